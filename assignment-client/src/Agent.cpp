@@ -141,6 +141,61 @@ void Agent::playAvatarSound(SharedSoundPointer sound) {
     }
 }
 
+void Agent::queueAvatarSamples(const QByteArray& samples) {
+    if (samples.size() < (int)sizeof(int16_t)) {
+        return;
+    }
+
+    // counted straight away so that a script pacing itself on it sees its own samples
+    _numQueuedAvatarSamples += samples.size() / (int)sizeof(int16_t);
+
+    // the queue is only touched on Agent's main thread
+    QMetaObject::invokeMethod(this, [this, samples] {
+        _avatarSampleQueue.push_back(samples);
+    });
+}
+
+bool Agent::hasQueuedAvatarSamples() const {
+    return !_avatarSampleQueue.empty()
+        && (_avatarSampleQueue.size() > 1 || _numAvatarSamplesSentBytes < _avatarSampleQueue.front().size());
+}
+
+QByteArray Agent::takeQueuedAvatarFrame() {
+    const int FRAME_BYTES = AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
+
+    // buffers used up by the last frame are only let go of now, since that frame may have pointed straight into them
+    while (!_avatarSampleQueue.empty() && _numAvatarSamplesSentBytes >= _avatarSampleQueue.front().size()) {
+        _avatarSampleQueue.pop_front();
+        _numAvatarSamplesSentBytes = 0;
+    }
+
+    QByteArray frame;
+    while (!_avatarSampleQueue.empty() && frame.size() < FRAME_BYTES) {
+        const QByteArray& samples = _avatarSampleQueue.front();
+        int numBytes = std::min(samples.size() - _numAvatarSamplesSentBytes, FRAME_BYTES - frame.size());
+        // whole samples only
+        numBytes -= numBytes % (int)sizeof(int16_t);
+        const char* start = samples.constData() + _numAvatarSamplesSentBytes;
+
+        if (frame.isEmpty() && numBytes == FRAME_BYTES) {
+            // the whole frame is in this buffer, so use it where it is rather than copying it out
+            frame = QByteArray::fromRawData(start, numBytes);
+        } else {
+            frame.append(start, numBytes);
+        }
+        _numAvatarSamplesSentBytes += numBytes;
+
+        if (frame.size() < FRAME_BYTES) {
+            // this buffer is used up and the frame carries on into the next, which it has copied from
+            _avatarSampleQueue.pop_front();
+            _numAvatarSamplesSentBytes = 0;
+        }
+    }
+
+    _numQueuedAvatarSamples -= frame.size() / (int)sizeof(int16_t);
+    return frame;
+}
+
 void Agent::handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto packetType = message->getType();
 
@@ -707,7 +762,8 @@ void Agent::processAgentAvatarAudio() {
     auto recordingInterface = DependencyManager::get<RecordingScriptingInterface>();
     bool isPlayingRecording = recordingInterface->isPlaying();
 
-    if (_isAvatar && ((_isListeningToAudioStream && !isPlayingRecording) || _avatarSound)) {
+    if (_isAvatar && ((_isListeningToAudioStream && !isPlayingRecording) || _avatarSound
+                     || hasQueuedAvatarSamples() || _isSendingAvatarSamples)) {
         // if we have an avatar audio stream then send it out to our audio-mixer
         auto scriptedAvatar = DependencyManager::get<ScriptableAvatar>();
         bool silentFrame = true;
@@ -715,12 +771,19 @@ void Agent::processAgentAvatarAudio() {
         int16_t numAvailableSamples = AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
         const int16_t* nextSoundOutput = NULL;
 
+        // hold on to whatever nextSoundOutput points into until the frame has been encoded
+        AudioDataPointer audioData;
+        QByteArray queuedFrame;
+
         if (_avatarSound && _avatarSound->isReady()) {
             if (isPlayingRecording && !_shouldMuteRecordingAudio) {
                 _shouldMuteRecordingAudio = true;
             }
             
-            auto audioData = _avatarSound->getAudioData();
+            if (!_avatarSoundData) {
+                _avatarSoundData = _avatarSound->getAudioData();
+            }
+            audioData = _avatarSoundData;
             nextSoundOutput = reinterpret_cast<const int16_t*>(audioData->rawData()
                     + _numAvatarSoundSentBytes);
 
@@ -729,20 +792,12 @@ void Agent::processAgentAvatarAudio() {
                 : audioData->getNumBytes() - _numAvatarSoundSentBytes;
             numAvailableSamples = (int16_t)numAvailableBytes / sizeof(int16_t);
 
-
-            // check if the all of the _numAvatarAudioBufferSamples to be sent are silence
-            for (int i = 0; i < numAvailableSamples; ++i) {
-                if (nextSoundOutput[i] != 0) {
-                    silentFrame = false;
-                    break;
-                }
-            }
-
             _numAvatarSoundSentBytes += numAvailableBytes;
             if (_numAvatarSoundSentBytes == (int)audioData->getNumBytes()) {
                 // we're done with this sound object - so set our pointer back to NULL
                 // and our sent bytes back to zero
                 _avatarSound.clear();
+                _avatarSoundData.reset();
                 _numAvatarSoundSentBytes = 0;
                 _flushEncoder = true;
 
@@ -750,6 +805,26 @@ void Agent::processAgentAvatarAudio() {
                     _shouldMuteRecordingAudio = false;
                 }
             }
+        } else if (hasQueuedAvatarSamples()) {
+            queuedFrame = takeQueuedAvatarFrame();
+            nextSoundOutput = reinterpret_cast<const int16_t*>(queuedFrame.constData());
+            numAvailableSamples = (int16_t)(queuedFrame.size() / sizeof(int16_t));
+            _isSendingAvatarSamples = true;
+        } else if (_isSendingAvatarSamples) {
+            // the script's samples have run out, which could be a gap before it queues more, so the encoder is only
+            // flushed once there is nothing to send
+            _isSendingAvatarSamples = false;
+            _flushEncoder = true;
+        }
+
+        if (nextSoundOutput) {
+            // check if the all of the _numAvatarAudioBufferSamples to be sent are silence
+            for (int i = 0; i < numAvailableSamples; ++i) {
+                if (nextSoundOutput[i] != 0) {
+                    silentFrame = false;
+                    break;
+                }
+            }
         }
 
         auto audioPacket = NLPacket::create(silentFrame && !_flushEncoder
@@ -802,7 +877,8 @@ void Agent::processAgentAvatarAudio() {
                 // loudness is 0
                 computeLoudness(nullptr, scriptedAvatar);
             } else {
-                QByteArray decodedBuffer(reinterpret_cast<const char*>(nextSoundOutput), numAvailableSamples*sizeof(int16_t));
+                auto decodedBuffer = QByteArray::fromRawData(reinterpret_cast<const char*>(nextSoundOutput),
+                                                             numAvailableSamples * sizeof(int16_t));
                 if (_encoder) {
                     // encode it
                     _encoder->encode(decodedBuffer, encodedBuffer);
@@ -12,6 +12,8 @@
 #ifndef hifi_Agent_h
 #define hifi_Agent_h
 
+#include <atomic>
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -49,6 +51,11 @@ public:
 
     bool isPlayingAvatarSound() const { return _avatarSound != NULL; }
 
+    // queues samples the script made to be sent as the avatar's audio, after any sound it is playing; can be called from any
+    // thread, the buffer is shared rather than copied
+    void queueAvatarSamples(const QByteArray& samples);
+    int getNumQueuedAvatarSamples() const { return _numQueuedAvatarSamples; }
+
     bool isListeningToAudioStream() const { return _isListeningToAudioStream; }
     void setIsListeningToAudioStream(bool isListeningToAudioStream);
 
@@ -90,6 +97,9 @@ private:
     void encodeFrameOfZeros(QByteArray& encodedZeros);
     void computeLoudness(const QByteArray* decodedBuffer, QSharedPointer<ScriptableAvatar>);
 
+    bool hasQueuedAvatarSamples() const;
+    QByteArray takeQueuedAvatarFrame();
+
     ScriptEnginePointer _scriptEngine;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
@@ -97,7 +107,7 @@ private:
     MixedAudioStream _receivedAudioStream;
     float _lastReceivedAudioLoudness;
 
-    void setAvatarSound(SharedSoundPointer avatarSound) { _avatarSound = avatarSound; }
+    void setAvatarSound(SharedSoundPointer avatarSound) { _avatarSound = avatarSound; _avatarSoundData.reset(); }
 
     void queryAvatars();
 
@@ -106,8 +116,14 @@ private:
     ResourceRequest* _pendingScriptRequest { nullptr };
     bool _isListeningToAudioStream = false;
     SharedSoundPointer _avatarSound;
+    // held while the sound plays, a streamed sound being decoded whole each time its data is asked for
+    AudioDataPointer _avatarSoundData;
     bool _shouldMuteRecordingAudio { false };
     int _numAvatarSoundSentBytes = 0;
+    std::deque<QByteArray> _avatarSampleQueue;
+    int _numAvatarSamplesSentBytes { 0 }; // from the buffer at the front of the queue
+    std::atomic<int> _numQueuedAvatarSamples { 0 };
+    bool _isSendingAvatarSamples { false };
     bool _isAvatar = false;
     QTimer* _avatarQueryTimer = nullptr;
     QHash<QUuid, quint16> _outgoingScriptAudioSequenceNumbers;
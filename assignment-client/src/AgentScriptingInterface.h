@@ -15,6 +15,8 @@
 
 #include <QObject>
 
+#include <ArrayBufferClass.h>
+
 #include "Agent.h"
 
 /*@jsdoc
@@ -30,6 +32,8 @@
  * @property {boolean} isPlayingAvatarSound - <code>true</code> if the script has a sound to play, otherwise <code>false</code>. 
  *     Sounds are played when <code>isAvatar</code> is <code>true</code>, from the position and with the orientation of the 
  *     scripted avatar's head. <em>Read-only.</em>
+ * @property {number} queuedAvatarSamples - The number of samples queued with {@link Agent.queueAvatarSamples} that are yet 
+ *     to be sent. <em>Read-only.</em>
  * @property {boolean} isListeningToAudioStream - <code>true</code> if the agent is "listening" to the audio stream from the 
  *     domain, otherwise <code>false</code>.
  * @property {boolean} isNoiseGateEnabled - <code>true</code> if the noise gate is enabled, otherwise <code>false</code>. When 
@@ -42,6 +46,7 @@ class AgentScriptingInterface : public QObject {
     Q_OBJECT
     Q_PROPERTY(bool isAvatar READ isAvatar WRITE setIsAvatar)
     Q_PROPERTY(bool isPlayingAvatarSound READ isPlayingAvatarSound)
+    Q_PROPERTY(int queuedAvatarSamples READ getNumQueuedAvatarSamples)
     Q_PROPERTY(bool isListeningToAudioStream READ isListeningToAudioStream WRITE setIsListeningToAudioStream)
     Q_PROPERTY(bool isNoiseGateEnabled READ isNoiseGateEnabled WRITE setIsNoiseGateEnabled)
     Q_PROPERTY(float lastReceivedAudioLoudness READ getLastReceivedAudioLoudness)
@@ -51,6 +56,7 @@ public:
     AgentScriptingInterface(Agent* agent);
 
     bool isPlayingAvatarSound() const { return _agent->isPlayingAvatarSound(); }
+    int getNumQueuedAvatarSamples() const { return _agent->getNumQueuedAvatarSamples(); }
 
     bool isListeningToAudioStream() const { return _agent->isListeningToAudioStream(); }
     void setIsListeningToAudioStream(bool isListeningToAudioStream) const { _agent->setIsListeningToAudioStream(isListeningToAudioStream); }
@@ -103,6 +109,37 @@ public slots:
      */
     void playAvatarSound(SharedSoundPointer avatarSound) const { _agent->playAvatarSound(avatarSound); }
 
+    /*@jsdoc
+     * Queues audio samples made by the script to be sent from the position and with the orientation of the emulated 
+     * avatar's head, after any sound being played with {@link Agent.playAvatarSound}. The samples are sent straight out of 
+     * the buffer rather than copied; writing to the buffer again once it has been queued doesn't change what is sent but does 
+     * make a copy of it, so use a new buffer for each block of samples. No sound is played unless <code>isAvatar == true</code>.
+     * @function Agent.queueAvatarSamples
+     * @param {ArrayBuffer|Int16Array} samples - Mono 16-bit PCM samples at 24kHz.
+     * @example <caption>Stream a tone from an emulated avatar.</caption>
+     * (function () {
+     *     Agent.isAvatar = true;
+     *     var SAMPLE_RATE = 24000;
+     *     var FRAME_SAMPLES = 240; // 10ms
+     *     var phase = 0;
+     *     Script.setInterval(function () {
+     *         while (Agent.queuedAvatarSamples < 4 * FRAME_SAMPLES) {
+     *             var frame = new Int16Array(FRAME_SAMPLES);
+     *             for (var i = 0; i < FRAME_SAMPLES; i++, phase++) {
+     *                 frame[i] = 8000 * Math.sin(2 * Math.PI * 440 * phase / SAMPLE_RATE);
+     *             }
+     *             Agent.queueAvatarSamples(frame);
+     *         }
+     *     }, 10);
+     * }());
+     */
+    void queueAvatarSamples(const QScriptValue& samples) const {
+        QByteArray sampleBytes;
+        if (ArrayBufferClass::toByteArray(samples, sampleBytes)) {
+            _agent->queueAvatarSamples(sampleBytes);
+        }
+    }
+
 private:
     Agent* _agent;
 
@@ -15,6 +15,7 @@
 
 #include <assert.h>
 
+#include <QDir>
 #include <QJsonDocument>
 #include <QProcess>
 #include <QSharedMemory>
@@ -40,6 +41,7 @@
 
 #include "AssignmentClientLogging.h"
 #include "AssignmentFactory.h"
+#include "AssignmentPlacement.h"
 #include "ResourceRequestObserver.h"
 
 const QString ASSIGNMENT_CLIENT_TARGET_NAME = "assignment-client";
@@ -48,12 +50,13 @@ const long long ASSIGNMENT_REQUEST_INTERVAL_MSECS = 1 * 1000;
 AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QString assignmentPool,
                                    quint16 listenPort, QUuid walletUUID, QString assignmentServerHostname,
                                    quint16 assignmentServerPort, quint16 assignmentMonitorPort,
-                                   bool disableDomainPortAutoDiscovery) :
-    _assignmentServerHostname(DEFAULT_ASSIGNMENT_SERVER_HOSTNAME)
+                                   bool disableDomainPortAutoDiscovery, QString placementPolicy) :
+    _assignmentServerHostname(DEFAULT_ASSIGNMENT_SERVER_HOSTNAME),
+    _placementPolicy(placementPolicy)
 {
     LogUtils::init();
 
-    DependencyManager::set<tracing::Tracer>();
+    auto tracer = DependencyManager::set<tracing::Tracer>();
     DependencyManager::set<StatTracker>();
     DependencyManager::set<AccountManager>();
     DependencyManager::set<ResourceRequestObserver>();
@@ -70,6 +73,15 @@ AssignmentClient::AssignmentClient(Assignment::Type requestAssignmentType, QStri
     // make sure we output process IDs for a child AC otherwise it's insane to parse
     LogHandler::getInstance().setShouldOutputProcessID(true);
 
+    // with HIFI_TRACE_DIRECTORY set, each assignment client streams a binary trace of the trace categories the logging
+    // rules enable to a file of its own there, for trace-convert to turn into Chrome trace JSON
+    const QString TRACE_DIRECTORY_ENV = "HIFI_TRACE_DIRECTORY";
+    QString traceDirectory = QProcessEnvironment::systemEnvironment().value(TRACE_DIRECTORY_ENV);
+    if (!traceDirectory.isEmpty() && QDir().mkpath(traceDirectory)) {
+        QString traceFile = QString("assignment-client-%1.hftrace").arg(QCoreApplication::applicationPid());
+        tracer->startTracing(QDir(traceDirectory).filePath(traceFile));
+    }
+
     // setup our _requestAssignment member variable from the passed arguments
     _requestAssignment = Assignment(Assignment::RequestCommand, requestAssignmentType, assignmentPool);
 
@@ -243,6 +255,12 @@ void AssignmentClient::handleCreateAssignmentPacket(QSharedPointer<ReceivedMessa
         return;
     }
 
+    if (!_placementPolicy.isEmpty()) {
+        // place ourselves before the assignment is built, the mixers size their slave pools from the CPUs we can run on
+        Assignment assignment(*message);
+        AssignmentPlacement::apply(_placementPolicy, assignment.getType());
+    }
+
     // construct the deployed assignment from the packet data
     _currentAssignment = AssignmentFactory::unpackAssignment(*message);
 
@@ -30,7 +30,7 @@ public:
     AssignmentClient(Assignment::Type requestAssignmentType, QString assignmentPool,
                      quint16 listenPort, QUuid walletUUID, QString assignmentServerHostname,
                      quint16 assignmentServerPort, quint16 assignmentMonitorPort,
-                     bool disableDomainPortAutoDiscovery);
+                     bool disableDomainPortAutoDiscovery, QString placementPolicy);
     ~AssignmentClient();
 
 public slots:
@@ -66,6 +66,7 @@ private:
     QTimer _statsTimerACM; // timer for sending stats to assignment client monitor
     QUuid _childAssignmentUUID = QUuid::createUuid();
     bool _disableDomainPortAutoDiscovery { false };
+    QString _placementPolicy;
 
  protected:
     SockAddr _assignmentClientMonitorSocket;
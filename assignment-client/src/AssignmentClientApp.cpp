@@ -29,6 +29,7 @@
 #include "Assignment.h"
 #include "AssignmentClient.h"
 #include "AssignmentClientMonitor.h"
+#include "AssignmentPlacement.h"
 
 AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
@@ -105,6 +106,11 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
         "assignment clients automatically search for the domain server on the local machine, if networking is being managed, then disable automatic discovery of the domain server port");
     parser.addOption(disableDomainPortAutoDiscoveryOption);
 
+    const QCommandLineOption placementOption(ASSIGNMENT_PLACEMENT_OPTION,
+        "CPU and NUMA placement per assignment type, e.g. audio-mixer=node:0;avatar-mixer=node:auto;*=cpus:8-15",
+        "placement");
+    parser.addOption(placementOption);
+
     const QCommandLineOption parentPIDOption(PARENT_PID_OPTION, "PID of the parent process", "parent-pid");
     parser.addOption(parentPIDOption);
 
@@ -166,6 +172,16 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
         disableDomainPortAutoDiscovery = true;
     }
 
+    QString placementPolicy;
+    if (parser.isSet(placementOption)) {
+        placementPolicy = parser.value(placementOption);
+        if (!AssignmentPlacement::isValidPolicy(placementPolicy)) {
+            qCritical() << "Invalid placement" << placementPolicy;
+            parser.showHelp();
+            Q_UNREACHABLE();
+        }
+    }
+
     Assignment::Type requestAssignmentType = Assignment::AllTypes;
     if (argumentVariantMap.contains(ASSIGNMENT_TYPE_OVERRIDE_OPTION)) {
         requestAssignmentType = (Assignment::Type) argumentVariantMap.value(ASSIGNMENT_TYPE_OVERRIDE_OPTION).toInt();
@@ -260,14 +276,14 @@ AssignmentClientApp::AssignmentClientApp(int argc, char* argv[]) :
                                                                         requestAssignmentType, assignmentPool, listenPort,
                                                                         childMinListenPort, walletUUID, assignmentServerHostname,
                                                                         assignmentServerPort, httpStatusPort, logDirectory,
-                                                                        disableDomainPortAutoDiscovery);
+                                                                        disableDomainPortAutoDiscovery, placementPolicy);
         monitor->setParent(this);
         connect(this, &QCoreApplication::aboutToQuit, monitor, &AssignmentClientMonitor::aboutToQuit);
     } else {
         AssignmentClient* client = new AssignmentClient(requestAssignmentType, assignmentPool, listenPort,
                                                         walletUUID, assignmentServerHostname,
                                                         assignmentServerPort, monitorPort,
-                                                        disableDomainPortAutoDiscovery);
+                                                        disableDomainPortAutoDiscovery, placementPolicy);
         client->setParent(this);
         connect(this, &QCoreApplication::aboutToQuit, client, &AssignmentClient::aboutToQuit);
     }
@@ -21,10 +21,12 @@
 
 #include <AddressManager.h>
 #include <LogHandler.h>
+#include <ProcessPlacement.h>
 #include <udt/PacketHeaders.h>
 
 #include "AssignmentClientApp.h"
 #include "AssignmentClientChildData.h"
+#include "AssignmentPlacement.h"
 #include "SharedUtil.h"
 #include <QtCore/QJsonDocument>
 #ifdef _POSIX_SOURCE
@@ -44,7 +46,7 @@ AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmen
                                                  Assignment::Type requestAssignmentType, QString assignmentPool,
                                                  quint16 listenPort, quint16 childMinListenPort, QUuid walletUUID, QString assignmentServerHostname,
                                                  quint16 assignmentServerPort, quint16 httpStatusServerPort, QString logDirectory,
-                                                 bool disableDomainPortAutoDiscovery) :
+                                                 bool disableDomainPortAutoDiscovery, QString placementPolicy) :
     _httpManager(QHostAddress::LocalHost, httpStatusServerPort, "", this),
     _numAssignmentClientForks(numAssignmentClientForks),
     _minAssignmentClientForks(minAssignmentClientForks),
@@ -55,7 +57,8 @@ AssignmentClientMonitor::AssignmentClientMonitor(const unsigned int numAssignmen
     _assignmentServerHostname(assignmentServerHostname),
     _assignmentServerPort(assignmentServerPort),
     _childMinListenPort(childMinListenPort),
-    _disableDomainPortAutoDiscovery(disableDomainPortAutoDiscovery)
+    _disableDomainPortAutoDiscovery(disableDomainPortAutoDiscovery),
+    _placementPolicy(placementPolicy)
 {
     qDebug() << "_requestAssignmentType =" << _requestAssignmentType;
 
@@ -206,6 +209,17 @@ void AssignmentClientMonitor::spawnChildClient() {
         _childArguments.append("--" + ASSIGNMENT_DISABLE_DOMAIN_AUTO_PORT_DISCOVERY);
     }
 
+    int numaNode = -1;
+    if (!_placementPolicy.isEmpty()) {
+        auto childPlacementPolicy = _placementPolicy;
+        if (AssignmentPlacement::usesAutoNode(_placementPolicy)) {
+            numaNode = pickNumaNodeForChild();
+            childPlacementPolicy = AssignmentPlacement::withAutoNode(_placementPolicy, numaNode);
+        }
+        _childArguments.append("--" + ASSIGNMENT_PLACEMENT_OPTION);
+        _childArguments.append(childPlacementPolicy);
+    }
+
     if (listenPort) {
         _childArguments.append("-" + ASSIGNMENT_CLIENT_LISTEN_PORT_OPTION);
         _childArguments.append(QString::number(listenPort));
@@ -288,8 +302,33 @@ void AssignmentClientMonitor::spawnChildClient() {
 
         qDebug() << "Spawned a child client with PID" << assignmentClient->processId();
 
-        _childProcesses.insert(assignmentClient->processId(), { assignmentClient, stdoutPath, stderrPath });
+        _childProcesses.insert(assignmentClient->processId(), { assignmentClient, stdoutPath, stderrPath, numaNode });
+    }
+}
+
+int AssignmentClientMonitor::pickNumaNodeForChild() const {
+    // the node with the fewest children on it, so that mixers on a multi-socket machine each get their own
+    QMap<int, int> numChildrenOnNode;
+    for (const auto& node : ProcessPlacement::getNumaNodes()) {
+        numChildrenOnNode[node.id] = 0;
+    }
+    if (numChildrenOnNode.isEmpty()) {
+        return 0;
+    }
+
+    for (const auto& ac : _childProcesses) {
+        if (numChildrenOnNode.contains(ac.numaNode)) {
+            ++numChildrenOnNode[ac.numaNode];
+        }
+    }
+
+    auto leastUsed = numChildrenOnNode.cbegin();
+    for (auto it = numChildrenOnNode.cbegin(); it != numChildrenOnNode.cend(); ++it) {
+        if (it.value() < leastUsed.value()) {
+            leastUsed = it;
+        }
     }
+    return leastUsed.key();
 }
 
 void AssignmentClientMonitor::checkSpares() {
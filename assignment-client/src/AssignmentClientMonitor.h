@@ -33,6 +33,7 @@ struct ACProcess {
     QProcess* process; // looks like a dangling pointer, but is parented by the AssignmentClientMonitor
     QString logStdoutPath;
     QString logStderrPath;
+    int numaNode { -1 }; // the node it was given for a node:auto placement
 };
 
 class AssignmentClientMonitor : public QObject, public HTTPRequestHandler {
@@ -42,7 +43,7 @@ public:
                             const unsigned int maxAssignmentClientForks, Assignment::Type requestAssignmentType,
                             QString assignmentPool, quint16 listenPort, quint16 childMinListenPort, QUuid walletUUID,
                             QString assignmentServerHostname, quint16 assignmentServerPort, quint16 httpStatusServerPort,
-                            QString logDirectory, bool disableDomainPortAutoDiscovery);
+                            QString logDirectory, bool disableDomainPortAutoDiscovery, QString placementPolicy);
     ~AssignmentClientMonitor();
 
     void stopChildProcesses();
@@ -60,6 +61,7 @@ private:
     void spawnChildClient();
     void simultaneousWaitOnChildren(int waitMsecs);
     void adjustOSResources(unsigned int numForks) const;
+    int pickNumaNodeForChild() const;
 
     QTimer _checkSparesTimer; // every few seconds see if it need fewer or more spare children
 
@@ -84,6 +86,7 @@ private:
 
     bool _wantsChildFileLogging { false };
     bool _disableDomainPortAutoDiscovery { false };
+    QString _placementPolicy;
 };
 
 #endif // hifi_AssignmentClientMonitor_h
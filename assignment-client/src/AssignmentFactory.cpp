@@ -15,6 +15,7 @@
 
 #include "Agent.h"
 #include "assets/AssetServer.h"
+#include "assets/BakeWorker.h"
 #include "audio/AudioMixer.h"
 #include "avatars/AvatarMixer.h"
 #include "entities/EntityServer.h"
@@ -45,6 +46,8 @@ ThreadedAssignment* AssignmentFactory::unpackAssignment(ReceivedMessage& message
             return new MessagesMixer(message);
         case Assignment::EntityScriptServerType:
             return new EntityScriptServer(message);
+        case Assignment::BakeWorkerType:
+            return new BakeWorker(message);
         default:
             return nullptr;
     }
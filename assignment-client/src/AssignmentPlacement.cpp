@@ -0,0 +1,108 @@
+//
+//  AssignmentPlacement.cpp
+//  assignment-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssignmentPlacement.h"
+
+#include <QtCore/QHash>
+
+#include <ProcessPlacement.h>
+
+#include "AssignmentClientLogging.h"
+
+static const QString NODE_PLACEMENT_PREFIX = "node:";
+static const QString CPUS_PLACEMENT_PREFIX = "cpus:";
+static const QString AUTO_NODE = "auto";
+static const QString ANY_TYPE = "*";
+
+// the placement for each type, "audio-mixer=node:0;*=cpus:0-3" split into its entries
+static QHash<QString, QString> parsePolicy(const QString& policy, bool* isValid = nullptr) {
+    QHash<QString, QString> placements;
+    bool isPolicyValid = true;
+
+    for (const auto& entry : policy.split(';', Qt::SkipEmptyParts)) {
+        auto separator = entry.indexOf('=');
+        auto type = entry.left(separator).trimmed();
+        auto placement = entry.mid(separator + 1).trimmed();
+
+        bool isPlacementValid = separator > 0
+            && (placement == NODE_PLACEMENT_PREFIX + AUTO_NODE
+                || (placement.startsWith(NODE_PLACEMENT_PREFIX) && placement.mid(NODE_PLACEMENT_PREFIX.size()).toInt() >= 0
+                    && !placement.mid(NODE_PLACEMENT_PREFIX.size()).isEmpty())
+                || (placement.startsWith(CPUS_PLACEMENT_PREFIX)
+                    && !ProcessPlacement::parseCpuList(placement.mid(CPUS_PLACEMENT_PREFIX.size())).empty()));
+        if (isPlacementValid) {
+            placements[type] = placement;
+        } else {
+            isPolicyValid = false;
+        }
+    }
+
+    if (isValid) {
+        *isValid = isPolicyValid;
+    }
+    return placements;
+}
+
+bool AssignmentPlacement::isValidPolicy(const QString& policy) {
+    bool isValid = false;
+    parsePolicy(policy, &isValid);
+    return isValid;
+}
+
+bool AssignmentPlacement::usesAutoNode(const QString& policy) {
+    return parsePolicy(policy).values().contains(NODE_PLACEMENT_PREFIX + AUTO_NODE);
+}
+
+QString AssignmentPlacement::withAutoNode(const QString& policy, int node) {
+    return QString(policy).replace(NODE_PLACEMENT_PREFIX + AUTO_NODE, NODE_PLACEMENT_PREFIX + QString::number(node));
+}
+
+bool AssignmentPlacement::apply(const QString& policy, Assignment::Type type) {
+    auto placements = parsePolicy(policy);
+    auto placement = placements.value(Assignment::typeToString(type), placements.value(ANY_TYPE));
+    if (placement.isEmpty()) {
+        return false;
+    }
+
+    std::vector<int> cpus;
+    int numaNode = -1;
+    if (placement.startsWith(NODE_PLACEMENT_PREFIX)) {
+        numaNode = placement.mid(NODE_PLACEMENT_PREFIX.size()).toInt();
+        for (const auto& node : ProcessPlacement::getNumaNodes()) {
+            if (node.id == numaNode) {
+                cpus = node.cpus;
+            }
+        }
+
+        if (cpus.empty()) {
+            qCWarning(assignment_client) << "Can't place" << Assignment::typeToString(type) << "on NUMA node" << numaNode
+                << "- there's no such node";
+            return false;
+        }
+    } else {
+        cpus = ProcessPlacement::parseCpuList(placement.mid(CPUS_PLACEMENT_PREFIX.size()));
+    }
+
+    if (!ProcessPlacement::bindToCpus(cpus)) {
+        qCWarning(assignment_client) << "Failed to bind" << Assignment::typeToString(type) << "to CPUs"
+            << ProcessPlacement::formatCpuList(cpus);
+        return false;
+    }
+
+    if (numaNode >= 0 && !ProcessPlacement::preferNumaNode(numaNode)) {
+        qCWarning(assignment_client) << "Failed to have" << Assignment::typeToString(type) << "allocate from NUMA node"
+            << numaNode;
+    }
+
+    qCDebug(assignment_client) << "Placed" << Assignment::typeToString(type) << "on CPUs"
+        << ProcessPlacement::formatCpuList(cpus) << (numaNode >= 0 ? "of NUMA node " + QString::number(numaNode) : "");
+    return true;
+}
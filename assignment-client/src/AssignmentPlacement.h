@@ -0,0 +1,37 @@
+//
+//  AssignmentPlacement.h
+//  assignment-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssignmentPlacement_h
+#define hifi_AssignmentPlacement_h
+
+#include <QtCore/QString>
+
+#include <Assignment.h>
+
+/// Where an assignment-client runs its assignment, from a policy per assignment type given with --placement, such as
+///     audio-mixer=node:0;avatar-mixer=node:auto;*=cpus:8-15
+/// node:N binds the assignment to the CPUs of NUMA node N and has it allocate from that node's memory, node:auto does the
+/// same on the node the monitor picked for the child, so that the children are spread over the nodes, and cpus:LIST binds
+/// the assignment to the CPUs listed. Types without a policy, and no * entry, aren't placed.
+namespace AssignmentPlacement {
+
+bool isValidPolicy(const QString& policy);
+
+// whether the monitor has to pick a node for its children
+bool usesAutoNode(const QString& policy);
+QString withAutoNode(const QString& policy, int node);
+
+// places this process for an assignment of the type, before the assignment has started its threads
+bool apply(const QString& policy, Assignment::Type type);
+
+}
+
+#endif // hifi_AssignmentPlacement_h
@@ -0,0 +1,207 @@
+//
+//  AvatarPoseTable.cpp
+//  assignment-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarPoseTable.h"
+
+#include <atomic>
+#include <cstring>
+#include <limits>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+#include "AssignmentClientLogging.h"
+
+// the table is shared between processes, so its atomics have to work without a lock
+static_assert(ATOMIC_INT_LOCK_FREE == 2 && ATOMIC_LLONG_LOCK_FREE == 2, "the avatar pose table needs lock free atomics");
+
+namespace {
+
+const uint32_t POSE_TABLE_MAGIC = 0x48465054; // "HFPT"
+const uint32_t POSE_TABLE_FORMAT = 1;
+const uint32_t NUM_SLOTS = (uint32_t)std::numeric_limits<Node::LocalID>::max() + 1;
+
+const quint64 MAX_HEARTBEAT_AGE = USECS_PER_SECOND;
+const int MAX_READ_ATTEMPTS = 4;
+
+// the session ID, position and orientation of an avatar
+const int NUM_UUID_WORDS = sizeof(QUuid) / sizeof(uint32_t);
+const int NUM_POSE_WORDS = NUM_UUID_WORDS + 3 + 4;
+
+}
+
+struct alignas(64) AvatarPoseTable::Header {
+    std::atomic<uint32_t> magic;
+    std::atomic<uint32_t> format;
+    std::atomic<uint32_t> numSlots;
+    std::atomic<quint64> heartbeat; // the last time the avatar mixer wrote to the table
+};
+
+// a cache line each, so that reading one slot doesn't contend with writes to the next
+struct alignas(64) AvatarPoseTable::Slot {
+    std::atomic<uint32_t> sequence; // odd while the slot is being written
+    std::atomic<uint32_t> words[NUM_POSE_WORDS];
+};
+
+static_assert(sizeof(QUuid) == NUM_UUID_WORDS * sizeof(uint32_t), "unexpected QUuid layout");
+
+static QString getPoseTableKey(const QUuid& domainID) {
+    return "avatar-poses-" + uuidStringWithoutCurlyBraces(domainID);
+}
+
+AvatarPoseTable::~AvatarPoseTable() {
+    detach();
+}
+
+bool AvatarPoseTable::publish(const QUuid& domainID) {
+    if (!map(domainID, true)) {
+        return false;
+    }
+
+    // the avatar mixer that wrote the table last may have stopped while writing to it
+    _header->magic.store(0, std::memory_order_relaxed);
+    for (uint32_t i = 0; i < NUM_SLOTS; i++) {
+        _slots[i].sequence.store(0, std::memory_order_relaxed);
+        for (auto& word : _slots[i].words) {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
+    _header->format.store(POSE_TABLE_FORMAT, std::memory_order_relaxed);
+    _header->numSlots.store(NUM_SLOTS, std::memory_order_relaxed);
+    _header->heartbeat.store(usecTimestampNow(), std::memory_order_relaxed);
+    _header->magic.store(POSE_TABLE_MAGIC, std::memory_order_release);
+
+    qCDebug(assignment_client) << "Publishing avatar poses to shared memory at key" << _sharedMemory->key();
+    return true;
+}
+
+bool AvatarPoseTable::attach(const QUuid& domainID) {
+    if (!map(domainID, false)) {
+        return false;
+    }
+
+    if (_header->magic.load(std::memory_order_acquire) != POSE_TABLE_MAGIC ||
+        _header->format.load(std::memory_order_relaxed) != POSE_TABLE_FORMAT ||
+        _header->numSlots.load(std::memory_order_relaxed) != NUM_SLOTS) {
+        qCWarning(assignment_client) << "Ignoring the avatar pose table at key" << _sharedMemory->key()
+            << ", it isn't in this build's format";
+        detach();
+        return false;
+    }
+    return true;
+}
+
+bool AvatarPoseTable::map(const QUuid& domainID, bool isWriter) {
+    detach();
+    if (domainID.isNull()) {
+        return false;
+    }
+
+    const int POSE_TABLE_SIZE = (int)(sizeof(Header) + NUM_SLOTS * sizeof(Slot));
+    std::unique_ptr<QSharedMemory> sharedMemory { new QSharedMemory(getPoseTableKey(domainID)) };
+    bool isMapped = isWriter ? (sharedMemory->create(POSE_TABLE_SIZE) || sharedMemory->attach())
+                             : sharedMemory->attach(QSharedMemory::ReadOnly);
+    if (!isMapped) {
+        if (isWriter) {
+            qCWarning(assignment_client) << "Could not create the avatar pose table at key" << sharedMemory->key()
+                << ":" << sharedMemory->errorString();
+        }
+        return false;
+    }
+    if (sharedMemory->size() < POSE_TABLE_SIZE) {
+        qCWarning(assignment_client) << "The avatar pose table at key" << sharedMemory->key() << "is too small";
+        return false;
+    }
+
+    _sharedMemory = std::move(sharedMemory);
+    _header = reinterpret_cast<Header*>(_sharedMemory->data());
+    _slots = reinterpret_cast<Slot*>(reinterpret_cast<char*>(_sharedMemory->data()) + sizeof(Header));
+    return true;
+}
+
+void AvatarPoseTable::detach() {
+    _header = nullptr;
+    _slots = nullptr;
+    _sharedMemory.reset();
+}
+
+AvatarPoseTable::Slot* AvatarPoseTable::getSlot(Node::LocalID localID) const {
+    return (_slots && localID != Node::NULL_LOCAL_ID) ? &_slots[localID] : nullptr;
+}
+
+void AvatarPoseTable::write(Node::LocalID localID, const QUuid& sessionID, const Pose& pose) {
+    Slot* slot = getSlot(localID);
+    if (!slot) {
+        return;
+    }
+
+    uint32_t words[NUM_POSE_WORDS];
+    memcpy(&words[0], &sessionID, sizeof(QUuid));
+    memcpy(&words[NUM_UUID_WORDS], &pose.position, 3 * sizeof(float));
+    memcpy(&words[NUM_UUID_WORDS + 3], &pose.orientation, 4 * sizeof(float));
+
+    uint32_t sequence = slot->sequence.load(std::memory_order_relaxed);
+    slot->sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (int i = 0; i < NUM_POSE_WORDS; i++) {
+        slot->words[i].store(words[i], std::memory_order_relaxed);
+    }
+    slot->sequence.store(sequence + 2, std::memory_order_release);
+}
+
+void AvatarPoseTable::clear(Node::LocalID localID) {
+    write(localID, QUuid(), Pose { glm::vec3(0.0f), glm::quat() });
+}
+
+void AvatarPoseTable::heartbeat() {
+    if (_header) {
+        _header->heartbeat.store(usecTimestampNow(), std::memory_order_release);
+    }
+}
+
+bool AvatarPoseTable::isFresh() const {
+    return _header && usecTimestampNow() < _header->heartbeat.load(std::memory_order_acquire) + MAX_HEARTBEAT_AGE;
+}
+
+bool AvatarPoseTable::read(Node::LocalID localID, const QUuid& sessionID, Pose& pose) const {
+    Slot* slot = getSlot(localID);
+    if (!slot || sessionID.isNull()) {
+        return false;
+    }
+
+    uint32_t words[NUM_POSE_WORDS];
+    for (int attempt = 0; attempt < MAX_READ_ATTEMPTS; attempt++) {
+        uint32_t sequence = slot->sequence.load(std::memory_order_acquire);
+        if (sequence & 1) {
+            continue;
+        }
+        for (int i = 0; i < NUM_POSE_WORDS; i++) {
+            words[i] = slot->words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot->sequence.load(std::memory_order_relaxed) != sequence) {
+            continue;
+        }
+
+        QUuid slotSessionID;
+        memcpy(&slotSessionID, &words[0], sizeof(QUuid));
+        if (slotSessionID != sessionID) {
+            return false;
+        }
+        memcpy(&pose.position, &words[NUM_UUID_WORDS], 3 * sizeof(float));
+        memcpy(&pose.orientation, &words[NUM_UUID_WORDS + 3], 4 * sizeof(float));
+        return true;
+    }
+
+    // the avatar mixer is writing to it, or stopped while it was
+    return false;
+}
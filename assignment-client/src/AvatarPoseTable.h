@@ -0,0 +1,69 @@
+//
+//  AvatarPoseTable.h
+//  assignment-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarPoseTable_h
+#define hifi_AvatarPoseTable_h
+
+#include <memory>
+
+#include <QtCore/QSharedMemory>
+#include <QtCore/QUuid>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <Node.h>
+
+/// The avatars' poses as the avatar mixer last had them, in shared memory for the assignments running next to it on the
+/// same host, so that they place the avatars where the avatar mixer sends them to everyone else.
+///
+/// The table has a slot for each local ID in the domain. The avatar mixer is its only writer; each slot is guarded by a
+/// sequence lock, so readers never block it and retry, or give up, on a slot that it is writing. A reader ignores the table
+/// once the avatar mixer hasn't touched it for a second, as when it has gone away.
+class AvatarPoseTable {
+public:
+    struct Pose {
+        glm::vec3 position;
+        glm::quat orientation;
+    };
+
+    ~AvatarPoseTable();
+
+    // creates, or takes over, the domain's table to write to, called by the avatar mixer
+    bool publish(const QUuid& domainID);
+    // attaches to the domain's table to read from, failing until the avatar mixer has created it
+    bool attach(const QUuid& domainID);
+    void detach();
+    bool isAttached() const { return _header != nullptr; }
+
+    // writer side, all on one thread
+    void write(Node::LocalID localID, const QUuid& sessionID, const Pose& pose);
+    void clear(Node::LocalID localID);
+    void heartbeat();
+
+    // reader side, from any thread
+    bool isFresh() const;
+    // fails unless the slot holds a pose of the avatar with this session ID
+    bool read(Node::LocalID localID, const QUuid& sessionID, Pose& pose) const;
+
+private:
+    struct Header;
+    struct Slot;
+
+    bool map(const QUuid& domainID, bool isWriter);
+    Slot* getSlot(Node::LocalID localID) const;
+
+    std::unique_ptr<QSharedMemory> _sharedMemory;
+    Header* _header { nullptr };
+    Slot* _slots { nullptr };
+};
+
+#endif // hifi_AvatarPoseTable_h
@@ -0,0 +1,203 @@
+//
+//  MixerStandbyReplicator.cpp
+//  assignment-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MixerStandbyReplicator.h"
+
+#include <algorithm>
+
+#include <NodeList.h>
+#include <UUID.h>
+
+#include "AssignmentClientLogging.h"
+
+// a node that keeps ignoring and soloing others is only remembered for its latest changes
+static const size_t MAX_STATE_ENTRIES_PER_NODE = 512;
+
+// the entries of these types only matter until the node sends another of the same
+static bool replacesEarlierEntries(PacketType type) {
+    return type == PacketType::NegotiateAudioFormat || type == PacketType::RequestsDomainListData
+        || type == PacketType::InjectorGainSet || type == PacketType::RadiusIgnoreRequest;
+}
+
+MixerStandbyReplicator::MixerStandbyReplicator(NodeType_t mixerType, Mode mode, ApplyFunction applyFunction,
+                                               QObject* parent) :
+    QObject(parent),
+    _mixerType(mixerType),
+    _mode(mode),
+    _applyFunction(std::move(applyFunction))
+{
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->getPacketReceiver().registerListener(PacketType::MixerStandbyState,
+        PacketReceiver::makeSourcedListenerReference<MixerStandbyReplicator>(this,
+                                                                              &MixerStandbyReplicator::handleStandbyStatePacket));
+
+    connect(nodeList.data(), &LimitedNodeList::nodeAdded, this, &MixerStandbyReplicator::handleNodeAdded);
+    connect(nodeList.data(), &LimitedNodeList::nodeActivated, this, &MixerStandbyReplicator::handleNodeActivated);
+    connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &MixerStandbyReplicator::handleNodeKilled);
+}
+
+void MixerStandbyReplicator::mirrorPacket(const ReceivedMessage& message, const Node& sendingNode) {
+    if (_isApplyingMirroredState || sendingNode.isUpstream() || !isMirrored(message.getType())
+        || (sendingNode.getType() != NodeType::Agent && sendingNode.getType() != NodeType::EntityScriptServer)) {
+        return;
+    }
+
+    StateEntry entry { message.getType(), message.getMessage() };
+    record(sendingNode.getUUID(), entry.type, entry.payload);
+
+    // the standby is the only other mixer of our type we're told about, unless we're one of several peers
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->eachMatchingNode([this](const SharedNodePointer& node) {
+        return node->getType() == _mixerType && node->getActiveSocket();
+    }, [&](const SharedNodePointer& node) {
+        auto packetList = NLPacketList::create(PacketType::MixerStandbyState, QByteArray(), true, true);
+        writeEntry(*packetList, sendingNode.getUUID(), entry);
+        nodeList->sendPacketList(std::move(packetList), *node);
+    });
+}
+
+bool MixerStandbyReplicator::isMirrored(PacketType type) const {
+    // the peers have their own nodes' settings, they only need the ignores and avatar traits of the nodes they replicate,
+    // while a standby is sent the traits again by the nodes failed over to it
+    if (_mode == Mode::Peers) {
+        return type == PacketType::NodeIgnoreRequest || type == PacketType::RadiusIgnoreRequest
+            || type == PacketType::SetAvatarTraits;
+    }
+    return type != PacketType::SetAvatarTraits;
+}
+
+void MixerStandbyReplicator::record(const QUuid& nodeID, PacketType type, const QByteArray& payload) {
+    auto& entries = _nodeStates[nodeID];
+
+    if (replacesEarlierEntries(type)) {
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [type](const StateEntry& entry) {
+            return entry.type == type;
+        }), entries.end());
+    } else if (type == PacketType::PerAvatarGainSet) {
+        // a gain replaces the earlier one for the same avatar, the payload starts with its ID
+        auto avatarID = payload.left(NUM_BYTES_RFC4122_UUID);
+        entries.erase(std::remove_if(entries.begin(), entries.end(), [type, &avatarID](const StateEntry& entry) {
+            return entry.type == type && entry.payload.startsWith(avatarID);
+        }), entries.end());
+    }
+
+    entries.push_back({ type, payload });
+    if (entries.size() > MAX_STATE_ENTRIES_PER_NODE) {
+        entries.erase(entries.begin());
+    }
+}
+
+void MixerStandbyReplicator::writeEntry(NLPacketList& packetList, const QUuid& nodeID, const StateEntry& entry) {
+    packetList.write(nodeID.toRfc4122());
+    packetList.writePrimitive(static_cast<quint8>(entry.type));
+    quint32 payloadSize = entry.payload.size();
+    packetList.writePrimitive(payloadSize);
+    packetList.write(entry.payload);
+}
+
+void MixerStandbyReplicator::apply(const SharedNodePointer& node, const StateEntry& entry) {
+    auto message = QSharedPointer<ReceivedMessage>::create(entry.payload, entry.type, versionForPacketType(entry.type),
+                                                           node->getPublicSocket(), node->getLocalID());
+
+    _isApplyingMirroredState = true;
+    _applyFunction(message, node);
+    _isApplyingMirroredState = false;
+}
+
+void MixerStandbyReplicator::handleStandbyStatePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    if (sendingNode->getType() != _mixerType) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    while (message->getBytesLeftToRead() > 0) {
+        auto nodeID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        quint8 type;
+        message->readPrimitive(&type);
+        quint32 payloadSize;
+        message->readPrimitive(&payloadSize);
+        if (payloadSize > message->getBytesLeftToRead()) {
+            qCWarning(assignment_client) << "Dropping truncated standby state from" << sendingNode->getUUID();
+            return;
+        }
+
+        StateEntry entry { static_cast<PacketType>(type), message->read(payloadSize) };
+        record(nodeID, entry.type, entry.payload);
+        if (_mode == Mode::Peers) {
+            _peerNodes.insert(nodeID, sendingNode->getUUID());
+        }
+
+        // the nodes the domain-server hasn't told us about yet get their state once it does
+        auto node = nodeList->nodeWithUUID(nodeID);
+        if (node) {
+            apply(node, entry);
+        }
+    }
+}
+
+void MixerStandbyReplicator::handleNodeAdded(SharedNodePointer node) {
+    auto state = _nodeStates.constFind(node->getUUID());
+    if (state != _nodeStates.constEnd()) {
+        for (const auto& entry : *state) {
+            apply(node, entry);
+        }
+    }
+}
+
+bool MixerStandbyReplicator::isServingNodes() const {
+    // nodes are never told about a standby, so only the active mixer has any connected to it
+    bool isServing = false;
+    DependencyManager::get<NodeList>()->eachNode([&isServing](const SharedNodePointer& node) {
+        isServing = isServing || (node->getType() == NodeType::Agent && node->getActiveSocket() && !node->isUpstream());
+    });
+    return isServing;
+}
+
+void MixerStandbyReplicator::handleNodeActivated(SharedNodePointer node) {
+    if (node->getType() != _mixerType || _nodeStates.isEmpty() || (_mode == Mode::Standby && !isServingNodes())) {
+        return;
+    }
+
+    // a peer is only sent the state of the nodes we serve, it has that of the others from their own shards
+    auto packetList = NLPacketList::create(PacketType::MixerStandbyState, QByteArray(), true, true);
+    int numNodes = 0;
+    for (auto it = _nodeStates.cbegin(); it != _nodeStates.cend(); ++it) {
+        if (_peerNodes.contains(it.key())) {
+            continue;
+        }
+        for (const auto& entry : it.value()) {
+            writeEntry(*packetList, it.key(), entry);
+        }
+        ++numNodes;
+    }
+
+    if (numNodes > 0) {
+        qCDebug(assignment_client) << "Sending the state of" << numNodes << "nodes to"
+            << (_mode == Mode::Standby ? "standby" : "peer") << node->getUUID();
+        DependencyManager::get<NodeList>()->sendPacketList(std::move(packetList), *node);
+    }
+}
+
+void MixerStandbyReplicator::handleNodeKilled(SharedNodePointer node) {
+    _nodeStates.remove(node->getUUID());
+    _peerNodes.remove(node->getUUID());
+
+    if (node->getType() == _mixerType) {
+        for (auto it = _peerNodes.begin(); it != _peerNodes.end();) {
+            if (it.value() == node->getUUID()) {
+                _nodeStates.remove(it.key());
+                it = _peerNodes.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
@@ -0,0 +1,82 @@
+//
+//  MixerStandbyReplicator.h
+//  assignment-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MixerStandbyReplicator_h
+#define hifi_MixerStandbyReplicator_h
+
+#include <functional>
+#include <vector>
+
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+
+#include <Node.h>
+#include <NLPacketList.h>
+#include <ReceivedMessage.h>
+
+/// Mirrors the per-node state a mixer builds from its nodes' control packets (codec, gains, ignores, solo) to a hot standby
+/// mixer of the same type, so that the standby already has it when the domain-server fails the nodes over to it.
+///
+/// The domain-server only lists a standby to the mixer of its type that is active, and the other way around. The control
+/// packets are kept per node, without those that later ones replaced, and applied on the standby as they would have been if
+/// the node had sent them there: all of them as the standby connects, then each as it arrives.
+///
+/// The shards of a sharded mixer are peers instead, each the only mixer of its own nodes. They mirror their nodes' ignores and
+/// avatar traits to every other shard, which applies them to the nodes it replicates from the shard, so that the ignored
+/// nodes it serves are kept from the ignoring ones too, and its own nodes see the others' avatars as they are.
+class MixerStandbyReplicator : public QObject {
+    Q_OBJECT
+public:
+    using ApplyFunction = std::function<void(QSharedPointer<ReceivedMessage>, SharedNodePointer)>;
+
+    enum class Mode {
+        Standby,
+        Peers
+    };
+
+    MixerStandbyReplicator(NodeType_t mixerType, Mode mode, ApplyFunction applyFunction, QObject* parent = nullptr);
+
+    // keeps a control packet one of our nodes sent us and forwards it to the standby, called on the mixer's thread
+    void mirrorPacket(const ReceivedMessage& message, const Node& sendingNode);
+
+private slots:
+    void handleStandbyStatePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void handleNodeAdded(SharedNodePointer node);
+    void handleNodeActivated(SharedNodePointer node);
+    void handleNodeKilled(SharedNodePointer node);
+
+private:
+    struct StateEntry {
+        PacketType type;
+        QByteArray payload;
+    };
+
+    void record(const QUuid& nodeID, PacketType type, const QByteArray& payload);
+    void apply(const SharedNodePointer& node, const StateEntry& entry);
+    bool isServingNodes() const;
+    bool isMirrored(PacketType type) const;
+
+    static void writeEntry(NLPacketList& packetList, const QUuid& nodeID, const StateEntry& entry);
+
+    NodeType_t _mixerType;
+    Mode _mode;
+    ApplyFunction _applyFunction;
+
+    QHash<QUuid, std::vector<StateEntry>> _nodeStates;
+
+    // the peer each node whose state a peer mirrored to us is served by, its state is dropped with the peer
+    QHash<QUuid, QUuid> _peerNodes;
+
+    // set while the state from the other mixer is applied, so that it isn't mirrored back
+    bool _isApplyingMirroredState { false };
+};
+
+#endif // hifi_MixerStandbyReplicator_h
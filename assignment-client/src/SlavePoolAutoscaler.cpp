@@ -0,0 +1,122 @@
+//
+//  SlavePoolAutoscaler.cpp
+//  assignment-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SlavePoolAutoscaler.h"
+
+#include <algorithm>
+
+#include <NumericalConstants.h>
+
+static const uint64_t WINDOW_USECS = USECS_PER_SECOND;
+
+static const float GROW_LOAD = 0.5f;
+static const float GROW_UTILIZATION = 0.75f;
+static const float OVERLOAD_LOAD = 1.0f; // the phases alone overran the frame, grow without waiting for a second window
+static const float SHRINK_LOAD = 0.15f;
+static const float SHRINK_UTILIZATION = 0.4f;
+
+static const int GROW_WINDOWS = 2;
+static const int SHRINK_WINDOWS = 5;
+static const int COOLDOWN_WINDOWS = 2;
+
+// a growth has to take at least this much off the load to be kept
+static const float GROWTH_BENEFIT_RATIO = 0.9f;
+static const int INITIAL_GROW_BACKOFF_WINDOWS = 10;
+static const int MAX_GROW_BACKOFF_WINDOWS = 300;
+
+void SlavePoolAutoscaler::setEnabled(bool enabled, int minThreads, int maxThreads) {
+    _isEnabled = enabled;
+    _minThreads = std::max(1, minThreads);
+    _maxThreads = std::max(_minThreads, maxThreads);
+
+    _window = Window();
+    _growVotes = _shrinkVotes = 0;
+    _cooldownWindows = 0;
+    _growBackoffWindows = INITIAL_GROW_BACKOFF_WINDOWS;
+    _windowsUntilGrowth = 0;
+    _loadBeforeGrowth = -1.0f;
+}
+
+void SlavePoolAutoscaler::recordPhase(uint64_t wallUsecs, uint64_t busyUsecs, int numThreads) {
+    _window.wallUsecs += wallUsecs;
+    _window.busyUsecs += busyUsecs;
+    _window.threadUsecs += wallUsecs * (uint64_t)std::max(1, numThreads);
+}
+
+int SlavePoolAutoscaler::change(int numThreads) {
+    _growVotes = _shrinkVotes = 0;
+    _cooldownWindows = COOLDOWN_WINDOWS;
+    return numThreads;
+}
+
+int SlavePoolAutoscaler::endFrame(uint64_t frameBudgetUsecs, int numThreads) {
+    _window.budgetUsecs += frameBudgetUsecs;
+    if (!_isEnabled || _window.budgetUsecs < WINDOW_USECS) {
+        return numThreads;
+    }
+
+    _load = (float)_window.wallUsecs / (float)_window.budgetUsecs;
+    _utilization = _window.threadUsecs > 0 ? std::min((float)_window.busyUsecs / (float)_window.threadUsecs, 1.0f) : 0.0f;
+    _window = Window();
+
+    _windowsUntilGrowth = std::max(0, _windowsUntilGrowth - 1);
+    if (_cooldownWindows > 0) {
+        --_cooldownWindows;
+        return numThreads;
+    }
+
+    if (_loadBeforeGrowth >= 0.0f) {
+        bool helped = _load < _loadBeforeGrowth * GROWTH_BENEFIT_RATIO;
+        _loadBeforeGrowth = -1.0f;
+        if (helped) {
+            _growBackoffWindows = INITIAL_GROW_BACKOFF_WINDOWS;
+        } else if (numThreads > _minThreads) {
+            // the thread had no core of its own to run on
+            _windowsUntilGrowth = _growBackoffWindows;
+            _growBackoffWindows = std::min(_growBackoffWindows * 2, MAX_GROW_BACKOFF_WINDOWS);
+            ++_numReverts;
+            return change(numThreads - 1);
+        }
+    }
+
+    bool wantsGrowth = _load > GROW_LOAD && _utilization > GROW_UTILIZATION;
+    // the load one thread less would leave, assuming the work spreads over the rest
+    float loadAfterShrink = numThreads > 1 ? _load * (float)numThreads / (float)(numThreads - 1) : _load;
+    bool wantsShrink = (_load < SHRINK_LOAD || _utilization < SHRINK_UTILIZATION) && loadAfterShrink < GROW_LOAD;
+
+    _growVotes = wantsGrowth ? _growVotes + 1 : 0;
+    _shrinkVotes = wantsShrink ? _shrinkVotes + 1 : 0;
+
+    bool isOverloaded = wantsGrowth && _load > OVERLOAD_LOAD;
+    if ((isOverloaded || _growVotes >= GROW_WINDOWS) && numThreads < _maxThreads && _windowsUntilGrowth == 0) {
+        _loadBeforeGrowth = _load;
+        ++_numGrowths;
+        return change(numThreads + 1);
+    }
+
+    if (_shrinkVotes >= SHRINK_WINDOWS && numThreads > _minThreads) {
+        ++_numShrinks;
+        return change(numThreads - 1);
+    }
+
+    return numThreads;
+}
+
+void SlavePoolAutoscaler::stats(QJsonObject& stats) {
+    stats["enabled"] = _isEnabled;
+    stats["load"] = _load;
+    stats["utilization"] = _utilization;
+    stats["max_threads"] = _maxThreads;
+    stats["growths"] = _numGrowths;
+    stats["shrinks"] = _numShrinks;
+    stats["reverted_growths"] = _numReverts;
+    _numGrowths = _numShrinks = _numReverts = 0;
+}
@@ -0,0 +1,71 @@
+//
+//  SlavePoolAutoscaler.h
+//  assignment-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SlavePoolAutoscaler_h
+#define hifi_SlavePoolAutoscaler_h
+
+#include <stdint.h>
+
+#include <QtCore/QJsonObject>
+
+// Picks the number of threads for a mixer's slave pool from how the pool's phases went over the last second of frames.
+//
+// The load is the share of the frame budget the phases took and the utilization is the share of the threads' time in the
+// phases that went to tasks rather than waiting for the others. The pool grows when it takes much of the frame with every
+// thread kept busy, and shrinks when it is idle or its threads mostly wait, as long as one thread less wouldn't put it
+// back over the growth threshold. A change needs agreeing windows in a row and is followed by a cooldown, and a growth
+// that didn't shorten the phases, because the host's cores are taken by other assignments, is undone and growing is held
+// off for longer each time.
+class SlavePoolAutoscaler {
+public:
+    void setEnabled(bool enabled, int minThreads, int maxThreads);
+    bool isEnabled() const { return _isEnabled; }
+
+    // one phase run by the pool: how long it took, the time its threads spent on tasks and how many threads it had
+    void recordPhase(uint64_t wallUsecs, uint64_t busyUsecs, int numThreads);
+
+    // ends a frame that had the budget, returns the number of threads the pool should have
+    int endFrame(uint64_t frameBudgetUsecs, int numThreads);
+
+    // the last window's load and utilization and the changes made since the last call
+    void stats(QJsonObject& stats);
+
+private:
+    int change(int numThreads);
+
+    bool _isEnabled { false };
+    int _minThreads { 1 };
+    int _maxThreads { 1 };
+
+    struct Window {
+        uint64_t wallUsecs { 0 };
+        uint64_t busyUsecs { 0 };
+        uint64_t threadUsecs { 0 };
+        uint64_t budgetUsecs { 0 };
+    };
+    Window _window;
+
+    float _load { 0.0f };
+    float _utilization { 0.0f };
+
+    int _growVotes { 0 };
+    int _shrinkVotes { 0 };
+    int _cooldownWindows { 0 };
+    int _growBackoffWindows { 0 }; // after a growth that didn't help
+    int _windowsUntilGrowth { 0 };
+    float _loadBeforeGrowth { -1.0f };
+
+    int _numGrowths { 0 };
+    int _numShrinks { 0 };
+    int _numReverts { 0 };
+};
+
+#endif // hifi_SlavePoolAutoscaler_h
@@ -0,0 +1,198 @@
+//
+//  AssetChunkIndex.cpp
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkIndex.h"
+
+#include <algorithm>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QFile>
+#include <QtCore/QRegExp>
+#include <QtCore/QSaveFile>
+
+#include "AssetServerLogging.h"
+
+static const quint32 CHUNK_LIST_VERSION = 1;
+
+AssetChunkIndex::AssetChunkIndex(const QDir& filesDirectory, const QDir& indexDirectory) :
+    _filesDirectory(filesDirectory),
+    _indexDirectory(indexDirectory)
+{
+}
+
+QStringList AssetChunkIndex::load() {
+    QRegExp hashFileRegex { AssetUtils::ASSET_HASH_REGEX_STRING };
+    auto fileHashes = _filesDirectory.entryList(QDir::Files).filter(hashFileRegex);
+    QStringList unindexedFileHashes;
+
+    for (const auto& fileHash : fileHashes) {
+        QFile listFile { _indexDirectory.filePath(fileHash) };
+        if (!listFile.open(QIODevice::ReadOnly)) {
+            unindexedFileHashes << fileHash;
+            continue;
+        }
+
+        QDataStream stream(&listFile);
+        quint32 version { 0 };
+        quint32 numChunks { 0 };
+        stream >> version >> numChunks;
+        if (version != CHUNK_LIST_VERSION) {
+            unindexedFileHashes << fileHash;
+            continue;
+        }
+
+        std::vector<AssetUtils::ContentChunk> chunks;
+        chunks.reserve(numChunks);
+        for (quint32 i = 0; i < numChunks && stream.status() == QDataStream::Ok; ++i) {
+            AssetUtils::ContentChunk chunk;
+            chunk.hash.resize(AssetUtils::SHA256_HASH_LENGTH);
+            stream.readRawData(chunk.hash.data(), chunk.hash.size());
+            quint64 offset;
+            stream >> offset >> chunk.size;
+            chunk.offset = offset;
+            chunks.push_back(chunk);
+        }
+
+        if (stream.status() == QDataStream::Ok) {
+            insertChunks(fileHash, chunks);
+        } else {
+            unindexedFileHashes << fileHash;
+        }
+    }
+
+    // drop the lists of the files deleted since
+    auto fileHashSet = fileHashes.toSet();
+    for (const auto& listName : _indexDirectory.entryList(QDir::Files)) {
+        if (!fileHashSet.contains(listName)) {
+            _indexDirectory.remove(listName);
+        }
+    }
+
+    qCInfo(asset_server) << "Loaded the chunks of" << fileHashes.size() - unindexedFileHashes.size() << "asset files,"
+                         << unindexedFileHashes.size() << "left to index";
+    return unindexedFileHashes;
+}
+
+void AssetChunkIndex::addFile(const AssetUtils::AssetHash& fileHash, const QByteArray& data) {
+    {
+        QMutexLocker lock(&_mutex);
+        if (_chunksPerFile.contains(fileHash)) {
+            return;
+        }
+    }
+
+    auto chunks = AssetUtils::chunkContent(data);
+
+    QSaveFile listFile { _indexDirectory.filePath(fileHash) };
+    if (listFile.open(QIODevice::WriteOnly)) {
+        QDataStream stream(&listFile);
+        stream << CHUNK_LIST_VERSION << (quint32)chunks.size();
+        for (const auto& chunk : chunks) {
+            stream.writeRawData(chunk.hash.constData(), chunk.hash.size());
+            stream << (quint64)chunk.offset << chunk.size;
+        }
+        if (!listFile.commit()) {
+            qCWarning(asset_server) << "Failed to write the chunk list of" << fileHash;
+        }
+    } else {
+        qCWarning(asset_server) << "Failed to open the chunk list of" << fileHash << "for writing";
+    }
+
+    insertChunks(fileHash, chunks);
+}
+
+void AssetChunkIndex::insertChunks(const AssetUtils::AssetHash& fileHash,
+                                   const std::vector<AssetUtils::ContentChunk>& chunks) {
+    QMutexLocker lock(&_mutex);
+    auto& fileChunks = _chunksPerFile[fileHash];
+    fileChunks.reserve((int)chunks.size());
+    for (const auto& chunk : chunks) {
+        _chunks[chunk.hash].push_back({ fileHash, chunk.offset, chunk.size });
+        fileChunks.push_back(chunk.hash);
+    }
+}
+
+void AssetChunkIndex::removeFile(const AssetUtils::AssetHash& fileHash) {
+    QMutexLocker lock(&_mutex);
+    auto fileIt = _chunksPerFile.find(fileHash);
+    if (fileIt == _chunksPerFile.end()) {
+        return;
+    }
+
+    for (const auto& chunkHash : *fileIt) {
+        auto chunkIt = _chunks.find(chunkHash);
+        if (chunkIt == _chunks.end()) {
+            continue;
+        }
+        auto& locations = *chunkIt;
+        locations.erase(std::remove_if(locations.begin(), locations.end(), [&](const Location& location) {
+            return location.fileHash == fileHash;
+        }), locations.end());
+        if (locations.isEmpty()) {
+            _chunks.erase(chunkIt);
+        }
+    }
+    _chunksPerFile.erase(fileIt);
+
+    _indexDirectory.remove(fileHash);
+}
+
+bool AssetChunkIndex::contains(const QByteArray& chunkHash) const {
+    QMutexLocker lock(&_mutex);
+    return _chunks.contains(chunkHash);
+}
+
+QByteArray AssetChunkIndex::readChunk(const QByteArray& chunkHash, uint32_t size) const {
+    QVector<Location> locations;
+    {
+        QMutexLocker lock(&_mutex);
+        locations = _chunks.value(chunkHash);
+    }
+
+    for (const auto& location : locations) {
+        if (location.size != size) {
+            continue;
+        }
+
+        QFile file { _filesDirectory.filePath(location.fileHash) };
+        if (file.open(QIODevice::ReadOnly) && file.seek(location.offset)) {
+            QByteArray data = file.read(size);
+            if (data.size() == (int)size && QCryptographicHash::hash(data, QCryptographicHash::Sha256) == chunkHash) {
+                return data;
+            }
+        }
+    }
+    return QByteArray();
+}
+
+int AssetChunkIndex::getNumChunks() const {
+    QMutexLocker lock(&_mutex);
+    return _chunks.size();
+}
+
+IndexAssetChunksTask::IndexAssetChunksTask(const std::shared_ptr<AssetChunkIndex>& chunkIndex, const QDir& filesDirectory,
+                                           const QStringList& fileHashes) :
+    _chunkIndex(chunkIndex),
+    _filesDirectory(filesDirectory),
+    _fileHashes(fileHashes)
+{
+}
+
+void IndexAssetChunksTask::run() {
+    for (const auto& fileHash : _fileHashes) {
+        QFile file { _filesDirectory.filePath(fileHash) };
+        if (file.open(QIODevice::ReadOnly)) {
+            _chunkIndex->addFile(fileHash, file.readAll());
+        }
+    }
+    qCInfo(asset_server) << "Indexed the chunks of" << _fileHashes.size() << "asset files";
+}
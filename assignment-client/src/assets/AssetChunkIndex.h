@@ -0,0 +1,79 @@
+//
+//  AssetChunkIndex.h
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunkIndex_h
+#define hifi_AssetChunkIndex_h
+
+#include <memory>
+
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QRunnable>
+#include <QtCore/QVector>
+
+#include <AssetChunking.h>
+#include <AssetUtils.h>
+
+/// Where the content-defined chunks (see AssetUtils::chunkContent) of the stored asset files are, so that an upload
+/// only needs to carry the chunks none of them has. Thread-safe.
+///
+/// The chunks of each file are listed in a file of the same name in the index directory, written once, when the
+/// asset file is.
+class AssetChunkIndex {
+public:
+    struct Location {
+        AssetUtils::AssetHash fileHash;
+        uint64_t offset;
+        uint32_t size;
+    };
+
+    AssetChunkIndex(const QDir& filesDirectory, const QDir& indexDirectory);
+
+    /// Read the chunk lists written before, returning the hashes of the files left to index
+    QStringList load();
+
+    void addFile(const AssetUtils::AssetHash& fileHash, const QByteArray& data);
+    void removeFile(const AssetUtils::AssetHash& fileHash);
+
+    bool contains(const QByteArray& chunkHash) const;
+
+    /// Read a chunk of a stored file, verified against its hash, or return a null QByteArray
+    QByteArray readChunk(const QByteArray& chunkHash, uint32_t size) const;
+
+    int getNumChunks() const;
+
+private:
+    void insertChunks(const AssetUtils::AssetHash& fileHash, const std::vector<AssetUtils::ContentChunk>& chunks);
+
+    QDir _filesDirectory;
+    QDir _indexDirectory;
+
+    mutable QMutex _mutex;
+    QHash<QByteArray, QVector<Location>> _chunks;
+    QHash<AssetUtils::AssetHash, QVector<QByteArray>> _chunksPerFile;
+};
+
+/// Index the asset files stored before there was a chunk index
+class IndexAssetChunksTask : public QRunnable {
+public:
+    IndexAssetChunksTask(const std::shared_ptr<AssetChunkIndex>& chunkIndex, const QDir& filesDirectory,
+                         const QStringList& fileHashes);
+
+    void run() override;
+
+private:
+    std::shared_ptr<AssetChunkIndex> _chunkIndex;
+    QDir _filesDirectory;
+    QStringList _fileHashes;
+};
+
+#endif // hifi_AssetChunkIndex_h
@@ -0,0 +1,393 @@
+//
+//  AssetMappingStore.cpp
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetMappingStore.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <QtCore/QJsonDocument>
+#include <QtCore/QSaveFile>
+
+#include "AssetServerLogging.h"
+
+namespace {
+
+const char JOURNAL_MAGIC[8] = { 'A', 'S', 'T', 'M', 'A', 'P', 'J', '\0' };
+const uint32_t JOURNAL_FORMAT_VERSION = 1;
+
+// the on-disk layouts, in host byte order since the journal never leaves the server
+struct JournalHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t reserved;
+};
+static_assert(sizeof(JournalHeader) == 16, "mapping journal header layout changed");
+
+// each record is one transaction, its operations follow the header
+struct RecordHeader {
+    uint32_t size;
+    uint16_t checksum; // of the operations, to find the records torn by a crash
+    uint16_t reserved;
+};
+static_assert(sizeof(RecordHeader) == 8, "mapping journal record layout changed");
+
+// the journal is compacted into a new snapshot once it's past half the snapshot's size, and at least this big
+const qint64 MIN_COMPACTED_JOURNAL_SIZE = 1024 * 1024;
+
+QString journalFilenameForSnapshot(const QString& snapshotFilename) {
+    return snapshotFilename + ".journal";
+}
+
+bool syncToDisk(QFile& file) {
+    if (!file.flush()) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
+
+}
+
+void AssetMappingStore::Transaction::set(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash) {
+    _operations.push_back({ Operation::Set, { path, hash } });
+}
+
+void AssetMappingStore::Transaction::remove(const AssetUtils::AssetPath& path) {
+    _operations.push_back({ Operation::Remove, { path, AssetUtils::AssetHash() } });
+}
+
+void AssetMappingStore::Transaction::clear() {
+    _operations.push_back({ Operation::Clear, { AssetUtils::AssetPath(), AssetUtils::AssetHash() } });
+}
+
+bool AssetMappingStore::load(const QString& snapshotFilename) {
+    _snapshotFilename = snapshotFilename;
+    _mappings.clear();
+    _snapshotSize = 0;
+
+    QFile snapshot { snapshotFilename };
+    if (snapshot.exists()) {
+        if (!snapshot.open(QIODevice::ReadOnly)) {
+            qCCritical(asset_server) << "Failed to read mapping file at" << snapshotFilename;
+            return false;
+        }
+        QByteArray data = snapshot.readAll();
+        _snapshotSize = data.size();
+
+        QJsonParseError error;
+        auto jsonDocument = QJsonDocument::fromJson(data, &error);
+        if (error.error != QJsonParseError::NoError) {
+            qCCritical(asset_server) << "Failed to read mapping file at" << snapshotFilename << error.errorString();
+            return false;
+        }
+        if (!jsonDocument.isObject()) {
+            qCWarning(asset_server) << "Failed to read mapping file, root value in" << snapshotFilename << "is not an object";
+            return false;
+        }
+        apply(importFromJSON(jsonDocument.object()));
+        qCInfo(asset_server) << "Loaded" << _mappings.size() << "mappings from map file at" << snapshotFilename;
+    } else {
+        qCInfo(asset_server) << "No existing mappings loaded from file since no file was found at" << snapshotFilename;
+    }
+
+    _journal.close();
+    _journal.setFileName(journalFilenameForSnapshot(snapshotFilename));
+    _journalSize = 0;
+
+    qint64 validSize = 0;
+    if (_journal.exists()) {
+        if (!_journal.open(QIODevice::ReadOnly)) {
+            qCCritical(asset_server) << "Failed to read mapping journal at" << _journal.fileName() << _journal.errorString();
+            return false;
+        }
+        QByteArray data = _journal.readAll();
+        _journal.close();
+
+        int numTransactions = 0;
+        if (replayJournal(data, validSize, numTransactions)) {
+            qCInfo(asset_server) << "Replayed" << numTransactions << "mapping transactions from" << _journal.fileName()
+                << "for" << _mappings.size() << "mappings";
+            if (validSize < data.size()) {
+                qCWarning(asset_server) << "Ignoring" << (data.size() - validSize)
+                    << "bytes of torn or corrupt mapping transactions at the end of" << _journal.fileName();
+            }
+        } else {
+            qCWarning(asset_server) << "Ignoring mapping journal" << _journal.fileName() << "since it isn't one";
+            validSize = 0;
+        }
+    }
+
+    if (validSize == 0) {
+        return resetJournal();
+    }
+
+    // drop anything after the last complete transaction, so the next one follows it directly
+    if (!_journal.open(QIODevice::ReadWrite) || !_journal.resize(validSize) || !_journal.seek(validSize)) {
+        qCCritical(asset_server) << "Cannot continue mapping journal" << _journal.fileName() << _journal.errorString();
+        _journal.close();
+        return false;
+    }
+    _journalSize = validSize;
+    return true;
+}
+
+AssetMappingStore::Range AssetMappingStore::findPrefix(const AssetUtils::AssetPath& prefix) const {
+    auto begin = _mappings.lower_bound(prefix);
+    auto end = begin;
+    while (end != _mappings.end() && end->first.startsWith(prefix)) {
+        ++end;
+    }
+    return { begin, end };
+}
+
+bool AssetMappingStore::commit(const Transaction& transaction) {
+    if (transaction.isEmpty()) {
+        return true;
+    }
+    if (!_journal.isOpen()) {
+        qCWarning(asset_server) << "Cannot commit mapping transaction without a journal";
+        return false;
+    }
+
+    QByteArray operations;
+    for (const auto& operation : transaction._operations) {
+        operations.append((char)operation.first);
+        if (operation.first == Transaction::Operation::Clear) {
+            continue;
+        }
+        QByteArray path = operation.second.first.toUtf8();
+        uint16_t pathSize = (uint16_t)std::min(path.size(), (int)UINT16_MAX);
+        operations.append((const char*)&pathSize, sizeof(pathSize));
+        operations.append(path.constData(), pathSize);
+        if (operation.first == Transaction::Operation::Set) {
+            QByteArray hash = QByteArray::fromHex(operation.second.second.toUtf8());
+            if (hash.size() != AssetUtils::SHA256_HASH_LENGTH) {
+                qCWarning(asset_server) << "Cannot commit a mapping to invalid hash" << operation.second.second;
+                return false;
+            }
+            operations.append(hash);
+        }
+    }
+
+    RecordHeader header;
+    header.size = operations.size();
+    header.checksum = qChecksum(operations.constData(), operations.size());
+    header.reserved = 0;
+
+    QByteArray record;
+    record.reserve(sizeof(header) + operations.size());
+    record.append((const char*)&header, sizeof(header));
+    record.append(operations);
+
+    if (_journal.write(record) != record.size() || !syncToDisk(_journal)) {
+        qCWarning(asset_server) << "Failed to append to mapping journal" << _journal.fileName() << _journal.errorString();
+        // a torn record hides the ones after it, so it's cut off before the next transaction
+        if (!_journal.resize(_journalSize) || !_journal.seek(_journalSize)) {
+            _journal.close();
+        }
+        return false;
+    }
+    _journalSize += record.size();
+
+    apply(transaction);
+
+    if (_journalSize > std::max(MIN_COMPACTED_JOURNAL_SIZE, _snapshotSize / 2)) {
+        // the transaction is already safe in the journal even if this fails
+        compact();
+    }
+    return true;
+}
+
+bool AssetMappingStore::compact() {
+    QSaveFile snapshot { _snapshotFilename };
+    if (!snapshot.open(QIODevice::WriteOnly)) {
+        qCWarning(asset_server) << "Failed to open map file at" << _snapshotFilename;
+        return false;
+    }
+
+    QByteArray data = QJsonDocument(exportToJSON()).toJson();
+    if (snapshot.write(data) != data.size()) {
+        qCWarning(asset_server) << "Failed to write JSON mappings to file at" << _snapshotFilename;
+        return false;
+    }
+    if (!snapshot.commit()) {
+        qCWarning(asset_server) << "Failed to commit JSON mappings to file at" << _snapshotFilename;
+        return false;
+    }
+    _snapshotSize = data.size();
+    qCDebug(asset_server) << "Wrote" << _mappings.size() << "JSON mappings to file at" << _snapshotFilename;
+
+    return resetJournal();
+}
+
+bool AssetMappingStore::isCompacted() const {
+    return !_journal.isOpen() || _journalSize <= (qint64)sizeof(JournalHeader);
+}
+
+QJsonObject AssetMappingStore::exportToJSON() const {
+    QJsonObject root;
+    for (const auto& mapping : _mappings) {
+        root[mapping.first] = mapping.second;
+    }
+    return root;
+}
+
+AssetMappingStore::Transaction AssetMappingStore::importFromJSON(const QJsonObject& root) {
+    Transaction transaction;
+    transaction.clear();
+    for (auto it = root.begin(); it != root.end(); ++it) {
+        auto key = it.key();
+        auto value = it.value();
+
+        if (!value.isString()) {
+            qCWarning(asset_server) << "Skipping" << key << ":" << value << "because it is not a string";
+            continue;
+        }
+
+        if (!AssetUtils::isValidFilePath(key)) {
+            qCWarning(asset_server) << "Will not keep mapping for" << key << "since it is not a valid path.";
+            continue;
+        }
+
+        if (!AssetUtils::isValidHash(value.toString())) {
+            qCWarning(asset_server) << "Will not keep mapping for" << key << "since it does not have a valid hash.";
+            continue;
+        }
+
+        transaction.set(key, value.toString());
+    }
+    return transaction;
+}
+
+bool AssetMappingStore::resetJournal() {
+    _journal.close();
+    _journalSize = 0;
+
+    if (!_journal.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCCritical(asset_server) << "Cannot open mapping journal" << _journal.fileName() << "for writing:"
+            << _journal.errorString();
+        return false;
+    }
+
+    JournalHeader header;
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.formatVersion = JOURNAL_FORMAT_VERSION;
+    header.reserved = 0;
+
+    if (_journal.write((const char*)&header, sizeof(header)) != (qint64)sizeof(header) || !syncToDisk(_journal)) {
+        qCCritical(asset_server) << "Cannot write mapping journal header to" << _journal.fileName() << _journal.errorString();
+        _journal.close();
+        return false;
+    }
+    _journalSize = sizeof(header);
+    return true;
+}
+
+bool AssetMappingStore::replayJournal(const QByteArray& data, qint64& validSize, int& numTransactions) {
+    validSize = 0;
+    numTransactions = 0;
+
+    JournalHeader header;
+    if (data.size() < (int)sizeof(header)) {
+        return false;
+    }
+    memcpy(&header, data.constData(), sizeof(header));
+    if (memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0 || header.formatVersion != JOURNAL_FORMAT_VERSION) {
+        return false;
+    }
+
+    qint64 offset = sizeof(header);
+    while (data.size() - offset >= (qint64)sizeof(RecordHeader)) {
+        RecordHeader recordHeader;
+        memcpy(&recordHeader, data.constData() + offset, sizeof(recordHeader));
+        const char* operations = data.constData() + offset + sizeof(recordHeader);
+        qint64 available = data.size() - offset - (qint64)sizeof(recordHeader);
+        if (recordHeader.size > available || qChecksum(operations, recordHeader.size) != recordHeader.checksum) {
+            break;
+        }
+
+        // the whole transaction is decoded before any of it is applied
+        Transaction transaction;
+        bool isValid = true;
+        const char* cursor = operations;
+        const char* end = operations + recordHeader.size;
+        while (isValid && cursor < end) {
+            auto operation = (Transaction::Operation)*cursor++;
+            if (operation == Transaction::Operation::Clear) {
+                transaction.clear();
+                continue;
+            }
+            if (operation != Transaction::Operation::Set && operation != Transaction::Operation::Remove) {
+                isValid = false;
+                break;
+            }
+
+            uint16_t pathSize;
+            if (end - cursor < (qint64)sizeof(pathSize)) {
+                isValid = false;
+                break;
+            }
+            memcpy(&pathSize, cursor, sizeof(pathSize));
+            cursor += sizeof(pathSize);
+            qint64 hashSize = operation == Transaction::Operation::Set ? AssetUtils::SHA256_HASH_LENGTH : 0;
+            if (end - cursor < pathSize + hashSize) {
+                isValid = false;
+                break;
+            }
+            auto path = QString::fromUtf8(cursor, pathSize);
+            cursor += pathSize;
+
+            if (operation == Transaction::Operation::Set) {
+                transaction.set(path, QByteArray(cursor, (int)hashSize).toHex());
+                cursor += hashSize;
+            } else {
+                transaction.remove(path);
+            }
+        }
+        if (!isValid) {
+            break;
+        }
+
+        apply(transaction);
+        ++numTransactions;
+        offset += sizeof(recordHeader) + recordHeader.size;
+    }
+
+    validSize = offset;
+    return true;
+}
+
+void AssetMappingStore::apply(const Transaction& transaction) {
+    for (const auto& operation : transaction._operations) {
+        switch (operation.first) {
+            case Transaction::Operation::Set:
+                _mappings[operation.second.first] = operation.second.second;
+                break;
+            case Transaction::Operation::Remove:
+                _mappings.erase(operation.second.first);
+                break;
+            case Transaction::Operation::Clear:
+                _mappings.clear();
+                break;
+        }
+    }
+}
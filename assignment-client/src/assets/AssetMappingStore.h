@@ -0,0 +1,97 @@
+//
+//  AssetMappingStore.h
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetMappingStore_h
+#define hifi_AssetMappingStore_h
+
+#include <utility>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonObject>
+
+#include <AssetUtils.h>
+
+/// The asset server's path to hash mappings, kept in memory and persisted as a JSON snapshot of all of them, the
+/// mapping file, plus a journal of the transactions committed since.
+///
+/// Each transaction is appended to the journal as one record and synced to disk before it's applied, so a change costs
+/// the size of the change rather than of all the mappings. A crash while a record is written leaves it torn, and it
+/// is dropped on the next load along with its whole transaction. Once the journal outgrows half the snapshot, the
+/// mappings are written to a new snapshot and the journal starts over.
+///
+/// Replaying a journal over the snapshot it was written after, or over one written after it, gives the same mappings,
+/// so a crash between writing a snapshot and clearing its journal loses nothing either.
+///
+/// Not thread-safe, it's used from the main assignment thread only.
+class AssetMappingStore {
+public:
+    class Transaction {
+    public:
+        void set(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& hash);
+        void remove(const AssetUtils::AssetPath& path);
+        /// Remove every mapping, before the operations that follow it
+        void clear();
+
+        bool isEmpty() const { return _operations.empty(); }
+
+    private:
+        friend class AssetMappingStore;
+
+        enum class Operation : uint8_t {
+            Set = 0,
+            Remove = 1,
+            Clear = 2
+        };
+
+        std::vector<std::pair<Operation, std::pair<AssetUtils::AssetPath, AssetUtils::AssetHash>>> _operations;
+    };
+
+    using ConstIterator = AssetUtils::Mappings::const_iterator;
+    using Range = std::pair<ConstIterator, ConstIterator>;
+
+    /// Load the snapshot and replay the journal written after it, then continue the journal
+    bool load(const QString& snapshotFilename);
+
+    const AssetUtils::Mappings& getMappings() const { return _mappings; }
+
+    /// The mappings of the paths that begin with the prefix, in order
+    Range findPrefix(const AssetUtils::AssetPath& prefix) const;
+
+    /// Persist the transaction, then apply it. Returns false, leaving the mappings as they were, if it couldn't be
+    /// written.
+    bool commit(const Transaction& transaction);
+
+    /// Write the mappings to a new snapshot and start an empty journal, so the snapshot alone holds all of them
+    bool compact();
+
+    /// The mappings as in the snapshot, valid paths to valid hashes
+    QJsonObject exportToJSON() const;
+    /// A transaction that replaces the mappings with the valid ones of the JSON object
+    static Transaction importFromJSON(const QJsonObject& root);
+
+    /// Whether the snapshot alone holds all the mappings
+    bool isCompacted() const;
+
+private:
+    bool resetJournal();
+    bool replayJournal(const QByteArray& data, qint64& validSize, int& numTransactions);
+    void apply(const Transaction& transaction);
+
+    AssetUtils::Mappings _mappings;
+
+    QString _snapshotFilename;
+    QFile _journal;
+    qint64 _journalSize { 0 };
+    qint64 _snapshotSize { 0 };
+};
+
+#endif // hifi_AssetMappingStore_h
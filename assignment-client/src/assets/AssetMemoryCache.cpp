@@ -0,0 +1,72 @@
+//
+//  AssetMemoryCache.cpp
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetMemoryCache.h"
+
+const qint64 AssetMemoryCache::DEFAULT_MAX_SIZE = 256 * 1024 * 1024;
+
+AssetMemoryCache::Content AssetMemoryCache::get(const QString& hash) {
+    QMutexLocker locker(&_mutex);
+    auto itr = _entriesByHash.find(hash);
+    if (itr == _entriesByHash.end()) {
+        _numMisses++;
+        return Content();
+    }
+
+    _numHits++;
+    _entries.splice(_entries.begin(), _entries, itr.value());
+    return itr.value()->second;
+}
+
+void AssetMemoryCache::insert(const QString& hash, const Content& content) {
+    if (!content || !canCache(content->size())) {
+        return;
+    }
+
+    QMutexLocker locker(&_mutex);
+    if (_entriesByHash.contains(hash)) {
+        // another task read it meanwhile
+        return;
+    }
+    _entries.emplace_front(hash, content);
+    _entriesByHash.insert(hash, _entries.begin());
+    _size += content->size();
+    _numEntries++;
+    evict();
+}
+
+void AssetMemoryCache::remove(const QString& hash) {
+    QMutexLocker locker(&_mutex);
+    auto itr = _entriesByHash.find(hash);
+    if (itr != _entriesByHash.end()) {
+        _size -= itr.value()->second->size();
+        _numEntries--;
+        _entries.erase(itr.value());
+        _entriesByHash.erase(itr);
+    }
+}
+
+void AssetMemoryCache::setMaxSize(qint64 maxSize) {
+    QMutexLocker locker(&_mutex);
+    _maxSize = maxSize;
+    evict();
+}
+
+void AssetMemoryCache::evict() {
+    // the tasks still sending an evicted asset keep its content alive until they're done
+    while (_size > _maxSize && !_entries.empty()) {
+        const auto& entry = _entries.back();
+        _size -= entry.second->size();
+        _numEntries--;
+        _entriesByHash.remove(entry.first);
+        _entries.pop_back();
+    }
+}
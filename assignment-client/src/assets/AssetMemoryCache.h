@@ -0,0 +1,67 @@
+//
+//  AssetMemoryCache.h
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetMemoryCache_h
+#define hifi_AssetMemoryCache_h
+
+#include <atomic>
+#include <list>
+#include <memory>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+// The contents of the assets served most recently, shared by the SendAssetTasks so that an asset requested by many
+// clients at once is read from disk once.  Assets are addressed by the hash of their content, so an entry only goes
+// stale when its file is deleted.
+class AssetMemoryCache {
+public:
+    using Content = std::shared_ptr<const QByteArray>;
+
+    static const qint64 DEFAULT_MAX_SIZE;
+
+    // Returns the content of the asset, or null if it isn't cached
+    Content get(const QString& hash);
+
+    // Whether an asset of size would be kept; the larger ones would evict too much of the cache
+    bool canCache(qint64 size) const { return size > 0 && size <= _maxSize / MAX_ENTRY_FRACTION; }
+    void insert(const QString& hash, const Content& content);
+    void remove(const QString& hash);
+
+    void setMaxSize(qint64 maxSize);
+    qint64 getMaxSize() const { return _maxSize; }
+    qint64 getSize() const { return _size; }
+    int getNumEntries() const { return _numEntries; }
+    uint64_t getNumHits() const { return _numHits; }
+    uint64_t getNumMisses() const { return _numMisses; }
+
+private:
+    static const qint64 MAX_ENTRY_FRACTION { 4 };
+
+    using Entries = std::list<std::pair<QString, Content>>;
+
+    void evict();
+
+    QMutex _mutex;
+    // by last use, most recent first
+    Entries _entries;
+    QHash<QString, Entries::iterator> _entriesByHash;
+
+    std::atomic<qint64> _maxSize { DEFAULT_MAX_SIZE };
+    std::atomic<qint64> _size { 0 };
+    std::atomic<int> _numEntries { 0 };
+    std::atomic<uint64_t> _numHits { 0 };
+    std::atomic<uint64_t> _numMisses { 0 };
+};
+
+#endif // hifi_AssetMemoryCache_h
@@ -12,6 +12,7 @@
 
 #include "AssetServer.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
@@ -33,6 +34,7 @@
 #include <NodeType.h>
 #include <SharedUtil.h>
 #include <PathUtils.h>
+#include <PerformanceCounters.h>
 #include <image/TextureProcessing.h>
 
 #include "AssetServerLogging.h"
@@ -116,7 +118,13 @@ const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) {
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
-    if (it == _pendingBakes.end()) {
+    if (it == _pendingBakes.end() && !_remoteBakes.contains(assetHash)) {
+        if (!_bakeWorkers.isEmpty()) {
+            // the bake workers take the baking off this host
+            queueRemoteBake(assetHash, assetPath);
+            return;
+        }
+
         auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
         task->setAutoDelete(false);
         _pendingBakes[assetHash] = task;
@@ -131,6 +139,191 @@ void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetU
     }
 }
 
+void AssetServer::queueRemoteBake(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath) {
+    _remoteBakes[assetHash] = { assetPath, QUuid() };
+    _queuedRemoteBakes.push_back(assetHash);
+    dispatchRemoteBakes();
+}
+
+void AssetServer::dispatchRemoteBakes() {
+    auto nodeList = DependencyManager::get<NodeList>();
+
+    while (!_idleBakeWorkers.isEmpty() && !_queuedRemoteBakes.empty()) {
+        auto assetHash = _queuedRemoteBakes.front();
+        _queuedRemoteBakes.pop_front();
+
+        auto it = _remoteBakes.find(assetHash);
+        if (it == _remoteBakes.end() || !it->workerID.isNull()) {
+            // this bake was dropped, or was queued more than once and is handed out already
+            continue;
+        }
+
+        auto workerID = *_idleBakeWorkers.begin();
+        _idleBakeWorkers.erase(_idleBakeWorkers.begin());
+        auto worker = nodeList->nodeWithUUID(workerID);
+        if (!worker) {
+            _queuedRemoteBakes.push_front(assetHash);
+            continue;
+        }
+
+        QFile file { getPathToAssetHash(assetHash) };
+        if (!file.open(QIODevice::ReadOnly)) {
+            _idleBakeWorkers.insert(workerID);
+            auto assetPath = it->assetPath;
+            _remoteBakes.erase(it);
+            handleFailedBake(assetHash, assetPath, "Could not read asset to bake");
+            continue;
+        }
+
+        auto type = assetTypeForFilename(it->assetPath);
+
+        auto packetList = NLPacketList::create(PacketType::BakeJob, QByteArray(), true, true);
+        packetList->setPriority(udt::Packet::Priority::Bulk);
+        packetList->write(QByteArray::fromHex(assetHash.toLatin1()));
+        packetList->writeString(it->assetPath);
+        packetList->writePrimitive((qint32)currentBakeVersionForAssetType(type));
+        packetList->write(file.readAll());
+        nodeList->sendPacketList(std::move(packetList), *worker);
+
+        qCDebug(asset_server) << "Handed bake of" << it->assetPath << "to bake worker" << workerID;
+        it->workerID = workerID;
+    }
+}
+
+void AssetServer::handleBakeJobRequest(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (senderNode->getType() != NodeType::BakeWorker) {
+        return;
+    }
+
+    auto workerID = senderNode->getUUID();
+    if (!_bakeWorkers.contains(workerID)) {
+        qCInfo(asset_server) << "Bake worker" << workerID << "is available";
+        _bakeWorkers.insert(workerID);
+
+        // the bakes that have yet to start on this host go to the workers instead
+        auto it = _pendingBakes.begin();
+        while (it != _pendingBakes.end()) {
+            if (_bakingTaskPool.tryTake(it->get())) {
+                auto assetHash = it.key();
+                auto assetPath = it.value()->getAssetPath();
+                it = _pendingBakes.erase(it);
+                queueRemoteBake(assetHash, assetPath);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    _idleBakeWorkers.insert(workerID);
+    dispatchRemoteBakes();
+}
+
+void AssetServer::handleBakeJobResult(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (senderNode->getType() != NodeType::BakeWorker) {
+        return;
+    }
+
+    QByteArray assetHashData = message->read(AssetUtils::SHA256_HASH_LENGTH);
+    AssetUtils::AssetHash assetHash = assetHashData.toHex();
+    AssetUtils::BakeJobResultType type;
+    message->readPrimitive(&type);
+
+    auto it = _remoteBakes.find(assetHash);
+    if (it == _remoteBakes.end()) {
+        // we don't need this bake (any more), the worker keeps it in case we do again
+        qCDebug(asset_server) << "Ignoring bake result for" << assetHash << "from bake worker" << senderNode->getUUID();
+        return;
+    }
+
+    if (type == AssetUtils::BakeJobAborted) {
+        if (it->workerID == senderNode->getUUID()) {
+            it->workerID = QUuid();
+            _queuedRemoteBakes.push_front(assetHash);
+            dispatchRemoteBakes();
+        }
+        return;
+    }
+
+    auto assetPath = it->assetPath;
+    _remoteBakes.erase(it);
+
+    if (type == AssetUtils::BakeJobFailed) {
+        handleFailedBake(assetHash, assetPath, message->readString());
+    } else {
+        // lay the baked files out the way the Oven does, so that they are completed like those of a local bake
+        QString errors;
+        QString tempOutputDir = PathUtils::generateTemporaryDir();
+        QDir outputDir(tempOutputDir);
+        QString bakeDirectoryName = assetPath.split("/").last();
+        QDir bakedDirectory(outputDir.filePath(bakeDirectoryName + "/baked"));
+        if (tempOutputDir.isEmpty() || !outputDir.mkpath(bakeDirectoryName + "/baked") ||
+            !outputDir.mkpath(bakeDirectoryName + "/original")) {
+            errors = "Could not create temporary working directory";
+        } else {
+            uint32_t numFiles { 0 };
+            message->readPrimitive(&numFiles);
+            for (uint32_t i = 0; i < numFiles && errors.isEmpty(); ++i) {
+                QString relativeFilePath = QDir::cleanPath(message->readString());
+                qint64 size { -1 };
+                message->readPrimitive(&size);
+                if (relativeFilePath.isEmpty() || QDir::isAbsolutePath(relativeFilePath) || relativeFilePath.startsWith("..") ||
+                    size < 0 || size > message->getBytesLeftToRead()) {
+                    errors = "Received malformed bake result";
+                    break;
+                }
+
+                auto filePath = bakedDirectory.filePath(relativeFilePath);
+                QFile file { filePath };
+                if (!bakedDirectory.mkpath(QFileInfo(filePath).path()) || !file.open(QIODevice::WriteOnly) ||
+                    file.write(message->read(size)) != size) {
+                    errors = "Failed to write baked file " + relativeFilePath;
+                }
+            }
+        }
+
+        if (errors.isEmpty()) {
+            handleCompletedBake(assetHash, assetPath, tempOutputDir);
+        } else {
+            PathUtils::deleteMyTemporaryDir(QDir(tempOutputDir).dirName());
+            handleFailedBake(assetHash, assetPath, errors);
+        }
+    }
+
+    // the worker can let go of the result now that it is ours
+    auto replyPacket = NLPacket::create(PacketType::BakeJobResultReply, AssetUtils::SHA256_HASH_LENGTH, true);
+    replyPacket->write(assetHashData);
+    DependencyManager::get<NodeList>()->sendPacket(std::move(replyPacket), *senderNode);
+}
+
+void AssetServer::nodeKilled(SharedNodePointer killedNode) {
+    auto workerID = killedNode->getUUID();
+    if (killedNode->getType() != NodeType::BakeWorker || !_bakeWorkers.remove(workerID)) {
+        return;
+    }
+
+    qCInfo(asset_server) << "Lost bake worker" << workerID;
+    _idleBakeWorkers.remove(workerID);
+
+    for (auto it = _remoteBakes.begin(); it != _remoteBakes.end(); ++it) {
+        if (it->workerID == workerID) {
+            it->workerID = QUuid();
+            _queuedRemoteBakes.push_front(it.key());
+        }
+    }
+
+    if (_bakeWorkers.isEmpty()) {
+        // with no workers left, this host bakes again
+        auto remoteBakes = _remoteBakes;
+        _remoteBakes.clear();
+        _queuedRemoteBakes.clear();
+        for (auto it = remoteBakes.cbegin(); it != remoteBakes.cend(); ++it) {
+            bakeAsset(it.key(), it->assetPath, getPathToAssetHash(it.key()));
+        }
+    } else {
+        dispatchRemoteBakes();
+    }
+}
+
 QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash) {
     return _filesDirectory.absoluteFilePath(assetHash);
 }
@@ -141,6 +334,11 @@ std::pair<AssetUtils::BakingStatus, QString> AssetServer::getAssetStatus(const A
         return { (*it)->isBaking() ? AssetUtils::Baking : AssetUtils::Pending, "" };
     }
 
+    auto remoteIt = _remoteBakes.find(hash);
+    if (remoteIt != _remoteBakes.end()) {
+        return { remoteIt->workerID.isNull() ? AssetUtils::Pending : AssetUtils::Baking, "" };
+    }
+
     if (path.startsWith(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER)) {
         return { AssetUtils::Baked, "" };
     }
@@ -308,7 +506,9 @@ AssetServer::AssetServer(ReceivedMessage& message) :
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload, PacketType::AssetMappingOperation },
+    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload,
+                                              PacketType::AssetUploadManifest, PacketType::AssetDeltaUpload,
+                                              PacketType::AssetMappingOperation },
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::queueRequests));
 
 #ifdef Q_OS_WIN
@@ -349,6 +549,11 @@ void AssetServer::aboutToFinish() {
     while (_pendingBakes.size() > 0) {
         QCoreApplication::processEvents();
     }
+
+    // leave all the mappings in the mapping file, for whatever backs it up or reads it while the server is down
+    if (!_mappingStore.isCompacted()) {
+        _mappingStore.compact();
+    }
 }
 
 void AssetServer::run() {
@@ -364,6 +569,7 @@ void AssetServer::run() {
 }
 
 static const QString ASSET_FILES_SUBDIR = "files";
+static const QString ASSET_CHUNKS_SUBDIR = "chunks";
 
 void AssetServer::completeSetup() {
     auto nodeList = DependencyManager::get<NodeList>();
@@ -425,6 +631,9 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    _resourcesDirectory.mkpath(ASSET_CHUNKS_SUBDIR);
+    _chunkIndex = std::make_shared<AssetChunkIndex>(_filesDirectory, QDir(_resourcesDirectory.filePath(ASSET_CHUNKS_SUBDIR)));
+
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
@@ -442,7 +651,13 @@ void AssetServer::completeSetup() {
             cleanupBakedFilesForDeletedAssets();
         }
 
-        nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
+        auto unindexedFileHashes = _chunkIndex->load();
+        if (!unindexedFileHashes.isEmpty()) {
+            _transferTaskPool.start(new IndexAssetChunksTask(_chunkIndex, _filesDirectory, unindexedFileHashes));
+        }
+
+        nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer, NodeType::BakeWorker });
+        connect(nodeList.data(), &NodeList::nodeKilled, this, &AssetServer::nodeKilled);
 
         bakeAssets();
     } else {
@@ -459,6 +674,15 @@ void AssetServer::completeSetup() {
         _filesizeLimit = assetsFilesizeLimit * BITS_PER_MEGABITS;
     }
 
+    // get the size of the memory cache of the assets served most, in MB
+    static const QString ASSETS_MEMORY_CACHE_SIZE_OPTION = "assets_memory_cache_size";
+    static const qint64 BYTES_PER_MEGABYTE = 1024 * 1024;
+    auto memoryCacheSizeJSONValue = assetServerObject[ASSETS_MEMORY_CACHE_SIZE_OPTION];
+    if (memoryCacheSizeJSONValue.isDouble()) {
+        _memoryCache->setMaxSize(std::max(0, memoryCacheSizeJSONValue.toInt()) * BYTES_PER_MEGABYTE);
+    }
+    qCInfo(asset_server) << "Caching up to" << _memoryCache->getMaxSize() / BYTES_PER_MEGABYTE << "MB of assets in memory";
+
     PathUtils::removeTemporaryApplicationDirs();
     PathUtils::removeTemporaryApplicationDirs("Oven");
 
@@ -471,8 +695,16 @@ void AssetServer::completeSetup() {
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetGetInfo));
     packetReceiver.registerListener(PacketType::AssetUpload,
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetUpload));
+    packetReceiver.registerListener(PacketType::AssetDeltaUpload,
+        PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetUpload));
+    packetReceiver.registerListener(PacketType::AssetUploadManifest,
+        PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetUploadManifest));
     packetReceiver.registerListener(PacketType::AssetMappingOperation,
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetMappingOperation));
+    packetReceiver.registerListener(PacketType::BakeJobRequest,
+        PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleBakeJobRequest));
+    packetReceiver.registerListener(PacketType::BakeJobResult,
+        PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleBakeJobResult));
 
     replayRequests();
 }
@@ -510,8 +742,12 @@ void AssetServer::replayRequests() {
                 handleAssetGetInfo(request.first, request.second);
                 break;
             case PacketType::AssetUpload:
+            case PacketType::AssetDeltaUpload:
                 handleAssetUpload(request.first, request.second);
                 break;
+            case PacketType::AssetUploadManifest:
+                handleAssetUploadManifest(request.first, request.second);
+                break;
             case PacketType::AssetMappingOperation:
                 handleAssetMappingOperation(request.first, request.second);
                 break;
@@ -545,6 +781,8 @@ void AssetServer::cleanupUnmappedFiles() {
 
                 if (removeableFile.remove()) {
                     qCDebug(asset_server) << "\tDeleted" << filename << "from asset files directory since it is unmapped.";
+                    _memoryCache->remove(filename);
+                    _chunkIndex->removeFile(filename);
 
                     removeBakedPathsForDeletedAsset(filename);
                 } else {
@@ -560,16 +798,15 @@ void AssetServer::cleanupBakedFilesForDeletedAssets() {
 
     std::set<AssetUtils::AssetHash> bakedHashes;
 
-    for (const auto& it : _fileMappings) {
-        // check if this is a mapping to baked content
-        if (it.first.startsWith(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER)) {
-            // extract the hash from the baked mapping
-            AssetUtils::AssetHash hash = it.first.mid(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER.length(),
-                                                      AssetUtils::SHA256_HASH_HEX_LENGTH);
+    // the mappings to baked content are the ones in the hidden baked folder
+    auto bakedRange = _mappingStore.findPrefix(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER);
+    for (auto it = bakedRange.first; it != bakedRange.second; ++it) {
+        // extract the hash from the baked mapping
+        AssetUtils::AssetHash hash = it->first.mid(AssetUtils::HIDDEN_BAKED_CONTENT_FOLDER.length(),
+                                                   AssetUtils::SHA256_HASH_HEX_LENGTH);
 
-            // add the hash to our set of hashes for which we have baked content
-            bakedHashes.insert(hash);
-        }
+        // add the hash to our set of hashes for which we have baked content
+        bakedHashes.insert(hash);
     }
 
     // enumerate the hashes for which we have baked content
@@ -872,7 +1109,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _memoryCache);
     _transferTaskPool.start(task);
 }
 
@@ -886,7 +1123,7 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit, _chunkIndex);
         _transferTaskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -912,6 +1149,58 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     }
 }
 
+void AssetServer::handleAssetUploadManifest(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    uint64_t fileSize { 0 };
+    message->readPrimitive(&fileSize);
+
+    bool canWriteToAssetServer = true;
+    if (senderNode) {
+        canWriteToAssetServer = senderNode->getCanWriteToAssetServer();
+    }
+
+    auto replyPacketList = NLPacketList::create(PacketType::AssetUploadManifestReply, QByteArray(), true, true);
+    replyPacketList->writePrimitive(messageID);
+
+    if (!canWriteToAssetServer) {
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::PermissionDenied);
+    } else if (fileSize > _filesizeLimit) {
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+    } else {
+        // reply with the indices of the chunks none of our files has, those the upload has to carry
+        uint32_t numChunks { 0 };
+        message->readPrimitive(&numChunks);
+
+        QVector<uint32_t> missingChunks;
+        for (uint32_t i = 0; i < numChunks && message->getBytesLeftToRead() > 0; ++i) {
+            QByteArray chunkHash = message->read(AssetUtils::SHA256_HASH_LENGTH);
+            uint32_t chunkSize { 0 };
+            message->readPrimitive(&chunkSize);
+            if (!_chunkIndex->contains(chunkHash)) {
+                missingChunks.push_back(i);
+            }
+        }
+
+        qCDebug(asset_server) << "Upload of" << fileSize << "bytes is missing" << missingChunks.size() << "of" << numChunks
+                              << "chunks";
+
+        replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+        replyPacketList->writePrimitive((uint32_t)missingChunks.size());
+        for (auto index : missingChunks) {
+            replyPacketList->writePrimitive(index);
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (senderNode) {
+        nodeList->sendPacketList(std::move(replyPacketList), *senderNode);
+    } else {
+        nodeList->sendPacketList(std::move(replyPacketList), message->getSenderSockAddr());
+    }
+}
+
 void AssetServer::sendStatsPacket() {
     QJsonObject serverStats;
 
@@ -965,6 +1254,37 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    static auto& activeTransfers = PerformanceCounters::getInstance().gauge("active_transfers",
+        "Asset uploads and downloads being handled");
+    static auto& pendingBakes = PerformanceCounters::getInstance().gauge("pending_bakes", "Assets waiting to be baked");
+    activeTransfers.set(_transferTaskPool.activeThreadCount());
+    pendingBakes.set(_pendingBakes.size());
+
+    uint64_t numHits = _memoryCache->getNumHits();
+    uint64_t numMisses = _memoryCache->getNumMisses();
+    QJsonObject memoryCacheStats;
+    memoryCacheStats["1. Hits"] = (double)numHits;
+    memoryCacheStats["2. Misses"] = (double)numMisses;
+    memoryCacheStats["3. Hit Rate (%)"] = numHits + numMisses > 0 ? 100.0 * numHits / (numHits + numMisses) : 0.0;
+    memoryCacheStats["4. Assets"] = _memoryCache->getNumEntries();
+    memoryCacheStats["5. Size (MB)"] = (double)_memoryCache->getSize() / (1024.0 * 1024.0);
+    serverStats["Memory Cache"] = memoryCacheStats;
+
+    if (_chunkIndex) {
+        serverStats["Indexed Chunks"] = _chunkIndex->getNumChunks();
+    }
+
+    int numRemoteBakesRunning = 0;
+    for (const auto& remoteBake : _remoteBakes) {
+        numRemoteBakesRunning += remoteBake.workerID.isNull() ? 0 : 1;
+    }
+    QJsonObject bakeWorkerStats;
+    bakeWorkerStats["1. Workers"] = _bakeWorkers.size();
+    bakeWorkerStats["2. Idle Workers"] = _idleBakeWorkers.size();
+    bakeWorkerStats["3. Queued Bakes"] = _remoteBakes.size() - numRemoteBakesRunning;
+    bakeWorkerStats["4. Running Bakes"] = numRemoteBakesRunning;
+    serverStats["Bake Workers"] = bakeWorkerStats;
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -972,90 +1292,7 @@ void AssetServer::sendStatsPacket() {
 static const QString MAP_FILE_NAME = "map.json";
 
 bool AssetServer::loadMappingsFromFile() {
-
-    auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
-
-    QFile mapFile { mapFilePath };
-    if (mapFile.exists()) {
-        if (mapFile.open(QIODevice::ReadOnly)) {
-            QJsonParseError error;
-
-            auto jsonDocument = QJsonDocument::fromJson(mapFile.readAll(), &error);
-
-            if (error.error == QJsonParseError::NoError) {
-                if (!jsonDocument.isObject()) {
-                    qCWarning(asset_server) << "Failed to read mapping file, root value in" << mapFilePath << "is not an object";
-                    return false;
-                }
-
-                //_fileMappings = jsonDocument.object().toVariantHash();
-                auto root = jsonDocument.object();
-                for (auto it = root.begin(); it != root.end(); ++it) {
-                    auto key = it.key();
-                    auto value = it.value();
-
-                    if (!value.isString()) {
-                        qCWarning(asset_server) << "Skipping" << key << ":" << value << "because it is not a string";
-                        continue;
-                    }
-
-                    if (!AssetUtils::isValidFilePath(key)) {
-                        qCWarning(asset_server) << "Will not keep mapping for" << key << "since it is not a valid path.";
-                        continue;
-                    }
-
-                    if (!AssetUtils::isValidHash(value.toString())) {
-                        qCWarning(asset_server) << "Will not keep mapping for" << key << "since it does not have a valid hash.";
-                        continue;
-                    }
-
-
-                    qDebug() << "Added " << key << value.toString();
-                    _fileMappings[key] = value.toString();
-                }
-
-                qCInfo(asset_server) << "Loaded" << _fileMappings.size() << "mappings from map file at" << mapFilePath;
-                return true;
-            }
-        }
-
-        qCCritical(asset_server) << "Failed to read mapping file at" << mapFilePath;
-        return false;
-    } else {
-        qCInfo(asset_server) << "No existing mappings loaded from file since no file was found at" << mapFilePath;
-    }
-
-    return true;
-}
-
-bool AssetServer::writeMappingsToFile() {
-    auto mapFilePath = _resourcesDirectory.absoluteFilePath(MAP_FILE_NAME);
-
-    QSaveFile mapFile { mapFilePath };
-    if (mapFile.open(QIODevice::WriteOnly)) {
-        QJsonObject root;
-
-        for (auto it : _fileMappings) {
-            root[it.first] = it.second;
-        }
-
-        QJsonDocument jsonDocument { root };
-
-        if (mapFile.write(jsonDocument.toJson()) != -1) {
-            if (mapFile.commit()) {
-                qCDebug(asset_server) << "Wrote JSON mappings to file at" << mapFilePath;
-                return true;
-            } else {
-                qCWarning(asset_server) << "Failed to commit JSON mappings to file at" << mapFilePath;
-            }
-        } else {
-            qCWarning(asset_server) << "Failed to write JSON mappings to file at" << mapFilePath;
-        }
-    } else {
-        qCWarning(asset_server) << "Failed to open map file at" << mapFilePath;
-    }
-
-    return false;
+    return _mappingStore.load(_resourcesDirectory.absoluteFilePath(MAP_FILE_NAME));
 }
 
 bool AssetServer::setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash hash) {
@@ -1071,27 +1308,15 @@ bool AssetServer::setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash h
         return false;
     }
 
-    // remember what the old mapping was in case persistence fails
-    auto it = _fileMappings.find(path);
-    auto oldMapping = it != _fileMappings.end() ? it->second : "";
-
-    // update the in memory QHash
-    _fileMappings[path] = hash;
+    AssetMappingStore::Transaction transaction;
+    transaction.set(path, hash);
 
-    // attempt to write to file
-    if (writeMappingsToFile()) {
-        // persistence succeeded, we are good to go
+    // the in memory mappings only change once the transaction is persisted
+    if (_mappingStore.commit(transaction)) {
         qCDebug(asset_server) << "Set mapping:" << path << "=>" << hash;
         maybeBake(path, hash);
         return true;
     } else {
-        // failed to persist this mapping to file - put back the old one in our in-memory representation
-        if (oldMapping.isEmpty()) {
-            _fileMappings.erase(_fileMappings.find(path));
-        } else {
-            _fileMappings[path] = oldMapping;
-        }
-
         qCWarning(asset_server) << "Failed to persist mapping:" << path << "=>" << hash;
 
         return false;
@@ -1111,12 +1336,14 @@ void AssetServer::removeBakedPathsForDeletedAsset(AssetUtils::AssetHash hash) {
 
     qCDebug(asset_server) << "Deleting baked content below" << hiddenBakedFolder << "since" << hash << "was deleted";
 
+    // a bake worker's result for it would be ignored
+    _remoteBakes.remove(hash);
+
     deleteMappings(hiddenBakedFolder);
 }
 
 bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
-    // take a copy of the current mappings in case persistence of these deletes fails
-    auto oldMappings = _fileMappings;
+    AssetMappingStore::Transaction transaction;
 
     QSet<QString> hashesToCheckForDeletion;
 
@@ -1126,24 +1353,20 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
         // figure out if this path will delete a file or folder
         if (pathIsFolder(path)) {
-            // enumerate the in memory file mappings and remove anything that matches
-            auto it = _fileMappings.begin();
-            auto sizeBefore = _fileMappings.size();
+            // the mappings are sorted by path, so the ones in the folder are next to each other
+            auto range = _mappingStore.findPrefix(path);
+            int numDeleted = 0;
 
-            while (it != _fileMappings.end()) {
-                if (it->first.startsWith(path)) {
-                    // add this hash to the list we need to check for asset removal from the server
-                    hashesToCheckForDeletion << it->second;
+            for (auto it = range.first; it != range.second; ++it) {
+                // add this hash to the list we need to check for asset removal from the server
+                hashesToCheckForDeletion << it->second;
 
-                    it = _fileMappings.erase(it);
-                } else {
-                    ++it;
-                }
+                transaction.remove(it->first);
+                ++numDeleted;
             }
 
-            auto sizeNow = _fileMappings.size();
-            if (sizeBefore != sizeNow) {
-                qCDebug(asset_server) << "Deleted" << sizeBefore - sizeNow << "mappings in folder: " << path;
+            if (numDeleted > 0) {
+                qCDebug(asset_server) << "Deleted" << numDeleted << "mappings in folder: " << path;
             } else {
                 qCDebug(asset_server) << "Did not find any mappings to delete in folder:" << path;
             }
@@ -1156,15 +1379,15 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
                 qCDebug(asset_server) << "Deleted a mapping:" << path << "=>" << it->second;
 
-                _fileMappings.erase(it);
+                transaction.remove(path);
             } else {
                 qCDebug(asset_server) << "Unable to delete a mapping that was not found:" << path;
             }
         }
     }
 
-    // deleted the old mappings, attempt to persist to file
-    if (writeMappingsToFile()) {
+    // the in memory mappings only change once the deletes are persisted
+    if (_mappingStore.commit(transaction)) {
         // persistence succeeded we are good to go
 
         // TODO iterate through hashesToCheckForDeletion instead
@@ -1182,6 +1405,8 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
             if (removeableFile.remove()) {
                 qCDebug(asset_server) << "\tDeleted" << hash << "from asset files directory since it is now unmapped.";
+                _memoryCache->remove(hash);
+                _chunkIndex->removeFile(hash);
 
                 removeBakedPathsForDeletedAsset(hash);
             } else {
@@ -1191,10 +1416,7 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
 
         return true;
     } else {
-        qCWarning(asset_server) << "Failed to persist deleted mappings, rolling back";
-
-        // we didn't delete the previous mapping, put it back in our in-memory representation
-        _fileMappings = oldMappings;
+        qCWarning(asset_server) << "Failed to persist deleted mappings";
 
         return false;
     }
@@ -1220,35 +1442,25 @@ bool AssetServer::renameMapping(AssetUtils::AssetPath oldPath, AssetUtils::Asset
             return false;
         }
 
-        // take a copy of the old mappings
-        auto oldMappings = _fileMappings;
-
-        // iterate the current mappings and adjust any that matches the renamed folder
-        auto it = oldMappings.begin();
-
-        while (it != oldMappings.end()) {
-            auto& oldKey = it->first;
-            if (oldKey.startsWith(oldPath)) {
-                auto newKey = oldKey;
-                newKey.replace(0, oldPath.size(), newPath);
-
-                // remove the old version from the in memory file mappings
-                _fileMappings.erase(_fileMappings.find(oldKey));
-                _fileMappings[newKey] = it->second;
-            }
-
-            ++it;
+        // adjust the mappings in the renamed folder, which are next to each other, all the removes go first so a
+        // folder can be renamed into itself
+        AssetMappingStore::Transaction transaction;
+        auto range = _mappingStore.findPrefix(oldPath);
+        for (auto it = range.first; it != range.second; ++it) {
+            transaction.remove(it->first);
+        }
+        for (auto it = range.first; it != range.second; ++it) {
+            auto newKey = it->first;
+            newKey.replace(0, oldPath.size(), newPath);
+            transaction.set(newKey, it->second);
         }
 
-        if (writeMappingsToFile()) {
+        if (_mappingStore.commit(transaction)) {
             // persisted the changed mappings, return success
             qCDebug(asset_server) << "Renamed folder mapping:" << oldPath << "=>" << newPath;
 
             return true;
         } else {
-            // couldn't persist the renamed paths, rollback and return failure
-            _fileMappings = oldMappings;
-
             qCWarning(asset_server) << "Failed to persist renamed folder mapping:" << oldPath << "=>" << newPath;
 
             return false;
@@ -1261,34 +1473,19 @@ bool AssetServer::renameMapping(AssetUtils::AssetPath oldPath, AssetUtils::Asset
             return false;
         }
 
-        // take the old hash to remove the old mapping
         auto it = _fileMappings.find(oldPath);
-        auto oldSourceMapping = it->second;
-        _fileMappings.erase(it);
-
-        // in case we're overwriting, keep the current destination mapping for potential rollback
-        auto oldDestinationIt = _fileMappings.find(newPath);
 
-        if (!oldSourceMapping.isEmpty()) {
-            _fileMappings[newPath] = oldSourceMapping;
+        if (it != _fileMappings.end()) {
+            AssetMappingStore::Transaction transaction;
+            transaction.remove(oldPath);
+            transaction.set(newPath, it->second);
 
-            if (writeMappingsToFile()) {
+            if (_mappingStore.commit(transaction)) {
                 // persisted the renamed mapping, return success
                 qCDebug(asset_server) << "Renamed mapping:" << oldPath << "=>" << newPath;
 
                 return true;
             } else {
-                // we couldn't persist the renamed mapping, rollback and return failure
-                _fileMappings[oldPath] = oldSourceMapping;
-
-                if (oldDestinationIt != _fileMappings.end()) {
-                    // put back the overwritten mapping for the destination path
-                    _fileMappings[newPath] = oldDestinationIt->second;
-                } else {
-                    // clear the new mapping
-                    _fileMappings.erase(_fileMappings.find(newPath));
-                }
-
                 qCDebug(asset_server) << "Failed to persist renamed mapping:" << oldPath << "=>" << newPath;
 
                 return false;
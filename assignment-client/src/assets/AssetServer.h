@@ -12,13 +12,20 @@
 #ifndef hifi_AssetServer_h
 #define hifi_AssetServer_h
 
+#include <deque>
+#include <memory>
+
 #include <QtCore/QDir>
+#include <QtCore/QSet>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThreadPool>
 #include <QRunnable>
 
 #include <ThreadedAssignment.h>
 
+#include "AssetChunkIndex.h"
+#include "AssetMappingStore.h"
+#include "AssetMemoryCache.h"
 #include "AssetUtils.h"
 #include "ReceivedMessage.h"
 
@@ -42,6 +49,7 @@ enum class BakedAssetType : int {
 enum class ModelBakeVersion : BakeVersion {
     Initial = INITIAL_BAKE_VERSION,
     MetaTextureJson,
+    MeshLODs,
 
     COUNT
 };
@@ -88,7 +96,12 @@ private slots:
     void handleAssetGetInfo(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGet(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetUpload(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer senderNode);
+    void handleAssetUploadManifest(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleBakeJobRequest(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleBakeJobResult(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+
+    void nodeKilled(SharedNodePointer killedNode);
 
     void sendStatsPacket() override;
 
@@ -107,7 +120,6 @@ private:
 
     // Mapping file operations must be called from main assignment thread only
     bool loadMappingsFromFile();
-    bool writeMappingsToFile();
 
     /// Set the mapping for path to hash
     bool setMapping(AssetUtils::AssetPath path, AssetUtils::AssetHash hash);
@@ -137,6 +149,10 @@ private:
     bool needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash);
     void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
+    /// Queue a bake for the bake workers and hand out what is queued to those waiting for a job
+    void queueRemoteBake(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath);
+    void dispatchRemoteBakes();
+
     /// Move baked content for asset to baked directory and update baked status
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir);
     void handleFailedBake(QString originalAssetHash, QString assetPath, QString errors);
@@ -149,7 +165,9 @@ private:
     /// Remove baked paths when the original asset is deleteds
     void removeBakedPathsForDeletedAsset(AssetUtils::AssetHash originalAssetHash);
 
-    AssetUtils::Mappings _fileMappings;
+    AssetMappingStore _mappingStore;
+    // the mappings are only changed through transactions of the store
+    const AssetUtils::Mappings& _fileMappings { _mappingStore.getMappings() };
 
     QDir _resourcesDirectory;
     QDir _filesDirectory;
@@ -157,9 +175,25 @@ private:
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
+    /// Contents of the assets served most recently, shared by the download tasks
+    std::shared_ptr<AssetMemoryCache> _memoryCache { std::make_shared<AssetMemoryCache>() };
+
+    /// Chunks of the stored files, that the uploads can leave out
+    std::shared_ptr<AssetChunkIndex> _chunkIndex;
+
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
 
+    /// Bakes handed to the bake workers, once any have asked for a job, rather than to the baking task pool
+    struct RemoteBake {
+        AssetUtils::AssetPath assetPath;
+        QUuid workerID; // null while queued
+    };
+    QHash<AssetUtils::AssetHash, RemoteBake> _remoteBakes;
+    std::deque<AssetUtils::AssetHash> _queuedRemoteBakes;
+    QSet<QUuid> _bakeWorkers;
+    QSet<QUuid> _idleBakeWorkers;
+
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
     using RequestQueue = QVector<QPair<QSharedPointer<ReceivedMessage>, SharedNodePointer>>;
@@ -30,6 +30,7 @@ public:
     // Thread-safe inspection methods
     bool isBaking() { return _isBaking.load(); }
     bool wasAborted() const { return _wasAborted.load(); }
+    const AssetUtils::AssetPath& getAssetPath() const { return _assetPath; }
 
     void run() override;
 
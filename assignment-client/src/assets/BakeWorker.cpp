@@ -0,0 +1,338 @@
+//
+//  BakeWorker.cpp
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BakeWorker.h"
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonObject>
+
+#include <NodeList.h>
+#include <PathUtils.h>
+
+#include "AssetServerLogging.h"
+#include "BakeAssetTask.h"
+
+static const QString BAKE_WORKER_LOGGING_TARGET_NAME = "bake-worker";
+
+static const QString BAKE_RESULTS_SUBDIR = "bake-worker/results";
+static const QString PARTIAL_RESULT_SUFFIX = ".partial";
+
+// results the asset-server never asked for again are for assets it no longer has
+static const qint64 RESULT_EXPIRY_SECS = 7 * 24 * 60 * 60;
+
+BakeWorker::BakeWorker(ReceivedMessage& message) :
+    ThreadedAssignment(message),
+    _bakingTaskPool(this)
+{
+    // the Oven makes use of the cores itself, we bake one asset at a time
+    _bakingTaskPool.setMaxThreadCount(1);
+}
+
+void BakeWorker::run() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::AssetServer });
+    connect(nodeList.data(), &NodeList::nodeActivated, this, &BakeWorker::nodeActivated);
+
+    auto& packetReceiver = nodeList->getPacketReceiver();
+    packetReceiver.registerListener(PacketType::BakeJob,
+        PacketReceiver::makeSourcedListenerReference<BakeWorker>(this, &BakeWorker::handleBakeJob));
+    packetReceiver.registerListener(PacketType::BakeJobResultReply,
+        PacketReceiver::makeSourcedListenerReference<BakeWorker>(this, &BakeWorker::handleBakeJobResultReply));
+
+    _resultsDirectory = QDir(PathUtils::getAppDataFilePath(BAKE_RESULTS_SUBDIR));
+    if (!_resultsDirectory.mkpath(".")) {
+        qCWarning(asset_server) << "Unable to create bake results directory" << _resultsDirectory.path();
+    }
+    removeExpiredResults();
+
+    PathUtils::removeTemporaryApplicationDirs();
+    PathUtils::removeTemporaryApplicationDirs("Oven");
+
+    ThreadedAssignment::commonInit(BAKE_WORKER_LOGGING_TARGET_NAME, NodeType::BakeWorker);
+}
+
+void BakeWorker::aboutToFinish() {
+    // abort the bake in progress, its result would have nowhere to go
+    if (_bakeTask) {
+        if (_bakingTaskPool.tryTake(_bakeTask.get())) {
+            finishBakeJob();
+        } else {
+            qCDebug(asset_server) << "Aborting bake in progress";
+            _bakeTask->abort();
+        }
+    }
+
+    // make sure the baker is finished or aborted
+    while (_bakeTask) {
+        QCoreApplication::processEvents();
+    }
+}
+
+void BakeWorker::nodeActivated(SharedNodePointer activatedNode) {
+    if (activatedNode->getType() == NodeType::AssetServer) {
+        requestBakeJob();
+    }
+}
+
+void BakeWorker::requestBakeJob() {
+    if (_isFinished || _bakeTask) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+    if (!assetServer) {
+        // we will ask again once we connect to an asset-server
+        return;
+    }
+
+    auto packet = NLPacket::create(PacketType::BakeJobRequest, 0, true);
+    nodeList->sendPacket(std::move(packet), *assetServer);
+}
+
+void BakeWorker::handleBakeJob(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    AssetUtils::AssetHash assetHash = message->read(AssetUtils::SHA256_HASH_LENGTH).toHex();
+    AssetUtils::AssetPath assetPath = message->readString();
+    qint32 bakeVersion { 0 };
+    message->readPrimitive(&bakeVersion);
+
+    if (_bakeTask) {
+        qCWarning(asset_server) << "Received bake job for" << assetPath << "while baking, handing it back";
+        sendResult(assetHash, AssetUtils::BakeJobAborted);
+        return;
+    }
+
+    // we baked this asset already, but the asset-server didn't get to confirm it has the result
+    QDir resultDirectory = _resultsDirectory;
+    if (resultDirectory.cd(getResultDirectoryName(assetHash, bakeVersion))) {
+        qCDebug(asset_server) << "Sending kept bake result for" << assetPath << assetHash;
+        ++_numReused;
+        sendCompletedResult(assetHash, resultDirectory);
+        requestBakeJob();
+        return;
+    }
+
+    QString errors;
+    QString tempDir = PathUtils::generateTemporaryDir();
+    QString filePath = tempDir + "/" + assetPath.split("/").last();
+    QByteArray data = message->readAll();
+    if (tempDir.isEmpty()) {
+        errors = "Could not create temporary working directory";
+    } else if (AssetUtils::hashData(data).toHex() != assetHash) {
+        errors = "Received asset does not match its hash";
+    } else {
+        QFile file { filePath };
+        if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size()) {
+            errors = "Couldn't write file to bake to temporary directory";
+        }
+    }
+
+    if (!errors.isEmpty()) {
+        qCWarning(asset_server) << "Failed to start bake of" << assetPath << "(" << errors << ")";
+        PathUtils::deleteMyTemporaryDir(QDir(tempDir).dirName());
+        ++_numFailed;
+        sendResult(assetHash, AssetUtils::BakeJobFailed, errors);
+        requestBakeJob();
+        return;
+    }
+
+    qCDebug(asset_server) << "Starting bake for:" << assetPath << assetHash;
+    _jobTempDirName = QDir(tempDir).dirName();
+    _jobBakeVersion = bakeVersion;
+
+    _bakeTask = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
+    _bakeTask->setAutoDelete(false);
+
+    connect(_bakeTask.get(), &BakeAssetTask::bakeComplete, this, &BakeWorker::handleCompletedBake);
+    connect(_bakeTask.get(), &BakeAssetTask::bakeFailed, this, &BakeWorker::handleFailedBake);
+    connect(_bakeTask.get(), &BakeAssetTask::bakeAborted, this, &BakeWorker::handleAbortedBake);
+
+    _bakingTaskPool.start(_bakeTask.get());
+}
+
+void BakeWorker::handleBakeJobResultReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    AssetUtils::AssetHash assetHash = message->read(AssetUtils::SHA256_HASH_LENGTH).toHex();
+
+    // the asset-server has the result now, whatever version of it we kept can go
+    auto resultDirectoryNames = _resultsDirectory.entryList({ assetHash + "-*" }, QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const auto& resultDirectoryName : resultDirectoryNames) {
+        QDir(_resultsDirectory.filePath(resultDirectoryName)).removeRecursively();
+    }
+}
+
+void BakeWorker::handleCompletedBake(QString assetHash, QString assetPath, QString tempOutputDir) {
+    qCDebug(asset_server) << "Completed bake for" << assetPath << assetHash;
+
+    // find the directory containing the baked content
+    QDir outputDir(tempOutputDir);
+    QString outputDirName = outputDir.dirName();
+    QString bakedDirectoryPath;
+    for (const auto& dirName : outputDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        QDir dir(outputDir.filePath(dirName));
+        if (dir.exists("baked") && dir.exists("original")) {
+            bakedDirectoryPath = dir.filePath("baked");
+            break;
+        }
+    }
+
+    // keep the baked files until the asset-server confirms it has them, moving them in place once all are copied
+    QString errors;
+    auto resultDirectoryName = getResultDirectoryName(assetHash, _jobBakeVersion);
+    QDir partialDirectory(_resultsDirectory.filePath(resultDirectoryName + PARTIAL_RESULT_SUFFIX));
+    partialDirectory.removeRecursively();
+
+    if (bakedDirectoryPath.isEmpty()) {
+        errors = "Failed to find baking output";
+    } else if (!partialDirectory.mkpath(".")) {
+        errors = "Failed to create bake result directory";
+    } else {
+        QDir bakedDirectory(bakedDirectoryPath);
+        QDirIterator it(bakedDirectoryPath, QDir::Files, QDirIterator::Subdirectories);
+        while (errors.isEmpty() && it.hasNext()) {
+            it.next();
+            auto destinationPath = partialDirectory.filePath(bakedDirectory.relativeFilePath(it.filePath()));
+            if (!partialDirectory.mkpath(QFileInfo(destinationPath).path()) || !QFile::copy(it.filePath(), destinationPath)) {
+                errors = "Failed to copy baked file " + it.fileName();
+            }
+        }
+
+        if (errors.isEmpty() && !_resultsDirectory.rename(partialDirectory.dirName(), resultDirectoryName)) {
+            errors = "Failed to move bake result in place";
+        }
+    }
+
+    PathUtils::deleteMyTemporaryDir(outputDirName);
+
+    if (errors.isEmpty()) {
+        ++_numBaked;
+        sendCompletedResult(assetHash, QDir(_resultsDirectory.filePath(resultDirectoryName)));
+    } else {
+        qCWarning(asset_server) << "Could not keep bake result for" << assetHash << "(" << errors << ")";
+        partialDirectory.removeRecursively();
+        ++_numFailed;
+        sendResult(assetHash, AssetUtils::BakeJobFailed, errors);
+    }
+
+    finishBakeJob();
+    requestBakeJob();
+}
+
+void BakeWorker::handleFailedBake(QString assetHash, QString assetPath, QString errors) {
+    qCDebug(asset_server) << "Failed to bake:" << assetHash << assetPath << "(" << errors << ")";
+
+    ++_numFailed;
+    sendResult(assetHash, AssetUtils::BakeJobFailed, errors);
+
+    finishBakeJob();
+    requestBakeJob();
+}
+
+void BakeWorker::handleAbortedBake(QString assetHash, QString assetPath) {
+    qCDebug(asset_server) << "Aborted bake:" << assetHash;
+
+    // hand the job back so that the asset-server can give it to another worker
+    sendResult(assetHash, AssetUtils::BakeJobAborted);
+
+    finishBakeJob();
+    requestBakeJob();
+}
+
+void BakeWorker::finishBakeJob() {
+    _bakeTask.reset();
+    if (!_jobTempDirName.isEmpty()) {
+        PathUtils::deleteMyTemporaryDir(_jobTempDirName);
+        _jobTempDirName.clear();
+    }
+}
+
+void BakeWorker::sendCompletedResult(const AssetUtils::AssetHash& assetHash, const QDir& resultDirectory) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+    if (!assetServer) {
+        qCDebug(asset_server) << "No asset-server to send the bake result for" << assetHash << "to, keeping it";
+        return;
+    }
+
+    QVector<QPair<QString, QByteArray>> bakedFiles;
+    QDirIterator it(resultDirectory.path(), QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        QFile file { it.filePath() };
+        if (!file.open(QIODevice::ReadOnly)) {
+            sendResult(assetHash, AssetUtils::BakeJobFailed, "Could not open baked file " + it.fileName());
+            return;
+        }
+        bakedFiles.push_back({ resultDirectory.relativeFilePath(it.filePath()), file.readAll() });
+    }
+
+    auto packetList = NLPacketList::create(PacketType::BakeJobResult, QByteArray(), true, true);
+    packetList->setPriority(udt::Packet::Priority::Bulk);
+    packetList->write(QByteArray::fromHex(assetHash.toLatin1()));
+    packetList->writePrimitive(AssetUtils::BakeJobCompleted);
+    packetList->writePrimitive((uint32_t)bakedFiles.size());
+    for (const auto& bakedFile : bakedFiles) {
+        packetList->writeString(bakedFile.first);
+        packetList->writePrimitive((qint64)bakedFile.second.size());
+        packetList->write(bakedFile.second);
+    }
+
+    nodeList->sendPacketList(std::move(packetList), *assetServer);
+}
+
+void BakeWorker::sendResult(const AssetUtils::AssetHash& assetHash, AssetUtils::BakeJobResultType type,
+                            const QString& errors) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
+    if (!assetServer) {
+        return;
+    }
+
+    auto packetList = NLPacketList::create(PacketType::BakeJobResult, QByteArray(), true, true);
+    packetList->write(QByteArray::fromHex(assetHash.toLatin1()));
+    packetList->writePrimitive(type);
+    if (type == AssetUtils::BakeJobFailed) {
+        packetList->writeString(errors);
+    }
+
+    nodeList->sendPacketList(std::move(packetList), *assetServer);
+}
+
+QString BakeWorker::getResultDirectoryName(const AssetUtils::AssetHash& assetHash, int bakeVersion) const {
+    return assetHash + "-" + QString::number(bakeVersion);
+}
+
+void BakeWorker::removeExpiredResults() {
+    auto now = QDateTime::currentDateTime();
+    auto resultDirectories = _resultsDirectory.entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const auto& resultDirectory : resultDirectories) {
+        if (resultDirectory.fileName().endsWith(PARTIAL_RESULT_SUFFIX) ||
+            resultDirectory.lastModified().secsTo(now) > RESULT_EXPIRY_SECS) {
+            qCDebug(asset_server) << "Removing expired bake result" << resultDirectory.fileName();
+            QDir(resultDirectory.absoluteFilePath()).removeRecursively();
+        }
+    }
+}
+
+void BakeWorker::sendStatsPacket() {
+    QJsonObject statsObject;
+    QJsonObject bakeStats;
+    bakeStats["1. Baked"] = _numBaked;
+    bakeStats["2. Reused"] = _numReused;
+    bakeStats["3. Failed"] = _numFailed;
+    bakeStats["4. Baking"] = _bakeTask != nullptr;
+    statsObject["Bake Jobs"] = bakeStats;
+
+    ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
+}
@@ -0,0 +1,76 @@
+//
+//  BakeWorker.h
+//  assignment-client/src/assets
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BakeWorker_h
+#define hifi_BakeWorker_h
+
+#include <memory>
+
+#include <QtCore/QDir>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
+
+#include <AssetUtils.h>
+#include <ThreadedAssignment.h>
+
+class BakeAssetTask;
+
+/// Handles assignments of type BakeWorker - baking, for the asset-server, the assets it hands out
+///
+/// The worker asks the asset-server for a job whenever it is idle, bakes the asset it receives with the Oven, and
+/// uploads the baked files keyed by the hash of the original. The results are kept on disk until the asset-server
+/// confirms it has them, so a job handed out again after either one restarts is not baked twice.
+class BakeWorker : public ThreadedAssignment {
+    Q_OBJECT
+public:
+    BakeWorker(ReceivedMessage& message);
+
+    void aboutToFinish() override;
+
+public slots:
+    void run() override;
+    void sendStatsPacket() override;
+
+private slots:
+    void nodeActivated(SharedNodePointer activatedNode);
+
+    void handleBakeJob(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleBakeJobResultReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+
+    void handleCompletedBake(QString assetHash, QString assetPath, QString tempOutputDir);
+    void handleFailedBake(QString assetHash, QString assetPath, QString errors);
+    void handleAbortedBake(QString assetHash, QString assetPath);
+
+private:
+    void requestBakeJob();
+    void finishBakeJob();
+
+    /// Upload the baked files kept for assetHash, if the asset-server is still there to receive them
+    void sendCompletedResult(const AssetUtils::AssetHash& assetHash, const QDir& resultDirectory);
+    void sendResult(const AssetUtils::AssetHash& assetHash, AssetUtils::BakeJobResultType type,
+                    const QString& errors = QString());
+
+    QString getResultDirectoryName(const AssetUtils::AssetHash& assetHash, int bakeVersion) const;
+    void removeExpiredResults();
+
+    QDir _resultsDirectory;
+
+    std::shared_ptr<BakeAssetTask> _bakeTask;
+    QString _jobTempDirName;
+    int _jobBakeVersion { 0 };
+    QThreadPool _bakingTaskPool;
+
+    int _numBaked { 0 };
+    int _numReused { 0 };
+    int _numFailed { 0 };
+};
+
+#endif // hifi_BakeWorker_h
@@ -18,14 +18,17 @@
 #include <NodeList.h>
 #include <NLPacketList.h>
 
+#include "AssetChunkIndex.h"
 #include "ClientServerUtils.h"
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const QDir& resourcesDir, uint64_t filesizeLimit,
+                                 const std::shared_ptr<AssetChunkIndex>& chunkIndex) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
-    _filesizeLimit(filesizeLimit)
+    _filesizeLimit(filesizeLimit),
+    _chunkIndex(chunkIndex)
 {
     
 }
@@ -50,12 +53,20 @@ void UploadAssetTask::run() {
     
     auto replyPacket = NLPacket::create(PacketType::AssetUploadReply, -1, true);
     replyPacket->writePrimitive(messageID);
-    
+
+    bool isDeltaUpload = _receivedMessage->getType() == PacketType::AssetDeltaUpload;
+    QByteArray fileData;
+    AssetUtils::AssetHash storedHash;
+    if (fileSize <= _filesizeLimit) {
+        fileData = isDeltaUpload ? readDeltaUpload(buffer, fileSize) : buffer.read(fileSize);
+    }
+
     if (fileSize > _filesizeLimit) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+    } else if (isDeltaUpload && (uint64_t)fileData.size() != fileSize) {
+        qDebug() << "Delta upload refers to chunks that are not stored any more";
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::UploadChunkNotFound);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
-        
         auto hash = AssetUtils::hashData(fileData);
         auto hexHash = hash.toHex();
 
@@ -68,6 +79,7 @@ void UploadAssetTask::run() {
         QFile file { _resourcesDir.filePath(QString(hexHash)) };
 
         bool existingCorrectFile = false;
+        bool storedFile = false;
         
         if (file.exists()) {
             // check if the local file has the correct contents, otherwise we overwrite
@@ -88,6 +100,7 @@ void UploadAssetTask::run() {
             if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
                 qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
                 file.close();
+                storedFile = true;
 
                 replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
                 replyPacket->write(hash);
@@ -105,7 +118,9 @@ void UploadAssetTask::run() {
             }
         }
 
-
+        if (existingCorrectFile || storedFile) {
+            storedHash = hexHash;
+        }
     }
     
     auto nodeList = DependencyManager::get<NodeList>();
@@ -114,4 +129,33 @@ void UploadAssetTask::run() {
     } else {
         nodeList->sendPacket(std::move(replyPacket), _receivedMessage->getSenderSockAddr());
     }
+
+    // the chunks of the stored file can be left out of the next uploads
+    if (!storedHash.isEmpty()) {
+        _chunkIndex->addFile(storedHash, fileData);
+    }
+}
+
+QByteArray UploadAssetTask::readDeltaUpload(QBuffer& buffer, uint64_t fileSize) {
+    QByteArray fileData;
+    fileData.reserve(fileSize);
+
+    uint32_t numChunks { 0 };
+    buffer.read(reinterpret_cast<char*>(&numChunks), sizeof(numChunks));
+
+    for (uint32_t i = 0; i < numChunks; ++i) {
+        QByteArray chunkHash = buffer.read(AssetUtils::SHA256_HASH_LENGTH);
+        uint32_t chunkSize { 0 };
+        buffer.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize));
+        uint8_t hasData { 0 };
+        buffer.read(reinterpret_cast<char*>(&hasData), sizeof(hasData));
+
+        QByteArray chunkData = hasData ? buffer.read(chunkSize) : _chunkIndex->readChunk(chunkHash, chunkSize);
+        if ((uint32_t)chunkData.size() != chunkSize || (uint64_t)fileData.size() + chunkSize > fileSize) {
+            return QByteArray();
+        }
+        fileData.append(chunkData);
+    }
+
+    return fileData;
 }
@@ -14,6 +14,9 @@
 #ifndef hifi_UploadAssetTask_h
 #define hifi_UploadAssetTask_h
 
+#include <memory>
+
+#include <QtCore/QBuffer>
 #include <QtCore/QDir>
 #include <QtCore/QObject>
 #include <QtCore/QRunnable>
@@ -21,21 +24,26 @@
 
 #include "ReceivedMessage.h"
 
+class AssetChunkIndex;
 class NLPacketList;
 class Node;
 
 class UploadAssetTask : public QRunnable {
 public:
     UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+                    const QDir& resourcesDir, uint64_t filesizeLimit, const std::shared_ptr<AssetChunkIndex>& chunkIndex);
 
     void run() override;
 
 private:
+    /// Put together the file of a delta upload, from the chunks it carries and those already stored
+    QByteArray readDeltaUpload(QBuffer& buffer, uint64_t fileSize);
+
     QSharedPointer<ReceivedMessage> _receivedMessage;
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
     uint64_t _filesizeLimit;
+    std::shared_ptr<AssetChunkIndex> _chunkIndex;
 };
 
 #endif // hifi_UploadAssetTask_h
@@ -11,6 +11,8 @@
 
 #include "AudioMixer.h"
 
+#include <algorithm>
+#include <iterator>
 #include <thread>
 
 #include <QtCore/QJsonArray>
@@ -24,6 +26,7 @@
 #include <NodeList.h>
 #include <Node.h>
 #include <OctreeConstants.h>
+#include <PerformanceCounters.h>
 #include <plugins/PluginManager.h>
 #include <plugins/CodecPlugin.h>
 #include <udt/PacketHeaders.h>
@@ -48,8 +51,11 @@ static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
 static const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
+static const float DEFAULT_MIX_CLUSTER_ORIENTATION_TOLERANCE = 5.0f * RADIANS_PER_DEGREE;
+static const float DEFAULT_MIX_CLUSTER_NEAR_FIELD_RADIUS = 5.0f;
 
 int AudioMixer::_numStaticJitterFrames{ DISABLE_STATIC_JITTER_FRAMES };
+float AudioMixer::_targetDelayPercentile{ InboundAudioStream::DEFAULT_TARGET_DELAY_PERCENTILE };
 float AudioMixer::_noiseMutingThreshold{ DEFAULT_NOISE_MUTING_THRESHOLD };
 float AudioMixer::_attenuationPerDoublingInDistance{ DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE };
 map<QString, shared_ptr<CodecPlugin>> AudioMixer::_availableCodecs{ };
@@ -57,6 +63,13 @@ QStringList AudioMixer::_codecPreferenceOrder{};
 vector<AudioMixer::ZoneDescription> AudioMixer::_audioZones;
 vector<AudioMixer::ZoneSettings> AudioMixer::_zoneSettings;
 vector<AudioMixer::ReverbSettings> AudioMixer::_zoneReverbSettings;
+float AudioMixer::_mixClusterPositionTolerance { 0.0f };
+float AudioMixer::_mixClusterOrientationTolerance { DEFAULT_MIX_CLUSTER_ORIENTATION_TOLERANCE };
+float AudioMixer::_mixClusterNearFieldRadius { DEFAULT_MIX_CLUSTER_NEAR_FIELD_RADIUS };
+float AudioMixer::_farFieldMixRadius { 0.0f };
+bool AudioMixer::_useSharedAvatarPoses { false };
+bool AudioMixer::_isShard { false };
+const AvatarPoseTable* AudioMixer::_freshAvatarPoseTable { nullptr };
 
 AudioMixer::AudioMixer(ReceivedMessage& message) :
     ThreadedAssignment(message)
@@ -66,6 +79,11 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     // This prevents previous assignment settings from sticking around
     clearDomainSettings();
 
+    _isShard = getPayload() == SHARD_ASSIGNMENT_PAYLOAD;
+    if (_isShard) {
+        qCDebug(audio) << "Audio mixer is a shard, serving a part of the domain's clients";
+    }
+
     // hash the available codecs (on the mixer)
     _availableCodecs.clear(); // Make sure struct is clean
     auto pluginManager = DependencyManager::set<PluginManager>();
@@ -86,11 +104,7 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
 
     // packets whose consequences are limited to their own node can be parallelized
     packetReceiver.registerListenerForTypes({
-            PacketType::MicrophoneAudioNoEcho,
-            PacketType::MicrophoneAudioWithEcho,
-            PacketType::InjectAudio,
             PacketType::AudioStreamStats,
-            PacketType::SilentAudioFrame,
             PacketType::NegotiateAudioFormat,
             PacketType::MuteEnvironment,
             PacketType::NodeIgnoreRequest,
@@ -103,6 +117,15 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
             PacketReceiver::makeSourcedListenerReference<AudioMixer>(this, &AudioMixer::queueAudioPacket)
     );
 
+    // audio frames go straight from the receiving thread to the node queues drained by the slave pool
+    packetReceiver.registerTypedHandlerForTypes<AudioMixer, &AudioMixer::queueAudioFrame>({
+            PacketType::MicrophoneAudioNoEcho,
+            PacketType::MicrophoneAudioWithEcho,
+            PacketType::InjectAudio,
+            PacketType::SilentAudioFrame },
+            this
+    );
+
     // packets whose consequences are global should be processed on the main thread
     packetReceiver.registerListener(PacketType::MuteEnvironment,
         PacketReceiver::makeSourcedListenerReference<AudioMixer>(this, &AudioMixer::handleMuteEnvironmentPacket));
@@ -110,6 +133,10 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
         PacketReceiver::makeSourcedListenerReference<AudioMixer>(this, &AudioMixer::handleNodeMuteRequestPacket));
     packetReceiver.registerListener(PacketType::KillAvatar,
         PacketReceiver::makeSourcedListenerReference<AudioMixer>(this, &AudioMixer::handleKillAvatarPacket));
+    packetReceiver.registerListener(PacketType::AudioShardListeners,
+        PacketReceiver::makeSourcedListenerReference<AudioMixer>(this, &AudioMixer::handleShardListenersPacket));
+    packetReceiver.registerListener(PacketType::AudioShardKilledNode,
+        PacketReceiver::makeSourcedListenerReference<AudioMixer>(this, &AudioMixer::handleShardKilledNodePacket));
 
     packetReceiver.registerListenerForTypes({
         PacketType::ReplicatedMicrophoneAudioNoEcho,
@@ -120,34 +147,96 @@ AudioMixer::AudioMixer(ReceivedMessage& message) :
     );
 
     connect(nodeList.data(), &NodeList::nodeKilled, this, &AudioMixer::handleNodeKilled);
+
+    // a hot standby mixer is kept with the state of our nodes, as they would have set it up there, or the other shards with
+    // their ignores
+    _standbyReplicator = new MixerStandbyReplicator(NodeType::AudioMixer,
+        _isShard ? MixerStandbyReplicator::Mode::Peers : MixerStandbyReplicator::Mode::Standby,
+        [this](QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+            getOrCreateClientData(node.data())->queuePacket(message, node);
+        }, this);
 }
 
 void AudioMixer::aboutToFinish() {
     DependencyManager::destroy<PluginManager>();
 }
 
+// the packets that set up how a node is mixed for, which a standby mixer needs to take over the node
+static bool isNodeStatePacket(PacketType type) {
+    return type == PacketType::NegotiateAudioFormat || type == PacketType::RequestsDomainListData
+        || type == PacketType::PerAvatarGainSet || type == PacketType::InjectorGainSet
+        || type == PacketType::NodeIgnoreRequest || type == PacketType::RadiusIgnoreRequest
+        || type == PacketType::AudioSoloRequest;
+}
+
 void AudioMixer::queueAudioPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
     if (message->getType() == PacketType::SilentAudioFrame) {
         _numSilentPackets++;
     }
 
+    if (isNodeStatePacket(message->getType())) {
+        _standbyReplicator->mirrorPacket(*message, *node);
+    }
+
     getOrCreateClientData(node.data())->queuePacket(message, node);
 }
 
+void AudioMixer::queueAudioFrame(const QSharedPointer<ReceivedMessage>& message, const SharedNodePointer& node) {
+    if (!node) {
+        return;
+    }
+
+    AudioMixerClientData* clientData;
+    {
+        // the mixer thread links the client data under the node's lock
+        QMutexLocker locker(&node->getMutex());
+        clientData = dynamic_cast<AudioMixerClientData*>(node->getLinkedData());
+    }
+    if (!clientData) {
+        // the client data has not been linked yet, do it on the mixer thread
+        QMetaObject::invokeMethod(this, [this, message, node] {
+            queueAudioPacket(message, node);
+        });
+        return;
+    }
+
+    if (message->getType() == PacketType::SilentAudioFrame) {
+        _numSilentPackets++;
+    }
+
+    clientData->queuePacket(message, node);
+}
+
 void AudioMixer::queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> message) {
     // make sure we have a replicated node for the original sender of the packet
     auto nodeList = DependencyManager::get<NodeList>();
 
     // Node ID is now part of user data, since replicated audio packets are non-sourced.
     QUuid nodeID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    Node::LocalID localID;
+    message->readPrimitive(&localID);
+
+    // the shards of a domain share its local IDs, those of an upstream mixer are another domain's
+    const auto& senderSockAddr = message->getSenderSockAddr();
+    if (localID != Node::NULL_LOCAL_ID) {
+        auto existingNode = nodeList->nodeWithUUID(nodeID);
+        if (!existingNode || existingNode->getLocalID() != localID) {
+            bool isFromShard = _isShard && !nodeList->nodeMatchingPredicate([&](const SharedNodePointer& node) {
+                return node->getType() == NodeType::AudioMixer
+                    && (node->getPublicSocket() == senderSockAddr || node->getLocalSocket() == senderSockAddr);
+            }).isNull();
+            if (!isFromShard) {
+                localID = Node::NULL_LOCAL_ID;
+            }
+        }
+    }
 
-    auto replicatedNode = nodeList->addOrUpdateNode(nodeID, NodeType::Agent,
-                                                    message->getSenderSockAddr(), message->getSenderSockAddr(),
-                                                    Node::NULL_LOCAL_ID, true, true);
+    auto replicatedNode = nodeList->addOrUpdateNode(nodeID, NodeType::Agent, senderSockAddr, senderSockAddr,
+                                                    localID, true, true);
     replicatedNode->setLastHeardMicrostamp(usecTimestampNow());
 
     // construct a "fake" audio received message from the byte array and packet list information
-    auto audioData = message->getMessage().mid(NUM_BYTES_RFC4122_UUID);
+    auto audioData = message->getMessage().mid(NUM_BYTES_RFC4122_UUID + sizeof(Node::LocalID));
 
     PacketType rewrittenType = PacketTypeEnum::getReplicatedPacketMapping().key(message->getType());
 
@@ -233,6 +322,96 @@ void AudioMixer::handleNodeKilled(SharedNodePointer killedNode) {
         // stage the removal of all streams from this node, workers handle when preparing mixes for listeners
         _workerSharedData.removedNodes.emplace_back(killedNode->getLocalID());
     }
+
+    // the other shards remove a client of ours that left now, rather than when its streams time out there
+    if (_isShard && (killedNode->getType() == NodeType::Agent || killedNode->getType() == NodeType::EntityScriptServer) &&
+        !killedNode->isUpstream()) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        nodeList->eachMatchingNode([&](const SharedNodePointer& node) {
+            return node->getType() == NodeType::AudioMixer && node->getActiveSocket();
+        }, [&](const SharedNodePointer& node) {
+            auto killedNodePacket = NLPacket::create(PacketType::AudioShardKilledNode, NUM_BYTES_RFC4122_UUID, true);
+            killedNodePacket->write(killedNode->getUUID().toRfc4122());
+            nodeList->sendPacket(std::move(killedNodePacket), *node);
+        });
+    }
+}
+
+void AudioMixer::handleShardListenersPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode) {
+    if (!_isShard || sendingNode->getType() != NodeType::AudioMixer) {
+        return;
+    }
+
+    const qint64 LISTENER_SIZE = sizeof(glm::vec3) + 2 * sizeof(float);
+    quint32 numListeners;
+    packet->readPrimitive(&numListeners);
+    std::vector<AudioMixerAudibility::Listener> listeners;
+    for (quint32 i = 0; i < numListeners && packet->getBytesLeftToRead() >= LISTENER_SIZE; ++i) {
+        AudioMixerAudibility::Listener listener;
+        packet->readPrimitive(&listener.position);
+        packet->readPrimitive(&listener.masterAvatarGain);
+        packet->readPrimitive(&listener.masterInjectorGain);
+        listeners.push_back(listener);
+    }
+
+    // read by the slaves when they forward our clients' streams, which they aren't doing while events are processed
+    getOrCreateClientData(sendingNode.data())->setShardListeners(std::move(listeners));
+}
+
+void AudioMixer::handleShardKilledNodePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode) {
+    if (!_isShard || sendingNode->getType() != NodeType::AudioMixer) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto nodeID = QUuid::fromRfc4122(packet->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    auto replicatedNode = nodeList->nodeWithUUID(nodeID);
+    if (replicatedNode && replicatedNode->isReplicated() && replicatedNode->isUpstream()) {
+        nodeList->killNodeWithUUID(nodeID);
+    }
+}
+
+void AudioMixer::sendShardListeners() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    std::vector<AudioMixerAudibility::Listener> listeners;
+    nodeList->eachNode([&](const SharedNodePointer& node) {
+        auto nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        auto listenerStream = nodeData ? nodeData->getAvatarAudioStream() : nullptr;
+        if (node->getType() == NodeType::Agent && !node->isUpstream() && listenerStream) {
+            listeners.push_back({ listenerStream->getPosition(), nodeData->getMasterAvatarGain(),
+                                  nodeData->getMasterInjectorGain() });
+        }
+    });
+
+    // the count goes first, so that having no listeners stops the streams too
+    nodeList->eachMatchingNode([&](const SharedNodePointer& node) {
+        return node->getType() == NodeType::AudioMixer && node->getActiveSocket();
+    }, [&](const SharedNodePointer& node) {
+        auto listenersPacketList = NLPacketList::create(PacketType::AudioShardListeners, QByteArray(), true, true);
+        listenersPacketList->writePrimitive((quint32)listeners.size());
+        for (const auto& listener : listeners) {
+            listenersPacketList->writePrimitive(listener.position);
+            listenersPacketList->writePrimitive(listener.masterAvatarGain);
+            listenersPacketList->writePrimitive(listener.masterInjectorGain);
+        }
+        nodeList->sendPacketList(std::move(listenersPacketList), *node);
+    });
+}
+
+void AudioMixer::sendShardClientPositions() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto positionsPacketList = NLPacketList::create(PacketType::MixerShardClientPositions, QByteArray(), true, true);
+    nodeList->eachNode([&](const SharedNodePointer& node) {
+        auto nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        auto listenerStream = nodeData ? nodeData->getAvatarAudioStream() : nullptr;
+        if (node->getType() == NodeType::Agent && !node->isUpstream() && listenerStream) {
+            positionsPacketList->write(node->getUUID().toRfc4122());
+            positionsPacketList->writePrimitive(listenerStream->getPosition());
+        }
+    });
+    if (positionsPacketList->getNumPackets() > 0) {
+        nodeList->sendPacketList(std::move(positionsPacketList), nodeList->getDomainHandler().getSockAddr());
+    }
 }
 
 void AudioMixer::handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode) {
@@ -284,9 +463,21 @@ void AudioMixer::sendStatsPacket() {
 
     statsObject["threads"] = _slavePool.numThreads();
 
+    QJsonObject threadBalanceStats;
+    _slavePool.balanceStats(threadBalanceStats);
+    statsObject["thread_balance"] = threadBalanceStats;
+
+    QJsonObject threadAutoscalingStats;
+    _slavePool.autoscalingStats(threadAutoscalingStats);
+    statsObject["thread_autoscaling"] = threadAutoscalingStats;
+
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
+    static auto& throttlingRatio = PerformanceCounters::getInstance().gauge("throttling_ratio",
+        "Share of the streams left out of mixes to keep up");
+    throttlingRatio.set(_throttlingRatio);
+
     statsObject["avg_streams_per_frame"] = (float)_stats.sumStreams / (float)_numStatFrames;
     statsObject["avg_listeners_per_frame"] = (float)_stats.sumListeners / (float)_numStatFrames;
     statsObject["avg_listeners_(silent)_per_frame"] = (float)_stats.sumListenersSilent / (float)_numStatFrames;
@@ -308,9 +499,22 @@ void AudioMixer::sendStatsPacket() {
     addTiming(_sleepTiming, "sleep");
     addTiming(_frameTiming, "frame");
     addTiming(_packetsTiming, "packets");
+    addTiming(_prepareTiming, "prepare");
     addTiming(_mixTiming, "mix");
     addTiming(_eventsTiming, "events");
 
+    // how much of each frame went to the mix as a whole and to its phases
+    QJsonObject timingHistograms;
+    timingHistograms["frame"] = _frameTiming.getHistogram();
+    timingHistograms["packets"] = _packetsTiming.getHistogram();
+    timingHistograms["mix"] = _mixTiming.getHistogram();
+    timingHistograms["events"] = _eventsTiming.getHistogram();
+    statsObject["timing_histograms"] = timingHistograms;
+
+    statsObject["late_frames"] = _numLateFrames;
+    statsObject["late_frame_max_us"] = (qint64)_maxFrameLateness.count();
+    statsObject["frame_clock_resyncs"] = _numFrameResyncs;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     timingStats["ns_per_mix"] = (_stats.totalMixes > 0) ?  (float)(_stats.mixTime / _stats.totalMixes) : 0;
 #endif
@@ -340,12 +544,33 @@ void AudioMixer::sendStatsPacket() {
     mixStats["3_active_to_skippped"] = (int)(_stats.activeToSkipped / (float)_numStatFrames);
     mixStats["3_active_to_inactive"] = (int)(_stats.activeToInactive / (float)_numStatFrames);
 
+    int clusterLookups = _stats.clusterHits + _stats.clusterMisses;
+    mixStats["4_cluster_hits"] = (int)(_stats.clusterHits / (float)_numStatFrames);
+    mixStats["4_cluster_misses"] = (int)(_stats.clusterMisses / (float)_numStatFrames);
+    mixStats["4_cluster_%_hit_rate"] = clusterLookups > 0 ? (100.0f * _stats.clusterHits) / clusterLookups : 0.0f;
+
+    mixStats["5_far_field_mixes"] = (int)(_stats.farFieldMixes / (float)_numStatFrames);
+    mixStats["5_far_field_renders"] = (int)(_stats.farFieldRenders / (float)_numStatFrames);
+
+    int culledOrMixed = _stats.audibilityCulls + _stats.totalMixes;
+    mixStats["8_culled_streams"] = (int)(_stats.audibilityCulls / (float)_numStatFrames);
+    mixStats["8_mixed_streams"] = (int)(_stats.totalMixes / (float)_numStatFrames);
+    mixStats["8_%_culled"] = culledOrMixed > 0 ? (100.0f * _stats.audibilityCulls) / culledOrMixed : 0.0f;
+
+    mixStats["6_encodes"] = (int)(_stats.encodes / (float)_numStatFrames);
+    mixStats["6_encode_cache_hits"] = (int)(_stats.encodeCacheHits / (float)_numStatFrames);
+
+    mixStats["7_arena_allocations"] = (int)(_stats.arenaAllocations / (float)_numStatFrames);
+    mixStats["7_arena_heap_allocations"] = _stats.arenaBlockAllocations / (float)_numStatFrames;
+
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
 
     statsObject["mix_stats"] = mixStats;
 
     _numStatFrames = _numSilentPackets = 0;
+    _numLateFrames = _numFrameResyncs = 0;
+    _maxFrameLateness = chrono::microseconds(0);
     _stats.reset();
 
     // add stats for each listerner
@@ -387,6 +612,12 @@ void AudioMixer::run() {
 }
 
 AudioMixerClientData* AudioMixer::getOrCreateClientData(Node* node) {
+    // the audio frame handlers read the linked data on the receiving thread, under the node's lock
+    QMutexLocker locker(&node->getMutex());
+    return getOrLinkClientData(node);
+}
+
+AudioMixerClientData* AudioMixer::getOrLinkClientData(Node* node) {
     auto clientData = dynamic_cast<AudioMixerClientData*>(node->getLinkedData());
 
     if (!clientData) {
@@ -404,9 +635,11 @@ void AudioMixer::start() {
     // prepare the NodeList
     nodeList->addSetOfNodeTypesToNodeInterestSet({
         NodeType::Agent, NodeType::EntityScriptServer,
-        NodeType::UpstreamAudioMixer, NodeType::DownstreamAudioMixer
+        NodeType::UpstreamAudioMixer, NodeType::DownstreamAudioMixer,
+        NodeType::AudioMixer // a hot standby, or the active mixer if we are one
     });
-    nodeList->linkedDataCreateCallback = [&](Node* node) { getOrCreateClientData(node); };
+    // called with the node's lock held
+    nodeList->linkedDataCreateCallback = [&](Node* node) { getOrLinkClientData(node); };
 
     // parse out any AudioMixer settings
     {
@@ -431,6 +664,10 @@ void AudioMixer::start() {
 
         auto frameTimer = _frameTiming.timer();
 
+        if (_useSharedAvatarPoses) {
+            updateAvatarPoseTable();
+        }
+
         // process (node-isolated) audio packets across slave threads
         {
             auto packetsTimer = _packetsTiming.timer();
@@ -439,6 +676,15 @@ void AudioMixer::start() {
             _workerSharedData.addedStreams.clear();
 
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+                // gather the downstream audio mixers and other shards once, rather than enumerating every node for each
+                // replicated packet
+                _workerSharedData.downstreamMixers.clear();
+                std::copy_if(cbegin, cend, std::back_inserter(_workerSharedData.downstreamMixers),
+                    [](const SharedNodePointer& node) {
+                        return node->getType() == NodeType::DownstreamAudioMixer ||
+                            (node->getType() == NodeType::AudioMixer && _isShard && node->getActiveSocket());
+                    });
+
                 _slavePool.processPackets(cbegin, cend);
             });
         }
@@ -455,11 +701,41 @@ void AudioMixer::start() {
             QCoreApplication::processEvents();
         }
 
+        if (_isShard) {
+            static const quint64 SHARD_LISTENERS_INTERVAL_USECS = 100 * USECS_PER_MSEC;
+            static const quint64 SHARD_CLIENT_POSITIONS_INTERVAL_USECS = 2 * USECS_PER_SECOND;
+            quint64 now = usecTimestampNow();
+            if (now - _lastShardListenersTime >= SHARD_LISTENERS_INTERVAL_USECS) {
+                sendShardListeners();
+                _lastShardListenersTime = now;
+            }
+            if (now - _lastShardClientPositionsTime >= SHARD_CLIENT_POSITIONS_INTERVAL_USECS) {
+                sendShardClientPositions();
+                _lastShardClientPositionsTime = now;
+            }
+        }
+
         int numToRetain = -1;
         assert(_throttlingRatio >= 0.0f && _throttlingRatio <= 1.0f);
         if (_throttlingRatio > EPSILON) {
             numToRetain = nodeList->size() * (1.0f - _throttlingRatio);
         }
+        // renders shared by mix clusters and shared encoded mixes are only good for one frame
+        _workerSharedData.mixClusterCache.clear();
+        _workerSharedData.encodeCache.clear();
+        // ...and so is the slaves' memory the renders were made in
+        _slavePool.each([](AudioMixerSlave& slave) {
+            slave.resetFrameArena();
+        });
+
+        // how far away each source can be heard from is worked out once, for all the listeners
+        {
+            auto prepareTimer = _prepareTiming.timer();
+            nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+                _workerSharedData.audibility.update(cbegin, cend);
+            });
+        }
+
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
             // mix across slave threads
             auto mixTimer = _mixTiming.timer();
@@ -472,6 +748,8 @@ void AudioMixer::start() {
             slave.stats.reset();
         });
 
+        _slavePool.autoscale(AudioConstants::NETWORK_FRAME_USECS);
+
         ++frame;
         ++_numStatFrames;
 
@@ -491,8 +769,32 @@ chrono::microseconds AudioMixer::timeFrame() {
     // compute how long the last frame took
     auto duration = chrono::duration_cast<chrono::microseconds>(now - _startFrameTimestamp);
 
+    static auto& frames = PerformanceCounters::getInstance().counter("frames", "Frames mixed");
+    static auto& frameOverruns = PerformanceCounters::getInstance().counter("frame_overruns",
+        "Frames that started after their time because the ones before took too long");
+    static auto& frameTime = PerformanceCounters::getInstance().histogram("frame_time_usecs",
+        "Time spent mixing each frame");
+    frames.increment();
+    frameTime.record((uint64_t)duration.count());
+
     _idealFrameTimestamp += chrono::microseconds(AudioConstants::NETWORK_FRAME_USECS);
 
+    if (now > _idealFrameTimestamp) {
+        frameOverruns.increment();
+
+        // this frame is starting late, so the mixer is overloaded even if throttling has not caught on yet
+        auto lateness = chrono::duration_cast<chrono::microseconds>(now - _idealFrameTimestamp);
+        ++_numLateFrames;
+        _maxFrameLateness = max(_maxFrameLateness, lateness);
+
+        // rather than sending a burst of frames to catch up, which clients would drop, restart the frame clock
+        const chrono::microseconds MAX_FRAME_LATENESS(AudioConstants::NETWORK_FRAME_USECS * 10);
+        if (lateness > MAX_FRAME_LATENESS) {
+            _idealFrameTimestamp = now;
+            ++_numFrameResyncs;
+        }
+    }
+
     {
         auto timer = _sleepTiming.timer();
         this_thread::sleep_until(_idealFrameTimestamp);
@@ -547,14 +849,39 @@ void AudioMixer::throttle(chrono::microseconds duration, int frame) {
     }
 }
 
+void AudioMixer::updateAvatarPoseTable() {
+    // the avatar mixer may start after us, or restart and make the table anew
+    if (!_avatarPoseTable.isFresh()) {
+        auto now = usecTimestampNow();
+        if (now >= _nextAvatarPoseTableAttach) {
+            _nextAvatarPoseTableAttach = now + USECS_PER_SECOND;
+            _avatarPoseTable.attach(DependencyManager::get<NodeList>()->getDomainHandler().getUUID());
+        }
+    }
+
+    auto freshAvatarPoseTable = _avatarPoseTable.isFresh() ? &_avatarPoseTable : nullptr;
+    if (freshAvatarPoseTable != _freshAvatarPoseTable) {
+        qCDebug(audio) << (freshAvatarPoseTable ? "Following" : "No longer following") << "the avatar mixer's avatar poses";
+        _freshAvatarPoseTable = freshAvatarPoseTable;
+    }
+}
+
 void AudioMixer::clearDomainSettings() {
     _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
+    _targetDelayPercentile = InboundAudioStream::DEFAULT_TARGET_DELAY_PERCENTILE;
     _attenuationPerDoublingInDistance = DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE;
     _noiseMutingThreshold = DEFAULT_NOISE_MUTING_THRESHOLD;
     _codecPreferenceOrder.clear();
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _mixClusterPositionTolerance = 0.0f;
+    _mixClusterOrientationTolerance = DEFAULT_MIX_CLUSTER_ORIENTATION_TOLERANCE;
+    _mixClusterNearFieldRadius = DEFAULT_MIX_CLUSTER_NEAR_FIELD_RADIUS;
+    _farFieldMixRadius = 0.0f;
+    _useSharedAvatarPoses = false;
+    _freshAvatarPoseTable = nullptr;
+    AudioMixerAudibility::setFloor(AudioMixerAudibility::DEFAULT_FLOOR);
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -564,6 +891,7 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         QJsonObject audioThreadingGroupObject = settingsObject[AUDIO_THREADING_GROUP_KEY].toObject();
         const QString AUTO_THREADS = "auto_threads";
         bool autoThreads = audioThreadingGroupObject[AUTO_THREADS].toBool();
+        _slavePool.setAutoscaling(autoThreads);
         if (!autoThreads) {
             bool ok;
             const QString NUM_THREADS = "num_threads";
@@ -573,6 +901,17 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        // the sockets sharing the mixer's port, each read on a thread of its own
+        const QString NUM_RECEIVE_THREADS = "num_receive_threads";
+        if (audioThreadingGroupObject.contains(NUM_RECEIVE_THREADS)) {
+            bool ok;
+            int numReceiveThreads = audioThreadingGroupObject[NUM_RECEIVE_THREADS].toVariant().toInt(&ok);
+            if (ok) {
+                DependencyManager::get<NodeList>()->setNumReceiveThreads(numReceiveThreads);
+                qCDebug(audio) << "Audio mixer will receive on" << numReceiveThreads << "threads";
+            }
+        }
+
         const QString THROTTLE_START_KEY = "throttle_start";
         const QString THROTTLE_BACKOFF_KEY = "throttle_backoff";
 
@@ -611,6 +950,14 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         } else {
             qCDebug(audio) << "Enabling dynamic jitter buffers.";
             _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
+
+            const QString TARGET_DELAY_PERCENTILE_KEY = "target_delay_percentile";
+            bool ok;
+            float targetDelayPercentile = audioBufferGroupObject[TARGET_DELAY_PERCENTILE_KEY].toString().toFloat(&ok);
+            if (ok && targetDelayPercentile > 0.0f && targetDelayPercentile <= 100.0f) {
+                _targetDelayPercentile = targetDelayPercentile / 100.0f;
+                qCDebug(audio) << "Dynamic jitter buffer target delay percentile:" << targetDelayPercentile;
+            }
         }
 
         // check for deprecated audio settings
@@ -686,6 +1033,64 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString MIX_CLUSTER_TOLERANCE = "mix_cluster_tolerance";
+        if (audioEnvGroupObject[MIX_CLUSTER_TOLERANCE].isString()) {
+            bool ok = false;
+            float tolerance = audioEnvGroupObject[MIX_CLUSTER_TOLERANCE].toString().toFloat(&ok);
+            if (ok && tolerance >= 0.0f) {
+                _mixClusterPositionTolerance = tolerance;
+                qCDebug(audio) << "Mix cluster position tolerance changed to" << _mixClusterPositionTolerance;
+            }
+        }
+
+        const QString MIX_CLUSTER_ORIENTATION_TOLERANCE = "mix_cluster_orientation_tolerance";
+        if (audioEnvGroupObject[MIX_CLUSTER_ORIENTATION_TOLERANCE].isString()) {
+            bool ok = false;
+            float degrees = audioEnvGroupObject[MIX_CLUSTER_ORIENTATION_TOLERANCE].toString().toFloat(&ok);
+            if (ok && degrees > 0.0f) {
+                _mixClusterOrientationTolerance = degrees * RADIANS_PER_DEGREE;
+                qCDebug(audio) << "Mix cluster orientation tolerance changed to" << degrees << "degrees";
+            }
+        }
+
+        const QString MIX_CLUSTER_NEAR_FIELD_RADIUS = "mix_cluster_near_field_radius";
+        if (audioEnvGroupObject[MIX_CLUSTER_NEAR_FIELD_RADIUS].isString()) {
+            bool ok = false;
+            float radius = audioEnvGroupObject[MIX_CLUSTER_NEAR_FIELD_RADIUS].toString().toFloat(&ok);
+            if (ok && radius >= 0.0f) {
+                _mixClusterNearFieldRadius = radius;
+                qCDebug(audio) << "Mix cluster near field radius changed to" << _mixClusterNearFieldRadius;
+            }
+        }
+
+        const QString FAR_FIELD_MIX_RADIUS = "far_field_mix_radius";
+        if (audioEnvGroupObject[FAR_FIELD_MIX_RADIUS].isString()) {
+            bool ok = false;
+            float radius = audioEnvGroupObject[FAR_FIELD_MIX_RADIUS].toString().toFloat(&ok);
+            if (ok && radius >= 0.0f) {
+                _farFieldMixRadius = radius;
+                qCDebug(audio) << "Far field mix radius changed to" << _farFieldMixRadius;
+            }
+        }
+
+        // take the avatars' poses from an avatar mixer on this host between audio packets
+        const QString SHARED_AVATAR_POSES = "shared_avatar_poses";
+        _useSharedAvatarPoses = audioEnvGroupObject[SHARED_AVATAR_POSES].toBool();
+        if (_useSharedAvatarPoses) {
+            qCDebug(audio) << "Following avatar poses shared by the avatar mixer on this host";
+        }
+
+        // in dB relative to full scale, 0 turns audibility culling off
+        const QString AUDIBILITY_FLOOR = "audibility_floor";
+        if (audioEnvGroupObject[AUDIBILITY_FLOOR].isString()) {
+            bool ok = false;
+            float floorDB = audioEnvGroupObject[AUDIBILITY_FLOOR].toString().toFloat(&ok);
+            if (ok && floorDB <= 0.0f) {
+                AudioMixerAudibility::setFloor(floorDB < 0.0f ? powf(10.0f, floorDB / 20.0f) : 0.0f);
+                qCDebug(audio) << "Audibility floor changed to" << floorDB << "dB";
+            }
+        }
+
         const QString AUDIO_ZONES = "zones";
         if (audioEnvGroupObject[AUDIO_ZONES].isObject()) {
             const QJsonObject& zones = audioEnvGroupObject[AUDIO_ZONES].toObject();
@@ -809,12 +1214,37 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
     }
 }
 
-AudioMixer::Timer::Timing::Timing(uint64_t& sum) : _sum(sum) {
+AudioMixer::Timer::Timing::Timing(Timer& timer) : _timer(timer) {
     _timing = p_high_resolution_clock::now();
 }
 
 AudioMixer::Timer::Timing::~Timing() {
-    _sum += chrono::duration_cast<chrono::microseconds>(p_high_resolution_clock::now() - _timing).count();
+    _timer.add(chrono::duration_cast<chrono::microseconds>(p_high_resolution_clock::now() - _timing).count());
+}
+
+// upper bounds of the histogram buckets, in percent of a frame; the last bucket holds everything over a frame
+static const int TIMER_HISTOGRAM_PERCENTS[] = { 10, 25, 50, 75, 100 };
+
+void AudioMixer::Timer::add(uint64_t timing) {
+    _sum += timing;
+
+    int bucket = 0;
+    while (bucket < TIMER_HISTOGRAM_BUCKETS - 1 &&
+           timing * 100 >= (uint64_t)TIMER_HISTOGRAM_PERCENTS[bucket] * AudioConstants::NETWORK_FRAME_USECS) {
+        ++bucket;
+    }
+    ++_histogram[bucket];
+}
+
+QJsonObject AudioMixer::Timer::getHistogram() {
+    QJsonObject histogram;
+    for (int i = 0; i < TIMER_HISTOGRAM_BUCKETS - 1; i++) {
+        histogram[QString("%1_under_%2%").arg(i).arg(TIMER_HISTOGRAM_PERCENTS[i])] = _histogram[i];
+    }
+    histogram[QString("%1_over_frame").arg(TIMER_HISTOGRAM_BUCKETS - 1)] = _histogram[TIMER_HISTOGRAM_BUCKETS - 1];
+
+    memset(_histogram, 0, sizeof(_histogram));
+    return histogram;
 }
 
 void AudioMixer::Timer::get(uint64_t& timing, uint64_t& trailing) {
@@ -12,6 +12,9 @@
 #ifndef hifi_AudioMixer_h
 #define hifi_AudioMixer_h
 
+#include <atomic>
+
+#include <QtCore/QJsonObject>
 #include <QtCore/QSharedPointer>
 
 #include <AABox.h>
@@ -22,6 +25,8 @@
 
 #include <plugins/Forward.h>
 
+#include "../AvatarPoseTable.h"
+#include "../MixerStandbyReplicator.h"
 #include "AudioMixerStats.h"
 #include "AudioMixerSlavePool.h"
 
@@ -53,15 +58,35 @@ public:
     };
 
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
+    static float getTargetDelayPercentile() { return _targetDelayPercentile; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
     static float getAttenuationPerDoublingInDistance() { return _attenuationPerDoublingInDistance; }
     static const std::vector<ZoneDescription>& getAudioZones() { return _audioZones; }
     static const std::vector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
     static const std::vector<ReverbSettings>& getReverbSettings() { return _zoneReverbSettings; }
+    static bool isMixClusteringEnabled() { return _mixClusterPositionTolerance > 0.0f; }
+    static float getMixClusterPositionTolerance() { return _mixClusterPositionTolerance; }
+    static float getMixClusterOrientationTolerance() { return _mixClusterOrientationTolerance; }
+    static float getMixClusterNearFieldRadius() { return _mixClusterNearFieldRadius; }
+    static bool isFarFieldMixingEnabled() { return _farFieldMixRadius > 0.0f; }
+    static float getFarFieldMixRadius() { return _farFieldMixRadius; }
+
+    // the avatar mixer's table of avatar poses on this host, null unless it's in use and up to date
+    static const AvatarPoseTable* getAvatarPoseTable() { return _freshAvatarPoseTable; }
     static const std::pair<QString, CodecPluginPointer> negotiateCodec(std::vector<QString> codecs);
 
+    // one of several mixers that each serve a part of the domain's clients, see shouldReplicateTo
+    static bool isShard() { return _isShard; }
+
     static bool shouldReplicateTo(const Node& from, const Node& to) {
-        return to.getType() == NodeType::DownstreamAudioMixer &&
+        // a shard replicates the streams of its own clients to the other shards, which mix them for their clients too,
+        // those their listeners can hear, see AudioMixerAudibility::isAudibleToAny
+        if (to.getType() == NodeType::AudioMixer) {
+            return _isShard && (from.getType() == NodeType::Agent || from.getType() == NodeType::EntityScriptServer) &&
+                !from.isUpstream();
+        }
+        // each shard replicates its own clients downstream, not those it has from the others
+        return from.isReplicated() && !(_isShard && from.isUpstream()) && to.getType() == NodeType::DownstreamAudioMixer &&
                to.getPublicSocket() != from.getPublicSocket() &&
                to.getLocalSocket() != from.getLocalSocket();
     }
@@ -78,8 +103,11 @@ private slots:
     void handleNodeMuteRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void handleNodeKilled(SharedNodePointer killedNode);
     void handleKillAvatarPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
+    void handleShardListenersPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
+    void handleShardKilledNodePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
 
     void queueAudioPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
+    void queueAudioFrame(const QSharedPointer<ReceivedMessage>& packet, const SharedNodePointer& sendingNode);
     void queueReplicatedAudioPacket(QSharedPointer<ReceivedMessage> packet);
     void removeHRTFsForFinishedInjector(const QUuid& streamID);
     void start();
@@ -90,45 +118,70 @@ private:
     void throttle(std::chrono::microseconds frameDuration, int frame);
 
     AudioMixerClientData* getOrCreateClientData(Node* node);
+    // for a caller holding the node's lock
+    AudioMixerClientData* getOrLinkClientData(Node* node);
 
     QString percentageForMixStats(int counter);
 
     void parseSettingsObject(const QJsonObject& settingsObject);
     void clearDomainSettings();
 
+    void updateAvatarPoseTable();
+
+    // tells the other shards where our listeners are, for them to forward only the streams those can hear,
+    // and the domain-server where our clients are, for it to give each shard those of a region
+    void sendShardListeners();
+    void sendShardClientPositions();
+    quint64 _lastShardListenersTime { 0 };
+    quint64 _lastShardClientPositionsTime { 0 };
+
     p_high_resolution_clock::time_point _idealFrameTimestamp;
     p_high_resolution_clock::time_point _startFrameTimestamp;
 
     float _trailingMixRatio { 0.0f };
     float _throttlingRatio { 0.0f };
 
-    int _numSilentPackets { 0 };
+    std::atomic<int> _numSilentPackets { 0 };  // also counted on the receiving thread
+
+    // frames that started after their deadline, and the times the frame clock gave up catching up
+    int _numLateFrames { 0 };
+    int _numFrameResyncs { 0 };
+    std::chrono::microseconds _maxFrameLateness { 0 };
 
     int _numStatFrames { 0 };
     AudioMixerStats _stats;
 
     AudioMixerSlavePool _slavePool { _workerSharedData };
 
+    MixerStandbyReplicator* _standbyReplicator { nullptr };
+
     class Timer {
     public:
         class Timing{
         public:
-            Timing(uint64_t& sum);
+            Timing(Timer& timer);
             ~Timing();
         private:
             p_high_resolution_clock::time_point _timing;
-            uint64_t& _sum;
+            Timer& _timer;
         };
 
-        Timing timer() { return Timing(_sum); }
+        Timing timer() { return Timing(*this); }
         void get(uint64_t& timing, uint64_t& trailing);
+
+        // counts of timings by the share of a frame they took, reset when read
+        QJsonObject getHistogram();
     private:
+        void add(uint64_t timing);
+
         static const int TIMER_TRAILING_SECONDS = 10;
+        static const int TIMER_HISTOGRAM_BUCKETS = 6;
 
         uint64_t _sum { 0 };
         uint64_t _trailing { 0 };
         uint64_t _history[TIMER_TRAILING_SECONDS] {};
         int _index { 0 };
+        int _histogram[TIMER_HISTOGRAM_BUCKETS] {};
     };
 
     Timer _ticTiming;
@@ -141,6 +194,7 @@ private:
     Timer _packetsTiming;
 
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
+    static float _targetDelayPercentile; // share of arrival gaps dynamic jitter buffers cover
     static float _noiseMutingThreshold;
     static float _attenuationPerDoublingInDistance;
     static std::map<QString, CodecPluginPointer> _availableCodecs;
@@ -150,6 +204,19 @@ private:
     static std::vector<ZoneSettings> _zoneSettings;
     static std::vector<ReverbSettings> _zoneReverbSettings;
 
+    static float _mixClusterPositionTolerance; // meters, 0 disables mix clustering
+    static float _mixClusterOrientationTolerance; // radians
+    static float _mixClusterNearFieldRadius; // meters
+
+    static float _farFieldMixRadius; // meters, 0 disables far field pre-mixing
+
+    static bool _useSharedAvatarPoses;
+    static bool _isShard;
+    static const AvatarPoseTable* _freshAvatarPoseTable; // set between frames, read by the slaves
+
+    AvatarPoseTable _avatarPoseTable;
+    quint64 _nextAvatarPoseTableAttach { 0 };
+
     float _throttleStartTarget = 0.9f;
     float _throttleBackoffTarget = 0.44f;
 
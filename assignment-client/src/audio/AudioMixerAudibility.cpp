@@ -0,0 +1,188 @@
+//
+//  AudioMixerAudibility.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerAudibility.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <AudioHRTF.h>
+#include <InjectedAudioStream.h>
+
+#include "AudioMixer.h"
+#include "AudioMixerClientData.h"
+
+namespace {
+
+// keep the cull distances, and their squares, finite
+const float MAX_CULL_DISTANCE = 1.0e9f;
+const float MAX_DISTANCE_SCALE = 1.0e6f;
+
+// attenuations weaker than this, per doubling of the distance, never make a source quiet enough to cull
+const float MIN_LOG2_GAIN_PER_DOUBLING = -1.0e-4f;
+
+// another shard's listeners are as old as its last report, which they may have walked this far from since
+const float SHARD_LISTENER_MARGIN = 2.0f;
+
+}
+
+const float AudioMixerAudibility::DEFAULT_FLOOR = 3.1623e-5f;
+
+float AudioMixerAudibility::_floor { DEFAULT_FLOOR };
+
+void AudioMixerAudibility::update(NodeList::const_iterator begin, NodeList::const_iterator end) {
+    _streams.clear();
+    _x.clear();
+    _y.clear();
+    _z.clear();
+    _isInjector.clear();
+    _cullDistance.clear();
+
+    // the distance attenuations a source can be heard with, as computeGain in AudioMixerSlave.cpp applies them
+    _log2GainsPerDoubling.clear();
+    _minCullDistance = 0.0f;
+    _isEnabled = isCullingEnabled();
+    auto addAttenuation = [&](float attenuationPerDoublingInDistance) {
+        if (attenuationPerDoublingInDistance < 0.0f) {
+            const float MIN_DISTANCE_LIMIT = ATTN_DISTANCE_REF + 1.0f;
+            float distanceLimit = std::max(-attenuationPerDoublingInDistance, MIN_DISTANCE_LIMIT);
+            _minCullDistance = std::max(_minCullDistance, distanceLimit);
+        } else if (attenuationPerDoublingInDistance < 1.0f) {
+            const float MIN_ATTENUATION_COEFFICIENT = 0.001f;
+            float g = glm::clamp(1.0f - attenuationPerDoublingInDistance, MIN_ATTENUATION_COEFFICIENT, 1.0f);
+            float log2Gain = std::log2(g);
+            if (log2Gain > MIN_LOG2_GAIN_PER_DOUBLING) {
+                _isEnabled = false;
+            }
+            _log2GainsPerDoubling.push_back(log2Gain);
+        }
+        // an attenuation of 1 is silent at any distance
+    };
+    addAttenuation(AudioMixer::getAttenuationPerDoublingInDistance());
+    for (const auto& settings : AudioMixer::getZoneSettings()) {
+        addAttenuation(settings.coefficient);
+    }
+    if (!_isEnabled) {
+        return;
+    }
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!nodeData) {
+            return;
+        }
+
+        for (auto& stream : nodeData->getAudioStreams()) {
+            // the trailing loudness is never under the loudness of the frame about to be mixed
+            float level = stream->getLastPopOutputTrailingLoudness();
+            bool isInjector = stream->getType() == PositionalAudioStream::Injector;
+            if (isInjector) {
+                level *= static_cast<const InjectedAudioStream*>(stream.get())->getAttenuationRatio();
+            }
+
+            // the distance at which the gain takes the source down to the floor, under the loosest attenuation:
+            // gain = gainPerDoubling ^ log2(distance / ATTN_DISTANCE_REF)
+            float cullDistance = 0.0f;
+            if (level > 0.0f) {
+                float log2FloorGain = std::log2(_floor / level);
+                for (float log2GainPerDoubling : _log2GainsPerDoubling) {
+                    cullDistance = std::max(cullDistance,
+                                            ATTN_DISTANCE_REF * std::exp2(log2FloorGain / log2GainPerDoubling));
+                }
+            }
+
+            stream->setAudibilityIndex((int)_streams.size());
+            _streams.push_back(stream.get());
+            const auto& position = stream->getPosition();
+            _x.push_back(position.x);
+            _y.push_back(position.y);
+            _z.push_back(position.z);
+            _isInjector.push_back(isInjector ? 1.0f : 0.0f);
+            _cullDistance.push_back(std::min(cullDistance, MAX_CULL_DISTANCE));
+        }
+    });
+}
+
+int AudioMixerAudibility::findSource(const PositionalAudioStream* stream) const {
+    int index = stream->getAudibilityIndex();
+    if (index >= 0 && index < (int)_streams.size() && _streams[index] == stream) {
+        return index;
+    }
+    return -1;
+}
+
+float AudioMixerAudibility::computeDistanceScale(float masterGain) const {
+    if (masterGain <= 0.0f) {
+        return 0.0f;
+    }
+
+    // a master gain of m takes a source down to the floor m ^ (-1 / log2(gainPerDoubling)) times further away
+    float scale = 0.0f;
+    float log2MasterGain = std::log2(masterGain);
+    for (float log2GainPerDoubling : _log2GainsPerDoubling) {
+        scale = std::max(scale, std::exp2(-log2MasterGain / log2GainPerDoubling));
+    }
+    return std::min(scale, MAX_DISTANCE_SCALE);
+}
+
+void AudioMixerAudibility::cull(const glm::vec3& listenerPosition, float masterAvatarGain, float masterInjectorGain,
+                                std::vector<uint8_t>& culled) const {
+    const size_t numSources = _streams.size();
+    culled.resize(numSources);
+    if (!_isEnabled) {
+        std::fill(culled.begin(), culled.end(), 0);
+        return;
+    }
+
+    const float avatarScale = computeDistanceScale(masterAvatarGain);
+    const float injectorScaleDelta = computeDistanceScale(masterInjectorGain) - avatarScale;
+    const float minCullDistance = _minCullDistance;
+    const float listenerX = listenerPosition.x;
+    const float listenerY = listenerPosition.y;
+    const float listenerZ = listenerPosition.z;
+
+    // branchless over the packed arrays, so that the compiler vectorizes it
+    const float* x = _x.data();
+    const float* y = _y.data();
+    const float* z = _z.data();
+    const float* isInjector = _isInjector.data();
+    const float* cullDistances = _cullDistance.data();
+    uint8_t* result = culled.data();
+    for (size_t i = 0; i < numSources; i++) {
+        float dx = x[i] - listenerX;
+        float dy = y[i] - listenerY;
+        float dz = z[i] - listenerZ;
+        float distance2 = dx * dx + dy * dy + dz * dz;
+        float cullDistance = std::max(cullDistances[i] * (avatarScale + isInjector[i] * injectorScaleDelta),
+                                      minCullDistance);
+        result[i] = (uint8_t)(distance2 > cullDistance * cullDistance);
+    }
+}
+
+bool AudioMixerAudibility::isAudibleToAny(const PositionalAudioStream* stream, const std::vector<Listener>& listeners) const {
+    if (listeners.empty()) {
+        return false;
+    }
+
+    int index = findSource(stream);
+    if (!_isEnabled || index < 0 || _cullDistance[index] == 0.0f) {
+        return true;
+    }
+
+    glm::vec3 sourcePosition(_x[index], _y[index], _z[index]);
+    return std::any_of(listeners.begin(), listeners.end(), [&](const Listener& listener) {
+        float masterGain = _isInjector[index] > 0.0f ? listener.masterInjectorGain : listener.masterAvatarGain;
+        float cullDistance = std::max(_cullDistance[index] * computeDistanceScale(masterGain), _minCullDistance) +
+            SHARD_LISTENER_MARGIN;
+        glm::vec3 offset = sourcePosition - listener.position;
+        return glm::dot(offset, offset) <= cullDistance * cullDistance;
+    });
+}
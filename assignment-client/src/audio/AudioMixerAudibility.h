@@ -0,0 +1,81 @@
+//
+//  AudioMixerAudibility.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerAudibility_h
+#define hifi_AudioMixerAudibility_h
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <NodeList.h>
+
+class PositionalAudioStream;
+
+// Tells which sources a listener can't hear, without computing the gain of each of them.
+// Once a frame, before mixing, the distance beyond which each source falls under the audibility floor is worked out
+// from its loudness and the loosest distance attenuation of the domain, into packed arrays. A listener then only
+// compares its distance to every source against those, scaled by its master gains, in one pass over the arrays.
+// The cull distances err on the side of mixing: off-axis attenuation, and zones that attenuate more, are left out.
+// update() must only be called between mixes; cull() and isAudibleToAny() are safe from any slave thread.
+class AudioMixerAudibility {
+public:
+    // a listener of another shard, which our clients' streams are only forwarded to when it can hear them
+    struct Listener {
+        glm::vec3 position;
+        float masterAvatarGain;
+        float masterInjectorGain;
+    };
+
+    // about one step of the 16-bit mix, -90 dB
+    static const float DEFAULT_FLOOR;
+
+    // set the floor, relative to full scale, under which a source isn't heard; 0 disables culling
+    static void setFloor(float floor) { _floor = floor; }
+    static float getFloor() { return _floor; }
+    static bool isCullingEnabled() { return _floor > 0.0f; }
+
+    // rebuild the table of sources from the streams of every node
+    void update(NodeList::const_iterator begin, NodeList::const_iterator end);
+
+    // the index of a stream in the table, or -1 if the stream wasn't there when it was built
+    int findSource(const PositionalAudioStream* stream) const;
+
+    // set culled[i] to 1 for each source i the listener can't hear, 0 otherwise
+    void cull(const glm::vec3& listenerPosition, float masterAvatarGain, float masterInjectorGain,
+              std::vector<uint8_t>& culled) const;
+
+    // whether any of the listeners can hear the stream as the table last had it, true for a silent stream or one that
+    // wasn't in the table, so that it isn't cut when it starts
+    bool isAudibleToAny(const PositionalAudioStream* stream, const std::vector<Listener>& listeners) const;
+
+private:
+    float computeDistanceScale(float masterGain) const;
+
+    static float _floor;
+
+    // the sources, structure of arrays so that cull() runs over them with SIMD
+    std::vector<const PositionalAudioStream*> _streams;
+    std::vector<float> _x;
+    std::vector<float> _y;
+    std::vector<float> _z;
+    std::vector<float> _isInjector;
+    std::vector<float> _cullDistance; // at a master gain of 1
+
+    // the logarithmic distance attenuations of the domain, as log2 of the gain per doubling of the distance
+    std::vector<float> _log2GainsPerDoubling;
+    // beyond which zones with a distance limit are silent, under which they're never culled
+    float _minCullDistance { 0.0f };
+    bool _isEnabled { false };
+};
+
+#endif // hifi_AudioMixerAudibility_h
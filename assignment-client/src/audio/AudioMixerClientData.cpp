@@ -19,6 +19,7 @@
 #include <QtCore/QJsonArray>
 
 #include <udt/PacketHeaders.h>
+#include <PerformanceCounters.h>
 #include <UUID.h>
 
 #include "InjectedAudioStream.h"
@@ -43,7 +44,15 @@ AudioMixerClientData::AudioMixerClientData(const QUuid& nodeID, Node::LocalID no
     _frameToSendStats = distribution(numberGenerator);
 }
 
+static PerformanceCounters::Gauge& inboundQueueDepth() {
+    static auto& gauge = PerformanceCounters::getInstance().gauge("inbound_queue_depth",
+        "Packets received and waiting for the mixer's next frame");
+    return gauge;
+}
+
 AudioMixerClientData::~AudioMixerClientData() {
+    inboundQueueDepth().add(-(double)_packetQueue.size());
+
     if (_codec) {
         _codec->releaseDecoder(_decoder);
         _codec->releaseEncoder(_encoder);
@@ -51,19 +60,31 @@ AudioMixerClientData::~AudioMixerClientData() {
 }
 
 void AudioMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+    std::lock_guard<std::mutex> lock(_packetQueueMutex);
     if (!_packetQueue.node) {
         _packetQueue.node = node;
     }
     _packetQueue.push(message);
+    inboundQueueDepth().add(1.0);
 }
 
-int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
-    SharedNodePointer node = _packetQueue.node;
-    assert(_packetQueue.empty() || node);
-    _packetQueue.node.clear();
+int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams,
+                                         const std::vector<SharedNodePointer>& downstreamMixers,
+                                         const AudioMixerAudibility& audibility) {
+    // take the queued packets, more may keep arriving on the receiving thread
+    {
+        std::lock_guard<std::mutex> lock(_packetQueueMutex);
+        _processingQueue.swap(_packetQueue);
+        _processingQueue.node.swap(_packetQueue.node);
+    }
+    inboundQueueDepth().add(-(double)_processingQueue.size());
+
+    SharedNodePointer node = _processingQueue.node;
+    assert(_processingQueue.empty() || node);
+    _processingQueue.node.clear();
 
-    while (!_packetQueue.empty()) {
-        auto& packet = _packetQueue.front();
+    while (!_processingQueue.empty()) {
+        auto& packet = _processingQueue.front();
 
         switch (packet->getType()) {
             case PacketType::MicrophoneAudioNoEcho:
@@ -74,9 +95,12 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
                     setupCodecForReplicatedAgent(packet);
                 }
 
-                processStreamPacket(*packet, addedStreams);
+                auto stream = processStreamPacket(*packet, addedStreams);
+                if (packet->getType() != PacketType::InjectAudio && !node->isUpstream()) {
+                    anchorToAvatarPose();
+                }
 
-                optionallyReplicatePacket(*packet, *node);
+                optionallyReplicatePacket(*packet, *node, stream, downstreamMixers, audibility);
                 break;
             }
             case PacketType::AudioStreamStats: {
@@ -111,9 +135,11 @@ int AudioMixerClientData::processPackets(ConcurrentAddedStreams& addedStreams) {
                 Q_UNREACHABLE();
         }
 
-        _packetQueue.pop();
+        _processingQueue.pop();
     }
-    assert(_packetQueue.empty());
+    assert(_processingQueue.empty());
+
+    followAvatarPose();
 
     // now that we have processed all packets for this frame
     // we can prepare the sources from this client to be ready for mixing
@@ -127,10 +153,13 @@ bool isReplicatedPacket(PacketType packetType) {
         || packetType == PacketType::ReplicatedSilentAudioFrame;
 }
 
-void AudioMixerClientData::optionallyReplicatePacket(ReceivedMessage& message, const Node& node) {
+void AudioMixerClientData::optionallyReplicatePacket(ReceivedMessage& message, const Node& node,
+                                                     const PositionalAudioStream* stream,
+                                                     const std::vector<SharedNodePointer>& downstreamMixers,
+                                                     const AudioMixerAudibility& audibility) {
 
     // first, make sure that this is a packet from a node we are supposed to replicate
-    if (node.isReplicated()) {
+    if (node.isReplicated() || (AudioMixer::isShard() && !node.isUpstream())) {
 
         // now make sure it's a packet type that we want to replicate
 
@@ -150,17 +179,28 @@ void AudioMixerClientData::optionallyReplicatePacket(ReceivedMessage& message, c
         std::unique_ptr<NLPacket> packet;
         auto nodeList = DependencyManager::get<NodeList>();
 
-        // enumerate the downstream audio mixers and send them the replicated version of this packet
-        nodeList->unsafeEachNode([&](const SharedNodePointer& downstreamNode) {
-            if (AudioMixer::shouldReplicateTo(node, *downstreamNode)) {
+        // another shard is only sent the streams its listeners can hear, but every silent frame, which are small
+        // and keep the stream going there
+        auto isHeardBy = [&](const Node& mixerNode) {
+            if (mixerNode.getType() != NodeType::AudioMixer || message.getType() == PacketType::SilentAudioFrame) {
+                return true;
+            }
+            auto mixerData = static_cast<const AudioMixerClientData*>(mixerNode.getLinkedData());
+            return stream && mixerData && audibility.isAudibleToAny(stream, mixerData->getShardListeners());
+        };
+
+        // send the replicated version of this packet to the downstream audio mixers gathered for this frame
+        for (const auto& downstreamNode : downstreamMixers) {
+            if (AudioMixer::shouldReplicateTo(node, *downstreamNode) && isHeardBy(*downstreamNode)) {
                 // construct the packet only once, if we have any downstream audio mixers to send to
                 if (!packet) {
                     // construct an NLPacket to send to the replicant that has the contents of the received packet
                     packet = NLPacket::create(mirroredType);
 
                     if (!isReplicatedPacket(message.getType())) {
-                        // since this packet will be non-sourced, we add the replicated node's ID here
+                        // since this packet will be non-sourced, we add the replicated node's IDs here
                         packet->write(node.getUUID().toRfc4122());
+                        packet->writePrimitive(node.getLocalID());
                     }
 
                     packet->write(message.getMessage());
@@ -168,7 +208,7 @@ void AudioMixerClientData::optionallyReplicatePacket(ReceivedMessage& message, c
                 
                 nodeList->sendUnreliablePacket(*packet, *downstreamNode);
             }
-        });
+        }
     }
 
 }
@@ -237,57 +277,45 @@ void AudioMixerClientData::parseNodeIgnoreRequest(QSharedPointer<ReceivedMessage
 
     // we have a vector of ignored or unignored node UUIDs - update our internal data structures so that
     // streams can be included or excluded next time a mix is being created
-    if (ignoredNodesPair.second) {
-        // we have newly ignored nodes, add them to our vector
-        _newIgnoredNodeIDs.insert(std::end(_newIgnoredNodeIDs),
-                                  std::begin(ignoredNodesPair.first), std::end(ignoredNodesPair.first));
-    } else {
-        // we have newly unignored nodes, add them to our vector
-        _newUnignoredNodeIDs.insert(std::end(_newUnignoredNodeIDs),
-                                    std::begin(ignoredNodesPair.first), std::end(ignoredNodesPair.first));
-    }
-
+    // only the connected nodes have streams, so those are the ones kept, by the local ID the streams carry
     auto nodeList = DependencyManager::get<NodeList>();
     for (auto& nodeID : ignoredNodesPair.first) {
         auto otherNode = nodeList->nodeWithUUID(nodeID);
         if (otherNode) {
+            if (ignoredNodesPair.second) {
+                _newIgnoredNodeIDs.insert(otherNode->getLocalID());
+            } else {
+                _newUnignoredNodeIDs.insert(otherNode->getLocalID());
+            }
+
             auto otherNodeMixerClientData = static_cast<AudioMixerClientData*>(otherNode->getLinkedData());
             if (otherNodeMixerClientData) {
                 if (ignoredNodesPair.second) {
-                    otherNodeMixerClientData->ignoredByNode(getNodeID());
+                    otherNodeMixerClientData->ignoredByNode(getNodeLocalID());
                 } else {
-                    otherNodeMixerClientData->unignoredByNode(getNodeID());
+                    otherNodeMixerClientData->unignoredByNode(getNodeLocalID());
                 }
             }
         }
     }
 }
 
-void AudioMixerClientData::ignoredByNode(QUuid nodeID) {
+void AudioMixerClientData::ignoredByNode(Node::LocalID nodeLocalID) {
     // first add this ID to the concurrent vector for newly ignoring nodes
-    _newIgnoringNodeIDs.push_back(nodeID);
+    _newIgnoringNodeIDs.push_back(nodeLocalID);
 
-    // now take a lock and on the consistent vector of ignoring nodes and make sure this node is in it
+    // now take a lock and on the consistent set of ignoring nodes and make sure this node is in it
     std::lock_guard<std::mutex> lock(_ignoringNodeIDsMutex);
-    if (std::find(_ignoringNodeIDs.begin(), _ignoringNodeIDs.end(), nodeID) == _ignoringNodeIDs.end()) {
-        _ignoringNodeIDs.push_back(nodeID);
-    }
+    _ignoringNodeIDs.insert(nodeLocalID);
 }
 
-void AudioMixerClientData::unignoredByNode(QUuid nodeID) {
+void AudioMixerClientData::unignoredByNode(Node::LocalID nodeLocalID) {
     // first add this ID to the concurrent vector for newly unignoring nodes
-    _newUnignoringNodeIDs.push_back(nodeID);
+    _newUnignoringNodeIDs.push_back(nodeLocalID);
 
-    // now take a lock on the consistent vector of ignoring nodes and make sure this node isn't in it
+    // now take a lock on the consistent set of ignoring nodes and make sure this node isn't in it
     std::lock_guard<std::mutex> lock(_ignoringNodeIDsMutex);
-    auto it = _ignoringNodeIDs.begin();
-    while (it != _ignoringNodeIDs.end()) {
-        if (*it == nodeID) {
-            it = _ignoringNodeIDs.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    _ignoringNodeIDs.erase(nodeLocalID);
 }
 
 void AudioMixerClientData::clearStagedIgnoreChanges() {
@@ -297,6 +325,11 @@ void AudioMixerClientData::clearStagedIgnoreChanges() {
     _newUnignoringNodeIDs.clear();
 }
 
+bool AudioMixerClientData::isIgnoredByNode(Node::LocalID nodeLocalID) {
+    std::lock_guard<std::mutex> lock(_ignoringNodeIDsMutex);
+    return _ignoringNodeIDs.contains(nodeLocalID);
+}
+
 void AudioMixerClientData::parseRadiusIgnoreRequest(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& node) {
     bool enabled;
     message->readPrimitive(&enabled);
@@ -334,6 +367,18 @@ void AudioMixerClientData::parseSoloRequest(QSharedPointer<ReceivedMessage> mess
     }
 }
 
+void AudioMixerClientData::updateSoloedNodeLocalIDs() {
+    // soloed nodes can come and go, or come back with another local ID, so this is redone for each mix
+    _soloedNodeLocalIDs.clear();
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (const auto& soloedUUID : _soloedNodes) {
+        auto soloedNode = nodeList->nodeWithUUID(soloedUUID);
+        if (soloedNode) {
+            _soloedNodeLocalIDs.insert(soloedNode->getLocalID());
+        }
+    }
+}
+
 AvatarAudioStream* AudioMixerClientData::getAvatarAudioStream() {
     auto it = std::find_if(_audioStreams.begin(), _audioStreams.end(), [](const SharedStreamPointer& stream){
         return stream->getStreamIdentifier().isNull();
@@ -433,11 +478,12 @@ bool AudioMixerClientData::containsValidPosition(ReceivedMessage& message) const
     return true;
 }
 
-void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, ConcurrentAddedStreams &addedStreams) {
+const PositionalAudioStream* AudioMixerClientData::processStreamPacket(ReceivedMessage& message,
+                                                                      ConcurrentAddedStreams &addedStreams) {
 
     if (!containsValidPosition(message)) {
         qDebug() << "Refusing to process audio stream from" << message.getSourceID() << "with invalid position";
-        return;
+        return nullptr;
     }
 
     SharedStreamPointer matchingStream;
@@ -475,6 +521,7 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
             }
 
             auto avatarAudioStream = new AvatarAudioStream(isStereo, AudioMixer::getStaticJitterFrames());
+            avatarAudioStream->setTargetDelayPercentile(AudioMixer::getTargetDelayPercentile());
             avatarAudioStream->setupCodec(_codec, _selectedCodecName, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
 
             if (_isIgnoreRadiusEnabled) {
@@ -514,6 +561,7 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
 
             // we don't have this injected stream yet, so add it
             auto injectorStream = new InjectedAudioStream(streamIdentifier, isStereo, AudioMixer::getStaticJitterFrames());
+            injectorStream->setTargetDelayPercentile(AudioMixer::getTargetDelayPercentile());
 
 #if INJECTORS_SUPPORT_CODECS
             injectorStream->setupCodec(_codec, _selectedCodecName, isStereo ? AudioConstants::STEREO : AudioConstants::MONO);
@@ -545,6 +593,39 @@ void AudioMixerClientData::processStreamPacket(ReceivedMessage& message, Concurr
         // whenever a stream is added, push it to the concurrent vector of streams added this frame
         addedStreams.push_back(AddedStream(getNodeID(), getNodeLocalID(), matchingStream->getStreamIdentifier(), matchingStream.get()));
     }
+    return matchingStream.get();
+}
+
+void AudioMixerClientData::anchorToAvatarPose() {
+    // further than this from the avatar, the listener has been placed apart from it and keeps the pose it sent
+    static const float MAX_AVATAR_POSE_OFFSET = 5.0f; // meters
+
+    _poseAnchor.isValid = false;
+    auto poseTable = AudioMixer::getAvatarPoseTable();
+    auto stream = getAvatarAudioStream();
+    AvatarPoseTable::Pose avatarPose;
+    if (!poseTable || !stream || !poseTable->read(getNodeLocalID(), getNodeID(), avatarPose)) {
+        return;
+    }
+
+    glm::quat inverseOrientation = glm::inverse(avatarPose.orientation);
+    glm::vec3 positionOffset = inverseOrientation * (stream->getPosition() - avatarPose.position);
+    if (glm::length(positionOffset) <= MAX_AVATAR_POSE_OFFSET) {
+        _poseAnchor = { true, positionOffset, inverseOrientation * stream->getOrientation() };
+    }
+}
+
+void AudioMixerClientData::followAvatarPose() {
+    auto poseTable = AudioMixer::getAvatarPoseTable();
+    auto stream = getAvatarAudioStream();
+    AvatarPoseTable::Pose avatarPose;
+    if (!_poseAnchor.isValid || !poseTable || !stream || !poseTable->read(getNodeLocalID(), getNodeID(), avatarPose)) {
+        return;
+    }
+
+    // where the avatar mixer has the avatar now, which may be later than the last audio packet
+    stream->setPose(avatarPose.position + avatarPose.orientation * _poseAnchor.positionOffset,
+                    avatarPose.orientation * _poseAnchor.orientationOffset);
 }
 
 int AudioMixerClientData::checkBuffersBeforeFrameSend() {
@@ -685,6 +766,8 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
         AudioStreamStats streamStats = avatarAudioStream->getAudioStreamStats();
         upstreamStats["mic.desired"] = streamStats._desiredJitterBufferFrames;
         upstreamStats["desired_calc"] = avatarAudioStream->getCalculatedJitterBufferFrames();
+        upstreamStats["desired_target"] = avatarAudioStream->getTargetDelayFrames();
+        upstreamStats["concealed"] = avatarAudioStream->getFramesConcealed();
         upstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
         upstreamStats["available"] = (double) streamStats._framesAvailable;
         upstreamStats["unplayed"] = (double) streamStats._unplayedMs;
@@ -722,6 +805,8 @@ QJsonObject AudioMixerClientData::getAudioStreamStats() {
             AudioStreamStats streamStats = injectorPair->getAudioStreamStats();
             upstreamStats["inj.desired"]  = streamStats._desiredJitterBufferFrames;
             upstreamStats["desired_calc"] = injectorPair->getCalculatedJitterBufferFrames();
+            upstreamStats["desired_target"] = injectorPair->getTargetDelayFrames();
+            upstreamStats["concealed"] = injectorPair->getFramesConcealed();
             upstreamStats["available_avg_10s"] = streamStats._framesAvailableAverage;
             upstreamStats["available"] = (double) streamStats._framesAvailable;
             upstreamStats["unplayed"] = (double) streamStats._unplayedMs;
@@ -12,6 +12,7 @@
 #ifndef hifi_AudioMixerClientData_h
 #define hifi_AudioMixerClientData_h
 
+#include <mutex>
 #include <queue>
 
 #if !defined(Q_MOC_RUN)
@@ -23,6 +24,7 @@
 #include <QtCore/QSharedPointer>
 
 #include <AABox.h>
+#include <AudioFOA.h>
 #include <AudioHRTF.h>
 #include <AudioLimiter.h>
 #include <UUIDHasher.h>
@@ -32,6 +34,7 @@
 
 #include "PositionalAudioStream.h"
 #include "AvatarAudioStream.h"
+#include "AudioMixerAudibility.h"
 
 class AudioMixerClientData : public NodeData {
     Q_OBJECT
@@ -54,7 +57,9 @@ public:
     using AudioStreamVector = std::vector<SharedStreamPointer>;
 
     void queuePacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer node);
-    int processPackets(ConcurrentAddedStreams& addedStreams); // returns the number of available streams this frame
+    int processPackets(ConcurrentAddedStreams& addedStreams,
+                       const std::vector<SharedNodePointer>& downstreamMixers,
+                       const AudioMixerAudibility& audibility); // returns the number of available streams this frame
 
     AudioStreamVector& getAudioStreams() { return _audioStreams; }
     AvatarAudioStream* getAvatarAudioStream();
@@ -63,7 +68,8 @@ public:
 
     // packet parsers
     int parseData(ReceivedMessage& message) override;
-    void processStreamPacket(ReceivedMessage& message, ConcurrentAddedStreams& addedStreams);
+    // returns the stream the packet was for, null if it was refused
+    const PositionalAudioStream* processStreamPacket(ReceivedMessage& message, ConcurrentAddedStreams& addedStreams);
     void negotiateAudioFormat(ReceivedMessage& message, const SharedNodePointer& node);
     void parseRequestsDomainListData(ReceivedMessage& message);
     void parsePerAvatarGainSet(ReceivedMessage& message, const SharedNodePointer& node);
@@ -91,8 +97,16 @@ public:
     float getMasterInjectorGain() const { return _masterInjectorGain; }
     void setMasterInjectorGain(float gain) { _masterInjectorGain = gain; }
 
+    // for another shard, its listeners as it last told us
+    const std::vector<AudioMixerAudibility::Listener>& getShardListeners() const { return _shardListeners; }
+    void setShardListeners(std::vector<AudioMixerAudibility::Listener> listeners) { _shardListeners = std::move(listeners); }
+
     AudioLimiter audioLimiter;
 
+    // binaural render of the sources pre-mixed into this listener's far field
+    AudioFOA farFieldFOA;
+    bool hasFarFieldHistory { false };
+
     void setupCodec(CodecPluginPointer codec, const QString& codecName);
     void cleanupCodec();
     void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
@@ -102,8 +116,10 @@ public:
             encodedBuffer = decodedBuffer;
         }
         // once you have encoded, you need to flush eventually.
-        _shouldFlushEncoder = true;
+        // stateless encoders hold nothing back, so silence can go out as a silent frame instead
+        _shouldFlushEncoder = _encoder && !_encoder->isStateless();
     }
+    const Encoder* getEncoder() const { return _encoder; }
     void encodeFrameOfZeros(QByteArray& encodedZeros);
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
 
@@ -124,6 +140,7 @@ public:
         PositionalAudioStream* positionalStream;
         bool ignoredByListener { false };
         bool ignoringListener { false };
+        bool isCulled { false };
 
         MixableStream(NodeIDStreamID nodeIDStreamID, PositionalAudioStream* positionalStream) :
             nodeStreamID(nodeIDStreamID), hrtf(new AudioHRTF), positionalStream(positionalStream) {};
@@ -141,24 +158,27 @@ public:
     Streams& getStreams() { return _streams; }
 
     // thread-safe, called from AudioMixerSlave(s) while processing ignore packets for other nodes
-    void ignoredByNode(QUuid nodeID);
-    void unignoredByNode(QUuid nodeID);
+    void ignoredByNode(Node::LocalID nodeLocalID);
+    void unignoredByNode(Node::LocalID nodeLocalID);
 
     // start of methods called non-concurrently from single AudioMixerSlave mixing for the owning node
 
-    const Node::IgnoredNodeIDs& getNewIgnoredNodeIDs() const { return _newIgnoredNodeIDs; }
-    const Node::IgnoredNodeIDs& getNewUnignoredNodeIDs() const { return _newUnignoredNodeIDs; }
+    // the ignore changes since the last mix, by local ID like the streams are
+    const LocalIDSet& getNewIgnoredNodeIDs() const { return _newIgnoredNodeIDs; }
+    const LocalIDSet& getNewUnignoredNodeIDs() const { return _newUnignoredNodeIDs; }
 
-    using ConcurrentIgnoreNodeIDs = tbb::concurrent_vector<QUuid>;
+    using ConcurrentIgnoreNodeIDs = tbb::concurrent_vector<Node::LocalID>;
     const ConcurrentIgnoreNodeIDs& getNewIgnoringNodeIDs() const { return _newIgnoringNodeIDs; }
     const ConcurrentIgnoreNodeIDs& getNewUnignoringNodeIDs() const { return _newUnignoringNodeIDs; }
 
     void clearStagedIgnoreChanges();
 
-    const Node::IgnoredNodeIDs& getIgnoringNodeIDs() const { return _ignoringNodeIDs; }
-
+    bool isIgnoredByNode(Node::LocalID nodeLocalID);
 
     const std::vector<QUuid>& getSoloedNodes() const { return _soloedNodes; }
+    // the soloed nodes are looked up once a mix, so the check of each stream is a bit test
+    void updateSoloedNodeLocalIDs();
+    bool isSoloing(Node::LocalID nodeLocalID) const { return _soloedNodeLocalIDs.contains(nodeLocalID); }
 
     bool getHasReceivedFirstMix() const { return _hasReceivedFirstMix; }
     void setHasReceivedFirstMix(bool hasReceivedFirstMix) { _hasReceivedFirstMix = hasReceivedFirstMix; }
@@ -176,16 +196,24 @@ private:
     struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
         QWeakPointer<Node> node;
     };
-    PacketQueue _packetQueue;
+    PacketQueue _packetQueue;       // filled by the receiving thread
+    PacketQueue _processingQueue;   // drained by the slave pool
+    std::mutex _packetQueueMutex;
 
     AudioStreamVector _audioStreams; // microphone stream from avatar has a null stream ID
 
-    void optionallyReplicatePacket(ReceivedMessage& packet, const Node& node);
+    void optionallyReplicatePacket(ReceivedMessage& packet, const Node& node, const PositionalAudioStream* stream,
+                                   const std::vector<SharedNodePointer>& downstreamMixers,
+                                   const AudioMixerAudibility& audibility);
 
     void setGainForAvatar(QUuid nodeID, float gain);
 
     bool containsValidPosition(ReceivedMessage& message) const;
 
+    // the microphone stream's pose relative to the avatar's in the avatar mixer's shared table
+    void anchorToAvatarPose();
+    void followAvatarPose();
+
     Streams _streams;
 
     quint16 _outgoingMixedAudioSequenceNumber;
@@ -197,6 +225,8 @@ private:
     float _masterAvatarGain { 1.0f };   // per-listener mixing gain, applied only to avatars
     float _masterInjectorGain { 1.0f }; // per-listener mixing gain, applied only to injectors
 
+    std::vector<AudioMixerAudibility::Listener> _shardListeners;
+
     CodecPluginPointer _codec;
     QString _selectedCodecName;
     Encoder* _encoder{ nullptr }; // for outbound mixed stream
@@ -209,20 +239,28 @@ private:
 
     std::vector<AddedStream> _newAddedStreams;
 
-    Node::IgnoredNodeIDs _newIgnoredNodeIDs;
-    Node::IgnoredNodeIDs _newUnignoredNodeIDs;
+    LocalIDSet _newIgnoredNodeIDs;
+    LocalIDSet _newUnignoredNodeIDs;
 
-    tbb::concurrent_vector<QUuid> _newIgnoringNodeIDs;
-    tbb::concurrent_vector<QUuid> _newUnignoringNodeIDs;
+    ConcurrentIgnoreNodeIDs _newIgnoringNodeIDs;
+    ConcurrentIgnoreNodeIDs _newUnignoringNodeIDs;
 
     std::mutex _ignoringNodeIDsMutex;
-    Node::IgnoredNodeIDs _ignoringNodeIDs;
+    LocalIDSet _ignoringNodeIDs;
 
     std::atomic_bool _isIgnoreRadiusEnabled { false };
 
     std::vector<QUuid> _soloedNodes;
+    LocalIDSet _soloedNodeLocalIDs;
 
     bool _hasReceivedFirstMix { false };
+
+    struct PoseAnchor {
+        bool isValid { false };
+        glm::vec3 positionOffset; // in the avatar's frame
+        glm::quat orientationOffset;
+    };
+    PoseAnchor _poseAnchor;
 };
 
 #endif // hifi_AudioMixerClientData_h
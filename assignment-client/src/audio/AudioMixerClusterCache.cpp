@@ -0,0 +1,70 @@
+//
+//  AudioMixerClusterCache.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerClusterCache.h"
+
+#include <functional>
+
+#include <GLMHelpers.h>
+
+AudioMixerClusterCache::ClusterKey AudioMixerClusterCache::computeClusterKey(const glm::vec3& position,
+                                                                           const glm::quat& orientation,
+                                                                           float masterAvatarGain,
+                                                                           float masterInjectorGain,
+                                                                           float positionTolerance,
+                                                                           float orientationTolerance) {
+    ClusterKey key;
+    glm::vec3 cell = glm::floor(position / positionTolerance);
+    key.x = (int32_t)cell.x;
+    key.y = (int32_t)cell.y;
+    key.z = (int32_t)cell.z;
+
+    // listeners that face the same way within the tolerance hear sources at the same azimuth
+    glm::vec3 front = orientation * Vectors::FRONT;
+    float yaw = atan2f(front.x, front.z);
+    key.yaw = (int32_t)floorf(yaw / orientationTolerance);
+
+    key.masterAvatarGain = masterAvatarGain;
+    key.masterInjectorGain = masterInjectorGain;
+    return key;
+}
+
+size_t AudioMixerClusterCache::KeyHasher::operator()(const Key& key) const {
+    size_t hash = std::hash<const void*>()(key.source);
+    auto combine = [&hash](size_t value) {
+        hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    };
+    combine(std::hash<int32_t>()(key.cluster.x));
+    combine(std::hash<int32_t>()(key.cluster.y));
+    combine(std::hash<int32_t>()(key.cluster.z));
+    combine(std::hash<int32_t>()(key.cluster.yaw));
+    combine(std::hash<float>()(key.cluster.masterAvatarGain));
+    combine(std::hash<float>()(key.cluster.masterInjectorGain));
+    return hash;
+}
+
+AudioMixerClusterCache::Render& AudioMixerClusterCache::findOrInsert(const ClusterKey& cluster,
+                                                                     const PositionalAudioStream* source,
+                                                                     FrameArena& arena, bool& shouldRender) {
+    Key key { cluster, source };
+
+    auto it = _renders.find(key);
+    if (it != _renders.end()) {
+        shouldRender = false;
+        return *it->second;
+    }
+
+    // another listener in the cluster may beat us to the insert, in which case we use theirs
+    // and ours sits unused in the arena until it is reset
+    auto result = _renders.insert({ key, arena.create<Render>() });
+    shouldRender = result.second;
+    return *result.first->second;
+}
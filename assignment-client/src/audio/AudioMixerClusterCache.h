@@ -0,0 +1,81 @@
+//
+//  AudioMixerClusterCache.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerClusterCache_h
+#define hifi_AudioMixerClusterCache_h
+
+#include <atomic>
+#include <memory>
+
+#if !defined(Q_MOC_RUN)
+// Work around https://bugreports.qt.io/browse/QTBUG-80990
+#include <tbb/concurrent_unordered_map.h>
+#endif
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <AudioConstants.h>
+#include <FrameArena.h>
+
+class PositionalAudioStream;
+
+// Holds one frame of HRTF renders of distant sources, shared by listeners that stand in the same "mix cluster":
+// a cell of the position grid and orientation wedge the listener falls into, with the same master gains.
+// Lookups and inserts are safe from any slave thread; clear() must only be called between mixes.
+// The renders live in the frame arenas of the slaves that created them, so it is cleared before those are reset.
+class AudioMixerClusterCache {
+public:
+    struct ClusterKey {
+        int32_t x { 0 };
+        int32_t y { 0 };
+        int32_t z { 0 };
+        int32_t yaw { 0 };
+        float masterAvatarGain { 1.0f };
+        float masterInjectorGain { 1.0f };
+    };
+
+    struct Render {
+        std::atomic<bool> isReady { false };
+        float samples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    };
+
+    static ClusterKey computeClusterKey(const glm::vec3& position, const glm::quat& orientation,
+                                        float masterAvatarGain, float masterInjectorGain,
+                                        float positionTolerance, float orientationTolerance);
+
+    // find the render of a source for a cluster, creating it in arena if needed
+    // shouldRender is set for the one caller that created it and must fill it in
+    Render& findOrInsert(const ClusterKey& cluster, const PositionalAudioStream* source, FrameArena& arena,
+                         bool& shouldRender);
+
+    void clear() { _renders.clear(); }
+
+private:
+    struct Key {
+        ClusterKey cluster;
+        const PositionalAudioStream* source;
+
+        bool operator==(const Key& other) const {
+            return cluster.x == other.cluster.x && cluster.y == other.cluster.y && cluster.z == other.cluster.z &&
+                cluster.yaw == other.cluster.yaw && cluster.masterAvatarGain == other.cluster.masterAvatarGain &&
+                cluster.masterInjectorGain == other.cluster.masterInjectorGain && source == other.source;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    tbb::concurrent_unordered_map<Key, Render*, KeyHasher> _renders;
+};
+
+#endif // hifi_AudioMixerClusterCache_h
@@ -0,0 +1,42 @@
+//
+//  AudioMixerEncodeCache.cpp
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerEncodeCache.h"
+
+#include <functional>
+
+#include <QtCore/QHash>
+
+size_t AudioMixerEncodeCache::KeyHasher::operator()(const Key& key) const {
+    size_t hash = std::hash<const void*>()(key.encoder);
+    hash ^= (size_t)qHash(key.decodedBuffer) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+AudioMixerEncodeCache::EncodedFrame& AudioMixerEncodeCache::findOrInsert(const Encoder* encoder,
+                                                                         const QByteArray& decodedBuffer,
+                                                                         bool& shouldEncode) {
+    Key key { encoder, decodedBuffer };
+
+    auto it = _frames.find(key);
+    if (it != _frames.end()) {
+        shouldEncode = false;
+        return *it->second;
+    }
+
+    // the mix may be borrowed from a slave's mixing buffer, so the cache keeps its own copy
+    key.decodedBuffer.detach();
+
+    // another listener with the same mix may beat us to the insert, in which case we use theirs
+    auto result = _frames.insert({ key, std::unique_ptr<EncodedFrame>(new EncodedFrame()) });
+    shouldEncode = result.second;
+    return *result.first->second;
+}
@@ -0,0 +1,59 @@
+//
+//  AudioMixerEncodeCache.h
+//  assignment-client/src/audio
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioMixerEncodeCache_h
+#define hifi_AudioMixerEncodeCache_h
+
+#include <atomic>
+#include <memory>
+
+#if !defined(Q_MOC_RUN)
+// Work around https://bugreports.qt.io/browse/QTBUG-80990
+#include <tbb/concurrent_unordered_map.h>
+#endif
+
+#include <QtCore/QByteArray>
+
+class Encoder;
+
+// Holds one frame of encoded mixes, shared by listeners whose stateless encoders were handed bit-identical mixes.
+// Lookups and inserts are safe from any slave thread; clear() must only be called between mixes.
+class AudioMixerEncodeCache {
+public:
+    struct EncodedFrame {
+        std::atomic<bool> isReady { false };
+        QByteArray encodedBuffer;
+    };
+
+    // find the encoded frame of a mix, creating it if needed
+    // shouldEncode is set for the one caller that created it and must fill it in
+    EncodedFrame& findOrInsert(const Encoder* encoder, const QByteArray& decodedBuffer, bool& shouldEncode);
+
+    void clear() { _frames.clear(); }
+
+private:
+    struct Key {
+        const Encoder* encoder;
+        QByteArray decodedBuffer;
+
+        bool operator==(const Key& other) const {
+            return encoder == other.encoder && decodedBuffer == other.decodedBuffer;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    tbb::concurrent_unordered_map<Key, std::unique_ptr<EncodedFrame>, KeyHasher> _frames;
+};
+
+#endif // hifi_AudioMixerEncodeCache_h
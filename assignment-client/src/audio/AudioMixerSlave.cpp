@@ -18,6 +18,7 @@
 #include <glm/gtx/vector_angle.hpp>
 
 #include <LogHandler.h>
+#include <MemoryAccounting.h>
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
@@ -41,6 +42,8 @@ using AudioStreamVector = AudioMixerClientData::AudioStreamVector;
 using MixableStream = AudioMixerClientData::MixableStream;
 using MixableStreamsVector = AudioMixerClientData::MixableStreamsVector;
 
+static const int HRTF_DATASET_INDEX = 1;
+
 // packet helpers
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec);
 void sendMixPacket(const SharedNodePointer& node, AudioMixerClientData& data, QByteArray& buffer);
@@ -56,10 +59,11 @@ inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const
         const glm::vec3& relativePosition);
 
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
+    MemoryAccounting::Scope memoryScope(MemoryTag::Audio);
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data) {
         // process packets and collect the number of streams available for this frame
-        stats.sumStreams += data->processPackets(_sharedData.addedStreams);
+        stats.sumStreams += data->processPackets(_sharedData.addedStreams, _sharedData.downstreamMixers, _sharedData.audibility);
     }
 }
 
@@ -70,7 +74,15 @@ void AudioMixerSlave::configureMix(ConstIter begin, ConstIter end, unsigned int
     _numToRetain = numToRetain;
 }
 
+void AudioMixerSlave::resetFrameArena() {
+    auto arenaStats = _frameArena.takeStats();
+    stats.arenaAllocations += (int)arenaStats.numAllocations;
+    stats.arenaBlockAllocations += (int)arenaStats.numBlockAllocations;
+    _frameArena.reset();
+}
+
 void AudioMixerSlave::mix(const SharedNodePointer& node) {
+    MemoryAccounting::Scope memoryScope(MemoryTag::Audio);
     // check that the node is valid
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
     if (data == nullptr) {
@@ -103,9 +115,10 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
         if (mixHasAudio || data->shouldFlushEncoder()) {
             QByteArray encodedBuffer;
             if (mixHasAudio) {
-                // encode the audio
-                QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
+                // encode the audio, straight from the mixing buffer: only what is kept past this listener is copied
+                QByteArray decodedBuffer = QByteArray::fromRawData(reinterpret_cast<char*>(_bufferSamples),
+                                                                   AudioConstants::NETWORK_FRAME_BYTES_STEREO);
+                encodeMix(*data, decodedBuffer, encodedBuffer);
             } else {
                 // time to flush (resets shouldFlush until the next encode)
                 data->encodeFrameOfZeros(encodedBuffer);
@@ -179,9 +192,6 @@ private:
 
 
 void AudioMixerSlave::addStreams(Node& listener, AudioMixerClientData& listenerData) {
-    auto& ignoredNodeIDs = listener.getIgnoredNodeIDs();
-    auto& ignoringNodeIDs = listenerData.getIgnoringNodeIDs();
-
     auto& streams = listenerData.getStreams();
 
     // add data for newly created streams to our vector
@@ -190,9 +200,10 @@ void AudioMixerSlave::addStreams(Node& listener, AudioMixerClientData& listenerD
         std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
             AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
             if (nodeData) {
+                bool ignoredByListener = listener.isIgnoringNodeWithLocalID(node->getLocalID());
+                bool ignoringListener = listenerData.isIgnoredByNode(node->getLocalID());
+
                 for (auto& stream : nodeData->getAudioStreams()) {
-                    bool ignoredByListener = contains(ignoredNodeIDs, node->getUUID());
-                    bool ignoringListener = contains(ignoringNodeIDs, node->getUUID());
 
                     if (ignoredByListener || ignoringListener) {
                         streams.skipped.emplace_back(node->getUUID(), node->getLocalID(),
@@ -213,8 +224,8 @@ void AudioMixerSlave::addStreams(Node& listener, AudioMixerClientData& listenerD
         listenerData.setHasReceivedFirstMix(true);
     } else {
         for (const auto& newStream : _sharedData.addedStreams) {
-            bool ignoredByListener = contains(ignoredNodeIDs, newStream.nodeIDStreamID.nodeID);
-            bool ignoringListener = contains(ignoringNodeIDs, newStream.nodeIDStreamID.nodeID);
+            bool ignoredByListener = listener.isIgnoringNodeWithLocalID(newStream.nodeIDStreamID.nodeLocalID);
+            bool ignoringListener = listenerData.isIgnoredByNode(newStream.nodeIDStreamID.nodeLocalID);
 
             if (ignoredByListener || ignoringListener) {
                 streams.skipped.emplace_back(newStream.nodeIDStreamID, newStream.positionalStream);
@@ -242,8 +253,9 @@ bool shouldBeInactive(MixableStream& stream) {
 bool shouldBeSkipped(MixableStream& stream, const Node& listener,
                      const AvatarAudioStream& listenerAudioStream,
                      const AudioMixerClientData& listenerData) {
+    const Node::LocalID streamNodeLocalID = stream.nodeStreamID.nodeLocalID;
 
-    if (stream.nodeStreamID.nodeLocalID == listener.getLocalID()) {
+    if (streamNodeLocalID == listener.getLocalID()) {
         return !stream.positionalStream->shouldLoopbackForNode();
     }
 
@@ -256,15 +268,15 @@ bool shouldBeSkipped(MixableStream& stream, const Node& listener,
     // this stream was previously not ignored by the listener and we have some newly ignored streams
     // check now if it is one of the ignored streams and flag it as such
     if (stream.ignoredByListener) {
-        stream.ignoredByListener = !contains(nodesUnignoredByListener, stream.nodeStreamID.nodeID);
+        stream.ignoredByListener = !nodesUnignoredByListener.contains(streamNodeLocalID);
     } else {
-        stream.ignoredByListener = contains(nodesIgnoredByListener, stream.nodeStreamID.nodeID);
+        stream.ignoredByListener = nodesIgnoredByListener.contains(streamNodeLocalID);
     }
 
     if (stream.ignoringListener) {
-        stream.ignoringListener = !contains(nodesUnignoringListener, stream.nodeStreamID.nodeID);
+        stream.ignoringListener = !contains(nodesUnignoringListener, streamNodeLocalID);
     } else {
-        stream.ignoringListener = contains(nodesIgnoringListener, stream.nodeStreamID.nodeID);
+        stream.ignoringListener = contains(nodesIgnoringListener, streamNodeLocalID);
     }
 
     bool listenerIsAdmin = listenerData.getRequestsDomainListData() && listener.getCanKick();
@@ -273,7 +285,7 @@ bool shouldBeSkipped(MixableStream& stream, const Node& listener,
     }
 
     if (!listenerData.getSoloedNodes().empty()) {
-        return !contains(listenerData.getSoloedNodes(), stream.nodeStreamID.nodeID);
+        return !listenerData.isSoloing(streamNodeLocalID);
     }
 
     bool shouldCheckIgnoreBox = (listenerAudioStream.isIgnoreBoxEnabled() ||
@@ -315,6 +327,33 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
 
     bool isThrottling = _numToRetain != -1;
     bool isSoloing = !listenerData->getSoloedNodes().empty();
+    if (isSoloing) {
+        listenerData->updateSoloedNodeLocalIDs();
+    }
+
+    _isFarFieldMixing = AudioMixer::isFarFieldMixingEnabled();
+    _numFarFieldSources = 0;
+    if (_isFarFieldMixing) {
+        memset(_farFieldSamples, 0, sizeof(_farFieldSamples));
+    }
+
+    // soloing listeners hear a different mix than their neighbours, so they never share renders
+    _isClustering = AudioMixer::isMixClusteringEnabled() && !isSoloing && listenerAudioStream;
+    if (_isClustering) {
+        _listenerClusterKey = AudioMixerClusterCache::computeClusterKey(listenerAudioStream->getPosition(),
+                                                                        listenerAudioStream->getOrientation(),
+                                                                        listenerData->getMasterAvatarGain(),
+                                                                        listenerData->getMasterInjectorGain(),
+                                                                        AudioMixer::getMixClusterPositionTolerance(),
+                                                                        AudioMixer::getMixClusterOrientationTolerance());
+    }
+
+    // soloed sources are heard at the master gain wherever they are, so they're never culled
+    _isCulling = AudioMixerAudibility::isCullingEnabled() && !isSoloing && listenerAudioStream;
+    if (_isCulling) {
+        _sharedData.audibility.cull(listenerAudioStream->getPosition(), listenerData->getMasterAvatarGain(),
+                                    listenerData->getMasterInjectorGain(), _culledSources);
+    }
 
     auto& streams = listenerData->getStreams();
 
@@ -387,6 +426,15 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                 return true;
             }
 
+            if (shouldBeCulled(stream, listenerAudioStream)) {
+                if (shouldBeInactive(stream)) {
+                    streams.inactive.push_back(move(stream));
+                    ++stats.activeToInactive;
+                    return true;
+                }
+                return false;
+            }
+
             addStream(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(), listenerData->getMasterInjectorGain(),
                       isSoloing);
 
@@ -423,6 +471,15 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                 return true;
             }
 
+            if (shouldBeCulled(stream, listenerAudioStream)) {
+                if (shouldBeInactive(stream)) {
+                    streams.inactive.push_back(move(stream));
+                    ++stats.activeToInactive;
+                    return true;
+                }
+                return false;
+            }
+
             addStream(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(), listenerData->getMasterInjectorGain(),
                       isSoloing);
 
@@ -473,6 +530,8 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     stats.mixTime += mixTime.count();
 #endif
 
+    renderFarField(*listenerData);
+
     // check for silent audio before limiting
     // limiting uses a dither and can only guarantee abs(sample) <= 1
     bool hasAudio = false;
@@ -510,7 +569,8 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
                                                    relativePosition, distance));
     float azimuth = isEcho ? 0.0f : computeAzimuth(listeningNodeStream, listeningNodeStream, relativePosition);
 
-    const int HRTF_DATASET_INDEX = 1;
+    bool isFarField = _isFarFieldMixing && !isEcho && !streamToAdd->isStereo() &&
+        distance > AudioMixer::getFarFieldMixRadius();
 
     if (!streamToAdd->lastPopSucceeded()) {
         bool forceSilentBlock = true;
@@ -533,8 +593,8 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
 
         if (forceSilentBlock) {
             // call renderSilent with a forced silent block to reduce artifacts
-            // (this is not done for stereo streams since they do not go through the HRTF)
-            if (!streamToAdd->isStereo() && !isEcho) {
+            // (this is not done for stereo or far field streams since they do not go through the HRTF)
+            if (!streamToAdd->isStereo() && !isEcho && !isFarField) {
                 static int16_t silentMonoBlock[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL] = {};
                 mixableStream.hrtf->render(silentMonoBlock, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
                                            AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
@@ -565,6 +625,51 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
         mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualEchoMixes;
+    } else if (isFarField) {
+
+        streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+        // the per-avatar gain is normally applied inside the HRTF, which this source bypasses
+        addFarFieldSource(_bufferSamples, azimuth, gain * mixableStream.hrtf->getGainAdjustment());
+
+        // keep the HRTF state current so the source glides when it comes back into the near field
+        mixableStream.hrtf->setParameterHistory(azimuth, distance, gain);
+        ++stats.farFieldMixes;
+    } else if (_isClustering && distance > AudioMixer::getMixClusterNearFieldRadius() &&
+               mixableStream.hrtf->getGainAdjustment() == 1.0f) {
+
+        // distant sources sound the same to every listener in the cluster, so the first one to get here renders
+        // for all of them; anyone that finds the render still in progress renders on their own
+        // (a per-avatar gain set by the listener is applied inside the HRTF, so those streams are never shared)
+        bool shouldRender = false;
+        auto& render = _sharedData.mixClusterCache.findOrInsert(_listenerClusterKey, streamToAdd, _frameArena, shouldRender);
+
+        if (shouldRender) {
+            streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+            memset(render.samples, 0, sizeof(render.samples));
+            mixableStream.hrtf->render(_bufferSamples, render.samples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                                       AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            render.isReady.store(true, std::memory_order_release);
+            ++stats.hrtfRenders;
+            ++stats.clusterMisses;
+
+            mixClusterRender(render);
+        } else if (render.isReady.load(std::memory_order_acquire)) {
+            // keep this listener's HRTF state current so it glides when it leaves the cluster
+            mixableStream.hrtf->setParameterHistory(azimuth, distance, gain);
+            ++stats.hrtfUpdates;
+            ++stats.clusterHits;
+
+            mixClusterRender(render);
+        } else {
+            streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+            mixableStream.hrtf->render(_bufferSamples, _mixSamples, HRTF_DATASET_INDEX, azimuth, distance, gain,
+                                       AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            ++stats.hrtfRenders;
+            ++stats.clusterMisses;
+        }
     } else {
 
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
@@ -575,6 +680,46 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
     }
 }
 
+void AudioMixerSlave::mixClusterRender(const AudioMixerClusterCache::Render& render) {
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i++) {
+        _mixSamples[i] += render.samples[i];
+    }
+}
+
+void AudioMixerSlave::addFarFieldSource(const int16_t* samples, float azimuth, float gain) {
+    // encode as a horizontal plane wave, in FuMa normalization relative to the listener
+    // azimuth is clockwise from the front, the soundfield Y axis points left
+    const float SQRT1_2 = 0.707106781f;
+    const float scale = gain * (1 / 32768.0f);
+    const float w = scale * SQRT1_2;
+    const float x = scale * cosf(azimuth);
+    const float y = -scale * sinf(azimuth);
+
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; i++) {
+        float sample = (float)samples[i];
+        _farFieldSamples[0][i] += w * sample;
+        _farFieldSamples[1][i] += x * sample;
+        _farFieldSamples[2][i] += y * sample;
+    }
+
+    ++_numFarFieldSources;
+}
+
+void AudioMixerSlave::renderFarField(AudioMixerClientData& listenerData) {
+    // render one more frame after the last far field source leaves, to flush the FOA tail
+    if (_numFarFieldSources > 0 || (_isFarFieldMixing && listenerData.hasFarFieldHistory)) {
+        const float* const soundfield[4] = { _farFieldSamples[0], _farFieldSamples[1], _farFieldSamples[2],
+                                             _farFieldSamples[3] };
+
+        // the soundfield is already listener-relative, so it is rendered without rotation
+        listenerData.farFieldFOA.render(soundfield, _mixSamples, HRTF_DATASET_INDEX, 1.0f, 0.0f, 0.0f, 0.0f, 1.0f,
+                                        AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+        ++stats.farFieldRenders;
+    }
+
+    listenerData.hasFarFieldHistory = _numFarFieldSources > 0;
+}
+
 void AudioMixerSlave::updateHRTFParameters(AudioMixerClientData::MixableStream& mixableStream,
                                            AvatarAudioStream& listeningNodeStream,
                                            float masterAvatarGain,
@@ -601,6 +746,55 @@ void AudioMixerSlave::resetHRTFState(AudioMixerClientData::MixableStream& mixabl
     ++stats.hrtfResets;
 }
 
+bool AudioMixerSlave::shouldBeCulled(AudioMixerClientData::MixableStream& mixableStream,
+                                     const AvatarAudioStream* listeningNodeStream) {
+    bool isCulled = false;
+    if (_isCulling && mixableStream.positionalStream != listeningNodeStream) {
+        int index = _sharedData.audibility.findSource(mixableStream.positionalStream);
+        // a per-avatar gain set by the listener can make a source louder than its cull distance allows for
+        isCulled = index >= 0 && _culledSources[index] && mixableStream.hrtf->getGainAdjustment() <= 1.0f;
+    }
+
+    if (isCulled) {
+        if (!mixableStream.isCulled) {
+            // drop the tail of the last mixed block, so it isn't heard when the source comes back
+            resetHRTFState(mixableStream);
+        }
+        ++stats.audibilityCulls;
+    }
+    mixableStream.isCulled = isCulled;
+    return isCulled;
+}
+
+void AudioMixerSlave::encodeMix(AudioMixerClientData& listenerData, const QByteArray& decodedBuffer,
+                                QByteArray& encodedBuffer) {
+    // a stateful encoder's output depends on every frame it encoded before, so only stateless ones share frames
+    const Encoder* encoder = listenerData.getEncoder();
+    if (!encoder || !encoder->isStateless()) {
+        listenerData.encode(decodedBuffer, encodedBuffer);
+        ++stats.encodes;
+        return;
+    }
+
+    bool shouldEncode;
+    auto& frame = _sharedData.encodeCache.findOrInsert(encoder, decodedBuffer, shouldEncode);
+    if (shouldEncode) {
+        listenerData.encode(decodedBuffer, frame.encodedBuffer);
+        // an encoder may hand back the mix itself, which won't stay in the mixing buffer for the other listeners
+        frame.encodedBuffer.detach();
+        frame.isReady.store(true, std::memory_order_release);
+        encodedBuffer = frame.encodedBuffer;
+        ++stats.encodes;
+    } else if (frame.isReady.load(std::memory_order_acquire)) {
+        encodedBuffer = frame.encodedBuffer;
+        ++stats.encodeCacheHits;
+    } else {
+        // the listener that owns this frame is still encoding it, so don't wait on them
+        listenerData.encode(decodedBuffer, encodedBuffer);
+        ++stats.encodes;
+    }
+}
+
 std::unique_ptr<NLPacket> createAudioPacket(PacketType type, int size, quint16 sequence, QString codec) {
     auto audioPacket = NLPacket::create(type, size);
     audioPacket->writePrimitive(sequence);
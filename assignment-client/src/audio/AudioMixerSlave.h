@@ -25,7 +25,10 @@
 #include <NodeList.h>
 #include <PositionalAudioStream.h>
 
+#include "AudioMixerAudibility.h"
 #include "AudioMixerClientData.h"
+#include "AudioMixerClusterCache.h"
+#include "AudioMixerEncodeCache.h"
 #include "AudioMixerStats.h"
 
 class AvatarAudioStream;
@@ -39,6 +42,10 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioMixerClusterCache mixClusterCache;
+        AudioMixerEncodeCache encodeCache;
+        AudioMixerAudibility audibility;
+        std::vector<SharedNodePointer> downstreamMixers;
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -53,6 +60,9 @@ public:
     // returns true if a mixed packet was sent to the node
     void mix(const SharedNodePointer& node);
 
+    // frees what the last frame allocated, once nothing shared between the slaves points to it
+    void resetFrameArena();
+
     AudioMixerStats stats;
 
 private:
@@ -68,6 +78,11 @@ private:
                               float masterAvatarGain,
                               float masterInjectorGain);
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
+    bool shouldBeCulled(AudioMixerClientData::MixableStream& mixableStream, const AvatarAudioStream* listeningNodeStream);
+    void mixClusterRender(const AudioMixerClusterCache::Render& render);
+    void addFarFieldSource(const int16_t* samples, float azimuth, float gain);
+    void renderFarField(AudioMixerClientData& listenerData);
+    void encodeMix(AudioMixerClientData& listenerData, const QByteArray& decodedBuffer, QByteArray& encodedBuffer);
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
 
@@ -75,12 +90,28 @@ private:
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
 
+    // first-order ambisonic (W, X, Y, Z) pre-mix of the sources beyond the far field radius of the current listener
+    float _farFieldSamples[4][AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+    bool _isFarFieldMixing { false };
+    int _numFarFieldSources { 0 };
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
     unsigned int _frame { 0 };
     int _numToRetain { -1 };
 
+    // mix cluster of the current listener, distant sources are rendered once per cluster
+    bool _isClustering { false };
+    AudioMixerClusterCache::ClusterKey _listenerClusterKey;
+
+    // sources of the frame the current listener can't hear, by their index in the shared audibility table
+    bool _isCulling { false };
+    std::vector<uint8_t> _culledSources;
+
+    // the memory of what this slave renders for the frame's mix clusters
+    FrameArena _frameArena { FrameArena::DEFAULT_BLOCK_SIZE, MemoryTag::Audio };
+
     SharedData& _sharedData;
 };
 
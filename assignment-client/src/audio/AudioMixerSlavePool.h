@@ -12,14 +12,19 @@
 #ifndef hifi_AudioMixerSlavePool_h
 #define hifi_AudioMixerSlavePool_h
 
+#include <array>
 #include <condition_variable>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
+#include <QJsonObject>
 #include <QThread>
 #include <shared/QtHelpers.h>
-#include <TBBHelpers.h>
+#include <ProcessPlacement.h>
+#include <WorkStealingScheduler.h>
 
+#include "../SlavePoolAutoscaler.h"
 #include "AudioMixerSlave.h"
 
 class AudioMixerSlavePool;
@@ -41,17 +46,16 @@ private:
 
     void wait();
     void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
 
     AudioMixerSlavePool& _pool;
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
+    int _workerIndex { 0 };
     bool _stop { false };
 };
 
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -59,7 +63,13 @@ class AudioMixerSlavePool {
 public:
     using ConstIter = NodeList::const_iterator;
 
-    AudioMixerSlavePool(AudioMixerSlave::SharedData& sharedData, int numThreads = QThread::idealThreadCount())
+    enum Phase {
+        PROCESS_PACKETS = 0,
+        MIX,
+        NUM_PHASES
+    };
+
+    AudioMixerSlavePool(AudioMixerSlave::SharedData& sharedData, int numThreads = ProcessPlacement::getNumUsableCpus())
         : _workerSharedData(sharedData) { setNumThreads(numThreads); }
     ~AudioMixerSlavePool() { resize(0); }
 
@@ -72,6 +82,9 @@ public:
     // iterate over all slaves
     void each(std::function<void(AudioMixerSlave& slave)> functor);
 
+    // per-phase thread imbalance (busiest thread time over mean thread time) and steals since the last call
+    void balanceStats(QJsonObject& stats);
+
 #ifdef DEBUG_EVENT_QUEUE
     void queueStats(QJsonObject& stats);
 #endif
@@ -79,15 +92,21 @@ public:
     void setNumThreads(int numThreads);
     int numThreads() { return _numThreads; }
 
+    // grow and shrink the pool with its load, between one thread and the CPUs we can run on
+    void setAutoscaling(bool enabled);
+    // once per frame, after the frame's phases have run
+    void autoscale(uint64_t frameBudgetUsecs);
+    void autoscalingStats(QJsonObject& stats) { _autoscaler.stats(stats); }
+
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(Phase phase, ConstIter begin, ConstIter end);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
 
     friend void AudioMixerSlaveThread::wait();
     friend void AudioMixerSlaveThread::notify(bool stopping);
-    friend bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend void AudioMixerSlaveThread::run();
 
     // synchronization state
     Mutex _mutex;
@@ -101,9 +120,25 @@ private:
     int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
     ConstIter _begin;
     ConstIter _end;
+    std::vector<SharedNodePointer> _nodes;
+    std::vector<float> _expectedCosts;
+    std::vector<float> _taskCosts; // usecs, written by the slave that ran each task
+    WorkStealingScheduler _scheduler;
+
+    // what each node cost in each phase last frame, used to balance the next frame
+    std::array<std::unordered_map<Node::LocalID, float>, NUM_PHASES> _nodeCosts;
+
+    struct BalanceStats {
+        float imbalanceSum { 0.0f };
+        float worstImbalance { 1.0f };
+        int numSteals { 0 };
+        int numFrames { 0 };
+    };
+    std::array<BalanceStats, NUM_PHASES> _balanceStats;
+
+    SlavePoolAutoscaler _autoscaler;
 
     AudioMixerSlave::SharedData& _workerSharedData;
 };
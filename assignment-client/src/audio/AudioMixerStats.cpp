@@ -36,6 +36,20 @@ void AudioMixerStats::reset() {
     inactive = 0;
     active = 0;
 
+    clusterHits = 0;
+    clusterMisses = 0;
+
+    farFieldMixes = 0;
+    farFieldRenders = 0;
+
+    audibilityCulls = 0;
+
+    encodes = 0;
+    encodeCacheHits = 0;
+
+    arenaAllocations = 0;
+    arenaBlockAllocations = 0;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
 #endif
@@ -66,6 +80,20 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     inactive += otherStats.inactive;
     active += otherStats.active;
 
+    clusterHits += otherStats.clusterHits;
+    clusterMisses += otherStats.clusterMisses;
+
+    farFieldMixes += otherStats.farFieldMixes;
+    farFieldRenders += otherStats.farFieldRenders;
+
+    audibilityCulls += otherStats.audibilityCulls;
+
+    encodes += otherStats.encodes;
+    encodeCacheHits += otherStats.encodeCacheHits;
+
+    arenaAllocations += otherStats.arenaAllocations;
+    arenaBlockAllocations += otherStats.arenaBlockAllocations;
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
 #endif
@@ -41,6 +41,20 @@ struct AudioMixerStats {
     int inactive { 0 };
     int active { 0 };
 
+    int clusterHits { 0 };
+    int clusterMisses { 0 };
+
+    int farFieldMixes { 0 };
+    int farFieldRenders { 0 };
+
+    int audibilityCulls { 0 };
+
+    int encodes { 0 };
+    int encodeCacheHits { 0 };
+
+    int arenaAllocations { 0 };
+    int arenaBlockAllocations { 0 };
+
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
 #endif
@@ -0,0 +1,92 @@
+//
+//  AvatarBandwidthBudget.cpp
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarBandwidthBudget.h"
+
+#include <algorithm>
+
+namespace {
+    // a connection is congested once this share of its packets has to be sent again
+    const float LOSS_THRESHOLD = 0.02f;
+    // or once its round trip is this much longer than the shortest one it has had lately
+    const float RTT_GROWTH_THRESHOLD = 1.5f;
+    const int RTT_GROWTH_MARGIN = 10000; // microseconds, so the jitter of very short round trips doesn't count
+    // the shortest round trip creeps up by this much a sample, so the budget follows a route that got longer
+    const float MIN_RTT_DECAY = 1.01f;
+
+    const float DECREASE_FACTOR = 0.8f;
+    const float INCREASE_STEP = 0.05f; // of the mixer's max_node_send_bandwidth, per clean sample
+
+    // how much of the way to the target the budget moves each frame, a decrease is followed quicker
+    const float INCREASE_SMOOTHING = 0.05f;
+    const float DECREASE_SMOOTHING = 0.2f;
+}
+
+float AvatarBandwidthBudget::update(const udt::ConnectionStatsHistory& statsHistory, float baseKbps,
+                                    const Settings& settings) {
+    if (!settings.isEnabled) {
+        _targetKbps = _kbps = baseKbps;
+        return _kbps;
+    }
+
+    float minKbps = baseKbps * settings.minRatio;
+    float maxKbps = baseKbps * std::max(settings.maxRatio, settings.minRatio);
+    if (_targetKbps == 0.0f) {
+        _targetKbps = _kbps = std::min(std::max(baseKbps, minKbps), maxKbps);
+    }
+
+    uint32_t numPushed = statsHistory.getNumPushed();
+    if (numPushed != _numSamplesSeen) {
+        // a sample a second, only the newest one is looked at
+        auto samples = statsHistory.getSamples();
+        _numSamplesSeen = numPushed;
+        if (!samples.empty()) {
+            sampleReceived(samples.back(), baseKbps, minKbps, maxKbps);
+        }
+    }
+
+    _targetKbps = std::min(std::max(_targetKbps, minKbps), maxKbps);
+    float smoothing = _targetKbps < _kbps ? DECREASE_SMOOTHING : INCREASE_SMOOTHING;
+    _kbps += (_targetKbps - _kbps) * smoothing;
+    return _kbps;
+}
+
+void AvatarBandwidthBudget::sampleReceived(const udt::ConnectionStatsHistory::Sample& sample, float baseKbps,
+                                           float minKbps, float maxKbps) {
+    bool isCongested = false;
+
+    // only reliable packets are retransmitted, so this counts the loss the connection noticed
+    if (sample.sentPackets > 0) {
+        float lossRatio = (float)sample.retransmittedPackets / (float)sample.sentPackets;
+        isCongested = lossRatio > LOSS_THRESHOLD;
+    }
+
+    // a round trip is only measured while there's reliable traffic
+    int rtt = sample.rtt.p50;
+    if (rtt > 0) {
+        if (_minRTT == 0 || rtt < _minRTT) {
+            _minRTT = rtt;
+        } else {
+            int grownRTT = (int)(_minRTT * RTT_GROWTH_THRESHOLD) + RTT_GROWTH_MARGIN;
+            isCongested = isCongested || rtt > grownRTT;
+            _minRTT = std::min((int)(_minRTT * MIN_RTT_DECAY) + 1, rtt);
+        }
+    }
+
+    if (isCongested) {
+        _targetKbps = std::max(_targetKbps * DECREASE_FACTOR, minKbps);
+        ++_numDecreases;
+    } else if (_wasLimited) {
+        // a budget the listener doesn't use up isn't raised, it would only let a burst through later
+        _targetKbps = std::min(_targetKbps + baseKbps * INCREASE_STEP, maxKbps);
+    }
+    _wasLimited = false;
+}
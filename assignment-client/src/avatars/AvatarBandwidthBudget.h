@@ -0,0 +1,55 @@
+//
+//  AvatarBandwidthBudget.h
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarBandwidthBudget_h
+#define hifi_AvatarBandwidthBudget_h
+
+#include <cstdint>
+
+#include <udt/ConnectionStatsHistory.h>
+
+// How many kbps of avatar data one listener is sent, adapted to how its connection copes: the budget backs off
+// multiplicatively when the connection's stats show loss or a round trip growing over its usual one, and grows back a
+// step at a time while they are clean and the listener actually used what it was given. The budget a frame is sent
+// with follows that target smoothly, so a listener doesn't see the number of avatars it gets jump from one second to
+// the next.
+class AvatarBandwidthBudget {
+public:
+    struct Settings {
+        bool isEnabled { true };
+        // the bounds of the budget, as ratios of the mixer's max_node_send_bandwidth
+        float minRatio { 0.2f };
+        float maxRatio { 2.0f };
+    };
+
+    // checks for a new sample of the connection's stats, and returns the budget for this frame
+    float update(const udt::ConnectionStatsHistory& statsHistory, float baseKbps, const Settings& settings);
+
+    // after a frame was sent, whether it had to leave avatars out to keep to the budget
+    void frameSent(bool wasOverBudget) { _wasLimited = _wasLimited || wasOverBudget; }
+
+    float getKbps() const { return _kbps; }
+    float getTargetKbps() const { return _targetKbps; }
+    int getMinRTT() const { return _minRTT; }
+    uint32_t getNumDecreases() const { return _numDecreases; }
+
+private:
+    void sampleReceived(const udt::ConnectionStatsHistory::Sample& sample, float baseKbps, float minKbps, float maxKbps);
+
+    uint32_t _numSamplesSeen { 0 };
+    float _targetKbps { 0.0f };    // 0 until the first update
+    float _kbps { 0.0f };
+    int _minRTT { 0 };             // microseconds, 0 until a sample had a round trip
+    bool _wasLimited { false };
+    uint32_t _numDecreases { 0 };
+};
+
+#endif // hifi_AvatarBandwidthBudget_h
@@ -13,6 +13,7 @@
 
 #include "AvatarMixer.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <chrono>
 #include <memory>
@@ -32,6 +33,7 @@
 #include <AvatarLogging.h>
 #include <LogHandler.h>
 #include <NodeList.h>
+#include <PerformanceCounters.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
 #include <UUID.h>
@@ -48,6 +50,8 @@ const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
 
 const QRegularExpression AvatarMixer::suffixedNamePattern { R"(^\s*(.+)\s*_(\d)+\s*$)" };
 
+bool AvatarMixer::_isShard { false };
+
 // Lexicographic comparison:
 bool AvatarMixer::SessionDisplayName::operator<(const SessionDisplayName& rhs) const {
     if (_baseName < rhs._baseName) {
@@ -69,12 +73,18 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
     DependencyManager::set<ModelCache>();
     DependencyManager::set<ResourceCacheSharedItems>();
     DependencyManager::set<ResourceManager>();
+
+    _isShard = getPayload() == SHARD_ASSIGNMENT_PAYLOAD;
+    if (_isShard) {
+        qCDebug(avatars) << "Avatar mixer is a shard, serving a part of the domain's clients";
+    }
+
     // make sure we hear about node kills so we can tell the other nodes
     connect(DependencyManager::get<NodeList>().data(), &NodeList::nodeKilled, this, &AvatarMixer::handleAvatarKilled);
 
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListener(PacketType::AvatarData,
-        PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::queueIncomingPacket));
+    // avatar data goes straight from the receiving thread to the node queues drained by the slave pool
+    packetReceiver.registerTypedHandler<AvatarMixer, &AvatarMixer::queueAvatarData>(PacketType::AvatarData, this);
     packetReceiver.registerListener(PacketType::AdjustAvatarSorting,
         PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleAdjustAvatarSorting));
     packetReceiver.registerListener(PacketType::AvatarQuery,
@@ -105,21 +115,49 @@ AvatarMixer::AvatarMixer(ReceivedMessage& message) :
 
     packetReceiver.registerListener(PacketType::ReplicatedBulkAvatarData,
         PacketReceiver::makeUnsourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleReplicatedBulkAvatarPacket));
+    packetReceiver.registerListener(PacketType::AvatarShardSummaries,
+        PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleAvatarShardSummariesPacket));
+    packetReceiver.registerListener(PacketType::AvatarShardRequests,
+        PacketReceiver::makeSourcedListenerReference<AvatarMixer>(this, &AvatarMixer::handleAvatarShardRequestsPacket));
 
     auto nodeList = DependencyManager::get<NodeList>();
     connect(nodeList.data(), &NodeList::packetVersionMismatch, this, &AvatarMixer::handlePacketVersionMismatch);
+
+    // a hot standby mixer is kept with the ignores and settings of our nodes, as they would have set them up there,
+    // and the other shards with their ignores
+    _standbyReplicator = new MixerStandbyReplicator(NodeType::AvatarMixer,
+        _isShard ? MixerStandbyReplicator::Mode::Peers : MixerStandbyReplicator::Mode::Standby,
+        [this](QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+            switch (message->getType()) {
+                case PacketType::NodeIgnoreRequest:
+                    handleNodeIgnoreRequestPacket(message, node);
+                    break;
+                case PacketType::RadiusIgnoreRequest:
+                    handleRadiusIgnoreRequestPacket(message, node);
+                    break;
+                case PacketType::RequestsDomainListData:
+                    handleRequestsDomainListDataPacket(message, node);
+                    break;
+                case PacketType::SetAvatarTraits:
+                    queueIncomingPacket(message, node);
+                    break;
+                default:
+                    break;
+            }
+        }, this);
     connect(nodeList.data(), &NodeList::nodeAdded, this, [this](const SharedNodePointer& node) {
-        if (node->getType() == NodeType::DownstreamAvatarMixer) {
+        if (node->getType() == NodeType::DownstreamAvatarMixer || (node->getType() == NodeType::AvatarMixer && _isShard)) {
             getOrCreateClientData(node);
         }
     });
 }
 
-SharedNodePointer addOrUpdateReplicatedNode(const QUuid& nodeID, const SockAddr& senderSockAddr) {
+SharedNodePointer addOrUpdateReplicatedNode(const QUuid& nodeID, const SockAddr& senderSockAddr,
+                                            Node::LocalID localID = Node::NULL_LOCAL_ID) {
     auto replicatedNode = DependencyManager::get<NodeList>()->addOrUpdateNode(nodeID, NodeType::Agent,
                                                                               senderSockAddr,
                                                                               senderSockAddr,
-                                                                              Node::NULL_LOCAL_ID, true, true);
+                                                                              localID, true, true);
 
     replicatedNode->setLastHeardMicrostamp(usecTimestampNow());
 
@@ -141,7 +179,10 @@ void AvatarMixer::handleReplicatedPacket(QSharedPointer<ReceivedMessage> message
             return;
         }
     } else {
-        replicatedNode = addOrUpdateReplicatedNode(nodeID, message->getSenderSockAddr());
+        // the node keeps the local ID its avatar data came with
+        auto existingNode = nodeList->nodeWithUUID(nodeID);
+        replicatedNode = addOrUpdateReplicatedNode(nodeID, message->getSenderSockAddr(),
+                                                   existingNode ? existingNode->getLocalID() : Node::NULL_LOCAL_ID);
     }
 
     // we better have a node to work with at this point
@@ -155,12 +196,22 @@ void AvatarMixer::handleReplicatedPacket(QSharedPointer<ReceivedMessage> message
 }
 
 void AvatarMixer::handleReplicatedBulkAvatarPacket(QSharedPointer<ReceivedMessage> message) {
+    // the shards of a domain share its local IDs, those of an upstream mixer are another domain's
+    const auto& senderSockAddr = message->getSenderSockAddr();
+    bool isFromShard = _isShard && !DependencyManager::get<NodeList>()->nodeMatchingPredicate([&](const SharedNodePointer& node) {
+        return node->getType() == NodeType::AvatarMixer
+            && (node->getPublicSocket() == senderSockAddr || node->getLocalSocket() == senderSockAddr);
+    }).isNull();
+
     while (message->getBytesLeftToRead()) {
         // first, grab the node ID for this replicated avatar
         // Node ID is now part of user data, since ReplicatedBulkAvatarPacket is non-sourced.
         auto nodeID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        Node::LocalID localID;
+        message->readPrimitive(&localID);
+
         // make sure we have an upstream replicated node that matches
-        auto replicatedNode = addOrUpdateReplicatedNode(nodeID, message->getSenderSockAddr());
+        auto replicatedNode = addOrUpdateReplicatedNode(nodeID, senderSockAddr, isFromShard ? localID : Node::NULL_LOCAL_ID);
 
         // grab the size of the avatar byte array so we know how much to read
         quint16 avatarByteArraySize;
@@ -182,9 +233,111 @@ void AvatarMixer::handleReplicatedBulkAvatarPacket(QSharedPointer<ReceivedMessag
     }
 }
 
+// other shards' avatars this close to one of our clients are wanted even when out of its view, as it may turn to them
+const float SHARD_NEARBY_AVATAR_DISTANCE = 10.0f;
+
+void AvatarMixer::handleAvatarShardSummariesPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    if (!_isShard || senderNode->getType() != NodeType::AvatarMixer) {
+        return;
+    }
+
+    // our clients want the other shard's avatars they can see, or all of them for the PAL or the entity scripts
+    auto nodeList = DependencyManager::get<NodeList>();
+    std::vector<AvatarMixerClientData*> listeners;
+    bool wantsAll = false;
+    nodeList->eachNode([&](const SharedNodePointer& node) {
+        auto nodeData = static_cast<AvatarMixerClientData*>(node->getLinkedData());
+        if (!nodeData || node->isUpstream()) {
+            return;
+        }
+        if (node->getType() == NodeType::Agent) {
+            listeners.push_back(nodeData);
+            wantsAll = wantsAll || nodeData->getRequestsDomainListData();
+        } else if (node->getType() == NodeType::EntityScriptServer) {
+            wantsAll = true;
+        }
+    });
+
+    std::vector<Node::LocalID> wantedIDs;
+    std::vector<QUuid> unwantedIDs;
+    const int SUMMARY_SIZE = NUM_BYTES_RFC4122_UUID + sizeof(Node::LocalID) + sizeof(glm::vec3) + sizeof(float);
+    while (message->getBytesLeftToRead() >= SUMMARY_SIZE) {
+        auto nodeID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        Node::LocalID localID;
+        message->readPrimitive(&localID);
+        glm::vec3 center;
+        message->readPrimitive(&center);
+        float radius;
+        message->readPrimitive(&radius);
+
+        AABox avatarBox(center - glm::vec3(radius), 2.0f * radius);
+        bool isWanted = wantsAll || std::any_of(listeners.begin(), listeners.end(), [&](AvatarMixerClientData* listener) {
+            return listener->otherAvatarInView(avatarBox)
+                || glm::distance(listener->getPosition(), center) < SHARD_NEARBY_AVATAR_DISTANCE + radius;
+        });
+        if (isWanted) {
+            wantedIDs.push_back(localID);
+        } else {
+            unwantedIDs.push_back(nodeID);
+        }
+    }
+
+    // the count goes first, so that asking for none stops the full data too
+    auto requestPacketList = NLPacketList::create(PacketType::AvatarShardRequests, QByteArray(), true, true);
+    requestPacketList->writePrimitive((quint32)wantedIDs.size());
+    for (auto localID : wantedIDs) {
+        requestPacketList->writePrimitive(localID);
+    }
+    nodeList->sendPacketList(std::move(requestPacketList), *senderNode);
+
+    // the avatars no longer wanted are killed for our clients now, rather than going stale until they time out
+    for (const auto& nodeID : unwantedIDs) {
+        auto replicatedNode = nodeList->nodeWithUUID(nodeID);
+        if (replicatedNode && replicatedNode->isReplicated() && replicatedNode->isUpstream()) {
+            nodeList->killNodeWithUUID(nodeID);
+        }
+    }
+}
+
+void AvatarMixer::handleAvatarShardRequestsPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    auto nodeData = static_cast<AvatarMixerClientData*>(senderNode->getLinkedData());
+    if (!_isShard || senderNode->getType() != NodeType::AvatarMixer || !nodeData) {
+        return;
+    }
+
+    quint32 numRequestedIDs;
+    message->readPrimitive(&numRequestedIDs);
+    std::unordered_set<Node::LocalID> requestedIDs;
+    for (quint32 i = 0; i < numRequestedIDs && message->getBytesLeftToRead() >= (qint64)sizeof(Node::LocalID); ++i) {
+        Node::LocalID localID;
+        message->readPrimitive(&localID);
+        if (!nodeData->isShardAvatarRequested(localID)) {
+            // an avatar the other shard didn't have is sent with its identity
+            nodeData->setLastBroadcastTime(localID, 0);
+        }
+        requestedIDs.insert(localID);
+    }
+    nodeData->setRequestedShardAvatars(std::move(requestedIDs));
+}
+
+void AvatarMixer::sendShardClientPositions() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto positionsPacketList = NLPacketList::create(PacketType::MixerShardClientPositions, QByteArray(), true, true);
+    nodeList->eachNode([&](const SharedNodePointer& node) {
+        auto nodeData = static_cast<AvatarMixerClientData*>(node->getLinkedData());
+        if (node->getType() == NodeType::Agent && !node->isUpstream() && nodeData) {
+            positionsPacketList->write(node->getUUID().toRfc4122());
+            positionsPacketList->writePrimitive(nodeData->getPosition());
+        }
+    });
+    if (positionsPacketList->getNumPackets() > 0) {
+        nodeList->sendPacketList(std::move(positionsPacketList), nodeList->getDomainHandler().getSockAddr());
+    }
+}
+
 void AvatarMixer::optionallyReplicatePacket(ReceivedMessage& message, const Node& node) {
     // first, make sure that this is a packet from a node we are supposed to replicate
-    if (node.isReplicated()) {
+    if (node.isReplicated() || (_isShard && !node.isUpstream())) {
 
         // check if this is a packet type we replicate
         // which means it must be a packet type present in REPLICATED_PACKET_MAPPING or must be the
@@ -202,9 +355,12 @@ void AvatarMixer::optionallyReplicatePacket(ReceivedMessage& message, const Node
 
         std::unique_ptr<NLPacket> packet;
 
+        // the other shards get an identity with the data of the avatars they ask for, see AvatarShardRequests
+        bool isIdentity = replicatedType == PacketType::ReplicatedAvatarIdentity;
+
         auto nodeList = DependencyManager::get<NodeList>();
         nodeList->eachMatchingNode([&](const SharedNodePointer& downstreamNode) {
-            return shouldReplicateTo(node, *downstreamNode);
+            return shouldReplicateTo(node, *downstreamNode) && !(isIdentity && downstreamNode->getType() == NodeType::AvatarMixer);
         }, [&](const SharedNodePointer& node) {
             if (!packet) {
                 // construct an NLPacket to send to the replicant that has the contents of the received packet
@@ -219,11 +375,39 @@ void AvatarMixer::optionallyReplicatePacket(ReceivedMessage& message, const Node
 
 void AvatarMixer::queueIncomingPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
     auto start = usecTimestampNow();
+    if (message->getType() == PacketType::SetAvatarTraits) {
+        _standbyReplicator->mirrorPacket(*message, *node);
+    }
     getOrCreateClientData(node)->queuePacket(message, node);
     auto end = usecTimestampNow();
     _queueIncomingPacketElapsedTime += (end - start);
 }
 
+void AvatarMixer::queueAvatarData(const QSharedPointer<ReceivedMessage>& message, const SharedNodePointer& node) {
+    if (!node) {
+        return;
+    }
+
+    AvatarMixerClientData* clientData;
+    {
+        // the mixer thread links the client data under the node's lock
+        QMutexLocker locker(&node->getMutex());
+        clientData = dynamic_cast<AvatarMixerClientData*>(node->getLinkedData());
+    }
+    if (!clientData) {
+        // the client data has not been linked yet, do it on the mixer thread
+        QMetaObject::invokeMethod(this, [this, message, node] {
+            queueIncomingPacket(message, node);
+        });
+        return;
+    }
+
+    auto start = usecTimestampNow();
+    clientData->queuePacket(message, node);
+    auto end = usecTimestampNow();
+    _queueIncomingPacketElapsedTime += (end - start);
+}
+
 void AvatarMixer::sendIdentityPacket(AvatarMixerClientData* nodeData, const SharedNodePointer& destinationNode) {
     if (destinationNode->getType() == NodeType::Agent && !destinationNode->isUpstream()) {
         QByteArray individualData = nodeData->getAvatar().identityByteArray();
@@ -237,12 +421,24 @@ void AvatarMixer::sendIdentityPacket(AvatarMixerClientData* nodeData, const Shar
 
 std::chrono::microseconds AvatarMixer::timeFrame(p_high_resolution_clock::time_point& timestamp) {
     // advance the next frame
-    auto nextTimestamp = timestamp + std::chrono::microseconds((int)((float)USECS_PER_SECOND / (float)AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND));
+    auto frameBudget = std::chrono::microseconds((int)((float)USECS_PER_SECOND / (float)AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND));
+    auto nextTimestamp = timestamp + frameBudget;
     auto now = p_high_resolution_clock::now();
 
     // compute how long the last frame took
     auto duration = std::chrono::duration_cast<std::chrono::microseconds>(now - timestamp);
 
+    static auto& frames = PerformanceCounters::getInstance().counter("frames", "Frames broadcast");
+    static auto& frameOverruns = PerformanceCounters::getInstance().counter("frame_overruns",
+        "Frames that took longer than the time between broadcasts");
+    static auto& frameTime = PerformanceCounters::getInstance().histogram("frame_time_usecs",
+        "Time spent processing and broadcasting each frame");
+    frames.increment();
+    frameTime.record((uint64_t)duration.count());
+    if (duration > frameBudget) {
+        frameOverruns.increment();
+    }
+
     // set the new frame timestamp
     timestamp = std::max(now, nextTimestamp);
 
@@ -274,6 +470,13 @@ void AvatarMixer::start() {
             _entityViewer.queryOctree();
         }
 
+        // the table is keyed by the domain, which we may only just have the ID of
+        if (_sharePoses && !_poseTable.isAttached()) {
+            if (!_poseTable.publish(nodeList->getDomainHandler().getUUID())) {
+                _sharePoses = false;
+            }
+        }
+
         // Dirty the hero status if there's been an entity change.
         {
             if (_dirtyHeroStatus) {
@@ -318,11 +521,31 @@ void AvatarMixer::start() {
                 std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
                     if (node->getType() == NodeType::Agent) {
                         manageIdentityData(node);
+
+                        // pack the identity once for the broadcast, after any changes made above
+                        auto nodeData = static_cast<AvatarMixerClientData*>(node->getLinkedData());
+                        if (nodeData && nodeData->getAvatar().hasProcessedFirstIdentity()) {
+                            nodeData->updatePackedIdentity();
+                        }
+
+                        if (nodeData && _poseTable.isAttached() && !node->isUpstream()) {
+                            const auto& avatar = nodeData->getAvatar();
+                            _poseTable.write(node->getLocalID(), node->getUUID(),
+                                             { avatar.getClientGlobalPosition(), avatar.getWorldOrientation() });
+                        }
                     }
 
                     ++_sumListeners;
                 });
             }, &lockWait, &nodeTransform, &functor);
+            _poseTable.heartbeat();
+
+            static const quint64 SHARD_CLIENT_POSITIONS_INTERVAL_USECS = 2 * USECS_PER_SECOND;
+            if (_isShard && start - _lastShardClientPositionsTime >= SHARD_CLIENT_POSITIONS_INTERVAL_USECS) {
+                sendShardClientPositions();
+                _lastShardClientPositionsTime = start;
+            }
+
             auto end = usecTimestampNow();
             _displayNameManagementElapsedTime += (end - start);
 
@@ -336,6 +559,9 @@ void AvatarMixer::start() {
             auto start = usecTimestampNow();
             nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
                 auto start = usecTimestampNow();
+                if (_slaveSharedData.spatialGridMinAvatars > 0) {
+                    _slaveSharedData.avatarGrid.rebuild(cbegin, cend, _slaveSharedData.spatialGridRadius);
+                }
                 _slavePool.broadcastAvatarData(cbegin, cend, _lastFrameTimestamp, _maxKbpsPerNode, _throttlingRatio);
                 auto end = usecTimestampNow();
                 _broadcastAvatarDataInner += (end - start);
@@ -348,6 +574,8 @@ void AvatarMixer::start() {
             _broadcastAvatarDataNodeFunctor += functor;
         }
 
+        _slavePool.autoscale(USECS_PER_SECOND / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+
         ++frame;
         ++_numTightLoopFrames;
         _loopRate.increment();
@@ -496,6 +724,8 @@ void AvatarMixer::handleAvatarKilled(SharedNodePointer avatarNode) {
         && avatarNode->getLinkedData()) {
         auto nodeList = DependencyManager::get<NodeList>();
 
+        _poseTable.clear(avatarNode->getLocalID());
+
         {  // decrement sessionDisplayNames table and possibly remove
            QMutexLocker nodeDataLocker(&avatarNode->getLinkedData()->getMutex());
            AvatarMixerClientData* nodeData = dynamic_cast<AvatarMixerClientData*>(avatarNode->getLinkedData());
@@ -527,7 +757,7 @@ void AvatarMixer::handleAvatarKilled(SharedNodePointer avatarNode) {
             // and downstream avatar mixers, if the node that was just killed was being replicatedConnectedAgent
             return node->getActiveSocket() &&
                 (((node->getType() == NodeType::Agent || node->getType() == NodeType::EntityScriptServer) && !node->isUpstream()) ||
-                 (avatarNode->isReplicated() && shouldReplicateTo(*avatarNode, *node)));
+                 shouldReplicateTo(*avatarNode, *node));
         }, [&](const SharedNodePointer& node) {
             if (node->getType() == NodeType::Agent || node->getType() == NodeType::EntityScriptServer) {
                 if (!killPacket) {
@@ -540,7 +770,7 @@ void AvatarMixer::handleAvatarKilled(SharedNodePointer avatarNode) {
 
                 nodeList->sendPacket(std::move(killPacketCopy), *node);
             } else {
-                // send a replicated kill packet to the downstream avatar mixer
+                // send a replicated kill packet to the downstream avatar mixer, or the other shard
                 if (!replicatedKillPacket) {
                     replicatedKillPacket = NLPacket::create(PacketType::ReplicatedKillAvatar,
                                                   NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason));
@@ -614,6 +844,7 @@ void AvatarMixer::handleAvatarQueryPacket(QSharedPointer<ReceivedMessage> messag
 
 void AvatarMixer::handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto start = usecTimestampNow();
+    _standbyReplicator->mirrorPacket(*message, *senderNode);
 
     getOrCreateClientData(senderNode);
 
@@ -633,7 +864,7 @@ void AvatarMixer::handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMess
                     // Discover the valid nodes we're ignoring...
                     [&](const SharedNodePointer& node)->bool {
                     if (node->getUUID() != senderNode->getUUID() &&
-                        (nodeData->isRadiusIgnoring(node->getUUID()) ||
+                        (nodeData->isRadiusIgnoring(node->getLocalID()) ||
                         senderNode->isIgnoringNodeWithID(node->getUUID()))) {
                         return true;
                     }
@@ -695,6 +926,7 @@ void AvatarMixer::handleKillAvatarPacket(QSharedPointer<ReceivedMessage> message
 
 void AvatarMixer::handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto start = usecTimestampNow();
+    _standbyReplicator->mirrorPacket(*message, *senderNode);
     auto nodeList = DependencyManager::get<NodeList>();
     AvatarMixerClientData* nodeData = reinterpret_cast<AvatarMixerClientData*>(senderNode->getLinkedData());
 
@@ -745,6 +977,7 @@ void AvatarMixer::handleNodeIgnoreRequestPacket(QSharedPointer<ReceivedMessage>
 
 void AvatarMixer::handleRadiusIgnoreRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode) {
     auto start = usecTimestampNow();
+    _standbyReplicator->mirrorPacket(*packet, *sendingNode);
 
     bool enabled;
     packet->readPrimitive(&enabled);
@@ -767,9 +1000,21 @@ void AvatarMixer::sendStatsPacket() {
 
     statsObject["broadcast_loop_rate"] = _loopRate.rate();
     statsObject["threads"] = _slavePool.numThreads();
+
+    QJsonObject threadBalanceStats;
+    _slavePool.balanceStats(threadBalanceStats);
+    statsObject["thread_balance"] = threadBalanceStats;
+
+    QJsonObject threadAutoscalingStats;
+    _slavePool.autoscalingStats(threadAutoscalingStats);
+    statsObject["thread_autoscaling"] = threadAutoscalingStats;
     statsObject["trailing_mix_ratio"] = _trailingMixRatio;
     statsObject["throttling_ratio"] = _throttlingRatio;
 
+    static auto& throttlingRatio = PerformanceCounters::getInstance().gauge("throttling_ratio",
+        "Share of the avatars left out of broadcasts to keep up");
+    throttlingRatio.set(_throttlingRatio);
+
 #ifdef DEBUG_EVENT_QUEUE
     QJsonObject qtStats;
 
@@ -853,6 +1098,24 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
 
+    float averageCandidates = averageNodes ? aggregateStats.numCandidatesConsidered / averageNodes : 0.0f;
+    slavesAggregatObject["sent_8_averageCandidates"] = TIGHT_LOOP_STAT(averageCandidates);
+    slavesAggregatObject["sent_9_spatialGridListeners"] = TIGHT_LOOP_STAT(aggregateStats.numSpatialGridListeners);
+
+    float averageBandwidthBudget = aggregateStats.nodesBroadcastedTo
+        ? aggregateStats.bandwidthBudgetKbps / aggregateStats.nodesBroadcastedTo : 0.0f;
+    slavesAggregatObject["sent_10_averageBandwidthBudgetKbps"] = averageBandwidthBudget;
+    slavesAggregatObject["sent_11_averageAvatarEntityReferences"] =
+        TIGHT_LOOP_STAT(aggregateStats.numAvatarEntityReferencesSent);
+    slavesAggregatObject["sent_12_averageAvatarEntitiesFromBase"] =
+        TIGHT_LOOP_STAT(aggregateStats.numAvatarEntitiesSentFromBase);
+    static auto& bandwidthBudgetGauge = PerformanceCounters::getInstance().gauge("avatar_bandwidth_budget_kbps",
+        "Average of the listeners' avatar bandwidth budgets, as adapted to their connections");
+    bandwidthBudgetGauge.set(averageBandwidthBudget);
+
+    slavesAggregatObject["memory_1_arenaAllocations"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.numArenaAllocations);
+    slavesAggregatObject["memory_2_arenaHeapAllocations"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.numArenaBlockAllocations);
+
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
     slavesAggregatObject["timing_3_toByteArray"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArrayElapsedTime);
@@ -949,6 +1212,8 @@ void AvatarMixer::run() {
 }
 
 AvatarMixerClientData* AvatarMixer::getOrCreateClientData(SharedNodePointer node) {
+    // the avatar data handler reads the linked data on the receiving thread, under the node's lock
+    QMutexLocker locker(&node->getMutex());
     auto clientData = dynamic_cast<AvatarMixerClientData*>(node->getLinkedData());
 
     if (!clientData) {
@@ -966,7 +1231,8 @@ void AvatarMixer::domainSettingsRequestComplete() {
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->addSetOfNodeTypesToNodeInterestSet({
         NodeType::Agent, NodeType::EntityScriptServer, NodeType::EntityServer,
-        NodeType::UpstreamAvatarMixer, NodeType::DownstreamAvatarMixer
+        NodeType::UpstreamAvatarMixer, NodeType::DownstreamAvatarMixer,
+        NodeType::AvatarMixer // a hot standby, or the active mixer if we are one
     });
 
     // parse the settings to pull out the values we need
@@ -1010,6 +1276,7 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
 
     const QString AUTO_THREADS = "auto_threads";
     bool autoThreads = avatarMixerGroupObject[AUTO_THREADS].toBool();
+    _slavePool.setAutoscaling(autoThreads);
     if (!autoThreads) {
         bool ok;
         const QString NUM_THREADS = "num_threads";
@@ -1021,7 +1288,20 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         qCDebug(avatars) << "Avatar mixer will use specified number of threads:" << numThreads;
         _slavePool.setNumThreads(numThreads);
     } else {
-        qCDebug(avatars) << "Avatar mixer will automatically determine number of threads to use. Using:" << _slavePool.numThreads() << "threads.";
+        qCDebug(avatars) << "Avatar mixer will scale its number of threads with its load, starting with:"
+            << _slavePool.numThreads() << "threads.";
+    }
+
+    {   // the sockets sharing the mixer's port, each read on a thread of its own
+        static const QString NUM_RECEIVE_THREADS = "num_receive_threads";
+        if (avatarMixerGroupObject.contains(NUM_RECEIVE_THREADS)) {
+            bool ok;
+            int numReceiveThreads = avatarMixerGroupObject[NUM_RECEIVE_THREADS].toVariant().toInt(&ok);
+            if (ok) {
+                DependencyManager::get<NodeList>()->setNumReceiveThreads(numReceiveThreads);
+                qCDebug(avatars) << "Avatar mixer will receive on" << numReceiveThreads << "threads";
+            }
+        }
     }
 
     {
@@ -1034,6 +1314,21 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         }
     }
 
+    {   // Publish the avatars' poses in shared memory for the audio mixer and others on this host:
+        static const QString SHARED_POSE_TABLE_KEY = "shared_pose_table";
+        _sharePoses = avatarMixerGroupObject[SHARED_POSE_TABLE_KEY].toBool();
+        if (_sharePoses && _isShard) {
+            // the table is the domain's, and a shard only has the poses of its own clients
+            qCWarning(avatars) << "Avatar mixer shards can't share avatar poses, the shared pose table is off";
+            _sharePoses = false;
+        }
+        if (_sharePoses) {
+            qCDebug(avatars) << "Avatar mixer will share avatar poses with assignments on this host";
+        } else {
+            _poseTable.detach();
+        }
+    }
+
     {   // Fraction of downstream bandwidth reserved for 'hero' avatars:
         static const QString PRIORITY_FRACTION_KEY = "priority_fraction";
         if (avatarMixerGroupObject.contains(PRIORITY_FRACTION_KEY)) {
@@ -1043,6 +1338,43 @@ void AvatarMixer::parseDomainServerSettings(const QJsonObject& domainSettings) {
         }
     }
 
+    {   // Adapt each listener's budget to its connection, between these ratios of max_node_send_bandwidth:
+        static const QString ADAPTIVE_BANDWIDTH_KEY = "adaptive_node_send_bandwidth";
+        static const QString ADAPTIVE_BANDWIDTH_MIN_RATIO_KEY = "adaptive_node_send_bandwidth_min_ratio";
+        static const QString ADAPTIVE_BANDWIDTH_MAX_RATIO_KEY = "adaptive_node_send_bandwidth_max_ratio";
+        const AvatarBandwidthBudget::Settings DEFAULT_SETTINGS;
+
+        auto& settings = _slaveSharedData.bandwidthBudget;
+        settings.isEnabled = avatarMixerGroupObject[ADAPTIVE_BANDWIDTH_KEY].toBool(DEFAULT_SETTINGS.isEnabled);
+        settings.minRatio = glm::clamp((float)avatarMixerGroupObject[ADAPTIVE_BANDWIDTH_MIN_RATIO_KEY]
+            .toDouble(DEFAULT_SETTINGS.minRatio), 0.05f, 1.0f);
+        settings.maxRatio = std::max(1.0f, (float)avatarMixerGroupObject[ADAPTIVE_BANDWIDTH_MAX_RATIO_KEY]
+            .toDouble(DEFAULT_SETTINGS.maxRatio));
+
+        if (settings.isEnabled) {
+            qCDebug(avatars) << "Avatar mixer will adapt each node's send bandwidth to its connection, between"
+                << settings.minRatio * _maxKbpsPerNode << "and" << settings.maxRatio * _maxKbpsPerNode << "kbps";
+        }
+    }
+
+    {   // Only consider nearby avatars, heroes and a sample of far avatars, once a domain has this many avatars:
+        static const QString SPATIAL_GRID_MIN_AVATARS_KEY = "spatial_grid_min_avatars";
+        static const QString SPATIAL_GRID_RADIUS_KEY = "spatial_grid_radius";
+        const int DEFAULT_SPATIAL_GRID_MIN_AVATARS = 0;    // disabled
+        const float DEFAULT_SPATIAL_GRID_RADIUS = 25.0f;    // meters
+        const float MIN_SPATIAL_GRID_RADIUS = 5.0f;         // well beyond the ignore bubble
+
+        _slaveSharedData.spatialGridMinAvatars =
+            std::max(avatarMixerGroupObject[SPATIAL_GRID_MIN_AVATARS_KEY].toInt(DEFAULT_SPATIAL_GRID_MIN_AVATARS), 0);
+        _slaveSharedData.spatialGridRadius = std::max(MIN_SPATIAL_GRID_RADIUS,
+            (float)avatarMixerGroupObject[SPATIAL_GRID_RADIUS_KEY].toDouble(DEFAULT_SPATIAL_GRID_RADIUS));
+
+        if (_slaveSharedData.spatialGridMinAvatars > 0) {
+            qCDebug(avatars) << "Avatar mixer will gather candidates within" << _slaveSharedData.spatialGridRadius
+                << "meters once there are" << _slaveSharedData.spatialGridMinAvatars << "avatars";
+        }
+    }
+
     const QString AVATARS_SETTINGS_KEY = "avatars";
 
     static const QString MIN_HEIGHT_OPTION = "min_avatar_height";
@@ -17,6 +17,8 @@
 #ifndef hifi_AvatarMixer_h
 #define hifi_AvatarMixer_h
 
+#include <atomic>
+
 #include <QtCore/QSharedPointer>
 
 #include <set>
@@ -25,6 +27,8 @@
 
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "../AvatarPoseTable.h"
+#include "../MixerStandbyReplicator.h"
 #include "AvatarMixerClientData.h"
 
 #include "AvatarMixerSlavePool.h"
@@ -36,8 +40,17 @@ public:
     AvatarMixer(ReceivedMessage& message);
     virtual void aboutToFinish() override;
 
+    // one of several mixers that each serve a part of the domain's clients, see shouldReplicateTo
+    static bool isShard() { return _isShard; }
+
     static bool shouldReplicateTo(const Node& from, const Node& to) {
-        return to.getType() == NodeType::DownstreamAvatarMixer &&
+        // a shard replicates the avatars of its own clients to the other shards, so that their clients see them too,
+        // a summary of each and the full data of those the other shard asks for
+        if (to.getType() == NodeType::AvatarMixer) {
+            return _isShard && from.getType() == NodeType::Agent && !from.isUpstream();
+        }
+        // each shard replicates its own clients downstream, not those it has from the others
+        return from.isReplicated() && !(_isShard && from.isUpstream()) && to.getType() == NodeType::DownstreamAvatarMixer &&
             to.getPublicSocket() != from.getPublicSocket() &&
             to.getLocalSocket() != from.getLocalSocket();
     }
@@ -57,6 +70,7 @@ public slots:
 
 private slots:
     void queueIncomingPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
+    void queueAvatarData(const QSharedPointer<ReceivedMessage>& message, const SharedNodePointer& node);
     void handleAdjustAvatarSorting(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAvatarQueryPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAvatarIdentityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
@@ -66,6 +80,8 @@ private slots:
     void handleRequestsDomainListDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleReplicatedPacket(QSharedPointer<ReceivedMessage> message);
     void handleReplicatedBulkAvatarPacket(QSharedPointer<ReceivedMessage> message);
+    void handleAvatarShardSummariesPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAvatarShardRequestsPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void domainSettingsRequestComplete();
     void handlePacketVersionMismatch(PacketType type, const SockAddr& senderSockAddr, const QUuid& senderUUID);
     void handleOctreePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
@@ -83,6 +99,10 @@ private:
 
     void optionallyReplicatePacket(ReceivedMessage& message, const Node& node);
 
+    // tells the domain-server where our clients are, for it to give each shard those of a region
+    void sendShardClientPositions();
+    quint64 _lastShardClientPositionsTime { 0 };
+
     void setupEntityQuery();
 
     p_high_resolution_clock::time_point _lastFrameTimestamp;
@@ -149,12 +169,20 @@ private:
 
     quint64 _processEventsElapsedTime { 0 };
     quint64 _sendStatsElapsedTime { 0 };
-    quint64 _queueIncomingPacketElapsedTime { 0 };
+    std::atomic<quint64> _queueIncomingPacketElapsedTime { 0 };  // also summed on the receiving thread
     quint64 _lastStatsTime { usecTimestampNow() };
 
     RateCounter<> _loopRate; // this is the rate that the main thread tight loop runs
 
     AvatarMixerSlavePool _slavePool;
+
+    MixerStandbyReplicator* _standbyReplicator { nullptr };
+
+    static bool _isShard;
+
+    // the avatars' poses for the assignments running on this host, when the domain shares them
+    bool _sharePoses { false };
+    AvatarPoseTable _poseTable;
     SlaveSharedData _slaveSharedData;
 };
 
@@ -16,6 +16,7 @@
 
 #include <DependencyManager.h>
 #include <NodeList.h>
+#include <PerformanceCounters.h>
 #include <EntityTree.h>
 #include <ZoneEntityItem.h>
 
@@ -23,11 +24,21 @@
 
 #include "AvatarMixerSlave.h"
 
+static PerformanceCounters::Gauge& inboundQueueDepth() {
+    static auto& gauge = PerformanceCounters::getInstance().gauge("inbound_queue_depth",
+        "Packets received and waiting for the mixer's next frame");
+    return gauge;
+}
+
 AvatarMixerClientData::AvatarMixerClientData(const QUuid& nodeID, Node::LocalID nodeLocalID) : NodeData(nodeID, nodeLocalID) {
     // in case somebody calls getSessionUUID on the AvatarData instance, make sure it has the right ID
     _avatar->setID(nodeID);
 }
 
+AvatarMixerClientData::~AvatarMixerClientData() {
+    inboundQueueDepth().add(-(double)_packetQueue.size());
+}
+
 uint64_t AvatarMixerClientData::getLastOtherAvatarEncodeTime(NLPacket::LocalID otherAvatar) const {
     const auto itr = _lastOtherAvatarEncodeTime.find(otherAvatar);
     if (itr != _lastOtherAvatarEncodeTime.end()) {
@@ -46,26 +57,38 @@ void AvatarMixerClientData::setLastOtherAvatarEncodeTime(NLPacket::LocalID other
 }
 
 void AvatarMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
+    std::lock_guard<std::mutex> lock(_packetQueueMutex);
     if (!_packetQueue.node) {
         _packetQueue.node = node;
     }
     _packetQueue.push(message);
+    inboundQueueDepth().add(1.0);
 }
 
 int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData) {
     int packetsProcessed = 0;
-    SharedNodePointer node = _packetQueue.node;
-    assert(_packetQueue.empty() || node);
-    _packetQueue.node.clear();
+    // take the queued packets, more may keep arriving on the receiving thread
+    {
+        std::lock_guard<std::mutex> lock(_packetQueueMutex);
+        _processingQueue.swap(_packetQueue);
+        _processingQueue.node.swap(_packetQueue.node);
+    }
+    inboundQueueDepth().add(-(double)_processingQueue.size());
 
-    while (!_packetQueue.empty()) {
-        auto& packet = _packetQueue.front();
+    SharedNodePointer node = _processingQueue.node;
+    assert(_processingQueue.empty() || node);
+    _processingQueue.node.clear();
+
+    bool parsedAvatarData = false;
+    while (!_processingQueue.empty()) {
+        auto& packet = _processingQueue.front();
 
         packetsProcessed++;
 
         switch (packet->getType()) {
             case PacketType::AvatarData:
                 parseData(*packet, slaveSharedData);
+                parsedAvatarData = true;
                 break;
             case PacketType::SetAvatarTraits:
                 processSetTraitsMessage(*packet, slaveSharedData, *node);
@@ -79,21 +102,25 @@ int AvatarMixerClientData::processPackets(const SlaveSharedData& slaveSharedData
             default:
                 Q_UNREACHABLE();
         }
-        _packetQueue.pop();
+        _processingQueue.pop();
     }
-    assert(_packetQueue.empty());
+    assert(_processingQueue.empty());
 
     if (_avatar) {
         _avatar->processCertifyEvents();
+
+        // pack the sections every listener receives once, before this frame's broadcast
+        if (parsedAvatarData) {
+            _avatar->updateEncodingCache();
+        }
     }
 
     return packetsProcessed;
 }
 
 namespace {
-using std::static_pointer_cast;
 
-// Operator to find if a point is within an avatar-priority (hero) Zone Entity.
+// Finds if a point is within an avatar-priority (hero) or screenshare Zone Entity.
 struct FindContainingZone {
     glm::vec3 position;
     bool isInPriorityZone { false };
@@ -102,32 +129,24 @@ struct FindContainingZone {
     float screenshareZoneVolume { priorityZoneVolume };
     EntityItemID screenshareZoneid{};
 
-    static bool operation(const OctreeElementPointer& element, void* extraData) {
-        auto findContainingZone = static_cast<FindContainingZone*>(extraData);
-        if (element->getAACube().contains(findContainingZone->position)) {
-            const EntityTreeElementPointer entityTreeElement = static_pointer_cast<EntityTreeElement>(element);
-            entityTreeElement->forEachEntity([&findContainingZone](EntityItemPointer item) {
-                if (item->getType() == EntityTypes::Zone && item->contains(findContainingZone->position)) {
-                    auto zoneItem = static_pointer_cast<ZoneEntityItem>(item);
-                    auto avatarPriorityProperty = zoneItem->getAvatarPriority();
-                    auto screenshareProperty = zoneItem->getScreenshare();
-                    float volume = zoneItem->getVolumeEstimate();
-                    if (avatarPriorityProperty != COMPONENT_MODE_INHERIT
-                        && volume < findContainingZone->priorityZoneVolume) {  // Smaller volume wins
-                        findContainingZone->isInPriorityZone = avatarPriorityProperty == COMPONENT_MODE_ENABLED;
-                        findContainingZone->priorityZoneVolume = volume;
-                    }
-                    if (screenshareProperty != COMPONENT_MODE_INHERIT
-                        && volume < findContainingZone->screenshareZoneVolume) {
-                            findContainingZone->isInScreenshareZone = screenshareProperty == COMPONENT_MODE_ENABLED;
-                            findContainingZone->screenshareZoneVolume = volume;
-                            findContainingZone->screenshareZoneid = zoneItem->getEntityItemID();
-                    }
-                }
-            });
-            return true;  // Keep recursing
-        } else {          // Position isn't within this subspace, so end recursion.
-            return false;
+    void find(EntityTree& entityTree) {
+        std::vector<ZoneEntityItemPointer> zones;
+        entityTree.getZoneIndex().findContainingZones(position, zones);
+        for (const auto& zoneItem : zones) {
+            auto avatarPriorityProperty = zoneItem->getAvatarPriority();
+            auto screenshareProperty = zoneItem->getScreenshare();
+            float volume = zoneItem->getVolumeEstimate();
+            if (avatarPriorityProperty != COMPONENT_MODE_INHERIT
+                && volume < priorityZoneVolume) {  // Smaller volume wins
+                isInPriorityZone = avatarPriorityProperty == COMPONENT_MODE_ENABLED;
+                priorityZoneVolume = volume;
+            }
+            if (screenshareProperty != COMPONENT_MODE_INHERIT
+                && volume < screenshareZoneVolume) {
+                    isInScreenshareZone = screenshareProperty == COMPONENT_MODE_ENABLED;
+                    screenshareZoneVolume = volume;
+                    screenshareZoneid = zoneItem->getEntityItemID();
+            }
         }
     }
 };
@@ -159,7 +178,7 @@ int AvatarMixerClientData::parseData(ReceivedMessage& message, const SlaveShared
     if (newPosition != oldPosition || _avatar->getNeedsHeroCheck()) {
         EntityTree& entityTree = *slaveSharedData.entityTree;
         FindContainingZone findContainingZone{ newPosition };
-        entityTree.recurseTreeWithOperation(&FindContainingZone::operation, &findContainingZone);
+        findContainingZone.find(entityTree);
         bool currentlyHasPriority = findContainingZone.isInPriorityZone;
         if (currentlyHasPriority != _avatar->getHasPriority()) {
             _avatar->setHasPriority(currentlyHasPriority);
@@ -233,6 +252,7 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                     // Deferred for UX work. With no PoP check, no need to get the .fst.
                     _avatar->fetchAvatarFST();
                 }
+                _packedTraits[traitType] = _avatar->packTrait(traitType);
 
                 anyTraitsChanged = true;
             } else {
@@ -264,6 +284,9 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                         _avatar->processDeletedTraitInstance(traitType, instanceID);
                         // Mixer doesn't need deleted IDs.
                         _avatar->getAndClearRecentlyRemovedIDs();
+                        if (traitType == AvatarTraits::AvatarEntity) {
+                            _packedAvatarEntities.remove(instanceID);
+                        }
 
                         // to track a deleted instance but keep version information
                         // the avatar mixer uses the negative value of the sent version
@@ -272,11 +295,21 @@ void AvatarMixerClientData::processSetTraitsMessage(ReceivedMessage& message,
                         // Don't accept avatar entity data for distribution unless sender has rez permissions on the domain.
                         // The sender shouldn't be sending avatar entity data, however this provides a back-up.
                         auto trait = message.read(traitSize);
+                        bool isAccepted = true;
                         if (sendingNode.getCanRezAvatarEntities()) {
-                            _avatar->processTraitInstance(traitType, instanceID, trait);
+                            if (traitType == AvatarTraits::AvatarEntity) {
+                                isAccepted = processAvatarEntityTrait(instanceID, trait);
+                            } else {
+                                _avatar->processTraitInstance(traitType, instanceID, trait);
+                            }
+                        }
+
+                        if (isAccepted) {
+                            instanceVersionRef = packetTraitVersion;
+                        } else {
+                            qWarning() << "Refusing to process avatar entity trait that can't be decoded from"
+                                       << message.getSenderSockAddr();
                         }
-                        
-                        instanceVersionRef = packetTraitVersion;
                     }
 
                     anyTraitsChanged = true;
@@ -307,6 +340,7 @@ void AvatarMixerClientData::emulateDeleteEntitiesTraitsMessage(const QList<QUuid
         _avatar->processDeletedTraitInstance(traitType, entityID);
         // Mixer doesn't need deleted IDs.
         _avatar->getAndClearRecentlyRemovedIDs();
+        _packedAvatarEntities.remove(entityID);
 
         // to track a deleted instance but keep version information
         // the avatar mixer uses the negative value of the sent version
@@ -319,6 +353,77 @@ void AvatarMixerClientData::emulateDeleteEntitiesTraitsMessage(const QList<QUuid
     _lastReceivedTraitsChange = std::chrono::steady_clock::now();
 }
 
+bool AvatarMixerClientData::processAvatarEntityTrait(AvatarTraits::TraitInstanceID instanceID, const QByteArray& encoded) {
+    AvatarTraits::EntityEncoding encoding;
+    AvatarTraits::EntityBlobHash neededHash;
+    if (!AvatarTraits::readEntityEncoding(encoded, encoding, neededHash)) {
+        return false;
+    }
+
+    // the avatar encodes from the blobs it sent us before, which we hold as its current entities
+    QByteArray neededBlob;
+    if (encoding == AvatarTraits::DeflatedFromBaseEntity || encoding == AvatarTraits::ReferencedEntity) {
+        for (auto it = _packedAvatarEntities.constBegin(); it != _packedAvatarEntities.constEnd(); ++it) {
+            if (it.value().hash == neededHash) {
+                neededBlob = _avatar->packTraitInstance(AvatarTraits::AvatarEntity, it.key());
+                break;
+            }
+        }
+        if (neededBlob.isNull()) {
+            return false;
+        }
+    }
+
+    QByteArray blob;
+    if (!AvatarTraits::decodeEntityBlob(encoded, neededBlob, blob)) {
+        return false;
+    }
+
+    _avatar->processTraitInstance(AvatarTraits::AvatarEntity, instanceID, blob);
+    if (_avatar->packTraitInstance(AvatarTraits::AvatarEntity, instanceID).isNull()) {
+        // the avatar has as many entities as it can have, it goes out as a delete
+        _packedAvatarEntities.remove(instanceID);
+        return true;
+    }
+
+    PackedAvatarEntity packed;
+    packed.hash = AvatarTraits::hashEntityBlob(blob);
+    if (encoding == AvatarTraits::RawEntity || encoding == AvatarTraits::DeflatedEntity) {
+        packed.encoded = encoded;
+    } else {
+        packed.encoded = AvatarTraits::encodeEntityBlob(blob);
+        if (encoding == AvatarTraits::DeflatedFromBaseEntity) {
+            packed.encodedFromBase = encoded;
+            packed.baseHash = neededHash;
+        }
+    }
+    _packedAvatarEntities[instanceID] = packed;
+    return true;
+}
+
+const AvatarMixerClientData::PackedAvatarEntity* AvatarMixerClientData::getPackedAvatarEntity(
+        AvatarTraits::TraitInstanceID instanceID) const {
+    auto it = _packedAvatarEntities.constFind(instanceID);
+    return it != _packedAvatarEntities.constEnd() ? &it.value() : nullptr;
+}
+
+bool AvatarMixerClientData::isHoldingAvatarEntityBlob(const QUuid& otherAvatar, AvatarTraits::EntityBlobHash hash) const {
+    auto it = _heldAvatarEntityBlobs.find(otherAvatar);
+    return it != _heldAvatarEntityBlobs.end() && it->second.count(hash) > 0;
+}
+
+void AvatarMixerClientData::setHoldingAvatarEntityBlob(const QUuid& otherAvatar, AvatarTraits::EntityBlobHash hash) {
+    // a few times what a listener's cache holds of a full domain's entities; forgetting only makes us send more
+    const size_t MAX_NUM_HELD_AVATAR_ENTITY_BLOBS = 16384;
+    if (_numHeldAvatarEntityBlobs >= MAX_NUM_HELD_AVATAR_ENTITY_BLOBS) {
+        _heldAvatarEntityBlobs.clear();
+        _numHeldAvatarEntityBlobs = 0;
+    }
+    if (_heldAvatarEntityBlobs[otherAvatar].insert(hash).second) {
+        ++_numHeldAvatarEntityBlobs;
+    }
+}
+
 void AvatarMixerClientData::processBulkAvatarTraitsAckMessage(ReceivedMessage& message) {
     // Avatar Traits flow control marks each outgoing avatar traits packet with a
     // sequence number. The mixer caches the traits sent in the traits packet.
@@ -373,6 +478,51 @@ void AvatarMixerClientData::processBulkAvatarTraitsAckMessage(ReceivedMessage& m
                        << message.getSenderSockAddr();
         }
     }
+
+    // the avatar entities the listener couldn't decode for want of the blob they were sent from or referred to
+    if (message.getBytesLeftToRead() < (qint64)sizeof(uint16_t)) {
+        return;
+    }
+    uint16_t numMissing;
+    message.readPrimitive(&numMissing);
+
+    const qint64 MISSING_AVATAR_ENTITY_BYTES = 2 * NUM_BYTES_RFC4122_UUID + sizeof(AvatarTraits::EntityBlobHash);
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (uint16_t i = 0; i < numMissing && message.getBytesLeftToRead() >= MISSING_AVATAR_ENTITY_BYTES; ++i) {
+        auto avatarID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        auto instanceID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        AvatarTraits::EntityBlobHash neededHash;
+        message.readPrimitive(&neededHash);
+
+        // what it holds of that avatar isn't what we thought, so we go back to sending its entities on their own
+        auto held = _heldAvatarEntityBlobs.find(avatarID);
+        if (held != _heldAvatarEntityBlobs.end()) {
+            _numHeldAvatarEntityBlobs -= held->second.size();
+            _heldAvatarEntityBlobs.erase(held);
+        }
+
+        // and forget that we sent the entity so that it goes again
+        auto otherNode = nodeList->nodeWithUUID(avatarID);
+        if (otherNode) {
+            auto otherLocalID = otherNode->getLocalID();
+            _perNodeSentTraitVersions[otherLocalID].instanceErase(AvatarTraits::AvatarEntity, instanceID);
+            _perNodeAckedTraitVersions[otherLocalID].instanceErase(AvatarTraits::AvatarEntity, instanceID);
+            _lastSentTraitsTimestamps[otherLocalID] = TraitsCheckTimestamp();
+        }
+    }
+}
+
+void AvatarMixerClientData::updatePackedIdentity() {
+    if (_packedIdentityTimestamp == _identityChangeTimestamp && !_packedIdentity.isNull()) {
+        return;
+    }
+
+    // the identity is sent with the node ID in place of the session UUID
+    _packedIdentity = _avatar->identityByteArray();
+    _packedIdentity.replace(0, NUM_BYTES_RFC4122_UUID, getNodeID().toRfc4122()); // FIXME, this looks suspicious
+    _packedReplicatedIdentity = _avatar->identityByteArray(true);
+    _packedReplicatedIdentity.replace(0, NUM_BYTES_RFC4122_UUID, getNodeID().toRfc4122());
+    _packedIdentityTimestamp = _identityChangeTimestamp;
 }
 
 void AvatarMixerClientData::checkSkeletonURLAgainstWhitelist(const SlaveSharedData& slaveSharedData,
@@ -442,8 +592,8 @@ void AvatarMixerClientData::ignoreOther(SharedNodePointer self, SharedNodePointe
 }
 
 void AvatarMixerClientData::ignoreOther(const Node* self, const Node* other) {
-    if (!isRadiusIgnoring(other->getUUID())) {
-        addToRadiusIgnoringSet(other->getUUID());
+    if (!isRadiusIgnoring(other->getLocalID())) {
+        addToRadiusIgnoringSet(other->getLocalID());
         auto killPacket = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason), true);
         killPacket->write(other->getUUID().toRfc4122());
         if (_isIgnoreRadiusEnabled) {
@@ -459,23 +609,6 @@ void AvatarMixerClientData::ignoreOther(const Node* self, const Node* other) {
     }
 }
 
-bool AvatarMixerClientData::isRadiusIgnoring(const QUuid& other) const {
-    return std::find(_radiusIgnoredOthers.cbegin(), _radiusIgnoredOthers.cend(), other) != _radiusIgnoredOthers.cend();
-}
-
-void AvatarMixerClientData::addToRadiusIgnoringSet(const QUuid& other) {
-    if (!isRadiusIgnoring(other)) {
-        _radiusIgnoredOthers.push_back(other);
-    }
-}
-
-void AvatarMixerClientData::removeFromRadiusIgnoringSet(const QUuid& other) {
-    auto ignoredOtherIter = std::find(_radiusIgnoredOthers.cbegin(), _radiusIgnoredOthers.cend(), other);
-    if (ignoredOtherIter != _radiusIgnoredOthers.cend()) {
-        _radiusIgnoredOthers.erase(ignoredOtherIter);
-    }
-}
-
 void AvatarMixerClientData::resetSentTraitData(Node::LocalID nodeLocalID) {
     _lastSentTraitsTimestamps[nodeLocalID] = TraitsCheckTimestamp();
     _perNodeSentTraitVersions[nodeLocalID].reset();
@@ -517,6 +650,10 @@ void AvatarMixerClientData::loadJSONStats(QJsonObject& jsonObject) const {
     jsonObject[OUTBOUND_AVATAR_DATA_STATS_KEY] = getOutboundAvatarDataKbps();
     jsonObject[OUTBOUND_AVATAR_TRAITS_STATS_KEY] = getOutboundAvatarTraitsKbps();
     jsonObject[INBOUND_AVATAR_DATA_STATS_KEY] = _avatar->getAverageBytesReceivedPerSecond() / (float)BYTES_PER_KILOBIT;
+    jsonObject["avatar_bandwidth_budget_kbps"] = _bandwidthBudget.getKbps();
+    jsonObject["avatar_bandwidth_target_kbps"] = _bandwidthBudget.getTargetKbps();
+    jsonObject["avatar_bandwidth_min_rtt_ms"] = _bandwidthBudget.getMinRTT() / (float)USECS_PER_MSEC;
+    jsonObject["avatar_bandwidth_decreases"] = (qint64)_bandwidthBudget.getNumDecreases();
 
     jsonObject["av_data_receive_rate"] = _avatar->getReceiveRate();
     jsonObject["recent_other_av_in_view"] = _recentOtherAvatarsInView;
@@ -535,6 +672,8 @@ AvatarMixerClientData::TraitsCheckTimestamp AvatarMixerClientData::getLastOtherA
 }
 
 void AvatarMixerClientData::cleanupKilledNode(const QUuid&, Node::LocalID nodeLocalID) {
+    // the local ID may go to another node
+    removeFromRadiusIgnoringSet(nodeLocalID);
     removeLastBroadcastSequenceNumber(nodeLocalID);
     removeLastBroadcastTime(nodeLocalID);
     _lastSentTraitsTimestamps.erase(nodeLocalID);
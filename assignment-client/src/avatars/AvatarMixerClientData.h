@@ -16,14 +16,21 @@
 #include <cfloat>
 #include <unordered_map>
 #include <vector>
+#include <array>
+#include <mutex>
 #include <queue>
+#include <unordered_set>
 
+#include <QtCore/QHash>
 #include <QtCore/QJsonObject>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QUrl>
 
+#include "AvatarBandwidthBudget.h"
 #include "MixerAvatar.h"
 #include <AssociatedTraitValues.h>
+#include <AvatarEntityTraitEncoding.h>
+#include <LocalIDSet.h>
 #include <NodeData.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
@@ -42,7 +49,7 @@ class AvatarMixerClientData : public NodeData {
     Q_OBJECT
 public:
     AvatarMixerClientData(const QUuid& nodeID, Node::LocalID nodeLocalID);
-    virtual ~AvatarMixerClientData() {}
+    virtual ~AvatarMixerClientData();
     using HRCTime = p_high_resolution_clock::time_point;
     using PerNodeTraitVersions = std::unordered_map<Node::LocalID, AvatarTraits::TraitVersions>;
 
@@ -66,6 +73,12 @@ public:
 
     Q_INVOKABLE void cleanupKilledNode(const QUuid& nodeUUID, Node::LocalID nodeLocalID);
 
+    // for another shard, the avatars of ours that its clients can see, the only ones it is sent the full data of
+    bool isShardAvatarRequested(NLPacket::LocalID avatarID) const { return _requestedShardAvatars.count(avatarID) > 0; }
+    void setRequestedShardAvatars(std::unordered_set<NLPacket::LocalID> avatarIDs) { _requestedShardAvatars = std::move(avatarIDs); }
+    uint64_t getLastShardSummaryTime() const { return _lastShardSummaryTime; }
+    void setLastShardSummaryTime(uint64_t summaryTime) { _lastShardSummaryTime = summaryTime; }
+
     uint16_t getLastReceivedSequenceNumber() const { return _lastReceivedSequenceNumber; }
 
     uint64_t getIdentityChangeTimestamp() const { return _identityChangeTimestamp; }
@@ -99,12 +112,16 @@ public:
     float getOutboundAvatarTraitsKbps() const
         { return _avgOtherAvatarTraitsRate.getAverageSampleValuePerSecond() / BYTES_PER_KILOBIT; }
 
+    // the listener's share of the mixer's bandwidth, adapted to its connection
+    AvatarBandwidthBudget& getBandwidthBudget() { return _bandwidthBudget; }
+
     void loadJSONStats(QJsonObject& jsonObject) const;
 
     glm::vec3 getPosition() const { return _avatar ? _avatar->getClientGlobalPosition() : glm::vec3(0); }
-    bool isRadiusIgnoring(const QUuid& other) const;
-    void addToRadiusIgnoringSet(const QUuid& other);
-    void removeFromRadiusIgnoringSet(const QUuid& other);
+    // by local ID, the broadcast checks every other avatar against it
+    bool isRadiusIgnoring(Node::LocalID other) const { return _radiusIgnoredOthers.contains(other); }
+    void addToRadiusIgnoringSet(Node::LocalID other) { _radiusIgnoredOthers.insert(other); }
+    void removeFromRadiusIgnoringSet(Node::LocalID other) { _radiusIgnoredOthers.erase(other); }
     void ignoreOther(SharedNodePointer self, SharedNodePointer other);
     void ignoreOther(const Node* self, const Node* other);
 
@@ -145,6 +162,30 @@ public:
     AvatarTraits::TraitVersions& getLastReceivedTraitVersions() { return _lastReceivedTraitVersions; }
     const AvatarTraits::TraitVersions& getLastReceivedTraitVersions() const { return _lastReceivedTraitVersions; }
 
+    // the last received simple traits, packed once for every listener and downstream mixer
+    const QByteArray& getPackedTrait(AvatarTraits::TraitType traitType) const { return _packedTraits[traitType]; }
+
+    // an avatar entity as it goes to listeners, encoded once on its own, and as the avatar sent it if it sent it from a
+    // base, for the listeners that hold the base
+    struct PackedAvatarEntity {
+        AvatarTraits::EntityBlobHash hash { 0 };
+        QByteArray encoded;
+        QByteArray encodedFromBase;
+        AvatarTraits::EntityBlobHash baseHash { 0 };
+    };
+    // nullptr if the avatar doesn't have the entity
+    const PackedAvatarEntity* getPackedAvatarEntity(AvatarTraits::TraitInstanceID instanceID) const;
+
+    // the other avatars' entity blobs this listener holds as far as we know, which are those we sent it since it last
+    // told us it was missing one of theirs
+    bool isHoldingAvatarEntityBlob(const QUuid& otherAvatar, AvatarTraits::EntityBlobHash hash) const;
+    void setHoldingAvatarEntityBlob(const QUuid& otherAvatar, AvatarTraits::EntityBlobHash hash);
+
+    // identity payloads sent to listeners and downstream mixers, packed once per identity change
+    void updatePackedIdentity();
+    const QByteArray& getPackedIdentity() const { return _packedIdentity; }
+    const QByteArray& getPackedReplicatedIdentity() const { return _packedReplicatedIdentity; }
+
     TraitsCheckTimestamp getLastOtherAvatarTraitsSendPoint(Node::LocalID otherAvatar) const;
     void setLastOtherAvatarTraitsSendPoint(Node::LocalID otherAvatar, TraitsCheckTimestamp sendPoint)
         { _lastSentTraitsTimestamps[otherAvatar] = sendPoint; }
@@ -161,23 +202,30 @@ public:
     void resetSentTraitData(Node::LocalID nodeID);
 
 private:
+    // decodes and applies an avatar entity trait, returns false if it can't be decoded
+    bool processAvatarEntityTrait(AvatarTraits::TraitInstanceID instanceID, const QByteArray& encoded);
+
     struct PacketQueue : public std::queue<QSharedPointer<ReceivedMessage>> {
         QWeakPointer<Node> node;
     };
-    PacketQueue _packetQueue;
+    PacketQueue _packetQueue;       // filled by the receiving thread
+    PacketQueue _processingQueue;   // drained by the slave pool
+    std::mutex _packetQueueMutex;
 
     MixerAvatarSharedPointer _avatar { new MixerAvatar() };
 
     uint16_t _lastReceivedSequenceNumber { 0 };
     std::unordered_map<NLPacket::LocalID, uint16_t> _lastBroadcastSequenceNumbers;
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastBroadcastTimes;
+    std::unordered_set<NLPacket::LocalID> _requestedShardAvatars;
+    uint64_t _lastShardSummaryTime { 0 };
 
     // this is a map of the last time we encoded an "other" avatar for
     // sending to "this" node
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastOtherAvatarEncodeTime;
     std::unordered_map<NLPacket::LocalID, QVector<JointData>> _lastOtherAvatarSentJoints;
 
-    uint64_t _identityChangeTimestamp;
+    uint64_t _identityChangeTimestamp { 0 };
     bool _avatarSessionDisplayNameMustChange{ true };
     bool _avatarSkeletonModelUrlMustChange{ false };
 
@@ -190,7 +238,8 @@ private:
 
     SimpleMovingAverage _avgOtherAvatarDataRate;
     SimpleMovingAverage _avgOtherAvatarTraitsRate;
-    std::vector<QUuid> _radiusIgnoredOthers;
+    AvatarBandwidthBudget _bandwidthBudget;
+    LocalIDSet _radiusIgnoredOthers;
     ConicalViewFrustums _currentViewFrustums;
 
     int _recentOtherAvatarsInView { 0 };
@@ -200,6 +249,16 @@ private:
     bool _prevRequestsDomainListData{ false };
 
     AvatarTraits::TraitVersions _lastReceivedTraitVersions;
+    std::array<QByteArray, AvatarTraits::NUM_SIMPLE_TRAITS> _packedTraits;
+    QHash<AvatarTraits::TraitInstanceID, PackedAvatarEntity> _packedAvatarEntities;
+
+    // by the other avatar's session ID, forgotten all at once past a bound so stale avatars don't pile up
+    std::unordered_map<QUuid, std::unordered_set<AvatarTraits::EntityBlobHash>> _heldAvatarEntityBlobs;
+    size_t _numHeldAvatarEntityBlobs { 0 };
+
+    uint64_t _packedIdentityTimestamp { 0 };
+    QByteArray _packedIdentity;
+    QByteArray _packedReplicatedIdentity;
     TraitsCheckTimestamp _lastReceivedTraitsChange;
 
     AvatarTraits::TraitMessageSequence _currentTraitsMessageSequence{ 0 };
@@ -21,6 +21,7 @@
 
 #include <AvatarLogging.h>
 #include <LogHandler.h>
+#include <MemoryAccounting.h>
 #include <NetworkAccessManager.h>
 #include <NodeList.h>
 #include <Node.h>
@@ -54,12 +55,17 @@ void AvatarMixerSlave::configureBroadcast(ConstIter begin, ConstIter end,
 }
 
 void AvatarMixerSlave::harvestStats(AvatarMixerSlaveStats& stats) {
+    auto arenaStats = _frameArena.takeStats();
+    _stats.numArenaAllocations += arenaStats.numAllocations;
+    _stats.numArenaBlockAllocations += arenaStats.numBlockAllocations;
+
     stats = _stats;
     _stats.reset();
 }
 
 
 void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
+    MemoryAccounting::Scope memoryScope(MemoryTag::Avatars);
     auto start = usecTimestampNow();
     auto nodeData = dynamic_cast<AvatarMixerClientData*>(node->getLinkedData());
     if (nodeData) {
@@ -72,8 +78,7 @@ void AvatarMixerSlave::processIncomingPackets(const SharedNodePointer& node) {
 
 int AvatarMixerSlave::sendIdentityPacket(NLPacketList& packetList, const AvatarMixerClientData* nodeData, const Node& destinationNode) {
     if (destinationNode.getType() == NodeType::Agent && !destinationNode.isUpstream()) {
-        QByteArray individualData = nodeData->getConstAvatarData()->identityByteArray();
-        individualData.replace(0, NUM_BYTES_RFC4122_UUID, nodeData->getNodeID().toRfc4122()); // FIXME, this looks suspicious
+        const QByteArray& individualData = nodeData->getPackedIdentity();
         packetList.write(individualData);
         _stats.numIdentityPacketsSent++;
         _stats.numIdentityBytesSent += individualData.size();
@@ -141,8 +146,8 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
                 if (lastReceivedVersion > lastSentVersionRef) {
                     bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
                     // there is an update to this trait, add it to the traits packet
-                    bytesWritten += AvatarTraits::packVersionedTrait(traitType, traitsPacketList,
-                                                                     lastReceivedVersion, *sendingAvatar);
+                    bytesWritten += AvatarTraits::packVersionedTrait(traitType, traitsPacketList, lastReceivedVersion,
+                                                                     sendingNodeData->getPackedTrait(traitType));
                     // update the last sent version
                     lastSentVersionRef = lastReceivedVersion;
                     // Remember which versions we sent in this particular packet
@@ -197,8 +202,13 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
                     bytesWritten += addTraitsNodeHeader(listeningNodeData, sendingNodeData, traitsPacketList, bytesWritten);
 
                     // this instance version exists and has never been sent or is newer so we need to send it
-                    bytesWritten += AvatarTraits::packVersionedTraitInstance(traitType, instanceID, traitsPacketList,
-                                                                             receivedVersion, *sendingAvatar);
+                    if (traitType == AvatarTraits::AvatarEntity) {
+                        bytesWritten += addAvatarEntityToBulkPacket(listeningNodeData, sendingNodeData, instanceID,
+                                                                    receivedVersion, traitsPacketList);
+                    } else {
+                        bytesWritten += AvatarTraits::packVersionedTraitInstance(traitType, instanceID, traitsPacketList,
+                                                                                 receivedVersion, *sendingAvatar);
+                    }
 
                     if (sentInstanceIt != sentIDValuePairs.end()) {
                         sentInstanceIt->value = receivedVersion;
@@ -245,10 +255,44 @@ qint64 AvatarMixerSlave::addChangedTraitsToBulkPacket(AvatarMixerClientData* lis
     return bytesWritten;
 }
 
+qint64 AvatarMixerSlave::addAvatarEntityToBulkPacket(AvatarMixerClientData* listeningNodeData,
+                                                     const AvatarMixerClientData* sendingNodeData,
+                                                     AvatarTraits::TraitInstanceID instanceID,
+                                                     AvatarTraits::TraitVersion traitVersion,
+                                                     NLPacketList& traitsPacketList) {
+    auto packedEntity = sendingNodeData->getPackedAvatarEntity(instanceID);
+    if (!packedEntity) {
+        // the avatar has no such entity, it was refused, which goes out as a delete
+        return AvatarTraits::packVersionedTraitInstance(AvatarTraits::AvatarEntity, instanceID, traitsPacketList,
+                                                        traitVersion, QByteArray());
+    }
+
+    // the listener keeps the blobs it receives, so an entity sent before only needs its hash, and one the avatar sent
+    // from a base the listener holds goes as it came
+    const auto& sendingID = sendingNodeData->getNodeID();
+    QByteArray encoded;
+    if (listeningNodeData->isHoldingAvatarEntityBlob(sendingID, packedEntity->hash)) {
+        encoded = AvatarTraits::encodeEntityReference(packedEntity->hash);
+        ++_stats.numAvatarEntityReferencesSent;
+    } else if (!packedEntity->encodedFromBase.isNull()
+               && listeningNodeData->isHoldingAvatarEntityBlob(sendingID, packedEntity->baseHash)) {
+        encoded = packedEntity->encodedFromBase;
+        ++_stats.numAvatarEntitiesSentFromBase;
+    } else {
+        encoded = packedEntity->encoded;
+    }
+
+    auto bytesWritten = AvatarTraits::packVersionedTraitInstance(AvatarTraits::AvatarEntity, instanceID, traitsPacketList,
+                                                                 traitVersion, encoded);
+    if (bytesWritten > 0) {
+        listeningNodeData->setHoldingAvatarEntityBlob(sendingID, packedEntity->hash);
+    }
+    return bytesWritten;
+}
+
 int AvatarMixerSlave::sendReplicatedIdentityPacket(const Node& agentNode, const AvatarMixerClientData* nodeData, const Node& destinationNode) {
     if (AvatarMixer::shouldReplicateTo(agentNode, destinationNode)) {
-        QByteArray individualData = nodeData->getConstAvatarData()->identityByteArray(true);
-        individualData.replace(0, NUM_BYTES_RFC4122_UUID, nodeData->getNodeID().toRfc4122()); // FIXME, this looks suspicious
+        const QByteArray& individualData = nodeData->getPackedReplicatedIdentity();
         auto identityPacket = NLPacketList::create(PacketType::ReplicatedAvatarIdentity, QByteArray(), true, true);
         identityPacket->write(individualData);
         DependencyManager::get<NodeList>()->sendPacketList(std::move(identityPacket), destinationNode);
@@ -263,11 +307,14 @@ int AvatarMixerSlave::sendReplicatedIdentityPacket(const Node& agentNode, const
 static const int AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 45;
 
 void AvatarMixerSlave::broadcastAvatarData(const SharedNodePointer& node) {
+    MemoryAccounting::Scope memoryScope(MemoryTag::Avatars);
     quint64 start = usecTimestampNow();
 
     if ((node->getType() == NodeType::Agent || node->getType() == NodeType::EntityScriptServer) && node->getLinkedData() && node->getActiveSocket() && !node->isUpstream()) {
         broadcastAvatarDataToAgent(node);
-    } else if (node->getType() == NodeType::DownstreamAvatarMixer) {
+    } else if (node->getType() == NodeType::DownstreamAvatarMixer
+               || (node->getType() == NodeType::AvatarMixer && AvatarMixer::isShard())) {
+        // the other shards are sent our clients' avatars the same way as downstream mixers are
         broadcastAvatarDataToDownstreamMixer(node);
     }
 
@@ -286,7 +333,7 @@ AABox computeBubbleBox(const AvatarData& avatar, float bubbleExpansionFactor) {
 }
 
 namespace {
-    class SortableAvatar : public PrioritySortUtil::Sortable {
+    class SortableAvatar final : public PrioritySortUtil::Sortable {
     public:
         SortableAvatar() = delete;
         SortableAvatar(const MixerAvatar* avatar, const Node* avatarNode, uint64_t lastEncodeTime)
@@ -311,6 +358,42 @@ namespace {
 
 }  // Close anonymous namespace.
 
+// when the spatial grid is used, each far avatar is considered once every this many frames
+static const uint32_t FAR_AVATAR_SAMPLE_PERIOD = 8;
+
+void AvatarMixerSlave::gatherCandidates(const glm::vec3& destinationPosition, bool useSpatialGrid) {
+    _candidates.clear();
+
+    if (!useSpatialGrid) {
+        std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
+            _candidates.push_back(node.data());
+        });
+        return;
+    }
+
+    // Avatars in the near cells...
+    const AvatarSpatialGrid& avatarGrid = _sharedData->avatarGrid;
+    auto nearCells = avatarGrid.cellsNear(destinationPosition, _sharedData->spatialGridRadius);
+    avatarGrid.eachEntryInCells(nearCells, [&](const AvatarSpatialGrid::Entry& entry) {
+        _candidates.push_back(entry.node);
+    });
+
+    // ...all the heroes...
+    for (const AvatarSpatialGrid::Entry* hero : avatarGrid.getHeroes()) {
+        if (!nearCells.contains(hero->cell)) {
+            _candidates.push_back(hero->node);
+        }
+    }
+
+    // ...and a share of the others, so far avatars still age in priority and get their turn.
+    // This is also when a far avatar leaves the radius ignoring set after a teleport.
+    avatarGrid.eachFarSampleEntry(FAR_AVATAR_SAMPLE_PERIOD, [&](const AvatarSpatialGrid::Entry& entry) {
+        if (!entry.isHero && !nearCells.contains(entry.cell)) {
+            _candidates.push_back(entry.node);
+        }
+    });
+}
+
 void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node) {
     const Node* destinationNode = node.data();
 
@@ -344,8 +427,13 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     int identityBytesSent = 0;
     int traitBytesSent = 0;
 
-    // max number of avatarBytes per frame (13 900, typical)
-    const int maxAvatarBytesPerFrame = int(_maxKbpsPerNode * BYTES_PER_KILOBIT / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+    // max number of avatarBytes per frame (13 900, typical), as far as the listener's connection keeps up with it
+    auto& bandwidthBudget = destinationNodeData->getBandwidthBudget();
+    float budgetKbps = bandwidthBudget.update(destinationNode->getConnectionStatsHistory(), _maxKbpsPerNode,
+                                              _sharedData->bandwidthBudget);
+    _stats.bandwidthBudgetKbps += budgetKbps;
+    const int maxAvatarBytesPerFrame = int(budgetKbps * BYTES_PER_KILOBIT / AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND);
+    bool wasOverBudget = false;
     const int maxHeroBytesPerFrame = int(maxAvatarBytesPerFrame * _avatarHeroFraction);  // 5555, typical
 
     // keep track of the number of other avatars held back in this frame
@@ -373,21 +461,34 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
     // prepare to sort
     const auto& cameraViews = destinationNodeData->getViewFrustums();
 
-    using AvatarPriorityQueue = PrioritySortUtil::PriorityQueue<SortableAvatar>;
+    // the queues only live until this listener has been sent to, so they take their memory from the frame arena
+    FrameArena::Scope arenaScope(_frameArena);
+    using AvatarPriorityQueue = PrioritySortUtil::PriorityQueue<SortableAvatar, ArenaAllocator<SortableAvatar>>;
+    ArenaAllocator<SortableAvatar> allocator(_frameArena);
     // Keep two independent queues, one for heroes and one for the riff-raff.
     enum PriorityVariants { kHero, kNonhero };
     AvatarPriorityQueue avatarPriorityQueues[2] =
     {
         {cameraViews, AvatarData::_avatarSortCoefficientSize, 
-            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge},
+            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge, allocator},
         {cameraViews, AvatarData::_avatarSortCoefficientSize,
-            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge}
+            AvatarData::_avatarSortCoefficientCenter, AvatarData::_avatarSortCoefficientAge, allocator}
     };
 
-    avatarPriorityQueues[kNonhero].reserve(_end - _begin);
+    // with many avatars, only consider the nearby ones, the heroes and a rotating sample of the far ones
+    // while the PAL is open, or has just been closed, every avatar is needed
+    bool useSpatialGrid = _sharedData->spatialGridMinAvatars > 0 && !PALIsOpen && !PALWasOpen
+        && (int)_sharedData->avatarGrid.size() >= _sharedData->spatialGridMinAvatars;
+    gatherCandidates(destinationPosition, useSpatialGrid);
+
+    _stats.numCandidatesConsidered += (int)_candidates.size();
+    if (useSpatialGrid) {
+        _stats.numSpatialGridListeners++;
+    }
+
+    avatarPriorityQueues[kNonhero].reserve(_candidates.size());
 
-    for (auto listedNode = _begin; listedNode != _end; ++listedNode) {
-        Node* otherNodeRaw = (*listedNode).data();
+    for (Node* otherNodeRaw : _candidates) {
         if (otherNodeRaw->getType() != NodeType::Agent
             || !otherNodeRaw->getLinkedData()
             || otherNodeRaw == destinationNode) {
@@ -412,8 +513,10 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         // make sure we have data for this avatar, that it isn't the same node,
         // and isn't an avatar that the viewing node has ignored
         // or that has ignored the viewing node
-        if ((destinationNode->isIgnoringNodeWithID(sourceAvatarNode->getUUID()) && !PALIsOpen)
-            || (sourceAvatarNode->isIgnoringNodeWithID(destinationNode->getUUID()) && !getsAnyIgnored)) {
+        // both by local ID, which are bit tests
+        bool isIgnoringSource = destinationNode->isIgnoringNodeWithLocalID(sourceAvatarNode->getLocalID());
+        bool isIgnoredBySource = sourceAvatarNode->isIgnoringNodeWithLocalID(destinationNode->getLocalID());
+        if ((isIgnoringSource && !PALIsOpen) || (isIgnoredBySource && !getsAnyIgnored)) {
             sendAvatar = false;
         } else {
             // Check to see if the space bubble is enabled
@@ -428,7 +531,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             }
             // Not close enough to ignore
             if (sendAvatar) {
-                destinationNodeData->removeFromRadiusIgnoringSet(sourceAvatarNode->getUUID());
+                destinationNodeData->removeFromRadiusIgnoringSet(sourceAvatarNode->getLocalID());
             }
         }
 
@@ -489,9 +592,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         // This is a bit heavy-handed still - there are cases where a kill packet
         // will be sent when it doesn't need to be (but where it _should_ be OK to send).
         // However, it's less heavy-handed than using `shouldIgnore`.
-        if (PALWasOpen && !PALIsOpen &&
-            (destinationNode->isIgnoringNodeWithID(sourceAvatarNode->getUUID()) ||
-                sourceAvatarNode->isIgnoringNodeWithID(destinationNode->getUUID()))) {
+        if (PALWasOpen && !PALIsOpen && (isIgnoringSource || isIgnoredBySource)) {
             // ...send a Kill Packet to Node A, instructing Node A to kill Avatar B,
             // then have Node A cleanup the killed Node B.
             auto packet = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason), true);
@@ -533,6 +634,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             auto frameByteEstimate = identityBytesSent + traitBytesSent + numAvatarDataBytes + minimRemainingAvatarBytes;
             bool overBudget = frameByteEstimate > maxAvatarBytesPerFrame;
             if (overBudget) {
+                wasOverBudget = true;
                 if (PALIsOpen) {
                     _stats.overBudgetAvatars++;
                     detail = AvatarData::PALMinimum;
@@ -635,6 +737,8 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
         }
     }
 
+    bandwidthBudget.frameSent(wasOverBudget);
+
     if (destinationNodeData->getNumAvatarsSentLastFrame() > numToSendEst) {
         qCWarning(avatars) << "More avatars sent than upper estimate" << destinationNodeData->getNumAvatarsSentLastFrame()
             << " / " << numToSendEst;
@@ -679,6 +783,7 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
 }
 
 uint64_t REBROADCAST_IDENTITY_TO_DOWNSTREAM_EVERY_US = 5 * 1000 * 1000;
+uint64_t SEND_SHARD_SUMMARIES_EVERY_US = 250 * 1000;
 
 void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePointer& node) {
     _stats.downstreamMixersBroadcastedTo++;
@@ -696,17 +801,37 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
     // reset the number of sent avatars
     nodeData->resetNumAvatarsSentLastFrame();
 
+    // another shard is sent where each of our avatars is every so often, and the full data only of those it asks for
+    bool isShard = node->getType() == NodeType::AvatarMixer;
+    std::unique_ptr<NLPacketList> summaryPacketList;
+    if (isShard && usecTimestampNow() - nodeData->getLastShardSummaryTime() >= SEND_SHARD_SUMMARIES_EVERY_US) {
+        summaryPacketList = NLPacketList::create(PacketType::AvatarShardSummaries, QByteArray(), true, true);
+        nodeData->setLastShardSummaryTime(usecTimestampNow());
+    }
+
     std::for_each(_begin, _end, [&](const SharedNodePointer& agentNode) {
         if (!AvatarMixer::shouldReplicateTo(*agentNode, *node)) {
             return;
         }
         
         // collect agents that we have avatar data for that we are supposed to replicate
-        if (agentNode->getType() == NodeType::Agent && agentNode->getLinkedData() && agentNode->isReplicated()) {
+        if (agentNode->getType() == NodeType::Agent && agentNode->getLinkedData()) {
             const AvatarMixerClientData* agentNodeData = reinterpret_cast<const AvatarMixerClientData*>(agentNode->getLinkedData());
 
             AvatarSharedPointer otherAvatar = agentNodeData->getAvatarSharedPointer();
 
+            if (summaryPacketList) {
+                // the session and local IDs, the center of the avatar's bounds and the radius around it
+                AABox avatarBox = otherAvatar->getGlobalBoundingBox();
+                summaryPacketList->write(agentNode->getUUID().toRfc4122());
+                summaryPacketList->writePrimitive(agentNode->getLocalID());
+                summaryPacketList->writePrimitive(avatarBox.calcCenter());
+                summaryPacketList->writePrimitive(0.5f * glm::length(avatarBox.getDimensions()));
+            }
+            if (isShard && !nodeData->isShardAvatarRequested(agentNode->getLocalID())) {
+                return;
+            }
+
             quint64 startAvatarDataPacking = usecTimestampNow();
 
             // we cannot send a downstream avatar mixer any updates that expect them to have previous state for this avatar
@@ -736,6 +861,7 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
             // to fit in a segment of the packet list
             auto maxAvatarByteArraySize = avatarPacketList->getMaxSegmentSize();
             maxAvatarByteArraySize -= NUM_BYTES_RFC4122_UUID;
+            maxAvatarByteArraySize -= sizeof(Node::LocalID);
             maxAvatarByteArraySize -= sizeof(quint16);
 
             auto sequenceNumberSize = sizeof(agentNodeData->getLastReceivedSequenceNumber());
@@ -771,9 +897,10 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
                 // start a new segment in the packet list for this avatar
                 avatarPacketList->startSegment();
 
-                // write the node's UUID, the size of the replicated avatar data,
+                // write the node's UUID and local ID, the size of the replicated avatar data,
                 // the sequence number of the replicated avatar data, and the replicated avatar data
                 numAvatarDataBytes += avatarPacketList->write(agentNode->getUUID().toRfc4122());
+                numAvatarDataBytes += avatarPacketList->writePrimitive(agentNode->getLocalID());
                 numAvatarDataBytes += avatarPacketList->writePrimitive((quint16) (avatarByteArray.size() + sequenceNumberSize));
                 numAvatarDataBytes += avatarPacketList->writePrimitive(agentNodeData->getLastReceivedSequenceNumber());
                 numAvatarDataBytes += avatarPacketList->write(avatarByteArray);
@@ -801,7 +928,7 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
 
         // send the replicated bulk avatar data
         auto nodeList = DependencyManager::get<NodeList>();
-        nodeList->sendPacketList(std::move(avatarPacketList), node->getPublicSocket());
+        nodeList->sendPacketList(std::move(avatarPacketList), *node);
 
         // record the bytes sent for other avatar data in the AvatarMixerClientData
         nodeData->recordSentAvatarData(numAvatarDataBytes);
@@ -809,5 +936,9 @@ void AvatarMixerSlave::broadcastAvatarDataToDownstreamMixer(const SharedNodePoin
         quint64 endPacketSending = usecTimestampNow();
         _stats.packetSendingElapsedTime += (endPacketSending - startPacketSending);
     }
+
+    if (summaryPacketList && summaryPacketList->getNumPackets() > 0) {
+        DependencyManager::get<NodeList>()->sendPacketList(std::move(summaryPacketList), *node);
+    }
 }
 
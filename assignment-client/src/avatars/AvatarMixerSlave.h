@@ -12,8 +12,12 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <AvatarTraits.h>
+#include <FrameArena.h>
 #include <NodeList.h>
 
+#include "AvatarSpatialGrid.h"
+
 class AvatarMixerClientData;
 
 class AvatarMixerSlaveStats {
@@ -30,9 +34,16 @@ public:
     int numDataPacketsSent { 0 };
     int numTraitsPacketsSent { 0 };
     int numIdentityPacketsSent { 0 };
+    int numAvatarEntityReferencesSent { 0 };
+    int numAvatarEntitiesSentFromBase { 0 };
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numCandidatesConsidered { 0 };
+    int numSpatialGridListeners { 0 };
+    float bandwidthBudgetKbps { 0.0f };     // summed over the listeners
+    quint64 numArenaAllocations { 0 };
+    quint64 numArenaBlockAllocations { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
@@ -56,9 +67,16 @@ public:
         numDataPacketsSent = 0;
         numTraitsPacketsSent = 0;
         numIdentityPacketsSent = 0;
+        numAvatarEntityReferencesSent = 0;
+        numAvatarEntitiesSentFromBase = 0;
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numCandidatesConsidered = 0;
+        numSpatialGridListeners = 0;
+        bandwidthBudgetKbps = 0.0f;
+        numArenaAllocations = 0;
+        numArenaBlockAllocations = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
@@ -80,9 +98,16 @@ public:
         numDataPacketsSent += rhs.numDataPacketsSent;
         numTraitsPacketsSent += rhs.numTraitsPacketsSent;
         numIdentityPacketsSent += rhs.numIdentityPacketsSent;
+        numAvatarEntityReferencesSent += rhs.numAvatarEntityReferencesSent;
+        numAvatarEntitiesSentFromBase += rhs.numAvatarEntitiesSentFromBase;
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numCandidatesConsidered += rhs.numCandidatesConsidered;
+        numSpatialGridListeners += rhs.numSpatialGridListeners;
+        bandwidthBudgetKbps += rhs.bandwidthBudgetKbps;
+        numArenaAllocations += rhs.numArenaAllocations;
+        numArenaBlockAllocations += rhs.numArenaBlockAllocations;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
@@ -100,6 +125,13 @@ struct SlaveSharedData {
     QStringList skeletonURLWhitelist;
     QUrl skeletonReplacementURL;
     EntityTreePointer entityTree;
+
+    // candidate selection for large domains, the grid is rebuilt before each broadcast
+    AvatarSpatialGrid avatarGrid;
+    int spatialGridMinAvatars { 0 };    // 0 disables the grid
+    float spatialGridRadius { 0.0f };
+
+    AvatarBandwidthBudget::Settings bandwidthBudget;
 };
 
 class AvatarMixerSlave {
@@ -131,9 +163,17 @@ private:
                                         const AvatarMixerClientData* sendingNodeData,
                                         NLPacketList& traitsPacketList);
 
+    qint64 addAvatarEntityToBulkPacket(AvatarMixerClientData* listeningNodeData,
+                                       const AvatarMixerClientData* sendingNodeData,
+                                       AvatarTraits::TraitInstanceID instanceID,
+                                       AvatarTraits::TraitVersion traitVersion,
+                                       NLPacketList& traitsPacketList);
+
     void broadcastAvatarDataToAgent(const SharedNodePointer& node);
     void broadcastAvatarDataToDownstreamMixer(const SharedNodePointer& node);
 
+    void gatherCandidates(const glm::vec3& destinationPosition, bool useSpatialGrid);
+
     // frame state
     ConstIter _begin;
     ConstIter _end;
@@ -143,6 +183,11 @@ private:
     float _throttlingRatio { 0.0f };
     float _avatarHeroFraction { 0.4f };
 
+    std::vector<Node*> _candidates;   // other avatars considered for the current listener
+
+    // the memory of what's sorted for the current listener, rewound for each one
+    FrameArena _frameArena { FrameArena::DEFAULT_BLOCK_SIZE, MemoryTag::Avatars };
+
     AvatarMixerSlaveStats _stats;
     SlaveSharedData* _sharedData;
 };
@@ -15,13 +15,26 @@
 #include <algorithm>
 
 void AvatarMixerSlaveThread::run() {
+    using namespace std::chrono;
+
     while (true) {
         wait();
 
-        // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
+        {
+            // collect the packets this thread sends during the frame and flush them together
+            auto sendBatch = DependencyManager::get<NodeList>()->batchUnreliableSends();
+
+            // work through our share of the nodes, then help the other slaves finish theirs
+            auto start = p_high_resolution_clock::now();
+            WorkStealingScheduler::Index task;
+            while (_pool._scheduler.pop(_workerIndex, task)) {
+                auto taskStart = p_high_resolution_clock::now();
+                (this->*_function)(_pool._nodes[task]);
+                _pool._taskCosts[task] =
+                    (float)duration_cast<microseconds>(p_high_resolution_clock::now() - taskStart).count();
+            }
+            auto busyTime = duration_cast<microseconds>(p_high_resolution_clock::now() - start).count();
+            _pool._scheduler.recordBusyTime(_workerIndex, busyTime);
         }
 
         bool stopping = _stop;
@@ -39,7 +52,7 @@ void AvatarMixerSlaveThread::wait() {
             assert(_pool._numStarted <= _pool._numThreads);
             return _pool._numStarted != _pool._numThreads;
         });
-        ++_pool._numStarted;
+        _workerIndex = _pool._numStarted++;
     }
     if (_pool._configure) {
         _pool._configure(*this);
@@ -59,16 +72,12 @@ void AvatarMixerSlaveThread::notify(bool stopping) {
     _pool._poolCondition.notify_one();
 }
 
-bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
-}
-
 void AvatarMixerSlavePool::processIncomingPackets(ConstIter begin, ConstIter end) {
     _function = &AvatarMixerSlave::processIncomingPackets;
     _configure = [=](AvatarMixerSlave& slave) { 
         slave.configure(begin, end);
     };
-    run(begin, end);
+    run(PROCESS_INCOMING_PACKETS, begin, end);
 }
 
 void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end, 
@@ -79,17 +88,42 @@ void AvatarMixerSlavePool::broadcastAvatarData(ConstIter begin, ConstIter end,
         slave.configureBroadcast(begin, end, lastFrameTimestamp, maxKbpsPerNode, throttlingRatio,
             _priorityReservedFraction);
    };
-    run(begin, end);
+    run(BROADCAST_AVATAR_DATA, begin, end);
 }
 
-void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AvatarMixerSlavePool::run(Phase phase, ConstIter begin, ConstIter end) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
-    });
+    // lay out the frame's tasks, weighted by what each node cost in this phase last frame
+    auto& nodeCosts = _nodeCosts[phase];
+    _nodes.assign(_begin, _end);
+    _expectedCosts.resize(_nodes.size());
+
+    float knownCostSum = 0.0f;
+    int numKnownCosts = 0;
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+        auto it = nodeCosts.find(_nodes[i]->getLocalID());
+        if (it != nodeCosts.end()) {
+            _expectedCosts[i] = it->second;
+            knownCostSum += it->second;
+            ++numKnownCosts;
+        } else {
+            _expectedCosts[i] = -1.0f;
+        }
+    }
+
+    // new nodes are assumed to cost as much as the average known node
+    const float DEFAULT_COST = numKnownCosts > 0 ? std::max(knownCostSum / numKnownCosts, 1.0f) : 1.0f;
+    for (auto& cost : _expectedCosts) {
+        if (cost < 0.0f) {
+            cost = DEFAULT_COST;
+        }
+    }
+
+    _taskCosts.assign(_nodes.size(), 0.0f);
+    _scheduler.reset(_numThreads, _nodes.size(), _expectedCosts);
+    auto phaseStart = p_high_resolution_clock::now();
 
     {
         Lock lock(_mutex);
@@ -107,7 +141,40 @@ void AvatarMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+    auto phaseTime = std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now() - phaseStart);
+    _autoscaler.recordPhase((uint64_t)phaseTime.count(), _scheduler.getTotalBusyTime(), _numThreads);
+
+    // remember what each node cost for the next frame
+    nodeCosts.clear();
+    for (size_t i = 0; i < _nodes.size(); ++i) {
+        nodeCosts[_nodes[i]->getLocalID()] = _taskCosts[i];
+    }
+
+    if (!_nodes.empty()) {
+        auto& balance = _balanceStats[phase];
+        float imbalance = _scheduler.getImbalance();
+        balance.imbalanceSum += imbalance;
+        balance.worstImbalance = std::max(balance.worstImbalance, imbalance);
+        balance.numSteals += _scheduler.getNumSteals();
+        ++balance.numFrames;
+    }
+
+    // don't hold on to the nodes between frames
+    _nodes.clear();
+}
+
+void AvatarMixerSlavePool::balanceStats(QJsonObject& stats) {
+    static const char* PHASE_NAMES[NUM_PHASES] = { "process_incoming_packets", "broadcast_avatar_data" };
+
+    for (int phase = 0; phase < NUM_PHASES; ++phase) {
+        auto& balance = _balanceStats[phase];
+        QJsonObject phaseStats;
+        phaseStats["avg_imbalance"] = balance.numFrames > 0 ? balance.imbalanceSum / balance.numFrames : 1.0f;
+        phaseStats["max_imbalance"] = balance.worstImbalance;
+        phaseStats["avg_steals_per_frame"] = balance.numFrames > 0 ? (float)balance.numSteals / balance.numFrames : 0.0f;
+        stats[PHASE_NAMES[phase]] = phaseStats;
+        balance = BalanceStats();
+    }
 }
 
 
@@ -130,15 +197,32 @@ void AvatarMixerSlavePool::queueStats(QJsonObject& stats) {
 }
 #endif // DEBUG_EVENT_QUEUE
 
+static int getMaxNumThreads() {
+    // the CPUs this process is bound to, which are all of them unless it was given a placement
+    int maxThreads = ProcessPlacement::getNumUsableCpus();
+    if (maxThreads <= 0) {
+        // no CPUs are reported if they cannot be detected
+        static const int MAX_THREADS_IF_UNKNOWN = 4;
+        maxThreads = MAX_THREADS_IF_UNKNOWN;
+    }
+    return maxThreads;
+}
+
+void AvatarMixerSlavePool::setAutoscaling(bool enabled) {
+    _autoscaler.setEnabled(enabled, 1, getMaxNumThreads());
+}
+
+void AvatarMixerSlavePool::autoscale(uint64_t frameBudgetUsecs) {
+    int numThreads = _autoscaler.endFrame(frameBudgetUsecs, _numThreads);
+    if (numThreads != _numThreads) {
+        resize(numThreads);
+    }
+}
+
 void AvatarMixerSlavePool::setNumThreads(int numThreads) {
     // clamp to allowed size
     {
-        int maxThreads = QThread::idealThreadCount();
-        if (maxThreads == -1) {
-            // idealThreadCount returns -1 if cores cannot be detected
-            static const int MAX_THREADS_IF_UNKNOWN = 4;
-            maxThreads = MAX_THREADS_IF_UNKNOWN;
-        }
+        int maxThreads = getMaxNumThreads();
 
         int clampedThreads = std::min(std::max(1, numThreads), maxThreads);
         if (clampedThreads != numThreads) {
@@ -175,6 +259,7 @@ void AvatarMixerSlavePool::resize(int numThreads) {
         }
 
         // ...cycle them until they do stop...
+        _scheduler.reset(_numThreads, 0);
         _numStopped = 0;
         while (_numStopped != (_numThreads - numThreads)) {
             _numStarted = _numFinished = _numStopped;
@@ -12,16 +12,21 @@
 #ifndef hifi_AvatarMixerSlavePool_h
 #define hifi_AvatarMixerSlavePool_h
 
+#include <array>
 #include <condition_variable>
 #include <mutex>
+#include <unordered_map>
 #include <vector>
 
+#include <QJsonObject>
 #include <QThread>
 
-#include <TBBHelpers.h>
+#include <ProcessPlacement.h>
+#include <WorkStealingScheduler.h>
 #include <NodeList.h>
 #include <shared/QtHelpers.h>
 
+#include "../SlavePoolAutoscaler.h"
 #include "AvatarMixerSlave.h"
 
 
@@ -44,17 +49,16 @@ private:
 
     void wait();
     void notify(bool stopping);
-    bool try_pop(SharedNodePointer& node);
 
     AvatarMixerSlavePool& _pool;
     void (AvatarMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
+    int _workerIndex { 0 };
     bool _stop { false };
 };
 
 // Slave pool for avatar mixers
 //   AvatarMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AvatarMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -62,7 +66,13 @@ class AvatarMixerSlavePool {
 public:
     using ConstIter = NodeList::const_iterator;
 
-    AvatarMixerSlavePool(SlaveSharedData* slaveSharedData, int numThreads = QThread::idealThreadCount()) :
+    enum Phase {
+        PROCESS_INCOMING_PACKETS = 0,
+        BROADCAST_AVATAR_DATA,
+        NUM_PHASES
+    };
+
+    AvatarMixerSlavePool(SlaveSharedData* slaveSharedData, int numThreads = ProcessPlacement::getNumUsableCpus()) :
         _slaveSharedData(slaveSharedData) { setNumThreads(numThreads); }
     ~AvatarMixerSlavePool() { resize(0); }
 
@@ -74,6 +84,9 @@ public:
     // iterate over all slaves
     void each(std::function<void(AvatarMixerSlave& slave)> functor);
 
+    // per-phase thread imbalance (busiest thread time over mean thread time) and steals since the last call
+    void balanceStats(QJsonObject& stats);
+
 #ifdef DEBUG_EVENT_QUEUE
     void queueStats(QJsonObject& stats);
 #endif
@@ -81,18 +94,24 @@ public:
     void setNumThreads(int numThreads);
     int numThreads() const { return _numThreads; }
 
+    // grow and shrink the pool with its load, between one thread and the CPUs we can run on
+    void setAutoscaling(bool enabled);
+    // once per frame, after the frame's phases have run
+    void autoscale(uint64_t frameBudgetUsecs);
+    void autoscalingStats(QJsonObject& stats) { _autoscaler.stats(stats); }
+
     void setPriorityReservedFraction(float fraction) { _priorityReservedFraction = fraction; }
     float getPriorityReservedFraction() const { return  _priorityReservedFraction; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    void run(Phase phase, ConstIter begin, ConstIter end);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AvatarMixerSlaveThread>> _slaves;
 
     friend void AvatarMixerSlaveThread::wait();
     friend void AvatarMixerSlaveThread::notify(bool stopping);
-    friend bool AvatarMixerSlaveThread::try_pop(SharedNodePointer& node);
+    friend void AvatarMixerSlaveThread::run();
 
     // synchronization state
     Mutex _mutex;
@@ -110,9 +129,25 @@ private:
     int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
     ConstIter _begin;
     ConstIter _end;
+    std::vector<SharedNodePointer> _nodes;
+    std::vector<float> _expectedCosts;
+    std::vector<float> _taskCosts; // usecs, written by the slave that ran each task
+    WorkStealingScheduler _scheduler;
+
+    // what each node cost in each phase last frame, used to balance the next frame
+    std::array<std::unordered_map<Node::LocalID, float>, NUM_PHASES> _nodeCosts;
+
+    struct BalanceStats {
+        float imbalanceSum { 0.0f };
+        float worstImbalance { 1.0f };
+        int numSteals { 0 };
+        int numFrames { 0 };
+    };
+    std::array<BalanceStats, NUM_PHASES> _balanceStats;
+
+    SlavePoolAutoscaler _autoscaler;
 
     SlaveSharedData* _slaveSharedData;
 };
@@ -0,0 +1,66 @@
+//
+//  AvatarSpatialGrid.cpp
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarSpatialGrid.h"
+
+#include "AvatarMixerClientData.h"
+
+// cell coordinates are packed into 21 bits each, which covers the whole domain for any sensible cell size
+static const int CELL_COORDINATE_BITS = 21;
+static const int CELL_COORDINATE_OFFSET = 1 << (CELL_COORDINATE_BITS - 1);
+static const uint64_t CELL_COORDINATE_MASK = (1ull << CELL_COORDINATE_BITS) - 1;
+
+void AvatarSpatialGrid::rebuild(ConstIter begin, ConstIter end, float cellSize) {
+    _cellSize = std::max(cellSize, 1.0f);
+    ++_frame;
+
+    // entries hold pointers into each other, so fill them completely before indexing
+    _entries.clear();
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        auto nodeData = static_cast<const AvatarMixerClientData*>(node->getLinkedData());
+        if (node->getType() == NodeType::Agent && nodeData) {
+            const MixerAvatar* avatar = nodeData->getConstAvatarData();
+            _entries.push_back({ node.data(), cellOf(avatar->getClientGlobalPosition()), avatar->getHasPriority() });
+        }
+    });
+
+    _cellIndex.clear();
+    _heroes.clear();
+    for (const Entry& entry : _entries) {
+        _cellIndex.emplace_back(keyOf(entry.cell), &entry);
+        if (entry.isHero) {
+            _heroes.push_back(&entry);
+        }
+    }
+
+    std::sort(_cellIndex.begin(), _cellIndex.end(),
+        [](const std::pair<uint64_t, const Entry*>& lhs, const std::pair<uint64_t, const Entry*>& rhs) {
+            return lhs.first < rhs.first;
+        });
+}
+
+AvatarSpatialGrid::CellRange AvatarSpatialGrid::cellsNear(const glm::vec3& position, float radius) const {
+    return { cellOf(position - glm::vec3(radius)), cellOf(position + glm::vec3(radius)) };
+}
+
+glm::ivec3 AvatarSpatialGrid::cellOf(const glm::vec3& position) const {
+    if (glm::any(glm::isnan(position))) {
+        return glm::ivec3(0);
+    }
+    glm::vec3 cell = glm::floor(position / _cellSize);
+    return glm::ivec3(glm::clamp(cell, glm::vec3(-CELL_COORDINATE_OFFSET), glm::vec3(CELL_COORDINATE_OFFSET - 1)));
+}
+
+uint64_t AvatarSpatialGrid::keyOf(const glm::ivec3& cell) {
+    return ((uint64_t)(cell.x + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK) << (2 * CELL_COORDINATE_BITS)
+        | ((uint64_t)(cell.y + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK) << CELL_COORDINATE_BITS
+        | ((uint64_t)(cell.z + CELL_COORDINATE_OFFSET) & CELL_COORDINATE_MASK);
+}
@@ -0,0 +1,100 @@
+//
+//  AvatarSpatialGrid.h
+//  assignment-client/src/avatars
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarSpatialGrid_h
+#define hifi_AvatarSpatialGrid_h
+
+#include <algorithm>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <NodeList.h>
+
+// Uniform grid of the agent avatars, rebuilt on the mixer thread once per frame before the broadcast,
+// and then read concurrently by the slaves. It lets each listener visit its nearby avatars, the heroes
+// and a rotating sample of the far avatars, instead of every avatar in the domain.
+class AvatarSpatialGrid {
+public:
+    using ConstIter = NodeList::const_iterator;
+
+    struct Entry {
+        Node* node;
+        glm::ivec3 cell;
+        bool isHero;
+    };
+
+    // inclusive range of cells
+    struct CellRange {
+        glm::ivec3 min;
+        glm::ivec3 max;
+
+        bool contains(const glm::ivec3& cell) const {
+            return glm::all(glm::greaterThanEqual(cell, min)) && glm::all(glm::lessThanEqual(cell, max));
+        }
+    };
+
+    // the nodes must stay alive until the next rebuild
+    void rebuild(ConstIter begin, ConstIter end, float cellSize);
+
+    size_t size() const { return _entries.size(); }
+    uint32_t getFrame() const { return _frame; }
+
+    CellRange cellsNear(const glm::vec3& position, float radius) const;
+
+    template <typename EntryLambda>
+    void eachEntryInCells(const CellRange& range, EntryLambda functor) const;
+
+    const std::vector<const Entry*>& getHeroes() const { return _heroes; }
+
+    // every entry is part of the far sample once every samplePeriod frames
+    template <typename EntryLambda>
+    void eachFarSampleEntry(uint32_t samplePeriod, EntryLambda functor) const;
+
+private:
+    glm::ivec3 cellOf(const glm::vec3& position) const;
+    static uint64_t keyOf(const glm::ivec3& cell);
+
+    float _cellSize { 1.0f };
+    uint32_t _frame { 0 };
+
+    std::vector<Entry> _entries;
+    std::vector<std::pair<uint64_t, const Entry*>> _cellIndex;    // sorted by cell key
+    std::vector<const Entry*> _heroes;
+};
+
+template <typename EntryLambda>
+void AvatarSpatialGrid::eachEntryInCells(const CellRange& range, EntryLambda functor) const {
+    auto compareKeys = [](const std::pair<uint64_t, const Entry*>& lhs, const std::pair<uint64_t, const Entry*>& rhs) {
+        return lhs.first < rhs.first;
+    };
+
+    for (int x = range.min.x; x <= range.max.x; ++x) {
+        for (int y = range.min.y; y <= range.max.y; ++y) {
+            for (int z = range.min.z; z <= range.max.z; ++z) {
+                std::pair<uint64_t, const Entry*> key { keyOf(glm::ivec3(x, y, z)), nullptr };
+                auto cell = std::equal_range(_cellIndex.cbegin(), _cellIndex.cend(), key, compareKeys);
+                for (auto it = cell.first; it != cell.second; ++it) {
+                    functor(*it->second);
+                }
+            }
+        }
+    }
+}
+
+template <typename EntryLambda>
+void AvatarSpatialGrid::eachFarSampleEntry(uint32_t samplePeriod, EntryLambda functor) const {
+    for (size_t i = _frame % std::max(samplePeriod, 1u); i < _entries.size(); i += std::max(samplePeriod, 1u)) {
+        functor(_entries[i]);
+    }
+}
+
+#endif // hifi_AvatarSpatialGrid_h
@@ -0,0 +1,166 @@
+//
+//  EntityInterestTiers.cpp
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityInterestTiers.h"
+
+#include <algorithm>
+
+using namespace workload;
+
+// the regions only need to be about right, so they aren't worth classifying every send interval
+static const uint64_t CLASSIFY_INTERVAL_USECS = 50 * 1000;
+
+void EntityInterestTiers::setViews(const ConicalViewFrustums& views) {
+    // the regions are centered on the views rather than pushed out ahead of them like on the client,
+    // since the client may turn around before the next edit of an entity
+    float regionBackFronts[Region::NUM_TRACKED_REGIONS * 2];
+    for (uint32_t i = 0; i < Region::NUM_TRACKED_REGIONS; ++i) {
+        regionBackFronts[i * 2] = _settings.regionDistances[i];
+        regionBackFronts[i * 2 + 1] = _settings.regionDistances[i];
+    }
+
+    Views workloadViews;
+    workloadViews.reserve(views.size());
+    for (const auto& view : views) {
+        View workloadView;
+        workloadView.origin = view.getPosition();
+        workloadView.direction = view.getDirection();
+        View::updateRegionsFromBackFrontDistances(workloadView, regionBackFronts);
+        workloadViews.push_back(workloadView);
+    }
+    _space.setViews(workloadViews);
+}
+
+void EntityInterestTiers::classify(uint64_t now) {
+    if (!_settings.isEnabled || now - _lastClassified < CLASSIFY_INTERVAL_USECS) {
+        return;
+    }
+    _lastClassified = now;
+
+    _space.enqueueTransaction(std::move(_pendingTransaction));
+    _pendingTransaction = Transaction();
+    _space.enqueueFrame();
+    _space.processTransactionQueue();
+
+    _changes.clear();
+    _space.categorizeAndGetChanges(_changes);
+    for (const auto& change : _changes) {
+        if (change.proxyId < (int32_t)_proxyEntities.size() && _proxyEntities[change.proxyId]) {
+            auto interest = _interests.find(_proxyEntities[change.proxyId]);
+            if (interest != _interests.end()) {
+                interest->second.region = change.region;
+            }
+        }
+    }
+}
+
+void EntityInterestTiers::entitySent(EntityItem* entity, uint64_t now, int encodedBytes) {
+    if (!_settings.isEnabled) {
+        return;
+    }
+
+    auto& interest = _interests[entity];
+    Sphere sphere(entity->getWorldPosition(), entity->getBoundingRadius());
+    if (interest.proxyID == INVALID_PROXY_ID) {
+        interest.proxyID = _space.allocateID();
+        if (interest.proxyID >= (ProxyID)_proxyEntities.size()) {
+            _proxyEntities.resize(interest.proxyID + 1, nullptr);
+        }
+        _proxyEntities[interest.proxyID] = entity;
+        _pendingTransaction.reset(interest.proxyID, sphere, Owner());
+    } else {
+        _pendingTransaction.update(interest.proxyID, sphere);
+    }
+    interest.lastSent = now;
+    interest.lastEncodedBytes = encodedBytes;
+    interest.isDeferred = false;
+    interest.deferredEntity.reset();
+}
+
+void EntityInterestTiers::forget(EntityItem* entity) {
+    auto interest = _interests.find(entity);
+    if (interest == _interests.end()) {
+        return;
+    }
+    if (interest->second.proxyID != INVALID_PROXY_ID) {
+        _pendingTransaction.remove(interest->second.proxyID);
+        _proxyEntities[interest->second.proxyID] = nullptr;
+    }
+    _interests.erase(interest);
+}
+
+void EntityInterestTiers::clear() {
+    // the space forgets its views along with its proxies
+    Views views;
+    _space.copyViews(views);
+    _space.clear();
+    _space.setViews(views);
+    _pendingTransaction = Transaction();
+    _interests.clear();
+    _proxyEntities.clear();
+    _deferredEntities.clear();
+    _numDeferredEntities = 0;
+    _lastClassified = 0;
+}
+
+bool EntityInterestTiers::defer(const EntityItemPointer& entity, uint64_t now) {
+    if (!_settings.isEnabled) {
+        return false;
+    }
+    auto found = _interests.find(entity.get());
+    if (found == _interests.end()) {
+        return false;
+    }
+
+    auto& interest = found->second;
+    uint8_t region = std::min(interest.region, (uint8_t)Region::R4);
+    if (now - interest.lastSent >= _settings.regionSendIntervals[region]) {
+        return false;
+    }
+
+    quint64 lastEdited = std::max(entity->getLastEdited(), entity->getLastChangedOnServer());
+    if (!interest.isDeferred) {
+        interest.isDeferred = true;
+        interest.deferredEntity = entity;
+        _deferredEntities.push_back(entity.get());
+        _numDeferredEntities = (uint32_t)_deferredEntities.size();
+    } else if (lastEdited > interest.deferredEdit) {
+        // one update less than there would have been
+        ++_numCoalescedUpdates;
+        _bytesSaved += interest.lastEncodedBytes;
+    }
+    interest.deferredEdit = std::max(interest.deferredEdit, lastEdited);
+    return true;
+}
+
+void EntityInterestTiers::takeDueEntities(uint64_t now, std::vector<EntityItemPointer>& dueEntities) {
+    auto isDone = [&](EntityItem* entityPointer) {
+        auto found = _interests.find(entityPointer);
+        if (found == _interests.end() || !found->second.isDeferred) {
+            // forgotten or sent in the meantime
+            return true;
+        }
+        auto& interest = found->second;
+        uint8_t region = std::min(interest.region, (uint8_t)Region::R4);
+        if (now - interest.lastSent < _settings.regionSendIntervals[region]) {
+            return false;
+        }
+        if (auto entity = interest.deferredEntity.lock()) {
+            dueEntities.push_back(entity);
+        }
+        interest.isDeferred = false;
+        interest.deferredEntity.reset();
+        return true;
+    };
+    _deferredEntities.erase(std::remove_if(_deferredEntities.begin(), _deferredEntities.end(), isDone),
+                            _deferredEntities.end());
+    _numDeferredEntities = (uint32_t)_deferredEntities.size();
+}
@@ -0,0 +1,88 @@
+//
+//  EntityInterestTiers.h
+//  assignment-client/src/entities
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityInterestTiers_h
+#define hifi_EntityInterestTiers_h
+
+#include <atomic>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <EntityItem.h>
+#include <shared/ConicalViewFrustum.h>
+#include <workload/Space.h>
+
+/// Sorts the entities a client already knows into the workload regions around its views, so that the edits of the far
+/// ones can be sent less often than those of the near ones. An edit of an entity that was sent to the client more
+/// recently than its region's interval is held back and the later edits coalesce into it: whenever it does go, it's
+/// sent with all its current properties, velocities included, so the client's simple kinematic motion carries it in
+/// between. The regions are classified from where the entities were when last sent, which is at most one interval old.
+/// Used only from the send thread of the client.
+class EntityInterestTiers {
+public:
+    struct Settings {
+        bool isEnabled { true };
+        // how far from the client's views each of R1 to R3 reaches, in meters; everything further is in R4
+        float regionDistances[workload::Region::NUM_TRACKED_REGIONS] { 25.0f, 100.0f, 400.0f };
+        // the least time between sends of an edited entity in each of R1 to R4, in usecs
+        uint64_t regionSendIntervals[workload::Region::NUM_KNOWN_REGIONS] { 0, 0, 100 * 1000, 500 * 1000 };
+    };
+
+    void setSettings(const Settings& settings) { _settings = settings; }
+    const Settings& getSettings() const { return _settings; }
+
+    void setViews(const ConicalViewFrustums& views);
+    /// brings the regions of the known entities up to date with their last sent spheres and the views, every so often
+    void classify(uint64_t now);
+
+    /// the entity was sent to the client, as encodedBytes of entity data
+    void entitySent(EntityItem* entity, uint64_t now, int encodedBytes);
+    /// the client doesn't know the entity anymore
+    void forget(EntityItem* entity);
+    void clear();
+
+    /// Returns whether an edit of a known entity is held back for now, in which case it's handed back by takeDueEntities()
+    /// once its region's interval has passed.
+    bool defer(const EntityItemPointer& entity, uint64_t now);
+    void takeDueEntities(uint64_t now, std::vector<EntityItemPointer>& dueEntities);
+
+    uint64_t getNumCoalescedUpdates() const { return _numCoalescedUpdates; }
+    uint64_t getBytesSaved() const { return _bytesSaved; }
+    uint32_t getNumDeferredEntities() const { return _numDeferredEntities; }
+
+private:
+    struct Interest {
+        workload::ProxyID proxyID { workload::INVALID_PROXY_ID };
+        uint8_t region { workload::Region::UNKNOWN };
+        uint64_t lastSent { 0 };
+        int lastEncodedBytes { 0 };
+        // while deferred, the last edit of the entity that was held back
+        bool isDeferred { false };
+        quint64 deferredEdit { 0 };
+        EntityItemWeakPointer deferredEntity;
+    };
+
+    Settings _settings;
+    workload::Space _space;
+    workload::Transaction _pendingTransaction;
+    workload::Changes _changes;
+    std::unordered_map<EntityItem*, Interest> _interests;
+    std::vector<EntityItem*> _proxyEntities; // by proxy ID
+    std::vector<EntityItem*> _deferredEntities;
+    uint64_t _lastClassified { 0 };
+
+    std::atomic<uint64_t> _numCoalescedUpdates { 0 };
+    std::atomic<uint64_t> _bytesSaved { 0 };
+    std::atomic<uint32_t> _numDeferredEntities { 0 };
+};
+
+#endif // hifi_EntityInterestTiers_h
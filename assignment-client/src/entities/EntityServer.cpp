@@ -11,17 +11,24 @@
 
 #include "EntityServer.h"
 
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDir>
 #include <QtCore/QEventLoop>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
 #include <QTimer>
 #include <QJsonArray>
 #include <QJsonDocument>
 
+#include <EntitySceneBundle.h>
 #include <EntityTree.h>
+#include <HTTPConnection.h>
 #include <ResourceCache.h>
 #include <ScriptCache.h>
 #include <plugins/PluginManager.h>
 #include <EntityEditFilters.h>
 #include <NetworkingConstants.h>
+#include <NumericalConstants.h>
 #include <hfm/ModelFormatRegistry.h>
 
 #include "../AssignmentDynamicFactory.h"
@@ -34,10 +41,18 @@ const char* MODEL_SERVER_NAME = "Entity";
 const char* MODEL_SERVER_LOGGING_TARGET_NAME = "entity-server";
 const char* LOCAL_MODELS_PERSIST_FILE = "resources/models.svo";
 
+static const QString SCENE_BUNDLE_DIRECTORY = "scene-bundles";
+static const QString SCENE_BUNDLE_HTTP_PATH = "/" + SCENE_BUNDLE_DIRECTORY + "/";
+// the newest bundle and the one before it, for clients that were told of it just before the newest was written
+static const size_t MAX_PUBLISHED_SCENE_BUNDLES = 2;
+static const int SCENE_BUNDLE_LOAD_RETRY_MSECS = 1000;
+
 EntityServer::EntityServer(ReceivedMessage& message) :
     OctreeServer(message),
     _entitySimulation(nullptr),
-    _dynamicDomainVerificationTimer(this)
+    _dynamicDomainVerificationTimer(this),
+    _sceneBundleTimer(this),
+    _sceneBundleChunkScale(EntitySceneBundle::DEFAULT_CHUNK_SCALE)
 {
     DependencyManager::set<ResourceManager>();
     DependencyManager::set<ResourceCacheSharedItems>();
@@ -62,6 +77,8 @@ EntityServer::EntityServer(ReceivedMessage& message) :
 
     connect(&_dynamicDomainVerificationTimer, &QTimer::timeout, this, &EntityServer::startDynamicDomainVerification);
     _dynamicDomainVerificationTimer.setSingleShot(true);
+
+    connect(&_sceneBundleTimer, &QTimer::timeout, this, &EntityServer::writeSceneBundle);
 }
 
 EntityServer::~EntityServer() {
@@ -75,6 +92,11 @@ EntityServer::~EntityServer() {
 }
 
 void EntityServer::aboutToFinish() {
+    _sceneBundleTimer.stop();
+    if (_sceneBundleWrite.valid()) {
+        _sceneBundleWrite.wait();
+    }
+
     DependencyManager::get<ResourceManager>()->cleanup();
 
     DependencyManager::destroy<AssignmentDynamicFactory>();
@@ -120,6 +142,9 @@ void EntityServer::beforeRun() {
     const int PRUNE_DELETED_MODELS_INTERVAL_MSECS = 1 * 1000; // once every second
     _pruneDeletedEntitiesTimer->start(PRUNE_DELETED_MODELS_INTERVAL_MSECS);
 
+    // every send thread encodes the same entities, so let them share the encodings
+    EntityItem::setEncodingCacheEnabled(true);
+
     DomainHandler& domainHandler = DependencyManager::get<NodeList>()->getDomainHandler();
     connect(&domainHandler, &DomainHandler::settingsReceiveFail, this, &EntityServer::domainSettingsRequestFailed);
 }
@@ -301,6 +326,13 @@ void EntityServer::pruneDeletedEntities() {
                 }
             }
         });
+        // clients that load the oldest scene bundle are sent what was deleted since it was written
+        {
+            std::lock_guard<std::mutex> lock(_sceneBundlesMutex);
+            if (!_sceneBundles.empty()) {
+                earliestLastDeletedEntitiesSent = std::min(earliestLastDeletedEntitiesSent, _sceneBundles.front()->version);
+            }
+        }
         tree->forgetEntitiesDeletedBefore(earliestLastDeletedEntitiesSent);
     }
 }
@@ -314,6 +346,10 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
     readOptionBool(QString("wantTerseEditLogging"), settingsSectionObject, wantTerseEditLogging);
     qDebug("wantTerseEditLogging=%s", debug::valueOf(wantTerseEditLogging));
 
+    bool disableEntityQueryCache = false;
+    readOptionBool(QString("disableEntityQueryCache"), settingsSectionObject, disableEntityQueryCache);
+    EntityQueryCache::setEnabled(!disableEntityQueryCache);
+
     EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
 
     int maxTmpEntityLifetime;
@@ -354,6 +390,166 @@ void EntityServer::readAdditionalConfiguration(const QJsonObject& settingsSectio
 
         entityEditFilters->addFilter(EntityItemID(), filterURL);
     }
+
+    // the edits of entities far from a client are sent to it less often
+    bool disableInterestTiers = false;
+    readOptionBool(QString("disableInterestTiers"), settingsSectionObject, disableInterestTiers);
+    _interestTierSettings.isEnabled = !disableInterestTiers;
+    const char* regionDistanceOptions[workload::Region::NUM_TRACKED_REGIONS] = {
+        "interestR1Distance", "interestR2Distance", "interestR3Distance"
+    };
+    for (uint32_t i = 0; i < workload::Region::NUM_TRACKED_REGIONS; ++i) {
+        int distance;
+        if (readOptionInt(regionDistanceOptions[i], settingsSectionObject, distance) && distance > 0) {
+            _interestTierSettings.regionDistances[i] = (float)distance;
+        }
+    }
+    const char* regionIntervalOptions[workload::Region::NUM_KNOWN_REGIONS] = {
+        "interestR1IntervalMsecs", "interestR2IntervalMsecs", "interestR3IntervalMsecs", "interestR4IntervalMsecs"
+    };
+    for (uint32_t i = 0; i < workload::Region::NUM_KNOWN_REGIONS; ++i) {
+        int interval;
+        if (readOptionInt(regionIntervalOptions[i], settingsSectionObject, interval) && interval >= 0) {
+            _interestTierSettings.regionSendIntervals[i] = (uint64_t)interval * USECS_PER_MSEC;
+        }
+    }
+    qDebug() << "interestTiers=" << _interestTierSettings.isEnabled
+        << "distances=" << _interestTierSettings.regionDistances[0] << _interestTierSettings.regionDistances[1]
+        << _interestTierSettings.regionDistances[2];
+
+    // new arrivals can download the scene from a bundle written out every so often, instead of having it all sent
+    int sceneBundleIntervalSecs = 0;
+    readOptionInt("sceneBundleIntervalSecs", settingsSectionObject, sceneBundleIntervalSecs);
+    readOptionString("sceneBundleURL", settingsSectionObject, _sceneBundleURL);
+    int sceneBundleChunkSize;
+    if (readOptionInt("sceneBundleChunkSize", settingsSectionObject, sceneBundleChunkSize) && sceneBundleChunkSize > 0) {
+        _sceneBundleChunkScale = (float)sceneBundleChunkSize;
+    }
+    if (sceneBundleIntervalSecs > 0 && _sceneBundleURL.isEmpty()) {
+        qWarning() << "Not writing scene bundles, sceneBundleURL is not set";
+    } else if (sceneBundleIntervalSecs > 0) {
+        if (!_sceneBundleURL.endsWith("/")) {
+            _sceneBundleURL += "/";
+        }
+
+        // the bundles of an earlier run are older than any deletions we know of
+        QDir sceneBundleDirectory(getSceneBundleDirectory());
+        sceneBundleDirectory.removeRecursively();
+        sceneBundleDirectory.mkpath(".");
+
+        _sceneBundleTimer.start(sceneBundleIntervalSecs * MSECS_PER_SECOND);
+        QTimer::singleShot(0, this, &EntityServer::writeSceneBundle);
+    }
+    qDebug() << "sceneBundleIntervalSecs=" << sceneBundleIntervalSecs << "sceneBundleURL=" << _sceneBundleURL;
+}
+
+QString EntityServer::getSceneBundleDirectory() const {
+    return QFileInfo(_persistAbsoluteFilePath).dir().absoluteFilePath(SCENE_BUNDLE_DIRECTORY);
+}
+
+void EntityServer::writeSceneBundle() {
+    if (_sceneBundleWrite.valid() && _sceneBundleWrite.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+        return; // the last one is still being written
+    }
+    if (!isInitialLoadComplete()) {
+        // a bundle written now would be missing the entities still loading
+        QTimer::singleShot(SCENE_BUNDLE_LOAD_RETRY_MSECS, this, &EntityServer::writeSceneBundle);
+        return;
+    }
+
+    EntityTreePointer tree = std::static_pointer_cast<EntityTree>(_tree);
+    float chunkScale = _sceneBundleChunkScale;
+    QString directory = getSceneBundleDirectory();
+    QString baseURL = _sceneBundleURL;
+    QByteArray lastContentHash = _sceneBundleContentHash;
+
+    // encoded and written away from the server's thread, which goes on handling queries and edits
+    _sceneBundleWrite = std::async(std::launch::async, [this, tree, chunkScale, directory, baseURL, lastContentHash] {
+        auto published = std::make_shared<PublishedSceneBundle>();
+        EntitySceneBundle bundle = EntitySceneBundle::encode(tree, chunkScale, &published->entityIDs);
+
+        QCryptographicHash contentHash(QCryptographicHash::Sha256);
+        for (const auto& chunk : bundle.chunks) {
+            contentHash.addData(chunk.sections);
+        }
+        QByteArray hash = contentHash.result();
+        if (hash == lastContentHash) {
+            return; // nothing changed, so the newest bundle is as good as a new one
+        }
+
+        published->version = bundle.version;
+        published->filename = QString("scene-%1.bundle").arg(bundle.version);
+        published->url = baseURL + published->filename;
+
+        QSaveFile file(QDir(directory).absoluteFilePath(published->filename));
+        QByteArray data = bundle.toByteArray();
+        if (!file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+            qWarning() << "Unable to write scene bundle" << file.fileName();
+            return;
+        }
+        qDebug() << "Wrote scene bundle" << published->filename << "with" << bundle.getNumEntities() << "entities in"
+            << bundle.chunks.size() << "chunks," << data.size() << "bytes";
+
+        QMetaObject::invokeMethod(this, [this, published, hash] {
+            publishSceneBundle(published, hash);
+        });
+    });
+}
+
+void EntityServer::publishSceneBundle(PublishedSceneBundlePointer bundle, const QByteArray& contentHash) {
+    _sceneBundleContentHash = contentHash;
+
+    PublishedSceneBundlePointer retired;
+    {
+        std::lock_guard<std::mutex> lock(_sceneBundlesMutex);
+        _sceneBundles.push_back(bundle);
+        if (_sceneBundles.size() > MAX_PUBLISHED_SCENE_BUNDLES) {
+            retired = _sceneBundles.front();
+            _sceneBundles.erase(_sceneBundles.begin());
+        }
+    }
+    if (retired) {
+        QDir(getSceneBundleDirectory()).remove(retired->filename);
+    }
+}
+
+EntityServer::PublishedSceneBundlePointer EntityServer::getSceneBundle() const {
+    std::lock_guard<std::mutex> lock(_sceneBundlesMutex);
+    return _sceneBundles.empty() ? nullptr : _sceneBundles.back();
+}
+
+EntityServer::PublishedSceneBundlePointer EntityServer::getSceneBundle(quint64 version) const {
+    std::lock_guard<std::mutex> lock(_sceneBundlesMutex);
+    for (const auto& bundle : _sceneBundles) {
+        if (bundle->version == version) {
+            return bundle;
+        }
+    }
+    return nullptr;
+}
+
+bool EntityServer::handleSubclassHTTPGet(HTTPConnection* connection, const QUrl& url) {
+    if (!url.path().startsWith(SCENE_BUNDLE_HTTP_PATH)) {
+        return false;
+    }
+
+    // only the bundles published are served, by name, so nothing else in the directory can be asked for
+    QString filename = url.path().mid(SCENE_BUNDLE_HTTP_PATH.size());
+    bool isPublished = false;
+    {
+        std::lock_guard<std::mutex> lock(_sceneBundlesMutex);
+        for (const auto& bundle : _sceneBundles) {
+            isPublished |= bundle->filename == filename;
+        }
+    }
+
+    std::unique_ptr<QFile> file { new QFile(QDir(getSceneBundleDirectory()).absoluteFilePath(filename)) };
+    if (isPublished && file->open(QIODevice::ReadOnly)) {
+        connection->respond(HTTPConnection::StatusCode200, std::move(file), "application/octet-stream");
+    } else {
+        connection->respond(HTTPConnection::StatusCode404, HTTPConnection::StatusCode404);
+    }
+    return true;
 }
 
 void EntityServer::entityFilterAdded(EntityItemID id, bool success) {
@@ -379,6 +575,7 @@ void EntityServer::nodeKilled(SharedNodePointer node) {
     if (tree) {
         tree->deleteDescendantsOfAvatar(node->getUUID());
         tree->forgetAvatarID(node->getUUID());
+        tree->forgetEditSender(node->getUUID());
     }
     OctreeServer::nodeKilled(node);
 }
@@ -415,6 +612,25 @@ QString EntityServer::serverSubclassStats() {
     statsString += QString().sprintf("       EntityItem size... %ld bytes\r\n", sizeof(EntityItem));
     statsString += "\r\n\r\n";
 
+    quint64 encodingCacheHits = EntityItem::getEncodingCacheHits();
+    quint64 encodingCacheMisses = EntityItem::getEncodingCacheMisses();
+    quint64 encodingCacheLookups = encodingCacheHits + encodingCacheMisses;
+    statsString += "<b>Entity Encoding Cache</b>\r\n";
+    statsString += QString("          hits... %1\r\n").arg(locale.toString(encodingCacheHits));
+    statsString += QString("        misses... %1\r\n").arg(locale.toString(encodingCacheMisses));
+    statsString += QString("      hit rate... %1%\r\n")
+        .arg(encodingCacheLookups > 0 ? (100.0 * encodingCacheHits) / encodingCacheLookups : 0.0, 0, 'f', 1);
+    statsString += "\r\n\r\n";
+
+    auto sceneBundle = getSceneBundle();
+    if (sceneBundle) {
+        statsString += "<b>Scene Bundle</b>\r\n";
+        statsString += QString("       version... %1\r\n").arg(sceneBundle->version);
+        statsString += QString("      entities... %1\r\n").arg(locale.toString(sceneBundle->entityIDs.size()));
+        statsString += QString("           url... %1\r\n").arg(sceneBundle->url);
+        statsString += "\r\n\r\n";
+    }
+
     statsString += "<b>Entity Server Sending to Viewer Statistics</b>\r\n";
     statsString += "----- Viewer Node ID -----------------    ----- Entity ID ----------------------    "
                    "---------- Last Sent To ----------    ---------- Last Edited -----------\r\n";
@@ -14,14 +14,19 @@
 
 #include "../octree/OctreeServer.h"
 
+#include <QtCore/QSet>
 #include <QtCore/QSharedPointer>
 
+#include <future>
 #include <memory>
+#include <mutex>
+#include <vector>
 
 #include <EntityItem.h>
 #include <EntityTree.h>
 #include <SimpleEntitySimulation.h>
 
+#include "EntityInterestTiers.h"
 #include "EntityServerConsts.h"
 
 /// Handles assignments of type EntityServer - sending entities to various clients.
@@ -54,6 +59,7 @@ public:
 
     virtual void entityCreated(const EntityItem& newEntity, const SharedNodePointer& senderNode) override;
     virtual void readAdditionalConfiguration(const QJsonObject& settingsSectionObject) override;
+    const EntityInterestTiers::Settings& getInterestTierSettings() const { return _interestTierSettings; }
     virtual QString serverSubclassStats() override;
 
     virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, const QUuid& sessionID) override;
@@ -61,6 +67,20 @@ public:
 
     virtual void aboutToFinish() override;
 
+    // a scene bundle written out for clients to download, see EntitySceneBundle
+    struct PublishedSceneBundle {
+        quint64 version;
+        QString filename;
+        QString url;
+        QSet<QUuid> entityIDs;
+    };
+    using PublishedSceneBundlePointer = std::shared_ptr<const PublishedSceneBundle>;
+
+    // the newest scene bundle, if any, which can be called from any thread
+    PublishedSceneBundlePointer getSceneBundle() const;
+    // the scene bundle with the version, if it is recent enough that the entities deleted since are still known
+    PublishedSceneBundlePointer getSceneBundle(quint64 version) const;
+
 public slots:
     virtual void nodeAdded(SharedNodePointer node) override;
     virtual void nodeKilled(SharedNodePointer node) override;
@@ -70,10 +90,12 @@ public slots:
 protected:
     virtual OctreePointer createTree() override;
     virtual UniqueSendThread newSendThread(const SharedNodePointer& node) override;
+    virtual bool handleSubclassHTTPGet(HTTPConnection* connection, const QUrl& url) override;
 
 private slots:
     void handleEntityPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void domainSettingsRequestFailed();
+    void writeSceneBundle();
 
 private:
     SimpleEntitySimulationPointer _entitySimulation;
@@ -87,7 +109,19 @@ private:
     int _MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = DEFAULT_MINIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS;  // 45m
     int _MAXIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS = DEFAULT_MAXIMUM_DYNAMIC_DOMAIN_VERIFICATION_TIMER_MS;  // 1h
     QTimer _dynamicDomainVerificationTimer;
+    EntityInterestTiers::Settings _interestTierSettings;
     void startDynamicDomainVerification();
+
+    QString getSceneBundleDirectory() const;
+    void publishSceneBundle(PublishedSceneBundlePointer bundle, const QByteArray& contentHash);
+
+    QTimer _sceneBundleTimer;
+    QString _sceneBundleURL;
+    float _sceneBundleChunkScale;
+    std::future<void> _sceneBundleWrite;
+    QByteArray _sceneBundleContentHash; // of the newest bundle's chunks, to tell when the scene hasn't changed since
+    mutable std::mutex _sceneBundlesMutex;
+    std::vector<PublishedSceneBundlePointer> _sceneBundles; // oldest first
 };
 
 #endif  // hifi_EntityServer_h
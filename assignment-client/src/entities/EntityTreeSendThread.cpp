@@ -17,6 +17,9 @@
 
 #include "EntityServer.h"
 
+// how long a client that was offered the scene bundle is given to load it before the scene is sent to it as usual
+static const quint64 MAX_SCENE_BUNDLE_LOAD_USECS = 30 * USECS_PER_SECOND;
+
 EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node) :
     OctreeSendThread(myServer, node)
 {
@@ -26,13 +29,76 @@ EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedN
     // connect to connection ID change on EntityNodeData so we can clear state for this receiver
     auto nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
     connect(nodeData, &EntityNodeData::incomingConnectionIDChanged, this, &EntityTreeSendThread::resetState);
+
+    _interestTiers.setSettings(static_cast<EntityServer*>(myServer)->getInterestTierSettings());
+}
+
+QJsonObject EntityTreeSendThread::getClientStats() const {
+    QJsonObject stats;
+    if (_interestTiers.getSettings().isEnabled) {
+        stats["interest_coalesced_updates"] = (double)_interestTiers.getNumCoalescedUpdates();
+        stats["interest_bytes_saved"] = (double)_interestTiers.getBytesSaved();
+        stats["interest_deferred_entities"] = (double)_interestTiers.getNumDeferredEntities();
+    }
+    return stats;
 }
 
 void EntityTreeSendThread::resetState() {
     qCDebug(entities) << "Clearing known EntityTreeSendThread state for" << _nodeUuid;
 
     _knownState.clear();
+    _interestTiers.clear();
     _traversal.reset();
+    _sceneBundleVersion = 0;
+    _sceneBundle.reset();
+    _sceneBundleOfferedAt = 0;
+}
+
+bool EntityTreeSendThread::updateSceneBundle(const SharedNodePointer& node, EntityNodeData& nodeData) {
+    auto versionValue = nodeData.getJSONParameters()[EntityJSONQueryProperties::SCENE_BUNDLE_VERSION_PROPERTY];
+
+    // the bundle leaves private user data out, so a client that can see it is sent everything
+    if (!versionValue.isDouble() || node->getCanGetAndSetPrivateUserData()) {
+        _sceneBundleVersion = 0;
+        _sceneBundle.reset();
+        return false;
+    }
+
+    auto entityServer = static_cast<EntityServer*>(_myServer);
+    qint64 version = (qint64)versionValue.toDouble();
+    if (version == EntityJSONQueryProperties::SCENE_BUNDLE_WANTED) {
+        auto sceneBundle = entityServer->getSceneBundle();
+        if (!sceneBundle) {
+            return false;
+        }
+
+        quint64 now = usecTimestampNow();
+        if (_sceneBundleOfferedAt == 0) {
+            auto offer = NLPacket::create(PacketType::EntitySceneBundle, -1, true);
+            offer->writePrimitive(sceneBundle->version);
+            offer->writeString(sceneBundle->url);
+            DependencyManager::get<NodeList>()->sendPacket(std::move(offer), *node);
+            _sceneBundleOfferedAt = now;
+        }
+        return now - _sceneBundleOfferedAt < MAX_SCENE_BUNDLE_LOAD_USECS;
+    }
+
+    if (version != _sceneBundleVersion) {
+        _sceneBundleVersion = version;
+        _sceneBundle = version > 0 ? entityServer->getSceneBundle((quint64)version) : nullptr;
+        if (_sceneBundle) {
+            // what was deleted since the bundle was written goes out with the next deletions
+            nodeData.setLastDeletedEntitiesSentAt(std::min(nodeData.getLastDeletedEntitiesSentAt(), _sceneBundle->version));
+        } else if (version > 0) {
+            qCDebug(entities) << "Scene bundle" << version << "loaded by" << _nodeUuid << "is too old, sending the scene";
+        }
+    }
+    return false;
+}
+
+bool EntityTreeSendThread::isKnownFromSceneBundle(const EntityItem& entity) const {
+    return _sceneBundle && entity.getLastEdited() <= _sceneBundle->version &&
+        entity.getLastChangedOnServer() <= _sceneBundle->version && _sceneBundle->entityIDs.contains(entity.getID());
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -101,58 +167,93 @@ void EntityTreeSendThread::preDistributionProcessing() {
 
 bool EntityTreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) {
-    if (viewFrustumChanged || _traversal.finished()) {
-        EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
+    if (updateSceneBundle(node, *static_cast<EntityNodeData*>(nodeData))) {
+        return false;
+    }
+
+    // walk the tree under its read lock; the entities found are encoded and sent below without it,
+    // since each entity guards its own properties
+    _myServer->getOctree()->withReadLock([&]{
+        if (viewFrustumChanged || _traversal.finished()) {
+            EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
 
 
-        DiffTraversal::View newView;
-        newView.viewFrustums = nodeData->getCurrentViews();
+            DiffTraversal::View newView;
+            newView.viewFrustums = nodeData->getCurrentViews();
 
-        int32_t lodLevelOffset = nodeData->getBoundaryLevelAdjust() + (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
-        newView.lodScaleFactor = powf(2.0f, lodLevelOffset);
+            int32_t lodLevelOffset = nodeData->getBoundaryLevelAdjust() + (viewFrustumChanged ? LOW_RES_MOVING_ADJUST : NO_BOUNDARY_ADJUST);
+            newView.lodScaleFactor = powf(2.0f, lodLevelOffset);
         
-        startNewTraversal(newView, root, isFullScene);
-
-        // When the viewFrustum changed the sort order may be incorrect, so we re-sort
-        // and also use the opportunity to cull anything no longer in view
-        if (viewFrustumChanged && !_sendQueue.empty()) {
-            EntityPriorityQueue prevSendQueue;
-            std::swap(_sendQueue, prevSendQueue);
-            assert(_sendQueue.empty());
-
-            // Re-add elements from previous traversal if they still need to be sent
-            while (!prevSendQueue.empty()) {
-                EntityItemPointer entity = prevSendQueue.top().getEntity();
-                bool forceRemove = prevSendQueue.top().shouldForceRemove();
-                prevSendQueue.pop();
-                if (entity) {
-                    float priority = PrioritizedEntity::DO_NOT_SEND;
+            // small view changes, like those of a user in an HMD every frame, carry on with the traversal in progress
+            // rather than starting over from the root
+            bool continuedTraversal = viewFrustumChanged && !isFullScene && _traversal.continueWithView(newView);
+            if (!continuedTraversal) {
+                startNewTraversal(newView, root, isFullScene);
+            }
 
-                    if (forceRemove) {
-                        priority = PrioritizedEntity::FORCE_REMOVE;
-                    } else {
-                        const auto& view = _traversal.getCurrentView();
-                        priority = view.computePriority(entity);
-                    }
+            // When the viewFrustum changed the sort order may be incorrect, so we re-sort
+            // and also use the opportunity to cull anything no longer in view.
+            // While a traversal continues, only once the view has moved enough to change priorities noticeably.
+            const float MAX_UNSORTED_VIEW_DISTANCE = 0.25f; // meters
+            const float MAX_UNSORTED_VIEW_ANGLE = 0.0873f; // radians, 5 degrees
+            bool shouldResort = !continuedTraversal ||
+                !_sortedView.isNear(newView, MAX_UNSORTED_VIEW_DISTANCE, MAX_UNSORTED_VIEW_ANGLE);
+            if (viewFrustumChanged && shouldResort) {
+                _sortedView = newView;
+            }
+            if (viewFrustumChanged) {
+                _interestTiers.setViews(newView.viewFrustums);
+            }
+            if (viewFrustumChanged && shouldResort && !_sendQueue.empty()) {
+                EntityPriorityQueue prevSendQueue;
+                std::swap(_sendQueue, prevSendQueue);
+                assert(_sendQueue.empty());
+
+                // Re-add elements from previous traversal if they still need to be sent
+                while (!prevSendQueue.empty()) {
+                    EntityItemPointer entity = prevSendQueue.top().getEntity();
+                    bool forceRemove = prevSendQueue.top().shouldForceRemove();
+                    prevSendQueue.pop();
+                    if (entity) {
+                        float priority = PrioritizedEntity::DO_NOT_SEND;
 
-                    if (priority != PrioritizedEntity::DO_NOT_SEND) {
-                        _sendQueue.emplace(entity, priority, forceRemove);
+                        if (forceRemove) {
+                            priority = PrioritizedEntity::FORCE_REMOVE;
+                        } else {
+                            const auto& view = _traversal.getCurrentView();
+                            priority = view.computePriority(entity);
+                        }
+
+                        if (priority != PrioritizedEntity::DO_NOT_SEND) {
+                            _sendQueue.emplace(entity, priority, forceRemove);
+                        }
                     }
                 }
             }
         }
-    }
 
-    if (!_traversal.finished()) {
-        quint64 startTime = usecTimestampNow();
+        if (!_traversal.finished()) {
+            quint64 startTime = usecTimestampNow();
 
-        #ifdef DEBUG
-        const uint64_t TIME_BUDGET = 400; // usec
-        #else
-        const uint64_t TIME_BUDGET = 200; // usec
-        #endif
-        _traversal.traverse(TIME_BUDGET);
-        OctreeServer::trackTreeTraverseTime((float)(usecTimestampNow() - startTime));
+            #ifdef DEBUG
+            const uint64_t TIME_BUDGET = 400; // usec
+            #else
+            const uint64_t TIME_BUDGET = 200; // usec
+            #endif
+            _traversal.traverse(TIME_BUDGET);
+            OctreeServer::trackTreeTraverseTime((float)(usecTimestampNow() - startTime));
+        }
+    });
+
+    // the edits held back for far away entities go out once their region's interval is up
+    uint64_t now = usecTimestampNow();
+    _interestTiers.classify(now);
+    std::vector<EntityItemPointer> dueEntities;
+    _interestTiers.takeDueEntities(now, dueEntities);
+    for (const auto& entity : dueEntities) {
+        if (!_sendQueue.contains(entity.get()) && _knownState.find(entity.get()) != _knownState.end()) {
+            _sendQueue.emplace(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY);
+        }
     }
 
     bool sendComplete = OctreeSendThread::traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
@@ -241,12 +342,17 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
         case DiffTraversal::First:
             // When we get to a First traversal, clear the _knownState
             _knownState.clear();
+            _interestTiers.clear();
             _traversal.setScanCallback([this](DiffTraversal::VisibleElement& next) {
                 next.element->forEachEntity([&](EntityItemPointer entity) {
                     // Bail early if we've already checked this entity this frame
                     if (_sendQueue.contains(entity.get())) {
                         return;
                     }
+                    if (isKnownFromSceneBundle(*entity)) {
+                        _knownState[entity.get()] = _sceneBundle->version;
+                        return;
+                    }
                     const auto& view = _traversal.getCurrentView();
                     float priority = view.computePriority(entity);
 
@@ -269,11 +375,16 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
 
                         auto knownTimestamp = _knownState.find(entity.get());
                         if (knownTimestamp == _knownState.end()) {
+                            if (isKnownFromSceneBundle(*entity)) {
+                                _knownState[entity.get()] = _sceneBundle->version;
+                                return;
+                            }
                             const auto& view = _traversal.getCurrentView();
                             priority = view.computePriority(entity);
 
-                        } else if (entity->getLastEdited() > knownTimestamp->second ||
-                                   entity->getLastChangedOnServer() > knownTimestamp->second) {
+                        } else if ((entity->getLastEdited() > knownTimestamp->second ||
+                                    entity->getLastChangedOnServer() > knownTimestamp->second) &&
+                                   !_interestTiers.defer(entity, usecTimestampNow())) {
                             // it is known and it changed --> put it on the queue with any priority
                             // TODO: sort these correctly
                             priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
@@ -298,11 +409,16 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
 
                     auto knownTimestamp = _knownState.find(entity.get());
                     if (knownTimestamp == _knownState.end()) {
+                        if (isKnownFromSceneBundle(*entity)) {
+                            _knownState[entity.get()] = _sceneBundle->version;
+                            return;
+                        }
                         const auto& view = _traversal.getCurrentView();
                         priority = view.computePriority(entity);
 
-                    } else if (entity->getLastEdited() > knownTimestamp->second ||
-                               entity->getLastChangedOnServer() > knownTimestamp->second) {
+                    } else if ((entity->getLastEdited() > knownTimestamp->second ||
+                                entity->getLastChangedOnServer() > knownTimestamp->second) &&
+                               !_interestTiers.defer(entity, usecTimestampNow())) {
                         // it is known and it changed --> put it on the queue with any priority
                         // TODO: sort these correctly
                         priority = PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY;
@@ -317,7 +433,11 @@ void EntityTreeSendThread::startNewTraversal(const DiffTraversal::View& view, En
     }
 }
 
-bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) {
+bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonQuery) {
+    // the scene bundle version is no filter
+    QJsonObject jsonFilters = jsonQuery;
+    jsonFilters.remove(EntityJSONQueryProperties::SCENE_BUNDLE_VERSION_PROPERTY);
+
     if (_sendQueue.empty()) {
         params.stopReason = EncodeBitstreamParams::FINISHED;
         OctreeServer::trackEncodeTime(OctreeServer::SKIP_TIME);
@@ -338,12 +458,14 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
         _packetData.appendValue(zeroByte); // colors
         if (params.includeExistsBits) {
             uint8_t childrenExistBits = 0;
-            EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
-            for (int32_t i = 0; i < NUMBER_OF_CHILDREN; ++i) {
-                if (root->getChildAtIndex(i)) {
-                    childrenExistBits += (1 << i);
+            _myServer->getOctree()->withReadLock([&]{
+                EntityTreeElementPointer root = std::dynamic_pointer_cast<EntityTreeElement>(_myServer->getOctree()->getRoot());
+                for (int32_t i = 0; i < NUMBER_OF_CHILDREN; ++i) {
+                    if (root->getChildAtIndex(i)) {
+                        childrenExistBits += (1 << i);
+                    }
                 }
-            }
+            });
             _packetData.appendValue(childrenExistBits); // childrenInTreeMask
         }
         _packetData.appendValue(zeroByte); // childrenInBufferMask
@@ -367,6 +489,7 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
         EntityItemPointer entity = queuedItem.getEntity();
         if (entity) {
             const QUuid& entityID = entity->getID();
+            int encodedBytes = 0;
             // Only send entities that match the jsonFilters, but keep track of everything we've tried to send so we don't try to send it again;
             // also send if we previously matched since this represents change to a matched item.
             bool entityMatchesFilters = entity->matchesJSONFilters(jsonFilters);
@@ -377,7 +500,9 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
                     // Record explicitly filtered-in entity so that extra entities can be flagged.
                     entityNodeData->insertSentFilteredEntity(entityID);
                 }
+                int bytesBefore = _packetData.getUncompressedSize();
                 OctreeElement::AppendState appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData, entityNode->getCanGetAndSetPrivateUserData());
+                encodedBytes = _packetData.getUncompressedSize() - bytesBefore;
 
                 if (appendEntityState != OctreeElement::COMPLETED) {
                     if (appendEntityState == OctreeElement::PARTIAL) {
@@ -394,8 +519,10 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
             }
             if (queuedItem.shouldForceRemove()) {
                 _knownState.erase(entity.get());
+                _interestTiers.forget(entity.get());
             } else {
                 _knownState[entity.get()] = sendTime;
+                _interestTiers.entitySent(entity.get(), sendTime, encodedBytes);
             }
         }
         _sendQueue.pop();
@@ -427,7 +554,7 @@ void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity)
             // We can force a removal from _knownState if the current view is used and entity is out of view
             if (priority == PrioritizedEntity::DO_NOT_SEND) {
                 _sendQueue.emplace(entity, PrioritizedEntity::FORCE_REMOVE, true);
-            } else if (priority == PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY) {
+            } else if (priority == PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY && !_interestTiers.defer(entity, usecTimestampNow())) {
                 _sendQueue.emplace(entity, PrioritizedEntity::WHEN_IN_DOUBT_PRIORITY, true);
             }
         }
@@ -436,4 +563,5 @@ void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity)
 
 void EntityTreeSendThread::deletingEntityPointer(EntityItem* entity) {
     _knownState.erase(entity);
+    _interestTiers.forget(entity);
 }
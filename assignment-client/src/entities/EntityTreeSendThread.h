@@ -20,6 +20,9 @@
 #include <EntityPriorityQueue.h>
 #include <shared/ConicalViewFrustum.h>
 
+#include "EntityInterestTiers.h"
+#include "EntityServer.h"
+
 
 class EntityNodeData;
 class EntityItem;
@@ -30,6 +33,8 @@ class EntityTreeSendThread : public OctreeSendThread {
 public:
     EntityTreeSendThread(OctreeServer* myServer, const SharedNodePointer& node);
 
+    QJsonObject getClientStats() const override;
+
 protected:
     bool traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
             bool viewFrustumChanged, bool isFullScene) override;
@@ -42,6 +47,12 @@ private:
     bool addAncestorsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
     bool addDescendantsToExtraFlaggedEntities(const QUuid& filteredEntityID, EntityItem& entityItem, EntityNodeData& nodeData);
 
+    // offers the server's scene bundle to a client that can load one, and returns whether the client is still loading it,
+    // in which case nothing is sent to it yet
+    bool updateSceneBundle(const SharedNodePointer& node, EntityNodeData& nodeData);
+    // whether the entity is known to the client from the scene bundle it loaded, as it hasn't changed since
+    bool isKnownFromSceneBundle(const EntityItem& entity) const;
+
     void startNewTraversal(const DiffTraversal::View& viewFrustum, EntityTreeElementPointer root, bool forceFirstPass = false);
     bool traverseTreeAndBuildNextPacketPayload(EncodeBitstreamParams& params, const QJsonObject& jsonFilters) override;
 
@@ -50,8 +61,14 @@ private:
     bool shouldStartNewTraversal(OctreeQueryNode* nodeData, bool viewFrustumChanged) override { return viewFrustumChanged || _traversal.finished(); }
 
     DiffTraversal _traversal;
+    DiffTraversal::View _sortedView; // the view _sendQueue was last sorted for
     EntityPriorityQueue _sendQueue;
     std::unordered_map<EntityItem*, uint64_t> _knownState;
+    EntityInterestTiers _interestTiers;
+
+    qint64 _sceneBundleVersion { 0 }; // as the client last reported it
+    EntityServer::PublishedSceneBundlePointer _sceneBundle; // the one the client loaded, if the server still has it
+    quint64 _sceneBundleOfferedAt { 0 };
 
     // packet construction stuff
     EntityTreeElementExtraEncodeDataPointer _extraEncodeData { new EntityTreeElementExtraEncodeData() };
@@ -10,10 +10,14 @@
 //
 
 #include <BuildInfo.h>
+#include <MemoryAccounting.h>
 #include <SharedUtil.h>
 
 #include "AssignmentClientApp.h"
 
+// accounts heap allocations to the subsystems making them, for the assignment stats
+MEMORY_ACCOUNTING_HOOKS()
+
 int main(int argc, char* argv[]) {
     setupHifiApplication(BuildInfo::ASSIGNMENT_CLIENT_NAME);
 
@@ -17,10 +17,13 @@
 #include <LogHandler.h>
 #include <MessagesClient.h>
 #include <NodeList.h>
+#include <NumericalConstants.h>
+#include <PerformanceCounters.h>
 #include <udt/PacketHeaders.h>
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
 const int MESSAGES_MIXER_RATE_LIMITER_INTERVAL = 1000; // 1 second
+const int MESSAGES_MIXER_SEND_INTERVAL = 10; // messages to each node are batched this long
 
 MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(message)
 {
@@ -35,20 +38,21 @@ MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(mess
 }
 
 void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
-    for (auto& channel : _channelSubscribers) {
-        channel.remove(killedNode->getUUID());
+    auto nodeUUID = killedNode->getUUID();
+    for (const auto& channel : _nodeChannels.take(nodeUUID)) {
+        auto subscribers = _channelSubscribers.find(channel);
+        if (subscribers != _channelSubscribers.end()) {
+            subscribers->remove(nodeUUID);
+            if (subscribers->isEmpty()) {
+                _channelSubscribers.erase(subscribers);
+            }
+        }
     }
+    _pendingMessages.remove(nodeUUID);
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    QUuid senderID;
-    bool isText;
     auto senderUUID = senderNode->getUUID();
-    MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
-
-    auto nodeList = DependencyManager::get<NodeList>();
 
     auto itr = _allSubscribers.find(senderUUID);
     if (itr == _allSubscribers.end()) {
@@ -59,15 +63,52 @@ void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessa
         *itr += 1;
     }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    while (receivedMessage->getBytesLeftToRead() > 0) {
+        QString channel, message;
+        QByteArray data;
+        QUuid senderID;
+        bool isText;
+        MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+
+        // a runaway script can flood a channel from many nodes at once
+        auto& channelStats = _channelStats[channel];
+        auto& channelMessageCount = _channelMessageCounts[channel];
+        if (channelMessageCount >= _maxChannelMessagesPerSecond) {
+            ++channelStats.dropped;
+            continue;
+        }
+        ++channelMessageCount;
+
+        auto encodedMessage = MessagesClient::encodeMessage(channel, isText, isText ? message.toUtf8() : data, senderID);
+        ++channelStats.messages;
+        channelStats.bytes += encodedMessage.size();
+
+        auto subscribers = _channelSubscribers.constFind(channel);
+        if (subscribers == _channelSubscribers.constEnd()) {
+            continue;
+        }
+
+        for (const auto& subscriberUUID : *subscribers) {
+            _pendingMessages[subscriberUUID].append(encodedMessage);
+        }
+    }
+}
+
+void MessagesMixer::sendPendingMessages() {
+    if (_pendingMessages.isEmpty()) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (auto it = _pendingMessages.cbegin(); it != _pendingMessages.cend(); ++it) {
+        auto node = nodeList->nodeWithUUID(it.key());
+        if (node && node->getActiveSocket()) {
+            auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+            packetList->write(it.value());
+            nodeList->sendPacketList(std::move(packetList), *node);
+        }
+    }
+    _pendingMessages.clear();
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -75,14 +116,27 @@ void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> mess
     QString channel = QString::fromUtf8(message->getMessage());
 
     _channelSubscribers[channel] << senderUUID;
+    _nodeChannels[senderUUID] << channel;
 }
 
 void MessagesMixer::handleMessagesUnsubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     auto senderUUID = senderNode->getUUID();
     QString channel = QString::fromUtf8(message->getMessage());
 
-    if (_channelSubscribers.contains(channel)) {
-        _channelSubscribers[channel].remove(senderUUID);
+    auto subscribers = _channelSubscribers.find(channel);
+    if (subscribers != _channelSubscribers.end()) {
+        subscribers->remove(senderUUID);
+        if (subscribers->isEmpty()) {
+            _channelSubscribers.erase(subscribers);
+        }
+    }
+
+    auto channels = _nodeChannels.find(senderUUID);
+    if (channels != _nodeChannels.end()) {
+        channels->remove(channel);
+        if (channels->isEmpty()) {
+            _nodeChannels.erase(channels);
+        }
     }
 }
 
@@ -99,6 +153,34 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    // the rates of each channel that had messages since the last stats
+    float seconds = std::max((float)_sinceLastStats.restart() / MSECS_PER_SECOND, 0.001f);
+    static auto& relayedMessages = PerformanceCounters::getInstance().counter("messages_relayed",
+        "Messages relayed to the subscribers of their channel");
+    static auto& droppedMessages = PerformanceCounters::getInstance().counter("messages_dropped",
+        "Messages dropped for going over their channel's rate limit");
+    static auto& subscribedChannels = PerformanceCounters::getInstance().gauge("channels", "Channels with subscribers");
+    subscribedChannels.set(_channelSubscribers.size());
+
+    QJsonObject channelsObject;
+    for (auto it = _channelStats.cbegin(); it != _channelStats.cend(); ++it) {
+        const auto& channelStats = it.value();
+        int numSubscribers = _channelSubscribers.value(it.key()).size();
+        relayedMessages.increment(channelStats.messages);
+        droppedMessages.increment(channelStats.dropped);
+
+        QJsonObject channelObject;
+        channelObject["subscribers"] = numSubscribers;
+        channelObject["messages_per_second"] = channelStats.messages / seconds;
+        channelObject["dropped_per_second"] = channelStats.dropped / seconds;
+        channelObject["inbound_kbps"] = channelStats.bytes / seconds / BYTES_PER_KILOBIT;
+        channelObject["outbound_kbps"] = channelStats.bytes * numSubscribers / seconds / BYTES_PER_KILOBIT;
+        channelsObject[it.key()] = channelObject;
+    }
+    _channelStats.clear();
+
+    statsObject["channels"] = channelsObject;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -111,6 +193,12 @@ void MessagesMixer::run() {
     ThreadedAssignment::commonInit(MESSAGES_MIXER_LOGGING_NAME, NodeType::MessagesMixer);
 
     startMaxMessagesProcessor();
+
+    _sendTimer = new QTimer(this);
+    connect(_sendTimer, &QTimer::timeout, this, &MessagesMixer::sendPendingMessages);
+    _sendTimer->start(MESSAGES_MIXER_SEND_INTERVAL);
+
+    _sinceLastStats.start();
 }
 
 void MessagesMixer::domainSettingsRequestComplete() {
@@ -127,10 +215,15 @@ void MessagesMixer::parseDomainServerSettings(const QJsonObject& domainSettings)
     const QString NODE_MESSAGES_PER_SECOND_KEY = "max_node_messages_per_second";
     QJsonValue maxMessagesPerSecondValue = messagesMixerGroupObject.value(NODE_MESSAGES_PER_SECOND_KEY);
     _maxMessagesPerSecond = maxMessagesPerSecondValue.toInt(DEFAULT_NODE_MESSAGES_PER_SECOND);
+
+    const QString CHANNEL_MESSAGES_PER_SECOND_KEY = "max_channel_messages_per_second";
+    QJsonValue maxChannelMessagesPerSecondValue = messagesMixerGroupObject.value(CHANNEL_MESSAGES_PER_SECOND_KEY);
+    _maxChannelMessagesPerSecond = maxChannelMessagesPerSecondValue.toInt(DEFAULT_CHANNEL_MESSAGES_PER_SECOND);
 }
 
 void MessagesMixer::processMaxMessagesContainer() {
     _allSubscribers.clear();
+    _channelMessageCounts.clear();
 }
 
 void MessagesMixer::startMaxMessagesProcessor() {
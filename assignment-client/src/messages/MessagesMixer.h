@@ -15,6 +15,7 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QSharedPointer>
 
 #include <ThreadedAssignment.h>
@@ -41,14 +42,33 @@ private slots:
     void stopMaxMessagesProcessor();
     void processMaxMessagesContainer();
 
+    void sendPendingMessages();
+
 private:
+    struct ChannelStats {
+        int messages { 0 };
+        qint64 bytes { 0 };
+        int dropped { 0 };
+    };
+
     QHash<QString, QSet<QUuid>> _channelSubscribers;
+    QHash<QUuid, QSet<QString>> _nodeChannels;
     QHash<QUuid, int> _allSubscribers;
+    QHash<QString, int> _channelMessageCounts;
+
+    // the messages relayed since the last send, batched per destination
+    QHash<QUuid, QByteArray> _pendingMessages;
+
+    QHash<QString, ChannelStats> _channelStats;
+    QElapsedTimer _sinceLastStats;
 
     const int DEFAULT_NODE_MESSAGES_PER_SECOND = 1000;
+    const int DEFAULT_CHANNEL_MESSAGES_PER_SECOND = 5000;
     int _maxMessagesPerSecond { 0 };
+    int _maxChannelMessagesPerSecond { DEFAULT_CHANNEL_MESSAGES_PER_SECOND };
 
     QTimer* _maxMessagesTimer { nullptr };
+    QTimer* _sendTimer { nullptr };
 };
 
 #endif // hifi_MessagesMixer_h
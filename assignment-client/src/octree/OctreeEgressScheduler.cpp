@@ -0,0 +1,108 @@
+//
+//  OctreeEgressScheduler.cpp
+//  assignment-client/src/octree
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEgressScheduler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <udt/Constants.h>
+
+// a client that sent less than it could is given room to grow by this much before it has to ask for more
+static const int DEMAND_HEADROOM_BYTES = 2 * udt::MAX_PACKET_SIZE;
+
+void OctreeEgressScheduler::setCapacity(int bytesPerInterval) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _capacity = std::max(0, bytesPerInterval);
+    _needsAllocation = true;
+}
+
+void OctreeEgressScheduler::setWeights(int liveWeight, int sceneLoadWeight) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _liveWeight = std::max(1, liveWeight);
+    _sceneLoadWeight = std::max(1, sceneLoadWeight);
+    _needsAllocation = true;
+}
+
+int OctreeEgressScheduler::beginInterval(const QUuid& clientID, uint64_t intervalIndex, Traffic traffic, int maxBytes,
+                                         int bytesSentLastInterval, bool wasLimited) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_capacity == 0) {
+        return maxBytes;
+    }
+
+    auto client = _clients.find(clientID);
+    if (client == _clients.end()) {
+        client = _clients.insert(clientID, Client());
+        _needsAllocation = true;
+    }
+    client->traffic = traffic;
+    client->wasLimited = wasLimited;
+    client->demand = wasLimited ? maxBytes : std::min(maxBytes, bytesSentLastInterval + DEMAND_HEADROOM_BYTES);
+
+    // the first thread into an interval shares it out for everyone, on what they asked for last
+    if (_needsAllocation || intervalIndex != _allocatedInterval) {
+        _allocatedInterval = intervalIndex;
+        _needsAllocation = false;
+        allocate();
+    }
+    return std::min(client->allocation, maxBytes);
+}
+
+void OctreeEgressScheduler::removeClient(const QUuid& clientID) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_clients.remove(clientID) > 0) {
+        _needsAllocation = true;
+    }
+}
+
+OctreeEgressScheduler::Stats OctreeEgressScheduler::getStats() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    Stats stats;
+    for (const auto& client : _clients) {
+        ++stats.numClients;
+        if (client.traffic == Traffic::SceneLoad) {
+            ++stats.numSceneLoadClients;
+        }
+        if (client.wasLimited) {
+            ++stats.numLimitedClients;
+        }
+        stats.allocatedBytes += client.allocation;
+    }
+    return stats;
+}
+
+void OctreeEgressScheduler::allocate() {
+    struct Share {
+        Client* client;
+        int weight;
+    };
+    std::vector<Share> shares;
+    shares.reserve(_clients.size());
+    int64_t totalWeight = 0;
+    for (auto& client : _clients) {
+        int weight = client.traffic == Traffic::Live ? _liveWeight : _sceneLoadWeight;
+        shares.push_back({ &client, weight });
+        totalWeight += weight;
+    }
+
+    // fill up the clients that want the least for their weight first, so whatever they leave goes to the rest
+    std::sort(shares.begin(), shares.end(), [](const Share& a, const Share& b) {
+        return (int64_t)a.client->demand * b.weight < (int64_t)b.client->demand * a.weight;
+    });
+    int64_t remaining = _capacity;
+    for (auto& share : shares) {
+        int64_t fairShare = remaining * share.weight / totalWeight;
+        share.client->allocation = (int)std::min((int64_t)share.client->demand, fairShare);
+        remaining -= share.client->allocation;
+        totalWeight -= share.weight;
+    }
+}
@@ -0,0 +1,71 @@
+//
+//  OctreeEgressScheduler.h
+//  assignment-client/src/octree
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeEgressScheduler_h
+#define hifi_OctreeEgressScheduler_h
+
+#include <cstdint>
+#include <mutex>
+
+#include <QtCore/QHash>
+#include <QtCore/QUuid>
+
+/// Shares the octree server's egress link between the send threads of its clients.
+/// Every send interval the capacity is split by weighted max-min fairness over what each client asked for at the start of
+/// its last interval: a client that wants less than its share gets what it wants and the rest goes to the others, in
+/// proportion to their weights. Clients with their scene in view only need the live edits, and are weighted above the
+/// ones still loading a scene, so that a few new arrivals can't starve everyone else's updates.
+class OctreeEgressScheduler {
+public:
+    enum class Traffic { Live, SceneLoad };
+
+    static const int DEFAULT_LIVE_WEIGHT = 4;
+    static const int DEFAULT_SCENE_LOAD_WEIGHT = 1;
+
+    /// the bytes per interval shared out, 0 for no cap
+    void setCapacity(int bytesPerInterval);
+    int getCapacity() const { return _capacity; }
+    void setWeights(int liveWeight, int sceneLoadWeight);
+
+    /// Called by a send thread at the start of its interval, with the most it could send in it and whether it ran out
+    /// of budget with more to send in the last one. Returns the bytes it may send in this interval.
+    int beginInterval(const QUuid& clientID, uint64_t intervalIndex, Traffic traffic, int maxBytes,
+                      int bytesSentLastInterval, bool wasLimited);
+    void removeClient(const QUuid& clientID);
+
+    struct Stats {
+        int numClients { 0 };
+        int numSceneLoadClients { 0 };
+        int numLimitedClients { 0 };
+        int allocatedBytes { 0 };
+    };
+    Stats getStats() const;
+
+private:
+    struct Client {
+        Traffic traffic { Traffic::Live };
+        int demand { 0 };
+        int allocation { 0 };
+        bool wasLimited { false };
+    };
+
+    void allocate();
+
+    mutable std::mutex _mutex;
+    QHash<QUuid, Client> _clients;
+    uint64_t _allocatedInterval { 0 };
+    bool _needsAllocation { true };
+    int _capacity { 0 };
+    int _liveWeight { DEFAULT_LIVE_WEIGHT };
+    int _sceneLoadWeight { DEFAULT_SCENE_LOAD_WEIGHT };
+};
+
+#endif // hifi_OctreeEgressScheduler_h
@@ -11,17 +11,26 @@
 
 #include "OctreeInboundPacketProcessor.h"
 
+#include <algorithm>
 #include <limits>
 
 #include <NumericalConstants.h>
+#include <ParallelFor.h>
 #include <udt/PacketHeaders.h>
 #include <PerfStat.h>
+#include <PerformanceCounters.h>
+#include <PortableHighResolutionClock.h>
 
 #include "OctreeServer.h"
 #include "OctreeServerConsts.h"
 
 static QUuid DEFAULT_NODE_ID_REF;
 const quint64 TOO_LONG_SINCE_LAST_NACK = 1 * USECS_PER_SECOND;
+const size_t MIN_EDITS_PER_VALIDATION_CHUNK = 16;
+// a batch applied under one write lock is short enough not to hold up the senders for long
+const size_t MAX_EDITS_PER_WRITE_LOCK = 256;
+
+using namespace std::chrono;
 
 OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServer) :
     _myServer(myServer),
@@ -31,6 +40,7 @@ OctreeInboundPacketProcessor::OctreeInboundPacketProcessor(OctreeServer* myServe
     _totalLockWaitTime(0),
     _totalElementsInPacket(0),
     _totalPackets(0),
+    _totalQueueLatency(0),
     _lastNackTime(usecTimestampNow()),
     _shuttingDown(false)
 {
@@ -42,6 +52,7 @@ void OctreeInboundPacketProcessor::resetStats() {
     _totalLockWaitTime = 0;
     _totalElementsInPacket = 0;
     _totalPackets = 0;
+    _totalQueueLatency = 0;
     _lastNackTime = usecTimestampNow();
 
     QWriteLocker locker(&_senderStatsLock);
@@ -178,6 +189,7 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                     _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
             });
             quint64 endProcess = usecTimestampNow();
+            trackQueueLatency(*message);
 
             if (debugProcessPacket) {
                 qDebug() << "OctreeInboundPacketProcessor::processPacket() after processEditPacketData()..."
@@ -225,6 +237,167 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
     }
 }
 
+void OctreeInboundPacketProcessor::processPackets(std::list<NodeSharedReceivedMessagePair>& packets) {
+    if (!_myServer->wantsParallelEdits()) {
+        ReceivedPacketProcessor::processPackets(packets);
+        return;
+    }
+
+    auto tree = _myServer->getOctree();
+    auto packet = packets.begin();
+    while (packet != packets.end()) {
+        // the runs of packets with edits the tree can prepare go through together, anything in between keeps its place
+        auto endOfRun = packet;
+        while (endOfRun != packets.end() && endOfRun->first && tree->canPrepareEditPacketType(endOfRun->second->getType())) {
+            ++endOfRun;
+        }
+
+        if (endOfRun == packet) {
+            processPacket(packet->second, packet->first);
+            _lastWindowProcessedPackets++;
+            midProcess();
+            ++packet;
+        } else {
+            processPreparedEdits(packet, endOfRun);
+            packet = endOfRun;
+        }
+    }
+}
+
+void OctreeInboundPacketProcessor::processPreparedEdits(PacketIterator firstPacket, PacketIterator endPacket) {
+    if (_shuttingDown) {
+        qDebug() << "OctreeInboundPacketProcessor::processPreparedEdits() while shutting down... ignoring incoming packets";
+        return;
+    }
+
+    struct PreparedPacket {
+        SharedNodePointer sendingNode;
+        QSharedPointer<ReceivedMessage> message;
+        unsigned short int sequence { 0 };
+        quint64 transitTime { 0 };
+        quint64 processTime { 0 };
+        quint64 lockWaitTime { 0 };
+        std::vector<Octree::PreparedEditPointer> edits;
+    };
+
+    std::vector<PreparedPacket> preparedPackets;
+    // the packets from each sender are decoded in order, on one thread
+    std::vector<std::vector<size_t>> packetsBySender;
+    QHash<QUuid, size_t> senderIndices;
+    for (auto packet = firstPacket; packet != endPacket; ++packet) {
+        _receivedPacketCount++;
+
+        PreparedPacket preparedPacket;
+        preparedPacket.sendingNode = packet->first;
+        preparedPacket.message = packet->second;
+        preparedPacket.message->readPrimitive(&preparedPacket.sequence);
+
+        quint64 sentAt;
+        preparedPacket.message->readPrimitive(&sentAt);
+        quint64 arrivedAt = usecTimestampNow();
+        preparedPacket.transitTime = sentAt > arrivedAt ? 0 : arrivedAt - sentAt;
+
+        QUuid senderID = preparedPacket.sendingNode->getUUID();
+        auto senderIndex = senderIndices.find(senderID);
+        if (senderIndex == senderIndices.end()) {
+            senderIndex = senderIndices.insert(senderID, packetsBySender.size());
+            packetsBySender.emplace_back();
+        }
+        packetsBySender[senderIndex.value()].push_back(preparedPackets.size());
+        preparedPackets.push_back(std::move(preparedPacket));
+    }
+
+    auto tree = _myServer->getOctree();
+    auto decodePackets = [&](size_t sender) {
+        for (size_t packetIndex : packetsBySender[sender]) {
+            auto& preparedPacket = preparedPackets[packetIndex];
+            auto& message = *preparedPacket.message;
+            quint64 startDecode = usecTimestampNow();
+            while (message.getBytesLeftToRead() > 0) {
+                auto editData = reinterpret_cast<const unsigned char*>(message.getRawMessage() + message.getPosition());
+                auto edit = tree->decodeEdit(message, editData, (int)message.getBytesLeftToRead(), preparedPacket.sendingNode);
+                if (!edit) {
+                    break;
+                }
+                int bytesRead = edit->bytesRead;
+                preparedPacket.edits.push_back(std::move(edit));
+                if (bytesRead <= 0) {
+                    // the rest of the packet can't be made sense of
+                    break;
+                }
+                message.seek(message.getPosition() + bytesRead);
+            }
+            preparedPacket.processTime += usecTimestampNow() - startDecode;
+        }
+    };
+    parallelFor(packetsBySender.size(), 1, [&decodePackets](size_t, size_t begin, size_t end) {
+        for (size_t sender = begin; sender < end; sender++) {
+            decodePackets(sender);
+        }
+    });
+
+    std::vector<Octree::PreparedEdit*> edits;
+    std::vector<size_t> editPackets;
+    for (size_t packetIndex = 0; packetIndex < preparedPackets.size(); packetIndex++) {
+        for (auto& edit : preparedPackets[packetIndex].edits) {
+            edits.push_back(edit.get());
+            editPackets.push_back(packetIndex);
+        }
+    }
+    tree->editsDecoded(edits);
+
+    // the checks of the edits run without the write lock, so the tree can still be read in the meantime
+    std::vector<quint64> validateTimes(edits.size(), 0);
+    parallelFor(edits.size(), MIN_EDITS_PER_VALIDATION_CHUNK, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            quint64 startValidate = usecTimestampNow();
+            tree->validateEdit(*edits[i], preparedPackets[editPackets[i]].sendingNode);
+            validateTimes[i] = usecTimestampNow() - startValidate;
+        }
+    });
+    for (size_t i = 0; i < edits.size(); i++) {
+        preparedPackets[editPackets[i]].processTime += validateTimes[i];
+    }
+
+    for (size_t start = 0; start < edits.size(); start += MAX_EDITS_PER_WRITE_LOCK) {
+        size_t end = std::min(start + MAX_EDITS_PER_WRITE_LOCK, edits.size());
+        quint64 startLock = usecTimestampNow();
+        quint64 lockWaitTime = 0;
+        tree->withWriteLock([&] {
+            lockWaitTime = usecTimestampNow() - startLock;
+            for (size_t i = start; i < end; i++) {
+                auto& preparedPacket = preparedPackets[editPackets[i]];
+                quint64 startApply = usecTimestampNow();
+                tree->applyEdit(*edits[i], *preparedPacket.message, preparedPacket.sendingNode);
+                preparedPacket.processTime += usecTimestampNow() - startApply;
+                trackQueueLatency(*preparedPacket.message);
+            }
+        });
+        // the edits under one lock share its wait
+        for (size_t i = start; i < end; i++) {
+            preparedPackets[editPackets[i]].lockWaitTime += lockWaitTime / (end - start);
+        }
+        midProcess();
+    }
+
+    for (auto& preparedPacket : preparedPackets) {
+        trackInboundPacket(preparedPacket.sendingNode->getUUID(), preparedPacket.sequence, preparedPacket.transitTime,
+                           (int)preparedPacket.edits.size(), preparedPacket.processTime, preparedPacket.lockWaitTime);
+        _lastWindowProcessedPackets++;
+    }
+}
+
+void OctreeInboundPacketProcessor::trackQueueLatency(const ReceivedMessage& message) {
+    static auto& queueLatency = PerformanceCounters::getInstance().histogram("entity_edit_queue_usecs",
+        "Time from the arrival of an edit until it is applied to the octree");
+
+    quint64 now = duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
+    quint64 receivedAt = (quint64)message.getFirstPacketReceiveTime();
+    quint64 latency = now > receivedAt ? now - receivedAt : 0;
+    _totalQueueLatency += latency;
+    queueLatency.record(latency);
+}
+
 void OctreeInboundPacketProcessor::trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int editsInPacket, quint64 processTime, quint64 lockWaitTime) {
 
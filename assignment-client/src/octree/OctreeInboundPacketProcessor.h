@@ -71,6 +71,9 @@ public:
                 { return _totalElementsInPacket == 0 ? 0 : _totalProcessTime / _totalElementsInPacket; }
     quint64 getAverageLockWaitTimePerElement() const
                 { return _totalElementsInPacket == 0 ? 0 : _totalLockWaitTime / _totalElementsInPacket; }
+    // from the arrival of an edit's packet until the edit is applied
+    quint64 getAverageQueueLatencyPerElement() const
+                { return _totalElementsInPacket == 0 ? 0 : _totalQueueLatency / _totalElementsInPacket; }
 
     void resetStats();
 
@@ -81,6 +84,7 @@ public:
 protected:
 
     virtual void processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) override;
+    virtual void processPackets(std::list<NodeSharedReceivedMessagePair>& packets) override;
 
     virtual uint32_t getMaxWait() const override;
     virtual void preProcess() override;
@@ -90,6 +94,10 @@ private:
     int sendNackPackets();
 
 private:
+    using PacketIterator = std::list<NodeSharedReceivedMessagePair>::iterator;
+    void processPreparedEdits(PacketIterator firstPacket, PacketIterator endPacket);
+    void trackQueueLatency(const ReceivedMessage& message);
+
     void trackInboundPacket(const QUuid& nodeUUID, unsigned short int sequence, quint64 transitTime,
             int elementsInPacket, quint64 processTime, quint64 lockWaitTime);
 
@@ -101,6 +109,7 @@ private:
     std::atomic<uint64_t> _totalLockWaitTime;
     std::atomic<uint64_t> _totalElementsInPacket;
     std::atomic<uint64_t> _totalPackets;
+    std::atomic<uint64_t> _totalQueueLatency;
     
     NodeToSenderStatsMap _singleSenderStats;
     QReadWriteLock _senderStatsLock;
@@ -59,6 +59,9 @@ OctreeSendThread::~OctreeSendThread() {
 
     OctreeServer::clientDisconnected();
     OctreeServer::stopTrackingThread(this);
+    if (_myServer) {
+        _myServer->getEgressScheduler().removeClient(_nodeUuid);
+    }
 }
 
 void OctreeSendThread::setIsShuttingDown() {
@@ -317,10 +320,23 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         preDistributionProcessing();
     }
 
+    int bytesSentLastInterval = _trueBytesSent;
     _truePacketsSent = 0;
     _trueBytesSent = 0;
     _packetsSentThisInterval = 0;
 
+    // calculate max number of packets that can be sent during this interval
+    int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
+    int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
+
+    // a client still loading its scene yields to the live updates of the others
+    auto traffic = nodeData->wantReportInitialCompletion() ? OctreeEgressScheduler::Traffic::SceneLoad
+                                                           : OctreeEgressScheduler::Traffic::Live;
+    _bytesAllowedThisInterval = _myServer->getEgressScheduler().beginInterval(_nodeUuid,
+        usecTimestampNow() / OCTREE_SEND_INTERVAL_USECS, traffic, maxPacketsPerInterval * udt::MAX_PACKET_SIZE,
+        bytesSentLastInterval, _wasLimitedLastInterval);
+    _wasLimitedLastInterval = false;
+
     bool isFullScene = nodeData->shouldForceFullScene();
     if (isFullScene) {
         // we're forcing a full scene, clear the force in OctreeQueryNode so we don't force it next time again
@@ -363,9 +379,9 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
 
     quint64 start = usecTimestampNow();
 
-    _myServer->getOctree()->withReadLock([&]{
-        traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
-    });
+    // the traversal takes the tree's read lock itself, only for as long as it walks the tree,
+    // so that encoding and sending packets for this client never holds up edits
+    traverseTreeAndSendContents(node, nodeData, viewFrustumChanged, isFullScene);
 
     // Here's where we can/should allow the server to send other data...
     // send the environment packet
@@ -385,12 +401,9 @@ int OctreeSendThread::packetDistributor(SharedNodePointer node, OctreeQueryNode*
         _totalSpecialBytes += specialBytesSent;
     }
 
-    // calculate max number of packets that can be sent during this interval
-    int clientMaxPacketsPerInterval = std::max(1, (nodeData->getMaxQueryPacketsPerSecond() / INTERVALS_PER_SECOND));
-    int maxPacketsPerInterval = std::min(clientMaxPacketsPerInterval, _myServer->getPacketsPerClientPerInterval());
-
     // Re-send packets that were nacked by the client
-    while (nodeData->hasNextNackedPacket() && _packetsSentThisInterval < maxPacketsPerInterval) {
+    while (nodeData->hasNextNackedPacket() && _packetsSentThisInterval < maxPacketsPerInterval &&
+           _trueBytesSent < _bytesAllowedThisInterval) {
         const NLPacket* packet = nodeData->getNextNackedPacket();
         if (packet) {
             DependencyManager::get<NodeList>()->sendUnreliablePacket(*packet, *node);
@@ -441,7 +454,8 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
 
     bool somethingToSend = true; // assume we have something
     bool hadSomething = hasSomethingToSend(nodeData);
-    while (somethingToSend && _packetsSentThisInterval < maxPacketsPerInterval && !nodeData->isShuttingDown()) {
+    while (somethingToSend && _packetsSentThisInterval < maxPacketsPerInterval &&
+           _trueBytesSent < _bytesAllowedThisInterval && !nodeData->isShuttingDown()) {
         float compressAndWriteElapsedUsec = OctreeServer::SKIP_TIME;
         float packetSendingElapsedUsec = OctreeServer::SKIP_TIME;
 
@@ -503,10 +517,13 @@ bool OctreeSendThread::traverseTreeAndSendContents(SharedNodePointer node, Octre
         OctreeServer::trackInsideTime((float)(usecTimestampNow() - startInside));
     }
 
+    _wasLimitedLastInterval = somethingToSend;
     if (somethingToSend && _myServer->wantsVerboseDebug()) {
         qCDebug(octree) << "Hit PPS Limit, packetsSentThisInterval =" << _packetsSentThisInterval
                         << "  maxPacketsPerInterval = " << maxPacketsPerInterval
-                        << "  clientMaxPacketsPerInterval = " << clientMaxPacketsPerInterval;
+                        << "  clientMaxPacketsPerInterval = " << clientMaxPacketsPerInterval
+                        << "  bytesSentThisInterval = " << _trueBytesSent
+                        << "  bytesAllowedThisInterval = " << _bytesAllowedThisInterval;
     }
 
     return params.stopReason == EncodeBitstreamParams::FINISHED;
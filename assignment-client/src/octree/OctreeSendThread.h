@@ -16,6 +16,8 @@
 
 #include <atomic>
 
+#include <QtCore/QJsonObject>
+
 #include <GenericThread.h>
 #include <Node.h>
 #include <OctreePacketData.h>
@@ -38,6 +40,9 @@ public:
 
     QUuid getNodeUuid() const { return _nodeUuid; }
 
+    /// stats of what was sent to this client in particular, for the server's stats packet
+    virtual QJsonObject getClientStats() const { return QJsonObject(); }
+
     static AtomicUIntStat _totalBytes;
     static AtomicUIntStat _totalWastedBytes;
     static AtomicUIntStat _totalPackets;
@@ -73,6 +78,8 @@ private:
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
+    int _bytesAllowedThisInterval { 0 }; // our share of the server's egress
+    bool _wasLimitedLastInterval { false };
     bool _isShuttingDown { false };
 };
 
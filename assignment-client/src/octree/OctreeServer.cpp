@@ -23,6 +23,7 @@
 #include <LogHandler.h>
 #include <shared/NetworkUtils.h>
 #include <NumericalConstants.h>
+#include <PerformanceCounters.h>
 #include <UUID.h>
 
 #include "../AssignmentClient.h"
@@ -90,6 +91,7 @@ int OctreeServer::_shortProcessWait = 0;
 int OctreeServer::_noProcessWait = 0;
 
 static const QString PERSIST_FILE_DOWNLOAD_PATH = "/models.json.gz";
+static const int HTTP_WORKER_THREADS = 1;
 static const double NANOSECONDS_PER_SECOND = 1000000.0;;
 
 
@@ -285,6 +287,7 @@ void OctreeServer::initHTTPManager(int port) {
 
     // setup an httpManager with us as the request handler and the parent
     _httpManager.reset(new HTTPManager(QHostAddress::AnyIPv4, port, documentRoot, this));
+    _httpManager->setNumWorkerThreads(HTTP_WORKER_THREADS);
 }
 
 bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
@@ -319,9 +322,10 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             showStats = true;
         } else if ((url.path() == PERSIST_FILE_DOWNLOAD_PATH) || (url.path() == PERSIST_FILE_DOWNLOAD_PATH + "/")) {
             if (_persistFileDownload) {
-                QByteArray persistFileContents = getPersistFileContents();
-                if (persistFileContents.length() > 0) {
-                    connection->respond(HTTPConnection::StatusCode200, persistFileContents, qPrintable(getPersistFileMimeType()));
+                // streamed from the HTTP manager's worker threads, so a large file isn't read into memory here
+                auto persistFile = openPersistFile();
+                if (persistFile) {
+                    connection->respond(HTTPConnection::StatusCode200, std::move(persistFile), qPrintable(getPersistFileMimeType()));
                 } else {
                     connection->respond(HTTPConnection::StatusCode500, HTTPConnection::StatusCode500);
                 }
@@ -329,6 +333,8 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
                 connection->respond(HTTPConnection::StatusCode403, HTTPConnection::StatusCode403); // not allowed
             }
             return true;
+        } else if (handleSubclassHTTPGet(connection, url)) {
+            return true;
         }
     }
 
@@ -657,6 +663,7 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
         quint64 averageLockWaitTimePerElement = _octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
         quint64 totalElementsProcessed = _octreeInboundPacketProcessor->getTotalElementsProcessed();
         quint64 totalPacketsProcessed = _octreeInboundPacketProcessor->getTotalPacketsProcessed();
+        quint64 averageQueueLatencyPerElement = _octreeInboundPacketProcessor->getAverageQueueLatencyPerElement();
 
         quint64 averageDecodeTime = _tree->getAverageDecodeTime();
         quint64 averageLookupTime = _tree->getAverageLookupTime();
@@ -692,6 +699,8 @@ bool OctreeServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             .arg(locale.toString((uint)averageProcessTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
         statsString += QString("  Average Wait Lock Time/Element: %1 usecs\r\n")
             .arg(locale.toString((uint)averageLockWaitTimePerElement).rightJustified(COLUMN_WIDTH, ' '));
+        statsString += QString("  Average Queue Latency/Element: %1 usecs\r\n")
+            .arg(locale.toString((uint)averageQueueLatencyPerElement).rightJustified(COLUMN_WIDTH, ' '));
 
         statsString += QString("             Average Decode Time: %1 usecs\r\n")
             .arg(locale.toString((uint)averageDecodeTime).rightJustified(COLUMN_WIDTH, ' '));
@@ -1025,6 +1034,11 @@ void OctreeServer::readConfiguration() {
     readOptionBool(QString("debugTimestampNow"), settingsSectionObject, _debugTimestampNow);
     qDebug() << "debugTimestampNow=" << _debugTimestampNow;
 
+    bool serialEdits;
+    readOptionBool(QString("serialEdits"), settingsSectionObject, serialEdits);
+    _wantParallelEdits = !serialEdits;
+    qDebug() << "wantParallelEdits=" << _wantParallelEdits;
+
     bool noPersist;
     readOptionBool(QString("NoPersist"), settingsSectionObject, noPersist);
     _wantPersist = !noPersist;
@@ -1049,7 +1063,18 @@ void OctreeServer::readConfiguration() {
         qDebug() << "persistFilePath=" << _persistFilePath;
         qDebug() << "persisAbsoluteFilePath=" << _persistAbsoluteFilePath;
 
+        // "bin" persists a binary snapshot, which loads and saves much faster than JSON but is only readable by
+        // the version that wrote it. The domain server and the persist file download still get JSON.
         _persistAsFileType = "json.gz";
+        QString persistFileType;
+        if (readOptionString("persistFileType", settingsSectionObject, persistFileType)) {
+            if (persistFileType == "bin" || persistFileType == "json.gz") {
+                _persistAsFileType = persistFileType;
+            } else {
+                qWarning() << "Ignoring unknown persistFileType" << persistFileType;
+            }
+        }
+        qDebug() << "persistAsFileType=" << _persistAsFileType;
 
         _persistInterval = OctreePersistThread::DEFAULT_PERSIST_INTERVAL;
         int result { -1 };
@@ -1098,6 +1123,20 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondTotalMax=%d _packetsTotalPerInterval=%d",
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
+    // the link the clients share, by default as fast as they each may go
+    int egressCapacityKbps = 0;
+    if (readOptionInt(QString("egressCapacityKbps"), settingsSectionObject, egressCapacityKbps)) {
+        const int BITS_PER_BYTE = 8;
+        _egressScheduler.setCapacity(egressCapacityKbps * 1000 / BITS_PER_BYTE / INTERVALS_PER_SECOND);
+    }
+    int liveUpdateWeight = OctreeEgressScheduler::DEFAULT_LIVE_WEIGHT;
+    int sceneLoadWeight = OctreeEgressScheduler::DEFAULT_SCENE_LOAD_WEIGHT;
+    readOptionInt(QString("egressLiveUpdateWeight"), settingsSectionObject, liveUpdateWeight);
+    readOptionInt(QString("egressSceneLoadWeight"), settingsSectionObject, sceneLoadWeight);
+    _egressScheduler.setWeights(liveUpdateWeight, sceneLoadWeight);
+    qDebug("egressCapacityKbps=%d egressLiveUpdateWeight=%d egressSceneLoadWeight=%d",
+                    egressCapacityKbps, liveUpdateWeight, sceneLoadWeight);
+
 
     readAdditionalConfiguration(settingsSectionObject);
 }
@@ -1470,8 +1509,28 @@ void OctreeServer::sendStatsPacket() {
     QJsonObject dataArray2;
     QJsonObject timingArray2;
 
+    static auto& clients = PerformanceCounters::getInstance().gauge("clients", "Clients being sent octree data");
+    static auto& inboundQueueDepth = PerformanceCounters::getInstance().gauge("inbound_queue_depth",
+        "Edit packets waiting to be applied to the octree");
+    clients.set(getCurrentClientCount());
+
+    static auto& egressAllocated = PerformanceCounters::getInstance().gauge("egress_allocated_kbps",
+        "Egress shared out to the clients in the last send interval");
+    static auto& egressSceneLoads = PerformanceCounters::getInstance().gauge("egress_scene_load_clients",
+        "Clients given the lower egress weight while they load their scene");
+    static auto& egressLimited = PerformanceCounters::getInstance().gauge("egress_limited_clients",
+        "Clients that had more to send than their share of egress");
+    if (_egressScheduler.getCapacity() > 0) {
+        auto egressStats = _egressScheduler.getStats();
+        const int BITS_PER_BYTE = 8;
+        egressAllocated.set((int64_t)egressStats.allocatedBytes * INTERVALS_PER_SECOND * BITS_PER_BYTE / 1000);
+        egressSceneLoads.set(egressStats.numSceneLoadClients);
+        egressLimited.set(egressStats.numLimitedClients);
+    }
+
     // Stats Object 3
     if (_octreeInboundPacketProcessor) {
+        inboundQueueDepth.set(_octreeInboundPacketProcessor->packetsToProcessCount());
         dataArray2["1. packetQueue"] = (double)_octreeInboundPacketProcessor->packetsToProcessCount();
         dataArray2["2. totalPackets"] = (double)_octreeInboundPacketProcessor->getTotalPacketsProcessed();
         dataArray2["3. totalElements"] = (double)_octreeInboundPacketProcessor->getTotalElementsProcessed();
@@ -1481,18 +1540,30 @@ void OctreeServer::sendStatsPacket() {
         timingArray2["3. avgLockWaitTimePerPacket"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerPacket();
         timingArray2["4. avgProcessTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageProcessTimePerElement();
         timingArray2["5. avgLockWaitTimePerElement"] = (double)_octreeInboundPacketProcessor->getAverageLockWaitTimePerElement();
+        timingArray2["6. avgQueueLatencyPerElement"] = (double)_octreeInboundPacketProcessor->getAverageQueueLatencyPerElement();
     }
 
     QJsonObject statsObject3;
     statsObject3["data"] = dataArray2;
     statsObject3["timing"] = timingArray2;
 
+    QJsonObject clientsStats;
+    for (auto& sendThread : _sendThreads) {
+        auto clientStats = sendThread.second->getClientStats();
+        if (!clientStats.isEmpty()) {
+            clientsStats[uuidStringWithoutCurlyBraces(sendThread.first)] = clientStats;
+        }
+    }
+
     // Merge everything
     QJsonObject jsonArray;
     jsonArray["1. misc"] = statsArray1;
     jsonArray["2. octree"] = octreeStats;
     jsonArray["3. outbound"] = statsObject2;
     jsonArray["4. inbound"] = statsObject3;
+    if (!clientsStats.isEmpty()) {
+        jsonArray["5. clients"] = clientsStats;
+    }
 
     QJsonObject statsObject;
     statsObject[QString(getMyServerName()) + "Server"] = jsonArray;
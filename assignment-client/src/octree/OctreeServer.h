@@ -23,6 +23,7 @@
 
 #include <ThreadedAssignment.h>
 
+#include "OctreeEgressScheduler.h"
 #include "OctreePersistThread.h"
 #include "OctreeSendThread.h"
 #include "OctreeServerConsts.h"
@@ -46,6 +47,7 @@ public:
 
     bool wantsDebugSending() const { return _debugSending; }
     bool wantsDebugReceiving() const { return _debugReceiving; }
+    bool wantsParallelEdits() const { return _wantParallelEdits; }
     bool wantsVerboseDebug() const { return _verboseDebug; }
 
     OctreePointer getOctree() { return _tree; }
@@ -57,6 +59,8 @@ public:
     int getPacketsTotalPerInterval() const { return _packetsTotalPerInterval; }
     int getPacketsTotalPerSecond() const { return getPacketsTotalPerInterval() * INTERVALS_PER_SECOND; }
 
+    OctreeEgressScheduler& getEgressScheduler() { return _egressScheduler; }
+
     static int getCurrentClientCount() { return _clientCount; }
     static void clientConnected() { _clientCount++; }
     static void clientDisconnected() { _clientCount--; }
@@ -67,6 +71,7 @@ public:
     QString getPersistFilename() const { return (_persistManager) ? _persistManager->getPersistFilename() : ""; }
     QString getPersistFileMimeType() const { return (_persistManager) ? _persistManager->getPersistFileMimeType() : "text/plain"; }
     QByteArray getPersistFileContents() const { return (_persistManager) ? _persistManager->getPersistFileContents() : QByteArray(); }
+    std::unique_ptr<QIODevice> openPersistFile() const { return (_persistManager) ? _persistManager->openPersistFile() : nullptr; }
 
     // Subclasses must implement these methods
     virtual std::unique_ptr<OctreeQueryNode> createOctreeQueryNode() = 0;
@@ -83,6 +88,8 @@ public:
     virtual bool hasSpecialPacketsToSend(const SharedNodePointer& node) { return false; }
     virtual int sendSpecialPackets(const SharedNodePointer& node, OctreeQueryNode* queryNode, int& packetsSent) { return 0; }
     virtual QString serverSubclassStats() { return QString(); }
+    // lets a subclass serve GET requests for paths of its own on the status server
+    virtual bool handleSubclassHTTPGet(HTTPConnection* connection, const QUrl& url) { return false; }
     virtual void trackSend(const QUuid& dataID, quint64 dataLastEdited, const QUuid& viewerNode) { }
     virtual void trackViewerGone(const QUuid& viewerNode) { }
 
@@ -186,12 +193,14 @@ protected:
     QString _persistAsFileType;
     int _packetsPerClientPerInterval;
     int _packetsTotalPerInterval;
+    OctreeEgressScheduler _egressScheduler;
     OctreePointer _tree; // this IS a reaveraging tree
     bool _wantPersist;
     bool _debugSending;
     bool _debugReceiving;
     bool _debugTimestampNow;
     bool _verboseDebug;
+    bool _wantParallelEdits { true };
     OctreeInboundPacketProcessor* _octreeInboundPacketProcessor;
     OctreePersistThread* _persistManager;
     QThread _persistThread;
@@ -24,6 +24,8 @@
 #include <plugins/CodecPlugin.h>
 #include <plugins/PluginManager.h>
 #include <ResourceManager.h>
+#include <PerformanceCounters.h>
+#include <ScriptProgramCache.h>
 #include <ResourceScriptingInterface.h>
 #include <ScriptCache.h>
 #include <ScriptEngines.h>
@@ -130,7 +132,7 @@ void EntityScriptServer::handleEntityScriptGetStatusPacket(QSharedPointer<Receiv
         replyPacketList->writePrimitive(messageID);
 
         EntityScriptDetails details;
-        if (_entitiesScriptEngine->getEntityScriptDetails(entityID, details)) {
+        if (_entityScriptShards && _entityScriptShards->getEngine(entityID)->getEntityScriptDetails(entityID, details)) {
             replyPacketList->writePrimitive(true);
             replyPacketList->writePrimitive(details.status);
             replyPacketList->writeString(details.errorInfo);
@@ -161,6 +163,36 @@ void EntityScriptServer::handleSettings() {
 
     static const QString MAX_ENTITY_PPS_OPTION = "max_total_entity_pps";
     static const QString ENTITY_PPS_PER_SCRIPT = "entity_pps_per_script";
+    static const QString SCRIPT_ENGINE_SHARDS_OPTION = "script_engine_shards";
+    static const int MAX_SCRIPT_ENGINE_SHARDS = 64;
+    static const QString SOFT_CPU_BUDGET_OPTION = "script_soft_cpu_budget";
+    static const QString HARD_CPU_BUDGET_OPTION = "script_hard_cpu_budget";
+    static const QString MAX_CALLBACK_MSECS_OPTION = "script_max_callback_msecs";
+
+    // the share of its engine's thread an entity script can take before it's throttled, and then stopped
+    ScriptEngine::CPUBudget defaultBudget;
+    _scriptCPUBudget.softLoad = std::max(0.0f,
+        (float)entityScriptServerSettings[SOFT_CPU_BUDGET_OPTION].toDouble(defaultBudget.softLoad));
+    _scriptCPUBudget.hardLoad = std::max(0.0f,
+        (float)entityScriptServerSettings[HARD_CPU_BUDGET_OPTION].toDouble(defaultBudget.hardLoad));
+    _scriptCPUBudget.maxCallbackUsecs = (uint64_t)std::max(0,
+        entityScriptServerSettings[MAX_CALLBACK_MSECS_OPTION].toInt((int)(defaultBudget.maxCallbackUsecs / USECS_PER_MSEC))) * USECS_PER_MSEC;
+    if (_entityScriptShards) {
+        for (const auto& engine : _entityScriptShards->getEngines()) {
+            engine->setCPUBudget(_scriptCPUBudget);
+        }
+    }
+
+    // scripts can't move between engines, so changing the count restarts them all, the entities are sent again
+    int numShards = std::max(1, std::min(entityScriptServerSettings[SCRIPT_ENGINE_SHARDS_OPTION].toInt(1),
+                                         MAX_SCRIPT_ENGINE_SHARDS));
+    if (numShards != _numScriptEngineShards) {
+        qCInfo(entity_script_server) << "Running entity scripts in" << numShards << "script engines";
+        _numScriptEngineShards = numShards;
+        if (_entityScriptShards && !_shuttingDown) {
+            clear();
+        }
+    }
 
     if (!entityScriptServerSettings.contains(MAX_ENTITY_PPS_OPTION) || !entityScriptServerSettings.contains(ENTITY_PPS_PER_SCRIPT)) {
         qWarning() << "Received settings from the domain-server with no max_total_entity_pps or entity_pps_per_script properties.";
@@ -175,7 +207,7 @@ void EntityScriptServer::handleSettings() {
 }
 
 void EntityScriptServer::updateEntityPPS() {
-    int numRunningScripts = _entitiesScriptEngine->getNumRunningEntityScripts();
+    int numRunningScripts = _entityScriptShards ? _entityScriptShards->getNumRunningEntityScripts() : 0;
     int pps;
     if (std::numeric_limits<int>::max() / _entityPPSPerScript < numRunningScripts) {
         qWarning() << QString("Integer multiplication would overflow, clamping to maxint: %1 * %2").arg(numRunningScripts).arg(_entityPPSPerScript);
@@ -236,7 +268,7 @@ void EntityScriptServer::pushLogs() {
 
 void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
 
-    if (_entitiesScriptEngine && _entityViewer.getTree() && !_shuttingDown) {
+    if (_entityScriptShards && _entityViewer.getTree() && !_shuttingDown) {
         auto entityID = QUuid::fromRfc4122(receivedMessage->read(NUM_BYTES_RFC4122_UUID));
 
         auto method = receivedMessage->readString();
@@ -250,7 +282,7 @@ void EntityScriptServer::handleEntityScriptCallMethodPacket(QSharedPointer<Recei
             params << paramString;
         }
 
-        _entitiesScriptEngine->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
+        _entityScriptShards->callEntityScriptMethod(entityID, method, params, senderNode->getUUID());
     }
 }
 
@@ -281,8 +313,8 @@ void EntityScriptServer::run() {
         NodeType::EntityServer, NodeType::MessagesMixer, NodeType::AssetServer
     });
 
-    // Setup Script Engine
-    resetEntitiesScriptEngine();
+    // Setup Script Engines
+    resetEntitiesScriptEngines();
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
     entityScriptingInterface->init();
@@ -444,8 +476,7 @@ void EntityScriptServer::selectAudioFormat(const QString& selectedCodecName) {
     }
 }
 
-void EntityScriptServer::resetEntitiesScriptEngine() {
-    auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
+ScriptEnginePointer EntityScriptServer::createEntitiesScriptEngine(const QString& engineName) {
     auto newEngine = scriptEngineFactory(ScriptEngine::ENTITY_SERVER_SCRIPT, NO_SCRIPT, engineName);
 
     auto webSocketServerConstructorValue = newEngine->newFunction(WebSocketServerClass::constructor);
@@ -461,50 +492,72 @@ void EntityScriptServer::resetEntitiesScriptEngine() {
     connect(newEngine.data(), &ScriptEngine::warningMessage, scriptEngines, &ScriptEngines::onWarningMessage);
     connect(newEngine.data(), &ScriptEngine::infoMessage, scriptEngines, &ScriptEngines::onInfoMessage);
 
-    connect(newEngine.data(), &ScriptEngine::update, this, [this] {
+    connect(newEngine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+
+    newEngine->setCPUBudget(_scriptCPUBudget);
+
+    scriptEngines->runScriptInitializers(newEngine);
+    return newEngine;
+}
+
+void EntityScriptServer::resetEntitiesScriptEngines() {
+    auto engineName = QString("about:Entities %1").arg(++_entitiesScriptEngineCount);
+
+    std::vector<ScriptEnginePointer> engines;
+    for (int i = 0; i < _numScriptEngineShards; ++i) {
+        engines.push_back(createEntitiesScriptEngine(_numScriptEngineShards > 1 ? engineName + "." + QString::number(i) : engineName));
+    }
+
+    // the first engine's frames drive the entity tree for all of them
+    connect(engines.front().data(), &ScriptEngine::update, this, [this] {
         _entityViewer.queryOctree();
         _entityViewer.getTree()->preUpdate();
         _entityViewer.getTree()->update();
     });
 
-    scriptEngines->runScriptInitializers(newEngine);
-    newEngine->runInThread();
-    auto newEngineSP = qSharedPointerCast<EntitiesScriptEngineProvider>(newEngine);
-    // On the entity script server, these are the same
-    DependencyManager::get<EntityScriptingInterface>()->setPersistentEntitiesScriptEngine(newEngineSP);
-    DependencyManager::get<EntityScriptingInterface>()->setNonPersistentEntitiesScriptEngine(newEngineSP);
+    for (const auto& engine : engines) {
+        engine->runInThread();
+    }
 
-    if (_entitiesScriptEngine) {
-        disconnect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-                   this, &EntityScriptServer::updateEntityPPS);
+    if (_entityScriptShards) {
+        for (const auto& engine : _entityScriptShards->getEngines()) {
+            disconnect(engine.data(), &ScriptEngine::entityScriptDetailsUpdated, this, &EntityScriptServer::updateEntityPPS);
+        }
     }
+    _entityScriptShards = QSharedPointer<EntityScriptShards>::create(std::move(engines));
 
-    _entitiesScriptEngine.swap(newEngine);
-    connect(_entitiesScriptEngine.data(), &ScriptEngine::entityScriptDetailsUpdated,
-            this, &EntityScriptServer::updateEntityPPS);
+    // On the entity script server, these are the same
+    DependencyManager::get<EntityScriptingInterface>()->setPersistentEntitiesScriptEngine(_entityScriptShards);
+    DependencyManager::get<EntityScriptingInterface>()->setNonPersistentEntitiesScriptEngine(_entityScriptShards);
 }
 
 
 void EntityScriptServer::clear() {
-    // unload and stop the engine
-    if (_entitiesScriptEngine) {
+    // unload and stop the engines
+    if (_entityScriptShards) {
         // do this here (instead of in deleter) to avoid marshalling unload signals back to this thread
-        _entitiesScriptEngine->unloadAllEntityScripts();
-        _entitiesScriptEngine->stop();
-        _entitiesScriptEngine->waitTillDoneRunning();
+        for (const auto& engine : _entityScriptShards->getEngines()) {
+            engine->unloadAllEntityScripts();
+            engine->stop();
+        }
+        for (const auto& engine : _entityScriptShards->getEngines()) {
+            engine->waitTillDoneRunning();
+        }
     }
 
     _entityViewer.clear();
 
-    // reset the engine
+    // reset the engines
     if (!_shuttingDown) {
-        resetEntitiesScriptEngine();
+        resetEntitiesScriptEngines();
     }
 }
 
 void EntityScriptServer::shutdownScriptEngine() {
-    if (_entitiesScriptEngine) {
-        _entitiesScriptEngine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+    if (_entityScriptShards) {
+        for (const auto& engine : _entityScriptShards->getEngines()) {
+            engine->disconnectNonEssentialSignals(); // disconnect all slots/signals from the script engine, except essential
+        }
     }
     _shuttingDown = true;
 
@@ -513,9 +566,11 @@ void EntityScriptServer::shutdownScriptEngine() {
     auto scriptEngines = DependencyManager::get<ScriptEngines>();
     scriptEngines->shutdownScripting();
 
-    _entitiesScriptEngine.clear();
-
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    entityScriptingInterface->setPersistentEntitiesScriptEngine(nullptr);
+    entityScriptingInterface->setNonPersistentEntitiesScriptEngine(nullptr);
+    _entityScriptShards.clear();
+
     // our entity tree is going to go away so tell that to the EntityScriptingInterface
     entityScriptingInterface->setEntityTree(nullptr);
 
@@ -531,8 +586,8 @@ void EntityScriptServer::addingEntity(const EntityItemID& entityID) {
 }
 
 void EntityScriptServer::deletingEntity(const EntityItemID& entityID) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
-        _entitiesScriptEngine->unloadEntityScript(entityID, true);
+    if (_entityViewer.getTree() && !_shuttingDown && _entityScriptShards) {
+        _entityScriptShards->getEngine(entityID)->unloadEntityScript(entityID, true);
     }
 }
 
@@ -543,20 +598,21 @@ void EntityScriptServer::entityServerScriptChanging(const EntityItemID& entityID
 }
 
 void EntityScriptServer::checkAndCallPreload(const EntityItemID& entityID, bool forceRedownload) {
-    if (_entityViewer.getTree() && !_shuttingDown && _entitiesScriptEngine) {
+    if (_entityViewer.getTree() && !_shuttingDown && _entityScriptShards) {
+        const auto& scriptEngine = _entityScriptShards->getEngine(entityID);
 
         EntityItemPointer entity = _entityViewer.getTree()->findEntityByEntityItemID(entityID);
         EntityScriptDetails details;
-        bool isRunning = _entitiesScriptEngine->getEntityScriptDetails(entityID, details);
+        bool isRunning = scriptEngine->getEntityScriptDetails(entityID, details);
         if (entity && (forceRedownload || !isRunning || details.scriptText != entity->getServerScripts())) {
             if (isRunning) {
-                _entitiesScriptEngine->unloadEntityScript(entityID, true);
+                scriptEngine->unloadEntityScript(entityID, true);
             }
 
             QString scriptUrl = entity->getServerScripts();
             if (!scriptUrl.isEmpty()) {
                 scriptUrl = DependencyManager::get<ResourceManager>()->normalizeURL(scriptUrl);
-                _entitiesScriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
+                scriptEngine->loadEntityScript(entityID, scriptUrl, forceRedownload);
             }
         }
     }
@@ -573,11 +629,39 @@ void EntityScriptServer::sendStatsPacket() {
 
     QJsonObject scriptEngineStats;
     int numberRunningScripts = 0;
-    const auto scriptEngine = _entitiesScriptEngine;
-    if (scriptEngine) {
-        numberRunningScripts = scriptEngine->getNumRunningEntityScripts();
+    double maxShardLoad = 0.0;
+    double numLongCallbacks = 0.0;
+    const auto scriptShards = _entityScriptShards;
+    if (scriptShards) {
+        numberRunningScripts = scriptShards->getNumRunningEntityScripts();
+
+        auto shards = scriptShards->takeStats();
+        for (const auto& shard : shards) {
+            maxShardLoad = std::max(maxShardLoad, shard.toObject()["load"].toDouble());
+            numLongCallbacks += shard.toObject()["long_callbacks"].toDouble();
+        }
+        scriptEngineStats["shards"] = shards;
     }
     scriptEngineStats["number_running_scripts"] = numberRunningScripts;
+
+    auto programCacheStats = ScriptProgramCache::getInstance().getStats();
+    QJsonObject programCache;
+    programCache["entries"] = programCacheStats.numEntries;
+    programCache["programs"] = programCacheStats.numPrograms;
+    programCache["bytes"] = (double)programCacheStats.bytes;
+    programCache["max_bytes"] = (double)programCacheStats.maxBytes;
+    programCache["hits"] = (double)programCacheStats.hits;
+    programCache["misses"] = (double)programCacheStats.misses;
+    programCache["evictions"] = (double)programCacheStats.evictions;
+    scriptEngineStats["program_cache"] = programCache;
+
+    auto& counters = PerformanceCounters::getInstance();
+    static auto& runningScripts = counters.gauge("running_scripts", "Entity scripts running");
+    static auto& shardLoad = counters.gauge("max_script_engine_load", "Share of time the busiest script engine spent in entity callbacks");
+    static auto& longCallbacks = counters.counter("long_entity_callbacks", "Entity script callbacks that ran longer than 100 ms");
+    runningScripts.set(numberRunningScripts);
+    shardLoad.set(maxShardLoad);
+    longCallbacks.increment((uint64_t)numLongCallbacks);
     statsObject["script_engine_stats"] = scriptEngineStats;
     
 
@@ -25,6 +25,7 @@
 #include <SimpleEntitySimulation.h>
 #include <ThreadedAssignment.h>
 #include "../entities/EntityTreeHeadlessViewer.h"
+#include "EntityScriptShards.h"
 
 class EntityScriptServer : public ThreadedAssignment {
     Q_OBJECT
@@ -62,7 +63,8 @@ private:
     void negotiateAudioFormat();
     void selectAudioFormat(const QString& selectedCodecName);
 
-    void resetEntitiesScriptEngine();
+    ScriptEnginePointer createEntitiesScriptEngine(const QString& engineName);
+    void resetEntitiesScriptEngines();
     void clear();
     void shutdownScriptEngine();
 
@@ -76,7 +78,9 @@ private:
     bool _shuttingDown { false };
 
     static int _entitiesScriptEngineCount;
-    ScriptEnginePointer _entitiesScriptEngine;
+    QSharedPointer<EntityScriptShards> _entityScriptShards;
+    int _numScriptEngineShards { 1 };
+    ScriptEngine::CPUBudget _scriptCPUBudget;
     SimpleEntitySimulationPointer _entitySimulation;
     EntityEditPacketSender _entityEditSender;
     EntityTreeHeadlessViewer _entityViewer;
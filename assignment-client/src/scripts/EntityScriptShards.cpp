@@ -0,0 +1,86 @@
+//
+//  EntityScriptShards.cpp
+//  assignment-client/src/scripts
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityScriptShards.h"
+
+#include <algorithm>
+
+#include <QtCore/QJsonObject>
+
+#include <UUID.h>
+
+// the entity scripts listed with each engine's stats
+static const int MAX_BUSIEST_SCRIPTS = 5;
+
+const ScriptEnginePointer& EntityScriptShards::getEngine(const EntityItemID& entityID) const {
+    return _engines[qHash(entityID) % _engines.size()];
+}
+
+int EntityScriptShards::getNumRunningEntityScripts() const {
+    int numRunningScripts = 0;
+    for (const auto& engine : _engines) {
+        numRunningScripts += engine->getNumRunningEntityScripts();
+    }
+    return numRunningScripts;
+}
+
+void EntityScriptShards::callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                                const QStringList& params, const QUuid& remoteCallerID) {
+    getEngine(entityID)->callEntityScriptMethod(entityID, methodName, params, remoteCallerID);
+}
+
+QFuture<QVariant> EntityScriptShards::getLocalEntityScriptDetails(const EntityItemID& entityID) {
+    return getEngine(entityID)->getLocalEntityScriptDetails(entityID);
+}
+
+QJsonArray EntityScriptShards::takeStats() {
+    auto now = usecTimestampNow();
+    auto elapsed = std::max(now - _lastStatsTime, (quint64)1);
+    _lastStatsTime = now;
+
+    QJsonArray shards;
+    for (const auto& engine : _engines) {
+        auto callbacks = engine->takeEntityCallbackStats();
+
+        QJsonObject shard;
+        shard["running_scripts"] = engine->getNumRunningEntityScripts();
+        shard["load"] = (double)callbacks.busyUsecs / elapsed;
+        shard["callbacks"] = (double)callbacks.numCallbacks;
+        shard["long_callbacks"] = (double)callbacks.numLongCallbacks;
+        shard["longest_callback_usecs"] = (double)callbacks.longestUsecs;
+        if (callbacks.longestUsecs > 0) {
+            shard["longest_callback_entity"] = uuidStringWithoutCurlyBraces(callbacks.longestEntityID);
+        }
+
+        auto timers = engine->takeTimerStats();
+        shard["timers"] = timers.numTimers;
+        shard["timers_fired"] = (double)timers.numFired;
+        shard["timers_rejected"] = (double)timers.numRejected;
+        shard["max_timer_lateness_msecs"] = (double)timers.maxLatenessMsecs;
+
+        // over the last few seconds, rather than since the last stats
+        auto cpu = engine->getCPUStats(MAX_BUSIEST_SCRIPTS);
+        shard["thread_load"] = cpu.engine.load;
+        QJsonArray busiestScripts;
+        for (const auto& script : cpu.entities) {
+            QJsonObject busiestScript;
+            busiestScript["entity"] = uuidStringWithoutCurlyBraces(script.entityID);
+            busiestScript["script"] = script.name;
+            busiestScript["load"] = script.load;
+            busiestScript["longest_callback_usecs"] = (double)script.longestUsecs;
+            busiestScript["throttled"] = script.isThrottled;
+            busiestScripts.append(busiestScript);
+        }
+        shard["busiest_scripts"] = busiestScripts;
+        shards.append(shard);
+    }
+    return shards;
+}
@@ -0,0 +1,48 @@
+//
+//  EntityScriptShards.h
+//  assignment-client/src/scripts
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityScriptShards_h
+#define hifi_EntityScriptShards_h
+
+#include <vector>
+
+#include <QtCore/QJsonArray>
+
+#include <EntitiesScriptEngineProvider.h>
+#include <ScriptEngine.h>
+#include <SharedUtil.h>
+
+// The entity script server's script engines, each running on its own thread with the scripts of the entities whose IDs
+// hash to it. It stands in for a single engine wherever the entity scripting interface needs one, so a call to another
+// entity's method goes to the engine that owns it and is queued onto that engine's thread.
+class EntityScriptShards : public EntitiesScriptEngineProvider {
+public:
+    EntityScriptShards(std::vector<ScriptEnginePointer> engines) : _engines(std::move(engines)) {}
+
+    const std::vector<ScriptEnginePointer>& getEngines() const { return _engines; }
+    const ScriptEnginePointer& getEngine(const EntityItemID& entityID) const;
+
+    int getNumRunningEntityScripts() const;
+
+    void callEntityScriptMethod(const EntityItemID& entityID, const QString& methodName,
+                                const QStringList& params = QStringList(), const QUuid& remoteCallerID = QUuid()) override;
+    QFuture<QVariant> getLocalEntityScriptDetails(const EntityItemID& entityID) override;
+
+    // the load on each engine since the last call, the share of the time its thread spent in entity callbacks, its timers,
+    // and the busiest of its entity scripts over the last few seconds
+    QJsonArray takeStats();
+
+private:
+    std::vector<ScriptEnginePointer> _engines;
+    quint64 _lastStatsTime { usecTimestampNow() };
+};
+
+#endif // hifi_EntityScriptShards_h
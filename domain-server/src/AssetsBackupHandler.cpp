@@ -13,6 +13,7 @@
 
 #include <QJsonDocument>
 #include <QDate>
+#include <QSaveFile>
 #include <QtCore/QLoggingCategory>
 
 #if !defined(__clang__) && defined(__GNUC__)
@@ -33,6 +34,8 @@
 #include <MappingRequest.h>
 #include <PathUtils.h>
 
+#include "BackupFileUtils.h"
+
 using namespace std;
 
 static const QString ASSETS_DIR { "/assets/" };
@@ -318,6 +321,11 @@ std::pair<bool, QString> AssetsBackupHandler::recoverBackup(const QString& backu
         auto assetNames = zipDir.entryList(QDir::Files);
         for (const auto& asset : assetNames) {
             if (AssetUtils::isValidHash(asset)) {
+                if (_assetsOnDisk.find(asset) != end(_assetsOnDisk)) {
+                    // the blobs are stored by hash, so one we already have doesn't need to be unzipped again
+                    continue;
+                }
+
                 if (!zip.setCurrentFile(zipDir.filePath(asset))) {
                     qCCritical(asset_backup) << "Failed to find" << asset << "while recovering backup";
                     qCCritical(asset_backup) << "    Error:" << zip.getZipError();
@@ -331,7 +339,7 @@ std::pair<bool, QString> AssetsBackupHandler::recoverBackup(const QString& backu
                     continue;
                 }
 
-                writeAssetFile(asset, zipFile.readAll());
+                writeAssetFile(asset, zipFile);
             }
         }
 
@@ -394,8 +402,13 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
         return;
     }
 
+    // several paths can map to the same blob, which only goes in the zip once
+    set<AssetUtils::AssetHash> hashesWritten;
     for (const auto& mapping : it->mappings) {
         const auto& hash = mapping.second;
+        if (!hashesWritten.insert(hash).second) {
+            continue;
+        }
 
         QDir assetsDir { _assetsDirectory };
         QFile file { assetsDir.filePath(hash) };
@@ -404,15 +417,10 @@ void AssetsBackupHandler::consolidateBackup(const QString& backupName, QuaZip& z
             continue;
         }
 
-        QuaZipFile zipFile { &zip };
-        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ZIP_ASSETS_FOLDER + "/" + hash))) {
-            qCDebug(asset_backup) << "Could not open zip file:" << zipFile.getZipError();
-            continue;
-        }
-        zipFile.write(file.readAll());
-        zipFile.close();
-        if (zipFile.getZipError() != UNZ_OK) {
-            qCDebug(asset_backup) << "Could not close zip file: " << zipFile.getZipError();
+        // the blob is streamed from disk, and only deflated if it isn't a compressed format already
+        bool compress = !BackupFileUtils::isCompressedFormat(mapping.first);
+        if (!BackupFileUtils::writeToZip(file, zip, ZIP_ASSETS_FOLDER + "/" + hash, compress)) {
+            qCDebug(asset_backup) << "Could not add asset file to zip:" << file.fileName();
             continue;
         }
     }
@@ -520,6 +528,58 @@ bool AssetsBackupHandler::writeAssetFile(const AssetUtils::AssetHash& hash, cons
     return true;
 }
 
+bool AssetsBackupHandler::writeAssetFile(const AssetUtils::AssetHash& hash, QIODevice& source) {
+    QDir assetsDir { _assetsDirectory };
+    QSaveFile file { assetsDir.filePath(hash) };
+    if (!file.open(QFile::WriteOnly)) {
+        qCCritical(asset_backup) << "Could not open asset file for write:" << file.fileName();
+        return false;
+    }
+
+    // the blob is verified against its name as it is copied, and only replaces the file on disk if it matches
+    auto dataHash = BackupFileUtils::copyAndHash(source, file);
+    if (dataHash.isEmpty()) {
+        qCCritical(asset_backup) << "Could not write data to file" << file.fileName();
+        file.cancelWriting();
+        return false;
+    }
+
+    if (QString(dataHash.toHex()) != hash) {
+        qCCritical(asset_backup) << "Asset file" << hash << "in backup is corrupted, its data hashes to" << dataHash.toHex();
+        file.cancelWriting();
+        return false;
+    }
+
+    if (!file.commit()) {
+        qCCritical(asset_backup) << "Could not write data to file" << file.fileName();
+        return false;
+    }
+
+    _assetsOnDisk.insert(hash);
+
+    return true;
+}
+
+bool AssetsBackupHandler::verifyAssetFile(const AssetUtils::AssetHash& hash) {
+    QDir assetsDir { _assetsDirectory };
+    QFile file { assetsDir.filePath(hash) };
+    if (!file.open(QFile::ReadOnly)) {
+        qCCritical(asset_backup) << "Could not open asset file" << file.fileName();
+        return false;
+    }
+
+    auto dataHash = BackupFileUtils::hashDevice(file);
+    if (QString(dataHash.toHex()) != hash) {
+        qCCritical(asset_backup) << "Asset file" << hash << "is corrupted on disk, removing it";
+        file.close();
+        file.remove();
+        _assetsOnDisk.erase(hash);
+        return false;
+    }
+
+    return true;
+}
+
 void AssetsBackupHandler::computeServerStateDifference(const AssetUtils::Mappings& currentMappings,
                                                        const AssetUtils::Mappings& newMappings) {
     _mappingsLeftToSet.reserve((int)newMappings.size());
@@ -573,6 +633,13 @@ void AssetsBackupHandler::restoreNextAsset() {
     auto hash = _assetsLeftToUpload.back();
     _assetsLeftToUpload.pop_back();
 
+    if (!verifyAssetFile(hash)) {
+        // the asset server would store it under a different hash than the one the mappings point at
+        qCCritical(asset_backup) << "Failed to restore asset:" << hash;
+        QMetaObject::invokeMethod(this, &AssetsBackupHandler::restoreNextAsset, Qt::QueuedConnection);
+        return;
+    }
+
     auto assetFilename = _assetsDirectory + hash;
 
     auto assetClient = DependencyManager::get<AssetClient>();
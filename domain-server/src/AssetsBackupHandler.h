@@ -57,6 +57,8 @@ private:
     void downloadMissingFiles(const AssetUtils::Mappings& mappings);
     void downloadNextMissingFile();
     bool writeAssetFile(const AssetUtils::AssetHash& hash, const QByteArray& data);
+    bool writeAssetFile(const AssetUtils::AssetHash& hash, QIODevice& source);
+    bool verifyAssetFile(const AssetUtils::AssetHash& hash);
 
     void computeServerStateDifference(const AssetUtils::Mappings& currentMappings,
                                       const AssetUtils::Mappings& newMappings);
@@ -0,0 +1,90 @@
+//
+//  BackupFileUtils.cpp
+//  domain-server/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BackupFileUtils.h"
+
+#include <QCryptographicHash>
+#include <QDebug>
+#include <QFileInfo>
+#include <QSet>
+
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsuggest-override"
+#endif
+
+#include <quazip5/quazip.h>
+#include <quazip5/quazipfile.h>
+
+#if !defined(__clang__) && defined(__GNUC__)
+#pragma GCC diagnostic pop
+#endif
+
+// zip's "stored" method, for data that isn't compressed any further
+static const int ZIP_STORED_METHOD = 0;
+
+bool BackupFileUtils::isCompressedFormat(const QString& path) {
+    static const QSet<QString> COMPRESSED_SUFFIXES {
+        "gz", "zip", "png", "jpg", "jpeg", "gif", "webp", "mp3", "ogg", "opus", "mp4", "webm", "7z", "bz2", "xz"
+    };
+    return COMPRESSED_SUFFIXES.contains(QFileInfo(path).suffix().toLower());
+}
+
+bool BackupFileUtils::writeToZip(QIODevice& source, QuaZip& zip, const QString& zipFileName, bool compress,
+                                 const QString& sourcePath) {
+    QuaZipFile zipFile { &zip };
+    auto info = sourcePath.isEmpty() ? QuaZipNewInfo(zipFileName) : QuaZipNewInfo(zipFileName, sourcePath);
+    if (!zipFile.open(QIODevice::WriteOnly, info, nullptr, 0, compress ? Z_DEFLATED : ZIP_STORED_METHOD)) {
+        qCritical() << "Could not open" << zipFileName << "for writing in zip:" << zipFile.getZipError();
+        return false;
+    }
+
+    while (!source.atEnd()) {
+        auto chunk = source.read(COPY_CHUNK_SIZE);
+        if (chunk.isEmpty()) {
+            qCritical() << "Could not read data for" << zipFileName << ":" << source.errorString();
+            zipFile.close();
+            return false;
+        }
+        if (zipFile.write(chunk) != chunk.size()) {
+            qCritical() << "Could not write" << zipFileName << "to zip:" << zipFile.getZipError();
+            zipFile.close();
+            return false;
+        }
+    }
+
+    zipFile.close();
+    if (zipFile.getZipError() != UNZ_OK) {
+        qCritical() << "Could not close" << zipFileName << "in zip:" << zipFile.getZipError();
+        return false;
+    }
+    return true;
+}
+
+QByteArray BackupFileUtils::copyAndHash(QIODevice& source, QIODevice& destination) {
+    QCryptographicHash hash { QCryptographicHash::Sha256 };
+    while (!source.atEnd()) {
+        auto chunk = source.read(COPY_CHUNK_SIZE);
+        if (chunk.isEmpty() || destination.write(chunk) != chunk.size()) {
+            return QByteArray();
+        }
+        hash.addData(chunk);
+    }
+    return hash.result();
+}
+
+QByteArray BackupFileUtils::hashDevice(QIODevice& source) {
+    QCryptographicHash hash { QCryptographicHash::Sha256 };
+    if (!hash.addData(&source)) {
+        return QByteArray();
+    }
+    return hash.result();
+}
@@ -0,0 +1,44 @@
+//
+//  BackupFileUtils.h
+//  domain-server/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BackupFileUtils_h
+#define hifi_BackupFileUtils_h
+
+#include <QByteArray>
+#include <QString>
+
+class QIODevice;
+class QuaZip;
+
+namespace BackupFileUtils {
+
+// Files are copied in and out of backups this much at a time, so their size doesn't matter to the memory used.
+const qint64 COPY_CHUNK_SIZE = 1024 * 1024;
+
+// Whether a file's data is already compressed, going by its extension, so that deflating it again would cost time
+// without making the backup any smaller.
+bool isCompressedFormat(const QString& path);
+
+// Writes the rest of the source into a new file in the zip, stored as is unless it is to be compressed.
+// The file's modification time and permissions are taken from the file at sourcePath when it is given.
+bool writeToZip(QIODevice& source, QuaZip& zip, const QString& zipFileName, bool compress,
+                const QString& sourcePath = QString());
+
+// Copies the rest of the source into the destination, returning the SHA-256 hash of what was copied, or an empty array
+// if it couldn't all be copied.
+QByteArray copyAndHash(QIODevice& source, QIODevice& destination);
+
+// Returns the SHA-256 hash of the rest of the source, or an empty array if it couldn't be read.
+QByteArray hashDevice(QIODevice& source);
+
+}
+
+#endif // hifi_BackupFileUtils_h
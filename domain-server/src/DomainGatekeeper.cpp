@@ -13,26 +13,43 @@
 
 #include "DomainGatekeeper.h"
 
-#include <openssl/err.h>
-#include <openssl/rsa.h>
-#include <openssl/x509.h>
+#include <algorithm>
 #include <random>
 
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDataStream>
 #include <QtCore/QMetaMethod>
+#include <QtCore/QThread>
+#include <QtCore/QTimer>
 
 #include <AccountManager.h>
 #include <Assignment.h>
 
 #include "DomainServer.h"
 #include "DomainServerNodeData.h"
+#include "UsernameSignatureVerifier.h"
 
 using SharedAssignmentPointer = QSharedPointer<Assignment>;
 
+// how many connect requests may wait to be processed, ones past that are told to retry later
+static const size_t MAX_PENDING_CONNECT_REQUESTS = 1000;
+// how long a batch of connect requests may take before the rest of the event loop gets a turn
+static const quint64 CONNECT_REQUEST_BATCH_USECS = 5 * USECS_PER_MSEC;
+static const int MIN_CONNECT_RETRY_MSECS = 1 * MSECS_PER_SECOND;
+static const int MAX_CONNECT_RETRY_MSECS = 10 * MSECS_PER_SECOND;
+
+// how long a user's public key and group memberships are used before they're asked for again
+static const quint64 USER_PUBLIC_KEY_TTL_USECS = 60 * USECS_PER_SECOND;
+static const quint64 GROUP_MEMBERSHIPS_TTL_USECS = 60 * USECS_PER_SECOND;
+static const int MAX_IN_FLIGHT_METAVERSE_REQUESTS = 16;
+
 DomainGatekeeper::DomainGatekeeper(DomainServer* server) :
     _server(server)
 {
     initLocalIDManagement();
+
+    // leave a core for the main thread
+    _signatureVerificationPool.setMaxThreadCount(std::max(QThread::idealThreadCount() - 1, 1));
 }
 
 void DomainGatekeeper::addPendingAssignedNode(const QUuid& nodeUUID, const QUuid& assignmentUUID,
@@ -61,6 +78,79 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
         return;
     }
 
+    const SockAddr& senderSockAddr = message->getSenderSockAddr();
+
+    auto pendingRequest = _pendingConnectRequests.find(senderSockAddr);
+    if (pendingRequest != _pendingConnectRequests.end()) {
+        // a retry from a sender that's already waiting replaces its request but doesn't lose its place
+        pendingRequest.value() = message;
+        return;
+    }
+
+    // assignment clients go ahead of everyone else, the users that are waiting need the mixers they're bringing up
+    QUuid connectUUID = QUuid::fromRfc4122(message->getMessage().left(NUM_BYTES_RFC4122_UUID));
+    bool isPendingAssignment = _pendingAssignedNodes.find(connectUUID) != _pendingAssignedNodes.end();
+
+    if (!isPendingAssignment && _connectRequestQueue.size() >= MAX_PENDING_CONNECT_REQUESTS) {
+        sendConnectionDeniedPacket("The domain is busy.", senderSockAddr, DomainHandler::ConnectionRefusedReason::Busy,
+                                   QString::number(getConnectRetryMsecs()));
+        return;
+    }
+
+    _pendingConnectRequests.insert(senderSockAddr, message);
+    if (isPendingAssignment) {
+        _connectRequestQueue.push_front(senderSockAddr);
+    } else {
+        _connectRequestQueue.push_back(senderSockAddr);
+    }
+
+    scheduleConnectRequestBatch();
+}
+
+void DomainGatekeeper::scheduleConnectRequestBatch() {
+    if (!_isConnectRequestBatchScheduled && !_connectRequestQueue.empty()) {
+        _isConnectRequestBatchScheduled = true;
+        QTimer::singleShot(0, this, &DomainGatekeeper::processConnectRequestBatch);
+    }
+}
+
+void DomainGatekeeper::processConnectRequestBatch() {
+    _isConnectRequestBatchScheduled = false;
+
+    quint64 batchStart = usecTimestampNow();
+    quint64 elapsed = 0;
+    int numProcessed = 0;
+
+    while (!_connectRequestQueue.empty() && elapsed < CONNECT_REQUEST_BATCH_USECS) {
+        auto senderSockAddr = _connectRequestQueue.front();
+        _connectRequestQueue.pop_front();
+
+        auto message = _pendingConnectRequests.take(senderSockAddr);
+        if (message) {
+            processConnectRequest(message);
+            ++numProcessed;
+        }
+
+        elapsed = usecTimestampNow() - batchStart;
+    }
+
+    if (numProcessed > 0) {
+        const float AVERAGE_CONNECT_REQUEST_WEIGHT = 0.1f;
+        float batchAverageUsecs = (float)elapsed / numProcessed;
+        _averageConnectRequestUsecs = _averageConnectRequestUsecs == 0.0f ? batchAverageUsecs
+            : _averageConnectRequestUsecs + AVERAGE_CONNECT_REQUEST_WEIGHT * (batchAverageUsecs - _averageConnectRequestUsecs);
+    }
+
+    scheduleConnectRequestBatch();
+}
+
+int DomainGatekeeper::getConnectRetryMsecs() const {
+    // long enough for the requests already waiting to be worked through twice over
+    int backlogMsecs = (int)(2.0f * _connectRequestQueue.size() * _averageConnectRequestUsecs / USECS_PER_MSEC);
+    return std::max(MIN_CONNECT_RETRY_MSECS, std::min(backlogMsecs, MAX_CONNECT_RETRY_MSECS));
+}
+
+void DomainGatekeeper::processConnectRequest(QSharedPointer<ReceivedMessage> message) {
     QDataStream packetStream(message->getMessage());
 
     // read a NodeConnectionData object from the packet so we can pass around this data while we're inspecting it
@@ -155,6 +245,9 @@ void DomainGatekeeper::processConnectRequestPacket(QSharedPointer<ReceivedMessag
         // signal that we just connected a node so the DomainServer can get it a list
         // and broadcast its presence right away
         emit connectedNode(node, message->getFirstPacketReceiveTime());
+    } else if (!username.isEmpty() && _inFlightUsernameSignatureChecks.contains(username.toLower())) {
+        // the request is processed again as soon as the check of its signature is done
+        _connectRequestsAwaitingSignature.insert(username.toLower(), message);
     } else {
         qDebug() << "Refusing connection from node at" << message->getSenderSockAddr()
             << "with hardware address" << nodeConnection.hardwareAddress
@@ -488,7 +581,7 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
             // user is attempting to prove their identity to us, but we don't have enough information
             sendConnectionTokenPacket(username, nodeConnection.senderSockAddr);
 
-            // ask for their public key right now to make sure we have it
+            // ask for their public key right now to make sure we have a recent one
             requestUserPublicKey(username, true);
             getGroupMemberships(username); // optimistically get started on group memberships
 #ifdef WANT_DEBUG
@@ -497,18 +590,25 @@ SharedNodePointer DomainGatekeeper::processAgentConnectRequest(const NodeConnect
             if (!domainHasLogin() || domainUsername.isEmpty()) {
                 return SharedNodePointer();
             }
-        } else if (verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr)) {
-            // they sent us a username and the signature verifies it
-            getGroupMemberships(username);
-            verifiedUsername = username.toLower();
         } else {
-            // they sent us a username, but it didn't check out
-            requestUserPublicKey(username);
+            auto signatureVerification = verifyUserSignature(username, usernameSignature, nodeConnection.senderSockAddr);
+
+            if (signatureVerification == SignatureVerification::Verified) {
+                // they sent us a username and the signature verifies it
+                getGroupMemberships(username);
+                verifiedUsername = username.toLower();
+            } else if (signatureVerification == SignatureVerification::Pending) {
+                // the signature is being checked off the main thread, we'll come back to this request when it has been
+                return SharedNodePointer();
+            } else {
+                // they sent us a username, but it didn't check out
+                requestUserPublicKey(username, false, true);
 #ifdef WANT_DEBUG
-            qDebug() << "stalling login because signature verification failed:" << username;
+                qDebug() << "stalling login because signature verification failed:" << username;
 #endif
-            if (!domainHasLogin() || domainUsername.isEmpty()) {
-                return SharedNodePointer();
+                if (!domainHasLogin() || domainUsername.isEmpty()) {
+                    return SharedNodePointer();
+                }
             }
         }
     }
@@ -689,9 +789,9 @@ void DomainGatekeeper::cleanupICEPeerForNode(const QUuid& nodeID) {
     }
 }
 
-bool DomainGatekeeper::verifyUserSignature(const QString& username,
-                                           const QByteArray& usernameSignature,
-                                           const SockAddr& senderSockAddr) {
+DomainGatekeeper::SignatureVerification DomainGatekeeper::verifyUserSignature(const QString& username,
+                                                                           const QByteArray& usernameSignature,
+                                                                           const SockAddr& senderSockAddr) {
     // it's possible this user can be allowed to connect, but we need to check their username signature
     auto lowerUsername = username.toLower();
     KeyFlagPair publicKeyPair = _userPublicKeys.value(lowerUsername);
@@ -703,32 +803,25 @@ bool DomainGatekeeper::verifyUserSignature(const QString& username,
 
     if (!publicKeyArray.isEmpty() && !connectionToken.isNull()) {
         // if we do have a public key for the user, check for a signature match
+        auto resultIt = _usernameSignatureResults.find(lowerUsername);
+        if (resultIt == _usernameSignatureResults.end() || resultIt->publicKey != publicKeyArray
+                || resultIt->usernameSignature != usernameSignature) {
+            // this signature hasn't been checked against this key yet
+            startUsernameSignatureCheck(lowerUsername, publicKeyArray, connectionToken, usernameSignature);
+            return SignatureVerification::Pending;
+        }
 
-        const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(publicKeyArray.constData());
-
-        // first load up the public key into an RSA struct
-        RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, publicKeyArray.size());
-
-        QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
-        QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
-                                                                QCryptographicHash::Sha256);
-
-        if (rsaPublicKey) {
-            int decryptResult = RSA_verify(NID_sha256,
-                                           reinterpret_cast<const unsigned char*>(usernameWithToken.constData()),
-                                           usernameWithToken.size(),
-                                           reinterpret_cast<const unsigned char*>(usernameSignature.constData()),
-                                           usernameSignature.size(),
-                                           rsaPublicKey);
+        UsernameSignatureResult result = resultIt.value();
+        _usernameSignatureResults.erase(resultIt);
 
-            if (decryptResult == 1) {
+        if (result.isKeyValid) {
+            if (result.isMatch) {
                 qDebug() << "Username signature matches for" << username;
 
-                // free up the public key and remove connection token before we return
-                RSA_free(rsaPublicKey);
+                // remove connection token before we return
                 _connectionTokenHash.remove(username);
 
-                return true;
+                return SignatureVerification::Verified;
 
             } else {
                 // we only send back a LoginErrorMetaverse if this wasn't an "optimistic" key
@@ -742,9 +835,6 @@ bool DomainGatekeeper::verifyUserSignature(const QString& username,
                     qDebug() << "Error decrypting metaverse username signature for" << username << "with optimistic key -"
                         << "re-requesting public key and delaying connection";
                 }
-
-                // free up the public key, we don't need it anymore
-                RSA_free(rsaPublicKey);
             }
 
         } else {
@@ -762,8 +852,47 @@ bool DomainGatekeeper::verifyUserSignature(const QString& username,
         }
     }
 
-    requestUserPublicKey(username); // no joy.  maybe next time?
-    return false;
+    requestUserPublicKey(username, false, true); // no joy.  maybe next time?
+    return SignatureVerification::Unverified;
+}
+
+void DomainGatekeeper::startUsernameSignatureCheck(const QString& lowerUsername, const QByteArray& publicKey,
+                                                   const QUuid& connectionToken, const QByteArray& usernameSignature) {
+    if (_inFlightUsernameSignatureChecks.contains(lowerUsername)) {
+        // the request waiting on it is replaced with this one, which is checked again if its signature is different
+        return;
+    }
+    _inFlightUsernameSignatureChecks.insert(lowerUsername);
+
+    QByteArray lowercaseUsernameUTF8 = lowerUsername.toUtf8();
+    QByteArray usernameWithToken = QCryptographicHash::hash(lowercaseUsernameUTF8.append(connectionToken.toRfc4122()),
+                                                            QCryptographicHash::Sha256);
+
+    auto verifier = new UsernameSignatureVerifier(lowerUsername, publicKey, usernameWithToken, usernameSignature);
+    connect(verifier, &UsernameSignatureVerifier::verified, this, &DomainGatekeeper::handleUsernameSignatureVerified);
+    _signatureVerificationPool.start(verifier);
+}
+
+void DomainGatekeeper::handleUsernameSignatureVerified(QString username, QByteArray publicKey,
+                                                       QByteArray usernameSignature, bool isKeyValid, bool isMatch) {
+    _inFlightUsernameSignatureChecks.remove(username);
+
+    auto message = _connectRequestsAwaitingSignature.take(username);
+    if (!message) {
+        // whoever sent it has given up
+        return;
+    }
+
+    _usernameSignatureResults.insert(username, { publicKey, usernameSignature, isKeyValid, isMatch });
+
+    // the request goes back to the front of the line, it has already waited its turn
+    const SockAddr& senderSockAddr = message->getSenderSockAddr();
+    if (!_pendingConnectRequests.contains(senderSockAddr)) {
+        _pendingConnectRequests.insert(senderSockAddr, message);
+        _connectRequestQueue.push_front(senderSockAddr);
+    }
+
+    scheduleConnectRequestBatch();
 }
 
 
@@ -805,7 +934,7 @@ bool DomainGatekeeper::isWithinMaxCapacity() {
     return true;
 }
 
-void DomainGatekeeper::requestUserPublicKey(const QString& username, bool isOptimistic) {
+void DomainGatekeeper::requestUserPublicKey(const QString& username, bool isOptimistic, bool evenIfCached) {
     // don't request public keys for the standard psuedo-account-names
     if (NodePermissions::standardNames.contains(username, Qt::CaseInsensitive)) {
         return;
@@ -816,9 +945,16 @@ void DomainGatekeeper::requestUserPublicKey(const QString& username, bool isOpti
         // public-key request for this username is already flight, not rerequesting
         return;
     }
+
+    // a key we got recently is used as it is, unless it has just failed to verify a signature
+    auto keyTime = _userPublicKeyTimes.find(lowerUsername);
+    if (!evenIfCached && keyTime != _userPublicKeyTimes.end()
+            && usecTimestampNow() - keyTime.value() < USER_PUBLIC_KEY_TTL_USECS) {
+        return;
+    }
+
     _inFlightPublicKeyRequests.insert(lowerUsername, isOptimistic);
 
-    // even if we have a public key for them right now, request a new one in case it has just changed
     JSONCallbackParameters callbackParams;
     callbackParams.callbackReceiver = this;
     callbackParams.jsonCallbackMethod = "publicKeyJSONCallback";
@@ -829,9 +965,32 @@ void DomainGatekeeper::requestUserPublicKey(const QString& username, bool isOpti
 
     qDebug().nospace() << "Requesting " << (isOptimistic ? "optimistic " : " ") << "public key for user " << username;
 
-    DependencyManager::get<AccountManager>()->sendRequest(USER_PUBLIC_KEY_PATH.arg(username),
-                                              AccountManagerAuth::None,
-                                              QNetworkAccessManager::GetOperation, callbackParams);
+    sendMetaverseRequest(USER_PUBLIC_KEY_PATH.arg(username), AccountManagerAuth::None, QNetworkAccessManager::GetOperation,
+                         callbackParams);
+}
+
+void DomainGatekeeper::sendMetaverseRequest(const QString& path, AccountManagerAuth::Type authType,
+                                            QNetworkAccessManager::Operation operation,
+                                            const JSONCallbackParameters& callbackParams, const QByteArray& dataByteArray) {
+    if (_numInFlightMetaverseRequests >= MAX_IN_FLIGHT_METAVERSE_REQUESTS) {
+        // a connection storm would otherwise have us asking the metaverse about every user at once
+        _queuedMetaverseRequests.push_back({ path, authType, operation, callbackParams, dataByteArray });
+        return;
+    }
+
+    ++_numInFlightMetaverseRequests;
+    DependencyManager::get<AccountManager>()->sendRequest(path, authType, operation, callbackParams, dataByteArray);
+}
+
+void DomainGatekeeper::finishMetaverseRequest() {
+    _numInFlightMetaverseRequests = std::max(_numInFlightMetaverseRequests - 1, 0);
+
+    if (!_queuedMetaverseRequests.empty()) {
+        auto request = _queuedMetaverseRequests.front();
+        _queuedMetaverseRequests.pop_front();
+        sendMetaverseRequest(request.path, request.authType, request.operation, request.callbackParams,
+                             request.dataByteArray);
+    }
 }
 
 QString extractUsernameFromPublicKeyRequest(QNetworkReply* requestReply) {
@@ -850,6 +1009,7 @@ void DomainGatekeeper::publicKeyJSONCallback(QNetworkReply* requestReply) {
     QString username = extractUsernameFromPublicKeyRequest(requestReply);
 
     bool isOptimisticKey = _inFlightPublicKeyRequests.take(username);
+    finishMetaverseRequest();
 
     if (jsonObject["status"].toString() == "success" && !username.isEmpty()) {
         // pull the public key as a QByteArray from this response
@@ -863,6 +1023,7 @@ void DomainGatekeeper::publicKeyJSONCallback(QNetworkReply* requestReply) {
                 QByteArray::fromBase64(jsonObject[JSON_DATA_KEY].toObject()[JSON_PUBLIC_KEY_KEY].toString().toUtf8()),
                 isOptimisticKey
             };
+        _userPublicKeyTimes[username.toLower()] = usecTimestampNow();
     }
 }
 
@@ -870,6 +1031,7 @@ void DomainGatekeeper::publicKeyJSONErrorCallback(QNetworkReply* requestReply) {
     qDebug() << "publicKey api call failed:" << requestReply->error();
     QString username = extractUsernameFromPublicKeyRequest(requestReply);
     _inFlightPublicKeyRequests.remove(username);
+    finishMetaverseRequest();
 }
 
 void DomainGatekeeper::sendProtocolMismatchConnectionDenial(const SockAddr& senderSockAddr) {
@@ -1020,7 +1182,7 @@ void DomainGatekeeper::processICEPingReplyPacket(QSharedPointer<ReceivedMessage>
     }
 }
 
-void DomainGatekeeper::getGroupMemberships(const QString& username) {
+void DomainGatekeeper::getGroupMemberships(const QString& username, bool evenIfCached) {
     // loop through the groups mentioned on the settings page and ask if this user is in each.  The replies
     // will be received asynchronously and permissions will be updated as the answers come in.
 
@@ -1044,6 +1206,14 @@ void DomainGatekeeper::getGroupMemberships(const QString& username) {
         // public-key request for this username is already flight, not rerequesting
         return;
     }
+
+    auto membershipsTime = _groupMembershipsTimes.find(lowerUsername);
+    if (!evenIfCached && membershipsTime != _groupMembershipsTimes.end()
+            && usecTimestampNow() - membershipsTime.value() < GROUP_MEMBERSHIPS_TTL_USECS) {
+        // we heard about this user's groups recently enough
+        return;
+    }
+
     _inFlightGroupMembershipsRequests += lowerUsername;
 
 
@@ -1053,10 +1223,8 @@ void DomainGatekeeper::getGroupMemberships(const QString& username) {
     callbackParams.errorCallbackMethod = "getIsGroupMemberErrorCallback";
 
     const QString GET_IS_GROUP_MEMBER_PATH = "/api/v1/groups/members/%2";
-    DependencyManager::get<AccountManager>()->sendRequest(GET_IS_GROUP_MEMBER_PATH.arg(username),
-                                                          AccountManagerAuth::Required,
-                                                          QNetworkAccessManager::PostOperation, callbackParams,
-                                                          QJsonDocument(json).toJson());
+    sendMetaverseRequest(GET_IS_GROUP_MEMBER_PATH.arg(username), AccountManagerAuth::Required,
+                         QNetworkAccessManager::PostOperation, callbackParams, QJsonDocument(json).toJson());
 }
 
 QString extractUsernameFromGroupMembershipsReply(QNetworkReply* requestReply) {
@@ -1099,16 +1267,19 @@ void DomainGatekeeper::getIsGroupMemberJSONCallback(QNetworkReply* requestReply)
             QUuid rankID = QUuid(rank["id"].toString());
             _server->_settingsManager.recordGroupMembership(username, groupID, rankID);
         }
+        _groupMembershipsTimes[username.toLower()] = usecTimestampNow();
     } else {
         qDebug() << "getIsGroupMember api call returned:" << QJsonDocument(jsonObject).toJson(QJsonDocument::Compact);
     }
 
     _inFlightGroupMembershipsRequests.remove(extractUsernameFromGroupMembershipsReply(requestReply));
+    finishMetaverseRequest();
 }
 
 void DomainGatekeeper::getIsGroupMemberErrorCallback(QNetworkReply* requestReply) {
     qDebug() << "getIsGroupMember api call failed:" << requestReply->error();
     _inFlightGroupMembershipsRequests.remove(extractUsernameFromGroupMembershipsReply(requestReply));
+    finishMetaverseRequest();
 }
 
 
@@ -16,13 +16,16 @@
 #ifndef hifi_DomainGatekeeper_h
 #define hifi_DomainGatekeeper_h
 
+#include <deque>
 #include <unordered_map>
 #include <unordered_set>
 
 #include <QtCore/QObject>
 #include <QtNetwork/QNetworkReply>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QThreadPool>
 
+#include <AccountManager.h>
 #include <DomainHandler.h>
 
 #include <NLPacket.h>
@@ -77,10 +80,24 @@ public slots:
 private slots:
     void handlePeerPingTimeout();
 
+    void processConnectRequestBatch();
+    void handleUsernameSignatureVerified(QString username, QByteArray publicKey, QByteArray usernameSignature,
+                                         bool isKeyValid, bool isMatch);
+
     // Login and groups for domain, separate from metaverse.
     void requestDomainUserFinished();
 
 private:
+    enum class SignatureVerification {
+        Verified,
+        Unverified,
+        Pending
+    };
+
+    void processConnectRequest(QSharedPointer<ReceivedMessage> message);
+    void scheduleConnectRequestBatch();
+    int getConnectRetryMsecs() const;
+
     SharedNodePointer processAssignmentConnectRequest(const NodeConnectionData& nodeConnection,
                                                       const PendingAssignedNodeData& pendingAssignment);
     SharedNodePointer processAgentConnectRequest(const NodeConnectionData& nodeConnection,
@@ -91,8 +108,10 @@ private:
                                                  const QString& domainRefreshToken);
     SharedNodePointer addVerifiedNodeFromConnectRequest(const NodeConnectionData& nodeConnection);
     
-    bool verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
-                             const SockAddr& senderSockAddr);
+    SignatureVerification verifyUserSignature(const QString& username, const QByteArray& usernameSignature,
+                                              const SockAddr& senderSockAddr);
+    void startUsernameSignatureCheck(const QString& lowerUsername, const QByteArray& publicKey,
+                                     const QUuid& connectionToken, const QByteArray& usernameSignature);
     
     bool needToVerifyDomainUserIdentity(const QString& username, const QString& accessToken, const QString& refreshToken);
     bool verifyDomainUserIdentity(const QString& username, const QString& accessToken, const QString& refreshToken,
@@ -110,7 +129,12 @@ private:
     
     void pingPunchForConnectingPeer(const SharedNetworkPeer& peer);
     
-    void requestUserPublicKey(const QString& username, bool isOptimistic = false);
+    void requestUserPublicKey(const QString& username, bool isOptimistic = false, bool evenIfCached = false);
+
+    void sendMetaverseRequest(const QString& path, AccountManagerAuth::Type authType,
+                              QNetworkAccessManager::Operation operation, const JSONCallbackParameters& callbackParams,
+                              const QByteArray& dataByteArray = QByteArray());
+    void finishMetaverseRequest();
     
     DomainServer* _server;
     
@@ -124,6 +148,36 @@ private:
     
     QHash<QString, QUuid> _connectionTokenHash;
 
+    // connect requests wait here, one per sender, and are worked through a few milliseconds at a time so that a storm of
+    // them can't starve the heartbeats and list requests of the nodes already connected
+    std::deque<SockAddr> _connectRequestQueue;
+    QHash<SockAddr, QSharedPointer<ReceivedMessage>> _pendingConnectRequests;
+    bool _isConnectRequestBatchScheduled { false };
+    float _averageConnectRequestUsecs { 0.0f };
+
+    // username signatures are checked on this pool, the requests waiting on one are processed again once it's done
+    struct UsernameSignatureResult {
+        QByteArray publicKey;
+        QByteArray usernameSignature;
+        bool isKeyValid { false };
+        bool isMatch { false };
+    };
+    QThreadPool _signatureVerificationPool;
+    QSet<QString> _inFlightUsernameSignatureChecks;
+    QHash<QString, UsernameSignatureResult> _usernameSignatureResults;
+    QHash<QString, QSharedPointer<ReceivedMessage>> _connectRequestsAwaitingSignature;
+
+    // metaverse lookups beyond the in-flight limit wait their turn here
+    struct MetaverseRequest {
+        QString path;
+        AccountManagerAuth::Type authType;
+        QNetworkAccessManager::Operation operation;
+        JSONCallbackParameters callbackParams;
+        QByteArray dataByteArray;
+    };
+    std::deque<MetaverseRequest> _queuedMetaverseRequests;
+    int _numInFlightMetaverseRequests { 0 };
+
     // the word "optimistic" below is used for keys that we request during user connection before the user has
     // had a chance to upload a new public key
 
@@ -134,14 +188,16 @@ private:
 
     QHash<QString, KeyFlagPair> _userPublicKeys; // keep track of keys and flag them as optimistic or not
     QHash<QString, bool> _inFlightPublicKeyRequests; // keep track of keys we've asked for (and if it was optimistic)
+    QHash<QString, quint64> _userPublicKeyTimes; // when each key was last received, so it isn't asked for again right away
     QSet<QString> _domainOwnerFriends; // keep track of friends of the domain owner
     QSet<QString> _inFlightGroupMembershipsRequests; // keep track of which we've already asked for
+    QHash<QString, quint64> _groupMembershipsTimes; // when each user's memberships were last received
 
     NodePermissions setPermissionsForUser(bool isLocalUser, QString verifiedUsername, QString verifiedDomainUsername,
                                           const QHostAddress& senderAddress, const QString& hardwareAddress, 
                                           const QUuid& machineFingerprint);
 
-    void getGroupMemberships(const QString& username);
+    void getGroupMemberships(const QString& username, bool evenIfCached = false);
     // void getIsGroupMember(const QString& username, const QUuid groupID);
     void getDomainOwnerFriendsList();
 
@@ -13,6 +13,8 @@
 
 #include "DomainServer.h"
 
+#include <algorithm>
+#include <cfloat>
 #include <memory>
 #include <random>
 #include <iostream>
@@ -40,10 +42,12 @@
 #include <HTTPConnection.h>
 #include <LogUtils.h>
 #include <NetworkingConstants.h>
+#include <NodeList.h>
 #include <MetaverseAPI.h>
 #include <udt/PacketHeaders.h>
 #include <SettingHandle.h>
 #include <SharedUtil.h>
+#include <SamplingProfiler.h>
 #include <ShutdownEventListener.h>
 #include <UUID.h>
 #include <LogHandler.h>
@@ -79,6 +83,9 @@ const QString DOMAIN_UPDATE_AUTOMATIC_NETWORKING_KEY = "automatic_networking";
 const int MIN_PORT = 1;
 const int MAX_PORT = 65535;
 
+// the web interface's sockets are read and written on these, its requests are still handled on the main thread
+const int HTTP_WORKER_THREADS = 2;
+
 int const DomainServer::EXIT_CODE_REBOOT = 234923;
 
 QString DomainServer::_iceServerAddr { NetworkingConstants::ICE_SERVER_DEFAULT_HOSTNAME };
@@ -217,6 +224,8 @@ DomainServer::DomainServer(int argc, char* argv[]) :
         watchParentProcess(_parentPID);
     }
 
+    _httpManager.setNumWorkerThreads(HTTP_WORKER_THREADS);
+
     PathUtils::removeTemporaryApplicationDirs();
 
     DependencyManager::set<tracing::Tracer>();
@@ -416,6 +425,23 @@ DomainServer::DomainServer(int argc, char* argv[]) :
     connect(_nodePingMonitorTimer, &QTimer::timeout, this, &DomainServer::nodePingMonitor);
     _nodePingMonitorTimer->start(NODE_PING_MONITOR_INTERVAL_MSECS);
 
+    // checked often enough to fail a mixer over right after its check-in is due
+    static const int MIXER_FAILOVER_CHECK_INTERVAL_MSECS = 250;
+    _mixerFailoverTimer = new QTimer{ this };
+    connect(_mixerFailoverTimer, &QTimer::timeout, this, &DomainServer::checkMixerFailover);
+    _mixerFailoverTimer->start(MIXER_FAILOVER_CHECK_INTERVAL_MSECS);
+
+    static const int MIXER_SHARD_REBALANCE_INTERVAL_MSECS = 10 * MSECS_PER_SECOND;
+    _mixerShardRebalanceTimer = new QTimer{ this };
+    connect(_mixerShardRebalanceTimer, &QTimer::timeout, this, &DomainServer::rebalanceMixerShards);
+    _mixerShardRebalanceTimer->start(MIXER_SHARD_REBALANCE_INTERVAL_MSECS);
+
+    static const int DOMAIN_LIST_STATS_INTERVAL_MSECS = 1 * MSECS_PER_SECOND;
+    _domainListStatsTimer = new QTimer{ this };
+    connect(_domainListStatsTimer, &QTimer::timeout, this, &DomainServer::sampleDomainListStats);
+    _domainListStatsTimer->start(DOMAIN_LIST_STATS_INTERVAL_MSECS);
+    _domainListStatsInterval.start();
+
     initializeExporter();
     initializeMetadataExporter();
 }
@@ -593,6 +619,7 @@ bool DomainServer::optionallyReadX509KeyAndCertificate() {
         }
 
         _httpsManager.reset(new HTTPSManager(QHostAddress::AnyIPv4, DOMAIN_SERVER_HTTPS_PORT, sslCertificate, privateKey, QString(), this));
+        _httpsManager->setNumWorkerThreads(HTTP_WORKER_THREADS);
 
         qDebug() << "TCP server listening for HTTPS connections on" << DOMAIN_SERVER_HTTPS_PORT;
 
@@ -874,6 +901,10 @@ void DomainServer::setupNodeListAndAssignments() {
         PacketReceiver::makeUnsourcedListenerReference<DomainServer>(this, &DomainServer::processPathQueryPacket));
     packetReceiver.registerListener(PacketType::NodeJsonStats,
         PacketReceiver::makeSourcedListenerReference<DomainServer>(this, &DomainServer::processNodeJSONStatsPacket));
+    packetReceiver.registerListener(PacketType::SamplingProfileReply,
+        PacketReceiver::makeSourcedListenerReference<DomainServer>(this, &DomainServer::processSamplingProfileReply));
+    packetReceiver.registerListener(PacketType::MixerShardClientPositions,
+        PacketReceiver::makeSourcedListenerReference<DomainServer>(this, &DomainServer::processMixerShardClientPositions));
     packetReceiver.registerListener(PacketType::DomainDisconnectRequest,
         PacketReceiver::makeUnsourcedListenerReference<DomainServer>(this, &DomainServer::processNodeDisconnectRequestPacket));
     packetReceiver.registerListener(PacketType::AvatarZonePresence,
@@ -1245,6 +1276,9 @@ void DomainServer::createStaticAssignmentsForType(Assignment::Type type, const Q
 }
 
 void DomainServer::populateDefaultStaticAssignmentsExcludingTypes(const QSet<Assignment::Type>& excludedTypes) {
+    const QString HOT_STANDBY_MIXERS_KEYPATH = "failover.hot_standby_mixers";
+    bool hasHotStandbyMixers = _settingsManager.valueOrDefaultValueForKeyPath(HOT_STANDBY_MIXERS_KEYPATH).toBool();
+
     // enumerate over all assignment types and see if we've already excluded it
     for (Assignment::Type defaultedType = Assignment::FirstType;
          defaultedType != Assignment::AllTypes;
@@ -1258,10 +1292,47 @@ void DomainServer::populateDefaultStaticAssignmentsExcludingTypes(const QSet<Ass
                 continue;
             }
 
+            // bake workers offload the baking of the asset-server, as many as are configured
+            if (defaultedType == Assignment::BakeWorkerType) {
+                if (isAssetServerEnabled()) {
+                    const QString BAKE_WORKERS_KEYPATH = "asset_server.bake_workers";
+                    int numBakeWorkers = _settingsManager.valueOrDefaultValueForKeyPath(BAKE_WORKERS_KEYPATH).toInt();
+                    for (int i = 0; i < numBakeWorkers; ++i) {
+                        addStaticAssignmentToAssignmentHash(new Assignment(Assignment::CreateCommand, defaultedType));
+                    }
+                }
+                continue;
+            }
+
+            // the avatar and audio mixers can be sharded, with each of their clients assigned to one of the shards
+            int numShards = numMixerShards(defaultedType);
+            if (numShards > 1) {
+                qCDebug(domain_server) << "Creating" << numShards << Assignment::typeToString(defaultedType) << "shards";
+                for (int i = 0; i < numShards; ++i) {
+                    Assignment* shardAssignment = new Assignment(Assignment::CreateCommand, defaultedType);
+                    shardAssignment->setPayload(SHARD_ASSIGNMENT_PAYLOAD);
+                    addStaticAssignmentToAssignmentHash(shardAssignment);
+                }
+
+                if (hasHotStandbyMixers) {
+                    qCWarning(domain_server) << "Sharded mixers can't have a hot standby, the"
+                        << Assignment::typeToString(defaultedType) << "shards will run without one";
+                }
+                continue;
+            }
+
             // type has not been set from a command line or config file config, use the default
             // by clearing whatever exists and writing a single default assignment with no payload
             Assignment* newAssignment = new Assignment(Assignment::CreateCommand, (Assignment::Type) defaultedType);
             addStaticAssignmentToAssignmentHash(newAssignment);
+
+            // the mixers can be given a hot standby that mirrors their nodes' state, to take over when they die
+            if ((defaultedType == Assignment::AudioMixerType || defaultedType == Assignment::AvatarMixerType)
+                && hasHotStandbyMixers) {
+                Assignment* standbyAssignment = new Assignment(Assignment::CreateCommand, defaultedType);
+                standbyAssignment->setIsStandby(true);
+                addStaticAssignmentToAssignmentHash(standbyAssignment);
+            }
         }
     }
 }
@@ -1298,12 +1369,227 @@ void DomainServer::processListRequestPacket(QSharedPointer<ReceivedMessage> mess
     // client-side send time of last connect/domain list request
     nodeData->setLastDomainCheckinTimestamp(nodeRequestData.lastPingTimestamp);
 
+    // the last domain list the node applied, which decides whether it can be sent only what has changed since
+    nodeData->setAppliedDomainListVersion(nodeRequestData.domainListVersion);
+
     sendDomainListToNode(sendingNode, message->getFirstPacketReceiveTime(), message->getSenderSockAddr(), false);
 }
 
 bool DomainServer::isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
     auto nodeAData = static_cast<DomainServerNodeData*>(nodeA->getLinkedData());
-    return nodeAData && nodeAData->getNodeInterestSet().contains(nodeB->getType());
+    if (!nodeAData || !nodeAData->getNodeInterestSet().contains(nodeB->getType())) {
+        return false;
+    }
+
+    if (nodeA->getType() == nodeB->getType()) {
+        return true;
+    }
+
+    // a hot standby mixer is only known to the mixer it stands by for, until it is failed over to
+    if (isStandbyMixer(nodeB)) {
+        return false;
+    }
+
+    // a client only knows the shard of a sharded mixer it is assigned to, and a shard only its own clients
+    auto isShardClient = [](const SharedNodePointer& node) {
+        return node->getType() == NodeType::Agent || node->getType() == NodeType::EntityScriptServer;
+    };
+    if (isShardClient(nodeA) && isShardMixer(nodeB)) {
+        return shardForNode(nodeA, nodeB->getType()) == nodeB->getUUID();
+    }
+    if (isShardMixer(nodeA) && isShardClient(nodeB)) {
+        return shardForNode(nodeB, nodeA->getType()) == nodeA->getUUID();
+    }
+    return true;
+}
+
+int DomainServer::numMixerShards(Assignment::Type type) {
+    const QString AVATAR_MIXER_SHARDS_KEYPATH = "sharding.avatar_mixers";
+    const QString AUDIO_MIXER_SHARDS_KEYPATH = "sharding.audio_mixers";
+    if (type == Assignment::AvatarMixerType) {
+        return _settingsManager.valueOrDefaultValueForKeyPath(AVATAR_MIXER_SHARDS_KEYPATH).toInt();
+    } else if (type == Assignment::AudioMixerType) {
+        return _settingsManager.valueOrDefaultValueForKeyPath(AUDIO_MIXER_SHARDS_KEYPATH).toInt();
+    }
+    return 1;
+}
+
+bool DomainServer::isShardMixer(const SharedNodePointer& node) {
+    if (node->getType() != NodeType::AudioMixer && node->getType() != NodeType::AvatarMixer) {
+        return false;
+    }
+
+    auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (!nodeData || nodeData->getAssignmentUUID().isNull()) {
+        return false;
+    }
+
+    auto assignment = _allAssignments.value(nodeData->getAssignmentUUID());
+    return assignment && assignment->getPayload() == SHARD_ASSIGNMENT_PAYLOAD;
+}
+
+QUuid DomainServer::shardForNode(const SharedNodePointer& node, NodeType_t mixerType) {
+    auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (!nodeData) {
+        return QUuid();
+    }
+
+    QUuid shardID = nodeData->getMixerShardID(mixerType);
+    if (!shardID.isNull()) {
+        return shardID;
+    }
+
+    // a node is assigned the shard with the fewest nodes when it first needs one, until rebalanceMixerShards
+    // moves it to the shard of its region once its shard has told us where it is
+    QHash<QUuid, int> numNodesPerShard;
+    QList<QUuid> shardIDs;
+    DependencyManager::get<LimitedNodeList>()->eachNode([&](const SharedNodePointer& otherNode) {
+        if (otherNode->getType() == mixerType && isShardMixer(otherNode)) {
+            shardIDs.push_back(otherNode->getUUID());
+        }
+        auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+        if (otherNodeData) {
+            ++numNodesPerShard[otherNodeData->getMixerShardID(mixerType)];
+        }
+    });
+
+    for (const auto& candidateID : shardIDs) {
+        if (shardID.isNull() || numNodesPerShard.value(candidateID) < numNodesPerShard.value(shardID)) {
+            shardID = candidateID;
+        }
+    }
+
+    if (!shardID.isNull()) {
+        qCDebug(domain_server) << "Assigned" << node->getUUID() << "to" << NodeType::getNodeTypeName(mixerType) << "shard"
+            << shardID << "of" << shardIDs.size();
+        nodeData->setMixerShardID(mixerType, shardID);
+    }
+    return shardID;
+}
+
+void DomainServer::processMixerShardClientPositions(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode) {
+    // the shards tell us where their clients are every few seconds, for them to be rebalanced by region
+    if (!isShardMixer(sendingNode)) {
+        return;
+    }
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    while (packetList->getBytesLeftToRead() >= (qint64)(NUM_BYTES_RFC4122_UUID + sizeof(glm::vec3))) {
+        auto nodeID = QUuid::fromRfc4122(packetList->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        glm::vec3 position;
+        packetList->readPrimitive(&position);
+
+        auto node = nodeList->nodeWithUUID(nodeID);
+        auto nodeData = node ? static_cast<DomainServerNodeData*>(node->getLinkedData()) : nullptr;
+        if (nodeData && nodeData->getMixerShardID(sendingNode->getType()) == sendingNode->getUUID()) {
+            nodeData->setAvatarPosition(position);
+        }
+    }
+}
+
+void DomainServer::rebalanceMixerShards() {
+    // the clients are split along the horizontal axis they're spread furthest over, into a slab of as many clients for
+    // each shard, so that those near each other share a shard and the shards send each other the fewest avatars
+    static const float SHARD_SLAB_EDGE_MARGIN = 5.0f;
+    static const int MAX_SHARD_MOVES_PER_REBALANCE = 8;
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    auto positionOf = [](const SharedNodePointer& node) {
+        return static_cast<DomainServerNodeData*>(node->getLinkedData())->getAvatarPosition();
+    };
+    auto shardIDOf = [](const SharedNodePointer& node, NodeType_t mixerType) {
+        return static_cast<DomainServerNodeData*>(node->getLinkedData())->getMixerShardID(mixerType);
+    };
+
+    for (auto mixerType : { NodeType::AudioMixer, NodeType::AvatarMixer }) {
+        std::vector<QUuid> shardIDs;
+        std::vector<SharedNodePointer> clients;
+        nodeList->eachNode([&](const SharedNodePointer& node) {
+            auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+            if (node->getType() == mixerType && isShardMixer(node)) {
+                shardIDs.push_back(node->getUUID());
+            } else if (nodeData && nodeData->hasAvatarPosition() && !nodeData->getMixerShardID(mixerType).isNull()) {
+                clients.push_back(node);
+            }
+        });
+        size_t numShards = shardIDs.size();
+        if (numShards < 2 || clients.size() < numShards) {
+            continue;
+        }
+
+        glm::vec3 minPosition = positionOf(clients.front());
+        glm::vec3 maxPosition = minPosition;
+        for (const auto& client : clients) {
+            minPosition = glm::min(minPosition, positionOf(client));
+            maxPosition = glm::max(maxPosition, positionOf(client));
+        }
+        int axis = (maxPosition.x - minPosition.x >= maxPosition.z - minPosition.z) ? 0 : 2;
+        std::sort(clients.begin(), clients.end(), [&](const SharedNodePointer& a, const SharedNodePointer& b) {
+            return positionOf(a)[axis] < positionOf(b)[axis];
+        });
+        auto slabBegin = [&](size_t slab) { return slab * clients.size() / numShards; };
+
+        // each slab goes to the shard that already has the most of its clients, so that the fewest move
+        std::vector<std::vector<int>> numShardClientsInSlab(numShards, std::vector<int>(numShards, 0));
+        for (size_t slab = 0; slab < numShards; ++slab) {
+            for (size_t i = slabBegin(slab); i < slabBegin(slab + 1); ++i) {
+                auto shard = std::find(shardIDs.begin(), shardIDs.end(), shardIDOf(clients[i], mixerType));
+                if (shard != shardIDs.end()) {
+                    ++numShardClientsInSlab[slab][shard - shardIDs.begin()];
+                }
+            }
+        }
+        std::vector<QUuid> slabShardIDs(numShards);
+        std::vector<bool> isShardTaken(numShards, false);
+        for (size_t round = 0; round < numShards; ++round) {
+            int bestSlab = -1;
+            int bestShard = -1;
+            for (size_t slab = 0; slab < numShards; ++slab) {
+                for (size_t shard = 0; shard < numShards; ++shard) {
+                    if (slabShardIDs[slab].isNull() && !isShardTaken[shard] &&
+                        (bestSlab < 0 || numShardClientsInSlab[slab][shard] > numShardClientsInSlab[bestSlab][bestShard])) {
+                        bestSlab = (int)slab;
+                        bestShard = (int)shard;
+                    }
+                }
+            }
+            slabShardIDs[bestSlab] = shardIDs[bestShard];
+            isShardTaken[bestShard] = true;
+        }
+
+        // a client near the edge of its slab stays where it is, so that those walking along it don't switch back and forth
+        int numMoves = 0;
+        for (size_t slab = 0; slab < numShards; ++slab) {
+            auto edgeBefore = [&](size_t i) { return 0.5f * (positionOf(clients[i - 1])[axis] + positionOf(clients[i])[axis]); };
+            float lowerEdge = slab > 0 ? edgeBefore(slabBegin(slab)) : -FLT_MAX;
+            float upperEdge = slab + 1 < numShards ? edgeBefore(slabBegin(slab + 1)) : FLT_MAX;
+
+            for (size_t i = slabBegin(slab); i < slabBegin(slab + 1) && numMoves < MAX_SHARD_MOVES_PER_REBALANCE; ++i) {
+                float position = positionOf(clients[i])[axis];
+                if (shardIDOf(clients[i], mixerType) != slabShardIDs[slab] &&
+                    position - lowerEdge >= SHARD_SLAB_EDGE_MARGIN && upperEdge - position >= SHARD_SLAB_EDGE_MARGIN) {
+                    qCDebug(domain_server) << "Moved" << clients[i]->getUUID() << "to" << NodeType::getNodeTypeName(mixerType)
+                        << "shard" << slabShardIDs[slab] << "of its region";
+                    static_cast<DomainServerNodeData*>(clients[i]->getLinkedData())->setMixerShardID(mixerType, slabShardIDs[slab]);
+                    ++numMoves;
+                }
+            }
+        }
+    }
+}
+
+bool DomainServer::isStandbyMixer(const SharedNodePointer& node) {
+    if (node->getType() != NodeType::AudioMixer && node->getType() != NodeType::AvatarMixer) {
+        return false;
+    }
+
+    auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    if (!nodeData || nodeData->getAssignmentUUID().isNull()) {
+        return false;
+    }
+
+    auto assignment = _allAssignments.value(nodeData->getAssignmentUUID());
+    return assignment && assignment->isStandby();
 }
 
 unsigned int DomainServer::countConnectedUsers() {
@@ -1384,6 +1670,9 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
         NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
 
+    // a full list now and then puts right anything a lost removal or an unnoticed change left behind
+    static const int DOMAIN_LISTS_PER_SNAPSHOT = 30;
+
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
     QByteArray extendedHeader(NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES, 0);
@@ -1391,6 +1680,21 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
     auto limitedNodeList = DependencyManager::get<LimitedNodeList>();
 
+    // the node is sent only the entries that changed since its last list if it applied that list, otherwise everything
+    bool isDelta = !newConnection && nodeData->getSentDomainListVersion() != 0
+        && nodeData->getAppliedDomainListVersion() == nodeData->getSentDomainListVersion()
+        && nodeData->getDomainListsSinceSnapshot() < DOMAIN_LISTS_PER_SNAPSHOT;
+    quint32 baseVersion = isDelta ? nodeData->getSentDomainListVersion() : 0;
+    quint32 version = nodeData->nextDomainListVersion();
+
+    auto& sentEntries = nodeData->getSentDomainListEntries();
+    if (isDelta) {
+        nodeData->setDomainListsSinceSnapshot(nodeData->getDomainListsSinceSnapshot() + 1);
+    } else {
+        sentEntries.clear();
+        nodeData->setDomainListsSinceSnapshot(0);
+    }
+
     extendedHeaderStream << limitedNodeList->getSessionUUID();
     extendedHeaderStream << limitedNodeList->getSessionLocalID();
     extendedHeaderStream << node->getUUID();
@@ -1401,29 +1705,43 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
     extendedHeaderStream << newConnection;
+    extendedHeaderStream << version;
+    extendedHeaderStream << baseVersion;
     auto domainListPackets = NLPacketList::create(PacketType::DomainList, extendedHeader);
 
-    // always send the node their own UUID back
-    QDataStream domainListStream(domainListPackets.get());
-
     // store the nodeInterestSet on this DomainServerNodeData, in case it has changed
     auto& nodeInterestSet = nodeData->getNodeInterestSet();
 
+    QSet<QUuid> listedNodes;
+
     if (nodeInterestSet.size() > 0) {
 
         // DTLSServerSession* dtlsSession = _isUsingDTLS ? _dtlsSessions[senderSockAddr] : NULL;
         if (nodeData->isAuthenticated()) {
             // if this authenticated node has any interest types, send back those nodes as well
-            limitedNodeList->eachNode([this, node, &domainListPackets, &domainListStream](const SharedNodePointer& otherNode) {
+            limitedNodeList->eachNode([this, node, &domainListPackets, &sentEntries, &listedNodes](const SharedNodePointer& otherNode) {
                 if (otherNode->getUUID() != node->getUUID() && isInInterestSet(node, otherNode)) {
-                    // since we're about to add a node to the packet we start a segment
-                    domainListPackets->startSegment();
+                    QByteArray entry;
+                    QDataStream entryStream(&entry, QIODevice::WriteOnly);
 
                     // don't send avatar nodes to other avatars, that will come from avatar mixer
-                    domainListStream << *otherNode.data();
+                    entryStream << *otherNode.data();
 
                     // pack the secret that these two nodes will use to communicate with each other
-                    domainListStream << connectionSecretForNodes(node, otherNode);
+                    entryStream << connectionSecretForNodes(node, otherNode);
+
+                    listedNodes.insert(otherNode->getUUID());
+
+                    auto& sentEntry = sentEntries[otherNode->getUUID()];
+                    if (sentEntry == entry) {
+                        // the node already has this entry as it is
+                        return;
+                    }
+                    sentEntry = entry;
+
+                    // since we're about to add a node to the packet we start a segment
+                    domainListPackets->startSegment();
+                    domainListPackets->write(entry);
 
                     // we've added the node we wanted so end the segment now
                     domainListPackets->endSegment();
@@ -1435,8 +1753,46 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     // send an empty list to the node, in case there were no other nodes
     domainListPackets->closeCurrentPacket(true);
 
+    _domainListBytesSent += domainListPackets->getDataSize();
+    if (isDelta) {
+        ++_numDeltaDomainListsSent;
+    } else {
+        ++_numFullDomainListsSent;
+    }
+
     // write the PacketList to this node
     limitedNodeList->sendPacketList(std::move(domainListPackets), *node);
+
+    // the nodes it was sent before that are no longer in its list are removed the same way a disconnected node is
+    for (auto it = sentEntries.begin(); it != sentEntries.end();) {
+        if (listedNodes.contains(it.key())) {
+            ++it;
+            continue;
+        }
+
+        auto removedNodePacket = NLPacket::create(PacketType::DomainServerRemovedNode, NUM_BYTES_RFC4122_UUID, true);
+        removedNodePacket->write(it.key().toRfc4122());
+        _domainListBytesSent += removedNodePacket->getDataSize();
+        limitedNodeList->sendPacket(std::move(removedNodePacket), *node);
+
+        it = sentEntries.erase(it);
+    }
+}
+
+void DomainServer::sampleDomainListStats() {
+    // the full lists are sent to new and resyncing nodes, the deltas to the rest, the bytes include the removals
+    float elapsedSeconds = _domainListStatsInterval.restart() / (float)MSECS_PER_SECOND;
+    if (elapsedSeconds <= 0.0f) {
+        return;
+    }
+
+    _domainListBytesPerSecond = _domainListBytesSent / elapsedSeconds;
+    _fullDomainListsPerSecond = _numFullDomainListsSent / elapsedSeconds;
+    _deltaDomainListsPerSecond = _numDeltaDomainListsSent / elapsedSeconds;
+
+    _domainListBytesSent = 0;
+    _numFullDomainListsSent = 0;
+    _numDeltaDomainListsSent = 0;
 }
 
 QUuid DomainServer::connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB) {
@@ -2029,6 +2385,48 @@ void DomainServer::nodePingMonitor() {
     });
 }
 
+void DomainServer::checkMixerFailover() {
+    // a mixer is failed over as soon as it misses a check-in, if its standby hasn't
+    static const quint64 MIXER_FAILOVER_SILENCE_USECS = DOMAIN_SERVER_CHECK_IN_MSECS * USECS_PER_MSEC * 3 / 2;
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    quint64 now = usecTimestampNow();
+
+    for (auto mixerType : { NodeType::AudioMixer, NodeType::AvatarMixer }) {
+        SharedNodePointer activeMixer;
+        SharedNodePointer standbyMixer;
+        nodeList->eachNode([this, mixerType, &activeMixer, &standbyMixer](const SharedNodePointer& node) {
+            if (node->getType() == mixerType) {
+                (isStandbyMixer(node) ? standbyMixer : activeMixer) = node;
+            }
+        });
+
+        if (!activeMixer || !standbyMixer || now - activeMixer->getLastHeardMicrostamp() <= MIXER_FAILOVER_SILENCE_USECS
+            || now - standbyMixer->getLastHeardMicrostamp() > MIXER_FAILOVER_SILENCE_USECS) {
+            continue;
+        }
+
+        qCDebug(domain_server) << "Failing over from" << NodeType::getNodeTypeName(mixerType) << activeMixer->getUUID()
+            << "to its hot standby" << standbyMixer->getUUID() << "after"
+            << (now - activeMixer->getLastHeardMicrostamp()) / USECS_PER_MSEC << "msec of silence";
+
+        auto activeData = static_cast<DomainServerNodeData*>(activeMixer->getLinkedData());
+        auto standbyData = static_cast<DomainServerNodeData*>(standbyMixer->getLinkedData());
+        _allAssignments.value(standbyData->getAssignmentUUID())->setIsStandby(false);
+
+        // the assignment of the failed mixer goes back in the queue as the new standby
+        auto failedAssignment = activeData ? _allAssignments.value(activeData->getAssignmentUUID()) : SharedAssignmentPointer();
+        if (failedAssignment) {
+            failedAssignment->setIsStandby(true);
+        }
+
+        handleKillNode(activeMixer);
+
+        // the nodes hear of the standby now rather than with their next domain list
+        broadcastNewNode(standbyMixer);
+    }
+}
+
 void DomainServer::processOctreeDataPersistMessage(QSharedPointer<ReceivedMessage> message) {
     auto data = message->readAll();
     qDebug() << "Received octree data persist message" << (data.size() / 1000) << "kbytes.";
@@ -2127,6 +2525,80 @@ void DomainServer::processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> pa
     }
 }
 
+void DomainServer::requestSamplingProfile(HTTPConnection* connection, const SharedNodePointer& node, const QUrl& url) {
+    static const int DEFAULT_PROFILE_SECONDS = 10;
+    // on top of the profile itself, for the node to gzip and send it
+    static const int PROFILE_REPLY_TIMEOUT_MSECS = 15 * MSECS_PER_SECOND;
+
+    QUrlQuery query(url);
+    bool ok = true;
+    int seconds = DEFAULT_PROFILE_SECONDS;
+    int frequency = SamplingProfiler::DEFAULT_FREQUENCY;
+    if (query.hasQueryItem("seconds")) {
+        seconds = query.queryItemValue("seconds").toInt(&ok);
+    }
+    if (ok && query.hasQueryItem("frequency")) {
+        frequency = query.queryItemValue("frequency").toInt(&ok);
+    }
+    if (!ok || seconds <= 0 || seconds > SamplingProfiler::MAX_DURATION_SECS ||
+        frequency <= 0 || frequency > SamplingProfiler::MAX_FREQUENCY) {
+        connection->respond(HTTPConnection::StatusCode400,
+            QString("seconds must be 1 to %1 and frequency 1 to %2 Hz")
+                .arg(SamplingProfiler::MAX_DURATION_SECS).arg(SamplingProfiler::MAX_FREQUENCY).toUtf8());
+        return;
+    }
+
+    quint32 requestID = ++_lastSamplingProfileRequestID;
+    _pendingSamplingProfiles[requestID] = { node->getUUID(), connection };
+
+    auto packet = NLPacket::create(PacketType::SamplingProfileRequest, 3 * sizeof(quint32), true);
+    packet->writePrimitive(requestID);
+    packet->writePrimitive((quint32)(seconds * MSECS_PER_SECOND));
+    packet->writePrimitive((quint32)frequency);
+    DependencyManager::get<LimitedNodeList>()->sendPacket(std::move(packet), *node);
+
+    qDebug() << "Requested a" << seconds << "second sampling profile at" << frequency << "Hz from" << node->getUUID();
+
+    QTimer::singleShot((int)(seconds * MSECS_PER_SECOND) + PROFILE_REPLY_TIMEOUT_MSECS, this, [this, requestID] {
+        auto pending = _pendingSamplingProfiles.find(requestID);
+        if (pending == _pendingSamplingProfiles.end()) {
+            return;
+        }
+        QPointer<HTTPConnection> connection = pending->connection;
+        _pendingSamplingProfiles.erase(pending);
+        if (connection) {
+            connection->respond(HTTPConnection::StatusCode500, "The node did not reply with a profile in time");
+        }
+    });
+}
+
+void DomainServer::processSamplingProfileReply(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode) {
+    quint32 requestID;
+    quint8 succeeded;
+    packetList->readPrimitive(&requestID);
+    packetList->readPrimitive(&succeeded);
+
+    auto pending = _pendingSamplingProfiles.find(requestID);
+    if (pending == _pendingSamplingProfiles.end() || pending->nodeID != sendingNode->getUUID()) {
+        return;
+    }
+    QPointer<HTTPConnection> connection = pending->connection;
+    _pendingSamplingProfiles.erase(pending);
+    if (!connection) {
+        return;
+    }
+
+    QByteArray payload = packetList->readAll();
+    if (succeeded) {
+        Headers headers;
+        headers["Content-Disposition"] =
+            QString("attachment; filename=\"%1.pb.gz\"").arg(uuidStringWithoutCurlyBraces(sendingNode->getUUID())).toUtf8();
+        connection->respond(HTTPConnection::StatusCode200, payload, "application/octet-stream", headers);
+    } else {
+        connection->respond(HTTPConnection::StatusCode500, payload);
+    }
+}
+
 QJsonObject DomainServer::jsonForSocket(const SockAddr& socket) {
     QJsonObject socketJSON;
 
@@ -2145,6 +2617,7 @@ const char JSON_KEY_PENDING_CREDITS[] = "pending_credits";
 const char JSON_KEY_UPTIME[] = "uptime";
 const char JSON_KEY_USERNAME[] = "username";
 const char JSON_KEY_VERSION[] = "version";
+const char JSON_KEY_CONNECTION[] = "connection";
 QJsonObject DomainServer::jsonObjectForNode(const SharedNodePointer& node) {
     QJsonObject nodeJson;
 
@@ -2173,6 +2646,9 @@ QJsonObject DomainServer::jsonObjectForNode(const SharedNodePointer& node) {
     nodeJson[JSON_KEY_USERNAME] = nodeData->getUsername();
     nodeJson[JSON_KEY_VERSION] = nodeData->getNodeVersion();
 
+    // the domain server's own view of the connection, with the last minute of samples
+    nodeJson[JSON_KEY_CONNECTION] = node->getConnectionStatsJSON(true);
+
     SharedAssignmentPointer matchingAssignment = _allAssignments.value(nodeData->getAssignmentUUID());
     if (matchingAssignment) {
         nodeJson[JSON_KEY_POOL] = matchingAssignment->getPool();
@@ -2229,6 +2705,7 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
     const QString URI_ID = "/id";
     const QString URI_ASSIGNMENT = "/assignment";
     const QString URI_NODES = "/nodes";
+    const QString URI_PERFORMANCE = "/performance.json";
     const QString URI_SETTINGS = "/settings";
     const QString URI_CONTENT_UPLOAD = "/content/upload";
     const QString URI_RESTART = "/restart";
@@ -2411,6 +2888,49 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
             QJsonDocument transactionsDocument(rootObject);
             connection->respond(HTTPConnection::StatusCode200, transactionsDocument.toJson(), qPrintable(JSON_MIME_TYPE));
 
+            return true;
+        } else if (url.path() == URI_PERFORMANCE) {
+            // the time series of every assignment's performance counters, and what they are alerting on
+            QJsonObject rootJSON;
+            QJsonArray nodesJSONArray;
+            QJsonArray alertsJSONArray;
+
+            nodeList->eachNode([&nodesJSONArray, &alertsJSONArray](const SharedNodePointer& node) {
+                auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+                if (!nodeData) {
+                    return;
+                }
+
+                const auto& history = nodeData->getPerformanceHistory();
+                auto series = history.getSeries();
+                if (series.isEmpty()) {
+                    return;
+                }
+
+                auto uuid = uuidStringWithoutCurlyBraces(node->getUUID());
+                auto type = NodeType::getNodeTypeName(node->getType());
+                auto alerts = history.getAlerts();
+                for (auto alert : alerts) {
+                    auto alertObject = alert.toObject();
+                    alertObject["uuid"] = uuid;
+                    alertObject["type"] = type;
+                    alertsJSONArray.append(alertObject);
+                }
+
+                nodesJSONArray.append(QJsonObject {
+                    { "uuid", uuid },
+                    { "type", type },
+                    { "series", series },
+                    { "alerts", alerts }
+                });
+            });
+
+            rootJSON["nodes"] = nodesJSONArray;
+            rootJSON["alerts"] = alertsJSONArray;
+
+            QJsonDocument performanceDocument(rootJSON);
+            connection->respond(HTTPConnection::StatusCode200, performanceDocument.toJson(), qPrintable(JSON_MIME_TYPE));
+
             return true;
         } else if (url.path() == QString("%1.json").arg(URI_NODES)) {
             // setup the JSON
@@ -2425,6 +2945,12 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
 
             rootJSON["nodes"] = nodesJSONArray;
 
+            QJsonObject domainListJSON;
+            domainListJSON["bytes_per_second"] = _domainListBytesPerSecond;
+            domainListJSON["full_lists_per_second"] = _fullDomainListsPerSecond;
+            domainListJSON["delta_lists_per_second"] = _deltaDomainListsPerSecond;
+            rootJSON["domain_list"] = domainListJSON;
+
             // print out the created JSON
             QJsonDocument nodesDocument(rootJSON);
 
@@ -2530,6 +3056,19 @@ bool DomainServer::handleHTTPRequest(HTTPConnection* connection, const QUrl& url
 
                 return false;
             }
+
+            // check if this is a request for a sampling profile of a node
+            const QString NODE_PROFILE_REGEX_STRING = QString("\\%1\\/(%2)\\/profile\\/?$").arg(URI_NODES).arg(UUID_REGEX_STRING);
+            QRegExp nodeProfileRegex(NODE_PROFILE_REGEX_STRING);
+
+            if (nodeProfileRegex.indexIn(url.path()) != -1) {
+                SharedNodePointer matchingNode = nodeList->nodeWithUUID(QUuid(nodeProfileRegex.cap(1)));
+                if (!matchingNode) {
+                    return false;
+                }
+                requestSamplingProfile(connection, matchingNode, url);
+                return true;
+            }
         }
     } else if (connection->requestOperation() == QNetworkAccessManager::PostOperation) {
         if (url.path() == URI_ASSIGNMENT) {
@@ -3446,6 +3985,7 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
     _gatekeeper.cleanupICEPeerForNode(node->getUUID());
 
     DomainServerNodeData* nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+    QUuid killedMixerID;
 
     if (nodeData) {
         // if this node's UUID matches a static assignment we need to throw it back in the assignment queue
@@ -3465,6 +4005,12 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
             }
         }
 
+        if (node->getType() == NodeType::AudioMixer || node->getType() == NodeType::AvatarMixer) {
+            // the clients of a mixer shard that died are assigned another with the next domain list they're sent,
+            // after being told this one is gone
+            killedMixerID = node->getUUID();
+        }
+
         if (node->getType() == NodeType::Agent) {
             // if this node was an Agent ask DomainServerNodeData to remove the interpolation we potentially stored
             nodeData->removeOverrideForKey(USERNAME_UUID_REPLACEMENT_STATS_KEY,
@@ -3478,6 +4024,15 @@ void DomainServer::nodeKilled(SharedNodePointer node) {
     }
 
     broadcastNodeDisconnect(node);
+
+    if (!killedMixerID.isNull()) {
+        DependencyManager::get<LimitedNodeList>()->eachNode([&](const SharedNodePointer& otherNode) {
+            auto otherNodeData = static_cast<DomainServerNodeData*>(otherNode->getLinkedData());
+            if (otherNodeData && otherNodeData->getMixerShardID(node->getType()) == killedMixerID) {
+                otherNodeData->setMixerShardID(node->getType(), QUuid());
+            }
+        });
+    }
 }
 
 SharedAssignmentPointer DomainServer::dequeueMatchingAssignment(const QUuid& assignmentUUID, NodeType_t nodeType) {
@@ -15,6 +15,7 @@
 #define hifi_DomainServer_h
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QHash>
 #include <QtCore/QJsonObject>
 #include <QtCore/QQueue>
@@ -103,6 +104,8 @@ private slots:
     void processRequestAssignmentPacket(QSharedPointer<ReceivedMessage> packet);
     void processListRequestPacket(QSharedPointer<ReceivedMessage> packet, SharedNodePointer sendingNode);
     void processNodeJSONStatsPacket(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
+    void processSamplingProfileReply(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
+    void processMixerShardClientPositions(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer sendingNode);
     void processPathQueryPacket(QSharedPointer<ReceivedMessage> packet);
     void processNodeDisconnectRequestPacket(QSharedPointer<ReceivedMessage> message);
     void processICEServerHeartbeatDenialPacket(QSharedPointer<ReceivedMessage> message);
@@ -123,6 +126,9 @@ private slots:
     void sendHeartbeatToMetaverse() { sendHeartbeatToMetaverse(QString(), int()); }
     void sendHeartbeatToIceServer();
     void nodePingMonitor();
+    void checkMixerFailover();
+    void rebalanceMixerShards();
+    void sampleDomainListStats();
 
     void handleConnectedNode(SharedNodePointer newNode, quint64 requestReceiveTime);
     void handleTempDomainSuccess(QNetworkReply* requestReply);
@@ -206,6 +212,10 @@ private:
     void sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr& senderSockAddr, bool newConnection);
 
     bool isInInterestSet(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
+    bool isStandbyMixer(const SharedNodePointer& node);
+    bool isShardMixer(const SharedNodePointer& node);
+    QUuid shardForNode(const SharedNodePointer& node, NodeType_t mixerType);
+    int numMixerShards(Assignment::Type type);
 
     QUuid connectionSecretForNodes(const SharedNodePointer& nodeA, const SharedNodePointer& nodeB);
     void broadcastNewNode(const SharedNodePointer& node);
@@ -230,6 +240,9 @@ private:
     Headers setupCookieHeadersFromProfileReply(QNetworkReply* profileReply);
 
     QJsonObject jsonForSocket(const SockAddr& socket);
+
+    // asks the node for a profile to answer the admin's request with, see SamplingProfiler.h
+    void requestSamplingProfile(HTTPConnection* connection, const SharedNodePointer& node, const QUrl& url);
     QJsonObject jsonObjectForNode(const SharedNodePointer& node);
 
     bool shouldReplicateNode(const Node& node);
@@ -304,6 +317,18 @@ private:
     QTimer* _metaverseHeartbeatTimer { nullptr };
     QTimer* _metaverseGroupCacheTimer { nullptr };
     QTimer* _nodePingMonitorTimer { nullptr };
+    QTimer* _mixerFailoverTimer { nullptr };
+    QTimer* _mixerShardRebalanceTimer { nullptr };
+    QTimer* _domainListStatsTimer { nullptr };
+
+    // what the domain lists and their removals have cost since the last sample, and the rates of the last sample
+    QElapsedTimer _domainListStatsInterval;
+    quint64 _domainListBytesSent { 0 };
+    int _numFullDomainListsSent { 0 };
+    int _numDeltaDomainListsSent { 0 };
+    float _domainListBytesPerSecond { 0.0f };
+    float _fullDomainListsPerSecond { 0.0f };
+    float _deltaDomainListsPerSecond { 0.0f };
 
     QList<QHostAddress> _iceServerAddresses;
     QSet<QHostAddress> _failedIceServerAddresses;
@@ -332,6 +357,14 @@ private:
 
     QHash<QUuid, QPointer<HTTPSConnection>> _pendingOAuthConnections;
 
+    // the admin HTTP requests waiting on a node's sampling profile, by the ID of the request sent to the node
+    struct PendingSamplingProfile {
+        QUuid nodeID;
+        QPointer<HTTPConnection> connection;
+    };
+    QHash<quint32, PendingSamplingProfile> _pendingSamplingProfiles;
+    quint32 _lastSamplingProfileRequestID { 0 };
+
     std::unordered_map<int, QByteArray> _pendingUploadedContents;
     std::unordered_map<int, std::unique_ptr<QTemporaryFile>> _pendingContentFiles;
 
@@ -26,6 +26,9 @@
 #include <QRegularExpression>
 #include <QSet>
 
+#include <map>
+#include <vector>
+
 #include "DomainServerExporter.h"
 #include "DependencyManager.h"
 #include "LimitedNodeList.h"
@@ -285,6 +288,14 @@ static const QSet<QString> BLACKLIST = {
     "messages_mixer_messages_username"                          // Username
 };
 
+static const QString PERFORMANCE_STATS_KEY = "performance";
+static const QString PERFORMANCE_METRIC_PREFIX = "assignment_";
+
+// counters get too large for the stream's default six digits
+static QString formatValue(double value) {
+    return QString::number(value, 'g', 15);
+}
+
 DomainServerExporter::DomainServerExporter() {
 }
 
@@ -300,6 +311,7 @@ bool DomainServerExporter::handleHTTPRequest(HTTPConnection* connection, const Q
         QTextStream outStream(&output);
 
         nodeList->eachNode([this, &outStream](const SharedNodePointer& node) { generateMetricsForNode(outStream, node); });
+        generatePerformanceMetrics(outStream);
 
         connection->respond(HTTPConnection::StatusCode200, output.toUtf8(), qPrintable(EXPORTER_MIME_TYPE));
         return true;
@@ -344,6 +356,10 @@ QString DomainServerExporter::escapeName(const QString& name) {
 
 void DomainServerExporter::generateMetricsForNode(QTextStream& stream, const SharedNodePointer& node) {
     QJsonObject statsObject = static_cast<DomainServerNodeData*>(node->getLinkedData())->getStatsJSONObject();
+
+    // the performance counters are typed, they are exported once for all nodes by generatePerformanceMetrics
+    statsObject.remove(PERFORMANCE_STATS_KEY);
+
     QString nodeType = NodeType::getNodeTypeName(static_cast<NodeType_t>(node->getType()));
 
     stream << "\n\n\n";
@@ -354,6 +370,82 @@ void DomainServerExporter::generateMetricsForNode(QTextStream& stream, const Sha
     generateMetricsFromJson(stream, nodeType, escapeName(nodeType), QHash<QString, QString>(), statsObject);
 }
 
+void DomainServerExporter::generatePerformanceMetrics(QTextStream& stream) {
+    // every sample of a metric has to follow its TYPE line, so gather each metric's samples across the nodes first
+    struct NodeMetric {
+        QString labels;
+        QJsonObject metric;
+    };
+    struct Family {
+        QString type;
+        QString help;
+        std::vector<NodeMetric> nodeMetrics;
+    };
+    std::map<QString, Family> families;
+
+    static const std::vector<std::pair<QString, QString>> KINDS {
+        { "counters", "counter" }, { "gauges", "gauge" }, { "histograms", "histogram" }
+    };
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    nodeList->eachNode([&](const SharedNodePointer& node) {
+        auto nodeData = static_cast<DomainServerNodeData*>(node->getLinkedData());
+        if (!nodeData) {
+            return;
+        }
+
+        auto performance = nodeData->getStatsJSONObject()[PERFORMANCE_STATS_KEY].toObject();
+        auto labels = QString("node_type=\"%1\",uuid=\"%2\"")
+            .arg(escapeName(NodeType::getNodeTypeName(static_cast<NodeType_t>(node->getType()))))
+            .arg(node->getUUID().toString(QUuid::WithoutBraces));
+
+        for (const auto& kind : KINDS) {
+            auto metrics = performance[kind.first].toObject();
+            for (auto it = metrics.constBegin(); it != metrics.constEnd(); ++it) {
+                auto name = PERFORMANCE_METRIC_PREFIX + escapeName(it.key());
+                if (kind.second == "counter") {
+                    name += "_total";
+                }
+
+                auto& family = families[name];
+                family.type = kind.second;
+                family.help = it.value().toObject()["help"].toString();
+                family.nodeMetrics.push_back({ labels, it.value().toObject() });
+            }
+        }
+    });
+
+    for (const auto& entry : families) {
+        const auto& name = entry.first;
+        const auto& family = entry.second;
+
+        stream << "\n# HELP " << name << " " << family.help << "\n";
+        stream << "# TYPE " << name << " " << family.type << "\n";
+
+        for (const auto& nodeMetric : family.nodeMetrics) {
+            const auto& metric = nodeMetric.metric;
+            const auto& labels = nodeMetric.labels;
+
+            if (family.type != "histogram") {
+                stream << name << "{" << labels << "} " << formatValue(metric["value"].toDouble()) << "\n";
+                continue;
+            }
+
+            // the exported buckets are cumulative, ours aren't
+            auto bounds = metric["bounds"].toArray();
+            auto counts = metric["counts"].toArray();
+            double cumulative = 0.0;
+            for (int i = 0; i < counts.size(); ++i) {
+                cumulative += counts[i].toDouble();
+                auto bound = i < bounds.size() ? formatValue(bounds[i].toDouble()) : QString("+Inf");
+                stream << name << "_bucket{" << labels << ",le=\"" << bound << "\"} " << formatValue(cumulative) << "\n";
+            }
+            stream << name << "_sum{" << labels << "} " << formatValue(metric["sum"].toDouble()) << "\n";
+            stream << name << "_count{" << labels << "} " << formatValue(metric["count"].toDouble()) << "\n";
+        }
+    }
+}
+
 void DomainServerExporter::generateMetricsFromJson(QTextStream& stream,
                                                    QString originalPath,
                                                    QString path,
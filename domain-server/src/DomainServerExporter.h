@@ -50,6 +50,7 @@ public:
 private:
     QString escapeName(const QString &name);
     void generateMetricsForNode(QTextStream& stream, const SharedNodePointer& node);
+    void generatePerformanceMetrics(QTextStream& stream);
     void generateMetricsFromJson(QTextStream& stream, QString originalPath, QString path, QHash<QString, QString> labels, const QJsonObject& obj);
 };
 
@@ -12,6 +12,7 @@
 #include "DomainServerNodeData.h"
 
 #include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
@@ -25,10 +26,24 @@ DomainServerNodeData::DomainServerNodeData() {
     _paymentIntervalTimer.start();
 }
 
+quint32 DomainServerNodeData::nextDomainListVersion() {
+    // 0 is what a node that needs a full list asks with, so it's never used for a list
+    if (++_sentDomainListVersion == 0) {
+        ++_sentDomainListVersion;
+    }
+    return _sentDomainListVersion;
+}
+
 void DomainServerNodeData::updateJSONStats(QByteArray statsByteArray) {
     auto document = QJsonDocument::fromBinaryData(statsByteArray);
     Q_ASSERT(document.isObject());
     _statsJSONObject = overrideValuesIfNeeded(document.object());
+
+    static const QString PERFORMANCE_STATS_KEY = "performance";
+    if (_statsJSONObject.contains(PERFORMANCE_STATS_KEY)) {
+        _performanceHistory.addSample(_statsJSONObject[PERFORMANCE_STATS_KEY].toObject(),
+                                      QDateTime::currentMSecsSinceEpoch());
+    }
 }
 
 QJsonObject DomainServerNodeData::overrideValuesIfNeeded(const QJsonObject& newStats) {
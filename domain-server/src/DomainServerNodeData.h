@@ -19,11 +19,15 @@
 #include <QtCore/QUuid>
 #include <QtCore/QJsonObject>
 
+#include <glm/glm.hpp>
+
 #include <SockAddr.h>
 #include <NLPacket.h>
 #include <NodeData.h>
 #include <NodeType.h>
 
+#include "PerformanceHistory.h"
+
 class DomainServerNodeData : public NodeData {
 public:
     DomainServerNodeData();
@@ -31,6 +35,7 @@ public:
     const QJsonObject& getStatsJSONObject() const { return _statsJSONObject; }
 
     void updateJSONStats(QByteArray statsByteArray);
+    const PerformanceHistory& getPerformanceHistory() const { return _performanceHistory; }
 
     void setAssignmentUUID(const QUuid& assignmentUUID) { _assignmentUUID = assignmentUUID; }
     const QUuid& getAssignmentUUID() const { return _assignmentUUID; }
@@ -77,6 +82,27 @@ public:
 
     bool hasCheckedIn() const { return _hasCheckedIn; }
     void setHasCheckedIn(bool hasCheckedIn) { _hasCheckedIn = hasCheckedIn; }
+
+    // the shard of each sharded mixer type this node was assigned to, null until it is
+    QUuid getMixerShardID(NodeType_t mixerType) const { return _mixerShardIDs.value(mixerType); }
+    void setMixerShardID(NodeType_t mixerType, const QUuid& shardID) { _mixerShardIDs[mixerType] = shardID; }
+
+    // where this node's avatar was when its shard last told us, which the shards are rebalanced by region with
+    bool hasAvatarPosition() const { return _hasAvatarPosition; }
+    const glm::vec3& getAvatarPosition() const { return _avatarPosition; }
+    void setAvatarPosition(const glm::vec3& position) { _avatarPosition = position; _hasAvatarPosition = true; }
+
+    // the version of the last domain list sent to this node, and of the last one it told us it applied
+    quint32 getSentDomainListVersion() const { return _sentDomainListVersion; }
+    quint32 nextDomainListVersion();
+    void setAppliedDomainListVersion(quint32 appliedDomainListVersion) { _appliedDomainListVersion = appliedDomainListVersion; }
+    quint32 getAppliedDomainListVersion() const { return _appliedDomainListVersion; }
+
+    // the node and secret last sent to this node for each node in its list, so later lists can carry only what changed
+    QHash<QUuid, QByteArray>& getSentDomainListEntries() { return _sentDomainListEntries; }
+
+    int getDomainListsSinceSnapshot() const { return _domainListsSinceSnapshot; }
+    void setDomainListsSinceSnapshot(int domainListsSinceSnapshot) { _domainListsSinceSnapshot = domainListsSinceSnapshot; }
     
 private:
     QJsonObject overrideValuesIfNeeded(const QJsonObject& newStats);
@@ -90,6 +116,7 @@ private:
     
     using StringPairHash = QHash<QPair<QString, QString>, QString>;
     QJsonObject _statsJSONObject;
+    PerformanceHistory _performanceHistory;
     static StringPairHash _overrideHash;
     
     SockAddr _sendingSockAddr;
@@ -104,6 +131,15 @@ private:
     bool _wasAssigned { false };
 
     bool _hasCheckedIn { false };
+
+    QHash<NodeType_t, QUuid> _mixerShardIDs;
+    glm::vec3 _avatarPosition;
+    bool _hasAvatarPosition { false };
+
+    quint32 _sentDomainListVersion { 0 };
+    quint32 _appliedDomainListVersion { 0 };
+    QHash<QUuid, QByteArray> _sentDomainListEntries;
+    int _domainListsSinceSnapshot { 0 };
 };
 
 #endif // hifi_DomainServerNodeData_h
@@ -27,6 +27,8 @@
 
 #include <OctreeDataUtils.h>
 
+#include "BackupFileUtils.h"
+
 EntitiesBackupHandler::EntitiesBackupHandler(QString entitiesFilePath, QString entitiesReplacementFilePath) :
     _entitiesFilePath(entitiesFilePath),
     _entitiesReplacementFilePath(entitiesReplacementFilePath)
@@ -39,20 +41,9 @@ void EntitiesBackupHandler::createBackup(const QString& backupName, QuaZip& zip)
     QFile entitiesFile { _entitiesFilePath };
 
     if (entitiesFile.open(QIODevice::ReadOnly)) {
-        QuaZipFile zipFile { &zip };
-        if (!zipFile.open(QIODevice::WriteOnly, QuaZipNewInfo(ENTITIES_BACKUP_FILENAME, _entitiesFilePath))) {
-            qCritical().nospace() << "Failed to open " << ENTITIES_BACKUP_FILENAME << " for writing in zip";
-            return;
-        }
-        auto entityData = entitiesFile.readAll();
-        if (zipFile.write(entityData) != entityData.size()) {
+        // the entities file is already gzipped, so it is streamed into the zip as is
+        if (!BackupFileUtils::writeToZip(entitiesFile, zip, ENTITIES_BACKUP_FILENAME, false, _entitiesFilePath)) {
             qCritical() << "Failed to write entities file to backup";
-            zipFile.close();
-            return;
-        }
-        zipFile.close();
-        if (zipFile.getZipError() != UNZ_OK) {
-            qCritical().nospace() << "Failed to zip " << ENTITIES_BACKUP_FILENAME << ": " << zipFile.getZipError();
         }
     }
 }
@@ -31,6 +31,7 @@ public:
     SockAddr senderSockAddr;
     QList<NodeType_t> interestList;
     QString placeName;
+    quint32 domainListVersion { 0 }; // the last domain list a list request's sender applied, 0 if it needs a full one
     QString hardwareAddress;
     QUuid machineFingerprint;
     QString SystemInfo;
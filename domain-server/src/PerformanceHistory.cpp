@@ -0,0 +1,164 @@
+//
+//  PerformanceHistory.cpp
+//  domain-server/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PerformanceHistory.h"
+
+#include <algorithm>
+
+static const QString OVERRUNS_SUFFIX = "_overruns";
+static const QString QUEUE_DEPTH_SUFFIX = "_queue_depth";
+static const QString RATE_SUFFIX = "_per_second";
+
+static const int ALERT_WINDOW = 10;
+static const float SUSTAINED_OVERRUN_RATIO = 0.5f; // of the samples in the window
+static const float QUEUE_GROWTH_RATIO = 0.75f; // of the steps in the window
+
+// the value below which the fraction of what the histogram counted lies, from its per bucket counts
+static double getQuantile(const QJsonArray& bounds, const std::vector<double>& counts, double total, double fraction) {
+    double target = total * fraction;
+    double cumulative = 0.0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        cumulative += counts[i];
+        if (cumulative >= target) {
+            // values above the last bound are reported as the last bound
+            return bounds.at(std::min((int)i, bounds.size() - 1)).toDouble();
+        }
+    }
+    return bounds.isEmpty() ? 0.0 : bounds.last().toDouble();
+}
+
+void PerformanceHistory::addSample(const QJsonObject& performance, qint64 timestampMsecs) {
+    Sample sample;
+    sample.timestamp = timestampMsecs;
+
+    double seconds = _lastTimestamp > 0 ? std::max((double)(timestampMsecs - _lastTimestamp) / 1000.0, 0.001) : 0.0;
+
+    auto counters = performance["counters"].toObject();
+    auto lastCounters = _lastPerformance["counters"].toObject();
+    for (auto it = counters.constBegin(); it != counters.constEnd(); ++it) {
+        if (seconds > 0.0 && lastCounters.contains(it.key())) {
+            double value = it.value().toObject()["value"].toDouble();
+            double lastValue = lastCounters[it.key()].toObject()["value"].toDouble();
+            // a counter that went down was reset by a new assignment, and counted up from zero since
+            double increase = value >= lastValue ? value - lastValue : value;
+            sample.values[it.key() + RATE_SUFFIX] = increase / seconds;
+        }
+    }
+
+    auto gauges = performance["gauges"].toObject();
+    for (auto it = gauges.constBegin(); it != gauges.constEnd(); ++it) {
+        sample.values[it.key()] = it.value().toObject()["value"].toDouble();
+    }
+
+    auto histograms = performance["histograms"].toObject();
+    auto lastHistograms = _lastPerformance["histograms"].toObject();
+    for (auto it = histograms.constBegin(); it != histograms.constEnd(); ++it) {
+        auto histogram = it.value().toObject();
+        auto counts = histogram["counts"].toArray();
+        auto lastHistogram = lastHistograms[it.key()].toObject();
+        auto lastCounts = lastHistogram["counts"].toArray();
+
+        bool wasReset = histogram["count"].toDouble() < lastHistogram["count"].toDouble();
+        bool hasLast = lastCounts.size() == counts.size() && !wasReset;
+
+        std::vector<double> intervalCounts(counts.size());
+        double total = 0.0;
+        for (int i = 0; i < counts.size(); ++i) {
+            intervalCounts[i] = counts[i].toDouble() - (hasLast ? lastCounts[i].toDouble() : 0.0);
+            total += intervalCounts[i];
+        }
+        if (total <= 0.0) {
+            continue;
+        }
+
+        auto bounds = histogram["bounds"].toArray();
+        double sum = histogram["sum"].toDouble() - (hasLast ? lastHistogram["sum"].toDouble() : 0.0);
+        sample.values[it.key() + "_p50"] = getQuantile(bounds, intervalCounts, total, 0.5);
+        sample.values[it.key() + "_p99"] = getQuantile(bounds, intervalCounts, total, 0.99);
+        sample.values[it.key() + "_mean"] = sum / total;
+    }
+
+    _lastPerformance = performance;
+    _lastTimestamp = timestampMsecs;
+
+    _samples[_next] = sample;
+    _next = (_next + 1) % CAPACITY;
+    _numSamples = std::min(_numSamples + 1, CAPACITY);
+}
+
+const PerformanceHistory::Sample& PerformanceHistory::getSample(int age) const {
+    return _samples[(_next - 1 - age + CAPACITY) % CAPACITY];
+}
+
+QJsonObject PerformanceHistory::getSeries() const {
+    QHash<QString, QJsonArray> series;
+    for (int age = _numSamples - 1; age >= 0; --age) {
+        const auto& sample = getSample(age);
+        for (auto it = sample.values.constBegin(); it != sample.values.constEnd(); ++it) {
+            series[it.key()].append(QJsonArray { (double)sample.timestamp, it.value() });
+        }
+    }
+
+    QJsonObject seriesObject;
+    for (auto it = series.constBegin(); it != series.constEnd(); ++it) {
+        seriesObject[it.key()] = it.value();
+    }
+    return seriesObject;
+}
+
+QJsonArray PerformanceHistory::getAlerts() const {
+    QJsonArray alerts;
+    if (_numSamples == 0) {
+        return alerts;
+    }
+
+    int window = std::min(_numSamples, ALERT_WINDOW);
+    const auto& newest = getSample(0);
+
+    for (auto it = newest.values.constBegin(); it != newest.values.constEnd(); ++it) {
+        const auto& name = it.key();
+
+        if (name.endsWith(OVERRUNS_SUFFIX + RATE_SUFFIX)) {
+            int numOverrunning = 0;
+            for (int age = 0; age < window; ++age) {
+                if (getSample(age).values.value(name) > 0.0) {
+                    ++numOverrunning;
+                }
+            }
+
+            if (window == ALERT_WINDOW && numOverrunning >= SUSTAINED_OVERRUN_RATIO * window) {
+                alerts.append(QJsonObject {
+                    { "metric", name.left(name.size() - RATE_SUFFIX.size()) },
+                    { "alert", "sustained_overruns" },
+                    { "value", it.value() }
+                });
+            }
+        } else if (name.endsWith(QUEUE_DEPTH_SUFFIX)) {
+            int numRises = 0;
+            for (int age = 0; age < window - 1; ++age) {
+                if (getSample(age).values.value(name) > getSample(age + 1).values.value(name)) {
+                    ++numRises;
+                }
+            }
+
+            bool hasGrown = it.value() > getSample(window - 1).values.value(name);
+            if (window == ALERT_WINDOW && hasGrown && numRises >= QUEUE_GROWTH_RATIO * (window - 1)) {
+                alerts.append(QJsonObject {
+                    { "metric", name },
+                    { "alert", "queue_growth" },
+                    { "value", it.value() }
+                });
+            }
+        }
+    }
+
+    return alerts;
+}
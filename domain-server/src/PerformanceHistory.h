@@ -0,0 +1,54 @@
+//
+//  PerformanceHistory.h
+//  domain-server/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PerformanceHistory_h
+#define hifi_PerformanceHistory_h
+
+#include <array>
+
+#include <QtCore/QHash>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+
+// The last few minutes of the performance counters one node sent with its stats, as time series: counters become rates
+// per second, gauges are kept as they are, and histograms become the median, 99th percentile and mean of what they
+// counted between samples. Alerts are raised for frames overrunning in most recent samples and for queues that keep
+// growing, going by the counter and gauge naming conventions of PerformanceCounters.
+class PerformanceHistory {
+public:
+    static const int CAPACITY = 300; // five minutes of stats at one a second
+
+    // adds the "performance" object of a node's stats
+    void addSample(const QJsonObject& performance, qint64 timestampMsecs);
+
+    // { name: [[msecs since the epoch, value], ...] } oldest first
+    QJsonObject getSeries() const;
+
+    // [{ "metric", "alert", "value" }]
+    QJsonArray getAlerts() const;
+
+private:
+    struct Sample {
+        qint64 timestamp { 0 };
+        QHash<QString, double> values;
+    };
+
+    const Sample& getSample(int age) const; // 0 is the newest
+
+    std::array<Sample, CAPACITY> _samples;
+    int _numSamples { 0 };
+    int _next { 0 };
+
+    QJsonObject _lastPerformance;
+    qint64 _lastTimestamp { 0 };
+};
+
+#endif // hifi_PerformanceHistory_h
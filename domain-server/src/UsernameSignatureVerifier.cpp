@@ -0,0 +1,49 @@
+//
+//  UsernameSignatureVerifier.cpp
+//  domain-server/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UsernameSignatureVerifier.h"
+
+#include <openssl/rsa.h>
+#include <openssl/x509.h>
+
+UsernameSignatureVerifier::UsernameSignatureVerifier(const QString& username, const QByteArray& publicKey,
+                                                     const QByteArray& usernameWithToken,
+                                                     const QByteArray& usernameSignature) :
+    _username(username),
+    _publicKey(publicKey),
+    _usernameWithToken(usernameWithToken),
+    _usernameSignature(usernameSignature)
+{
+}
+
+void UsernameSignatureVerifier::run() {
+    const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(_publicKey.constData());
+
+    // first load up the public key into an RSA struct
+    RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, _publicKey.size());
+
+    if (!rsaPublicKey) {
+        emit verified(_username, _publicKey, _usernameSignature, false, false);
+        return;
+    }
+
+    int decryptResult = RSA_verify(NID_sha256,
+                                   reinterpret_cast<const unsigned char*>(_usernameWithToken.constData()),
+                                   _usernameWithToken.size(),
+                                   reinterpret_cast<const unsigned char*>(_usernameSignature.constData()),
+                                   _usernameSignature.size(),
+                                   rsaPublicKey);
+
+    // free up the public key, we don't need it anymore
+    RSA_free(rsaPublicKey);
+
+    emit verified(_username, _publicKey, _usernameSignature, true, decryptResult == 1);
+}
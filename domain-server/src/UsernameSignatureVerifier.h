@@ -0,0 +1,39 @@
+//
+//  UsernameSignatureVerifier.h
+//  domain-server/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UsernameSignatureVerifier_h
+#define hifi_UsernameSignatureVerifier_h
+
+#include <QtCore/QObject>
+#include <QtCore/QRunnable>
+
+// Checks the signature a connecting user made of their username and connection token against their public key, on a
+// thread pool rather than the domain-server's main thread.
+class UsernameSignatureVerifier : public QObject, public QRunnable {
+    Q_OBJECT
+public:
+    UsernameSignatureVerifier(const QString& username, const QByteArray& publicKey, const QByteArray& usernameWithToken,
+                              const QByteArray& usernameSignature);
+
+    virtual void run() override;
+
+signals:
+    // isKeyValid is false if the public key couldn't be loaded, in which case the signature wasn't checked
+    void verified(QString username, QByteArray publicKey, QByteArray usernameSignature, bool isKeyValid, bool isMatch);
+
+private:
+    QString _username;
+    QByteArray _publicKey;
+    QByteArray _usernameWithToken;
+    QByteArray _usernameSignature;
+};
+
+#endif // hifi_UsernameSignatureVerifier_h
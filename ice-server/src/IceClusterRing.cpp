@@ -0,0 +1,56 @@
+//
+//  IceClusterRing.cpp
+//  ice-server/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "IceClusterRing.h"
+
+#include <algorithm>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QtEndian>
+
+IceClusterRing::IceClusterRing(const QStringList& instances) :
+    _instances(instances)
+{
+    // sorted so that every instance numbers the others the same way, whatever order they were listed in
+    _instances.removeDuplicates();
+    _instances.sort();
+
+    _points.reserve(_instances.size() * POINTS_PER_INSTANCE);
+    for (int i = 0; i < _instances.size(); ++i) {
+        for (int point = 0; point < POINTS_PER_INSTANCE; ++point) {
+            auto key = (_instances[i] + "#" + QString::number(point)).toUtf8();
+            _points.emplace_back(hashKey(key), i);
+        }
+    }
+
+    std::sort(_points.begin(), _points.end());
+}
+
+int IceClusterRing::getOwner(const QUuid& domainID) const {
+    if (_points.empty()) {
+        return -1;
+    }
+
+    // the owner is the first point at or after the domain's hash, going around the ring
+    auto hash = hashKey(domainID.toRfc4122());
+    auto it = std::lower_bound(_points.begin(), _points.end(), hash, [](const std::pair<quint64, int>& point, quint64 hash) {
+        return point.first < hash;
+    });
+    if (it == _points.end()) {
+        it = _points.begin();
+    }
+    return it->second;
+}
+
+quint64 IceClusterRing::hashKey(const QByteArray& key) {
+    auto digest = QCryptographicHash::hash(key, QCryptographicHash::Sha1);
+    return qFromBigEndian<quint64>(reinterpret_cast<const uchar*>(digest.constData()));
+}
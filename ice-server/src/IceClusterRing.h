@@ -0,0 +1,49 @@
+//
+//  IceClusterRing.h
+//  ice-server/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_IceClusterRing_h
+#define hifi_IceClusterRing_h
+
+#include <vector>
+
+#include <QtCore/QStringList>
+#include <QtCore/QUuid>
+
+/// Assigns each domain ID to one of the ICE server instances of a cluster by consistent hashing, so that every instance
+/// agrees on a domain's owner without talking to the others, and adding or removing an instance only moves the domains
+/// of its share of the ring.
+class IceClusterRing {
+public:
+    static const int POINTS_PER_INSTANCE = 128;
+
+    IceClusterRing() = default;
+
+    /// Takes the names every instance of the cluster is configured with, the order they're in doesn't matter.
+    IceClusterRing(const QStringList& instances);
+
+    bool isEmpty() const { return _instances.isEmpty(); }
+
+    /// The instances in the same order on every instance, so that they can refer to each other by index.
+    const QStringList& getInstances() const { return _instances; }
+    int indexOf(const QString& instance) const { return _instances.indexOf(instance); }
+
+    /// Returns the index in getInstances() of the instance that owns the domain, or -1 if the ring is empty.
+    int getOwner(const QUuid& domainID) const;
+
+private:
+    // the hashes have to be the same on every instance, whatever the platform, so no qHash
+    static quint64 hashKey(const QByteArray& key);
+
+    QStringList _instances;
+    std::vector<std::pair<quint64, int>> _points;
+};
+
+#endif // hifi_IceClusterRing_h
@@ -0,0 +1,329 @@
+//
+//  IcePeerShard.cpp
+//  ice-server/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "IcePeerShard.h"
+
+#include <openssl/x509.h>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QNetworkReply>
+#include <QtNetwork/QNetworkRequest>
+
+#include <MetaverseAPI.h>
+#include <NetworkAccessManager.h>
+#include <SharedUtil.h>
+#include <UUID.h>
+
+#include "IceServer.h"
+
+const int CLEAR_INACTIVE_PEERS_INTERVAL_MSECS = 1 * 1000;
+const int PEER_SILENCE_THRESHOLD_MSECS = 5 * 1000;
+
+// a registration is refreshed with every heartbeat the domain sends its instance, so it can outlive one lost packet
+const int CLUSTER_REGISTRATION_SILENCE_THRESHOLD_MSECS = 2 * PEER_SILENCE_THRESHOLD_MSECS;
+
+// a query goes from the instance that got it to the domain's owner, and from there to the instance the domain
+// heartbeats with
+const int MAX_CLUSTER_QUERY_HOPS = 2;
+
+IcePeerShard::IcePeerShard(IceServer& server) :
+    _server(server)
+{
+}
+
+void IcePeerShard::start() {
+    // setup our timer to clear inactive peers
+    QTimer* inactivePeerTimer = new QTimer(this);
+    connect(inactivePeerTimer, &QTimer::timeout, this, &IcePeerShard::clearInactivePeers);
+    inactivePeerTimer->start(CLEAR_INACTIVE_PEERS_INTERVAL_MSECS);
+}
+
+void IcePeerShard::processHeartbeat(const QByteArray& payload, const SockAddr& senderSockAddr) {
+    SharedNetworkPeer peer = addOrUpdateHeartbeatingPeer(payload);
+    if (peer) {
+        // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
+        peer->activateMatchingOrNewSymmetricSocket(senderSockAddr);
+
+        // we have an active and verified heartbeating peer
+        // send them an ACK packet so they know that they are being heard and ready for ICE
+        _server.sendPacket(PacketType::ICEServerHeartbeatACK, QByteArray(), senderSockAddr);
+
+        // let the domain's owner know where to find it, for queries that other instances get
+        const auto& ring = _server.getClusterRing();
+        int owner = ring.getOwner(peer->getUUID());
+        if (owner != -1 && owner != _server.getClusterInstance()) {
+            _server.sendClusterPacket(PacketType::ICEClusterRegistration, peer->getUUID().toRfc4122(), owner);
+        }
+    } else {
+        // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
+        _server.sendPacket(PacketType::ICEServerHeartbeatDenied, QByteArray(), senderSockAddr);
+    }
+}
+
+void IcePeerShard::processQuery(const IceQuery& query, int originInstance, int hops) {
+    SharedNetworkPeer matchingPeer = _activePeers.value(query.connectRequestID);
+
+    if (matchingPeer) {
+        qDebug() << "Sending information for peer" << query.connectRequestID << "to peer" << query.senderUUID;
+
+        // we have the peer they want to connect to - send them pack the information for that peer
+        if (originInstance == -1) {
+            sendPeerInformationPacket(*matchingPeer, query.clientSockAddr);
+        } else {
+            // the node has to hear back from the instance it asked
+            QByteArray payload;
+            QDataStream payloadStream(&payload, QIODevice::WriteOnly);
+            payloadStream << query.clientSockAddr;
+            payload.append(matchingPeer->toByteArray());
+            _server.sendClusterPacket(PacketType::ICEClusterPeerInformation, payload, originInstance);
+        }
+
+        // we also need to send them to the active peer they are hoping to connect to
+        // create a dummy peer object we can pass to sendPeerInformationPacket
+        NetworkPeer dummyPeer(query.senderUUID, query.publicSocket, query.localSocket);
+        sendPeerInformationPacket(dummyPeer, *matchingPeer->getActiveSocket());
+        return;
+    }
+
+    // in a cluster the peer may be heartbeating with another instance, which its owner knows
+    const auto& ring = _server.getClusterRing();
+    int self = _server.getClusterInstance();
+    int nextInstance = -1;
+    if (!ring.isEmpty() && hops < MAX_CLUSTER_QUERY_HOPS) {
+        int owner = ring.getOwner(query.connectRequestID);
+        if (owner != self) {
+            nextInstance = owner;
+        } else {
+            auto registration = _clusterRegistrations.find(query.connectRequestID);
+            if (registration != _clusterRegistrations.end() && registration->homeInstance != self) {
+                nextInstance = registration->homeInstance;
+            }
+        }
+    }
+
+    if (nextInstance == -1) {
+        qDebug() << "Peer" << query.senderUUID << "asked for" << query.connectRequestID << "but no matching peer found";
+        return;
+    }
+
+    QByteArray payload;
+    QDataStream payloadStream(&payload, QIODevice::WriteOnly);
+    payloadStream << query.senderUUID << query.publicSocket << query.localSocket << query.connectRequestID
+        << query.clientSockAddr << (quint8)(originInstance == -1 ? self : originInstance) << (quint8)(hops + 1);
+    _server.sendClusterPacket(PacketType::ICEClusterQuery, payload, nextInstance);
+}
+
+void IcePeerShard::processClusterRegistration(const QUuid& domainID, int homeInstance) {
+    _clusterRegistrations[domainID] = { homeInstance, usecTimestampNow() };
+}
+
+SharedNetworkPeer IcePeerShard::addOrUpdateHeartbeatingPeer(const QByteArray& payload) {
+
+    // pull the UUID, public and private sock addrs for this peer
+    QUuid senderUUID;
+    SockAddr publicSocket, localSocket;
+    QByteArray signature;
+
+    QDataStream heartbeatStream(payload);
+    heartbeatStream >> senderUUID >> publicSocket >> localSocket;
+
+    auto signedPlaintext = QByteArray::fromRawData(payload.constData(), heartbeatStream.device()->pos());
+    heartbeatStream >> signature;
+
+    // make sure this is a verified heartbeat before performing any more processing
+    if (isVerifiedHeartbeat(senderUUID, signedPlaintext, signature)) {
+        // make sure we have this sender in our peer hash
+        SharedNetworkPeer matchingPeer = _activePeers.value(senderUUID);
+
+        if (!matchingPeer) {
+            // if we don't have this sender we need to create them now
+            matchingPeer = QSharedPointer<NetworkPeer>::create(senderUUID, publicSocket, localSocket);
+            _activePeers.insert(senderUUID, matchingPeer);
+
+            qDebug() << "Added a new network peer" << *matchingPeer;
+        } else {
+            // we already had the peer so just potentially update their sockets
+            matchingPeer->setPublicSocket(publicSocket);
+            matchingPeer->setLocalSocket(localSocket);
+        }
+
+        // update our last heard microstamp for this network peer to now
+        matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
+
+        return matchingPeer;
+    } else {
+        // not verified, return the empty peer object
+        return SharedNetworkPeer();
+    }
+}
+
+bool IcePeerShard::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
+    // make sure we're not already waiting for a public key for this domain-server
+    if (!_pendingPublicKeyRequests.contains(domainID)) {
+        // check if we have a public key for this domain ID - if we do not then fire off the request for it
+        auto it = _domainPublicKeys.find(domainID);
+        if (it != _domainPublicKeys.end()) {
+
+            // attempt to verify the signature for this heartbeat
+            const auto rsaPublicKey = it->second.get();
+
+            if (rsaPublicKey) {
+                auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
+                int verificationResult = RSA_verify(NID_sha256,
+                                                    reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
+                                                    hashedPlaintext.size(),
+                                                    reinterpret_cast<const unsigned char*>(signature.constData()),
+                                                    signature.size(),
+                                                    rsaPublicKey);
+
+                if (verificationResult == 1) {
+                    // this is the only success case - we return true here to indicate that the heartbeat is verified
+                    return true;
+                } else {
+                    qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
+                }
+
+            } else {
+                // we can't let this user in since we couldn't convert their public key to an RSA key we could use
+                qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
+                qWarning() << "Re-requesting public key from API";
+            }
+        }
+
+        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
+        // ask the metaverse API for the right public key and return false to indicate that this is not verified
+        requestDomainPublicKey(domainID);
+    }
+
+    return false;
+}
+
+void IcePeerShard::requestDomainPublicKey(const QUuid& domainID) {
+    // send a request to the metaverse API for the public key for this domain
+    // each thread has its own network access manager, this shard's is only used from here
+    auto& networkAccessManager = NetworkAccessManager::getInstance();
+    if (!_isHandlingPublicKeyReplies) {
+        // handle public keys when they arrive from the QNetworkAccessManager
+        connect(&networkAccessManager, &QNetworkAccessManager::finished, this, &IcePeerShard::publicKeyReplyFinished);
+        _isHandlingPublicKeyReplies = true;
+    }
+
+    QUrl publicKeyURL{ MetaverseAPI::getCurrentMetaverseServerURL() };
+    QString publicKeyPath = QString("/api/v1/domains/%1/public_key").arg(uuidStringWithoutCurlyBraces(domainID));
+    publicKeyURL.setPath("/" + MetaverseAPI::getCurrentMetaverseServerURLPath() + publicKeyPath);
+
+    QNetworkRequest publicKeyRequest { publicKeyURL };
+    publicKeyRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
+    publicKeyRequest.setAttribute(QNetworkRequest::User, domainID);
+
+    qDebug() << "Requesting public key for domain with ID" << domainID;
+
+    // add this to the set of pending public key requests
+    _pendingPublicKeyRequests.insert(domainID);
+
+    networkAccessManager.get(publicKeyRequest);
+}
+
+void IcePeerShard::publicKeyReplyFinished(QNetworkReply* reply) {
+    // get the domain ID from the QNetworkReply attribute
+    QUuid domainID = reply->request().attribute(QNetworkRequest::User).toUuid();
+
+    if (reply->error() == QNetworkReply::NoError) {
+        // pull out the public key and store it for this domain
+
+        // the response should be JSON
+        QJsonDocument responseDocument = QJsonDocument::fromJson(reply->readAll());
+
+        static const QString DATA_KEY = "data";
+        static const QString PUBLIC_KEY_KEY = "public_key";
+        static const QString STATUS_KEY = "status";
+        static const QString SUCCESS_VALUE = "success";
+
+        auto responseObject = responseDocument.object();
+        if (responseObject[STATUS_KEY].toString() == SUCCESS_VALUE) {
+            auto dataObject = responseObject[DATA_KEY].toObject();
+            if (dataObject.contains(PUBLIC_KEY_KEY)) {
+
+                // grab the base 64 public key from the API response
+                auto apiPublicKey = QByteArray::fromBase64(dataObject[PUBLIC_KEY_KEY].toString().toUtf8());
+
+                // convert the downloaded public key to an RSA struct, if possible
+                const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(apiPublicKey.constData());
+
+                RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, apiPublicKey.size());
+
+                if (rsaPublicKey) {
+                    _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
+                } else {
+                    qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
+                    qWarning() << "Public key will be re-requested on next heartbeat.";
+                }
+
+            } else {
+                qWarning() << "There was no public key present in response for domain with ID" << domainID;
+            }
+        } else {
+            qWarning() << "The metaverse API did not return success for public key request for domain with ID" << domainID;
+        }
+
+    } else {
+        // there was a problem getting the public key for the domain
+        // log it since it will be re-requested on the next heartbeat
+
+        qWarning() << "Error retreiving public key for domain with ID" << domainID << "-" <<  reply->errorString();
+    }
+
+    // remove this domain ID from the list of pending public key requests
+    _pendingPublicKeyRequests.remove(domainID);
+
+    reply->deleteLater();
+}
+
+void IcePeerShard::sendPeerInformationPacket(const NetworkPeer& peer, const SockAddr& destinationSockAddr) {
+    // get the byte array for this peer
+    _server.sendPacket(PacketType::ICEServerPeerInformation, peer.toByteArray(), destinationSockAddr);
+}
+
+void IcePeerShard::clearInactivePeers() {
+    auto now = usecTimestampNow();
+
+    NetworkPeerHash::iterator peerItem = _activePeers.begin();
+
+    while (peerItem != _activePeers.end()) {
+        SharedNetworkPeer peer = peerItem.value();
+
+        if ((now - peer->getLastHeardMicrostamp()) > (PEER_SILENCE_THRESHOLD_MSECS * 1000)) {
+            qDebug() << "Removing peer from memory for inactivity -" << *peer;
+
+            // if we had a public key for this domain, remove it now
+            _domainPublicKeys.erase(peer->getUUID());
+
+            // remove the peer object
+            peerItem = _activePeers.erase(peerItem);
+        } else {
+            // we didn't kill this peer, push the iterator forwards
+            ++peerItem;
+        }
+    }
+
+    auto registration = _clusterRegistrations.begin();
+    while (registration != _clusterRegistrations.end()) {
+        if ((now - registration->lastHeardMicrostamp) > (CLUSTER_REGISTRATION_SILENCE_THRESHOLD_MSECS * 1000)) {
+            registration = _clusterRegistrations.erase(registration);
+        } else {
+            ++registration;
+        }
+    }
+}
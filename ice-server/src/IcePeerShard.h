@@ -0,0 +1,90 @@
+//
+//  IcePeerShard.h
+//  ice-server/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_IcePeerShard_h
+#define hifi_IcePeerShard_h
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QSet>
+
+#include <openssl/rsa.h>
+
+#include <UUIDHasher.h>
+
+#include <NetworkPeer.h>
+#include <SockAddr.h>
+
+class IceServer;
+class QNetworkReply;
+
+/// A query for the sockets of a heartbeating peer, from the node at clientSockAddr.
+struct IceQuery {
+    QUuid senderUUID;
+    SockAddr publicSocket;
+    SockAddr localSocket;
+    QUuid connectRequestID;
+    SockAddr clientSockAddr;
+};
+
+/// The heartbeating peers of a share of the domain IDs, and everything else the ICE server keeps per domain, on a thread
+/// of its own so that heartbeats for different domains are verified in parallel. Every call is made on the shard's thread.
+class IcePeerShard : public QObject {
+    Q_OBJECT
+public:
+    IcePeerShard(IceServer& server);
+
+    void start();
+
+    void processHeartbeat(const QByteArray& payload, const SockAddr& senderSockAddr);
+
+    /// Answers a query, from a node of ours when originInstance is -1 or else relayed by the given cluster instance.
+    void processQuery(const IceQuery& query, int originInstance = -1, int hops = 0);
+
+    /// Records that a domain whose owner is this instance heartbeats with another.
+    void processClusterRegistration(const QUuid& domainID, int homeInstance);
+
+private slots:
+    void clearInactivePeers();
+    void publicKeyReplyFinished(QNetworkReply* reply);
+
+private:
+    SharedNetworkPeer addOrUpdateHeartbeatingPeer(const QByteArray& payload);
+    void sendPeerInformationPacket(const NetworkPeer& peer, const SockAddr& destinationSockAddr);
+
+    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
+    void requestDomainPublicKey(const QUuid& domainID);
+
+    IceServer& _server;
+
+    using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
+    NetworkPeerHash _activePeers;
+
+    using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
+    using DomainPublicKeyHash = std::unordered_map<QUuid, RSAUniquePtr>;
+    DomainPublicKeyHash _domainPublicKeys;
+
+    QSet<QUuid> _pendingPublicKeyRequests;
+    bool _isHandlingPublicKeyReplies { false };
+
+    // the instance each domain this one owns heartbeats with, and when it last said so
+    struct ClusterRegistration {
+        int homeInstance;
+        quint64 lastHeardMicrostamp;
+    };
+    QHash<QUuid, ClusterRegistration> _clusterRegistrations;
+};
+
+#endif // hifi_IcePeerShard_h
@@ -13,35 +13,98 @@
 
 #include "IceServer.h"
 
-#include <openssl/x509.h>
+#include <algorithm>
 
+#include <QtCore/QCommandLineParser>
 #include <QtCore/QDataStream>
-#include <QtCore/QJsonDocument>
-#include <QtCore/QJsonObject>
-#include <QtCore/QTimer>
-#include <QtNetwork/QNetworkReply>
-#include <QtNetwork/QNetworkRequest>
-#include <QtCore/QSharedPointer>
+#include <QtCore/QtEndian>
 
 #include <LimitedNodeList.h>
-#include <NetworkAccessManager.h>
 #include <NetworkingConstants.h>
-#include <MetaverseAPI.h>
+#include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
 #include <SharedUtil.h>
+#include <UUID.h>
 
-const int CLEAR_INACTIVE_PEERS_INTERVAL_MSECS = 1 * 1000;
-const int PEER_SILENCE_THRESHOLD_MSECS = 5 * 1000;
+// cluster packets are signed with the cluster's secret, and only accepted for a while after they were sent
+static const int CLUSTER_PACKET_HASH_SIZE = 32;
+static const quint64 MAX_CLUSTER_PACKET_AGE_USECS = 30 * USECS_PER_SECOND;
 
 IceServer::IceServer(int argc, char* argv[]) :
     QCoreApplication(argc, argv),
-    _id(QUuid::createUuid()),
-    _serverSocket(0, false),
-    _activePeers()
+    _serverSocket(0, false)
 {
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Vircadia ICE server");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption portOption("port", "UDP port to listen on", "port", QString::number(ICE_SERVER_DEFAULT_PORT));
+    parser.addOption(portOption);
+
+    const QCommandLineOption threadsOption("threads", "number of threads the peers are split between", "count");
+    parser.addOption(threadsOption);
+
+    const QCommandLineOption clusterOption("cluster", "comma separated HOST:PORT of every instance of the cluster",
+                                           "instances");
+    parser.addOption(clusterOption);
+
+    const QCommandLineOption clusterSelfOption("cluster-self", "HOST:PORT of this instance, as given in --cluster",
+                                               "instance");
+    parser.addOption(clusterSelfOption);
+
+    const QCommandLineOption clusterSecretOption("cluster-secret",
+        "secret shared by the instances of the cluster, defaults to the ICE_CLUSTER_SECRET environment variable", "secret");
+    parser.addOption(clusterSecretOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    quint16 port = (quint16)parser.value(portOption).toUInt();
+    if (port == 0) {
+        port = ICE_SERVER_DEFAULT_PORT;
+    }
+
+    if (parser.isSet(clusterOption)) {
+        auto secret = parser.isSet(clusterSecretOption) ? parser.value(clusterSecretOption)
+                                                        : QString::fromUtf8(qgetenv("ICE_CLUSTER_SECRET"));
+        auto instances = parser.value(clusterOption).split(',', Qt::SkipEmptyParts);
+        if (!setupCluster(instances, parser.value(clusterSelfOption), secret)) {
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+            return;
+        }
+    }
+
+    int numThreads = std::max(QThread::idealThreadCount() - 1, 1);
+    if (parser.isSet(threadsOption)) {
+        numThreads = std::max(parser.value(threadsOption).toInt(), 1);
+    }
+
+    for (int i = 0; i < numThreads; ++i) {
+        auto thread = std::unique_ptr<QThread>(new QThread());
+        thread->setObjectName("ICE Peer Shard " + QString::number(i));
+
+        auto shard = std::unique_ptr<IcePeerShard>(new IcePeerShard(*this));
+        shard->moveToThread(thread.get());
+        thread->start();
+
+        auto rawShard = shard.get();
+        QMetaObject::invokeMethod(rawShard, [rawShard] { rawShard->start(); });
+
+        _shards.push_back(std::move(shard));
+        _shardThreads.push_back(std::move(thread));
+    }
+
     // start the ice-server socket
-    qDebug() << "ice-server socket is listening on" << ICE_SERVER_DEFAULT_PORT;
-    _serverSocket.bind(SocketType::UDP, QHostAddress::AnyIPv4, ICE_SERVER_DEFAULT_PORT);
+    qDebug() << "ice-server socket is listening on" << port << "with" << numThreads << "peer threads";
+    _serverSocket.bind(SocketType::UDP, QHostAddress::AnyIPv4, port);
 
     // set processPacket as the verified packet callback for the udt::Socket
     _serverSocket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) { processPacket(std::move(packet));  });
@@ -49,15 +112,52 @@ IceServer::IceServer(int argc, char* argv[]) :
     // set packetVersionMatch as the verify packet operator for the udt::Socket
     using std::placeholders::_1;
     _serverSocket.setPacketFilterOperator(std::bind(&IceServer::packetVersionMatch, this, _1));
+}
+
+IceServer::~IceServer() {
+    for (size_t i = 0; i < _shards.size(); ++i) {
+        // the shard is deleted from its thread, as it finishes
+        _shards[i].release()->deleteLater();
+        _shardThreads[i]->quit();
+        _shardThreads[i]->wait();
+    }
+}
 
-    // setup our timer to clear inactive peers
-    QTimer* inactivePeerTimer = new QTimer(this);
-    connect(inactivePeerTimer, &QTimer::timeout, this, &IceServer::clearInactivePeers);
-    inactivePeerTimer->start(CLEAR_INACTIVE_PEERS_INTERVAL_MSECS);
+bool IceServer::setupCluster(const QStringList& instances, const QString& self, const QString& secret) {
+    if (secret.isEmpty()) {
+        qCritical() << "A cluster needs a --cluster-secret shared by its instances";
+        return false;
+    }
+
+    _clusterRing = IceClusterRing(instances);
+    _clusterInstance = _clusterRing.indexOf(self);
+    if (_clusterInstance == -1) {
+        qCritical() << "--cluster-self" << self << "is not one of the --cluster instances";
+        return false;
+    }
+
+    for (const auto& instance : _clusterRing.getInstances()) {
+        auto separator = instance.lastIndexOf(':');
+        quint16 port = separator == -1 ? 0 : (quint16)instance.mid(separator + 1).toUInt();
+        SockAddr sockAddr(SocketType::UDP, instance.left(separator), port == 0 ? ICE_SERVER_DEFAULT_PORT : port, true);
+        if (sockAddr.getAddress().isNull()) {
+            qCritical() << "Could not look up cluster instance" << instance;
+            return false;
+        }
 
-    // handle public keys when they arrive from the QNetworkAccessManager
-    auto& networkAccessManager = NetworkAccessManager::getInstance();
-    connect(&networkAccessManager, &QNetworkAccessManager::finished, this, &IceServer::publicKeyReplyFinished);
+        _clusterInstanceIndices[sockAddr] = (int)_clusterSockAddrs.size();
+        _clusterSockAddrs.push_back(sockAddr);
+    }
+
+    auto secretBytes = secret.toUtf8();
+    _clusterAuth.setKey(secretBytes.constData(), secretBytes.size());
+
+    qDebug() << "ice-server is instance" << self << "of a cluster of" << _clusterSockAddrs.size();
+    return true;
+}
+
+IcePeerShard& IceServer::shardFor(const QUuid& domainID) {
+    return *_shards[qHash(domainID) % _shards.size()];
 }
 
 bool IceServer::packetVersionMatch(const udt::Packet& packet) {
@@ -79,246 +179,143 @@ void IceServer::processPacket(std::unique_ptr<udt::Packet> packet) {
     if (nlPacket->getPayloadSize() >= NLPacket::localHeaderSize(PacketType::ICEServerHeartbeat)) {
         
         if (nlPacket->getType() == PacketType::ICEServerHeartbeat) {
-            SharedNetworkPeer peer = addOrUpdateHeartbeatingPeer(*nlPacket);
-            if (peer) {
-                // so that we can send packets to the heartbeating peer when we need, we need to activate a socket now
-                peer->activateMatchingOrNewSymmetricSocket(nlPacket->getSenderSockAddr());
-
-                // we have an active and verified heartbeating peer
-                // send them an ACK packet so they know that they are being heard and ready for ICE
-                static auto ackPacket = NLPacket::create(PacketType::ICEServerHeartbeatACK);
-                _serverSocket.writePacket(*ackPacket, nlPacket->getSenderSockAddr());
-            } else {
-                // we couldn't verify this peer - respond back to them so they know they may need to perform keypair re-generation
-                static auto deniedPacket = NLPacket::create(PacketType::ICEServerHeartbeatDenied);
-                _serverSocket.writePacket(*deniedPacket, nlPacket->getSenderSockAddr());
-            }
+            // the rest of the heartbeat is read by the shard of the domain that sent it
+            QByteArray payload(nlPacket->getPayload(), (int)nlPacket->getPayloadSize());
+            QUuid senderUUID;
+            QDataStream payloadStream(payload);
+            payloadStream >> senderUUID;
+
+            auto& shard = shardFor(senderUUID);
+            auto senderSockAddr = nlPacket->getSenderSockAddr();
+            QMetaObject::invokeMethod(&shard, [&shard, payload, senderSockAddr] {
+                shard.processHeartbeat(payload, senderSockAddr);
+            });
         } else if (nlPacket->getType() == PacketType::ICEServerQuery) {
             QDataStream heartbeatStream(nlPacket.get());
             
             // this is a node hoping to connect to a heartbeating peer - do we have the heartbeating peer?
-            QUuid senderUUID;
-            heartbeatStream >> senderUUID;
+            IceQuery query;
+            heartbeatStream >> query.senderUUID;
             
             // pull the public and private sock addrs for this peer
-            SockAddr publicSocket, localSocket;
-            heartbeatStream >> publicSocket >> localSocket;
+            heartbeatStream >> query.publicSocket >> query.localSocket;
             
             // check if this node also included a UUID that they would like to connect to
-            QUuid connectRequestID;
-            heartbeatStream >> connectRequestID;
-            
-            SharedNetworkPeer matchingPeer = _activePeers.value(connectRequestID);
-            
-            if (matchingPeer) {
-                
-                qDebug() << "Sending information for peer" << connectRequestID << "to peer" << senderUUID;
-                
-                // we have the peer they want to connect to - send them pack the information for that peer
-                sendPeerInformationPacket(*matchingPeer, &nlPacket->getSenderSockAddr());
-                
-                // we also need to send them to the active peer they are hoping to connect to
-                // create a dummy peer object we can pass to sendPeerInformationPacket
-                
-                NetworkPeer dummyPeer(senderUUID, publicSocket, localSocket);
-                sendPeerInformationPacket(dummyPeer, matchingPeer->getActiveSocket());
-            } else {
-                qDebug() << "Peer" << senderUUID << "asked for" << connectRequestID << "but no matching peer found";
-            }
-        }
-    }
-}
-
-SharedNetworkPeer IceServer::addOrUpdateHeartbeatingPeer(NLPacket& packet) {
-
-    // pull the UUID, public and private sock addrs for this peer
-    QUuid senderUUID;
-    SockAddr publicSocket, localSocket;
-    QByteArray signature;
-
-    QDataStream heartbeatStream(&packet);
-    heartbeatStream >> senderUUID >> publicSocket >> localSocket;
-
-    auto signedPlaintext = QByteArray::fromRawData(packet.getPayload(), heartbeatStream.device()->pos());
-    heartbeatStream >> signature;
+            heartbeatStream >> query.connectRequestID;
+            query.clientSockAddr = nlPacket->getSenderSockAddr();
 
-    // make sure this is a verified heartbeat before performing any more processing
-    if (isVerifiedHeartbeat(senderUUID, signedPlaintext, signature)) {
-        // make sure we have this sender in our peer hash
-        SharedNetworkPeer matchingPeer = _activePeers.value(senderUUID);
-
-        if (!matchingPeer) {
-            // if we don't have this sender we need to create them now
-            matchingPeer = QSharedPointer<NetworkPeer>::create(senderUUID, publicSocket, localSocket);
-            _activePeers.insert(senderUUID, matchingPeer);
-
-            qDebug() << "Added a new network peer" << *matchingPeer;
-        } else {
-            // we already had the peer so just potentially update their sockets
-            matchingPeer->setPublicSocket(publicSocket);
-            matchingPeer->setLocalSocket(localSocket);
+            auto& shard = shardFor(query.connectRequestID);
+            QMetaObject::invokeMethod(&shard, [&shard, query] { shard.processQuery(query); });
+        } else if (!_clusterSockAddrs.empty()) {
+            processClusterPacket(*nlPacket);
         }
-
-        // update our last heard microstamp for this network peer to now
-        matchingPeer->setLastHeardMicrostamp(usecTimestampNow());
-        
-        return matchingPeer;
-    } else {
-        // not verified, return the empty peer object
-        return SharedNetworkPeer();
     }
 }
 
-bool IceServer::isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature) {
-    // make sure we're not already waiting for a public key for this domain-server
-    if (!_pendingPublicKeyRequests.contains(domainID)) {
-        // check if we have a public key for this domain ID - if we do not then fire off the request for it
-        auto it = _domainPublicKeys.find(domainID);
-        if (it != _domainPublicKeys.end()) {
-
-            // attempt to verify the signature for this heartbeat
-            const auto rsaPublicKey = it->second.get();
-
-            if (rsaPublicKey) {
-                auto hashedPlaintext = QCryptographicHash::hash(plaintext, QCryptographicHash::Sha256);
-                int verificationResult = RSA_verify(NID_sha256,
-                                                    reinterpret_cast<const unsigned char*>(hashedPlaintext.constData()),
-                                                    hashedPlaintext.size(),
-                                                    reinterpret_cast<const unsigned char*>(signature.constData()),
-                                                    signature.size(),
-                                                    rsaPublicKey);
-
-                if (verificationResult == 1) {
-                    // this is the only success case - we return true here to indicate that the heartbeat is verified
-                    return true;
-                } else {
-                    qDebug() << "Failed to verify heartbeat for" << domainID << "- re-requesting public key from API.";
-                }
-
-            } else {
-                // we can't let this user in since we couldn't convert their public key to an RSA key we could use
-                qWarning() << "Public key for" << domainID << "is not a usable RSA* public key.";
-                qWarning() << "Re-requesting public key from API";
-            }
-        }
-
-        // we could not verify this heartbeat (missing public key, could not load public key, bad actor)
-        // ask the metaverse API for the right public key and return false to indicate that this is not verified
-        requestDomainPublicKey(domainID);
+void IceServer::processClusterPacket(NLPacket& packet) {
+    auto type = packet.getType();
+    if (type != PacketType::ICEClusterRegistration && type != PacketType::ICEClusterQuery
+        && type != PacketType::ICEClusterPeerInformation) {
+        return;
     }
 
-    return false;
-}
-
-void IceServer::requestDomainPublicKey(const QUuid& domainID) {
-    // send a request to the metaverse API for the public key for this domain
-    auto& networkAccessManager = NetworkAccessManager::getInstance();
-
-    QUrl publicKeyURL{ MetaverseAPI::getCurrentMetaverseServerURL() };
-    // qDebug() << "publicKeyURL" << publicKeyURL;
-    // qDebug() << "MetaverseAPI::getCurrentMetaverseServerURLPath()" << MetaverseAPI::getCurrentMetaverseServerURLPath();
-    QString publicKeyPath = QString("/api/v1/domains/%1/public_key").arg(uuidStringWithoutCurlyBraces(domainID));
-    publicKeyURL.setPath("/" + MetaverseAPI::getCurrentMetaverseServerURLPath() + publicKeyPath);
-    // qDebug() << "publicKeyPath" << publicKeyPath;
-    // qDebug() << "publicKeyURL.setPath" << "/" + MetaverseAPI::getCurrentMetaverseServerURLPath() + publicKeyPath;
-    // qDebug() << "publicKeyURL" << publicKeyURL;
-    // qDebug() << "publicKeyURL.isValid()" << publicKeyURL.isValid();
-    // qDebug() << "publicKeyURL.errorString()" << publicKeyURL.errorString();
-
-    QNetworkRequest publicKeyRequest { publicKeyURL };
-    publicKeyRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
-    publicKeyRequest.setAttribute(QNetworkRequest::User, domainID);
-
-    qDebug() << "Requesting public key for domain with ID" << domainID;
-
-    // add this to the set of pending public key requests
-    _pendingPublicKeyRequests.insert(domainID);
-
-    networkAccessManager.get(publicKeyRequest);
-}
-
-void IceServer::publicKeyReplyFinished(QNetworkReply* reply) {
-    // get the domain ID from the QNetworkReply attribute
-    QUuid domainID = reply->request().attribute(QNetworkRequest::User).toUuid();
-
-    if (reply->error() == QNetworkReply::NoError) {
-        // pull out the public key and store it for this domain
-
-        // the response should be JSON
-        QJsonDocument responseDocument = QJsonDocument::fromJson(reply->readAll());
-
-        static const QString DATA_KEY = "data";
-        static const QString PUBLIC_KEY_KEY = "public_key";
-        static const QString STATUS_KEY = "status";
-        static const QString SUCCESS_VALUE = "success";
+    auto instance = _clusterInstanceIndices.find(packet.getSenderSockAddr());
+    if (instance == _clusterInstanceIndices.end()) {
+        qDebug() << "Ignoring" << type << "from" << packet.getSenderSockAddr() << "which is not in the cluster";
+        return;
+    }
+    int senderInstance = instance->second;
 
-        auto responseObject = responseDocument.object();
-        if (responseObject[STATUS_KEY].toString() == SUCCESS_VALUE) {
-            auto dataObject = responseObject[DATA_KEY].toObject();
-            if (dataObject.contains(PUBLIC_KEY_KEY)) {
+    // the payload is the time it was sent and its data, followed by their hash
+    auto payloadSize = (int)packet.getPayloadSize();
+    if (payloadSize < (int)sizeof(quint64) + CLUSTER_PACKET_HASH_SIZE) {
+        return;
+    }
 
-                // grab the base 64 public key from the API response
-                auto apiPublicKey = QByteArray::fromBase64(dataObject[PUBLIC_KEY_KEY].toString().toUtf8());
+    QByteArray signedData;
+    signedData.append((char)type);
+    signedData.append(packet.getPayload(), payloadSize - CLUSTER_PACKET_HASH_SIZE);
 
-                // convert the downloaded public key to an RSA struct, if possible
-                const unsigned char* publicKeyData = reinterpret_cast<const unsigned char*>(apiPublicKey.constData());
+    HMACAuth::HMACHash hash;
+    if (!_clusterAuth.calculateHash(hash, signedData.constData(), signedData.size())
+        || hash.size() != (size_t)CLUSTER_PACKET_HASH_SIZE
+        || memcmp(hash.data(), packet.getPayload() + payloadSize - CLUSTER_PACKET_HASH_SIZE, CLUSTER_PACKET_HASH_SIZE) != 0) {
+        qWarning() << "Ignoring" << type << "from cluster instance" << senderInstance << "with a bad signature";
+        return;
+    }
 
-                RSA* rsaPublicKey = d2i_RSA_PUBKEY(NULL, &publicKeyData, apiPublicKey.size());
+    auto sentTime = qFromBigEndian<quint64>(reinterpret_cast<const uchar*>(signedData.constData() + 1));
+    auto now = usecTimestampNow();
+    if ((sentTime > now ? sentTime - now : now - sentTime) > MAX_CLUSTER_PACKET_AGE_USECS) {
+        qWarning() << "Ignoring" << type << "from cluster instance" << senderInstance << "sent too long ago";
+        return;
+    }
 
-                if (rsaPublicKey) {
-                    _domainPublicKeys[domainID] = { rsaPublicKey, RSA_free };
-                } else {
-                    qWarning() << "Could not convert in-memory public key for" << domainID << "to usable RSA public key.";
-                    qWarning() << "Public key will be re-requested on next heartbeat.";
-                }
+    QByteArray data = signedData.mid(1 + (int)sizeof(quint64));
+    QDataStream dataStream(data);
 
-            } else {
-                qWarning() << "There was no public key present in response for domain with ID" << domainID;
-            }
-        } else {
-            qWarning() << "The metaverse API did not return success for public key request for domain with ID" << domainID;
+    if (type == PacketType::ICEClusterRegistration) {
+        if (data.size() < NUM_BYTES_RFC4122_UUID) {
+            return;
+        }
+        auto domainID = QUuid::fromRfc4122(data.left(NUM_BYTES_RFC4122_UUID));
+
+        auto& shard = shardFor(domainID);
+        QMetaObject::invokeMethod(&shard, [&shard, domainID, senderInstance] {
+            shard.processClusterRegistration(domainID, senderInstance);
+        });
+    } else if (type == PacketType::ICEClusterQuery) {
+        IceQuery query;
+        quint8 originInstance;
+        quint8 hops;
+        dataStream >> query.senderUUID >> query.publicSocket >> query.localSocket >> query.connectRequestID
+            >> query.clientSockAddr >> originInstance >> hops;
+        if (dataStream.status() != QDataStream::Ok || originInstance >= _clusterSockAddrs.size()) {
+            return;
         }
 
+        auto& shard = shardFor(query.connectRequestID);
+        QMetaObject::invokeMethod(&shard, [&shard, query, originInstance, hops] {
+            shard.processQuery(query, originInstance, hops);
+        });
     } else {
-        // there was a problem getting the public key for the domain
-        // log it since it will be re-requested on the next heartbeat
-
-        qWarning() << "Error retreiving public key for domain with ID" << domainID << "-" <<  reply->errorString();
+        // the peer a node of ours asked for was found by another instance, pass it on
+        SockAddr clientSockAddr;
+        dataStream >> clientSockAddr;
+        if (dataStream.status() == QDataStream::Ok) {
+            auto peerIndex = (int)dataStream.device()->pos();
+            sendPacket(PacketType::ICEServerPeerInformation, data.mid(peerIndex), clientSockAddr);
+        }
     }
-
-    // remove this domain ID from the list of pending public key requests
-    _pendingPublicKeyRequests.remove(domainID);
-
-    reply->deleteLater();
 }
 
-void IceServer::sendPeerInformationPacket(const NetworkPeer& peer, const SockAddr* destinationSockAddr) {
-    auto peerPacket = NLPacket::create(PacketType::ICEServerPeerInformation);
-
-    // get the byte array for this peer
-    peerPacket->write(peer.toByteArray());
-    
-    // write the current packet
-    _serverSocket.writePacket(*peerPacket, *destinationSockAddr);
+void IceServer::sendPacket(PacketType type, const QByteArray& payload, const SockAddr& destination) {
+    QMetaObject::invokeMethod(this, [this, type, payload, destination] {
+        auto packet = NLPacket::create(type, payload.size());
+        packet->write(payload);
+        _serverSocket.writePacket(*packet, destination);
+    });
 }
 
-void IceServer::clearInactivePeers() {
-    NetworkPeerHash::iterator peerItem = _activePeers.begin();
-
-    while (peerItem != _activePeers.end()) {
-        SharedNetworkPeer peer = peerItem.value();
-
-        if ((usecTimestampNow() - peer->getLastHeardMicrostamp()) > (PEER_SILENCE_THRESHOLD_MSECS * 1000)) {
-            qDebug() << "Removing peer from memory for inactivity -" << *peer;
-
-            // if we had a public key for this domain, remove it now
-            _domainPublicKeys.erase(peer->getUUID());
-
-            // remove the peer object
-            peerItem = _activePeers.erase(peerItem);
-        } else {
-            // we didn't kill this peer, push the iterator forwards
-            ++peerItem;
+void IceServer::sendClusterPacket(PacketType type, const QByteArray& payload, int instance) {
+    QMetaObject::invokeMethod(this, [this, type, payload, instance] {
+        QByteArray signedData;
+        signedData.reserve(1 + (int)sizeof(quint64) + payload.size());
+        signedData.append((char)type);
+        quint64 sentTime = qToBigEndian<quint64>(usecTimestampNow());
+        signedData.append(reinterpret_cast<const char*>(&sentTime), sizeof(sentTime));
+        signedData.append(payload);
+
+        HMACAuth::HMACHash hash;
+        if (!_clusterAuth.calculateHash(hash, signedData.constData(), signedData.size())) {
+            qWarning() << "Could not sign" << type << "for cluster instance" << instance;
+            return;
         }
-    }
+
+        auto packetSize = signedData.size() - 1 + (int)hash.size();
+        auto packet = NLPacket::create(type, packetSize);
+        packet->write(signedData.constData() + 1, signedData.size() - 1);
+        packet->write(reinterpret_cast<const char*>(hash.data()), hash.size());
+        _serverSocket.writePacket(*packet, _clusterSockAddrs[instance]);
+    });
 }
@@ -14,49 +14,59 @@
 #ifndef hifi_IceServer_h
 #define hifi_IceServer_h
 
-#include <QtCore/QCoreApplication>
-#include <QUdpSocket>
-
-#include <openssl/rsa.h>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
-#include <UUIDHasher.h>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
 
-#include <NetworkPeer.h>
-#include <HTTPConnection.h>
-#include <HTTPManager.h>
+#include <HMACAuth.h>
 #include <NLPacket.h>
 #include <udt/Socket.h>
 
-class QNetworkReply;
+#include "IceClusterRing.h"
+#include "IcePeerShard.h"
 
+/// Keeps track of heartbeating domains and answers the queries of nodes that want to connect to them. The peers are split
+/// by domain ID between shards on their own threads, while packets are read and written on the main thread.
+///
+/// Several instances can share the load as a cluster, given the same --cluster list and --cluster-secret: each domain is
+/// owned by one instance by consistent hashing of its ID. A domain can heartbeat with any instance, which registers it with
+/// the owner. An instance asked for a domain it doesn't have forwards the query to the owner, which passes it on to the
+/// instance the domain heartbeats with. The domain is sent the node's sockets by that instance, and the node hears back
+/// from the instance it asked, so that both only ever hear from the instance they talk to.
 class IceServer : public QCoreApplication {
     Q_OBJECT
 public:
     IceServer(int argc, char* argv[]);
-private slots:
-    void clearInactivePeers();
-    void publicKeyReplyFinished(QNetworkReply* reply);
+    ~IceServer();
+
+    const IceClusterRing& getClusterRing() const { return _clusterRing; }
+    int getClusterInstance() const { return _clusterInstance; }
+
+    // can be called from any thread, the packet is written from the main thread
+    void sendPacket(PacketType type, const QByteArray& payload, const SockAddr& destination);
+    void sendClusterPacket(PacketType type, const QByteArray& payload, int instance);
+
 private:
     bool packetVersionMatch(const udt::Packet& packet);
     void processPacket(std::unique_ptr<udt::Packet> packet);
-    
-    SharedNetworkPeer addOrUpdateHeartbeatingPeer(NLPacket& incomingPacket);
-    void sendPeerInformationPacket(const NetworkPeer& peer, const SockAddr* destinationSockAddr);
+    void processClusterPacket(NLPacket& packet);
 
-    bool isVerifiedHeartbeat(const QUuid& domainID, const QByteArray& plaintext, const QByteArray& signature);
-    void requestDomainPublicKey(const QUuid& domainID);
+    bool setupCluster(const QStringList& instances, const QString& self, const QString& secret);
+    IcePeerShard& shardFor(const QUuid& domainID);
 
-    QUuid _id;
     udt::Socket _serverSocket;
 
-    using NetworkPeerHash = QHash<QUuid, SharedNetworkPeer>;
-    NetworkPeerHash _activePeers;
-
-    using RSAUniquePtr = std::unique_ptr<RSA, std::function<void(RSA*)>>;
-    using DomainPublicKeyHash = std::unordered_map<QUuid, RSAUniquePtr>;
-    DomainPublicKeyHash _domainPublicKeys;
+    std::vector<std::unique_ptr<IcePeerShard>> _shards;
+    std::vector<std::unique_ptr<QThread>> _shardThreads;
 
-    QSet<QUuid> _pendingPublicKeyRequests;
+    IceClusterRing _clusterRing;
+    int _clusterInstance { -1 };
+    std::vector<SockAddr> _clusterSockAddrs;
+    std::unordered_map<SockAddr, int> _clusterInstanceIndices;
+    HMACAuth _clusterAuth { HMACAuth::SHA256 };
 };
 
 #endif // hifi_IceServer_h
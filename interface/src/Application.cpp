@@ -61,6 +61,7 @@
 #include <shared/QtHelpers.h>
 #include <shared/PlatformHelper.h>
 #include <shared/GlobalAppProperties.h>
+#include <shared/StartupTask.h>
 #include <GeometryUtil.h>
 #include <StatTracker.h>
 #include <Trace.h>
@@ -82,6 +83,7 @@
 #include <VirtualPadManager.h>
 #include <DebugDraw.h>
 #include <DeferredLightingEffect.h>
+#include <EntityNodeData.h>
 #include <EntityScriptClient.h>
 #include <EntityScriptServerLogClient.h>
 #include <EntityScriptingInterface.h>
@@ -110,6 +112,7 @@
 #include <model-networking/ModelCacheScriptingInterface.h>
 #include <procedural/MaterialCacheScriptingInterface.h>
 #include <material-networking/TextureCacheScriptingInterface.h>
+#include <image/TextureProcessing.h>
 #include <ModelEntityItem.h>
 #include <NetworkAccessManager.h>
 #include <NetworkingConstants.h>
@@ -132,6 +135,7 @@
 #include <plugins/InputConfiguration.h>
 #include <RecordingScriptingInterface.h>
 #include <render/EngineStats.h>
+#include <workload/ViewTask.h>
 #include <SecondaryCamera.h>
 #include <ResourceCache.h>
 #include <ResourceRequest.h>
@@ -140,6 +144,7 @@
 #include <ScriptEngines.h>
 #include <ScriptCache.h>
 #include <ShapeEntityItem.h>
+#include <shaders/Shaders.h>
 #include <SoundCacheScriptingInterface.h>
 #include <ui/TabletScriptingInterface.h>
 #include <ui/ToolbarScriptingInterface.h>
@@ -306,6 +311,8 @@ static const uint32_t MAX_CONCURRENT_RESOURCE_DOWNLOADS = 4;
 // based on how many are being consumed by the application and the display plugin.  However,
 // we will never drop below the 'min' value
 static const int MIN_PROCESSING_THREAD_POOL_SIZE = 2;
+// the threads that the texture compressions can take, so the frame rate holds while a domain loads
+static const int TEXTURE_COMPRESSION_CONCURRENCY = 2;
 
 static const QString SNAPSHOT_EXTENSION = ".jpg";
 static const QString JPG_EXTENSION = ".jpg";
@@ -730,6 +737,7 @@ const QString TEST_QUIT_WHEN_FINISHED_OPTION{ "quitWhenFinished" };
 const QString TEST_RESULTS_LOCATION_COMMAND{ "--testResultsLocation" };
 
 bool setupEssentials(int& argc, char** argv, bool runningMarkerExisted) {
+    PROFILE_RANGE(startup, __FUNCTION__);
     const char** constArgv = const_cast<const char**>(argv);
 
     qInstallMessageHandler(messageHandler);
@@ -817,12 +825,11 @@ bool setupEssentials(int& argc, char** argv, bool runningMarkerExisted) {
     pluginManager->setInputPluginProvider([] { return getInputPlugins(); });
     pluginManager->setDisplayPluginProvider([] { return getDisplayPlugins(); });
     pluginManager->setInputPluginSettingsPersister([](const InputPluginList& plugins) { saveInputPluginSettings(plugins); });
-    if (auto steamClient = pluginManager->getSteamClientPlugin()) {
-        steamClient->init();
-    }
-    if (auto oculusPlatform = pluginManager->getOculusPlatformPlugin()) {
-        oculusPlatform->init();
-    }
+
+    // Finding and loading the plugin libraries and loading the shaders don't need the main thread, so they're done while
+    // it sets up the dependencies. Whatever needs them first waits for them.
+    auto pluginDiscovery = StartupTask::start("plugin discovery", [pluginManager] { pluginManager->getLoadedPlugins(); });
+    StartupTask::start("shader loading", [] { shader::Source::loadAll(); });
 
     PROFILE_SET_THREAD_NAME("Main Thread");
 
@@ -879,6 +886,7 @@ bool setupEssentials(int& argc, char** argv, bool runningMarkerExisted) {
     DependencyManager::set<AudioScope>();
     DependencyManager::set<DeferredLightingEffect>();
     DependencyManager::set<TextureCache>();
+    image::setCompressionConcurrency(TEXTURE_COMPRESSION_CONCURRENCY);
     DependencyManager::set<MaterialCache>();
     DependencyManager::set<TextureCacheScriptingInterface>();
     DependencyManager::set<MaterialCacheScriptingInterface>();
@@ -957,6 +965,14 @@ bool setupEssentials(int& argc, char** argv, bool runningMarkerExisted) {
     DependencyManager::set<ScreenshareScriptingInterface>();
     PlatformHelper::setup();
 
+    pluginDiscovery->wait();
+    if (auto steamClient = pluginManager->getSteamClientPlugin()) {
+        steamClient->init();
+    }
+    if (auto oculusPlatform = pluginManager->getOculusPlatformPlugin()) {
+        oculusPlatform->init();
+    }
+
     QObject::connect(PlatformHelper::instance(), &PlatformHelper::systemWillWake, [] {
         QMetaObject::invokeMethod(DependencyManager::get<NodeList>().data(), "noteAwakening", Qt::QueuedConnection);
         QMetaObject::invokeMethod(DependencyManager::get<AudioClient>().data(), "noteAwakening", Qt::QueuedConnection);
@@ -1611,6 +1627,9 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
     // create thread for parsing of octree data independent of the main network and rendering threads
     _octreeProcessor.initialize(_enableProcessOctreeThread);
     connect(&_octreeProcessor, &OctreePacketProcessor::packetVersionMismatch, this, &Application::notifyPacketVersionMismatch);
+    connect(&_octreeProcessor, &OctreePacketProcessor::sceneBundleOffered, this, &Application::loadSceneBundle);
+    connect(&_sceneBundleLoader, &SceneBundleLoader::finished, this, &Application::sceneBundleLoaded);
+    resetSceneBundle();
     _entityEditSender.initialize(_enableProcessOctreeThread);
 
     _idleLoopStdev.reset();
@@ -2227,6 +2246,8 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
         properties["present_rate"] = displayPlugin->presentRate();
         properties["new_frame_present_rate"] = displayPlugin->newFramePresentRate();
         properties["dropped_frame_rate"] = displayPlugin->droppedFrameRate();
+        properties["present_latency"] = displayPlugin->presentLatency();
+        properties["missed_vsync_rate"] = displayPlugin->missedVsyncRate();
         properties["stutter_rate"] = displayPlugin->stutterRate();
         properties["game_rate"] = getGameLoopRate();
         properties["has_async_reprojection"] = displayPlugin->hasAsyncReprojection();
@@ -2304,6 +2325,7 @@ Application::Application(int& argc, char** argv, QElapsedTimer& startupTimer, bo
         cacheRequests["http"] = statTracker->getStat(STAT_HTTP_REQUEST_CACHE).toInt();
         cacheRequests["total"] = cacheRequests["atp"].toInt() + cacheRequests["http"].toInt();
         properties["cache_requests"] = cacheRequests;
+        properties["coalesced_requests"] = statTracker->getStat(STAT_HTTP_REQUEST_COALESCED).toInt();
 
         QJsonObject atpMappingRequests;
         atpMappingRequests["started"] = statTracker->getStat(STAT_ATP_MAPPING_REQUEST_STARTED).toInt();
@@ -2946,6 +2968,7 @@ Application::~Application() {
     // shutdown graphics engine
     _graphicsEngine.shutdown();
 
+    _resourcePrefetcher.clear();
     _gameWorkload.shutdown();
 
     DependencyManager::destroy<Preferences>();
@@ -3045,6 +3068,7 @@ Application::~Application() {
 }
 
 void Application::initializeGL() {
+    PROFILE_RANGE(startup, __FUNCTION__);
     qCDebug(interfaceapp) << "Created Display Window.";
 
 #ifdef DISABLE_QML
@@ -3154,6 +3178,7 @@ void Application::initializeGL() {
 }
 
 void Application::initializeDisplayPlugins() {
+    PROFILE_RANGE(startup, __FUNCTION__);
     const auto& displayPlugins = PluginManager::getInstance()->getDisplayPlugins();
     Setting::Handle<QString> activeDisplayPluginSetting{ ACTIVE_DISPLAY_PLUGIN_SETTING_NAME, displayPlugins.at(0)->getName() };
     auto lastActiveDisplayPluginName = activeDisplayPluginSetting.get();
@@ -3212,6 +3237,7 @@ void Application::initializeDisplayPlugins() {
 }
 
 void Application::initializeRenderEngine() {
+    PROFILE_RANGE(startup, __FUNCTION__);
     // FIXME: on low end systems os the shaders take up to 1 minute to compile, so we pause the deadlock watchdog thread.
     DeadlockWatchdogThread::withPause([&] {
         _graphicsEngine.initializeRender();
@@ -3254,6 +3280,7 @@ void Application::showLoginScreen() {
 static const QUrl AUTHORIZED_EXTERNAL_QML_SOURCE { "https://cdn.vircadia.com/community-apps/applications" };
 
 void Application::initializeUi() {
+    PROFILE_RANGE(startup, __FUNCTION__);
 
     // Allow remote QML content from trusted sources ONLY
     {
@@ -5362,8 +5389,8 @@ void Application::idle() {
     PerformanceWarning warn(showWarnings, "idle()");
 
     {
+        // the workload engine runs as a stage of update()
         _gameWorkload.updateViews(_viewFrustum, getMyAvatar()->getHeadPosition());
-        _gameWorkload._engine->run();
     }
     {
         PerformanceTimer perfTimer("update");
@@ -5517,6 +5544,7 @@ bool Application::exportEntities(const QString& filename, float x, float y, floa
 }
 
 void Application::loadSettings() {
+    PROFILE_RANGE(startup, __FUNCTION__);
 
     sessionRunTime.set(0); // Just clean living. We're about to saveSettings, which will update value.
     DependencyManager::get<AudioClient>()->loadSettings();
@@ -5680,6 +5708,7 @@ QVector<EntityItemID> Application::pasteEntities(const QString& entityHostType,
 }
 
 void Application::init() {
+    PROFILE_RANGE(startup, __FUNCTION__);
     // Make sure Login state is up to date
 #if !defined(DISABLE_QML)
     DependencyManager::get<DialogsManager>()->toggleLoginDialog();
@@ -5722,11 +5751,16 @@ void Application::init() {
         return atan2(maxSize, distance);
     });
 
+    auto shapeCache = std::make_shared<ShapeCache>();
+    shapeCache->initialize();
+    _shapeManager.setDiskCache(shapeCache);
     ObjectMotionState::setShapeManager(&_shapeManager);
+    _physicsEngine->setNumPhysicsThreads(_performanceManager.getNumPhysicsThreads());
     _physicsEngine->init();
 
     EntityTreePointer tree = getEntities()->getTree();
     _entitySimulation->init(tree, _physicsEngine, &_entityEditSender);
+    _entitySimulation->setMaxActiveDynamicEntities((uint32_t)_performanceManager.getMaxActiveDynamicEntities());
     tree->setSimulation(_entitySimulation);
 
     auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
@@ -5752,6 +5786,9 @@ void Application::init() {
 
     _gameWorkload.startup(getEntities()->getWorkloadSpace(), _graphicsEngine.getRenderScene(), _entitySimulation);
     _entitySimulation->setWorkloadSpace(getEntities()->getWorkloadSpace());
+
+    buildUpdateGraph();
+    _updateGraph.setConcurrent(_performanceManager.isParallelUpdateEnabled());
 }
 
 void Application::pauseUntilLoginDetermined() {
@@ -5928,8 +5965,13 @@ void Application::updateLOD(float deltaTime) const {
         auto lodManager = DependencyManager::get<LODManager>();
         lodManager->setRenderTimes(presentTime, engineRunTime, batchTime, gpuTime);
         lodManager->autoAdjustLOD(deltaTime);
+
+        float targetFrameTime = (float)MSECS_PER_SECOND / getActiveDisplayPlugin()->getTargetFrameRate();
+        RenderScriptingInterface::getInstance()->updateDynamicResolution(gpuTime, targetFrameTime);
     } else {
         DependencyManager::get<LODManager>()->resetLODAdjust();
+        // back to the full scale while throttled, rather than judge it by frames that aren't trying to keep up
+        RenderScriptingInterface::getInstance()->updateDynamicResolution(0.0f, 0.0f);
     }
 }
 
@@ -6384,7 +6426,7 @@ void Application::update(float deltaTime) {
         PROFILE_ASYNC_END(app, "Scene Loading", "");
     }
 
-     if (shouldCaptureMouse()) {
+    if (shouldCaptureMouse()) {
         QPoint point = _glWidget->mapToGlobal(_glWidget->geometry().center());
         if (QCursor::pos() != point) {
             _mouseCaptureTarget = point;
@@ -6393,357 +6435,439 @@ void Application::update(float deltaTime) {
         }
     }
 
-    auto myAvatar = getMyAvatar();
-    {
-        PerformanceTimer perfTimer("devices");
-        auto userInputMapper = DependencyManager::get<UserInputMapper>();
+    bool showWarnings = Menu::getInstance()->isOptionChecked(MenuOption::PipelineWarnings);
+    PerformanceWarning warn(showWarnings, "Application::update()");
 
-        controller::HmdAvatarAlignmentType hmdAvatarAlignmentType;
-        if (myAvatar->getHmdAvatarAlignmentType() == "eyes") {
-            hmdAvatarAlignmentType = controller::HmdAvatarAlignmentType::Eyes;
-        } else {
-            hmdAvatarAlignmentType = controller::HmdAvatarAlignmentType::Head;
-        }
-
-        controller::InputCalibrationData calibrationData = {
-            myAvatar->getSensorToWorldMatrix(),
-            createMatFromQuatAndPos(myAvatar->getWorldOrientation(), myAvatar->getWorldPosition()),
-            myAvatar->getHMDSensorMatrix(),
-            myAvatar->getCenterEyeCalibrationMat(),
-            myAvatar->getHeadCalibrationMat(),
-            myAvatar->getSpine2CalibrationMat(),
-            myAvatar->getHipsCalibrationMat(),
-            myAvatar->getLeftFootCalibrationMat(),
-            myAvatar->getRightFootCalibrationMat(),
-            myAvatar->getRightArmCalibrationMat(),
-            myAvatar->getLeftArmCalibrationMat(),
-            myAvatar->getRightHandCalibrationMat(),
-            myAvatar->getLeftHandCalibrationMat(),
-            hmdAvatarAlignmentType
-        };
+    _updateDeltaTime = deltaTime;
+    _updateGraph.run();
+    if (_graphicsEngine._frameTimingsScriptingInterface.isActive()) {
+        _graphicsEngine._frameTimingsScriptingInterface.addUpdateStageTimings(_updateGraph.getStageTimings());
+    }
+}
 
-        InputPluginPointer keyboardMousePlugin;
-        for(const auto& inputPlugin : PluginManager::getInstance()->getInputPlugins()) {
-            if (inputPlugin->getName() == KeyboardMouseDevice::NAME) {
-                keyboardMousePlugin = inputPlugin;
-            } else if (inputPlugin->isActive()) {
-                inputPlugin->pluginUpdate(deltaTime, calibrationData);
-            }
-        }
+void Application::buildUpdateGraph() {
+    using Affinity = UpdateGraph::Affinity;
+    auto& graph = _updateGraph;
 
-        userInputMapper->setInputCalibrationData(calibrationData);
-        userInputMapper->update(deltaTime);
-
-        if (keyboardMousePlugin && keyboardMousePlugin->isActive()) {
-            keyboardMousePlugin->pluginUpdate(deltaTime, calibrationData);
-        }
-        // Transfer the user inputs to the driveKeys
-        // FIXME can we drop drive keys and just have the avatar read the action states directly?
-        myAvatar->clearDriveKeys();
-        if (_myCamera.getMode() != CAMERA_MODE_INDEPENDENT && !isInterstitialMode()) {
-            if (!_controllerScriptingInterface->areActionsCaptured() && _myCamera.getMode() != CAMERA_MODE_MIRROR) {
-                myAvatar->setDriveKey(MyAvatar::TRANSLATE_Z, -1.0f * userInputMapper->getActionState(controller::Action::TRANSLATE_Z));
-                myAvatar->setDriveKey(MyAvatar::TRANSLATE_Y, userInputMapper->getActionState(controller::Action::TRANSLATE_Y));
-                myAvatar->setDriveKey(MyAvatar::TRANSLATE_X, userInputMapper->getActionState(controller::Action::TRANSLATE_X));
-                if (deltaTime > FLT_EPSILON && userInputMapper->getActionState(controller::Action::TRANSLATE_CAMERA_Z)  == 0.0f) {
-                    myAvatar->setDriveKey(MyAvatar::PITCH, -1.0f * userInputMapper->getActionState(controller::Action::PITCH));
-                    myAvatar->setDriveKey(MyAvatar::YAW, -1.0f * userInputMapper->getActionState(controller::Action::YAW));
-                    myAvatar->setDriveKey(MyAvatar::DELTA_PITCH, -_myCamera.getSensitivity() * userInputMapper->getActionState(controller::Action::DELTA_PITCH));
-                    myAvatar->setDriveKey(MyAvatar::DELTA_YAW, -_myCamera.getSensitivity() * userInputMapper->getActionState(controller::Action::DELTA_YAW));
-                    myAvatar->setDriveKey(MyAvatar::STEP_YAW, -1.0f * userInputMapper->getActionState(controller::Action::STEP_YAW));
-                }
-            }
-            myAvatar->setDriveKey(MyAvatar::ZOOM, userInputMapper->getActionState(controller::Action::TRANSLATE_CAMERA_Z));
-        }
-
-        myAvatar->setSprintMode((bool)userInputMapper->getActionState(controller::Action::SPRINT));
-        static const std::vector<controller::Action> avatarControllerActions = {
-            controller::Action::LEFT_HAND,
-            controller::Action::RIGHT_HAND,
-            controller::Action::LEFT_FOOT,
-            controller::Action::RIGHT_FOOT,
-            controller::Action::HIPS,
-            controller::Action::SPINE2,
-            controller::Action::HEAD,
-            controller::Action::LEFT_HAND_THUMB1,
-            controller::Action::LEFT_HAND_THUMB2,
-            controller::Action::LEFT_HAND_THUMB3,
-            controller::Action::LEFT_HAND_THUMB4,
-            controller::Action::LEFT_HAND_INDEX1,
-            controller::Action::LEFT_HAND_INDEX2,
-            controller::Action::LEFT_HAND_INDEX3,
-            controller::Action::LEFT_HAND_INDEX4,
-            controller::Action::LEFT_HAND_MIDDLE1,
-            controller::Action::LEFT_HAND_MIDDLE2,
-            controller::Action::LEFT_HAND_MIDDLE3,
-            controller::Action::LEFT_HAND_MIDDLE4,
-            controller::Action::LEFT_HAND_RING1,
-            controller::Action::LEFT_HAND_RING2,
-            controller::Action::LEFT_HAND_RING3,
-            controller::Action::LEFT_HAND_RING4,
-            controller::Action::LEFT_HAND_PINKY1,
-            controller::Action::LEFT_HAND_PINKY2,
-            controller::Action::LEFT_HAND_PINKY3,
-            controller::Action::LEFT_HAND_PINKY4,
-            controller::Action::RIGHT_HAND_THUMB1,
-            controller::Action::RIGHT_HAND_THUMB2,
-            controller::Action::RIGHT_HAND_THUMB3,
-            controller::Action::RIGHT_HAND_THUMB4,
-            controller::Action::RIGHT_HAND_INDEX1,
-            controller::Action::RIGHT_HAND_INDEX2,
-            controller::Action::RIGHT_HAND_INDEX3,
-            controller::Action::RIGHT_HAND_INDEX4,
-            controller::Action::RIGHT_HAND_MIDDLE1,
-            controller::Action::RIGHT_HAND_MIDDLE2,
-            controller::Action::RIGHT_HAND_MIDDLE3,
-            controller::Action::RIGHT_HAND_MIDDLE4,
-            controller::Action::RIGHT_HAND_RING1,
-            controller::Action::RIGHT_HAND_RING2,
-            controller::Action::RIGHT_HAND_RING3,
-            controller::Action::RIGHT_HAND_RING4,
-            controller::Action::RIGHT_HAND_PINKY1,
-            controller::Action::RIGHT_HAND_PINKY2,
-            controller::Action::RIGHT_HAND_PINKY3,
-            controller::Action::RIGHT_HAND_PINKY4,
-            controller::Action::LEFT_ARM,
-            controller::Action::RIGHT_ARM,
-            controller::Action::LEFT_SHOULDER,
-            controller::Action::RIGHT_SHOULDER,
-            controller::Action::LEFT_FORE_ARM,
-            controller::Action::RIGHT_FORE_ARM,
-            controller::Action::LEFT_LEG,
-            controller::Action::RIGHT_LEG,
-            controller::Action::LEFT_UP_LEG,
-            controller::Action::RIGHT_UP_LEG,
-            controller::Action::LEFT_TOE_BASE,
-            controller::Action::RIGHT_TOE_BASE,
-            controller::Action::LEFT_EYE,
-            controller::Action::RIGHT_EYE
+    // The workload engine only touches the workload space, the render scene and the entity simulation's changes, all of
+    // which lock, and what it hands the physics and the avatars is only picked up by stages that depend on it. So it runs
+    // on the thread pool while the input, dialog, grab and pick stages run here. Its views were updated before the graph ran.
+    auto workload = graph.addStage("workload", Affinity::AnyThread, {}, [this] {
+        _gameWorkload._engine->run();
+    });
 
-        };
+    auto devices = graph.addStage("devices", Affinity::MainThread, {}, [this] {
+        updateInputDevices(_updateDeltaTime);
+    });
 
-        // copy controller poses from userInputMapper to myAvatar.
-        glm::mat4 myAvatarMatrix = createMatFromQuatAndPos(myAvatar->getWorldOrientation(), myAvatar->getWorldPosition());
-        glm::mat4 worldToSensorMatrix = glm::inverse(myAvatar->getSensorToWorldMatrix());
-        glm::mat4 avatarToSensorMatrix = worldToSensorMatrix * myAvatarMatrix;
-        for (auto& action : avatarControllerActions) {
-            controller::Pose pose = userInputMapper->getPoseState(action);
-            myAvatar->setControllerPoseInSensorFrame(action, pose.transform(avatarToSensorMatrix));
-        }
+    auto threads = graph.addStage("threads", Affinity::MainThread, {}, [this] {
+        updateThreads(_updateDeltaTime); // If running non-threaded, then give the threads some time to process...
+        updateDialogs(_updateDeltaTime); // update various stats dialogs if present
+    });
 
-        static const std::vector<QString> trackedObjectStringLiterals = {
-            QStringLiteral("_TrackedObject00"), QStringLiteral("_TrackedObject01"), QStringLiteral("_TrackedObject02"), QStringLiteral("_TrackedObject03"),
-            QStringLiteral("_TrackedObject04"), QStringLiteral("_TrackedObject05"), QStringLiteral("_TrackedObject06"), QStringLiteral("_TrackedObject07"),
-            QStringLiteral("_TrackedObject08"), QStringLiteral("_TrackedObject09"), QStringLiteral("_TrackedObject10"), QStringLiteral("_TrackedObject11"),
-            QStringLiteral("_TrackedObject12"), QStringLiteral("_TrackedObject13"), QStringLiteral("_TrackedObject14"), QStringLiteral("_TrackedObject15")
-        };
+    auto grabs = graph.addStage("grabs", Affinity::MainThread, { devices }, [] {
+        DependencyManager::get<GrabManager>()->simulateGrabs();
+    });
 
-        // Controlled by the Developer > Avatar > Show Tracked Objects menu.
-        if (_showTrackedObjects) {
-            static const std::vector<controller::Action> trackedObjectActions = {
-                controller::Action::TRACKED_OBJECT_00, controller::Action::TRACKED_OBJECT_01, controller::Action::TRACKED_OBJECT_02, controller::Action::TRACKED_OBJECT_03,
-                controller::Action::TRACKED_OBJECT_04, controller::Action::TRACKED_OBJECT_05, controller::Action::TRACKED_OBJECT_06, controller::Action::TRACKED_OBJECT_07,
-                controller::Action::TRACKED_OBJECT_08, controller::Action::TRACKED_OBJECT_09, controller::Action::TRACKED_OBJECT_10, controller::Action::TRACKED_OBJECT_11,
-                controller::Action::TRACKED_OBJECT_12, controller::Action::TRACKED_OBJECT_13, controller::Action::TRACKED_OBJECT_14, controller::Action::TRACKED_OBJECT_15
-            };
+    auto picks = graph.addStage("pickManager", Affinity::MainThread, { devices }, [] {
+        DependencyManager::get<PickManager>()->update();
+    });
 
-            int i = 0;
-            glm::vec4 BLUE(0.0f, 0.0f, 1.0f, 1.0f);
-            for (auto& action : trackedObjectActions) {
-                controller::Pose pose = userInputMapper->getPoseState(action);
-                if (pose.valid) {
-                    glm::vec3 pos = transformPoint(myAvatarMatrix, pose.translation);
-                    glm::quat rot = glmExtractRotation(myAvatarMatrix) * pose.rotation;
-                    DebugDraw::getInstance().addMarker(trackedObjectStringLiterals[i], rot, pos, BLUE);
-                } else {
-                    DebugDraw::getInstance().removeMarker(trackedObjectStringLiterals[i]);
-                }
-                i++;
-            }
-        } else if (_prevShowTrackedObjects) {
-            for (auto& key : trackedObjectStringLiterals) {
-                DebugDraw::getInstance().removeMarker(key);
-            }
+    auto pointers = graph.addStage("pointerManager", Affinity::MainThread, { picks }, [] {
+        DependencyManager::get<PointerManager>()->update();
+    });
+
+    // reads the workload's views
+    auto prefetch = graph.addStage("prefetchResources", Affinity::MainThread, { workload }, [this] {
+        updateResourcePrefetching();
+    });
+
+    auto simulation = graph.addStage("simulation", Affinity::MainThread, { workload, devices, grabs, threads },
+                                     [this] {
+        updateSimulation(_updateDeltaTime);
+    });
+
+    auto otherAvatars = graph.addStage("otherAvatars", Affinity::MainThread, { workload, simulation }, [this] {
+        PROFILE_RANGE(simulation, "OtherAvatars");
+        DependencyManager::get<AvatarManager>()->updateOtherAvatars(_updateDeltaTime);
+    });
+
+    auto myAvatar = graph.addStage("MyAvatar", Affinity::MainThread, { otherAvatars, pointers }, [this] {
+        PROFILE_RANGE(simulation, "MyAvatar");
+        updateMyAvatarLookAtPosition(_updateDeltaTime);
+        DependencyManager::get<AvatarManager>()->updateMyAvatar(_updateDeltaTime);
+    });
+
+    auto lod = graph.addStage("LOD", Affinity::MainThread, { myAvatar }, [this] {
+        updateLOD(_updateDeltaTime);
+
+        if (!_loginDialogID.isNull()) {
+            _loginStateManager.update(getMyAvatar()->getDominantHand(), _loginDialogID);
+            updateLoginDialogPosition();
         }
-        _prevShowTrackedObjects = _showTrackedObjects;
-    }
+    });
 
-    updateThreads(deltaTime); // If running non-threaded, then give the threads some time to process...
-    updateDialogs(deltaTime); // update various stats dialogs if present
+    auto overlays = graph.addStage("overlays", Affinity::MainThread, { myAvatar }, [this] {
+        PROFILE_RANGE_EX(app, "Overlays", 0xffff0000, (uint64_t)getActiveDisplayPlugin()->presentCount());
+        _overlays.update(_updateDeltaTime);
+    });
 
-    auto grabManager = DependencyManager::get<GrabManager>();
-    grabManager->simulateGrabs();
+    auto queries = graph.addStage("queryOctree", Affinity::MainThread, { myAvatar, prefetch }, [this] {
+        updateViewsAndQueries();
+    });
 
-    // TODO: break these out into distinct perfTimers when they prove interesting
-    {
-        PROFILE_RANGE(app, "PickManager");
-        PerformanceTimer perfTimer("pickManager");
-        DependencyManager::get<PickManager>()->update();
-    }
+    auto avatarsPostUpdate = graph.addStage("avatarManager/postUpdate", Affinity::MainThread, { myAvatar }, [this] {
+        DependencyManager::get<AvatarManager>()->postUpdate(_updateDeltaTime, getMain3DScene());
+    });
 
-    {
-        PROFILE_RANGE(app, "PointerManager");
-        PerformanceTimer perfTimer("pointerManager");
-        DependencyManager::get<PointerManager>()->update();
-    }
+    auto postUpdateLambdas = graph.addStage("postUpdateLambdas", Affinity::MainThread, { avatarsPostUpdate }, [this] {
+        PROFILE_RANGE_EX(app, "PostUpdateLambdas", 0xffff0000, (uint64_t)0);
+        std::unique_lock<std::mutex> guard(_postUpdateLambdasLock);
+        for (auto& iter : _postUpdateLambdas) {
+            iter.second();
+        }
+        _postUpdateLambdas.clear();
+    });
 
-    QSharedPointer<AvatarManager> avatarManager = DependencyManager::get<AvatarManager>();
+    auto renderArgs = graph.addStage("renderArgs", Affinity::MainThread, { lod, overlays, queries, postUpdateLambdas },
+                                     [this] {
+        updateRenderArgs(_updateDeltaTime);
+    });
 
-    {
-        PROFILE_RANGE(simulation_physics, "Simulation");
-        PerformanceTimer perfTimer("simulation");
+    auto animDebugDraw = graph.addStage("AnimDebugDraw", Affinity::MainThread, { renderArgs }, [] {
+        AnimDebugDraw::getInstance().update();
+    });
 
-        getEntities()->preUpdate();
-        _entitySimulation->removeDeadEntities();
+    // Game loop is done, mark the end of the frame for the scene transactions and the render loop to take over
+    graph.addStage("enqueueFrame", Affinity::MainThread, { workload, animDebugDraw }, [this] {
+        getMain3DScene()->enqueueFrame();
 
-        auto t0 = std::chrono::high_resolution_clock::now();
-        auto t1 = t0;
-        {
-            PROFILE_RANGE(simulation_physics, "PrePhysics");
-            PerformanceTimer perfTimer("prePhysics)");
-            {
-                PROFILE_RANGE(simulation_physics, "Entities");
-                PhysicsEngine::Transaction transaction;
-                _entitySimulation->buildPhysicsTransaction(transaction);
-                _physicsEngine->processTransaction(transaction);
-                _entitySimulation->handleProcessedPhysicsTransaction(transaction);
-            }
+        // If the display plugin is inactive then the frames won't be processed so process them here.
+        if (!getActiveDisplayPlugin()->isActive()) {
+            getMain3DScene()->processTransactionQueue();
+        }
 
-            t1 = std::chrono::high_resolution_clock::now();
+        // decide if the sensorToWorldMatrix is changing in a way that warrents squeezing the edges of the view down
+        if (getActiveDisplayPlugin()->isHmd()) {
+            _visionSqueeze.updateVisionSqueeze(getMyAvatar()->getSensorToWorldMatrix(), _updateDeltaTime);
+        }
+    });
+}
 
-            {
-                PROFILE_RANGE(simulation_physics, "Avatars");
-                PhysicsEngine::Transaction transaction;
-                avatarManager->buildPhysicsTransaction(transaction);
-                _physicsEngine->processTransaction(transaction);
-                avatarManager->handleProcessedPhysicsTransaction(transaction);
-
-                myAvatar->prepareForPhysicsSimulation();
-                myAvatar->getCharacterController()->preSimulation();
+void Application::updateResourcePrefetching() {
+    // look ahead as far as the entities are kinematically animated
+    float prefetchRadius = 0.0f;
+    auto controlViewsConfig = _gameWorkload._engine->getConfiguration()->getConfig<workload::ControlViews>("controlViews");
+    if (controlViewsConfig) {
+        prefetchRadius = controlViewsConfig->r3RangeFront();
+    }
+    auto myAvatar = getMyAvatar();
+    if (prefetchRadius > 0.0f) {
+        _resourcePrefetcher.update(getEntities()->getTree(), myAvatar->getWorldPosition(), myAvatar->getWorldVelocity(),
+                                   myAvatar->getNextPosition(), prefetchRadius);
+    }
+}
+
+void Application::updateInputDevices(float deltaTime) {
+    auto myAvatar = getMyAvatar();
+    auto userInputMapper = DependencyManager::get<UserInputMapper>();
+
+    controller::HmdAvatarAlignmentType hmdAvatarAlignmentType;
+    if (myAvatar->getHmdAvatarAlignmentType() == "eyes") {
+        hmdAvatarAlignmentType = controller::HmdAvatarAlignmentType::Eyes;
+    } else {
+        hmdAvatarAlignmentType = controller::HmdAvatarAlignmentType::Head;
+    }
+
+    controller::InputCalibrationData calibrationData = {
+        myAvatar->getSensorToWorldMatrix(),
+        createMatFromQuatAndPos(myAvatar->getWorldOrientation(), myAvatar->getWorldPosition()),
+        myAvatar->getHMDSensorMatrix(),
+        myAvatar->getCenterEyeCalibrationMat(),
+        myAvatar->getHeadCalibrationMat(),
+        myAvatar->getSpine2CalibrationMat(),
+        myAvatar->getHipsCalibrationMat(),
+        myAvatar->getLeftFootCalibrationMat(),
+        myAvatar->getRightFootCalibrationMat(),
+        myAvatar->getRightArmCalibrationMat(),
+        myAvatar->getLeftArmCalibrationMat(),
+        myAvatar->getRightHandCalibrationMat(),
+        myAvatar->getLeftHandCalibrationMat(),
+        hmdAvatarAlignmentType
+    };
+
+    InputPluginPointer keyboardMousePlugin;
+    for(const auto& inputPlugin : PluginManager::getInstance()->getInputPlugins()) {
+        if (inputPlugin->getName() == KeyboardMouseDevice::NAME) {
+            keyboardMousePlugin = inputPlugin;
+        } else if (inputPlugin->isActive()) {
+            inputPlugin->pluginUpdate(deltaTime, calibrationData);
+        }
+    }
+
+    userInputMapper->setInputCalibrationData(calibrationData);
+    userInputMapper->update(deltaTime);
+
+    if (keyboardMousePlugin && keyboardMousePlugin->isActive()) {
+        keyboardMousePlugin->pluginUpdate(deltaTime, calibrationData);
+    }
+    // Transfer the user inputs to the driveKeys
+    // FIXME can we drop drive keys and just have the avatar read the action states directly?
+    myAvatar->clearDriveKeys();
+    if (_myCamera.getMode() != CAMERA_MODE_INDEPENDENT && !isInterstitialMode()) {
+        if (!_controllerScriptingInterface->areActionsCaptured() && _myCamera.getMode() != CAMERA_MODE_MIRROR) {
+            myAvatar->setDriveKey(MyAvatar::TRANSLATE_Z, -1.0f * userInputMapper->getActionState(controller::Action::TRANSLATE_Z));
+            myAvatar->setDriveKey(MyAvatar::TRANSLATE_Y, userInputMapper->getActionState(controller::Action::TRANSLATE_Y));
+            myAvatar->setDriveKey(MyAvatar::TRANSLATE_X, userInputMapper->getActionState(controller::Action::TRANSLATE_X));
+            if (deltaTime > FLT_EPSILON && userInputMapper->getActionState(controller::Action::TRANSLATE_CAMERA_Z)  == 0.0f) {
+                myAvatar->setDriveKey(MyAvatar::PITCH, -1.0f * userInputMapper->getActionState(controller::Action::PITCH));
+                myAvatar->setDriveKey(MyAvatar::YAW, -1.0f * userInputMapper->getActionState(controller::Action::YAW));
+                myAvatar->setDriveKey(MyAvatar::DELTA_PITCH, -_myCamera.getSensitivity() * userInputMapper->getActionState(controller::Action::DELTA_PITCH));
+                myAvatar->setDriveKey(MyAvatar::DELTA_YAW, -_myCamera.getSensitivity() * userInputMapper->getActionState(controller::Action::DELTA_YAW));
+                myAvatar->setDriveKey(MyAvatar::STEP_YAW, -1.0f * userInputMapper->getActionState(controller::Action::STEP_YAW));
             }
         }
+        myAvatar->setDriveKey(MyAvatar::ZOOM, userInputMapper->getActionState(controller::Action::TRANSLATE_CAMERA_Z));
+    }
+
+    myAvatar->setSprintMode((bool)userInputMapper->getActionState(controller::Action::SPRINT));
+    static const std::vector<controller::Action> avatarControllerActions = {
+        controller::Action::LEFT_HAND,
+        controller::Action::RIGHT_HAND,
+        controller::Action::LEFT_FOOT,
+        controller::Action::RIGHT_FOOT,
+        controller::Action::HIPS,
+        controller::Action::SPINE2,
+        controller::Action::HEAD,
+        controller::Action::LEFT_HAND_THUMB1,
+        controller::Action::LEFT_HAND_THUMB2,
+        controller::Action::LEFT_HAND_THUMB3,
+        controller::Action::LEFT_HAND_THUMB4,
+        controller::Action::LEFT_HAND_INDEX1,
+        controller::Action::LEFT_HAND_INDEX2,
+        controller::Action::LEFT_HAND_INDEX3,
+        controller::Action::LEFT_HAND_INDEX4,
+        controller::Action::LEFT_HAND_MIDDLE1,
+        controller::Action::LEFT_HAND_MIDDLE2,
+        controller::Action::LEFT_HAND_MIDDLE3,
+        controller::Action::LEFT_HAND_MIDDLE4,
+        controller::Action::LEFT_HAND_RING1,
+        controller::Action::LEFT_HAND_RING2,
+        controller::Action::LEFT_HAND_RING3,
+        controller::Action::LEFT_HAND_RING4,
+        controller::Action::LEFT_HAND_PINKY1,
+        controller::Action::LEFT_HAND_PINKY2,
+        controller::Action::LEFT_HAND_PINKY3,
+        controller::Action::LEFT_HAND_PINKY4,
+        controller::Action::RIGHT_HAND_THUMB1,
+        controller::Action::RIGHT_HAND_THUMB2,
+        controller::Action::RIGHT_HAND_THUMB3,
+        controller::Action::RIGHT_HAND_THUMB4,
+        controller::Action::RIGHT_HAND_INDEX1,
+        controller::Action::RIGHT_HAND_INDEX2,
+        controller::Action::RIGHT_HAND_INDEX3,
+        controller::Action::RIGHT_HAND_INDEX4,
+        controller::Action::RIGHT_HAND_MIDDLE1,
+        controller::Action::RIGHT_HAND_MIDDLE2,
+        controller::Action::RIGHT_HAND_MIDDLE3,
+        controller::Action::RIGHT_HAND_MIDDLE4,
+        controller::Action::RIGHT_HAND_RING1,
+        controller::Action::RIGHT_HAND_RING2,
+        controller::Action::RIGHT_HAND_RING3,
+        controller::Action::RIGHT_HAND_RING4,
+        controller::Action::RIGHT_HAND_PINKY1,
+        controller::Action::RIGHT_HAND_PINKY2,
+        controller::Action::RIGHT_HAND_PINKY3,
+        controller::Action::RIGHT_HAND_PINKY4,
+        controller::Action::LEFT_ARM,
+        controller::Action::RIGHT_ARM,
+        controller::Action::LEFT_SHOULDER,
+        controller::Action::RIGHT_SHOULDER,
+        controller::Action::LEFT_FORE_ARM,
+        controller::Action::RIGHT_FORE_ARM,
+        controller::Action::LEFT_LEG,
+        controller::Action::RIGHT_LEG,
+        controller::Action::LEFT_UP_LEG,
+        controller::Action::RIGHT_UP_LEG,
+        controller::Action::LEFT_TOE_BASE,
+        controller::Action::RIGHT_TOE_BASE,
+        controller::Action::LEFT_EYE,
+        controller::Action::RIGHT_EYE
 
-        if (_physicsEnabled) {
-            {
-                PROFILE_RANGE(simulation_physics, "PrepareActions");
-                _entitySimulation->applyDynamicChanges();
-                _physicsEngine->forEachDynamic([&](EntityDynamicPointer dynamic) {
-                    dynamic->prepareForPhysicsSimulation();
-                });
-            }
-            auto t2 = std::chrono::high_resolution_clock::now();
-            {
-                PROFILE_RANGE(simulation_physics, "StepPhysics");
-                PerformanceTimer perfTimer("stepPhysics");
-                getEntities()->getTree()->withWriteLock([&] {
-                    _physicsEngine->stepSimulation();
-                });
-            }
-            auto t3 = std::chrono::high_resolution_clock::now();
-            {
-                if (_physicsEngine->hasOutgoingChanges()) {
-                    {
-                        PROFILE_RANGE(simulation_physics, "PostPhysics");
-                        PerformanceTimer perfTimer("postPhysics");
-                        // grab the collision events BEFORE handleChangedMotionStates() because at this point
-                        // we have a better idea of which objects we own or should own.
-                        auto& collisionEvents = _physicsEngine->getCollisionEvents();
-
-                        getEntities()->getTree()->withWriteLock([&] {
-                            PROFILE_RANGE(simulation_physics, "HandleChanges");
-                            PerformanceTimer perfTimer("handleChanges");
-
-                            const VectorOfMotionStates& outgoingChanges = _physicsEngine->getChangedMotionStates();
-                            _entitySimulation->handleChangedMotionStates(outgoingChanges);
-                            avatarManager->handleChangedMotionStates(outgoingChanges);
-
-                            const VectorOfMotionStates& deactivations = _physicsEngine->getDeactivatedMotionStates();
-                            _entitySimulation->handleDeactivatedMotionStates(deactivations);
-                        });
-
-                        // handleCollisionEvents() AFTER handleChangedMotionStates()
-                        {
-                            PROFILE_RANGE(simulation_physics, "CollisionEvents");
-                            avatarManager->handleCollisionEvents(collisionEvents);
-                            // Collision events (and their scripts) must not be handled when we're locked, above. (That would risk
-                            // deadlock.)
-                            _entitySimulation->handleCollisionEvents(collisionEvents);
-                        }
+    };
 
-                        {
-                            PROFILE_RANGE(simulation_physics, "MyAvatar");
-                            myAvatar->getCharacterController()->postSimulation();
-                            myAvatar->harvestResultsFromPhysicsSimulation(deltaTime);
-                        }
+    // copy controller poses from userInputMapper to myAvatar.
+    glm::mat4 myAvatarMatrix = createMatFromQuatAndPos(myAvatar->getWorldOrientation(), myAvatar->getWorldPosition());
+    glm::mat4 worldToSensorMatrix = glm::inverse(myAvatar->getSensorToWorldMatrix());
+    glm::mat4 avatarToSensorMatrix = worldToSensorMatrix * myAvatarMatrix;
+    for (auto& action : avatarControllerActions) {
+        controller::Pose pose = userInputMapper->getPoseState(action);
+        myAvatar->setControllerPoseInSensorFrame(action, pose.transform(avatarToSensorMatrix));
+    }
 
-                        if (PerformanceTimer::isActive() &&
-                                Menu::getInstance()->isOptionChecked(MenuOption::DisplayDebugTimingDetails) &&
-                                Menu::getInstance()->isOptionChecked(MenuOption::ExpandPhysicsTiming)) {
-                            _physicsEngine->harvestPerformanceStats();
-                        }
-                        // NOTE: the PhysicsEngine stats are written to stdout NOT to Qt log framework
-                        _physicsEngine->dumpStatsIfNecessary();
-                    }
-                    auto t4 = std::chrono::high_resolution_clock::now();
-
-                    // NOTE: the getEntities()->update() call below will wait for lock
-                    // and will provide non-physical entity motion
-                    getEntities()->update(true); // update the models...
-
-                    auto t5 = std::chrono::high_resolution_clock::now();
-
-                    workload::Timings timings(6);
-                    timings[0] = t1 - t0; // prePhysics entities
-                    timings[1] = t2 - t1; // prePhysics avatars
-                    timings[2] = t3 - t2; // stepPhysics
-                    timings[3] = t4 - t3; // postPhysics
-                    timings[4] = t5 - t4; // non-physical kinematics
-                    timings[5] = workload::Timing_ns((int32_t)(NSECS_PER_SECOND * deltaTime)); // game loop duration
-                    _gameWorkload.updateSimulationTimings(timings);
-                }
+    static const std::vector<QString> trackedObjectStringLiterals = {
+        QStringLiteral("_TrackedObject00"), QStringLiteral("_TrackedObject01"), QStringLiteral("_TrackedObject02"), QStringLiteral("_TrackedObject03"),
+        QStringLiteral("_TrackedObject04"), QStringLiteral("_TrackedObject05"), QStringLiteral("_TrackedObject06"), QStringLiteral("_TrackedObject07"),
+        QStringLiteral("_TrackedObject08"), QStringLiteral("_TrackedObject09"), QStringLiteral("_TrackedObject10"), QStringLiteral("_TrackedObject11"),
+        QStringLiteral("_TrackedObject12"), QStringLiteral("_TrackedObject13"), QStringLiteral("_TrackedObject14"), QStringLiteral("_TrackedObject15")
+    };
+
+    // Controlled by the Developer > Avatar > Show Tracked Objects menu.
+    if (_showTrackedObjects) {
+        static const std::vector<controller::Action> trackedObjectActions = {
+            controller::Action::TRACKED_OBJECT_00, controller::Action::TRACKED_OBJECT_01, controller::Action::TRACKED_OBJECT_02, controller::Action::TRACKED_OBJECT_03,
+            controller::Action::TRACKED_OBJECT_04, controller::Action::TRACKED_OBJECT_05, controller::Action::TRACKED_OBJECT_06, controller::Action::TRACKED_OBJECT_07,
+            controller::Action::TRACKED_OBJECT_08, controller::Action::TRACKED_OBJECT_09, controller::Action::TRACKED_OBJECT_10, controller::Action::TRACKED_OBJECT_11,
+            controller::Action::TRACKED_OBJECT_12, controller::Action::TRACKED_OBJECT_13, controller::Action::TRACKED_OBJECT_14, controller::Action::TRACKED_OBJECT_15
+        };
+
+        int i = 0;
+        glm::vec4 BLUE(0.0f, 0.0f, 1.0f, 1.0f);
+        for (auto& action : trackedObjectActions) {
+            controller::Pose pose = userInputMapper->getPoseState(action);
+            if (pose.valid) {
+                glm::vec3 pos = transformPoint(myAvatarMatrix, pose.translation);
+                glm::quat rot = glmExtractRotation(myAvatarMatrix) * pose.rotation;
+                DebugDraw::getInstance().addMarker(trackedObjectStringLiterals[i], rot, pos, BLUE);
+            } else {
+                DebugDraw::getInstance().removeMarker(trackedObjectStringLiterals[i]);
             }
-        } else {
-            // update the rendering without any simulation
-            getEntities()->update(false);
+            i++;
+        }
+    } else if (_prevShowTrackedObjects) {
+        for (auto& key : trackedObjectStringLiterals) {
+            DebugDraw::getInstance().removeMarker(key);
         }
-        // remove recently dead avatarEntities
-        SetOfEntities deadAvatarEntities;
-        _entitySimulation->takeDeadAvatarEntities(deadAvatarEntities);
-        avatarManager->removeDeadAvatarEntities(deadAvatarEntities);
     }
+    _prevShowTrackedObjects = _showTrackedObjects;
+}
 
-    // AvatarManager update
+void Application::updateSimulation(float deltaTime) {
+    auto myAvatar = getMyAvatar();
+    QSharedPointer<AvatarManager> avatarManager = DependencyManager::get<AvatarManager>();
+
+    PROFILE_RANGE(simulation_physics, "Simulation");
+
+    getEntities()->preUpdate();
+    _entitySimulation->removeDeadEntities();
+
+    auto t0 = std::chrono::high_resolution_clock::now();
+    auto t1 = t0;
     {
+        PROFILE_RANGE(simulation_physics, "PrePhysics");
+        PerformanceTimer perfTimer("prePhysics)");
         {
-            PROFILE_RANGE(simulation, "OtherAvatars");
-            PerformanceTimer perfTimer("otherAvatars");
-            avatarManager->updateOtherAvatars(deltaTime);
+            PROFILE_RANGE(simulation_physics, "Entities");
+            PhysicsEngine::Transaction transaction;
+            _entitySimulation->buildPhysicsTransaction(transaction);
+            _physicsEngine->processTransaction(transaction);
+            _entitySimulation->handleProcessedPhysicsTransaction(transaction);
         }
 
+        t1 = std::chrono::high_resolution_clock::now();
+
         {
-            PROFILE_RANGE(simulation, "MyAvatar");
-            PerformanceTimer perfTimer("MyAvatar");
-            qApp->updateMyAvatarLookAtPosition(deltaTime);
-            avatarManager->updateMyAvatar(deltaTime);
+            PROFILE_RANGE(simulation_physics, "Avatars");
+            PhysicsEngine::Transaction transaction;
+            avatarManager->buildPhysicsTransaction(transaction);
+            _physicsEngine->processTransaction(transaction);
+            avatarManager->handleProcessedPhysicsTransaction(transaction);
+
+            myAvatar->prepareForPhysicsSimulation();
+            myAvatar->getCharacterController()->preSimulation();
         }
     }
 
-    bool showWarnings = Menu::getInstance()->isOptionChecked(MenuOption::PipelineWarnings);
-    PerformanceWarning warn(showWarnings, "Application::update()");
+    if (_physicsEnabled) {
+        {
+            PROFILE_RANGE(simulation_physics, "PrepareActions");
+            _entitySimulation->applyDynamicChanges();
+            _physicsEngine->forEachDynamic([&](EntityDynamicPointer dynamic) {
+                dynamic->prepareForPhysicsSimulation();
+            });
+        }
+        auto t2 = std::chrono::high_resolution_clock::now();
+        {
+            PROFILE_RANGE(simulation_physics, "StepPhysics");
+            PerformanceTimer perfTimer("stepPhysics");
+            getEntities()->getTree()->withWriteLock([&] {
+                _physicsEngine->stepSimulation();
+            });
+        }
+        auto t3 = std::chrono::high_resolution_clock::now();
+        {
+            if (_physicsEngine->hasOutgoingChanges()) {
+                {
+                    PROFILE_RANGE(simulation_physics, "PostPhysics");
+                    PerformanceTimer perfTimer("postPhysics");
+                    // grab the collision events BEFORE handleChangedMotionStates() because at this point
+                    // we have a better idea of which objects we own or should own.
+                    auto& collisionEvents = _physicsEngine->getCollisionEvents();
+
+                    getEntities()->getTree()->withWriteLock([&] {
+                        PROFILE_RANGE(simulation_physics, "HandleChanges");
+                        PerformanceTimer perfTimer("handleChanges");
+
+                        const VectorOfMotionStates& outgoingChanges = _physicsEngine->getChangedMotionStates();
+                        _entitySimulation->handleChangedMotionStates(outgoingChanges);
+                        avatarManager->handleChangedMotionStates(outgoingChanges);
+
+                        const VectorOfMotionStates& deactivations = _physicsEngine->getDeactivatedMotionStates();
+                        _entitySimulation->handleDeactivatedMotionStates(deactivations);
+                    });
 
-    updateLOD(deltaTime);
+                    // handleCollisionEvents() AFTER handleChangedMotionStates()
+                    {
+                        PROFILE_RANGE(simulation_physics, "CollisionEvents");
+                        avatarManager->handleCollisionEvents(collisionEvents);
+                        // Collision events (and their scripts) must not be handled when we're locked, above. (That would risk
+                        // deadlock.)
+                        _entitySimulation->handleCollisionEvents(collisionEvents);
+                    }
 
-    if (!_loginDialogID.isNull()) {
-        _loginStateManager.update(getMyAvatar()->getDominantHand(), _loginDialogID);
-        updateLoginDialogPosition();
-    }
+                    {
+                        PROFILE_RANGE(simulation_physics, "MyAvatar");
+                        myAvatar->getCharacterController()->postSimulation();
+                        myAvatar->harvestResultsFromPhysicsSimulation(deltaTime);
+                    }
 
-    {
-        PROFILE_RANGE_EX(app, "Overlays", 0xffff0000, (uint64_t)getActiveDisplayPlugin()->presentCount());
-        PerformanceTimer perfTimer("overlays");
-        _overlays.update(deltaTime);
+                    if (PerformanceTimer::isActive() &&
+                            Menu::getInstance()->isOptionChecked(MenuOption::DisplayDebugTimingDetails) &&
+                            Menu::getInstance()->isOptionChecked(MenuOption::ExpandPhysicsTiming)) {
+                        _physicsEngine->harvestPerformanceStats();
+                    }
+                    // NOTE: the PhysicsEngine stats are written to stdout NOT to Qt log framework
+                    _physicsEngine->dumpStatsIfNecessary();
+                }
+                auto t4 = std::chrono::high_resolution_clock::now();
+
+                // NOTE: the getEntities()->update() call below will wait for lock
+                // and will provide non-physical entity motion
+                getEntities()->update(true); // update the models...
+
+                auto t5 = std::chrono::high_resolution_clock::now();
+
+                workload::Timings timings(6);
+                timings[0] = t1 - t0; // prePhysics entities
+                timings[1] = t2 - t1; // prePhysics avatars
+                timings[2] = t3 - t2; // stepPhysics
+                timings[3] = t4 - t3; // postPhysics
+                timings[4] = t5 - t4; // non-physical kinematics
+                timings[5] = workload::Timing_ns((int32_t)(NSECS_PER_SECOND * deltaTime)); // game loop duration
+                _gameWorkload.updateSimulationTimings(timings);
+            }
+        }
+    } else {
+        // update the rendering without any simulation
+        getEntities()->update(false);
     }
+    // remove recently dead avatarEntities
+    SetOfEntities deadAvatarEntities;
+    _entitySimulation->takeDeadAvatarEntities(deadAvatarEntities);
+    avatarManager->removeDeadAvatarEntities(deadAvatarEntities);
+}
 
+void Application::updateViewsAndQueries() {
     // Update _viewFrustum with latest camera and view frustum data...
     // NOTE: we get this from the view frustum, to make it simpler, since the
     // loadViewFrumstum() method will get the correct details from the camera
@@ -6767,7 +6891,6 @@ void Application::update(float deltaTime) {
     // Update my voxel servers with my current voxel query...
     {
         PROFILE_RANGE_EX(app, "QueryOctree", 0xffff0000, (uint64_t)getActiveDisplayPlugin()->presentCount());
-        PerformanceTimer perfTimer("queryOctree");
         QMutexLocker viewLocker(&_viewMutex);
 
         bool viewIsDifferentEnough = false;
@@ -6816,46 +6939,6 @@ void Application::update(float deltaTime) {
             QMetaObject::invokeMethod(DependencyManager::get<AudioClient>().data(), "sendDownstreamAudioStatsPacket", Qt::QueuedConnection);
         }
     }
-
-    {
-        PerformanceTimer perfTimer("avatarManager/postUpdate");
-        avatarManager->postUpdate(deltaTime, getMain3DScene());
-    }
-
-    {
-        PROFILE_RANGE_EX(app, "PostUpdateLambdas", 0xffff0000, (uint64_t)0);
-        PerformanceTimer perfTimer("postUpdateLambdas");
-        std::unique_lock<std::mutex> guard(_postUpdateLambdasLock);
-        for (auto& iter : _postUpdateLambdas) {
-            iter.second();
-        }
-        _postUpdateLambdas.clear();
-    }
-
-
-    updateRenderArgs(deltaTime);
-
-    {
-        PerformanceTimer perfTimer("AnimDebugDraw");
-        AnimDebugDraw::getInstance().update();
-    }
-
-
-    { // Game loop is done, mark the end of the frame for the scene transactions and the render loop to take over
-        PerformanceTimer perfTimer("enqueueFrame");
-        getMain3DScene()->enqueueFrame();
-    }
-
-    // If the display plugin is inactive then the frames won't be processed so process them here.
-    if (!getActiveDisplayPlugin()->isActive()) {
-        getMain3DScene()->processTransactionQueue();
-    }
-
-    // decide if the sensorToWorldMatrix is changing in a way that warrents squeezing the edges of the view down
-    if (getActiveDisplayPlugin()->isHmd()) {
-        PerformanceTimer perfTimer("squeezeVision");
-        _visionSqueeze.updateVisionSqueeze(myAvatar->getSensorToWorldMatrix(), deltaTime);
-    }
 }
 
 void Application::updateRenderArgs(float deltaTime) {
@@ -6958,6 +7041,28 @@ void Application::updateRenderArgs(float deltaTime) {
                     eyeProjections[eye] = getActiveDisplayPlugin()->getEyeProjection(eye, baseProjection);
                 });
 
+                // Where the eye tracker has the eyes look, for the foveated rendering to keep the full shading rate there
+                auto myAvatar = getMyAvatar();
+                controller::Pose leftEyePose = myAvatar->getControllerPoseInAvatarFrame(controller::Action::LEFT_EYE);
+                controller::Pose rightEyePose = myAvatar->getControllerPoseInAvatarFrame(controller::Action::RIGHT_EYE);
+                if (leftEyePose.isValid() && rightEyePose.isValid()) {
+                    glm::quat avatarToCamera = glm::inverse(_myCamera.getOrientation()) * myAvatar->getWorldOrientation();
+                    glm::vec4& gazeCenters = appRenderArgs._renderArgs._gazeCenters;
+                    for_each_eye([&](Eye eye) {
+                        const auto& eyePose = (eye == Eye::Left) ? leftEyePose : rightEyePose;
+                        glm::vec3 gaze = avatarToCamera * eyePose.rotation * Vectors::UNIT_Z;
+                        glm::vec4 clip = eyeProjections[eye] * glm::vec4(gaze, 1.0f);
+                        glm::vec2 center = (clip.w > 0.0f) ? glm::clamp(glm::vec2(clip) / clip.w, -1.0f, 1.0f) : glm::vec2(0.0f);
+                        if (eye == Eye::Left) {
+                            gazeCenters.x = center.x;
+                            gazeCenters.y = center.y;
+                        } else {
+                            gazeCenters.z = center.x;
+                            gazeCenters.w = center.y;
+                        }
+                    });
+                }
+
                 // Configure the type of display / stereo
                 appRenderArgs._renderArgs._displayMode = (isHMDMode() ? RenderArgs::STEREO_HMD : RenderArgs::STEREO_MONITOR);
             }
@@ -7282,6 +7387,34 @@ void Application::updateWindowTitle() const {
     DependencyManager::get< MessagesClient >()->sendLocalMessage("Toolbar-DomainChanged", "");
 }
 
+void Application::resetSceneBundle() {
+    // ask the next entity server for a bundle to start from
+    _sceneBundleLoader.cancel();
+    QJsonObject jsonParameters;
+    jsonParameters[EntityJSONQueryProperties::SCENE_BUNDLE_VERSION_PROPERTY] =
+        (double)EntityJSONQueryProperties::SCENE_BUNDLE_WANTED;
+    _octreeQuery.setJSONParameters(jsonParameters);
+}
+
+void Application::loadSceneBundle(quint64 version, QUrl url, SharedNodePointer entityServer) {
+    auto jsonParameters = _octreeQuery.getJSONParameters();
+    if (jsonParameters[EntityJSONQueryProperties::SCENE_BUNDLE_VERSION_PROPERTY].toDouble() !=
+        (double)EntityJSONQueryProperties::SCENE_BUNDLE_WANTED) {
+        // already loading or loaded one
+        return;
+    }
+    qCDebug(interfaceapp) << "Loading scene bundle" << version << "from" << url;
+    _sceneBundleLoader.load(version, url, entityServer, getEntities()->getTree(), getMyAvatar()->getWorldPosition());
+}
+
+void Application::sceneBundleLoaded(qint64 version) {
+    // tell the entity server which entities need not be sent
+    QJsonObject jsonParameters;
+    jsonParameters[EntityJSONQueryProperties::SCENE_BUNDLE_VERSION_PROPERTY] = (double)version;
+    _octreeQuery.setJSONParameters(jsonParameters);
+    _queryExpiry = SteadyClock::now();
+}
+
 void Application::clearDomainOctreeDetails(bool clearAll) {
     // if we're about to quit, we really don't need to do the rest of these things...
     if (_aboutToQuit) {
@@ -7299,6 +7432,8 @@ void Application::clearDomainOctreeDetails(bool clearAll) {
 
     // reset the model renderer
     clearAll ? getEntities()->clear() : getEntities()->clearDomainAndNonOwnedEntities();
+    _resourcePrefetcher.clear();
+    resetSceneBundle();
 
     DependencyManager::get<AnimationCache>()->clearUnusedResources();
     DependencyManager::get<SoundCache>()->clearUnusedResources();
@@ -8745,7 +8880,7 @@ void Application::shareSnapshot(const QString& path, const QUrl& href) {
 }
 
 float Application::getRenderResolutionScale() const {
-    return RenderScriptingInterface::getInstance()->getViewportResolutionScale();
+    return RenderScriptingInterface::getInstance()->getDynamicResolutionScale();
 }
 
 void Application::notifyPacketVersionMismatch() {
@@ -9187,6 +9322,10 @@ void Application::setShowBulletWireframe(bool value) {
     _physicsEngine->setShowBulletWireframe(value);
 }
 
+void Application::setBulkMotionStateSync(bool value) {
+    _physicsEngine->setBulkMotionStateSync(value);
+}
+
 void Application::setShowBulletAABBs(bool value) {
     _physicsEngine->setShowBulletAABBs(value);
 }
@@ -9565,6 +9704,10 @@ void Application::saveNextPhysicsStats(QString filename) {
     _physicsEngine->saveNextPhysicsStats(filename);
 }
 
+void Application::saveNextPhysicsSnapshot(QString filename) {
+    _physicsEngine->saveNextSnapshot(filename);
+}
+
 void Application::copyToClipboard(const QString& text) {
     if (QThread::currentThread() != qApp->thread()) {
         QMetaObject::invokeMethod(this, "copyToClipboard");
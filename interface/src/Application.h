@@ -63,8 +63,11 @@
 #include "LoginStateManager.h"
 #include "Menu.h"
 #include "PerformanceManager.h"
+#include "UpdateGraph.h"
 #include "RefreshRateManager.h"
 #include "octree/OctreePacketProcessor.h"
+#include "octree/ResourcePrefetcher.h"
+#include "octree/SceneBundleLoader.h"
 #include "render/Engine.h"
 #include "scripting/ControllerScriptingInterface.h"
 #include "scripting/DialogsManagerScriptingInterface.h"
@@ -202,6 +205,7 @@ public:
     Overlays& getOverlays() { return _overlays; }
 
     PerformanceManager& getPerformanceManager() { return _performanceManager; }
+    UpdateGraph& getUpdateGraph() { return _updateGraph; }
     RefreshRateManager& getRefreshRateManager() { return _refreshRateManager; }
 
     size_t getRenderFrameCount() const { return _graphicsEngine.getRenderFrameCount(); }
@@ -266,6 +270,7 @@ public:
     bool isAboutToQuit() const { return _aboutToQuit; }
     bool isPhysicsEnabled() const { return _physicsEnabled; }
     PhysicsEnginePointer getPhysicsEngine() { return _physicsEngine; }
+    PhysicalEntitySimulationPointer getEntitySimulation() { return _entitySimulation; }
 
     // the isHMDMode is true whenever we use the interface from an HMD and not a standard flat display
     // rendering of several elements depend on that
@@ -314,6 +319,7 @@ public:
     QUrl getAvatarOverrideUrl() { return _avatarOverrideUrl; }
     bool getSaveAvatarOverrideUrl() { return _saveAvatarOverrideUrl; }
     void saveNextPhysicsStats(QString filename);
+    void saveNextPhysicsSnapshot(QString filename);
 
     bool isServerlessMode() const;
     bool isInterstitialMode() const { return _interstitialMode; }
@@ -506,6 +512,9 @@ private slots:
 
     void notifyPacketVersionMismatch();
 
+    void loadSceneBundle(quint64 version, QUrl url, SharedNodePointer entityServer);
+    void sceneBundleLoaded(qint64 version);
+
     void loadSettings();
     void saveSettings() const;
     void setFailedToConnectToEntityServer();
@@ -542,6 +551,7 @@ private slots:
     void switchDisplayMode();
 
     void setShowBulletWireframe(bool value);
+    void setBulkMotionStateSync(bool value);
     void setShowBulletAABBs(bool value);
     void setShowBulletContactPoints(bool value);
     void setShowBulletConstraints(bool value);
@@ -562,13 +572,19 @@ private:
     void idle();
     void tryToEnablePhysics();
     void update(float deltaTime);
+    void buildUpdateGraph();
 
     // Various helper functions called during update()
+    void updateResourcePrefetching();
+    void updateInputDevices(float deltaTime);
+    void updateSimulation(float deltaTime);
+    void updateViewsAndQueries();
     void updateLOD(float deltaTime) const;
     void updateThreads(float deltaTime);
     void updateDialogs(float deltaTime) const;
 
     void queryOctree(NodeType_t serverType, PacketType packetType);
+    void resetSceneBundle();
     void queryAvatars();
 
     int sendNackPackets();
@@ -696,6 +712,8 @@ private:
     bool _interstitialMode { false };
 
     OctreePacketProcessor _octreeProcessor;
+    ResourcePrefetcher _resourcePrefetcher;
+    SceneBundleLoader _sceneBundleLoader;
     EntityEditPacketSender _entityEditSender;
 
     StDev _idleLoopStdev;
@@ -743,6 +761,10 @@ private:
 
     GameWorkload _gameWorkload;
 
+    // the stages of update(), run once a frame with the frame's delta time
+    UpdateGraph _updateGraph;
+    float _updateDeltaTime { 0.0f };
+
     GraphicsEngine _graphicsEngine;
     void updateRenderArgs(float deltaTime);
 
@@ -28,6 +28,7 @@
 #include <RunningMarker.h>
 #include <SettingHandle.h>
 #include <SettingHelpers.h>
+#include <SettingManager.h>
 
 
 bool CrashRecoveryHandler::checkForResetSettings(bool wasLikelyCrash, bool suppressPrompt) {
@@ -169,5 +170,11 @@ void CrashRecoveryHandler::handleCrash(CrashRecoveryHandler::Action action) {
         // Tutorial complete
         settings.setValue(TUTORIAL_COMPLETE_FLAG_KEY, tutorialComplete);
     }
+
+    // The settings manager keeps its own copy of the settings, which has to be read again
+    settings.sync();
+    if (DependencyManager::isSet<Setting::Manager>()) {
+        DependencyManager::get<Setting::Manager>()->reload();
+    }
 }
 
@@ -12,6 +12,10 @@
 
 void FrameTimingsScriptingInterface::start() {
     _values.clear();
+    {
+        std::unique_lock<std::mutex> lock(_updateStageMutex);
+        _updateStageValues.clear();
+    }
     DependencyManager::get<TextureCache>()->setUnusedResourceCacheSize(0);
     _values.reserve(8192);
     _active = true;
@@ -23,8 +27,38 @@ void FrameTimingsScriptingInterface::addValue(uint64_t value) {
     }
 }
 
+void FrameTimingsScriptingInterface::addUpdateStageTimings(const std::vector<UpdateGraph::StageTiming>& timings) {
+    if (!_active) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_updateStageMutex);
+    for (const auto& timing : timings) {
+        auto& values = _updateStageValues[timing.name];
+        values.total += timing.lastUsecs;
+        values.min = std::min(values.min, timing.lastUsecs);
+        values.max = std::max(values.max, timing.lastUsecs);
+        ++values.count;
+        if (timing.isConcurrent) {
+            ++values.concurrentCount;
+        }
+    }
+}
+
 void FrameTimingsScriptingInterface::finish() {
     _active = false;
+    {
+        std::unique_lock<std::mutex> lock(_updateStageMutex);
+        _updateStageTimings.clear();
+        for (const auto& stage : _updateStageValues) {
+            const auto& values = stage.second;
+            QVariantMap timing;
+            timing["mean"] = values.count > 0 ? (float)values.total / (float)values.count : 0.0f;
+            timing["min"] = QVariant::fromValue(values.count > 0 ? values.min : 0);
+            timing["max"] = QVariant::fromValue(values.max);
+            timing["concurrent"] = values.count > 0 ? (float)values.concurrentCount / (float)values.count : 0.0f;
+            _updateStageTimings[stage.first] = timing;
+        }
+    }
     uint64_t total = 0;
     _min = std::numeric_limits<uint64_t>::max();
     _max = std::numeric_limits<uint64_t>::lowest();
@@ -51,3 +85,8 @@ QVariantList FrameTimingsScriptingInterface::getValues() const {
     }
     return result;
 }
+
+QVariantMap FrameTimingsScriptingInterface::getUpdateStageTimings() const {
+    std::unique_lock<std::mutex> lock(_updateStageMutex);
+    return _updateStageTimings;
+}
@@ -8,7 +8,14 @@
 
 #pragma once
 #include <stdint.h>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <vector>
 #include <QtCore/QObject>
+#include <QtCore/QVariantMap>
+
+#include "UpdateGraph.h"
 
 class FrameTimingsScriptingInterface : public QObject {
     Q_OBJECT
@@ -22,6 +29,15 @@ public:
     Q_INVOKABLE void finish();
     Q_INVOKABLE QVariantList getValues() const;
 
+    // the mean, min and max microseconds each update stage took between start() and finish(), and the share of frames
+    // it ran on another thread in, by stage name
+    Q_INVOKABLE QVariantMap getUpdateStageTimings() const;
+
+    bool isActive() const { return _active; }
+
+    // called from the main thread with each frame's update stage timings
+    void addUpdateStageTimings(const std::vector<UpdateGraph::StageTiming>& timings);
+
 
     uint64_t getMax() const { return _max; }
     uint64_t getMin() const { return _min; }
@@ -35,4 +51,15 @@ protected:
     uint64_t _min { 0 };
     float _stdDev { 0 };
     float _mean { 0 };
+
+    struct UpdateStageValues {
+        uint64_t total { 0 };
+        uint64_t min { std::numeric_limits<uint64_t>::max() };
+        uint64_t max { 0 };
+        uint32_t count { 0 };
+        uint32_t concurrentCount { 0 };
+    };
+    mutable std::mutex _updateStageMutex;
+    std::map<QString, UpdateStageValues> _updateStageValues;
+    QVariantMap _updateStageTimings;
 };
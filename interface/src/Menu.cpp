@@ -550,6 +550,8 @@ Menu::Menu() {
     connect(action, &QAction::triggered, [this]{ Avatar::setShowOtherLookAtVectors(isOptionChecked(MenuOption::ShowOtherLookAtVectors)); });
     action = addCheckableActionToQMenuAndActionHash(avatarDebugMenu, MenuOption::ShowOtherLookAtTarget, 0, false);
     connect(action, &QAction::triggered, [this]{ Avatar::setShowOtherLookAtTarget(isOptionChecked(MenuOption::ShowOtherLookAtTarget)); });
+    action = addCheckableActionToQMenuAndActionHash(avatarDebugMenu, MenuOption::FarAvatarLOD, 0, true);
+    connect(action, &QAction::triggered, [this]{ Avatar::setEnableFarRenderLOD(isOptionChecked(MenuOption::FarAvatarLOD)); });
 
     auto avatarManager = DependencyManager::get<AvatarManager>();
     auto avatar = avatarManager->getMyAvatar();
@@ -570,6 +572,10 @@ Menu::Menu() {
         avatar.get(), SLOT(setEnableDebugDrawPosition(bool)));
     addCheckableActionToQMenuAndActionHash(avatarDebugMenu, MenuOption::AnimDebugDrawOtherSkeletons, 0, false,
         avatarManager.data(), SLOT(setEnableDebugDrawOtherSkeletons(bool)));
+    action = addCheckableActionToQMenuAndActionHash(avatarDebugMenu, MenuOption::ParallelAvatarJointUpdates, 0, true);
+    connect(action, &QAction::triggered, [this, avatarManager]{
+            avatarManager->setParallelJointUpdates(isOptionChecked(MenuOption::ParallelAvatarJointUpdates));
+        });
     addCheckableActionToQMenuAndActionHash(avatarDebugMenu, MenuOption::MeshVisible, 0, true,
         avatar.get(), SLOT(setEnableMeshVisible(bool)));
     addCheckableActionToQMenuAndActionHash(avatarDebugMenu, MenuOption::DisableEyelidAdjustment, 0, false);
@@ -719,11 +725,18 @@ Menu::Menu() {
     addCheckableActionToQMenuAndActionHash(physicsOptionsMenu, MenuOption::PhysicsShowBulletContactPoints, 0, false, qApp, SLOT(setShowBulletContactPoints(bool)));
     addCheckableActionToQMenuAndActionHash(physicsOptionsMenu, MenuOption::PhysicsShowBulletConstraints, 0, false, qApp, SLOT(setShowBulletConstraints(bool)));
     addCheckableActionToQMenuAndActionHash(physicsOptionsMenu, MenuOption::PhysicsShowBulletConstraintLimits, 0, false, qApp, SLOT(setShowBulletConstraintLimits(bool)));
+    addCheckableActionToQMenuAndActionHash(physicsOptionsMenu, MenuOption::PhysicsBulkMotionStateSync, 0, true, qApp, SLOT(setBulkMotionStateSync(bool)));
 
     // Developer > Picking >>>
     MenuWrapper* pickingOptionsMenu = developerMenu->addMenu("Picking");
     addCheckableActionToQMenuAndActionHash(pickingOptionsMenu, MenuOption::ForceCoarsePicking, 0, false,
         DependencyManager::get<PickManager>().data(), SLOT(setForceCoarsePicking(bool)));
+    addCheckableActionToQMenuAndActionHash(pickingOptionsMenu, MenuOption::ParallelPicking, 0, false,
+        DependencyManager::get<PickManager>().data(), SLOT(setParallelPicking(bool)));
+    action = addCheckableActionToQMenuAndActionHash(pickingOptionsMenu, MenuOption::PickEntityBVH, 0, false);
+    connect(action, &QAction::triggered, [action] {
+        qApp->getEntities()->getTree()->setPickBVHEnabled(action->isChecked());
+    });
 
     // Developer > Crash >>>
     bool result = false;
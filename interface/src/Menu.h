@@ -117,6 +117,7 @@ namespace MenuOption {
     const QString ExpandSimulationTiming = "Expand /simulation";
     const QString ExpandPhysicsTiming = "Expand /physics";
     const QString ExpandUpdateTiming = "Expand /update";
+    const QString FarAvatarLOD = "Far Avatar Level of Detail";
     const QString FirstPerson = "First Person Legacy";
     const QString FirstPersonLookAt = "First Person";
     const QString FirstPersonHMD = "Enter First Person Mode in HMD";
@@ -151,6 +152,8 @@ namespace MenuOption {
     const QString Overlays = "Show Overlays";
     const QString PackageModel = "Package Avatar as .fst...";
     const QString Pair = "Pair";
+    const QString ParallelAvatarJointUpdates = "Parallel Other Avatar Joint Updates";
+    const QString PhysicsBulkMotionStateSync = "Bulk Motion State Sync";
     const QString PhysicsShowOwned = "Highlight Simulation Ownership";
     const QString VerboseLogging = "Verbose Logging";
     const QString PhysicsShowBulletWireframe = "Show Bullet Collision";
@@ -230,6 +233,8 @@ namespace MenuOption {
     const QString NotificationSoundsSnapshot = "play_notification_sounds_snapshot";
     const QString NotificationSoundsTablet = "play_notification_sounds_tablet";
     const QString ForceCoarsePicking = "Force Coarse Picking";
+    const QString PickEntityBVH = "Pick Entities With BVH";
+    const QString ParallelPicking = "Parallel Picking";
     const QString ComputeBlendshapes = "Compute Blendshapes";
     const QString HighlightTransitions = "Highlight Transitions";
     const QString MaterialProceduralShaders = "Enable Procedural Materials";
@@ -64,6 +64,59 @@ PerformanceManager::PerformancePreset PerformanceManager::getPerformancePreset()
     return preset;
 }
 
+void PerformanceManager::setNumPhysicsThreads(int numThreads) {
+    numThreads = std::max(1, std::min(numThreads, PhysicsEngine::getMaxNumPhysicsThreads()));
+    _performancePresetSettingLock.withWriteLock([&] {
+        _numPhysicsThreadsSetting.set(numThreads);
+    });
+
+    // the physics engine only changes threads between steps, on the main thread
+    QMetaObject::invokeMethod(qApp, [numThreads] {
+        qApp->getPhysicsEngine()->setNumPhysicsThreads(numThreads);
+    });
+}
+
+int PerformanceManager::getNumPhysicsThreads() const {
+    return _performancePresetSettingLock.resultWithReadLock<int>([&] {
+        return _numPhysicsThreadsSetting.get();
+    });
+}
+
+void PerformanceManager::setMaxActiveDynamicEntities(int maxEntities) {
+    maxEntities = std::max(0, maxEntities);
+    _performancePresetSettingLock.withWriteLock([&] {
+        _maxActiveDynamicEntitiesSetting.set(maxEntities);
+    });
+
+    // the entity simulation is only changed on the main thread
+    QMetaObject::invokeMethod(qApp, [maxEntities] {
+        qApp->getEntitySimulation()->setMaxActiveDynamicEntities((uint32_t)maxEntities);
+    });
+}
+
+int PerformanceManager::getMaxActiveDynamicEntities() const {
+    return _performancePresetSettingLock.resultWithReadLock<int>([&] {
+        return _maxActiveDynamicEntitiesSetting.get();
+    });
+}
+
+void PerformanceManager::setParallelUpdateEnabled(bool enabled) {
+    _performancePresetSettingLock.withWriteLock([&] {
+        _parallelUpdateSetting.set(enabled);
+    });
+
+    // the update graph is only changed between frames, on the main thread
+    QMetaObject::invokeMethod(qApp, [enabled] {
+        qApp->getUpdateGraph().setConcurrent(enabled);
+    });
+}
+
+bool PerformanceManager::isParallelUpdateEnabled() const {
+    return _performancePresetSettingLock.resultWithReadLock<bool>([&] {
+        return _parallelUpdateSetting.get();
+    });
+}
+
 void PerformanceManager::applyPerformancePreset(PerformanceManager::PerformancePreset preset) {
 
     // Ugly case that prevent us to run deferred everywhere...
@@ -91,10 +144,14 @@ void PerformanceManager::applyPerformancePreset(PerformanceManager::PerformanceP
             RenderScriptingInterface::getInstance()->setViewportResolutionScale(recommendedPpiScale);
             
             RenderScriptingInterface::getInstance()->setShadowsEnabled(true);
+            RenderScriptingInterface::getInstance()->setReducedEffectsEnabled(false);
             qApp->getRefreshRateManager().setRefreshRateProfile(RefreshRateManager::RefreshRateProfile::REALTIME);
 
             DependencyManager::get<LODManager>()->setWorldDetailQuality(WORLD_DETAIL_HIGH);
-            
+            setNumPhysicsThreads(4);
+            setMaxActiveDynamicEntities(512);
+            setParallelUpdateEnabled(true);
+
             break;
         case PerformancePreset::MID:
             RenderScriptingInterface::getInstance()->setRenderMethod((isDeferredCapable ?
@@ -104,28 +161,40 @@ void PerformanceManager::applyPerformancePreset(PerformanceManager::PerformanceP
             RenderScriptingInterface::getInstance()->setViewportResolutionScale(recommendedPpiScale);
 
             RenderScriptingInterface::getInstance()->setShadowsEnabled(false);
+            RenderScriptingInterface::getInstance()->setReducedEffectsEnabled(true);
             qApp->getRefreshRateManager().setRefreshRateProfile(RefreshRateManager::RefreshRateProfile::REALTIME);
             DependencyManager::get<LODManager>()->setWorldDetailQuality(WORLD_DETAIL_MEDIUM);
+            setNumPhysicsThreads(2);
+            setMaxActiveDynamicEntities(256);
+            setParallelUpdateEnabled(true);
 
             break;
         case PerformancePreset::LOW:
             RenderScriptingInterface::getInstance()->setRenderMethod(RenderScriptingInterface::RenderMethod::FORWARD);
             RenderScriptingInterface::getInstance()->setShadowsEnabled(false);
+            RenderScriptingInterface::getInstance()->setReducedEffectsEnabled(true);
             qApp->getRefreshRateManager().setRefreshRateProfile(RefreshRateManager::RefreshRateProfile::REALTIME);
 
             RenderScriptingInterface::getInstance()->setViewportResolutionScale(recommendedPpiScale);
 
             DependencyManager::get<LODManager>()->setWorldDetailQuality(WORLD_DETAIL_LOW);
+            setNumPhysicsThreads(1);
+            setMaxActiveDynamicEntities(128);
+            setParallelUpdateEnabled(true);
 
             break;
         case PerformancePreset::LOW_POWER:
             RenderScriptingInterface::getInstance()->setRenderMethod(RenderScriptingInterface::RenderMethod::FORWARD);
             RenderScriptingInterface::getInstance()->setShadowsEnabled(false);
+            RenderScriptingInterface::getInstance()->setReducedEffectsEnabled(true);
             qApp->getRefreshRateManager().setRefreshRateProfile(RefreshRateManager::RefreshRateProfile::ECO);
 
             RenderScriptingInterface::getInstance()->setViewportResolutionScale(recommendedPpiScale);
 
             DependencyManager::get<LODManager>()->setWorldDetailQuality(WORLD_DETAIL_LOW);
+            setNumPhysicsThreads(1);
+            setMaxActiveDynamicEntities(64);
+            setParallelUpdateEnabled(false);
 
             break;
         case PerformancePreset::UNKNOWN:
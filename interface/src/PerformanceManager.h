@@ -39,9 +39,27 @@ public:
     void setPerformancePreset(PerformancePreset performancePreset);
     PerformancePreset getPerformancePreset() const;
 
+    // The threads that solve the physics simulation, including the main thread. The presets set it, and it can be tuned
+    // on its own.
+    void setNumPhysicsThreads(int numThreads);
+    int getNumPhysicsThreads() const;
+
+    // The most dynamic entities kept awake and simulated at once, see PhysicalEntitySimulation::updatePhysicsLOD().
+    // Zero means no limit. The presets set it, and it can be tuned on its own.
+    void setMaxActiveDynamicEntities(int maxEntities);
+    int getMaxActiveDynamicEntities() const;
+
+    // Whether Application::update() runs the stages that can run on the thread pool there, alongside the main thread
+    // stages that don't depend on them. The presets set it, and it can be tuned on its own.
+    void setParallelUpdateEnabled(bool enabled);
+    bool isParallelUpdateEnabled() const;
+
 private:
     mutable ReadWriteLockable _performancePresetSettingLock;
     Setting::Handle<int> _performancePresetSetting { "performancePreset", PerformanceManager::PerformancePreset::UNKNOWN };
+    Setting::Handle<int> _numPhysicsThreadsSetting { "numPhysicsThreads", 1 };
+    Setting::Handle<int> _maxActiveDynamicEntitiesSetting { "maxActiveDynamicEntities", 256 };
+    Setting::Handle<bool> _parallelUpdateSetting { "parallelUpdate", true };
 
     // The concrete performance preset changes
     void applyPerformancePreset(PerformanceManager::PerformancePreset performancePreset);
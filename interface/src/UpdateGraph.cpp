@@ -0,0 +1,202 @@
+//
+//  UpdateGraph.cpp
+//  interface/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "UpdateGraph.h"
+
+#include <cassert>
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+#include <QtCore/QVariantMap>
+
+#include <NumericalConstants.h>
+#include <PerfStat.h>
+#include <Profile.h>
+#include <SharedUtil.h>
+
+class UpdateGraph::StageTask : public QRunnable {
+public:
+    StageTask(UpdateGraph& graph, StageID id) : _graph(graph), _id(id) {}
+
+    void run() override {
+        {
+            std::unique_lock<std::mutex> lock(_graph._mutex);
+            _graph._stages[_id].queuedTask = nullptr;
+        }
+        _graph.runStage(_id, true);
+        _graph.finishStage(_id);
+    }
+
+private:
+    UpdateGraph& _graph;
+    StageID _id;
+};
+
+UpdateGraph::StageID UpdateGraph::addStage(const QString& name, Affinity affinity, const std::vector<StageID>& dependencies,
+                                           const StageFunction& function) {
+    StageID id = (StageID)_stages.size();
+    _stages.emplace_back();
+    auto& stage = _stages.back();
+    stage.name = name;
+    stage.affinity = affinity;
+    stage.function = function;
+    for (auto dependency : dependencies) {
+        assert(dependency >= 0 && dependency < id);
+        _stages[dependency].dependents.push_back(id);
+        ++stage.numDependencies;
+    }
+    return id;
+}
+
+void UpdateGraph::run() {
+    auto timerContext = PerformanceTimer::getContextName();
+
+    if (!_isConcurrent) {
+        for (StageID id = 0; id < (StageID)_stages.size(); ++id) {
+            runStage(id, false);
+        }
+        publishTimings(timerContext);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _numUnfinishedStages = (int)_stages.size();
+        for (auto& stage : _stages) {
+            stage.numUnfinishedDependencies = stage.numDependencies;
+        }
+        for (StageID id = 0; id < (StageID)_stages.size(); ++id) {
+            if (_stages[id].affinity == Affinity::AnyThread && _stages[id].numDependencies == 0) {
+                startOnThreadPool(id);
+            }
+        }
+    }
+
+    for (StageID id = 0; id < (StageID)_stages.size(); ++id) {
+        auto& stage = _stages[id];
+        if (stage.affinity != Affinity::MainThread) {
+            continue;
+        }
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (stage.numUnfinishedDependencies > 0) {
+                if (!runQueuedStage(lock)) {
+                    _stageFinished.wait(lock);
+                }
+            }
+        }
+        runStage(id, false);
+        finishStage(id);
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        while (_numUnfinishedStages > 0) {
+            if (!runQueuedStage(lock)) {
+                _stageFinished.wait(lock);
+            }
+        }
+    }
+    publishTimings(timerContext);
+}
+
+void UpdateGraph::startOnThreadPool(StageID id) {
+    // called with _mutex held
+    auto task = new StageTask(*this, id);
+    _stages[id].queuedTask = task;
+    QThreadPool::globalInstance()->start(task);
+}
+
+bool UpdateGraph::runQueuedStage(std::unique_lock<std::mutex>& lock) {
+    for (StageID id = 0; id < (StageID)_stages.size(); ++id) {
+        auto task = _stages[id].queuedTask;
+        // tryTake() hands back the task only if no pool thread has picked it up yet
+        if (task && QThreadPool::globalInstance()->tryTake(task)) {
+            _stages[id].queuedTask = nullptr;
+            lock.unlock();
+            delete task;
+            runStage(id, false);
+            finishStage(id);
+            lock.lock();
+            return true;
+        }
+    }
+    return false;
+}
+
+void UpdateGraph::runStage(StageID id, bool onThreadPool) {
+    auto& stage = _stages[id];
+    PROFILE_RANGE(app, stage.name);
+    auto start = usecTimestampNow();
+    if (onThreadPool) {
+        stage.function();
+    } else {
+        // on the main thread the stage's timer nests the timers inside it, as they did when update() was all one
+        PerformanceTimer perfTimer(stage.name);
+        stage.function();
+    }
+    stage.lastUsecs = usecTimestampNow() - start;
+    stage.ranConcurrently = onThreadPool;
+}
+
+void UpdateGraph::finishStage(StageID id) {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        for (auto dependent : _stages[id].dependents) {
+            auto& stage = _stages[dependent];
+            if (--stage.numUnfinishedDependencies == 0 && stage.affinity == Affinity::AnyThread) {
+                startOnThreadPool(dependent);
+            }
+        }
+        --_numUnfinishedStages;
+    }
+    _stageFinished.notify_all();
+}
+
+void UpdateGraph::publishTimings(const QString& timerContext) {
+    std::vector<StageTiming> timings;
+    timings.reserve(_stages.size());
+    for (auto& stage : _stages) {
+        stage.averageUsecs.updateAverage((float)stage.lastUsecs);
+        if (stage.ranConcurrently && PerformanceTimer::isActive()) {
+            // filed next to the main thread stages, where the timing details show them
+            PerformanceTimer::addTimerRecord(timerContext + "/" + stage.name, stage.lastUsecs);
+        }
+
+        StageTiming timing;
+        timing.name = stage.name;
+        timing.isConcurrent = stage.ranConcurrently;
+        timing.lastUsecs = stage.lastUsecs;
+        timing.averageUsecs = stage.averageUsecs.getAverage();
+        timings.push_back(timing);
+    }
+
+    std::unique_lock<std::mutex> lock(_timingsMutex);
+    _timings.swap(timings);
+}
+
+std::vector<UpdateGraph::StageTiming> UpdateGraph::getStageTimings() const {
+    std::unique_lock<std::mutex> lock(_timingsMutex);
+    return _timings;
+}
+
+QVariantList UpdateGraph::getStageTimingsAsVariant() const {
+    QVariantList result;
+    for (const auto& timing : getStageTimings()) {
+        QVariantMap stage;
+        stage["name"] = timing.name;
+        stage["concurrent"] = timing.isConcurrent;
+        stage["lastMsecs"] = (float)timing.lastUsecs / USECS_PER_MSEC;
+        stage["averageMsecs"] = timing.averageUsecs / USECS_PER_MSEC;
+        result.push_back(stage);
+    }
+    return result;
+}
@@ -0,0 +1,102 @@
+//
+//  UpdateGraph.h
+//  interface/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_UpdateGraph_h
+#define hifi_UpdateGraph_h
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QString>
+#include <QtCore/QVariantList>
+
+#include <SimpleMovingAverage.h>
+
+class QRunnable;
+
+// The stages of Application::update() and what each has to wait for. The stages that live on the main thread run on the
+// thread that runs the graph, in the order they were added; the stages that can run on any thread start on the global
+// thread pool as soon as the stages they depend on are done, alongside whatever main thread stages don't depend on them.
+// A stage that has to wait for a thread pool stage still queued behind other work takes it back and runs it itself, so the
+// main thread never waits on the pool being busy. Stages can only depend on stages added before them.
+//
+// Run without concurrency every stage runs on the calling thread, in order, as update() did before it was split up.
+class UpdateGraph {
+public:
+    enum class Affinity {
+        MainThread,
+        AnyThread
+    };
+
+    using StageID = int;
+    using StageFunction = std::function<void()>;
+
+    struct StageTiming {
+        QString name;
+        bool isConcurrent { false }; // ran on the thread pool the last time
+        quint64 lastUsecs { 0 };
+        float averageUsecs { 0.0f };
+    };
+
+    UpdateGraph() = default;
+    UpdateGraph(const UpdateGraph&) = delete;
+    UpdateGraph& operator=(const UpdateGraph&) = delete;
+
+    StageID addStage(const QString& name, Affinity affinity, const std::vector<StageID>& dependencies,
+                     const StageFunction& function);
+
+    // call from the thread that runs the graph
+    void setConcurrent(bool isConcurrent) { _isConcurrent = isConcurrent; }
+    bool isConcurrent() const { return _isConcurrent; }
+
+    void run();
+
+    // the timings of the last run and the moving averages, from any thread
+    std::vector<StageTiming> getStageTimings() const;
+    QVariantList getStageTimingsAsVariant() const;
+
+private:
+    class StageTask;
+
+    struct Stage {
+        QString name;
+        Affinity affinity;
+        StageFunction function;
+        std::vector<StageID> dependents;
+        int numDependencies { 0 };
+
+        int numUnfinishedDependencies { 0 };
+        StageTask* queuedTask { nullptr }; // started on the thread pool but not yet running
+        bool ranConcurrently { false };
+        quint64 lastUsecs { 0 };
+        SimpleMovingAverage averageUsecs;
+    };
+
+    void startOnThreadPool(StageID id);
+    void runStage(StageID id, bool onThreadPool);
+    void finishStage(StageID id);
+    bool runQueuedStage(std::unique_lock<std::mutex>& lock);
+    void publishTimings(const QString& timerContext);
+
+    std::vector<Stage> _stages;
+    bool _isConcurrent { true };
+
+    std::mutex _mutex;
+    std::condition_variable _stageFinished;
+    int _numUnfinishedStages { 0 };
+
+    mutable std::mutex _timingsMutex;
+    std::vector<StageTiming> _timings;
+};
+
+#endif // hifi_UpdateGraph_h
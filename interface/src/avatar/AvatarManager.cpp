@@ -11,6 +11,7 @@
 
 #include "AvatarManager.h"
 
+#include <atomic>
 #include <string>
 
 #include <QScriptEngine>
@@ -30,6 +31,8 @@
 
 #include <shared/QtHelpers.h>
 #include <AvatarData.h>
+#include <MemoryAccounting.h>
+#include <ParallelFor.h>
 #include <PerfStat.h>
 #include <PrioritySortUtil.h>
 #include <RegisteredMetaTypes.h>
@@ -56,6 +59,7 @@
 const QUuid MY_AVATAR_KEY;  // NULL key
 
 AvatarManager::AvatarManager(QObject* parent) :
+    AvatarHashMap(true),
     _myAvatar(new MyAvatar(qApp->thread()), [](MyAvatar* ptr) { ptr->deleteLater(); })
 {
     // register a meta type for the weak pointer we'll use for the owning avatar mixer for each avatar
@@ -123,6 +127,7 @@ void AvatarManager::init() {
     }
 
     setEnableDebugDrawOtherSkeletons(Menu::getInstance()->isOptionChecked(MenuOption::AnimDebugDrawOtherSkeletons));
+    setParallelJointUpdates(Menu::getInstance()->isOptionChecked(MenuOption::ParallelAvatarJointUpdates));
 }
 
 void AvatarManager::setSpace(workload::SpacePointer& space ) {
@@ -217,6 +222,7 @@ float AvatarManager::getAvatarSimulationRate(const QUuid& sessionID, const QStri
 }
 
 void AvatarManager::updateOtherAvatars(float deltaTime) {
+    MemoryAccounting::Scope memoryScope(MemoryTag::Avatars);
     {
         // lock the hash for read to check the size
         QReadLocker lock(&_hashLock);
@@ -227,7 +233,7 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
 
     PerformanceTimer perfTimer("otherAvatars");
 
-    class SortableAvatar: public PrioritySortUtil::Sortable {
+    class SortableAvatar final : public PrioritySortUtil::Sortable {
     public:
         SortableAvatar() = delete;
         SortableAvatar(const std::shared_ptr<Avatar>& avatar) : _avatar(avatar) {}
@@ -272,6 +278,8 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         // DO NOT update _myAvatar!  Its update has already been done earlier in the main loop.
         // DO NOT update or fade out uninitialized Avatars
         if (avatar != _myAvatar && avatar->isInitialized() && !nodeList->isPersonalMutingNode(avatar->getID())) {
+            // the level of detail is known before the joint updates that depend on it
+            avatar->updateRenderLOD(views);
             if (avatar->getHasPriority()) {
                 avatarPriorityQueues[kHero].push(SortableAvatar(avatar));
             } else {
@@ -296,6 +304,21 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     render::Transaction renderTransaction;
     workload::Transaction workloadTransaction;
 
+    std::vector<OtherAvatarPointer> jointUpdateAvatars;
+    if (_parallelJointUpdates) {
+        // the avatars whose joints simulate() would update, in the order they're simulated
+        for (int p = kHero; p < NumVariants; p++) {
+            for (const auto& sortData : avatarPriorityQueues[p].getSortedVector()) {
+                const auto avatar = std::static_pointer_cast<OtherAvatar>(sortData.getAvatar());
+                if (sortData.getPriority() > OUT_OF_VIEW_THRESHOLD && avatar->hasNewJointData() &&
+                    avatar->getSkeletonModel()->isLoaded() && avatar->isJointUpdateDue(startTime)) {
+                    jointUpdateAvatars.push_back(avatar);
+                }
+            }
+        }
+        updateJointPosesInParallel(jointUpdateAvatars, startTime + MAX_UPDATE_AVATARS_TIME_BUDGET);
+    }
+
     for (int p = kHero; p < NumVariants; p++) {
         auto& priorityQueue = avatarPriorityQueues[p];
         // Sorting the current queue HERE as part of the measured timing.
@@ -386,6 +409,11 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
         }
     }
 
+    for (const auto& avatar : jointUpdateAvatars) {
+        // the avatars that ran out of budget before they were simulated compute their poses again next time
+        avatar->_jointPosesUpdated = false;
+    }
+
     if (_shouldRender) {
         qApp->getMain3DScene()->enqueueTransaction(renderTransaction);
     }
@@ -399,6 +427,22 @@ void AvatarManager::updateOtherAvatars(float deltaTime) {
     _avatarSimulationTime = (float)(usecTimestampNow() - startTime) / (float)USECS_PER_MSEC;
 }
 
+void AvatarManager::updateJointPosesInParallel(const std::vector<OtherAvatarPointer>& avatars, uint64_t expiry) {
+    PROFILE_RANGE(simulation, "updateJointPoses");
+    // Avatars' skeletons differ a lot in size, so the tasks take the next avatar as they go rather than splitting them
+    // up front. Once the budget is spent the rest are left for simulate(), which won't get to them either.
+    std::atomic<size_t> nextAvatar { 0 };
+    auto updateAvatars = [&avatars, &nextAvatar, expiry] {
+        size_t i;
+        while ((i = nextAvatar++) < avatars.size() && usecTimestampNow() < expiry) {
+            avatars[i]->updateJointPoses();
+        }
+    };
+
+    const size_t MIN_AVATARS_PER_TASK = 4;
+    parallelFor(avatars.size(), MIN_AVATARS_PER_TASK, [&updateAvatars](size_t, size_t, size_t) { updateAvatars(); });
+}
+
 void AvatarManager::postUpdate(float deltaTime, const render::ScenePointer& scene) {
     auto hashCopy = getHashCopy();
     AvatarHash::iterator avatarIterator = hashCopy.begin();
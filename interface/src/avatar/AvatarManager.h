@@ -121,6 +121,11 @@ public:
     void updateMyAvatar(float deltaTime);
     void updateOtherAvatars(float deltaTime);
 
+    // When enabled, the joint poses of the other avatars that are in view are computed on the global thread pool before
+    // they're simulated, within the same time budget.
+    void setParallelJointUpdates(bool enabled) { _parallelJointUpdates = enabled; }
+    bool isParallelJointUpdates() const { return _parallelJointUpdates; }
+
     void setMyAvatarDataPacketsPaused(bool puase);
 
     void postUpdate(float deltaTime, const render::ScenePointer& scene);
@@ -289,6 +294,7 @@ private:
     void handleRemovedAvatar(const AvatarSharedPointer& removedAvatar,
                              KillAvatarReason removalReason = KillAvatarReason::NoReason) override;
     void handleTransitAnimations(AvatarTransit::Status status);
+    void updateJointPosesInParallel(const std::vector<OtherAvatarPointer>& avatars, uint64_t expiry);
 
     using SetOfOtherAvatars = std::set<OtherAvatarPointer>;
     SetOfOtherAvatars _otherAvatarsToChangeInPhysics;
@@ -312,6 +318,7 @@ private:
 
     AvatarTransit::TransitConfig  _transitConfig;
     bool _drawOtherAvatarSkeletons { false };
+    bool _parallelJointUpdates { true };
 };
 
 #endif // hifi_AvatarManager_h
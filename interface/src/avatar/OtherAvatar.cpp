@@ -21,6 +21,9 @@
 const float DISPLAYNAME_FADE_TIME = 0.5f;
 const float DISPLAYNAME_FADE_FACTOR = pow(0.01f, 1.0f / DISPLAYNAME_FADE_TIME);
 
+const uint64_t OtherAvatar::FAR_JOINT_UPDATE_INTERVAL = USECS_PER_SECOND / 10;
+const uint64_t OtherAvatar::FAR_RENDER_LOD_JOINT_UPDATE_INTERVAL = USECS_PER_SECOND / 4;
+
 static glm::u8vec3 getLoadingOrbColor(Avatar::LoadingStatus loadingStatus) {
 
     const glm::u8vec3 NO_MODEL_COLOR(0xe3, 0xe3, 0xe3);
@@ -251,6 +254,26 @@ void OtherAvatar::setCollisionWithOtherAvatarsFlags() {
     }
 }
 
+bool OtherAvatar::isJointUpdateDue(uint64_t now) const {
+    if (_transit.isActive()) {
+        return true;
+    }
+    if (_renderLOD == RenderLOD::Far) {
+        return now - _lastJointUpdate >= FAR_RENDER_LOD_JOINT_UPDATE_INTERVAL;
+    }
+    return _workloadRegion < workload::Region::R3 || now - _lastJointUpdate >= FAR_JOINT_UPDATE_INTERVAL;
+}
+
+void OtherAvatar::updateJointPoses() {
+    {
+        QReadLocker readLock(&_jointDataLock);
+        _skeletonModel->getRig().copyJointsFromJointData(_jointData);
+    }
+    glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
+    _skeletonModel->getRig().computeExternalPoses(rootTransform);
+    _jointPosesUpdated = true;
+}
+
 void OtherAvatar::simulate(float deltaTime, bool inView) {
     PROFILE_RANGE(simulation, "simulate");
 
@@ -265,14 +288,19 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     }
 
     PerformanceTimer perfTimer("simulate");
+    bool jointsUpdated = false;
     {
         PROFILE_RANGE(simulation, "updateJoints");
         if (inView) {
             Head* head = getHead();
-            if (_hasNewJointData || _transit.isActive()) {
-                _skeletonModel->getRig().copyJointsFromJointData(_jointData);
-                glm::mat4 rootTransform = glm::scale(_skeletonModel->getScale()) * glm::translate(_skeletonModel->getOffset());
-                _skeletonModel->getRig().computeExternalPoses(rootTransform);
+            uint64_t now = usecTimestampNow();
+            if ((_hasNewJointData || _transit.isActive()) && isJointUpdateDue(now)) {
+                if (!_jointPosesUpdated) {
+                    updateJointPoses();
+                }
+                _jointPosesUpdated = false;
+                _lastJointUpdate = now;
+                jointsUpdated = true;
                 _jointDataSimulationRate.increment();
 
                 head->simulate(deltaTime);
@@ -319,13 +347,19 @@ void OtherAvatar::simulate(float deltaTime, bool inView) {
     {
         PROFILE_RANGE(simulation, "misc");
         measureMotionDerivatives(deltaTime);
-        simulateAttachments(deltaTime);
+        // the attachments aren't drawn at the far level of detail
+        if (_renderLOD == RenderLOD::Near) {
+            simulateAttachments(deltaTime);
+        }
         updatePalms();
     }
     {
         PROFILE_RANGE(simulation, "entities");
         handleChangedAvatarEntityData();
-        updateAttachedAvatarEntities();
+        // at the far level of detail, the avatar entities follow the joints when they're updated
+        if (_renderLOD == RenderLOD::Near || jointsUpdated) {
+            updateAttachedAvatarEntities();
+        }
     }
 
     {
@@ -65,6 +65,17 @@ public:
 
     void simulate(float deltaTime, bool inView) override;
     void debugJointData() const;
+
+    // Far avatars only update their joints every FAR_JOINT_UPDATE_INTERVAL, or FAR_RENDER_LOD_JOINT_UPDATE_INTERVAL at the far
+    // level of detail, and show their last pose until then.
+    bool isJointUpdateDue(uint64_t now) const;
+    // Copies the last joint data received into the rig and computes the joints' poses, ahead of simulate(). It only touches
+    // this avatar's rig, so it can run on any thread while nothing else uses the rig, and several avatars can be
+    // updated at once.
+    void updateJointPoses();
+    static const uint64_t FAR_JOINT_UPDATE_INTERVAL;
+    static const uint64_t FAR_RENDER_LOD_JOINT_UPDATE_INTERVAL;
+
     friend AvatarManager;
 
 protected:
@@ -91,6 +102,8 @@ protected:
     uint8_t _workloadRegion { workload::Region::INVALID };
     BodyLOD _bodyLOD { BodyLOD::Sphere };
     bool _needsDetailedRebuild { false };
+    bool _jointPosesUpdated { false };
+    uint64_t _lastJointUpdate { 0 };
 };
 
 using OtherAvatarPointer = std::shared_ptr<OtherAvatar>;
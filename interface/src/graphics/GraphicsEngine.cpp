@@ -15,6 +15,7 @@
 #include "LODManager.h"
 
 #include <GeometryCache.h>
+#include <MemoryAccounting.h>
 #include <TextureCache.h>
 #include <FramebufferCache.h>
 #include <UpdateSceneTask.h>
@@ -122,6 +123,7 @@ void GraphicsEngine::render_runRenderFrame(RenderArgs* renderArgs) {
     }
 
     {
+        MemoryAccounting::Scope memoryScope(MemoryTag::Render);
         _renderEngine->getRenderContext()->args = renderArgs;
         _renderEngine->run();
     }
@@ -170,6 +172,9 @@ void GraphicsEngine::render_performFrame() {
     // Some plugins process message events, allowing paintGL to be called reentrantly.
 
     _renderFrameCount++;
+    if (_renderFrameCount == 1) {
+        PROFILE_INSTANT(startup, "first frame", "g");
+    }
 
     auto lastPaintBegin = usecTimestampNow();
     PROFILE_RANGE_EX(render, __FUNCTION__, 0xff0000ff, (uint64_t)_renderFrameCount);
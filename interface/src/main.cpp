@@ -19,6 +19,7 @@
 #include <QTranslator>
 
 #include <BuildInfo.h>
+#include <MemoryAccounting.h>
 #include <SandboxUtils.h>
 #include <SharedUtil.h>
 #include <NetworkAccessManager.h>
@@ -40,6 +41,9 @@ extern "C" {
 }
 #endif
 
+// accounts heap allocations to the subsystems making them, for the stats overlay
+MEMORY_ACCOUNTING_HOOKS()
+
 int main(int argc, const char* argv[]) {
 #ifdef Q_OS_MAC
     auto format = getDefaultOpenGLSurfaceFormat();
@@ -13,6 +13,7 @@
 #define hifi_OctreePacketProcessor_h
 
 #include <QtCore/QSharedPointer>
+#include <QtCore/QUrl>
 
 #include <ReceivedPacketProcessor.h>
 #include <ReceivedMessage.h>
@@ -38,6 +39,7 @@ public:
 
 signals:
     void packetVersionMismatch();
+    void sceneBundleOffered(quint64 version, QUrl url, SharedNodePointer entityServer);
 
 protected:
     virtual void processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) override;
@@ -0,0 +1,157 @@
+//
+//  ResourcePrefetcher.cpp
+//  interface/src/octree
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ResourcePrefetcher.h"
+
+#include <vector>
+
+#include <ImageEntityItem.h>
+#include <ModelEntityItem.h>
+#include <PickFilter.h>
+#include <SharedUtil.h>
+#include <TextureCache.h>
+#include <model-networking/ModelCache.h>
+
+namespace {
+    const quint64 UPDATE_INTERVAL = 250 * USECS_PER_MSEC;
+
+    // the avatar path is predicted a second apart over the next few seconds
+    const int NUM_LOOKAHEAD_STEPS = 3;
+    const float LOOKAHEAD_STEP = 1.0f;
+    const float MIN_PREDICTION_SPEED = 0.5f;
+
+    // a prediction not renewed for as long as the lookahead is wrong
+    const quint64 PREDICTION_LIFETIME = (quint64)(NUM_LOOKAHEAD_STEPS * LOOKAHEAD_STEP * USECS_PER_SECOND);
+
+    const int MAX_PREDICTIONS = 64;
+}
+
+void ResourcePrefetcher::update(const EntityTreePointer& entityTree, const glm::vec3& position, const glm::vec3& velocity,
+                                const glm::vec3& destination, float radius) {
+    quint64 now = usecTimestampNow();
+    if (!_enabled || !entityTree || now - _lastUpdate < UPDATE_INTERVAL) {
+        return;
+    }
+    _lastUpdate = now;
+
+    // where the avatar will be, and how soon
+    std::vector<std::pair<glm::vec3, float>> predictedPositions;
+    if (glm::distance(destination, position) > radius) {
+        predictedPositions.emplace_back(destination, 0.0f);
+    }
+    if (glm::length(velocity) > MIN_PREDICTION_SPEED) {
+        for (int i = 1; i <= NUM_LOOKAHEAD_STEPS; i++) {
+            float time = i * LOOKAHEAD_STEP;
+            predictedPositions.emplace_back(position + velocity * time, time);
+        }
+    }
+
+    std::vector<std::pair<EntityItemPointer, float>> entities;
+    unsigned int searchFilter = PickFilter::getBitMask(PickFilter::FlagBit::DOMAIN_ENTITIES) |
+        PickFilter::getBitMask(PickFilter::FlagBit::AVATAR_ENTITIES);
+    entityTree->withReadLock([&] {
+        for (const auto& predictedPosition : predictedPositions) {
+            QVector<QUuid> entityIDs;
+            entityTree->evalEntitiesInSphere(predictedPosition.first, radius, PickFilter(searchFilter), entityIDs);
+            for (const auto& entityID : entityIDs) {
+                auto entity = entityTree->findEntityByID(entityID);
+                if (entity) {
+                    entities.emplace_back(entity, predictedPosition.second);
+                }
+            }
+        }
+    });
+
+    for (const auto& entityAndTime : entities) {
+        const auto& entity = entityAndTime.first;
+        // the renderers of the entities already around the avatar have requested their resources
+        if (glm::distance(entity->getWorldPosition(), position) < radius) {
+            continue;
+        }
+
+        float arrivalTime = entityAndTime.second;
+        switch (entity->getType()) {
+            case EntityTypes::Model: {
+                QUrl url(std::static_pointer_cast<ModelEntityItem>(entity)->getModelURL());
+                predict(_modelPredictions, url, arrivalTime, now, [](const QUrl& url) {
+                    return DependencyManager::get<ModelCache>()->getSpeculativeGeometryResource(url);
+                });
+                break;
+            }
+            case EntityTypes::Image: {
+                QUrl url(std::static_pointer_cast<ImageEntityItem>(entity)->getImageURL());
+                predict(_texturePredictions, url, arrivalTime, now, [](const QUrl& url) {
+                    return DependencyManager::get<TextureCache>()->getSpeculativeTexture(url);
+                });
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    expire(_modelPredictions, now);
+    expire(_texturePredictions, now);
+}
+
+template <typename Fetch>
+void ResourcePrefetcher::predict(Predictions& predictions, const QUrl& url, float arrivalTime, quint64 now, Fetch fetch) {
+    if (url.isEmpty() || !url.isValid()) {
+        return;
+    }
+
+    auto itr = predictions.find(url);
+    if (itr == predictions.end()) {
+        if (getNumPredictions() >= MAX_PREDICTIONS) {
+            return;
+        }
+        QSharedPointer<Resource> resource = fetch(url);
+        if (!resource) {
+            return;
+        }
+        itr = predictions.insert(url, { resource, 0 });
+    }
+
+    // the sooner the avatar gets there, the sooner it loads among the speculative requests
+    itr->resource->setLoadPriority(this, -arrivalTime);
+    itr->expiry = now + PREDICTION_LIFETIME;
+}
+
+void ResourcePrefetcher::expire(Predictions& predictions, quint64 now) {
+    for (auto itr = predictions.begin(); itr != predictions.end();) {
+        const auto& resource = itr->resource;
+        if (!resource->isSpeculative()) {
+            // requested since, so its requester holds it now
+            itr = predictions.erase(itr);
+        } else if (itr->expiry < now) {
+            ResourceCache::cancelSpeculativeResource(resource);
+            itr = predictions.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+}
+
+void ResourcePrefetcher::clear() {
+    for (auto predictions : { &_modelPredictions, &_texturePredictions }) {
+        for (const auto& prediction : *predictions) {
+            ResourceCache::cancelSpeculativeResource(prediction.resource);
+        }
+        predictions->clear();
+    }
+}
+
+void ResourcePrefetcher::setEnabled(bool enabled) {
+    _enabled = enabled;
+    if (!_enabled) {
+        clear();
+    }
+}
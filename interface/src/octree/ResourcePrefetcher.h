@@ -0,0 +1,59 @@
+//
+//  ResourcePrefetcher.h
+//  interface/src/octree
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+// Loads the resources of the entities the avatar is heading towards, ahead of their renderers requesting them.
+
+#ifndef hifi_ResourcePrefetcher_h
+#define hifi_ResourcePrefetcher_h
+
+#include <QtCore/QHash>
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QUrl>
+
+#include <glm/glm.hpp>
+
+#include <EntityTree.h>
+#include <ResourceCache.h>
+
+class ResourcePrefetcher : public QObject {
+public:
+    // The entities within radius of where the avatar will be over the next seconds, moving at velocity, or of its
+    // destination, have their resources loaded as speculative requests (see ResourceCache::getSpeculativeResource).
+    // Those no longer predicted for a while are cancelled.
+    void update(const EntityTreePointer& entityTree, const glm::vec3& position, const glm::vec3& velocity,
+                const glm::vec3& destination, float radius);
+
+    // Cancels all the predictions
+    void clear();
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+
+private:
+    struct Prediction {
+        QSharedPointer<Resource> resource;
+        quint64 expiry { 0 };
+    };
+    using Predictions = QHash<QUrl, Prediction>;
+
+    template <typename Fetch>
+    void predict(Predictions& predictions, const QUrl& url, float arrivalTime, quint64 now, Fetch fetch);
+    void expire(Predictions& predictions, quint64 now);
+    int getNumPredictions() const { return _modelPredictions.size() + _texturePredictions.size(); }
+
+    bool _enabled { true };
+    quint64 _lastUpdate { 0 };
+    Predictions _modelPredictions;
+    Predictions _texturePredictions;
+};
+
+#endif  // hifi_ResourcePrefetcher_h
@@ -0,0 +1,90 @@
+//
+//  SceneBundleLoader.cpp
+//  interface/src/octree
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SceneBundleLoader.h"
+
+#include <QtCore/QThreadPool>
+
+#include <EntityNodeData.h>
+#include <EntitySceneBundle.h>
+#include <ResourceManager.h>
+#include <ResourceRequest.h>
+#include <SharedUtil.h>
+
+#include "InterfaceLogging.h"
+
+void SceneBundleLoader::load(quint64 version, const QUrl& url, const SharedNodePointer& entityServer,
+                             const EntityTreePointer& tree, const glm::vec3& position) {
+    int generation = ++_generation;
+
+    auto request = DependencyManager::get<ResourceManager>()->createResourceRequest(this, url);
+    if (!request) {
+        qCWarning(interfaceapp) << "Could not create a request for the scene bundle" << url;
+        emit finished(EntityJSONQueryProperties::SCENE_BUNDLE_UNAVAILABLE);
+        return;
+    }
+
+    connect(request, &ResourceRequest::finished, this, [=]() {
+        request->deleteLater();
+        if (generation != _generation) {
+            return;
+        }
+        if (request->getResult() != ResourceRequest::Success) {
+            qCWarning(interfaceapp) << "Scene bundle" << url << "failed to download, the entity server will send the scene";
+            emit finished(EntityJSONQueryProperties::SCENE_BUNDLE_UNAVAILABLE);
+            return;
+        }
+
+        // reading the chunks takes the tree's write lock a chunk at a time, keep it off the main thread
+        QByteArray data = request->getData();
+        QThreadPool::globalInstance()->start([=] {
+            read(generation, version, data, entityServer, tree, position);
+        });
+    });
+    request->send();
+}
+
+void SceneBundleLoader::read(int generation, quint64 version, const QByteArray& data, const SharedNodePointer& entityServer,
+                             const EntityTreePointer& tree, const glm::vec3& position) {
+    quint64 start = usecTimestampNow();
+    EntitySceneBundle bundle;
+    if (!bundle.fromByteArray(data) || bundle.version != version) {
+        qCWarning(interfaceapp) << "Scene bundle is not version" << version << "or can't be read by this build";
+        if (generation == _generation) {
+            emit finished(EntityJSONQueryProperties::SCENE_BUNDLE_UNAVAILABLE);
+        }
+        return;
+    }
+
+    for (size_t index : bundle.getChunkOrder(position)) {
+        if (generation != _generation) {
+            return;
+        }
+        bool isRead = false;
+        tree->withWriteLock([&] {
+            isRead = bundle.readChunk(bundle.chunks[index], *tree, entityServer);
+        });
+        if (!isRead) {
+            // told there's no bundle, the server sends every entity, including those read already
+            qCWarning(interfaceapp) << "Scene bundle" << version << "has a malformed chunk";
+            if (generation == _generation) {
+                emit finished(EntityJSONQueryProperties::SCENE_BUNDLE_UNAVAILABLE);
+            }
+            return;
+        }
+    }
+
+    qCDebug(interfaceapp) << "Read" << bundle.getNumEntities() << "entities from scene bundle" << version << "in"
+                          << (usecTimestampNow() - start) / USECS_PER_MSEC << "msecs";
+    if (generation == _generation) {
+        emit finished((qint64)version);
+    }
+}
@@ -0,0 +1,49 @@
+//
+//  SceneBundleLoader.h
+//  interface/src/octree
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+// Downloads the scene bundle the entity server offers and reads it into the entity tree, nearest chunks first.
+
+#ifndef hifi_SceneBundleLoader_h
+#define hifi_SceneBundleLoader_h
+
+#include <atomic>
+
+#include <QtCore/QObject>
+#include <QtCore/QUrl>
+
+#include <glm/glm.hpp>
+
+#include <EntityTree.h>
+#include <Node.h>
+
+class SceneBundleLoader : public QObject {
+    Q_OBJECT
+public:
+    // Replaces any load in progress. The chunks are read as if they had been sent by the entity server, those nearest
+    // the position first.
+    void load(quint64 version, const QUrl& url, const SharedNodePointer& entityServer, const EntityTreePointer& tree,
+              const glm::vec3& position);
+
+    // Stops the load in progress, if any, without it finishing
+    void cancel() { ++_generation; }
+
+signals:
+    // the version of the bundle read, or EntityJSONQueryProperties::SCENE_BUNDLE_UNAVAILABLE if it couldn't be
+    void finished(qint64 version);
+
+private:
+    void read(int generation, quint64 version, const QByteArray& data, const SharedNodePointer& entityServer,
+              const EntityTreePointer& tree, const glm::vec3& position);
+
+    std::atomic<int> _generation { 0 };
+};
+
+#endif  // hifi_SceneBundleLoader_h
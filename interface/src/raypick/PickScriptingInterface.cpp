@@ -8,6 +8,7 @@
 
 #include "PickScriptingInterface.h"
 
+#include <QThread>
 #include <QVariant>
 #include "GLMHelpers.h"
 
@@ -29,6 +30,7 @@
 #include "EntityTransformNode.h"
 
 #include <ScriptEngine.h>
+#include <shared/QtHelpers.h>
 
 static const float WEB_TOUCH_Y_OFFSET = 0.105f;  // how far forward (or back with a negative number) to slide stylus in hand
 static const glm::vec3 TIP_OFFSET = glm::vec3(0.0f, StylusPick::WEB_STYLUS_LENGTH - WEB_TOUCH_Y_OFFSET, 0.0f);
@@ -421,6 +423,75 @@ QVariantMap PickScriptingInterface::getPrevPickResult(unsigned int uid) {
     return result;
 }
 
+/*@jsdoc
+ * How long a pick has been taking to update its results. Ray and parabola picks evaluated in parallel include the time spent 
+ * on a worker thread.
+ *
+ * @typedef {object} Picks.PickUpdateStats
+ * @property {number} lastUpdateUsecs - The time taken by the most recent update, in microseconds.
+ * @property {number} averageUpdateUsecs - The moving average of the time taken by recent updates, in microseconds.
+ * @property {number} numUpdates - The number of times the pick has been updated while enabled.
+ */
+QVariantMap PickScriptingInterface::getPickUpdateStats(unsigned int uid) const {
+    return DependencyManager::get<PickManager>()->getPickUpdateStats(uid);
+}
+
+QVariantList PickScriptingInterface::testCollisionRegions(const QVariantList& collisionRegions, unsigned int filter) {
+    if (QThread::currentThread() != thread()) {
+        // one trip to the main thread, where the physics engine lives, for the whole batch
+        QVariantList results;
+        BLOCKING_INVOKE_METHOD(this, "testCollisionRegions", Q_RETURN_ARG(QVariantList, results),
+                               Q_ARG(const QVariantList&, collisionRegions), Q_ARG(unsigned int, filter));
+        return results;
+    }
+
+    PickFilter pickFilter = getPickFilter(filter);
+    bool testEntities = pickFilter.doesPickDomainEntities() || pickFilter.doesPickAvatarEntities() || pickFilter.doesPickLocalEntities();
+    bool testAvatars = pickFilter.doesPickAvatars();
+
+    // each region is tested against entities and avatars separately, like a collision pick
+    std::vector<CollisionRegion> regions;
+    std::vector<ContactTestRegion> contactTestRegions;
+    std::vector<int> entityTests;
+    std::vector<int> avatarTests;
+    regions.reserve(collisionRegions.size());
+    for (const auto& collisionRegion : collisionRegions) {
+        CollisionRegion region(collisionRegion.toMap());
+        region.loaded = !region.shouldComputeShapeInfo();
+        entityTests.push_back(-1);
+        avatarTests.push_back(-1);
+        if (region.loaded && region) {
+            if (testEntities) {
+                entityTests.back() = (int)contactTestRegions.size();
+                contactTestRegions.emplace_back(*region.shapeInfo, region.transform, USER_COLLISION_MASK_ENTITIES,
+                                                region.collisionGroup, region.threshold);
+            }
+            if (testAvatars) {
+                avatarTests.back() = (int)contactTestRegions.size();
+                contactTestRegions.emplace_back(*region.shapeInfo, region.transform, USER_COLLISION_MASK_AVATARS,
+                                                region.collisionGroup, region.threshold);
+            }
+        }
+        regions.push_back(region);
+    }
+
+    ContactTestResults contactTestResults = qApp->getPhysicsEngine()->contactTest(contactTestRegions);
+
+    QVariantList results;
+    for (size_t i = 0; i < regions.size(); ++i) {
+        std::vector<ContactTestResult> entityIntersections;
+        if (entityTests[i] >= 0) {
+            entityIntersections = contactTestResults.getContacts(entityTests[i]);
+        }
+        std::vector<ContactTestResult> avatarIntersections;
+        if (avatarTests[i] >= 0) {
+            avatarIntersections = contactTestResults.getContacts(avatarTests[i]);
+        }
+        results.append(CollisionPickResult(regions[i], entityIntersections, avatarIntersections).toVariantMap());
+    }
+    return results;
+}
+
 void PickScriptingInterface::setPrecisionPicking(unsigned int uid, bool precisionPicking) {
     DependencyManager::get<PickManager>()->setPrecisionPicking(uid, precisionPicking);
 }
@@ -472,6 +543,10 @@ void PickScriptingInterface::setPerFrameTimeBudget(unsigned int numUsecs) {
     DependencyManager::get<PickManager>()->setPerFrameTimeBudget(numUsecs);
 }
 
+bool PickScriptingInterface::getParallelPicking() const {
+    return DependencyManager::get<PickManager>()->getParallelPicking();
+}
+
 void PickScriptingInterface::setParentTransform(std::shared_ptr<PickQuery> pick, const QVariantMap& propMap) {
     QUuid parentUuid;
     int parentJointIndex = 0;
@@ -67,6 +67,9 @@
  * @property {IntersectionType} INTERSECTED_HUD - Intersected the HUD surface. <em>Read-only.</em>
  *
  * @property {number} perFrameTimeBudget - The maximum time, in microseconds, to spend per frame updating pick results.
+ * @property {boolean} parallelPicking - <code>true</code> if the entity intersections of ray and parabola picks are evaluated 
+ *     on worker threads, with their results published a frame later, <code>false</code> if all picks are evaluated on the 
+ *     main thread. Set using the Developer &gt; Picking &gt; Parallel Picking menu item. <em>Read-only.</em>
  */
 
 class PickScriptingInterface : public QObject, public Dependency {
@@ -100,6 +103,7 @@ class PickScriptingInterface : public QObject, public Dependency {
     Q_PROPERTY(unsigned int INTERSECTED_AVATAR READ INTERSECTED_AVATAR CONSTANT)
     Q_PROPERTY(unsigned int INTERSECTED_HUD READ INTERSECTED_HUD CONSTANT)
     Q_PROPERTY(unsigned int perFrameTimeBudget READ getPerFrameTimeBudget WRITE setPerFrameTimeBudget)
+    Q_PROPERTY(bool parallelPicking READ getParallelPicking)
     SINGLETON_DEPENDENCY
 
 public:
@@ -228,6 +232,56 @@ public:
      */
     Q_INVOKABLE QVariantMap getPrevPickResult(unsigned int uid);
 
+    /*@jsdoc
+     * Gets how long a pick has been taking to update its results. Use this to find the picks that take up the most of 
+     * <code>Picks.perFrameTimeBudget</code>.
+     * @function Picks.getPickUpdateStats
+     * @param {number} id - The ID of the pick.
+     * @returns {Picks.PickUpdateStats} The update times of the pick. Empty if the pick doesn't exist.
+     * @example <caption>Report the cost of a mouse ray pick.</caption>
+     * var rayPick = Picks.createPick(PickType.Ray, {
+     *     enabled: true,
+     *     filter: Picks.PICK_DOMAIN_ENTITIES | Picks.PICK_AVATAR_ENTITIES,
+     *     joint: "Mouse"
+     * });
+     * Script.setTimeout(function () {
+     *     var stats = Picks.getPickUpdateStats(rayPick);
+     *     print("Ray pick: " + stats.averageUpdateUsecs + " usecs on average over " + stats.numUpdates + " updates");
+     *     Picks.removePick(rayPick);
+     * }, 5000);
+     */
+    Q_INVOKABLE QVariantMap getPickUpdateStats(unsigned int uid) const;
+
+    /*@jsdoc
+     * Checks many collision regions for collisions with entities and avatars in the physics simulation, right away. This is 
+     * much cheaper than a collision pick, or a call, per region, when a script needs to check many regions at once.
+     * <p>Regions whose shape is from a model aren't checked, and have <code>loaded</code> set to <code>false</code> in their 
+     * results. Use a collision pick for those.</p>
+     * @function Picks.testCollisionRegions
+     * @param {CollisionRegion[]} collisionRegions - The regions to check. Their positions, orientations and dimensions are in 
+     *     world coordinates.
+     * @param {FilterFlags} [filter=Picks.PICK_ENTITIES|Picks.PICK_AVATARS] - What to check the regions against: entities, 
+     *     avatars, or both. Collision regions don't intersect the HUD.
+     * @returns {CollisionPickResult[]} The intersections of each region, in the same order as <code>collisionRegions</code>.
+     * @example <caption>Check which of the spaces around you are free to rez into.</caption>
+     * var regions = [];
+     * for (var i = 0; i < 8; i++) {
+     *     var angle = i * Math.PI / 4;
+     *     regions.push({
+     *         shape: { shapeType: "box", dimensions: { x: 0.5, y: 0.5, z: 0.5 } },
+     *         position: Vec3.sum(MyAvatar.position, { x: 2 * Math.cos(angle), y: 0, z: 2 * Math.sin(angle) }),
+     *         orientation: Quat.IDENTITY,
+     *         threshold: 0.0
+     *     });
+     * }
+     * var results = Picks.testCollisionRegions(regions, Picks.PICK_DOMAIN_ENTITIES | Picks.PICK_AVATAR_ENTITIES);
+     * for (var j = 0; j < results.length; j++) {
+     *     print("Region " + j + (results[j].intersects ? " is occupied" : " is free"));
+     * }
+     */
+    Q_INVOKABLE QVariantList testCollisionRegions(const QVariantList& collisionRegions,
+                                                  unsigned int filter = PICK_ENTITIES() | PICK_AVATARS());
+
     /*@jsdoc
      * Sets whether or not a pick should use precision picking, i.e., whether it should pick against precise meshes or coarse 
      * meshes.
@@ -289,6 +343,8 @@ public:
     unsigned int getPerFrameTimeBudget() const;
     void setPerFrameTimeBudget(unsigned int numUsecs);
 
+    bool getParallelPicking() const;
+
     static constexpr unsigned int PICK_BYPASS_IGNORE() { return PickFilter::getBitMask(PickFilter::FlagBit::PICK_BYPASS_IGNORE); }
 
 public slots:
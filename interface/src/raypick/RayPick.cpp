@@ -25,16 +25,16 @@ PickRay RayPick::getMathematicalPick() const {
     return PickRay(origin, direction);
 }
 
-PickResultPointer RayPick::getEntityIntersection(const PickRay& pick) {
+PickFilter RayPick::getEntitySearchFilter() const {
     PickFilter searchFilter = getFilter();
     if (DependencyManager::get<PickManager>()->getForceCoarsePicking()) {
         searchFilter.setFlag(PickFilter::COARSE, true);
         searchFilter.setFlag(PickFilter::PRECISE, false);
     }
+    return searchFilter;
+}
 
-    RayToEntityIntersectionResult entityRes =
-        DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionVector(pick, searchFilter,
-            getIncludeItemsAs<EntityItemID>(), getIgnoreItemsAs<EntityItemID>());
+PickResultPointer RayPick::makeEntityResult(const RayToEntityIntersectionResult& entityRes, const PickRay& pick) const {
     if (entityRes.intersects) {
         IntersectionType type = IntersectionType::ENTITY;
         if (getFilter().doesPickLocalEntities()) {
@@ -50,6 +50,25 @@ PickResultPointer RayPick::getEntityIntersection(const PickRay& pick) {
     }
 }
 
+PickResultPointer RayPick::getEntityIntersection(const PickRay& pick) {
+    RayToEntityIntersectionResult entityRes =
+        DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionVector(pick, getEntitySearchFilter(),
+            getIncludeItemsAs<EntityItemID>(), getIgnoreItemsAs<EntityItemID>());
+    return makeEntityResult(entityRes, pick);
+}
+
+std::vector<PickResultPointer> RayPick::getEntityIntersections(const std::vector<PickRay>& picks) {
+    std::vector<RayToEntityIntersectionResult> entityResults =
+        DependencyManager::get<EntityScriptingInterface>()->evalRayIntersectionVectors(picks, getEntitySearchFilter(),
+            getIncludeItemsAs<EntityItemID>(), getIgnoreItemsAs<EntityItemID>());
+    std::vector<PickResultPointer> results;
+    results.reserve(entityResults.size());
+    for (size_t i = 0; i < entityResults.size(); i++) {
+        results.push_back(makeEntityResult(entityResults[i], picks[i]));
+    }
+    return results;
+}
+
 PickResultPointer RayPick::getAvatarIntersection(const PickRay& pick) {
     bool precisionPicking = !(getFilter().isCoarse() || DependencyManager::get<PickManager>()->getForceCoarsePicking());
     RayToAvatarIntersectionResult avatarRes = DependencyManager::get<AvatarManager>()->findRayIntersectionVector(pick, getIncludeItemsAs<EntityItemID>(), getIgnoreItemsAs<EntityItemID>(), precisionPicking);
@@ -58,3 +58,38 @@ RefreshRateManager::UXMode PerformanceScriptingInterface::getUXMode() const {
 RefreshRateManager::RefreshRateRegime PerformanceScriptingInterface::getRefreshRateRegime() const {
     return qApp->getRefreshRateManager().getRefreshRateRegime();
 }
+
+void PerformanceScriptingInterface::setNumPhysicsThreads(int numPhysicsThreads) {
+    qApp->getPerformanceManager().setNumPhysicsThreads(numPhysicsThreads);
+    emit settingsChanged();
+}
+
+int PerformanceScriptingInterface::getNumPhysicsThreads() const {
+    return qApp->getPerformanceManager().getNumPhysicsThreads();
+}
+
+int PerformanceScriptingInterface::getMaxNumPhysicsThreads() const {
+    return PhysicsEngine::getMaxNumPhysicsThreads();
+}
+
+void PerformanceScriptingInterface::setMaxActiveDynamicEntities(int maxActiveDynamicEntities) {
+    qApp->getPerformanceManager().setMaxActiveDynamicEntities(maxActiveDynamicEntities);
+    emit settingsChanged();
+}
+
+int PerformanceScriptingInterface::getMaxActiveDynamicEntities() const {
+    return qApp->getPerformanceManager().getMaxActiveDynamicEntities();
+}
+
+void PerformanceScriptingInterface::setParallelUpdateEnabled(bool enabled) {
+    qApp->getPerformanceManager().setParallelUpdateEnabled(enabled);
+    emit settingsChanged();
+}
+
+bool PerformanceScriptingInterface::isParallelUpdateEnabled() const {
+    return qApp->getPerformanceManager().isParallelUpdateEnabled();
+}
+
+QVariantList PerformanceScriptingInterface::getUpdateStageTimings() const {
+    return qApp->getUpdateGraph().getStageTimingsAsVariant();
+}
@@ -29,11 +29,23 @@
  *
  * @property {Performance.PerformancePreset} performancePreset - The current graphics performance preset.
  * @property {Performance.RefreshRateProfile} refreshRateProfile - The current refresh rate profile.
+ * @property {number} numPhysicsThreads - The number of threads that solve the physics simulation, from <code>1</code> 
+ *     to {@link Performance.getMaxNumPhysicsThreads|getMaxNumPhysicsThreads}. The performance presets set it.
+ * @property {number} maxActiveDynamicEntities - The most dynamic entities that are simulated at once. When more are moving 
+ *     within physics range, those that are farther away and simulated by someone else are moved by their last known 
+ *     velocities instead, until there is room for them or they come close. <code>0</code> means no limit. The performance 
+ *     presets set it.
+ * @property {boolean} parallelUpdate - <code>true</code> if the stages of each frame's update that can run on other threads 
+ *     do so, alongside the stages that don't depend on them, <code>false</code> if every stage runs on the main thread in 
+ *     turn. The performance presets set it.
  */
 class PerformanceScriptingInterface : public QObject {
     Q_OBJECT
     Q_PROPERTY(PerformancePreset performancePreset READ getPerformancePreset WRITE setPerformancePreset NOTIFY settingsChanged)
     Q_PROPERTY(RefreshRateProfile refreshRateProfile READ getRefreshRateProfile WRITE setRefreshRateProfile NOTIFY settingsChanged)
+    Q_PROPERTY(int numPhysicsThreads READ getNumPhysicsThreads WRITE setNumPhysicsThreads NOTIFY settingsChanged)
+    Q_PROPERTY(int maxActiveDynamicEntities READ getMaxActiveDynamicEntities WRITE setMaxActiveDynamicEntities NOTIFY settingsChanged)
+    Q_PROPERTY(bool parallelUpdate READ isParallelUpdateEnabled WRITE setParallelUpdateEnabled NOTIFY settingsChanged)
 
 public:
 
@@ -162,10 +174,80 @@ public slots:
      */
     RefreshRateManager::RefreshRateRegime getRefreshRateRegime() const;
 
+
+    /*@jsdoc
+     * Sets the number of threads that solve the physics simulation. More than one thread is only used if Interface's 
+     * physics library was built with multithreading.
+     * @function Performance.setNumPhysicsThreads
+     * @param {number} numPhysicsThreads - The number of threads, including the main thread.
+     */
+    void setNumPhysicsThreads(int numPhysicsThreads);
+
+    /*@jsdoc
+     * Gets the number of threads that solve the physics simulation.
+     * @function Performance.getNumPhysicsThreads
+     * @returns {number} The number of threads, including the main thread.
+     */
+    int getNumPhysicsThreads() const;
+
+    /*@jsdoc
+     * Gets the most threads that can solve the physics simulation on this computer.
+     * @function Performance.getMaxNumPhysicsThreads
+     * @returns {number} The most threads that can solve the physics simulation.
+     */
+    int getMaxNumPhysicsThreads() const;
+
+    /*@jsdoc
+     * Sets the most dynamic entities that are simulated at once.
+     * @function Performance.setMaxActiveDynamicEntities
+     * @param {number} maxActiveDynamicEntities - The most dynamic entities simulated at once. <code>0</code> means no limit.
+     */
+    void setMaxActiveDynamicEntities(int maxActiveDynamicEntities);
+
+    /*@jsdoc
+     * Gets the most dynamic entities that are simulated at once.
+     * @function Performance.getMaxActiveDynamicEntities
+     * @returns {number} The most dynamic entities simulated at once. <code>0</code> means no limit.
+     */
+    int getMaxActiveDynamicEntities() const;
+
+    /*@jsdoc
+     * Sets whether the stages of each frame's update that can run on other threads do so.
+     * @function Performance.setParallelUpdateEnabled
+     * @param {boolean} enabled - <code>true</code> to run them on other threads, <code>false</code> to run every stage on 
+     *     the main thread.
+     */
+    void setParallelUpdateEnabled(bool enabled);
+
+    /*@jsdoc
+     * Gets whether the stages of each frame's update that can run on other threads do so.
+     * @function Performance.isParallelUpdateEnabled
+     * @returns {boolean} <code>true</code> if they run on other threads, <code>false</code> if every stage runs on the main 
+     *     thread.
+     */
+    bool isParallelUpdateEnabled() const;
+
+    /*@jsdoc
+     * Details of a stage of the frame update.
+     * @typedef {object} Performance.UpdateStageTiming
+     * @property {string} name - The stage's name, as shown in the timing details.
+     * @property {boolean} concurrent - <code>true</code> if the stage ran on another thread the last frame, alongside the 
+     *     main thread.
+     * @property {number} lastMsecs - How long the stage took the last frame, in milliseconds.
+     * @property {number} averageMsecs - How long the stage took in the last 100 frames, on average, in milliseconds.
+     */
+    /*@jsdoc
+     * Gets how long each stage of the frame update takes, in the order the stages are started.
+     * @function Performance.getUpdateStageTimings
+     * @returns {Performance.UpdateStageTiming[]} The stages' timings.
+     */
+    QVariantList getUpdateStageTimings() const;
+
 signals:
 
     /*@jsdoc
-     * Triggered when the performance preset or refresh rate profile is changed.
+     * Triggered when the performance preset, refresh rate profile, number of physics threads, most active dynamic 
+     * entities, or parallel update is changed.
      * @function Performance.settingsChanged
      * @returns {Signal}
      */
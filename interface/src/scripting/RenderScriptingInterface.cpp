@@ -7,6 +7,8 @@
 //
 #include "RenderScriptingInterface.h"
 
+#include "AmbientOcclusionEffect.h"
+#include "BloomEffect.h"
 #include "LightingModel.h"
 
 
@@ -28,15 +30,20 @@ void RenderScriptingInterface::loadSettings() {
         _renderMethod = (_renderMethodSetting.get());
         _shadowsEnabled = (_shadowsEnabledSetting.get());
         _ambientOcclusionEnabled = (_ambientOcclusionEnabledSetting.get());
+        _reducedEffectsEnabled = (_reducedEffectsEnabledSetting.get());
         //_antialiasingMode = (_antialiasingModeSetting.get());
         _antialiasingMode = static_cast<AntialiasingConfig::Mode>(_antialiasingModeSetting.get());
         _viewportResolutionScale = (_viewportResolutionScaleSetting.get());
+        _dynamicResolutionEnabled = (_dynamicResolutionEnabledSetting.get());
+        _dynamicResolutionMinimumScale = (_dynamicResolutionMinimumScaleSetting.get());
     });
     forceRenderMethod((RenderMethod)_renderMethod);
     forceShadowsEnabled(_shadowsEnabled);
     forceAmbientOcclusionEnabled(_ambientOcclusionEnabled);
+    forceReducedEffectsEnabled(_reducedEffectsEnabled);
     forceAntialiasingMode(_antialiasingMode);
     forceViewportResolutionScale(_viewportResolutionScale);
+    forceDynamicResolutionEnabled(_dynamicResolutionEnabled);
 }
 
 RenderScriptingInterface::RenderMethod RenderScriptingInterface::getRenderMethod() const {
@@ -121,6 +128,44 @@ void RenderScriptingInterface::forceAmbientOcclusionEnabled(bool enabled) {
     });
 }
 
+bool RenderScriptingInterface::getReducedEffectsEnabled() const {
+    return _reducedEffectsEnabled;
+}
+
+void RenderScriptingInterface::setReducedEffectsEnabled(bool enabled) {
+    if (_reducedEffectsEnabled != enabled) {
+        forceReducedEffectsEnabled(enabled);
+        emit settingsChanged();
+    }
+}
+
+void RenderScriptingInterface::forceReducedEffectsEnabled(bool enabled) {
+    // The reduced ambient occlusion runs at the same resolution, which is already a quarter of the frame's, with half the
+    // samples and a narrower depth-aware blur. The reduced bloom is blurred at an eighth of the frame's resolution.
+    static const int FULL_AO_BLUR_RADIUS = 4;
+    static const int REDUCED_AO_BLUR_RADIUS = 2;
+    static const int FULL_AO_NUM_SAMPLES = 32;
+    static const int REDUCED_AO_NUM_SAMPLES = 16;
+    static const int FULL_BLOOM_RESOLUTION_LEVEL = 2;
+    static const int REDUCED_BLOOM_RESOLUTION_LEVEL = 3;
+
+    _renderSettingLock.withWriteLock([&] {
+        _reducedEffectsEnabled = (enabled);
+        _reducedEffectsEnabledSetting.set(enabled);
+
+        auto renderConfig = qApp->getRenderEngine()->getConfiguration();
+        auto ambientOcclusionConfig = renderConfig->getConfig<AmbientOcclusionEffect>("RenderMainView.AmbientOcclusion");
+        if (ambientOcclusionConfig) {
+            ambientOcclusionConfig->setBlurRadius(enabled ? REDUCED_AO_BLUR_RADIUS : FULL_AO_BLUR_RADIUS);
+            ambientOcclusionConfig->setSSAONumSamples(enabled ? REDUCED_AO_NUM_SAMPLES : FULL_AO_NUM_SAMPLES);
+        }
+        auto bloomThresholdConfig = renderConfig->getConfig<BloomThreshold>("RenderMainView.BloomThreshold");
+        if (bloomThresholdConfig) {
+            bloomThresholdConfig->setResolutionLevel(enabled ? REDUCED_BLOOM_RESOLUTION_LEVEL : FULL_BLOOM_RESOLUTION_LEVEL);
+        }
+    });
+}
+
 AntialiasingConfig::Mode RenderScriptingInterface::getAntialiasingMode() const {
     return _antialiasingMode;
 }
@@ -188,18 +233,105 @@ void RenderScriptingInterface::forceViewportResolutionScale(float scale) {
     _renderSettingLock.withWriteLock([&] {
         _viewportResolutionScale = (scale);
         _viewportResolutionScaleSetting.set(scale);
+        applyResolutionScale();
+    });
+}
 
-        auto renderConfig = qApp->getRenderEngine()->getConfiguration();
-        assert(renderConfig);
-        auto deferredView = renderConfig->getConfig("RenderMainView.RenderDeferredTask");
-        // mainView can be null if we're rendering in forward mode
-        if (deferredView) {
-            deferredView->setProperty("resolutionScale", _viewportResolutionScale);
+void RenderScriptingInterface::applyResolutionScale() {
+    float scale = _viewportResolutionScale * _dynamicResolutionFactor;
+
+    auto renderConfig = qApp->getRenderEngine()->getConfiguration();
+    assert(renderConfig);
+    auto deferredView = renderConfig->getConfig("RenderMainView.RenderDeferredTask");
+    // mainView can be null if we're rendering in forward mode
+    if (deferredView) {
+        deferredView->setProperty("resolutionScale", scale);
+    }
+    auto forwardView = renderConfig->getConfig("RenderMainView.RenderForwardTask");
+    // mainView can be null if we're rendering in forward mode
+    if (forwardView) {
+        forwardView->setProperty("resolutionScale", scale);
+    }
+}
+
+bool RenderScriptingInterface::getDynamicResolutionEnabled() const {
+    return _dynamicResolutionEnabled;
+}
+
+void RenderScriptingInterface::setDynamicResolutionEnabled(bool enabled) {
+    if (_dynamicResolutionEnabled != enabled) {
+        forceDynamicResolutionEnabled(enabled);
+        emit settingsChanged();
+    }
+}
+
+void RenderScriptingInterface::forceDynamicResolutionEnabled(bool enabled) {
+    _renderSettingLock.withWriteLock([&] {
+        _dynamicResolutionEnabled = (enabled);
+        _dynamicResolutionEnabledSetting.set(enabled);
+    });
+}
+
+float RenderScriptingInterface::getDynamicResolutionMinimumScale() const {
+    return _dynamicResolutionMinimumScale;
+}
+
+void RenderScriptingInterface::setDynamicResolutionMinimumScale(float scale) {
+    // just not negative values or zero
+    if (scale <= 0.f || _dynamicResolutionMinimumScale == scale) {
+        return;
+    }
+    _renderSettingLock.withWriteLock([&] {
+        _dynamicResolutionMinimumScale = (scale);
+        _dynamicResolutionMinimumScaleSetting.set(scale);
+    });
+    emit settingsChanged();
+}
+
+float RenderScriptingInterface::getDynamicResolutionScale() const {
+    return _renderSettingLock.resultWithReadLock<float>([&] {
+        return _viewportResolutionScale * _dynamicResolutionFactor;
+    });
+}
+
+// the share of the display's frame time the GPU is given, leaving room for the compositor and the frames that run long
+static const float DYNAMIC_RESOLUTION_GPU_BUDGET = 0.9f;
+// the share of that budget the GPU has to be under before the scale goes back up, so that going up doesn't go over it
+static const float DYNAMIC_RESOLUTION_RAISE_THRESHOLD = 0.75f;
+// the scale changes in steps, each one rebuilding the primary framebuffer and restarting the TAA history
+static const float DYNAMIC_RESOLUTION_STEP = 0.05f;
+// frames to wait after a step for the GPU's moving average frame time to be made of frames rendered at the new scale
+static const int DYNAMIC_RESOLUTION_SETTLE_FRAMES = 15;
+
+void RenderScriptingInterface::updateDynamicResolution(float gpuFrameTime, float targetFrameTime) {
+    float factor = 1.0f;
+    if (_dynamicResolutionEnabled && gpuFrameTime > 0.0f && targetFrameTime > 0.0f) {
+        if (_dynamicResolutionSettleFrames > 0) {
+            --_dynamicResolutionSettleFrames;
+            return;
         }
-        auto forwardView = renderConfig->getConfig("RenderMainView.RenderForwardTask");
-        // mainView can be null if we're rendering in forward mode
-        if (forwardView) {
-            forwardView->setProperty("resolutionScale", _viewportResolutionScale);
+
+        factor = _dynamicResolutionFactor;
+        float budget = targetFrameTime * DYNAMIC_RESOLUTION_GPU_BUDGET;
+        if (gpuFrameTime > budget) {
+            // the GPU's time goes with the number of pixels, the square of the scale, so jump straight to the one that fits
+            float fittingFactor = factor * sqrtf(budget / gpuFrameTime);
+            factor = floorf(fittingFactor / DYNAMIC_RESOLUTION_STEP) * DYNAMIC_RESOLUTION_STEP;
+        } else if (gpuFrameTime < budget * DYNAMIC_RESOLUTION_RAISE_THRESHOLD) {
+            // but only come back up a step at a time
+            factor += DYNAMIC_RESOLUTION_STEP;
         }
-    });
+
+        float minimumFactor = std::min(_dynamicResolutionMinimumScale / _viewportResolutionScale, 1.0f);
+        factor = glm::clamp(factor, minimumFactor, 1.0f);
+    }
+
+    if (factor != _dynamicResolutionFactor) {
+        _renderSettingLock.withWriteLock([&] {
+            _dynamicResolutionFactor = factor;
+            applyResolutionScale();
+        });
+        _dynamicResolutionSettleFrames = DYNAMIC_RESOLUTION_SETTLE_FRAMES;
+        emit dynamicResolutionScaleChanged();
+    }
 }
@@ -29,16 +29,30 @@
  * @property {boolean} shadowsEnabled - <code>true</code> if shadows are enabled, <code>false</code> if they're disabled.
  * @property {boolean} ambientOcclusionEnabled - <code>true</code> if ambient occlusion is enabled, <code>false</code> if it's 
  *     disabled.
+ * @property {boolean} reducedEffectsEnabled - <code>true</code> if ambient occlusion and bloom are rendered with fewer
+ *     samples and at a lower resolution, to cost less on slower GPUs, <code>false</code> if they're rendered at full quality.
  * @property {integer} antialiasingMode - The active anti-aliasing mode.
  * @property {number} viewportResolutionScale - The view port resolution scale, <code>&gt; 0.0</code>.
+ * @property {boolean} dynamicResolutionEnabled - <code>true</code> if the resolution scale is lowered below
+ *     <code>viewportResolutionScale</code> while the GPU can't keep up with the display's frame rate, <code>false</code> if
+ *     it isn't.
+ * @property {number} dynamicResolutionMinimumScale - The lowest resolution scale dynamic resolution goes down to,
+ *     <code>&gt; 0.0</code>.
+ * @property {number} dynamicResolutionScale - The resolution scale being rendered at, which is
+ *     <code>viewportResolutionScale</code> unless dynamic resolution has lowered it.
+ *     <em>Read-only.</em>
  */
 class RenderScriptingInterface : public QObject {
     Q_OBJECT
     Q_PROPERTY(RenderMethod renderMethod READ getRenderMethod WRITE setRenderMethod NOTIFY settingsChanged)
     Q_PROPERTY(bool shadowsEnabled READ getShadowsEnabled WRITE setShadowsEnabled NOTIFY settingsChanged)
     Q_PROPERTY(bool ambientOcclusionEnabled READ getAmbientOcclusionEnabled WRITE setAmbientOcclusionEnabled NOTIFY settingsChanged)
+    Q_PROPERTY(bool reducedEffectsEnabled READ getReducedEffectsEnabled WRITE setReducedEffectsEnabled NOTIFY settingsChanged)
     Q_PROPERTY(AntialiasingConfig::Mode antialiasingMode READ getAntialiasingMode WRITE setAntialiasingMode NOTIFY settingsChanged)
     Q_PROPERTY(float viewportResolutionScale READ getViewportResolutionScale WRITE setViewportResolutionScale NOTIFY settingsChanged)
+    Q_PROPERTY(bool dynamicResolutionEnabled READ getDynamicResolutionEnabled WRITE setDynamicResolutionEnabled NOTIFY settingsChanged)
+    Q_PROPERTY(float dynamicResolutionMinimumScale READ getDynamicResolutionMinimumScale WRITE setDynamicResolutionMinimumScale NOTIFY settingsChanged)
+    Q_PROPERTY(float dynamicResolutionScale READ getDynamicResolutionScale NOTIFY dynamicResolutionScaleChanged)
 
 public:
     RenderScriptingInterface();
@@ -144,6 +158,20 @@ public slots:
      */
     void setAmbientOcclusionEnabled(bool enabled);
 
+    /*@jsdoc
+     * Gets whether ambient occlusion and bloom are rendered at a reduced quality that costs less.
+     * @function Render.getReducedEffectsEnabled
+     * @returns {boolean} <code>true</code> if the reduced effects are enabled, <code>false</code> if they're disabled.
+     */
+    bool getReducedEffectsEnabled() const;
+
+    /*@jsdoc
+     * Sets whether ambient occlusion and bloom are rendered at a reduced quality that costs less.
+     * @function Render.setReducedEffectsEnabled
+     * @param {boolean} enabled - <code>true</code> to enable the reduced effects, <code>false</code> to disable them.
+     */
+    void setReducedEffectsEnabled(bool enabled);
+
     /*@jsdoc
      * Gets the active anti-aliasing mode.
      * @function Render.getAntialiasingMode
@@ -172,6 +200,46 @@ public slots:
      */
     void setViewportResolutionScale(float resolutionScale);
 
+    /*@jsdoc
+     * Gets whether the resolution scale is lowered while the GPU can't keep up with the display's frame rate.
+     * @function Render.getDynamicResolutionEnabled
+     * @returns {boolean} <code>true</code> if dynamic resolution is enabled, <code>false</code> if it isn't.
+     */
+    bool getDynamicResolutionEnabled() const;
+
+    /*@jsdoc
+     * Sets whether the resolution scale is lowered while the GPU can't keep up with the display's frame rate.
+     * @function Render.setDynamicResolutionEnabled
+     * @param {boolean} enabled - <code>true</code> to enable dynamic resolution, <code>false</code> to disable it.
+     */
+    void setDynamicResolutionEnabled(bool enabled);
+
+    /*@jsdoc
+     * Gets the lowest resolution scale dynamic resolution goes down to.
+     * @function Render.getDynamicResolutionMinimumScale
+     * @returns {number} The lowest dynamic resolution scale, <code>&gt; 0.0</code>.
+     */
+    float getDynamicResolutionMinimumScale() const;
+
+    /*@jsdoc
+     * Sets the lowest resolution scale dynamic resolution goes down to.
+     * @function Render.setDynamicResolutionMinimumScale
+     * @param {number} scale - The lowest dynamic resolution scale, <code>&gt; 0.0</code>.
+     */
+    void setDynamicResolutionMinimumScale(float scale);
+
+    /*@jsdoc
+     * Gets the resolution scale being rendered at.
+     * @function Render.getDynamicResolutionScale
+     * @returns {number} The resolution scale being rendered at, which is <code>viewportResolutionScale</code> unless
+     *     dynamic resolution has lowered it.
+     */
+    float getDynamicResolutionScale() const;
+
+    // Called once a frame on the main thread with the GPU's average frame time and the time the display has for a frame, in
+    // ms, to lower or raise the resolution scale it renders at.
+    void updateDynamicResolution(float gpuFrameTime, float targetFrameTime);
+
 signals:
     
     /*@jsdoc
@@ -186,6 +254,13 @@ signals:
      */
     void settingsChanged();
 
+    /*@jsdoc
+     * Triggered when dynamic resolution changes the resolution scale being rendered at.
+     * @function Render.dynamicResolutionScaleChanged
+     * @returns {Signal}
+     */
+    void dynamicResolutionScaleChanged();
+
 private:
     // One lock to serialize and access safely all the settings
     mutable ReadWriteLockable _renderSettingLock;
@@ -194,23 +269,38 @@ private:
     int  _renderMethod{ RENDER_FORWARD ? render::Args::RenderMethod::FORWARD : render::Args::RenderMethod::DEFERRED };
     bool _shadowsEnabled{ true };
     bool _ambientOcclusionEnabled{ false };
+    bool _reducedEffectsEnabled{ false };
     AntialiasingConfig::Mode _antialiasingMode{ AntialiasingConfig::Mode::TAA };
     float _viewportResolutionScale{ 1.0f };
+    bool _dynamicResolutionEnabled{ false };
+    float _dynamicResolutionMinimumScale{ 0.5f };
+
+    // Dynamic resolution state, the factor applied to _viewportResolutionScale
+    float _dynamicResolutionFactor{ 1.0f };
+    int _dynamicResolutionSettleFrames{ 0 };
 
     // Actual settings saved on disk
     Setting::Handle<int> _renderMethodSetting { "renderMethod", RENDER_FORWARD ? render::Args::RenderMethod::FORWARD : render::Args::RenderMethod::DEFERRED };
     Setting::Handle<bool> _shadowsEnabledSetting { "shadowsEnabled", true };
     Setting::Handle<bool> _ambientOcclusionEnabledSetting { "ambientOcclusionEnabled", false };
+    Setting::Handle<bool> _reducedEffectsEnabledSetting { "reducedEffectsEnabled", false };
     //Setting::Handle<AntialiasingConfig::Mode> _antialiasingModeSetting { "antialiasingMode", AntialiasingConfig::Mode::TAA };
     Setting::Handle<int> _antialiasingModeSetting { "antialiasingMode", AntialiasingConfig::Mode::TAA };
     Setting::Handle<float> _viewportResolutionScaleSetting { "viewportResolutionScale", 1.0f };
+    Setting::Handle<bool> _dynamicResolutionEnabledSetting { "dynamicResolutionEnabled", false };
+    Setting::Handle<float> _dynamicResolutionMinimumScaleSetting { "dynamicResolutionMinimumScale", 0.5f };
 
     // Force assign both setting AND runtime value to the parameter value
     void forceRenderMethod(RenderMethod renderMethod);
     void forceShadowsEnabled(bool enabled);
     void forceAmbientOcclusionEnabled(bool enabled);
+    void forceReducedEffectsEnabled(bool enabled);
     void forceAntialiasingMode(AntialiasingConfig::Mode mode);
     void forceViewportResolutionScale(float scale);
+    void forceDynamicResolutionEnabled(bool enabled);
+
+    // Pushes the resolution scale with the dynamic factor applied to the render config, with the setting lock held
+    void applyResolutionScale();
 
     static std::once_flag registry_flag;
 };
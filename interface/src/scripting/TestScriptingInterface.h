@@ -121,6 +121,14 @@ public slots:
      */
     void savePhysicsSimulationStats(QString filename);
 
+    /*@jsdoc
+     * Write the bodies and constraints of the physics simulation to filename before its next step, to replay them in the
+     * physics-bench tool.
+     * @function Test.savePhysicsSnapshot
+     * @param {string} filename - Name of file to save to
+     */
+    void savePhysicsSnapshot(QString filename);
+
     /*@jsdoc
     * Profiles a specific function
     * @function Test.savePhysicsSimulationStats
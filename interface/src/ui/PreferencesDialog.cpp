@@ -129,6 +129,29 @@ void setupPreferences() {
         scaleSlider->setStep(0.02f);
         preferences->addPreference(scaleSlider);
     }
+    {
+        auto getter = []()->bool {
+            return RenderScriptingInterface::getInstance()->getDynamicResolutionEnabled();
+        };
+        auto setter = [](bool value) {
+            RenderScriptingInterface::getInstance()->setDynamicResolutionEnabled(value);
+        };
+        preferences->addPreference(new CheckPreference(GRAPHICS_QUALITY, "Lower Resolution Scale to Keep Frame Rate", getter, setter));
+    }
+    {
+        auto getter = []()->float {
+            return RenderScriptingInterface::getInstance()->getDynamicResolutionMinimumScale();
+        };
+        auto setter = [](float value) {
+            RenderScriptingInterface::getInstance()->setDynamicResolutionMinimumScale(value);
+        };
+
+        auto scaleSlider = new SliderPreference(GRAPHICS_QUALITY, "Lowest Dynamic Resolution Scale", getter, setter);
+        scaleSlider->setMin(0.25f);
+        scaleSlider->setMax(1.0f);
+        scaleSlider->setStep(0.05f);
+        preferences->addPreference(scaleSlider);
+    }
 
     // UI
     static const QString UI_CATEGORY { "User Interface" };
@@ -514,6 +537,12 @@ void setupPreferences() {
         auto preference = new CheckPreference(AUDIO_BUFFERS, "Disable output starve detection", getter, setter);
         preferences->addPreference(preference);
     }
+    {
+        auto getter = []()->bool { return DependencyManager::get<AudioClient>()->getLowLatencyOutputEnabled(); };
+        auto setter = [](bool value) { DependencyManager::get<AudioClient>()->setLowLatencyOutputEnabled(value); };
+        auto preference = new CheckPreference(AUDIO_BUFFERS, "Low-latency output (takes the device exclusively)", getter, setter);
+        preferences->addPreference(preference);
+    }
     {
         auto getter = []()->float { return DependencyManager::get<AudioClient>()->getOutputBufferSize(); };
         auto setter = [](float value) { DependencyManager::get<AudioClient>()->setOutputBufferSize(value); };
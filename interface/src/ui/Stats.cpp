@@ -23,10 +23,12 @@
 #include <AudioClient.h>
 #include <GeometryCache.h>
 #include <LODManager.h>
+#include <ObjectMotionState.h>
 #include <OffscreenUi.h>
 #include <PerfStat.h>
 #include <plugins/DisplayPlugin.h>
 #include <PickManager.h>
+#include <ScriptEngines.h>
 
 #include <gl/Context.h>
 
@@ -127,6 +129,11 @@ void Stats::updateStats(bool force) {
     STAT_UPDATE(avatarCount, avatarManager->size() - 1);
     STAT_UPDATE(heroAvatarCount, avatarManager->getNumHeroAvatars());
     STAT_UPDATE(physicsObjectCount, qApp->getNumCollisionObjects());
+    ShapeManager* shapeManager = ObjectMotionState::getShapeManager();
+    if (shapeManager) {
+        STAT_UPDATE(physicsShapeQueueDepth, shapeManager->getNumPendingShapes());
+        STAT_UPDATE_FLOAT(physicsShapeBuildTime, shapeManager->getAverageShapeBuildTime() / (float)USECS_PER_MSEC, 0.01f);
+    }
     STAT_UPDATE(updatedAvatarCount, avatarManager->getNumAvatarsUpdated());
     STAT_UPDATE(updatedHeroAvatarCount, avatarManager->getNumHeroAvatarsUpdated());
     STAT_UPDATE(notUpdatedAvatarCount, avatarManager->getNumAvatarsNotUpdated());
@@ -150,6 +157,8 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE_FLOAT(presentrate, displayPlugin->presentRate(), 0.1f);
         STAT_UPDATE_FLOAT(presentnewrate, displayPlugin->newFramePresentRate(), 0.1f);
         STAT_UPDATE_FLOAT(presentdroprate, displayPlugin->droppedFrameRate(), 0.1f);
+        STAT_UPDATE_FLOAT(presentlatency, displayPlugin->presentLatency(), 0.1f);
+        STAT_UPDATE_FLOAT(missedvsyncrate, displayPlugin->missedVsyncRate(), 0.1f);
         STAT_UPDATE_FLOAT(stutterrate, displayPlugin->stutterRate(), 0.1f);
     } else {
         STAT_UPDATE(appdropped, -1);
@@ -158,6 +167,8 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(presentrate, -1);
         STAT_UPDATE(presentnewrate, -1);
         STAT_UPDATE(presentdroprate, -1);
+        STAT_UPDATE(presentlatency, -1);
+        STAT_UPDATE(missedvsyncrate, -1);
     }
     STAT_UPDATE(gameLoopRate, (int)qApp->getGameLoopRate());
 
@@ -381,6 +392,7 @@ void Stats::updateStats(bool force) {
         QVector2D dims(displayPlugin->getRecommendedRenderSize().x, displayPlugin->getRecommendedRenderSize().y);
         dims *= qApp->getRenderResolutionScale();
         STAT_UPDATE(gpuFrameSize, dims);
+        STAT_UPDATE(renderResolutionScale, qApp->getRenderResolutionScale());
         STAT_UPDATE(gpuFrameTimePerPixel, (float)(gpuContext->getFrameTimerGPUAverage()*1000000.0 / double(dims.x()*dims.y())));
     }
     // Update Frame timing (in ms)
@@ -389,6 +401,8 @@ void Stats::updateStats(bool force) {
     auto config = qApp->getRenderEngine()->getConfiguration().get();
     STAT_UPDATE(engineFrameTime, (float) config->getCPURunTime());
     STAT_UPDATE(avatarSimulationTime, (float)avatarManager->getAvatarSimulationTime());
+    STAT_UPDATE(avatarDecodeTime, avatarManager->getAverageDecodeTime());
+    STAT_UPDATE(avatarApplyTime, avatarManager->getAverageApplyTime());
 
     if (_expanded) {
         STAT_UPDATE(gpuBuffers, (int)gpu::Context::getBufferGPUCount());
@@ -405,6 +419,8 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(gpuTextureResourceMemory, (int)BYTES_TO_MB(gpu::Context::getTextureResourceGPUMemSize()));
         STAT_UPDATE(gpuTextureResourceIdealMemory, (int)BYTES_TO_MB(gpu::Context::getTextureResourceIdealGPUMemSize()));
         STAT_UPDATE(gpuTextureResourcePopulatedMemory, (int)BYTES_TO_MB(gpu::Context::getTextureResourcePopulatedGPUMemSize()));
+        STAT_UPDATE(gpuTextureResourceUnderResolvedCount, (int)gpu::Context::getTextureResourceUnderResolvedGPUCount());
+        STAT_UPDATE(gpuTextureResourceOverResolvedMemory, (int)BYTES_TO_MB(gpu::Context::getTextureResourceOverResolvedGPUMemSize()));
         STAT_UPDATE(gpuTextureExternalMemory, (int)BYTES_TO_MB(gpu::Context::getTextureExternalGPUMemSize()));
 #if !defined(Q_OS_ANDROID)
         STAT_UPDATE(gpuTextureMemoryPressureState, getTextureMemoryPressureModeString());
@@ -460,6 +476,27 @@ void Stats::updateStats(bool force) {
         STAT_UPDATE(lodStatus, "You can see " + DependencyManager::get<LODManager>()->getLODFeedbackText());
         STAT_UPDATE(numEntityUpdates, DependencyManager::get<EntityTreeRenderer>()->getPrevNumEntityUpdates());
         STAT_UPDATE(numNeededEntityUpdates, DependencyManager::get<EntityTreeRenderer>()->getPrevTotalNeededEntityUpdates());
+        STAT_UPDATE(entityRenderBacklog, DependencyManager::get<EntityTreeRenderer>()->getRenderableBacklog());
+
+        // the busiest scripts, as the share of their script engine's thread they took over the last few seconds
+        const int MAX_SCRIPT_CPU_STATS = 5;
+        float scriptLoad;
+        auto scripts = DependencyManager::get<ScriptEngines>()->getScriptCPUStats(MAX_SCRIPT_CPU_STATS, scriptLoad);
+        QString scriptCPUStats;
+        for (const auto& script : scripts) {
+            scriptCPUStats += QString("%1%: %2%3\n").arg((int)(script.load * 100.0f), 3)
+                .arg(script.name.split("/").last()).arg(script.isThrottled ? " (throttled)" : "");
+        }
+        STAT_UPDATE_FLOAT(scriptLoad, scriptLoad * 100.0f, 0.1f);
+        STAT_UPDATE(scriptCPUStats, scriptCPUStats);
+
+        // the allocation rates are over a second, steadier than over a frame
+        auto memorySnapshot = MemoryAccounting::takeSnapshot();
+        if (memorySnapshot.timestamp >= _lastMemorySnapshot.timestamp + USECS_PER_SECOND) {
+            STAT_UPDATE(memoryStats, MemoryAccounting::toString(memorySnapshot,
+                                                                _lastMemorySnapshot.timestamp > 0 ? &_lastMemorySnapshot : nullptr));
+            _lastMemorySnapshot = memorySnapshot;
+        }
     }
 
 
@@ -586,6 +623,7 @@ void Stats::setRenderDetails(const render::RenderDetails& details) {
         STAT_UPDATE(shadowOutOfView, details._shadow._outOfView);
         STAT_UPDATE(shadowTooSmall, details._shadow._tooSmall);
         STAT_UPDATE(shadowRendered, details._shadow._rendered);
+        STAT_UPDATE(shadowCached, details._shadow._cached);
     }
 }
 
@@ -13,6 +13,7 @@
 
 #include <OffscreenQmlElement.h>
 #include <AudioIOStats.h>
+#include <MemoryAccounting.h>
 #include <render/Args.h>
 #include <shared/QtHelpers.h>
 
@@ -69,6 +70,12 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} presentdroprate - The rate at which the display plugin is dropping GPU frames, in Hz.
  *     <em>Read-only.</em>
+ * @property {number} presentlatency - The average time from a GPU frame being submitted to the display plugin to it being
+ *     presented, in ms.
+ *     <em>Read-only.</em>
+ * @property {number} missedvsyncrate - The rate at which the display plugin is missing the vsyncs it means to present at, in
+ *     Hz.
+ *     <em>Read-only.</em>
 
  * @property {number} gameLoopRate - The rate at which the game loop is running, in Hz.
  *     <em>Read-only.</em>
@@ -87,6 +94,11 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} physicsObjectCount - The number of objects that have collisions enabled.
  *     <em>Read-only.</em>
+ * @property {number} physicsShapeQueueDepth - The number of collision shapes, such as model hulls and meshes, that are 
+ *     being built or waiting to be used.
+ *     <em>Read-only.</em>
+ * @property {number} physicsShapeBuildTime - The average time taken to build one of those collision shapes, in ms.
+ *     <em>Read-only.</em>
  * @property {number} updatedAvatarCount - The number of avatars in the domain, other than the client's, that were updated in 
  *     the most recent game loop.
  *     <em>Read-only.</em>
@@ -238,6 +250,9 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} shadowRendered - The number of shadows rendered.
  *     <em>Read-only.</em>
+ * @property {number} shadowCached - The number of the shadows rendered that were taken from the shadow cache instead of
+ *     being drawn again.
+ *     <em>Read-only.</em>
  * @property {string} sendingMode - Description of the octree sending mode.
  *     <em>Read-only.</em>
  * @property {string} packetStats - Description of the octree packet processing state.
@@ -252,12 +267,24 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} numNeededEntityUpdates - The total number of entity updates scheduled for last frame.
  *     <em>Read-only.</em>
+ * @property {number} entityRenderBacklog - The number of entities still waiting to be added to the scene or to have their
+ *     rendering updated after last frame, because doing so took longer than the time allowed each frame.
+ *     <em>Read-only.</em>
  * @property {string} timingStats - Details of the average time (ms) spent in and number of calls made to different parts of 
  *     the code. Provided only if <code>timingExpanded</code> is <code>true</code>. Only the top 10 items are provided if 
  *     Developer &gt; Timing &gt; Performance Timer &gt; Only Display Top 10 is enabled.
  *     <em>Read-only.</em>
  * @property {string} gameUpdateStats - Details of the average time (ms) spent in different parts of the game loop.
  *     <em>Read-only.</em>
+ * @property {number} scriptLoad - The CPU time taken by all the script engines over the last few seconds, as a percentage of
+ *     one thread.
+ *     <em>Read-only.</em>
+ * @property {string} scriptCPUStats - The busiest Interface and entity scripts, each with the percentage of its script
+ *     engine's thread it took over the last few seconds and whether it's throttled for going over its budget.
+ *     <em>Read-only.</em>
+ * @property {string} memoryStats - The live heap and, for each subsystem, the memory held by its allocators and the rate it
+ *     allocates at, updated every second.
+ *     <em>Read-only.</em>
  * @property {number} serverElements - The total number of elements in the server octree.
  *     <em>Read-only.</em>
  * @property {number} serverInternal - The number of internal elements in the server octree.
@@ -307,6 +334,12 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} gpuTextureResourcePopulatedMemory - How much of the GPU memory allocated has actually been populated, in 
 *      MB.
+ *     <em>Read-only.</em>
+ * @property {number} gpuTextureResourceUnderResolvedCount - The number of "variable" textures drawn over more pixels on screen 
+ *     than they have texels in GPU memory.
+ *     <em>Read-only.</em>
+ * @property {number} gpuTextureResourceOverResolvedMemory - How much of the GPU memory allocated for "variable" textures holds 
+ *     mips finer than the textures are drawn on screen, in MB.
  *     <em>Read-only.</em>
  * @property {string} gpuTextureMemoryPressureState - The stats of the texture transfer engine.
  *     <ul>
@@ -327,6 +360,9 @@ private: \
  * @property {Vec2} gpuFrameSize - The dimensions of the frames being rendered, in pixels.
  *     <em>Read-only.</em>
  *     <p><strong>Note:</strong> Property not available in the API.</p>
+ * @property {number} renderResolutionScale - The resolution scale the frames are being rendered at, lowered from the
+ *     viewport resolution scale while dynamic resolution is keeping up the frame rate.
+ *     <em>Read-only.</em>
  * @property {number} gpuFrameTime - The time the GPU is spending on a frame, in ms.
  *     <em>Read-only.</em>
  * @property {number} gpuFrameTimePerPixel - The time the GPU is spending on a pixel, in ns.
@@ -337,6 +373,12 @@ private: \
  *     <em>Read-only.</em>
  * @property {number} avatarSimulationTime - The time being spent simulating avatars each frame, in ms.
  *     <em>Read-only.</em>
+ * @property {number} avatarDecodeTime - The average time spent decoding each avatar data packet from the avatar mixer, off
+ *     the main thread, in ms.
+ *     <em>Read-only.</em>
+ * @property {number} avatarApplyTime - The average time spent on the main thread applying the decoded avatar data to the
+ *     avatars each time some arrives, in ms.
+ *     <em>Read-only.</em>
  *
  * @property {number} stylusPicksCount - The number of stylus picks currently in effect.
  *     <em>Read-only.</em>
@@ -477,6 +519,8 @@ class Stats : public QQuickItem {
 
     STATS_PROPERTY(float, presentnewrate, 0)
     STATS_PROPERTY(float, presentdroprate, 0)
+    STATS_PROPERTY(float, presentlatency, 0)
+    STATS_PROPERTY(float, missedvsyncrate, 0)
     STATS_PROPERTY(int, gameLoopRate, 0)
     STATS_PROPERTY(int, avatarCount, 0)
     STATS_PROPERTY(int, refreshRateTarget, 0)
@@ -485,6 +529,8 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, uxMode, QString())
     STATS_PROPERTY(int, heroAvatarCount, 0)
     STATS_PROPERTY(int, physicsObjectCount, 0)
+    STATS_PROPERTY(int, physicsShapeQueueDepth, 0)
+    STATS_PROPERTY(float, physicsShapeBuildTime, 0)
     STATS_PROPERTY(int, updatedAvatarCount, 0)
     STATS_PROPERTY(int, updatedHeroAvatarCount, 0)
     STATS_PROPERTY(int, notUpdatedAvatarCount, 0)
@@ -542,6 +588,7 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, shadowOutOfView, 0)
     STATS_PROPERTY(int, shadowTooSmall, 0)
     STATS_PROPERTY(int, shadowRendered, 0)
+    STATS_PROPERTY(int, shadowCached, 0)
     STATS_PROPERTY(QString, sendingMode, QString())
     STATS_PROPERTY(QString, packetStats, QString())
     STATS_PROPERTY(int, lodAngle, 0)
@@ -549,8 +596,12 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(QString, lodStatus, QString())
     STATS_PROPERTY(quint64, numEntityUpdates, 0)
     STATS_PROPERTY(quint64, numNeededEntityUpdates, 0)
+    STATS_PROPERTY(quint64, entityRenderBacklog, 0)
     STATS_PROPERTY(QString, timingStats, QString())
     STATS_PROPERTY(QString, gameUpdateStats, QString())
+    STATS_PROPERTY(float, scriptLoad, 0.0f)
+    STATS_PROPERTY(QString, scriptCPUStats, QString())
+    STATS_PROPERTY(QString, memoryStats, QString())
     STATS_PROPERTY(int, serverElements, 0)
     STATS_PROPERTY(int, serverInternal, 0)
     STATS_PROPERTY(int, serverLeaves, 0)
@@ -572,15 +623,20 @@ class Stats : public QQuickItem {
     STATS_PROPERTY(int, gpuTextureResourceMemory, 0)
     STATS_PROPERTY(int, gpuTextureResourceIdealMemory, 0)
     STATS_PROPERTY(int, gpuTextureResourcePopulatedMemory, 0)
+    STATS_PROPERTY(int, gpuTextureResourceUnderResolvedCount, 0)
+    STATS_PROPERTY(int, gpuTextureResourceOverResolvedMemory, 0)
     STATS_PROPERTY(int, gpuTextureExternalMemory, 0)
     STATS_PROPERTY(QString, gpuTextureMemoryPressureState, QString())
     STATS_PROPERTY(int, gpuFreeMemory, 0)
     STATS_PROPERTY(QVector2D, gpuFrameSize, QVector2D(0,0))
+    STATS_PROPERTY(float, renderResolutionScale, 1.0f)
     STATS_PROPERTY(float, gpuFrameTime, 0)
     STATS_PROPERTY(float, gpuFrameTimePerPixel, 0)
     STATS_PROPERTY(float, batchFrameTime, 0)
     STATS_PROPERTY(float, engineFrameTime, 0)
     STATS_PROPERTY(float, avatarSimulationTime, 0)
+    STATS_PROPERTY(float, avatarDecodeTime, 0)
+    STATS_PROPERTY(float, avatarApplyTime, 0)
 
     STATS_PROPERTY(int, stylusPicksCount, 0)
     STATS_PROPERTY(int, rayPicksCount, 0)
@@ -739,6 +795,20 @@ signals:
      */
     void presentdroprateChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>presentlatency</code> property changes.
+     * @function Stats.presentlatencyChanged
+     * @returns {Signal}
+     */
+    void presentlatencyChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>missedvsyncrate</code> property changes.
+     * @function Stats.missedvsyncrateChanged
+     * @returns {Signal}
+     */
+    void missedvsyncrateChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>gameLoopRate</code> property changes.
      * @function Stats.gameLoopRateChanged
@@ -795,6 +865,20 @@ signals:
      */
     void physicsObjectCountChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>physicsShapeQueueDepth</code> property changes.
+     * @function Stats.physicsShapeQueueDepthChanged
+     * @returns {Signal}
+     */
+    void physicsShapeQueueDepthChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>physicsShapeBuildTime</code> property changes.
+     * @function Stats.physicsShapeBuildTimeChanged
+     * @returns {Signal}
+     */
+    void physicsShapeBuildTimeChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>updatedAvatarCount</code> property changes.
      * @function Stats.updatedAvatarCountChanged
@@ -1182,6 +1266,13 @@ signals:
      */
     void shadowRenderedChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>shadowCached</code> property changes.
+     * @function Stats.shadowCachedChanged
+     * @returns {Signal}
+     */
+    void shadowCachedChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>sendingMode</code> property changes.
      * @function Stats.sendingModeChanged
@@ -1231,6 +1322,13 @@ signals:
      */
     void numNeededEntityUpdatesChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>entityRenderBacklog</code> property changes.
+     * @function Stats.entityRenderBacklogChanged
+     * @returns {Signal}
+     */
+    void entityRenderBacklogChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>timingStats</code> property changes.
      * @function Stats.timingStatsChanged
@@ -1245,6 +1343,27 @@ signals:
      */
     void gameUpdateStatsChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>scriptLoad</code> property changes.
+     * @function Stats.scriptLoadChanged
+     * @returns {Signal}
+     */
+    void scriptLoadChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>scriptCPUStats</code> property changes.
+     * @function Stats.scriptCPUStatsChanged
+     * @returns {Signal}
+     */
+    void scriptCPUStatsChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>memoryStats</code> property changes.
+     * @function Stats.memoryStatsChanged
+     * @returns {Signal}
+     */
+    void memoryStatsChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>serverElements</code> property changes.
      * @function Stats.serverElementsChanged
@@ -1385,6 +1504,20 @@ signals:
      */
     void gpuTextureResourcePopulatedMemoryChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>gpuTextureResourceUnderResolvedCount</code> property changes.
+     * @function Stats.gpuTextureResourceUnderResolvedCountChanged
+     * @returns {Signal}
+     */
+    void gpuTextureResourceUnderResolvedCountChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>gpuTextureResourceOverResolvedMemory</code> property changes.
+     * @function Stats.gpuTextureResourceOverResolvedMemoryChanged
+     * @returns {Signal}
+     */
+    void gpuTextureResourceOverResolvedMemoryChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>gpuTextureExternalMemory</code> property changes.
      * @function Stats.gpuTextureExternalMemoryChanged
@@ -1413,6 +1546,13 @@ signals:
      */
     void gpuFrameSizeChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>renderResolutionScale</code> property changes.
+     * @function Stats.renderResolutionScaleChanged
+     * @returns {Signal}
+     */
+    void renderResolutionScaleChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>gpuFrameTime</code> property changes.
      * @function Stats.gpuFrameTimeChanged
@@ -1448,6 +1588,20 @@ signals:
      */
     void avatarSimulationTimeChanged();
 
+    /*@jsdoc
+     * Triggered when the value of the <code>avatarDecodeTime</code> property changes.
+     * @function Stats.avatarDecodeTimeChanged
+     * @returns {Signal}
+     */
+    void avatarDecodeTimeChanged();
+
+    /*@jsdoc
+     * Triggered when the value of the <code>avatarApplyTime</code> property changes.
+     * @function Stats.avatarApplyTimeChanged
+     * @returns {Signal}
+     */
+    void avatarApplyTimeChanged();
+
     /*@jsdoc
      * Triggered when the value of the <code>stylusPicksCount</code> property changes.
      * @function Stats.stylusPicksCountChanged
@@ -1814,6 +1968,7 @@ private:
     bool _expanded{ false };
     bool _showTimingDetails{ false };
     bool _showGameUpdateStats{ false };
+    MemoryAccounting::Snapshot _lastMemorySnapshot;
     QString _monospaceFont;
     const AudioIOStats* _audioStats;
     QStringList _downloadUrls = QStringList();
@@ -264,49 +264,23 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
     if (_blendType == AnimBlendType_Normal) {
         if (_networkAnim && _networkAnim->isLoaded() && _skeleton) {
             // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
-
-            // we no longer need the actual animation resource anymore.
-            _networkAnim.reset();
-
-            // mirrorAnim will be re-built on demand, if needed.
-            _mirrorAnim.clear();
-
-            _poses.resize(_skeleton->getNumJoints());
+            loadClipData();
         }
     } else {
         // an additive blend type
         if (_networkAnim && _networkAnim->isLoaded() && _baseNetworkAnim && _baseNetworkAnim->isLoaded() && _skeleton) {
-            // loading is complete, copy & retarget animation.
-            _anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
-
-            // we no longer need the actual animation resource anymore.
-            _networkAnim.reset();
-
-            // mirrorAnim will be re-built on demand, if needed.
-            // TODO: handle mirrored relative animations.
-            _mirrorAnim.clear();
-
-            _poses.resize(_skeleton->getNumJoints());
-
-            // copy & retarget baseAnim!
-            auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
-
-            if (_blendType == AnimBlendType_AddAbsolute) {
-                bakeAbsoluteDeltaAnim(_anim, baseAnim[(int)_baseFrame], _skeleton);
-            } else {
-                // AnimBlendType_AddRelative
-                bakeRelativeDeltaAnim(_anim, baseAnim[(int)_baseFrame]);
-            }
+            // loading is complete, copy & retarget animation and its base.
+            loadClipData();
         }
     }
 
-    if (_anim.size()) {
+    if (_clipData && _clipData->getNumFrames() > 0) {
 
         // lazy creation of mirrored animation frames.
-        if (_mirrorFlag && _anim.size() != _mirrorAnim.size()) {
+        if (_mirrorFlag && !_mirrorClipData) {
             buildMirrorAnim();
         }
+        const AnimClipData& clipData = _mirrorFlag ? *_mirrorClipData : *_clipData;
 
         int prevIndex = (int)glm::floor(_frame);
         int nextIndex;
@@ -318,15 +292,19 @@ const AnimPoseVec& AnimClip::evaluate(const AnimVariantMap& animVars, const Anim
 
         // It can be quite possible for the user to set _startFrame and _endFrame to
         // values before or past valid ranges.  We clamp the frames here.
-        int frameCount = (int)_anim.size();
+        int frameCount = clipData.getNumFrames();
         prevIndex = std::min(std::max(0, prevIndex), frameCount - 1);
         nextIndex = std::min(std::max(0, nextIndex), frameCount - 1);
 
-        const AnimPoseVec& prevFrame = _mirrorFlag ? _mirrorAnim[prevIndex] : _anim[prevIndex];
-        const AnimPoseVec& nextFrame = _mirrorFlag ? _mirrorAnim[nextIndex] : _anim[nextIndex];
+        clipData.decompress(prevIndex, _prevPoses.data());
+        const AnimPoseVec* nextFrame = &_prevPoses;
+        if (nextIndex != prevIndex) {
+            clipData.decompress(nextIndex, _nextPoses.data());
+            nextFrame = &_nextPoses;
+        }
         float alpha = glm::fract(_frame);
 
-        ::blend(_poses.size(), &prevFrame[0], &nextFrame[0], alpha, &_poses[0]);
+        ::blend(_poses.size(), &_prevPoses[0], &(*nextFrame)[0], alpha, &_poses[0]);
     }
 
     processOutputJoints(triggersOut);
@@ -341,15 +319,49 @@ void AnimClip::setCurrentFrameInternal(float frame) {
     _frame = ::accumulateTime(_startFrame, _endFrame, _timeScale, frame + _startFrame, dt, _loopFlag, _id, triggers);
 }
 
+void AnimClip::loadClipData() {
+    // the key holds everything the frames are built from, so that clips which would build the same ones share them
+    _clipKey = QString("%1|%2|%3|%4|%5").arg(_url).arg((int)_blendType).arg(_baseURL).arg(_baseFrame)
+        .arg(AnimClipData::getSkeletonKey(*_skeleton));
+    _clipData = AnimClipData::fetch(_clipKey, [&] {
+        auto anim = copyAndRetargetFromNetworkAnim(_networkAnim, _skeleton);
+        if (_blendType != AnimBlendType_Normal) {
+            // copy & retarget baseAnim!
+            auto baseAnim = copyAndRetargetFromNetworkAnim(_baseNetworkAnim, _skeleton);
+
+            if (_blendType == AnimBlendType_AddAbsolute) {
+                bakeAbsoluteDeltaAnim(anim, baseAnim[(int)_baseFrame], _skeleton);
+            } else {
+                // AnimBlendType_AddRelative
+                bakeRelativeDeltaAnim(anim, baseAnim[(int)_baseFrame]);
+            }
+        }
+        return std::make_shared<const AnimClipData>(anim, extractScale(_skeleton->getGeometryOffset()).y);
+    });
+
+    // we no longer need the actual animation resource anymore.
+    _networkAnim.reset();
+
+    // mirrorClipData will be re-built on demand, if needed.
+    // TODO: handle mirrored relative animations.
+    _mirrorClipData.reset();
+
+    const int numJoints = _skeleton->getNumJoints();
+    _poses.resize(numJoints);
+    _prevPoses.resize(numJoints);
+    _nextPoses.resize(numJoints);
+}
+
 void AnimClip::buildMirrorAnim() {
-    assert(_skeleton);
+    assert(_skeleton && _clipData);
 
-    _mirrorAnim.clear();
-    _mirrorAnim.reserve(_anim.size());
-    for (auto& relPoses : _anim) {
-        _mirrorAnim.push_back(relPoses);
-        _skeleton->mirrorRelativePoses(_mirrorAnim.back());
-    }
+    _mirrorClipData = AnimClipData::fetch(_clipKey + "|mirror", [&] {
+        std::vector<AnimPoseVec> mirrorAnim = _clipData->decompressAll();
+        for (auto& relPoses : mirrorAnim) {
+            _skeleton->mirrorRelativePoses(relPoses);
+        }
+        return std::make_shared<const AnimClipData>(mirrorAnim, extractScale(_skeleton->getGeometryOffset()).y);
+    });
 }
 
 const AnimPoseVec& AnimClip::getPosesInternal() const {
@@ -13,6 +13,7 @@
 
 #include <string>
 #include "AnimationCache.h"
+#include "AnimClipData.h"
 #include "AnimNode.h"
 
 // Playback a single animation timeline.
@@ -61,6 +62,7 @@ protected:
 
     virtual void setCurrentFrameInternal(float frame) override;
 
+    void loadClipData();
     void buildMirrorAnim();
 
     // for AnimDebugDraw rendering
@@ -71,9 +73,14 @@ protected:
 
     AnimPoseVec _poses;
 
-    // _anim[frame][joint]
-    std::vector<AnimPoseVec> _anim;
-    std::vector<AnimPoseVec> _mirrorAnim;
+    // the retargeted frames, shared with the other clips that play the same animation on the same skeleton
+    AnimClipData::ConstPointer _clipData;
+    AnimClipData::ConstPointer _mirrorClipData;
+    QString _clipKey;
+
+    // the two frames blended for the current one
+    AnimPoseVec _prevPoses;
+    AnimPoseVec _nextPoses;
 
     QString _url;
     float _startFrame;
@@ -0,0 +1,264 @@
+//
+//  AnimClipData.cpp
+//  libraries/animation/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimClipData.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+
+#include <QtCore/QCryptographicHash>
+
+#include <NumericalConstants.h>
+
+#include "AnimSkeleton.h"
+#include "AnimationLogging.h"
+
+const float AnimClipData::ROTATION_TOLERANCE = 0.001f;
+const float AnimClipData::TRANSLATION_TOLERANCE = 0.0001f;
+const float AnimClipData::SCALE_TOLERANCE = 0.0001f;
+
+namespace {
+
+const float ROTATION_KEY_SCALE = (float)std::numeric_limits<int16_t>::max();
+const float VEC3_KEY_MAX = (float)std::numeric_limits<uint16_t>::max();
+
+std::mutex clipsMutex;
+std::unordered_map<std::string, std::weak_ptr<const AnimClipData>> clips;
+
+using PoseComparison = std::function<bool(const AnimPose&, const AnimPose&)>;
+
+bool isConstant(const std::vector<AnimPoseVec>& frames, int joint, const PoseComparison& isClose) {
+    for (const auto& frame : frames) {
+        if (!isClose(frames[0][joint], frame[joint])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+AnimClipData::AnimClipData(const std::vector<AnimPoseVec>& frames, float metersPerUnit) :
+    _numFrames((int)frames.size())
+{
+    if (frames.empty()) {
+        return;
+    }
+    _constantPoses = frames[0];
+    const int numJoints = (int)_constantPoses.size();
+
+    const float MIN_ROTATION_DOT = cosf(0.5f * ROTATION_TOLERANCE);
+    PoseComparison isRotationClose = [&](const AnimPose& a, const AnimPose& b) {
+        return fabsf(glm::dot(a.rot(), b.rot())) >= MIN_ROTATION_DOT;
+    };
+    const float translationTolerance = metersPerUnit > 0.0f ? TRANSLATION_TOLERANCE / metersPerUnit : TRANSLATION_TOLERANCE;
+    PoseComparison isTranslationClose = [&](const AnimPose& a, const AnimPose& b) {
+        return glm::distance(a.trans(), b.trans()) <= translationTolerance;
+    };
+    PoseComparison isScaleClose = [&](const AnimPose& a, const AnimPose& b) {
+        return glm::distance(a.scale(), b.scale()) <= SCALE_TOLERANCE;
+    };
+
+    // sort the parts that change into channels: quantized rotations, and translations and scales quantized over their
+    // range when its steps are fine enough, floats when they're not
+    for (int joint = 0; joint < numJoints; ++joint) {
+        if (!isConstant(frames, joint, isRotationClose)) {
+            _rotationJoints.push_back(joint);
+        }
+        for (bool isScale : { true, false }) {
+            if (isConstant(frames, joint, isScale ? isScaleClose : isTranslationClose)) {
+                continue;
+            }
+            glm::vec3 minValue(std::numeric_limits<float>::max());
+            glm::vec3 maxValue(-std::numeric_limits<float>::max());
+            for (const auto& frame : frames) {
+                const glm::vec3& value = isScale ? frame[joint].scale() : frame[joint].trans();
+                minValue = glm::min(minValue, value);
+                maxValue = glm::max(maxValue, value);
+            }
+            glm::vec3 step = (maxValue - minValue) / VEC3_KEY_MAX;
+            float tolerance = isScale ? SCALE_TOLERANCE : translationTolerance;
+            Vec3Channel channel { glm::vec4(minValue, 0.0f), glm::vec4(step, 0.0f), joint, isScale };
+            if (0.5f * glm::max(step.x, glm::max(step.y, step.z)) <= tolerance) {
+                _quantizedChannels.push_back(channel);
+            } else {
+                _floatChannels.push_back(channel);
+            }
+        }
+    }
+
+    _rotationKeys.reserve(frames.size() * _rotationJoints.size() * 4);
+    _quantizedKeys.reserve(frames.size() * _quantizedChannels.size() * 3 + 1);
+    _floatKeys.reserve(frames.size() * _floatChannels.size() * 3);
+    for (const auto& frame : frames) {
+        for (int joint : _rotationJoints) {
+            const float* rot = reinterpret_cast<const float*>(&frame[joint].rot());
+            for (int i = 0; i < 4; ++i) {
+                _rotationKeys.push_back((int16_t)roundf(glm::clamp(rot[i], -1.0f, 1.0f) * ROTATION_KEY_SCALE));
+            }
+        }
+        for (const auto& channel : _quantizedChannels) {
+            const glm::vec3& value = channel.isScale ? frame[channel.joint].scale() : frame[channel.joint].trans();
+            for (int i = 0; i < 3; ++i) {
+                float key = channel.step[i] > 0.0f ? (value[i] - channel.offset[i]) / channel.step[i] : 0.0f;
+                _quantizedKeys.push_back((uint16_t)glm::clamp(roundf(key), 0.0f, VEC3_KEY_MAX));
+            }
+        }
+        for (const auto& channel : _floatChannels) {
+            const glm::vec3& value = channel.isScale ? frame[channel.joint].scale() : frame[channel.joint].trans();
+            _floatKeys.insert(_floatKeys.end(), { value.x, value.y, value.z });
+        }
+    }
+    // decompress() reads the keys of each quantized channel four at a time, this keeps the last read inside the keys
+    _quantizedKeys.push_back(0);
+}
+
+void AnimClipData::decompress(int frame, AnimPose* result) const {
+    assert(frame >= 0 && frame < _numFrames);
+    std::copy(_constantPoses.begin(), _constantPoses.end(), result);
+
+    const float* floatKeys = _floatKeys.data() + (size_t)frame * _floatChannels.size() * 3;
+    for (const auto& channel : _floatChannels) {
+        AnimPose& pose = result[channel.joint];
+        (channel.isScale ? pose.scale() : pose.trans()) = glm::vec3(floatKeys[0], floatKeys[1], floatKeys[2]);
+        floatKeys += 3;
+    }
+
+    const uint16_t* quantizedKeys = _quantizedKeys.data() + (size_t)frame * _quantizedChannels.size() * 3;
+    const int16_t* rotationKeys = _rotationKeys.data() + (size_t)frame * _rotationJoints.size() * 4;
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    const __m128i ZERO = _mm_setzero_si128();
+    for (const auto& channel : _quantizedChannels) {
+        AnimPose& pose = result[channel.joint];
+        float* value = channel.isScale ? &pose.scale().x : &pose.trans().x;
+        // the fourth key belongs to the next channel, its step is zero
+        __m128i keys = _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(quantizedKeys)), ZERO);
+        __m128 decoded = _mm_add_ps(_mm_loadu_ps(&channel.offset.x),
+            _mm_mul_ps(_mm_cvtepi32_ps(keys), _mm_loadu_ps(&channel.step.x)));
+        // store three floats, the fourth lane would land on the rotation
+        _mm_storel_pi(reinterpret_cast<__m64*>(value), decoded);
+        _mm_store_ss(value + 2, _mm_movehl_ps(decoded, decoded));
+        quantizedKeys += 3;
+    }
+
+    // widen each 16 bit component to 32 bits with its sign, then scale back to [-1, 1]
+    const __m128 ROTATION_STEP = _mm_set1_ps(1.0f / ROTATION_KEY_SCALE);
+    for (int joint : _rotationJoints) {
+        __m128i keys = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(rotationKeys));
+        keys = _mm_srai_epi32(_mm_unpacklo_epi16(keys, keys), 16);
+        _mm_storeu_ps(reinterpret_cast<float*>(&result[joint].rot()), _mm_mul_ps(_mm_cvtepi32_ps(keys), ROTATION_STEP));
+        rotationKeys += 4;
+    }
+#else
+    for (const auto& channel : _quantizedChannels) {
+        AnimPose& pose = result[channel.joint];
+        glm::vec3& value = channel.isScale ? pose.scale() : pose.trans();
+        for (int i = 0; i < 3; ++i) {
+            value[i] = channel.offset[i] + (float)quantizedKeys[i] * channel.step[i];
+        }
+        quantizedKeys += 3;
+    }
+
+    for (int joint : _rotationJoints) {
+        float* rot = reinterpret_cast<float*>(&result[joint].rot());
+        for (int i = 0; i < 4; ++i) {
+            rot[i] = (float)rotationKeys[i] / ROTATION_KEY_SCALE;
+        }
+        rotationKeys += 4;
+    }
+#endif
+    // the quantized rotations are within a key of unit length, blend() normalizes what it samples
+}
+
+std::vector<AnimPoseVec> AnimClipData::decompressAll() const {
+    std::vector<AnimPoseVec> frames(_numFrames, AnimPoseVec(_constantPoses.size()));
+    for (int frame = 0; frame < _numFrames; ++frame) {
+        decompress(frame, frames[frame].data());
+        for (auto& pose : frames[frame]) {
+            pose.rot() = glm::normalize(pose.rot());
+        }
+    }
+    return frames;
+}
+
+size_t AnimClipData::getCompressedSize() const {
+    return sizeof(AnimClipData) + _constantPoses.size() * sizeof(AnimPose) + _rotationJoints.size() * sizeof(int) +
+        _rotationKeys.size() * sizeof(int16_t) + (_quantizedChannels.size() + _floatChannels.size()) * sizeof(Vec3Channel) +
+        _quantizedKeys.size() * sizeof(uint16_t) + _floatKeys.size() * sizeof(float);
+}
+
+AnimClipData::ConstPointer AnimClipData::fetch(const QString& key, const std::function<ConstPointer()>& create) {
+    const std::string clipKey = key.toStdString();
+    {
+        std::lock_guard<std::mutex> lock(clipsMutex);
+        auto itr = clips.find(clipKey);
+        if (itr != clips.end()) {
+            if (auto clip = itr->second.lock()) {
+                return clip;
+            }
+        }
+    }
+
+    // build it unlocked, retargeting is slow, and keep whichever copy is registered first
+    ConstPointer clip = create();
+    if (!clip) {
+        return clip;
+    }
+    {
+        std::lock_guard<std::mutex> lock(clipsMutex);
+        auto& entry = clips[clipKey];
+        if (auto existing = entry.lock()) {
+            return existing;
+        }
+        entry = clip;
+        for (auto itr = clips.begin(); itr != clips.end();) {
+            itr = itr->second.expired() ? clips.erase(itr) : std::next(itr);
+        }
+    }
+    Stats stats = getStats();
+    qCDebug(animation) << "AnimClipData, compressed" << key << "from" << clip->getUncompressedSize() / BYTES_PER_KILOBYTE
+        << "kB to" << clip->getCompressedSize() / BYTES_PER_KILOBYTE << "kB," << stats.numClips << "clips for"
+        << stats.numUsers << "users in" << stats.compressedSize / BYTES_PER_KILOBYTE << "kB instead of"
+        << stats.uncompressedSize / BYTES_PER_KILOBYTE << "kB";
+    return clip;
+}
+
+QString AnimClipData::getSkeletonKey(const AnimSkeleton& skeleton) {
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    const int numJoints = skeleton.getNumJoints();
+    for (int i = 0; i < numJoints; ++i) {
+        hash.addData(skeleton.getJointName(i).toUtf8());
+        int parentIndex = skeleton.getParentIndex(i);
+        hash.addData(reinterpret_cast<const char*>(&parentIndex), sizeof(parentIndex));
+        hash.addData(reinterpret_cast<const char*>(&skeleton.getRelativeDefaultPose(i)), sizeof(AnimPose));
+    }
+    hash.addData(reinterpret_cast<const char*>(&skeleton.getGeometryOffset()), sizeof(glm::mat4));
+    return QString::fromLatin1(hash.result().toHex());
+}
+
+AnimClipData::Stats AnimClipData::getStats() {
+    std::lock_guard<std::mutex> lock(clipsMutex);
+    Stats stats;
+    for (const auto& entry : clips) {
+        if (auto clip = entry.second.lock()) {
+            // not counting the reference just taken
+            int numUsers = (int)clip.use_count() - 1;
+            ++stats.numClips;
+            stats.numUsers += numUsers;
+            stats.compressedSize += clip->getCompressedSize();
+            stats.uncompressedSize += numUsers * clip->getUncompressedSize();
+        }
+    }
+    return stats;
+}
@@ -0,0 +1,92 @@
+//
+//  AnimClipData.h
+//  libraries/animation/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimClipData_h
+#define hifi_AnimClipData_h
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <QtCore/QString>
+
+#include "AnimPose.h"
+
+class AnimSkeleton;
+
+// The frames of a clip retargeted to a skeleton, stored compactly and shared between all the AnimClips that play the
+// same animation on skeletons with the same joints.
+//
+// A joint's rotation, translation or scale that stays within a tolerance of its first frame is kept once rather than
+// per frame. Rotations that do change are quantized to 16 bits per component and translations and scales to 16 bits
+// per axis over their range, falling back to floats when that range is too wide to meet the tolerance.
+class AnimClipData {
+public:
+    using ConstPointer = std::shared_ptr<const AnimClipData>;
+
+    // the most a joint can stray from its first frame and still be kept once
+    static const float ROTATION_TOLERANCE; // radians
+    static const float TRANSLATION_TOLERANCE; // meters
+    static const float SCALE_TOLERANCE;
+
+    // frames[frame][joint] are the relative poses of every joint, metersPerUnit the size of the skeleton's units
+    AnimClipData(const std::vector<AnimPoseVec>& frames, float metersPerUnit);
+
+    int getNumFrames() const { return _numFrames; }
+    int getNumJoints() const { return (int)_constantPoses.size(); }
+
+    // writes the relative poses of every joint at the frame
+    void decompress(int frame, AnimPose* result) const;
+    std::vector<AnimPoseVec> decompressAll() const;
+
+    // in bytes, as stored, and as the frames it was built from
+    size_t getCompressedSize() const;
+    size_t getUncompressedSize() const { return (size_t)_numFrames * _constantPoses.size() * sizeof(AnimPose); }
+
+    // Returns the clip data with the key while anyone still holds it, otherwise creates and returns it. The key should
+    // identify everything the frames are built from.
+    static ConstPointer fetch(const QString& key, const std::function<ConstPointer()>& create);
+
+    // identifies the joints, hierarchy and default poses of a skeleton, everything that retargeting a clip to it uses
+    static QString getSkeletonKey(const AnimSkeleton& skeleton);
+
+    struct Stats {
+        int numClips { 0 };
+        int numUsers { 0 };
+        size_t compressedSize { 0 };
+        // what every user would hold if each kept its own uncompressed copy
+        size_t uncompressedSize { 0 };
+    };
+    static Stats getStats();
+
+private:
+    struct Vec3Channel {
+        glm::vec4 offset;
+        glm::vec4 step;
+        int joint;
+        bool isScale;
+    };
+
+    int _numFrames { 0 };
+
+    // the first frame, which holds the joints' constant parts
+    AnimPoseVec _constantPoses;
+
+    // the keys of the parts that change, frame by frame
+    std::vector<int> _rotationJoints;
+    std::vector<int16_t> _rotationKeys;
+    std::vector<Vec3Channel> _quantizedChannels;
+    std::vector<uint16_t> _quantizedKeys;
+    std::vector<Vec3Channel> _floatChannels;
+    std::vector<float> _floatKeys;
+};
+
+#endif // hifi_AnimClipData_h
@@ -67,13 +67,27 @@ glm::vec3 AnimPose::xformVectorFast(const glm::vec3& rhs) const {
     return _rot * (_scale * rhs);
 }
 
+// a uniform scale commutes with rotations, so poses with one can be multiplied and inverted by parts,
+// which is much cheaper than going through a matrix and decomposing the result.
+bool AnimPose::hasUniformScale() const {
+    return _scale.x > 0.0f && fabsf(_scale.x - _scale.y) <= EPSILON * _scale.x && fabsf(_scale.x - _scale.z) <= EPSILON * _scale.x;
+}
+
 AnimPose AnimPose::operator*(const AnimPose& rhs) const {
+    if (hasUniformScale()) {
+        return AnimPose(_scale.x * rhs._scale, _rot * rhs._rot, _trans + _rot * (_scale.x * rhs._trans));
+    }
     glm::mat4 result;
     glm_mat4u_mul(*this, rhs, result);
     return AnimPose(result);
 }
 
 AnimPose AnimPose::inverse() const {
+    if (hasUniformScale()) {
+        float inverseScale = 1.0f / _scale.x;
+        glm::quat inverseRot = glm::conjugate(_rot);
+        return AnimPose(glm::vec3(inverseScale), inverseRot, -inverseScale * (inverseRot * _trans));
+    }
     return AnimPose(glm::inverse(static_cast<glm::mat4>(*this)));
 }
 
@@ -83,11 +97,10 @@ AnimPose AnimPose::mirror() const {
 }
 
 AnimPose::operator glm::mat4() const {
-    glm::vec3 xAxis = _rot * glm::vec3(_scale.x, 0.0f, 0.0f);
-    glm::vec3 yAxis = _rot * glm::vec3(0.0f, _scale.y, 0.0f);
-    glm::vec3 zAxis = _rot * glm::vec3(0.0f, 0.0f, _scale.z);
-    return glm::mat4(glm::vec4(xAxis, 0.0f), glm::vec4(yAxis, 0.0f),
-        glm::vec4(zAxis, 0.0f), glm::vec4(_trans, 1.0f));
+    // one rotation matrix for all three axes, rather than rotating each of them
+    glm::mat3 rotMat = glm::mat3_cast(_rot);
+    return glm::mat4(glm::vec4(_scale.x * rotMat[0], 0.0f), glm::vec4(_scale.y * rotMat[1], 0.0f),
+        glm::vec4(_scale.z * rotMat[2], 0.0f), glm::vec4(_trans, 1.0f));
 }
 
 void AnimPose::blend(const AnimPose& srcPose, float alpha) {
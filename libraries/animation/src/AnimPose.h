@@ -37,6 +37,7 @@ public:
 
     AnimPose inverse() const;
     AnimPose mirror() const;
+    bool hasUniformScale() const;
     operator glm::mat4() const;
 
     const glm::vec3& scale() const { return _scale; }
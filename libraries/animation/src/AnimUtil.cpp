@@ -13,9 +13,49 @@
 #include <NumericalConstants.h>
 #include <DebugDraw.h>
 
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+// the dot product of two quats, in all four lanes
+static inline __m128 dot4(__m128 a, __m128 b) {
+    __m128 products = _mm_mul_ps(a, b);
+    __m128 sums = _mm_add_ps(products, _mm_shuffle_ps(products, products, _MM_SHUFFLE(2, 3, 0, 1)));
+    return _mm_add_ps(sums, _mm_shuffle_ps(sums, sums, _MM_SHUFFLE(1, 0, 3, 2)));
+}
+
+static inline __m128 lerp4(__m128 a, __m128 b, __m128 alpha) {
+    return _mm_add_ps(a, _mm_mul_ps(alpha, _mm_sub_ps(b, a)));
+}
+#endif
+
 // TODO: use restrict keyword
-// TODO: excellent candidate for simd vectorization.
 void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, AnimPose* result) {
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    // An AnimPose is ten floats: scale, rot and trans. Each part is loaded as four floats that stay within the pose, and
+    // the rotation is stored last, over the lanes of the scale and trans that belong to it.
+    static_assert(sizeof(AnimPose) == 10 * sizeof(float), "blend() expects AnimPose to be packed floats");
+    const int ROT_OFFSET = 3;
+    const int TRANS_OFFSET = 6;
+    const __m128 alphas = _mm_set1_ps(alpha);
+    const __m128 SIGN_BITS = _mm_set1_ps(-0.0f);
+    for (size_t i = 0; i < numPoses; i++) {
+        const float* aData = &a[i].scale().x;
+        const float* bData = &b[i].scale().x;
+        float* resultData = &result[i].scale().x;
+
+        __m128 aRot = _mm_loadu_ps(aData + ROT_OFFSET);
+        __m128 bRot = _mm_loadu_ps(bData + ROT_OFFSET);
+        // same as safeLerp(): flip b to the same side as a
+        bRot = _mm_xor_ps(bRot, _mm_and_ps(dot4(aRot, bRot), SIGN_BITS));
+        __m128 rot = lerp4(aRot, bRot, alphas);
+        rot = _mm_div_ps(rot, _mm_sqrt_ps(dot4(rot, rot)));
+
+        __m128 scale = lerp4(_mm_loadu_ps(aData), _mm_loadu_ps(bData), alphas);
+        __m128 trans = lerp4(_mm_loadu_ps(aData + TRANS_OFFSET), _mm_loadu_ps(bData + TRANS_OFFSET), alphas);
+
+        _mm_storeu_ps(resultData, scale);
+        _mm_storeu_ps(resultData + TRANS_OFFSET, trans);
+        _mm_storeu_ps(resultData + ROT_OFFSET, rot);
+    }
+#else
     for (size_t i = 0; i < numPoses; i++) {
         const AnimPose& aPose = a[i];
         const AnimPose& bPose = b[i];
@@ -24,6 +64,7 @@ void blend(size_t numPoses, const AnimPose* a, const AnimPose* b, float alpha, A
         result[i].rot() = safeLerp(aPose.rot(), bPose.rot(), alpha);
         result[i].trans() = lerp(aPose.trans(), bPose.trans(), alpha);
     }
+#endif
 }
 
 void blend3(size_t numPoses, const AnimPose* a, const AnimPose* b, const AnimPose* c, float* alphas, AnimPose* result) {
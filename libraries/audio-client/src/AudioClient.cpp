@@ -13,6 +13,7 @@
 
 #include "AudioClient.h"
 
+#include <algorithm>
 #include <cstring>
 #include <math.h>
 #include <sys/stat.h>
@@ -401,6 +402,13 @@ AudioClient::~AudioClient() {
 
     stop();
 
+    auto pending = _pendingLocalInjectors.exchange(nullptr);
+    while (pending) {
+        auto next = pending->next;
+        delete pending;
+        pending = next;
+    }
+
     if (_codec && _encoder) {
         _codec->releaseEncoder(_encoder);
         _encoder = nullptr;
@@ -869,7 +877,7 @@ void AudioClient::handleAudioDataPacket(QSharedPointer<ReceivedMessage> message)
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->flagTimeForConnectionStep(LimitedNodeList::ConnectionStep::ReceiveFirstAudioPacket);
 
-    if (_audioOutput) {
+    if (_audioOutput || _audioOutputBackend) {
 
         if (!_hasReceivedFirstPacket) {
             _hasReceivedFirstPacket = true;
@@ -1588,19 +1596,21 @@ bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
         return false;
     }
 
-    // lock the injectors
-    Lock lock(_injectorsMutex);
+    // the injectors are the mixing thread's own, it only takes the new ones off the queue
+    takePendingLocalInjectors();
 
     QVector<AudioInjectorPointer> injectorsToRemove;
 
     memset(mixBuffer, 0, AudioConstants::NETWORK_FRAME_SAMPLES_STEREO * sizeof(float));
 
-    for (const AudioInjectorPointer& injector : _activeLocalAudioInjectors) {
-        // the lock guarantees that injectorBuffer, if found, is invariant
+    for (LocalInjector& localInjector : _activeLocalAudioInjectors) {
+        const AudioInjectorPointer& injector = localInjector.injector;
         auto injectorBuffer = injector->getLocalBuffer();
         if (injectorBuffer) {
 
-            auto options = injector->getOptions();
+            // a script setting the options keeps mixing with the last ones rather than waiting on it
+            injector->tryGetOptions(localInjector.options);
+            const auto& options = localInjector.options;
 
             static const int HRTF_DATASET_INDEX = 1;
 
@@ -1690,17 +1700,57 @@ bool AudioClient::mixLocalAudioInjectors(float* mixBuffer) {
         }
     }
 
-    for (const AudioInjectorPointer& injector : injectorsToRemove) {
-        //qCDebug(audioclient) << "removing injector";
-        _activeLocalAudioInjectors.removeOne(injector);
+    if (!injectorsToRemove.empty()) {
+        //qCDebug(audioclient) << "removing injectors";
+        _activeLocalAudioInjectors.erase(std::remove_if(_activeLocalAudioInjectors.begin(), _activeLocalAudioInjectors.end(),
+            [&](const LocalInjector& localInjector) { return injectorsToRemove.contains(localInjector.injector); }),
+            _activeLocalAudioInjectors.end());
+        _numLocalInjectors.store((int)_activeLocalAudioInjectors.size(), std::memory_order_relaxed);
     }
 
-    // update the flag
-    _localInjectorsAvailable.exchange(!_activeLocalAudioInjectors.empty(), std::memory_order_release);
+    // update the flag, unless an injector was pushed meanwhile
+    if (_activeLocalAudioInjectors.empty() && !_pendingLocalInjectors.load(std::memory_order_acquire)) {
+        _localInjectorsAvailable.store(false, std::memory_order_release);
+        // one pushed between the check and the store is still owed its flag
+        if (_pendingLocalInjectors.load(std::memory_order_acquire)) {
+            _localInjectorsAvailable.store(true, std::memory_order_release);
+        }
+    }
 
     return true;
 }
 
+void AudioClient::takePendingLocalInjectors() {
+    auto pending = _pendingLocalInjectors.exchange(nullptr, std::memory_order_acquire);
+    if (!pending) {
+        return;
+    }
+
+    // the stack is newest first, reverse it so injectors are mixed in the order they were started
+    PendingLocalInjector* ordered = nullptr;
+    while (pending) {
+        auto next = pending->next;
+        pending->next = ordered;
+        ordered = pending;
+        pending = next;
+    }
+
+    while (ordered) {
+        auto next = ordered->next;
+        auto found = std::find_if(_activeLocalAudioInjectors.begin(), _activeLocalAudioInjectors.end(),
+            [&](const LocalInjector& localInjector) { return localInjector.injector == ordered->local.injector; });
+        if (found == _activeLocalAudioInjectors.end()) {
+            //qCDebug(audioclient) << "adding new injector";
+            _activeLocalAudioInjectors.push_back(std::move(ordered->local));
+        } else {
+            qCDebug(audioclient) << "injector exists in active list already";
+        }
+        delete ordered;
+        ordered = next;
+    }
+    _numLocalInjectors.store((int)_activeLocalAudioInjectors.size(), std::memory_order_relaxed);
+}
+
 void AudioClient::processReceivedSamples(const QByteArray& decodedBuffer, QByteArray& outputBuffer) {
 
     const int16_t* decodedSamples = reinterpret_cast<const int16_t*>(decodedBuffer.data());
@@ -1840,18 +1890,19 @@ bool AudioClient::setIsStereoInput(bool isStereoInput) {
 bool AudioClient::outputLocalInjector(const AudioInjectorPointer& injector) {
     auto injectorBuffer = injector->getLocalBuffer();
     if (injectorBuffer) {
-        // local injectors are on the AudioInjectorsThread, so we must guard access
-        Lock lock(_injectorsMutex);
-        if (!_activeLocalAudioInjectors.contains(injector)) {
-            //qCDebug(audioclient) << "adding new injector";
-            _activeLocalAudioInjectors.append(injector);
-
-            // update the flag
-            _localInjectorsAvailable.exchange(true, std::memory_order_release);
-        } else {
-            qCDebug(audioclient) << "injector exists in active list already";
+        // local injectors are started from any thread, they are queued for the mixing thread without taking a lock it
+        // could be waiting on; the options are read here, where waiting on a script that is setting them is fine
+        auto pending = new PendingLocalInjector();
+        pending->local.injector = injector;
+        pending->local.options = injector->getOptions();
+        pending->next = _pendingLocalInjectors.load(std::memory_order_relaxed);
+        while (!_pendingLocalInjectors.compare_exchange_weak(pending->next, pending, std::memory_order_release,
+                                                             std::memory_order_relaxed)) {
         }
 
+        // update the flag
+        _localInjectorsAvailable.store(true, std::memory_order_release);
+
         return true;
 
     } else {
@@ -1861,8 +1912,7 @@ bool AudioClient::outputLocalInjector(const AudioInjectorPointer& injector) {
 }
 
 int AudioClient::getNumLocalInjectors() {
-    Lock lock(_injectorsMutex);
-    return _activeLocalAudioInjectors.size();
+    return _numLocalInjectors.load(std::memory_order_relaxed);
 }
 
 void AudioClient::outputFormatChanged() {
@@ -2127,14 +2177,22 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
     Lock localAudioLock(_localAudioMutex);
 
     // cleanup any previously initialized device
-    if (_audioOutput) {
+    if (_audioOutput || _audioOutputBackend) {
         _audioOutputIODevice.close();
-        _audioOutput->stop();
+        if (_audioOutputBackend) {
+            // returns once the device's thread is done with the mix buffers
+            _audioOutputBackend->stop();
+            _audioOutputBackend.reset();
+        } else {
+            _audioOutput->stop();
+        }
         _audioOutputInitialized = false;
 
-        //must be deleted in next eventloop cycle when its called from notify()
-        _audioOutput->deleteLater();
-        _audioOutput = NULL;
+        if (_audioOutput) {
+            //must be deleted in next eventloop cycle when its called from notify()
+            _audioOutput->deleteLater();
+            _audioOutput = NULL;
+        }
 
         _loopbackOutputDevice = NULL;
         //must be deleted in next eventloop cycle when its called from notify()
@@ -2202,26 +2260,44 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
 
             outputFormatChanged();
 
-            // setup our general output device for audio-mixer audio
-            _audioOutput = new QAudioOutput(_outputDeviceInfo.getDevice(), _outputFormat, this);
-
             int deviceChannelCount = _outputFormat.channelCount();
             int frameSize = (AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * deviceChannelCount * _outputFormat.sampleRate()) / _desiredOutputFormat.sampleRate();
             int requestedSize = _sessionOutputBufferSizeFrames * frameSize * AudioConstants::SAMPLE_SIZE;
-            _audioOutput->setBufferSize(requestedSize * 16);
 
-            connect(_audioOutput, &QAudioOutput::notify, this, &AudioClient::outputNotify);
+            if (_lowLatencyOutputEnabled.get()) {
+                // the backend calls readData itself, without opening the IO device
+                _audioOutputBackend = AudioOutputBackend::create();
+                if (_audioOutputBackend && !_audioOutputBackend->start(_outputDeviceInfo.getDevice().deviceName(), _outputFormat,
+                        [this](int16_t* samples, int frames) { renderOutputBackend(samples, frames); })) {
+                    qCDebug(audioclient) << "Falling back to Qt audio output from" << _audioOutputBackend->getName();
+                    _audioOutputBackend.reset();
+                }
+            }
 
-            // start the output device
-            _audioOutputIODevice.start();
-            _audioOutput->start(&_audioOutputIODevice);
+            if (_audioOutputBackend) {
+                int periodFrames = _audioOutputBackend->getPeriodFrames();
+                // in samples of OUTPUT_CHANNEL_COUNT, doubled in case the device asks for more than a period to catch up
+                _outputPeriod = periodFrames * std::max(deviceChannelCount, OUTPUT_CHANNEL_COUNT) * 2;
+                _stats.setOutputDeviceLatency(_audioOutputBackend->getLatencyMsecs());
+            } else {
+                // setup our general output device for audio-mixer audio
+                _audioOutput = new QAudioOutput(_outputDeviceInfo.getDevice(), _outputFormat, this);
+                _audioOutput->setBufferSize(requestedSize * 16);
 
-            // initialize mix buffers
+                connect(_audioOutput, &QAudioOutput::notify, this, &AudioClient::outputNotify);
 
-            // restrict device callback to _outputPeriod samples
-            _outputPeriod = _audioOutput->periodSize() / AudioConstants::SAMPLE_SIZE;
-            // device callback may exceed reported period, so double it to avoid stutter
-            _outputPeriod *= 2;
+                // start the output device
+                _audioOutputIODevice.start();
+                _audioOutput->start(&_audioOutputIODevice);
+
+                // restrict device callback to _outputPeriod samples
+                _outputPeriod = _audioOutput->periodSize() / AudioConstants::SAMPLE_SIZE;
+                // device callback may exceed reported period, so double it to avoid stutter
+                _outputPeriod *= 2;
+                _stats.setOutputDeviceLatency(_audioOutput->bufferSize() / (float)_outputFormat.bytesForDuration(USECS_PER_MSEC));
+            }
+
+            // initialize mix buffers
 
             _outputMixBuffer = new float[_outputPeriod];
             _outputScratchBuffer = new int16_t[_outputPeriod];
@@ -2240,14 +2316,19 @@ bool AudioClient::switchOutputToAudioDevice(const HifiAudioDeviceInfo outputDevi
 
             _audioOutputInitialized = true;
 
-            int bufferSize = _audioOutput->bufferSize();
-            int bufferSamples = bufferSize / AudioConstants::SAMPLE_SIZE;
-            int bufferFrames = bufferSamples / (float)frameSize;
-            qCDebug(audioclient) << "frame (samples):" << frameSize;
-            qCDebug(audioclient) << "buffer (frames):" << bufferFrames;
-            qCDebug(audioclient) << "buffer (samples):" << bufferSamples;
-            qCDebug(audioclient) << "buffer (bytes):" << bufferSize;
-            qCDebug(audioclient) << "requested (bytes):" << requestedSize;
+            if (_audioOutput) {
+                int bufferSize = _audioOutput->bufferSize();
+                int bufferSamples = bufferSize / AudioConstants::SAMPLE_SIZE;
+                int bufferFrames = bufferSamples / (float)frameSize;
+                qCDebug(audioclient) << "frame (samples):" << frameSize;
+                qCDebug(audioclient) << "buffer (frames):" << bufferFrames;
+                qCDebug(audioclient) << "buffer (samples):" << bufferSamples;
+                qCDebug(audioclient) << "buffer (bytes):" << bufferSize;
+                qCDebug(audioclient) << "requested (bytes):" << requestedSize;
+            } else {
+                qCDebug(audioclient) << "backend:" << _audioOutputBackend->getName();
+                qCDebug(audioclient) << "device latency (ms):" << _audioOutputBackend->getLatencyMsecs();
+            }
             qCDebug(audioclient) << "period (samples):" << _outputPeriod;
             qCDebug(audioclient) << "local buffer (samples):" << localPeriod;
 
@@ -2452,6 +2533,15 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
         _audio->_audioFileWav.addRawAudioChunk(data, bytesWritten);
     }
 
+    if (_audio->_audioOutputBackend) {
+        // the device asks for each period as it needs it, so all that is unplayed is what the device holds itself
+        _audio->_stats.updateOutputMsUnplayed(_audio->_audioOutputBackend->getLatencyMsecs());
+        if (bytesWritten < maxSize) {
+            _unfulfilledReads++;
+        }
+        return bytesWritten;
+    }
+
     int bytesAudioOutputUnplayed = _audio->_audioOutput->bufferSize() - _audio->_audioOutput->bytesFree();
     float msecsAudioOutputUnplayed = bytesAudioOutputUnplayed / (float)_audio->_outputFormat.bytesForDuration(USECS_PER_MSEC);
     _audio->_stats.updateOutputMsUnplayed(msecsAudioOutputUnplayed);
@@ -2463,6 +2553,15 @@ qint64 AudioClient::AudioOutputIODevice::readData(char * data, qint64 maxSize) {
     return bytesWritten;
 }
 
+void AudioClient::renderOutputBackend(int16_t* samples, int frames) {
+    qint64 size = (qint64)frames * _outputFormat.channelCount() * AudioConstants::SAMPLE_SIZE;
+    qint64 bytesWritten = _audioOutputIODevice.readData((char*)samples, size);
+    // the device plays the whole period whether or not the mix could fill it
+    if (bytesWritten < size) {
+        memset((char*)samples + bytesWritten, 0, size - bytesWritten);
+    }
+}
+
 bool AudioClient::startRecording(const QString& filepath) {
     if (!_audioFileWav.create(_outputFormat, filepath)) {
         qDebug() << "Error creating audio file: " + filepath;
@@ -57,6 +57,7 @@
 
 #include "AudioIOStats.h"
 #include "AudioFileWav.h"
+#include "AudioOutputBackend.h"
 #include "HifiAudioDeviceInfo.h"
 
 #if defined(WEBRTC_AUDIO)
@@ -154,6 +155,10 @@ public:
     bool getOutputStarveDetectionEnabled() { return _outputStarveDetectionEnabled.get(); }
     void setOutputStarveDetectionEnabled(bool enabled) { _outputStarveDetectionEnabled.set(enabled); }
 
+    // takes effect the next time an output device is opened
+    bool getLowLatencyOutputEnabled() { return _lowLatencyOutputEnabled.get(); }
+    void setLowLatencyOutputEnabled(bool enabled) { _lowLatencyOutputEnabled.set(enabled); }
+
     bool isSimulatingJitter() { return _gate.isSimulatingJitter(); }
     void setIsSimulatingJitter(bool enable) { _gate.setIsSimulatingJitter(enable); }
 
@@ -334,6 +339,8 @@ private:
     void checkPeakValues();
 
     void outputFormatChanged();
+    // the low-latency backend's callback, which the device plays all of
+    void renderOutputBackend(int16_t* samples, int frames);
     void handleAudioInput(QByteArray& audioBuffer);
     void prepareLocalAudioInjectors(std::unique_ptr<Lock> localAudioLock = nullptr);
     bool mixLocalAudioInjectors(float* mixBuffer);
@@ -372,7 +379,6 @@ private:
 
     Gate _gate{ this };
 
-    Mutex _injectorsMutex;
     QAudioInput* _audioInput{ nullptr };
     QTimer* _dummyAudioInput{ nullptr };
     QAudioFormat _desiredInputFormat;
@@ -380,6 +386,8 @@ private:
     QIODevice* _inputDevice{ nullptr };
     int _numInputCallbackBytes{ 0 };
     QAudioOutput* _audioOutput{ nullptr };
+    // in place of _audioOutput when the low-latency output is on and took the device
+    std::unique_ptr<AudioOutputBackend> _audioOutputBackend;
     std::atomic<bool> _audioOutputInitialized { false };
     QAudioFormat _desiredOutputFormat;
     QAudioFormat _outputFormat;
@@ -403,6 +411,7 @@ private:
     Setting::Handle<int> _outputBufferSizeFrames{"audioOutputBufferFrames", DEFAULT_BUFFER_FRAMES};
     int _sessionOutputBufferSizeFrames{ _outputBufferSizeFrames.get() };
     Setting::Handle<bool> _outputStarveDetectionEnabled{ "audioOutputStarveDetectionEnabled", DEFAULT_STARVE_DETECTION_ENABLED};
+    Setting::Handle<bool> _lowLatencyOutputEnabled{ "audioLowLatencyOutputEnabled", false };
 
     StDev _stdev;
     QElapsedTimer _timeSinceLastReceived;
@@ -515,7 +524,21 @@ private:
 
     bool _hasReceivedFirstPacket { false };
 
-    QVector<AudioInjectorPointer> _activeLocalAudioInjectors;
+    // the injectors being mixed, owned by whichever thread is mixing under _localAudioMutex, with the options each had
+    // when last read, for the frames a script holds them locked
+    struct LocalInjector {
+        AudioInjectorPointer injector;
+        AudioInjectorOptions options;
+    };
+    std::vector<LocalInjector> _activeLocalAudioInjectors;
+    // injectors handed to outputLocalInjector, from any thread, pushed without a lock for the mixing thread to take
+    struct PendingLocalInjector {
+        LocalInjector local;
+        PendingLocalInjector* next { nullptr };
+    };
+    std::atomic<PendingLocalInjector*> _pendingLocalInjectors { nullptr };
+    std::atomic<int> _numLocalInjectors { 0 };
+    void takePendingLocalInjectors();
 
     bool _isPlayingBackRecording { false };
     bool _audioPaused { false };
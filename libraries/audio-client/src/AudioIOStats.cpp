@@ -47,6 +47,7 @@ void AudioIOStats::reset() {
     _packetTimegaps.reset();
 
     _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
+    _interface->outputDeviceLatencyMs(_outputDeviceLatencyMs.load());
     _interface->updateMixerStream(AudioStreamStats());
     _interface->updateClientStream(AudioStreamStats());
     _interface->updateInjectorStreams(QHash<QUuid, AudioStreamStats>());
@@ -110,6 +111,7 @@ void AudioIOStats::publish() {
 
     // update the interface
     _interface->updateLocalBuffers(_inputMsRead, _inputMsUnplayed, _outputMsUnplayed, _packetTimegaps);
+    _interface->outputDeviceLatencyMs(_outputDeviceLatencyMs.load());
     _interface->updateClientStream(stats);
 
     // prepare a packet to the mixer
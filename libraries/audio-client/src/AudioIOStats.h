@@ -14,6 +14,8 @@
 
 #include "MovingMinMaxAvg.h"
 
+#include <atomic>
+
 #include <QObject>
 #include <QtCore/QSharedPointer>
 
@@ -252,6 +254,9 @@ class AudioStatsInterface : public QObject {
      *     <em>Read-only.</em>
      * @property {AudioStats.AudioStreamStats} mixerStream - Statistics of the audio mixer's stream.
      *     <em>Read-only.</em>
+     * @property {number} outputDeviceLatencyMs - The time between audio being handed to the output device and it being 
+     *     heard, as the device reports it, in ms.
+     *     <em>Read-only.</em>
      * @property {number} outputUnplayedMsMax - The maximum duration of output audio recently in the output buffer waiting to 
      *     be played, in ms.
      *     <em>Read-only.</em>
@@ -304,6 +309,15 @@ class AudioStatsInterface : public QObject {
      */
     AUDIO_PROPERTY(float, outputUnplayedMsMax);
 
+    /*@jsdoc
+     * Triggered when the latency of the output device changes, which it does when the device or its backend changes.
+     * @function AudioStats.outputDeviceLatencyMsChanged
+     * @param {number} outputDeviceLatencyMs - The time between audio being handed to the output device and it being heard, in 
+     *     ms.
+     * @returns {Signal} 
+     */
+    AUDIO_PROPERTY(float, outputDeviceLatencyMs);
+
 
     /*@jsdoc
      * Triggered when the overall maximum time between sending data packets to the audio mixer changes.
@@ -401,6 +415,7 @@ public:
     void updateInputMsRead(float ms) const { _inputMsRead.update(ms); }
     void updateInputMsUnplayed(float ms) const { _inputMsUnplayed.update(ms); }
     void updateOutputMsUnplayed(float ms) const { _outputMsUnplayed.update(ms); }
+    void setOutputDeviceLatency(float ms) { _outputDeviceLatencyMs.store(ms); }
     void sentPacket() const;
 
     void publish();
@@ -414,6 +429,7 @@ private:
     mutable MovingMinMaxAvg<float> _inputMsRead;
     mutable MovingMinMaxAvg<float> _inputMsUnplayed;
     mutable MovingMinMaxAvg<float> _outputMsUnplayed;
+    std::atomic<float> _outputDeviceLatencyMs { 0.0f };
 
     mutable quint64 _lastSentPacketTime;
     mutable MovingMinMaxAvg<quint64> _packetTimegaps;
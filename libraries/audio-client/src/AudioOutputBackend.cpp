@@ -0,0 +1,397 @@
+//
+//  AudioOutputBackend.cpp
+//  libraries/audio-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioOutputBackend.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "AudioClientLogging.h"
+
+#if defined(Q_OS_WIN)
+
+#include <Windows.h>
+#include <avrt.h>
+#include <audioclient.h>
+#include <mmdeviceapi.h>
+
+#pragma comment(lib, "avrt.lib")
+
+extern QString getWinDeviceName(IMMDevice* pEndpoint);
+
+static const REFERENCE_TIME REFERENCE_TIMES_PER_SECOND = 10000000;
+static const DWORD WASAPI_EVENT_TIMEOUT_MSECS = 200;
+
+template <typename T>
+static void release(T*& object) {
+    if (object) {
+        object->Release();
+        object = nullptr;
+    }
+}
+
+// WASAPI in exclusive, event driven mode: the device's own buffer is the only one, one period long, and each event asks
+// for all of it
+class WasapiExclusiveOutput : public AudioOutputBackend {
+public:
+    ~WasapiExclusiveOutput() { stop(); }
+
+    const char* getName() const override { return "WASAPI exclusive"; }
+    bool start(const QString& deviceName, const QAudioFormat& format, RenderCallback render) override;
+    void stop() override;
+    int getPeriodFrames() const override { return (int)_bufferFrames; }
+    float getLatencyMsecs() const override { return _latencyMsecs; }
+
+private:
+    IMMDevice* findDevice(IMMDeviceEnumerator* enumerator, const QString& deviceName) const;
+    bool initialize(const WAVEFORMATEX& waveFormat);
+    void run();
+
+    IMMDevice* _device { nullptr };
+    IAudioClient* _client { nullptr };
+    IAudioRenderClient* _renderClient { nullptr };
+    HANDLE _event { nullptr };
+    RenderCallback _render;
+    std::thread _thread;
+    std::atomic<bool> _running { false };
+    bool _comInitialized { false };
+    UINT32 _bufferFrames { 0 };
+    float _latencyMsecs { 0.0f };
+};
+
+IMMDevice* WasapiExclusiveOutput::findDevice(IMMDeviceEnumerator* enumerator, const QString& deviceName) const {
+    IMMDevice* found = nullptr;
+    IMMDeviceCollection* devices = nullptr;
+    if (SUCCEEDED(enumerator->EnumAudioEndpoints(eRender, DEVICE_STATE_ACTIVE, &devices))) {
+        UINT count = 0;
+        devices->GetCount(&count);
+        for (UINT i = 0; i < count && !found; ++i) {
+            IMMDevice* device = nullptr;
+            if (SUCCEEDED(devices->Item(i, &device))) {
+                // Qt's names may be cut short, see getWinDeviceName
+                QString name = getWinDeviceName(device);
+                if (!deviceName.isEmpty() && name.startsWith(deviceName)) {
+                    found = device;
+                } else {
+                    device->Release();
+                }
+            }
+        }
+        devices->Release();
+    }
+    if (!found) {
+        enumerator->GetDefaultAudioEndpoint(eRender, eConsole, &found);
+    }
+    return found;
+}
+
+bool WasapiExclusiveOutput::initialize(const WAVEFORMATEX& waveFormat) {
+    if (FAILED(_device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&_client))) {
+        return false;
+    }
+    if (_client->IsFormatSupported(AUDCLNT_SHAREMODE_EXCLUSIVE, &waveFormat, nullptr) != S_OK) {
+        qCDebug(audioclient) << "WASAPI exclusive mode doesn't support" << waveFormat.nSamplesPerSec << "Hz"
+                             << waveFormat.nChannels << "channel 16-bit output";
+        return false;
+    }
+
+    REFERENCE_TIME defaultPeriod = 0, minimumPeriod = 0;
+    _client->GetDevicePeriod(&defaultPeriod, &minimumPeriod);
+    HRESULT result = _client->Initialize(AUDCLNT_SHAREMODE_EXCLUSIVE, AUDCLNT_STREAMFLAGS_EVENTCALLBACK, minimumPeriod,
+                                         minimumPeriod, &waveFormat, nullptr);
+    if (result == AUDCLNT_E_BUFFER_SIZE_NOT_ALIGNED) {
+        // the device rounds the period to its own alignment, and wants a new client asked for exactly that
+        UINT32 alignedFrames = 0;
+        _client->GetBufferSize(&alignedFrames);
+        release(_client);
+        REFERENCE_TIME alignedPeriod =
+            (REFERENCE_TIME)((double)REFERENCE_TIMES_PER_SECOND * alignedFrames / waveFormat.nSamplesPerSec + 0.5);
+        if (FAILED(_device->Activate(__uuidof(IAudioClient), CLSCTX_ALL, nullptr, (void**)&_client))) {
+            return false;
+        }
+        result = _client->Initialize(AUDCLNT_SHAREMODE_EXCLUSIVE, AUDCLNT_STREAMFLAGS_EVENTCALLBACK, alignedPeriod,
+                                     alignedPeriod, &waveFormat, nullptr);
+    }
+    if (FAILED(result)) {
+        qCDebug(audioclient) << "Unable to open the WASAPI device exclusively, error" << QString::number((uint32_t)result, 16);
+        return false;
+    }
+
+    _client->GetBufferSize(&_bufferFrames);
+    REFERENCE_TIME streamLatency = 0;
+    _client->GetStreamLatency(&streamLatency);
+    _latencyMsecs = (float)streamLatency * 1000.0f / REFERENCE_TIMES_PER_SECOND +
+        (float)_bufferFrames * 1000.0f / waveFormat.nSamplesPerSec;
+
+    _event = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+    return _event && SUCCEEDED(_client->SetEventHandle(_event)) &&
+        SUCCEEDED(_client->GetService(__uuidof(IAudioRenderClient), (void**)&_renderClient));
+}
+
+bool WasapiExclusiveOutput::start(const QString& deviceName, const QAudioFormat& format, RenderCallback render) {
+    stop();
+    if (format.sampleSize() != 16 || format.sampleType() != QAudioFormat::SignedInt) {
+        return false;
+    }
+
+    // for as long as the device is open, on the thread that opened it
+    _comInitialized = SUCCEEDED(CoInitializeEx(nullptr, COINIT_MULTITHREADED));
+    IMMDeviceEnumerator* enumerator = nullptr;
+    if (SUCCEEDED(CoCreateInstance(__uuidof(MMDeviceEnumerator), nullptr, CLSCTX_ALL, __uuidof(IMMDeviceEnumerator),
+                                   (void**)&enumerator))) {
+        _device = findDevice(enumerator, deviceName);
+        enumerator->Release();
+    }
+
+    WAVEFORMATEX waveFormat {};
+    waveFormat.wFormatTag = WAVE_FORMAT_PCM;
+    waveFormat.nChannels = (WORD)format.channelCount();
+    waveFormat.nSamplesPerSec = (DWORD)format.sampleRate();
+    waveFormat.wBitsPerSample = 16;
+    waveFormat.nBlockAlign = waveFormat.nChannels * sizeof(int16_t);
+    waveFormat.nAvgBytesPerSec = waveFormat.nSamplesPerSec * waveFormat.nBlockAlign;
+
+    bool started = _device && initialize(waveFormat);
+    if (started) {
+        // the first event only comes once the buffer has played out, so it starts out silent
+        BYTE* data = nullptr;
+        if (SUCCEEDED(_renderClient->GetBuffer(_bufferFrames, &data))) {
+            _renderClient->ReleaseBuffer(_bufferFrames, AUDCLNT_BUFFERFLAGS_SILENT);
+        }
+        _render = render;
+        _running = true;
+        _thread = std::thread([this] { run(); });
+        started = SUCCEEDED(_client->Start());
+    }
+    if (!started) {
+        stop();
+        return false;
+    }
+
+    qCInfo(audioclient) << "WASAPI exclusive output started:" << _bufferFrames << "frames per period," << _latencyMsecs
+                        << "ms device latency";
+    return true;
+}
+
+void WasapiExclusiveOutput::run() {
+    HRESULT comResult = CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+    DWORD taskIndex = 0;
+    HANDLE task = AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex);
+    if (!task) {
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+    }
+
+    while (_running.load(std::memory_order_acquire)) {
+        if (WaitForSingleObject(_event, WASAPI_EVENT_TIMEOUT_MSECS) != WAIT_OBJECT_0 ||
+            !_running.load(std::memory_order_acquire)) {
+            continue;
+        }
+        BYTE* data = nullptr;
+        if (SUCCEEDED(_renderClient->GetBuffer(_bufferFrames, &data))) {
+            _render((int16_t*)data, (int)_bufferFrames);
+            _renderClient->ReleaseBuffer(_bufferFrames, 0);
+        }
+    }
+
+    if (task) {
+        AvRevertMmThreadCharacteristics(task);
+    }
+    if (SUCCEEDED(comResult)) {
+        CoUninitialize();
+    }
+}
+
+void WasapiExclusiveOutput::stop() {
+    if (_thread.joinable()) {
+        _running = false;
+        SetEvent(_event);
+        _thread.join();
+    }
+    if (_client) {
+        _client->Stop();
+    }
+    release(_renderClient);
+    release(_client);
+    release(_device);
+    if (_event) {
+        CloseHandle(_event);
+        _event = nullptr;
+    }
+    if (_comInitialized) {
+        CoUninitialize();
+        _comInitialized = false;
+    }
+    _render = nullptr;
+}
+
+std::unique_ptr<AudioOutputBackend> AudioOutputBackend::create() {
+    return std::unique_ptr<AudioOutputBackend>(new WasapiExclusiveOutput());
+}
+
+#elif defined(Q_OS_MAC)
+
+#include <CoreAudio/CoreAudio.h>
+
+// the smallest period the HAL gets asked for, in frames, which is about 2.7 ms at 48 kHz
+static const UInt32 COREAUDIO_PERIOD_FRAMES = 128;
+
+template <typename T>
+static bool getProperty(AudioObjectID object, AudioObjectPropertySelector selector, AudioObjectPropertyScope scope, T& value) {
+    AudioObjectPropertyAddress address { selector, scope, kAudioObjectPropertyElementMaster };
+    UInt32 size = sizeof(T);
+    return AudioObjectGetPropertyData(object, &address, 0, nullptr, &size, &value) == noErr;
+}
+
+// A HAL IOProc on the device itself: the HAL calls it on its own realtime thread with the device's float buffers
+class CoreAudioHalOutput : public AudioOutputBackend {
+public:
+    ~CoreAudioHalOutput() { stop(); }
+
+    const char* getName() const override { return "CoreAudio HAL"; }
+    bool start(const QString& deviceName, const QAudioFormat& format, RenderCallback render) override;
+    void stop() override;
+    int getPeriodFrames() const override { return (int)_periodFrames; }
+    float getLatencyMsecs() const override { return _latencyMsecs; }
+
+private:
+    static OSStatus ioProc(AudioObjectID device, const AudioTimeStamp* now, const AudioBufferList* input,
+                           const AudioTimeStamp* inputTime, AudioBufferList* output, const AudioTimeStamp* outputTime,
+                           void* clientData);
+    AudioDeviceID findDevice(const QString& deviceName) const;
+
+    AudioDeviceID _device { kAudioObjectUnknown };
+    AudioDeviceIOProcID _ioProc { nullptr };
+    RenderCallback _render;
+    int _channels { 0 };
+    UInt32 _periodFrames { 0 };
+    std::vector<int16_t> _scratch;
+    float _latencyMsecs { 0.0f };
+};
+
+AudioDeviceID CoreAudioHalOutput::findDevice(const QString& deviceName) const {
+    AudioObjectPropertyAddress address { kAudioHardwarePropertyDevices, kAudioObjectPropertyScopeGlobal,
+                                         kAudioObjectPropertyElementMaster };
+    UInt32 size = 0;
+    if (AudioObjectGetPropertyDataSize(kAudioObjectSystemObject, &address, 0, nullptr, &size) == noErr) {
+        std::vector<AudioDeviceID> devices(size / sizeof(AudioDeviceID));
+        if (AudioObjectGetPropertyData(kAudioObjectSystemObject, &address, 0, nullptr, &size, devices.data()) == noErr) {
+            for (auto device : devices) {
+                CFStringRef name = nullptr;
+                if (getProperty(device, kAudioObjectPropertyName, kAudioObjectPropertyScopeGlobal, name) && name) {
+                    bool matches = QString::fromCFString(name) == deviceName;
+                    CFRelease(name);
+                    if (matches) {
+                        return device;
+                    }
+                }
+            }
+        }
+    }
+    AudioDeviceID device = kAudioObjectUnknown;
+    getProperty(kAudioObjectSystemObject, kAudioHardwarePropertyDefaultOutputDevice, kAudioObjectPropertyScopeGlobal, device);
+    return device;
+}
+
+bool CoreAudioHalOutput::start(const QString& deviceName, const QAudioFormat& format, RenderCallback render) {
+    stop();
+    if (format.sampleSize() != 16 || format.sampleType() != QAudioFormat::SignedInt) {
+        return false;
+    }
+    _device = findDevice(deviceName);
+    if (_device == kAudioObjectUnknown) {
+        return false;
+    }
+
+    // the HAL doesn't resample, AudioClient's resamplers do
+    Float64 sampleRate = 0.0;
+    getProperty(_device, kAudioDevicePropertyNominalSampleRate, kAudioObjectPropertyScopeGlobal, sampleRate);
+    if ((int)sampleRate != format.sampleRate()) {
+        qCDebug(audioclient) << "The CoreAudio device runs at" << sampleRate << "Hz, not" << format.sampleRate();
+        return false;
+    }
+
+    AudioValueRange periodRange { 0.0, 0.0 };
+    getProperty(_device, kAudioDevicePropertyBufferFrameSizeRange, kAudioObjectPropertyScopeGlobal, periodRange);
+    UInt32 periodFrames = std::max(COREAUDIO_PERIOD_FRAMES, (UInt32)periodRange.mMinimum);
+    AudioObjectPropertyAddress periodAddress { kAudioDevicePropertyBufferFrameSize, kAudioObjectPropertyScopeGlobal,
+                                               kAudioObjectPropertyElementMaster };
+    AudioObjectSetPropertyData(_device, &periodAddress, 0, nullptr, sizeof(periodFrames), &periodFrames);
+    getProperty(_device, kAudioDevicePropertyBufferFrameSize, kAudioObjectPropertyScopeGlobal, _periodFrames);
+
+    UInt32 deviceLatency = 0, safetyOffset = 0;
+    getProperty(_device, kAudioDevicePropertyLatency, kAudioObjectPropertyScopeOutput, deviceLatency);
+    getProperty(_device, kAudioDevicePropertySafetyOffset, kAudioObjectPropertyScopeOutput, safetyOffset);
+    _latencyMsecs = (float)(deviceLatency + safetyOffset + _periodFrames) * 1000.0f / (float)sampleRate;
+
+    _channels = format.channelCount();
+    // the HAL may ask for more than a period when it catches up
+    _scratch.resize(_periodFrames * 2 * _channels);
+    _render = render;
+    if (AudioDeviceCreateIOProcID(_device, &CoreAudioHalOutput::ioProc, this, &_ioProc) != noErr ||
+        AudioDeviceStart(_device, _ioProc) != noErr) {
+        stop();
+        return false;
+    }
+
+    qCInfo(audioclient) << "CoreAudio HAL output started:" << _periodFrames << "frames per period," << _latencyMsecs
+                        << "ms device latency";
+    return true;
+}
+
+OSStatus CoreAudioHalOutput::ioProc(AudioObjectID device, const AudioTimeStamp* now, const AudioBufferList* input,
+                                    const AudioTimeStamp* inputTime, AudioBufferList* output,
+                                    const AudioTimeStamp* outputTime, void* clientData) {
+    auto self = (CoreAudioHalOutput*)clientData;
+    if (!output || output->mNumberBuffers == 0) {
+        return noErr;
+    }
+
+    // the device's first stream, interleaved floats, takes our channels and silence in any beyond them
+    AudioBuffer& buffer = output->mBuffers[0];
+    int deviceChannels = (int)buffer.mNumberChannels;
+    int frames = (int)(buffer.mDataByteSize / (sizeof(float) * deviceChannels));
+    frames = std::min(frames, (int)self->_scratch.size() / self->_channels);
+    self->_render(self->_scratch.data(), frames);
+
+    auto samples = (float*)buffer.mData;
+    int channels = std::min(deviceChannels, self->_channels);
+    for (int frame = 0; frame < frames; ++frame) {
+        for (int channel = 0; channel < deviceChannels; ++channel) {
+            samples[frame * deviceChannels + channel] =
+                channel < channels ? self->_scratch[frame * self->_channels + channel] * (1.0f / 32768.0f) : 0.0f;
+        }
+    }
+    return noErr;
+}
+
+void CoreAudioHalOutput::stop() {
+    if (_ioProc) {
+        AudioDeviceStop(_device, _ioProc);
+        AudioDeviceDestroyIOProcID(_device, _ioProc);
+        _ioProc = nullptr;
+    }
+    _device = kAudioObjectUnknown;
+    _render = nullptr;
+}
+
+std::unique_ptr<AudioOutputBackend> AudioOutputBackend::create() {
+    return std::unique_ptr<AudioOutputBackend>(new CoreAudioHalOutput());
+}
+
+#else
+
+std::unique_ptr<AudioOutputBackend> AudioOutputBackend::create() {
+    return nullptr;
+}
+
+#endif
@@ -0,0 +1,47 @@
+//
+//  AudioOutputBackend.h
+//  libraries/audio-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioOutputBackend_h
+#define hifi_AudioOutputBackend_h
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+#include <QtCore/QString>
+#include <QtMultimedia/QAudioFormat>
+
+// An audio output that talks to the platform's audio API directly instead of through QAudioOutput: the device calls back
+// for each period as it needs it, on a thread of the backend's own running at realtime priority, so that nothing but the
+// device's own buffer sits between the mix and the speakers.
+class AudioOutputBackend {
+public:
+    // fills frames frames of interleaved 16-bit samples in the format the backend was started with
+    using RenderCallback = std::function<void(int16_t* samples, int frames)>;
+
+    // the low-latency backend of this platform, or nullptr where there is none
+    static std::unique_ptr<AudioOutputBackend> create();
+
+    virtual ~AudioOutputBackend() {}
+
+    virtual const char* getName() const = 0;
+
+    // opens the device called deviceName, or the default output when there is no such device, and starts rendering;
+    // false when the device won't play format as it is, which leaves the caller to the Qt output and its resamplers
+    virtual bool start(const QString& deviceName, const QAudioFormat& format, RenderCallback render) = 0;
+    virtual void stop() = 0;
+
+    virtual int getPeriodFrames() const = 0;
+    // what the device reports between a sample being rendered and it being heard, its buffer included
+    virtual float getLatencyMsecs() const = 0;
+};
+
+#endif // hifi_AudioOutputBackend_h
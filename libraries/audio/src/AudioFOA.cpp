@@ -831,7 +831,7 @@ static void rifft512_ref(float buf[512]) {
 
 // fft-domain complex multiply-add, for packed complex-conjugate symmetric
 // 1 channel input, 2 channel output
-static void rfft512_cmadd_1X2_ref(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]) {
+void rfft512_cmadd_1X2_ref(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]) {
 
     // NOTE: x[n/2].re is packed into x[0].im
     dst0[0] += src[0] * coef0[0];   // first bin is real
@@ -852,7 +852,7 @@ static void rfft512_cmadd_1X2_ref(const float src[512], const float coef0[512],
 #ifdef FOA_INPUT_FUMA   // input is FuMa (B-format) channel order and normalization
 
 // convert to deinterleaved float (B-format)
-static void convertInput_ref(int16_t* src, float *dst[4], float gain, int numFrames) {
+void convertInput_ref(int16_t* src, float *dst[4], float gain, int numFrames) {
 
     const float scale = gain * (1/32768.0f);
 
@@ -867,7 +867,7 @@ static void convertInput_ref(int16_t* src, float *dst[4], float gain, int numFra
 #else   // input is ambiX (ACN/SN3D) channel order and normalization
 
 // convert to deinterleaved float (B-format)
-static void convertInput_ref(int16_t* src, float *dst[4], float gain, int numFrames) {
+void convertInput_ref(int16_t* src, float *dst[4], float gain, int numFrames) {
 
     const float scaleW = gain * (1/32768.0f) * SQRT1_2; // -3dB
     const float scale = gain * (1/32768.0f);
@@ -884,7 +884,7 @@ static void convertInput_ref(int16_t* src, float *dst[4], float gain, int numFra
 
 // in-place rotation and scaling of the soundfield
 // crossfade between old and new matrix, to prevent artifacts
-static void rotate_4x4_ref(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames) {
+void rotate_4x4_ref(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames) {
 
     // matrix difference
     const float md[4][4] = { 
@@ -966,6 +966,19 @@ static void rotate_4x4(float* buf[4], const float m0[4][4], const float m1[4][4]
     (*f)(buf, m0, m1, win, numFrames);  // dispatch
 }
 
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+void rfft512_cmadd_1X2_NEON(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]);
+void convertInput_NEON(int16_t* src, float *dst[4], float gain, int numFrames);
+void rotate_4x4_NEON(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames);
+
+// FFT passes use the reference code
+static auto& rfft512 = rfft512_ref;
+static auto& rifft512 = rifft512_ref;
+static auto& rfft512_cmadd_1X2 = rfft512_cmadd_1X2_NEON;
+static auto& convertInput = convertInput_NEON;
+static auto& rotate_4x4 = rotate_4x4_NEON;
+
 #else   // portable reference code
 
 static auto& rfft512 = rfft512_ref;
@@ -1065,16 +1078,44 @@ void AudioFOA::render(int16_t* input, float* output, int index, float qw, float
     assert(index < FOA_TABLES);
     assert(numFrames == FOA_BLOCK);
 
-    ALIGN32 float fftBuffer[FOA_NFFT];          // in-place FFT buffer
-    ALIGN32 float accBuffer[2][FOA_NFFT] = {};  // binaural accumulation buffers
     ALIGN32 float inBuffer[4][FOA_BLOCK];       // deinterleaved input buffers
 
     float* in[4] = { inBuffer[0], inBuffer[1], inBuffer[2], inBuffer[3] };
-    float rotation[4][4];
 
     // convert input to deinterleaved float
     convertInput(input, in, FOA_GAIN, FOA_BLOCK);
 
+    renderBFormat(in, output, index, qw, qx, qy, qz, gain);
+}
+
+// B-format to binaural render
+void AudioFOA::render(const float* const input[4], float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames) {
+
+    assert(index >= 0);
+    assert(index < FOA_TABLES);
+    assert(numFrames == FOA_BLOCK);
+
+    ALIGN32 float inBuffer[4][FOA_BLOCK];       // deinterleaved input buffers
+
+    float* in[4] = { inBuffer[0], inBuffer[1], inBuffer[2], inBuffer[3] };
+
+    // copy, since the soundfield is rotated in-place
+    for (int n = 0; n < 4; n++) {
+        for (int i = 0; i < FOA_BLOCK; i++) {
+            in[n][i] = input[n][i] * FOA_GAIN;
+        }
+    }
+
+    renderBFormat(in, output, index, qw, qx, qy, qz, gain);
+}
+
+void AudioFOA::renderBFormat(float* in[4], float* output, int index, float qw, float qx, float qy, float qz, float gain) {
+
+    ALIGN32 float fftBuffer[FOA_NFFT];          // in-place FFT buffer
+    ALIGN32 float accBuffer[2][FOA_NFFT] = {};  // binaural accumulation buffers
+
+    float rotation[4][4];
+
     // convert quaternion to 4x4 rotation
     quatToMatrix_4x4(qw, qx, qy, qz, rotation);
 
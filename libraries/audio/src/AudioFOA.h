@@ -40,7 +40,17 @@ public:
     //
     void render(int16_t* input, float* output, int index, float qw, float qx, float qy, float qz, float gain, int numFrames);
 
+    //
+    // input: deinterleaved B-format source in FuMa normalization (W at -3dB), ordered W, X, Y, Z
+    //        where X is front, Y is left and Z is up, full scale is 1.0f
+    // all other arguments are the same as above
+    //
+    void render(const float* const input[4], float* output, int index, float qw, float qx, float qy, float qz, float gain,
+                int numFrames);
+
 private:
+    void renderBFormat(float* in[4], float* output, int index, float qw, float qx, float qy, float qz, float gain);
+
     AudioFOA(const AudioFOA&) = delete;
     AudioFOA& operator=(const AudioFOA&) = delete;
 
@@ -420,7 +420,7 @@ static void interpolate(const float* src0, const float* src1, float* dst, float
 #else   // portable reference code
 
 // 1 channel input, 4 channel output
-static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+void FIR_1x4_ref(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
 
     float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
     float* coef1 = coef[1] + HRTF_TAPS - 1;
@@ -485,7 +485,7 @@ static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* ds
 }
 
 // 4 channel planar to interleaved
-static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
+void interleave_4x4_ref(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
     for (int i = 0; i < numFrames; i++) {
 
@@ -498,7 +498,7 @@ static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, f
 
 // process 2 cascaded biquads on 4 channels (interleaved)
 // biquads are computed in parallel, by adding one sample of delay
-static void biquad2_4x4(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames) {
+void biquad2_4x4_ref(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames) {
 
     // restore state
     float y00 = state[0][0];
@@ -667,7 +667,7 @@ static void biquad2_4x4(float* src, float* dst, float coef[5][8], float state[3]
 }
 
 // crossfade 4 inputs into 2 outputs with accumulation (interleaved)
-static void crossfade_4x2(float* src, float* dst, const float* win, int numFrames) {
+void crossfade_4x2_ref(float* src, float* dst, const float* win, int numFrames) {
 
     for (int i = 0; i < numFrames; i++) {
 
@@ -679,7 +679,7 @@ static void crossfade_4x2(float* src, float* dst, const float* win, int numFrame
 }
 
 // linear interpolation with gain
-static void interpolate(const float* src0, const float* src1, float* dst, float frac, float gain) {
+void interpolate_ref(const float* src0, const float* src1, float* dst, float frac, float gain) {
 
     float f0 = gain * (1.0f - frac);
     float f1 = gain * frac;
@@ -689,6 +689,33 @@ static void interpolate(const float* src0, const float* src1, float* dst, float
     }
 }
 
+//
+// on ARM architecture, NEON is used when present
+//
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+void FIR_1x4_NEON(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void interleave_4x4_NEON(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames);
+void biquad2_4x4_NEON(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames);
+void crossfade_4x2_NEON(float* src, float* dst, const float* win, int numFrames);
+void interpolate_NEON(const float* src0, const float* src1, float* dst, float frac, float gain);
+
+static auto& FIR_1x4 = FIR_1x4_NEON;
+static auto& interleave_4x4 = interleave_4x4_NEON;
+static auto& biquad2_4x4 = biquad2_4x4_NEON;
+static auto& crossfade_4x2 = crossfade_4x2_NEON;
+static auto& interpolate = interpolate_NEON;
+
+#else
+
+static auto& FIR_1x4 = FIR_1x4_ref;
+static auto& interleave_4x4 = interleave_4x4_ref;
+static auto& biquad2_4x4 = biquad2_4x4_ref;
+static auto& crossfade_4x2 = crossfade_4x2_ref;
+static auto& interpolate = interpolate_ref;
+
+#endif
+
 #endif
 
 // apply gain crossfade with accumulation (interleaved)
@@ -1089,12 +1116,26 @@ void AudioHRTF::render(int16_t* input, float* output, int index, float azimuth,
         _lpfState = lpf;
     }
 
-    // to avoid polluting the cache, old filters are recomputed instead of stored
-    setFilters(firCoef, bqCoef, delay, index, _azimuthState, _distanceState, _gainState, _lpfState, L0);
-
     // compute new filters
     setFilters(firCoef, bqCoef, delay, index, azimuth, distance, gain, lpf, L1);
 
+    if (azimuth == _azimuthState && distance == _distanceState && gain == _gainState && lpf == _lpfState) {
+        // a source that has not moved has identical old and new filters, so interpolate them only once
+        memcpy(firCoef[L0], firCoef[L1], HRTF_TAPS * sizeof(float));
+        memcpy(firCoef[R0], firCoef[R1], HRTF_TAPS * sizeof(float));
+        for (int i = 0; i < 5; i++) {
+            bqCoef[i][L0] = bqCoef[i][L1];
+            bqCoef[i][R0] = bqCoef[i][R1];
+            bqCoef[i][L2] = bqCoef[i][L3];
+            bqCoef[i][R2] = bqCoef[i][R3];
+        }
+        delay[L0] = delay[L1];
+        delay[R0] = delay[R1];
+    } else {
+        // to avoid polluting the cache, old filters are recomputed instead of stored
+        setFilters(firCoef, bqCoef, delay, index, _azimuthState, _distanceState, _gainState, _lpfState, L0);
+    }
+
     // new parameters become old
     _azimuthState = azimuth;
     _distanceState = distance;
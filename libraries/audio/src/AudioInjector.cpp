@@ -41,7 +41,9 @@ AudioInjectorState& operator|= (AudioInjectorState& lhs, AudioInjectorState rhs)
 
 AudioInjector::AudioInjector(SharedSoundPointer sound, const AudioInjectorOptions& injectorOptions) :
     _sound(sound),
-    _audioData(sound->getAudioData()),
+    // a streamed sound is decoded as it's injected, rather than whole by asking for its audio data
+    _audioData(sound->isStreamed() ? AudioDataPointer() : sound->getAudioData()),
+    _soundSource(sound->getSource()),
     _options(injectorOptions)
 {
 }
@@ -54,6 +56,13 @@ AudioInjector::AudioInjector(AudioDataPointer audioData, const AudioInjectorOpti
 
 AudioInjector::~AudioInjector() {}
 
+uint32_t AudioInjector::getNumBytes() const {
+    if (_soundSource) {
+        return _soundSource->getNumBytes();
+    }
+    return _audioData ? _audioData->getNumBytes() : 0;
+}
+
 bool AudioInjector::stateHas(AudioInjectorState state) const {
     return resultWithReadLock<bool>([&] {
         return (_state & state) == state;
@@ -163,9 +172,10 @@ bool AudioInjector::inject(bool(AudioInjectorManager::*injection)(const AudioInj
 bool AudioInjector::injectLocally() {
     bool success = false;
     if (_localAudioInterface) {
-        if (_audioData->getNumBytes() > 0) {
+        if (getNumBytes() > 0) {
 
-            _localBuffer = QSharedPointer<AudioInjectorLocalBuffer>(new AudioInjectorLocalBuffer(_audioData), &AudioInjectorLocalBuffer::deleteLater);
+            auto localBuffer = _soundSource ? new AudioInjectorLocalBuffer(_soundSource) : new AudioInjectorLocalBuffer(_audioData);
+            _localBuffer = QSharedPointer<AudioInjectorLocalBuffer>(localBuffer, &AudioInjectorLocalBuffer::deleteLater);
             _localBuffer->moveToThread(thread());
 
             _localBuffer->open(QIODevice::ReadOnly);
@@ -225,12 +235,12 @@ int64_t AudioInjector::injectNextFrame() {
 
     if (!_currentPacket) {
         if (_currentSendOffset < 0 ||
-            _currentSendOffset >= (int)_audioData->getNumBytes()) {
+            _currentSendOffset >= (int)getNumBytes()) {
             _currentSendOffset = 0;
         }
 
         // make sure we actually have samples downloaded to inject
-        if (_audioData && _audioData->getNumSamples() > 0) {
+        if (getNumBytes() > 0) {
             _outgoingSequenceNumber = 0;
             _nextFrame = 0;
 
@@ -331,13 +341,12 @@ int64_t AudioInjector::injectNextFrame() {
     QByteArray decodedAudio;
 
     int totalBytesLeftToCopy = (options.stereo ? 2 : 1) * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL;
-    if (!options.loop) {
+    if (!options.loop && !_soundSource) {
         // If we aren't looping, let's make sure we don't read past the end
         int bytesLeftToRead = _audioData->getNumBytes() - _currentSendOffset;
         totalBytesLeftToCopy = std::min(totalBytesLeftToCopy, bytesLeftToRead);
     }
 
-    auto samples = _audioData->data();
     auto currentSample = _currentSendOffset / AudioConstants::SAMPLE_SIZE;
     auto samplesLeftToCopy = totalBytesLeftToCopy / AudioConstants::SAMPLE_SIZE;
 
@@ -345,19 +354,30 @@ int64_t AudioInjector::injectNextFrame() {
     decodedAudio.resize(totalBytesLeftToCopy);
     auto samplesOut = reinterpret_cast<AudioSample*>(decodedAudio.data());
 
+    if (_soundSource) {
+        // the stream ends where the sound does, which also moves _currentSendOffset on
+        samplesLeftToCopy = readNetworkStream(samplesOut, samplesLeftToCopy, options.loop);
+        decodedAudio.resize(samplesLeftToCopy * AudioConstants::SAMPLE_SIZE);
+    }
+
     //  Copy and Measure the loudness of this frame
     withWriteLock([&] {
         _loudness = 0.0f;
         for (int i = 0; i < samplesLeftToCopy; ++i) {
-            auto index = (currentSample + i) % _audioData->getNumSamples();
-            auto sample = samples[index];
-            samplesOut[i] = sample;
-            _loudness += abs(sample) / (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
+            if (!_soundSource) {
+                auto index = (currentSample + i) % _audioData->getNumSamples();
+                samplesOut[i] = _audioData->data()[index];
+            }
+            _loudness += abs(samplesOut[i]) / (AudioConstants::MAX_SAMPLE_VALUE / 2.0f);
+        }
+        if (samplesLeftToCopy > 0) {
+            _loudness /= (float)samplesLeftToCopy;
         }
-        _loudness /= (float)samplesLeftToCopy;
     });
-    _currentSendOffset = (_currentSendOffset + totalBytesLeftToCopy) %
-                         _audioData->getNumBytes();
+    if (!_soundSource) {
+        _currentSendOffset = (_currentSendOffset + totalBytesLeftToCopy) %
+                             _audioData->getNumBytes();
+    }
 
     // FIXME -- good place to call codec encode here. We need to figure out how to tell the AudioInjector which
     // codec to use... possible through AbstractAudioInterface.
@@ -397,7 +417,7 @@ int64_t AudioInjector::injectNextFrame() {
         // If we are falling behind by more frames than our threshold, let's skip the frames ahead
         qCDebug(audio)  << this << "injectNextFrame() skipping ahead, fell behind by " << (currentFrameBasedOnElapsedTime - _nextFrame) << " frames";
         _nextFrame = currentFrameBasedOnElapsedTime;
-        _currentSendOffset = _nextFrame * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * (options.stereo ? 2 : 1) % _audioData->getNumBytes();
+        _currentSendOffset = _nextFrame * AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL * (options.stereo ? 2 : 1) % getNumBytes();
     }
 
     int64_t playNextFrameAt = ++_nextFrame * AudioConstants::NETWORK_FRAME_USECS;
@@ -406,6 +426,40 @@ int64_t AudioInjector::injectNextFrame() {
 }
 
 
+int AudioInjector::readNetworkStream(AudioConstants::AudioSample* samples, int numSamples, bool loop) {
+    const int numChannels = _soundSource->getNumChannels();
+    const int frameBytes = numChannels * AudioConstants::SAMPLE_SIZE;
+
+    // the offset is moved from elsewhere on a restart or a skip ahead, which the stream catches up with
+    if (!_networkStream || _currentSendOffset != _networkStreamOffset) {
+        if (!_networkStream) {
+            _networkStream.reset(new SoundStream(_soundSource));
+        } else {
+            _networkStream->rewind();
+        }
+        _networkStream->skip(_currentSendOffset / frameBytes);
+    }
+
+    int numFrames = numSamples / numChannels;
+    int framesRead = _networkStream->read(samples, numFrames);
+    int offset = _currentSendOffset + framesRead * frameBytes;
+    if (framesRead < numFrames && loop) {
+        _networkStream->rewind();
+        int framesFromStart = _networkStream->read(samples + framesRead * numChannels, numFrames - framesRead);
+        framesRead += framesFromStart;
+        offset = framesFromStart * frameBytes;
+    }
+
+    if (_networkStream->atEnd()) {
+        // as with a whole sound, an offset back at the start is how the caller knows the sound has been sent
+        _networkStream->rewind();
+        offset = 0;
+    }
+    _currentSendOffset = _networkStreamOffset = offset;
+
+    return framesRead * numChannels;
+}
+
 void AudioInjector::sendStopInjectorPacket() {
     auto nodeList = DependencyManager::get<NodeList>();
     if (auto audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer)) {
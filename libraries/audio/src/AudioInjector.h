@@ -79,6 +79,8 @@ public:
     bool isAmbisonic() const { return resultWithReadLock<bool>([&] { return _options.ambisonic; }); }
 
     AudioInjectorOptions getOptions() const { return resultWithReadLock<AudioInjectorOptions>([&] { return _options; }); }
+    // copies the options only when no script is setting them, for the audio thread that can't wait on one that is
+    bool tryGetOptions(AudioInjectorOptions& options) const { return withTryReadLock([&] { options = _options; }); }
     void setOptions(const AudioInjectorOptions& options);
 
     bool stateHas(AudioInjectorState state) const ;
@@ -98,6 +100,8 @@ signals:
 
 private:
     int64_t injectNextFrame();
+    uint32_t getNumBytes() const;
+    int readNetworkStream(AudioConstants::AudioSample* samples, int numSamples, bool loop);
     bool inject(bool(AudioInjectorManager::*injection)(const AudioInjectorPointer&));
     bool injectLocally();
     void sendStopInjectorPacket();
@@ -106,6 +110,10 @@ private:
 
     const SharedSoundPointer _sound;
     AudioDataPointer _audioData;
+    // in place of _audioData for a streamed sound, with the stream the network injection reads from
+    SoundSourcePointer _soundSource;
+    std::unique_ptr<SoundStream> _networkStream;
+    int _networkStreamOffset { 0 };
     AudioInjectorOptions _options;
     AudioInjectorState _state { AudioInjectorState::NotFinished };
     bool _hasSentFirstFrame { false };
@@ -11,11 +11,64 @@
 
 #include "AudioInjectorLocalBuffer.h"
 
+#include <algorithm>
+
+#include <QtCore/QThreadPool>
+
+// about a third of a second of a streamed sound is decoded ahead, refilled once half of it has been read
+static const int READ_AHEAD_NETWORK_FRAMES = 32;
+// the most decoded in one go, so a full ring's sound can be seen by the reader before the whole ring is refilled
+static const int REFILL_BLOCK_FRAMES = 4 * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL;
+
 AudioInjectorLocalBuffer::AudioInjectorLocalBuffer(AudioDataPointer audioData) :
     _audioData(audioData)
 {
 }
 
+AudioInjectorLocalBuffer::AudioInjectorLocalBuffer(SoundSourcePointer source) :
+    _stream(std::make_shared<StreamBuffer>(std::move(source)))
+{
+    // the first of the sound is decoded here, on the thread starting the injector
+    _stream->refill();
+}
+
+AudioInjectorLocalBuffer::StreamBuffer::StreamBuffer(SoundSourcePointer source) :
+    stream(source),
+    ring(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL * source->getNumChannels(), READ_AHEAD_NETWORK_FRAMES),
+    scratch(REFILL_BLOCK_FRAMES * source->getNumChannels())
+{
+}
+
+void AudioInjectorLocalBuffer::StreamBuffer::refill() {
+    const int numChannels = stream.getSource()->getNumChannels();
+    while (!hasEnded.load(std::memory_order_relaxed)) {
+        int samplesFree = ring.getSampleCapacity() - samplesAvailable.load(std::memory_order_acquire);
+        int numFrames = std::min(samplesFree / numChannels, REFILL_BLOCK_FRAMES);
+        if (numFrames <= 0) {
+            break;
+        }
+
+        int framesRead = stream.read(scratch.data(), numFrames);
+        bool ended = false;
+        if (framesRead < numFrames) {
+            if (shouldLoop.load(std::memory_order_relaxed)) {
+                stream.rewind();
+                framesRead += stream.read(scratch.data() + framesRead * numChannels, numFrames - framesRead);
+            } else {
+                ended = true;
+            }
+        }
+
+        ring.writeSamples(scratch.data(), framesRead * numChannels);
+        samplesAvailable.fetch_add(framesRead * numChannels, std::memory_order_release);
+        // only once the last of it is in the ring, for the reader not to end before playing it
+        if (ended) {
+            hasEnded.store(true, std::memory_order_release);
+        }
+    }
+    isRefilling.store(false, std::memory_order_release);
+}
+
 AudioInjectorLocalBuffer::~AudioInjectorLocalBuffer() {
     stop();
 }
@@ -34,7 +87,38 @@ bool AudioInjectorLocalBuffer::seek(qint64 pos) {
     }
 }
 
+void AudioInjectorLocalBuffer::setShouldLoop(bool shouldLoop) {
+    _shouldLoop = shouldLoop;
+    if (_stream) {
+        _stream->shouldLoop.store(shouldLoop, std::memory_order_relaxed);
+        // a sound that reached its end in the first fill has more to play now
+        if (shouldLoop && _stream->hasEnded.load(std::memory_order_acquire) && !_stream->isRefilling.exchange(true)) {
+            _stream->hasEnded.store(false, std::memory_order_relaxed);
+            _stream->stream.rewind();
+            _stream->refill();
+        }
+    }
+}
+
+void AudioInjectorLocalBuffer::setCurrentOffset(int currentOffset) {
+    if (_stream && currentOffset != _currentOffset) {
+        // only called before the injector is handed to the audio thread, when the ring is this thread's alone
+        const int frameBytes = _stream->stream.getSource()->getNumChannels() * AudioConstants::SAMPLE_SIZE;
+        _stream->ring.reset();
+        _stream->samplesAvailable.store(0, std::memory_order_relaxed);
+        _stream->hasEnded.store(false, std::memory_order_relaxed);
+        _stream->stream.rewind();
+        _stream->stream.skip(currentOffset / frameBytes);
+        _stream->refill();
+    }
+    _currentOffset = currentOffset;
+}
+
 qint64 AudioInjectorLocalBuffer::readData(char* data, qint64 maxSize) {
+    if (!_isStopped && _stream) {
+        return readStreamData(data, maxSize);
+    }
+
     if (!_isStopped && _audioData) {
         
         // first copy to the end of the raw audio
@@ -65,6 +149,38 @@ qint64 AudioInjectorLocalBuffer::readData(char* data, qint64 maxSize) {
     }
 }
 
+qint64 AudioInjectorLocalBuffer::readStreamData(char* data, qint64 maxSize) {
+    int samplesWanted = (int)(maxSize / AudioConstants::SAMPLE_SIZE);
+    int samplesAvailable = _stream->samplesAvailable.load(std::memory_order_acquire);
+    int samplesRead = _stream->ring.readSamples((AudioConstants::AudioSample*)data, std::min(samplesWanted, samplesAvailable));
+    _stream->samplesAvailable.fetch_sub(samplesRead, std::memory_order_release);
+    samplesAvailable -= samplesRead;
+
+    int numBytes = (int)_stream->stream.getSource()->getNumBytes();
+    _currentOffset = numBytes > 0 ? (_currentOffset + samplesRead * AudioConstants::SAMPLE_SIZE) % numBytes : 0;
+
+    if (samplesRead < samplesWanted) {
+        if (_stream->hasEnded.load(std::memory_order_acquire) &&
+            _stream->samplesAvailable.load(std::memory_order_acquire) == 0) {
+            // all played, what was read is the last of it
+            return samplesRead * AudioConstants::SAMPLE_SIZE;
+        }
+        // the refill fell behind: play silence rather than end the injector
+        memset(data + samplesRead * AudioConstants::SAMPLE_SIZE, 0, (samplesWanted - samplesRead) * AudioConstants::SAMPLE_SIZE);
+        samplesRead = samplesWanted;
+    }
+
+    if (samplesAvailable < _stream->ring.getSampleCapacity() / 2 && !_stream->hasEnded.load(std::memory_order_relaxed) &&
+        !_stream->isRefilling.exchange(true, std::memory_order_acq_rel)) {
+        auto stream = _stream;
+        QThreadPool::globalInstance()->start([stream] {
+            stream->refill();
+        });
+    }
+
+    return samplesRead * AudioConstants::SAMPLE_SIZE;
+}
+
 qint64 AudioInjectorLocalBuffer::recursiveReadFromFront(char* data, qint64 maxSize) {
     // see how much we can get in this pass
     int bytesRead = maxSize;
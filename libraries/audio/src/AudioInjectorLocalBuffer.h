@@ -12,16 +12,23 @@
 #ifndef hifi_AudioInjectorLocalBuffer_h
 #define hifi_AudioInjectorLocalBuffer_h
 
+#include <atomic>
+#include <memory>
+
 #include <QtCore/qiodevice.h>
 
 #include <glm/common.hpp>
 
+#include "AudioRingBuffer.h"
 #include "Sound.h"
+#include "SoundStream.h"
 
 class AudioInjectorLocalBuffer : public QIODevice {
     Q_OBJECT
 public:
     AudioInjectorLocalBuffer(AudioDataPointer audioData);
+    // plays a streamed sound from a ring decoded ahead on the thread pool, so the audio thread reading it never decodes
+    AudioInjectorLocalBuffer(SoundSourcePointer source);
     ~AudioInjectorLocalBuffer();
 
     void stop();
@@ -31,13 +38,33 @@ public:
     qint64 readData(char* data, qint64 maxSize) override;
     qint64 writeData(const char* data, qint64 maxSize) override { return 0; }
 
-    void setShouldLoop(bool shouldLoop) { _shouldLoop = shouldLoop; }
-    void setCurrentOffset(int currentOffset) { _currentOffset = currentOffset; }
+    void setShouldLoop(bool shouldLoop);
+    void setCurrentOffset(int currentOffset);
 
 private:
     qint64 recursiveReadFromFront(char* data, qint64 maxSize);
 
+    // the read-ahead of a streamed sound, shared with the refill running on the thread pool, which can outlive the
+    // buffer. The ring has a single producer, the refill, and a single consumer, the reader, which track the samples in
+    // it through samplesAvailable.
+    struct StreamBuffer {
+        StreamBuffer(SoundSourcePointer source);
+
+        // decodes until the ring is full or the sound has ended
+        void refill();
+
+        SoundStream stream;
+        AudioRingBuffer ring;
+        std::vector<AudioConstants::AudioSample> scratch;
+        std::atomic<int> samplesAvailable { 0 };
+        std::atomic<bool> isRefilling { false };
+        std::atomic<bool> shouldLoop { false };
+        std::atomic<bool> hasEnded { false };
+    };
+    qint64 readStreamData(char* data, qint64 maxSize);
+
     AudioDataPointer _audioData;
+    std::shared_ptr<StreamBuffer> _stream;
     bool _shouldLoop { false };
     bool _isStopped { false };
     int _currentOffset { 0 };
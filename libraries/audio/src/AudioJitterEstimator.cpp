@@ -0,0 +1,59 @@
+//
+//  AudioJitterEstimator.cpp
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioJitterEstimator.h"
+
+#include <algorithm>
+#include <string.h>
+
+#include "AudioConstants.h"
+
+const float AudioJitterEstimator::FORGET_FACTOR = 0.9996f;
+
+void AudioJitterEstimator::reset() {
+    memset(_histogram, 0, sizeof(_histogram));
+    _totalWeight = 0.0f;
+}
+
+void AudioJitterEstimator::update(quint64 gapUsecs) {
+    // a gap of n frames needs n frames of buffering to play through without starving
+    quint64 frames = (gapUsecs + AudioConstants::NETWORK_FRAME_USECS - 1) / AudioConstants::NETWORK_FRAME_USECS;
+    int bucket = (int)std::min(frames, (quint64)(MAX_DELAY_FRAMES - 1));
+
+    for (int i = 0; i < MAX_DELAY_FRAMES; i++) {
+        _histogram[i] *= FORGET_FACTOR;
+    }
+    _histogram[bucket] += 1.0f - FORGET_FACTOR;
+    _totalWeight = _totalWeight * FORGET_FACTOR + (1.0f - FORGET_FACTOR);
+}
+
+int AudioJitterEstimator::getTargetFrames(float percentile) const {
+    if (_totalWeight <= 0.0f) {
+        return 0;
+    }
+
+    float threshold = percentile * _totalWeight;
+    float cumulativeWeight = 0.0f;
+    for (int i = 0; i < MAX_DELAY_FRAMES; i++) {
+        cumulativeWeight += _histogram[i];
+        if (cumulativeWeight >= threshold && _histogram[i] > 0.0f) {
+            return i;
+        }
+    }
+
+    // rounding left the threshold out of reach, so fall back to the largest gap recorded
+    for (int i = MAX_DELAY_FRAMES - 1; i > 0; i--) {
+        if (_histogram[i] > 0.0f) {
+            return i;
+        }
+    }
+    return 0;
+}
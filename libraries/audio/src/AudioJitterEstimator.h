@@ -0,0 +1,40 @@
+//
+//  AudioJitterEstimator.h
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioJitterEstimator_h
+#define hifi_AudioJitterEstimator_h
+
+#include <QtCore/QtGlobal>
+
+// Estimates the jitter buffer delay a stream needs from a histogram of packet inter-arrival gaps, measured in
+// network frames, that slowly forgets old arrivals. The target delay is a percentile of that histogram, so a
+// stream can trade a few late packets for lower latency instead of always covering the worst gap seen.
+class AudioJitterEstimator {
+public:
+    static const int MAX_DELAY_FRAMES = 64;
+
+    // weight kept by the existing histogram for each new arrival, about 25 seconds of memory at 100 packets/s
+    static const float FORGET_FACTOR;
+
+    void reset();
+
+    // record the gap between the arrival of a packet and the one before it
+    void update(quint64 gapUsecs);
+
+    // the smallest delay, in frames, that covers the given fraction of the recorded gaps (0 with no history)
+    int getTargetFrames(float percentile) const;
+
+private:
+    float _histogram[MAX_DELAY_FRAMES] {};
+    float _totalWeight { 0.0f };
+};
+
+#endif // hifi_AudioJitterEstimator_h
@@ -0,0 +1,51 @@
+//
+//  AudioKernels.h
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+//
+// Block kernels of AudioLimiter and AudioReverb.
+// Each has a portable reference version, and SIMD versions selected at runtime using CPUDetect.h.
+// They are declared here so the variants can be tested and benchmarked against each other.
+//
+
+#ifndef hifi_AudioKernels_h
+#define hifi_AudioKernels_h
+
+#include <stdint.h>
+
+//
+// Limiter peak detection, for interleaved input of 1, 2 or 4 channels
+// attn[n] = MAX(threshold - peaklog2(input frame n), 0)
+//
+void limiterPeak_ref(const float* input, int32_t* attn, int32_t threshold, int numChannels, int numFrames);
+
+//
+// Limiter gain, dither and conversion to 16-bit, for interleaved input of 1, 2 or 4 channels
+// output = round(input * gain[n] + dither[n]), using one gain and dither per frame
+//
+void limiterOutput_ref(const float* input, const float* gain, const float* dither, int16_t* output,
+                       int numChannels, int numFrames);
+
+//
+// Reverb wet/dry mix
+// output = dry + (wet - dry) * mix, output may alias dry
+//
+void reverbMix_ref(const float* dry, const float* wet, float* output, float mix, int numFrames);
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+void limiterPeak_AVX2(const float* input, int32_t* attn, int32_t threshold, int numChannels, int numFrames);
+void limiterOutput_AVX2(const float* input, const float* gain, const float* dither, int16_t* output,
+                        int numChannels, int numFrames);
+void reverbMix_AVX2(const float* dry, const float* wet, float* output, float mix, int numFrames);
+
+#endif
+
+#endif // hifi_AudioKernels_h
@@ -11,6 +11,76 @@
 #include <assert.h>
 
 #include "AudioDynamics.h"
+#include "AudioKernels.h"
+
+//
+// Block kernels (reference)
+//
+void limiterPeak_ref(const float* input, int32_t* attn, int32_t threshold, int numChannels, int numFrames) {
+
+    float* x = const_cast<float*>(input);
+
+    for (int n = 0; n < numFrames; n++) {
+
+        // peak detect and convert to log2 domain
+        int32_t peak;
+        if (numChannels == 1) {
+            peak = peaklog2(&x[n]);
+        } else if (numChannels == 2) {
+            peak = peaklog2(&x[2*n+0], &x[2*n+1]);
+        } else {
+            peak = peaklog2(&x[4*n+0], &x[4*n+1], &x[4*n+2], &x[4*n+3]);
+        }
+
+        // compute limiter attenuation
+        attn[n] = MAX(threshold - peak, 0);
+    }
+}
+
+void limiterOutput_ref(const float* input, const float* gain, const float* dither, int16_t* output,
+                       int numChannels, int numFrames) {
+
+    for (int n = 0; n < numFrames; n++) {
+        for (int c = 0; c < numChannels; c++) {
+
+            // apply gain and dither
+            float x = input[numChannels*n+c];
+            x *= gain[n];
+            x += dither[n];
+
+            // store 16-bit output
+            output[numChannels*n+c] = (int16_t)floatToInt(x);
+        }
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include "CPUDetect.h"
+
+static void limiterPeak(const float* input, int32_t* attn, int32_t threshold, int numChannels, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? limiterPeak_AVX2 : limiterPeak_ref;
+    (*f)(input, attn, threshold, numChannels, numFrames);   // dispatch
+}
+
+static void limiterOutput(const float* input, const float* gain, const float* dither, int16_t* output,
+                          int numChannels, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? limiterOutput_AVX2 : limiterOutput_ref;
+    (*f)(input, gain, dither, output, numChannels, numFrames);  // dispatch
+}
+
+#else   // portable reference code
+
+static auto& limiterPeak = limiterPeak_ref;
+static auto& limiterOutput = limiterOutput_ref;
+
+#endif
+
+// frames processed per pass of the block kernels
+static const int LIMITER_BLOCK = 256;
 
 //
 // Limiter (common)
@@ -209,36 +279,43 @@ public:
 template<int N>
 void LimiterMono<N>::process(float* input, int16_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
+    int32_t attn[LIMITER_BLOCK];
+    float gain[LIMITER_BLOCK];
+    float dith[LIMITER_BLOCK];
+    float delayed[LIMITER_BLOCK];
 
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[n]);
+    while (numFrames > 0) {
+        int numBlockFrames = MIN(numFrames, LIMITER_BLOCK);
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+        // peak detect and compute limiter attenuation
+        limiterPeak(input, attn, _threshold, 1, numBlockFrames);
 
-        // apply envelope
-        attn = envelope(attn);
+        for (int n = 0; n < numBlockFrames; n++) {
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+            // apply envelope
+            int32_t a = envelope(attn[n]);
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+            // convert from log2 domain
+            a = fixexp2(a);
 
-        // delay audio
-        float x = input[n];
-        _delay.process(x);
+            // lowpass filter
+            a = _filter.process(a);
+            gain[n] = a * _outGain;
 
-        // apply gain
-        x *= gain;
+            // delay audio
+            float x = input[n];
+            _delay.process(x);
+            delayed[n] = x;
+
+            dith[n] = dither();
+        }
 
-        // apply dither
-        x += dither();
+        // apply gain and dither, store 16-bit output
+        limiterOutput(delayed, gain, dith, output, 1, numBlockFrames);
 
-        // store 16-bit output
-        output[n] = (int16_t)floatToInt(x);
+        input += numBlockFrames;
+        output += numBlockFrames;
+        numFrames -= numBlockFrames;
     }
 }
 
@@ -261,41 +338,45 @@ public:
 template<int N>
 void LimiterStereo<N>::process(float* input, int16_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
+    int32_t attn[LIMITER_BLOCK];
+    float gain[LIMITER_BLOCK];
+    float dith[LIMITER_BLOCK];
+    float delayed[2*LIMITER_BLOCK];
 
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[2*n+0], &input[2*n+1]);
+    while (numFrames > 0) {
+        int numBlockFrames = MIN(numFrames, LIMITER_BLOCK);
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
+        // peak detect and compute limiter attenuation
+        limiterPeak(input, attn, _threshold, 2, numBlockFrames);
 
-        // apply envelope
-        attn = envelope(attn);
+        for (int n = 0; n < numBlockFrames; n++) {
 
-        // convert from log2 domain
-        attn = fixexp2(attn);
+            // apply envelope
+            int32_t a = envelope(attn[n]);
 
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
+            // convert from log2 domain
+            a = fixexp2(a);
 
-        // delay audio
-        float x0 = input[2*n+0];
-        float x1 = input[2*n+1];
-        _delay.process(x0, x1);
+            // lowpass filter
+            a = _filter.process(a);
+            gain[n] = a * _outGain;
 
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
+            // delay audio
+            float x0 = input[2*n+0];
+            float x1 = input[2*n+1];
+            _delay.process(x0, x1);
+            delayed[2*n+0] = x0;
+            delayed[2*n+1] = x1;
 
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
+            dith[n] = dither();
+        }
+
+        // apply gain and dither, store 16-bit output
+        limiterOutput(delayed, gain, dith, output, 2, numBlockFrames);
 
-        // store 16-bit output
-        output[2*n+0] = (int16_t)floatToInt(x0);
-        output[2*n+1] = (int16_t)floatToInt(x1);
+        input += 2*numBlockFrames;
+        output += 2*numBlockFrames;
+        numFrames -= numBlockFrames;
     }
 }
 
@@ -318,49 +399,49 @@ public:
 template<int N>
 void LimiterQuad<N>::process(float* input, int16_t* output, int numFrames) {
 
-    for (int n = 0; n < numFrames; n++) {
+    int32_t attn[LIMITER_BLOCK];
+    float gain[LIMITER_BLOCK];
+    float dith[LIMITER_BLOCK];
+    float delayed[4*LIMITER_BLOCK];
 
-        // peak detect and convert to log2 domain
-        int32_t peak = peaklog2(&input[4*n+0], &input[4*n+1], &input[4*n+2], &input[4*n+3]);
+    while (numFrames > 0) {
+        int numBlockFrames = MIN(numFrames, LIMITER_BLOCK);
 
-        // compute limiter attenuation
-        int32_t attn = MAX(_threshold - peak, 0);
-
-        // apply envelope
-        attn = envelope(attn);
-
-        // convert from log2 domain
-        attn = fixexp2(attn);
-
-        // lowpass filter
-        attn = _filter.process(attn);
-        float gain = attn * _outGain;
-
-        // delay audio
-        float x0 = input[4*n+0];
-        float x1 = input[4*n+1];
-        float x2 = input[4*n+2];
-        float x3 = input[4*n+3];
-        _delay.process(x0, x1, x2, x3);
-
-        // apply gain
-        x0 *= gain;
-        x1 *= gain;
-        x2 *= gain;
-        x3 *= gain;
-
-        // apply dither
-        float d = dither();
-        x0 += d;
-        x1 += d;
-        x2 += d;
-        x3 += d;
-
-        // store 16-bit output
-        output[4*n+0] = (int16_t)floatToInt(x0);
-        output[4*n+1] = (int16_t)floatToInt(x1);
-        output[4*n+2] = (int16_t)floatToInt(x2);
-        output[4*n+3] = (int16_t)floatToInt(x3);
+        // peak detect and compute limiter attenuation
+        limiterPeak(input, attn, _threshold, 4, numBlockFrames);
+
+        for (int n = 0; n < numBlockFrames; n++) {
+
+            // apply envelope
+            int32_t a = envelope(attn[n]);
+
+            // convert from log2 domain
+            a = fixexp2(a);
+
+            // lowpass filter
+            a = _filter.process(a);
+            gain[n] = a * _outGain;
+
+            // delay audio
+            float x0 = input[4*n+0];
+            float x1 = input[4*n+1];
+            float x2 = input[4*n+2];
+            float x3 = input[4*n+3];
+            _delay.process(x0, x1, x2, x3);
+            delayed[4*n+0] = x0;
+            delayed[4*n+1] = x1;
+            delayed[4*n+2] = x2;
+            delayed[4*n+3] = x3;
+
+            dith[n] = dither();
+        }
+
+        // apply gain and dither, store 16-bit output
+        limiterOutput(delayed, gain, dith, output, 4, numBlockFrames);
+
+        input += 4*numBlockFrames;
+        output += 4*numBlockFrames;
+        numFrames -= numBlockFrames;
     }
 }
 
@@ -7,6 +7,7 @@
 //
 
 #include "AudioReverb.h"
+#include "AudioKernels.h"
 
 #include <stdint.h>
 #include <string.h>
@@ -26,6 +27,37 @@
 #define MIN(a,b)    (((a) < (b)) ? (a) : (b))
 #endif
 
+//
+// Block kernels (reference)
+//
+void reverbMix_ref(const float* dry, const float* wet, float* output, float mix, int numFrames) {
+    for (int i = 0; i < numFrames; i++) {
+        float x = dry[i];
+        output[i] = x + (wet[i] - x) * mix;
+    }
+}
+
+//
+// Runtime CPU dispatch
+//
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include "CPUDetect.h"
+
+static void reverbMix(const float* dry, const float* wet, float* output, float mix, int numFrames) {
+    static auto f = cpuSupportsAVX2() ? reverbMix_AVX2 : reverbMix_ref;
+    (*f)(dry, wet, output, mix, numFrames);  // dispatch
+}
+
+#else   // portable reference code
+
+static auto& reverbMix = reverbMix_ref;
+
+#endif
+
+// frames of wet output buffered for each pass of the wet/dry mix
+static const int REVERB_MIX_BLOCK = 256;
+
 static const float PHI = 0.6180339887f; // maximum allpass diffusion
 static const float TWOPI = 6.283185307f;
 
@@ -1209,6 +1241,9 @@ public:
     void setParameters(ReverbParameters *p);
     void process(float** inputs, float** outputs, int numFrames);
     void reset();
+
+private:
+    void processBlock(float* input0, float* input1, float* output0, float* output1, int numFrames);
 };
 
 static const short primeTable[] = {
@@ -1579,12 +1614,23 @@ void ReverbImpl::setParameters(ReverbParameters *p) {
 
 void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
 
+    for (int k = 0; k < numFrames; k += REVERB_MIX_BLOCK) {
+        int numBlockFrames = MIN(numFrames - k, REVERB_MIX_BLOCK);
+        processBlock(&inputs[0][k], &inputs[1][k], &outputs[0][k], &outputs[1][k], numBlockFrames);
+    }
+}
+
+void ReverbImpl::processBlock(float* input0, float* input1, float* output0, float* output1, int numFrames) {
+
+    float wet0[REVERB_MIX_BLOCK];
+    float wet1[REVERB_MIX_BLOCK];
+
     for (int i = 0; i < numFrames; i++) {
         float x0, x1, y0, y1, y2, y3;
 
         // Preprocess
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
+        x0 = input0[i];
+        x1 = input1[i];
         _bw.process(x0, x1, x0, x1);
 
         float preL, preR;
@@ -1660,11 +1706,13 @@ void ReverbImpl::process(float** inputs, float** outputs, int numFrames) {
         _ap20.process(-earlyOutR + lateOut1 + lateOut2, x1);
         _ap21.process(x1, y1);
 
-        x0 = inputs[0][i];
-        x1 = inputs[1][i];
-        outputs[0][i] = x0 + (y0 - x0) * _wetDryMix;
-        outputs[1][i] = x1 + (y1 - x1) * _wetDryMix;
+        wet0[i] = y0;
+        wet1[i] = y1;
     }
+
+    // wet/dry mix, outputs may alias inputs
+    reverbMix(input0, wet0, output0, _wetDryMix, numFrames);
+    reverbMix(input1, wet1, output1, _wetDryMix, numFrames);
 }
 
 // clear internal state, but retain settings
@@ -22,6 +22,7 @@
 
 const bool InboundAudioStream::DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED = true;
 const int InboundAudioStream::DEFAULT_STATIC_JITTER_FRAMES = 1;
+const float InboundAudioStream::DEFAULT_TARGET_DELAY_PERCENTILE = 1.0f;
 const int InboundAudioStream::MAX_FRAMES_OVER_DESIRED = 10;
 const int InboundAudioStream::WINDOW_STARVE_THRESHOLD = 3;
 const int InboundAudioStream::WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES = 50;
@@ -87,10 +88,12 @@ void InboundAudioStream::resetStats() {
     _starveCount = 0;
     _silentFramesDropped = 0;
     _oldFramesDropped = 0;
+    _framesConcealed = 0;
     _incomingSequenceNumberStats.reset();
     _lastPacketReceivedTime = 0;
     _timeGapStatsForDesiredCalcOnTooManyStarves.reset();
     _timeGapStatsForDesiredReduction.reset();
+    _jitterEstimator.reset();
     _starveHistory.clear();
     _framesAvailableStat.reset();
     _currentJitterBufferFrames = 0;
@@ -263,6 +266,7 @@ int InboundAudioStream::lostAudioData(int numPackets) {
             memset(decodedBuffer.data(), 0, decodedBuffer.size());
         }
         _ringBuffer.writeData(decodedBuffer.data(), decodedBuffer.size());
+        _framesConcealed++;
     }
     return 0;
 }
@@ -497,6 +501,7 @@ void InboundAudioStream::packetReceivedUpdateTimingStats() {
         // update all stats used for desired frames calculations under dynamic jitter buffer mode
         _timeGapStatsForDesiredCalcOnTooManyStarves.update(gap);
         _timeGapStatsForDesiredReduction.update(gap);
+        _jitterEstimator.update(gap);
 
         if (_timeGapStatsForDesiredCalcOnTooManyStarves.getNewStatsAvailableFlag()) {
             _calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredCalcOnTooManyStarves.getWindowMax()
@@ -510,6 +515,10 @@ void InboundAudioStream::packetReceivedUpdateTimingStats() {
             if (_timeGapStatsForDesiredReduction.getNewStatsAvailableFlag() && _timeGapStatsForDesiredReduction.isWindowFilled()) {
                 int calculatedJitterBufferFrames = ceilf((float)_timeGapStatsForDesiredReduction.getWindowMax()
                                                          / (float)AudioConstants::NETWORK_FRAME_USECS);
+                if (_targetDelayPercentile < 1.0f) {
+                    // accept the occasional late packet, which the decoder conceals, for a shorter buffer
+                    calculatedJitterBufferFrames = std::max(getTargetDelayFrames(), 1);
+                }
                 if (calculatedJitterBufferFrames < _desiredJitterBufferFrames) {
                     _desiredJitterBufferFrames = calculatedJitterBufferFrames;
                     qCInfo(audiostream, "Set desired jitter frames to %d (reduced)", _desiredJitterBufferFrames);
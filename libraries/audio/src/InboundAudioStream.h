@@ -21,6 +21,7 @@
 
 #include <plugins/CodecPlugin.h>
 
+#include "AudioJitterEstimator.h"
 #include "AudioRingBuffer.h"
 #include "MovingMinMaxAvg.h"
 #include "SequenceNumberStats.h"
@@ -39,6 +40,7 @@ public:
     // settings
     static const bool DEFAULT_DYNAMIC_JITTER_BUFFER_ENABLED;
     static const int DEFAULT_STATIC_JITTER_FRAMES;
+    static const float DEFAULT_TARGET_DELAY_PERCENTILE;
     // legacy (now static) settings
     static const int MAX_FRAMES_OVER_DESIRED;
     static const int WINDOW_STARVE_THRESHOLD;
@@ -75,6 +77,12 @@ public:
 
     /// returns the desired number of jitter buffer frames under the dyanmic jitter buffers scheme
     int getCalculatedJitterBufferFrames() const { return _calculatedJitterBufferFrames; }
+
+    // fraction of packet arrival gaps the dynamic jitter buffer is reduced to cover; 1.0 covers the largest recent gap
+    void setTargetDelayPercentile(float percentile) { _targetDelayPercentile = percentile; }
+    float getTargetDelayPercentile() const { return _targetDelayPercentile; }
+    int getTargetDelayFrames() const { return _jitterEstimator.getTargetFrames(_targetDelayPercentile); }
+    int getFramesConcealed() const { return _framesConcealed; }
     
     bool dynamicJitterBufferEnabled() const { return _dynamicJitterBufferEnabled; }
     int getStaticJitterBufferFrames() { return _staticJitterBufferFrames; }
@@ -161,6 +169,7 @@ protected:
     int _starveCount { 0 };
     int _silentFramesDropped { 0 };
     int _oldFramesDropped { 0 };
+    int _framesConcealed { 0 };
 
     SequenceNumberStats _incomingSequenceNumberStats;
 
@@ -168,6 +177,8 @@ protected:
     MovingMinMaxAvg<quint64> _timeGapStatsForDesiredCalcOnTooManyStarves { 0, WINDOW_SECONDS_FOR_DESIRED_CALC_ON_TOO_MANY_STARVES };
     int _calculatedJitterBufferFrames { 0 };
     MovingMinMaxAvg<quint64> _timeGapStatsForDesiredReduction { 0, WINDOW_SECONDS_FOR_DESIRED_REDUCTION };
+    AudioJitterEstimator _jitterEstimator;
+    float _targetDelayPercentile { DEFAULT_TARGET_DELAY_PERCENTILE };
 
     RingBufferHistory<quint64> _starveHistory;
 
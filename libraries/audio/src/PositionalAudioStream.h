@@ -66,6 +66,8 @@ public:
 
     const glm::vec3& getPosition() const { return _position; }
     const glm::quat& getOrientation() const { return _orientation; }
+    // replaces the pose from the stream's packets until the next of them
+    void setPose(const glm::vec3& position, const glm::quat& orientation) { _position = position; _orientation = orientation; }
     const glm::vec3& getAvatarBoundingBoxCorner() const { return _avatarBoundingBoxCorner; }
     const glm::vec3& getAvatarBoundingBoxScale() const { return _avatarBoundingBoxScale; }
 
@@ -79,6 +81,10 @@ public:
     bool isIgnoreBoxEnabled() const { return _isIgnoreBoxEnabled; }
     const IgnoreBox& getIgnoreBox() const { return _ignoreBox; }
 
+    // called by the audio mixer between mixes, the place of the stream in its table of sources for the frame
+    void setAudibilityIndex(int index) { _audibilityIndex = index; }
+    int getAudibilityIndex() const { return _audibilityIndex; }
+
 protected:
     // disallow copying of PositionalAudioStream objects
     PositionalAudioStream(const PositionalAudioStream&);
@@ -109,6 +115,8 @@ protected:
 
     bool _isIgnoreBoxEnabled { false };
     IgnoreBox _ignoreBox;
+
+    int _audibilityIndex { -1 };
 };
 
 #endif // hifi_PositionalAudioStream_h
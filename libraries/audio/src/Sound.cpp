@@ -13,6 +13,9 @@
 
 #include <stdint.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <glm/glm.hpp>
 
 #include <QRunnable>
@@ -37,6 +40,10 @@ int audioDataPointerMetaTypeID = qRegisterMetaType<AudioDataPointer>("AudioDataP
 
 using AudioConstants::AudioSample;
 
+// sounds at least this long, once resampled, are streamed rather than decoded whole: music and ambient loops rather
+// than the effects that are played over and over
+static const uint32_t MIN_STREAMED_SOUND_FRAMES = 30 * AudioConstants::SAMPLE_RATE;
+
 AudioDataPointer AudioData::make(uint32_t numSamples, uint32_t numChannels,
                                  const AudioSample* samples) {
     // Compute the amount of memory required for the audio data object
@@ -62,6 +69,20 @@ AudioDataPointer AudioData::make(uint32_t numSamples, uint32_t numChannels,
     });
 }
 
+AudioDataPointer AudioData::make(uint32_t numChannels, const QByteArray& samples) {
+    QByteArray sharedSamples = samples;
+    uint32_t numSamples = (uint32_t)sharedSamples.size() / sizeof(AudioSample);
+    if (numChannels > 0) {
+        // whole frames only
+        numSamples -= numSamples % numChannels;
+    }
+    auto buffer = reinterpret_cast<const AudioSample*>(sharedSamples.constData());
+
+    // the deleter holds the reference that keeps the buffer alive
+    return AudioDataPointer(new AudioData(numSamples, numChannels, buffer), [sharedSamples](AudioData* ptr) {
+        delete ptr;
+    });
+}
 
 AudioData::AudioData(uint32_t numSamples, uint32_t numChannels, const AudioSample* samples)
     : _numSamples(numSamples),
@@ -78,6 +99,7 @@ void Sound::downloadFinished(const QByteArray& data) {
     // this is a QRunnable, will delete itself after it has finished running
     auto soundProcessor = new SoundProcessor(_self, data);
     connect(soundProcessor, &SoundProcessor::onSuccess, this, &Sound::soundProcessSuccess);
+    connect(soundProcessor, &SoundProcessor::onStreamed, this, &Sound::soundProcessStreamed);
     connect(soundProcessor, &SoundProcessor::onError, this, &Sound::soundProcessError);
     QThreadPool::globalInstance()->start(soundProcessor);
 }
@@ -91,6 +113,34 @@ void Sound::soundProcessSuccess(AudioDataPointer audioData) {
     emit ready();
 }
 
+void Sound::soundProcessStreamed(SoundSourcePointer source) {
+    qCDebug(audio) << "Setting ready state for streamed sound file" << _url.fileName() << "of" << source->getDuration() << "s";
+
+    _source = std::move(source);
+    finishedLoading(true);
+
+    emit ready();
+}
+
+AudioDataPointer Sound::getAudioData() const {
+    if (!_source) {
+        return _audioData;
+    }
+
+    std::lock_guard<std::mutex> lock(_decodedMutex);
+    auto audioData = _decoded.lock();
+    if (!audioData) {
+        // the length of an MP3 is known to about a frame, so decode into a buffer with room to spare
+        SoundStream stream(_source);
+        const uint32_t numChannels = _source->getNumChannels();
+        std::vector<AudioSample> samples((_source->getNumFrames() + AudioConstants::SAMPLE_RATE) * numChannels);
+        int numFrames = stream.read(samples.data(), (int)(samples.size() / numChannels));
+        audioData = AudioData::make(numFrames * numChannels, numChannels, samples.data());
+        _decoded = audioData;
+    }
+    return audioData;
+}
+
 void Sound::soundProcessError(int error, QString str) {
     qCCritical(audio) << "Failed to process sound file: code =" << error << str;
     emit failed(QNetworkReply::UnknownContentError);
@@ -129,7 +179,12 @@ void SoundProcessor::run() {
         properties = interpretAsWav(_data, outputAudioByteArray);
     } else if (fileName.endsWith(MP3_EXTENSION)) {
         fileType = "MP3";
-        properties = interpretAsMP3(_data, outputAudioByteArray);
+        // a long MP3 is streamed from the file as it is, so only the short ones are decoded here
+        properties = probeMP3(_data);
+        if ((uint64_t)properties.numFrames * AudioConstants::SAMPLE_RATE <
+                (uint64_t)MIN_STREAMED_SOUND_FRAMES * std::max(properties.sampleRate, 1u)) {
+            properties = interpretAsMP3(_data, outputAudioByteArray);
+        }
     } else if (fileName.endsWith(STEREO_RAW_EXTENSION)) {
         // check if this was a stereo raw file
         // since it's raw the only way for us to know that is if the file was called .stereo.raw
@@ -137,11 +192,13 @@ void SoundProcessor::run() {
         // Process as 48khz RAW file
         properties.numChannels = 2;
         properties.sampleRate = 48000;
+        properties.numFrames = _data.size() / (2 * AudioConstants::SAMPLE_SIZE);
         outputAudioByteArray = _data;
     } else if (fileName.endsWith(RAW_EXTENSION)) {
         // Process as 48khz RAW file
         properties.numChannels = 1;
         properties.sampleRate = 48000;
+        properties.numFrames = _data.size() / AudioConstants::SAMPLE_SIZE;
         outputAudioByteArray = _data;
     } else {
         qCWarning(audio) << "Unknown sound file type";
@@ -155,6 +212,21 @@ void SoundProcessor::run() {
         return;
     }
 
+    uint32_t numStreamedFrames = (uint32_t)((uint64_t)properties.numFrames * AudioConstants::SAMPLE_RATE / properties.sampleRate);
+    if (numStreamedFrames >= MIN_STREAMED_SOUND_FRAMES) {
+        qCDebug(audio) << "Streaming" << fileType << "sound of" << numStreamedFrames << "frames from" << fileName;
+        if (fileType == "MP3") {
+            emit onStreamed(SoundSource::make(SoundSource::MP3, _data, 0, _data.size(),
+                                              properties.numChannels, properties.sampleRate, numStreamedFrames));
+        } else {
+            // the samples are where they are in the file, which the source keeps instead of a copy of them
+            int offset = (int)(outputAudioByteArray.constData() - _data.constData());
+            emit onStreamed(SoundSource::make(SoundSource::PCM, _data, offset, outputAudioByteArray.size(),
+                                              properties.numChannels, properties.sampleRate, numStreamedFrames));
+        }
+        return;
+    }
+
     auto data = downSample(outputAudioByteArray, properties);
 
     int numSamples = data.size() / AudioConstants::SAMPLE_SIZE;
@@ -320,16 +392,17 @@ SoundProcessor::AudioProperties SoundProcessor::interpretAsWav(const QByteArray&
         waveStream.skipRawData(qFromLittleEndian<quint32>(data.size));  // next chunk
     }
 
-    // Read the "data" chunk
+    // Refer to the "data" chunk where it is rather than copy it, the input outlives the output
     quint32 outputAudioByteArraySize = qFromLittleEndian<quint32>(data.size);
-    outputAudioByteArray.resize(outputAudioByteArraySize);
-    auto bytesRead = waveStream.readRawData(outputAudioByteArray.data(), outputAudioByteArraySize);
-    if (bytesRead != (int)outputAudioByteArraySize) {
+    qint64 dataOffset = waveStream.device()->pos();
+    if (dataOffset + outputAudioByteArraySize > (qint64)inputAudioByteArray.size()) {
         qCWarning(audio) << "Error reading WAV file";
         return AudioProperties();
     }
+    outputAudioByteArray = QByteArray::fromRawData(inputAudioByteArray.constData() + dataOffset, outputAudioByteArraySize);
 
     properties.sampleRate = wave.sampleRate;
+    properties.numFrames = outputAudioByteArraySize / (properties.numChannels * AudioConstants::SAMPLE_SIZE);
     return properties;
 }
 
@@ -421,6 +494,57 @@ SoundProcessor::AudioProperties SoundProcessor::interpretAsMP3(const QByteArray&
     return properties;
 }
 
+SoundProcessor::AudioProperties SoundProcessor::probeMP3(const QByteArray& inputAudioByteArray) {
+    AudioProperties properties;
+
+    using namespace flump3dec;
+
+    Bit_stream_struc *bitstream = bs_new();
+    if (bitstream == nullptr) {
+        return AudioProperties();
+    }
+    mp3tl *decoder = mp3tl_new(bitstream, MP3TL_MODE_16BIT);
+    if (decoder == nullptr) {
+        bs_free(bitstream);
+        return AudioProperties();
+    }
+
+    bs_set_data(bitstream, (uint8_t*)inputAudioByteArray.data(), inputAudioByteArray.size());
+    int frameCount = 0;
+
+    Mp3TlRetcode result = mp3tl_skip_id3(decoder);
+    while (!(result == MP3TL_ERR_NO_SYNC || result == MP3TL_ERR_NEED_DATA)) {
+
+        mp3tl_sync(decoder);
+
+        const fr_header *header = nullptr;
+        result = mp3tl_decode_header(decoder, &header);
+        if (result != MP3TL_ERR_OK) {
+            continue;
+        }
+
+        if (frameCount++ == 0) {
+            properties.sampleRate = header->sample_rate;
+            properties.numChannels = header->channels;
+            result = mp3tl_skip_xing(decoder, header);
+            if (result != MP3TL_ERR_OK) {
+                continue;
+            }
+        }
+
+        // only the frames the stream will play count, as with decoding
+        if ((uint32_t)header->sample_rate == properties.sampleRate && (uint32_t)header->channels == properties.numChannels) {
+            properties.numFrames += header->frame_samples;
+        }
+        result = mp3tl_skip_frame(decoder);
+    }
+
+    mp3tl_free(decoder);
+    bs_free(bitstream);
+
+    return properties;
+}
+
 
 QScriptValue soundSharedPointerToScriptValue(QScriptEngine* engine, const SharedSoundPointer& in) {
     return engine->newQObject(new SoundScriptingInterface(in), QScriptEngine::ScriptOwnership);
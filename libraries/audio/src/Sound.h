@@ -12,6 +12,8 @@
 #ifndef hifi_Sound_h
 #define hifi_Sound_h
 
+#include <mutex>
+
 #include <QRunnable>
 #include <QtCore/QObject>
 #include <QtCore/QSharedPointer>
@@ -21,6 +23,7 @@
 #include <ResourceCache.h>
 
 #include "AudioConstants.h"
+#include "SoundStream.h"
 
 class AudioData;
 using AudioDataPointer = std::shared_ptr<const AudioData>;
@@ -38,6 +41,10 @@ public:
     static AudioDataPointer make(uint32_t numSamples, uint32_t numChannels,
                                  const AudioSample* samples);
 
+    // Shares the samples' buffer with the caller instead of copying it; the QByteArray is only ever read from here, so a
+    // later write by the caller detaches their copy and leaves this one as it was
+    static AudioDataPointer make(uint32_t numChannels, const QByteArray& samples);
+
     uint32_t getNumSamples() const { return _numSamples; }
     uint32_t getNumChannels() const { return _numChannels; }
     const AudioSample* data() const { return _data; }
@@ -62,15 +69,20 @@ class Sound : public Resource {
 
 public:
     Sound(const QUrl& url, bool isStereo = false, bool isAmbisonic = false);
-    Sound(const Sound& other) : Resource(other), _audioData(other._audioData), _numChannels(other._numChannels) {}
+    Sound(const Sound& other) :
+        Resource(other), _audioData(other._audioData), _source(other._source), _numChannels(other._numChannels) {}
 
-    bool isReady() const { return (bool)_audioData; }
+    bool isReady() const { return _audioData || _source; }
 
-    bool isStereo() const { return _audioData ? _audioData->isStereo() : false; }
-    bool isAmbisonic() const { return _audioData ? _audioData->isAmbisonic() : false; }
-    float getDuration() const { return _audioData ? _audioData->getDuration() : 0.0f; }
+    bool isStereo() const { return _source ? _source->isStereo() : (_audioData ? _audioData->isStereo() : false); }
+    bool isAmbisonic() const { return _source ? _source->isAmbisonic() : (_audioData ? _audioData->isAmbisonic() : false); }
+    float getDuration() const { return _source ? _source->getDuration() : (_audioData ? _audioData->getDuration() : 0.0f); }
 
-    AudioDataPointer getAudioData() const { return _audioData; }
+    // a long sound is kept as its file and decoded as it plays, through a SoundStream of its source; asking for its
+    // audio data decodes it whole, for as long as a caller holds on to it
+    bool isStreamed() const { return (bool)_source; }
+    SoundSourcePointer getSource() const { return _source; }
+    AudioDataPointer getAudioData() const;
 
     int getNumChannels() const { return _numChannels; }
 
@@ -79,12 +91,18 @@ signals:
 
 protected slots:
     void soundProcessSuccess(AudioDataPointer audioData);
+    void soundProcessStreamed(SoundSourcePointer source);
     void soundProcessError(int error, QString str);
     
 private:
     virtual void downloadFinished(const QByteArray& data) override;
 
     AudioDataPointer _audioData;
+    SoundSourcePointer _source;
+
+    // the whole decode of a streamed sound, shared by the callers that asked for it while any of them still has it
+    mutable std::mutex _decodedMutex;
+    mutable std::weak_ptr<const AudioData> _decoded;
 
      // Only used for caching until the download has finished
     int _numChannels { 0 };
@@ -97,6 +115,8 @@ public:
     struct AudioProperties {
         uint8_t numChannels { 0 };
         uint32_t sampleRate { 0 };
+        // at sampleRate, when known before decoding
+        uint32_t numFrames { 0 };
     };
 
     SoundProcessor(QWeakPointer<Resource> sound, QByteArray data);
@@ -109,9 +129,12 @@ public:
                                    QByteArray& outputAudioByteArray);
     AudioProperties interpretAsMP3(const QByteArray& inputAudioByteArray,
                                    QByteArray& outputAudioByteArray);
+    // reads the MP3's frame headers without decoding the frames
+    AudioProperties probeMP3(const QByteArray& inputAudioByteArray);
 
 signals:
     void onSuccess(AudioDataPointer audioData);
+    void onStreamed(SoundSourcePointer source);
     void onError(int error, QString str);
 
 private:
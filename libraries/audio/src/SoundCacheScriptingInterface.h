@@ -43,10 +43,15 @@ class SoundCacheScriptingInterface : public ScriptableResourceCache, public Depe
      *     <em>Read-only.</em>
      * @property {number} numGlobalQueriesLoading - Total number of global queries loading (across all resource cache managers).
      *     <em>Read-only.</em>
+     * @property {number} numGlobalSpeculativeHits - Total number of resources loaded ahead of being requested that were then
+     *     requested (across all resource cache managers). <em>Read-only.</em>
+     * @property {number} numGlobalSpeculativeMisses - Total number of resources loaded ahead of being requested that were
+     *     not (across all resource cache managers). <em>Read-only.</em>
      *
      * @borrows ResourceCache.getResourceList as getResourceList
      * @borrows ResourceCache.updateTotalSize as updateTotalSize
      * @borrows ResourceCache.prefetch as prefetch
+     * @borrows ResourceCache.getRequestQueueStats as getRequestQueueStats
      * @borrows ResourceCache.dirty as dirty
      */
 
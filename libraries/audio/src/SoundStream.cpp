@@ -0,0 +1,216 @@
+//
+//  SoundStream.cpp
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SoundStream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "AudioSRC.h"
+
+#include "flump3dec.h"
+
+int soundSourcePointerMetaTypeID = qRegisterMetaType<SoundSourcePointer>("SoundSourcePointer");
+
+// the source frames decoded at a time from PCM, about as many as an MP3 frame holds
+static const int PCM_BLOCK_FRAMES = 1024;
+
+static const int MP3_SAMPLES_MAX = 1152;
+static const int MP3_CHANNELS_MAX = 2;
+static const int MP3_BUFFER_SIZE = MP3_SAMPLES_MAX * MP3_CHANNELS_MAX * sizeof(int16_t);
+
+SoundSourcePointer SoundSource::make(Format format, const QByteArray& file, int offset, int size,
+                                     uint32_t numChannels, uint32_t sampleRate, uint32_t numFrames) {
+    return SoundSourcePointer(new SoundSource(format, file, offset, size, numChannels, sampleRate, numFrames));
+}
+
+SoundSource::SoundSource(Format format, const QByteArray& file, int offset, int size,
+                         uint32_t numChannels, uint32_t sampleRate, uint32_t numFrames) :
+    _format(format),
+    _file(file),
+    _offset(offset),
+    _size(size),
+    _numChannels(numChannels),
+    _sampleRate(sampleRate),
+    _numFrames(numFrames)
+{}
+
+struct SoundStream::MP3Decoder {
+    flump3dec::Bit_stream_struc* bitstream { nullptr };
+    flump3dec::mp3tl* decoder { nullptr };
+    int frameCount { 0 };
+    uint8_t buffer[MP3_BUFFER_SIZE];
+};
+
+SoundStream::SoundStream(SoundSourcePointer source) :
+    _source(std::move(source))
+{
+    rewind();
+}
+
+SoundStream::~SoundStream() {
+    closeMP3();
+}
+
+void SoundStream::rewind() {
+    _sourcePosition = 0;
+    _output.clear();
+    _outputPosition = 0;
+
+    // a fresh resampler, without the history of where the stream was
+    _resampler.reset();
+    if (_source->getSampleRate() != AudioConstants::SAMPLE_RATE) {
+        _resampler.reset(new AudioSRC(_source->getSampleRate(), AudioConstants::SAMPLE_RATE, _source->getNumChannels()));
+    }
+
+    if (_source->getFormat() == SoundSource::MP3) {
+        using namespace flump3dec;
+
+        closeMP3();
+        _mp3.reset(new MP3Decoder());
+        _mp3->bitstream = bs_new();
+        if (_mp3->bitstream) {
+            _mp3->decoder = mp3tl_new(_mp3->bitstream, MP3TL_MODE_16BIT);
+        }
+        if (!_mp3->decoder) {
+            closeMP3();
+            return;
+        }
+        bs_set_data(_mp3->bitstream, (const uint8_t*)_source->data(), _source->getSize());
+        mp3tl_skip_id3(_mp3->decoder);
+    }
+}
+
+void SoundStream::closeMP3() {
+    if (!_mp3) {
+        return;
+    }
+    if (_mp3->decoder) {
+        flump3dec::mp3tl_free(_mp3->decoder);
+    }
+    if (_mp3->bitstream) {
+        flump3dec::bs_free(_mp3->bitstream);
+    }
+    _mp3.reset();
+}
+
+int SoundStream::read(AudioSample* samples, int numFrames) {
+    const int numChannels = _source->getNumChannels();
+    int framesRead = 0;
+    while (framesRead < numFrames) {
+        if (_outputPosition >= _output.size() && !fill()) {
+            break;
+        }
+        int framesLeft = (int)(_output.size() - _outputPosition) / numChannels;
+        int frames = std::min(framesLeft, numFrames - framesRead);
+        if (samples) {
+            memcpy(samples + framesRead * numChannels, _output.data() + _outputPosition,
+                   frames * numChannels * sizeof(AudioSample));
+        }
+        _outputPosition += frames * numChannels;
+        framesRead += frames;
+    }
+    return framesRead;
+}
+
+void SoundStream::skip(int numFrames) {
+    read(nullptr, numFrames);
+}
+
+bool SoundStream::atEnd() {
+    return _outputPosition >= _output.size() && !fill();
+}
+
+bool SoundStream::fill() {
+    _output.clear();
+    _outputPosition = 0;
+
+    // a block can resample to nothing while the resampler fills its history, so keep going until it outputs
+    while (_output.empty()) {
+        bool decoded = _source->getFormat() == SoundSource::MP3 ? decodeMP3() : decodePCM();
+        if (!decoded) {
+            return false;
+        }
+
+        const int numChannels = _source->getNumChannels();
+        int numFrames = (int)_decoded.size() / numChannels;
+        if (_resampler) {
+            _output.resize(_resampler->getMaxOutput(numFrames) * numChannels);
+            int outputFrames = _resampler->render(_decoded.data(), _output.data(), numFrames);
+            _output.resize(outputFrames * numChannels);
+        } else {
+            _output.swap(_decoded);
+        }
+    }
+    return true;
+}
+
+bool SoundStream::decodePCM() {
+    const int frameBytes = _source->getNumChannels() * sizeof(AudioSample);
+    int framesLeft = (_source->getSize() - _sourcePosition) / frameBytes;
+    int numFrames = std::min(framesLeft, PCM_BLOCK_FRAMES);
+    if (numFrames <= 0) {
+        return false;
+    }
+
+    _decoded.resize(numFrames * _source->getNumChannels());
+    memcpy(_decoded.data(), _source->data() + _sourcePosition, numFrames * frameBytes);
+    _sourcePosition += numFrames * frameBytes;
+    return true;
+}
+
+bool SoundStream::decodeMP3() {
+    using namespace flump3dec;
+
+    if (!_mp3) {
+        return false;
+    }
+
+    Mp3TlRetcode result = MP3TL_ERR_OK;
+    while (!(result == MP3TL_ERR_NO_SYNC || result == MP3TL_ERR_NEED_DATA)) {
+
+        mp3tl_sync(_mp3->decoder);
+
+        const fr_header* header = nullptr;
+        result = mp3tl_decode_header(_mp3->decoder, &header);
+        if (result != MP3TL_ERR_OK) {
+            continue;
+        }
+
+        if (_mp3->frameCount++ == 0) {
+            result = mp3tl_skip_xing(_mp3->decoder, header);
+            if (result != MP3TL_ERR_OK) {
+                continue;
+            }
+        }
+
+        result = mp3tl_decode_frame(_mp3->decoder, _mp3->buffer, MP3_BUFFER_SIZE);
+
+        // a frame of another layout than the first is dropped rather than played at the wrong rate
+        if ((uint32_t)header->channels != _source->getNumChannels() ||
+            (uint32_t)header->sample_rate != _source->getSampleRate()) {
+            continue;
+        }
+
+        // fill bad frames with silence
+        int numSamples = header->frame_samples * header->channels;
+        if (result == MP3TL_ERR_BAD_FRAME) {
+            memset(_mp3->buffer, 0, numSamples * sizeof(int16_t));
+        }
+
+        if (result == MP3TL_ERR_OK || result == MP3TL_ERR_BAD_FRAME) {
+            auto samples = reinterpret_cast<const AudioSample*>(_mp3->buffer);
+            _decoded.assign(samples, samples + numSamples);
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,118 @@
+//
+//  SoundStream.h
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SoundStream_h
+#define hifi_SoundStream_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QMetaType>
+
+#include "AudioConstants.h"
+
+class AudioSRC;
+
+class SoundSource;
+using SoundSourcePointer = std::shared_ptr<const SoundSource>;
+
+Q_DECLARE_METATYPE(SoundSourcePointer);
+
+// The file of a sound long enough to be decoded as it plays rather than all at once, kept as it was downloaded:
+// compressed for MP3, the samples at the file's own rate for WAV and RAW.
+// Like AudioData it is immutable, and safe to share between the threads playing it.
+class SoundSource {
+public:
+    using AudioSample = AudioConstants::AudioSample;
+
+    enum Format {
+        PCM,
+        MP3
+    };
+
+    // the source is the bytes from offset to offset + size of file, which it shares rather than copies;
+    // numFrames is the length at sampleRate
+    static SoundSourcePointer make(Format format, const QByteArray& file, int offset, int size,
+                                   uint32_t numChannels, uint32_t sampleRate, uint32_t numFrames);
+
+    Format getFormat() const { return _format; }
+    const char* data() const { return _file.constData() + _offset; }
+    int getSize() const { return _size; }
+    uint32_t getNumChannels() const { return _numChannels; }
+    uint32_t getSampleRate() const { return _sampleRate; }
+
+    // the length once resampled to AudioConstants::SAMPLE_RATE, exact for PCM and to within a frame of the decoder's
+    // delay for MP3
+    uint32_t getNumFrames() const { return _numFrames; }
+    uint32_t getNumSamples() const { return _numFrames * _numChannels; }
+    uint32_t getNumBytes() const { return getNumSamples() * sizeof(AudioSample); }
+    float getDuration() const { return (float)_numFrames / AudioConstants::SAMPLE_RATE; }
+    bool isStereo() const { return _numChannels == 2; }
+    bool isAmbisonic() const { return _numChannels == 4; }
+
+private:
+    SoundSource(Format format, const QByteArray& file, int offset, int size,
+                uint32_t numChannels, uint32_t sampleRate, uint32_t numFrames);
+
+    const Format _format;
+    const QByteArray _file;
+    const int _offset;
+    const int _size;
+    const uint32_t _numChannels;
+    const uint32_t _sampleRate;
+    const uint32_t _numFrames;
+};
+
+// Decodes a SoundSource a block at a time and resamples it to AudioConstants::SAMPLE_RATE, so playing a sound takes no
+// more memory than its source and whatever the caller reads ahead. One thread reads a stream at a time.
+class SoundStream {
+public:
+    using AudioSample = AudioConstants::AudioSample;
+
+    SoundStream(SoundSourcePointer source);
+    ~SoundStream();
+
+    const SoundSourcePointer& getSource() const { return _source; }
+
+    // reads up to numFrames frames of interleaved samples, fewer only at the end of the sound
+    int read(AudioSample* samples, int numFrames);
+    // decodes and drops numFrames frames
+    void skip(int numFrames);
+    void rewind();
+
+    // decodes the next block when none is left to know, so it may take as long as a read
+    bool atEnd();
+
+private:
+    // decodes and resamples the next block of the source, false at its end
+    bool fill();
+    bool decodePCM();
+    bool decodeMP3();
+    void closeMP3();
+
+    const SoundSourcePointer _source;
+    std::unique_ptr<AudioSRC> _resampler;
+
+    // samples decoded at the source's rate, then those resampled and not read yet
+    std::vector<AudioSample> _decoded;
+    std::vector<AudioSample> _output;
+    size_t _outputPosition { 0 };
+
+    // bytes into the source
+    int _sourcePosition { 0 };
+
+    // flump3dec state, opaque here to keep its headers out of everyone else's
+    struct MP3Decoder;
+    std::unique_ptr<MP3Decoder> _mp3;
+};
+
+#endif // hifi_SoundStream_h
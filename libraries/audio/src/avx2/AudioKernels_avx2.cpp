@@ -0,0 +1,182 @@
+//
+//  AudioKernels_avx2.cpp
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <assert.h>
+#include <immintrin.h>
+
+#include "../AudioDynamics.h"
+#include "../AudioKernels.h"
+
+// signed (a * b) >> 32, for each 32-bit lane
+static inline __m256i mulhi_epi32(__m256i a, __m256i b) {
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epi32(a, b), 32);
+    __m256i odd = _mm256_mul_epi32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    return _mm256_blend_epi32(even, odd, 0xaa);
+}
+
+// -log2(x) of the absolute float bits in each lane, matching peaklog2() exactly
+static inline __m256i peaklog2_AVX2(__m256i peak) {
+
+    // split into e and x - 1.0
+    __m256i e = _mm256_sub_epi32(_mm256_set1_epi32(IEEE754_EXPN_BIAS + LOG2_HEADROOM),
+                                 _mm256_srli_epi32(peak, IEEE754_MANT_BITS));
+    __m256i x = _mm256_and_si256(_mm256_slli_epi32(peak, IEEE754_EXPN_BITS), _mm256_set1_epi32(0x7fffffff));
+
+    __m256i k = _mm256_srli_epi32(x, 31 - LOG2_TABBITS);
+    k = _mm256_add_epi32(k, _mm256_slli_epi32(k, 1));   // 3 coefs per entry
+
+    // polynomial for log2(1+x) over x=[0,1]
+    __m256i c0 = _mm256_i32gather_epi32(&log2Table[0][0], k, 4);
+    __m256i c1 = _mm256_i32gather_epi32(&log2Table[0][1], k, 4);
+    __m256i c2 = _mm256_i32gather_epi32(&log2Table[0][2], k, 4);
+
+    c1 = _mm256_add_epi32(c1, mulhi_epi32(c0, x));
+    c2 = _mm256_add_epi32(c2, mulhi_epi32(c1, x));
+
+    // reconstruct result in Q26
+    __m256i result = _mm256_sub_epi32(_mm256_slli_epi32(e, LOG2_FRACBITS), _mm256_srai_epi32(c2, 3));
+
+    // saturate when e > 31 or e < 0
+    __m256i saturated = _mm256_andnot_si256(_mm256_srai_epi32(e, 31), _mm256_set1_epi32(0x7fffffff));
+    __m256i mask = _mm256_or_si256(_mm256_cmpgt_epi32(e, _mm256_set1_epi32(31)),
+                                   _mm256_cmpgt_epi32(_mm256_setzero_si256(), e));
+
+    return _mm256_blendv_epi8(result, saturated, mask);
+}
+
+void limiterPeak_AVX2(const float* input, int32_t* attn, int32_t threshold, int numChannels, int numFrames) {
+
+    assert(numChannels == 1 || numChannels == 2 || numChannels == 4);
+
+    const __m256i fabsMask = _mm256_set1_epi32(IEEE754_FABS_MASK);
+    const __m256i quadOrder = _mm256_setr_epi32(0, 4, 1, 5, 2, 6, 3, 7);
+    const __m256i thresh = _mm256_set1_epi32(threshold);
+
+    int n = 0;
+    for (; n < numFrames - 7; n += 8) {  // 8 frames per pass
+
+        __m256i peak;
+
+        if (numChannels == 1) {
+
+            peak = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)&input[n]), fabsMask);
+
+        } else if (numChannels == 2) {
+
+            __m256 x0 = _mm256_loadu_ps(&input[2*n+0]);
+            __m256 x1 = _mm256_loadu_ps(&input[2*n+8]);
+
+            // deinterleave, frames 0 1 4 5 2 3 6 7
+            __m256i u0 = _mm256_and_si256(_mm256_castps_si256(_mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(2,0,2,0))), fabsMask);
+            __m256i u1 = _mm256_and_si256(_mm256_castps_si256(_mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3,1,3,1))), fabsMask);
+
+            // max absolute value
+            peak = _mm256_permute4x64_epi64(_mm256_max_epi32(u0, u1), _MM_SHUFFLE(3,1,2,0));
+
+        } else {
+
+            __m256 x0 = _mm256_loadu_ps(&input[4*n+0]);
+            __m256 x1 = _mm256_loadu_ps(&input[4*n+8]);
+            __m256 x2 = _mm256_loadu_ps(&input[4*n+16]);
+            __m256 x3 = _mm256_loadu_ps(&input[4*n+24]);
+
+            // max over channel pairs
+            __m256i m0 = _mm256_max_epi32(
+                _mm256_and_si256(_mm256_castps_si256(_mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(2,0,2,0))), fabsMask),
+                _mm256_and_si256(_mm256_castps_si256(_mm256_shuffle_ps(x0, x1, _MM_SHUFFLE(3,1,3,1))), fabsMask));
+            __m256i m1 = _mm256_max_epi32(
+                _mm256_and_si256(_mm256_castps_si256(_mm256_shuffle_ps(x2, x3, _MM_SHUFFLE(2,0,2,0))), fabsMask),
+                _mm256_and_si256(_mm256_castps_si256(_mm256_shuffle_ps(x2, x3, _MM_SHUFFLE(3,1,3,1))), fabsMask));
+
+            // max over all channels, frames 0 2 4 6 1 3 5 7
+            __m256 f0 = _mm256_castsi256_ps(m0);
+            __m256 f1 = _mm256_castsi256_ps(m1);
+            peak = _mm256_max_epi32(_mm256_castps_si256(_mm256_shuffle_ps(f0, f1, _MM_SHUFFLE(2,0,2,0))),
+                                    _mm256_castps_si256(_mm256_shuffle_ps(f0, f1, _MM_SHUFFLE(3,1,3,1))));
+
+            peak = _mm256_permutevar8x32_epi32(peak, quadOrder);
+        }
+
+        // compute limiter attenuation
+        __m256i a = _mm256_max_epi32(_mm256_sub_epi32(thresh, peaklog2_AVX2(peak)), _mm256_setzero_si256());
+        _mm256_storeu_si256((__m256i*)&attn[n], a);
+    }
+
+    // remaining frames
+    if (n < numFrames) {
+        limiterPeak_ref(&input[numChannels*n], &attn[n], threshold, numChannels, numFrames - n);
+    }
+}
+
+void limiterOutput_AVX2(const float* input, const float* gain, const float* dither, int16_t* output,
+                        int numChannels, int numFrames) {
+
+    assert(numChannels == 1 || numChannels == 2 || numChannels == 4);
+
+    // replicate the per-frame gain and dither across the channels of each frame
+    const __m256i stereoOrder = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    const __m256i quadOrder = _mm256_setr_epi32(0, 0, 0, 0, 1, 1, 1, 1);
+
+    const int framesPerPass = 8 / numChannels;
+
+    int n = 0;
+    for (; n < numFrames - (framesPerPass - 1); n += framesPerPass) {
+
+        __m256 g, d;
+
+        if (numChannels == 1) {
+            g = _mm256_loadu_ps(&gain[n]);
+            d = _mm256_loadu_ps(&dither[n]);
+        } else if (numChannels == 2) {
+            g = _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(&gain[n])), stereoOrder);
+            d = _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_loadu_ps(&dither[n])), stereoOrder);
+        } else {
+            g = _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_castpd_ps(_mm_load_sd((const double*)&gain[n]))), quadOrder);
+            d = _mm256_permutevar8x32_ps(_mm256_castps128_ps256(_mm_castpd_ps(_mm_load_sd((const double*)&dither[n]))), quadOrder);
+        }
+
+        // apply gain and dither
+        __m256 x = _mm256_loadu_ps(&input[numChannels*n]);
+        x = _mm256_add_ps(_mm256_mul_ps(x, g), d);
+
+        // round to nearest and store 16-bit output
+        // the limiter output never exceeds 16 bits, so saturation matches the scalar conversion
+        __m256i i = _mm256_cvtps_epi32(x);
+        __m128i s = _mm_packs_epi32(_mm256_castsi256_si128(i), _mm256_extracti128_si256(i, 1));
+        _mm_storeu_si128((__m128i*)&output[numChannels*n], s);
+    }
+
+    // remaining frames
+    if (n < numFrames) {
+        limiterOutput_ref(&input[numChannels*n], &gain[n], &dither[n], &output[numChannels*n], numChannels, numFrames - n);
+    }
+}
+
+void reverbMix_AVX2(const float* dry, const float* wet, float* output, float mix, int numFrames) {
+
+    const __m256 m = _mm256_set1_ps(mix);
+
+    int n = 0;
+    for (; n < numFrames - 7; n += 8) {
+        __m256 x = _mm256_loadu_ps(&dry[n]);
+        __m256 y = _mm256_loadu_ps(&wet[n]);
+        _mm256_storeu_ps(&output[n], _mm256_add_ps(x, _mm256_mul_ps(_mm256_sub_ps(y, x), m)));
+    }
+
+    // remaining frames
+    if (n < numFrames) {
+        reverbMix_ref(&dry[n], &wet[n], &output[n], mix, numFrames - n);
+    }
+}
+
+#endif
@@ -0,0 +1,156 @@
+//
+//  AudioFOA_neon.cpp
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <assert.h>
+#include <arm_neon.h>
+
+#include "../AudioFOA.h"
+
+//
+// These follow the operation order of the scalar reference code, so the results match it exactly
+// as long as the compiler does not contract either one into fused multiply-adds.
+//
+
+// fft-domain complex multiply-add, for packed complex-conjugate symmetric
+// 1 channel input, 2 channel output
+void rfft512_cmadd_1X2_NEON(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]) {
+
+    // NOTE: x[n/2].re is packed into x[0].im
+    dst0[0] += src[0] * coef0[0];   // first bin is real
+    dst0[1] += src[1] * coef0[1];   // last bin is real
+
+    dst1[0] += src[0] * coef1[0];   // first bin is real
+    dst1[1] += src[1] * coef1[1];   // last bin is real
+
+    int i = 1;
+    for (; i < 512/2 - 3; i += 4) {
+
+        // deinterleaving loads of 4 complex bins
+        float32x4x2_t x = vld2q_f32(&src[2*i]);
+        float32x4x2_t c0 = vld2q_f32(&coef0[2*i]);
+        float32x4x2_t c1 = vld2q_f32(&coef1[2*i]);
+        float32x4x2_t y0 = vld2q_f32(&dst0[2*i]);
+        float32x4x2_t y1 = vld2q_f32(&dst1[2*i]);
+
+        y0.val[0] = vaddq_f32(y0.val[0], vsubq_f32(vmulq_f32(x.val[0], c0.val[0]), vmulq_f32(x.val[1], c0.val[1])));   // re
+        y0.val[1] = vaddq_f32(y0.val[1], vaddq_f32(vmulq_f32(x.val[0], c0.val[1]), vmulq_f32(x.val[1], c0.val[0])));   // im
+
+        y1.val[0] = vaddq_f32(y1.val[0], vsubq_f32(vmulq_f32(x.val[0], c1.val[0]), vmulq_f32(x.val[1], c1.val[1])));   // re
+        y1.val[1] = vaddq_f32(y1.val[1], vaddq_f32(vmulq_f32(x.val[0], c1.val[1]), vmulq_f32(x.val[1], c1.val[0])));   // im
+
+        vst2q_f32(&dst0[2*i], y0);
+        vst2q_f32(&dst1[2*i], y1);
+    }
+
+    // remaining bins
+    for (; i < 512/2; i++) {
+        dst0[2*i+0] += src[2*i+0] * coef0[2*i+0] - src[2*i+1] * coef0[2*i+1];   // re
+        dst0[2*i+1] += src[2*i+0] * coef0[2*i+1] + src[2*i+1] * coef0[2*i+0];   // im
+
+        dst1[2*i+0] += src[2*i+0] * coef1[2*i+0] - src[2*i+1] * coef1[2*i+1];   // re
+        dst1[2*i+1] += src[2*i+0] * coef1[2*i+1] + src[2*i+1] * coef1[2*i+0];   // im
+    }
+}
+
+// convert to deinterleaved float (B-format)
+void convertInput_NEON(int16_t* src, float *dst[4], float gain, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+#ifdef FOA_INPUT_FUMA   // input is FuMa (B-format) channel order and normalization
+
+    const float scaleW = gain * (1/32768.0f);
+    const float scale = gain * (1/32768.0f);
+
+    const int order[4] = { 0, 1, 2, 3 };    // W, X, Y, Z
+
+#else   // input is ambiX (ACN/SN3D) channel order and normalization
+
+    const float scaleW = gain * (1/32768.0f) * 0.707106781f;    // -3dB
+    const float scale = gain * (1/32768.0f);
+
+    const int order[4] = { 0, 2, 3, 1 };    // W, Y, Z, X
+
+#endif
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        int16x4x4_t x = vld4_s16(&src[4*i]);   // deinterleaving load
+
+        vst1q_f32(&dst[order[0]][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(x.val[0])), scaleW));
+        vst1q_f32(&dst[order[1]][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(x.val[1])), scale));
+        vst1q_f32(&dst[order[2]][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(x.val[2])), scale));
+        vst1q_f32(&dst[order[3]][i], vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(x.val[3])), scale));
+    }
+}
+
+// in-place rotation and scaling of the soundfield
+// crossfade between old and new matrix, to prevent artifacts
+void rotate_4x4_NEON(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    // matrix difference
+    const float32x4_t md00 = vdupq_n_f32(m0[0][0] - m1[0][0]);
+
+    const float32x4_t md11 = vdupq_n_f32(m0[1][1] - m1[1][1]);
+    const float32x4_t md21 = vdupq_n_f32(m0[2][1] - m1[2][1]);
+    const float32x4_t md31 = vdupq_n_f32(m0[3][1] - m1[3][1]);
+
+    const float32x4_t md12 = vdupq_n_f32(m0[1][2] - m1[1][2]);
+    const float32x4_t md22 = vdupq_n_f32(m0[2][2] - m1[2][2]);
+    const float32x4_t md32 = vdupq_n_f32(m0[3][2] - m1[3][2]);
+
+    const float32x4_t md13 = vdupq_n_f32(m0[1][3] - m1[1][3]);
+    const float32x4_t md23 = vdupq_n_f32(m0[2][3] - m1[2][3]);
+    const float32x4_t md33 = vdupq_n_f32(m0[3][3] - m1[3][3]);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t frac = vld1q_f32(&win[i]);
+
+        // interpolate the matrix
+        float32x4_t m00 = vaddq_f32(vdupq_n_f32(m1[0][0]), vmulq_f32(frac, md00));
+
+        float32x4_t m11 = vaddq_f32(vdupq_n_f32(m1[1][1]), vmulq_f32(frac, md11));
+        float32x4_t m21 = vaddq_f32(vdupq_n_f32(m1[2][1]), vmulq_f32(frac, md21));
+        float32x4_t m31 = vaddq_f32(vdupq_n_f32(m1[3][1]), vmulq_f32(frac, md31));
+
+        float32x4_t m12 = vaddq_f32(vdupq_n_f32(m1[1][2]), vmulq_f32(frac, md12));
+        float32x4_t m22 = vaddq_f32(vdupq_n_f32(m1[2][2]), vmulq_f32(frac, md22));
+        float32x4_t m32 = vaddq_f32(vdupq_n_f32(m1[3][2]), vmulq_f32(frac, md32));
+
+        float32x4_t m13 = vaddq_f32(vdupq_n_f32(m1[1][3]), vmulq_f32(frac, md13));
+        float32x4_t m23 = vaddq_f32(vdupq_n_f32(m1[2][3]), vmulq_f32(frac, md23));
+        float32x4_t m33 = vaddq_f32(vdupq_n_f32(m1[3][3]), vmulq_f32(frac, md33));
+
+        float32x4_t b0 = vld1q_f32(&buf[0][i]);
+        float32x4_t b1 = vld1q_f32(&buf[1][i]);
+        float32x4_t b2 = vld1q_f32(&buf[2][i]);
+        float32x4_t b3 = vld1q_f32(&buf[3][i]);
+
+        // matrix multiply
+        float32x4_t w = vmulq_f32(m00, b0);
+
+        float32x4_t x = vaddq_f32(vaddq_f32(vmulq_f32(m11, b1), vmulq_f32(m12, b2)), vmulq_f32(m13, b3));
+        float32x4_t y = vaddq_f32(vaddq_f32(vmulq_f32(m21, b1), vmulq_f32(m22, b2)), vmulq_f32(m23, b3));
+        float32x4_t z = vaddq_f32(vaddq_f32(vmulq_f32(m31, b1), vmulq_f32(m32, b2)), vmulq_f32(m33, b3));
+
+        vst1q_f32(&buf[0][i], w);
+        vst1q_f32(&buf[1][i], x);
+        vst1q_f32(&buf[2][i], y);
+        vst1q_f32(&buf[3][i], z);
+    }
+}
+
+#endif
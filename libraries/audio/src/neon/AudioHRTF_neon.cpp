@@ -0,0 +1,199 @@
+//
+//  AudioHRTF_neon.cpp
+//  libraries/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <assert.h>
+#include <arm_neon.h>
+
+#include "../AudioHRTF.h"
+
+//
+// These follow the operation order of the scalar reference code, so the results match it exactly
+// as long as the compiler does not contract either one into fused multiply-adds.
+//
+
+// 1 channel input, 4 channel output
+void FIR_1x4_NEON(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        float32x4_t acc2 = vdupq_n_f32(0.0f);
+        float32x4_t acc3 = vdupq_n_f32(0.0f);
+
+        float* ps = &src[i - HRTF_TAPS + 1];    // process forwards
+
+        static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            float32x4_t x0 = vld1q_f32(&ps[k+0]);
+            float32x4_t x1 = vld1q_f32(&ps[k+1]);
+            float32x4_t x2 = vld1q_f32(&ps[k+2]);
+            float32x4_t x3 = vld1q_f32(&ps[k+3]);
+
+            float32x4_t t0 = vmulq_n_f32(x0, coef0[-k-0]);
+            float32x4_t t1 = vmulq_n_f32(x0, coef1[-k-0]);
+            float32x4_t t2 = vmulq_n_f32(x0, coef2[-k-0]);
+            float32x4_t t3 = vmulq_n_f32(x0, coef3[-k-0]);
+
+            t0 = vaddq_f32(t0, vmulq_n_f32(x1, coef0[-k-1]));
+            t1 = vaddq_f32(t1, vmulq_n_f32(x1, coef1[-k-1]));
+            t2 = vaddq_f32(t2, vmulq_n_f32(x1, coef2[-k-1]));
+            t3 = vaddq_f32(t3, vmulq_n_f32(x1, coef3[-k-1]));
+
+            t0 = vaddq_f32(t0, vmulq_n_f32(x2, coef0[-k-2]));
+            t1 = vaddq_f32(t1, vmulq_n_f32(x2, coef1[-k-2]));
+            t2 = vaddq_f32(t2, vmulq_n_f32(x2, coef2[-k-2]));
+            t3 = vaddq_f32(t3, vmulq_n_f32(x2, coef3[-k-2]));
+
+            t0 = vaddq_f32(t0, vmulq_n_f32(x3, coef0[-k-3]));
+            t1 = vaddq_f32(t1, vmulq_n_f32(x3, coef1[-k-3]));
+            t2 = vaddq_f32(t2, vmulq_n_f32(x3, coef2[-k-3]));
+            t3 = vaddq_f32(t3, vmulq_n_f32(x3, coef3[-k-3]));
+
+            acc0 = vaddq_f32(acc0, t0);
+            acc1 = vaddq_f32(acc1, t1);
+            acc2 = vaddq_f32(acc2, t2);
+            acc3 = vaddq_f32(acc3, t3);
+        }
+
+        vst1q_f32(&dst0[i], acc0);
+        vst1q_f32(&dst1[i], acc1);
+        vst1q_f32(&dst2[i], acc2);
+        vst1q_f32(&dst3[i], acc3);
+    }
+}
+
+// 4 channel planar to interleaved
+void interleave_4x4_NEON(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4x4_t x;
+        x.val[0] = vld1q_f32(&src0[i]);
+        x.val[1] = vld1q_f32(&src1[i]);
+        x.val[2] = vld1q_f32(&src2[i]);
+        x.val[3] = vld1q_f32(&src3[i]);
+
+        vst4q_f32(&dst[4*i], x);    // interleaving store
+    }
+}
+
+// process 2 cascaded biquads on 4 channels (interleaved)
+// biquads computed in parallel, by adding one sample of delay
+void biquad2_4x4_NEON(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames) {
+
+    const float32x4_t denormal = vdupq_n_f32(1.0e-20f);
+
+    // restore state
+    float32x4_t y00 = vld1q_f32(&state[0][0]);
+    float32x4_t w10 = vld1q_f32(&state[1][0]);
+    float32x4_t w20 = vld1q_f32(&state[2][0]);
+
+    float32x4_t y01;
+    float32x4_t w11 = vld1q_f32(&state[1][4]);
+    float32x4_t w21 = vld1q_f32(&state[2][4]);
+
+    // first biquad coefs
+    float32x4_t b00 = vld1q_f32(&coef[0][0]);
+    float32x4_t b10 = vld1q_f32(&coef[1][0]);
+    float32x4_t b20 = vld1q_f32(&coef[2][0]);
+    float32x4_t a10 = vld1q_f32(&coef[3][0]);
+    float32x4_t a20 = vld1q_f32(&coef[4][0]);
+
+    // second biquad coefs
+    float32x4_t b01 = vld1q_f32(&coef[0][4]);
+    float32x4_t b11 = vld1q_f32(&coef[1][4]);
+    float32x4_t b21 = vld1q_f32(&coef[2][4]);
+    float32x4_t a11 = vld1q_f32(&coef[3][4]);
+    float32x4_t a21 = vld1q_f32(&coef[4][4]);
+
+    for (int i = 0; i < numFrames; i++) {
+
+        float32x4_t x00 = vaddq_f32(vld1q_f32(&src[4*i]), denormal);  // prevent denormals
+        float32x4_t x01 = y00;  // first biquad output
+
+        // transposed Direct Form II
+        y00 = vaddq_f32(vmulq_f32(b00, x00), w10);
+        y01 = vaddq_f32(vmulq_f32(b01, x01), w11);
+
+        w10 = vaddq_f32(vsubq_f32(vmulq_f32(b10, x00), vmulq_f32(a10, y00)), w20);
+        w11 = vaddq_f32(vsubq_f32(vmulq_f32(b11, x01), vmulq_f32(a11, y01)), w21);
+
+        w20 = vsubq_f32(vmulq_f32(b20, x00), vmulq_f32(a20, y00));
+        w21 = vsubq_f32(vmulq_f32(b21, x01), vmulq_f32(a21, y01));
+
+        vst1q_f32(&dst[4*i], y01);  // second biquad output
+    }
+
+    // save state
+    vst1q_f32(&state[0][0], y00);
+    vst1q_f32(&state[1][0], w10);
+    vst1q_f32(&state[2][0], w20);
+
+    vst1q_f32(&state[1][4], w11);
+    vst1q_f32(&state[2][4], w21);
+}
+
+// crossfade 4 inputs into 2 outputs with accumulation (interleaved)
+void crossfade_4x2_NEON(float* src, float* dst, const float* win, int numFrames) {
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t frac = vld1q_f32(&win[i]);
+
+        float32x4x4_t x = vld4q_f32(&src[4*i]);     // deinterleaving load
+        float32x4x2_t y = vld2q_f32(&dst[2*i]);
+
+        // crossfade
+        float32x4_t x0 = vaddq_f32(x.val[2], vmulq_f32(frac, vsubq_f32(x.val[0], x.val[2])));
+        float32x4_t x1 = vaddq_f32(x.val[3], vmulq_f32(frac, vsubq_f32(x.val[1], x.val[3])));
+
+        // accumulate
+        y.val[0] = vaddq_f32(y.val[0], x0);
+        y.val[1] = vaddq_f32(y.val[1], x1);
+
+        vst2q_f32(&dst[2*i], y);    // interleaving store
+    }
+}
+
+// linear interpolation with gain
+void interpolate_NEON(const float* src0, const float* src1, float* dst, float frac, float gain) {
+
+    float32x4_t f0 = vdupq_n_f32(gain * (1.0f - frac));
+    float32x4_t f1 = vdupq_n_f32(gain * frac);
+
+    static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
+
+    for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+        float32x4_t x0 = vld1q_f32(&src0[k]);
+        float32x4_t x1 = vld1q_f32(&src1[k]);
+
+        vst1q_f32(&dst[k], vaddq_f32(vmulq_f32(f0, x0), vmulq_f32(f1, x1)));
+    }
+}
+
+#endif
@@ -11,6 +11,8 @@
 
 #include "Avatar.h"
 
+#include <limits>
+
 #include <QtCore/QThread>
 #include <glm/gtx/transform.hpp>
 #include <glm/gtx/vector_query.hpp>
@@ -53,6 +55,10 @@ const glm::vec3 HAND_TO_PALM_OFFSET(0.0f, 0.12f, 0.08f);
 const float Avatar::MYAVATAR_LOADING_PRIORITY = (float)M_PI; // Entity priority is computed as atan2(maxDim, distance) which is <= PI / 2
 const float Avatar::OTHERAVATAR_LOADING_PRIORITY = MYAVATAR_LOADING_PRIORITY - EPSILON;
 const float Avatar::ATTACHMENT_LOADING_PRIORITY = OTHERAVATAR_LOADING_PRIORITY - EPSILON;
+// about 30 pixels across for a full HD view 90 degrees high, 40 meters away for an avatar 2 meters tall
+const float Avatar::FAR_RENDER_LOD_ANGLE = 0.025f;
+// the avatars get back to the near level of detail a bit closer than they left it, so they don't flicker between the two
+const float NEAR_RENDER_LOD_ANGLE = 1.25f * Avatar::FAR_RENDER_LOD_ANGLE;
 
 namespace render {
     template <> const ItemKey payloadGetKey(const AvatarSharedPointer& avatar) {
@@ -133,6 +139,11 @@ void Avatar::setShowNamesAboveHeads(bool show) {
     showNamesAboveHeads = show;
 }
 
+static bool enableFarRenderLOD = true;
+void Avatar::setEnableFarRenderLOD(bool enabled) {
+    enableFarRenderLOD = enabled;
+}
+
 AvatarTransit::Status AvatarTransit::update(float deltaTime, const glm::vec3& avatarPosition, const AvatarTransit::TransitConfig& config) {
     float oneFrameDistance = _isActive ? glm::length(avatarPosition - _endPosition) : glm::length(avatarPosition - _lastPosition);
     if (oneFrameDistance > (config._minTriggerDistance * _scale)) {
@@ -647,7 +658,7 @@ void Avatar::addToScene(AvatarSharedPointer self, const render::ScenePointer& sc
     _skeletonModel->addToScene(scene, transaction, std::bind(&Avatar::metaBlendshapeOperator, _renderItemID, _1, _2, _3, _4));
     _skeletonModel->setTagMask(render::hifi::TAG_ALL_VIEWS);
     _skeletonModel->setGroupCulled(true);
-    _skeletonModel->setCanCastShadow(true);
+    _skeletonModel->setCanCastShadow(_renderLOD == RenderLOD::Near);
     _skeletonModel->setVisibleInScene(_isMeshVisible, scene);
 
     processMaterials();
@@ -657,7 +668,7 @@ void Avatar::addToScene(AvatarSharedPointer self, const render::ScenePointer& sc
         attachmentModel->setTagMask(render::hifi::TAG_ALL_VIEWS);
         attachmentModel->setGroupCulled(true);
         attachmentModel->setCanCastShadow(true);
-        attachmentModel->setVisibleInScene(_isMeshVisible, scene);
+        attachmentModel->setVisibleInScene(areAttachmentsVisible(), scene);
         attachmentRenderingNeedsUpdate = true;
     }
 
@@ -878,7 +889,7 @@ void Avatar::fixupModelsInScene(const render::ScenePointer& scene) {
 
         _skeletonModel->setTagMask(render::hifi::TAG_ALL_VIEWS);
         _skeletonModel->setGroupCulled(true);
-        _skeletonModel->setCanCastShadow(true);
+        _skeletonModel->setCanCastShadow(_renderLOD == RenderLOD::Near);
         _skeletonModel->setVisibleInScene(_isMeshVisible, scene);
 
         processMaterials();
@@ -894,7 +905,7 @@ void Avatar::fixupModelsInScene(const render::ScenePointer& scene) {
             attachmentModel->setTagMask(render::hifi::TAG_ALL_VIEWS);
             attachmentModel->setGroupCulled(true);
             attachmentModel->setCanCastShadow(true);
-            attachmentModel->setVisibleInScene(_isMeshVisible, scene);
+            attachmentModel->setVisibleInScene(areAttachmentsVisible(), scene);
             attachmentRenderingNeedsUpdate = true;
         }
     }
@@ -903,13 +914,23 @@ void Avatar::fixupModelsInScene(const render::ScenePointer& scene) {
         _skeletonModel->setVisibleInScene(_isMeshVisible, scene);
         for (auto attachmentModel : _attachmentModels) {
             if (attachmentModel->isRenderable()) {
-                attachmentModel->setVisibleInScene(_isMeshVisible, scene);
+                attachmentModel->setVisibleInScene(areAttachmentsVisible(), scene);
             }
         }
         updateRenderItem(transaction);
         _needMeshVisibleSwitch = false;
     }
 
+    if (_needRenderLODSwitch) {
+        _skeletonModel->setCanCastShadow(_renderLOD == RenderLOD::Near, scene);
+        for (auto attachmentModel : _attachmentModels) {
+            if (attachmentModel->isRenderable()) {
+                attachmentModel->setVisibleInScene(areAttachmentsVisible(), scene);
+            }
+        }
+        _needRenderLODSwitch = false;
+    }
+
     if (_mustFadeIn && canTryFade) {
         // Do it now to be sure all the sub items are ready and the fade is sent to them too
         fade(transaction, render::Transition::USER_ENTER_DOMAIN);
@@ -980,6 +1001,24 @@ float Avatar::getBoundingRadius() const {
     return getBounds().getLargestDimension() / 2.0f;
 }
 
+void Avatar::updateRenderLOD(const ConicalViewFrustums& views) {
+    RenderLOD renderLOD = RenderLOD::Near;
+    if (enableFarRenderLOD && !views.empty()) {
+        glm::vec3 position = getWorldPosition();
+        float distance = std::numeric_limits<float>::max();
+        for (const auto& view : views) {
+            distance = std::min(distance, glm::distance(view.getPosition(), position));
+        }
+        float angle = getBoundingRadius() / std::max(distance, EPSILON);
+        float threshold = _renderLOD == RenderLOD::Far ? NEAR_RENDER_LOD_ANGLE : FAR_RENDER_LOD_ANGLE;
+        renderLOD = angle < threshold ? RenderLOD::Far : RenderLOD::Near;
+    }
+    if (renderLOD != _renderLOD) {
+        _renderLOD = renderLOD;
+        _needRenderLODSwitch = true;
+    }
+}
+
 #ifdef DEBUG
 void debugValue(const QString& str, const glm::vec3& value) {
     if (glm::any(glm::isnan(value)) || glm::any(glm::isinf(value))) {
@@ -1076,7 +1115,10 @@ void Avatar::renderDisplayName(gpu::Batch& batch, const ViewFrustum& view, const
     }
 
     // Compute display name extent/position offset
-    static TextRenderer3D* displayNameRenderer = TextRenderer3D::getInstance(ROBOTO_FONT_FAMILY);
+    if (!_displayNameRenderer) {
+        _displayNameRenderer.reset(TextRenderer3D::getInstance(ROBOTO_FONT_FAMILY));
+    }
+    auto& displayNameRenderer = _displayNameRenderer;
     const glm::vec2 extent = displayNameRenderer->computeExtent(renderedDisplayName);
     if (!glm::any(glm::isCompNull(extent, EPSILON))) {
         const QRect nameDynamicRect = QRect(0, 0, (int)extent.x, (int)extent.y);
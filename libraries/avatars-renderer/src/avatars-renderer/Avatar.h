@@ -31,6 +31,7 @@
 
 #include <Grab.h>
 #include <ThreadSafeValueCache.h>
+#include <shared/ConicalViewFrustum.h>
 
 #include "Head.h"
 #include "SkeletonModel.h"
@@ -60,6 +61,7 @@ enum ScreenTintLayer {
 };
 
 class Texture;
+class TextRenderer3D;
 
 class AvatarTransit {
 public:
@@ -97,7 +99,7 @@ public:
     Status update(float deltaTime, const glm::vec3& avatarPosition, const TransitConfig& config);
     void slamPosition(const glm::vec3& avatarPosition);
     Status getStatus() { return _status; }
-    bool isActive() { return _isActive; }
+    bool isActive() const { return _isActive; }
     glm::vec3 getCurrentPosition() { return _currentPosition; }
     glm::vec3 getEndPosition() { return _endPosition; }
     void setScale(float scale) { _scale = scale; }
@@ -147,6 +149,7 @@ public:
     static void setShowOtherLookAtTarget(bool showOthers);
     static void setShowCollisionShapes(bool render);
     static void setShowNamesAboveHeads(bool show);
+    static void setEnableFarRenderLOD(bool enabled);
 
     explicit Avatar(QThread* thread);
     virtual ~Avatar();
@@ -185,6 +188,18 @@ public:
     /// Returns the distance to use as a LOD parameter.
     float getLODDistance() const;
 
+    // The avatars that only cover a few pixels from the closest view are drawn at the far level of detail: their skeleton
+    // doesn't cast shadows, and their attachments are hidden. OtherAvatar also updates their joints and avatar entities
+    // less often. Their meshes are already drawn at their coarsest baked levels of detail.
+    enum class RenderLOD : uint8_t {
+        Near,
+        Far
+    };
+    void updateRenderLOD(const ConicalViewFrustums& views);
+    RenderLOD getRenderLOD() const { return _renderLOD; }
+    // the angle, from the view, below which the avatar's bounding radius is drawn at the far level of detail
+    static const float FAR_RENDER_LOD_ANGLE;
+
     virtual void createOrb() { }
 
     enum class LoadingStatus {
@@ -746,6 +761,7 @@ protected:
 
     float _displayNameTargetAlpha { 1.0f };
     float _displayNameAlpha { 1.0f };
+    mutable std::shared_ptr<TextRenderer3D> _displayNameRenderer; // each avatar's own, so its name stays laid out across frames
 
     ThreadSafeValueCache<float> _unscaledEyeHeightCache { DEFAULT_AVATAR_EYE_HEIGHT };
     float _spine2SplineRatio { DEFAULT_SPINE2_SPLINE_PROPORTION };
@@ -760,6 +776,10 @@ protected:
     bool _isMeshVisible{ true };
     bool _needMeshVisibleSwitch{ true };
 
+    bool areAttachmentsVisible() const { return _isMeshVisible && _renderLOD == RenderLOD::Near; }
+    RenderLOD _renderLOD { RenderLOD::Near };
+    bool _needRenderLODSwitch { false };
+
     static const float MYAVATAR_LOADING_PRIORITY;
     static const float OTHERAVATAR_LOADING_PRIORITY;
     static const float ATTACHMENT_LOADING_PRIORITY;
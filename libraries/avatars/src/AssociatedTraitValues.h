@@ -197,7 +197,8 @@ namespace AvatarTraits {
                                                  instancesVector.end(),
                                                  [&instanceID](InstanceIDValuePair& idValuePair){
                                                      return idValuePair.id == instanceID;
-                                                 }));
+                                                 }),
+                                  instancesVector.end());
         }
     }
 
@@ -59,6 +59,7 @@ static const int HAND_CONTROLLER_COMPRESSION_RADIX = 12;
 static const int SENSOR_TO_WORLD_SCALE_RADIX = 10;
 static const float AUDIO_LOUDNESS_SCALE = 1024.0f;
 static const float DEFAULT_AVATAR_DENSITY = 1000.0f; // density of water
+static const size_t PACKED_JOINT_TRANSLATION_SIZE = 3 * sizeof(int16_t);
 
 #define ASSERT(COND)  do { if (!(COND)) { abort(); } } while(0)
 
@@ -72,6 +73,7 @@ size_t AvatarDataPacket::maxJointDataSize(size_t numJoints) {
     size_t totalSize = sizeof(uint8_t); // numJoints
 
     totalSize += validityBitsSize; // Orientations mask
+    totalSize += validityBitsSize; // Compact orientations mask
     totalSize += numJoints * sizeof(SixByteQuat); // Orientations
     totalSize += validityBitsSize; // Translations mask
     totalSize += sizeof(float); // maxTranslationDimension
@@ -85,6 +87,7 @@ size_t AvatarDataPacket::minJointDataSize(size_t numJoints) {
     size_t totalSize = sizeof(uint8_t); // numJoints
 
     totalSize += validityBitsSize; // Orientations mask
+    totalSize += validityBitsSize; // Compact orientations mask
     // assume no valid rotations
     totalSize += validityBitsSize; // Translations mask
     totalSize += sizeof(float); // maxTranslationDimension
@@ -282,6 +285,51 @@ QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dro
     return avatarByteArray;
 }
 
+static void packSensorToWorldMatrix(AvatarDataPacket::SensorToWorldMatrix* data, const glm::mat4& sensorToWorldMatrix) {
+    packOrientationQuatToSixBytes(data->sensorToWorldQuat, glmExtractRotation(sensorToWorldMatrix));
+    glm::vec3 scale = extractScale(sensorToWorldMatrix);
+    packFloatScalarToSignedTwoByteFixed((uint8_t*)&data->sensorToWorldScale, scale.x, SENSOR_TO_WORLD_SCALE_RADIX);
+    data->sensorToWorldTrans[0] = sensorToWorldMatrix[3][0];
+    data->sensorToWorldTrans[1] = sensorToWorldMatrix[3][1];
+    data->sensorToWorldTrans[2] = sensorToWorldMatrix[3][2];
+}
+
+static int packHandControllers(uint8_t* destinationBuffer, const glm::mat4& leftHandMatrix, const glm::mat4& rightHandMatrix) {
+    auto startSection = destinationBuffer;
+
+    Transform controllerLeftHandTransform = Transform(leftHandMatrix);
+    destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, controllerLeftHandTransform.getRotation());
+    destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, controllerLeftHandTransform.getTranslation(), HAND_CONTROLLER_COMPRESSION_RADIX);
+
+    Transform controllerRightHandTransform = Transform(rightHandMatrix);
+    destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, controllerRightHandTransform.getRotation());
+    destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, controllerRightHandTransform.getTranslation(), HAND_CONTROLLER_COMPRESSION_RADIX);
+
+    return destinationBuffer - startSection;
+}
+
+// the accuracy of a rotation packed by packOrientationQuatToFourBytes(), as its dot product with the exact rotation
+static float compactRotationDot(const glm::quat& rotation) {
+    AvatarDataPacket::FourByteQuat packed;
+    packOrientationQuatToFourBytes(packed, rotation);
+    glm::quat unpacked;
+    unpackOrientationQuatFromFourBytes(packed, unpacked);
+    return fabsf(glm::dot(unpacked, rotation));
+}
+
+static float computeMaxTranslationDimension(const QVector<JointData>& jointData, int firstJoint) {
+    float maxTranslationDimension = 0.001f;
+    for (int i = firstJoint; i < jointData.size(); ++i) {
+        const JointData& data = jointData[i];
+        if (!data.translationIsDefaultPose) {
+            maxTranslationDimension = glm::max(fabsf(data.translation.x), maxTranslationDimension);
+            maxTranslationDimension = glm::max(fabsf(data.translation.y), maxTranslationDimension);
+            maxTranslationDimension = glm::max(fabsf(data.translation.z), maxTranslationDimension);
+        }
+    }
+    return maxTranslationDimension;
+}
+
 QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSentTime,
                                    const QVector<JointData>& lastSentJointData, AvatarDataPacket::SendStatus& sendStatus,
                                    bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
@@ -491,8 +539,13 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     IF_AVATAR_SPACE(PACKET_HAS_AVATAR_ORIENTATION, sizeof(AvatarDataPacket::SixByteQuat)) {
         auto startSection = destinationBuffer;
-        auto localOrientation = getOrientationOutbound();
-        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, localOrientation);
+        if (_encodingCache.isValid) {
+            memcpy(destinationBuffer, _encodingCache.orientation, sizeof(AvatarDataPacket::SixByteQuat));
+            destinationBuffer += sizeof(AvatarDataPacket::SixByteQuat);
+        } else {
+            auto localOrientation = getOrientationOutbound();
+            destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, localOrientation);
+        }
 
         int numBytes = destinationBuffer - startSection;
         if (outboundDataRateOut) {
@@ -536,14 +589,12 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     IF_AVATAR_SPACE(PACKET_HAS_SENSOR_TO_WORLD_MATRIX, sizeof(AvatarDataPacket::SensorToWorldMatrix)) {
         auto startSection = destinationBuffer;
-        auto data = reinterpret_cast<AvatarDataPacket::SensorToWorldMatrix*>(destinationBuffer);
-        glm::mat4 sensorToWorldMatrix = getSensorToWorldMatrix();
-        packOrientationQuatToSixBytes(data->sensorToWorldQuat, glmExtractRotation(sensorToWorldMatrix));
-        glm::vec3 scale = extractScale(sensorToWorldMatrix);
-        packFloatScalarToSignedTwoByteFixed((uint8_t*)&data->sensorToWorldScale, scale.x, SENSOR_TO_WORLD_SCALE_RADIX);
-        data->sensorToWorldTrans[0] = sensorToWorldMatrix[3][0];
-        data->sensorToWorldTrans[1] = sensorToWorldMatrix[3][1];
-        data->sensorToWorldTrans[2] = sensorToWorldMatrix[3][2];
+        if (_encodingCache.isValid) {
+            memcpy(destinationBuffer, &_encodingCache.sensorToWorld, sizeof(AvatarDataPacket::SensorToWorldMatrix));
+        } else {
+            auto data = reinterpret_cast<AvatarDataPacket::SensorToWorldMatrix*>(destinationBuffer);
+            packSensorToWorldMatrix(data, getSensorToWorldMatrix());
+        }
         destinationBuffer += sizeof(AvatarDataPacket::SensorToWorldMatrix);
 
         int numBytes = destinationBuffer - startSection;
@@ -641,13 +692,12 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
     IF_AVATAR_SPACE(PACKET_HAS_HAND_CONTROLLERS, AvatarDataPacket::HAND_CONTROLLERS_SIZE) {
         auto startSection = destinationBuffer;
 
-        Transform controllerLeftHandTransform = Transform(getControllerLeftHandMatrix());
-        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, controllerLeftHandTransform.getRotation());
-        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, controllerLeftHandTransform.getTranslation(), HAND_CONTROLLER_COMPRESSION_RADIX);
-
-        Transform controllerRightHandTransform = Transform(getControllerRightHandMatrix());
-        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, controllerRightHandTransform.getRotation());
-        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, controllerRightHandTransform.getTranslation(), HAND_CONTROLLER_COMPRESSION_RADIX);
+        if (_encodingCache.isValid) {
+            memcpy(destinationBuffer, _encodingCache.handControllers, AvatarDataPacket::HAND_CONTROLLERS_SIZE);
+            destinationBuffer += AvatarDataPacket::HAND_CONTROLLERS_SIZE;
+        } else {
+            destinationBuffer += packHandControllers(destinationBuffer, getControllerLeftHandMatrix(), getControllerRightHandMatrix());
+        }
 
         int numBytes = destinationBuffer - startSection;
         if (outboundDataRateOut) {
@@ -680,8 +730,12 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     QVector<JointData> jointData;
     if (wantedFlags & (AvatarDataPacket::PACKET_HAS_JOINT_DATA | AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS)) {
-        QReadLocker readLock(&_jointDataLock);
-        jointData = _jointData;
+        if (_encodingCache.isValid) {
+            jointData = _encodingCache.jointData;
+        } else {
+            QReadLocker readLock(&_jointDataLock);
+            jointData = _jointData;
+        }
     }
     const int numJoints = jointData.size();
     assert(numJoints <= 255);
@@ -695,16 +749,14 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         auto startSection = destinationBuffer;
 
+        // the cached translations are only scaled correctly for a message that starts at the first joint
+        const uint8_t* cachedRotations = _encodingCache.isValid ? _encodingCache.jointRotations.data() : nullptr;
+        const uint8_t* cachedTranslations = (_encodingCache.isValid && sendStatus.translationsSent == 0) ?
+            _encodingCache.jointTranslations.data() : nullptr;
+
         // compute maxTranslationDimension before we send any joint data.
-        float maxTranslationDimension = 0.001f;
-        for (int i = sendStatus.translationsSent; i < numJoints; ++i) {
-            const JointData& data = jointData[i];
-            if (!data.translationIsDefaultPose) {
-                maxTranslationDimension = glm::max(fabsf(data.translation.x), maxTranslationDimension);
-                maxTranslationDimension = glm::max(fabsf(data.translation.y), maxTranslationDimension);
-                maxTranslationDimension = glm::max(fabsf(data.translation.z), maxTranslationDimension);
-            }
-        }
+        float maxTranslationDimension = cachedTranslations ? _encodingCache.maxTranslationDimension :
+            computeMaxTranslationDimension(jointData, sendStatus.translationsSent);
 
         // joint rotation data
         *destinationBuffer++ = (uint8_t)numJoints;
@@ -719,6 +771,10 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
         destinationBuffer += jointBitVectorSize; // Move pointer past the validity bytes
 
+        unsigned char* compactPosition = destinationBuffer;
+        memset(compactPosition, 0, jointBitVectorSize);
+        destinationBuffer += jointBitVectorSize; // Move pointer past the compact rotation bytes
+
         // sentJointDataOut and lastSentJointData might be the same vector
         if (sentJointDataOut) {
             sentJointDataOut->resize(numJoints); // Make sure the destination is resized before using it
@@ -743,10 +799,41 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #ifdef WANT_DEBUG
                         rotationSentCount++;
 #endif
-                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                        // the four byte packing is used when its error would be culled as too small to send anyway
+                        float compactDot = 0.0f;
+                        if (_compactJointRotations) {
+                            compactDot = cachedRotations ? _encodingCache.jointCompactRotationDots[i] : compactRotationDot(data.rotation);
+                        }
+
+                        unsigned char* rotationStart = destinationBuffer;
+                        bool isCompact = compactDot >= minRotationDOT;
+                        if (isCompact) {
+                            compactPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
+                            if (cachedRotations) {
+                                memcpy(destinationBuffer, _encodingCache.jointCompactRotations.data() + i * sizeof(AvatarDataPacket::FourByteQuat),
+                                       sizeof(AvatarDataPacket::FourByteQuat));
+                                destinationBuffer += sizeof(AvatarDataPacket::FourByteQuat);
+                            } else {
+                                destinationBuffer += packOrientationQuatToFourBytes(destinationBuffer, data.rotation);
+                            }
+                        } else if (cachedRotations) {
+                            memcpy(destinationBuffer, cachedRotations + i * sizeof(AvatarDataPacket::SixByteQuat),
+                                   sizeof(AvatarDataPacket::SixByteQuat));
+                            destinationBuffer += sizeof(AvatarDataPacket::SixByteQuat);
+                        } else {
+                            destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                        }
 
+                        // later changes are culled against what the receiver decoded, not the exact rotation
                         if (sentJoints) {
-                            sentJoints[i].rotation = data.rotation;
+                            if (cachedRotations) {
+                                sentJoints[i].rotation = isCompact ? _encodingCache.jointCompactDecodedRotations[i]
+                                                                   : _encodingCache.jointDecodedRotations[i];
+                            } else if (isCompact) {
+                                unpackOrientationQuatFromFourBytes(rotationStart, sentJoints[i].rotation);
+                            } else {
+                                unpackOrientationQuatFromSixBytes(rotationStart, sentJoints[i].rotation);
+                            }
                         }
                     }
                 }
@@ -791,8 +878,14 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #ifdef WANT_DEBUG
                         translationSentCount++;
 #endif
-                        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
-                                                                               TRANSLATION_COMPRESSION_RADIX);
+                        if (cachedTranslations) {
+                            memcpy(destinationBuffer, cachedTranslations + i * PACKED_JOINT_TRANSLATION_SIZE,
+                                   PACKED_JOINT_TRANSLATION_SIZE);
+                            destinationBuffer += PACKED_JOINT_TRANSLATION_SIZE;
+                        } else {
+                            destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
+                                                                                   TRANSLATION_COMPRESSION_RADIX);
+                        }
 
                         if (sentJoints) {
                             sentJoints[i].translation = data.translation;
@@ -901,6 +994,51 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 #undef IF_AVATAR_SPACE
 }
 
+void AvatarData::updateEncodingCache() {
+    _encodingCache.isValid = false;
+
+    packOrientationQuatToSixBytes(_encodingCache.orientation, getOrientationOutbound());
+    packSensorToWorldMatrix(&_encodingCache.sensorToWorld, getSensorToWorldMatrix());
+    packHandControllers(_encodingCache.handControllers, getControllerLeftHandMatrix(), getControllerRightHandMatrix());
+
+    {
+        QReadLocker readLock(&_jointDataLock);
+        _encodingCache.jointData = _jointData;
+    }
+    const QVector<JointData>& jointData = _encodingCache.jointData;
+    const int numJoints = jointData.size();
+
+    float maxTranslationDimension = computeMaxTranslationDimension(jointData, 0);
+    _encodingCache.maxTranslationDimension = maxTranslationDimension;
+
+    // joints in their default pose are never sent, so their entries are left empty
+    _encodingCache.jointRotations.assign(numJoints * sizeof(AvatarDataPacket::SixByteQuat), 0);
+    _encodingCache.jointTranslations.assign(numJoints * PACKED_JOINT_TRANSLATION_SIZE, 0);
+    _encodingCache.jointCompactRotations.assign(numJoints * sizeof(AvatarDataPacket::FourByteQuat), 0);
+    _encodingCache.jointCompactRotationDots.assign(numJoints, 0.0f);
+    _encodingCache.jointDecodedRotations.assign(numJoints, Quaternions::IDENTITY);
+    _encodingCache.jointCompactDecodedRotations.assign(numJoints, Quaternions::IDENTITY);
+    for (int i = 0; i < numJoints; ++i) {
+        const JointData& data = jointData[i];
+        if (!data.rotationIsDefaultPose) {
+            uint8_t* rotation = &_encodingCache.jointRotations[i * sizeof(AvatarDataPacket::SixByteQuat)];
+            packOrientationQuatToSixBytes(rotation, data.rotation);
+            unpackOrientationQuatFromSixBytes(rotation, _encodingCache.jointDecodedRotations[i]);
+            uint8_t* compactRotation = &_encodingCache.jointCompactRotations[i * sizeof(AvatarDataPacket::FourByteQuat)];
+            packOrientationQuatToFourBytes(compactRotation, data.rotation);
+            unpackOrientationQuatFromFourBytes(compactRotation, _encodingCache.jointCompactDecodedRotations[i]);
+            _encodingCache.jointCompactRotationDots[i] =
+                fabsf(glm::dot(_encodingCache.jointCompactDecodedRotations[i], data.rotation));
+        }
+        if (!data.translationIsDefaultPose) {
+            packFloatVec3ToSignedTwoByteFixed(&_encodingCache.jointTranslations[i * PACKED_JOINT_TRANSLATION_SIZE],
+                                              data.translation / maxTranslationDimension, TRANSLATION_COMPRESSION_RADIX);
+        }
+    }
+
+    _encodingCache.isValid = true;
+}
+
 // NOTE: This is never used in a "distanceAdjust" mode, so it's ok that it doesn't use a variable minimum rotation/translation
 void AvatarData::doneEncoding(bool cullSmallChanges) {
     // The server has finished sending this version of the joint-data to other nodes.  Update _lastSentJointData.
@@ -954,6 +1092,150 @@ const unsigned char* unpackHandController(const unsigned char* sourceBuffer, Thr
     return sourceBuffer;
 }
 
+// Unpacks a JointData section onto jointData, leaving the joints it has no rotation or translation for as they were.
+// Returns the end of the section, or nullptr if the buffer ends before the section does.
+static const unsigned char* unpackJointData(const unsigned char* sourceBuffer, const unsigned char* endPosition,
+                                            QVector<JointData>& jointData, bool& hasNewJointData) {
+    #define JOINT_READ_CHECK(SIZE_TO_READ)                      \
+        if ((endPosition - sourceBuffer) < (int)SIZE_TO_READ) { \
+            return nullptr;                                     \
+        }
+
+    JOINT_READ_CHECK(sizeof(uint8_t));
+    int numJoints = *sourceBuffer++;
+    const int bytesOfValidity = (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
+    JOINT_READ_CHECK(bytesOfValidity);
+
+    int numValidJointRotations = 0;
+    QVector<bool> validRotations;
+    validRotations.resize(numJoints);
+    { // rotation validity bits
+        unsigned char validity = 0;
+        int validityBit = 0;
+        for (int i = 0; i < numJoints; i++) {
+            if (validityBit == 0) {
+                validity = *sourceBuffer++;
+            }
+            bool valid = (bool)(validity & (1 << validityBit));
+            if (valid) {
+                ++numValidJointRotations;
+            }
+            validRotations[i] = valid;
+            validityBit = (validityBit + 1) % BITS_IN_BYTE;
+        }
+    }
+
+    JOINT_READ_CHECK(bytesOfValidity);
+
+    // get compact rotation bits -- these indicate which of the packed rotations use 4 bytes
+    int numCompactJointRotations = 0;
+    QVector<bool> compactRotations;
+    compactRotations.resize(numJoints);
+    { // compact rotation bits
+        unsigned char compact = 0;
+        int compactBit = 0;
+        for (int i = 0; i < numJoints; i++) {
+            if (compactBit == 0) {
+                compact = *sourceBuffer++;
+            }
+            bool isCompact = validRotations[i] && (bool)(compact & (1 << compactBit));
+            if (isCompact) {
+                ++numCompactJointRotations;
+            }
+            compactRotations[i] = isCompact;
+            compactBit = (compactBit + 1) % BITS_IN_BYTE;
+        }
+    }
+
+    // each joint rotation is stored in 6 bytes, or 4 bytes when compact.
+    jointData.resize(numJoints);
+
+    const int COMPRESSED_QUATERNION_SIZE = 6;
+    const int COMPACT_QUATERNION_SIZE = 4;
+    JOINT_READ_CHECK((numValidJointRotations - numCompactJointRotations) * COMPRESSED_QUATERNION_SIZE
+                     + numCompactJointRotations * COMPACT_QUATERNION_SIZE);
+    for (int i = 0; i < numJoints; i++) {
+        JointData& data = jointData[i];
+        if (compactRotations[i]) {
+            sourceBuffer += unpackOrientationQuatFromFourBytes(sourceBuffer, data.rotation);
+            hasNewJointData = true;
+            data.rotationIsDefaultPose = false;
+        } else if (validRotations[i]) {
+            sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
+            hasNewJointData = true;
+            data.rotationIsDefaultPose = false;
+        }
+    }
+
+    JOINT_READ_CHECK(bytesOfValidity);
+
+    // get translation validity bits -- these indicate which translations were packed
+    int numValidJointTranslations = 0;
+    QVector<bool> validTranslations;
+    validTranslations.resize(numJoints);
+    { // translation validity bits
+        unsigned char validity = 0;
+        int validityBit = 0;
+        for (int i = 0; i < numJoints; i++) {
+            if (validityBit == 0) {
+                validity = *sourceBuffer++;
+            }
+            bool valid = (bool)(validity & (1 << validityBit));
+            if (valid) {
+                ++numValidJointTranslations;
+            }
+            validTranslations[i] = valid;
+            validityBit = (validityBit + 1) % BITS_IN_BYTE;
+        }
+    } // 1 + bytesOfValidity bytes
+
+    // read maxTranslationDimension
+    float maxTranslationDimension;
+    JOINT_READ_CHECK(sizeof(float));
+    memcpy(&maxTranslationDimension, sourceBuffer, sizeof(float));
+    sourceBuffer += sizeof(float);
+
+    // each joint translation component is stored in 6 bytes.
+    const int COMPRESSED_TRANSLATION_SIZE = 6;
+    JOINT_READ_CHECK(numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
+
+    for (int i = 0; i < numJoints; i++) {
+        JointData& data = jointData[i];
+        if (validTranslations[i]) {
+            sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
+            data.translation *= maxTranslationDimension;
+            hasNewJointData = true;
+            data.translationIsDefaultPose = false;
+        }
+    }
+
+    #undef JOINT_READ_CHECK
+    return sourceBuffer;
+}
+
+// Unpacks a JointDefaultPoseFlags section onto jointData, which it resizes to the section's joint count.
+// Returns the end of the section, or nullptr if the buffer ends before the section does.
+static const unsigned char* unpackJointDefaultPoseFlags(const unsigned char* sourceBuffer, const unsigned char* endPosition,
+                                                        QVector<JointData>& jointData) {
+    if (endPosition - sourceBuffer < (int)sizeof(uint8_t)) {
+        return nullptr;
+    }
+    int numJoints = (int)*sourceBuffer++;
+
+    size_t bitVectorSize = calcBitVectorSize(numJoints);
+    if (endPosition - sourceBuffer < 2 * (int)bitVectorSize) {
+        return nullptr;
+    }
+    jointData.resize(numJoints);
+    sourceBuffer += readBitVector(sourceBuffer, numJoints, [&](int i, bool value) {
+        jointData[i].rotationIsDefaultPose = value;
+    });
+    sourceBuffer += readBitVector(sourceBuffer, numJoints, [&](int i, bool value) {
+        jointData[i].translationIsDefaultPose = value;
+    });
+    return sourceBuffer;
+}
+
 
 #define PACKET_READ_CHECK(ITEM_NAME, SIZE_TO_READ)                                        \
     if ((endPosition - sourceBuffer) < (int)SIZE_TO_READ) {                               \
@@ -970,6 +1252,14 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     // lazily allocate memory for HeadData in case we're not an Avatar instance
     lazyInitHeadData();
 
+    // drop the encoding cache, releasing its copy of the joints so they are updated in place
+    _encodingCache.isValid = false;
+    _encodingCache.jointData.clear();
+
+    // joints decoded ahead of time are only good for this buffer
+    DecodedAvatarJoints decodedJoints;
+    std::swap(decodedJoints, _decodedJoints);
+
     AvatarDataPacket::HasFlags packetStateFlags;
 
     const unsigned char* startPosition = reinterpret_cast<const unsigned char*>(buffer.data());
@@ -1323,94 +1613,22 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     if (hasJointData) {
         auto startSection = sourceBuffer;
 
-        PACKET_READ_CHECK(NumJoints, sizeof(uint8_t));
-        int numJoints = *sourceBuffer++;
-        const int bytesOfValidity = (int)ceil((float)numJoints / (float)BITS_IN_BYTE);
-        PACKET_READ_CHECK(JointRotationValidityBits, bytesOfValidity);
-
-        int numValidJointRotations = 0;
-        QVector<bool> validRotations;
-        validRotations.resize(numJoints);
-        { // rotation validity bits
-            unsigned char validity = 0;
-            int validityBit = 0;
-            for (int i = 0; i < numJoints; i++) {
-                if (validityBit == 0) {
-                    validity = *sourceBuffer++;
-                }
-                bool valid = (bool)(validity & (1 << validityBit));
-                if (valid) {
-                    ++numValidJointRotations;
+        if (decodedJoints.isValid) {
+            PACKET_READ_CHECK(JointData, decodedJoints.jointDataSize);
+            sourceBuffer += decodedJoints.jointDataSize;
+        } else {
+            QWriteLocker writeLock(&_jointDataLock);
+            auto endSection = unpackJointData(sourceBuffer, endPosition, _jointData, _hasNewJointData);
+            if (!endSection) {
+                if (shouldLogError(now)) {
+                    qCWarning(avatars) << "AvatarData packet too small, attempting to read JointData, only "
+                        << (endPosition - sourceBuffer) << " bytes left, " << getSessionUUID();
                 }
-                validRotations[i] = valid;
-                validityBit = (validityBit + 1) % BITS_IN_BYTE;
-            }
-        }
-
-        // each joint rotation is stored in 6 bytes.
-        QWriteLocker writeLock(&_jointDataLock);
-        _jointData.resize(numJoints);
-
-        const int COMPRESSED_QUATERNION_SIZE = 6;
-        PACKET_READ_CHECK(JointRotations, numValidJointRotations * COMPRESSED_QUATERNION_SIZE);
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validRotations[i]) {
-                sourceBuffer += unpackOrientationQuatFromSixBytes(sourceBuffer, data.rotation);
-                _hasNewJointData = true;
-                data.rotationIsDefaultPose = false;
+                return buffer.size();
             }
+            sourceBuffer = endSection;
         }
 
-        PACKET_READ_CHECK(JointTranslationValidityBits, bytesOfValidity);
-
-        // get translation validity bits -- these indicate which translations were packed
-        int numValidJointTranslations = 0;
-        QVector<bool> validTranslations;
-        validTranslations.resize(numJoints);
-        { // translation validity bits
-            unsigned char validity = 0;
-            int validityBit = 0;
-            for (int i = 0; i < numJoints; i++) {
-                if (validityBit == 0) {
-                    validity = *sourceBuffer++;
-                }
-                bool valid = (bool)(validity & (1 << validityBit));
-                if (valid) {
-                    ++numValidJointTranslations;
-                }
-                validTranslations[i] = valid;
-                validityBit = (validityBit + 1) % BITS_IN_BYTE;
-            }
-        } // 1 + bytesOfValidity bytes
-
-        // read maxTranslationDimension
-        float maxTranslationDimension;
-        PACKET_READ_CHECK(JointMaxTranslationDimension, sizeof(float));
-        memcpy(&maxTranslationDimension, sourceBuffer, sizeof(float));
-        sourceBuffer += sizeof(float);
-
-        // each joint translation component is stored in 6 bytes.
-        const int COMPRESSED_TRANSLATION_SIZE = 6;
-        PACKET_READ_CHECK(JointTranslation, numValidJointTranslations * COMPRESSED_TRANSLATION_SIZE);
-
-        for (int i = 0; i < numJoints; i++) {
-            JointData& data = _jointData[i];
-            if (validTranslations[i]) {
-                sourceBuffer += unpackFloatVec3FromSignedTwoByteFixed(sourceBuffer, data.translation, TRANSLATION_COMPRESSION_RADIX);
-                data.translation *= maxTranslationDimension;
-                _hasNewJointData = true;
-                data.translationIsDefaultPose = false;
-            }
-        }
-
-#ifdef WANT_DEBUG
-        if (numValidJointRotations > 15) {
-            qCDebug(avatars) << "RECEIVING -- rotations:" << numValidJointRotations
-                << "translations:" << numValidJointTranslations
-                << "size:" << (int)(sourceBuffer - startPosition);
-        }
-#endif
         int numBytesRead = sourceBuffer - startSection;
         _jointDataRate.increment(numBytesRead);
         _jointDataUpdateRate.increment();
@@ -1459,29 +1677,34 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     if (hasJointDefaultPoseFlags) {
         auto startSection = sourceBuffer;
 
-        QWriteLocker writeLock(&_jointDataLock);
-
-        PACKET_READ_CHECK(JointDefaultPoseFlagsNumJoints, sizeof(uint8_t));
-        int numJoints = (int)*sourceBuffer++;
-
-        _jointData.resize(numJoints);
-
-        size_t bitVectorSize = calcBitVectorSize(numJoints);
-        PACKET_READ_CHECK(JointDefaultPoseFlagsRotationFlags, bitVectorSize);
-        sourceBuffer += readBitVector(sourceBuffer, numJoints, [&](int i, bool value) {
-            _jointData[i].rotationIsDefaultPose = value;
-        });
-
-        PACKET_READ_CHECK(JointDefaultPoseFlagsTranslationFlags, bitVectorSize);
-        sourceBuffer += readBitVector(sourceBuffer, numJoints, [&](int i, bool value) {
-            _jointData[i].translationIsDefaultPose = value;
-        });
+        if (decodedJoints.isValid) {
+            PACKET_READ_CHECK(JointDefaultPoseFlags, decodedJoints.jointDefaultPoseFlagsSize);
+            sourceBuffer += decodedJoints.jointDefaultPoseFlagsSize;
+        } else {
+            QWriteLocker writeLock(&_jointDataLock);
+            auto endSection = unpackJointDefaultPoseFlags(sourceBuffer, endPosition, _jointData);
+            if (!endSection) {
+                if (shouldLogError(now)) {
+                    qCWarning(avatars) << "AvatarData packet too small, attempting to read JointDefaultPoseFlags, only "
+                        << (endPosition - sourceBuffer) << " bytes left, " << getSessionUUID();
+                }
+                return buffer.size();
+            }
+            sourceBuffer = endSection;
+        }
 
         int numBytesRead = sourceBuffer - startSection;
         _jointDefaultPoseFlagsRate.increment(numBytesRead);
         _jointDefaultPoseFlagsUpdateRate.increment();
     }
 
+    if (decodedJoints.isValid && (hasJointData || hasJointDefaultPoseFlags)) {
+        // the decoded skeleton shares its data with the decoder's copy, which pays for the copy when it next changes it
+        QWriteLocker writeLock(&_jointDataLock);
+        _jointData = std::move(decodedJoints.jointData);
+        _hasNewJointData = _hasNewJointData || decodedJoints.hasNewJointData;
+    }
+
     int numBytesRead = sourceBuffer - startPosition;
     _averageBytesReceived.updateAverage(numBytesRead);
 
@@ -1491,6 +1714,103 @@ int AvatarData::parseDataFromBuffer(const QByteArray& buffer) {
     return numBytesRead;
 }
 
+int AvatarData::decodeJoints(const QByteArray& buffer, QVector<JointData>& jointState, DecodedAvatarJoints& decoded) {
+    const unsigned char* startPosition = reinterpret_cast<const unsigned char*>(buffer.data());
+    const unsigned char* endPosition = startPosition + buffer.size();
+    const unsigned char* sourceBuffer = startPosition;
+
+    AvatarDataPacket::HasFlags packetStateFlags;
+    if (endPosition - sourceBuffer < (int)sizeof(packetStateFlags)) {
+        return -1;
+    }
+    memcpy(&packetStateFlags, sourceBuffer, sizeof(packetStateFlags));
+    sourceBuffer += sizeof(packetStateFlags);
+
+    // skip the sections before the joints, which parseDataFromBuffer() reads as they come
+    size_t sizeBeforeJoints = 0;
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION)) {
+        sizeBeforeJoints += sizeof(AvatarDataPacket::AvatarGlobalPosition);
+    }
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX)) {
+        sizeBeforeJoints += sizeof(AvatarDataPacket::AvatarBoundingBox);
+    }
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION)) {
+        sizeBeforeJoints += sizeof(AvatarDataPacket::AvatarOrientation);
+    }
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_AVATAR_SCALE)) {
+        sizeBeforeJoints += sizeof(AvatarDataPacket::AvatarScale);
+    }
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION)) {
+        sizeBeforeJoints += sizeof(AvatarDataPacket::LookAtPosition);
+    }
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS)) {
+        sizeBeforeJoints += sizeof(AvatarDataPacket::AudioLoudness);
+    }
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX)) {
+        sizeBeforeJoints += sizeof(AvatarDataPacket::SensorToWorldMatrix);
+    }
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS)) {
+        sizeBeforeJoints += sizeof(AvatarDataPacket::AdditionalFlags);
+    }
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_PARENT_INFO)) {
+        sizeBeforeJoints += sizeof(AvatarDataPacket::ParentInfo);
+    }
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION)) {
+        sizeBeforeJoints += sizeof(AvatarDataPacket::AvatarLocalPosition);
+    }
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS)) {
+        sizeBeforeJoints += AvatarDataPacket::HAND_CONTROLLERS_SIZE;
+    }
+    if (endPosition - sourceBuffer < (int)sizeBeforeJoints) {
+        return -1;
+    }
+    sourceBuffer += sizeBeforeJoints;
+
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO)) {
+        if (endPosition - sourceBuffer < (int)sizeof(AvatarDataPacket::FaceTrackerInfo)) {
+            return -1;
+        }
+        auto faceTrackerInfo = reinterpret_cast<const AvatarDataPacket::FaceTrackerInfo*>(sourceBuffer);
+        int coefficientsSize = sizeof(float) * faceTrackerInfo->numBlendshapeCoefficients;
+        sourceBuffer += sizeof(AvatarDataPacket::FaceTrackerInfo);
+        if (endPosition - sourceBuffer < coefficientsSize) {
+            return -1;
+        }
+        sourceBuffer += coefficientsSize;
+    }
+
+    decoded = DecodedAvatarJoints();
+    bool hasJointData = HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DATA);
+    if (hasJointData) {
+        auto endSection = unpackJointData(sourceBuffer, endPosition, jointState, decoded.hasNewJointData);
+        if (!endSection) {
+            return -1;
+        }
+        decoded.jointDataSize = (int)(endSection - sourceBuffer);
+        sourceBuffer = endSection;
+
+        if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_GRAB_JOINTS)) {
+            if (endPosition - sourceBuffer < (int)sizeof(AvatarDataPacket::FarGrabJoints)) {
+                return -1;
+            }
+            sourceBuffer += sizeof(AvatarDataPacket::FarGrabJoints);
+        }
+    }
+
+    if (HAS_FLAG(packetStateFlags, AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS)) {
+        auto endSection = unpackJointDefaultPoseFlags(sourceBuffer, endPosition, jointState);
+        if (!endSection) {
+            return -1;
+        }
+        decoded.jointDefaultPoseFlagsSize = (int)(endSection - sourceBuffer);
+        sourceBuffer = endSection;
+    }
+
+    decoded.isValid = true;
+    decoded.jointData = jointState;
+    return (int)(sourceBuffer - startPosition);
+}
+
 /*@jsdoc
  * <p>The avatar mixer data comprises different types of data, with the data rates of each being tracked in kbps.</p>
  *
@@ -3014,7 +3334,8 @@ void AvatarData::storeAvatarEntityDataPayload(const QUuid& entityID, const QByte
                 _packedAvatarEntityData.insert(entityID, data);
                 changed = true;
             }
-        } else {
+        } else if (itr.value() != data) {
+            // properties packed again without a change are nothing to send
             itr.value() = data;
             changed = true;
         }
@@ -3179,6 +3500,7 @@ void RayToAvatarIntersectionResultFromScriptValue(const QScriptValue& object, Ra
 // these coefficients can be changed via JS for experimental tuning
 // use AvatatManager.setAvatarSortCoefficient("name", value) by a user with domain kick-rights
 float AvatarData::_avatarSortCoefficientSize { 8.0f };
+bool AvatarData::_compactJointRotations { true };
 float AvatarData::_avatarSortCoefficientCenter { 0.25f };
 float AvatarData::_avatarSortCoefficientAge { 1.0f };
 
@@ -210,6 +210,7 @@ namespace AvatarDataPacket {
     const size_t AVATAR_HAS_FLAGS_SIZE = 2;
 
     using SixByteQuat = uint8_t[6];
+    using FourByteQuat = uint8_t[4];
     using SixByteTrans = uint8_t[6];
 
     // NOTE: AvatarDataPackets start with a uint16_t sequence number that is not reflected in the Header structure.
@@ -342,7 +343,9 @@ namespace AvatarDataPacket {
     struct JointData {
         uint8_t numJoints;
         uint8_t rotationValidityBits[ceil(numJoints / 8)];     // one bit per joint, if true then a compressed rotation follows.
-        SixByteQuat rotation[numValidRotations];               // encodeded and compressed by packOrientationQuatToSixBytes()
+        uint8_t compactRotationBits[ceil(numJoints / 8)];      // one bit per joint, if true its rotation is a FourByteQuat.
+        SixByteQuat rotation[numValidRotations];               // encodeded and compressed by packOrientationQuatToSixBytes(),
+                                                               // or packOrientationQuatToFourBytes() for compact rotations
         uint8_t translationValidityBits[ceil(numJoints / 8)];  // one bit per joint, if true then a compressed translation follows.
         float maxTranslationDimension;                         // used to normalize fixed point translation values.
         SixByteTrans translation[numValidTranslations];        // normalized and compressed by packFloatVec3ToSignedTwoByteFixed()
@@ -480,6 +483,17 @@ public:
     bool operator<(const AvatarPriority& other) const { return priority < other.priority; }
 };
 
+// The joint sections of one avatar's data in a BulkAvatarData packet, decoded by AvatarData::decodeJoints() away from
+// the avatar. jointData is the whole skeleton as of this packet, not only the joints the packet carried.
+class DecodedAvatarJoints {
+public:
+    bool isValid { false };
+    QVector<JointData> jointData;
+    bool hasNewJointData { false };
+    int jointDataSize { 0 };             // bytes of the JointData section, not counting the FarGrabJoints after it
+    int jointDefaultPoseFlagsSize { 0 }; // bytes of the JointDefaultPoseFlags section
+};
+
 class ClientTraitsHandler;
 
 class AvatarData : public QObject, public SpatiallyNestable {
@@ -631,6 +645,11 @@ public:
 
     virtual void doneEncoding(bool cullSmallChanges);
 
+    /// Packs the sections of toByteArray() that are the same for every receiver, so encoding this avatar
+    /// for many receivers only has to cull joints and copy bytes. The cache is dropped by parseDataFromBuffer().
+    /// Must not run concurrently with toByteArray(); the avatar mixer builds it while processing incoming packets.
+    void updateEncodingCache();
+
     /// \return true if an error should be logged
     bool shouldLogError(const quint64& now);
 
@@ -639,6 +658,16 @@ public:
     /// \return number of bytes parsed
     virtual int parseDataFromBuffer(const QByteArray& buffer);
 
+    /// Decodes the joint sections of the avatar data in buffer onto jointState, which holds what the earlier packets for
+    /// the same avatar left in it, so the avatar's parseDataFromBuffer() doesn't have to. Touches no avatar, so it can run
+    /// on any thread.
+    /// \return the size of the avatar data at the start of buffer, or -1 if it is malformed
+    static int decodeJoints(const QByteArray& buffer, QVector<JointData>& jointState, DecodedAvatarJoints& decoded);
+
+    /// Hands over joints decoded by decodeJoints() for the buffer parseDataFromBuffer() is called with next, which then
+    /// skips their sections and swaps them in instead of decoding them itself.
+    void setDecodedJoints(DecodedAvatarJoints&& decoded) { _decodedJoints = std::move(decoded); }
+
     virtual void setCollisionWithOtherAvatarsFlags() {};
 
     // Body Rotation (degrees)
@@ -1497,6 +1526,9 @@ public:
     static float _avatarSortCoefficientCenter;
     static float _avatarSortCoefficientAge;
 
+    // When set, toByteArray() packs a joint rotation in four bytes if its error is within the receiver's culling threshold.
+    static bool _compactJointRotations;
+
     bool getIdentityDataChanged() const { return _identityDataChanged; } // has the identity data changed since the last time sendIdentityPacket() was called
     void markIdentityDataChanged() { _identityDataChanged = true; }
 
@@ -1726,10 +1758,28 @@ protected:
     QVector<JointData> _lastSentJointData; ///< the state of the skeleton joints last time we transmitted
     mutable QReadWriteLock _jointDataLock;
 
+    // receiver-independent sections of toByteArray(), see updateEncodingCache()
+    struct EncodingCache {
+        bool isValid { false };
+        AvatarDataPacket::SixByteQuat orientation;
+        AvatarDataPacket::SensorToWorldMatrix sensorToWorld;
+        uint8_t handControllers[AvatarDataPacket::HAND_CONTROLLERS_SIZE];
+        QVector<JointData> jointData;
+        float maxTranslationDimension { 0.0f };
+        std::vector<uint8_t> jointRotations;    // packed SixByteQuat per joint
+        std::vector<uint8_t> jointCompactRotations; // packed FourByteQuat per joint
+        std::vector<float> jointCompactRotationDots; // dot of each FourByteQuat with the exact rotation
+        std::vector<glm::quat> jointDecodedRotations; // each SixByteQuat as the receiver unpacks it
+        std::vector<glm::quat> jointCompactDecodedRotations; // each FourByteQuat as the receiver unpacks it
+        std::vector<uint8_t> jointTranslations; // packed translation / maxTranslationDimension per joint
+    };
+    EncodingCache _encodingCache;
+
     // key state
     KeyState _keyState;
 
     bool _hasNewJointData { true }; // set in AvatarData, cleared in Avatar
+    DecodedAvatarJoints _decodedJoints; // see setDecodedJoints()
 
     mutable HeadData* _headData { nullptr };
 
@@ -0,0 +1,102 @@
+//
+//  AvatarDataDecoder.cpp
+//  libraries/avatars/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarDataDecoder.h"
+
+#include <cassert>
+
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <ThreadHelpers.h>
+
+#include "Profile.h"
+
+void AvatarDataDecoder::start() {
+    moveToNewNamedThread(this, "Avatar Data Decoder Thread");
+
+    auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
+    packetReceiver.registerListener(PacketType::BulkAvatarData,
+        PacketReceiver::makeSourcedListenerReference<AvatarDataDecoder>(this, &AvatarDataDecoder::processAvatarDataPacket));
+    packetReceiver.registerListener(PacketType::KillAvatar,
+        PacketReceiver::makeSourcedListenerReference<AvatarDataDecoder>(this, &AvatarDataDecoder::processKillAvatar));
+}
+
+void AvatarDataDecoder::takeDecodedMessages(DecodedMessages& messages) {
+    assert(messages.empty());
+    std::unique_lock<std::mutex> lock(_decodedMessagesMutex);
+    _decodedMessages.swap(messages);
+}
+
+void AvatarDataDecoder::reset() {
+    {
+        std::unique_lock<std::mutex> lock(_decodedMessagesMutex);
+        _decodedMessages.clear();
+    }
+    QMetaObject::invokeMethod(this, [this] {
+        _jointStates.clear();
+    });
+}
+
+void AvatarDataDecoder::processAvatarDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    DETAILED_PROFILE_RANGE(network, __FUNCTION__);
+    auto start = usecTimestampNow();
+
+    DecodedMessage decoded;
+    decoded.message = message;
+    decoded.sendingNode = sendingNode;
+    while (message->getBytesLeftToRead()) {
+        DecodedAvatar avatar;
+        avatar.sessionUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+
+        auto positionBeforeRead = message->getPosition();
+        QByteArray rest = message->readWithoutCopy(message->getBytesLeftToRead());
+        int size = AvatarData::decodeJoints(rest, _jointStates[avatar.sessionUUID], avatar.joints);
+        if (size < 0) {
+            // malformed: leave the rest of the packet to the avatar, which parses it as it did before this decoder
+            size = rest.size();
+        }
+        avatar.buffer = QByteArray::fromRawData(rest.constData(), size);
+        message->seek(positionBeforeRead + size);
+
+        decoded.avatars.push_back(std::move(avatar));
+    }
+
+    _decodeUsecs.updateAverage((float)(usecTimestampNow() - start));
+    _averageDecodeMsecs.store(_decodeUsecs.getAverage() / USECS_PER_MSEC);
+
+    queueDecodedMessage(std::move(decoded));
+}
+
+void AvatarDataDecoder::processKillAvatar(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    QUuid sessionUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+    _jointStates.erase(sessionUUID);
+    // the avatars' thread reads the kill from the start
+    message->seek(0);
+
+    DecodedMessage decoded;
+    decoded.message = message;
+    decoded.sendingNode = sendingNode;
+    queueDecodedMessage(std::move(decoded));
+}
+
+void AvatarDataDecoder::queueDecodedMessage(DecodedMessage&& decoded) {
+    bool wasEmpty;
+    {
+        std::unique_lock<std::mutex> lock(_decodedMessagesMutex);
+        wasEmpty = _decodedMessages.empty();
+        _decodedMessages.push_back(std::move(decoded));
+    }
+    // one signal for however many messages pile up before they are taken
+    if (wasEmpty) {
+        emit decodedMessagesReady();
+    }
+}
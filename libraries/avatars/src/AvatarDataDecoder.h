@@ -0,0 +1,82 @@
+//
+//  AvatarDataDecoder.h
+//  libraries/avatars/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarDataDecoder_h
+#define hifi_AvatarDataDecoder_h
+
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QObject>
+#include <QtCore/QSharedPointer>
+#include <QtCore/QUuid>
+
+#include <Node.h>
+#include <ReceivedMessage.h>
+#include <SimpleMovingAverage.h>
+#include <UUIDHasher.h>
+
+#include "AvatarData.h"
+
+// Takes the BulkAvatarData packets off the thread their avatars live on: on a thread of its own it splits each packet into
+// its avatars and decodes their joints, the bulk of the work, keeping every avatar's skeleton as the packets so far left it.
+// The decoded packets queue up in arrival order, KillAvatar packets among them so an avatar isn't brought back by data
+// that came before its kill, until the avatars' thread swaps the queue out and hands them to the avatars.
+class AvatarDataDecoder : public QObject {
+    Q_OBJECT
+public:
+    struct DecodedAvatar {
+        QUuid sessionUUID;
+        QByteArray buffer; // this avatar's part of the packet, without a copy
+        DecodedAvatarJoints joints;
+    };
+
+    struct DecodedMessage {
+        QSharedPointer<ReceivedMessage> message; // owns the bytes of the avatars' buffers
+        SharedNodePointer sendingNode;
+        std::vector<DecodedAvatar> avatars; // none for a KillAvatar message
+    };
+    using DecodedMessages = std::vector<DecodedMessage>;
+
+    // starts the decoder's thread and has it take over the BulkAvatarData and KillAvatar packets
+    void start();
+
+    // swaps the decoded messages into messages, which should come in empty, so the two buffers trade places
+    void takeDecodedMessages(DecodedMessages& messages);
+
+    // drops the decoded messages not yet taken and the skeletons kept so far, for when the avatars are all gone
+    void reset();
+
+    float getAverageDecodeTime() const { return _averageDecodeMsecs.load(); } // ms per BulkAvatarData packet
+
+signals:
+    // emitted when decoded messages are waiting and the last ones were taken
+    void decodedMessagesReady();
+
+private slots:
+    void processAvatarDataPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void processKillAvatar(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+
+private:
+    void queueDecodedMessage(DecodedMessage&& decoded);
+
+    std::unordered_map<QUuid, QVector<JointData>> _jointStates; // on the decoder's thread only
+
+    std::mutex _decodedMessagesMutex;
+    DecodedMessages _decodedMessages;
+
+    SimpleMovingAverage _decodeUsecs;
+    std::atomic<float> _averageDecodeMsecs { 0.0f };
+};
+
+#endif // hifi_AvatarDataDecoder_h
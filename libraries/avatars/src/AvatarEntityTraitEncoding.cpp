@@ -0,0 +1,165 @@
+//
+//  AvatarEntityTraitEncoding.cpp
+//  libraries/avatars/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarEntityTraitEncoding.h"
+
+#include <cstring>
+
+#include <Gzip.h>
+
+#include "AvatarTraits.h"
+
+namespace {
+
+const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+const uint64_t FNV_PRIME = 1099511628211ULL;
+
+const int ENCODING_SIZE = (int)sizeof(AvatarTraits::EntityEncoding);
+const int HASH_SIZE = (int)sizeof(AvatarTraits::EntityBlobHash);
+const int BLOB_SIZE_SIZE = (int)sizeof(uint16_t);
+
+void appendHash(QByteArray& destination, AvatarTraits::EntityBlobHash hash) {
+    destination.append(reinterpret_cast<const char*>(&hash), HASH_SIZE);
+}
+
+AvatarTraits::EntityBlobHash readHash(const QByteArray& source, int offset) {
+    AvatarTraits::EntityBlobHash hash;
+    memcpy(&hash, source.constData() + offset, HASH_SIZE);
+    return hash;
+}
+
+QByteArray encodeDeflated(AvatarTraits::EntityEncoding encoding, const QByteArray& blob, const QByteArray& base) {
+    QByteArray deflated;
+    if (!deflateWithDictionary(blob, base, deflated)) {
+        return QByteArray();
+    }
+
+    QByteArray encoded;
+    encoded.reserve(ENCODING_SIZE + HASH_SIZE + BLOB_SIZE_SIZE + deflated.size());
+    encoded.append((char)encoding);
+    if (encoding == AvatarTraits::DeflatedFromBaseEntity) {
+        appendHash(encoded, AvatarTraits::hashEntityBlob(base));
+    }
+    uint16_t blobSize = (uint16_t)blob.size();
+    encoded.append(reinterpret_cast<const char*>(&blobSize), BLOB_SIZE_SIZE);
+    encoded.append(deflated);
+    return encoded;
+}
+
+}  // namespace
+
+namespace AvatarTraits {
+
+    EntityBlobHash hashEntityBlob(const QByteArray& blob) {
+        // FNV-1a, the same on every platform, hashes only ever identify the blobs of one avatar
+        uint64_t hash = FNV_OFFSET_BASIS;
+        auto data = reinterpret_cast<const uint8_t*>(blob.constData());
+        for (int i = 0; i < blob.size(); ++i) {
+            hash = (hash ^ data[i]) * FNV_PRIME;
+        }
+        return hash;
+    }
+
+    QByteArray encodeEntityBlob(const QByteArray& blob, const QByteArray& base) {
+        QByteArray raw;
+        raw.reserve(ENCODING_SIZE + blob.size());
+        raw.append((char)RawEntity);
+        raw.append(blob);
+
+        if (blob.size() > MAXIMUM_TRAIT_SIZE) {
+            // too big to send at all, it's refused when packed
+            return raw;
+        }
+
+        QByteArray best = raw;
+        QByteArray deflated = encodeDeflated(DeflatedEntity, blob, QByteArray());
+        if (!deflated.isNull() && deflated.size() < best.size()) {
+            best = deflated;
+        }
+        if (!base.isEmpty()) {
+            QByteArray fromBase = encodeDeflated(DeflatedFromBaseEntity, blob, base);
+            if (!fromBase.isNull() && fromBase.size() < best.size()) {
+                best = fromBase;
+            }
+        }
+        return best;
+    }
+
+    QByteArray encodeEntityReference(EntityBlobHash hash) {
+        QByteArray encoded;
+        encoded.reserve(ENCODING_SIZE + HASH_SIZE);
+        encoded.append((char)ReferencedEntity);
+        appendHash(encoded, hash);
+        return encoded;
+    }
+
+    bool readEntityEncoding(const QByteArray& encoded, EntityEncoding& encoding, EntityBlobHash& neededHash) {
+        if (encoded.size() < ENCODING_SIZE || (uint8_t)encoded[0] >= NumEntityEncodings) {
+            return false;
+        }
+        encoding = (EntityEncoding)encoded[0];
+        neededHash = 0;
+
+        switch (encoding) {
+            case RawEntity:
+                return true;
+            case DeflatedEntity:
+                return encoded.size() >= ENCODING_SIZE + BLOB_SIZE_SIZE;
+            case DeflatedFromBaseEntity:
+                if (encoded.size() < ENCODING_SIZE + HASH_SIZE + BLOB_SIZE_SIZE) {
+                    return false;
+                }
+                neededHash = readHash(encoded, ENCODING_SIZE);
+                return true;
+            case ReferencedEntity:
+                if (encoded.size() != ENCODING_SIZE + HASH_SIZE) {
+                    return false;
+                }
+                neededHash = readHash(encoded, ENCODING_SIZE);
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    bool decodeEntityBlob(const QByteArray& encoded, const QByteArray& neededBlob, QByteArray& blob) {
+        blob.clear();
+
+        EntityEncoding encoding;
+        EntityBlobHash neededHash;
+        if (!readEntityEncoding(encoded, encoding, neededHash)) {
+            return false;
+        }
+
+        if (encoding == RawEntity) {
+            blob = encoded.mid(ENCODING_SIZE);
+            return true;
+        }
+
+        if (encoding != DeflatedEntity && hashEntityBlob(neededBlob) != neededHash) {
+            return false;
+        }
+
+        if (encoding == ReferencedEntity) {
+            blob = neededBlob;
+            return true;
+        }
+
+        int offset = ENCODING_SIZE + (encoding == DeflatedFromBaseEntity ? HASH_SIZE : 0);
+        uint16_t blobSize;
+        memcpy(&blobSize, encoded.constData() + offset, BLOB_SIZE_SIZE);
+        offset += BLOB_SIZE_SIZE;
+
+        QByteArray deflated = QByteArray::fromRawData(encoded.constData() + offset, encoded.size() - offset);
+        return inflateWithDictionary(deflated, encoding == DeflatedFromBaseEntity ? neededBlob : QByteArray(),
+                                     blobSize, blob);
+    }
+};
@@ -0,0 +1,54 @@
+//
+//  AvatarEntityTraitEncoding.h
+//  libraries/avatars/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarEntityTraitEncoding_h
+#define hifi_AvatarEntityTraitEncoding_h
+
+#include <cstdint>
+
+#include <QtCore/QByteArray>
+
+// An avatar entity trait carries the entity's whole property blob, and wearables are sent again to every listener that
+// comes into range. On the wire the blob is encoded as one byte of encoding followed by:
+//
+//   Raw:         the blob, when deflating it doesn't make it smaller
+//   Deflated:    its uint16 size, then the zlib stream of it
+//   FromBase:    the hash of a base blob, its uint16 size, then the zlib stream of it with the base as preset dictionary
+//   Reference:   the hash of the blob, for a receiver that already holds it
+//
+// The base of FromBase is another blob of the same avatar that the receiver holds: the entity's previous properties when
+// it's edited, or one of the avatar's other entities when it's new, which share most of their properties, e.g. parent,
+// owner and model. Hashes only identify the blobs of one avatar, the receivers keep their blobs per avatar.
+namespace AvatarTraits {
+    using EntityBlobHash = uint64_t;
+
+    enum EntityEncoding : uint8_t {
+        RawEntity = 0,
+        DeflatedEntity,
+        DeflatedFromBaseEntity,
+        ReferencedEntity,
+        NumEntityEncodings
+    };
+
+    EntityBlobHash hashEntityBlob(const QByteArray& blob);
+
+    // encodes the blob on its own, or from the base when one is given and that ends up smaller
+    QByteArray encodeEntityBlob(const QByteArray& blob, const QByteArray& base = QByteArray());
+    QByteArray encodeEntityReference(EntityBlobHash hash);
+
+    // reads the encoding of an encoded blob, and for FromBase and Reference the hash of the blob needed to decode it
+    bool readEntityEncoding(const QByteArray& encoded, EntityEncoding& encoding, EntityBlobHash& neededHash);
+
+    // decodes an encoded blob, given the blob its encoding needs if it needs one
+    bool decodeEntityBlob(const QByteArray& encoded, const QByteArray& neededBlob, QByteArray& blob);
+};
+
+#endif // hifi_AvatarEntityTraitEncoding_h
@@ -119,14 +119,21 @@ void AvatarReplicas::processTraitInstance(const QUuid& parentID, AvatarTraits::T
     }
 }
 
-AvatarHashMap::AvatarHashMap() {
+AvatarHashMap::AvatarHashMap(bool decodeOnThread) {
     auto nodeList = DependencyManager::get<NodeList>();
 
     auto& packetReceiver = nodeList->getPacketReceiver();
-    packetReceiver.registerListener(PacketType::BulkAvatarData,
-        PacketReceiver::makeSourcedListenerReference<AvatarHashMap>(this, &AvatarHashMap::processAvatarDataPacket));
-    packetReceiver.registerListener(PacketType::KillAvatar,
-        PacketReceiver::makeSourcedListenerReference<AvatarHashMap>(this, &AvatarHashMap::processKillAvatar));
+    if (decodeOnThread) {
+        // the decoder takes the kills too, to keep them in order with the data
+        _decoder = new AvatarDataDecoder();
+        connect(_decoder, &AvatarDataDecoder::decodedMessagesReady, this, &AvatarHashMap::processDecodedMessages);
+        _decoder->start();
+    } else {
+        packetReceiver.registerListener(PacketType::BulkAvatarData,
+            PacketReceiver::makeSourcedListenerReference<AvatarHashMap>(this, &AvatarHashMap::processAvatarDataPacket));
+        packetReceiver.registerListener(PacketType::KillAvatar,
+            PacketReceiver::makeSourcedListenerReference<AvatarHashMap>(this, &AvatarHashMap::processKillAvatar));
+    }
     packetReceiver.registerListener(PacketType::AvatarIdentity,
         PacketReceiver::makeSourcedListenerReference<AvatarHashMap>(this, &AvatarHashMap::processAvatarIdentityPacket));
     packetReceiver.registerListener(PacketType::BulkAvatarTraits,
@@ -136,11 +143,33 @@ AvatarHashMap::AvatarHashMap() {
 
     connect(nodeList.data(), &NodeList::nodeKilled, this, [this](SharedNodePointer killedNode){
         if (killedNode->getType() == NodeType::AvatarMixer) {
+            if (_decoder) {
+                _decoder->reset();
+            }
             clearOtherAvatars();
+            // the next mixer sends everything again anyway
+            _missingAvatarEntities.clear();
         }
     });
 }
 
+namespace {
+
+QByteArray avatarEntityBlobKey(const QUuid& avatarID, AvatarTraits::EntityBlobHash hash) {
+    QByteArray key = avatarID.toRfc4122();
+    key.append(reinterpret_cast<const char*>(&hash), sizeof(hash));
+    return key;
+}
+
+}  // namespace
+
+AvatarHashMap::~AvatarHashMap() {
+    if (_decoder) {
+        // deleted on its own thread, which then quits
+        _decoder->deleteLater();
+    }
+}
+
 QVector<QUuid> AvatarHashMap::getAvatarIdentifiers() {
     QReadLocker locker(&_hashLock);
     return _avatarHash.keys().toVector();
@@ -252,6 +281,59 @@ void AvatarHashMap::processAvatarDataPacket(QSharedPointer<ReceivedMessage> mess
     }
 }
 
+void AvatarHashMap::processDecodedMessages() {
+    DETAILED_PROFILE_RANGE(network, __FUNCTION__);
+    PerformanceTimer perfTimer("receiveAvatar");
+    auto start = usecTimestampNow();
+
+    _decoder->takeDecodedMessages(_decodedMessages);
+    for (auto& decoded : _decodedMessages) {
+        if (decoded.message->getType() == PacketType::KillAvatar) {
+            processKillAvatar(decoded.message, decoded.sendingNode);
+            continue;
+        }
+
+        for (auto& decodedAvatar : decoded.avatars) {
+            // the decoder has found where each avatar's data ends, so an ignored avatar's is simply left alone
+            auto avatar = avatarForData(decodedAvatar.sessionUUID, decoded.sendingNode);
+            if (avatar) {
+                avatar->setDecodedJoints(std::move(decodedAvatar.joints));
+                avatar->parseDataFromBuffer(decodedAvatar.buffer);
+                _replicas.parseDataFromBuffer(decodedAvatar.sessionUUID, decodedAvatar.buffer);
+            }
+        }
+    }
+    _decodedMessages.clear();
+
+    _applyUsecs.updateAverage((float)(usecTimestampNow() - start));
+    _averageApplyMsecs = _applyUsecs.getAverage() / USECS_PER_MSEC;
+}
+
+AvatarSharedPointer AvatarHashMap::avatarForData(const QUuid& sessionUUID, const SharedNodePointer& sendingNode) {
+    // make sure this isn't our own avatar data or for a previously ignored node
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (sessionUUID == _lastOwnerSessionUUID || (nodeList->isIgnoringNode(sessionUUID) && !nodeList->getRequestsDomainListData())) {
+        // Shouldn't happen if mixer functioning correctly - debugging for BUGZ-781:
+        qCDebug(avatars) << "Discarding received avatar data" << sessionUUID << (sessionUUID == _lastOwnerSessionUUID ? "(is self)" : "")
+            << "isIgnoringNode = " << nodeList->isIgnoringNode(sessionUUID);
+        return nullptr;
+    }
+
+    bool isNewAvatar;
+    auto avatar = newOrExistingAvatar(sessionUUID, sendingNode, isNewAvatar);
+    if (isNewAvatar) {
+        QWriteLocker locker(&_hashLock);
+        avatar->setIsNewAvatar(true);
+        auto replicaIDs = _replicas.getReplicaIDs(sessionUUID);
+        for (auto replicaID : replicaIDs) {
+            auto replicaAvatar = addAvatar(replicaID, sendingNode);
+            replicaAvatar->setIsNewAvatar(true);
+            _replicas.addReplica(sessionUUID, replicaAvatar);
+        }
+    }
+    return avatar;
+}
+
 AvatarSharedPointer AvatarHashMap::parseAvatarData(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     QUuid sessionUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
 
@@ -259,35 +341,15 @@ AvatarSharedPointer AvatarHashMap::parseAvatarData(QSharedPointer<ReceivedMessag
 
     QByteArray byteArray = message->readWithoutCopy(message->getBytesLeftToRead());
 
-    // make sure this isn't our own avatar data or for a previously ignored node
-    auto nodeList = DependencyManager::get<NodeList>();
-    bool isNewAvatar;
-    if (sessionUUID != _lastOwnerSessionUUID && (!nodeList->isIgnoringNode(sessionUUID) || nodeList->getRequestsDomainListData())) {
-        auto avatar = newOrExistingAvatar(sessionUUID, sendingNode, isNewAvatar);
-
-        if (isNewAvatar) {
-            QWriteLocker locker(&_hashLock);
-            avatar->setIsNewAvatar(true);
-            auto replicaIDs = _replicas.getReplicaIDs(sessionUUID);
-            for (auto replicaID : replicaIDs) {
-                auto replicaAvatar = addAvatar(replicaID, sendingNode);
-                replicaAvatar->setIsNewAvatar(true);
-                _replicas.addReplica(sessionUUID, replicaAvatar);
-            }
-        } 
-        
+    auto avatar = avatarForData(sessionUUID, sendingNode);
+    if (avatar) {
         // have the matching (or new) avatar parse the data from the packet
         int bytesRead = avatar->parseDataFromBuffer(byteArray);
         message->seek(positionBeforeRead + bytesRead);
         _replicas.parseDataFromBuffer(sessionUUID, byteArray);
-        
 
         return avatar;
     } else {
-        // Shouldn't happen if mixer functioning correctly - debugging for BUGZ-781:
-        qCDebug(avatars) << "Discarding received avatar data" << sessionUUID << (sessionUUID == _lastOwnerSessionUUID ? "(is self)" : "")
-            << "isIgnoringNode = " << nodeList->isIgnoringNode(sessionUUID);
-
         // create a dummy AvatarData class to throw this data on the ground
         AvatarData dummyData;
         int bytesRead = dummyData.parseDataFromBuffer(byteArray);
@@ -350,26 +412,45 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
 
     message->readPrimitive(&seq);
 
-    auto traitsAckPacket = NLPacket::create(PacketType::BulkAvatarTraitsAck, sizeof(AvatarTraits::TraitMessageSequence), true);
-    traitsAckPacket->writePrimitive(seq);
+    readBulkAvatarTraits(*message, sendingNode);
+
     auto nodeList = DependencyManager::get<LimitedNodeList>();
     SharedNodePointer avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer);
     if (!avatarMixer.isNull()) {
         // we have a mixer to send to, acknowledge that we received these
         // traits.
+        auto traitsAckPacket = NLPacket::create(PacketType::BulkAvatarTraitsAck, -1, true);
+        traitsAckPacket->writePrimitive(seq);
+
+        // and tell it of the avatar entities we couldn't decode for want of a blob, so that it sends them whole;
+        // any that don't fit go with the ack of the traits it sends next
+        const qint64 MISSING_AVATAR_ENTITY_BYTES = 2 * NUM_BYTES_RFC4122_UUID + sizeof(AvatarTraits::EntityBlobHash);
+        auto maxNumMissing = (traitsAckPacket->bytesAvailableForWrite() - (qint64)sizeof(uint16_t)) / MISSING_AVATAR_ENTITY_BYTES;
+        auto numMissing = (uint16_t)std::min((qint64)_missingAvatarEntities.size(), maxNumMissing);
+        traitsAckPacket->writePrimitive(numMissing);
+        for (uint16_t i = 0; i < numMissing; ++i) {
+            const auto& missing = _missingAvatarEntities[i];
+            traitsAckPacket->write(missing.avatarID.toRfc4122());
+            traitsAckPacket->write(missing.instanceID.toRfc4122());
+            traitsAckPacket->writePrimitive(missing.neededHash);
+        }
+        _missingAvatarEntities.erase(_missingAvatarEntities.begin(), _missingAvatarEntities.begin() + numMissing);
+
         nodeList->sendPacket(std::move(traitsAckPacket), *avatarMixer);
     }
+}
 
-    while (message->getBytesLeftToRead() > 0) {
+void AvatarHashMap::readBulkAvatarTraits(ReceivedMessage& message, const SharedNodePointer& sendingNode) {
+    while (message.getBytesLeftToRead() > 0) {
         // Trying to read more bytes than available, bail
-        if (message->getBytesLeftToRead() < qint64(NUM_BYTES_RFC4122_UUID +
-                                                   sizeof(AvatarTraits::TraitType))) {
+        if (message.getBytesLeftToRead() < qint64(NUM_BYTES_RFC4122_UUID +
+                                                  sizeof(AvatarTraits::TraitType))) {
             qWarning() << "Malformed bulk trait packet, bailling";
             return;
         }
 
         // read the avatar ID to figure out which avatar this is for
-        auto avatarID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        auto avatarID = QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
 
         // grab the avatar so we can ask it to process trait data
         bool isNewAvatar;
@@ -377,42 +458,42 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
 
         // read the first trait type for this avatar
         AvatarTraits::TraitType traitType;
-        message->readPrimitive(&traitType);
+        message.readPrimitive(&traitType);
 
         // grab the last trait versions for this avatar
         auto& lastProcessedVersions = _processedTraitVersions[avatarID];
 
-        while (traitType != AvatarTraits::NullTrait && message->getBytesLeftToRead() > 0) {
+        while (traitType != AvatarTraits::NullTrait && message.getBytesLeftToRead() > 0) {
             // Trying to read more bytes than available, bail
-            if (message->getBytesLeftToRead() < qint64(sizeof(AvatarTraits::TraitVersion))) {
+            if (message.getBytesLeftToRead() < qint64(sizeof(AvatarTraits::TraitVersion))) {
                 qWarning() << "Malformed bulk trait packet, bailling";
                 return;
             }
 
             AvatarTraits::TraitVersion packetTraitVersion;
-            message->readPrimitive(&packetTraitVersion);
+            message.readPrimitive(&packetTraitVersion);
 
             AvatarTraits::TraitWireSize traitBinarySize;
             bool skipBinaryTrait = false;
 
             if (AvatarTraits::isSimpleTrait(traitType)) {
                 // Trying to read more bytes than available, bail
-                if (message->getBytesLeftToRead() < qint64(sizeof(AvatarTraits::TraitWireSize))) {
+                if (message.getBytesLeftToRead() < qint64(sizeof(AvatarTraits::TraitWireSize))) {
                     qWarning() << "Malformed bulk trait packet, bailling";
                     return;
                 }
 
-                message->readPrimitive(&traitBinarySize);
+                message.readPrimitive(&traitBinarySize);
 
                 // Trying to read more bytes than available, bail
-                if (message->getBytesLeftToRead() < traitBinarySize) {
+                if (message.getBytesLeftToRead() < traitBinarySize) {
                     qWarning() << "Malformed bulk trait packet, bailling";
                     return;
                 }
 
                 // check if this trait version is newer than what we already have for this avatar
                 if (packetTraitVersion > lastProcessedVersions[traitType]) {
-                    auto traitData = message->read(traitBinarySize);
+                    auto traitData = message.read(traitBinarySize);
                     avatar->processTrait(traitType, traitData);
                     _replicas.processTrait(avatarID, traitType, traitData);
                     lastProcessedVersions[traitType] = packetTraitVersion;
@@ -421,30 +502,50 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
                 }
             } else {
                 // Trying to read more bytes than available, bail
-                if (message->getBytesLeftToRead() < qint64(NUM_BYTES_RFC4122_UUID +
-                                                           sizeof(AvatarTraits::TraitWireSize))) {
+                if (message.getBytesLeftToRead() < qint64(NUM_BYTES_RFC4122_UUID +
+                                                          sizeof(AvatarTraits::TraitWireSize))) {
                     qWarning() << "Malformed bulk trait packet, bailling";
                     return;
                 }
 
                 AvatarTraits::TraitInstanceID traitInstanceID =
-                    QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+                    QUuid::fromRfc4122(message.readWithoutCopy(NUM_BYTES_RFC4122_UUID));
 
-                message->readPrimitive(&traitBinarySize);
+                message.readPrimitive(&traitBinarySize);
 
                 // Trying to read more bytes than available, bail
-                if (traitBinarySize < -1 || message->getBytesLeftToRead() < traitBinarySize) {
+                if (traitBinarySize < -1 || message.getBytesLeftToRead() < traitBinarySize) {
                     qWarning() << "Malformed bulk trait packet, bailling";
                     return;
                 }
 
                 auto& processedInstanceVersion = lastProcessedVersions.getInstanceValueRef(traitType, traitInstanceID);
-                if (packetTraitVersion > processedInstanceVersion) {
+                if (traitType == AvatarTraits::AvatarEntity && traitBinarySize != AvatarTraits::DELETED_TRAIT_SIZE) {
+                    // decoded even when it's not newer, the mixer counts on us holding every blob it sent
+                    QByteArray blob;
+                    bool isMissingBlob = false;
+                    AvatarTraits::EntityBlobHash neededHash;
+                    bool isNewer = packetTraitVersion > processedInstanceVersion;
+                    if (decodeAvatarEntity(avatarID, message.read(traitBinarySize), blob, isMissingBlob, neededHash)) {
+                        if (isNewer) {
+                            avatar->processTraitInstance(traitType, traitInstanceID, blob);
+                            _replicas.processTraitInstance(avatarID, traitType, traitInstanceID, blob);
+                            processedInstanceVersion = packetTraitVersion;
+                        }
+                    } else if (isMissingBlob) {
+                        // left at its version, so that it's taken when the mixer sends it again
+                        if (isNewer) {
+                            _missingAvatarEntities.push_back({ avatarID, traitInstanceID, neededHash });
+                        }
+                    } else {
+                        qWarning() << "Refusing to process malformed avatar entity trait for" << avatarID;
+                    }
+                } else if (packetTraitVersion > processedInstanceVersion) {
                     if (traitBinarySize == AvatarTraits::DELETED_TRAIT_SIZE) {
                         avatar->processDeletedTraitInstance(traitType, traitInstanceID);
                         _replicas.processDeletedTraitInstance(avatarID, traitType, traitInstanceID);
                     } else {
-                        auto traitData = message->read(traitBinarySize);
+                        auto traitData = message.read(traitBinarySize);
                         avatar->processTraitInstance(traitType, traitInstanceID, traitData);
                         _replicas.processTraitInstance(avatarID, traitType, traitInstanceID, traitData);
                     }
@@ -456,15 +557,46 @@ void AvatarHashMap::processBulkAvatarTraits(QSharedPointer<ReceivedMessage> mess
 
             if (skipBinaryTrait && traitBinarySize > 0) {
                 // we didn't read this trait because it was older or because we didn't have an avatar to process it for
-                message->seek(message->getPosition() + traitBinarySize);
+                message.seek(message.getPosition() + traitBinarySize);
             }
 
             // read the next trait type, which is null if there are no more traits for this avatar
-            message->readPrimitive(&traitType);
+            message.readPrimitive(&traitType);
         }
     }
 }
 
+bool AvatarHashMap::decodeAvatarEntity(const QUuid& avatarID, const QByteArray& encoded, QByteArray& blob,
+                                       bool& isMissingBlob, AvatarTraits::EntityBlobHash& neededHash) {
+    isMissingBlob = false;
+
+    AvatarTraits::EntityEncoding encoding;
+    if (!AvatarTraits::readEntityEncoding(encoded, encoding, neededHash)) {
+        return false;
+    }
+
+    QByteArray neededBlob;
+    if (encoding == AvatarTraits::DeflatedFromBaseEntity || encoding == AvatarTraits::ReferencedEntity) {
+        auto heldBlob = _avatarEntityBlobs.object(avatarEntityBlobKey(avatarID, neededHash));
+        if (!heldBlob) {
+            isMissingBlob = true;
+            return false;
+        }
+        neededBlob = *heldBlob;
+    }
+
+    if (!AvatarTraits::decodeEntityBlob(encoded, neededBlob, blob)) {
+        return false;
+    }
+
+    auto hash = encoding == AvatarTraits::ReferencedEntity ? neededHash : AvatarTraits::hashEntityBlob(blob);
+    auto key = avatarEntityBlobKey(avatarID, hash);
+    if (!_avatarEntityBlobs.contains(key)) {
+        _avatarEntityBlobs.insert(key, new QByteArray(blob), blob.size());
+    }
+    return true;
+}
+
 void AvatarHashMap::processKillAvatar(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     // read the node id
     QUuid sessionUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
@@ -13,6 +13,7 @@
 #ifndef hifi_AvatarHashMap_h
 #define hifi_AvatarHashMap_h
 
+#include <QtCore/QCache>
 #include <QtCore/QHash>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QUuid>
@@ -30,7 +31,9 @@
 #include "ScriptAvatarData.h"
 
 #include "AvatarData.h"
+#include "AvatarDataDecoder.h"
 #include "AssociatedTraitValues.h"
+#include "AvatarEntityTraitEncoding.h"
 
 const int CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND = 50;
 const quint64 MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS = USECS_PER_SECOND / CLIENT_TO_AVATAR_MIXER_BROADCAST_FRAMES_PER_SECOND;
@@ -74,6 +77,8 @@ class AvatarHashMap : public QObject, public Dependency {
     SINGLETON_DEPENDENCY
 
 public:
+    virtual ~AvatarHashMap();
+
     AvatarHash getHashCopy() { QReadLocker lock(&_hashLock); return _avatarHash; }
     const AvatarHash getHashCopy() const { QReadLocker lock(&_hashLock); return _avatarHash; }
     int size() { QReadLocker lock(&_hashLock); return _avatarHash.size(); }
@@ -124,6 +129,11 @@ public:
 
     virtual void clearOtherAvatars();
 
+    // with the avatar data decoded on a thread of its own: the average time it takes to decode a BulkAvatarData packet
+    // there, and to apply the packets decoded since the last time here, in ms
+    float getAverageDecodeTime() const { return _decoder ? _decoder->getAverageDecodeTime() : 0.0f; }
+    float getAverageApplyTime() const { return _averageApplyMsecs; }
+
 signals:
 
     /*@jsdoc
@@ -224,9 +234,12 @@ protected slots:
     void processKillAvatar(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
 
 protected:
-    AvatarHashMap();
+    // decodeOnThread has an AvatarDataDecoder decode the avatar data away from this object's thread, which only applies it
+    explicit AvatarHashMap(bool decodeOnThread = false);
 
     virtual AvatarSharedPointer parseAvatarData(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    // the avatar, found or added, to give sessionUUID's data to; nullptr if it is our own or ignored
+    AvatarSharedPointer avatarForData(const QUuid& sessionUUID, const SharedNodePointer& sendingNode);
     virtual AvatarSharedPointer newSharedAvatar(const QUuid& sessionUUID);
     virtual AvatarSharedPointer addAvatar(const QUuid& sessionUUID, const QWeakPointer<Node>& mixerWeakPointer);
     AvatarSharedPointer newOrExistingAvatar(const QUuid& sessionUUID, const QWeakPointer<Node>& mixerWeakPointer,
@@ -242,8 +255,34 @@ protected:
     std::unordered_map<QUuid, AvatarTraits::TraitVersions> _processedTraitVersions;
     AvatarReplicas _replicas;
 
+private slots:
+    void processDecodedMessages();
+
 private:
+    void readBulkAvatarTraits(ReceivedMessage& message, const SharedNodePointer& sendingNode);
+    // decodes an avatar entity trait from the blobs held, isMissingBlob tells if it failed for want of one
+    bool decodeAvatarEntity(const QUuid& avatarID, const QByteArray& encoded, QByteArray& blob, bool& isMissingBlob,
+                            AvatarTraits::EntityBlobHash& neededHash);
+
     QUuid _lastOwnerSessionUUID;
+
+    // the avatar entity blobs received lately, by avatar and hash, for the mixer to send others from or refer to; they
+    // outlive the avatars so that an avatar coming back in range doesn't need its entities sent again
+    static const int AVATAR_ENTITY_BLOBS_CACHE_BYTES = 8 * 1024 * 1024;
+    QCache<QByteArray, QByteArray> _avatarEntityBlobs { AVATAR_ENTITY_BLOBS_CACHE_BYTES };
+
+    // the avatar entities sent from blobs we didn't hold, to tell the mixer about in our next traits ack
+    struct MissingAvatarEntity {
+        QUuid avatarID;
+        AvatarTraits::TraitInstanceID instanceID;
+        AvatarTraits::EntityBlobHash neededHash;
+    };
+    std::vector<MissingAvatarEntity> _missingAvatarEntities;
+
+    AvatarDataDecoder* _decoder { nullptr };
+    AvatarDataDecoder::DecodedMessages _decodedMessages; // the decoder fills the other buffer while these are applied
+    SimpleMovingAverage _applyUsecs;
+    float _averageApplyMsecs { 0.0f };
 };
 
 #endif // hifi_AvatarHashMap_h
@@ -17,6 +17,7 @@
 #include <array>
 #include <vector>
 
+#include <QtCore/QByteArray>
 #include <QtCore/QUuid>
 
 class ExtendedIODevice;
@@ -64,12 +65,19 @@ namespace AvatarTraits {
     qint64 packTrait(TraitType traitType, ExtendedIODevice& destination, const AvatarData& avatar);
     qint64 packVersionedTrait(TraitType traitType, ExtendedIODevice& destination,
                               TraitVersion traitVersion, const AvatarData& avatar);
+    qint64 packVersionedTrait(TraitType traitType, ExtendedIODevice& destination,
+                              TraitVersion traitVersion, const QByteArray& traitBinaryData);
 
     qint64 packTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
                              ExtendedIODevice& destination, AvatarData& avatar);
+    qint64 packTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
+                             ExtendedIODevice& destination, const QByteArray& traitBinaryData);
     qint64 packVersionedTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
                                       ExtendedIODevice& destination, TraitVersion traitVersion,
                                       AvatarData& avatar);
+    qint64 packVersionedTraitInstance(TraitType traitType, TraitInstanceID traitInstanceID,
+                                      ExtendedIODevice& destination, TraitVersion traitVersion,
+                                      const QByteArray& traitBinaryData);
 
     qint64 packInstancedTraitDelete(TraitType traitType, TraitInstanceID instanceID, ExtendedIODevice& destination,
                                            TraitVersion traitVersion = NULL_TRAIT_VERSION);
@@ -17,6 +17,7 @@
 #include <NLPacketList.h>
 
 #include "AvatarData.h"
+#include "AvatarEntityTraitEncoding.h"
 
 ClientTraitsHandler::ClientTraitsHandler(AvatarData* owningAvatar) :
     _owningAvatar(owningAvatar)
@@ -100,6 +101,11 @@ int ClientTraitsHandler::sendChangedTraitsToMixer() {
         // and will setup the packet using the information in the copy
         lock.unlock();
 
+        if (initialSend) {
+            // a new mixer holds none of our avatar entities to encode from
+            _sentAvatarEntityBlobs.clear();
+        }
+
         auto simpleIt = traitStatusesCopy.simpleCBegin();
         while (simpleIt != traitStatusesCopy.simpleCEnd()) {
             // because the vector contains all trait types (for access using trait type as index)
@@ -125,10 +131,17 @@ int ClientTraitsHandler::sendChangedTraitsToMixer() {
                     || instanceIDValuePair.value == Updated) {
                     // this is a changed trait we need to send or we haven't send out trait information yet
                     // ask the owning avatar to pack it
-                    bytesWritten += AvatarTraits::packTraitInstance(instancedIt->traitType, instanceIDValuePair.id,
-                                                                    *traitsPacketList, *_owningAvatar);
+                    if (instancedIt->traitType == AvatarTraits::AvatarEntity) {
+                        bytesWritten += packAvatarEntity(instanceIDValuePair.id, *traitsPacketList);
+                    } else {
+                        bytesWritten += AvatarTraits::packTraitInstance(instancedIt->traitType, instanceIDValuePair.id,
+                                                                        *traitsPacketList, *_owningAvatar);
+                    }
 
                 } else if (!initialSend && instanceIDValuePair.value == Deleted) {
+                    if (instancedIt->traitType == AvatarTraits::AvatarEntity) {
+                        _sentAvatarEntityBlobs.remove(instanceIDValuePair.id);
+                    }
                     // pack delete for this trait instance
                     bytesWritten += AvatarTraits::packInstancedTraitDelete(instancedIt->traitType, instanceIDValuePair.id,
                                                            *traitsPacketList);
@@ -144,6 +157,34 @@ int ClientTraitsHandler::sendChangedTraitsToMixer() {
     return bytesWritten;
 }
 
+qint64 ClientTraitsHandler::packAvatarEntity(AvatarTraits::TraitInstanceID instanceID, ExtendedIODevice& destination) {
+    auto blob = _owningAvatar->packTraitInstance(AvatarTraits::AvatarEntity, instanceID);
+    if (blob.isNull()) {
+        // deleted since it was marked as updated, which packs as a delete
+        _sentAvatarEntityBlobs.remove(instanceID);
+        return AvatarTraits::packTraitInstance(AvatarTraits::AvatarEntity, instanceID, destination, blob);
+    }
+
+    // the mixer decodes the traits in the order they're packed, so any entity sent before this one is a base it holds:
+    // this entity's previous blob if it has one, else the entity sent last, which likely shares most of its properties
+    QByteArray base;
+    auto previous = _sentAvatarEntityBlobs.constFind(instanceID);
+    if (previous != _sentAvatarEntityBlobs.constEnd()) {
+        base = previous.value();
+    } else if (!_sentAvatarEntityBlobs.isEmpty()) {
+        auto lastSent = _sentAvatarEntityBlobs.constFind(_lastSentAvatarEntityID);
+        base = lastSent != _sentAvatarEntityBlobs.constEnd() ? lastSent.value() : _sentAvatarEntityBlobs.constBegin().value();
+    }
+
+    auto bytesWritten = AvatarTraits::packTraitInstance(AvatarTraits::AvatarEntity, instanceID, destination,
+                                                        AvatarTraits::encodeEntityBlob(blob, base));
+    if (bytesWritten > 0) {
+        _sentAvatarEntityBlobs[instanceID] = blob;
+        _lastSentAvatarEntityID = instanceID;
+    }
+    return bytesWritten;
+}
+
 void ClientTraitsHandler::processTraitOverride(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
     if (sendingNode->getType() == NodeType::AvatarMixer) {
         Lock lock(_traitLock);
@@ -12,6 +12,7 @@
 #ifndef hifi_ClientTraitsHandler_h
 #define hifi_ClientTraitsHandler_h
 
+#include <QtCore/QHash>
 #include <QtCore/QSharedPointer>
 
 #include <ReceivedMessage.h>
@@ -20,6 +21,7 @@
 #include "Node.h"
 
 class AvatarData;
+class ExtendedIODevice;
 
 class ClientTraitsHandler : public QObject {
     Q_OBJECT
@@ -49,6 +51,8 @@ private:
         Deleted
     };
 
+    qint64 packAvatarEntity(AvatarTraits::TraitInstanceID instanceID, ExtendedIODevice& destination);
+
     AvatarData* const _owningAvatar;
 
     Mutex _traitLock;
@@ -59,6 +63,11 @@ private:
     
     bool _shouldPerformInitialSend { false };
     bool _hasChangedTraits { false };
+
+    // the blob each avatar entity was last sent to this mixer with, which the mixer holds, and the bases of the next
+    // encodings; only touched while sending
+    QHash<AvatarTraits::TraitInstanceID, QByteArray> _sentAvatarEntityBlobs;
+    AvatarTraits::TraitInstanceID _lastSentAvatarEntityID;
 };
 
 #endif // hifi_ClientTraitsHandler_h
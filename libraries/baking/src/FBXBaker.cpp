@@ -50,10 +50,10 @@ void FBXBaker::bakeProcessedSource(const hfm::Model::Pointer& hfmModel, const st
     rewriteAndBakeSceneModels(hfmModel->meshes, dracoMeshes, dracoMaterialLists);
 }
 
-void FBXBaker::replaceMeshNodeWithDraco(FBXNode& meshNode, const QByteArray& dracoMeshBytes, const std::vector<hifi::ByteArray>& dracoMaterialList) {
+void FBXBaker::replaceMeshNodeWithDraco(FBXNode& meshNode, const QByteArray& dracoMeshBytes, const std::vector<hifi::ByteArray>& dracoMaterialList, const QVector<float>& lodErrors) {
     // Compress mesh information and store in dracoMeshNode
     FBXNode dracoMeshNode;
-    bool success = buildDracoMeshNode(dracoMeshNode, dracoMeshBytes, dracoMaterialList);
+    bool success = buildDracoMeshNode(dracoMeshNode, dracoMeshBytes, dracoMaterialList, lodErrors);
 
     if (!success) {
         return;
@@ -108,7 +108,7 @@ void FBXBaker::rewriteAndBakeSceneModels(const QVector<hfm::Mesh>& meshes, const
                 if (object->name == "Geometry") {
                     if (object->properties.at(2) == "Mesh") {
                         int meshNum = meshIndexToRuntimeOrder[meshIndex];
-                        replaceMeshNodeWithDraco(*object, dracoMeshes[meshNum], dracoMaterialLists[meshNum]);
+                        replaceMeshNodeWithDraco(*object, dracoMeshes[meshNum], dracoMaterialLists[meshNum], meshes[meshNum].lodErrors);
                         meshIndex++;
                     }
                     object++;
@@ -133,7 +133,7 @@ void FBXBaker::rewriteAndBakeSceneModels(const QVector<hfm::Mesh>& meshes, const
                         } else if (modelChild.name == "Vertices") {
                             // This model is also a mesh
                             int meshNum = meshIndexToRuntimeOrder[meshIndex];
-                            replaceMeshNodeWithDraco(*object, dracoMeshes[meshNum], dracoMaterialLists[meshNum]);
+                            replaceMeshNodeWithDraco(*object, dracoMeshes[meshNum], dracoMaterialLists[meshNum], meshes[meshNum].lodErrors);
                             meshIndex++;
                         }
                     }
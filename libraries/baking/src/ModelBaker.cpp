@@ -20,6 +20,7 @@
 #include <FBXSerializer.h>
 
 #include <model-baker/Baker.h>
+#include <model-baker/BuildDracoMeshTask.h>
 #include <model-baker/PrepareJointsTask.h>
 
 #include <FBXWriter.h>
@@ -45,6 +46,12 @@
 
 #include <QJsonArray>
 
+static const QString DRACO_PROFILE_FIELD = "dracoProfile";
+static const QString DRACO_LARGE_MESH_PROFILE_FIELD = "dracoLargeMeshProfile";
+
+QString ModelBaker::_dracoProfile = DEFAULT_DRACO_PROFILE;
+QString ModelBaker::_dracoLargeMeshProfile;
+
 ModelBaker::ModelBaker(const QUrl& inputModelURL, const QString& bakedOutputDirectory, const QString& originalOutputDirectory, bool hasBeenBaked) :
     _originalInputModelURL(inputModelURL),
     _modelURL(inputModelURL),
@@ -72,6 +79,15 @@ void ModelBaker::setMapping(const hifi::VariantHash& mapping) {
     _mapping = mapping;
 }
 
+bool ModelBaker::setDracoProfiles(const QString& profile, const QString& largeMeshProfile) {
+    if (!DracoProfile::find(profile) || (!largeMeshProfile.isEmpty() && !DracoProfile::find(largeMeshProfile))) {
+        return false;
+    }
+    _dracoProfile = profile;
+    _dracoLargeMeshProfile = largeMeshProfile;
+    return true;
+}
+
 QUrl ModelBaker::getFullOutputMappingURL() const {
     QUrl appendedURL = _outputMappingURL;
     appendedURL.setFragment(_outputURLSuffix.fragment());
@@ -240,7 +256,12 @@ void ModelBaker::bakeSourceCopy() {
         baker::Baker baker(loadedModel, serializerMapping, _mappingURL);
         auto config = baker.getConfiguration();
         // Enable compressed draco mesh generation
-        config->getJobConfig("BuildDracoMesh")->setEnabled(true);
+        auto dracoConfig = (BuildDracoMeshConfig*)config->getJobConfig("BuildDracoMesh");
+        dracoConfig->setEnabled(true);
+        dracoConfig->profile = _mapping.value(DRACO_PROFILE_FIELD, _dracoProfile).toString();
+        dracoConfig->largeMeshProfile = _mapping.value(DRACO_LARGE_MESH_PROFILE_FIELD, _dracoLargeMeshProfile).toString();
+        // Enable the levels of detail, which are stored in the draco meshes
+        config->getJobConfig("BuildMeshLODs")->setEnabled(true);
         // Do not permit potentially lossy modification of joint data meant for runtime
         ((PrepareJointsConfig*)config->getJobConfig("PrepareJoints"))->passthrough = true;
     
@@ -442,7 +463,7 @@ void ModelBaker::abort() {
     }
 }
 
-bool ModelBaker::buildDracoMeshNode(FBXNode& dracoMeshNode, const QByteArray& dracoMeshBytes, const std::vector<hifi::ByteArray>& dracoMaterialList) {
+bool ModelBaker::buildDracoMeshNode(FBXNode& dracoMeshNode, const QByteArray& dracoMeshBytes, const std::vector<hifi::ByteArray>& dracoMaterialList, const QVector<float>& lodErrors) {
     if (dracoMeshBytes.isEmpty()) {
         handleWarning("Empty mesh detected in model: '" + _modelURL.toString() + "'. It will be included in the baked output.");
     }
@@ -468,6 +489,15 @@ bool ModelBaker::buildDracoMeshNode(FBXNode& dracoMeshNode, const QByteArray& dr
             materialListNode.properties.append(materialID);
         }
         dracoNode.children.append(materialListNode);
+
+        if (!lodErrors.isEmpty()) {
+            FBXNode lodErrorsNode;
+            lodErrorsNode.name = "LODErrors";
+            for (float lodError : lodErrors) {
+                lodErrorsNode.properties.append(lodError);
+            }
+            dracoNode.children.append(lodErrorsNode);
+        }
     }
     
     dracoMeshNode = dracoNode;
@@ -48,9 +48,13 @@ public:
 
     void initializeOutputDirs();
 
-    bool buildDracoMeshNode(FBXNode& dracoMeshNode, const QByteArray& dracoMeshBytes, const std::vector<hifi::ByteArray>& dracoMaterialList);
+    bool buildDracoMeshNode(FBXNode& dracoMeshNode, const QByteArray& dracoMeshBytes, const std::vector<hifi::ByteArray>& dracoMaterialList, const QVector<float>& lodErrors = QVector<float>());
     virtual void setWasAborted(bool wasAborted) override;
 
+    // the Draco profiles of the meshes of every model baked, unless its mapping names others with the dracoProfile and
+    // dracoLargeMeshProfile fields; returns false for a name that isn't a profile
+    static bool setDracoProfiles(const QString& profile, const QString& largeMeshProfile = QString());
+
     QUrl getModelURL() const { return _modelURL; }
     QUrl getOriginalInputModelURL() const { return _originalInputModelURL; }
     virtual QUrl getFullOutputMappingURL() const;
@@ -77,6 +81,9 @@ protected:
     QString _bakedOutputDir;
     QString _originalOutputDir;
     QString _originalOutputModelPath;
+
+    static QString _dracoProfile;
+    static QString _dracoLargeMeshProfile;
     QString _outputMappingURL;
     QUrl _bakedModelURL;
 
@@ -126,7 +126,7 @@ void OBJBaker::createFBXNodeTree(FBXNode& rootNode, const hfm::Model::Pointer& h
             newMaterialList.push_back(hifi::ByteArray(std::to_string((int)materialID).c_str()));
         }
         FBXNode dracoNode;
-        buildDracoMeshNode(dracoNode, dracoMesh, newMaterialList);
+        buildDracoMeshNode(dracoNode, dracoMesh, newMaterialList, hfmModel->meshes[0].lodErrors);
         geometryNode.children.append(dracoNode);
     } else {
         handleWarning("Baked mesh for OBJ model '" + _modelURL.toString() + "' is empty");
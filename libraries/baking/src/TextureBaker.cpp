@@ -32,6 +32,38 @@ const QString BAKED_TEXTURE_BCN_SUFFIX = "_bcn.ktx";
 const QString BAKED_META_TEXTURE_SUFFIX = ".texmeta.json";
 
 bool TextureBaker::_compressionEnabled = true;
+size_t TextureBaker::_profileIndex = 0;
+
+const std::vector<TextureBakeProfile>& TextureBakeProfile::getProfiles() {
+    static const int MOBILE_MAX_TEXTURE_NUM_PIXELS = 2048 * 2048;
+    static const std::vector<TextureBakeProfile> profiles {
+        // the first is the default, which serves every client
+        { "all", true, true, ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, 64, 512 },
+        { "desktop", true, false, ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, 64, 512 },
+        // standalone headsets have the memory for smaller textures, and display them at smaller sizes
+        { "mobile", false, true, MOBILE_MAX_TEXTURE_NUM_PIXELS, 64, 256 },
+        // browsers on either kind of hardware, where a small first tier gets something on screen sooner
+        { "web", true, true, MOBILE_MAX_TEXTURE_NUM_PIXELS, 32, 256 }
+    };
+    return profiles;
+}
+
+const TextureBakeProfile* TextureBakeProfile::find(const QString& name) {
+    const auto& profiles = getProfiles();
+    auto profile = std::find_if(profiles.cbegin(), profiles.cend(), [&](const TextureBakeProfile& profile) {
+        return profile.name.compare(name, Qt::CaseInsensitive) == 0;
+    });
+    return profile != profiles.cend() ? &*profile : nullptr;
+}
+
+bool TextureBaker::setProfile(const QString& name) {
+    const TextureBakeProfile* profile = TextureBakeProfile::find(name);
+    if (!profile) {
+        return false;
+    }
+    _profileIndex = profile - TextureBakeProfile::getProfiles().data();
+    return true;
+}
 
 TextureBaker::TextureBaker(const QUrl& textureURL, image::TextureUsage::Type textureType,
                            const QDir& outputDirectory, const QString& baseFilename,
@@ -131,9 +163,14 @@ void TextureBaker::handleTextureNetworkReply() {
 void TextureBaker::processTexture() {
     // the baked textures need to have the source hash added for cache checks in Interface
     // so we add that to the processed texture before handling it off to be serialized
+    const auto& profile = TextureBakeProfile::getProfiles()[_profileIndex];
     QCryptographicHash hasher(QCryptographicHash::Md5);
     hasher.addData(_originalTexture);
     hasher.addData((const char*)&_textureType, sizeof(_textureType));
+    // a profile that shrinks the texture makes a different KTX of it, which the clients must not find in their caches
+    if (profile.maxNumPixels != ABSOLUTE_MAX_TEXTURE_NUM_PIXELS) {
+        hasher.addData((const char*)&profile.maxNumPixels, sizeof(profile.maxNumPixels));
+    }
     auto hashData = hasher.result();
     std::string hash = hashData.toHex().toStdString();
 
@@ -163,13 +200,16 @@ void TextureBaker::processTexture() {
 
     // Compressed KTX
     if (_compressionEnabled) {
-        constexpr std::array<gpu::BackendTarget, 2> BACKEND_TARGETS {{
-            gpu::BackendTarget::GL45,
-            gpu::BackendTarget::GLES32
-        }};
-        for (auto target : BACKEND_TARGETS) {
+        std::vector<gpu::BackendTarget> backendTargets;
+        if (profile.desktopFormats) {
+            backendTargets.push_back(gpu::BackendTarget::GL45);
+        }
+        if (profile.mobileFormats) {
+            backendTargets.push_back(gpu::BackendTarget::GLES32);
+        }
+        for (auto target : backendTargets) {
             auto processedTextureAndSize = image::processImage(buffer, _textureURL.toString().toStdString(), image::ColorChannel::NONE,
-                                                               ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, _textureType, true,
+                                                               profile.maxNumPixels, _textureType, true,
                                                                target, _abortProcessing);
             if (!processedTextureAndSize.first) {
                 handleError("Could not process texture " + _textureURL.toString());
@@ -205,6 +245,8 @@ void TextureBaker::processTexture() {
             }
             _outputFiles.push_back(filePath);
             meta.availableTextureTypes[memKTX->_header.getGLInternaFormat()] = fileName;
+            meta.mipTiers[memKTX->_header.getGLInternaFormat()] =
+                MipTiers::fromKTX(*memKTX, profile.lowTierMaxDimension, profile.mediumTierMaxDimension);
         }
     }
 
@@ -212,7 +254,7 @@ void TextureBaker::processTexture() {
     if (_textureType == image::TextureUsage::Type::SKY_TEXTURE || _textureType == image::TextureUsage::Type::AMBIENT_TEXTURE) {
         buffer->reset();
         auto processedTextureAndSize = image::processImage(std::move(buffer), _textureURL.toString().toStdString(), image::ColorChannel::NONE,
-                                                           ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, _textureType, false, gpu::BackendTarget::GL45, _abortProcessing);
+                                                           profile.maxNumPixels, _textureType, false, gpu::BackendTarget::GL45, _abortProcessing);
         if (!processedTextureAndSize.first) {
             handleError("Could not process texture " + _textureURL.toString());
             return;
@@ -241,6 +283,7 @@ void TextureBaker::processTexture() {
         }
         _outputFiles.push_back(filePath);
         meta.uncompressed = fileName;
+        meta.uncompressedMipTiers = MipTiers::fromKTX(*memKTX, profile.lowTierMaxDimension, profile.mediumTierMaxDimension);
     } else {
         buffer.reset();
     }
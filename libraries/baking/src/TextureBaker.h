@@ -12,6 +12,8 @@
 #ifndef hifi_TextureBaker_h
 #define hifi_TextureBaker_h
 
+#include <vector>
+
 #include <QtCore/QObject>
 #include <QtCore/QUrl>
 #include <QtCore/QRunnable>
@@ -27,6 +29,21 @@
 extern const QString BAKED_TEXTURE_KTX_EXT;
 extern const QString BAKED_META_TEXTURE_SUFFIX;
 
+// What textures are baked for: the compressed formats of which GPU backends, the largest size, and the mip sizes at which
+// the mips are split into the low, medium and high streaming tiers
+struct TextureBakeProfile {
+    QString name;
+    bool desktopFormats;
+    bool mobileFormats;
+    int maxNumPixels;
+    uint32_t lowTierMaxDimension;
+    uint32_t mediumTierMaxDimension;
+
+    static const std::vector<TextureBakeProfile>& getProfiles();
+    // nullptr for a name that isn't one of the profiles
+    static const TextureBakeProfile* find(const QString& name);
+};
+
 class TextureBaker : public Baker {
     Q_OBJECT
 
@@ -46,6 +63,8 @@ public:
     virtual void setWasAborted(bool wasAborted) override;
 
     static void setCompressionEnabled(bool enabled) { _compressionEnabled = enabled; }
+    // the profile every texture is baked with; returns false for a name that isn't a profile
+    static bool setProfile(const QString& name);
 
     void setMapChannel(graphics::Material::MapChannel mapChannel) { _mapChannel = mapChannel; }
     graphics::Material::MapChannel getMapChannel() const { return _mapChannel; }
@@ -79,6 +98,7 @@ private:
     std::atomic<bool> _abortProcessing { false };
 
     static bool _compressionEnabled;
+    static size_t _profileIndex;
 };
 
 #endif // hifi_TextureBaker_h
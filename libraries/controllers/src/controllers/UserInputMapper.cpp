@@ -8,6 +8,7 @@
 
 #include "UserInputMapper.h"
 
+#include <algorithm>
 #include <set>
 
 #include <QtCore/QThread>
@@ -93,6 +94,7 @@ void UserInputMapper::registerDevice(InputDevice::Pointer device) {
         }
         _inputsByEndpoint[endpoint] = input;
         _endpointsByInput[input] = endpoint;
+        _resetEndpointsChanged = true;
     }
 
     _registeredDevices[deviceID] = device;
@@ -134,6 +136,7 @@ void UserInputMapper::removeDevice(int deviceID) {
         if (endpoint != _endpointsByInput.end()) {
             _inputsByEndpoint.erase((*endpoint).second);
             _endpointsByInput.erase(input);
+            _resetEndpointsChanged = true;
         }
     }
 
@@ -480,20 +483,28 @@ void UserInputMapper::runMappings() {
     if (debugRoutes) {
         qCDebug(controllers) << "Beginning mapping frame";
     }
-    for (const auto& endpointEntry : _endpointsByInput) {
-        endpointEntry.second->reset();
+    if (_resetEndpointsChanged) {
+        _resetEndpoints.clear();
+        _resetEndpoints.reserve(_endpointsByInput.size());
+        for (const auto& endpointEntry : _endpointsByInput) {
+            _resetEndpoints.push_back(endpointEntry.second.get());
+        }
+        _resetEndpointsChanged = false;
+    }
+    for (auto endpoint : _resetEndpoints) {
+        endpoint->reset();
     }
 
     if (debugRoutes) {
         qCDebug(controllers) << "Processing device routes";
     }
     // Now process the current values for each level of the stack
-    applyRoutes(_deviceRoutes);
+    applyRoutes(_compiledDeviceRoutes);
 
     if (debugRoutes) {
         qCDebug(controllers) << "Processing standard routes";
     }
-    applyRoutes(_standardRoutes);
+    applyRoutes(_compiledStandardRoutes);
 
     InputRecorder* inputRecorder = InputRecorder::getInstance();
     if (inputRecorder->isPlayingback()) {
@@ -516,41 +527,58 @@ void UserInputMapper::runMappings() {
     debugRoutes = false;
 }
 
+void UserInputMapper::compileRoutes() {
+    auto compileRouteList = [](const Route::List& routes, CompiledRouteList& compiledRoutes) {
+        compiledRoutes.clear();
+        compiledRoutes.reserve(routes.size());
+        for (const auto& route : routes) {
+            if (!route) {
+                continue;
+            }
+            bool deferrable = route->source->getInput().device == STANDARD_DEVICE;
+            compiledRoutes.push_back({ route.get(), deferrable });
+        }
+    };
+    compileRouteList(_deviceRoutes, _compiledDeviceRoutes);
+    compileRouteList(_standardRoutes, _compiledStandardRoutes);
+    _deferredRoutes.reserve(std::max(_compiledDeviceRoutes.size(), _compiledStandardRoutes.size()));
+}
+
 // Encapsulate the logic that routes should not be read before they are written
-void UserInputMapper::applyRoutes(const Route::List& routes) {
-    Route::List deferredRoutes;
+void UserInputMapper::applyRoutes(const CompiledRouteList& routes) {
+    _deferredRoutes.clear();
 
     for (const auto& route : routes) {
-        if (!route) {
-            continue;
-        }
-
         // Try all the deferred routes
-        deferredRoutes.remove_if([](Route::Pointer route) {
-            return UserInputMapper::applyRoute(route);
-        });
+        if (!_deferredRoutes.empty()) {
+            _deferredRoutes.erase(std::remove_if(_deferredRoutes.begin(), _deferredRoutes.end(),
+                [](const CompiledRoute& deferredRoute) {
+                    return UserInputMapper::applyRoute(deferredRoute);
+                }), _deferredRoutes.end());
+        }
 
         if (!applyRoute(route)) {
-            deferredRoutes.push_back(route);
+            _deferredRoutes.push_back(route);
         }
     }
 
     bool force = true;
-    for (const auto& route : deferredRoutes) {
+    for (const auto& route : _deferredRoutes) {
         UserInputMapper::applyRoute(route, force);
     }
+    _deferredRoutes.clear();
 }
 
 
-bool UserInputMapper::applyRoute(const Route::Pointer& route, bool force) {
+bool UserInputMapper::applyRoute(const CompiledRoute& compiledRoute, bool force) {
+    Route* route = compiledRoute.route;
     if (debugRoutes && route->debug) {
         qCDebug(controllers) << "Applying route " << route->json;
     }
 
     // If the source hasn't been written yet, defer processing of this route
     auto& source = route->source;
-    auto& sourceInput = source->getInput();
-    if (sourceInput.device == STANDARD_DEVICE && !force && source->writeable()) {
+    if (compiledRoute.deferrable && !force && source->writeable()) {
         if (debugRoutes && route->debug) {
             qCDebug(controllers) << "Source not yet written, deferring";
         }
@@ -1217,6 +1245,7 @@ void UserInputMapper::enableMapping(const Mapping::Pointer& mapping) {
         return (value->source->getInput().device == STANDARD_DEVICE);
     });
     _deviceRoutes.insert(_deviceRoutes.begin(), deviceRoutes.begin(), deviceRoutes.end());
+    compileRoutes();
 
     if (!debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
@@ -1233,6 +1262,7 @@ void UserInputMapper::disableMapping(const Mapping::Pointer& mapping) {
     _standardRoutes.remove_if([&](const Route::Pointer& value) {
         return routeSet.count(value) != 0;
     });
+    compileRoutes();
 
     if (debuggableRoutes) {
         debuggableRoutes = hasDebuggableRoute(_deviceRoutes) || hasDebuggableRoute(_standardRoutes);
@@ -16,6 +16,7 @@
 #include <functional>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include <QtQml/QJSValue>
 #include <QtScript/QScriptValue>
@@ -159,8 +160,18 @@ namespace controller {
 
         void runMappings();
 
-        static void applyRoutes(const RouteList& route);
-        static bool applyRoute(const RoutePointer& route, bool force = false);
+        // A route as it's run each frame, with what can be worked out once when the mappings change
+        struct CompiledRoute {
+            Route* route;
+            // routes reading a standard endpoint wait until it's been written this frame
+            bool deferrable;
+        };
+        using CompiledRouteList = std::vector<CompiledRoute>;
+
+        // rebuilds the compiled routes after the mappings changed, so the frames in between don't redo it
+        void compileRoutes();
+        void applyRoutes(const CompiledRouteList& routes);
+        static bool applyRoute(const CompiledRoute& route, bool force = false);
         void enableMapping(const MappingPointer& mapping);
         void disableMapping(const MappingPointer& mapping);
         EndpointPointer endpointFor(const QJSValue& endpoint);
@@ -192,6 +203,14 @@ namespace controller {
         RouteList _deviceRoutes;
         RouteList _standardRoutes;
 
+        CompiledRouteList _compiledDeviceRoutes;
+        CompiledRouteList _compiledStandardRoutes;
+        // kept between frames so that deferring routes doesn't allocate
+        CompiledRouteList _deferredRoutes;
+        // the endpoints reset each frame, rebuilt when devices come and go
+        std::vector<Endpoint*> _resetEndpoints;
+        bool _resetEndpointsChanged { true };
+
         QSet<QString> _loadedRouteJsonFiles;
 
         InputCalibrationData inputCalibrationData;
@@ -57,6 +57,12 @@ using namespace shader::gpu::program;
 
 extern QThread* RENDER_THREAD;
 
+// The frame being presented and the one after it: the render thread works on the next frame while the last one presents,
+// but doesn't get further ahead than that to render frames that would only be dropped
+static const size_t FRAME_QUEUE_DEPTH = 2;
+// The render thread gives up on waiting after this, in case the present thread has stalled or has no plugin to present with
+static const auto MAX_FRAME_QUEUE_WAIT = std::chrono::milliseconds(100);
+
 class PresentThread : public QThread, public Dependency {
     using Mutex = std::mutex;
     using Condition = std::condition_variable;
@@ -410,6 +416,8 @@ void OpenGLDisplayPlugin::customizeContext() {
     }
 
     updateCompositeFramebuffer();
+
+    _lastPresentTime = 0;
 }
 
 void OpenGLDisplayPlugin::uncustomizeContext() {
@@ -430,6 +438,7 @@ void OpenGLDisplayPlugin::uncustomizeContext() {
             _newFrameQueue.pop();
         }
     });
+    _newFrameQueueCondition.notify_one();
 }
 
 // Pressing Alt (and Meta) key alone activates the menubar because its style inherits the
@@ -475,9 +484,14 @@ bool OpenGLDisplayPlugin::eventFilter(QObject* receiver, QEvent* event) {
 }
 
 void OpenGLDisplayPlugin::submitFrame(const gpu::FramePointer& newFrame) {
-    withNonPresentThreadLock([&] {
-        _newFrameQueue.push(newFrame);
+    PROFILE_RANGE(render, __FUNCTION__)
+    assertNotPresentThread();
+    Lock lock(_presentMutex);
+    _newFrameQueueCondition.wait_for(lock, MAX_FRAME_QUEUE_WAIT, [&] {
+        return _newFrameQueue.size() < FRAME_QUEUE_DEPTH - 1;
     });
+    newFrame->submitTime = usecTimestampNow();
+    _newFrameQueue.push(newFrame);
 }
 
 ktx::StoragePointer textureToKtx(const gpu::Texture& texture) {
@@ -604,6 +618,7 @@ void OpenGLDisplayPlugin::updateFrameData() {
             _gpuContext->consumeFrameUpdates(_currentFrame);
         }
     });
+    _newFrameQueueCondition.notify_one();
 }
 
 std::function<void(gpu::Batch&, const gpu::TexturePointer&)> OpenGLDisplayPlugin::getHUDOperator() {
@@ -703,10 +718,12 @@ void OpenGLDisplayPlugin::present(const std::shared_ptr<RefreshRateController>&
         auto correction = getViewCorrection();
         getGLBackend()->setCameraCorrection(correction, _prevRenderView);
         _prevRenderView = correction * _currentFrame->view;
+        bool isNewFrame = false;
         {
             withPresentThreadLock([&] {
                 _renderRate.increment();
-                if (_currentFrame.get() != _lastFrame) {
+                isNewFrame = _currentFrame.get() != _lastFrame;
+                if (isNewFrame) {
                     _newFrameRate.increment();
                 }
                 _lastFrame = _currentFrame.get();
@@ -741,17 +758,41 @@ void OpenGLDisplayPlugin::present(const std::shared_ptr<RefreshRateController>&
             PROFILE_RANGE_EX(render, "internalPresent", 0xff00ffff, frameId)
             internalPresent();
         }
+        updatePresentTimings(isNewFrame, refreshRateController);
 
         gpu::Backend::freeGPUMemSize.set(gpu::gl::getFreeDedicatedMemory());
     } else if (alwaysPresent()) {
         refreshRateController->clockEndTime();
         internalPresent();
+        updatePresentTimings(false, refreshRateController);
     } else {
         refreshRateController->clockEndTime();
     }
     _movingAveragePresent.addSample((float)(usecTimestampNow() - startPresent));
 }
 
+void OpenGLDisplayPlugin::updatePresentTimings(bool isNewFrame, const std::shared_ptr<RefreshRateController>& refreshRateController) {
+    auto now = usecTimestampNow();
+    if (isNewFrame && _currentFrame->submitTime != 0) {
+        _movingAverageLatency.addSample((float)(now - _currentFrame->submitTime));
+    }
+
+    // Outside of VR the present thread is held to the refresh rate limit, so that's the rate it means to present at
+    float targetRate = getTargetFrameRate();
+    if (!isHmd()) {
+        targetRate = std::min(targetRate, (float)refreshRateController->getRefreshRateLimitPeriod());
+    }
+    if (_lastPresentTime != 0 && targetRate > 0.0f) {
+        // a present more than half a period late missed the vsyncs in between
+        float periods = (float)(now - _lastPresentTime) * targetRate / (float)USECS_PER_SECOND;
+        int missedVsyncs = (int)(periods + 0.5f) - 1;
+        if (missedVsyncs > 0) {
+            _missedVsyncRate.increment(missedVsyncs);
+        }
+    }
+    _lastPresentTime = now;
+}
+
 float OpenGLDisplayPlugin::newFramePresentRate() const {
     return _newFrameRate.rate();
 }
@@ -760,6 +801,14 @@ float OpenGLDisplayPlugin::droppedFrameRate() const {
     return _droppedFrameRate.rate();
 }
 
+float OpenGLDisplayPlugin::presentLatency() const {
+    return _movingAverageLatency.average / (float)USECS_PER_MSEC;
+}
+
+float OpenGLDisplayPlugin::missedVsyncRate() const {
+    return _missedVsyncRate.rate();
+}
+
 float OpenGLDisplayPlugin::presentRate() const {
     return _presentRate.rate();
 }
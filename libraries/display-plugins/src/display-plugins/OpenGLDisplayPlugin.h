@@ -70,6 +70,10 @@ public:
 
     float droppedFrameRate() const override;
 
+    float presentLatency() const override;
+
+    float missedVsyncRate() const override;
+
     float renderRate() const override;
 
     bool beginFrameRender(uint32_t frameIndex) override;
@@ -136,17 +140,23 @@ protected:
     void withOtherThreadContext(std::function<void()> f) const;
 
     void present(const std::shared_ptr<RefreshRateController>& refreshRateController);
+    void updatePresentTimings(bool isNewFrame, const std::shared_ptr<RefreshRateController>& refreshRateController);
     virtual void swapBuffers();
 
     void render(std::function<void(gpu::Batch& batch)> f);
 
     bool _vsyncEnabled{ true };
     QThread* _presentThread{ nullptr };
+    // The frames the render thread has submitted, at most one ahead of the frame being presented
     std::queue<gpu::FramePointer> _newFrameQueue;
+    Condition _newFrameQueueCondition;
     RateCounter<200> _droppedFrameRate;
     RateCounter<200> _newFrameRate;
     RateCounter<200> _presentRate;
     RateCounter<200> _renderRate;
+    RateCounter<200> _missedVsyncRate;
+    MovingAverage<float, 10> _movingAverageLatency;
+    uint64_t _lastPresentTime { 0 };
 
     gpu::FramePointer _currentFrame;
     gpu::Frame* _lastFrame{ nullptr };
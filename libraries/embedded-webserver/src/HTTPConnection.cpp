@@ -15,11 +15,11 @@
 
 #include <QBuffer>
 #include <QCryptographicHash>
-#include <QTcpSocket>
 #include <QUrlQuery>
 
 #include "EmbeddedWebserverLogging.h"
 #include "HTTPManager.h"
+#include "HTTPSocketIO.h"
 
 const char* HTTPConnection::StatusCode200 = "200 OK";
 const char* HTTPConnection::StatusCode204 = "204 No Content";
@@ -115,27 +115,33 @@ void FileStorage::write(const QByteArray& data) {
 }
 
 
-HTTPConnection::HTTPConnection(QTcpSocket* socket, HTTPManager* parentManager) :
+HTTPConnection::HTTPConnection(qintptr socketDescriptor, HTTPManager* parentManager,
+                               const QSslConfiguration& sslConfiguration) :
     QObject(parentManager),
     _parentManager(parentManager),
-    _socket(socket),
-    _address(socket->peerAddress())
+    _io(new HTTPSocketIO(socketDescriptor, sslConfiguration))
 {
-    // take over ownership of the socket
-    _socket->setParent(this);
+    auto workerThread = parentManager->getNextWorkerThread();
+    if (workerThread) {
+        _io->moveToThread(workerThread);
+    }
 
-    // connect initial slots
-    connect(socket, &QAbstractSocket::readyRead, this, &HTTPConnection::readRequest);
-    connect(socket, &QAbstractSocket::errorOccurred, this, &HTTPConnection::deleteLater);
-    connect(socket, &QAbstractSocket::disconnected, this, &HTTPConnection::deleteLater);
+    connect(_io, &HTTPSocketIO::started, this, [this](QString peerAddress) {
+        _address = QHostAddress(peerAddress);
+    });
+    connect(_io, &HTTPSocketIO::dataRead, this, &HTTPConnection::handleDataRead);
+    connect(_io, &HTTPSocketIO::responseWritten, this, &HTTPConnection::handleResponseWritten);
+    connect(_io, &HTTPSocketIO::closed, this, [this] {
+        _readState = Closed;
+        deleteLater();
+    });
+
+    QMetaObject::invokeMethod(_io, &HTTPSocketIO::start, Qt::QueuedConnection);
 }
 
 HTTPConnection::~HTTPConnection() {
-    // log the destruction
-    if (_socket->error() != QAbstractSocket::UnknownSocketError
-        && _socket->error() != QAbstractSocket::RemoteHostClosedError) {
-        qCDebug(embeddedwebserver) << _socket->errorString() << "-" << _socket->error();
-    }
+    // the socket is closed along with its IO, on its own thread
+    _io->deleteLater();
 }
 
 QHash<QString, QString> HTTPConnection::parseUrlEncodedForm() {
@@ -219,86 +225,146 @@ QList<FormData> HTTPConnection::parseFormData() const {
 }
 
 void HTTPConnection::respond(const char* code, const QByteArray& content, const char* contentType, const Headers& headers) {
-    respondWithStatusAndHeaders(code, contentType, headers, content.size());
+    if (_readState == Closed) {
+        return;
+    }
 
-    _socket->write(content);
+    QByteArray response = statusAndHeaders(code, contentType, headers, content.size());
+    response.append(content);
 
-    _socket->disconnectFromHost();
+    // don't parse any pipelined request until this response is on its way
+    _readState = WritingResponse;
 
-    // make sure we receive no further read notifications
-    disconnect(_socket, &QTcpSocket::readyRead, this, nullptr);
+    auto io = _io;
+    bool keepAlive = _keepAlive;
+    QMetaObject::invokeMethod(_io, [io, response, keepAlive] {
+        io->write(response);
+        io->finishResponse(keepAlive);
+    }, Qt::QueuedConnection);
 }
 
 void HTTPConnection::respond(const char* code, std::unique_ptr<QIODevice> device, const char* contentType, const Headers& headers) {
-    _responseDevice = std::move(device);
+    if (_readState == Closed) {
+        return;
+    }
 
-    if (_responseDevice->isSequential()) {
+    if (device->isSequential()) {
         qWarning() << "Error responding to HTTPConnection: sequential IO devices not supported";
-        respondWithStatusAndHeaders(StatusCode500, contentType, headers, 0);
-        _socket->disconnect(SIGNAL(readyRead()), this);
-        _socket->disconnectFromHost();
+        _keepAlive = false;
+        respond(StatusCode500, QByteArray(), contentType, headers);
         return;
     }
 
-    int totalToBeWritten = _responseDevice->size();
-    respondWithStatusAndHeaders(code, contentType, headers, totalToBeWritten);
+    QByteArray response = statusAndHeaders(code, contentType, headers, device->bytesAvailable());
+    _readState = WritingResponse;
 
-    if (_responseDevice->atEnd()) {
-        _socket->disconnectFromHost();
-    } else {
-        connect(_socket, &QTcpSocket::bytesWritten, this, [this, totalToBeWritten](size_t bytes) mutable {
-            constexpr size_t HTTP_RESPONSE_CHUNK_SIZE = 1024 * 10;
-            if (!_responseDevice->atEnd()) {
-                totalToBeWritten -= _socket->write(_responseDevice->read(HTTP_RESPONSE_CHUNK_SIZE));
-                if (_responseDevice->atEnd()) {
-                    _socket->disconnectFromHost();
-                    disconnect(_socket, &QTcpSocket::bytesWritten, this, nullptr);
-                }
-            }
-        });
+    // the device is read from the socket's thread as it drains, so a large file is never held in memory
+    device->moveToThread(_io->thread());
 
-    }
+    auto io = _io;
+    auto rawDevice = device.release();
+    bool keepAlive = _keepAlive;
+    QMetaObject::invokeMethod(_io, [io, response, rawDevice, keepAlive] {
+        io->write(response);
+        io->streamDevice(rawDevice, keepAlive);
+    }, Qt::QueuedConnection);
+}
 
-    // make sure we receive no further read notifications
-    disconnect(_socket, &QTcpSocket::readyRead, this, nullptr);
+void HTTPConnection::respondAndClose(const char* code, const QByteArray& content) {
+    _keepAlive = false;
+    respond(code, content);
 }
 
-void HTTPConnection::respondWithStatusAndHeaders(const char* code, const char* contentType, const Headers& headers, qint64 contentLength) {
-    _socket->write("HTTP/1.1 ");
+QByteArray HTTPConnection::statusAndHeaders(const char* code, const char* contentType, const Headers& headers,
+                                            qint64 contentLength) {
+    QByteArray response;
+    response.append("HTTP/1.1 ");
 
-    _socket->write(code);
-    _socket->write("\r\n");
+    response.append(code);
+    response.append("\r\n");
 
     for (Headers::const_iterator it = headers.constBegin(), end = headers.constEnd();
             it != end; it++) {
-        _socket->write(it.key());
-        _socket->write(": ");
-        _socket->write(it.value());
-        _socket->write("\r\n");
+        response.append(it.key());
+        response.append(": ");
+        response.append(it.value());
+        response.append("\r\n");
     }
 
+    // the length is always sent so that a kept alive connection knows where the next response starts
+    response.append("Content-Length: ");
+    response.append(QByteArray::number(contentLength));
+    response.append("\r\n");
+
     if (contentLength > 0) {
-        _socket->write("Content-Length: ");
-        _socket->write(QByteArray::number(contentLength));
-        _socket->write("\r\n");
+        response.append("Content-Type: ");
+        response.append(contentType);
+        response.append("\r\n");
+    }
+    response.append(_keepAlive ? "Connection: keep-alive\r\n\r\n" : "Connection: close\r\n\r\n");
+    return response;
+}
 
-        _socket->write("Content-Type: ");
-        _socket->write(contentType);
-        _socket->write("\r\n");
+void HTTPConnection::handleDataRead(QByteArray data) {
+    _readBuffer.append(data);
+
+    bool isParsing = true;
+    while (isParsing) {
+        switch (_readState) {
+            case ReadingRequestLine:
+                isParsing = readRequest();
+                break;
+            case ReadingHeaders:
+                isParsing = readHeaders();
+                break;
+            case ReadingContent:
+                isParsing = readContent();
+                break;
+            default:
+                // wait for the current request to be responded to
+                isParsing = false;
+                break;
+        }
     }
-    _socket->write("Connection: close\r\n\r\n");
 }
 
-void HTTPConnection::readRequest() {
-    if (!_socket->canReadLine()) {
+void HTTPConnection::handleResponseWritten() {
+    if (_readState != WritingResponse) {
         return;
     }
-    if (!_requestUrl.isEmpty()) {
-        qDebug() << "Request URL was already set";
-        return;
+
+    _requestOperation = QNetworkAccessManager::UnknownOperation;
+    _requestUrl.clear();
+    _requestHeaders.clear();
+    _lastRequestHeader.clear();
+    _requestContent.reset();
+
+    _readState = ReadingRequestLine;
+
+    // parse any request that was pipelined behind the last one
+    handleDataRead(QByteArray());
+}
+
+void HTTPConnection::handleRequest() {
+    _readState = HandlingRequest;
+    _parentManager->handleHTTPRequest(this, _requestUrl);
+}
+
+bool HTTPConnection::readRequest() {
+    int lineEnd = _readBuffer.indexOf('\n');
+    if (lineEnd == -1) {
+        return false;
     }
+
     // parse out the method and resource
-    QByteArray line = _socket->readLine().trimmed();
+    QByteArray line = _readBuffer.left(lineEnd).trimmed();
+    _readBuffer.remove(0, lineEnd + 1);
+
+    if (line.isEmpty()) {
+        // clients may send an empty line between kept alive requests
+        return true;
+    }
+
     if (line.startsWith("HEAD")) {
         _requestOperation = QNetworkAccessManager::HeadOperation;
 
@@ -316,57 +382,64 @@ void HTTPConnection::readRequest() {
 
     } else {
         qWarning() << "Unrecognized HTTP operation." << _address << line;
-        respond("400 Bad Request", "Unrecognized operation.");
-        return;
+        respondAndClose("400 Bad Request", "Unrecognized operation.");
+        return false;
     }
     int idx = line.indexOf(' ') + 1;
-    _requestUrl.setUrl(line.mid(idx, line.lastIndexOf(' ') - idx));
+    int versionIndex = line.lastIndexOf(' ');
+    _requestUrl.setUrl(line.mid(idx, versionIndex - idx));
 
-    // switch to reading the header
-    _socket->disconnect(this, SLOT(readRequest()));
-    connect(_socket, SIGNAL(readyRead()), SLOT(readHeaders()));
+    // HTTP/1.1 connections are kept alive unless the client says otherwise, the headers get the final say
+    _keepAlive = line.mid(versionIndex + 1) == "HTTP/1.1";
 
-    // read any headers immediately available
-    readHeaders();
+    // switch to reading the header
+    _readState = ReadingHeaders;
+    return true;
 }
 
-void HTTPConnection::readHeaders() {
-    while (_socket->canReadLine()) {
-        QByteArray line = _socket->readLine();
+bool HTTPConnection::readHeaders() {
+    int lineEnd;
+    while ((lineEnd = _readBuffer.indexOf('\n')) != -1) {
+        QByteArray line = _readBuffer.left(lineEnd + 1);
+        _readBuffer.remove(0, lineEnd + 1);
+
         QByteArray trimmed = line.trimmed();
         if (trimmed.isEmpty()) {
-            _socket->disconnect(this, SLOT(readHeaders()));
+            QByteArray connectionHeader = requestHeader("Connection").toLower();
+            if (connectionHeader.contains("close")) {
+                _keepAlive = false;
+            } else if (connectionHeader.contains("keep-alive")) {
+                _keepAlive = true;
+            }
 
             QByteArray clength = requestHeader("Content-Length");
             if (clength.isEmpty()) {
                 _requestContent = MemoryStorage::make(0);
-                _parentManager->handleHTTPRequest(this, _requestUrl);
-
-            } else {
-                bool success = false;
-                auto length = clength.toInt(&success);
-                if (!success) {
-                    qWarning() << "Invalid header." << _address << trimmed;
-                    respond("400 Bad Request", "The header was malformed.");
-                    return;
-                }
-
-                // Storing big requests in memory gets expensive, especially on servers
-                // with limited memory. So we store big requests in a temporary file on disk
-                // and map it to faster read/write access.
-                static const int MAX_CONTENT_SIZE_IN_MEMORY = 10 * 1000 * 1000;
-                if (length < MAX_CONTENT_SIZE_IN_MEMORY) {
-                    _requestContent = MemoryStorage::make(length);
-                } else {
-                    _requestContent = FileStorage::make(length);
-                }
+                handleRequest();
+                return false;
+            }
 
-                connect(_socket, SIGNAL(readyRead()), SLOT(readContent()));
+            bool success = false;
+            auto length = clength.toInt(&success);
+            if (!success || length < 0) {
+                qWarning() << "Invalid header." << _address << trimmed;
+                respondAndClose("400 Bad Request", "The header was malformed.");
+                return false;
+            }
 
-                // read any content immediately available
-                readContent();
+            // Storing big requests in memory gets expensive, especially on servers
+            // with limited memory. So we store big requests in a temporary file on disk
+            // and map it to faster read/write access.
+            static const int MAX_CONTENT_SIZE_IN_MEMORY = 10 * 1000 * 1000;
+            if (length < MAX_CONTENT_SIZE_IN_MEMORY) {
+                _requestContent = MemoryStorage::make(length);
+            } else {
+                _requestContent = FileStorage::make(length);
             }
-            return;
+
+            // read any content immediately available
+            _readState = ReadingContent;
+            return true;
         }
         char first = line.at(0);
         if (first == ' ' || first == '\t') { // continuation
@@ -376,8 +449,8 @@ void HTTPConnection::readHeaders() {
         int idx = trimmed.indexOf(':');
         if (idx == -1) {
             qWarning() << "Invalid header." << _address << trimmed;
-            respond("400 Bad Request", "The header was malformed.");
-            return;
+            respondAndClose("400 Bad Request", "The header was malformed.");
+            return false;
         }
         _lastRequestHeader = trimmed.left(idx).toLower();
         QByteArray& value = _requestHeaders[_lastRequestHeader];
@@ -386,16 +459,17 @@ void HTTPConnection::readHeaders() {
         }
         value.append(trimmed.mid(idx + 1).trimmed());
     }
+    return false;
 }
 
-void HTTPConnection::readContent() {
-    auto size = std::min(_socket->bytesAvailable(), _requestContent->bytesLeftToWrite());
+bool HTTPConnection::readContent() {
+    int size = (int)std::min((qint64)_readBuffer.size(), _requestContent->bytesLeftToWrite());
 
-    _requestContent->write(_socket->read(size));
+    _requestContent->write(_readBuffer.left(size));
+    _readBuffer.remove(0, size);
 
     if (_requestContent->bytesLeftToWrite() == 0) {
-        _socket->disconnect(this, SLOT(readContent()));
-
-        _parentManager->handleHTTPRequest(this, _requestUrl);
+        handleRequest();
     }
+    return false;
 }
@@ -21,6 +21,7 @@
 #include <QList>
 #include <QtNetwork/QHostAddress>
 #include <QtNetwork/QNetworkAccessManager>
+#include <QtNetwork/QSslConfiguration>
 #include <QObject>
 #include <QPair>
 #include <QTemporaryFile>
@@ -28,8 +29,8 @@
 
 #include <memory>
 
-class QTcpSocket;
 class HTTPManager;
+class HTTPSocketIO;
 class MaskFilter;
 class ServerApp;
 
@@ -39,7 +40,9 @@ typedef QHash<QByteArray, QByteArray> Headers;
 /// A form data element
 typedef QPair<Headers, QByteArray> FormData;
 
-/// Handles a single HTTP connection.
+/// Handles a single HTTP connection, which is kept alive for further requests when the client asks for it. The socket is
+/// read and written from one of the manager's worker threads, if it has any, while requests are handled on the
+/// connection's thread.
 class HTTPConnection : public QObject {
    Q_OBJECT
 
@@ -70,15 +73,13 @@ public:
         virtual void write(const QByteArray& data) = 0;
     };
 
-    /// Initializes the connection.
-    HTTPConnection(QTcpSocket* socket, HTTPManager* parentManager);
+    /// Initializes the connection for an accepted socket, encrypting it with the configuration unless it is null.
+    HTTPConnection(qintptr socketDescriptor, HTTPManager* parentManager,
+        const QSslConfiguration& sslConfiguration = QSslConfiguration());
 
     /// Destroys the connection.
     virtual ~HTTPConnection();
 
-    /// Returns a pointer to the underlying socket, to which WebSocket message bodies should be written.
-    QTcpSocket* socket() const { return _socket; }
-
     /// Returns the IP address on the other side of the connection
     const QHostAddress &peerAddress() const { return _address; }
 
@@ -101,7 +102,7 @@ public:
     /// Duplicate keys are not supported.
     QHash<QString, QString> parseUrlEncodedForm();
 
-    /// Sends a response and closes the connection.
+    /// Sends a response, then closes the connection unless it is being kept alive.
     void respond(const char* code, const QByteArray& content = QByteArray(),
         const char* contentType = DefaultContentType,
         const Headers& headers = Headers());
@@ -111,29 +112,48 @@ public:
 
 protected slots:
 
+    /// Buffers data read from the socket and parses as much of the request as it can.
+    void handleDataRead(QByteArray data);
+
+    /// Starts on the next request once the last response has been written.
+    void handleResponseWritten();
+
+protected:
+    enum ReadState { ReadingRequestLine, ReadingHeaders, ReadingContent, HandlingRequest, WritingResponse, Closed };
+
     /// Reads the request line.
-    void readRequest();
+    bool readRequest();
 
     /// Reads the headers.
-    void readHeaders();
+    bool readHeaders();
 
     /// Reads the content.
-    void readContent();
+    bool readContent();
 
-protected:
-    void respondWithStatusAndHeaders(const char* code, const char* contentType, const Headers& headers, qint64 size);
+    void handleRequest();
+    void respondAndClose(const char* code, const QByteArray& content);
+
+    QByteArray statusAndHeaders(const char* code, const char* contentType, const Headers& headers, qint64 contentLength);
 
     /// The parent HTTP manager
     HTTPManager* _parentManager;
 
-    /// The underlying socket.
-    QTcpSocket* _socket;
+    /// Reads and writes the socket.
+    HTTPSocketIO* _io;
+
+    /// Data read from the socket that hasn't been parsed yet.
+    QByteArray _readBuffer;
+
+    ReadState _readState { ReadingRequestLine };
+
+    /// Whether the connection is kept open after the current response.
+    bool _keepAlive { false };
 
     /// The stored address.
     QHostAddress _address;
 
     /// The requested operation.
-    QNetworkAccessManager::Operation _requestOperation;
+    QNetworkAccessManager::Operation _requestOperation { QNetworkAccessManager::UnknownOperation };
 
     /// The requested URL.
     QUrl _requestUrl;
@@ -146,9 +166,6 @@ protected:
 
     /// The content of the request.
     std::unique_ptr<Storage> _requestContent;
-
-    /// Response content
-    std::unique_ptr<QIODevice> _responseDevice;
 };
 
 #endif // hifi_HTTPConnection_h
@@ -37,16 +37,41 @@ HTTPManager::HTTPManager(const QHostAddress& listenAddress, quint16 port, const
     _isListeningTimer->start(SOCKET_CHECK_INTERVAL_IN_MS);
 }
 
-void HTTPManager::incomingConnection(qintptr socketDescriptor) {
-    QTcpSocket* socket = new QTcpSocket(this);
+HTTPManager::~HTTPManager() {
+    // close the connections first so that their sockets are deleted as the worker threads finish
+    qDeleteAll(findChildren<HTTPConnection*>(QString(), Qt::FindDirectChildrenOnly));
+
+    for (auto thread : _workerThreads) {
+        thread->quit();
+        thread->wait();
+        delete thread;
+    }
+}
 
-    if (socket->setSocketDescriptor(socketDescriptor)) {
-        new HTTPConnection(socket, this);
-    } else {
-        delete socket;
+void HTTPManager::setNumWorkerThreads(int numWorkerThreads) {
+    // connections already on a thread stay there, so threads are only ever added
+    while ((int)_workerThreads.size() < numWorkerThreads) {
+        auto thread = new QThread();
+        thread->setObjectName("HTTP Worker");
+        thread->start();
+        _workerThreads.push_back(thread);
     }
 }
 
+QThread* HTTPManager::getNextWorkerThread() {
+    if (_workerThreads.empty()) {
+        return nullptr;
+    }
+
+    // spread connections over the threads in turn
+    _nextWorkerThread = (_nextWorkerThread + 1) % _workerThreads.size();
+    return _workerThreads[_nextWorkerThread];
+}
+
+void HTTPManager::incomingConnection(qintptr socketDescriptor) {
+    new HTTPConnection(socketDescriptor, this);
+}
+
 bool HTTPManager::handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler) {
     // Reject paths with embedded NULs
     if (url.path().contains(QChar(0x00))) {
@@ -16,7 +16,10 @@
 #ifndef hifi_HTTPManager_h
 #define hifi_HTTPManager_h
 
+#include <vector>
+
 #include <QtNetwork/QTcpServer>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 
 class HTTPConnection;
@@ -34,6 +37,15 @@ class HTTPManager : public QTcpServer, public HTTPRequestHandler {
 public:
     /// Initializes the manager.
     HTTPManager(const QHostAddress& listenAddress, quint16 port, const QString& documentRoot, HTTPRequestHandler* requestHandler = nullptr);
+    virtual ~HTTPManager();
+
+    /// Reads and writes the sockets of new connections on this many threads, so that slow clients, TLS and large
+    /// responses don't hold up the thread requests are handled on. With none the manager's own thread is used.
+    /// The number of threads can only be increased.
+    void setNumWorkerThreads(int numWorkerThreads);
+
+    /// Returns the thread the next connection's socket should be used from, or nullptr for the manager's own.
+    QThread* getNextWorkerThread();
 
     bool handleHTTPRequest(HTTPConnection* connection, const QUrl& url, bool skipSubHandler = false) override;
 
@@ -54,6 +66,9 @@ protected:
     HTTPRequestHandler* _requestHandler;
     QTimer* _isListeningTimer;
     const quint16 _port;
+
+    std::vector<QThread*> _workerThreads;
+    size_t _nextWorkerThread { 0 };
 };
 
 #endif // hifi_HTTPManager_h
@@ -11,15 +11,8 @@
 
 #include "HTTPSConnection.h"
 
-#include "EmbeddedWebserverLogging.h"
-
-HTTPSConnection::HTTPSConnection(QSslSocket* sslSocket, HTTPSManager* parentManager) :
-    HTTPConnection(sslSocket, parentManager)
+// the socket's encryption is started, and its errors logged, by its HTTPSocketIO
+HTTPSConnection::HTTPSConnection(qintptr socketDescriptor, HTTPSManager* parentManager) :
+    HTTPConnection(socketDescriptor, parentManager, parentManager->getSslConfiguration())
 {
-    connect(sslSocket, SIGNAL(sslErrors(const QList<QSslError>&)), this, SLOT(handleSSLErrors(const QList<QSslError>&)));
-    sslSocket->startServerEncryption();
-}
-
-void HTTPSConnection::handleSSLErrors(const QList<QSslError>& errors) {
-    qCDebug(embeddedwebserver) << "SSL errors:" << errors;
 }
@@ -18,9 +18,7 @@
 class HTTPSConnection : public HTTPConnection {
     Q_OBJECT
 public:
-    HTTPSConnection(QSslSocket* sslSocket, HTTPSManager* parentManager);
-protected slots:
-    void handleSSLErrors(const QList<QSslError>& errors);
+    HTTPSConnection(qintptr socketDescriptor, HTTPSManager* parentManager);
 };
 
 #endif // hifi_HTTPSConnection_h
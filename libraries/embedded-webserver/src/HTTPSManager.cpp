@@ -25,18 +25,16 @@ HTTPSManager::HTTPSManager(QHostAddress listenAddress, quint16 port, const QSslC
     
 }
 
+QSslConfiguration HTTPSManager::getSslConfiguration() const {
+    QSslConfiguration configuration = QSslConfiguration::defaultConfiguration();
+    configuration.setLocalCertificate(_certificate);
+    configuration.setPrivateKey(_privateKey);
+    configuration.setPeerVerifyMode(QSslSocket::VerifyNone);
+    return configuration;
+}
+
 void HTTPSManager::incomingConnection(qintptr socketDescriptor) {
-    QSslSocket* sslSocket = new QSslSocket(this);
-    
-    sslSocket->setLocalCertificate(_certificate);
-    sslSocket->setPrivateKey(_privateKey);
-    sslSocket->setPeerVerifyMode(QSslSocket::VerifyNone);
-    
-    if (sslSocket->setSocketDescriptor(socketDescriptor)) {
-        new HTTPSConnection(sslSocket, this);
-    } else {
-        delete sslSocket;
-    }
+    new HTTPSConnection(socketDescriptor, this);
 }
 
 bool HTTPSManager::handleHTTPRequest(HTTPConnection* connection, const QUrl &url, bool skipSubHandler) {
@@ -0,0 +1,152 @@
+//
+//  HTTPSocketIO.cpp
+//  libraries/embedded-webserver/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HTTPSocketIO.h"
+
+#include <QTimer>
+#include <QtNetwork/QSslSocket>
+#include <QtNetwork/QTcpSocket>
+
+#include "EmbeddedWebserverLogging.h"
+
+// a response device is read this much at a time, and only while the socket has less than the high water mark left to send
+static const qint64 RESPONSE_CHUNK_SIZE = 64 * 1024;
+static const qint64 RESPONSE_HIGH_WATER_MARK = 256 * 1024;
+
+// how long a kept-alive connection may sit between requests
+static const int KEEP_ALIVE_IDLE_TIMEOUT_MSECS = 15 * 1000;
+
+HTTPSocketIO::HTTPSocketIO(qintptr socketDescriptor, const QSslConfiguration& sslConfiguration) :
+    _socketDescriptor(socketDescriptor),
+    _sslConfiguration(sslConfiguration)
+{
+}
+
+void HTTPSocketIO::start() {
+    // the socket has to be created on the thread it is used from
+    QSslSocket* sslSocket = nullptr;
+    if (_sslConfiguration.isNull()) {
+        _socket = new QTcpSocket(this);
+    } else {
+        sslSocket = new QSslSocket(this);
+        sslSocket->setSslConfiguration(_sslConfiguration);
+        _socket = sslSocket;
+    }
+
+    if (!_socket->setSocketDescriptor(_socketDescriptor)) {
+        qCWarning(embeddedwebserver) << "Failed to open HTTP socket:" << _socket->errorString();
+        handleClosed();
+        return;
+    }
+
+    _idleTimer = new QTimer(this);
+    _idleTimer->setSingleShot(true);
+    _idleTimer->setInterval(KEEP_ALIVE_IDLE_TIMEOUT_MSECS);
+    connect(_idleTimer, &QTimer::timeout, _socket, &QAbstractSocket::disconnectFromHost);
+
+    connect(_socket, &QAbstractSocket::readyRead, this, &HTTPSocketIO::readAvailable);
+    connect(_socket, &QAbstractSocket::bytesWritten, this, &HTTPSocketIO::writeNextChunk);
+    connect(_socket, &QAbstractSocket::errorOccurred, this, &HTTPSocketIO::handleClosed);
+    connect(_socket, &QAbstractSocket::disconnected, this, &HTTPSocketIO::handleClosed);
+
+    emit started(_socket->peerAddress().toString());
+
+    if (sslSocket) {
+        connect(sslSocket, QOverload<const QList<QSslError>&>::of(&QSslSocket::sslErrors), this,
+                [](const QList<QSslError>& errors) {
+            qCDebug(embeddedwebserver) << "SSL errors:" << errors;
+        });
+        sslSocket->startServerEncryption();
+    }
+
+    // read anything that arrived before we were started
+    readAvailable();
+}
+
+void HTTPSocketIO::readAvailable() {
+    if (!_isReading || _socket->bytesAvailable() == 0) {
+        return;
+    }
+
+    _idleTimer->stop();
+    emit dataRead(_socket->readAll());
+}
+
+void HTTPSocketIO::write(QByteArray data) {
+    if (!_isClosed) {
+        _socket->write(data);
+    }
+}
+
+void HTTPSocketIO::streamDevice(QIODevice* device, bool keepAlive) {
+    _responseDevice.reset(device);
+    _keepAliveAfterDevice = keepAlive;
+    if (_isClosed) {
+        _responseDevice.reset();
+        return;
+    }
+    writeNextChunk();
+}
+
+void HTTPSocketIO::writeNextChunk() {
+    if (!_responseDevice) {
+        return;
+    }
+
+    while (!_responseDevice->atEnd() && _socket->bytesToWrite() < RESPONSE_HIGH_WATER_MARK) {
+        auto chunk = _responseDevice->read(RESPONSE_CHUNK_SIZE);
+        if (chunk.isEmpty()) {
+            qCWarning(embeddedwebserver) << "Error reading HTTP response:" << _responseDevice->errorString();
+            _responseDevice.reset();
+            _socket->abort();
+            return;
+        }
+        _socket->write(chunk);
+    }
+
+    if (_responseDevice->atEnd()) {
+        _responseDevice.reset();
+        finishResponse(_keepAliveAfterDevice);
+    }
+}
+
+void HTTPSocketIO::finishResponse(bool keepAlive) {
+    if (_isClosed || _responseDevice) {
+        // a device is finished once it has been written
+        return;
+    }
+
+    if (keepAlive) {
+        _idleTimer->start();
+        emit responseWritten();
+
+        // a pipelined request may already be waiting
+        readAvailable();
+    } else {
+        // make sure we read no further requests
+        _isReading = false;
+        _socket->disconnectFromHost();
+    }
+}
+
+void HTTPSocketIO::handleClosed() {
+    if (!_isClosed) {
+        _isClosed = true;
+
+        if (_socket && _socket->error() != QAbstractSocket::UnknownSocketError
+            && _socket->error() != QAbstractSocket::RemoteHostClosedError) {
+            qCDebug(embeddedwebserver) << _socket->errorString() << "-" << _socket->error();
+        }
+
+        _responseDevice.reset();
+        emit closed();
+    }
+}
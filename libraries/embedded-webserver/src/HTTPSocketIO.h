@@ -0,0 +1,69 @@
+//
+//  HTTPSocketIO.h
+//  libraries/embedded-webserver/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HTTPSocketIO_h
+#define hifi_HTTPSocketIO_h
+
+#include <memory>
+
+#include <QIODevice>
+#include <QObject>
+#include <QtNetwork/QSslConfiguration>
+
+class QTcpSocket;
+class QTimer;
+
+/// Does the reading and writing for an HTTPConnection on the socket's thread, which is one of the HTTPManager's worker
+/// threads if it has any, so that slow clients and large responses are streamed without holding up the connection's thread.
+class HTTPSocketIO : public QObject {
+    Q_OBJECT
+
+public:
+    /// Takes an accepted socket descriptor, and the configuration to encrypt it with unless it is null.
+    HTTPSocketIO(qintptr socketDescriptor, const QSslConfiguration& sslConfiguration = QSslConfiguration());
+
+public slots:
+    /// Creates the socket and starts reading from it, called from the thread it will be used from.
+    void start();
+
+    void write(QByteArray data);
+
+    /// Writes the whole device out as the socket drains, taking ownership of it. The device must already be on this
+    /// object's thread.
+    void streamDevice(QIODevice* device, bool keepAlive);
+
+    /// Ends the response written so far, either waiting for the next request or closing the connection once it has been
+    /// sent.
+    void finishResponse(bool keepAlive);
+
+signals:
+    void started(QString peerAddress);
+    void dataRead(QByteArray data);
+    void responseWritten();
+    void closed();
+
+private slots:
+    void readAvailable();
+    void writeNextChunk();
+    void handleClosed();
+
+private:
+    qintptr _socketDescriptor;
+    QSslConfiguration _sslConfiguration;
+    QTcpSocket* _socket { nullptr };
+    std::unique_ptr<QIODevice> _responseDevice;
+    bool _keepAliveAfterDevice { false };
+    bool _isReading { true };
+    bool _isClosed { false };
+    QTimer* _idleTimer { nullptr };
+};
+
+#endif // hifi_HTTPSocketIO_h
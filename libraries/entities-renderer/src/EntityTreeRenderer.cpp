@@ -404,7 +404,8 @@ void EntityTreeRenderer::addPendingEntities(const render::ScenePointer& scene, r
     }
 
     if (!_entitiesToAdd.empty()) {
-        std::unordered_set<EntityItemID> processedIds;
+        std::vector<EntityItemPointer> entitiesToAdd;
+        entitiesToAdd.reserve(_entitiesToAdd.size());
         for (const auto& entry : _entitiesToAdd) {
             auto entity = entry.second.lock();
             if (!entity) {
@@ -416,6 +417,48 @@ void EntityTreeRenderer::addPendingEntities(const render::ScenePointer& scene, r
             if (!entity->isParentPathComplete()) {
                 continue;
             }
+            entitiesToAdd.push_back(entity);
+        }
+
+        uint64_t addStart = usecTimestampNow();
+        // the budget always applies, so a burst is spread over frames even before the average cost is known
+        uint64_t expiry = addStart + MAX_ADD_RENDERABLES_TIME_BUDGET;
+        float expectedAddCost = _avgRenderableAddCost * entitiesToAdd.size();
+        if (expectedAddCost >= MAX_ADD_RENDERABLES_TIME_BUDGET) {
+            // a burst of new entities, such as a domain loading, is added over several frames, the most visible first
+            class SortableEntity final : public PrioritySortUtil::Sortable {
+            public:
+                SortableEntity(const EntityItemPointer& entity, uint64_t timestamp) : _entity(entity), _timestamp(timestamp) { }
+
+                glm::vec3 getPosition() const override { return _entity->getWorldPosition(); }
+                float getRadius() const override { return 0.5f * _entity->getQueryAACube().getScale(); }
+                uint64_t getTimestamp() const override { return _timestamp; }
+
+                const EntityItemPointer& getEntity() const { return _entity; }
+            private:
+                EntityItemPointer _entity;
+                uint64_t _timestamp;
+            };
+
+            PROFILE_RANGE_EX(simulation_physics, "SortEntitiesToAdd", 0xffff00ff, (uint64_t)entitiesToAdd.size());
+            PrioritySortUtil::PriorityQueue<SortableEntity> sortedEntities(_viewState->getConicalViews());
+            sortedEntities.reserve(entitiesToAdd.size());
+            for (const auto& entity : entitiesToAdd) {
+                // all of them waited as long, as far as the priority is concerned
+                sortedEntities.push(SortableEntity(entity, addStart));
+            }
+            const auto& sortedEntitiesVector = sortedEntities.getSortedVector();
+            for (size_t i = 0; i < sortedEntitiesVector.size(); ++i) {
+                entitiesToAdd[i] = sortedEntitiesVector[i].getEntity();
+            }
+        }
+
+        std::unordered_set<EntityItemID> processedIds;
+        for (const auto& entity : entitiesToAdd) {
+            // always add at least one so that the backlog shrinks however slow adding is
+            if (!processedIds.empty() && usecTimestampNow() > expiry) {
+                break;
+            }
             if (entity->getSpaceIndex() == -1) {
                 std::unique_lock<std::mutex> lock(_spaceLock);
                 auto spaceIndex = _space->allocateID();
@@ -441,6 +484,11 @@ void EntityTreeRenderer::addPendingEntities(const render::ScenePointer& scene, r
                 _entitiesToAdd.erase(processedId);
             }
             forceRecheckEntities();
+
+            // compute average per-entity add cost
+            float cost = (float)(usecTimestampNow() - addStart) / (float)(processedIds.size());
+            const float BLEND = 0.1f;
+            _avgRenderableAddCost = (1.0f - BLEND) * _avgRenderableAddCost + BLEND * cost;
         }
     }
 }
@@ -486,7 +534,7 @@ void EntityTreeRenderer::updateChangedEntities(const render::ScenePointer& scene
         // we expect the cost to updating all renderables to exceed available time budget
         // so we first sort by priority and update in order until out of time
 
-        class SortableRenderer: public PrioritySortUtil::Sortable {
+        class SortableRenderer final : public PrioritySortUtil::Sortable {
         public:
             SortableRenderer(const EntityRendererPointer& renderer) : _renderer(renderer) { }
 
@@ -572,7 +620,9 @@ void EntityTreeRenderer::update(bool simulate) {
                 addPendingEntities(scene, transaction);
 
                 updateChangedEntities(scene, transaction);
+                // everything changed in the scene this frame goes in one transaction
                 scene->enqueueTransaction(transaction);
+                _renderableBacklog = _entitiesToAdd.size() + _renderablesToUpdate.size();
             }
         }
         {
@@ -629,38 +679,39 @@ void EntityTreeRenderer::findBestZoneAndMaybeContainingEntities(QSet<EntityItemI
         LayeredZones oldLayeredZones(_layeredZones);
         _layeredZones.clear();
 
-        // create a list of entities that actually contain the avatar's position
+        // the zone index has already tested the zones' shapes
+        std::vector<ZoneEntityItemPointer> zones;
+        entityTree->getZoneIndex().findContainingZones(_avatarPosition, zones);
+        for (auto& zone : zones) {
+            // if this zone is visible, add it to our layered zones
+            if (zone->getVisible() && renderableIdForEntity(zone) != render::Item::INVALID_ITEM_ID) {
+                _layeredZones.emplace_back(zone);
+            }
+
+            // don't flag a scripted zone as containing the avatar until the script is loaded,
+            // so that the script is awake in time to receive the "entityEntity" call
+            if (zone->getScript().isEmpty() || zone->isScriptPreloadFinished()) {
+                entitiesContainingAvatar << zone->getEntityItemID();
+            }
+        }
+
+        // create a list of the other entities that actually contain the avatar's position
         for (auto& entityID : entityIDs) {
             auto entity = entityTree->findEntityByID(entityID);
-            if (!entity) {
+            if (!entity || entity->getType() == EntityTypes::Zone) {
                 continue;
             }
 
-            auto isZone = entity->getType() == EntityTypes::Zone;
-            auto hasScript = !entity->getScript().isEmpty();
-
-            // only consider entities that are zones or have scripts, all other entities can
+            // only consider entities that have scripts, all other entities can
             // be ignored because they can't have events fired on them.
             // FIXME - this could be optimized further by determining if the script is loaded
             // and if it has either an enterEntity or leaveEntity method
             //
             // also, don't flag a scripted entity as containing the avatar until the script is loaded,
-            // so that the script is awake in time to receive the "entityEntity" call (even if the entity is a zone).
-            bool contains = false;
-            bool scriptHasLoaded = hasScript && entity->isScriptPreloadFinished();
-            if (isZone || scriptHasLoaded) {
-                contains = entity->contains(_avatarPosition);
-            }
-
-            if (contains) {
-                // if this entity is a zone and visible, add it to our layered zones
-                if (isZone && entity->getVisible() && renderableIdForEntity(entity) != render::Item::INVALID_ITEM_ID) {
-                    _layeredZones.emplace_back(std::dynamic_pointer_cast<ZoneEntityItem>(entity));
-                }
-
-                if ((!hasScript && isZone) || scriptHasLoaded) {
-                    entitiesContainingAvatar << entity->getEntityItemID();
-                }
+            // so that the script is awake in time to receive the "entityEntity" call.
+            bool scriptHasLoaded = !entity->getScript().isEmpty() && entity->isScriptPreloadFinished();
+            if (scriptHasLoaded && entity->contains(_avatarPosition)) {
+                entitiesContainingAvatar << entity->getEntityItemID();
             }
         }
 
@@ -141,6 +141,8 @@ public:
 
     size_t getPrevNumEntityUpdates() const { return _prevNumEntityUpdates; }
     size_t getPrevTotalNeededEntityUpdates() const { return _prevTotalNeededEntityUpdates; }
+    // the entities left waiting to be added to the scene or to have their renderables updated after the last frame
+    size_t getRenderableBacklog() const { return _renderableBacklog; }
 
     bool shouldRenderModelEntityPlaceholders() const { return _shouldRenderModelEntityPlaceholders; }
 
@@ -256,11 +258,13 @@ private:
     const float ZONE_CHECK_DISTANCE = 0.001f;
 
     float _avgRenderableUpdateCost { 0.0f };
+    float _avgRenderableAddCost { 20.0f }; // usecs, a rough guess until entities have been added
 
     ReadWriteLockable _changedEntitiesGuard;
     std::unordered_set<EntityItemID> _changedEntities;
     size_t _prevNumEntityUpdates { 0 };
     size_t _prevTotalNeededEntityUpdates { 0 };
+    size_t _renderableBacklog { 0 };
 
     std::unordered_set<EntityRendererPointer> _renderablesToUpdate;
     std::unordered_map<EntityItemID, EntityRendererPointer> _entitiesInScene;
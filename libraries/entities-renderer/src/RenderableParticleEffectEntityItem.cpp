@@ -9,6 +9,9 @@
 //
 
 #include "RenderableParticleEffectEntityItem.h"
+
+#include <algorithm>
+
 #include <StencilMaskPass.h>
 
 #include <GeometryCache.h>
@@ -40,17 +43,13 @@ static ShapePipelinePointer shapePipelineFactory(const ShapePlumber& plumber, co
     return std::make_shared<render::ShapePipeline>(texturedPipeline, nullptr, nullptr, nullptr);
 }
 
-struct GpuParticle {
-    GpuParticle(const glm::vec3& xyzIn, const glm::vec2& uvIn) : xyz(xyzIn), uv(uvIn) {}
-    glm::vec3 xyz; // Position
-    glm::vec2 uv; // Lifetime + seed
-};
-
-using GpuParticles = std::vector<GpuParticle>;
+// the simulation time is brought back by this much when it gets there, before a float loses too much precision
+static const float SIMULATION_TIME_REBASE = 3600.0f;
 
 ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPointer& entity) : Parent(entity) {
     ParticleUniforms uniforms;
     _uniformBuffer = std::make_shared<Buffer>(sizeof(ParticleUniforms), (const gpu::Byte*) &uniforms);
+    _randomGenerator.seed(qHash(entity->getEntityItemID()));
 
     static std::once_flag once;
     std::call_once(once, [] {
@@ -58,9 +57,15 @@ ParticleEffectEntityRenderer::ParticleEffectEntityRenderer(const EntityItemPoint
         CUSTOM_PIPELINE_NUMBER = render::ShapePipeline::registerCustomShapePipelineFactory(shapePipelineFactory);
         _vertexFormat = std::make_shared<Format>();
         _vertexFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element::VEC3F_XYZ,
-            offsetof(GpuParticle, xyz), gpu::Stream::PER_INSTANCE);
+            offsetof(Particle, basePosition), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element::VEC3F_XYZ,
+            offsetof(Particle, relativePosition), gpu::Stream::PER_INSTANCE);
         _vertexFormat->setAttribute(gpu::Stream::COLOR, 0, gpu::Element::VEC2F_UV,
-            offsetof(GpuParticle, uv), gpu::Stream::PER_INSTANCE);
+            offsetof(Particle, emitTimeAndSeed), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::TEXCOORD0, 0, gpu::Element::VEC3F_XYZ,
+            offsetof(Particle, velocity), gpu::Stream::PER_INSTANCE);
+        _vertexFormat->setAttribute(gpu::Stream::TANGENT, 0, gpu::Element::VEC3F_XYZ,
+            offsetof(Particle, acceleration), gpu::Stream::PER_INSTANCE);
     });
 }
 
@@ -82,6 +87,7 @@ void ParticleEffectEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEn
     if (_particleProperties != newParticleProperties) {
         _timeUntilNextEmit = 0;
         _particleProperties = newParticleProperties;
+        resizeParticles(_particleProperties.maxParticles);
         if (!_prevEmitterShouldTrailInitialized) {
             _prevEmitterShouldTrailInitialized = true;
             _prevEmitterShouldTrail = _particleProperties.emission.shouldTrail;
@@ -165,33 +171,47 @@ Item::Bound ParticleEffectEntityRenderer::getBound(RenderArgs* args) {
     return _bound;
 }
 
+// randFloat(), randFloatInRange() and randIntInRange() from an effect's own generator, whose sequence, unlike rand()'s and
+// the standard distributions', is the same everywhere
+static float randFloat(std::mt19937& generator) {
+    return (generator() % 10000) / 10000.0f;
+}
+
+static float randFloatInRange(std::mt19937& generator, float min, float max) {
+    return min + randFloat(generator) * (max - min);
+}
+
+static int randIntInRange(std::mt19937& generator, int min, int max) {
+    return min + (int)(generator() % (uint32_t)(max - min + 1));
+}
+
 // FIXME: these methods assume uniform emitDimensions, need to importance sample based on dimensions
-float importanceSample2DDimension(float startDim) {
+float importanceSample2DDimension(float startDim, std::mt19937& generator) {
     float dimension = 1.0f;
     if (startDim < 1.0f) {
         float innerDimensionSquared = startDim * startDim;
         float outerDimensionSquared = 1.0f;  // pow(particle::MAXIMUM_EMIT_RADIUS_START, 2);
-        float randDimensionSquared = randFloatInRange(innerDimensionSquared, outerDimensionSquared);
+        float randDimensionSquared = randFloatInRange(generator, innerDimensionSquared, outerDimensionSquared);
         dimension = std::sqrt(randDimensionSquared);
     }
     return dimension;
 }
 
-float importanceSample3DDimension(float startDim) {
+float importanceSample3DDimension(float startDim, std::mt19937& generator) {
     float dimension = 1.0f;
     if (startDim < 1.0f) {
         float innerDimensionCubed = startDim * startDim * startDim;
         float outerDimensionCubed = 1.0f;  // pow(particle::MAXIMUM_EMIT_RADIUS_START, 3);
-        float randDimensionCubed = randFloatInRange(innerDimensionCubed, outerDimensionCubed);
+        float randDimensionCubed = randFloatInRange(generator, innerDimensionCubed, outerDimensionCubed);
         dimension = std::cbrt(randDimensionCubed);
     }
     return dimension;
 }
 
-ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createParticle(const Transform& baseTransform, const particle::Properties& particleProperties,
-                                                                                       const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
-                                                                                       const TriangleInfo& triangleInfo) {
-    CpuParticle particle;
+ParticleEffectEntityRenderer::Particle ParticleEffectEntityRenderer::createParticle(const Transform& baseTransform, const particle::Properties& particleProperties,
+                                                                                    const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
+                                                                                    const TriangleInfo& triangleInfo, std::mt19937& randomGenerator) {
+    Particle particle;
 
     const auto& accelerationSpread = particleProperties.emission.acceleration.spread;
     const auto& azimuthStart = particleProperties.azimuth.start;
@@ -205,8 +225,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
     const auto& polarStart = particleProperties.polar.start;
     const auto& polarFinish = particleProperties.polar.finish;
 
-    particle.seed = randFloatInRange(-1.0f, 1.0f);
-    particle.expiration = (uint64_t)(particleProperties.lifespan * USECS_PER_SECOND);
+    particle.emitTimeAndSeed.y = randFloatInRange(randomGenerator, -1.0f, 1.0f);
 
     particle.relativePosition = glm::vec3(0.0f);
     particle.basePosition = baseTransform.getTranslation();
@@ -224,13 +243,13 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
 
         float elevationMinZ = sinf(PI_OVER_TWO - polarFinish);
         float elevationMaxZ = sinf(PI_OVER_TWO - polarStart);
-        float elevation = asinf(elevationMinZ + (elevationMaxZ - elevationMinZ) * randFloat());
+        float elevation = asinf(elevationMinZ + (elevationMaxZ - elevationMinZ) * randFloat(randomGenerator));
 
         float azimuth;
         if (azimuthFinish >= azimuthStart) {
-            azimuth = azimuthStart + (azimuthFinish - azimuthStart) * randFloat();
+            azimuth = azimuthStart + (azimuthFinish - azimuthStart) * randFloat(randomGenerator);
         } else {
-            azimuth = azimuthStart + (TWO_PI + azimuthFinish - azimuthStart) * randFloat();
+            azimuth = azimuthStart + (TWO_PI + azimuthFinish - azimuthStart) * randFloat(randomGenerator);
         }
         // TODO: azimuth and elevation are only used for ellipsoids/circles, but could be used for other shapes too
 
@@ -241,28 +260,28 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
             glm::vec3 emitPosition;
             switch (shapeType) {
                 case SHAPE_TYPE_BOX: {
-                    glm::vec3 dim = importanceSample3DDimension(emitRadiusStart) * 0.5f * emitDimensions;
+                    glm::vec3 dim = importanceSample3DDimension(emitRadiusStart, randomGenerator) * 0.5f * emitDimensions;
 
-                    int side = randIntInRange(0, 5);
+                    int side = randIntInRange(randomGenerator, 0, 5);
                     int axis = side % 3;
                     float direction = side > 2 ? 1.0f : -1.0f;
 
                     emitDirection[axis] = direction;
                     emitPosition[axis] = direction * dim[axis];
                     axis = (axis + 1) % 3;
-                    emitPosition[axis] = dim[axis] * randFloatInRange(-1.0f, 1.0f);
+                    emitPosition[axis] = dim[axis] * randFloatInRange(randomGenerator, -1.0f, 1.0f);
                     axis = (axis + 1) % 3;
-                    emitPosition[axis] = dim[axis] * randFloatInRange(-1.0f, 1.0f);
+                    emitPosition[axis] = dim[axis] * randFloatInRange(randomGenerator, -1.0f, 1.0f);
                     break;
                 }
 
                 case SHAPE_TYPE_CYLINDER_X:
                 case SHAPE_TYPE_CYLINDER_Y:
                 case SHAPE_TYPE_CYLINDER_Z: {
-                    glm::vec3 radii = importanceSample2DDimension(emitRadiusStart) * 0.5f * emitDimensions;
+                    glm::vec3 radii = importanceSample2DDimension(emitRadiusStart, randomGenerator) * 0.5f * emitDimensions;
                     int axis = shapeType - SHAPE_TYPE_CYLINDER_X;
 
-                    emitPosition[axis] = emitDimensions[axis] * randFloatInRange(-0.5f, 0.5f);
+                    emitPosition[axis] = emitDimensions[axis] * randFloatInRange(randomGenerator, -0.5f, 0.5f);
                     emitDirection[axis] = 0.0f;
                     axis = (axis + 1) % 3;
                     emitPosition[axis] = radii[axis] * glm::cos(azimuth);
@@ -275,7 +294,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                 }
 
                 case SHAPE_TYPE_CIRCLE: {
-                    glm::vec2 radii = importanceSample2DDimension(emitRadiusStart) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
+                    glm::vec2 radii = importanceSample2DDimension(emitRadiusStart, randomGenerator) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
                     float x = radii.x * glm::cos(azimuth);
                     float z = radii.y * glm::sin(azimuth);
                     emitPosition = glm::vec3(x, 0.0f, z);
@@ -283,16 +302,16 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                     break;
                 }
                 case SHAPE_TYPE_PLANE: {
-                    glm::vec2 dim = importanceSample2DDimension(emitRadiusStart) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
+                    glm::vec2 dim = importanceSample2DDimension(emitRadiusStart, randomGenerator) * 0.5f * glm::vec2(emitDimensions.x, emitDimensions.z);
 
-                    int side = randIntInRange(0, 3);
+                    int side = randIntInRange(randomGenerator, 0, 3);
                     int axis = side % 2;
                     float direction = side > 1 ? 1.0f : -1.0f;
 
                     glm::vec2 pos;
                     pos[axis] = direction * dim[axis];
                     axis = (axis + 1) % 2;
-                    pos[axis] = dim[axis] * randFloatInRange(-1.0f, 1.0f);
+                    pos[axis] = dim[axis] * randFloatInRange(randomGenerator, -1.0f, 1.0f);
 
                     emitPosition = glm::vec3(pos.x, 0.0f, pos.y);
                     emitDirection = Vectors::UP;
@@ -302,7 +321,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                 case SHAPE_TYPE_COMPOUND: {
                     // if we get here we know that geometryResource is loaded
 
-                    size_t index = randFloat() * triangleInfo.totalSamples;
+                    size_t index = randFloat(randomGenerator) * triangleInfo.totalSamples;
                     Triangle triangle;
                     for (size_t i = 0; i < triangleInfo.samplesPerTriangle.size(); i++) {
                         size_t numSamples = triangleInfo.samplesPerTriangle[i];
@@ -318,14 +337,14 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                     float edgeLength3 = glm::length(triangle.v0 - triangle.v2);
 
                     float perimeter = edgeLength1 + edgeLength2 + edgeLength3;
-                    float fraction1 = randFloatInRange(0.0f, 1.0f);
+                    float fraction1 = randFloatInRange(randomGenerator, 0.0f, 1.0f);
                     float fractionEdge1 = glm::min(fraction1 * perimeter / edgeLength1, 1.0f);
                     float fraction2 = fraction1 - edgeLength1 / perimeter;
                     float fractionEdge2 = glm::clamp(fraction2 * perimeter / edgeLength2, 0.0f, 1.0f);
                     float fraction3 = fraction2 - edgeLength2 / perimeter;
                     float fractionEdge3 = glm::clamp(fraction3 * perimeter / edgeLength3, 0.0f, 1.0f);
 
-                    float dim = importanceSample2DDimension(emitRadiusStart);
+                    float dim = importanceSample2DDimension(emitRadiusStart, randomGenerator);
                     triangle = triangle * (glm::scale(emitDimensions) * triangleInfo.transform);
                     glm::vec3 center = (triangle.v0 + triangle.v1 + triangle.v2) / 3.0f;
                     glm::vec3 v0 = (dim * (triangle.v0 - center)) + center;
@@ -340,7 +359,7 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
                 case SHAPE_TYPE_SPHERE:
                 case SHAPE_TYPE_ELLIPSOID:
                 default: {
-                    glm::vec3 radii = importanceSample3DDimension(emitRadiusStart) * 0.5f * emitDimensions;
+                    glm::vec3 radii = importanceSample3DDimension(emitRadiusStart, randomGenerator) * 0.5f * emitDimensions;
                     float x = radii.x * glm::cos(elevation) * glm::cos(azimuth);
                     float y = radii.y * glm::cos(elevation) * glm::sin(azimuth);
                     float z = radii.z * glm::sin(elevation);
@@ -355,13 +374,57 @@ ParticleEffectEntityRenderer::CpuParticle ParticleEffectEntityRenderer::createPa
             particle.relativePosition += emitOrientation * emitPosition;
         }
     }
-    particle.velocity = (emitSpeed + randFloatInRange(-1.0f, 1.0f) * speedSpread) * (emitOrientation * emitDirection);
-    particle.acceleration = emitAcceleration +
-        glm::vec3(randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f), randFloatInRange(-1.0f, 1.0f)) * accelerationSpread;
+    particle.velocity = (emitSpeed + randFloatInRange(randomGenerator, -1.0f, 1.0f) * speedSpread) * (emitOrientation * emitDirection);
+    // one at a time, so the components draw from the generator in the same order whatever the compiler
+    glm::vec3 accelerationSpreadFactor;
+    accelerationSpreadFactor.x = randFloatInRange(randomGenerator, -1.0f, 1.0f);
+    accelerationSpreadFactor.y = randFloatInRange(randomGenerator, -1.0f, 1.0f);
+    accelerationSpreadFactor.z = randFloatInRange(randomGenerator, -1.0f, 1.0f);
+    particle.acceleration = emitAcceleration + accelerationSpreadFactor * accelerationSpread;
 
     return particle;
 }
 
+void ParticleEffectEntityRenderer::resizeParticles(size_t maxParticles) {
+    if (_particles.size() <= maxParticles && (_nextParticle == _particles.size() || _particles.size() == maxParticles)) {
+        return;
+    }
+
+    // oldest first, then drop the oldest that no longer fit
+    std::rotate(_particles.begin(), _particles.begin() + _nextParticle, _particles.end());
+    if (_particles.size() > maxParticles) {
+        _particles.erase(_particles.begin(), _particles.end() - maxParticles);
+    }
+    _nextParticle = _particles.size() < maxParticles ? _particles.size() : 0;
+    _firstDirtyParticle = 0;
+    _endDirtyParticle = _particles.size();
+}
+
+void ParticleEffectEntityRenderer::emitParticle(const Particle& particle) {
+    size_t maxParticles = _particleProperties.maxParticles;
+    if (maxParticles == 0) {
+        return;
+    }
+
+    size_t index = _nextParticle;
+    if (index == _particles.size()) {
+        _particles.push_back(particle);
+    } else {
+        _particles[index] = particle;
+    }
+    _particles[index].emitTimeAndSeed.x = _simulationTime;
+    _lastEmitTime = _simulationTime;
+    _nextParticle = (index + 1) % maxParticles;
+
+    if (_firstDirtyParticle >= _endDirtyParticle) {
+        _firstDirtyParticle = index;
+        _endDirtyParticle = index + 1;
+    } else {
+        _firstDirtyParticle = std::min(_firstDirtyParticle, index);
+        _endDirtyParticle = std::max(_endDirtyParticle, index + 1);
+    }
+}
+
 void ParticleEffectEntityRenderer::stepSimulation() {
     if (_lastSimulated == 0) {
         _lastSimulated = usecTimestampNow();
@@ -383,7 +446,8 @@ void ParticleEffectEntityRenderer::stepSimulation() {
                     computeTriangles(_geometryResource->getHFMModel());
                 }
                 // emit particle
-                _cpuParticles.push_back(createParticle(modelTransform, _particleProperties, _shapeType, _geometryResource, _triangleInfo));
+                emitParticle(createParticle(modelTransform, _particleProperties, _shapeType, _geometryResource, _triangleInfo,
+                                            _randomGenerator));
                 _timeUntilNextEmit = emitInterval;
                 if (emitInterval < timeRemaining) {
                     timeRemaining -= emitInterval;
@@ -394,41 +458,50 @@ void ParticleEffectEntityRenderer::stepSimulation() {
         }
     }
 
-    // Kill any particles that have expired or are over the max size
-    while (_cpuParticles.size() > _particleProperties.maxParticles || (!_cpuParticles.empty() && _cpuParticles.front().expiration == 0)) {
-        _cpuParticles.pop_front();
-    }
+    // the particles emitted this step have lived through it, as they did when each was integrated
+    _simulationTime += (float)interval / (float)USECS_PER_SECOND;
 
-    const float deltaTime = (float)interval / (float)USECS_PER_SECOND;
-    // update the particles
-    for (auto& particle : _cpuParticles) {
-        if (_prevEmitterShouldTrail != _particleProperties.emission.shouldTrail) {
+    if (_prevEmitterShouldTrail != _particleProperties.emission.shouldTrail) {
+        // keep the particles where they are, now that they move from the other origin
+        for (auto& particle : _particles) {
             if (_prevEmitterShouldTrail) {
                 particle.relativePosition = particle.relativePosition + particle.basePosition - modelTransform.getTranslation();
             }
             particle.basePosition = modelTransform.getTranslation();
         }
-        particle.expiration = particle.expiration >= interval ? particle.expiration - interval : 0;
-        particle.integrate(deltaTime);
+        _firstDirtyParticle = 0;
+        _endDirtyParticle = _particles.size();
     }
     _prevEmitterShouldTrail = _particleProperties.emission.shouldTrail;
 
-    // Build particle primitives
-    static GpuParticles gpuParticles;
-    gpuParticles.clear();
-    gpuParticles.reserve(_cpuParticles.size()); // Reserve space
-    std::transform(_cpuParticles.begin(), _cpuParticles.end(), std::back_inserter(gpuParticles), [this, &modelTransform] (const CpuParticle& particle) {
-        glm::vec3 position = particle.relativePosition + (_particleProperties.emission.shouldTrail ? particle.basePosition : modelTransform.getTranslation());
-        return GpuParticle(position, glm::vec2(particle.lifetime, particle.seed));
-    });
+    if (_simulationTime > SIMULATION_TIME_REBASE) {
+        for (auto& particle : _particles) {
+            particle.emitTimeAndSeed.x -= SIMULATION_TIME_REBASE;
+        }
+        _simulationTime -= SIMULATION_TIME_REBASE;
+        _lastEmitTime -= SIMULATION_TIME_REBASE;
+        _firstDirtyParticle = 0;
+        _endDirtyParticle = _particles.size();
+    }
+
+    auto& uniforms = _uniformBuffer.edit<ParticleUniforms>();
+    uniforms.time = _simulationTime;
+    uniforms.shouldTrail = _particleProperties.emission.shouldTrail ? 1 : 0;
+    uniforms.emitterPosition = glm::vec4(modelTransform.getTranslation(), 1.0f);
 
-    // Update particle buffer
+    // Update particle buffer, only where particles were emitted since the last step
     auto& particleBuffer = _particleBuffer;
-    size_t numBytes = sizeof(GpuParticle) * gpuParticles.size();
-    particleBuffer->resize(numBytes);
-    if (numBytes != 0) {
-        particleBuffer->setData(numBytes, (const gpu::Byte*)gpuParticles.data());
+    size_t numBytes = sizeof(Particle) * _particles.size();
+    if (particleBuffer->getSize() != numBytes) {
+        particleBuffer->resize(numBytes);
+        if (numBytes != 0) {
+            particleBuffer->setData(numBytes, (const gpu::Byte*)_particles.data());
+        }
+    } else if (_firstDirtyParticle < _endDirtyParticle) {
+        particleBuffer->setSubData(sizeof(Particle) * _firstDirtyParticle, sizeof(Particle) * (_endDirtyParticle - _firstDirtyParticle),
+                                   (const gpu::Byte*)(_particles.data() + _firstDirtyParticle));
     }
+    _firstDirtyParticle = _endDirtyParticle = 0;
 }
 
 void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
@@ -436,9 +509,13 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
         return;
     }
 
-    // FIXME migrate simulation to a compute stage
     stepSimulation();
 
+    // none of the particles has lived less than its lifespan
+    if (_particles.empty() || _simulationTime - _lastEmitTime >= _particleProperties.lifespan) {
+        return;
+    }
+
     gpu::Batch& batch = *args->_batch;
     batch.setResourceTexture(0, _networkTexture->getGPUTexture());
 
@@ -459,9 +536,10 @@ void ParticleEffectEntityRenderer::doRender(RenderArgs* args) {
 
     batch.setUniformBuffer(0, _uniformBuffer);
     batch.setInputFormat(_vertexFormat);
-    batch.setInputBuffer(0, _particleBuffer, 0, sizeof(GpuParticle));
+    batch.setInputBuffer(0, _particleBuffer, 0, sizeof(Particle));
 
-    auto numParticles = _particleBuffer->getSize() / sizeof(GpuParticle);
+    // the vertex shader collapses the particles that have expired
+    auto numParticles = _particles.size();
     static const size_t VERTEX_PER_PARTICLE = 4;
     batch.drawInstanced((gpu::uint32)numParticles, gpu::TRIANGLE_STRIP, (gpu::uint32)VERTEX_PER_PARTICLE);
 }
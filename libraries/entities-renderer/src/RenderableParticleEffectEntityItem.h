@@ -11,6 +11,8 @@
 #ifndef hifi_RenderableParticleEffectEntityItem_h
 #define hifi_RenderableParticleEffectEntityItem_h
 
+#include <random>
+
 #include "RenderableEntityItem.h"
 #include <ParticleEffectEntityItem.h>
 #include <TextureCache.h>
@@ -41,25 +43,15 @@ private:
     using Buffer = gpu::Buffer;
     using BufferView = gpu::BufferView;
 
-    // CPU particles
-    // FIXME either switch to GPU compute particles or switch to simd updating of the particles
-    struct CpuParticle {
-        float seed { 0.0f };
-        uint64_t expiration { 0 };
-        float lifetime { 0.0f };
-        glm::vec3 basePosition;
-        glm::vec3 relativePosition;
+    // A particle as it was emitted. Its acceleration is constant, so the vertex shader works out where it is from how long
+    // ago it was emitted, and the CPU only writes the particles it emits.
+    struct Particle {
+        glm::vec3 basePosition; // where the emitter was
+        glm::vec2 emitTimeAndSeed; // emitTime is in the simulation time, see _simulationTime
+        glm::vec3 relativePosition; // from the base position, or from the emitter if the particles don't trail
         glm::vec3 velocity;
         glm::vec3 acceleration;
-
-        void integrate(float deltaTime) {
-            glm::vec3 atSquared = (0.5f * deltaTime * deltaTime) * acceleration;
-            relativePosition += velocity * deltaTime + atSquared;
-            velocity += acceleration * deltaTime;
-            lifetime += deltaTime;
-        }
     };
-    using CpuParticles = std::deque<CpuParticle>;
 
 
     template<typename T>
@@ -76,7 +68,9 @@ private:
         InterpolationData<float> spin;
         float lifespan;
         int rotateWithEntity;
-        glm::vec2 spare;
+        float time; // the simulation time
+        int shouldTrail;
+        glm::vec4 emitterPosition; // xyz
     };
 
     void computeTriangles(const hfm::Model& hfmModel);
@@ -88,17 +82,28 @@ private:
         glm::mat4 transform;
     } _triangleInfo;
 
-    static CpuParticle createParticle(const Transform& baseTransform, const particle::Properties& particleProperties,
-                                      const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
-                                      const TriangleInfo& triangleInfo);
+    static Particle createParticle(const Transform& baseTransform, const particle::Properties& particleProperties,
+                                   const ShapeType& shapeType, const GeometryResource::Pointer& geometryResource,
+                                   const TriangleInfo& triangleInfo, std::mt19937& randomGenerator);
     void stepSimulation();
+    void emitParticle(const Particle& particle);
+    void resizeParticles(size_t maxParticles);
 
     particle::Properties _particleProperties;
     bool _prevEmitterShouldTrail;
     bool _prevEmitterShouldTrailInitialized { false };
-    CpuParticles _cpuParticles;
     bool _emitting { false };
     uint64_t _timeUntilNextEmit { 0 };
+    std::mt19937 _randomGenerator; // seeded from the entity ID, so an effect always emits the same particles
+
+    // The particles are kept in a ring of maxParticles, a new particle taking the place of the oldest, and only the
+    // slots written since the last frame are uploaded
+    std::vector<Particle> _particles;
+    size_t _nextParticle { 0 };
+    size_t _firstDirtyParticle { 0 };
+    size_t _endDirtyParticle { 0 };
+    float _simulationTime { 0.0f }; // in seconds, moves with the simulation steps, which are capped at 60 per second
+    float _lastEmitTime { 0.0f };
     BufferPointer _particleBuffer { std::make_shared<Buffer>() };
     BufferView _uniformBuffer;
     quint64 _lastSimulated { 0 };
@@ -50,13 +50,13 @@
 
 #include <Model.h>
 #include <PerfStat.h>
+#include <Profile.h>
 #include <render/Scene.h>
 
 #ifdef _WIN32
 #pragma warning(push)
 #pragma warning( disable : 4267 )
 #endif
-#include <PolyVoxCore/CubicSurfaceExtractorWithNormals.h>
 #include <PolyVoxCore/MarchingCubesSurfaceExtractor.h>
 #include <PolyVoxCore/SurfaceMesh.h>
 #include <PolyVoxCore/SimpleVolume.h>
@@ -86,6 +86,12 @@ const float MARCHING_CUBE_COLLISION_HULL_OFFSET = 0.5;
 
   Each one depends on the one before it, except that _voxelData is set from _volData if a script edits the voxels.
 
+  _volData is divided into chunks of CHUNK_SIZE voxels a side.  Changing a voxel marks the chunks around it dirty, and
+  baking the mesh meshes only the dirty chunks again, keeping the other chunks' meshes from before; the shape is
+  likewise gathered again only from the chunks that were meshed again.  The cubic styles are meshed by merging the faces
+  that look the same into larger quads, and get a second, coarse mesh of each chunk that the renderer draws when the
+  chunk is far away.
+
   There are booleans to indicate that something has been updated and the dependents now need to be updated.
   _meshReady       -- do we have something to give scripts that ask for the mesh?
   _voxelDataDirty  -- do we need to uncompress data and expand it into _volData?
@@ -226,6 +232,8 @@ void RenderablePolyVoxEntityItem::setVoxelSurfaceStyle(PolyVoxSurfaceStyle voxel
             volSizeChanged = true;
         }
         _voxelSurfaceStyle = voxelSurfaceStyle;
+        // every chunk is meshed differently now
+        markAllChunksDirty();
         startUpdates();
     });
 
@@ -896,6 +904,10 @@ void RenderablePolyVoxEntityItem::setVoxelVolumeSize(const glm::vec3& voxelVolum
         _volData.reset(new PolyVox::SimpleVolume<uint8_t>(PolyVox::Region(lowCorner, highCorner)));
         // having the "outside of voxel-space" value be 255 has helped me notice some problems.
         _volData->setBorderValue(255);
+
+        ivec3 volDataSize { _volData->getWidth(), _volData->getHeight(), _volData->getDepth() };
+        _numChunks = (volDataSize + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        markAllChunksDirty();
     });
 
     tellNeighborsToRecopyEdges(true);
@@ -946,8 +958,28 @@ uint8_t RenderablePolyVoxEntityItem::getVoxelInternal(const ivec3& v) const {
 }
 
 
+void RenderablePolyVoxEntityItem::markChunksDirty(int x, int y, int z) {
+    // the chunks a voxel is in, and those whose surface it shapes: a cubic face looks at the voxel next to it, and
+    // a marching cubes normal at the voxels one further
+    static const int CHUNK_DEPENDENCY_MARGIN = 2;
+    if (_dirtyChunks.empty()) {
+        return;
+    }
+    ivec3 v { x, y, z };
+    ivec3 lowChunk = glm::clamp(glm::max(v - CHUNK_DEPENDENCY_MARGIN, ivec3(0)) / CHUNK_SIZE, ivec3(0), _numChunks - 1);
+    ivec3 highChunk = glm::clamp((v + CHUNK_DEPENDENCY_MARGIN) / CHUNK_SIZE, ivec3(0), _numChunks - 1);
+    loop3(lowChunk, highChunk + 1, [&](const ivec3& chunk) {
+        _dirtyChunks[chunk.x + _numChunks.x * (chunk.y + _numChunks.y * chunk.z)] = true;
+    });
+}
+
+void RenderablePolyVoxEntityItem::markAllChunksDirty() {
+    _dirtyChunks.assign(_numChunks.x * _numChunks.y * _numChunks.z, true);
+}
+
 void RenderablePolyVoxEntityItem::setVoxelMarkNeighbors(int x, int y, int z, uint8_t toValue) {
     _volData->setVoxelAt(x, y, z, toValue);
+    markChunksDirty(x, y, z);
     if (x == 0) {
         _neighborXNeedsUpdate = true;
         startUpdates();
@@ -1200,6 +1232,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1220,6 +1253,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1240,6 +1274,7 @@ void RenderablePolyVoxEntityItem::copyUpperEdgesFromNeighbors() {
                         uint8_t prevValue = _volData->getVoxelAt(x, y, z);
                         if (prevValue != neighborValue) {
                             _volData->setVoxelAt(x, y, z, neighborValue);
+                            markChunksDirty(x, y, z);
                             _volDataDirty = true;
                         }
                     }
@@ -1279,79 +1314,294 @@ void RenderablePolyVoxEntityItem::tellNeighborsToRecopyEdges(bool force) {
 }
 
 
+// The cubic surface of one level of a chunk, each run of faces that look the same merged into one quad. The voxels are
+// taken scale by scale by scale, a block counting as its largest voxel.
+static void greedyMeshChunk(const PolyVox::SimpleVolume<uint8_t>& volData, const ivec3& low, const ivec3& high, int scale,
+                            std::vector<PolyVox::PositionMaterialNormal>& vertices, std::vector<uint32_t>& indices) {
+    const PolyVox::Region& region = volData.getEnclosingRegion();
+    const ivec3 volumeLow { region.getLowerCorner().getX(), region.getLowerCorner().getY(), region.getLowerCorner().getZ() };
+    const ivec3 volumeHigh = ivec3(region.getUpperCorner().getX(), region.getUpperCorner().getY(),
+                                   region.getUpperCorner().getZ()) + 1;
+
+    // the chunk's blocks and one block around them, -1 for a block that is all outside the volume
+    const ivec3 numBlocks = (high - low + scale - 1) / scale;
+    const ivec3 numSamples = numBlocks + 2;
+    std::vector<int> blocks(numSamples.x * numSamples.y * numSamples.z);
+    auto blockAt = [&](const ivec3& block) -> int& {
+        ivec3 sample = block + 1;
+        return blocks[sample.x + numSamples.x * (sample.y + numSamples.y * sample.z)];
+    };
+    loop3(ivec3(-1), numBlocks + 1, [&](const ivec3& block) {
+        ivec3 blockLow = glm::max(low + block * scale, volumeLow);
+        ivec3 blockHigh = glm::min(low + (block + 1) * scale, volumeHigh);
+        int value = -1;
+        loop3(blockLow, blockHigh, [&](const ivec3& v) {
+            value = std::max(value, (int)volData.getVoxelAt(v.x, v.y, v.z));
+        });
+        blockAt(block) = value;
+    });
+
+    // where the side of a block is in voxel space, the last blocks stopping at the end of the chunk
+    auto sideAt = [&](int axis, int block) {
+        return (float)std::min(low[axis] + block * scale, high[axis]) - 0.5f;
+    };
+
+    std::vector<int> mask;
+    for (int axis = 0; axis < 3; axis++) {
+        const int uAxis = (axis + 1) % 3;
+        const int vAxis = (axis + 2) % 3;
+        const int width = numBlocks[uAxis];
+        const int height = numBlocks[vAxis];
+        mask.resize(width * height);
+
+        for (int direction = -1; direction <= 1; direction += 2) {
+            glm::vec3 normal;
+            normal[axis] = (float)direction;
+
+            for (int slice = 0; slice < numBlocks[axis]; slice++) {
+                // the faces of this slice that look out the way of the normal, by the value of their voxel
+                for (int j = 0; j < height; j++) {
+                    for (int i = 0; i < width; i++) {
+                        ivec3 block;
+                        block[axis] = slice;
+                        block[uAxis] = i;
+                        block[vAxis] = j;
+                        int value = blockAt(block);
+                        ivec3 outside = block;
+                        outside[axis] += direction;
+                        mask[i + width * j] = value > 0 && blockAt(outside) == 0 ? value : 0;
+                    }
+                }
+
+                float plane = sideAt(axis, direction > 0 ? slice + 1 : slice);
+                for (int j = 0; j < height; j++) {
+                    for (int i = 0; i < width;) {
+                        int value = mask[i + width * j];
+                        if (value == 0) {
+                            i++;
+                            continue;
+                        }
+
+                        int quadWidth = 1;
+                        while (i + quadWidth < width && mask[i + quadWidth + width * j] == value) {
+                            quadWidth++;
+                        }
+                        int quadHeight = 1;
+                        for (; j + quadHeight < height; quadHeight++) {
+                            bool rowMatches = true;
+                            for (int k = 0; k < quadWidth && rowMatches; k++) {
+                                rowMatches = mask[i + k + width * (j + quadHeight)] == value;
+                            }
+                            if (!rowMatches) {
+                                break;
+                            }
+                        }
+                        for (int l = 0; l < quadHeight; l++) {
+                            for (int k = 0; k < quadWidth; k++) {
+                                mask[i + k + width * (j + l)] = 0;
+                            }
+                        }
+
+                        float u0 = sideAt(uAxis, i);
+                        float u1 = sideAt(uAxis, i + quadWidth);
+                        float v0 = sideAt(vAxis, j);
+                        float v1 = sideAt(vAxis, j + quadHeight);
+                        uint32_t first = (uint32_t)vertices.size();
+                        for (auto corner : { glm::vec2(u0, v0), glm::vec2(u1, v0), glm::vec2(u1, v1), glm::vec2(u0, v1) }) {
+                            glm::vec3 position;
+                            position[axis] = plane;
+                            position[uAxis] = corner.x;
+                            position[vAxis] = corner.y;
+                            vertices.emplace_back(PolyVox::Vector3DFloat(position.x, position.y, position.z),
+                                                  PolyVox::Vector3DFloat(normal.x, normal.y, normal.z), (float)value);
+                        }
+                        // counter-clockwise seen from the way the face looks
+                        if (direction > 0) {
+                            indices.insert(indices.end(), { first, first + 1, first + 2, first, first + 2, first + 3 });
+                        } else {
+                            indices.insert(indices.end(), { first, first + 2, first + 1, first, first + 3, first + 2 });
+                        }
+                        i += quadWidth;
+                    }
+                }
+            }
+        }
+    }
+}
+
+void RenderablePolyVoxEntityItem::meshChunk(Chunk& chunk, const ivec3& chunkCoords, PolyVoxSurfaceStyle voxelSurfaceStyle) {
+    // called by the mesh worker, with _chunksMutex held
+    for (auto& lod : chunk.lods) {
+        lod.vertices.clear();
+        lod.indices.clear();
+    }
+    chunk.shapeDirty = true;
+
+    withReadLock([&] {
+        if (!_volData) {
+            return;
+        }
+        const PolyVox::SimpleVolume<uint8_t>& volData = *_volData;
+        ivec3 volDataSize { volData.getWidth(), volData.getHeight(), volData.getDepth() };
+        ivec3 low = chunkCoords * CHUNK_SIZE;
+        ivec3 high = glm::min(low + CHUNK_SIZE, volDataSize);
+        if (glm::any(glm::greaterThanEqual(low, volDataSize))) {
+            // the volume was resized under the worker, which will have to mesh it all again
+            return;
+        }
+
+        switch (voxelSurfaceStyle) {
+            case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
+            case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
+                // the cells between this chunk's voxels and the first voxels of the next chunk
+                ivec3 upper = glm::min(high, volDataSize - 1);
+                if (glm::any(glm::lessThanEqual(upper, low))) {
+                    break;
+                }
+                PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+                PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
+                    (_volData.get(), PolyVox::Region(PolyVox::Vector3DInt32(low.x, low.y, low.z),
+                                                     PolyVox::Vector3DInt32(upper.x, upper.y, upper.z)), &polyVoxMesh);
+                surfaceExtractor.execute();
+
+                // the extractor puts the vertices relative to the region it was given
+                auto& lod = chunk.lods[0];
+                const PolyVox::Vector3DFloat offset((float)low.x, (float)low.y, (float)low.z);
+                lod.vertices = polyVoxMesh.getRawVertexData();
+                for (auto& vertex : lod.vertices) {
+                    vertex.setPosition(vertex.getPosition() + offset);
+                }
+                lod.indices = polyVoxMesh.getIndices();
+                break;
+            }
+            case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
+            case PolyVoxEntityItem::SURFACE_CUBIC: {
+                for (int lod = 0; lod < NUM_CHUNK_LODS; lod++) {
+                    greedyMeshChunk(volData, low, high, 1 << lod, chunk.lods[lod].vertices, chunk.lods[lod].indices);
+                }
+                break;
+            }
+        }
+    });
+}
+
+static graphics::MeshPointer createPolyVoxMesh(const std::vector<PolyVox::PositionMaterialNormal>& vecVertices,
+                                               const std::vector<uint32_t>& vecIndices) {
+    graphics::MeshPointer mesh(std::make_shared<graphics::Mesh>());
+
+    // convert PolyVox mesh to a Sam mesh
+    auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
+                                                     (gpu::Byte*)vecIndices.data());
+    auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
+    gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
+    mesh->setIndexBuffer(indexBufferView);
+
+    auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
+                                                      (gpu::Byte*)vecVertices.data());
+    auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
+    gpu::BufferView vertexBufferView(vertexBufferPtr, 0,
+                                     vertexBufferPtr->getSize(),
+                                     sizeof(PolyVox::PositionMaterialNormal),
+                                     gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ));
+    mesh->setVertexBuffer(vertexBufferView);
+
+    // TODO -- use 3-byte normals rather than 3-float normals
+    mesh->addAttribute(gpu::Stream::NORMAL,
+                       gpu::BufferView(vertexBufferPtr,
+                                       sizeof(float) * 3, // polyvox mesh is packed: position, normal, material
+                                       vertexBufferPtr->getSize(),
+                                       sizeof(PolyVox::PositionMaterialNormal),
+                                       gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ)));
+
+    std::vector<graphics::Mesh::Part> parts;
+    parts.emplace_back(graphics::Mesh::Part((graphics::Index)0, // startIndex
+                                         (graphics::Index)vecIndices.size(), // numIndices
+                                         (graphics::Index)0, // baseVertex
+                                         graphics::Mesh::TRIANGLES)); // topology
+    mesh->setPartBuffer(gpu::BufferView(new gpu::Buffer(parts.size() * sizeof(graphics::Mesh::Part), (gpu::Byte*) parts.data()),
+                                        gpu::Element::PART_DRAWCALL));
+    return mesh;
+}
+
 void RenderablePolyVoxEntityItem::recomputeMesh() {
-    // use _volData to make a renderable mesh
+    // use _volData to make a renderable mesh, meshing again only the chunks that changed since the last time
     PolyVoxSurfaceStyle voxelSurfaceStyle;
-    withReadLock([&] {
+    ivec3 numChunks;
+    std::vector<bool> dirtyChunks;
+    withWriteLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
+        numChunks = _numChunks;
+        dirtyChunks.swap(_dirtyChunks);
+        _dirtyChunks.assign(dirtyChunks.size(), false);
     });
 
     auto entity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(getThisPointer());
 
-    QtConcurrent::run([entity, voxelSurfaceStyle] {
-        graphics::MeshPointer mesh(std::make_shared<graphics::Mesh>());
+    QtConcurrent::run([entity, voxelSurfaceStyle, numChunks, dirtyChunks] {
+        PROFILE_RANGE(render, "PolyVoxMesh");
+        std::vector<PolyVox::PositionMaterialNormal> vertices;
+        std::vector<uint32_t> indices;
+        std::vector<PolyVox::PositionMaterialNormal> coarseVertices;
+        std::vector<uint32_t> coarseIndices;
+        std::vector<PolyVoxChunkRange> chunkRanges;
+
+        {
+            std::unique_lock<std::mutex> lock(entity->_chunksMutex);
+            auto& chunks = entity->_chunks;
+            if (chunks.size() != dirtyChunks.size()) {
+                chunks.clear();
+                chunks.resize(dirtyChunks.size());
+            }
 
-        // A mesh object to hold the result of surface extraction
-        PolyVox::SurfaceMesh<PolyVox::PositionMaterialNormal> polyVoxMesh;
+            chunkRanges.reserve(chunks.size());
+            size_t index = 0;
+            loop3(ivec3(0), numChunks, [&](const ivec3& chunkCoords) {
+                auto& chunk = chunks[index];
+                if (dirtyChunks[index]) {
+                    entity->meshChunk(chunk, chunkCoords, voxelSurfaceStyle);
+                }
+                index++;
+
+                PolyVoxChunkRange range;
+                glm::vec3 chunkLow = glm::vec3(chunkCoords * CHUNK_SIZE) - 0.5f;
+                range.center = chunkLow + 0.5f * (float)CHUNK_SIZE;
+                range.radius = 0.5f * glm::length(glm::vec3((float)CHUNK_SIZE));
+
+                const auto& fine = chunk.lods[0];
+                range.startIndex = (uint32_t)indices.size();
+                range.numIndices = (uint32_t)fine.indices.size();
+                uint32_t baseVertex = (uint32_t)vertices.size();
+                vertices.insert(vertices.end(), fine.vertices.begin(), fine.vertices.end());
+                for (auto vertexIndex : fine.indices) {
+                    indices.push_back(baseVertex + vertexIndex);
+                }
 
-        entity->withReadLock([&] {
-            PolyVox::SimpleVolume<uint8_t>* volData = entity->getVolData();
-            switch (voxelSurfaceStyle) {
-                case PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES:
-                case PolyVoxEntityItem::SURFACE_MARCHING_CUBES: {
-                    PolyVox::MarchingCubesSurfaceExtractor<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+                const auto& coarse = chunk.lods[NUM_CHUNK_LODS - 1];
+                range.hasCoarse = !coarse.indices.empty();
+                range.coarseStartIndex = (uint32_t)coarseIndices.size();
+                range.coarseNumIndices = (uint32_t)coarse.indices.size();
+                baseVertex = (uint32_t)coarseVertices.size();
+                coarseVertices.insert(coarseVertices.end(), coarse.vertices.begin(), coarse.vertices.end());
+                for (auto vertexIndex : coarse.indices) {
+                    coarseIndices.push_back(baseVertex + vertexIndex);
                 }
-                case PolyVoxEntityItem::SURFACE_EDGED_CUBIC:
-                case PolyVoxEntityItem::SURFACE_CUBIC: {
-                    PolyVox::CubicSurfaceExtractorWithNormals<PolyVox::SimpleVolume<uint8_t>> surfaceExtractor
-                        (volData, volData->getEnclosingRegion(), &polyVoxMesh);
-                    surfaceExtractor.execute();
-                    break;
+
+                if (range.numIndices > 0) {
+                    chunkRanges.push_back(range);
                 }
-            }
-        });
+            });
+        }
 
-        // convert PolyVox mesh to a Sam mesh
-        const std::vector<uint32_t>& vecIndices = polyVoxMesh.getIndices();
-        auto indexBuffer = std::make_shared<gpu::Buffer>(vecIndices.size() * sizeof(uint32_t),
-                                                         (gpu::Byte*)vecIndices.data());
-        auto indexBufferPtr = gpu::BufferPointer(indexBuffer);
-        gpu::BufferView indexBufferView(indexBufferPtr, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::INDEX));
-        mesh->setIndexBuffer(indexBufferView);
-
-        const std::vector<PolyVox::PositionMaterialNormal>& vecVertices = polyVoxMesh.getRawVertexData();
-        auto vertexBuffer = std::make_shared<gpu::Buffer>(vecVertices.size() * sizeof(PolyVox::PositionMaterialNormal),
-                                                          (gpu::Byte*)vecVertices.data());
-        auto vertexBufferPtr = gpu::BufferPointer(vertexBuffer);
-        gpu::BufferView vertexBufferView(vertexBufferPtr, 0,
-                                         vertexBufferPtr->getSize(),
-                                         sizeof(PolyVox::PositionMaterialNormal),
-                                         gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ));
-        mesh->setVertexBuffer(vertexBufferView);
-
-        // TODO -- use 3-byte normals rather than 3-float normals
-        mesh->addAttribute(gpu::Stream::NORMAL,
-                           gpu::BufferView(vertexBufferPtr,
-                                           sizeof(float) * 3, // polyvox mesh is packed: position, normal, material
-                                           vertexBufferPtr->getSize(),
-                                           sizeof(PolyVox::PositionMaterialNormal),
-                                           gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ)));
-
-        std::vector<graphics::Mesh::Part> parts;
-        parts.emplace_back(graphics::Mesh::Part((graphics::Index)0, // startIndex
-                                             (graphics::Index)vecIndices.size(), // numIndices
-                                             (graphics::Index)0, // baseVertex
-                                             graphics::Mesh::TRIANGLES)); // topology
-        mesh->setPartBuffer(gpu::BufferView(new gpu::Buffer(parts.size() * sizeof(graphics::Mesh::Part), (gpu::Byte*) parts.data()),
-                                            gpu::Element::PART_DRAWCALL));
-        entity->setMesh(mesh);
+        graphics::MeshPointer coarseMesh;
+        if (!coarseIndices.empty()) {
+            coarseMesh = createPolyVoxMesh(coarseVertices, coarseIndices);
+        }
+        entity->setMesh(createPolyVoxMesh(vertices, indices), coarseMesh, std::move(chunkRanges));
     });
 }
 
-void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
+void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh, graphics::MeshPointer coarseMesh,
+                                          std::vector<PolyVoxChunkRange> chunkRanges) {
     // this catches the payload from recomputeMesh
     withWriteLock([&] {
         if (!_collisionless) {
@@ -1359,6 +1609,8 @@ void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
         }
         _shapeReady = false;
         _mesh = mesh;
+        _coarseMesh = coarseMesh;
+        _chunkRanges = std::move(chunkRanges);
         _state = PolyVoxState::BakingMeshFinished;
         _meshReady = true;
         startUpdates();
@@ -1367,134 +1619,138 @@ void RenderablePolyVoxEntityItem::setMesh(graphics::MeshPointer mesh) {
     somethingChangedNotification();
 }
 
+void RenderablePolyVoxEntityItem::findChunkCollisionPoints(Chunk& chunk, const ivec3& chunkCoords,
+                                                           PolyVoxSurfaceStyle voxelSurfaceStyle,
+                                                           const glm::vec3& voxelVolumeSize) {
+    // called by the shape worker, with _chunksMutex held.  The points are in voxel space.
+    chunk.points.clear();
+    chunk.shapeDirty = false;
+
+    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
+        voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES) {
+        // pull each triangle in the mesh into a polyhedron which can be collided with
+        const auto& vertices = chunk.lods[0].vertices;
+        const auto& indices = chunk.lods[0].indices;
+        for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+            const PolyVox::Vector3DFloat& v0 = vertices[indices[i]].getPosition();
+            const PolyVox::Vector3DFloat& v1 = vertices[indices[i + 1]].getPosition();
+            const PolyVox::Vector3DFloat& v2 = vertices[indices[i + 2]].getPosition();
+            glm::vec3 p0 { v0.getX(), v0.getY(), v0.getZ() };
+            glm::vec3 p1 { v1.getX(), v1.getY(), v1.getZ() };
+            glm::vec3 p2 { v2.getX(), v2.getY(), v2.getZ() };
+
+            glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
+            glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
+            glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
+
+            // add next convex hull
+            QVector<glm::vec3> pointsInPart;
+            pointsInPart << p0;
+            pointsInPart << p1;
+            pointsInPart << p2;
+            pointsInPart << p3;
+            chunk.points << pointsInPart;
+        }
+        return;
+    }
+
+    // the chunk's voxels, in user voxel-coords
+    ivec3 edge = ivec3(isEdged(voxelSurfaceStyle) ? 1 : 0);
+    ivec3 low = glm::max(chunkCoords * CHUNK_SIZE - edge, ivec3(0));
+    ivec3 high = glm::min((chunkCoords + 1) * CHUNK_SIZE - edge, ivec3(voxelVolumeSize));
+
+    withReadLock([&] {
+        if (!_volData) {
+            return;
+        }
+        loop3(low, high, [&](const ivec3& v) {
+            if (getVoxelInternal(v) == 0) {
+                return;
+            }
+            const auto& x = v.x;
+            const auto& y = v.y;
+            const auto& z = v.z;
+            if (glm::all(glm::greaterThan(v, ivec3(0))) &&
+                glm::all(glm::lessThan(v, ivec3(voxelVolumeSize) - 1)) &&
+                (getVoxelInternal({ x - 1, y, z }) > 0) &&
+                (getVoxelInternal({ x, y - 1, z }) > 0) &&
+                (getVoxelInternal({ x, y, z - 1 }) > 0) &&
+                (getVoxelInternal({ x + 1, y, z }) > 0) &&
+                (getVoxelInternal({ x, y + 1, z }) > 0) &&
+                (getVoxelInternal({ x, y, z + 1 }) > 0)) {
+                // this voxel has neighbors in every cardinal direction, so there's no need
+                // to include it in the collision hull.
+                return;
+            }
+
+            float offL = -0.5f;
+            float offH = 0.5f;
+            if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
+                offL += 1.0f;
+                offH += 1.0f;
+            }
+
+            // add next convex hull
+            QVector<glm::vec3> pointsInPart;
+            pointsInPart << glm::vec3(x + offL, y + offL, z + offL);
+            pointsInPart << glm::vec3(x + offL, y + offL, z + offH);
+            pointsInPart << glm::vec3(x + offL, y + offH, z + offL);
+            pointsInPart << glm::vec3(x + offL, y + offH, z + offH);
+            pointsInPart << glm::vec3(x + offH, y + offL, z + offL);
+            pointsInPart << glm::vec3(x + offH, y + offL, z + offH);
+            pointsInPart << glm::vec3(x + offH, y + offH, z + offL);
+            pointsInPart << glm::vec3(x + offH, y + offH, z + offH);
+            chunk.points << pointsInPart;
+        });
+    });
+}
+
 void RenderablePolyVoxEntityItem::computeShapeInfoWorker() {
-    // this creates a collision-shape for the physics engine.  The shape comes from
-    // _volData for cubic extractors and from _mesh for marching-cube extractors
+    // this creates a collision-shape for the physics engine.  The shape comes from _volData for cubic extractors and
+    // from the chunks' meshes for marching-cube extractors.  Only the chunks meshed again since the last shape
+    // are gone over again; the others' points are kept, in voxel space, from before.
 
     EntityItemPointer entity = getThisPointer();
 
     PolyVoxSurfaceStyle voxelSurfaceStyle;
     glm::vec3 voxelVolumeSize;
-    graphics::MeshPointer mesh;
+    ivec3 numChunks;
 
     withReadLock([&] {
         voxelSurfaceStyle = _voxelSurfaceStyle;
         voxelVolumeSize = _voxelVolumeSize;
-        mesh = _mesh;
+        numChunks = _numChunks;
     });
 
-    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, mesh] {
+    QtConcurrent::run([entity, voxelSurfaceStyle, voxelVolumeSize, numChunks] {
+        PROFILE_RANGE(simulation_physics, "PolyVoxShape");
         auto polyVoxEntity = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity);
         QVector<QVector<glm::vec3>> pointCollection;
         AABox box;
-        glm::mat4 vtoM = std::static_pointer_cast<RenderablePolyVoxEntityItem>(entity)->voxelToLocalMatrix();
-
-        if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_MARCHING_CUBES ||
-            voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_MARCHING_CUBES) {
-            // pull each triangle in the mesh into a polyhedron which can be collided with
-            unsigned int i = 0;
-
-            const gpu::BufferView& vertexBufferView = mesh->getVertexBuffer();
-            const gpu::BufferView& indexBufferView = mesh->getIndexBuffer();
-
-            gpu::BufferView::Iterator<const uint32_t> it = indexBufferView.cbegin<uint32_t>();
-            while (it != indexBufferView.cend<uint32_t>()) {
-                uint32_t p0Index = *(it++);
-                uint32_t p1Index = *(it++);
-                uint32_t p2Index = *(it++);
-
-                const glm::vec3& p0 = vertexBufferView.get<const glm::vec3>(p0Index);
-                const glm::vec3& p1 = vertexBufferView.get<const glm::vec3>(p1Index);
-                const glm::vec3& p2 = vertexBufferView.get<const glm::vec3>(p2Index);
-
-                glm::vec3 av = (p0 + p1 + p2) / 3.0f; // center of the triangular face
-                glm::vec3 normal = glm::normalize(glm::cross(p1 - p0, p2 - p0));
-                glm::vec3 p3 = av - normal * MARCHING_CUBE_COLLISION_HULL_OFFSET;
-
-                glm::vec3 p0Model = glm::vec3(vtoM * glm::vec4(p0, 1.0f));
-                glm::vec3 p1Model = glm::vec3(vtoM * glm::vec4(p1, 1.0f));
-                glm::vec3 p2Model = glm::vec3(vtoM * glm::vec4(p2, 1.0f));
-                glm::vec3 p3Model = glm::vec3(vtoM * glm::vec4(p3, 1.0f));
-
-                box += p0Model;
-                box += p1Model;
-                box += p2Model;
-                box += p3Model;
-
-                QVector<glm::vec3> pointsInPart;
-                pointsInPart << p0Model;
-                pointsInPart << p1Model;
-                pointsInPart << p2Model;
-                pointsInPart << p3Model;
-                // add next convex hull
-                QVector<glm::vec3> newMeshPoints;
-                pointCollection << newMeshPoints;
-                // add points to the new convex hull
-                pointCollection[i++] << pointsInPart;
-            }
-        } else {
-            unsigned int i = 0;
-            polyVoxEntity->forEachVoxelValue(voxelVolumeSize, [&](const ivec3& v, uint8_t value) {
-                if (value > 0) {
-                    const auto& x = v.x;
-                    const auto& y = v.y;
-                    const auto& z = v.z;
-                    if (glm::all(glm::greaterThan(v, ivec3(0))) &&
-                        glm::all(glm::lessThan(v, ivec3(voxelVolumeSize) - 1)) &&
-                        (polyVoxEntity->getVoxelInternal({ x - 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y - 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z - 1 }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x + 1, y, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y + 1, z }) > 0) &&
-                        (polyVoxEntity->getVoxelInternal({ x, y, z + 1 }) > 0)) {
-                        // this voxel has neighbors in every cardinal direction, so there's no need
-                        // to include it in the collision hull.
-                        return;
+        glm::mat4 vtoM = polyVoxEntity->voxelToLocalMatrix();
+
+        {
+            std::unique_lock<std::mutex> lock(polyVoxEntity->_chunksMutex);
+            auto& chunks = polyVoxEntity->_chunks;
+            if (chunks.size() == (size_t)(numChunks.x * numChunks.y * numChunks.z)) {
+                size_t index = 0;
+                loop3(ivec3(0), numChunks, [&](const ivec3& chunkCoords) {
+                    auto& chunk = chunks[index++];
+                    if (chunk.shapeDirty) {
+                        polyVoxEntity->findChunkCollisionPoints(chunk, chunkCoords, voxelSurfaceStyle, voxelVolumeSize);
                     }
-
-                    QVector<glm::vec3> pointsInPart;
-
-                    float offL = -0.5f;
-                    float offH = 0.5f;
-                    if (voxelSurfaceStyle == PolyVoxEntityItem::SURFACE_EDGED_CUBIC) {
-                        offL += 1.0f;
-                        offH += 1.0f;
+                    for (const auto& pointsInPart : chunk.points) {
+                        QVector<glm::vec3> pointsInModel;
+                        pointsInModel.reserve(pointsInPart.size());
+                        for (const auto& point : pointsInPart) {
+                            glm::vec3 pointInModel = glm::vec3(vtoM * glm::vec4(point, 1.0f));
+                            box += pointInModel;
+                            pointsInModel << pointInModel;
+                        }
+                        pointCollection << pointsInModel;
                     }
-
-                    glm::vec3 p000 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offL, 1.0f));
-                    glm::vec3 p001 = glm::vec3(vtoM * glm::vec4(x + offL, y + offL, z + offH, 1.0f));
-                    glm::vec3 p010 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offL, 1.0f));
-                    glm::vec3 p011 = glm::vec3(vtoM * glm::vec4(x + offL, y + offH, z + offH, 1.0f));
-                    glm::vec3 p100 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offL, 1.0f));
-                    glm::vec3 p101 = glm::vec3(vtoM * glm::vec4(x + offH, y + offL, z + offH, 1.0f));
-                    glm::vec3 p110 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offL, 1.0f));
-                    glm::vec3 p111 = glm::vec3(vtoM * glm::vec4(x + offH, y + offH, z + offH, 1.0f));
-
-                    box += p000;
-                    box += p001;
-                    box += p010;
-                    box += p011;
-                    box += p100;
-                    box += p101;
-                    box += p110;
-                    box += p111;
-
-                    pointsInPart << p000;
-                    pointsInPart << p001;
-                    pointsInPart << p010;
-                    pointsInPart << p011;
-                    pointsInPart << p100;
-                    pointsInPart << p101;
-                    pointsInPart << p110;
-                    pointsInPart << p111;
-
-                    // add next convex hull
-                    QVector<glm::vec3> newMeshPoints;
-                    pointCollection << newMeshPoints;
-                    // add points to the new convex hull
-                    pointCollection[i++] << pointsInPart;
-                }
-            });
+                });
+            }
         }
         polyVoxEntity->setCollisionPoints(pointCollection, box);
     });
@@ -1792,12 +2048,20 @@ void PolyVoxEntityRenderer::doRenderUpdateAsynchronousTyped(const TypedEntityPoi
     _lastVoxelVolumeSize = entity->getVoxelVolumeSize();
     _params->setSubData(0, vec4(_lastVoxelVolumeSize, 0.0));
     graphics::MeshPointer newMesh;
+    graphics::MeshPointer newCoarseMesh;
+    std::vector<PolyVoxChunkRange> newChunkRanges;
     entity->withReadLock([&] {
         newMesh = entity->_mesh;
+        if (newMesh != _mesh) {
+            newCoarseMesh = entity->_coarseMesh;
+            newChunkRanges = entity->_chunkRanges;
+        }
     });
 
-    if (newMesh && newMesh->getIndexBuffer()._buffer) {
+    if (newMesh && newMesh->getIndexBuffer()._buffer && newMesh != _mesh) {
         _mesh = newMesh;
+        _coarseMesh = newCoarseMesh;
+        _chunkRanges = std::move(newChunkRanges);
     }
 
     std::array<QString, 3> xyzTextureURLs{ {
@@ -1824,20 +2088,15 @@ void PolyVoxEntityRenderer::doRender(RenderArgs* args) {
     PerformanceTimer perfTimer("RenderablePolyVoxEntityItem::render");
     gpu::Batch& batch = *args->_batch;
 
+    glm::vec3 viewPosition = args->_renderMode == RenderArgs::RenderMode::SHADOW_RENDER_MODE ?
+        BillboardModeHelpers::getPrimaryViewFrustumPosition() : args->getViewFrustum().getPosition();
     glm::mat4 rotation = glm::mat4_cast(BillboardModeHelpers::getBillboardRotation(_position, _orientation, _billboardMode,
-        args->_renderMode == RenderArgs::RenderMode::SHADOW_RENDER_MODE ? BillboardModeHelpers::getPrimaryViewFrustumPosition() : args->getViewFrustum().getPosition()));
-    Transform transform(glm::translate(_position) * rotation * _lastVoxelToLocalMatrix);
+        viewPosition));
+    glm::mat4 voxelToWorld = glm::translate(_position) * rotation * _lastVoxelToLocalMatrix;
+    Transform transform(voxelToWorld);
     batch.setModelTransform(transform);
 
     batch.setInputFormat(_vertexFormat);
-    batch.setInputBuffer(gpu::Stream::POSITION, _mesh->getVertexBuffer()._buffer, 0,
-        sizeof(PolyVox::PositionMaterialNormal));
-
-    // TODO -- should we be setting this?
-    // batch.setInputBuffer(gpu::Stream::NORMAL, mesh->getVertexBuffer()._buffer,
-    //                      12,
-    //                      sizeof(PolyVox::PositionMaterialNormal));
-    batch.setIndexBuffer(gpu::UINT32, _mesh->getIndexBuffer()._buffer, 0);
 
     for (size_t i = 0; i < _xyzTextures.size(); ++i) {
         const auto& texture = _xyzTextures[i];
@@ -1849,7 +2108,63 @@ void PolyVoxEntityRenderer::doRender(RenderArgs* args) {
     }
 
     batch.setUniformBuffer(0, _params);
-    batch.drawIndexed(gpu::TRIANGLES, (gpu::uint32)_mesh->getNumIndices(), 0);
+
+    // a chunk far enough away, for its size, is drawn from the coarse mesh
+    static const float COARSE_CHUNK_DISTANCE_TO_RADIUS = 12.0f;
+    float voxelToWorldScale = glm::compMax(glm::vec3(glm::length(glm::vec3(voxelToWorld[0])),
+                                                     glm::length(glm::vec3(voxelToWorld[1])),
+                                                     glm::length(glm::vec3(voxelToWorld[2]))));
+    std::vector<bool> isCoarse(_chunkRanges.size(), false);
+    bool anyCoarse = false;
+    if (_coarseMesh) {
+        for (size_t i = 0; i < _chunkRanges.size(); i++) {
+            const auto& range = _chunkRanges[i];
+            glm::vec3 center = glm::vec3(voxelToWorld * glm::vec4(range.center, 1.0f));
+            isCoarse[i] = range.hasCoarse &&
+                glm::distance(center, viewPosition) > COARSE_CHUNK_DISTANCE_TO_RADIUS * range.radius * voxelToWorldScale;
+            anyCoarse = anyCoarse || isCoarse[i];
+        }
+    }
+
+    // the chunks follow each other in the meshes, so neighboring chunks that are drawn at the same level are drawn at once
+    auto drawChunks = [&](const graphics::MeshPointer& mesh, bool coarse) {
+        batch.setInputBuffer(gpu::Stream::POSITION, mesh->getVertexBuffer()._buffer, 0,
+            sizeof(PolyVox::PositionMaterialNormal));
+        batch.setIndexBuffer(gpu::UINT32, mesh->getIndexBuffer()._buffer, 0);
+
+        if (_chunkRanges.empty()) {
+            batch.drawIndexed(gpu::TRIANGLES, (gpu::uint32)mesh->getNumIndices(), 0);
+            return;
+        }
+
+        uint32_t runStart = 0;
+        uint32_t runCount = 0;
+        for (size_t i = 0; i < _chunkRanges.size(); i++) {
+            if (isCoarse[i] != coarse) {
+                continue;
+            }
+            const auto& range = _chunkRanges[i];
+            uint32_t start = coarse ? range.coarseStartIndex : range.startIndex;
+            uint32_t count = coarse ? range.coarseNumIndices : range.numIndices;
+            if (runCount > 0 && start == runStart + runCount) {
+                runCount += count;
+                continue;
+            }
+            if (runCount > 0) {
+                batch.drawIndexed(gpu::TRIANGLES, runCount, runStart);
+            }
+            runStart = start;
+            runCount = count;
+        }
+        if (runCount > 0) {
+            batch.drawIndexed(gpu::TRIANGLES, runCount, runStart);
+        }
+    };
+
+    drawChunks(_mesh, false);
+    if (anyCoarse) {
+        drawChunks(_coarseMesh, true);
+    }
 }
 
 QDebug operator<<(QDebug debug, PolyVoxState state) {
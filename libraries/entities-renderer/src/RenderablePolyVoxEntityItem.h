@@ -12,12 +12,16 @@
 #ifndef hifi_RenderablePolyVoxEntityItem_h
 #define hifi_RenderablePolyVoxEntityItem_h
 
+#include <array>
 #include <atomic>
+#include <mutex>
+#include <vector>
 
 #include <QSemaphore>
 
 #include <PolyVoxCore/SimpleVolume.h>
 #include <PolyVoxCore/Raycast.h>
+#include <PolyVoxCore/VertexTypes.h>
 
 #include <gpu/Forward.h>
 #include <gpu/Context.h>
@@ -49,6 +53,17 @@ enum class PolyVoxState {
 
 QDebug operator<<(QDebug debug, PolyVoxState state);
 
+// Where one chunk of the voxel volume is in the entity's meshes, so the renderer can pick the level of detail of each
+struct PolyVoxChunkRange {
+    glm::vec3 center; // in voxel space
+    float radius { 0.0f };
+    uint32_t startIndex { 0 };
+    uint32_t numIndices { 0 };
+    bool hasCoarse { false }; // false when the surface style has no coarse level, and the chunk is always drawn fine
+    uint32_t coarseStartIndex { 0 };
+    uint32_t coarseNumIndices { 0 };
+};
+
 
 class RenderablePolyVoxEntityItem : public PolyVoxEntityItem, public scriptable::ModelProvider {
     friend class render::entities::PolyVoxEntityRenderer;
@@ -119,7 +134,7 @@ public:
     void forEachVoxelValue(const ivec3& voxelSize, std::function<void(const ivec3&, uint8_t)> thunk);
     QByteArray volDataToArray(quint16 voxelXSize, quint16 voxelYSize, quint16 voxelZSize) const;
 
-    void setMesh(graphics::MeshPointer mesh);
+    void setMesh(graphics::MeshPointer mesh, graphics::MeshPointer coarseMesh, std::vector<PolyVoxChunkRange> chunkRanges);
     void setCollisionPoints(ShapeInfo::PointCollection points, AABox box);
     PolyVox::SimpleVolume<uint8_t>* getVolData() { return _volData.get(); }
 
@@ -138,7 +153,23 @@ public:
     virtual void update(const quint64& now) override;
     bool needsToCallUpdate() const override { return _updateNeeded; }
 
+    // the volume is meshed, and its collision points found, CHUNK_SIZE^3 voxels at a time, so that an edit only redoes
+    // the chunks around the voxels it changed
+    static constexpr int CHUNK_SIZE = 16;
+    static constexpr int NUM_CHUNK_LODS = 2; // the voxels, and then the voxels merged two by two by two
+
 private:
+    struct ChunkMesh {
+        std::vector<PolyVox::PositionMaterialNormal> vertices; // in voxel space
+        std::vector<uint32_t> indices;
+    };
+
+    struct Chunk {
+        std::array<ChunkMesh, NUM_CHUNK_LODS> lods; // the coarse level is left empty for marching cubes
+        bool shapeDirty { true };
+        ShapeInfo::PointCollection points; // in voxel space
+    };
+
     bool updateOnCount(const ivec3& v, uint8_t toValue);
     PolyVox::RaycastResult doRayCast(glm::vec4 originInVoxel, glm::vec4 farInVoxel, glm::vec4& result) const;
 
@@ -147,6 +178,11 @@ private:
     void stopUpdates();
 
     void recomputeMesh();
+    void markChunksDirty(int x, int y, int z); // around the voxel at x, y, z of _volData
+    void markAllChunksDirty();
+    void meshChunk(Chunk& chunk, const ivec3& chunkCoords, PolyVoxSurfaceStyle voxelSurfaceStyle);
+    void findChunkCollisionPoints(Chunk& chunk, const ivec3& chunkCoords, PolyVoxSurfaceStyle voxelSurfaceStyle,
+                                  const glm::vec3& voxelVolumeSize);
     void cacheNeighbors();
     void copyUpperEdgesFromNeighbors();
     void tellNeighborsToRecopyEdges(bool force);
@@ -167,12 +203,21 @@ private:
     bool _updateNeeded { true };
 
     graphics::MeshPointer _mesh;
+    graphics::MeshPointer _coarseMesh; // the coarse level of the chunks that have one
+    std::vector<PolyVoxChunkRange> _chunkRanges;
 
     ShapeInfo _shapeInfo;
 
     std::shared_ptr<PolyVox::SimpleVolume<uint8_t>> _volData;
     int _onCount; // how many non-zero voxels are in _volData
 
+    ivec3 _numChunks { 0 }; // along each axis of _volData
+    std::vector<bool> _dirtyChunks; // which chunks need meshing again
+
+    // meshed and filled in by the workers, one at a time
+    std::mutex _chunksMutex;
+    std::vector<Chunk> _chunks;
+
     bool _neighborXNeedsUpdate { false };
     bool _neighborYNeedsUpdate { false };
     bool _neighborZNeedsUpdate { false };
@@ -217,6 +262,8 @@ private:
 #endif
 
     graphics::MeshPointer _mesh;
+    graphics::MeshPointer _coarseMesh;
+    std::vector<PolyVoxChunkRange> _chunkRanges;
     gpu::BufferPointer _params;
     std::array<NetworkTexturePointer, 3> _xyzTextures;
     glm::vec3 _lastVoxelVolumeSize;
@@ -83,6 +83,29 @@ Item::Bound ShapeEntityRenderer::getBound(RenderArgs* args) {
     return Parent::getMaterialBound(args);
 }
 
+bool ShapeEntityRenderer::getOccluder(glm::mat4& boxToWorld) const {
+    if (_shape != entity::Shape::Cube || _primitiveMode != PrimitiveMode::SOLID || _billboardMode != BillboardMode::NONE ||
+        _renderLayer != RenderLayer::WORLD || isTransparent()) {
+        return false;
+    }
+
+    {
+        // procedurals can move their vertices and discard their fragments, and masked or front culled materials have holes
+        std::lock_guard<std::mutex> lock(_materialsLock);
+        auto materials = _materials.find("0");
+        if (materials == _materials.cend() || getPipelineType(materials->second) == Pipeline::PROCEDURAL ||
+            materials->second.getMaterialKey().isOpacityMaskMap() ||
+            materials->second.getCullFaceMode() == graphics::MaterialKey::CULL_FRONT) {
+            return false;
+        }
+    }
+
+    withReadLock([&] {
+        boxToWorld = _renderTransform.getMatrix();
+    });
+    return true;
+}
+
 ShapeKey ShapeEntityRenderer::getShapeKey() {
     ShapeKey::Builder builder;
     updateShapeKeyBuilderFromMaterials(builder);
@@ -27,6 +27,7 @@ public:
 protected:
     ShapeKey getShapeKey() override;
     Item::Bound getBound(RenderArgs* args) override;
+    bool getOccluder(glm::mat4& boxToWorld) const override;
 
 private:
     virtual bool needsRenderUpdate() const override;
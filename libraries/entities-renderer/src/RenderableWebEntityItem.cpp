@@ -53,6 +53,12 @@ static uint64_t MAX_NO_RENDER_INTERVAL = 30 * USECS_PER_SECOND;
 
 static uint8_t YOUTUBE_MAX_FPS = 30;
 
+// A web view that hasn't been rendered for a second is suspended until it is rendered again
+static uint64_t MAX_NO_RENDER_SUSPEND_INTERVAL = USECS_PER_SECOND;
+// A web view that looks smaller than this, in radians, updates at a lower frame rate in proportion
+static float FULL_RATE_ANGULAR_SIZE = 0.35f;
+static uint8_t MIN_DISTANT_FPS = 5;
+
 // Don't allow more than 20 concurrent web views
 static std::atomic<uint32_t> _currentWebCount(0);
 static const uint32_t MAX_CONCURRENT_WEB_VIEWS = 20;
@@ -92,6 +98,10 @@ WebEntityRenderer::WebEntityRenderer(const EntityItemPointer& entity) : Parent(e
 
     _timer.setInterval(MSECS_PER_SECOND);
     connect(&_timer, &QTimer::timeout, this, &WebEntityRenderer::onTimeout);
+
+    _rateTimer.setInterval(MSECS_PER_SECOND);
+    connect(&_rateTimer, &QTimer::timeout, this, &WebEntityRenderer::updateSurfaceRate);
+    _rateTimer.start();
 }
 
 WebEntityRenderer::~WebEntityRenderer() {
@@ -140,6 +150,36 @@ void WebEntityRenderer::onTimeout() {
     }
 }
 
+uint8_t WebEntityRenderer::getThrottledMaxFPS() const {
+    float rateScale = glm::clamp(_viewAngularSize / FULL_RATE_ANGULAR_SIZE, 0.0f, 1.0f);
+    uint8_t throttledMaxFPS = (uint8_t)glm::max((float)MIN_DISTANT_FPS, rateScale * _contentMaxFPS);
+    return std::min(throttledMaxFPS, _contentMaxFPS);
+}
+
+void WebEntityRenderer::updateSurfaceRate() {
+    QSharedPointer<OffscreenQmlSurface> webSurface;
+    uint64_t lastRenderTime;
+    uint8_t maxFPS;
+    withWriteLock([&] {
+        webSurface = _webSurface;
+        lastRenderTime = _lastRenderTime;
+        maxFPS = getThrottledMaxFPS();
+        _viewAngularSize = 0.0f;
+    });
+    if (!webSurface || lastRenderTime == 0) {
+        return;
+    }
+
+    if (usecTimestampNow() - lastRenderTime > MAX_NO_RENDER_SUSPEND_INTERVAL) {
+        // Out of view, the surface stops rendering until doRender() resumes it
+        if (!webSurface->isPaused()) {
+            webSurface->pause();
+        }
+    } else {
+        webSurface->setMaxFps(maxFPS);
+    }
+}
+
 void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene, Transaction& transaction, const TypedEntityPointer& entity) {
     // If the content type has changed, or the old content type was QML, we need to
     // destroy the existing surface (because surfaces don't support changing the root
@@ -196,7 +236,8 @@ void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene
                     _webSurface->getRootItem()->setProperty(USE_BACKGROUND_PROPERTY, _useBackground);
                     _webSurface->getRootItem()->setProperty(USER_AGENT_PROPERTY, _userAgent);
                     _webSurface->getSurfaceContext()->setContextProperty(GLOBAL_POSITION_PROPERTY, vec3toVariant(_contextPosition));
-                    _webSurface->setMaxFps((QUrl(newSourceURL).host().endsWith("youtube.com", Qt::CaseInsensitive)) ? YOUTUBE_MAX_FPS : _maxFPS);
+                    _contentMaxFPS = (QUrl(newSourceURL).host().endsWith("youtube.com", Qt::CaseInsensitive)) ? YOUTUBE_MAX_FPS : _maxFPS;
+                    _webSurface->setMaxFps(_contentMaxFPS);
                     ::hifi::scripting::setLocalAccessSafeThread(false);
                     _sourceURL = newSourceURL;
                 } else if (_contentType != ContentType::HtmlContent) {
@@ -217,10 +258,11 @@ void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene
                         // We special case YouTube URLs since we know they are videos that we should play with at least 30 FPS.
                         // FIXME this doesn't handle redirects or shortened URLs, consider using a signaling method from the web entity
                         if (QUrl(_sourceURL).host().endsWith("youtube.com", Qt::CaseInsensitive)) {
-                            _webSurface->setMaxFps(YOUTUBE_MAX_FPS);
+                            _contentMaxFPS = YOUTUBE_MAX_FPS;
                         } else {
-                            _webSurface->setMaxFps(maxFPS);
+                            _contentMaxFPS = maxFPS;
                         }
+                        _webSurface->setMaxFps(_contentMaxFPS);
                         _maxFPS = maxFPS;
                     }
                 }
@@ -268,9 +310,28 @@ void WebEntityRenderer::doRenderUpdateSynchronousTyped(const ScenePointer& scene
 
 void WebEntityRenderer::doRender(RenderArgs* args) {
     PerformanceTimer perfTimer("WebEntityRenderer::render");
+    bool isSuspended = false;
     withWriteLock([&] {
         _lastRenderTime = usecTimestampNow();
+        if (args->_renderMode != RenderArgs::RenderMode::SHADOW_RENDER_MODE) {
+            glm::vec3 dimensions = _renderTransform.getScale();
+            float distance = glm::distance(args->getViewFrustum().getPosition(), _renderTransform.getTranslation());
+            float angularSize = glm::max(dimensions.x, dimensions.y) / glm::max(distance, EPSILON);
+            _viewAngularSize = glm::max(_viewAngularSize, angularSize);
+        }
+        isSuspended = _webSurface && _webSurface->isPaused();
     });
+    if (isSuspended) {
+        // Back in view, the surface is resumed from the main thread
+        QMetaObject::invokeMethod(this, [this] {
+            auto webSurface = resultWithReadLock<QSharedPointer<OffscreenQmlSurface>>([&] {
+                return _webSurface;
+            });
+            if (webSurface && webSurface->isPaused()) {
+                webSurface->resume();
+            }
+        });
+    }
 
     // Try to update the texture
     OffscreenQmlSurface::TextureAndFence newTextureAndFence;
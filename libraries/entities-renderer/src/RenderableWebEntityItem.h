@@ -73,6 +73,8 @@ protected:
 
 private:
     void onTimeout();
+    void updateSurfaceRate();
+    uint8_t getThrottledMaxFPS() const;
     void buildWebSurface(const EntityItemPointer& entity, const QString& newSourceURL);
     void destroyWebSurface();
     glm::vec2 getWindowSize(const TypedEntityPointer& entity) const;
@@ -108,6 +110,10 @@ private:
     QTimer _timer;
     uint64_t _lastRenderTime { 0 };
 
+    QTimer _rateTimer;
+    uint8_t _contentMaxFPS { 60 }; // what the content asks for, before it is cut down for a distant view
+    float _viewAngularSize { 0.0f }; // the largest the view has looked, in radians, since the rate was last updated
+
     std::vector<QMetaObject::Connection> _connections;
 
     static std::function<void(QString, bool, QSharedPointer<OffscreenQmlSurface>&, bool&)> _acquireWebSurfaceOperator;
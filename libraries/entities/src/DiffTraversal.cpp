@@ -11,6 +11,7 @@
 
 #include "DiffTraversal.h"
 
+#include <GLMHelpers.h>
 #include <OctreeUtils.h>
 
 #include "EntityPriorityQueue.h"
@@ -121,6 +122,21 @@ bool DiffTraversal::View::isVerySimilar(const View& view) const {
     return true;
 }
 
+bool DiffTraversal::View::isNear(const View& view, float maxDistance, float maxAngle) const {
+    auto size = view.viewFrustums.size();
+    if (viewFrustums.size() != size) {
+        return false;
+    }
+
+    for (size_t i = 0; i < size; ++i) {
+        if (glm::distance(viewFrustums[i].getPosition(), view.viewFrustums[i].getPosition()) >= maxDistance ||
+            angleBetween(viewFrustums[i].getDirection(), view.viewFrustums[i].getDirection()) >= maxAngle) {
+            return false;
+        }
+    }
+    return true;
+}
+
 float DiffTraversal::View::computePriority(const EntityItemPointer& entity) const {
     if (!entity) {
         return PrioritizedEntity::DO_NOT_SEND;
@@ -220,7 +236,7 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
         _getNextVisibleElementCallback = [this](DiffTraversal::VisibleElement& next) {
             _path.back().getNextVisibleElementFirstTime(next, _currentView);
         };
-    } else if (!_currentView.usesViewFrustums() || _completedView.isVerySimilar(view)) {
+    } else if (!_currentView.usesViewFrustums() || (!_completedViewIsPartial && _completedView.isVerySimilar(view))) {
         type = Type::Repeat;
         _getNextVisibleElementCallback = [this](DiffTraversal::VisibleElement& next) {
             _path.back().getNextVisibleElementRepeat(next, _completedView, _completedView.startTime);
@@ -240,10 +256,36 @@ DiffTraversal::Type DiffTraversal::prepareNewTraversal(const DiffTraversal::View
     _path.back().initRootNextIndex();
 
     _currentView.startTime = usecTimestampNow();
+    // a Repeat traversal culls against the completed view
+    _startView = (type == Type::Repeat) ? _completedView : _currentView;
+    _type = type;
+    _viewChangedDuringTraversal = false;
 
     return type;
 }
 
+bool DiffTraversal::continueWithView(const DiffTraversal::View& view) {
+    // about how far a user can walk or be carried in one query interval; anything further is a teleport
+    const float MAX_CONTINUED_VIEW_DISTANCE = 5.0f; // meters
+    // any amount of turning is fine, the rest of the traversal just uses the new direction
+    const float MAX_CONTINUED_VIEW_ANGLE = TWO_PI;
+
+    if (finished() || !view.usesViewFrustums() || !_startView.usesViewFrustums() ||
+        !_startView.isNear(view, MAX_CONTINUED_VIEW_DISTANCE, MAX_CONTINUED_VIEW_ANGLE)) {
+        return false;
+    }
+
+    if (_type != Type::Repeat) {
+        _currentView.viewFrustums = view.viewFrustums;
+        _currentView.lodScaleFactor = view.lodScaleFactor;
+    }
+    if (!_startView.isVerySimilar(view)) {
+        // elements already passed may have come into view, the next traversal has to look at them again
+        _viewChangedDuringTraversal = true;
+    }
+    return true;
+}
+
 void DiffTraversal::getNextVisibleElement(DiffTraversal::VisibleElement& next) {
     if (_path.empty()) {
         next.element.reset();
@@ -263,6 +305,7 @@ void DiffTraversal::getNextVisibleElement(DiffTraversal::VisibleElement& next) {
             if (_path.empty()) {
                 // we've traversed the entire tree
                 _completedView = _currentView;
+                _completedViewIsPartial = _viewChangedDuringTraversal;
                 return;
             }
             // keep looking for next
@@ -31,6 +31,8 @@ public:
     public:
         bool usesViewFrustums() const;
         bool isVerySimilar(const View& view) const;
+        // true when each of the view's frustums has moved less than maxDistance and turned less than maxAngle from ours
+        bool isNear(const View& view, float maxDistance, float maxAngle) const;
 
         bool shouldTraverseElement(const EntityTreeElement& element) const;
         float computePriority(const EntityItemPointer& entity) const;
@@ -62,6 +64,10 @@ public:
     DiffTraversal();
 
     Type prepareNewTraversal(const DiffTraversal::View& view, EntityTreeElementPointer root, bool forceFirstPass = false);
+    // Carries on with the traversal in progress using a slightly different view, rather than starting over and losing
+    // its progress. Returns false when there is no traversal in progress, or the view has jumped too far from the one
+    // the traversal started with, and a new traversal is needed.
+    bool continueWithView(const DiffTraversal::View& view);
 
     const View& getCurrentView() const { return _currentView; }
 
@@ -71,13 +77,20 @@ public:
     void setScanCallback(std::function<void (VisibleElement&)> cb);
     void traverse(uint64_t timeBudget);
 
-    void reset() { _path.clear(); _completedView.startTime = 0; } // resets our state to force a new "First" traversal
+    // resets our state to force a new "First" traversal
+    void reset() { _path.clear(); _completedView.startTime = 0; _viewChangedDuringTraversal = false; _completedViewIsPartial = false; }
 
 private:
     void getNextVisibleElement(VisibleElement& next);
 
     View _currentView;
     View _completedView;
+    View _startView; // the view the elements of the traversal in progress are culled against, before any continueWithView()
+    Type _type { First };
+    // the traversal culled some elements against a view that isn't very similar to the one it finished with, so the
+    // next traversal can't be a Repeat
+    bool _viewChangedDuringTraversal { false };
+    bool _completedViewIsPartial { false };
     std::vector<Waypoint> _path;
     std::function<void (VisibleElement&)> _getNextVisibleElementCallback { nullptr };
     std::function<void (VisibleElement&)> _scanElementCallback { [](VisibleElement& e){} };
@@ -0,0 +1,343 @@
+//
+//  EntityEditDeltas.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditDeltas.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include <NumericalConstants.h>
+
+#include "EntityItemProperties.h"
+
+const float EntityEditEncoding::LINEAR_DELTA_STEP = 1.0f / 2048.0f;
+const float EntityEditEncoding::MAX_LINEAR_DELTA = (float)INT16_MAX * EntityEditEncoding::LINEAR_DELTA_STEP;
+const float EntityEditEncoding::MAX_ROTATION_DELTA = 0.125f;
+
+const quint64 EntityEditDeltaEncoder::KEYFRAME_INTERVAL_USECS = USECS_PER_SECOND;
+const quint64 EntityEditDeltaDecoder::KEYFRAME_EXPIRY_USECS = 10 * USECS_PER_SECOND;
+
+namespace {
+
+// a rotation delta's x and y components take 11 bits each and its z component takes the other 10
+const int ROTATION_XY_BITS = 11;
+const int ROTATION_Z_BITS = 10;
+const int ROTATION_XY_RANGE = (1 << (ROTATION_XY_BITS - 1)) - 1;
+const int ROTATION_Z_RANGE = (1 << (ROTATION_Z_BITS - 1)) - 1;
+
+void appendLinearDelta(QByteArray& buffer, const glm::ivec3& delta) {
+    for (int i = 0; i < 3; i++) {
+        int16_t component = (int16_t)delta[i];
+        buffer.append((const char*)&component, sizeof(component));
+    }
+}
+
+void readLinearDelta(const unsigned char*& dataAt, glm::ivec3& delta) {
+    for (int i = 0; i < 3; i++) {
+        int16_t component;
+        memcpy(&component, dataAt, sizeof(component));
+        dataAt += sizeof(component);
+        delta[i] = component;
+    }
+}
+
+}
+
+QByteArray EntityEditEncoding::toByteArray() const {
+    QByteArray buffer;
+    buffer.append((char)flags);
+    if (flags & (KEYFRAME | MOTION_DELTA)) {
+        buffer.append((const char*)&keyframeID, sizeof(keyframeID));
+    }
+    if (flags & MOTION_DELTA) {
+        buffer.append((char)deltaProperties);
+        if (deltaProperties & POSITION) {
+            appendLinearDelta(buffer, position);
+        }
+        if (deltaProperties & ROTATION) {
+            buffer.append((const char*)&rotation, sizeof(rotation));
+        }
+        if (deltaProperties & VELOCITY) {
+            appendLinearDelta(buffer, velocity);
+        }
+        if (deltaProperties & ANGULAR_VELOCITY) {
+            appendLinearDelta(buffer, angularVelocity);
+        }
+    }
+    return buffer;
+}
+
+int EntityEditEncoding::fromBytes(const unsigned char* data, int bytesToRead) {
+    const int LINEAR_DELTA_SIZE = 3 * sizeof(int16_t);
+    const unsigned char* dataAt = data;
+    if (bytesToRead < (int)sizeof(flags)) {
+        return -1;
+    }
+    flags = *dataAt++;
+
+    if (flags & (KEYFRAME | MOTION_DELTA)) {
+        if (bytesToRead < (int)(dataAt - data) + (int)sizeof(keyframeID)) {
+            return -1;
+        }
+        memcpy(&keyframeID, dataAt, sizeof(keyframeID));
+        dataAt += sizeof(keyframeID);
+    }
+
+    deltaProperties = 0;
+    if (flags & MOTION_DELTA) {
+        if (bytesToRead < (int)(dataAt - data) + (int)sizeof(deltaProperties)) {
+            return -1;
+        }
+        deltaProperties = *dataAt++;
+
+        int deltasSize = ((deltaProperties & POSITION) ? LINEAR_DELTA_SIZE : 0) +
+            ((deltaProperties & ROTATION) ? (int)sizeof(rotation) : 0) +
+            ((deltaProperties & VELOCITY) ? LINEAR_DELTA_SIZE : 0) +
+            ((deltaProperties & ANGULAR_VELOCITY) ? LINEAR_DELTA_SIZE : 0);
+        if (bytesToRead < (int)(dataAt - data) + deltasSize) {
+            return -1;
+        }
+        if (deltaProperties & POSITION) {
+            readLinearDelta(dataAt, position);
+        }
+        if (deltaProperties & ROTATION) {
+            memcpy(&rotation, dataAt, sizeof(rotation));
+            dataAt += sizeof(rotation);
+        }
+        if (deltaProperties & VELOCITY) {
+            readLinearDelta(dataAt, velocity);
+        }
+        if (deltaProperties & ANGULAR_VELOCITY) {
+            readLinearDelta(dataAt, angularVelocity);
+        }
+    }
+    return (int)(dataAt - data);
+}
+
+bool EntityEditEncoding::quantizeLinearDelta(const glm::vec3& delta, glm::ivec3& quantized) {
+    for (int i = 0; i < 3; i++) {
+        // also rejects NaN
+        if (!(fabsf(delta[i]) <= MAX_LINEAR_DELTA)) {
+            return false;
+        }
+        quantized[i] = (int)roundf(delta[i] / LINEAR_DELTA_STEP);
+    }
+    return true;
+}
+
+glm::vec3 EntityEditEncoding::unquantizeLinearDelta(const glm::ivec3& quantized) {
+    return glm::vec3(quantized) * LINEAR_DELTA_STEP;
+}
+
+bool EntityEditEncoding::quantizeRotationDelta(const glm::quat& delta, uint32_t& quantized) {
+    // q and -q are the same rotation, so the one with a positive w can be rebuilt from x, y and z
+    glm::quat positive = delta.w < 0.0f ? -delta : delta;
+    if (!(fabsf(positive.x) <= MAX_ROTATION_DELTA && fabsf(positive.y) <= MAX_ROTATION_DELTA &&
+          fabsf(positive.z) <= MAX_ROTATION_DELTA)) {
+        return false;
+    }
+    uint32_t x = (uint32_t)((int)roundf(positive.x / MAX_ROTATION_DELTA * ROTATION_XY_RANGE) + ROTATION_XY_RANGE);
+    uint32_t y = (uint32_t)((int)roundf(positive.y / MAX_ROTATION_DELTA * ROTATION_XY_RANGE) + ROTATION_XY_RANGE);
+    uint32_t z = (uint32_t)((int)roundf(positive.z / MAX_ROTATION_DELTA * ROTATION_Z_RANGE) + ROTATION_Z_RANGE);
+    quantized = (x << (ROTATION_XY_BITS + ROTATION_Z_BITS)) | (y << ROTATION_Z_BITS) | z;
+    return true;
+}
+
+glm::quat EntityEditEncoding::unquantizeRotationDelta(uint32_t quantized) {
+    const uint32_t XY_MASK = (1 << ROTATION_XY_BITS) - 1;
+    const uint32_t Z_MASK = (1 << ROTATION_Z_BITS) - 1;
+    int x = (int)((quantized >> (ROTATION_XY_BITS + ROTATION_Z_BITS)) & XY_MASK) - ROTATION_XY_RANGE;
+    int y = (int)((quantized >> ROTATION_Z_BITS) & XY_MASK) - ROTATION_XY_RANGE;
+    int z = (int)(quantized & Z_MASK) - ROTATION_Z_RANGE;
+
+    glm::vec3 xyz((float)x / ROTATION_XY_RANGE, (float)y / ROTATION_XY_RANGE, (float)z / ROTATION_Z_RANGE);
+    xyz *= MAX_ROTATION_DELTA;
+    float w = sqrtf(std::max(0.0f, 1.0f - glm::dot(xyz, xyz)));
+    return glm::normalize(glm::quat(w, xyz.x, xyz.y, xyz.z));
+}
+
+EntityEditEncoding EntityEditDeltaEncoder::encode(const EntityItemID& entityID, const EntityItemProperties& properties,
+                                                  EntityPropertyFlags& requestedProperties, quint64 now) {
+    EntityEditEncoding encoding;
+    encoding.allowCompression = true;
+
+    uint8_t motionProperties = (requestedProperties.getHasProperty(PROP_POSITION) ? EntityEditEncoding::POSITION : 0) |
+        (requestedProperties.getHasProperty(PROP_ROTATION) ? EntityEditEncoding::ROTATION : 0) |
+        (requestedProperties.getHasProperty(PROP_VELOCITY) ? EntityEditEncoding::VELOCITY : 0) |
+        (requestedProperties.getHasProperty(PROP_ANGULAR_VELOCITY) ? EntityEditEncoding::ANGULAR_VELOCITY : 0);
+    if (motionProperties == 0) {
+        return encoding;
+    }
+
+    auto keyframeItr = _keyframes.find(entityID);
+    if (keyframeItr != _keyframes.end()) {
+        const EntityMotionKeyframe& keyframe = keyframeItr->second;
+        if (now - keyframe.timestamp < KEYFRAME_INTERVAL_USECS && (motionProperties & ~keyframe.properties) == 0) {
+            EntityEditEncoding deltas = encoding;
+            deltas.flags = EntityEditEncoding::MOTION_DELTA;
+            deltas.keyframeID = keyframe.id;
+            deltas.deltaProperties = motionProperties;
+
+            bool fits = true;
+            if (motionProperties & EntityEditEncoding::POSITION) {
+                fits = fits && EntityEditEncoding::quantizeLinearDelta(properties.getPosition() - keyframe.position, deltas.position);
+            }
+            if (motionProperties & EntityEditEncoding::ROTATION) {
+                fits = fits && EntityEditEncoding::quantizeRotationDelta(glm::inverse(keyframe.rotation) * properties.getRotation(),
+                                                                         deltas.rotation);
+            }
+            if (motionProperties & EntityEditEncoding::VELOCITY) {
+                fits = fits && EntityEditEncoding::quantizeLinearDelta(properties.getVelocity() - keyframe.velocity, deltas.velocity);
+            }
+            if (motionProperties & EntityEditEncoding::ANGULAR_VELOCITY) {
+                fits = fits && EntityEditEncoding::quantizeLinearDelta(properties.getAngularVelocity() - keyframe.angularVelocity,
+                                                                       deltas.angularVelocity);
+            }
+
+            if (fits) {
+                requestedProperties -= PROP_POSITION;
+                requestedProperties -= PROP_ROTATION;
+                requestedProperties -= PROP_VELOCITY;
+                requestedProperties -= PROP_ANGULAR_VELOCITY;
+                return deltas;
+            }
+        }
+    }
+
+    EntityMotionKeyframe& keyframe = _keyframes[entityID];
+    keyframe.id = ++_nextKeyframeID;
+    keyframe.properties = motionProperties;
+    keyframe.position = properties.getPosition();
+    keyframe.rotation = properties.getRotation();
+    keyframe.velocity = properties.getVelocity();
+    keyframe.angularVelocity = properties.getAngularVelocity();
+    keyframe.timestamp = now;
+
+    encoding.flags = EntityEditEncoding::KEYFRAME;
+    encoding.keyframeID = keyframe.id;
+    return encoding;
+}
+
+void EntityEditDeltaEncoder::keyframePartlySent(const EntityItemID& entityID, const EntityPropertyFlags& didntFitProperties) {
+    auto keyframeItr = _keyframes.find(entityID);
+    if (keyframeItr == _keyframes.end()) {
+        return;
+    }
+    EntityMotionKeyframe& keyframe = keyframeItr->second;
+    if (didntFitProperties.getHasProperty(PROP_POSITION)) {
+        keyframe.properties &= ~EntityEditEncoding::POSITION;
+    }
+    if (didntFitProperties.getHasProperty(PROP_ROTATION)) {
+        keyframe.properties &= ~EntityEditEncoding::ROTATION;
+    }
+    if (didntFitProperties.getHasProperty(PROP_VELOCITY)) {
+        keyframe.properties &= ~EntityEditEncoding::VELOCITY;
+    }
+    if (didntFitProperties.getHasProperty(PROP_ANGULAR_VELOCITY)) {
+        keyframe.properties &= ~EntityEditEncoding::ANGULAR_VELOCITY;
+    }
+}
+
+void EntityEditDeltaEncoder::removeEntity(const EntityItemID& entityID) {
+    _keyframes.erase(entityID);
+}
+
+bool EntityEditDeltaDecoder::decode(const QUuid& senderID, const EntityItemID& entityID, const EntityEditEncoding& encoding,
+                                    EntityItemProperties& properties, quint64 now) {
+    if (!encoding.isKeyframe() && !encoding.hasMotionDeltas()) {
+        return true;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    removeExpiredKeyframes(now);
+
+    if (encoding.isKeyframe()) {
+        EntityMotionKeyframe& keyframe = _keyframes[senderID][entityID];
+        keyframe.id = encoding.keyframeID;
+        keyframe.properties = 0;
+        keyframe.timestamp = now;
+        if (properties.positionChanged()) {
+            keyframe.properties |= EntityEditEncoding::POSITION;
+            keyframe.position = properties.getPosition();
+        }
+        if (properties.rotationChanged()) {
+            keyframe.properties |= EntityEditEncoding::ROTATION;
+            keyframe.rotation = properties.getRotation();
+        }
+        if (properties.velocityChanged()) {
+            keyframe.properties |= EntityEditEncoding::VELOCITY;
+            keyframe.velocity = properties.getVelocity();
+        }
+        if (properties.angularVelocityChanged()) {
+            keyframe.properties |= EntityEditEncoding::ANGULAR_VELOCITY;
+            keyframe.angularVelocity = properties.getAngularVelocity();
+        }
+        return true;
+    }
+
+    auto senderItr = _keyframes.find(senderID);
+    if (senderItr == _keyframes.end()) {
+        return false;
+    }
+    auto keyframeItr = senderItr->second.find(entityID);
+    if (keyframeItr == senderItr->second.end()) {
+        return false;
+    }
+    EntityMotionKeyframe& keyframe = keyframeItr->second;
+    if (keyframe.id != encoding.keyframeID || (encoding.deltaProperties & ~keyframe.properties) != 0) {
+        // the keyframe was lost or is still being resent, wait for the next one
+        return false;
+    }
+
+    keyframe.timestamp = now;
+    if (encoding.deltaProperties & EntityEditEncoding::POSITION) {
+        properties.setPosition(keyframe.position + EntityEditEncoding::unquantizeLinearDelta(encoding.position));
+    }
+    if (encoding.deltaProperties & EntityEditEncoding::ROTATION) {
+        properties.setRotation(glm::normalize(keyframe.rotation * EntityEditEncoding::unquantizeRotationDelta(encoding.rotation)));
+    }
+    if (encoding.deltaProperties & EntityEditEncoding::VELOCITY) {
+        properties.setVelocity(keyframe.velocity + EntityEditEncoding::unquantizeLinearDelta(encoding.velocity));
+    }
+    if (encoding.deltaProperties & EntityEditEncoding::ANGULAR_VELOCITY) {
+        properties.setAngularVelocity(keyframe.angularVelocity + EntityEditEncoding::unquantizeLinearDelta(encoding.angularVelocity));
+    }
+    return true;
+}
+
+void EntityEditDeltaDecoder::removeSender(const QUuid& senderID) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _keyframes.erase(senderID);
+}
+
+void EntityEditDeltaDecoder::removeExpiredKeyframes(quint64 now) {
+    if (now - _lastExpiryCheck < KEYFRAME_EXPIRY_USECS) {
+        return;
+    }
+    _lastExpiryCheck = now;
+
+    for (auto senderItr = _keyframes.begin(); senderItr != _keyframes.end();) {
+        auto& keyframes = senderItr->second;
+        for (auto keyframeItr = keyframes.begin(); keyframeItr != keyframes.end();) {
+            if (now - keyframeItr->second.timestamp > KEYFRAME_EXPIRY_USECS) {
+                keyframeItr = keyframes.erase(keyframeItr);
+            } else {
+                ++keyframeItr;
+            }
+        }
+        if (keyframes.empty()) {
+            senderItr = _keyframes.erase(senderItr);
+        } else {
+            ++senderItr;
+        }
+    }
+}
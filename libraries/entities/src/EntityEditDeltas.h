@@ -0,0 +1,139 @@
+//
+//  EntityEditDeltas.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditDeltas_h
+#define hifi_EntityEditDeltas_h
+
+#include <mutex>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QUuid>
+
+#include <UUIDHasher.h>
+
+#include "EntityItemID.h"
+#include "EntityPropertyFlags.h"
+
+class EntityItemProperties;
+
+// The encoding byte at the start of each entity edit, and its motion deltas.
+//
+// An edit marked as a keyframe has its absolute position, rotation, velocity and angular velocity kept by the entity
+// server, for that sender and entity. Later edits can send those properties as small quantized offsets from the
+// keyframe instead. Edits are NACKed but never acknowledged, so the offsets are always against the last keyframe rather
+// than the previous edit. That way a lost delta costs nothing later, and a lost keyframe only costs the motion updates
+// until the next one.
+class EntityEditEncoding {
+public:
+    enum Flag : uint8_t {
+        KEYFRAME = 0x01,        // keyframeID is this edit's
+        MOTION_DELTA = 0x02,    // keyframeID is the one the deltas are against
+        COMPRESSED = 0x04       // the property data is zlib compressed
+    };
+
+    enum MotionProperty : uint8_t {
+        POSITION = 0x01,
+        ROTATION = 0x02,
+        VELOCITY = 0x04,
+        ANGULAR_VELOCITY = 0x08
+    };
+
+    // the finest step and the largest offset of the position, velocity and angular velocity deltas, in meters and radians
+    static const float LINEAR_DELTA_STEP;
+    static const float MAX_LINEAR_DELTA;
+    // the largest rotation delta, as the largest component of the unit quaternion from the keyframe's rotation
+    static const float MAX_ROTATION_DELTA;
+
+    // the encoder only compresses property data at least this long, when it saves at least MIN_COMPRESSION_SAVING
+    static const int MIN_COMPRESSED_SIZE = 256;
+    static const int MIN_COMPRESSION_SAVING = 32;
+
+    uint8_t flags { 0 };
+    uint16_t keyframeID { 0 };
+    uint8_t deltaProperties { 0 };
+    // sent as 16 bit integers
+    glm::ivec3 position { 0 };
+    uint32_t rotation { 0 };
+    glm::ivec3 velocity { 0 };
+    glm::ivec3 angularVelocity { 0 };
+
+    // not sent, lets encodeEntityEditPacket() compress large property data
+    bool allowCompression { false };
+
+    bool isKeyframe() const { return flags & KEYFRAME; }
+    bool hasMotionDeltas() const { return flags & MOTION_DELTA; }
+
+    QByteArray toByteArray() const;
+    // returns the number of bytes read, or -1 if the encoding doesn't fit in bytesToRead
+    int fromBytes(const unsigned char* data, int bytesToRead);
+
+    static bool quantizeLinearDelta(const glm::vec3& delta, glm::ivec3& quantized);
+    static glm::vec3 unquantizeLinearDelta(const glm::ivec3& quantized);
+    static bool quantizeRotationDelta(const glm::quat& delta, uint32_t& quantized);
+    static glm::quat unquantizeRotationDelta(uint32_t quantized);
+};
+
+// The absolute motion properties of a keyframe edit
+struct EntityMotionKeyframe {
+    uint16_t id { 0 };
+    uint8_t properties { 0 };
+    glm::vec3 position;
+    glm::quat rotation;
+    glm::vec3 velocity;
+    glm::vec3 angularVelocity;
+    quint64 timestamp { 0 };
+};
+
+// Picks the encoding of each outgoing edit, for EntityEditPacketSender. Not thread safe.
+class EntityEditDeltaEncoder {
+public:
+    // how often an entity that keeps moving is sent a new keyframe, which bounds how long a lost keyframe matters
+    static const quint64 KEYFRAME_INTERVAL_USECS;
+
+    // Replaces the motion properties of an edit with deltas, removing them from requestedProperties, when they are close to
+    // the entity's last keyframe. Otherwise marks the edit as a new keyframe.
+    EntityEditEncoding encode(const EntityItemID& entityID, const EntityItemProperties& properties,
+                              EntityPropertyFlags& requestedProperties, quint64 now);
+    // Drops the properties that didn't fit in a keyframe's edit packet from the keyframe, so no deltas are sent
+    // against them. They go in a later packet, which isn't a keyframe.
+    void keyframePartlySent(const EntityItemID& entityID, const EntityPropertyFlags& didntFitProperties);
+    void removeEntity(const EntityItemID& entityID);
+
+private:
+    std::unordered_map<EntityItemID, EntityMotionKeyframe> _keyframes;
+    uint16_t _nextKeyframeID { 0 };
+};
+
+// Keeps the keyframes of each sender on the entity server, and turns deltas back into absolute properties
+class EntityEditDeltaDecoder {
+public:
+    // how long a keyframe is kept without any edits against it
+    static const quint64 KEYFRAME_EXPIRY_USECS;
+
+    // Stores the motion properties of keyframes. Sets the properties of motion deltas from their keyframe. Returns false if
+    // that keyframe isn't the last one received from this sender, in which case the deltas are dropped.
+    bool decode(const QUuid& senderID, const EntityItemID& entityID, const EntityEditEncoding& encoding,
+                EntityItemProperties& properties, quint64 now);
+    void removeSender(const QUuid& senderID);
+
+private:
+    void removeExpiredKeyframes(quint64 now);
+
+    std::mutex _mutex;
+    std::unordered_map<QUuid, std::unordered_map<EntityItemID, EntityMotionKeyframe>> _keyframes;
+    quint64 _lastExpiryCheck { 0 };
+};
+
+#endif // hifi_EntityEditDeltas_h
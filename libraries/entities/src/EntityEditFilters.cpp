@@ -63,6 +63,9 @@ bool EntityEditFilters::filter(glm::vec3& position, EntityItemProperties& proper
                 return false;
             }
 
+            // the edits of a batch are filtered in parallel, but a script engine only runs on one thread at a time
+            std::lock_guard<std::mutex> evaluationLock(_evaluationMutex);
+
             // check to see if this filter wants to filter this message type
             if ((!filterData.wantsToFilterEdit && filterType == EntityTree::FilterType::Edit) ||
                 (!filterData.wantsToFilterPhysics && filterType == EntityTree::FilterType::Physics) ||
@@ -18,6 +18,7 @@
 #include <glm/glm.hpp>
 
 #include <functional>
+#include <mutex>
 
 #include "EntityItemID.h"
 #include "EntityItemProperties.h"
@@ -72,6 +73,7 @@ private:
     
     QReadWriteLock _lock;
     QMap<EntityItemID, FilterData> _filterDataMap;
+    std::mutex _evaluationMutex;
 };
 
 #endif //hifi_EntityEditFilters_h
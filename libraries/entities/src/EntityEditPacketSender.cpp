@@ -119,8 +119,22 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
         requestedProperties -= PROP_PRIVATE_USER_DATA;
     }
 
+    // edits can send their motion properties as deltas against the last keyframe, adds always send them in full
+    EntityEditEncoding encoding;
+    encoding.allowCompression = true;
+    if (type == PacketType::EntityEdit) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        encoding = _deltaEncoder.encode(entityItemID, propertiesCopy, requestedProperties, usecTimestampNow());
+    }
+
     while (encodeResult == OctreeElement::PARTIAL) {
-        encodeResult = EntityItemProperties::encodeEntityEditPacket(type, entityItemID, propertiesCopy, bufferOut, requestedProperties, didntFitProperties);
+        encodeResult = EntityItemProperties::encodeEntityEditPacket(type, entityItemID, propertiesCopy, bufferOut, requestedProperties,
+                                                                    didntFitProperties, encoding);
+
+        if (encoding.isKeyframe() && encodeResult != OctreeElement::COMPLETED) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _deltaEncoder.keyframePartlySent(entityItemID, encodeResult == OctreeElement::NONE ? requestedProperties : didntFitProperties);
+        }
 
         if (encodeResult == OctreeElement::NONE) {
             // This can happen for two reasons:
@@ -145,6 +159,10 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
         if (encodeResult != OctreeElement::COMPLETED) {
             type = PacketType::EntityEdit;
             requestedProperties = didntFitProperties;
+            // the rest of the properties are sent in full
+            EntityEditEncoding remainderEncoding;
+            remainderEncoding.allowCompression = true;
+            encoding = remainderEncoding;
         }
 
         bufferOut.resize(NLPacket::maxPayloadSize(type)); // resize our output buffer for the next packet
@@ -152,6 +170,10 @@ void EntityEditPacketSender::queueEditEntityMessage(PacketType type,
 }
 
 void EntityEditPacketSender::queueEraseEntityMessage(const EntityItemID& entityItemID) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _deltaEncoder.removeEntity(entityItemID);
+    }
 
     QByteArray bufferOut(NLPacket::maxPayloadSize(PacketType::EntityErase), 0);
 
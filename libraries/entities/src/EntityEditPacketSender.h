@@ -19,6 +19,7 @@
 #include <mutex>
 
 #include "EntityItem.h"
+#include "EntityEditDeltas.h"
 #include "AvatarData.h"
 
 /// Utility for processing, packing, queueing and sending of outbound edit voxel messages.
@@ -58,5 +59,6 @@ private:
 private:
     std::mutex _mutex;
     AvatarData* _myAvatar { nullptr };
+    EntityEditDeltaEncoder _deltaEncoder; // guarded by _mutex
 };
 #endif // hifi_EntityEditPacketSender_h
@@ -49,6 +49,9 @@ int entityItemPointernMetaTypeId = qRegisterMetaType<EntityItemPointer>();
 
 int EntityItem::_maxActionsDataSize = 800;
 quint64 EntityItem::_rememberDeletedActionTime = 20 * USECS_PER_SECOND;
+bool EntityItem::_encodingCacheEnabled = false;
+std::atomic<quint64> EntityItem::_encodingCacheHits { 0 };
+std::atomic<quint64> EntityItem::_encodingCacheMisses { 0 };
 QString EntityItem::_marketplacePublicKey;
 
 EntityItem::EntityItem(const EntityItemID& entityItemID) :
@@ -168,6 +171,40 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     OctreeElement::AppendState appendState = OctreeElement::COMPLETED; // assume the best
 
+    // If we are being called for a subsequent pass at appendEntityData() that failed to completely encode this item,
+    // then our entityTreeElementExtraEncodeData should include data about which properties we need to append.
+    bool isContinuation = entityTreeElementExtraEncodeData &&
+        entityTreeElementExtraEncodeData->entities.contains(getEntityItemID());
+
+    // a complete encoding is the same for every destination with the same access to private user data
+    bool useEncodingCache = _encodingCacheEnabled && !isContinuation;
+    int encodingCacheIndex = destinationNodeCanGetAndSetPrivateUserData ? 1 : 0;
+    EncodingCacheKey encodingCacheKey;
+    if (useEncodingCache) {
+        encodingCacheKey = getEncodingCacheKey();
+
+        QByteArray cachedEncoding;
+        {
+            std::lock_guard<std::mutex> lock(_encodingCacheMutex);
+            if (_encodingCacheKeys[encodingCacheIndex] == encodingCacheKey) {
+                cachedEncoding = _encodingCache[encodingCacheIndex];
+            }
+        }
+
+        if (!cachedEncoding.isEmpty()) {
+            LevelDetails entityLevel = packetData->startLevel();
+            if (packetData->appendRawData(cachedEncoding)) {
+                packetData->endLevel(entityLevel);
+                ++_encodingCacheHits;
+                params.trackSend(getID(), encodingCacheKey.lastEdited);
+                return appendState;
+            }
+            // it didn't fit whole, so encode what does fit below
+            packetData->discardLevel(entityLevel);
+        }
+        ++_encodingCacheMisses;
+    }
+
     // encode our ID as a byte count coded byte stream
     QByteArray encodedID = getID().toRfc4122();
 
@@ -194,9 +231,7 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     requestedProperties -= PROP_OWNING_AVATAR_ID;
     requestedProperties -= PROP_VISIBLE_IN_SECONDARY_CAMERA;
 
-    // If we are being called for a subsequent pass at appendEntityData() that failed to completely encode this item,
-    // then our entityTreeElementExtraEncodeData should include data about which properties we need to append.
-    if (entityTreeElementExtraEncodeData && entityTreeElementExtraEncodeData->entities.contains(getEntityItemID())) {
+    if (isContinuation) {
         requestedProperties = entityTreeElementExtraEncodeData->entities.value(getEntityItemID());
     }
 
@@ -207,6 +242,7 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
     EntityPropertyFlags propertiesDidntFit = requestedProperties;
 
+    int startOfEntity = packetData->getUncompressedByteOffset();
     LevelDetails entityLevel = packetData->startLevel();
 
     quint64 lastEdited = getLastEdited();
@@ -381,6 +417,16 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
         }
 
         packetData->endLevel(entityLevel);
+
+        // keep the complete encoding, unless the entity changed while we were encoding it
+        if (useEncodingCache && appendState == OctreeElement::COMPLETED && getEncodingCacheKey() == encodingCacheKey) {
+            int endOfEntity = packetData->getUncompressedByteOffset();
+            QByteArray encoding((const char*)packetData->getUncompressedData(startOfEntity), endOfEntity - startOfEntity);
+
+            std::lock_guard<std::mutex> lock(_encodingCacheMutex);
+            _encodingCacheKeys[encodingCacheIndex] = encodingCacheKey;
+            _encodingCache[encodingCacheIndex] = encoding;
+        }
     } else {
         packetData->discardLevel(entityLevel);
         appendState = OctreeElement::NONE; // if we got here, then we didn't include the item
@@ -2766,6 +2812,17 @@ void EntityItem::markAsChangedOnServer() {
     });
 }
 
+EntityItem::EncodingCacheKey EntityItem::getEncodingCacheKey() const {
+    EncodingCacheKey key;
+    withReadLock([&] {
+        key.lastEdited = _lastEdited;
+        key.lastUpdated = _lastUpdated;
+        key.lastSimulated = _lastSimulated;
+        key.changedOnServer = _changedOnServer;
+    });
+    return key;
+}
+
 quint64 EntityItem::getLastChangedOnServer() const {
     quint64 result;
     withReadLock([&] {
@@ -3265,6 +3322,20 @@ void EntityItem::deregisterChangeHandler(const ChangeHandlerId& changeHandlerId)
 }
 
 void EntityItem::somethingChangedNotification() {
+    EntityTreeElementPointer element = _element; // use local copy of _element for logic below
+    if (element && element->getTree()) {
+        element->getTree()->invalidateQueryCache(*this, element);
+        if (getType() == EntityTypes::Zone) {
+            // edits update the query cube after the tree has seen it, and a new shape or rotation
+            // can change which points the zone contains without changing the cube at all
+            bool success;
+            AACube queryAACube = getQueryAACube(success);
+            if (success) {
+                element->getTree()->getZoneIndex().updateZone(getEntityItemID(), queryAACube);
+            }
+        }
+    }
+
     auto id = getEntityItemID();
     withReadLock([&] {
         for (const auto& handler : _changeHandlers.values()) {
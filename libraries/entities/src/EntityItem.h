@@ -12,7 +12,9 @@
 #ifndef hifi_EntityItem_h
 #define hifi_EntityItem_h
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <stdint.h>
 
 #include <glm/glm.hpp>
@@ -139,6 +141,12 @@ public:
                                                         EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
                                                         const bool destinationNodeCanGetAndSetPrivateUserData = false) const;
 
+    // when enabled, appendEntityData keeps the last complete encoding of each entity and reuses it
+    // for every destination until the entity changes (meant for the entity server, which encodes for many clients)
+    static void setEncodingCacheEnabled(bool enabled) { _encodingCacheEnabled = enabled; }
+    static quint64 getEncodingCacheHits() { return _encodingCacheHits; }
+    static quint64 getEncodingCacheMisses() { return _encodingCacheMisses; }
+
     virtual void appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                     EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
                                     EntityPropertyFlags& requestedProperties,
@@ -728,6 +736,29 @@ protected:
     static quint64 _rememberDeletedActionTime;
     mutable QHash<QUuid, quint64> _previouslyDeletedActions;
 
+    // the times that together change whenever the encoded entity does
+    struct EncodingCacheKey {
+        quint64 lastEdited { 0 };
+        quint64 lastUpdated { 0 };
+        quint64 lastSimulated { 0 };
+        quint64 changedOnServer { 0 };
+
+        bool operator==(const EncodingCacheKey& other) const {
+            return lastEdited == other.lastEdited && lastUpdated == other.lastUpdated &&
+                lastSimulated == other.lastSimulated && changedOnServer == other.changedOnServer;
+        }
+    };
+    EncodingCacheKey getEncodingCacheKey() const;
+
+    static bool _encodingCacheEnabled;
+    static std::atomic<quint64> _encodingCacheHits;
+    static std::atomic<quint64> _encodingCacheMisses;
+
+    // complete encodings without and with the private user data, for destinations that can't and can see it
+    mutable std::mutex _encodingCacheMutex;
+    mutable EncodingCacheKey _encodingCacheKeys[2];
+    mutable QByteArray _encodingCache[2];
+
     QUuid _sourceUUID; /// the server node UUID we came from
 
     entity::HostType _hostType { entity::HostType::DOMAIN };
@@ -34,6 +34,7 @@
 
 #include "EntitiesLogging.h"
 #include "EntityItem.h"
+#include "EntityPropertyTable.h"
 #include "ModelEntityItem.h"
 #include "PolyLineEntityItem.h"
 
@@ -3046,7 +3047,8 @@ void EntityPropertyInfoFromScriptValue(const QScriptValue& object, EntityPropert
 // TODO: Implement support for script and visible properties.
 //
 OctreeElement::AppendState EntityItemProperties::encodeEntityEditPacket(PacketType command, EntityItemID id, const EntityItemProperties& properties,
-                QByteArray& buffer, EntityPropertyFlags requestedProperties, EntityPropertyFlags& didntFitProperties) {
+                QByteArray& buffer, EntityPropertyFlags requestedProperties, EntityPropertyFlags& didntFitProperties,
+                const EntityEditEncoding& encoding) {
 
     OctreePacketData ourDataPacket(false, buffer.size()); // create a packetData object to add out packet details too.
     OctreePacketData* packetData = &ourDataPacket; // we want a pointer to this so we can use our APPEND_ENTITY_PROPERTY macro
@@ -3111,6 +3113,11 @@ OctreeElement::AppendState EntityItemProperties::encodeEntityEditPacket(PacketTy
         // TODO: Should we get rid of this in this in edit packets, since this has to always be 0?
         bool successLastUpdatedFits = packetData->appendRawData(encodedUpdateDelta);
 
+        // the encoding flags and any motion deltas, which replace the motion properties
+        int encodingOffset = packetData->getUncompressedByteOffset();
+        QByteArray encodedEncoding = encoding.toByteArray();
+        bool successEncodingFits = packetData->appendRawData(encodedEncoding);
+
         int propertyFlagsOffset = packetData->getUncompressedByteOffset();
         QByteArray encodedPropertyFlags = propertyFlags;
         int oldPropertyFlagsLength = encodedPropertyFlags.length();
@@ -3118,11 +3125,27 @@ OctreeElement::AppendState EntityItemProperties::encodeEntityEditPacket(PacketTy
         int propertyCount = 0;
 
         bool headerFits = successIDFits && successTypeFits && successLastEditedFits &&
-            successLastUpdatedFits && successPropertyFlagsFits;
+            successLastUpdatedFits && successEncodingFits && successPropertyFlagsFits;
 
         int startOfEntityItemData = packetData->getUncompressedByteOffset();
 
-        if (headerFits) {
+        if (headerFits && requestedProperties.isSubsetOf(EntityPropertyTable::getProperties())) {
+            propertyFlags -= PROP_LAST_ITEM;
+
+            // an edit of the base properties alone, like the physics simulation's, appends just the ones it has
+            requestedProperties.forEachFlag([&](EntityPropertyList property) {
+                LevelDetails propertyLevel = packetData->startLevel();
+                if (EntityPropertyTable::getEntry(property).append(*packetData, properties)) {
+                    propertyFlags |= property;
+                    propertiesDidntFit -= property;
+                    propertyCount++;
+                    packetData->endLevel(propertyLevel);
+                } else {
+                    packetData->discardLevel(propertyLevel);
+                    appendState = OctreeElement::PARTIAL;
+                }
+            });
+        } else if (headerFits) {
             bool successPropertyFits;
             propertyFlags -= PROP_LAST_ITEM; // clear the last item for now, we may or may not set it as the actual item
 
@@ -3453,7 +3476,8 @@ OctreeElement::AppendState EntityItemProperties::encodeEntityEditPacket(PacketTy
             }
         }
 
-        if (propertyCount > 0) {
+        // an edit of only motion deltas has no properties, but still has something to send
+        if (propertyCount > 0 || encoding.hasMotionDeltas()) {
             int endOfEntityItemData = packetData->getUncompressedByteOffset();
 
             encodedPropertyFlags = propertyFlags;
@@ -3477,6 +3501,25 @@ OctreeElement::AppendState EntityItemProperties::encodeEntityEditPacket(PacketTy
                 assert(newPropertyFlagsLength == oldPropertyFlagsLength); // should not have grown
             }
 
+            // large property data, which is mostly strings like userData and scripts, is compressed if that saves enough
+            int propertyDataOffset = propertyFlagsOffset + newPropertyFlagsLength;
+            int propertyDataLength = packetData->getUncompressedSize() - propertyDataOffset;
+            if (encoding.allowCompression && propertyDataLength >= EntityEditEncoding::MIN_COMPRESSED_SIZE) {
+                QByteArray compressed = qCompress(packetData->getUncompressedData(propertyDataOffset), propertyDataLength);
+                quint16 compressedLength = (quint16)compressed.size();
+                int compressedSize = (int)sizeof(compressedLength) + compressed.size();
+                if (compressed.size() <= UINT16_MAX &&
+                    compressedSize + EntityEditEncoding::MIN_COMPRESSION_SAVING <= propertyDataLength) {
+                    packetData->updatePriorBytes(propertyDataOffset, (const unsigned char*)&compressedLength, sizeof(compressedLength));
+                    packetData->updatePriorBytes(propertyDataOffset + sizeof(compressedLength),
+                                                 (const unsigned char*)compressed.constData(), compressed.size());
+                    packetData->setUncompressedSize(propertyDataOffset + compressedSize);
+
+                    unsigned char flags = encoding.flags | EntityEditEncoding::COMPRESSED;
+                    packetData->updatePriorBytes(encodingOffset, &flags, sizeof(flags));
+                }
+            }
+
             packetData->endLevel(entityLevel);
         } else {
             packetData->discardLevel(entityLevel);
@@ -3563,7 +3606,8 @@ QByteArray EntityItemProperties::packStrokeColors(const QVector<vec3>& strokeCol
 // TODO: Implement support for script and visible properties.
 //
 bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
-                                                  EntityItemID& entityID, EntityItemProperties& properties) {
+                                                  EntityItemID& entityID, EntityItemProperties& properties,
+                                                  EntityEditEncoding* encoding) {
     bool valid = false;
 
     const unsigned char* dataAt = data;
@@ -3619,12 +3663,57 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
     //quint64 updateDelta = updateDeltaCoder;
     //quint64 lastUpdated = lastEdited + updateDelta; // don't adjust for clock skew since we already did that for lastEdited
 
+    EntityEditEncoding editEncoding;
+    int encodingBytes = editEncoding.fromBytes(dataAt, bytesToRead - processedBytes);
+    if (encodingBytes < 0) {
+        return false;
+    }
+    dataAt += encodingBytes;
+    processedBytes += encodingBytes;
+    if (encoding) {
+        *encoding = editEncoding;
+    }
+
     // Property Flags...
     QByteArray encodedPropertyFlags((const char*)dataAt, (bytesToRead - processedBytes));
     EntityPropertyFlags propertyFlags = encodedPropertyFlags;
     dataAt += propertyFlags.getEncodedLength();
     processedBytes += propertyFlags.getEncodedLength();
 
+    // compressed property data is read from a decompressed copy, and counts as its compressed length
+    QByteArray decompressedData;
+    int endOfCompressedData = -1;
+    if (editEncoding.flags & EntityEditEncoding::COMPRESSED) {
+        quint16 compressedLength;
+        if (bytesToRead - processedBytes < (int)sizeof(compressedLength)) {
+            return false;
+        }
+        memcpy(&compressedLength, dataAt, sizeof(compressedLength));
+        if (bytesToRead - processedBytes < (int)sizeof(compressedLength) + compressedLength) {
+            return false;
+        }
+        decompressedData = qUncompress(dataAt + sizeof(compressedLength), compressedLength);
+        if (decompressedData.isEmpty()) {
+            qCDebug(entities) << "Failed to decompress the properties of an edit to" << entityID;
+            return false;
+        }
+        endOfCompressedData = processedBytes + (int)sizeof(compressedLength) + compressedLength;
+        dataAt = (const unsigned char*)decompressedData.constData();
+    }
+
+    if (propertyFlags.isSubsetOf(EntityPropertyTable::getProperties())) {
+        // as with encoding, an edit of the base properties alone reads just the ones it has
+        propertyFlags.forEachFlag([&](EntityPropertyList property) {
+            int bytes = EntityPropertyTable::getEntry(property).read(dataAt, properties);
+            dataAt += bytes;
+            processedBytes += bytes;
+        });
+        if (endOfCompressedData >= 0) {
+            processedBytes = endOfCompressedData;
+        }
+        return valid;
+    }
+
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_SIMULATION_OWNER, QByteArray, setSimulationOwner);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_PARENT_ID, QUuid, setParentID);
     READ_ENTITY_PROPERTY_TO_PROPERTIES(PROP_PARENT_JOINT_INDEX, quint16, setParentJointIndex);
@@ -3922,6 +4011,10 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
         properties.getRing().decodeFromEditPacket(propertyFlags, dataAt, processedBytes);
     }
 
+    if (endOfCompressedData >= 0) {
+        processedBytes = endOfCompressedData;
+    }
+
     return valid;
 }
 
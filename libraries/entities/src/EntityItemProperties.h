@@ -37,6 +37,7 @@
 #include "FontFamilies.h"
 
 #include "EntityItemID.h"
+#include "EntityEditDeltas.h"
 #include "EntityItemPropertiesDefaults.h"
 #include "EntityItemPropertiesMacros.h"
 #include "EntityTypes.h"
@@ -424,14 +425,17 @@ public:
     bool containsDimensionsChange() const { return _dimensionsChanged; }
 
     static OctreeElement::AppendState encodeEntityEditPacket(PacketType command, EntityItemID id, const EntityItemProperties& properties,
-                                       QByteArray& buffer, EntityPropertyFlags requestedProperties, EntityPropertyFlags& didntFitProperties);
+                                       QByteArray& buffer, EntityPropertyFlags requestedProperties, EntityPropertyFlags& didntFitProperties,
+                                       const EntityEditEncoding& encoding = EntityEditEncoding());
 
     static bool encodeEraseEntityMessage(const EntityItemID& entityItemID, QByteArray& buffer);
     static bool encodeCloneEntityMessage(const EntityItemID& entityIDToClone, const EntityItemID& newEntityID, QByteArray& buffer);
     static bool decodeCloneEntityMessage(const QByteArray& buffer, int& processedBytes, EntityItemID& entityIDToClone, EntityItemID& newEntityID);
 
+    // the motion deltas of the edit, if any, are left in encoding for EntityEditDeltaDecoder
     static bool decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
-                                       EntityItemID& entityID, EntityItemProperties& properties);
+                                       EntityItemID& entityID, EntityItemProperties& properties,
+                                       EntityEditEncoding* encoding = nullptr);
 
     void clearID() { _id = UNKNOWN_ENTITY_ID; _idSet = false; }
     void markAllChanged();
@@ -21,6 +21,12 @@ namespace EntityJSONQueryProperties {
     static const QString FLAGS_PROPERTY = "flags";
     static const QString INCLUDE_ANCESTORS_PROPERTY = "includeAncestors";
     static const QString INCLUDE_DESCENDANTS_PROPERTY = "includeDescendants";
+
+    // sent by clients that can load the scene from a bundle, see EntitySceneBundle: the version of the bundle loaded,
+    // SCENE_BUNDLE_WANTED until one is, or SCENE_BUNDLE_UNAVAILABLE if none could be
+    static const QString SCENE_BUNDLE_VERSION_PROPERTY = "sceneBundleVersion";
+    static const qint64 SCENE_BUNDLE_WANTED = 0;
+    static const qint64 SCENE_BUNDLE_UNAVAILABLE = -1;
 }
 
 class EntityNodeData : public OctreeQueryNode {
@@ -0,0 +1,142 @@
+//
+//  EntityPropertyTable.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPropertyTable.h"
+
+#include <array>
+#include <cassert>
+
+#include <OctreePacketData.h>
+
+#include "EntityItemProperties.h"
+
+// the same value and setter as the property's APPEND_ENTITY_PROPERTY and READ_ENTITY_PROPERTY_TO_PROPERTIES
+#define ENTITY_PROPERTY_ENTRY(P, T, V, S)                                                    \
+    { P,                                                                                     \
+      [](OctreePacketData& packetData, const EntityItemProperties& properties) {             \
+          return packetData.appendValue(V);                                                  \
+      },                                                                                     \
+      [](const unsigned char* data, EntityItemProperties& properties) {                      \
+          T fromBuffer;                                                                      \
+          int bytes = OctreePacketData::unpackDataFromBytes(data, fromBuffer);               \
+          properties.S(fromBuffer);                                                          \
+          return bytes;                                                                      \
+      } }
+
+namespace {
+
+// in the order of their flags, which is the order encodeEntityEditPacket() writes them in
+const EntityPropertyTable::Entry ENTRIES[] = {
+    ENTITY_PROPERTY_ENTRY(PROP_SIMULATION_OWNER, QByteArray, properties.getSimulationOwner().toByteArray(), setSimulationOwner),
+    ENTITY_PROPERTY_ENTRY(PROP_PARENT_ID, QUuid, properties.getParentID(), setParentID),
+    ENTITY_PROPERTY_ENTRY(PROP_PARENT_JOINT_INDEX, quint16, properties.getParentJointIndex(), setParentJointIndex),
+    ENTITY_PROPERTY_ENTRY(PROP_VISIBLE, bool, properties.getVisible(), setVisible),
+    ENTITY_PROPERTY_ENTRY(PROP_NAME, QString, properties.getName(), setName),
+    ENTITY_PROPERTY_ENTRY(PROP_LOCKED, bool, properties.getLocked(), setLocked),
+    ENTITY_PROPERTY_ENTRY(PROP_USER_DATA, QString, properties.getUserData(), setUserData),
+    ENTITY_PROPERTY_ENTRY(PROP_PRIVATE_USER_DATA, QString, properties.getPrivateUserData(), setPrivateUserData),
+    ENTITY_PROPERTY_ENTRY(PROP_HREF, QString, properties.getHref(), setHref),
+    ENTITY_PROPERTY_ENTRY(PROP_DESCRIPTION, QString, properties.getDescription(), setDescription),
+    ENTITY_PROPERTY_ENTRY(PROP_POSITION, vec3, properties.getPosition(), setPosition),
+    ENTITY_PROPERTY_ENTRY(PROP_DIMENSIONS, vec3, properties.getDimensions(), setDimensions),
+    ENTITY_PROPERTY_ENTRY(PROP_ROTATION, quat, properties.getRotation(), setRotation),
+    ENTITY_PROPERTY_ENTRY(PROP_REGISTRATION_POINT, vec3, properties.getRegistrationPoint(), setRegistrationPoint),
+    ENTITY_PROPERTY_ENTRY(PROP_CREATED, quint64, properties.getCreated(), setCreated),
+    ENTITY_PROPERTY_ENTRY(PROP_LAST_EDITED_BY, QUuid, properties.getLastEditedBy(), setLastEditedBy),
+    ENTITY_PROPERTY_ENTRY(PROP_QUERY_AA_CUBE, AACube, properties.getQueryAACube(), setQueryAACube),
+    ENTITY_PROPERTY_ENTRY(PROP_CAN_CAST_SHADOW, bool, properties.getCanCastShadow(), setCanCastShadow),
+    ENTITY_PROPERTY_ENTRY(PROP_RENDER_LAYER, RenderLayer, (uint32_t)properties.getRenderLayer(), setRenderLayer),
+    ENTITY_PROPERTY_ENTRY(PROP_PRIMITIVE_MODE, PrimitiveMode, (uint32_t)properties.getPrimitiveMode(), setPrimitiveMode),
+    ENTITY_PROPERTY_ENTRY(PROP_IGNORE_PICK_INTERSECTION, bool, properties.getIgnorePickIntersection(), setIgnorePickIntersection),
+    ENTITY_PROPERTY_ENTRY(PROP_RENDER_WITH_ZONES, QVector<QUuid>, properties.getRenderWithZones(), setRenderWithZones),
+    ENTITY_PROPERTY_ENTRY(PROP_BILLBOARD_MODE, BillboardMode, (uint32_t)properties.getBillboardMode(), setBillboardMode),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_GRABBABLE, bool, properties.getGrab().getGrabbable(), getGrab().setGrabbable),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_KINEMATIC, bool, properties.getGrab().getGrabKinematic(), getGrab().setGrabKinematic),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_FOLLOWS_CONTROLLER, bool, properties.getGrab().getGrabFollowsController(), getGrab().setGrabFollowsController),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_TRIGGERABLE, bool, properties.getGrab().getTriggerable(), getGrab().setTriggerable),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_EQUIPPABLE, bool, properties.getGrab().getEquippable(), getGrab().setEquippable),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_DELEGATE_TO_PARENT, bool, properties.getGrab().getGrabDelegateToParent(), getGrab().setGrabDelegateToParent),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_LEFT_EQUIPPABLE_POSITION_OFFSET, glm::vec3, properties.getGrab().getEquippableLeftPosition(), getGrab().setEquippableLeftPosition),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_LEFT_EQUIPPABLE_ROTATION_OFFSET, glm::quat, properties.getGrab().getEquippableLeftRotation(), getGrab().setEquippableLeftRotation),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_RIGHT_EQUIPPABLE_POSITION_OFFSET, glm::vec3, properties.getGrab().getEquippableRightPosition(), getGrab().setEquippableRightPosition),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_RIGHT_EQUIPPABLE_ROTATION_OFFSET, glm::quat, properties.getGrab().getEquippableRightRotation(), getGrab().setEquippableRightRotation),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_EQUIPPABLE_INDICATOR_URL, QString, properties.getGrab().getEquippableIndicatorURL(), getGrab().setEquippableIndicatorURL),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_EQUIPPABLE_INDICATOR_SCALE, glm::vec3, properties.getGrab().getEquippableIndicatorScale(), getGrab().setEquippableIndicatorScale),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAB_EQUIPPABLE_INDICATOR_OFFSET, glm::vec3, properties.getGrab().getEquippableIndicatorOffset(), getGrab().setEquippableIndicatorOffset),
+    ENTITY_PROPERTY_ENTRY(PROP_DENSITY, float, properties.getDensity(), setDensity),
+    ENTITY_PROPERTY_ENTRY(PROP_VELOCITY, vec3, properties.getVelocity(), setVelocity),
+    ENTITY_PROPERTY_ENTRY(PROP_ANGULAR_VELOCITY, vec3, properties.getAngularVelocity(), setAngularVelocity),
+    ENTITY_PROPERTY_ENTRY(PROP_GRAVITY, vec3, properties.getGravity(), setGravity),
+    ENTITY_PROPERTY_ENTRY(PROP_ACCELERATION, vec3, properties.getAcceleration(), setAcceleration),
+    ENTITY_PROPERTY_ENTRY(PROP_DAMPING, float, properties.getDamping(), setDamping),
+    ENTITY_PROPERTY_ENTRY(PROP_ANGULAR_DAMPING, float, properties.getAngularDamping(), setAngularDamping),
+    ENTITY_PROPERTY_ENTRY(PROP_RESTITUTION, float, properties.getRestitution(), setRestitution),
+    ENTITY_PROPERTY_ENTRY(PROP_FRICTION, float, properties.getFriction(), setFriction),
+    ENTITY_PROPERTY_ENTRY(PROP_LIFETIME, float, properties.getLifetime(), setLifetime),
+    ENTITY_PROPERTY_ENTRY(PROP_COLLISIONLESS, bool, properties.getCollisionless(), setCollisionless),
+    ENTITY_PROPERTY_ENTRY(PROP_COLLISION_MASK, uint16_t, properties.getCollisionMask(), setCollisionMask),
+    ENTITY_PROPERTY_ENTRY(PROP_DYNAMIC, bool, properties.getDynamic(), setDynamic),
+    ENTITY_PROPERTY_ENTRY(PROP_COLLISION_SOUND_URL, QString, properties.getCollisionSoundURL(), setCollisionSoundURL),
+    ENTITY_PROPERTY_ENTRY(PROP_ACTION_DATA, QByteArray, properties.getActionData(), setActionData),
+    ENTITY_PROPERTY_ENTRY(PROP_CLONEABLE, bool, properties.getCloneable(), setCloneable),
+    ENTITY_PROPERTY_ENTRY(PROP_CLONE_LIFETIME, float, properties.getCloneLifetime(), setCloneLifetime),
+    ENTITY_PROPERTY_ENTRY(PROP_CLONE_LIMIT, float, properties.getCloneLimit(), setCloneLimit),
+    ENTITY_PROPERTY_ENTRY(PROP_CLONE_DYNAMIC, bool, properties.getCloneDynamic(), setCloneDynamic),
+    ENTITY_PROPERTY_ENTRY(PROP_CLONE_AVATAR_ENTITY, bool, properties.getCloneAvatarEntity(), setCloneAvatarEntity),
+    ENTITY_PROPERTY_ENTRY(PROP_CLONE_ORIGIN_ID, QUuid, properties.getCloneOriginID(), setCloneOriginID),
+    ENTITY_PROPERTY_ENTRY(PROP_SCRIPT, QString, properties.getScript(), setScript),
+    ENTITY_PROPERTY_ENTRY(PROP_SCRIPT_TIMESTAMP, quint64, properties.getScriptTimestamp(), setScriptTimestamp),
+    ENTITY_PROPERTY_ENTRY(PROP_SERVER_SCRIPTS, QString, properties.getServerScripts(), setServerScripts),
+    ENTITY_PROPERTY_ENTRY(PROP_ITEM_NAME, QString, properties.getItemName(), setItemName),
+    ENTITY_PROPERTY_ENTRY(PROP_ITEM_DESCRIPTION, QString, properties.getItemDescription(), setItemDescription),
+    ENTITY_PROPERTY_ENTRY(PROP_ITEM_CATEGORIES, QString, properties.getItemCategories(), setItemCategories),
+    ENTITY_PROPERTY_ENTRY(PROP_ITEM_ARTIST, QString, properties.getItemArtist(), setItemArtist),
+    ENTITY_PROPERTY_ENTRY(PROP_ITEM_LICENSE, QString, properties.getItemLicense(), setItemLicense),
+    ENTITY_PROPERTY_ENTRY(PROP_LIMITED_RUN, quint32, properties.getLimitedRun(), setLimitedRun),
+    ENTITY_PROPERTY_ENTRY(PROP_MARKETPLACE_ID, QString, properties.getMarketplaceID(), setMarketplaceID),
+    ENTITY_PROPERTY_ENTRY(PROP_EDITION_NUMBER, quint32, properties.getEditionNumber(), setEditionNumber),
+    ENTITY_PROPERTY_ENTRY(PROP_ENTITY_INSTANCE_NUMBER, quint32, properties.getEntityInstanceNumber(), setEntityInstanceNumber),
+    ENTITY_PROPERTY_ENTRY(PROP_CERTIFICATE_ID, QString, properties.getCertificateID(), setCertificateID),
+    ENTITY_PROPERTY_ENTRY(PROP_CERTIFICATE_TYPE, QString, properties.getCertificateType(), setCertificateType),
+    ENTITY_PROPERTY_ENTRY(PROP_STATIC_CERTIFICATE_VERSION, quint32, properties.getStaticCertificateVersion(), setStaticCertificateVersion),
+};
+
+#undef ENTITY_PROPERTY_ENTRY
+
+struct Index {
+    std::array<const EntityPropertyTable::Entry*, PROP_AFTER_LAST_ITEM> entries {};
+    EntityPropertyFlags properties;
+
+    Index() {
+        for (const auto& entry : ENTRIES) {
+            assert(!properties.getHasProperty(entry.property) && properties.lastFlag() < entry.property);
+            entries[entry.property] = &entry;
+            properties += entry.property;
+        }
+    }
+};
+
+const Index& getIndex() {
+    static const Index index;
+    return index;
+}
+
+}
+
+const EntityPropertyTable::Entry& EntityPropertyTable::getEntry(EntityPropertyList property) {
+    const Entry* entry = getIndex().entries[property];
+    assert(entry);
+    return *entry;
+}
+
+const EntityPropertyFlags& EntityPropertyTable::getProperties() {
+    return getIndex().properties;
+}
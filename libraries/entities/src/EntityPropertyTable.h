@@ -0,0 +1,41 @@
+//
+//  EntityPropertyTable.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPropertyTable_h
+#define hifi_EntityPropertyTable_h
+
+#include "EntityPropertyFlags.h"
+
+class EntityItemProperties;
+class OctreePacketData;
+
+// A table of the properties every entity has, grab group included, with how each is written to and read from an edit.
+// These are the properties below the ones shared by some entity types, which the edit packets carry first and in the
+// order of their flags, so an edit of nothing else can be encoded and decoded by walking its set flags alone instead of
+// testing every property of every type. That covers the bulk of the edits sent, the physics simulation's transform and
+// velocity updates. The derived properties reuse the same flags for different types, so they can't be in the table.
+class EntityPropertyTable {
+public:
+    struct Entry {
+        EntityPropertyList property;
+        bool (*append)(OctreePacketData& packetData, const EntityItemProperties& properties);
+        // returns the number of bytes read
+        int (*read)(const unsigned char* data, EntityItemProperties& properties);
+    };
+
+    // the entry of a property in getProperties()
+    static const Entry& getEntry(EntityPropertyList property);
+
+    // the properties in the table: all those of the base entity that are sent over the wire
+    static const EntityPropertyFlags& getProperties();
+};
+
+#endif // hifi_EntityPropertyTable_h
@@ -0,0 +1,125 @@
+//
+//  EntityQueryCache.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityQueryCache.h"
+
+#include <algorithm>
+
+#include <PerformanceCounters.h>
+
+std::atomic<bool> EntityQueryCache::_enabled { true };
+
+static PerformanceCounters::Counter& queryCacheHits() {
+    static auto& counter = PerformanceCounters::getInstance().counter("entity_query_cache_hits",
+        "Spatial entity queries answered from the query cache");
+    return counter;
+}
+
+static PerformanceCounters::Counter& queryCacheMisses() {
+    static auto& counter = PerformanceCounters::getInstance().counter("entity_query_cache_misses",
+        "Spatial entity queries that had to walk the entity tree");
+    return counter;
+}
+
+bool EntityQueryCache::Query::operator==(const Query& other) const {
+    return type == other.type && corner == other.corner && size == other.size && filter == other.filter &&
+        entityType == other.entityType && caseSensitive == other.caseSensitive && name == other.name;
+}
+
+EntityQueryCache::Query EntityQueryCache::sphereQuery(QueryType type, const glm::vec3& center, float radius,
+                                                      PickFilter filter) {
+    Query query;
+    query.type = type;
+    query.corner = center - glm::vec3(radius);
+    query.size = glm::vec3(2.0f * radius);
+    query.filter = filter;
+    return query;
+}
+
+EntityQueryCache::Query EntityQueryCache::boxQuery(QueryType type, const glm::vec3& corner, const glm::vec3& size,
+                                                   PickFilter filter) {
+    Query query;
+    query.type = type;
+    query.corner = corner;
+    query.size = size;
+    query.filter = filter;
+    return query;
+}
+
+bool EntityQueryCache::find(const Query& query, QVector<QUuid>& results) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& entry : _entries) {
+        if (entry.query == query) {
+            entry.lastUsed = ++_useCount;
+            results = entry.results;
+            ++_numHits;
+            queryCacheHits().increment();
+            return true;
+        }
+    }
+    ++_numMisses;
+    queryCacheMisses().increment();
+    return false;
+}
+
+void EntityQueryCache::insert(const Query& query, const QVector<QUuid>& results, uint64_t changeCount) {
+    AABox region = query.getRegion();
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    uint64_t currentChangeCount = _changeCount.load(std::memory_order_relaxed);
+    if (currentChangeCount - changeCount > NUM_RECENT_CHANGES) {
+        // too much changed while the query ran to tell where
+        return;
+    }
+    for (uint64_t count = changeCount + 1; count <= currentChangeCount; ++count) {
+        const Change& change = _recentChanges[count % NUM_RECENT_CHANGES];
+        if (change.count != count || change.region.touches(region)) {
+            return;
+        }
+    }
+
+    for (auto& entry : _entries) {
+        if (entry.query == query) {
+            entry.results = results;
+            entry.lastUsed = ++_useCount;
+            return;
+        }
+    }
+    if (_entries.size() >= MAX_ENTRIES) {
+        auto leastUsed = std::min_element(_entries.begin(), _entries.end(), [](const Entry& a, const Entry& b) {
+            return a.lastUsed < b.lastUsed;
+        });
+        std::swap(*leastUsed, _entries.back());
+        _entries.pop_back();
+    }
+    _entries.push_back({ query, region, results, ++_useCount });
+    _numEntries.store(_entries.size(), std::memory_order_release);
+}
+
+void EntityQueryCache::invalidate(const AABox& region) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    uint64_t count = _changeCount.load(std::memory_order_relaxed) + 1;
+    _recentChanges[count % NUM_RECENT_CHANGES] = { count, region };
+    _changeCount.store(count, std::memory_order_release);
+
+    _entries.erase(std::remove_if(_entries.begin(), _entries.end(), [&](const Entry& entry) {
+        return entry.region.touches(region);
+    }), _entries.end());
+    _numEntries.store(_entries.size(), std::memory_order_release);
+}
+
+void EntityQueryCache::clear() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // a gap bigger than the recent changes keeps whatever queries are running from being cached
+    _changeCount.store(_changeCount.load(std::memory_order_relaxed) + NUM_RECENT_CHANGES + 1, std::memory_order_release);
+    _entries.clear();
+    _numEntries.store(0, std::memory_order_release);
+}
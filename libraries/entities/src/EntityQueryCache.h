@@ -0,0 +1,109 @@
+//
+//  EntityQueryCache.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityQueryCache_h
+#define hifi_EntityQueryCache_h
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+#include <QtCore/QString>
+#include <QtCore/QUuid>
+#include <QtCore/QVector>
+
+#include <AABox.h>
+#include <PickFilter.h>
+
+#include "EntityTypes.h"
+
+// Remembers the results of the spatial queries scripts and servers repeat every frame with the same parameters, like
+// proximity triggers and zone checks, so that a repeat over a region where nothing changed skips walking the tree.
+// The tree reports the region of every change, from the elements entities are added to or removed from, and from the
+// entities that move or have their properties changed; results whose region it touches are dropped.
+class EntityQueryCache {
+public:
+    enum QueryType {
+        SPHERE,
+        SPHERE_WITH_TYPE,
+        SPHERE_WITH_NAME,
+        CUBE,
+        BOX,
+        CLOSEST
+    };
+
+    struct Query {
+        QueryType type;
+        glm::vec3 corner;
+        glm::vec3 size;
+        PickFilter filter;
+        EntityTypes::EntityType entityType { EntityTypes::Unknown };
+        QString name;
+        bool caseSensitive { false };
+
+        bool operator==(const Query& other) const;
+        // the region a change has to touch to change the result
+        AABox getRegion() const { return AABox(corner, size); }
+    };
+
+    static Query sphereQuery(QueryType type, const glm::vec3& center, float radius, PickFilter filter);
+    static Query boxQuery(QueryType type, const glm::vec3& corner, const glm::vec3& size, PickFilter filter);
+
+    static const size_t MAX_ENTRIES = 128;
+
+    static void setEnabled(bool enabled) { _enabled = enabled; }
+    static bool isEnabled() { return _enabled; }
+
+    // the change count to hand back to insert(), taken before running the query the result is from
+    uint64_t getChangeCount() const { return _changeCount.load(std::memory_order_acquire); }
+
+    bool find(const Query& query, QVector<QUuid>& results);
+    // caches a result unless something changed in its region since the count was taken
+    void insert(const Query& query, const QVector<QUuid>& results, uint64_t changeCount);
+
+    void invalidate(const AABox& region);
+    // drops everything, and keeps the queries running meanwhile from being cached: for changes that aren't worth
+    // working out the region of, like those while nothing is cached
+    void clear();
+    bool isEmpty() const { return _numEntries.load(std::memory_order_acquire) == 0; }
+
+    uint64_t getNumHits() const { return _numHits; }
+    uint64_t getNumMisses() const { return _numMisses; }
+
+private:
+    struct Entry {
+        Query query;
+        AABox region;
+        QVector<QUuid> results;
+        uint64_t lastUsed;
+    };
+
+    // the regions of the last changes, to tell whether a result computed while they were made is still good
+    static const size_t NUM_RECENT_CHANGES = 64;
+    struct Change {
+        uint64_t count;
+        AABox region;
+    };
+
+    static std::atomic<bool> _enabled;
+
+    std::mutex _mutex;
+    std::vector<Entry> _entries;
+    std::array<Change, NUM_RECENT_CHANGES> _recentChanges;
+    std::atomic<uint64_t> _changeCount { 0 };
+    std::atomic<size_t> _numEntries { 0 };
+    uint64_t _useCount { 0 };
+    std::atomic<uint64_t> _numHits { 0 };
+    std::atomic<uint64_t> _numMisses { 0 };
+};
+
+#endif // hifi_EntityQueryCache_h
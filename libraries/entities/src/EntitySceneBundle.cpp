@@ -0,0 +1,256 @@
+//
+//  EntitySceneBundle.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySceneBundle.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QDataStream>
+
+#include <OctreePacketData.h>
+#include <SharedUtil.h>
+
+#include "EntitiesLogging.h"
+#include "EntityTreeElement.h"
+
+const float EntitySceneBundle::DEFAULT_CHUNK_SCALE = 128.0f; // meters
+
+namespace {
+
+const quint32 SCENE_BUNDLE_MAGIC = 0x48465342; // "HFSB"
+const quint32 SCENE_BUNDLE_VERSION = 1;
+const quint32 MAX_SCENE_BUNDLE_CHUNKS = 1 << 20;
+
+struct PendingChunk {
+    AACube cube;
+    std::vector<EntityItemPointer> entities;
+};
+
+void collectEntitiesBelow(const EntityTreeElementPointer& element, std::vector<EntityItemPointer>& entities) {
+    element->forEachEntity([&](const EntityItemPointer& entity) {
+        entities.push_back(entity);
+    });
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        auto child = std::static_pointer_cast<EntityTreeElement>(element->getChildAtIndex(i));
+        if (child) {
+            collectEntitiesBelow(child, entities);
+        }
+    }
+}
+
+// an element small enough is a chunk with everything below it, a bigger one is a chunk of its own entities
+void collectChunks(const EntityTreeElementPointer& element, float chunkScale, std::vector<PendingChunk>& chunks) {
+    PendingChunk chunk { element->getAACube(), {} };
+    bool isChunkRoot = element->getScale() <= chunkScale;
+    if (isChunkRoot) {
+        collectEntitiesBelow(element, chunk.entities);
+    } else {
+        element->forEachEntity([&](const EntityItemPointer& entity) {
+            chunk.entities.push_back(entity);
+        });
+    }
+    if (!chunk.entities.empty()) {
+        chunks.push_back(std::move(chunk));
+    }
+
+    if (!isChunkRoot) {
+        for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+            auto child = std::static_pointer_cast<EntityTreeElement>(element->getChildAtIndex(i));
+            if (child) {
+                collectChunks(child, chunkScale, chunks);
+            }
+        }
+    }
+}
+
+// the entities in as many sections as they need, each laid out like the payload EntityTreeSendThread builds for a packet
+QByteArray encodeSections(const std::vector<EntityItemPointer>& entities, uint8_t childrenExistBits) {
+    QByteArray sections;
+    OctreePacketData packetData(false);
+    EncodeBitstreamParams params(WANT_EXISTS_BITS);
+    EntityTreeElementExtraEncodeDataPointer extraEncodeData { new EntityTreeElementExtraEncodeData() };
+
+    size_t next = 0;
+    while (next < entities.size()) {
+        packetData.reset();
+        const uint8_t zeroByte = 0;
+        packetData.appendValue(zeroByte); // octalcode
+        packetData.appendValue(zeroByte); // colors
+        packetData.appendValue(childrenExistBits); // childrenInTreeMask
+        packetData.appendValue(zeroByte); // childrenInBufferMask
+        uint16_t numEntities = 0;
+        int numEntitiesOffset = packetData.getUncompressedByteOffset();
+        packetData.appendValue(numEntities);
+
+        LevelDetails entitiesLevel = packetData.startLevel();
+        while (next < entities.size()) {
+            // an entity that doesn't fit is continued, with the properties that didn't, in the next section
+            OctreeElement::AppendState appendState = entities[next]->appendEntityData(&packetData, params, extraEncodeData);
+            if (appendState != OctreeElement::COMPLETED) {
+                if (appendState == OctreeElement::PARTIAL) {
+                    ++numEntities;
+                }
+                break;
+            }
+            ++numEntities;
+            ++next;
+        }
+
+        if (numEntities == 0) {
+            // not even part of it fits in an empty section
+            qCWarning(entities) << "Leaving entity" << entities[next]->getID() << "out of the scene bundle, it can't be encoded";
+            packetData.discardLevel(entitiesLevel);
+            ++next;
+            continue;
+        }
+        packetData.endLevel(entitiesLevel);
+        packetData.updatePriorBytes(numEntitiesOffset, (const unsigned char*)&numEntities, sizeof(numEntities));
+
+        OCTREE_PACKET_INTERNAL_SECTION_SIZE sectionSize = (OCTREE_PACKET_INTERNAL_SECTION_SIZE)packetData.getFinalizedSize();
+        sections.append((const char*)&sectionSize, sizeof(sectionSize));
+        sections.append((const char*)packetData.getFinalizedData(), sectionSize);
+    }
+    return sections;
+}
+
+}
+
+EntitySceneBundle EntitySceneBundle::encode(const EntityTreePointer& tree, float chunkScale, QSet<QUuid>* entityIDs) {
+    EntitySceneBundle bundle;
+    std::vector<PendingChunk> pendingChunks;
+    uint8_t childrenExistBits = 0;
+
+    // only the walk holds the tree's lock, the entities guard their own properties while they are encoded; one edited
+    // in the meantime is encoded as it is by then, which is still no older than the version
+    tree->withReadLock([&] {
+        bundle.version = usecTimestampNow();
+        EntityTreeElementPointer root = tree->getRoot();
+        for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+            if (root->getChildAtIndex(i)) {
+                childrenExistBits += (1 << i);
+            }
+        }
+        collectChunks(root, chunkScale, pendingChunks);
+    });
+
+    bundle.chunks.reserve(pendingChunks.size());
+    for (const auto& pendingChunk : pendingChunks) {
+        Chunk chunk;
+        chunk.cube = pendingChunk.cube;
+        chunk.numEntities = (uint32_t)pendingChunk.entities.size();
+        chunk.sections = qCompress(encodeSections(pendingChunk.entities, childrenExistBits));
+        bundle.chunks.push_back(std::move(chunk));
+
+        if (entityIDs) {
+            for (const auto& entity : pendingChunk.entities) {
+                entityIDs->insert(entity->getID());
+            }
+        }
+    }
+    return bundle;
+}
+
+uint32_t EntitySceneBundle::getNumEntities() const {
+    uint32_t numEntities = 0;
+    for (const auto& chunk : chunks) {
+        numEntities += chunk.numEntities;
+    }
+    return numEntities;
+}
+
+QByteArray EntitySceneBundle::toByteArray() const {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream << SCENE_BUNDLE_MAGIC << SCENE_BUNDLE_VERSION << (quint32)versionForPacketType(PacketType::EntityData) << version;
+
+    stream << (quint32)chunks.size();
+    for (const auto& chunk : chunks) {
+        const glm::vec3& corner = chunk.cube.getCorner();
+        stream << corner.x << corner.y << corner.z << chunk.cube.getScale() << chunk.numEntities << chunk.sections;
+    }
+    return data;
+}
+
+bool EntitySceneBundle::fromByteArray(const QByteArray& data) {
+    *this = EntitySceneBundle();
+    QDataStream stream(data);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    quint32 magic, formatVersion, bitstreamVersion, numChunks;
+    stream >> magic >> formatVersion >> bitstreamVersion >> version >> numChunks;
+    if (stream.status() != QDataStream::Ok || magic != SCENE_BUNDLE_MAGIC || formatVersion != SCENE_BUNDLE_VERSION ||
+        bitstreamVersion != (quint32)versionForPacketType(PacketType::EntityData) || numChunks > MAX_SCENE_BUNDLE_CHUNKS) {
+        *this = EntitySceneBundle();
+        return false;
+    }
+
+    chunks.resize(numChunks);
+    for (auto& chunk : chunks) {
+        glm::vec3 corner;
+        float scale;
+        stream >> corner.x >> corner.y >> corner.z >> scale >> chunk.numEntities >> chunk.sections;
+        chunk.cube = AACube(corner, scale);
+    }
+    if (stream.status() != QDataStream::Ok || !stream.atEnd()) {
+        *this = EntitySceneBundle();
+        return false;
+    }
+    return true;
+}
+
+std::vector<size_t> EntitySceneBundle::getChunkOrder(const glm::vec3& position) const {
+    std::vector<std::pair<float, size_t>> distances;
+    distances.reserve(chunks.size());
+    for (size_t i = 0; i < chunks.size(); i++) {
+        const AACube& cube = chunks[i].cube;
+        glm::vec3 nearestPoint = glm::clamp(position, cube.getCorner(), cube.getCorner() + glm::vec3(cube.getScale()));
+        distances.emplace_back(glm::distance(position, nearestPoint), i);
+    }
+    std::stable_sort(distances.begin(), distances.end(), [](const std::pair<float, size_t>& a, const std::pair<float, size_t>& b) {
+        return a.first < b.first;
+    });
+
+    std::vector<size_t> order;
+    order.reserve(distances.size());
+    for (const auto& distance : distances) {
+        order.push_back(distance.second);
+    }
+    return order;
+}
+
+bool EntitySceneBundle::readChunk(const Chunk& chunk, EntityTree& tree, const SharedNodePointer& sourceNode) const {
+    QByteArray sections = qUncompress(chunk.sections);
+    if (sections.isEmpty() && chunk.numEntities > 0) {
+        return false;
+    }
+
+    const char* data = sections.constData();
+    const char* end = data + sections.size();
+    while (data < end) {
+        OCTREE_PACKET_INTERNAL_SECTION_SIZE sectionSize;
+        if (end - data < (qint64)sizeof(sectionSize)) {
+            return false;
+        }
+        memcpy(&sectionSize, data, sizeof(sectionSize));
+        data += sizeof(sectionSize);
+        if (sectionSize == 0 || sectionSize > end - data || sectionSize > MAX_OCTREE_UNCOMRESSED_PACKET_SIZE) {
+            return false;
+        }
+
+        ReadBitstreamToTreeParams args(WANT_EXISTS_BITS, nullptr, sourceNode ? sourceNode->getUUID() : QUuid(), sourceNode);
+        OctreePacketData packetData(false);
+        packetData.loadFinalizedContent(reinterpret_cast<const unsigned char*>(data), sectionSize);
+        tree.readBitstreamToTree(packetData.getUncompressedData(), packetData.getUncompressedSize(), args);
+        data += sectionSize;
+    }
+    return true;
+}
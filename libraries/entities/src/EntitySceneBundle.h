@@ -0,0 +1,67 @@
+//
+//  EntitySceneBundle.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySceneBundle_h
+#define hifi_EntitySceneBundle_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QSet>
+#include <QtCore/QUuid>
+
+#include <glm/glm.hpp>
+
+#include <AACube.h>
+#include <Node.h>
+#include <udt/PacketHeaders.h>
+
+#include "EntityTree.h"
+
+// A precompiled copy of the whole entity scene, which the entity server writes out for clients to download over HTTP
+// instead of having it sent to each of them in turn. The entities are encoded just as they are in EntityData packets,
+// for a client that can't see private user data, and split into chunks by octree element so that a client can read
+// the part of the scene around it first. Each chunk is compressed on its own.
+class EntitySceneBundle {
+public:
+    // the biggest octree element whose entities, and those below it, are kept in one chunk
+    static const float DEFAULT_CHUNK_SCALE;
+
+    struct Chunk {
+        AACube cube; // holds every entity in the chunk
+        uint32_t numEntities { 0 };
+        QByteArray sections; // compressed EntityData packet sections, each prefixed by its size
+    };
+
+    // the server time the scene was taken at; the bundle holds every entity as it was then or later
+    quint64 version { 0 };
+    std::vector<Chunk> chunks;
+
+    // Encodes the entities in the tree, which must not be locked. The IDs of the entities the bundle holds are
+    // added to entityIDs if it is given.
+    static EntitySceneBundle encode(const EntityTreePointer& tree, float chunkScale = DEFAULT_CHUNK_SCALE,
+                                    QSet<QUuid>* entityIDs = nullptr);
+
+    uint32_t getNumEntities() const;
+
+    QByteArray toByteArray() const;
+    // fails, leaving the bundle empty, for data that isn't a bundle of this format with this build's entity encoding
+    bool fromByteArray(const QByteArray& data);
+
+    // the chunks in the order to read them in, those nearest the position first
+    std::vector<size_t> getChunkOrder(const glm::vec3& position) const;
+
+    // Reads a chunk into the tree, which must be write locked, as if its sections had come in EntityData packets from
+    // the source node. Fails if the chunk's data is malformed, when part of it may have been read.
+    bool readChunk(const Chunk& chunk, EntityTree& tree, const SharedNodePointer& sourceNode) const;
+};
+
+#endif // hifi_EntitySceneBundle_h
@@ -11,6 +11,8 @@
 
 #include "EntityScriptingInterface.h"
 
+#include <functional>
+
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtx/transform.hpp>
 
@@ -791,104 +793,338 @@ QScriptValue EntityScriptingInterface::getMultipleEntityPropertiesInternal(QScri
     return finalResult;
 }
 
+namespace {
+
+// A property that getMultipleEntityPropertyArrays returns in a typed array, read straight from the entity.
+struct TypedArrayProperty {
+    int numComponents;
+    bool isBoolean; // in a Uint8Array, otherwise a Float32Array
+    std::function<void(const EntityItem& entity, float* values)> read;
+};
+
+void readVec3(float* values, const glm::vec3& value) {
+    values[0] = value.x;
+    values[1] = value.y;
+    values[2] = value.z;
+}
+
+void readQuat(float* values, const glm::quat& value) {
+    values[0] = value.x;
+    values[1] = value.y;
+    values[2] = value.z;
+    values[3] = value.w;
+}
+
+const QHash<QString, TypedArrayProperty>& getTypedArrayProperties() {
+    // position and rotation are in the world frame, as in the objects scripts get from getEntityProperties
+    static const QHash<QString, TypedArrayProperty> properties {
+        { "position", { 3, false, [](const EntityItem& entity, float* values) { readVec3(values, entity.getWorldPosition()); } } },
+        { "rotation", { 4, false, [](const EntityItem& entity, float* values) { readQuat(values, entity.getWorldOrientation()); } } },
+        { "velocity", { 3, false, [](const EntityItem& entity, float* values) { readVec3(values, entity.getWorldVelocity()); } } },
+        { "angularVelocity", { 3, false, [](const EntityItem& entity, float* values) {
+            readVec3(values, entity.getWorldAngularVelocity());
+        } } },
+        { "dimensions", { 3, false, [](const EntityItem& entity, float* values) { readVec3(values, entity.getScaledDimensions()); } } },
+        { "localPosition", { 3, false, [](const EntityItem& entity, float* values) { readVec3(values, entity.getLocalPosition()); } } },
+        { "localRotation", { 4, false, [](const EntityItem& entity, float* values) {
+            readQuat(values, entity.getLocalOrientation());
+        } } },
+        { "localVelocity", { 3, false, [](const EntityItem& entity, float* values) { readVec3(values, entity.getLocalVelocity()); } } },
+        { "localAngularVelocity", { 3, false, [](const EntityItem& entity, float* values) {
+            readVec3(values, entity.getLocalAngularVelocity());
+        } } },
+        { "gravity", { 3, false, [](const EntityItem& entity, float* values) { readVec3(values, entity.getGravity()); } } },
+        { "acceleration", { 3, false, [](const EntityItem& entity, float* values) { readVec3(values, entity.getAcceleration()); } } },
+        { "registrationPoint", { 3, false, [](const EntityItem& entity, float* values) {
+            readVec3(values, entity.getRegistrationPoint());
+        } } },
+        { "damping", { 1, false, [](const EntityItem& entity, float* values) { values[0] = entity.getDamping(); } } },
+        { "angularDamping", { 1, false, [](const EntityItem& entity, float* values) { values[0] = entity.getAngularDamping(); } } },
+        { "restitution", { 1, false, [](const EntityItem& entity, float* values) { values[0] = entity.getRestitution(); } } },
+        { "friction", { 1, false, [](const EntityItem& entity, float* values) { values[0] = entity.getFriction(); } } },
+        { "density", { 1, false, [](const EntityItem& entity, float* values) { values[0] = entity.getDensity(); } } },
+        { "lifetime", { 1, false, [](const EntityItem& entity, float* values) { values[0] = entity.getLifetime(); } } },
+        { "age", { 1, false, [](const EntityItem& entity, float* values) { values[0] = entity.getAge(); } } },
+        { "visible", { 1, true, [](const EntityItem& entity, float* values) { values[0] = entity.getVisible(); } } },
+        { "collisionless", { 1, true, [](const EntityItem& entity, float* values) { values[0] = entity.getCollisionless(); } } },
+        { "dynamic", { 1, true, [](const EntityItem& entity, float* values) { values[0] = entity.getDynamic(); } } },
+        { "locked", { 1, true, [](const EntityItem& entity, float* values) { values[0] = entity.getLocked(); } } }
+    };
+    return properties;
+}
+
+// wraps the values in a typed array of the class if the engine has typed arrays, an ordinary array if it doesn't
+template <typename T>
+QScriptValue newTypedArray(QScriptEngine* engine, const QString& className, const std::vector<T>& values) {
+    auto constructor = engine->globalObject().property(className);
+    if (constructor.isFunction()) {
+        auto buffer = engine->toScriptValue(QByteArray((const char*)values.data(), (int)(values.size() * sizeof(T))));
+        auto typedArray = constructor.construct(QScriptValueList { buffer });
+        if (typedArray.property("length").toUInt32() == values.size()) {
+            return typedArray;
+        }
+    }
+
+    QScriptValue array = engine->newArray((uint)values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        array.setProperty((quint32)i, (double)values[i]);
+    }
+    return array;
+}
+
+}
+
+// Static method to make sure that we have the right script engine.
+// Using sender() or QtScriptable::engine() does not work for classes used by multiple threads (script-engines)
+QScriptValue EntityScriptingInterface::getMultipleEntityPropertyArrays(QScriptContext* context, QScriptEngine* engine) {
+    const int ARGUMENT_ENTITY_IDS = 0;
+    const int ARGUMENT_PROPERTY_NAMES = 1;
+
+    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    const auto entityIDs = qscriptvalue_cast<QVector<QUuid>>(context->argument(ARGUMENT_ENTITY_IDS));
+    const auto propertyNames = qscriptvalue_cast<QStringList>(context->argument(ARGUMENT_PROPERTY_NAMES));
+    return entityScriptingInterface->getMultipleEntityPropertyArraysInternal(engine, entityIDs, propertyNames);
+}
+
+QScriptValue EntityScriptingInterface::getMultipleEntityPropertyArraysInternal(QScriptEngine* engine,
+                                                                               const QVector<QUuid>& entityIDs,
+                                                                               const QStringList& propertyNames) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    const auto& typedArrayProperties = getTypedArrayProperties();
+
+    // the typed ones are read from the entities, the rest from their properties, as getMultipleEntityProperties would
+    std::vector<std::pair<QString, const TypedArrayProperty*>> typedProperties;
+    QStringList otherPropertyNames;
+    for (const auto& name : propertyNames) {
+        auto it = typedArrayProperties.find(name);
+        if (it != typedArrayProperties.end()) {
+            typedProperties.emplace_back(name, &it.value());
+        } else {
+            otherPropertyNames.append(name);
+        }
+    }
+
+    EntityPropertyFlags otherDesiredProperties;
+    if (!otherPropertyNames.isEmpty()) {
+        otherDesiredProperties = qscriptvalue_cast<EntityPropertyFlags>(qScriptValueFromSequence(engine, otherPropertyNames));
+        // the parent is needed to put position and rotation in the world frame
+        otherDesiredProperties.setHasProperty(PROP_PARENT_ID);
+        otherDesiredProperties.setHasProperty(PROP_PARENT_JOINT_INDEX);
+    }
+
+    QVector<QUuid> foundIDs;
+    std::vector<std::vector<float>> typedValues(typedProperties.size());
+    QVector<EntityPropertiesResult> otherResults;
+    if (_entityTree) {
+        _entityTree->withReadLock([&] {
+            for (const auto& entityID : entityIDs) {
+                const EntityItemPointer entity = _entityTree->findEntityByEntityItemID(EntityItemID(entityID));
+                if (!entity) {
+                    continue;
+                }
+                foundIDs.append(entityID);
+
+                for (size_t i = 0; i < typedProperties.size(); ++i) {
+                    auto& values = typedValues[i];
+                    auto property = typedProperties[i].second;
+                    values.resize(values.size() + property->numComponents);
+                    property->read(*entity, values.data() + values.size() - property->numComponents);
+                }
+
+                if (!otherPropertyNames.isEmpty()) {
+                    otherResults.append(EntityPropertiesResult(entity->getProperties(otherDesiredProperties, true),
+                                                               entity->getScalesWithParent()));
+                }
+            }
+        });
+    }
+
+    QScriptValue result = engine->newObject();
+    result.setProperty("ids", qScriptValueFromSequence(engine, foundIDs));
+
+    for (size_t i = 0; i < typedProperties.size(); ++i) {
+        const auto& values = typedValues[i];
+        if (typedProperties[i].second->isBoolean) {
+            result.setProperty(typedProperties[i].first, newTypedArray(engine, "Uint8Array",
+                                                                       std::vector<uint8_t>(values.begin(), values.end())));
+        } else {
+            result.setProperty(typedProperties[i].first, newTypedArray(engine, "Float32Array", values));
+        }
+    }
+
+    if (!otherPropertyNames.isEmpty()) {
+        std::vector<QScriptValue> otherArrays;
+        for (const auto& name : otherPropertyNames) {
+            otherArrays.push_back(engine->newArray(otherResults.size()));
+            result.setProperty(name, otherArrays.back());
+        }
+
+        quint32 index = 0;
+        for (const auto& otherResult : otherResults) {
+            auto properties = convertPropertiesToScriptSemantics(otherResult.properties, otherResult.scalesWithParent)
+                .copyToScriptValue(engine, false, false, false);
+            for (int i = 0; i < otherPropertyNames.size(); ++i) {
+                otherArrays[i].setProperty(index, properties.property(otherPropertyNames[i]));
+            }
+            ++index;
+        }
+    }
+
+    return result;
+}
+
 QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProperties& scriptSideProperties) {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
-    _activityTracking.editedEntityCount++;
+    auto editedIDs = editEntitiesInternal({ id }, { scriptSideProperties });
+    return editedIDs.isEmpty() ? QUuid() : editedIDs.front();
+}
+
+// Static method to make sure that we have the right script engine.
+// Using sender() or QtScriptable::engine() does not work for classes used by multiple threads (script-engines)
+QScriptValue EntityScriptingInterface::editEntities(QScriptContext* context, QScriptEngine* engine) {
+    const int ARGUMENT_ENTITY_IDS = 0;
+    const int ARGUMENT_PROPERTIES = 1;
+
+    const auto entityIDs = qscriptvalue_cast<QVector<QUuid>>(context->argument(ARGUMENT_ENTITY_IDS));
+    const auto propertiesArgument = context->argument(ARGUMENT_PROPERTIES);
+
+    QVector<EntityItemProperties> propertySets;
+    propertySets.reserve(entityIDs.size());
+    if (propertiesArgument.isArray()) {
+        if (propertiesArgument.property("length").toInt32() != entityIDs.size()) {
+            return context->throwError("Entities.editEntities: properties array must have an item for each entity ID");
+        }
+        for (int i = 0; i < entityIDs.size(); ++i) {
+            propertySets.append(qscriptvalue_cast<EntityItemProperties>(propertiesArgument.property(i)));
+        }
+    } else {
+        // the same edit for all of them, converted from script once
+        propertySets.fill(qscriptvalue_cast<EntityItemProperties>(propertiesArgument), entityIDs.size());
+    }
+
+    auto entityScriptingInterface = DependencyManager::get<EntityScriptingInterface>();
+    return qScriptValueFromSequence(engine, entityScriptingInterface->editEntitiesInternal(entityIDs, propertySets));
+}
+
+QVector<QUuid> EntityScriptingInterface::editEntitiesInternal(const QVector<QUuid>& entityIDs,
+                                                              QVector<EntityItemProperties> propertySets) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    const int numEntities = entityIDs.size();
+    _activityTracking.editedEntityCount += numEntities;
 
     const auto sessionID = DependencyManager::get<NodeList>()->getSessionUUID();
 
-    EntityItemProperties properties = scriptSideProperties;
+    QVector<QUuid> editedIDs;
+    editedIDs.reserve(numEntities);
 
-    EntityItemID entityID(id);
     if (!_entityTree) {
-        properties.setLastEditedBy(sessionID);
-        queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-        return id;
+        for (int i = 0; i < numEntities; ++i) {
+            propertySets[i].setLastEditedBy(sessionID);
+            queueEntityMessage(PacketType::EntityEdit, entityIDs[i], propertySets[i]);
+            editedIDs.append(entityIDs[i]);
+        }
+        return editedIDs;
     }
 
-    EntityItemPointer entity(nullptr);
-    SimulationOwner simulationOwner;
+    std::vector<EntityItemPointer> entities(numEntities);
+    std::vector<SimulationOwner> simulationOwners(numEntities);
     _entityTree->withReadLock([&] {
-        // make a copy of entity for local logic outside of tree lock
-        entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (!entity) {
-            return;
-        }
+        for (int i = 0; i < numEntities; ++i) {
+            // make a copy of entity for local logic outside of tree lock
+            auto entity = _entityTree->findEntityByEntityItemID(EntityItemID(entityIDs[i]));
+            entities[i] = entity;
+            if (!entity) {
+                continue;
+            }
 
-        if (entity->isAvatarEntity() && !entity->isMyAvatarEntity()) {
-            // don't edit other avatar's avatarEntities
-            properties = EntityItemProperties();
-            return;
+            if (entity->isAvatarEntity() && !entity->isMyAvatarEntity()) {
+                // don't edit other avatar's avatarEntities
+                propertySets[i] = EntityItemProperties();
+                continue;
+            }
+            // make a copy of simulationOwner for local logic outside of tree lock
+            simulationOwners[i] = entity->getSimulationOwner();
         }
-        // make a copy of simulationOwner for local logic outside of tree lock
-        simulationOwner = entity->getSimulationOwner();
     });
 
-    QString previousUserdata;
-    if (entity) {
-        if (properties.hasTransformOrVelocityChanges() && entity->hasGrabs()) {
-            // if an entity is grabbed, the grab will override any position changes
-            properties.clearTransformOrVelocityChanges();
-        }
-        if (properties.hasSimulationRestrictedChanges()) {
-            if (_bidOnSimulationOwnership) {
-                // flag for simulation ownership, or upgrade existing ownership priority
-                // (actual bids for simulation ownership are sent by the PhysicalEntitySimulation)
-                entity->upgradeScriptSimulationPriority(properties.computeSimulationBidPriority());
-                if (entity->isLocalEntity() || entity->isMyAvatarEntity() || simulationOwner.getID() == sessionID) {
-                    // we own the simulation --> copy ALL restricted properties
-                    properties.copySimulationRestrictedProperties(entity);
-                } else {
-                    // we don't own the simulation but think we would like to
-
-                    uint8_t desiredPriority = entity->getScriptSimulationPriority();
-                    if (desiredPriority < simulationOwner.getPriority()) {
-                        // the priority at which we'd like to own it is not high enough
-                        // --> assume failure and clear all restricted property changes
-                        properties.clearSimulationRestrictedProperties();
-                    } else {
-                        // the priority at which we'd like to own it is high enough to win.
-                        // --> assume success and copy ALL restricted properties
+    std::vector<bool> skipped(numEntities, false);
+    for (int i = 0; i < numEntities; ++i) {
+        auto& properties = propertySets[i];
+        const auto& entity = entities[i];
+        const auto& simulationOwner = simulationOwners[i];
+
+        QString previousUserdata;
+        if (entity) {
+            if (properties.hasTransformOrVelocityChanges() && entity->hasGrabs()) {
+                // if an entity is grabbed, the grab will override any position changes
+                properties.clearTransformOrVelocityChanges();
+            }
+            if (properties.hasSimulationRestrictedChanges()) {
+                if (_bidOnSimulationOwnership) {
+                    // flag for simulation ownership, or upgrade existing ownership priority
+                    // (actual bids for simulation ownership are sent by the PhysicalEntitySimulation)
+                    entity->upgradeScriptSimulationPriority(properties.computeSimulationBidPriority());
+                    if (entity->isLocalEntity() || entity->isMyAvatarEntity() || simulationOwner.getID() == sessionID) {
+                        // we own the simulation --> copy ALL restricted properties
                         properties.copySimulationRestrictedProperties(entity);
+                    } else {
+                        // we don't own the simulation but think we would like to
+
+                        uint8_t desiredPriority = entity->getScriptSimulationPriority();
+                        if (desiredPriority < simulationOwner.getPriority()) {
+                            // the priority at which we'd like to own it is not high enough
+                            // --> assume failure and clear all restricted property changes
+                            properties.clearSimulationRestrictedProperties();
+                        } else {
+                            // the priority at which we'd like to own it is high enough to win.
+                            // --> assume success and copy ALL restricted properties
+                            properties.copySimulationRestrictedProperties(entity);
+                        }
                     }
+                } else if (!simulationOwner.getID().isNull()) {
+                    // someone owns this but not us
+                    // clear restricted properties
+                    properties.clearSimulationRestrictedProperties();
                 }
-            } else if (!simulationOwner.getID().isNull()) {
-                // someone owns this but not us
-                // clear restricted properties
-                properties.clearSimulationRestrictedProperties();
+                // clear the cached simulationPriority level
+                entity->upgradeScriptSimulationPriority(0);
             }
-            // clear the cached simulationPriority level
-            entity->upgradeScriptSimulationPriority(0);
-        }
 
-        // set these to make EntityItemProperties::getScalesWithParent() work correctly
-        entity::HostType entityHostType = entity->getEntityHostType();
-        properties.setEntityHostType(entityHostType);
-        if (entityHostType == entity::HostType::LOCAL) {
-            properties.setCollisionless(true);
-        }
-        properties.setOwningAvatarID(entity->getOwningAvatarID());
+            // set these to make EntityItemProperties::getScalesWithParent() work correctly
+            entity::HostType entityHostType = entity->getEntityHostType();
+            properties.setEntityHostType(entityHostType);
+            if (entityHostType == entity::HostType::LOCAL) {
+                properties.setCollisionless(true);
+            }
+            properties.setOwningAvatarID(entity->getOwningAvatarID());
 
-        // make sure the properties has a type, so that the encode can know which properties to include
-        properties.setType(entity->getType());
+            // make sure the properties has a type, so that the encode can know which properties to include
+            properties.setType(entity->getType());
 
-        previousUserdata = entity->getUserData();
-    } else if (_bidOnSimulationOwnership) {
-        // bail when simulation participants don't know about entity
-        return QUuid();
-    }
-    // TODO: it is possible there is no remaining useful changes in properties and we should bail early.
-    // How to check for this cheaply?
+            previousUserdata = entity->getUserData();
+        } else if (_bidOnSimulationOwnership) {
+            // bail when simulation participants don't know about entity
+            skipped[i] = true;
+            continue;
+        }
+        // TODO: it is possible there is no remaining useful changes in properties and we should bail early.
+        // How to check for this cheaply?
 
-    properties = convertPropertiesFromScriptSemantics(properties, properties.getScalesWithParent());
-    synchronizeEditedGrabProperties(properties, previousUserdata);
-    properties.setLastEditedBy(sessionID);
+        properties = convertPropertiesFromScriptSemantics(properties, properties.getScalesWithParent());
+        synchronizeEditedGrabProperties(properties, previousUserdata);
+        properties.setLastEditedBy(sessionID);
+    }
 
     // done reading and modifying properties --> start write
-    bool updatedEntity = false;
     _entityTree->withWriteLock([&] {
-        updatedEntity = _entityTree->updateEntity(entityID, properties);
+        for (int i = 0; i < numEntities; ++i) {
+            if (!skipped[i]) {
+                _entityTree->updateEntity(EntityItemID(entityIDs[i]), propertySets[i]);
+            }
+        }
     });
 
     // FIXME: We need to figure out a better way to handle this. Allowing these edits to go through potentially
@@ -900,80 +1136,98 @@ QUuid EntityScriptingInterface::editEntity(const QUuid& id, const EntityItemProp
     //     return QUuid();
     // }
 
-    bool hasQueryAACubeRelatedChanges = properties.queryAACubeRelatedPropertyChanged();
     // done writing, send update
     _entityTree->withReadLock([&] {
-        // find the entity again: maybe it was removed since we last found it
-        entity = _entityTree->findEntityByEntityItemID(entityID);
-        if (entity) {
-            uint64_t now = usecTimestampNow();
-            entity->setLastBroadcast(now);
-
-            if (hasQueryAACubeRelatedChanges) {
-                properties.setQueryAACube(entity->getQueryAACube());
-
-                // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
-                // if they've changed.
-                entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
-                    if (descendant->getNestableType() == NestableType::Entity) {
-                        if (descendant->updateQueryAACube()) {
-                            EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
-                            EntityItemProperties newQueryCubeProperties;
-                            newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
-                            newQueryCubeProperties.setLastEdited(properties.getLastEdited());
-                            queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
-                            entityDescendant->setLastBroadcast(now);
+        uint64_t now = usecTimestampNow();
+        for (int i = 0; i < numEntities; ++i) {
+            if (skipped[i]) {
+                continue;
+            }
+            auto& properties = propertySets[i];
+
+            // find the entity again: maybe it was removed since we last found it
+            auto entity = _entityTree->findEntityByEntityItemID(EntityItemID(entityIDs[i]));
+            entities[i] = entity;
+            if (entity) {
+                entity->setLastBroadcast(now);
+
+                if (properties.queryAACubeRelatedPropertyChanged()) {
+                    properties.setQueryAACube(entity->getQueryAACube());
+
+                    // if we've moved an entity with children, check/update the queryAACube of all descendents and tell the server
+                    // if they've changed.
+                    entity->forEachDescendant([&](SpatiallyNestablePointer descendant) {
+                        if (descendant->getNestableType() == NestableType::Entity) {
+                            if (descendant->updateQueryAACube()) {
+                                EntityItemPointer entityDescendant = std::static_pointer_cast<EntityItem>(descendant);
+                                EntityItemProperties newQueryCubeProperties;
+                                newQueryCubeProperties.setQueryAACube(descendant->getQueryAACube());
+                                newQueryCubeProperties.setLastEdited(properties.getLastEdited());
+                                queueEntityMessage(PacketType::EntityEdit, descendant->getID(), newQueryCubeProperties);
+                                entityDescendant->setLastBroadcast(now);
+                            }
                         }
-                    }
-                });
+                    });
+                }
             }
         }
     });
-    if (!entity) {
-        if (hasQueryAACubeRelatedChanges) {
-            // Sometimes ESS don't have the entity they are trying to edit in their local tree.  In this case,
-            // convertPropertiesFromScriptSemantics doesn't get called and local* edits will get dropped.
-            // This is because, on the script side, "position" is in world frame, but in the network
-            // protocol and in the internal data-structures, "position" is "relative to parent".
-            // Compensate here.  The local* versions will get ignored during the edit-packet encoding.
-            if (properties.localPositionChanged()) {
-                properties.setPosition(properties.getLocalPosition());
-            }
-            if (properties.localRotationChanged()) {
-                properties.setRotation(properties.getLocalRotation());
-            }
-            if (properties.localVelocityChanged()) {
-                properties.setVelocity(properties.getLocalVelocity());
-            }
-            if (properties.localAngularVelocityChanged()) {
-                properties.setAngularVelocity(properties.getLocalAngularVelocity());
-            }
-            if (properties.localDimensionsChanged()) {
-                properties.setDimensions(properties.getLocalDimensions());
+
+    for (int i = 0; i < numEntities; ++i) {
+        if (skipped[i]) {
+            continue;
+        }
+        const auto& id = entityIDs[i];
+        auto& properties = propertySets[i];
+
+        if (!entities[i]) {
+            if (properties.queryAACubeRelatedPropertyChanged()) {
+                // Sometimes ESS don't have the entity they are trying to edit in their local tree.  In this case,
+                // convertPropertiesFromScriptSemantics doesn't get called and local* edits will get dropped.
+                // This is because, on the script side, "position" is in world frame, but in the network
+                // protocol and in the internal data-structures, "position" is "relative to parent".
+                // Compensate here.  The local* versions will get ignored during the edit-packet encoding.
+                if (properties.localPositionChanged()) {
+                    properties.setPosition(properties.getLocalPosition());
+                }
+                if (properties.localRotationChanged()) {
+                    properties.setRotation(properties.getLocalRotation());
+                }
+                if (properties.localVelocityChanged()) {
+                    properties.setVelocity(properties.getLocalVelocity());
+                }
+                if (properties.localAngularVelocityChanged()) {
+                    properties.setAngularVelocity(properties.getLocalAngularVelocity());
+                }
+                if (properties.localDimensionsChanged()) {
+                    properties.setDimensions(properties.getLocalDimensions());
+                }
             }
-        }
-        // we've made an edit to an entity we don't know about, or to a non-entity.  If it's a known non-entity,
-        // print a warning and don't send an edit packet to the entity-server.
-        QSharedPointer<SpatialParentFinder> parentFinder = DependencyManager::get<SpatialParentFinder>();
-        if (parentFinder) {
-            bool success;
-            auto nestableWP = parentFinder->find(id, success, static_cast<SpatialParentTree*>(_entityTree.get()));
-            if (success) {
-                auto nestable = nestableWP.lock();
-                if (nestable) {
-                    NestableType nestableType = nestable->getNestableType();
-                    if (nestableType == NestableType::Avatar) {
-                        qCWarning(entities) << "attempted edit on non-entity: " << id << nestable->getName();
-                        return QUuid(); // null script value to indicate failure
+            // we've made an edit to an entity we don't know about, or to a non-entity.  If it's a known non-entity,
+            // print a warning and don't send an edit packet to the entity-server.
+            QSharedPointer<SpatialParentFinder> parentFinder = DependencyManager::get<SpatialParentFinder>();
+            if (parentFinder) {
+                bool success;
+                auto nestableWP = parentFinder->find(id, success, static_cast<SpatialParentTree*>(_entityTree.get()));
+                if (success) {
+                    auto nestable = nestableWP.lock();
+                    if (nestable) {
+                        NestableType nestableType = nestable->getNestableType();
+                        if (nestableType == NestableType::Avatar) {
+                            qCWarning(entities) << "attempted edit on non-entity: " << id << nestable->getName();
+                            continue; // leave it out of the IDs that were edited to indicate failure
+                        }
                     }
                 }
             }
         }
+        // we queue edit packets even if we don't know about the entity.  This is to allow AC agents
+        // to edit entities they know only by ID. Edits queued together are packed into the same packets
+        // until the sender releases them.
+        queueEntityMessage(PacketType::EntityEdit, EntityItemID(id), properties);
+        editedIDs.append(id);
     }
-    // we queue edit packets even if we don't know about the entity.  This is to allow AC agents
-    // to edit entities they know only by ID.
-    queueEntityMessage(PacketType::EntityEdit, entityID, properties);
-    return id;
+    return editedIDs;
 }
 
 void EntityScriptingInterface::deleteEntity(const QUuid& id) {
@@ -1193,6 +1447,22 @@ QVector<QUuid> EntityScriptingInterface::findEntitiesInBox(const glm::vec3& corn
     return result;
 }
 
+QVector<QUuid> EntityScriptingInterface::findZonesContainingPoint(const glm::vec3& point) const {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    QVector<QUuid> result;
+    if (_entityTree) {
+        std::vector<ZoneEntityItemPointer> zones;
+        _entityTree->withReadLock([&] {
+            _entityTree->getZoneIndex().findContainingZones(point, zones);
+        });
+        for (const auto& zone : zones) {
+            result.push_back(zone->getEntityItemID());
+        }
+    }
+    return result;
+}
+
 QVector<QUuid> EntityScriptingInterface::findEntitiesInFrustum(QVariantMap frustum) const {
     PROFILE_RANGE(script_entities, __FUNCTION__);
 
@@ -1287,6 +1557,34 @@ RayToEntityIntersectionResult EntityScriptingInterface::evalRayIntersectionVecto
     return evalRayIntersectionWorker(ray, Octree::Lock, searchFilter, entityIdsToInclude, entityIdsToDiscard);
 }
 
+std::vector<RayToEntityIntersectionResult> EntityScriptingInterface::evalRayIntersectionVectors(const std::vector<PickRay>& rays,
+        PickFilter searchFilter, const QVector<EntityItemID>& entityIdsToInclude,
+        const QVector<EntityItemID>& entityIdsToDiscard) {
+    PROFILE_RANGE(script_entities, __FUNCTION__);
+
+    std::vector<RayToEntityIntersectionResult> results(rays.size());
+    if (_entityTree) {
+        bool accurate = false;
+        auto intersections = _entityTree->evalRayIntersections(rays, entityIdsToInclude, entityIdsToDiscard, searchFilter,
+                                                               Octree::Lock, &accurate);
+        for (size_t i = 0; i < rays.size(); i++) {
+            RayToEntityIntersectionResult& result = results[i];
+            const auto& intersection = intersections[i];
+            result.accurate = accurate;
+            result.entityID = intersection.entityID;
+            result.distance = intersection.distance;
+            result.face = intersection.face;
+            result.surfaceNormal = intersection.surfaceNormal;
+            result.extraInfo = intersection.extraInfo;
+            result.intersects = !result.entityID.isNull();
+            if (result.intersects) {
+                result.intersection = rays[i].origin + (rays[i].direction * result.distance);
+            }
+        }
+    }
+    return results;
+}
+
 RayToEntityIntersectionResult EntityScriptingInterface::evalRayIntersectionWorker(const PickRay& ray,
         Octree::lockType lockType, PickFilter searchFilter, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard) const {
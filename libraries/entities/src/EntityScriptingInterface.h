@@ -191,6 +191,10 @@ public:
 
     RayToEntityIntersectionResult evalRayIntersectionVector(const PickRay& ray, PickFilter searchFilter,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
+    // one result per ray, all the rays are evaluated in one pass over the tree
+    std::vector<RayToEntityIntersectionResult> evalRayIntersectionVectors(const std::vector<PickRay>& rays,
+        PickFilter searchFilter, const QVector<EntityItemID>& entityIdsToInclude,
+        const QVector<EntityItemID>& entityIdsToDiscard);
     ParabolaToEntityIntersectionResult evalParabolaIntersectionVector(const PickParabola& parabola, PickFilter searchFilter,
         const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard);
 
@@ -213,6 +217,51 @@ public:
     static QScriptValue getMultipleEntityProperties(QScriptContext* context, QScriptEngine* engine);
     QScriptValue getMultipleEntityPropertiesInternal(QScriptEngine* engine, QVector<QUuid> entityIDs, const QScriptValue& extendedDesiredProperties);
 
+    /*@jsdoc
+     * Gets properties of multiple entities as one array per property, which is quicker than getting an object per entity
+     * when a script reads the same few properties of many entities. Numeric and vector properties are returned in typed
+     * arrays: <code>position</code>, <code>velocity</code>, <code>angularVelocity</code>, <code>dimensions</code>,
+     * <code>localPosition</code>, <code>localVelocity</code>, <code>localAngularVelocity</code>, <code>gravity</code>,
+     * <code>acceleration</code> and <code>registrationPoint</code> have 3 values per entity in a <code>Float32Array</code>;
+     * <code>rotation</code> and <code>localRotation</code> have 4 (<code>x</code>, <code>y</code>, <code>z</code>,
+     * <code>w</code>); <code>damping</code>, <code>angularDamping</code>, <code>restitution</code>, <code>friction</code>,
+     * <code>density</code>, <code>lifetime</code> and <code>age</code> have 1; and <code>visible</code>,
+     * <code>collisionless</code>, <code>dynamic</code> and <code>locked</code> have 1 in a <code>Uint8Array</code>. Any other
+     * property is returned in an ordinary array of its values.
+     * @function Entities.getMultipleEntityPropertyArrays
+     * @param {Uuid[]} entityIDs - The IDs of the entities to get the properties of.
+     * @param {string[]} propertyNames - The names of the properties to get.
+     * @returns {object} An object with an <code>ids</code> array of the entities that were found, and an array for each of the
+     *     properties with the entities' values in the same order.
+     * @example <caption>Find the highest of the nearby entities.</caption>
+     * var entityIDs = Entities.findEntities(MyAvatar.position, 50);
+     * var arrays = Entities.getMultipleEntityPropertyArrays(entityIDs, ["position"]);
+     * var highest = -1;
+     * for (var i = 0; i < arrays.ids.length; i++) {
+     *     if (highest === -1 || arrays.position[3 * i + 1] > arrays.position[3 * highest + 1]) {
+     *         highest = i;
+     *     }
+     * }
+     */
+    static QScriptValue getMultipleEntityPropertyArrays(QScriptContext* context, QScriptEngine* engine);
+    QScriptValue getMultipleEntityPropertyArraysInternal(QScriptEngine* engine, const QVector<QUuid>& entityIDs,
+                                                         const QStringList& propertyNames);
+
+    /*@jsdoc
+     * Edits multiple entities at once, which takes the entity tree's locks once for all of them rather than once per entity,
+     * and packs their edits together.
+     * @function Entities.editEntities
+     * @param {Uuid[]} entityIDs - The IDs of the entities to edit.
+     * @param {Entities.EntityProperties|Entities.EntityProperties[]} properties - The new property values, either for all of
+     *     the entities or in an array with an item for each of them.
+     * @returns {Uuid[]} The IDs of the entities that were edited.
+     * @example <caption>Hide the nearby entities.</caption>
+     * var entityIDs = Entities.findEntities(MyAvatar.position, 10);
+     * Entities.editEntities(entityIDs, { visible: false });
+     */
+    static QScriptValue editEntities(QScriptContext* context, QScriptEngine* engine);
+    QVector<QUuid> editEntitiesInternal(const QVector<QUuid>& entityIDs, QVector<EntityItemProperties> propertySets);
+
     QUuid addEntityInternal(const EntityItemProperties& properties, entity::HostType entityHostType);
 
 public slots:
@@ -764,6 +813,19 @@ public slots:
     /// this function will not find any models in script engine contexts which don't have access to entities
     Q_INVOKABLE QVector<QUuid> findEntitiesInFrustum(QVariantMap frustum) const;
 
+    /*@jsdoc
+     * Finds all zone entities whose shape contains a point. This is much faster than finding the entities around the point
+     * and testing each of them.
+     * @function Entities.findZonesContainingPoint
+     * @param {Vec3} point - The point to test.
+     * @returns {Uuid[]} An array of the IDs of the zone entities that contain the point. The array is empty if the point
+     *     isn't in any zone.
+     * @example <caption>Report how many zones your avatar is in.</caption>
+     * var zoneIDs = Entities.findZonesContainingPoint(MyAvatar.position);
+     * print("Number of zones: " + zoneIDs.length);
+     */
+    Q_INVOKABLE QVector<QUuid> findZonesContainingPoint(const glm::vec3& point) const;
+
     /*@jsdoc
      * Finds all domain and avatar entities of a particular type that intersect a sphere.
      * <p><strong>Note:</strong> Server entity scripts only find entities that have a server entity script
@@ -11,12 +11,21 @@
 
 #include "EntitySimulation.h"
 
+#include <algorithm>
+
+#include <QtCore/QThreadPool>
+
 #include <AACube.h>
+#include <ParallelFor.h>
 #include <Profile.h>
 
 #include "EntitiesLogging.h"
 #include "MovingEntitiesOperator.h"
 
+// below this many simple kinematic entities they are moved on one thread, and never in chunks smaller than this
+const int MIN_PARALLEL_SIMPLE_KINEMATIC_ENTITIES = 512;
+const size_t MIN_SIMPLE_KINEMATIC_CHUNK_SIZE = 128;
+
 void EntitySimulation::setEntityTree(EntityTreePointer tree) {
     if (_entityTree && _entityTree != tree) {
         _entitiesToSort.clear();
@@ -225,39 +234,94 @@ void EntitySimulation::clearEntities() {
     _nextExpiry = std::numeric_limits<uint64_t>::max();
 }
 
+EntitySimulation::SimpleKinematicMove EntitySimulation::moveSimpleKinematicEntity(const EntityItemPointer& entity,
+                                                                                    uint64_t now) {
+    // The entity-server doesn't know where avatars are, so don't attempt to do simple extrapolation for
+    // children of avatars.  See related code in EntityMotionState::remoteSimulationOutOfSync.
+    bool ancestryIsKnown;
+    entity->getMaximumAACube(ancestryIsKnown);
+    bool hasAvatarAncestor = entity->hasAncestorOfType(NestableType::Avatar);
+
+    bool isMoving = entity->isMovingRelativeToParent();
+    if (isMoving && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
+        entity->simulate(now);
+        entity->updateQueryAACube();
+        return SimpleKinematicMove::MovedAndKeep;
+    }
+    if (!isMoving && ancestryIsKnown && !hasAvatarAncestor) {
+        // HACK: This catches most cases where the entity's QueryAACube (and spatial sorting in the EntityTree)
+        // would otherwise be out of date at conclusion of its "unowned" simpleKinematicMotion.
+        entity->updateQueryAACube();
+        return SimpleKinematicMove::StoppedAndSort;
+    }
+    return SimpleKinematicMove::Stopped;
+}
+
+void EntitySimulation::applySimpleKinematicMove(const EntityItemPointer& entity, SimpleKinematicMove move) {
+    if (move != SimpleKinematicMove::Stopped) {
+        _entitiesToSort.insert(entity);
+    }
+    if (move != SimpleKinematicMove::MovedAndKeep) {
+        // the entity is no longer non-physical-kinematic
+        _simpleKinematicEntities.remove(entity);
+    }
+}
+
 void EntitySimulation::moveSimpleKinematics(uint64_t now) {
     PROFILE_RANGE_EX(simulation_physics, "MoveSimples", 0xffff00ff, (uint64_t)_simpleKinematicEntities.size());
+    if (_parallelSimpleKinematics && _simpleKinematicEntities.size() >= MIN_PARALLEL_SIMPLE_KINEMATIC_ENTITIES &&
+            QThreadPool::globalInstance()->maxThreadCount() > 1) {
+        moveSimpleKinematicsInParallel(now);
+        return;
+    }
+
     SetOfEntities::iterator itemItr = _simpleKinematicEntities.begin();
     while (itemItr != _simpleKinematicEntities.end()) {
         EntityItemPointer entity = *itemItr;
-
-        // The entity-server doesn't know where avatars are, so don't attempt to do simple extrapolation for
-        // children of avatars.  See related code in EntityMotionState::remoteSimulationOutOfSync.
-        bool ancestryIsKnown;
-        entity->getMaximumAACube(ancestryIsKnown);
-        bool hasAvatarAncestor = entity->hasAncestorOfType(NestableType::Avatar);
-
-        bool isMoving = entity->isMovingRelativeToParent();
-        if (isMoving && !entity->getPhysicsInfo() && ancestryIsKnown && !hasAvatarAncestor) {
-            entity->simulate(now);
-            if (ancestryIsKnown && !hasAvatarAncestor) {
-                entity->updateQueryAACube();
-            }
+        SimpleKinematicMove move = moveSimpleKinematicEntity(entity, now);
+        if (move != SimpleKinematicMove::Stopped) {
             _entitiesToSort.insert(entity);
+        }
+        if (move == SimpleKinematicMove::MovedAndKeep) {
             ++itemItr;
         } else {
-            if (!isMoving && ancestryIsKnown && !hasAvatarAncestor) {
-                // HACK: This catches most cases where the entity's QueryAACube (and spatial sorting in the EntityTree)
-                // would otherwise be out of date at conclusion of its "unowned" simpleKinematicMotion.
-                entity->updateQueryAACube();
-                _entitiesToSort.insert(entity);
-            }
             // the entity is no longer non-physical-kinematic
             itemItr = _simpleKinematicEntities.erase(itemItr);
         }
     }
 }
 
+void EntitySimulation::moveSimpleKinematicsInParallel(uint64_t now) {
+    // Entities in a hierarchy tell each other when they move, and read each other's transforms, so only the ones on
+    // their own go in the chunks.
+    std::vector<EntityItemPointer> independent;
+    std::vector<EntityItemPointer> dependent;
+    independent.reserve(_simpleKinematicEntities.size());
+    for (const auto& entity : _simpleKinematicEntities) {
+        if (entity->getParentID().isNull() && !entity->hasChildren()) {
+            independent.push_back(entity);
+        } else {
+            dependent.push_back(entity);
+        }
+    }
+
+    // each range of independent is moved on its own, with the results written to the same range of moves
+    std::vector<SimpleKinematicMove> moves(independent.size());
+    parallelFor(independent.size(), MIN_SIMPLE_KINEMATIC_CHUNK_SIZE, [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            moves[i] = moveSimpleKinematicEntity(independent[i], now);
+        }
+    });
+
+    // the hierarchies only touch their own entities, which aren't in the ranges
+    for (const auto& entity : dependent) {
+        applySimpleKinematicMove(entity, moveSimpleKinematicEntity(entity, now));
+    }
+    for (size_t i = 0; i < independent.size(); i++) {
+        applySimpleKinematicMove(independent[i], moves[i]);
+    }
+}
+
 void EntitySimulation::processDeadEntities() {
     if (_deadEntitiesToRemoveFromTree.empty()) {
         return;
@@ -73,6 +73,13 @@ public:
 
     void moveSimpleKinematics(uint64_t now);
 
+    // Moves simple kinematic entities on the global thread pool, in chunks, when there are enough of them.  Only entities
+    // without a parent or children are moved in parallel, the others are moved one at a time, and the moved entities are
+    // all sorted in the tree in one pass afterwards.  Off by default, because entity change handlers are called from the
+    // threads doing the moving.
+    void setParallelSimpleKinematics(bool parallel) { _parallelSimpleKinematics = parallel; }
+    bool isParallelSimpleKinematics() const { return _parallelSimpleKinematics; }
+
     EntityTreePointer getEntityTree() { return _entityTree; }
 
     virtual void prepareEntityForDelete(EntityItemPointer entity);
@@ -99,6 +106,15 @@ protected:
 private:
     void moveSimpleKinematics();
 
+    enum class SimpleKinematicMove : uint8_t {
+        MovedAndKeep,       // still moving
+        StoppedAndSort,     // stopped, with a query cube that might be out of date
+        Stopped
+    };
+    static SimpleKinematicMove moveSimpleKinematicEntity(const EntityItemPointer& entity, uint64_t now);
+    void applySimpleKinematicMove(const EntityItemPointer& entity, SimpleKinematicMove move);
+    void moveSimpleKinematicsInParallel(uint64_t now);
+
     // We maintain multiple lists, each for its distinct purpose.
     // An entity may be in more than one list.
     std::unordered_set<EntityItemPointer> _changedEntities; // all changes this frame
@@ -106,6 +122,7 @@ private:
     SetOfEntities _entitiesToUpdate; // entities that need to call EntityItem::update()
     SetOfEntities _mortalEntities; // entities that have an expiry
     uint64_t _nextExpiry;
+    bool _parallelSimpleKinematics { false };
 
     // back pointer to EntityTree structure
     EntityTreePointer _entityTree;
@@ -12,8 +12,11 @@
 //
 
 #include "EntityTree.h"
+#include <algorithm>
+#include <limits>
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
+#include <QtCore/QThreadPool>
 #include <openssl/err.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
@@ -27,11 +30,17 @@
 #include <QtScript/QScriptEngine>
 
 #include <Extents.h>
+#include <MemoryAccounting.h>
+#include <OctreeEntitiesFileParser.h>
+#include <OctreeJournal.h>
+#include <OctreeSnapshot.h>
+#include <ParallelFor.h>
 #include <PerfStat.h>
 #include <Profile.h>
 #include <AddressManager.h>
 
 #include "EntitySimulation.h"
+#include "EntityTreeBVH.h"
 #include "VariantMapToScriptValue.h"
 
 #include "AddEntityOperator.h"
@@ -78,7 +87,7 @@ void EntityTree::createRootElement() {
 }
 
 OctreeElementPointer EntityTree::createNewElement(unsigned char* octalCode) {
-    auto newElement = EntityTreeElementPointer(new EntityTreeElement(octalCode));
+    auto newElement = EntityTreeElement::create(octalCode);
     newElement->setTree(std::static_pointer_cast<EntityTree>(shared_from_this()));
     return std::static_pointer_cast<OctreeElement>(newElement);
 }
@@ -114,6 +123,19 @@ void EntityTree::eraseDomainAndNonOwnedEntities() {
             }
         }
         _entityMap.swap(savedEntities);
+
+        if (auto pickBVH = getPickBVH()) {
+            pickBVH->clear();
+            for (const auto& entity : _entityMap) {
+                pickBVH->addEntity(entity);
+            }
+        }
+        _zoneIndex.clear();
+        for (const auto& entity : _entityMap) {
+            if (entity->getType() == EntityTypes::Zone) {
+                _zoneIndex.addZone(entity);
+            }
+        }
     });
 
     resetClientEditStats();
@@ -142,6 +164,10 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     }
     QHash<EntityItemID, EntityItemPointer> localMap;
     localMap.swap(_entityMap);
+    if (auto pickBVH = getPickBVH()) {
+        pickBVH->clear();
+    }
+    _zoneIndex.clear();
     this->withWriteLock([&] {
         foreach(EntityItemPointer entity, localMap) {
             EntityTreeElementPointer element = entity->getElement();
@@ -159,6 +185,7 @@ void EntityTree::eraseAllOctreeElements(bool createNewRoot) {
     });
     localMap.clear();
     Octree::eraseAllOctreeElements(createNewRoot);
+    _queryCache.clear();
 
     resetClientEditStats();
     clearDeletedEntities();
@@ -173,15 +200,17 @@ void EntityTree::readBitstreamToTree(const unsigned char* bitstream,
             uint64_t bufferSizeBytes, ReadBitstreamToTreeParams& args) {
     Octree::readBitstreamToTree(bitstream, bufferSizeBytes, args);
 
-    // add entities
-    QHash<EntityItemID, EntityItemPointer>::const_iterator itr;
-    for (itr = _entitiesToAdd.constBegin(); itr != _entitiesToAdd.constEnd(); ++itr) {
-        const EntityItemPointer& entityItem = itr.value();
-        AddEntityOperator theOperator(getThisPointer(), entityItem);
-        recurseTreeWithOperator(&theOperator);
-        postAddEntity(entityItem);
+    // add entities, with one pass down the tree for all of them, since a packet or a scene bundle section can hold many
+    if (!_entitiesToAdd.isEmpty()) {
+        std::vector<EntityItemPointer> entitiesToAdd;
+        entitiesToAdd.reserve(_entitiesToAdd.size());
+        for (auto itr = _entitiesToAdd.constBegin(); itr != _entitiesToAdd.constEnd(); ++itr) {
+            entitiesToAdd.push_back(itr.value());
+        }
+        _entitiesToAdd.clear();
+        placeEntities(entitiesToAdd);
+        postAddEntities(entitiesToAdd);
     }
-    _entitiesToAdd.clear();
 
     // move entities
     if (_entityMover.hasMovingEntities()) {
@@ -291,27 +320,34 @@ bool EntityTree::handlesEditPacketType(PacketType packetType) const {
 /// Adds a new entity item to the tree
 void EntityTree::postAddEntity(EntityItemPointer entity) {
     assert(entity);
+    postAddEntities({ entity });
+}
 
-    if (getIsServer()) {
-        addCertifiedEntityOnServer(entity);
-    }
+void EntityTree::postAddEntities(const std::vector<EntityItemPointer>& entities) {
+    for (const auto& entity : entities) {
+        if (getIsServer()) {
+            addCertifiedEntityOnServer(entity);
+        }
 
-    // check to see if we need to simulate this entity..
-    if (_simulation) {
-        _simulation->addEntity(entity);
-    }
+        // check to see if we need to simulate this entity..
+        if (_simulation) {
+            _simulation->addEntity(entity);
+        }
 
-    if (!entity->getParentID().isNull()) {
-        addToNeedsParentFixupList(entity);
+        if (!entity->getParentID().isNull()) {
+            addToNeedsParentFixupList(entity);
+        }
     }
 
     _isDirty = true;
 
-    // find and hook up any entities with this entity as a (previously) missing parent
+    // find and hook up any entities with these entities as a (previously) missing parent
     fixupNeedsParentFixups();
 
-    emit addingEntity(entity->getEntityItemID());
-    emit addingEntityPointer(entity.get());
+    for (const auto& entity : entities) {
+        emit addingEntity(entity->getEntityItemID());
+        emit addingEntityPointer(entity.get());
+    }
 }
 
 bool EntityTree::updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode) {
@@ -465,6 +501,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         }
         UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, newQueryAACube);
         recurseTreeWithOperator(&theOperator);
+        entityQueryAACubeChanged(entity, newQueryAACube);
         if (entity->setProperties(properties)) {
             emit editingEntityPointer(entity);
         }
@@ -499,6 +536,7 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
 
             UpdateEntityOperator theChildOperator(getThisPointer(), childContainingElement, childEntity, queryCube);
             recurseTreeWithOperator(&theChildOperator);
+            entityQueryAACubeChanged(childEntity, queryCube);
             foreach (SpatiallyNestablePointer childChild, childEntity->getChildren()) {
                 if (childChild && childChild->getNestableType() == NestableType::Entity) {
                     toProcess.enqueue(childChild);
@@ -536,10 +574,169 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         return false;
     }
 
+    journalEntityChanged(entity->getEntityItemID());
     return true;
 }
 
 EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone, const bool isImport) {
+    EntityItemPointer result = constructNewEntity(entityID, properties, isClone, isImport);
+    if (result) {
+        // Recurse the tree and store the entity in the correct tree element
+        AddEntityOperator theOperator(getThisPointer(), result);
+        recurseTreeWithOperator(&theOperator);
+        postAddEntity(result);
+        journalEntityChanged(entityID);
+    }
+    return result;
+}
+
+namespace {
+
+// the most entities read from a file that are held as properties to add them together
+const int MAX_ENTITIES_PER_BULK_ADD = 1024;
+
+struct BulkAddEntry {
+    uint64_t mortonCode;
+    AABox box;
+    EntityItemPointer entity;
+};
+
+// Interleaves the bits of the box's minimum corner, a level of the octree at a time. Sorting by it puts the entities
+// below each element next to each other, depth first, so they can be placed with one pass down the tree.
+uint64_t mortonCodeFor(const AABox& box) {
+    const int BITS_PER_AXIS = 21;
+    const uint32_t MAX_CELL = (1 << BITS_PER_AXIS) - 1;
+    const float CELLS_PER_METER = (float)(1 << BITS_PER_AXIS) / (float)TREE_SCALE;
+
+    glm::vec3 cell = (box.getCorner() + glm::vec3((float)HALF_TREE_SCALE)) * CELLS_PER_METER;
+    uint32_t x = std::min((uint32_t)std::max(cell.x, 0.0f), MAX_CELL);
+    uint32_t y = std::min((uint32_t)std::max(cell.y, 0.0f), MAX_CELL);
+    uint32_t z = std::min((uint32_t)std::max(cell.z, 0.0f), MAX_CELL);
+
+    uint64_t code = 0;
+    for (int bit = BITS_PER_AXIS - 1; bit >= 0; bit--) {
+        code = (code << 3) | (((x >> bit) & 1) << 2) | (((y >> bit) & 1) << 1) | ((z >> bit) & 1);
+    }
+    return code;
+}
+
+// places the entries, which are all inside the element, in the element or below it
+void addEntitiesBelow(EntityTree& tree, const EntityTreeElementPointer& element,
+                      std::vector<BulkAddEntry>::iterator begin, std::vector<BulkAddEntry>::iterator end) {
+    // the entries that best fit this element stay here, as in AddEntityOperator, and the rest keep their order
+    auto childEntriesBegin = std::stable_partition(begin, end, [&](const BulkAddEntry& entry) {
+        return element->bestFitBounds(entry.box);
+    });
+    for (auto entry = begin; entry != childEntriesBegin; ++entry) {
+        tree.addEntityMapEntry(entry->entity);
+        element->addEntityItem(entry->entity);
+    }
+
+    // an entry that doesn't best fit here is inside one child, which is the one containing its minimum corner
+    auto childIndexOf = [&](const BulkAddEntry& entry) {
+        return element->getMyChildContainingPoint(entry.box.getCorner());
+    };
+    auto runBegin = childEntriesBegin;
+    while (runBegin != end) {
+        int childIndex = childIndexOf(*runBegin);
+        auto runEnd = std::find_if(runBegin + 1, end, [&](const BulkAddEntry& entry) {
+            return childIndexOf(entry) != childIndex;
+        });
+
+        // boxes that meet a child's boundary can split a child's run in two, which just visits that child twice
+        OctreeElementPointer child = element->getChildAtIndex(childIndex);
+        if (!child) {
+            child = element->addChildAtIndex(childIndex);
+        }
+        addEntitiesBelow(tree, std::static_pointer_cast<EntityTreeElement>(child), runBegin, runEnd);
+        runBegin = runEnd;
+    }
+
+    element->markWithChangedTime();
+}
+
+}
+
+std::vector<EntityItemPointer> EntityTree::addEntities(std::vector<std::pair<EntityItemID, EntityItemProperties>>& entities,
+                                                       bool isClone, const bool isImport) {
+    std::vector<EntityItemPointer> result;
+    result.reserve(entities.size());
+    std::vector<EntityItemPointer> added;
+    added.reserve(entities.size());
+    QSet<EntityItemID> newIDs;
+
+    for (const auto& entity : entities) {
+        EntityItemPointer newEntity;
+        if (newIDs.contains(entity.first)) {
+            qCWarning(entities) << "EntityTree::addEntities() with the same entityID more than once, entityID=" << entity.first;
+        } else {
+            newEntity = constructNewEntity(entity.first, entity.second, isClone, isImport);
+        }
+
+        if (newEntity) {
+            newIDs.insert(entity.first);
+            added.push_back(newEntity);
+        }
+        result.push_back(newEntity);
+    }
+
+    if (added.empty()) {
+        return result;
+    }
+
+    placeEntities(added);
+
+    // every entity is in the tree before any are announced, so parents in the same batch are found in one fixup
+    for (const auto& entity : added) {
+        journalEntityChanged(entity->getEntityItemID());
+    }
+    postAddEntities(added);
+
+    return result;
+}
+
+void EntityTree::placeEntities(const std::vector<EntityItemPointer>& entities) {
+    std::vector<BulkAddEntry> entries;
+    entries.reserve(entities.size());
+    for (const auto& entity : entities) {
+        bool success;
+        AABox box = entity->getQueryAACube(success).clamp((float)(-HALF_TREE_SCALE), (float)HALF_TREE_SCALE);
+        entries.push_back({ mortonCodeFor(box), box, entity });
+    }
+
+    std::stable_sort(entries.begin(), entries.end(), [](const BulkAddEntry& a, const BulkAddEntry& b) {
+        return a.mortonCode < b.mortonCode;
+    });
+    addEntitiesBelow(*this, getRoot(), entries.begin(), entries.end());
+}
+
+bool EntityTree::addEntitiesFromFile(std::vector<std::pair<EntityItemID, EntityItemProperties>>& entities, bool isClone,
+                                     const bool isImport, QMap<QUuid, QVector<QUuid>>& cloneIDs,
+                                     std::vector<EntityItemID>* addedIDs) {
+    bool success = true;
+    std::vector<EntityItemPointer> added = addEntities(entities, isClone, isImport);
+    for (size_t i = 0; i < added.size(); i++) {
+        const EntityItemPointer& entity = added[i];
+        if (!entity) {
+            qCDebug(entities) << "adding Entity failed:" << entities[i].first << entities[i].second.getType();
+            success = false;
+            continue;
+        }
+
+        if (addedIDs) {
+            addedIDs->push_back(entity->getEntityItemID());
+        }
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        }
+    }
+    entities.clear();
+    return success;
+}
+
+EntityItemPointer EntityTree::constructNewEntity(const EntityItemID& entityID, const EntityItemProperties& properties,
+                                                 bool isClone, const bool isImport) {
     EntityItemProperties props = properties;
 
     auto nodeList = DependencyManager::get<NodeList>();
@@ -574,14 +771,8 @@ EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const Enti
     EntityTypes::EntityType type = props.getType();
     EntityItemPointer result = EntityTypes::constructEntityItem(type, entityID, props);
 
-    if (result) {
-        if (recordCreationTime) {
-            result->recordCreationTime();
-        }
-        // Recurse the tree and store the entity in the correct tree element
-        AddEntityOperator theOperator(getThisPointer(), result);
-        recurseTreeWithOperator(&theOperator);
-        postAddEntity(result);
+    if (result && recordCreationTime) {
+        result->recordCreationTime();
     }
     return result;
 }
@@ -766,6 +957,7 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
         EntityItemPointer theEntity = details.entity;
         if (getIsServer()) {
             removeCertifiedEntityOnServer(theEntity);
+            journalEntityErased(theEntity->getEntityItemID());
 
             // set up the deleted entities ID
             QWriteLocker recentlyDeletedEntitiesLocker(&_recentlyDeletedEntitiesLock);
@@ -866,7 +1058,17 @@ EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm:
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&]{
-        recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        auto pickBVH = getPickBVH();
+        if (pickBVH) {
+            pickBVH->findRayIntersection(origin, direction, distance, [&](const EntityItemPointer& entity, float& entityDistance) {
+                if (EntityTreeElement::evalEntityRayIntersection(entity, origin, direction, args.viewFrustumPos, element,
+                        entityDistance, face, surfaceNormal, entityIdsToInclude, entityIdsToDiscard, searchFilter, extraInfo)) {
+                    args.entityID = entity->getEntityItemID();
+                }
+            });
+        } else {
+            recurseTreeWithOperationSorted(evalRayIntersectionOp, evalRayIntersectionSortingOp, &args);
+        }
     }, requireLock);
 
     if (accurateResult) {
@@ -876,6 +1078,53 @@ EntityItemID EntityTree::evalRayIntersection(const glm::vec3& origin, const glm:
     return args.entityID;
 }
 
+std::vector<EntityTree::RayIntersection> EntityTree::evalRayIntersections(const std::vector<PickRay>& rays,
+                                    const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+                                    PickFilter searchFilter, Octree::lockType lockType, bool* accurateResult) {
+    std::vector<RayIntersection> intersections(rays.size());
+    glm::vec3 viewFrustumPos = BillboardModeHelpers::getPrimaryViewFrustumPosition();
+
+    bool requireLock = lockType == Octree::Lock;
+    bool lockResult = withReadLock([&] {
+        auto pickBVH = getPickBVH();
+        if (!pickBVH) {
+            for (size_t i = 0; i < rays.size(); i++) {
+                RayIntersection& intersection = intersections[i];
+                OctreeElementPointer element;
+                intersection.entityID = evalRayIntersection(rays[i].origin, rays[i].direction, entityIdsToInclude,
+                    entityIdsToDiscard, searchFilter, element, intersection.distance, intersection.face,
+                    intersection.surfaceNormal, intersection.extraInfo, Octree::NoLock);
+            }
+            return;
+        }
+
+        std::vector<EntityTreeBVH::Ray> bvhRays;
+        bvhRays.reserve(rays.size());
+        for (const auto& ray : rays) {
+            bvhRays.push_back({ ray.origin, ray.direction });
+        }
+        std::vector<float> distances(rays.size(), FLT_MAX);
+        OctreeElementPointer element;
+        pickBVH->findRayIntersections(bvhRays, distances, [&](const EntityItemPointer& entity, size_t rayIndex, float& distance) {
+            RayIntersection& intersection = intersections[rayIndex];
+            if (EntityTreeElement::evalEntityRayIntersection(entity, rays[rayIndex].origin, rays[rayIndex].direction,
+                    viewFrustumPos, element, distance, intersection.face, intersection.surfaceNormal, entityIdsToInclude,
+                    entityIdsToDiscard, searchFilter, intersection.extraInfo)) {
+                intersection.entityID = entity->getEntityItemID();
+            }
+        });
+        for (size_t i = 0; i < rays.size(); i++) {
+            intersections[i].distance = distances[i];
+        }
+    }, requireLock);
+
+    if (accurateResult) {
+        *accurateResult = lockResult; // if user asked to accuracy or result, let them know this is accurate
+    }
+
+    return intersections;
+}
+
 class ParabolaArgs {
 public:
     // Inputs
@@ -946,7 +1195,20 @@ EntityItemID EntityTree::evalParabolaIntersection(const PickParabola& parabola,
 
     bool requireLock = lockType == Octree::Lock;
     bool lockResult = withReadLock([&] {
-        recurseTreeWithOperationSorted(evalParabolaIntersectionOp, evalParabolaIntersectionSortingOp, &args);
+        auto pickBVH = getPickBVH();
+        if (pickBVH) {
+            glm::vec3 normal = EntityTreeElement::getParabolaPlaneNormal(parabola.velocity, parabola.acceleration);
+            pickBVH->findParabolaIntersection(parabola.origin, parabola.velocity, parabola.acceleration, parabolicDistance,
+                    [&](const EntityItemPointer& entity, float& entityDistance) {
+                if (EntityTreeElement::evalEntityParabolaIntersection(entity, parabola.origin, parabola.velocity,
+                        parabola.acceleration, args.viewFrustumPos, normal, element, entityDistance, face, surfaceNormal,
+                        entityIdsToInclude, entityIdsToDiscard, searchFilter, extraInfo)) {
+                    args.entityID = entity->getEntityItemID();
+                }
+            });
+        } else {
+            recurseTreeWithOperationSorted(evalParabolaIntersectionOp, evalParabolaIntersectionSortingOp, &args);
+        }
     }, requireLock);
 
     if (accurateResult) {
@@ -1010,9 +1272,17 @@ bool evalClosestEntityOperation(const OctreeElementPointer& element, void* extra
 
 // NOTE: assumes caller has handled locking
 QUuid EntityTree::evalClosestEntity(const glm::vec3& position, float targetRadius, PickFilter searchFilter) {
-    FindClosestEntityArgs args = { position, targetRadius, searchFilter, QUuid(), FLT_MAX };
-    recurseTreeWithOperation(evalClosestEntityOperation, &args);
-    return args.closestEntity;
+    QVector<QUuid> closestEntity;
+    auto query = EntityQueryCache::sphereQuery(EntityQueryCache::CLOSEST, position, targetRadius, searchFilter);
+    withQueryCache(query, closestEntity, [&](QVector<QUuid>& result) {
+        FindClosestEntityArgs args = { position, targetRadius, searchFilter, QUuid(), FLT_MAX };
+        recurseTreeWithOperation(evalClosestEntityOperation, &args);
+        result.clear();
+        if (!args.closestEntity.isNull()) {
+            result.push_back(args.closestEntity);
+        }
+    });
+    return closestEntity.isEmpty() ? QUuid() : closestEntity.front();
 }
 
 class FindEntitiesInSphereArgs {
@@ -1044,9 +1314,12 @@ bool evalInSphereOperation(const OctreeElementPointer& element, void* extraData)
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereOperation, &args);
-    foundEntities.swap(args.entities);
+    auto query = EntityQueryCache::sphereQuery(EntityQueryCache::SPHERE, center, radius, searchFilter);
+    withQueryCache(query, foundEntities, [&](QVector<QUuid>& result) {
+        FindEntitiesInSphereArgs args = { center, radius, searchFilter, QVector<QUuid>() };
+        recurseTreeWithOperation(evalInSphereOperation, &args);
+        result.swap(args.entities);
+    });
 }
 
 class FindEntitiesInSphereWithTypeArgs {
@@ -1079,9 +1352,13 @@ bool evalInSphereWithTypeOperation(const OctreeElementPointer& element, void* ex
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
-    foundEntities.swap(args.entities);
+    auto query = EntityQueryCache::sphereQuery(EntityQueryCache::SPHERE_WITH_TYPE, center, radius, searchFilter);
+    query.entityType = type;
+    withQueryCache(query, foundEntities, [&](QVector<QUuid>& result) {
+        FindEntitiesInSphereWithTypeArgs args = { center, radius, type, searchFilter, QVector<QUuid>() };
+        recurseTreeWithOperation(evalInSphereWithTypeOperation, &args);
+        result.swap(args.entities);
+    });
 }
 
 class FindEntitiesInSphereWithNameArgs {
@@ -1115,9 +1392,14 @@ bool evalInSphereWithNameOperation(const OctreeElementPointer& element, void* ex
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInSphereWithName(const glm::vec3& center, float radius, const QString& name, bool caseSensitive, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
-    foundEntities.swap(args.entities);
+    auto query = EntityQueryCache::sphereQuery(EntityQueryCache::SPHERE_WITH_NAME, center, radius, searchFilter);
+    query.name = name;
+    query.caseSensitive = caseSensitive;
+    withQueryCache(query, foundEntities, [&](QVector<QUuid>& result) {
+        FindEntitiesInSphereWithNameArgs args = { center, radius, name, caseSensitive, searchFilter, QVector<QUuid>() };
+        recurseTreeWithOperation(evalInSphereWithNameOperation, &args);
+        result.swap(args.entities);
+    });
 }
 
 class FindEntitiesInCubeArgs {
@@ -1142,9 +1424,12 @@ bool findInCubeOperation(const OctreeElementPointer& element, void* extraData) {
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInCube(const AACube& cube, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
-    recurseTreeWithOperation(findInCubeOperation, &args);
-    foundEntities.swap(args.entities);
+    auto query = EntityQueryCache::boxQuery(EntityQueryCache::CUBE, cube.getCorner(), glm::vec3(cube.getScale()), searchFilter);
+    withQueryCache(query, foundEntities, [&](QVector<QUuid>& result) {
+        FindEntitiesInCubeArgs args { cube, searchFilter, QVector<QUuid>() };
+        recurseTreeWithOperation(findInCubeOperation, &args);
+        result.swap(args.entities);
+    });
 }
 
 class FindEntitiesInBoxArgs {
@@ -1169,11 +1454,14 @@ bool findInBoxOperation(const OctreeElementPointer& element, void* extraData) {
 
 // NOTE: assumes caller has handled locking
 void EntityTree::evalEntitiesInBox(const AABox& box, PickFilter searchFilter, QVector<QUuid>& foundEntities) {
-    FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
-    // NOTE: This should use recursion, since this is a spatial operation
-    recurseTreeWithOperation(findInBoxOperation, &args);
-    // swap the two lists of entity pointers instead of copy
-    foundEntities.swap(args.entities);
+    auto query = EntityQueryCache::boxQuery(EntityQueryCache::BOX, box.getCorner(), box.getScale(), searchFilter);
+    withQueryCache(query, foundEntities, [&](QVector<QUuid>& result) {
+        FindEntitiesInBoxArgs args { box, searchFilter, QVector<QUuid>() };
+        // NOTE: This should use recursion, since this is a spatial operation
+        recurseTreeWithOperation(findInBoxOperation, &args);
+        // swap the two lists of entity pointers instead of copy
+        result.swap(args.entities);
+    });
 }
 
 class FindEntitiesInFrustumArgs {
@@ -1803,14 +2091,13 @@ void EntityTree::processChallengeOwnershipPacket(ReceivedMessage& message, const
 // NOTE: Caller must lock the tree before calling this.
 int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                      const SharedNodePointer& senderNode) {
+    MemoryAccounting::Scope memoryScope(MemoryTag::Entities);
     if (!getIsServer()) {
         qCWarning(entities) << "EntityTree::processEditPacketData() should only be called on a server tree.";
         return 0;
     }
 
     int processedBytes = 0;
-    bool isAdd = false;
-    bool isClone = false;
     // we handle these types of "edit" packets
     switch (message.getType()) {
         case PacketType::EntityErase: {
@@ -1820,312 +2107,405 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
         }
 
         case PacketType::EntityClone:
-            isClone = true; // fall through to next case
-            // FALLTHRU
         case PacketType::EntityAdd:
-            isAdd = true;  // fall through to next case
-            // FALLTHRU
         case PacketType::EntityPhysics:
         case PacketType::EntityEdit: {
-            quint64 startDecode = 0, endDecode = 0;
-            quint64 startLookup = 0, endLookup = 0;
-            quint64 startUpdate = 0, endUpdate = 0;
-            quint64 startCreate = 0, endCreate = 0;
-            quint64 startFilter = 0, endFilter = 0;
-            quint64 startLogging = 0, endLogging = 0;
-
-            bool suppressDisallowedClientScript = false;
-            bool suppressDisallowedServerScript = false;
-            bool suppressDisallowedPrivateUserData = false;
-            bool isPhysics = message.getType() == PacketType::EntityPhysics;
-
-            _totalEditMessages++;
-
-            EntityItemID entityItemID;
-            EntityItemProperties properties;
-            startDecode = usecTimestampNow();
-
-            bool validEditPacket = false;
-            EntityItemID entityIDToClone;
-            EntityItemPointer entityToClone;
-            if (isClone) {
-                QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
-                validEditPacket = EntityItemProperties::decodeCloneEntityMessage(buffer, processedBytes, entityIDToClone, entityItemID);
-                if (validEditPacket) {
-                    entityToClone = findEntityByEntityItemID(entityIDToClone);
-                    if (entityToClone) {
-                        properties = entityToClone->getProperties();
-                    }
-                }
-            } else {
-                validEditPacket = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, processedBytes, entityItemID, properties);
-            }
+            PreparedEntityEdit edit;
+            decodeEntityEdit(message.getType(), editData, maxLength, senderNode, edit);
+            lookUpEditedEntity(edit);
+            validateEntityEdit(edit, senderNode);
+            applyEntityEdit(edit, message.getType(), senderNode);
+            processedBytes = edit.bytesRead;
+            break;
+        }
 
-            endDecode = usecTimestampNow();
+        default:
+            processedBytes = 0;
+            break;
+    }
+    return processedBytes;
+}
 
-            EntityItemPointer existingEntity;
-            if (!isAdd) {
-                // search for the entity by EntityItemID
-                startLookup = usecTimestampNow();
-                existingEntity = findEntityByEntityItemID(entityItemID);
-                endLookup = usecTimestampNow();
-                if (!existingEntity) {
-                    // this is not an add-entity operation, and we don't know about the identified entity.
-                    validEditPacket = false;
-                }
-            }
+bool EntityTree::canPrepareEditPacketType(PacketType packetType) const {
+    switch (packetType) {
+        case PacketType::EntityClone:
+        case PacketType::EntityAdd:
+        case PacketType::EntityPhysics:
+        case PacketType::EntityEdit:
+            return getIsServer();
+        default:
+            return false;
+    }
+}
+
+Octree::PreparedEditPointer EntityTree::decodeEdit(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                                   const SharedNodePointer& senderNode) {
+    auto edit = new PreparedEntityEdit();
+    decodeEntityEdit(message.getType(), editData, maxLength, senderNode, *edit);
+    return PreparedEditPointer(edit);
+}
+
+void EntityTree::editsDecoded(const std::vector<PreparedEdit*>& edits) {
+    // an edit can only be checked ahead of the others if none of the edits before it in the batch touch its entity,
+    // otherwise it has to wait until they are applied
+    QHash<EntityItemID, int> editsPerEntity;
+    for (auto edit : edits) {
+        auto& entityEdit = static_cast<PreparedEntityEdit&>(*edit);
+        if (entityEdit.isValid) {
+            ++editsPerEntity[entityEdit.entityItemID];
+        }
+    }
+    for (auto edit : edits) {
+        auto& entityEdit = static_cast<PreparedEntityEdit&>(*edit);
+        // clones copy the properties of an entity that may itself be edited in the batch
+        entityEdit.mustValidateInOrder = entityEdit.isClone || editsPerEntity.value(entityEdit.entityItemID) > 1;
+    }
+}
 
-            if (validEditPacket && !_entityScriptSourceWhitelist.isEmpty()) {
+void EntityTree::validateEdit(PreparedEdit& edit, const SharedNodePointer& senderNode) {
+    auto& entityEdit = static_cast<PreparedEntityEdit&>(edit);
+    if (entityEdit.mustValidateInOrder) {
+        return;
+    }
+    withReadLock([&] {
+        lookUpEditedEntity(entityEdit);
+        // an edit of an entity that isn't there yet may be for one added since the batch was decoded
+        if (entityEdit.isAdd || entityEdit.existingEntity) {
+            validateEntityEdit(entityEdit, senderNode);
+        }
+    });
+}
 
-                bool wasDeletedBecauseOfClientScript = false;
+// NOTE: Caller must lock the tree before calling this.
+void EntityTree::applyEdit(PreparedEdit& edit, ReceivedMessage& message, const SharedNodePointer& senderNode) {
+    auto& entityEdit = static_cast<PreparedEntityEdit&>(edit);
+    if (entityEdit.isValidated && entityEdit.existingEntity && !entityEdit.existingEntity->getElement()) {
+        // the entity was deleted after the edit was checked
+        entityEdit.isValid = false;
+    } else if (!entityEdit.isValidated) {
+        lookUpEditedEntity(entityEdit);
+        validateEntityEdit(entityEdit, senderNode);
+    }
+    applyEntityEdit(entityEdit, message.getType(), senderNode);
+}
 
-                // check the client entity script to make sure its URL is in the whitelist
-                if (!properties.getScript().isEmpty()) {
-                    bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
+void EntityTree::decodeEntityEdit(PacketType packetType, const unsigned char* editData, int maxLength,
+                                  const SharedNodePointer& senderNode, PreparedEntityEdit& edit) {
+    edit.isClone = packetType == PacketType::EntityClone;
+    edit.isAdd = edit.isClone || packetType == PacketType::EntityAdd;
+    edit.isPhysics = packetType == PacketType::EntityPhysics;
+
+    quint64 startDecode = usecTimestampNow();
+    if (edit.isClone) {
+        QByteArray buffer = QByteArray::fromRawData(reinterpret_cast<const char*>(editData), maxLength);
+        edit.isValid = EntityItemProperties::decodeCloneEntityMessage(buffer, edit.bytesRead, edit.entityIDToClone,
+                                                                      edit.entityItemID);
+    } else {
+        EntityEditEncoding encoding;
+        edit.isValid = EntityItemProperties::decodeEntityEditPacket(editData, maxLength, edit.bytesRead, edit.entityItemID,
+                                                                    edit.properties, &encoding);
+        if (edit.isValid && !_editDeltaDecoder.decode(senderNode ? senderNode->getUUID() : QUuid(), edit.entityItemID,
+                                                      encoding, edit.properties, usecTimestampNow())) {
+            // the rest of the edit still applies
+            qCDebug(entities) << "Dropping motion deltas against an unknown keyframe for" << edit.entityItemID;
+        }
+    }
+    edit.decodeTime = usecTimestampNow() - startDecode;
+}
 
-                    if (!clientScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set entity script not on whitelist, edit rejected";
-                        }
+void EntityTree::lookUpEditedEntity(PreparedEntityEdit& edit) {
+    if (!edit.isValid) {
+        return;
+    }
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                            validEditPacket = false;
-                            wasDeletedBecauseOfClientScript = true;
-                        } else {
-                            suppressDisallowedClientScript = true;
-                        }
-                    }
-                }
+    if (edit.isClone) {
+        edit.entityToClone = findEntityByEntityItemID(edit.entityIDToClone);
+        if (edit.entityToClone) {
+            edit.properties = edit.entityToClone->getProperties();
+        }
+    }
+
+    if (!edit.isAdd) {
+        // search for the entity by EntityItemID
+        quint64 startLookup = usecTimestampNow();
+        edit.existingEntity = findEntityByEntityItemID(edit.entityItemID);
+        edit.lookupTime = usecTimestampNow() - startLookup;
+    }
+}
 
-                // check all server entity scripts to make sure their URLs are in the whitelist
-                if (!properties.getServerScripts().isEmpty()) {
-                    bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+void EntityTree::validateEntityEdit(PreparedEntityEdit& edit, const SharedNodePointer& senderNode) {
+    edit.isValidated = true;
 
-                    if (!serverScriptPassedWhitelist) {
-                        if (wantEditLogging()) {
-                            qCDebug(entities) << "User [" << senderNode->getUUID()
-                                << "] attempting to set server entity script not on whitelist, edit rejected";
-                        }
+    EntityItemProperties& properties = edit.properties;
+    const EntityItemID& entityItemID = edit.entityItemID;
+    bool isAdd = edit.isAdd;
 
-                        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
-                        if (isAdd) {
-                            // Make sure we didn't already need to send back a delete because the client script failed
-                            // the whitelist check
-                            if (!wasDeletedBecauseOfClientScript) {
-                                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                                validEditPacket = false;
-                            }
-                        } else {
-                            suppressDisallowedServerScript = true;
-                        }
-                    }
-                }
-            }
+    if (!isAdd && !edit.existingEntity) {
+        // this is not an add-entity operation, and we don't know about the identified entity.
+        edit.isValid = false;
+    }
+
+    if (edit.isValid && !_entityScriptSourceWhitelist.isEmpty()) {
+
+        bool wasDeletedBecauseOfClientScript = false;
+
+        // check the client entity script to make sure its URL is in the whitelist
+        if (!properties.getScript().isEmpty()) {
+            bool clientScriptPassedWhitelist = isScriptInWhitelist(properties.getScript());
 
-            if (!properties.getPrivateUserData().isEmpty() && validEditPacket && !senderNode->getCanGetAndSetPrivateUserData()) {
+            if (!clientScriptPassedWhitelist) {
                 if (wantEditLogging()) {
                     qCDebug(entities) << "User [" << senderNode->getUUID()
-                        << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+                        << "] attempting to set entity script not on whitelist, edit rejected";
                 }
 
                 // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
                 if (isAdd) {
                     QWriteLocker locker(&_recentlyDeletedEntitiesLock);
                     _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    validEditPacket = false;
+                    edit.isValid = false;
+                    wasDeletedBecauseOfClientScript = true;
                 } else {
-                    suppressDisallowedPrivateUserData = true;
+                    edit.suppressDisallowedClientScript = true;
                 }
             }
+        }
 
-            if (!isClone) {
-                if ((isAdd || properties.lifetimeChanged()) &&
-                    ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
-                    (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
-                    // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
-                    if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
-                        properties.getLifetime() > _maxTmpEntityLifetime) {
-                        properties.setLifetime(_maxTmpEntityLifetime);
-                        bumpTimestamp(properties);
-                    }
+        // check all server entity scripts to make sure their URLs are in the whitelist
+        if (!properties.getServerScripts().isEmpty()) {
+            bool serverScriptPassedWhitelist = isScriptInWhitelist(properties.getServerScripts());
+
+            if (!serverScriptPassedWhitelist) {
+                if (wantEditLogging()) {
+                    qCDebug(entities) << "User [" << senderNode->getUUID()
+                        << "] attempting to set server entity script not on whitelist, edit rejected";
                 }
 
-                if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
-                    // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
-                    // clear the locked property and allow the unlocked entity to be created.
-                    properties.setLocked(false);
-                    bumpTimestamp(properties);
+                // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+                if (isAdd) {
+                    // Make sure we didn't already need to send back a delete because the client script failed
+                    // the whitelist check
+                    if (!wasDeletedBecauseOfClientScript) {
+                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+                        edit.isValid = false;
+                    }
+                } else {
+                    edit.suppressDisallowedServerScript = true;
                 }
             }
+        }
+    }
 
-            // If we got a valid edit packet, then it could be a new entity or it could be an update to
-            // an existing entity... handle appropriately
-            if (validEditPacket) {
-                startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-                if (!allowed) {
-                    // the update failed and we need to convey that fact to the sender
-                    // our method is to re-assert the current properties and bump the lastEdited timestamp
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
-                }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
-                }
-                endFilter = usecTimestampNow();
+    if (!properties.getPrivateUserData().isEmpty() && edit.isValid && !senderNode->getCanGetAndSetPrivateUserData()) {
+        if (wantEditLogging()) {
+            qCDebug(entities) << "User [" << senderNode->getUUID()
+                << "] is attempting to set private user data but user isn't allowed; edit rejected...";
+        }
 
-                if (existingEntity && !isAdd) {
+        // If this was an add, we also want to tell the client that sent this edit that the entity was not added.
+        if (isAdd) {
+            QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+            _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            edit.isValid = false;
+        } else {
+            edit.suppressDisallowedPrivateUserData = true;
+        }
+    }
 
-                    if (suppressDisallowedClientScript) {
-                        bumpTimestamp(properties);
-                        properties.setScript(existingEntity->getScript());
-                    }
+    if (!edit.isClone) {
+        if ((isAdd || properties.lifetimeChanged()) &&
+            ((!senderNode->getCanRez() && senderNode->getCanRezTmp()) ||
+            (!senderNode->getCanRezCertified() && senderNode->getCanRezTmpCertified()))) {
+            // this node is only allowed to rez temporary entities.  if need be, cap the lifetime.
+            if (properties.getLifetime() == ENTITY_ITEM_IMMORTAL_LIFETIME ||
+                properties.getLifetime() > _maxTmpEntityLifetime) {
+                properties.setLifetime(_maxTmpEntityLifetime);
+                bumpTimestamp(properties);
+            }
+        }
 
-                    if (suppressDisallowedServerScript) {
-                        bumpTimestamp(properties);
-                        properties.setServerScripts(existingEntity->getServerScripts());
-                    }
+        if (isAdd && properties.getLocked() && !senderNode->isAllowedEditor()) {
+            // if a node can't change locks, don't allow it to create an already-locked entity -- automatically
+            // clear the locked property and allow the unlocked entity to be created.
+            properties.setLocked(false);
+            bumpTimestamp(properties);
+        }
+    }
+
+    if (edit.isValid) {
+        quint64 startFilter = usecTimestampNow();
+        bool wasChanged = false;
+        // Having (un)lock rights bypasses the filter, unless it's a physics result.
+        FilterType filterType = edit.isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+        edit.isAllowed = (!edit.isPhysics && senderNode->isAllowedEditor()) ||
+            filterProperties(edit.existingEntity, properties, properties, wasChanged, filterType);
+        if (!edit.isAllowed) {
+            // the update failed and we need to convey that fact to the sender
+            // our method is to re-assert the current properties and bump the lastEdited timestamp
+            auto timestamp = properties.getLastEdited();
+            properties = EntityItemProperties();
+            properties.setLastEdited(timestamp);
+        }
+        if (!edit.isAllowed || wasChanged) {
+            bumpTimestamp(properties);
+            // For now, free ownership on any modification.
+            properties.clearSimulationOwner();
+        }
+        edit.filterTime = usecTimestampNow() - startFilter;
+    }
+}
+
+// NOTE: Caller must lock the tree before calling this.
+void EntityTree::applyEntityEdit(PreparedEntityEdit& edit, PacketType packetType, const SharedNodePointer& senderNode) {
+    quint64 startUpdate = 0, endUpdate = 0;
+    quint64 startCreate = 0, endCreate = 0;
+    quint64 startLogging = 0, endLogging = 0;
+
+    EntityItemProperties& properties = edit.properties;
+    const EntityItemID& entityItemID = edit.entityItemID;
+    const EntityItemID& entityIDToClone = edit.entityIDToClone;
+    const EntityItemPointer& existingEntity = edit.existingEntity;
+    bool isAdd = edit.isAdd;
+    bool isClone = edit.isClone;
+
+    _totalEditMessages++;
+
+    // If we got a valid edit packet, then it could be a new entity or it could be an update to
+    // an existing entity... handle appropriately
+    if (edit.isValid) {
+        if (existingEntity && !isAdd) {
+
+            if (edit.suppressDisallowedClientScript) {
+                bumpTimestamp(properties);
+                properties.setScript(existingEntity->getScript());
+            }
+
+            if (edit.suppressDisallowedServerScript) {
+                bumpTimestamp(properties);
+                properties.setServerScripts(existingEntity->getServerScripts());
+            }
+
+            if (edit.suppressDisallowedPrivateUserData) {
+                bumpTimestamp(properties);
+                properties.setPrivateUserData(existingEntity->getPrivateUserData());
+            }
+
+            // if the EntityItem exists, then update it
+            startLogging = usecTimestampNow();
+            if (wantEditLogging()) {
+                qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                qCDebug(entities) << "   properties:" << properties;
+            }
+            if (wantTerseEditLogging()) {
+                QList<QString> changedProperties = properties.listChangedProperties();
+                fixupTerseEditLogging(properties, changedProperties);
+                qCDebug(entities) << senderNode->getUUID() << "edit" <<
+                    existingEntity->getDebugName() << changedProperties;
+            }
+            endLogging = usecTimestampNow();
+
+            startUpdate = usecTimestampNow();
+            if (!edit.isPhysics) {
+                properties.setLastEditedBy(senderNode->getUUID());
+            }
+            updateEntity(existingEntity, properties, senderNode);
+            existingEntity->markAsChangedOnServer();
+            endUpdate = usecTimestampNow();
+            _totalUpdates++;
+        } else if (isAdd) {
+            const EntityItemPointer& entityToClone = edit.entityToClone;
+            bool failedAdd = !edit.isAllowed;
+            bool isCertified = !properties.getCertificateID().isEmpty();
+            bool isCloneable = properties.getCloneable();
+            int cloneLimit = properties.getCloneLimit();
+            if (!edit.isAllowed) {
+                qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
+            } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add an uncertified entity with ID:" << entityItemID;
+            } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
+                failedAdd = true;
+                qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
+                    << "] attempted to add a certified entity with ID:" << entityItemID;
+            } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
+            } else if (isClone && !isCloneable) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
+            } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
+                failedAdd = true;
+                qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
+            } else {
+                if (isClone) {
+                    properties.convertToCloneProperties(entityIDToClone);
+                }
 
-                    if (suppressDisallowedPrivateUserData) {
-                        bumpTimestamp(properties);
-                        properties.setPrivateUserData(existingEntity->getPrivateUserData());
+                // this is a new entity... assign a new entityID
+                properties.setLastEditedBy(senderNode->getUUID());
+                startCreate = usecTimestampNow();
+                EntityItemPointer newEntity = addEntity(entityItemID, properties);
+                endCreate = usecTimestampNow();
+                _totalCreates++;
+
+                if (newEntity && isCertified && getIsServer()) {
+                    if (!properties.verifyStaticCertificateProperties()) {
+                        qCDebug(entities) << "User" << senderNode->getUUID()
+                            << "attempted to add a certified entity with ID" << entityItemID << "which failed"
+                            << "static certificate verification.";
+                        // Delete the entity we just added if it doesn't pass static certificate verification
+                        deleteEntity(entityItemID, true);
+                    } else {
+                        validatePop(properties.getCertificateID(), entityItemID, senderNode);
                     }
+                }
+
+                if (newEntity && isClone) {
+                    entityToClone->addCloneID(newEntity->getEntityItemID());
+                    newEntity->setCloneOriginID(entityIDToClone);
+                }
+
+                if (newEntity) {
+                    newEntity->markAsChangedOnServer();
+                    notifyNewlyCreatedEntity(*newEntity, senderNode);
 
-                    // if the EntityItem exists, then update it
                     startLogging = usecTimestampNow();
                     if (wantEditLogging()) {
-                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] editing entity. ID:" << entityItemID;
+                        qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
+                                          << newEntity->getEntityItemID();
                         qCDebug(entities) << "   properties:" << properties;
                     }
                     if (wantTerseEditLogging()) {
                         QList<QString> changedProperties = properties.listChangedProperties();
                         fixupTerseEditLogging(properties, changedProperties);
-                        qCDebug(entities) << senderNode->getUUID() << "edit" <<
-                            existingEntity->getDebugName() << changedProperties;
+                        qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
                     }
                     endLogging = usecTimestampNow();
 
-                    startUpdate = usecTimestampNow();
-                    if (!isPhysics) {
-                        properties.setLastEditedBy(senderNode->getUUID());
-                    }
-                    updateEntity(existingEntity, properties, senderNode);
-                    existingEntity->markAsChangedOnServer();
-                    endUpdate = usecTimestampNow();
-                    _totalUpdates++;
-                } else if (isAdd) {
-                    bool failedAdd = !allowed;
-                    bool isCertified = !properties.getCertificateID().isEmpty();
-                    bool isCloneable = properties.getCloneable();
-                    int cloneLimit = properties.getCloneLimit();
-                    if (!allowed) {
-                        qCDebug(entities) << "Filtered entity add. ID:" << entityItemID;
-                    } else if (!isClone && !isCertified && !senderNode->getCanRez() && !senderNode->getCanRezTmp()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'uncertified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add an uncertified entity with ID:" << entityItemID;
-                    } else if (!isClone && isCertified && !senderNode->getCanRezCertified() && !senderNode->getCanRezTmpCertified()) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User without 'certified rez rights' [" << senderNode->getUUID()
-                            << "] attempted to add a certified entity with ID:" << entityItemID;
-                    } else if (isClone && isCertified && !properties.getCertificateType().contains(DOMAIN_UNLIMITED)) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone certified entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && !isCloneable) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone non-cloneable entity from entity ID:" << entityIDToClone;
-                    } else if (isClone && entityToClone && entityToClone->getCloneIDs().size() >= cloneLimit && cloneLimit != 0) {
-                        failedAdd = true;
-                        qCDebug(entities) << "User attempted to clone entity ID:" << entityIDToClone << " which reached it's cloneable limit.";
-                    } else {
-                        if (isClone) {
-                            properties.convertToCloneProperties(entityIDToClone);
-                        }
+                } else {
+                    failedAdd = true;
+                    qCDebug(entities) << "Add entity failed ID:" << entityItemID;
+                }
+            }
+            if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
+                QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+                _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
+            }
+        } else {
+            HIFI_FCDEBUG(entities(), "Edit failed. [" << packetType <<"] " <<
+                    "entity id:" << entityItemID <<
+                    "existingEntity pointer:" << existingEntity.get());
+        }
+    }
 
-                        // this is a new entity... assign a new entityID
-                        properties.setLastEditedBy(senderNode->getUUID());
-                        startCreate = usecTimestampNow();
-                        EntityItemPointer newEntity = addEntity(entityItemID, properties);
-                        endCreate = usecTimestampNow();
-                        _totalCreates++;
-
-                        if (newEntity && isCertified && getIsServer()) {
-                            if (!properties.verifyStaticCertificateProperties()) {
-                                qCDebug(entities) << "User" << senderNode->getUUID()
-                                    << "attempted to add a certified entity with ID" << entityItemID << "which failed"
-                                    << "static certificate verification.";
-                                // Delete the entity we just added if it doesn't pass static certificate verification
-                                deleteEntity(entityItemID, true);
-                            } else {
-                                validatePop(properties.getCertificateID(), entityItemID, senderNode);
-                            }
-                        }
-
-                        if (newEntity && isClone) {
-                            entityToClone->addCloneID(newEntity->getEntityItemID());
-                            newEntity->setCloneOriginID(entityIDToClone);
-                        }
-
-                        if (newEntity) {
-                            newEntity->markAsChangedOnServer();
-                            notifyNewlyCreatedEntity(*newEntity, senderNode);
-                            
-                            startLogging = usecTimestampNow();
-                            if (wantEditLogging()) {
-                                qCDebug(entities) << "User [" << senderNode->getUUID() << "] added entity. ID:"
-                                                  << newEntity->getEntityItemID();
-                                qCDebug(entities) << "   properties:" << properties;
-                            }
-                            if (wantTerseEditLogging()) {
-                                QList<QString> changedProperties = properties.listChangedProperties();
-                                fixupTerseEditLogging(properties, changedProperties);
-                                qCDebug(entities) << senderNode->getUUID() << "add" << entityItemID << changedProperties;
-                            }
-                            endLogging = usecTimestampNow();
-
-                        } else {
-                            failedAdd = true;
-                            qCDebug(entities) << "Add entity failed ID:" << entityItemID;
-                        }
-                    }
-                    if (failedAdd) { // Let client know it failed, so that they don't have an entity that no one else sees.
-                        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
-                        _recentlyDeletedEntityItemIDs.insert(usecTimestampNow(), entityItemID);
-                    }
-                } else {
-                    HIFI_FCDEBUG(entities(), "Edit failed. [" << message.getType() <<"] " <<
-                            "entity id:" << entityItemID << 
-                            "existingEntity pointer:" << existingEntity.get());
-                }
-            }
-
-
-            _totalDecodeTime += endDecode - startDecode;
-            _totalLookupTime += endLookup - startLookup;
-            _totalUpdateTime += endUpdate - startUpdate;
-            _totalCreateTime += endCreate - startCreate;
-            _totalLoggingTime += endLogging - startLogging;
-            _totalFilterTime += endFilter - startFilter;
-
-            break;
-        }
-
-        default:
-            processedBytes = 0;
-            break;
-    }
-    return processedBytes;
+    _totalDecodeTime += edit.decodeTime;
+    _totalLookupTime += edit.lookupTime;
+    _totalUpdateTime += endUpdate - startUpdate;
+    _totalCreateTime += endCreate - startCreate;
+    _totalLoggingTime += endLogging - startLogging;
+    _totalFilterTime += edit.filterTime;
 }
 
 
@@ -2159,6 +2539,37 @@ void EntityTree::releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncod
     extraEncodeData->clear();
 }
 
+void EntityTree::invalidateQueryCache(const AABox& region) {
+    if (!EntityQueryCache::isEnabled()) {
+        return;
+    }
+    if (_queryCache.isEmpty()) {
+        _queryCache.clear();
+    } else {
+        _queryCache.invalidate(region);
+    }
+}
+
+void EntityTree::invalidateQueryCache(const EntityItem& entity, const EntityTreeElementPointer& element) {
+    if (!EntityQueryCache::isEnabled()) {
+        return;
+    }
+    if (_queryCache.isEmpty()) {
+        _queryCache.clear();
+        return;
+    }
+    // the entity was somewhere in its element before the change, and is within its maximum cube after it
+    AABox region(element->getAACube());
+    bool success;
+    AACube entityCube = entity.getMaximumAACube(success);
+    if (!success) {
+        _queryCache.clear();
+        return;
+    }
+    region += AABox(entityCube);
+    _queryCache.invalidate(region);
+}
+
 void EntityTree::entityChanged(EntityItemPointer entity) {
     if (entity->isSimulated()) {
         _simulation->changeEntity(entity);
@@ -2329,6 +2740,7 @@ void EntityTree::preUpdate() {
 }
 
 void EntityTree::update(bool simulate) {
+    MemoryAccounting::Scope memoryScope(MemoryTag::Entities);
     PROFILE_RANGE(simulation_physics, "UpdateTree");
     PerformanceTimer perfTimer("updateTree");
     if (simulate && _simulation) {
@@ -2552,19 +2964,68 @@ EntityTreeElementPointer EntityTree::getContainingElement(const EntityItemID& en
 
 void EntityTree::addEntityMapEntry(EntityItemPointer entity) {
     EntityItemID id = entity->getEntityItemID();
-    QWriteLocker locker(&_entityMapLock);
-    EntityItemPointer otherEntity = _entityMap.value(id);
-    if (otherEntity) {
-        qCWarning(entities) << "EntityTree::addEntityMapEntry() found pre-existing id " << id;
-        assert(false);
-        return;
+    {
+        QWriteLocker locker(&_entityMapLock);
+        EntityItemPointer otherEntity = _entityMap.value(id);
+        if (otherEntity) {
+            qCWarning(entities) << "EntityTree::addEntityMapEntry() found pre-existing id " << id;
+            assert(false);
+            return;
+        }
+        _entityMap.insert(id, entity);
+    }
+    // a BVH published since the insert already has the entity, adding it again is harmless
+    if (auto pickBVH = getPickBVH()) {
+        pickBVH->addEntity(entity);
+    }
+    if (entity->getType() == EntityTypes::Zone) {
+        _zoneIndex.addZone(entity);
     }
-    _entityMap.insert(id, entity);
 }
 
 void EntityTree::clearEntityMapEntry(const EntityItemID& id) {
-    QWriteLocker locker(&_entityMapLock);
-    _entityMap.remove(id);
+    {
+        QWriteLocker locker(&_entityMapLock);
+        _entityMap.remove(id);
+    }
+    if (auto pickBVH = getPickBVH()) {
+        pickBVH->removeEntity(id);
+    }
+    _zoneIndex.removeZone(id);
+}
+
+std::shared_ptr<EntityTreeBVH> EntityTree::getPickBVH() const {
+    std::lock_guard<std::mutex> lock(_pickBVHLock);
+    return _pickBVH;
+}
+
+void EntityTree::setPickBVHEnabled(bool enabled) {
+    if (!enabled) {
+        std::lock_guard<std::mutex> lock(_pickBVHLock);
+        _pickBVH.reset();
+        return;
+    }
+    if (getPickBVH()) {
+        return;
+    }
+
+    // hold the map lock until the BVH is published, so an entity added in between can't be missed
+    auto pickBVH = std::make_shared<EntityTreeBVH>();
+    QReadLocker locker(&_entityMapLock);
+    for (const auto& entity : _entityMap) {
+        pickBVH->addEntity(entity);
+    }
+    std::lock_guard<std::mutex> lock(_pickBVHLock);
+    _pickBVH = pickBVH;
+}
+
+void EntityTree::entityQueryAACubeChanged(const EntityItemPointer& entity, const AACube& newQueryAACube) {
+    if (auto pickBVH = getPickBVH()) {
+        pickBVH->updateEntity(entity, newQueryAACube);
+    }
+    if (entity->getType() == EntityTypes::Zone) {
+        _zoneIndex.updateZone(entity->getEntityItemID(), newQueryAACube);
+    }
 }
 
 void EntityTree::debugDumpMap() {
@@ -3068,10 +3529,166 @@ void convertGrabUserDataToProperties(EntityItemProperties& properties) {
 }
 
 
-bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
-    // These are needed to deal with older content (before adding inheritance modes)
-    int contentVersion = map["Version"].toInt();
+namespace {
 
+// QVariantMap --> QScriptValue --> EntityItemProperties, upgrading content written by older versions
+void entityPropertiesFromMap(QVariantMap& entityMap, int contentVersion, const QUuid& myNodeID, QScriptEngine& scriptEngine,
+                             EntityItemID& entityItemID, EntityItemProperties& properties) {
+    QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+    EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+
+    if (entityMap.contains("id")) {
+        entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
+    } else {
+        entityItemID = EntityItemID(QUuid::createUuid());
+    }
+
+    // Convert old clientOnly bool to new entityHostType enum
+    // (must happen before setOwningAvatarID below)
+    if (contentVersion < (int)EntityVersion::EntityHostTypes) {
+        if (entityMap.contains("clientOnly")) {
+            properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        }
+    }
+
+    if (properties.getEntityHostType() == entity::HostType::AVATAR) {
+        properties.setOwningAvatarID(myNodeID);
+    }
+
+    // Fix for older content not containing mode fields in the zones
+    if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
+        // The legacy version had no keylight mode - this is set to on
+        properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+
+        // The ambient URL has been moved from "keyLight" to "ambientLight"
+        if (entityMap.contains("keyLight")) {
+            QVariantMap keyLightObject = entityMap["keyLight"].toMap();
+            properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
+        }
+
+        // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
+        // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
+        properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
+        if (properties.getAmbientLight().getAmbientURL() == "") {
+            if (properties.getSkybox().getURL() != "") {
+                properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
+            } else {
+                properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
+            }
+        }
+
+        // The background should be enabled if the mode is skybox
+        // Note that if the values are default then they are not stored in the JSON file
+        if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
+            properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
+        } else {
+            properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+        }
+    }
+
+    // Convert old materials so that they use materialData instead of userData
+    if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
+        if (properties.getMaterialURL().startsWith("userData")) {
+            QString materialURL = properties.getMaterialURL();
+            properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+
+            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+            QJsonObject materialData;
+            QJsonValue materialVersion = userData["materialVersion"];
+            if (!materialVersion.isNull()) {
+                materialData.insert("materialVersion", materialVersion);
+                userData.remove("materialVersion");
+            }
+            QJsonValue materials = userData["materials"];
+            if (!materials.isNull()) {
+                materialData.insert("materials", materials);
+                userData.remove("materials");
+            }
+
+            properties.setMaterialData(QJsonDocument(materialData).toJson());
+            properties.setUserData(QJsonDocument(userData).toJson());
+        }
+    }
+
+    // Convert old cloneable entities so they use cloneableData instead of userData
+    if (contentVersion < (int)EntityVersion::CloneableData) {
+        QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
+        QJsonObject grabbableKey = userData["grabbableKey"].toObject();
+        QJsonValue cloneable = grabbableKey["cloneable"];
+        if (cloneable.isBool() && cloneable.toBool()) {
+            QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
+            QJsonValue cloneLimit = grabbableKey["cloneLimit"];
+            QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
+            QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+
+            // This is cloneable, we need to convert the properties
+            properties.setCloneable(true);
+            properties.setCloneLifetime(cloneLifetime.toInt());
+            properties.setCloneLimit(cloneLimit.toInt());
+            properties.setCloneDynamic(cloneDynamic.toBool());
+            properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+        }
+    }
+
+    // convert old grab-related userData to new grab properties
+    if (contentVersion < (int)EntityVersion::GrabProperties) {
+        convertGrabUserDataToProperties(properties);
+    }
+
+    // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
+    if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
+        properties.setRadiusSpread(0.0f);
+        properties.setAlphaSpread(0.0f);
+        properties.setColorSpread({0, 0, 0});
+    }
+
+    if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
+        if (entityMap.contains("created")) {
+            quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
+            properties.setCreated(created);
+        }
+    }
+
+    // Before, billboarded entities ignored rotation.  Now, they use it to determine which axis is facing you.
+    if (contentVersion < (int)EntityVersion::AllBillboardMode) {
+        if (properties.getBillboardMode() != BillboardMode::NONE) {
+            properties.setRotation(glm::quat());
+        }
+    }
+}
+
+// the number of entities converted together by readFromParser(), enough to make each task worth its script engine
+const int ENTITY_CONVERSION_BATCH_SIZE = 256;
+
+struct ConvertedEntity {
+    EntityItemID id;
+    EntityItemProperties properties;
+    QString parentJointName; // for wearables, resolved against the avatar by the thread that adds the entity
+};
+using ConvertedEntities = std::vector<ConvertedEntity>;
+
+// called on the pool threads, freeing each entity's JSON once it's converted
+ConvertedEntities convertEntities(std::vector<QJsonObject>& entities, int contentVersion, const QUuid& myNodeID) {
+    // each batch has its own engine, a script engine can't be shared between threads
+    QScriptEngine scriptEngine;
+    ConvertedEntities converted(entities.size());
+    for (size_t i = 0; i < entities.size(); i++) {
+        QVariantMap entityMap = entities[i].toVariantMap();
+        entities[i] = QJsonObject();
+
+        ConvertedEntity& entity = converted[i];
+        if (entityMap.contains("parentJointName") && entityMap.contains("parentID") &&
+            QUuid(entityMap["parentID"].toString()) == AVATAR_SELF_ID) {
+            entity.parentJointName = entityMap["parentJointName"].toString();
+        }
+        entityPropertiesFromMap(entityMap, contentVersion, myNodeID, scriptEngine, entity.id, entity.properties);
+    }
+    return converted;
+}
+
+}
+
+void EntityTree::readPersistInfoFromMap(const QVariantMap& map) {
     if (map.contains("Id")) {
         _persistID = map["Id"].toUuid();
     }
@@ -3089,6 +3706,12 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
             _namedPaths[namedPathName] = namedPathViewPoint;
         }
     }
+}
+
+bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
+    // These are needed to deal with older content (before adding inheritance modes)
+    int contentVersion = map["Version"].toInt();
+    readPersistInfoFromMap(map);
 
     // map will have a top-level list keyed as "Entities".  This will be extracted
     // and iterated over.  Each member of this list is converted to a QVariantMap, then
@@ -3096,6 +3719,8 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
     // to add the new entity to the EntityTree.
     QVariantList entitiesQList = map["Entities"].toList();
     QScriptEngine scriptEngine;
+    auto nodeList = DependencyManager::get<NodeList>();
+    const QUuid myNodeID = nodeList ? nodeList->getSessionUUID() : QUuid();
 
     if (entitiesQList.length() == 0) {
         // Empty map or invalidly formed file.
@@ -3103,6 +3728,7 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
     }
 
     QMap<QUuid, QVector<QUuid>> cloneIDs;
+    std::vector<std::pair<EntityItemID, EntityItemProperties>> entitiesToAdd;
 
     bool success = true;
     foreach (QVariant entityVariant, entitiesQList) {
@@ -3119,145 +3745,352 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
                 " mapped it to parentJointIndex " << entityMap["parentJointIndex"].toInt();
         }
 
-        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
-        EntityItemProperties properties;
-        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
-
-        EntityItemID entityItemID;
-        if (entityMap.contains("id")) {
-            entityItemID = EntityItemID(QUuid(entityMap["id"].toString()));
-        } else {
-            entityItemID = EntityItemID(QUuid::createUuid());
-        }
+        entitiesToAdd.emplace_back();
+        auto& entityToAdd = entitiesToAdd.back();
+        entityPropertiesFromMap(entityMap, contentVersion, myNodeID, scriptEngine, entityToAdd.first, entityToAdd.second);
 
-        // Convert old clientOnly bool to new entityHostType enum
-        // (must happen before setOwningAvatarID below)
-        if (contentVersion < (int)EntityVersion::EntityHostTypes) {
-            if (entityMap.contains("clientOnly")) {
-                properties.setEntityHostType(entityMap["clientOnly"].toBool() ? entity::HostType::AVATAR : entity::HostType::DOMAIN);
+        if ((int)entitiesToAdd.size() >= MAX_ENTITIES_PER_BULK_ADD) {
+            if (!addEntitiesFromFile(entitiesToAdd, isImport, false, cloneIDs)) {
+                success = false;
             }
         }
+    }
+    if (!addEntitiesFromFile(entitiesToAdd, isImport, false, cloneIDs)) {
+        success = false;
+    }
 
-        if (properties.getEntityHostType() == entity::HostType::AVATAR) {
-            auto nodeList = DependencyManager::get<NodeList>();
-            const QUuid myNodeID = nodeList->getSessionUUID();
-            properties.setOwningAvatarID(myNodeID);
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
         }
+    }
 
-        // Fix for older content not containing mode fields in the zones
-        if (contentVersion < (int)EntityVersion::ZoneLightInheritModes && (properties.getType() == EntityTypes::EntityType::Zone)) {
-            // The legacy version had no keylight mode - this is set to on
-            properties.setKeyLightMode(COMPONENT_MODE_ENABLED);
+    return success;
+}
 
-            // The ambient URL has been moved from "keyLight" to "ambientLight"
-            if (entityMap.contains("keyLight")) {
-                QVariantMap keyLightObject = entityMap["keyLight"].toMap();
-                properties.getAmbientLight().setAmbientURL(keyLightObject["ambientURL"].toString());
-            }
+bool EntityTree::readFromParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID, const bool isImport) {
+    // Entities are gathered in batches as they are parsed. Once there's a batch for each pool thread, the batches are
+    // converted to properties in parallel and added here in file order, so only they are ever held as JSON rather than
+    // the whole document.
+    const size_t maxPendingBatches = (size_t)std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+    auto nodeList = DependencyManager::get<NodeList>();
+    const QUuid myNodeID = nodeList ? nodeList->getSessionUUID() : QUuid();
 
-            // Copy the skybox URL if the ambient URL is empty, as this is the legacy behaviour
-            // Use skybox value only if it is not empty, else set ambientMode to inherit (to use default URL)
-            properties.setAmbientLightMode(COMPONENT_MODE_ENABLED);
-            if (properties.getAmbientLight().getAmbientURL() == "") {
-                if (properties.getSkybox().getURL() != "") {
-                    properties.getAmbientLight().setAmbientURL(properties.getSkybox().getURL());
-                } else {
-                    properties.setAmbientLightMode(COMPONENT_MODE_INHERIT);
-                }
+    std::vector<std::vector<QJsonObject>> pendingBatches;
+    std::vector<QJsonObject> batch;
+    QVariantMap header;
+
+    std::vector<EntityItemID> addedIDs;
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    bool success = true;
+
+    auto addBatch = [&](ConvertedEntities& converted) {
+        std::vector<std::pair<EntityItemID, EntityItemProperties>> entitiesToAdd;
+        entitiesToAdd.reserve(converted.size());
+        for (auto& convertedEntity : converted) {
+            // handle parentJointName for wearables
+            if (_myAvatar && !convertedEntity.parentJointName.isEmpty()) {
+                int parentJointIndex = _myAvatar->getJointIndex(convertedEntity.parentJointName);
+                convertedEntity.properties.setParentJointIndex(parentJointIndex);
+
+                qCDebug(entities) << "Found parentJointName " << convertedEntity.parentJointName <<
+                    " mapped it to parentJointIndex " << parentJointIndex;
             }
+            entitiesToAdd.emplace_back(convertedEntity.id, std::move(convertedEntity.properties));
+        }
+        if (!addEntitiesFromFile(entitiesToAdd, isImport, false, cloneIDs, &addedIDs)) {
+            success = false;
+        }
+    };
 
-            // The background should be enabled if the mode is skybox
-            // Note that if the values are default then they are not stored in the JSON file
-            if (entityMap.contains("backgroundMode") && (entityMap["backgroundMode"].toString() == "skybox")) {
-                properties.setSkyboxMode(COMPONENT_MODE_ENABLED);
-            } else {
-                properties.setSkyboxMode(COMPONENT_MODE_INHERIT);
+    auto convertAndAddBatches = [&] {
+        // the header is parsed before any entity is passed on, so the content version is known by now
+        const int contentVersion = header["Version"].toInt();
+        std::vector<ConvertedEntities> converted(pendingBatches.size());
+        parallelFor(pendingBatches.size(), 1, [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                converted[i] = convertEntities(pendingBatches[i], contentVersion, myNodeID);
             }
+        });
+        pendingBatches.clear();
+
+        for (auto& convertedBatch : converted) {
+            addBatch(convertedBatch);
         }
+    };
 
-        // Convert old materials so that they use materialData instead of userData
-        if (contentVersion < (int)EntityVersion::MaterialData && properties.getType() == EntityTypes::EntityType::Material) {
-            if (properties.getMaterialURL().startsWith("userData")) {
-                QString materialURL = properties.getMaterialURL();
-                properties.setMaterialURL(materialURL.replace("userData", "materialData"));
+    auto convertBatch = [&] {
+        pendingBatches.push_back(std::move(batch));
+        batch.clear();
+        if (pendingBatches.size() >= maxPendingBatches) {
+            convertAndAddBatches();
+        }
+    };
 
-                QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-                QJsonObject materialData;
-                QJsonValue materialVersion = userData["materialVersion"];
-                if (!materialVersion.isNull()) {
-                    materialData.insert("materialVersion", materialVersion);
-                    userData.remove("materialVersion");
-                }
-                QJsonValue materials = userData["materials"];
-                if (!materials.isNull()) {
-                    materialData.insert("materials", materials);
-                    userData.remove("materials");
-                }
+    bool parsed = parser.parseEntities(header, [&](QJsonObject& entity) {
+        if (!marketplaceID.isEmpty()) {
+            entity["marketplaceID"] = marketplaceID;
+        }
+        batch.push_back(std::move(entity));
+        if ((int)batch.size() >= ENTITY_CONVERSION_BATCH_SIZE) {
+            convertBatch();
+        }
+        return true;
+    });
 
-                properties.setMaterialData(QJsonDocument(materialData).toJson());
-                properties.setUserData(QJsonDocument(userData).toJson());
-            }
+    if (!parsed) {
+        qCritical() << "Couldn't parse Entities JSON:" << parser.getErrorString().c_str();
+        // like readFromMap(), a file that doesn't parse adds nothing, so take out what was added before the error was found
+        deleteEntitiesByID(addedIDs, true);
+        return false;
+    }
+
+    if (!batch.empty()) {
+        pendingBatches.push_back(std::move(batch));
+    }
+    convertAndAddBatches();
+
+    readPersistInfoFromMap(header);
+
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
         }
+    }
 
-        // Convert old cloneable entities so they use cloneableData instead of userData
-        if (contentVersion < (int)EntityVersion::CloneableData) {
-            QJsonObject userData = QJsonDocument::fromJson(properties.getUserData().toUtf8()).object();
-            QJsonObject grabbableKey = userData["grabbableKey"].toObject();
-            QJsonValue cloneable = grabbableKey["cloneable"];
-            if (cloneable.isBool() && cloneable.toBool()) {
-                QJsonValue cloneLifetime = grabbableKey["cloneLifetime"];
-                QJsonValue cloneLimit = grabbableKey["cloneLimit"];
-                QJsonValue cloneDynamic = grabbableKey["cloneDynamic"];
-                QJsonValue cloneAvatarEntity = grabbableKey["cloneAvatarEntity"];
+    // like readFromMap(), a file without entities is treated as invalid
+    return success && !addedIDs.empty();
+}
+
+bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
+    QScriptEngine scriptEngine;
+    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
+    withReadLock([&] {
+        recurseTreeWithOperator(&theOperator);
+    });
+
+    jsonString = theOperator.getJson();
+    return true;
+}
+
+namespace {
+
+// the wire encoding stores strings and byte arrays with a 16 bit length, so entities with longer free-form
+// properties are kept in snapshots as JSON instead
+const int MAX_SNAPSHOT_ENCODED_LENGTH = std::numeric_limits<uint16_t>::max();
+const int INITIAL_SNAPSHOT_RECORD_SIZE = 16 * 1024;
+const int MAX_SNAPSHOT_RECORD_SIZE = 4 * 1024 * 1024;
 
-                // This is cloneable, we need to convert the properties
-                properties.setCloneable(true);
-                properties.setCloneLifetime(cloneLifetime.toInt());
-                properties.setCloneLimit(cloneLimit.toInt());
-                properties.setCloneDynamic(cloneDynamic.toBool());
-                properties.setCloneAvatarEntity(cloneAvatarEntity.toBool());
+bool isTooLongToEncode(const QString& value) {
+    // a QChar is at most three bytes of UTF-8, so most strings never need converting to find out
+    const int MAX_UTF8_BYTES_PER_CHAR = 3;
+    return value.size() * MAX_UTF8_BYTES_PER_CHAR > MAX_SNAPSHOT_ENCODED_LENGTH &&
+        value.toUtf8().size() > MAX_SNAPSHOT_ENCODED_LENGTH;
+}
+
+bool hasPropertiesTooLongToEncode(const EntityItemProperties& properties) {
+    return isTooLongToEncode(properties.getUserData()) || isTooLongToEncode(properties.getPrivateUserData()) ||
+        isTooLongToEncode(properties.getDescription()) || isTooLongToEncode(properties.getScript()) ||
+        isTooLongToEncode(properties.getServerScripts()) || isTooLongToEncode(properties.getItemDescription()) ||
+        isTooLongToEncode(properties.getText()) || isTooLongToEncode(properties.getTextures()) ||
+        isTooLongToEncode(properties.getModelURL()) || isTooLongToEncode(properties.getImageURL()) ||
+        isTooLongToEncode(properties.getSourceUrl()) || isTooLongToEncode(properties.getMaterialURL()) ||
+        isTooLongToEncode(properties.getMaterialData()) ||
+        properties.getActionData().size() > MAX_SNAPSHOT_ENCODED_LENGTH ||
+        properties.getVoxelData().size() > MAX_SNAPSHOT_ENCODED_LENGTH;
+}
+
+// encodes the entity's complete state as a snapshot record, in buffer
+OctreeSnapshot::Encoding encodeSnapshotRecord(const EntityItemPointer& entity, QScriptEngine& scriptEngine,
+                                              QByteArray& buffer, int& bufferSize) {
+    EntityItemProperties properties = entity->getProperties();
+
+    // like the JSON persist file, a snapshot doesn't keep simulation ownership
+    EncodeBitstreamParams params;
+    EntityPropertyFlags requestedProperties = entity->getEntityProperties(params);
+    requestedProperties -= PROP_SIMULATION_OWNER;
+
+    if (!hasPropertiesTooLongToEncode(properties)) {
+        while (bufferSize <= MAX_SNAPSHOT_RECORD_SIZE) {
+            buffer.resize(bufferSize);
+            EntityPropertyFlags didntFitProperties;
+            OctreeElement::AppendState appendState = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityAdd,
+                entity->getEntityItemID(), properties, buffer, requestedProperties, didntFitProperties);
+            if (appendState == OctreeElement::COMPLETED) {
+                return OctreeSnapshot::Encoding::Properties;
             }
+            bufferSize *= 2;
         }
+    }
 
-        // convert old grab-related userData to new grab properties
-        if (contentVersion < (int)EntityVersion::GrabProperties) {
-            convertGrabUserDataToProperties(properties);
-        }
+    QScriptValue entityScriptValue = EntityItemNonDefaultPropertiesToScriptValue(&scriptEngine, properties);
+    buffer = QJsonDocument::fromVariant(entityScriptValue.toVariant()).toJson(QJsonDocument::Compact);
+    return OctreeSnapshot::Encoding::JSON;
+}
 
-        // Zero out the spread values that were fixed in version ParticleEntityFix so they behave the same as before
-        if (contentVersion < (int)EntityVersion::ParticleEntityFix) {
-            properties.setRadiusSpread(0.0f);
-            properties.setAlphaSpread(0.0f);
-            properties.setColorSpread({0, 0, 0});
+bool decodeSnapshotRecord(const OctreeSnapshot::Record& record, QScriptEngine& scriptEngine,
+                          EntityItemID& entityItemID, EntityItemProperties& properties) {
+    if (record.encoding == OctreeSnapshot::Encoding::Properties) {
+        int processedBytes = 0;
+        return EntityItemProperties::decodeEntityEditPacket((const unsigned char*)record.data, record.size, processedBytes,
+                                                            entityItemID, properties);
+    } else if (record.encoding == OctreeSnapshot::Encoding::JSON) {
+        QJsonDocument entityJSON = QJsonDocument::fromJson(QByteArray::fromRawData(record.data, record.size));
+        QVariantMap entityMap = entityJSON.object().toVariantMap();
+        QScriptValue entityScriptValue = variantMapToScriptValue(entityMap, scriptEngine);
+        EntityItemPropertiesFromScriptValueIgnoreReadOnly(entityScriptValue, properties);
+        entityItemID = EntityItemID(record.id);
+        return true;
+    }
+    return false;
+}
+
+}
+
+bool EntityTree::writeToSnapshot(OctreeSnapshotWriter& writer) {
+    QScriptEngine scriptEngine;
+    QByteArray buffer;
+    int bufferSize = INITIAL_SNAPSHOT_RECORD_SIZE;
+
+    withReadLock([&] {
+        QReadLocker locker(&_entityMapLock);
+        for (const auto& entity : _entityMap) {
+            OctreeSnapshot::Encoding encoding = encodeSnapshotRecord(entity, scriptEngine, buffer, bufferSize);
+            writer.addRecord(entity->getID(), encoding, buffer);
         }
 
-        if (contentVersion < (int)EntityVersion::FixPropertiesFromCleanup) {
-            if (entityMap.contains("created")) {
-                quint64 created = QDateTime::fromString(entityMap["created"].toString().trimmed(), Qt::ISODate).toMSecsSinceEpoch() * 1000;
-                properties.setCreated(created);
+        // everything is in the snapshot now, so a journal that follows it starts from here. Edits need the write
+        // lock, so none can be missed between encoding the entities and clearing their changes.
+        std::lock_guard<std::mutex> lock(_journalMutex);
+        _journalChangedIDs.clear();
+        _journalErasedIDs.clear();
+    });
+    return true;
+}
+
+void EntityTree::setJournalEnabled(bool enabled) {
+    std::lock_guard<std::mutex> lock(_journalMutex);
+    _journalEnabled = enabled;
+    _journalChangedIDs.clear();
+    _journalErasedIDs.clear();
+}
+
+void EntityTree::journalEntityChanged(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_journalMutex);
+    if (_journalEnabled) {
+        _journalErasedIDs.remove(entityID);
+        _journalChangedIDs.insert(entityID);
+    }
+}
+
+void EntityTree::journalEntityErased(const EntityItemID& entityID) {
+    std::lock_guard<std::mutex> lock(_journalMutex);
+    if (_journalEnabled) {
+        _journalChangedIDs.remove(entityID);
+        _journalErasedIDs.insert(entityID);
+    }
+}
+
+bool EntityTree::writeToJournal(OctreeJournalWriter& journal) {
+    QSet<EntityItemID> changedIDs;
+    QSet<EntityItemID> erasedIDs;
+    {
+        std::lock_guard<std::mutex> lock(_journalMutex);
+        changedIDs.swap(_journalChangedIDs);
+        erasedIDs.swap(_journalErasedIDs);
+    }
+    if (changedIDs.isEmpty() && erasedIDs.isEmpty()) {
+        return true;
+    }
+
+    QScriptEngine scriptEngine;
+    QByteArray buffer;
+    int bufferSize = INITIAL_SNAPSHOT_RECORD_SIZE;
+
+    // an entity is journaled as it is now, however many times it was edited since the last batch
+    withReadLock([&] {
+        for (const auto& entityID : changedIDs) {
+            EntityItemPointer entity = findEntityByEntityItemID(entityID);
+            if (entity) {
+                OctreeSnapshot::Encoding encoding = encodeSnapshotRecord(entity, scriptEngine, buffer, bufferSize);
+                journal.addEdit(entityID, encoding, buffer);
+            } else {
+                journal.addErase(entityID);
             }
         }
+    });
+    for (const auto& entityID : erasedIDs) {
+        journal.addErase(entityID);
+    }
+    return true;
+}
+
+bool EntityTree::readFromSnapshot(const OctreeSnapshotReader& reader, const OctreeJournalReader* journal,
+                                  const bool isImport) {
+    _persistID = reader.getPersistID();
+    _persistDataVersion = reader.getDataVersion();
 
-        // Before, billboarded entities ignored rotation.  Now, they use it to determine which axis is facing you.
-        if (contentVersion < (int)EntityVersion::AllBillboardMode) {
-            if (properties.getBillboardMode() != BillboardMode::NONE) {
-                properties.setRotation(glm::quat());
+    // replay the journal over the snapshot's records, so each entity is only added once with its latest state
+    std::vector<OctreeSnapshot::Record> records;
+    records.reserve(reader.getRecordCount());
+    for (int i = 0; i < reader.getRecordCount(); i++) {
+        records.push_back(reader.getRecord(i));
+    }
+    if (journal) {
+        QHash<QUuid, size_t> recordIndices;
+        recordIndices.reserve((int)records.size());
+        for (size_t i = 0; i < records.size(); i++) {
+            recordIndices.insert(records[i].id, i);
+        }
+
+        for (const auto& entry : journal->getEntries()) {
+            auto recordIndex = recordIndices.find(entry.record.id);
+            if (entry.operation == OctreeJournal::Operation::Erase) {
+                if (recordIndex != recordIndices.end()) {
+                    records[recordIndex.value()].data = nullptr;
+                    recordIndices.erase(recordIndex);
+                }
+            } else if (recordIndex != recordIndices.end()) {
+                records[recordIndex.value()] = entry.record;
+            } else {
+                recordIndices.insert(entry.record.id, records.size());
+                records.push_back(entry.record);
             }
         }
+    }
 
-        EntityItemPointer entity = addEntity(entityItemID, properties, isImport);
-        if (!entity) {
-            qCDebug(entities) << "adding Entity failed:" << entityItemID << properties.getType();
+    QScriptEngine scriptEngine;
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    std::vector<std::pair<EntityItemID, EntityItemProperties>> entitiesToAdd;
+
+    bool success = true;
+    int numEntities = 0;
+    for (const auto& record : records) {
+        if (!record.data) {
+            continue; // erased by the journal
+        }
+        numEntities++;
+
+        entitiesToAdd.emplace_back();
+        auto& entityToAdd = entitiesToAdd.back();
+        if (!decodeSnapshotRecord(record, scriptEngine, entityToAdd.first, entityToAdd.second)) {
+            qCDebug(entities) << "Failed to decode snapshot record for entity" << record.id;
+            entitiesToAdd.pop_back();
             success = false;
+            continue;
         }
 
-        if (entity) {
-            const QUuid& cloneOriginID = entity->getCloneOriginID();
-            if (!cloneOriginID.isNull()) {
-                cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        if ((int)entitiesToAdd.size() >= MAX_ENTITIES_PER_BULK_ADD) {
+            if (!addEntitiesFromFile(entitiesToAdd, false, isImport, cloneIDs)) {
+                success = false;
             }
         }
     }
+    if (!addEntitiesFromFile(entitiesToAdd, false, isImport, cloneIDs)) {
+        success = false;
+    }
 
     for (const auto& entityID : cloneIDs.keys()) {
         auto entity = findEntityByID(entityID);
@@ -3266,18 +4099,8 @@ bool EntityTree::readFromMap(QVariantMap& map, const bool isImport) {
         }
     }
 
-    return success;
-}
-
-bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& element) {
-    QScriptEngine scriptEngine;
-    RecurseOctreeToJSONOperator theOperator(element, &scriptEngine, jsonString);
-    withReadLock([&] {
-        recurseTreeWithOperator(&theOperator);
-    });
-
-    jsonString = theOperator.getJson();
-    return true;
+    // matches readFromMap(), which treats a file without entities as invalid
+    return success && numEntities > 0;
 }
 
 void EntityTree::resetClientEditStats() {
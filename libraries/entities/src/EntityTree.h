@@ -12,6 +12,8 @@
 #ifndef hifi_EntityTree_h
 #define hifi_EntityTree_h
 
+#include <cfloat>
+
 #include <QSet>
 #include <QVector>
 
@@ -21,12 +23,16 @@
 #include "AddEntityOperator.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
+#include "EntityEditDeltas.h"
+#include "EntityQueryCache.h"
+#include "ZoneIndex.h"
 #include "MovingEntitiesOperator.h"
 
 class EntityTree;
 using EntityTreePointer = std::shared_ptr<EntityTree>;
 
 class EntitySimulation;
+class EntityTreeBVH;
 
 namespace EntityQueryFilterSymbol {
     static const QString NonDefault = "+";
@@ -62,6 +68,14 @@ public:
 
 
     void setEntityMaxTmpLifetime(float maxTmpEntityLifetime) { _maxTmpEntityLifetime = maxTmpEntityLifetime; }
+
+    // tell the query cache where something changed: an element's contents, or an entity that moved or was edited
+    void invalidateQueryCache(const AABox& region);
+    void invalidateQueryCache(const EntityItem& entity, const EntityTreeElementPointer& element);
+    const EntityQueryCache& getQueryCache() const { return _queryCache; }
+
+    // the zones of the tree, for finding the ones that contain a point
+    ZoneIndex& getZoneIndex() { return _zoneIndex; }
     void setEntityScriptSourceWhitelist(const QString& entityScriptSourceWhitelist);
 
     /// Implements our type specific root element factory
@@ -90,6 +104,12 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual bool canPrepareEditPacketType(PacketType packetType) const override;
+    virtual PreparedEditPointer decodeEdit(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                           const SharedNodePointer& senderNode) override;
+    virtual void editsDecoded(const std::vector<PreparedEdit*>& edits) override;
+    virtual void validateEdit(PreparedEdit& edit, const SharedNodePointer& senderNode) override;
+    virtual void applyEdit(PreparedEdit& edit, ReceivedMessage& message, const SharedNodePointer& senderNode) override;
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) override;
@@ -106,6 +126,27 @@ public:
         float& distance, float& parabolicDistance, BoxFace& face, glm::vec3& surfaceNormal, QVariantMap& extraInfo,
         Octree::lockType lockType = Octree::TryLock, bool* accurateResult = NULL);
 
+    class RayIntersection {
+    public:
+        EntityItemID entityID;
+        float distance { FLT_MAX };
+        BoxFace face { UNKNOWN_FACE };
+        glm::vec3 surfaceNormal;
+        QVariantMap extraInfo;
+    };
+
+    // evaluates several rays that share a filter together, which walks the pick BVH once per packet of rays when it's
+    // enabled, and returns one intersection per ray
+    std::vector<RayIntersection> evalRayIntersections(const std::vector<PickRay>& rays,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        PickFilter searchFilter, Octree::lockType lockType = Octree::TryLock, bool* accurateResult = NULL);
+
+    // Picks walk a bounding volume hierarchy over the entities instead of the octree while this is enabled, see EntityTreeBVH
+    void setPickBVHEnabled(bool enabled);
+    bool isPickBVHEnabled() const { return (bool)getPickBVH(); }
+    // keeps the pick BVH's and zone index's bounds for the entity up to date, called wherever an entity's query cube is re-sorted
+    void entityQueryAACubeChanged(const EntityItemPointer& entity, const AACube& newQueryAACube);
+
     virtual bool rootElementHasData() const override { return true; }
 
     virtual void releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncodeData) const override;
@@ -117,8 +158,15 @@ public:
 
     // The newer API...
     void postAddEntity(EntityItemPointer entityItem);
+    void postAddEntities(const std::vector<EntityItemPointer>& entities);
 
     EntityItemPointer addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone = false, const bool isImport = false);
+    // Adds the entities like addEntity(), but places them all with one pass down the tree and fixes up their parents
+    // once. The result holds the new entity, or null if it couldn't be added, for each of the given entities in turn.
+    std::vector<EntityItemPointer> addEntities(std::vector<std::pair<EntityItemID, EntityItemProperties>>& entities,
+                                               bool isClone = false, const bool isImport = false);
+    // puts new entities, which aren't in the tree yet, in the elements that best fit them with one pass down the tree
+    void placeEntities(const std::vector<EntityItemPointer>& entities);
 
     // use this method if you only know the entityID
     bool updateEntity(const EntityItemID& entityID, const EntityItemProperties& properties, const SharedNodePointer& senderNode = SharedNodePointer(nullptr));
@@ -137,6 +185,8 @@ public:
 
     EntityItemID assignEntityID(const EntityItemID& entityItemID); /// Assigns a known ID for a creator token ID
 
+    // the closest entity and the entities in a sphere, cube or box, answered from the query cache when nothing in the
+    // region changed since the same query was last made
     QUuid evalClosestEntity(const glm::vec3& position, float targetRadius, PickFilter searchFilter);
     void evalEntitiesInSphere(const glm::vec3& center, float radius, PickFilter searchFilter, QVector<QUuid>& foundEntities);
     void evalEntitiesInSphereWithType(const glm::vec3& center, float radius, EntityTypes::EntityType type, PickFilter searchFilter, QVector<QUuid>& foundEntities);
@@ -197,7 +247,13 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) override;
+    virtual bool readFromParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID, const bool isImport) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    virtual bool writeToSnapshot(OctreeSnapshotWriter& writer) override;
+    virtual bool readFromSnapshot(const OctreeSnapshotReader& reader, const OctreeJournalReader* journal = nullptr,
+                                  const bool isImport = false) override;
+    virtual void setJournalEnabled(bool enabled) override;
+    virtual bool writeToJournal(OctreeJournalWriter& journal) override;
 
 
     glm::vec3 getContentsDimensions();
@@ -242,6 +298,8 @@ public:
 
     void knowAvatarID(const QUuid& avatarID);
     void forgetAvatarID(const QUuid& avatarID);
+    // drops the motion keyframes kept for a node's entity edits
+    void forgetEditSender(const QUuid& senderID) { _editDeltaDecoder.removeSender(senderID); }
     void deleteDescendantsOfAvatar(const QUuid& avatarID);
     void removeFromChildrenOfAvatars(EntityItemPointer entity);
 
@@ -297,6 +355,35 @@ signals:
 
 protected:
 
+    // an add, clone or edit of an entity on its way through the steps of processEditPacketData
+    class PreparedEntityEdit : public PreparedEdit {
+    public:
+        bool isAdd { false };
+        bool isClone { false };
+        bool isPhysics { false };
+        bool isValid { false };
+        bool isValidated { false };
+        bool mustValidateInOrder { false };
+        bool isAllowed { true };
+        bool suppressDisallowedClientScript { false };
+        bool suppressDisallowedServerScript { false };
+        bool suppressDisallowedPrivateUserData { false };
+        EntityItemID entityItemID;
+        EntityItemProperties properties;
+        EntityItemID entityIDToClone;
+        EntityItemPointer entityToClone;
+        EntityItemPointer existingEntity;
+        quint64 decodeTime { 0 };
+        quint64 lookupTime { 0 };
+        quint64 filterTime { 0 };
+    };
+
+    void decodeEntityEdit(PacketType packetType, const unsigned char* editData, int maxLength,
+                          const SharedNodePointer& senderNode, PreparedEntityEdit& edit);
+    void lookUpEditedEntity(PreparedEntityEdit& edit);
+    void validateEntityEdit(PreparedEntityEdit& edit, const SharedNodePointer& senderNode);
+    void applyEntityEdit(PreparedEntityEdit& edit, PacketType packetType, const SharedNodePointer& senderNode);
+
     void recursivelyFilterAndCollectForDelete(const EntityItemPointer& entity, std::vector<EntityItemPointer>& entitiesToDelete, bool force) const;
     void processRemovedEntities(const DeleteEntityOperator& theOperator);
     bool updateEntity(EntityItemPointer entity, const EntityItemProperties& properties,
@@ -330,6 +417,31 @@ protected:
     mutable QReadWriteLock _entityMapLock;
     QHash<EntityItemID, EntityItemPointer> _entityMap;
 
+    std::shared_ptr<EntityTreeBVH> getPickBVH() const;
+    mutable std::mutex _pickBVHLock;
+    std::shared_ptr<EntityTreeBVH> _pickBVH;
+
+    // checks the new entity can be added and creates it, without putting it in the tree
+    EntityItemPointer constructNewEntity(const EntityItemID& entityID, const EntityItemProperties& properties,
+                                         bool isClone, const bool isImport);
+
+    // adds entities read from a file with addEntities(), collecting the clones to fix up once all are added, and
+    // empties the list. Returns false if any couldn't be added.
+    bool addEntitiesFromFile(std::vector<std::pair<EntityItemID, EntityItemProperties>>& entities, bool isClone,
+                             const bool isImport, QMap<QUuid, QVector<QUuid>>& cloneIDs,
+                             std::vector<EntityItemID>* addedIDs = nullptr);
+
+    // the Id, DataVersion and Paths of a persist file
+    void readPersistInfoFromMap(const QVariantMap& map);
+
+    // the entities added, edited or erased since the last journal batch, see writeToJournal()
+    void journalEntityChanged(const EntityItemID& entityID);
+    void journalEntityErased(const EntityItemID& entityID);
+    std::mutex _journalMutex;
+    bool _journalEnabled { false };
+    QSet<EntityItemID> _journalChangedIDs;
+    QSet<EntityItemID> _journalErasedIDs;
+
     mutable QReadWriteLock _entityCertificateIDMapLock;
     QHash<QString, QList<EntityItemID>> _entityCertificateIDMap;
 
@@ -342,6 +454,8 @@ protected:
     bool _wantTerseEditLogging = false;
 
 
+    EntityEditDeltaDecoder _editDeltaDecoder;
+
     // some performance tracking properties - only used in server trees
     int _totalEditMessages = 0;
     int _totalUpdates = 0;
@@ -403,6 +517,23 @@ private:
 
     std::map<QString, QString> _namedPaths;
 
+    template <typename F>
+    void withQueryCache(const EntityQueryCache::Query& query, QVector<QUuid>& foundEntities, F&& evalQuery) {
+        if (!EntityQueryCache::isEnabled()) {
+            evalQuery(foundEntities);
+            return;
+        }
+        if (_queryCache.find(query, foundEntities)) {
+            return;
+        }
+        uint64_t changeCount = _queryCache.getChangeCount();
+        evalQuery(foundEntities);
+        _queryCache.insert(query, foundEntities, changeCount);
+    }
+
+    EntityQueryCache _queryCache;
+    ZoneIndex _zoneIndex;
+
     // Return an AACube containing object and all its entity descendants
     AACube updateEntityQueryAACubeWorker(SpatiallyNestablePointer object, EntityEditPacketSender* packetSender,
                                          MovingEntitiesOperator& moveOperator, bool force, bool tellServer);
@@ -0,0 +1,493 @@
+//
+//  EntityTreeBVH.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeBVH.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+
+#include <AABox.h>
+#include <OctreeConstants.h>
+
+namespace {
+
+const uint32_t MAX_LEAF_SIZE = 4;
+// entities added since the last build are checked one by one, past this many it's cheaper to rebuild
+const size_t MAX_UNINDEXED_ENTITIES = 64;
+// refitting keeps the hierarchy correct but loosens it, so rebuild once the entities have moved this many times over
+const size_t MAX_REFITS_PER_ENTITY = 2;
+// the median split keeps the depth at log2 of the leaf count, so this is never reached
+const int TRAVERSAL_STACK_SIZE = 64;
+const size_t PACKET_SIZE = 32; // rays per traversal, one bit each in the active mask
+
+// calculate the reciprocal like this so axis aligned directions don't produce NaNs in the slab test
+glm::vec3 safeReciprocal(const glm::vec3& direction) {
+    return glm::vec3(direction.x == 0.0f ? FLT_MAX : 1.0f / direction.x,
+                     direction.y == 0.0f ? FLT_MAX : 1.0f / direction.y,
+                     direction.z == 0.0f ? FLT_MAX : 1.0f / direction.z);
+}
+
+bool rayEntersBox(const glm::vec3& origin, const glm::vec3& invDirection, const glm::vec3& minimum, const glm::vec3& maximum,
+                  float maxDistance, float& entryDistance) {
+    glm::vec3 t0 = (minimum - origin) * invDirection;
+    glm::vec3 t1 = (maximum - origin) * invDirection;
+    glm::vec3 tNear = glm::min(t0, t1);
+    glm::vec3 tFar = glm::max(t0, t1);
+    entryDistance = glm::max(glm::max(tNear.x, tNear.y), glm::max(tNear.z, 0.0f));
+    float exitDistance = glm::min(glm::min(tFar.x, tFar.y), tFar.z);
+    return entryDistance <= exitDistance && entryDistance < maxDistance;
+}
+
+bool parabolaEntersBox(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
+                       const glm::vec3& minimum, const glm::vec3& maximum, float maxDistance, float& entryDistance) {
+    AABox box(minimum, maximum - minimum);
+    if (box.contains(origin)) {
+        entryDistance = 0.0f;
+        return true;
+    }
+    BoxFace face;
+    glm::vec3 surfaceNormal;
+    return box.findParabolaIntersection(origin, velocity, acceleration, entryDistance, face, surfaceNormal) &&
+        entryDistance < maxDistance;
+}
+
+}
+
+void EntityTreeBVH::addEntity(const EntityItemPointer& entity) {
+    bool success;
+    AACube queryAACube = entity->getQueryAACube(success);
+    withWriteLock([&] {
+        auto itr = _itemIndex.find(entity->getEntityItemID());
+        if (itr != _itemIndex.end()) {
+            Item& item = _items[itr->second];
+            item.entity = entity;
+            setItemBounds(item, queryAACube, success);
+            if (item.leaf != INVALID_INDEX) {
+                refit(item.leaf);
+            }
+            return;
+        }
+
+        uint32_t index = (uint32_t)_items.size();
+        _items.emplace_back();
+        _items.back().entity = entity;
+        setItemBounds(_items.back(), queryAACube, success);
+        _itemIndex[entity->getEntityItemID()] = index;
+        _unindexed.push_back(index);
+    });
+}
+
+void EntityTreeBVH::removeEntity(const EntityItemID& entityID) {
+    withWriteLock([&] {
+        auto itr = _itemIndex.find(entityID);
+        if (itr == _itemIndex.end()) {
+            return;
+        }
+        uint32_t index = itr->second;
+        _itemIndex.erase(itr);
+
+        // the item stays in its leaf until the next build, so the leaf's bounds are still conservative
+        Item& item = _items[index];
+        item.entity.reset();
+        _removedCount++;
+        if (item.leaf == INVALID_INDEX) {
+            _unindexed.erase(std::find(_unindexed.begin(), _unindexed.end(), index));
+        }
+    });
+}
+
+void EntityTreeBVH::updateEntity(const EntityItemPointer& entity, const AACube& queryAACube) {
+    withWriteLock([&] {
+        auto itr = _itemIndex.find(entity->getEntityItemID());
+        if (itr == _itemIndex.end()) {
+            return;
+        }
+        Item& item = _items[itr->second];
+        setItemBounds(item, queryAACube, true);
+        if (item.leaf != INVALID_INDEX) {
+            refit(item.leaf);
+            _refitCount++;
+        }
+    });
+}
+
+void EntityTreeBVH::clear() {
+    withWriteLock([&] {
+        _items.clear();
+        _order.clear();
+        _nodes.clear();
+        _unindexed.clear();
+        _itemIndex.clear();
+        _removedCount = 0;
+        _refitCount = 0;
+    });
+}
+
+size_t EntityTreeBVH::getEntityCount() const {
+    return resultWithReadLock<size_t>([&] {
+        return _itemIndex.size();
+    });
+}
+
+void EntityTreeBVH::setItemBounds(Item& item, const AACube& queryAACube, bool success) {
+    if (success) {
+        AABox box(queryAACube);
+        item.minimum = box.getMinimumPoint();
+        item.maximum = box.getMaximumPoint();
+    } else {
+        // the octree keeps entities without a known position at its root, so they are checked by every pick
+        item.minimum = glm::vec3((float)-HALF_TREE_SCALE);
+        item.maximum = glm::vec3((float)HALF_TREE_SCALE);
+    }
+}
+
+bool EntityTreeBVH::needsRebuild() const {
+    return _unindexed.size() > MAX_UNINDEXED_ENTITIES || _removedCount > _items.size() / 4 ||
+        _refitCount > MAX_REFITS_PER_ENTITY * _items.size();
+}
+
+void EntityTreeBVH::rebuildIfNeeded() {
+    bool shouldRebuild = resultWithReadLock<bool>([&] {
+        return needsRebuild();
+    });
+    if (shouldRebuild) {
+        withWriteLock([&] {
+            // another pick may have rebuilt it while we waited for the lock
+            if (needsRebuild()) {
+                rebuild();
+            }
+        });
+    }
+}
+
+void EntityTreeBVH::rebuild() {
+    std::vector<Item> items;
+    items.reserve(_items.size() - _removedCount);
+    for (auto& item : _items) {
+        if (item.entity) {
+            item.leaf = INVALID_INDEX;
+            items.push_back(std::move(item));
+        }
+    }
+    _items.swap(items);
+
+    _itemIndex.clear();
+    for (uint32_t i = 0; i < (uint32_t)_items.size(); i++) {
+        _itemIndex[_items[i].entity->getEntityItemID()] = i;
+    }
+    _unindexed.clear();
+    _removedCount = 0;
+    _refitCount = 0;
+
+    _order.resize(_items.size());
+    std::iota(_order.begin(), _order.end(), 0);
+    _nodes.clear();
+    if (!_items.empty()) {
+        _nodes.reserve(2 * (_items.size() / MAX_LEAF_SIZE + 1));
+        buildNode(INVALID_INDEX, 0, (uint32_t)_items.size());
+    }
+}
+
+void EntityTreeBVH::buildNode(uint32_t parent, uint32_t begin, uint32_t end) {
+    uint32_t nodeIndex = (uint32_t)_nodes.size();
+    _nodes.emplace_back();
+
+    glm::vec3 minimum(FLT_MAX);
+    glm::vec3 maximum(-FLT_MAX);
+    glm::vec3 centerMinimum(FLT_MAX);
+    glm::vec3 centerMaximum(-FLT_MAX);
+    for (uint32_t i = begin; i < end; i++) {
+        const Item& item = _items[_order[i]];
+        minimum = glm::min(minimum, item.minimum);
+        maximum = glm::max(maximum, item.maximum);
+        glm::vec3 center = 0.5f * (item.minimum + item.maximum);
+        centerMinimum = glm::min(centerMinimum, center);
+        centerMaximum = glm::max(centerMaximum, center);
+    }
+
+    // building the children adds nodes, so don't hold on to a reference to this one
+    _nodes[nodeIndex].minimum = minimum;
+    _nodes[nodeIndex].maximum = maximum;
+    _nodes[nodeIndex].parent = parent;
+
+    if (end - begin <= MAX_LEAF_SIZE) {
+        _nodes[nodeIndex].first = begin;
+        _nodes[nodeIndex].count = (uint16_t)(end - begin);
+        for (uint32_t i = begin; i < end; i++) {
+            _items[_order[i]].leaf = nodeIndex;
+        }
+        return;
+    }
+
+    // split at the median center along the axis the centers are most spread out on
+    glm::vec3 extent = centerMaximum - centerMinimum;
+    int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+    _nodes[nodeIndex].axis = (uint8_t)axis;
+
+    uint32_t middle = begin + (end - begin) / 2;
+    std::nth_element(_order.begin() + begin, _order.begin() + middle, _order.begin() + end, [&](uint32_t a, uint32_t b) {
+        return _items[a].minimum[axis] + _items[a].maximum[axis] < _items[b].minimum[axis] + _items[b].maximum[axis];
+    });
+
+    buildNode(nodeIndex, begin, middle);
+    uint32_t right = (uint32_t)_nodes.size();
+    buildNode(nodeIndex, middle, end);
+    _nodes[nodeIndex].first = right;
+}
+
+void EntityTreeBVH::refit(uint32_t nodeIndex) {
+    Node& leaf = _nodes[nodeIndex];
+    glm::vec3 minimum(FLT_MAX);
+    glm::vec3 maximum(-FLT_MAX);
+    for (uint32_t i = leaf.first; i < leaf.first + leaf.count; i++) {
+        const Item& item = _items[_order[i]];
+        minimum = glm::min(minimum, item.minimum);
+        maximum = glm::max(maximum, item.maximum);
+    }
+    leaf.minimum = minimum;
+    leaf.maximum = maximum;
+
+    uint32_t index = leaf.parent;
+    while (index != INVALID_INDEX) {
+        Node& node = _nodes[index];
+        const Node& left = _nodes[index + 1];
+        const Node& right = _nodes[node.first];
+        minimum = glm::min(left.minimum, right.minimum);
+        maximum = glm::max(left.maximum, right.maximum);
+        if (minimum == node.minimum && maximum == node.maximum) {
+            // nothing above here changes either
+            break;
+        }
+        node.minimum = minimum;
+        node.maximum = maximum;
+        index = node.parent;
+    }
+}
+
+void EntityTreeBVH::findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, float& distance,
+                                        const HitTest& hitTest) {
+    rebuildIfNeeded();
+    glm::vec3 invDirection = safeReciprocal(direction);
+
+    withReadLock([&] {
+        float entryDistance;
+        for (uint32_t index : _unindexed) {
+            const Item& item = _items[index];
+            if (rayEntersBox(origin, invDirection, item.minimum, item.maximum, distance, entryDistance)) {
+                hitTest(item.entity, distance);
+            }
+        }
+
+        if (_nodes.empty() || !rayEntersBox(origin, invDirection, _nodes[0].minimum, _nodes[0].maximum, distance, entryDistance)) {
+            return;
+        }
+
+        struct StackEntry {
+            uint32_t node;
+            float entryDistance;
+        };
+        StackEntry stack[TRAVERSAL_STACK_SIZE];
+        int stackSize = 0;
+        stack[stackSize++] = { 0, entryDistance };
+
+        while (stackSize > 0) {
+            StackEntry entry = stack[--stackSize];
+            // a closer hit may have been found since this node was pushed
+            if (entry.entryDistance >= distance) {
+                continue;
+            }
+
+            const Node& node = _nodes[entry.node];
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                    const Item& item = _items[_order[i]];
+                    if (item.entity && rayEntersBox(origin, invDirection, item.minimum, item.maximum, distance, entryDistance)) {
+                        hitTest(item.entity, distance);
+                    }
+                }
+                continue;
+            }
+
+            StackEntry nearChild = { entry.node + 1, 0.0f };
+            StackEntry farChild = { node.first, 0.0f };
+            const Node& nearNode = _nodes[nearChild.node];
+            const Node& farNode = _nodes[farChild.node];
+            bool hitsNear = rayEntersBox(origin, invDirection, nearNode.minimum, nearNode.maximum, distance,
+                                         nearChild.entryDistance);
+            bool hitsFar = rayEntersBox(origin, invDirection, farNode.minimum, farNode.maximum, distance,
+                                        farChild.entryDistance);
+            if (hitsNear && hitsFar && farChild.entryDistance < nearChild.entryDistance) {
+                std::swap(nearChild, farChild);
+            }
+            // push the farther child first so the nearer one is visited first
+            if (hitsFar) {
+                stack[stackSize++] = farChild;
+            }
+            if (hitsNear) {
+                stack[stackSize++] = nearChild;
+            }
+        }
+    });
+}
+
+void EntityTreeBVH::findRayIntersections(const std::vector<Ray>& rays, std::vector<float>& distances,
+                                         const PacketHitTest& hitTest) {
+    rebuildIfNeeded();
+    std::vector<glm::vec3> invDirections;
+    invDirections.reserve(rays.size());
+    for (const auto& ray : rays) {
+        invDirections.push_back(safeReciprocal(ray.direction));
+    }
+
+    withReadLock([&] {
+        for (size_t packetStart = 0; packetStart < rays.size(); packetStart += PACKET_SIZE) {
+            size_t packetSize = std::min(PACKET_SIZE, rays.size() - packetStart);
+            uint32_t packetMask = packetSize == 32 ? 0xffffffff : ((1u << packetSize) - 1);
+
+            // the rays in mask that enter the box closer than their closest hit so far
+            auto raysEnteringBox = [&](uint32_t mask, const glm::vec3& minimum, const glm::vec3& maximum) {
+                uint32_t entering = 0;
+                float entryDistance;
+                for (size_t bit = 0; bit < packetSize; bit++) {
+                    size_t ray = packetStart + bit;
+                    if ((mask & (1u << bit)) && rayEntersBox(rays[ray].origin, invDirections[ray], minimum, maximum,
+                                                             distances[ray], entryDistance)) {
+                        entering |= 1u << bit;
+                    }
+                }
+                return entering;
+            };
+
+            auto testItem = [&](const Item& item, uint32_t mask) {
+                if (!item.entity) {
+                    return;
+                }
+                uint32_t entering = raysEnteringBox(mask, item.minimum, item.maximum);
+                for (size_t bit = 0; entering != 0 && bit < packetSize; bit++) {
+                    if (entering & (1u << bit)) {
+                        hitTest(item.entity, packetStart + bit, distances[packetStart + bit]);
+                    }
+                }
+            };
+
+            for (uint32_t index : _unindexed) {
+                testItem(_items[index], packetMask);
+            }
+            if (_nodes.empty()) {
+                continue;
+            }
+
+            struct StackEntry {
+                uint32_t node;
+                uint32_t mask;
+            };
+            StackEntry stack[TRAVERSAL_STACK_SIZE];
+            int stackSize = 0;
+            stack[stackSize++] = { 0, packetMask };
+
+            while (stackSize > 0) {
+                StackEntry entry = stack[--stackSize];
+                const Node& node = _nodes[entry.node];
+                // test the node when it's popped, so the rays that found a closer hit since it was pushed drop out
+                uint32_t mask = raysEnteringBox(entry.mask, node.minimum, node.maximum);
+                if (mask == 0) {
+                    continue;
+                }
+
+                if (node.count > 0) {
+                    for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                        testItem(_items[_order[i]], mask);
+                    }
+                    continue;
+                }
+
+                // order the children by the direction of the first active ray, rays in a packet mostly point the same way
+                size_t firstRay = packetStart;
+                while (!(mask & (1u << (firstRay - packetStart)))) {
+                    firstRay++;
+                }
+                uint32_t nearChild = entry.node + 1;
+                uint32_t farChild = node.first;
+                if (rays[firstRay].direction[node.axis] < 0.0f) {
+                    std::swap(nearChild, farChild);
+                }
+                stack[stackSize++] = { farChild, mask };
+                stack[stackSize++] = { nearChild, mask };
+            }
+        }
+    });
+}
+
+void EntityTreeBVH::findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
+                                             float& parabolicDistance, const HitTest& hitTest) {
+    rebuildIfNeeded();
+
+    withReadLock([&] {
+        float entryDistance;
+        for (uint32_t index : _unindexed) {
+            const Item& item = _items[index];
+            if (parabolaEntersBox(origin, velocity, acceleration, item.minimum, item.maximum, parabolicDistance, entryDistance)) {
+                hitTest(item.entity, parabolicDistance);
+            }
+        }
+
+        if (_nodes.empty() || !parabolaEntersBox(origin, velocity, acceleration, _nodes[0].minimum, _nodes[0].maximum,
+                                                 parabolicDistance, entryDistance)) {
+            return;
+        }
+
+        struct StackEntry {
+            uint32_t node;
+            float entryDistance;
+        };
+        StackEntry stack[TRAVERSAL_STACK_SIZE];
+        int stackSize = 0;
+        stack[stackSize++] = { 0, entryDistance };
+
+        while (stackSize > 0) {
+            StackEntry entry = stack[--stackSize];
+            if (entry.entryDistance >= parabolicDistance) {
+                continue;
+            }
+
+            const Node& node = _nodes[entry.node];
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                    const Item& item = _items[_order[i]];
+                    if (item.entity && parabolaEntersBox(origin, velocity, acceleration, item.minimum, item.maximum,
+                                                         parabolicDistance, entryDistance)) {
+                        hitTest(item.entity, parabolicDistance);
+                    }
+                }
+                continue;
+            }
+
+            StackEntry nearChild = { entry.node + 1, 0.0f };
+            StackEntry farChild = { node.first, 0.0f };
+            const Node& nearNode = _nodes[nearChild.node];
+            const Node& farNode = _nodes[farChild.node];
+            bool hitsNear = parabolaEntersBox(origin, velocity, acceleration, nearNode.minimum, nearNode.maximum,
+                                              parabolicDistance, nearChild.entryDistance);
+            bool hitsFar = parabolaEntersBox(origin, velocity, acceleration, farNode.minimum, farNode.maximum,
+                                             parabolicDistance, farChild.entryDistance);
+            if (hitsNear && hitsFar && farChild.entryDistance < nearChild.entryDistance) {
+                std::swap(nearChild, farChild);
+            }
+            if (hitsFar) {
+                stack[stackSize++] = farChild;
+            }
+            if (hitsNear) {
+                stack[stackSize++] = nearChild;
+            }
+        }
+    });
+}
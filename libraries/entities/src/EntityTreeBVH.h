@@ -0,0 +1,98 @@
+//
+//  EntityTreeBVH.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeBVH_h
+#define hifi_EntityTreeBVH_h
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AACube.h>
+#include <shared/ReadWriteLockable.h>
+
+#include "EntityItem.h"
+
+// A flattened bounding volume hierarchy over the query cubes of a tree's entities, for picking.
+//
+// The octree keeps each entity in the smallest element that holds it, so a pick through a dense area visits many
+// elements with few entities each. The hierarchy instead groups the entities into small leaves with tight bounds and
+// is walked nearest child first, so a pick stops descending as soon as nothing left can beat its closest hit.
+//
+// Moves refit the bounds of the moved entity's leaf and its ancestors in place. Entities added since the last build
+// are checked one by one until there are enough of them to be worth a rebuild, which happens lazily on the next pick.
+class EntityTreeBVH : public ReadWriteLockable {
+public:
+    struct Ray {
+        glm::vec3 origin;
+        glm::vec3 direction;
+    };
+
+    // tests the entity against the pick, and lowers distance if it is hit closer
+    using HitTest = std::function<void(const EntityItemPointer& entity, float& distance)>;
+    using PacketHitTest = std::function<void(const EntityItemPointer& entity, size_t rayIndex, float& distance)>;
+
+    void addEntity(const EntityItemPointer& entity);
+    void removeEntity(const EntityItemID& entityID);
+    // refits the hierarchy around the entity's new query cube
+    void updateEntity(const EntityItemPointer& entity, const AACube& queryAACube);
+    void clear();
+
+    size_t getEntityCount() const;
+
+    // calls hitTest for each entity whose bounds the ray enters closer than distance, nearest leaves first
+    void findRayIntersection(const glm::vec3& origin, const glm::vec3& direction, float& distance, const HitTest& hitTest);
+    // walks the hierarchy once for a packet of rays, skipping each node that none of the rays still need,
+    // distances must have one entry per ray
+    void findRayIntersections(const std::vector<Ray>& rays, std::vector<float>& distances, const PacketHitTest& hitTest);
+    void findParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity, const glm::vec3& acceleration,
+                                  float& parabolicDistance, const HitTest& hitTest);
+
+private:
+    static const uint32_t INVALID_INDEX = (uint32_t)-1;
+
+    struct Item {
+        EntityItemPointer entity; // null once removed, until the next build drops it
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        uint32_t leaf { INVALID_INDEX };
+    };
+
+    // leaves hold count items from _order starting at first, an interior node has a count of zero and its children are
+    // the node after it and the node at first
+    struct Node {
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        uint32_t parent { INVALID_INDEX };
+        uint32_t first { 0 };
+        uint16_t count { 0 };
+        uint8_t axis { 0 };
+    };
+
+    bool needsRebuild() const;
+    void rebuildIfNeeded();
+    void rebuild();
+    void buildNode(uint32_t parent, uint32_t begin, uint32_t end);
+    void refit(uint32_t nodeIndex);
+    void setItemBounds(Item& item, const AACube& queryAACube, bool success);
+
+    std::vector<Item> _items;
+    std::vector<uint32_t> _order;
+    std::vector<Node> _nodes;
+    std::vector<uint32_t> _unindexed; // items added since the last build
+    std::unordered_map<EntityItemID, uint32_t> _itemIndex;
+    size_t _removedCount { 0 };
+    size_t _refitCount { 0 };
+};
+
+#endif // hifi_EntityTreeBVH_h
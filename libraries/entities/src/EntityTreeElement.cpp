@@ -11,6 +11,8 @@
 
 #include "EntityTreeElement.h"
 
+#include <FixedSizePool.h>
+
 #include <glm/gtx/transform.hpp>
 
 #include <GeometryUtil.h>
@@ -31,8 +33,19 @@ EntityTreeElement::~EntityTreeElement() {
     _octreeMemoryUsage -= sizeof(EntityTreeElement);
 }
 
+EntityTreeElementPointer EntityTreeElement::create(unsigned char* octalCode) {
+    PoolAllocator<EntityTreeElement> allocator;
+    static std::once_flag tagPool;
+    std::call_once(tagPool, [&] { allocator.getPool().setMemoryTag(MemoryTag::Entities); });
+    auto element = new (allocator.allocate(1)) EntityTreeElement(octalCode);
+    return EntityTreeElementPointer(element, [](EntityTreeElement* element) {
+        element->~EntityTreeElement();
+        PoolAllocator<EntityTreeElement>().deallocate(element, 1);
+    }, allocator);
+}
+
 OctreeElementPointer EntityTreeElement::createNewElement(unsigned char* octalCode) {
-    auto newChild = EntityTreeElementPointer(new EntityTreeElement(octalCode));
+    auto newChild = create(octalCode);
     newChild->setTree(_myTree);
     return newChild;
 }
@@ -197,79 +210,92 @@ EntityItemID EntityTreeElement::evalDetailedRayIntersection(const glm::vec3& ori
     // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
     EntityItemID entityID;
     forEachEntity([&](EntityItemPointer entity) {
-        if (entity->getIgnorePickIntersection() && !searchFilter.bypassIgnore()) {
-            return;
+        if (evalEntityRayIntersection(entity, origin, direction, viewFrustumPos, element, distance, face, surfaceNormal,
+                entityIdsToInclude, entityIDsToDiscard, searchFilter, extraInfo)) {
+            entityID = entity->getEntityItemID();
         }
+    });
+    return entityID;
+}
 
-        // use simple line-sphere for broadphase check
-        // (this is faster and more likely to cull results than the filter check below so we do it first)
-        bool success;
-        AABox entityBox = entity->getAABox(success);
-        if (!success || !entityBox.rayHitsBoundingSphere(origin, direction)) {
-            return;
-        }
+bool EntityTreeElement::evalEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+                                    const glm::vec3& direction, const glm::vec3& viewFrustumPos, OctreeElementPointer& element,
+                                    float& distance, BoxFace& face, glm::vec3& surfaceNormal,
+                                    const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIDsToDiscard,
+                                    PickFilter searchFilter, QVariantMap& extraInfo) {
+    if (entity->getIgnorePickIntersection() && !searchFilter.bypassIgnore()) {
+        return false;
+    }
 
-        if (!checkFilterSettings(entity, searchFilter) ||
-            (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
-            (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
-            return;
-        }
+    // use simple line-sphere for broadphase check
+    // (this is faster and more likely to cull results than the filter check below so we do it first)
+    bool success;
+    AABox entityBox = entity->getAABox(success);
+    if (!success || !entityBox.rayHitsBoundingSphere(origin, direction)) {
+        return false;
+    }
 
-        // extents is the entity relative, scaled, centered extents of the entity
-        glm::vec3 position = entity->getWorldPosition();
-        glm::mat4 translation = glm::translate(position);
-        BillboardMode billboardMode = entity->getBillboardMode();
-        glm::quat orientation = billboardMode == BillboardMode::NONE ? entity->getWorldOrientation() : entity->getLocalOrientation();
-        glm::mat4 rotation = glm::mat4_cast(BillboardModeHelpers::getBillboardRotation(position, orientation, billboardMode,
-            viewFrustumPos, entity->getRotateForPicking()));
-        glm::mat4 entityToWorldMatrix = translation * rotation;
-        glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
-
-        glm::vec3 dimensions = entity->getScaledDimensions();
-        glm::vec3 registrationPoint = entity->getRegistrationPoint();
-        glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
-
-        AABox entityFrameBox(corner, dimensions);
-
-        glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
-        glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
-
-        // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
-        // and testing intersection there.
-        float localDistance;
-        BoxFace localFace { UNKNOWN_FACE };
-        glm::vec3 localSurfaceNormal;
-        if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, 1.0f / entityFrameDirection, localDistance,
-                                                localFace, localSurfaceNormal)) {
-            if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
-                // now ask the entity if we actually intersect
-                if (entity->supportsDetailedIntersection()) {
-                    QVariantMap localExtraInfo;
-                    if (entity->findDetailedRayIntersection(origin, direction, viewFrustumPos, element, localDistance,
-                            localFace, localSurfaceNormal, localExtraInfo, searchFilter.isPrecise())) {
-                        if (localDistance < distance) {
-                            distance = localDistance;
-                            face = localFace;
-                            surfaceNormal = localSurfaceNormal;
-                            extraInfo = localExtraInfo;
-                            entityID = entity->getEntityItemID();
-                        }
-                    }
-                } else {
-                    // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
-                    // Never intersect with particle entities
-                    if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+    if (!checkFilterSettings(entity, searchFilter) ||
+        (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
+        (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID())) ) {
+        return false;
+    }
+
+    // extents is the entity relative, scaled, centered extents of the entity
+    glm::vec3 position = entity->getWorldPosition();
+    glm::mat4 translation = glm::translate(position);
+    BillboardMode billboardMode = entity->getBillboardMode();
+    glm::quat orientation = billboardMode == BillboardMode::NONE ? entity->getWorldOrientation() : entity->getLocalOrientation();
+    glm::mat4 rotation = glm::mat4_cast(BillboardModeHelpers::getBillboardRotation(position, orientation, billboardMode,
+        viewFrustumPos, entity->getRotateForPicking()));
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+    glm::vec3 dimensions = entity->getScaledDimensions();
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
+
+    AABox entityFrameBox(corner, dimensions);
+
+    glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
+    glm::vec3 entityFrameDirection = glm::vec3(worldToEntityMatrix * glm::vec4(direction, 0.0f));
+
+    // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
+    // and testing intersection there.
+    bool hit = false;
+    float localDistance;
+    BoxFace localFace { UNKNOWN_FACE };
+    glm::vec3 localSurfaceNormal;
+    if (entityFrameBox.findRayIntersection(entityFrameOrigin, entityFrameDirection, 1.0f / entityFrameDirection, localDistance,
+                                            localFace, localSurfaceNormal)) {
+        if (entityFrameBox.contains(entityFrameOrigin) || localDistance < distance) {
+            // now ask the entity if we actually intersect
+            if (entity->supportsDetailedIntersection()) {
+                QVariantMap localExtraInfo;
+                if (entity->findDetailedRayIntersection(origin, direction, viewFrustumPos, element, localDistance,
+                        localFace, localSurfaceNormal, localExtraInfo, searchFilter.isPrecise())) {
+                    if (localDistance < distance) {
                         distance = localDistance;
                         face = localFace;
-                        surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 0.0f));
-                        extraInfo = QVariantMap();
-                        entityID = entity->getEntityItemID();
+                        surfaceNormal = localSurfaceNormal;
+                        extraInfo = localExtraInfo;
+                        hit = true;
                     }
                 }
+            } else {
+                // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
+                // Never intersect with particle entities
+                if (localDistance < distance && entity->getType() != EntityTypes::ParticleEffect) {
+                    distance = localDistance;
+                    face = localFace;
+                    surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 0.0f));
+                    extraInfo = QVariantMap();
+                    hit = true;
+                }
             }
         }
-    });
-    return entityID;
+    }
+    return hit;
 }
 
 // TODO: change this to use better bounding shape for entity than sphere
@@ -277,7 +303,7 @@ bool EntityTreeElement::findSpherePenetration(const glm::vec3& center, float rad
                                     glm::vec3& penetration, void** penetratedObject) const {
     bool result = false;
     withReadLock([&] {
-        foreach(EntityItemPointer entity, _entityItems) {
+        for (const auto& entity : _entityItems) {
             bool success;
             glm::vec3 entityCenter = entity->getCenterPosition(success);
             float entityRadius = entity->getRadius();
@@ -299,6 +325,17 @@ bool EntityTreeElement::findSpherePenetration(const glm::vec3& center, float rad
     return result;
 }
 
+glm::vec3 EntityTreeElement::getParabolaPlaneNormal(const glm::vec3& velocity, const glm::vec3& acceleration) {
+    glm::vec3 vectorOnPlane = velocity;
+    if (glm::dot(glm::normalize(velocity), glm::normalize(acceleration)) > 1.0f - EPSILON) {
+        // Handle the degenerate case where velocity is parallel to acceleration
+        // We pick t = 1 and calculate a second point on the plane
+        vectorOnPlane = velocity + 0.5f * acceleration;
+    }
+    // Get the normal of the plane, the cross product of two vectors on the plane
+    return glm::normalize(glm::cross(vectorOnPlane, acceleration));
+}
+
 EntityItemID EntityTreeElement::evalParabolaIntersection(const glm::vec3& origin, const glm::vec3& velocity,
     const glm::vec3& acceleration, const glm::vec3& viewFrustumPos, OctreeElementPointer& element, float& parabolicDistance,
     BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
@@ -315,14 +352,7 @@ EntityItemID EntityTreeElement::evalParabolaIntersection(const glm::vec3& origin
     QVariantMap localExtraInfo;
     float distanceToElementDetails = parabolicDistance;
     // We can precompute the world-space parabola normal and reuse it for the parabola plane intersects AABox sphere check
-    glm::vec3 vectorOnPlane = velocity;
-    if (glm::dot(glm::normalize(velocity), glm::normalize(acceleration)) > 1.0f - EPSILON) {
-        // Handle the degenerate case where velocity is parallel to acceleration
-        // We pick t = 1 and calculate a second point on the plane
-        vectorOnPlane = velocity + 0.5f * acceleration;
-    }
-    // Get the normal of the plane, the cross product of two vectors on the plane
-    glm::vec3 normal = glm::normalize(glm::cross(vectorOnPlane, acceleration));
+    glm::vec3 normal = getParabolaPlaneNormal(velocity, acceleration);
     EntityItemID entityID = evalDetailedParabolaIntersection(origin, velocity, acceleration, viewFrustumPos, normal, element, distanceToElementDetails,
             localFace, localSurfaceNormal, entityIdsToInclude, entityIdsToDiscard, searchFilter, localExtraInfo);
     if (!entityID.isNull() && distanceToElementDetails < parabolicDistance) {
@@ -343,85 +373,98 @@ EntityItemID EntityTreeElement::evalDetailedParabolaIntersection(const glm::vec3
     // only called if we do intersect our bounding cube, but find if we actually intersect with entities...
     EntityItemID entityID;
     forEachEntity([&](EntityItemPointer entity) {
-        if (entity->getIgnorePickIntersection() && !searchFilter.bypassIgnore()) {
-            return;
+        if (evalEntityParabolaIntersection(entity, origin, velocity, acceleration, viewFrustumPos, normal, element,
+                parabolicDistance, face, surfaceNormal, entityIdsToInclude, entityIDsToDiscard, searchFilter, extraInfo)) {
+            entityID = entity->getEntityItemID();
         }
+    });
+    return entityID;
+}
 
-        // use simple line-sphere for broadphase check
-        // (this is faster and more likely to cull results than the filter check below so we do it first)
-        bool success;
-        AABox entityBox = entity->getAABox(success);
+bool EntityTreeElement::evalEntityParabolaIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+                                    const glm::vec3& velocity, const glm::vec3& acceleration, const glm::vec3& viewFrustumPos,
+                                    const glm::vec3& normal, OctreeElementPointer& element, float& parabolicDistance,
+                                    BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+                                    const QVector<EntityItemID>& entityIDsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo) {
+    if (entity->getIgnorePickIntersection() && !searchFilter.bypassIgnore()) {
+        return false;
+    }
 
-        // Instead of checking parabolaInstersectsBoundingSphere here, we are just going to check if the plane
-        // defined by the parabola slices the sphere.  The solution to parabolaIntersectsBoundingSphere is cubic,
-        // the solution to which is more computationally expensive than the quadratic AABox::findParabolaIntersection
-        // below
-        if (!success || !entityBox.parabolaPlaneIntersectsBoundingSphere(origin, velocity, acceleration, normal)) {
-            return;
-        }
+    // use simple line-sphere for broadphase check
+    // (this is faster and more likely to cull results than the filter check below so we do it first)
+    bool success;
+    AABox entityBox = entity->getAABox(success);
 
-        if (!checkFilterSettings(entity, searchFilter) ||
-            (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
-            (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID()))) {
-            return;
-        }
+    // Instead of checking parabolaInstersectsBoundingSphere here, we are just going to check if the plane
+    // defined by the parabola slices the sphere.  The solution to parabolaIntersectsBoundingSphere is cubic,
+    // the solution to which is more computationally expensive than the quadratic AABox::findParabolaIntersection
+    // below
+    if (!success || !entityBox.parabolaPlaneIntersectsBoundingSphere(origin, velocity, acceleration, normal)) {
+        return false;
+    }
 
-        // extents is the entity relative, scaled, centered extents of the entity
-        glm::vec3 position = entity->getWorldPosition();
-        glm::mat4 translation = glm::translate(position);
-        BillboardMode billboardMode = entity->getBillboardMode();
-        glm::quat orientation = billboardMode == BillboardMode::NONE ? entity->getWorldOrientation() : entity->getLocalOrientation();
-        glm::mat4 rotation = glm::mat4_cast(BillboardModeHelpers::getBillboardRotation(position, orientation, billboardMode,
-            viewFrustumPos, entity->getRotateForPicking()));
-        glm::mat4 entityToWorldMatrix = translation * rotation;
-        glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
-
-        glm::vec3 dimensions = entity->getScaledDimensions();
-        glm::vec3 registrationPoint = entity->getRegistrationPoint();
-        glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
-
-        AABox entityFrameBox(corner, dimensions);
-
-        glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
-        glm::vec3 entityFrameVelocity = glm::vec3(worldToEntityMatrix * glm::vec4(velocity, 0.0f));
-        glm::vec3 entityFrameAcceleration = glm::vec3(worldToEntityMatrix * glm::vec4(acceleration, 0.0f));
-
-        // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
-        // and testing intersection there.
-        float localDistance;
-        BoxFace localFace;
-        glm::vec3 localSurfaceNormal;
-        if (entityFrameBox.findParabolaIntersection(entityFrameOrigin, entityFrameVelocity, entityFrameAcceleration, localDistance,
-                                                localFace, localSurfaceNormal)) {
-            if (entityFrameBox.contains(entityFrameOrigin) || localDistance < parabolicDistance) {
-                // now ask the entity if we actually intersect
-                if (entity->supportsDetailedIntersection()) {
-                    QVariantMap localExtraInfo;
-                    if (entity->findDetailedParabolaIntersection(origin, velocity, acceleration, viewFrustumPos, element, localDistance,
-                            localFace, localSurfaceNormal, localExtraInfo, searchFilter.isPrecise())) {
-                        if (localDistance < parabolicDistance) {
-                            parabolicDistance = localDistance;
-                            face = localFace;
-                            surfaceNormal = localSurfaceNormal;
-                            extraInfo = localExtraInfo;
-                            entityID = entity->getEntityItemID();
-                        }
-                    }
-                } else {
-                    // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
-                    // Never intersect with particle entities
-                    if (localDistance < parabolicDistance && entity->getType() != EntityTypes::ParticleEffect) {
+    if (!checkFilterSettings(entity, searchFilter) ||
+        (entityIdsToInclude.size() > 0 && !entityIdsToInclude.contains(entity->getID())) ||
+        (entityIDsToDiscard.size() > 0 && entityIDsToDiscard.contains(entity->getID()))) {
+        return false;
+    }
+
+    // extents is the entity relative, scaled, centered extents of the entity
+    glm::vec3 position = entity->getWorldPosition();
+    glm::mat4 translation = glm::translate(position);
+    BillboardMode billboardMode = entity->getBillboardMode();
+    glm::quat orientation = billboardMode == BillboardMode::NONE ? entity->getWorldOrientation() : entity->getLocalOrientation();
+    glm::mat4 rotation = glm::mat4_cast(BillboardModeHelpers::getBillboardRotation(position, orientation, billboardMode,
+        viewFrustumPos, entity->getRotateForPicking()));
+    glm::mat4 entityToWorldMatrix = translation * rotation;
+    glm::mat4 worldToEntityMatrix = glm::inverse(entityToWorldMatrix);
+
+    glm::vec3 dimensions = entity->getScaledDimensions();
+    glm::vec3 registrationPoint = entity->getRegistrationPoint();
+    glm::vec3 corner = -(dimensions * registrationPoint) + entity->getPivot();
+
+    AABox entityFrameBox(corner, dimensions);
+
+    glm::vec3 entityFrameOrigin = glm::vec3(worldToEntityMatrix * glm::vec4(origin, 1.0f));
+    glm::vec3 entityFrameVelocity = glm::vec3(worldToEntityMatrix * glm::vec4(velocity, 0.0f));
+    glm::vec3 entityFrameAcceleration = glm::vec3(worldToEntityMatrix * glm::vec4(acceleration, 0.0f));
+
+    // we can use the AABox's ray intersection by mapping our origin and direction into the entity frame
+    // and testing intersection there.
+    bool hit = false;
+    float localDistance;
+    BoxFace localFace;
+    glm::vec3 localSurfaceNormal;
+    if (entityFrameBox.findParabolaIntersection(entityFrameOrigin, entityFrameVelocity, entityFrameAcceleration, localDistance,
+                                            localFace, localSurfaceNormal)) {
+        if (entityFrameBox.contains(entityFrameOrigin) || localDistance < parabolicDistance) {
+            // now ask the entity if we actually intersect
+            if (entity->supportsDetailedIntersection()) {
+                QVariantMap localExtraInfo;
+                if (entity->findDetailedParabolaIntersection(origin, velocity, acceleration, viewFrustumPos, element, localDistance,
+                        localFace, localSurfaceNormal, localExtraInfo, searchFilter.isPrecise())) {
+                    if (localDistance < parabolicDistance) {
                         parabolicDistance = localDistance;
                         face = localFace;
-                        surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 0.0f));
-                        extraInfo = QVariantMap();
-                        entityID = entity->getEntityItemID();
+                        surfaceNormal = localSurfaceNormal;
+                        extraInfo = localExtraInfo;
+                        hit = true;
                     }
                 }
+            } else {
+                // if the entity type doesn't support a detailed intersection, then just return the non-AABox results
+                // Never intersect with particle entities
+                if (localDistance < parabolicDistance && entity->getType() != EntityTypes::ParticleEffect) {
+                    parabolicDistance = localDistance;
+                    face = localFace;
+                    surfaceNormal = glm::vec3(rotation * glm::vec4(localSurfaceNormal, 0.0f));
+                    extraInfo = QVariantMap();
+                    hit = true;
+                }
             }
         }
-    });
-    return entityID;
+    }
+    return hit;
 }
 
 QUuid EntityTreeElement::evalClosetEntity(const glm::vec3& position, PickFilter searchFilter, float& closestDistanceSquared) const {
@@ -691,7 +734,7 @@ void EntityTreeElement::getEntities(EntityItemFilter& filter, QVector<EntityItem
 EntityItemPointer EntityTreeElement::getEntityWithEntityItemID(const EntityItemID& id) const {
     EntityItemPointer foundEntity = NULL;
     withReadLock([&] {
-        foreach(EntityItemPointer entity, _entityItems) {
+        for (const auto& entity : _entityItems) {
             if (entity->getEntityItemID() == id) {
                 foundEntity = entity;
                 break;
@@ -703,7 +746,7 @@ EntityItemPointer EntityTreeElement::getEntityWithEntityItemID(const EntityItemI
 
 void EntityTreeElement::cleanupDomainAndNonOwnedEntities() {
     withWriteLock([&] {
-        EntityItems savedEntities;
+        EntityItemList savedEntities;
         foreach(EntityItemPointer entity, _entityItems) {
             if (!(entity->isLocalEntity() || entity->isMyAvatarEntity())) {
                 entity->preDelete();
@@ -713,9 +756,13 @@ void EntityTreeElement::cleanupDomainAndNonOwnedEntities() {
             }
         }
 
-        _entityItems = savedEntities;
+        _entityItems = std::move(savedEntities);
+        _numEntities.store((uint16_t)_entityItems.size(), std::memory_order_release);
     });
     bumpChangedContent();
+    if (_myTree) {
+        _myTree->invalidateQueryCache(AABox(getAACube()));
+    }
 }
 
 void EntityTreeElement::cleanupEntities() {
@@ -729,8 +776,12 @@ void EntityTreeElement::cleanupEntities() {
             entity->_element = NULL;
         }
         _entityItems.clear();
+        _numEntities.store(0, std::memory_order_release);
     });
     bumpChangedContent();
+    if (_myTree) {
+        _myTree->invalidateQueryCache(AABox(getAACube()));
+    }
 }
 
 bool EntityTreeElement::removeEntityItem(EntityItemPointer entity, bool deletion) {
@@ -739,13 +790,17 @@ bool EntityTreeElement::removeEntityItem(EntityItemPointer entity, bool deletion
     }
     int numEntries = 0;
     withWriteLock([&] {
-        numEntries = _entityItems.removeAll(entity);
+        numEntries = (int)_entityItems.removeAll(entity);
+        _numEntities.store((uint16_t)_entityItems.size(), std::memory_order_release);
     });
     if (numEntries > 0) {
         // NOTE: only EntityTreeElement should ever be changing the value of entity->_element
         assert(entity->_element.get() == this);
         entity->_element = NULL;
         bumpChangedContent();
+        if (_myTree) {
+            _myTree->invalidateQueryCache(AABox(getAACube()));
+        }
         return true;
     }
     return false;
@@ -762,8 +817,12 @@ void EntityTreeElement::addEntityItem(EntityItemPointer entity) {
     assert(entity->_element == nullptr);
     withWriteLock([&] {
         _entityItems.push_back(entity);
+        _numEntities.store((uint16_t)_entityItems.size(), std::memory_order_release);
     });
     bumpChangedContent();
+    if (_myTree) {
+        _myTree->invalidateQueryCache(AABox(getAACube()));
+    }
     entity->_element = getThisPointer();
 }
 
@@ -797,7 +856,7 @@ bool EntityTreeElement::pruneChildren() {
 
 void EntityTreeElement::expandExtentsToContents(Extents& extents) {
     withReadLock([&] {
-        foreach(EntityItemPointer entity, _entityItems) {
+        for (const auto& entity : _entityItems) {
             bool success;
             AABox aaBox = entity->getAABox(success);
             if (success) {
@@ -808,11 +867,7 @@ void EntityTreeElement::expandExtentsToContents(Extents& extents) {
 }
 
 uint16_t EntityTreeElement::size() const {
-    uint16_t result = 0;
-    withReadLock([&] {
-        result = _entityItems.size();
-    });
-    return result;
+    return _numEntities.load(std::memory_order_acquire);
 }
 
 
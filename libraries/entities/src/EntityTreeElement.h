@@ -12,10 +12,12 @@
 #ifndef hifi_EntityTreeElement_h
 #define hifi_EntityTreeElement_h
 
+#include <atomic>
 #include <memory>
 
 #include <OctreeElement.h>
 #include <QList>
+#include <SmallVector.h>
 
 #include "EntityEditPacketSender.h"
 #include "EntityItem.h"
@@ -83,6 +85,9 @@ class EntityTreeElement : public OctreeElement, ReadWriteLockable {
 
     EntityTreeElement(unsigned char* octalCode = NULL);
 
+    // elements and their shared pointer control blocks come from pools rather than two heap blocks each
+    static EntityTreeElementPointer create(unsigned char* octalCode = NULL);
+
     virtual OctreeElementPointer createNewElement(unsigned char* octalCode = NULL) override;
 
 public:
@@ -144,6 +149,11 @@ public:
                          const glm::vec3& viewFrustumPos, OctreeElementPointer& element, float& distance,
                          BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
                          const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
+    // tests a single entity, returns true and updates distance if it is hit closer than distance
+    static bool evalEntityRayIntersection(const EntityItemPointer& entity, const glm::vec3& origin, const glm::vec3& direction,
+        const glm::vec3& viewFrustumPos, OctreeElementPointer& element, float& distance, BoxFace& face,
+        glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
+        const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
     virtual bool findSpherePenetration(const glm::vec3& center, float radius,
                         glm::vec3& penetration, void** penetratedObject) const override;
 
@@ -155,18 +165,29 @@ public:
         const glm::vec3& normal, const glm::vec3& acceleration, const glm::vec3& viewFrustumPos, OctreeElementPointer& element,
         float& parabolicDistance, BoxFace& face, glm::vec3& surfaceNormal, const QVector<EntityItemID>& entityIdsToInclude,
         const QVector<EntityItemID>& entityIdsToDiscard, PickFilter searchFilter, QVariantMap& extraInfo);
+    static bool evalEntityParabolaIntersection(const EntityItemPointer& entity, const glm::vec3& origin,
+        const glm::vec3& velocity, const glm::vec3& acceleration, const glm::vec3& viewFrustumPos, const glm::vec3& normal,
+        OctreeElementPointer& element, float& parabolicDistance, BoxFace& face, glm::vec3& surfaceNormal,
+        const QVector<EntityItemID>& entityIdsToInclude, const QVector<EntityItemID>& entityIdsToDiscard,
+        PickFilter searchFilter, QVariantMap& extraInfo);
+    // the normal of the plane the parabola lies in
+    static glm::vec3 getParabolaPlaneNormal(const glm::vec3& velocity, const glm::vec3& acceleration);
 
     template <typename F>
     void forEachEntity(F f) const {
+        // most of the elements a traversal visits hold no entities, and those don't need the lock
+        if (!hasEntities()) {
+            return;
+        }
         withReadLock([&] {
-            foreach(EntityItemPointer entityItem, _entityItems) {
+            for (const auto& entityItem : _entityItems) {
                 f(entityItem);
             }
         });
     }
 
     virtual uint16_t size() const;
-    bool hasEntities() const { return size() > 0; }
+    bool hasEntities() const { return _numEntities.load(std::memory_order_acquire) > 0; }
 
     void setTree(EntityTreePointer tree) { _myTree = tree; }
     EntityTreePointer getTree() const { return _myTree; }
@@ -228,7 +249,12 @@ public:
 protected:
     virtual void init(unsigned char * octalCode) override;
     EntityTreePointer _myTree;
-    EntityItems _entityItems;
+
+    // almost every element holds one entity or none, so one is kept inline
+    using EntityItemList = SmallVector<EntityItemPointer, 1>;
+    EntityItemList _entityItems;
+    // the size of _entityItems, which can be read without the lock
+    std::atomic<uint16_t> _numEntities { 0 };
 };
 
 #endif // hifi_EntityTreeElement_h
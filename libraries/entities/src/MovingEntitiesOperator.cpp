@@ -63,6 +63,11 @@ void MovingEntitiesOperator::addEntityToMoveList(EntityItemPointer entity, const
         return; // bail without adding.
     }
 
+    // the pick BVH follows every move, including the ones that stay inside the same element
+    if (auto tree = oldContainingElement->getTree()) {
+        tree->entityQueryAACubeChanged(entity, newCube);
+    }
+
     // If the original containing element is the best fit for the requested newCube locations then
     // we don't actually need to add the entity for moving and we can short circuit all this work
     if (!oldContainingElement->bestFitBounds(newCubeClamped)) {
@@ -22,7 +22,8 @@ using SimpleEntitySimulationPointer = std::shared_ptr<SimpleEntitySimulation>;
 
 class SimpleEntitySimulation : public EntitySimulation {
 public:
-    SimpleEntitySimulation() : EntitySimulation() { }
+    // the entity server has no entity change handlers, so it can move simple kinematic entities in parallel
+    SimpleEntitySimulation() : EntitySimulation() { setParallelSimpleKinematics(true); }
     ~SimpleEntitySimulation() { clearEntities(); }
 
     void clearOwnership(const QUuid& ownerID);
@@ -361,6 +361,11 @@ bool ZoneEntityItem::contains(const glm::vec3& point) const {
     return EntityItem::contains(point);
 }
 
+bool ZoneEntityItem::isShapeLoading() const {
+    GeometryResource::Pointer resource = _shapeResource;
+    return getShapeType() == SHAPE_TYPE_COMPOUND && resource && !resource->isLoaded();
+}
+
 void ZoneEntityItem::setFilterURL(QString url) {
     withWriteLock([&] {
         _filterURL = url;
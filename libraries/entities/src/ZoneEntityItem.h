@@ -125,6 +125,8 @@ public:
                          QVariantMap& extraInfo, bool precisionPicking) const override;
 
     bool contains(const glm::vec3& point) const override;
+    // whether contains() is testing the box while a compound shape loads
+    bool isShapeLoading() const;
 
     virtual void debugDump() const override;
 
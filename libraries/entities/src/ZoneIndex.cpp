@@ -0,0 +1,249 @@
+//
+//  ZoneIndex.cpp
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ZoneIndex.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <numeric>
+
+#include <AABox.h>
+#include <OctreeConstants.h>
+
+#include "ZoneEntityItem.h"
+
+namespace {
+
+const uint32_t MAX_LEAF_SIZE = 4;
+// the median split keeps the depth at log2 of the leaf count, so this is never reached
+const int TRAVERSAL_STACK_SIZE = 64;
+
+bool boxContains(const glm::vec3& minimum, const glm::vec3& maximum, const glm::vec3& point) {
+    return glm::all(glm::greaterThanEqual(point, minimum)) && glm::all(glm::lessThanEqual(point, maximum));
+}
+
+}
+
+void ZoneIndex::addZone(const EntityItemPointer& entity) {
+    auto zone = std::dynamic_pointer_cast<ZoneEntityItem>(entity);
+    if (!zone) {
+        return;
+    }
+    bool success;
+    AACube queryAACube = zone->getQueryAACube(success);
+
+    std::lock_guard<std::mutex> lock(_lock);
+    auto itr = _itemIndex.find(zone->getEntityItemID());
+    if (itr != _itemIndex.end()) {
+        Item& item = _items[itr->second];
+        item.zone = zone;
+        item.hasTest = false;
+        setItemBounds(item, queryAACube, success);
+        if (!_needsRebuild) {
+            refit(item.leaf);
+        }
+        return;
+    }
+
+    _itemIndex[zone->getEntityItemID()] = (uint32_t)_items.size();
+    _items.emplace_back();
+    _items.back().zone = zone;
+    setItemBounds(_items.back(), queryAACube, success);
+    _needsRebuild = true;
+}
+
+void ZoneIndex::removeZone(const EntityItemID& zoneID) {
+    std::lock_guard<std::mutex> lock(_lock);
+    auto itr = _itemIndex.find(zoneID);
+    if (itr == _itemIndex.end()) {
+        return;
+    }
+    uint32_t index = itr->second;
+    _itemIndex.erase(itr);
+
+    // the leaves point at the items, so moving the last one into the gap needs a rebuild either way
+    if (index != _items.size() - 1) {
+        _items[index] = std::move(_items.back());
+        _itemIndex[_items[index].zone->getEntityItemID()] = index;
+    }
+    _items.pop_back();
+    _needsRebuild = true;
+}
+
+void ZoneIndex::updateZone(const EntityItemID& zoneID, const AACube& queryAACube) {
+    std::lock_guard<std::mutex> lock(_lock);
+    auto itr = _itemIndex.find(zoneID);
+    if (itr == _itemIndex.end()) {
+        return;
+    }
+    Item& item = _items[itr->second];
+    item.hasTest = false;
+    setItemBounds(item, queryAACube, true);
+    if (!_needsRebuild) {
+        refit(item.leaf);
+    }
+}
+
+void ZoneIndex::clear() {
+    std::lock_guard<std::mutex> lock(_lock);
+    _items.clear();
+    _order.clear();
+    _nodes.clear();
+    _itemIndex.clear();
+    _needsRebuild = false;
+}
+
+size_t ZoneIndex::getZoneCount() const {
+    std::lock_guard<std::mutex> lock(_lock);
+    return _items.size();
+}
+
+void ZoneIndex::setItemBounds(Item& item, const AACube& queryAACube, bool success) {
+    if (success) {
+        AABox box(queryAACube);
+        item.minimum = box.getMinimumPoint();
+        item.maximum = box.getMaximumPoint();
+    } else {
+        // the octree keeps entities without a known position at its root, so their shape is tested for every point
+        item.minimum = glm::vec3((float)-HALF_TREE_SCALE);
+        item.maximum = glm::vec3((float)HALF_TREE_SCALE);
+    }
+}
+
+void ZoneIndex::rebuild() {
+    _needsRebuild = false;
+    _order.resize(_items.size());
+    std::iota(_order.begin(), _order.end(), 0);
+    _nodes.clear();
+    if (!_items.empty()) {
+        _nodes.reserve(2 * (_items.size() / MAX_LEAF_SIZE + 1));
+        buildNode(INVALID_INDEX, 0, (uint32_t)_items.size());
+    }
+}
+
+void ZoneIndex::buildNode(uint32_t parent, uint32_t begin, uint32_t end) {
+    uint32_t nodeIndex = (uint32_t)_nodes.size();
+    _nodes.emplace_back();
+
+    glm::vec3 minimum(FLT_MAX);
+    glm::vec3 maximum(-FLT_MAX);
+    glm::vec3 centerMinimum(FLT_MAX);
+    glm::vec3 centerMaximum(-FLT_MAX);
+    for (uint32_t i = begin; i < end; i++) {
+        const Item& item = _items[_order[i]];
+        minimum = glm::min(minimum, item.minimum);
+        maximum = glm::max(maximum, item.maximum);
+        glm::vec3 center = 0.5f * (item.minimum + item.maximum);
+        centerMinimum = glm::min(centerMinimum, center);
+        centerMaximum = glm::max(centerMaximum, center);
+    }
+
+    // building the children adds nodes, so don't hold on to a reference to this one
+    _nodes[nodeIndex].minimum = minimum;
+    _nodes[nodeIndex].maximum = maximum;
+    _nodes[nodeIndex].parent = parent;
+
+    if (end - begin <= MAX_LEAF_SIZE) {
+        _nodes[nodeIndex].first = begin;
+        _nodes[nodeIndex].count = (uint16_t)(end - begin);
+        for (uint32_t i = begin; i < end; i++) {
+            _items[_order[i]].leaf = nodeIndex;
+        }
+        return;
+    }
+
+    // split at the median center along the axis the centers are most spread out on
+    glm::vec3 extent = centerMaximum - centerMinimum;
+    int axis = (extent.x >= extent.y && extent.x >= extent.z) ? 0 : (extent.y >= extent.z ? 1 : 2);
+
+    uint32_t middle = begin + (end - begin) / 2;
+    std::nth_element(_order.begin() + begin, _order.begin() + middle, _order.begin() + end, [&](uint32_t a, uint32_t b) {
+        return _items[a].minimum[axis] + _items[a].maximum[axis] < _items[b].minimum[axis] + _items[b].maximum[axis];
+    });
+
+    buildNode(nodeIndex, begin, middle);
+    uint32_t right = (uint32_t)_nodes.size();
+    buildNode(nodeIndex, middle, end);
+    _nodes[nodeIndex].first = right;
+}
+
+void ZoneIndex::refit(uint32_t nodeIndex) {
+    Node& leaf = _nodes[nodeIndex];
+    glm::vec3 minimum(FLT_MAX);
+    glm::vec3 maximum(-FLT_MAX);
+    for (uint32_t i = leaf.first; i < leaf.first + leaf.count; i++) {
+        const Item& item = _items[_order[i]];
+        minimum = glm::min(minimum, item.minimum);
+        maximum = glm::max(maximum, item.maximum);
+    }
+    leaf.minimum = minimum;
+    leaf.maximum = maximum;
+
+    uint32_t index = leaf.parent;
+    while (index != INVALID_INDEX) {
+        Node& node = _nodes[index];
+        const Node& left = _nodes[index + 1];
+        const Node& right = _nodes[node.first];
+        minimum = glm::min(left.minimum, right.minimum);
+        maximum = glm::max(left.maximum, right.maximum);
+        if (minimum == node.minimum && maximum == node.maximum) {
+            // nothing above here changes either
+            break;
+        }
+        node.minimum = minimum;
+        node.maximum = maximum;
+        index = node.parent;
+    }
+}
+
+bool ZoneIndex::containsPoint(Item& item, const glm::vec3& point) {
+    if (item.hasTest && item.testedPoint == point) {
+        return item.testResult;
+    }
+    bool result = item.zone->contains(point);
+    // while a compound shape loads the zone is tested as a box, so that answer mustn't be kept
+    item.hasTest = !item.zone->isShapeLoading();
+    item.testedPoint = point;
+    item.testResult = result;
+    return result;
+}
+
+void ZoneIndex::findContainingZones(const glm::vec3& point, std::vector<ZoneEntityItemPointer>& zones) {
+    std::lock_guard<std::mutex> lock(_lock);
+    if (_needsRebuild) {
+        rebuild();
+    }
+    if (_nodes.empty()) {
+        return;
+    }
+
+    uint32_t stack[TRAVERSAL_STACK_SIZE];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+    while (stackSize > 0) {
+        const Node& node = _nodes[stack[--stackSize]];
+        if (!boxContains(node.minimum, node.maximum, point)) {
+            continue;
+        }
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                Item& item = _items[_order[i]];
+                if (boxContains(item.minimum, item.maximum, point) && containsPoint(item, point)) {
+                    zones.push_back(item.zone);
+                }
+            }
+        } else {
+            uint32_t index = (uint32_t)(&node - _nodes.data());
+            stack[stackSize++] = node.first;
+            stack[stackSize++] = index + 1;
+        }
+    }
+}
@@ -0,0 +1,90 @@
+//
+//  ZoneIndex.h
+//  libraries/entities/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ZoneIndex_h
+#define hifi_ZoneIndex_h
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AACube.h>
+
+#include "EntityItem.h"
+
+class ZoneEntityItem;
+using ZoneEntityItemPointer = std::shared_ptr<ZoneEntityItem>;
+
+// A bounding volume hierarchy over the query cubes of a tree's zones, for finding the zones that contain a point.
+//
+// The renderer's layered zones and the avatar mixer's priority and screenshare zones all ask which zones an avatar is
+// in, and the octree can only answer that by visiting every element around the point and skipping everything that
+// isn't a zone. Zones are few and large, so a hierarchy of just them answers it in a few box tests.
+//
+// Moves refit the bounds of the moved zone's leaf and its ancestors, adding and removing zones rebuilds it on the next
+// query. The last shape test of each zone is kept, so asking again for the same point, as a resting avatar does,
+// doesn't repeat the compound shape tests.
+class ZoneIndex {
+public:
+    void addZone(const EntityItemPointer& zone);
+    void removeZone(const EntityItemID& zoneID);
+    // refits the hierarchy around the zone's new query cube, and forgets its shape test
+    void updateZone(const EntityItemID& zoneID, const AACube& queryAACube);
+    void clear();
+
+    size_t getZoneCount() const;
+
+    // appends the zones whose shape contains the point
+    void findContainingZones(const glm::vec3& point, std::vector<ZoneEntityItemPointer>& zones);
+
+private:
+    static const uint32_t INVALID_INDEX = (uint32_t)-1;
+
+    struct Item {
+        ZoneEntityItemPointer zone;
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        uint32_t leaf { INVALID_INDEX };
+        // the last shape test
+        glm::vec3 testedPoint;
+        bool hasTest { false };
+        bool testResult { false };
+    };
+
+    // leaves hold count items from _order starting at first, an interior node has a count of zero and its children are
+    // the node after it and the node at first
+    struct Node {
+        glm::vec3 minimum;
+        glm::vec3 maximum;
+        uint32_t parent { INVALID_INDEX };
+        uint32_t first { 0 };
+        uint16_t count { 0 };
+    };
+
+    void rebuild();
+    void buildNode(uint32_t parent, uint32_t begin, uint32_t end);
+    void refit(uint32_t nodeIndex);
+    bool containsPoint(Item& item, const glm::vec3& point);
+    static void setItemBounds(Item& item, const AACube& queryAACube, bool success);
+
+    // queries keep the shape tests, so even they need the lock to themselves
+    mutable std::mutex _lock;
+    std::vector<Item> _items;
+    std::vector<uint32_t> _order;
+    std::vector<Node> _nodes;
+    std::unordered_map<EntityItemID, uint32_t> _itemIndex;
+    bool _needsRebuild { false };
+};
+
+#endif // hifi_ZoneIndex_h
@@ -11,6 +11,7 @@
 
 #include "Config.h"
 
+#include <cstring>
 #include <mutex>
 
 #if defined(Q_OS_WIN)
@@ -84,6 +85,13 @@ static void* getGlProcessAddress(const char *namez) {
 
 #endif
 
+#if !defined(USE_GLES)
+typedef void (APIENTRYP PFNGLBINDSHADINGRATEIMAGENVPROC)(GLuint texture);
+typedef void (APIENTRYP PFNGLSHADINGRATEIMAGEPALETTENVPROC)(GLuint viewport, GLuint first, GLsizei count, const GLenum* rates);
+PFNGLBINDSHADINGRATEIMAGENVPROC BindShadingRateImageNV;
+PFNGLSHADINGRATEIMAGEPALETTENVPROC ShadingRateImagePaletteNV;
+#endif
+
 
 
 void gl::initModuleGl() {
@@ -104,10 +112,55 @@ void gl::initModuleGl() {
         gladLoadGLES2Loader(getGlProcessAddress);
 #else
         gladLoadGLLoader(getGlProcessAddress);
+
+        // the loaders hand back addresses for functions the driver doesn't have, so check the extension is there
+        GLint numExtensions = 0;
+        if (glGetStringi) {
+            glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+        }
+        for (GLint i = 0; i < numExtensions; ++i) {
+            auto extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+            if (extension && strcmp(extension, "GL_NV_shading_rate_image") == 0) {
+                BindShadingRateImageNV = (PFNGLBINDSHADINGRATEIMAGENVPROC)getGlProcessAddress("glBindShadingRateImageNV");
+                ShadingRateImagePaletteNV = (PFNGLSHADINGRATEIMAGEPALETTENVPROC)getGlProcessAddress("glShadingRateImagePaletteNV");
+                break;
+            }
+        }
 #endif
     });
 }
 
+bool gl::hasShadingRateImage() {
+#if !defined(USE_GLES)
+    return BindShadingRateImageNV && ShadingRateImagePaletteNV;
+#else
+    return false;
+#endif
+}
+
+void gl::bindShadingRateImage(GLuint texture) {
+#if !defined(USE_GLES)
+    if (BindShadingRateImageNV) {
+        BindShadingRateImageNV(texture);
+    }
+#else
+    Q_UNUSED(texture);
+#endif
+}
+
+void gl::setShadingRateImagePalette(GLuint viewport, GLuint first, GLsizei count, const GLenum* rates) {
+#if !defined(USE_GLES)
+    if (ShadingRateImagePaletteNV) {
+        ShadingRateImagePaletteNV(viewport, first, count, rates);
+    }
+#else
+    Q_UNUSED(viewport);
+    Q_UNUSED(first);
+    Q_UNUSED(count);
+    Q_UNUSED(rates);
+#endif
+}
+
 int gl::getSwapInterval() {
 #if defined(Q_OS_WIN)
     return wglGetSwapIntervalEXT();
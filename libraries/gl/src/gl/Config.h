@@ -40,6 +40,21 @@
 #define GL_SLUMINANCE8_EXT 0x8C47
 #endif
 
+// NV_shading_rate_image, which glad isn't generated with
+#ifndef GL_SHADING_RATE_IMAGE_NV
+#define GL_SHADING_RATE_IMAGE_NV 0x9563
+#define GL_SHADING_RATE_1_INVOCATION_PER_PIXEL_NV 0x9565
+#define GL_SHADING_RATE_1_INVOCATION_PER_1X2_PIXELS_NV 0x9566
+#define GL_SHADING_RATE_1_INVOCATION_PER_2X1_PIXELS_NV 0x9567
+#define GL_SHADING_RATE_1_INVOCATION_PER_2X2_PIXELS_NV 0x9568
+#define GL_SHADING_RATE_1_INVOCATION_PER_2X4_PIXELS_NV 0x9569
+#define GL_SHADING_RATE_1_INVOCATION_PER_4X2_PIXELS_NV 0x956A
+#define GL_SHADING_RATE_1_INVOCATION_PER_4X4_PIXELS_NV 0x956B
+#define GL_SHADING_RATE_IMAGE_TEXEL_WIDTH_NV 0x955C
+#define GL_SHADING_RATE_IMAGE_TEXEL_HEIGHT_NV 0x955D
+#define GL_SHADING_RATE_IMAGE_PALETTE_SIZE_NV 0x955E
+#endif
+
 // Prevent inclusion of System GL headers
 #define __glext_h_
 #define __gl_h_
@@ -53,6 +68,11 @@ namespace gl {
     int getSwapInterval();
     void setSwapInterval(int swapInterval);
     bool queryCurrentRendererIntegerMESA(int attr, unsigned int *value);
+
+    // NV_shading_rate_image, false if the context doesn't have the extension, in which case the calls do nothing
+    bool hasShadingRateImage();
+    void bindShadingRateImage(GLuint texture);
+    void setShadingRateImagePalette(GLuint viewport, GLuint first, GLsizei count, const GLenum* rates);
 }
 
 #endif // hifi_gpu_GPUConfig_h
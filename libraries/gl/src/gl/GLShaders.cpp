@@ -436,8 +436,21 @@ const QString& getShaderCacheFile() {
 static const char* SHADER_JSON_TYPE_KEY = "type";
 static const char* SHADER_JSON_SOURCE_KEY = "source";
 static const char* SHADER_JSON_DATA_KEY = "data";
+static const char* SHADER_JSON_DRIVER_KEY = "driver";
+
+std::string gl::getDriverID() {
+    std::string driverID;
+    for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION }) {
+        const GLubyte* value = glGetString(name);
+        if (value) {
+            driverID += reinterpret_cast<const char*>(value);
+        }
+        driverID += "/";
+    }
+    return driverID;
+}
 
-void gl::loadShaderCache(ShaderCache& cache) {
+void gl::loadShaderCache(ShaderCache& cache, const std::string& driverID) {
 #if !defined(DISABLE_QML)
     QString shaderCacheFile = getShaderCacheFile();
     if (QFileInfo(shaderCacheFile).exists()) {
@@ -445,6 +458,10 @@ void gl::loadShaderCache(ShaderCache& cache) {
         auto root = QJsonDocument::fromJson(json.toUtf8()).object();
         for (const auto& qhash : root.keys()) {
             auto programObject = root[qhash].toObject();
+            if (programObject[SHADER_JSON_DRIVER_KEY].toString().toStdString() != driverID) {
+                // Built by another driver, or before a driver update
+                continue;
+            }
             QByteArray qbinary = QByteArray::fromBase64(programObject[SHADER_JSON_DATA_KEY].toString().toUtf8());
             std::string hash = qhash.toStdString();
             auto& cachedShader = cache[hash];
@@ -457,10 +474,11 @@ void gl::loadShaderCache(ShaderCache& cache) {
 #endif
 }
 
-void gl::saveShaderCache(const ShaderCache& cache) {
+void gl::saveShaderCache(const ShaderCache& cache, const std::string& driverID) {
     QByteArray json;
     {
         QVariantMap variantMap;
+        QString qdriverID = QString::fromStdString(driverID);
         for (const auto& entry : cache) {
             const auto& key = entry.first;
             const auto& type = entry.second.format;
@@ -469,6 +487,7 @@ void gl::saveShaderCache(const ShaderCache& cache) {
             qentry[SHADER_JSON_TYPE_KEY] = QVariant(type);
             qentry[SHADER_JSON_SOURCE_KEY] = QString(entry.second.source.c_str());
             qentry[SHADER_JSON_DATA_KEY] = QByteArray{ binary.data(), (int)binary.size() }.toBase64();
+            qentry[SHADER_JSON_DRIVER_KEY] = qdriverID;
             variantMap[key.c_str()] = qentry;
         }
         json = QJsonDocument::fromVariant(variantMap).toJson(QJsonDocument::Indented);
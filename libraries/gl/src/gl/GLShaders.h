@@ -92,8 +92,11 @@ struct CachedShader {
 using ShaderCache = std::unordered_map<std::string, CachedShader>;
 
 std::string getShaderHash(const std::string& shaderSource);
-void loadShaderCache(ShaderCache& cache);
-void saveShaderCache(const ShaderCache& cache);
+// Identifies the driver of the current context, program binaries are only valid for the driver that built them
+std::string getDriverID();
+// Only loads the binaries built by the driver identified by driverID
+void loadShaderCache(ShaderCache& cache, const std::string& driverID);
+void saveShaderCache(const ShaderCache& cache, const std::string& driverID);
 
 #ifdef SEPARATE_PROGRAM
 bool compileShader(GLenum shaderDomain,
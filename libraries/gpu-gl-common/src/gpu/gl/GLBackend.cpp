@@ -11,6 +11,7 @@
 #include "GLBackend.h"
 
 
+#include <algorithm>
 #include <mutex>
 #include <queue>
 #include <list>
@@ -57,6 +58,7 @@ GLBackend::CommandCall GLBackend::_commandCalls[Batch::NUM_COMMANDS] =
     (&::gpu::gl::GLBackend::do_setPipeline),
     (&::gpu::gl::GLBackend::do_setStateBlendFactor),
     (&::gpu::gl::GLBackend::do_setStateScissorRect),
+    (&::gpu::gl::GLBackend::do_setFoveation),
 
     (&::gpu::gl::GLBackend::do_setUniformBuffer),
     (&::gpu::gl::GLBackend::do_setResourceBuffer),
@@ -121,10 +123,13 @@ GLint GLBackend::GPU_MEMORY_INFO_DEDICATED_VIDMEM_NVX{ 0 };
 GLint GLBackend::GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX{ 0 };
 GLint GLBackend::GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX{ 0 };
 GLint GLBackend::TEXTURE_FREE_MEMORY_ATI{ 0 };
+GLint GLBackend::SHADING_RATE_IMAGE_TEXEL_WIDTH_NV{ 16 };
+GLint GLBackend::SHADING_RATE_IMAGE_TEXEL_HEIGHT_NV{ 16 };
 
 size_t GLBackend::_totalMemory{ 0 };
 size_t GLBackend::_dedicatedMemory{ 0 };
 GLBackend::VideoCardType GLBackend::_videoCard{ GLBackend::Unknown };
+bool GLBackend::_supportsASTC{ false };
 
 
 #define GLX_RENDERER_VIDEO_MEMORY_MESA 0x8187
@@ -148,6 +153,16 @@ void GLBackend::init() {
         GL_GET_INTEGER(MAX_UNIFORM_BLOCK_SIZE);
         GL_GET_INTEGER(UNIFORM_BUFFER_OFFSET_ALIGNMENT);
 
+        const auto& extensions = contextInfo.extensions;
+        _supportsASTC =
+            std::find(extensions.begin(), extensions.end(), "GL_KHR_texture_compression_astc_ldr") != extensions.end();
+
+        // Foveation
+        if (::gl::hasShadingRateImage()) {
+            GL_GET_INTEGER(SHADING_RATE_IMAGE_TEXEL_WIDTH_NV);
+            GL_GET_INTEGER(SHADING_RATE_IMAGE_TEXEL_HEIGHT_NV);
+        }
+
         GPUIdent* gpu = GPUIdent::getInstance(vendor, renderer);
         unsigned int mem;
 
@@ -221,6 +236,7 @@ void GLBackend::init() {
         qCDebug(gpugllogging) << "\tmax uniform binding:" << MAX_COMBINED_UNIFORM_BLOCKS;
         qCDebug(gpugllogging) << "\tmax uniform size:" << MAX_UNIFORM_BLOCK_SIZE;
         qCDebug(gpugllogging) << "\tuniform alignment:" << UNIFORM_BUFFER_OFFSET_ALIGNMENT;
+        qCDebug(gpugllogging) << "\tshading rate image:" << (::gl::hasShadingRateImage() ? "yes" : "no");
 #if !defined(USE_GLES)
         qCDebug(gpugllogging, "V-Sync is %s\n", (::gl::getSwapInterval() > 0 ? "ON" : "OFF"));
 #endif
@@ -287,6 +303,7 @@ void GLBackend::shutdown() {
     }
     killInput();
     killTransform();
+    killFoveationStage();
     killTextureManagementStage();
     killShaderBinaryCache();
 }
@@ -398,6 +415,9 @@ void GLBackend::renderPassDraw(const Batch& batch) {
 #endif 
                 // updates for draw calls
                 ++_currentDraw;
+                if (_pipeline._programPending) {
+                    break;
+                }
                 updateInput();
                 updateTransform(batch);
                 updatePipeline();
@@ -649,6 +669,7 @@ void GLBackend::resetStages() {
     resetResourceStage();
     resetOutputStage();
     resetQueryStage();
+    resetFoveationStage();
 
     (void) CHECK_GL_ERROR();
 }
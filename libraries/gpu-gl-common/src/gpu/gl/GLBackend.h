@@ -19,6 +19,7 @@
 #include <utility>
 #include <list>
 #include <array>
+#include <unordered_map>
 
 #include <QtCore/QLoggingCategory>
 
@@ -100,15 +101,19 @@ public:
     static GLint GPU_MEMORY_INFO_TOTAL_AVAILABLE_MEMORY_NVX;
     static GLint GPU_MEMORY_INFO_CURRENT_AVAILABLE_VIDMEM_NVX;
     static GLint TEXTURE_FREE_MEMORY_ATI;
+    static GLint SHADING_RATE_IMAGE_TEXEL_WIDTH_NV;
+    static GLint SHADING_RATE_IMAGE_TEXEL_HEIGHT_NV;
 
 
     static size_t _totalMemory;
     static size_t _dedicatedMemory;
     static VideoCardType _videoCard;
+    static bool _supportsASTC; // KHR_texture_compression_astc_ldr
 
 
     static size_t getTotalMemory() { return _totalMemory; }
     static size_t getDedicatedMemory() { return _dedicatedMemory; }
+    static bool supportsASTC() { return _supportsASTC; }
 
     static size_t getAvailableMemory();
     static bool availableMemoryKnown();
@@ -263,6 +268,8 @@ public:
     virtual void do_setStateBlendFactor(const Batch& batch, size_t paramOffset) final;
     virtual void do_setStateScissorRect(const Batch& batch, size_t paramOffset) final;
 
+    virtual void do_setFoveation(const Batch& batch, size_t paramOffset) final;
+
     virtual GLuint getFramebufferID(const FramebufferPointer& framebuffer) = 0;
     virtual GLuint getTextureID(const TexturePointer& texture) final;
     virtual GLuint getBufferID(const Buffer& buffer) = 0;
@@ -427,6 +434,10 @@ protected:
         GLuint _cameraBuffer{ 0 };
         GLuint _drawCallInfoBuffer{ 0 };
         GLuint _objectBufferTexture{ 0 };
+        // when the backend streams the current batch's cameras and draw call infos into buffers other than the ones above
+        mutable GLuint _streamedCameraBuffer{ 0 };
+        mutable size_t _streamedCameraOffset{ 0 };
+        mutable GLuint _streamedDrawCallInfoBuffer{ 0 };
         size_t _cameraUboSize{ 0 };
         bool _viewIsCamera{ false };
         bool _skybox{ false };
@@ -527,6 +538,8 @@ protected:
         bool _cameraCorrection{ false };
         GLShader* _programShader{ nullptr };
         bool _invalidProgram{ false };
+        // the pipeline set is waiting for the async shader compiler, the draws are skipped until another is set
+        bool _programPending{ false };
 
         BufferView _cameraCorrectionBuffer{ gpu::BufferView(std::make_shared<gpu::Buffer>(sizeof(CameraCorrection), nullptr)) };
         BufferView _cameraCorrectionBufferIdentity{ gpu::BufferView(
@@ -582,6 +595,23 @@ protected:
         uint32_t _rangeQueryDepth{ 0 };
     } _queryStage;
 
+    // Foveation goes through NV_shading_rate_image: one rate image per size of framebuffer drawn to while it's on,
+    // filled by the CPU for the eye centers and radii last asked for.
+    void syncFoveation();
+    void resetFoveationStage();
+    void killFoveationStage();
+    struct FoveationStageState {
+        struct RateImage {
+            GLuint _texture{ 0 };
+            bool _stale{ true };
+        };
+        Vec4 _eyeCenters{ 0.0f };
+        Vec2 _radii{ 0.0f };
+        bool _enabled{ false };
+        bool _active{ false }; // GL_SHADING_RATE_IMAGE_NV is on
+        std::unordered_map<uint64_t, RateImage> _rateImages; // by framebuffer width << 32 | height
+    } _foveation;
+
     void resetStages();
 
     // Stores cached binary versions of the shaders for quicker startup on subsequent runs
@@ -592,10 +622,20 @@ protected:
         std::mutex _mutex;
         std::vector<GLint> _formats;
         std::unordered_map<std::string, ::gl::CachedShader> _binaries;
+        // the binaries of other drivers are dropped when the cache is loaded
+        std::string _driverID;
     } _shaderBinaryCache;
 
     virtual void initShaderBinaryCache();
     virtual void killShaderBinaryCache();
+    void saveShaderBinaryCache();
+
+    // Compiles the programs queued with gpu::Shader::compileAsync on a context shared with the backend's, adding their
+    // binaries to the _shaderBinaryCache so that their GLShader::sync only has to load them
+    class ShaderCompileThread;
+    ShaderCompileThread* _shaderCompileThread{ nullptr };
+    // Returns the number of binaries added to the cache
+    size_t compileProgramBinaries(const Shader& program);
 
     struct TextureManagementStageState {
         bool _sparseCapable{ false };
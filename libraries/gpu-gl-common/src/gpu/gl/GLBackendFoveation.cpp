@@ -0,0 +1,127 @@
+//
+//  GLBackendFoveation.cpp
+//  libraries/gpu-gl-common/src/gpu/gl
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#include "GLBackend.h"
+
+#include <vector>
+
+#include <gpu/Framebuffer.h>
+
+using namespace gpu;
+using namespace gpu::gl;
+
+// The rates the rate images index into, from the center of the eyes' views out
+enum FoveationRate : uint8_t {
+    FOVEATION_RATE_FULL = 0,
+    FOVEATION_RATE_HALF,
+    FOVEATION_RATE_QUARTER,
+    NUM_FOVEATION_RATES
+};
+
+static const GLenum FOVEATION_RATE_PALETTE[NUM_FOVEATION_RATES] = {
+    GL_SHADING_RATE_1_INVOCATION_PER_PIXEL_NV,
+    GL_SHADING_RATE_1_INVOCATION_PER_2X2_PIXELS_NV,
+    GL_SHADING_RATE_1_INVOCATION_PER_4X4_PIXELS_NV,
+};
+
+static void fillRateImage(std::vector<uint8_t>& rates, uint32_t width, uint32_t height, uint32_t tilesWide, uint32_t tilesHigh,
+                          const Vec4& eyeCenters, const Vec2& radii) {
+    rates.resize(tilesWide * tilesHigh);
+    float eyeWidth = 0.5f * (float)width;
+    float texelWidth = (float)width / (float)tilesWide;
+    float texelHeight = (float)height / (float)tilesHigh;
+    for (uint32_t y = 0; y < tilesHigh; ++y) {
+        float v = 2.0f * ((float)y + 0.5f) * texelHeight / (float)height - 1.0f;
+        for (uint32_t x = 0; x < tilesWide; ++x) {
+            float pixelX = ((float)x + 0.5f) * texelWidth;
+            bool isRightEye = pixelX >= eyeWidth;
+            float u = 2.0f * (pixelX - (isRightEye ? eyeWidth : 0.0f)) / eyeWidth - 1.0f;
+            Vec2 center = isRightEye ? Vec2(eyeCenters.z, eyeCenters.w) : Vec2(eyeCenters.x, eyeCenters.y);
+
+            float distance = glm::length(Vec2(u, v) - center);
+            uint8_t rate = FOVEATION_RATE_QUARTER;
+            if (distance < radii.x) {
+                rate = FOVEATION_RATE_FULL;
+            } else if (distance < radii.y) {
+                rate = FOVEATION_RATE_HALF;
+            }
+            rates[y * tilesWide + x] = rate;
+        }
+    }
+}
+
+void GLBackend::do_setFoveation(const Batch& batch, size_t paramOffset) {
+    Vec4 eyeCenters;
+    Vec2 radii;
+    memcpy(glm::value_ptr(eyeCenters), batch.readData(batch._params[paramOffset + 0]._uint), sizeof(Vec4));
+    memcpy(glm::value_ptr(radii), batch.readData(batch._params[paramOffset + 1]._uint), sizeof(Vec2));
+
+    bool enabled = radii.y > 0.0f && ::gl::hasShadingRateImage();
+    if (enabled && (eyeCenters != _foveation._eyeCenters || radii != _foveation._radii)) {
+        _foveation._eyeCenters = eyeCenters;
+        _foveation._radii = radii;
+        for (auto& rateImage : _foveation._rateImages) {
+            rateImage.second._stale = true;
+        }
+    }
+    _foveation._enabled = enabled;
+    syncFoveation();
+}
+
+void GLBackend::syncFoveation() {
+    auto framebuffer = acquire(_output._framebuffer);
+    // the default framebuffer is the display's, which the scene isn't drawn to
+    if (!_foveation._enabled || !framebuffer) {
+        if (_foveation._active) {
+            glDisable(GL_SHADING_RATE_IMAGE_NV);
+            _foveation._active = false;
+        }
+        return;
+    }
+
+    uint32_t width = framebuffer->getWidth();
+    uint32_t height = framebuffer->getHeight();
+    auto& rateImage = _foveation._rateImages[((uint64_t)width << 32) | height];
+    uint32_t tilesWide = (width + SHADING_RATE_IMAGE_TEXEL_WIDTH_NV - 1) / SHADING_RATE_IMAGE_TEXEL_WIDTH_NV;
+    uint32_t tilesHigh = (height + SHADING_RATE_IMAGE_TEXEL_HEIGHT_NV - 1) / SHADING_RATE_IMAGE_TEXEL_HEIGHT_NV;
+    if (!rateImage._texture) {
+        // the extension only comes with drivers that have direct state access, which leaves the texture units alone
+        glCreateTextures(GL_TEXTURE_2D, 1, &rateImage._texture);
+        glTextureStorage2D(rateImage._texture, 1, GL_R8UI, tilesWide, tilesHigh);
+    }
+    if (rateImage._stale) {
+        static std::vector<uint8_t> rates;
+        fillRateImage(rates, width, height, tilesWide, tilesHigh, _foveation._eyeCenters, _foveation._radii);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTextureSubImage2D(rateImage._texture, 0, 0, 0, tilesWide, tilesHigh, GL_RED_INTEGER, GL_UNSIGNED_BYTE, rates.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        rateImage._stale = false;
+    }
+
+    ::gl::bindShadingRateImage(rateImage._texture);
+    if (!_foveation._active) {
+        ::gl::setShadingRateImagePalette(0, 0, NUM_FOVEATION_RATES, FOVEATION_RATE_PALETTE);
+        glEnable(GL_SHADING_RATE_IMAGE_NV);
+        _foveation._active = true;
+    }
+    (void)CHECK_GL_ERROR();
+}
+
+void GLBackend::resetFoveationStage() {
+    _foveation._enabled = false;
+    syncFoveation();
+}
+
+void GLBackend::killFoveationStage() {
+    for (auto& rateImage : _foveation._rateImages) {
+        glDeleteTextures(1, &rateImage.second._texture);
+    }
+    _foveation._rateImages.clear();
+}
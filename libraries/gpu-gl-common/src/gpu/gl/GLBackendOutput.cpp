@@ -62,6 +62,9 @@ void GLBackend::setFramebuffer(const FramebufferPointer& framebuffer) {
             glBindFramebuffer(GL_DRAW_FRAMEBUFFER, newFBO);
         }
         assign(_output._framebuffer, framebuffer);
+        if (_foveation._enabled) {
+            syncFoveation();
+        }
     }
 }
 
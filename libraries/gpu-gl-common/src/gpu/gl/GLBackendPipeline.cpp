@@ -25,7 +25,11 @@ using namespace gpu::gl;
 void GLBackend::do_setPipeline(const Batch& batch, size_t paramOffset) {
     const auto& pipeline = batch._pipelines.get(batch._params[paramOffset + 0]._uint);
 
-    if (compare(_pipeline._pipeline, pipeline)) {
+    // A program still compiled by the async compiler is treated like a null pipeline, but its draws are skipped
+    bool programPending = pipeline && pipeline->getProgram() && pipeline->getProgram()->skipsDrawsUntilReady();
+    _pipeline._programPending = programPending;
+
+    if (!programPending && compare(_pipeline._pipeline, pipeline)) {
         return;
     }
 
@@ -33,7 +37,7 @@ void GLBackend::do_setPipeline(const Batch& batch, size_t paramOffset) {
     _stats._PSNumSetPipelines++;
 
     // null pipeline == reset
-    if (!pipeline) {
+    if (!pipeline || programPending) {
         reset(_pipeline._pipeline);
 
         _pipeline._program = 0;
@@ -132,6 +136,7 @@ void GLBackend::resetPipelineStage() {
 
     // Second the shader side
     _pipeline._invalidProgram = false;
+    _pipeline._programPending = false;
     _pipeline._program = 0;
     _pipeline._programShader = nullptr;
     reset(_pipeline._pipeline);
@@ -8,6 +8,14 @@
 #include "GLBackend.h"
 #include "GLShader.h"
 #include <gl/GLShaders.h>
+#include <gl/OffscreenGLCanvas.h>
+
+#include <condition_variable>
+#include <deque>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QThread>
+#include <QtGui/QOpenGLContext>
 
 using namespace gpu;
 using namespace gpu::gl;
@@ -390,6 +398,151 @@ GLBackend::ElementResource GLBackend::getFormatFromGLUniform(GLenum gltype) {
     //{GL_UNSIGNED_INT_ATOMIC_COUNTER    atomic_uint}
 };
 
+class GLBackend::ShaderCompileThread : public QThread {
+public:
+    // Must be called with the backend's context current, on the thread that context was created on
+    ShaderCompileThread(GLBackend& backend) : _backend(backend) {
+        setObjectName("ShaderCompile");
+        auto sharedContext = QOpenGLContext::currentContext();
+        auto sharedSurface = sharedContext->surface();
+        _canvas = new OffscreenGLCanvas();
+        _canvas->setObjectName("ShaderCompileContext");
+        _canvas->create(sharedContext);
+        // create() released the shared context
+        sharedContext->makeCurrent(sharedSurface);
+        _canvas->moveToThreadWithContext(this);
+    }
+
+    ~ShaderCompileThread() {
+        // the canvas is current while it's destroyed
+        auto currentContext = QOpenGLContext::currentContext();
+        auto currentSurface = currentContext ? currentContext->surface() : nullptr;
+        delete _canvas;
+        if (currentContext) {
+            currentContext->makeCurrent(currentSurface);
+        }
+    }
+
+    void push(const ShaderPointer& program) {
+        Lock lock(_mutex);
+        _queue.push_back(program);
+        _condition.notify_one();
+    }
+
+    void shutdown() {
+        {
+            Lock lock(_mutex);
+            _shutdown = true;
+        }
+        _condition.notify_one();
+        wait();
+    }
+
+protected:
+    void run() override {
+        if (!_canvas->makeCurrent()) {
+            qCWarning(gpugllogging) << "GLBackend::ShaderCompileThread - Unable to make the shader compile context current";
+        }
+
+        size_t numNewBinaries = 0;
+        while (true) {
+            std::weak_ptr<Shader> next;
+            {
+                Lock lock(_mutex);
+                if (_queue.empty() && numNewBinaries != 0) {
+                    // Save the cache whenever a batch of programs is done, not only on shutdown
+                    lock.unlock();
+                    _backend.saveShaderBinaryCache();
+                    numNewBinaries = 0;
+                    continue;
+                }
+                _condition.wait(lock, [&] { return _shutdown || !_queue.empty(); });
+                if (_shutdown) {
+                    break;
+                }
+                next = _queue.front();
+                _queue.pop_front();
+            }
+
+            auto program = next.lock();
+            if (program) {
+                numNewBinaries += _backend.compileProgramBinaries(*program);
+                program->setReady(true);
+            }
+        }
+
+        // Nothing must wait on the programs that weren't compiled
+        for (const auto& weakProgram : _queue) {
+            auto program = weakProgram.lock();
+            if (program) {
+                program->setReady(true);
+            }
+        }
+        _queue.clear();
+
+        _canvas->doneCurrent();
+        _canvas->moveToThreadWithContext(qApp->thread());
+    }
+
+private:
+    GLBackend& _backend;
+    OffscreenGLCanvas* _canvas{ nullptr };
+    Mutex _mutex;
+    std::condition_variable _condition;
+    std::deque<std::weak_ptr<Shader>> _queue;
+    bool _shutdown{ false };
+};
+
+size_t GLBackend::compileProgramBinaries(const Shader& program) {
+    size_t numNewBinaries = 0;
+    for (const auto& variant : shader::allVariants()) {
+        auto programSource = getShaderSource(program, variant);
+        auto hash = ::gl::getShaderHash(programSource);
+        {
+            Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+            if (_shaderBinaryCache._binaries.count(hash) != 0) {
+                continue;
+            }
+        }
+
+        // Same as compileBackendShader and compileBackendProgram, without the GLShaders that need the backend's thread
+        bool compiled = true;
+        std::string message;
+        std::vector<GLuint> shaderGLObjects;
+        for (const auto& subShader : program.getShaders()) {
+            GLuint glshader = 0;
+            auto shaderSource = subShader->getSource().getSource(getShaderDialect(), variant);
+            if (!::gl::compileShader(SHADER_DOMAINS[subShader->getType()], shaderSource, glshader, message)) {
+                compiled = false;
+                break;
+            }
+            shaderGLObjects.push_back(glshader);
+        }
+
+        if (compiled) {
+            GLuint glprogram = ::gl::buildProgram(shaderGLObjects);
+            if (glprogram != 0 && ::gl::linkProgram(glprogram, message)) {
+                CachedShader cachedBinary;
+                ::gl::getProgramBinary(glprogram, cachedBinary);
+                cachedBinary.source = programSource;
+                if (cachedBinary) {
+                    Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+                    _shaderBinaryCache._binaries[hash] = cachedBinary;
+                    ++numNewBinaries;
+                }
+            }
+            if (glprogram != 0) {
+                glDeleteProgram(glprogram);
+            }
+        }
+        for (auto glshader : shaderGLObjects) {
+            glDeleteShader(glshader);
+        }
+        // Failures are left to the backend's thread to report, when the program is first used
+    }
+    return numNewBinaries;
+}
+
 void GLBackend::initShaderBinaryCache() {
     GLint numBinFormats = 0;
     glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numBinFormats);
@@ -397,10 +550,35 @@ void GLBackend::initShaderBinaryCache() {
         _shaderBinaryCache._formats.resize(numBinFormats);
         glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, _shaderBinaryCache._formats.data());
     }
-    ::gl::loadShaderCache(_shaderBinaryCache._binaries);
+    _shaderBinaryCache._driverID = ::gl::getDriverID();
+    ::gl::loadShaderCache(_shaderBinaryCache._binaries, _shaderBinaryCache._driverID);
+
+    // Without binary formats there is nothing for the compile thread to hand over
+    if (numBinFormats > 0 && QOpenGLContext::currentContext()) {
+        _shaderCompileThread = new ShaderCompileThread(*this);
+        _shaderCompileThread->start();
+        Shader::setAsyncCompiler([this](const ShaderPointer& program) {
+            _shaderCompileThread->push(program);
+        });
+    }
 }
 
 void GLBackend::killShaderBinaryCache() {
-    ::gl::saveShaderCache(_shaderBinaryCache._binaries);
+    if (_shaderCompileThread) {
+        Shader::setAsyncCompiler(nullptr);
+        _shaderCompileThread->shutdown();
+        delete _shaderCompileThread;
+        _shaderCompileThread = nullptr;
+    }
+    saveShaderBinaryCache();
+}
+
+void GLBackend::saveShaderBinaryCache() {
+    ::gl::ShaderCache binaries;
+    {
+        Lock shaderCacheLock{ _shaderBinaryCache._mutex };
+        binaries = _shaderBinaryCache._binaries;
+    }
+    ::gl::saveShaderCache(binaries, _shaderBinaryCache._driverID);
 }
 
@@ -169,7 +169,9 @@ void GLBackend::TransformStageState::update(size_t commandIndex, const StereoSta
 void GLBackend::TransformStageState::bindCurrentCamera(int eye) const {
     if (_currentCameraOffset != INVALID_OFFSET) {
         static_assert(slot::buffer::Buffer::CameraTransform >= MAX_NUM_UNIFORM_BUFFERS, "TransformCamera may overlap pipeline uniform buffer slots. Invalidate uniform buffer slot cache for safety (call _uniform._buffers[TRANSFORM_CAMERA_SLOT].reset()).");
-        glBindBufferRange(GL_UNIFORM_BUFFER, slot::buffer::Buffer::CameraTransform, _cameraBuffer, _currentCameraOffset + eye * _cameraUboSize, sizeof(CameraBufferElement));
+        GLuint cameraBuffer = _streamedCameraBuffer ? _streamedCameraBuffer : _cameraBuffer;
+        glBindBufferRange(GL_UNIFORM_BUFFER, slot::buffer::Buffer::CameraTransform, cameraBuffer,
+                          _streamedCameraOffset + _currentCameraOffset + eye * _cameraUboSize, sizeof(CameraBufferElement));
     }
 }
 
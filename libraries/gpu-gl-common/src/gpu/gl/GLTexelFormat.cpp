@@ -31,6 +31,10 @@ using namespace gpu::gl;
 #define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
 #define GL_COMPRESSED_RGB_BPTC_SIGNED_FLOAT 0x8E8E
 #define GL_COMPRESSED_RGB_BPTC_UNSIGNED_FLOAT 0x8E8F
+#else
+// KHR_texture_compression_astc_ldr, which glad isn't generated with
+#define GL_COMPRESSED_RGBA_ASTC_4x4 0x93B0
+#define GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4 0x93D0
 #endif
 
 bool GLTexelFormat::isCompressed(GLenum format) {
@@ -83,6 +87,9 @@ bool GLTexelFormat::isCompressed(GLenum format) {
         case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_10x10:
         case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x10:
         case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_12x12:
+#else
+        case GL_COMPRESSED_RGBA_ASTC_4x4:
+        case GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4:
 #endif
 
 
@@ -407,6 +414,12 @@ GLenum GLTexelFormat::evalGLTexelFormatInternal(const gpu::Element& dstFormat) {
                 case gpu::COMPRESSED_EAC_XY_SIGNED:
                     result = GL_COMPRESSED_SIGNED_RG11_EAC;
                     break;
+                case gpu::COMPRESSED_ASTC_RGBA:
+                    result = GL_COMPRESSED_RGBA_ASTC_4x4;
+                    break;
+                case gpu::COMPRESSED_ASTC_SRGBA:
+                    result = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4;
+                    break;
                 default:
                     qCWarning(gpugllogging) << "Unknown combination of texel format";
             }
@@ -597,6 +610,12 @@ GLTexelFormat GLTexelFormat::evalGLTexelFormat(const Element& dstFormat, const E
             case gpu::COMPRESSED_EAC_XY_SIGNED:
                 texel.internalFormat = GL_COMPRESSED_SIGNED_RG11_EAC;
                 break;
+            case gpu::COMPRESSED_ASTC_RGBA:
+                texel.internalFormat = GL_COMPRESSED_RGBA_ASTC_4x4;
+                break;
+            case gpu::COMPRESSED_ASTC_SRGBA:
+                texel.internalFormat = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4;
+                break;
             default:
                 qCWarning(gpugllogging) << "Unknown combination of texel format";
             }
@@ -994,6 +1013,12 @@ GLTexelFormat GLTexelFormat::evalGLTexelFormat(const Element& dstFormat, const E
             case gpu::COMPRESSED_EAC_XY_SIGNED:
                 texel.internalFormat = GL_COMPRESSED_SIGNED_RG11_EAC;
                 break;
+            case gpu::COMPRESSED_ASTC_RGBA:
+                texel.internalFormat = GL_COMPRESSED_RGBA_ASTC_4x4;
+                break;
+            case gpu::COMPRESSED_ASTC_SRGBA:
+                texel.internalFormat = GL_COMPRESSED_SRGB8_ALPHA8_ASTC_4x4;
+                break;
             default:
                 qCWarning(gpugllogging) << "Unknown combination of texel format";
             }
@@ -213,6 +213,29 @@ void GLVariableAllocationSupport::decrementPopulatedSize(Size delta) const {
     }
 }
 
+// The fraction of a texture's screen size that's kept each frame it's not drawn that large
+static const float SCREEN_SIZE_DECAY = 0.99f;
+
+void GLVariableAllocationSupport::updateScreenSize(Texture& texture) {
+    float reportedSize = texture.takeScreenSize();
+    if (reportedSize > 0.0f) {
+        _hasScreenSize = true;
+    }
+    if (!_hasScreenSize) {
+        return;
+    }
+
+    _screenSize = std::max(reportedSize, _screenSize * SCREEN_SIZE_DECAY);
+    // assumes the texture is mapped once over what it was drawn on, so its texels span the screen size
+    int maxMip = texture.getMaxMip();
+    int neededMip = maxMip;
+    if (_screenSize >= 1.0f) {
+        float maxDimension = (float)std::max(texture.getWidth(), texture.getHeight());
+        neededMip = (int)floorf(log2f(maxDimension / _screenSize));
+    }
+    _neededMip = (uint16)glm::clamp(neededMip, 0, maxMip);
+}
+
 void GLVariableAllocationSupport::sanityCheck() const {
     if (_populatedMip < _allocatedMip) {
         qCWarning(gpugllogging) << "Invalid mip levels";
@@ -109,6 +109,14 @@ public:
     virtual size_t promote() = 0;
     virtual size_t demote() = 0;
 
+    // Takes the screen size reported for the texture since the last frame, keeping a decaying maximum of it so that a
+    // texture that's briefly out of view doesn't lose its finer mips first
+    void updateScreenSize(Texture& texture);
+    bool hasScreenSize() const { return _hasScreenSize; }
+    // How many mips finer than its allocated ones the texture needs on screen, negative when it holds finer mips than it
+    // needs, or 0 when nothing that reports its screen size has drawn it
+    int getMipDeficit() const { return _hasScreenSize ? (int)_allocatedMip - (int)std::max(_neededMip, _minAllocatedMip) : 0; }
+
     static const uvec3 MAX_TRANSFER_DIMENSIONS;
     static const uvec3 INITIAL_MIP_TRANSFER_DIMENSIONS;
     static const size_t MAX_TRANSFER_SIZE;
@@ -136,6 +144,11 @@ protected:
     // The lowest (highest resolution) mip that we will support, relative to the number
     // of mips in the gpu::Texture object
     uint16 _minAllocatedMip { 0 };
+    // The mip with as many texels across as the texture covers on screen, relative to the number of mips in the
+    // gpu::Texture object
+    uint16 _neededMip { 0 };
+    float _screenSize { 0.0f };
+    bool _hasScreenSize { false };
 };
 
 class GLTexture : public GLObject<Texture> {
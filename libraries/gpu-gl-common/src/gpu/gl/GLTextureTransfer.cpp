@@ -17,11 +17,27 @@
 
 #define OVERSUBSCRIBED_PRESSURE_VALUE 0.95f
 #define UNDERSUBSCRIBED_PRESSURE_VALUE 0.85f
+// Textures are only given finer mips than they need on screen while the pressure is below this, leaving room for the
+// ones that come into view
+#define TARGET_RESIDENCY_PRESSURE_VALUE 0.6f
+#if defined(USE_GLES)
+// Mobile GPUs share their memory with everything else on the device
+#define DEFAULT_ALLOWED_TEXTURE_MEMORY_MB ((size_t)512)
+#define MAX_AUTO_FRACTION_OF_TOTAL_MEMORY 0.5f
+#else
 #define DEFAULT_ALLOWED_TEXTURE_MEMORY_MB ((size_t)2048)
+#define MAX_AUTO_FRACTION_OF_TOTAL_MEMORY 0.8f
+#endif
+// The texture data uploaded per frame, past the first transfer, so that a burst of loads is spread over a few frames
+// instead of dropping one. Desktop GPUs upload all that gets buffered in a frame.
+#if defined(USE_GLES)
+#define MAX_TRANSFER_SIZE_PER_FRAME MB_TO_BYTES(2)
+#else
+#define MAX_TRANSFER_SIZE_PER_FRAME MB_TO_BYTES(16)
+#endif
 #define MAX_RESOURCE_TEXTURES_PER_FRAME 2
 #define NO_BUFFER_WORK_SLEEP_TIME_MS 2
 #define THREADED_TEXTURE_BUFFERING 1
-#define MAX_AUTO_FRACTION_OF_TOTAL_MEMORY 0.8f
 #define AUTO_RESERVE_TEXTURE_MEMORY MB_TO_BYTES(64)
 
 static const size_t DEFAULT_ALLOWED_TEXTURE_MEMORY = MB_TO_BYTES(DEFAULT_ALLOWED_TEXTURE_MEMORY_MB);
@@ -54,6 +70,26 @@ using ImmediateWorkQueue = std::priority_queue<ImmediateQueuePair, std::vector<I
 // A map of weak texture pointers to queues of work to be done to transfer their data from the backing store to the GPU
 using TransferMap = std::map<TextureWeakPointer, TransferQueue, std::owner_less<TextureWeakPointer>>;
 
+// Textures that need finer mips on screen are promoted first, those that need the most mips first, followed by the
+// ones whose screen size isn't known and then the ones that already have what they need. Ties go to the smallest.
+static float evalPromotePriority(const GLTexture& gltexture, const GLVariableAllocationSupport& vartexture) {
+    return (float)vartexture.getMipDeficit() + 1.0f / (float)(gltexture.size() + 1);
+}
+
+// Textures holding the most mips finer than they need on screen are demoted first, ties going to the largest
+static float evalDemotePriority(const GLTexture& gltexture, const GLVariableAllocationSupport& vartexture, size_t totalSize) {
+    return (float)-vartexture.getMipDeficit() + (float)gltexture.size() / (float)(totalSize + 1);
+}
+
+// roughly the memory held by the mips finer than the texture needs, each mip being a quarter of the size of the one before
+static size_t evalOverResolvedSize(const GLTexture& gltexture, const GLVariableAllocationSupport& vartexture) {
+    int surplus = std::min(-vartexture.getMipDeficit(), 16);
+    if (surplus <= 0) {
+        return 0;
+    }
+    return gltexture.size() - (gltexture.size() >> (2 * surplus));
+}
+
 class GLTextureTransferEngineDefault : public GLTextureTransferEngine {
     using Parent = GLTextureTransferEngine;
 
@@ -90,11 +126,14 @@ protected:
     //void addToWorkQueue(const TexturePointer& texturePointer);
     void updateMemoryPressure();
 
-    void processDemotes(size_t relief, const std::vector<TexturePointer>& strongTextures);
+    void processDemotes(size_t relief, const std::vector<TexturePointer>& strongTextures, bool onlyOverResolved = false);
     void processPromotes();
+    bool shouldPromote(const GLVariableAllocationSupport& vartexture) const;
 
 private:
     std::atomic<bool> _shutdown{ false };
+    // The fraction of the allowed memory in use as of the last frame
+    float _pressure { 0.0f };
     // Contains a priority sorted list of weak texture pointers that have been determined to be eligible for additional allocation
     // While the memory state is 'undersubscribed', items will be removed from this list and processed, allocating additional memory
     // per frame
@@ -113,6 +152,8 @@ private:
     TextureBufferThread* _transferThread{ nullptr };
     // The amount of buffering work currently represented by the _activeBufferQueue
     std::atomic<size_t> _queuedBufferSize{ 0 };
+    // The buffered jobs left over from the last frame once it had uploaded MAX_TRANSFER_SIZE_PER_FRAME, which go first
+    ActiveTransferQueue _deferredTransferQueue;
     // This contains a map of all textures to queues of pending transfer jobs.  While in the transfer state, this map is used to
     // populate the _activeBufferQueue up to the limit specified in GLVariableAllocationTexture::MAX_BUFFER_SIZE
     TransferMap _pendingTransfersMap;
@@ -213,23 +254,37 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
 
     size_t totalVariableMemoryAllocation = 0;
     size_t idealMemoryAllocation = 0;
+    size_t overResolvedMemoryAllocation = 0;
+    uint32_t underResolvedCount = 0;
     bool canDemote = false;
-    bool canPromote = false;
+    bool canDemoteOverResolved = false;
+    bool canPromoteUnderResolved = false;
+    bool canPromoteWithoutScreenSize = false;
+    bool canPromoteAny = false;
     bool hasTransfers = false;
     for (const auto& texture : strongTextures) {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vartexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
         vartexture->sanityCheck();
+        vartexture->updateScreenSize(*texture);
+        int mipDeficit = vartexture->getMipDeficit();
 
         // Track how much the texture thinks it should be using
         idealMemoryAllocation += texture->evalTotalSize();
         // Track how much we're actually using
         totalVariableMemoryAllocation += gltexture->size();
+        overResolvedMemoryAllocation += evalOverResolvedSize(*gltexture, *vartexture);
+        if (mipDeficit > 0) {
+            ++underResolvedCount;
+        }
         if (!gltexture->_gpuObject.getImportant() && vartexture->canDemote()) {
             canDemote |= true;
+            canDemoteOverResolved |= (mipDeficit < 0);
         }
         if (vartexture->canPromote()) {
-            canPromote |= true;
+            canPromoteAny |= true;
+            canPromoteUnderResolved |= (mipDeficit > 0);
+            canPromoteWithoutScreenSize |= !vartexture->hasScreenSize();
         }
         if (vartexture->hasPendingTransfers()) {
             hasTransfers |= true;
@@ -237,6 +292,8 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
     }
 
     Backend::textureResourceIdealGPUMemSize.set(idealMemoryAllocation);
+    Backend::textureResourceUnderResolvedCount.set(underResolvedCount);
+    Backend::textureResourceOverResolvedGPUMemSize.set(overResolvedMemoryAllocation);
     size_t unallocated = idealMemoryAllocation - totalVariableMemoryAllocation;
     float pressure = 0;
 
@@ -255,6 +312,8 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
         pressure = (float)totalVariableMemoryAllocation / (float)allowedMemoryAllocation;
     }
 
+    _pressure = pressure;
+
     // If we're oversubscribed we need to demote textures IMMEDIATELY
     if (pressure > OVERSUBSCRIBED_PRESSURE_VALUE && canDemote) {
         auto overPressure = pressure - OVERSUBSCRIBED_PRESSURE_VALUE;
@@ -263,6 +322,14 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
         return;
     }
 
+    // Without room to promote the textures that look blurry on screen, make some from the mips others don't need
+    if (pressure >= UNDERSUBSCRIBED_PRESSURE_VALUE && canPromoteUnderResolved && canDemoteOverResolved) {
+        processDemotes(GLVariableAllocationSupport::MAX_BUFFER_SIZE, strongTextures, true);
+        return;
+    }
+
+    bool canPromote = canPromoteUnderResolved || canPromoteWithoutScreenSize ||
+        (canPromoteAny && pressure < TARGET_RESIDENCY_PRESSURE_VALUE);
     auto newState = MemoryPressureState::Idle;
     if (pressure < UNDERSUBSCRIBED_PRESSURE_VALUE && (unallocated != 0 && canPromote)) {
         newState = MemoryPressureState::Undersubscribed;
@@ -270,7 +337,8 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
         newState = MemoryPressureState::Transfer;
     } else {
         Lock lock(_bufferMutex);
-        if (!_activeBufferQueue.empty() || !_activeTransferQueue.empty() || !_pendingTransfersMap.empty()) {
+        if (!_activeBufferQueue.empty() || !_activeTransferQueue.empty() || !_pendingTransfersMap.empty() ||
+            !_deferredTransferQueue.empty()) {
             newState = MemoryPressureState::Transfer;
         }
     }
@@ -280,6 +348,8 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
         _memoryPressureState = newState;
         _promoteQueue = WorkQueue();
         _pendingTransfersMap.clear();
+        // their target mips may not be there after promotions and demotions, they're queued again from the populated mip
+        _deferredTransferQueue.clear();
 
         if (MemoryPressureState::Idle == _memoryPressureState) {
             return;
@@ -289,9 +359,8 @@ void GLTextureTransferEngineDefault::updateMemoryPressure() {
         for (const auto& texture : strongTextures) {
             GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
             GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
-            if (MemoryPressureState::Undersubscribed == _memoryPressureState && vargltexture->canPromote()) {
-                // Promote smallest first
-                _promoteQueue.push({ texture, 1.0f / (float)gltexture->size() });
+            if (MemoryPressureState::Undersubscribed == _memoryPressureState && shouldPromote(*vargltexture)) {
+                _promoteQueue.push({ texture, evalPromotePriority(*gltexture, *vargltexture) });
             } else if (MemoryPressureState::Transfer == _memoryPressureState && vargltexture->hasPendingTransfers()) {
                 populateTransferQueue(texture);
             }
@@ -316,28 +385,39 @@ void GLTextureTransferEngineDefault::processTransferQueues() {
     // while the background thread is working.
     //
     // This will queue jobs until _queuedBufferSize can't be increased without exceeding
-    // GLVariableAllocationTexture::MAX_BUFFER_SIZE or there is no more work to be done
-    populateActiveBufferQueue();
+    // GLVariableAllocationTexture::MAX_BUFFER_SIZE or there is no more work to be done.
+    // Nothing more is buffered while the uploads are behind.
+    if (_deferredTransferQueue.empty()) {
+        populateActiveBufferQueue();
+    }
 #if !THREADED_TEXTURE_BUFFERING
     processActiveBufferQueue();
 #endif
 
     // Take any tasks which have completed buffering and process them, uploading the buffered
-    // data to the GPU.  Drains the _activeTransferQueue
+    // data to the GPU, up to MAX_TRANSFER_SIZE_PER_FRAME.  Drains the _activeTransferQueue
     {
         ActiveTransferQueue activeTransferQueue;
+        activeTransferQueue.swap(_deferredTransferQueue);
         {
             Lock lock(_bufferMutex);
-            activeTransferQueue.swap(_activeTransferQueue);
+            activeTransferQueue.splice(activeTransferQueue.end(), _activeTransferQueue);
         }
 
+        size_t transferredSize = 0;
         while (!activeTransferQueue.empty()) {
+            if (transferredSize >= MAX_TRANSFER_SIZE_PER_FRAME) {
+                _deferredTransferQueue.swap(activeTransferQueue);
+                break;
+            }
+
             const auto& activeTransferJob = activeTransferQueue.front();
             const auto& texturePointer = activeTransferJob.first;
             GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texturePointer);
             GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
             const auto& tranferJob = activeTransferJob.second;
             if (tranferJob->sourceMip() < vargltexture->populatedMip()) {
+                transferredSize += tranferJob->size();
                 tranferJob->transfer(texturePointer);
             }
             // The pop_front MUST be the last call since all of these varaibles in scope are
@@ -350,7 +430,8 @@ void GLTextureTransferEngineDefault::processTransferQueues() {
     // force reconstruction of the _pendingTransfersMap if necessary
     {
         Lock lock(_bufferMutex);
-        if (_activeTransferQueue.empty() && _activeBufferQueue.empty() && _pendingTransfersMap.empty()) {
+        if (_activeTransferQueue.empty() && _activeBufferQueue.empty() && _pendingTransfersMap.empty() &&
+            _deferredTransferQueue.empty()) {
             _memoryPressureState = MemoryPressureState::Idle;
         }
     }
@@ -483,9 +564,8 @@ void GLTextureTransferEngineDefault::processPromotes() {
         auto originalSize = gltexture->size();
         vartexture->promote();
         auto allocationDelta = gltexture->size() - originalSize;
-        if (vartexture->canPromote()) {
-            // Promote smallest first
-            _promoteQueue.push({ texture, 1.0f / (float)gltexture->size() });
+        if (shouldPromote(*vartexture)) {
+            _promoteQueue.push({ texture, evalPromotePriority(*gltexture, *vartexture) });
         }
         allocatedBytes += allocationDelta;
         if (++allocations >= MAX_ALLOCATIONS_PER_FRAME) {
@@ -503,14 +583,30 @@ void GLTextureTransferEngineDefault::processPromotes() {
     }
 }
 
-void GLTextureTransferEngineDefault::processDemotes(size_t reliefRequired, const std::vector<TexturePointer>& strongTextures) {
-    // Demote largest first
+bool GLTextureTransferEngineDefault::shouldPromote(const GLVariableAllocationSupport& vartexture) const {
+    if (!vartexture.canPromote()) {
+        return false;
+    }
+    // Finer mips than a texture needs on screen may only take memory up to the target residency
+    return vartexture.getMipDeficit() > 0 || !vartexture.hasScreenSize() || _pressure < TARGET_RESIDENCY_PRESSURE_VALUE;
+}
+
+void GLTextureTransferEngineDefault::processDemotes(size_t reliefRequired, const std::vector<TexturePointer>& strongTextures,
+                                                    bool onlyOverResolved) {
+    size_t totalSize = 0;
+    for (const auto& texture : strongTextures) {
+        totalSize += Backend::getGPUObject<GLTexture>(*texture)->size();
+    }
+
     ImmediateWorkQueue demoteQueue;
     for (const auto& texture : strongTextures) {
         GLTexture* gltexture = Backend::getGPUObject<GLTexture>(*texture);
         GLVariableAllocationSupport* vargltexture = dynamic_cast<GLVariableAllocationSupport*>(gltexture);
+        if (onlyOverResolved && vargltexture->getMipDeficit() >= 0) {
+            continue;
+        }
         if (!gltexture->_gpuObject.getImportant() && vargltexture->canDemote()) {
-            demoteQueue.push({ texture, (float)gltexture->size() });
+            demoteQueue.push({ texture, evalDemotePriority(*gltexture, *vargltexture, totalSize) });
         }
     }
 
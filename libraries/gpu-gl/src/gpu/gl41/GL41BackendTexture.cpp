@@ -36,6 +36,9 @@ bool GL41Backend::supportedTextureFormat(const gpu::Element& format) {
         case gpu::Semantic::COMPRESSED_BC6_RGB:
         case gpu::Semantic::COMPRESSED_BC7_SRGBA:
             return false;
+        case gpu::Semantic::COMPRESSED_ASTC_RGBA:
+        case gpu::Semantic::COMPRESSED_ASTC_SRGBA:
+            return supportsASTC();
         default:
             return true;
     }
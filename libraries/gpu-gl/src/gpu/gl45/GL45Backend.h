@@ -15,6 +15,7 @@
 #include <gpu/gl/GLBackend.h>
 #include <gpu/gl/GLTexture.h>
 
+#include <deque>
 #include <thread>
 #include <gpu/TextureTable.h>
 
@@ -51,6 +52,8 @@ public:
     static const std::string GL45_VERSION;
     const std::string& getVersion() const override { return GL45_VERSION; }
 
+    void shutdown() override;
+
     bool supportedTextureFormat(const gpu::Element& format) override;
 
     class GL45Texture : public GLTexture {
@@ -265,6 +268,46 @@ protected:
     void initTransform() override;
     void updateTransform(const Batch& batch) override;
 
+    // A persistently mapped buffer that the batches' cameras, object transforms and draw call infos are written to,
+    // rather than respecifying the transform buffers for each batch.  It's used as a ring, holding a few frames' worth,
+    // and what each batch wrote is fenced, so it's only overwritten once the GPU is done with it.
+    class GL45StreamBuffer {
+    public:
+        static const GLsizeiptr SIZE { 16 * 1024 * 1024 };
+        // larger writes go through the transform buffers, so one batch never wraps onto its own data
+        static const GLsizeiptr MAX_WRITE_SIZE { SIZE / 4 };
+
+        void create();
+        void destroy();
+
+        GLuint getBuffer() const { return _buffer; }
+
+        // Returns where size bytes were reserved for this batch, or -1 if they can't be.  Waits for the GPU if they
+        // overlap what an earlier batch wrote that is still in use.
+        GLintptr reserve(GLsizeiptr size, uint8_t*& data, ContextStats& stats);
+        // Fences what was reserved since the last fence, once the batch that uses it is submitted
+        void fence();
+
+    private:
+        struct Fence {
+            GLsync sync;
+            uint64_t end;
+        };
+
+        void retireFence(ContextStats& stats);
+
+        GLuint _buffer { 0 };
+        uint8_t* _mapped { nullptr };
+        GLint _alignment { 1 };
+        // positions in the stream, which wraps around the buffer
+        uint64_t _head { 0 };
+        uint64_t _fenced { 0 };
+        uint64_t _retired { 0 };
+        std::deque<Fence> _fences;
+    };
+
+    mutable GL45StreamBuffer _streamBuffer;
+
     // Resource Stage
     bool bindResourceBuffer(uint32_t slot, const BufferPointer& buffer) override;
     void releaseResourceBuffer(uint32_t slot) override;
@@ -51,6 +51,10 @@ bool GL45Backend::supportedTextureFormat(const gpu::Element& format) {
         case gpu::Semantic::COMPRESSED_EAC_XY_SIGNED:
             return FORCE_MOBILE_TEXTURES;
 
+        case gpu::Semantic::COMPRESSED_ASTC_RGBA:
+        case gpu::Semantic::COMPRESSED_ASTC_SRGBA:
+            return supportsASTC();
+
         default:
             return FORCE_MOBILE_TEXTURES ? !format.isCompressed() : true;
     }
@@ -27,41 +27,187 @@ void GL45Backend::initTransform() {
     while (_transform._cameraUboSize < cameraSize) {
         _transform._cameraUboSize += UNIFORM_BUFFER_OFFSET_ALIGNMENT;
     }
+
+    _streamBuffer.create();
+}
+
+void GL45Backend::shutdown() {
+    _streamBuffer.destroy();
+    Parent::shutdown();
+}
+
+void GL45Backend::GL45StreamBuffer::create() {
+    // the offsets are bound as cameras, object transforms and vertex data
+    GLint uniformAlignment = 1;
+    GLint objectAlignment = 1;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &uniformAlignment);
+#ifdef GPU_SSBO_TRANSFORM_OBJECT
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &objectAlignment);
+#else
+    glGetIntegerv(GL_TEXTURE_BUFFER_OFFSET_ALIGNMENT, &objectAlignment);
+#endif
+    const GLint MIN_ALIGNMENT = 16;
+    _alignment = std::max(MIN_ALIGNMENT, std::max(uniformAlignment, objectAlignment));
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glCreateBuffers(1, &_buffer);
+    glNamedBufferStorage(_buffer, SIZE, nullptr, flags);
+    _mapped = (uint8_t*)glMapNamedBufferRange(_buffer, 0, SIZE, flags);
+    if (!_mapped) {
+        qCWarning(gpugl45logging) << "Failed to map the transform stream buffer, transforms will be uploaded with each batch";
+        glDeleteBuffers(1, &_buffer);
+        _buffer = 0;
+    }
+    (void)CHECK_GL_ERROR();
+}
+
+void GL45Backend::GL45StreamBuffer::destroy() {
+    for (auto& fence : _fences) {
+        glDeleteSync(fence.sync);
+    }
+    _fences.clear();
+    if (_buffer) {
+        glUnmapNamedBuffer(_buffer);
+        glDeleteBuffers(1, &_buffer);
+        _buffer = 0;
+        _mapped = nullptr;
+    }
+}
+
+GLintptr GL45Backend::GL45StreamBuffer::reserve(GLsizeiptr size, uint8_t*& data, ContextStats& stats) {
+    if (!_buffer || size > MAX_WRITE_SIZE) {
+        return -1;
+    }
+
+    uint64_t start = ((_head + _alignment - 1) / _alignment) * _alignment;
+    if ((start % SIZE) + size > (uint64_t)SIZE) {
+        // wrap around to the start of the buffer rather than splitting the write
+        start = ((start / SIZE) + 1) * SIZE;
+    }
+    uint64_t end = start + size;
+
+    if (end > (uint64_t)SIZE) {
+        uint64_t reusedEnd = end - SIZE;
+        if (reusedEnd > _fenced) {
+            // this batch would overwrite what it wrote itself
+            return -1;
+        }
+        while (_retired < reusedEnd && !_fences.empty()) {
+            retireFence(stats);
+        }
+    }
+
+    _head = end;
+    GLintptr offset = (GLintptr)(start % SIZE);
+    data = _mapped + offset;
+    stats._TSAmountStreamedMemory += size;
+    stats._TSNumStreamedUploads++;
+    return offset;
+}
+
+void GL45Backend::GL45StreamBuffer::fence() {
+    if (_head == _fenced) {
+        return;
+    }
+    _fences.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), _head });
+    _fenced = _head;
+}
+
+void GL45Backend::GL45StreamBuffer::retireFence(ContextStats& stats) {
+    auto& fence = _fences.front();
+    GLenum result = glClientWaitSync(fence.sync, 0, 0);
+    if (result != GL_ALREADY_SIGNALED && result != GL_CONDITION_SATISFIED) {
+        stats._TSNumStreamStalls++;
+        const GLuint64 TIMEOUT_NSECS = 1000 * 1000 * 1000;
+        result = glClientWaitSync(fence.sync, GL_SYNC_FLUSH_COMMANDS_BIT, TIMEOUT_NSECS);
+        while (result == GL_TIMEOUT_EXPIRED) {
+            result = glClientWaitSync(fence.sync, GL_SYNC_FLUSH_COMMANDS_BIT, TIMEOUT_NSECS);
+        }
+    }
+    glDeleteSync(fence.sync);
+    _retired = fence.end;
+    _fences.pop_front();
 }
 
 void GL45Backend::transferTransformState(const Batch& batch) const {
+    // the commands of the batch before this one, which read what it streamed, have all been issued
+    _streamBuffer.fence();
+
     // FIXME not thread safe
     static std::vector<uint8_t> bufferData;
+    _transform._streamedCameraBuffer = 0;
+    _transform._streamedCameraOffset = 0;
     if (!_transform._cameras.empty()) {
-        bufferData.resize(_transform._cameraUboSize * _transform._cameras.size());
+        GLsizeiptr size = _transform._cameraUboSize * _transform._cameras.size();
+        uint8_t* data = nullptr;
+        GLintptr offset = _streamBuffer.reserve(size, data, _stats);
+        if (offset < 0) {
+            bufferData.resize(size);
+            data = bufferData.data();
+        }
         for (size_t i = 0; i < _transform._cameras.size(); ++i) {
-            memcpy(bufferData.data() + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
+            memcpy(data + (_transform._cameraUboSize * i), &_transform._cameras[i], sizeof(TransformStageState::CameraBufferElement));
+        }
+        if (offset < 0) {
+            glNamedBufferData(_transform._cameraBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        } else {
+            _transform._streamedCameraBuffer = _streamBuffer.getBuffer();
+            _transform._streamedCameraOffset = offset;
         }
-        glNamedBufferData(_transform._cameraBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
     }
 
+    GLintptr objectOffset = -1;
+    GLsizeiptr objectSize = batch._objects.size() * sizeof(Batch::TransformObject);
     if (!batch._objects.empty()) {
-        glNamedBufferData(_transform._objectBuffer, batch._objects.size() * sizeof(Batch::TransformObject), batch._objects.data(), GL_STREAM_DRAW);
+        uint8_t* data = nullptr;
+        objectOffset = _streamBuffer.reserve(objectSize, data, _stats);
+        if (objectOffset < 0) {
+            glNamedBufferData(_transform._objectBuffer, objectSize, batch._objects.data(), GL_STREAM_DRAW);
+        } else {
+            memcpy(data, batch._objects.data(), objectSize);
+        }
     }
 
+    _transform._streamedDrawCallInfoBuffer = 0;
     if (!batch._namedData.empty()) {
-        bufferData.clear();
+        GLsizeiptr size = 0;
+        for (auto& data : batch._namedData) {
+            size += data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
+        }
+        uint8_t* streamed = nullptr;
+        GLintptr offset = _streamBuffer.reserve(size, streamed, _stats);
+        if (offset < 0) {
+            bufferData.resize(size);
+            streamed = bufferData.data();
+        }
+        size_t currentSize = 0;
         for (auto& data : batch._namedData) {
-            auto currentSize = bufferData.size();
             auto bytesToCopy = data.second.drawCallInfos.size() * sizeof(Batch::DrawCallInfo);
-            bufferData.resize(currentSize + bytesToCopy);
-            memcpy(bufferData.data() + currentSize, data.second.drawCallInfos.data(), bytesToCopy);
-            _transform._drawCallInfoOffsets[data.first] = (GLvoid*)currentSize;
+            memcpy(streamed + currentSize, data.second.drawCallInfos.data(), bytesToCopy);
+            _transform._drawCallInfoOffsets[data.first] = (GLvoid*)(std::max(offset, (GLintptr)0) + currentSize);
+            currentSize += bytesToCopy;
+        }
+        if (offset < 0) {
+            glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
+        } else {
+            _transform._streamedDrawCallInfoBuffer = _streamBuffer.getBuffer();
         }
-        glNamedBufferData(_transform._drawCallInfoBuffer, bufferData.size(), bufferData.data(), GL_STREAM_DRAW);
     }
 
 #ifdef GPU_SSBO_TRANSFORM_OBJECT
-    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, _transform._objectBuffer);
+    if (objectOffset < 0) {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, _transform._objectBuffer);
+    } else {
+        glBindBufferRange(GL_SHADER_STORAGE_BUFFER, slot::storage::ObjectTransforms, _streamBuffer.getBuffer(), objectOffset, objectSize);
+    }
 #else
     glActiveTexture(GL_TEXTURE0 + slot::texture::ObjectTransforms);
     glBindTexture(GL_TEXTURE_BUFFER, _transform._objectBufferTexture);
-    glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    if (objectOffset < 0) {
+        glTextureBuffer(_transform._objectBufferTexture, GL_RGBA32F, _transform._objectBuffer);
+    } else {
+        glTextureBufferRange(_transform._objectBufferTexture, GL_RGBA32F, _streamBuffer.getBuffer(), objectOffset, objectSize);
+    }
 #endif
 
     CHECK_GL_ERROR();
@@ -97,7 +243,8 @@ void GL45Backend::updateTransform(const Batch& batch) {
         // NOTE: A stride of zero in BindVertexBuffer signifies that all elements are sourced from the same location,
         //       so we must provide a stride.
         //       This is in contrast to VertexAttrib*Pointer, where a zero signifies tightly-packed elements.
-        glBindVertexBuffer(gpu::Stream::DRAW_CALL_INFO, _transform._drawCallInfoBuffer, (GLintptr)_transform._drawCallInfoOffsets[batch._currentNamedCall], 2 * sizeof(GLushort));
+        GLuint drawCallInfoBuffer = _transform._streamedDrawCallInfoBuffer ? _transform._streamedDrawCallInfoBuffer : _transform._drawCallInfoBuffer;
+        glBindVertexBuffer(gpu::Stream::DRAW_CALL_INFO, drawCallInfoBuffer, (GLintptr)_transform._drawCallInfoOffsets[batch._currentNamedCall], 2 * sizeof(GLushort));
     }
 
     (void)CHECK_GL_ERROR();
@@ -45,6 +45,31 @@ public:
     static const std::string GLES_VERSION;
     const std::string& getVersion() const override { return GLES_VERSION; }
 
+    // Texture data is staged in a few pixel unpack buffers on its way to the GPU, so that the driver copies it to the
+    // texture as the frame goes on instead of from client memory during the upload call. A buffer is only written again
+    // once the fence after the upload that read it has passed, and when none is free the data is uploaded directly.
+    class GLESTextureUploadBuffers {
+    public:
+        ~GLESTextureUploadBuffers();
+
+        // copies the data to a free buffer and binds it to GL_PIXEL_UNPACK_BUFFER, or returns false
+        bool stage(const void* data, Size size);
+        // unbinds the staged buffer and fences the uploads made from it
+        void release();
+
+    private:
+        struct Buffer {
+            GLuint id { 0 };
+            Size capacity { 0 };
+            GLsync fence { nullptr };
+        };
+        static const size_t NUM_BUFFERS { 4 };
+
+        std::array<Buffer, NUM_BUFFERS> _buffers;
+        size_t _nextBuffer { 0 };
+        Buffer* _stagedBuffer { nullptr };
+    };
+
     class GLESTexture : public GLTexture {
         using Parent = GLTexture;
         friend class GLESBackend;
@@ -168,6 +193,9 @@ protected:
     void do_blit(const Batch& batch, size_t paramOffset) override;
     
     shader::Dialect getShaderDialect() const override { return shader::Dialect::glsl310es; }
+
+    // only used on the render thread, by the transfers of the variable allocation textures
+    GLESTextureUploadBuffers _textureUploadBuffers;
 };
 
 } }
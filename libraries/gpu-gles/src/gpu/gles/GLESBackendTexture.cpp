@@ -10,6 +10,7 @@
 //
 #include "GLESBackend.h"
 
+#include <cstring>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -32,6 +33,9 @@ bool GLESBackend::supportedTextureFormat(const gpu::Element& format) {
         case gpu::Semantic::COMPRESSED_EAC_XY:
         case gpu::Semantic::COMPRESSED_EAC_XY_SIGNED:
             return true;
+        case gpu::Semantic::COMPRESSED_ASTC_RGBA:
+        case gpu::Semantic::COMPRESSED_ASTC_SRGBA:
+            return supportsASTC();
         default:
             return !format.isCompressed();
     }
@@ -233,6 +237,72 @@ void GLESTexture::syncSampler() const {
     (void)CHECK_GL_ERROR();
 }
 
+using GLESTextureUploadBuffers = GLESBackend::GLESTextureUploadBuffers;
+
+GLESTextureUploadBuffers::~GLESTextureUploadBuffers() {
+    for (auto& buffer : _buffers) {
+        if (buffer.fence) {
+            glDeleteSync(buffer.fence);
+        }
+        if (buffer.id) {
+            glDeleteBuffers(1, &buffer.id);
+        }
+    }
+}
+
+bool GLESTextureUploadBuffers::stage(const void* data, Size size) {
+    Q_ASSERT(!_stagedBuffer);
+
+    // the buffers are used in turn, so the next one is the one written the longest ago
+    auto& buffer = _buffers[_nextBuffer];
+    if (buffer.fence) {
+        auto status = glClientWaitSync(buffer.fence, 0, 0);
+        if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+            return false;
+        }
+        glDeleteSync(buffer.fence);
+        buffer.fence = nullptr;
+    }
+
+    if (!buffer.id) {
+        glGenBuffers(1, &buffer.id);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buffer.id);
+    if (buffer.capacity < size) {
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+        buffer.capacity = size;
+    }
+
+    // nothing reads the buffer any more, the fence said so
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size,
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    bool isStaged = false;
+    if (mapped) {
+        memcpy(mapped, data, size);
+        isStaged = glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER) == GL_TRUE;
+    }
+    if (!isStaged) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        (void)CHECK_GL_ERROR();
+        return false;
+    }
+
+    _stagedBuffer = &buffer;
+    _nextBuffer = (_nextBuffer + 1) % NUM_BUFFERS;
+    return true;
+}
+
+void GLESTextureUploadBuffers::release() {
+    if (!_stagedBuffer) {
+        return;
+    }
+
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    _stagedBuffer->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    _stagedBuffer = nullptr;
+    (void)CHECK_GL_ERROR();
+}
+
 using GLESFixedAllocationTexture = GLESBackend::GLESFixedAllocationTexture;
 
 GLESFixedAllocationTexture::GLESFixedAllocationTexture(const std::weak_ptr<GLBackend>& backend, const Texture& texture) : GLESTexture(backend, texture), _size(texture.evalTotalSize()) {
@@ -427,8 +497,15 @@ Size GLESVariableAllocationTexture::copyMipsFromTexture() {
 
 Size GLESVariableAllocationTexture::copyMipFaceLinesFromTexture(uint16_t mip, uint8_t face, const uvec3& size, uint32_t yOffset, GLenum internalFormat, GLenum format, GLenum type, Size sourceSize, const void* sourcePointer) const {
     Size amountCopied = 0;
+    auto backend = std::static_pointer_cast<GLESBackend>(_backend.lock());
     withPreservedTexture([&] {
-        amountCopied = Parent::copyMipFaceLinesFromTexture(mip, face, size, yOffset, internalFormat, format, type, sourceSize, sourcePointer);
+        if (backend && backend->_textureUploadBuffers.stage(sourcePointer, sourceSize)) {
+            // the data is read from the start of the bound unpack buffer
+            amountCopied = Parent::copyMipFaceLinesFromTexture(mip, face, size, yOffset, internalFormat, format, type, sourceSize, nullptr);
+            backend->_textureUploadBuffers.release();
+        } else {
+            amountCopied = Parent::copyMipFaceLinesFromTexture(mip, face, size, yOffset, internalFormat, format, type, sourceSize, sourcePointer);
+        }
     });
     return amountCopied;
 }
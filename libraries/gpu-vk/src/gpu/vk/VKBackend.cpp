@@ -0,0 +1,503 @@
+//
+//  VKBackend.cpp
+//  libraries/gpu-vk/src/gpu/vk
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "VKBackend.h"
+
+#include <algorithm>
+
+#include <glm/gtc/type_ptr.hpp>
+
+#include "VKBuffer.h"
+#include "VKPipeline.h"
+
+using namespace gpu;
+using namespace gpu::vk;
+
+static const std::string VK_VERSION { "VK" };
+
+VKBackend::CommandCall VKBackend::_commandCalls[Batch::NUM_COMMANDS] =
+{
+    (&::gpu::vk::VKBackend::do_draw),
+    (&::gpu::vk::VKBackend::do_drawIndexed),
+    (&::gpu::vk::VKBackend::do_drawInstanced),
+    (&::gpu::vk::VKBackend::do_drawIndexedInstanced),
+    (&::gpu::vk::VKBackend::do_notPorted), // multiDrawIndirect
+    (&::gpu::vk::VKBackend::do_notPorted), // multiDrawIndexedIndirect
+
+    (&::gpu::vk::VKBackend::do_setInputFormat),
+    (&::gpu::vk::VKBackend::do_setInputBuffer),
+    (&::gpu::vk::VKBackend::do_setIndexBuffer),
+    (&::gpu::vk::VKBackend::do_notPorted), // setIndirectBuffer
+
+    (&::gpu::vk::VKBackend::do_notPorted), // setModelTransform
+    (&::gpu::vk::VKBackend::do_notPorted), // setViewTransform
+    (&::gpu::vk::VKBackend::do_notPorted), // setProjectionTransform
+    (&::gpu::vk::VKBackend::do_notPorted), // setProjectionJitter
+    (&::gpu::vk::VKBackend::do_setViewportTransform),
+    (&::gpu::vk::VKBackend::do_notPorted), // setDepthRangeTransform
+
+    (&::gpu::vk::VKBackend::do_setPipeline),
+    (&::gpu::vk::VKBackend::do_setStateBlendFactor),
+    (&::gpu::vk::VKBackend::do_setStateScissorRect),
+    (&::gpu::vk::VKBackend::do_notPorted), // setFoveation
+
+    (&::gpu::vk::VKBackend::do_setUniformBuffer),
+    (&::gpu::vk::VKBackend::do_setResourceBuffer),
+    (&::gpu::vk::VKBackend::do_notPorted), // setResourceTexture
+    (&::gpu::vk::VKBackend::do_notPorted), // setResourceTextureTable
+    (&::gpu::vk::VKBackend::do_notPorted), // setResourceFramebufferSwapChainTexture
+
+    (&::gpu::vk::VKBackend::do_setFramebuffer),
+    (&::gpu::vk::VKBackend::do_notPorted), // setFramebufferSwapChain
+    (&::gpu::vk::VKBackend::do_notPorted), // clearFramebuffer
+    (&::gpu::vk::VKBackend::do_notPorted), // blit
+    (&::gpu::vk::VKBackend::do_notPorted), // generateTextureMips
+    (&::gpu::vk::VKBackend::do_notPorted), // generateTextureMipsWithPipeline
+
+    (&::gpu::vk::VKBackend::do_notPorted), // advance
+
+    (&::gpu::vk::VKBackend::do_notPorted), // beginQuery
+    (&::gpu::vk::VKBackend::do_notPorted), // endQuery
+    (&::gpu::vk::VKBackend::do_notPorted), // getQuery
+
+    (&::gpu::vk::VKBackend::do_resetStages),
+
+    (&::gpu::vk::VKBackend::do_notPorted), // disableContextViewCorrection
+    (&::gpu::vk::VKBackend::do_notPorted), // restoreContextViewCorrection
+    (&::gpu::vk::VKBackend::do_notPorted), // disableContextStereo
+    (&::gpu::vk::VKBackend::do_notPorted), // restoreContextStereo
+
+    (&::gpu::vk::VKBackend::do_runLambda),
+
+    (&::gpu::vk::VKBackend::do_notPorted), // startNamedCall
+    (&::gpu::vk::VKBackend::do_notPorted), // stopNamedCall
+
+    // the GL uniforms have no Vulkan equivalent, they'll map to push constants
+    (&::gpu::vk::VKBackend::do_notPorted), // glUniform1i
+    (&::gpu::vk::VKBackend::do_notPorted), // glUniform1f
+    (&::gpu::vk::VKBackend::do_notPorted), // glUniform2f
+    (&::gpu::vk::VKBackend::do_notPorted), // glUniform3f
+    (&::gpu::vk::VKBackend::do_notPorted), // glUniform4f
+    (&::gpu::vk::VKBackend::do_notPorted), // glUniform3fv
+    (&::gpu::vk::VKBackend::do_notPorted), // glUniform4fv
+    (&::gpu::vk::VKBackend::do_notPorted), // glUniform4iv
+    (&::gpu::vk::VKBackend::do_notPorted), // glUniformMatrix3fv
+    (&::gpu::vk::VKBackend::do_notPorted), // glUniformMatrix4fv
+
+    (&::gpu::vk::VKBackend::do_notPorted), // glColor4f
+
+    (&::gpu::vk::VKBackend::do_notPorted), // pushProfileRange
+    (&::gpu::vk::VKBackend::do_notPorted), // popProfileRange
+};
+
+VKDevice VKBackend::_initialDevice;
+
+void VKBackend::setDevice(const VKDevice& device) {
+    _initialDevice = device;
+}
+
+BackendPointer VKBackend::createBackend() {
+    if (!_initialDevice.device) {
+        qCWarning(gpu_vk_logging) << "VKBackend::createBackend: no device was set";
+        return BackendPointer();
+    }
+    return std::shared_ptr<VKBackend>(new VKBackend(_initialDevice));
+}
+
+VKBackend::VKBackend(const VKDevice& device) : _device(device) {
+    VkPipelineCacheCreateInfo cacheInfo { VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO };
+    vkCreatePipelineCache(_device.device, &cacheInfo, nullptr, &_pipelineCache);
+    _descriptorPool.create(_device.device, NUM_FRAMES_IN_FLIGHT);
+}
+
+VKBackend::~VKBackend() {
+    shutdown();
+}
+
+void VKBackend::shutdown() {
+    if (!_pipelineCache) {
+        return;
+    }
+    resetStages();
+    vkDeviceWaitIdle(_device.device);
+    {
+        std::unique_lock<std::mutex> lock(_releasesMutex);
+        for (auto& release : _releases) {
+            release.release(_device.device);
+        }
+        _releases.clear();
+    }
+    _descriptorPool.destroy();
+    vkDestroyPipelineCache(_device.device, _pipelineCache, nullptr);
+    _pipelineCache = VK_NULL_HANDLE;
+}
+
+const std::string& VKBackend::getVersion() const {
+    return VK_VERSION;
+}
+
+void VKBackend::beginFrame(const VKFrameTarget& target) {
+    _frameIndex++;
+    _target = target;
+    _inFrame = true;
+    _descriptorPool.beginFrame(_frameIndex);
+
+    // the state bound in a command buffer doesn't carry over to the next one
+    _pipeline._boundPipeline = VK_NULL_HANDLE;
+    _pipeline._toFrameTarget = true;
+    _input._invalidBuffers = true;
+    _input._invalidIndexBuffer = true;
+    _resource._invalidSet = true;
+    _output._viewport = { 0.0f, (float)target.extent.height, (float)target.extent.width, -(float)target.extent.height, 0.0f, 1.0f };
+    _output._scissor = { { 0, 0 }, target.extent };
+    _output._invalidViewport = true;
+
+    recycle();
+}
+
+void VKBackend::endFrame() {
+    _inFrame = false;
+    _target = VKFrameTarget();
+}
+
+void VKBackend::render(const Batch& batch) {
+    if (!_inFrame) {
+        return;
+    }
+    // batches start from the default output, like in GLBackend
+    _pipeline._toFrameTarget = true;
+
+    const size_t numCommands = batch.getCommands().size();
+    const Batch::Commands::value_type* command = batch.getCommands().data();
+    const Batch::CommandOffsets::value_type* offset = batch.getCommandOffsets().data();
+    for (size_t i = 0; i < numCommands; i++) {
+        CommandCall call = _commandCalls[(*command)];
+        (this->*(call))(batch, *offset);
+        command++;
+        offset++;
+    }
+}
+
+void VKBackend::recycle() const {
+    // the frames up to NUM_FRAMES_IN_FLIGHT ago are done, so what was released before them isn't used anymore
+    std::vector<Release> releases;
+    {
+        std::unique_lock<std::mutex> lock(_releasesMutex);
+        auto firstInUse = std::partition(_releases.begin(), _releases.end(), [&](const Release& release) {
+            return release.frame + NUM_FRAMES_IN_FLIGHT <= _frameIndex;
+        });
+        releases.assign(std::make_move_iterator(_releases.begin()), std::make_move_iterator(firstInUse));
+        _releases.erase(_releases.begin(), firstInUse);
+    }
+    for (auto& release : releases) {
+        release.release(_device.device);
+    }
+}
+
+void VKBackend::releaseLater(std::function<void(VkDevice)>&& release) {
+    std::unique_lock<std::mutex> lock(_releasesMutex);
+    _releases.push_back({ _frameIndex, std::move(release) });
+}
+
+void VKBackend::resetStages() {
+    _input._format.reset();
+    for (auto& buffer : _input._buffers) {
+        buffer.reset();
+    }
+    _input._indexBuffer.reset();
+    _input._invalidBuffers = true;
+    _input._invalidIndexBuffer = true;
+
+    _pipeline._pipeline.reset();
+    _pipeline._object = nullptr;
+
+    for (auto& uniformBuffer : _resource._uniformBuffers) {
+        uniformBuffer = UniformBufferState();
+    }
+    for (auto& resourceBuffer : _resource._resourceBuffers) {
+        resourceBuffer.reset();
+    }
+    _resource._invalidSet = true;
+}
+
+bool VKBackend::prepareDraw(Primitive primitive, bool indexed) {
+    if (!_pipeline._toFrameTarget || !_pipeline._object || !_input._format) {
+        return false;
+    }
+    VKPipeline& pipelineObject = *_pipeline._object;
+    const auto& reflection = pipelineObject._reflection;
+    if (!reflection.textures.empty()) {
+        return false;
+    }
+
+    VkCommandBuffer commandBuffer = _target.commandBuffer;
+    VkPipeline pipeline = pipelineObject.getVariant(*_input._format, primitive, _target.renderPass, _target.numColorAttachments);
+    if (!pipeline) {
+        return false;
+    }
+    if (pipeline != _pipeline._boundPipeline) {
+        vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+        _pipeline._boundPipeline = pipeline;
+    }
+
+    if (_output._invalidViewport) {
+        vkCmdSetViewport(commandBuffer, 0, 1, &_output._viewport);
+        // the scissor test can't be disabled, so without it the scissor is the whole target
+        bool scissorEnabled = _pipeline._pipeline->getState()->isScissorEnable();
+        VkRect2D scissor = scissorEnabled ? _output._scissor : VkRect2D { { 0, 0 }, _target.extent };
+        vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+        _output._invalidViewport = false;
+    }
+
+    if (_input._invalidBuffers) {
+        for (const auto& channel : _input._format->getChannels()) {
+            uint32_t slot = channel.first;
+            if (slot >= MAX_NUM_INPUT_BUFFERS || !_input._buffers[slot]) {
+                return false;
+            }
+            VkBuffer buffer = VKBuffer::getBuffer(*this, *_input._buffers[slot]);
+            if (!buffer) {
+                return false;
+            }
+            vkCmdBindVertexBuffers(commandBuffer, slot, 1, &buffer, &_input._offsets[slot]);
+        }
+        _input._invalidBuffers = false;
+    }
+
+    if (indexed && _input._invalidIndexBuffer) {
+        if (!_input._indexBuffer) {
+            return false;
+        }
+        VkBuffer buffer = VKBuffer::getBuffer(*this, *_input._indexBuffer);
+        if (!buffer) {
+            return false;
+        }
+        vkCmdBindIndexBuffer(commandBuffer, buffer, _input._indexBufferOffset, toVkIndexType(_input._indexBufferType));
+        _input._invalidIndexBuffer = false;
+    }
+
+    if (_resource._invalidSet) {
+        std::vector<VkDescriptorBufferInfo> bufferInfos;
+        std::vector<VkWriteDescriptorSet> writes;
+        bufferInfos.reserve(reflection.uniformBuffers.size() + reflection.resourceBuffers.size());
+
+        auto addWrite = [&](uint32_t binding, VkDescriptorType type, const BufferPointer& buffer, VkDeviceSize offset,
+                            VkDeviceSize size) {
+            VkBuffer vkBuffer = buffer ? VKBuffer::getBuffer(*this, *buffer) : VK_NULL_HANDLE;
+            if (!vkBuffer) {
+                return false;
+            }
+            bufferInfos.push_back({ vkBuffer, offset, size ? size : VK_WHOLE_SIZE });
+            VkWriteDescriptorSet write { VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET };
+            write.dstBinding = binding;
+            write.descriptorCount = 1;
+            write.descriptorType = type;
+            write.pBufferInfo = &bufferInfos.back();
+            writes.push_back(write);
+            return true;
+        };
+
+        // every binding the program uses must be valid
+        for (const auto& location : reflection.uniformBuffers) {
+            uint32_t slot = (uint32_t)location.second;
+            if (slot >= MAX_NUM_UNIFORM_BUFFERS) {
+                return false;
+            }
+            const auto& uniformBuffer = _resource._uniformBuffers[slot];
+            if (!addWrite(slot, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, uniformBuffer._buffer, uniformBuffer._offset,
+                          uniformBuffer._size)) {
+                return false;
+            }
+        }
+        for (const auto& location : reflection.resourceBuffers) {
+            uint32_t slot = (uint32_t)location.second;
+            if (slot >= MAX_NUM_RESOURCE_BUFFERS ||
+                !addWrite(RESOURCE_BUFFER_BINDING_BASE + slot, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                          _resource._resourceBuffers[slot], 0, 0)) {
+                return false;
+            }
+        }
+
+        VkDescriptorSet set = _descriptorPool.allocate(pipelineObject._setLayout);
+        if (!set) {
+            return false;
+        }
+        for (auto& write : writes) {
+            write.dstSet = set;
+        }
+        vkUpdateDescriptorSets(_device.device, (uint32_t)writes.size(), writes.data(), 0, nullptr);
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineObject._layout, 0, 1, &set, 0,
+                                nullptr);
+        _resource._invalidSet = false;
+    }
+
+    return true;
+}
+
+void VKBackend::do_draw(const Batch& batch, size_t paramOffset) {
+    Primitive primitiveType = (Primitive)batch._params[paramOffset + 2]._uint;
+    uint32 numVertices = batch._params[paramOffset + 1]._uint;
+    uint32 startVertex = batch._params[paramOffset + 0]._uint;
+    if (!prepareDraw(primitiveType, false)) {
+        return;
+    }
+    vkCmdDraw(_target.commandBuffer, numVertices, 1, startVertex, 0);
+    _stats._DSNumTriangles += numVertices / 3;
+    _stats._DSNumDrawcalls++;
+}
+
+void VKBackend::do_drawIndexed(const Batch& batch, size_t paramOffset) {
+    Primitive primitiveType = (Primitive)batch._params[paramOffset + 2]._uint;
+    uint32 numIndices = batch._params[paramOffset + 1]._uint;
+    uint32 startIndex = batch._params[paramOffset + 0]._uint;
+    if (!prepareDraw(primitiveType, true)) {
+        return;
+    }
+    vkCmdDrawIndexed(_target.commandBuffer, numIndices, 1, startIndex, 0, 0);
+    _stats._DSNumTriangles += numIndices / 3;
+    _stats._DSNumDrawcalls++;
+}
+
+void VKBackend::do_drawInstanced(const Batch& batch, size_t paramOffset) {
+    uint32 numInstances = batch._params[paramOffset + 4]._uint;
+    Primitive primitiveType = (Primitive)batch._params[paramOffset + 3]._uint;
+    uint32 numVertices = batch._params[paramOffset + 2]._uint;
+    uint32 startVertex = batch._params[paramOffset + 1]._uint;
+    uint32 startInstance = batch._params[paramOffset + 0]._uint;
+    if (!prepareDraw(primitiveType, false)) {
+        return;
+    }
+    vkCmdDraw(_target.commandBuffer, numVertices, numInstances, startVertex, startInstance);
+    _stats._DSNumTriangles += (numInstances * numVertices) / 3;
+    _stats._DSNumDrawcalls += numInstances;
+}
+
+void VKBackend::do_drawIndexedInstanced(const Batch& batch, size_t paramOffset) {
+    uint32 numInstances = batch._params[paramOffset + 4]._uint;
+    Primitive primitiveType = (Primitive)batch._params[paramOffset + 3]._uint;
+    uint32 numIndices = batch._params[paramOffset + 2]._uint;
+    uint32 startIndex = batch._params[paramOffset + 1]._uint;
+    uint32 startInstance = batch._params[paramOffset + 0]._uint;
+    if (!prepareDraw(primitiveType, true)) {
+        return;
+    }
+    vkCmdDrawIndexed(_target.commandBuffer, numIndices, numInstances, startIndex, 0, startInstance);
+    _stats._DSNumTriangles += (numInstances * numIndices) / 3;
+    _stats._DSNumDrawcalls += numInstances;
+}
+
+void VKBackend::do_setInputFormat(const Batch& batch, size_t paramOffset) {
+    const auto& format = batch._streamFormats.get(batch._params[paramOffset]._uint);
+    if (format != _input._format) {
+        _input._format = format;
+        _input._invalidBuffers = true;
+    }
+}
+
+void VKBackend::do_setInputBuffer(const Batch& batch, size_t paramOffset) {
+    Offset offset = batch._params[paramOffset + 1]._uint;
+    const auto& buffer = batch._buffers.get(batch._params[paramOffset + 2]._uint);
+    uint32 channel = batch._params[paramOffset + 3]._uint;
+    if (channel < MAX_NUM_INPUT_BUFFERS) {
+        _input._buffers[channel] = buffer;
+        _input._offsets[channel] = offset;
+        _input._invalidBuffers = true;
+    }
+}
+
+void VKBackend::do_setIndexBuffer(const Batch& batch, size_t paramOffset) {
+    _input._indexBufferType = (Type)batch._params[paramOffset + 2]._uint;
+    _input._indexBufferOffset = batch._params[paramOffset + 0]._uint;
+    _input._indexBuffer = batch._buffers.get(batch._params[paramOffset + 1]._uint);
+    _input._invalidIndexBuffer = true;
+}
+
+void VKBackend::do_setViewportTransform(const Batch& batch, size_t paramOffset) {
+    Vec4i viewport;
+    memcpy(glm::value_ptr(viewport), batch.readData(batch._params[paramOffset]._uint), sizeof(Vec4i));
+    // GL's origin is at the bottom left, so the viewport is flipped, with a negative height
+    float targetHeight = (float)_target.extent.height;
+    _output._viewport = { (float)viewport.x, targetHeight - (float)viewport.y, (float)viewport.z, -(float)viewport.w,
+                          0.0f, 1.0f };
+    _output._invalidViewport = true;
+}
+
+void VKBackend::do_setPipeline(const Batch& batch, size_t paramOffset) {
+    const auto& pipeline = batch._pipelines.get(batch._params[paramOffset + 0]._uint);
+    if (pipeline == _pipeline._pipeline) {
+        return;
+    }
+
+    // A true new Pipeline
+    _stats._PSNumSetPipelines++;
+
+    _pipeline._pipeline = pipeline;
+    _pipeline._object = pipeline ? VKPipeline::sync(*this, *pipeline) : nullptr;
+    // the descriptor set was allocated for the previous pipeline's layout
+    _resource._invalidSet = true;
+    _output._invalidViewport = true;
+}
+
+void VKBackend::do_setStateBlendFactor(const Batch& batch, size_t paramOffset) {
+    if (!_inFrame) {
+        return;
+    }
+    float factor[4] = { batch._params[paramOffset + 0]._float, batch._params[paramOffset + 1]._float,
+                        batch._params[paramOffset + 2]._float, batch._params[paramOffset + 3]._float };
+    vkCmdSetBlendConstants(_target.commandBuffer, factor);
+}
+
+void VKBackend::do_setStateScissorRect(const Batch& batch, size_t paramOffset) {
+    Vec4i rect;
+    memcpy(glm::value_ptr(rect), batch.readData(batch._params[paramOffset]._uint), sizeof(Vec4i));
+    int32_t targetHeight = (int32_t)_target.extent.height;
+    _output._scissor = { { rect.x, targetHeight - rect.y - rect.w }, { (uint32_t)rect.z, (uint32_t)rect.w } };
+    _output._invalidViewport = true;
+}
+
+void VKBackend::do_setUniformBuffer(const Batch& batch, size_t paramOffset) {
+    uint32 slot = batch._params[paramOffset + 3]._uint;
+    if (slot >= MAX_NUM_UNIFORM_BUFFERS) {
+        return;
+    }
+    auto& uniformBuffer = _resource._uniformBuffers[slot];
+    uniformBuffer._buffer = batch._buffers.get(batch._params[paramOffset + 2]._uint);
+    uniformBuffer._offset = batch._params[paramOffset + 1]._uint;
+    uniformBuffer._size = batch._params[paramOffset + 0]._uint;
+    _resource._invalidSet = true;
+}
+
+void VKBackend::do_setResourceBuffer(const Batch& batch, size_t paramOffset) {
+    uint32 slot = batch._params[paramOffset + 1]._uint;
+    if (slot >= MAX_NUM_RESOURCE_BUFFERS) {
+        return;
+    }
+    _resource._resourceBuffers[slot] = batch._buffers.get(batch._params[paramOffset + 0]._uint);
+    _resource._invalidSet = true;
+}
+
+void VKBackend::do_setFramebuffer(const Batch& batch, size_t paramOffset) {
+    // only the default framebuffer, which is the frame target, is ported
+    const auto& framebuffer = batch._framebuffers.get(batch._params[paramOffset]._uint);
+    _pipeline._toFrameTarget = !framebuffer;
+}
+
+void VKBackend::do_resetStages(const Batch& batch, size_t paramOffset) {
+    resetStages();
+}
+
+void VKBackend::do_runLambda(const Batch& batch, size_t paramOffset) {
+    std::function<void()> f = batch._lambdas.get(batch._params[paramOffset]._uint);
+    f();
+}
+
+void VKBackend::do_notPorted(const Batch& batch, size_t paramOffset) {
+}
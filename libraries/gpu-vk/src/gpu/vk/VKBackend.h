@@ -0,0 +1,186 @@
+//
+//  VKBackend.h
+//  libraries/gpu-vk/src/gpu/vk
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_gpu_vk_VKBackend_h
+#define hifi_gpu_vk_VKBackend_h
+
+#include <array>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <gpu/Batch.h>
+#include <gpu/Context.h>
+
+#include "VKShared.h"
+#include "VKDescriptorPool.h"
+
+namespace gpu { namespace vk {
+
+class VKPipeline;
+
+// The device the backend records for, created by the display plugin that presents its frames
+struct VKDevice {
+    VkPhysicalDevice physicalDevice { VK_NULL_HANDLE };
+    VkDevice device { VK_NULL_HANDLE };
+};
+
+// Where a frame's batches are recorded: a command buffer in which the render pass of the presented image has begun
+struct VKFrameTarget {
+    VkCommandBuffer commandBuffer { VK_NULL_HANDLE };
+    VkRenderPass renderPass { VK_NULL_HANDLE };
+    VkExtent2D extent { 0, 0 };
+    uint32_t numColorAttachments { 1 };
+};
+
+// A Vulkan implementation of gpu::Backend, translating the batches' commands into a command buffer like GLBackend
+// translates them into GL calls.
+//
+// Only the commands that draw into the frame target are ported so far: the input, pipeline and uniform and resource
+// buffer stages.  The transform stage, textures, offscreen framebuffers and queries aren't, so draws with programs that
+// sample textures, or into a framebuffer other than the frame target, are skipped.
+class VKBackend : public Backend, public std::enable_shared_from_this<VKBackend> {
+    using Parent = Backend;
+    // Context Backend static interface required
+    friend class gpu::Context;
+    static void init() {}
+    static BackendPointer createBackend();
+
+public:
+    static const uint32_t NUM_FRAMES_IN_FLIGHT { 3 };
+    static const uint32_t MAX_NUM_INPUT_BUFFERS { 16 };
+    static const uint32_t MAX_NUM_UNIFORM_BUFFERS { 16 };
+    static const uint32_t MAX_NUM_RESOURCE_BUFFERS { 16 };
+
+    // Must be called before Context::init<VKBackend>()
+    static void setDevice(const VKDevice& device);
+
+    ~VKBackend();
+
+    void shutdown() override;
+    const std::string& getVersion() const override;
+
+    // Starts recording a frame into the target.  The frame that was started NUM_FRAMES_IN_FLIGHT frames ago must be done
+    // on the GPU, since its descriptor sets and released objects are reused.
+    void beginFrame(const VKFrameTarget& target);
+    void endFrame();
+
+    void render(const Batch& batch) final;
+
+    void syncCache() final {}
+    void syncProgram(const gpu::ShaderPointer& program) final {}
+    void recycle() const final;
+    void downloadFramebuffer(const FramebufferPointer& srcFramebuffer, const Vec4i& region, QImage& destImage) final {}
+
+    bool supportedTextureFormat(const gpu::Element& format) final { return false; }
+    bool isTextureManagementSparseEnabled() const final { return false; }
+
+    const VKDevice& getDevice() const { return _device; }
+    VkPipelineCache getPipelineCache() const { return _pipelineCache; }
+
+    // Destroys Vulkan objects once the frames in flight that may use them are done
+    void releaseLater(std::function<void(VkDevice)>&& release);
+
+    typedef void (VKBackend::*CommandCall)(const Batch&, size_t);
+
+protected:
+    VKBackend(const VKDevice& device);
+
+    void do_draw(const Batch& batch, size_t paramOffset);
+    void do_drawIndexed(const Batch& batch, size_t paramOffset);
+    void do_drawInstanced(const Batch& batch, size_t paramOffset);
+    void do_drawIndexedInstanced(const Batch& batch, size_t paramOffset);
+
+    void do_setInputFormat(const Batch& batch, size_t paramOffset);
+    void do_setInputBuffer(const Batch& batch, size_t paramOffset);
+    void do_setIndexBuffer(const Batch& batch, size_t paramOffset);
+
+    void do_setViewportTransform(const Batch& batch, size_t paramOffset);
+
+    void do_setPipeline(const Batch& batch, size_t paramOffset);
+    void do_setStateBlendFactor(const Batch& batch, size_t paramOffset);
+    void do_setStateScissorRect(const Batch& batch, size_t paramOffset);
+
+    void do_setUniformBuffer(const Batch& batch, size_t paramOffset);
+    void do_setResourceBuffer(const Batch& batch, size_t paramOffset);
+
+    void do_setFramebuffer(const Batch& batch, size_t paramOffset);
+
+    void do_resetStages(const Batch& batch, size_t paramOffset);
+    void do_runLambda(const Batch& batch, size_t paramOffset);
+
+    // The commands that aren't ported yet
+    void do_notPorted(const Batch& batch, size_t paramOffset);
+
+    void resetStages();
+    // Binds what the next draw needs, returning false if it can't be drawn
+    bool prepareDraw(Primitive primitive, bool indexed);
+
+    static CommandCall _commandCalls[Batch::NUM_COMMANDS];
+
+    static VKDevice _initialDevice;
+
+    const VKDevice _device;
+    VkPipelineCache _pipelineCache { VK_NULL_HANDLE };
+    VKDescriptorPool _descriptorPool;
+
+    VKFrameTarget _target;
+    uint32_t _frameIndex { 0 };
+    bool _inFrame { false };
+
+    struct InputStageState {
+        Stream::FormatPointer _format;
+        std::array<BufferPointer, MAX_NUM_INPUT_BUFFERS> _buffers;
+        std::array<VkDeviceSize, MAX_NUM_INPUT_BUFFERS> _offsets;
+        bool _invalidBuffers { true };
+        BufferPointer _indexBuffer;
+        VkDeviceSize _indexBufferOffset { 0 };
+        Type _indexBufferType { UINT32 };
+        bool _invalidIndexBuffer { true };
+    } _input;
+
+    struct PipelineStageState {
+        PipelinePointer _pipeline;
+        VKPipeline* _object { nullptr };
+        VkPipeline _boundPipeline { VK_NULL_HANDLE };
+        bool _toFrameTarget { true };
+    } _pipeline;
+
+    struct UniformBufferState {
+        BufferPointer _buffer;
+        VkDeviceSize _offset { 0 };
+        VkDeviceSize _size { 0 };
+    };
+
+    struct ResourceStageState {
+        std::array<UniformBufferState, MAX_NUM_UNIFORM_BUFFERS> _uniformBuffers;
+        std::array<BufferPointer, MAX_NUM_RESOURCE_BUFFERS> _resourceBuffers;
+        bool _invalidSet { true };
+    } _resource;
+
+    struct OutputStageState {
+        VkViewport _viewport {};
+        VkRect2D _scissor {};
+        bool _invalidViewport { true };
+    } _output;
+
+    struct Release {
+        uint32_t frame;
+        std::function<void(VkDevice)> release;
+    };
+    mutable std::mutex _releasesMutex;
+    mutable std::vector<Release> _releases;
+};
+
+} }
+
+#endif // hifi_gpu_vk_VKBackend_h
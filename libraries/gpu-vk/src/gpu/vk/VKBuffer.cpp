@@ -0,0 +1,118 @@
+//
+//  VKBuffer.cpp
+//  libraries/gpu-vk/src/gpu/vk
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "VKBuffer.h"
+
+#include "VKBackend.h"
+
+using namespace gpu;
+using namespace gpu::vk;
+
+static const VkBufferUsageFlags BUFFER_USAGE = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
+                                               VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                               VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT;
+
+VKBuffer* VKBuffer::sync(VKBackend& backend, const Buffer& buffer) {
+    VKBuffer* object = Backend::getGPUObject<VKBuffer>(buffer);
+
+    // Has the storage size changed?
+    if (!object || object->_stamp != buffer._renderSysmem.getStamp()) {
+        const VKDevice& device = backend.getDevice();
+        Size size = buffer._renderSysmem.getSize();
+
+        VkBufferCreateInfo bufferInfo { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+        bufferInfo.size = size == 0 ? 256 : size;
+        bufferInfo.usage = BUFFER_USAGE;
+        bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        VkBuffer vkBuffer = VK_NULL_HANDLE;
+        if (vkCreateBuffer(device.device, &bufferInfo, nullptr, &vkBuffer) != VK_SUCCESS) {
+            qCWarning(gpu_vk_logging) << "Failed to create a buffer of" << bufferInfo.size << "bytes";
+            return object;
+        }
+
+        VkMemoryRequirements requirements;
+        vkGetBufferMemoryRequirements(device.device, vkBuffer, &requirements);
+        int32_t memoryType = findMemoryType(device.physicalDevice, requirements.memoryTypeBits,
+                                            VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+        VkMemoryAllocateInfo allocateInfo { VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO };
+        allocateInfo.allocationSize = requirements.size;
+        allocateInfo.memoryTypeIndex = (uint32_t)memoryType;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        void* mapped = nullptr;
+        if (memoryType < 0 || vkAllocateMemory(device.device, &allocateInfo, nullptr, &memory) != VK_SUCCESS ||
+            vkBindBufferMemory(device.device, vkBuffer, memory, 0) != VK_SUCCESS ||
+            vkMapMemory(device.device, memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS) {
+            qCWarning(gpu_vk_logging) << "Failed to allocate the memory of a buffer of" << bufferInfo.size << "bytes";
+            if (memory) {
+                vkFreeMemory(device.device, memory, nullptr);
+            }
+            vkDestroyBuffer(device.device, vkBuffer, nullptr);
+            return object;
+        }
+
+        // the whole buffer is copied below, so the original's content doesn't need to be
+        object = new VKBuffer(backend.shared_from_this(), vkBuffer, memory, mapped, buffer);
+        if (size != 0) {
+            memcpy(object->_mapped, buffer._renderSysmem.readData(), size);
+        }
+        buffer._renderPages._flags &= ~PageManager::DIRTY;
+        Backend::setGPUObject(buffer, object);
+        Backend::bufferCount.increment();
+        Backend::bufferGPUMemSize.update(0, object->_size);
+    }
+
+    if (0 != (buffer._renderPages._flags & PageManager::DIRTY)) {
+        object->transfer();
+    }
+
+    return object;
+}
+
+VkBuffer VKBuffer::getBuffer(VKBackend& backend, const Buffer& buffer) {
+    VKBuffer* object = sync(backend, buffer);
+    return object ? object->_buffer : VK_NULL_HANDLE;
+}
+
+VKBuffer::VKBuffer(const std::weak_ptr<VKBackend>& backend, VkBuffer vkBuffer, VkDeviceMemory memory, void* mapped,
+                   const Buffer& buffer) :
+    _buffer(vkBuffer),
+    _memory(memory),
+    _size(buffer._renderSysmem.getSize()),
+    _stamp(buffer._renderSysmem.getStamp()),
+    _backend(backend),
+    _gpuObject(buffer),
+    _mapped((uint8_t*)mapped) {
+}
+
+VKBuffer::~VKBuffer() {
+    Backend::bufferCount.decrement();
+    Backend::bufferGPUMemSize.update(_size, 0);
+    auto backend = _backend.lock();
+    if (backend) {
+        VkBuffer buffer = _buffer;
+        VkDeviceMemory memory = _memory;
+        backend->releaseLater([buffer, memory](VkDevice device) {
+            vkDestroyBuffer(device, buffer, nullptr);
+            vkFreeMemory(device, memory, nullptr);
+        });
+    }
+}
+
+void VKBuffer::transfer() {
+    Size offset;
+    Size size;
+    Size currentPage { 0 };
+    auto data = _gpuObject._renderSysmem.readData();
+    while (_gpuObject._renderPages.getNextTransferBlock(offset, size, currentPage)) {
+        memcpy(_mapped + offset, data + offset, size);
+    }
+    _gpuObject._renderPages._flags &= ~PageManager::DIRTY;
+}
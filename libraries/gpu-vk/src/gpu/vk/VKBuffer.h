@@ -0,0 +1,54 @@
+//
+//  VKBuffer.h
+//  libraries/gpu-vk/src/gpu/vk
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_gpu_vk_VKBuffer_h
+#define hifi_gpu_vk_VKBuffer_h
+
+#include <memory>
+
+#include <gpu/Buffer.h>
+
+#include "VKShared.h"
+
+namespace gpu { namespace vk {
+
+class VKBackend;
+
+// The Vulkan buffer of a gpu::Buffer.  Its memory is host visible and coherent, and the dirty pages are copied into it
+// when a batch uses it, like GL45Buffer's glNamedBufferSubData.
+//
+// FIXME the copy isn't ordered with the frames still in flight that read the buffer, as GL's is.  Buffers updated
+// every frame need to be staged, or versioned per frame, like the transforms are in GL45Backend.
+class VKBuffer : public GPUObject {
+public:
+    static VKBuffer* sync(VKBackend& backend, const Buffer& buffer);
+    static VkBuffer getBuffer(VKBackend& backend, const Buffer& buffer);
+
+    ~VKBuffer();
+
+    const VkBuffer _buffer;
+    const VkDeviceMemory _memory;
+    const Size _size;
+    const Stamp _stamp;
+
+private:
+    VKBuffer(const std::weak_ptr<VKBackend>& backend, VkBuffer vkBuffer, VkDeviceMemory memory, void* mapped,
+             const Buffer& buffer);
+    void transfer();
+
+    const std::weak_ptr<VKBackend> _backend;
+    const Buffer& _gpuObject;
+    uint8_t* const _mapped;
+};
+
+} }
+
+#endif // hifi_gpu_vk_VKBuffer_h
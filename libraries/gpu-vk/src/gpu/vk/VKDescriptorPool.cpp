@@ -0,0 +1,88 @@
+//
+//  VKDescriptorPool.cpp
+//  libraries/gpu-vk/src/gpu/vk
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "VKDescriptorPool.h"
+
+using namespace gpu;
+using namespace gpu::vk;
+
+void VKDescriptorPool::create(VkDevice device, uint32_t numFrames) {
+    _device = device;
+    _frames.resize(numFrames);
+    _frameIndex = 0;
+}
+
+void VKDescriptorPool::destroy() {
+    for (auto& frame : _frames) {
+        for (auto pool : frame.pools) {
+            vkDestroyDescriptorPool(_device, pool, nullptr);
+        }
+    }
+    _frames.clear();
+}
+
+void VKDescriptorPool::beginFrame(uint32_t frameIndex) {
+    _frameIndex = frameIndex % (uint32_t)_frames.size();
+    auto& frame = _frames[_frameIndex];
+    for (auto pool : frame.pools) {
+        vkResetDescriptorPool(_device, pool, 0);
+    }
+    frame.currentPool = 0;
+}
+
+VkDescriptorSet VKDescriptorPool::allocate(VkDescriptorSetLayout layout) {
+    auto& frame = _frames[_frameIndex];
+    VkDescriptorSetAllocateInfo allocateInfo { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO };
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &layout;
+
+    while (true) {
+        if (frame.currentPool == frame.pools.size()) {
+            VkDescriptorPool pool = createPool();
+            if (!pool) {
+                return VK_NULL_HANDLE;
+            }
+            frame.pools.push_back(pool);
+        }
+
+        allocateInfo.descriptorPool = frame.pools[frame.currentPool];
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        VkResult result = vkAllocateDescriptorSets(_device, &allocateInfo, &set);
+        if (result == VK_SUCCESS) {
+            return set;
+        }
+        if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL) {
+            qCWarning(gpu_vk_logging) << "Failed to allocate a descriptor set" << result;
+            return VK_NULL_HANDLE;
+        }
+        // this pool is full, until the frame comes around again
+        frame.currentPool++;
+    }
+}
+
+VkDescriptorPool VKDescriptorPool::createPool() const {
+    // sized for sets of a few uniform buffers, resource buffers and textures each
+    const VkDescriptorPoolSize POOL_SIZES[] = {
+        { VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 8 * MAX_SETS_PER_POOL },
+        { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4 * MAX_SETS_PER_POOL },
+        { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 8 * MAX_SETS_PER_POOL }
+    };
+    VkDescriptorPoolCreateInfo poolInfo { VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO };
+    poolInfo.maxSets = MAX_SETS_PER_POOL;
+    poolInfo.poolSizeCount = sizeof(POOL_SIZES) / sizeof(POOL_SIZES[0]);
+    poolInfo.pPoolSizes = POOL_SIZES;
+    VkDescriptorPool pool = VK_NULL_HANDLE;
+    if (vkCreateDescriptorPool(_device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+        qCWarning(gpu_vk_logging) << "Failed to create a descriptor pool";
+        return VK_NULL_HANDLE;
+    }
+    return pool;
+}
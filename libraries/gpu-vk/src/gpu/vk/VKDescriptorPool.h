@@ -0,0 +1,50 @@
+//
+//  VKDescriptorPool.h
+//  libraries/gpu-vk/src/gpu/vk
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_gpu_vk_VKDescriptorPool_h
+#define hifi_gpu_vk_VKDescriptorPool_h
+
+#include <vector>
+
+#include "VKShared.h"
+
+namespace gpu { namespace vk {
+
+// The descriptor sets of the frames in flight.  Each frame allocates its sets from its own pools, which are all reset at
+// once when the frame comes around again, rather than freeing each set.
+class VKDescriptorPool {
+public:
+    static const uint32_t MAX_SETS_PER_POOL { 1024 };
+
+    void create(VkDevice device, uint32_t numFrames);
+    void destroy();
+
+    // Reuses the pools of that frame, once the GPU is done with the frame that last used them
+    void beginFrame(uint32_t frameIndex);
+
+    VkDescriptorSet allocate(VkDescriptorSetLayout layout);
+
+private:
+    struct Frame {
+        std::vector<VkDescriptorPool> pools;
+        size_t currentPool { 0 };
+    };
+
+    VkDescriptorPool createPool() const;
+
+    VkDevice _device { VK_NULL_HANDLE };
+    std::vector<Frame> _frames;
+    uint32_t _frameIndex { 0 };
+};
+
+} }
+
+#endif // hifi_gpu_vk_VKDescriptorPool_h
@@ -0,0 +1,297 @@
+//
+//  VKPipeline.cpp
+//  libraries/gpu-vk/src/gpu/vk
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "VKPipeline.h"
+
+#include <gpu/Shader.h>
+
+#include "VKBackend.h"
+
+using namespace gpu;
+using namespace gpu::vk;
+
+static VkShaderModule createShaderModule(VkDevice device, const Shader& shader) {
+    const auto& source = shader.getSource();
+    auto dialectSource = source.dialectSources.find(shader::DEFAULT_DIALECT);
+    if (dialectSource == source.dialectSources.end()) {
+        return VK_NULL_HANDLE;
+    }
+    auto variantSource = dialectSource->second.variantSources.find(shader::Variant::Mono);
+    if (variantSource == dialectSource->second.variantSources.end()) {
+        return VK_NULL_HANDLE;
+    }
+    const auto& spirv = variantSource->second.spirv;
+    if (spirv.empty() || (spirv.size() % sizeof(uint32_t)) != 0) {
+        return VK_NULL_HANDLE;
+    }
+
+    VkShaderModuleCreateInfo moduleInfo { VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO };
+    moduleInfo.codeSize = spirv.size();
+    moduleInfo.pCode = reinterpret_cast<const uint32_t*>(spirv.data());
+    VkShaderModule module = VK_NULL_HANDLE;
+    if (vkCreateShaderModule(device, &moduleInfo, nullptr, &module) != VK_SUCCESS) {
+        return VK_NULL_HANDLE;
+    }
+    return module;
+}
+
+static void addBindings(std::vector<VkDescriptorSetLayoutBinding>& bindings, const shader::Reflection::LocationMap& locations,
+                        VkDescriptorType type, uint32_t bindingBase) {
+    for (const auto& location : locations) {
+        VkDescriptorSetLayoutBinding binding {};
+        binding.binding = bindingBase + (uint32_t)location.second;
+        binding.descriptorType = type;
+        binding.descriptorCount = 1;
+        binding.stageFlags = VK_SHADER_STAGE_ALL_GRAPHICS;
+        bindings.push_back(binding);
+    }
+}
+
+VKPipeline* VKPipeline::sync(VKBackend& backend, const Pipeline& pipeline) {
+    VKPipeline* object = Backend::getGPUObject<VKPipeline>(pipeline);
+    if (object) {
+        return object;
+    }
+
+    const auto& program = pipeline.getProgram();
+    const auto& state = pipeline.getState();
+    if (!program || !state) {
+        return nullptr;
+    }
+
+    VkDevice device = backend.getDevice().device;
+    static const VkShaderStageFlagBits STAGES[Shader::NUM_DOMAINS] = {
+        VK_SHADER_STAGE_VERTEX_BIT,
+        VK_SHADER_STAGE_FRAGMENT_BIT,
+        VK_SHADER_STAGE_GEOMETRY_BIT
+    };
+    std::vector<VkPipelineShaderStageCreateInfo> stages;
+    const auto& shaders = program->getShaders();
+    for (size_t i = 0; i < shaders.size() && i < Shader::NUM_DOMAINS; i++) {
+        if (!shaders[i]) {
+            continue;
+        }
+        VkShaderModule module = createShaderModule(device, *shaders[i]);
+        if (!module) {
+            qCWarning(gpu_vk_logging) << "No SPIR-V for shader" << shaders[i]->getSource().name.c_str();
+            for (auto& stage : stages) {
+                vkDestroyShaderModule(device, stage.module, nullptr);
+            }
+            return nullptr;
+        }
+        VkPipelineShaderStageCreateInfo stage { VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO };
+        stage.stage = STAGES[i];
+        stage.module = module;
+        stage.pName = "main";
+        stages.push_back(stage);
+    }
+
+    auto reflection = program->getReflection(shader::DEFAULT_DIALECT, shader::Variant::Mono);
+    std::vector<VkDescriptorSetLayoutBinding> bindings;
+    addBindings(bindings, reflection.uniformBuffers, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 0);
+    addBindings(bindings, reflection.resourceBuffers, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, RESOURCE_BUFFER_BINDING_BASE);
+    addBindings(bindings, reflection.textures, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, TEXTURE_BINDING_BASE);
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo { VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO };
+    setLayoutInfo.bindingCount = (uint32_t)bindings.size();
+    setLayoutInfo.pBindings = bindings.data();
+    VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+    vkCreateDescriptorSetLayout(device, &setLayoutInfo, nullptr, &setLayout);
+
+    VkPipelineLayoutCreateInfo layoutInfo { VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO };
+    layoutInfo.setLayoutCount = 1;
+    layoutInfo.pSetLayouts = &setLayout;
+    VkPipelineLayout layout = VK_NULL_HANDLE;
+    vkCreatePipelineLayout(device, &layoutInfo, nullptr, &layout);
+
+    object = new VKPipeline(backend.shared_from_this(), pipeline, setLayout, layout, reflection, std::move(stages));
+    Backend::setGPUObject(pipeline, object);
+    return object;
+}
+
+VKPipeline::VKPipeline(const std::weak_ptr<VKBackend>& backend, const Pipeline& pipeline, VkDescriptorSetLayout setLayout,
+                       VkPipelineLayout layout, const shader::Reflection& reflection,
+                       std::vector<VkPipelineShaderStageCreateInfo>&& stages) :
+    _setLayout(setLayout),
+    _layout(layout),
+    _reflection(reflection),
+    _backend(backend),
+    _gpuObject(pipeline),
+    _stages(std::move(stages)) {
+}
+
+VKPipeline::~VKPipeline() {
+    auto backend = _backend.lock();
+    if (!backend) {
+        return;
+    }
+    std::vector<VkPipeline> variants;
+    for (const auto& variant : _variants) {
+        variants.push_back(variant.second);
+    }
+    std::vector<VkShaderModule> modules;
+    for (const auto& stage : _stages) {
+        modules.push_back(stage.module);
+    }
+    VkPipelineLayout layout = _layout;
+    VkDescriptorSetLayout setLayout = _setLayout;
+    backend->releaseLater([variants, modules, layout, setLayout](VkDevice device) {
+        for (auto variant : variants) {
+            vkDestroyPipeline(device, variant, nullptr);
+        }
+        for (auto module : modules) {
+            vkDestroyShaderModule(device, module, nullptr);
+        }
+        vkDestroyPipelineLayout(device, layout, nullptr);
+        vkDestroyDescriptorSetLayout(device, setLayout, nullptr);
+    });
+}
+
+VkPipeline VKPipeline::getVariant(const Stream::Format& format, Primitive primitive, VkRenderPass renderPass,
+                                  uint32_t numColorAttachments) {
+    std::string key = format.getKey() + "|" + std::to_string(primitive) + "|" +
+                      std::to_string((uint64_t)renderPass) + "|" + std::to_string(numColorAttachments);
+    auto variant = _variants.find(key);
+    if (variant != _variants.end()) {
+        return variant->second;
+    }
+
+    auto backend = _backend.lock();
+    if (!backend) {
+        return VK_NULL_HANDLE;
+    }
+
+    // the channels' strides are baked in, as Vulkan has no dynamic strides without extensions, so the batches' strides
+    // have to match their formats'
+    std::vector<VkVertexInputBindingDescription> vertexBindings;
+    for (const auto& channel : format.getChannels()) {
+        VkVertexInputBindingDescription binding {};
+        binding.binding = channel.first;
+        binding.stride = channel.second._stride;
+        binding.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+        vertexBindings.push_back(binding);
+    }
+    std::vector<VkVertexInputAttributeDescription> vertexAttributes;
+    for (const auto& attribute : format.getAttributes()) {
+        VkFormat vertexFormat = toVkVertexFormat(attribute.second._element);
+        if (vertexFormat == VK_FORMAT_UNDEFINED) {
+            qCWarning(gpu_vk_logging) << "Unsupported vertex attribute" << attribute.second.getKey().c_str();
+            continue;
+        }
+        VkVertexInputAttributeDescription description {};
+        description.location = attribute.second._slot;
+        description.binding = attribute.second._channel;
+        description.format = vertexFormat;
+        description.offset = attribute.second._offset;
+        vertexAttributes.push_back(description);
+        if (attribute.second._frequency == Stream::PER_INSTANCE) {
+            for (auto& binding : vertexBindings) {
+                if (binding.binding == description.binding) {
+                    binding.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE;
+                }
+            }
+        }
+    }
+    VkPipelineVertexInputStateCreateInfo vertexInput { VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO };
+    vertexInput.vertexBindingDescriptionCount = (uint32_t)vertexBindings.size();
+    vertexInput.pVertexBindingDescriptions = vertexBindings.data();
+    vertexInput.vertexAttributeDescriptionCount = (uint32_t)vertexAttributes.size();
+    vertexInput.pVertexAttributeDescriptions = vertexAttributes.data();
+
+    VkPipelineInputAssemblyStateCreateInfo inputAssembly { VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO };
+    inputAssembly.topology = toVkTopology(primitive);
+
+    VkPipelineViewportStateCreateInfo viewport { VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO };
+    viewport.viewportCount = 1;
+    viewport.scissorCount = 1;
+
+    const State::Data& state = _gpuObject.getState()->getValues();
+
+    // the viewport is flipped, so the faces keep the winding they have in GL
+    VkPipelineRasterizationStateCreateInfo rasterization { VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO };
+    rasterization.depthClampEnable = state.flags.depthClampEnable;
+    rasterization.polygonMode = toVkPolygonMode(state.fillMode);
+    rasterization.cullMode = toVkCullMode(state.cullMode);
+    rasterization.frontFace = state.flags.frontFaceClockwise ? VK_FRONT_FACE_CLOCKWISE : VK_FRONT_FACE_COUNTER_CLOCKWISE;
+    rasterization.depthBiasEnable = (state.depthBias != 0.0f || state.depthBiasSlopeScale != 0.0f);
+    rasterization.depthBiasConstantFactor = state.depthBias;
+    rasterization.depthBiasSlopeFactor = state.depthBiasSlopeScale;
+    rasterization.lineWidth = 1.0f;
+
+    VkSampleMask sampleMask = state.sampleMask;
+    VkPipelineMultisampleStateCreateInfo multisample { VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO };
+    multisample.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+    multisample.pSampleMask = &sampleMask;
+    multisample.alphaToCoverageEnable = state.flags.alphaToCoverageEnable;
+
+    auto toVkStencilOpState = [&](const State::StencilTest& test, uint8_t writeMask) {
+        VkStencilOpState stencil {};
+        stencil.failOp = toVkStencilOp(test.getFailOp());
+        stencil.passOp = toVkStencilOp(test.getPassOp());
+        stencil.depthFailOp = toVkStencilOp(test.getDepthFailOp());
+        stencil.compareOp = toVkCompareOp(test.getFunction());
+        stencil.compareMask = test.getReadMask();
+        stencil.writeMask = writeMask;
+        stencil.reference = (uint32_t)(uint8_t)test.getReference();
+        return stencil;
+    };
+    VkPipelineDepthStencilStateCreateInfo depthStencil { VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO };
+    depthStencil.depthTestEnable = state.depthTest.isEnabled();
+    depthStencil.depthWriteEnable = state.depthTest.isEnabled() && state.depthTest.getWriteMask();
+    depthStencil.depthCompareOp = toVkCompareOp(state.depthTest.getFunction());
+    depthStencil.stencilTestEnable = state.stencilActivation.isEnabled();
+    depthStencil.front = toVkStencilOpState(state.stencilTestFront, state.stencilActivation.getWriteMaskFront());
+    depthStencil.back = toVkStencilOpState(state.stencilTestBack, state.stencilActivation.getWriteMaskBack());
+
+    const auto& blend = state.blendFunction;
+    VkPipelineColorBlendAttachmentState blendAttachment {};
+    blendAttachment.blendEnable = blend.isEnabled();
+    blendAttachment.srcColorBlendFactor = toVkBlendFactor(blend.getSourceColor());
+    blendAttachment.dstColorBlendFactor = toVkBlendFactor(blend.getDestinationColor());
+    blendAttachment.colorBlendOp = toVkBlendOp(blend.getOperationColor());
+    blendAttachment.srcAlphaBlendFactor = toVkBlendFactor(blend.getSourceAlpha());
+    blendAttachment.dstAlphaBlendFactor = toVkBlendFactor(blend.getDestinationAlpha());
+    blendAttachment.alphaBlendOp = toVkBlendOp(blend.getOperationAlpha());
+    blendAttachment.colorWriteMask = toVkColorComponents(state.colorWriteMask);
+    std::vector<VkPipelineColorBlendAttachmentState> blendAttachments(numColorAttachments, blendAttachment);
+    VkPipelineColorBlendStateCreateInfo colorBlend { VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO };
+    colorBlend.attachmentCount = numColorAttachments;
+    colorBlend.pAttachments = blendAttachments.data();
+
+    const VkDynamicState DYNAMIC_STATES[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR,
+                                              VK_DYNAMIC_STATE_BLEND_CONSTANTS };
+    VkPipelineDynamicStateCreateInfo dynamic { VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO };
+    dynamic.dynamicStateCount = sizeof(DYNAMIC_STATES) / sizeof(DYNAMIC_STATES[0]);
+    dynamic.pDynamicStates = DYNAMIC_STATES;
+
+    VkGraphicsPipelineCreateInfo pipelineInfo { VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO };
+    pipelineInfo.stageCount = (uint32_t)_stages.size();
+    pipelineInfo.pStages = _stages.data();
+    pipelineInfo.pVertexInputState = &vertexInput;
+    pipelineInfo.pInputAssemblyState = &inputAssembly;
+    pipelineInfo.pViewportState = &viewport;
+    pipelineInfo.pRasterizationState = &rasterization;
+    pipelineInfo.pMultisampleState = &multisample;
+    pipelineInfo.pDepthStencilState = &depthStencil;
+    pipelineInfo.pColorBlendState = &colorBlend;
+    pipelineInfo.pDynamicState = &dynamic;
+    pipelineInfo.layout = _layout;
+    pipelineInfo.renderPass = renderPass;
+
+    VkPipeline vkPipeline = VK_NULL_HANDLE;
+    if (vkCreateGraphicsPipelines(backend->getDevice().device, backend->getPipelineCache(), 1, &pipelineInfo, nullptr,
+                                  &vkPipeline) != VK_SUCCESS) {
+        qCWarning(gpu_vk_logging) << "Failed to create a pipeline for format" << format.getKey().c_str();
+        vkPipeline = VK_NULL_HANDLE;
+    }
+    _variants[key] = vkPipeline;
+    return vkPipeline;
+}
@@ -0,0 +1,59 @@
+//
+//  VKPipeline.h
+//  libraries/gpu-vk/src/gpu/vk
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_gpu_vk_VKPipeline_h
+#define hifi_gpu_vk_VKPipeline_h
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <gpu/Pipeline.h>
+#include <gpu/Stream.h>
+
+#include "VKShared.h"
+
+namespace gpu { namespace vk {
+
+class VKBackend;
+
+// The Vulkan objects of a gpu::Pipeline: its shader modules, and the layout of the descriptor set its reflection asks
+// for.  Vulkan pipelines also bake in the vertex format, the primitive and the render pass, which gpu::Pipeline doesn't
+// know about, so a VkPipeline is created for each combination of them the pipeline is drawn with, and kept until the
+// gpu::Pipeline is released.
+class VKPipeline : public GPUObject {
+public:
+    static VKPipeline* sync(VKBackend& backend, const Pipeline& pipeline);
+
+    ~VKPipeline();
+
+    VkPipeline getVariant(const Stream::Format& format, Primitive primitive, VkRenderPass renderPass,
+                          uint32_t numColorAttachments);
+
+    const VkDescriptorSetLayout _setLayout;
+    const VkPipelineLayout _layout;
+    const shader::Reflection _reflection;
+
+private:
+    VKPipeline(const std::weak_ptr<VKBackend>& backend, const Pipeline& pipeline, VkDescriptorSetLayout setLayout,
+               VkPipelineLayout layout, const shader::Reflection& reflection,
+               std::vector<VkPipelineShaderStageCreateInfo>&& stages);
+
+    const std::weak_ptr<VKBackend> _backend;
+    const Pipeline& _gpuObject;
+    const std::vector<VkPipelineShaderStageCreateInfo> _stages;
+    std::unordered_map<std::string, VkPipeline> _variants;
+};
+
+} }
+
+#endif // hifi_gpu_vk_VKPipeline_h
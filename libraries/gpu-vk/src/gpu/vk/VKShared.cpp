@@ -0,0 +1,164 @@
+//
+//  VKShared.cpp
+//  libraries/gpu-vk/src/gpu/vk
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "VKShared.h"
+
+Q_LOGGING_CATEGORY(gpu_vk_logging, "hifi.gpu.vk")
+
+namespace gpu { namespace vk {
+
+VkCompareOp toVkCompareOp(ComparisonFunction function) {
+    // the gpu comparison functions are in the same order as Vulkan's
+    static_assert(VK_COMPARE_OP_NEVER == (int)NEVER && VK_COMPARE_OP_ALWAYS == (int)ALWAYS, "comparison functions mismatch");
+    return (VkCompareOp)function;
+}
+
+VkStencilOp toVkStencilOp(State::StencilOp op) {
+    static const VkStencilOp STENCIL_OPS[State::NUM_STENCIL_OPS] = {
+        VK_STENCIL_OP_KEEP,
+        VK_STENCIL_OP_ZERO,
+        VK_STENCIL_OP_REPLACE,
+        VK_STENCIL_OP_INCREMENT_AND_CLAMP,
+        VK_STENCIL_OP_DECREMENT_AND_CLAMP,
+        VK_STENCIL_OP_INVERT,
+        VK_STENCIL_OP_INCREMENT_AND_WRAP,
+        VK_STENCIL_OP_DECREMENT_AND_WRAP
+    };
+    return STENCIL_OPS[op];
+}
+
+VkBlendFactor toVkBlendFactor(State::BlendArg arg) {
+    static const VkBlendFactor BLEND_FACTORS[State::NUM_BLEND_ARGS] = {
+        VK_BLEND_FACTOR_ZERO,
+        VK_BLEND_FACTOR_ONE,
+        VK_BLEND_FACTOR_SRC_COLOR,
+        VK_BLEND_FACTOR_ONE_MINUS_SRC_COLOR,
+        VK_BLEND_FACTOR_SRC_ALPHA,
+        VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA,
+        VK_BLEND_FACTOR_DST_ALPHA,
+        VK_BLEND_FACTOR_ONE_MINUS_DST_ALPHA,
+        VK_BLEND_FACTOR_DST_COLOR,
+        VK_BLEND_FACTOR_ONE_MINUS_DST_COLOR,
+        VK_BLEND_FACTOR_SRC_ALPHA_SATURATE,
+        VK_BLEND_FACTOR_CONSTANT_COLOR,
+        VK_BLEND_FACTOR_ONE_MINUS_CONSTANT_COLOR,
+        VK_BLEND_FACTOR_CONSTANT_ALPHA,
+        VK_BLEND_FACTOR_ONE_MINUS_CONSTANT_ALPHA
+    };
+    return BLEND_FACTORS[arg];
+}
+
+VkBlendOp toVkBlendOp(State::BlendOp op) {
+    static const VkBlendOp BLEND_OPS[State::NUM_BLEND_OPS] = {
+        VK_BLEND_OP_ADD,
+        VK_BLEND_OP_SUBTRACT,
+        VK_BLEND_OP_REVERSE_SUBTRACT,
+        VK_BLEND_OP_MIN,
+        VK_BLEND_OP_MAX
+    };
+    return BLEND_OPS[op];
+}
+
+VkPolygonMode toVkPolygonMode(State::FillMode mode) {
+    static const VkPolygonMode POLYGON_MODES[State::NUM_FILL_MODES] = {
+        VK_POLYGON_MODE_POINT,
+        VK_POLYGON_MODE_LINE,
+        VK_POLYGON_MODE_FILL
+    };
+    return POLYGON_MODES[mode];
+}
+
+VkCullModeFlags toVkCullMode(State::CullMode mode) {
+    static const VkCullModeFlags CULL_MODES[State::NUM_CULL_MODES] = {
+        VK_CULL_MODE_NONE,
+        VK_CULL_MODE_FRONT_BIT,
+        VK_CULL_MODE_BACK_BIT
+    };
+    return CULL_MODES[mode];
+}
+
+VkColorComponentFlags toVkColorComponents(uint32_t colorMask) {
+    VkColorComponentFlags components = 0;
+    if (colorMask & State::WRITE_RED) {
+        components |= VK_COLOR_COMPONENT_R_BIT;
+    }
+    if (colorMask & State::WRITE_GREEN) {
+        components |= VK_COLOR_COMPONENT_G_BIT;
+    }
+    if (colorMask & State::WRITE_BLUE) {
+        components |= VK_COLOR_COMPONENT_B_BIT;
+    }
+    if (colorMask & State::WRITE_ALPHA) {
+        components |= VK_COLOR_COMPONENT_A_BIT;
+    }
+    return components;
+}
+
+VkPrimitiveTopology toVkTopology(Primitive primitive) {
+    static const VkPrimitiveTopology TOPOLOGIES[NUM_PRIMITIVES] = {
+        VK_PRIMITIVE_TOPOLOGY_POINT_LIST,
+        VK_PRIMITIVE_TOPOLOGY_LINE_LIST,
+        VK_PRIMITIVE_TOPOLOGY_LINE_STRIP,
+        VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+        VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP,
+        VK_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN
+    };
+    return TOPOLOGIES[primitive];
+}
+
+VkFormat toVkVertexFormat(const Element& element) {
+    // the formats of 1 to 4 components, for each scalar type
+    static const VkFormat FORMATS[NUM_TYPES][4] = {
+        { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT },
+        { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT },
+        { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT },
+        { VK_FORMAT_R16_SFLOAT, VK_FORMAT_R16G16_SFLOAT, VK_FORMAT_R16G16B16_SFLOAT, VK_FORMAT_R16G16B16A16_SFLOAT },
+        { VK_FORMAT_R16_SINT, VK_FORMAT_R16G16_SINT, VK_FORMAT_R16G16B16_SINT, VK_FORMAT_R16G16B16A16_SINT },
+        { VK_FORMAT_R16_UINT, VK_FORMAT_R16G16_UINT, VK_FORMAT_R16G16B16_UINT, VK_FORMAT_R16G16B16A16_UINT },
+        { VK_FORMAT_R8_SINT, VK_FORMAT_R8G8_SINT, VK_FORMAT_R8G8B8_SINT, VK_FORMAT_R8G8B8A8_SINT },
+        { VK_FORMAT_R8_UINT, VK_FORMAT_R8G8_UINT, VK_FORMAT_R8G8B8_UINT, VK_FORMAT_R8G8B8A8_UINT },
+        // Vulkan has no normalized 32 bit formats
+        { VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED },
+        { VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED },
+        { VK_FORMAT_R16_SNORM, VK_FORMAT_R16G16_SNORM, VK_FORMAT_R16G16B16_SNORM, VK_FORMAT_R16G16B16A16_SNORM },
+        { VK_FORMAT_R16_UNORM, VK_FORMAT_R16G16_UNORM, VK_FORMAT_R16G16B16_UNORM, VK_FORMAT_R16G16B16A16_UNORM },
+        { VK_FORMAT_R8_SNORM, VK_FORMAT_R8G8_SNORM, VK_FORMAT_R8G8B8_SNORM, VK_FORMAT_R8G8B8A8_SNORM },
+        { VK_FORMAT_R8_UNORM, VK_FORMAT_R8G8_UNORM, VK_FORMAT_R8G8B8_UNORM, VK_FORMAT_R8G8B8A8_UNORM },
+        { VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED },
+        { VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED, VK_FORMAT_A2B10G10R10_SNORM_PACK32 },
+        { VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED, VK_FORMAT_UNDEFINED }
+    };
+    if (element.getDimension() > VEC4) {
+        return VK_FORMAT_UNDEFINED;
+    }
+    VkFormat format = FORMATS[element.getType()][element.getDimension()];
+    if (element.getSemantic() == BGRA && format == VK_FORMAT_R8G8B8A8_UNORM) {
+        format = VK_FORMAT_B8G8R8A8_UNORM;
+    }
+    return format;
+}
+
+VkIndexType toVkIndexType(Type type) {
+    return (type == UINT16 || type == INT16) ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+}
+
+int32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeBits, VkMemoryPropertyFlags properties) {
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+    for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+        if ((typeBits & (1 << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return (int32_t)i;
+        }
+    }
+    return -1;
+}
+
+} }
@@ -0,0 +1,49 @@
+//
+//  VKShared.h
+//  libraries/gpu-vk/src/gpu/vk
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_gpu_VKShared_h
+#define hifi_gpu_VKShared_h
+
+#include <vulkan/vulkan.h>
+
+#include <QtCore/QLoggingCategory>
+
+#include <gpu/Forward.h>
+#include <gpu/Format.h>
+#include <gpu/State.h>
+
+Q_DECLARE_LOGGING_CATEGORY(gpu_vk_logging)
+
+namespace gpu { namespace vk {
+
+// All the resources of a program are in descriptor set 0.  The uniform buffers keep their gpu slot as their binding, and
+// the resource buffers and textures are offset from it, since Vulkan doesn't give them separate binding namespaces.
+static const uint32_t RESOURCE_BUFFER_BINDING_BASE = 32;
+static const uint32_t TEXTURE_BINDING_BASE = 64;
+
+VkCompareOp toVkCompareOp(ComparisonFunction function);
+VkStencilOp toVkStencilOp(State::StencilOp op);
+VkBlendFactor toVkBlendFactor(State::BlendArg arg);
+VkBlendOp toVkBlendOp(State::BlendOp op);
+VkPolygonMode toVkPolygonMode(State::FillMode mode);
+VkCullModeFlags toVkCullMode(State::CullMode mode);
+VkColorComponentFlags toVkColorComponents(uint32_t colorMask);
+VkPrimitiveTopology toVkTopology(Primitive primitive);
+// VK_FORMAT_UNDEFINED for the elements that can't be vertex attributes
+VkFormat toVkVertexFormat(const Element& element);
+VkIndexType toVkIndexType(Type type);
+
+// The index of a memory type of the physical device with all the properties, or -1 if there's none
+int32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeBits, VkMemoryPropertyFlags properties);
+
+} }
+
+#endif // hifi_gpu_VKShared_h
@@ -302,6 +302,13 @@ void Batch::setStateScissorRect(const Vec4i& rect) {
     _params.emplace_back(cacheData(sizeof(Vec4i), &rect));
 }
 
+void Batch::setFoveation(const Vec4& eyeCenters, const Vec2& radii) {
+    ADD_COMMAND(setFoveation);
+
+    _params.emplace_back(cacheData(sizeof(Vec4), &eyeCenters));
+    _params.emplace_back(cacheData(sizeof(Vec2), &radii));
+}
+
 void Batch::setUniformBuffer(uint32 slot, const BufferPointer& buffer, Offset offset, Offset size) {
     ADD_COMMAND(setUniformBuffer);
     if (slot >= MAX_NUM_UNIFORM_BUFFERS) {
@@ -507,12 +514,16 @@ bool Batch::isSkyboxEnabled() const {
 }
 
 void Batch::setupNamedCalls(const std::string& instanceName, NamedBatchData::Function function) {
+    setupNamedCalls(instanceName, 1, function);
+}
+
+void Batch::setupNamedCalls(const std::string& instanceName, size_t count, NamedBatchData::Function function) {
     NamedBatchData& instance = _namedData[instanceName];
     if (!instance.function) {
         instance.function = function;
     }
 
-    captureNamedDrawCallInfo(instanceName);
+    captureNamedDrawCallInfo(instanceName, count);
 }
 
 const BufferPointer& Batch::getNamedBuffer(const std::string& instanceName, uint8_t index) {
@@ -544,7 +555,7 @@ const Batch::DrawCallInfoBuffer& Batch::getDrawCallInfoBuffer() const {
     }
 }
 
-void Batch::captureDrawCallInfoImpl() {
+void Batch::captureDrawCallInfoImpl(size_t count) {
     if (_invalidModel) {
         TransformObject object;
         _currentModel.getMatrix(object._model);
@@ -562,7 +573,7 @@ void Batch::captureDrawCallInfoImpl() {
     }
 
     auto& drawCallInfos = getDrawCallInfoBuffer();
-    drawCallInfos.emplace_back((uint16)_objects.size() - 1, _drawcallUniform);
+    drawCallInfos.insert(drawCallInfos.end(), count, DrawCallInfo((uint16)_objects.size() - 1, _drawcallUniform));
     _drawcallUniform = _drawcallUniformReset;
 }
 
@@ -575,9 +586,9 @@ void Batch::captureDrawCallInfo() {
     captureDrawCallInfoImpl();
 }
 
-void Batch::captureNamedDrawCallInfo(std::string name) {
+void Batch::captureNamedDrawCallInfo(std::string name, size_t count) {
     std::swap(_currentNamedCall, name);  // Set and save _currentNamedCall
-    captureDrawCallInfoImpl();
+    captureDrawCallInfoImpl(count);
     std::swap(_currentNamedCall, name);  // Restore _currentNamedCall
 }
 
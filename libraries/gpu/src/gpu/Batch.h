@@ -87,7 +87,7 @@ public:
     DrawCallInfoBuffer& getDrawCallInfoBuffer();
 
     void captureDrawCallInfo();
-    void captureNamedDrawCallInfo(std::string name);
+    void captureNamedDrawCallInfo(std::string name, size_t count = 1);
 
     Batch(const std::string& name = "");
     // Disallow copy construction and assignement of batches
@@ -129,6 +129,8 @@ public:
     void multiDrawIndexedIndirect(uint32 numCommands, Primitive primitiveType);
 
     void setupNamedCalls(const std::string& instanceName, NamedBatchData::Function function);
+    // Makes count calls at once, all with the current model transform, for instances that come in groups
+    void setupNamedCalls(const std::string& instanceName, size_t count, NamedBatchData::Function function);
     const BufferPointer& getNamedBuffer(const std::string& instanceName, uint8_t index = 0);
 
     // Input Stage
@@ -194,6 +196,12 @@ public:
     // the rect coordinates are xy for the low left corner of the rect and zw for the width and height of the rect, expressed in pixels
     void setStateScissorRect(const Vec4i& rect);
 
+    // Shade the periphery of the framebuffers drawn to from here on coarser than the center of the eyes' views, on backends
+    // that can. The framebuffers are taken as a stereo pair side by side, eyeCenters xy for the left eye and zw for the right
+    // are where the full rate shading is centered in [-1, 1] across each eye's half. Out to radii.x from the center,
+    // in the same units, the shading stays at full rate, past radii.y it is at the coarsest; a null radii.y turns it off.
+    void setFoveation(const Vec4& eyeCenters, const Vec2& radii);
+
     void setUniformBuffer(uint32 slot, const BufferPointer& buffer, Offset offset, Offset size);
     void setUniformBuffer(uint32 slot, const BufferView& view); // not a command, just a shortcut from a BufferView
 
@@ -316,6 +324,7 @@ public:
         COMMAND_setPipeline,
         COMMAND_setStateBlendFactor,
         COMMAND_setStateScissorRect,
+        COMMAND_setFoveation,
 
         COMMAND_setUniformBuffer,
         COMMAND_setResourceBuffer,
@@ -550,7 +559,7 @@ protected:
 
 
 
-    void captureDrawCallInfoImpl();
+    void captureDrawCallInfoImpl(size_t count = 1);
 };
 
 template <typename T>
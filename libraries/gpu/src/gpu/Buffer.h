@@ -161,6 +161,7 @@ protected:
     friend class gl41::GL41Buffer;
     friend class gl45::GL45Buffer;
     friend class gles::GLESBuffer;
+    friend class vk::VKBuffer;
 };
 
 using BufferUpdates = std::vector<Buffer::Update>;
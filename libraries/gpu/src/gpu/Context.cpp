@@ -41,6 +41,10 @@ void ContextStats::evalDelta(const ContextStats& begin, const ContextStats& end)
     _DSNumTriangles= subWrap<uint32_t>(end._DSNumTriangles, begin._DSNumTriangles);
 
     _PSNumSetPipelines = subWrap<uint32_t>(end._PSNumSetPipelines, begin._PSNumSetPipelines);
+
+    _TSAmountStreamedMemory = subWrap<uint64_t>(end._TSAmountStreamedMemory, begin._TSAmountStreamedMemory);
+    _TSNumStreamedUploads = subWrap<uint32_t>(end._TSNumStreamedUploads, begin._TSNumStreamedUploads);
+    _TSNumStreamStalls = subWrap<uint32_t>(end._TSNumStreamStalls, begin._TSNumStreamStalls);
 }
 
 
@@ -284,6 +288,8 @@ ContextMetricSize  Backend::texturePendingGPUTransferMemSize;
 
 ContextMetricSize  Backend::textureResourcePopulatedGPUMemSize;
 ContextMetricSize  Backend::textureResourceIdealGPUMemSize;
+ContextMetricCount Backend::textureResourceUnderResolvedCount;
+ContextMetricSize  Backend::textureResourceOverResolvedGPUMemSize;
 
 Size Context::getFreeGPUMemSize() {
     return Backend::freeGPUMemSize.getValue();
@@ -359,6 +365,14 @@ Size Context::getTextureResourceIdealGPUMemSize() {
     return Backend::textureResourceIdealGPUMemSize.getValue();
 }
 
+uint32_t Context::getTextureResourceUnderResolvedGPUCount() {
+    return Backend::textureResourceUnderResolvedCount.getValue();
+}
+
+Size Context::getTextureResourceOverResolvedGPUMemSize() {
+    return Backend::textureResourceOverResolvedGPUMemSize.getValue();
+}
+
 void Context::pushProgramsToSync(const std::vector<uint32_t>& programIDs, std::function<void()> callback, size_t rate) {
     std::vector<gpu::ShaderPointer> programs;
     for (auto programID : programIDs) {
@@ -368,6 +382,10 @@ void Context::pushProgramsToSync(const std::vector<uint32_t>& programIDs, std::f
 }
 
 void Context::pushProgramsToSync(const std::vector<gpu::ShaderPointer>& programs, std::function<void()> callback, size_t rate) {
+    // the backend's async compiler, if any, does the work, processProgramsToSync() then only loads its results
+    for (const auto& program : programs) {
+        Shader::compileAsync(program);
+    }
     Lock lock(_programsToSyncMutex);
     _programsToSyncQueue.emplace(programs, callback, rate == 0 ? programs.size() : rate);
 }
@@ -379,6 +397,11 @@ void Context::processProgramsToSync() {
         size_t numSynced = 0;
         while (_nextProgramToSyncIndex < programsToSync.programs.size() && numSynced < programsToSync.rate) {
             auto nextProgram = programsToSync.programs.at(_nextProgramToSyncIndex);
+            if (!nextProgram->isReady()) {
+                // still being compiled by the backend's async compiler, which is much cheaper to wait for than to
+                // compile it again here
+                break;
+            }
             _backend->syncProgram(nextProgram);
             _syncedPrograms.push_back(nextProgram);
             _nextProgramToSyncIndex++;
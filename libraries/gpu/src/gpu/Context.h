@@ -46,6 +46,12 @@ public:
 
     uint32_t _PSNumSetPipelines { 0 };
 
+    // the transform data written straight to mapped memory, and the buffer uploads that saved
+    uint64_t _TSAmountStreamedMemory { 0 };
+    uint32_t _TSNumStreamedUploads { 0 };
+    // the times the GPU was still reading the mapped memory the next writes needed
+    uint32_t _TSNumStreamStalls { 0 };
+
     ContextStats() {}
     ContextStats(const ContextStats& stats) = default;
 
@@ -117,6 +123,10 @@ public:
     static ContextMetricSize texturePendingGPUTransferMemSize;
     static ContextMetricSize textureResourcePopulatedGPUMemSize;
     static ContextMetricSize textureResourceIdealGPUMemSize;
+    // the resource textures drawn on screen over more pixels than their allocated mips have texels, and the memory
+    // held by mips finer than their textures are drawn on screen
+    static ContextMetricCount textureResourceUnderResolvedCount;
+    static ContextMetricSize textureResourceOverResolvedGPUMemSize;
 
     virtual bool isStereo() const {
         return _stereo.isStereo();
@@ -255,6 +265,8 @@ public:
 
     static Size getTextureResourcePopulatedGPUMemSize();
     static Size getTextureResourceIdealGPUMemSize();
+    static uint32_t getTextureResourceUnderResolvedGPUCount();
+    static Size getTextureResourceOverResolvedGPUMemSize();
 
     struct ProgramsToSync {
         ProgramsToSync(const std::vector<gpu::ShaderPointer>& programs, std::function<void()> callback, size_t rate) :
@@ -40,6 +40,9 @@ const Element Element::COLOR_COMPRESSED_EAC_RED_SIGNED { TILE4x4, COMPRESSED, CO
 const Element Element::COLOR_COMPRESSED_EAC_XY { TILE4x4, COMPRESSED, COMPRESSED_EAC_XY };
 const Element Element::COLOR_COMPRESSED_EAC_XY_SIGNED { TILE4x4, COMPRESSED, COMPRESSED_EAC_XY_SIGNED };
 
+const Element Element::COLOR_COMPRESSED_ASTC_RGBA { TILE4x4, COMPRESSED, COMPRESSED_ASTC_RGBA };
+const Element Element::COLOR_COMPRESSED_ASTC_SRGBA { TILE4x4, COMPRESSED, COMPRESSED_ASTC_SRGBA };
+
 const Element Element::DEPTH24_STENCIL8 { SCALAR, UINT32, DEPTH_STENCIL };
 
 const Element Element::VEC2NU8_XY{ VEC2, NUINT8, XY };
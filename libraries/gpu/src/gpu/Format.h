@@ -220,6 +220,10 @@ enum Semantic : uint8_t {
     SAMPLER_MULTISAMPLE,
     SAMPLER_SHADOW,
 
+    // compressed semantics added since, kept last so that the raw values of the others, which frame captures store, don't change
+    COMPRESSED_ASTC_RGBA,
+    COMPRESSED_ASTC_SRGBA,
+    _LAST_APPENDED_COMPRESSED = COMPRESSED_ASTC_SRGBA,
 
     NUM_SEMANTICS, // total Number of semantics (not a valid Semantic)!
 };
@@ -285,6 +289,9 @@ static const int SEMANTIC_SIZE_FACTOR[NUM_SEMANTICS] = {
     1, //SAMPLER,
     1, //SAMPLER_MULTISAMPLE,
     1, //SAMPLER_SHADOW,
+
+    16, //COMPRESSED_ASTC_RGBA, 4x4 blocks only
+    16, //COMPRESSED_ASTC_SRGBA,
 };
 
 
@@ -308,7 +315,10 @@ public:
 
     Dimension getDimension() const { return (Dimension)_dimension; }
     
-    bool isCompressed() const { return uint8(getSemantic() - _FIRST_COMPRESSED) <= uint8(_LAST_COMPRESSED - _FIRST_COMPRESSED); }
+    bool isCompressed() const {
+        return uint8(getSemantic() - _FIRST_COMPRESSED) <= uint8(_LAST_COMPRESSED - _FIRST_COMPRESSED) ||
+            uint8(getSemantic() - COMPRESSED_ASTC_RGBA) <= uint8(_LAST_APPENDED_COMPRESSED - COMPRESSED_ASTC_RGBA);
+    }
 
     Type getType() const { return (Type)_type; }
     bool isNormalized() const { return (getType() >= NORMALIZED_START); }
@@ -358,6 +368,8 @@ public:
     static const Element COLOR_COMPRESSED_EAC_RED_SIGNED;
     static const Element COLOR_COMPRESSED_EAC_XY;
     static const Element COLOR_COMPRESSED_EAC_XY_SIGNED;
+    static const Element COLOR_COMPRESSED_ASTC_RGBA;
+    static const Element COLOR_COMPRESSED_ASTC_SRGBA;
     static const Element DEPTH24_STENCIL8;
     static const Element VEC2NU8_XY;
     static const Element VEC4F_COLOR_RGBA;
@@ -149,6 +149,11 @@ namespace gpu {
         class GLESBackend;
         class GLESBuffer;
     }
+
+    namespace vk {
+        class VKBackend;
+        class VKBuffer;
+    }
 }
 
 #endif
@@ -41,6 +41,8 @@ namespace gpu {
         FramebufferPointer framebuffer;
         /// How to process the framebuffer when the frame dies.  MUST BE THREAD SAFE
         FramebufferRecycler framebufferRecycler;
+        /// When the frame was submitted to the display plugin, in usecs, for the latency until it's presented
+        uint64_t submitTime { 0 };
 
         std::queue<std::tuple<std::function<void(const QImage&)>, float, bool>> snapshotOperators;
 
@@ -157,6 +157,7 @@ constexpr const char*  COMMAND_NAMES[] = {
     "setPipeline",
     "setStateBlendFactor",
     "setStateScissorRect",
+    "setFoveation",
 
     "setUniformBuffer",
     "setResourceBuffer",
@@ -11,12 +11,33 @@
 
 #include "Shader.h"
 
+#include <mutex>
+
 #include "Context.h"
 
 using namespace gpu;
 
 Shader::ProgramMap Shader::_programMap;
 
+static std::mutex _asyncCompilerMutex;
+static Shader::AsyncCompiler _asyncCompiler;
+
+void Shader::setAsyncCompiler(const AsyncCompiler& compiler) {
+    std::unique_lock<std::mutex> lock(_asyncCompilerMutex);
+    _asyncCompiler = compiler;
+}
+
+void Shader::compileAsync(const Pointer& program, bool skipDrawsUntilReady) {
+    if (!program || !program->isProgram()) {
+        return;
+    }
+    std::unique_lock<std::mutex> lock(_asyncCompilerMutex);
+    if (_asyncCompiler) {
+        program->_skipDrawsUntilReady = skipDrawsUntilReady;
+        program->setReady(false);
+        _asyncCompiler(program);
+    }
+}
 
 Shader::Shader(Type type, const Source& source, bool dynamic) :
     _type(type)
@@ -19,6 +19,7 @@
 #include <unordered_map>
 #include <map>
 #include <functional>
+#include <atomic>
 #include <shaders/Shaders.h>
 #include <QUrl>
 
@@ -113,6 +114,18 @@ public:
     void setCompilationLogs(const CompilationLogs& logs) const;
     void incrementCompilationAttempt() const;
 
+    // A backend can compile programs on a thread of its own before they are used, so their first use only has to load
+    // the result. A program queued that way isn't ready until its compilation is done, whether it succeeded or not.
+    // Draws with a program that isn't ready are skipped if skipDrawsUntilReady is set, otherwise the program is compiled
+    // right away as usual.
+    using AsyncCompiler = std::function<void(const Pointer&)>;
+    static void setAsyncCompiler(const AsyncCompiler& compiler);
+    // Does nothing if the backend has no async compiler, the program stays ready
+    static void compileAsync(const Pointer& program, bool skipDrawsUntilReady = false);
+    bool isReady() const { return _ready; }
+    void setReady(bool ready) const { _ready = ready; }
+    bool skipsDrawsUntilReady() const { return _skipDrawsUntilReady && !_ready; }
+
     const GPUObjectPointer gpuObject{};
 
 protected:
@@ -137,6 +150,10 @@ protected:
     // Whether or not the shader compilation failed
     bool _compilationHasFailed{ false };
 
+    // False while the program is queued for the async compiler
+    mutable std::atomic<bool> _ready{ true };
+    std::atomic<bool> _skipDrawsUntilReady{ false };
+
     // Global maps of the shaders
     // Unique shader ID
     //static std::atomic<ID> _nextShaderID;
@@ -76,6 +76,12 @@ void Texture::setAllowedGPUMemoryUsage(Size size) {
 
 uint8 Texture::NUM_FACES_PER_TYPE[NUM_TYPES] = { 1, 1, 1, 6 };
 
+void Texture::reportScreenSize(float pixels) {
+    // several views can draw the same texture at once
+    float screenSize = _screenSize;
+    while (pixels > screenSize && !_screenSize.compare_exchange_weak(screenSize, pixels)) {}
+}
+
 using Storage = Texture::Storage;
 using PixelsPointer = Texture::PixelsPointer;
 using MemoryStorage = Texture::MemoryStorage;
@@ -730,6 +736,27 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
     int stride = width / numDivisionsPerSide;
     int halfStride = stride / 2;
 
+    // every texel is read, so the texel decoding is chosen once
+    std::function<glm::vec3(uint32)> unpackFunc;
+    float linearFromGamma[256];
+    if (target != gpu::BackendTarget::GLES32) {
+        switch (cubeTexture.getStoredMipFormat().getSemantic()) {
+        case gpu::R11G11B10:
+            unpackFunc = glm::unpackF2x11_1x10;
+            break;
+        case gpu::RGB9E5:
+            unpackFunc = glm::unpackF3x9_E1x5;
+            break;
+        default:
+            assert(false);
+            break;
+        }
+    } else {
+        for (int i = 0; i < 256; i++) {
+            linearFromGamma[i] = powf((float)i / 255.0f, 2.2f);
+        }
+    }
+
     // for each face of cube texture
     for(int face=0; face < gpu::Texture::NUM_CUBE_FACES; face++) {
         PROFILE_RANGE(render_gpu, "ProcessFace");
@@ -818,19 +845,6 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
                 glm::vec3 color{ 0.0f, 0.0f, 0.0f };
 
                 if (target != gpu::BackendTarget::GLES32) {
-                    auto mipFormat = cubeTexture.getStoredMipFormat();
-                    std::function<glm::vec3(uint32)> unpackFunc;
-                    switch (mipFormat.getSemantic()) {
-                    case gpu::R11G11B10:
-                        unpackFunc = glm::unpackF2x11_1x10;
-                        break;
-                    case gpu::RGB9E5:
-                        unpackFunc = glm::unpackF3x9_E1x5;
-                        break;
-                    default:
-                        assert(false);
-                        break;
-                    }
                     auto data32 = reinterpret_cast<const uint32*>(data);
                     for (int i = 0; i < stride; ++i) {
                         for (int j = 0; j < stride; ++j) {
@@ -844,7 +858,7 @@ bool sphericalHarmonicsFromTexture(const gpu::Texture& cubeTexture, std::vector<
                     for (int i = 0; i < stride; ++i) {
                         for (int j = 0; j < stride; ++j) {
                             int k = NUM_COMPONENTS_PER_PIXEL * (int)(x + i - halfStride + (y + j - halfStride) * width);
-                            color += glm::pow(glm::vec3(data[k + 2], data[k + 1], data[k]) / 255.0f, glm::vec3(2.2f));
+                            color += glm::vec3(linearFromGamma[data[k + 2]], linearFromGamma[data[k + 1]], linearFromGamma[data[k]]);
                         }
                     }
                 }
@@ -579,6 +579,11 @@ public:
     bool getImportant() const { return _important; }
     void setImportant(bool important) { _important = important; }
 
+    // Whatever draws the texture reports the size in pixels of the largest area on screen it was drawn over, and the
+    // backend takes the largest reported since it last looked to decide which textures need their finer mips the most
+    void reportScreenSize(float pixels);
+    float takeScreenSize() { return _screenSize.exchange(0.0f); }
+
     const GPUObjectPointer gpuObject {};
 
     ExternalUpdates getUpdates() const;
@@ -643,6 +648,7 @@ protected:
     bool _isIrradianceValid = false;
     bool _defined = false;
     bool _important = false;
+    std::atomic<float> _screenSize { 0.0f };
    
     static TexturePointer create(TextureUsageType usageType, Type type, const Element& texelFormat, uint16 width, uint16 height, uint16 depth, uint16 numSamples, uint16 numSlices, uint16 numMips, const Sampler& sampler);
 
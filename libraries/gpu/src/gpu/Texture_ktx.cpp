@@ -265,7 +265,8 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
             std::lock_guard<std::mutex> lock(*_cacheFileMutex);
             auto file = maybeOpenFile();
             if (file) {
-                storageView = file->createView(faceSize, faceOffset);
+                // The view keeps the file mapped until the mip is uploaded, so the pixels aren't copied to the heap
+                storageView = file->createMappedView(faceSize, faceOffset);
             } else {
                 qWarning() << "Failed to get a valid file out of maybeOpenFile " << QString::fromStdString(_filename);
             }
@@ -274,8 +275,12 @@ PixelsPointer KtxStorage::getMipFace(uint16 level, uint8 face) const {
     if (!storageView) {
         qWarning() << "Failed to get a valid storageView for faceSize=" << faceSize << "  faceOffset=" << faceOffset
                     << "out of valid file " << QString::fromStdString(_filename);
+        return storageView;
     }
-    return storageView->toMemoryStorage();
+    if (_storage) {
+        return storageView->toMemoryStorage();
+    }
+    return storageView;
 }
 
 Size KtxStorage::getMipFaceSize(uint16 level, uint8 face) const {
@@ -657,6 +662,10 @@ bool Texture::evalKTXFormat(const Element& mipFormat, const Element& texelFormat
         header.setCompressed(ktx::GLInternalFormat::COMPRESSED_RG11_EAC, ktx::GLBaseInternalFormat::RG);
     } else if (texelFormat == Format::COLOR_COMPRESSED_EAC_XY_SIGNED && mipFormat == Format::COLOR_COMPRESSED_EAC_XY_SIGNED) {
         header.setCompressed(ktx::GLInternalFormat::COMPRESSED_SIGNED_RG11_EAC, ktx::GLBaseInternalFormat::RG);
+    } else if (texelFormat == Format::COLOR_COMPRESSED_ASTC_RGBA && mipFormat == Format::COLOR_COMPRESSED_ASTC_RGBA) {
+        header.setCompressed(ktx::GLInternalFormat::COMPRESSED_RGBA_ASTC_4x4, ktx::GLBaseInternalFormat::RGBA);
+    } else if (texelFormat == Format::COLOR_COMPRESSED_ASTC_SRGBA && mipFormat == Format::COLOR_COMPRESSED_ASTC_SRGBA) {
+        header.setCompressed(ktx::GLInternalFormat::COMPRESSED_SRGB8_ALPHA8_ASTC_4x4, ktx::GLBaseInternalFormat::RGBA);
     } else if (texelFormat == Format::COLOR_RGB9E5 && mipFormat == Format::COLOR_RGB9E5) {
         header.setUncompressed(ktx::GLType::UNSIGNED_INT_5_9_9_9_REV, 1, ktx::GLFormat::RGB, ktx::GLInternalFormat::RGB9_E5, ktx::GLBaseInternalFormat::RGB);
     } else if (texelFormat == Format::COLOR_R11G11B10 && mipFormat == Format::COLOR_R11G11B10) {
@@ -703,6 +712,10 @@ bool Texture::getCompressedFormat(ktx::GLInternalFormat format, Element& elForma
         elFormat = Format::COLOR_COMPRESSED_EAC_XY;
     } else if (format == ktx::GLInternalFormat::COMPRESSED_SIGNED_RG11_EAC) {
         elFormat = Format::COLOR_COMPRESSED_EAC_XY_SIGNED;
+    } else if (format == ktx::GLInternalFormat::COMPRESSED_RGBA_ASTC_4x4) {
+        elFormat = Format::COLOR_COMPRESSED_ASTC_RGBA;
+    } else if (format == ktx::GLInternalFormat::COMPRESSED_SRGB8_ALPHA8_ASTC_4x4) {
+        elFormat = Format::COLOR_COMPRESSED_ASTC_SRGBA;
     } else {
         return false;
     }
@@ -117,6 +117,18 @@ public:
     const BufferView& getPartBuffer() const { return _partBuffer; }
     size_t getNumParts() const { return _partBuffer.getNumElements(); }
 
+    // A coarser level of detail of the parts, drawn from the LOD index buffer with the same vertices
+    class LOD {
+    public:
+        std::vector<Part> parts; // in the order of the part buffer
+        float error { 0.0f }; // the largest distance of its surface from the full detail one
+    };
+    using LODs = std::vector<LOD>;
+
+    void setLODs(const BufferView& indexBuffer, const LODs& lods);
+    const BufferView& getLODIndexBuffer() const { return _lodIndexBuffer; }
+    const LODs& getLODs() const { return _lods; }
+
     // evaluate the bounding box of A part
     Box evalPartBound(int partNum) const;
     // evaluate the bounding boxes of the parts in the range [start, end]
@@ -154,6 +166,9 @@ protected:
 
     BufferView _partBuffer;
 
+    BufferView _lodIndexBuffer;
+    LODs _lods;
+
     void evalVertexFormat();
     void evalVertexStream();
 
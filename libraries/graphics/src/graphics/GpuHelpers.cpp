@@ -128,6 +128,9 @@ namespace gpu {
         { Semantic::SAMPLER_MULTISAMPLE, "sampler_multisample" },
         { Semantic::SAMPLER_SHADOW, "sampler_shadow" },
 
+        { Semantic::COMPRESSED_ASTC_RGBA, "compressed_astc_rgba" },
+        { Semantic::COMPRESSED_ASTC_SRGBA, "compressed_astc_srgba" },
+
 
         { Semantic::NUM_SEMANTICS, "num_semantics" },
     };
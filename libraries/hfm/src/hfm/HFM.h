@@ -56,12 +56,14 @@ const int MAX_NUM_PIXELS_FOR_FBX_TEXTURE = 8192 * 8192;
 
 using ShapeVertices = std::vector<glm::vec3>;
 // The version of the Draco mesh binary data itself. See also: FBX_DRACO_MESH_VERSION in FBX.h
-static const int DRACO_MESH_VERSION = 3;
+static const int DRACO_MESH_VERSION = 4;
 
 static const int DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES = 1000;
 static const int DRACO_ATTRIBUTE_MATERIAL_ID = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES;
 static const int DRACO_ATTRIBUTE_TEX_COORD_1 = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES + 1;
 static const int DRACO_ATTRIBUTE_ORIGINAL_INDEX = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES + 2;
+// The levels of detail a face is in, a bit per level from the full detail one
+static const int DRACO_ATTRIBUTE_LOD_MASK = DRACO_BEGIN_CUSTOM_HIFI_ATTRIBUTES + 3;
 
 // High Fidelity Model namespace
 namespace hfm {
@@ -155,6 +157,7 @@ public:
     QVector<int> quadIndices; // original indices from the FBX mesh
     QVector<int> quadTrianglesIndices; // original indices from the FBX mesh of the quad converted as triangles
     QVector<int> triangleIndices; // original indices from the FBX mesh
+    QVector<QVector<int>> lodTriangleIndices; // the triangles of each coarser level of detail of the mesh
 
     QString materialID;
 };
@@ -250,6 +253,9 @@ public:
 
     QVector<Blendshape> blendshapes;
 
+    // the largest distance of the surface of each coarser level of detail from the full detail one
+    QVector<float> lodErrors;
+
     unsigned int meshIndex; // the order the meshes appeared in the object file
 
     graphics::MeshPointer _mesh;
@@ -0,0 +1,216 @@
+//
+//  ImageKernels_avx2.cpp
+//  image/src/avx2
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <algorithm>
+
+#include <immintrin.h>
+
+#include "../image/ImageKernels.h"
+
+namespace image {
+
+// natural log for x > 0, the cephes polynomial
+static inline __m256 log_AVX2(__m256 x) {
+    const __m256 one = _mm256_set1_ps(1.0f);
+
+    // split into e and m in [sqrt(0.5), sqrt(2))
+    x = _mm256_max_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(0x00800000)));   // smallest normal
+    __m256i exponent = _mm256_sub_epi32(_mm256_srli_epi32(_mm256_castps_si256(x), 23), _mm256_set1_epi32(0x7e));
+    __m256 e = _mm256_cvtepi32_ps(exponent);
+    x = _mm256_or_ps(_mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(~0x7f800000))), _mm256_set1_ps(0.5f));
+
+    __m256 mask = _mm256_cmp_ps(x, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+    e = _mm256_sub_ps(e, _mm256_and_ps(one, mask));
+    x = _mm256_add_ps(_mm256_sub_ps(x, one), _mm256_and_ps(x, mask));
+
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(7.0376836292e-2f);
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.1514610310e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.1676998740e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.2420140846e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.4249322787e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.6668057665e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(2.0000714765e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-2.4999993993e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(3.3333331174e-1f));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, x), z);
+
+    // reconstruct, with ln(2) split in two for precision
+    y = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), y);
+    y = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), y);
+    x = _mm256_add_ps(x, y);
+    return _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), x);
+}
+
+// natural exp, the cephes polynomial
+static inline __m256 exp_AVX2(__m256 x) {
+    x = _mm256_min_ps(x, _mm256_set1_ps(88.3762626647949f));
+    x = _mm256_max_ps(x, _mm256_set1_ps(-88.3762626647949f));
+
+    // x = n * ln(2) + r
+    __m256 n = _mm256_floor_ps(_mm256_fmadd_ps(x, _mm256_set1_ps(1.44269504088896341f), _mm256_set1_ps(0.5f)));
+    x = _mm256_fnmadd_ps(n, _mm256_set1_ps(0.693359375f), x);
+    x = _mm256_fnmadd_ps(n, _mm256_set1_ps(-2.12194440e-4f), x);
+
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(1.9875691500e-4f);
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.3981999507e-3f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(8.3334519073e-3f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.1665795894e-2f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.6666665459e-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(5.0000001201e-1f));
+    y = _mm256_fmadd_ps(y, z, x);
+    y = _mm256_add_ps(y, _mm256_set1_ps(1.0f));
+
+    // scale by 2^n
+    __m256i scale = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvttps_epi32(n), _mm256_set1_epi32(0x7f)), 23);
+    return _mm256_mul_ps(y, _mm256_castsi256_ps(scale));
+}
+
+void powRGBA_AVX2(float* rgba, size_t numPixels, float gamma) {
+    const __m256 g = _mm256_set1_ps(gamma);
+    const __m256 zero = _mm256_setzero_ps();
+
+    size_t i = 0;
+    for (; i + 2 <= numPixels; i += 2) {
+        __m256 x = _mm256_loadu_ps(rgba);
+        __m256 y = exp_AVX2(_mm256_mul_ps(g, log_AVX2(x)));
+        y = _mm256_and_ps(y, _mm256_cmp_ps(x, zero, _CMP_GT_OQ));   // pow(0, gamma) = 0
+        _mm256_storeu_ps(rgba, _mm256_blend_ps(y, x, 0x88));        // keep alpha
+        rgba += 8;
+    }
+    powRGBA_ref(rgba, numPixels - i, gamma);
+}
+
+void interleaveRGBA_AVX2(const float* r, const float* g, const float* b, const float* a, float* rgba, size_t numPixels) {
+    size_t i = 0;
+    for (; i + 8 <= numPixels; i += 8) {
+        __m256 r8 = _mm256_loadu_ps(r + i);
+        __m256 g8 = _mm256_loadu_ps(g + i);
+        __m256 b8 = _mm256_loadu_ps(b + i);
+        __m256 a8 = _mm256_loadu_ps(a + i);
+
+        // 4x4 transposes within each lane, pixels 0,4 1,5 2,6 and 3,7
+        __m256 rgLo = _mm256_unpacklo_ps(r8, g8);
+        __m256 rgHi = _mm256_unpackhi_ps(r8, g8);
+        __m256 baLo = _mm256_unpacklo_ps(b8, a8);
+        __m256 baHi = _mm256_unpackhi_ps(b8, a8);
+        __m256 p04 = _mm256_shuffle_ps(rgLo, baLo, 0x44);
+        __m256 p15 = _mm256_shuffle_ps(rgLo, baLo, 0xee);
+        __m256 p26 = _mm256_shuffle_ps(rgHi, baHi, 0x44);
+        __m256 p37 = _mm256_shuffle_ps(rgHi, baHi, 0xee);
+
+        float* dst = rgba + 4 * i;
+        _mm256_storeu_ps(dst + 0, _mm256_permute2f128_ps(p04, p15, 0x20));
+        _mm256_storeu_ps(dst + 8, _mm256_permute2f128_ps(p26, p37, 0x20));
+        _mm256_storeu_ps(dst + 16, _mm256_permute2f128_ps(p04, p15, 0x31));
+        _mm256_storeu_ps(dst + 24, _mm256_permute2f128_ps(p26, p37, 0x31));
+    }
+    interleaveRGBA_ref(r + i, g + i, b + i, a + i, rgba + 4 * i, numPixels - i);
+}
+
+void downsampleBox_AVX2(const float* src, size_t srcLineStride, float* dst, size_t dstLineStride, int dstWidth, int dstHeight) {
+    const __m256 quarter = _mm256_set1_ps(0.25f);
+
+    for (int y = 0; y < dstHeight; y++) {
+        const float* src0 = src + 2 * y * srcLineStride * 4;
+        const float* src1 = src0 + srcLineStride * 4;
+        float* dstIt = dst + y * dstLineStride * 4;
+
+        int x = 0;
+        for (; x + 2 <= dstWidth; x += 2) {
+            __m256 a0 = _mm256_loadu_ps(src0);
+            __m256 b0 = _mm256_loadu_ps(src0 + 8);
+            __m256 a1 = _mm256_loadu_ps(src1);
+            __m256 b1 = _mm256_loadu_ps(src1 + 8);
+
+            // summed in the order of the reference
+            __m256 sum = _mm256_add_ps(_mm256_permute2f128_ps(a0, b0, 0x20), _mm256_permute2f128_ps(a0, b0, 0x31));
+            sum = _mm256_add_ps(sum, _mm256_permute2f128_ps(a1, b1, 0x20));
+            sum = _mm256_add_ps(sum, _mm256_permute2f128_ps(a1, b1, 0x31));
+            _mm256_storeu_ps(dstIt, _mm256_mul_ps(sum, quarter));
+
+            src0 += 16;
+            src1 += 16;
+            dstIt += 8;
+        }
+        if (x < dstWidth) {
+            __m128 sum = _mm_add_ps(_mm_loadu_ps(src0), _mm_loadu_ps(src0 + 4));
+            sum = _mm_add_ps(_mm_add_ps(sum, _mm_loadu_ps(src1)), _mm_loadu_ps(src1 + 4));
+            _mm_storeu_ps(dstIt, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+        }
+    }
+}
+
+void moveChannelToRed_AVX2(uint32_t* argb, size_t numPixels, int channelShift) {
+    const __m128i shift = _mm_cvtsi32_si128(channelShift);
+    const __m256i byteMask = _mm256_set1_epi32(0xff);
+    const __m256i alpha = _mm256_set1_epi32((int)0xff000000);
+
+    size_t i = 0;
+    for (; i + 8 <= numPixels; i += 8) {
+        __m256i pixels = _mm256_loadu_si256((const __m256i*)(argb + i));
+        __m256i channel = _mm256_and_si256(_mm256_srl_epi32(pixels, shift), byteMask);
+        _mm256_storeu_si256((__m256i*)(argb + i), _mm256_or_si256(_mm256_slli_epi32(channel, 16), alpha));
+    }
+    moveChannelToRed_ref(argb + i, numPixels - i, channelShift);
+}
+
+static inline size_t sum_epi32(__m256i x) {
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(x), _mm256_extracti128_si256(x, 1));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0x4e));
+    sum = _mm_add_epi32(sum, _mm_shuffle_epi32(sum, 0xb1));
+    return (size_t)(uint32_t)_mm_cvtsi128_si32(sum);
+}
+
+void countAlpha_AVX2(const uint32_t* argb, size_t numPixels, size_t maxTranslucents, size_t* numOpaques,
+                     size_t* numTranslucents) {
+    // the translucent limit is checked a block of pixels at a time
+    const size_t BLOCK_SIZE = 1024;
+    const size_t numSimdPixels = numPixels & ~(size_t)7;
+    const __m256i opaque = _mm256_set1_epi32(0xff);
+    const __m256i transparent = _mm256_setzero_si256();
+
+    size_t opaques = 0;
+    size_t translucents = 0;
+    size_t i = 0;
+    while (i < numSimdPixels && translucents <= maxTranslucents) {
+        size_t blockStart = i;
+        size_t blockEnd = std::min(i + BLOCK_SIZE, numSimdPixels);
+        __m256i opaqueCounts = _mm256_setzero_si256();
+        __m256i otherCounts = _mm256_setzero_si256();
+        for (; i < blockEnd; i += 8) {
+            __m256i alphas = _mm256_srli_epi32(_mm256_loadu_si256((const __m256i*)(argb + i)), 24);
+            __m256i isOpaque = _mm256_cmpeq_epi32(alphas, opaque);
+            __m256i isOther = _mm256_or_si256(isOpaque, _mm256_cmpeq_epi32(alphas, transparent));
+            // the masks are -1 where set
+            opaqueCounts = _mm256_sub_epi32(opaqueCounts, isOpaque);
+            otherCounts = _mm256_sub_epi32(otherCounts, isOther);
+        }
+        opaques += sum_epi32(opaqueCounts);
+        translucents += (blockEnd - blockStart) - sum_epi32(otherCounts);
+    }
+
+    if (translucents <= maxTranslucents) {
+        size_t tailOpaques, tailTranslucents;
+        countAlpha_ref(argb + i, numPixels - i, maxTranslucents - translucents, &tailOpaques, &tailTranslucents);
+        opaques += tailOpaques;
+        translucents += tailTranslucents;
+    }
+    *numOpaques = opaques;
+    *numTranslucents = translucents;
+}
+
+}
+
+#endif
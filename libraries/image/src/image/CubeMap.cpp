@@ -15,6 +15,7 @@
 
 #include "RandomAndNoise.h"
 #include "BRDF.h"
+#include "ImageKernels.h"
 #include "ImageLogging.h"
 
 #ifndef M_PI
@@ -303,17 +304,14 @@ static void copySurface(const nvtt::Surface& source, glm::vec4* dest, size_t dst
     const float* srcGreenIt = source.channel(1);
     const float* srcBlueIt = source.channel(2);
     const float* srcAlphaIt = source.channel(3);
+    const int width = source.width();
 
     for (int y = 0; y < source.height(); y++) {
-        glm::vec4* dstColIt = dest;
-        for (int x = 0; x < source.width(); x++) {
-            *dstColIt = glm::vec4(*srcRedIt, *srcGreenIt, *srcBlueIt, *srcAlphaIt);
-            dstColIt++;
-            srcRedIt++;
-            srcGreenIt++;
-            srcBlueIt++;
-            srcAlphaIt++;
-        }
+        interleaveRGBA(srcRedIt, srcGreenIt, srcBlueIt, srcAlphaIt, (float*)dest, width);
+        srcRedIt += width;
+        srcGreenIt += width;
+        srcBlueIt += width;
+        srcAlphaIt += width;
         dest += dstLineStride;
     }
 }
@@ -325,49 +323,58 @@ CubeMap::CubeMap(int width, int height, int mipCount) {
 CubeMap::CubeMap(const std::vector<Image>& faces, int mipCount, const std::atomic<bool>& abortProcessing) {
     reset(faces.front().getWidth(), faces.front().getHeight(), mipCount);
 
-    int face;
-
-    nvtt::Surface surface;
-    surface.setAlphaMode(nvtt::AlphaMode_None);
-    surface.setWrapMode(nvtt::WrapMode_Mirror);
-
-    // Compute mips
-    for (face = 0; face < 6; face++) {
+    // Compute mips, of each face in parallel
+    tbb::parallel_for(0, 6, [&](int face) {
         Image faceImage = faces[face].getConvertedToFormat(Image::Format_RGBAF);
+        copyFace(_width, _height, (const glm::vec4*)faceImage.getBits(), faceImage.getBytesPerLineCount() / sizeof(glm::vec4),
+                 editFace(0, face), getMipLineStride(0));
+
+        // halving an even size takes the same 2x2 averages as nvtt's box filter
+        gpu::uint16 mipLevel = 0;
+        while (mipLevel + 1 < getMipCount() && !abortProcessing.load()) {
+            auto mipDimensions = getMipDimensions(mipLevel);
+            if ((mipDimensions.x & 1) || (mipDimensions.y & 1)) {
+                break;
+            }
+            downsampleBox((const float*)getFace(mipLevel, face), getMipLineStride(mipLevel),
+                          (float*)editFace(mipLevel + 1, face), getMipLineStride(mipLevel + 1), mipDimensions.x / 2,
+                          mipDimensions.y / 2);
+            mipLevel++;
+        }
 
-        surface.setImage(nvtt::InputFormat_RGBA_32F, _width, _height, 1, faceImage.editBits());
+        if (mipLevel + 1 < getMipCount() && !abortProcessing.load()) {
+            // odd sizes are left to nvtt
+            faceImage = getFaceImage(mipLevel, face);
 
-        auto mipLevel = 0;
-        copySurface(surface, editFace(0, face), getMipLineStride(0));
+            nvtt::Surface surface;
+            surface.setAlphaMode(nvtt::AlphaMode_None);
+            surface.setWrapMode(nvtt::WrapMode_Mirror);
+            surface.setImage(nvtt::InputFormat_RGBA_32F, faceImage.getWidth(), faceImage.getHeight(), 1, faceImage.editBits());
 
-        while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
-            surface.buildNextMipmap(nvtt::MipmapFilter_Box);
-            mipLevel++;
+            while (surface.canMakeNextMipmap() && !abortProcessing.load()) {
+                surface.buildNextMipmap(nvtt::MipmapFilter_Box);
+                mipLevel++;
 
-            copySurface(surface, editFace(mipLevel, face), getMipLineStride(mipLevel));
+                copySurface(surface, editFace(mipLevel, face), getMipLineStride(mipLevel));
+            }
         }
-    }
+    });
 
     if (abortProcessing.load()) {
         return;
     }
 
-    for (gpu::uint16 mipLevel = 0; mipLevel < mipCount; ++mipLevel) {
-        Mip mip(mipLevel, this);
+    tbb::parallel_for(0, (int)mipCount, [&](int mipLevel) {
+        Mip mip((gpu::uint16)mipLevel, this);
         mip.applySeams();
-    }
+    });
 }
 
 void CubeMap::applyGamma(float value) {
-    for (auto& mip : _mips) {
-        for (auto& face : mip) {
-            for (auto& pixel : face) {
-                pixel.r = std::pow(pixel.r, value);
-                pixel.g = std::pow(pixel.g, value);
-                pixel.b = std::pow(pixel.b, value);
-            }
-        }
-    }
+    tbb::parallel_for(0, (int)_mips.size() * 6, [&](int index) {
+        auto& face = _mips[index / 6][index % 6];
+        powRGBA((float*)face.data(), face.size(), value);
+    });
 }
 
 void CubeMap::copyFace(int width, int height, const glm::vec4* source, size_t srcLineStride, glm::vec4* dest, size_t dstLineStride) {
@@ -594,11 +601,12 @@ void CubeMap::convolveForGGX(CubeMap& output, const std::atomic<bool>& abortProc
         params.points.resize(sampleCount);
         generateGGXSamples(params, mipRoughness, _width);
 
-        for (int face = 0; face < 6; face++) {
+        // the faces run together, the smallest mips have too few pixels to keep the workers busy one face at a time
+        tbb::parallel_for(0, 6, [&](int face) {
             convolveMipFaceForGGX(params, output, mipLevel, face, abortProcessing);
-            if (abortProcessing.load()) {
-                return;
-            }
+        });
+        if (abortProcessing.load()) {
+            return;
         }
     }
 }
@@ -0,0 +1,178 @@
+//
+//  ImageKernels.cpp
+//  image/src/image
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ImageKernels.h"
+
+#include <cmath>
+
+namespace image {
+
+//
+// Pixel kernels (reference)
+//
+void powRGBA_ref(float* rgba, size_t numPixels, float gamma) {
+    for (size_t i = 0; i < numPixels; i++) {
+        rgba[0] = std::pow(rgba[0], gamma);
+        rgba[1] = std::pow(rgba[1], gamma);
+        rgba[2] = std::pow(rgba[2], gamma);
+        rgba += 4;
+    }
+}
+
+void interleaveRGBA_ref(const float* r, const float* g, const float* b, const float* a, float* rgba, size_t numPixels) {
+    for (size_t i = 0; i < numPixels; i++) {
+        rgba[4 * i + 0] = r[i];
+        rgba[4 * i + 1] = g[i];
+        rgba[4 * i + 2] = b[i];
+        rgba[4 * i + 3] = a[i];
+    }
+}
+
+void downsampleBox_ref(const float* src, size_t srcLineStride, float* dst, size_t dstLineStride, int dstWidth, int dstHeight) {
+    for (int y = 0; y < dstHeight; y++) {
+        const float* src0 = src + 2 * y * srcLineStride * 4;
+        const float* src1 = src0 + srcLineStride * 4;
+        float* dstIt = dst + y * dstLineStride * 4;
+        for (int x = 0; x < dstWidth; x++) {
+            for (int c = 0; c < 4; c++) {
+                dstIt[c] = (((src0[c] + src0[4 + c]) + src1[c]) + src1[4 + c]) * 0.25f;
+            }
+            src0 += 8;
+            src1 += 8;
+            dstIt += 4;
+        }
+    }
+}
+
+void moveChannelToRed_ref(uint32_t* argb, size_t numPixels, int channelShift) {
+    for (size_t i = 0; i < numPixels; i++) {
+        argb[i] = 0xff000000 | (((argb[i] >> channelShift) & 0xff) << 16);
+    }
+}
+
+void countAlpha_ref(const uint32_t* argb, size_t numPixels, size_t maxTranslucents, size_t* numOpaques,
+                    size_t* numTranslucents) {
+    size_t opaques = 0;
+    size_t translucents = 0;
+    for (size_t i = 0; i < numPixels; i++) {
+        uint32_t alpha = argb[i] >> 24;
+        if (alpha == 0xff) {
+            opaques++;
+        } else if (alpha != 0) {
+            if (++translucents > maxTranslucents) {
+                break;
+            }
+        }
+    }
+    *numOpaques = opaques;
+    *numTranslucents = translucents;
+}
+
+const float* getLinearFromGamma8Table() {
+    static const struct Table {
+        float values[256];
+        Table() {
+            for (int i = 0; i < 256; i++) {
+                values[i] = std::pow((float)i / 255.0f, 2.2f);
+            }
+        }
+    } table;
+    return table.values;
+}
+
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include "CPUDetect.h"
+
+namespace image {
+
+void powRGBA(float* rgba, size_t numPixels, float gamma) {
+    static auto f = cpuSupportsAVX2() ? powRGBA_AVX2 : powRGBA_ref;
+    (*f)(rgba, numPixels, gamma);  // dispatch
+}
+
+void interleaveRGBA(const float* r, const float* g, const float* b, const float* a, float* rgba, size_t numPixels) {
+    static auto f = cpuSupportsAVX2() ? interleaveRGBA_AVX2 : interleaveRGBA_ref;
+    (*f)(r, g, b, a, rgba, numPixels);  // dispatch
+}
+
+void downsampleBox(const float* src, size_t srcLineStride, float* dst, size_t dstLineStride, int dstWidth, int dstHeight) {
+    static auto f = cpuSupportsAVX2() ? downsampleBox_AVX2 : downsampleBox_ref;
+    (*f)(src, srcLineStride, dst, dstLineStride, dstWidth, dstHeight);  // dispatch
+}
+
+void moveChannelToRed(uint32_t* argb, size_t numPixels, int channelShift) {
+    static auto f = cpuSupportsAVX2() ? moveChannelToRed_AVX2 : moveChannelToRed_ref;
+    (*f)(argb, numPixels, channelShift);  // dispatch
+}
+
+void countAlpha(const uint32_t* argb, size_t numPixels, size_t maxTranslucents, size_t* numOpaques, size_t* numTranslucents) {
+    static auto f = cpuSupportsAVX2() ? countAlpha_AVX2 : countAlpha_ref;
+    (*f)(argb, numPixels, maxTranslucents, numOpaques, numTranslucents);  // dispatch
+}
+
+}
+
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+namespace image {
+
+void powRGBA(float* rgba, size_t numPixels, float gamma) {
+    powRGBA_NEON(rgba, numPixels, gamma);
+}
+
+void interleaveRGBA(const float* r, const float* g, const float* b, const float* a, float* rgba, size_t numPixels) {
+    interleaveRGBA_NEON(r, g, b, a, rgba, numPixels);
+}
+
+void downsampleBox(const float* src, size_t srcLineStride, float* dst, size_t dstLineStride, int dstWidth, int dstHeight) {
+    downsampleBox_NEON(src, srcLineStride, dst, dstLineStride, dstWidth, dstHeight);
+}
+
+void moveChannelToRed(uint32_t* argb, size_t numPixels, int channelShift) {
+    moveChannelToRed_NEON(argb, numPixels, channelShift);
+}
+
+void countAlpha(const uint32_t* argb, size_t numPixels, size_t maxTranslucents, size_t* numOpaques, size_t* numTranslucents) {
+    countAlpha_NEON(argb, numPixels, maxTranslucents, numOpaques, numTranslucents);
+}
+
+}
+
+#else   // portable reference code
+
+namespace image {
+
+void powRGBA(float* rgba, size_t numPixels, float gamma) {
+    powRGBA_ref(rgba, numPixels, gamma);
+}
+
+void interleaveRGBA(const float* r, const float* g, const float* b, const float* a, float* rgba, size_t numPixels) {
+    interleaveRGBA_ref(r, g, b, a, rgba, numPixels);
+}
+
+void downsampleBox(const float* src, size_t srcLineStride, float* dst, size_t dstLineStride, int dstWidth, int dstHeight) {
+    downsampleBox_ref(src, srcLineStride, dst, dstLineStride, dstWidth, dstHeight);
+}
+
+void moveChannelToRed(uint32_t* argb, size_t numPixels, int channelShift) {
+    moveChannelToRed_ref(argb, numPixels, channelShift);
+}
+
+void countAlpha(const uint32_t* argb, size_t numPixels, size_t maxTranslucents, size_t* numOpaques, size_t* numTranslucents) {
+    countAlpha_ref(argb, numPixels, maxTranslucents, numOpaques, numTranslucents);
+}
+
+}
+
+#endif
@@ -0,0 +1,92 @@
+//
+//  ImageKernels.h
+//  image/src/image
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+//
+// Pixel kernels of the texture processing.
+// Each has a portable reference version, and SIMD versions selected at runtime using CPUDetect.h.
+// They are declared here so the variants can be tested and benchmarked against each other.
+//
+
+#ifndef hifi_image_ImageKernels_h
+#define hifi_image_ImageKernels_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace image {
+
+//
+// Gamma of float RGBA pixels, in place
+// rgb = pow(rgb, gamma), for rgb >= 0, alpha is left as is
+// The SIMD versions are within a relative error of 1e-5 of the reference.
+//
+void powRGBA_ref(float* rgba, size_t numPixels, float gamma);
+
+//
+// Planar to interleaved float RGBA
+// rgba[4 * n + c] = channel c[n]
+//
+void interleaveRGBA_ref(const float* r, const float* g, const float* b, const float* a, float* rgba, size_t numPixels);
+
+//
+// Box filtered mip of a float RGBA image of even width and height, the average of each 2x2 block of pixels
+// summed in the order nvtt sums them, so that all the versions match its box filter exactly
+// Line strides are in pixels.
+//
+void downsampleBox_ref(const float* src, size_t srcLineStride, float* dst, size_t dstLineStride, int dstWidth, int dstHeight);
+
+//
+// One channel of ARGB32 pixels moved to red, in place
+// argb = 0xff000000 | (((argb >> channelShift) & 0xff) << 16), for a shift of 0, 8, 16 or 24
+//
+void moveChannelToRed_ref(uint32_t* argb, size_t numPixels, int channelShift);
+
+//
+// Alpha histogram of ARGB32 pixels
+// numOpaques counts the alphas of 255, numTranslucents those that are neither 0 nor 255. Counting may stop
+// once numTranslucents is past maxTranslucents, so both counts are only exact when it isn't.
+//
+void countAlpha_ref(const uint32_t* argb, size_t numPixels, size_t maxTranslucents, size_t* numOpaques,
+                    size_t* numTranslucents);
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+void powRGBA_AVX2(float* rgba, size_t numPixels, float gamma);
+void interleaveRGBA_AVX2(const float* r, const float* g, const float* b, const float* a, float* rgba, size_t numPixels);
+void downsampleBox_AVX2(const float* src, size_t srcLineStride, float* dst, size_t dstLineStride, int dstWidth, int dstHeight);
+void moveChannelToRed_AVX2(uint32_t* argb, size_t numPixels, int channelShift);
+void countAlpha_AVX2(const uint32_t* argb, size_t numPixels, size_t maxTranslucents, size_t* numOpaques,
+                     size_t* numTranslucents);
+
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+void powRGBA_NEON(float* rgba, size_t numPixels, float gamma);
+void interleaveRGBA_NEON(const float* r, const float* g, const float* b, const float* a, float* rgba, size_t numPixels);
+void downsampleBox_NEON(const float* src, size_t srcLineStride, float* dst, size_t dstLineStride, int dstWidth, int dstHeight);
+void moveChannelToRed_NEON(uint32_t* argb, size_t numPixels, int channelShift);
+void countAlpha_NEON(const uint32_t* argb, size_t numPixels, size_t maxTranslucents, size_t* numOpaques,
+                     size_t* numTranslucents);
+
+#endif
+
+// the fastest version of each kernel for this CPU
+void powRGBA(float* rgba, size_t numPixels, float gamma);
+void interleaveRGBA(const float* r, const float* g, const float* b, const float* a, float* rgba, size_t numPixels);
+void downsampleBox(const float* src, size_t srcLineStride, float* dst, size_t dstLineStride, int dstWidth, int dstHeight);
+void moveChannelToRed(uint32_t* argb, size_t numPixels, int channelShift);
+void countAlpha(const uint32_t* argb, size_t numPixels, size_t maxTranslucents, size_t* numOpaques, size_t* numTranslucents);
+
+// pow(value / 255, 2.2) for each 8-bit value, the sRGB approximation the texture processing linearizes with
+const float* getLinearFromGamma8Table();
+
+}
+
+#endif // hifi_image_ImageKernels_h
@@ -11,6 +11,9 @@
 
 #include "TextureProcessing.h"
 
+#include <map>
+#include <mutex>
+
 #include <glm/gtc/packing.hpp>
 
 #include <QtCore/QtGlobal>
@@ -30,11 +33,17 @@
 #endif
 #include "ImageLogging.h"
 #include "CubeMap.h"
+#include "ImageKernels.h"
 
 using namespace gpu;
 
 #include <nvtt/nvtt.h>
 
+#if !defined(Q_MOC_RUN)
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+#endif
+
 #undef _CRT_SECURE_NO_WARNINGS
 #include <Etc2/Etc.h>
 #include <Etc2/EtcFilter.h>
@@ -45,6 +54,7 @@ static const glm::uvec2 MAX_TEXTURE_SIZE_GL(8192);
 bool DEV_DECIMATE_TEXTURES = false;
 std::atomic<size_t> DECIMATED_TEXTURE_COUNT{ 0 };
 std::atomic<size_t> RECTIFIED_TEXTURE_COUNT{ 0 };
+static std::atomic<int> COMPRESSION_CONCURRENCY{ 0 };
 
 // we use a ref here to work around static order initialization
 // possibly causing the element not to be constructed yet
@@ -306,35 +316,27 @@ void mapToRedChannel(Image& image, ColorChannel sourceChannel) {
         image = image.getConvertedToFormat(Image::Format_ARGB32);
     }
 
-    for (glm::uint32 i = 0; i < image.getHeight(); i++) {
-        QRgb* pixel = reinterpret_cast<QRgb*>(image.editScanLine(i));
-        // Past end pointer
-        QRgb* lineEnd = pixel + image.getWidth();
-
-        // Transfer channel data from source to target
-        for (; pixel < lineEnd; pixel++) {
-            int colorValue;
-            switch (sourceChannel) {
-            case ColorChannel::RED:
-                colorValue = qRed(*pixel);
-                break;
-            case ColorChannel::GREEN:
-                colorValue = qGreen(*pixel);
-                break;
-            case ColorChannel::BLUE:
-                colorValue = qBlue(*pixel);
-                break;
-            case ColorChannel::ALPHA:
-                colorValue = qAlpha(*pixel);
-                break;
-            default:
-                colorValue = qRed(*pixel);
-                break;
-            }
+    // where the channel is in a QRgb
+    int channelShift;
+    switch (sourceChannel) {
+    case ColorChannel::GREEN:
+        channelShift = 8;
+        break;
+    case ColorChannel::BLUE:
+        channelShift = 0;
+        break;
+    case ColorChannel::ALPHA:
+        channelShift = 24;
+        break;
+    case ColorChannel::RED:
+    default:
+        channelShift = 16;
+        break;
+    }
 
-            // Dump the color in the red channel, ignore the rest
-            *pixel = qRgba(colorValue, 0, 0, 255);
-        }
+    // Dump the color in the red channel, ignore the rest
+    for (glm::uint32 i = 0; i < image.getHeight(); i++) {
+        moveChannelToRed(reinterpret_cast<uint32_t*>(image.editScanLine(i)), image.getWidth(), channelShift);
     }
 }
 
@@ -500,22 +502,46 @@ struct MyErrorHandler : public nvtt::ErrorHandler {
     }
 };
 
+void setCompressionConcurrency(int maxConcurrency) {
+    COMPRESSION_CONCURRENCY = std::max(0, maxConcurrency);
+}
+
+int getCompressionConcurrency() {
+    return COMPRESSION_CONCURRENCY.load();
+}
+
 #if defined(NVTT_API)
-class SequentialTaskDispatcher : public nvtt::TaskDispatcher {
+// The compressions of all the textures share the tbb workers, through an arena that limits how many of them they
+// take at once.  The arenas are kept, as some compressions can still be running in one when the limit changes.
+static tbb::task_arena& getCompressionArena() {
+    static std::mutex arenasMutex;
+    static std::map<int, std::unique_ptr<tbb::task_arena>> arenas;
+
+    int maxConcurrency = COMPRESSION_CONCURRENCY.load();
+    std::lock_guard<std::mutex> lock(arenasMutex);
+    auto& arena = arenas[maxConcurrency];
+    if (!arena) {
+        arena = std::make_unique<tbb::task_arena>(maxConcurrency > 0 ? maxConcurrency : (int)tbb::task_arena::automatic);
+    }
+    return *arena;
+}
+
+class ParallelTaskDispatcher : public nvtt::TaskDispatcher {
 public:
-    SequentialTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
+    ParallelTaskDispatcher(const std::atomic<bool>& abortProcessing = false) : _abortProcessing(abortProcessing) {
     }
 
     const std::atomic<bool>& _abortProcessing;
 
+    // nvtt expects the tasks to be done when this returns, the calling thread joins the arena to work on them
     void dispatch(nvtt::Task* task, void* context, int count) override {
-        for (int i = 0; i < count; i++) {
-            if (!_abortProcessing.load()) {
-                task(context, i);
-            } else {
-                break;
-            }
-        }
+        getCompressionArena().execute([&] {
+            tbb::parallel_for(0, count, [&](int i) {
+                if (!_abortProcessing.load()) {
+                    task(context, i);
+                }
+            });
+        });
     }
 };
 #endif
@@ -622,8 +648,7 @@ void convertImageToHDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
     surface.setAlphaMode(nvtt::AlphaMode_None);
     surface.setWrapMode(nvtt::WrapMode_Mirror);
 
-    SequentialTaskDispatcher dispatcher(abortProcessing);
-    nvtt::Compressor compressor;
+    ParallelTaskDispatcher dispatcher(abortProcessing);
     context.setTaskDispatcher(&dispatcher);
 
     context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
@@ -759,8 +784,9 @@ void convertImageToLDRTexture(gpu::Texture* texture, Image&& image, BackendTarge
         MyErrorHandler errorHandler;
         outputOptions.setErrorHandler(&errorHandler);
 
-        SequentialTaskDispatcher dispatcher(abortProcessing);
+        ParallelTaskDispatcher dispatcher(abortProcessing);
         nvtt::Compressor context;
+        context.setTaskDispatcher(&dispatcher);
 
         context.compress(surface, face, mipLevel++, compressionOptions, outputOptions);
         if (buildMips) {
@@ -863,28 +889,15 @@ void convertToTexture(gpu::Texture* texture, Image&& image, BackendTarget target
 
 void processTextureAlpha(const Image& srcImage, bool& validAlpha, bool& alphaAsMask) {
     PROFILE_RANGE(resource_parse, "processTextureAlpha");
-    validAlpha = false;
-    alphaAsMask = true;
-    const uint8 OPAQUE_ALPHA = 255;
-    const uint8 TRANSPARENT_ALPHA = 0;
 
     // Figure out if we can use a mask for alpha or not
-    int numOpaques = 0;
-    int numTranslucents = 0;
-    const int NUM_PIXELS = srcImage.getWidth() * srcImage.getHeight();
-    const int MAX_TRANSLUCENT_PIXELS_FOR_ALPHAMASK = (int)(0.05f * (float)(NUM_PIXELS));
-    const QRgb* data = reinterpret_cast<const QRgb*>(srcImage.getBits());
-    for (int i = 0; i < NUM_PIXELS; ++i) {
-        auto alpha = qAlpha(data[i]);
-        if (alpha == OPAQUE_ALPHA) {
-            numOpaques++;
-        } else if (alpha != TRANSPARENT_ALPHA) {
-            if (++numTranslucents > MAX_TRANSLUCENT_PIXELS_FOR_ALPHAMASK) {
-                alphaAsMask = false;
-                break;
-            }
-        }
-    }
+    size_t numOpaques = 0;
+    size_t numTranslucents = 0;
+    const size_t NUM_PIXELS = srcImage.getWidth() * srcImage.getHeight();
+    const size_t MAX_TRANSLUCENT_PIXELS_FOR_ALPHAMASK = (size_t)(0.05f * (float)(NUM_PIXELS));
+    const uint32_t* data = reinterpret_cast<const uint32_t*>(srcImage.getBits());
+    countAlpha(data, NUM_PIXELS, MAX_TRANSLUCENT_PIXELS_FOR_ALPHAMASK, &numOpaques, &numTranslucents);
+    alphaAsMask = numTranslucents <= MAX_TRANSLUCENT_PIXELS_FOR_ALPHAMASK;
     validAlpha = (numOpaques != NUM_PIXELS);
 }
 
@@ -1382,25 +1395,25 @@ Image convertToLDRFormat(Image&& srcImage, Image::Format format) {
 
     Image ldrImage(localCopy.getWidth(), localCopy.getHeight(), format);
     auto unpackFunc = getHDRUnpackingFunction();
+    std::vector<glm::vec4> line(localCopy.getWidth());
 
     for (glm::uint32 y = 0; y < localCopy.getHeight(); y++) {
         const QRgb* srcLineIt = reinterpret_cast<const QRgb*>(localCopy.getScanLine(y));
-        const QRgb* srcLineEnd = srcLineIt + localCopy.getWidth();
         uint32* ldrLineIt = reinterpret_cast<uint32*>(ldrImage.editScanLine(y));
-        glm::vec3 color;
 
-        while (srcLineIt < srcLineEnd) {
-            color = unpackFunc(*srcLineIt);
-            // Apply reverse gamma and clamp
-            color.r = std::pow(color.r, 1.0f / 2.2f);
-            color.g = std::pow(color.g, 1.0f / 2.2f);
-            color.b = std::pow(color.b, 1.0f / 2.2f);
+        for (auto& color : line) {
+            color = glm::vec4(unpackFunc(*srcLineIt), 1.0f);
+            ++srcLineIt;
+        }
+        // Apply reverse gamma, a line at a time
+        powRGBA((float*)line.data(), line.size(), 1.0f / 2.2f);
+
+        for (auto& color : line) {
+            // and clamp
             color.r = std::min(1.0f, color.r) * 255.0f;
             color.g = std::min(1.0f, color.g) * 255.0f;
             color.b = std::min(1.0f, color.b) * 255.0f;
             *ldrLineIt = qRgb((int)color.r, (int)color.g, (int)color.b);
-
-            ++srcLineIt;
             ++ldrLineIt;
         }
     }
@@ -1438,6 +1451,7 @@ Image convertToHDRFormat(Image&& srcImage, gpu::Element format) {
     }
 
     localCopy = localCopy.getConvertedToFormat(Image::Format_ARGB32);
+    const float* linearFromGamma = getLinearFromGamma8Table();
     for (glm::uint32 y = 0; y < localCopy.getHeight(); y++) {
         const QRgb* srcLineIt = reinterpret_cast<const QRgb*>( localCopy.getScanLine(y) );
         const QRgb* srcLineEnd = srcLineIt + localCopy.getWidth();
@@ -1445,14 +1459,10 @@ Image convertToHDRFormat(Image&& srcImage, gpu::Element format) {
         glm::vec3 color;
 
         while (srcLineIt < srcLineEnd) {
-            color.r = qRed(*srcLineIt);
-            color.g = qGreen(*srcLineIt);
-            color.b = qBlue(*srcLineIt);
             // Normalize and apply gamma
-            color /= 255.0f;
-            color.r = std::pow(color.r, 2.2f);
-            color.g = std::pow(color.g, 2.2f);
-            color.b = std::pow(color.b, 2.2f);
+            color.r = linearFromGamma[qRed(*srcLineIt)];
+            color.g = linearFromGamma[qGreen(*srcLineIt)];
+            color.b = linearFromGamma[qBlue(*srcLineIt)];
             *hdrLineIt = packFunc(color);
 #ifdef DEBUG_COLOR_PACKING
             glm::vec3 ucolor = unpackFunc(*hdrLineIt);
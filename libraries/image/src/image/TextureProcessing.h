@@ -123,6 +123,11 @@ gpu::TexturePointer processCubeTextureColorFromImage(Image&& srcImage, const std
 
 const QStringList getSupportedFormats();
 
+// The number of threads that the texture compressions can take at once, out of the ones they share with everything
+// else, or 0 for all of them.  Processes that need to keep their frame rate while loading textures should keep it low.
+void setCompressionConcurrency(int maxConcurrency);
+int getCompressionConcurrency();
+
 std::pair<gpu::TexturePointer, glm::ivec2> processImage(std::shared_ptr<QIODevice> content, const std::string& url, ColorChannel sourceChannel,
                                                         int maxNumPixels, TextureUsage::Type textureType,
                                                         bool compress, gpu::BackendTarget target, const std::atomic<bool>& abortProcessing = false);
@@ -0,0 +1,183 @@
+//
+//  ImageKernels_neon.cpp
+//  image/src/neon
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+
+#include <algorithm>
+
+#include <arm_neon.h>
+
+#include "../image/ImageKernels.h"
+
+namespace image {
+
+// natural log for x > 0, the cephes polynomial
+static inline float32x4_t log_NEON(float32x4_t x) {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+
+    // split into e and m in [sqrt(0.5), sqrt(2))
+    x = vmaxq_f32(x, vreinterpretq_f32_u32(vdupq_n_u32(0x00800000)));  // smallest normal
+    int32x4_t exponent = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(vreinterpretq_u32_f32(x), 23)), vdupq_n_s32(0x7e));
+    float32x4_t e = vcvtq_f32_s32(exponent);
+    x = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(vreinterpretq_u32_f32(x), vdupq_n_u32(~0x7f800000u)),
+                                        vreinterpretq_u32_f32(vdupq_n_f32(0.5f))));
+
+    uint32x4_t mask = vcltq_f32(x, vdupq_n_f32(0.707106781186547524f));
+    e = vsubq_f32(e, vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(one), mask)));
+    x = vaddq_f32(vsubq_f32(x, one), vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(x), mask)));
+
+    float32x4_t z = vmulq_f32(x, x);
+    float32x4_t y = vdupq_n_f32(7.0376836292e-2f);
+    y = vmlaq_f32(vdupq_n_f32(-1.1514610310e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(1.1676998740e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(-1.2420140846e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(1.4249322787e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(-1.6668057665e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(2.0000714765e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(-2.4999993993e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(3.3333331174e-1f), y, x);
+    y = vmulq_f32(vmulq_f32(y, x), z);
+
+    // reconstruct, with ln(2) split in two for precision
+    y = vmlaq_f32(y, e, vdupq_n_f32(-2.12194440e-4f));
+    y = vmlsq_f32(y, z, vdupq_n_f32(0.5f));
+    x = vaddq_f32(x, y);
+    return vmlaq_f32(x, e, vdupq_n_f32(0.693359375f));
+}
+
+// natural exp, the cephes polynomial
+static inline float32x4_t exp_NEON(float32x4_t x) {
+    x = vminq_f32(x, vdupq_n_f32(88.3762626647949f));
+    x = vmaxq_f32(x, vdupq_n_f32(-88.3762626647949f));
+
+    // x = n * ln(2) + r, n rounded down from the truncation
+    float32x4_t fx = vmlaq_f32(vdupq_n_f32(0.5f), x, vdupq_n_f32(1.44269504088896341f));
+    float32x4_t n = vcvtq_f32_s32(vcvtq_s32_f32(fx));
+    n = vsubq_f32(n, vreinterpretq_f32_u32(vandq_u32(vcgtq_f32(n, fx), vreinterpretq_u32_f32(vdupq_n_f32(1.0f)))));
+    x = vmlsq_f32(x, n, vdupq_n_f32(0.693359375f));
+    x = vmlsq_f32(x, n, vdupq_n_f32(-2.12194440e-4f));
+
+    float32x4_t z = vmulq_f32(x, x);
+    float32x4_t y = vdupq_n_f32(1.9875691500e-4f);
+    y = vmlaq_f32(vdupq_n_f32(1.3981999507e-3f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(8.3334519073e-3f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(4.1665795894e-2f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(1.6666665459e-1f), y, x);
+    y = vmlaq_f32(vdupq_n_f32(5.0000001201e-1f), y, x);
+    y = vmlaq_f32(x, y, z);
+    y = vaddq_f32(y, vdupq_n_f32(1.0f));
+
+    // scale by 2^n
+    int32x4_t scale = vshlq_n_s32(vaddq_s32(vcvtq_s32_f32(n), vdupq_n_s32(0x7f)), 23);
+    return vmulq_f32(y, vreinterpretq_f32_s32(scale));
+}
+
+void powRGBA_NEON(float* rgba, size_t numPixels, float gamma) {
+    const float32x4_t g = vdupq_n_f32(gamma);
+    const uint32x4_t rgbMask = { 0xffffffff, 0xffffffff, 0xffffffff, 0 };
+
+    for (size_t i = 0; i < numPixels; i++) {
+        float32x4_t x = vld1q_f32(rgba);
+        float32x4_t y = exp_NEON(vmulq_f32(g, log_NEON(x)));
+        y = vreinterpretq_f32_u32(vandq_u32(vreinterpretq_u32_f32(y), vcgtq_f32(x, vdupq_n_f32(0.0f))));   // pow(0, gamma) = 0
+        vst1q_f32(rgba, vbslq_f32(rgbMask, y, x));  // keep alpha
+        rgba += 4;
+    }
+}
+
+void interleaveRGBA_NEON(const float* r, const float* g, const float* b, const float* a, float* rgba, size_t numPixels) {
+    size_t i = 0;
+    for (; i + 4 <= numPixels; i += 4) {
+        float32x4x4_t pixels;
+        pixels.val[0] = vld1q_f32(r + i);
+        pixels.val[1] = vld1q_f32(g + i);
+        pixels.val[2] = vld1q_f32(b + i);
+        pixels.val[3] = vld1q_f32(a + i);
+        vst4q_f32(rgba + 4 * i, pixels);
+    }
+    interleaveRGBA_ref(r + i, g + i, b + i, a + i, rgba + 4 * i, numPixels - i);
+}
+
+void downsampleBox_NEON(const float* src, size_t srcLineStride, float* dst, size_t dstLineStride, int dstWidth, int dstHeight) {
+    for (int y = 0; y < dstHeight; y++) {
+        const float* src0 = src + 2 * y * srcLineStride * 4;
+        const float* src1 = src0 + srcLineStride * 4;
+        float* dstIt = dst + y * dstLineStride * 4;
+        for (int x = 0; x < dstWidth; x++) {
+            // summed in the order of the reference
+            float32x4_t sum = vaddq_f32(vld1q_f32(src0), vld1q_f32(src0 + 4));
+            sum = vaddq_f32(vaddq_f32(sum, vld1q_f32(src1)), vld1q_f32(src1 + 4));
+            vst1q_f32(dstIt, vmulq_n_f32(sum, 0.25f));
+            src0 += 8;
+            src1 += 8;
+            dstIt += 4;
+        }
+    }
+}
+
+void moveChannelToRed_NEON(uint32_t* argb, size_t numPixels, int channelShift) {
+    const int32x4_t shift = vdupq_n_s32(-channelShift);    // negative shifts right
+    const uint32x4_t byteMask = vdupq_n_u32(0xff);
+    const uint32x4_t alpha = vdupq_n_u32(0xff000000);
+
+    size_t i = 0;
+    for (; i + 4 <= numPixels; i += 4) {
+        uint32x4_t channel = vandq_u32(vshlq_u32(vld1q_u32(argb + i), shift), byteMask);
+        vst1q_u32(argb + i, vorrq_u32(vshlq_n_u32(channel, 16), alpha));
+    }
+    moveChannelToRed_ref(argb + i, numPixels - i, channelShift);
+}
+
+static inline size_t sum_u32(uint32x4_t x) {
+    return (size_t)vgetq_lane_u32(x, 0) + vgetq_lane_u32(x, 1) + vgetq_lane_u32(x, 2) + vgetq_lane_u32(x, 3);
+}
+
+void countAlpha_NEON(const uint32_t* argb, size_t numPixels, size_t maxTranslucents, size_t* numOpaques,
+                     size_t* numTranslucents) {
+    // the translucent limit is checked a block of pixels at a time
+    const size_t BLOCK_SIZE = 1024;
+    const size_t numSimdPixels = numPixels & ~(size_t)3;
+    const uint32x4_t opaque = vdupq_n_u32(0xff);
+    const uint32x4_t transparent = vdupq_n_u32(0);
+
+    size_t opaques = 0;
+    size_t translucents = 0;
+    size_t i = 0;
+    while (i < numSimdPixels && translucents <= maxTranslucents) {
+        size_t blockStart = i;
+        size_t blockEnd = std::min(i + BLOCK_SIZE, numSimdPixels);
+        uint32x4_t opaqueCounts = vdupq_n_u32(0);
+        uint32x4_t otherCounts = vdupq_n_u32(0);
+        for (; i < blockEnd; i += 4) {
+            uint32x4_t alphas = vshrq_n_u32(vld1q_u32(argb + i), 24);
+            uint32x4_t isOpaque = vceqq_u32(alphas, opaque);
+            uint32x4_t isOther = vorrq_u32(isOpaque, vceqq_u32(alphas, transparent));
+            // the masks are all ones where set
+            opaqueCounts = vsubq_u32(opaqueCounts, isOpaque);
+            otherCounts = vsubq_u32(otherCounts, isOther);
+        }
+        opaques += sum_u32(opaqueCounts);
+        translucents += (blockEnd - blockStart) - sum_u32(otherCounts);
+    }
+
+    if (translucents <= maxTranslucents) {
+        size_t tailOpaques, tailTranslucents;
+        countAlpha_ref(argb + i, numPixels - i, maxTranslucents - translucents, &tailOpaques, &tailTranslucents);
+        opaques += tailOpaques;
+        translucents += tailTranslucents;
+    }
+    *numOpaques = opaques;
+    *numTranslucents = translucents;
+}
+
+}
+
+#endif
@@ -11,13 +11,88 @@
 
 #include "TextureMeta.h"
 
+#include <algorithm>
+
 #include <QDebug>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 
+#include "ktx/KTX.h"
+
 const QString TEXTURE_META_EXTENSION = ".texmeta.json";
 const uint16_t KTX_VERSION = 1;
 
+static const QString UNCOMPRESSED_MIP_TIERS_KEY = "uncompressed";
+
+uint16_t MipTiers::getTierFirstMip(uint16_t mip) const {
+    uint16_t tierFirstMip = mip;
+    for (auto firstMip : firstMips) {
+        if (firstMip > mip) {
+            break;
+        }
+        tierFirstMip = firstMip;
+    }
+    return tierFirstMip;
+}
+
+MipTiers MipTiers::fromKTX(const ktx::KTX& ktx, uint32_t lowTierMaxDimension, uint32_t mediumTierMaxDimension) {
+    MipTiers tiers;
+    const auto& header = ktx._header;
+    uint16_t numMips = (uint16_t)ktx._images.size();
+    if (numMips == 0) {
+        return tiers;
+    }
+
+    auto mipDimension = [&](uint16_t mip) {
+        return std::max({ header.getPixelWidth() >> mip, header.getPixelHeight() >> mip, 1U });
+    };
+    uint16_t lowFirstMip = 0;
+    while (lowFirstMip < numMips - 1 && mipDimension(lowFirstMip) > lowTierMaxDimension) {
+        ++lowFirstMip;
+    }
+    uint16_t mediumFirstMip = 0;
+    while (mediumFirstMip < lowFirstMip && mipDimension(mediumFirstMip) > mediumTierMaxDimension) {
+        ++mediumFirstMip;
+    }
+
+    if (mediumFirstMip > 0) {
+        tiers.firstMips.push_back(0);
+    }
+    if (mediumFirstMip < lowFirstMip) {
+        tiers.firstMips.push_back(mediumFirstMip);
+    }
+    tiers.firstMips.push_back(lowFirstMip);
+
+    // from the size of the low tier's first mip to the end of the file
+    size_t lowTierOffset = ktx::KTX_HEADER_SIZE + header.bytesOfKeyValueData + ktx._images[lowFirstMip]._imageOffset;
+    tiers.lowTierSize = (uint32_t)(ktx.getStorage()->size() - lowTierOffset);
+    return tiers;
+}
+
+static MipTiers mipTiersFromJson(const QJsonObject& json) {
+    MipTiers tiers;
+    for (const auto& firstMip : json["firstMips"].toArray()) {
+        tiers.firstMips.push_back((uint16_t)firstMip.toInt());
+    }
+    tiers.lowTierSize = (uint32_t)json["lowTierSize"].toDouble();
+    if (!std::is_sorted(tiers.firstMips.cbegin(), tiers.firstMips.cend()) || tiers.lowTierSize == 0) {
+        return MipTiers();
+    }
+    return tiers;
+}
+
+static QJsonObject mipTiersToJson(const MipTiers& tiers) {
+    QJsonObject json;
+    QJsonArray firstMips;
+    for (auto firstMip : tiers.firstMips) {
+        firstMips.push_back(firstMip);
+    }
+    json["firstMips"] = firstMips;
+    json["lowTierSize"] = (double)tiers.lowTierSize;
+    return json;
+}
+
 bool TextureMeta::deserialize(const QByteArray& data, TextureMeta* meta) {
     QJsonParseError error;
     auto doc = QJsonDocument::fromJson(data, &error);
@@ -47,6 +122,20 @@ bool TextureMeta::deserialize(const QByteArray& data, TextureMeta* meta) {
             }
         }
     }
+    if (root.contains("mipTiers")) {
+        auto mipTiers = root["mipTiers"].toObject();
+        for (auto it = mipTiers.constBegin(); it != mipTiers.constEnd(); it++) {
+            if (it.key() == UNCOMPRESSED_MIP_TIERS_KEY) {
+                meta->uncompressedMipTiers = mipTiersFromJson(it.value().toObject());
+                continue;
+            }
+            khronos::gl::texture::InternalFormat format;
+            auto formatName = it.key().toLatin1();
+            if (khronos::gl::texture::fromString(formatName.constData(), &format)) {
+                meta->mipTiers[format] = mipTiersFromJson(it.value().toObject());
+            }
+        }
+    }
     if (root.contains("version")) {
         meta->version = root["version"].toInt();
     }
@@ -66,6 +155,19 @@ QByteArray TextureMeta::serialize() {
     root["original"] = original.toString();
     root["uncompressed"] = uncompressed.toString();
     root["compressed"] = compressed;
+
+    QJsonObject mipTiersObject;
+    for (const auto& kv : mipTiers) {
+        if (!kv.second.isEmpty()) {
+            mipTiersObject[khronos::gl::texture::toString(kv.first)] = mipTiersToJson(kv.second);
+        }
+    }
+    if (!uncompressedMipTiers.isEmpty()) {
+        mipTiersObject[UNCOMPRESSED_MIP_TIERS_KEY] = mipTiersToJson(uncompressedMipTiers);
+    }
+    if (!mipTiersObject.isEmpty()) {
+        root["mipTiers"] = mipTiersObject;
+    }
     root["version"] = KTX_VERSION;
     doc.setObject(root);
 
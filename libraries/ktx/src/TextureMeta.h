@@ -14,6 +14,7 @@
 
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 #include <QUrl>
 
 #include "khronos/KHR.h"
@@ -31,6 +32,25 @@ namespace std {
     };
 }
 
+namespace ktx {
+    class KTX;
+}
+
+// The mips of a baked KTX in the tiers a client streams them in, each tier one byte range of the file. firstMips holds
+// the first mip of each tier from the high tier to the low one, and a tier runs to the first mip of the next. The low
+// tier is the end of the file, and lowTierSize bytes long, so it can be requested along with the header.
+struct MipTiers {
+    std::vector<uint16_t> firstMips;
+    uint32_t lowTierSize { 0 };
+
+    bool isEmpty() const { return firstMips.empty(); }
+    // the first mip of the tier the mip is in
+    uint16_t getTierFirstMip(uint16_t mip) const;
+
+    // low takes the mips no larger than lowTierMaxDimension, medium the others up to mediumTierMaxDimension and high the rest
+    static MipTiers fromKTX(const ktx::KTX& ktx, uint32_t lowTierMaxDimension, uint32_t mediumTierMaxDimension);
+};
+
 struct TextureMeta {
     static bool deserialize(const QByteArray& data, TextureMeta* meta);
     QByteArray serialize();
@@ -38,6 +58,8 @@ struct TextureMeta {
     QUrl original;
     QUrl uncompressed;
     std::unordered_map<khronos::gl::texture::InternalFormat, QUrl> availableTextureTypes;
+    std::unordered_map<khronos::gl::texture::InternalFormat, MipTiers> mipTiers;
+    MipTiers uncompressedMipTiers;
     uint16_t version { 0 };
 };
 
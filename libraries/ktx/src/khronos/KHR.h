@@ -210,6 +210,9 @@ namespace khronos {
                 COMPRESSED_SIGNED_R11_EAC = 0x9271,
                 COMPRESSED_RG11_EAC = 0x9272,
                 COMPRESSED_SIGNED_RG11_EAC = 0x9273,
+
+                COMPRESSED_RGBA_ASTC_4x4 = 0x93B0,
+                COMPRESSED_SRGB8_ALPHA8_ASTC_4x4 = 0x93D0,
             };
 
             static std::unordered_map<std::string, InternalFormat> nameToFormat {
@@ -248,7 +251,10 @@ namespace khronos {
                 { "COMPRESSED_R11_EAC", InternalFormat::COMPRESSED_R11_EAC },
                 { "COMPRESSED_SIGNED_R11_EAC", InternalFormat::COMPRESSED_SIGNED_R11_EAC },
                 { "COMPRESSED_RG11_EAC", InternalFormat::COMPRESSED_RG11_EAC },
-                { "COMPRESSED_SIGNED_RG11_EAC", InternalFormat::COMPRESSED_SIGNED_RG11_EAC }
+                { "COMPRESSED_SIGNED_RG11_EAC", InternalFormat::COMPRESSED_SIGNED_RG11_EAC },
+
+                { "COMPRESSED_RGBA_ASTC_4x4", InternalFormat::COMPRESSED_RGBA_ASTC_4x4 },
+                { "COMPRESSED_SRGB8_ALPHA8_ASTC_4x4", InternalFormat::COMPRESSED_SRGB8_ALPHA8_ASTC_4x4 }
             };
 
             inline const char* toString(InternalFormat format) {
@@ -429,6 +435,9 @@ namespace khronos {
                     case InternalFormat::COMPRESSED_SIGNED_R11_EAC:
                     case InternalFormat::COMPRESSED_RG11_EAC:
                     case InternalFormat::COMPRESSED_SIGNED_RG11_EAC:
+                    // ASTC
+                    case InternalFormat::COMPRESSED_RGBA_ASTC_4x4:
+                    case InternalFormat::COMPRESSED_SRGB8_ALPHA8_ASTC_4x4:
                         return evalAlignedCompressedBlockCount<4>(value);
 
                     default:
@@ -457,6 +466,8 @@ namespace khronos {
                     case InternalFormat::COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
                     case InternalFormat::COMPRESSED_RG11_EAC:
                     case InternalFormat::COMPRESSED_SIGNED_RG11_EAC:
+                    case InternalFormat::COMPRESSED_RGBA_ASTC_4x4:
+                    case InternalFormat::COMPRESSED_SRGB8_ALPHA8_ASTC_4x4:
                         return 16;
 
                     default:
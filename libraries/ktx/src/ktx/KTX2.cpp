@@ -0,0 +1,130 @@
+//
+//  KTX2.cpp
+//  ktx/src/ktx
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "KTX2.h"
+
+#include <QtCore/QDebug>
+
+using namespace ktx;
+
+const std::array<Byte, KTX2::IDENTIFIER_SIZE> KTX2::IDENTIFIER {{
+    0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A
+}};
+
+// the data format descriptor starts with its total size, then the basic block's vendor, type, version and size words
+static const size_t DFD_COLOR_MODEL_OFFSET { 3 * sizeof(uint32_t) };
+static const size_t DFD_TRANSFER_FUNCTION_OFFSET { DFD_COLOR_MODEL_OFFSET + 2 };
+static const uint32_t MAX_LEVELS { 32 };
+
+template <typename T>
+static T readValue(const Byte* bytes, size_t& offset) {
+    T value;
+    memcpy(&value, bytes + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+
+static bool isRangeInside(uint64_t offset, uint64_t length, size_t size) {
+    return offset <= size && length <= size - offset;
+}
+
+bool KTX2::checkIdentifier(size_t srcSize, const Byte* srcBytes) {
+    return srcSize >= IDENTIFIER_SIZE && memcmp(srcBytes, IDENTIFIER.data(), IDENTIFIER_SIZE) == 0;
+}
+
+std::unique_ptr<KTX2> KTX2::create(const StoragePointer& src) {
+    if (!src) {
+        return nullptr;
+    }
+    size_t srcSize = src->size();
+    const Byte* srcBytes = src->data();
+    if (srcSize < HEADER_SIZE || !checkIdentifier(srcSize, srcBytes)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<KTX2> result { new KTX2() };
+    auto& header = result->_header;
+    size_t offset = IDENTIFIER_SIZE;
+    header.vkFormat = readValue<uint32_t>(srcBytes, offset);
+    header.typeSize = readValue<uint32_t>(srcBytes, offset);
+    header.pixelWidth = readValue<uint32_t>(srcBytes, offset);
+    header.pixelHeight = readValue<uint32_t>(srcBytes, offset);
+    header.pixelDepth = readValue<uint32_t>(srcBytes, offset);
+    header.layerCount = readValue<uint32_t>(srcBytes, offset);
+    header.faceCount = readValue<uint32_t>(srcBytes, offset);
+    header.levelCount = readValue<uint32_t>(srcBytes, offset);
+    header.supercompressionScheme = readValue<uint32_t>(srcBytes, offset);
+    header.dfdByteOffset = readValue<uint32_t>(srcBytes, offset);
+    header.dfdByteLength = readValue<uint32_t>(srcBytes, offset);
+    header.kvdByteOffset = readValue<uint32_t>(srcBytes, offset);
+    header.kvdByteLength = readValue<uint32_t>(srcBytes, offset);
+    header.sgdByteOffset = readValue<uint64_t>(srcBytes, offset);
+    header.sgdByteLength = readValue<uint64_t>(srcBytes, offset);
+
+    if (header.pixelWidth == 0 || (header.faceCount != 1 && header.faceCount != NUM_CUBEMAPFACES) ||
+        header.levelCount > MAX_LEVELS || header.supercompressionScheme > (uint32_t)SupercompressionScheme::ZLIB) {
+        qWarning() << "Invalid KTX2 header" << header.pixelWidth << header.faceCount << header.levelCount
+                   << header.supercompressionScheme;
+        return nullptr;
+    }
+
+    uint32_t numLevels = header.getNumStoredLevels();
+    if (!isRangeInside(HEADER_SIZE, (uint64_t)numLevels * LEVEL_INDEX_ENTRY_SIZE, srcSize) ||
+        !isRangeInside(header.dfdByteOffset, header.dfdByteLength, srcSize) ||
+        !isRangeInside(header.kvdByteOffset, header.kvdByteLength, srcSize) ||
+        !isRangeInside(header.sgdByteOffset, header.sgdByteLength, srcSize)) {
+        qWarning() << "Invalid KTX2 index";
+        return nullptr;
+    }
+
+    for (uint32_t i = 0; i < numLevels; ++i) {
+        Level level;
+        level.byteOffset = readValue<uint64_t>(srcBytes, offset);
+        level.byteLength = readValue<uint64_t>(srcBytes, offset);
+        level.uncompressedByteLength = readValue<uint64_t>(srcBytes, offset);
+        if (!isRangeInside(level.byteOffset, level.byteLength, srcSize)) {
+            qWarning() << "Invalid KTX2 level" << i;
+            return nullptr;
+        }
+        result->_levels.push_back(level);
+    }
+
+    if (header.dfdByteLength > DFD_TRANSFER_FUNCTION_OFFSET) {
+        result->_colorModel = srcBytes[header.dfdByteOffset + DFD_COLOR_MODEL_OFFSET];
+        result->_transferFunction = srcBytes[header.dfdByteOffset + DFD_TRANSFER_FUNCTION_OFFSET];
+    }
+
+    // the key values are laid out as in KTX 1
+    if (header.kvdByteLength > 0) {
+        result->_keyValues = KTX::parseKeyValues(header.kvdByteLength, srcBytes + header.kvdByteOffset);
+    }
+
+    result->_storage = src;
+    return result;
+}
+
+bool KTX2::isBasisUniversal() const {
+    return _header.vkFormat == VK_FORMAT_UNDEFINED && (_colorModel == COLOR_MODEL_ETC1S || _colorModel == COLOR_MODEL_UASTC);
+}
+
+StoragePointer KTX2::getLevelData(uint32_t level) const {
+    if (level >= _levels.size()) {
+        return nullptr;
+    }
+    return _storage->createView((size_t)_levels[level].byteLength, (size_t)_levels[level].byteOffset);
+}
+
+StoragePointer KTX2::getSupercompressionGlobalData() const {
+    if (_header.sgdByteLength == 0) {
+        return nullptr;
+    }
+    return _storage->createView((size_t)_header.sgdByteLength, (size_t)_header.sgdByteOffset);
+}
@@ -0,0 +1,107 @@
+//
+//  KTX2.h
+//  ktx/src/ktx
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_ktx_KTX2_h
+#define hifi_ktx_KTX2_h
+
+#include <algorithm>
+
+#include "KTX.h"
+
+namespace ktx {
+    // The KTX 2.0 container, see https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html
+    // Only reading is supported. The levels of a supercompressed texture, or of a Basis Universal one, have to be
+    // inflated or transcoded before they can be uploaded, which this doesn't do.
+    class KTX2 {
+    public:
+        static const size_t IDENTIFIER_SIZE { 12 };
+        static const size_t HEADER_SIZE { 80 }; // with the identifier
+        static const size_t LEVEL_INDEX_ENTRY_SIZE { 3 * sizeof(uint64_t) };
+        static const std::array<Byte, IDENTIFIER_SIZE> IDENTIFIER;
+
+        static const uint32_t VK_FORMAT_UNDEFINED { 0 };
+
+        enum class SupercompressionScheme : uint32_t {
+            NONE = 0,
+            BASIS_LZ = 1,
+            ZSTANDARD = 2,
+            ZLIB = 3,
+        };
+
+        // the color models of the data format descriptor that mark Basis Universal data
+        static const uint8_t COLOR_MODEL_ETC1S { 163 };
+        static const uint8_t COLOR_MODEL_UASTC { 166 };
+        static const uint8_t TRANSFER_FUNCTION_SRGB { 2 };
+
+        struct Header {
+            uint32_t vkFormat { VK_FORMAT_UNDEFINED };
+            uint32_t typeSize { 1 };
+            uint32_t pixelWidth { 0 };
+            uint32_t pixelHeight { 0 };
+            uint32_t pixelDepth { 0 };
+            uint32_t layerCount { 0 };
+            uint32_t faceCount { 1 };
+            uint32_t levelCount { 0 };
+            uint32_t supercompressionScheme { 0 };
+
+            uint32_t dfdByteOffset { 0 };
+            uint32_t dfdByteLength { 0 };
+            uint32_t kvdByteOffset { 0 };
+            uint32_t kvdByteLength { 0 };
+            uint64_t sgdByteOffset { 0 };
+            uint64_t sgdByteLength { 0 };
+
+            // a level count of 0 asks for the mips to be generated, from the one level stored
+            uint32_t getNumStoredLevels() const { return std::max(levelCount, 1U); }
+        };
+
+        struct Level {
+            uint64_t byteOffset { 0 };
+            uint64_t byteLength { 0 };
+            uint64_t uncompressedByteLength { 0 };
+        };
+        using Levels = std::vector<Level>;
+
+        static bool checkIdentifier(size_t srcSize, const Byte* srcBytes);
+
+        // null if the storage isn't a valid KTX 2.0 file
+        static std::unique_ptr<KTX2> create(const StoragePointer& src);
+
+        const Header& getHeader() const { return _header; }
+        const Levels& getLevels() const { return _levels; }
+        const KeyValues& getKeyValues() const { return _keyValues; }
+        const StoragePointer& getStorage() const { return _storage; }
+
+        SupercompressionScheme getSupercompressionScheme() const { return (SupercompressionScheme)_header.supercompressionScheme; }
+        uint8_t getColorModel() const { return _colorModel; }
+        bool isSRGB() const { return _transferFunction == TRANSFER_FUNCTION_SRGB; }
+        // ETC1S or UASTC, to be transcoded to a format the GPU supports
+        bool isBasisUniversal() const;
+
+        // the data of a level as stored, level 0 being the largest
+        StoragePointer getLevelData(uint32_t level) const;
+        // the supercompression global data, used by BasisLZ
+        StoragePointer getSupercompressionGlobalData() const;
+
+    private:
+        KTX2() {}
+
+        Header _header;
+        Levels _levels;
+        KeyValues _keyValues;
+        uint8_t _colorModel { 0 };
+        uint8_t _transferFunction { 0 };
+        StoragePointer _storage;
+    };
+}
+
+#endif // hifi_ktx_KTX2_h
@@ -168,6 +168,8 @@ static const std::unordered_set<uint32_t> VALID_GL_INTERNAL_COMPRESSED_FORMATS {
     (uint32_t)GLInternalFormat::COMPRESSED_SIGNED_R11_EAC,
     (uint32_t)GLInternalFormat::COMPRESSED_RG11_EAC,
     (uint32_t)GLInternalFormat::COMPRESSED_SIGNED_RG11_EAC,
+    (uint32_t)GLInternalFormat::COMPRESSED_RGBA_ASTC_4x4,
+    (uint32_t)GLInternalFormat::COMPRESSED_SRGB8_ALPHA8_ASTC_4x4,
 };
 
 static const std::unordered_set<uint32_t> VALID_GL_BASE_INTERNAL_FORMATS {
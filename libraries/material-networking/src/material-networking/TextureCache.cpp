@@ -50,6 +50,7 @@
 #include <StatTracker.h>
 
 #include <TextureMeta.h>
+#include <PerformanceCounters.h>
 
 #include <OwningBuffer.h>
 
@@ -100,7 +101,7 @@ static const float HIGH_MIPS_LOAD_PRIORITY { 9.0f }; // Make sure high mips load
 std::function<gpu::TexturePointer(const QUuid&)> Texture::_unboundTextureForUUIDOperator { nullptr };
 
 TextureCache::TextureCache() {
-    _ktxCache->initialize();
+    _ktxCache->initializeInBackground();
 #if defined(DISABLE_KTX_CACHE)
     _ktxCache->wipe();
 #endif
@@ -271,6 +272,17 @@ NetworkTexturePointer TextureCache::getTexture(const QUrl& url, image::TextureUs
     return ResourceCache::getResource(modifiedUrl, QUrl(), &extra, std::hash<TextureExtra>()(extra)).staticCast<NetworkTexture>();
 }
 
+NetworkTexturePointer TextureCache::getSpeculativeTexture(const QUrl& url, image::TextureUsage::Type type) {
+    // only the textures getTexture looks up by their own url
+    if (url.scheme() == RESOURCE_SCHEME || type == image::TextureUsage::SKY_TEXTURE || type == image::TextureUsage::AMBIENT_TEXTURE ||
+            QUrl::fromPercentEncoding(url.toEncoded()).startsWith("{")) {
+        return NetworkTexturePointer();
+    }
+    QByteArray content;
+    TextureExtra extra = { type, content, ABSOLUTE_MAX_TEXTURE_NUM_PIXELS, image::ColorChannel::NONE };
+    return ResourceCache::getSpeculativeResource(url, &extra, std::hash<TextureExtra>()(extra)).staticCast<NetworkTexture>();
+}
+
 std::pair<gpu::TexturePointer, glm::ivec2> TextureCache::getTextureByHash(const std::string& hash) {
     std::pair<gpu::TextureWeakPointer, glm::ivec2> weakPointer;
     {
@@ -434,6 +446,7 @@ void NetworkTexture::setExtra(void* extra) {
         _textureSource = std::make_shared<gpu::TextureSource>(_url, (int)_type);
     }
     _lowestRequestedMipLevel = 0;
+    _mipTiers = MipTiers();
 
     auto fileNameLowercase = _url.fileName().toLower();
     if (fileNameLowercase.endsWith(TEXTURE_META_EXTENSION)) {
@@ -512,7 +525,23 @@ private:
     image::ColorChannel _sourceChannel;
 };
 
+ResourceRequestClass NetworkTexture::getRequestClass(float priority) const {
+    // the textures wait for the nearby models, unless prioritized above every entity
+    auto requestClass = Resource::getRequestClass(priority);
+    if (requestClass == ResourceRequestClass::NEARBY || requestClass == ResourceRequestClass::DISTANT) {
+        return ResourceRequestClass::TEXTURE;
+    }
+    return requestClass;
+}
+
+static PerformanceCounters::Gauge& skippedMipBytesGauge() {
+    static auto& gauge = PerformanceCounters::getInstance().gauge("texture_skipped_mip_bytes",
+        "Bytes of the mips of streamed textures that aren't loaded because the textures are needed at a smaller size");
+    return gauge;
+}
+
 NetworkTexture::~NetworkTexture() {
+    setSkippedMipBytes(0);
     if (_ktxHeaderRequest || _ktxMipRequest) {
         if (_ktxHeaderRequest) {
             _ktxHeaderRequest->disconnect(this);
@@ -589,9 +618,11 @@ void NetworkTexture::makeRequest() {
 
             // Add a fragment to the base url so we can identify the section of the ktx being requested when debugging
             // The actual requested url is _activeUrl and will not contain the fragment
+            // The rest of the tier the next mip is in comes in the same request
             uint16_t nextMip = _lowestKnownPopulatedMip - 1;
-            _url.setFragment(QString::number(nextMip));
-            startMipRangeRequest(nextMip, nextMip);
+            uint16_t firstMip = _mipTiers.getTierFirstMip(nextMip);
+            _url.setFragment(firstMip == nextMip ? QString::number(nextMip) : QString("%1-%2").arg(firstMip).arg(nextMip));
+            startMipRangeRequest(firstMip, nextMip);
         }
     } else {
         qWarning(networking) << "NetworkTexture::makeRequest() called while not in a valid state: " << _ktxResourceState;
@@ -698,7 +729,17 @@ void NetworkTexture::startRequestForNextMipLevel() {
     }
 
     _lowestKnownPopulatedMip = texture->minAvailableMipLevel();
-    if (_lowestRequestedMipLevel < _lowestKnownPopulatedMip) {
+    uint16_t lowestNeededMip = evalLowestNeededMip();
+
+    size_t skippedMipBytes = 0;
+    if (_originalKtxDescriptor) {
+        for (uint16_t mip = 0; mip < lowestNeededMip && mip < _originalKtxDescriptor->images.size(); ++mip) {
+            skippedMipBytes += _originalKtxDescriptor->images[mip]._imageSize;
+        }
+    }
+    setSkippedMipBytes(skippedMipBytes);
+
+    if (lowestNeededMip < _lowestKnownPopulatedMip) {
         _ktxResourceState = PENDING_MIP_REQUEST;
 
         init(false);
@@ -709,6 +750,46 @@ void NetworkTexture::startRequestForNextMipLevel() {
     }
 }
 
+void NetworkTexture::setDesiredSize(int size) {
+    size = std::max(size, 0);
+    if (size == _desiredSize) {
+        return;
+    }
+    _desiredSize = size;
+    startRequestForNextMipLevel();
+}
+
+uint16_t NetworkTexture::evalLowestNeededMip() const {
+    uint16_t mip = _lowestRequestedMipLevel;
+    if (!_originalKtxDescriptor) {
+        return mip;
+    }
+
+    const auto& header = _originalKtxDescriptor->header;
+    uint16_t numMips = (uint16_t)_originalKtxDescriptor->images.size();
+    auto width = [&](uint16_t level) { return std::max(header.getPixelWidth() >> level, 1U); };
+    auto height = [&](uint16_t level) { return std::max(header.getPixelHeight() >> level, 1U); };
+
+    // a mip is more than needed when the next one is still as large as the texture is on screen, or it's over the
+    // pixel limit
+    while (mip + 1 < numMips) {
+        bool nextIsLargeEnough = _desiredSize > 0 && std::max(width(mip + 1), height(mip + 1)) >= (uint32_t)_desiredSize;
+        bool isOverPixelLimit = (size_t)width(mip) * height(mip) > (size_t)_maxNumPixels;
+        if (!nextIsLargeEnough && !isOverPixelLimit) {
+            break;
+        }
+        ++mip;
+    }
+    return _mipTiers.getTierFirstMip(mip);
+}
+
+void NetworkTexture::setSkippedMipBytes(size_t skippedMipBytes) {
+    if (skippedMipBytes != _skippedMipBytes) {
+        skippedMipBytesGauge().add((double)skippedMipBytes - (double)_skippedMipBytes);
+        _skippedMipBytes = skippedMipBytes;
+    }
+}
+
 // Load mips in the range [low, high] (inclusive)
 void NetworkTexture::startMipRangeRequest(uint16_t low, uint16_t high) {
     if (_ktxMipRequest) {
@@ -729,9 +810,9 @@ void NetworkTexture::startMipRangeRequest(uint16_t low, uint16_t high) {
     _ktxMipLevelRangeInFlight = { low, high };
     if (isHighMipRequest) {
         static const int HIGH_MIP_MAX_SIZE = 5516;
-        // This is a special case where we load the high 7 mips
+        // This is a special case where we load the low tier, or the high 7 mips of a KTX baked without tiers
         ByteRange range;
-        range.fromInclusive = -HIGH_MIP_MAX_SIZE;
+        range.fromInclusive = -(_mipTiers.isEmpty() ? HIGH_MIP_MAX_SIZE : (int64_t)_mipTiers.lowTierSize);
         _ktxMipRequest->setByteRange(range);
 
         connect(_ktxMipRequest, &ResourceRequest::finished, this, &NetworkTexture::ktxInitialDataRequestFinished);
@@ -826,17 +907,26 @@ void NetworkTexture::ktxMipRequestFinished() {
 
         if (_ktxResourceState == REQUESTING_MIP) {
             Q_ASSERT(_ktxMipLevelRangeInFlight.first != NULL_MIP_LEVEL);
-            Q_ASSERT(_ktxMipLevelRangeInFlight.second - _ktxMipLevelRangeInFlight.first == 0);
+            Q_ASSERT(_ktxMipLevelRangeInFlight.second >= _ktxMipLevelRangeInFlight.first);
 
             _ktxResourceState = WAITING_FOR_MIP_REQUEST;
 
             auto self = _self;
             auto url = _url;
             auto data = _ktxMipRequest->getData();
-            auto mipLevel = _ktxMipLevelRangeInFlight.first;
+            auto lowMip = _ktxMipLevelRangeInFlight.first;
+            auto highMip = _ktxMipLevelRangeInFlight.second;
             auto texture = _textureSource->getGPUTexture();
+
+            // where each mip of the range is in the data, which starts after the size of the first one
+            std::vector<std::pair<size_t, uint32_t>> mipRanges;
+            for (auto mip = lowMip; mip <= highMip; ++mip) {
+                const auto& image = _originalKtxDescriptor->images[mip];
+                mipRanges.push_back({ image._imageOffset - _originalKtxDescriptor->images[lowMip]._imageOffset, image._imageSize });
+            }
+
             DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
-            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, mipLevel, url, texture] {
+            QtConcurrent::run(QThreadPool::globalInstance(), [self, data, lowMip, highMip, mipRanges, url, texture] {
                 PROFILE_RANGE_EX(resource_parse_image, "NetworkTexture - Processing Mip Data", 0xffff0000, 0, { { "url", url.toString() } });
                 DependencyManager::get<StatTracker>()->decrementStat("PendingProcessing");
                 CounterStat counter("Processing");
@@ -856,11 +946,19 @@ void NetworkTexture::ktxMipRequestFinished() {
 
                 Q_ASSERT_X(texture, "Async - NetworkTexture::ktxMipRequestFinished", "NetworkTexture should have been assigned a GPU texture by now.");
 
-                texture->assignStoredMip(mipLevel, data.size(), reinterpret_cast<const uint8_t*>(data.data()));
+                // the mips are stored from the smallest up
+                for (int mip = highMip; mip >= lowMip; --mip) {
+                    const auto& mipRange = mipRanges[mip - lowMip];
+                    if (mipRange.first + mipRange.second > (size_t)data.size()) {
+                        break;
+                    }
+                    texture->assignStoredMip((uint16_t)mip, mipRange.second,
+                                             reinterpret_cast<const uint8_t*>(data.data()) + mipRange.first);
+                }
 
                 // If mip level assigned above is still unavailable, then we assume future requests will also fail.
                 auto minMipLevel = texture->minAvailableMipLevel();
-                if (minMipLevel > mipLevel) {
+                if (minMipLevel > lowMip) {
                     return;
                 }
 
@@ -1090,6 +1188,8 @@ void NetworkTexture::loadMetaContent(const QByteArray& content) {
 
                 _currentlyLoadingResourceType = ResourceType::KTX;
                 _activeUrl = _activeUrl.resolved(url);
+                auto mipTiers = meta.mipTiers.find(pair.first);
+                _mipTiers = mipTiers != meta.mipTiers.end() ? mipTiers->second : MipTiers();
                 auto textureCache = DependencyManager::get<TextureCache>();
                 auto self = _self.lock();
                 if (!self) {
@@ -1105,6 +1205,7 @@ void NetworkTexture::loadMetaContent(const QByteArray& content) {
     if (!meta.uncompressed.isEmpty()) {
         _currentlyLoadingResourceType = ResourceType::KTX;
         _activeUrl = _activeUrl.resolved(meta.uncompressed);
+        _mipTiers = meta.uncompressedMipTiers;
 
         auto textureCache = DependencyManager::get<TextureCache>();
         auto self = _self.lock();
@@ -1161,6 +1262,7 @@ void NetworkTexture::refresh() {
     }
 
     _ktxResourceState = PENDING_INITIAL_LOAD;
+    setSkippedMipBytes(0);
     Resource::refresh();
 }
 
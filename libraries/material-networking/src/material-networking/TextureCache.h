@@ -58,6 +58,7 @@ public:
     ~NetworkTexture() override;
 
     QString getType() const override { return "NetworkTexture"; }
+    ResourceRequestClass getRequestClass(float priority) const override;
 
     int getOriginalWidth() const { return _textureSource->getGPUTexture() ? _textureSource->getGPUTexture()->getOriginalWidth() : 0; }
     int getOriginalHeight() const { return _textureSource->getGPUTexture() ? _textureSource->getGPUTexture()->getOriginalHeight() : 0; }
@@ -71,6 +72,10 @@ public:
 
     Q_INVOKABLE void setOriginalDescriptor(ktx::KTXDescriptor* descriptor) { _originalKtxDescriptor.reset(descriptor); }
 
+    // streams in the mips of a KTX texture down to the tier it needs to be size pixels across on screen, or all of them
+    // for 0. The mips past that aren't requested until a larger size is set.
+    Q_INVOKABLE void setDesiredSize(int size);
+
     void setExtra(void* extra) override;
 
 signals:
@@ -100,6 +105,10 @@ protected:
     void startMipRangeRequest(uint16_t low, uint16_t high);
     void handleFinishedInitialLoad();
 
+    // the largest mip the texture needs, at the start of its tier
+    uint16_t evalLowestNeededMip() const;
+    void setSkippedMipBytes(size_t skippedMipBytes);
+
 private:
     friend class KTXReader;
     friend class ImageReader;
@@ -144,6 +153,12 @@ private:
     // mip offsets to change.
     ktx::KTXDescriptorPointer _originalKtxDescriptor;
 
+    // the streaming tiers of the KTX being loaded, which are empty for one baked without them, and loaded a mip at a time
+    MipTiers _mipTiers;
+    int _desiredSize { 0 };
+    // the bytes of the mips larger than the texture needs, which aren't loaded
+    size_t _skippedMipBytes { 0 };
+
     int _width { 0 };
     int _height { 0 };
     int _maxNumPixels { ABSOLUTE_MAX_TEXTURE_NUM_PIXELS };
@@ -189,6 +204,9 @@ public:
         const QByteArray& content = QByteArray(), int maxNumPixels = ABSOLUTE_MAX_TEXTURE_NUM_PIXELS,
         image::ColorChannel sourceChannel = image::ColorChannel::NONE);
 
+    /// Loads a texture predicted to be needed soon through getTexture, see ResourceCache::getSpeculativeResource.
+    NetworkTexturePointer getSpeculativeTexture(const QUrl& url, image::TextureUsage::Type type = image::TextureUsage::DEFAULT_TEXTURE);
+
     std::pair<gpu::TexturePointer, glm::ivec2> getTextureByHash(const std::string& hash);
     std::pair<gpu::TexturePointer, glm::ivec2> cacheTextureByHash(const std::string& hash, const std::pair<gpu::TexturePointer, glm::ivec2>& textureAndSize);
 
@@ -20,6 +20,7 @@
 #include "CalculateBlendshapeTangentsTask.h"
 #include "PrepareJointsTask.h"
 #include "BuildDracoMeshTask.h"
+#include "BuildMeshLODsTask.h"
 #include "ParseFlowDataTask.h"
 
 namespace baker {
@@ -76,7 +77,7 @@ namespace baker {
 
     class BuildMeshesTask {
     public:
-        using Input = VaryingSet5<std::vector<hfm::Mesh>, std::vector<graphics::MeshPointer>, NormalsPerMesh, TangentsPerMesh, BlendshapesPerMesh>;
+        using Input = VaryingSet6<std::vector<hfm::Mesh>, std::vector<graphics::MeshPointer>, NormalsPerMesh, TangentsPerMesh, BlendshapesPerMesh, LODsPerMesh>;
         using Output = std::vector<hfm::Mesh>;
         using JobModel = Job::ModelIO<BuildMeshesTask, Input, Output>;
 
@@ -87,6 +88,7 @@ namespace baker {
             auto& normalsPerMeshIn = input.get2();
             auto& tangentsPerMeshIn = input.get3();
             auto& blendshapesPerMeshIn = input.get4();
+            auto& lodsPerMeshIn = input.get5();
 
             auto meshesOut = meshesIn;
             for (int i = 0; i < numMeshes; i++) {
@@ -99,6 +101,18 @@ namespace baker {
                 meshOut.normals = QVector<glm::vec3>(stdNormals.begin(), stdNormals.end());
                 meshOut.tangents = QVector<glm::vec3>(stdTangents.begin(), stdTangents.end());
                 meshOut.blendshapes = QVector<hfm::Blendshape>(stdBlendshapes.begin(), stdBlendshapes.end());
+
+                const auto& lods = safeGet(lodsPerMeshIn, i);
+                if (!lods.errors.empty()) {
+                    meshOut.lodErrors = QVector<float>(lods.errors.begin(), lods.errors.end());
+                    for (int j = 0; j < meshOut.parts.size(); j++) {
+                        auto& partOut = meshOut.parts[j];
+                        partOut.lodTriangleIndices.clear();
+                        for (const auto& lodTriangleIndices : lods.triangleIndices) {
+                            partOut.lodTriangleIndices.push_back(safeGet(lodTriangleIndices, j));
+                        }
+                    }
+                }
             }
             output = meshesOut;
         }
@@ -167,12 +181,16 @@ namespace baker {
             const auto parseMaterialMappingInputs = ParseMaterialMappingTask::Input(mapping, materialMappingBaseURL).asVarying();
             const auto materialMapping = model.addJob<ParseMaterialMappingTask>("ParseMaterialMapping", parseMaterialMappingInputs);
 
+            // Simplify the meshes into levels of detail
+            // NOTE: This task is disabled by default and must be enabled through configuration
+            const auto lodsPerMesh = model.addJob<BuildMeshLODsTask>("BuildMeshLODs", meshesIn);
+
             // Build Draco meshes
             // NOTE: This task is disabled by default and must be enabled through configuration
             // TODO: Tangent support (Needs changes to FBXSerializer_Mesh as well)
             // NOTE: Due to an unresolved linker error, BuildDracoMeshTask is not functional on Android
             // TODO: Figure out why BuildDracoMeshTask.cpp won't link with draco on Android
-            const auto buildDracoMeshInputs = BuildDracoMeshTask::Input(meshesIn, normalsPerMesh, tangentsPerMesh).asVarying();
+            const auto buildDracoMeshInputs = BuildDracoMeshTask::Input(meshesIn, normalsPerMesh, tangentsPerMesh, lodsPerMesh).asVarying();
             const auto buildDracoMeshOutputs = model.addJob<BuildDracoMeshTask>("BuildDracoMesh", buildDracoMeshInputs);
             const auto dracoMeshes = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(0);
             const auto dracoErrors = buildDracoMeshOutputs.getN<BuildDracoMeshTask::Output>(1);
@@ -184,7 +202,7 @@ namespace baker {
             // Combine the outputs into a new hfm::Model
             const auto buildBlendshapesInputs = BuildBlendshapesTask::Input(blendshapesPerMeshIn, normalsPerBlendshapePerMesh, tangentsPerBlendshapePerMesh).asVarying();
             const auto blendshapesPerMeshOut = model.addJob<BuildBlendshapesTask>("BuildBlendshapes", buildBlendshapesInputs);
-            const auto buildMeshesInputs = BuildMeshesTask::Input(meshesIn, graphicsMeshes, normalsPerMesh, tangentsPerMesh, blendshapesPerMeshOut).asVarying();
+            const auto buildMeshesInputs = BuildMeshesTask::Input(meshesIn, graphicsMeshes, normalsPerMesh, tangentsPerMesh, blendshapesPerMeshOut, lodsPerMesh).asVarying();
             const auto meshesOut = model.addJob<BuildMeshesTask>("BuildMeshes", buildMeshesInputs);
             const auto buildModelInputs = BuildModelTask::Input(hfmModelIn, meshesOut, jointsOut, jointRotationOffsets, jointIndices, flowData).asVarying();
             const auto hfmModelOut = model.addJob<BuildModelTask>("BuildModel", buildModelInputs);
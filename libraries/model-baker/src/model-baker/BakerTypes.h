@@ -36,6 +36,14 @@ namespace baker {
     using TangentsPerBlendshape = std::vector<std::vector<glm::vec3>>;
 
     using MeshIndicesToModelNames = QHash<int, QString>;
+
+    // The coarser levels of detail of a mesh
+    class MeshLODs {
+    public:
+        std::vector<std::vector<QVector<int>>> triangleIndices; // per level, the triangle indices of each part
+        std::vector<float> errors; // per level, the largest distance of its surface from the full detail one
+    };
+    using LODsPerMesh = std::vector<MeshLODs>;
 };
 
 #endif // hifi_BakerTypes_h
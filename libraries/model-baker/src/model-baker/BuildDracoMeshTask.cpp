@@ -35,10 +35,19 @@
 #pragma GCC diagnostic pop
 #endif
 
+#include <algorithm>
+#include <array>
+#include <map>
+
+#include <tbb/parallel_for.h>
+
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
 
 #ifndef Q_OS_ANDROID
+// the full detail level and the coarser ones share the bits of a face's mask
+const size_t MAX_DRACO_LODS = 15;
+
 std::vector<hifi::ByteArray> createMaterialList(const hfm::Mesh& mesh) {
     std::vector<hifi::ByteArray> materialList;
     for (const auto& meshPart : mesh.parts) {
@@ -51,7 +60,47 @@ std::vector<hifi::ByteArray> createMaterialList(const hfm::Mesh& mesh) {
     return materialList;
 }
 
-std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals, const std::vector<glm::vec3>& tangents, const std::vector<hifi::ByteArray>& materialList) {
+using DracoFace = std::array<int32_t, 3>;
+
+// The faces of each part, with the levels of detail they are in. Faces in several levels are only added once.
+std::vector<std::vector<std::pair<DracoFace, uint16_t>>> createFacesPerPart(const hfm::Mesh& mesh, const baker::MeshLODs& lods) {
+    std::vector<std::vector<std::pair<DracoFace, uint16_t>>> facesPerPart;
+    facesPerPart.reserve(mesh.parts.size());
+    for (int i = 0; i < mesh.parts.size(); i++) {
+        const auto& part = mesh.parts[i];
+        facesPerPart.emplace_back();
+        auto& faces = facesPerPart.back();
+
+        for (const auto* indices : { &part.quadTrianglesIndices, &part.triangleIndices }) {
+            for (int j = 0; (j + 2) < indices->size(); j += 3) {
+                faces.push_back({ { indices->at(j), indices->at(j + 1), indices->at(j + 2) }, 1 });
+            }
+        }
+
+        if (!lods.triangleIndices.empty()) {
+            std::map<DracoFace, size_t> faceIndices;
+            for (size_t j = 0; j < faces.size(); j++) {
+                faceIndices.emplace(faces[j].first, j);
+            }
+            for (size_t j = 0; j < lods.triangleIndices.size() && j < MAX_DRACO_LODS; j++) {
+                const auto& indices = baker::safeGet(lods.triangleIndices[j], i);
+                uint16_t lodBit = (uint16_t)(1 << (j + 1));
+                for (int k = 0; (k + 2) < indices.size(); k += 3) {
+                    DracoFace face { indices[k], indices[k + 1], indices[k + 2] };
+                    auto faceIndex = faceIndices.emplace(face, faces.size());
+                    if (faceIndex.second) {
+                        faces.push_back({ face, lodBit });
+                    } else {
+                        faces[faceIndex.first->second].second |= lodBit;
+                    }
+                }
+            }
+        }
+    }
+    return facesPerPart;
+}
+
+std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals, const std::vector<glm::vec3>& tangents, const std::vector<hifi::ByteArray>& materialList, const baker::MeshLODs& lods) {
     Q_ASSERT(normals.size() == 0 || (int)normals.size() == mesh.vertices.size());
     Q_ASSERT(mesh.colors.size() == 0 || mesh.colors.size() == mesh.vertices.size());
     Q_ASSERT(mesh.texCoords.size() == 0 || mesh.texCoords.size() == mesh.vertices.size());
@@ -67,6 +116,15 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
         numTriangles += (part.triangleIndices.size() - extraTriangleIndices) / 3;
     }
 
+    auto facesPerPart = createFacesPerPart(mesh, lods);
+    bool hasLODs { !lods.triangleIndices.empty() };
+    if (hasLODs) {
+        numTriangles = 0;
+        for (const auto& faces : facesPerPart) {
+            numTriangles += faces.size();
+        }
+    }
+
     if (numTriangles == 0) {
         return std::make_tuple(std::unique_ptr<draco::Mesh>(), false);
     }
@@ -88,6 +146,7 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
     int texCoords1AttributeID { -1 };
     int faceMaterialAttributeID { -1 };
     int originalIndexAttributeID { -1 };
+    int lodMaskAttributeID { -1 };
 
     const int positionAttributeID = meshBuilder.AddAttribute(draco::GeometryAttribute::POSITION,
         3, draco::DT_FLOAT32);
@@ -119,6 +178,12 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
             (draco::GeometryAttribute::Type)DRACO_ATTRIBUTE_MATERIAL_ID,
             1, draco::DT_UINT16);
     }
+    // NOTE: The vertices shared by faces in different levels of detail are split by their different masks
+    if (hasLODs) {
+        lodMaskAttributeID = meshBuilder.AddAttribute(
+            (draco::GeometryAttribute::Type)DRACO_ATTRIBUTE_LOD_MASK,
+            1, draco::DT_UINT16);
+    }
 
     auto partIndex = 0;
     draco::FaceIndex face;
@@ -128,14 +193,17 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
         auto materialIt = std::find(materialList.cbegin(), materialList.cend(), QVariant(part.materialID).toByteArray());
         materialID = (uint16_t)(materialIt - materialList.cbegin());
 
-        auto addFace = [&](const QVector<int>& indices, int index, draco::FaceIndex face) {
-            int32_t idx0 = indices[index];
-            int32_t idx1 = indices[index + 1];
-            int32_t idx2 = indices[index + 2];
+        auto addFace = [&](const DracoFace& indices, uint16_t lodMask, draco::FaceIndex face) {
+            int32_t idx0 = indices[0];
+            int32_t idx1 = indices[1];
+            int32_t idx2 = indices[2];
 
             if (hasPerFaceMaterials) {
                 meshBuilder.SetPerFaceAttributeValueForFace(faceMaterialAttributeID, face, &materialID);
             }
+            if (hasLODs) {
+                meshBuilder.SetPerFaceAttributeValueForFace(lodMaskAttributeID, face, &lodMask);
+            }
 
             meshBuilder.SetAttributeValuesForFace(positionAttributeID, face,
                 &mesh.vertices[idx0], &mesh.vertices[idx1],
@@ -169,12 +237,8 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
             }
         };
 
-        for (int i = 0; (i + 2) < part.quadTrianglesIndices.size(); i += 3) {
-            addFace(part.quadTrianglesIndices, i, face++);
-        }
-
-        for (int i = 0; (i + 2) < part.triangleIndices.size(); i += 3) {
-            addFace(part.triangleIndices, i, face++);
+        for (const auto& partFace : facesPerPart[partIndex]) {
+            addFace(partFace.first, partFace.second, face++);
         }
 
         partIndex++;
@@ -200,14 +264,92 @@ std::tuple<std::unique_ptr<draco::Mesh>, bool> createDracoMesh(const hfm::Mesh&
     if (needsOriginalIndices) {
         dracoMesh->attribute(originalIndexAttributeID)->set_unique_id(DRACO_ATTRIBUTE_ORIGINAL_INDEX);
     }
+
+    if (hasLODs) {
+        dracoMesh->attribute(lodMaskAttributeID)->set_unique_id(DRACO_ATTRIBUTE_LOD_MASK);
+    }
     
     return std::make_tuple(std::move(dracoMesh), false);
 }
 #endif // not Q_OS_ANDROID
 
+const std::vector<DracoProfile>& DracoProfile::getProfiles() {
+    static const std::vector<DracoProfile> profiles {
+        // the smallest downloads, for desktop clients on slow connections
+        { "compact", 11, 10, 7, 8, 0, 0 },
+        { DEFAULT_DRACO_PROFILE, 14, 12, 10, 0, 0, 5 },
+        // sequential encoding, which decodes several times faster than the edgebreaker at some cost in size
+        { "fastDecode", 14, 12, 10, 0, 10, 10 },
+        // fast decoding at the precision a headset's display shows, for standalone headsets
+        { "mobile", 12, 11, 8, 8, 10, 10 }
+    };
+    return profiles;
+}
+
+const DracoProfile* DracoProfile::find(const QString& name) {
+    const auto& profiles = getProfiles();
+    auto profile = std::find_if(profiles.cbegin(), profiles.cend(), [&](const DracoProfile& profile) {
+        return profile.name.compare(name, Qt::CaseInsensitive) == 0;
+    });
+    return profile != profiles.cend() ? &*profile : nullptr;
+}
+
 void BuildDracoMeshTask::configure(const Config& config) {
-    _encodeSpeed = config.encodeSpeed;
-    _decodeSpeed = config.decodeSpeed;
+    const DracoProfile* profile = DracoProfile::find(config.profile);
+    if (!profile) {
+        qCWarning(model_baker) << "Unknown Draco profile" << config.profile << "- using" << DEFAULT_DRACO_PROFILE;
+        profile = DracoProfile::find(DEFAULT_DRACO_PROFILE);
+    }
+    _profile = *profile;
+
+    const DracoProfile* largeMeshProfile = config.largeMeshProfile.isEmpty() ? nullptr : DracoProfile::find(config.largeMeshProfile);
+    if (!config.largeMeshProfile.isEmpty() && !largeMeshProfile) {
+        qCWarning(model_baker) << "Unknown Draco profile" << config.largeMeshProfile << "for large meshes";
+    }
+    _hasLargeMeshProfile = largeMeshProfile != nullptr;
+    _largeMeshProfile = _hasLargeMeshProfile ? *largeMeshProfile : _profile;
+    _largeMeshTriangles = config.largeMeshTriangles;
+
+    for (auto* configured : { &_profile, &_largeMeshProfile }) {
+        if (config.encodeSpeed >= 0) {
+            configured->encodeSpeed = config.encodeSpeed;
+        }
+        if (config.decodeSpeed >= 0) {
+            configured->decodeSpeed = config.decodeSpeed;
+        }
+    }
+}
+
+hifi::ByteArray BuildDracoMeshTask::encodeMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals,
+                                               const std::vector<glm::vec3>& tangents, const baker::MeshLODs& lods,
+                                               const DracoProfile& profile, std::vector<hifi::ByteArray>& materialList, bool& error) {
+#ifdef Q_OS_ANDROID
+    error = false;
+    return hifi::ByteArray();
+#else
+    materialList = createMaterialList(mesh);
+
+    std::unique_ptr<draco::Mesh> dracoMesh;
+    std::tie(dracoMesh, error) = createDracoMesh(mesh, normals, tangents, materialList, lods);
+    if (!dracoMesh) {
+        return hifi::ByteArray();
+    }
+
+    draco::Encoder encoder;
+
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, profile.positionBits);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, profile.texCoordBits);
+    encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, profile.normalBits);
+    if (profile.colorBits > 0) {
+        encoder.SetAttributeQuantization(draco::GeometryAttribute::COLOR, profile.colorBits);
+    }
+    encoder.SetSpeedOptions(profile.encodeSpeed, profile.decodeSpeed);
+
+    draco::EncoderBuffer buffer;
+    encoder.EncodeMeshToBuffer(*dracoMesh, &buffer);
+
+    return hifi::ByteArray(buffer.data(), (int)buffer.size());
+#endif // not Q_OS_ANDROID
 }
 
 void BuildDracoMeshTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -217,42 +359,42 @@ void BuildDracoMeshTask::run(const baker::BakeContextPointer& context, const Inp
     const auto& meshes = input.get0();
     const auto& normalsPerMesh = input.get1();
     const auto& tangentsPerMesh = input.get2();
+    const auto& lodsPerMesh = input.get3();
     auto& dracoBytesPerMesh = output.edit0();
     auto& dracoErrorsPerMesh = output.edit1();
     auto& materialLists = output.edit2();
 
-    dracoBytesPerMesh.reserve(meshes.size());
+    dracoBytesPerMesh.resize(meshes.size());
     // vector<bool> is an exception to the std::vector conventions as it is a bit field
-    // So a bool reference to an element doesn't work
-    dracoErrorsPerMesh.resize(meshes.size());
-    materialLists.reserve(meshes.size());
-    for (size_t i = 0; i < meshes.size(); i++) {
+    // So its elements can't be written from several threads, and the errors are gathered apart
+    std::vector<uint8_t> dracoErrors(meshes.size(), 0);
+    materialLists.resize(meshes.size());
+    tbb::parallel_for((size_t)0, meshes.size(), [&](size_t i) {
         const auto& mesh = meshes[i];
         const auto& normals = baker::safeGet(normalsPerMesh, i);
         const auto& tangents = baker::safeGet(tangentsPerMesh, i);
-        dracoBytesPerMesh.emplace_back();
-        auto& dracoBytes = dracoBytesPerMesh.back();
-        materialLists.push_back(createMaterialList(mesh));
-        const auto& materialList = materialLists.back();
+        const auto& lods = baker::safeGet(lodsPerMesh, i);
+
+        // the large meshes are the ones a client waits longest on, so they can trade size for decode time
+        const DracoProfile* profile = &_profile;
+        if (_hasLargeMeshProfile) {
+            int numTriangles = 0;
+            for (const auto& part : mesh.parts) {
+                numTriangles += (part.quadTrianglesIndices.size() + part.triangleIndices.size()) / 3;
+            }
+            if (numTriangles >= _largeMeshTriangles) {
+                profile = &_largeMeshProfile;
+            }
+        }
 
         bool dracoError;
-        std::unique_ptr<draco::Mesh> dracoMesh;
-        std::tie(dracoMesh, dracoError) = createDracoMesh(mesh, normals, tangents, materialList);
-        dracoErrorsPerMesh[i] = dracoError;
-
-        if (dracoMesh) {
-            draco::Encoder encoder;
-
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::POSITION, 14);
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::TEX_COORD, 12);
-            encoder.SetAttributeQuantization(draco::GeometryAttribute::NORMAL, 10);
-            encoder.SetSpeedOptions(_encodeSpeed, _decodeSpeed);
-
-            draco::EncoderBuffer buffer;
-            encoder.EncodeMeshToBuffer(*dracoMesh, &buffer);
+        dracoBytesPerMesh[i] = encodeMesh(mesh, normals, tangents, lods, *profile, materialLists[i], dracoError);
+        dracoErrors[i] = dracoError;
+    });
 
-            dracoBytes = hifi::ByteArray(buffer.data(), (int)buffer.size());
-        }
+    dracoErrorsPerMesh.resize(meshes.size());
+    for (size_t i = 0; i < meshes.size(); i++) {
+        dracoErrorsPerMesh[i] = dracoErrors[i] != 0;
     }
 #endif // not Q_OS_ANDROID
 }
@@ -12,37 +12,75 @@
 #ifndef hifi_BuildDracoMeshTask_h
 #define hifi_BuildDracoMeshTask_h
 
+#include <vector>
+
+#include <QtCore/QString>
+
 #include <hfm/HFM.h>
 #include <shared/HifiTypes.h>
 
 #include "Engine.h"
 #include "BakerTypes.h"
 
+// The quantization bits and speeds of a Draco encode. Fewer bits make smaller meshes, and higher decode speeds make
+// meshes that are larger but quicker to decode, which is what the clients on mobile hardware wait on.
+struct DracoProfile {
+    QString name;
+    int positionBits;
+    int texCoordBits;
+    int normalBits;
+    // 0 leaves the colors lossless
+    int colorBits;
+    int encodeSpeed;
+    int decodeSpeed;
+
+    static const std::vector<DracoProfile>& getProfiles();
+    // nullptr for a name that isn't one of the profiles
+    static const DracoProfile* find(const QString& name);
+};
+
+static const QString DEFAULT_DRACO_PROFILE { "balanced" };
+
 // BuildDracoMeshTask is disabled by default
 class BuildDracoMeshConfig : public baker::JobConfig {
     Q_OBJECT
+    Q_PROPERTY(QString profile MEMBER profile)
+    Q_PROPERTY(QString largeMeshProfile MEMBER largeMeshProfile)
+    Q_PROPERTY(int largeMeshTriangles MEMBER largeMeshTriangles)
     Q_PROPERTY(int encodeSpeed MEMBER encodeSpeed)
     Q_PROPERTY(int decodeSpeed MEMBER decodeSpeed)
 public:
     BuildDracoMeshConfig() : baker::JobConfig(false) {}
 
-    int encodeSpeed { 0 };
-    int decodeSpeed { 5 };
+    QString profile { DEFAULT_DRACO_PROFILE };
+    // the meshes with at least largeMeshTriangles triangles use this profile instead, when it is set
+    QString largeMeshProfile;
+    int largeMeshTriangles { 50000 };
+    // override the speeds of the profiles when not negative
+    int encodeSpeed { -1 };
+    int decodeSpeed { -1 };
 };
 
 class BuildDracoMeshTask {
 public:
     using Config = BuildDracoMeshConfig;
-    using Input = baker::VaryingSet3<std::vector<hfm::Mesh>, baker::NormalsPerMesh, baker::TangentsPerMesh>;
+    using Input = baker::VaryingSet4<std::vector<hfm::Mesh>, baker::NormalsPerMesh, baker::TangentsPerMesh, baker::LODsPerMesh>;
     using Output = baker::VaryingSet3<std::vector<hifi::ByteArray>, std::vector<bool>, std::vector<std::vector<hifi::ByteArray>>>;
     using JobModel = baker::Job::ModelIO<BuildDracoMeshTask, Input, Output, Config>;
 
     void configure(const Config& config);
     void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
 
+    // encodes one mesh the way run() does, leaving the bytes empty for a mesh with no triangles
+    static hifi::ByteArray encodeMesh(const hfm::Mesh& mesh, const std::vector<glm::vec3>& normals,
+                                      const std::vector<glm::vec3>& tangents, const baker::MeshLODs& lods,
+                                      const DracoProfile& profile, std::vector<hifi::ByteArray>& materialList, bool& error);
+
 protected:
-    int _encodeSpeed { 0 };
-    int _decodeSpeed { 5 };
+    DracoProfile _profile;
+    DracoProfile _largeMeshProfile;
+    bool _hasLargeMeshProfile { false };
+    int _largeMeshTriangles { 50000 };
 };
 
 #endif // hifi_BuildDracoMeshTask_h
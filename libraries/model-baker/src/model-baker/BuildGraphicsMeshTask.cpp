@@ -13,6 +13,8 @@
 
 #include <glm/gtc/packing.hpp>
 
+#include <tbb/parallel_for.h>
+
 #include <LogHandler.h>
 #include "ModelBakerLogging.h"
 #include "ModelMath.h"
@@ -366,6 +368,38 @@ void buildGraphicsMesh(const hfm::Mesh& hfmMesh, graphics::MeshPointer& graphics
         return;
     }
 
+    // Coarser levels of detail, in their own index buffer so the full detail one is left as it was
+    if (!hfmMesh.lodErrors.isEmpty()) {
+        unsigned int totalLODIndices = 0;
+        foreach(const HFMMeshPart& part, hfmMesh.parts) {
+            foreach(const QVector<int>& lodIndices, part.lodTriangleIndices) {
+                totalLODIndices += lodIndices.size();
+            }
+        }
+
+        auto lodIndexBuffer = std::make_shared<gpu::Buffer>();
+        lodIndexBuffer->resize(totalLODIndices * sizeof(int));
+
+        int lodIndexNum = 0;
+        graphics::Mesh::LODs lods(hfmMesh.lodErrors.size());
+        for (int i = 0; i < (int)lods.size(); i++) {
+            auto& lod = lods[i];
+            lod.error = hfmMesh.lodErrors[i];
+            foreach(const HFMMeshPart& part, hfmMesh.parts) {
+                graphics::Mesh::Part lodPart(lodIndexNum, 0, 0, graphics::Mesh::TRIANGLES);
+                if (i < part.lodTriangleIndices.size() && part.lodTriangleIndices[i].size()) {
+                    const auto& lodIndices = part.lodTriangleIndices[i];
+                    lodIndexBuffer->setSubData(lodIndexNum * sizeof(int), lodIndices.size() * sizeof(int), (gpu::Byte*) lodIndices.constData());
+                    lodIndexNum += lodIndices.size();
+                    lodPart._numIndices = lodIndices.size();
+                }
+                lod.parts.push_back(lodPart);
+            }
+        }
+
+        graphicsMesh->setLODs(gpu::BufferView(lodIndexBuffer, gpu::Element(gpu::SCALAR, gpu::UINT32, gpu::XYZ)), lods);
+    }
+
     graphicsMesh->evalPartBound(0);
 
     graphicsMeshPointer = graphicsMesh;
@@ -380,9 +414,10 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
 
     auto& graphicsMeshes = output;
 
+    // the meshes of a model are independent, and its largest meshes take most of the time
     int n = (int)meshes.size();
-    for (int i = 0; i < n; i++) {
-        graphicsMeshes.emplace_back();
+    graphicsMeshes.resize(n);
+    tbb::parallel_for(0, n, [&](int i) {
         auto& graphicsMesh = graphicsMeshes[i];
         
         // Try to create the graphics::Mesh
@@ -395,5 +430,5 @@ void BuildGraphicsMeshTask::run(const baker::BakeContextPointer& context, const
                 graphicsMesh->modelName = meshIndicesToModelNames[i].toStdString();
             }
         }
-    }
+    });
 }
@@ -0,0 +1,354 @@
+//
+//  BuildMeshLODsTask.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BuildMeshLODsTask.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <queue>
+#include <set>
+
+#include <tbb/parallel_for.h>
+
+#include "ModelBakerLogging.h"
+
+namespace {
+
+    // a level that barely reduces the triangles of the previous one isn't worth its indices
+    const float MAX_LOD_TRIANGLE_RATIO = 0.8f;
+
+    // the sum of the squared distances to a set of planes, as a symmetric 4x4 matrix
+    class Quadric {
+    public:
+        Quadric() {}
+        Quadric(const glm::dvec3& normal, double distance) {
+            _a = { normal.x * normal.x, normal.x * normal.y, normal.x * normal.z, normal.x * distance,
+                   normal.y * normal.y, normal.y * normal.z, normal.y * distance,
+                   normal.z * normal.z, normal.z * distance,
+                   distance * distance };
+        }
+
+        Quadric& operator+=(const Quadric& other) {
+            for (size_t i = 0; i < _a.size(); i++) {
+                _a[i] += other._a[i];
+            }
+            return *this;
+        }
+
+        double evaluate(const glm::dvec3& p) const {
+            return _a[0] * p.x * p.x + 2.0 * _a[1] * p.x * p.y + 2.0 * _a[2] * p.x * p.z + 2.0 * _a[3] * p.x +
+                   _a[4] * p.y * p.y + 2.0 * _a[5] * p.y * p.z + 2.0 * _a[6] * p.y +
+                   _a[7] * p.z * p.z + 2.0 * _a[8] * p.z +
+                   _a[9];
+        }
+
+    private:
+        std::array<double, 10> _a {};
+    };
+
+    Quadric operator+(Quadric a, const Quadric& b) {
+        return a += b;
+    }
+
+    // Collapses the edges of a mesh into one of their vertices, cheapest first, by the quadric error metric.  The vertices
+    // on the borders of the mesh, and on its seams, where vertices share a position but not their other attributes, are
+    // never moved, so the levels don't crack or tear their texturing.
+    class MeshSimplifier {
+    public:
+        MeshSimplifier(const hfm::Mesh& mesh);
+
+        // Collapses edges until there are at most targetTriangles left, or no more can be
+        void simplify(size_t targetTriangles);
+
+        size_t getNumTriangles() const { return _numTriangles; }
+        float getError() const { return (float)_error; }
+
+        // The triangle indices of each part of the mesh as it now is
+        std::vector<QVector<int>> getTriangleIndices() const;
+
+    private:
+        struct Triangle {
+            std::array<int, 3> indices;
+            int part;
+            bool removed { false };
+        };
+
+        struct Collapse {
+            double cost;
+            int from;
+            int to;
+            bool operator<(const Collapse& other) const { return cost > other.cost; }
+        };
+
+        glm::dvec3 getNormal(const std::array<int, 3>& indices) const;
+        double evalCost(int from, int to) const { return (_quadrics[from] + _quadrics[to]).evaluate(_positions[to]); }
+        bool hasEdge(int from, int to) const;
+        bool canCollapse(int from, int to) const;
+        void collapse(int from, int to);
+        void addCollapse(int from, int to);
+
+        int _numParts { 0 };
+        std::vector<glm::dvec3> _positions;
+        std::vector<Quadric> _quadrics;
+        std::vector<bool> _locked;
+        std::vector<bool> _removed;
+        std::vector<std::vector<int>> _vertexTriangles;
+        std::vector<Triangle> _triangles;
+        size_t _numTriangles { 0 };
+        std::priority_queue<Collapse> _collapses;
+        double _error { 0.0 };
+    };
+
+    MeshSimplifier::MeshSimplifier(const hfm::Mesh& mesh) {
+        int numVertices = mesh.vertices.size();
+        _numParts = mesh.parts.size();
+        _positions.reserve(numVertices);
+        for (const auto& vertex : mesh.vertices) {
+            _positions.push_back(glm::dvec3(vertex));
+        }
+        _quadrics.resize(numVertices);
+        _locked.resize(numVertices, false);
+        _removed.resize(numVertices, false);
+        _vertexTriangles.resize(numVertices);
+
+        for (int i = 0; i < _numParts; i++) {
+            const auto& part = mesh.parts[i];
+            for (const auto* indices : { &part.quadTrianglesIndices, &part.triangleIndices }) {
+                for (int j = 0; j + 2 < indices->size(); j += 3) {
+                    Triangle triangle { { indices->at(j), indices->at(j + 1), indices->at(j + 2) }, i };
+                    bool isValid = true;
+                    for (int index : triangle.indices) {
+                        isValid = isValid && index >= 0 && index < numVertices;
+                    }
+                    isValid = isValid && triangle.indices[0] != triangle.indices[1] && triangle.indices[1] != triangle.indices[2] &&
+                        triangle.indices[2] != triangle.indices[0];
+                    if (isValid) {
+                        _triangles.push_back(triangle);
+                    }
+                }
+            }
+        }
+        _numTriangles = _triangles.size();
+
+        std::map<std::pair<int, int>, int> numEdgeTriangles;
+        for (int i = 0; i < (int)_triangles.size(); i++) {
+            const auto& indices = _triangles[i].indices;
+            glm::dvec3 normal = getNormal(indices);
+            double length = glm::length(normal);
+            if (length > 0.0) {
+                normal /= length;
+                Quadric quadric(normal, -glm::dot(normal, _positions[indices[0]]));
+                for (int index : indices) {
+                    _quadrics[index] += quadric;
+                }
+            }
+            for (int j = 0; j < 3; j++) {
+                _vertexTriangles[indices[j]].push_back(i);
+                int a = indices[j];
+                int b = indices[(j + 1) % 3];
+                numEdgeTriangles[{ std::min(a, b), std::max(a, b) }]++;
+            }
+        }
+
+        // borders, and the edges shared by more than two triangles
+        for (const auto& edge : numEdgeTriangles) {
+            if (edge.second != 2) {
+                _locked[edge.first.first] = true;
+                _locked[edge.first.second] = true;
+            }
+        }
+
+        // seams
+        std::vector<int> sortedVertices(numVertices);
+        for (int i = 0; i < numVertices; i++) {
+            sortedVertices[i] = i;
+        }
+        auto isBefore = [&](int a, int b) {
+            const auto& p = _positions[a];
+            const auto& q = _positions[b];
+            return p.x < q.x || (p.x == q.x && (p.y < q.y || (p.y == q.y && p.z < q.z)));
+        };
+        std::sort(sortedVertices.begin(), sortedVertices.end(), isBefore);
+        for (int i = 1; i < numVertices; i++) {
+            if (_positions[sortedVertices[i]] == _positions[sortedVertices[i - 1]]) {
+                _locked[sortedVertices[i]] = true;
+                _locked[sortedVertices[i - 1]] = true;
+            }
+        }
+
+        for (const auto& triangle : _triangles) {
+            for (int j = 0; j < 3; j++) {
+                addCollapse(triangle.indices[j], triangle.indices[(j + 1) % 3]);
+                addCollapse(triangle.indices[(j + 1) % 3], triangle.indices[j]);
+            }
+        }
+    }
+
+    glm::dvec3 MeshSimplifier::getNormal(const std::array<int, 3>& indices) const {
+        const auto& p0 = _positions[indices[0]];
+        return glm::cross(_positions[indices[1]] - p0, _positions[indices[2]] - p0);
+    }
+
+    void MeshSimplifier::addCollapse(int from, int to) {
+        if (!_locked[from]) {
+            _collapses.push({ evalCost(from, to), from, to });
+        }
+    }
+
+    bool MeshSimplifier::hasEdge(int from, int to) const {
+        for (int i : _vertexTriangles[from]) {
+            const auto& triangle = _triangles[i];
+            if (!triangle.removed && std::find(triangle.indices.begin(), triangle.indices.end(), to) != triangle.indices.end()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool MeshSimplifier::canCollapse(int from, int to) const {
+        // the vertices of an edge inside a manifold share exactly two neighbors, or the collapse would pinch the surface
+        std::set<int> fromNeighbors;
+        for (int i : _vertexTriangles[from]) {
+            if (!_triangles[i].removed) {
+                fromNeighbors.insert(_triangles[i].indices.begin(), _triangles[i].indices.end());
+            }
+        }
+        std::set<int> sharedNeighbors;
+        for (int i : _vertexTriangles[to]) {
+            if (!_triangles[i].removed) {
+                for (int index : _triangles[i].indices) {
+                    if (index != from && index != to && fromNeighbors.count(index)) {
+                        sharedNeighbors.insert(index);
+                    }
+                }
+            }
+        }
+        if (sharedNeighbors.size() > 2) {
+            return false;
+        }
+
+        // nor may it flip the triangles that are moved
+        for (int i : _vertexTriangles[from]) {
+            const auto& triangle = _triangles[i];
+            if (triangle.removed || std::find(triangle.indices.begin(), triangle.indices.end(), to) != triangle.indices.end()) {
+                continue;
+            }
+            auto indices = triangle.indices;
+            std::replace(indices.begin(), indices.end(), from, to);
+            if (glm::dot(getNormal(triangle.indices), getNormal(indices)) <= 0.0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void MeshSimplifier::collapse(int from, int to) {
+        auto& toTriangles = _vertexTriangles[to];
+        for (int i : _vertexTriangles[from]) {
+            auto& triangle = _triangles[i];
+            if (triangle.removed) {
+                continue;
+            }
+            if (std::find(triangle.indices.begin(), triangle.indices.end(), to) != triangle.indices.end()) {
+                triangle.removed = true;
+                _numTriangles--;
+            } else {
+                std::replace(triangle.indices.begin(), triangle.indices.end(), from, to);
+                toTriangles.push_back(i);
+            }
+        }
+        _vertexTriangles[from].clear();
+        _removed[from] = true;
+        _quadrics[to] += _quadrics[from];
+
+        toTriangles.erase(std::remove_if(toTriangles.begin(), toTriangles.end(), [&](int i) { return _triangles[i].removed; }),
+                          toTriangles.end());
+        for (int i : toTriangles) {
+            for (int index : _triangles[i].indices) {
+                if (index != to) {
+                    addCollapse(index, to);
+                    addCollapse(to, index);
+                }
+            }
+        }
+    }
+
+    void MeshSimplifier::simplify(size_t targetTriangles) {
+        while (_numTriangles > targetTriangles && !_collapses.empty()) {
+            Collapse candidate = _collapses.top();
+            _collapses.pop();
+            if (_removed[candidate.from] || _removed[candidate.to] || !hasEdge(candidate.from, candidate.to)) {
+                continue;
+            }
+
+            // the costs are recomputed lazily, as the quadrics of the vertices around the collapses grow
+            double cost = evalCost(candidate.from, candidate.to);
+            if (cost > candidate.cost) {
+                _collapses.push({ cost, candidate.from, candidate.to });
+                continue;
+            }
+            if (!canCollapse(candidate.from, candidate.to)) {
+                continue;
+            }
+
+            collapse(candidate.from, candidate.to);
+            _error = std::max(_error, sqrt(std::max(cost, 0.0)));
+        }
+    }
+
+    std::vector<QVector<int>> MeshSimplifier::getTriangleIndices() const {
+        std::vector<QVector<int>> triangleIndices(_numParts);
+        for (const auto& triangle : _triangles) {
+            if (!triangle.removed) {
+                auto& indices = triangleIndices[triangle.part];
+                indices << triangle.indices[0] << triangle.indices[1] << triangle.indices[2];
+            }
+        }
+        return triangleIndices;
+    }
+
+}
+
+void BuildMeshLODsTask::configure(const Config& config) {
+    _maxLODs = config.maxLODs;
+    _minTriangles = config.minTriangles;
+    _triangleRatio = config.triangleRatio;
+}
+
+void BuildMeshLODsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
+    const auto& meshes = input;
+    auto& lodsPerMesh = output;
+
+    lodsPerMesh.resize(meshes.size());
+    tbb::parallel_for((size_t)0, meshes.size(), [&](size_t i) {
+        MeshSimplifier simplifier(meshes[i]);
+        size_t numTriangles = simplifier.getNumTriangles();
+        if (numTriangles < (size_t)_minTriangles) {
+            return;
+        }
+
+        auto& lods = lodsPerMesh[i];
+        for (int j = 0; j < _maxLODs; j++) {
+            simplifier.simplify((size_t)(numTriangles * _triangleRatio));
+            if (simplifier.getNumTriangles() > numTriangles * MAX_LOD_TRIANGLE_RATIO) {
+                break;
+            }
+            numTriangles = simplifier.getNumTriangles();
+            lods.triangleIndices.push_back(simplifier.getTriangleIndices());
+            lods.errors.push_back(simplifier.getError());
+        }
+
+        if (!lods.errors.empty()) {
+            qCDebug(model_baker) << "Built" << lods.errors.size() << "levels of detail for mesh" << i << "down to" << numTriangles << "triangles";
+        }
+    });
+}
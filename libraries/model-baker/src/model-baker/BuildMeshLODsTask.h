@@ -0,0 +1,52 @@
+//
+//  BuildMeshLODsTask.h
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BuildMeshLODsTask_h
+#define hifi_BuildMeshLODsTask_h
+
+#include <hfm/HFM.h>
+
+#include "Engine.h"
+#include "BakerTypes.h"
+
+// BuildMeshLODsTask is disabled by default
+class BuildMeshLODsConfig : public baker::JobConfig {
+    Q_OBJECT
+    Q_PROPERTY(int maxLODs MEMBER maxLODs)
+    Q_PROPERTY(int minTriangles MEMBER minTriangles)
+    Q_PROPERTY(float triangleRatio MEMBER triangleRatio)
+public:
+    BuildMeshLODsConfig() : baker::JobConfig(false) {}
+
+    int maxLODs { 3 };
+    int minTriangles { 1024 };
+    float triangleRatio { 0.5f };
+};
+
+// Simplifies the meshes into a chain of coarser levels of detail, by collapsing their edges into their vertices.  The
+// levels keep the vertices of the mesh, so they are index lists of its parts, and its skinning and blendshapes still apply.
+class BuildMeshLODsTask {
+public:
+    using Config = BuildMeshLODsConfig;
+    using Input = std::vector<hfm::Mesh>;
+    using Output = baker::LODsPerMesh;
+    using JobModel = baker::Job::ModelIO<BuildMeshLODsTask, Input, Output, Config>;
+
+    void configure(const Config& config);
+    void run(const baker::BakeContextPointer& context, const Input& input, Output& output);
+
+protected:
+    int _maxLODs { 3 };
+    int _minTriangles { 1024 };
+    float _triangleRatio { 0.5f };
+};
+
+#endif // hifi_BuildMeshLODsTask_h
@@ -13,6 +13,8 @@
 
 #include <set>
 
+#include <tbb/parallel_for.h>
+
 #include "ModelMath.h"
 
 void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& context, const Input& input, Output& output) {
@@ -21,30 +23,29 @@ void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& conte
     const auto& meshes = input.get2();
     auto& tangentsPerBlendshapePerMeshOut = output;
 
-    tangentsPerBlendshapePerMeshOut.reserve(normalsPerBlendshapePerMesh.size());
-    for (size_t i = 0; i < blendshapesPerMesh.size(); i++) {
+    tangentsPerBlendshapePerMeshOut.resize(blendshapesPerMesh.size());
+    tbb::parallel_for((size_t)0, blendshapesPerMesh.size(), [&](size_t i) {
         const auto& normalsPerBlendshape = baker::safeGet(normalsPerBlendshapePerMesh, i);
         const auto& blendshapes = blendshapesPerMesh[i];
         const auto& mesh = meshes[i];
-        tangentsPerBlendshapePerMeshOut.emplace_back();
-        auto& tangentsPerBlendshapeOut = tangentsPerBlendshapePerMeshOut[tangentsPerBlendshapePerMeshOut.size()-1];
+        auto& tangentsPerBlendshapeOut = tangentsPerBlendshapePerMeshOut[i];
 
-        for (size_t j = 0; j < blendshapes.size(); j++) {
+        tangentsPerBlendshapeOut.resize(blendshapes.size());
+        tbb::parallel_for((size_t)0, blendshapes.size(), [&](size_t j) {
             const auto& blendshape = blendshapes[j];
             const auto& tangentsIn = blendshape.tangents;
             const auto& normals = baker::safeGet(normalsPerBlendshape, j);
-            tangentsPerBlendshapeOut.emplace_back();
-            auto& tangentsOut = tangentsPerBlendshapeOut[tangentsPerBlendshapeOut.size()-1];
+            auto& tangentsOut = tangentsPerBlendshapeOut[j];
 
             // Check if we already have tangents
             if (!tangentsIn.empty()) {
                 tangentsOut = std::vector<glm::vec3>(tangentsIn.begin(), tangentsIn.end());
-                continue;
+                return;
             }
 
             // Check if we can calculate tangents (we need normals and texcoords to calculate the tangents)
             if (normals.empty() || normals.size() != (size_t)mesh.texCoords.size()) {
-                continue;
+                return;
             }
             tangentsOut.resize(normals.size());
 
@@ -79,6 +80,6 @@ void CalculateBlendshapeTangentsTask::run(const baker::BakeContextPointer& conte
                     return (glm::vec3*)nullptr;
                 }
             });
-        }
-    }
+        });
+    });
 }
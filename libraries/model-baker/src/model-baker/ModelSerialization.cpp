@@ -0,0 +1,562 @@
+//
+//  ModelSerialization.cpp
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelSerialization.h"
+
+#include <QtCore/QDataStream>
+
+namespace baker {
+
+const uint32_t MODEL_SERIALIZATION_VERSION = 1;
+
+namespace {
+
+const uint32_t MODEL_SERIALIZATION_MAGIC = 0x424d4648; // "HFMB"
+
+// The data is only ever read back on the machine that wrote it, so values are written as they are held in memory
+class ModelWriter {
+public:
+    ModelWriter(hifi::ByteArray& data) : _stream(&data, QIODevice::WriteOnly) {
+        _stream.setVersion(QDataStream::Qt_5_9);
+    }
+
+    template <typename T>
+    void write(const T& value) {
+        _stream.writeRawData(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void write(const QString& string) { _stream << string; }
+    void write(const QByteArray& bytes) { _stream << bytes; }
+    void write(bool value) { write((uint8_t)value); }
+
+    template <typename T>
+    void writeValues(const QVector<T>& values) {
+        write((int32_t)values.size());
+        _stream.writeRawData(reinterpret_cast<const char*>(values.constData()), values.size() * (int)sizeof(T));
+    }
+
+    void write(const Extents& extents) {
+        write(extents.minimum);
+        write(extents.maximum);
+    }
+
+    void write(const Transform& transform) {
+        write(transform.getTranslation());
+        write(transform.getRotation());
+        write(transform.getScale());
+    }
+
+    void write(const hfm::Joint& joint) {
+        write(joint.parentIndex);
+        write(joint.distanceToParent);
+        write(joint.translation);
+        write(joint.preTransform);
+        write(joint.preRotation);
+        write(joint.rotation);
+        write(joint.postRotation);
+        write(joint.postTransform);
+        write(joint.transform);
+        write(joint.rotationMin);
+        write(joint.rotationMax);
+        write(joint.inverseDefaultRotation);
+        write(joint.inverseBindRotation);
+        write(joint.bindTransform);
+        write(joint.name);
+        write(joint.isSkeletonJoint);
+        write(joint.bindTransformFoundInCluster);
+        write(joint.hasGeometricOffset);
+        write(joint.geometricTranslation);
+        write(joint.geometricRotation);
+        write(joint.geometricScaling);
+    }
+
+    void write(const hfm::Cluster& cluster) {
+        write(cluster.jointIndex);
+        write(cluster.inverseBindMatrix);
+        write(cluster.inverseBindTransform);
+    }
+
+    void write(const hfm::Blendshape& blendshape) {
+        writeValues(blendshape.indices);
+        writeValues(blendshape.vertices);
+        writeValues(blendshape.normals);
+        writeValues(blendshape.tangents);
+    }
+
+    void write(const hfm::MeshPart& part) {
+        writeValues(part.quadIndices);
+        writeValues(part.quadTrianglesIndices);
+        writeValues(part.triangleIndices);
+        write(part.materialID);
+    }
+
+    void write(const hfm::Mesh& mesh) {
+        writeList(mesh.parts);
+        writeValues(mesh.vertices);
+        writeValues(mesh.normals);
+        writeValues(mesh.tangents);
+        writeValues(mesh.colors);
+        writeValues(mesh.texCoords);
+        writeValues(mesh.texCoords1);
+        writeValues(mesh.clusterIndices);
+        writeValues(mesh.clusterWeights);
+        writeValues(mesh.originalIndices);
+        writeList(mesh.clusters);
+        write(mesh.meshExtents);
+        write(mesh.modelTransform);
+        writeList(mesh.blendshapes);
+        write(mesh.meshIndex);
+        write(mesh.wasCompressed);
+    }
+
+    void write(const hfm::Texture& texture) {
+        write(texture.id);
+        write(texture.name);
+        write(texture.filename);
+        write(texture.content);
+        write(texture.sourceChannel);
+        write(texture.transform);
+        write(texture.maxNumPixels);
+        write(texture.texcoordSet);
+        write(texture.texcoordSetName);
+        write(texture.isBumpmap);
+    }
+
+    void write(const graphics::Material& material) {
+        write((uint32_t)material.getKey()._flags.to_ulong());
+        write(material.getEmissive(false));
+        write(material.getOpacity());
+        write(material.getAlbedo(false));
+        write(material.getRoughness());
+        write(material.getMetallic());
+        write(material.getScattering());
+        write(material.getOpacityCutoff());
+        write(material.getCullFaceMode());
+    }
+
+    void write(const hfm::Material& material) {
+        write(material.diffuseColor);
+        write(material.diffuseFactor);
+        write(material.specularColor);
+        write(material.specularFactor);
+        write(material.emissiveColor);
+        write(material.emissiveFactor);
+        write(material.shininess);
+        write(material.opacity);
+        write(material.metallic);
+        write(material.roughness);
+        write(material.emissiveIntensity);
+        write(material.ambientFactor);
+        write(material.bumpMultiplier);
+        write(material.alphaMode);
+        write(material.alphaCutoff);
+        write(material.materialID);
+        write(material.name);
+        write(material.shadingModel);
+
+        write((bool)material._material);
+        if (material._material) {
+            write(*material._material);
+        }
+
+        write(material.normalTexture);
+        write(material.albedoTexture);
+        write(material.opacityTexture);
+        write(material.glossTexture);
+        write(material.roughnessTexture);
+        write(material.specularTexture);
+        write(material.metallicTexture);
+        write(material.emissiveTexture);
+        write(material.occlusionTexture);
+        write(material.scatteringTexture);
+        write(material.lightmapTexture);
+        write(material.lightmapParams);
+
+        write(material.isPBSMaterial);
+        write(material.useNormalMap);
+        write(material.useAlbedoMap);
+        write(material.useOpacityMap);
+        write(material.useRoughnessMap);
+        write(material.useSpecularMap);
+        write(material.useMetallicMap);
+        write(material.useEmissiveMap);
+        write(material.useOcclusionMap);
+    }
+
+    void write(const hfm::AnimationFrame& frame) {
+        writeValues(frame.rotations);
+        writeValues(frame.translations);
+    }
+
+    template <typename List>
+    void writeList(const List& list) {
+        write((int32_t)list.size());
+        for (const auto& element : list) {
+            write(element);
+        }
+    }
+
+    template <typename Hash>
+    void writeHash(const Hash& hash) {
+        write((int32_t)hash.size());
+        for (auto it = hash.cbegin(); it != hash.cend(); ++it) {
+            write(it.key());
+            write(it.value());
+        }
+    }
+
+    void write(const hfm::Model& model) {
+        write(model.originalURL);
+        write(model.author);
+        write(model.applicationName);
+        writeList(model.joints);
+        writeHash(model.jointIndices);
+        write(model.hasSkeletonJoints);
+        writeList(model.meshes);
+        writeList(model.scripts);
+        writeHash(model.materials);
+        write(model.offset);
+        write(model.neckPivot);
+        write(model.bindExtents);
+        write(model.meshExtents);
+        writeList(model.animationFrames);
+        writeHash(model.meshIndicesToModelNames);
+        writeList(model.blendshapeChannelNames);
+    }
+
+private:
+    QDataStream _stream;
+};
+
+class ModelReader {
+public:
+    ModelReader(const hifi::ByteArray& data) : _stream(data) {
+        _stream.setVersion(QDataStream::Qt_5_9);
+    }
+
+    bool isValid() const { return _stream.status() == QDataStream::Ok; }
+    bool atEnd() const { return _stream.atEnd(); }
+
+    template <typename T>
+    void read(T& value) {
+        if (_stream.readRawData(reinterpret_cast<char*>(&value), sizeof(T)) != (int)sizeof(T)) {
+            _stream.setStatus(QDataStream::ReadPastEnd);
+        }
+    }
+
+    void read(QString& string) { _stream >> string; }
+    void read(QByteArray& bytes) { _stream >> bytes; }
+
+    void read(bool& value) {
+        uint8_t byte { 0 };
+        read(byte);
+        value = (byte != 0);
+    }
+
+    template <typename T>
+    void readValues(QVector<T>& values) {
+        int size = readSize(sizeof(T));
+        values.resize(size);
+        if (size > 0) {
+            _stream.readRawData(reinterpret_cast<char*>(values.data()), size * (int)sizeof(T));
+        }
+    }
+
+    void read(Extents& extents) {
+        read(extents.minimum);
+        read(extents.maximum);
+    }
+
+    void read(Transform& transform) {
+        glm::vec3 translation;
+        glm::quat rotation;
+        glm::vec3 scale;
+        read(translation);
+        read(rotation);
+        read(scale);
+        transform.setTranslation(translation);
+        transform.setRotation(rotation);
+        transform.setScale(scale);
+    }
+
+    void read(hfm::Joint& joint) {
+        read(joint.parentIndex);
+        read(joint.distanceToParent);
+        read(joint.translation);
+        read(joint.preTransform);
+        read(joint.preRotation);
+        read(joint.rotation);
+        read(joint.postRotation);
+        read(joint.postTransform);
+        read(joint.transform);
+        read(joint.rotationMin);
+        read(joint.rotationMax);
+        read(joint.inverseDefaultRotation);
+        read(joint.inverseBindRotation);
+        read(joint.bindTransform);
+        read(joint.name);
+        read(joint.isSkeletonJoint);
+        read(joint.bindTransformFoundInCluster);
+        read(joint.hasGeometricOffset);
+        read(joint.geometricTranslation);
+        read(joint.geometricRotation);
+        read(joint.geometricScaling);
+    }
+
+    void read(hfm::Cluster& cluster) {
+        read(cluster.jointIndex);
+        read(cluster.inverseBindMatrix);
+        read(cluster.inverseBindTransform);
+    }
+
+    void read(hfm::Blendshape& blendshape) {
+        readValues(blendshape.indices);
+        readValues(blendshape.vertices);
+        readValues(blendshape.normals);
+        readValues(blendshape.tangents);
+    }
+
+    void read(hfm::MeshPart& part) {
+        readValues(part.quadIndices);
+        readValues(part.quadTrianglesIndices);
+        readValues(part.triangleIndices);
+        read(part.materialID);
+    }
+
+    void read(hfm::Mesh& mesh) {
+        readList(mesh.parts);
+        readValues(mesh.vertices);
+        readValues(mesh.normals);
+        readValues(mesh.tangents);
+        readValues(mesh.colors);
+        readValues(mesh.texCoords);
+        readValues(mesh.texCoords1);
+        readValues(mesh.clusterIndices);
+        readValues(mesh.clusterWeights);
+        readValues(mesh.originalIndices);
+        readList(mesh.clusters);
+        read(mesh.meshExtents);
+        read(mesh.modelTransform);
+        readList(mesh.blendshapes);
+        read(mesh.meshIndex);
+        read(mesh.wasCompressed);
+    }
+
+    void read(hfm::Texture& texture) {
+        read(texture.id);
+        read(texture.name);
+        read(texture.filename);
+        read(texture.content);
+        read(texture.sourceChannel);
+        read(texture.transform);
+        read(texture.maxNumPixels);
+        read(texture.texcoordSet);
+        read(texture.texcoordSetName);
+        read(texture.isBumpmap);
+    }
+
+    // The key can't be set directly, so the setters that produced it are called again. Each sets its flag from the
+    // value it's given, so a setter is only skipped when its value was never set.
+    void read(graphics::Material& material) {
+        uint32_t flags { 0 };
+        glm::vec3 emissive;
+        float opacity;
+        glm::vec3 albedo;
+        float roughness;
+        float metallic;
+        float scattering;
+        float opacityCutoff;
+        graphics::MaterialKey::CullFaceMode cullFaceMode;
+        read(flags);
+        read(emissive);
+        read(opacity);
+        read(albedo);
+        read(roughness);
+        read(metallic);
+        read(scattering);
+        read(opacityCutoff);
+        read(cullFaceMode);
+
+        graphics::MaterialKey key { graphics::MaterialKey::Flags(flags) };
+        if (key.isEmissive() || emissive != glm::vec3(graphics::Material::DEFAULT_EMISSIVE)) {
+            material.setEmissive(emissive, false);
+        }
+        if (key.isTranslucentFactor() || opacity != graphics::Material::DEFAULT_OPACITY) {
+            material.setOpacity(opacity);
+        }
+        if (key.isAlbedo()) {
+            material.setAlbedo(albedo, false);
+        }
+        if (key.isGlossy() || roughness != graphics::Material::DEFAULT_ROUGHNESS) {
+            material.setRoughness(roughness);
+        }
+        if (key.isMetallic() || metallic != graphics::Material::DEFAULT_METALLIC) {
+            material.setMetallic(metallic);
+        }
+        if (key.isScattering() || scattering != graphics::Material::DEFAULT_SCATTERING) {
+            material.setScattering(scattering);
+        }
+        if (key.isOpacityCutoff()) {
+            material.setOpacityCutoff(opacityCutoff);
+        }
+        if (key.isOpacityMapMode()) {
+            material.setOpacityMapMode(key.getOpacityMapMode());
+        }
+        material.setUnlit(key.isUnlit());
+        material.setCullFaceMode(cullFaceMode);
+    }
+
+    void read(hfm::Material& material) {
+        read(material.diffuseColor);
+        read(material.diffuseFactor);
+        read(material.specularColor);
+        read(material.specularFactor);
+        read(material.emissiveColor);
+        read(material.emissiveFactor);
+        read(material.shininess);
+        read(material.opacity);
+        read(material.metallic);
+        read(material.roughness);
+        read(material.emissiveIntensity);
+        read(material.ambientFactor);
+        read(material.bumpMultiplier);
+        read(material.alphaMode);
+        read(material.alphaCutoff);
+        read(material.materialID);
+        read(material.name);
+        read(material.shadingModel);
+
+        bool hasMaterial { false };
+        read(hasMaterial);
+        if (hasMaterial) {
+            material._material = std::make_shared<graphics::Material>();
+            read(*material._material);
+        }
+
+        read(material.normalTexture);
+        read(material.albedoTexture);
+        read(material.opacityTexture);
+        read(material.glossTexture);
+        read(material.roughnessTexture);
+        read(material.specularTexture);
+        read(material.metallicTexture);
+        read(material.emissiveTexture);
+        read(material.occlusionTexture);
+        read(material.scatteringTexture);
+        read(material.lightmapTexture);
+        read(material.lightmapParams);
+
+        read(material.isPBSMaterial);
+        read(material.useNormalMap);
+        read(material.useAlbedoMap);
+        read(material.useOpacityMap);
+        read(material.useRoughnessMap);
+        read(material.useSpecularMap);
+        read(material.useMetallicMap);
+        read(material.useEmissiveMap);
+        read(material.useOcclusionMap);
+    }
+
+    void read(hfm::AnimationFrame& frame) {
+        readValues(frame.rotations);
+        readValues(frame.translations);
+    }
+
+    template <typename List>
+    void readList(List& list) {
+        int size = readSize(1);
+        list.clear();
+        list.reserve(size);
+        for (int i = 0; i < size && isValid(); i++) {
+            typename List::value_type element;
+            read(element);
+            list.push_back(element);
+        }
+    }
+
+    template <typename Hash>
+    void readHash(Hash& hash) {
+        int size = readSize(1);
+        hash.clear();
+        hash.reserve(size);
+        for (int i = 0; i < size && isValid(); i++) {
+            typename Hash::key_type key;
+            typename Hash::mapped_type value;
+            read(key);
+            read(value);
+            hash.insert(key, value);
+        }
+    }
+
+    void read(hfm::Model& model) {
+        read(model.originalURL);
+        read(model.author);
+        read(model.applicationName);
+        readList(model.joints);
+        readHash(model.jointIndices);
+        read(model.hasSkeletonJoints);
+        readList(model.meshes);
+        readList(model.scripts);
+        readHash(model.materials);
+        read(model.offset);
+        read(model.neckPivot);
+        read(model.bindExtents);
+        read(model.meshExtents);
+        readList(model.animationFrames);
+        readHash(model.meshIndicesToModelNames);
+        readList(model.blendshapeChannelNames);
+    }
+
+private:
+    // reads the size of a list, which can't be more elements than there are bytes left to hold them
+    int readSize(size_t minElementSize) {
+        int32_t size { 0 };
+        read(size);
+        if (size < 0 || (qint64)size * (qint64)minElementSize > _stream.device()->bytesAvailable()) {
+            _stream.setStatus(QDataStream::ReadCorruptData);
+            return 0;
+        }
+        return isValid() ? size : 0;
+    }
+
+    QDataStream _stream;
+};
+
+}
+
+hifi::ByteArray serializeModel(const hfm::Model& model) {
+    hifi::ByteArray data;
+    ModelWriter writer(data);
+    writer.write(MODEL_SERIALIZATION_MAGIC);
+    writer.write(MODEL_SERIALIZATION_VERSION);
+    writer.write(model);
+    return data;
+}
+
+hfm::Model::Pointer deserializeModel(const hifi::ByteArray& data) {
+    ModelReader reader(data);
+    uint32_t magic { 0 };
+    uint32_t version { 0 };
+    reader.read(magic);
+    reader.read(version);
+    if (!reader.isValid() || magic != MODEL_SERIALIZATION_MAGIC || version != MODEL_SERIALIZATION_VERSION) {
+        return nullptr;
+    }
+
+    auto model = std::make_shared<hfm::Model>();
+    reader.read(*model);
+    if (!reader.isValid() || !reader.atEnd()) {
+        return nullptr;
+    }
+    return model;
+}
+
+};
@@ -0,0 +1,33 @@
+//
+//  ModelSerialization.h
+//  model-baker/src/model-baker
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_baker_ModelSerialization_h
+#define hifi_baker_ModelSerialization_h
+
+#include <hfm/HFM.h>
+
+#include <shared/HifiTypes.h>
+
+namespace baker {
+    // Whenever a change is made to the serialized format, or to hfm::Model, that isn't backward compatible,
+    // this value should be incremented. Data written with any other version is not read.
+    extern const uint32_t MODEL_SERIALIZATION_VERSION;
+
+    // Writes a model as a serializer returns it, along with the normals and tangents of its meshes and blendshapes, so
+    // that reading it back gives a model the baker only has to build graphics meshes for. What the baker derives from
+    // the mapping (the prepared joints, flow data, kdops and levels of detail) and the graphics meshes are not written.
+    hifi::ByteArray serializeModel(const hfm::Model& model);
+
+    // Returns nullptr if the data is not a model written with this version
+    hfm::Model::Pointer deserializeModel(const hifi::ByteArray& data);
+};
+
+#endif // hifi_baker_ModelSerialization_h
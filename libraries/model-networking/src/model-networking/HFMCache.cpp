@@ -0,0 +1,73 @@
+//
+//  HFMCache.cpp
+//  libraries/model-networking/src/model-networking
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HFMCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+
+#include <SettingHandle.h>
+#include <model-baker/ModelSerialization.h>
+
+#include "ModelNetworkingLogging.h"
+
+const char* HFMCache::SETTING_VERSION_NAME = "hifi.hfm.cache_version";
+
+HFMCache::HFMCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+void HFMCache::initialize() {
+    FileCache::initialize();
+    // models written with another version can't be read, so they'd only be taking up space
+    Setting::Handle<int> cacheVersionHandle(SETTING_VERSION_NAME, 0);
+    auto cacheVersion = cacheVersionHandle.get();
+    if (cacheVersion != (int)baker::MODEL_SERIALIZATION_VERSION) {
+        wipe();
+        cacheVersionHandle.set((int)baker::MODEL_SERIALIZATION_VERSION);
+    }
+}
+
+HFMCache::Key HFMCache::getKey(const QByteArray& data, const QUrl& url, const QMultiHash<QString, QVariant>& serializerMapping) {
+    // QJsonDocument orders the keys, so the same mapping always hashes the same
+    QVariantMap mapping;
+    for (const auto& key : serializerMapping.uniqueKeys()) {
+        mapping.insert(key, serializerMapping.values(key));
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(data);
+    // the url is part of the key as serializers resolve the files a model refers to, such as textures, against it
+    hash.addData(url.toEncoded());
+    hash.addData(QJsonDocument::fromVariant(mapping).toJson(QJsonDocument::Compact));
+    return hash.result().toHex().toStdString();
+}
+
+HFMModel::Pointer HFMCache::readModel(const Key& key) {
+    auto file = getFile(key);
+    if (!file) {
+        return nullptr;
+    }
+
+    QFile modelFile(QString::fromStdString(file->getFilepath()));
+    if (!modelFile.open(QIODevice::ReadOnly)) {
+        return nullptr;
+    }
+    return baker::deserializeModel(modelFile.readAll());
+}
+
+void HFMCache::writeModel(const Key& key, const HFMModel& model) {
+    auto data = baker::serializeModel(model);
+    // overwrites anything under the key that couldn't be read
+    if (!writeFile(data.constData(), Metadata(key, data.size()), true)) {
+        qCWarning(modelnetworking) << "Failed to write the cached model" << key.c_str();
+    }
+}
@@ -0,0 +1,41 @@
+//
+//  HFMCache.h
+//  libraries/model-networking/src/model-networking
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HFMCache_h
+#define hifi_HFMCache_h
+
+#include <QtCore/QUrl>
+#include <QtCore/QVariant>
+
+#include <shared/FileCache.h>
+#include <hfm/HFM.h>
+
+// Keeps the models parsed from FBX, OBJ and glTF files on disk, along with their computed normals and tangents, so
+// that loading the same file again skips parsing it and calculating them. See baker::serializeModel.
+class HFMCache : public cache::FileCache {
+    Q_OBJECT
+
+public:
+    static const char* SETTING_VERSION_NAME;
+
+    HFMCache(const std::string& dir, const std::string& ext);
+
+    void initialize() override;
+
+    // identifies the model parsed from the data at the url with the serializer mapping
+    static Key getKey(const QByteArray& data, const QUrl& url, const QMultiHash<QString, QVariant>& serializerMapping);
+
+    // returns nullptr if the model isn't cached, or was cached by another version
+    HFMModel::Pointer readModel(const Key& key);
+    void writeModel(const Key& key, const HFMModel& model);
+};
+
+#endif // hifi_HFMCache_h
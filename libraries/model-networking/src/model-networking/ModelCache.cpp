@@ -20,6 +20,7 @@
 
 #include <Gzip.h>
 
+#include "HFMCache.h"
 #include "ModelNetworkingLogging.h"
 #include <Trace.h>
 #include <StatTracker.h>
@@ -85,11 +86,27 @@ namespace std {
     };
 }
 
+// Copies the normals and tangents the baker calculated for a model's meshes and blendshapes to the model it was given
+static void copyNormalsAndTangents(const HFMModel& bakedModel, HFMModel& parsedModel) {
+    for (int i = 0; i < parsedModel.meshes.size() && i < bakedModel.meshes.size(); i++) {
+        auto& mesh = parsedModel.meshes[i];
+        const auto& bakedMesh = bakedModel.meshes[i];
+        mesh.normals = bakedMesh.normals;
+        mesh.tangents = bakedMesh.tangents;
+        for (int j = 0; j < mesh.blendshapes.size() && j < bakedMesh.blendshapes.size(); j++) {
+            mesh.blendshapes[j].normals = bakedMesh.blendshapes[j].normals;
+            mesh.blendshapes[j].tangents = bakedMesh.blendshapes[j].tangents;
+        }
+    }
+}
+
 class GeometryReader : public QRunnable {
 public:
-    GeometryReader(const ModelLoader& modelLoader, QWeakPointer<Resource>& resource, const QUrl& url, const GeometryMappingPair& mapping,
-                   const QByteArray& data, bool combineParts, const QString& webMediaType) :
-        _modelLoader(modelLoader), _resource(resource), _url(url), _mapping(mapping), _data(data), _combineParts(combineParts), _webMediaType(webMediaType) {
+    GeometryReader(const ModelLoader& modelLoader, const std::shared_ptr<HFMCache>& hfmCache, QWeakPointer<Resource>& resource,
+                   const QUrl& url, const GeometryMappingPair& mapping, const QByteArray& data, bool combineParts,
+                   const QString& webMediaType) :
+        _modelLoader(modelLoader), _hfmCache(hfmCache), _resource(resource), _url(url), _mapping(mapping), _data(data),
+        _combineParts(combineParts), _webMediaType(webMediaType) {
 
         DependencyManager::get<StatTracker>()->incrementStat("PendingProcessing");
     }
@@ -98,6 +115,7 @@ public:
 
 private:
     ModelLoader _modelLoader;
+    std::shared_ptr<HFMCache> _hfmCache;
     QWeakPointer<Resource> _resource;
     QUrl _url;
     GeometryMappingPair _mapping;
@@ -139,12 +157,18 @@ void GeometryReader::run() {
             throw QString("url is invalid");
         }
 
-        HFMModel::Pointer hfmModel;
         QMultiHash<QString, QVariant> serializerMapping = _mapping.second;
         serializerMapping.replace("combineParts",_combineParts);
         serializerMapping.replace("deduplicateIndices", true);
 
-        if (_url.path().toLower().endsWith(".gz")) {
+        // A cached model already has its normals and tangents, so the baker only has to build its graphics meshes
+        auto cacheKey = HFMCache::getKey(_data, _url, serializerMapping);
+        HFMModel::Pointer hfmModel = _hfmCache->readModel(cacheKey);
+        bool wasCached = (bool)hfmModel;
+
+        if (wasCached) {
+            qCDebug(modelnetworking) << "Read cached model for" << _url;
+        } else if (_url.path().toLower().endsWith(".gz")) {
             QByteArray uncompressedData;
             if (!gunzip(_data, uncompressedData)) {
                 throw QString("failed to decompress .gz model");
@@ -166,6 +190,9 @@ void GeometryReader::run() {
             throw QString("empty geometry, possibly due to an unsupported model version");
         }
 
+        // the model as it was parsed, to be cached along with the normals and tangents the baker calculates for it
+        HFMModel::Pointer parsedHFMModel = wasCached ? nullptr : std::make_shared<HFMModel>(*hfmModel);
+
         // Add scripts to hfmModel
         if (!serializerMapping.value(SCRIPT_FIELD).isNull()) {
             QVariantList scripts = serializerMapping.values(SCRIPT_FIELD);
@@ -183,6 +210,11 @@ void GeometryReader::run() {
 
         QMetaObject::invokeMethod(resource.data(), "setGeometryDefinition",
                 Q_ARG(HFMModel::Pointer, processedHFMModel), Q_ARG(MaterialMapping, materialMapping));
+
+        if (parsedHFMModel) {
+            copyNormalsAndTangents(*processedHFMModel, *parsedHFMModel);
+            _hfmCache->writeModel(cacheKey, *parsedHFMModel);
+        }
     } catch (const std::exception&) {
         auto resource = _resource.toStrongRef();
         if (resource) {
@@ -287,7 +319,9 @@ void GeometryResource::downloadFinished(const QByteArray& data) {
             _url = _effectiveBaseURL;
             _textureBaseURL = _effectiveBaseURL;
         }
-        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, _self, _effectiveBaseURL, _mappingPair, data, _combineParts, _request->getWebMediaType()));
+        auto hfmCache = DependencyManager::get<ModelCache>()->_hfmCache;
+        QThreadPool::globalInstance()->start(new GeometryReader(_modelLoader, hfmCache, _self, _effectiveBaseURL, _mappingPair, data,
+                                                                _combineParts, _request->getWebMediaType()));
     }
 }
 
@@ -365,10 +399,16 @@ void GeometryResource::resetTextures() {
     _materials.clear();
 }
 
-ModelCache::ModelCache() {
+const std::string ModelCache::HFM_DIRNAME { "hfm_cache" };
+const std::string ModelCache::HFM_EXT { "hfm" };
+
+ModelCache::ModelCache() :
+    _hfmCache(std::make_shared<HFMCache>(HFM_DIRNAME, HFM_EXT))
+{
     const qint64 GEOMETRY_DEFAULT_UNUSED_MAX_SIZE = DEFAULT_UNUSED_MAX_SIZE;
     setUnusedResourceCacheSize(GEOMETRY_DEFAULT_UNUSED_MAX_SIZE);
     setObjectName("ModelCache");
+    _hfmCache->initializeInBackground();
 
     auto modelFormatRegistry = DependencyManager::get<ModelFormatRegistry>();
     modelFormatRegistry->addFormat(FBXSerializer());
@@ -410,6 +450,12 @@ GeometryResource::Pointer ModelCache::getCollisionGeometryResource(const QUrl& u
     return resource;
 }
 
+GeometryResource::Pointer ModelCache::getSpeculativeGeometryResource(const QUrl& url) {
+    bool combineParts = true;
+    GeometryExtra geometryExtra = { GeometryMappingPair(QUrl(), QVariantHash()), QUrl(), combineParts };
+    return getSpeculativeResource(url, &geometryExtra, std::hash<GeometryExtra>()(geometryExtra)).staticCast<GeometryResource>();
+}
+
 const QVariantMap Geometry::getTextures() const {
     QVariantMap textures;
     for (const auto& material : _materials) {
@@ -25,6 +25,7 @@
 #include "ModelLoader.h"
 
 class MeshPart;
+class HFMCache;
 
 using GeometryMappingPair = std::pair<QUrl, QVariantHash>;
 Q_DECLARE_METATYPE(GeometryMappingPair)
@@ -170,6 +171,9 @@ public:
                                                                  GeometryMappingPair(QUrl(), QVariantHash()),
                                                            const QUrl& textureBaseUrl = QUrl());
 
+    /// Loads a model predicted to be needed soon through getGeometryResource, see ResourceCache::getSpeculativeResource.
+    GeometryResource::Pointer getSpeculativeGeometryResource(const QUrl& url);
+
 protected:
     friend class GeometryResource;
 
@@ -180,6 +184,10 @@ private:
     ModelCache();
     virtual ~ModelCache() = default;
     ModelLoader _modelLoader;
+
+    static const std::string HFM_DIRNAME;
+    static const std::string HFM_EXT;
+    std::shared_ptr<HFMCache> _hfmCache;
 };
 
 class MeshPart {
@@ -17,6 +17,8 @@
 #include <glm/gtx/quaternion.hpp>
 #include <glm/gtx/transform.hpp>
 
+#include <tbb/parallel_for.h>
+
 #include <BlendshapeConstants.h>
 
 #include <hfm/ModelFormatLogging.h>
@@ -510,10 +512,17 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                 }
             }
         } else if (child.name == "Objects") {
+            // the meshes are extracted in parallel once all the objects are read, as nothing reads them until then
+            struct PendingMesh {
+                const FBXNode* object;
+                unsigned int meshIndex;
+                ExtractedMesh extracted;
+            };
+            std::vector<PendingMesh> pendingMeshes;
             foreach (const FBXNode& object, child.children) {
                 if (object.name == "Geometry") {
                     if (object.properties.at(2) == "Mesh") {
-                        meshes.insert(getID(object.properties), extractMesh(object, meshIndex, deduplicateIndices));
+                        pendingMeshes.push_back({ &object, meshIndex++, ExtractedMesh() });
                     } else { // object.properties.at(2) == "Shape"
                         ExtractedBlendshape extracted = { getID(object.properties), extractBlendshape(object) };
                         blendshapes.append(extracted);
@@ -1100,6 +1109,15 @@ HFMModel* FBXSerializer::extractHFMModel(const hifi::VariantHash& mapping, const
                 }
 #endif
             }
+
+            tbb::parallel_for((size_t)0, pendingMeshes.size(), [&](size_t i) {
+                auto& pending = pendingMeshes[i];
+                unsigned int pendingMeshIndex = pending.meshIndex;
+                pending.extracted = extractMesh(*pending.object, pendingMeshIndex, deduplicateIndices);
+            });
+            for (auto& pending : pendingMeshes) {
+                meshes.insert(getID(pending.object->properties), std::move(pending.extracted));
+            }
         } else if (child.name == "Connections") {
             static const QVariant OO = hifi::ByteArray("OO");
             static const QVariant OP = hifi::ByteArray("OP");
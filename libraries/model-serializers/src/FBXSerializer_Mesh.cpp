@@ -366,6 +366,10 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
                     for (const auto& materialID : dracoChild.properties) {
                         dracoMaterialList.push_back(materialID.toString());
                     }
+                } else if (dracoChild.name == "LODErrors") {
+                    for (const auto& lodError : dracoChild.properties) {
+                        data.extracted.mesh.lodErrors.push_back(lodError.toFloat());
+                    }
                 }
             }
 
@@ -386,6 +390,11 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
             auto colorAttribute = dracoMesh->GetNamedAttribute(draco::GeometryAttribute::COLOR);
             auto materialIDAttribute = dracoMesh->GetAttributeByUniqueId(DRACO_ATTRIBUTE_MATERIAL_ID);
             auto originalIndexAttribute = dracoMesh->GetAttributeByUniqueId(DRACO_ATTRIBUTE_ORIGINAL_INDEX);
+            auto lodMaskAttribute = dracoMesh->GetAttributeByUniqueId(DRACO_ATTRIBUTE_LOD_MASK);
+            int numLODs = lodMaskAttribute ? data.extracted.mesh.lodErrors.size() : 0;
+            if (!lodMaskAttribute) {
+                data.extracted.mesh.lodErrors.clear();
+            }
 
             // setup extracted mesh data structures given number of points
             auto numVertices = dracoMesh->num_points();
@@ -473,6 +482,13 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
                 auto& firstCorner = dracoFace[0];
 
                 uint16_t materialID { 0 };
+                uint16_t lodMask { 1 };
+
+                if (lodMaskAttribute) {
+                    auto mappedIndex = lodMaskAttribute->mapped_index(firstCorner);
+
+                    lodMaskAttribute->ConvertValue<uint16_t, 1>(mappedIndex, &lodMask);
+                }
 
                 if (materialIDAttribute) {
                     // read material ID and texture ID mappings into materials and texture vectors
@@ -500,14 +516,21 @@ ExtractedMesh FBXSerializer::extractMesh(const FBXNode& object, unsigned int& me
                         data.extracted.partMaterialTextures.append(materialTexture);
                     }
 
+                    part.lodTriangleIndices.resize(numLODs);
+
                     partIndexPlusOne = data.extracted.mesh.parts.size();
                 }
 
-                // give the mesh part this index
+                // give the mesh part this index, in the levels of detail it's in
                 HFMMeshPart& part = data.extracted.mesh.parts[partIndexPlusOne - 1];
-                part.triangleIndices.append(firstCorner.value());
-                part.triangleIndices.append(dracoFace[1].value());
-                part.triangleIndices.append(dracoFace[2].value());
+                for (int lod = 0; lod <= numLODs; lod++) {
+                    if (lodMask & (1 << lod)) {
+                        QVector<int>& triangleIndices = lod == 0 ? part.triangleIndices : part.lodTriangleIndices[lod - 1];
+                        triangleIndices.append(firstCorner.value());
+                        triangleIndices.append(dracoFace[1].value());
+                        triangleIndices.append(dracoFace[2].value());
+                    }
+                }
             }
         }
     }
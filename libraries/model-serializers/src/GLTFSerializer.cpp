@@ -11,6 +11,10 @@
 
 #include "GLTFSerializer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
 #include <QtCore/QBuffer>
 #include <QtCore/QIODevice>
 #include <QtCore/QEventLoop>
@@ -36,6 +40,20 @@
 
 #include "FBXSerializer.h"
 
+// Appends the packed components of an accessor to the vectors of a mesh in one copy
+template <typename V>
+static void appendPacked(QVector<V>& out, const QVector<float>& components) {
+    static_assert(sizeof(V) % sizeof(float) == 0 && std::is_trivially_copyable<V>::value, "V must be packed floats");
+    const int numComponents = (int)(sizeof(V) / sizeof(float));
+    const int count = components.size() / numComponents;
+    if (count == 0) {
+        return;
+    }
+    const int offset = out.size();
+    out.resize(offset + count);
+    memcpy(out.data() + offset, components.constData(), count * sizeof(V));
+}
+
 #define GLTF_GET_INDICIES(accCount) int index1 = (indices[n + 0] * accCount); int index2 = (indices[n + 1] * accCount); int index3 = (indices[n + 2] * accCount);
 
 #define GLTF_APPEND_ARRAY_1(newArray, oldArray) GLTF_GET_INDICIES(1) \
@@ -167,7 +185,10 @@ hifi::ByteArray GLTFSerializer::setGLBChunks(const hifi::ByteArray& data) {
         tempBinLen.setByteOrder(QDataStream::LittleEndian);
         tempBinLen >> binLength;
 
-        _glbBinary = data.mid(binStart + byte, binLength);
+        // a view of the data being read rather than a copy of it, released at the end of read()
+        int binOffset = std::min(binStart + byte, data.size());
+        binLength = std::max(0, std::min(binLength, data.size() - binOffset));
+        _glbBinary = hifi::ByteArray::fromRawData(data.constData() + binOffset, binLength);
     }
     return jsonChunk;
 }
@@ -386,6 +407,7 @@ bool GLTFSerializer::addBufferView(const QJsonObject& object) {
     getIntVal(object, "buffer", bufferview.buffer, bufferview.defined);
     getIntVal(object, "byteLength", bufferview.byteLength, bufferview.defined);
     getIntVal(object, "byteOffset", bufferview.byteOffset, bufferview.defined);
+    getIntVal(object, "byteStride", bufferview.byteStride, bufferview.defined);
     getIntVal(object, "target", bufferview.target, bufferview.defined);
 
     _file.bufferviews.push_back(bufferview);
@@ -1360,13 +1382,8 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
 
                 part.triangleIndices.append(validatedIndices);
 
-                for (int n = 0; n + verticesStride - 1 < vertices.size(); n = n + verticesStride) {
-                    mesh.vertices.push_back(glm::vec3(vertices[n], vertices[n + 1], vertices[n + 2]));
-                }
-
-                for (int n = 0; n + normalStride - 1 < normals.size(); n = n + normalStride) {
-                    mesh.normals.push_back(glm::vec3(normals[n], normals[n + 1], normals[n + 2]));
-                }
+                appendPacked(mesh.vertices, vertices);
+                appendPacked(mesh.normals, normals);
 
                 // TODO: add correct tangent generation
                 if (tangents.size() == partVerticesCount * tangentStride) {
@@ -1383,9 +1400,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                 }
 
                 if (texcoords.size() == partVerticesCount * texCoordStride) {
-                    for (int n = 0; n + 1 < texcoords.size(); n = n + 2) {
-                        mesh.texCoords.push_back(glm::vec2(texcoords[n], texcoords[n + 1]));
-                    }
+                    appendPacked(mesh.texCoords, texcoords);
                 } else {
                     if (meshAttributes.contains("TEXCOORD_0")) {
                         for (int i = 0; i < partVerticesCount; ++i) {
@@ -1395,9 +1410,7 @@ bool GLTFSerializer::buildGeometry(HFMModel& hfmModel, const hifi::VariantHash&
                 }
 
                 if (texcoords2.size() == partVerticesCount * texCoord2Stride) {
-                    for (int n = 0; n + 1 < texcoords2.size(); n = n + 2) {
-                        mesh.texCoords1.push_back(glm::vec2(texcoords2[n], texcoords2[n + 1]));
-                    }
+                    appendPacked(mesh.texCoords1, texcoords2);
                 } else {
                     if (meshAttributes.contains("TEXCOORD_1")) {
                         for (int i = 0; i < partVerticesCount; ++i) {
@@ -1701,21 +1714,24 @@ HFMModel::Pointer GLTFSerializer::read(const hifi::ByteArray& data, const hifi::
         _url = hifi::URL(QFileInfo(localFileName).absoluteFilePath());
     }
 
+    HFMModel::Pointer hfmModelPtr;
     if (parseGLTF(data)) {
         //_file.dump();
-        auto hfmModelPtr = std::make_shared<HFMModel>();
+        hfmModelPtr = std::make_shared<HFMModel>();
         HFMModel& hfmModel = *hfmModelPtr;
         buildGeometry(hfmModel, mapping, _url);
 
         //hfmModel.debugDump();
         //glTFDebugDump();
-
-        return hfmModelPtr;
     } else {
         qCDebug(modelformat) << "Error parsing GLTF file.";
     }
 
-    return nullptr;
+    // the GLB binary chunk and the buffers sharing it are views of data, which the caller owns
+    _glbBinary.clear();
+    _file.buffers.clear();
+
+    return hfmModelPtr;
 }
 
 bool GLTFSerializer::readBinary(const QString& url, hifi::ByteArray& outdata) {
@@ -1809,7 +1825,10 @@ HFMTexture GLTFSerializer::getHFMTexture(const GLTFTexture& texture) {
             int offset = imagesBufferview.byteOffset;
             int length = imagesBufferview.byteLength;
 
-            fbxtex.content = _glbBinary.mid(offset, length);
+            // copied, as the binary chunk is only a view of the data being read
+            offset = std::max(0, std::min(offset, _glbBinary.size()));
+            length = std::max(0, std::min(length, _glbBinary.size() - offset));
+            fbxtex.content = hifi::ByteArray(_glbBinary.constData() + offset, length);
             fbxtex.filename = textureUrl.toEncoded().append(texture.source);
         }
 
@@ -1892,15 +1911,8 @@ void GLTFSerializer::setHFMMaterial(HFMMaterial& hfmMat, const GLTFMaterial& mat
 }
 
 template<typename T, typename L>
-bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int count,
+bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
                            QVector<L>& outarray, int accessorType, bool normalized) {
-
-    QDataStream blobstream(bin);
-    blobstream.setByteOrder(QDataStream::LittleEndian);
-    blobstream.setVersion(QDataStream::Qt_5_9);
-    blobstream.setFloatingPointPrecision(QDataStream::FloatingPointPrecision::SinglePrecision);
-    blobstream.skipRawData(byteOffset);
-
     int bufferCount = 0;
     switch (accessorType) {
     case GLTFAccessorType::SCALAR:
@@ -1926,55 +1938,69 @@ bool GLTFSerializer::readArray(const hifi::ByteArray& bin, int byteOffset, int c
         break;
     default:
         qWarning(modelformat) << "Unknown accessorType: " << accessorType;
-        blobstream.setDevice(nullptr);
         return false;
     }
 
+    if (count <= 0) {
+        return true;
+    }
+
+    // the elements are read in place from the buffer, which is little endian as are all the supported platforms
+    const qint64 elementSize = bufferCount * (qint64)sizeof(T);
+    const qint64 stride = byteStride > 0 ? byteStride : elementSize;
+    if (byteOffset < 0 || stride < elementSize || byteOffset + (count - 1) * stride + elementSize > bin.size()) {
+        return false;
+    }
+    const char* data = bin.constData() + byteOffset;
+
+    const int outOffset = outarray.size();
+    outarray.resize(outOffset + count * bufferCount);
+    L* out = outarray.data() + outOffset;
+
+    if (std::is_same<T, L>::value && !normalized && stride == elementSize) {
+        memcpy(out, data, count * elementSize);
+        return true;
+    }
+
     float scale = 1.0f;  // Normalized output values should always be floats.
     if (normalized) {
         scale = (float)(std::numeric_limits<T>::max)();
     }
 
     for (int i = 0; i < count; ++i) {
+        const char* element = data + i * stride;
         for (int j = 0; j < bufferCount; ++j) {
-            if (!blobstream.atEnd()) {
-                T value;
-                blobstream >> value;
-                if (normalized) {
-                    outarray.push_back(std::max((float)value / scale, -1.0f));
-                } else {
-                    outarray.push_back(value);
-                }
+            T value;
+            memcpy(&value, element + j * sizeof(T), sizeof(T));
+            if (normalized) {
+                *out++ = std::max((float)value / scale, -1.0f);
             } else {
-                blobstream.setDevice(nullptr);
-                return false;
+                *out++ = value;
             }
         }
     }
-
-    blobstream.setDevice(nullptr);
     return true;
 }
 template<typename T>
-bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int count,
+bool GLTFSerializer::addArrayOfType(const hifi::ByteArray& bin, int byteOffset, int byteStride, int count,
                                 QVector<T>& outarray, int accessorType, int componentType, bool normalized) {
 
     switch (componentType) {
     case GLTFAccessorComponentType::BYTE: {}
     case GLTFAccessorComponentType::UNSIGNED_BYTE: {
-        return readArray<uchar>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<uchar>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::SHORT: {
-        return readArray<short>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<short>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::UNSIGNED_INT: {
-        return readArray<uint>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<uint>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::UNSIGNED_SHORT: {
-        return readArray<ushort>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<ushort>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     case GLTFAccessorComponentType::FLOAT: {
-        return readArray<float>(bin, byteOffset, count, outarray, accessorType, normalized);
+        return readArray<float>(bin, byteOffset, byteStride, count, outarray, accessorType, normalized);
     }
     }
     return false;
@@ -1990,14 +2016,13 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
         int accBoffset = accessor.defined["byteOffset"] ? accessor.byteOffset : 0;
 
-        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, accessor.count, outarray, accessor.type,
-                                 accessor.componentType, accessor.normalized);
+        int byteStride = bufferview.defined["byteStride"] ? bufferview.byteStride : 0;
+
+        success = addArrayOfType(buffer.blob, bufferview.byteOffset + accBoffset, byteStride, accessor.count, outarray,
+                                 accessor.type, accessor.componentType, accessor.normalized);
     } else {
-        for (int i = 0; i < accessor.count; ++i) {
-            T value;
-            memset(&value, 0, sizeof(T));  // Make sure the dummy array is initialized to zero.
-            outarray.push_back(value);
-        }
+        // Make sure the dummy array is initialized to zero.
+        outarray.insert(outarray.end(), accessor.count, T());
     }
 
     if (success) {
@@ -2009,7 +2034,7 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
             int accSIBoffset = accessor.sparse.indices.defined["byteOffset"] ? accessor.sparse.indices.byteOffset : 0;
 
-            success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset,
+            success = addArrayOfType(sparseIndicesBuffer.blob, sparseIndicesBufferview.byteOffset + accSIBoffset, 0,
                                      accessor.sparse.count, out_sparse_indices_array, GLTFAccessorType::SCALAR,
                                      accessor.sparse.indices.componentType, false);
             if (success) {
@@ -2020,7 +2045,7 @@ bool GLTFSerializer::addArrayFromAccessor(GLTFAccessor& accessor, QVector<T>& ou
 
                 int accSVBoffset = accessor.sparse.values.defined["byteOffset"] ? accessor.sparse.values.byteOffset : 0;
 
-                success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset,
+                success = addArrayOfType(sparseValuesBuffer.blob, sparseValuesBufferview.byteOffset + accSVBoffset, 0,
                                          accessor.sparse.count, out_sparse_values_array, accessor.type, accessor.componentType,
                                          accessor.normalized);
 
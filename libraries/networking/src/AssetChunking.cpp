@@ -0,0 +1,88 @@
+//
+//  AssetChunking.cpp
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunking.h"
+
+#include <algorithm>
+#include <array>
+
+#include <QtCore/QCryptographicHash>
+
+namespace AssetUtils {
+
+namespace {
+    // the gear hash rolls over the last 64 bytes, whose influence is in its highest bits, so it is those that the
+    // masks test: more of them before the average chunk size than after, to keep the chunk sizes close to it
+    const int AVERAGE_CONTENT_CHUNK_BITS = 16;
+    const uint64_t SMALL_CHUNK_MASK = ~0ULL << (64 - (AVERAGE_CONTENT_CHUNK_BITS + 2));
+    const uint64_t LARGE_CHUNK_MASK = ~0ULL << (64 - (AVERAGE_CONTENT_CHUNK_BITS - 2));
+
+    // the chunk boundaries have to be the same for every client and server, so the table is generated from a fixed seed
+    const std::array<uint64_t, 256>& getGearTable() {
+        static const std::array<uint64_t, 256> GEAR_TABLE = [] {
+            std::array<uint64_t, 256> table;
+            uint64_t state = 0x5643474541524442ULL;
+            for (auto& value : table) {
+                // splitmix64
+                uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                value = z ^ (z >> 31);
+            }
+            return table;
+        }();
+        return GEAR_TABLE;
+    }
+
+    size_t findChunkSize(const uint8_t* data, size_t size) {
+        if (size <= MIN_CONTENT_CHUNK_SIZE) {
+            return size;
+        }
+
+        const auto& gear = getGearTable();
+        size_t normalSize = std::min<size_t>(size, AVERAGE_CONTENT_CHUNK_SIZE);
+        size_t maxSize = std::min<size_t>(size, MAX_CONTENT_CHUNK_SIZE);
+
+        uint64_t hash = 0;
+        size_t i = MIN_CONTENT_CHUNK_SIZE;
+        for (; i < normalSize; ++i) {
+            hash = (hash << 1) + gear[data[i]];
+            if (!(hash & SMALL_CHUNK_MASK)) {
+                return i + 1;
+            }
+        }
+        for (; i < maxSize; ++i) {
+            hash = (hash << 1) + gear[data[i]];
+            if (!(hash & LARGE_CHUNK_MASK)) {
+                return i + 1;
+            }
+        }
+        return maxSize;
+    }
+}
+
+std::vector<ContentChunk> chunkContent(const QByteArray& data) {
+    std::vector<ContentChunk> chunks;
+    chunks.reserve(data.size() / AVERAGE_CONTENT_CHUNK_SIZE + 1);
+
+    auto bytes = reinterpret_cast<const uint8_t*>(data.constData());
+    size_t size = data.size();
+    size_t offset = 0;
+    while (offset < size) {
+        size_t chunkSize = findChunkSize(bytes + offset, size - offset);
+        auto chunkData = QByteArray::fromRawData(data.constData() + offset, (int)chunkSize);
+        chunks.push_back({ offset, (uint32_t)chunkSize, QCryptographicHash::hash(chunkData, QCryptographicHash::Sha256) });
+        offset += chunkSize;
+    }
+    return chunks;
+}
+
+} // namespace AssetUtils
@@ -0,0 +1,38 @@
+//
+//  AssetChunking.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunking_h
+#define hifi_AssetChunking_h
+
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+namespace AssetUtils {
+
+const uint32_t MIN_CONTENT_CHUNK_SIZE = 16 * 1024;
+const uint32_t AVERAGE_CONTENT_CHUNK_SIZE = 64 * 1024;
+const uint32_t MAX_CONTENT_CHUNK_SIZE = 256 * 1024;
+
+struct ContentChunk {
+    uint64_t offset;
+    uint32_t size;
+    QByteArray hash;
+};
+
+/// Split data in chunks whose boundaries depend on the content around them (with FastCDC), so that an edit only
+/// changes the chunks it touches, and hash each of them. The chunks cover data, in order.
+std::vector<ContentChunk> chunkContent(const QByteArray& data);
+
+} // namespace AssetUtils
+
+#endif // hifi_AssetChunking_h
@@ -19,6 +19,7 @@
 #include <QtScript/QScriptEngine>
 #include <QtNetwork/QNetworkDiskCache>
 
+#include <SettingHandle.h>
 #include <shared/GlobalAppProperties.h>
 #include <shared/MiniPromises.h>
 
@@ -27,6 +28,7 @@
 #include "AssetUtils.h"
 #include "MappingRequest.h"
 #include "NetworkAccessManager.h"
+#include "NetworkDiskCache.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 #include "PacketReceiver.h"
@@ -34,6 +36,11 @@
 
 MessageID AssetClient::_currentID = 0;
 
+// smaller assets are uploaded at once, rather than to have their chunks looked up first
+static const uint64_t MIN_DELTA_UPLOAD_SIZE = 1024 * 1024;
+
+static Setting::Handle<qint64> maximumCacheSizeSetting { "networkDiskCacheMaximumSize", MAXIMUM_CACHE_SIZE };
+
 AssetClient::AssetClient() {
     _cacheDir = qApp->property(hifi::properties::APP_LOCAL_DATA_PATH).toString();
     setCustomDeleter([](Dependency* dependency){
@@ -51,6 +58,8 @@ AssetClient::AssetClient() {
         PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetGetReply), true);
     packetReceiver.registerListener(PacketType::AssetUploadReply,
         PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetUploadReply));
+    packetReceiver.registerListener(PacketType::AssetUploadManifestReply,
+        PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetUploadManifestReply));
 
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &AssetClient::handleNodeKilled);
     connect(nodeList.data(), &LimitedNodeList::clientConnectionToNodeReset,
@@ -71,12 +80,13 @@ void AssetClient::initCaching() {
 #endif
             _cacheDir = !cachePath.isEmpty() ? cachePath : "interfaceCache";
         }
-        QNetworkDiskCache* cache = new QNetworkDiskCache();
-        cache->setMaximumCacheSize(MAXIMUM_CACHE_SIZE);
+        qint64 maximumCacheSize = maximumCacheSizeSetting.get();
+        QNetworkDiskCache* cache = new NetworkDiskCache();
+        cache->setMaximumCacheSize(maximumCacheSize);
         cache->setCacheDirectory(_cacheDir);
         networkAccessManager.setCache(cache);
         qInfo() << "ResourceManager disk cache setup at" << _cacheDir
-                 << "(size:" << MAXIMUM_CACHE_SIZE / BYTES_PER_GIGABYTES << "GB)";
+                 << "(size:" << maximumCacheSize / BYTES_PER_GIGABYTES << "GB)";
     } else {
         auto cache = qobject_cast<QNetworkDiskCache*>(networkAccessManager.cache());
         qInfo() << "ResourceManager disk cache already setup at" << cache->cacheDirectory()
@@ -85,6 +95,24 @@ void AssetClient::initCaching() {
 
 }
 
+void AssetClient::setMaximumCacheSize(qint64 maximumCacheSize) {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, "setMaximumCacheSize", Q_ARG(qint64, maximumCacheSize));
+        return;
+    }
+
+    maximumCacheSizeSetting.set(maximumCacheSize);
+    auto cache = qobject_cast<QNetworkDiskCache*>(NetworkAccessManager::getInstance().cache());
+    if (cache) {
+        // evicts down to the new size, if smaller
+        cache->setMaximumCacheSize(maximumCacheSize);
+    }
+}
+
+qint64 AssetClient::getMaximumCacheSize() const {
+    return maximumCacheSizeSetting.get();
+}
+
 namespace {
     const QString& CACHE_ERROR_MESSAGE{ "AssetClient::Error: %1 %2" };
 }
@@ -892,6 +920,7 @@ bool AssetClient::cancelUploadAssetRequest(MessageID id) {
     // Search through each pending mapping request for id `id`
     for (auto& kv : _pendingUploads) {
         if (kv.second.erase(id)) {
+            _pendingDeltaUploads[kv.first].erase(id);
             return true;
         }
     }
@@ -905,16 +934,33 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
 
     if (assetServer) {
-        auto packetList = NLPacketList::create(PacketType::AssetUpload, QByteArray(), true, true);
-
         auto messageID = ++_currentID;
-        packetList->writePrimitive(messageID);
 
-        uint64_t size = data.length();
-        packetList->writePrimitive(size);
-        packetList->write(data.constData(), size);
+        bool sent = false;
+        if ((uint64_t)data.length() >= MIN_DELTA_UPLOAD_SIZE) {
+            // send the manifest of the chunks of a large asset first, the asset-server may have most of them already
+            auto chunks = AssetUtils::chunkContent(data);
 
-        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+            auto packetList = NLPacketList::create(PacketType::AssetUploadManifest, QByteArray(), true, true);
+            packetList->writePrimitive(messageID);
+
+            uint64_t size = data.length();
+            packetList->writePrimitive(size);
+            packetList->writePrimitive((uint32_t)chunks.size());
+            for (const auto& chunk : chunks) {
+                packetList->write(chunk.hash);
+                packetList->writePrimitive(chunk.size);
+            }
+
+            sent = nodeList->sendPacketList(std::move(packetList), *assetServer) != -1;
+            if (sent) {
+                _pendingDeltaUploads[assetServer][messageID] = { data, std::move(chunks) };
+            }
+        } else {
+            sent = sendAssetUpload(assetServer, messageID, data);
+        }
+
+        if (sent) {
             _pendingUploads[assetServer][messageID] = callback;
 
             return messageID;
@@ -925,6 +971,90 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     return INVALID_MESSAGE_ID;
 }
 
+bool AssetClient::sendAssetUpload(const SharedNodePointer& assetServer, MessageID messageID, const QByteArray& data) {
+    auto packetList = NLPacketList::create(PacketType::AssetUpload, QByteArray(), true, true);
+    packetList->setPriority(udt::Packet::Priority::Bulk);
+    packetList->writePrimitive(messageID);
+
+    uint64_t size = data.length();
+    packetList->writePrimitive(size);
+    packetList->write(data.constData(), size);
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    return nodeList->sendPacketList(std::move(packetList), *assetServer) != -1;
+}
+
+void AssetClient::handleAssetUploadManifestReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    AssetUtils::AssetServerError error;
+    message->readPrimitive(&error);
+
+    auto nodeIt = _pendingDeltaUploads.find(senderNode);
+    if (nodeIt == _pendingDeltaUploads.end()) {
+        return;
+    }
+    auto uploadIt = nodeIt->second.find(messageID);
+    if (uploadIt == nodeIt->second.end()) {
+        return;
+    }
+
+    if (error) {
+        qCWarning(asset_client) << "Error uploading file to asset server";
+
+        nodeIt->second.erase(uploadIt);
+        auto messageMapIt = _pendingUploads.find(senderNode);
+        if (messageMapIt != _pendingUploads.end()) {
+            auto requestIt = messageMapIt->second.find(messageID);
+            if (requestIt != messageMapIt->second.end()) {
+                auto callback = requestIt->second;
+                messageMapIt->second.erase(requestIt);
+                callback(true, error, QString());
+            }
+        }
+        return;
+    }
+
+    const auto& upload = uploadIt->second;
+    std::vector<bool> isMissing(upload.chunks.size(), false);
+    uint32_t numMissing { 0 };
+    message->readPrimitive(&numMissing);
+    for (uint32_t i = 0; i < numMissing; ++i) {
+        uint32_t index { 0 };
+        message->readPrimitive(&index);
+        if (index < isMissing.size()) {
+            isMissing[index] = true;
+        }
+    }
+
+    qCDebug(asset_client) << "Uploading" << numMissing << "of" << upload.chunks.size() << "chunks to asset-server";
+
+    auto packetList = NLPacketList::create(PacketType::AssetDeltaUpload, QByteArray(), true, true);
+    packetList->setPriority(udt::Packet::Priority::Bulk);
+    packetList->writePrimitive(messageID);
+
+    uint64_t size = upload.data.length();
+    packetList->writePrimitive(size);
+    packetList->writePrimitive((uint32_t)upload.chunks.size());
+    for (size_t i = 0; i < upload.chunks.size(); ++i) {
+        const auto& chunk = upload.chunks[i];
+        packetList->write(chunk.hash);
+        packetList->writePrimitive(chunk.size);
+
+        uint8_t hasData = isMissing[i] ? 1 : 0;
+        packetList->writePrimitive(hasData);
+        if (hasData) {
+            packetList->write(upload.data.constData() + chunk.offset, chunk.size);
+        }
+    }
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    nodeList->sendPacketList(std::move(packetList), *senderNode);
+}
+
 void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -934,6 +1064,19 @@ void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message
     AssetUtils::AssetServerError error;
     message->readPrimitive(&error);
 
+    // the delta upload of an asset whose chunks the asset-server lost meanwhile is sent in full
+    auto deltaNodeIt = _pendingDeltaUploads.find(senderNode);
+    if (deltaNodeIt != _pendingDeltaUploads.end()) {
+        auto deltaIt = deltaNodeIt->second.find(messageID);
+        if (deltaIt != deltaNodeIt->second.end()) {
+            auto data = deltaIt->second.data;
+            deltaNodeIt->second.erase(deltaIt);
+            if (error == AssetUtils::AssetServerError::UploadChunkNotFound && sendAssetUpload(senderNode, messageID, data)) {
+                return;
+            }
+        }
+    }
+
     QString hashString;
 
     if (error) {
@@ -982,6 +1125,7 @@ void AssetClient::handleNodeKilled(SharedNodePointer node) {
             }
             messageMapIt->second.clear();
         }
+        _pendingDeltaUploads.erase(node);
     }
 }
 
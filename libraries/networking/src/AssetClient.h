@@ -22,6 +22,7 @@
 #include <DependencyManager.h>
 #include <shared/MiniPromises.h>
 
+#include "AssetChunking.h"
 #include "AssetUtils.h"
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
@@ -67,6 +68,10 @@ public:
 public slots:
     void initCaching();
 
+    // The maximum size of the disk cache of the HTTP resources, kept in the settings.
+    void setMaximumCacheSize(qint64 maximumCacheSize);
+    qint64 getMaximumCacheSize() const;
+
     void cacheInfoRequest(QObject* reciever, QString slot);
     MiniPromise::Promise cacheInfoRequestAsync(MiniPromise::Promise deferred = nullptr);
     MiniPromise::Promise queryCacheMetaAsync(const QUrl& url, MiniPromise::Promise deferred = nullptr);
@@ -79,6 +84,7 @@ private slots:
     void handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetGetReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetUploadManifestReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void handleNodeKilled(SharedNodePointer node);
     void handleNodeClientConnectionReset(SharedNodePointer node);
@@ -95,6 +101,7 @@ private:
     MessageID getAsset(const QString& hash, AssetUtils::DataOffset start, AssetUtils::DataOffset end,
                   ReceivedAssetCallback callback, ProgressCallback progressCallback);
     MessageID uploadAsset(const QByteArray& data, UploadResultCallback callback);
+    bool sendAssetUpload(const SharedNodePointer& assetServer, MessageID messageID, const QByteArray& data);
 
     bool cancelMappingRequest(MessageID id);
     bool cancelGetAssetInfoRequest(MessageID id);
@@ -118,6 +125,13 @@ private:
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
 
+    // The large uploads whose chunks the asset-server is asked for first, so that only those it lacks are sent
+    struct DeltaUploadData {
+        QByteArray data;
+        std::vector<AssetUtils::ContentChunk> chunks;
+    };
+    std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, DeltaUploadData>> _pendingDeltaUploads;
+
     QString _cacheDir;
 
     friend class AssetRequest;
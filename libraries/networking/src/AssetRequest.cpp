@@ -14,17 +14,46 @@
 #include <algorithm>
 
 #include <QtCore/QThread>
+#include <QtCore/QUrlQuery>
+#include <QtNetwork/QAbstractNetworkCache>
 
 #include <StatTracker.h>
 #include <Trace.h>
 
 #include "AssetClient.h"
+#include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 #include "ResourceCache.h"
 
 static int requestID = 0;
 
+namespace {
+    const int64_t CHUNK_SIZE = 2 * 1024 * 1024;
+    const int64_t MIN_CHUNKED_ASSET_SIZE = 2 * CHUNK_SIZE;
+    const int MAX_CHUNKS_IN_FLIGHT = 4;
+    const int MAX_CHUNK_ATTEMPTS = 3;
+
+    AssetRequest::Error getRequestError(AssetUtils::AssetServerError serverError) {
+        switch (serverError) {
+            case AssetUtils::AssetServerError::NoError:
+                return AssetRequest::NoError;
+            case AssetUtils::AssetServerError::AssetNotFound:
+                return AssetRequest::NotFound;
+            case AssetUtils::AssetServerError::InvalidByteRange:
+                return AssetRequest::InvalidByteRange;
+            default:
+                return AssetRequest::UnknownError;
+        }
+    }
+
+    void removeFromCache(const QUrl& url) {
+        if (auto cache = NetworkAccessManager::getInstance().cache()) {
+            cache->remove(url);
+        }
+    }
+}
+
 AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
     _requestID(++requestID),
     _hash(hash),
@@ -38,6 +67,10 @@ AssetRequest::~AssetRequest() {
     if (_assetRequestID) {
         assetClient->cancelGetAssetRequest(_assetRequestID);
     }
+    if (_assetInfoRequestID) {
+        assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
+    }
+    cancelChunks();
 }
 
 void AssetRequest::start() {
@@ -75,6 +108,30 @@ void AssetRequest::start() {
 
     _state = WaitingForData;
 
+    if (_byteRange.isSet()) {
+        requestAsset();
+        return;
+    }
+
+    // the size of the asset decides whether it's fetched whole or in chunks
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+    _assetInfoRequestID = DependencyManager::get<AssetClient>()->getAssetInfo(_hash,
+        [this, that](bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info) {
+        if (!that) {
+            return;
+        }
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+
+        if (responseReceived && serverError == AssetUtils::AssetServerError::NoError && info.size >= MIN_CHUNKED_ASSET_SIZE) {
+            requestChunks(info.size);
+        } else {
+            // the whole request reports the errors, if any
+            requestAsset();
+        }
+    });
+}
+
+void AssetRequest::requestAsset() {
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
     auto hash = _hash;
@@ -92,17 +149,7 @@ void AssetRequest::start() {
         if (!responseReceived) {
             _error = NetworkError;
         } else if (serverError != AssetUtils::AssetServerError::NoError) {
-            switch (serverError) {
-                case AssetUtils::AssetServerError::AssetNotFound:
-                    _error = NotFound;
-                    break;
-                case AssetUtils::AssetServerError::InvalidByteRange:
-                    _error = InvalidByteRange;
-                    break;
-                default:
-                    _error = UnknownError;
-                    break;
-            }
+            _error = getRequestError(serverError);
         } else {
             if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
                 // the hash of the received data does not match what we expect, so we return an error
@@ -135,6 +182,158 @@ void AssetRequest::start() {
     });
 }
 
+void AssetRequest::requestChunks(int64_t size) {
+    _size = size;
+    _data.resize(size);
+    _chunks.resize((size + CHUNK_SIZE - 1) / CHUNK_SIZE);
+
+    // resume from the chunks of an earlier download
+    for (int i = 0; i < (int)_chunks.size(); i++) {
+        QByteArray cachedChunk = AssetUtils::loadFromCache(getChunkUrl(i));
+        if (cachedChunk.size() == getChunkSize(i)) {
+            memcpy(_data.data() + i * CHUNK_SIZE, cachedChunk.constData(), cachedChunk.size());
+            _chunks[i].received = true;
+            _numChunksReceived++;
+            _numChunksFromCache++;
+            _totalReceived += cachedChunk.size();
+        } else {
+            _pendingChunks.push_back(i);
+        }
+    }
+    if (_numChunksFromCache > 0) {
+        qCDebug(asset_client) << "Resuming download of asset" << _hash << "from" << _numChunksFromCache << "of"
+                              << _chunks.size() << "chunks";
+        emit progress(_totalReceived, _size);
+    }
+
+    if (_numChunksReceived == (int)_chunks.size()) {
+        finishChunks();
+    } else {
+        requestNextChunks();
+    }
+}
+
+void AssetRequest::requestNextChunks() {
+    // a chunk request failing right away calls back into here
+    if (_requestingChunks) {
+        return;
+    }
+    _requestingChunks = true;
+
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+    while (_state == WaitingForData && _numChunksInFlight < MAX_CHUNKS_IN_FLIGHT && !_pendingChunks.empty()) {
+        int index = _pendingChunks.front();
+        _pendingChunks.pop_front();
+
+        int64_t start = index * CHUNK_SIZE;
+        _numChunksInFlight++;
+        _chunks[index].attempts++;
+        MessageID requestID = assetClient->getAsset(_hash, start, start + getChunkSize(index),
+            [this, that, index](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+                if (that) {
+                    handleChunk(index, responseReceived, serverError, data);
+                }
+            }, [](qint64, qint64) {});
+        // a request that failed right away has been handled already
+        if (requestID != INVALID_MESSAGE_ID) {
+            _chunks[index].requestID = requestID;
+        }
+    }
+
+    _requestingChunks = false;
+}
+
+void AssetRequest::handleChunk(int index, bool responseReceived, AssetUtils::AssetServerError serverError,
+                               const QByteArray& data) {
+    auto& chunk = _chunks[index];
+    chunk.requestID = INVALID_MESSAGE_ID;
+    _numChunksInFlight--;
+    if (_state != WaitingForData) {
+        return;
+    }
+
+    if (responseReceived && serverError == AssetUtils::AssetServerError::NoError && data.size() == getChunkSize(index)) {
+        memcpy(_data.data() + index * CHUNK_SIZE, data.constData(), data.size());
+        chunk.received = true;
+        _numChunksReceived++;
+        _totalReceived += data.size();
+        AssetUtils::saveToCache(getChunkUrl(index), data);
+        emit progress(_totalReceived, _size);
+    } else if (responseReceived && serverError != AssetUtils::AssetServerError::NoError) {
+        fail(getRequestError(serverError));
+        return;
+    } else if (chunk.attempts < MAX_CHUNK_ATTEMPTS) {
+        qCDebug(asset_client) << "Retrying chunk" << index << "of asset" << _hash;
+        _pendingChunks.push_back(index);
+    } else {
+        fail(responseReceived ? SizeVerificationFailed : NetworkError);
+        return;
+    }
+
+    if (_numChunksReceived == (int)_chunks.size()) {
+        finishChunks();
+    } else {
+        requestNextChunks();
+    }
+}
+
+void AssetRequest::finishChunks() {
+    // the asset is addressed by the hash of its content, which verifies all the chunks at once
+    if (AssetUtils::hashData(_data).toHex() != _hash) {
+        for (int i = 0; i < (int)_chunks.size(); i++) {
+            removeFromCache(getChunkUrl(i));
+        }
+        fail(HashVerificationFailed);
+        return;
+    }
+
+    AssetUtils::saveToCache(getUrl(), _data);
+    for (int i = 0; i < (int)_chunks.size(); i++) {
+        removeFromCache(getChunkUrl(i));
+    }
+    _loadedFromCache = _numChunksFromCache == (int)_chunks.size();
+    _error = NoError;
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::cancelChunks() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    for (auto& chunk : _chunks) {
+        if (chunk.requestID != INVALID_MESSAGE_ID) {
+            assetClient->cancelGetAssetRequest(chunk.requestID);
+            chunk.requestID = INVALID_MESSAGE_ID;
+        }
+    }
+    _pendingChunks.clear();
+    _numChunksInFlight = 0;
+}
+
+QUrl AssetRequest::getChunkUrl(int index) const {
+    // the chunk size is part of the key so that chunks of another size are never mixed in
+    QUrl url = getUrl();
+    QUrlQuery query;
+    query.addQueryItem("chunk", QString::number(index));
+    query.addQueryItem("chunkSize", QString::number(CHUNK_SIZE));
+    url.setQuery(query);
+    return url;
+}
+
+int64_t AssetRequest::getChunkSize(int index) const {
+    return std::min(CHUNK_SIZE, _size - index * CHUNK_SIZE);
+}
+
+void AssetRequest::fail(Error error) {
+    // the chunks received so far stay in the cache, for the next request to resume from
+    cancelChunks();
+    _data.clear();
+    _error = error;
+    qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+    _state = Finished;
+    emit finished(this);
+}
+
 
 const QString AssetRequest::getErrorString() const {
     QString result;
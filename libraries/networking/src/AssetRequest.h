@@ -12,6 +12,9 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <deque>
+#include <vector>
+
 #include <QByteArray>
 #include <QObject>
 #include <QString>
@@ -62,6 +65,26 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    struct Chunk {
+        MessageID requestID { INVALID_MESSAGE_ID };
+        int attempts { 0 };
+        bool received { false };
+    };
+
+    void requestAsset();
+
+    // Large assets are fetched as ranges of CHUNK_SIZE bytes, several at a time, each retried on its own.  The received
+    // chunks are kept in the disk cache until the whole asset is, so that a failed download resumes where it stopped.
+    void requestChunks(int64_t size);
+    void requestNextChunks();
+    void handleChunk(int index, bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data);
+    void finishChunks();
+    void cancelChunks();
+    QUrl getChunkUrl(int index) const;
+    int64_t getChunkSize(int index) const;
+
+    void fail(Error error);
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
@@ -70,6 +93,14 @@ private:
     QByteArray _data;
     int _numPendingRequests { 0 };
     MessageID _assetRequestID { INVALID_MESSAGE_ID };
+    MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
+    int64_t _size { 0 };
+    std::vector<Chunk> _chunks;
+    std::deque<int> _pendingChunks;
+    int _numChunksInFlight { 0 };
+    int _numChunksReceived { 0 };
+    int _numChunksFromCache { 0 };
+    bool _requestingChunks { false };
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
 };
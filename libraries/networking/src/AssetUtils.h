@@ -46,7 +46,8 @@ enum AssetServerError : uint8_t {
     MappingOperationFailed,
     FileOperationFailed,
     NoAssetServer,
-    LostConnection
+    LostConnection,
+    UploadChunkNotFound
 };
 
 enum AssetMappingOperationType : uint8_t {
@@ -67,6 +68,12 @@ enum BakingStatus {
     Error
 };
 
+enum BakeJobResultType : uint8_t {
+    BakeJobCompleted = 0,
+    BakeJobFailed,
+    BakeJobAborted
+};
+
 struct MappingInfo {
     AssetHash hash;
     BakingStatus status;
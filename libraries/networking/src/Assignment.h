@@ -22,6 +22,9 @@ const int MAX_PAYLOAD_BYTES = 1024;
 
 const QString emptyPool = QString();
 
+// the payload of a mixer assignment that is one of several shards serving the domain's clients
+const QByteArray SHARD_ASSIGNMENT_PAYLOAD = "--shard";
+
 /// Holds information used for request, creation, and deployment of assignments
 class Assignment : public QObject {
     Q_OBJECT
@@ -36,7 +39,8 @@ public:
         MessagesMixerType = 4,
         EntityScriptServerType = 5,
         EntityServerType = 6,
-        AllTypes = 7
+        BakeWorkerType = 7,
+        AllTypes = 8
     };
 
     enum Command {
@@ -83,6 +87,9 @@ public:
     
     void setIsStatic(bool isStatic) { _isStatic = isStatic; }
     bool isStatic() const  { return _isStatic; }
+
+    void setIsStandby(bool isStandby) { _isStandby = isStandby; }
+    bool isStandby() const { return _isStandby; }
     
     void setWalletUUID(const QUuid& walletUUID) { _walletUUID = walletUUID; }
     const QUuid& getWalletUUID() const { return _walletUUID; }
@@ -104,6 +111,7 @@ protected:
     Assignment::Location _location; /// the location of the assignment, allows a domain to preferentially use local ACs
     QByteArray _payload; /// an optional payload attached to this assignment, a maximum for 1024 bytes will be packed
     bool _isStatic; /// defines if this assignment needs to be re-queued in the domain-server if it stops being fulfilled
+    bool _isStandby { false }; /// defines if this mixer assignment is kept as a hot standby, from all but the active mixer
     QUuid _walletUUID; /// the UUID for the wallet that should be paid for this assignment
     QString _nodeVersion;
     QString _dataDirectory;
@@ -113,6 +113,7 @@ void DomainHandler::softReset(QString reason) {
 
     _connectionDenialsSinceKeypairRegen = 0;
     _checkInPacketsSinceLastReply = 0;
+    _checkInDeferredUntil = 0;
 
     // cancel the failure timeout for any pending requests for settings
     QMetaObject::invokeMethod(&_settingsTimer, "stop");
@@ -581,6 +582,16 @@ void DomainHandler::processDomainServerConnectionDeniedPacket(QSharedPointer<Rec
     auto extraInfoUtf8= message->readWithoutCopy(extraInfoSize);
     QString extraInfo = QString::fromUtf8(extraInfoUtf8);
 
+    if (reasonCode == ConnectionRefusedReason::Busy) {
+        // not a refusal, the domain-server is asking us not to add to a storm of connection requests - wait as long as it
+        // asks, and a little longer so that everyone it turned away doesn't come back at the same time
+        int retryMsecs = std::max(extraInfo.toInt(), 0);
+        retryMsecs += (int)(randFloat() * retryMsecs / 2);
+        _checkInDeferredUntil = usecTimestampNow() + (quint64)retryMsecs * USECS_PER_MSEC;
+        qCDebug(networking) << "The domain-server is busy, will try to connect again in" << retryMsecs << "msec";
+        return;
+    }
+
     // output to the log so the user knows they got a denied connection request
     // and check and signal for an access token so that we can make sure they are logged in
     QString sanitizedExtraInfo = extraInfo.toLower().startsWith("http") ? "" : extraInfo;  // Don't log URLs.
@@ -647,6 +658,10 @@ void DomainHandler::processDomainServerConnectionDeniedPacket(QSharedPointer<Rec
     }
 }
 
+bool DomainHandler::isCheckInDeferred() const {
+    return usecTimestampNow() < _checkInDeferredUntil;
+}
+
 static const int SILENT_DOMAIN_TRAFFIC_DROP_MIN = 2;
 
 bool DomainHandler::checkInPacketTimeout() {
@@ -172,6 +172,9 @@ public:
     bool checkInPacketTimeout();
     void clearPendingCheckins() { _checkInPacketsSinceLastReply = 0; }
 
+    // whether the domain-server asked us to wait before sending another connect request
+    bool isCheckInDeferred() const;
+
     void resetConfirmConnectWithoutAvatarEntities() {
         _haveAskedConnectWithoutAvatarEntities = false;
     }
@@ -227,6 +230,11 @@ public:
      *       <td><code>6</code></td>
      *       <td>You are not authorized to connect to the domain per your domain login.</td>
      *     </tr>
+     *     <tr>
+     *       <td><strong>Busy</strong></td>
+     *       <td><code>8</code></td>
+     *       <td>The domain is handling too many connection requests and will be retried shortly.</td>
+     *     </tr>
      *   </tbody>
      * </table>
      * @typedef {number} Window.ConnectionRefusedReason
@@ -239,7 +247,8 @@ public:
         TooManyUsers,
         TimedOut,
         LoginErrorDomain,
-        NotAuthorizedDomain
+        NotAuthorizedDomain,
+        Busy
     };
 
 public slots:
@@ -323,6 +332,7 @@ private:
     bool _hasCheckedForDomainAccessToken { false };
     int _connectionDenialsSinceKeypairRegen { 0 };
     int _checkInPacketsSinceLastReply { 0 };
+    quint64 _checkInDeferredUntil { 0 };
 
     QTimer _apiRefreshTimer;
 
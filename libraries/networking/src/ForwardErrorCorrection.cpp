@@ -0,0 +1,307 @@
+//
+//  ForwardErrorCorrection.cpp
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ForwardErrorCorrection.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+
+#include "NLPacket.h"
+#include "udt/Constants.h"
+
+static const int MAX_GROUP_SIZE = 16;
+
+// first index, packets in the group, fragment index, fragments, parity length, length parity, then the sequence numbers
+static const int PARITY_HEADER_SIZE = sizeof(quint16) + 3 * sizeof(quint8) + 2 * sizeof(quint16);
+static const int MAX_PARITY_HEADER_SIZE = PARITY_HEADER_SIZE + MAX_GROUP_SIZE * sizeof(udt::SequenceNumber::Type);
+
+// the receiver reports every second, protection stops when it doesn't any more
+static const quint64 FEEDBACK_TIMEOUT_USECS = 10 * USECS_PER_SECOND;
+
+// enough for a few groups of the largest size, late parity for older packets can't help anymore
+static const size_t MAX_RECEIVED_DATAGRAMS = 256;
+static const size_t MAX_RECOVERED_SEQUENCE_NUMBERS = 64;
+static const size_t MAX_PENDING_PARITIES = 8;
+
+static const int STATS_HISTORY_INTERVALS = 5;
+
+FECEncoder::FECEncoder() :
+    _maxFragmentSize(NLPacket::maxPayloadSize(PacketType::FECParity) - MAX_PARITY_HEADER_SIZE)
+{
+    _sequenceNumbers.reserve(MAX_GROUP_SIZE);
+}
+
+void FECEncoder::setLossRate(float lossRate) {
+    // a group recovers one loss, keep the chance of a second one in the same group low
+    int groupSize;
+    if (lossRate < 0.005f) {
+        groupSize = MAX_GROUP_SIZE;
+    } else if (lossRate < 0.01f) {
+        groupSize = 10;
+    } else if (lossRate < 0.02f) {
+        groupSize = 6;
+    } else if (lossRate < 0.05f) {
+        groupSize = 4;
+    } else {
+        groupSize = 2;
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    _groupSize = groupSize;
+    _lastFeedbackUsecs = usecTimestampNow();
+}
+
+void FECEncoder::resetGroup() {
+    _sequenceNumbers.clear();
+    _parity.clear();
+    _lengthParity = 0;
+}
+
+std::vector<QByteArray> FECEncoder::protect(const udt::Packet& packet) {
+    std::vector<QByteArray> payloads;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_groupSize == 0) {
+        return payloads;
+    }
+
+    if (usecTimestampNow() - _lastFeedbackUsecs > FEEDBACK_TIMEOUT_USECS) {
+        // the receiver is gone or stopped asking for protection
+        _groupSize = 0;
+        resetGroup();
+        return payloads;
+    }
+
+    if (_sequenceNumbers.empty()) {
+        _firstIndex = _nextIndex;
+    }
+    ++_nextIndex;
+
+    auto data = packet.getData();
+    auto size = (int)packet.getDataSize();
+    if (_parity.size() < size) {
+        _parity.append(QByteArray(size - _parity.size(), 0));
+    }
+
+    auto parity = _parity.data();
+    for (int i = 0; i < size; ++i) {
+        parity[i] ^= data[i];
+    }
+    _lengthParity ^= (quint16)size;
+    _sequenceNumbers.push_back(packet.getSequenceNumber());
+
+    if ((int)_sequenceNumbers.size() < _groupSize) {
+        return payloads;
+    }
+
+    // the parity of the largest datagrams doesn't fit in one packet, it goes out in more
+    quint16 parityLength = (quint16)_parity.size();
+    quint8 numFragments = (quint8)((parityLength + _maxFragmentSize - 1) / _maxFragmentSize);
+    int fragmentSize = (parityLength + numFragments - 1) / numFragments;
+    quint8 numPackets = (quint8)_sequenceNumbers.size();
+
+    for (quint8 fragmentIndex = 0; fragmentIndex < numFragments; ++fragmentIndex) {
+        int offset = fragmentIndex * fragmentSize;
+        int length = std::min(fragmentSize, parityLength - offset);
+
+        QByteArray payload;
+        payload.reserve(PARITY_HEADER_SIZE + numPackets * sizeof(udt::SequenceNumber::Type) + length);
+        payload.append(reinterpret_cast<const char*>(&_firstIndex), sizeof(_firstIndex));
+        payload.append(reinterpret_cast<const char*>(&numPackets), sizeof(numPackets));
+        payload.append(reinterpret_cast<const char*>(&fragmentIndex), sizeof(fragmentIndex));
+        payload.append(reinterpret_cast<const char*>(&numFragments), sizeof(numFragments));
+        payload.append(reinterpret_cast<const char*>(&parityLength), sizeof(parityLength));
+        payload.append(reinterpret_cast<const char*>(&_lengthParity), sizeof(_lengthParity));
+        for (auto sequenceNumber : _sequenceNumbers) {
+            auto value = (udt::SequenceNumber::Type)sequenceNumber;
+            payload.append(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+        payload.append(_parity.constData() + offset, length);
+
+        payloads.push_back(payload);
+    }
+
+    resetGroup();
+    return payloads;
+}
+
+FECDecoder::FECDecoder() : _stats(STATS_HISTORY_INTERVALS) {
+}
+
+void FECDecoder::addReceived(udt::SequenceNumber sequenceNumber, QByteArray datagram) {
+    if (_receivedDatagrams.emplace(sequenceNumber, datagram).second) {
+        _receivedOrder.push_back(sequenceNumber);
+    }
+
+    while (_receivedOrder.size() > MAX_RECEIVED_DATAGRAMS) {
+        _receivedDatagrams.erase(_receivedOrder.front());
+        _receivedOrder.pop_front();
+    }
+}
+
+bool FECDecoder::packetReceived(const udt::Packet& packet) {
+    _lastReceivedUsecs = usecTimestampNow();
+
+    auto sequenceNumber = packet.getSequenceNumber();
+    if (_recovered.find(sequenceNumber) != _recovered.end()) {
+        return false;
+    }
+
+    addReceived(sequenceNumber, QByteArray(packet.getData(), (int)packet.getDataSize()));
+    return true;
+}
+
+std::unique_ptr<udt::Packet> FECDecoder::parityReceived(const char* payload, int size, const SockAddr& senderSockAddr) {
+    _lastReceivedUsecs = usecTimestampNow();
+
+    if (size < PARITY_HEADER_SIZE) {
+        return nullptr;
+    }
+
+    quint16 firstIndex;
+    quint8 numPackets;
+    quint8 fragmentIndex;
+    quint8 numFragments;
+    quint16 parityLength;
+    quint16 lengthParity;
+    auto position = payload;
+    memcpy(&firstIndex, position, sizeof(firstIndex));
+    position += sizeof(firstIndex);
+    memcpy(&numPackets, position, sizeof(numPackets));
+    position += sizeof(numPackets);
+    memcpy(&fragmentIndex, position, sizeof(fragmentIndex));
+    position += sizeof(fragmentIndex);
+    memcpy(&numFragments, position, sizeof(numFragments));
+    position += sizeof(numFragments);
+    memcpy(&parityLength, position, sizeof(parityLength));
+    position += sizeof(parityLength);
+    memcpy(&lengthParity, position, sizeof(lengthParity));
+    position += sizeof(lengthParity);
+
+    int sequenceNumbersSize = numPackets * sizeof(udt::SequenceNumber::Type);
+    if (numPackets == 0 || numPackets > MAX_GROUP_SIZE || numFragments == 0 || fragmentIndex >= numFragments
+        || size < PARITY_HEADER_SIZE + sequenceNumbersSize) {
+        return nullptr;
+    }
+
+    int fragmentSize = (parityLength + numFragments - 1) / numFragments;
+    int offset = fragmentIndex * fragmentSize;
+    int length = size - PARITY_HEADER_SIZE - sequenceNumbersSize;
+    if (offset + length > parityLength) {
+        return nullptr;
+    }
+
+    auto it = _pendingParities.find(firstIndex);
+    if (it == _pendingParities.end()) {
+        PendingParity pendingParity;
+        for (quint8 i = 0; i < numPackets; ++i) {
+            udt::SequenceNumber::Type value;
+            memcpy(&value, position, sizeof(value));
+            position += sizeof(value);
+            pendingParity.sequenceNumbers.push_back(udt::SequenceNumber(value));
+        }
+        pendingParity.parity = QByteArray(parityLength, 0);
+        pendingParity.lengthParity = lengthParity;
+
+        // the stats see the group as it arrived, a lost parity has its whole group count as lost with it so the
+        // measured loss errs on the side of more protection
+        for (quint8 i = 0; i < numPackets; ++i) {
+            if (_receivedDatagrams.find(pendingParity.sequenceNumbers[i]) != _receivedDatagrams.end()) {
+                _stats.sequenceNumberReceived(firstIndex + i);
+            }
+        }
+
+        if (_pendingParities.size() >= MAX_PENDING_PARITIES) {
+            // some group lost a fragment of its parity
+            _pendingParities.erase(_pendingParities.begin());
+        }
+        it = _pendingParities.emplace(firstIndex, std::move(pendingParity)).first;
+    } else {
+        position += sequenceNumbersSize;
+        if (it->second.parity.size() != parityLength) {
+            return nullptr;
+        }
+    }
+
+    auto& pendingParity = it->second;
+    memcpy(pendingParity.parity.data() + offset, position, length);
+    if (++pendingParity.numFragmentsReceived < numFragments) {
+        return nullptr;
+    }
+
+    auto recovered = recover(pendingParity, senderSockAddr);
+    _pendingParities.erase(it);
+    return recovered;
+}
+
+std::unique_ptr<udt::Packet> FECDecoder::recover(const PendingParity& pendingParity, const SockAddr& senderSockAddr) {
+    // the parity can only rebuild the one datagram of the group we don't have
+    const udt::SequenceNumber* missingSequenceNumber = nullptr;
+    for (auto& sequenceNumber : pendingParity.sequenceNumbers) {
+        if (_receivedDatagrams.find(sequenceNumber) == _receivedDatagrams.end()) {
+            if (missingSequenceNumber) {
+                return nullptr;
+            }
+            missingSequenceNumber = &sequenceNumber;
+        }
+    }
+
+    if (!missingSequenceNumber) {
+        return nullptr;
+    }
+
+    QByteArray datagram = pendingParity.parity;
+    quint16 length = pendingParity.lengthParity;
+    auto data = datagram.data();
+    for (auto& sequenceNumber : pendingParity.sequenceNumbers) {
+        if (&sequenceNumber == missingSequenceNumber) {
+            continue;
+        }
+
+        auto& received = _receivedDatagrams[sequenceNumber];
+        auto receivedData = received.constData();
+        for (int i = 0; i < received.size(); ++i) {
+            data[i] ^= receivedData[i];
+        }
+        length ^= (quint16)received.size();
+    }
+
+    if (length <= udt::Packet::localHeaderSize() || length > datagram.size()) {
+        return nullptr;
+    }
+
+    // the header was rebuilt with the rest, it has to be the unreliable packet the group says was there
+    udt::Packet::SequenceNumberAndBitField sequenceNumberAndBitField;
+    memcpy(&sequenceNumberAndBitField, data, sizeof(sequenceNumberAndBitField));
+    if ((sequenceNumberAndBitField & (udt::CONTROL_BIT_MASK | udt::RELIABILITY_BIT_MASK | udt::MESSAGE_BIT_MASK))
+        || udt::SequenceNumber(sequenceNumberAndBitField & udt::SEQUENCE_NUMBER_MASK) != *missingSequenceNumber) {
+        return nullptr;
+    }
+
+    auto buffer = udt::PacketBufferPool::allocate(length);
+    memcpy(buffer.get(), data, length);
+    auto packet = udt::Packet::fromReceivedPacket(std::move(buffer), length, senderSockAddr);
+
+    addReceived(*missingSequenceNumber, QByteArray(data, length));
+    if (_recovered.insert(*missingSequenceNumber).second) {
+        _recoveredOrder.push_back(*missingSequenceNumber);
+    }
+    while (_recoveredOrder.size() > MAX_RECOVERED_SEQUENCE_NUMBERS) {
+        _recovered.erase(_recoveredOrder.front());
+        _recoveredOrder.pop_front();
+    }
+
+    ++_numRecovered;
+    return packet;
+}
@@ -0,0 +1,108 @@
+//
+//  ForwardErrorCorrection.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ForwardErrorCorrection_h
+#define hifi_ForwardErrorCorrection_h
+
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "SequenceNumberStats.h"
+#include "SockAddr.h"
+#include "udt/Packet.h"
+#include "udt/SequenceNumber.h"
+
+// Unreliable packets of the types in PacketTypeEnum::getForwardErrorCorrectedPackets() can be protected in groups:
+// after every group the sender sends a FECParity packet holding the XOR of the group's datagrams, from which the
+// receiver rebuilds any one datagram of the group it lost. A receiver asks for this by reporting the loss it sees with
+// FECFeedback packets, and the sender picks the group size from that loss rate.
+
+/// Builds the parity of the protected packets sent to one node
+class FECEncoder {
+public:
+    FECEncoder();
+
+    bool isEnabled() const { return _groupSize > 0; }
+
+    // the loss rate the receiver reported, enables the encoder with a group size that protects against it
+    void setLossRate(float lossRate);
+    int getGroupSize() const { return _groupSize; }
+
+    // adds a packet that was just sent to the current group, and returns the payloads of the FECParity packets to send
+    // once the group is complete
+    std::vector<QByteArray> protect(const udt::Packet& packet);
+
+private:
+    void resetGroup();
+
+    std::mutex _mutex;
+    std::atomic<int> _groupSize { 0 }; // packets per group, 0 until the receiver asked for protection
+    quint64 _lastFeedbackUsecs { 0 };
+    int _maxFragmentSize;
+
+    quint16 _nextIndex { 0 }; // every protected packet gets the next index, the receiver measures loss from them
+    quint16 _firstIndex { 0 }; // index of the first packet in the current group
+    std::vector<udt::SequenceNumber> _sequenceNumbers;
+    QByteArray _parity;
+    quint16 _lengthParity { 0 };
+};
+
+/// Rebuilds the protected packets lost from one sender
+class FECDecoder {
+public:
+    FECDecoder();
+
+    // records a protected packet as it arrived, returns false if it is a late copy of one that was already rebuilt
+    bool packetReceived(const udt::Packet& packet);
+
+    // takes the payload of a FECParity packet, and returns the packet it rebuilt if any
+    std::unique_ptr<udt::Packet> parityReceived(const char* payload, int size, const SockAddr& senderSockAddr);
+
+    // the loss rate before recovery, over the last few seconds
+    float getLossRate() const { return _stats.getStatsForHistoryWindow().getLostRate(); }
+    void pushStatsToHistory() { _stats.pushStatsToHistory(); }
+
+    int getNumRecovered() const { return _numRecovered; }
+    quint64 getLastReceivedUsecs() const { return _lastReceivedUsecs; }
+
+private:
+    struct PendingParity {
+        std::vector<udt::SequenceNumber> sequenceNumbers;
+        QByteArray parity;
+        quint16 lengthParity { 0 };
+        int numFragmentsReceived { 0 };
+    };
+
+    std::unique_ptr<udt::Packet> recover(const PendingParity& pendingParity, const SockAddr& senderSockAddr);
+    void addReceived(udt::SequenceNumber sequenceNumber, QByteArray datagram);
+
+    std::unordered_map<udt::SequenceNumber, QByteArray> _receivedDatagrams;
+    std::deque<udt::SequenceNumber> _receivedOrder; // oldest first, so the datagrams kept stay bounded
+
+    std::unordered_set<udt::SequenceNumber> _recovered;
+    std::deque<udt::SequenceNumber> _recoveredOrder;
+
+    std::map<quint16, PendingParity> _pendingParities; // groups waiting for more of their parity, by first index
+
+    SequenceNumberStats _stats;
+    int _numRecovered { 0 };
+    quint64 _lastReceivedUsecs { 0 };
+};
+
+#endif // hifi_ForwardErrorCorrection_h
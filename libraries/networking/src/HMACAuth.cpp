@@ -17,30 +17,47 @@
 #include <QUuid>
 #include "NetworkLogging.h"
 #include <cassert>
+#include <thread>
+
+static_assert(HMACAuth::MAX_HASH_SIZE >= EVP_MAX_MD_SIZE, "HMACAuth::MAX_HASH_SIZE too small");
 
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
-HMACAuth::HMACAuth(AuthMethod authMethod)
-    : _hmacContext(HMAC_CTX_new())
-    , _authMethod(authMethod) { }
+static HMAC_CTX* createHMACContext() {
+    return HMAC_CTX_new();
+}
 
-HMACAuth::~HMACAuth()
-{
-    HMAC_CTX_free(_hmacContext);
+static void freeHMACContext(HMAC_CTX* context) {
+    HMAC_CTX_free(context);
 }
 
 #else
 
+static HMAC_CTX* createHMACContext() {
+    auto context = new HMAC_CTX();
+    HMAC_CTX_init(context);
+    return context;
+}
+
+static void freeHMACContext(HMAC_CTX* context) {
+    HMAC_CTX_cleanup(context);
+    delete context;
+}
+#endif
+
 HMACAuth::HMACAuth(AuthMethod authMethod)
-    : _hmacContext(new HMAC_CTX())
+    : _hmacContext(createHMACContext())
     , _authMethod(authMethod) {
-    HMAC_CTX_init(_hmacContext);
+    for (auto& pooledContext : _pool) {
+        pooledContext.context = createHMACContext();
+    }
 }
 
 HMACAuth::~HMACAuth() {
-    HMAC_CTX_cleanup(_hmacContext);
-    delete _hmacContext;
+    freeHMACContext(_hmacContext);
+    for (auto& pooledContext : _pool) {
+        freeHMACContext(pooledContext.context);
+    }
 }
-#endif
 
 bool HMACAuth::setKey(const char* keyValue, int keyLen) {
     const EVP_MD* sslStruct = nullptr;
@@ -71,7 +88,22 @@ bool HMACAuth::setKey(const char* keyValue, int keyLen) {
     }
 
     QMutexLocker lock(&_lock);
-    return (bool) HMAC_Init_ex(_hmacContext, keyValue, keyLen, sslStruct, nullptr);
+    bool isKeyed = (bool) HMAC_Init_ex(_hmacContext, keyValue, keyLen, sslStruct, nullptr);
+
+    // the pooled contexts are re-keyed too, once whoever is hashing with them is done
+    for (auto& pooledContext : _pool) {
+        bool isInUse = false;
+        while (!pooledContext.isInUse.compare_exchange_weak(isInUse, true, std::memory_order_acquire)) {
+            isInUse = false;
+            std::this_thread::yield();
+        }
+
+        isKeyed = HMAC_Init_ex(pooledContext.context, keyValue, keyLen, sslStruct, nullptr) && isKeyed;
+        pooledContext.isInUse.store(false, std::memory_order_release);
+    }
+
+    _isKeyed = isKeyed;
+    return isKeyed;
 }
 
 bool HMACAuth::setKey(const QUuid& uidKey) {
@@ -104,14 +136,43 @@ HMACAuth::HMACHash HMACAuth::result() {
     return hashValue;
 }
 
-bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) {
-    QMutexLocker lock(&_lock);
-    if (!addData(data, dataLen)) {
-        qCWarning(networking) << "Error occured calling HMACAuth::addData()";
+int HMACAuth::calculateHashWithContext(struct hmac_ctx_st* context, unsigned char* hashResult,
+                                       const char* data, int dataLen) {
+    unsigned int hashLen = 0;
+    if (!HMAC_Update(context, reinterpret_cast<const unsigned char*>(data), dataLen)
+        || !HMAC_Final(context, hashResult, &hashLen)) {
+        qCWarning(networking) << "Error occured calculating HMAC";
         assert(false);
-        return false;
+        hashLen = 0;
+    }
+
+    // Clear state for reuse, keeping the key.
+    HMAC_Init_ex(context, nullptr, 0, nullptr, nullptr);
+    return (int)hashLen;
+}
+
+int HMACAuth::calculateHash(unsigned char* hashResult, const char* data, int dataLen) {
+    if (!_isKeyed) {
+        return 0;
     }
 
-    hashResult = result();
-    return true;
+    // the fast path takes whichever pooled context is free, without a lock
+    for (auto& pooledContext : _pool) {
+        bool isInUse = false;
+        if (pooledContext.isInUse.compare_exchange_strong(isInUse, true, std::memory_order_acquire)) {
+            auto hashLen = calculateHashWithContext(pooledContext.context, hashResult, data, dataLen);
+            pooledContext.isInUse.store(false, std::memory_order_release);
+            return hashLen;
+        }
+    }
+
+    QMutexLocker lock(&_lock);
+    return calculateHashWithContext(_hmacContext, hashResult, data, dataLen);
+}
+
+bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) {
+    hashResult.resize(MAX_HASH_SIZE);
+    auto hashLen = calculateHash(hashResult.data(), data, dataLen);
+    hashResult.resize(hashLen);
+    return hashLen > 0;
 }
@@ -12,6 +12,8 @@
 #ifndef hifi_HMACAuth_h
 #define hifi_HMACAuth_h
 
+#include <array>
+#include <atomic>
 #include <vector>
 #include <memory>
 #include <QtCore/QMutex>
@@ -22,14 +24,20 @@ class HMACAuth {
 public:
     enum AuthMethod { MD5, SHA1, SHA224, SHA256, RIPEMD160 };
     using HMACHash = std::vector<unsigned char>;
+
+    static const int MAX_HASH_SIZE = 64;
     
     explicit HMACAuth(AuthMethod authMethod = MD5);
     ~HMACAuth();
 
     bool setKey(const char* keyValue, int keyLen);
     bool setKey(const QUuid& uidKey);
+    bool isKeyed() const { return _isKeyed; }
     // Calculate complete hash in one.
+    // Several threads can do this at once without waiting for each other, each gets a keyed context from a pool.
     bool calculateHash(HMACHash& hashResult, const char* data, int dataLen);
+    // Same, into a buffer of at least MAX_HASH_SIZE bytes, returns the hash length or 0 on failure.
+    int calculateHash(unsigned char* hashResult, const char* data, int dataLen);
 
     // Append to data to be hashed.
     bool addData(const char* data, int dataLen);
@@ -39,9 +47,22 @@ public:
     HMACHash result();
 
 private:
+    struct PooledContext {
+        std::atomic<bool> isInUse { false };
+        struct hmac_ctx_st* context { nullptr };
+    };
+
+    // enough for the threads of a mixer sending to the same node, any more share _hmacContext under the lock
+    static const int NUM_POOLED_CONTEXTS = 4;
+
+    int calculateHashWithContext(struct hmac_ctx_st* context, unsigned char* hashResult, const char* data, int dataLen);
+
     QRecursiveMutex _lock;
     struct hmac_ctx_st* _hmacContext;
     AuthMethod _authMethod;
+
+    std::array<PooledContext, NUM_POOLED_CONTEXTS> _pool;
+    std::atomic<bool> _isKeyed { false };
 };
 
 #endif  // hifi_HMACAuth_h
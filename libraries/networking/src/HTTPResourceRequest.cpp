@@ -11,7 +11,12 @@
 
 #include "HTTPResourceRequest.h"
 
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+
 #include <QFile>
+#include <QHash>
 #include <QNetworkReply>
 #include <QNetworkRequest>
 #include <QMetaEnum>
@@ -23,12 +28,69 @@
 #include "NetworkLogging.h"
 #include "NetworkingConstants.h"
 
+namespace {
+
+// A closed byte range is fetched as up to MAX_RANGE_PARTS ranges at once, none of them smaller than MIN_RANGE_PART_SIZE
+const int64_t MIN_RANGE_PART_SIZE = 1024 * 1024;
+const int64_t MAX_RANGE_PARTS = 4;
+
+// The requests fetching data, by fetch key. Requests are only coalesced with requests on the same thread, which for
+// those made by the ResourceManager is its thread.
+thread_local QHash<QString, QPointer<HTTPResourceRequest>> fetchingRequests;
+
+struct HostStats {
+    qint64 requests { 0 };
+    qint64 bytes { 0 };
+    qint64 msecs { 0 };
+};
+
+std::mutex hostStatsMutex;
+QHash<QString, HostStats> hostStats;
+
+}
+
 HTTPResourceRequest::~HTTPResourceRequest() {
-    if (_reply) {
-        _reply->disconnect(this);
-        _reply->deleteLater();
-        _reply = nullptr;
+    releaseReplies();
+
+    if (_isFetching) {
+        fetchingRequests.remove(getFetchKey());
+
+        // hand the fetch over to the first request still waiting for it
+        auto followers = std::move(_followers);
+        _followers.clear();
+        auto next = std::find_if(followers.begin(), followers.end(), [](const QPointer<HTTPResourceRequest>& follower) {
+            return !follower.isNull();
+        });
+        if (next != followers.end()) {
+            HTTPResourceRequest* leader = next->data();
+            leader->_followers.assign(std::next(next), followers.end());
+            fetchingRequests[leader->getFetchKey()] = leader;
+            leader->startFetch();
+        }
+    }
+}
+
+QVariantMap HTTPResourceRequest::getHostStats() {
+    std::lock_guard<std::mutex> lock(hostStatsMutex);
+    QVariantMap result;
+    for (auto it = hostStats.cbegin(); it != hostStats.cend(); ++it) {
+        const auto& stats = it.value();
+        QVariantMap hostResult;
+        hostResult["requests"] = stats.requests;
+        hostResult["bytes"] = stats.bytes;
+        hostResult["msecs"] = stats.msecs;
+        hostResult["bytesPerSecond"] = stats.msecs > 0 ? (stats.bytes * (qint64)MSECS_PER_SECOND) / stats.msecs : 0;
+        result[it.key()] = hostResult;
     }
+    return result;
+}
+
+QString HTTPResourceRequest::getFetchKey() const {
+    return QString("%1 %2 %3 %4")
+        .arg(_url.toString())
+        .arg(_byteRange.fromInclusive)
+        .arg(_byteRange.toExclusive)
+        .arg(_cacheEnabled ? 1 : 0);
 }
 
 void HTTPResourceRequest::setupTimer() {
@@ -50,45 +112,131 @@ void HTTPResourceRequest::cleanupTimer() {
     _sendTimer = nullptr;
 }
 
+void HTTPResourceRequest::releaseReplies() {
+    for (auto reply : _replies) {
+        reply->disconnect(this);
+        if (!reply->isFinished()) {
+            reply->abort();
+        }
+        reply->deleteLater();
+    }
+    _replies.clear();
+    _replyData.clear();
+    _replyBytesReceived.clear();
+    _finishedReplyCount = 0;
+}
+
 void HTTPResourceRequest::doSend() {
-    DependencyManager::get<StatTracker>()->incrementStat(STAT_HTTP_REQUEST_STARTED);
+    auto statTracker = DependencyManager::get<StatTracker>();
+    statTracker->incrementStat(STAT_HTTP_REQUEST_STARTED);
+
+    // the same data is already being fetched for another request, which will share its result with this one
+    auto fetchKey = getFetchKey();
+    auto leader = fetchingRequests.value(fetchKey);
+    if (leader) {
+        leader->_followers.push_back(this);
+        statTracker->incrementStat(STAT_HTTP_REQUEST_COALESCED);
+        return;
+    }
+
+    fetchingRequests[fetchKey] = this;
+    startFetch();
+}
+
+void HTTPResourceRequest::startFetch() {
+    Q_ASSERT(_replies.empty());
+    _isFetching = true;
+    _fetchTimer.start();
 
     QNetworkRequest networkRequest(_url);
     networkRequest.setAttribute(QNetworkRequest::FollowRedirectsAttribute, true);
     networkRequest.setHeader(QNetworkRequest::UserAgentHeader, NetworkingConstants::VIRCADIA_USER_AGENT);
 
     if (_cacheEnabled) {
-        networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferCache);
+        // the cached copy is used while fresh, then revalidated with its ETag or Last-Modified date rather than used stale
+        networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::PreferNetwork);
     } else {
         networkRequest.setAttribute(QNetworkRequest::CacheLoadControlAttribute, QNetworkRequest::AlwaysNetwork);
     }
-
-    if (_byteRange.isSet()) {
-        QString byteRange;
-        if (_byteRange.fromInclusive < 0) {
-            byteRange = QString("bytes=%1").arg(_byteRange.fromInclusive);
-        } else {
-            // HTTP byte ranges are inclusive on the `to` end: [from, to]
-            byteRange = QString("bytes=%1-%2").arg(_byteRange.fromInclusive).arg(_byteRange.toExclusive - 1);
+    networkRequest.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, false);
+    // servers that negotiate HTTP/2 get all the requests to them multiplexed on one connection
+    networkRequest.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+
+    std::vector<ByteRange> ranges;
+    if (_byteRange.isSet() && _byteRange.fromInclusive >= 0) {
+        auto numParts = std::min(MAX_RANGE_PARTS, std::max((int64_t)1, _byteRange.size() / MIN_RANGE_PART_SIZE));
+        auto partSize = (_byteRange.size() + numParts - 1) / numParts;
+        for (auto from = _byteRange.fromInclusive; from < _byteRange.toExclusive; from += partSize) {
+            ranges.push_back({ from, std::min(from + partSize, _byteRange.toExclusive) });
         }
-        networkRequest.setRawHeader("Range", byteRange.toLatin1());
+    } else {
+        ranges.push_back(_byteRange);
     }
-    networkRequest.setAttribute(QNetworkRequest::HttpPipeliningAllowedAttribute, false);
 
-    _reply = NetworkAccessManager::getInstance().get(networkRequest);
-    
-    connect(_reply, &QNetworkReply::finished, this, &HTTPResourceRequest::onRequestFinished);
-    connect(_reply, &QNetworkReply::downloadProgress, this, &HTTPResourceRequest::onDownloadProgress);
+    for (size_t i = 0; i < ranges.size(); i++) {
+        const auto& range = ranges[i];
+        QNetworkRequest partRequest = networkRequest;
+        if (range.isSet()) {
+            QString byteRange;
+            if (range.fromInclusive < 0) {
+                byteRange = QString("bytes=%1").arg(range.fromInclusive);
+            } else {
+                // HTTP byte ranges are inclusive on the `to` end: [from, to]
+                byteRange = QString("bytes=%1-%2").arg(range.fromInclusive).arg(range.toExclusive - 1);
+            }
+            partRequest.setRawHeader("Range", byteRange.toLatin1());
+        }
+
+        auto reply = NetworkAccessManager::getInstance().get(partRequest);
+        _replies.push_back(reply);
+        _replyData.emplace_back();
+        _replyBytesReceived.push_back(0);
+
+        connect(reply, &QNetworkReply::finished, this, [this, reply] {
+            onReplyFinished(reply);
+        });
+        connect(reply, &QNetworkReply::downloadProgress, this, [this, i](qint64 bytesReceived, qint64 bytesTotal) {
+            _replyBytesReceived[i] = bytesReceived;
+            if (_replies.size() == 1) {
+                onDownloadProgress(bytesReceived, bytesTotal);
+            } else {
+                auto totalReceived = std::accumulate(_replyBytesReceived.begin(), _replyBytesReceived.end(), (qint64)0);
+                onDownloadProgress(totalReceived, _byteRange.size());
+            }
+        });
+    }
 
     setupTimer();
 }
 
-void HTTPResourceRequest::onRequestFinished() {
+void HTTPResourceRequest::onReplyFinished(QNetworkReply* reply) {
     Q_ASSERT(_state == InProgress);
-    Q_ASSERT(_reply);
 
-    cleanupTimer();
+    // a part that fails fails the request, and a part the server answered with the whole resource is its result
+    auto statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    if (_replies.size() == 1 || reply->error() != QNetworkReply::NoError || statusCode != 206) {
+        processReply(reply, reply->readAll());
+        finish();
+        return;
+    }
+
+    auto index = std::find(_replies.begin(), _replies.end(), reply) - _replies.begin();
+    _replyData[index] = reply->readAll();
+    if (++_finishedReplyCount < _replies.size()) {
+        return;
+    }
 
+    QByteArray data;
+    data.reserve(_byteRange.size());
+    for (const auto& part : _replyData) {
+        data.append(part);
+    }
+    // the parts all give the same size of resource and media type
+    processReply(reply, data);
+    finish();
+}
+
+void HTTPResourceRequest::processReply(QNetworkReply* reply, QByteArray data) {
     // Content-Range headers have the form: 
     //
     //   Content-Range: <unit> <range-start>-<range-end>/<size>
@@ -125,17 +273,17 @@ void HTTPResourceRequest::onRequestFinished() {
         return { true, contentTypeParts[0] };
     };
 
-    switch(_reply->error()) {
+    switch(reply->error()) {
         case QNetworkReply::NoError:
-            _data = _reply->readAll();
-            _loadedFromCache = _reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
+            _data = data;
+            _loadedFromCache = reply->attribute(QNetworkRequest::SourceIsFromCacheAttribute).toBool();
             _result = Success;
 
             if (_byteRange.isSet()) {
-                auto statusCode = _reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+                auto statusCode = reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
                 if (statusCode == 206) {
                     _rangeRequestSuccessful = true;
-                    auto contentRangeHeader = _reply->rawHeader("Content-Range");
+                    auto contentRangeHeader = reply->rawHeader("Content-Range");
                     bool success;
                     uint64_t size;
                     std::tie(success, size) = parseContentRangeHeader(contentRangeHeader);
@@ -152,7 +300,7 @@ void HTTPResourceRequest::onRequestFinished() {
             }
 
             {
-                auto contentTypeHeader = _reply->rawHeader("Content-Type");
+                auto contentTypeHeader = reply->rawHeader("Content-Type");
                 bool success;
                 QString mediaType;
                 std::tie(success, mediaType) = parseMediaType(contentTypeHeader);
@@ -193,17 +341,58 @@ void HTTPResourceRequest::onRequestFinished() {
         case QNetworkReply::UnknownServerError: // Script.include('QUrl("https://httpbin.org/status/504")')
         case QNetworkReply::InternalServerError: // Script.include('QUrl("https://httpbin.org/status/500")')
         default:
-            qCDebug(networking) << "HTTPResourceRequest error:" << QMetaEnum::fromType<QNetworkReply::NetworkError>().valueToKey(_reply->error());
+            qCDebug(networking) << "HTTPResourceRequest error:" << QMetaEnum::fromType<QNetworkReply::NetworkError>().valueToKey(reply->error());
             _result = Error;
             break;
     }
-    _reply->disconnect(this);
-    _reply->deleteLater();
-    _reply = nullptr;
-    
+}
+
+void HTTPResourceRequest::finish() {
+    cleanupTimer();
+    releaseReplies();
+
+    _isFetching = false;
+    fetchingRequests.remove(getFetchKey());
+
+    {
+        std::lock_guard<std::mutex> lock(hostStatsMutex);
+        auto& stats = hostStats[_url.host()];
+        stats.requests++;
+        if (_result == Success && !_loadedFromCache) {
+            stats.bytes += _data.size();
+            stats.msecs += _fetchTimer.elapsed();
+        }
+    }
+
     _state = Finished;
     emit finished();
 
+    recordOutcomeInStats();
+    finishFollowers();
+}
+
+void HTTPResourceRequest::finishFollowers() {
+    auto followers = std::move(_followers);
+    _followers.clear();
+    for (const auto& follower : followers) {
+        if (!follower) {
+            continue;
+        }
+        Q_ASSERT(follower->_state == InProgress);
+        follower->_data = _data;
+        follower->_result = _result;
+        follower->_loadedFromCache = _loadedFromCache;
+        follower->_rangeRequestSuccessful = _rangeRequestSuccessful;
+        follower->_totalSizeOfResource = _totalSizeOfResource;
+        follower->_webMediaType = _webMediaType;
+        follower->_state = Finished;
+        // the stats go first, as the follower may be deleted by what it finishing triggers
+        follower->recordOutcomeInStats();
+        emit follower->finished();
+    }
+}
+
+void HTTPResourceRequest::recordOutcomeInStats() {
     auto statTracker = DependencyManager::get<StatTracker>();
     if (_result == Success) {
         statTracker->incrementStat(STAT_HTTP_REQUEST_SUCCESS);
@@ -223,23 +412,19 @@ void HTTPResourceRequest::onDownloadProgress(qint64 bytesReceived, qint64 bytesT
     _sendTimer->start();
 
     emit progress(bytesReceived, bytesTotal);
+    for (const auto& follower : _followers) {
+        if (follower) {
+            emit follower->progress(bytesReceived, bytesTotal);
+        }
+    }
 
     recordBytesDownloadedInStats(STAT_HTTP_RESOURCE_TOTAL_BYTES, bytesReceived);
 }
 
 void HTTPResourceRequest::onTimeout() {
-    qDebug() << "Timeout: " << _reply->isFinished();
+    qDebug() << "Timeout: " << _url;
     Q_ASSERT(_state == InProgress);
-    _reply->disconnect(this);
-    _reply->abort();
-    _reply->deleteLater();
-    _reply = nullptr;
 
-    cleanupTimer();
-    
     _result = Timeout;
-    _state = Finished;
-    emit finished();
-
-    DependencyManager::get<StatTracker>()->incrementStat(STAT_HTTP_REQUEST_FAILED);
+    finish();
 }
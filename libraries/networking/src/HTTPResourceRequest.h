@@ -12,9 +12,14 @@
 #ifndef hifi_HTTPResourceRequest_h
 #define hifi_HTTPResourceRequest_h
 
+#include <vector>
+
+#include <QElapsedTimer>
 #include <QNetworkReply>
+#include <QPointer>
 #include <QUrl>
 #include <QTimer>
+#include <QVariantMap>
 
 #include "ResourceRequest.h"
 
@@ -29,20 +34,42 @@ public:
     ) : ResourceRequest(url, isObservable, callerId) { }
     ~HTTPResourceRequest();
 
+    // Bytes downloaded, time spent downloading and number of requests made, by host, since startup. Requests answered
+    // by another request for the same data in flight aren't counted.
+    static QVariantMap getHostStats();
+
 protected:
     virtual void doSend() override;
 
 private slots:
     void onTimeout();
     void onDownloadProgress(qint64 bytesReceived, qint64 bytesTotal);
-    void onRequestFinished();
 
 private:
+    QString getFetchKey() const;
+    void startFetch();
+    void onReplyFinished(QNetworkReply* reply);
+    void processReply(QNetworkReply* reply, QByteArray data);
+    void releaseReplies();
+    void finish();
+    void finishFollowers();
+    void recordOutcomeInStats();
+
     void setupTimer();
     void cleanupTimer();
 
     QTimer* _sendTimer { nullptr };
-    QNetworkReply* _reply { nullptr };
+
+    // Large closed byte ranges are fetched as several smaller ranges at once, in order
+    std::vector<QNetworkReply*> _replies;
+    std::vector<QByteArray> _replyData;
+    std::vector<qint64> _replyBytesReceived;
+    size_t _finishedReplyCount { 0 };
+
+    // Requests for the same data made while this one is fetching it, which get its result rather than fetching it again
+    std::vector<QPointer<HTTPResourceRequest>> _followers;
+    bool _isFetching { false };
+    QElapsedTimer _fetchTimer;
 };
 
 #endif
@@ -16,6 +16,7 @@
 #include <cstring>
 #include <cstdlib>
 #include <cstdio>
+#include <mutex>
 
 #include <QtCore/QDataStream>
 #include <QtCore/QDebug>
@@ -38,6 +39,7 @@
 #include "SockAddr.h"
 #include "NetworkLogging.h"
 #include "udt/Packet.h"
+#include "udt/PacketCoalescer.h"
 #include "HMACAuth.h"
 
 #if defined(Q_OS_WIN)
@@ -51,6 +53,9 @@ static Setting::Handle<quint16> LIMITED_NODELIST_LOCAL_PORT("LimitedNodeList.Loc
 using namespace std::chrono_literals;
 static const std::chrono::milliseconds CONNECTION_RATE_INTERVAL_MS = 1s;
 
+static const int FEC_FEEDBACK_INTERVAL_MSECS = 1000;
+static const quint64 FEC_DECODER_TIMEOUT_USECS = 10 * USECS_PER_SECOND;
+
 LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     _nodeSocket(this, true),
     _packetReceiver(new PacketReceiver(this))
@@ -97,11 +102,23 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     connect(delayedAddsFlushTimer, &QTimer::timeout, this, &NodeList::processDelayedAdds);
     delayedAddsFlushTimer->start(CONNECTION_RATE_INTERVAL_MS.count());
 
+    // tell the nodes we get protectable packets from how many we lose
+    QTimer* fecFeedbackTimer = new QTimer(this);
+    connect(fecFeedbackTimer, &QTimer::timeout, this, &LimitedNodeList::sendFECFeedback);
+    fecFeedbackTimer->start(FEC_FEEDBACK_INTERVAL_MSECS);
+
     // check the local socket right now
     updateLocalSocket();
 
     // set &PacketReceiver::handleVerifiedPacket as the verified packet callback for the udt::Socket
     _nodeSocket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
+            if (NLPacket::typeInHeader(*packet) == PacketType::CoalescedPackets) {
+                processCoalescedPackets(*packet);
+                return;
+            }
+            if (_isForwardErrorCorrectionEnabled && !processForwardErrorCorrection(*packet)) {
+                return;
+            }
             _packetReceiver->handleVerifiedPacket(std::move(packet));
     });
     _nodeSocket.setMessageHandler([this](std::unique_ptr<udt::Packet> packet) {
@@ -115,10 +132,27 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     // set our isPacketVerified method as the verify operator for the udt::Socket
     using std::placeholders::_1;
     _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
+    _nodeSocket.setPacketBatchFilterOperator([this](const std::vector<const udt::Packet*>& packets,
+                                                    std::vector<bool>& isVerified) {
+        verifyPacketBatch(packets, isVerified);
+    });
+    _nodeSocket.setConcurrentPacketBatchFilterOperator([this](const std::vector<const udt::Packet*>& packets,
+                                                              std::vector<udt::PacketVerification>& verifications) {
+        verifyPacketBatchConcurrently(packets, verifications);
+    });
 
     // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
     _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
 
+    // a secure session with a node is authenticated with the secret the domain server gave both of us
+    _nodeSocket.setPreSharedKeyOperator([this](const SockAddr& sockAddr) {
+        auto node = findNodeWithAddr(sockAddr);
+        if (node.isNull() || node->getConnectionSecret().isNull()) {
+            return QByteArray();
+        }
+        return node->getConnectionSecret().toRfc4122();
+    });
+
     // handle when a socket connection has its receiver side reset - might need to emit clientConnectionToNodeReset
     connect(&_nodeSocket, &udt::Socket::clientHandshakeRequestComplete, this, &LimitedNodeList::clientConnectionToSockAddrReset);
 
@@ -260,6 +294,65 @@ bool LimitedNodeList::isPacketVerifiedWithSource(const udt::Packet& packet, Node
     return packetVersionMatch(packet) && packetSourceAndHashMatchAndTrackBandwidth(packet, sourceNode);
 }
 
+void LimitedNodeList::verifyPacketBatch(const std::vector<const udt::Packet*>& packets, std::vector<bool>& isVerified) {
+    // the packets of a receive batch mostly come from a handful of nodes, and often a run of them from the same one,
+    // so look each source up once per run instead of taking the node hash lock for every packet
+    NLPacket::LocalID lastSourceLocalID = Node::NULL_LOCAL_ID;
+    SharedNodePointer lastSourceNode;
+
+    for (size_t i = 0; i < packets.size(); ++i) {
+        auto& packet = *packets[i];
+
+        if (PacketTypeEnum::getNonSourcedPackets().contains(NLPacket::typeInHeader(packet))) {
+            isVerified[i] = isPacketVerifiedWithSource(packet);
+            continue;
+        }
+
+        auto sourceLocalID = NLPacket::sourceIDInHeader(packet);
+        if (!lastSourceNode || sourceLocalID != lastSourceLocalID) {
+            lastSourceLocalID = sourceLocalID;
+            lastSourceNode = nodeWithLocalID(sourceLocalID);
+        }
+
+        isVerified[i] = isPacketVerifiedWithSource(packet, lastSourceNode.data());
+    }
+}
+
+void LimitedNodeList::verifyPacketBatchConcurrently(const std::vector<const udt::Packet*>& packets,
+                                                    std::vector<udt::PacketVerification>& verifications) {
+    // This runs on the socket's receive threads, so it only verifies the packets of nodes in the node hash, reading
+    // the hash under its lock and, of the node, its UUID, which is set before it's added, its HMAC, which lives as long as
+    // the node and is only rekeyed under its own lock, and its atomic last heard time. The debug maps of mismatched
+    // versions and hashes are behind their own mutexes. Packets without a source, from the domain server or from nodes that aren't added yet are checked
+    // against upstream node sockets, the domain handler and the delayed node adds, which belong to this list's
+    // thread, so they're deferred to it.
+    NLPacket::LocalID lastSourceLocalID = Node::NULL_LOCAL_ID;
+    SharedNodePointer lastSourceNode;
+
+    for (size_t i = 0; i < packets.size(); ++i) {
+        auto& packet = *packets[i];
+
+        if (PacketTypeEnum::getNonSourcedPackets().contains(NLPacket::typeInHeader(packet))) {
+            verifications[i] = udt::PacketVerification::Deferred;
+            continue;
+        }
+
+        auto sourceLocalID = NLPacket::sourceIDInHeader(packet);
+        if (!lastSourceNode || sourceLocalID != lastSourceLocalID) {
+            lastSourceLocalID = sourceLocalID;
+            lastSourceNode = nodeWithLocalID(sourceLocalID);
+        }
+
+        if (!lastSourceNode) {
+            verifications[i] = udt::PacketVerification::Deferred;
+            continue;
+        }
+
+        verifications[i] = isPacketVerifiedWithSource(packet, lastSourceNode.data()) ? udt::PacketVerification::Verified
+                                                                                    : udt::PacketVerification::Rejected;
+    }
+}
+
 bool LimitedNodeList::packetVersionMatch(const udt::Packet& packet) {
     PacketType headerType = NLPacket::typeInHeader(packet);
     PacketVersion headerVersion = NLPacket::versionInHeader(packet);
@@ -268,6 +361,9 @@ bool LimitedNodeList::packetVersionMatch(const udt::Packet& packet) {
 
         static QMultiHash<QUuid, PacketType> sourcedVersionDebugSuppressMap;
         static QMultiHash<SockAddr, PacketType> versionDebugSuppressMap;
+        // packets can be verified on the socket's receive threads
+        static std::mutex debugSuppressMutex;
+        std::lock_guard<std::mutex> debugSuppressLock(debugSuppressMutex);
 
         bool hasBeenOutput = false;
         QString senderString;
@@ -370,18 +466,21 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
 
             if (verifiedPacket && verificationEnabled) {
 
-                QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
-                QByteArray expectedHash;
                 auto sourceNodeHMACAuth = sourceNode->getAuthenticateHash();
-                if (sourceNode->getAuthenticateHash()) {
-                    expectedHash = NLPacket::hashForPacketAndHMAC(packet, *sourceNodeHMACAuth);
-                }
 
                 // check if the HMAC-md5 hash in the header matches the hash we would expect
-                if (!sourceNodeHMACAuth || packetHeaderHash != expectedHash) {
+                if (!sourceNodeHMACAuth || !NLPacket::verificationHashMatches(packet, *sourceNodeHMACAuth)) {
                     static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
+                    static std::mutex hashDebugSuppressMutex;
+                    std::lock_guard<std::mutex> hashDebugSuppressLock(hashDebugSuppressMutex);
 
                     if (!hashDebugSuppressMap.contains(sourceID, headerType)) {
+                        QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
+                        QByteArray expectedHash;
+                        if (sourceNodeHMACAuth) {
+                            expectedHash = NLPacket::hashForPacketAndHMAC(packet, *sourceNodeHMACAuth);
+                        }
+
                         qCDebug(networking) << "Packet hash mismatch on" << headerType << "- Sender" << sourceID;
                         qCDebug(networking) << "Packet len:" << packet.getDataSize() << "Expected hash:" <<
                             expectedHash.toHex() << "Actual:" << packetHeaderHash.toHex();
@@ -458,6 +557,15 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const Node&
     auto activeSocket = destinationNode.getActiveSocket();
 
     if (activeSocket) {
+        if (!packet->isReliable() && destinationNode.getFECEncoder().isEnabled()
+            && PacketTypeEnum::getForwardErrorCorrectedPackets().contains(packet->getType())) {
+            // the parity is of the packet as it went out, with its header and sequence number
+            auto size = sendUnreliablePacket(*packet, *activeSocket, destinationNode.getAuthenticateHash());
+            if (!_dropOutgoingNodeTraffic) {
+                sendParity(*packet, destinationNode);
+            }
+            return size;
+        }
         return sendPacket(std::move(packet), *activeSocket, destinationNode.getAuthenticateHash());
     } else {
         qCDebug(networking) << "LimitedNodeList::sendPacket called without active socket for node" << destinationNode << "- not sending";
@@ -494,6 +602,92 @@ qint64 LimitedNodeList::sendPacket(std::unique_ptr<NLPacket> packet, const SockA
     }
 }
 
+void LimitedNodeList::sendParity(const NLPacket& packet, const Node& destinationNode) {
+    for (auto& payload : destinationNode.getFECEncoder().protect(packet)) {
+        auto parityPacket = NLPacket::create(PacketType::FECParity, payload.size());
+        parityPacket->write(payload);
+        sendUnreliablePacket(*parityPacket, destinationNode);
+    }
+}
+
+bool LimitedNodeList::processForwardErrorCorrection(const udt::Packet& packet) {
+    PacketType headerType = NLPacket::typeInHeader(packet);
+
+    if (headerType == PacketType::FECParity) {
+        auto headerSize = NLPacket::totalHeaderSize(headerType);
+        auto& decoder = _fecDecoders[packet.getSenderSockAddr()];
+        auto recoveredPacket = decoder.parityReceived(packet.getData() + headerSize,
+                                                      (int)packet.getDataSize() - headerSize,
+                                                      packet.getSenderSockAddr());
+
+        // the rebuilt packet goes through the same checks as if it had arrived
+        if (recoveredPacket && isPacketVerified(*recoveredPacket)) {
+            _packetReceiver->handleVerifiedPacket(std::move(recoveredPacket));
+        }
+
+        // nothing else listens for parity
+        return false;
+    } else if (PacketTypeEnum::getForwardErrorCorrectedPackets().contains(headerType)) {
+        return _fecDecoders[packet.getSenderSockAddr()].packetReceived(packet);
+    }
+
+    return true;
+}
+
+void LimitedNodeList::setPacketCoalescingEnabled(bool isEnabled) {
+    QByteArray header;
+    if (isEnabled) {
+        auto packet = NLPacket::create(PacketType::CoalescedPackets, 0);
+        header = QByteArray(packet->getData() + udt::Packet::totalHeaderSize(),
+                            NLPacket::localHeaderSize(PacketType::CoalescedPackets));
+    }
+    _nodeSocket.setPacketCoalescingHeader(header);
+}
+
+void LimitedNodeList::processCoalescedPackets(const udt::Packet& packet) {
+    auto headerSize = NLPacket::totalHeaderSize(PacketType::CoalescedPackets);
+    for (auto& coalescedPacket : udt::PacketCoalescer::split(packet, headerSize)) {
+        // each packet goes through the same checks as if it had arrived on its own
+        if (!isPacketVerified(*coalescedPacket)) {
+            continue;
+        }
+
+        if (coalescedPacket->isPartOfMessage()) {
+            _packetReceiver->handleVerifiedMessagePacket(std::move(coalescedPacket));
+        } else {
+            _packetReceiver->handleVerifiedPacket(std::move(coalescedPacket));
+        }
+    }
+}
+
+void LimitedNodeList::sendFECFeedback() {
+    if (!_isForwardErrorCorrectionEnabled) {
+        return;
+    }
+
+    auto now = usecTimestampNow();
+    for (auto it = _fecDecoders.begin(); it != _fecDecoders.end();) {
+        auto& decoder = it->second;
+        if (now - decoder.getLastReceivedUsecs() > FEC_DECODER_TIMEOUT_USECS) {
+            // the sender went away, or stopped sending us anything we could protect
+            it = _fecDecoders.erase(it);
+            continue;
+        }
+
+        decoder.pushStatsToHistory();
+
+        auto sourceNode = findNodeWithAddr(it->first);
+        if (sourceNode) {
+            // this is also what has the sender start protecting what it sends us
+            auto feedbackPacket = NLPacket::create(PacketType::FECFeedback, sizeof(float));
+            feedbackPacket->writePrimitive(decoder.getLossRate());
+            sendPacket(std::move(feedbackPacket), *sourceNode);
+        }
+
+        ++it;
+    }
+}
+
 qint64 LimitedNodeList::sendUnreliableUnorderedPacketList(NLPacketList& packetList, const Node& destinationNode) {
     auto activeSocket = destinationNode.getActiveSocket();
 
@@ -600,44 +794,36 @@ NodeData* LimitedNodeList::getOrCreateLinkedData(SharedNodePointer node) {
 }
 
 SharedNodePointer LimitedNodeList::nodeWithUUID(const QUuid& nodeUUID) {
-    QReadLocker readLocker(&_nodeMutex);
-
-    NodeHash::const_iterator it = _nodeHash.find(nodeUUID);
-    return it == _nodeHash.cend() ? SharedNodePointer() : it->second;
- }
+    return getNodeTable()->nodeWithUUID(nodeUUID);
+}
 
 SharedNodePointer LimitedNodeList::nodeWithLocalID(Node::LocalID localID) const {
-    QReadLocker readLocker(&_nodeMutex);
-
-    LocalIDMapping::const_iterator idIter = _localIDMap.find(localID);
-    return idIter == _localIDMap.cend() ? nullptr : idIter->second;
+    return getNodeTable()->nodeWithLocalID(localID);
 }
 
 void LimitedNodeList::eraseAllNodes(QString reason) {
     std::vector<SharedNodePointer> killedNodes;
 
     {
-        // iterate the current nodes - grab them so we can emit that they are dying
-        // and then remove them from the hash
-        QWriteLocker writeLocker(&_nodeMutex);
-
-        if (_nodeHash.size() > 0) {
-            qCDebug(networking) << "LimitedNodeList::eraseAllNodes() removing all nodes from NodeList:" << reason;
-
-            killedNodes.reserve(_nodeHash.size());
-            for (auto& pair : _nodeHash) {
-                killedNodes.push_back(pair.second);
+        // grab the current nodes so we can emit that they are dying
+        // and then remove them from the table
+        editNodeTable([&](NodeTable& table) {
+            if (table.size() > 0) {
+                qCDebug(networking) << "LimitedNodeList::eraseAllNodes() removing all nodes from NodeList:" << reason;
+                killedNodes = table.nodes();
             }
-        }
-        _localIDMap.clear();
-        _nodeHash.clear();
+            table.clear();
+        });
     }
 
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         handleNodeKill(killedNode);
     }
 
-    _delayedNodeAdds.clear();
+    {
+        std::lock_guard<std::mutex> delayedNodeAddsLock(_delayedNodeAddsMutex);
+        _delayedNodeAdds.clear();
+    }
 }
 
 void LimitedNodeList::reset(QString reason) {
@@ -652,11 +838,9 @@ bool LimitedNodeList::killNodeWithUUID(const QUuid& nodeUUID, ConnectionID newCo
     auto matchingNode = nodeWithUUID(nodeUUID);
 
     if (matchingNode) {
-        {
-            QWriteLocker writeLocker(&_nodeMutex);
-            _localIDMap.unsafe_erase(matchingNode->getLocalID());
-            _nodeHash.unsafe_erase(matchingNode->getUUID());
-        }
+        editNodeTable([&](NodeTable& table) {
+            table.erase(matchingNode);
+        });
 
         handleNodeKill(matchingNode, newConnectionID);
         return true;
@@ -677,6 +861,7 @@ void LimitedNodeList::handleNodeKill(const SharedNodePointer& node, ConnectionID
     _nodeDisconnectTimestamp = usecTimestampNow();
     qCDebug(networking) << "Killed" << *node;
     node->stopPingTimer();
+    notifyOtherNodes(*node, false);
     emit nodeKilled(node);
 
     if (auto activeSocket = node->getActiveSocket()) {
@@ -693,6 +878,18 @@ void LimitedNodeList::handleNodeKill(const SharedNodePointer& node, ConnectionID
     }
 }
 
+void LimitedNodeList::notifyOtherNodes(const Node& node, bool isAdded) {
+    for (const auto& otherNode : getNodeTable()->nodes()) {
+        if (otherNode.data() != &node) {
+            if (isAdded) {
+                otherNode->otherNodeAdded(node);
+            } else {
+                otherNode->otherNodeKilled(node);
+            }
+        }
+    }
+}
+
 SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t nodeType,
                                                    const SockAddr& publicSocket, const SockAddr& localSocket,
                                                    Node::LocalID localID, bool isReplicated, bool isUpstream,
@@ -705,32 +902,37 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         matchingNode->setConnectionSecret(connectionSecret);
         matchingNode->setIsReplicated(isReplicated);
         matchingNode->setIsUpstream(isUpstream || NodeType::isUpstream(nodeType));
-        matchingNode->setLocalID(localID);
+        if (matchingNode->getLocalID() != localID) {
+            notifyOtherNodes(*matchingNode, false);
+            matchingNode->setLocalID(localID);
+            notifyOtherNodes(*matchingNode, true);
+        }
 
         return matchingNode;
     }
 
     auto removeOldNode = [&](auto node) {
         if (node) {
-            {
-                QWriteLocker writeLocker(&_nodeMutex);
-                _localIDMap.unsafe_erase(node->getLocalID());
-                _nodeHash.unsafe_erase(node->getUUID());
-            }
+            editNodeTable([&](NodeTable& table) {
+                table.erase(node);
+            });
             handleNodeKill(node);
         }
     };
 
     // if this is a solo node type, we assume that the DS has replaced its assignment and we should kill the previous node
-    if (SOLO_NODE_TYPES.count(nodeType)) {
+    if (isSoloNodeType(nodeType)) {
         removeOldNode(soloNodeOfType(nodeType));
     }
-    // If there is a new node with the same socket, this is a reconnection, kill the old node
-    removeOldNode(findNodeWithAddr(publicSocket));
-    removeOldNode(findNodeWithAddr(localSocket));
-    // If there is an old Connection to the new node's address kill it
-    _nodeSocket.cleanupConnection(publicSocket);
-    _nodeSocket.cleanupConnection(localSocket);
+    // replicated nodes all have the socket of the mixer they are replicated from, and have no connection of their own
+    if (!isReplicated) {
+        // If there is a new node with the same socket, this is a reconnection, kill the old node
+        removeOldNode(findNodeWithAddr(publicSocket));
+        removeOldNode(findNodeWithAddr(localSocket));
+        // If there is an old Connection to the new node's address kill it
+        _nodeSocket.cleanupConnection(publicSocket);
+        _nodeSocket.cleanupConnection(localSocket);
+    }
 
     auto it = _connectionIDs.find(uuid);
     if (it == _connectionIDs.end()) {
@@ -755,12 +957,10 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
     SharedNodePointer newNodePointer(newNode, &QObject::deleteLater);
 
 
-    {
-        QReadLocker readLocker(&_nodeMutex);
-        // insert the new node and release our read lock
-        _nodeHash.insert({ newNode->getUUID(), newNodePointer });
-        _localIDMap.insert({ localID, newNodePointer });
-    }
+    editNodeTable([&](NodeTable& table) {
+        table.insert(newNodePointer, localID);
+    });
+    notifyOtherNodes(*newNode, true);
 
     qCDebug(networking) << "Added" << *newNode;
 
@@ -803,10 +1003,12 @@ void LimitedNodeList::addNewNode(NewNodeInfo info) {
 }
 
 void LimitedNodeList::delayNodeAdd(NewNodeInfo info) {
+    std::lock_guard<std::mutex> delayedNodeAddsLock(_delayedNodeAddsMutex);
     _delayedNodeAdds.push_back(info);
 }
 
 void LimitedNodeList::removeDelayedAdd(QUuid nodeUUID) {
+    std::lock_guard<std::mutex> delayedNodeAddsLock(_delayedNodeAddsMutex);
     auto it = std::find_if(_delayedNodeAdds.begin(), _delayedNodeAdds.end(), [&](const auto& info) {
         return info.uuid == nodeUUID;
     });
@@ -816,6 +1018,7 @@ void LimitedNodeList::removeDelayedAdd(QUuid nodeUUID) {
 }
 
 bool LimitedNodeList::isDelayedNode(QUuid nodeUUID) {
+    std::lock_guard<std::mutex> delayedNodeAddsLock(_delayedNodeAddsMutex);
     auto it = std::find_if(_delayedNodeAdds.begin(), _delayedNodeAdds.end(), [&](const auto& info) {
         return info.uuid == nodeUUID;
     });
@@ -825,14 +1028,20 @@ bool LimitedNodeList::isDelayedNode(QUuid nodeUUID) {
 void LimitedNodeList::processDelayedAdds() {
     _nodesAddedInCurrentTimeSlice = 0;
 
-    auto nodesToAdd = glm::min(_delayedNodeAdds.size(), _maxConnectionRate);
-    auto firstNodeToAdd = _delayedNodeAdds.begin();
-    auto lastNodeToAdd = firstNodeToAdd + nodesToAdd;
+    // taken out first, as adding a node can delay it again
+    std::vector<NewNodeInfo> nodesToAdd;
+    {
+        std::lock_guard<std::mutex> delayedNodeAddsLock(_delayedNodeAddsMutex);
+        auto numNodesToAdd = glm::min(_delayedNodeAdds.size(), _maxConnectionRate);
+        auto firstNodeToAdd = _delayedNodeAdds.begin();
+        auto lastNodeToAdd = firstNodeToAdd + numNodesToAdd;
+        nodesToAdd.assign(firstNodeToAdd, lastNodeToAdd);
+        _delayedNodeAdds.erase(firstNodeToAdd, lastNodeToAdd);
+    }
 
-    for (auto it = firstNodeToAdd; it != lastNodeToAdd; ++it) {
-        addNewNode(*it);
+    for (const auto& info : nodesToAdd) {
+        addNewNode(info);
     }
-    _delayedNodeAdds.erase(firstNodeToAdd, lastNodeToAdd);
 }
 
 std::unique_ptr<NLPacket> LimitedNodeList::constructPingPacket(const QUuid& nodeId, PingType_t pingType) {
@@ -917,24 +1126,25 @@ void LimitedNodeList::removeSilentNodes() {
 
     auto startedAt = usecTimestampNow();
 
-    eachNodeHashIterator([&](NodeHash::iterator& it){
-        SharedNodePointer node = it->second;
-        node->getMutex().lock();
-
-        if (!node->isForcedNeverSilent()
-            && (usecTimestampNow() - node->getLastHeardMicrostamp()) > (NODE_SILENCE_THRESHOLD_MSECS * USECS_PER_MSEC)) {
-            // call the NodeHash erase to get rid of this node
-            _localIDMap.unsafe_erase(node->getLocalID());
-            it = _nodeHash.unsafe_erase(it);
-
-            killedNodes.insert(node);
-        } else {
-            // we didn't erase this node, push the iterator forwards
-            ++it;
-        }
+    auto isSilent = [](const SharedNodePointer& node) {
+        QMutexLocker locker(&node->getMutex());
+        return !node->isForcedNeverSilent()
+            && (usecTimestampNow() - node->getLastHeardMicrostamp()) > (NODE_SILENCE_THRESHOLD_MSECS * USECS_PER_MSEC);
+    };
 
-        node->getMutex().unlock();
-    });
+    // only publish a new node table when there is a silent node to remove
+    if (nodeMatchingPredicate(isSilent)) {
+        editNodeTable([&](NodeTable& table) {
+            for (const SharedNodePointer& node : table.nodes()) {
+                if (isSilent(node)) {
+                    killedNodes.insert(node);
+                }
+            }
+            for (const SharedNodePointer& node : killedNodes) {
+                table.erase(node);
+            }
+        });
+    }
 
     foreach(const SharedNodePointer& killedNode, killedNodes) {
         auto now = usecTimestampNow();
@@ -1307,23 +1517,15 @@ void LimitedNodeList::sendPeerQueryToIceServer(const SockAddr& iceServerSockAddr
 }
 
 SharedNodePointer LimitedNodeList::findNodeWithAddr(const SockAddr& addr) {
-    QReadLocker locker(&_nodeMutex);
-    auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&addr](const UUIDNodePair& pair) {
-        return pair.second->getPublicSocket() == addr
-            || pair.second->getLocalSocket() == addr
-            || pair.second->getSymmetricSocket() == addr;
+    return nodeMatchingPredicate([&addr](const SharedNodePointer& node) {
+        return node->getPublicSocket() == addr
+            || node->getLocalSocket() == addr
+            || node->getSymmetricSocket() == addr;
     });
-    return (it != std::end(_nodeHash)) ? it->second : SharedNodePointer();
 }
 
 bool LimitedNodeList::sockAddrBelongsToNode(const SockAddr& sockAddr) {
-    QReadLocker locker(&_nodeMutex);
-    auto it = std::find_if(std::begin(_nodeHash), std::end(_nodeHash), [&sockAddr](const UUIDNodePair& pair) {
-        return pair.second->getPublicSocket() == sockAddr
-            || pair.second->getLocalSocket() == sockAddr
-            || pair.second->getSymmetricSocket() == sockAddr;
-    });
-    return it != std::end(_nodeHash);
+    return !findNodeWithAddr(sockAddr).isNull();
 }
 
 void LimitedNodeList::sendPacketToIceServer(PacketType packetType, const SockAddr& iceServerSockAddr,
@@ -18,6 +18,7 @@
 #include <stdint.h>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <unordered_map>
 
@@ -43,6 +44,7 @@
 #include "Node.h"
 #include "NLPacket.h"
 #include "NLPacketList.h"
+#include "NodeTable.h"
 #include "PacketReceiver.h"
 #include "ReceivedMessage.h"
 #include "udt/ControlPacket.h"
@@ -73,9 +75,6 @@ using ConnectionID = int64_t;
 const ConnectionID NULL_CONNECTION_ID { -1 };
 const ConnectionID INITIAL_CONNECTION_ID { 0 };
 
-typedef std::pair<QUuid, SharedNodePointer> UUIDNodePair;
-typedef tbb::concurrent_unordered_map<QUuid, SharedNodePointer, UUIDHasher> NodeHash;
-
 typedef quint8 PingType_t;
 namespace PingType {
     const PingType_t Agnostic = 0;
@@ -153,11 +152,20 @@ public:
     virtual Node::LocalID getDomainLocalID() const { assert(false); return Node::NULL_LOCAL_ID; }
     virtual SockAddr getDomainSockAddr() const { assert(false); return SockAddr(); }
 
+    // a node of a solo type replaces the one we had of that type, as the domain-server has replaced its assignment
+    virtual bool isSoloNodeType(NodeType_t nodeType) const {
+        // the domain-server itself runs several mixers of a type when they have a hot standby or are sharded
+        return SOLO_NODE_TYPES.count(nodeType) > 0 && nodeType != NodeType::AvatarMixer && nodeType != NodeType::AudioMixer;
+    }
+
     // use sendUnreliablePacket to send an unreliable packet (that you do not need to move)
     // either to a node (via its active socket) or to a manual sockaddr
     qint64 sendUnreliablePacket(const NLPacket& packet, const Node& destinationNode);
     qint64 sendUnreliablePacket(const NLPacket& packet, const SockAddr& sockAddr, HMACAuth* hmacAuth = nullptr);
 
+    // while the returned batch is alive, unreliable packets sent from the calling thread are flushed together
+    udt::Socket::SendBatch batchUnreliableSends() { return udt::Socket::SendBatch(_nodeSocket); }
+
     // use sendPacket to send a moved unreliable or reliable NL packet to a node's active socket or manual sockaddr
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const Node& destinationNode);
     qint64 sendPacket(std::unique_ptr<NLPacket> packet, const SockAddr& sockAddr, HMACAuth* hmacAuth = nullptr);
@@ -175,7 +183,11 @@ public:
 
     std::function<void(Node*)> linkedDataCreateCallback;
 
-    size_t size() const { QReadLocker readLock(&_nodeMutex); return _nodeHash.size(); }
+    size_t size() const { return getNodeTable()->size(); }
+
+    // The current snapshot of the nodes. It never changes, and stays valid for as long as it is held,
+    // while nodes keep being added and removed.
+    NodeTablePointer getNodeTable() const { return std::atomic_load(&_nodeTable); }
 
     SharedNodePointer nodeWithUUID(const QUuid& nodeUUID);
     SharedNodePointer nodeWithLocalID(Node::LocalID localID) const;
@@ -214,10 +226,8 @@ public:
     using value_type = SharedNodePointer;
     using const_iterator = std::vector<value_type>::const_iterator;
 
-    // Cede control of iteration under a single read lock (e.g. for use by thread pools)
-    // Use this for nested loops instead of taking nested read locks!
-    //   This allows multiple threads (i.e. a thread pool) to share a lock
-    //   without deadlocking when a dying node attempts to acquire a write lock
+    // Cede control of iteration over a single snapshot of the nodes (e.g. for use by thread pools)
+    // Use this for nested loops, so every thread sees the same set of nodes during a frame
     template<typename NestedNodeLambda>
     void nestedEach(NestedNodeLambda functor,
                     int* lockWaitOut = nullptr,
@@ -226,29 +236,17 @@ public:
         quint64 start, endTransform, endFunctor;
 
         start = usecTimestampNow();
-        std::vector<SharedNodePointer> nodes;
-        {
-            QReadLocker readLock(&_nodeMutex);
-            auto endLock = usecTimestampNow();
-            if (lockWaitOut) {
-                *lockWaitOut = (endLock - start);
-            }
+        NodeTablePointer table = getNodeTable();
 
-            // Size of _nodeHash could change at any time,
-            // so reserve enough memory for the current size
-            // and then back insert all the nodes found
-            nodes.reserve(_nodeHash.size());
-            std::transform(_nodeHash.cbegin(), _nodeHash.cend(), std::back_inserter(nodes), [&](const NodeHash::value_type& it) {
-                return it.second;
-            });
-
-            endTransform = usecTimestampNow();
-            if (nodeTransformOut) {
-                *nodeTransformOut = (endTransform - endLock);
-            }
+        endTransform = usecTimestampNow();
+        if (lockWaitOut) {
+            *lockWaitOut = (endTransform - start);
+        }
+        if (nodeTransformOut) {
+            *nodeTransformOut = 0;
         }
 
-        functor(nodes.cbegin(), nodes.cend());
+        functor(table->nodes().cbegin(), table->nodes().cend());
         endFunctor = usecTimestampNow();
         if (functorOut) {
             *functorOut = (endFunctor - endTransform);
@@ -257,30 +255,30 @@ public:
 
     template<typename NodeLambda>
     void eachNode(NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeTablePointer table = getNodeTable();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
+        for (const SharedNodePointer& node : table->nodes()) {
+            functor(node);
         }
     }
 
     template<typename PredLambda, typename NodeLambda>
     void eachMatchingNode(PredLambda predicate, NodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeTablePointer table = getNodeTable();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                functor(it->second);
+        for (const SharedNodePointer& node : table->nodes()) {
+            if (predicate(node)) {
+                functor(node);
             }
         }
     }
 
     template<typename BreakableNodeLambda>
     void eachNodeBreakable(BreakableNodeLambda functor) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeTablePointer table = getNodeTable();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (!functor(it->second)) {
+        for (const SharedNodePointer& node : table->nodes()) {
+            if (!functor(node)) {
                 break;
             }
         }
@@ -288,25 +286,21 @@ public:
 
     template<typename PredLambda>
     SharedNodePointer nodeMatchingPredicate(const PredLambda predicate) {
-        QReadLocker readLock(&_nodeMutex);
+        NodeTablePointer table = getNodeTable();
 
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            if (predicate(it->second)) {
-                return it->second;
+        for (const SharedNodePointer& node : table->nodes()) {
+            if (predicate(node)) {
+                return node;
             }
         }
 
         return SharedNodePointer();
     }
 
-    // This is unsafe because it does not take a lock
-    // Must only be called when you know that a read lock on the node mutex is held
-    // and will be held for the duration of your iteration
+    // Iterating a snapshot needs no lock, so this is now the same as eachNode()
     template<typename NodeLambda>
     void unsafeEachNode(NodeLambda functor) {
-        for (NodeHash::const_iterator it = _nodeHash.cbegin(); it != _nodeHash.cend(); ++it) {
-            functor(it->second);
-        }
+        eachNode(functor);
     }
 
     void putLocalPortIntoSharedMemory(const QString key, QObject* parent, quint16 localPort);
@@ -317,14 +311,27 @@ public:
     void flagTimeForConnectionStep(ConnectionStep connectionStep);
 
     udt::Socket::StatsVector sampleStatsForAllConnections() { return _nodeSocket.sampleStatsForAllConnections(); }
+    udt::Socket::ReceiveBatchStats sampleReceiveBatchStats() { return _nodeSocket.sampleReceiveBatchStats(); }
+    void setReceiveBatchSize(int batchSize) { _nodeSocket.setReceiveBatchSize(batchSize); }
+    // see udt::Socket::setNumReceiveThreads, packets from known nodes are verified on the receive threads
+    void setNumReceiveThreads(int numThreads) { _nodeSocket.setNumReceiveThreads(numThreads); }
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
+    void setOutboundDatagramSink(udt::OutboundDatagramSink sink) { _nodeSocket.setOutboundDatagramSink(sink); }
 
-    void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
+    void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) {
+        // our batched verification would bypass the replacement
+        _nodeSocket.setPacketFilterOperator(filterOperator);
+        _nodeSocket.setPacketBatchFilterOperator(nullptr);
+        _nodeSocket.setConcurrentPacketBatchFilterOperator(nullptr);
+    }
     bool packetVersionMatch(const udt::Packet& packet);
 
     bool isPacketVerifiedWithSource(const udt::Packet& packet, Node* sourceNode = nullptr);
     bool isPacketVerified(const udt::Packet& packet) { return isPacketVerifiedWithSource(packet); }
+    void verifyPacketBatch(const std::vector<const udt::Packet*>& packets, std::vector<bool>& isVerified);
+    void verifyPacketBatchConcurrently(const std::vector<const udt::Packet*>& packets,
+                                       std::vector<udt::PacketVerification>& verifications);
     void setAuthenticatePackets(bool useAuthentication) { _useAuthentication = useAuthentication; }
     bool getAuthenticatePackets() const { return _useAuthentication; }
 
@@ -347,6 +354,13 @@ public:
 
     void setDropOutgoingNodeTraffic(bool squelchOutgoingNodeTraffic) { _dropOutgoingNodeTraffic = squelchOutgoingNodeTraffic; }
 
+    // whether we ask the nodes sending us protectable packets for parity, and rebuild the ones we lose from it
+    void setForwardErrorCorrectionEnabled(bool isEnabled) { _isForwardErrorCorrectionEnabled = isEnabled; }
+
+    // whether small reliable packets to the same node share datagrams, see udt::Socket::setPacketCoalescingHeader.
+    // Shared datagrams are always split on receive.
+    void setPacketCoalescingEnabled(bool isEnabled);
+
     const std::set<NodeType_t> SOLO_NODE_TYPES = {
         NodeType::AvatarMixer,
         NodeType::AudioMixer,
@@ -407,6 +421,8 @@ protected slots:
 
     void processDelayedAdds();
 
+    void sendFECFeedback();
+
 protected:
     struct NewNodeInfo {
         qint8 type;
@@ -441,12 +457,24 @@ protected:
     bool sockAddrBelongsToNode(const SockAddr& sockAddr);
 
     void addNewNode(NewNodeInfo info);
+    // lets the other nodes update what they keep by local ID about this one
+    void notifyOtherNodes(const Node& node, bool isAdded);
     void delayNodeAdd(NewNodeInfo info);
     void removeDelayedAdd(QUuid nodeUUID);
     bool isDelayedNode(QUuid nodeUUID);
 
-    NodeHash _nodeHash;
-    mutable QReadWriteLock _nodeMutex { QReadWriteLock::Recursive };
+    // Copies the current node table, lets the functor modify the copy, and publishes it.
+    // Writers are serialized, readers are never blocked.
+    template<typename EditLambda>
+    void editNodeTable(EditLambda functor) {
+        std::lock_guard<std::mutex> lock(_nodeTableEditMutex);
+        auto table = std::make_shared<NodeTable>(*getNodeTable());
+        functor(*table);
+        std::atomic_store(&_nodeTable, NodeTablePointer(std::move(table)));
+    }
+
+    NodeTablePointer _nodeTable { std::make_shared<NodeTable>() };   // only accessed with std::atomic_load/store
+    std::mutex _nodeTableEditMutex;
     udt::Socket _nodeSocket;
     QUdpSocket* _dtlsSocket { nullptr };
     SockAddr _localSockAddr;
@@ -470,16 +498,6 @@ protected:
     QMap<quint64, ConnectionStep> _lastConnectionTimes;
     bool _areConnectionTimesComplete = false;
 
-    template<typename IteratorLambda>
-    void eachNodeHashIterator(IteratorLambda functor) {
-        QWriteLocker writeLock(&_nodeMutex);
-        NodeHash::iterator it = _nodeHash.begin();
-
-        while (it != _nodeHash.end()) {
-            functor(it);
-        }
-    }
-
     std::unordered_map<QUuid, ConnectionID> _connectionIDs;
     quint64 _nodeConnectTimestamp{ 0 };
     quint64 _nodeDisconnectTimestamp{ 0 };
@@ -493,15 +511,18 @@ private slots:
 private:
     void fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAuth = nullptr);
 
+    void sendParity(const NLPacket& packet, const Node& destinationNode);
+    bool processForwardErrorCorrection(const udt::Packet& packet); // returns whether the packet is handled further
+    void processCoalescedPackets(const udt::Packet& packet);
+
     mutable QReadWriteLock _sessionUUIDLock;
     QUuid _sessionUUID;
-    using LocalIDMapping = tbb::concurrent_unordered_map<Node::LocalID, SharedNodePointer>;
-    LocalIDMapping _localIDMap;
     Node::LocalID _sessionLocalID { 0 };
     bool _flagTimeForConnectionStep { false }; // only keep track in interface
 
     size_t _maxConnectionRate { DEFAULT_MAX_CONNECTION_RATE };
     size_t _nodesAddedInCurrentTimeSlice { 0 };
+    std::mutex _delayedNodeAddsMutex;
     std::vector<NewNodeInfo> _delayedNodeAdds;
 
     int _inboundPPS { 0 };
@@ -511,6 +532,9 @@ private:
 
     bool _dropOutgoingNodeTraffic { false };
 
+    bool _isForwardErrorCorrectionEnabled { true };
+    std::unordered_map<SockAddr, FECDecoder> _fecDecoders; // by sender, only used on the socket's thread
+
     quint64 _sendErrorStatsTime { (quint64)0 };
     static const quint64 ERROR_STATS_PERIOD_US { 1 * USECS_PER_SECOND };
 };
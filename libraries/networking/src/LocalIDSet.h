@@ -0,0 +1,71 @@
+//
+//  LocalIDSet.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LocalIDSet_h
+#define hifi_LocalIDSet_h
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <UUID.h>
+
+// A set of nodes by their local ID, kept as one bit per ID so that the mixers' checks of every listener against every
+// source are a bit test rather than a search through UUIDs. It only grows as far as the highest ID it holds, at most
+// 8 kB since local IDs are 16 bits, and an empty set holds no memory at all.
+class LocalIDSet {
+public:
+    bool contains(NetworkLocalID localID) const {
+        size_t word = localID / BITS_PER_WORD;
+        return word < _words.size() && (_words[word] & bit(localID)) != 0;
+    }
+
+    // returns whether the ID wasn't in the set yet
+    bool insert(NetworkLocalID localID) {
+        size_t word = localID / BITS_PER_WORD;
+        if (word >= _words.size()) {
+            _words.resize(word + 1, 0);
+        }
+        if (_words[word] & bit(localID)) {
+            return false;
+        }
+        _words[word] |= bit(localID);
+        ++_size;
+        return true;
+    }
+
+    // returns whether the ID was in the set
+    bool erase(NetworkLocalID localID) {
+        if (!contains(localID)) {
+            return false;
+        }
+        _words[localID / BITS_PER_WORD] &= ~bit(localID);
+        --_size;
+        return true;
+    }
+
+    void clear() {
+        _words.clear();
+        _size = 0;
+    }
+
+    bool empty() const { return _size == 0; }
+    size_t size() const { return _size; }
+
+private:
+    static const size_t BITS_PER_WORD = 64;
+    static uint64_t bit(NetworkLocalID localID) { return (uint64_t)1 << (localID % BITS_PER_WORD); }
+
+    std::vector<uint64_t> _words;
+    size_t _size { 0 };
+};
+
+#endif // hifi_LocalIDSet_h
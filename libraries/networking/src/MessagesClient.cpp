@@ -60,58 +60,50 @@ void MessagesClient::decodeMessagesPacket(QSharedPointer<ReceivedMessage> receiv
     }
 }
 
-std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesPacket(QString channel, QString message, QUuid senderID) {
-    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
-
+QByteArray MessagesClient::encodeMessage(const QString& channel, bool isText, const QByteArray& messageData,
+                                         const QUuid& senderID) {
     auto channelUtf8 = channel.toUtf8();
     quint16 channelLength = channelUtf8.length();
-    packetList->writePrimitive(channelLength);
-    packetList->write(channelUtf8);
-
-    bool isTextMessage = true;
-    packetList->writePrimitive(isTextMessage);
-
-    auto messageUtf8 = message.toUtf8();
-    quint32 messageLength = messageUtf8.length();
-    packetList->writePrimitive(messageLength);
-    packetList->write(messageUtf8);
-
-    packetList->write(senderID.toRfc4122());
+    quint32 messageLength = messageData.length();
+
+    QByteArray encoded;
+    encoded.reserve(sizeof(channelLength) + channelLength + sizeof(isText) + sizeof(messageLength) + messageLength +
+                    NUM_BYTES_RFC4122_UUID);
+    encoded.append(reinterpret_cast<const char*>(&channelLength), sizeof(channelLength));
+    encoded.append(channelUtf8);
+    encoded.append(reinterpret_cast<const char*>(&isText), sizeof(isText));
+    encoded.append(reinterpret_cast<const char*>(&messageLength), sizeof(messageLength));
+    encoded.append(messageData);
+    encoded.append(senderID.toRfc4122());
+    return encoded;
+}
 
+std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesPacket(QString channel, QString message, QUuid senderID) {
+    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+    packetList->write(encodeMessage(channel, true, message.toUtf8(), senderID));
     return packetList;
 }
 
 std::unique_ptr<NLPacketList> MessagesClient::encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID) {
     auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
-
-    auto channelUtf8 = channel.toUtf8();
-    quint16 channelLength = channelUtf8.length();
-    packetList->writePrimitive(channelLength);
-    packetList->write(channelUtf8);
-
-    bool isTextMessage = false;
-    packetList->writePrimitive(isTextMessage);
-
-    quint32 dataLength = data.length();
-    packetList->writePrimitive(dataLength);
-    packetList->write(data);
-
-    packetList->write(senderID.toRfc4122());
-
+    packetList->write(encodeMessage(channel, false, data, senderID));
     return packetList;
 }
 
 
 void MessagesClient::handleMessagesPacket(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
-    QString channel, message;
-    QByteArray data;
-    bool isText { false };
-    QUuid senderID;
-    decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
-    if (isText) {
-        emit messageReceived(channel, message, senderID, false);
-    } else {
-        emit dataReceived(channel, data, senderID, false);
+    // the messages mixer batches the messages it relays to us
+    while (receivedMessage->getBytesLeftToRead() > 0) {
+        QString channel, message;
+        QByteArray data;
+        bool isText { false };
+        QUuid senderID;
+        decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
+        if (isText) {
+            emit messageReceived(channel, message, senderID, false);
+        } else {
+            emit dataReceived(channel, data, senderID, false);
+        }
     }
 }
 
@@ -168,6 +168,9 @@ public:
     static std::unique_ptr<NLPacketList> encodeMessagesPacket(QString channel, QString message, QUuid senderID);
     static std::unique_ptr<NLPacketList> encodeMessagesDataPacket(QString channel, QByteArray data, QUuid senderID);
 
+    // one message as it is written in a MessagesData packet, which can hold several back to back
+    static QByteArray encodeMessage(const QString& channel, bool isText, const QByteArray& messageData, const QUuid& senderID);
+
 signals:
     /*@jsdoc
      * Triggered when a text message is received.
@@ -36,7 +36,7 @@ std::unique_ptr<NLPacket> NLPacket::create(PacketType type, qint64 size, bool is
     return packet;
 }
 
-std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(udt::PacketBuffer data, qint64 size,
                                                        const SockAddr& senderSockAddr) {
     // Fail with null data
     Q_ASSERT(data);
@@ -91,7 +91,7 @@ NLPacket::NLPacket(const NLPacket& other) : Packet(other) {
     _sourceID = other._sourceID;
 }
 
-NLPacket::NLPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr) :
+NLPacket::NLPacket(udt::PacketBuffer data, qint64 size, const SockAddr& senderSockAddr) :
     Packet(std::move(data), size, senderSockAddr)
 {    
     // sanity check before we decrease the payloadSize with the payloadCapacity
@@ -166,6 +166,17 @@ QByteArray NLPacket::hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& h
     return QByteArray((const char*) hashResult.data(), (int) hashResult.size());
 }
 
+bool NLPacket::verificationHashMatches(const udt::Packet& packet, HMACAuth& hash) {
+    int hashOffset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
+        + NUM_BYTES_LOCALID;
+    int offset = hashOffset + NUM_BYTES_MD5_HASH;
+
+    // this is on the receive path of every sourced packet, hash on the stack instead of through QByteArrays
+    unsigned char hashResult[HMACAuth::MAX_HASH_SIZE];
+    int hashLen = hash.calculateHash(hashResult, packet.getData() + offset, packet.getDataSize() - offset);
+    return hashLen == NUM_BYTES_MD5_HASH && memcmp(hashResult, packet.getData() + hashOffset, NUM_BYTES_MD5_HASH) == 0;
+}
+
 void NLPacket::writeTypeAndVersion() {
     auto headerOffset = Packet::totalHeaderSize(isPartOfMessage());
     
@@ -225,7 +236,9 @@ void NLPacket::writeVerificationHash(HMACAuth& hmacAuth) const {
     auto offset = Packet::totalHeaderSize(isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
                 + NUM_BYTES_LOCALID;
 
-    QByteArray verificationHash = hashForPacketAndHMAC(*this, hmacAuth);
+    unsigned char verificationHash[HMACAuth::MAX_HASH_SIZE];
+    int hashLen = hmacAuth.calculateHash(verificationHash, _packet.get() + offset + NUM_BYTES_MD5_HASH,
+                                         getDataSize() - offset - NUM_BYTES_MD5_HASH);
     
-    memcpy(_packet.get() + offset, verificationHash.data(), verificationHash.size());
+    memcpy(_packet.get() + offset, verificationHash, hashLen);
 }
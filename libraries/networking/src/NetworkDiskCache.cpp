@@ -0,0 +1,170 @@
+//
+//  NetworkDiskCache.cpp
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NetworkDiskCache.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QDirIterator>
+#include <QtCore/QSaveFile>
+
+#include "NetworkLogging.h"
+
+namespace {
+    const QString ACCESS_TIMES_FILENAME = "accessTimes";
+    const QString CACHE_FILE_SUFFIX = ".d";
+    const quint32 ACCESS_TIMES_VERSION = 1;
+
+    // like QNetworkDiskCache, evicts down to 90% of the maximum so that eviction doesn't happen on every insert
+    const qint64 EXPIRE_GOAL_NUMERATOR = 9;
+    const qint64 EXPIRE_GOAL_DENOMINATOR = 10;
+}
+
+NetworkDiskCache::NetworkDiskCache(QObject* parent) : QNetworkDiskCache(parent) {
+}
+
+NetworkDiskCache::~NetworkDiskCache() {
+    saveAccessTimes();
+}
+
+QIODevice* NetworkDiskCache::data(const QUrl& url) {
+    QIODevice* device = QNetworkDiskCache::data(url);
+    if (device) {
+        loadAccessTimes();
+        _accessTimes[url.toString()] = QDateTime::currentMSecsSinceEpoch();
+        _accessTimesChanged = true;
+    }
+    return device;
+}
+
+bool NetworkDiskCache::remove(const QUrl& url) {
+    loadAccessTimes();
+    if (_accessTimes.remove(url.toString()) > 0) {
+        _accessTimesChanged = true;
+    }
+    return QNetworkDiskCache::remove(url);
+}
+
+void NetworkDiskCache::clear() {
+    loadAccessTimes();
+    _accessTimes.clear();
+    _accessTimesChanged = true;
+    QNetworkDiskCache::clear();
+}
+
+qint64 NetworkDiskCache::expire() {
+    struct Entry {
+        QString path;
+        qint64 size;
+        qint64 lastUsed;
+        QString url;
+    };
+
+    std::vector<Entry> entries;
+    qint64 totalSize = 0;
+    QDirIterator it(cacheDirectory(), QDir::Files | QDir::NoDotAndDotDot, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        QString path = it.next();
+        QFileInfo info = it.fileInfo();
+        if (!info.fileName().endsWith(CACHE_FILE_SUFFIX)) {
+            continue;
+        }
+        // the entries are written when stored or revalidated, which counts as a use
+        entries.push_back({ path, info.size(), info.lastModified().toMSecsSinceEpoch(), QString() });
+        totalSize += info.size();
+    }
+
+    if (totalSize <= maximumCacheSize()) {
+        return totalSize;
+    }
+
+    // the URLs of the entries are only read when evicting, as it takes opening every entry
+    loadAccessTimes();
+    for (auto& entry : entries) {
+        entry.url = fileMetaData(entry.path).url().toString();
+        auto itr = _accessTimes.find(entry.url);
+        if (itr != _accessTimes.end()) {
+            entry.lastUsed = std::max(entry.lastUsed, itr.value());
+        }
+    }
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.lastUsed < b.lastUsed;
+    });
+
+    qint64 goal = maximumCacheSize() * EXPIRE_GOAL_NUMERATOR / EXPIRE_GOAL_DENOMINATOR;
+    int numRemoved = 0;
+    for (const auto& entry : entries) {
+        if (totalSize <= goal) {
+            break;
+        }
+        if (QFile::remove(entry.path)) {
+            totalSize -= entry.size;
+            _accessTimes.remove(entry.url);
+            numRemoved++;
+        }
+    }
+    _accessTimesChanged = true;
+    saveAccessTimes();
+
+    qCDebug(networking) << "NetworkDiskCache evicted" << numRemoved << "least recently used entries, down to" << totalSize
+                        << "bytes";
+    return totalSize;
+}
+
+void NetworkDiskCache::loadAccessTimes() {
+    if (_accessTimesDirectory == cacheDirectory()) {
+        return;
+    }
+    saveAccessTimes();
+    _accessTimes.clear();
+    _accessTimesChanged = false;
+    _accessTimesDirectory = cacheDirectory();
+    if (_accessTimesDirectory.isEmpty()) {
+        return;
+    }
+
+    QFile file(QDir(_accessTimesDirectory).filePath(ACCESS_TIMES_FILENAME));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    quint32 version;
+    stream >> version;
+    if (version != ACCESS_TIMES_VERSION) {
+        return;
+    }
+    stream >> _accessTimes;
+    if (stream.status() != QDataStream::Ok) {
+        qCWarning(networking) << "NetworkDiskCache discarding corrupt access times at" << file.fileName();
+        _accessTimes.clear();
+    }
+}
+
+void NetworkDiskCache::saveAccessTimes() {
+    if (!_accessTimesChanged || _accessTimesDirectory.isEmpty()) {
+        return;
+    }
+
+    QSaveFile file(QDir(_accessTimesDirectory).filePath(ACCESS_TIMES_FILENAME));
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(networking) << "NetworkDiskCache can't write access times to" << file.fileName();
+        return;
+    }
+    QDataStream stream(&file);
+    stream << ACCESS_TIMES_VERSION << _accessTimes;
+    if (file.commit()) {
+        _accessTimesChanged = false;
+    }
+}
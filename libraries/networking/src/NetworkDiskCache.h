@@ -0,0 +1,46 @@
+//
+//  NetworkDiskCache.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NetworkDiskCache_h
+#define hifi_NetworkDiskCache_h
+
+#include <QtCore/QHash>
+#include <QtNetwork/QNetworkDiskCache>
+
+// The disk cache of the resources loaded over HTTP, set up by AssetClient::initCaching.
+//
+// QNetworkDiskCache evicts the entries it stored first; this one evicts the entries least recently used, so the content
+// of the places visited often stays cached however much is loaded elsewhere.  The last uses are kept in an index next to
+// the entries, as the entries themselves are only written when stored or revalidated.
+class NetworkDiskCache : public QNetworkDiskCache {
+    Q_OBJECT
+public:
+    NetworkDiskCache(QObject* parent = nullptr);
+    ~NetworkDiskCache() override;
+
+    QIODevice* data(const QUrl& url) override;
+    bool remove(const QUrl& url) override;
+    void clear() override;
+
+protected:
+    qint64 expire() override;
+
+private:
+    void loadAccessTimes();
+    void saveAccessTimes();
+
+    // the last uses of the entries, by URL, in msecs since epoch
+    QHash<QString, qint64> _accessTimes;
+    QString _accessTimesDirectory;
+    bool _accessTimesChanged { false };
+};
+
+#endif // hifi_NetworkDiskCache_h
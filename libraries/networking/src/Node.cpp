@@ -13,14 +13,18 @@
 
 #include "Node.h"
 
+#include <algorithm>
 #include <cstring>
 #include <stdio.h>
 
 #include <QtCore/QDataStream>
 #include <QtCore/QDebug>
+#include <QtCore/QJsonArray>
 
 #include <UUID.h>
 
+#include "DependencyManager.h"
+#include "LimitedNodeList.h"
 #include "NetworkLogging.h"
 #include "NodePermissions.h"
 #include "SharedUtil.h"
@@ -40,6 +44,7 @@ static const QHash<NodeType_t, QString> TYPE_NAME_HASH {
     { NodeType::MessagesMixer, "Messages Mixer" },
     { NodeType::AssetServer, "Asset Server" },
     { NodeType::EntityScriptServer, "Entity Script Server" },
+    { NodeType::BakeWorker, "Bake Worker" },
     { NodeType::UpstreamAudioMixer, "Upstream Audio Mixer" },
     { NodeType::UpstreamAvatarMixer, "Upstream Avatar Mixer" },
     { NodeType::DownstreamAudioMixer, "Downstream Audio Mixer" },
@@ -56,6 +61,7 @@ static const QHash<NodeType_t, QString> TYPE_CHAR_HASH {
     { NodeType::AssetServer, "A" },
     { NodeType::MessagesMixer, "m" },
     { NodeType::EntityScriptServer, "S" },
+    { NodeType::BakeWorker, "K" },
     { NodeType::UpstreamAudioMixer, "B" },
     { NodeType::UpstreamAvatarMixer, "C" },
     { NodeType::DownstreamAudioMixer, "a" },
@@ -110,6 +116,7 @@ Node::Node(const QUuid& uuid, NodeType_t type, const SockAddr& publicSocket,
     const SockAddr& localSocket, QObject* parent) :
     NetworkPeer(uuid, publicSocket, localSocket, parent),
     _type(type),
+    _authenticateHash(new HMACAuth()),
     _pingMs(-1),  // "Uninitialized"
     _clockSkewUsec(0),
     _mutex(),
@@ -165,6 +172,15 @@ void Node::addIgnoredNode(const QUuid& otherNodeID) {
         // add the session UUID to the set of ignored ones for this listening node
         if (std::find(_ignoredNodeIDs.begin(), _ignoredNodeIDs.end(), otherNodeID) == _ignoredNodeIDs.end()) {
             _ignoredNodeIDs.push_back(otherNodeID);
+            _hasIgnoredNodes = true;
+
+            // the node table is read without a lock, so it's fine to look it up with ours held
+            if (DependencyManager::isSet<LimitedNodeList>()) {
+                auto otherNode = DependencyManager::get<LimitedNodeList>()->nodeWithUUID(otherNodeID);
+                if (otherNode) {
+                    _ignoredNodeLocalIDs.insert(otherNode->getLocalID());
+                }
+            }
         }
     } else {
         qCWarning(networking) << "Node::addIgnoredNode called with null ID or ID of ignoring node.";
@@ -181,6 +197,14 @@ void Node::removeIgnoredNode(const QUuid& otherNodeID) {
         auto it = std::remove(_ignoredNodeIDs.begin(), _ignoredNodeIDs.end(), otherNodeID);
         if (it != _ignoredNodeIDs.end()) {
             _ignoredNodeIDs.erase(it);
+            _hasIgnoredNodes = !_ignoredNodeIDs.empty();
+
+            if (DependencyManager::isSet<LimitedNodeList>()) {
+                auto otherNode = DependencyManager::get<LimitedNodeList>()->nodeWithUUID(otherNodeID);
+                if (otherNode) {
+                    _ignoredNodeLocalIDs.erase(otherNode->getLocalID());
+                }
+            }
         }
     } else {
         qCWarning(networking) << "Node::removeIgnoredNode called with null ID or ID of ignoring node.";
@@ -194,6 +218,38 @@ bool Node::isIgnoringNodeWithID(const QUuid& nodeID) const {
     return std::find(_ignoredNodeIDs.begin(), _ignoredNodeIDs.end(), nodeID) != _ignoredNodeIDs.end();
 }
 
+bool Node::isIgnoringNodeWithLocalID(LocalID localID) const {
+    if (!_hasIgnoredNodes) {
+        return false;
+    }
+
+    QReadLocker lock { &_ignoredNodeIDSetLock };
+    return _ignoredNodeLocalIDs.contains(localID);
+}
+
+void Node::otherNodeAdded(const Node& otherNode) {
+    if (!_hasIgnoredNodes) {
+        return;
+    }
+
+    QWriteLocker lock { &_ignoredNodeIDSetLock };
+    if (std::find(_ignoredNodeIDs.begin(), _ignoredNodeIDs.end(), otherNode.getUUID()) != _ignoredNodeIDs.end()) {
+        _ignoredNodeLocalIDs.insert(otherNode.getLocalID());
+    }
+}
+
+void Node::otherNodeKilled(const Node& otherNode) {
+    if (!_hasIgnoredNodes) {
+        return;
+    }
+
+    // the ignore itself is kept for if the node comes back, it's only its local ID that may go to another node
+    QWriteLocker lock { &_ignoredNodeIDSetLock };
+    if (std::find(_ignoredNodeIDs.begin(), _ignoredNodeIDs.end(), otherNode.getUUID()) != _ignoredNodeIDs.end()) {
+        _ignoredNodeLocalIDs.erase(otherNode.getLocalID());
+    }
+}
+
 QDataStream& operator<<(QDataStream& out, const Node& node) {
     out << node._type;
     out << node._uuid;
@@ -240,16 +296,65 @@ void Node::setConnectionSecret(const QUuid& connectionSecret) {
         return;
     }
 
-    if (!_authenticateHash) {
-        _authenticateHash.reset(new HMACAuth());
-    }
-
     _connectionSecret = connectionSecret;
     _authenticateHash->setKey(_connectionSecret);
 }
 
 void Node::updateStats(Stats stats) {
     _stats = stats;
+    _statsHistory.push(stats);
+}
+
+static QJsonObject jsonForPercentiles(const udt::LatencyPercentiles& percentiles) {
+    QJsonObject json;
+    json["p50"] = percentiles.p50;
+    json["p90"] = percentiles.p90;
+    json["p99"] = percentiles.p99;
+    json["max"] = percentiles.max;
+    return json;
+}
+
+QJsonObject Node::getConnectionStatsJSON(bool includeSamples) const {
+    auto samples = _statsHistory.getSamples();
+
+    QJsonObject json;
+    if (!samples.empty()) {
+        json["rtt_usecs"] = jsonForPercentiles(samples.back().rtt);
+        json["send_latency_usecs"] = jsonForPercentiles(samples.back().sendLatency);
+    }
+
+    // the tail over the whole history, to find the connections that were bad at some point in the last minute
+    int worstRTT = 0;
+    int worstSendLatency = 0;
+    quint64 sentPackets = 0;
+    quint64 retransmittedPackets = 0;
+    QJsonArray samplesJSON;
+    for (const auto& sample : samples) {
+        worstRTT = std::max(worstRTT, sample.rtt.p99);
+        worstSendLatency = std::max(worstSendLatency, sample.sendLatency.p99);
+        sentPackets += sample.sentPackets;
+        retransmittedPackets += sample.retransmittedPackets;
+
+        if (includeSamples) {
+            QJsonObject sampleJSON;
+            sampleJSON["end_time_msecs"] = (qint64)(sample.endTime / USECS_PER_MSEC);
+            sampleJSON["sent_packets"] = (qint64)sample.sentPackets;
+            sampleJSON["received_packets"] = (qint64)sample.receivedPackets;
+            sampleJSON["retransmitted_packets"] = (qint64)sample.retransmittedPackets;
+            sampleJSON["rtt_usecs"] = jsonForPercentiles(sample.rtt);
+            sampleJSON["send_latency_usecs"] = jsonForPercentiles(sample.sendLatency);
+            samplesJSON.append(sampleJSON);
+        }
+    }
+
+    json["history_samples"] = (int)samples.size();
+    json["history_rtt_p99_max_usecs"] = worstRTT;
+    json["history_send_latency_p99_max_usecs"] = worstSendLatency;
+    json["history_retransmit_ratio"] = sentPackets > 0 ? (double)retransmittedPackets / sentPackets : 0.0;
+    if (includeSamples) {
+        json["history"] = samplesJSON;
+    }
+    return json;
 }
 
 const Node::Stats& Node::getConnectionStats() const {
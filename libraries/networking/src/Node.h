@@ -14,12 +14,14 @@
 #ifndef hifi_Node_h
 #define hifi_Node_h
 
+#include <atomic>
 #include <memory>
 #include <ostream>
 #include <stdint.h>
 #include <vector>
 
 #include <QtCore/QDebug>
+#include <QtCore/QJsonObject>
 #include <QtCore/QMutex>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QUuid>
@@ -30,6 +32,8 @@
 #include <TBBHelpers.h>
 
 #include "SockAddr.h"
+#include "ForwardErrorCorrection.h"
+#include "LocalIDSet.h"
 #include "NetworkPeer.h"
 #include "NodeData.h"
 #include "NodeType.h"
@@ -38,6 +42,7 @@
 #include "NodePermissions.h"
 #include "HMACAuth.h"
 #include "udt/ConnectionStats.h"
+#include "udt/ConnectionStatsHistory.h"
 #include "NumericalConstants.h"
 
 class Node : public NetworkPeer {
@@ -63,7 +68,8 @@ public:
 
     const QUuid& getConnectionSecret() const { return _connectionSecret; }
     void setConnectionSecret(const QUuid& connectionSecret);
-    HMACAuth* getAuthenticateHash() const { return _authenticateHash.get(); }
+    // null until the node has a connection secret, the HMAC itself lives as long as the node and is rekeyed under its own lock
+    HMACAuth* getAuthenticateHash() const { return _authenticateHash->isKeyed() ? _authenticateHash.get() : nullptr; }
 
     NodeData* getLinkedData() const { return _linkedData.get(); }
     void setLinkedData(std::unique_ptr<NodeData> linkedData) { _linkedData = std::move(linkedData); }
@@ -94,6 +100,12 @@ public:
     void addIgnoredNode(const QUuid& otherNodeID);
     void removeIgnoredNode(const QUuid& otherNodeID);
     bool isIgnoringNodeWithID(const QUuid& nodeID) const;
+    // the same for a connected node by its local ID, a bit test for the mixers' checks of every pair of nodes
+    bool isIgnoringNodeWithLocalID(LocalID localID) const;
+
+    // the node list tells each node of the others coming and going, so the local IDs of the ignored ones stay right
+    void otherNodeAdded(const Node& otherNode);
+    void otherNodeKilled(const Node& otherNode);
 
     using IgnoredNodeIDs = std::vector<QUuid>;
     const IgnoredNodeIDs& getIgnoredNodeIDs() const { return _ignoredNodeIDs; }
@@ -104,18 +116,27 @@ public:
     void updateStats(Stats stats);
     const Stats& getConnectionStats() const;
 
+    // the last minute of samples, can be read from any thread
+    const udt::ConnectionStatsHistory& getConnectionStatsHistory() const { return _statsHistory; }
+
+    // the latency percentiles of the last sample and the worst of the history, with every sample of it if asked for
+    QJsonObject getConnectionStatsJSON(bool includeSamples) const;
+
     int getInboundPPS() const;
     int getOutboundPPS() const;
     float getInboundKbps() const;
     float getOutboundKbps() const;
 
+    // protects the unreliable packets sent to this node, once it asked for it
+    FECEncoder& getFECEncoder() const { return _fecEncoder; }
+
 private:
     Q_DISABLE_COPY(Node)
 
     NodeType_t _type;
 
     QUuid _connectionSecret;
-    std::unique_ptr<HMACAuth> _authenticateHash { nullptr };
+    const std::unique_ptr<HMACAuth> _authenticateHash;
     std::unique_ptr<NodeData> _linkedData;
     bool _isReplicated { false };
     int _pingMs;
@@ -126,10 +147,15 @@ private:
     bool _isUpstream { false };
 
     IgnoredNodeIDs _ignoredNodeIDs;
+    LocalIDSet _ignoredNodeLocalIDs;   // those of the ignored nodes that are connected
+    std::atomic<bool> _hasIgnoredNodes { false };
     mutable QReadWriteLock _ignoredNodeIDSetLock;
     std::vector<QString> _replicatedUsernames { };
 
     Stats _stats;
+    udt::ConnectionStatsHistory _statsHistory;
+
+    mutable FECEncoder _fecEncoder;
 };
 
 Q_DECLARE_METATYPE(Node*)
@@ -19,8 +19,10 @@
 #include <QtCore/QDebug>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QMetaEnum>
+#include <QtCore/QPointer>
 #include <QtCore/QUrl>
 #include <QtCore/QThread>
+#include <QtCore/QThreadPool>
 #include <QtNetwork/QHostInfo>
 #include <QtNetwork/QNetworkInterface>
 
@@ -44,6 +46,7 @@
 #include "SharedUtil.h"
 #include <Trace.h>
 #include <ModerationFlags.h>
+#include <SamplingProfiler.h>
 
 using namespace std::chrono;
 
@@ -117,6 +120,14 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
     // clear our NodeList when logout is requested
     connect(accountManager.data(), &AccountManager::logoutComplete , this, [this]{ reset("Logged out"); });
 
+    // the domain-server only sends what changed since our last list, so a node we drop ourselves would never come back
+    // in one - ask for a full list instead
+    connect(this, &LimitedNodeList::nodeKilled, this, [this] {
+        if (!_isRemovingNodeForDomainServer) {
+            _domainListVersion = 0;
+        }
+    });
+
     // Only used in Interface.
     auto domainAccountManager = DependencyManager::get<DomainAccountManager>();
     if (domainAccountManager) {
@@ -157,6 +168,8 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
         PacketReceiver::makeSourcedListenerReference<NodeList>(this, &NodeList::processPingPacket));
     packetReceiver.registerListener(PacketType::PingReply,
         PacketReceiver::makeSourcedListenerReference<NodeList>(this, &NodeList::processPingReplyPacket));
+    packetReceiver.registerListener(PacketType::FECFeedback,
+        PacketReceiver::makeSourcedListenerReference<NodeList>(this, &NodeList::processFECFeedback));
     packetReceiver.registerListener(PacketType::ICEPing,
         PacketReceiver::makeUnsourcedListenerReference<NodeList>(this, &NodeList::processICEPingPacket));
     packetReceiver.registerListener(PacketType::DomainServerAddedNode,
@@ -179,6 +192,8 @@ NodeList::NodeList(char newOwnerType, int socketListenPort, int dtlsListenPort)
         PacketReceiver::makeUnsourcedListenerReference<NodeList>(this, &NodeList::processDomainServerRemovedNode));
     packetReceiver.registerListener(PacketType::UsernameFromIDReply,
         PacketReceiver::makeUnsourcedListenerReference<NodeList>(this, &NodeList::processUsernameFromIDReply));
+    packetReceiver.registerListener(PacketType::SamplingProfileRequest,
+        PacketReceiver::makeUnsourcedListenerReference<NodeList>(this, &NodeList::processSamplingProfileRequest));
 }
 
 qint64 NodeList::sendStats(QJsonObject statsObject, SockAddr destination) {
@@ -198,6 +213,52 @@ qint64 NodeList::sendStats(QJsonObject statsObject, SockAddr destination) {
     return 0;
 }
 
+void NodeList::processSamplingProfileRequest(QSharedPointer<ReceivedMessage> message) {
+    // only the domain-server asks for profiles, on behalf of its admins
+    if (message->getSenderSockAddr() != _domainHandler.getSockAddr()) {
+        return;
+    }
+
+    quint32 requestID;
+    quint32 durationMsecs;
+    quint32 frequency;
+    message->readPrimitive(&requestID);
+    message->readPrimitive(&durationMsecs);
+    message->readPrimitive(&frequency);
+
+    if (!SamplingProfiler::isEnabled()) {
+        QString error;
+        SamplingProfiler::profile(std::chrono::milliseconds(durationMsecs), (int)frequency, error);
+        sendSamplingProfile(requestID, QByteArray(), error);
+        return;
+    }
+
+    qCDebug(networking) << "Taking a" << durationMsecs << "ms sampling profile at" << frequency << "Hz for the domain-server";
+
+    // sampling blocks for the whole profile, so it can't be on this thread
+    QPointer<NodeList> nodeList { this };
+    QThreadPool::globalInstance()->start([nodeList, requestID, durationMsecs, frequency] {
+        QString error;
+        QByteArray profile = SamplingProfiler::profile(std::chrono::milliseconds(durationMsecs), (int)frequency, error);
+        if (nodeList) {
+            QMetaObject::invokeMethod(nodeList, [nodeList, requestID, profile, error] {
+                if (nodeList) {
+                    nodeList->sendSamplingProfile(requestID, profile, error);
+                }
+            });
+        }
+    });
+}
+
+void NodeList::sendSamplingProfile(quint32 requestID, const QByteArray& profile, const QString& error) {
+    auto replyPacketList = NLPacketList::create(PacketType::SamplingProfileReply, QByteArray(), true, true);
+    bool succeeded = error.isEmpty();
+    replyPacketList->writePrimitive(requestID);
+    replyPacketList->writePrimitive((quint8)succeeded);
+    replyPacketList->write(succeeded ? profile : error.toUtf8());
+    sendPacketList(std::move(replyPacketList), _domainHandler.getSockAddr());
+}
+
 qint64 NodeList::sendStatsToDomainServer(QJsonObject statsObject) {
     if (thread() != QThread::currentThread()) {
         QMetaObject::invokeMethod(this, "sendStatsToDomainServer", Qt::QueuedConnection,
@@ -285,6 +346,13 @@ void NodeList::processPingReplyPacket(QSharedPointer<ReceivedMessage> message, S
     timePingReply(*message, sendingNode);
 }
 
+void NodeList::processFECFeedback(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    // the node wants what we send it protected, as much as the loss it sees calls for
+    float lossRate;
+    message->readPrimitive(&lossRate);
+    sendingNode->getFECEncoder().setLossRate(lossRate);
+}
+
 void NodeList::processICEPingPacket(QSharedPointer<ReceivedMessage> message) {
     // send back a reply
     auto replyPacket = constructICEPingReplyPacket(*message, _domainHandler.getICEClientID());
@@ -323,6 +391,8 @@ void NodeList::reset(QString reason, bool skipDomainHandlerReset) {
     setSessionUUID(QUuid());
     setSessionLocalID(Node::NULL_LOCAL_ID);
 
+    _domainListVersion = 0;
+
     // if we setup the DTLS socket, also disconnect from the DTLS socket readyRead() so it can handle handshaking
     if (_dtlsSocket) {
         disconnect(_dtlsSocket, 0, this, 0);
@@ -367,6 +437,9 @@ void NodeList::sendDomainServerCheckIn() {
         qCDebug(networking_ice) << "Waiting for ICE discovered domain-server socket. Will not send domain-server check in.";
         handleICEConnectionToDomainServer();
         // let the domain handler know we are due to send a checkin packet
+    } else if (!_domainHandler.isConnected() && _domainHandler.isCheckInDeferred()) {
+        // the domain-server is busy with other connect requests and asked us to try again later
+        qCDebug(networking_ice) << "Waiting to retry the connect request the domain-server was too busy for.";
     } else if (!domainHandlerIp.isNull() && !_domainHandler.checkInPacketTimeout()) {
         bool domainIsConnected = _domainHandler.isConnected();
         SockAddr domainSockAddr = _domainHandler.getSockAddr();
@@ -505,6 +578,11 @@ void NodeList::sendDomainServerCheckIn() {
             << localSockAddr << _nodeTypesOfInterest.values();
         packetStream << DependencyManager::get<AddressManager>()->getPlaceName();
 
+        if (domainIsConnected) {
+            // the domain-server sends a full list unless it knows we have the last one it sent
+            packetStream << _domainListVersion;
+        }
+
         if (!domainIsConnected) {
 
             // Metaverse account.
@@ -766,6 +844,12 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     bool newConnection;
     packetStream >> newConnection;
 
+    // a full list has a base version of 0, the others carry only the nodes that changed since the base list
+    quint32 domainListVersion;
+    quint32 domainListBaseVersion;
+    packetStream >> domainListVersion;
+    packetStream >> domainListBaseVersion;
+
     if (newConnection) {
         _nodeConnectTimestamp = usecTimestampNow();
         _connectReason = Connect;
@@ -862,6 +946,15 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
 
+    if (domainListBaseVersion == 0 || domainListBaseVersion == _domainListVersion) {
+        _domainListVersion = domainListVersion;
+    } else {
+        // we missed a list, the nodes in this one are still current but the next has to be a full list
+        qCDebug(networking) << "DomainList" << domainListVersion << "is relative to" << domainListBaseVersion
+            << "but the last applied was" << _domainListVersion << "- requesting a full list";
+        _domainListVersion = 0;
+    }
+
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
         parseNodeFromPacketStream(packetStream);
@@ -880,7 +973,9 @@ void NodeList::processDomainServerRemovedNode(QSharedPointer<ReceivedMessage> me
     // read the UUID from the packet, remove it if it exists
     QUuid nodeUUID = QUuid::fromRfc4122(message->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
     qCDebug(networking) << "Received packet from domain-server to remove node with UUID" << uuidStringWithoutCurlyBraces(nodeUUID);
+    _isRemovingNodeForDomainServer = true;
     killNodeWithUUID(nodeUUID);
+    _isRemovingNodeForDomainServer = false;
     removeDelayedAdd(nodeUUID);
 }
 
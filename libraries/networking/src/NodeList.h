@@ -106,6 +106,11 @@ public:
     virtual Node::LocalID getDomainLocalID() const override { return _domainHandler.getLocalID(); }
     virtual SockAddr getDomainSockAddr() const override { return _domainHandler.getSockAddr(); }
 
+    // a mixer is told about the others of its type, its hot standby or the other shards
+    virtual bool isSoloNodeType(NodeType_t nodeType) const override {
+        return nodeType != _ownerType.load() && SOLO_NODE_TYPES.count(nodeType) > 0;
+    }
+
 public slots:
     void reset(QString reason, bool skipDomainHandlerReset = false);
     void resetFromDomainHandler() { reset("Reset from Domain Handler", true); }
@@ -122,11 +127,14 @@ public slots:
 
     void processPingPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
     void processPingReplyPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void processFECFeedback(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
 
     void processICEPingPacket(QSharedPointer<ReceivedMessage> message);
 
     void processUsernameFromIDReply(QSharedPointer<ReceivedMessage> message);
 
+    void processSamplingProfileRequest(QSharedPointer<ReceivedMessage> message);
+
 #if defined(WEBRTC_DATA_CHANNELS)
     void setWebRTCIceServersFromSettings(const QJsonObject& domainSettingsObject);
 #endif
@@ -174,6 +182,9 @@ private:
 
     void sendDSPathQuery(const QString& newPath);
 
+    // replies to the domain-server with a profile, or why there is none
+    void sendSamplingProfile(quint32 requestID, const QByteArray& profile, const QString& error);
+
     void parseNodeFromPacketStream(QDataStream& packetStream);
 
     void pingPunchForInactiveNode(const SharedNodePointer& node);
@@ -213,6 +224,10 @@ private:
 #endif
 
     bool _hasDomainAccountManager { false };
+
+    // the last domain list applied, 0 when the next one has to be a full list
+    quint32 _domainListVersion { 0 };
+    bool _isRemovingNodeForDomainServer { false };
 };
 
 #endif // hifi_NodeList_h
@@ -0,0 +1,77 @@
+//
+//  NodeTable.h
+//  libraries/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeTable_h
+#define hifi_NodeTable_h
+
+#include <algorithm>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <UUIDHasher.h>
+
+#include "Node.h"
+
+//
+// Snapshot of the nodes known to a LimitedNodeList.
+//
+// A published table is never modified: readers load the current one without locking and can keep iterating it
+// while nodes are added or removed. Writers modify a private copy and publish it as a whole, see
+// LimitedNodeList::editNodeTable().
+//
+class NodeTable {
+public:
+    using Nodes = std::vector<SharedNodePointer>;
+
+    const Nodes& nodes() const { return _nodes; }
+    size_t size() const { return _nodes.size(); }
+
+    SharedNodePointer nodeWithUUID(const QUuid& nodeUUID) const {
+        auto it = _nodesByUUID.find(nodeUUID);
+        return it == _nodesByUUID.cend() ? SharedNodePointer() : it->second;
+    }
+
+    SharedNodePointer nodeWithLocalID(Node::LocalID localID) const {
+        auto it = _nodesByLocalID.find(localID);
+        return it == _nodesByLocalID.cend() ? SharedNodePointer() : it->second;
+    }
+
+    // does not replace a node already registered with the same local ID
+    void insert(const SharedNodePointer& node, Node::LocalID localID) {
+        if (_nodesByUUID.emplace(node->getUUID(), node).second) {
+            _nodes.push_back(node);
+        }
+        _nodesByLocalID.emplace(localID, node);
+    }
+
+    void erase(const SharedNodePointer& node) {
+        _nodesByLocalID.erase(node->getLocalID());
+        if (_nodesByUUID.erase(node->getUUID()) > 0) {
+            _nodes.erase(std::remove(_nodes.begin(), _nodes.end(), node), _nodes.end());
+        }
+    }
+
+    void clear() {
+        _nodes.clear();
+        _nodesByUUID.clear();
+        _nodesByLocalID.clear();
+    }
+
+private:
+    Nodes _nodes;
+    std::unordered_map<QUuid, SharedNodePointer, UUIDHasher> _nodesByUUID;
+    std::unordered_map<Node::LocalID, SharedNodePointer> _nodesByLocalID;
+};
+
+using NodeTablePointer = std::shared_ptr<const NodeTable>;
+
+#endif // hifi_NodeTable_h
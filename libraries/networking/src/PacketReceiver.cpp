@@ -114,11 +114,33 @@ void PacketReceiver::registerVerifiedListener(PacketType type, const ListenerRef
     _messageListenerMap[type] = { listener, deliverPending };
 }
 
+void PacketReceiver::registerVerifiedTypedHandler(PacketType type, TypedHandler::Invoke invoke, QObject* target) {
+    Q_ASSERT_X((size_t)type < _typedHandlers.size(), "PacketReceiver::registerVerifiedTypedHandler", "Invalid packet type");
+    QMutexLocker locker(&_packetListenerLock);
+
+    auto& handler = _typedHandlers[(size_t)type];
+    if (handler.invoke || _messageListenerMap.contains(type)) {
+        qCWarning(networking) << "Registering a typed packet handler for packet type" << type
+            << "that will replace a previously registered listener";
+    }
+
+    qCDebug(networking) << "Registering a typed packet handler for packet type" << type;
+    handler.invoke = invoke;
+    handler.target = target;
+}
+
 void PacketReceiver::unregisterListener(QObject* listener) {
     Q_ASSERT_X(listener, "PacketReceiver::unregisterListener", "No listener to unregister");
     
     {
         QMutexLocker packetListenerLocker(&_packetListenerLock);
+
+        // clear any typed handlers for this listener
+        for (auto& handler : _typedHandlers) {
+            if (handler.invoke && handler.target == listener) {
+                handler = TypedHandler();
+            }
+        }
         
         // clear any registrations for this listener in _messageListenerMap
         auto it = _messageListenerMap.begin();
@@ -142,9 +164,9 @@ void PacketReceiver::handleVerifiedPacket(std::unique_ptr<udt::Packet> packet) {
         return;
     }
 
-    // setup an NLPacket from the packet we were passed
+    // setup an NLPacket from the packet we were passed, the message reads its payload in place
     auto nlPacket = NLPacket::fromBase(std::move(packet));
-    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(*nlPacket);
+    auto receivedMessage = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
 
     handleVerifiedMessage(receivedMessage, true);
 }
@@ -156,7 +178,11 @@ void PacketReceiver::handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> pa
     auto it = _pendingMessages.find(key);
     QSharedPointer<ReceivedMessage> message;
 
-    if (it == _pendingMessages.end()) {
+    if (it == _pendingMessages.end() && nlPacket->getPacketPosition() == NLPacket::ONLY) {
+        // single packet message, read it in place
+        message = QSharedPointer<ReceivedMessage>::create(std::move(nlPacket));
+        handleVerifiedMessage(message, true);
+    } else if (it == _pendingMessages.end()) {
         // Create message
         message = QSharedPointer<ReceivedMessage>::create(*nlPacket);
         if (!message->isComplete()) {
@@ -193,6 +219,25 @@ void PacketReceiver::handleVerifiedMessage(QSharedPointer<ReceivedMessage> recei
         matchingNode = nodeList->nodeWithLocalID(receivedMessage->getSourceID());
     }
     QMutexLocker packetListenerLocker(&_packetListenerLock);
+
+    // typed handlers are invoked right here, on the receiving thread
+    auto type = (size_t)receivedMessage->getType();
+    if (type < _typedHandlers.size() && _typedHandlers[type].invoke) {
+        auto& handler = _typedHandlers[type];
+
+        if (!receivedMessage->isComplete()) {
+            return;
+        }
+
+        if (QObject* target = handler.target.data()) {
+            handler.invoke(target, receivedMessage, matchingNode);
+        } else {
+            qCDebug(networking).nospace() << "Typed handler for packet " << receivedMessage->getType()
+                << " has been destroyed. Removing it.";
+            handler = TypedHandler();
+        }
+        return;
+    }
     
     auto it = _messageListenerMap.find(receivedMessage->getType());
     if (it != _messageListenerMap.end() && !it->listener.isNull()) {
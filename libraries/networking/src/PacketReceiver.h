@@ -15,6 +15,7 @@
 #ifndef hifi_PacketReceiver_h
 #define hifi_PacketReceiver_h
 
+#include <array>
 #include <vector>
 #include <unordered_map>
 
@@ -77,6 +78,15 @@ public:
     bool registerListener(PacketType type, const ListenerReferencePointer& listener, bool deliverPending = false);
     bool registerListenerForTypes(PacketTypeList types, const ListenerReferencePointer& listener);
     void unregisterListener(QObject* listener);
+
+    // Typed handlers are called directly on the thread that receives the packet, without a Qt event loop hop.
+    // They are looked up in a flat table by packet type, take precedence over listeners registered for the same type,
+    // and only receive complete messages. They must be thread-safe: the usual handler hands the message off to a
+    // queue drained by the target's own thread or slave pool. The node is null for non-sourced packet types.
+    template <class T, void (T::*Handler)(const QSharedPointer<ReceivedMessage>&, const QSharedPointer<Node>&)>
+    void registerTypedHandler(PacketType type, T* target);
+    template <class T, void (T::*Handler)(const QSharedPointer<ReceivedMessage>&, const QSharedPointer<Node>&)>
+    void registerTypedHandlerForTypes(const PacketTypeList& types, T* target);
     
     void handleVerifiedPacket(std::unique_ptr<udt::Packet> packet);
     void handleVerifiedMessagePacket(std::unique_ptr<udt::Packet> message);
@@ -114,6 +124,17 @@ private:
         bool deliverPending;
     };
 
+    struct TypedHandler {
+        using Invoke = void (*)(QObject* target, const QSharedPointer<ReceivedMessage>& message, const QSharedPointer<Node>& node);
+        Invoke invoke { nullptr };
+        QPointer<QObject> target;
+    };
+
+    template <class T, void (T::*Handler)(const QSharedPointer<ReceivedMessage>&, const QSharedPointer<Node>&)>
+    static void invokeTypedHandler(QObject* target, const QSharedPointer<ReceivedMessage>& message, const QSharedPointer<Node>& node);
+
+    void registerVerifiedTypedHandler(PacketType type, TypedHandler::Invoke invoke, QObject* target);
+
     void handleVerifiedMessage(QSharedPointer<ReceivedMessage> message, bool justReceived);
 
     // these are brutal hacks for now - ideally GenericThread / ReceivedPacketProcessor
@@ -126,6 +147,7 @@ private:
 
     QMutex _packetListenerLock;
     QHash<PacketType, Listener> _messageListenerMap;
+    std::array<TypedHandler, (size_t)PacketType::NUM_PACKET_TYPE> _typedHandlers;
 
     bool _shouldDropPackets = false;
     QMutex _directConnectSetMutex;
@@ -175,4 +197,24 @@ bool PacketReceiver::SourcedListenerReference<T>::invokeDirectly(const QSharedPo
     return true;
 }
 
+template <class T, void (T::*Handler)(const QSharedPointer<ReceivedMessage>&, const QSharedPointer<Node>&)>
+void PacketReceiver::registerTypedHandler(PacketType type, T* target) {
+    Q_ASSERT_X(target, "PacketReceiver::registerTypedHandler", "No target to register");
+    registerVerifiedTypedHandler(type, &PacketReceiver::invokeTypedHandler<T, Handler>, target);
+}
+
+template <class T, void (T::*Handler)(const QSharedPointer<ReceivedMessage>&, const QSharedPointer<Node>&)>
+void PacketReceiver::registerTypedHandlerForTypes(const PacketTypeList& types, T* target) {
+    Q_ASSERT_X(!types.empty(), "PacketReceiver::registerTypedHandlerForTypes", "No types to register");
+    for (auto type : types) {
+        registerTypedHandler<T, Handler>(type, target);
+    }
+}
+
+template <class T, void (T::*Handler)(const QSharedPointer<ReceivedMessage>&, const QSharedPointer<Node>&)>
+void PacketReceiver::invokeTypedHandler(QObject* target, const QSharedPointer<ReceivedMessage>& message,
+                                        const QSharedPointer<Node>& node) {
+    (static_cast<T*>(target)->*Handler)(message, node);
+}
+
 #endif // hifi_PacketReceiver_h
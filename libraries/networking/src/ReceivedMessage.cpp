@@ -48,6 +48,24 @@ ReceivedMessage::ReceivedMessage(NLPacket& packet)
     _firstPacketReceiveTime = duration_cast<microseconds>(packet.getReceiveTime().time_since_epoch()).count();
 }
 
+ReceivedMessage::ReceivedMessage(std::unique_ptr<NLPacket> packet)
+    : _packet(std::move(packet)),
+      _numPackets(1),
+      _sourceID(_packet->getSourceID()),
+      _packetType(_packet->getType()),
+      _packetVersion(_packet->getVersion()),
+      _senderSockAddr(_packet->getSenderSockAddr()),
+      _isComplete(_packet->getPacketPosition() == NLPacket::ONLY)
+{
+    Q_ASSERT_X(_isComplete, "ReceivedMessage::ReceivedMessage",
+               "Only complete single-packet messages can be read in place");
+
+    // the packet outlives _data, and is never appended to, so the raw data stays valid
+    _data = QByteArray::fromRawData(_packet->getPayload() + _packet->pos(), _packet->bytesLeftToRead());
+    _headData = QByteArray::fromRawData(_data.constData(), std::min(_data.size(), HEAD_DATA_SIZE));
+    _firstPacketReceiveTime = duration_cast<microseconds>(_packet->getReceiveTime().time_since_epoch()).count();
+}
+
 ReceivedMessage::ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                 const SockAddr& senderSockAddr, NLPacket::LocalID sourceID) :
     _data(byteArray),
@@ -71,6 +89,7 @@ void ReceivedMessage::setFailed() {
 void ReceivedMessage::appendPacket(NLPacket& packet) {
     Q_ASSERT_X(!_isComplete, "ReceivedMessage::appendPacket", 
                "We should not be appending to a complete message");
+    Q_ASSERT(!isBorrowed());
 
     // Limit progress signal to every X packets
     const int EMIT_PROGRESS_EVERY_X_PACKETS = 50;
@@ -118,18 +137,27 @@ qint64 ReceivedMessage::readHead(char* data, qint64 size) {
     return sizeRead;
 }
 
+QByteArray ReceivedMessage::getMessage() const {
+    return copyData(0, _data.size());
+}
+
 QByteArray ReceivedMessage::peek(qint64 size) {
-    return _data.mid(_position, size);
+    return copyData(_position, size);
 }
 
 QByteArray ReceivedMessage::read(qint64 size) {
-    auto data = _data.mid(_position, size);
+    auto data = copyData(_position, size);
     _position += size;
     return data;
 }
 
 QByteArray ReceivedMessage::readHead(qint64 size) {
-    auto data = _headData.mid(_position, size);
+    QByteArray data;
+    if (isBorrowed()) {
+        data = copyData(_position, std::max<qint64>(0, std::min(size, (qint64)_headData.size() - _position)));
+    } else {
+        data = _headData.mid(_position, size);
+    }
     _position += size;
     return data;
 }
@@ -153,6 +181,19 @@ QByteArray ReceivedMessage::readWithoutCopy(qint64 size) {
     return data;
 }
 
+QByteArray ReceivedMessage::copyData(qint64 position, qint64 size) const {
+    if (!isBorrowed()) {
+        return _data.mid(position, size);
+    }
+
+    // QByteArray::mid() can share the raw data, which must not outlive the packet
+    qint64 bytesLeft = std::max(_data.size() - position, (qint64)0);
+    if (size < 0 || size > bytesLeft) {
+        size = bytesLeft;
+    }
+    return size > 0 ? QByteArray(_data.constData() + position, size) : QByteArray();
+}
+
 void ReceivedMessage::onComplete() {
     _isComplete = true;
     emit completed();
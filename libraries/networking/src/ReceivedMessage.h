@@ -19,6 +19,7 @@
 #include <QtCore/QSharedPointer>
 
 #include <atomic>
+#include <memory>
 
 #include "NLPacketList.h"
 
@@ -27,10 +28,14 @@ class ReceivedMessage : public QObject {
 public:
     ReceivedMessage(const NLPacketList& packetList);
     ReceivedMessage(NLPacket& packet);
+
+    // Takes ownership of a single-packet message and reads it in place, without copying the payload
+    ReceivedMessage(std::unique_ptr<NLPacket> packet);
+
     ReceivedMessage(QByteArray byteArray, PacketType packetType, PacketVersion packetVersion,
                     const SockAddr& senderSockAddr, NLPacket::LocalID sourceID = NLPacket::NULL_LOCAL_ID);
 
-    QByteArray getMessage() const { return _data; }
+    QByteArray getMessage() const;
     const char* getRawMessage() const { return _data.constData(); }
 
     PacketType getType() const { return _packetType; }
@@ -84,6 +89,9 @@ public:
 
     template<typename T> qint64 readHeadPrimitive(T* data);
 
+    // True if the message data is read in place from the packet it arrived in
+    bool isBorrowed() const { return _packet != nullptr; }
+
 signals:
     void progress(qint64 size);
     void completed();
@@ -92,6 +100,10 @@ private slots:
     void onComplete();
 
 private:
+    QByteArray copyData(qint64 position, qint64 size) const;
+
+    std::unique_ptr<NLPacket> _packet;  // backs _data when the message is borrowed
+
     QByteArray _data;
     QByteArray _headData;
 
@@ -67,6 +67,10 @@ protected:
     /// \param QByteArray& the packet to be processed
     virtual void processPacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) = 0;
 
+    /// Override to process all the packets taken off the queue together. Default hands them to processPacket() one by one
+    /// and calls midProcess() after each.
+    virtual void processPackets(std::list<NodeSharedReceivedMessagePair>& packets);
+
     /// Implements generic processing behavior for this thread.
     virtual bool process() override;
 
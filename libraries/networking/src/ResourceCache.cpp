@@ -12,6 +12,7 @@
 #include "ResourceCache.h"
 #include "ResourceRequestObserver.h"
 
+#include <algorithm>
 #include <cfloat>
 #include <cmath>
 #include <assert.h>
@@ -20,26 +21,157 @@
 #include <QtCore/QThread>
 #include <QtCore/QTimer>
 
+#include <NumericalConstants.h>
 #include <SharedUtil.h>
 #include <shared/QtHelpers.h>
 #include <Trace.h>
 #include <Profile.h>
 
+#include "HTTPResourceRequest.h"
 #include "NetworkAccessManager.h"
 #include "NetworkLogging.h"
 #include "NodeList.h"
 
+// the shares of the bandwidth guaranteed to each request class, among those with pending requests
+static const float REQUEST_CLASS_BUDGETS[ResourceCacheSharedItems::NUM_REQUEST_CLASSES] = { 0.4f, 0.3f, 0.2f, 0.1f, 0.0f };
+static const char* REQUEST_CLASS_NAMES[ResourceCacheSharedItems::NUM_REQUEST_CLASSES] = {
+    "avatar", "nearby", "texture", "distant", "speculative"
+};
+
+// the recent bytes received by each request class halve every second
+static const float RECENT_BYTES_HALF_LIFE = (float)USECS_PER_SECOND;
+
+static const quint64 WAIT_TIME_BUCKET_LIMITS[ResourceCacheSharedItems::NUM_WAIT_TIME_BUCKETS - 1] = {
+    10 * USECS_PER_MSEC, 100 * USECS_PER_MSEC, USECS_PER_SECOND, 10 * USECS_PER_SECOND
+};
+
+// the entity load priorities are computed as atan2(maxDim, distance)
+static const float MAX_ENTITY_LOAD_PRIORITY = PI_OVER_TWO;
+static const float NEARBY_LOAD_PRIORITY = 0.1f; // about 6 degrees across
+
+bool ResourceCacheSharedItems::PendingRequest::operator<(const PendingRequest& other) const {
+    // local files first, then the highest priorities, then the oldest requests
+    if (isFile != other.isFile) {
+        return other.isFile;
+    }
+    if (priority != other.priority) {
+        return priority < other.priority;
+    }
+    return generation > other.generation;
+}
+
+QString ResourceCacheSharedItems::getHostKey(const QUrl& url) {
+    // only the requests to remote hosts are limited
+    auto scheme = url.scheme();
+    if (scheme == HIFI_URL_SCHEME_HTTP || scheme == HIFI_URL_SCHEME_HTTPS || scheme == URL_SCHEME_ATP) {
+        return scheme + "://" + url.host() + ":" + QString::number(url.port());
+    }
+    return QString();
+}
+
+bool ResourceCacheSharedItems::hasHostCapacity(const QString& host) const {
+    return host.isEmpty() || _numLoadingRequestsPerHost.value(host) < MAX_REQUESTS_PER_HOST;
+}
+
 bool ResourceCacheSharedItems::appendRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
-    if ((uint32_t)_loadingRequests.size() < _requestLimit) {
-        _loadingRequests.append(resource);
+    auto locked = resource.lock();
+    if (!locked) {
+        return false;
+    }
+
+    float priority = locked->getLoadPriority();
+    auto requestClass = locked->getRequestClass(priority);
+    QString host = getHostKey(locked->getURL());
+    if ((uint32_t)_loadingRequests.size() < _requestLimit && hasHostCapacity(host)) {
+        startRequest(locked, requestClass, host);
         return true;
     } else {
-        _pendingRequests.append(resource);
+        queueRequest(locked, priority, requestClass);
         return false;
     }
 }
 
+void ResourceCacheSharedItems::queueRequest(const QSharedPointer<Resource>& resource, float priority,
+                                            ResourceRequestClass requestClass) {
+    if (resource->_pendingGeneration == 0) {
+        resource->_pendingTime = usecTimestampNow();
+        _numPendingRequests++;
+    } else {
+        _requestClassStats[(int)resource->_requestClass].numPending--;
+    }
+    _requestClassStats[(int)requestClass].numPending++;
+
+    // the previous entries of the resource are left in their heaps, and skipped as they come up
+    resource->_pendingGeneration = ++_lastGeneration;
+    resource->_requestClass = requestClass;
+    bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
+    auto& pendingRequests = _pendingRequests[(int)requestClass];
+    pendingRequests.push_back({ resource, priority, isFile, resource->_pendingGeneration });
+    std::push_heap(pendingRequests.begin(), pendingRequests.end());
+}
+
+void ResourceCacheSharedItems::startRequest(const QSharedPointer<Resource>& resource, ResourceRequestClass requestClass,
+                                            const QString& host) {
+    quint64 waitTime = 0;
+    if (resource->_pendingGeneration != 0) {
+        waitTime = usecTimestampNow() - resource->_pendingTime;
+        _requestClassStats[(int)resource->_requestClass].numPending--;
+        _numPendingRequests--;
+        resource->_pendingGeneration = 0;
+    }
+    resource->_requestClass = requestClass;
+
+    auto& stats = _requestClassStats[(int)requestClass];
+    int bucket = 0;
+    while (bucket < NUM_WAIT_TIME_BUCKETS - 1 && waitTime >= WAIT_TIME_BUCKET_LIMITS[bucket]) {
+        bucket++;
+    }
+    stats.waitTimes[bucket]++;
+    stats.numLoading++;
+
+    _loadingRequests.append({ resource, host, requestClass });
+    if (!host.isEmpty()) {
+        _numLoadingRequestsPerHost[host]++;
+    }
+}
+
+void ResourceCacheSharedItems::reprioritizeRequest(Resource* resource) {
+    Lock lock(_mutex);
+    if (resource->_pendingGeneration == 0) {
+        return;
+    }
+    auto self = resource->_self.lock();
+    if (self) {
+        float priority = self->getLoadPriority();
+        queueRequest(self, priority, self->getRequestClass(priority));
+    }
+}
+
+void ResourceCacheSharedItems::removePendingRequest(Resource* resource) {
+    Lock lock(_mutex);
+    if (resource->_pendingGeneration != 0) {
+        _requestClassStats[(int)resource->_requestClass].numPending--;
+        _numPendingRequests--;
+        resource->_pendingGeneration = 0;
+    }
+}
+
+void ResourceCacheSharedItems::decayRecentBytes() {
+    quint64 now = usecTimestampNow();
+    float decay = powf(0.5f, (float)(now - _lastBytesDecay) / RECENT_BYTES_HALF_LIFE);
+    _lastBytesDecay = now;
+    for (auto& stats : _requestClassStats) {
+        stats.recentBytes *= decay;
+    }
+}
+
+void ResourceCacheSharedItems::addReceivedBytes(ResourceRequestClass requestClass, qint64 bytes) {
+    Lock lock(_mutex);
+    decayRecentBytes();
+    _requestClassStats[(int)requestClass].recentBytes += (float)bytes;
+}
+
 void ResourceCacheSharedItems::setRequestLimit(uint32_t limit) {
     Lock lock(_mutex);
     _requestLimit = limit;
@@ -54,10 +186,12 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach (QWeakPointer<Resource> resource, _pendingRequests) {
-        auto locked = resource.lock();
-        if (locked) {
-            result.append(locked);
+    for (const auto& pendingRequests : _pendingRequests) {
+        for (const auto& request : pendingRequests) {
+            auto locked = request.resource.lock();
+            if (locked && locked->_pendingGeneration == request.generation) {
+                result.append(locked);
+            }
         }
     }
 
@@ -66,15 +200,15 @@ QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getPendingRequests() c
 
 uint32_t ResourceCacheSharedItems::getPendingRequestsCount() const {
     Lock lock(_mutex);
-    return _pendingRequests.size();
+    return _numPendingRequests;
 }
 
 QList<QSharedPointer<Resource>> ResourceCacheSharedItems::getLoadingRequests() const {
     QList<QSharedPointer<Resource>> result;
     Lock lock(_mutex);
 
-    foreach(QWeakPointer<Resource> resource, _loadingRequests) {
-        auto locked = resource.lock();
+    for (const auto& request : _loadingRequests) {
+        auto locked = request.resource.lock();
         if (locked) {
             result.append(locked);
         }
@@ -88,6 +222,15 @@ uint32_t ResourceCacheSharedItems::getLoadingRequestsCount() const {
     return _loadingRequests.size();
 }
 
+void ResourceCacheSharedItems::removeLoadingRequestAt(int index) {
+    const auto& request = _loadingRequests.at(index);
+    if (!request.host.isEmpty() && --_numLoadingRequestsPerHost[request.host] <= 0) {
+        _numLoadingRequestsPerHost.remove(request.host);
+    }
+    _requestClassStats[(int)request.requestClass].numLoading--;
+    _loadingRequests.removeAt(index);
+}
+
 void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     Lock lock(_mutex);
 
@@ -95,56 +238,131 @@ void ResourceCacheSharedItems::removeRequest(QWeakPointer<Resource> resource) {
     // QWeakPointer has no operator== implementation for two weak ptrs, so
     // manually loop in case resource has been freed.
     for (int i = 0; i < _loadingRequests.size();) {
-        auto request = _loadingRequests.at(i);
+        auto request = _loadingRequests.at(i).resource;
         // Clear our resource and any freed resources
         if (!request || request.data() == resource.data()) {
-            _loadingRequests.removeAt(i);
+            removeLoadingRequestAt(i);
             continue;
         }
         i++;
     }
 }
 
-QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
-    // look for the highest priority pending request
-    int highestIndex = -1;
-    float highestPriority = -FLT_MAX;
-    QSharedPointer<Resource> highestResource;
-    Lock lock(_mutex);
+QSharedPointer<Resource> ResourceCacheSharedItems::takeRequest(ResourceRequestClass requestClass) {
+    auto& pendingRequests = _pendingRequests[(int)requestClass];
+    PendingRequests blockedRequests;
+    QSharedPointer<Resource> resource;
 
-    bool currentHighestIsFile = false;
+    while (!resource && !pendingRequests.empty()) {
+        std::pop_heap(pendingRequests.begin(), pendingRequests.end());
+        PendingRequest request = pendingRequests.back();
+        pendingRequests.pop_back();
 
-    for (int i = 0; i < _pendingRequests.size();) {
-        // Clear any freed resources
-        auto resource = _pendingRequests.at(i).lock();
-        if (!resource) {
-            _pendingRequests.removeAt(i);
+        // Skip the freed resources and the requests that were queued again since
+        auto locked = request.resource.lock();
+        if (!locked || locked->_pendingGeneration != request.generation) {
             continue;
         }
 
-        // Check load priority
-        float priority = resource->getLoadPriority();
-        bool isFile = resource->getURL().scheme() == HIFI_URL_SCHEME_FILE;
-        if (priority >= highestPriority && (isFile || !currentHighestIsFile)) {
-            highestPriority = priority;
-            highestIndex = i;
-            highestResource = resource;
-            currentHighestIsFile = isFile;
+        // The priority drops when an owner goes away (e.g. out of view), so it is checked again
+        float priority = locked->getLoadPriority();
+        if (priority != request.priority) {
+            queueRequest(locked, priority, locked->getRequestClass(priority));
+            continue;
         }
-        i++;
+
+        if (!hasHostCapacity(getHostKey(locked->getURL()))) {
+            blockedRequests.push_back(request);
+            continue;
+        }
+        resource = locked;
+    }
+
+    for (const auto& request : blockedRequests) {
+        pendingRequests.push_back(request);
+        std::push_heap(pendingRequests.begin(), pendingRequests.end());
+    }
+    return resource;
+}
+
+QSharedPointer<Resource> ResourceCacheSharedItems::getHighestPendingRequest() {
+    Lock lock(_mutex);
+    decayRecentBytes();
+
+    float totalBudget = 0.0f;
+    float totalRecentBytes = 0.0f;
+    for (uint32_t i = 0; i < NUM_REQUEST_CLASSES; i++) {
+        if (_requestClassStats[i].numPending > 0) {
+            totalBudget += REQUEST_CLASS_BUDGETS[i];
+        }
+        totalRecentBytes += _requestClassStats[i].recentBytes;
     }
 
-    if (highestIndex >= 0) {
-        _pendingRequests.takeAt(highestIndex);
+    // A class getting less than its share of the bandwidth goes first, then the classes go in order
+    if (totalBudget > 0.0f) {
+        for (uint32_t i = 0; i < NUM_REQUEST_CLASSES; i++) {
+            const auto& stats = _requestClassStats[i];
+            float share = REQUEST_CLASS_BUDGETS[i] / totalBudget;
+            if (stats.numPending > 0 && stats.recentBytes < share * totalRecentBytes) {
+                auto resource = takeRequest((ResourceRequestClass)i);
+                if (resource) {
+                    return resource;
+                }
+            }
+        }
+    }
+    for (uint32_t i = 0; i < NUM_REQUEST_CLASSES; i++) {
+        if (_requestClassStats[i].numPending > 0) {
+            auto resource = takeRequest((ResourceRequestClass)i);
+            if (resource) {
+                return resource;
+            }
+        }
     }
+    return QSharedPointer<Resource>();
+}
+
+QVariantMap ResourceCacheSharedItems::getRequestQueueStats() const {
+    QVariantMap result;
+    Lock lock(_mutex);
 
-    return highestResource;
+    float decay = powf(0.5f, (float)(usecTimestampNow() - _lastBytesDecay) / RECENT_BYTES_HALF_LIFE);
+    for (uint32_t i = 0; i < NUM_REQUEST_CLASSES; i++) {
+        const auto& stats = _requestClassStats[i];
+        QVariantList waitTimes;
+        for (auto count : stats.waitTimes) {
+            waitTimes.append(count);
+        }
+
+        // the recent bytes sum to the rate times the integral of the decay
+        QVariantMap classStats;
+        classStats["pending"] = stats.numPending;
+        classStats["loading"] = stats.numLoading;
+        classStats["bytesPerSecond"] = stats.recentBytes * decay * logf(2.0f) * (float)USECS_PER_SECOND / RECENT_BYTES_HALF_LIFE;
+        classStats["waitTimes"] = waitTimes;
+        result[REQUEST_CLASS_NAMES[i]] = classStats;
+    }
+    return result;
 }
 
 void ResourceCacheSharedItems::clear() {
     Lock lock(_mutex);
-    _pendingRequests.clear();
+    for (auto& pendingRequests : _pendingRequests) {
+        for (const auto& request : pendingRequests) {
+            auto locked = request.resource.lock();
+            if (locked) {
+                locked->_pendingGeneration = 0;
+            }
+        }
+        pendingRequests.clear();
+    }
     _loadingRequests.clear();
+    _numLoadingRequestsPerHost.clear();
+    for (auto& stats : _requestClassStats) {
+        stats.numPending = 0;
+        stats.numLoading = 0;
+    }
+    _numPendingRequests = 0;
 }
 
 ScriptableResourceCache::ScriptableResourceCache(QSharedPointer<ResourceCache> resourceCache) {
@@ -344,13 +562,36 @@ void ResourceCache::setRequestLimit(uint32_t limit) {
     auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
     sharedItems->setRequestLimit(limit);
 
-    // Now go fill any new request spots
+    // Now go fill any new request spots, while the hosts of the pending requests allow
     while (sharedItems->getLoadingRequestsCount() < limit && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
 QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl& fallback, void* extra, size_t extraHash) {
+    return getResource(url, fallback, extra, extraHash, false);
+}
+
+QSharedPointer<Resource> ResourceCache::getSpeculativeResource(const QUrl& url, void* extra, size_t extraHash) {
+    {
+        // any copy of the resource has already been downloaded
+        QReadLocker locker(&_resourcesLock);
+        auto resourcesWithExtraHash = _resources.find(url);
+        if (resourcesWithExtraHash != _resources.end()) {
+            for (const auto& resource : resourcesWithExtraHash.value()) {
+                if (!resource.isNull()) {
+                    return QSharedPointer<Resource>();
+                }
+            }
+        }
+    }
+    return getResource(url, QUrl(), extra, extraHash, true);
+}
+
+QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl& fallback, void* extra, size_t extraHash,
+                                                    bool speculative) {
     QSharedPointer<Resource> resource;
     {
         QWriteLocker locker(&_resourcesLock);
@@ -359,6 +600,10 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
         if (resourcesWithExtraHashIter != resourcesWithExtraHash.end()) {
             // We've seen this extra info before
             resource = resourcesWithExtraHashIter.value().lock();
+            if (resource && !speculative && resource->_speculative.exchange(false)) {
+                DependencyManager::get<ResourceCacheSharedItems>()->speculativeHit();
+                resource->reprioritizeRequest();
+            }
         } else if (resourcesWithExtraHash.size() > 0.0f) {
             auto oldResource = resourcesWithExtraHash.begin().value().lock();
             if (oldResource) {
@@ -387,6 +632,10 @@ QSharedPointer<Resource> ResourceCache::getResource(const QUrl& url, const QUrl&
         resource = createResource(url);
         resource->setExtra(extra);
         resource->setExtraHash(extraHash);
+        if (speculative) {
+            resource->_speculative = true;
+            DependencyManager::get<ResourceCacheSharedItems>()->speculativeRequested();
+        }
         resource->setSelf(resource);
         resource->setCache(this);
         resource->moveToThread(qApp->thread());
@@ -530,6 +779,32 @@ uint32_t ResourceCache::getLoadingRequestCount() {
     return DependencyManager::get<ResourceCacheSharedItems>()->getLoadingRequestsCount();
 }
 
+QVariantMap ResourceCache::getRequestQueueStats() {
+    return DependencyManager::get<ResourceCacheSharedItems>()->getRequestQueueStats();
+}
+
+QVariantMap ResourceCache::getHostStats() {
+    return HTTPResourceRequest::getHostStats();
+}
+
+uint32_t ResourceCache::getSpeculativeRequestCount() {
+    return DependencyManager::get<ResourceCacheSharedItems>()->getSpeculativeRequestsCount();
+}
+
+uint32_t ResourceCache::getSpeculativeHitCount() {
+    return DependencyManager::get<ResourceCacheSharedItems>()->getSpeculativeHitsCount();
+}
+
+uint32_t ResourceCache::getSpeculativeMissCount() {
+    return DependencyManager::get<ResourceCacheSharedItems>()->getSpeculativeMissesCount();
+}
+
+void ResourceCache::cancelSpeculativeResource(const QSharedPointer<Resource>& resource) {
+    if (resource && resource->_speculative.exchange(false)) {
+        DependencyManager::get<ResourceCacheSharedItems>()->speculativeMissed();
+    }
+}
+
 bool ResourceCache::attemptRequest(QSharedPointer<Resource> resource) {
     Q_ASSERT(!resource.isNull());
 
@@ -546,9 +821,11 @@ void ResourceCache::requestCompleted(QWeakPointer<Resource> resource) {
 
     sharedItems->removeRequest(resource);
 
-    // Now go fill any new request spots
+    // Now go fill any new request spots, while the hosts of the pending requests allow
     while (sharedItems->getLoadingRequestsCount() < sharedItems->getRequestLimit() && sharedItems->getPendingRequestsCount() > 0) {
-        attemptHighestPriorityRequest();
+        if (!attemptHighestPriorityRequest()) {
+            break;
+        }
     }
 }
 
@@ -590,6 +867,12 @@ Resource::Resource(const QUrl& url) :
 }
 
 Resource::~Resource() {
+    if (_pendingGeneration != 0) {
+        auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+        if (sharedItems) {
+            sharedItems->removePendingRequest(this);
+        }
+    }
     if (_request) {
         _request->disconnect(this);
         _request->deleteLater();
@@ -607,6 +890,7 @@ void Resource::ensureLoading() {
 void Resource::setLoadPriority(const QPointer<QObject>& owner, float priority) {
     if (!_failedToLoad) {
         _loadPriorities.insert(owner, priority);
+        reprioritizeRequest();
     }
 }
 
@@ -618,12 +902,32 @@ void Resource::setLoadPriorities(const QHash<QPointer<QObject>, float>& prioriti
             it != priorities.constEnd(); it++) {
         _loadPriorities.insert(it.key(), it.value());
     }
+    reprioritizeRequest();
 }
 
 void Resource::clearLoadPriority(const QPointer<QObject>& owner) {
     if (!_failedToLoad) {
         _loadPriorities.remove(owner);
+        reprioritizeRequest();
+    }
+}
+
+void Resource::reprioritizeRequest() {
+    // a pending request is scheduled by its priority
+    if (_pendingGeneration != 0) {
+        DependencyManager::get<ResourceCacheSharedItems>()->reprioritizeRequest(this);
+    }
+}
+
+ResourceRequestClass Resource::getRequestClass(float priority) const {
+    if (_speculative) {
+        return ResourceRequestClass::SPECULATIVE;
+    } else if (priority > MAX_ENTITY_LOAD_PRIORITY) {
+        return ResourceRequestClass::AVATAR;
+    } else if (priority >= NEARBY_LOAD_PRIORITY) {
+        return ResourceRequestClass::NEARBY;
     }
+    return ResourceRequestClass::DISTANT;
 }
 
 float Resource::getLoadPriority() {
@@ -772,6 +1076,9 @@ void Resource::makeRequest() {
 }
 
 void Resource::handleDownloadProgress(uint64_t bytesReceived, uint64_t bytesTotal) {
+    // the bytes received are counted from the start of each request
+    qint64 receivedBytes = (qint64)bytesReceived > _bytesReceived ? (qint64)bytesReceived - _bytesReceived : (qint64)bytesReceived;
+    DependencyManager::get<ResourceCacheSharedItems>()->addReceivedBytes(_requestClass, receivedBytes);
     _bytesReceived = bytesReceived;
     _bytesTotal = bytesTotal;
 }
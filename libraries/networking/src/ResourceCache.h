@@ -14,6 +14,7 @@
 
 #include <atomic>
 #include <mutex>
+#include <vector>
 
 #include <QtCore/QHash>
 #include <QtCore/QList>
@@ -55,6 +56,18 @@ static const qint64 DEFAULT_UNUSED_MAX_SIZE = 1024 * BYTES_PER_MEGABYTES;
 static const qint64 MIN_UNUSED_MAX_SIZE = 0;
 static const qint64 MAX_UNUSED_MAX_SIZE = MAXIMUM_CACHE_SIZE;
 
+// The classes of resource requests, from the first to be made. Under contention, each class with pending requests is
+// still guaranteed its share of the download bandwidth (see ResourceCacheSharedItems::getHighestPendingRequest).
+enum class ResourceRequestClass : uint8_t {
+    AVATAR = 0,     // avatars, and what is prioritized above every entity: skyboxes, texture headers, animation graphs
+    NEARBY,         // the entities taking up a large part of the view
+    TEXTURE,        // the textures of the entities and models
+    DISTANT,        // everything else
+    SPECULATIVE,    // predicted to be needed, only loaded when nothing else is pending
+
+    NUM_CLASSES
+};
+
 // We need to make sure that these items are available for all instances of
 // ResourceCache derived classes. Since we can't count on the ordering of
 // static members destruction, we need to use this Dependency manager implemented
@@ -66,8 +79,17 @@ class ResourceCacheSharedItems : public Dependency  {
     using Lock = std::unique_lock<Mutex>;
 
 public:
+    static const uint32_t NUM_REQUEST_CLASSES = (uint32_t)ResourceRequestClass::NUM_CLASSES;
+    static const int NUM_WAIT_TIME_BUCKETS = 5;
+
+    // The concurrent requests to a single HTTP or ATP host
+    static const int MAX_REQUESTS_PER_HOST = 6;
+
     bool appendRequest(QWeakPointer<Resource> newRequest);
     void removeRequest(QWeakPointer<Resource> doneRequest);
+    void reprioritizeRequest(Resource* resource);
+    void removePendingRequest(Resource* resource);
+    void addReceivedBytes(ResourceRequestClass requestClass, qint64 bytes);
     void setRequestLimit(uint32_t limit);
     uint32_t getRequestLimit() const;
     QList<QSharedPointer<Resource>> getPendingRequests() const;
@@ -77,14 +99,66 @@ public:
     uint32_t getLoadingRequestsCount() const;
     void clear();
 
+    // The queue depth, loading requests, bandwidth and wait time histogram of each request class
+    QVariantMap getRequestQueueStats() const;
+
+    // Telemetry of the speculative requests, made ahead of their resources being needed
+    void speculativeRequested() { _numSpeculativeRequests++; }
+    void speculativeHit() { _numSpeculativeHits++; }
+    void speculativeMissed() { _numSpeculativeMisses++; }
+    uint32_t getSpeculativeRequestsCount() const { return _numSpeculativeRequests; }
+    uint32_t getSpeculativeHitsCount() const { return _numSpeculativeHits; }
+    uint32_t getSpeculativeMissesCount() const { return _numSpeculativeMisses; }
+
 private:
     ResourceCacheSharedItems() = default;
 
+    struct PendingRequest {
+        QWeakPointer<Resource> resource;
+        float priority;
+        bool isFile;
+        uint32_t generation;
+
+        // ordered by when they are made, so the heap tops are the next requests
+        bool operator<(const PendingRequest& other) const;
+    };
+    using PendingRequests = std::vector<PendingRequest>;
+
+    struct LoadingRequest {
+        QWeakPointer<Resource> resource;
+        QString host;
+        ResourceRequestClass requestClass;
+    };
+
+    struct RequestClassStats {
+        uint32_t numPending { 0 };
+        uint32_t numLoading { 0 };
+        float recentBytes { 0.0f };
+        uint32_t waitTimes[NUM_WAIT_TIME_BUCKETS] { 0 };
+    };
+
+    static QString getHostKey(const QUrl& url);
+    bool hasHostCapacity(const QString& host) const;
+    void queueRequest(const QSharedPointer<Resource>& resource, float priority, ResourceRequestClass requestClass);
+    void startRequest(const QSharedPointer<Resource>& resource, ResourceRequestClass requestClass, const QString& host);
+    QSharedPointer<Resource> takeRequest(ResourceRequestClass requestClass);
+    void removeLoadingRequestAt(int index);
+    void decayRecentBytes();
+
     mutable Mutex _mutex;
-    QList<QWeakPointer<Resource>> _pendingRequests;
-    QList<QWeakPointer<Resource>> _loadingRequests;
+    PendingRequests _pendingRequests[NUM_REQUEST_CLASSES];
+    QList<LoadingRequest> _loadingRequests;
+    QHash<QString, int> _numLoadingRequestsPerHost;
+    RequestClassStats _requestClassStats[NUM_REQUEST_CLASSES];
+    uint32_t _numPendingRequests { 0 };
+    uint32_t _lastGeneration { 0 };
+    quint64 _lastBytesDecay { 0 };
     const uint32_t DEFAULT_REQUEST_LIMIT = 10;
     uint32_t _requestLimit { DEFAULT_REQUEST_LIMIT };
+
+    std::atomic<uint32_t> _numSpeculativeRequests { 0 };
+    std::atomic<uint32_t> _numSpeculativeHits { 0 };
+    std::atomic<uint32_t> _numSpeculativeMisses { 0 };
 };
 
 /// Wrapper to expose resources to JS/QML
@@ -219,6 +293,15 @@ public:
     static QList<QSharedPointer<Resource>> getLoadingRequests();
     static uint32_t getPendingRequestCount();
     static uint32_t getLoadingRequestCount();
+    static QVariantMap getRequestQueueStats();
+    static QVariantMap getHostStats();
+    static uint32_t getSpeculativeRequestCount();
+    static uint32_t getSpeculativeHitCount();
+    static uint32_t getSpeculativeMissCount();
+
+    /// Stops speculating on a resource returned by getSpeculativeResource that was not requested since, counting it
+    /// as a miss. Releasing the last reference to it then cancels its download.
+    static void cancelSpeculativeResource(const QSharedPointer<Resource>& resource);
 
     ResourceCache(QObject* parent = nullptr);
     virtual ~ResourceCache();
@@ -248,6 +331,11 @@ protected slots:
     QSharedPointer<Resource> getResource(const QUrl& url, const QUrl& fallback = QUrl()) { return getResource(url, fallback, nullptr, std::numeric_limits<size_t>::max()); }
     QSharedPointer<Resource> getResource(const QUrl& url, const QUrl& fallback, void* extra, size_t extraHash);
 
+    /// Loads a resource predicted to be needed soon, which only loads after every resource actually requested.
+    /// A request through getResource while it is held turns it into a regular resource, and counts as a hit.
+    /// \return an empty pointer if the resource is already known, as there is nothing to speculate on
+    QSharedPointer<Resource> getSpeculativeResource(const QUrl& url, void* extra, size_t extraHash);
+
 private slots:
     void clearATPAssets();
 
@@ -276,6 +364,7 @@ private:
     friend class Resource;
     friend class ScriptableResourceCache;
 
+    QSharedPointer<Resource> getResource(const QUrl& url, const QUrl& fallback, void* extra, size_t extraHash, bool speculative);
     void reserveUnusedResource(qint64 resourceSize);
     void removeResource(const QUrl& url, size_t extraHash, qint64 size = 0);
 
@@ -327,6 +416,15 @@ class ScriptableResourceCache : public QObject {
     Q_PROPERTY(size_t numGlobalQueriesPending READ getNumGlobalQueriesPending NOTIFY dirty)
     Q_PROPERTY(size_t numGlobalQueriesLoading READ getNumGlobalQueriesLoading NOTIFY dirty)
 
+    /*@jsdoc
+     * @property {number} numGlobalSpeculativeHits - Total number of resources loaded ahead of being requested that were then
+     *     requested (across all resource cache managers). <em>Read-only.</em>
+     * @property {number} numGlobalSpeculativeMisses - Total number of resources loaded ahead of being requested that were
+     *     not (across all resource cache managers). <em>Read-only.</em>
+     */
+    Q_PROPERTY(size_t numGlobalSpeculativeHits READ getNumGlobalSpeculativeHits NOTIFY dirty)
+    Q_PROPERTY(size_t numGlobalSpeculativeMisses READ getNumGlobalSpeculativeMisses NOTIFY dirty)
+
 public:
     ScriptableResourceCache(QSharedPointer<ResourceCache> resourceCache);
 
@@ -384,6 +482,38 @@ public:
     // FIXME: This function variation shouldn't be in the API.
     Q_INVOKABLE ScriptableResource* prefetch(const QUrl& url, void* extra, size_t extraHash);
 
+    /*@jsdoc
+     * Gets the state of the request queue of each request class (across all resource cache managers). The classes are
+     * made in the order <code>avatar</code>, <code>nearby</code>, <code>texture</code>, <code>distant</code>, then
+     * <code>speculative</code>, each getting a share of the bandwidth while it has pending requests.
+     * @function ResourceCache.getRequestQueueStats
+     * @returns {Object<string, ResourceCache.RequestClassStats>} The state of each request class, by name.
+     */
+    /*@jsdoc
+     * @typedef {object} ResourceCache.RequestClassStats
+     * @property {number} pending - The number of pending requests.
+     * @property {number} loading - The number of requests loading.
+     * @property {number} bytesPerSecond - The recent download rate.
+     * @property {number[]} waitTimes - The number of requests that waited less than 10ms, 100ms, 1s, 10s, then longer
+     *     before being made.
+     */
+    Q_INVOKABLE QVariantMap getRequestQueueStats() { return ResourceCache::getRequestQueueStats(); }
+
+    /*@jsdoc
+     * Gets the HTTP downloads made from each host since startup. Requests answered by another request for the same data
+     * that was in flight aren't counted.
+     * @function ResourceCache.getHostStats
+     * @returns {Object<string, ResourceCache.HostStats>} The downloads from each host, by host name.
+     */
+    /*@jsdoc
+     * @typedef {object} ResourceCache.HostStats
+     * @property {number} requests - The number of requests made.
+     * @property {number} bytes - The number of bytes downloaded, not counting those loaded from the disk cache.
+     * @property {number} msecs - The time spent downloading those bytes, summed over the requests.
+     * @property {number} bytesPerSecond - The average download rate of a request.
+     */
+    Q_INVOKABLE QVariantMap getHostStats() { return ResourceCache::getHostStats(); }
+
 signals:
 
     /*@jsdoc
@@ -403,6 +533,9 @@ private:
 
     size_t getNumGlobalQueriesPending() const { return ResourceCache::getPendingRequestCount(); }
     size_t getNumGlobalQueriesLoading() const { return ResourceCache::getLoadingRequestCount(); }
+
+    size_t getNumGlobalSpeculativeHits() const { return ResourceCache::getSpeculativeHitCount(); }
+    size_t getNumGlobalSpeculativeMisses() const { return ResourceCache::getSpeculativeMissCount(); }
 };
 
 /// Base class for resources.
@@ -435,6 +568,12 @@ public:
     /// Returns the highest load priority across all owners.
     float getLoadPriority();
 
+    /// Checks whether the resource is only loading ahead of being needed, see ResourceCache::getSpeculativeResource.
+    bool isSpeculative() const { return _speculative; }
+
+    /// Returns the class of requests of the resource at the given load priority, under which its downloads are scheduled.
+    virtual ResourceRequestClass getRequestClass(float priority) const;
+
     /// Checks whether the resource has loaded.
     virtual bool isLoaded() const { return _loaded; }
 
@@ -524,6 +663,9 @@ protected:
     /// Return true if the resource will be retried
     virtual bool handleFailedRequest(ResourceRequest::Result result);
 
+    /// Schedules a pending request again, after its priority or class changed.
+    void reprioritizeRequest();
+
     QUrl _url;
     QUrl _effectiveBaseURL { _url };
     QUrl _activeUrl;
@@ -538,6 +680,7 @@ protected:
     bool _loaded = false;
 
     QHash<QPointer<QObject>, float> _loadPriorities;
+    std::atomic<bool> _speculative { false };
     QWeakPointer<Resource> _self;
     QPointer<ResourceCache> _cache;
 
@@ -556,6 +699,7 @@ public slots:
 
 private:
     friend class ResourceCache;
+    friend class ResourceCacheSharedItems;
     friend class ScriptableResource;
 
     void setLRUKey(int lruKey) { _lruKey = lruKey; }
@@ -572,6 +716,11 @@ private:
     static const int MAX_ATTEMPTS = 8;
     unsigned int _attemptsRemaining { MAX_ATTEMPTS };
     bool _isInScript{ false };
+
+    // the scheduling state, guarded by the ResourceCacheSharedItems mutex
+    uint32_t _pendingGeneration { 0 };
+    quint64 _pendingTime { 0 };
+    ResourceRequestClass _requestClass { ResourceRequestClass::DISTANT };
 };
 
 uint qHash(const QPointer<QObject>& value, uint seed = 0);
@@ -18,6 +18,10 @@
 #include <QtCore/QTimer>
 
 #include <LogHandler.h>
+#include <MemoryAccounting.h>
+#include <PerformanceCounters.h>
+#include <ProcessPlacement.h>
+#include <UUID.h>
 #include <shared/QtHelpers.h>
 
 #include <platform/Platform.h>
@@ -32,6 +36,9 @@ ThreadedAssignment::ThreadedAssignment(ReceivedMessage& message) :
     // use <mixer-type> as a temporary targetName name until commonInit can be called later
     LogHandler::getInstance().setTargetName(QString("<%1>").arg(getTypeName()));
 
+    // don't publish what an earlier assignment of this process counted
+    PerformanceCounters::getInstance().reset();
+
     static const int STATS_TIMEOUT_MS = 1000;
     _statsTimer.setInterval(STATS_TIMEOUT_MS); // 1s, Qt::CoarseTimer acceptable
     connect(&_statsTimer, &QTimer::timeout, this, &ThreadedAssignment::sendStatsPacket);
@@ -94,6 +101,12 @@ void ThreadedAssignment::commonInit(const QString& targetName, NodeType_t nodeTy
     auto nodeList = DependencyManager::get<NodeList>();
     nodeList->setOwnerType(nodeType);
 
+    // assignments see the heaviest inbound traffic, drain the socket in batches
+    nodeList->setReceiveBatchSize(udt::UDP_RECEIVE_BATCH_SIZE);
+
+    // and send many small reliable packets, kills, trait and messages traffic, which share datagrams to the same node
+    nodeList->setPacketCoalescingEnabled(true);
+
     // send a domain-server check in immediately and start the timer to fire them every DOMAIN_SERVER_CHECK_IN_MSECS
     checkInWithDomainServerOrExit();
     _domainServerTimer.start();
@@ -119,13 +132,39 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["outbound_kbps"] = nodeList->getOutboundKbps();
     ioStats["outbound_pps"] = nodeList->getOutboundPPS();
 
+    auto receiveBatchStats = nodeList->sampleReceiveBatchStats();
+    ioStats["receive_batch_size"] = receiveBatchStats.capacity;
+    ioStats["receive_batch_avg_datagrams"] = receiveBatchStats.averageBatchSize;
+    ioStats["receive_batch_fill_ratio"] = receiveBatchStats.fillRatio;
+
     statsObject["io_stats"] = ioStats;
 
+    // the latency tails of the connection to each node, the samples behind them stay here to keep the packet small
+    QJsonObject connectionStats;
+    nodeList->eachNode([&](const SharedNodePointer& node) {
+        auto nodeStats = node->getConnectionStatsJSON(false);
+        nodeStats["node_type"] = NodeType::getNodeTypeName(node->getType()).toLower().replace(' ', '-');
+        connectionStats[uuidStringWithoutCurlyBraces(node->getUUID())] = nodeStats;
+    });
+    statsObject["connection_stats"] = connectionStats;
+
     QJsonObject assignmentStats;
     assignmentStats["numQueuedCheckIns"] = _numQueuedCheckIns;
 
     statsObject["assignmentStats"] = assignmentStats;
 
+    static auto& checkInQueueDepth = PerformanceCounters::getInstance().gauge("domain_check_in_queue_depth",
+        "Check-ins sent to the domain server without a reply");
+    checkInQueueDepth.set(_numQueuedCheckIns);
+    statsObject["performance"] = PerformanceCounters::getInstance().toJson();
+
+    auto memorySnapshot = MemoryAccounting::takeSnapshot();
+    statsObject["memory"] = MemoryAccounting::toJson(memorySnapshot,
+                                                     _lastMemorySnapshot.timestamp > 0 ? &_lastMemorySnapshot : nullptr);
+    _lastMemorySnapshot = memorySnapshot;
+
+    statsObject["placement"] = ProcessPlacement::getEffectivePlacement();
+
     nodeList->sendStatsToDomainServer(statsObject);
 }
 
@@ -14,6 +14,8 @@
 
 #include <QtCore/QSharedPointer>
 
+#include <MemoryAccounting.h>
+
 #include "ReceivedMessage.h"
 
 #include "Assignment.h"
@@ -48,6 +50,7 @@ protected:
     QTimer _domainServerTimer;
     QTimer _statsTimer;
     int _numQueuedCheckIns { 0 };
+    MemoryAccounting::Snapshot _lastMemorySnapshot; // the allocation rates are over the time since the last stats
 
 protected slots:
     void domainSettingsRequestFailed();
@@ -0,0 +1,334 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QtGlobal>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+// the lowest gain that still doubles the sending rate every round trip during startup (2 / ln(2))
+static const double HIGH_GAIN = 2.885;
+// the pacing gains of probe bandwidth, each used for one min RTT: probe for more, drain what that queued, then cruise
+static const double PACING_GAIN_CYCLE[] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+static const int PACING_GAIN_CYCLE_LENGTH = sizeof(PACING_GAIN_CYCLE) / sizeof(PACING_GAIN_CYCLE[0]);
+// a window of twice the bandwidth-delay product leaves room for delayed and aggregated ACKs
+static const double PROBE_BANDWIDTH_CONGESTION_WINDOW_GAIN = 2.0;
+
+static const int64_t BANDWIDTH_FILTER_ROUNDS = 10;
+static const auto MIN_RTT_FILTER_WINDOW = seconds(10);
+static const auto PROBE_RTT_DURATION = milliseconds(200);
+
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const int MIN_CONGESTION_WINDOW_PACKETS = 4;
+static const int INITIAL_CONGESTION_WINDOW_PACKETS = 16;
+
+BBRCC::BBRCC() {
+    _packetSendPeriod = 0.0;
+    _congestionWindowSize = INITIAL_CONGESTION_WINDOW_PACKETS;
+    _pacingGain = HIGH_GAIN;
+    _congestionWindowGain = HIGH_GAIN;
+
+    // we can't do this as a member initializer until our VS has support for constexpr
+    _minRTT = std::numeric_limits<int>::max();
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    auto previousAck = _lastACK;
+    _lastACK = ack;
+
+    bool wasDuplicateACK = (ack == previousAck);
+
+    if (!wasDuplicateACK) {
+        int numNewlyDelivered = seqoff(previousAck, ack);
+
+        _delivered += numNewlyDelivered;
+        _deliveredTime = receiveTime;
+        _isRoundStart = false;
+
+        bool isMinRTTExpired = _minRTT != std::numeric_limits<int>::max()
+            && receiveTime - _minRTTTime > MIN_RTT_FILTER_WINDOW;
+
+        // everything up to this ACK was received
+        auto end = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [ack](SentPacketData& sentPacketData) {
+            return sentPacketData.sequenceNumber > ack;
+        });
+
+        if (end != _sentPacketDatas.begin() && (end - 1)->sequenceNumber == ack) {
+            auto packetData = *(end - 1);
+
+            // as in TCPVegasCC, the RTT is only unambiguous if none of the packets this ACK covers was re-sent
+            bool canBeUsedForRTT = std::none_of(_sentPacketDatas.begin(), end, [](SentPacketData& sentPacketData) {
+                return sentPacketData.wasResent;
+            });
+
+            if (canBeUsedForRTT) {
+                updateRTT(duration_cast<microseconds>(receiveTime - packetData.sendTime).count(), receiveTime,
+                          isMinRTTExpired);
+            }
+
+            updateBandwidth(packetData, receiveTime);
+        }
+
+        _sentPacketDatas.erase(_sentPacketDatas.begin(), end);
+
+        updateMode(receiveTime, isMinRTTExpired);
+        updateControlParameters(numNewlyDelivered);
+    }
+
+    return needsFastRetransmit(ack, wasDuplicateACK);
+}
+
+void BBRCC::updateRTT(int rtt, p_high_resolution_clock::time_point now, bool isMinRTTExpired) {
+    const int MAX_RTT_SAMPLE_MICROSECONDS = 10000000;
+
+    if (rtt < 0) {
+        Q_ASSERT_X(false, __FUNCTION__, "calculated an RTT that is not > 0");
+        return;
+    }
+    rtt = std::max(1, std::min(rtt, MAX_RTT_SAMPLE_MICROSECONDS));
+    _lastRTT = rtt;
+
+    // the smoothed RTT is only used for the timeout, the model uses the minimum
+    if (_ewmaRTT == -1) {
+        _ewmaRTT = rtt;
+        _rttVariance = rtt / 2;
+    } else {
+        static const int RTT_ESTIMATION_ALPHA = 8;
+        static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + rtt) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1) + abs(rtt - _ewmaRTT))
+            / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+
+    if (rtt <= _minRTT || isMinRTTExpired) {
+        _minRTT = rtt;
+        _minRTTTime = now;
+    }
+}
+
+void BBRCC::updateBandwidth(const SentPacketData& packetData, p_high_resolution_clock::time_point now) {
+    if (packetData.delivered >= _nextRoundDelivered) {
+        _nextRoundDelivered = _delivered;
+        ++_round;
+        _isRoundStart = true;
+    }
+
+    // the rate is what was delivered while this packet was in flight, over the longer of the time it took to send
+    // and the time it took to ACK, so that neither a burst of sends nor a burst of ACKs overestimates it
+    auto sendElapsed = duration_cast<microseconds>(packetData.sendTime - packetData.firstSentTime).count();
+    auto ackElapsed = duration_cast<microseconds>(now - packetData.deliveredTime).count();
+    auto interval = std::max(sendElapsed, ackElapsed);
+
+    if (interval <= 0 || interval < _minRTT) {
+        // too short to be a sample of the bottleneck rather than of ACK compression
+        return;
+    }
+
+    double packetsPerSecond = (_delivered - packetData.delivered) * USECS_PER_SECOND / interval;
+
+    // keep the samples that could still be the max, so the front is the max of the window
+    while (!_bandwidthSamples.empty() && _bandwidthSamples.back().packetsPerSecond <= packetsPerSecond) {
+        _bandwidthSamples.pop_back();
+    }
+    _bandwidthSamples.push_back({ _round, packetsPerSecond });
+    while (_bandwidthSamples.front().round <= _round - BANDWIDTH_FILTER_ROUNDS) {
+        _bandwidthSamples.pop_front();
+    }
+
+    _bottleneckBandwidth = _bandwidthSamples.front().packetsPerSecond;
+}
+
+void BBRCC::updateMode(p_high_resolution_clock::time_point now, bool isMinRTTExpired) {
+    if (_isRoundStart && !_hasFilledPipe) {
+        if (_bottleneckBandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+            // still growing
+            _fullBandwidth = _bottleneckBandwidth;
+            _numRoundsWithoutGrowth = 0;
+        } else if (++_numRoundsWithoutGrowth >= FULL_BANDWIDTH_ROUNDS) {
+            _hasFilledPipe = true;
+        }
+    }
+
+    if (_mode == Mode::Startup && _hasFilledPipe) {
+        setMode(Mode::Drain, now);
+    }
+
+    if (_mode == Mode::Drain && getPacketsInFlight() <= getBandwidthDelayProduct(1.0)) {
+        setMode(Mode::ProbeBandwidth, now);
+    }
+
+    if (_mode == Mode::ProbeBandwidth) {
+        bool isFullLength = duration_cast<microseconds>(now - _cycleStartTime).count() > _minRTT;
+        bool shouldAdvance = isFullLength;
+        if (_pacingGain < 1.0) {
+            // done draining once the queue the probe built up is gone
+            shouldAdvance = isFullLength || getPacketsInFlight() <= getBandwidthDelayProduct(1.0);
+        }
+
+        if (shouldAdvance) {
+            _cycleIndex = (_cycleIndex + 1) % PACING_GAIN_CYCLE_LENGTH;
+            _cycleStartTime = now;
+            _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+        }
+    }
+
+    if (isMinRTTExpired && _mode != Mode::ProbeRTT) {
+        setMode(Mode::ProbeRTT, now);
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        if (_probeRTTDoneTime == p_high_resolution_clock::time_point()) {
+            // wait for the window to drain, then hold it there for a while and at least a round trip
+            if (getPacketsInFlight() <= MIN_CONGESTION_WINDOW_PACKETS) {
+                _probeRTTDoneTime = now + PROBE_RTT_DURATION;
+                _hasProbeRTTRoundDone = false;
+                _nextRoundDelivered = _delivered;
+            }
+        } else {
+            if (_isRoundStart) {
+                _hasProbeRTTRoundDone = true;
+            }
+
+            if (_hasProbeRTTRoundDone && now > _probeRTTDoneTime) {
+                _minRTTTime = now;
+                _congestionWindowSize = std::max(_congestionWindowSize, _priorCongestionWindowSize);
+                setMode(_hasFilledPipe ? Mode::ProbeBandwidth : Mode::Startup, now);
+            }
+        }
+    }
+}
+
+void BBRCC::setMode(Mode mode, p_high_resolution_clock::time_point now) {
+    _mode = mode;
+
+    switch (mode) {
+        case Mode::Startup:
+            _pacingGain = HIGH_GAIN;
+            _congestionWindowGain = HIGH_GAIN;
+            break;
+        case Mode::Drain:
+            _pacingGain = 1.0 / HIGH_GAIN;
+            _congestionWindowGain = HIGH_GAIN;
+            break;
+        case Mode::ProbeBandwidth:
+            // start the cycle anywhere but in its draining phase (the second one)
+            _cycleIndex = (PACING_GAIN_CYCLE_LENGTH - (int)(_round % (PACING_GAIN_CYCLE_LENGTH - 1))) % PACING_GAIN_CYCLE_LENGTH;
+            _cycleStartTime = now;
+            _pacingGain = PACING_GAIN_CYCLE[_cycleIndex];
+            _congestionWindowGain = PROBE_BANDWIDTH_CONGESTION_WINDOW_GAIN;
+            break;
+        case Mode::ProbeRTT:
+            _pacingGain = 1.0;
+            _congestionWindowGain = 1.0;
+            _priorCongestionWindowSize = _congestionWindowSize;
+            _probeRTTDoneTime = p_high_resolution_clock::time_point();
+            break;
+    }
+}
+
+void BBRCC::updateControlParameters(int numNewlyDelivered) {
+    if (_bottleneckBandwidth <= 0.0) {
+        // no model yet, keep sending the initial window unpaced
+        return;
+    }
+
+    setPacketSendPeriod(USECS_PER_SECOND / (_pacingGain * _bottleneckBandwidth));
+
+    if (_mode == Mode::ProbeRTT) {
+        _congestionWindowSize = MIN_CONGESTION_WINDOW_PACKETS;
+        return;
+    }
+
+    int targetWindowSize = getBandwidthDelayProduct(_congestionWindowGain);
+    if (_hasFilledPipe) {
+        // follow the model, growing back towards it one ACKed packet at a time
+        _congestionWindowSize = std::min(_congestionWindowSize + numNewlyDelivered, targetWindowSize);
+    } else if (_congestionWindowSize < targetWindowSize || _delivered < INITIAL_CONGESTION_WINDOW_PACKETS) {
+        _congestionWindowSize += numNewlyDelivered;
+    }
+
+    if (_congestionWindowSize < MIN_CONGESTION_WINDOW_PACKETS) {
+        _congestionWindowSize = MIN_CONGESTION_WINDOW_PACKETS;
+    } else if (_congestionWindowSize > udt::MAX_PACKETS_IN_FLIGHT) {
+        _congestionWindowSize = udt::MAX_PACKETS_IN_FLIGHT;
+    }
+}
+
+bool BBRCC::needsFastRetransmit(SequenceNumber ack, bool wasDuplicateACK) {
+    // the model does not react to loss, but the lost packet still has to be re-sent quickly
+
+    // everything up to the ACK was erased, so the next packet is the first one left
+    if (!_sentPacketDatas.empty() && _sentPacketDatas.front().sequenceNumber == ack + 1) {
+        auto sinceSend = duration_cast<microseconds>(p_high_resolution_clock::now() - _sentPacketDatas.front().sendTime);
+        if (!_sentPacketDatas.front().wasResent && sinceSend.count() >= estimatedTimeout()) {
+            _duplicateACKCount = 0;
+            return true;
+        }
+    }
+
+    static const int RENO_FAST_RETRANSMIT_DUPLICATE_COUNT = 3;
+
+    if (!wasDuplicateACK) {
+        _duplicateACKCount = 0;
+    } else if (++_duplicateACKCount == RENO_FAST_RETRANSMIT_DUPLICATE_COUNT) {
+        _duplicateACKCount = 0;
+        return true;
+    }
+
+    return false;
+}
+
+int BBRCC::getPacketsInFlight() const {
+    return std::max(0, seqoff(_lastACK, _sendCurrSeqNum));
+}
+
+int BBRCC::getBandwidthDelayProduct(double gain) const {
+    if (_minRTT == std::numeric_limits<int>::max()) {
+        return INITIAL_CONGESTION_WINDOW_PACKETS;
+    }
+
+    return (int)std::ceil(gain * _bottleneckBandwidth * _minRTT / USECS_PER_SECOND);
+}
+
+int BBRCC::estimatedTimeout() const {
+    return _ewmaRTT == -1 ? DEFAULT_SYN_INTERVAL : _ewmaRTT + _rttVariance * 4;
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    if (_sentPacketDatas.empty()) {
+        // nothing in flight, so the delivery rate samples restart from this send
+        _firstSentTime = timePoint;
+        _deliveredTime = timePoint;
+    }
+
+    _sentPacketDatas.push_back({ seqNum, timePoint, _delivered, _deliveredTime, _firstSentTime });
+}
+
+void BBRCC::onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    auto it = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [seqNum](SentPacketData& sentPacketData){
+        return sentPacketData.sequenceNumber == seqNum;
+    });
+
+    // a re-sent packet cannot be used for RTT calculations
+    if (it != _sentPacketDatas.end()) {
+        it->wasResent = true;
+    }
+}
@@ -0,0 +1,122 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_BBRCC_h
+#define hifi_BBRCC_h
+
+#include <deque>
+#include <vector>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+namespace udt {
+
+/// Model based congestion control after BBR (https://queue.acm.org/detail.cfm?id=3022184)
+///
+/// Instead of reacting to loss or to growing delay, this estimates the bottleneck bandwidth (the highest delivery
+/// rate of the last few round trips) and the propagation delay (the lowest RTT of the last few seconds), paces
+/// packets out at about that bandwidth and keeps about one bandwidth-delay product of them in flight.
+class BBRCC : public CongestionControl {
+public:
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+    virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+    virtual int estimatedTimeout() const override;
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    enum class Mode {
+        Startup, // grow the sending rate exponentially until the bandwidth estimate stops growing
+        Drain, // drain the queue startup built up at the bottleneck
+        ProbeBandwidth, // cycle the pacing rate around the estimate to find out if more bandwidth became available
+        ProbeRTT // fall back to a few packets in flight, so the propagation delay can be measured again
+    };
+
+    struct SentPacketData {
+        SequenceNumber sequenceNumber;
+        p_high_resolution_clock::time_point sendTime;
+
+        // the state of delivery when the packet was sent, to sample the delivery rate when it is ACKed
+        int64_t delivered;
+        p_high_resolution_clock::time_point deliveredTime;
+        p_high_resolution_clock::time_point firstSentTime;
+
+        bool wasResent { false };
+    };
+
+    struct BandwidthSample {
+        int64_t round;
+        double packetsPerSecond;
+    };
+
+    void updateRTT(int rtt, p_high_resolution_clock::time_point now, bool isMinRTTExpired);
+    void updateBandwidth(const SentPacketData& packetData, p_high_resolution_clock::time_point now);
+    void updateMode(p_high_resolution_clock::time_point now, bool isMinRTTExpired);
+    void updateControlParameters(int numNewlyDelivered);
+    void setMode(Mode mode, p_high_resolution_clock::time_point now);
+
+    bool needsFastRetransmit(SequenceNumber ack, bool wasDuplicateACK);
+
+    int getPacketsInFlight() const;
+    int getBandwidthDelayProduct(double gain) const;
+
+    std::vector<SentPacketData> _sentPacketDatas; // packets sent and not yet ACKed, in send order
+
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+    int _duplicateACKCount { 0 };
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _congestionWindowGain;
+
+    // delivery rate estimation
+    int64_t _delivered { 0 }; // number of packets ACKed so far
+    p_high_resolution_clock::time_point _deliveredTime;
+    p_high_resolution_clock::time_point _firstSentTime;
+
+    // round trip counting - a round ends when a packet sent after the previous one ended is ACKed
+    int64_t _round { 0 };
+    int64_t _nextRoundDelivered { 0 };
+    bool _isRoundStart { false };
+
+    std::deque<BandwidthSample> _bandwidthSamples; // a windowed max filter, highest rate first
+    double _bottleneckBandwidth { 0.0 }; // in packets per second
+
+    int _minRTT; // in microseconds
+    p_high_resolution_clock::time_point _minRTTTime;
+    int _ewmaRTT { -1 }; // Exponential weighted moving average RTT, for the timeout
+    int _rttVariance { 0 };
+
+    // startup ends when the bandwidth estimate has not grown by a quarter for a few rounds
+    double _fullBandwidth { 0.0 };
+    int _numRoundsWithoutGrowth { 0 };
+    bool _hasFilledPipe { false };
+
+    int _cycleIndex { 0 };
+    p_high_resolution_clock::time_point _cycleStartTime;
+
+    p_high_resolution_clock::time_point _probeRTTDoneTime;
+    bool _hasProbeRTTRoundDone { false };
+    int _priorCongestionWindowSize { 0 }; // the window before the probe of the RTT, restored after it
+};
+
+}
+
+#endif // hifi_BBRCC_h
@@ -13,7 +13,9 @@
 
 #include <random>
 
+#include "BBRCC.h"
 #include "Packet.h"
+#include "TCPVegasCC.h"
 
 using namespace udt;
 using namespace std::chrono;
@@ -21,6 +23,15 @@ using namespace std::chrono;
 static const double USECS_PER_SECOND = 1000000.0;
 static const int BITS_PER_BYTE = 8;
 
+std::unique_ptr<CongestionControlVirtualFactory> udt::createCongestionControlFactory(const QString& name) {
+    if (name.compare("vegas", Qt::CaseInsensitive) == 0) {
+        return std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<TCPVegasCC>());
+    } else if (name.compare("bbr", Qt::CaseInsensitive) == 0) {
+        return std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<BBRCC>());
+    }
+    return nullptr;
+}
+
 void CongestionControl::setMaxBandwidth(int maxBandwidth) {
     _maxBandwidth = maxBandwidth;
     setPacketSendPeriod(_packetSendPeriod);
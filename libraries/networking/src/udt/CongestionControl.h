@@ -16,6 +16,8 @@
 #include <memory>
 #include <vector>
 
+#include <QtCore/QString>
+
 #include <PortableHighResolutionClock.h>
 
 #include "LossList.h"
@@ -57,6 +59,7 @@ protected:
     
     double _packetSendPeriod { 1.0 }; // Packet sending period, in microseconds
     int _congestionWindowSize { 16 }; // Congestion window size, in packets
+    int _lastRTT { 0 }; // RTT measured from the last ACK, in microseconds, 0 if it couldn't measure one
 
     std::atomic<int> _maxBandwidth { -1 }; // Maximum desired bandwidth, bits per second
     
@@ -80,6 +83,9 @@ public:
     virtual ~CongestionControlFactory() {}
     virtual std::unique_ptr<CongestionControl> create() override { return std::unique_ptr<T>(new T()); }
 };
+
+// returns a factory for the congestion control called name ("vegas" or "bbr"), or nullptr if there is none by that name
+std::unique_ptr<CongestionControlVirtualFactory> createCongestionControlFactory(const QString& name);
     
 }
 
@@ -15,8 +15,6 @@
 
 #include <random>
 
-#include <QtCore/QThread>
-
 #include <NumericalConstants.h>
 
 #include "../SockAddr.h"
@@ -69,21 +67,13 @@ Connection::~Connection() {
 }
 
 void Connection::stopSendQueue() {
-    if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
-        // tell the send queue to stop and be deleted
-        
-        sendQueue->stop();
+    if (_sendQueue) {
+        // tell the send queue to stop and delete it, which waits for the scheduler to be done servicing it
+        _sendQueue->stop();
 
-        _lastMessageNumber = sendQueue->getCurrentMessageNumber();
+        _lastMessageNumber = _sendQueue->getCurrentMessageNumber();
 
-        sendQueue->deleteLater();
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
+        _sendQueue.reset();
     }
 }
 
@@ -148,14 +138,57 @@ void Connection::queueTimeout() {
 
 void Connection::sendReliablePacket(std::unique_ptr<Packet> packet) {
     Q_ASSERT_X(packet->isReliable(), "Connection::send", "Trying to send an unreliable packet reliably.");
+
+    if (_parentSocket->isCoalescingPackets() && PacketCoalescer::isCoalescable(*packet)) {
+        coalescePacket(std::move(packet));
+        return;
+    }
+
+    // what was held back goes first, so that packets still leave in the order they were sent
+    flushCoalescedPackets();
     getSendQueue().queuePacket(std::move(packet));
 }
 
 void Connection::sendReliablePacketList(std::unique_ptr<PacketList> packetList) {
     Q_ASSERT_X(packetList->isReliable(), "Connection::send", "Trying to send an unreliable packet reliably.");
+
+    // a message that fits in one small packet can share a datagram too, as long as it isn't bulk
+    if (_parentSocket->isCoalescingPackets() && packetList->_packets.size() == 1 &&
+        packetList->getPriority() != Packet::Priority::Bulk && PacketCoalescer::isCoalescable(*packetList->_packets.front())) {
+        if (packetList->isOrdered()) {
+            packetList->preparePackets(getSendQueue().getNextMessageNumber());
+        }
+        coalescePacket(packetList->takeFront<Packet>());
+        return;
+    }
+
+    flushCoalescedPackets();
     getSendQueue().queuePacketList(std::move(packetList));
 }
 
+void Connection::coalescePacket(std::unique_ptr<Packet> packet) {
+    if (!_packetCoalescer.fits(*packet, _parentSocket->getPacketCoalescingHeader().size())) {
+        flushCoalescedPackets();
+    }
+
+    if (_packetCoalescer.isEmpty()) {
+        _parentSocket->scheduleCoalescedPacketsFlush();
+    }
+    _packetCoalescer.append(std::move(packet));
+}
+
+void Connection::flushCoalescedPackets() {
+    if (_packetCoalescer.isEmpty()) {
+        return;
+    }
+
+    auto numPackets = _packetCoalescer.getNumPackets();
+    if (numPackets > 1) {
+        _stats.recordCoalescedPackets((int)numPackets);
+    }
+    getSendQueue().queuePacket(_packetCoalescer.takeCoalescedPacket(_parentSocket->getPacketCoalescingHeader()));
+}
+
 void Connection::queueReceivedMessagePacket(std::unique_ptr<Packet> packet) {
     Q_ASSERT(packet->isPartOfMessage());
 
@@ -189,15 +222,18 @@ void Connection::sync() {
 }
 
 void Connection::recordSentPackets(int wireSize, int payloadSize,
-                                   SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+                                   SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint,
+                                   int sendLatency) {
     _stats.recordSentPackets(payloadSize, wireSize);
+    _stats.recordSendLatency(sendLatency);
 
     _congestionControl->onPacketSent(wireSize, seqNum, timePoint);
 }
 
 void Connection::recordRetransmission(int wireSize, int payloadSize,
-                                      SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
-    _stats.recordRetransmittedPackets(payloadSize, wireSize);
+                                      SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint,
+                                      Packet::Priority priority) {
+    _stats.recordRetransmittedPackets(payloadSize, wireSize, priority);
 
     _congestionControl->onPacketReSent(wireSize, seqNum, timePoint);
 }
@@ -353,6 +389,11 @@ void Connection::processACK(ControlPacketPointer controlPacket) {
             // the congestion control has told us it needs a fast re-transmit of ack + 1, add that now
             _sendQueue->fastRetransmit(ack + 1);
         }
+
+        if (_congestionControl->_lastRTT > 0) {
+            _stats.recordRTT(_congestionControl->_lastRTT);
+            _congestionControl->_lastRTT = 0;
+        }
     });
     
     _stats.record(ConnectionStats::Stats::ProcessedACK);
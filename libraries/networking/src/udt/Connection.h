@@ -24,6 +24,7 @@
 #include "ConnectionStats.h"
 #include "Constants.h"
 #include "LossList.h"
+#include "PacketCoalescer.h"
 #include "SendQueue.h"
 #include "../SockAddr.h"
 
@@ -57,6 +58,8 @@ public:
 
     void sendReliablePacket(std::unique_ptr<Packet> packet);
     void sendReliablePacketList(std::unique_ptr<PacketList> packet);
+    // sends the small reliable packets held back to share a datagram, see Socket::setPacketCoalescingHeader
+    void flushCoalescedPackets();
 
     void sync(); // rate control method, fired by Socket for all connections on SYN interval
 
@@ -85,8 +88,10 @@ signals:
     void destinationAddressChange(SockAddr currentAddress);
 
 private slots:
-    void recordSentPackets(int wireSize, int payloadSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint);
-    void recordRetransmission(int wireSize, int payloadSize, SequenceNumber sequenceNumber, p_high_resolution_clock::time_point timePoint);
+    void recordSentPackets(int wireSize, int payloadSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint,
+                           int sendLatency);
+    void recordRetransmission(int wireSize, int payloadSize, SequenceNumber sequenceNumber, p_high_resolution_clock::time_point timePoint,
+                              Packet::Priority priority);
 
     void queueInactive();
     void queueTimeout();
@@ -106,6 +111,8 @@ private:
     void updateCongestionControlAndSendQueue(std::function<void()> congestionCallback);
     
     void stopSendQueue();
+
+    void coalescePacket(std::unique_ptr<Packet> packet);
     
     bool _hasReceivedHandshake { false }; // flag for receipt of handshake from server
     bool _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
@@ -129,6 +136,8 @@ private:
     
     std::map<MessageNumber, PendingReceivedMessage> _pendingReceivedMessages;
 
+    PacketCoalescer _packetCoalescer;
+
     // Re-used control packets
     ControlPacketPointer _ackPacket;
     ControlPacketPointer _handshakeACK;
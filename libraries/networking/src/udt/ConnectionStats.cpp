@@ -24,6 +24,12 @@ ConnectionStats::ConnectionStats() {
 ConnectionStats::Stats ConnectionStats::sample() {
     Stats sample = _currentSample;
     _currentSample = Stats();
+
+    sample.rtt = _rttHistogram.getMean();
+    sample.rttPercentiles = _rttHistogram.getPercentiles();
+    sample.sendLatencyPercentiles = _sendLatencyHistogram.getPercentiles();
+    _rttHistogram.reset();
+    _sendLatencyHistogram.reset();
     
     auto now = duration_cast<microseconds>(system_clock::now().time_since_epoch());
     sample.endTime = now;
@@ -58,12 +64,18 @@ void ConnectionStats::recordReceivedPackets(int payload, int total) {
     _currentSample.receivedBytes += total;
 }
 
-void ConnectionStats::recordRetransmittedPackets(int payload, int total) {
+void ConnectionStats::recordRetransmittedPackets(int payload, int total, Packet::Priority priority) {
     ++_currentSample.retransmittedPackets;
+    ++_currentSample.retransmittedPacketsByPriority[(int)priority];
     _currentSample.retransmittedUtilBytes += payload;
     _currentSample.retransmittedBytes += total;
 }
 
+void ConnectionStats::recordCoalescedPackets(int numPackets) {
+    _currentSample.coalescedPackets += numPackets;
+    ++_currentSample.coalescedDatagrams;
+}
+
 void ConnectionStats::recordDuplicatePackets(int payload, int total) {
     ++_currentSample.duplicatePackets;
     _currentSample.duplicateUtilBytes += payload;
@@ -90,6 +102,14 @@ void ConnectionStats::recordPacketSendPeriod(int sample) {
     _currentSample.packetSendPeriod = sample;
 }
 
+void ConnectionStats::recordRTT(int rtt) {
+    _rttHistogram.record(rtt);
+}
+
+void ConnectionStats::recordSendLatency(int sendLatency) {
+    _sendLatencyHistogram.record(sendLatency);
+}
+
 QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
     debug << "Connection stats:\n";
 #define HIFI_LOG_EVENT(x) << "    " #x " events: " << stats.events[ConnectionStats::Stats::Event::x] << "\n"
@@ -102,10 +122,19 @@ QDebug& operator<<(QDebug&& debug, const udt::ConnectionStats::Stats& stats) {
 
     debug << "    Sent packets: " << stats.sentPackets;
     debug << "\n    Retransmitted packets: " << stats.retransmittedPackets;
+    debug << "\n    Retransmitted packets (urgent / normal / bulk): "
+        << stats.retransmittedPacketsByPriority[(int)Packet::Priority::Urgent] << "/"
+        << stats.retransmittedPacketsByPriority[(int)Packet::Priority::Normal] << "/"
+        << stats.retransmittedPacketsByPriority[(int)Packet::Priority::Bulk];
+    debug << "\n     Coalesced packets / datagrams: " << stats.coalescedPackets << "/" << stats.coalescedDatagrams;
     debug << "\n     Received packets: " << stats.receivedPackets;
     debug << "\n     Duplicate packets: " << stats.duplicatePackets;
     debug << "\n     Sent util bytes: " << stats.sentUtilBytes;
     debug << "\n     Sent bytes: " << stats.sentBytes;
-    debug << "\n     Received bytes: " << stats.receivedBytes << "\n";
+    debug << "\n     Received bytes: " << stats.receivedBytes;
+    debug << "\n     RTT p50 / p99 / max (us): " << stats.rttPercentiles.p50 << "/" << stats.rttPercentiles.p99 << "/"
+        << stats.rttPercentiles.max;
+    debug << "\n     Send latency p50 / p99 / max (us): " << stats.sendLatencyPercentiles.p50 << "/"
+        << stats.sendLatencyPercentiles.p99 << "/" << stats.sendLatencyPercentiles.max << "\n";
     return debug;
 }
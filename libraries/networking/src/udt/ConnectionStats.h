@@ -16,6 +16,9 @@
 #include <array>
 #include <stdint.h>
 
+#include "LatencyHistogram.h"
+#include "Packet.h"
+
 namespace udt {
 
 class ConnectionStats {
@@ -31,6 +34,7 @@ public:
         
         using microseconds = std::chrono::microseconds;
         using Events = std::array<int, NumEvents>;
+        using PriorityCounts = std::array<uint32_t, Packet::NUM_PRIORITIES>;
         
         microseconds startTime;
         microseconds endTime;
@@ -44,6 +48,13 @@ public:
         uint32_t retransmittedPackets { 0 };
         uint32_t duplicatePackets { 0 };
 
+        // the small reliable packets sent in a datagram shared with others, and the datagrams they needed
+        uint32_t coalescedPackets { 0 };
+        uint32_t coalescedDatagrams { 0 };
+
+        // the retransmitted packets, by the priority of the stream they were sent in
+        PriorityCounts retransmittedPacketsByPriority;
+
         uint64_t sentUtilBytes { 0 };
         uint64_t receivedUtilBytes { 0 };
         uint64_t retransmittedUtilBytes { 0 };
@@ -65,12 +76,16 @@ public:
         int sendRate { 0 };
         int receiveRate { 0 };
         int estimatedBandwith { 0 };
-        int rtt { 0 };
+        int rtt { 0 }; // microseconds
         int congestionWindowSize { 0 };
         int packetSendPeriod { 0 };
+
+        // the spread of the RTT, and of the time packets waited in the send queue, over the sample, in microseconds
+        LatencyPercentiles rttPercentiles;
+        LatencyPercentiles sendLatencyPercentiles;
         
         // TODO: Remove once Win build supports brace initialization: `Events events {{ 0 }};`
-        Stats() { events.fill(0); }
+        Stats() { events.fill(0); retransmittedPacketsByPriority.fill(0); }
     };
     
     ConnectionStats();
@@ -85,17 +100,23 @@ public:
     void recordSentPackets(int payload, int total);
     void recordReceivedPackets(int payload, int total);
 
-    void recordRetransmittedPackets(int payload, int total);
+    void recordRetransmittedPackets(int payload, int total, Packet::Priority priority);
     void recordDuplicatePackets(int payload, int total);
+    void recordCoalescedPackets(int numPackets);
     
     void recordUnreliableSentPackets(int payload, int total);
     void recordUnreliableReceivedPackets(int payload, int total);
 
     void recordCongestionWindowSize(int sample);
     void recordPacketSendPeriod(int sample);
+
+    void recordRTT(int rtt);
+    void recordSendLatency(int sendLatency);
     
 private:
     Stats _currentSample;
+    LatencyHistogram _rttHistogram;
+    LatencyHistogram _sendLatencyHistogram;
 };
     
 }
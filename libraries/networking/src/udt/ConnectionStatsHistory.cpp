@@ -0,0 +1,63 @@
+//
+//  ConnectionStatsHistory.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ConnectionStatsHistory.h"
+
+using namespace udt;
+
+void ConnectionStatsHistory::push(const ConnectionStats::Stats& stats) {
+    auto index = _numPushed.load(std::memory_order_relaxed);
+    auto& slot = _slots[index % CAPACITY];
+
+    auto sequence = slot.sequence.load(std::memory_order_relaxed);
+    slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    auto& sample = slot.sample;
+    sample.endTime = (uint64_t)stats.endTime.count();
+    sample.duration = (uint32_t)(stats.endTime - stats.startTime).count();
+    sample.sentPackets = stats.sentPackets + stats.sentUnreliablePackets;
+    sample.receivedPackets = stats.receivedPackets + stats.receivedUnreliablePackets;
+    sample.retransmittedPackets = stats.retransmittedPackets;
+    sample.duplicatePackets = stats.duplicatePackets;
+    sample.rtt = stats.rttPercentiles;
+    sample.sendLatency = stats.sendLatencyPercentiles;
+
+    slot.sequence.store(sequence + 2, std::memory_order_release);
+    _numPushed.store(index + 1, std::memory_order_release);
+}
+
+std::vector<ConnectionStatsHistory::Sample> ConnectionStatsHistory::getSamples() const {
+    std::vector<Sample> samples;
+
+    auto numPushed = _numPushed.load(std::memory_order_acquire);
+    auto first = numPushed > (uint32_t)CAPACITY ? numPushed - CAPACITY : 0;
+    samples.reserve(numPushed - first);
+
+    for (auto index = first; index < numPushed; ++index) {
+        auto& slot = _slots[index % CAPACITY];
+
+        // the slot has been written once for every lap of the ring up to this sample's
+        auto expectedSequence = (index / CAPACITY + 1) * 2;
+        if (slot.sequence.load(std::memory_order_acquire) != expectedSequence) {
+            // overwritten since we read the count, the samples after it will be too
+            continue;
+        }
+
+        Sample sample = slot.sample;
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == expectedSequence) {
+            samples.push_back(sample);
+        }
+    }
+
+    return samples;
+}
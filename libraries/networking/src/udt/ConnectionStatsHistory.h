@@ -0,0 +1,63 @@
+//
+//  ConnectionStatsHistory.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ConnectionStatsHistory_h
+#define hifi_ConnectionStatsHistory_h
+
+#include <array>
+#include <atomic>
+#include <vector>
+
+#include "ConnectionStats.h"
+
+namespace udt {
+
+// The last samples of a connection's stats, kept in a fixed ring that one thread pushes to and any thread reads without
+// locking: every slot has a sequence number that is odd while it is being written, so a reader can tell a sample it copied
+// was complete and that it wasn't overwritten with a newer one halfway through.
+class ConnectionStatsHistory {
+public:
+    static const int CAPACITY = 60; // a minute of the node list's samples
+
+    struct Sample {
+        uint64_t endTime { 0 }; // microseconds since the epoch
+        uint32_t duration { 0 }; // microseconds
+        uint32_t sentPackets { 0 };
+        uint32_t receivedPackets { 0 };
+        uint32_t retransmittedPackets { 0 };
+        uint32_t duplicatePackets { 0 };
+        LatencyPercentiles rtt;
+        LatencyPercentiles sendLatency;
+    };
+
+    // only ever called from one thread
+    void push(const ConnectionStats::Stats& stats);
+
+    // the samples still in the ring, oldest first; can be called from any thread
+    std::vector<Sample> getSamples() const;
+
+    uint32_t getNumPushed() const { return _numPushed.load(std::memory_order_acquire); }
+
+private:
+    struct Slot {
+        std::atomic<uint32_t> sequence { 0 };
+        Sample sample;
+    };
+
+    std::array<Slot, CAPACITY> _slots;
+    std::atomic<uint32_t> _numPushed { 0 };
+};
+
+}
+
+#endif // hifi_ConnectionStatsHistory_h
@@ -20,7 +20,10 @@ namespace udt {
 
     static const int UDP_IPV4_HEADER_SIZE = 28;
     static const int MAX_PACKET_SIZE_WITH_UDP_HEADER = 1492;
-    static const int MAX_PACKET_SIZE = MAX_PACKET_SIZE_WITH_UDP_HEADER - UDP_IPV4_HEADER_SIZE;
+    static const int MAX_DATAGRAM_SIZE = MAX_PACKET_SIZE_WITH_UDP_HEADER - UDP_IPV4_HEADER_SIZE;
+    // packets leave room for the header and tag a secure session wraps them in, see SecureSession
+    static const int SECURE_DATAGRAM_OVERHEAD = 28;
+    static const int MAX_PACKET_SIZE = MAX_DATAGRAM_SIZE - SECURE_DATAGRAM_OVERHEAD;
     static const int MAX_PACKETS_IN_FLIGHT = 25600;
     static const int CONNECTION_RECEIVE_BUFFER_SIZE_PACKETS = 8192;
     static const int CONNECTION_SEND_BUFFER_SIZE_PACKETS = 8192;
@@ -29,6 +32,7 @@ namespace udt {
     static const int WEBRTC_SEND_BUFFER_SIZE_BYTES = 1048576;
     static const int WEBRTC_RECEIVE_BUFFER_SIZE_BYTES = 1048576;
     static const int DEFAULT_SYN_INTERVAL_USECS = 10 * 1000;
+    static const int UDP_RECEIVE_BATCH_SIZE = 32;
 
     
     // Header constants
@@ -53,11 +53,14 @@ public:
         ACK,                ///< `0` - ACK
         Handshake,          ///< `1` - Handshake
         HandshakeACK,       ///< `2` - HandskakeACK
-        HandshakeRequest    ///< `3` - HandshakeRequest
+        HandshakeRequest,   ///< `3` - HandshakeRequest
+        SecureHandshakeInit,     ///< `4` - SecureHandshakeInit
+        SecureHandshakeResponse, ///< `5` - SecureHandshakeResponse
+        SecureData               ///< `6` - SecureData, see SecureSession
     };
     
     static std::unique_ptr<ControlPacket> create(Type type, qint64 size = -1);
-    static std::unique_ptr<ControlPacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<ControlPacket> fromReceivedPacket(PacketBuffer data, qint64 size,
                                                              const SockAddr& senderSockAddr);
     // Current level's header size
     static int localHeaderSize();
@@ -72,7 +75,7 @@ public:
 private:
     Q_DISABLE_COPY(ControlPacket)
     ControlPacket(Type type, qint64 size = -1);
-    ControlPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    ControlPacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     ControlPacket(ControlPacket&& other);
     
     ControlPacket& operator=(ControlPacket&& other);
@@ -0,0 +1,101 @@
+//
+//  LatencyHistogram.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace udt;
+
+int LatencyHistogram::indexForValue(int value) {
+    if (value < SUB_BUCKET_COUNT) {
+        return value;
+    }
+
+    // the position of the highest bit set
+    uint32_t remaining = (uint32_t)value;
+    int magnitude = 0;
+    for (int bits = 16; bits > 0; bits /= 2) {
+        if (remaining >= (1u << bits)) {
+            remaining >>= bits;
+            magnitude += bits;
+        }
+    }
+
+    // keep the highest SUB_BUCKET_BITS bits, the top one is always set
+    int shift = magnitude - (SUB_BUCKET_BITS - 1);
+    int subBucket = value >> shift;
+    return SUB_BUCKET_COUNT + (shift - 1) * HALF_SUB_BUCKET_COUNT + (subBucket - HALF_SUB_BUCKET_COUNT);
+}
+
+int LatencyHistogram::highestValueForIndex(int index) {
+    if (index < SUB_BUCKET_COUNT) {
+        return index;
+    }
+
+    int offset = index - SUB_BUCKET_COUNT;
+    int shift = offset / HALF_SUB_BUCKET_COUNT + 1;
+    int subBucket = offset % HALF_SUB_BUCKET_COUNT + HALF_SUB_BUCKET_COUNT;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::record(int value) {
+    value = std::max(0, std::min(value, MAX_VALUE));
+
+    ++_counts[indexForValue(value)];
+    ++_count;
+    _sum += value;
+    _max = std::max(_max, value);
+}
+
+void LatencyHistogram::reset() {
+    _counts.fill(0);
+    _count = 0;
+    _sum = 0;
+    _max = 0;
+}
+
+void LatencyHistogram::add(const LatencyHistogram& other) {
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        _counts[i] += other._counts[i];
+    }
+    _count += other._count;
+    _sum += other._sum;
+    _max = std::max(_max, other._max);
+}
+
+int LatencyHistogram::getValueAtPercentile(float percentile) const {
+    if (_count == 0) {
+        return 0;
+    }
+
+    // the count of values at or below the percentile, worked out so that whole percentiles of round counts are exact
+    auto target = std::max((uint32_t)1, (uint32_t)std::ceil((double)std::min(percentile, 100.0f) * _count / 100.0));
+    uint32_t cumulativeCount = 0;
+    for (int i = 0; i < NUM_BUCKETS; ++i) {
+        cumulativeCount += _counts[i];
+        if (cumulativeCount >= target) {
+            // the bucket's values are all reported as its highest, which can't be more than what was recorded
+            return std::min(highestValueForIndex(i), _max);
+        }
+    }
+    return _max;
+}
+
+LatencyPercentiles LatencyHistogram::getPercentiles() const {
+    LatencyPercentiles percentiles;
+    percentiles.p50 = getValueAtPercentile(50.0f);
+    percentiles.p90 = getValueAtPercentile(90.0f);
+    percentiles.p99 = getValueAtPercentile(99.0f);
+    percentiles.max = _max;
+    return percentiles;
+}
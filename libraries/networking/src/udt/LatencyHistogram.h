@@ -0,0 +1,70 @@
+//
+//  LatencyHistogram.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_LatencyHistogram_h
+#define hifi_LatencyHistogram_h
+
+#include <array>
+#include <stdint.h>
+
+namespace udt {
+
+struct LatencyPercentiles {
+    int p50 { 0 };
+    int p90 { 0 };
+    int p99 { 0 };
+    int max { 0 };
+};
+
+// Counts latencies in microseconds with a fixed relative precision, in the manner of an HDR histogram: values below 64
+// are counted exactly, larger ones in 32 buckets per power of two, so any percentile read back is within about 3% of the
+// true value, over the whole range, in a fixed few kilobytes.
+class LatencyHistogram {
+public:
+    static const int MAX_VALUE = (1 << 24) - 1; // about 16.8 seconds, larger values are counted as this
+
+    LatencyHistogram() { reset(); }
+
+    void record(int value);
+    void reset();
+
+    // adds the values counted by another histogram to this one
+    void add(const LatencyHistogram& other);
+
+    uint32_t getCount() const { return _count; }
+    int getMax() const { return _max; }
+    int getMean() const { return _count > 0 ? (int)(_sum / _count) : 0; }
+
+    // the value that percentile (0 to 100) of the values are at or below, 0 if nothing was recorded
+    int getValueAtPercentile(float percentile) const;
+
+    LatencyPercentiles getPercentiles() const;
+
+private:
+    static const int SUB_BUCKET_BITS = 6;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static const int HALF_SUB_BUCKET_COUNT = SUB_BUCKET_COUNT / 2;
+    static const int NUM_BUCKETS = SUB_BUCKET_COUNT + (24 - SUB_BUCKET_BITS) * HALF_SUB_BUCKET_COUNT;
+
+    static int indexForValue(int value);
+    static int highestValueForIndex(int index);
+
+    std::array<uint32_t, NUM_BUCKETS> _counts;
+    uint32_t _count { 0 };
+    uint64_t _sum { 0 };
+    int _max { 0 };
+};
+
+}
+
+#endif // hifi_LatencyHistogram_h
@@ -9,7 +9,103 @@
 
 #include "NetworkSocket.h"
 
+#include <algorithm>
+#include <cstring>
+
+#if defined(Q_OS_LINUX)
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+
+#ifndef SOL_UDP
+#define SOL_UDP 17
+#endif
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103
+#endif
+#endif
+
 #include "../NetworkLogging.h"
+#include "Constants.h"
+
+#if defined(Q_OS_LINUX)
+namespace {
+    // a UDP socket that shares its port with the others of its group, returns -1 if it can't be bound
+    int createReusePortSocket(const QHostAddress& address, quint16 port) {
+        bool isIPv6 = address.protocol() == QAbstractSocket::IPv6Protocol;
+        int descriptor = ::socket(isIPv6 ? AF_INET6 : AF_INET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (descriptor < 0) {
+            return -1;
+        }
+
+        int enable = 1;
+        sockaddr_storage storage;
+        memset(&storage, 0, sizeof(storage));
+        socklen_t length;
+        if (isIPv6) {
+            auto address6 = reinterpret_cast<sockaddr_in6*>(&storage);
+            address6->sin6_family = AF_INET6;
+            address6->sin6_port = htons(port);
+            Q_IPV6ADDR ipv6Address = address.toIPv6Address();
+            memcpy(&address6->sin6_addr, &ipv6Address, sizeof(ipv6Address));
+            length = sizeof(sockaddr_in6);
+        } else {
+            auto address4 = reinterpret_cast<sockaddr_in*>(&storage);
+            address4->sin_family = AF_INET;
+            address4->sin_port = htons(port);
+            address4->sin_addr.s_addr = htonl(address.toIPv4Address());
+            length = sizeof(sockaddr_in);
+        }
+
+        if (::setsockopt(descriptor, SOL_SOCKET, SO_REUSEPORT, &enable, sizeof(enable)) < 0
+            || ::bind(descriptor, reinterpret_cast<sockaddr*>(&storage), length) < 0) {
+            int bindError = errno;
+            ::close(descriptor);
+            errno = bindError;
+            return -1;
+        }
+        return descriptor;
+    }
+
+    // pulls up to count datagrams off the socket with one recvmmsg, returns how many
+    int receiveDatagrams(int descriptor, NetworkSocket::Datagram* datagrams, int count) {
+        mmsghdr headers[NetworkSocket::MAX_DATAGRAM_BATCH_SIZE];
+        iovec vectors[NetworkSocket::MAX_DATAGRAM_BATCH_SIZE];
+        sockaddr_storage addresses[NetworkSocket::MAX_DATAGRAM_BATCH_SIZE];
+        memset(headers, 0, sizeof(mmsghdr) * count);
+
+        for (int i = 0; i < count; ++i) {
+            vectors[i].iov_base = datagrams[i].data.get();
+            vectors[i].iov_len = udt::MAX_DATAGRAM_SIZE;
+            headers[i].msg_hdr.msg_iov = &vectors[i];
+            headers[i].msg_hdr.msg_iovlen = 1;
+            headers[i].msg_hdr.msg_name = &addresses[i];
+            headers[i].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+        }
+
+        int result = ::recvmmsg(descriptor, headers, count, MSG_DONTWAIT, nullptr);
+        for (int i = 0; i < result; ++i) {
+            auto& datagram = datagrams[i];
+            datagram.sockAddr.setType(SocketType::UDP);
+
+            auto address = reinterpret_cast<const sockaddr*>(&addresses[i]);
+            datagram.sockAddr.setAddress(QHostAddress(address));
+            if (address->sa_family == AF_INET6) {
+                datagram.sockAddr.setPort(ntohs(reinterpret_cast<const sockaddr_in6*>(address)->sin6_port));
+            } else {
+                datagram.sockAddr.setPort(ntohs(reinterpret_cast<const sockaddr_in*>(address)->sin_port));
+            }
+
+            // drop datagrams that didn't fit in a packet buffer, they can't be valid packets
+            datagram.size = (headers[i].msg_hdr.msg_flags & MSG_TRUNC) ? 0 : headers[i].msg_len;
+        }
+        return std::max(result, 0);
+    }
+}
+#endif
 
 
 NetworkSocket::NetworkSocket(QObject* parent) :
@@ -68,6 +164,12 @@ QVariant NetworkSocket::socketOption(SocketType socketType, QAbstractSocket::Soc
 void NetworkSocket::bind(SocketType socketType, const QHostAddress& address, quint16 port) {
     switch (socketType) {
     case SocketType::UDP:
+#if defined(Q_OS_LINUX)
+        if (_reusePortGroupSize > 1) {
+            bindReusePortGroup(address, port);
+            break;
+        }
+#endif
         _udpSocket.bind(address, port);
         break;
 #if defined(WEBRTC_DATA_CHANNELS)
@@ -83,6 +185,7 @@ void NetworkSocket::bind(SocketType socketType, const QHostAddress& address, qui
 void NetworkSocket::abort(SocketType socketType) {
     switch (socketType) {
     case SocketType::UDP:
+        closeSiblings();
         _udpSocket.abort();
         break;
 #if defined(WEBRTC_DATA_CHANNELS)
@@ -95,6 +198,78 @@ void NetworkSocket::abort(SocketType socketType) {
     }
 }
 
+void NetworkSocket::bindReusePortGroup(const QHostAddress& address, quint16 port) {
+#if defined(Q_OS_LINUX)
+    closeSiblings();
+
+    int descriptor = createReusePortSocket(address, port);
+    if (descriptor < 0 || !_udpSocket.setSocketDescriptor(descriptor, QAbstractSocket::BoundState)) {
+        qCWarning(networking) << "Could not bind a socket with SO_REUSEPORT to port" << port << "-" << strerror(errno)
+            << "- binding a single socket";
+        if (descriptor >= 0) {
+            ::close(descriptor);
+        }
+        _udpSocket.bind(address, port);
+        return;
+    }
+
+    // the siblings are bound to the port the first socket got, in case it was picked by the system
+    quint16 boundPort = _udpSocket.localPort();
+    for (int i = 1; i < _reusePortGroupSize; ++i) {
+        int sibling = createReusePortSocket(address, boundPort);
+        if (sibling < 0) {
+            qCWarning(networking) << "Could only bind" << i << "of" << _reusePortGroupSize << "sockets to port" << boundPort
+                << "-" << strerror(errno);
+            break;
+        }
+
+        int bufferSize = udt::UDP_RECEIVE_BUFFER_SIZE_BYTES;
+        ::setsockopt(sibling, SOL_SOCKET, SO_RCVBUF, &bufferSize, sizeof(bufferSize));
+        _siblingDescriptors.push_back(sibling);
+    }
+#else
+    Q_UNUSED(address);
+    Q_UNUSED(port);
+#endif
+}
+
+void NetworkSocket::closeSiblings() {
+#if defined(Q_OS_LINUX)
+    for (auto descriptor : _siblingDescriptors) {
+        ::close((int)descriptor);
+    }
+#endif
+    _siblingDescriptors.clear();
+}
+
+int NetworkSocket::readSiblingDatagrams(qintptr descriptor, std::vector<Datagram>& datagrams, int timeoutMsecs) {
+    const int maxCount = std::min((int)datagrams.size(), MAX_DATAGRAM_BATCH_SIZE);
+    if (maxCount <= 0) {
+        return 0;
+    }
+
+#if defined(Q_OS_LINUX)
+    pollfd pollDescriptor;
+    pollDescriptor.fd = (int)descriptor;
+    pollDescriptor.events = POLLIN;
+    pollDescriptor.revents = 0;
+    if (::poll(&pollDescriptor, 1, timeoutMsecs) <= 0 || !(pollDescriptor.revents & (POLLIN | POLLERR))) {
+        return 0;
+    }
+
+    for (int i = 0; i < maxCount; ++i) {
+        if (!datagrams[i].data) {
+            datagrams[i].data = udt::PacketBufferPool::allocate(udt::MAX_DATAGRAM_SIZE);
+        }
+        datagrams[i].size = 0;
+    }
+    return receiveDatagrams((int)descriptor, datagrams.data(), maxCount);
+#else
+    Q_UNUSED(descriptor);
+    Q_UNUSED(timeoutMsecs);
+    return 0;
+#endif
+}
 
 quint16 NetworkSocket::localPort(SocketType socketType) const {
     switch (socketType) {
@@ -142,6 +317,130 @@ qint64 NetworkSocket::writeDatagram(const QByteArray& datagram, const SockAddr&
     }
 }
 
+int NetworkSocket::writeDatagrams(const char* data, const std::vector<OutgoingDatagram>& datagrams) {
+    int numSent = 0;
+    const int count = (int)datagrams.size();
+
+#if defined(Q_OS_LINUX)
+    // the largest UDP payload the kernel will accept for one GSO send, and the most segments it will split it into
+    static const qint64 MAX_SEGMENTED_SEND_BYTES = 65000;
+    static const int MAX_SEGMENTS_PER_SEND = 64;
+
+    auto fd = (int)_udpSocket.socketDescriptor();
+    bool useSegmentation = _isSegmentationOffloadEnabled;
+
+    int index = 0;
+    while (index < count) {
+        mmsghdr headers[MAX_DATAGRAM_BATCH_SIZE];
+        iovec vectors[MAX_DATAGRAM_BATCH_SIZE];
+        sockaddr_in addresses[MAX_DATAGRAM_BATCH_SIZE];
+        char controls[MAX_DATAGRAM_BATCH_SIZE][CMSG_SPACE(sizeof(uint16_t))];
+        int firstDatagram[MAX_DATAGRAM_BATCH_SIZE + 1];
+        memset(headers, 0, sizeof(headers));
+
+        // build up to MAX_DATAGRAM_BATCH_SIZE messages, each of one datagram or a run of equal sized GSO segments
+        int numMessages = 0;
+        int numVectors = 0;
+        while (index < count && numMessages < MAX_DATAGRAM_BATCH_SIZE && numVectors < MAX_DATAGRAM_BATCH_SIZE) {
+            const auto& datagram = datagrams[index];
+            if (datagram.sockAddr.getType() != SocketType::UDP
+                || datagram.sockAddr.getAddress().protocol() != QAbstractSocket::IPv4Protocol) {
+                // not something we can hand to sendmmsg, send it on its own
+                if (numMessages > 0) {
+                    break;
+                }
+                if (writeDatagram(QByteArray::fromRawData(data + datagram.offset, datagram.size), datagram.sockAddr) >= 0) {
+                    ++numSent;
+                }
+                ++index;
+                continue;
+            }
+
+            auto& header = headers[numMessages].msg_hdr;
+            auto& address = addresses[numMessages];
+            memset(&address, 0, sizeof(address));
+            address.sin_family = AF_INET;
+            address.sin_port = htons(datagram.sockAddr.getPort());
+            address.sin_addr.s_addr = htonl(datagram.sockAddr.getAddress().toIPv4Address());
+            header.msg_name = &address;
+            header.msg_namelen = sizeof(address);
+            header.msg_iov = &vectors[numVectors];
+            firstDatagram[numMessages] = index;
+
+            // gather the run of datagrams that can go out as segments of this message
+            qint64 segmentSize = datagram.size;
+            qint64 totalSize = 0;
+            int numSegments = 0;
+            do {
+                const auto& segment = datagrams[index];
+                vectors[numVectors].iov_base = const_cast<char*>(data + segment.offset);
+                vectors[numVectors].iov_len = segment.size;
+                totalSize += segment.size;
+                ++numVectors;
+                ++numSegments;
+                ++index;
+
+                if (!useSegmentation || segment.size < segmentSize) {
+                    // only the final segment of a GSO send may be shorter than the others
+                    break;
+                }
+            } while (index < count && numVectors < MAX_DATAGRAM_BATCH_SIZE && numSegments < MAX_SEGMENTS_PER_SEND
+                     && datagrams[index].sockAddr == datagram.sockAddr
+                     && datagrams[index].size <= segmentSize
+                     && totalSize + datagrams[index].size <= MAX_SEGMENTED_SEND_BYTES);
+            header.msg_iovlen = numSegments;
+
+            if (numSegments > 1) {
+                header.msg_control = controls[numMessages];
+                header.msg_controllen = CMSG_SPACE(sizeof(uint16_t));
+                auto controlMessage = CMSG_FIRSTHDR(&header);
+                controlMessage->cmsg_level = SOL_UDP;
+                controlMessage->cmsg_type = UDP_SEGMENT;
+                controlMessage->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+                uint16_t gsoSize = (uint16_t)segmentSize;
+                memcpy(CMSG_DATA(controlMessage), &gsoSize, sizeof(gsoSize));
+            }
+
+            ++numMessages;
+        }
+        firstDatagram[numMessages] = index;
+
+        int message = 0;
+        while (message < numMessages) {
+            int result = ::sendmmsg(fd, &headers[message], numMessages - message, 0);
+            if (result <= 0) {
+                bool segmentationFailed = (errno == EIO || errno == EINVAL) && headers[message].msg_hdr.msg_controllen > 0;
+                if (segmentationFailed && _isSegmentationOffloadEnabled.exchange(false)) {
+                    qCDebug(networking) << "UDP segmentation offload is not supported, disabling it";
+                }
+
+                // send the rest of this batch the slow way
+                for (int i = firstDatagram[message]; i < firstDatagram[numMessages]; ++i) {
+                    const auto& datagram = datagrams[i];
+                    if (writeDatagram(QByteArray::fromRawData(data + datagram.offset, datagram.size),
+                                      datagram.sockAddr) >= 0) {
+                        ++numSent;
+                    }
+                }
+                break;
+            }
+
+            numSent += firstDatagram[message + result] - firstDatagram[message];
+            message += result;
+        }
+    }
+#else
+    for (int i = 0; i < count; ++i) {
+        const auto& datagram = datagrams[i];
+        if (writeDatagram(QByteArray::fromRawData(data + datagram.offset, datagram.size), datagram.sockAddr) >= 0) {
+            ++numSent;
+        }
+    }
+#endif
+
+    return numSent;
+}
+
 qint64 NetworkSocket::bytesToWrite(SocketType socketType, const SockAddr& address) const {
     switch (socketType) {
     case SocketType::UDP:
@@ -223,6 +522,66 @@ qint64 NetworkSocket::readDatagram(char* data, qint64 maxSize, SockAddr* sockAdd
 #endif
 }
 
+int NetworkSocket::readDatagrams(std::vector<Datagram>& datagrams) {
+    const int maxCount = std::min((int)datagrams.size(), MAX_DATAGRAM_BATCH_SIZE);
+    if (maxCount <= 0 || _udpSocket.state() != QAbstractSocket::BoundState) {
+        return 0;
+    }
+
+    for (int i = 0; i < maxCount; ++i) {
+        if (!datagrams[i].data) {
+            datagrams[i].data = udt::PacketBufferPool::allocate(udt::MAX_DATAGRAM_SIZE);
+        }
+        datagrams[i].size = 0;
+    }
+
+    int numRead = 0;
+
+#if defined(Q_OS_LINUX)
+    // Leave the last slot for QUdpSocket::readDatagram() so that Qt re-enables its read notifier.
+    const int maxSystemCallCount = maxCount - 1;
+    if (maxSystemCallCount > 0) {
+        numRead = receiveDatagrams((int)_udpSocket.socketDescriptor(), datagrams.data(), maxSystemCallCount);
+
+        if (numRead < maxSystemCallCount) {
+            // the kernel queue was drained, but we still need a QUdpSocket read to re-arm Qt's notifier
+            auto& datagram = datagrams[numRead];
+            datagram.sockAddr.setType(SocketType::UDP);
+            auto sizeRead = _udpSocket.readDatagram(datagram.data.get(), udt::MAX_DATAGRAM_SIZE,
+                datagram.sockAddr.getAddressPointer(), datagram.sockAddr.getPortPointer());
+            if (sizeRead > 0) {
+                datagram.size = sizeRead;
+                ++numRead;
+            }
+            return numRead;
+        }
+    }
+#endif
+
+    while (numRead < maxCount && _udpSocket.hasPendingDatagrams()) {
+        auto& datagram = datagrams[numRead];
+        auto pendingSize = _udpSocket.pendingDatagramSize();
+        if (pendingSize < 0) {
+            break;
+        } else if (pendingSize > udt::MAX_DATAGRAM_SIZE) {
+            // oversized datagram, pull it off the queue and drop it
+            _udpSocket.readDatagram(nullptr, 0);
+            continue;
+        }
+
+        datagram.sockAddr.setType(SocketType::UDP);
+        auto sizeRead = _udpSocket.readDatagram(datagram.data.get(), udt::MAX_DATAGRAM_SIZE,
+            datagram.sockAddr.getAddressPointer(), datagram.sockAddr.getPortPointer());
+        if (sizeRead <= 0) {
+            break;
+        }
+        datagram.size = sizeRead;
+        ++numRead;
+    }
+
+    return numRead;
+}
+
 
 QAbstractSocket::SocketState NetworkSocket::state(SocketType socketType) const {
     switch (socketType) {
@@ -10,6 +10,11 @@
 #ifndef vircadia_NetworkSocket_h
 #define vircadia_NetworkSocket_h
 
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <vector>
+
 #include <QObject>
 #include <QUdpSocket>
 
@@ -20,6 +25,7 @@
 #include "../SocketType.h"
 #if defined(WEBRTC_DATA_CHANNELS)
 #include "../webrtc/WebRTCSocket.h"
+#include "PacketBufferPool.h"
 #endif
 
 /// @addtogroup Networking
@@ -32,9 +38,27 @@ class NetworkSocket : public QObject {
 
 public:
 
+    /// @brief A UDP datagram read by readDatagrams() into a reusable, pre-sized buffer.
+    struct Datagram {
+        udt::PacketBuffer data;        ///< The datagram data. Allocated to udt::MAX_DATAGRAM_SIZE if empty when read into.
+        qint64 size { 0 };             ///< The number of bytes read, <code>0</code> if the datagram should be ignored.
+        SockAddr sockAddr;             ///< The source network address.
+    };
+
+    /// @brief A UDP datagram queued for writeDatagrams(), stored at an offset in a shared buffer.
+    struct OutgoingDatagram {
+        qint64 offset { 0 };           ///< The offset of the datagram data in the batch buffer.
+        qint64 size { 0 };             ///< The size of the datagram.
+        SockAddr sockAddr;             ///< The destination network address.
+    };
+
+    /// @brief The maximum number of datagrams that readDatagrams() reads in one call.
+    static const int MAX_DATAGRAM_BATCH_SIZE = 64;
+
     /// @brief Constructs a new NetworkSocket object.
     /// @param parent Qt parent object.
     NetworkSocket(QObject* parent);
+    ~NetworkSocket() { closeSiblings(); }
 
 
     /// @brief Set the value of a UDP or WebRTC socket option.
@@ -50,13 +74,34 @@ public:
     QVariant socketOption(SocketType socketType, QAbstractSocket::SocketOption option);
 
 
+    /// @brief Sets how many UDP sockets the next bind() opens on the same port with <code>SO_REUSEPORT</code>.
+    /// @details The kernel hashes each sender's flow to one of the sockets, so a sender's datagrams always arrive on
+    /// the same one. The first socket is the QUdpSocket, the others are only read through readSiblingDatagrams() and
+    /// are never written to. Only supported on Linux, elsewhere a single socket is always bound.
+    /// @param size The number of sockets, <code>1</code> for just the QUdpSocket.
+    void setReusePortGroupSize(int size) { _reusePortGroupSize = std::max(size, 1); }
+
+    /// @brief Gets the native descriptors of the UDP sockets bound to the QUdpSocket's port besides it.
+    /// @details They are closed by abort(), so whatever reads them must have stopped before then.
+    /// @return The sibling socket descriptors, empty unless setReusePortGroupSize() asked for more than one socket.
+    const std::vector<qintptr>& getSiblingDescriptors() const { return _siblingDescriptors; }
+
+    /// @brief Waits for datagrams on a sibling socket and reads them with as few system calls as possible.
+    /// @details Unlike readDatagrams(), this doesn't go through Qt and can be called from any thread. Empty buffers in
+    /// <code>datagrams</code> are allocated; buffers that are still owned are reused.
+    /// @param descriptor A descriptor from getSiblingDescriptors().
+    /// @param datagrams The batch to read into. At most <code>MAX_DATAGRAM_BATCH_SIZE</code> entries are used.
+    /// @param timeoutMsecs How long to wait for a datagram when none is pending.
+    /// @return The number of entries of <code>datagrams</code> that were filled.
+    static int readSiblingDatagrams(qintptr descriptor, std::vector<Datagram>& datagrams, int timeoutMsecs);
+
     /// @brief Binds the UDP or WebRTC socket to an address and port.
     /// @param socketType The type of socket to bind.
     /// @param address The address to bind to.
     /// @param port The port to bind to.
     void bind(SocketType socketType, const QHostAddress& address, quint16 port = 0);
 
-    /// @brief Immediately closes and resets the socket.
+    /// @brief Immediately closes and resets the socket, and for UDP its siblings.
     /// @param socketType The type of socket to close and reset.
     void abort(SocketType socketType);
 
@@ -78,6 +123,15 @@ public:
     /// @return The number of bytes if successfully sent, otherwise <code>-1</code>.
     qint64 writeDatagram(const QByteArray& datagram, const SockAddr& sockAddr);
 
+    /// @brief Sends a batch of UDP datagrams, using as few system calls as possible.
+    /// @details On Linux the datagrams are sent with <code>sendmmsg</code>. Consecutive datagrams of the same size to the
+    /// same destination are coalesced into a single UDP GSO send where the kernel supports it. Datagrams that can't be
+    /// sent in a batch fall back to writeDatagram().
+    /// @param data The buffer that the datagrams' offsets refer to.
+    /// @param datagrams The datagrams to send.
+    /// @return The number of datagrams successfully sent.
+    int writeDatagrams(const char* data, const std::vector<OutgoingDatagram>& datagrams);
+
     /// @brief Gets the number of bytes waiting to be written.
     /// @details For UDP, there's a single buffer used for all destinations. For WebRTC, each destination has its own buffer.
     /// @param socketType The type of socket for which to get the number of bytes waiting to be written.
@@ -103,6 +157,15 @@ public:
     /// @return The number of bytes if successfully read, otherwise <code>-1</code>.
     qint64 readDatagram(char* data, qint64 maxSize, SockAddr* sockAddr = nullptr);
 
+    /// @brief Reads pending UDP datagrams into a batch of buffers, using as few system calls as possible.
+    /// @details On Linux the datagrams are pulled with <code>recvmmsg</code>. The final slot is always read through the
+    /// QUdpSocket so that Qt keeps its read notifier armed. On other platforms the datagrams are read one at a time.
+    /// Empty buffers in <code>datagrams</code> are allocated; buffers that are still owned are reused.
+    /// WebRTC datagrams are not read by this method.
+    /// @param datagrams The batch to read into. At most <code>MAX_DATAGRAM_BATCH_SIZE</code> entries are used.
+    /// @return The number of entries of <code>datagrams</code> that were filled.
+    int readDatagrams(std::vector<Datagram>& datagrams);
+
 
     /// @brief Gets the state of the UDP or WebRTC socket.
     /// @param socketType The type of socket for which to get the state.
@@ -156,9 +219,15 @@ private slots:
 
 private:
 
+    void bindReusePortGroup(const QHostAddress& address, quint16 port);
+    void closeSiblings();
+
     QObject* _parent;
 
     QUdpSocket _udpSocket;
+    std::atomic<bool> _isSegmentationOffloadEnabled { true };
+    int _reusePortGroupSize { 1 };
+    std::vector<qintptr> _siblingDescriptors;
 #if defined(WEBRTC_DATA_CHANNELS)
     WebRTCSocket _webrtcSocket;
 #endif
@@ -63,7 +63,7 @@ std::unique_ptr<Packet> Packet::create(qint64 size, bool isReliable, bool isPart
     return packet;
 }
 
-std::unique_ptr<Packet> Packet::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr) {
+std::unique_ptr<Packet> Packet::fromReceivedPacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr) {
     // Fail with invalid size
     Q_ASSERT(size >= 0);
 
@@ -89,7 +89,7 @@ Packet::Packet(qint64 size, bool isReliable, bool isPartOfMessage) :
     writeHeader();
 }
 
-Packet::Packet(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr) :
+Packet::Packet(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr) :
     BasePacket(std::move(data), size, senderSockAddr)
 {
     readHeader();
@@ -169,6 +169,8 @@ void Packet::copyMembers(const Packet& other) {
     _isReliable = other._isReliable;
     _isPartOfMessage = other._isPartOfMessage;
     _obfuscationLevel = other._obfuscationLevel;
+    _priority = other._priority;
+    _queuedTime = other._queuedTime;
     _sequenceNumber = other._sequenceNumber;
     _packetPosition = other._packetPosition;
     _messageNumber = other._messageNumber;
@@ -81,8 +81,18 @@ public:
         ObfuscationL3 = 0x3, // 11
     };
 
+    // The class of the stream a reliable packet is sent in, which the PacketQueue shares the connection between.
+    // Local only, it isn't written to the header.
+    enum class Priority : uint8_t {
+        Urgent, // single packets
+        Normal, // packet lists by default
+        Bulk // large transfers that shouldn't hold up the rest
+    };
+    Q_ENUM(Priority)
+    static const int NUM_PRIORITIES = 3;
+
     static std::unique_ptr<Packet> create(qint64 size = -1, bool isReliable = false, bool isPartOfMessage = false);
-    static std::unique_ptr<Packet> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    static std::unique_ptr<Packet> fromReceivedPacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     
     // Provided for convenience, try to limit use
     static std::unique_ptr<Packet> createCopy(const Packet& other);
@@ -98,6 +108,13 @@ public:
     bool isReliable() const { return _isReliable; }
     void setReliable(bool reliable) { _isReliable = reliable; }
 
+    Priority getPriority() const { return _priority; }
+    void setPriority(Priority priority) { _priority = priority; }
+
+    // when the packet was queued to be sent, for the send latency stats
+    p_high_resolution_clock::time_point getQueuedTime() const { return _queuedTime; }
+    void setQueuedTime(p_high_resolution_clock::time_point queuedTime) { _queuedTime = queuedTime; }
+
     ObfuscationLevel getObfuscationLevel() const { return _obfuscationLevel; }
     SequenceNumber getSequenceNumber() const { return _sequenceNumber; }
     MessageNumber getMessageNumber() const { return _messageNumber; }
@@ -110,7 +127,7 @@ public:
 
 protected:
     Packet(qint64 size, bool isReliable = false, bool isPartOfMessage = false);
-    Packet(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    Packet(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     
     Packet(const Packet& other);
     Packet(Packet&& other);
@@ -133,6 +150,9 @@ private:
     mutable MessageNumber _messageNumber { 0 };
     mutable PacketPosition _packetPosition { PacketPosition::ONLY };
     mutable MessagePartNumber _messagePartNumber { 0 };
+
+    Priority _priority { Priority::Urgent };
+    p_high_resolution_clock::time_point _queuedTime;
 };
 
 } // namespace udt
@@ -0,0 +1,151 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <PerformanceCounters.h>
+
+using namespace udt;
+
+namespace {
+
+// the buffers a thread keeps before handing a batch to the shared list, a few frames of a mixer's packets
+const size_t MAX_THREAD_BUFFERS = 256;
+const size_t TRANSFER_BATCH_SIZE = 128;
+// about 24MB, past which returned buffers are freed
+const size_t MAX_SHARED_BUFFERS = 16384;
+
+struct SharedBuffers {
+    std::mutex mutex;
+    std::vector<char*> buffers;
+};
+
+SharedBuffers& sharedBuffers() {
+    // leaked, so the threads still returning buffers while the process exits never find it destroyed
+    static SharedBuffers* shared = new SharedBuffers();
+    return *shared;
+}
+
+void giveToShared(std::vector<char*>& buffers, size_t count) {
+    auto& shared = sharedBuffers();
+    auto first = buffers.end() - count;
+    {
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        while (first != buffers.end() && shared.buffers.size() < MAX_SHARED_BUFFERS) {
+            shared.buffers.push_back(*first++);
+        }
+    }
+    for (auto it = first; it != buffers.end(); ++it) {
+        delete[] *it;
+    }
+    buffers.resize(buffers.size() - count);
+}
+
+void takeFromShared(std::vector<char*>& buffers) {
+    auto& shared = sharedBuffers();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    size_t count = std::min(TRANSFER_BATCH_SIZE, shared.buffers.size());
+    buffers.insert(buffers.end(), shared.buffers.end() - count, shared.buffers.end());
+    shared.buffers.resize(shared.buffers.size() - count);
+}
+
+struct ThreadBuffers {
+    ThreadBuffers() { buffers.reserve(MAX_THREAD_BUFFERS + 1); }
+    ~ThreadBuffers();
+
+    std::vector<char*> buffers;
+};
+
+// a thread's free list is made the first time it's used, and packets freed as the thread exits skip it once it's gone
+thread_local bool threadBuffersDestroyed { false };
+
+ThreadBuffers::~ThreadBuffers() {
+    threadBuffersDestroyed = true;
+    giveToShared(buffers, buffers.size());
+}
+
+std::vector<char*>* getThreadBuffers() {
+    if (threadBuffersDestroyed) {
+        return nullptr;
+    }
+    thread_local ThreadBuffers threadBuffers;
+    return &threadBuffers.buffers;
+}
+
+PerformanceCounters::Counter& poolHits() {
+    static auto& counter = PerformanceCounters::getInstance().counter("packet_buffer_pool_hits",
+        "Packet buffers reused from the pool");
+    return counter;
+}
+
+PerformanceCounters::Counter& poolMisses() {
+    static auto& counter = PerformanceCounters::getInstance().counter("packet_buffer_pool_misses",
+        "Packet buffers allocated because the pool had none, or the packet was too big for it");
+    return counter;
+}
+
+}
+
+void PacketBufferPool::Deleter::operator()(char* buffer) const {
+    if (isPooled) {
+        release(buffer);
+    } else {
+        delete[] buffer;
+    }
+}
+
+PacketBufferPool::Buffer PacketBufferPool::allocate(size_t size) {
+    Deleter deleter;
+    if (size > BUFFER_SIZE) {
+        poolMisses().increment();
+        return Buffer(new char[size], deleter);
+    }
+
+    deleter.isPooled = true;
+
+    auto buffers = getThreadBuffers();
+    if (buffers) {
+        if (buffers->empty()) {
+            takeFromShared(*buffers);
+        }
+        if (!buffers->empty()) {
+            char* buffer = buffers->back();
+            buffers->pop_back();
+            poolHits().increment();
+            return Buffer(buffer, deleter);
+        }
+    }
+
+    poolMisses().increment();
+    return Buffer(new char[BUFFER_SIZE], deleter);
+}
+
+void PacketBufferPool::release(char* buffer) {
+    if (!buffer) {
+        return;
+    }
+
+    auto buffers = getThreadBuffers();
+    if (!buffers) {
+        std::vector<char*> lastBuffers { buffer };
+        giveToShared(lastBuffers, 1);
+        return;
+    }
+
+    buffers->push_back(buffer);
+    if (buffers->size() > MAX_THREAD_BUFFERS) {
+        giveToShared(*buffers, TRANSFER_BATCH_SIZE);
+    }
+}
@@ -0,0 +1,55 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_udt_PacketBufferPool_h
+#define hifi_udt_PacketBufferPool_h
+
+#include <cstddef>
+#include <memory>
+
+#include "Constants.h"
+
+namespace udt {
+
+// Recycles the buffers packets are sent and received in, all of them sized for the biggest datagram, so a mixer
+// stops paying a heap allocation and free for every packet. Each thread takes from and returns to a free list of its
+// own. The threads that free more buffers than they take, like the one processing what the socket thread received,
+// hand the surplus to a shared list a batch at a time, which the threads that run out take from in batches too.
+class PacketBufferPool {
+public:
+    static const size_t BUFFER_SIZE = MAX_DATAGRAM_SIZE;
+
+    // frees a buffer, back to the pool if it came from there
+    struct Deleter {
+        Deleter() = default;
+        // lets a buffer that was allocated with new[] be handed over as a PacketBuffer
+        Deleter(const std::default_delete<char[]>&) {}
+
+        void operator()(char* buffer) const;
+
+        bool isPooled { false };
+    };
+    using Buffer = std::unique_ptr<char[], Deleter>;
+
+    // a buffer of at least size bytes, from the pool when it is up to BUFFER_SIZE
+    static Buffer allocate(size_t size = BUFFER_SIZE);
+
+private:
+    static void release(char* buffer);
+};
+
+using PacketBuffer = PacketBufferPool::Buffer;
+
+}
+
+#endif // hifi_udt_PacketBufferPool_h
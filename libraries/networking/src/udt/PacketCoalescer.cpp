@@ -0,0 +1,99 @@
+//
+//  PacketCoalescer.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketCoalescer.h"
+
+#include <cstring>
+
+#include "Constants.h"
+
+using namespace udt;
+
+using FrameSize = quint16;
+
+bool PacketCoalescer::isCoalescable(const Packet& packet) {
+    return packet.isReliable() && packet.getDataSize() <= MAX_COALESCED_PACKET_SIZE &&
+        (!packet.isPartOfMessage() || packet.getPacketPosition() == Packet::PacketPosition::ONLY);
+}
+
+bool PacketCoalescer::fits(const Packet& packet, int headerSize) const {
+    return headerSize + _size + (int)sizeof(FrameSize) + packet.getDataSize() <= Packet::maxPayloadSize();
+}
+
+void PacketCoalescer::append(std::unique_ptr<Packet> packet) {
+    _size += (int)sizeof(FrameSize) + (int)packet->getDataSize();
+    _packets.push_back(std::move(packet));
+}
+
+std::unique_ptr<Packet> PacketCoalescer::takeCoalescedPacket(const QByteArray& header) {
+    if (_packets.empty()) {
+        return nullptr;
+    }
+
+    std::unique_ptr<Packet> coalescedPacket;
+    if (_packets.size() == 1) {
+        // nothing to share the datagram with
+        coalescedPacket = std::move(_packets.front());
+    } else {
+        coalescedPacket = Packet::create(header.size() + _size, true);
+        coalescedPacket->write(header);
+        for (const auto& packet : _packets) {
+            FrameSize size = (FrameSize)packet->getDataSize();
+            coalescedPacket->writePrimitive(size);
+            coalescedPacket->write(packet->getData(), size);
+        }
+    }
+
+    _packets.clear();
+    _size = 0;
+    return coalescedPacket;
+}
+
+std::vector<std::unique_ptr<Packet>> PacketCoalescer::split(const Packet& coalescedPacket, int headerSize) {
+    std::vector<std::unique_ptr<Packet>> packets;
+
+    const char* data = coalescedPacket.getData() + headerSize;
+    const char* end = coalescedPacket.getData() + coalescedPacket.getDataSize();
+    while (data < end) {
+        FrameSize size;
+        if (end - data < (qint64)sizeof(size)) {
+            packets.clear();
+            break;
+        }
+        memcpy(&size, data, sizeof(size));
+        data += sizeof(size);
+
+        if (size < Packet::localHeaderSize() || size > end - data) {
+            packets.clear();
+            break;
+        }
+
+        // only reliable data packets are coalesced
+        Packet::SequenceNumberAndBitField sequenceNumberAndBitField;
+        memcpy(&sequenceNumberAndBitField, data, sizeof(sequenceNumberAndBitField));
+        bool isPartOfMessage = sequenceNumberAndBitField & MESSAGE_BIT_MASK;
+        if ((sequenceNumberAndBitField & CONTROL_BIT_MASK) || !(sequenceNumberAndBitField & RELIABILITY_BIT_MASK)
+            || size < Packet::localHeaderSize(isPartOfMessage)) {
+            packets.clear();
+            break;
+        }
+
+        auto buffer = PacketBufferPool::allocate(size);
+        memcpy(buffer.get(), data, size);
+        data += size;
+
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), size, coalescedPacket.getSenderSockAddr());
+        packet->setReceiveTime(coalescedPacket.getReceiveTime());
+        packets.push_back(std::move(packet));
+    }
+
+    return packets;
+}
@@ -0,0 +1,57 @@
+//
+//  PacketCoalescer.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_udt_PacketCoalescer_h
+#define hifi_udt_PacketCoalescer_h
+
+#include <memory>
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "Packet.h"
+
+namespace udt {
+
+// Collects small reliable packets to the same destination so that they share one datagram, and with it one sequence
+// number, ACK and retransmission, instead of each paying for their own. The shared packet's payload is a header that
+// tells the receiver what it is, followed by each packet as it would have been sent, prefixed by its size.
+class PacketCoalescer {
+public:
+    // the biggest packet worth holding back to share a datagram with others
+    static const int MAX_COALESCED_PACKET_SIZE = 256;
+
+    // small enough, and either not part of a message or the only packet of one
+    static bool isCoalescable(const Packet& packet);
+
+    bool isEmpty() const { return _packets.empty(); }
+    size_t getNumPackets() const { return _packets.size(); }
+
+    // whether the packet still fits in the datagram the collected ones share, after the header
+    bool fits(const Packet& packet, int headerSize) const;
+    void append(std::unique_ptr<Packet> packet);
+
+    // the reliable packet the collected ones share, or the only one collected as it was
+    std::unique_ptr<Packet> takeCoalescedPacket(const QByteArray& header);
+
+    // the packets coalesced in the data of a received packet after headerSize bytes, none if that data is malformed
+    static std::vector<std::unique_ptr<Packet>> split(const Packet& coalescedPacket, int headerSize);
+
+private:
+    std::vector<std::unique_ptr<Packet>> _packets;
+    int _size { 0 };
+};
+
+}
+
+#endif // hifi_udt_PacketCoalescer_h
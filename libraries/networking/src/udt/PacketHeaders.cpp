@@ -27,7 +27,7 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::DomainConnectRequestPending: // keeping the old version to maintain the protocol hash
             return 17;
         case PacketType::DomainList:
-            return static_cast<PacketVersion>(DomainListVersion::SocketTypes);
+            return static_cast<PacketVersion>(DomainListVersion::DeltaLists);
         case PacketType::EntityAdd:
         case PacketType::EntityClone:
         case PacketType::EntityEdit:
@@ -38,12 +38,12 @@ PacketVersion versionForPacketType(PacketType packetType) {
             return static_cast<PacketVersion>(EntityQueryPacketVersion::ConicalFrustums);
         case PacketType::AvatarIdentity:
         case PacketType::AvatarData:
-            return static_cast<PacketVersion>(AvatarMixerPacketVersion::ARKitBlendshapes);
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::CompactJointRotations);
         case PacketType::BulkAvatarData:
         case PacketType::KillAvatar:
-            return static_cast<PacketVersion>(AvatarMixerPacketVersion::ARKitBlendshapes);
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::CompactJointRotations);
         case PacketType::MessagesData:
-            return static_cast<PacketVersion>(MessageDataVersion::TextOrBinaryData);
+            return static_cast<PacketVersion>(MessageDataVersion::BatchedMessages);
         // ICE packets
         case PacketType::ICEServerPeerInformation:
             return 17;
@@ -64,7 +64,12 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::AssetGetInfo:
         case PacketType::AssetGet:
         case PacketType::AssetUpload:
-            return static_cast<PacketVersion>(AssetServerPacketVersion::BakingTextureMeta);
+        case PacketType::AssetUploadManifest:
+        case PacketType::AssetDeltaUpload:
+            return static_cast<PacketVersion>(AssetServerPacketVersion::DeltaUploads);
+        case PacketType::RequestAssignment:
+        case PacketType::CreateAssignment:
+            return static_cast<PacketVersion>(AssignmentVersion::BakeWorkerType);
         case PacketType::NodeIgnoreRequest:
             return 18; // Introduction of node ignore request (which replaced an unused packet tpye)
 
@@ -74,7 +79,7 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::DomainConnectRequest:
             return static_cast<PacketVersion>(DomainConnectRequestVersion::SocketTypes);
         case PacketType::DomainListRequest:
-            return static_cast<PacketVersion>(DomainListRequestVersion::SocketTypes);
+            return static_cast<PacketVersion>(DomainListRequestVersion::HasDomainListVersion);
 
         case PacketType::DomainServerAddedNode:
             return static_cast<PacketVersion>(DomainServerAddedNodeVersion::SocketTypes);
@@ -90,6 +95,11 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::AudioStreamStats:
         case PacketType::StopInjector:
             return static_cast<PacketVersion>(AudioVersion::StopInjectors);
+        case PacketType::ReplicatedMicrophoneAudioNoEcho:
+        case PacketType::ReplicatedMicrophoneAudioWithEcho:
+        case PacketType::ReplicatedInjectAudio:
+        case PacketType::ReplicatedSilentAudioFrame:
+            return static_cast<PacketVersion>(AudioVersion::ReplicatedLocalIDs);
         case PacketType::DomainSettings:
             return 18;  // replace min_avatar_scale and max_avatar_scale with min_avatar_height and max_avatar_height
         case PacketType::Ping:
@@ -98,9 +108,12 @@ PacketVersion versionForPacketType(PacketType packetType) {
             return static_cast<PacketVersion>(AvatarQueryVersion::ConicalFrustums);
         case PacketType::EntityQueryInitialResultsComplete:
             return static_cast<PacketVersion>(EntityVersion::ParticleSpin);
+        case PacketType::SetAvatarTraits:
         case PacketType::BulkAvatarTraitsAck:
         case PacketType::BulkAvatarTraits:
-            return static_cast<PacketVersion>(AvatarMixerPacketVersion::AvatarTraitsAck);
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::CompactAvatarEntityTraits);
+        case PacketType::ReplicatedBulkAvatarData:
+            return static_cast<PacketVersion>(AvatarMixerPacketVersion::ReplicatedLocalIDs);
         default:
             return 22;
     }
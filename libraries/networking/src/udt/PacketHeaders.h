@@ -141,6 +141,28 @@ public:
         StopInjector,
         AvatarZonePresence,
         WebRTCSignaling,
+        BakeJobRequest,
+        BakeJob,
+        BakeJobResult,
+        BakeJobResultReply,
+        AssetUploadManifest,
+        AssetUploadManifestReply,
+        AssetDeltaUpload,
+        FECParity,
+        FECFeedback,
+        ICEClusterRegistration,
+        ICEClusterQuery,
+        ICEClusterPeerInformation,
+        MixerStandbyState,
+        SamplingProfileRequest,
+        SamplingProfileReply,
+        CoalescedPackets,
+        EntitySceneBundle,
+        AvatarShardSummaries,
+        AvatarShardRequests,
+        MixerShardClientPositions,
+        AudioShardListeners,
+        AudioShardKilledNode,
         NUM_PACKET_TYPE
     };
 
@@ -160,6 +182,8 @@ public:
     const static QSet<PacketTypeEnum::Value> getNonVerifiedPackets() {
         const static QSet<PacketTypeEnum::Value> NON_VERIFIED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::NodeJsonStats
+            << PacketTypeEnum::Value::MixerShardClientPositions
+            << PacketTypeEnum::Value::SamplingProfileReply
             << PacketTypeEnum::Value::EntityQuery
             << PacketTypeEnum::Value::OctreeDataNack
             << PacketTypeEnum::Value::EntityEditNack
@@ -168,10 +192,20 @@ public:
             << PacketTypeEnum::Value::DomainDisconnectRequest
             << PacketTypeEnum::Value::UsernameFromIDRequest
             << PacketTypeEnum::Value::NodeKickRequest
-            << PacketTypeEnum::Value::NodeMuteRequest;
+            << PacketTypeEnum::Value::NodeMuteRequest
+            << PacketTypeEnum::Value::FECParity;
         return NON_VERIFIED_PACKETS;
     }
 
+    // unreliable packets a lossy receiver can ask to have protected, see ForwardErrorCorrection.h
+    const static QSet<PacketTypeEnum::Value> getForwardErrorCorrectedPackets() {
+        const static QSet<PacketTypeEnum::Value> FORWARD_ERROR_CORRECTED_PACKETS = QSet<PacketTypeEnum::Value>()
+            << PacketTypeEnum::Value::MixedAudio
+            << PacketTypeEnum::Value::SilentAudioFrame
+            << PacketTypeEnum::Value::BulkAvatarData;
+        return FORWARD_ERROR_CORRECTED_PACKETS;
+    }
+
     const static QSet<PacketTypeEnum::Value> getNonSourcedPackets() {
         const static QSet<PacketTypeEnum::Value> NON_SOURCED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::DomainConnectRequestPending << PacketTypeEnum::Value::CreateAssignment
@@ -186,13 +220,16 @@ public:
             << PacketTypeEnum::Value::ICEServerQuery << PacketTypeEnum::Value::ICEServerHeartbeat
             << PacketTypeEnum::Value::ICEServerHeartbeatACK << PacketTypeEnum::Value::ICEPing
             << PacketTypeEnum::Value::ICEPingReply << PacketTypeEnum::Value::ICEServerHeartbeatDenied
+            << PacketTypeEnum::Value::ICEClusterRegistration << PacketTypeEnum::Value::ICEClusterQuery
+            << PacketTypeEnum::Value::ICEClusterPeerInformation
             << PacketTypeEnum::Value::AssignmentClientStatus << PacketTypeEnum::Value::StopNode
             << PacketTypeEnum::Value::DomainServerRemovedNode << PacketTypeEnum::Value::UsernameFromIDReply
             << PacketTypeEnum::Value::OctreeFileReplacement << PacketTypeEnum::Value::ReplicatedMicrophoneAudioNoEcho
             << PacketTypeEnum::Value::ReplicatedMicrophoneAudioWithEcho << PacketTypeEnum::Value::ReplicatedInjectAudio
             << PacketTypeEnum::Value::ReplicatedSilentAudioFrame << PacketTypeEnum::Value::ReplicatedAvatarIdentity
             << PacketTypeEnum::Value::ReplicatedKillAvatar << PacketTypeEnum::Value::ReplicatedBulkAvatarData
-            << PacketTypeEnum::Value::AvatarZonePresence << PacketTypeEnum::Value::WebRTCSignaling;
+            << PacketTypeEnum::Value::AvatarZonePresence << PacketTypeEnum::Value::WebRTCSignaling
+            << PacketTypeEnum::Value::SamplingProfileRequest << PacketTypeEnum::Value::CoalescedPackets;
         return NON_SOURCED_PACKETS;
     }
 
@@ -200,7 +237,9 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_SOURCED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperation
             << PacketTypeEnum::Value::AssetGet
-            << PacketTypeEnum::Value::AssetUpload;
+            << PacketTypeEnum::Value::AssetUpload
+            << PacketTypeEnum::Value::AssetUploadManifest
+            << PacketTypeEnum::Value::AssetDeltaUpload;
         return DOMAIN_SOURCED_PACKETS;
     }
 
@@ -208,7 +247,8 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_IGNORED_VERIFICATION_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperationReply
             << PacketTypeEnum::Value::AssetGetReply
-            << PacketTypeEnum::Value::AssetUploadReply;
+            << PacketTypeEnum::Value::AssetUploadReply
+            << PacketTypeEnum::Value::AssetUploadManifestReply;
         return DOMAIN_IGNORED_VERIFICATION_PACKETS;
     }
 };
@@ -291,6 +331,7 @@ enum class EntityVersion : PacketVersion {
     UserAgent,
     AllBillboardMode,
     TextAlignment,
+    EditDeltas,
 
     // Add new versions above here
     NUM_PACKET_TYPE,
@@ -315,7 +356,13 @@ enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
     RedirectedMappings,
-    BakingTextureMeta
+    BakingTextureMeta,
+    DeltaUploads
+};
+
+enum class AssignmentVersion : PacketVersion {
+    PreBakeWorker = 22,
+    BakeWorkerType
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
@@ -356,7 +403,10 @@ enum class AvatarMixerPacketVersion : PacketVersion {
     FBXJointOrderChange,
     HandControllerSection,
     SendVerificationFailed,
-    ARKitBlendshapes
+    ARKitBlendshapes,
+    CompactJointRotations,
+    CompactAvatarEntityTraits,
+    ReplicatedLocalIDs
 };
 
 enum class DomainConnectRequestVersion : PacketVersion {
@@ -375,7 +425,8 @@ enum class DomainConnectRequestVersion : PacketVersion {
 
 enum class DomainListRequestVersion : PacketVersion {
     PreSocketTypes = 22,
-    SocketTypes
+    SocketTypes,
+    HasDomainListVersion
 };
 
 enum class DomainConnectionDeniedVersion : PacketVersion {
@@ -398,7 +449,8 @@ enum class DomainListVersion : PacketVersion {
     AuthenticationOptional,
     HasTimestamp,
     HasConnectReason,
-    SocketTypes
+    SocketTypes,
+    DeltaLists
 };
 
 enum class AudioVersion : PacketVersion {
@@ -409,11 +461,13 @@ enum class AudioVersion : PacketVersion {
     SpaceBubbleChanges,
     HasPersonalMute,
     HighDynamicRangeVolume,
-    StopInjectors
+    StopInjectors,
+    ReplicatedLocalIDs
 };
 
 enum class MessageDataVersion : PacketVersion {
-    TextOrBinaryData = 18
+    TextOrBinaryData = 18,
+    BatchedMessages
 };
 
 enum class IcePingVersion : PacketVersion {
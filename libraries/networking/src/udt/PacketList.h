@@ -39,6 +39,10 @@ public:
     PacketType getType() const { return _packetType; }
     bool isReliable() const { return _isReliable; }
     bool isOrdered() const { return _isOrdered; }
+
+    // the priority the packets of this list are sent with, relative to the other reliable ones on the connection
+    Packet::Priority getPriority() const { return _priority; }
+    void setPriority(Packet::Priority priority) { _priority = priority; }
     
     size_t getNumPackets() const { return _packets.size() + (_currentPacket ? 1 : 0); }
     size_t getDataSize() const;
@@ -82,6 +86,7 @@ protected:
     
 private:
     friend class ::LimitedNodeList;
+    friend class Connection;
     friend class PacketQueue;
     friend class SendQueue;
     friend class Socket;
@@ -97,6 +102,7 @@ private:
     
     Packet::MessageNumber _messageNumber;
     bool _isReliable = false;
+    Packet::Priority _priority = Packet::Priority::Normal;
     
     std::unique_ptr<Packet> _currentPacket;
     
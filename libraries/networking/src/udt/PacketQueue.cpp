@@ -11,13 +11,20 @@
 
 #include "PacketQueue.h"
 
+#include <algorithm>
+
 #include "PacketList.h"
 
 using namespace udt;
 
+// how many packets each priority gets to send, in turn, while the others have packets waiting too
+static const std::array<int, Packet::NUM_PRIORITIES> PRIORITY_WEIGHTS {{ 8, 4, 1 }};
+
 PacketQueue::PacketQueue(MessageNumber messageNumber) : _currentMessageNumber(messageNumber) {
-    _channels.emplace_front(new std::list<PacketPointer>());
-    _currentChannel = _channels.begin();
+    _priorities[(int)Packet::Priority::Urgent].channels.emplace_front(new std::list<PacketPointer>());
+    for (auto& priorityChannels : _priorities) {
+        priorityChannels.currentChannel = priorityChannels.channels.begin();
+    }
 }
 
 MessageNumber PacketQueue::getNextMessageNumber() {
@@ -26,11 +33,18 @@ MessageNumber PacketQueue::getNextMessageNumber() {
     return _currentMessageNumber;
 }
 
+bool PacketQueue::isEmpty(const PriorityChannels& priorityChannels) const {
+    // the other channels are removed once empty, so only the main channel can be there and empty
+    return priorityChannels.channels.empty()
+        || (priorityChannels.channels.size() == 1 && priorityChannels.channels.front()->empty());
+}
+
 bool PacketQueue::isEmpty() const {
     LockGuard locker(_packetsLock);
 
-    // Only the main channel and it is empty
-    return _channels.size() == 1 && _channels.front()->empty();
+    return std::all_of(_priorities.begin(), _priorities.end(), [this](const PriorityChannels& priorityChannels) {
+        return isEmpty(priorityChannels);
+    });
 }
 
 PacketQueue::PacketPointer PacketQueue::takePacket() {
@@ -40,15 +54,42 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
         return PacketPointer();
     }
 
-    // handle the case where we are looking at the first channel and it is empty
-    if (_currentChannel == _channels.begin() && (*_currentChannel)->empty()) {
-        ++_currentChannel;
+    // take from the most urgent priority with packets that has credits left, and once they all ran out
+    // give them all their weight in credits again
+    for (int i = 0; i < 2; ++i) {
+        for (auto& priorityChannels : _priorities) {
+            if (priorityChannels.credits > 0 && !isEmpty(priorityChannels)) {
+                --priorityChannels.credits;
+                return takePacket(priorityChannels);
+            }
+        }
+
+        for (int priority = 0; priority < Packet::NUM_PRIORITIES; ++priority) {
+            _priorities[priority].credits = PRIORITY_WEIGHTS[priority];
+        }
+    }
+
+    Q_ASSERT_X(false, "PacketQueue::takePacket", "found no packets in a queue that is not empty");
+    return PacketPointer();
+}
+
+PacketQueue::PacketPointer PacketQueue::takePacket(PriorityChannels& priorityChannels) {
+    auto& channels = priorityChannels.channels;
+    auto& currentChannel = priorityChannels.currentChannel;
+
+    if (currentChannel == channels.end()) {
+        currentChannel = channels.begin();
+    }
+
+    // handle the case where we are looking at the main channel and it is empty
+    if ((*currentChannel)->empty()) {
+        ++currentChannel;
     }
 
     // at this point the current channel should always not be at the end and should also not be empty
-    Q_ASSERT(_currentChannel != _channels.end());
+    Q_ASSERT(currentChannel != channels.end());
 
-    auto& channel = *_currentChannel;
+    auto& channel = *currentChannel;
 
     Q_ASSERT(!channel->empty());
 
@@ -56,32 +97,38 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
     auto packet = std::move(channel->front());
     channel->pop_front();
 
+    bool isMainChannel = &priorityChannels == &_priorities[(int)Packet::Priority::Urgent]
+        && currentChannel == channels.begin();
+
     // Remove now empty channel (Don't remove the main channel)
-    if (channel->empty() && _currentChannel != _channels.begin()) {
+    if (channel->empty() && !isMainChannel) {
         // erase the current channel and slide the iterator to the next channel
-        _currentChannel = _channels.erase(_currentChannel);
+        currentChannel = channels.erase(currentChannel);
     } else {
-        ++_currentChannel;
+        ++currentChannel;
     }
 
     // push forward our number of channels taken from
-    ++_channelsVisitedCount;
+    ++priorityChannels.channelsVisitedCount;
 
-    // check if we need to restart back at the front channel (main)
+    // check if we need to restart back at the front channel
     // to respect our capped number of channels considered concurrently
-    static const int MAX_CHANNELS_SENT_CONCURRENTLY = 16;
+    static const unsigned int MAX_CHANNELS_SENT_CONCURRENTLY = 16;
 
-    if (_currentChannel == _channels.end() || _channelsVisitedCount >= MAX_CHANNELS_SENT_CONCURRENTLY) {
-        _channelsVisitedCount = 0;
-        _currentChannel = _channels.begin();
+    if (currentChannel == channels.end() || priorityChannels.channelsVisitedCount >= MAX_CHANNELS_SENT_CONCURRENTLY) {
+        priorityChannels.channelsVisitedCount = 0;
+        currentChannel = channels.begin();
     }
 
     return packet;
 }
 
 void PacketQueue::queuePacket(PacketPointer packet) {
+    packet->setPriority(Packet::Priority::Urgent);
+    packet->setQueuedTime(p_high_resolution_clock::now());
+
     LockGuard locker(_packetsLock);
-    _channels.front()->push_back(std::move(packet));
+    _priorities[(int)Packet::Priority::Urgent].channels.front()->push_back(std::move(packet));
 }
 
 void PacketQueue::queuePacketList(PacketListPointer packetList) {
@@ -89,7 +136,15 @@ void PacketQueue::queuePacketList(PacketListPointer packetList) {
         packetList->preparePackets(getNextMessageNumber());
     }
 
+    auto priority = packetList->getPriority();
+    auto now = p_high_resolution_clock::now();
+    for (auto& packet : packetList->_packets) {
+        packet->setPriority(priority);
+        packet->setQueuedTime(now);
+    }
+
     LockGuard locker(_packetsLock);
-    _channels.emplace_back(new std::list<PacketPointer>());
-    _channels.back()->swap(packetList->_packets);
+    auto& channels = _priorities[(int)priority].channels;
+    channels.emplace_back(new std::list<PacketPointer>());
+    channels.back()->swap(packetList->_packets);
 }
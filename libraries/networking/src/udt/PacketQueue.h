@@ -12,6 +12,7 @@
 #ifndef hifi_PacketQueue_h
 #define hifi_PacketQueue_h
 
+#include <array>
 #include <list>
 #include <vector>
 #include <memory>
@@ -24,7 +25,10 @@ namespace udt {
 class PacketList;
     
 using MessageNumber = uint32_t;
-    
+
+// Packets wait in one channel per packet list, plus a main channel for single packets. The channels are grouped by
+// priority (single packets are urgent), and the priorities share the connection by weight, so that a bulk transfer
+// cannot hold up the small messages behind it.
 class PacketQueue {
     using Mutex = std::recursive_mutex;
     using LockGuard = std::lock_guard<Mutex>;
@@ -45,17 +49,23 @@ public:
     Mutex& getLock() { return _packetsLock; }
 
     MessageNumber getCurrentMessageNumber() const { return _currentMessageNumber; }
+    MessageNumber getNextMessageNumber();
     
 private:
-    MessageNumber getNextMessageNumber();
+    struct PriorityChannels {
+        Channels channels;
+        Channels::iterator currentChannel;
+        unsigned int channelsVisitedCount { 0 };
+        int credits { 0 }; // packets left to take from these channels before the other priorities get their turn
+    };
+
+    bool isEmpty(const PriorityChannels& priorityChannels) const;
+    PacketPointer takePacket(PriorityChannels& priorityChannels);
 
     MessageNumber _currentMessageNumber { 0 };
     
     mutable Mutex _packetsLock; // Protects the packets to be sent.
-    Channels _channels; // One channel per packet list + Main channel
-
-    Channels::iterator _currentChannel;
-    unsigned int _channelsVisitedCount { 0 };
+    std::array<PriorityChannels, Packet::NUM_PRIORITIES> _priorities; // The urgent channels start with the main one
 };
 
 }
@@ -0,0 +1,405 @@
+//
+//  SecureSession.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SecureSession.h"
+
+#include <cstring>
+
+#include <openssl/opensslv.h>
+#include <openssl/crypto.h>
+#include <openssl/evp.h>
+#include <openssl/hmac.h>
+
+using namespace udt;
+
+// X25519 and its raw keys came with OpenSSL 1.1.1
+#if OPENSSL_VERSION_NUMBER >= 0x10101000L
+#define HAS_SECURE_SESSIONS
+#endif
+
+static const uint8_t HANDSHAKE_VERSION = 1;
+
+static const int CONTROL_SIZE = sizeof(ControlPacket::ControlBitAndType);
+static const int COUNTER_SIZE = sizeof(uint64_t);
+static const int TAG_SIZE = 16;
+static const int NONCE_SIZE = 12;
+static_assert(CONTROL_SIZE + COUNTER_SIZE + TAG_SIZE == SECURE_DATAGRAM_OVERHEAD, "SECURE_DATAGRAM_OVERHEAD is wrong");
+
+// control, version, cipher, public key and then a MAC of all that
+static const int PUBLIC_KEY_SIZE = 32;
+static const int PUBLIC_KEY_OFFSET = CONTROL_SIZE + 2 * sizeof(uint8_t);
+static const int MAC_OFFSET = PUBLIC_KEY_OFFSET + PUBLIC_KEY_SIZE;
+static const int MAC_SIZE = 16;
+static const int HANDSHAKE_SIZE = MAC_OFFSET + MAC_SIZE;
+
+static const QByteArray KEY_DERIVATION_SALT = "vircadia udt secure session";
+
+static ControlPacket::ControlBitAndType controlBitAndType(ControlPacket::Type type) {
+    // the same header ControlPacket writes
+    return CONTROL_BIT_MASK | (ControlPacket::ControlBitAndType(type) << (8 * sizeof(ControlPacket::Type)));
+}
+
+bool SecureSession::readSecureType(const char* datagram, qint64 size, ControlPacket::Type& type) {
+    if (size < CONTROL_SIZE) {
+        return false;
+    }
+
+    ControlPacket::ControlBitAndType bitAndType;
+    memcpy(&bitAndType, datagram, sizeof(bitAndType));
+    if (!(bitAndType & CONTROL_BIT_MASK)) {
+        return false;
+    }
+
+    auto packetType = (uint16_t)((bitAndType & ~CONTROL_BIT_MASK) >> (8 * sizeof(ControlPacket::Type)));
+    if (packetType < ControlPacket::SecureHandshakeInit || packetType > ControlPacket::SecureData) {
+        return false;
+    }
+
+    type = (ControlPacket::Type)packetType;
+    return true;
+}
+
+bool SecureSession::isSupported() {
+#ifdef HAS_SECURE_SESSIONS
+    return true;
+#else
+    return false;
+#endif
+}
+
+SecureSession::Cipher SecureSession::getPreferredCipher() {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+    return AES256GCM;
+#else
+    return ChaCha20Poly1305;
+#endif
+}
+
+static bool hmacSHA256(const unsigned char* key, int keySize, const QByteArray& data, unsigned char* hash) {
+    unsigned int hashSize = 0;
+    return HMAC(EVP_sha256(), key, keySize, (const unsigned char*)data.constData(), data.size(), hash, &hashSize)
+        && hashSize == 32;
+}
+
+static bool handshakeMACMatches(const QByteArray& preSharedKey, const char* handshake) {
+    unsigned char mac[EVP_MAX_MD_SIZE];
+    return hmacSHA256((const unsigned char*)preSharedKey.constData(), preSharedKey.size(),
+                      QByteArray::fromRawData(handshake, MAC_OFFSET), mac)
+        && CRYPTO_memcmp(mac, handshake + MAC_OFFSET, MAC_SIZE) == 0;
+}
+
+SecureSession::SecureSession(bool isInitiator) : _isInitiator(isInitiator) {
+}
+
+SecureSession::~SecureSession() {
+#ifdef HAS_SECURE_SESSIONS
+    EVP_PKEY_free(_privateKey);
+    EVP_CIPHER_CTX_free(_sendContext);
+    EVP_CIPHER_CTX_free(_receiveContext);
+#endif
+    OPENSSL_cleanse(_sendKey.data(), _sendKey.size());
+    OPENSSL_cleanse(_receiveKey.data(), _receiveKey.size());
+}
+
+bool SecureSession::generateKey() {
+#ifdef HAS_SECURE_SESSIONS
+    auto context = EVP_PKEY_CTX_new_id(EVP_PKEY_X25519, nullptr);
+    bool success = context && EVP_PKEY_keygen_init(context) == 1 && EVP_PKEY_keygen(context, &_privateKey) == 1;
+    EVP_PKEY_CTX_free(context);
+
+    size_t publicKeySize = _publicKey.size();
+    return success && EVP_PKEY_get_raw_public_key(_privateKey, _publicKey.data(), &publicKeySize) == 1
+        && publicKeySize == _publicKey.size();
+#else
+    return false;
+#endif
+}
+
+static QByteArray createHandshake(ControlPacket::Type type, SecureSession::Cipher cipher, const unsigned char* publicKey) {
+    QByteArray handshake;
+    handshake.reserve(HANDSHAKE_SIZE);
+
+    auto bitAndType = controlBitAndType(type);
+    handshake.append(reinterpret_cast<const char*>(&bitAndType), sizeof(bitAndType));
+    handshake.append((char)HANDSHAKE_VERSION);
+    handshake.append((char)cipher);
+    handshake.append(reinterpret_cast<const char*>(publicKey), PUBLIC_KEY_SIZE);
+    return handshake;
+}
+
+std::shared_ptr<SecureSession> SecureSession::initiate(const QByteArray& preSharedKey) {
+    auto session = std::shared_ptr<SecureSession>(new SecureSession(true));
+    if (!session->generateKey()) {
+        return nullptr;
+    }
+
+    // the MAC proves to the responder that we have the key
+    session->_preSharedKey = preSharedKey;
+    session->_handshake = createHandshake(ControlPacket::SecureHandshakeInit, session->_cipher, session->_publicKey.data());
+    unsigned char mac[EVP_MAX_MD_SIZE];
+    if (!hmacSHA256((const unsigned char*)preSharedKey.constData(), preSharedKey.size(), session->_handshake, mac)) {
+        return nullptr;
+    }
+    session->_handshake.append(reinterpret_cast<const char*>(mac), MAC_SIZE);
+    return session;
+}
+
+std::shared_ptr<SecureSession> SecureSession::respond(const char* init, qint64 size, const QByteArray& preSharedKey) {
+    ControlPacket::Type type;
+    if (size != HANDSHAKE_SIZE || !readSecureType(init, size, type) || type != ControlPacket::SecureHandshakeInit
+        || (uint8_t)init[CONTROL_SIZE] != HANDSHAKE_VERSION || !handshakeMACMatches(preSharedKey, init)) {
+        return nullptr;
+    }
+
+    auto initiatorCipher = (Cipher)init[CONTROL_SIZE + 1];
+    if (initiatorCipher != AES256GCM && initiatorCipher != ChaCha20Poly1305) {
+        return nullptr;
+    }
+
+    auto session = std::shared_ptr<SecureSession>(new SecureSession(false));
+    if (!session->generateKey()) {
+        return nullptr;
+    }
+
+    // AES is only worth it when both sides have the instructions for it
+    session->_cipher = (initiatorCipher == AES256GCM && getPreferredCipher() == AES256GCM) ? AES256GCM : ChaCha20Poly1305;
+    session->_peerInit = QByteArray(init, (int)size);
+
+    Key confirmationKey;
+    if (!session->deriveKeys(reinterpret_cast<const unsigned char*>(init + PUBLIC_KEY_OFFSET), preSharedKey,
+                             session->_peerInit, confirmationKey)) {
+        return nullptr;
+    }
+
+    // the MAC of the whole exchange proves to the initiator that we derived the same keys
+    session->_handshake = createHandshake(ControlPacket::SecureHandshakeResponse, session->_cipher,
+                                          session->_publicKey.data());
+    unsigned char mac[EVP_MAX_MD_SIZE];
+    bool hasMAC = hmacSHA256(confirmationKey.data(), (int)confirmationKey.size(), session->_peerInit + session->_handshake,
+                             mac);
+    OPENSSL_cleanse(confirmationKey.data(), confirmationKey.size());
+    if (!hasMAC || !session->setupContexts()) {
+        return nullptr;
+    }
+    session->_handshake.append(reinterpret_cast<const char*>(mac), MAC_SIZE);
+
+    session->_isEstablished = true;
+    return session;
+}
+
+bool SecureSession::completeHandshake(const char* response, qint64 size) {
+    ControlPacket::Type type;
+    if (!_isInitiator || _isEstablished || size != HANDSHAKE_SIZE || !readSecureType(response, size, type)
+        || type != ControlPacket::SecureHandshakeResponse || (uint8_t)response[CONTROL_SIZE] != HANDSHAKE_VERSION) {
+        return false;
+    }
+
+    auto cipher = (Cipher)response[CONTROL_SIZE + 1];
+    if (cipher != AES256GCM && cipher != ChaCha20Poly1305) {
+        return false;
+    }
+
+    Key confirmationKey;
+    if (!deriveKeys(reinterpret_cast<const unsigned char*>(response + PUBLIC_KEY_OFFSET), _preSharedKey, _handshake,
+                    confirmationKey)) {
+        return false;
+    }
+
+    unsigned char mac[EVP_MAX_MD_SIZE];
+    bool isConfirmed = hmacSHA256(confirmationKey.data(), (int)confirmationKey.size(),
+                                  _handshake + QByteArray::fromRawData(response, MAC_OFFSET), mac)
+        && CRYPTO_memcmp(mac, response + MAC_OFFSET, MAC_SIZE) == 0;
+    OPENSSL_cleanse(confirmationKey.data(), confirmationKey.size());
+
+    _cipher = cipher;
+    if (!isConfirmed || !setupContexts()) {
+        return false;
+    }
+
+    OPENSSL_cleanse(_preSharedKey.data(), _preSharedKey.size());
+    _preSharedKey.clear();
+    _isEstablished = true;
+    return true;
+}
+
+bool SecureSession::deriveKeys(const unsigned char* peerPublicKey, const QByteArray& preSharedKey, const QByteArray& init,
+                               Key& confirmationKey) {
+#ifdef HAS_SECURE_SESSIONS
+    unsigned char sharedSecret[PUBLIC_KEY_SIZE];
+    size_t sharedSecretSize = sizeof(sharedSecret);
+
+    auto peerKey = EVP_PKEY_new_raw_public_key(EVP_PKEY_X25519, nullptr, peerPublicKey, PUBLIC_KEY_SIZE);
+    auto context = peerKey ? EVP_PKEY_CTX_new(_privateKey, nullptr) : nullptr;
+
+    // OpenSSL refuses the peer keys of low order, that an attacker would pick to force the secret
+    bool success = context && EVP_PKEY_derive_init(context) == 1 && EVP_PKEY_derive_set_peer(context, peerKey) == 1
+        && EVP_PKEY_derive(context, sharedSecret, &sharedSecretSize) == 1 && sharedSecretSize == sizeof(sharedSecret);
+    EVP_PKEY_CTX_free(context);
+    EVP_PKEY_free(peerKey);
+
+    // HKDF-SHA256: the secret and the key given for the peer are extracted into one key, expanded into the key for each
+    // direction and the one confirming the handshake, bound to both public keys
+    unsigned char pseudoRandomKey[EVP_MAX_MD_SIZE];
+    QByteArray inputKey = QByteArray(reinterpret_cast<const char*>(sharedSecret), (int)sizeof(sharedSecret)) + preSharedKey;
+    OPENSSL_cleanse(sharedSecret, sizeof(sharedSecret));
+    success = success && hmacSHA256((const unsigned char*)KEY_DERIVATION_SALT.constData(), KEY_DERIVATION_SALT.size(),
+                                    inputKey, pseudoRandomKey);
+    OPENSSL_cleanse(inputKey.data(), inputKey.size());
+
+    auto initiatorPublicKey = init.mid(PUBLIC_KEY_OFFSET, PUBLIC_KEY_SIZE);
+    auto responderPublicKey = _isInitiator
+        ? QByteArray(reinterpret_cast<const char*>(peerPublicKey), PUBLIC_KEY_SIZE)
+        : QByteArray(reinterpret_cast<const char*>(_publicKey.data()), PUBLIC_KEY_SIZE);
+    QByteArray info = initiatorPublicKey + responderPublicKey;
+
+    Key* outputKeys[] = {
+        _isInitiator ? &_sendKey : &_receiveKey, // initiator to responder
+        _isInitiator ? &_receiveKey : &_sendKey, // responder to initiator
+        &confirmationKey
+    };
+
+    QByteArray previousBlock;
+    for (int i = 0; i < 3 && success; ++i) {
+        unsigned char block[EVP_MAX_MD_SIZE];
+        success = hmacSHA256(pseudoRandomKey, 32, previousBlock + info + (char)(i + 1), block);
+        memcpy(outputKeys[i]->data(), block, outputKeys[i]->size());
+        previousBlock = QByteArray(reinterpret_cast<const char*>(block), 32);
+        OPENSSL_cleanse(block, sizeof(block));
+    }
+    OPENSSL_cleanse(pseudoRandomKey, sizeof(pseudoRandomKey));
+    OPENSSL_cleanse(previousBlock.data(), previousBlock.size());
+
+    // the ephemeral key has done its job
+    EVP_PKEY_free(_privateKey);
+    _privateKey = nullptr;
+    return success;
+#else
+    return false;
+#endif
+}
+
+#ifdef HAS_SECURE_SESSIONS
+static const EVP_CIPHER* cipherFor(SecureSession::Cipher cipher) {
+    return cipher == SecureSession::AES256GCM ? EVP_aes_256_gcm() : EVP_chacha20_poly1305();
+}
+#endif
+
+bool SecureSession::setupContexts() {
+#ifdef HAS_SECURE_SESSIONS
+    // the keys are set up once, every datagram only sets its nonce
+    _sendContext = EVP_CIPHER_CTX_new();
+    _receiveContext = EVP_CIPHER_CTX_new();
+    return _sendContext && _receiveContext
+        && EVP_EncryptInit_ex(_sendContext, cipherFor(_cipher), nullptr, _sendKey.data(), nullptr) == 1
+        && EVP_DecryptInit_ex(_receiveContext, cipherFor(_cipher), nullptr, _receiveKey.data(), nullptr) == 1;
+#else
+    return false;
+#endif
+}
+
+bool SecureSession::isResponseTo(const char* init, qint64 size) const {
+    return !_isInitiator && size == _peerInit.size() && memcmp(init, _peerInit.constData(), size) == 0;
+}
+
+bool SecureSession::winsOver(const char* init, qint64 size) const {
+    return size == HANDSHAKE_SIZE && memcmp(_publicKey.data(), init + PUBLIC_KEY_OFFSET, PUBLIC_KEY_SIZE) < 0;
+}
+
+static void nonceFor(uint64_t counter, unsigned char* nonce) {
+    memset(nonce, 0, NONCE_SIZE - COUNTER_SIZE);
+    memcpy(nonce + NONCE_SIZE - COUNTER_SIZE, &counter, COUNTER_SIZE);
+}
+
+qint64 SecureSession::encrypt(const char* datagram, qint64 size, char* envelope) {
+#ifdef HAS_SECURE_SESSIONS
+    if (!_isEstablished) {
+        return -1;
+    }
+
+    auto bitAndType = controlBitAndType(ControlPacket::SecureData);
+    memcpy(envelope, &bitAndType, CONTROL_SIZE);
+
+    std::lock_guard<std::mutex> lock(_sendMutex);
+
+    // counters start at one, zero is never valid
+    auto counter = ++_sendCounter;
+    memcpy(envelope + CONTROL_SIZE, &counter, COUNTER_SIZE);
+
+    unsigned char nonce[NONCE_SIZE];
+    nonceFor(counter, nonce);
+
+    auto header = reinterpret_cast<unsigned char*>(envelope);
+    auto cipherText = header + CONTROL_SIZE + COUNTER_SIZE;
+    int length = 0;
+    int finalLength = 0;
+    if (EVP_EncryptInit_ex(_sendContext, nullptr, nullptr, nullptr, nonce) != 1
+        || EVP_EncryptUpdate(_sendContext, nullptr, &length, header, CONTROL_SIZE + COUNTER_SIZE) != 1
+        || EVP_EncryptUpdate(_sendContext, cipherText, &length, reinterpret_cast<const unsigned char*>(datagram),
+                             (int)size) != 1
+        || EVP_EncryptFinal_ex(_sendContext, cipherText + length, &finalLength) != 1
+        || EVP_CIPHER_CTX_ctrl(_sendContext, EVP_CTRL_AEAD_GET_TAG, TAG_SIZE, cipherText + size) != 1) {
+        return -1;
+    }
+
+    return encryptedSize(size);
+#else
+    return -1;
+#endif
+}
+
+qint64 SecureSession::decrypt(char* envelope, qint64 size) {
+#ifdef HAS_SECURE_SESSIONS
+    if (!_isEstablished || size < SECURE_DATAGRAM_OVERHEAD) {
+        return -1;
+    }
+
+    uint64_t counter;
+    memcpy(&counter, envelope + CONTROL_SIZE, COUNTER_SIZE);
+    if (counter == 0 || counter + REPLAY_WINDOW_SIZE <= _highestReceivedCounter
+        || (counter <= _highestReceivedCounter && _receivedCounters[counter % REPLAY_WINDOW_SIZE])) {
+        return -1;
+    }
+
+    unsigned char nonce[NONCE_SIZE];
+    nonceFor(counter, nonce);
+
+    auto header = reinterpret_cast<unsigned char*>(envelope);
+    auto cipherText = header + CONTROL_SIZE + COUNTER_SIZE;
+    int cipherTextSize = (int)(size - SECURE_DATAGRAM_OVERHEAD);
+    int length = 0;
+    int finalLength = 0;
+    if (EVP_DecryptInit_ex(_receiveContext, nullptr, nullptr, nullptr, nonce) != 1
+        || EVP_CIPHER_CTX_ctrl(_receiveContext, EVP_CTRL_AEAD_SET_TAG, TAG_SIZE, cipherText + cipherTextSize) != 1
+        || EVP_DecryptUpdate(_receiveContext, nullptr, &length, header, CONTROL_SIZE + COUNTER_SIZE) != 1
+        || EVP_DecryptUpdate(_receiveContext, cipherText, &length, cipherText, cipherTextSize) != 1
+        || EVP_DecryptFinal_ex(_receiveContext, cipherText + length, &finalLength) != 1) {
+        return -1;
+    }
+
+    // only an authentic datagram moves the window
+    if (counter > _highestReceivedCounter) {
+        if (counter - _highestReceivedCounter >= REPLAY_WINDOW_SIZE) {
+            _receivedCounters.reset();
+        } else {
+            for (auto skipped = _highestReceivedCounter + 1; skipped < counter; ++skipped) {
+                _receivedCounters.reset(skipped % REPLAY_WINDOW_SIZE);
+            }
+        }
+        _highestReceivedCounter = counter;
+    }
+    _receivedCounters.set(counter % REPLAY_WINDOW_SIZE);
+
+    memmove(envelope, cipherText, cipherTextSize);
+    return cipherTextSize;
+#else
+    return -1;
+#endif
+}
@@ -0,0 +1,148 @@
+//
+//  SecureSession.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SecureSession_h
+#define hifi_SecureSession_h
+
+#include <array>
+#include <atomic>
+#include <bitset>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QByteArray>
+
+#include "Constants.h"
+#include "ControlPacket.h"
+
+typedef struct evp_cipher_ctx_st EVP_CIPHER_CTX;
+typedef struct evp_pkey_st EVP_PKEY;
+
+namespace udt {
+
+/// @addtogroup Networking
+/// @{
+
+/// @brief The keys that encrypt the datagrams exchanged with one peer.
+/// @details The initiator sends its ephemeral X25519 key in a SecureHandshakeInit, the responder answers with its own in
+/// a SecureHandshakeResponse, and both derive a key for each direction from the shared secret and the key they were given
+/// for the peer, if any. Every datagram then goes out as a SecureData packet:
+/// ```
+///                         SecureData Packet Format
+///
+///     0                   1                   2                   3
+///     0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+///    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+///    |C|             |     Type      |             Unused            |
+///    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+///    |                            Counter                            |
+///    |                                                               |
+///    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+///    |                  Encrypted Datagram (variable)                |
+///    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+///    |                        Tag (16 bytes)                         |
+///    +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+///
+///    The counter is the nonce, it is authenticated with the header.
+/// ```
+class SecureSession {
+public:
+    enum Cipher : uint8_t {
+        AES256GCM = 1,
+        ChaCha20Poly1305 = 2
+    };
+
+    // whether the OpenSSL we were built with has everything sessions need
+    static bool isSupported();
+
+    // AES-GCM where there are AES instructions, ChaCha20-Poly1305 everywhere else
+    static Cipher getPreferredCipher();
+
+    // the type of a secure control packet, false for any other datagram
+    static bool readSecureType(const char* datagram, qint64 size, ControlPacket::Type& type);
+
+    // a session that waits for the response to getHandshake()
+    static std::shared_ptr<SecureSession> initiate(const QByteArray& preSharedKey);
+
+    // an established session answering a peer's init, the response to send it is getHandshake(),
+    // nullptr if the init isn't valid or wasn't made with the same key
+    static std::shared_ptr<SecureSession> respond(const char* init, qint64 size, const QByteArray& preSharedKey);
+
+    ~SecureSession();
+
+    // takes the peer's response, the session is established if it could derive the same keys
+    bool completeHandshake(const char* response, qint64 size);
+
+    bool isInitiator() const { return _isInitiator; }
+    bool isEstablished() const { return _isEstablished; }
+    Cipher getCipher() const { return _cipher; }
+
+    // the init this session sent, or the response it answered with
+    const QByteArray& getHandshake() const { return _handshake; }
+
+    // whether the init is the one this session answered, so that a lost response can be sent again
+    bool isResponseTo(const char* init, qint64 size) const;
+
+    // ties two initiators trying at once: the one with the lower key stays the initiator
+    bool winsOver(const char* init, qint64 size) const;
+
+    static qint64 encryptedSize(qint64 size) { return size + SECURE_DATAGRAM_OVERHEAD; }
+
+    // writes the SecureData packet of the datagram into envelope, which has room for encryptedSize(size) bytes,
+    // returns the size written or -1; can be called from any thread
+    qint64 encrypt(const char* datagram, qint64 size, char* envelope);
+
+    // decrypts a SecureData packet in place and moves the datagram to the start of the buffer, returns its size
+    // or -1 if it isn't authentic or was a replay; only ever called from one thread
+    qint64 decrypt(char* envelope, qint64 size);
+
+private:
+    using Key = std::array<unsigned char, 32>;
+
+    SecureSession(bool isInitiator);
+
+    bool generateKey();
+    bool deriveKeys(const unsigned char* peerPublicKey, const QByteArray& preSharedKey, const QByteArray& init,
+                    Key& confirmationKey);
+    bool setupContexts();
+
+    bool _isInitiator;
+    std::atomic<bool> _isEstablished { false };
+    Cipher _cipher { getPreferredCipher() };
+
+    EVP_PKEY* _privateKey { nullptr };
+    Key _publicKey;
+    QByteArray _preSharedKey; // kept by the initiator until the response comes
+    QByteArray _handshake;
+    QByteArray _peerInit; // the init answered by a responder
+
+    Key _sendKey;
+    Key _receiveKey;
+
+    std::mutex _sendMutex;
+    EVP_CIPHER_CTX* _sendContext { nullptr };
+    uint64_t _sendCounter { 0 };
+
+    EVP_CIPHER_CTX* _receiveContext { nullptr };
+
+    // counters of the last datagrams received, a counter can only be accepted once
+    static const int REPLAY_WINDOW_SIZE = 1024;
+    uint64_t _highestReceivedCounter { 0 };
+    std::bitset<REPLAY_WINDOW_SIZE> _receivedCounters;
+};
+
+/// @}
+
+}
+
+#endif // hifi_SecureSession_h
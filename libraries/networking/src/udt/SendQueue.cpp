@@ -14,12 +14,6 @@
 #include "SendQueue.h"
 
 #include <algorithm>
-#include <thread>
-
-#include <QtCore/QCoreApplication>
-#include <QtCore/QDateTime>
-#include <QtCore/QJsonObject>
-#include <QtCore/QThread>
 
 #include <LogHandler.h>
 #include <NumericalConstants.h>
@@ -29,44 +23,24 @@
 #include "ControlPacket.h"
 #include "Packet.h"
 #include "PacketList.h"
-#include "../UserActivityLogger.h"
 #include "Socket.h"
 #include <Trace.h>
 #include <Profile.h>
-#include <ThreadHelpers.h>
-
-#include "../NetworkLogging.h"
 
 using namespace udt;
 using namespace std::chrono;
 
-template <typename Mutex1, typename Mutex2>
-class DoubleLock {
-public:
-    using Lock = std::unique_lock<DoubleLock<Mutex1, Mutex2>>;
-    
-    DoubleLock(Mutex1& mutex1, Mutex2& mutex2) : _mutex1(mutex1), _mutex2(mutex2) { }
-    
-    DoubleLock(const DoubleLock&) = delete;
-    DoubleLock& operator=(const DoubleLock&) = delete;
-    
-    // Either locks all the mutexes or none of them
-    bool try_lock() { return (std::try_lock(_mutex1, _mutex2) == -1); }
-    
-    // Locks all the mutexes
-    void lock() { std::lock(_mutex1, _mutex2); }
-    
-     // Undefined behavior if not locked
-    void unlock() { _mutex1.unlock(); _mutex2.unlock(); }
-    
-private:
-    Mutex1& _mutex1;
-    Mutex2& _mutex2;
-};
-
 const microseconds SendQueue::MAXIMUM_ESTIMATED_TIMEOUT = seconds(5);
 const microseconds SendQueue::MINIMUM_ESTIMATED_TIMEOUT = milliseconds(10);
 
+static const auto HANDSHAKE_RESEND_INTERVAL = milliseconds(100);
+
+// with everything sent and ACKed, the queue is cleaned up after having nothing to send for that long
+static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = seconds(5);
+
+// a queue that is behind on its pacing catches up in bursts this long, before letting other queues be serviced
+static const int MAX_PACKETS_PER_SERVICE = 32;
+
 std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, SockAddr destination, SequenceNumber currentSequenceNumber,
                                              MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK) {
     Q_ASSERT_X(socket, "SendQueue::create", "Must be called with a valid Socket*");
@@ -74,21 +48,8 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, SockAddr destinatio
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination, currentSequenceNumber,
                                                           currentMessageNumber, hasReceivedHandshakeACK));
 
-    // Setup queue private thread
-    QThread* thread = new QThread();
-    QString name = "Networking: SendQueue " + destination.objectName();
-    thread->setObjectName(name); // Name thread for easier debug
-
-    connect(thread, &QThread::started, [name] { setThreadName(name.toStdString()); });
-    connect(thread, &QThread::started, queue.get(), &SendQueue::run);
-
-    connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
-
-    // Move queue to private thread and start it
-    queue->moveToThread(thread);
-
-    thread->start();
+    // the queue has no thread of its own, the scheduler's threads service it when it is due
+    SendQueueScheduler::getInstance().add(queue.get());
 
     return queue;
 }
@@ -108,41 +69,37 @@ SendQueue::SendQueue(Socket* socket, SockAddr dest, SequenceNumber currentSequen
 }
 
 SendQueue::~SendQueue() {
+    SendQueueScheduler::getInstance().remove(this);
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
-    
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+
+    wakeUp();
 }
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
-    
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+
+    wakeUp();
 }
 
 void SendQueue::stop() {
     
     _state = State::Stopped;
-    
-    // Notify all conditions in case we're waiting somewhere
-    _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+
+    // let the scheduler forget about us rather than wait for our timeout
+    wakeUp();
+}
+
+void SendQueue::wakeUp() {
+    SendQueueScheduler::getInstance().wake(this);
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
-    _lastPacketSentAt = std::chrono::high_resolution_clock::now();
+    _lastPacketSentAt = SendQueueScheduler::Clock::now();
+
+    std::lock_guard<std::mutex> destinationLocker(_destinationMutex);
     return _socket->writeDatagram(packet.getData(), packet.getDataSize(), _destination);
 }
     
@@ -169,8 +126,8 @@ void SendQueue::ack(SequenceNumber ack) {
     
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // in case the queue is waiting with a full congestion window
+    wakeUp();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
@@ -179,35 +136,27 @@ void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
         _naks.insert(ack, ack);
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // in case the queue is waiting for losses to re-send
+    wakeUp();
 }
 
 void SendQueue::sendHandshake() {
-    std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
-    if (!_hasReceivedHandshakeACK) {
-        // we haven't received a handshake ACK from the client, send another now
-        // if the handshake hasn't been completed, then the initial sequence number
-        // should be the current sequence number + 1
-        SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
-        
-        // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
-        _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
-    }
+    // we haven't received a handshake ACK from the client, send another now
+    // if the handshake hasn't been completed, then the initial sequence number
+    // should be the current sequence number + 1
+    SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(initialSequenceNumber);
+
+    std::lock_guard<std::mutex> destinationLocker(_destinationMutex);
+    _socket->writeBasePacket(*handshakePacket, _destination);
 }
 
 void SendQueue::handshakeACK() {
-    {
-        std::lock_guard<std::mutex> locker { _handshakeMutex };
-        _hasReceivedHandshakeACK = true;
-    }
+    _hasReceivedHandshakeACK = true;
 
-    // Notify on the handshake ACK condition
-    _handshakeACKCondition.notify_one();
+    // we can start sending right away, instead of at the next handshake re-send
+    wakeUp();
 }
 
 SequenceNumber SendQueue::getNextSequenceNumber() {
@@ -225,7 +174,9 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     
     auto bytesWritten = sendPacket(*newPacket);
 
-    emit packetSent(packetSize, payloadSize, sequenceNumber, p_high_resolution_clock::now());
+    auto now = p_high_resolution_clock::now();
+    int sendLatency = (int)duration_cast<microseconds>(now - newPacket->getQueuedTime()).count();
+    emit packetSent(packetSize, payloadSize, sequenceNumber, now, sendLatency);
 
     {
         // Insert the packet we have just sent in the sent list
@@ -251,113 +202,68 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     }
 }
 
-void SendQueue::run() {
+SendQueueScheduler::TimePoint SendQueue::service(SendQueueScheduler::TimePoint now) {
     if (_state == State::Stopped) {
-        // we've already been asked to stop before we even got a chance to start
-        // don't start now
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run after being told to stop. Will not run.";
-#endif
-        return;
-    } else if (_state == State::Running) {
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run but is already running (according to state). Will not re-run.";
-#endif
-        return;
-    }
-    
-    _state = State::Running;
-    
-    // Wait for handshake to be complete
-    while (_state == State::Running && !_hasReceivedHandshakeACK) {
-        sendHandshake();
-
-        // Keep processing events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
-        // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
+        // we've been asked to stop, possibly before we even got a chance to start
+        return SendQueueScheduler::NEVER;
+    } else if (_state == State::NotStarted) {
+        _state = State::Running;
+        _nextPacketTimestamp = now;
     }
 
-    // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
+    // Wait for handshake to be complete, no packets will be sent until we have the handshake ACK
+    if (!_hasReceivedHandshakeACK) {
+        if (now >= _nextHandshakeTime) {
+            sendHandshake();
 
-    while (_state == State::Running) {
-        bool attemptedToSendPacket = maybeResendPacket();
-        
-        // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
-        // (this is according to the current flow window size) then we send out a new packet
-        auto newPacketCount = 0;
-        if (!attemptedToSendPacket) {
-            newPacketCount = maybeSendNewPacket();
-            attemptedToSendPacket = (newPacketCount > 0);
+            // we're serviced again for the ACK, or once the re-send interval expires
+            _nextHandshakeTime = now + HANDSHAKE_RESEND_INTERVAL;
         }
-        
-        // since we're a while loop, give the thread a chance to process events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // we just processed events so check now if we were just told to stop
-        // If the send queue has been innactive, skip the sleep for
-        // Either _isRunning will have been set to false and we'll break
-        // Or something happened and we'll keep going
-        if (_state != State::Running || isInactive(attemptedToSendPacket)) {
-            return;
+        return _nextHandshakeTime;
+    }
+
+    for (int i = 0; i < MAX_PACKETS_PER_SERVICE; ++i) {
+        if (_packetSendPeriod > 0 && _nextPacketTimestamp > now) {
+            // not our time to send yet
+            return _nextPacketTimestamp;
         }
 
-        if (_packetSendPeriod > 0) {
-            // push the next packet timestamp forwards by the current packet send period
-            auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-            nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
+        bool attemptedToSendPacket = false;
+        {
+            // packet pairs go out to the same destination back to back, flush them with one system call
+            Socket::SendBatch sendBatch(*_socket);
 
-            // sleep as long as we need for next packet send, if we can
-            auto now = p_high_resolution_clock::now();
+            attemptedToSendPacket = maybeResendPacket();
 
-            auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
+            // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
+            // (this is according to the current flow window size) then we send out a new packet
+            if (!attemptedToSendPacket) {
+                attemptedToSendPacket = (maybeSendNewPacket() > 0);
+            }
+        }
 
-            // we use nextPacketTimestamp so that we don't fall behind, not to force long sleeps
-            // we'll never allow nextPacketTimestamp to force us to sleep for more than nextPacketDelta
-            // so cap it to that value
-            if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
-                // reset the nextPacketTimestamp so that it is correct next time we come around
-                nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
+        if (!attemptedToSendPacket) {
+            // we have nothing to send, wake-ups are what tell us otherwise, so there is no time to keep up with
+            _nextPacketTimestamp = now;
+            return idle(now);
+        }
+        _isIdle = false;
 
-                timeToSleep = std::chrono::microseconds(nextPacketDelta);
-            }
+        if (_packetSendPeriod > 0) {
+            // push the next packet timestamp forwards by the current packet send period
+            auto nextPacketDelta = microseconds(_packetSendPeriod);
+            _nextPacketTimestamp += nextPacketDelta;
 
-            // we're seeing SendQueues sleep for a long period of time here,
-            // which can lock the NodeList if it's attempting to clear connections
-            // for now we guard this by capping the time this thread and sleep for
-
-            const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-            if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-                qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
-                qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
-                << "NOW:" << now.time_since_epoch().count();
-
-                // alright, we're in a weird state
-                // we want to know why this is happening so we can implement a better fix than this guard
-                // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
-                static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
-
-                // setup a json object with the details we want
-                QJsonObject longSleepObject;
-                longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
-                longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-                longSleepObject["nextPacketDelta"] = nextPacketDelta;
-                longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
-                longSleepObject["then"] = qint64(now.time_since_epoch().count());
-
-                // hopefully send this event using the user activity logger
-                UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-                
-                timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
+            // we use _nextPacketTimestamp so that we don't fall behind, not to force long waits
+            // we'll never allow it to make us wait for more than nextPacketDelta, so cap it to that value
+            if (_nextPacketTimestamp - now > nextPacketDelta) {
+                _nextPacketTimestamp = now + nextPacketDelta;
             }
-            
-            std::this_thread::sleep_for(timeToSleep);
         }
     }
+
+    // we're still behind, have other queues serviced before we catch up some more
+    return now;
 }
 
 int SendQueue::maybeSendNewPacket() {
@@ -414,6 +320,7 @@ bool SendQueue::maybeResendPacket() {
                 auto wireSize = resendPacket.getWireSize();
                 auto payloadSize = resendPacket.getPayloadSize();
                 auto sequenceNumber = it->first;
+                auto priority = resendPacket.getPriority();
 
                 if (level != Packet::NoObfuscation) {
 #ifdef UDT_CONNECTION_DEBUG
@@ -449,7 +356,7 @@ bool SendQueue::maybeResendPacket() {
                 }
                 
                 emit packetRetransmitted(wireSize, payloadSize, sequenceNumber,
-                                         p_high_resolution_clock::now());
+                                         p_high_resolution_clock::now(), priority);
                 
                 // Signal that we did resend a packet
                 return true;
@@ -468,88 +375,64 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
-    // check for connection timeout first
+SendQueueScheduler::TimePoint SendQueue::idle(SendQueueScheduler::TimePoint now) {
+    std::unique_lock<std::mutex> naksLocker(_naksLock);
 
-    if (!attemptedToSendPacket) {
-        // During our processing above we didn't send any packets
-        
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
-        using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
-        DoubleLock doubleLock(_packets.getLock(), _naksLock);
-        DoubleLock::Lock locker(doubleLock, std::try_to_lock);
-        
-        if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-            // The packets queue and loss list mutexes are now both locked and they're both empty
-            
-            if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
-                // we've sent the client as much data as we have (and they've ACKed it)
-                // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
+    if (!((_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty())) {
+        // something was queued, ACKed or lost since we tried to send
+        return now;
+    }
+
+    if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        if (!_isIdle) {
+            _isIdle = true;
+            _idleSince = now;
+        }
+
+        if (now - _idleSince < EMPTY_QUEUES_INACTIVE_TIMEOUT) {
+            return _idleSince + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+        }
 
 #ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
+        qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
+            << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
+            << "seconds and receiver has ACKed all packets."
+            << "The queue is now inactive and will be stopped.";
 #endif
 
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
+        naksLocker.unlock();
 
-            } else {
-                // We think the client is still waiting for data (based on the sequence number gap)
-                // Let's wait either for a response from the client or until the estimated timeout
-                // (plus the sync interval to allow the client to respond) has elapsed
-
-                auto estimatedTimeout = std::chrono::microseconds(_estimatedTimeout);
-
-                // Clamp timeout beween 10 ms and 5 s
-                estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
-
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, estimatedTimeout);
-
-                // when we wake-up check if we're "stuck" either if we've slept for the estimated timeout
-                // or it has been that long since the last time we sent a packet
-
-                // we are stuck if all of the following are true
-                // - there are no new packets to send or the flow window is full and we can't send any new packets
-                // - there are no packets to resend
-                // - the client has yet to ACK some sent packets
-                auto now = std::chrono::high_resolution_clock::now();
-
-                if ((cvStatus == std::cv_status::timeout || (now - _lastPacketSentAt > estimatedTimeout))
-                    && (_packets.isEmpty() || isFlowWindowFull())
-                    && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
-            }
-        }
+        // Deactivate queue
+        deactivate();
+        return SendQueueScheduler::NEVER;
     }
-    
-    return false;
+
+    // We think the client is still waiting for data (based on the sequence number gap)
+    // Let's wait either for a response from the client or until the estimated timeout
+    // (plus the sync interval to allow the client to respond) has elapsed
+    _isIdle = false;
+
+    auto estimatedTimeout = microseconds(_estimatedTimeout);
+
+    // Clamp timeout beween 10 ms and 5 s
+    estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
+
+    if (now - _lastPacketSentAt < estimatedTimeout) {
+        // an ACK or a NAK wakes us up before then if the client responds
+        return _lastPacketSentAt + estimatedTimeout;
+    }
+
+    // we are stuck: there is nothing we can send, nothing to resend, and the client has yet to ACK some sent packets
+    // add them to the loss list
+    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+    naksLocker.unlock();
+
+    emit timeout();
+
+    // resend them right away
+    return now;
 }
 
 void SendQueue::deactivate() {
@@ -564,5 +447,6 @@ bool SendQueue::isFlowWindowFull() const {
 }
 
 void SendQueue::updateDestinationAddress(SockAddr newAddress) {
+    std::lock_guard<std::mutex> destinationLocker(_destinationMutex);
     _destination = newAddress;
 }
@@ -15,7 +15,6 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -32,6 +31,7 @@
 #include "Constants.h"
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
+#include "SendQueueScheduler.h"
 #include "LossList.h"
 
 namespace udt {
@@ -63,6 +63,8 @@ public:
 
     SequenceNumber getCurrentSequenceNumber() const { return SequenceNumber(_atomicCurrentSequenceNumber); }
     MessageNumber getCurrentMessageNumber() const { return _packets.getCurrentMessageNumber(); }
+    // for a message that is sent without being queued as a packet list, called from the socket's thread
+    MessageNumber getNextMessageNumber() { return _packets.getNextMessageNumber(); }
     
     void setFlowWindowSize(int flowWindowSize) { _flowWindowSize = flowWindowSize; }
     
@@ -70,6 +72,9 @@ public:
     void setPacketSendPeriod(int newPeriod) { _packetSendPeriod = newPeriod; }
     
     void setEstimatedTimeout(int estimatedTimeout) { _estimatedTimeout = estimatedTimeout; }
+
+    // sends what is due at now, called by the SendQueueScheduler which services the queue again at the returned time
+    SendQueueScheduler::TimePoint service(SendQueueScheduler::TimePoint now);
     
 public slots:
     void stop();
@@ -80,22 +85,22 @@ public slots:
     void updateDestinationAddress(SockAddr newAddress);
 
 signals:
-    void packetSent(int wireSize, int payloadSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint);
-    void packetRetransmitted(int wireSize, int payloadSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint);
+    void packetSent(int wireSize, int payloadSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint,
+                    int sendLatency);
+    void packetRetransmitted(int wireSize, int payloadSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint,
+                             Packet::Priority priority);
     
     void queueInactive();
 
     void timeout();
     
-private slots:
-    void run();
-    
 private:
     Q_DISABLE_COPY_MOVE(SendQueue)
     SendQueue(Socket* socket, SockAddr dest, SequenceNumber currentSequenceNumber,
               MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK);
     
     void sendHandshake();
+    void wakeUp(); // has the scheduler service the queue, something could have changed what it can send
     
     int sendPacket(const Packet& packet);
     bool sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket, SequenceNumber sequenceNumber);
@@ -103,7 +108,7 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    SendQueueScheduler::TimePoint idle(SendQueueScheduler::TimePoint now); // when there is nothing to send, or not yet
     void deactivate(); // makes the queue inactive and cleans it up
 
     bool isFlowWindowFull() const;
@@ -114,6 +119,8 @@ private:
     PacketQueue _packets;
     
     Socket* _socket { nullptr }; // Socket to send packet on
+
+    std::mutex _destinationMutex; // Protects the destination, which may change while we're sending
     SockAddr _destination; // Destination addr
     
     std::atomic<uint32_t> _lastACKSequenceNumber { 0 }; // Last ACKed sequence number
@@ -135,13 +142,14 @@ private:
     using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
     std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
     
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
 
-    std::chrono::high_resolution_clock::time_point _lastPacketSentAt;
+    // only used while servicing, which the scheduler never does from two threads at once
+    SendQueueScheduler::TimePoint _nextHandshakeTime; // when to re-send the handshake if there's still no ACK
+    SendQueueScheduler::TimePoint _nextPacketTimestamp; // when the next packet should go out, to not fall behind
+    SendQueueScheduler::TimePoint _lastPacketSentAt;
+    SendQueueScheduler::TimePoint _idleSince; // when there was last nothing to send with everything ACKed
+    bool _isIdle { false };
 
     static const std::chrono::microseconds MAXIMUM_ESTIMATED_TIMEOUT;
     static const std::chrono::microseconds MINIMUM_ESTIMATED_TIMEOUT;
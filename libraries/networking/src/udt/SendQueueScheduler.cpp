@@ -0,0 +1,234 @@
+//
+//  SendQueueScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueScheduler.h"
+
+#include <algorithm>
+
+#include <ThreadHelpers.h>
+
+#include "SendQueue.h"
+
+using namespace udt;
+using namespace std::chrono;
+
+const SendQueueScheduler::TimePoint SendQueueScheduler::NEVER = SendQueueScheduler::TimePoint::max();
+const microseconds SendQueueScheduler::TICK = microseconds(250);
+
+// sending is mostly system calls, a couple of threads keep up with hundreds of connections
+static const unsigned int MAX_SCHEDULER_THREADS = 4;
+
+SendQueueScheduler& SendQueueScheduler::getInstance() {
+    static SendQueueScheduler instance;
+    return instance;
+}
+
+SendQueueScheduler::SendQueueScheduler() : _epoch(Clock::now()) {
+    auto numThreads = std::max(1u, std::min(MAX_SCHEDULER_THREADS, std::thread::hardware_concurrency() / 2));
+    for (unsigned int i = 0; i < numThreads; ++i) {
+        _threads.emplace_back([this, i] {
+            setThreadName("Networking: SendQueue " + std::to_string(i));
+            run();
+        });
+    }
+}
+
+SendQueueScheduler::~SendQueueScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+    }
+    _condition.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void SendQueueScheduler::add(SendQueue* queue) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto& entry = _entries[queue];
+        makeReady(queue, entry);
+    }
+    _condition.notify_one();
+}
+
+void SendQueueScheduler::wake(SendQueue* queue) {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _entries.find(queue);
+        if (it == _entries.end()) {
+            return;
+        }
+
+        auto& entry = it->second;
+        if (entry.location == Entry::Servicing) {
+            // the queue may have already decided what to wait for, have it serviced again right after
+            entry.wasWokenWhileServicing = true;
+            return;
+        } else if (entry.location == Entry::Ready) {
+            return;
+        }
+
+        unlink(entry);
+        makeReady(queue, entry);
+    }
+    _condition.notify_one();
+}
+
+void SendQueueScheduler::remove(SendQueue* queue) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    auto it = _entries.find(queue);
+    if (it == _entries.end()) {
+        return;
+    }
+
+    if (it->second.location == Entry::Servicing) {
+        // the servicing thread erases the entry when it is done with the queue
+        it->second.wasRemovedWhileServicing = true;
+        _servicedCondition.wait(lock, [this, queue] { return _entries.find(queue) == _entries.end(); });
+    } else {
+        unlink(it->second);
+        _entries.erase(it);
+    }
+}
+
+void SendQueueScheduler::run() {
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_isStopping) {
+        advance(Clock::now());
+
+        if (_readyQueues.empty()) {
+            int64_t dueTick;
+            if (findNextDueTick(dueTick)) {
+                _condition.wait_until(lock, timeForTick(dueTick));
+            } else {
+                _condition.wait(lock);
+            }
+            continue;
+        }
+
+        SendQueue* queue = _readyQueues.front();
+        _readyQueues.pop_front();
+
+        // the entry stays where it is while servicing: remove() waits for us instead of erasing it
+        auto& entry = _entries[queue];
+        entry.location = Entry::Servicing;
+        entry.wasWokenWhileServicing = false;
+
+        lock.unlock();
+        auto dueTime = queue->service(Clock::now());
+        lock.lock();
+
+        if (entry.wasRemovedWhileServicing) {
+            _entries.erase(queue);
+            _servicedCondition.notify_all();
+        } else if (entry.wasWokenWhileServicing) {
+            makeReady(queue, entry);
+        } else {
+            schedule(queue, entry, dueTime);
+        }
+    }
+}
+
+int64_t SendQueueScheduler::tickForTime(TimePoint time) const {
+    auto sinceEpoch = duration_cast<microseconds>(time - _epoch);
+    return (sinceEpoch.count() + TICK.count() - 1) / TICK.count();
+}
+
+SendQueueScheduler::TimePoint SendQueueScheduler::timeForTick(int64_t tick) const {
+    return _epoch + tick * TICK;
+}
+
+void SendQueueScheduler::makeReady(SendQueue* queue, Entry& entry) {
+    _readyQueues.push_back(queue);
+    entry.location = Entry::Ready;
+    entry.position = std::prev(_readyQueues.end());
+}
+
+void SendQueueScheduler::schedule(SendQueue* queue, Entry& entry, TimePoint dueTime) {
+    if (dueTime == NEVER) {
+        entry.location = Entry::Waiting;
+        return;
+    }
+
+    auto dueTick = tickForTime(dueTime);
+    if (dueTick <= _currentTick) {
+        // already due
+        makeReady(queue, entry);
+        return;
+    }
+
+    // only the servicing threads schedule, and they look for the next due tick before they wait again,
+    // so there is nobody to notify
+    auto& slot = _slots[dueTick % NUM_SLOTS];
+    slot.push_back(queue);
+    entry.location = Entry::InSlot;
+    entry.position = std::prev(slot.end());
+    entry.dueTick = dueTick;
+    ++_numInSlots;
+}
+
+void SendQueueScheduler::unlink(Entry& entry) {
+    if (entry.location == Entry::InSlot) {
+        _slots[entry.dueTick % NUM_SLOTS].erase(entry.position);
+        --_numInSlots;
+    } else if (entry.location == Entry::Ready) {
+        _readyQueues.erase(entry.position);
+    }
+    entry.location = Entry::Waiting;
+}
+
+void SendQueueScheduler::advance(TimePoint now) {
+    // only ticks that are over have their queues due
+    auto nowTick = tickForTime(now) - 1;
+    if (nowTick <= _currentTick) {
+        return;
+    }
+
+    // after a long enough pause every slot has to be looked at, but only once
+    auto firstTick = std::max(_currentTick + 1, nowTick - NUM_SLOTS + 1);
+    for (auto tick = firstTick; tick <= nowTick && _numInSlots > 0; ++tick) {
+        auto& slot = _slots[tick % NUM_SLOTS];
+        for (auto it = slot.begin(); it != slot.end();) {
+            auto& entry = _entries[*it];
+            if (entry.dueTick <= nowTick) {
+                // due, and not just in this slot for a later turn of the wheel
+                auto queue = *it;
+                it = slot.erase(it);
+                --_numInSlots;
+                makeReady(queue, entry);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    _currentTick = nowTick;
+}
+
+bool SendQueueScheduler::findNextDueTick(int64_t& dueTick) const {
+    if (_numInSlots == 0) {
+        return false;
+    }
+
+    // the first slot with queues is usually close, but its queues may be due on a later turn of the wheel
+    for (auto tick = _currentTick + 1; tick <= _currentTick + NUM_SLOTS; ++tick) {
+        const auto& slot = _slots[tick % NUM_SLOTS];
+        if (!slot.empty()) {
+            dueTick = tick;
+            return true;
+        }
+    }
+    return false;
+}
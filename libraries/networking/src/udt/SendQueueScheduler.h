@@ -0,0 +1,99 @@
+//
+//  SendQueueScheduler.h
+//  libraries/networking/src/udt
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_SendQueueScheduler_h
+#define hifi_SendQueueScheduler_h
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace udt {
+
+class SendQueue;
+
+/// Runs every SendQueue of the process on a few shared threads, instead of a sleeping thread for each
+///
+/// A queue is serviced when it is due: it sends what its pacing allows and says when it is next due - the next paced
+/// send, a handshake re-send, or its timeout. Queues wait for that in a timer wheel, and anything that could let a
+/// queue send earlier (new packets, an ACK, a loss) wakes it up.
+class SendQueueScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
+
+    // what SendQueue::service returns when the queue will only have something to do once woken up
+    static const TimePoint NEVER;
+
+    static SendQueueScheduler& getInstance();
+
+    ~SendQueueScheduler();
+
+    void add(SendQueue* queue); // services the queue as soon as possible
+    void wake(SendQueue* queue); // services the queue as soon as possible, if it was waiting
+    void remove(SendQueue* queue); // returns once the queue is not being serviced, it won't be again
+
+private:
+    // the wheel covers about a second ahead in quarter milliseconds, queues due later wait for more turns of it
+    static const std::chrono::microseconds TICK;
+    static const int NUM_SLOTS = 4096;
+
+    using Queues = std::list<SendQueue*>;
+
+    struct Entry {
+        enum Location { Waiting, InSlot, Ready, Servicing };
+
+        Location location { Waiting };
+        Queues::iterator position;
+        int64_t dueTick { 0 };
+        bool wasWokenWhileServicing { false };
+        bool wasRemovedWhileServicing { false };
+    };
+
+    SendQueueScheduler();
+
+    void run();
+
+    int64_t tickForTime(TimePoint time) const; // rounded up, so a queue is never serviced before it is due
+    TimePoint timeForTick(int64_t tick) const;
+
+    void makeReady(SendQueue* queue, Entry& entry);
+    void schedule(SendQueue* queue, Entry& entry, TimePoint dueTime);
+    void unlink(Entry& entry);
+    void advance(TimePoint now);
+    bool findNextDueTick(int64_t& dueTick) const;
+
+    std::mutex _mutex;
+    std::condition_variable _condition; // signaled when there are queues ready
+    std::condition_variable _servicedCondition; // signaled when a queue removed while serviced is done
+
+    std::unordered_map<SendQueue*, Entry> _entries;
+    std::array<Queues, NUM_SLOTS> _slots;
+    Queues _readyQueues;
+    int _numInSlots { 0 };
+
+    TimePoint _epoch;
+    int64_t _currentTick { 0 }; // the last tick whose slot was processed
+
+    bool _isStopping { false };
+    std::vector<std::thread> _threads;
+};
+
+}
+
+#endif // hifi_SendQueueScheduler_h
@@ -17,10 +17,16 @@
 #include <sys/socket.h>
 #endif
 
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+#include <QtCore/QProcessEnvironment>
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
 #include <LogHandler.h>
+#include <MemoryAccounting.h>
 
 #include "../NetworkLogging.h"
 #include "Connection.h"
@@ -40,11 +46,61 @@ using namespace udt;
 #include <netinet/in.h>
 #endif
 
+namespace {
+    // the datagrams collected by the SendBatch alive on this thread
+    struct ThreadSendBatch {
+        Socket* socket { nullptr };
+        int depth { 0 };
+        std::vector<char> data;
+        std::vector<NetworkSocket::OutgoingDatagram> datagrams;
+    };
+    thread_local ThreadSendBatch threadSendBatch;
+
+    // where the SecureData packets written outside of a SendBatch are put together
+    thread_local std::vector<char> threadEnvelope;
+}
+
+// an init is sent again until it is answered, a few times, before the peer is left alone for a while
+static const auto SECURE_HANDSHAKE_INTERVAL = std::chrono::milliseconds(250);
+static const int MAX_SECURE_HANDSHAKES = 8;
+static const auto SECURE_HANDSHAKE_RETRY_DELAY = std::chrono::seconds(5);
+
+// datagrams that wait for a session when encryption is required
+static const size_t MAX_PENDING_SECURE_DATAGRAMS = 128;
+
+// sessions of peers we stop hearing from are dropped, they start a new one if they come back
+static const auto SECURE_SESSION_TIMEOUT = std::chrono::seconds(60);
+static const int SECURE_SESSION_CHECK_MSECS = 10 * 1000;
+
+// the sockets that can share the UDP port, and how soon a receive thread notices it should stop
+static const int MAX_RECEIVE_THREADS = 16;
+static const int RECEIVE_THREAD_POLL_MSECS = 100;
+
+// how long a small reliable packet waits for others to share its datagram with
+static const int COALESCED_PACKETS_WINDOW_MSECS = 2;
+
+Socket::SendBatch::SendBatch(Socket& socket) : _socket(socket) {
+    // batches nest, but only for one socket per thread
+    if (!threadSendBatch.socket || threadSendBatch.socket == &socket) {
+        threadSendBatch.socket = &socket;
+        ++threadSendBatch.depth;
+        _isActive = true;
+    }
+}
+
+Socket::SendBatch::~SendBatch() {
+    if (_isActive && --threadSendBatch.depth == 0) {
+        _socket.flushSendBatch();
+        threadSendBatch.socket = nullptr;
+    }
+}
 
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
     _networkSocket(parent),
     _readyReadBackupTimer(new QTimer(this)),
+    _secureSessionTimer(new QTimer(this)),
+    _coalescedPacketsTimer(new QTimer(this)),
     _shouldChangeSocketOptions(shouldChangeSocketOptions)
 {
     connect(&_networkSocket, &NetworkSocket::readyRead, this, &Socket::readPendingDatagrams);
@@ -57,11 +113,66 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     const int READY_READ_BACKUP_CHECK_MSECS = 2 * 1000;
     connect(_readyReadBackupTimer, &QTimer::timeout, this, &Socket::checkForReadyReadBackup);
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
+
+    // connections use TCP Vegas unless the environment picks another congestion control for every socket
+    static const QString CONGESTION_CONTROL_ENV = "VIRCADIA_UDT_CONGESTION_CONTROL";
+    auto congestionControlName = QProcessEnvironment::systemEnvironment().value(CONGESTION_CONTROL_ENV);
+    if (!congestionControlName.isEmpty()) {
+        auto ccFactory = createCongestionControlFactory(congestionControlName);
+        if (ccFactory) {
+            setCongestionControlFactory(std::move(ccFactory));
+        } else {
+            qCWarning(networking) << "Unknown congestion control" << congestionControlName << "in" << CONGESTION_CONTROL_ENV
+                << "- using the default";
+        }
+    }
+
+    // datagrams are only encrypted when the environment asks for it
+    static const QString ENCRYPTION_ENV = "VIRCADIA_UDT_ENCRYPTION";
+    auto encryptionModeName = QProcessEnvironment::systemEnvironment().value(ENCRYPTION_ENV).toLower();
+    if (encryptionModeName == "preferred") {
+        setEncryptionMode(EncryptionMode::Preferred);
+    } else if (encryptionModeName == "required") {
+        setEncryptionMode(EncryptionMode::Required);
+    } else if (!encryptionModeName.isEmpty() && encryptionModeName != "disabled") {
+        qCWarning(networking) << "Unknown encryption mode" << encryptionModeName << "in" << ENCRYPTION_ENV
+            << "- encryption is disabled";
+    }
+
+    connect(_secureSessionTimer, &QTimer::timeout, this, &Socket::pruneSecureSessions);
+    _secureSessionTimer->start(SECURE_SESSION_CHECK_MSECS);
+
+    _coalescedPacketsTimer->setSingleShot(true);
+    _coalescedPacketsTimer->setTimerType(Qt::PreciseTimer);
+    _coalescedPacketsTimer->setInterval(COALESCED_PACKETS_WINDOW_MSECS);
+    connect(_coalescedPacketsTimer, &QTimer::timeout, this, &Socket::flushCoalescedPackets);
+}
+
+Socket::~Socket() {
+    stopReceiveThreads();
+}
+
+void Socket::setEncryptionMode(EncryptionMode mode) {
+    if (mode != EncryptionMode::Disabled && !SecureSession::isSupported()) {
+        qCWarning(networking) << "Cannot encrypt datagrams, this build's OpenSSL is too old - encryption is disabled";
+        return;
+    }
+
+    _encryptionMode = mode;
 }
 
 void Socket::bind(SocketType socketType, const QHostAddress& address, quint16 port) {
+    if (socketType == SocketType::UDP) {
+        stopReceiveThreads();
+        _networkSocket.setReusePortGroupSize(_numReceiveThreads);
+    }
+
     _networkSocket.bind(socketType, address, port);
 
+    if (socketType == SocketType::UDP) {
+        startReceiveThreads();
+    }
+
     if (_shouldChangeSocketOptions) {
         setSystemBufferSizes(socketType);
         if (socketType == SocketType::WebRTC) {
@@ -88,6 +199,10 @@ void Socket::rebind(SocketType socketType) {
 }
 
 void Socket::rebind(SocketType socketType, quint16 localPort) {
+    if (socketType == SocketType::UDP) {
+        // the receive threads read the sibling sockets the abort closes
+        stopReceiveThreads();
+    }
     _networkSocket.abort(socketType);
     bind(socketType, QHostAddress::AnyIPv4, localPort);
 }
@@ -249,9 +364,307 @@ qint64 Socket::writeDatagram(const char* data, qint64 size, const SockAddr& sock
     return writeDatagram(QByteArray::fromRawData(data, size), sockAddr);
 }
 
+bool Socket::queueBatchedDatagram(const char* data, qint64 size, const SockAddr& sockAddr, SecureSession* session) {
+    if (threadSendBatch.socket != this || sockAddr.getType() != SocketType::UDP) {
+        return false;
+    }
+
+    auto& batch = threadSendBatch;
+    NetworkSocket::OutgoingDatagram datagram;
+    datagram.offset = batch.data.size();
+    datagram.size = session ? SecureSession::encryptedSize(size) : size;
+    datagram.sockAddr = sockAddr;
+
+    // a session encrypts straight into the batch
+    batch.data.resize(datagram.offset + datagram.size);
+    if (!session) {
+        memcpy(batch.data.data() + datagram.offset, data, size);
+    } else if (session->encrypt(data, size, batch.data.data() + datagram.offset) < 0) {
+        batch.data.resize(datagram.offset);
+        return true;
+    }
+    batch.datagrams.push_back(datagram);
+
+    if ((int)batch.datagrams.size() >= NetworkSocket::MAX_DATAGRAM_BATCH_SIZE) {
+        flushSendBatch();
+    }
+    return true;
+}
+
+void Socket::flushSendBatch() {
+    auto& batch = threadSendBatch;
+    if (batch.datagrams.empty()) {
+        return;
+    }
+
+    if (_networkSocket.state(SocketType::UDP) == QAbstractSocket::BoundState) {
+        int numSent = _networkSocket.writeDatagrams(batch.data.data(), batch.datagrams);
+        if (numSent < (int)batch.datagrams.size()) {
+            HIFI_FCDEBUG(networking(), "udt::Socket::flushSendBatch sent" << numSent << "of"
+                         << batch.datagrams.size() << "datagrams");
+        }
+    } else {
+        qCDebug(networking) << "Attempt to flush" << batch.datagrams.size() << "datagrams when in unbound state";
+    }
+
+    // keep the capacity around for the next batch
+    batch.data.clear();
+    batch.datagrams.clear();
+}
+
 qint64 Socket::writeDatagram(const QByteArray& datagram, const SockAddr& sockAddr) {
+    if (_outboundDatagramSink) {
+        _outboundDatagramSink(datagram.constData(), datagram.size(), sockAddr);
+        return datagram.size();
+    }
+
+    if (_encryptionMode != EncryptionMode::Disabled && sockAddr.getType() == SocketType::UDP) {
+        bool isHeld = false;
+        auto session = findSecureSession(sockAddr, datagram, isHeld);
+        if (isHeld) {
+            return datagram.size();
+        } else if (session) {
+            return writeEncryptedDatagram(*session, datagram.constData(), datagram.size(), sockAddr);
+        }
+    }
+
+    return writeRawDatagram(datagram, sockAddr);
+}
+
+qint64 Socket::writeEncryptedDatagram(SecureSession& session, const char* data, qint64 size, const SockAddr& sockAddr) {
+    if (queueBatchedDatagram(data, size, sockAddr, &session)) {
+        return size;
+    }
+
+    threadEnvelope.resize(SecureSession::encryptedSize(size));
+    auto envelopeSize = session.encrypt(data, size, threadEnvelope.data());
+    if (envelopeSize < 0) {
+        return -1;
+    }
+
+    auto bytesWritten = writeRawDatagram(QByteArray::fromRawData(threadEnvelope.data(), (int)envelopeSize), sockAddr);
+    return bytesWritten < 0 ? bytesWritten : size;
+}
+
+std::shared_ptr<SecureSession> Socket::findSecureSession(const SockAddr& sockAddr, const QByteArray& datagram,
+                                                         bool& isHeld) {
+    auto now = p_high_resolution_clock::now();
+    bool shouldInitiate = false;
+    {
+        Lock securePeersLock(_securePeersMutex);
+        auto it = _securePeers.find(sockAddr);
+        if (it == _securePeers.end()) {
+            shouldInitiate = true;
+        } else if (it->second.session && it->second.session->isEstablished()) {
+            return it->second.session;
+        } else {
+            shouldInitiate = !it->second.session && now >= it->second.retryTime;
+        }
+    }
+
+    // the operators look up nodes, they are called without holding our lock
+    std::shared_ptr<SecureSession> newSession;
+    if (shouldInitiate && (!_connectionCreationFilterOperator || _connectionCreationFilterOperator(sockAddr))) {
+        newSession = SecureSession::initiate(_preSharedKeyOperator ? _preSharedKeyOperator(sockAddr) : QByteArray());
+    }
+
+    QByteArray handshake;
+    {
+        Lock securePeersLock(_securePeersMutex);
+        auto it = _securePeers.find(sockAddr);
+        if (newSession && (it == _securePeers.end() || (!it->second.session && now >= it->second.retryTime))) {
+            auto& peer = _securePeers[sockAddr];
+            peer.session = newSession;
+            peer.numHandshakesSent = 0;
+            peer.lastReceiveTime = now;
+            it = _securePeers.find(sockAddr);
+        }
+
+        if (it == _securePeers.end()) {
+            // not a peer we encrypt for
+            return nullptr;
+        }
+
+        auto& peer = it->second;
+        if (peer.session && peer.session->isEstablished()) {
+            return peer.session;
+        }
+
+        if (peer.session && now - peer.lastHandshakeTime >= SECURE_HANDSHAKE_INTERVAL) {
+            if (peer.numHandshakesSent < MAX_SECURE_HANDSHAKES) {
+                handshake = peer.session->getHandshake();
+                peer.lastHandshakeTime = now;
+                ++peer.numHandshakesSent;
+            } else {
+                qCDebug(networking) << "Secure session handshake with" << sockAddr << "went unanswered";
+                peer.session.reset();
+                peer.pendingDatagrams.clear();
+                peer.retryTime = now + SECURE_HANDSHAKE_RETRY_DELAY;
+            }
+        }
+
+        if (_encryptionMode == EncryptionMode::Required) {
+            // the datagram waits for the handshake, or is dropped while there can't be one
+            if (peer.session && !datagram.isEmpty()) {
+                if (peer.pendingDatagrams.size() >= MAX_PENDING_SECURE_DATAGRAMS) {
+                    peer.pendingDatagrams.pop_front();
+                }
+                peer.pendingDatagrams.emplace_back(datagram.constData(), datagram.size());
+            }
+            isHeld = true;
+        }
+    }
+
+    if (!handshake.isEmpty()) {
+        writeRawDatagram(handshake, sockAddr);
+    }
+    return nullptr;
+}
+
+void Socket::processSecureHandshake(const char* data, qint64 size, ControlPacket::Type type,
+                                    const SockAddr& senderSockAddr) {
+    if (_encryptionMode == EncryptionMode::Disabled) {
+        // we don't answer, the peer gives up on the session
+        return;
+    }
+
+    std::shared_ptr<SecureSession> currentSession;
+    {
+        Lock securePeersLock(_securePeersMutex);
+        auto it = _securePeers.find(senderSockAddr);
+        if (it != _securePeers.end()) {
+            currentSession = it->second.session;
+        }
+    }
+
+    std::shared_ptr<SecureSession> session;
+    if (type == ControlPacket::SecureHandshakeInit) {
+        if (currentSession && currentSession->isResponseTo(data, size)) {
+            // our response was lost
+            writeRawDatagram(currentSession->getHandshake(), senderSockAddr);
+            return;
+        } else if (currentSession && currentSession->isInitiator() && !currentSession->isEstablished()
+                   && currentSession->winsOver(data, size)) {
+            // we both started a session, the peer answers ours
+            return;
+        }
+
+        // a new init replaces whatever session we had, the peer may have restarted
+        session = SecureSession::respond(data, size,
+                                         _preSharedKeyOperator ? _preSharedKeyOperator(senderSockAddr) : QByteArray());
+        if (!session) {
+            HIFI_FCDEBUG(networking(), "Dropping invalid secure session init from" << senderSockAddr);
+            return;
+        }
+        writeRawDatagram(session->getHandshake(), senderSockAddr);
+    } else if (type == ControlPacket::SecureHandshakeResponse) {
+        if (!currentSession || !currentSession->isInitiator() || currentSession->isEstablished()
+            || !currentSession->completeHandshake(data, size)) {
+            HIFI_FCDEBUG(networking(), "Dropping unexpected secure session response from" << senderSockAddr);
+            return;
+        }
+        session = currentSession;
+    } else {
+        return;
+    }
+
+    std::deque<QByteArray> pendingDatagrams;
+    {
+        Lock securePeersLock(_securePeersMutex);
+        auto& peer = _securePeers[senderSockAddr];
+        peer.session = session;
+        peer.numHandshakesSent = 0;
+        peer.lastReceiveTime = p_high_resolution_clock::now();
+        pendingDatagrams.swap(peer.pendingDatagrams);
+    }
+
+    qCDebug(networking) << "Established secure session with" << senderSockAddr << "using"
+        << (session->getCipher() == SecureSession::AES256GCM ? "AES-256-GCM" : "ChaCha20-Poly1305");
+
+    sendPendingDatagrams(*session, pendingDatagrams, senderSockAddr);
+}
+
+void Socket::sendPendingDatagrams(SecureSession& session, std::deque<QByteArray>& datagrams, const SockAddr& sockAddr) {
+    SendBatch sendBatch(*this);
+    for (const auto& datagram : datagrams) {
+        writeEncryptedDatagram(session, datagram.constData(), datagram.size(), sockAddr);
+    }
+}
+
+qint64 Socket::decryptDatagram(char* data, qint64 size, const SockAddr& senderSockAddr) {
+    if (_encryptionMode == EncryptionMode::Disabled) {
+        return -1;
+    }
+
+    std::shared_ptr<SecureSession> session;
+    {
+        Lock securePeersLock(_securePeersMutex);
+        auto it = _securePeers.find(senderSockAddr);
+        if (it != _securePeers.end()) {
+            session = it->second.session;
+            it->second.lastReceiveTime = p_high_resolution_clock::now();
+        }
+    }
+
+    if (!session || !session->isEstablished()) {
+        // the peer has a session we lost, start a new one if it's a peer we encrypt for
+        bool isHeld = false;
+        findSecureSession(senderSockAddr, QByteArray(), isHeld);
+        return -1;
+    }
+
+    return session->decrypt(data, size);
+}
+
+bool Socket::mustBeEncrypted(const SockAddr& senderSockAddr) {
+    if (_encryptionMode != EncryptionMode::Required || senderSockAddr.getType() != SocketType::UDP) {
+        return false;
+    }
+
+    {
+        Lock securePeersLock(_securePeersMutex);
+        auto it = _securePeers.find(senderSockAddr);
+        if (it != _securePeers.end() && it->second.session && it->second.session->isEstablished()) {
+            return true;
+        }
+    }
+
+    // the peers we would start a session with can't do without one
+    return !_connectionCreationFilterOperator || _connectionCreationFilterOperator(senderSockAddr);
+}
+
+void Socket::pruneSecureSessions() {
+    auto now = p_high_resolution_clock::now();
+
+    Lock securePeersLock(_securePeersMutex);
+    for (auto it = _securePeers.begin(); it != _securePeers.end();) {
+        if (now - it->second.lastReceiveTime > SECURE_SESSION_TIMEOUT && now >= it->second.retryTime) {
+            it = _securePeers.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+int Socket::getNumSecureSessions() {
+    Lock securePeersLock(_securePeersMutex);
+    return (int)std::count_if(_securePeers.begin(), _securePeers.end(), [](const auto& peer) {
+        return peer.second.session && peer.second.session->isEstablished();
+    });
+}
+
+qint64 Socket::writeRawDatagram(const QByteArray& datagram, const SockAddr& sockAddr) {
+    if (_outboundDatagramSink) {
+        _outboundDatagramSink(datagram.constData(), datagram.size(), sockAddr);
+        return datagram.size();
+    }
+
     auto socketType = sockAddr.getType();
 
+    if (queueBatchedDatagram(datagram.constData(), datagram.size(), sockAddr)) {
+        return datagram.size();
+    }
+
     // don't attempt to write the datagram if we're unbound.  Just drop it.
     // _networkSocket.writeDatagram will return an error anyway, but there are
     // potential crashes in Qt when that happens.
@@ -334,6 +747,9 @@ void Socket::clearConnections() {
         qCDebug(networking) << "Clearing all remaining connections in Socket.";
         _connectionsHash.clear();
     }
+
+    Lock securePeersLock(_securePeersMutex);
+    _securePeers.clear();
 }
 
 void Socket::cleanupConnection(SockAddr sockAddr) {
@@ -345,6 +761,20 @@ void Socket::cleanupConnection(SockAddr sockAddr) {
         qCDebug(networking) << "Socket::cleanupConnection called for UDT connection to" << sockAddr;
 #endif
     }
+    connectionsLock.unlock();
+
+    Lock securePeersLock(_securePeersMutex);
+    _securePeers.erase(sockAddr);
+}
+
+void Socket::addUnfilteredHandler(const SockAddr& senderSockAddr, BasePacketHandler handler) {
+    _unfilteredHandlers[senderSockAddr] = handler;
+
+    auto sockAddrs = std::make_shared<std::unordered_set<SockAddr>>();
+    for (const auto& unfilteredHandler : _unfilteredHandlers) {
+        sockAddrs->insert(unfilteredHandler.first);
+    }
+    std::atomic_store(&_unfilteredSockAddrs, std::shared_ptr<const std::unordered_set<SockAddr>>(sockAddrs));
 }
 
 void Socket::messageReceived(std::unique_ptr<Packet> packet) {
@@ -383,11 +813,16 @@ void Socket::checkForReadyReadBackup() {
 }
 
 void Socket::readPendingDatagrams() {
+    MemoryAccounting::Scope memoryScope(MemoryTag::Networking);
     using namespace std::chrono;
     static const auto MAX_PROCESS_TIME { 100ms };
     const auto abortTime = system_clock::now() + MAX_PROCESS_TIME;
     int packetSizeWithHeader = -1;
 
+    if (_receiveBatchSize > 1) {
+        readPendingDatagramBatches(abortTime);
+    }
+
     while (_networkSocket.hasPendingDatagrams() &&
            (packetSizeWithHeader = _networkSocket.pendingDatagramSize()) != -1) {
         if (system_clock::now() > abortTime) {
@@ -411,7 +846,7 @@ void Socket::readPendingDatagrams() {
         SockAddr senderSockAddr;
 
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketBufferPool::allocate(packetSizeWithHeader);
 
         // pull the datagram
         auto sizeRead = _networkSocket.readDatagram(buffer.get(), packetSizeWithHeader, &senderSockAddr);
@@ -426,75 +861,177 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+    }
+}
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this SockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
-            }
+void Socket::readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime) {
+    const int batchSize = std::min((int)_receiveBatchSize, NetworkSocket::MAX_DATAGRAM_BATCH_SIZE);
+    if (_receiveBatch.size() != (size_t)batchSize) {
+        _receiveBatch.resize(batchSize);
+    }
 
-            continue;
+    do {
+        int numRead = _networkSocket.readDatagrams(_receiveBatch);
+        if (numRead == 0) {
+            break;
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        // we're reading packets so re-start the readyRead backup timer
+        _readyReadBackupTimer->start();
+
+        // every datagram in this batch came in with the same system call, so they share a receive time
+        auto receiveTime = p_high_resolution_clock::now();
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+        _numReceiveBatches++;
+        _numBatchedDatagrams += numRead;
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+        for (int i = 0; i < numRead; ++i) {
+            auto& datagram = _receiveBatch[i];
 
-            if (connection) {
-                connection->processControl(move(controlPacket));
+            // save information for this packet, in case it is the one that sticks readyRead
+            _lastPacketSizeRead = datagram.size;
+            _lastPacketSockAddr = datagram.sockAddr;
+
+            if (datagram.size <= 0) {
+                // keep the buffer in the batch, it will be read into again
+                continue;
             }
 
-        } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+            // the packet takes ownership of the buffer, readDatagrams will allocate a replacement for the slot
+            processDatagram(std::move(datagram.data), datagram.size, datagram.sockAddr, receiveTime, true);
+        }
+
+        processBatchedDataPackets();
+
+        if (numRead < batchSize) {
+            // the socket has been drained
+            break;
+        }
+    } while (std::chrono::system_clock::now() <= abortTime);
+}
+
+void Socket::processDatagram(PacketBuffer buffer, qint64 packetSizeWithHeader, const SockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime, bool isPartOfBatch) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
+
+    ControlPacket::Type secureType;
+    if (it == _unfilteredHandlers.end() && SecureSession::readSecureType(buffer.get(), packetSizeWithHeader, secureType)) {
+        if (secureType != ControlPacket::SecureData) {
+            processSecureHandshake(buffer.get(), packetSizeWithHeader, secureType, senderSockAddr);
+            return;
+        }
+
+        // the datagram is decrypted in place, and then processed like any other
+        packetSizeWithHeader = decryptDatagram(buffer.get(), packetSizeWithHeader, senderSockAddr);
+        if (packetSizeWithHeader < (qint64)sizeof(uint32_t)) {
+            return;
+        }
+    } else if (it == _unfilteredHandlers.end() && mustBeEncrypted(senderSockAddr)) {
+        return;
+    }
+
+    // anything other than a data packet is handled right away, the data packets read before it go first
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+    if (it != _unfilteredHandlers.end() || isControlPacket) {
+        processBatchedDataPackets();
+    }
+
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this SockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+        return;
+    }
+
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one
+        auto connection = findOrCreateConnection(senderSockAddr, true);
+
+        if (connection) {
+            connection->processControl(move(controlPacket));
+        }
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+        if (isPartOfBatch && _packetBatchFilterOperator) {
+            // verified with the rest of its batch in processBatchedDataPackets
+            _batchedDataPackets.push_back(std::move(packet));
+            return;
+        }
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+        // call our verification operator to see if this packet is verified
+        bool isVerified = !_packetFilterOperator || _packetFilterOperator(*packet);
+        processDataPacket(std::move(packet), isVerified);
+    }
+}
+
+void Socket::processBatchedDataPackets() {
+    if (_batchedDataPackets.empty()) {
+        return;
+    }
+
+    _batchedDataPacketPointers.clear();
+    for (auto& packet : _batchedDataPackets) {
+        _batchedDataPacketPointers.push_back(packet.get());
+    }
+    _batchedDataPacketVerifications.assign(_batchedDataPackets.size(), false);
+
+    _packetBatchFilterOperator(_batchedDataPacketPointers, _batchedDataPacketVerifications);
+
+    for (size_t i = 0; i < _batchedDataPackets.size(); ++i) {
+        processDataPacket(std::move(_batchedDataPackets[i]), _batchedDataPacketVerifications[i]);
+    }
+    _batchedDataPackets.clear();
+}
+
+void Socket::processDataPacket(std::unique_ptr<Packet> packet, bool isVerified) {
+    if (!isVerified) {
+        return;
+    }
+
+    const auto& senderSockAddr = packet->getSenderSockAddr();
+    auto connection = findOrCreateConnection(senderSockAddr, true);
+
+    if (packet->isReliable()) {
+        // if this was a reliable packet then signal the matching connection with the sequence number
+
+        if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                      packet->getDataSize(),
+                                                                      packet->getPayloadSize())) {
+            // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+            qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
-                }
+            return;
+        }
+    } else if (connection) {
+        connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                    packet->getPayloadSize());
+    }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
-                }
-            }
+    if (packet->isPartOfMessage()) {
+        if (connection) {
+            connection->queueReceivedMessagePacket(std::move(packet));
         }
+    } else if (_packetHandler) {
+        // call the verified packet callback to let it handle this packet
+        _packetHandler(std::move(packet));
     }
 }
 
@@ -512,6 +1049,33 @@ void Socket::setCongestionControlFactory(std::unique_ptr<CongestionControlVirtua
 }
 
 
+void Socket::setPacketCoalescingHeader(const QByteArray& header) {
+    if (QThread::currentThread() != thread()) {
+        BLOCKING_INVOKE_METHOD(this, "setPacketCoalescingHeader", Q_ARG(QByteArray, header));
+        return;
+    }
+
+    _packetCoalescingHeader = header;
+    if (header.isEmpty()) {
+        flushCoalescedPackets();
+    }
+}
+
+void Socket::scheduleCoalescedPacketsFlush() {
+    if (!_coalescedPacketsTimer->isActive()) {
+        _coalescedPacketsTimer->start();
+    }
+}
+
+void Socket::flushCoalescedPackets() {
+    _coalescedPacketsTimer->stop();
+
+    Lock connectionsLock(_connectionsHashMutex);
+    for (auto& pair : _connectionsHash) {
+        pair.second->flushCoalescedPackets();
+    }
+}
+
 void Socket::setConnectionMaxBandwidth(int maxBandwidth) {
     qInfo() << "Setting socket's maximum bandwith to" << maxBandwidth << "bps. ("
             << _connectionsHash.size() << "live connections)";
@@ -532,6 +1096,200 @@ ConnectionStats::Stats Socket::sampleStatsForConnection(const SockAddr& destinat
     }
 }
 
+void Socket::setReceiveBatchSize(int batchSize) {
+    _receiveBatchSize = std::max(1, std::min(batchSize, NetworkSocket::MAX_DATAGRAM_BATCH_SIZE));
+}
+
+Socket::ReceiveBatchStats Socket::sampleReceiveBatchStats() {
+    ReceiveBatchStats stats;
+    stats.capacity = _receiveBatchSize;
+
+    auto numBatches = _numReceiveBatches.exchange(0);
+    auto numDatagrams = _numBatchedDatagrams.exchange(0);
+    if (numBatches > 0) {
+        stats.averageBatchSize = (float)numDatagrams / (float)numBatches;
+        stats.fillRatio = stats.averageBatchSize / (float)stats.capacity;
+    }
+    return stats;
+}
+
+void Socket::setNumReceiveThreads(int numThreads) {
+    if (QThread::currentThread() != thread()) {
+        BLOCKING_INVOKE_METHOD(this, "setNumReceiveThreads", Q_ARG(int, numThreads));
+        return;
+    }
+
+    numThreads = std::max(1, std::min(numThreads, MAX_RECEIVE_THREADS));
+#if !defined(Q_OS_LINUX)
+    if (numThreads > 1) {
+        qCWarning(networking) << "Receive threads need the flow hashing of SO_REUSEPORT, only available on Linux";
+        numThreads = 1;
+    }
+#endif
+    if (numThreads == _numReceiveThreads) {
+        return;
+    }
+
+    _numReceiveThreads = numThreads;
+    if (_networkSocket.state(SocketType::UDP) == QAbstractSocket::BoundState) {
+        rebind(SocketType::UDP);
+    }
+}
+
+void Socket::setConcurrentPacketBatchFilterOperator(ConcurrentPacketBatchFilterOperator filterOperator) {
+    _concurrentPacketBatchFilterOperator = filterOperator;
+    if (!_receiveShards.empty()) {
+        // restart the receive threads with a copy of the new one
+        stopReceiveThreads();
+        startReceiveThreads();
+    }
+}
+
+void Socket::startReceiveThreads() {
+    const auto& descriptors = _networkSocket.getSiblingDescriptors();
+    if (descriptors.empty()) {
+        return;
+    }
+
+    _isReceiving = true;
+    for (auto descriptor : descriptors) {
+        auto shard = std::unique_ptr<ReceiveShard>(new ReceiveShard());
+        shard->descriptor = descriptor;
+        shard->filterOperator = _concurrentPacketBatchFilterOperator;
+        shard->batch.resize(std::min((int)UDP_RECEIVE_BATCH_SIZE, NetworkSocket::MAX_DATAGRAM_BATCH_SIZE));
+        _receiveShards.push_back(std::move(shard));
+    }
+    for (auto& shard : _receiveShards) {
+        auto shardPointer = shard.get();
+        shard->thread = std::thread([this, shardPointer] { runReceiveShard(*shardPointer); });
+    }
+
+    qCDebug(networking) << "Receiving on" << _receiveShards.size() + 1 << "sockets sharing port"
+        << _networkSocket.localPort(SocketType::UDP);
+}
+
+void Socket::stopReceiveThreads() {
+    if (_receiveShards.empty()) {
+        return;
+    }
+
+    _isReceiving = false;
+    for (auto& shard : _receiveShards) {
+        shard->thread.join();
+    }
+    // whatever they read and wasn't processed yet is dropped like the datagrams still in the sockets
+    _receiveShards.clear();
+}
+
+void Socket::runReceiveShard(ReceiveShard& shard) {
+    while (_isReceiving) {
+        int numRead = NetworkSocket::readSiblingDatagrams(shard.descriptor, shard.batch, RECEIVE_THREAD_POLL_MSECS);
+        if (numRead == 0) {
+            continue;
+        }
+
+        auto receiveTime = p_high_resolution_clock::now();
+        _numReceiveBatches++;
+        _numBatchedDatagrams += numRead;
+
+        auto unfilteredSockAddrs = std::atomic_load(&_unfilteredSockAddrs);
+        bool isEncryptionEnabled = _encryptionMode != EncryptionMode::Disabled;
+
+        for (int i = 0; i < numRead; ++i) {
+            auto& datagram = shard.batch[i];
+            if (datagram.size < (qint64)sizeof(uint32_t)) {
+                continue;
+            }
+
+            // secure sessions, connections and unfiltered handlers belong to the socket thread, so everything but the
+            // data packets goes there as it was read - after the data packets read before it, to keep their order
+            ControlPacket::Type secureType;
+            bool isControlPacket = *reinterpret_cast<uint32_t*>(datagram.data.get()) & CONTROL_BIT_MASK;
+            if (isEncryptionEnabled || isControlPacket
+                || SecureSession::readSecureType(datagram.data.get(), datagram.size, secureType)
+                || (unfilteredSockAddrs && unfilteredSockAddrs->count(datagram.sockAddr) > 0)) {
+                verifyShardDataPackets(shard);
+
+                ReceivedDatagram received;
+                received.buffer = std::move(datagram.data);
+                received.size = datagram.size;
+                received.sockAddr = datagram.sockAddr;
+                received.receiveTime = receiveTime;
+                shard.received.push_back(std::move(received));
+                continue;
+            }
+
+            auto packet = Packet::fromReceivedPacket(std::move(datagram.data), datagram.size, datagram.sockAddr);
+            packet->setReceiveTime(receiveTime);
+            shard.dataPackets.push_back(std::move(packet));
+        }
+        verifyShardDataPackets(shard);
+
+        if (shard.received.empty()) {
+            continue;
+        }
+
+        {
+            Lock readyLock(shard.readyMutex);
+            std::move(shard.received.begin(), shard.received.end(), std::back_inserter(shard.ready));
+        }
+        shard.received.clear();
+
+        if (!_hasReceivedShardDatagrams.exchange(true)) {
+            QMetaObject::invokeMethod(this, "processReceiveShards", Qt::QueuedConnection);
+        }
+    }
+}
+
+void Socket::verifyShardDataPackets(ReceiveShard& shard) {
+    if (shard.dataPackets.empty()) {
+        return;
+    }
+
+    shard.dataPacketVerifications.assign(shard.dataPackets.size(), PacketVerification::Deferred);
+    if (shard.filterOperator) {
+        shard.dataPacketPointers.clear();
+        for (auto& packet : shard.dataPackets) {
+            shard.dataPacketPointers.push_back(packet.get());
+        }
+        shard.filterOperator(shard.dataPacketPointers, shard.dataPacketVerifications);
+    }
+
+    for (size_t i = 0; i < shard.dataPackets.size(); ++i) {
+        auto verification = shard.dataPacketVerifications[i];
+        if (verification != PacketVerification::Rejected) {
+            ReceivedDatagram received;
+            received.dataPacket = std::move(shard.dataPackets[i]);
+            received.isVerified = verification == PacketVerification::Verified;
+            shard.received.push_back(std::move(received));
+        }
+    }
+    shard.dataPackets.clear();
+}
+
+void Socket::processReceiveShards() {
+    _hasReceivedShardDatagrams = false;
+
+    for (auto& shard : _receiveShards) {
+        {
+            Lock readyLock(shard->readyMutex);
+            shard->processing.swap(shard->ready);
+        }
+
+        for (auto& received : shard->processing) {
+            if (received.dataPacket) {
+                // the filter operators that aren't thread-safe verify what the receive thread deferred
+                bool isVerified = received.isVerified || !_packetFilterOperator
+                    || _packetFilterOperator(*received.dataPacket);
+                processDataPacket(std::move(received.dataPacket), isVerified);
+            } else {
+                processDatagram(std::move(received.buffer), received.size, received.sockAddr, received.receiveTime);
+            }
+        }
+        shard->processing.clear();
+    }
+}
+
 Socket::StatsVector Socket::sampleStatsForAllConnections() {
     StatsVector result;
     Lock connectionsLock(_connectionsHashMutex);
@@ -606,7 +1364,16 @@ void Socket::handleRemoteAddressChange(SockAddr previousAddress, SockAddr curren
                 _unreliableSequenceNumbers.erase(sequenceNumbersIter);
                 _unreliableSequenceNumbers[currentAddress] = sequenceNumbers;
             }
-
+            sequenceNumbersLock.unlock();
+
+            // the session stays with the peer, its keys don't depend on the address
+            Lock securePeersLock(_securePeersMutex);
+            const auto securePeerIter = _securePeers.find(previousAddress);
+            if (securePeerIter != _securePeers.end()) {
+                auto securePeer = std::move(securePeerIter->second);
+                _securePeers.erase(securePeerIter);
+                _securePeers[currentAddress] = std::move(securePeer);
+            }
         }
     }
 }
@@ -16,10 +16,16 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <functional>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <list>
+#include <memory>
+#include <thread>
 
 #include <QtCore/QObject>
 #include <QtCore/QTimer>
@@ -28,6 +34,7 @@
 #include "TCPVegasCC.h"
 #include "Connection.h"
 #include "NetworkSocket.h"
+#include "SecureSession.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -41,7 +48,17 @@ class PacketList;
 class SequenceNumber;
 
 using PacketFilterOperator = std::function<bool(const Packet&)>;
+// verifies the data packets read with one system call together, so that work for the same sender can be shared
+using PacketBatchFilterOperator = std::function<void(const std::vector<const Packet*>& packets,
+                                                     std::vector<bool>& isVerified)>;
+// verifies data packets on the receive threads, leaving those it can't verify there to the other filter operators
+enum class PacketVerification : uint8_t { Rejected, Verified, Deferred };
+using ConcurrentPacketBatchFilterOperator = std::function<void(const std::vector<const Packet*>& packets,
+                                                               std::vector<PacketVerification>& verifications)>;
 using ConnectionCreationFilterOperator = std::function<bool(const SockAddr&)>;
+using PreSharedKeyOperator = std::function<QByteArray(const SockAddr&)>;
+// takes the datagrams the socket would have written, called from whichever thread sends them
+using OutboundDatagramSink = std::function<void(const char* data, qint64 size, const SockAddr& sockAddr)>;
 
 using BasePacketHandler = std::function<void(std::unique_ptr<BasePacket>)>;
 using PacketHandler = std::function<void(std::unique_ptr<Packet>)>;
@@ -57,7 +74,38 @@ class Socket : public QObject {
 public:
     using StatsVector = std::vector<std::pair<SockAddr, ConnectionStats::Stats>>;
 
+    // While a SendBatch is alive, unreliable datagrams the current thread writes to the socket are collected and then
+    // flushed together when the outermost batch goes out of scope, or when the batch fills up.
+    // Queued datagrams report their full size as written; a failed flush shows up as loss.
+    class SendBatch {
+    public:
+        SendBatch(Socket& socket);
+        SendBatch(const SendBatch&) = delete;
+        SendBatch& operator=(const SendBatch&) = delete;
+        ~SendBatch();
+
+    private:
+        Socket& _socket;
+        bool _isActive { false };
+    };
+
+    // Whether datagrams are encrypted, see SecureSession. Sessions are started with the peers that pass the connection
+    // creation filter, any peer can start one with us. While a session is being set up datagrams go out unencrypted when
+    // it is preferred, or wait for it when it is required - then unencrypted datagrams from those peers are dropped.
+    enum class EncryptionMode {
+        Disabled,
+        Preferred,
+        Required
+    };
+
+    struct ReceiveBatchStats {
+        int capacity { 1 };
+        float averageBatchSize { 0.0f };
+        float fillRatio { 0.0f };
+    };
+
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
+    ~Socket();
 
     quint16 localPort(SocketType socketType) const { return _networkSocket.localPort(socketType); }
 
@@ -74,15 +122,39 @@ public:
     void rebind(SocketType socketType);
 
     void setPacketFilterOperator(PacketFilterOperator filterOperator) { _packetFilterOperator = filterOperator; }
+    void setPacketBatchFilterOperator(PacketBatchFilterOperator filterOperator)
+        { _packetBatchFilterOperator = filterOperator; }
+    // called on this thread, the receive threads take a copy of it when they start
+    void setConcurrentPacketBatchFilterOperator(ConcurrentPacketBatchFilterOperator filterOperator);
     void setPacketHandler(PacketHandler handler) { _packetHandler = handler; }
     void setMessageHandler(MessageHandler handler) { _messageHandler = handler; }
     void setMessageFailureHandler(MessageFailureHandler handler) { _messageFailureHandler = handler; }
     void setConnectionCreationFilterOperator(ConnectionCreationFilterOperator filterOperator)
         { _connectionCreationFilterOperator = filterOperator; }
 
-    void addUnfilteredHandler(const SockAddr& senderSockAddr, BasePacketHandler handler)
-        { _unfilteredHandlers[senderSockAddr] = handler; }
+    void addUnfilteredHandler(const SockAddr& senderSockAddr, BasePacketHandler handler);
+
+    void setEncryptionMode(EncryptionMode mode);
+    EncryptionMode getEncryptionMode() const { return _encryptionMode; }
+    // the key a session with the peer authenticates its handshake with, both sides need the same one or none
+    void setPreSharedKeyOperator(PreSharedKeyOperator keyOperator) { _preSharedKeyOperator = keyOperator; }
+
+    // hands every outgoing datagram to the sink instead of the network, for benchmarks that drive a mixer without one.
+    // Set it before anything is sent.
+    void setOutboundDatagramSink(OutboundDatagramSink sink) { _outboundDatagramSink = sink; }
 
+    int getNumSecureSessions();
+
+    // Small reliable packets wait a couple of milliseconds for others to the same destination, to share a datagram
+    // with them, see PacketCoalescer. The header starts the payload of the shared packet so that the receiver can
+    // tell it apart and split it; an empty one, the default, sends every packet on its own.
+    Q_INVOKABLE void setPacketCoalescingHeader(const QByteArray& header);
+    bool isCoalescingPackets() const { return !_packetCoalescingHeader.isEmpty(); }
+    const QByteArray& getPacketCoalescingHeader() const { return _packetCoalescingHeader; }
+    // called by a connection that started holding packets back
+    void scheduleCoalescedPacketsFlush();
+
+    // the congestion control of the connections created from now on, see createCongestionControlFactory
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
     void setConnectionMaxBandwidth(int maxBandwidth);
 
@@ -91,6 +163,20 @@ public:
 
     StatsVector sampleStatsForAllConnections();
 
+    // a batch size of 1 reads one datagram at a time, larger values drain many datagrams per system call
+    void setReceiveBatchSize(int batchSize);
+    int getReceiveBatchSize() const { return _receiveBatchSize; }
+    ReceiveBatchStats sampleReceiveBatchStats();
+
+    // With more than one, the UDP port is shared by that many sockets with SO_REUSEPORT and the kernel hashes each
+    // sender to one of them. This thread reads the first, every other has a receive thread of its own that parses and
+    // verifies its data packets, and hands them over to be dispatched here; the rest of a sender's datagrams still go
+    // through this thread, as do all of them while encryption is on. Linux only, a bound UDP socket is rebound.
+    // Only the concurrent batch filter operator is called from the receive threads; the data packets it defers, and all
+    // of them without one, are verified here by the other filter operators.
+    Q_INVOKABLE void setNumReceiveThreads(int numThreads);
+    int getNumReceiveThreads() const { return _numReceiveThreads; }
+
 #if defined(WEBRTC_DATA_CHANNELS)
     const WebRTCSocket* getWebRTCSocket();
     void setWebRTCIceServers(QList<QVariant> iceServers);
@@ -111,12 +197,37 @@ public slots:
 private slots:
     void readPendingDatagrams();
     void checkForReadyReadBackup();
+    void pruneSecureSessions();
+    void flushCoalescedPackets();
 
     void handleSocketError(SocketType socketType, QAbstractSocket::SocketError socketError);
     void handleStateChanged(SocketType socketType, QAbstractSocket::SocketState socketState);
 
 private:
+    struct SecurePeer {
+        std::shared_ptr<SecureSession> session; // established, or waiting for the response to our init
+        std::deque<QByteArray> pendingDatagrams; // waiting for the session when encryption is required
+        int numHandshakesSent { 0 };
+        p_high_resolution_clock::time_point lastHandshakeTime;
+        p_high_resolution_clock::time_point retryTime; // after the handshakes of a session went unanswered
+        p_high_resolution_clock::time_point lastReceiveTime;
+    };
+
     void setSystemBufferSizes(SocketType socketType);
+    qint64 writeRawDatagram(const QByteArray& datagram, const SockAddr& sockAddr);
+    qint64 writeEncryptedDatagram(SecureSession& session, const char* data, qint64 size, const SockAddr& sockAddr);
+    bool queueBatchedDatagram(const char* data, qint64 size, const SockAddr& sockAddr, SecureSession* session = nullptr);
+    std::shared_ptr<SecureSession> findSecureSession(const SockAddr& sockAddr, const QByteArray& datagram, bool& isHeld);
+    void processSecureHandshake(const char* data, qint64 size, ControlPacket::Type type, const SockAddr& senderSockAddr);
+    void sendPendingDatagrams(SecureSession& session, std::deque<QByteArray>& datagrams, const SockAddr& sockAddr);
+    qint64 decryptDatagram(char* data, qint64 size, const SockAddr& senderSockAddr);
+    bool mustBeEncrypted(const SockAddr& senderSockAddr);
+    void flushSendBatch();
+    void readPendingDatagramBatches(std::chrono::system_clock::time_point abortTime);
+    void processDatagram(PacketBuffer buffer, qint64 size, const SockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime, bool isPartOfBatch = false);
+    void processDataPacket(std::unique_ptr<Packet> packet, bool isVerified);
+    void processBatchedDataPackets();
     Connection* findOrCreateConnection(const SockAddr& sockAddr, bool filterCreation = false);
 
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
@@ -125,24 +236,69 @@ private:
     std::vector<SockAddr> getConnectionSockAddrs();
     void connectToSendSignal(const SockAddr& destinationAddr, QObject* receiver, const char* slot);
 
+    // a sibling socket of the UDP port and its receive thread, see setNumReceiveThreads
+    struct ReceivedDatagram {
+        std::unique_ptr<Packet> dataPacket; // a parsed data packet, otherwise the raw datagram
+        bool isVerified { false };
+        PacketBuffer buffer;
+        qint64 size { 0 };
+        SockAddr sockAddr;
+        p_high_resolution_clock::time_point receiveTime;
+    };
+    struct ReceiveShard {
+        qintptr descriptor { -1 };
+        std::thread thread;
+
+        // only used by the receive thread
+        ConcurrentPacketBatchFilterOperator filterOperator;
+        std::vector<NetworkSocket::Datagram> batch;
+        std::vector<std::unique_ptr<Packet>> dataPackets;
+        std::vector<const Packet*> dataPacketPointers;
+        std::vector<PacketVerification> dataPacketVerifications;
+        std::vector<ReceivedDatagram> received;
+
+        // handed over to the socket thread
+        Mutex readyMutex;
+        std::vector<ReceivedDatagram> ready;
+        std::vector<ReceivedDatagram> processing;
+    };
+
+    void startReceiveThreads();
+    void stopReceiveThreads();
+    void runReceiveShard(ReceiveShard& shard);
+    void verifyShardDataPackets(ReceiveShard& shard);
+    Q_INVOKABLE void processReceiveShards();
+
     Q_INVOKABLE void writeReliablePacket(Packet* packet, const SockAddr& sockAddr);
     Q_INVOKABLE void writeReliablePacketList(PacketList* packetList, const SockAddr& sockAddr);
 
     NetworkSocket _networkSocket;
     PacketFilterOperator _packetFilterOperator;
+    PacketBatchFilterOperator _packetBatchFilterOperator;
+    ConcurrentPacketBatchFilterOperator _concurrentPacketBatchFilterOperator;
     PacketHandler _packetHandler;
     MessageHandler _messageHandler;
     MessageFailureHandler _messageFailureHandler;
     ConnectionCreationFilterOperator _connectionCreationFilterOperator;
+    PreSharedKeyOperator _preSharedKeyOperator;
+    OutboundDatagramSink _outboundDatagramSink;
 
     Mutex _unreliableSequenceNumbersMutex;
     Mutex _connectionsHashMutex;
+    Mutex _securePeersMutex;
 
     std::unordered_map<SockAddr, BasePacketHandler> _unfilteredHandlers;
     std::unordered_map<SockAddr, SequenceNumber> _unreliableSequenceNumbers;
     std::unordered_map<SockAddr, std::unique_ptr<Connection>> _connectionsHash;
+    std::unordered_map<SockAddr, SecurePeer> _securePeers;
+
+    std::atomic<EncryptionMode> _encryptionMode { EncryptionMode::Disabled };
 
     QTimer* _readyReadBackupTimer { nullptr };
+    QTimer* _secureSessionTimer { nullptr };
+    QTimer* _coalescedPacketsTimer { nullptr };
+
+    QByteArray _packetCoalescingHeader; // only used on the socket's thread
 
     int _maxBandwidth { -1 };
 
@@ -150,6 +306,23 @@ private:
 
     bool _shouldChangeSocketOptions { true };
 
+    std::atomic<int> _receiveBatchSize { 1 };
+    std::vector<NetworkSocket::Datagram> _receiveBatch;
+
+    // data packets of the receive batch waiting to be verified together, in the order they were read
+    std::vector<std::unique_ptr<Packet>> _batchedDataPackets;
+    std::vector<const Packet*> _batchedDataPacketPointers;
+    std::vector<bool> _batchedDataPacketVerifications;
+    std::atomic<uint64_t> _numReceiveBatches { 0 };
+    std::atomic<uint64_t> _numBatchedDatagrams { 0 };
+
+    std::atomic<int> _numReceiveThreads { 1 };
+    std::vector<std::unique_ptr<ReceiveShard>> _receiveShards;
+    std::atomic<bool> _isReceiving { false };
+    std::atomic<bool> _hasReceivedShardDatagrams { false };
+    // the addresses with unfiltered handlers, which the receive threads leave to this thread
+    std::shared_ptr<const std::unordered_set<SockAddr>> _unfilteredSockAddrs;
+
     int _lastPacketSizeRead { 0 };
     SequenceNumber _lastReceivedSequenceNumber;
     SockAddr _lastPacketSockAddr;
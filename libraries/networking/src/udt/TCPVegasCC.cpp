@@ -67,6 +67,8 @@ bool TCPVegasCC::calculateRTT(p_high_resolution_clock::time_point sendTime, p_hi
                         + abs(lastRTT - _ewmaRTT)) / RTT_ESTIMATION_VARIANCE_ALPHA;
     }
 
+    _lastRTT = lastRTT;
+
     // keep track of the lowest RTT during connection
     _baseRTT = std::min(_baseRTT, lastRTT);
 
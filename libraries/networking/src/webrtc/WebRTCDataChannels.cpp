@@ -11,9 +11,18 @@
 
 #if defined(WEBRTC_DATA_CHANNELS)
 
+#include <algorithm>
+#include <cstring>
+
 #include <QJsonDocument>
 #include <QJsonObject>
 
+// NOTE: this indicates a newer WebRTC build in use on linux,
+// TODO: remove the old code when windows WebRTC is updated as well
+#ifndef API_SET_LOCAL_DESCRIPTION_OBSERVER_INTERFACE_H_
+#include <rtc_base/location.h>
+#endif
+
 #include "../NetworkLogging.h"
 
 
@@ -28,6 +37,8 @@ const std::list<std::string> DEFAULT_ICE_SERVER_URLS = {
     "stun:stun.schlund.de"
 };
 const int MAX_WEBRTC_BUFFER_SIZE = 16777216;  // 16MB
+// Unreliable messages that would wait behind this much are stale by the time they arrive.
+const int MAX_UNRELIABLE_BUFFER_SIZE = 262144;  // 256kB
 
 // #define WEBRTC_DEBUG
 
@@ -198,15 +209,16 @@ void WDCPeerConnectionObserver::OnConnectionChange(PeerConnectionInterface::Peer
 }
 
 
-WDCDataChannelObserver::WDCDataChannelObserver(WDCConnection* parent) :
-    _parent(parent)
+WDCDataChannelObserver::WDCDataChannelObserver(WDCConnection* parent, bool isUnreliable) :
+    _parent(parent),
+    _isUnreliable(isUnreliable)
 { }
 
 void WDCDataChannelObserver::OnStateChange() {
 #ifdef WEBRTC_DEBUG
-    qCDebug(networking_webrtc) << "WDCDataChannelObserver::OnStateChange()";
+    qCDebug(networking_webrtc) << "WDCDataChannelObserver::OnStateChange() :" << _isUnreliable;
 #endif
-    _parent->onDataChannelStateChanged();
+    _parent->onDataChannelStateChanged(_isUnreliable);
 }
 
 void WDCDataChannelObserver::OnMessage(const DataBuffer& buffer) {
@@ -226,11 +238,20 @@ WDCConnection::WDCConnection(WebRTCDataChannels* parent, const QString& dataChan
     qCDebug(networking_webrtc) << "WDCConnection::WDCConnection() :" << dataChannelID;
 #endif
 
+    // The ID has been validated by WebRTCDataChannels::onSignalingMessage().
+    auto addressParts = dataChannelID.split(":");
+    if (addressParts.length() == 2) {
+        _address = SockAddr(SocketType::WebRTC, QHostAddress(addressParts[0]), addressParts[1].toInt());
+    } else {
+        qCWarning(networking_webrtc) << "Invalid dataChannelID:" << dataChannelID;
+    }
+
     // Create observers.
     _setLocalDescriptionObserver = new rtc::RefCountedObject<WDCSetLocalDescriptionObserver>();
     _setRemoteDescriptionObserver = new rtc::RefCountedObject<WDCSetRemoteDescriptionObserver>();
     _createSessionDescriptionObserver = new rtc::RefCountedObject<WDCCreateSessionDescriptionObserver>(this);
     _dataChannelObserver = std::make_shared<WDCDataChannelObserver>(this);
+    _unreliableDataChannelObserver = std::make_shared<WDCDataChannelObserver>(this, true);
     _peerConnectionObserver = std::make_shared<WDCPeerConnectionObserver>(this);
 
     // Create new peer connection.
@@ -399,6 +420,14 @@ void WDCConnection::onDataChannelOpened(rtc::scoped_refptr<DataChannelInterface>
         << dataChannel->maxRetransmitsOpt().value_or(-1);
 #endif
 
+    if (!dataChannel->ordered() || dataChannel->maxRetransmitsOpt().value_or(-1) == 0) {
+        if (_unreliableDataChannelObserver) {
+            _unreliableDataChannel = dataChannel;
+            _unreliableDataChannel->RegisterObserver(_unreliableDataChannelObserver.get());
+        }
+        return;
+    }
+
     _dataChannel = dataChannel;
     _dataChannel->RegisterObserver(_dataChannelObserver.get());
 
@@ -408,7 +437,16 @@ void WDCConnection::onDataChannelOpened(rtc::scoped_refptr<DataChannelInterface>
     _parent->onDataChannelOpened(this, _dataChannelID);
 }
 
-void WDCConnection::onDataChannelStateChanged() {
+void WDCConnection::onDataChannelStateChanged(bool isUnreliable) {
+    if (isUnreliable) {
+        if (_unreliableDataChannel && _unreliableDataChannel->state() == DataChannelInterface::kClosed) {
+            // Finish with the unreliable data channel, unreliable messages are sent on the main one from now on.
+            _unreliableDataChannel->UnregisterObserver();
+            _unreliableDataChannelObserver = nullptr;
+        }
+        return;
+    }
+
     auto state = _dataChannel->state();
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WDCConnection::onDataChannelStateChanged() :" << (int)state
@@ -419,6 +457,10 @@ void WDCConnection::onDataChannelStateChanged() {
         _dataChannel->UnregisterObserver();
         // Don't set _dataChannel = nullptr because it is a scoped_refptr.
         _dataChannelObserver = nullptr;
+        if (_unreliableDataChannel && _unreliableDataChannelObserver) {
+            _unreliableDataChannel->UnregisterObserver();
+        }
+        _unreliableDataChannelObserver = nullptr;
 
         // Close peer connection.
         _parent->closePeerConnection(this);
@@ -430,53 +472,20 @@ void WDCConnection::onDataChannelMessageReceived(const DataBuffer& buffer) {
     qCDebug(networking_webrtc) << "WDCConnection::onDataChannelMessageReceived()";
 #endif
 
-    auto byteArray = QByteArray(buffer.data.data<char>(), (int)buffer.data.size());
-
     // Echo message back to sender.
-    if (byteArray.startsWith("echo:")) {
+    const char ECHO_PREFIX[] = "echo:";
+    const size_t ECHO_PREFIX_LENGTH = sizeof(ECHO_PREFIX) - 1;
+    if (buffer.data.size() >= ECHO_PREFIX_LENGTH && memcmp(buffer.data.data(), ECHO_PREFIX, ECHO_PREFIX_LENGTH) == 0) {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "Echo message back";
 #endif
-        auto addressParts = _dataChannelID.split(":");
-        if (addressParts.length() != 2) {
-            qCWarning(networking_webrtc) << "Invalid dataChannelID:" << _dataChannelID;
-            return;
-        }
-        auto address = SockAddr(SocketType::WebRTC, QHostAddress(addressParts[0]), addressParts[1].toInt());
-        _parent->sendDataMessage(address, byteArray);  // Use parent method to exercise the code stack.
+        auto byteArray = QByteArray(buffer.data.data<char>(), (int)buffer.data.size());
+        _parent->sendDataMessage(_address, byteArray);  // Use parent method to exercise the code stack.
         return;
     }
 
-    _parent->emitDataMessage(_dataChannelID, byteArray);
-}
-
-qint64 WDCConnection::getBufferedAmount() const {
-#ifdef WEBRTC_DEBUG
-    qCDebug(networking_webrtc) << "WDCConnection::getBufferedAmount()";
-#endif
-    return _dataChannel && _dataChannel->state() != DataChannelInterface::kClosing
-            && _dataChannel->state() != DataChannelInterface::kClosed
-        ? _dataChannel->buffered_amount() : 0;
-}
-
-bool WDCConnection::sendDataMessage(const DataBuffer& buffer) {
-#ifdef WEBRTC_DEBUG
-    qCDebug(networking_webrtc) << "WDCConnection::sendDataMessage()";
-    if (!_dataChannel || _dataChannel->state() == DataChannelInterface::kClosing
-        || _dataChannel->state() == DataChannelInterface::kClosed) {
-        qCDebug(networking_webrtc) << "No data channel to send on";
-    }
-#endif
-    if (!_dataChannel || _dataChannel->state() == DataChannelInterface::kClosing
-            || _dataChannel->state() == DataChannelInterface::kClosed) {
-        // Data channel may have been closed while message to send was being prepared.
-        return false;
-    } else if (_dataChannel->buffered_amount() + buffer.size() > MAX_WEBRTC_BUFFER_SIZE) {
-        // Don't send, otherwise the data channel will be closed.
-        qCDebug(networking_webrtc) << "WebRTC send buffer overflow";
-        return false;
-    }
-    return _dataChannel->Send(buffer);
+    ++_numMessagesReceived;
+    _parent->queueReceivedMessage(_address, buffer.data);
 }
 
 void WDCConnection::closePeerConnection() {
@@ -543,22 +552,31 @@ WebRTCDataChannels::~WebRTCDataChannels() {
 }
 
 void WebRTCDataChannels::reset() {
+    QHash<QString, WDCConnection*> connections;
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        connections.swap(_connectionsByID);
+        _peers.clear();
+    }
 #ifdef WEBRTC_DEBUG
-    qCDebug(networking_webrtc) << "WebRTCDataChannels::reset() :" << _connectionsByID.count();
+    qCDebug(networking_webrtc) << "WebRTCDataChannels::reset() :" << connections.count();
 #endif
-    QHashIterator<QString, WDCConnection*> i(_connectionsByID);
+    QHashIterator<QString, WDCConnection*> i(connections);
     while (i.hasNext()) {
         i.next();
         delete i.value();
     }
-    _connectionsByID.clear();
 }
 
 void WebRTCDataChannels::onDataChannelOpened(WDCConnection* connection, const QString& dataChannelID) {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WebRTCDataChannels::onDataChannelOpened() :" << dataChannelID;
 #endif
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
     _connectionsByID.insert(dataChannelID, connection);
+    auto& peer = _peers[connection->getAddress()];
+    peer = Peer();
+    peer.connection = connection;
 }
 
 void WebRTCDataChannels::onSignalingMessage(const QJsonObject& message) {
@@ -584,10 +602,14 @@ void WebRTCDataChannels::onSignalingMessage(const QJsonObject& message) {
 
     // Find or create a connection.
     WDCConnection* connection;
-    if (_connectionsByID.contains(from)) {
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
         connection = _connectionsByID.value(from);
-    } else {
+    }
+    if (!connection) {
+        // The connection's observers call back on the WebRTC threads, so it is created without the lock held.
         connection = new WDCConnection(this, from);
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
         _connectionsByID.insert(from, connection);
     }
 
@@ -618,46 +640,166 @@ void WebRTCDataChannels::sendSignalingMessage(const QJsonObject& message) {
     emit signalingMessage(message);
 }
 
-void WebRTCDataChannels::emitDataMessage(const QString& dataChannelID, const QByteArray& byteArray) {
+void WebRTCDataChannels::queueReceivedMessage(const SockAddr& address, const rtc::CopyOnWriteBuffer& data) {
 #ifdef WEBRTC_DEBUG
-    qCDebug(networking_webrtc) << "WebRTCDataChannels::emitDataMessage() :" << dataChannelID << byteArray.toHex()
-        << byteArray.length();
+    qCDebug(networking_webrtc) << "WebRTCDataChannels::queueReceivedMessage() :" << address << data.size();
 #endif
-    auto addressParts = dataChannelID.split(":");
-    if (addressParts.length() != 2) {
-        qCWarning(networking_webrtc) << "Invalid dataChannelID:" << dataChannelID;
-        return;
+    bool shouldNotify;
+    {
+        std::lock_guard<std::mutex> lock(_receivedMessagesMutex);
+        _receivedMessages.push_back({ address, data });
+        shouldNotify = !_isReceiveNotificationPending;
+        _isReceiveNotificationPending = true;
+    }
+    if (shouldNotify) {
+        emit dataMessagesReceived();
     }
-    auto address = SockAddr(SocketType::WebRTC, QHostAddress(addressParts[0]), addressParts[1].toInt());
-    emit dataMessage(address, byteArray);
 }
 
-bool WebRTCDataChannels::sendDataMessage(const SockAddr& destination, const QByteArray& byteArray) {
-    auto dataChannelID = destination.toShortString();
+void WebRTCDataChannels::takeReceivedMessages(std::deque<ReceivedMessage>& messages) const {
+    std::lock_guard<std::mutex> lock(_receivedMessagesMutex);
+    // Swapping hands the reader's empty queue back, so its storage is reused.
+    messages.swap(_receivedMessages);
+    _isReceiveNotificationPending = false;
+}
+
+bool WebRTCDataChannels::sendDataMessage(const SockAddr& destination, const QByteArray& byteArray, bool isUnreliable) {
 #ifdef WEBRTC_DEBUG
-    qCDebug(networking_webrtc) << "WebRTCDataChannels::sendDataMessage() :" << dataChannelID;
+    qCDebug(networking_webrtc) << "WebRTCDataChannels::sendDataMessage() :" << destination << isUnreliable;
 #endif
-
-    if (!_connectionsByID.contains(dataChannelID)) {
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    auto it = _peers.find(destination);
+    if (it == _peers.end()) {
         qCWarning(networking_webrtc) << "Could not find WebRTC data channel to send message on!";
         return false;
     }
 
-    auto connection = _connectionsByID.value(dataChannelID);
-    DataBuffer buffer(rtc::CopyOnWriteBuffer(byteArray.data(), byteArray.size()), true);
-    return connection->sendDataMessage(buffer);
+    auto& peer = it->second;
+    qint64 bufferedAmount = peer.stats.bufferedAmount + peer.stats.queuedBytes + byteArray.size();
+    if (bufferedAmount > MAX_WEBRTC_BUFFER_SIZE || isUnreliable && bufferedAmount > MAX_UNRELIABLE_BUFFER_SIZE) {
+        // Don't send, otherwise the data channel will be closed.
+        ++peer.stats.numMessagesDropped;
+#ifdef WEBRTC_DEBUG
+        qCDebug(networking_webrtc) << "WebRTC send buffer overflow";
+#endif
+        return false;
+    }
+
+    peer.outgoingMessages.push_back({ DataBuffer(rtc::CopyOnWriteBuffer(byteArray.data(), byteArray.size()), true),
+        isUnreliable });
+    peer.stats.queuedBytes += byteArray.size();
+    if (!_isSendTaskPosted) {
+        _isSendTaskPosted = true;
+        postSendTask();
+    }
+    return true;
+}
+
+void WebRTCDataChannels::postSendTask() {
+// NOTE: this indicates a newer WebRTC build in use on linux,
+// TODO: remove the old code when windows WebRTC is updated as well
+#ifdef API_SET_LOCAL_DESCRIPTION_OBSERVER_INTERFACE_H_
+    _rtcSignalingThread->PostTask([this]() { sendQueuedDataMessages(); });
+#else
+    _rtcSignalingThread->PostTask(RTC_FROM_HERE, [this]() { sendQueuedDataMessages(); });
+#endif
+}
+
+void WebRTCDataChannels::sendQueuedDataMessages() {
+    // Runs on the WebRTC signaling thread, where the data channels live, so that sending doesn't block on a thread hop.
+    struct PeerMessages {
+        SockAddr address;
+        rtc::scoped_refptr<DataChannelInterface> dataChannel;
+        rtc::scoped_refptr<DataChannelInterface> unreliableDataChannel;
+        std::vector<OutgoingMessage> messages;
+        qint64 sentBytes { 0 };
+        qint64 bufferedAmount { 0 };
+        quint64 numSent { 0 };
+        quint64 numDropped { 0 };
+    };
+    std::vector<PeerMessages> peersMessages;
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        _isSendTaskPosted = false;
+        for (auto& peer : _peers) {
+            if (peer.second.outgoingMessages.empty()) {
+                continue;
+            }
+            PeerMessages peerMessages;
+            peerMessages.address = peer.first;
+            peerMessages.dataChannel = peer.second.connection->getDataChannel(false);
+            peerMessages.unreliableDataChannel = peer.second.connection->getDataChannel(true);
+            peerMessages.messages.swap(peer.second.outgoingMessages);
+            peersMessages.push_back(std::move(peerMessages));
+        }
+    }
+
+    // The channels are sent on without the lock held: closing a peer connection waits on this thread while holding it.
+    for (auto& peerMessages : peersMessages) {
+        auto& dataChannel = peerMessages.dataChannel;
+        auto& unreliableDataChannel = peerMessages.unreliableDataChannel;
+        bool isOpen = dataChannel && dataChannel->state() == DataChannelInterface::kOpen;
+        bool isUnreliableOpen = unreliableDataChannel && unreliableDataChannel->state() == DataChannelInterface::kOpen;
+
+        for (auto& message : peerMessages.messages) {
+            peerMessages.sentBytes += message.buffer.size();
+            bool isSent;
+            if (message.isUnreliable && isUnreliableOpen) {
+                isSent = unreliableDataChannel->Send(message.buffer);
+            } else {
+                // Data channel may have been closed while message to send was being prepared.
+                isSent = isOpen && dataChannel->Send(message.buffer);
+            }
+            if (isSent) {
+                ++peerMessages.numSent;
+            } else {
+                ++peerMessages.numDropped;
+            }
+        }
+
+        peerMessages.bufferedAmount = (isOpen ? dataChannel->buffered_amount() : 0)
+            + (isUnreliableOpen ? unreliableDataChannel->buffered_amount() : 0);
+        if (!isUnreliableOpen) {
+            unreliableDataChannel = nullptr;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    for (auto& peerMessages : peersMessages) {
+        auto it = _peers.find(peerMessages.address);
+        if (it == _peers.end()) {
+            continue;
+        }
+        auto& stats = it->second.stats;
+        stats.queuedBytes = std::max(stats.queuedBytes - peerMessages.sentBytes, (qint64)0);
+        stats.bufferedAmount = peerMessages.bufferedAmount;
+        stats.numMessagesSent += peerMessages.numSent;
+        stats.numMessagesDropped += peerMessages.numDropped;
+        stats.hasUnreliableChannel = peerMessages.unreliableDataChannel != nullptr;
+    }
 }
 
 qint64 WebRTCDataChannels::getBufferedAmount(const SockAddr& address) const {
-    auto dataChannelID = address.toShortString();
-    if (!_connectionsByID.contains(dataChannelID)) {
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    auto it = _peers.find(address);
+    if (it == _peers.end()) {
 #ifdef WEBRTC_DEBUG
-        qCDebug(networking_webrtc) << "WebRTCDataChannels::getBufferedAmount() : Channel doesn't exist:" << dataChannelID;
+        qCDebug(networking_webrtc) << "WebRTCDataChannels::getBufferedAmount() : Channel doesn't exist:" << address;
 #endif
         return 0;
     }
-    auto connection = _connectionsByID.value(dataChannelID);
-    return connection->getBufferedAmount();
+    return it->second.stats.bufferedAmount + it->second.stats.queuedBytes;
+}
+
+std::vector<std::pair<SockAddr, WebRTCDataChannels::DataChannelStats>> WebRTCDataChannels::getDataChannelStats() const {
+    std::vector<std::pair<SockAddr, DataChannelStats>> stats;
+    std::lock_guard<std::mutex> lock(_connectionsMutex);
+    stats.reserve(_peers.size());
+    for (auto& peer : _peers) {
+        stats.emplace_back(peer.first, peer.second.stats);
+        stats.back().second.numMessagesReceived = peer.second.connection->getNumMessagesReceived();
+    }
+    return stats;
 }
 
 rtc::scoped_refptr<PeerConnectionInterface> WebRTCDataChannels::createPeerConnection(
@@ -720,6 +862,16 @@ void WebRTCDataChannels::closePeerConnectionNow(WDCConnection* connection) {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "WebRTCDataChannels::closePeerConnectionNow()";
 #endif
+    // Stop sending to the connection, a send task that has already taken its data channels holds on to them.
+    {
+        std::lock_guard<std::mutex> lock(_connectionsMutex);
+        _connectionsByID.remove(connection->getDataChannelID());
+        auto it = _peers.find(connection->getAddress());
+        if (it != _peers.end() && it->second.connection == connection) {
+            _peers.erase(it);
+        }
+    }
+
     // Close the peer connection.
     connection->closePeerConnection();
 
@@ -727,7 +879,6 @@ void WebRTCDataChannels::closePeerConnectionNow(WDCConnection* connection) {
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "Dispose of connection for channel:" << connection->getDataChannelID();
 #endif
-    _connectionsByID.remove(connection->getDataChannelID());
     delete connection;
 #ifdef WEBRTC_DEBUG
     qCDebug(networking_webrtc) << "Disposed of connection";
@@ -15,6 +15,12 @@
 #if defined(WEBRTC_DATA_CHANNELS)
 
 
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
 #include <QObject>
 #include <QHash>
 
@@ -143,7 +149,8 @@ public:
 
     /// @brief Constructs a data channel observer.
     /// @param parent The parent connection object.
-    WDCDataChannelObserver(WDCConnection* parent);
+    /// @param isUnreliable Whether the observer is for the connection's unreliable data channel.
+    WDCDataChannelObserver(WDCConnection* parent, bool isUnreliable = false);
 
     /// @brief The data channel state changed.
     void OnStateChange() override;
@@ -154,11 +161,15 @@ public:
 
 private:
     WDCConnection* _parent;
+    bool _isUnreliable;
 };
 
 
 /// @brief A WebRTC data channel connection.
 /// @details Opens and manages a WebRTC data channel connection.
+///
+/// The Interface client may open a second data channel that is unordered or doesn't retransmit. Unreliable packets are
+/// sent on that channel instead of the main one, so that a lost audio or avatar packet doesn't hold up the ones after it.
 class WDCConnection {
 
 public:
@@ -172,6 +183,9 @@ public:
     /// @return The data channel ID.
     QString getDataChannelID() const { return _dataChannelID; }
 
+    /// @brief Gets the data channel's address, parsed from its ID.
+    /// @return The address of the signaling WebSocket that the client used to connect.
+    const SockAddr& getAddress() const { return _address; }
 
     /// @brief Sets the remote session description received from the remote client via the signaling channel.
     /// @param description The remote session description.
@@ -200,27 +214,32 @@ public:
     /// @param state The new peer connection state.
     void onPeerConnectionStateChanged(webrtc::PeerConnectionInterface::PeerConnectionState state);
 
-    /// @brief Handles the WebRTC data channel being opened.
+    /// @brief Handles a WebRTC data channel being opened.
+    /// @details A channel that is unordered or doesn't retransmit becomes the unreliable data channel, any other the main one.
     /// @param dataChannel The WebRTC data channel.
     void onDataChannelOpened(rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel);
 
-    /// @brief Handles a change in the state of the WebRTC data channel.
-    void onDataChannelStateChanged();
+    /// @brief Handles a change in the state of a WebRTC data channel.
+    /// @details Closing the main data channel closes the peer connection, closing the unreliable one doesn't.
+    /// @param isUnreliable Whether the change is of the unreliable data channel.
+    void onDataChannelStateChanged(bool isUnreliable);
 
 
-    /// @brief Handles a message being received on the WebRTC data channel.
+    /// @brief Handles a message being received on a WebRTC data channel.
     /// @param buffer The message received.
     void onDataChannelMessageReceived(const webrtc::DataBuffer& buffer);
 
-    /// @brief Gets the number of bytes waiting to be sent on the WebRTC data channel.
-    /// @return The number of bytes waiting to be sent on the WebRTC data channel.
-    qint64 getBufferedAmount() const;
-
+    /// @brief Gets a WebRTC data channel to send on.
+    /// @details Only called on the WebRTC signaling thread, where the channels are opened.
+    /// @param isUnreliable Whether to get the unreliable data channel rather than the main one.
+    /// @return The data channel, <code>nullptr</code> if it hasn't been opened.
+    rtc::scoped_refptr<webrtc::DataChannelInterface> getDataChannel(bool isUnreliable) const {
+        return isUnreliable ? _unreliableDataChannel : _dataChannel;
+    }
 
-    /// @brief Sends a message on the WebRTC data channel.
-    /// @param buffer The message to send.
-    /// @return `true` if the message was sent, otherwise `false`.
-    bool sendDataMessage(const webrtc::DataBuffer& buffer);
+    /// @brief Gets the number of messages received on the WebRTC data channels.
+    /// @return The number of messages received.
+    quint64 getNumMessagesReceived() const { return _numMessagesReceived; }
 
     /// @brief Closes the WebRTC peer connection.
     void closePeerConnection();
@@ -228,6 +247,7 @@ public:
 private:
     WebRTCDataChannels* _parent;
     QString _dataChannelID;
+    SockAddr _address;
 
     rtc::scoped_refptr<WDCSetLocalDescriptionObserver> _setLocalDescriptionObserver { nullptr };
     rtc::scoped_refptr<WDCSetRemoteDescriptionObserver> _setRemoteDescriptionObserver { nullptr };
@@ -236,6 +256,11 @@ private:
     std::shared_ptr<WDCDataChannelObserver> _dataChannelObserver { nullptr };
     rtc::scoped_refptr<webrtc::DataChannelInterface> _dataChannel { nullptr };
 
+    std::shared_ptr<WDCDataChannelObserver> _unreliableDataChannelObserver { nullptr };
+    rtc::scoped_refptr<webrtc::DataChannelInterface> _unreliableDataChannel { nullptr };
+
+    std::atomic<quint64> _numMessagesReceived { 0 };
+
     std::shared_ptr<WDCPeerConnectionObserver> _peerConnectionObserver { nullptr };
     rtc::scoped_refptr<webrtc::PeerConnectionInterface> _peerConnection { nullptr };
 };
@@ -256,11 +281,32 @@ private:
 /// A WebRTC data channel is identified by the IP address and port of the client WebSocket that was used when opening the data
 /// channel - this is considered to be the WebRTC data channel's address. The IP address and port of the actual WebRTC
 /// connection is not used.
+///
+/// Messages are handed between the WebRTC threads and the socket's thread in batches: received messages are queued without
+/// being copied and a single dataMessagesReceived signal announces them all, and messages to send are queued per client and
+/// sent together by one task on the WebRTC signaling thread. The send buffer of each client's data channels is tracked as
+/// part of that task, so that bytes waiting to be written can be read without having to wait on the WebRTC threads.
 class WebRTCDataChannels : public QObject {
     Q_OBJECT
 
 public:
 
+    /// @brief The state of the data channels to an Interface client.
+    struct DataChannelStats {
+        qint64 queuedBytes { 0 }; ///< Bytes queued to be sent by the WebRTC signaling thread.
+        qint64 bufferedAmount { 0 }; ///< Bytes in the data channels' send buffers after they were last sent on.
+        quint64 numMessagesSent { 0 };
+        quint64 numMessagesDropped { 0 }; ///< Messages not sent because the send buffers were full or closed.
+        quint64 numMessagesReceived { 0 };
+        bool hasUnreliableChannel { false };
+    };
+
+    /// @brief A data message received from an Interface client.
+    struct ReceivedMessage {
+        SockAddr address;
+        rtc::CopyOnWriteBuffer data;
+    };
+
     /// @brief Constructs a new WebRTCDataChannels object.
     /// @param parent The parent Qt object.
     WebRTCDataChannels(QObject* parent);
@@ -286,22 +332,34 @@ public:
     /// @param message The WebRTC signaling message to send.
     void sendSignalingMessage(const QJsonObject& message);
 
-    /// @brief Emits a dataMessage received from the Interface client.
-    /// @param dataChannelID The IP address and port of the signaling WebSocket that the client used to connect, `"n.n.n.n:n"`.
-    /// @param byteArray The data message received.
-    void emitDataMessage(const QString& dataChannelID, const QByteArray& byteArray);
+    /// @brief Queues a data message received from the Interface client to be read.
+    /// @details Called on a WebRTC thread. Emits dataMessagesReceived if the queue was empty.
+    /// @param address The address of the signaling WebSocket that the client used to connect.
+    /// @param data The data message received.
+    void queueReceivedMessage(const SockAddr& address, const rtc::CopyOnWriteBuffer& data);
 
-    /// @brief Sends a data message to an Interface client.
-    /// @param dataChannelID The IP address and port of the signaling WebSocket that the client used to connect, `"n.n.n.n:n"`.
+    /// @brief Takes all the data messages received since the last call.
+    /// @param messages The empty queue to put the messages in.
+    void takeReceivedMessages(std::deque<ReceivedMessage>& messages) const;
+
+    /// @brief Queues a data message to be sent to an Interface client.
+    /// @details The message is dropped if the client's send buffers are too full. An unreliable message is dropped sooner,
+    /// since it would be stale by the time it arrived, and is sent on the client's unreliable data channel if it has one.
+    /// @param destination The address of the signaling WebSocket that the client used to connect.
     /// @param message The data message to send.
-    /// @return `true` if the data message was sent, otherwise `false`.
-    bool sendDataMessage(const SockAddr& destination, const QByteArray& message);
+    /// @param isUnreliable Whether the message doesn't need to be delivered, or in order.
+    /// @return `true` if the data message was queued, otherwise `false`.
+    bool sendDataMessage(const SockAddr& destination, const QByteArray& message, bool isUnreliable = false);
 
-    /// @brief Gets the number of bytes waiting to be sent on a data channel.
+    /// @brief Gets the number of bytes waiting to be sent on a client's data channels.
     /// @param address The address of the signaling WebSocket that the client used to connect.
-    /// @return The number of bytes waiting to be sent on the data channel.
+    /// @return The number of bytes queued and in the send buffers, as of the last time the data channels were sent on.
     qint64 getBufferedAmount(const SockAddr& address) const;
 
+    /// @brief Gets the state of the data channels to each Interface client.
+    /// @return The address of each client and the state of its data channels.
+    std::vector<std::pair<SockAddr, DataChannelStats>> getDataChannelStats() const;
+
     /// @brief Creates a new WebRTC peer connection for connecting to an Interface client.
     /// @param peerConnectionObserver An observer to monitor the WebRTC peer connection.
     /// @return The new WebRTC peer connection.
@@ -337,11 +395,10 @@ signals:
     /// @param message The WebRTC signaling message to send.
     void signalingMessage(const QJsonObject& message);
 
-    /// @brief A WebRTC data message received from the Interface client.
-    /// @details This message is for handling at a higher level in the Vircadia protocol.
-    /// @param address The address of the signaling WebSocket that the client used to connect.
-    /// @param byteArray The Vircadia protocol message.
-    void dataMessage(const SockAddr& address, const QByteArray& byteArray);
+    /// @brief WebRTC data messages have been received from Interface clients.
+    /// @details Emitted on a WebRTC thread when a message is queued for reading and no earlier one is waiting to be taken.
+    ///     The messages are for handling at a higher level in the Vircadia protocol and are read with takeReceivedMessages.
+    void dataMessagesReceived();
 
     /// @brief Signals that the peer connection for a WebRTC data channel should be closed.
     /// @details Used by {@link WebRTCDataChannels.closePeerConnection}.
@@ -350,6 +407,20 @@ signals:
 
 private:
 
+    struct OutgoingMessage {
+        webrtc::DataBuffer buffer;
+        bool isUnreliable;
+    };
+
+    struct Peer {
+        WDCConnection* connection { nullptr };
+        std::vector<OutgoingMessage> outgoingMessages;
+        DataChannelStats stats;
+    };
+
+    void postSendTask();
+    void sendQueuedDataMessages();
+
     QObject* _parent;
 
     NodeType_t _nodeType { NodeType::Unassigned };
@@ -360,9 +431,17 @@ private:
 
     rtc::scoped_refptr<webrtc::PeerConnectionFactoryInterface> _peerConnectionFactory { nullptr };
 
+    mutable std::mutex _connectionsMutex;  // Guards the connections and peers, which are used on the WebRTC threads too.
     QHash<QString, WDCConnection*> _connectionsByID;  // <client data channel ID, WDCConnection>
     // The client's WebSocket IP and port is used as the data channel ID to uniquely identify each.
     // The WebSocket IP address and port is formatted as "n.n.n.n:n", the same as used in WebRTCSignalingServer.
+    std::unordered_map<SockAddr, Peer> _peers;  // The clients whose data channels have opened.
+    bool _isSendTaskPosted { false };
+
+    // Taken by the socket's const readers.
+    mutable std::mutex _receivedMessagesMutex;
+    mutable std::deque<ReceivedMessage> _receivedMessages;
+    mutable bool _isReceiveNotificationPending { false };
 
     std::vector<webrtc::PeerConnectionInterface::IceServer> _iceServers {};
 };
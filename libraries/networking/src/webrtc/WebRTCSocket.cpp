@@ -11,10 +11,13 @@
 
 #if defined(WEBRTC_DATA_CHANNELS)
 
+#include <cstring>
+
 #include <QHostAddress>
 
 #include "../NetworkLogging.h"
 #include "../udt/Constants.h"
+#include "../udt/Packet.h"
 
 
 WebRTCSocket::WebRTCSocket(QObject* parent) :
@@ -25,8 +28,8 @@ WebRTCSocket::WebRTCSocket(QObject* parent) :
     connect(this, &WebRTCSocket::onSignalingMessage, &_dataChannels, &WebRTCDataChannels::onSignalingMessage);
     connect(&_dataChannels, &WebRTCDataChannels::signalingMessage, this, &WebRTCSocket::sendSignalingMessage);
 
-    // Route received data channel messages.
-    connect(&_dataChannels, &WebRTCDataChannels::dataMessage, this, &WebRTCSocket::onDataChannelReceivedMessage);
+    // Announce received data channel messages, they are taken from the data channels when read.
+    connect(&_dataChannels, &WebRTCDataChannels::dataMessagesReceived, this, &WebRTCSocket::readyRead);
 }
 
 void WebRTCSocket::setSocketOption(QAbstractSocket::SocketOption option, const QVariant& value) {
@@ -81,7 +84,17 @@ void WebRTCSocket::abort() {
 
 qint64 WebRTCSocket::writeDatagram(const QByteArray& datagram, const SockAddr& destination) {
     clearError();
-    if (_dataChannels.sendDataMessage(destination, datagram)) {
+
+    // Unreliable packets that aren't part of a message can go on the unreliable data channel.
+    bool isUnreliable = false;
+    udt::Packet::SequenceNumberAndBitField sequenceNumberAndBitField;
+    if (datagram.size() >= (int)sizeof(sequenceNumberAndBitField)) {
+        memcpy(&sequenceNumberAndBitField, datagram.constData(), sizeof(sequenceNumberAndBitField));
+        isUnreliable = (sequenceNumberAndBitField
+            & (udt::CONTROL_BIT_MASK | udt::RELIABILITY_BIT_MASK | udt::MESSAGE_BIT_MASK)) == 0;
+    }
+
+    if (_dataChannels.sendDataMessage(destination, datagram, isUnreliable)) {
         return datagram.length();
     }
     setError(QAbstractSocket::SocketError::UnknownSocketError, "Failed to write datagram");
@@ -93,35 +106,43 @@ qint64 WebRTCSocket::bytesToWrite(const SockAddr& destination) const {
 }
 
 
+bool WebRTCSocket::takeReceivedMessages() const {
+    if (_receivedMessages.empty()) {
+        _dataChannels.takeReceivedMessages(_receivedMessages);
+    }
+    return !_receivedMessages.empty();
+}
+
 bool WebRTCSocket::hasPendingDatagrams() const {
-    return _receivedQueue.length() > 0;
+    return takeReceivedMessages();
 }
 
 qint64 WebRTCSocket::pendingDatagramSize() const {
-    if (_receivedQueue.length() > 0) {
-        return _receivedQueue.head().second.length();
+    if (takeReceivedMessages()) {
+        return (qint64)_receivedMessages.front().data.size();
     }
     return -1;
 }
 
 qint64 WebRTCSocket::readDatagram(char* data, qint64 maxSize, QHostAddress* address, quint16* port) {
     clearError();
-    if (_receivedQueue.length() > 0) {
-        auto datagram = _receivedQueue.dequeue();
-        auto length = std::min((qint64)datagram.second.length(), maxSize);
+    if (takeReceivedMessages()) {
+        auto& message = _receivedMessages.front();
+        auto length = std::min((qint64)message.data.size(), maxSize);
 
         if (data) {
-            memcpy(data, datagram.second.constData(), length);
+            memcpy(data, message.data.data(), length);
         }
 
         if (address) {
-            *address = datagram.first.getAddress();
+            *address = message.address.getAddress();
         }
 
         if (port) {
-            *port = datagram.first.getPort();
+            *port = message.address.getPort();
         }
 
+        _receivedMessages.pop_front();
         return length;
     }
     setError(QAbstractSocket::SocketError::UnknownSocketError, "Failed to read datagram");
@@ -167,10 +188,4 @@ void WebRTCSocket::clearError() {
     _lastErrorString = QString();
 }
 
-
-void WebRTCSocket::onDataChannelReceivedMessage(const SockAddr& source, const QByteArray& message) {
-    _receivedQueue.enqueue(QPair<SockAddr, QByteArray>(source, message));
-    emit readyRead();
-}
-
 #endif // WEBRTC_DATA_CHANNELS
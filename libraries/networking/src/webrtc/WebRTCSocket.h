@@ -14,9 +14,10 @@
 
 #if defined(WEBRTC_DATA_CHANNELS)
 
+#include <deque>
+
 #include <QAbstractSocket>
 #include <QObject>
-#include <QQueue>
 
 #include "WebRTCDataChannels.h"
 
@@ -29,6 +30,8 @@
 /// @details A WebRTC data channel is identified by the IP address and port of the client WebSocket that was used when opening
 /// the data channel - this is considered to be the WebRTC data channel's address. The IP address and port of the actual WebRTC
 /// connection is not used.
+///
+/// Unreliable Vircadia protocol packets are sent on a client's unreliable data channel, if it opened one.
 class WebRTCSocket : public QObject {
     Q_OBJECT
 
@@ -97,6 +100,12 @@ public:
     /// @return The number of bytes waiting to be written.
     qint64 bytesToWrite(const SockAddr& destination) const;
 
+    /// @brief Gets the state of the data channels to each Interface client.
+    /// @return The address of each client and the state of its data channels.
+    std::vector<std::pair<SockAddr, WebRTCDataChannels::DataChannelStats>> getDataChannelStats() const {
+        return _dataChannels.getDataChannelStats();
+    }
+
     /// @brief Gets whether there's a datagram waiting to be read.
     /// @return <code>true</code> if there's a datagram waiting to be read, <code>false</code> if there isn't.
     bool hasPendingDatagrams() const;
@@ -127,21 +136,14 @@ public:
     /// @param iceServers The list of STUN/TURN servers.
     void setWebRTCIceServers(QList<QVariant> iceServers);
 
-public slots:
-
-    /// @brief Handles the WebRTC data channel receiving a message.
-    /// @details Queues the message to be read via readDatagram.
-    /// @param source The WebRTC data channel that the message was received on.
-    /// @param message The message that was received.
-    void onDataChannelReceivedMessage(const SockAddr& source, const QByteArray& message);
-
 signals:
 
     /// @brief Emitted when the state of the socket changes.
     /// @param socketState The new state of the socket.
     void stateChanged(QAbstractSocket::SocketState socketState);
 
-    /// @brief Emitted each time new data becomes available for reading.
+    /// @brief Emitted when new data becomes available for reading.
+    /// @details Emitted once for all the messages that arrive before the pending ones are read.
     void readyRead();
 
     /// @brief Emitted when a WebRTC signaling message has been received from the signaling server for this WebRTCSocket.
@@ -157,12 +159,14 @@ private:
 
     void setError(QAbstractSocket::SocketError errorType, QString errorString);
     void clearError();
+    bool takeReceivedMessages() const;
 
     WebRTCDataChannels _dataChannels;
 
     bool _isBound { false };
 
-    QQueue<QPair<SockAddr, QByteArray>> _receivedQueue;  // Messages received are queued for reading from the "socket".
+    // Messages received are taken from the data channels a batch at a time, for reading from the "socket".
+    mutable std::deque<WebRTCDataChannels::ReceivedMessage> _receivedMessages;
 
     QAbstractSocket::SocketError _lastErrorType { QAbstractSocket::UnknownSocketError };
     QString _lastErrorString;
@@ -48,11 +48,13 @@
 
 #include "OctreeConstants.h"
 #include "OctreeLogging.h"
+#include "OctreeJournal.h"
 #include "OctreeQueryNode.h"
+#include "OctreeSnapshot.h"
 #include "OctreeUtils.h"
 #include "OctreeEntitiesFileParser.h"
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", "bin"};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -675,6 +677,9 @@ bool Octree::readFromFile(const char* fileName) {
     if (qFileName.endsWith(".json.gz")) {
         return readJSONFromGzippedFile(qFileName);
     }
+    if (qFileName.endsWith(".bin")) {
+        return readSnapshotFile(qFileName);
+    }
 
     QFile file(qFileName);
 
@@ -714,6 +719,33 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
     return readJSONFromStream(-1, jsonStream, "", false, relativeURL);
 }
 
+bool Octree::readSnapshotFile(QString qFileName) {
+    OctreeSnapshotReader reader;
+    if (!reader.open(qFileName)) {
+        qCritical() << "Cannot read octree snapshot file: " << qFileName;
+        return false;
+    }
+
+    // snapshots hold the bitstream encoding of the version that wrote them, which can only be read by that version
+    PacketVersion expectedVersion = versionForPacketType(expectedDataPacketType());
+    if (reader.getBitstreamVersion() != expectedVersion) {
+        qCritical() << "Octree snapshot" << qFileName << "has bitstream version" << reader.getBitstreamVersion()
+            << "but this server reads version" << expectedVersion;
+        return false;
+    }
+
+    // the changes made since the snapshot was written, if the journal next to it still applies to it
+    OctreeJournalReader journal;
+    QString journalFileName = OctreeJournal::filenameForSnapshot(qFileName);
+    bool hasJournal = QFile::exists(journalFileName) && journal.open(journalFileName) &&
+        journal.getPersistID() == reader.getPersistID() && journal.getBaseDataVersion() == reader.getDataVersion() &&
+        journal.getBitstreamVersion() == reader.getBitstreamVersion();
+
+    qCDebug(octree) << "Reading octree snapshot with" << reader.getRecordCount() << "records and"
+        << (hasJournal ? (int)journal.getEntries().size() : 0) << "journal entries from" << qFileName;
+    return readFromSnapshot(reader, hasJournal ? &journal : nullptr);
+}
+
 // hack to get the marketplace id into the entities.  We will create a way to get this from a hash of
 // the entity later, but this helps us move things along for now
 QString getMarketplaceID(const QString& urlString) {
@@ -870,9 +902,15 @@ bool Octree::readJSONFromStream(
     octreeParser.setRelativeURL(relativeURL);
     octreeParser.setEntitiesString(jsonBuffer);
 
+    bool success = readFromParser(octreeParser, marketplaceID, isImport);
+    delete[] rawData;
+    return success;
+}
+
+bool Octree::readFromParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID, const bool isImport) {
     QVariantMap asMap;
-    if (!octreeParser.parseEntities(asMap)) {
-        qCritical() << "Couldn't parse Entities JSON:" << octreeParser.getErrorString().c_str();
+    if (!parser.parseEntities(asMap)) {
+        qCritical() << "Couldn't parse Entities JSON:" << parser.getErrorString().c_str();
         return false;
     }
 
@@ -880,9 +918,7 @@ bool Octree::readJSONFromStream(
         addMarketplaceIDToDocumentEntities(asMap, marketplaceID);
     }
 
-    bool success = readFromMap(asMap, isImport);
-    delete[] rawData;
-    return success;
+    return readFromMap(asMap, isImport);
 }
 
 bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& element, QString persistAsFileType) {
@@ -896,6 +932,8 @@ bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& eleme
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == "bin") {
+        success = writeToSnapshotFile(cFileName);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -1001,6 +1039,43 @@ bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& e
     return success;
 }
 
+bool Octree::toSnapshot(QByteArray* data) {
+    PacketVersion expectedVersion = versionForPacketType(expectedDataPacketType());
+    OctreeSnapshotWriter writer(_persistID, _persistDataVersion, expectedVersion);
+    if (!writeToSnapshot(writer)) {
+        return false;
+    }
+    *data = writer.finish();
+    return true;
+}
+
+bool Octree::writeToSnapshotFile(const char* fileName) {
+    qCDebug(octree, "Saving octree snapshot to file %s...", fileName);
+
+    QByteArray snapshotData;
+    if (!toSnapshot(&snapshotData)) {
+        qCritical("Failed to convert octree to a snapshot.");
+        return false;
+    }
+
+    QSaveFile persistFile(fileName);
+    bool success = false;
+    if (persistFile.open(QIODevice::WriteOnly)) {
+        if (persistFile.write(snapshotData) != -1) {
+            success = persistFile.commit();
+            if (!success) {
+                qCritical() << "Failed to commit to snapshot save file:" << persistFile.errorString();
+            }
+        } else {
+            qCritical("Failed to write to snapshot file.");
+        }
+    } else {
+        qCritical("Failed to open snapshot file for writing.");
+    }
+
+    return success;
+}
+
 uint64_t Octree::getOctreeElementsCount() {
     uint64_t nodeCount = 0;
     recurseTreeWithOperation(countOctreeElementsOperation, &nodeCount);
@@ -15,6 +15,7 @@
 #include <memory>
 #include <set>
 #include <stdint.h>
+#include <vector>
 
 #include <QHash>
 #include <QObject>
@@ -34,6 +35,11 @@ class ReadBitstreamToTreeParams;
 class Octree;
 class OctreeElement;
 class OctreePacketData;
+class OctreeEntitiesFileParser;
+class OctreeJournalReader;
+class OctreeJournalWriter;
+class OctreeSnapshotReader;
+class OctreeSnapshotWriter;
 class Shape;
 using OctreePointer = std::shared_ptr<Octree>;
 
@@ -138,6 +144,23 @@ public:
     virtual bool handlesEditPacketType(PacketType packetType) const { return false; }
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
+
+    // Edits of the types a tree can prepare don't need to hold the write lock for all of processEditPacketData: they are
+    // decoded on any thread, in order for each sender, and once a batch is decoded it is handed to editsDecoded, then
+    // validated on any thread and finally applied under the write lock in the order they were received.
+    class PreparedEdit {
+    public:
+        virtual ~PreparedEdit() {}
+        int bytesRead { 0 };
+    };
+    using PreparedEditPointer = std::unique_ptr<PreparedEdit>;
+    virtual bool canPrepareEditPacketType(PacketType packetType) const { return false; }
+    virtual PreparedEditPointer decodeEdit(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                           const SharedNodePointer& sourceNode) { return nullptr; }
+    virtual void editsDecoded(const std::vector<PreparedEdit*>& edits) { }
+    virtual void validateEdit(PreparedEdit& edit, const SharedNodePointer& sourceNode) { }
+    // NOTE: Caller must lock the tree before calling this.
+    virtual void applyEdit(PreparedEdit& edit, ReceivedMessage& message, const SharedNodePointer& sourceNode) { }
     virtual void processChallengeOwnershipRequestPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipReplyPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
     virtual void processChallengeOwnershipPacket(ReceivedMessage& message, const SharedNodePointer& sourceNode) { return; }
@@ -210,6 +233,14 @@ public:
     bool toJSON(QByteArray* data, const OctreeElementPointer& element = nullptr, bool doGzip = false);
     bool writeToFile(const char* filename, const OctreeElementPointer& element = nullptr, QString persistAsFileType = "json.gz");
     bool writeToJSONFile(const char* filename, const OctreeElementPointer& element = nullptr, bool doGzip = false);
+    bool toSnapshot(QByteArray* data);
+    bool writeToSnapshotFile(const char* filename);
+    virtual bool writeToSnapshot(OctreeSnapshotWriter& writer) = 0;
+
+    // while journaling is enabled the octree tracks its changes, and writeToJournal() adds those made since it was
+    // last called to the journal
+    virtual void setJournalEnabled(bool enabled) = 0;
+    virtual bool writeToJournal(OctreeJournalWriter& journal) = 0;
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
@@ -221,7 +252,12 @@ public:
     bool readFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="", const bool isImport = false, const QUrl& urlString = QUrl());
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const QString& marketplaceID="", const bool isImport = false, const QUrl& urlString = QUrl());
     bool readJSONFromGzippedFile(QString qFileName);
+    bool readSnapshotFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) = 0;
+    // reads the parsed JSON through readFromMap(), subclasses can instead consume the entities as they are parsed
+    virtual bool readFromParser(OctreeEntitiesFileParser& parser, const QString& marketplaceID, const bool isImport);
+    virtual bool readFromSnapshot(const OctreeSnapshotReader& reader, const OctreeJournalReader* journal = nullptr,
+                                  const bool isImport = false) = 0;
 
     uint64_t getOctreeElementsCount();
 
@@ -250,6 +286,8 @@ public:
         _persistID = id;
         _persistDataVersion = dataVersion;
     }
+    const QUuid& getPersistID() const { return _persistID; }
+    int64_t getPersistDataVersion() const { return _persistDataVersion; }
 
     virtual void resetEditStats() { }
     virtual quint64 getAverageDecodeTime() const { return 0; }
@@ -10,6 +10,7 @@
 
 #include "OctreeDataUtils.h"
 #include "OctreeEntitiesFileParser.h"
+#include "OctreeSnapshot.h"
 
 #include <Gzip.h>
 #include <udt/PacketHeaders.h>
@@ -60,6 +61,20 @@ bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromFile(QString path) {
     return readOctreeDataInfoFromData(data);
 }
 
+// Reads the header of an octree snapshot file, without reading any of its records.
+// Returns false if the file isn't an octree snapshot.
+bool OctreeUtils::RawOctreeData::readOctreeDataInfoFromSnapshot(QString path) {
+    OctreeSnapshotReader reader;
+    if (!reader.open(path)) {
+        return false;
+    }
+
+    id = reader.getPersistID();
+    dataVersion = reader.getDataVersion();
+    version = reader.getBitstreamVersion();
+    return true;
+}
+
 QByteArray OctreeUtils::RawOctreeData::toByteArray() {
     QByteArray jsonString;
 
@@ -42,6 +42,7 @@ public:
 
     bool readOctreeDataInfoFromData(QByteArray data);
     bool readOctreeDataInfoFromFile(QString path);
+    bool readOctreeDataInfoFromSnapshot(QString path);
     bool readOctreeDataInfoFromMap(const QVariantMap& map);
 };
 
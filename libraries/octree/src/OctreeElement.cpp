@@ -87,12 +87,9 @@ void OctreeElement::init(unsigned char * octalCode) {
 
 #ifdef SIMPLE_EXTERNAL_CHILDREN
     _childrenSingle.reset();
+    _externalChildren.reset();
 #endif
 
-    for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-        _externalChildren[i].reset();
-    }
-
     _isDirty = true;
     _shouldRender = false;
     _sourceUUIDKey = 0;
@@ -253,6 +250,13 @@ AtomicUIntStat OctreeElement::_setChildAtIndexCalls { 0 };
 AtomicUIntStat OctreeElement::_externalChildrenCount { 0 };
 AtomicUIntStat OctreeElement::_childrenCount[NUMBER_OF_CHILDREN + 1];
 
+#ifdef SIMPLE_EXTERNAL_CHILDREN
+// where a child is in the packed children: the number of children before it, bit 7 being child 0
+static inline int packedChildSlot(unsigned char childBitmask, int childIndex) {
+    return numberOfOnes((unsigned char)(childBitmask & (0xff00 >> childIndex)));
+}
+#endif
+
 OctreeElementPointer OctreeElement::getChildAtIndex(int childIndex) const {
 #ifdef SIMPLE_CHILD_ARRAY
     return _simpleChildArray[childIndex];
@@ -278,27 +282,31 @@ OctreeElementPointer OctreeElement::getChildAtIndex(int childIndex) const {
         } break;
 
         default : {
-            return _externalChildren[childIndex];
+            if (!oneAtBit(_childBitmask, childIndex)) {
+                return NULL;
+            }
+            return _externalChildren[packedChildSlot(_childBitmask, childIndex)];
         } break;
     }
 #endif // def SIMPLE_EXTERNAL_CHILDREN
 }
 
 void OctreeElement::deleteAllChildren() {
-    // first delete all the OctreeElement objects...
+#ifdef SIMPLE_CHILD_ARRAY
     for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
-        OctreeElementPointer childAt = getChildAtIndex(i);
-        if (childAt) {
-            childAt.reset();
-        }
+        _simpleChildArray[i].reset();
     }
+#endif
 
+#ifdef SIMPLE_EXTERNAL_CHILDREN
     if (_childrenExternal) {
-        // if the children_t union represents _children.external we need to delete it here
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
-        }
+        _externalChildrenMemoryUsage -= getChildCount() * sizeof(OctreeElementPointer);
+        _externalChildren.reset();
+        _childrenExternal = false;
     }
+    _childrenSingle.reset();
+#endif
+    _childBitmask = 0;
 }
 
 void OctreeElement::setChildAtIndex(int childIndex, const OctreeElementPointer& child) {
@@ -323,9 +331,7 @@ void OctreeElement::setChildAtIndex(int childIndex, const OctreeElementPointer&
 
 #ifdef SIMPLE_EXTERNAL_CHILDREN
 
-    int firstIndex = getNthBit(_childBitmask, 1);
-    int secondIndex = getNthBit(_childBitmask, 2);
-
+    unsigned char previousChildBitmask = _childBitmask;
     int previousChildCount = getChildCount();
     if (child) {
         setAtBit(_childBitmask, childIndex);
@@ -340,40 +346,51 @@ void OctreeElement::setChildAtIndex(int childIndex, const OctreeElementPointer&
         _childrenCount[newChildCount]++;
     }
 
-    if ((previousChildCount == 0 || previousChildCount == 1) && newChildCount == 0) {
-        _childrenSingle.reset();
-    } else if (previousChildCount == 0 && newChildCount == 1) {
-        _childrenSingle = child;
-    } else if (previousChildCount == 1 && newChildCount == 2) {
-        OctreeElementPointer previousChild = _childrenSingle;
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
+    if (_childBitmask == previousChildBitmask) {
+        // replacing a child keeps the layout
+        if (child) {
+            if (newChildCount == 1) {
+                _childrenSingle = child;
+            } else {
+                _externalChildren[packedChildSlot(_childBitmask, childIndex)] = child;
+            }
         }
-        _externalChildren[firstIndex] = previousChild;
-        _externalChildren[childIndex] = child;
-
-        _childrenExternal = true;
-
-        _externalChildrenMemoryUsage += NUMBER_OF_CHILDREN * sizeof(OctreeElementPointer);
-
-    } else if (previousChildCount == 2 && newChildCount == 1) {
-        assert(!child); // we are removing a child, so this must be true!
-        OctreeElementPointer previousFirstChild = _externalChildren[firstIndex];
-        OctreeElementPointer previousSecondChild = _externalChildren[secondIndex];
+        return;
+    }
 
-        for (int i = 0; i < NUMBER_OF_CHILDREN; i ++) {
-            _externalChildren[i].reset();
+    // a child came or went, so pack the children again, sized to exactly the children there are now
+    OctreeElementPointer children[NUMBER_OF_CHILDREN];
+    int numChildren = 0;
+    for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+        if (i == childIndex) {
+            if (child) {
+                children[numChildren++] = child;
+            }
+        } else if (oneAtBit(previousChildBitmask, i)) {
+            if (previousChildCount == 1) {
+                children[numChildren++] = std::move(_childrenSingle);
+            } else {
+                children[numChildren++] = std::move(_externalChildren[packedChildSlot(previousChildBitmask, i)]);
+            }
         }
-        _childrenExternal = false;
+    }
+    assert(numChildren == newChildCount);
 
-        _externalChildrenMemoryUsage -= NUMBER_OF_CHILDREN * sizeof(OctreeElementPointer);
-        if (childIndex == firstIndex) {
-            _childrenSingle = previousSecondChild;
-        } else {
-            _childrenSingle = previousFirstChild;
+    if (_childrenExternal) {
+        _externalChildrenMemoryUsage -= previousChildCount * sizeof(OctreeElementPointer);
+    }
+    _childrenSingle.reset();
+    _externalChildren.reset();
+    _childrenExternal = newChildCount > 1;
+
+    if (newChildCount == 1) {
+        _childrenSingle = std::move(children[0]);
+    } else if (newChildCount > 1) {
+        _externalChildren.reset(new OctreeElementPointer[newChildCount]);
+        for (int i = 0; i < newChildCount; i++) {
+            _externalChildren[i] = std::move(children[i]);
         }
-    } else {
-        _externalChildren[childIndex] = child;
+        _externalChildrenMemoryUsage += newChildCount * sizeof(OctreeElementPointer);
     }
 
 #endif // def SIMPLE_EXTERNAL_CHILDREN
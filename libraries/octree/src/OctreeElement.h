@@ -16,6 +16,7 @@
 #define SIMPLE_EXTERNAL_CHILDREN
 
 #include <atomic>
+#include <memory>
 
 #include <QReadWriteLock>
 
@@ -233,10 +234,9 @@ protected:
 #endif
 
 #ifdef SIMPLE_EXTERNAL_CHILDREN
-    // union children_t {
+    // a lone child is kept inline, two or more are packed in child index order, one slot per bit in _childBitmask
     OctreeElementPointer _childrenSingle;
-    OctreeElementPointer _externalChildren[NUMBER_OF_CHILDREN];
-    // } _children;
+    std::unique_ptr<OctreeElementPointer[]> _externalChildren;
 #endif
 
     uint16_t _sourceUUIDKey; /// Client only, stores node id of voxel server that sent his voxel, 2 bytes
@@ -40,6 +40,19 @@ void OctreeEntitiesFileParser::setEntitiesString(const QByteArray& entitiesConte
 }
 
 bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
+    QVariantList entitiesValue;
+    bool success = parseEntities(parsedEntities, [&entitiesValue](QJsonObject& entity) {
+        entitiesValue.append(entity);
+        return true;
+    });
+
+    if (success && parsedEntities.contains("Entities")) {
+        parsedEntities["Entities"] = std::move(entitiesValue);
+    }
+    return success;
+}
+
+bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities, const EntityCallback& entityCallback) {
     if (nextToken() != '{') {
         _errorString = "Text before start of object";
         return false;
@@ -49,6 +62,8 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
     bool gotEntities = false;
     bool gotId = false;
     bool gotVersion = false;
+    int entitiesPosition = 0;
+    int entitiesLine = 0;
 
     int token = nextToken();
 
@@ -87,12 +102,22 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
                 return false;
             }
 
-            QVariantList entitiesValue;
-            if (!readEntitiesArray(entitiesValue)) {
+            // skip the entities for now, they're read once the keys that describe them are known
+            entitiesPosition = _position;
+            entitiesLine = _line;
+            if (nextToken() != '[') {
+                _errorString = "Entities entry is not an array";
                 return false;
             }
 
-            parsedEntities["Entities"] = std::move(entitiesValue);
+            int matchingBracket = findMatchingBrace('[', ']');
+            if (matchingBracket < 0) {
+                _errorString = "Unterminated entities array";
+                return false;
+            }
+
+            parsedEntities["Entities"] = QVariantList();
+            _position = matchingBracket;
             gotEntities = true;
         } else if (key == "Id") {
             if (gotId) {
@@ -171,6 +196,12 @@ bool OctreeEntitiesFileParser::parseEntities(QVariantMap& parsedEntities) {
         return false;
     }
 
+    if (gotEntities) {
+        _position = entitiesPosition;
+        _line = entitiesLine;
+        return readEntitiesArray(entityCallback);
+    }
+
     return true;
 }
 
@@ -215,7 +246,7 @@ int OctreeEntitiesFileParser::readInteger() {
     return i;
 }
 
-bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
+bool OctreeEntitiesFileParser::readEntitiesArray(const EntityCallback& entityCallback) {
     if (nextToken() != '[') {
         _errorString = "Entities entry is not an array";
         return false;
@@ -327,7 +358,10 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
             }
         }
 
-        entitiesArray.append(entityObject);
+        if (!entityCallback(entityObject)) {
+            _errorString = "Entity rejected";
+            return false;
+        }
         _position = matchingBrace;
         char c = nextToken();
         if (c == ']') {
@@ -340,20 +374,16 @@ bool OctreeEntitiesFileParser::readEntitiesArray(QVariantList& entitiesArray) {
     return true;
 }
 
-int OctreeEntitiesFileParser::findMatchingBrace() const {
+int OctreeEntitiesFileParser::findMatchingBrace(char open, char close) const {
     int index = _position;
     int nestCount = 1;
     while (index < _entitiesLength && nestCount != 0) {
-        switch (_entitiesContents[index++]) {
-        case '{':
+        char c = _entitiesContents[index++];
+        if (c == open) {
             ++nestCount;
-            break;
-
-        case '}':
+        } else if (c == close) {
             --nestCount;
-            break;
-
-        case '"':
+        } else if (c == '"') {
             // Skip string
             while (index < _entitiesLength) {
                 if (_entitiesContents[index] == '"') {
@@ -364,10 +394,6 @@ int OctreeEntitiesFileParser::findMatchingBrace() const {
                 }
                 ++index;
             }
-            break;
-
-        default:
-            break;
         }
     }
 
@@ -14,23 +14,32 @@
 #ifndef hifi_OctreeEntitiesFileParser_h
 #define hifi_OctreeEntitiesFileParser_h
 
+#include <functional>
+
 #include <QByteArray>
+#include <QJsonObject>
 #include <QUrl>
 #include <QVariant>
 
 class OctreeEntitiesFileParser {
 public:
+    // receives each entity in file order, returning false stops parsing
+    using EntityCallback = std::function<bool(QJsonObject& entity)>;
+
     void setEntitiesString(const QByteArray& entitiesContents);
     void setRelativeURL(const QUrl& relativeURL) { _relativeURL = relativeURL; }
     bool parseEntities(QVariantMap& parsedEntities);
+    // Streams the entities to entityCallback instead of collecting them in parsedEntities. The rest of the top-level
+    // object is parsed first, so parsedEntities is complete by the time the first entity is passed on.
+    bool parseEntities(QVariantMap& parsedEntities, const EntityCallback& entityCallback);
     std::string getErrorString() const;
 
 private:
     int nextToken();
     std::string readString();
     int readInteger();
-    bool readEntitiesArray(QVariantList& entitiesArray);
-    int findMatchingBrace() const;
+    bool readEntitiesArray(const EntityCallback& entityCallback);
+    int findMatchingBrace(char open = '{', char close = '}') const;
 
     QByteArray _entitiesContents;
     QUrl _relativeURL;
@@ -0,0 +1,234 @@
+//
+//  OctreeJournal.cpp
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeJournal.h"
+
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <QtCore/QDebug>
+
+#include <UUID.h>
+
+#include "OctreeLogging.h"
+
+namespace {
+
+const char JOURNAL_MAGIC[8] = { 'O', 'C', 'T', 'J', 'R', 'N', 'L', '\0' };
+
+// the on-disk layouts, written in host byte order like the rest of the octree bitstream
+struct FileHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t bitstreamVersion;
+    char persistID[NUM_BYTES_RFC4122_UUID];
+    int64_t baseDataVersion;
+};
+static_assert(sizeof(FileHeader) == 40, "journal header layout changed");
+
+struct FileEntryHeader {
+    uint32_t size;
+    uint16_t checksum; // of the entry's data, to find entries that were torn by a crash
+    uint8_t operation;
+    uint8_t encoding;
+    char id[NUM_BYTES_RFC4122_UUID];
+};
+static_assert(sizeof(FileEntryHeader) == 24, "journal entry layout changed");
+
+bool syncToDisk(QFile& file) {
+    if (!file.flush()) {
+        return false;
+    }
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
+
+}
+
+QString OctreeJournal::filenameForSnapshot(const QString& snapshotFilename) {
+    return snapshotFilename + ".journal";
+}
+
+bool OctreeJournalWriter::open(const QString& filename, const QUuid& persistID, int64_t baseDataVersion,
+                               PacketVersion bitstreamVersion) {
+    _file.close();
+    _file.setFileName(filename);
+    _pending.clear();
+
+    qint64 validSize = 0;
+    if (QFile::exists(filename)) {
+        OctreeJournalReader existing;
+        if (existing.open(filename) && existing.getPersistID() == persistID &&
+            existing.getBaseDataVersion() == baseDataVersion && existing.getBitstreamVersion() == bitstreamVersion) {
+            validSize = existing.getValidSize();
+        }
+    }
+
+    if (validSize == 0) {
+        return reset(persistID, baseDataVersion, bitstreamVersion);
+    }
+
+    // drop anything after the last complete entry, so the next batch follows it directly
+    if (!_file.open(QIODevice::ReadWrite) || !_file.resize(validSize) || !_file.seek(validSize)) {
+        qCWarning(octree) << "Cannot continue journal" << filename << _file.errorString();
+        _file.close();
+        return false;
+    }
+    _size = validSize;
+    return true;
+}
+
+bool OctreeJournalWriter::reset(const QUuid& persistID, int64_t baseDataVersion, PacketVersion bitstreamVersion) {
+    _file.close();
+    _pending.clear();
+    _size = 0;
+
+    if (!_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qCWarning(octree) << "Cannot open journal" << _file.fileName() << "for writing:" << _file.errorString();
+        return false;
+    }
+
+    FileHeader header;
+    memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+    header.formatVersion = OctreeJournal::FORMAT_VERSION;
+    header.bitstreamVersion = bitstreamVersion;
+    memcpy(header.persistID, persistID.toRfc4122().constData(), sizeof(header.persistID));
+    header.baseDataVersion = baseDataVersion;
+
+    if (_file.write((const char*)&header, sizeof(header)) != (qint64)sizeof(header) || !syncToDisk(_file)) {
+        qCWarning(octree) << "Cannot write journal header to" << _file.fileName() << _file.errorString();
+        _file.close();
+        return false;
+    }
+    _size = sizeof(header);
+    return true;
+}
+
+void OctreeJournalWriter::addEdit(const QUuid& id, OctreeSnapshot::Encoding encoding, const QByteArray& data) {
+    addEntry(OctreeJournal::Operation::Edit, id, encoding, data);
+}
+
+void OctreeJournalWriter::addErase(const QUuid& id) {
+    addEntry(OctreeJournal::Operation::Erase, id, OctreeSnapshot::Encoding::Properties, QByteArray());
+}
+
+void OctreeJournalWriter::addEntry(OctreeJournal::Operation operation, const QUuid& id, OctreeSnapshot::Encoding encoding,
+                                   const QByteArray& data) {
+    FileEntryHeader entryHeader;
+    entryHeader.size = data.size();
+    entryHeader.checksum = qChecksum(data.constData(), data.size());
+    entryHeader.operation = (uint8_t)operation;
+    entryHeader.encoding = (uint8_t)encoding;
+    memcpy(entryHeader.id, id.toRfc4122().constData(), sizeof(entryHeader.id));
+
+    _pending.append((const char*)&entryHeader, sizeof(entryHeader));
+    _pending.append(data);
+}
+
+bool OctreeJournalWriter::flush() {
+    if (_pending.isEmpty()) {
+        return true;
+    }
+    if (!_file.isOpen()) {
+        return false;
+    }
+
+    if (_file.write(_pending) != _pending.size() || !syncToDisk(_file)) {
+        qCWarning(octree) << "Failed to append to journal" << _file.fileName() << _file.errorString();
+        return false;
+    }
+    _size += _pending.size();
+    _pending.clear();
+    return true;
+}
+
+bool OctreeJournalReader::open(const QString& filename) {
+    _file.setFileName(filename);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(octree) << "Cannot open journal for reading:" << filename << _file.errorString();
+        return false;
+    }
+
+    qint64 size = _file.size();
+    const uchar* mapped = size > 0 ? _file.map(0, size) : nullptr;
+    if (!mapped) {
+        qCWarning(octree) << "Cannot map journal:" << filename << _file.errorString();
+        return false;
+    }
+    return parse((const char*)mapped, size);
+}
+
+bool OctreeJournalReader::setData(const QByteArray& data) {
+    return parse(data.constData(), data.size());
+}
+
+bool OctreeJournalReader::parse(const char* data, qint64 size) {
+    _entries.clear();
+    _validSize = 0;
+
+    FileHeader header;
+    if (size < (qint64)sizeof(header)) {
+        qCWarning(octree) << "Journal is too short for its header:" << size << "bytes";
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) != 0) {
+        qCWarning(octree) << "Not an octree journal";
+        return false;
+    }
+    if (header.formatVersion != OctreeJournal::FORMAT_VERSION) {
+        qCWarning(octree) << "Unsupported octree journal format version" << header.formatVersion;
+        return false;
+    }
+
+    _persistID = QUuid::fromRfc4122(QByteArray::fromRawData(header.persistID, sizeof(header.persistID)));
+    _baseDataVersion = header.baseDataVersion;
+    _bitstreamVersion = (PacketVersion)header.bitstreamVersion;
+
+    qint64 offset = sizeof(header);
+    while (size - offset >= (qint64)sizeof(FileEntryHeader)) {
+        FileEntryHeader entryHeader;
+        memcpy(&entryHeader, data + offset, sizeof(entryHeader));
+        const char* entryData = data + offset + sizeof(entryHeader);
+        qint64 available = size - offset - (qint64)sizeof(entryHeader);
+
+        if (entryHeader.size > available || entryHeader.operation > (uint8_t)OctreeJournal::Operation::Erase ||
+            entryHeader.encoding > (uint8_t)OctreeSnapshot::Encoding::JSON ||
+            qChecksum(entryData, entryHeader.size) != entryHeader.checksum) {
+            break;
+        }
+
+        OctreeJournal::Entry entry;
+        entry.operation = (OctreeJournal::Operation)entryHeader.operation;
+        entry.record.id = QUuid::fromRfc4122(QByteArray::fromRawData(entryHeader.id, sizeof(entryHeader.id)));
+        entry.record.encoding = (OctreeSnapshot::Encoding)entryHeader.encoding;
+        entry.record.data = entryData;
+        entry.record.size = (int)entryHeader.size;
+        _entries.push_back(entry);
+
+        offset += sizeof(entryHeader) + entryHeader.size;
+    }
+
+    if (offset < size) {
+        qCWarning(octree) << "Ignoring" << (size - offset) << "bytes of torn or corrupt journal entries";
+    }
+    _validSize = offset;
+    return true;
+}
@@ -0,0 +1,98 @@
+//
+//  OctreeJournal.h
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeJournal_h
+#define hifi_OctreeJournal_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QUuid>
+
+#include "OctreeSnapshot.h"
+
+// An append-only journal of the changes made to an octree since its last snapshot.
+//
+// The journal starts with a header naming the snapshot it applies to, followed by one entry per change. Each entry
+// holds the item's complete state encoded as in a snapshot record, or marks the item as erased, so replaying the
+// journal in order over the records of its snapshot gives the current contents. Entries are written in batches and
+// each batch is synced to disk, so a crash loses at most the batch that was being written.
+namespace OctreeJournal {
+    const uint32_t FORMAT_VERSION = 1;
+
+    enum class Operation : uint8_t {
+        Edit = 0,
+        Erase = 1
+    };
+
+    struct Entry {
+        Operation operation { Operation::Edit };
+        OctreeSnapshot::Record record;
+    };
+
+    QString filenameForSnapshot(const QString& snapshotFilename);
+}
+
+class OctreeJournalWriter {
+public:
+    // continues the journal in the file if it applies to the given snapshot, otherwise starts a new one
+    bool open(const QString& filename, const QUuid& persistID, int64_t baseDataVersion, PacketVersion bitstreamVersion);
+    // discards every entry, for when the journal has been compacted into a new snapshot
+    bool reset(const QUuid& persistID, int64_t baseDataVersion, PacketVersion bitstreamVersion);
+    bool isOpen() const { return _file.isOpen(); }
+
+    void addEdit(const QUuid& id, OctreeSnapshot::Encoding encoding, const QByteArray& data);
+    void addErase(const QUuid& id);
+    bool hasPendingEntries() const { return !_pending.isEmpty(); }
+
+    // appends the pending entries and syncs them to disk
+    bool flush();
+
+    qint64 getSize() const { return _size; }
+
+private:
+    void addEntry(OctreeJournal::Operation operation, const QUuid& id, OctreeSnapshot::Encoding encoding,
+                  const QByteArray& data);
+
+    QFile _file;
+    QByteArray _pending;
+    qint64 _size { 0 };
+};
+
+class OctreeJournalReader {
+public:
+    // maps the file, which stays mapped for the lifetime of the reader
+    bool open(const QString& filename);
+    // reads a journal that is already in memory, the data must outlive the reader
+    bool setData(const QByteArray& data);
+
+    const QUuid& getPersistID() const { return _persistID; }
+    int64_t getBaseDataVersion() const { return _baseDataVersion; }
+    PacketVersion getBitstreamVersion() const { return _bitstreamVersion; }
+
+    // the entries up to the first one that is torn or corrupt, which is where the next batch should be written
+    const std::vector<OctreeJournal::Entry>& getEntries() const { return _entries; }
+    qint64 getValidSize() const { return _validSize; }
+
+private:
+    bool parse(const char* data, qint64 size);
+
+    QFile _file;
+    std::vector<OctreeJournal::Entry> _entries;
+    qint64 _validSize { 0 };
+
+    QUuid _persistID;
+    int64_t _baseDataVersion { -1 };
+    PacketVersion _bitstreamVersion { 0 };
+};
+
+#endif // hifi_OctreeJournal_h
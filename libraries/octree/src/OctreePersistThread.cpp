@@ -11,6 +11,7 @@
 
 #include "OctreePersistThread.h"
 
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -18,6 +19,7 @@
 #include <fstream>
 #include <time.h>
 
+#include <QBuffer>
 #include <QDateTime>
 #include <QDebug>
 #include <QDir>
@@ -43,6 +45,13 @@ constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
+// a crash loses at most the journal batch that was being written
+constexpr std::chrono::seconds JOURNAL_FLUSH_INTERVAL { 1 };
+// the journal is compacted into a new snapshot once it is a good fraction of the snapshot's size, or has gone long
+// enough without that to make loading it slow
+constexpr qint64 MIN_JOURNAL_SIZE_TO_COMPACT { 1000 * 1000 };
+constexpr std::chrono::minutes MAX_TIME_BETWEEN_COMPACTIONS { 10 };
+
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, std::chrono::milliseconds persistInterval,
                                          bool debugTimestampNow, QString persistAsFileType) :
     _tree(tree),
@@ -75,7 +84,20 @@ void OctreePersistThread::start() {
     OctreeUtils::RawOctreeData data;
     qCDebug(octree) << "Reading octree data from" << _filename;
     QFile file(_filename);
-    if (file.open(QIODevice::ReadOnly)) {
+    if (persistsAsSnapshot()) {
+        // only the snapshot's header is needed here, the records are read once the domain server replies.
+        // A snapshot from another version can't be read, so ask the domain server for its JSON copy instead.
+        if (data.readOctreeDataInfoFromSnapshot(_filename) && data.version == _tree->expectedVersion()) {
+            qCDebug(octree) << "Current octree snapshot: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
+            packet->writePrimitive(true);
+            auto id = data.id.toRfc4122();
+            packet->write(id);
+            packet->writePrimitive(data.dataVersion);
+        } else {
+            qCWarning(octree) << "No octree snapshot found";
+            packet->writePrimitive(false);
+        }
+    } else if (file.open(QIODevice::ReadOnly)) {
         QByteArray jsonData(file.readAll());
         file.close();
         if (!gunzip(jsonData, _cachedJSONData)) {
@@ -113,12 +135,37 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     QByteArray replacementData;
     OctreeUtils::RawOctreeData data;
     bool hasValidOctreeData { false };
-    if (includesNewData) {
+    bool shouldWriteSnapshot { false };
+    if (includesNewData && persistsAsSnapshot()) {
+        // the domain server's copy is JSON, so load it from memory and write it out as a snapshot afterwards
+        replacementData = message->readAll();
+        backupCurrentFile();
+        if (!gunzip(replacementData, _cachedJSONData)) {
+            _cachedJSONData = replacementData;
+        }
+        hasValidOctreeData = data.readOctreeDataInfoFromData(_cachedJSONData);
+        shouldWriteSnapshot = true;
+        qDebug() << "Got OctreeDataFileReply, new data sent";
+    } else if (includesNewData) {
         _cachedJSONData.clear();
         replacementData = message->readAll();
         replaceData(replacementData);
         hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
         qDebug() << "Got OctreeDataFileReply, new data sent";
+    } else if (persistsAsSnapshot()) {
+        qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
+
+        if (data.readOctreeDataInfoFromSnapshot(_filename) && data.version == _tree->expectedVersion()) {
+            hasValidOctreeData = true;
+            if (data.id.isNull()) {
+                qCDebug(octree) << "Current octree snapshot has a null id, updating";
+                data.resetIdAndVersion();
+                shouldWriteSnapshot = true;
+            }
+        } else {
+            // whatever persist file is found is loaded instead, so replace it with a snapshot
+            shouldWriteSnapshot = true;
+        }
     } else {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
         
@@ -163,11 +210,30 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
         _tree->pruneTree();
     });
 
+    if (persistsAsSnapshot() && hasValidOctreeData) {
+        // reading the snapshot also reads its version info, which is stale if it was just reset
+        _tree->setOctreeVersionInfo(data.id, data.dataVersion);
+    }
+
     _cachedJSONData.clear();
     quint64 loadDone = usecTimestampNow();
     _loadTimeUSecs = loadDone - loadStarted;
 
-    _tree->clearDirtyBit(); // the tree is clean since we just loaded it
+    if (shouldWriteSnapshot) {
+        _tree->setDirtyBit(); // the snapshot on disk doesn't match what we loaded yet
+    } else {
+        _tree->clearDirtyBit(); // the tree is clean since we just loaded it
+    }
+
+    if (persistsAsSnapshot()) {
+        // a journal that applies to the snapshot we loaded is continued, anything else is started over
+        _tree->setJournalEnabled(true);
+        _journal.open(OctreeJournal::filenameForSnapshot(_filename), _tree->getPersistID(),
+                      _tree->getPersistDataVersion(), _tree->expectedVersion());
+        _snapshotSize = QFileInfo(_filename).size();
+        _shouldCompact = shouldWriteSnapshot;
+        _lastJournalFlush = _lastCompaction = std::chrono::steady_clock::now();
+    }
 
     unsigned long nodeCount = OctreeElement::getNodeCount();
     unsigned long internalNodeCount = OctreeElement::getInternalNodeCount();
@@ -205,7 +271,8 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
 QString OctreePersistThread::getPersistFileMimeType() const {
     if (_persistAsFileType == "json") {
         return "application/json";
-    } if (_persistAsFileType == "json.gz") {
+    } if (_persistAsFileType == "json.gz" || persistsAsSnapshot()) {
+        // snapshots are downloaded as gzipped JSON, see getPersistFileContents()
         return "application/zip";
     }
     return "";
@@ -249,6 +316,11 @@ void OctreePersistThread::process() {
     auto now = std::chrono::steady_clock::now();
     auto timeSinceLastPersist = now - _lastPersistCheck;
 
+    if (persistsAsSnapshot() && now - _lastJournalFlush > JOURNAL_FLUSH_INTERVAL) {
+        _lastJournalFlush = now;
+        flushJournal();
+    }
+
     if (timeSinceLastPersist > _persistInterval) {
         _lastPersistCheck = now;
         persist();
@@ -259,12 +331,18 @@ void OctreePersistThread::process() {
 
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
+    _isFinishing = true;
     persist();
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
     QByteArray fileContents;
+    if (persistsAsSnapshot()) {
+        // export the snapshot as the JSON every other tool expects
+        _tree->toJSON(&fileContents, nullptr, true);
+        return fileContents;
+    }
     QFile file(_filename);
     if (file.open(QIODevice::ReadOnly)) {
         fileContents = file.readAll();
@@ -272,6 +350,24 @@ QByteArray OctreePersistThread::getPersistFileContents() const {
     return fileContents;
 }
 
+std::unique_ptr<QIODevice> OctreePersistThread::openPersistFile() const {
+    if (persistsAsSnapshot()) {
+        // the JSON export has to be made in memory
+        auto buffer = std::unique_ptr<QBuffer>(new QBuffer());
+        buffer->setData(getPersistFileContents());
+        if (buffer->size() > 0 && buffer->open(QIODevice::ReadOnly)) {
+            return buffer;
+        }
+        return nullptr;
+    }
+
+    auto file = std::unique_ptr<QFile>(new QFile(_filename));
+    if (file->open(QIODevice::ReadOnly) && file->size() > 0) {
+        return file;
+    }
+    return nullptr;
+}
+
 void OctreePersistThread::cleanupOldReplacementBackups() {
     QRegExp filenameRegex { ".*\\.backup\\.\\d{8}-\\d{6}$" };
     QFileInfo persistFile { _filename };
@@ -302,7 +398,35 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
     qDebug() << "Found" << count << "backups";
 }
 
+void OctreePersistThread::flushJournal() {
+    if (!_initialLoadComplete || !_journal.isOpen()) {
+        return;
+    }
+    _tree->writeToJournal(_journal);
+    if (!_journal.flush()) {
+        // the edits are still in the tree, so compacting writes them out with everything else
+        _shouldCompact = true;
+    }
+}
+
+bool OctreePersistThread::shouldCompactJournal() const {
+    if (_shouldCompact || _isFinishing || !_journal.isOpen()) {
+        return true;
+    }
+    qint64 maxJournalSize = std::max(MIN_JOURNAL_SIZE_TO_COMPACT, _snapshotSize / 2);
+    return _journal.getSize() > maxJournalSize ||
+        std::chrono::steady_clock::now() - _lastCompaction > MAX_TIME_BETWEEN_COMPACTIONS;
+}
+
 void OctreePersistThread::persist() {
+    if (persistsAsSnapshot() && _initialLoadComplete) {
+        flushJournal();
+        if (!_tree->isDirty() || !shouldCompactJournal()) {
+            // the journal has every edit, so the snapshot doesn't need rewriting yet
+            return;
+        }
+    }
+
     if (_tree->isDirty() && _initialLoadComplete) {
 
         _tree->withWriteLock([&] {
@@ -317,6 +441,14 @@ void OctreePersistThread::persist() {
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
+
+            if (persistsAsSnapshot()) {
+                // the new snapshot holds everything that was journaled
+                _journal.reset(_tree->getPersistID(), _tree->getPersistDataVersion(), _tree->expectedVersion());
+                _snapshotSize = QFileInfo(_filename).size();
+                _shouldCompact = false;
+                _lastCompaction = std::chrono::steady_clock::now();
+            }
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
         }
@@ -14,10 +14,14 @@
 #ifndef hifi_OctreePersistThread_h
 #define hifi_OctreePersistThread_h
 
+#include <memory>
+
+#include <QIODevice>
 #include <QString>
 #include <QtCore/QSharedPointer>
 #include <GenericThread.h>
 #include "Octree.h"
+#include "OctreeJournal.h"
 
 class OctreePersistThread : public QObject {
     Q_OBJECT
@@ -46,6 +50,9 @@ public:
     QString getPersistFileMimeType() const;
     QByteArray getPersistFileContents() const;
 
+    /// Opens the persist file to be read as it is sent, or returns nullptr if there is nothing to send.
+    std::unique_ptr<QIODevice> openPersistFile() const;
+
     void aboutToFinish(); /// call this to inform the persist thread that the owner is about to finish to support final persist
 
 public slots:
@@ -60,12 +67,17 @@ protected slots:
 
 protected:
     void persist();
+    void flushJournal();
+    bool shouldCompactJournal() const;
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
     void replaceData(QByteArray data);
     void sendLatestEntityDataToDS();
 
+    // binary snapshots are only kept locally, the domain server always gets and sends JSON
+    bool persistsAsSnapshot() const { return _persistAsFileType == "bin"; }
+
 private:
     OctreePointer _tree;
     QString _filename;
@@ -80,6 +92,14 @@ private:
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+
+    // snapshots are kept current with a journal of the edits made since, and only rewritten to compact it
+    OctreeJournalWriter _journal;
+    std::chrono::steady_clock::time_point _lastJournalFlush;
+    std::chrono::steady_clock::time_point _lastCompaction;
+    qint64 _snapshotSize { 0 };
+    bool _shouldCompact { false };
+    bool _isFinishing { false };
 };
 
 #endif // hifi_OctreePersistThread_h
@@ -0,0 +1,174 @@
+//
+//  OctreeSnapshot.cpp
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSnapshot.h"
+
+#include <cstring>
+
+#include <QtCore/QDebug>
+
+#include <UUID.h>
+
+#include "OctreeLogging.h"
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = { 'O', 'C', 'T', 'S', 'N', 'A', 'P', '\0' };
+
+// the on-disk layouts, written in host byte order like the rest of the octree bitstream
+struct FileHeader {
+    char magic[8];
+    uint32_t formatVersion;
+    uint32_t bitstreamVersion;
+    char persistID[NUM_BYTES_RFC4122_UUID];
+    int64_t dataVersion;
+    uint64_t recordCount;
+    uint64_t indexOffset;
+};
+static_assert(sizeof(FileHeader) == 56, "snapshot header layout changed");
+
+struct FileIndexEntry {
+    char id[NUM_BYTES_RFC4122_UUID];
+    uint64_t offset;
+    uint32_t size;
+    uint32_t encoding;
+};
+static_assert(sizeof(FileIndexEntry) == 32, "snapshot index layout changed");
+
+}
+
+OctreeSnapshotWriter::OctreeSnapshotWriter(const QUuid& persistID, int64_t dataVersion, PacketVersion bitstreamVersion) :
+    _persistID(persistID),
+    _dataVersion(dataVersion),
+    _bitstreamVersion(bitstreamVersion)
+{
+    // leave room for the header, which is filled in once the index offset is known
+    _data.fill('\0', sizeof(FileHeader));
+}
+
+void OctreeSnapshotWriter::addRecord(const QUuid& id, OctreeSnapshot::Encoding encoding, const QByteArray& data) {
+    _index.push_back({ id, (uint64_t)_data.size(), (uint32_t)data.size(), encoding });
+    _data.append(data);
+}
+
+QByteArray OctreeSnapshotWriter::finish() {
+    int padding = (OctreeSnapshot::PAGE_SIZE - _data.size() % OctreeSnapshot::PAGE_SIZE) % OctreeSnapshot::PAGE_SIZE;
+    _data.append(padding, '\0');
+
+    FileHeader header;
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.formatVersion = OctreeSnapshot::FORMAT_VERSION;
+    header.bitstreamVersion = _bitstreamVersion;
+    memcpy(header.persistID, _persistID.toRfc4122().constData(), sizeof(header.persistID));
+    header.dataVersion = _dataVersion;
+    header.recordCount = _index.size();
+    header.indexOffset = _data.size();
+    memcpy(_data.data(), &header, sizeof(header));
+
+    _data.reserve(_data.size() + (int)(_index.size() * sizeof(FileIndexEntry)));
+    for (const auto& entry : _index) {
+        FileIndexEntry fileEntry;
+        memcpy(fileEntry.id, entry.id.toRfc4122().constData(), sizeof(fileEntry.id));
+        fileEntry.offset = entry.offset;
+        fileEntry.size = entry.size;
+        fileEntry.encoding = (uint32_t)entry.encoding;
+        _data.append((const char*)&fileEntry, sizeof(fileEntry));
+    }
+    _index.clear();
+
+    QByteArray snapshot;
+    snapshot.swap(_data);
+    return snapshot;
+}
+
+bool OctreeSnapshotReader::open(const QString& filename) {
+    _file.setFileName(filename);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(octree) << "Cannot open snapshot file for reading:" << filename << _file.errorString();
+        return false;
+    }
+
+    qint64 size = _file.size();
+    const uchar* mapped = size > 0 ? _file.map(0, size) : nullptr;
+    if (!mapped) {
+        qCWarning(octree) << "Cannot map snapshot file:" << filename << _file.errorString();
+        return false;
+    }
+    return parse((const char*)mapped, size);
+}
+
+bool OctreeSnapshotReader::setData(const QByteArray& data) {
+    return parse(data.constData(), data.size());
+}
+
+bool OctreeSnapshotReader::parse(const char* data, qint64 size) {
+    _data = nullptr;
+    _recordCount = 0;
+
+    FileHeader header;
+    if (size < (qint64)sizeof(header)) {
+        qCWarning(octree) << "Snapshot is too short for its header:" << size << "bytes";
+        return false;
+    }
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0) {
+        qCWarning(octree) << "Not an octree snapshot";
+        return false;
+    }
+    if (header.formatVersion != OctreeSnapshot::FORMAT_VERSION) {
+        qCWarning(octree) << "Unsupported octree snapshot format version" << header.formatVersion;
+        return false;
+    }
+
+    uint64_t fileSize = (uint64_t)size;
+    if (header.indexOffset < sizeof(header) || header.indexOffset > fileSize ||
+        header.indexOffset % OctreeSnapshot::PAGE_SIZE != 0 ||
+        header.recordCount > (fileSize - header.indexOffset) / sizeof(FileIndexEntry)) {
+        qCWarning(octree) << "Octree snapshot index is out of bounds";
+        return false;
+    }
+
+    // check every record is inside the record area once, so getRecord doesn't have to
+    const char* index = data + header.indexOffset;
+    for (uint64_t i = 0; i < header.recordCount; i++) {
+        FileIndexEntry entry;
+        memcpy(&entry, index + i * sizeof(FileIndexEntry), sizeof(entry));
+        if (entry.offset < sizeof(header) || entry.offset > header.indexOffset ||
+            entry.size > header.indexOffset - entry.offset) {
+            qCWarning(octree) << "Octree snapshot record" << i << "is out of bounds";
+            return false;
+        }
+    }
+
+    _data = data;
+    _indexOffset = header.indexOffset;
+    _recordCount = header.recordCount;
+    _persistID = QUuid::fromRfc4122(QByteArray::fromRawData(header.persistID, sizeof(header.persistID)));
+    _dataVersion = header.dataVersion;
+    _bitstreamVersion = (PacketVersion)header.bitstreamVersion;
+    return true;
+}
+
+OctreeSnapshot::Record OctreeSnapshotReader::getRecord(int index) const {
+    OctreeSnapshot::Record record;
+    if (!_data || index < 0 || (uint64_t)index >= _recordCount) {
+        return record;
+    }
+
+    FileIndexEntry entry;
+    memcpy(&entry, _data + _indexOffset + index * sizeof(FileIndexEntry), sizeof(entry));
+    record.id = QUuid::fromRfc4122(QByteArray::fromRawData(entry.id, sizeof(entry.id)));
+    record.encoding = (OctreeSnapshot::Encoding)entry.encoding;
+    record.data = _data + entry.offset;
+    record.size = (int)entry.size;
+    return record;
+}
@@ -0,0 +1,97 @@
+//
+//  OctreeSnapshot.h
+//  libraries/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSnapshot_h
+#define hifi_OctreeSnapshot_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QUuid>
+
+#include <udt/PacketHeaders.h>
+
+// A versioned binary snapshot of an octree's contents, the binary alternative to the JSON persist file.
+//
+// The file is a fixed header, then one record per item, then an index of the records that starts on a page
+// boundary. Records are opaque here, the octree that writes them decides how they are encoded. Readers map the
+// file and decode each record in place, so loading never copies the file and only touches the pages it reads.
+namespace OctreeSnapshot {
+    const uint32_t FORMAT_VERSION = 1;
+    const int PAGE_SIZE = 4096;
+
+    enum class Encoding : uint32_t {
+        Properties = 0, // the octree's own binary property encoding
+        JSON = 1        // compact JSON, for items the binary encoding can't hold
+    };
+
+    struct Record {
+        QUuid id;
+        Encoding encoding { Encoding::Properties };
+        const char* data { nullptr };
+        int size { 0 };
+    };
+}
+
+class OctreeSnapshotWriter {
+public:
+    OctreeSnapshotWriter(const QUuid& persistID, int64_t dataVersion, PacketVersion bitstreamVersion);
+
+    void addRecord(const QUuid& id, OctreeSnapshot::Encoding encoding, const QByteArray& data);
+    int getRecordCount() const { return (int)_index.size(); }
+
+    // appends the index and returns the complete snapshot, the writer is empty afterwards
+    QByteArray finish();
+
+private:
+    struct IndexEntry {
+        QUuid id;
+        uint64_t offset;
+        uint32_t size;
+        OctreeSnapshot::Encoding encoding;
+    };
+
+    QUuid _persistID;
+    int64_t _dataVersion;
+    PacketVersion _bitstreamVersion;
+    QByteArray _data;
+    std::vector<IndexEntry> _index;
+};
+
+class OctreeSnapshotReader {
+public:
+    // maps the file, which stays mapped for the lifetime of the reader
+    bool open(const QString& filename);
+    // reads a snapshot that is already in memory, the data must outlive the reader
+    bool setData(const QByteArray& data);
+
+    const QUuid& getPersistID() const { return _persistID; }
+    int64_t getDataVersion() const { return _dataVersion; }
+    PacketVersion getBitstreamVersion() const { return _bitstreamVersion; }
+
+    int getRecordCount() const { return (int)_recordCount; }
+    OctreeSnapshot::Record getRecord(int index) const;
+
+private:
+    bool parse(const char* data, qint64 size);
+
+    QFile _file;
+    const char* _data { nullptr };
+    uint64_t _indexOffset { 0 };
+    uint64_t _recordCount { 0 };
+
+    QUuid _persistID;
+    int64_t _dataVersion { -1 };
+    PacketVersion _bitstreamVersion { 0 };
+};
+
+#endif // hifi_OctreeSnapshot_h
@@ -198,6 +198,9 @@ PhysicsMotionType EntityMotionState::computePhysicsMotionType() const {
             // if something would have been dynamic but is a child of something else, force it to be kinematic, instead.
             return MOTION_TYPE_KINEMATIC;
         }
+        if (_frozenByLOD) {
+            return MOTION_TYPE_KINEMATIC;
+        }
         return MOTION_TYPE_DYNAMIC;
     }
     if (_entity->hasActions() ||
@@ -252,6 +255,12 @@ void EntityMotionState::getWorldTransform(btTransform& worldTrans) const {
 // This callback is invoked by the physics simulation at the end of each simulation step...
 // iff the corresponding RigidBody is DYNAMIC and ACTIVE.
 void EntityMotionState::setWorldTransform(const btTransform& worldTrans) {
+    applyBodyState(bulletToGLM(worldTrans.getOrigin()), bulletToGLM(worldTrans.getRotation()), getBodyLinearVelocity(),
+                   getBodyAngularVelocity(), usecTimestampNow());
+}
+
+void EntityMotionState::applyBodyState(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& linearVelocity,
+                                       const glm::vec3& angularVelocity, uint64_t now) {
     measureBodyAcceleration();
 
     // If transform or velocities are flagged as dirty it means a network or scripted change
@@ -260,29 +269,29 @@ void EntityMotionState::setWorldTransform(const btTransform& worldTrans) {
     uint32_t flags = _entity->getDirtyFlags() & (Simulation::DIRTY_TRANSFORM | Simulation::DIRTY_VELOCITIES);
     if (!flags) {
         // flags are clear
-        _entity->setWorldTransform(bulletToGLM(worldTrans.getOrigin()), bulletToGLM(worldTrans.getRotation()));
-        _entity->setWorldVelocity(getBodyLinearVelocity());
-        _entity->setWorldAngularVelocity(getBodyAngularVelocity());
-        _entity->setLastSimulated(usecTimestampNow());
+        _entity->setWorldTransform(position, rotation);
+        _entity->setWorldVelocity(linearVelocity);
+        _entity->setWorldAngularVelocity(angularVelocity);
+        _entity->setLastSimulated(now);
     } else {
         // only set properties NOT flagged
         if (!(flags & Simulation::DIRTY_TRANSFORM)) {
-            _entity->setWorldTransform(bulletToGLM(worldTrans.getOrigin()), bulletToGLM(worldTrans.getRotation()));
+            _entity->setWorldTransform(position, rotation);
         }
         if (!(flags & Simulation::DIRTY_LINEAR_VELOCITY)) {
-            _entity->setWorldVelocity(getBodyLinearVelocity());
+            _entity->setWorldVelocity(linearVelocity);
         }
         if (!(flags & Simulation::DIRTY_ANGULAR_VELOCITY)) {
-            _entity->setWorldAngularVelocity(getBodyAngularVelocity());
+            _entity->setWorldAngularVelocity(angularVelocity);
         }
         if (flags != (Simulation::DIRTY_TRANSFORM | Simulation::DIRTY_VELOCITIES)) {
-            _entity->setLastSimulated(usecTimestampNow());
+            _entity->setLastSimulated(now);
         }
     }
 
     if (_entity->getSimulatorID().isNull()) {
         _loopsWithoutOwner++;
-        if (_loopsWithoutOwner > LOOPS_FOR_SIMULATION_ORPHAN && usecTimestampNow() > _nextBidExpiry) {
+        if (_loopsWithoutOwner > LOOPS_FOR_SIMULATION_ORPHAN && now > _nextBidExpiry) {
             _bumpedPriority = glm::max(_bumpedPriority, VOLUNTEER_SIMULATION_PRIORITY);
         }
     }
@@ -783,6 +792,18 @@ bool EntityMotionState::isLocallyOwnedOrShouldBe() const {
 
 void EntityMotionState::setRegion(uint8_t region) {
     _region = region;
+    if (_frozenByLOD && _region == workload::Region::R1) {
+        // close enough to interact with, so it must be simulated
+        setFrozenByLOD(false);
+    }
+}
+
+void EntityMotionState::setFrozenByLOD(bool frozen) {
+    if (frozen != _frozenByLOD) {
+        _frozenByLOD = frozen;
+        // reinserted into the simulation with its new motion type
+        _entity->markDirtyFlags(Simulation::DIRTY_MOTION_TYPE);
+    }
 }
 
 void EntityMotionState::initForBid() {
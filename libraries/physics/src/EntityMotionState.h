@@ -50,6 +50,9 @@ public:
 
     // this relays outgoing position/rotation to the EntityItem
     virtual void setWorldTransform(const btTransform& worldTrans) override;
+    // the same, from the results gathered in a MotionStateBuffer, at time now
+    void applyBodyState(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& linearVelocity,
+                        const glm::vec3& angularVelocity, uint64_t now);
 
     bool shouldSendUpdate(uint32_t simulationStep);
     void sendBid(OctreeEditPacketSender* packetSender, uint32_t step);
@@ -99,6 +102,11 @@ public:
     void setRegion(uint8_t region);
     void saveKinematicState(btScalar timeStep) override;
 
+    // A dynamic entity frozen by the physics LOD is kinematic, moving by its last known velocities, until the LOD or a
+    // move into R1 thaws it.  See PhysicalEntitySimulation::updatePhysicsLOD().
+    bool isFrozenByLOD() const { return _frozenByLOD; }
+    void setFrozenByLOD(bool frozen);
+
 protected:
     void setRigidBody(btRigidBody* body) override;
 
@@ -156,6 +164,7 @@ protected:
     uint8_t _numInactiveUpdates { 1 };
     uint8_t _bumpedPriority { 0 }; // the target simulation priority according to collision history
     uint8_t _region { workload::Region::INVALID };
+    bool _frozenByLOD { false };
 
     bool isServerlessMode();
 };
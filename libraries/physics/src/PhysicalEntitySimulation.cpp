@@ -269,6 +269,10 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
         _incomingChanges.insert(motionState);
     };
 
+    // take in a frame's worth of the shapes finished on worker threads
+    const uint64_t SHAPE_DELIVERY_TIME_BUDGET = 1000; // usecs
+    ObjectMotionState::getShapeManager()->deliverWork(SHAPE_DELIVERY_TIME_BUDGET);
+
     uint32_t deliveryCount = ObjectMotionState::getShapeManager()->getWorkDeliveryCount();
     if (deliveryCount != _lastWorkDeliveryCount) {
         // new off-thread shapes have arrived --> find adds whose shapes have arrived
@@ -391,6 +395,71 @@ void PhysicalEntitySimulation::buildMotionStatesForEntitiesThatNeedThem() {
     }
 }
 
+void PhysicalEntitySimulation::updatePhysicsLOD() {
+    // Dynamic entities in R2 are simulated by someone closer to them, so there is little lost by moving them with the
+    // velocities they're sent rather than resolving their collisions here.  When there are more active dynamic entities
+    // than the budget, those are frozen as kinematic, and thawed again when there is room or they come into R1.
+    // Sleeping bodies cost next to nothing to simulate, so only active ones count.
+    uint64_t now = usecTimestampNow();
+    if (now < _nextPhysicsLODUpdate) {
+        return;
+    }
+    const uint64_t PHYSICS_LOD_UPDATE_PERIOD = 100 * USECS_PER_MSEC;
+    _nextPhysicsLODUpdate = now + PHYSICS_LOD_UPDATE_PERIOD;
+
+    QUuid sessionID = Physics::getSessionUUID();
+    uint32_t numActive = 0;
+    std::vector<EntityMotionState*> freezable;
+    std::vector<EntityMotionState*> frozen;
+    for (auto& object : _physicalObjects) {
+        EntityMotionState* motionState = static_cast<EntityMotionState*>(object);
+        const EntityItemPointer& entity = motionState->getEntity();
+        btRigidBody* body = motionState->getRigidBody();
+        if (!body || !entity->getDynamic() || !entity->getParentID().isNull()) {
+            continue;
+        }
+        bool canFreeze = _maxActiveDynamicEntities > 0
+            && motionState->_region == workload::Region::R2
+            && !entity->getSimulatorID().isNull() && entity->getSimulatorID() != sessionID
+            && motionState->getOwnershipState() == EntityMotionState::OwnershipState::NotLocallyOwned
+            && !entity->hasActions();
+        if (motionState->isFrozenByLOD()) {
+            if (canFreeze) {
+                frozen.push_back(motionState);
+            } else {
+                // owned by us now, or grabbed, or the LOD is off
+                motionState->setFrozenByLOD(false);
+                _incomingChanges.insert(motionState);
+                ++numActive;
+            }
+        } else if (body->isActive()) {
+            ++numActive;
+            if (canFreeze) {
+                freezable.push_back(motionState);
+            }
+        }
+    }
+
+    // a little room before thawing, so entities don't flip between frozen and thawed
+    const uint32_t THAW_MARGIN = 8;
+    if (numActive > _maxActiveDynamicEntities) {
+        for (size_t i = 0; i < freezable.size() && numActive > _maxActiveDynamicEntities; ++i) {
+            freezable[i]->setFrozenByLOD(true);
+            _incomingChanges.insert(freezable[i]);
+            frozen.push_back(freezable[i]);
+            --numActive;
+        }
+    } else {
+        while (!frozen.empty() && numActive + THAW_MARGIN < _maxActiveDynamicEntities) {
+            frozen.back()->setFrozenByLOD(false);
+            _incomingChanges.insert(frozen.back());
+            frozen.pop_back();
+            ++numActive;
+        }
+    }
+    _numFrozenByLOD = (uint32_t)frozen.size();
+}
+
 void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transaction& transaction) {
     QMutexLocker lock(&_mutex);
     // entities being removed
@@ -413,6 +482,9 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
     // entities to add
     buildMotionStatesForEntitiesThatNeedThem();
 
+    // entities to freeze or thaw
+    updatePhysicsLOD();
+
     // motionStates with changed entities: delete, add, or change
     for (auto& object : _incomingChanges) {
         uint32_t unhandledFlags = object->getIncomingDirtyFlags();
@@ -428,7 +500,7 @@ void PhysicalEntitySimulation::buildPhysicsTransaction(PhysicsEngine::Transactio
         bool needsNewShape = object->needsNewShape() && object->_entity->isReadyToComputeShape();
         if (needsNewShape) {
             ShapeType shapeType = object->getShapeType();
-            if (shapeType == SHAPE_TYPE_STATIC_MESH) {
+            if (ShapeManager::isBuiltOffThread(shapeType)) {
                 ShapeRequest shapeRequest(object->_entity);
                 ShapeRequests::iterator requestItr = _shapeRequests.find(shapeRequest);
                 if (requestItr == _shapeRequests.end()) {
@@ -539,21 +611,20 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
         ObjectMotionState* state = &(*stateItr);
         assert(state);
         if (state->getType() == MOTIONSTATE_TYPE_ENTITY) {
-            EntityMotionState* entityState = static_cast<EntityMotionState*>(state);
-            _entitiesToSort.insert(entityState->getEntity());
-            if (entityState->getOwnershipState() == EntityMotionState::OwnershipState::NotLocallyOwned) {
-                // NOTE: entityState->getOwnershipState() reflects what ownership list (_bids or _owned) it is in
-                // and is distinct from entityState->isLocallyOwned() which checks the simulation ownership
-                // properties of the corresponding EntityItem.  It is possible for the two states to be out
-                // of sync.  In fact, we're trying to put them back into sync here.
-                if (entityState->isLocallyOwned()) {
-                    addOwnership(entityState);
-                } else if (entityState->shouldSendBid()) {
-                    addOwnershipBid(entityState);
-                } else {
-                    entityState->getEntity()->updateQueryAACube();
-                }
-            }
+            handleChangedEntityState(static_cast<EntityMotionState*>(state));
+        }
+    }
+
+    // with bulk sync the active dynamic entities aren't in motionStates, and their results are applied here
+    const MotionStateBuffer& buffer = _physicsEngine->getMotionStateBuffer();
+    if (buffer.size() > 0) {
+        PROFILE_RANGE_EX(simulation_physics, "ApplyBodyStates", 0x00000000, (uint64_t)buffer.size());
+        uint64_t now = usecTimestampNow();
+        for (size_t i = 0; i < buffer.size(); ++i) {
+            EntityMotionState* entityState = static_cast<EntityMotionState*>(buffer.motionStates[i]);
+            entityState->applyBodyState(buffer.positions[i], buffer.rotations[i], buffer.linearVelocities[i],
+                                        buffer.angularVelocities[i], now);
+            handleChangedEntityState(entityState);
         }
     }
 
@@ -571,6 +642,23 @@ void PhysicalEntitySimulation::handleChangedMotionStates(const VectorOfMotionSta
     }
 }
 
+void PhysicalEntitySimulation::handleChangedEntityState(EntityMotionState* entityState) {
+    _entitiesToSort.insert(entityState->getEntity());
+    if (entityState->getOwnershipState() == EntityMotionState::OwnershipState::NotLocallyOwned) {
+        // NOTE: entityState->getOwnershipState() reflects what ownership list (_bids or _owned) it is in
+        // and is distinct from entityState->isLocallyOwned() which checks the simulation ownership
+        // properties of the corresponding EntityItem.  It is possible for the two states to be out
+        // of sync.  In fact, we're trying to put them back into sync here.
+        if (entityState->isLocallyOwned()) {
+            addOwnership(entityState);
+        } else if (entityState->shouldSendBid()) {
+            addOwnershipBid(entityState);
+        } else {
+            entityState->getEntity()->updateQueryAACube();
+        }
+    }
+}
+
 void PhysicalEntitySimulation::addOwnershipBid(EntityMotionState* motionState) {
     if (getEntityTree()->isServerlessMode()) {
         return;
@@ -99,8 +99,16 @@ public:
     void sendOwnershipBids(uint32_t numSubsteps);
     void sendOwnedUpdates(uint32_t numSubsteps);
 
+    // The physics LOD keeps at most this many dynamic entities awake and simulated, when more are in physics range.  The
+    // rest are frozen as kinematic, moving by their last known velocities.  Zero means no limit.
+    void setMaxActiveDynamicEntities(uint32_t maxEntities) { _maxActiveDynamicEntities = maxEntities; }
+    uint32_t getMaxActiveDynamicEntities() const { return _maxActiveDynamicEntities; }
+    uint32_t getNumFrozenByLOD() const { return _numFrozenByLOD; }
+
 private:
     void buildMotionStatesForEntitiesThatNeedThem();
+    void updatePhysicsLOD();
+    void handleChangedEntityState(EntityMotionState* entityState);
 
     class ShapeRequest {
     public:
@@ -135,6 +143,9 @@ private:
     uint64_t _nextBidExpiry;
     uint32_t _lastStepSendPackets { 0 };
     uint32_t _lastWorkDeliveryCount { 0 };
+    uint32_t _maxActiveDynamicEntities { 0 };
+    uint32_t _numFrozenByLOD { 0 };
+    uint64_t _nextPhysicsLODUpdate { 0 };
 };
 
 
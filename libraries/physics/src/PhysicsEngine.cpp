@@ -12,18 +12,25 @@
 #include "PhysicsEngine.h"
 
 #include <functional>
+#include <thread>
+#include <unordered_map>
 
 #include <QFile>
 
+#include <MemoryAccounting.h>
 #include <PerfStat.h>
 #include <PhysicsCollisionGroups.h>
 #include <Profile.h>
 #include <BulletCollision/CollisionShapes/btTriangleShape.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <LinearMath/btAabbUtil2.h>
+#include <LinearMath/btThreads.h>
 
 #include "CharacterController.h"
 #include "ObjectMotionState.h"
 #include "PhysicsHelpers.h"
 #include "PhysicsDebugDraw.h"
+#include "PhysicsSnapshot.h"
 #include "ThreadSafeDynamicsWorld.h"
 #include "PhysicsLogging.h"
 
@@ -38,8 +45,15 @@ PhysicsEngine::~PhysicsEngine() {
     delete _collisionDispatcher;
     delete _broadphaseFilter;
     delete _constraintSolver;
+    delete _constraintSolverMt;
     delete _dynamicsWorld;
     delete _ghostPairCallback;
+    if (_taskScheduler) {
+        if (btGetTaskScheduler() == _taskScheduler) {
+            btSetTaskScheduler(btGetSequentialTaskScheduler());
+        }
+        delete _taskScheduler;
+    }
 }
 
 void PhysicsEngine::init() {
@@ -47,8 +61,13 @@ void PhysicsEngine::init() {
         _collisionConfig = new btDefaultCollisionConfiguration();
         _collisionDispatcher = new btCollisionDispatcher(_collisionConfig);
         _broadphaseFilter = new btDbvtBroadphase();
-        _constraintSolver = new btSequentialImpulseConstraintSolver;
-        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver, _collisionConfig);
+        // one solver per thread for the islands, and a parallel one for an island too large to share a thread
+        _constraintSolver = new btConstraintSolverPoolMt(getMaxNumPhysicsThreads());
+        _constraintSolverMt = new btSequentialImpulseConstraintSolverMt();
+        _dynamicsWorld = new ThreadSafeDynamicsWorld(_collisionDispatcher, _broadphaseFilter, _constraintSolver,
+                                                     _constraintSolverMt, _collisionConfig);
+        applyNumPhysicsThreads();
+        _dynamicsWorld->setBulkMotionStateSync(_bulkMotionStateSync);
         _physicsDebugDraw.reset(new PhysicsDebugDraw());
 
         // hook up debug draw renderer
@@ -78,6 +97,40 @@ int32_t PhysicsEngine::getNumCollisionObjects() const {
     return _dynamicsWorld ? _dynamicsWorld->getNumCollisionObjects() : 0;
 }
 
+int PhysicsEngine::getMaxNumPhysicsThreads() {
+    // beyond this the islands of a typical domain are too few and too small to keep more threads busy
+    const int MAX_NUM_PHYSICS_THREADS = 8;
+    return std::max(1, std::min((int)std::thread::hardware_concurrency(), MAX_NUM_PHYSICS_THREADS));
+}
+
+void PhysicsEngine::setNumPhysicsThreads(int numThreads) {
+    numThreads = std::max(1, std::min(numThreads, getMaxNumPhysicsThreads()));
+    if (numThreads != _numPhysicsThreads) {
+        _numPhysicsThreads = numThreads;
+        // the scheduler is only changed between steps, which happen on the thread that calls this
+        if (_dynamicsWorld) {
+            applyNumPhysicsThreads();
+        }
+    }
+}
+
+void PhysicsEngine::applyNumPhysicsThreads() {
+    if (_numPhysicsThreads > 1 && !_taskScheduler) {
+        // null when Bullet is built without multithreading
+        _taskScheduler = btCreateDefaultTaskScheduler();
+        if (!_taskScheduler) {
+            qCDebug(physics) << "Bullet is single threaded, physics stays on one thread";
+        }
+    }
+
+    if (_numPhysicsThreads > 1 && _taskScheduler) {
+        _taskScheduler->setNumThreads(std::min(_numPhysicsThreads, _taskScheduler->getMaxNumThreads()));
+        btSetTaskScheduler(_taskScheduler);
+    } else {
+        btSetTaskScheduler(btGetSequentialTaskScheduler());
+    }
+}
+
 // private
 void PhysicsEngine::addObjectToDynamicsWorld(ObjectMotionState* motionState) {
     assert(motionState);
@@ -302,8 +355,6 @@ void PhysicsEngine::removeContacts(ObjectMotionState* motionState) {
 }
 
 void PhysicsEngine::stepSimulation() {
-    CProfileManager::Reset();
-    BT_PROFILE("stepSimulation");
     // NOTE: the grand order of operations is:
     // (1) pull incoming changes
     // (2) step simulation
@@ -313,7 +364,23 @@ void PhysicsEngine::stepSimulation() {
     const float MAX_TIMESTEP = (float)PHYSICS_ENGINE_MAX_NUM_SUBSTEPS * PHYSICS_ENGINE_FIXED_SUBSTEP;
     float dt = 1.0e-6f * (float)(_clock.getTimeMicroseconds());
     _clock.reset();
-    float timeStep = btMin(dt, MAX_TIMESTEP);
+    stepSimulation(btMin(dt, MAX_TIMESTEP));
+}
+
+void PhysicsEngine::stepSimulation(float timeStep) {
+    MemoryAccounting::Scope memoryScope(MemoryTag::Physics);
+    if (_saveNextSnapshot) {
+        _saveNextSnapshot = false;
+        PhysicsSnapshot snapshot = PhysicsSnapshot::capture(_dynamicsWorld);
+        if (snapshot.save(_snapshotFilename)) {
+            qCDebug(physics) << "saved" << snapshot.bodies.size() << "bodies and" << snapshot.constraints.size()
+                << "constraints to" << _snapshotFilename << "but skipped" << snapshot.numSkippedObjects << "objects and"
+                << snapshot.numSkippedConstraints << "constraints";
+        }
+    }
+
+    CProfileManager::Reset();
+    BT_PROFILE("stepSimulation");
 
     auto onSubStep = [this]() {
         this->updateContactMap();
@@ -626,6 +693,13 @@ const VectorOfMotionStates& PhysicsEngine::getChangedMotionStates() {
     return _dynamicsWorld->getChangedMotionStates();
 }
 
+void PhysicsEngine::setBulkMotionStateSync(bool enabled) {
+    _bulkMotionStateSync = enabled;
+    if (_dynamicsWorld) {
+        _dynamicsWorld->setBulkMotionStateSync(enabled);
+    }
+}
+
 void PhysicsEngine::dumpStatsIfNecessary() {
     if (_dumpNextStats) {
         _dumpNextStats = false;
@@ -644,6 +718,11 @@ void PhysicsEngine::saveNextPhysicsStats(QString filename) {
     _statsFilename = filename;
 }
 
+void PhysicsEngine::saveNextSnapshot(QString filename) {
+    _saveNextSnapshot = true;
+    _snapshotFilename = filename;
+}
+
 // Bullet collision flags are as follows:
 // CF_STATIC_OBJECT= 1,
 // CF_KINEMATIC_OBJECT= 2,
@@ -827,32 +906,18 @@ void PhysicsEngine::setContactAddedCallback(PhysicsEngine::ContactAddedCallback
 }
 
 struct AllContactsCallback : public btCollisionWorld::ContactResultCallback {
-    AllContactsCallback(int32_t mask, int32_t group, const ShapeInfo& shapeInfo, const Transform& transform, btCollisionObject* myAvatarCollisionObject, float threshold) :
+    AllContactsCallback(int32_t mask, int32_t group, const btCollisionObject* collisionObject, btCollisionObject* myAvatarCollisionObject, float threshold, std::vector<ContactTestResult>& contacts) :
         btCollisionWorld::ContactResultCallback(),
-        collisionObject(),
-        contacts(),
+        collisionObject(collisionObject),
+        contacts(contacts),
         myAvatarCollisionObject(myAvatarCollisionObject),
         threshold(threshold) {
-        const btCollisionShape* collisionShape = ObjectMotionState::getShapeManager()->getShape(shapeInfo);
-
-        collisionObject.setCollisionShape(const_cast<btCollisionShape*>(collisionShape));
-
-        btTransform bulletTransform;
-        bulletTransform.setOrigin(glmToBullet(transform.getTranslation()));
-        bulletTransform.setRotation(glmToBullet(transform.getRotation()));
-
-        collisionObject.setWorldTransform(bulletTransform);
-
         m_collisionFilterMask = mask;
         m_collisionFilterGroup = group;
     }
 
-    ~AllContactsCallback() {
-        ObjectMotionState::getShapeManager()->releaseShape(collisionObject.getCollisionShape());
-    }
-
-    btCollisionObject collisionObject;
-    std::vector<ContactTestResult> contacts;
+    const btCollisionObject* collisionObject;
+    std::vector<ContactTestResult>& contacts;
     btCollisionObject* myAvatarCollisionObject;
     btScalar threshold;
 
@@ -865,7 +930,7 @@ struct AllContactsCallback : public btCollisionWorld::ContactResultCallback {
         btVector3 penetrationPoint;
         btVector3 otherPenetrationPoint;
         btVector3 normal;
-        if (colObj0->m_collisionObject == &collisionObject) {
+        if (colObj0->m_collisionObject == collisionObject) {
             otherBody = colObj1->m_collisionObject;
             penetrationPoint = getWorldPoint(cp.m_localPointB, colObj1->getWorldTransform());
             otherPenetrationPoint = getWorldPoint(cp.m_localPointA, colObj0->getWorldTransform());
@@ -906,16 +971,108 @@ protected:
     }
 };
 
+// collects the broadphase proxies that overlap an AABB
+struct BroadphaseProxyCollector : public btBroadphaseAabbCallback {
+    BroadphaseProxyCollector(std::vector<btBroadphaseProxy*>& proxies) : proxies(proxies) {}
+
+    bool process(const btBroadphaseProxy* proxy) override {
+        proxies.push_back(const_cast<btBroadphaseProxy*>(proxy));
+        return true;
+    }
+
+    std::vector<btBroadphaseProxy*>& proxies;
+};
+
 std::vector<ContactTestResult> PhysicsEngine::contactTest(uint16_t mask, const ShapeInfo& regionShapeInfo, const Transform& regionTransform, uint16_t group, float threshold) const {
+    return contactTest({ ContactTestRegion(regionShapeInfo, regionTransform, mask, group, threshold) }).contacts;
+}
+
+ContactTestResults PhysicsEngine::contactTest(const std::vector<ContactTestRegion>& regions) const {
+    ContactTestResults results;
+    results.offsets.reserve(regions.size() + 1);
+    results.offsets.push_back(0);
+
     // TODO: Give MyAvatar a motion state so we don't have to do this
-    btCollisionObject* myAvatarCollisionObject = nullptr;
-    if ((mask & USER_COLLISION_GROUP_MY_AVATAR) && _myAvatarController) {
-        myAvatarCollisionObject = _myAvatarController->getCollisionObject();
+    btCollisionObject* myAvatarCollisionObject = _myAvatarController ? _myAvatarController->getCollisionObject() : nullptr;
+
+    // place a temporary object for each region, and find the AABB of them all
+    ShapeManager* shapeManager = ObjectMotionState::getShapeManager();
+    std::unordered_map<uint64_t, const btCollisionShape*> shapes;
+    std::vector<btVector3> regionMins(regions.size());
+    std::vector<btVector3> regionMaxs(regions.size());
+    btVector3 batchMin(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+    btVector3 batchMax(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+    btScalar sumOfRegionVolumes = 0.0f;
+    while (_contactTestObjects.size() < regions.size()) {
+        _contactTestObjects.push_back(std::make_unique<btCollisionObject>());
+    }
+    for (size_t i = 0; i < regions.size(); ++i) {
+        const ContactTestRegion& region = regions[i];
+        uint64_t hash = region.shapeInfo.getHash();
+        auto shapeItr = shapes.find(hash);
+        if (shapeItr == shapes.end()) {
+            // for shapes built on a worker, the first request only starts building them
+            shapeItr = shapes.emplace(hash, shapeManager->getShape(region.shapeInfo)).first;
+        }
+        btCollisionObject* collisionObject = _contactTestObjects[i].get();
+        collisionObject->setCollisionShape(const_cast<btCollisionShape*>(shapeItr->second));
+        if (!shapeItr->second) {
+            continue;
+        }
+
+        btTransform bulletTransform;
+        bulletTransform.setOrigin(glmToBullet(region.transform.getTranslation()));
+        bulletTransform.setRotation(glmToBullet(region.transform.getRotation()));
+        collisionObject->setWorldTransform(bulletTransform);
+
+        shapeItr->second->getAabb(bulletTransform, regionMins[i], regionMaxs[i]);
+        batchMin.setMin(regionMins[i]);
+        batchMax.setMax(regionMaxs[i]);
+        btVector3 diagonal = regionMaxs[i] - regionMins[i];
+        sumOfRegionVolumes += diagonal.getX() * diagonal.getY() * diagonal.getZ();
+    }
+
+    // Regions close together share one broadphase query, whose results are then checked against each region's AABB.
+    // Regions far apart are queried one by one, so the shared query doesn't sweep the space between them.
+    const btScalar MAX_SHARED_QUERY_VOLUME_RATIO = 8.0f;
+    btVector3 batchDiagonal = batchMax - batchMin;
+    bool shareQuery = sumOfRegionVolumes > 0.0f &&
+        batchDiagonal.getX() * batchDiagonal.getY() * batchDiagonal.getZ() < MAX_SHARED_QUERY_VOLUME_RATIO * sumOfRegionVolumes;
+    btBroadphaseInterface* broadphase = _dynamicsWorld->getBroadphase();
+    std::vector<btBroadphaseProxy*> proxies;
+    BroadphaseProxyCollector proxyCollector(proxies);
+    if (shareQuery) {
+        broadphase->aabbTest(batchMin, batchMax, proxyCollector);
     }
 
-    auto contactCallback = AllContactsCallback((int32_t)mask, (int32_t)group, regionShapeInfo, regionTransform, myAvatarCollisionObject, threshold);
-    _dynamicsWorld->contactTest(&contactCallback.collisionObject, contactCallback);
+    for (size_t i = 0; i < regions.size(); ++i) {
+        btCollisionObject* collisionObject = _contactTestObjects[i].get();
+        if (collisionObject->getCollisionShape()) {
+            const ContactTestRegion& region = regions[i];
+            if (!shareQuery) {
+                proxies.clear();
+                broadphase->aabbTest(regionMins[i], regionMaxs[i], proxyCollector);
+            }
+            btCollisionObject* avatarObject = (region.mask & USER_COLLISION_GROUP_MY_AVATAR) ? myAvatarCollisionObject : nullptr;
+            AllContactsCallback contactCallback((int32_t)region.mask, (int32_t)region.group, collisionObject, avatarObject,
+                                                region.threshold, results.contacts);
+            for (btBroadphaseProxy* proxy : proxies) {
+                if ((!shareQuery || TestAabbAgainstAabb2(regionMins[i], regionMaxs[i], proxy->m_aabbMin, proxy->m_aabbMax))
+                        && contactCallback.needsCollision(proxy)) {
+                    _dynamicsWorld->contactPairTest(collisionObject, static_cast<btCollisionObject*>(proxy->m_clientObject),
+                                                    contactCallback);
+                }
+            }
+            collisionObject->setCollisionShape(nullptr);
+        }
+        results.offsets.push_back(results.contacts.size());
+    }
 
-    return contactCallback.contacts;
+    for (const auto& shape : shapes) {
+        if (shape.second) {
+            shapeManager->releaseShape(shape.second);
+        }
+    }
+    return results;
 }
 
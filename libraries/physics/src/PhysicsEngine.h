@@ -69,6 +69,31 @@ struct ContactTestResult {
     glm::vec3 collisionNormal;
 };
 
+// One region of a batched PhysicsEngine::contactTest()
+struct ContactTestRegion {
+    ContactTestRegion(const ShapeInfo& shapeInfo, const Transform& transform, uint16_t mask,
+                      uint16_t group = USER_COLLISION_GROUP_DYNAMIC, float threshold = 0.0f) :
+        shapeInfo(shapeInfo), transform(transform), mask(mask), group(group), threshold(threshold) {}
+
+    ShapeInfo shapeInfo;
+    Transform transform;
+    uint16_t mask;
+    uint16_t group;
+    float threshold;
+};
+
+// The contacts found by a batched PhysicsEngine::contactTest(), packed into one array.  The contacts of region i are
+// contacts[offsets[i]] up to, but not including, contacts[offsets[i + 1]].
+struct ContactTestResults {
+    size_t getNumContacts(size_t region) const { return offsets[region + 1] - offsets[region]; }
+    std::vector<ContactTestResult> getContacts(size_t region) const {
+        return std::vector<ContactTestResult>(contacts.begin() + offsets[region], contacts.begin() + offsets[region + 1]);
+    }
+
+    std::vector<ContactTestResult> contacts;
+    std::vector<size_t> offsets;
+};
+
 using ContactMap = std::map<ContactKey, ContactInfo>;
 using CollisionEvents = std::vector<Collision>;
 
@@ -99,6 +124,12 @@ public:
     uint32_t getNumSubsteps() const;
     int32_t getNumCollisionObjects() const;
 
+    // The number of threads that solve simulation islands, including the one stepping the simulation. More than one
+    // needs a Bullet built with multithreading, and otherwise the simulation stays single threaded.
+    static int getMaxNumPhysicsThreads();
+    void setNumPhysicsThreads(int numThreads);
+    int getNumPhysicsThreads() const { return _numPhysicsThreads; }
+
     void removeObjects(const VectorOfMotionStates& objects);
     void removeSetOfObjects(const SetOfMotionStates& objects); // only called during teardown
 
@@ -109,6 +140,8 @@ public:
     void processTransaction(Transaction& transaction);
 
     void stepSimulation();
+    // takes exactly timeStep, rather than the time since the last step, for a replay
+    void stepSimulation(float timeStep);
     void harvestPerformanceStats();
     void printPerformanceStatsToFile(const QString& filename);
     void updateContactMap();
@@ -119,6 +152,15 @@ public:
     /// \return reference to list of changed MotionStates.  The list is only valid until beginning of next simulation loop.
     const VectorOfMotionStates& getChangedMotionStates();
     const VectorOfMotionStates& getDeactivatedMotionStates() const { return _dynamicsWorld->getDeactivatedMotionStates(); }
+    /// \return the results of the active dynamic entities, when bulk motion state sync is enabled.  Valid as long as the
+    /// list of changed MotionStates.
+    const MotionStateBuffer& getMotionStateBuffer() const { return _dynamicsWorld->getMotionStateBuffer(); }
+
+    // Bulk sync gathers the results of the active dynamic entities in a MotionStateBuffer, rather than handing them to each
+    // EntityMotionState through btMotionState::setWorldTransform().  Enabled by default, and disabled to compare against
+    // the per body path.
+    void setBulkMotionStateSync(bool enabled);
+    bool isBulkMotionStateSync() const { return _bulkMotionStateSync; }
 
     /// \return reference to list of Collision events.  The list is only valid until beginning of next simulation loop.
     const CollisionEvents& getCollisionEvents();
@@ -129,6 +171,9 @@ public:
     /// \brief saves timings for last frame in filename
     void saveNextPhysicsStats(QString filename);
 
+    /// \brief saves the bodies and constraints of the world in filename, as a PhysicsSnapshot, before the next step
+    void saveNextSnapshot(QString filename);
+
     /// \param offset position of simulation origin in domain-frame
     void setOriginOffset(const glm::vec3& offset) { _originOffset = offset; }
 
@@ -153,6 +198,9 @@ public:
     // Function for getting colliding objects in the world of specified type
     // See PhysicsCollisionGroups.h for mask flags.
     std::vector<ContactTestResult> contactTest(uint16_t mask, const ShapeInfo& regionShapeInfo, const Transform& regionTransform, uint16_t group = USER_COLLISION_GROUP_DYNAMIC, float threshold = 0.0f) const;
+    // The same for many regions at once.  Regions of the same shape share it, and regions close together share one
+    // broadphase query, so this is much cheaper than a contactTest() per region.
+    ContactTestResults contactTest(const std::vector<ContactTestRegion>& regions) const;
 
     void setContactAddedCallback(ContactAddedCallback cb);
 
@@ -167,15 +215,20 @@ private:
     void bumpAndPruneContacts(ObjectMotionState* motionState);
 
     void doOwnershipInfection(const btCollisionObject* objectA, const btCollisionObject* objectB);
+    void applyNumPhysicsThreads();
 
     btClock _clock;
     btDefaultCollisionConfiguration* _collisionConfig = NULL;
     btCollisionDispatcher* _collisionDispatcher = NULL;
     btBroadphaseInterface* _broadphaseFilter = NULL;
-    btSequentialImpulseConstraintSolver* _constraintSolver = NULL;
+    btConstraintSolverPoolMt* _constraintSolver = NULL;
+    btConstraintSolver* _constraintSolverMt = NULL;
+    btITaskScheduler* _taskScheduler = NULL;
     ThreadSafeDynamicsWorld* _dynamicsWorld = NULL;
     btGhostPairCallback* _ghostPairCallback = NULL;
     std::unique_ptr<PhysicsDebugDraw> _physicsDebugDraw;
+    // the temporary objects of contactTest(), kept for the next call
+    mutable std::vector<std::unique_ptr<btCollisionObject>> _contactTestObjects;
 
     ContactMap _contactMap;
     CollisionEvents _collisionEvents;
@@ -183,15 +236,19 @@ private:
     QHash<btRigidBody*, QSet<QUuid>> _objectDynamicsByBody;
     std::set<btRigidBody*> _activeStaticBodies;
     QString _statsFilename;
+    QString _snapshotFilename;
 
     glm::vec3 _originOffset;
 
     CharacterController* _myAvatarController;
 
     uint32_t _numContactFrames { 0 };
+    int _numPhysicsThreads { 1 };
+    bool _bulkMotionStateSync { true };
 
     bool _dumpNextStats { false };
     bool _saveNextStats { false };
+    bool _saveNextSnapshot { false };
     bool _hasOutgoingChanges { false };
 
 };
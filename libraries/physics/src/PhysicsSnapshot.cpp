@@ -0,0 +1,362 @@
+//
+//  PhysicsSnapshot.cpp
+//  libraries/physics/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsSnapshot.h"
+
+#include <map>
+
+#include <QDataStream>
+#include <QFile>
+
+#include "PhysicsLogging.h"
+#include "ShapeFactory.h"
+
+// Whenever a change is made to the format of snapshots that isn't backward compatible, this value should be
+// incremented.  Snapshots written with any other version are not read.
+const quint32 PHYSICS_SNAPSHOT_VERSION = 1;
+const quint32 PHYSICS_SNAPSHOT_MAGIC = 0x50485953; // "PHYS"
+
+// enough for any world we'd simulate, and small enough to reject garbage before allocating for it
+const quint32 MAX_SNAPSHOT_COUNT = 1 << 20;
+
+static void writeVector(QDataStream& stream, const btVector3& v) {
+    stream << (float)v.getX() << (float)v.getY() << (float)v.getZ();
+}
+
+static btVector3 readVector(QDataStream& stream) {
+    float x, y, z;
+    stream >> x >> y >> z;
+    return btVector3(x, y, z);
+}
+
+static void writeTransform(QDataStream& stream, const btTransform& transform) {
+    btQuaternion rotation = transform.getRotation();
+    writeVector(stream, transform.getOrigin());
+    stream << (float)rotation.getX() << (float)rotation.getY() << (float)rotation.getZ() << (float)rotation.getW();
+}
+
+static btTransform readTransform(QDataStream& stream) {
+    btVector3 origin = readVector(stream);
+    float x, y, z, w;
+    stream >> x >> y >> z >> w;
+    return btTransform(btQuaternion(x, y, z, w), origin);
+}
+
+PhysicsSnapshot PhysicsSnapshot::capture(const btDiscreteDynamicsWorld* world) {
+    PhysicsSnapshot snapshot;
+    // the ShapeManager shares shapes between bodies, so they're written once each
+    std::map<const btCollisionShape*, int32_t> shapeIndices;
+    std::map<const btCollisionObject*, int32_t> bodyIndices;
+
+    const btCollisionObjectArray& objects = world->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); ++i) {
+        const btRigidBody* rigidBody = btRigidBody::upcast(objects[i]);
+        if (!rigidBody || !rigidBody->getBroadphaseHandle()) {
+            // ghost objects, of the character controller
+            ++snapshot.numSkippedObjects;
+            continue;
+        }
+        const btCollisionShape* shape = rigidBody->getCollisionShape();
+        auto shapeItr = shapeIndices.find(shape);
+        if (shapeItr == shapeIndices.end()) {
+            QByteArray data = ShapeFactory::serializeShape(shape);
+            int32_t shapeIndex = -1;
+            if (!data.isEmpty()) {
+                shapeIndex = (int32_t)snapshot.shapes.size();
+                snapshot.shapes.push_back(data);
+            }
+            shapeItr = shapeIndices.emplace(shape, shapeIndex).first;
+        }
+        if (shapeItr->second == -1) {
+            ++snapshot.numSkippedObjects;
+            continue;
+        }
+
+        Body body;
+        body.shape = shapeItr->second;
+        body.transform = rigidBody->getWorldTransform();
+        body.linearVelocity = rigidBody->getLinearVelocity();
+        body.angularVelocity = rigidBody->getAngularVelocity();
+        body.gravity = rigidBody->getGravity();
+        body.mass = rigidBody->getInvMass() > 0.0f ? 1.0f / rigidBody->getInvMass() : 0.0f;
+        body.friction = rigidBody->getFriction();
+        body.restitution = rigidBody->getRestitution();
+        body.linearDamping = rigidBody->getLinearDamping();
+        body.angularDamping = rigidBody->getAngularDamping();
+        if (rigidBody->isKinematicObject()) {
+            body.motionType = MOTION_TYPE_KINEMATIC;
+        } else if (rigidBody->isStaticObject()) {
+            body.motionType = MOTION_TYPE_STATIC;
+        } else {
+            body.motionType = MOTION_TYPE_DYNAMIC;
+        }
+        body.activationState = rigidBody->getActivationState();
+        body.group = rigidBody->getBroadphaseHandle()->m_collisionFilterGroup;
+        body.mask = rigidBody->getBroadphaseHandle()->m_collisionFilterMask;
+        bodyIndices[rigidBody] = (int32_t)snapshot.bodies.size();
+        snapshot.bodies.push_back(body);
+    }
+
+    const btRigidBody* fixedBody = &btTypedConstraint::getFixedBody();
+    auto findBody = [&](const btRigidBody& rigidBody, int32_t& index) {
+        if (&rigidBody == fixedBody) {
+            index = FIXED_BODY;
+            return true;
+        }
+        auto bodyItr = bodyIndices.find(&rigidBody);
+        if (bodyItr == bodyIndices.end()) {
+            return false;
+        }
+        index = bodyItr->second;
+        return true;
+    };
+
+    for (int i = 0; i < world->getNumConstraints(); ++i) {
+        const btTypedConstraint* typedConstraint = world->getConstraint(i);
+        Constraint constraint;
+        constraint.type = typedConstraint->getConstraintType();
+        if (!findBody(typedConstraint->getRigidBodyA(), constraint.bodyA) ||
+                !findBody(typedConstraint->getRigidBodyB(), constraint.bodyB)) {
+            ++snapshot.numSkippedConstraints;
+            continue;
+        }
+        switch (constraint.type) {
+            case POINT2POINT_CONSTRAINT_TYPE: {
+                const btPoint2PointConstraint* pointToPoint = static_cast<const btPoint2PointConstraint*>(typedConstraint);
+                constraint.frameA.setOrigin(pointToPoint->getPivotInA());
+                constraint.frameB.setOrigin(pointToPoint->getPivotInB());
+                break;
+            }
+            case HINGE_CONSTRAINT_TYPE: {
+                const btHingeConstraint* hinge = static_cast<const btHingeConstraint*>(typedConstraint);
+                constraint.frameA = hinge->getAFrame();
+                constraint.frameB = hinge->getBFrame();
+                constraint.limits[0] = hinge->getLowerLimit();
+                constraint.limits[1] = hinge->getUpperLimit();
+                constraint.useReferenceFrameA = hinge->getUseReferenceFrameA();
+                break;
+            }
+            case CONETWIST_CONSTRAINT_TYPE: {
+                const btConeTwistConstraint* coneTwist = static_cast<const btConeTwistConstraint*>(typedConstraint);
+                constraint.frameA = coneTwist->getAFrame();
+                constraint.frameB = coneTwist->getBFrame();
+                constraint.limits[0] = coneTwist->getSwingSpan1();
+                constraint.limits[1] = coneTwist->getSwingSpan2();
+                constraint.limits[2] = coneTwist->getTwistSpan();
+                break;
+            }
+            case SLIDER_CONSTRAINT_TYPE: {
+                // the slider's getters aren't const
+                btSliderConstraint* slider = const_cast<btSliderConstraint*>(
+                    static_cast<const btSliderConstraint*>(typedConstraint));
+                constraint.frameA = slider->getFrameOffsetA();
+                constraint.frameB = slider->getFrameOffsetB();
+                constraint.limits[0] = slider->getLowerLinLimit();
+                constraint.limits[1] = slider->getUpperLinLimit();
+                constraint.limits[2] = slider->getLowerAngLimit();
+                constraint.limits[3] = slider->getUpperAngLimit();
+                constraint.useReferenceFrameA = slider->getUseLinearReferenceFrameA();
+                break;
+            }
+            default:
+                // none of the ObjectConstraints make any other type
+                ++snapshot.numSkippedConstraints;
+                continue;
+        }
+        constraint.breakingImpulse = typedConstraint->getBreakingImpulseThreshold();
+        constraint.enabled = typedConstraint->isEnabled();
+        constraint.disableCollisions =
+            !typedConstraint->getRigidBodyA().checkCollideWithOverride(&typedConstraint->getRigidBodyB());
+        snapshot.constraints.push_back(constraint);
+    }
+    return snapshot;
+}
+
+btTypedConstraint* PhysicsSnapshot::createConstraint(const Constraint& constraint, btRigidBody& bodyA, btRigidBody& bodyB) {
+    btTypedConstraint* typedConstraint = nullptr;
+    switch (constraint.type) {
+        case POINT2POINT_CONSTRAINT_TYPE:
+            typedConstraint = new btPoint2PointConstraint(bodyA, bodyB, constraint.frameA.getOrigin(),
+                                                          constraint.frameB.getOrigin());
+            break;
+        case HINGE_CONSTRAINT_TYPE: {
+            btHingeConstraint* hinge = new btHingeConstraint(bodyA, bodyB, constraint.frameA, constraint.frameB,
+                                                             constraint.useReferenceFrameA);
+            hinge->setLimit(constraint.limits[0], constraint.limits[1]);
+            typedConstraint = hinge;
+            break;
+        }
+        case CONETWIST_CONSTRAINT_TYPE: {
+            btConeTwistConstraint* coneTwist = new btConeTwistConstraint(bodyA, bodyB, constraint.frameA, constraint.frameB);
+            coneTwist->setLimit(constraint.limits[0], constraint.limits[1], constraint.limits[2]);
+            typedConstraint = coneTwist;
+            break;
+        }
+        case SLIDER_CONSTRAINT_TYPE: {
+            btSliderConstraint* slider = new btSliderConstraint(bodyA, bodyB, constraint.frameA, constraint.frameB,
+                                                                constraint.useReferenceFrameA);
+            slider->setLowerLinLimit(constraint.limits[0]);
+            slider->setUpperLinLimit(constraint.limits[1]);
+            slider->setLowerAngLimit(constraint.limits[2]);
+            slider->setUpperAngLimit(constraint.limits[3]);
+            typedConstraint = slider;
+            break;
+        }
+        default:
+            return nullptr;
+    }
+    typedConstraint->setBreakingImpulseThreshold(constraint.breakingImpulse);
+    typedConstraint->setEnabled(constraint.enabled);
+    return typedConstraint;
+}
+
+QByteArray PhysicsSnapshot::toByteArray() const {
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    stream << PHYSICS_SNAPSHOT_MAGIC << PHYSICS_SNAPSHOT_VERSION << numSkippedObjects << numSkippedConstraints;
+
+    stream << (quint32)shapes.size();
+    for (const auto& shape : shapes) {
+        stream << shape;
+    }
+
+    stream << (quint32)bodies.size();
+    for (const auto& body : bodies) {
+        stream << (qint32)body.shape;
+        writeTransform(stream, body.transform);
+        writeVector(stream, body.linearVelocity);
+        writeVector(stream, body.angularVelocity);
+        writeVector(stream, body.gravity);
+        stream << body.mass << body.friction << body.restitution << body.linearDamping << body.angularDamping
+            << (quint8)body.motionType << (qint32)body.activationState << (qint32)body.group << (qint32)body.mask;
+    }
+
+    stream << (quint32)constraints.size();
+    for (const auto& constraint : constraints) {
+        stream << (qint32)constraint.type << (qint32)constraint.bodyA << (qint32)constraint.bodyB;
+        writeTransform(stream, constraint.frameA);
+        writeTransform(stream, constraint.frameB);
+        for (float limit : constraint.limits) {
+            stream << limit;
+        }
+        stream << constraint.breakingImpulse << constraint.useReferenceFrameA << constraint.enabled
+            << constraint.disableCollisions;
+    }
+    return data;
+}
+
+bool PhysicsSnapshot::fromByteArray(const QByteArray& data) {
+    *this = PhysicsSnapshot();
+    QDataStream stream(data);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    quint32 magic, version;
+    stream >> magic >> version;
+    if (stream.status() != QDataStream::Ok || magic != PHYSICS_SNAPSHOT_MAGIC || version != PHYSICS_SNAPSHOT_VERSION) {
+        return false;
+    }
+    stream >> numSkippedObjects >> numSkippedConstraints;
+
+    quint32 numShapes;
+    stream >> numShapes;
+    if (stream.status() != QDataStream::Ok || numShapes > MAX_SNAPSHOT_COUNT) {
+        *this = PhysicsSnapshot();
+        return false;
+    }
+    shapes.resize(numShapes);
+    for (auto& shape : shapes) {
+        stream >> shape;
+    }
+
+    quint32 numBodies;
+    stream >> numBodies;
+    if (stream.status() != QDataStream::Ok || numBodies > MAX_SNAPSHOT_COUNT) {
+        *this = PhysicsSnapshot();
+        return false;
+    }
+    bodies.resize(numBodies);
+    for (auto& body : bodies) {
+        qint32 shape, activationState, group, mask;
+        quint8 motionType;
+        stream >> shape;
+        body.transform = readTransform(stream);
+        body.linearVelocity = readVector(stream);
+        body.angularVelocity = readVector(stream);
+        body.gravity = readVector(stream);
+        stream >> body.mass >> body.friction >> body.restitution >> body.linearDamping >> body.angularDamping
+            >> motionType >> activationState >> group >> mask;
+        if (shape < 0 || shape >= (qint32)numShapes || motionType > MOTION_TYPE_KINEMATIC) {
+            *this = PhysicsSnapshot();
+            return false;
+        }
+        body.shape = shape;
+        body.motionType = (PhysicsMotionType)motionType;
+        body.activationState = activationState;
+        body.group = group;
+        body.mask = mask;
+    }
+
+    quint32 numConstraints;
+    stream >> numConstraints;
+    if (stream.status() != QDataStream::Ok || numConstraints > MAX_SNAPSHOT_COUNT) {
+        *this = PhysicsSnapshot();
+        return false;
+    }
+    constraints.resize(numConstraints);
+    for (auto& constraint : constraints) {
+        qint32 type, bodyA, bodyB;
+        stream >> type >> bodyA >> bodyB;
+        constraint.frameA = readTransform(stream);
+        constraint.frameB = readTransform(stream);
+        for (float& limit : constraint.limits) {
+            stream >> limit;
+        }
+        stream >> constraint.breakingImpulse >> constraint.useReferenceFrameA >> constraint.enabled
+            >> constraint.disableCollisions;
+        if (bodyA < FIXED_BODY || bodyA >= (qint32)numBodies || bodyB < FIXED_BODY || bodyB >= (qint32)numBodies) {
+            *this = PhysicsSnapshot();
+            return false;
+        }
+        constraint.type = type;
+        constraint.bodyA = bodyA;
+        constraint.bodyB = bodyB;
+    }
+
+    if (stream.status() != QDataStream::Ok || !stream.atEnd()) {
+        *this = PhysicsSnapshot();
+        return false;
+    }
+    return true;
+}
+
+bool PhysicsSnapshot::save(const QString& filename) const {
+    QFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(physics) << "unable to open file" << filename << "to save the physics snapshot";
+        return false;
+    }
+    QByteArray data = toByteArray();
+    return file.write(data) == data.size();
+}
+
+bool PhysicsSnapshot::load(const QString& filename) {
+    QFile file(filename);
+    if (!file.open(QIODevice::ReadOnly)) {
+        qCWarning(physics) << "unable to open file" << filename << "to load a physics snapshot";
+        *this = PhysicsSnapshot();
+        return false;
+    }
+    if (!fromByteArray(file.readAll())) {
+        qCWarning(physics) << filename << "is not a physics snapshot of this version";
+        return false;
+    }
+    return true;
+}
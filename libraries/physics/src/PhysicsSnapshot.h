@@ -0,0 +1,83 @@
+//
+//  PhysicsSnapshot.h
+//  libraries/physics/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsSnapshot_h
+#define hifi_PhysicsSnapshot_h
+
+#include <vector>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <QByteArray>
+#include <QString>
+
+#include "ObjectMotionState.h"
+
+// The rigid bodies and constraints of a dynamics world, with what's needed to build it again and step it as it would
+// have been stepped, so that a slow frame can be replayed and profiled outside of the application.  Actions and the
+// character controller aren't captured, though the character's body is, as a plain body.
+class PhysicsSnapshot {
+public:
+    struct Body {
+        int32_t shape { -1 }; // index into shapes
+        btTransform transform { btTransform::getIdentity() };
+        btVector3 linearVelocity { 0.0f, 0.0f, 0.0f };
+        btVector3 angularVelocity { 0.0f, 0.0f, 0.0f };
+        btVector3 gravity { 0.0f, 0.0f, 0.0f };
+        float mass { 0.0f };
+        float friction { 0.0f };
+        float restitution { 0.0f };
+        float linearDamping { 0.0f };
+        float angularDamping { 0.0f };
+        PhysicsMotionType motionType { MOTION_TYPE_STATIC };
+        int32_t activationState { ACTIVE_TAG };
+        int32_t group { 0 };
+        int32_t mask { 0 };
+    };
+
+    static const int32_t FIXED_BODY = -1;
+
+    struct Constraint {
+        int32_t type { POINT2POINT_CONSTRAINT_TYPE }; // a btTypedConstraintType
+        int32_t bodyA { FIXED_BODY }; // index into bodies
+        int32_t bodyB { FIXED_BODY };
+        // pivots only, for a point to point constraint
+        btTransform frameA { btTransform::getIdentity() };
+        btTransform frameB { btTransform::getIdentity() };
+        // hinge: low, high; cone twist: swing span 1, swing span 2, twist span; slider: lower and upper linear, then
+        // lower and upper angular
+        float limits[4] { 0.0f, 0.0f, 0.0f, 0.0f };
+        float breakingImpulse { 0.0f };
+        bool useReferenceFrameA { true };
+        bool enabled { true };
+        bool disableCollisions { false };
+    };
+
+    // Bodies whose shape can't be serialized are left out, and so are the constraints on them
+    static PhysicsSnapshot capture(const btDiscreteDynamicsWorld* world);
+    // builds the constraint between the bodies, either of which may be btTypedConstraint::getFixedBody()
+    static btTypedConstraint* createConstraint(const Constraint& constraint, btRigidBody& bodyA, btRigidBody& bodyB);
+
+    QByteArray toByteArray() const;
+    // returns false, leaving the snapshot empty, for data that isn't a snapshot written with this version
+    bool fromByteArray(const QByteArray& data);
+
+    bool save(const QString& filename) const;
+    bool load(const QString& filename);
+
+    std::vector<QByteArray> shapes; // as written by ShapeFactory::serializeShape()
+    std::vector<Body> bodies;
+    std::vector<Constraint> constraints;
+    uint32_t numSkippedObjects { 0 };
+    uint32_t numSkippedConstraints { 0 };
+};
+
+#endif // hifi_PhysicsSnapshot_h
@@ -0,0 +1,70 @@
+//
+//  ShapeCache.cpp
+//  libraries/physics/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ShapeCache.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QFile>
+
+#include <NumericalConstants.h>
+
+#include "ShapeFactory.h"
+
+const std::string ShapeCache::DIRNAME { "shape_cache" };
+const std::string ShapeCache::EXT { "shape" };
+const size_t ShapeCache::MAX_SIZE { GB_TO_BYTES(1) };
+
+ShapeCache::ShapeCache(const std::string& dir, const std::string& ext) :
+    FileCache(dir, ext) { }
+
+void ShapeCache::initialize() {
+    FileCache::initialize();
+    setMaxSize(MAX_SIZE);
+}
+
+cache::FileCache::Key ShapeCache::getKey(const ShapeInfo& info) {
+    QCryptographicHash contentHash(QCryptographicHash::Md5);
+    for (const auto& points : info.getPointCollection()) {
+        contentHash.addData((const char*)points.constData(), points.size() * (int)sizeof(glm::vec3));
+    }
+    const ShapeInfo::TriangleIndices& triangleIndices = info.getTriangleIndices();
+    contentHash.addData((const char*)triangleIndices.constData(), triangleIndices.size() * (int)sizeof(int32_t));
+
+    QString key = QString("%1-%2").arg(info.getHash(), 16, 16, QChar('0')).arg(QString(contentHash.result().toHex()));
+    return key.toStdString();
+}
+
+const btCollisionShape* ShapeCache::loadShape(const Key& key) {
+    cache::FilePointer file = getFile(key);
+    if (!file) {
+        return nullptr;
+    }
+    QFile diskFile(QString::fromStdString(file->getFilepath()));
+    if (!diskFile.open(QIODevice::ReadOnly)) {
+        qCWarning(file_cache) << "Failed to open shape" << key.c_str();
+        return nullptr;
+    }
+    const btCollisionShape* shape = ShapeFactory::deserializeShape(diskFile.readAll());
+    if (!shape) {
+        // from an older build, most likely, and saveShape() will replace it
+        qCDebug(file_cache) << "Failed to read shape" << key.c_str();
+    }
+    return shape;
+}
+
+bool ShapeCache::saveShape(const Key& key, const btCollisionShape* shape) {
+    QByteArray data = ShapeFactory::serializeShape(shape);
+    if (data.isEmpty()) {
+        return false;
+    }
+    const bool OVERWRITE = true;
+    return (bool)writeFile(data.constData(), Metadata(key, (size_t)data.size()), OVERWRITE);
+}
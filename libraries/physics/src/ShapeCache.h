@@ -0,0 +1,44 @@
+//
+//  ShapeCache.h
+//  libraries/physics/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ShapeCache_h
+#define hifi_ShapeCache_h
+
+#include <btBulletDynamicsCommon.h>
+
+#include <ShapeInfo.h>
+#include <shared/FileCache.h>
+
+// A disk cache of the shapes that are expensive to build (see ShapeManager::isBuiltOffThread()), so that the models
+// of a domain don't have their hulls and mesh BVHs built again on every visit.  Shapes are keyed by their ShapeInfo's
+// hash and a hash of the model geometry in it, since the ShapeInfo hash alone only covers the model's URL.
+//
+// loadShape() and saveShape() are called by the ShapeManager's workers, on any thread.
+class ShapeCache : public cache::FileCache {
+    Q_OBJECT
+public:
+    static const std::string DIRNAME;
+    static const std::string EXT;
+    static const size_t MAX_SIZE;
+
+    ShapeCache(const std::string& dir = DIRNAME, const std::string& ext = EXT);
+
+    void initialize() override;
+
+    static Key getKey(const ShapeInfo& info);
+
+    /// \return a new shape built from the cached file, or nullptr when there isn't one that can be read
+    const btCollisionShape* loadShape(const Key& key);
+    /// \return true if the shape was written to the cache
+    bool saveShape(const Key& key, const btCollisionShape* shape);
+};
+
+#endif // hifi_ShapeCache_h
@@ -13,11 +13,29 @@
 
 #include <glm/gtx/norm.hpp>
 
+#include <QDataStream>
+
 #include <SharedUtil.h> // for MILLIMETERS_PER_METER
 
 #include "BulletUtil.h"
 
 
+// frees a data array along with the vertex/index data it points to
+static void deleteStaticMeshArray(btTriangleIndexVertexArray* dataArray) {
+    IndexedMeshArray& meshes = dataArray->getIndexedMeshArray();
+    for (int32_t i = 0; i < meshes.size(); ++i) {
+        btIndexedMesh mesh = meshes[i];
+        mesh.m_numTriangles = 0;
+        delete [] mesh.m_triangleIndexBase;
+        mesh.m_triangleIndexBase = nullptr;
+        mesh.m_numVertices = 0;
+        delete [] mesh.m_vertexBase;
+        mesh.m_vertexBase = nullptr;
+    }
+    meshes.clear();
+    delete dataArray;
+}
+
 class StaticMeshShape : public btBvhTriangleMeshShape {
 public:
     StaticMeshShape() = delete;
@@ -27,26 +45,30 @@ public:
         assert(_dataArray);
     }
 
+    // for a mesh whose BVH was deserialized in place, into bvhBuffer
+    StaticMeshShape(btTriangleIndexVertexArray* dataArray, btOptimizedBvh* bvh, void* bvhBuffer)
+    :   btBvhTriangleMeshShape(dataArray, true, false), _dataArray(dataArray), _bvhBuffer(bvhBuffer) {
+        assert(_dataArray);
+        assert(bvh && _bvhBuffer);
+        setOptimizedBvh(bvh);
+    }
+
     ~StaticMeshShape() {
+        if (_bvhBuffer) {
+            // the base class doesn't own a BVH it was given
+            getOptimizedBvh()->~btOptimizedBvh();
+            btAlignedFree(_bvhBuffer);
+            _bvhBuffer = nullptr;
+        }
         assert(_dataArray);
-        IndexedMeshArray& meshes = _dataArray->getIndexedMeshArray();
-        for (int32_t i = 0; i < meshes.size(); ++i) {
-            btIndexedMesh mesh = meshes[i];
-            mesh.m_numTriangles = 0;
-            delete [] mesh.m_triangleIndexBase;
-            mesh.m_triangleIndexBase = nullptr;
-            mesh.m_numVertices = 0;
-            delete [] mesh.m_vertexBase;
-            mesh.m_vertexBase = nullptr;
-        }
-        meshes.clear();
-        delete _dataArray;
+        deleteStaticMeshArray(_dataArray);
         _dataArray = nullptr;
     }
 
 private:
     // the StaticMeshShape owns its vertex/index data
     btTriangleIndexVertexArray* _dataArray;
+    void* _bvhBuffer { nullptr };
 };
 
 // the dataArray must be created before we create the StaticMeshShape
@@ -483,7 +505,346 @@ void ShapeFactory::deleteShape(const btCollisionShape* shape) {
     delete nonConstShape;
 }
 
-void ShapeFactory::Worker::run() {
-    shape = ShapeFactory::createShapeFromInfo(shapeInfo);
-    emit submitWork(this);
+// Whenever a change is made to the serialized format of shapes that isn't backward compatible,
+// this value should be incremented.  Data in an older format is ignored, and the shape is built again.
+const quint32 SERIALIZED_SHAPE_VERSION = 1;
+const quint32 SERIALIZED_SHAPE_MAGIC = 0x53485045; // "SHPE"
+
+enum SerializedShapeType : quint8 {
+    SERIALIZED_HULL = 0,
+    SERIALIZED_COMPOUND,
+    SERIALIZED_STATIC_MESH,
+    // primitives, for physics snapshots
+    SERIALIZED_BOX,
+    SERIALIZED_SPHERE,
+    SERIALIZED_CAPSULE,
+    SERIALIZED_CYLINDER,
+    SERIALIZED_MULTI_SPHERE
+};
+
+static void writeVector(QDataStream& stream, const btVector3& v) {
+    stream << (float)v.getX() << (float)v.getY() << (float)v.getZ();
+}
+
+static btVector3 readVector(QDataStream& stream) {
+    float x, y, z;
+    stream >> x >> y >> z;
+    return btVector3(x, y, z);
+}
+
+static bool writeShape(QDataStream& stream, const btCollisionShape* shape) {
+    switch (shape->getShapeType()) {
+        case CONVEX_HULL_SHAPE_PROXYTYPE: {
+            const btConvexHullShape* hull = static_cast<const btConvexHullShape*>(shape);
+            int32_t numPoints = hull->getNumPoints();
+            const btVector3* points = hull->getUnscaledPoints();
+            stream << (quint8)SERIALIZED_HULL << (float)hull->getMargin() << (quint32)numPoints;
+            for (int32_t i = 0; i < numPoints; ++i) {
+                writeVector(stream, points[i]);
+            }
+            return true;
+        }
+        case COMPOUND_SHAPE_PROXYTYPE: {
+            const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+            int32_t numChildren = compound->getNumChildShapes();
+            stream << (quint8)SERIALIZED_COMPOUND << (quint32)numChildren;
+            for (int32_t i = 0; i < numChildren; ++i) {
+                const btTransform& transform = compound->getChildTransform(i);
+                btQuaternion rotation = transform.getRotation();
+                writeVector(stream, transform.getOrigin());
+                stream << (float)rotation.getX() << (float)rotation.getY() << (float)rotation.getZ() << (float)rotation.getW();
+                if (!writeShape(stream, compound->getChildShape(i))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        case TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+            const btBvhTriangleMeshShape* mesh = static_cast<const btBvhTriangleMeshShape*>(shape);
+            const btTriangleIndexVertexArray* dataArray =
+                dynamic_cast<const btTriangleIndexVertexArray*>(mesh->getMeshInterface());
+            btOptimizedBvh* bvh = const_cast<btBvhTriangleMeshShape*>(mesh)->getOptimizedBvh();
+            // a StaticMeshShape has one mesh, of float vertices
+            if (!dataArray || !bvh || dataArray->getIndexedMeshArray().size() != 1) {
+                return false;
+            }
+            const btIndexedMesh& indexedMesh = dataArray->getIndexedMeshArray()[0];
+            if (indexedMesh.m_vertexType != PHY_FLOAT) {
+                return false;
+            }
+            size_t indexSize = indexedMesh.m_indexType == PHY_SHORT ? sizeof(int16_t) : sizeof(int32_t);
+            const int32_t VERTICES_PER_TRIANGLE = 3;
+            stream << (quint8)SERIALIZED_STATIC_MESH << (quint8)indexedMesh.m_indexType
+                << (quint32)indexedMesh.m_numVertices << (quint32)indexedMesh.m_numTriangles;
+            stream.writeRawData((const char*)indexedMesh.m_vertexBase,
+                (int)(VERTICES_PER_TRIANGLE * sizeof(btScalar) * (size_t)indexedMesh.m_numVertices));
+            stream.writeRawData((const char*)indexedMesh.m_triangleIndexBase,
+                (int)(VERTICES_PER_TRIANGLE * indexSize * (size_t)indexedMesh.m_numTriangles));
+
+            // Bullet's own BVH serialization, in this machine's byte order
+            QByteArray bvhData((int)bvh->calculateSerializeBufferSize(), 0);
+            if (!bvh->serializeInPlace(bvhData.data(), (unsigned)bvhData.size(), false)) {
+                return false;
+            }
+            stream << (quint32)bvhData.size();
+            stream.writeRawData(bvhData.constData(), bvhData.size());
+            return true;
+        }
+        case BOX_SHAPE_PROXYTYPE: {
+            const btBoxShape* box = static_cast<const btBoxShape*>(shape);
+            stream << (quint8)SERIALIZED_BOX << (float)box->getMargin();
+            writeVector(stream, box->getHalfExtentsWithMargin());
+            return true;
+        }
+        case SPHERE_SHAPE_PROXYTYPE: {
+            const btSphereShape* sphere = static_cast<const btSphereShape*>(shape);
+            stream << (quint8)SERIALIZED_SPHERE << (float)sphere->getRadius();
+            return true;
+        }
+        case CAPSULE_SHAPE_PROXYTYPE: {
+            const btCapsuleShape* capsule = static_cast<const btCapsuleShape*>(shape);
+            stream << (quint8)SERIALIZED_CAPSULE << (quint8)capsule->getUpAxis() << (float)capsule->getRadius()
+                << (float)capsule->getHalfHeight();
+            return true;
+        }
+        case CYLINDER_SHAPE_PROXYTYPE: {
+            const btCylinderShape* cylinder = static_cast<const btCylinderShape*>(shape);
+            stream << (quint8)SERIALIZED_CYLINDER << (quint8)cylinder->getUpAxis() << (float)cylinder->getMargin();
+            writeVector(stream, cylinder->getHalfExtentsWithMargin());
+            return true;
+        }
+        case MULTI_SPHERE_SHAPE_PROXYTYPE: {
+            const btMultiSphereShape* multiSphere = static_cast<const btMultiSphereShape*>(shape);
+            int32_t numSpheres = multiSphere->getSphereCount();
+            stream << (quint8)SERIALIZED_MULTI_SPHERE << (float)multiSphere->getMargin() << (quint32)numSpheres;
+            for (int32_t i = 0; i < numSpheres; ++i) {
+                writeVector(stream, multiSphere->getSpherePosition(i));
+                stream << (float)multiSphere->getSphereRadius(i);
+            }
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+static btCollisionShape* readShape(QDataStream& stream) {
+    // enough for any shape we'd build, and small enough to reject garbage before allocating for it
+    const quint32 MAX_SERIALIZED_COUNT = 1 << 24;
+
+    quint8 type;
+    stream >> type;
+    if (stream.status() != QDataStream::Ok) {
+        return nullptr;
+    }
+    switch (type) {
+        case SERIALIZED_HULL: {
+            float margin;
+            quint32 numPoints;
+            stream >> margin >> numPoints;
+            if (stream.status() != QDataStream::Ok || numPoints == 0 || numPoints > MAX_SERIALIZED_COUNT) {
+                return nullptr;
+            }
+            btConvexHullShape* hull = new btConvexHullShape();
+            hull->setMargin(margin);
+            for (quint32 i = 0; i < numPoints; ++i) {
+                hull->addPoint(readVector(stream), false);
+            }
+            if (stream.status() != QDataStream::Ok) {
+                delete hull;
+                return nullptr;
+            }
+            hull->recalcLocalAabb();
+            return hull;
+        }
+        case SERIALIZED_COMPOUND: {
+            quint32 numChildren;
+            stream >> numChildren;
+            if (stream.status() != QDataStream::Ok || numChildren > MAX_SERIALIZED_COUNT) {
+                return nullptr;
+            }
+            btCompoundShape* compound = new btCompoundShape();
+            for (quint32 i = 0; i < numChildren; ++i) {
+                btVector3 origin = readVector(stream);
+                float x, y, z, w;
+                stream >> x >> y >> z >> w;
+                btCollisionShape* child = stream.status() == QDataStream::Ok ? readShape(stream) : nullptr;
+                if (!child) {
+                    ShapeFactory::deleteShape(compound);
+                    return nullptr;
+                }
+                compound->addChildShape(btTransform(btQuaternion(x, y, z, w), origin), child);
+            }
+            return compound;
+        }
+        case SERIALIZED_STATIC_MESH: {
+            quint8 indexType;
+            quint32 numVertices, numTriangles;
+            stream >> indexType >> numVertices >> numTriangles;
+            if (stream.status() != QDataStream::Ok || (indexType != PHY_SHORT && indexType != PHY_INTEGER)
+                    || numVertices > MAX_SERIALIZED_COUNT || numTriangles > MAX_SERIALIZED_COUNT) {
+                return nullptr;
+            }
+            const int32_t VERTICES_PER_TRIANGLE = 3;
+            size_t indexSize = indexType == PHY_SHORT ? sizeof(int16_t) : sizeof(int32_t);
+            int vertexDataSize = (int)(VERTICES_PER_TRIANGLE * sizeof(btScalar) * (size_t)numVertices);
+            int indexDataSize = (int)(VERTICES_PER_TRIANGLE * indexSize * (size_t)numTriangles);
+
+            btIndexedMesh mesh;
+            mesh.m_numTriangles = (int)numTriangles;
+            mesh.m_triangleIndexBase = new unsigned char[indexDataSize];
+            mesh.m_indexType = (PHY_ScalarType)indexType;
+            mesh.m_triangleIndexStride = (int)(VERTICES_PER_TRIANGLE * indexSize);
+            mesh.m_numVertices = (int)numVertices;
+            mesh.m_vertexBase = new unsigned char[vertexDataSize];
+            mesh.m_vertexStride = VERTICES_PER_TRIANGLE * sizeof(btScalar);
+            mesh.m_vertexType = PHY_FLOAT;
+            btTriangleIndexVertexArray* dataArray = new btTriangleIndexVertexArray;
+            dataArray->addIndexedMesh(mesh, mesh.m_indexType);
+
+            quint32 bvhSize = 0;
+            if (stream.readRawData((char*)mesh.m_vertexBase, vertexDataSize) == vertexDataSize
+                    && stream.readRawData((char*)mesh.m_triangleIndexBase, indexDataSize) == indexDataSize) {
+                stream >> bvhSize;
+            }
+            void* bvhBuffer = nullptr;
+            btOptimizedBvh* bvh = nullptr;
+            if (stream.status() == QDataStream::Ok && bvhSize > 0 && bvhSize <= MAX_SERIALIZED_COUNT * sizeof(btQuantizedBvhNode)) {
+                // the deserialized BVH lives in its buffer, which must be aligned for it
+                const int BVH_ALIGNMENT = 16;
+                bvhBuffer = btAlignedAlloc(bvhSize, BVH_ALIGNMENT);
+                if (stream.readRawData((char*)bvhBuffer, (int)bvhSize) == (int)bvhSize) {
+                    bvh = static_cast<btOptimizedBvh*>(btOptimizedBvh::deSerializeInPlace(bvhBuffer, bvhSize, false));
+                }
+            }
+            if (!bvh) {
+                if (bvhBuffer) {
+                    btAlignedFree(bvhBuffer);
+                }
+                deleteStaticMeshArray(dataArray);
+                return nullptr;
+            }
+            return new StaticMeshShape(dataArray, bvh, bvhBuffer);
+        }
+        case SERIALIZED_BOX: {
+            float margin;
+            stream >> margin;
+            btVector3 halfExtents = readVector(stream);
+            if (stream.status() != QDataStream::Ok) {
+                return nullptr;
+            }
+            // setMargin() keeps the extents with the margin, which is what was written
+            btBoxShape* box = new btBoxShape(halfExtents);
+            box->setMargin(margin);
+            return box;
+        }
+        case SERIALIZED_SPHERE: {
+            float radius;
+            stream >> radius;
+            if (stream.status() != QDataStream::Ok) {
+                return nullptr;
+            }
+            return new btSphereShape(radius);
+        }
+        case SERIALIZED_CAPSULE: {
+            quint8 upAxis;
+            float radius, halfHeight;
+            stream >> upAxis >> radius >> halfHeight;
+            if (stream.status() != QDataStream::Ok) {
+                return nullptr;
+            }
+            switch (upAxis) {
+                case 0:
+                    return new btCapsuleShapeX(radius, 2.0f * halfHeight);
+                case 1:
+                    return new btCapsuleShape(radius, 2.0f * halfHeight);
+                case 2:
+                    return new btCapsuleShapeZ(radius, 2.0f * halfHeight);
+                default:
+                    return nullptr;
+            }
+        }
+        case SERIALIZED_CYLINDER: {
+            quint8 upAxis;
+            float margin;
+            stream >> upAxis >> margin;
+            btVector3 halfExtents = readVector(stream);
+            if (stream.status() != QDataStream::Ok) {
+                return nullptr;
+            }
+            btCylinderShape* cylinder = nullptr;
+            switch (upAxis) {
+                case 0:
+                    cylinder = new btCylinderShapeX(halfExtents);
+                    break;
+                case 1:
+                    cylinder = new btCylinderShape(halfExtents);
+                    break;
+                case 2:
+                    cylinder = new btCylinderShapeZ(halfExtents);
+                    break;
+                default:
+                    return nullptr;
+            }
+            cylinder->setMargin(margin);
+            return cylinder;
+        }
+        case SERIALIZED_MULTI_SPHERE: {
+            float margin;
+            quint32 numSpheres;
+            stream >> margin >> numSpheres;
+            if (stream.status() != QDataStream::Ok || numSpheres == 0 || numSpheres > MAX_SERIALIZED_COUNT) {
+                return nullptr;
+            }
+            std::vector<btVector3> positions;
+            std::vector<btScalar> radiuses;
+            positions.reserve(numSpheres);
+            radiuses.reserve(numSpheres);
+            for (quint32 i = 0; i < numSpheres; ++i) {
+                positions.push_back(readVector(stream));
+                float radius;
+                stream >> radius;
+                radiuses.push_back(radius);
+            }
+            if (stream.status() != QDataStream::Ok) {
+                return nullptr;
+            }
+            btMultiSphereShape* multiSphere = new btMultiSphereShape(positions.data(), radiuses.data(), (int)numSpheres);
+            multiSphere->setMargin(margin);
+            return multiSphere;
+        }
+        default:
+            return nullptr;
+    }
+}
+
+QByteArray ShapeFactory::serializeShape(const btCollisionShape* shape) {
+    QByteArray data;
+    if (shape) {
+        QDataStream stream(&data, QIODevice::WriteOnly);
+        stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+        stream << SERIALIZED_SHAPE_MAGIC << SERIALIZED_SHAPE_VERSION << (quint32)sizeof(btScalar);
+        if (!writeShape(stream, shape)) {
+            data.clear();
+        }
+    }
+    return data;
+}
+
+const btCollisionShape* ShapeFactory::deserializeShape(const QByteArray& data) {
+    QDataStream stream(data);
+    stream.setFloatingPointPrecision(QDataStream::SinglePrecision);
+    quint32 magic, version, scalarSize;
+    stream >> magic >> version >> scalarSize;
+    if (stream.status() != QDataStream::Ok || magic != SERIALIZED_SHAPE_MAGIC || version != SERIALIZED_SHAPE_VERSION
+            || scalarSize != sizeof(btScalar)) {
+        return nullptr;
+    }
+    btCollisionShape* shape = readShape(stream);
+    if (shape && !stream.atEnd()) {
+        // trailing garbage, so don't trust any of it
+        ShapeFactory::deleteShape(shape);
+        shape = nullptr;
+    }
+    return shape;
 }
@@ -14,8 +14,8 @@
 
 #include <btBulletDynamicsCommon.h>
 #include <glm/glm.hpp>
-#include <QObject>
-#include <QtCore/QRunnable>
+
+#include <QByteArray>
 
 #include <ShapeInfo.h>
 
@@ -25,16 +25,11 @@ namespace ShapeFactory {
     const btCollisionShape* createShapeFromInfo(const ShapeInfo& info);
     void deleteShape(const btCollisionShape* shape);
 
-    class Worker : public QObject, public QRunnable {
-        Q_OBJECT
-    public:
-        Worker(const ShapeInfo& info) : shapeInfo(info), shape(nullptr) {}
-        void run() override;
-        ShapeInfo shapeInfo;
-        const btCollisionShape* shape;
-    signals:
-        void submitWork(Worker*);
-    };
+    // Hulls, compounds and static meshes can be saved and restored, for the ShapeCache, and so can the primitive
+    // shapes, for a PhysicsSnapshot.  Meshes keep their BVH so it needn't be built again.  serializeShape() returns an
+    // empty array for any other shape, and deserializeShape() returns nullptr for data it can't read.
+    QByteArray serializeShape(const btCollisionShape* shape);
+    const btCollisionShape* deserializeShape(const QByteArray& data);
 };
 
 #endif // hifi_ShapeFactory_h
@@ -12,27 +12,83 @@
 #include "ShapeManager.h"
 
 #include <glm/gtx/norm.hpp>
+#include <QThread>
 #include <QThreadPool>
 
 #include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 const int MAX_RING_SIZE = 256;
 
+// builds one shape on a thread of ShapeManager::_workerPool, or loads it from the disk cache
+class ShapeManager::ShapeBuildJob : public QRunnable {
+public:
+    ShapeBuildJob(ShapeManager& shapeManager, const ShapeInfo& info, const std::shared_ptr<ShapeCache>& diskCache) :
+        _shapeManager(shapeManager), _info(info), _diskCache(diskCache) {}
+
+    void run() override {
+        uint64_t start = usecTimestampNow();
+        const btCollisionShape* shape = nullptr;
+        ShapeCache::Key cacheKey;
+        if (_diskCache) {
+            cacheKey = ShapeCache::getKey(_info);
+            shape = _diskCache->loadShape(cacheKey);
+            if (shape) {
+                ++_shapeManager._diskCacheHitCount;
+            }
+        }
+        if (!shape) {
+            shape = ShapeFactory::createShapeFromInfo(_info);
+            if (shape && _diskCache) {
+                _diskCache->saveShape(cacheKey, shape);
+            }
+        }
+        _shapeManager.queueFinishedShape({ _info.getHash(), shape, usecTimestampNow() - start });
+    }
+
+private:
+    ShapeManager& _shapeManager;
+    ShapeInfo _info;
+    std::shared_ptr<ShapeCache> _diskCache;
+};
+
 ShapeManager::ShapeManager() {
     _garbageRing.reserve(MAX_RING_SIZE);
     _nextOrphanExpiry = std::chrono::steady_clock::now();
+
+    // a pool of its own so that loading a domain full of models doesn't hold up other users of the global pool,
+    // and leaves cores for the main and render threads
+    _workerPool.setMaxThreadCount(std::max(1, QThread::idealThreadCount() / 2));
+    _workerPool.setObjectName("ShapeManager workers");
 }
 
 ShapeManager::~ShapeManager() {
+    _workerPool.clear();
+    _workerPool.waitForDone();
+    for (const auto& finishedShape : _finishedWork) {
+        if (finishedShape.shape) {
+            ShapeFactory::deleteShape(finishedShape.shape);
+        }
+    }
+    _finishedWork.clear();
+
     int numShapes = _shapeMap.size();
     for (int i = 0; i < numShapes; ++i) {
         ShapeReference* shapeRef = _shapeMap.getAtIndex(i);
         ShapeFactory::deleteShape(shapeRef->shape);
     }
     _shapeMap.clear();
-    if (_deadWorker) {
-        delete _deadWorker;
-        _deadWorker = nullptr;
+}
+
+bool ShapeManager::isBuiltOffThread(ShapeType type) {
+    switch (type) {
+        case SHAPE_TYPE_COMPOUND:
+        case SHAPE_TYPE_SIMPLE_HULL:
+        case SHAPE_TYPE_SIMPLE_COMPOUND:
+        case SHAPE_TYPE_STATIC_MESH:
+            return true;
+        default:
+            return false;
     }
 }
 
@@ -47,29 +103,18 @@ const btCollisionShape* ShapeManager::getShape(const ShapeInfo& info) {
         return shapeRef->shape;
     }
     const btCollisionShape* shape = nullptr;
-    if (info.getType() == SHAPE_TYPE_STATIC_MESH) {
+    if (isBuiltOffThread(info.getType())) {
         uint64_t hash = info.getHash();
 
         // bump the request count to the caller knows we're 
         // starting or waiting on a thread.
         ++_workRequestCount;
 
-        const auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), hash);
-        if (itr == _pendingMeshShapes.end()) {
-            // start a worker
-            _pendingMeshShapes.push_back(hash);
-            // try to recycle old deadWorker
-            ShapeFactory::Worker* worker = _deadWorker;
-            if (!worker) {
-                worker = new ShapeFactory::Worker(info);
-            } else {
-                worker->shapeInfo = info;
-                _deadWorker = nullptr;
-            }
-            // we will delete worker manually later
-            worker->setAutoDelete(false);
-            QObject::connect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
-            QThreadPool::globalInstance()->start(worker);
+        const auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), hash);
+        if (itr == _pendingShapes.end()) {
+            // start a worker, its shape is delivered by deliverWork()
+            _pendingShapes.push_back(hash);
+            _workerPool.start(new ShapeBuildJob(*this, info, _diskCache));
         }
         // else we're still waiting for the shape to be created on another thread
     } else {
@@ -206,27 +251,72 @@ bool ShapeManager::hasShape(const btCollisionShape* shape) const {
     return false;
 }
 
-// slot: called when ShapeFactory::Worker is done building shape
-void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
-    auto itr = std::find(_pendingMeshShapes.begin(), _pendingMeshShapes.end(), worker->shapeInfo.getHash());
-    if (itr == _pendingMeshShapes.end()) {
+int ShapeManager::getNumUndeliveredShapes() const {
+    std::lock_guard<std::mutex> lock(_finishedWorkMutex);
+    return (int)_finishedWork.size();
+}
+
+float ShapeManager::getAverageShapeBuildTime() const {
+    return _averageBuildTime.isAverageValid() ? (float)_averageBuildTime.average : 0.0f;
+}
+
+void ShapeManager::queueFinishedShape(const FinishedShape& finishedShape) {
+    std::lock_guard<std::mutex> lock(_finishedWorkMutex);
+    _finishedWork.push_back(finishedShape);
+}
+
+int ShapeManager::deliverWork(uint64_t timeBudget) {
+    std::vector<FinishedShape> finishedWork;
+    {
+        std::lock_guard<std::mutex> lock(_finishedWorkMutex);
+        if (_finishedWork.empty()) {
+            return 0;
+        }
+        finishedWork.swap(_finishedWork);
+    }
+
+    // oldest first, and always at least one
+    uint64_t expiry = usecTimestampNow() + timeBudget;
+    size_t numDelivered = 0;
+    while (numDelivered < finishedWork.size()) {
+        acceptWork(finishedWork[numDelivered]);
+        ++numDelivered;
+        if (usecTimestampNow() > expiry) {
+            break;
+        }
+    }
+
+    if (numDelivered < finishedWork.size()) {
+        // put the rest back in front of anything that finished meanwhile
+        std::lock_guard<std::mutex> lock(_finishedWorkMutex);
+        _finishedWork.insert(_finishedWork.begin(), finishedWork.begin() + numDelivered, finishedWork.end());
+    }
+    return (int)numDelivered;
+}
+
+// called by deliverWork() for each shape a worker has finished building
+void ShapeManager::acceptWork(const FinishedShape& finishedShape) {
+    _averageBuildTime.addSample((float)finishedShape.buildTime);
+
+    auto itr = std::find(_pendingShapes.begin(), _pendingShapes.end(), finishedShape.key);
+    if (itr == _pendingShapes.end()) {
         // we've received a shape but don't remember asking for it
         // (should not fall in here, but if we do: delete the unwanted shape)
-        if (worker->shape) {
-            ShapeFactory::deleteShape(worker->shape);
+        if (finishedShape.shape) {
+            ShapeFactory::deleteShape(finishedShape.shape);
         }
     } else {
         // clear pending status
-        *itr = _pendingMeshShapes.back();
-        _pendingMeshShapes.pop_back();
+        *itr = _pendingShapes.back();
+        _pendingShapes.pop_back();
 
         // cache the new shape
-        if (worker->shape) {
+        if (finishedShape.shape) {
             ShapeReference newRef;
             // refCount is zero because nothing is using the shape yet
             newRef.refCount = 0;
-            newRef.shape = worker->shape;
-            newRef.key = worker->shapeInfo.getHash();
+            newRef.shape = finishedShape.shape;
+            newRef.key = finishedShape.key;
             HashKey hashKey(newRef.key);
             _shapeMap.insert(hashKey, newRef);
 
@@ -268,15 +358,5 @@ void ShapeManager::acceptWork(ShapeFactory::Worker* worker) {
             _orphans.push_back(KeyExpiry(newRef.key, newExpiry));
         }
     }
-    disconnect(worker, &ShapeFactory::Worker::submitWork, this, &ShapeManager::acceptWork);
-
-    if (_deadWorker) {
-        // delete the previous deadWorker manually
-        delete _deadWorker;
-    }
-    // save this dead worker for later
-    worker->shapeInfo.clear();
-    worker->shape = nullptr;
-    _deadWorker = worker;
     ++_workDeliveryCount;
 }
@@ -14,14 +14,19 @@
 
 #include <atomic>
 #include <chrono>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 #include <QObject>
+#include <QThreadPool>
 #include <btBulletDynamicsCommon.h>
 #include <LinearMath/btHashMap.h>
 
 #include <ShapeInfo.h>
+#include <SimpleMovingAverage.h>
 
+#include "ShapeCache.h"
 #include "ShapeFactory.h"
 #include "HashKey.h"
 
@@ -46,6 +51,11 @@
 // doesn't delete it right away.  Instead it puts the shape's key on a list delete
 // later.  When that list grows big enough the ShapeManager will remove any matching
 // entries that still have zero ref-count.
+//
+// Shapes that are expensive to build (triangle meshes and hulls, see isBuiltOffThread()) are built by workers on the
+// ShapeManager's own thread pool, and getShape() returns nullptr until they arrive.  Finished shapes are only added to
+// the map by deliverWork(), a few at a time, so that a domain full of models doesn't deliver them all in one frame.
+// With a disk cache the workers load the shapes built on an earlier run, and save the ones they build.
 
 
 class ShapeManager : public QObject {
@@ -66,6 +76,16 @@ public:
     /// delete shapes that have zero references
     void collectGarbage();
 
+    /// \return true if getShape() builds shapes of this type on a worker thread
+    static bool isBuiltOffThread(ShapeType type);
+
+    /// add shapes finished by workers to the map, for at most about timeBudget usecs
+    /// \return number of shapes delivered
+    int deliverWork(uint64_t timeBudget);
+
+    /// the cache is shared with the workers, which may still be using the previous one for a while
+    void setDiskCache(const std::shared_ptr<ShapeCache>& diskCache) { _diskCache = diskCache; }
+
     // validation methods
     int getNumShapes() const { return _shapeMap.size(); }
     int getNumReferences(const ShapeInfo& info) const;
@@ -74,10 +94,23 @@ public:
     uint32_t getWorkRequestCount() const { return _workRequestCount; }
     uint32_t getWorkDeliveryCount() const { return _workDeliveryCount; }
 
-protected slots:
-    void acceptWork(ShapeFactory::Worker* worker);
+    // stats
+    int getNumPendingShapes() const { return (int)_pendingShapes.size(); }   // requested and not yet delivered
+    int getNumUndeliveredShapes() const;                                     // finished and waiting for deliverWork()
+    float getAverageShapeBuildTime() const;                                  // usecs
+    uint32_t getDiskCacheHitCount() const { return _diskCacheHitCount; }
 
 private:
+    class ShapeBuildJob;
+    class FinishedShape {
+    public:
+        uint64_t key;
+        const btCollisionShape* shape;
+        uint64_t buildTime; // usecs
+    };
+
+    void queueFinishedShape(const FinishedShape& finishedShape); // called on worker threads
+    void acceptWork(const FinishedShape& finishedShape);
     void addToGarbage(uint64_t key);
     bool releaseShapeByKey(uint64_t key);
 
@@ -100,13 +133,18 @@ private:
     // btHashMap is required because it supports memory alignment of the btCollisionShapes
     btHashMap<HashKey, ShapeReference> _shapeMap;
     std::vector<uint64_t> _garbageRing;
-    std::vector<uint64_t> _pendingMeshShapes;
+    std::vector<uint64_t> _pendingShapes;
     std::vector<KeyExpiry> _orphans;
-    ShapeFactory::Worker* _deadWorker { nullptr };
     TimePoint _nextOrphanExpiry;
+    QThreadPool _workerPool;
+    std::shared_ptr<ShapeCache> _diskCache;
+    mutable std::mutex _finishedWorkMutex;
+    std::vector<FinishedShape> _finishedWork; // guarded by _finishedWorkMutex
+    MovingAverage<float, 30> _averageBuildTime;
     uint32_t _ringIndex { 0 };
     std::atomic_uint _workRequestCount { 0 };
     std::atomic_uint _workDeliveryCount { 0 };
+    std::atomic_uint _diskCacheHitCount { 0 };
 };
 
 #endif // hifi_ShapeManager_h
@@ -18,15 +18,18 @@
 #include "ThreadSafeDynamicsWorld.h"
 
 #include <LinearMath/btQuickprof.h>
+#include <LinearMath/btThreads.h>
 
+#include "BulletUtil.h"
 #include "Profile.h"
 
 ThreadSafeDynamicsWorld::ThreadSafeDynamicsWorld(
         btDispatcher* dispatcher,
         btBroadphaseInterface* pairCache,
-        btConstraintSolver* constraintSolver,
+        btConstraintSolverPoolMt* constraintSolverPool,
+        btConstraintSolver* constraintSolverMt,
         btCollisionConfiguration* collisionConfiguration)
-    :   btDiscreteDynamicsWorld(dispatcher, pairCache, constraintSolver, collisionConfiguration) {
+    :   btDiscreteDynamicsWorldMt(dispatcher, pairCache, constraintSolverPool, constraintSolverMt, collisionConfiguration) {
 }
 
 int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep, int maxSubSteps,
@@ -89,9 +92,37 @@ int ThreadSafeDynamicsWorld::stepSimulationWithSubstepCallback(btScalar timeStep
 
     clearForces();
 
+    // as in btDiscreteDynamicsWorldMt::stepSimulation(), let the solver threads sleep until the next step
+    btGetTaskScheduler()->sleepWorkerThreadsHint();
+
     return subSteps;
 }
 
+void MotionStateBuffer::clear() {
+    motionStates.clear();
+    positions.clear();
+    rotations.clear();
+    linearVelocities.clear();
+    angularVelocities.clear();
+}
+
+void MotionStateBuffer::reserve(size_t size) {
+    motionStates.reserve(size);
+    positions.reserve(size);
+    rotations.reserve(size);
+    linearVelocities.reserve(size);
+    angularVelocities.reserve(size);
+}
+
+void MotionStateBuffer::push_back(ObjectMotionState* motionState, const btTransform& transform,
+                                  const btVector3& linearVelocity, const btVector3& angularVelocity) {
+    motionStates.push_back(motionState);
+    positions.push_back(bulletToGLM(transform.getOrigin()));
+    rotations.push_back(bulletToGLM(transform.getRotation()));
+    linearVelocities.push_back(bulletToGLM(linearVelocity));
+    angularVelocities.push_back(bulletToGLM(angularVelocity));
+}
+
 // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
 void ThreadSafeDynamicsWorld::synchronizeMotionState(btRigidBody* body) {
     btAssert(body);
@@ -110,17 +141,25 @@ void ThreadSafeDynamicsWorld::synchronizeMotionState(btRigidBody* body) {
         return;
     }
     btTransform interpolatedTransform;
+    computeInterpolatedTransform(body, interpolatedTransform);
+    body->getMotionState()->setWorldTransform(interpolatedTransform);
+}
+
+void ThreadSafeDynamicsWorld::computeInterpolatedTransform(const btRigidBody* body, btTransform& interpolatedTransform) const {
     btTransformUtil::integrateTransform(body->getInterpolationWorldTransform(),
         body->getInterpolationLinearVelocity(),body->getInterpolationAngularVelocity(),
         (m_latencyMotionStateInterpolation && m_fixedTimeStep) ? m_localTime - m_fixedTimeStep : m_localTime*body->getHitFraction(),
         interpolatedTransform);
-    body->getMotionState()->setWorldTransform(interpolatedTransform);
 }
 
 void ThreadSafeDynamicsWorld::synchronizeMotionStates() {
     PROFILE_RANGE(simulation_physics, "SyncMotionStates");
     BT_PROFILE("syncMotionStates");
     _changedMotionStates.clear();
+    _motionStateBuffer.clear();
+    if (_bulkMotionStateSync) {
+        _motionStateBuffer.reserve(m_nonStaticRigidBodies.size());
+    }
 
     // NOTE: m_synchronizeAllMotionStates is 'false' by default for optimization.
     // See PhysicsEngine::init() where we call _dynamicsWorld->setForceUpdateAllAabbs(false)
@@ -145,8 +184,15 @@ void ThreadSafeDynamicsWorld::synchronizeMotionStates() {
             ObjectMotionState* motionState = static_cast<ObjectMotionState*>(body->getMotionState());
             if (motionState) {
                 if (body->isActive()) {
-                    synchronizeMotionState(body);
-                    _changedMotionStates.push_back(motionState);
+                    if (_bulkMotionStateSync && !body->isKinematicObject() && motionState->getType() == MOTIONSTATE_TYPE_ENTITY) {
+                        btTransform interpolatedTransform;
+                        computeInterpolatedTransform(body, interpolatedTransform);
+                        _motionStateBuffer.push_back(motionState, interpolatedTransform, body->getLinearVelocity(),
+                                                     body->getAngularVelocity());
+                    } else {
+                        synchronizeMotionState(body);
+                        _changedMotionStates.push_back(motionState);
+                    }
                     _activeStates.insert(motionState);
                 } else if (_lastActiveStates.find(motionState) != _lastActiveStates.end()) {
                     // this object was active last frame but is no longer
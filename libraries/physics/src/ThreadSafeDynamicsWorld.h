@@ -20,21 +20,46 @@
 
 #include <BulletDynamics/Dynamics/btRigidBody.h>
 #include <BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h>
+#include <BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h>
+
+#include <glm/gtc/quaternion.hpp>
 
 #include "ObjectMotionState.h"
 
 #include <functional>
+#include <vector>
 
 using SubStepCallback = std::function<void()>;
 
-ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorld {
+// The synchronized transforms and velocities of the active dynamic entity bodies, as a structure of arrays in body order,
+// so that the entity simulation can apply them and gather its bids in one pass.
+struct MotionStateBuffer {
+    std::vector<ObjectMotionState*> motionStates;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::quat> rotations;
+    std::vector<glm::vec3> linearVelocities;
+    std::vector<glm::vec3> angularVelocities;
+
+    size_t size() const { return motionStates.size(); }
+    void clear();
+    void reserve(size_t size);
+    void push_back(ObjectMotionState* motionState, const btTransform& transform, const btVector3& linearVelocity,
+                   const btVector3& angularVelocity);
+};
+
+// Solves simulation islands in parallel on the threads of Bullet's task scheduler (see btSetTaskScheduler()), and
+// sequentially when that is the sequential scheduler. Collision dispatch, actions, the substep callback and the motion
+// state hooks always run on the thread that steps the simulation.
+ATTRIBUTE_ALIGNED16(class) ThreadSafeDynamicsWorld : public btDiscreteDynamicsWorldMt {
 public:
     BT_DECLARE_ALIGNED_ALLOCATOR();
 
+    // constraintSolverMt solves islands too large to share a thread, and may be null
     ThreadSafeDynamicsWorld(
             btDispatcher* dispatcher,
             btBroadphaseInterface* pairCache,
-            btConstraintSolver* constraintSolver,
+            btConstraintSolverPoolMt* constraintSolverPool,
+            btConstraintSolver* constraintSolverMt,
             btCollisionConfiguration* collisionConfiguration);
 
     int getNumSubsteps() const { return _numSubsteps; }
@@ -49,6 +74,13 @@ public:
     // smoother rendering of objects when the physics simulation loop is ansynchronous to the render loop).
     float getLocalTimeAccumulation() const { return m_localTime; }
 
+    // When bulk sync is enabled the active dynamic entities aren't told their new transforms through
+    // btMotionState::setWorldTransform(), and aren't in the changed motion states.  Instead their results are in the
+    // motion state buffer, for PhysicalEntitySimulation::handleChangedMotionStates() to apply.
+    void setBulkMotionStateSync(bool enabled) { _bulkMotionStateSync = enabled; }
+    bool isBulkMotionStateSync() const { return _bulkMotionStateSync; }
+    const MotionStateBuffer& getMotionStateBuffer() const { return _motionStateBuffer; }
+
     const VectorOfMotionStates& getChangedMotionStates() const { return _changedMotionStates; }
     const VectorOfMotionStates& getDeactivatedMotionStates() const { return _deactivatedStates; }
 
@@ -58,14 +90,17 @@ public:
 private:
     // call this instead of non-virtual btDiscreteDynamicsWorld::synchronizeSingleMotionState()
     void synchronizeMotionState(btRigidBody* body);
+    void computeInterpolatedTransform(const btRigidBody* body, btTransform& interpolatedTransform) const;
     void drawConnectedSpheres(btIDebugDraw* drawer, btScalar radius1, btScalar radius2, const btVector3& position1, 
                               const btVector3& position2, const btVector3& color);
 
     VectorOfMotionStates _changedMotionStates;
     VectorOfMotionStates _deactivatedStates;
+    MotionStateBuffer _motionStateBuffer;
     SetOfMotionStates _activeStates;
     SetOfMotionStates _lastActiveStates;
     int _numSubsteps { 0 };
+    bool _bulkMotionStateSync { true };
 };
 
 #endif // hifi_ThreadSafeDynamicsWorld_h
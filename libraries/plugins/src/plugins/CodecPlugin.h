@@ -16,6 +16,10 @@ class Encoder {
 public:
     virtual ~Encoder() { }
     virtual void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) = 0;
+
+    // true when the encoded output depends only on the decoded input, so identical inputs give identical outputs
+    // and there is nothing to flush
+    virtual bool isStateless() const { return false; }
 };
 
 class Decoder {
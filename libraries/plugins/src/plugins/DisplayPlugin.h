@@ -190,6 +190,10 @@ public:
     virtual float newFramePresentRate() const { return -1.0f; }
     // Rate at which rendered frames are being skipped
     virtual float droppedFrameRate() const { return -1.0f; }
+    // Average time from the submission of a frame to its first present, in msec
+    virtual float presentLatency() const { return -1.0f; }
+    // Rate at which presents miss the vsyncs they were meant for
+    virtual float missedVsyncRate() const { return -1.0f; }
     virtual bool getSupportsAutoSwitch() { return false; }
 
     // Hardware specific stats
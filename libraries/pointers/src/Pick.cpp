@@ -64,6 +64,23 @@ QVariantMap PickQuery::getScriptParameters() const {
     return _scriptParameters;
 }
 
+void PickQuery::recordUpdateCost(uint64_t usecs) {
+    withWriteLock([&] {
+        _lastUpdateUsecs = usecs;
+        _averageUpdateUsecs.addSample((float)usecs);
+    });
+}
+
+QVariantMap PickQuery::getUpdateStats() const {
+    return resultWithReadLock<QVariantMap>([&] {
+        QVariantMap stats;
+        stats["lastUpdateUsecs"] = (quint64)_lastUpdateUsecs;
+        stats["averageUpdateUsecs"] = _averageUpdateUsecs.isAverageValid() ? (float)_averageUpdateUsecs.average : 0.0f;
+        stats["numUpdates"] = (int)_averageUpdateUsecs.numSamples;
+        return stats;
+    });
+}
+
 QVector<QUuid> PickQuery::getIncludeItems() const {
     return resultWithReadLock<QVector<QUuid>>([&] {
         return _includeItems;
@@ -17,6 +17,7 @@
 #include <QVariant>
 
 #include <shared/ReadWriteLockable.h>
+#include <SimpleMovingAverage.h>
 #include <TransformNode.h>
 #include <PickFilter.h>
 
@@ -191,6 +192,11 @@ public:
     void setScriptParameters(const QVariantMap& parameters);
     QVariantMap getScriptParameters() const;
 
+    // Records how long an evaluation of this pick took, from whichever thread evaluated it
+    void recordUpdateCost(uint64_t usecs);
+    // The last and average evaluation times in microseconds, and the number of evaluations
+    QVariantMap getUpdateStats() const;
+
     virtual bool isLeftHand() const { return _jointState == JOINT_STATE_LEFT_HAND; }
     virtual bool isRightHand() const { return _jointState == JOINT_STATE_RIGHT_HAND; }
     virtual bool isMouse() const { return _jointState == JOINT_STATE_MOUSE; }
@@ -214,6 +220,10 @@ private:
     QVariantMap _scriptParameters;
 
     JointState _jointState { JOINT_STATE_NONE };
+
+    static const int NUM_UPDATE_COST_SAMPLES = 30;
+    uint64_t _lastUpdateUsecs { 0 };
+    MovingAverage<float, NUM_UPDATE_COST_SAMPLES> _averageUpdateUsecs;
 };
 Q_DECLARE_METATYPE(PickQuery::PickType)
 
@@ -225,6 +235,10 @@ public:
     virtual T getMathematicalPick() const = 0;
     virtual PickResultPointer getDefaultResult(const QVariantMap& pickVariant) const = 0;
     virtual PickResultPointer getEntityIntersection(const T& pick) = 0;
+    // Picks that return true evaluate the entity intersections of several picks that share their filter and include and
+    // ignore lists together, one result per pick. The others are evaluated one at a time.
+    virtual bool batchesEntityIntersections() const { return false; }
+    virtual std::vector<PickResultPointer> getEntityIntersections(const std::vector<T>& picks) { return std::vector<PickResultPointer>(); }
     virtual PickResultPointer getAvatarIntersection(const T& pick) = 0;
     virtual PickResultPointer getHUDIntersection(const T& pick) = 0;
 
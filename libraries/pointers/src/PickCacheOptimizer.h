@@ -9,6 +9,7 @@
 #define hifi_PickCacheOptimizer_h
 
 #include <unordered_map>
+#include <vector>
 
 #include "Pick.h"
 
@@ -37,14 +38,38 @@ template<typename T>
 class PickCacheOptimizer {
 
 public:
+    // A pick whose mathematical pick was taken on the main thread, so that its entity intersections can be evaluated on another
+    struct PendingPick {
+        std::shared_ptr<Pick<T>> pick;
+        T mathematicalPick;
+        PickResultPointer result;
+        bool evaluated { false };
+        uint64_t costUsecs { 0 };
+    };
+    using PendingPicks = std::vector<PendingPick>;
+
     QVector3D update(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks, uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD);
 
+    // Takes the mathematical picks of all the picks.  This reads the transforms of their parents, so has to be done on the main thread.
+    static PendingPicks getPendingPicks(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks);
+    // Evaluates the entity intersections of pending picks [begin, end) with their own cache.  Safe to call from any thread.
+    QVector3D evaluatePendingPicks(PendingPicks& pending, size_t begin, size_t end);
+    // Adds the avatar and HUD intersections, which go through objects that live on the main thread, and publishes the results
+    QVector3D publishPendingPicks(PendingPicks& pending, bool shouldPickHUD);
+
 protected:
     typedef std::unordered_map<T, std::unordered_map<PickCacheKey, PickResultPointer>> PickCache;
 
     // Returns true if this pick exists in the cache, and if it does, update res if the cached result is closer
     bool checkAndCompareCachedResults(T& pick, PickCache& cache, PickResultPointer& res, const PickCacheKey& key);
     void cacheResult(const bool intersects, const PickResultPointer& resTemp, const PickCacheKey& key, PickResultPointer& res, T& mathPick, PickCache& cache, const std::shared_ptr<Pick<T>> pick);
+    // Evaluates the entity intersections of the picks that share an entity key as one batch, and caches the results for update()
+    void cacheBatchedEntityResults(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks, PickCache& cache, QVector3D& numIntersectionsComputed);
+    void cacheBatchedEntityResults(const PendingPicks& pending, size_t begin, size_t end, PickCache& cache, QVector3D& numIntersectionsComputed);
+    // Compare the intersections of an enabled pick with res, keeping the closest
+    void evaluateEntityIntersection(const std::shared_ptr<Pick<T>>& pick, T& mathematicalPick, PickCache& cache, PickResultPointer& res, QVector3D& numIntersectionsComputed);
+    void evaluateAvatarAndHUDIntersections(const std::shared_ptr<Pick<T>>& pick, T& mathematicalPick, PickCache& cache, bool shouldPickHUD, PickResultPointer& res, QVector3D& numIntersectionsComputed);
+    PickResultPointer filterAgainstMaxDistance(const std::shared_ptr<Pick<T>>& pick, T& mathematicalPick, const PickResultPointer& res);
 };
 
 template<typename T>
@@ -66,11 +91,127 @@ void PickCacheOptimizer<T>::cacheResult(const bool needToCompareResults, const P
     }
 }
 
+template<typename T>
+typename PickCacheOptimizer<T>::PendingPicks PickCacheOptimizer<T>::getPendingPicks(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks) {
+    PendingPicks pending;
+    pending.reserve(picks.size());
+    for (auto& entry : picks) {
+        std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(entry.second);
+        pending.push_back({ pick, pick->getMathematicalPick(), PickResultPointer() });
+    }
+    return pending;
+}
+
+template<typename T>
+void PickCacheOptimizer<T>::cacheBatchedEntityResults(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks,
+        PickCache& cache, QVector3D& numIntersectionsComputed) {
+    PendingPicks pending;
+    for (auto& entry : picks) {
+        std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(entry.second);
+        if (pick->batchesEntityIntersections()) {
+            pending.push_back({ pick, pick->getMathematicalPick(), PickResultPointer() });
+        }
+    }
+    cacheBatchedEntityResults(pending, 0, pending.size(), cache, numIntersectionsComputed);
+}
+
+template<typename T>
+void PickCacheOptimizer<T>::cacheBatchedEntityResults(const PendingPicks& pending, size_t begin, size_t end,
+        PickCache& cache, QVector3D& numIntersectionsComputed) {
+    struct PickBatch {
+        std::shared_ptr<Pick<T>> pick;
+        std::vector<T> mathPicks;
+    };
+    std::unordered_map<PickCacheKey, PickBatch> batches;
+    for (size_t i = begin; i < end; i++) {
+        const std::shared_ptr<Pick<T>>& pick = pending[i].pick;
+        const T& mathematicalPick = pending[i].mathematicalPick;
+        if (!pick->batchesEntityIntersections() || !pick->isEnabled() || pick->getMaxDistance() < 0.0f || !mathematicalPick ||
+            !(pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities())) {
+            continue;
+        }
+        PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
+        PickBatch& batch = batches[entityKey];
+        batch.pick = pick;
+        batch.mathPicks.push_back(mathematicalPick);
+    }
+
+    for (auto& entry : batches) {
+        PickBatch& batch = entry.second;
+        if (batch.mathPicks.size() < 2) {
+            continue;
+        }
+        std::vector<PickResultPointer> entityResults = batch.pick->getEntityIntersections(batch.mathPicks);
+        if (entityResults.size() != batch.mathPicks.size()) {
+            continue;
+        }
+        for (size_t i = 0; i < entityResults.size(); i++) {
+            numIntersectionsComputed[0]++;
+            if (entityResults[i]) {
+                cache[batch.mathPicks[i]][entry.first] = entityResults[i]->doesIntersect() ? entityResults[i] :
+                    batch.pick->getDefaultResult(batch.mathPicks[i].toVariantMap());
+            }
+        }
+    }
+}
+
+template<typename T>
+void PickCacheOptimizer<T>::evaluateEntityIntersection(const std::shared_ptr<Pick<T>>& pick, T& mathematicalPick, PickCache& cache,
+        PickResultPointer& res, QVector3D& numIntersectionsComputed) {
+    if (pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities()) {
+        PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
+        if (!checkAndCompareCachedResults(mathematicalPick, cache, res, entityKey)) {
+            PickResultPointer entityRes = pick->getEntityIntersection(mathematicalPick);
+            numIntersectionsComputed[0]++;
+            if (entityRes) {
+                cacheResult(entityRes->doesIntersect(), entityRes, entityKey, res, mathematicalPick, cache, pick);
+            }
+        }
+    }
+}
+
+template<typename T>
+void PickCacheOptimizer<T>::evaluateAvatarAndHUDIntersections(const std::shared_ptr<Pick<T>>& pick, T& mathematicalPick, PickCache& cache,
+        bool shouldPickHUD, PickResultPointer& res, QVector3D& numIntersectionsComputed) {
+    if (pick->getFilter().doesPickAvatars()) {
+        PickCacheKey avatarKey = { pick->getFilter().getAvatarFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
+        if (!checkAndCompareCachedResults(mathematicalPick, cache, res, avatarKey)) {
+            PickResultPointer avatarRes = pick->getAvatarIntersection(mathematicalPick);
+            numIntersectionsComputed[1]++;
+            if (avatarRes) {
+                cacheResult(avatarRes->doesIntersect(), avatarRes, avatarKey, res, mathematicalPick, cache, pick);
+            }
+        }
+    }
+
+    // Can't intersect with HUD in desktop mode
+    if (pick->getFilter().doesPickHUD() && shouldPickHUD) {
+        PickCacheKey hudKey = { pick->getFilter().getHUDFlags(), QVector<QUuid>(), QVector<QUuid>() };
+        if (!checkAndCompareCachedResults(mathematicalPick, cache, res, hudKey)) {
+            PickResultPointer hudRes = pick->getHUDIntersection(mathematicalPick);
+            numIntersectionsComputed[2]++;
+            if (hudRes) {
+                cacheResult(true, hudRes, hudKey, res, mathematicalPick, cache, pick);
+            }
+        }
+    }
+}
+
+template<typename T>
+PickResultPointer PickCacheOptimizer<T>::filterAgainstMaxDistance(const std::shared_ptr<Pick<T>>& pick, T& mathematicalPick,
+        const PickResultPointer& res) {
+    if (pick->getMaxDistance() == 0.0f || (pick->getMaxDistance() > 0.0f && res->checkOrFilterAgainstMaxDistance(pick->getMaxDistance()))) {
+        return res;
+    }
+    return pick->getDefaultResult(mathematicalPick.toVariantMap());
+}
+
 template<typename T>
 QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared_ptr<PickQuery>>& picks,
         uint32_t& nextToUpdate, uint64_t expiry, bool shouldPickHUD) {
     QVector3D numIntersectionsComputed;
     PickCache results;
+    cacheBatchedEntityResults(picks, results, numIntersectionsComputed);
     const uint32_t INVALID_PICK_ID = 0;
     auto itr = picks.begin();
     if (nextToUpdate != INVALID_PICK_ID) {
@@ -83,50 +224,16 @@ QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared
     while(numUpdates < picks.size()) {
         std::shared_ptr<Pick<T>> pick = std::static_pointer_cast<Pick<T>>(itr->second);
         T mathematicalPick = pick->getMathematicalPick();
-        PickResultPointer res = pick->getDefaultResult(mathematicalPick.toVariantMap());
 
         if (!pick->isEnabled() || pick->getMaxDistance() < 0.0f || !mathematicalPick) {
-            pick->setPickResult(res);
+            pick->setPickResult(pick->getDefaultResult(mathematicalPick.toVariantMap()));
         } else {
-            if (pick->getFilter().doesPickDomainEntities() || pick->getFilter().doesPickAvatarEntities() || pick->getFilter().doesPickLocalEntities()) {
-                PickCacheKey entityKey = { pick->getFilter().getEntityFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, entityKey)) {
-                    PickResultPointer entityRes = pick->getEntityIntersection(mathematicalPick);
-                    numIntersectionsComputed[0]++;
-                    if (entityRes) {
-                        cacheResult(entityRes->doesIntersect(), entityRes, entityKey, res, mathematicalPick, results, pick);
-                    }
-                }
-            }
-
-            if (pick->getFilter().doesPickAvatars()) {
-                PickCacheKey avatarKey = { pick->getFilter().getAvatarFlags(), pick->getIncludeItems(), pick->getIgnoreItems() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, avatarKey)) {
-                    PickResultPointer avatarRes = pick->getAvatarIntersection(mathematicalPick);
-                    numIntersectionsComputed[1]++;
-                    if (avatarRes) {
-                        cacheResult(avatarRes->doesIntersect(), avatarRes, avatarKey, res, mathematicalPick, results, pick);
-                    }
-                }
-            }
-
-            // Can't intersect with HUD in desktop mode
-            if (pick->getFilter().doesPickHUD() && shouldPickHUD) {
-                PickCacheKey hudKey = { pick->getFilter().getHUDFlags(), QVector<QUuid>(), QVector<QUuid>() };
-                if (!checkAndCompareCachedResults(mathematicalPick, results, res, hudKey)) {
-                    PickResultPointer hudRes = pick->getHUDIntersection(mathematicalPick);
-                    numIntersectionsComputed[2]++;
-                    if (hudRes) {
-                        cacheResult(true, hudRes, hudKey, res, mathematicalPick, results, pick);
-                    }
-                }
-            }
-
-            if (pick->getMaxDistance() == 0.0f || (pick->getMaxDistance() > 0.0f && res->checkOrFilterAgainstMaxDistance(pick->getMaxDistance()))) {
-                pick->setPickResult(res);
-            } else {
-                pick->setPickResult(pick->getDefaultResult(mathematicalPick.toVariantMap()));
-            }
+            uint64_t start = usecTimestampNow();
+            PickResultPointer res = pick->getDefaultResult(mathematicalPick.toVariantMap());
+            evaluateEntityIntersection(pick, mathematicalPick, results, res, numIntersectionsComputed);
+            evaluateAvatarAndHUDIntersections(pick, mathematicalPick, results, shouldPickHUD, res, numIntersectionsComputed);
+            pick->setPickResult(filterAgainstMaxDistance(pick, mathematicalPick, res));
+            pick->recordUpdateCost(usecTimestampNow() - start);
         }
 
         ++itr;
@@ -142,4 +249,40 @@ QVector3D PickCacheOptimizer<T>::update(std::unordered_map<uint32_t, std::shared
     return numIntersectionsComputed;
 }
 
+template<typename T>
+QVector3D PickCacheOptimizer<T>::evaluatePendingPicks(PendingPicks& pending, size_t begin, size_t end) {
+    QVector3D numIntersectionsComputed;
+    PickCache results;
+    cacheBatchedEntityResults(pending, begin, end, results, numIntersectionsComputed);
+    for (size_t i = begin; i < end; i++) {
+        PendingPick& entry = pending[i];
+        entry.result = entry.pick->getDefaultResult(entry.mathematicalPick.toVariantMap());
+        if (entry.pick->isEnabled() && entry.pick->getMaxDistance() >= 0.0f && entry.mathematicalPick) {
+            uint64_t start = usecTimestampNow();
+            evaluateEntityIntersection(entry.pick, entry.mathematicalPick, results, entry.result, numIntersectionsComputed);
+            entry.costUsecs = usecTimestampNow() - start;
+            entry.evaluated = true;
+        }
+    }
+    return numIntersectionsComputed;
+}
+
+template<typename T>
+QVector3D PickCacheOptimizer<T>::publishPendingPicks(PendingPicks& pending, bool shouldPickHUD) {
+    QVector3D numIntersectionsComputed;
+    PickCache results;
+    for (auto& entry : pending) {
+        if (entry.evaluated) {
+            uint64_t start = usecTimestampNow();
+            evaluateAvatarAndHUDIntersections(entry.pick, entry.mathematicalPick, results, shouldPickHUD, entry.result, numIntersectionsComputed);
+            entry.result = filterAgainstMaxDistance(entry.pick, entry.mathematicalPick, entry.result);
+            entry.pick->recordUpdateCost(entry.costUsecs + (usecTimestampNow() - start));
+        }
+        if (entry.result) {
+            entry.pick->setPickResult(entry.result);
+        }
+    }
+    return numIntersectionsComputed;
+}
+
 #endif // hifi_PickCacheOptimizer_h
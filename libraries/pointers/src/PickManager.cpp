@@ -6,14 +6,54 @@
 //  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
 //
 #include "PickManager.h"
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
 #include "PerfStat.h"
 #include "Profile.h"
 
+namespace {
+
+template <typename T>
+class ParallelPickTask : public QRunnable {
+public:
+    using PendingPicks = typename PickCacheOptimizer<T>::PendingPicks;
+
+    ParallelPickTask(PickCacheOptimizer<T>& optimizer, const std::shared_ptr<PendingPicks>& pending, size_t begin, size_t end) :
+        _optimizer(optimizer), _pending(pending), _begin(begin), _end(end) {}
+
+    std::future<QVector3D> getResult() { return _result.get_future(); }
+
+    void run() override {
+        _result.set_value(_optimizer.evaluatePendingPicks(*_pending, _begin, _end));
+    }
+
+private:
+    PickCacheOptimizer<T>& _optimizer;
+    std::shared_ptr<PendingPicks> _pending;
+    size_t _begin;
+    size_t _end;
+    std::promise<QVector3D> _result;
+};
+
+}
+
 PickManager::PickManager() {
     setShouldPickHUDOperator([]() { return false; });
     setCalculatePos2DFromHUDOperator([](const glm::vec3& intersection) { return glm::vec2(NAN); });
 }
 
+PickManager::~PickManager() {
+    // the tasks refer to the optimizers
+    for (auto& chunk : _parallelRayUpdate.chunks) {
+        chunk.wait();
+    }
+    for (auto& chunk : _parallelParabolaUpdate.chunks) {
+        chunk.wait();
+    }
+}
+
 unsigned int PickManager::addPick(PickQuery::PickType type, const std::shared_ptr<PickQuery> pick) {
     unsigned int id = INVALID_PICK_ID;
     withWriteLock([&] {
@@ -65,6 +105,14 @@ QVariantMap PickManager::getPickScriptParameters(unsigned int uid) const {
     return QVariantMap();
 }
 
+QVariantMap PickManager::getPickUpdateStats(unsigned int uid) const {
+    auto pick = findPick(uid);
+    if (pick) {
+        return pick->getUpdateStats();
+    }
+    return QVariantMap();
+}
+
 QVector<unsigned int> PickManager::getPicks() const {
     QVector<unsigned int> picks;
     withReadLock([&] {
@@ -163,15 +211,33 @@ void PickManager::update() {
         PerformanceTimer perfTimer("StylusPicks");
         _updatedPickCounts[PickQuery::Stylus] = _stylusPickCacheOptimizer.update(cachedPicks[PickQuery::Stylus], _nextPickToUpdate[PickQuery::Stylus], expiry, false);
     }
-    {
-        PROFILE_RANGE_EX(picks, "RayPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Ray]);
-        PerformanceTimer perfTimer("RayPicks");
-        _updatedPickCounts[PickQuery::Ray] = _rayPickCacheOptimizer.update(cachedPicks[PickQuery::Ray], _nextPickToUpdate[PickQuery::Ray], expiry, shouldPickHUD);
-    }
-    {
-        PROFILE_RANGE_EX(picks, "ParabolaPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Parabola]);
-        PerformanceTimer perfTimer("ParabolaPicks");
-        _updatedPickCounts[PickQuery::Parabola] = _parabolaPickCacheOptimizer.update(cachedPicks[PickQuery::Parabola], _nextPickToUpdate[PickQuery::Parabola], expiry, shouldPickHUD);
+    if (_parallelPicking) {
+        // Stylus and collision picks use the overlays and the physics engine, which are only safe on this thread
+        {
+            PROFILE_RANGE_EX(picks, "RayPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Ray]);
+            PerformanceTimer perfTimer("RayPicks");
+            _updatedPickCounts[PickQuery::Ray] = updateInParallel(_rayPickCacheOptimizer, _parallelRayUpdate, cachedPicks[PickQuery::Ray], shouldPickHUD);
+        }
+        {
+            PROFILE_RANGE_EX(picks, "ParabolaPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Parabola]);
+            PerformanceTimer perfTimer("ParabolaPicks");
+            _updatedPickCounts[PickQuery::Parabola] = updateInParallel(_parabolaPickCacheOptimizer, _parallelParabolaUpdate, cachedPicks[PickQuery::Parabola], shouldPickHUD);
+        }
+    } else {
+        // don't let a parallel update that was still running when parallel picking was turned off overwrite newer results
+        QVector3D numIntersectionsComputed;
+        finishParallelUpdate(_rayPickCacheOptimizer, _parallelRayUpdate, true, shouldPickHUD, numIntersectionsComputed);
+        finishParallelUpdate(_parabolaPickCacheOptimizer, _parallelParabolaUpdate, true, shouldPickHUD, numIntersectionsComputed);
+        {
+            PROFILE_RANGE_EX(picks, "RayPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Ray]);
+            PerformanceTimer perfTimer("RayPicks");
+            _updatedPickCounts[PickQuery::Ray] = _rayPickCacheOptimizer.update(cachedPicks[PickQuery::Ray], _nextPickToUpdate[PickQuery::Ray], expiry, shouldPickHUD);
+        }
+        {
+            PROFILE_RANGE_EX(picks, "ParabolaPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Parabola]);
+            PerformanceTimer perfTimer("ParabolaPicks");
+            _updatedPickCounts[PickQuery::Parabola] = _parabolaPickCacheOptimizer.update(cachedPicks[PickQuery::Parabola], _nextPickToUpdate[PickQuery::Parabola], expiry, shouldPickHUD);
+        }
     }
     {
         PROFILE_RANGE_EX(picks, "CollisionPicks", 0xffff0000, (uint64_t)_totalPickCounts[PickQuery::Collision]);
@@ -180,6 +246,55 @@ void PickManager::update() {
     }
 }
 
+template <typename T>
+bool PickManager::finishParallelUpdate(PickCacheOptimizer<T>& optimizer, ParallelUpdate<T>& parallelUpdate, bool wait,
+                                       bool shouldPickHUD, QVector3D& numIntersectionsComputed) {
+    if (!parallelUpdate.pending) {
+        return true;
+    }
+    for (auto& chunk : parallelUpdate.chunks) {
+        if (wait) {
+            chunk.wait();
+        } else if (chunk.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+            return false;
+        }
+    }
+    for (auto& chunk : parallelUpdate.chunks) {
+        numIntersectionsComputed += chunk.get();
+    }
+    numIntersectionsComputed += optimizer.publishPendingPicks(*parallelUpdate.pending, shouldPickHUD);
+    parallelUpdate.pending.reset();
+    parallelUpdate.chunks.clear();
+    return true;
+}
+
+template <typename T>
+QVector3D PickManager::updateInParallel(PickCacheOptimizer<T>& optimizer, ParallelUpdate<T>& parallelUpdate,
+                                        std::unordered_map<unsigned int, std::shared_ptr<PickQuery>>& picks, bool shouldPickHUD) {
+    QVector3D numIntersectionsComputed;
+    if (!finishParallelUpdate(optimizer, parallelUpdate, false, shouldPickHUD, numIntersectionsComputed)) {
+        // last frame's picks are still being evaluated, keep their previous results up rather than wait
+        return numIntersectionsComputed;
+    }
+    if (picks.empty()) {
+        return numIntersectionsComputed;
+    }
+
+    // the picks are taken from their parents' transforms as of this frame, and their entity intersections are evaluated under
+    // the entity tree's read lock
+    parallelUpdate.pending = std::make_shared<typename PickCacheOptimizer<T>::PendingPicks>(PickCacheOptimizer<T>::getPendingPicks(picks));
+    auto threadPool = QThreadPool::globalInstance();
+    size_t numPicks = parallelUpdate.pending->size();
+    size_t numChunks = std::min(numPicks, (size_t)std::max(threadPool->maxThreadCount(), 1));
+    size_t chunkSize = (numPicks + numChunks - 1) / numChunks;
+    for (size_t begin = 0; begin < numPicks; begin += chunkSize) {
+        auto task = new ParallelPickTask<T>(optimizer, parallelUpdate.pending, begin, std::min(begin + chunkSize, numPicks));
+        parallelUpdate.chunks.push_back(task->getResult());
+        threadPool->start(task);
+    }
+    return numIntersectionsComputed;
+}
+
 bool PickManager::isLeftHand(unsigned int uid) {
     auto pick = findPick(uid);
     if (pick) {
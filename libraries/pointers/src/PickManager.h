@@ -8,6 +8,8 @@
 #ifndef hifi_PickManager_h
 #define hifi_PickManager_h
 
+#include <future>
+
 #include <DependencyManager.h>
 #include "RegisteredMetaTypes.h"
 
@@ -24,6 +26,7 @@ class PickManager : public QObject, public Dependency, protected ReadWriteLockab
 
 public:
     PickManager();
+    ~PickManager();
 
     void update();
 
@@ -39,6 +42,8 @@ public:
     QVariantMap getPickProperties(unsigned int uid) const;
     // The properties that were passed in to create the pick (may be empty if the pick was created by invoking the constructor)
     QVariantMap getPickScriptParameters(unsigned int uid) const;
+    // How long the pick's evaluations have taken
+    QVariantMap getPickUpdateStats(unsigned int uid) const;
 
     template <typename T>
     std::shared_ptr<T> getPrevPickResultTyped(unsigned int uid) const {
@@ -66,12 +71,14 @@ public:
     void setPerFrameTimeBudget(unsigned int numUsecs) { _perFrameTimeBudget = numUsecs; }
 
     bool getForceCoarsePicking() { return _forceCoarsePicking; }
+    bool getParallelPicking() const { return _parallelPicking; }
 
     const std::vector<QVector3D>& getUpdatedPickCounts() { return _updatedPickCounts; }
     const std::vector<int>& getTotalPickCounts() { return _totalPickCounts; }
 
 public slots:
     void setForceCoarsePicking(bool forceCoarsePicking) { _forceCoarsePicking = forceCoarsePicking; }
+    void setParallelPicking(bool parallelPicking) { _parallelPicking = parallelPicking; }
 
 protected:
     std::vector<QVector3D> _updatedPickCounts { PickQuery::NUM_PICK_TYPES };
@@ -92,6 +99,25 @@ protected:
     PickCacheOptimizer<PickParabola> _parabolaPickCacheOptimizer;
     PickCacheOptimizer<CollisionRegion> _collisionPickCacheOptimizer;
 
+    // The ray and parabola picks of one frame, evaluated on the thread pool and published at the start of a later frame
+    template <typename T>
+    struct ParallelUpdate {
+        std::shared_ptr<typename PickCacheOptimizer<T>::PendingPicks> pending;
+        std::vector<std::future<QVector3D>> chunks;
+    };
+
+    template <typename T>
+    QVector3D updateInParallel(PickCacheOptimizer<T>& optimizer, ParallelUpdate<T>& parallelUpdate,
+                               std::unordered_map<unsigned int, std::shared_ptr<PickQuery>>& picks, bool shouldPickHUD);
+    // Publishes the results of the last parallel update, returns false if it was still running and wait was false
+    template <typename T>
+    bool finishParallelUpdate(PickCacheOptimizer<T>& optimizer, ParallelUpdate<T>& parallelUpdate, bool wait, bool shouldPickHUD,
+                              QVector3D& numIntersectionsComputed);
+
+    bool _parallelPicking { false };
+    ParallelUpdate<PickRay> _parallelRayUpdate;
+    ParallelUpdate<PickParabola> _parallelParabolaUpdate;
+
     static const unsigned int DEFAULT_PER_FRAME_TIME_BUDGET = 3 * USECS_PER_MSEC;
     unsigned int _perFrameTimeBudget { DEFAULT_PER_FRAME_TIME_BUDGET };
 };
@@ -259,6 +259,13 @@ bool Procedural::isReady() const {
         }
     }
 
+    // Are our programs compiled?  Until they are, the default material is rendered instead
+    for (const auto& pipeline : _proceduralPipelines) {
+        if (!pipeline.second->getProgram()->isReady()) {
+            return false;
+        }
+    }
+
     if (!_hasStartedFade) {
         _hasStartedFade = true;
         _isFading = true;
@@ -373,6 +380,8 @@ void Procedural::prepare(gpu::Batch& batch,
         gpu::ShaderPointer vertexShader = gpu::Shader::createVertex(vertexSource);
         gpu::ShaderPointer fragmentShader = gpu::Shader::createPixel(fragmentSource);
         gpu::ShaderPointer program = gpu::Shader::createProgram(vertexShader, fragmentShader);
+        // Compiled in the background, the draws with it are skipped until then, and isReady() is false
+        gpu::Shader::compileAsync(program, true);
 
         _proceduralPipelines[key] = gpu::Pipeline::create(program, key.isTransparent() ? _transparentState : _opaqueState);
 
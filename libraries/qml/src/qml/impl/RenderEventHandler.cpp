@@ -14,9 +14,11 @@
 #include <gl/QOpenGLContextWrapper.h>
 #include <gl/GLHelpers.h>
 
+#include <QtCore/QCoreApplication>
 #include <QtQuick/QQuickWindow>
 
 #include <shared/NsightHelpers.h>
+#include <ThreadHelpers.h>
 #include "Profiling.h"
 #include "SharedObject.h"
 #include "TextureCache.h"
@@ -49,15 +51,51 @@ bool RenderEventHandler::event(QEvent* e) {
     return QObject::event(e);
 }
 
-RenderEventHandler::RenderEventHandler(SharedObject* shared, QThread* targetThread) :
-        _shared(shared) {
+std::shared_ptr<SharedRenderThread> SharedRenderThread::acquire() {
+    Q_ASSERT(QThread::currentThread() == qApp->thread());
+    static std::weak_ptr<SharedRenderThread> current;
+    auto result = current.lock();
+    if (!result) {
+        result = std::shared_ptr<SharedRenderThread>(new SharedRenderThread());
+        current = result;
+    }
+    return result;
+}
+
+SharedRenderThread::SharedRenderThread() {
     // Create the GL canvas in the same thread as the share canvas
     if (!_canvas.create(SharedObject::getSharedContext())) {
         qFatal("Unable to create new offscreen GL context");
     }
 
-    _canvas.moveToThreadWithContext(targetThread);
-    moveToThread(targetThread);
+    _thread = new QThread();
+    _thread->setObjectName("QML Render Thread");
+    QObject::connect(_thread, &QThread::started, [] { setThreadName("QML Render Thread"); });
+    _thread->start();
+
+    _canvas.moveToThreadWithContext(_thread);
+    QMetaObject::invokeMethod(&_canvas, [this] {
+        _canvas.setThreadContext();
+        if (!_canvas.makeCurrent()) {
+            qFatal("Unable to make QML rendering context current on render thread");
+        }
+    });
+}
+
+SharedRenderThread::~SharedRenderThread() {
+    QMetaObject::invokeMethod(&_canvas, [this] {
+        _canvas.doneCurrent();
+        _canvas.moveToThreadWithContext(qApp->thread());
+        QThread::currentThread()->quit();
+    });
+    _thread->wait();
+    delete _thread;
+    _thread = nullptr;
+}
+
+RenderEventHandler::RenderEventHandler(SharedObject* shared, SharedRenderThread& renderThread) :
+        _shared(shared), _canvas(renderThread.getCanvas()) {
+    moveToThread(renderThread.getThread());
 }
 
 void RenderEventHandler::onInitalize() {
@@ -65,7 +103,6 @@ void RenderEventHandler::onInitalize() {
         return;
     }
 
-    _canvas.setThreadContext();
     if (!_canvas.makeCurrent()) {
         qFatal("Unable to make QML rendering context current on render thread");
     }
@@ -148,14 +185,9 @@ void RenderEventHandler::qmlRender(bool sceneGraphSync) {
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
             _shared->setRenderTarget(_fbo, _currentSize);
 
-            // workaround for https://highfidelity.atlassian.net/browse/BUGZ-1119
-            {
-                // Serialize QML rendering because of a crash caused by Qt bug 
-                // https://bugreports.qt.io/browse/QTBUG-77469
-                static std::mutex qmlRenderMutex;
-                std::unique_lock<std::mutex> qmlRenderLock{ qmlRenderMutex };
-                _shared->_renderControl->render();
-            }
+            // The surfaces render one after the other on the one thread, which also keeps clear of the crash of Qt bug
+            // https://bugreports.qt.io/browse/QTBUG-77469 (https://highfidelity.atlassian.net/browse/BUGZ-1119)
+            _shared->_renderControl->render();
         }
         _shared->_lastRenderTime = usecTimestampNow();
         glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
@@ -172,6 +204,8 @@ void RenderEventHandler::qmlRender(bool sceneGraphSync) {
 }
 
 void RenderEventHandler::onQuit() {
+    // The thread and its context carry on for the other surfaces
+    moveToThread(qApp->thread());
     if (_initialized) {
         if (_canvas.getContext() != QOpenGLContextWrapper::currentContext()) {
             qFatal("QML rendering context not current on render thread");
@@ -188,11 +222,9 @@ void RenderEventHandler::onQuit() {
         }
 
         _shared->shutdownRendering(_currentSize);
-        _canvas.doneCurrent();
+    } else {
+        _shared->shutdownRendering(QSize());
     }
-    _canvas.moveToThreadWithContext(qApp->thread());
-    moveToThread(qApp->thread());
-    QThread::currentThread()->quit();
 }
 
 #endif
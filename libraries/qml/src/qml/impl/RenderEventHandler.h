@@ -9,6 +9,8 @@
 
 #ifndef DISABLE_QML
 
+#include <memory>
+
 #include <QtCore/QObject>
 #include <QtCore/QThread>
 #include <QtGui/qevent.h>
@@ -32,14 +34,34 @@ public:
     OffscreenEvent(Type type) : QEvent(static_cast<QEvent::Type>(type)) {}
 };
 
-/* The render event handler lives on the QML rendering thread for a given surface
- * (each surface has a dedicated rendering thread) and handles events of type 
- * OffscreenEvent to do one time initialization or destruction, and to actually 
- * perform the render.  
+/* All the surfaces render on one thread, in one GL context shared with the
+ * application's, instead of a thread and a context each. The surfaces with a root
+ * item hold on to it, and the thread stops when the last of them lets go.
+ */
+class SharedRenderThread {
+public:
+    // From the main thread only
+    static std::shared_ptr<SharedRenderThread> acquire();
+
+    ~SharedRenderThread();
+
+    QThread* getThread() const { return _thread; }
+    OffscreenGLCanvas& getCanvas() { return _canvas; }
+
+private:
+    SharedRenderThread();
+
+    QThread* _thread { nullptr };
+    OffscreenGLCanvas _canvas;
+};
+
+/* The render event handler lives on the QML rendering thread on behalf of a given
+ * surface and handles events of type OffscreenEvent to do one time initialization
+ * or destruction, and to actually perform the render.
  */
 class RenderEventHandler : public QObject {
 public:
-    RenderEventHandler(SharedObject* shared, QThread* targetThread);
+    RenderEventHandler(SharedObject* shared, SharedRenderThread& renderThread);
 
 private:
     bool event(QEvent* e) override;
@@ -51,7 +73,7 @@ private:
     void onQuit();
 
     SharedObject* const _shared;
-    OffscreenGLCanvas _canvas;
+    OffscreenGLCanvas& _canvas;
     QSize _currentSize;
 
     uint32_t _fbo{ 0 };
@@ -17,6 +17,7 @@
 #include <QtGui/QOpenGLContext>
 #include <QPointer>
 
+#include <MemoryAccounting.h>
 #include <NumericalConstants.h>
 #include <shared/NsightHelpers.h>
 #include <gl/QOpenGLContextWrapper.h>
@@ -29,7 +30,6 @@
 #include "RenderControl.h"
 #include "RenderEventHandler.h"
 #include "TextureCache.h"
-#include <ThreadHelpers.h>
 
 // Time between receiving a request to render the offscreen UI actually triggering
 // the render.  Could possibly be increased depending on the framerate we expect to
@@ -161,15 +161,11 @@ void SharedObject::setRootItem(QQuickItem* rootItem) {
 #ifndef DISABLE_QML
     _rootItem->setSize(_quickWindow->size());
 
-    // Create the render thread
-    _renderThread = new QThread();
-    QString name = objectName();
-    _renderThread->setObjectName(name);
-    QObject::connect(_renderThread, &QThread::started, [name] { setThreadName("QML SharedObject " + name.toStdString()); });
-    _renderThread->start();
+    // Join the render thread of the other surfaces
+    _renderThread = SharedRenderThread::acquire();
 
     // Create event handler for the render thread
-    _renderObject = new RenderEventHandler(this, _renderThread);
+    _renderObject = new RenderEventHandler(this, *_renderThread);
     QCoreApplication::postEvent(this, new OffscreenEvent(OffscreenEvent::Initialize));
 
     QObject::connect(_renderControl, &QQuickRenderControl::renderRequested, this, &SharedObject::requestRender);
@@ -207,17 +203,15 @@ void SharedObject::destroy() {
         _quit = true;
         if (_renderObject) {
             QCoreApplication::postEvent(_renderObject, new OffscreenEvent(OffscreenEvent::Quit), Qt::HighEventPriority);
+            // Block until the rendering thread is done with this surface
+            // FIXME this is undesirable because this is blocking the main thread,
+            // but I haven't found a reliable way to do this only at application
+            // shutdown
+            while (!_renderingShutDown) {
+                wait();
+            }
         }
     }
-    // Block until the rendering thread has stopped
-    // FIXME this is undesirable because this is blocking the main thread,
-    // but I haven't found a reliable way to do this only at application
-    // shutdown
-    if (_renderThread) {
-        _renderThread->wait();
-        delete _renderThread;
-        _renderThread = nullptr;
-    }
 #endif
 }
 
@@ -385,6 +379,7 @@ void SharedObject::shutdownRendering(const QSize& size) {
 #ifndef DISABLE_QML
     _renderControl->invalidate();
 #endif
+    _renderingShutDown = true;
     wake();
 }
 
@@ -441,7 +436,7 @@ void SharedObject::onInitialize() {
 #ifndef DISABLE_QML
     // Associate root item with the window.
     _rootItem->setParentItem(_quickWindow->contentItem());
-    _renderControl->prepareThread(_renderThread);
+    _renderControl->prepareThread(_renderThread->getThread());
 
     // Set up the render thread
     QCoreApplication::postEvent(_renderObject, new OffscreenEvent(OffscreenEvent::Initialize));
@@ -460,6 +455,7 @@ void SharedObject::onInitialize() {
 
 void SharedObject::onRender() {
 #ifndef DISABLE_QML
+    MemoryAccounting::Scope memoryScope(MemoryTag::Qml);
     PROFILE_RANGE(render_qml, __FUNCTION__);
     if (_quit) {
         return;
@@ -7,6 +7,8 @@
 //
 #pragma once
 
+#include <memory>
+
 #include <QtCore/QObject>
 #include <QtCore/QThread>
 #include <QtCore/QWaitCondition>
@@ -31,6 +33,7 @@ namespace impl {
 
 class RenderControl;
 class RenderEventHandler;
+class SharedRenderThread;
 
 class SharedObject : public QObject {
     Q_OBJECT
@@ -104,7 +107,7 @@ private:
     RenderEventHandler* _renderObject { nullptr };
 
     QTimer* _renderTimer { nullptr };
-    QThread* _renderThread { nullptr };
+    std::shared_ptr<SharedRenderThread> _renderThread;
 #endif
 
     uint64_t _lastRenderTime { 0 };
@@ -114,6 +117,7 @@ private:
     bool _renderRequested { false };
     bool _syncRequested { false };
     bool _quit { false };
+    bool _renderingShutDown { false };
     bool _paused { false };
 };
 
@@ -11,6 +11,7 @@
 #include "Frame.h"
 #include "Logging.h"
 
+#include "impl/ChunkedClip.h"
 #include "impl/FileClip.h"
 #include "impl/BufferClip.h"
 
@@ -22,7 +23,12 @@
 using namespace recording;
 
 Clip::Pointer Clip::fromFile(const QString& filePath) {
-    auto result = std::make_shared<FileClip>(filePath);
+    Clip::Pointer result;
+    if (ChunkedClip::isChunkedFile(filePath)) {
+        result = std::make_shared<ChunkedClip>(filePath);
+    } else {
+        result = std::make_shared<FileClip>(filePath);
+    }
     if (result->frameCount() == 0) {
         return Clip::Pointer();
     }
@@ -33,6 +39,10 @@ void Clip::toFile(const QString& filePath, const Clip::ConstPointer& clip) {
     FileClip::write(filePath, clip->duplicate());
 }
 
+bool Clip::toChunkedFile(const QString& filePath, const Clip::ConstPointer& clip, bool compressed) {
+    return ChunkedClip::write(filePath, clip->duplicate(), compressed);
+}
+
 QByteArray Clip::toBuffer(const Clip::ConstPointer& clip) {
     QBuffer buffer;
     if (buffer.open(QFile::Truncate | QFile::WriteOnly)) {
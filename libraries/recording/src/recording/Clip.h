@@ -49,8 +49,10 @@ public:
 
     bool write(QIODevice& output);
 
+    // reads both the .hfr format and the chunked one, which is mapped rather than indexed frame by frame
     static Pointer fromFile(const QString& filePath);
     static void toFile(const QString& filePath, const ConstPointer& clip);
+    static bool toChunkedFile(const QString& filePath, const ConstPointer& clip, bool compressed = true);
     static QByteArray toBuffer(const ConstPointer& clip);
     static Pointer newClip();
     
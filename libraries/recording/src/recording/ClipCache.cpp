@@ -12,6 +12,7 @@
 
 #include <shared/QtHelpers.h>
 
+#include "impl/ChunkedClip.h"
 #include "impl/PointerClip.h"
 #include "Logging.h"
 
@@ -28,11 +29,26 @@ NetworkClipLoader::NetworkClipLoader(const QUrl& url) :
 
 void NetworkClip::init(const QByteArray& clipData) {
     _clipData = clipData;
-    PointerClip::init((uchar*)_clipData.data(), _clipData.size());
+    // the clip only reads from the frames, so point at the shared data rather than detaching a copy of it
+    PointerClip::init((uchar*)_clipData.constData(), _clipData.size());
+}
+
+ClipPointer NetworkClip::fromData(const QUrl& url, const QByteArray& clipData) {
+    if (ChunkedClip::isChunked(clipData)) {
+        // the processes playing a local file share its pages, where each would have a copy of the data
+        if (url.isLocalFile()) {
+            return std::make_shared<ChunkedClip>(url.toLocalFile());
+        }
+        return std::make_shared<ChunkedClip>(clipData, url.toString());
+    }
+
+    auto clip = std::make_shared<NetworkClip>(url);
+    clip->init(clipData);
+    return clip;
 }
 
 void NetworkClipLoader::downloadFinished(const QByteArray& data) {
-    _clip->init(data);
+    _clip = NetworkClip::fromData(_url, data);
     finishedLoading(true);
     emit clipLoaded();
 }
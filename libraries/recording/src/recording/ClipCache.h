@@ -24,6 +24,10 @@ public:
 
     NetworkClip(const QUrl& url) : _url(url) {}
     virtual void init(const QByteArray& clipData);
+
+    // a clip over the data in whichever format it is in, mapping a chunked clip that is a local file rather than
+    // keeping the data
+    static ClipPointer fromData(const QUrl& url, const QByteArray& clipData);
     virtual QString getName() const override { return _url.toString(); }
 
 private:
@@ -45,7 +49,8 @@ signals:
     void clipLoaded();
 
 private:
-    const NetworkClip::Pointer _clip;
+    // chosen once the data says which format it is in
+    ClipPointer _clip;
 };
 
 using NetworkClipLoaderPointer = QSharedPointer<NetworkClipLoader>;
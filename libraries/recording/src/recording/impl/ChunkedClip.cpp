@@ -0,0 +1,449 @@
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ChunkedClip.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+#include <QtCore/QJsonObject>
+#include <QtCore/QSet>
+
+#include <Finally.h>
+
+#include "../Frame.h"
+#include "../Logging.h"
+#include "PointerClip.h"
+
+using namespace recording;
+
+// The layout of a chunked clip, in the byte order of the machine that wrote it as with .hfr files:
+//   "HFRC", version, header size, header                                     the frame type map, as in .hfr files
+//   chunks                                            each frame as type, time offset, 32-bit size, data; maybe compressed
+//   per chunk: offset, size, uncompressed size, first frame, frame count, start time, end time, flags     the index
+//   index offset, chunk count, frame count, "HFRC"
+static const char CHUNKED_CLIP_MAGIC[4] = { 'H', 'F', 'R', 'C' };
+static const uint32_t CHUNKED_CLIP_VERSION = 1;
+
+static const size_t FILE_HEADER_SIZE = sizeof(CHUNKED_CLIP_MAGIC) + 2 * sizeof(uint32_t);
+static const size_t CHUNK_ENTRY_SIZE = sizeof(quint64) + 5 * sizeof(uint32_t) + 2 * sizeof(Frame::Time);
+static const size_t FILE_FOOTER_SIZE = sizeof(quint64) + 2 * sizeof(uint32_t) + sizeof(CHUNKED_CLIP_MAGIC);
+static const size_t CHUNK_FRAME_HEADER_SIZE = sizeof(FrameType) + sizeof(Frame::Time) + sizeof(uint32_t);
+
+static const uint32_t CHUNK_FLAG_COMPRESSED = 1;
+
+// a chunk is closed early rather than grow past this, for the frames that are large
+static const int MAX_CHUNK_BYTES = 256 * 1024;
+
+template <typename T>
+static void appendValue(QByteArray& buffer, const T& value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <typename T>
+static T readValue(const uchar*& current) {
+    T value;
+    memcpy(&value, current, sizeof(T));
+    current += sizeof(T);
+    return value;
+}
+
+bool ChunkedClip::isChunked(const uchar* data, size_t size) {
+    return size >= FILE_HEADER_SIZE + FILE_FOOTER_SIZE && 0 == memcmp(data, CHUNKED_CLIP_MAGIC, sizeof(CHUNKED_CLIP_MAGIC));
+}
+
+bool ChunkedClip::isChunkedFile(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() < (qint64)(FILE_HEADER_SIZE + FILE_FOOTER_SIZE)) {
+        return false;
+    }
+    QByteArray magic = file.read(sizeof(CHUNKED_CLIP_MAGIC));
+    return magic.size() == sizeof(CHUNKED_CLIP_MAGIC) && 0 == memcmp(magic.constData(), CHUNKED_CLIP_MAGIC, sizeof(CHUNKED_CLIP_MAGIC));
+}
+
+ChunkedClip::ChunkedClip(const QString& fileName) : _name(fileName), _file(fileName) {
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(recordingLog) << "Unable to open file " << fileName;
+        return;
+    }
+    // mapped read only, the pages are those of the page cache that every process playing the file maps
+    auto size = _file.size();
+    auto mappedFile = _file.map(0, size);
+    if (!mappedFile) {
+        qCWarning(recordingLog) << "Unable to map file " << fileName;
+        return;
+    }
+    init(mappedFile, size);
+}
+
+ChunkedClip::ChunkedClip(const QByteArray& data, const QString& name) : _name(name), _buffer(data) {
+    // the clip only reads from the frames, so point at the shared data rather than detaching a copy of it
+    init((const uchar*)_buffer.constData(), _buffer.size());
+}
+
+ChunkedClip::~ChunkedClip() {
+    Locker lock(_mutex);
+    if (_data && _file.isOpen()) {
+        _file.unmap(const_cast<uchar*>(_data));
+    }
+    if (_file.isOpen()) {
+        _file.close();
+    }
+    reset();
+}
+
+void ChunkedClip::reset() {
+    _data = nullptr;
+    _size = 0;
+    _header = QJsonDocument();
+    _translationMap.clear();
+    _chunks.clear();
+    _frameCount = 0;
+    _frameIndex = 0;
+    _decodedChunk = SIZE_MAX;
+    _decompressed.clear();
+    _decodedFrames.clear();
+}
+
+void ChunkedClip::init(const uchar* data, size_t size) {
+    reset();
+
+    if (!isChunked(data, size)) {
+        qCWarning(recordingLog) << "Not a chunked clip, invalid file";
+        return;
+    }
+
+    auto current = data + sizeof(CHUNKED_CLIP_MAGIC);
+    auto version = readValue<uint32_t>(current);
+    auto headerSize = readValue<uint32_t>(current);
+    if (version != CHUNKED_CLIP_VERSION) {
+        qCWarning(recordingLog) << "Unsupported chunked clip version" << version;
+        return;
+    }
+
+    auto footer = data + size - FILE_FOOTER_SIZE;
+    auto indexOffset = readValue<quint64>(footer);
+    auto chunkCount = readValue<uint32_t>(footer);
+    auto frameCount = readValue<uint32_t>(footer);
+    if (0 != memcmp(footer, CHUNKED_CLIP_MAGIC, sizeof(CHUNKED_CLIP_MAGIC)) ||
+        FILE_HEADER_SIZE + headerSize > indexOffset ||
+        indexOffset + (quint64)chunkCount * CHUNK_ENTRY_SIZE + FILE_FOOTER_SIZE != size) {
+        qCWarning(recordingLog) << "Truncated chunked clip, invalid file";
+        return;
+    }
+
+    _header = QJsonDocument::fromBinaryData(QByteArray((const char*)current, headerSize));
+    _translationMap = parseTranslationMap(_header);
+    if (_translationMap.empty()) {
+        qCWarning(recordingLog) << "Header missing frame type map, invalid file";
+        return;
+    }
+
+    auto index = data + indexOffset;
+    _chunks.reserve(chunkCount);
+    uint32_t nextFrame = 0;
+    for (uint32_t i = 0; i < chunkCount; ++i) {
+        ChunkEntry chunk;
+        chunk.fileOffset = readValue<quint64>(index);
+        chunk.size = readValue<uint32_t>(index);
+        chunk.uncompressedSize = readValue<uint32_t>(index);
+        chunk.firstFrame = readValue<uint32_t>(index);
+        chunk.frameCount = readValue<uint32_t>(index);
+        chunk.startTime = readValue<Frame::Time>(index);
+        chunk.endTime = readValue<Frame::Time>(index);
+        chunk.flags = readValue<uint32_t>(index);
+        if (chunk.fileOffset + chunk.size > indexOffset || chunk.firstFrame != nextFrame || chunk.frameCount == 0) {
+            qCWarning(recordingLog) << "Corrupt chunk index, invalid file";
+            _chunks.clear();
+            return;
+        }
+        nextFrame += chunk.frameCount;
+        _chunks.push_back(chunk);
+    }
+    if (nextFrame != frameCount) {
+        qCWarning(recordingLog) << "Corrupt chunk index, invalid file";
+        _chunks.clear();
+        return;
+    }
+
+    _data = data;
+    _size = size;
+    _frameCount = frameCount;
+    qCDebug(recordingLog) << "Indexed" << _frameCount << "frames in" << _chunks.size() << "chunks";
+}
+
+// Internal only function, needs no locking
+bool ChunkedClip::decodeChunkOf(size_t frameIndex) const {
+    if (frameIndex >= _frameCount) {
+        return false;
+    }
+
+    auto chunkItr = std::upper_bound(_chunks.begin(), _chunks.end(), frameIndex, [](size_t index, const ChunkEntry& chunk) {
+        return index < chunk.firstFrame;
+    }) - 1;
+    size_t chunkIndex = chunkItr - _chunks.begin();
+    if (chunkIndex == _decodedChunk) {
+        return true;
+    }
+
+    const auto& chunk = *chunkItr;
+    const uchar* current = _data + chunk.fileOffset;
+    size_t size = chunk.size;
+    if (chunk.flags & CHUNK_FLAG_COMPRESSED) {
+        _decompressed = qUncompress(current, (int)chunk.size);
+        current = (const uchar*)_decompressed.constData();
+        size = _decompressed.size();
+    } else {
+        // straight from the mapped file
+        _decompressed.clear();
+    }
+    auto end = current + size;
+
+    // the frames of a corrupt chunk are skipped over as if of unknown types, at the chunk's start time
+    _decodedFrames.assign(chunk.frameCount, FrameEntry { Frame::TYPE_INVALID, chunk.startTime, nullptr, 0 });
+    for (auto& frame : _decodedFrames) {
+        if ((size_t)(end - current) < CHUNK_FRAME_HEADER_SIZE) {
+            qCWarning(recordingLog) << "Corrupt chunk" << chunkIndex << "in" << _name;
+            break;
+        }
+        auto storedType = readValue<FrameType>(current);
+        auto timeOffset = readValue<Frame::Time>(current);
+        auto frameSize = readValue<uint32_t>(current);
+        if ((size_t)(end - current) < frameSize) {
+            qCWarning(recordingLog) << "Corrupt chunk" << chunkIndex << "in" << _name;
+            break;
+        }
+        frame.type = _translationMap.value(storedType, Frame::TYPE_INVALID);
+        frame.timeOffset = timeOffset;
+        frame.data = (const char*)current;
+        frame.size = frameSize;
+        current += frameSize;
+    }
+    _decodedChunk = chunkIndex;
+    return true;
+}
+
+// Internal only function, needs no locking
+FrameConstPointer ChunkedClip::readFrame(size_t frameIndex) const {
+    FramePointer result;
+    if (decodeChunkOf(frameIndex)) {
+        const auto& frame = _decodedFrames[frameIndex - _chunks[_decodedChunk].firstFrame];
+        result = std::make_shared<Frame>();
+        result->type = frame.type;
+        result->timeOffset = frame.timeOffset;
+        if (frame.size) {
+            result->data = QByteArray(frame.data, frame.size);
+        }
+    }
+    return result;
+}
+
+// Internal only function, needs no locking
+void ChunkedClip::skipUnknownFrames() const {
+    while (decodeChunkOf(_frameIndex) &&
+           _decodedFrames[_frameIndex - _chunks[_decodedChunk].firstFrame].type == Frame::TYPE_INVALID) {
+        ++_frameIndex;
+    }
+}
+
+Clip::Pointer ChunkedClip::duplicate() const {
+    auto result = newClip();
+    Locker lock(_mutex);
+    for (size_t i = 0; i < _frameCount; ++i) {
+        auto frame = readFrame(i);
+        if (frame->type != Frame::TYPE_INVALID) {
+            result->addFrame(frame);
+        }
+    }
+    return result;
+}
+
+float ChunkedClip::duration() const {
+    Locker lock(_mutex);
+    if (_chunks.empty()) {
+        return 0;
+    }
+    return Frame::frameTimeToSeconds(_chunks.back().endTime);
+}
+
+size_t ChunkedClip::frameCount() const {
+    Locker lock(_mutex);
+    return _frameCount;
+}
+
+void ChunkedClip::seekFrameTime(Frame::Time offset) {
+    Locker lock(_mutex);
+    // the first chunk that ends at or after the offset has the first frame at or after it
+    auto chunkItr = std::lower_bound(_chunks.begin(), _chunks.end(), offset, [](const ChunkEntry& chunk, Frame::Time time) {
+        return chunk.endTime < time;
+    });
+    if (chunkItr == _chunks.end()) {
+        _frameIndex = _frameCount;
+        return;
+    }
+
+    decodeChunkOf(chunkItr->firstFrame);
+    auto frameItr = std::lower_bound(_decodedFrames.begin(), _decodedFrames.end(), offset,
+        [](const FrameEntry& frame, Frame::Time time) {
+            return frame.timeOffset < time;
+        }
+    );
+    _frameIndex = chunkItr->firstFrame + (frameItr - _decodedFrames.begin());
+}
+
+Frame::Time ChunkedClip::positionFrameTime() const {
+    Locker lock(_mutex);
+    skipUnknownFrames();
+    Frame::Time result = Frame::INVALID_TIME;
+    if (decodeChunkOf(_frameIndex)) {
+        result = _decodedFrames[_frameIndex - _chunks[_decodedChunk].firstFrame].timeOffset;
+    }
+    return result;
+}
+
+FrameConstPointer ChunkedClip::peekFrame() const {
+    Locker lock(_mutex);
+    skipUnknownFrames();
+    return readFrame(_frameIndex);
+}
+
+FrameConstPointer ChunkedClip::nextFrame() {
+    Locker lock(_mutex);
+    skipUnknownFrames();
+    FrameConstPointer result = readFrame(_frameIndex);
+    if (result) {
+        ++_frameIndex;
+    }
+    return result;
+}
+
+void ChunkedClip::skipFrame() {
+    Locker lock(_mutex);
+    skipUnknownFrames();
+    if (_frameIndex < _frameCount) {
+        ++_frameIndex;
+    }
+}
+
+void ChunkedClip::addFrame(FrameConstPointer) {
+    throw std::runtime_error("Chunked clips are read only, use duplicate to create a read/write clip");
+}
+
+bool ChunkedClip::write(const QString& fileName, Clip::Pointer clip, bool compressed, uint32_t chunkFrames) {
+    if (0 == clip->frameCount()) {
+        return false;
+    }
+
+    QFile outputFile(fileName);
+    if (!outputFile.open(QFile::Truncate | QFile::WriteOnly)) {
+        return false;
+    }
+
+    Finally closer([&] { outputFile.close(); });
+    return write(outputFile, clip, compressed, chunkFrames);
+}
+
+bool ChunkedClip::write(QIODevice& output, Clip::Pointer clip, bool compressed, uint32_t chunkFrames) {
+    auto frameTypes = Frame::getFrameTypes();
+    QJsonObject frameTypeObj;
+    QSet<FrameType> knownTypes;
+    for (const auto& frameTypeName : frameTypes.keys()) {
+        frameTypeObj[frameTypeName] = frameTypes[frameTypeName];
+        knownTypes.insert(frameTypes[frameTypeName]);
+    }
+    QJsonObject rootObject;
+    rootObject.insert(FRAME_TYPE_MAP, frameTypeObj);
+    QByteArray headerData = QJsonDocument(rootObject).toBinaryData();
+
+    QByteArray fileHeader;
+    fileHeader.append(CHUNKED_CLIP_MAGIC, sizeof(CHUNKED_CLIP_MAGIC));
+    appendValue(fileHeader, CHUNKED_CLIP_VERSION);
+    appendValue(fileHeader, (uint32_t)headerData.size());
+    fileHeader.append(headerData);
+    if (output.write(fileHeader) != fileHeader.size()) {
+        return false;
+    }
+    quint64 offset = fileHeader.size();
+
+    std::vector<ChunkEntry> chunks;
+    ChunkEntry chunk {};
+    QByteArray chunkData;
+    uint32_t frameCount = 0;
+    auto writeChunk = [&]() -> bool {
+        if (chunk.frameCount == 0) {
+            return true;
+        }
+        QByteArray data = chunkData;
+        chunk.uncompressedSize = chunkData.size();
+        chunk.flags = 0;
+        if (compressed) {
+            // audio frames are already small for their length, many avatar frames in a row compress well
+            QByteArray compressedData = qCompress(chunkData);
+            if (compressedData.size() < chunkData.size()) {
+                data = compressedData;
+                chunk.flags |= CHUNK_FLAG_COMPRESSED;
+            }
+        }
+        chunk.fileOffset = offset;
+        chunk.size = data.size();
+        if (output.write(data) != data.size()) {
+            return false;
+        }
+        offset += data.size();
+        chunks.push_back(chunk);
+        chunk = ChunkEntry {};
+        chunkData.clear();
+        return true;
+    };
+
+    clip->seek(0);
+    for (auto frame = clip->nextFrame(); frame; frame = clip->nextFrame()) {
+        // a frame of a type that isn't registered couldn't be played back
+        if (frame->type == Frame::TYPE_HEADER || !knownTypes.contains(frame->type)) {
+            continue;
+        }
+
+        if (chunk.frameCount == 0) {
+            chunk.firstFrame = frameCount;
+            chunk.startTime = frame->timeOffset;
+        }
+        appendValue(chunkData, frame->type);
+        appendValue(chunkData, frame->timeOffset);
+        appendValue(chunkData, (uint32_t)frame->data.size());
+        chunkData.append(frame->data);
+        chunk.endTime = frame->timeOffset;
+        ++chunk.frameCount;
+        ++frameCount;
+
+        if (chunk.frameCount >= chunkFrames || chunkData.size() >= MAX_CHUNK_BYTES) {
+            if (!writeChunk()) {
+                return false;
+            }
+        }
+    }
+    if (!writeChunk() || frameCount == 0) {
+        return false;
+    }
+
+    QByteArray index;
+    for (const auto& entry : chunks) {
+        appendValue(index, entry.fileOffset);
+        appendValue(index, entry.size);
+        appendValue(index, entry.uncompressedSize);
+        appendValue(index, entry.firstFrame);
+        appendValue(index, entry.frameCount);
+        appendValue(index, entry.startTime);
+        appendValue(index, entry.endTime);
+        appendValue(index, entry.flags);
+    }
+    appendValue(index, offset);
+    appendValue(index, (uint32_t)chunks.size());
+    appendValue(index, frameCount);
+    index.append(CHUNKED_CLIP_MAGIC, sizeof(CHUNKED_CLIP_MAGIC));
+    return output.write(index) == index.size();
+}
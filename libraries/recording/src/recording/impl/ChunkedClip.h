@@ -0,0 +1,113 @@
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_Recording_Impl_ChunkedClip_h
+#define hifi_Recording_Impl_ChunkedClip_h
+
+#include "../Clip.h"
+
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QMap>
+
+namespace recording {
+
+// A read only clip in the chunked format: the frames are written in chunks of about a second each, each chunk optionally
+// compressed as a whole, followed by an index of the chunks' offsets and frame times at the end of the file.
+// Unlike a PointerClip, nothing is kept per frame: opening a clip reads the index alone, seeking looks up the chunk by
+// time, and only the chunk being played is decompressed. Clips opened from a file are mapped read only, so the pages
+// of a recording are shared between the processes playing it.
+class ChunkedClip : public Clip {
+public:
+    using Pointer = std::shared_ptr<ChunkedClip>;
+
+    ChunkedClip(const QString& fileName);
+    ChunkedClip(const QByteArray& data, const QString& name);
+    virtual ~ChunkedClip();
+
+    static bool isChunked(const uchar* data, size_t size);
+    static bool isChunked(const QByteArray& data) { return isChunked((const uchar*)data.constData(), data.size()); }
+    static bool isChunkedFile(const QString& fileName);
+
+    // writes the clip's frames in chunks of up to chunkFrames frames, compressing the chunks that shrink when compressed
+    static bool write(QIODevice& output, Clip::Pointer clip, bool compressed = true, uint32_t chunkFrames = DEFAULT_CHUNK_FRAMES);
+    static bool write(const QString& fileName, Clip::Pointer clip, bool compressed = true,
+                      uint32_t chunkFrames = DEFAULT_CHUNK_FRAMES);
+
+    virtual Clip::Pointer duplicate() const override;
+    virtual QString getName() const override { return _name; }
+
+    virtual float duration() const override;
+    virtual size_t frameCount() const override;
+
+    virtual void seekFrameTime(Frame::Time offset) override;
+    virtual Frame::Time positionFrameTime() const override;
+
+    virtual FrameConstPointer peekFrame() const override;
+    virtual FrameConstPointer nextFrame() override;
+    virtual void skipFrame() override;
+    virtual void addFrame(FrameConstPointer) override;
+
+    const QJsonDocument& getHeader() const { return _header; }
+
+    // about a second of avatar frames
+    static const uint32_t DEFAULT_CHUNK_FRAMES = 90;
+
+protected:
+    virtual void reset() override;
+
+private:
+    struct ChunkEntry {
+        quint64 fileOffset;
+        uint32_t size;
+        uint32_t uncompressedSize;
+        uint32_t firstFrame;
+        uint32_t frameCount;
+        Frame::Time startTime;
+        Frame::Time endTime;
+        uint32_t flags;
+    };
+
+    struct FrameEntry {
+        FrameType type;
+        Frame::Time timeOffset;
+        const char* data;
+        uint32_t size;
+    };
+
+    void init(const uchar* data, size_t size);
+    // makes the chunk the frame index is in the decoded one, false past the last frame
+    bool decodeChunkOf(size_t frameIndex) const;
+    FrameConstPointer readFrame(size_t frameIndex) const;
+    // moves the position past the frames of types this process doesn't know
+    void skipUnknownFrames() const;
+
+    QString _name;
+    QFile _file;
+    QByteArray _buffer;
+    const uchar* _data { nullptr };
+    size_t _size { 0 };
+
+    QJsonDocument _header;
+    QMap<FrameType, FrameType> _translationMap;
+    std::vector<ChunkEntry> _chunks;
+    size_t _frameCount { 0 };
+    mutable size_t _frameIndex { 0 };
+
+    // the chunk being played, which points into the file unless it was compressed
+    mutable size_t _decodedChunk { SIZE_MAX };
+    mutable QByteArray _decompressed;
+    mutable std::vector<FrameEntry> _decodedFrames;
+};
+
+}
+
+#endif
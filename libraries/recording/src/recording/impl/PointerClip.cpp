@@ -25,7 +25,7 @@ using namespace recording;
 
 using FrameTranslationMap = QMap<FrameType, FrameType>;
 
-FrameTranslationMap parseTranslationMap(const QJsonDocument& doc) {
+FrameTranslationMap recording::parseTranslationMap(const QJsonDocument& doc) {
     FrameTranslationMap results;
     auto headerObj = doc.object();
     if (headerObj.contains(Clip::FRAME_TYPE_MAP)) {
@@ -15,6 +15,7 @@
 #include <mutex>
 
 #include <QtCore/QJsonDocument>
+#include <QtCore/QMap>
 
 #include "../Frame.h"
 
@@ -29,6 +30,9 @@ struct PointerFrameHeader : public FrameHeader {
 
 using PointerFrameHeaderList = std::list<PointerFrameHeader>;
 
+// the stored frame types of a clip's header to the types registered in this process, without the unregistered ones
+QMap<FrameType, FrameType> parseTranslationMap(const QJsonDocument& doc);
+
 class PointerClip : public ArrayClip<PointerFrameHeader> {
 public:
     using Pointer = std::shared_ptr<PointerClip>;
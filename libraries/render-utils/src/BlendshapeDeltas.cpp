@@ -0,0 +1,130 @@
+//
+//  BlendshapeDeltas.cpp
+//  libraries/render-utils/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BlendshapeDeltas.h"
+
+#include <map>
+#include <mutex>
+
+#include <glm/gtx/component_wise.hpp>
+
+#include <GLMHelpers.h>
+
+namespace {
+
+    // same as the Blender's
+    const float NORMAL_COEFFICIENT_SCALE = 0.01f;
+    const float MIN_COEFFICIENT = 0.0001f;
+
+    // the normal and tangent offsets are differences of unit vectors, scaled to fit the [-1, 1] range of their packing
+    const float NORMAL_DELTA_SCALE = 0.5f;
+
+    struct CacheEntry {
+        std::weak_ptr<const HFMModel> hfmModel;
+        std::weak_ptr<const BlendshapeDeltas> deltas;
+    };
+
+    std::mutex _cacheMutex;
+    std::map<std::pair<const HFMModel*, int>, CacheEntry> _cache;
+
+}
+
+BlendshapeDeltas::Pointer BlendshapeDeltas::get(const HFMModel::ConstPointer& hfmModel, int meshIndex) {
+    if (!hfmModel || meshIndex < 0 || meshIndex >= hfmModel->meshes.size() || hfmModel->meshes.at(meshIndex).blendshapes.isEmpty()) {
+        return Pointer();
+    }
+
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    for (auto itr = _cache.begin(); itr != _cache.end();) {
+        if (itr->second.deltas.expired()) {
+            itr = _cache.erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+
+    // the model is checked too, in case another was allocated where an expired one was
+    auto& entry = _cache[{ hfmModel.get(), meshIndex }];
+    auto deltas = entry.deltas.lock();
+    if (!deltas || entry.hfmModel.lock() != hfmModel) {
+        deltas = Pointer(new BlendshapeDeltas(hfmModel->meshes.at(meshIndex)));
+        entry.hfmModel = hfmModel;
+        entry.deltas = deltas;
+    }
+    return deltas;
+}
+
+BlendshapeDeltas::BlendshapeDeltas(const HFMMesh& mesh) {
+    int numVertices = mesh.vertices.size();
+    int numBlendshapes = mesh.blendshapes.size();
+
+    std::vector<uint32_t> numVertexDeltas(numVertices, 0);
+    size_t numDeltas = 0;
+    _positionScales.resize(numBlendshapes, 1.0f);
+    for (int i = 0; i < numBlendshapes; i++) {
+        const HFMBlendshape& blendshape = mesh.blendshapes.at(i);
+        float positionScale = 0.0f;
+        for (int j = 0; j < blendshape.indices.size(); j++) {
+            int index = blendshape.indices.at(j);
+            if (index >= 0 && index < numVertices) {
+                numVertexDeltas[index]++;
+                numDeltas++;
+                positionScale = std::max(positionScale, glm::compMax(glm::abs(blendshape.vertices.at(j))));
+            }
+        }
+        if (positionScale > 0.0f) {
+            _positionScales[i] = positionScale;
+        }
+    }
+
+    std::vector<BlendshapeOffset> texels(numVertices + numDeltas);
+    std::vector<uint32_t> nextVertexDeltas(numVertices);
+    uint32_t nextDelta = numVertices;
+    for (int i = 0; i < numVertices; i++) {
+        texels[i].packedPosNorTan = glm::uvec4(nextDelta, numVertexDeltas[i], 0, 0);
+        nextVertexDeltas[i] = nextDelta;
+        nextDelta += numVertexDeltas[i];
+    }
+
+    for (int i = 0; i < numBlendshapes; i++) {
+        const HFMBlendshape& blendshape = mesh.blendshapes.at(i);
+        float invPositionScale = 1.0f / _positionScales[i];
+        for (int j = 0; j < blendshape.indices.size(); j++) {
+            int index = blendshape.indices.at(j);
+            if (index < 0 || index >= numVertices) {
+                continue;
+            }
+            glm::vec3 normal = j < blendshape.normals.size() ? blendshape.normals.at(j) : glm::vec3(0.0f);
+            glm::vec3 tangent = j < blendshape.tangents.size() ? blendshape.tangents.at(j) : glm::vec3(0.0f);
+            texels[nextVertexDeltas[index]++].packedPosNorTan = glm::uvec4(
+                (uint32_t)i,
+                glm_packSnorm3x10_1x2(glm::vec4(blendshape.vertices.at(j) * invPositionScale, 0.0f)),
+                glm_packSnorm3x10_1x2(glm::vec4(normal * NORMAL_DELTA_SCALE, 0.0f)),
+                glm_packSnorm3x10_1x2(glm::vec4(tangent * NORMAL_DELTA_SCALE, 0.0f)));
+        }
+    }
+
+    auto size = texels.size() * sizeof(BlendshapeOffset);
+    _buffer = std::make_shared<gpu::Buffer>(size, reinterpret_cast<const gpu::Byte*>(texels.data()), size);
+}
+
+void BlendshapeDeltas::packCoefficients(const QVector<float>& coefficients, BlendshapeOffset* packed) const {
+    for (int i = 0; i < getNumBlendshapes(); i++) {
+        float coefficient = i < coefficients.size() ? coefficients.at(i) : 0.0f;
+        if (coefficient < MIN_COEFFICIENT) {
+            coefficient = 0.0f;
+        }
+        packed[i].packedPosNorTan = glm::uvec4(
+            glm::floatBitsToUint(coefficient * _positionScales[i]),
+            glm::floatBitsToUint(coefficient * NORMAL_COEFFICIENT_SCALE / NORMAL_DELTA_SCALE),
+            0, 0);
+    }
+}
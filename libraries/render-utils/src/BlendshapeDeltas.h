@@ -0,0 +1,55 @@
+//
+//  BlendshapeDeltas.h
+//  libraries/render-utils/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_BlendshapeDeltas_h
+#define hifi_BlendshapeDeltas_h
+
+#include <memory>
+#include <vector>
+
+#include <BlendshapeConstants.h>
+#include <gpu/Buffer.h>
+#include <hfm/HFM.h>
+
+// The blendshapes of a mesh, laid out for the vertex shaders to apply them (see Blendshape.slh) from the coefficients
+// of each model, instead of the Blender blending the offsets of every vertex on the CPU.
+//
+// The buffer holds a texel per vertex with the range of its deltas, followed by the deltas, each with its blendshape
+// and its position, normal and tangent offsets. The position offsets of a blendshape are normalized by its largest
+// one, which its coefficient is scaled by instead.
+class BlendshapeDeltas {
+public:
+    using Pointer = std::shared_ptr<const BlendshapeDeltas>;
+
+    // GLES keeps the Blender
+#if defined(USE_GLES)
+    static const bool ENABLED = false;
+#else
+    static const bool ENABLED = true;
+#endif
+
+    // Shared by all the models of hfmModel
+    static Pointer get(const HFMModel::ConstPointer& hfmModel, int meshIndex);
+
+    int getNumBlendshapes() const { return (int)_positionScales.size(); }
+    const gpu::BufferPointer& getBuffer() const { return _buffer; }
+
+    // Packs the coefficients of the model for the shaders, a texel per blendshape of the mesh
+    void packCoefficients(const QVector<float>& coefficients, BlendshapeOffset* packed) const;
+
+private:
+    BlendshapeDeltas(const HFMMesh& mesh);
+
+    gpu::BufferPointer _buffer;
+    std::vector<float> _positionScales;
+};
+
+#endif // hifi_BlendshapeDeltas_h
@@ -19,12 +19,22 @@
 
 #define BLOOM_BLUR_LEVEL_COUNT  3
 
-BloomThreshold::BloomThreshold(unsigned int downsamplingFactor) {
-    assert(downsamplingFactor > 0);
-    _parameters.edit()._sampleCount = downsamplingFactor;
+void BloomThresholdConfig::setResolutionLevel(int level) {
+    resolutionLevel = std::max(MIN_RESOLUTION_LEVEL, std::min(level, MAX_RESOLUTION_LEVEL));
+    emit dirty();
+}
+
+BloomThreshold::BloomThreshold() {
+    // the default resolution level's, until configured
+    _parameters.edit()._sampleCount = 4;
 }
 
-void BloomThreshold::configure(const Config& config) {}
+void BloomThreshold::configure(const Config& config) {
+    const int downsamplingFactor = 1 << config.resolutionLevel;
+    if (_parameters.get()._sampleCount != downsamplingFactor) {
+        _parameters.edit()._sampleCount = downsamplingFactor;
+    }
+}
 
 void BloomThreshold::run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
@@ -292,12 +302,13 @@ void BloomEffect::configure(const Config& config) {
         blurName.back() = '0' + i;
         auto blurConfig = config.getConfig<render::BlurGaussian>(blurName);
         blurConfig->filterScale = 1.0f;
+        blurConfig->linearSampling = true;
     }
 }
 
 void BloomEffect::build(JobModel& task, const render::Varying& inputs, render::Varying& outputs) {
-    // Start by computing threshold of color buffer input at quarter resolution
-    const auto bloomOutputs = task.addJob<BloomThreshold>("BloomThreshold", inputs, 4U);
+    // Start by computing threshold of color buffer input at a reduced resolution, a quarter by default
+    const auto bloomOutputs = task.addJob<BloomThreshold>("BloomThreshold", inputs);
 
     // Multi-scale blur, each new blur is half resolution of the previous pass
     const auto blurInputBuffer = bloomOutputs.getN<BloomThreshold::Outputs>(0);
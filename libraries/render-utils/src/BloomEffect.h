@@ -25,6 +25,19 @@ class BloomConfig : public render::Task::Config {
 
 class BloomThresholdConfig : public render::Job::Config {
     Q_OBJECT
+    Q_PROPERTY(int resolutionLevel MEMBER resolutionLevel WRITE setResolutionLevel NOTIFY dirty)
+
+public:
+    // The bloom is blurred at 1 / 2^resolutionLevel of the frame size, which is what most of its cost depends on
+    static const int MIN_RESOLUTION_LEVEL = 1;
+    static const int MAX_RESOLUTION_LEVEL = 3;
+
+    void setResolutionLevel(int level);
+
+    int resolutionLevel{ 2 };
+
+signals:
+    void dirty();
 };
 
 class BloomThreshold {
@@ -34,7 +47,7 @@ public:
     using Config = BloomThresholdConfig;
     using JobModel = render::Job::ModelIO<BloomThreshold, Inputs, Outputs, Config>;
 
-    BloomThreshold(unsigned int downsamplingFactor);
+    BloomThreshold();
 
     void configure(const Config& config);
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs);
@@ -235,6 +235,27 @@ static const std::string DEFAULT_VELOCITY_SHADER{
     " }"
 };
 
+// The number of local lights of the cluster of each fragment, from black to a ramp up to 32 lights, and white where
+// a cluster hits its light cap
+static const std::string DEFAULT_LIGHT_CLUSTER_SHADER{
+    "vec4 getFragmentColor() {"
+    "    DeferredFrameTransform deferredTransform = getDeferredFrameTransform();"
+    "    DeferredFragment frag = unpackDeferredFragment(deferredTransform, uv);"
+    "    vec4 worldPosition = getViewInverse() * vec4(frag.position.xyz, 1.0);"
+    "    vec4 clusterEyePos = frustumGrid_worldToEye(worldPosition);"
+    "    ivec3 clusterPos = frustumGrid_eyeToClusterPos(clusterEyePos.xyz);"
+    "    ivec3 cluster = clusterGrid_getCluster(frustumGrid_clusterToIndex(clusterPos));"
+    "    int numLights = cluster.x + cluster.y;"
+    "    if (!hasLocalLights(numLights, clusterPos, frustumGrid.dims)) {"
+    "        return vec4(vec3(0.0), 1.0);"
+    "    }"
+    "    if (max(cluster.x, cluster.y) >= 255) {"
+    "        return vec4(1.0);"
+    "    }"
+    "    return vec4(colorRamp(clamp(log2(float(numLights) + 1.0) / 5.0, 0.0, 1.0)), 1.0);"
+    " }"
+};
+
 static const std::string DEFAULT_CUSTOM_SHADER{
     "vec4 getFragmentColor() {"
     "    return vec4(1.0, 0.0, 0.0, 1.0);"
@@ -325,6 +346,8 @@ std::string DebugDeferredBuffer::getShaderSourceCode(Mode mode, const std::strin
             return DEFAULT_HALF_NORMAL_SHADER;
         case VelocityMode:
             return DEFAULT_VELOCITY_SHADER;
+        case LightClusterMode:
+            return DEFAULT_LIGHT_CLUSTER_SHADER;
         case CustomMode:
             return getFileContent(customFile, DEFAULT_CUSTOM_SHADER);
         default:
@@ -404,6 +427,7 @@ void DebugDeferredBuffer::run(const RenderContextPointer& renderContext, const I
     auto& velocityFramebuffer = inputs.get4();
     auto& frameTransform = inputs.get5();
     auto& shadowFrame = inputs.get6();
+    auto& lightClusters = inputs.get7();
 
     gpu::doInBatch("DebugDeferredBuffer::run", args->_context, [&](gpu::Batch& batch) {
         batch.enableStereo(false);
@@ -472,6 +496,12 @@ void DebugDeferredBuffer::run(const RenderContextPointer& renderContext, const I
                 batch.setResourceTexture(Textures::DebugTexture0, ambientOcclusionFramebuffer->getNormalTexture());
             }
         }
+        if (lightClusters && _mode == LightClusterMode) {
+            batch.setUniformBuffer(UBOs::DeferredFrameTransform, frameTransform->getFrameTransformBuffer());
+            batch.setUniformBuffer(UBOs::LightClusterFrustumGrid, lightClusters->_frustumGridBuffer);
+            batch.setUniformBuffer(UBOs::LightClusterGrid, lightClusters->_clusterGridBuffer);
+            batch.setUniformBuffer(UBOs::LightClusterContent, lightClusters->_clusterContentBuffer);
+        }
         const glm::vec4 color(1.0f, 1.0f, 1.0f, 1.0f);
         const glm::vec2 bottomLeft(_size.x, _size.y);
         const glm::vec2 topRight(_size.z, _size.w);
@@ -490,5 +520,11 @@ void DebugDeferredBuffer::run(const RenderContextPointer& renderContext, const I
         }
 
         batch.setResourceTexture(Textures::DebugTexture0, nullptr);
+
+        if (lightClusters && _mode == LightClusterMode) {
+            batch.setUniformBuffer(UBOs::LightClusterFrustumGrid, nullptr);
+            batch.setUniformBuffer(UBOs::LightClusterGrid, nullptr);
+            batch.setUniformBuffer(UBOs::LightClusterContent, nullptr);
+        }
     });
 }
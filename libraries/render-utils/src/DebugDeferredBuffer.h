@@ -22,6 +22,7 @@
 #include "VelocityBufferPass.h"
 
 #include "LightStage.h"
+#include "LightClusters.h"
 
 class DebugDeferredBufferConfig : public render::Job::Config {
     Q_OBJECT
@@ -40,13 +41,14 @@ signals:
 
 class DebugDeferredBuffer {
 public:
-    using Inputs = render::VaryingSet7<DeferredFramebufferPointer,
+    using Inputs = render::VaryingSet8<DeferredFramebufferPointer,
                                        LinearDepthFramebufferPointer,
                                        SurfaceGeometryFramebufferPointer,
                                        AmbientOcclusionFramebufferPointer,
                                        VelocityFramebufferPointer,
                                        DeferredFrameTransformPointer,
-                                       LightStage::ShadowFramePointer>;
+                                       LightStage::ShadowFramePointer,
+                                       LightClustersPointer>;
     using Config = DebugDeferredBufferConfig;
     using JobModel = render::Job::ModelI<DebugDeferredBuffer, Inputs, Config>;
 
@@ -92,6 +94,7 @@ protected:
         AmbientOcclusionBlurredMode,
         AmbientOcclusionNormalMode,
         VelocityMode,
+        LightClusterMode,
         CustomMode,  // Needs to stay last
 
         NumModes,
@@ -0,0 +1,42 @@
+//
+//  FoveationPass.cpp
+//  render-utils/src/
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FoveationPass.h"
+
+#include <gpu/Context.h>
+
+void BeginFoveation::configure(const Config& config) {
+    _radii = glm::vec2(config.innerRadius, glm::max(config.innerRadius, config.outerRadius));
+    _followGaze = config.followGaze;
+}
+
+void BeginFoveation::run(const render::RenderContextPointer& renderContext) {
+    auto args = renderContext->args;
+    if (!args->isStereo()) {
+        return;
+    }
+
+    glm::vec4 eyeCenters = _followGaze ? args->_gazeCenters : glm::vec4(0.0f);
+    gpu::doInBatch("BeginFoveation::run", args->_context, [&](gpu::Batch& batch) {
+        batch.setFoveation(eyeCenters, _radii);
+    });
+}
+
+void EndFoveation::run(const render::RenderContextPointer& renderContext) {
+    auto args = renderContext->args;
+    if (!args->isStereo()) {
+        return;
+    }
+
+    gpu::doInBatch("EndFoveation::run", args->_context, [&](gpu::Batch& batch) {
+        batch.setFoveation(glm::vec4(0.0f), glm::vec2(0.0f));
+    });
+}
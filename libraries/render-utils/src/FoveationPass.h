@@ -0,0 +1,57 @@
+//
+//  FoveationPass.h
+//  render-utils/src/
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+#pragma once
+#ifndef hifi_FoveationPass_h
+#define hifi_FoveationPass_h
+
+#include <render/Engine.h>
+
+// In stereo, shades the periphery of each eye's view coarser from BeginFoveation to EndFoveation, on the GPUs that can.
+// The radii are in [-1, 1] across each eye's view: out to innerRadius the shading stays at full rate, past outerRadius it
+// is at a quarter of it. With followGaze the full rate region goes where the eye tracker says the eyes look.
+class BeginFoveationConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(float innerRadius MEMBER innerRadius NOTIFY dirty)
+    Q_PROPERTY(float outerRadius MEMBER outerRadius NOTIFY dirty)
+    Q_PROPERTY(bool followGaze MEMBER followGaze NOTIFY dirty)
+
+public:
+    BeginFoveationConfig() : render::Job::Config(true) {}
+
+    float innerRadius { 0.6f };
+    float outerRadius { 0.9f };
+    bool followGaze { true };
+
+signals:
+    void dirty();
+};
+
+class BeginFoveation {
+public:
+    using Config = BeginFoveationConfig;
+    using JobModel = render::Job::Model<BeginFoveation, Config>;
+
+    void configure(const Config& config);
+    void run(const render::RenderContextPointer& renderContext);
+
+private:
+    glm::vec2 _radii { 0.6f, 0.9f };
+    bool _followGaze { true };
+};
+
+class EndFoveation {
+public:
+    using JobModel = render::Job::Model<EndFoveation>;
+
+    void run(const render::RenderContextPointer& renderContext);
+};
+
+#endif // hifi_FoveationPass_h
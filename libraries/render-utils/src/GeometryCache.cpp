@@ -725,8 +725,56 @@ gpu::ShaderPointer GeometryCache::_forwardUnlitFadeShader;
 
 std::map<std::tuple<bool, bool, bool, graphics::MaterialKey::CullFaceMode>, render::ShapePipelinePointer> GeometryCache::_shapePipelines;
 
+static gpu::Stream::FormatPointer makeArenaFormat(bool is3D, bool hasNormal, bool hasTexCoord) {
+    auto format = std::make_shared<gpu::Stream::Format>();
+    uint32_t offset = 0;
+    format->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(is3D ? gpu::VEC3 : gpu::VEC2, gpu::FLOAT, gpu::XYZ), offset);
+    offset += (is3D ? 3 : 2) * sizeof(float);
+    if (hasNormal) {
+        format->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), offset);
+        offset += 3 * sizeof(float);
+    }
+    if (hasTexCoord) {
+        format->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV), offset);
+    }
+    format->setAttribute(gpu::Stream::COLOR, 1, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA));
+    return format;
+}
+
+// a few hundred quads' worth at most, so a full buffer isn't held for long by the few items still drawing from it
+static const int VERTEX_ARENA_VERTICES = 4096;
+
+void GeometryCache::VertexArena::allocate(BatchItemDetails& details, int count, const float* vertices, const int* colors) {
+    assert(count <= VERTEX_ARENA_VERTICES);
+    const auto& channels = _format->getChannels();
+    auto vertexStride = channels.at(0)._stride;
+    auto colorStride = channels.at(1)._stride;
+    if (!_stream || _used + count > VERTEX_ARENA_VERTICES) {
+        _stream = std::make_shared<gpu::BufferStream>();
+        _stream->addBuffer(std::make_shared<gpu::Buffer>((gpu::Size)(VERTEX_ARENA_VERTICES * vertexStride), nullptr), 0, vertexStride);
+        _stream->addBuffer(std::make_shared<gpu::Buffer>((gpu::Size)(VERTEX_ARENA_VERTICES * colorStride), nullptr), 0, colorStride);
+        _used = 0;
+    }
+
+    const auto& buffers = _stream->getBuffers();
+    buffers[0]->setSubData(_used * vertexStride, count * vertexStride, (const gpu::Byte*)vertices);
+    buffers[1]->setSubData(_used * colorStride, count * colorStride, (const gpu::Byte*)colors);
+
+    details.verticesBuffer = buffers[0];
+    details.colorBuffer = buffers[1];
+    details.streamFormat = _format;
+    details.stream = _stream;
+    details.startVertex = _used;
+    _used += count;
+}
+
 GeometryCache::GeometryCache() :
-_nextID(0) {
+_nextID(0),
+_arena2D(makeArenaFormat(false, true, false)),
+_arena2DTexture(makeArenaFormat(false, true, true)),
+_arena3D(makeArenaFormat(true, true, false)),
+_arena3DTexture(makeArenaFormat(true, true, true)),
+_arenaPosition2D(makeArenaFormat(false, false, false)) {
     // Let's register its special shapePipeline factory:
     initializeShapePipelines();
     buildShapes();
@@ -1324,33 +1372,14 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, co
 
     const int FLOATS_PER_VERTEX = 2 + 3; // vertices + normals
     const int VERTICES = 4; // 1 quad = 4 vertices
-    const int NUM_POS_COORDS = 2;
-    const int VERTEX_NORMAL_OFFSET = NUM_POS_COORDS * sizeof(float);
 
-    if (!details.isCreated) {
+    // unregistered draws share details, and get their own vertices every time
+    if (!registered || !details.isCreated) {
 
         details.isCreated = true;
         details.vertices = VERTICES;
         details.vertexSize = FLOATS_PER_VERTEX;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
-        auto streamFormat = std::make_shared<gpu::Stream::Format>();
-        auto stream = std::make_shared<gpu::BufferStream>();
-
-        details.verticesBuffer = verticesBuffer;
-        details.colorBuffer = colorBuffer;
-        details.streamFormat = streamFormat;
-        details.stream = stream;
-
-        details.streamFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::XYZ), 0);
-        details.streamFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), VERTEX_NORMAL_OFFSET);
-        details.streamFormat->setAttribute(gpu::Stream::COLOR, 1, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA));
-
-        details.stream->addBuffer(details.verticesBuffer, 0, details.streamFormat->getChannels().at(0)._stride);
-        details.stream->addBuffer(details.colorBuffer, 0, details.streamFormat->getChannels().at(1)._stride);
-
-
         const glm::vec3 NORMAL(0.0f, 0.0f, 1.0f);
         float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
             minCorner.x, minCorner.y, NORMAL.x, NORMAL.y, NORMAL.z,
@@ -1366,13 +1395,12 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, co
             ((int(color.w * 255.0f) & 0xFF) << 24);
         int colors[NUM_COLOR_SCALARS_PER_QUAD] = { compactColor, compactColor, compactColor, compactColor };
 
-        details.verticesBuffer->append(sizeof(vertexBuffer), (gpu::Byte*) vertexBuffer);
-        details.colorBuffer->append(sizeof(colors), (gpu::Byte*) colors);
+        _arena2D.allocate(details, VERTICES, vertexBuffer, colors);
     }
 
     batch.setInputFormat(details.streamFormat);
     batch.setInputStream(0, *details.stream);
-    batch.draw(gpu::TRIANGLE_STRIP, 4, 0);
+    batch.draw(gpu::TRIANGLE_STRIP, 4, details.startVertex);
 }
 
 void GeometryCache::renderUnitQuad(gpu::Batch& batch, const glm::vec4& color, int id) {
@@ -1411,10 +1439,6 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, co
 
     const int FLOATS_PER_VERTEX = 2 + 3 + 2; // vertices + normals + tex coords
     const int VERTICES = 4; // 1 quad = 4 vertices
-    const int NUM_POS_COORDS = 2;
-    const int NUM_NORMAL_COORDS = 3;
-    const int VERTEX_NORMAL_OFFSET = NUM_POS_COORDS * sizeof(float);
-    const int VERTEX_TEXCOORD_OFFSET = VERTEX_NORMAL_OFFSET + NUM_NORMAL_COORDS * sizeof(float);
 
     if (!details.isCreated) {
 
@@ -1422,28 +1446,6 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, co
         details.vertices = VERTICES;
         details.vertexSize = FLOATS_PER_VERTEX;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
-
-        auto streamFormat = std::make_shared<gpu::Stream::Format>();
-        auto stream = std::make_shared<gpu::BufferStream>();
-
-        details.verticesBuffer = verticesBuffer;
-        details.colorBuffer = colorBuffer;
-
-        details.streamFormat = streamFormat;
-        details.stream = stream;
-
-        // zzmp: fix the normal across all renderQuad
-        details.streamFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::XYZ), 0);
-        details.streamFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), VERTEX_NORMAL_OFFSET);
-        details.streamFormat->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV), VERTEX_TEXCOORD_OFFSET);
-        details.streamFormat->setAttribute(gpu::Stream::COLOR, 1, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA));
-
-        details.stream->addBuffer(details.verticesBuffer, 0, details.streamFormat->getChannels().at(0)._stride);
-        details.stream->addBuffer(details.colorBuffer, 0, details.streamFormat->getChannels().at(1)._stride);
-
-
         const glm::vec3 NORMAL(0.0f, 0.0f, 1.0f);
         float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
             minCorner.x, minCorner.y, NORMAL.x, NORMAL.y, NORMAL.z, texCoordMinCorner.x, texCoordMinCorner.y,
@@ -1460,13 +1462,12 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec2& minCorner, co
             ((int(color.w * 255.0f) & 0xFF) << 24);
         int colors[NUM_COLOR_SCALARS_PER_QUAD] = { compactColor, compactColor, compactColor, compactColor };
 
-        details.verticesBuffer->append(sizeof(vertexBuffer), (gpu::Byte*) vertexBuffer);
-        details.colorBuffer->append(sizeof(colors), (gpu::Byte*) colors);
+        _arena2DTexture.allocate(details, VERTICES, vertexBuffer, colors);
     }
 
     batch.setInputFormat(details.streamFormat);
     batch.setInputStream(0, *details.stream);
-    batch.draw(gpu::TRIANGLE_STRIP, 4, 0);
+    batch.draw(gpu::TRIANGLE_STRIP, 4, details.startVertex);
 }
 
 void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& minCorner, const glm::vec3& maxCorner, const glm::vec4& color, int id) {
@@ -1493,35 +1494,14 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& minCorner, co
 
     const int FLOATS_PER_VERTEX = 3 + 3; // vertices + normals
     const int VERTICES = 4; // 1 quad = 4 vertices
-    const int NUM_POS_COORDS = 3;
-    const int VERTEX_NORMAL_OFFSET = NUM_POS_COORDS * sizeof(float);
 
-    if (!details.isCreated) {
+    // unregistered draws share details, and get their own vertices every time
+    if (!registered || !details.isCreated) {
 
         details.isCreated = true;
         details.vertices = VERTICES;
         details.vertexSize = FLOATS_PER_VERTEX;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
-
-        auto streamFormat = std::make_shared<gpu::Stream::Format>();
-        auto stream = std::make_shared<gpu::BufferStream>();
-
-        details.verticesBuffer = verticesBuffer;
-        details.colorBuffer = colorBuffer;
-
-        details.streamFormat = streamFormat;
-        details.stream = stream;
-
-        details.streamFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0);
-        details.streamFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), VERTEX_NORMAL_OFFSET);
-        details.streamFormat->setAttribute(gpu::Stream::COLOR, 1, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA));
-
-        details.stream->addBuffer(details.verticesBuffer, 0, details.streamFormat->getChannels().at(0)._stride);
-        details.stream->addBuffer(details.colorBuffer, 0, details.streamFormat->getChannels().at(1)._stride);
-
-
         const glm::vec3 NORMAL(0.0f, 0.0f, 1.0f);
         float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
             minCorner.x, minCorner.y, minCorner.z, NORMAL.x, NORMAL.y, NORMAL.z,
@@ -1537,13 +1517,12 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& minCorner, co
             ((int(color.w * 255.0f) & 0xFF) << 24);
         int colors[NUM_COLOR_SCALARS_PER_QUAD] = { compactColor, compactColor, compactColor, compactColor };
 
-        details.verticesBuffer->append(sizeof(vertexBuffer), (gpu::Byte*) vertexBuffer);
-        details.colorBuffer->append(sizeof(colors), (gpu::Byte*) colors);
+        _arena3D.allocate(details, VERTICES, vertexBuffer, colors);
     }
 
     batch.setInputFormat(details.streamFormat);
     batch.setInputStream(0, *details.stream);
-    batch.draw(gpu::TRIANGLE_STRIP, 4, 0);
+    batch.draw(gpu::TRIANGLE_STRIP, 4, details.startVertex);
 }
 
 void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& topLeft, const glm::vec3& bottomLeft,
@@ -1589,37 +1568,15 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& topLeft, cons
 
     const int FLOATS_PER_VERTEX = 3 + 3 + 2; // vertices + normals + tex coords
     const int VERTICES = 4; // 1 quad = 4 vertices
-    const int NUM_POS_COORDS = 3;
-    const int NUM_NORMAL_COORDS = 3;
-    const int VERTEX_NORMAL_OFFSET = NUM_POS_COORDS * sizeof(float);
-    const int VERTEX_TEXCOORD_OFFSET = VERTEX_NORMAL_OFFSET + NUM_NORMAL_COORDS * sizeof(float);
 
 
-    if (!details.isCreated) {
+    // unregistered draws share details, and get their own vertices every time
+    if (!registered || !details.isCreated) {
 
         details.isCreated = true;
         details.vertices = VERTICES;
         details.vertexSize = FLOATS_PER_VERTEX; // NOTE: this isn't used for BatchItemDetails maybe we can get rid of it
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
-        auto streamFormat = std::make_shared<gpu::Stream::Format>();
-        auto stream = std::make_shared<gpu::BufferStream>();
-
-        details.verticesBuffer = verticesBuffer;
-        details.colorBuffer = colorBuffer;
-        details.streamFormat = streamFormat;
-        details.stream = stream;
-
-        details.streamFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0);
-        details.streamFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), VERTEX_NORMAL_OFFSET);
-        details.streamFormat->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV), VERTEX_TEXCOORD_OFFSET);
-        details.streamFormat->setAttribute(gpu::Stream::COLOR, 1, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA));
-
-        details.stream->addBuffer(details.verticesBuffer, 0, details.streamFormat->getChannels().at(0)._stride);
-        details.stream->addBuffer(details.colorBuffer, 0, details.streamFormat->getChannels().at(1)._stride);
-
-
         const glm::vec3 NORMAL(0.0f, 0.0f, 1.0f);
         float vertexBuffer[VERTICES * FLOATS_PER_VERTEX] = {
             bottomLeft.x, bottomLeft.y, bottomLeft.z, NORMAL.x, NORMAL.y, NORMAL.z, texCoordBottomLeft.x, texCoordBottomLeft.y,
@@ -1635,13 +1592,12 @@ void GeometryCache::renderQuad(gpu::Batch& batch, const glm::vec3& topLeft, cons
             ((int(color.w * 255.0f) & 0xFF) << 24);
         int colors[NUM_COLOR_SCALARS_PER_QUAD] = { compactColor, compactColor, compactColor, compactColor };
 
-        details.verticesBuffer->append(sizeof(vertexBuffer), (gpu::Byte*) vertexBuffer);
-        details.colorBuffer->append(sizeof(colors), (gpu::Byte*) colors);
+        _arena3DTexture.allocate(details, VERTICES, vertexBuffer, colors);
     }
 
     batch.setInputFormat(details.streamFormat);
     batch.setInputStream(0, *details.stream);
-    batch.draw(gpu::TRIANGLE_STRIP, 4, 0);
+    batch.draw(gpu::TRIANGLE_STRIP, 4, details.startVertex);
 }
 
 void GeometryCache::renderDashedLine(gpu::Batch& batch, const glm::vec3& start, const glm::vec3& end, const glm::vec4& color,
@@ -1775,6 +1731,7 @@ streamFormat(NULL),
 stream(NULL),
 vertices(0),
 vertexSize(0),
+startVertex(0),
 isCreated(false) {
     population++;
 #ifdef WANT_DEBUG
@@ -1789,6 +1746,7 @@ streamFormat(other.streamFormat),
 stream(other.stream),
 vertices(other.vertices),
 vertexSize(other.vertexSize),
+startVertex(other.startVertex),
 isCreated(other.isCreated) {
     population++;
 #ifdef WANT_DEBUG
@@ -1806,6 +1764,7 @@ GeometryCache::BatchItemDetails::~BatchItemDetails() {
 
 void GeometryCache::BatchItemDetails::clear() {
     isCreated = false;
+    startVertex = 0;
     uniformBuffer.reset();
     verticesBuffer.reset();
     colorBuffer.reset();
@@ -1850,32 +1809,14 @@ void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec3& p1, const glm
     }
 
     const int FLOATS_PER_VERTEX = 3 + 3; // vertices + normals
-    const int NUM_POS_COORDS = 3;
-    const int VERTEX_NORMAL_OFFSET = NUM_POS_COORDS * sizeof(float);
     const int vertices = 2;
-    if (!details.isCreated) {
+    // unregistered draws share details, and get their own vertices every time
+    if (!registered || !details.isCreated) {
 
         details.isCreated = true;
         details.vertices = vertices;
         details.vertexSize = FLOATS_PER_VERTEX;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
-        auto streamFormat = std::make_shared<gpu::Stream::Format>();
-        auto stream = std::make_shared<gpu::BufferStream>();
-
-        details.verticesBuffer = verticesBuffer;
-        details.colorBuffer = colorBuffer;
-        details.streamFormat = streamFormat;
-        details.stream = stream;
-
-        details.streamFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0);
-        details.streamFormat->setAttribute(gpu::Stream::NORMAL, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), VERTEX_NORMAL_OFFSET);
-        details.streamFormat->setAttribute(gpu::Stream::COLOR, 1, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA));
-
-        details.stream->addBuffer(details.verticesBuffer, 0, details.streamFormat->getChannels().at(0)._stride);
-        details.stream->addBuffer(details.colorBuffer, 0, details.streamFormat->getChannels().at(1)._stride);
-
         const glm::vec3 NORMAL(1.0f, 0.0f, 0.0f);
         float vertexBuffer[vertices * FLOATS_PER_VERTEX] = {
             p1.x, p1.y, p1.z, NORMAL.x, NORMAL.y, NORMAL.z,
@@ -1884,8 +1825,7 @@ void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec3& p1, const glm
         const int NUM_COLOR_SCALARS = 2;
         int colors[NUM_COLOR_SCALARS] = { compactColor1, compactColor2 };
 
-        details.verticesBuffer->append(sizeof(vertexBuffer), (gpu::Byte*) vertexBuffer);
-        details.colorBuffer->append(sizeof(colors), (gpu::Byte*) colors);
+        _arena3D.allocate(details, vertices, vertexBuffer, colors);
 
 #ifdef WANT_DEBUG
         if (id == UNKNOWN_ID) {
@@ -1899,7 +1839,7 @@ void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec3& p1, const glm
     // this is what it takes to render a quad
     batch.setInputFormat(details.streamFormat);
     batch.setInputStream(0, *details.stream);
-    batch.draw(gpu::LINES, 2, 0);
+    batch.draw(gpu::LINES, 2, details.startVertex);
 }
 
 void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec2& p1, const glm::vec2& p2,
@@ -1940,36 +1880,19 @@ void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec2& p1, const glm
 
     const int FLOATS_PER_VERTEX = 2;
     const int vertices = 2;
-    if (!details.isCreated) {
+    // unregistered draws share details, and get their own vertices every time
+    if (!registered || !details.isCreated) {
 
         details.isCreated = true;
         details.vertices = vertices;
         details.vertexSize = FLOATS_PER_VERTEX;
 
-        auto verticesBuffer = std::make_shared<gpu::Buffer>();
-        auto colorBuffer = std::make_shared<gpu::Buffer>();
-        auto streamFormat = std::make_shared<gpu::Stream::Format>();
-        auto stream = std::make_shared<gpu::BufferStream>();
-
-        details.verticesBuffer = verticesBuffer;
-        details.colorBuffer = colorBuffer;
-        details.streamFormat = streamFormat;
-        details.stream = stream;
-
-        details.streamFormat->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC3, gpu::FLOAT, gpu::XYZ), 0);
-        details.streamFormat->setAttribute(gpu::Stream::COLOR, 1, gpu::Element(gpu::VEC4, gpu::NUINT8, gpu::RGBA));
-
-        details.stream->addBuffer(details.verticesBuffer, 0, details.streamFormat->getChannels().at(0)._stride);
-        details.stream->addBuffer(details.colorBuffer, 0, details.streamFormat->getChannels().at(1)._stride);
-
-
         float vertexBuffer[vertices * FLOATS_PER_VERTEX] = { p1.x, p1.y, p2.x, p2.y };
 
         const int NUM_COLOR_SCALARS = 2;
         int colors[NUM_COLOR_SCALARS] = { compactColor1, compactColor2 };
 
-        details.verticesBuffer->append(sizeof(vertexBuffer), (gpu::Byte*) vertexBuffer);
-        details.colorBuffer->append(sizeof(colors), (gpu::Byte*) colors);
+        _arenaPosition2D.allocate(details, vertices, vertexBuffer, colors);
 
 #ifdef WANT_DEBUG
         if (id == UNKNOWN_ID) {
@@ -1983,7 +1906,7 @@ void GeometryCache::renderLine(gpu::Batch& batch, const glm::vec2& p1, const glm
     // this is what it takes to render a quad
     batch.setInputFormat(details.streamFormat);
     batch.setInputStream(0, *details.stream);
-    batch.draw(gpu::LINES, 2, 0);
+    batch.draw(gpu::LINES, 2, details.startVertex);
 }
 
 void GeometryCache::useSimpleDrawPipeline(gpu::Batch& batch, bool noBlend) {
@@ -404,6 +404,7 @@ private:
 
         int vertices;
         int vertexSize;
+        int startVertex; // in the stream's buffers, which are a vertex arena's when it drew from one
         bool isCreated;
         
         BatchItemDetails();
@@ -412,6 +413,29 @@ private:
         void clear();
     };
 
+    // The vertices of the quads and lines drawn a few at a time, packed by vertex format into shared buffers instead of a
+    // pair of buffers for each: draws of the same format bind the same buffers and the same format and only differ in
+    // their first vertex. Once the buffers fill up the arena moves on to new ones, and the full ones go away with the last
+    // batch or registered item drawing from them, so nothing is overwritten while a frame could still read it.
+    class VertexArena {
+    public:
+        VertexArena(const gpu::Stream::FormatPointer& format) : _format(format) {}
+
+        // copies in count vertices and their packed colors and points details at them
+        void allocate(BatchItemDetails& details, int count, const float* vertices, const int* colors);
+
+    private:
+        gpu::Stream::FormatPointer _format;
+        gpu::BufferStreamPointer _stream;
+        int _used { 0 };
+    };
+
+    VertexArena _arena2D;
+    VertexArena _arena2DTexture;
+    VertexArena _arena3D;
+    VertexArena _arena3DTexture;
+    VertexArena _arenaPosition2D;
+
     QHash<IntPair, VerticesIndices> _coneVBOs;
 
     int _nextID{ 1 };
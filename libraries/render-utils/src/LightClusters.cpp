@@ -220,15 +220,19 @@ bool reduceSphereToPlane(const glm::vec4& sphere, const glm::vec4& plane, glm::v
 }
 
 
-uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zSlice, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
+uint32_t clusterReferenceKey(int clusterIndex, bool isSpot) {
+    return (uint32_t)clusterIndex * 2 + (isSpot ? 1 : 0);
+}
+
+uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zSlice, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, bool isSpot, const glm::vec4& eyePosRadius,
+    std::vector<LightClusters::ClusterReference>& references) {
     glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
     uint32_t numClustersTouched = 0;
 
     for (auto y = yMin; (y <= yMax); y++) {
         for (auto x = xMin; (x <= xMax); x++) {
             auto index = x + gridPosToOffset.y * y + gridPosToOffset.z * zSlice;
-            clusterGrid[index].emplace_back(lightId);
+            references.push_back({ clusterReferenceKey(index, isSpot), (LightClusters::LightIndex)lightId });
             numClustersTouched++;
         }
     }
@@ -236,8 +240,8 @@ uint32_t scanLightVolumeBoxSlice(FrustumGrid& grid, const FrustumGrid::Planes pl
     return numClustersTouched;
 }
 
-uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
+uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, bool isSpot, const glm::vec4& eyePosRadius,
+    std::vector<LightClusters::ClusterReference>& references) {
     glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
     uint32_t numClustersTouched = 0;
 
@@ -245,7 +249,7 @@ uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[
         for (auto y = yMin; (y <= yMax); y++) {
             for (auto x = xMin; (x <= xMax); x++) {
                 auto index = x + gridPosToOffset.y * y + gridPosToOffset.z * z;
-                clusterGrid[index].emplace_back(lightId);
+                references.push_back({ clusterReferenceKey(index, isSpot), (LightClusters::LightIndex)lightId });
                 numClustersTouched++;
             }
         }
@@ -254,9 +258,9 @@ uint32_t scanLightVolumeBox(FrustumGrid& grid, const FrustumGrid::Planes planes[
     return numClustersTouched;
 }
 
-uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, const glm::vec4& eyePosRadius,
-    std::vector< std::vector<LightClusters::LightIndex>>& clusterGrid) {
-    glm::ivec3 gridPosToOffset(1, grid.dims.x, grid.dims.x * grid.dims.y);
+uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes planes[3], int zMin, int zMax, int yMin, int yMax, int xMin, int xMax, LightClusters::LightID lightId, bool isSpot, const glm::vec4& eyePosRadius,
+    std::vector<LightClusters::ClusterReference>& references) {
+    int numClusters = grid.frustumGrid_numClusters();
     uint32_t numClustersTouched = 0;
     const auto& xPlanes = planes[0];
     const auto& yPlanes = planes[1];
@@ -308,11 +312,11 @@ uint32_t scanLightVolumeSphere(FrustumGrid& grid, const FrustumGrid::Planes plan
 
             for (; (x <= xs); x++) {
                 auto index = grid.frustumGrid_clusterToIndex(ivec3(x, y, z));
-                if (index < (int)clusterGrid.size()) {
-                    clusterGrid[index].emplace_back(lightId);
+                if (index < numClusters) {
+                    references.push_back({ clusterReferenceKey(index, isSpot), (LightClusters::LightIndex)lightId });
                     numClustersTouched++;
                 } else {
-                    qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphere invalid index found ? numClusters = " << clusterGrid.size() << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
+                    qCDebug(renderutils) << "WARNING: LightClusters::scanLightVolumeSphere invalid index found ? numClusters = " << numClusters << " index = " << index << " found from cluster xyz = " << x << " " << y << " " << z;
                 }
             }
         }
@@ -325,19 +329,12 @@ glm::ivec3 LightClusters::updateClusters() {
     // Make sure resource are in good shape
     updateClusterResource();
 
-    // Clean up last info
+    // Clean up last info, keeping the allocations of the previous frames
     uint32_t numClusters = (uint32_t)_clusterGrid.size();
-
-    std::vector< std::vector< LightIndex > > clusterGridPoint(numClusters);
-    std::vector< std::vector< LightIndex > > clusterGridSpot(numClusters);
-
-    _clusterGrid.clear();
-    _clusterGrid.resize(numClusters, EMPTY_CLUSTER);
+    std::fill(_clusterGrid.begin(), _clusterGrid.end(), EMPTY_CLUSTER);
+    _clusterReferences.clear();
 
     uint32_t maxNumIndices = (uint32_t)_clusterContent.size();
-    _clusterContent.clear();
-    _clusterContent.resize(maxNumIndices, INVALID_LIGHT);
-
 
     auto theFrustumGrid(_frustumGridBuffer.get());
 
@@ -473,50 +470,55 @@ glm::ivec3 LightClusters::updateClusters() {
         }
 
         // now voxelize
-        auto& clusterGrid = (isSpot ? clusterGridSpot : clusterGridPoint);
         if (beyondFar) {
-            numClusterTouched += scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, zMin, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
+            numClusterTouched += scanLightVolumeBoxSlice(theFrustumGrid, _gridPlanes, zMin, yMin, yMax, xMin, xMax, lightId, isSpot, glm::vec4(glm::vec3(eyeOri), radius), _clusterReferences);
         } else {
-            numClusterTouched += scanLightVolumeSphere(theFrustumGrid, _gridPlanes, zMin, zMax, yMin, yMax, xMin, xMax, lightId, glm::vec4(glm::vec3(eyeOri), radius), clusterGrid);
+            numClusterTouched += scanLightVolumeSphere(theFrustumGrid, _gridPlanes, zMin, zMax, yMin, yMax, xMin, xMax, lightId, isSpot, glm::vec4(glm::vec3(eyeOri), radius), _clusterReferences);
         }
 
         numClusteredLights++;
     }
 
     // Lights have been gathered now reexpress in terms of 2 sequential buffers
-    // Start filling from near to far and stops if it overflows
-    bool checkBudget = false;
-    if (numClusterTouched > maxNumIndices) {
-        checkBudget = true;
+    _clusterReferenceCounts.assign(numClusters * 2, 0);
+    _clusterReferenceOffsets.resize(numClusters * 2);
+    for (const auto& reference : _clusterReferences) {
+        _clusterReferenceCounts[reference.key]++;
     }
-    uint16_t indexOffset = 0;
-    for (int i = 0; i < (int) clusterGridPoint.size(); i++) {
-        auto& clusterPoint = clusterGridPoint[i];
-        auto& clusterSpot = clusterGridSpot[i];
-
-        uint8_t numLightsPoint = ((uint8_t)clusterPoint.size());
-        uint8_t numLightsSpot = ((uint8_t)clusterSpot.size());
-        uint16_t numLights = numLightsPoint + numLightsSpot;
-        uint16_t offset = indexOffset;
-
-        // Check for overflow
-        if (checkBudget) {
-            if ((indexOffset + numLights) > (uint16_t) maxNumIndices) {
-                break;
-            }
+
+    // Start filling from near to far and stops if it overflows, the counts become the number of lights kept
+    _numDroppedReferences = 0;
+    uint32_t indexOffset = 0;
+    for (uint32_t i = 0; i < numClusters; i++) {
+        auto& numLightsPoint = _clusterReferenceCounts[2 * i];
+        auto& numLightsSpot = _clusterReferenceCounts[2 * i + 1];
+        uint32_t numReferences = numLightsPoint + numLightsSpot;
+        numLightsPoint = std::min(numLightsPoint, MAX_CLUSTER_LIGHTS);
+        numLightsSpot = std::min(numLightsSpot, MAX_CLUSTER_LIGHTS);
+        if ((indexOffset + numLightsPoint + numLightsSpot) > maxNumIndices) {
+            numLightsPoint = 0;
+            numLightsSpot = 0;
+        }
+        _numDroppedReferences += numReferences - (numLightsPoint + numLightsSpot);
+
+        if (numLightsPoint + numLightsSpot == 0) {
+            continue;
         }
 
         // Encode the cluster grid: [ ContentOffset - 16bits, Num Point LIghts - 8bits, Num Spot Lights - 8bits] 
-        _clusterGrid[i] = (uint32_t)((0xFF000000 & (numLightsSpot << 24)) | (0x00FF0000 & (numLightsPoint << 16)) | (0x0000FFFF & offset));
+        _clusterGrid[i] = (uint32_t)((0xFF000000 & (numLightsSpot << 24)) | (0x00FF0000 & (numLightsPoint << 16)) | (0x0000FFFF & indexOffset));
 
+        _clusterReferenceOffsets[2 * i] = indexOffset;
+        _clusterReferenceOffsets[2 * i + 1] = indexOffset + numLightsPoint;
+        indexOffset += numLightsPoint + numLightsSpot;
+    }
 
-        if (numLightsPoint) {
-            memcpy(_clusterContent.data() + indexOffset, clusterPoint.data(), numLightsPoint * sizeof(LightIndex));
-            indexOffset += numLightsPoint;
-        }
-        if (numLightsSpot) {
-            memcpy(_clusterContent.data() + indexOffset, clusterSpot.data(), numLightsSpot * sizeof(LightIndex));
-            indexOffset += numLightsSpot;
+    // Then the references are sorted into the content, in the order of the lights
+    for (const auto& reference : _clusterReferences) {
+        auto& numLights = _clusterReferenceCounts[reference.key];
+        if (numLights > 0) {
+            _clusterContent[_clusterReferenceOffsets[reference.key]++] = reference.light;
+            numLights--;
         }
     }
 
@@ -573,6 +575,7 @@ void LightClusteringPass::run(const render::RenderContextPointer& renderContext,
     config->setNumInputLights(clusteringStats.x);
     config->setNumClusteredLights(clusteringStats.y);
     config->setNumClusteredLightReferences(clusteringStats.z);
+    config->setNumDroppedLightReferences(_lightClusters->_numDroppedReferences);
 }
 
 DebugLightClusters::DebugLightClusters() {
@@ -103,6 +103,20 @@ public:
 
     using LightIndex = uint16_t;
 
+    // The cluster description only has 8 bits for each type of lights
+    static constexpr uint32_t MAX_CLUSTER_LIGHTS { 0xFF };
+
+    // A light touching a cluster, keyed by twice the cluster index, plus one for the spot lights so they come after
+    // the point lights of the cluster.  They are gathered in one flat list, then counted and sorted into the content.
+    struct ClusterReference {
+        uint32_t key;
+        LightIndex light;
+    };
+    std::vector<ClusterReference> _clusterReferences;
+    std::vector<uint32_t> _clusterReferenceCounts;
+    std::vector<uint32_t> _clusterReferenceOffsets;
+    uint32_t _numDroppedReferences { 0 };
+
     std::vector<uint32_t> _clusterGrid;
     std::vector<LightIndex> _clusterContent;
     gpu::BufferView _clusterGridBuffer;
@@ -131,6 +145,7 @@ class LightClusteringPassConfig : public render::Job::Config {
     Q_PROPERTY(int numClusteredLightReferences MEMBER numClusteredLightReferences NOTIFY dirty)
     Q_PROPERTY(int numInputLights MEMBER numInputLights NOTIFY dirty)
     Q_PROPERTY(int numClusteredLights MEMBER numClusteredLights NOTIFY dirty)
+    Q_PROPERTY(int numDroppedLightReferences MEMBER numDroppedLightReferences NOTIFY dirty)
 
     Q_PROPERTY(int numSceneLights MEMBER numSceneLights NOTIFY dirty)
     Q_PROPERTY(int numFreeSceneLights MEMBER numFreeSceneLights NOTIFY dirty)
@@ -151,10 +166,13 @@ public:
     int numClusteredLightReferences { 0 };
     int numInputLights { 0 };
     int numClusteredLights { 0 };
+    // the references over the content budget or the light cap of their cluster
+    int numDroppedLightReferences { 0 };
 
     void setNumClusteredLightReferences(int numRefs) { numClusteredLightReferences = numRefs; }
     void setNumInputLights(int numLights) { numInputLights = numLights; }
     void setNumClusteredLights(int numLights) { numClusteredLights = numLights; }
+    void setNumDroppedLightReferences(int numRefs) { numDroppedLightReferences = numRefs; }
 
     int numSceneLights { 0 };
     int numFreeSceneLights { 0 };
@@ -250,7 +250,7 @@ void LightStage::Shadow::setKeylightFrustum(const ViewFrustum& viewFrustum,
 }
 
 void LightStage::Shadow::setKeylightCascadeFrustum(unsigned int cascadeIndex, const ViewFrustum& viewFrustum,
-                                            float nearDepth, float farDepth) {
+                                            float nearDepth, float farDepth, bool isStable) {
     assert(nearDepth < farDepth);
     assert(cascadeIndex < _cascades.size());
 
@@ -287,9 +287,53 @@ void LightStage::Shadow::setKeylightCascadeFrustum(unsigned int cascadeIndex, co
     fitFrustum(farCorners.topLeft);
     fitFrustum(farCorners.topRight);
 
+    cascade._snapSize = 0.0f;
+    // The light space coordinates of the frustum position, to snap in a light space that doesn't move with the view
+    glm::vec3 origin;
+    if (isStable) {
+        // The bounding sphere of the slice doesn't change with the view orientation
+        const vec3 corners[8] = { nearCorners.bottomLeft, nearCorners.bottomRight, nearCorners.topLeft, nearCorners.topRight,
+                                  farCorners.bottomLeft, farCorners.bottomRight, farCorners.topLeft, farCorners.topRight };
+        vec3 center { 0.0f };
+        for (const auto& corner : corners) {
+            center += corner;
+        }
+        center /= 8.0f;
+        float radius = 0.0f;
+        for (const auto& corner : corners) {
+            radius = glm::max(radius, glm::distance(center, corner));
+        }
+        // Keep float noise from changing the size frame to frame
+        static const float RADIUS_QUANTUM = 1.0f / 16.0f;
+        radius = glm::ceil(radius / RADIUS_QUANTUM) * RADIUS_QUANTUM;
+
+        // Move the cascade a sixteenth of its size at a time
+        static const float SNAP_STEPS_PER_CASCADE = 16.0f;
+        const float snapSize = 2.0f * radius / SNAP_STEPS_PER_CASCADE;
+        cascade._snapSize = snapSize;
+
+        origin = glm::inverse(cascade._frustum->getOrientation()) * cascade._frustum->getPosition();
+        const vec3 sphereCenter = shadowViewInverse.transform(center) + origin;
+        min.x = glm::floor((sphereCenter.x - radius) / snapSize) * snapSize;
+        min.y = glm::floor((sphereCenter.y - radius) / snapSize) * snapSize;
+        max.x = min.x + 2.0f * radius + snapSize;
+        max.y = min.y + 2.0f * radius + snapSize;
+        min.x -= origin.x;
+        min.y -= origin.y;
+        max.x -= origin.x;
+        max.y -= origin.y;
+        max.z = glm::max(max.z, sphereCenter.z - origin.z + radius);
+    }
+
     // Re-adjust near and far shadow distance
     auto near = glm::min(-max.z, nearDepth);
     auto far = cascade.computeFarDistance(viewFrustum, shadowViewInverse, min.x, max.x, min.y, max.y, viewMaxShadowDistance);
+    if (isStable) {
+        const auto snapSize = cascade._snapSize;
+        // Distances along the view direction, -z, are snapped from the light space origin too
+        near = glm::floor((near - origin.z) / snapSize) * snapSize + origin.z;
+        far = glm::ceil((far - origin.z) / snapSize) * snapSize + origin.z;
+    }
 
     glm::mat4 ortho = glm::ortho<float>(min.x, max.x, min.y, max.y, near, far);
     cascade._frustum->setProjection(ortho);
@@ -64,11 +64,15 @@ public:
             float getMinDistance() const { return _minDistance; }
             float getMaxDistance() const { return _maxDistance; }
 
+            // The step the bounds of a stable cascade are snapped to in light space, 0 if the cascade fits the view tightly
+            float getSnapSize() const { return _snapSize; }
+
         private:
 
             std::shared_ptr<ViewFrustum> _frustum;
             float _minDistance;
             float _maxDistance;
+            float _snapSize { 0.0f };
 
             float computeFarDistance(const ViewFrustum& viewFrustum, const Transform& shadowViewInverse,
                                      float left, float right, float bottom, float top, float viewMaxShadowDistance) const;
@@ -80,8 +84,10 @@ public:
 
         void setKeylightFrustum(const ViewFrustum& viewFrustum,
                                 float nearDepth = 1.0f, float farDepth = 1000.0f);
+        // A stable cascade bounds its slice of the view with a sphere instead of a box, placed on a grid fixed in light
+        // space, so it stays put while the view turns or moves within a grid step, at the cost of some resolution
         void setKeylightCascadeFrustum(unsigned int cascadeIndex, const ViewFrustum& viewFrustum,
-                                float nearDepth = 1.0f, float farDepth = 1000.0f);
+                                float nearDepth = 1.0f, float farDepth = 1000.0f, bool isStable = false);
         void setKeylightCascadeBias(unsigned int cascadeIndex, float constantBias, float slopeBias);
         void setCascadeFrustum(unsigned int cascadeIndex, const ViewFrustum& shadowFrustum);
 
@@ -25,6 +25,25 @@
 using namespace render;
 
 bool ModelMeshPartPayload::enableMaterialProceduralShaders = false;
+bool ModelMeshPartPayload::enableInstancing = true;
+float ModelMeshPartPayload::lodErrorPixels = 1.0f;
+
+namespace {
+
+    // a coarser level of detail is only switched to once its error is this much under the threshold, so the levels don't
+    // flicker back and forth at it
+    const float LOD_HYSTERESIS = 0.75f;
+
+    // the pixels per meter on screen at the point of the bound nearest the viewer
+    float evalPixelsPerMeter(RenderArgs* args, const AABox& bound) {
+        const auto& frustum = args->getViewFrustum();
+        const float MIN_LOD_DISTANCE = 0.01f;
+        float distance = std::max(glm::distance(frustum.getPosition(), bound.calcCenter()) - 0.5f * glm::length(bound.getDimensions()),
+                                  MIN_LOD_DISTANCE);
+        return 0.5f * (float)args->_viewport.w * frustum.getProjection()[1][1] / distance;
+    }
+
+}
 
 ModelMeshPartPayload::ModelMeshPartPayload(ModelPointer model, int meshIndex, int partIndex, int shapeIndex,
                                            const Transform& transform, const uint64_t& created) :
@@ -38,6 +57,10 @@ ModelMeshPartPayload::ModelMeshPartPayload(ModelPointer model, int meshIndex, in
     const Model::MeshState& state = model->getMeshState(_meshIndex);
 
     updateMeshPart(modelMesh, partIndex);
+    if (!modelMesh->getLODs().empty()) {
+        _lodLevel = state.lodLevel;
+        _meshLocalBound = AABox(model->getHFMModel().meshes.at(_meshIndex).meshExtents);
+    }
 
     bool useDualQuaternionSkinning = model->getUseDualQuaternionSkinning();
     if (useDualQuaternionSkinning) {
@@ -50,10 +73,19 @@ ModelMeshPartPayload::ModelMeshPartPayload(ModelPointer model, int meshIndex, in
 
     initCache(model, shapeIndex);
 
+    if (BlendshapeDeltas::ENABLED && _isBlendShaped) {
+        _blendshapeDeltas = BlendshapeDeltas::get(model->getGeometry()->getConstHFMModelPointer(), _meshIndex);
+    }
+
 #if defined(Q_OS_MAC) || defined(Q_OS_ANDROID)
     // On mac AMD, we specifically need to have a _meshBlendshapeBuffer bound when using a deformed mesh pipeline
     // it cannot be null otherwise we crash in the drawcall using a deformed pipeline with a skinned only (not blendshaped) mesh
-    if (_isBlendShaped) {
+    if (_blendshapeDeltas) {
+        _meshBlendshapeBuffer = _blendshapeDeltas->getBuffer();
+        std::vector<BlendshapeOffset> data(std::max(_blendshapeDeltas->getNumBlendshapes(), 1));
+        const auto coefficientBufferSize = data.size() * sizeof(BlendshapeOffset);
+        _meshBlendshapeCoefficientBuffer = std::make_shared<gpu::Buffer>(coefficientBufferSize, reinterpret_cast<const gpu::Byte*>(data.data()), coefficientBufferSize);
+    } else if (_isBlendShaped) {
         std::vector<BlendshapeOffset> data(_meshNumVertices);
         const auto blendShapeBufferSize = _meshNumVertices * sizeof(BlendshapeOffset);
         _meshBlendshapeBuffer = std::make_shared<gpu::Buffer>(blendShapeBufferSize, reinterpret_cast<const gpu::Byte*>(data.data()), blendShapeBufferSize);
@@ -87,6 +119,7 @@ void ModelMeshPartPayload::updateMeshPart(const std::shared_ptr<const graphics::
     if (_drawMesh) {
         auto vertexFormat = _drawMesh->getVertexFormat();
         _drawPart = _drawMesh->getPartBuffer().get<graphics::Mesh::Part>(partIndex);
+        _partIndex = partIndex;
         _localBound = _drawMesh->evalPartBound(partIndex);
     }
 }
@@ -179,12 +212,16 @@ void ModelMeshPartPayload::updateTransformForSkinnedMesh(const Transform& modelT
     _parentTransform = modelTransform;
 }
 
-void ModelMeshPartPayload::bindMesh(gpu::Batch& batch) {
-    batch.setIndexBuffer(gpu::UINT32, (_drawMesh->getIndexBuffer()._buffer), 0);
+void ModelMeshPartPayload::bindMesh(gpu::Batch& batch, int lodLevel) {
+    const auto& indexBuffer = lodLevel > 0 ? _drawMesh->getLODIndexBuffer() : _drawMesh->getIndexBuffer();
+    batch.setIndexBuffer(gpu::UINT32, indexBuffer._buffer, 0);
     batch.setInputFormat((_drawMesh->getVertexFormat()));
     if (_meshBlendshapeBuffer) {
         batch.setResourceBuffer(0, _meshBlendshapeBuffer);
     }
+    if (_meshBlendshapeCoefficientBuffer) {
+        batch.setResourceBuffer(1, _meshBlendshapeCoefficientBuffer);
+    }
     batch.setInputStream(0, _drawMesh->getVertexStream());
 }
 
@@ -195,8 +232,94 @@ void ModelMeshPartPayload::bindTransform(gpu::Batch& batch, const Transform& tra
     batch.setModelTransform(transform);
 }
 
-void ModelMeshPartPayload::drawCall(gpu::Batch& batch) const {
-    batch.drawIndexed(gpu::TRIANGLES, _drawPart._numIndices, _drawPart._startIndex);
+void ModelMeshPartPayload::drawCall(gpu::Batch& batch, int lodLevel) const {
+    const auto& drawPart = getDrawPart(lodLevel);
+    batch.drawIndexed(gpu::TRIANGLES, drawPart._numIndices, drawPart._startIndex);
+}
+
+const graphics::Mesh::Part& ModelMeshPartPayload::getDrawPart(int lodLevel) const {
+    if (lodLevel > 0) {
+        return _drawMesh->getLODs()[lodLevel - 1].parts[_partIndex];
+    }
+    return _drawPart;
+}
+
+bool ModelMeshPartPayload::canDrawInstanced(RenderArgs* args) const {
+    // the instances only differ by their transforms, so the parts with state of their own, the translucent ones which
+    // are sorted by depth, and the ones whose pipelines set up the items (like the fading ones) are drawn by themselves
+    return enableInstancing && !_isSkinned && !_isBlendShaped && !_shapeKey.hasOwnPipeline() && !_itemKey.isTransparent() &&
+        _drawMaterials.size() == 1 && args->_shapePipeline && !args->_shapePipeline->hasSetters();
+}
+
+void ModelMeshPartPayload::drawInstanced(RenderArgs* args, int lodLevel) {
+    gpu::Batch& batch = *(args->_batch);
+    const auto& pipeline = args->_shapePipeline;
+
+    // The meshes are shared by all the models of a ModelCache resource, so the instances are the parts of its models
+    // drawn with the same material and pipeline
+    std::string instanceName = "model_part_" + std::to_string(std::hash<const graphics::Mesh*>()(_drawMesh.get())) +
+        "_" + std::to_string(_partIndex) + "_" + std::to_string(lodLevel) +
+        "_" + std::to_string(std::hash<render::ShapePipelinePointer>()(pipeline)) +
+        "_" + std::to_string(std::hash<graphics::MaterialPointer>()(_drawMaterials.top().material));
+
+    // The call is made by the first part of the name, when the batch is finished.  The payloads are only released by
+    // the transactions of the next frame, so they are still there.
+    auto renderMode = args->_renderMode;
+    bool enableTexturing = args->_enableTexturing;
+    batch.setupNamedCalls(instanceName, [this, pipeline, lodLevel, renderMode, enableTexturing](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        batch.setPipeline(pipeline->pipeline);
+        bindMesh(batch, lodLevel);
+        RenderPipelines::bindMaterials(_drawMaterials, batch, renderMode, enableTexturing);
+
+        const auto& drawPart = getDrawPart(lodLevel);
+        batch.drawIndexedInstanced((gpu::uint32)data.count(), gpu::TRIANGLES, drawPart._numIndices, drawPart._startIndex);
+    });
+}
+
+int ModelMeshPartPayload::evalLODLevel(RenderArgs* args) const {
+    if (!_lodLevel || !_drawMesh) {
+        return 0;
+    }
+    const auto& lods = _drawMesh->getLODs();
+    int level = std::min(_lodLevel->load(), (int)lods.size());
+
+    // the other views draw the level of the main one
+    if (args->_renderMode != RenderArgs::RenderMode::DEFAULT_RENDER_MODE || !args->hasViewFrustum()) {
+        return level;
+    }
+
+    // all the parts of the mesh evaluate the same bound, so they switch together and don't crack apart
+    Transform meshTransform = _parentTransform.worldTransform(_localTransform);
+    AABox meshBound = _meshLocalBound;
+    meshBound.transform(meshTransform);
+    const auto& scale = meshTransform.getScale();
+    float pixelsPerUnit = std::max(scale.x, std::max(scale.y, scale.z)) * evalPixelsPerMeter(args, meshBound);
+
+    int desiredLevel = 0;
+    while (desiredLevel < (int)lods.size() && lods[desiredLevel].error * pixelsPerUnit <= lodErrorPixels) {
+        desiredLevel++;
+    }
+    if (desiredLevel > level) {
+        while (level < desiredLevel && lods[level].error * pixelsPerUnit <= lodErrorPixels * LOD_HYSTERESIS) {
+            level++;
+        }
+    } else {
+        level = desiredLevel;
+    }
+    _lodLevel->store(level);
+    return level;
+}
+
+void ModelMeshPartPayload::reportTextureScreenSize(RenderArgs* args, const Transform& modelTransform) {
+    AABox meshBound = _meshLocalBound;
+    meshBound.transform(modelTransform);
+    const auto& dimensions = meshBound.getDimensions();
+    float screenSize = std::max(dimensions.x, std::max(dimensions.y, dimensions.z)) * evalPixelsPerMeter(args, meshBound);
+    for (const auto& texture : _drawMaterials.getTextureTable()->getTextures()) {
+        if (texture) {
+            texture->reportScreenSize(screenSize);
+        }
+    }
 }
 
 void ModelMeshPartPayload::updateKey(const render::ItemKey& key) {
@@ -319,6 +442,9 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
 
     gpu::Batch& batch = *(args->_batch);
 
+    // the views can be recorded in parallel, so the level is passed along rather than kept
+    int lodLevel = evalLODLevel(args);
+
     Transform transform = _parentTransform;
     transform.setRotation(BillboardModeHelpers::getBillboardRotation(transform.getTranslation(), transform.getRotation(), _billboardMode,
         args->_renderMode == RenderArgs::RenderMode::SHADOW_RENDER_MODE ? BillboardModeHelpers::getPrimaryViewFrustumPosition() : args->getViewFrustum().getPosition()));
@@ -326,8 +452,19 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     Transform modelTransform = transform.worldTransform(_localTransform);
     bindTransform(batch, modelTransform, args->_renderMode);
 
+    if (args->_renderMode == RenderArgs::RenderMode::DEFAULT_RENDER_MODE && args->hasViewFrustum() && args->_enableTexturing) {
+        reportTextureScreenSize(args, modelTransform);
+    }
+
+    const int INDICES_PER_TRIANGLE = 3;
+    if (canDrawInstanced(args)) {
+        drawInstanced(args, lodLevel);
+        args->_details._trianglesRendered += getDrawPart(lodLevel)._numIndices / INDICES_PER_TRIANGLE;
+        return;
+    }
+
     //Bind the index buffer and vertex buffer and Blend shapes if needed
-    bindMesh(batch);
+    bindMesh(batch, lodLevel);
 
     // IF deformed pass the mesh key
     auto drawcallInfo = (uint16_t) (((_isBlendShaped && _meshBlendshapeBuffer && args->_enableBlendshape) << 0) | ((_isSkinned && args->_enableSkinning) << 1));
@@ -356,11 +493,10 @@ void ModelMeshPartPayload::render(RenderArgs* args) {
     // Draw!
     {
         PerformanceTimer perfTimer("batch.drawIndexed()");
-        drawCall(batch);
+        drawCall(batch, lodLevel);
     }
 
-    const int INDICES_PER_TRIANGLE = 3;
-    args->_details._trianglesRendered += _drawPart._numIndices / INDICES_PER_TRIANGLE;
+    args->_details._trianglesRendered += getDrawPart(lodLevel)._numIndices / INDICES_PER_TRIANGLE;
 }
 
 bool ModelMeshPartPayload::passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const {
@@ -377,11 +513,26 @@ bool ModelMeshPartPayload::passesZoneOcclusionTest(const std::unordered_set<QUui
     return true;
 }
 
+uint64_t ModelMeshPartPayload::getMaterialSortKey() const {
+    // the parts with the same top material mostly bind the same textures, whatever material is under it
+    if (_shapeKey.hasOwnPipeline() || _drawMaterials.empty()) {
+        return 0;
+    }
+    return (uint64_t)(uintptr_t)_drawMaterials.top().material.get();
+}
+
 void ModelMeshPartPayload::setBlendshapeBuffer(const std::unordered_map<int, gpu::BufferPointer>& blendshapeBuffers, const QVector<int>& blendedMeshSizes) {
-    if (_meshIndex < blendedMeshSizes.length() && blendedMeshSizes.at(_meshIndex) == _meshNumVertices) {
+    // With the blendshape deltas, the buffers hold the coefficients of the blendshapes rather than the vertex offsets
+    int blendedMeshSize = _blendshapeDeltas ? _blendshapeDeltas->getNumBlendshapes() : _meshNumVertices;
+    if (_meshIndex < blendedMeshSizes.length() && blendedMeshSizes.at(_meshIndex) == blendedMeshSize) {
         auto blendshapeBuffer = blendshapeBuffers.find(_meshIndex);
         if (blendshapeBuffer != blendshapeBuffers.end()) {
-            _meshBlendshapeBuffer = blendshapeBuffer->second;
+            if (_blendshapeDeltas) {
+                _meshBlendshapeBuffer = _blendshapeDeltas->getBuffer();
+                _meshBlendshapeCoefficientBuffer = blendshapeBuffer->second;
+            } else {
+                _meshBlendshapeBuffer = blendshapeBuffer->second;
+            }
             if (_isSkinned || (_isBlendShaped && _meshBlendshapeBuffer)) {
                 ShapeKey::Builder builder(_shapeKey);
                 builder.withDeformed();
@@ -426,4 +577,11 @@ template <> bool payloadPassesZoneOcclusionTest(const ModelMeshPartPayload::Poin
     }
     return false;
 }
+
+template <> uint64_t payloadGetMaterialSortKey(const ModelMeshPartPayload::Pointer& payload) {
+    if (payload) {
+        return payload->getMaterialSortKey();
+    }
+    return 0;
+}
 }
@@ -36,9 +36,15 @@ public:
     void updateTransformForSkinnedMesh(const Transform& modelTransform, const Model::MeshState& meshState, bool useDualQuaternionSkinning);
 
     // ModelMeshPartPayload functions to perform render
-    void bindMesh(gpu::Batch& batch);
+    void bindMesh(gpu::Batch& batch, int lodLevel = 0);
     virtual void bindTransform(gpu::Batch& batch, const Transform& transform, RenderArgs::RenderMode renderMode) const;
-    void drawCall(gpu::Batch& batch) const;
+    void drawCall(gpu::Batch& batch, int lodLevel = 0) const;
+
+    // The level of detail to draw in this view, switching once its error on screen is past the threshold
+    int evalLODLevel(RenderArgs* args) const;
+    // Tells the textures of the materials how large the mesh is drawn on screen, for the backend to give the finer mips of
+    // the textures drawn the largest priority
+    void reportTextureScreenSize(RenderArgs* args, const Transform& modelTransform);
 
     void updateKey(const render::ItemKey& key);
     void setShapeKey(bool invalidateShapeKey, PrimitiveMode primitiveMode, bool useDualQuaternionSkinning);
@@ -59,6 +65,7 @@ public:
     void setRenderWithZones(const QVector<QUuid>& renderWithZones) { _renderWithZones = renderWithZones; }
     void setBillboardMode(BillboardMode billboardMode) { _billboardMode = billboardMode; }
     bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const;
+    uint64_t getMaterialSortKey() const;
 
     void addMaterial(graphics::MaterialLayer material) { _drawMaterials.push(material); }
     void removeMaterial(graphics::MaterialPointer material) { _drawMaterials.remove(material); }
@@ -66,13 +73,23 @@ public:
     void setBlendshapeBuffer(const std::unordered_map<int, gpu::BufferPointer>& blendshapeBuffers, const QVector<int>& blendedMeshSizes);
 
     static bool enableMaterialProceduralShaders;
+    // the parts of the models that share their mesh and material are drawn as instances of each other
+    static bool enableInstancing;
+    // the error, in pixels, below which a coarser level of detail is drawn
+    static float lodErrorPixels;
 
 private:
     void initCache(const ModelPointer& model, int shapeID);
+    const graphics::Mesh::Part& getDrawPart(int lodLevel) const;
+    bool canDrawInstanced(RenderArgs* args) const;
+    void drawInstanced(RenderArgs* args, int lodLevel);
 
     int _meshIndex;
     std::shared_ptr<const graphics::Mesh> _drawMesh;
     graphics::Mesh::Part _drawPart;
+    int _partIndex { 0 };
+    std::shared_ptr<std::atomic<int>> _lodLevel;
+    graphics::Box _meshLocalBound;
     graphics::MultiMaterial _drawMaterials;
 
     gpu::BufferPointer _clusterBuffer;
@@ -80,6 +97,9 @@ private:
     ClusterBufferType _clusterBufferType { ClusterBufferType::Matrices };
 
     gpu::BufferPointer _meshBlendshapeBuffer;
+    // when the shaders apply the blendshapes, _meshBlendshapeBuffer is the deltas' buffer
+    BlendshapeDeltas::Pointer _blendshapeDeltas;
+    gpu::BufferPointer _meshBlendshapeCoefficientBuffer;
     int _meshNumVertices;
 
     render::ItemKey _itemKey { render::ItemKey::Builder::opaqueShape().build() };
@@ -107,6 +127,7 @@ namespace render {
     template <> const ShapeKey shapeGetShapeKey(const ModelMeshPartPayload::Pointer& payload);
     template <> void payloadRender(const ModelMeshPartPayload::Pointer& payload, RenderArgs* args);
     template <> bool payloadPassesZoneOcclusionTest(const ModelMeshPartPayload::Pointer& payload, const std::unordered_set<QUuid>& containingZones);
+    template <> uint64_t payloadGetMaterialSortKey(const ModelMeshPartPayload::Pointer& payload);
 }
 
 #endif // hifi_MeshPartPayload_h
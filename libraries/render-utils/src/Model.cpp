@@ -1525,15 +1525,58 @@ void Model::updateBlendshapes() {
     // post the blender if we're not currently waiting for one to finish
     auto modelBlender = DependencyManager::get<ModelBlender>();
     if (modelBlender->shouldComputeBlendshapes() && getHFMModel().hasBlendedMeshes() && _blendshapeCoefficients != _blendedBlendshapeCoefficients) {
-        _blendedBlendshapeCoefficients = _blendshapeCoefficients;
-        modelBlender->noteRequiresBlend(getThisPointer());
+        if (BlendshapeDeltas::ENABLED) {
+            // the shaders apply the blendshapes, only their coefficients are needed
+            if (updateBlendshapeCoefficients()) {
+                _blendedBlendshapeCoefficients = _blendshapeCoefficients;
+            }
+        } else {
+            _blendedBlendshapeCoefficients = _blendshapeCoefficients;
+            modelBlender->noteRequiresBlend(getThisPointer());
+        }
+    }
+}
+
+bool Model::updateBlendshapeCoefficients() {
+    if (!isLoaded() || !_modelBlendshapeOperator) {
+        return false;
+    }
+
+    const auto& hfmModel = getGeometry()->getConstHFMModelPointer();
+    if (_blendshapeDeltas.empty()) {
+        for (int i = 0; i < hfmModel->meshes.size(); i++) {
+            _blendshapeDeltas.push_back(BlendshapeDeltas::get(hfmModel, i));
+        }
     }
+
+    // Only the coefficients are sent, in place of the offsets the Blender would have computed from them
+    QVector<int> blendedMeshSizes;
+    blendedMeshSizes.reserve((int)_blendshapeDeltas.size());
+    int numCoefficients = 0;
+    for (const auto& deltas : _blendshapeDeltas) {
+        int numMeshCoefficients = deltas ? deltas->getNumBlendshapes() : 0;
+        blendedMeshSizes.push_back(numMeshCoefficients);
+        numCoefficients += numMeshCoefficients;
+    }
+
+    QVector<BlendshapeOffset> packedCoefficients(numCoefficients);
+    int offset = 0;
+    for (const auto& deltas : _blendshapeDeltas) {
+        if (deltas) {
+            deltas->packCoefficients(_blendshapeCoefficients, packedCoefficients.data() + offset);
+            offset += deltas->getNumBlendshapes();
+        }
+    }
+
+    _modelBlendshapeOperator(++_blendNumber, packedCoefficients, blendedMeshSizes, fetchRenderItemIDs());
+    return true;
 }
 
 void Model::deleteGeometry() {
     _meshStates.clear();
     _rig.destroyAnimGraph();
     _blendedBlendshapeCoefficients.clear();
+    _blendshapeDeltas.clear();
     _renderGeometry.reset();
 }
 
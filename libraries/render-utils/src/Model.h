@@ -17,6 +17,7 @@
 #include <QUrl>
 #include <QMutex>
 
+#include <atomic>
 #include <unordered_map>
 #include <unordered_set>
 #include <functional>
@@ -39,6 +40,7 @@
 #include "Rig.h"
 #include "PrimitiveMode.h"
 #include "BillboardMode.h"
+#include "BlendshapeDeltas.h"
 
 // Use dual quaternion skinning!
 // Must match define in Skinning.slh
@@ -337,6 +339,8 @@ public:
     public:
         std::vector<TransformDualQuaternion> clusterDualQuaternions;
         std::vector<glm::mat4> clusterMatrices;
+        // the level of detail the mesh is drawn at, shared by the render items of its parts so they switch together
+        std::shared_ptr<std::atomic<int>> lodLevel { std::make_shared<std::atomic<int>>(0) };
     };
 
     const MeshState& getMeshState(int index) { return _meshStates.at(index); }
@@ -437,12 +441,17 @@ protected:
 
     virtual void deleteGeometry();
 
+    // Sends the blendshape coefficients to the render items, for their shaders to apply them
+    bool updateBlendshapeCoefficients();
+
     QUrl _url;
 
     BlendShapeOperator _modelBlendshapeOperator { nullptr };
     QVector<float> _blendshapeCoefficients;
     QVector<float> _blendedBlendshapeCoefficients;
     int _blendNumber { 0 };
+    // the blendshapes of each mesh, when the shaders apply them
+    std::vector<BlendshapeDeltas::Pointer> _blendshapeDeltas;
 
     mutable QRecursiveMutex _mutex;
 
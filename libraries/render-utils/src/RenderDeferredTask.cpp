@@ -35,6 +35,7 @@
 #include "RenderCommonTask.h"
 #include "LightingModel.h"
 #include "StencilMaskPass.h"
+#include "FoveationPass.h"
 #include "DebugDeferredBuffer.h"
 #include "DeferredFramebuffer.h"
 #include "DeferredLightingEffect.h"
@@ -158,6 +159,9 @@ void RenderDeferredTask::build(JobModel& task, const render::Varying& input, ren
     // draw a stencil mask in hidden regions of the framebuffer.
     task.addJob<PrepareStencil>("PrepareStencil", scaledPrimaryFramebuffer);
 
+    // In HMDs, shade the periphery coarser up to the in front items
+    task.addJob<BeginFoveation>("BeginFoveation");
+
     // Render opaque objects in DeferredBuffer
     const auto opaqueInputs = DrawStateSortDeferred::Inputs(opaques, lightingModel, jitter).asVarying();
     task.addJob<DrawStateSortDeferred>("DrawOpaqueDeferred", opaqueInputs, shapePlumber);
@@ -216,6 +220,8 @@ void RenderDeferredTask::build(JobModel& task, const render::Varying& input, ren
     const auto outlineInputs = DrawHighlightTask::Inputs(items, deferredFramebuffer, lightingFramebuffer, deferredFrameTransform, jitter).asVarying();
     task.addJob<DrawHighlightTask>("DrawHighlight", outlineInputs);
 
+    task.addJob<EndFoveation>("EndFoveation");
+
     // Layered Over (in front)
     const auto inFrontOpaquesInputs = DrawLayered3D::Inputs(inFrontOpaque, lightingModel, hazeFrame, jitter).asVarying();
     const auto inFrontTransparentsInputs = DrawLayered3D::Inputs(inFrontTransparent, lightingModel, hazeFrame, jitter).asVarying();
@@ -379,7 +385,7 @@ void RenderDeferredTaskDebug::build(JobModel& task, const render::Varying& input
     {
 
         // Debugging Deferred buffer job
-        const auto debugFramebuffers = DebugDeferredBuffer::Inputs(deferredFramebuffer, linearDepthTarget, surfaceGeometryFramebuffer, ambientOcclusionFramebuffer, velocityBuffer, deferredFrameTransform, shadowFrame).asVarying();
+        const auto debugFramebuffers = DebugDeferredBuffer::Inputs(deferredFramebuffer, linearDepthTarget, surfaceGeometryFramebuffer, ambientOcclusionFramebuffer, velocityBuffer, deferredFrameTransform, shadowFrame, lightClusters).asVarying();
         task.addJob<DebugDeferredBuffer>("DebugDeferredBuffer", debugFramebuffers);
 
         const auto debugSubsurfaceScatteringInputs = DebugSubsurfaceScattering::Inputs(deferredFrameTransform, deferredFramebuffer, lightingModel,
@@ -533,9 +539,14 @@ void DrawStateSortDeferred::run(const RenderContextPointer& renderContext, const
 
     RenderArgs* args = renderContext->args;
 
-    gpu::doInBatch("DrawStateSortDeferred::run", args->_context, [&](gpu::Batch& batch) {
-        args->_batch = &batch;
+    // From the lighting model define a global shapeKey ORED with individiual keys
+    ShapeKey::Builder keyBuilder;
+    if (lightingModel->isWireframeEnabled()) {
+        keyBuilder.withWireframe();
+    }
+    ShapeKey globalKey = keyBuilder.build();
 
+    auto setupBatch = [&](gpu::Batch& batch) {
         // Setup camera, projection and viewport for all items
         batch.setViewportTransform(args->_viewport);
         batch.setStateScissorRect(args->_viewport);
@@ -552,24 +563,26 @@ void DrawStateSortDeferred::run(const RenderContextPointer& renderContext, const
         // Setup lighting model for all items;
         batch.setUniformBuffer(ru::Buffer::LightModel, lightingModel->getParametersBuffer());
         batch.setResourceTexture(ru::Texture::AmbientFresnel, lightingModel->getAmbientFresnelLUT());
-
-        // From the lighting model define a global shapeKey ORED with individiual keys
-        ShapeKey::Builder keyBuilder;
-        if (lightingModel->isWireframeEnabled()) {
-            keyBuilder.withWireframe();
-        }
-
-        ShapeKey globalKey = keyBuilder.build();
-        args->_globalShapeKey = globalKey._flags.to_ulong();
-
-        if (_stateSort) {
-            renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
-        } else {
-            renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
-        }
-        args->_batch = nullptr;
-        args->_globalShapeKey = 0;
-    });
+    };
+
+    args->_globalShapeKey = globalKey._flags.to_ulong();
+    if (_stateSort && _parallelRecording) {
+        renderStateSortShapesInParallel(renderContext, _shapePlumber, inItems, "DrawStateSortDeferred::run", setupBatch, _maxDrawn, globalKey,
+                                        _materialSort);
+    } else {
+        gpu::doInBatch("DrawStateSortDeferred::run", args->_context, [&](gpu::Batch& batch) {
+            args->_batch = &batch;
+            setupBatch(batch);
+
+            if (_stateSort) {
+                renderStateSortShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey, _materialSort);
+            } else {
+                renderShapes(renderContext, _shapePlumber, inItems, _maxDrawn, globalKey);
+            }
+            args->_batch = nullptr;
+        });
+    }
+    args->_globalShapeKey = 0;
 
     config->setNumDrawn((int)inItems.size());
 }
@@ -63,6 +63,8 @@ class DrawStateSortConfig : public render::Job::Config {
     Q_PROPERTY(int numDrawn READ getNumDrawn NOTIFY numDrawnChanged)
     Q_PROPERTY(int maxDrawn MEMBER maxDrawn NOTIFY dirty)
     Q_PROPERTY(bool stateSort MEMBER stateSort NOTIFY dirty)
+    Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
+    Q_PROPERTY(bool materialSort MEMBER materialSort NOTIFY dirty)
 public:
     int getNumDrawn() { return numDrawn; }
     void setNumDrawn(int num) {
@@ -72,6 +74,10 @@ public:
 
     int maxDrawn{ -1 };
     bool stateSort{ true };
+    // records the state sorted shapes into several batches at once
+    bool parallelRecording{ true };
+    // draws the shapes of each pipeline in the order of their materials rather than front to back
+    bool materialSort{ true };
 
 signals:
     void numDrawnChanged();
@@ -95,6 +101,8 @@ public:
     void configure(const Config& config) {
         _maxDrawn = config.maxDrawn;
         _stateSort = config.stateSort;
+        _parallelRecording = config.parallelRecording;
+        _materialSort = config.materialSort;
     }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
@@ -102,6 +110,8 @@ protected:
     render::ShapePlumberPointer _shapePlumber;
     int _maxDrawn;  // initialized by Config
     bool _stateSort;
+    bool _parallelRecording;
+    bool _materialSort;
 };
 
 class SetSeparateDeferredDepthBuffer {
@@ -12,6 +12,7 @@
 #include "RenderShadowTask.h"
 
 #include <gpu/Context.h>
+#include <shaders/Shaders.h>
 
 #include <ViewFrustum.h>
 
@@ -23,6 +24,7 @@
 #include "FramebufferCache.h"
 
 #include "RenderUtilsLogging.h"
+#include "render-utils/ShaderConstants.h"
 
 #include "RenderCommonTask.h"
 #include "AssembleLightingStageTask.h"
@@ -165,7 +167,7 @@ static void computeNearFar(const glm::vec3 sceneBoundVertices[8], const Plane sh
     }
 }
 
-static void adjustNearFar(const AABox& inShapeBounds, ViewFrustum& shadowFrustum) {
+static void adjustNearFar(const AABox& inShapeBounds, ViewFrustum& shadowFrustum, float snapSize) {
     if (!inShapeBounds.isNull()) {
         const Transform shadowView{ shadowFrustum.getView() };
         const Transform shadowViewInverse{ shadowView.getInverseMatrix() };
@@ -193,7 +195,15 @@ static void adjustNearFar(const AABox& inShapeBounds, ViewFrustum& shadowFrustum
         }
 
         const auto depthEpsilon = 0.1f;
-        auto projMatrix = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, near - depthEpsilon, far + depthEpsilon);
+        near -= depthEpsilon;
+        far += depthEpsilon;
+        if (snapSize > 0.0f) {
+            // Snap the range in a light space that doesn't move with the view, as the cascade bounds are
+            const auto originDepth = (glm::inverse(shadowFrustum.getOrientation()) * shadowFrustum.getPosition()).z;
+            near = glm::floor((near - originDepth) / snapSize) * snapSize + originDepth;
+            far = glm::ceil((far - originDepth) / snapSize) * snapSize + originDepth;
+        }
+        auto projMatrix = glm::ortho(-1.0f, 1.0f, -1.0f, 1.0f, near, far);
         auto shadowProjection = shadowFrustum.getProjection();
 
         shadowProjection[2][2] = projMatrix[2][2];
@@ -227,12 +237,199 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
 
     // Adjust the frustum near and far depths based on the rendered items bounding box to have
     // the minimal Z range.
-    adjustNearFar(inShapeBounds, adjustedShadowFrustum);
+    adjustNearFar(inShapeBounds, adjustedShadowFrustum, cascade.getSnapSize());
     // Reapply the frustum as it has been adjusted
     shadow->setCascadeFrustum(_cascadeIndex, adjustedShadowFrustum);
     args->popViewFrustum();
     args->pushViewFrustum(adjustedShadowFrustum);
 
+    if (cascade.getSnapSize() <= 0.0f) {
+        // The cascade follows every move of the view, a cache would never be reused
+        _casterStates.clear();
+        _cacheFramebuffer.reset();
+        _isCacheFilled = false;
+        drawCasters(renderContext, inShapes, fbo, true);
+        return;
+    }
+
+    ++_frame;
+    ShapeBounds staticShapes;
+    ShapeBounds dynamicShapes;
+    sortCasters(inShapes, staticShapes, dynamicShapes);
+    size_t staticCasterCount = 0;
+    for (const auto& items : staticShapes) {
+        staticCasterCount += items.second.size();
+    }
+
+    if (isCacheValid(args->getViewFrustum(), fbo, staticCasterCount)) {
+        args->_details.edit(RenderDetails::SHADOW)._cached += (int)staticCasterCount;
+    } else {
+        if (!_cacheFramebuffer || _cacheFramebuffer->getSize() != fbo->getSize()) {
+            auto depthFormat = fbo->getDepthStencilBufferFormat();
+            auto cacheTexture = gpu::Texture::createRenderBuffer(depthFormat, fbo->getWidth(), fbo->getHeight());
+            std::string name = "Shadowmap Cache ";
+            name += '0' + _cascadeIndex;
+            _cacheFramebuffer = gpu::FramebufferPointer(gpu::Framebuffer::create(name));
+            _cacheFramebuffer->setDepthBuffer(cacheTexture, depthFormat);
+        }
+        drawCasters(renderContext, staticShapes, _cacheFramebuffer, true);
+
+        const auto& shadowFrustum = args->getViewFrustum();
+        _isCacheFilled = true;
+        _cacheOrientation = shadowFrustum.getOrientation();
+        _cacheNearCorner = shadowFrustum.getNearBottomLeft();
+        _cacheFarCorner = shadowFrustum.getFarTopRight();
+        _cacheStaticCastersDigest = _staticCastersDigest;
+        _cacheStaticCasterCount = staticCasterCount;
+    }
+
+    copyCache(renderContext, fbo);
+    drawCasters(renderContext, dynamicShapes, fbo, false);
+}
+
+// The casters that moved within these many frames are drawn every frame instead of being cached
+static const uint32_t SHADOW_CACHE_SETTLE_FRAMES = 30;
+// The casters out of the cascade for these many frames are forgotten
+static const uint32_t SHADOW_CACHE_FORGET_FRAMES = 120;
+
+static size_t hashCasterID(ItemID id) {
+    size_t hash = id;
+    hash ^= hash >> 16;
+    hash *= 0x45d9f3b;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+void RenderShadowMap::sortCasters(const ShapeBounds& inShapes, ShapeBounds& staticShapes, ShapeBounds& dynamicShapes) {
+    size_t digest = 0;
+    for (const auto& items : inShapes) {
+        const auto& key = items.first;
+        // Skinned and fading casters change from frame to frame, and the ones with their own pipeline may be procedural
+        const bool isDynamicShape = key.isDeformed() || key.isFaded() || key.hasOwnPipeline();
+        ItemBounds* staticItems = nullptr;
+        ItemBounds* dynamicItems = nullptr;
+
+        for (const auto& item : items.second) {
+            auto stateItr = _casterStates.find(item.id);
+            if (stateItr == _casterStates.end()) {
+                // A caster coming into the cascade is as good as static until it moves
+                CasterState state;
+                state.bound = item.bound;
+                state.lastMovedFrame = _frame - SHADOW_CACHE_SETTLE_FRAMES;
+                stateItr = _casterStates.emplace(item.id, state).first;
+            } else if (!(stateItr->second.bound == item.bound)) {
+                stateItr->second.bound = item.bound;
+                stateItr->second.lastMovedFrame = _frame;
+            }
+            auto& state = stateItr->second;
+            state.lastSeenFrame = _frame;
+
+            if (isDynamicShape || _frame - state.lastMovedFrame < SHADOW_CACHE_SETTLE_FRAMES) {
+                if (!dynamicItems) {
+                    dynamicItems = &dynamicShapes[key];
+                }
+                dynamicItems->emplace_back(item);
+            } else {
+                if (!staticItems) {
+                    staticItems = &staticShapes[key];
+                }
+                staticItems->emplace_back(item);
+                // Order independent, the casters come sorted by their distance to the view
+                digest += hashCasterID(item.id);
+            }
+        }
+    }
+    _staticCastersDigest = digest;
+
+    if (_frame % SHADOW_CACHE_FORGET_FRAMES == 0) {
+        for (auto itr = _casterStates.begin(); itr != _casterStates.end();) {
+            if (_frame - itr->second.lastSeenFrame > SHADOW_CACHE_FORGET_FRAMES) {
+                itr = _casterStates.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+    }
+}
+
+bool RenderShadowMap::isCacheValid(const ViewFrustum& shadowFrustum, const gpu::FramebufferPointer& fbo, size_t staticCasterCount) const {
+    if (!_isCacheFilled || _cacheFramebuffer->getSize() != fbo->getSize()) {
+        return false;
+    }
+    if (staticCasterCount != _cacheStaticCasterCount || _staticCastersDigest != _cacheStaticCastersDigest) {
+        return false;
+    }
+    if (shadowFrustum.getOrientation() != _cacheOrientation) {
+        return false;
+    }
+    // The frustum moves with the view but its bounds stay on the same light space grid, give or take float precision
+    const auto tolerance = glm::vec3(0.1f * glm::max(shadowFrustum.getWidth(), shadowFrustum.getHeight()) / fbo->getWidth());
+    return glm::all(glm::lessThanEqual(glm::abs(shadowFrustum.getNearBottomLeft() - _cacheNearCorner), tolerance)) &&
+        glm::all(glm::lessThanEqual(glm::abs(shadowFrustum.getFarTopRight() - _cacheFarCorner), tolerance));
+}
+
+void RenderShadowMap::copyCache(const render::RenderContextPointer& renderContext, const gpu::FramebufferPointer& fbo) {
+    if (!_cacheCopyPipeline) {
+        auto state = std::make_shared<gpu::State>();
+        state->setDepthTest(true, true, gpu::ALWAYS);
+        state->setColorWriteMask(false, false, false, false);
+        _cacheCopyPipeline = gpu::Pipeline::create(gpu::Shader::createProgram(shader::render_utils::program::shadowCacheCopy), state);
+    }
+
+    gpu::doInBatch("RenderShadowMap::copyCache", renderContext->args->_context, [&](gpu::Batch& batch) {
+        batch.enableStereo(false);
+
+        glm::ivec4 viewport{0, 0, fbo->getWidth(), fbo->getHeight()};
+        batch.setViewportTransform(viewport);
+        batch.setStateScissorRect(viewport);
+        batch.setFramebuffer(fbo);
+
+        batch.setPipeline(_cacheCopyPipeline);
+        batch.setResourceTexture(render_utils::slot::texture::ShadowCache, _cacheFramebuffer->getDepthStencilBuffer());
+        batch.draw(gpu::TRIANGLE_STRIP, 4);
+        batch.setResourceTexture(render_utils::slot::texture::ShadowCache, nullptr);
+    });
+}
+
+void RenderShadowMap::drawCasters(const render::RenderContextPointer& renderContext, const ShapeBounds& inShapes,
+                                  const gpu::FramebufferPointer& fbo, bool clear) {
+    RenderArgs* args = renderContext->args;
+
+    if (_parallelRecording) {
+        glm::mat4 projMat;
+        Transform viewMat;
+        args->getViewFrustum().evalProjectionMatrix(projMat);
+        args->getViewFrustum().evalViewTransform(viewMat);
+
+        auto setupBatch = [&](gpu::Batch& batch) {
+            batch.enableStereo(false);
+
+            glm::ivec4 viewport{0, 0, fbo->getWidth(), fbo->getHeight()};
+            batch.setViewportTransform(viewport);
+            batch.setStateScissorRect(viewport);
+            batch.setFramebuffer(fbo);
+
+            batch.setProjectionTransform(projMat);
+            batch.setViewTransform(viewMat, false);
+        };
+
+        if (clear) {
+            gpu::doInBatch("RenderShadowMap::run", args->_context, [&](gpu::Batch& batch) {
+                setupBatch(batch);
+                batch.clearDepthFramebuffer(1.0, false);
+            });
+        }
+
+        render::ItemBounds shapes;
+        for (const auto& items : inShapes) {
+            shapes.insert(shapes.end(), items.second.begin(), items.second.end());
+        }
+        if (!shapes.empty()) {
+            renderStateSortShapesInParallel(renderContext, _shapePlumber, shapes, "RenderShadowMap::run", setupBatch);
+        }
+        return;
+    }
+
     gpu::doInBatch("RenderShadowMap::run", args->_context, [&](gpu::Batch& batch) {
         args->_batch = &batch;
         batch.enableStereo(false);
@@ -242,9 +439,11 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
         batch.setStateScissorRect(viewport);
 
         batch.setFramebuffer(fbo);
-        batch.clearDepthFramebuffer(1.0, false);
+        if (clear) {
+            batch.clearDepthFramebuffer(1.0, false);
+        }
 
-        if (!inShapeBounds.isNull()) {
+        if (!inShapes.empty()) {
             glm::mat4 projMat;
             Transform viewMat;
             args->getViewFrustum().evalProjectionMatrix(projMat);
@@ -311,6 +510,7 @@ void RenderShadowMap::run(const render::RenderContextPointer& renderContext, con
     });
 }
 
+
 RenderShadowSetup::RenderShadowSetup() :
     _cameraFrustum{ std::make_shared<ViewFrustum>() },
     _coarseShadowFrustum{ std::make_shared<ViewFrustum>() } {
@@ -328,6 +528,7 @@ void RenderShadowSetup::configure(const Config& config) {
     slopeBias3 = config.slopeBias3;
     biasInput = config.biasInput;
     maxDistance = config.maxDistance;
+    cacheStaticCasters = config.cacheStaticCasters;
 }
 
 void RenderShadowSetup::calculateBiases(float biasInput) {
@@ -396,7 +597,8 @@ void RenderShadowSetup::run(const render::RenderContextPointer& renderContext, c
 
     // Adjust each cascade frustum
     for (unsigned int cascadeIndex = 0; cascadeIndex < _globalShadowObject->getCascadeCount(); ++cascadeIndex) {
-        _globalShadowObject->setKeylightCascadeFrustum(cascadeIndex, args->getViewFrustum(), SHADOW_FRUSTUM_NEAR, SHADOW_FRUSTUM_FAR);
+        _globalShadowObject->setKeylightCascadeFrustum(cascadeIndex, args->getViewFrustum(), SHADOW_FRUSTUM_NEAR, SHADOW_FRUSTUM_FAR,
+                                                       cacheStaticCasters);
     }
 
     calculateBiases(biasInput > 0.0f ? biasInput : currentKeyLight->getShadowBias());
@@ -594,7 +796,7 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
             if (antiFrustum == nullptr) {
                 for (auto& item : inItems.second) {
                     if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
+                        const auto shapeKey = scene->getItemKey(item.id);
                         if (castersFilter.test(shapeKey)) {
                             outItems->second.emplace_back(item);
                             outBounds += item.bound;
@@ -609,7 +811,7 @@ void CullShadowBounds::run(const render::RenderContextPointer& renderContext, co
             } else {
                 for (auto& item : inItems.second) {
                     if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) && test.antiFrustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
+                        const auto shapeKey = scene->getItemKey(item.id);
                         if (castersFilter.test(shapeKey)) {
                             outItems->second.emplace_back(item);
                             outBounds += item.bound;
@@ -12,6 +12,8 @@
 #ifndef hifi_RenderShadowTask_h
 #define hifi_RenderShadowTask_h
 
+#include <unordered_map>
+
 #include <gpu/Framebuffer.h>
 #include <gpu/Pipeline.h>
 
@@ -24,17 +26,59 @@
 
 class ViewFrustum;
 
+class RenderShadowMapConfig : public render::Job::Config {
+    Q_OBJECT
+    Q_PROPERTY(bool parallelRecording MEMBER parallelRecording NOTIFY dirty)
+public:
+    // records the shapes into several batches at once
+    bool parallelRecording{ true };
+
+signals:
+    void dirty();
+};
+
 class RenderShadowMap {
 public:
     using Inputs = render::VaryingSet3<render::ShapeBounds, AABox, LightStage::ShadowFramePointer>;
-    using JobModel = render::Job::ModelI<RenderShadowMap, Inputs>;
+    using Config = RenderShadowMapConfig;
+    using JobModel = render::Job::ModelI<RenderShadowMap, Inputs, Config>;
 
     RenderShadowMap(render::ShapePlumberPointer shapePlumber, unsigned int cascadeIndex) : _shapePlumber{ shapePlumber }, _cascadeIndex{ cascadeIndex } {}
+    void configure(const Config& config) { _parallelRecording = config.parallelRecording; }
     void run(const render::RenderContextPointer& renderContext, const Inputs& inputs);
 
 protected:
+    // The casters that haven't moved for a while and draw the same every frame go in a depth cache, drawn again only
+    // when the cascade or the set of these casters changes. Each frame the cache is copied into the cascade and the
+    // other casters are drawn over it.
+    struct CasterState {
+        AABox bound;
+        uint32_t lastMovedFrame { 0 };
+        uint32_t lastSeenFrame { 0 };
+    };
+
+    void sortCasters(const render::ShapeBounds& inShapes, render::ShapeBounds& staticShapes, render::ShapeBounds& dynamicShapes);
+    bool isCacheValid(const ViewFrustum& shadowFrustum, const gpu::FramebufferPointer& fbo, size_t staticCasterCount) const;
+    void drawCasters(const render::RenderContextPointer& renderContext, const render::ShapeBounds& inShapes,
+                     const gpu::FramebufferPointer& fbo, bool clear);
+    void copyCache(const render::RenderContextPointer& renderContext, const gpu::FramebufferPointer& fbo);
+
     render::ShapePlumberPointer _shapePlumber;
     unsigned int _cascadeIndex;
+    bool _parallelRecording { true };
+
+    uint32_t _frame { 0 };
+    std::unordered_map<render::ItemID, CasterState> _casterStates;
+    size_t _staticCastersDigest { 0 };
+
+    gpu::FramebufferPointer _cacheFramebuffer;
+    gpu::PipelinePointer _cacheCopyPipeline;
+    bool _isCacheFilled { false };
+    glm::quat _cacheOrientation;
+    glm::vec3 _cacheNearCorner;
+    glm::vec3 _cacheFarCorner;
+    size_t _cacheStaticCastersDigest { 0 };
+    size_t _cacheStaticCasterCount { 0 };
 };
 
 //class RenderShadowTaskConfig : public render::Task::Config::Persistent {
@@ -87,6 +131,7 @@ class RenderShadowSetupConfig : public render::Job::Config {
     Q_PROPERTY(float slopeBias3 MEMBER slopeBias3 NOTIFY dirty)
     Q_PROPERTY(float biasInput MEMBER biasInput NOTIFY dirty)
     Q_PROPERTY(float maxDistance MEMBER maxDistance NOTIFY dirty)
+    Q_PROPERTY(bool cacheStaticCasters MEMBER cacheStaticCasters NOTIFY dirty)
 
 public:
     // Set to > 0 to experiment with these values
@@ -100,6 +145,8 @@ public:
     float slopeBias3 { 0.0f };
     float biasInput { 0.0f };
     float maxDistance { 0.0f };
+    // keeps the cascades stable and caches the casters that don't move
+    bool cacheStaticCasters { true };
 
 signals:
     void dirty();
@@ -138,6 +185,7 @@ private:
     float slopeBias3;
     float biasInput;
     float maxDistance;
+    bool cacheStaticCasters;
 
     void setConstantBias(int cascadeIndex, float value);
     void setSlopeBias(int cascadeIndex, float value);
@@ -127,6 +127,9 @@
 #define RENDER_UTILS_UNIFORM_TEXT_COLOR 0
 #define RENDER_UTILS_UNIFORM_TEXT_OUTLINE 1
 
+// Shadow cache
+#define RENDER_UTILS_TEXTURE_SHADOW_CACHE 0
+
 // Debugging 
 #define RENDER_UTILS_BUFFER_DEBUG_SKYBOX 5
 #define RENDER_UTILS_DEBUG_TEXTURE0 11
@@ -202,6 +205,7 @@ enum Texture {
     ToneMappingColor = RENDER_UTILS_TEXTURE_TM_COLOR,
     TextFont = RENDER_UTILS_TEXTURE_TEXT_FONT,
     AmbientFresnel = RENDER_UTILS_TEXTURE_AMBIENT_FRESNEL,
+    ShadowCache = RENDER_UTILS_TEXTURE_SHADOW_CACHE,
     DebugTexture0 = RENDER_UTILS_DEBUG_TEXTURE0,
 };
 } // namespace texture
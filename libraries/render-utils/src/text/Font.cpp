@@ -20,7 +20,9 @@
 static std::mutex fontMutex;
 
 std::map<std::tuple<bool, bool, bool>, gpu::PipelinePointer> Font::_pipelines;
+std::map<std::tuple<bool, bool>, gpu::PipelinePointer> Font::_batchedPipelines;
 gpu::Stream::FormatPointer Font::_format;
+gpu::Stream::FormatPointer Font::_batchedFormat;
 
 struct TextureVertex {
     glm::vec2 pos;
@@ -33,27 +35,44 @@ struct TextureVertex {
 static const int NUMBER_OF_INDICES_PER_QUAD = 6;  // 1 quad = 2 triangles
 static const int VERTICES_PER_QUAD = 4;           // 1 quad = 4 vertices (must match value in sdf_text3D.slv)
 const float DOUBLE_MAX_OFFSET_PIXELS = 20.0f;     // must match value in sdf_text3D.slh
+static const float SHADOW_DEPTH_OFFSET = 0.001f;  // each glyph's offset in front of the one before it, as in sdf_text3D.slv
+
+static const uint8_t INSTANCE_GLYPH_BUFFER = 0;
+
+static Font::GlyphInstance layoutGlyph(const Glyph& glyph, const glm::vec2& offset, float scale, bool enlargeForShadows) {
+    glm::vec2 min = offset + glm::vec2(glyph.offset.x, glyph.offset.y - glyph.size.y);
+    glm::vec2 size = glyph.size;
+    glm::vec2 texMin = glyph.texOffset;
+    glm::vec2 texSize = glyph.texSize;
+
+    // We need the pre-adjustment bounds for clamping
+    glm::vec4 bounds = glm::vec4(texMin, texSize);
+    if (enlargeForShadows) {
+        glm::vec2 imageSize = glyph.size / glyph.texSize;
+        glm::vec2 sizeDelta = 0.5f * DOUBLE_MAX_OFFSET_PIXELS * scale * imageSize;
+        glm::vec2 oldSize = size;
+        size += sizeDelta;
+        min.y -= sizeDelta.y;
+
+        texSize = texSize * (size / oldSize);
+    }
+
+    Font::GlyphInstance instance;
+    instance.quad = glm::vec4(min, size);
+    instance.texCoords = glm::vec4(texMin, texSize);
+    instance.bounds = bounds;
+    return instance;
+}
 
 struct QuadBuilder {
     TextureVertex vertices[VERTICES_PER_QUAD];
 
-    QuadBuilder(const Glyph& glyph, const glm::vec2& offset, float scale, bool enlargeForShadows) {
-        glm::vec2 min = offset + glm::vec2(glyph.offset.x, glyph.offset.y - glyph.size.y);
-        glm::vec2 size = glyph.size;
-        glm::vec2 texMin = glyph.texOffset;
-        glm::vec2 texSize = glyph.texSize;
-
-        // We need the pre-adjustment bounds for clamping
-        glm::vec4 bounds = glm::vec4(texMin, texSize);
-        if (enlargeForShadows) {
-            glm::vec2 imageSize = glyph.size / glyph.texSize;
-            glm::vec2 sizeDelta = 0.5f * DOUBLE_MAX_OFFSET_PIXELS * scale * imageSize;
-            glm::vec2 oldSize = size;
-            size += sizeDelta;
-            min.y -= sizeDelta.y;
-
-            texSize = texSize * (size / oldSize);
-        }
+    QuadBuilder(const Font::GlyphInstance& glyph) {
+        glm::vec2 min = glm::vec2(glyph.quad);
+        glm::vec2 size = glm::vec2(glyph.quad.z, glyph.quad.w);
+        glm::vec2 texMin = glm::vec2(glyph.texCoords);
+        glm::vec2 texSize = glm::vec2(glyph.texCoords.z, glyph.texCoords.w);
+        const glm::vec4& bounds = glyph.bounds;
 
         // min = bottomLeft
         vertices[0] = TextureVertex(min,
@@ -287,6 +306,21 @@ void Font::setupGPU() {
             _pipelines[std::make_tuple(std::get<0>(key), std::get<1>(key), std::get<2>(key))] = gpu::Pipeline::create(gpu::Shader::createProgram(std::get<3>(key)), state);
         }
 
+        static const std::vector<std::tuple<bool, bool, uint32_t>> batchedKeys = {
+            std::make_tuple(false, false, sdf_text3D_batched), std::make_tuple(true, false, sdf_text3D_batched_unlit),
+            std::make_tuple(false, true, sdf_text3D_batched_forward), std::make_tuple(true, true, sdf_text3D_batched_unlit_forward)
+        };
+        for (auto& key : batchedKeys) {
+            auto state = std::make_shared<gpu::State>();
+            state->setCullMode(gpu::State::CULL_BACK);
+            state->setDepthTest(true, true, gpu::LESS_EQUAL);
+            state->setBlendFunction(false,
+                gpu::State::SRC_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::INV_SRC_ALPHA,
+                gpu::State::FACTOR_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::ONE);
+            PrepareStencil::testMaskDrawShape(*state);
+            _batchedPipelines[std::make_tuple(std::get<0>(key), std::get<1>(key))] = gpu::Pipeline::create(gpu::Shader::createProgram(std::get<2>(key)), state);
+        }
+
         // Sanity checks
         static const int TEX_COORD_OFFSET = offsetof(TextureVertex, tex);
         static const int TEX_BOUNDS_OFFSET = offsetof(TextureVertex, bounds);
@@ -299,29 +333,44 @@ void Font::setupGPU() {
         _format->setAttribute(gpu::Stream::POSITION, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::XYZ), 0);
         _format->setAttribute(gpu::Stream::TEXCOORD, 0, gpu::Element(gpu::VEC2, gpu::FLOAT, gpu::UV), TEX_COORD_OFFSET);
         _format->setAttribute(gpu::Stream::TEXCOORD1, 0, gpu::Element(gpu::VEC4, gpu::FLOAT, gpu::XYZW), TEX_BOUNDS_OFFSET);
+
+        // The batched glyphs have no vertices, just one instance each (see sdf_text3D_batched.slv)
+        static const gpu::Element INSTANCE_ELEMENT = gpu::Element(gpu::VEC4, gpu::FLOAT, gpu::XYZW);
+        _batchedFormat = std::make_shared<gpu::Stream::Format>();
+        _batchedFormat->setAttribute(gpu::Stream::POSITION, 0, INSTANCE_ELEMENT, offsetof(GlyphInstance, quad), gpu::Stream::PER_INSTANCE);
+        _batchedFormat->setAttribute(gpu::Stream::TEXCOORD0, 0, INSTANCE_ELEMENT, offsetof(GlyphInstance, texCoords), gpu::Stream::PER_INSTANCE);
+        _batchedFormat->setAttribute(gpu::Stream::TEXCOORD1, 0, INSTANCE_ELEMENT, offsetof(GlyphInstance, bounds), gpu::Stream::PER_INSTANCE);
+        _batchedFormat->setAttribute(gpu::Stream::COLOR, 0, gpu::Element(gpu::VEC4, gpu::FLOAT, gpu::RGBA),
+                                     offsetof(GlyphInstance, color), gpu::Stream::PER_INSTANCE);
+        _batchedFormat->setAttribute(gpu::Stream::TEXCOORD2, 0, INSTANCE_ELEMENT, offsetof(GlyphInstance, effectColorAndThickness),
+                                     gpu::Stream::PER_INSTANCE);
+        _batchedFormat->setAttribute(gpu::Stream::TEXCOORD3, 0, INSTANCE_ELEMENT, offsetof(GlyphInstance, effectAndDepthOffset),
+                                     gpu::Stream::PER_INSTANCE);
+        assert(_batchedFormat->getChannels().at(0)._stride == sizeof(GlyphInstance));
     }
 }
 
-inline QuadBuilder adjustedQuadBuilderForAlignmentMode(const Glyph& glyph, glm::vec2 advance, float scale, float enlargeForShadows,
-                                                TextAlignment alignment, float rightSpacing) {
+inline Font::GlyphInstance adjustedGlyphForAlignmentMode(const Glyph& glyph, glm::vec2 advance, float scale, float enlargeForShadows,
+                                                         TextAlignment alignment, float rightSpacing) {
     if (alignment == TextAlignment::RIGHT) {
         advance.x += rightSpacing;
     } else if (alignment == TextAlignment::CENTER) {
         advance.x += 0.5f * rightSpacing;
     }
-    return QuadBuilder(glyph, advance, scale, enlargeForShadows);
+    return layoutGlyph(glyph, advance, scale, enlargeForShadows);
 }
 
 void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm::vec2& origin, const glm::vec2& bounds, float scale, bool enlargeForShadows,
                          TextAlignment alignment) {
-    drawInfo.verticesBuffer = std::make_shared<gpu::Buffer>();
-    drawInfo.indicesBuffer = std::make_shared<gpu::Buffer>();
-    drawInfo.indexCount = 0;
-    int numVertices = 0;
+    drawInfo.glyphs.clear();
+    drawInfo.buffersStale = true;
+    drawInfo.glyphParamsStale = true;
 
     drawInfo.string = str;
     drawInfo.bounds = bounds;
     drawInfo.origin = origin;
+    drawInfo.alignment = alignment;
+    drawInfo.scale = scale;
 
     float enlargedBoundsX = bounds.x - 0.5f * DOUBLE_MAX_OFFSET_PIXELS * float(enlargeForShadows);
     float rightEdge = origin.x + enlargedBoundsX;
@@ -371,15 +420,15 @@ void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm
         }
     }
 
-    std::vector<QuadBuilder> quadBuilders;
-    quadBuilders.reserve(glyphsAndCorners.size());
+    std::vector<GlyphInstance> alignedGlyphs;
+    alignedGlyphs.reserve(glyphsAndCorners.size());
     {
         int i = glyphsAndCorners.size() - 1;
         while (i >= 0) {
             auto nextGlyphAndCorner = glyphsAndCorners[i];
             float rightSpacing = rightEdge - (nextGlyphAndCorner.second.x + nextGlyphAndCorner.first.d);
-            quadBuilders.push_back(adjustedQuadBuilderForAlignmentMode(nextGlyphAndCorner.first, nextGlyphAndCorner.second, scale, enlargeForShadows,
-                                                                       alignment, rightSpacing));
+            alignedGlyphs.push_back(adjustedGlyphForAlignmentMode(nextGlyphAndCorner.first, nextGlyphAndCorner.second, scale, enlargeForShadows,
+                                                                  alignment, rightSpacing));
             i--;
             while (i >= 0) {
                 auto prevGlyphAndCorner = glyphsAndCorners[i];
@@ -389,8 +438,8 @@ void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm
                     break;
                 }
 
-                quadBuilders.push_back(adjustedQuadBuilderForAlignmentMode(prevGlyphAndCorner.first, prevGlyphAndCorner.second, scale, enlargeForShadows,
-                                                                           alignment, rightSpacing));
+                alignedGlyphs.push_back(adjustedGlyphForAlignmentMode(prevGlyphAndCorner.first, prevGlyphAndCorner.second, scale, enlargeForShadows,
+                                                                      alignment, rightSpacing));
 
                 nextGlyphAndCorner = prevGlyphAndCorner;
                 i--;
@@ -398,10 +447,25 @@ void Font::buildVertices(Font::DrawInfo& drawInfo, const QString& str, const glm
         }
     }
 
-    // The quadBuilders is backwards now because we looped over the glyphs backwards to adjust their alignment
-    for (int i = quadBuilders.size() - 1; i >= 0; i--) {
+    // The alignedGlyphs are backwards now because we looped over the glyphs backwards to adjust their alignment
+    drawInfo.glyphs.assign(alignedGlyphs.rbegin(), alignedGlyphs.rend());
+    if (enlargeForShadows) {
+        for (size_t i = 0; i < drawInfo.glyphs.size(); i++) {
+            drawInfo.glyphs[i].effectAndDepthOffset.y = (float)i * SHADOW_DEPTH_OFFSET;
+        }
+    }
+}
+
+void Font::buildBuffers(Font::DrawInfo& drawInfo) {
+    drawInfo.verticesBuffer = std::make_shared<gpu::Buffer>();
+    drawInfo.indicesBuffer = std::make_shared<gpu::Buffer>();
+    drawInfo.indexCount = 0;
+    drawInfo.buffersStale = false;
+    int numVertices = 0;
+
+    for (const auto& glyph : drawInfo.glyphs) {
         quint16 verticesOffset = numVertices;
-        drawInfo.verticesBuffer->append(quadBuilders[i]);
+        drawInfo.verticesBuffer->append(QuadBuilder(glyph));
         numVertices += VERTICES_PER_QUAD;
 
         // Sam's recommended triangle slices
@@ -444,11 +508,9 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
     const int SHADOW_EFFECT = (int)TextEffect::SHADOW_EFFECT;
 
     // If we're switching to or from shadow effect mode, we need to rebuild the vertices
-    if (str != drawInfo.string || bounds != drawInfo.bounds || origin != drawInfo.origin || alignment != _alignment ||
+    if (str != drawInfo.string || bounds != drawInfo.bounds || origin != drawInfo.origin || alignment != drawInfo.alignment ||
             (drawInfo.params.effect != textEffect && (textEffect == SHADOW_EFFECT || drawInfo.params.effect == SHADOW_EFFECT)) ||
-            (textEffect == SHADOW_EFFECT && scale != _scale)) {
-        _scale = scale;
-        _alignment = alignment;
+            (textEffect == SHADOW_EFFECT && scale != drawInfo.scale)) {
         buildVertices(drawInfo, str, origin, bounds, scale, textEffect == SHADOW_EFFECT, alignment);
     }
 
@@ -460,6 +522,7 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
         drawInfo.params.effectColor = effectColor;
         drawInfo.params.effectThickness = effectThickness;
         drawInfo.params.effect = textEffect;
+        drawInfo.glyphParamsStale = true;
 
         // need the gamma corrected color here
         DrawParams gpuDrawParams;
@@ -473,6 +536,20 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
         drawInfo.paramsBuffer->setSubData(0, sizeof(DrawParams), (const gpu::Byte*)&gpuDrawParams);
     }
 
+    if (drawInfo.glyphs.empty()) {
+        return;
+    }
+
+    // Translucent text is sorted with the rest of the translucent items, so it can't wait for the end of the batch
+    if (color.a >= 1.0f) {
+        drawBatched(batch, drawInfo, unlit, forward);
+        return;
+    }
+
+    if (drawInfo.buffersStale) {
+        buildBuffers(drawInfo);
+    }
+
     batch.setPipeline(_pipelines[std::make_tuple(color.a < 1.0f, unlit, forward)]);
     batch.setInputFormat(_format);
     batch.setInputBuffer(0, drawInfo.verticesBuffer, 0, _format->getChannels().at(0)._stride);
@@ -481,3 +558,30 @@ void Font::drawString(gpu::Batch& batch, Font::DrawInfo& drawInfo, const QString
     batch.setIndexBuffer(gpu::UINT16, drawInfo.indicesBuffer, 0);
     batch.drawIndexed(gpu::TRIANGLES, drawInfo.indexCount, 0);
 }
+
+void Font::drawBatched(gpu::Batch& batch, Font::DrawInfo& drawInfo, bool unlit, bool forward) {
+    if (drawInfo.glyphParamsStale) {
+        glm::vec4 color = ColorUtils::sRGBToLinearVec4(drawInfo.params.color);
+        glm::vec4 effectColorAndThickness = glm::vec4(ColorUtils::sRGBToLinearVec3(drawInfo.params.effectColor), drawInfo.params.effectThickness);
+        for (auto& glyph : drawInfo.glyphs) {
+            glyph.color = color;
+            glyph.effectColorAndThickness = effectColorAndThickness;
+            glyph.effectAndDepthOffset.x = (float)drawInfo.params.effect;
+        }
+        drawInfo.glyphParamsStale = false;
+    }
+
+    // All the opaque text in the font and lighting is drawn by one instanced call, one glyph per instance, each with the
+    // transform of its text.  The call is made by the first text to ask for it, when the batch is finished; the fonts are
+    // never released, so the font is still there.
+    std::string instanceName = "sdf_text_" + std::to_string(std::hash<const Font*>()(this)) + (unlit ? "_unlit" : "") + (forward ? "_forward" : "");
+    batch.getNamedBuffer(instanceName, INSTANCE_GLYPH_BUFFER)->append(drawInfo.glyphs.size() * sizeof(GlyphInstance),
+                                                                     (const gpu::Byte*)drawInfo.glyphs.data());
+    batch.setupNamedCalls(instanceName, drawInfo.glyphs.size(), [this, unlit, forward](gpu::Batch& batch, gpu::Batch::NamedBatchData& data) {
+        batch.setPipeline(_batchedPipelines[std::make_tuple(unlit, forward)]);
+        batch.setInputFormat(_batchedFormat);
+        batch.setInputBuffer(0, data.buffers[INSTANCE_GLYPH_BUFFER], 0, sizeof(GlyphInstance));
+        batch.setResourceTexture(render_utils::slot::texture::TextFont, _texture);
+        batch.drawInstanced((gpu::uint32)data.count(), gpu::TRIANGLE_STRIP, VERTICES_PER_QUAD);
+    });
+}
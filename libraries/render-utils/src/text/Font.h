@@ -42,22 +42,41 @@ public:
         vec3 _spare;
     };
 
+    // A laid out glyph, and the instance that draws it when the text is batched with the rest of the opaque text
+    // in the font
+    struct GlyphInstance {
+        vec4 quad { 0.0f };         // bottom left corner and size
+        vec4 texCoords { 0.0f };    // top left corner and size in the atlas, enlarged for shadows
+        vec4 bounds { 0.0f };       // the glyph's own part of the atlas
+        vec4 color { 0.0f };        // linear, like the rest of the params
+        vec4 effectColorAndThickness { 0.0f };
+        vec4 effectAndDepthOffset { 0.0f }; // the shadow effect moves each glyph in front of the shadows of the ones before it
+    };
+
     struct DrawInfo {
         gpu::BufferPointer verticesBuffer { nullptr };
         gpu::BufferPointer indicesBuffer { nullptr };
         gpu::BufferPointer paramsBuffer { nullptr };
         uint32_t indexCount;
 
+        // the layout, kept across frames until the string, its bounds or alignment, or for shadows its scale, change
+        std::vector<GlyphInstance> glyphs;
+        bool buffersStale { true };     // the vertices and indices the unbatched draw needs lag the layout
+        bool glyphParamsStale { true }; // the params of the glyphs lag the params
+
         QString string;
         glm::vec2 origin;
         glm::vec2 bounds;
+        TextAlignment alignment { TextAlignment::LEFT };
+        float scale { 0.0f };
         DrawParams params;
     };
 
     glm::vec2 computeExtent(const QString& str) const;
     float getFontSize() const { return _fontSize; }
 
-    // Render string to batch
+    // Render string to batch.  Opaque text is batched: its glyphs are instances that the font draws at the end of the batch,
+    // in one call for all the text drawn with the same lighting.
     void drawString(gpu::Batch& batch, DrawInfo& drawInfo, const QString& str, const glm::vec4& color,
                     const glm::vec3& effectColor, float effectThickness, TextEffect effect, TextAlignment alignment,
                     const glm::vec2& origin, const glm::vec2& bound, float scale, bool unlit, bool forward);
@@ -79,6 +98,8 @@ private:
     const Glyph& getGlyph(const QChar& c) const;
     void buildVertices(DrawInfo& drawInfo, const QString& str, const glm::vec2& origin, const glm::vec2& bounds, float scale, bool enlargeForShadows,
                        TextAlignment alignment);
+    void buildBuffers(DrawInfo& drawInfo);
+    void drawBatched(gpu::Batch& batch, DrawInfo& drawInfo, bool unlit, bool forward);
 
     void setupGPU();
 
@@ -97,16 +118,15 @@ private:
     float _descent { 0.0f };
     float _spaceWidth { 0.0f };
 
-    float _scale { 0.0f };
-    TextAlignment _alignment;
-
     bool _loaded { true };
 
     gpu::TexturePointer _texture;
     gpu::BufferStreamPointer _stream;
 
     static std::map<std::tuple<bool, bool, bool>, gpu::PipelinePointer> _pipelines;
+    static std::map<std::tuple<bool, bool>, gpu::PipelinePointer> _batchedPipelines;
     static gpu::Stream::FormatPointer _format;
+    static gpu::Stream::FormatPointer _batchedFormat;
 };
 
 #endif
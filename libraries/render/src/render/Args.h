@@ -39,6 +39,7 @@ namespace render {
             int _outOfView = 0;
             int _tooSmall = 0;
             int _rendered = 0;
+            int _cached = 0; // rendered from a cache instead of being drawn again
         };
 
         int _materialSwitches = 0;
@@ -143,6 +144,9 @@ namespace render {
         bool _takingSnapshot { false };
         StencilMaskMode _stencilMaskMode { StencilMaskMode::NONE };
         std::function<void(gpu::Batch&)> _stencilMaskOperator;
+
+        // where the eyes look in stereo, xy for the left eye and zw for the right in [-1, 1] across each eye's view
+        glm::vec4 _gazeCenters { 0.0f };
     };
 
 }
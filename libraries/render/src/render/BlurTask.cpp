@@ -71,7 +71,7 @@ void BlurParams::setFilterTap(int index, float offset, float value) {
     filterTaps[index].y = value;
 }
 
-void BlurParams::setFilterGaussianTaps(int numHalfTaps, float sigma) {
+void BlurParams::setFilterGaussianTaps(int numHalfTaps, float sigma, bool linearSampling) {
     auto& params = _parametersBuffer.edit<Params>();
     const int numTaps = 2 * numHalfTaps + 1;
     assert(numTaps <= BLUR_MAX_NUM_TAPS);
@@ -82,10 +82,29 @@ void BlurParams::setFilterGaussianTaps(int numHalfTaps, float sigma) {
     float offset;
     int i;
 
-    params.filterInfo.y = numTaps;
     params.filterTaps[0].x = 0.0f;
     params.filterTaps[0].y = 1.0f;
 
+    if (linearSampling) {
+        // Taps 1 & 2, 3 & 4... become one tap at their weighted mean offset, with an odd one left as it is
+        const int numMergedHalfTaps = (numHalfTaps + 1) / 2;
+        for (i = 0; i < numMergedHalfTaps; i++) {
+            float offset1 = float(2 * i + 1);
+            float weight1 = (float)exp(-offset1*offset1 * inverseTwoSigmaSquared);
+            float offset2 = offset1 + 1.0f;
+            float weight2 = (2 * i + 2 <= numHalfTaps) ? (float)exp(-offset2*offset2 * inverseTwoSigmaSquared) : 0.0f;
+            weight = weight1 + weight2;
+            offset = (offset1 * weight1 + offset2 * weight2) / weight;
+            params.filterTaps[i + 1].x = offset;
+            params.filterTaps[i + 1].y = weight;
+            params.filterTaps[i + 1 + numMergedHalfTaps].x = -offset;
+            params.filterTaps[i + 1 + numMergedHalfTaps].y = weight;
+        }
+        params.filterInfo.y = 2 * numMergedHalfTaps + 1;
+        return;
+    }
+
+    params.filterInfo.y = numTaps;
     for (i = 0; i < numHalfTaps; i++) {
         offset = i + 1;
         weight = (float)exp(-offset*offset * inverseTwoSigmaSquared);
@@ -232,6 +251,7 @@ void BlurGaussian::configure(const Config& config) {
 
     _parameters->setFilterRadiusScale(config.filterScale);
     _parameters->setOutputAlpha(config.mix);
+    _linearSampling = config.linearSampling;
     if (config.mix < 1.0f) {
         state->setBlendFunction(config.mix < 1.0f, gpu::State::SRC_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::INV_SRC_ALPHA,
                                 gpu::State::SRC_ALPHA, gpu::State::BLEND_OP_ADD, gpu::State::INV_SRC_ALPHA);
@@ -250,7 +270,7 @@ void BlurGaussian::run(const RenderContextPointer& renderContext, const Inputs&
     const auto sourceFramebuffer = inputs.get0();
     _inOutResources._generateOutputFramebuffer = inputs.get1();
     _inOutResources._downsampleFactor = inputs.get2();
-    _parameters->setFilterGaussianTaps(inputs.get3(), inputs.get4());
+    _parameters->setFilterGaussianTaps(inputs.get3(), inputs.get4(), _linearSampling);
 
     BlurInOutResource::Resources blurringResources;
     if (!_inOutResources.updateResources(sourceFramebuffer, blurringResources)) {
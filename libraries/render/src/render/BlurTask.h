@@ -30,7 +30,10 @@ public:
     void setFilterNumTaps(int count);
     // Tap 0 is considered the center of the kernel
     void setFilterTap(int index, float offset, float value);
-    void setFilterGaussianTaps(int numHalfTaps, float sigma = 1.47f);
+    // With linear sampling each pair of neighbouring taps on a side is merged into one tap between them, which the
+    // bilinear filter of the source weights as the pair, halving the fetches. It's exact for a filter scale of 1
+    // when the source is at the resolution being blurred to.
+    void setFilterGaussianTaps(int numHalfTaps, float sigma = 1.47f, bool linearSampling = false);
     void setOutputAlpha(float value);
 
     void setDepthPerspective(float oneOverTan2FOV);
@@ -98,12 +101,14 @@ class BlurGaussianConfig : public Job::Config {
     Q_PROPERTY(bool enabled WRITE setEnabled READ isEnabled NOTIFY dirty) // expose enabled flag
     Q_PROPERTY(float filterScale MEMBER filterScale NOTIFY dirty)
     Q_PROPERTY(float mix MEMBER mix NOTIFY dirty)
+    Q_PROPERTY(bool linearSampling MEMBER linearSampling NOTIFY dirty)
 public:
 
     BlurGaussianConfig() : Job::Config(true) {}
 
     float filterScale{ 0.2f };
     float mix{ 1.0f };
+    bool linearSampling{ false };
 
 signals :
     void dirty();
@@ -136,6 +141,8 @@ protected:
     gpu::PipelinePointer getBlurHPipeline();
 
     BlurInOutResource _inOutResources;
+
+    bool _linearSampling{ false };
 };
 
 class BlurGaussianDepthAwareConfig : public BlurGaussianConfig {
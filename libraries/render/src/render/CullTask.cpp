@@ -16,6 +16,8 @@
 
 #include <PerfStat.h>
 #include <OctreeUtils.h>
+#include <ParallelFor.h>
+
 
 using namespace render;
 
@@ -45,6 +47,31 @@ bool CullTest::frustumTest(const AABox& bound) {
     return true;
 }
 
+void CullTest::frustumTest(ItemBounds& itemBounds, size_t first) {
+    // four at a time, keeping the ones in view in place
+    const ViewFrustum& frustum = _args->getViewFrustum();
+    size_t numInView = first;
+    size_t i = first;
+    for (; i + 4 <= itemBounds.size(); i += 4) {
+        const AABox* boxes[4] = { &itemBounds[i].bound, &itemBounds[i + 1].bound, &itemBounds[i + 2].bound,
+                                  &itemBounds[i + 3].bound };
+        uint32_t inView = frustum.boxesIntersectFrustum(boxes);
+        for (size_t j = 0; j < 4; j++) {
+            if (inView & (1 << j)) {
+                itemBounds[numInView++] = itemBounds[i + j];
+            } else {
+                _renderDetails._outOfView++;
+            }
+        }
+    }
+    for (; i < itemBounds.size(); i++) {
+        if (frustumTest(itemBounds[i].bound)) {
+            itemBounds[numInView++] = itemBounds[i];
+        }
+    }
+    itemBounds.resize(numInView);
+}
+
 bool CullTest::antiFrustumTest(const AABox& bound) {
     assert(_antiFrustum);
     if (_antiFrustum->boxInsideFrustum(bound)) {
@@ -71,6 +98,54 @@ bool CullTest::zoneOcclusionTest(const render::Item& item) {
     return item.passesZoneOcclusionTest(_containingZones);
 }
 
+namespace {
+
+// the parts of a selection with at least this many items are culled in parallel
+const size_t MIN_PARALLEL_CULL_ITEMS = 4096;
+const size_t MIN_ITEMS_PER_CULL_RANGE = 1024;
+
+// the shapes looking smaller than this, their diagonal over their distance, hide too little to be worth rasterizing
+const float MIN_OCCLUDER_SIZE = 0.1f;
+const size_t MAX_OCCLUDERS = 32;
+
+// Appends the items that pass the filter and the culling to outItems, each meta item followed by its sub-items
+void cullItems(Scene& scene, RenderArgs* args, const ItemFilter& filter, CullTest& test, const ItemID* ids, size_t numIDs,
+               bool frustumCull, bool solidAngleCull, ItemBounds& outItems) {
+    size_t first = outItems.size();
+    bool hasMetaItems = false;
+    for (size_t i = 0; i < numIDs; i++) {
+        // the packed keys are filtered first, so that only the items passing are read, and their payloads called
+        const auto& key = scene.getItemKey(ids[i]);
+        if (!filter.test(key)) {
+            continue;
+        }
+        auto& item = scene.getItem(ids[i]);
+        if (test.zoneOcclusionTest(item)) {
+            outItems.emplace_back(ItemBound(ids[i], item.getBound(args)));
+            hasMetaItems = hasMetaItems || key.isMetaCullGroup();
+        }
+    }
+
+    if (frustumCull) {
+        test.frustumTest(outItems, first);
+    }
+
+    if (solidAngleCull || hasMetaItems) {
+        ItemBounds candidates(outItems.begin() + first, outItems.end());
+        outItems.resize(first);
+        for (const auto& itemBound : candidates) {
+            if (!solidAngleCull || test.solidAngleTest(itemBound.bound)) {
+                outItems.emplace_back(itemBound);
+                if (scene.getItemKey(itemBound.id).isMetaCullGroup()) {
+                    scene.getItem(itemBound.id).fetchMetaSubItemBounds(outItems, scene, args);
+                }
+            }
+        }
+    }
+}
+
+}
+
 void FetchNonspatialItems::run(const RenderContextPointer& renderContext, const ItemFilter& filter, ItemBounds& outItems) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -81,8 +156,11 @@ void FetchNonspatialItems::run(const RenderContextPointer& renderContext, const
     const auto& items = scene->getNonspatialSet();
     outItems.reserve(items.size());
     for (auto& id : items) {
+        if (!filter.test(scene->getItemKey(id))) {
+            continue;
+        }
         auto& item = scene->getItem(id);
-        if (filter.test(item.getKey()) && item.passesZoneOcclusionTest(CullTest::_containingZones)) {
+        if (item.passesZoneOcclusionTest(CullTest::_containingZones)) {
             outItems.emplace_back(ItemBound(id, item.getBound(renderContext->args)));
         }
     }
@@ -145,6 +223,7 @@ void CullSpatialSelection::configure(const Config& config) {
     _justFrozeFrustum = _justFrozeFrustum || (config.freezeFrustum && !_freezeFrustum);
     _freezeFrustum = config.freezeFrustum;
     _overrideSkipCulling = config.skipCulling;
+    _parallelCulling = config.parallelCulling;
 }
 
 void CullSpatialSelection::run(const RenderContextPointer& renderContext,
@@ -176,139 +255,57 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
     const auto srcFilter = inputs.get1();
     if (!srcFilter.selectsNothing()) {
         auto filter = render::ItemFilter::Builder(srcFilter).withoutSubMetaCulled().build();
+        bool skipCulling = _skipCulling || _overrideSkipCulling;
+
+        auto cullPart = [&](const ItemIDs& ids, bool frustumCull, bool solidAngleCull) {
+            if (!_parallelCulling || ids.size() < MIN_PARALLEL_CULL_ITEMS) {
+                cullItems(*scene, args, filter, test, ids.data(), ids.size(), frustumCull, solidAngleCull, outItems);
+                return;
+            }
+            size_t numRanges = getNumParallelRanges(ids.size(), MIN_ITEMS_PER_CULL_RANGE);
+            std::vector<ItemBounds> rangeItems(numRanges);
+            std::vector<RenderDetails::Item> rangeDetails(numRanges);
+            parallelFor(ids.size(), MIN_ITEMS_PER_CULL_RANGE, [&](size_t index, size_t begin, size_t end) {
+                CullTest rangeTest(_cullFunctor, args, rangeDetails[index]);
+                rangeItems[index].reserve(end - begin);
+                cullItems(*scene, args, filter, rangeTest, ids.data() + begin, end - begin, frustumCull, solidAngleCull,
+                          rangeItems[index]);
+            });
+            for (size_t i = 0; i < numRanges; i++) {
+                outItems.insert(outItems.end(), rangeItems[i].begin(), rangeItems[i].end());
+                details._outOfView += rangeDetails[i]._outOfView;
+                details._tooSmall += rangeDetails[i]._tooSmall;
+            }
+        };
 
         // Now get the bound, and
         // filter individually against the _filter
         // visibility cull if partially selected ( octree cell contianing it was partial)
         // distance cull if was a subcell item ( octree cell is way bigger than the item bound itself, so now need to test per item)
-        if (_skipCulling || _overrideSkipCulling) {
-            // inside & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // inside & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & fit items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-            // partial & subcell items: filter only, culling is disabled
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
-
-        } else {
+        // When culling is disabled, every part is only filtered.
 
-            // inside & fit items: easy, just filter
-            {
-                PerformanceTimer perfTimer("insideFitItems");
-                for (auto id : inSelection.insideItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        outItems.emplace_back(itemBound);
-                        if (item.getKey().isMetaCullGroup()) {
-                            item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                        }
-                    }
-                }
-            }
+        // inside & fit items: easy, just filter
+        {
+            PerformanceTimer perfTimer("insideFitItems");
+            cullPart(inSelection.insideItems, false, false);
+        }
 
-            // inside & subcell items: filter & distance cull
-            {
-                PerformanceTimer perfTimer("insideSmallItems");
-                for (auto id : inSelection.insideSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // inside & subcell items: filter & distance cull
+        {
+            PerformanceTimer perfTimer("insideSmallItems");
+            cullPart(inSelection.insideSubcellItems, false, !skipCulling);
+        }
 
-            // partial & fit items: filter & frustum cull
-            {
-                PerformanceTimer perfTimer("partialFitItems");
-                for (auto id : inSelection.partialItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & fit items: filter & frustum cull
+        {
+            PerformanceTimer perfTimer("partialFitItems");
+            cullPart(inSelection.partialItems, !skipCulling, false);
+        }
 
-            // partial & subcell items:: filter & frutum cull & solidangle cull
-            {
-                PerformanceTimer perfTimer("partialSmallItems");
-                for (auto id : inSelection.partialSubcellItems) {
-                    auto& item = scene->getItem(id);
-                    if (filter.test(item.getKey()) && test.zoneOcclusionTest(item)) {
-                        ItemBound itemBound(id, item.getBound(args));
-                        if (test.frustumTest(itemBound.bound) && test.solidAngleTest(itemBound.bound)) {
-                            outItems.emplace_back(itemBound);
-                            if (item.getKey().isMetaCullGroup()) {
-                                item.fetchMetaSubItemBounds(outItems, (*scene), args);
-                            }
-                        }
-                    }
-                }
-            }
+        // partial & subcell items:: filter & frutum cull & solidangle cull
+        {
+            PerformanceTimer perfTimer("partialSmallItems");
+            cullPart(inSelection.partialSubcellItems, !skipCulling, !skipCulling);
         }
     }
 
@@ -322,6 +319,83 @@ void CullSpatialSelection::run(const RenderContextPointer& renderContext,
     std::static_pointer_cast<Config>(renderContext->jobConfig)->numItems = (int)outItems.size();
 }
 
+void OcclusionCullItems::configure(const Config& config) {
+    _occlusionCulling = config.occlusionCulling;
+}
+
+void OcclusionCullItems::run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems) {
+    assert(renderContext->args);
+    assert(renderContext->args->hasViewFrustum());
+    PerformanceTimer perfTimer("occlusionCullItems");
+    RenderArgs* args = renderContext->args;
+    auto& scene = renderContext->_scene;
+    auto config = std::static_pointer_cast<Config>(renderContext->jobConfig);
+
+    // in stereo, what is hidden from between the eyes can still be seen by one of them
+    if (!_occlusionCulling || args->isStereo()) {
+        outItems = inItems;
+        config->numOccluders = 0;
+        config->numOccluded = 0;
+        return;
+    }
+
+    const ViewFrustum& frustum = args->getViewFrustum();
+    const glm::vec3 eyePosition = frustum.getPosition();
+
+    // the occluders are the shapes that look the largest, so likely hide the most
+    _occluders.clear();
+    for (const auto& itemBound : inItems) {
+        const auto& item = scene->getItem(itemBound.id);
+        glm::mat4 boxToWorld;
+        if (item.getKey().isShape() && item.getOccluder(boxToWorld)) {
+            float distance = std::max(glm::distance(eyePosition, itemBound.bound.calcCenter()), EPSILON);
+            float size = glm::length(itemBound.bound.getDimensions()) / distance;
+            if (size > MIN_OCCLUDER_SIZE) {
+                _occluders.push_back({ size, boxToWorld });
+            }
+        }
+    }
+    if (_occluders.size() > MAX_OCCLUDERS) {
+        std::nth_element(_occluders.begin(), _occluders.begin() + MAX_OCCLUDERS, _occluders.end(),
+                         [](const Occluder& a, const Occluder& b) { return a.size > b.size; });
+        _occluders.resize(MAX_OCCLUDERS);
+    }
+
+    if (_occluders.empty()) {
+        outItems = inItems;
+        config->numOccluders = 0;
+        config->numOccluded = 0;
+        return;
+    }
+
+    glm::mat4 projection;
+    frustum.evalProjectionMatrix(projection);
+    Transform viewTransform;
+    frustum.evalViewTransform(viewTransform);
+    glm::mat4 view;
+    viewTransform.getInverseMatrix(view);
+
+    _buffer.clear(projection * view);
+    for (const auto& occluder : _occluders) {
+        _buffer.addOccluder(occluder.boxToWorld);
+    }
+    _buffer.buildPyramid();
+
+    outItems.clear();
+    outItems.reserve(inItems.size());
+    int numOccluded = 0;
+    for (const auto& itemBound : inItems) {
+        if (scene->getItemKey(itemBound.id).isShape() && _buffer.isOccluded(itemBound.bound)) {
+            numOccluded++;
+        } else {
+            outItems.emplace_back(itemBound);
+        }
+    }
+
+    config->numOccluders = _buffer.getNumOccluders();
+    config->numOccluded = numOccluded;
+}
+
 void CullShapeBounds::run(const RenderContextPointer& renderContext, const Inputs& inputs, Outputs& outputs) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -358,7 +432,7 @@ void CullShapeBounds::run(const RenderContextPointer& renderContext, const Input
             if (antiFrustum == nullptr) {
                 for (auto& item : inItems.second) {
                     if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
+                        const auto shapeKey = scene->getItemKey(item.id);
                         if (cullFilter.test(shapeKey)) {
                             outItems->second.emplace_back(item);
                         }
@@ -370,7 +444,7 @@ void CullShapeBounds::run(const RenderContextPointer& renderContext, const Input
             } else {
                 for (auto& item : inItems.second) {
                     if (test.solidAngleTest(item.bound) && test.frustumTest(item.bound) && test.antiFrustumTest(item.bound)) {
-                        const auto shapeKey = scene->getItem(item.id).getKey();
+                        const auto shapeKey = scene->getItemKey(item.id);
                         if (cullFilter.test(shapeKey)) {
                             outItems->second.emplace_back(item);
                         }
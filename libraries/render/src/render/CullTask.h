@@ -13,6 +13,7 @@
 #define hifi_render_CullTask_h
 
 #include "Engine.h"
+#include "OcclusionBuffer.h"
 #include "ViewFrustum.h"
 
 namespace render {
@@ -31,6 +32,8 @@ namespace render {
         CullTest(CullFunctor& functor, RenderArgs* pargs, RenderDetails::Item& renderDetails, ViewFrustumPointer antiFrustum = nullptr);
 
         bool frustumTest(const AABox& bound);
+        // removes the items from first on that are out of view
+        void frustumTest(ItemBounds& itemBounds, size_t first);
         bool antiFrustumTest(const AABox& bound);
         bool solidAngleTest(const AABox& bound);
         bool zoneOcclusionTest(const render::Item& item);
@@ -84,15 +87,18 @@ namespace render {
         Q_PROPERTY(int numItems READ getNumItems)
         Q_PROPERTY(bool freezeFrustum MEMBER freezeFrustum WRITE setFreezeFrustum)
         Q_PROPERTY(bool skipCulling MEMBER skipCulling WRITE setSkipCulling)
+        Q_PROPERTY(bool parallelCulling MEMBER parallelCulling WRITE setParallelCulling)
     public:
         int numItems{ 0 };
         int getNumItems() { return numItems; }
 
         bool freezeFrustum{ false };
         bool skipCulling{ false };
+        bool parallelCulling{ true };
     public slots:
         void setFreezeFrustum(bool enabled) { freezeFrustum = enabled; emit dirty(); }
         void setSkipCulling(bool enabled) { skipCulling = enabled; emit dirty(); }
+        void setParallelCulling(bool enabled) { parallelCulling = enabled; emit dirty(); }
     signals:
         void dirty();
     };
@@ -115,12 +121,52 @@ namespace render {
         bool _freezeFrustum { false }; // initialized by Config
         bool _justFrozeFrustum { false };
         bool _overrideSkipCulling { false };
+        bool _parallelCulling { true };
         ViewFrustum _frozenFrustum;
 
         void configure(const Config& config);
         void run(const RenderContextPointer& renderContext, const Inputs& inputs, ItemBounds& outItems);
     };
 
+    class OcclusionCullItemsConfig : public Job::Config {
+        Q_OBJECT
+        Q_PROPERTY(bool occlusionCulling MEMBER occlusionCulling WRITE setOcclusionCulling)
+        Q_PROPERTY(int numOccluders READ getNumOccluders)
+        Q_PROPERTY(int numOccluded READ getNumOccluded)
+    public:
+        bool occlusionCulling{ true };
+
+        int numOccluders{ 0 };
+        int getNumOccluders() { return numOccluders; }
+        // the shapes culled, and so the draw calls saved, last frame
+        int numOccluded{ 0 };
+        int getNumOccluded() { return numOccluded; }
+    public slots:
+        void setOcclusionCulling(bool enabled) { occlusionCulling = enabled; emit dirty(); }
+    signals:
+        void dirty();
+    };
+
+    // Removes the shapes hidden behind the largest occluders in view, which are rasterized into an OcclusionBuffer
+    class OcclusionCullItems {
+    public:
+        using Config = OcclusionCullItemsConfig;
+        using JobModel = Job::ModelIO<OcclusionCullItems, ItemBounds, ItemBounds, Config>;
+
+        void configure(const Config& config);
+        void run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems);
+
+    private:
+        struct Occluder {
+            float size;
+            glm::mat4 boxToWorld;
+        };
+
+        bool _occlusionCulling { true };
+        std::vector<Occluder> _occluders;
+        OcclusionBuffer _buffer;
+    };
+
     class CullShapeBounds {
     public:
         using Inputs = render::VaryingSet4<ShapeBounds, ItemFilter, ItemFilter, ViewFrustumPointer>;
@@ -15,6 +15,7 @@
 #include <assert.h>
 
 #include <LogHandler.h>
+#include <ParallelFor.h>
 #include <PerfStat.h>
 #include <ViewFrustum.h>
 #include <gpu/Context.h>
@@ -80,8 +81,30 @@ void render::renderShapes(const RenderContextPointer& renderContext,
     }
 }
 
-void render::renderStateSortShapes(const RenderContextPointer& renderContext,
-    const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey) {
+namespace {
+    // Orders the shapes of a pipeline by their materials.  The sort is stable, so the shapes of a material stay in the
+    // order they came in, front to back for the opaque ones.
+    void sortByMaterial(std::vector<const Item*>& bucket) {
+        if (bucket.size() < 2) {
+            return;
+        }
+        std::vector<std::pair<uint64_t, const Item*>> keyedItems;
+        keyedItems.reserve(bucket.size());
+        for (auto item : bucket) {
+            keyedItems.emplace_back(item->getMaterialSortKey(), item);
+        }
+        std::stable_sort(keyedItems.begin(), keyedItems.end(), [](const std::pair<uint64_t, const Item*>& a,
+                                                                  const std::pair<uint64_t, const Item*>& b) {
+            return a.first < b.first;
+        });
+        for (size_t i = 0; i < bucket.size(); i++) {
+            bucket[i] = keyedItems[i].second;
+        }
+    }
+}
+
+void render::renderStateSortShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext,
+    const ItemBounds& inItems, int maxDrawnItems, const ShapeKey& globalKey, bool sortMaterials) {
     auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
 
@@ -91,13 +114,13 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
     }
 
     using SortedPipelines = std::vector<render::ShapeKey>;
-    using SortedShapes = std::unordered_map<render::ShapeKey, std::vector<Item>, render::ShapeKey::Hash, render::ShapeKey::KeyEqual>;
+    using SortedShapes = std::unordered_map<render::ShapeKey, std::vector<const Item*>, render::ShapeKey::Hash, render::ShapeKey::KeyEqual>;
     SortedPipelines sortedPipelines;
     SortedShapes sortedShapes;
-    std::vector< std::tuple<Item,ShapeKey> > ownPipelineBucket;
+    std::vector< std::tuple<const Item*,ShapeKey> > ownPipelineBucket;
 
     for (auto i = 0; i < numItemsToDraw; ++i) {
-        auto& item = scene->getItem(inItems[i].id);
+        const auto& item = scene->getItem(inItems[i].id);
         {
             assert(item.getKey().isShape());
             auto key = item.getShapeKey() | globalKey;
@@ -106,9 +129,9 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
                 if (bucket.empty()) {
                     sortedPipelines.push_back(key);
                 }
-                bucket.push_back(item);
+                bucket.push_back(&item);
             } else if (key.hasOwnPipeline()) {
-                ownPipelineBucket.push_back( std::make_tuple(item, key) );
+                ownPipelineBucket.push_back( std::make_tuple(&item, key) );
             } else {
                 std::call_once(messageIDFlag, [](int* id) { *id = LogHandler::getInstance().newRepeatedMessageID(); },
                     &repeatedInvalidKeyMessageID);
@@ -124,21 +147,131 @@ void render::renderStateSortShapes(const RenderContextPointer& renderContext,
         if (!args->_shapePipeline) {
             continue;
         }
+        if (sortMaterials) {
+            sortByMaterial(bucket);
+        }
         args->_itemShapeKey = pipelineKey._flags.to_ulong();
-        for (auto& item : bucket) {
-            args->_shapePipeline->prepareShapeItem(args, pipelineKey, item);
-            item.render(args);
+        for (auto item : bucket) {
+            args->_shapePipeline->prepareShapeItem(args, pipelineKey, *item);
+            item->render(args);
         }
     }
     args->_shapePipeline = nullptr;
     for (auto& itemAndKey : ownPipelineBucket) {
-        auto& item = std::get<0>(itemAndKey);
         args->_itemShapeKey = std::get<1>(itemAndKey)._flags.to_ulong();
-        item.render(args);
+        std::get<0>(itemAndKey)->render(args);
     }
     args->_itemShapeKey = 0;
 }
 
+namespace {
+    // the fewest shapes worth recording in a batch of their own
+    const size_t MIN_SHAPES_PER_BATCH = 256;
+}
+
+void render::renderStateSortShapesInParallel(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext,
+    const ItemBounds& inItems, const char* batchName, const std::function<void(gpu::Batch& batch)>& setupBatch,
+    int maxDrawnItems, const ShapeKey& globalKey, bool sortMaterials) {
+    auto& scene = renderContext->_scene;
+    RenderArgs* args = renderContext->args;
+
+    int numItemsToDraw = (int)inItems.size();
+    if (maxDrawnItems != -1) {
+        numItemsToDraw = glm::min(numItemsToDraw, maxDrawnItems);
+    }
+
+    // The pipelines are found here, so the recording threads only read the plumber
+    using SortedShapes = std::unordered_map<render::ShapeKey, std::vector<const Item*>, render::ShapeKey::Hash, render::ShapeKey::KeyEqual>;
+    std::vector<ShapeKey> sortedPipelines;
+    SortedShapes sortedShapes;
+    std::vector<std::tuple<const Item*, ShapeKey>> ownPipelineBucket;
+
+    for (auto i = 0; i < numItemsToDraw; ++i) {
+        const auto& item = scene->getItem(inItems[i].id);
+        assert(item.getKey().isShape());
+        auto key = item.getShapeKey() | globalKey;
+        if (key.isValid() && !key.hasOwnPipeline()) {
+            auto& bucket = sortedShapes[key];
+            if (bucket.empty()) {
+                if (!shapeContext->findPipeline(args, key)) {
+                    continue;
+                }
+                sortedPipelines.push_back(key);
+            }
+            bucket.push_back(&item);
+        } else if (key.hasOwnPipeline()) {
+            ownPipelineBucket.push_back(std::make_tuple(&item, key));
+        } else {
+            std::call_once(messageIDFlag, [](int* id) { *id = LogHandler::getInstance().newRepeatedMessageID(); },
+                &repeatedInvalidKeyMessageID);
+            HIFI_FCDEBUG_ID(renderlogging(), repeatedInvalidKeyMessageID, "Item could not be rendered with invalid key" << key);
+        }
+    }
+
+    std::vector<std::tuple<const Item*, ShapeKey>> shapes;
+    shapes.reserve(numItemsToDraw);
+    for (auto& pipelineKey : sortedPipelines) {
+        auto& bucket = sortedShapes[pipelineKey];
+        if (sortMaterials) {
+            sortByMaterial(bucket);
+        }
+        for (auto item : bucket) {
+            shapes.push_back(std::make_tuple(item, pipelineKey));
+        }
+    }
+
+    size_t numRanges = getNumParallelRanges(shapes.size(), MIN_SHAPES_PER_BATCH);
+    std::vector<gpu::BatchPointer> batches(numRanges);
+    std::vector<RenderDetails> rangeDetails(numRanges);
+    parallelFor(shapes.size(), MIN_SHAPES_PER_BATCH, [&](size_t index, size_t begin, size_t end) {
+        if (begin == end) {
+            return;
+        }
+        RenderArgs rangeArgs(*args);
+        rangeArgs._details = RenderDetails();
+        auto batch = gpu::Context::acquireBatch(batchName);
+        rangeArgs._batch = batch.get();
+        setupBatch(*batch);
+
+        for (size_t i = begin; i < end; i++) {
+            const auto& item = *std::get<0>(shapes[i]);
+            const auto& pipelineKey = std::get<1>(shapes[i]);
+            if (i == begin || pipelineKey._flags != std::get<1>(shapes[i - 1])._flags) {
+                rangeArgs._shapePipeline = shapeContext->pickPipeline(&rangeArgs, pipelineKey);
+                rangeArgs._itemShapeKey = pipelineKey._flags.to_ulong();
+            }
+            rangeArgs._shapePipeline->prepareShapeItem(&rangeArgs, pipelineKey, item);
+            item.render(&rangeArgs);
+        }
+
+        rangeArgs._batch = nullptr;
+        rangeDetails[index] = rangeArgs._details;
+        batches[index] = batch;
+    });
+
+    for (size_t i = 0; i < numRanges; i++) {
+        if (batches[i]) {
+            args->_context->appendFrameBatch(batches[i]);
+            args->_details._materialSwitches += rangeDetails[i]._materialSwitches;
+            args->_details._trianglesRendered += rangeDetails[i]._trianglesRendered;
+        }
+    }
+
+    // The shapes with their own pipelines can share state between them, so are recorded here, in order.  This batch is
+    // recorded even without them, so the state set up by setupBatch() is left for the jobs after this one.
+    gpu::doInBatch(batchName, args->_context, [&](gpu::Batch& batch) {
+        args->_batch = &batch;
+        setupBatch(batch);
+        args->_shapePipeline = nullptr;
+        for (auto& itemAndKey : ownPipelineBucket) {
+            args->_itemShapeKey = std::get<1>(itemAndKey)._flags.to_ulong();
+            std::get<0>(itemAndKey)->render(args);
+        }
+        args->_itemShapeKey = 0;
+        args->_batch = nullptr;
+    });
+}
+
 void DrawLight::run(const RenderContextPointer& renderContext, const ItemBounds& inLights) {
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
@@ -18,7 +18,19 @@ namespace render {
 
 void renderItems(const RenderContextPointer& renderContext, const ItemBounds& inItems, int maxDrawnItems = -1);
 void renderShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
-void renderStateSortShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey());
+// With sortMaterials, the shapes of each pipeline are drawn in the order of their materials rather than in the order they
+// came in, so that consecutive draws mostly bind the textures already bound.
+void renderStateSortShapes(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey(),
+    bool sortMaterials = false);
+
+// Renders the shapes like renderStateSortShapes(), into batches of their own, appended to the frame after the batches
+// appended so far. The shapes drawn with the plumber's pipelines are split across batches recorded on the global thread
+// pool, each with its own copy of the args. The shapes with their own pipelines are recorded on this thread, in the last
+// batch. Each batch begins with setupBatch(), which must record the viewport and the transforms, since those don't carry
+// over from one batch to the next.
+void renderStateSortShapesInParallel(const RenderContextPointer& renderContext, const ShapePlumberPointer& shapeContext, const ItemBounds& inItems,
+    const char* batchName, const std::function<void(gpu::Batch& batch)>& setupBatch, int maxDrawnItems = -1, const ShapeKey& globalKey = ShapeKey(),
+    bool sortMaterials = false);
 
 class DrawLightConfig : public Job::Config {
     Q_OBJECT
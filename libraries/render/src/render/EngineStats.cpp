@@ -12,6 +12,8 @@
 
 #include <gpu/Texture.h>
 
+#include <FrameArena.h>
+
 using namespace render;
 
 void EngineStats::run(const RenderContextPointer& renderContext) {
@@ -47,6 +49,8 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
     config->texturePendingGPUTransferSize = gpu::Context::getTexturePendingGPUTransferMemSize();
 
     config->textureResourcePopulatedGPUMemSize = gpu::Context::getTextureResourcePopulatedGPUMemSize();
+    config->textureResourceUnderResolvedGPUCount = gpu::Context::getTextureResourceUnderResolvedGPUCount();
+    config->textureResourceOverResolvedGPUMemSize = gpu::Context::getTextureResourceOverResolvedGPUMemSize();
 
     renderContext->args->_context->getFrameStats(_gpuStats);
 
@@ -64,5 +68,14 @@ void EngineStats::run(const RenderContextPointer& renderContext) {
     config->frameSetPipelineCount = _gpuStats._PSNumSetPipelines;
     config->frameSetInputFormatCount = _gpuStats._ISNumFormatChanges;
 
+    config->frameStreamedMemory = _gpuStats._TSAmountStreamedMemory;
+    config->frameStreamedUploadCount = _gpuStats._TSNumStreamedUploads;
+    config->frameStreamStallCount = _gpuStats._TSNumStreamStalls;
+
+    // the render jobs' transient containers come from the thread arenas, along with those of anything else that uses them
+    auto arenaStats = FrameArena::takeThreadArenaStats();
+    config->frameArenaAllocationCount = (quint32)arenaStats.numAllocations;
+    config->frameArenaHeapAllocationCount = (quint32)arenaStats.numBlockAllocations;
+
     // These new stat values are notified with the "newStats" signal triggered by the timer
 }
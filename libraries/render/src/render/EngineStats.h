@@ -46,6 +46,8 @@ namespace render {
         Q_PROPERTY(quint32 texturePendingGPUTransferCount MEMBER texturePendingGPUTransferCount NOTIFY newStats)
         Q_PROPERTY(qint64 texturePendingGPUTransferSize MEMBER texturePendingGPUTransferSize NOTIFY newStats)
         Q_PROPERTY(qint64 textureResourcePopulatedGPUMemSize MEMBER textureResourcePopulatedGPUMemSize NOTIFY newStats)
+        Q_PROPERTY(quint32 textureResourceUnderResolvedGPUCount MEMBER textureResourceUnderResolvedGPUCount NOTIFY newStats)
+        Q_PROPERTY(qint64 textureResourceOverResolvedGPUMemSize MEMBER textureResourceOverResolvedGPUMemSize NOTIFY newStats)
 
         Q_PROPERTY(quint32 frameAPIDrawcallCount MEMBER frameAPIDrawcallCount NOTIFY newStats)
         Q_PROPERTY(quint32 frameDrawcallCount MEMBER frameDrawcallCount NOTIFY newStats)
@@ -61,6 +63,13 @@ namespace render {
         Q_PROPERTY(quint32 frameSetPipelineCount MEMBER frameSetPipelineCount NOTIFY newStats)
         Q_PROPERTY(quint32 frameSetInputFormatCount MEMBER frameSetInputFormatCount NOTIFY newStats)
 
+        Q_PROPERTY(quint64 frameStreamedMemory MEMBER frameStreamedMemory NOTIFY newStats)
+        Q_PROPERTY(quint32 frameStreamedUploadCount MEMBER frameStreamedUploadCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameStreamStallCount MEMBER frameStreamStallCount NOTIFY newStats)
+
+        Q_PROPERTY(quint32 frameArenaAllocationCount MEMBER frameArenaAllocationCount NOTIFY newStats)
+        Q_PROPERTY(quint32 frameArenaHeapAllocationCount MEMBER frameArenaHeapAllocationCount NOTIFY newStats)
+
 
     public:
         EngineStatsConfig() : Job::Config(true) {}
@@ -86,6 +95,8 @@ namespace render {
         qint64 textureExternalGPUMemSize { 0 };
         qint64 texturePendingGPUTransferSize { 0 };
         qint64 textureResourcePopulatedGPUMemSize { 0 };
+        quint32 textureResourceUnderResolvedGPUCount { 0 };
+        qint64 textureResourceOverResolvedGPUMemSize { 0 };
 
         quint32 frameAPIDrawcallCount{ 0 };
         quint32 frameDrawcallCount{ 0 };
@@ -101,6 +112,13 @@ namespace render {
         quint32 frameSetPipelineCount{ 0 };
 
         quint32 frameSetInputFormatCount{ 0 };
+
+        quint64 frameStreamedMemory{ 0 };
+        quint32 frameStreamedUploadCount{ 0 };
+        quint32 frameStreamStallCount{ 0 };
+
+        quint32 frameArenaAllocationCount{ 0 };
+        quint32 frameArenaHeapAllocationCount{ 0 };
     };
 
     class EngineStats {
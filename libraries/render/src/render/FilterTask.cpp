@@ -29,8 +29,7 @@ void FilterLayeredItems::run(const RenderContextPointer& renderContext, const It
 
     // For each item, filter it into one bucket
     for (auto& itemBound : inItems) {
-        auto& item = scene->getItem(itemBound.id);
-        if (item.getLayer() == _keepLayer) {
+        if (scene->getItemKey(itemBound.id).getLayer() == _keepLayer) {
             matchedItems.emplace_back(itemBound);
         } else {
             nonMatchItems.emplace_back(itemBound);
@@ -160,4 +160,18 @@ namespace render {
         }
         return payload->passesZoneOcclusionTest(containingZones);
     }
+
+    template <> bool payloadGetOccluder(const PayloadProxyInterface::Pointer& payload, glm::mat4& boxToWorld) {
+        if (!payload) {
+            return false;
+        }
+        return payload->getOccluder(boxToWorld);
+    }
+
+    template <> uint64_t payloadGetMaterialSortKey(const PayloadProxyInterface::Pointer& payload) {
+        if (!payload) {
+            return 0;
+        }
+        return payload->getMaterialSortKey();
+    }
 }
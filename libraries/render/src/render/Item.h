@@ -440,6 +440,10 @@ public:
 
         virtual bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const = 0;
 
+        virtual bool getOccluder(glm::mat4& boxToWorld) const = 0;
+
+        virtual uint64_t getMaterialSortKey() const = 0;
+
         ~PayloadInterface() {}
 
         // Status interface is local to the base class
@@ -493,6 +497,12 @@ public:
 
     bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const { return _payload->passesZoneOcclusionTest(containingZones); }
 
+    // Occluder Interface
+    bool getOccluder(glm::mat4& boxToWorld) const { return _payload->getOccluder(boxToWorld); }
+
+    // Material Sort Interface
+    uint64_t getMaterialSortKey() const { return _payload->getMaterialSortKey(); }
+
     // Access the status
     const StatusPointer& getStatus() const { return _payload->getStatus(); }
 
@@ -547,6 +557,16 @@ template <class T> uint32_t metaFetchMetaSubItems(const std::shared_ptr<T>& payl
 // Allows payloads to determine if they should render or not, based on the zones that contain the current camera
 template <class T> bool payloadPassesZoneOcclusionTest(const std::shared_ptr<T>& payloadData, const std::unordered_set<QUuid>& containingZones) { return true; }
 
+// Occluder Interface
+// Allows opaque payloads to provide a box, inside what they render, that hides the items behind it.  boxToWorld transforms
+// the unit cube centered on the origin to that box.
+template <class T> bool payloadGetOccluder(const std::shared_ptr<T>& payloadData, glm::mat4& boxToWorld) { return false; }
+
+// Material Sort Interface
+// Allows shapes to tell which material they bind, so the shapes drawn with one pipeline can be drawn in the order of their
+// materials, and the textures bound for a shape are mostly still bound for the next.  0 is for no material to sort by.
+template <class T> uint64_t payloadGetMaterialSortKey(const std::shared_ptr<T>& payloadData) { return 0; }
+
 // THe Payload class is the real Payload to be used
 // THis allow anything to be turned into a Payload as long as the required interface functions are available
 // When creating a new kind of payload from a new "stuff" class then you need to create specialized version for "stuff"
@@ -573,6 +593,10 @@ public:
 
     virtual bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const override { return payloadPassesZoneOcclusionTest<T>(_data, containingZones); }
 
+    virtual bool getOccluder(glm::mat4& boxToWorld) const override { return payloadGetOccluder<T>(_data, boxToWorld); }
+
+    virtual uint64_t getMaterialSortKey() const override { return payloadGetMaterialSortKey<T>(_data); }
+
 protected:
     DataPointer _data;
 
@@ -628,6 +652,8 @@ public:
     virtual void render(RenderArgs* args) = 0;
     virtual uint32_t metaFetchMetaSubItems(ItemIDs& subItems) const = 0;
     virtual bool passesZoneOcclusionTest(const std::unordered_set<QUuid>& containingZones) const = 0;
+    virtual bool getOccluder(glm::mat4& boxToWorld) const { return false; }
+    virtual uint64_t getMaterialSortKey() const { return 0; }
 
     // FIXME: this isn't the best place for this since it's only used for ModelEntities, but currently all Entities use PayloadProxyInterface
     virtual void handleBlendedVertices(int blendshapeNumber, const QVector<BlendshapeOffset>& blendshapeOffsets,
@@ -640,6 +666,8 @@ template <> void payloadRender(const PayloadProxyInterface::Pointer& payload, Re
 template <> uint32_t metaFetchMetaSubItems(const PayloadProxyInterface::Pointer& payload, ItemIDs& subItems);
 template <> const ShapeKey shapeGetShapeKey(const PayloadProxyInterface::Pointer& payload);
 template <> bool payloadPassesZoneOcclusionTest(const PayloadProxyInterface::Pointer& payload, const std::unordered_set<QUuid>& containingZones);
+template <> bool payloadGetOccluder(const PayloadProxyInterface::Pointer& payload, glm::mat4& boxToWorld);
+template <> uint64_t payloadGetMaterialSortKey(const PayloadProxyInterface::Pointer& payload);
 
 typedef Item::PayloadPointer PayloadPointer;
 typedef std::vector<PayloadPointer> Payloads;
@@ -0,0 +1,197 @@
+//
+//  OcclusionBuffer.cpp
+//  render/src/render
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cfloat>
+
+using namespace render;
+
+namespace {
+
+    // the corners of the unit cube, with the x, y and z offsets in bits 0, 1 and 2 of their index
+    const int NUM_BOX_CORNERS = 8;
+    // its faces, as loops of corners
+    const int NUM_BOX_FACES = 6;
+    const int BOX_FACES[NUM_BOX_FACES][4] = {
+        { 0, 2, 6, 4 }, { 1, 3, 7, 5 },
+        { 0, 1, 5, 4 }, { 2, 3, 7, 6 },
+        { 0, 1, 3, 2 }, { 4, 5, 7, 6 }
+    };
+
+    // how much farther than the occluders a box must be to be hidden by them, so boxes touching them aren't, whatever the
+    // rounding of their depths
+    const float DEPTH_BIAS = 1.0e-6f;
+
+    // triangles thinner than this, in square pixels, cover no pixel centers worth the work
+    const float MIN_TRIANGLE_AREA = 1.0e-4f;
+
+    inline glm::vec3 boxCorner(int index) {
+        return glm::vec3((index & 1) ? 0.5f : -0.5f, (index & 2) ? 0.5f : -0.5f, (index & 4) ? 0.5f : -0.5f);
+    }
+
+    inline bool isInFrontOfNearPlane(const glm::vec4& clip) {
+        return clip.w <= 0.0f || clip.z < -clip.w;
+    }
+
+    // from clip space to pixels, and normalized device depth
+    inline glm::vec3 toScreen(const glm::vec4& clip) {
+        glm::vec3 ndc = glm::vec3(clip) / clip.w;
+        return glm::vec3((0.5f * ndc.x + 0.5f) * (float)OcclusionBuffer::WIDTH,
+                         (0.5f * ndc.y + 0.5f) * (float)OcclusionBuffer::HEIGHT, ndc.z);
+    }
+
+    inline float edge(const glm::vec3& a, const glm::vec3& b, float x, float y) {
+        return (b.x - a.x) * (y - a.y) - (b.y - a.y) * (x - a.x);
+    }
+
+}
+
+void OcclusionBuffer::clear(const glm::mat4& viewProjection) {
+    _viewProjection = viewProjection;
+    _numOccluders = 0;
+
+    if (_levels.empty()) {
+        int width = WIDTH;
+        int height = HEIGHT;
+        while (true) {
+            _levels.push_back({ width, height, std::vector<float>(width * height) });
+            if (width == 1 && height == 1) {
+                break;
+            }
+            width = std::max(1, (width + 1) / 2);
+            height = std::max(1, (height + 1) / 2);
+        }
+    }
+    std::fill(_levels[0].depths.begin(), _levels[0].depths.end(), 1.0f);
+}
+
+bool OcclusionBuffer::addOccluder(const glm::mat4& boxToWorld) {
+    glm::mat4 boxToClip = _viewProjection * boxToWorld;
+    glm::vec3 corners[NUM_BOX_CORNERS];
+    for (int i = 0; i < NUM_BOX_CORNERS; i++) {
+        glm::vec4 clip = boxToClip * glm::vec4(boxCorner(i), 1.0f);
+        if (isInFrontOfNearPlane(clip)) {
+            return false;
+        }
+        corners[i] = toScreen(clip);
+    }
+
+    // the back faces are rasterized too, but are always behind the front ones, so they never change the depths
+    for (int i = 0; i < NUM_BOX_FACES; i++) {
+        const int* face = BOX_FACES[i];
+        rasterizeTriangle(corners[face[0]], corners[face[1]], corners[face[2]]);
+        rasterizeTriangle(corners[face[0]], corners[face[2]], corners[face[3]]);
+    }
+    _numOccluders++;
+    return true;
+}
+
+void OcclusionBuffer::rasterizeTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+    float area = edge(a, b, c.x, c.y);
+    if (fabsf(area) < MIN_TRIANGLE_AREA) {
+        return;
+    }
+
+    glm::vec2 minPixel = glm::clamp(glm::floor(glm::min(glm::vec2(a), glm::min(glm::vec2(b), glm::vec2(c)))),
+                                    glm::vec2(0.0f), glm::vec2(WIDTH - 1, HEIGHT - 1));
+    glm::vec2 maxPixel = glm::clamp(glm::ceil(glm::max(glm::vec2(a), glm::max(glm::vec2(b), glm::vec2(c)))),
+                                    glm::vec2(0.0f), glm::vec2(WIDTH - 1, HEIGHT - 1));
+
+    // depth is linear in screen space, so the pixels' depths are interpolated from the corners' with barycentrics, which
+    // are the same whichever way the triangle winds
+    float invArea = 1.0f / area;
+    auto& depths = _levels[0].depths;
+    for (int y = (int)minPixel.y; y <= (int)maxPixel.y; y++) {
+        float pixelY = (float)y + 0.5f;
+        float* row = depths.data() + y * WIDTH;
+        for (int x = (int)minPixel.x; x <= (int)maxPixel.x; x++) {
+            float pixelX = (float)x + 0.5f;
+            float weightA = edge(b, c, pixelX, pixelY) * invArea;
+            float weightB = edge(c, a, pixelX, pixelY) * invArea;
+            float weightC = 1.0f - weightA - weightB;
+            if (weightA < 0.0f || weightB < 0.0f || weightC < 0.0f) {
+                continue;
+            }
+            float depth = weightA * a.z + weightB * b.z + weightC * c.z;
+            row[x] = std::min(row[x], depth);
+        }
+    }
+}
+
+void OcclusionBuffer::buildPyramid() {
+    for (size_t i = 1; i < _levels.size(); i++) {
+        const Level& source = _levels[i - 1];
+        Level& level = _levels[i];
+        for (int y = 0; y < level.height; y++) {
+            int sourceY0 = 2 * y;
+            int sourceY1 = std::min(sourceY0 + 1, source.height - 1);
+            for (int x = 0; x < level.width; x++) {
+                int sourceX0 = 2 * x;
+                int sourceX1 = std::min(sourceX0 + 1, source.width - 1);
+                level.depths[y * level.width + x] = std::max(
+                    std::max(source.depths[sourceY0 * source.width + sourceX0], source.depths[sourceY0 * source.width + sourceX1]),
+                    std::max(source.depths[sourceY1 * source.width + sourceX0], source.depths[sourceY1 * source.width + sourceX1]));
+            }
+        }
+    }
+}
+
+bool OcclusionBuffer::isOccluded(const AABox& box) const {
+    if (_numOccluders == 0) {
+        return false;
+    }
+
+    glm::vec2 minScreen(FLT_MAX);
+    glm::vec2 maxScreen(-FLT_MAX);
+    float minDepth = FLT_MAX;
+    const glm::vec3& minimum = box.getMinimumPoint();
+    const glm::vec3& dimensions = box.getDimensions();
+    for (int i = 0; i < NUM_BOX_CORNERS; i++) {
+        glm::vec3 corner = minimum + dimensions * (boxCorner(i) + glm::vec3(0.5f));
+        glm::vec4 clip = _viewProjection * glm::vec4(corner, 1.0f);
+        if (isInFrontOfNearPlane(clip)) {
+            return false;
+        }
+        glm::vec3 screen = toScreen(clip);
+        minScreen = glm::min(minScreen, glm::vec2(screen));
+        maxScreen = glm::max(maxScreen, glm::vec2(screen));
+        minDepth = std::min(minDepth, screen.z);
+    }
+
+    // the occluders only cover the pixels whose centers they cover, so a pixel is added around the box to keep the test
+    // conservative at their edges
+    glm::ivec2 minPixel = glm::ivec2(glm::floor(minScreen)) - glm::ivec2(1);
+    glm::ivec2 maxPixel = glm::ivec2(glm::floor(maxScreen)) + glm::ivec2(1);
+    if (maxPixel.x < 0 || maxPixel.y < 0 || minPixel.x >= WIDTH || minPixel.y >= HEIGHT) {
+        return false;
+    }
+    minPixel = glm::max(minPixel, glm::ivec2(0));
+    maxPixel = glm::min(maxPixel, glm::ivec2(WIDTH - 1, HEIGHT - 1));
+
+    // the level where the box covers at most 2x2 texels
+    size_t levelIndex = 0;
+    while (levelIndex + 1 < _levels.size() &&
+           ((maxPixel.x >> levelIndex) - (minPixel.x >> levelIndex) > 1 || (maxPixel.y >> levelIndex) - (minPixel.y >> levelIndex) > 1)) {
+        levelIndex++;
+    }
+
+    const Level& level = _levels[levelIndex];
+    for (int y = minPixel.y >> levelIndex; y <= (maxPixel.y >> levelIndex); y++) {
+        for (int x = minPixel.x >> levelIndex; x <= (maxPixel.x >> levelIndex); x++) {
+            if (minDepth <= level.depths[y * level.width + x] + DEPTH_BIAS) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
@@ -0,0 +1,62 @@
+//
+//  OcclusionBuffer.h
+//  render/src/render
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_render_OcclusionBuffer_h
+#define hifi_render_OcclusionBuffer_h
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <AABox.h>
+
+namespace render {
+
+    // A low resolution depth buffer that a few large occluders are rasterized into on the CPU, and its pyramid of
+    // farthest depths, to test whether item bounds are hidden behind them.  Depths are normalized device depths, -1 at
+    // the near plane and 1 at the far plane.
+    class OcclusionBuffer {
+    public:
+        static const int WIDTH = 256;
+        static const int HEIGHT = 128;
+
+        // Empties the buffer, for occluders and tests from this view
+        void clear(const glm::mat4& viewProjection);
+
+        // Rasterizes the unit cube centered on the origin, transformed by boxToWorld.  Occluders that reach in front of
+        // the near plane are skipped, returning false.
+        bool addOccluder(const glm::mat4& boxToWorld);
+
+        // Builds the depth pyramid, after the occluders are added and before the tests
+        void buildPyramid();
+
+        // True if the whole box is behind the occluders
+        bool isOccluded(const AABox& box) const;
+
+        int getNumOccluders() const { return _numOccluders; }
+
+    private:
+        struct Level {
+            int width;
+            int height;
+            std::vector<float> depths;
+        };
+
+        void rasterizeTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+
+        glm::mat4 _viewProjection;
+        std::vector<Level> _levels;
+        int _numOccluders { 0 };
+    };
+
+}
+
+#endif // hifi_render_OcclusionBuffer_h
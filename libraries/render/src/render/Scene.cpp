@@ -185,6 +185,7 @@ Scene::Scene(glm::vec3 origin, float size) :
     _masterSpatialTree(origin, size)
 {
     _items.push_back(Item()); // add the itemID #0 to nothing
+    _itemKeys.push_back(ItemKey());
 }
 
 Scene::~Scene() {
@@ -257,6 +258,7 @@ void Scene::processTransactionFrame(const Transaction& transaction) {
         ItemID maxID = _IDAllocator.load();
         if (maxID > _items.size()) {
             _items.resize(maxID + 100); // allocate the maxId and more
+            _itemKeys.resize(_items.size());
         }
         // Now we know for sure that we have enough items in the array to
         // capture anything coming from the transaction
@@ -310,6 +312,7 @@ void Scene::resetItems(const Transaction::Resets& transactions) {
         } else {
             _masterNonspatialSet.insert(itemId);
         }
+        _itemKeys[itemId] = item.getKey();
     }
 }
 
@@ -332,6 +335,7 @@ void Scene::removeItems(const Transaction::Removes& transactions) {
 
         // Kill it
         item.kill();
+        _itemKeys[removedID] = item.getKey();
     }
 }
 
@@ -377,6 +381,7 @@ void Scene::updateItems(const Transaction::Updates& transactions) {
                 _masterNonspatialSet.insert(updateID);
             }
         }
+        _itemKeys[updateID] = item.getKey();
     }
 }
 
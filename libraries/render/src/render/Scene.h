@@ -175,6 +175,11 @@ public:
     // Same as getItem, checking if the id is valid
     const Item getItemSafe(const ItemID& id) const { if (isAllocatedID(id)) { return _items[id]; } else { return Item(); } }
 
+    // The key of a particular item, from a packed array kept along with the items, so that filtering many items by key
+    // reads a few bytes each instead of the whole items
+    // WARNING, There is No check on the validity of the ID
+    const ItemKey& getItemKey(const ItemID& id) const { return _itemKeys[id]; }
+
     // Access the spatialized items
     const ItemSpatialTree& getSpatialTree() const { return _masterSpatialTree; }
 
@@ -215,6 +220,8 @@ protected:
     // database of items is protected for editing by a mutex
     std::mutex _itemsMutex;
     Item::Vector _items;
+    // the key of every item in _items, updated whenever a transaction changes it
+    std::vector<ItemKey> _itemKeys;
     ItemSpatialTree _masterSpatialTree;
     ItemIDSet _masterNonspatialSet;
 
@@ -306,6 +306,9 @@ public:
 
     void prepareShapeItem(Args* args, const ShapeKey& key, const Item& shape);
 
+    // Without setters, the pipeline and the state of the items are all there is to draw them, so they can be instanced
+    bool hasSetters() const { return (bool)_batchSetter || (bool)_itemSetter; }
+
 protected:
     friend class ShapePlumber;
 
@@ -342,6 +345,9 @@ public:
         BatchSetter batchSetter = nullptr, ItemSetter itemSetter = nullptr);
 
     const PipelinePointer pickPipeline(RenderArgs* args, const Key& key) const;
+    // Finds the pipeline of the key, creating it the first time if it's custom, without setting it up in a batch.
+    // pickPipeline() only reads the plumber for keys that were found before, so can be called from several threads.
+    const PipelinePointer findPipeline(RenderArgs* args, const Key& key) const;
 
 protected:
     void addPipelineHelper(const Filter& filter, Key key, int bit, const PipelinePointer& pipeline) const;
@@ -13,8 +13,13 @@
 #include "ShapePipeline.h"
 
 #include <assert.h>
+#include <unordered_map>
+
+#include <FrameArena.h>
+#include <ParallelFor.h>
 #include <ViewFrustum.h>
 
+
 using namespace render;
 
 struct ItemBoundSort {
@@ -45,8 +50,8 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
     assert(renderContext->args);
     assert(renderContext->args->hasViewFrustum());
 
-    auto& scene = renderContext->_scene;
     RenderArgs* args = renderContext->args;
+    const ViewFrustum& frustum = args->getViewFrustum();
 
 
     // Allocate and simply copy
@@ -54,14 +59,14 @@ void render::depthSortItems(const RenderContextPointer& renderContext, bool fron
     outItems.reserve(inItems.size());
 
 
-    // Make a local dataset of the center distance and closest point distance
-    std::vector<ItemBoundSort> itemBoundSorts;
-    itemBoundSorts.reserve(outItems.size());
+    // Make a local dataset of the center distance and closest point distance, in the memory of this thread's frame
+    FrameArena::Scope arenaScope(FrameArena::forCurrentThread());
+    ArenaVector<ItemBoundSort> itemBoundSorts { ArenaAllocator<ItemBoundSort>(arenaScope.getArena()) };
+    itemBoundSorts.reserve(inItems.size());
 
-    for (auto itemDetails : inItems) {
-        auto item = scene->getItem(itemDetails.id);
-        auto bound = itemDetails.bound; // item.getBound(args);
-        float distanceSquared = args->getViewFrustum().distanceToCameraSquared(bound.calcCenter());
+    for (const auto& itemDetails : inItems) {
+        const auto& bound = itemDetails.bound;
+        float distanceSquared = frustum.distanceToCameraSquared(bound.calcCenter());
 
         itemBoundSorts.emplace_back(ItemBoundSort(distanceSquared, distanceSquared, distanceSquared, itemDetails.id, bound));
     }
@@ -102,56 +107,84 @@ void PipelineSortShapes::run(const RenderContextPointer& renderContext, const It
     auto& scene = renderContext->_scene;
     outShapes.clear();
 
+    // look up each item's key once, and count the items of each key so their buckets are only allocated once
+    FrameArena::Scope arenaScope(FrameArena::forCurrentThread());
+    ArenaVector<ShapeKey> keys { ArenaAllocator<ShapeKey>(arenaScope.getArena()) };
+    keys.reserve(inItems.size());
+    using NumItemsPerKey = std::unordered_map<ShapeKey, size_t, ShapeKey::Hash, ShapeKey::KeyEqual,
+                                              ArenaAllocator<std::pair<const ShapeKey, size_t>>>;
+    NumItemsPerKey numItemsPerKey(0, ShapeKey::Hash(), ShapeKey::KeyEqual(),
+                                  NumItemsPerKey::allocator_type(arenaScope.getArena()));
     for (const auto& item : inItems) {
-        auto key = scene->getItem(item.id).getShapeKey();
-        auto outItems = outShapes.find(key);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(key, ItemBounds{})).first;
-            outItems->second.reserve(inItems.size());
-        }
-
-        outItems->second.push_back(item);
+        keys.push_back(scene->getItem(item.id).getShapeKey());
+        numItemsPerKey[keys.back()]++;
+    }
+    outShapes.reserve(numItemsPerKey.size());
+    for (const auto& numItems : numItemsPerKey) {
+        outShapes[numItems.first].reserve(numItems.second);
     }
 
-    for (auto& items : outShapes) {
-        items.second.shrink_to_fit();
+    for (size_t i = 0; i < inItems.size(); i++) {
+        outShapes[keys[i]].push_back(inItems[i]);
     }
 }
 
-void DepthSortShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
+namespace {
+
+// the shape buckets are sorted in parallel when they hold at least this many items between them
+const size_t MIN_PARALLEL_SORT_ITEMS = 4096;
+
+// Depth sorts each of inShapes' buckets into outShapes, and returns their bounds in bounds if it isn't null
+void depthSortShapes(const RenderContextPointer& renderContext, bool frontToBack, const ShapeBounds& inShapes,
+                     ShapeBounds& outShapes, AABox* bounds) {
     outShapes.clear();
     outShapes.reserve(inShapes.size());
 
+    // the buckets are all added first, so each can be sorted on its own thread
+    struct Bucket {
+        const ItemBounds* inItems;
+        ItemBounds* outItems;
+        AABox bounds;
+    };
+    std::vector<Bucket> buckets;
+    buckets.reserve(inShapes.size());
+    size_t numItems = 0;
     for (auto& pipeline : inShapes) {
-        auto& inItems = pipeline.second;
-        auto outItems = outShapes.find(pipeline.first);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(pipeline.first, ItemBounds{})).first;
+        buckets.push_back({ &pipeline.second, &outShapes[pipeline.first], AABox() });
+        numItems += pipeline.second.size();
+    }
+
+    auto sortBuckets = [&](size_t index, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+            depthSortItems(renderContext, frontToBack, *buckets[i].inItems, *buckets[i].outItems,
+                           bounds ? &buckets[i].bounds : nullptr);
         }
+    };
+    if (numItems >= MIN_PARALLEL_SORT_ITEMS) {
+        parallelFor(buckets.size(), 1, sortBuckets);
+    } else {
+        sortBuckets(0, 0, buckets.size());
+    }
 
-        depthSortItems(renderContext, _frontToBack, inItems, outItems->second);
+    if (bounds) {
+        for (const auto& bucket : buckets) {
+            *bounds += bucket.bounds;
+        }
     }
 }
 
+}
+
+void DepthSortShapes::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, ShapeBounds& outShapes) {
+    depthSortShapes(renderContext, _frontToBack, inShapes, outShapes, nullptr);
+}
+
 void DepthSortShapesAndComputeBounds::run(const RenderContextPointer& renderContext, const ShapeBounds& inShapes, Outputs& outputs) {
     auto& outShapes = outputs.edit0();
     auto& outBounds = outputs.edit1();
 
-    outShapes.clear();
-    outShapes.reserve(inShapes.size());
     outBounds = AABox();
-
-    for (auto& pipeline : inShapes) {
-        auto& inItems = pipeline.second;
-        auto outItems = outShapes.find(pipeline.first);
-        if (outItems == outShapes.end()) {
-            outItems = outShapes.insert(std::make_pair(pipeline.first, ItemBounds{})).first;
-        }
-        AABox bounds;
-
-        depthSortItems(renderContext, _frontToBack, inItems, outItems->second, &bounds);
-        outBounds += bounds;
-    }
+    depthSortShapes(renderContext, _frontToBack, inShapes, outShapes, &outBounds);
 }
 
 void DepthSortItems::run(const RenderContextPointer& renderContext, const ItemBounds& inItems, ItemBounds& outItems) {
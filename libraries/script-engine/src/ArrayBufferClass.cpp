@@ -171,10 +171,39 @@ void ArrayBufferClass::fromScriptValue(const QScriptValue& object, QByteArray& b
             byteArray = *buffer;
         }
     } else if (object.isObject()) {
-        // ArrayBuffer instance (or any JS class that supports coercion into QByteArray*)
-        if (QByteArray* buffer = qscriptvalue_cast<QByteArray*>(object.data())) {
-            byteArray = *buffer;
-        }
+        // ArrayBuffer, typed array or DataView instance
+        toByteArray(object, byteArray);
+    }
+}
+
+bool ArrayBufferClass::toByteArray(const QScriptValue& value, QByteArray& byteArray) {
+    if (!value.isObject()) {
+        return false;
+    }
+
+    // ArrayBuffer instance (or any JS class that supports coercion into QByteArray*)
+    if (QByteArray* buffer = qscriptvalue_cast<QByteArray*>(value.data())) {
+        byteArray = *buffer;
+        return true;
+    }
+
+    // typed arrays and DataViews keep their buffer and the range they cover in their data object
+    QScriptValue viewData = value.data();
+    if (!viewData.isObject()) {
+        return false;
+    }
+    QByteArray* buffer = qscriptvalue_cast<QByteArray*>(viewData.property(BUFFER_PROPERTY_NAME).data());
+    if (!buffer) {
+        return false;
+    }
+
+    int byteOffset = viewData.property(BYTE_OFFSET_PROPERTY_NAME).toInt32();
+    int byteLength = viewData.property(BYTE_LENGTH_PROPERTY_NAME).toInt32();
+    if (byteOffset == 0 && byteLength == buffer->size()) {
+        byteArray = *buffer;
+    } else {
+        byteArray = buffer->mid(byteOffset, byteLength);
     }
+    return true;
 }
 
@@ -45,6 +45,11 @@ public:
     QString name() const override;
     QScriptValue prototype() const override;
 
+    // Gets the bytes of an ArrayBuffer, typed array or DataView into byteArray, returning false for anything else. The
+    // result shares the buffer's data instead of copying it when the value covers the whole buffer, so handing it to
+    // native code costs nothing until one side writes to it.
+    static bool toByteArray(const QScriptValue& value, QByteArray& byteArray);
+
 
 private:
     static QScriptValue construct(QScriptContext* context, QScriptEngine* engine);
@@ -15,6 +15,7 @@
 
 #include <shared/QtHelpers.h>
 
+#include "ArrayBufferClass.h"
 #include "ScriptAudioInjector.h"
 #include "ScriptEngineLogging.h"
 
@@ -65,6 +66,36 @@ ScriptAudioInjector* AudioScriptingInterface::playSound(SharedSoundPointer sound
     }
 }
 
+ScriptAudioInjector* AudioScriptingInterface::playSamples(const QScriptValue& samples, int numChannels,
+                                                         const AudioInjectorOptions& injectorOptions) {
+    if (numChannels != 1 && numChannels != 2 && numChannels != 4) {
+        qCDebug(scriptengine) << "AudioScriptingInterface::playSamples called with" << numChannels << "channels.";
+        return nullptr;
+    }
+
+    QByteArray sampleBytes;
+    if (!ArrayBufferClass::toByteArray(samples, sampleBytes)) {
+        qCDebug(scriptengine) << "AudioScriptingInterface::playSamples called without an ArrayBuffer or typed array.";
+        return nullptr;
+    }
+
+    auto audioData = AudioData::make(numChannels, sampleBytes);
+    if (audioData->getNumSamples() == 0) {
+        return nullptr;
+    }
+
+    AudioInjectorOptions optionsCopy = injectorOptions;
+    optionsCopy.stereo = audioData->isStereo();
+    optionsCopy.ambisonic = audioData->isAmbisonic();
+    optionsCopy.localOnly = optionsCopy.localOnly || optionsCopy.ambisonic;  // force localOnly when Ambisonic
+
+    auto injector = DependencyManager::get<AudioInjectorManager>()->playSound(audioData, optionsCopy);
+    if (!injector) {
+        return nullptr;
+    }
+    return new ScriptAudioInjector(injector);
+}
+
 void AudioScriptingInterface::setStereoInput(bool stereo) {
     if (_localAudioInterface) {
         QMetaObject::invokeMethod(_localAudioInterface, "setIsStereoInput", Q_ARG(bool, stereo));
@@ -206,6 +206,28 @@ protected:
      */
     Q_INVOKABLE ScriptAudioInjector* playSystemSound(SharedSoundPointer sound);
 
+    /*@jsdoc
+     * Starts playing or "injecting" audio samples made by the script, in the same way as {@link Audio.playSound}. The 
+     * samples are read straight out of the buffer rather than copied, so a script that makes audio as it goes can hand over
+     * each buffer as it fills it.
+     * @function Audio.playSamples
+     * @param {ArrayBuffer|Int16Array} samples - 16-bit PCM samples at 24kHz, interleaved if there is more than one channel.
+     * @param {number} numChannels - The number of channels: <code>1</code> for mono, <code>2</code> for stereo, or 
+     *     <code>4</code> for ambisonic.
+     * @param {AudioInjector.AudioInjectorOptions} [injectorOptions={}] - Configures where and how the audio injector plays the 
+     *     samples.
+     * @returns {AudioInjector} The audio injector that plays the samples, or <code>null</code> if they couldn't be played.
+     * @example <caption>Play a second of a 440Hz tone.</caption>
+     * var SAMPLE_RATE = 24000;
+     * var samples = new Int16Array(SAMPLE_RATE);
+     * for (var i = 0; i < samples.length; i++) {
+     *     samples[i] = 8000 * Math.sin(2 * Math.PI * 440 * i / SAMPLE_RATE);
+     * }
+     * var injector = Audio.playSamples(samples, 1, { position: MyAvatar.position });
+     */
+    Q_INVOKABLE ScriptAudioInjector* playSamples(const QScriptValue& samples, int numChannels,
+        const AudioInjectorOptions& injectorOptions = AudioInjectorOptions());
+
     /*@jsdoc
      * Sets whether the audio input should be used in stereo. If the audio input doesn't support stereo then setting a value 
      * of <code>true</code> has no effect.
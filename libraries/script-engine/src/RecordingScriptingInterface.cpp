@@ -27,6 +27,7 @@
 #include <recording/Frame.h>
 #include <recording/ClipCache.h>
 
+#include "ArrayBufferClass.h"
 #include "ScriptEngineLogging.h"
 
 using namespace recording;
@@ -307,3 +308,48 @@ void RecordingScriptingInterface::loadLastRecording() {
     _player->play();
 }
 
+QByteArray RecordingScriptingInterface::getLastRecordingBuffer() {
+    if (QThread::currentThread() != thread()) {
+        QByteArray result;
+        BLOCKING_INVOKE_METHOD(this, "getLastRecordingBuffer",
+            Q_RETURN_ARG(QByteArray, result));
+        return result;
+    }
+
+    if (!_lastClip) {
+        qCDebug(scriptengine) << "There is no recording to get";
+        return QByteArray();
+    }
+
+    // the buffer is handed to the script as an ArrayBuffer as it is
+    return recording::Clip::toBuffer(_lastClip);
+}
+
+bool RecordingScriptingInterface::loadRecordingFromBuffer(const QScriptValue& buffer) {
+    // read on the script's thread; the bytes are shared with the script's buffer from here on
+    QByteArray clipData;
+    if (!ArrayBufferClass::toByteArray(buffer, clipData)) {
+        qCWarning(scriptengine) << "The argument is not an ArrayBuffer or typed array.";
+        return false;
+    }
+    return loadRecordingFromBytes(clipData);
+}
+
+bool RecordingScriptingInterface::loadRecordingFromBytes(const QByteArray& clipData) {
+    if (QThread::currentThread() != thread()) {
+        bool result;
+        BLOCKING_INVOKE_METHOD(this, "loadRecordingFromBytes",
+            Q_RETURN_ARG(bool, result),
+            Q_ARG(const QByteArray&, clipData));
+        return result;
+    }
+
+    auto clip = recording::NetworkClip::fromData(QUrl(), clipData);
+    if (clip->frameCount() == 0) {
+        qCDebug(scriptengine) << "The buffer doesn't hold a recording";
+        return false;
+    }
+
+    _player->queueClip(clip);
+    return true;
+}
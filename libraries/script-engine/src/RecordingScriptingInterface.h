@@ -352,6 +352,32 @@ public slots:
      */
     void loadLastRecording();
 
+    /*@jsdoc
+     * Gets the most recently made recording in the same form as it is saved to a file, to be sent on or stored by the script 
+     * without going through a file or the asset server.
+     * @function Recording.getLastRecordingBuffer
+     * @returns {ArrayBuffer} The recording, empty if there is no recording.
+     * @example <caption>Send a 5 second recording over a WebSocket.</caption>
+     * var webSocket = new WebSocket("ws://127.0.0.1:8080");
+     * Recording.startRecording();
+     * 
+     * Script.setTimeout(function () {
+     *     Recording.stopRecording();
+     *     webSocket.send(Recording.getLastRecordingBuffer());
+     * }, 5000);
+     */
+    QByteArray getLastRecordingBuffer();
+
+    /*@jsdoc
+     * Loads a recording from a buffer, such as one from {@link Recording.getLastRecordingBuffer|getLastRecordingBuffer} or a 
+     * WebSocket message, and queues it to be played back on your avatar. The recording is played straight out of the buffer 
+     * rather than copied.
+     * @function Recording.loadRecordingFromBuffer
+     * @param {ArrayBuffer|Uint8Array} buffer - The recording, in the same form as a recording file.
+     * @returns {boolean} <code>true</code> if the buffer held a recording, otherwise <code>false</code>.
+     */
+    bool loadRecordingFromBuffer(const QScriptValue& buffer);
+
 protected:
     using Mutex = std::recursive_mutex;
     using Locker = std::unique_lock<Mutex>;
@@ -369,6 +395,8 @@ protected:
 
     QSet<recording::NetworkClipLoaderPointer> _clipLoaders;
 
+    Q_INVOKABLE bool loadRecordingFromBytes(const QByteArray& clipData);
+
 private:
     void playClip(recording::NetworkClipLoaderPointer clipLoader, const QString& url, QScriptValue callback);
 };
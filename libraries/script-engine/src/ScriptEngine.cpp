@@ -11,9 +11,12 @@
 
 #include "ScriptEngine.h"
 
+#include <algorithm>
 #include <chrono>
+#include <limits>
 #include <thread>
 
+#include <QtCore/QAbstractEventDispatcher>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QEventLoop>
 #include <QtCore/QFileInfo>
@@ -43,6 +46,7 @@
 #include <AudioEffectOptions.h>
 #include <AvatarData.h>
 #include <DebugDraw.h>
+#include <MemoryAccounting.h>
 #include <EntityScriptingInterface.h>
 #include <MessagesClient.h>
 #include <NetworkAccessManager.h>
@@ -78,6 +82,7 @@
 #include "ModelScriptingInterface.h"
 
 #include <Profile.h>
+#include <ScriptProgramCache.h>
 
 #include "../../midi/src/Midi.h"        // FIXME why won't a simpler include work?
 #include "MIDIEvent.h"
@@ -101,6 +106,13 @@ static const QScriptValue::PropertyFlags READONLY_HIDDEN_PROP_FLAGS { READONLY_P
 
 static const bool HIFI_AUTOREFRESH_FILE_SCRIPTS { true };
 
+const uint64_t ScriptEngine::LONG_ENTITY_CALLBACK_USECS = 100 * USECS_PER_MSEC;
+const int ScriptEngine::MAX_TIMERS_PER_SCRIPT = 10000;
+const int ScriptEngine::THROTTLED_INTERVAL_MSECS = 100;
+
+// QtScript processes the engine's events every second while a script runs, which is when the watchdog gets to check on it
+static const int WATCHDOG_INTERVAL_MSECS = MSECS_PER_SECOND;
+
 Q_DECLARE_METATYPE(QScriptEngine::FunctionSignature)
 int functionSignatureMetaID = qRegisterMetaType<QScriptEngine::FunctionSignature>();
 
@@ -223,7 +235,6 @@ ScriptEngine::ScriptEngine(Context context, const QString& scriptContents, const
     BaseScriptEngine(),
     _context(context),
     _scriptContents(scriptContents),
-    _timerFunctionMap(),
     _fileNameString(fileNameString),
     _arrayBufferClass(new ArrayBufferClass(this)),
     _assetScriptingInterface(new AssetScriptingInterface(this))
@@ -313,7 +324,9 @@ bool ScriptEngine::isDebugMode() const {
 #endif
 }
 
-ScriptEngine::~ScriptEngine() {}
+ScriptEngine::~ScriptEngine() {
+    ScriptProgramCache::getInstance().releaseEngine(this);
+}
 
 void ScriptEngine::disconnectNonEssentialSignals() {
     disconnect();
@@ -742,6 +755,8 @@ void ScriptEngine::init() {
 
     registerGlobalObject("Entities", entityScriptingInterface.data());
     registerFunction("Entities", "getMultipleEntityProperties", EntityScriptingInterface::getMultipleEntityProperties);
+    registerFunction("Entities", "getMultipleEntityPropertyArrays", EntityScriptingInterface::getMultipleEntityPropertyArrays);
+    registerFunction("Entities", "editEntities", EntityScriptingInterface::editEntities);
     registerGlobalObject("Quat", &_quatLibrary);
     registerGlobalObject("Vec3", &_vec3Library);
     registerGlobalObject("Mat4", &_mat4Library);
@@ -1137,7 +1152,8 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
         maybeEmitUncaughtException("lint");
         return syntaxError;
     }
-    QScriptProgram program { sourceCode, fileName, lineNumber };
+    // compiled once for this engine however many times it is evaluated, e.g. by every entity sharing an entity script
+    QScriptProgram program = ScriptProgramCache::getInstance().getProgram(this, sourceCode, fileName, lineNumber);
     if (program.isNull()) {
         // can this happen?
         auto err = makeError("could not create QScriptProgram for " + fileName);
@@ -1155,6 +1171,8 @@ QScriptValue ScriptEngine::evaluate(const QString& sourceCode, const QString& fi
 }
 
 void ScriptEngine::run() {
+    // everything the script's thread allocates from here on is the script's
+    MemoryAccounting::Scope memoryScope(MemoryTag::Scripts);
     if (QThread::currentThread() != qApp->thread() && _context == Context::CLIENT_SCRIPT) {
         // Flag that we're allowed to access local HTML files on UI created from C++ calls on this thread
         // (because we're a client script)
@@ -1202,6 +1220,25 @@ void ScriptEngine::run() {
 
     std::chrono::microseconds totalUpdates(0);
 
+    // the thread is busy with the scripts for all but the time its event loop is blocked waiting for events
+    uint64_t blockedSince = 0;
+    uint64_t blockedUsecs = 0;
+    uint64_t lastFrameEnd = usecTimestampNow();
+    auto dispatcher = QAbstractEventDispatcher::instance();
+    auto aboutToBlock = connect(dispatcher, &QAbstractEventDispatcher::aboutToBlock, this, [&blockedSince] {
+        blockedSince = usecTimestampNow();
+    }, Qt::DirectConnection);
+    auto awake = connect(dispatcher, &QAbstractEventDispatcher::awake, this, [&blockedSince, &blockedUsecs] {
+        if (blockedSince != 0) {
+            blockedUsecs += usecTimestampNow() - blockedSince;
+            blockedSince = 0;
+        }
+    }, Qt::DirectConnection);
+
+    _watchdog = new QTimer(this);
+    connect(_watchdog, &QTimer::timeout, this, &ScriptEngine::checkWatchdog);
+    _watchdog->start(WATCHDOG_INTERVAL_MSECS);
+
     // TODO: Integrate this with signals/slots instead of reimplementing throttling for ScriptEngine
     while (!_isFinished) {
         auto beforeSleep = clock::now();
@@ -1224,6 +1261,9 @@ void ScriptEngine::run() {
         auto averageTimerPerFrame = _totalTimerExecution / thisFrame;
         auto averageTimerAndUpdate = averageUpdate + averageTimerPerFrame;
         auto sleepUntil = std::max(targetSleepUntil, beforeSleep + averageTimerAndUpdate);
+        if (isThrottled(EntityItemID())) {
+            sleepUntil = std::max(sleepUntil, beforeSleep + std::chrono::milliseconds(THROTTLED_INTERVAL_MSECS));
+        }
 
         // We don't want to actually sleep for too long, because it causes our scripts to hang
         // on shutdown and stop... so we want to loop and sleep until we've spent our time in
@@ -1279,6 +1319,13 @@ void ScriptEngine::run() {
             break;
         }
 
+        // fire the timers that came due while we weren't waiting on the timer wakeup
+        processTimers();
+
+        if (_isFinished) {
+            break;
+        }
+
         if (!_isFinished && entityScriptingInterface->getEntityPacketSender()->serversExist()) {
             // release the queue of edit entity messages.
             entityScriptingInterface->getEntityPacketSender()->releaseQueuedMessages();
@@ -1298,7 +1345,10 @@ void ScriptEngine::run() {
                 auto preUpdate = clock::now();
                 {
                     PROFILE_RANGE(script, "ScriptUpdate");
+                    _callbackStartUsecs = usecTimestampNow();
                     emit update(deltaTime);
+                    _callbackStartUsecs = 0;
+                    stopAbortedScript();
                 }
                 auto postUpdate = clock::now();
                 auto elapsed = (postUpdate - preUpdate);
@@ -1307,6 +1357,12 @@ void ScriptEngine::run() {
         }
         _lastUpdate = now;
 
+        auto frameEnd = usecTimestampNow();
+        auto frameUsecs = frameEnd - lastFrameEnd;
+        accountFrame(frameEnd, frameUsecs > blockedUsecs ? frameUsecs - blockedUsecs : 0);
+        lastFrameEnd = frameEnd;
+        blockedUsecs = 0;
+
         // only clear exceptions if we are not in the middle of evaluating
         if (!isEvaluating() && hasUncaughtException()) {
             qCWarning(scriptengine) << __FUNCTION__ << "---------- UNCAUGHT EXCEPTION --------";
@@ -1317,6 +1373,10 @@ void ScriptEngine::run() {
     }
     scriptInfoMessage("Script Engine stopping:" + getFilename());
 
+    disconnect(aboutToBlock);
+    disconnect(awake);
+    _watchdog->stop();
+
     stopAllTimers(); // make sure all our timers are stopped if the script is ending
     emit scriptEnding();
 
@@ -1349,32 +1409,31 @@ void ScriptEngine::run() {
 // NOTE: This is private because it must be called on the same thread that created the timers, which is why
 // we want to only call it in our own run "shutdown" processing.
 void ScriptEngine::stopAllTimers() {
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    int j {0};
-    while (i.hasNext()) {
-        i.next();
-        QTimer* timer = i.key();
-        qCDebug(scriptengine) << getFilename() << "stopAllTimers[" << j++ << "]";
-        stopTimer(timer);
+    if (!_timers.isEmpty()) {
+        qCDebug(scriptengine) << getFilename() << "stopAllTimers" << _timers.size();
+    }
+    for (auto it = _timers.cbegin(); it != _timers.cend(); ++it) {
+        _timerWheel.cancel(it.key());
+    }
+    _timers.clear();
+    _numTimersPerScript.clear();
+    _numTimers = 0;
+    if (_timerWakeup) {
+        _timerWakeup->stop();
     }
 }
 
 void ScriptEngine::stopAllTimersForEntityScript(const EntityItemID& entityID) {
      // We could maintain a separate map of entityID => QTimer, but someone will have to prove to me that it's worth the complexity. -HRS
-    QVector<QTimer*> toDelete;
-    QMutableHashIterator<QTimer*, CallbackData> i(_timerFunctionMap);
-    while (i.hasNext()) {
-        i.next();
-        if (i.value().definingEntityIdentifier != entityID) {
-            continue;
+    QVector<int> toDelete;
+    for (auto it = _timers.cbegin(); it != _timers.cend(); ++it) {
+        if (it.value().callback.definingEntityIdentifier == entityID) {
+            toDelete << it.key(); // don't delete while we're iterating. save it.
         }
-        QTimer* timer = i.key();
-        toDelete << timer; // don't delete while we're iterating. save it.
     }
-    for (auto timer:toDelete) { // now reap 'em
-        stopTimer(timer);
+    for (auto timerID : toDelete) { // now reap 'em
+        stopTimer(timerID);
     }
-
 }
 
 void ScriptEngine::stop(bool marshal) {
@@ -1427,7 +1486,23 @@ void ScriptEngine::updateMemoryCost(const qint64& deltaSize) {
     }
 }
 
-void ScriptEngine::timerFired() {
+uint64_t ScriptEngine::getTimerTick() const {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - _timerEpoch).count();
+}
+
+void ScriptEngine::processTimers() {
+    if (_timers.isEmpty()) {
+        return;
+    }
+
+    auto now = getTimerTick();
+    std::vector<TimerWheel::TimerID> expired;
+    _timerWheel.advance(now, expired);
+    if (expired.empty()) {
+        scheduleTimerWakeup();
+        return;
+    }
+
     {
         QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
         if (!scriptEngines || scriptEngines->isStopped()) {
@@ -1436,80 +1511,152 @@ void ScriptEngine::timerFired() {
         }
     }
 
-    QTimer* callingTimer = reinterpret_cast<QTimer*>(sender());
-    CallbackData timerData = _timerFunctionMap.value(callingTimer);
+    for (auto timerID : expired) {
+        // an earlier callback can have cleared it
+        auto it = _timers.find((int)timerID);
+        if (it == _timers.end()) {
+            continue;
+        }
 
-    if (!callingTimer->isActive()) {
-        // this timer is done, we can kill it
-        _timerFunctionMap.remove(callingTimer);
-        delete callingTimer;
-    }
+        auto lateness = now - it->expiry;
+        if (lateness > _maxTimerLatenessMsecs) {
+            _maxTimerLatenessMsecs = lateness;
+        }
 
-    // call the associated JS function, if it exists
-    if (timerData.function.isValid()) {
-        PROFILE_RANGE(script, __FUNCTION__);
-        auto preTimer = p_high_resolution_clock::now();
-        callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
-        auto postTimer = p_high_resolution_clock::now();
-        auto elapsed = (postTimer - preTimer);
-        _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
-    } else {
-        qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        CallbackData timerData = it->callback;
+        if (it->isSingleShot) {
+            // this timer is done, the callback clearing it is harmless
+            stopTimer((int)timerID);
+        } else {
+            // keep to the interval's cadence unless we've fallen a whole interval behind
+            auto interval = (uint64_t)std::max(it->intervalMS, 1);
+            if (isThrottled(timerData.definingEntityIdentifier)) {
+                interval = std::max(interval, (uint64_t)THROTTLED_INTERVAL_MSECS);
+            }
+            it->expiry = it->expiry + interval > now ? it->expiry + interval : now + interval;
+            _timerWheel.schedule(timerID, it->expiry);
+        }
+
+        // call the associated JS function, if it exists
+        if (timerData.function.isValid()) {
+            PROFILE_RANGE(script, "timerFired");
+            auto preTimer = p_high_resolution_clock::now();
+            callWithEnvironment(timerData.definingEntityIdentifier, timerData.definingSandboxURL, timerData.function, timerData.function, QScriptValueList());
+            auto postTimer = p_high_resolution_clock::now();
+            auto elapsed = (postTimer - preTimer);
+            _totalTimerExecution += std::chrono::duration_cast<std::chrono::microseconds>(elapsed);
+            ++_numTimersFired;
+        } else {
+            qCWarning(scriptengine) << "timerFired -- invalid function" << timerData.function.toVariant().toString();
+        }
     }
+
+    scheduleTimerWakeup();
 }
 
-QObject* ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
-    // create the timer, add it to the map, and start it
-    QTimer* newTimer = new QTimer(this);
-    newTimer->setSingleShot(isSingleShot);
+void ScriptEngine::scheduleTimerWakeup() {
+    if (!_timerWakeup) {
+        return;
+    }
+
+    // one wakeup for however many timers are due then, the run loop also catches them on each frame
+    auto nextExpiry = _timerWheel.getNextExpiry();
+    if (nextExpiry == TimerWheel::NO_EXPIRY) {
+        _timerWakeup->stop();
+        return;
+    }
+
+    auto now = getTimerTick();
+    auto delay = nextExpiry > now ? (int)std::min(nextExpiry - now, (uint64_t)std::numeric_limits<int>::max()) : 0;
 
     // The default timer type is not very accurate below about 200ms http://doc.qt.io/qt-5/qt.html#TimerType-enum
     static const int MIN_TIMEOUT_FOR_COARSE_TIMER = 200;
-    if (intervalMS < MIN_TIMEOUT_FOR_COARSE_TIMER) {
-        newTimer->setTimerType(Qt::PreciseTimer);
+    _timerWakeup->setTimerType(delay < MIN_TIMEOUT_FOR_COARSE_TIMER ? Qt::PreciseTimer : Qt::CoarseTimer);
+    _timerWakeup->start(delay);
+}
+
+int ScriptEngine::setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot) {
+    auto& numScriptTimers = _numTimersPerScript[currentEntityIdentifier];
+    if (numScriptTimers >= MAX_TIMERS_PER_SCRIPT) {
+        ++_numTimersRejected;
+        scriptWarningMessage(QString("Script.%1() ignored, the script already has %2 timers... parent script: %3")
+            .arg(isSingleShot ? "setTimeout" : "setInterval").arg(MAX_TIMERS_PER_SCRIPT).arg(getFilename()));
+        return 0;
     }
 
-    connect(newTimer, &QTimer::timeout, this, &ScriptEngine::timerFired);
+    if (!_timerWakeup) {
+        _timerWakeup = new QTimer(this);
+        _timerWakeup->setSingleShot(true);
+        connect(_timerWakeup, &QTimer::timeout, this, &ScriptEngine::processTimers);
 
-    // make sure the timer stops when the script does
-    connect(this, &ScriptEngine::scriptEnding, newTimer, &QTimer::stop);
+        // make sure the timers stop when the script does
+        connect(this, &ScriptEngine::scriptEnding, _timerWakeup, &QTimer::stop);
+    }
 
+    // handles are never 0, so a script can test them, and aren't reused until they wrap
+    int timerID = _nextTimerID;
+    do {
+        timerID = _nextTimerID;
+        _nextTimerID = _nextTimerID == std::numeric_limits<int>::max() ? 1 : _nextTimerID + 1;
+    } while (_timers.contains(timerID));
 
-    CallbackData timerData = { function, currentEntityIdentifier, currentSandboxURL };
-    _timerFunctionMap.insert(newTimer, timerData);
+    ScriptTimer timer;
+    timer.callback = { function, currentEntityIdentifier, currentSandboxURL };
+    timer.intervalMS = std::max(intervalMS, 0);
+    timer.isSingleShot = isSingleShot;
+    timer.expiry = getTimerTick() + timer.intervalMS;
+    _timers.insert(timerID, timer);
+    _timerWheel.schedule(timerID, timer.expiry);
+    ++numScriptTimers;
+    ++_numTimers;
 
-    newTimer->start(intervalMS);
-    return newTimer;
+    scheduleTimerWakeup();
+    return timerID;
 }
 
-QObject* ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
+int ScriptEngine::setInterval(const QScriptValue& function, int intervalMS) {
     QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
     if (!scriptEngines || scriptEngines->isStopped()) {
         scriptWarningMessage("Script.setInterval() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return 0; // bail early
     }
 
     return setupTimerWithInterval(function, intervalMS, false);
 }
 
-QObject* ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
+int ScriptEngine::setTimeout(const QScriptValue& function, int timeoutMS) {
     QSharedPointer<ScriptEngines> scriptEngines(_scriptEngines);
     if (!scriptEngines || scriptEngines->isStopped()) {
         scriptWarningMessage("Script.setTimeout() while shutting down is ignored... parent script:" + getFilename());
-        return NULL; // bail early
+        return 0; // bail early
     }
 
     return setupTimerWithInterval(function, timeoutMS, true);
 }
 
-void ScriptEngine::stopTimer(QTimer *timer) {
-    if (_timerFunctionMap.contains(timer)) {
-        timer->stop();
-        _timerFunctionMap.remove(timer);
-        delete timer;
-    } else {
-        qCDebug(scriptengine) << "stopTimer -- not in _timerFunctionMap" << timer;
+void ScriptEngine::stopTimer(int timerID) {
+    auto it = _timers.find(timerID);
+    if (it == _timers.end()) {
+        qCDebug(scriptengine) << "stopTimer -- not a running timer" << timerID;
+        return;
+    }
+
+    auto numScriptTimers = _numTimersPerScript.find(it->callback.definingEntityIdentifier);
+    if (numScriptTimers != _numTimersPerScript.end() && --numScriptTimers.value() <= 0) {
+        _numTimersPerScript.erase(numScriptTimers);
     }
+    _timerWheel.cancel(timerID);
+    _timers.erase(it);
+    --_numTimers;
+}
+
+ScriptEngine::TimerStats ScriptEngine::takeTimerStats() {
+    TimerStats stats;
+    stats.numTimers = _numTimers;
+    stats.numFired = _numTimersFired;
+    stats.numRejected = _numTimersRejected;
+    stats.maxLatenessMsecs = _maxTimerLatenessMsecs.exchange(0);
+    return stats;
 }
 
 QUrl ScriptEngine::resolvePath(const QString& include) const {
@@ -2593,6 +2740,9 @@ void ScriptEngine::unloadEntityScript(const EntityItemID& entityID, bool shouldR
         }
 
         stopAllTimersForEntityScript(entityID);
+
+        std::lock_guard<std::mutex> lock(_cpuAccountsMutex);
+        _entityCPUAccounts.remove(entityID);
     }
 }
 
@@ -2676,6 +2826,14 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     currentEntityIdentifier = entityID;
     currentSandboxURL = sandboxURL;
 
+    // entity scripts calling each other on this engine nest, only the outermost call is timed
+    bool timeCallback = !entityID.isNull() && _entityCallbackDepth++ == 0;
+    auto callbackStart = usecTimestampNow();
+    bool watchCallback = _callbackStartUsecs == 0;
+    if (watchCallback) {
+        _callbackStartUsecs = callbackStart;
+    }
+
 #if DEBUG_CURRENT_ENTITY
     QScriptValue oldData = this->globalObject().property("debugEntityID");
     this->globalObject().setProperty("debugEntityID", entityID.toScriptValue(this)); // Make the entityID available to javascript as a global.
@@ -2687,6 +2845,197 @@ void ScriptEngine::doWithEnvironment(const EntityItemID& entityID, const QUrl& s
     maybeEmitUncaughtException(!entityID.isNull() ? entityID.toString() : __FUNCTION__);
     currentEntityIdentifier = oldIdentifier;
     currentSandboxURL = oldSandboxURL;
+
+    if (!entityID.isNull()) {
+        --_entityCallbackDepth;
+    }
+    if (watchCallback) {
+        _callbackStartUsecs = 0;
+    }
+    if (timeCallback) {
+        auto now = usecTimestampNow();
+        auto elapsed = now - callbackStart;
+        bool isLong = elapsed > LONG_ENTITY_CALLBACK_USECS;
+        if (isLong) {
+            qCWarning(scriptengine) << "Entity script callback for" << entityID << "took" << elapsed / USECS_PER_MSEC << "ms";
+        }
+
+        std::unique_lock<std::mutex> lock(_entityCallbackStatsMutex);
+        _entityCallbackStats.busyUsecs += elapsed;
+        ++_entityCallbackStats.numCallbacks;
+        if (isLong) {
+            ++_entityCallbackStats.numLongCallbacks;
+        }
+        if (elapsed > _entityCallbackStats.longestUsecs) {
+            _entityCallbackStats.longestUsecs = elapsed;
+            _entityCallbackStats.longestEntityID = entityID;
+        }
+        lock.unlock();
+
+        bool isOverBudget;
+        float load;
+        {
+            std::lock_guard<std::mutex> accountsLock(_cpuAccountsMutex);
+            auto& account = _entityCPUAccounts[entityID];
+            account.account.add(now, elapsed);
+            isOverBudget = updateThrottling(account, now);
+            load = account.account.getLoad(now);
+        }
+        if (isOverBudget) {
+            stopEntityScriptOverBudget(entityID, QString("it took %1% of its script engine over %2 s")
+                .arg((int)(load * 100.0f)).arg(ScriptCPUAccount::WINDOW_SECONDS));
+        }
+    }
+    if (watchCallback) {
+        stopAbortedScript();
+    }
+}
+
+void ScriptEngine::stopAbortedScript() {
+    if (!_isCallbackAborted) {
+        return;
+    }
+    _isCallbackAborted = false;
+
+    auto reason = QString("a callback ran for longer than %1 ms").arg(getCPUBudget().maxCallbackUsecs / USECS_PER_MSEC);
+    if (!_abortedEntityID.isNull()) {
+        stopEntityScriptOverBudget(_abortedEntityID, reason);
+    } else if (_context == CLIENT_SCRIPT) {
+        scriptErrorMessage("Stopping the script, " + reason + ": " + getFilename());
+        stop();
+    }
+}
+
+void ScriptEngine::setCPUBudget(const CPUBudget& budget) {
+    std::lock_guard<std::mutex> lock(_cpuAccountsMutex);
+    _cpuBudget = budget;
+}
+
+ScriptEngine::CPUBudget ScriptEngine::getCPUBudget() const {
+    std::lock_guard<std::mutex> lock(_cpuAccountsMutex);
+    return _cpuBudget;
+}
+
+bool ScriptEngine::updateThrottling(CPUAccount& account, uint64_t now) {
+    auto load = account.account.getLoad(now);
+    bool wasThrottled = account.isThrottled;
+    account.isThrottled = _cpuBudget.softLoad > 0.0f && load > _cpuBudget.softLoad;
+    if (account.isThrottled && !wasThrottled) {
+        qCWarning(scriptengine) << "Throttling a script of" << getFilename() << "taking" << load << "of its thread";
+    }
+    return _cpuBudget.hardLoad > 0.0f && load > _cpuBudget.hardLoad;
+}
+
+bool ScriptEngine::isThrottled(const EntityItemID& entityID) const {
+    std::lock_guard<std::mutex> lock(_cpuAccountsMutex);
+    if (entityID.isNull()) {
+        return _cpuAccount.isThrottled;
+    }
+    auto account = _entityCPUAccounts.find(entityID);
+    return account != _entityCPUAccounts.end() && account->isThrottled;
+}
+
+void ScriptEngine::accountFrame(uint64_t now, uint64_t busyUsecs) {
+    bool isOverBudget = false;
+    float load;
+    {
+        std::lock_guard<std::mutex> lock(_cpuAccountsMutex);
+        _cpuAccount.account.add(now, busyUsecs);
+        // an entity script engine's scripts are held to their budgets one by one, its other scripts aren't going anywhere
+        if (_context == CLIENT_SCRIPT) {
+            isOverBudget = updateThrottling(_cpuAccount, now);
+        }
+        load = _cpuAccount.account.getLoad(now);
+    }
+    if (isOverBudget && !_isStopping) {
+        scriptErrorMessage(QString("Stopping the script, it took %1% of its thread over %2 s: %3")
+            .arg((int)(load * 100.0f)).arg(ScriptCPUAccount::WINDOW_SECONDS).arg(getFilename()));
+        stop();
+    }
+}
+
+void ScriptEngine::stopEntityScriptOverBudget(const EntityItemID& entityID, const QString& reason) {
+    EntityScriptDetails details;
+    if (!getEntityScriptDetails(entityID, details) || details.status != EntityScriptStatus::RUNNING) {
+        return;
+    }
+    scriptErrorMessage("Stopping the script of entity " + entityID.toString() + ", " + reason);
+
+    // its unload isn't called, that would only be more of the same
+    details.status = EntityScriptStatus::ERROR_RUNNING_SCRIPT;
+    details.errorInfo = "Stopped, " + reason;
+    details.lastModified = QDateTime::currentMSecsSinceEpoch();
+    setEntityScriptDetails(entityID, details);
+    stopAllTimersForEntityScript(entityID);
+    for (auto& handlersOnEntity : _registeredHandlers) {
+        for (auto& handlersForEvent : handlersOnEntity) {
+            for (int i = handlersForEvent.count() - 1; i >= 0; --i) {
+                if (handlersForEvent[i].definingEntityIdentifier == entityID) {
+                    handlersForEvent.removeAt(i);
+                }
+            }
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(_cpuAccountsMutex);
+    _entityCPUAccounts.remove(entityID);
+}
+
+void ScriptEngine::checkWatchdog() {
+    auto maxCallbackUsecs = getCPUBudget().maxCallbackUsecs;
+    if (_callbackStartUsecs == 0 || maxCallbackUsecs == 0 || _isCallbackAborted ||
+        usecTimestampNow() - _callbackStartUsecs < maxCallbackUsecs) {
+        return;
+    }
+
+    // the script running now is the one whose callback is taken to have hung, after it's unwound it's stopped
+    qCWarning(scriptengine) << "Aborting a callback of" << getFilename() << "in" << currentEntityIdentifier
+                            << "that's run for" << (usecTimestampNow() - _callbackStartUsecs) / USECS_PER_MSEC << "ms";
+    _isCallbackAborted = true;
+    _abortedEntityID = currentEntityIdentifier;
+    abortEvaluation();
+}
+
+ScriptEngine::CPUStats ScriptEngine::getCPUStats(int maxEntities) const {
+    auto now = usecTimestampNow();
+    CPUStats stats;
+    stats.engine.name = _fileNameString;
+    {
+        std::lock_guard<std::mutex> lock(_cpuAccountsMutex);
+        stats.engine.load = _cpuAccount.account.getLoad(now);
+        stats.engine.longestUsecs = _cpuAccount.account.getLongestUsecs();
+        stats.engine.isThrottled = _cpuAccount.isThrottled;
+
+        for (auto it = _entityCPUAccounts.begin(); it != _entityCPUAccounts.end(); ++it) {
+            ScriptCPUStats entity;
+            entity.entityID = it.key();
+            entity.load = it->account.getLoad(now);
+            entity.longestUsecs = it->account.getLongestUsecs();
+            entity.isThrottled = it->isThrottled;
+            stats.entities.push_back(entity);
+        }
+    }
+
+    auto numEntities = std::min(stats.entities.size(), (size_t)std::max(maxEntities, 0));
+    std::partial_sort(stats.entities.begin(), stats.entities.begin() + numEntities, stats.entities.end(),
+                      [](const ScriptCPUStats& a, const ScriptCPUStats& b) { return a.load > b.load; });
+    stats.entities.resize(numEntities);
+
+    QReadLocker locker { &_entityScriptsLock };
+    for (auto& entity : stats.entities) {
+        auto details = _entityScripts.find(entity.entityID);
+        if (details != _entityScripts.end()) {
+            entity.name = details->definingSandboxURL.toString();
+        }
+    }
+    return stats;
+}
+
+ScriptEngine::EntityCallbackStats ScriptEngine::takeEntityCallbackStats() {
+    std::lock_guard<std::mutex> lock(_entityCallbackStatsMutex);
+    EntityCallbackStats stats = _entityCallbackStats;
+    _entityCallbackStats = EntityCallbackStats();
+    return stats;
 }
 
 void ScriptEngine::callWithEnvironment(const EntityItemID& entityID, const QUrl& sandboxURL, QScriptValue function, QScriptValue thisObject, QScriptValueList args) {
@@ -17,6 +17,9 @@
 #ifndef hifi_ScriptEngine_h
 #define hifi_ScriptEngine_h
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -54,6 +57,8 @@
 #include "ConsoleScriptingInterface.h"
 #include "SettingHandle.h"
 #include "Profile.h"
+#include "ScriptCPUAccount.h"
+#include "TimerWheel.h"
 
 static const QString NO_SCRIPT("");
 
@@ -472,31 +477,33 @@ public:
      * @function Script.setInterval
      * @param {function} function - The function to call. This can be either the name of a function or an in-line definition.
      * @param {number} interval - The interval at which to call the function, in ms.
-     * @returns {object} A handle to the interval timer. This can be used in {@link Script.clearInterval}.
+     * @returns {number} A handle to the interval timer. This can be used in {@link Script.clearInterval}. <code>0</code> if
+     *     the timer couldn't be set because the script is stopping or has too many timers.
      * @example <caption>Print a message every second.</caption>
      * Script.setInterval(function () {
      *     print("Interval timer fired");
      * }, 1000);
     */
-    Q_INVOKABLE QObject* setInterval(const QScriptValue& function, int intervalMS);
+    Q_INVOKABLE int setInterval(const QScriptValue& function, int intervalMS);
 
     /*@jsdoc
      * Calls a function once, after a delay.
      * @function Script.setTimeout
      * @param {function} function - The function to call. This can be either the name of a function or an in-line definition.
      * @param {number} timeout - The delay after which to call the function, in ms.
-     * @returns {object} A handle to the timeout timer. This can be used in {@link Script.clearTimeout}.
+     * @returns {number} A handle to the timeout timer. This can be used in {@link Script.clearTimeout}. <code>0</code> if
+     *     the timer couldn't be set because the script is stopping or has too many timers.
      * @example <caption>Print a message once, after a second.</caption>
      * Script.setTimeout(function () {
      *     print("Timeout timer fired");
      * }, 1000);
      */
-    Q_INVOKABLE QObject* setTimeout(const QScriptValue& function, int timeoutMS);
+    Q_INVOKABLE int setTimeout(const QScriptValue& function, int timeoutMS);
 
     /*@jsdoc
      * Stops an interval timer set by {@link Script.setInterval|setInterval}.
      * @function Script.clearInterval
-     * @param {object} timer - The interval timer to stop.
+     * @param {number} timer - The interval timer to stop.
      * @example <caption>Stop an interval timer.</caption>
      * // Print a message every second.
      * var timer = Script.setInterval(function () {
@@ -509,12 +516,12 @@ public:
      *     Script.clearInterval(timer);
      * }, 10000);
      */
-    Q_INVOKABLE void clearInterval(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearInterval(int timer) { stopTimer(timer); }
 
     /*@jsdoc
      * Stops a timeout timer set by {@link Script.setTimeout|setTimeout}.
      * @function Script.clearTimeout
-     * @param {object} timer - The timeout timer to stop.
+     * @param {number} timer - The timeout timer to stop.
      * @example <caption>Stop a timeout timer.</caption>
      * // Print a message after two seconds.
      * var timer = Script.setTimeout(function () {
@@ -524,7 +531,7 @@ public:
      * // Uncomment the following line to stop the timer from firing.
      * //Script.clearTimeout(timer);
      */
-    Q_INVOKABLE void clearTimeout(QObject* timer) { stopTimer(reinterpret_cast<QTimer*>(timer)); }
+    Q_INVOKABLE void clearTimeout(int timer) { stopTimer(timer); }
 
     /*@jsdoc
      * Prints a message to the program log and emits {@link Script.printedMessage}.
@@ -694,6 +701,62 @@ public:
     bool getEntityScriptDetails(const EntityItemID& entityID, EntityScriptDetails &details) const;
     bool hasEntityScriptDetails(const EntityItemID& entityID) const;
 
+    // The time spent running entity script callbacks (preloads, method calls, timers and event handlers that belong to an
+    // entity), counted on the engine's thread and readable from any other.
+    struct EntityCallbackStats {
+        uint64_t busyUsecs { 0 };
+        uint32_t numCallbacks { 0 };
+        uint32_t numLongCallbacks { 0 }; // those that took longer than LONG_ENTITY_CALLBACK_USECS
+        uint64_t longestUsecs { 0 };
+        EntityItemID longestEntityID;
+    };
+    static const uint64_t LONG_ENTITY_CALLBACK_USECS;
+
+    // the stats since the last call, which starts counting again
+    EntityCallbackStats takeEntityCallbackStats();
+
+    // Script.setInterval and setTimeout timers, readable from any thread
+    struct TimerStats {
+        int numTimers { 0 };
+        uint64_t numFired { 0 };
+        uint64_t numRejected { 0 }; // refused because their script had MAX_TIMERS_PER_SCRIPT already
+        uint64_t maxLatenessMsecs { 0 }; // the furthest behind a timer has fired since the last call
+    };
+    static const int MAX_TIMERS_PER_SCRIPT;
+
+    TimerStats takeTimerStats();
+
+    // How much of the engine's thread a script can take over ScriptCPUAccount::WINDOW_SECONDS. A script past the soft budget
+    // is throttled: its timers and, for an Interface script, its frames come no more often than THROTTLED_INTERVAL_MSECS.
+    // A script past the hard budget, or with a callback that runs for longer than maxCallbackUsecs, is stopped. The script is
+    // each entity's script on an entity script engine and the whole engine on an Interface script engine. Budgets of 0
+    // aren't enforced.
+    struct CPUBudget {
+        float softLoad { 0.5f };
+        float hardLoad { 0.9f };
+        uint64_t maxCallbackUsecs { 10 * USECS_PER_SECOND };
+    };
+    static const int THROTTLED_INTERVAL_MSECS;
+
+    // can be called from any thread
+    void setCPUBudget(const CPUBudget& budget);
+    CPUBudget getCPUBudget() const;
+
+    struct ScriptCPUStats {
+        EntityItemID entityID; // null for the engine
+        QString name; // the script's file name, or the URL an entity's script was loaded from
+        float load { 0.0f }; // the share of the engine's thread over the window
+        uint64_t longestUsecs { 0 }; // the longest callback, or for the engine the longest its thread went without waiting
+        bool isThrottled { false };
+    };
+    struct CPUStats {
+        ScriptCPUStats engine; // all the scripts of the engine
+        std::vector<ScriptCPUStats> entities; // busiest first
+    };
+
+    // the engine's load and that of its busiest entity scripts, up to maxEntities of them, readable from any thread
+    CPUStats getCPUStats(int maxEntities) const;
+
     void setScriptEngines(QSharedPointer<ScriptEngines>& scriptEngines) { _scriptEngines = scriptEngines; }
 
     /*@jsdoc
@@ -936,16 +999,30 @@ protected:
     Q_INVOKABLE QString _requireResolve(const QString& moduleId, const QString& relativeTo = QString());
 
     QString logException(const QScriptValue& exception);
-    void timerFired();
+    void processTimers();
+    void scheduleTimerWakeup();
+    uint64_t getTimerTick() const;
     void stopAllTimers();
     void stopAllTimersForEntityScript(const EntityItemID& entityID);
+
+    struct CPUAccount {
+        ScriptCPUAccount account;
+        bool isThrottled { false };
+    };
+    // with _cpuAccountsMutex held, returns whether the account's script is past its hard budget
+    bool updateThrottling(CPUAccount& account, uint64_t now);
+    bool isThrottled(const EntityItemID& entityID) const;
+    void accountFrame(uint64_t now, uint64_t busyUsecs);
+    void stopEntityScriptOverBudget(const EntityItemID& entityID, const QString& reason);
+    void checkWatchdog();
+    void stopAbortedScript();
     void refreshFileScript(const EntityItemID& entityID);
     void updateEntityScriptStatus(const EntityItemID& entityID, const EntityScriptStatus& status, const QString& errorInfo = QString());
     void setEntityScriptDetails(const EntityItemID& entityID, const EntityScriptDetails& details);
     void setParentURL(const QString& parentURL) { _parentURL = parentURL; }
 
-    QObject* setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
-    void stopTimer(QTimer* timer);
+    int setupTimerWithInterval(const QScriptValue& function, int intervalMS, bool isSingleShot);
+    void stopTimer(int timerID);
 
     QHash<EntityItemID, RegisteredEventHandlers> _registeredHandlers;
     void forwardHandlerCall(const EntityItemID& entityID, const QString& eventName, QScriptValueList eventHanderArgs);
@@ -975,7 +1052,24 @@ protected:
     std::atomic<bool> _isRunning { false };
     std::atomic<bool> _isStopping { false };
     bool _isInitialized { false };
-    QHash<QTimer*, CallbackData> _timerFunctionMap;
+
+    // the script's timers are kept in a wheel ticking in milliseconds, with one QTimer to wake the engine for the next
+    struct ScriptTimer {
+        CallbackData callback;
+        int intervalMS { 0 };
+        bool isSingleShot { true };
+        uint64_t expiry { 0 };
+    };
+    QHash<int, ScriptTimer> _timers;
+    QHash<EntityItemID, int> _numTimersPerScript;
+    TimerWheel _timerWheel;
+    QTimer* _timerWakeup { nullptr };
+    int _nextTimerID { 1 };
+    std::chrono::steady_clock::time_point _timerEpoch { std::chrono::steady_clock::now() };
+    std::atomic<int> _numTimers { 0 };
+    std::atomic<uint64_t> _numTimersFired { 0 };
+    std::atomic<uint64_t> _numTimersRejected { 0 };
+    std::atomic<uint64_t> _maxTimerLatenessMsecs { 0 };
     QSet<QUrl> _includedURLs;
     mutable QReadWriteLock _entityScriptsLock { QReadWriteLock::Recursive };
     QHash<EntityItemID, EntityScriptDetails> _entityScripts;
@@ -1005,6 +1099,21 @@ protected:
 
     std::chrono::microseconds _totalTimerExecution { 0 };
 
+    int _entityCallbackDepth { 0 };
+    std::mutex _entityCallbackStatsMutex;
+    EntityCallbackStats _entityCallbackStats;
+
+    mutable std::mutex _cpuAccountsMutex;
+    CPUBudget _cpuBudget;
+    CPUAccount _cpuAccount;
+    QHash<EntityItemID, CPUAccount> _entityCPUAccounts;
+
+    // the outermost callback running on the engine's thread, which the watchdog aborts once it's run for too long
+    QTimer* _watchdog { nullptr };
+    uint64_t _callbackStartUsecs { 0 };
+    bool _isCallbackAborted { false };
+    EntityItemID _abortedEntityID;
+
     static const QString _SETTINGS_ENABLE_EXTENDED_MODULE_COMPAT;
     static const QString _SETTINGS_ENABLE_EXTENDED_EXCEPTIONS;
 
@@ -8,6 +8,8 @@
 
 #include "ScriptEngines.h"
 
+#include <algorithm>
+
 #include <QtCore/QStandardPaths>
 #include <QtCore/QSharedPointer>
 
@@ -33,6 +35,12 @@ static const QUrl DEFAULT_SCRIPTS_LOCATION { "file:///~//defaultScripts.js" };
 // Using a QVariantList so this is human-readable in the settings file
 static Setting::Handle<QVariantList> runningScriptsHandle(SETTINGS_KEY, { QVariant(DEFAULT_SCRIPTS_LOCATION) });
 
+// the shares of its thread a script can take before it's throttled and stopped, and how long one callback can run, 0 for none
+static Setting::Handle<float> scriptSoftCPUBudgetHandle("scriptSoftCPUBudget", ScriptEngine::CPUBudget().softLoad);
+static Setting::Handle<float> scriptHardCPUBudgetHandle("scriptHardCPUBudget", ScriptEngine::CPUBudget().hardLoad);
+static Setting::Handle<int> scriptMaxCallbackMsecsHandle("scriptMaxCallbackMsecs",
+                                                         (int)(ScriptEngine::CPUBudget().maxCallbackUsecs / USECS_PER_MSEC));
+
 const int RELOAD_ALL_SCRIPTS_TIMEOUT = 1000;
 
 
@@ -139,12 +147,44 @@ QUrl expandScriptUrl(const QUrl& rawScriptURL) {
 QObject* scriptsModel();
 
 void ScriptEngines::addScriptEngine(ScriptEnginePointer engine) {
+    ScriptEngine::CPUBudget budget;
+    budget.softLoad = std::max(scriptSoftCPUBudgetHandle.get(), 0.0f);
+    budget.hardLoad = std::max(scriptHardCPUBudgetHandle.get(), 0.0f);
+    budget.maxCallbackUsecs = (uint64_t)std::max(scriptMaxCallbackMsecsHandle.get(), 0) * USECS_PER_MSEC;
+    engine->setCPUBudget(budget);
+
     if (!_isStopped) {
         QMutexLocker locker(&_allScriptsMutex);
         _allKnownScriptEngines.insert(engine);
     }
 }
 
+std::vector<ScriptEngine::ScriptCPUStats> ScriptEngines::getScriptCPUStats(int maxScripts, float& totalLoad) {
+    std::vector<ScriptEngine::ScriptCPUStats> scripts;
+    totalLoad = 0.0f;
+    {
+        QMutexLocker locker(&_allScriptsMutex);
+        for (const auto& engine : _allKnownScriptEngines) {
+            auto stats = engine->getCPUStats(maxScripts);
+            totalLoad += stats.engine.load;
+            // an entity script engine is accounted by its scripts, the busiest of which could be anywhere in the list
+            if (engine->isClientScript()) {
+                scripts.push_back(stats.engine);
+            } else {
+                scripts.insert(scripts.end(), stats.entities.begin(), stats.entities.end());
+            }
+        }
+    }
+
+    auto numScripts = std::min(scripts.size(), (size_t)std::max(maxScripts, 0));
+    std::partial_sort(scripts.begin(), scripts.begin() + numScripts, scripts.end(),
+                      [](const ScriptEngine::ScriptCPUStats& a, const ScriptEngine::ScriptCPUStats& b) {
+        return a.load > b.load;
+    });
+    scripts.resize(numScripts);
+    return scripts;
+}
+
 void ScriptEngines::removeScriptEngine(ScriptEnginePointer engine) {
     // If we're not already in the middle of stopping all scripts, then we should remove ourselves
     // from the list of running scripts. We don't do this if we're in the process of stopping all scripts
@@ -77,6 +77,10 @@ public:
     QStringList getRunningScripts();
     ScriptEnginePointer getScriptEngine(const QUrl& scriptHash);
 
+    // The busiest scripts, up to maxScripts of them, busiest first: Interface scripts as a whole and entity scripts one by
+    // one. totalLoad is how many threads' worth of time the script engines took altogether.
+    std::vector<ScriptEngine::ScriptCPUStats> getScriptCPUStats(int maxScripts, float& totalLoad);
+
     ScriptsModel* scriptsModel() { return &_scriptsModel; };
     ScriptsModelFilter* scriptsModelFilter() { return &_scriptsModelFilter; };
 
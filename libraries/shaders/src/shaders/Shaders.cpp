@@ -142,19 +142,28 @@ Source& Source::operator=(const Source& other) {
     return *this;
 }
 
-const Source& Source::get(uint32_t shaderId) {
+const std::unordered_map<uint32_t, Source::Pointer>& Source::getAllById() {
     static std::once_flag once;
-    static const std::unordered_map<uint32_t, Source::Pointer> shadersById;
+    static const std::unordered_map<uint32_t, Source::Pointer> shaders;
     std::call_once(once, [] {
         initShadersResources();
-        auto& map = const_cast<std::unordered_map<uint32_t, Source::Pointer>&>(shadersById);
+        auto& map = const_cast<std::unordered_map<uint32_t, Source::Pointer>&>(shaders);
         for (const auto& shaderId : allShaders()) {
             map[shaderId] = loadSource(shaderId);
         }
     });
-    const auto itr = shadersById.find(shaderId);
+    return shaders;
+}
+
+void Source::loadAll() {
+    getAllById();
+}
+
+const Source& Source::get(uint32_t shaderId) {
+    const auto& shaders = getAllById();
+    const auto itr = shaders.find(shaderId);
     static const Source EMPTY_SHADER;
-    if (itr == shadersById.end()) {
+    if (itr == shaders.end()) {
         return EMPTY_SHADER;
     }
     return *(itr->second);
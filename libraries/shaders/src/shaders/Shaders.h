@@ -153,12 +153,16 @@ struct Source {
     bool valid() const { return !dialectSources.empty(); }
     static Source generate(const std::string& glsl) { throw std::runtime_error("Implement me"); }
     static const Source& get(uint32_t shaderId);
+    // Loads the sources and reflection of every shader, which the first get() otherwise does. Thread-safe, so startup can
+    // have it done off the main thread.
+    static void loadAll();
 
 private:
     // Disallow copy construction
     Source(const Source& other) = delete;
 
     static Source::Pointer loadSource(uint32_t shaderId) ;
+    static const std::unordered_map<uint32_t, Source::Pointer>& getAllById();
 
     bool doReplacement(String& source) const;
     const DialectVariantSource& getDialectVariantSource(Dialect dialect, Variant variant) const;
@@ -20,6 +20,7 @@
 #include <QtScript/QScriptContextInfo>
 
 #include "Profile.h"
+#include "ScriptProgramCache.h"
 
 const QString BaseScriptEngine::SCRIPT_EXCEPTION_FORMAT { "[%0] %1 in %2:%3" };
 const QString BaseScriptEngine::SCRIPT_BACKTRACE_SEP { "\n    " };
@@ -77,18 +78,19 @@ QScriptValue BaseScriptEngine::lintScript(const QString& sourceCode, const QStri
     if (!IS_THREADSAFE_INVOCATION(thread(), __FUNCTION__)) {
         return unboundNullValue();
     }
-    const auto syntaxCheck = checkSyntax(sourceCode);
-    if (syntaxCheck.state() != QScriptSyntaxCheckResult::Valid) {
+    // the same source is often linted by many engines, or many times by one, so the outcome is cached
+    const auto syntaxCheck = ScriptProgramCache::getInstance().checkSyntax(sourceCode);
+    if (!syntaxCheck.isValid) {
         auto err = globalObject().property("SyntaxError")
-            .construct(QScriptValueList({syntaxCheck.errorMessage()}));
+            .construct(QScriptValueList({syntaxCheck.errorMessage}));
         err.setProperty("fileName", fileName);
-        err.setProperty("lineNumber", syntaxCheck.errorLineNumber());
-        err.setProperty("expressionBeginOffset", syntaxCheck.errorColumnNumber());
+        err.setProperty("lineNumber", syntaxCheck.errorLineNumber);
+        err.setProperty("expressionBeginOffset", syntaxCheck.errorColumnNumber);
         err.setProperty("stack", currentContext()->backtrace().join(SCRIPT_BACKTRACE_SEP));
         {
-            const auto error = syntaxCheck.errorMessage();
-            const auto line = QString::number(syntaxCheck.errorLineNumber());
-            const auto column = QString::number(syntaxCheck.errorColumnNumber());
+            const auto error = syntaxCheck.errorMessage;
+            const auto line = QString::number(syntaxCheck.errorLineNumber);
+            const auto column = QString::number(syntaxCheck.errorColumnNumber);
             // for compatibility with legacy reporting
             const auto message = QString("[SyntaxError] %1 in %2:%3(%4)").arg(error, fileName, line, column);
             err.setProperty("formatted", message);
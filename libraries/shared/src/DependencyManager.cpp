@@ -11,8 +11,15 @@
 
 #include "DependencyManager.h"
 
+#include <cstdlib>
+
+#if defined(__GNUC__)
+#include <cxxabi.h>
+#endif
+
 #include "SharedUtil.h"
 #include "Finally.h"
+#include "Profile.h"
 
 static const char* const DEPENDENCY_PROPERTY_NAME = "com.highfidelity.DependencyMananger";
 
@@ -21,8 +28,69 @@ DependencyManager& DependencyManager::manager() {
     return *instance;
 }
 
+static QString typeName(const std::type_info& type) {
+#if defined(__GNUC__)
+    int status = 0;
+    char* demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+    if (demangled) {
+        QString name(demangled);
+        free(demangled);
+        return name;
+    }
+#endif
+    // MSVC's names are readable already, past the kind of type
+    QString name(type.name());
+    for (const QString& kind : { QStringLiteral("class "), QStringLiteral("struct ") }) {
+        if (name.startsWith(kind)) {
+            name.remove(0, kind.length());
+        }
+    }
+    return name;
+}
+
+DependencyManager::ConstructionTrace::ConstructionTrace(const std::type_info& type) {
+    if (tracing::Tracer::isActive() && trace_startup().isDebugEnabled()) {
+        _name = typeName(type);
+        syncBegin(trace_startup(), _name, "");
+    }
+}
+
+DependencyManager::ConstructionTrace::~ConstructionTrace() {
+    if (!_name.isEmpty()) {
+        syncEnd(trace_startup(), _name, "");
+    }
+}
+
 QSharedPointer<Dependency> DependencyManager::safeGet(size_t hashCode) const {
     QMutexLocker lock(&_instanceHashMutex);
     return _instanceHash.value(hashCode);
 }
 
+
+const QWeakPointer<Dependency>* DependencyManager::fillSlot(Slot& slot, size_t hashCode) {
+    QMutexLocker lock(&_instanceHashMutex);
+
+    // another thread may have filled it while this one waited for the lock
+    const QWeakPointer<Dependency>* instance = slot.instance.load(std::memory_order_relaxed);
+    if (instance) {
+        return instance;
+    }
+
+    _slotInstances.push_back(std::make_unique<QWeakPointer<Dependency>>(_instanceHash.value(hashCode)));
+    instance = _slotInstances.back().get();
+    if (!slot.isRegistered) {
+        _slots[hashCode].push_back(&slot);
+        slot.isRegistered = true;
+    }
+    slot.instance.store(instance, std::memory_order_release);
+    return instance;
+}
+
+void DependencyManager::emptySlots(size_t hashCode) {
+    auto slots = _slots.find(hashCode);
+    if (slots != _slots.end()) {
+        for (Slot* slot : slots.value()) {
+            slot->instance.store(nullptr, std::memory_order_release);
+        }
+    }
+}
@@ -19,8 +19,11 @@
 #include <QWeakPointer>
 #include <QMutex>
 
+#include <atomic>
 #include <functional>
+#include <memory>
 #include <typeinfo>
+#include <vector>
 
 #define SINGLETON_DEPENDENCY \
     friend class ::DependencyManager;
@@ -79,16 +82,42 @@ public:
     static void prepareToExit() { manager()._exiting = true; }
 
 private:
+    // Where get<T>() and isSet<T>() keep the instance of their type once they've looked it up, so that after the first
+    // call they are a single acquire load and take no lock. An instance that isn't set is kept too, as a null pointer.
+    // set() and destroy() empty the slots of the instance they replace, and the next call looks it up again.
+    struct Slot {
+        std::atomic<const QWeakPointer<Dependency>*> instance { nullptr };
+        bool isRegistered { false };
+    };
+
     static DependencyManager& manager();
 
+    // traces the construction of an instance as a range under trace.startup, named by its type
+    class ConstructionTrace {
+    public:
+        ConstructionTrace(const std::type_info& type);
+        ~ConstructionTrace();
+
+    private:
+        QString _name;
+    };
+
     template<typename T>
     size_t getHashCode() const;
 
     QSharedPointer<Dependency> safeGet(size_t hashCode) const;
 
+    const QWeakPointer<Dependency>* fillSlot(Slot& slot, size_t hashCode);
+    // called with the instance hash locked
+    void emptySlots(size_t hashCode);
+
     QHash<size_t, QSharedPointer<Dependency>> _instanceHash;
     QHash<size_t, size_t> _inheritanceHash;
 
+    QHash<size_t, std::vector<Slot*>> _slots;
+    // a slot's readers may still be reading the instance it held after it is emptied, so those are kept until exit
+    std::vector<std::unique_ptr<QWeakPointer<Dependency>>> _slotInstances;
+
     mutable QRecursiveMutex _instanceHashMutex;
     mutable QMutex _inheritanceHashMutex;
 
@@ -98,11 +127,15 @@ private:
 template <typename T>
 QSharedPointer<T> DependencyManager::get() {
     static size_t hashCode = manager().getHashCode<T>();
-    static QWeakPointer<T> instance;
+    static Slot slot;
 
-    if (instance.isNull()) {
-        instance = qSharedPointerCast<T>(manager().safeGet(hashCode));
+    const QWeakPointer<Dependency>* slotInstance = slot.instance.load(std::memory_order_acquire);
+    if (!slotInstance) {
+        slotInstance = manager().fillSlot(slot, hashCode);
+    }
+    QSharedPointer<T> instance = qSharedPointerCast<T>(slotInstance->toStrongRef());
 
+    if (instance.isNull()) {
 #ifndef QT_NO_DEBUG
         // debug builds...
         if (instance.isNull()) {
@@ -118,15 +151,19 @@ QSharedPointer<T> DependencyManager::get() {
 #endif
     }
 
-    return instance.toStrongRef();
+    return instance;
 }
 
 template <typename T>
 bool DependencyManager::isSet() {
     static size_t hashCode = manager().getHashCode<T>();
+    static Slot slot;
 
-    QSharedPointer<Dependency> instance = manager().safeGet(hashCode);
-    return !instance.isNull();
+    const QWeakPointer<Dependency>* slotInstance = slot.instance.load(std::memory_order_acquire);
+    if (!slotInstance) {
+        slotInstance = manager().fillSlot(slot, hashCode);
+    }
+    return !slotInstance->isNull();
 }
 
 template <typename T, typename ...Args>
@@ -140,8 +177,10 @@ QSharedPointer<T> DependencyManager::set(Args&&... args) {
         iter.value().clear();
     }
 
+    ConstructionTrace trace(typeid(T));
     QSharedPointer<T> newInstance(new T(args...), &T::customDeleter);
     manager()._instanceHash.insert(hashCode, newInstance);
+    manager().emptySlots(hashCode);
 
     return newInstance;
 }
@@ -157,8 +196,10 @@ QSharedPointer<T> DependencyManager::set(Args&&... args) {
         iter.value().clear();
     }
 
+    ConstructionTrace trace(typeid(I));
     QSharedPointer<T> newInstance(new I(args...), &I::customDeleter);
     manager()._instanceHash.insert(hashCode, newInstance);
+    manager().emptySlots(hashCode);
 
     return newInstance;
 }
@@ -169,6 +210,7 @@ void DependencyManager::destroy() {
 
     QMutexLocker lock(&manager()._instanceHashMutex);
     QSharedPointer<Dependency> shared = manager()._instanceHash.take(hashCode);
+    manager().emptySlots(hashCode);
     QWeakPointer<Dependency> weak = shared;
     shared.clear();
 
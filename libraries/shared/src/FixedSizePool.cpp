@@ -0,0 +1,78 @@
+//
+//  FixedSizePool.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FixedSizePool.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+
+static size_t alignUp(size_t size, size_t alignment) {
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+FixedSizePool::FixedSizePool(size_t slotSize, size_t slotAlignment, size_t slotsPerBlock) :
+    _slotSize(alignUp(std::max(slotSize, sizeof(FreeSlot)), std::max(slotAlignment, alignof(FreeSlot)))),
+    _slotAlignment(std::max(slotAlignment, alignof(FreeSlot))),
+    _slotsPerBlock(slotsPerBlock)
+{
+    assert((_slotAlignment & (_slotAlignment - 1)) == 0);
+}
+
+void* FixedSizePool::allocate() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_freeSlots) {
+        // the block has room to align its first slot, the rest follow at the slot size
+        _blocks.emplace_back(new char[_slotSize * _slotsPerBlock + _slotAlignment]);
+        MemoryAccounting::add(_tag, _slotSize * _slotsPerBlock + _slotAlignment);
+        uintptr_t base = (uintptr_t)_blocks.back().get();
+        char* first = (char*)alignUp(base, _slotAlignment);
+        // thread the slots in address order, so a run of allocations is laid out in memory like it was made
+        for (size_t i = _slotsPerBlock; i > 0; --i) {
+            auto slot = reinterpret_cast<FreeSlot*>(first + (i - 1) * _slotSize);
+            slot->next = _freeSlots;
+            _freeSlots = slot;
+        }
+    }
+    FreeSlot* slot = _freeSlots;
+    _freeSlots = slot->next;
+    ++_numSlotsInUse;
+    return slot;
+}
+
+void FixedSizePool::deallocate(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto slot = static_cast<FreeSlot*>(pointer);
+    slot->next = _freeSlots;
+    _freeSlots = slot;
+    --_numSlotsInUse;
+}
+
+size_t FixedSizePool::getNumSlotsInUse() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _numSlotsInUse;
+}
+
+size_t FixedSizePool::getCapacityBytes() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _blocks.size() * (_slotSize * _slotsPerBlock + _slotAlignment);
+}
+
+void FixedSizePool::setMemoryTag(MemoryTag tag) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    size_t capacity = _blocks.size() * (_slotSize * _slotsPerBlock + _slotAlignment);
+    MemoryAccounting::remove(_tag, capacity);
+    MemoryAccounting::add(tag, capacity);
+    _tag = tag;
+}
@@ -0,0 +1,102 @@
+//
+//  FixedSizePool.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FixedSizePool_h
+#define hifi_FixedSizePool_h
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "MemoryAccounting.h"
+
+// Hands out slots of one size from big blocks, so that hundreds of thousands of small objects of a kind, like octree
+// elements, cost neither a heap block header each nor a trip to malloc, and end up next to each other in memory.
+// Freed slots are kept for the next allocation; the blocks are only returned when the pool is destroyed.
+// Thread safe: objects are often created by one thread and released by another.
+class FixedSizePool {
+public:
+    static const size_t DEFAULT_SLOTS_PER_BLOCK = 256;
+
+    FixedSizePool(size_t slotSize, size_t slotAlignment, size_t slotsPerBlock = DEFAULT_SLOTS_PER_BLOCK);
+
+    void* allocate();
+    void deallocate(void* slot);
+
+    size_t getSlotSize() const { return _slotSize; }
+    size_t getNumSlotsInUse() const;
+    // the memory the pool holds, used or not
+    size_t getCapacityBytes() const;
+
+    // accounts the pool's blocks, those it already has included, to the tag, Other until it's set
+    void setMemoryTag(MemoryTag tag);
+
+    // the pool shared by everything of this size and alignment
+    template <size_t Size, size_t Alignment>
+    static FixedSizePool& forSize() {
+        static FixedSizePool* pool = new FixedSizePool(Size, Alignment); // never destroyed, objects may outlive statics
+        return *pool;
+    }
+
+private:
+    FixedSizePool(const FixedSizePool&) = delete;
+    FixedSizePool& operator=(const FixedSizePool&) = delete;
+
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    const size_t _slotSize;
+    const size_t _slotAlignment;
+    const size_t _slotsPerBlock;
+
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<char[]>> _blocks;
+    FreeSlot* _freeSlots { nullptr };
+    size_t _numSlotsInUse { 0 };
+    MemoryTag _tag { MemoryTag::Other };
+};
+
+// An STL allocator that takes single objects from the FixedSizePool for their size, for std::allocate_shared and
+// node based containers. Arrays still go to the heap.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    PoolAllocator() {}
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) {}
+
+    T* allocate(size_t count) {
+        if (count == 1) {
+            return static_cast<T*>(getPool().allocate());
+        }
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+    void deallocate(T* pointer, size_t count) {
+        if (count == 1) {
+            getPool().deallocate(pointer);
+        } else {
+            ::operator delete(pointer);
+        }
+    }
+
+    static FixedSizePool& getPool() { return FixedSizePool::forSize<sizeof(T), alignof(T)>(); }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const { return true; }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const { return false; }
+};
+
+#endif // hifi_FixedSizePool_h
@@ -0,0 +1,127 @@
+//
+//  FrameArena.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <cassert>
+
+std::atomic<uint64_t> FrameArena::_threadArenaAllocations { 0 };
+std::atomic<uint64_t> FrameArena::_threadArenaBytes { 0 };
+std::atomic<uint64_t> FrameArena::_threadArenaBlockAllocations { 0 };
+
+FrameArena::Scope::Scope(FrameArena& arena) :
+    _arena(arena),
+    _block(arena._block),
+    _offset(arena._offset)
+{
+    ++_arena._numScopes;
+}
+
+FrameArena::Scope::~Scope() {
+    _arena.rewind(_block, _offset);
+    --_arena._numScopes;
+
+    if (_arena._isThreadArena && _arena._numScopes == 0) {
+        // nothing outlives a thread arena's outermost scope, so it's the time to merge its blocks
+        _arena.reset();
+
+        Stats stats = _arena.takeStats();
+        _threadArenaAllocations += stats.numAllocations;
+        _threadArenaBytes += stats.numBytes;
+        _threadArenaBlockAllocations += stats.numBlockAllocations;
+    }
+}
+
+FrameArena::FrameArena(size_t blockSize, MemoryTag tag) :
+    _blockSize(blockSize),
+    _tag(tag)
+{
+}
+
+FrameArena::~FrameArena() {
+    MemoryAccounting::remove(_tag, getCapacity());
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment) {
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    ++_stats.numAllocations;
+    _stats.numBytes += size;
+
+    while (_block < _blocks.size()) {
+        auto& block = _blocks[_block];
+        uintptr_t base = (uintptr_t)block.data.get();
+        size_t offset = (size_t)(((base + _offset + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base);
+        if (offset + size <= block.size) {
+            _offset = offset + size;
+            return block.data.get() + offset;
+        }
+        // blocks kept from before a scope rewound are reused before any new one is allocated
+        ++_block;
+        _offset = 0;
+    }
+
+    size_t blockSize = std::max(_blockSize, size + alignment);
+    _blocks.push_back({ std::unique_ptr<char[]>(new char[blockSize]), blockSize });
+    ++_stats.numBlockAllocations;
+    MemoryAccounting::add(_tag, blockSize);
+    _block = _blocks.size() - 1;
+
+    auto& block = _blocks.back();
+    uintptr_t base = (uintptr_t)block.data.get();
+    size_t offset = (size_t)(((base + alignment - 1) & ~(uintptr_t)(alignment - 1)) - base);
+    _offset = offset + size;
+    return block.data.get() + offset;
+}
+
+void FrameArena::rewind(size_t block, size_t offset) {
+    _block = block;
+    _offset = offset;
+}
+
+void FrameArena::reset() {
+    assert(_numScopes == 0);
+    if (_blocks.size() > 1) {
+        size_t capacity = getCapacity();
+        _blocks.clear();
+        _blocks.push_back({ std::unique_ptr<char[]>(new char[capacity]), capacity });
+        ++_stats.numBlockAllocations;
+    }
+    rewind(0, 0);
+}
+
+size_t FrameArena::getCapacity() const {
+    size_t capacity = 0;
+    for (auto& block : _blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+FrameArena::Stats FrameArena::takeStats() {
+    Stats stats = _stats;
+    _stats = Stats();
+    return stats;
+}
+
+FrameArena& FrameArena::forCurrentThread() {
+    thread_local FrameArena arena(DEFAULT_BLOCK_SIZE);
+    arena._isThreadArena = true;
+    return arena;
+}
+
+FrameArena::Stats FrameArena::takeThreadArenaStats() {
+    Stats stats;
+    stats.numAllocations = _threadArenaAllocations.exchange(0);
+    stats.numBytes = _threadArenaBytes.exchange(0);
+    stats.numBlockAllocations = _threadArenaBlockAllocations.exchange(0);
+    return stats;
+}
@@ -0,0 +1,138 @@
+//
+//  FrameArena.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrameArena_h
+#define hifi_FrameArena_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "MemoryAccounting.h"
+
+// A monotonic arena for the short lived allocations of a frame: allocating bumps a pointer, freeing does nothing, and
+// everything is freed at once by reset() or when a Scope ends. The memory is kept for the next frame, so a frame
+// that allocates no more than the one before makes no heap allocations at all.
+// An arena is used by one thread at a time; work that spreads over worker threads uses forCurrentThread().
+// Its blocks are accounted to the memory tag it's created with.
+class FrameArena {
+public:
+    static const size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    struct Stats {
+        uint64_t numAllocations { 0 };
+        uint64_t numBytes { 0 };
+        // the heap allocations the arena made itself, which stop once it has grown to the size of a frame
+        uint64_t numBlockAllocations { 0 };
+    };
+
+    // Marks where the arena is, and frees everything allocated after that when it goes out of scope
+    class Scope {
+    public:
+        Scope(FrameArena& arena);
+        ~Scope();
+
+        FrameArena& getArena() const { return _arena; }
+
+    private:
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        FrameArena& _arena;
+        size_t _block;
+        size_t _offset;
+    };
+
+    FrameArena(size_t blockSize = DEFAULT_BLOCK_SIZE, MemoryTag tag = MemoryTag::Other);
+    ~FrameArena();
+
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+    // constructs an object that is never destroyed, only freed with the rest of the arena
+    template <typename T, typename... Args>
+    T* create(Args&&... args) {
+        static_assert(std::is_trivially_destructible<T>::value, "arena objects are freed without being destroyed");
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    // frees everything, and merges the blocks into one big enough for a frame like this one
+    void reset();
+
+    size_t getCapacity() const;
+
+    // returns the stats since they were last taken, and starts counting again
+    Stats takeStats();
+
+    // the calling thread's own arena, which is only ever used through a Scope
+    static FrameArena& forCurrentThread();
+
+    // the stats of all the threads' arenas, gathered as their scopes end
+    static Stats takeThreadArenaStats();
+
+private:
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    struct Block {
+        std::unique_ptr<char[]> data;
+        size_t size;
+    };
+
+    void rewind(size_t block, size_t offset);
+
+    const size_t _blockSize;
+    const MemoryTag _tag;
+    std::vector<Block> _blocks;
+    size_t _block { 0 };
+    size_t _offset { 0 };
+    int _numScopes { 0 };
+    bool _isThreadArena { false };
+    Stats _stats;
+
+    static std::atomic<uint64_t> _threadArenaAllocations;
+    static std::atomic<uint64_t> _threadArenaBytes;
+    static std::atomic<uint64_t> _threadArenaBlockAllocations;
+};
+
+// An STL allocator that takes its memory from a FrameArena, so containers built and dropped within a frame
+// stop costing a malloc and free each time they grow. Qt containers have no allocator parameter, so this is for
+// the std ones only.
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+
+    ArenaAllocator(FrameArena& arena) : _arena(&arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) : _arena(other.getArena()) {}
+
+    T* allocate(size_t count) { return static_cast<T*>(_arena->allocate(count * sizeof(T), alignof(T))); }
+    void deallocate(T* pointer, size_t count) {}
+
+    FrameArena* getArena() const { return _arena; }
+
+    template <typename U>
+    bool operator==(const ArenaAllocator<U>& other) const { return _arena == other.getArena(); }
+    template <typename U>
+    bool operator!=(const ArenaAllocator<U>& other) const { return _arena != other.getArena(); }
+
+private:
+    FrameArena* _arena;
+};
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
+
+#endif // hifi_FrameArena_h
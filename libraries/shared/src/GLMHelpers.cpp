@@ -231,6 +231,77 @@ int unpackOrientationQuatFromSixBytes(const unsigned char* buffer, glm::quat& qu
     return 6;
 }
 
+int packOrientationQuatToFourBytes(unsigned char* buffer, const glm::quat& quatInput) {
+
+    // find largest component
+    uint8_t largestComponent = 0;
+    for (int i = 1; i < 4; i++) {
+        if (fabs(quatInput[i]) > fabs(quatInput[largestComponent])) {
+            largestComponent = i;
+        }
+    }
+
+    // ensure that the sign of the dropped component is always negative.
+    glm::quat q = quatInput[largestComponent] > 0 ? -quatInput : quatInput;
+
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const uint32_t NUM_BITS_PER_COMPONENT = 10;
+    const uint32_t RANGE = (1 << NUM_BITS_PER_COMPONENT) - 1;
+
+    // round the smallest three components to integers, with the largestComponent in the top 2 bits
+    uint32_t bits = largestComponent;
+    for (int i = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            // transform component into 0..1 range.
+            float value = glm::clamp((q[i] + MAGNITUDE) / (2.0f * MAGNITUDE), 0.0f, 1.0f);
+
+            // quantize 0..1 into 0..range
+            bits = (bits << NUM_BITS_PER_COMPONENT) | (uint32_t)(value * RANGE + 0.5f);
+        }
+    }
+
+    buffer[0] = (uint8_t)(bits >> 24);
+    buffer[1] = (uint8_t)(bits >> 16);
+    buffer[2] = (uint8_t)(bits >> 8);
+    buffer[3] = (uint8_t)bits;
+
+    return 4;
+}
+
+int unpackOrientationQuatFromFourBytes(const unsigned char* buffer, glm::quat& quatOutput) {
+
+    uint32_t bits = ((uint32_t)buffer[0] << 24) | ((uint32_t)buffer[1] << 16) | ((uint32_t)buffer[2] << 8) | buffer[3];
+
+    const uint32_t NUM_BITS_PER_COMPONENT = 10;
+    const uint32_t MASK = (1 << NUM_BITS_PER_COMPONENT) - 1;
+    const float RANGE = (float)MASK;
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+
+    // largestComponent is encoded into the top 2 bits
+    uint8_t largestComponent = (uint8_t)(bits >> (3 * NUM_BITS_PER_COMPONENT));
+
+    float floatComponents[3];
+    for (int i = 0; i < 3; i++) {
+        uint32_t component = (bits >> ((2 - i) * NUM_BITS_PER_COMPONENT)) & MASK;
+        floatComponents[i] = ((float)component / RANGE) * (2.0f * MAGNITUDE) - MAGNITUDE;
+    }
+
+    // missingComponent is always negative.
+    float sumOfSquares = floatComponents[0] * floatComponents[0] + floatComponents[1] * floatComponents[1] + floatComponents[2] * floatComponents[2];
+    float missingComponent = -sqrtf(glm::max(1.0f - sumOfSquares, 0.0f));
+
+    for (int i = 0, j = 0; i < 4; i++) {
+        if (i != largestComponent) {
+            quatOutput[i] = floatComponents[j];
+            j++;
+        } else {
+            quatOutput[i] = missingComponent;
+        }
+    }
+
+    return 4;
+}
+
 bool closeEnough(float a, float b, float relativeError) {
     assert(relativeError >= 0.0f);
     // NOTE: we add EPSILON to the denominator so we can avoid checking for division by zero.
@@ -153,3 +153,86 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel) {
     deflateEnd(&strm);
     return status == Z_STREAM_END;
 }
+
+bool deflateWithDictionary(const QByteArray& source, const QByteArray& dictionary, QByteArray& destination,
+                           int compressionLevel) {
+    destination.clear();
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+
+    int status = deflateInit(&strm, qMax(Z_DEFAULT_COMPRESSION, qMin(9, compressionLevel)));
+    if (status != Z_OK) {
+        return false;
+    }
+
+    if (!dictionary.isEmpty()) {
+        status = deflateSetDictionary(&strm, (const Bytef*)dictionary.constData(), (uInt)dictionary.size());
+        if (status != Z_OK) {
+            deflateEnd(&strm);
+            return false;
+        }
+    }
+
+    destination.resize((int)deflateBound(&strm, (uLong)source.size()));
+    strm.next_in = (Bytef*)source.constData();
+    strm.avail_in = (uInt)source.size();
+    strm.next_out = (Bytef*)destination.data();
+    strm.avail_out = (uInt)destination.size();
+
+    status = deflate(&strm, Z_FINISH);
+    destination.resize((int)strm.total_out);
+    deflateEnd(&strm);
+
+    if (status != Z_STREAM_END) {
+        destination.clear();
+        return false;
+    }
+    return true;
+}
+
+bool inflateWithDictionary(const QByteArray& source, const QByteArray& dictionary, int uncompressedSize,
+                           QByteArray& destination) {
+    destination.clear();
+    if (uncompressedSize < 0) {
+        return false;
+    }
+
+    z_stream strm;
+    strm.zalloc = Z_NULL;
+    strm.zfree = Z_NULL;
+    strm.opaque = Z_NULL;
+    strm.next_in = (Bytef*)source.constData();
+    strm.avail_in = (uInt)source.size();
+
+    int status = inflateInit(&strm);
+    if (status != Z_OK) {
+        return false;
+    }
+
+    destination.resize(uncompressedSize);
+    strm.next_out = (Bytef*)destination.data();
+    strm.avail_out = (uInt)destination.size();
+
+    status = inflate(&strm, Z_FINISH);
+    if (status == Z_NEED_DICT) {
+        // the stream says which dictionary it was deflated with, and zlib checks it's the one given
+        if (dictionary.isEmpty()
+            || inflateSetDictionary(&strm, (const Bytef*)dictionary.constData(), (uInt)dictionary.size()) != Z_OK) {
+            inflateEnd(&strm);
+            destination.clear();
+            return false;
+        }
+        status = inflate(&strm, Z_FINISH);
+    }
+
+    bool isComplete = status == Z_STREAM_END && strm.total_out == (uLong)uncompressedSize;
+    inflateEnd(&strm);
+
+    if (!isComplete) {
+        destination.clear();
+    }
+    return isComplete;
+}
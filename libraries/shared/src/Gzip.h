@@ -24,4 +24,13 @@ bool gzip(QByteArray source, QByteArray &destination, int compressionLevel = -1)
 
 bool gunzip(QByteArray source, QByteArray &destination);
 
+// One-shot zlib streams whose deflater starts out with the dictionary as already seen data, so that whatever the source
+// shares with the dictionary costs a back-reference rather than its bytes. The inflater needs the same dictionary, and is
+// told the size to expect so that it never inflates past it. An empty dictionary gives a plain zlib stream.
+bool deflateWithDictionary(const QByteArray& source, const QByteArray& dictionary, QByteArray& destination,
+                           int compressionLevel = -1);
+
+bool inflateWithDictionary(const QByteArray& source, const QByteArray& dictionary, int uncompressedSize,
+                           QByteArray& destination);
+
 #endif
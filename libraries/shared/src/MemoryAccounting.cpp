@@ -0,0 +1,252 @@
+//
+//  MemoryAccounting.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MemoryAccounting.h"
+
+#include <atomic>
+#include <cstdlib>
+
+#include <QtCore/QtGlobal>
+
+#if defined(Q_OS_WIN)
+#include <malloc.h>
+#elif defined(Q_OS_MAC)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+#include "NumericalConstants.h"
+#include "SharedUtil.h"
+
+namespace {
+
+// Everything here is zero initialized before any constructor runs, as operator new may be called before this file's
+// static constructors are, and must not allocate.
+
+struct alignas(64) TagCounters {
+    std::atomic<int64_t> bytes;
+    std::atomic<uint64_t> numAllocations;
+    std::atomic<uint64_t> numAllocatedBytes;
+};
+
+TagCounters tagCounters[MemoryAccounting::NUM_TAGS];
+std::atomic<int64_t> heapBytes { 0 };
+std::atomic<bool> hooksInstalled { false };
+
+// a thread's heap counts since they were last passed on, for its current tag
+struct ThreadCounts {
+    MemoryTag tag;
+    uint32_t numOperations;
+    uint64_t numAllocations;
+    uint64_t numAllocatedBytes;
+    int64_t heapBytes;
+};
+
+thread_local ThreadCounts threadCounts;
+
+const uint32_t MAX_BATCHED_OPERATIONS = 256;
+const int64_t MAX_BATCHED_BYTES = 1 << 20;
+
+const char* TAG_NAMES[MemoryAccounting::NUM_TAGS] = {
+    "other", "entities", "avatars", "audio", "scripts", "physics", "render", "qml", "networking"
+};
+
+size_t getUsableSize(void* pointer) {
+#if defined(Q_OS_WIN)
+    return _msize(pointer);
+#elif defined(Q_OS_MAC)
+    return malloc_size(pointer);
+#else
+    return malloc_usable_size(pointer);
+#endif
+}
+
+void flushThreadCounts() {
+    ThreadCounts& counts = threadCounts;
+    if (counts.numOperations == 0) {
+        return;
+    }
+    TagCounters& tagCounter = tagCounters[(int)counts.tag];
+    tagCounter.numAllocations.fetch_add(counts.numAllocations, std::memory_order_relaxed);
+    tagCounter.numAllocatedBytes.fetch_add(counts.numAllocatedBytes, std::memory_order_relaxed);
+    heapBytes.fetch_add(counts.heapBytes, std::memory_order_relaxed);
+    counts.numOperations = 0;
+    counts.numAllocations = 0;
+    counts.numAllocatedBytes = 0;
+    counts.heapBytes = 0;
+}
+
+void countOperation() {
+    ThreadCounts& counts = threadCounts;
+    if (++counts.numOperations >= MAX_BATCHED_OPERATIONS || (int64_t)counts.numAllocatedBytes >= MAX_BATCHED_BYTES ||
+        counts.heapBytes >= MAX_BATCHED_BYTES || counts.heapBytes <= -MAX_BATCHED_BYTES) {
+        flushThreadCounts();
+    }
+}
+
+QString formatBytes(double bytes) {
+    const double BYTES_PER_MEGABYTE = (double)BYTES_PER_KILOBYTE * BYTES_PER_KILOBYTE;
+    if (bytes >= BYTES_PER_MEGABYTE || bytes <= -BYTES_PER_MEGABYTE) {
+        return QString("%1 MB").arg(bytes / BYTES_PER_MEGABYTE, 0, 'f', 1);
+    }
+    return QString("%1 kB").arg(bytes / BYTES_PER_KILOBYTE, 0, 'f', 1);
+}
+
+}
+
+MemoryAccounting::Scope::Scope(MemoryTag tag) :
+    _previousTag(threadCounts.tag)
+{
+    if (tag != _previousTag) {
+        flushThreadCounts();
+        threadCounts.tag = tag;
+    }
+}
+
+MemoryAccounting::Scope::~Scope() {
+    if (threadCounts.tag != _previousTag) {
+        flushThreadCounts();
+        threadCounts.tag = _previousTag;
+    }
+}
+
+void MemoryAccounting::add(MemoryTag tag, size_t bytes) {
+    tagCounters[(int)tag].bytes.fetch_add((int64_t)bytes, std::memory_order_relaxed);
+}
+
+void MemoryAccounting::remove(MemoryTag tag, size_t bytes) {
+    tagCounters[(int)tag].bytes.fetch_sub((int64_t)bytes, std::memory_order_relaxed);
+}
+
+MemoryTag MemoryAccounting::getCurrentTag() {
+    return threadCounts.tag;
+}
+
+const char* MemoryAccounting::getTagName(MemoryTag tag) {
+    return (int)tag < NUM_TAGS ? TAG_NAMES[(int)tag] : "unknown";
+}
+
+bool MemoryAccounting::areHooksInstalled() {
+    return hooksInstalled.load(std::memory_order_relaxed);
+}
+
+void MemoryAccounting::installHooks() {
+    hooksInstalled.store(true, std::memory_order_relaxed);
+}
+
+uint64_t MemoryAccounting::getNumAllocations() {
+    flushThreadCounts();
+    uint64_t numAllocations = 0;
+    for (const auto& tagCounter : tagCounters) {
+        numAllocations += tagCounter.numAllocations.load(std::memory_order_relaxed);
+    }
+    return numAllocations;
+}
+
+uint64_t MemoryAccounting::getNumAllocatedBytes() {
+    flushThreadCounts();
+    uint64_t numAllocatedBytes = 0;
+    for (const auto& tagCounter : tagCounters) {
+        numAllocatedBytes += tagCounter.numAllocatedBytes.load(std::memory_order_relaxed);
+    }
+    return numAllocatedBytes;
+}
+
+void* MemoryAccounting::allocateCounted(size_t size) {
+    void* pointer = allocateCounted(size, std::nothrow);
+    if (!pointer) {
+        throw std::bad_alloc();
+    }
+    return pointer;
+}
+
+void* MemoryAccounting::allocateCounted(size_t size, const std::nothrow_t&) noexcept {
+    void* pointer = std::malloc(size ? size : 1);
+    if (!pointer) {
+        return nullptr;
+    }
+    size_t usableSize = getUsableSize(pointer);
+    ThreadCounts& counts = threadCounts;
+    ++counts.numAllocations;
+    counts.numAllocatedBytes += usableSize;
+    counts.heapBytes += (int64_t)usableSize;
+    countOperation();
+    return pointer;
+}
+
+void MemoryAccounting::freeCounted(void* pointer) {
+    if (!pointer) {
+        return;
+    }
+    threadCounts.heapBytes -= (int64_t)getUsableSize(pointer);
+    countOperation();
+    std::free(pointer);
+}
+
+MemoryAccounting::Snapshot MemoryAccounting::takeSnapshot() {
+    flushThreadCounts();
+
+    Snapshot snapshot;
+    snapshot.timestamp = usecTimestampNow();
+    for (int i = 0; i < NUM_TAGS; i++) {
+        snapshot.tags[i].bytes = tagCounters[i].bytes.load(std::memory_order_relaxed);
+        snapshot.tags[i].numAllocations = tagCounters[i].numAllocations.load(std::memory_order_relaxed);
+        snapshot.tags[i].numAllocatedBytes = tagCounters[i].numAllocatedBytes.load(std::memory_order_relaxed);
+    }
+    if (areHooksInstalled()) {
+        snapshot.heapBytes = heapBytes.load(std::memory_order_relaxed);
+    }
+    return snapshot;
+}
+
+QJsonObject MemoryAccounting::toJson(const Snapshot& snapshot, const Snapshot* previous) {
+    double seconds = previous && snapshot.timestamp > previous->timestamp ?
+        (double)(snapshot.timestamp - previous->timestamp) / USECS_PER_SECOND : 0.0;
+
+    QJsonObject tags;
+    for (int i = 0; i < NUM_TAGS; i++) {
+        const TagStats& stats = snapshot.tags[i];
+        QJsonObject tag;
+        tag["bytes"] = (double)stats.bytes;
+        if (seconds > 0.0) {
+            const TagStats& previousStats = previous->tags[i];
+            tag["allocations_per_second"] = (double)(stats.numAllocations - previousStats.numAllocations) / seconds;
+            tag["allocated_bytes_per_second"] = (double)(stats.numAllocatedBytes - previousStats.numAllocatedBytes) / seconds;
+        }
+        tags[getTagName((MemoryTag)i)] = tag;
+    }
+
+    QJsonObject result;
+    result["heap_bytes"] = (double)snapshot.heapBytes;
+    result["tags"] = tags;
+    return result;
+}
+
+QString MemoryAccounting::toString(const Snapshot& snapshot, const Snapshot* previous) {
+    double seconds = previous && snapshot.timestamp > previous->timestamp ?
+        (double)(snapshot.timestamp - previous->timestamp) / USECS_PER_SECOND : 0.0;
+
+    QString result = snapshot.heapBytes >= 0 ? QString("heap = %1").arg(formatBytes((double)snapshot.heapBytes))
+                                             : QString("heap = not counted");
+    for (int i = 0; i < NUM_TAGS; i++) {
+        const TagStats& stats = snapshot.tags[i];
+        double numAllocations = seconds > 0.0 ? (double)(stats.numAllocations - previous->tags[i].numAllocations) / seconds : 0.0;
+        double numAllocatedBytes = seconds > 0.0 ?
+            (double)(stats.numAllocatedBytes - previous->tags[i].numAllocatedBytes) / seconds : 0.0;
+        if (stats.bytes == 0 && numAllocations == 0.0) {
+            continue;
+        }
+        result += QString("\n    %1 = %2, %3 allocs/s, %4/s").arg(getTagName((MemoryTag)i), formatBytes((double)stats.bytes))
+                      .arg(numAllocations, 0, 'f', 0).arg(formatBytes(numAllocatedBytes));
+    }
+    return result;
+}
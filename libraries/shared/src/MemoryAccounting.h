@@ -0,0 +1,127 @@
+//
+//  MemoryAccounting.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_MemoryAccounting_h
+#define hifi_MemoryAccounting_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+// the subsystems memory is accounted to
+enum class MemoryTag : uint8_t {
+    Other = 0,
+    Entities,
+    Avatars,
+    Audio,
+    Scripts,
+    Physics,
+    Render,
+    Qml,
+    Networking,
+    NUM_TAGS
+};
+
+// Accounts the process's memory to the subsystems using it, cheaply enough to be left on.
+//
+// Two kinds of memory are accounted. The blocks of allocators that know what they hold, like a tagged FrameArena or
+// FixedSizePool, are added and removed as they're allocated and freed, so their live bytes are exact. Everything else is
+// counted by a replacement operator new and delete, in executables that use MEMORY_ACCOUNTING_HOOKS() once: each
+// allocation is accounted to the tag of the Scope the thread is in, Other outside one. A free can't tell what it frees
+// without a header on every allocation, so what the hooks give per tag is the rate of allocations and of bytes allocated,
+// with the live heap only for the process as a whole.
+//
+// Counting is a relaxed atomic operation for allocator blocks and a thread local one for the hooks, which pass their
+// counts on every few hundred allocations or megabyte, so a snapshot can be that far behind for each thread but the one
+// taking it. The hooks are the only replacement of operator new in the tree; benchmarks count with them too.
+class MemoryAccounting {
+public:
+    static const int NUM_TAGS = (int)MemoryTag::NUM_TAGS;
+
+    // accounts the thread's allocations to the tag until it goes out of scope
+    class Scope {
+    public:
+        Scope(MemoryTag tag);
+        ~Scope();
+
+    private:
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        MemoryTag _previousTag;
+    };
+
+    struct TagStats {
+        int64_t bytes { 0 }; // live in tagged allocator blocks
+        uint64_t numAllocations { 0 }; // made through operator new since the process started
+        uint64_t numAllocatedBytes { 0 };
+    };
+
+    struct Snapshot {
+        uint64_t timestamp { 0 }; // usecs
+        std::array<TagStats, NUM_TAGS> tags;
+        int64_t heapBytes { -1 }; // live through operator new, -1 if the hooks aren't installed
+    };
+
+    // the blocks of an allocator for the tag
+    static void add(MemoryTag tag, size_t bytes);
+    static void remove(MemoryTag tag, size_t bytes);
+
+    static MemoryTag getCurrentTag();
+    static const char* getTagName(MemoryTag tag);
+
+    static bool areHooksInstalled();
+
+    // made through operator new since the process started, for all tags, 0 if the hooks aren't installed
+    static uint64_t getNumAllocations();
+    static uint64_t getNumAllocatedBytes();
+
+    static Snapshot takeSnapshot();
+    // the bytes live at the snapshot and, against the previous one if it's given, the allocation rates per second
+    static QJsonObject toJson(const Snapshot& snapshot, const Snapshot* previous = nullptr);
+    // a few lines for the stats overlay
+    static QString toString(const Snapshot& snapshot, const Snapshot* previous = nullptr);
+
+    // used by MEMORY_ACCOUNTING_HOOKS(), and not to be called otherwise
+    static void installHooks();
+    static void* allocateCounted(size_t size);
+    static void* allocateCounted(size_t size, const std::nothrow_t&) noexcept;
+    static void freeCounted(void* pointer);
+};
+
+// Replaces the global operator new and delete of the executable to account heap allocations to subsystems. Libraries use
+// the replacement too where the platform resolves operator new across shared libraries, as Linux and macOS do.
+#define MEMORY_ACCOUNTING_HOOKS() \
+    static const struct MemoryAccountingHooks { \
+        MemoryAccountingHooks() { MemoryAccounting::installHooks(); } \
+    } memoryAccountingHooks; \
+    void* operator new(std::size_t size) { return MemoryAccounting::allocateCounted(size); } \
+    void* operator new[](std::size_t size) { return MemoryAccounting::allocateCounted(size); } \
+    void* operator new(std::size_t size, const std::nothrow_t& tag) noexcept { \
+        return MemoryAccounting::allocateCounted(size, tag); \
+    } \
+    void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept { \
+        return MemoryAccounting::allocateCounted(size, tag); \
+    } \
+    void operator delete(void* pointer) noexcept { MemoryAccounting::freeCounted(pointer); } \
+    void operator delete[](void* pointer) noexcept { MemoryAccounting::freeCounted(pointer); } \
+    void operator delete(void* pointer, std::size_t) noexcept { MemoryAccounting::freeCounted(pointer); } \
+    void operator delete[](void* pointer, std::size_t) noexcept { MemoryAccounting::freeCounted(pointer); } \
+    void operator delete(void* pointer, const std::nothrow_t&) noexcept { MemoryAccounting::freeCounted(pointer); } \
+    void operator delete[](void* pointer, const std::nothrow_t&) noexcept { MemoryAccounting::freeCounted(pointer); }
+
+#endif // hifi_MemoryAccounting_h
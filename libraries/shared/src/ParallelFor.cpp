@@ -0,0 +1,81 @@
+//
+//  ParallelFor.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ParallelFor.h"
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+namespace {
+
+class RangeTask : public QRunnable {
+public:
+    RangeTask(const std::function<void(size_t, size_t, size_t)>& work, size_t index, size_t begin, size_t end) :
+        _work(work), _index(index), _begin(begin), _end(end) {}
+
+    std::future<void> getResult() { return _result.get_future(); }
+
+    void run() override {
+        _work(_index, _begin, _end);
+        _result.set_value();
+    }
+
+private:
+    const std::function<void(size_t, size_t, size_t)>& _work;
+    size_t _index;
+    size_t _begin;
+    size_t _end;
+    std::promise<void> _result;
+};
+
+}
+
+size_t getNumParallelRanges(size_t numItems, size_t minItemsPerRange) {
+    size_t maxRanges = (size_t)std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+    return std::max((size_t)1, std::min(maxRanges, numItems / std::max((size_t)1, minItemsPerRange)));
+}
+
+size_t parallelFor(size_t numItems, size_t minItemsPerRange, const std::function<void(size_t, size_t, size_t)>& work) {
+    if (numItems == 0) {
+        return 0;
+    }
+    const size_t numRanges = getNumParallelRanges(numItems, minItemsPerRange);
+    const size_t rangeSize = (numItems + numRanges - 1) / numRanges;
+
+    struct PendingRange {
+        RangeTask* task;
+        std::future<void> result;
+    };
+    QThreadPool* threadPool = QThreadPool::globalInstance();
+    std::vector<PendingRange> pendingRanges;
+    // the first range is done on this thread
+    for (size_t index = 1; index < numRanges; index++) {
+        size_t begin = std::min(index * rangeSize, numItems);
+        auto task = new RangeTask(work, index, begin, std::min(begin + rangeSize, numItems));
+        pendingRanges.push_back({ task, task->getResult() });
+        threadPool->start(task);
+    }
+    work(0, 0, std::min(rangeSize, numItems));
+    for (auto& pending : pendingRanges) {
+        // the task is only guaranteed to be alive until its result is set
+        if (pending.result.wait_for(std::chrono::seconds(0)) != std::future_status::ready && threadPool->tryTake(pending.task)) {
+            // the pool is busy, so don't wait for it to get to the task
+            pending.task->run();
+            delete pending.task;
+        }
+        pending.result.get();
+    }
+    return numRanges;
+}
@@ -0,0 +1,29 @@
+//
+//  ParallelFor.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_ParallelFor_h
+#define hifi_ParallelFor_h
+
+#include <cstddef>
+#include <functional>
+
+// Splits [0, numItems) into ranges of at least minItemsPerRange and calls work(index, begin, end) for each of them, on
+// the global thread pool and on this thread, returning once they're all done. The ranges are in order, so work can write
+// each range's results to its own slot and the caller can merge them in order afterwards. A range the pool hasn't
+// started by the time this thread is done with its own is run here instead.
+// Returns the number of ranges.
+size_t parallelFor(size_t numItems, size_t minItemsPerRange, const std::function<void(size_t index, size_t begin, size_t end)>& work);
+
+// the number of ranges parallelFor() splits numItems into, at most the global thread pool's thread count
+size_t getNumParallelRanges(size_t numItems, size_t minItemsPerRange);
+
+#endif // hifi_ParallelFor_h
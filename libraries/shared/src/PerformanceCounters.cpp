@@ -0,0 +1,154 @@
+//
+//  PerformanceCounters.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PerformanceCounters.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <QtCore/QJsonArray>
+
+const std::array<uint64_t, PerformanceCounters::Histogram::NUM_BOUNDS> PerformanceCounters::Histogram::BOUNDS {
+    100, 200, 500,
+    1000, 2000, 5000,
+    10000, 20000, 50000,
+    100000, 200000, 500000,
+    1000000, 2000000, 5000000,
+    10000000
+};
+
+static uint64_t doubleToBits(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static double bitsToDouble(uint64_t bits) {
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+void PerformanceCounters::Gauge::set(double value) {
+    _bits.store(doubleToBits(value), std::memory_order_relaxed);
+}
+
+void PerformanceCounters::Gauge::add(double amount) {
+    auto bits = _bits.load(std::memory_order_relaxed);
+    while (!_bits.compare_exchange_weak(bits, doubleToBits(bitsToDouble(bits) + amount), std::memory_order_relaxed)) {
+    }
+}
+
+double PerformanceCounters::Gauge::get() const {
+    return bitsToDouble(_bits.load(std::memory_order_relaxed));
+}
+
+void PerformanceCounters::Histogram::record(uint64_t usecs) {
+    auto bucket = std::lower_bound(BOUNDS.cbegin(), BOUNDS.cend(), usecs) - BOUNDS.cbegin();
+    _counts[bucket].fetch_add(1, std::memory_order_relaxed);
+    _sum.fetch_add(usecs, std::memory_order_relaxed);
+}
+
+PerformanceCounters& PerformanceCounters::getInstance() {
+    static PerformanceCounters instance;
+    return instance;
+}
+
+template <typename T>
+T& PerformanceCounters::getOrCreate(std::map<QString, Metric<T>>& metrics, const QString& name, const QString& help) {
+    auto& entry = metrics[name];
+    if (!entry.metric) {
+        entry.help = help;
+        entry.metric.reset(new T());
+    }
+    return *entry.metric;
+}
+
+PerformanceCounters::Counter& PerformanceCounters::counter(const QString& name, const QString& help) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return getOrCreate(_counters, name, help);
+}
+
+PerformanceCounters::Gauge& PerformanceCounters::gauge(const QString& name, const QString& help) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return getOrCreate(_gauges, name, help);
+}
+
+PerformanceCounters::Histogram& PerformanceCounters::histogram(const QString& name, const QString& help) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return getOrCreate(_histograms, name, help);
+}
+
+void PerformanceCounters::reset() {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto& entry : _counters) {
+        entry.second.metric->_value.store(0, std::memory_order_relaxed);
+    }
+    for (auto& entry : _gauges) {
+        entry.second.metric->set(0.0);
+    }
+    for (auto& entry : _histograms) {
+        for (auto& count : entry.second.metric->_counts) {
+            count.store(0, std::memory_order_relaxed);
+        }
+        entry.second.metric->_sum.store(0, std::memory_order_relaxed);
+    }
+}
+
+QJsonObject PerformanceCounters::toJson() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    QJsonObject counters;
+    for (const auto& entry : _counters) {
+        counters[entry.first] = QJsonObject {
+            { "help", entry.second.help },
+            { "value", (double)entry.second.metric->get() }
+        };
+    }
+
+    QJsonObject gauges;
+    for (const auto& entry : _gauges) {
+        gauges[entry.first] = QJsonObject {
+            { "help", entry.second.help },
+            { "value", entry.second.metric->get() }
+        };
+    }
+
+    QJsonArray bounds;
+    for (auto bound : Histogram::BOUNDS) {
+        bounds.append((double)bound);
+    }
+
+    QJsonObject histograms;
+    for (const auto& entry : _histograms) {
+        QJsonArray counts;
+        uint64_t count = 0;
+        for (const auto& bucketCount : entry.second.metric->_counts) {
+            auto value = bucketCount.load(std::memory_order_relaxed);
+            counts.append((double)value);
+            count += value;
+        }
+
+        histograms[entry.first] = QJsonObject {
+            { "help", entry.second.help },
+            { "bounds", bounds },
+            { "counts", counts },
+            { "sum", (double)entry.second.metric->_sum.load(std::memory_order_relaxed) },
+            { "count", (double)count }
+        };
+    }
+
+    return QJsonObject {
+        { "counters", counters },
+        { "gauges", gauges },
+        { "histograms", histograms }
+    };
+}
@@ -0,0 +1,103 @@
+//
+//  PerformanceCounters.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_PerformanceCounters_h
+#define hifi_PerformanceCounters_h
+
+#include <array>
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+// The process's performance metrics, in one shape for every assignment so the domain server can aggregate and export
+// them without knowing what each one sends.
+//
+// A metric is registered by name the first time it's asked for and lives for the rest of the process, so callers keep the
+// reference, typically in a function-local static. Updating one is a relaxed atomic operation from any thread and takes a
+// fixed amount of memory, histograms included. Names are lower_snake_case without the assignment type, which the domain
+// server adds as a label; by convention counters of frames that overran their budget end in _overruns and gauges of
+// queued work end in _queue_depth, which the domain server alerts on.
+class PerformanceCounters {
+public:
+    class Counter {
+    public:
+        void increment(uint64_t amount = 1) { _value.fetch_add(amount, std::memory_order_relaxed); }
+        uint64_t get() const { return _value.load(std::memory_order_relaxed); }
+
+    private:
+        friend class PerformanceCounters;
+        std::atomic<uint64_t> _value { 0 };
+    };
+
+    class Gauge {
+    public:
+        void set(double value);
+        void add(double amount);
+        double get() const;
+
+    private:
+        friend class PerformanceCounters;
+        std::atomic<uint64_t> _bits { 0 }; // the double's bits, 0 is 0.0
+    };
+
+    // counts durations in microseconds into buckets bounded by 1, 2 and 5 times each power of ten from 100us to 10s
+    class Histogram {
+    public:
+        static constexpr int NUM_BOUNDS = 16;
+        static const std::array<uint64_t, NUM_BOUNDS> BOUNDS;
+
+        void record(uint64_t usecs);
+
+    private:
+        friend class PerformanceCounters;
+        std::array<std::atomic<uint64_t>, NUM_BOUNDS + 1> _counts {}; // the last one counts values above every bound
+        std::atomic<uint64_t> _sum { 0 };
+    };
+
+    static PerformanceCounters& getInstance();
+
+    // the metric with the name, registered with the help text if it's new
+    Counter& counter(const QString& name, const QString& help);
+    Gauge& gauge(const QString& name, const QString& help);
+    Histogram& histogram(const QString& name, const QString& help);
+
+    // zeroes every metric, for a process that goes on to run another assignment
+    void reset();
+
+    // { "counters": { name: { "help", "value" } }, "gauges": { ... },
+    //   "histograms": { name: { "help", "bounds": [...], "counts": [...], "sum", "count" } } }
+    // with a histogram's counts per bucket rather than cumulative and one more count than bounds
+    QJsonObject toJson() const;
+
+private:
+    template <typename T>
+    struct Metric {
+        QString help;
+        std::unique_ptr<T> metric;
+    };
+
+    template <typename T>
+    static T& getOrCreate(std::map<QString, Metric<T>>& metrics, const QString& name, const QString& help);
+
+    mutable std::mutex _mutex;
+    std::map<QString, Metric<Counter>> _counters;
+    std::map<QString, Metric<Gauge>> _gauges;
+    std::map<QString, Metric<Histogram>> _histograms;
+};
+
+#endif // hifi_PerformanceCounters_h
@@ -0,0 +1,112 @@
+//
+//  PrioritySortUtil.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PrioritySortUtil.h"
+
+namespace {
+    // below this many keys a comparison sort beats the radix passes' fixed cost
+    const size_t MIN_RADIX_SORT_COUNT = 256;
+
+    // the priority is the high 32 bits of a key, sorted in three digits from the least significant up
+    const int NUM_DIGITS = 3;
+    const int DIGIT_SHIFTS[NUM_DIGITS] = { 32, 43, 54 };
+    const int DIGIT_BITS = 11;
+    const uint32_t DIGIT_MASK = (1 << DIGIT_BITS) - 1;
+    const int NUM_BUCKETS = 1 << DIGIT_BITS;
+
+    inline uint32_t getDigit(uint64_t key, int digit) {
+        return (uint32_t)(key >> DIGIT_SHIFTS[digit]) & DIGIT_MASK;
+    }
+}
+
+void PrioritySortUtil::sortKeys(uint64_t* keys, uint64_t* scratch, size_t count) {
+    if (count < MIN_RADIX_SORT_COUNT) {
+        std::sort(keys, keys + count);
+        return;
+    }
+
+    uint32_t histograms[NUM_DIGITS][NUM_BUCKETS] = {};
+    for (size_t i = 0; i < count; ++i) {
+        for (int digit = 0; digit < NUM_DIGITS; ++digit) {
+            ++histograms[digit][getDigit(keys[i], digit)];
+        }
+    }
+
+    // each pass is stable, so keys of equal priority stay in the order of their indices, as the comparison sort leaves them
+    uint64_t* from = keys;
+    uint64_t* to = scratch;
+    for (int digit = 0; digit < NUM_DIGITS; ++digit) {
+        uint32_t* histogram = histograms[digit];
+        if (histogram[getDigit(from[0], digit)] == count) {
+            // all the keys share this digit, which is usual for the high ones
+            continue;
+        }
+
+        uint32_t offset = 0;
+        for (int bucket = 0; bucket < NUM_BUCKETS; ++bucket) {
+            uint32_t bucketCount = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucketCount;
+        }
+        for (size_t i = 0; i < count; ++i) {
+            to[histogram[getDigit(from[i], digit)]++] = from[i];
+        }
+        std::swap(from, to);
+    }
+
+    if (from != keys) {
+        memcpy(keys, from, count * sizeof(uint64_t));
+    }
+}
+
+void PrioritySortUtil::selectKeys(uint64_t* keys, uint64_t* scratch, size_t count, size_t numToSelect) {
+    if (count < MIN_RADIX_SORT_COUNT) {
+        std::partial_sort(keys, keys + numToSelect, keys + count);
+        return;
+    }
+
+    // narrows down to the keys that share the digits of the last key selected, from the most significant digit down;
+    // the keys before them are all selected and those after them are not
+    size_t begin = 0;
+    size_t end = count;
+    size_t numNeeded = numToSelect;
+    for (int digit = NUM_DIGITS - 1; digit >= 0 && end - begin > numNeeded; --digit) {
+        uint32_t histogram[NUM_BUCKETS] = {};
+        for (size_t i = begin; i < end; ++i) {
+            ++histogram[getDigit(keys[i], digit)];
+        }
+
+        uint32_t lastBucket = 0;
+        size_t numBefore = 0;
+        while (numBefore + histogram[lastBucket] < numNeeded) {
+            numBefore += histogram[lastBucket];
+            ++lastBucket;
+        }
+
+        // a stable partition into the keys before the bucket, in it and after it
+        size_t before = begin;
+        size_t in = begin + numBefore;
+        size_t after = in + histogram[lastBucket];
+        for (size_t i = begin; i < end; ++i) {
+            uint32_t bucket = getDigit(keys[i], digit);
+            size_t& destination = bucket < lastBucket ? before : (bucket == lastBucket ? in : after);
+            scratch[destination++] = keys[i];
+        }
+        memcpy(keys + begin, scratch + begin, (end - begin) * sizeof(uint64_t));
+
+        end = begin + numBefore + histogram[lastBucket];
+        begin += numBefore;
+        numNeeded -= numBefore;
+    }
+
+    // keys that share all their digits have equal priorities and are still in the order of their indices
+    sortKeys(keys, scratch, begin + numNeeded);
+}
@@ -11,6 +11,12 @@
 #ifndef hifi_PrioritySortUtil_h
 #define hifi_PrioritySortUtil_h
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
 #include <glm/glm.hpp>
 
 #include "NumericalConstants.h"
@@ -27,6 +33,24 @@ namespace PrioritySortUtil {
     constexpr float DEFAULT_CENTER_COEF { 0.5f };
     constexpr float DEFAULT_AGE_COEF { 0.25f };
 
+    // Sorts count keys made by makeSortKey() into ascending order, so into descending priority with equal priorities
+    // in the order they were pushed. scratch must have room for count keys.
+    void sortKeys(uint64_t* keys, uint64_t* scratch, size_t count);
+
+    // Moves the numToSelect keys that sort first to the front, in ascending order, leaving the rest behind them in no
+    // particular order. scratch must have room for count keys.
+    void selectKeys(uint64_t* keys, uint64_t* scratch, size_t count, size_t numToSelect);
+
+    // A key that sorts ahead for higher priorities, with the index the thing was pushed at in the low bits
+    inline uint64_t makeSortKey(float priority, uint32_t index) {
+        uint32_t bits;
+        memcpy(&bits, &priority, sizeof(bits));
+        // flipping the sign bit of positive floats and all the bits of negative ones orders them as unsigned ints,
+        // and inverting that puts the highest priority first
+        uint32_t key = ~((bits & 0x80000000u) ? ~bits : (bits | 0x80000000u));
+        return ((uint64_t)key << 32) | index;
+    }
+
     class Sortable {
     public:
         virtual ~Sortable() = default;
@@ -41,19 +65,36 @@ namespace PrioritySortUtil {
         float _priority { 0.0f };
     };
 
-    template <typename T>
+    // Things are prioritized in batches: push() only reads a thing's position, radius and age into arrays, and the
+    // priorities of everything pushed since are computed together, view by view, when the queue is next sorted.
+    // Sortables should be final so those reads are not virtual calls.
+    template <typename T, typename Allocator = std::allocator<T>>
     class PriorityQueue {
+        using FloatVector = std::vector<float, typename std::allocator_traits<Allocator>::template rebind_alloc<float>>;
+        using KeyVector = std::vector<uint64_t, typename std::allocator_traits<Allocator>::template rebind_alloc<uint64_t>>;
+
     public:
         PriorityQueue() = delete;
-        PriorityQueue(const ConicalViewFrustums& views) : _views(views), _usecCurrentTime(usecTimestampNow()) { }
-        PriorityQueue(const ConicalViewFrustums& views, float angularWeight, float centerWeight, float ageWeight)
-            : _views(views), _angularWeight(angularWeight), _centerWeight(centerWeight), _ageWeight(ageWeight)
-            , _usecCurrentTime(usecTimestampNow()) {
+        PriorityQueue(const ConicalViewFrustums& views, const Allocator& allocator = Allocator())
+            : _views(views), _vector(allocator), _usecCurrentTime(usecTimestampNow()), _x(allocator), _y(allocator)
+            , _z(allocator), _radius(allocator), _age(allocator), _distance(allocator), _viewPriority(allocator)
+            , _keys(allocator), _scratchKeys(allocator) {
+        }
+        PriorityQueue(const ConicalViewFrustums& views, float angularWeight, float centerWeight, float ageWeight,
+                      const Allocator& allocator = Allocator())
+            : _views(views), _vector(allocator), _angularWeight(angularWeight), _centerWeight(centerWeight)
+            , _ageWeight(ageWeight), _usecCurrentTime(usecTimestampNow()), _x(allocator), _y(allocator), _z(allocator)
+            , _radius(allocator), _age(allocator), _distance(allocator), _viewPriority(allocator), _keys(allocator)
+            , _scratchKeys(allocator) {
         }
 
-        void setViews(const ConicalViewFrustums& views) { _views = views; }
+        void setViews(const ConicalViewFrustums& views) {
+            computePendingPriorities();
+            _views = views;
+        }
 
         void setWeights(float angularWeight, float centerWeight, float ageWeight) {
+            computePendingPriorities();
             _angularWeight = angularWeight;
             _centerWeight = centerWeight;
             _ageWeight = ageWeight;
@@ -62,79 +103,150 @@ namespace PrioritySortUtil {
 
         size_t size() const { return _vector.size(); }
         void push(T thing) {
-            thing.setPriority(computePriority(thing));
-            _vector.push_back(thing);
+            const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
+            glm::vec3 position = thing.getPosition();
+            _x.push_back(position.x);
+            _y.push_back(position.y);
+            _z.push_back(position.z);
+            _radius.push_back(glm::max(thing.getRadius(), MIN_RADIUS));
+            _age.push_back(float((_usecCurrentTime - thing.getTimestamp()) / USECS_PER_SECOND));
+            _vector.push_back(std::move(thing));
         }
         void reserve(size_t num) {
             _vector.reserve(num);
+            _x.reserve(num);
+            _y.reserve(num);
+            _z.reserve(num);
+            _radius.reserve(num);
+            _age.reserve(num);
         }
-        const std::vector<T>& getSortedVector(int numToSort = 0) {
-            if (numToSort == 0 || numToSort >= (int)_vector.size()) {
-                std::sort(_vector.begin(), _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
+        const std::vector<T, Allocator>& getSortedVector(int numToSort = 0) {
+            computePendingPriorities();
+
+            size_t count = _vector.size();
+            _keys.resize(count);
+            _scratchKeys.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                _keys[i] = makeSortKey(_vector[i].getPriority(), (uint32_t)i);
+            }
+            if (numToSort <= 0 || numToSort >= (int)count) {
+                sortKeys(_keys.data(), _scratchKeys.data(), count);
             } else {
-                std::partial_sort(_vector.begin(), _vector.begin() + numToSort, _vector.end(),
-                    [](const T& left, const T& right) { return left.getPriority() > right.getPriority(); });
+                selectKeys(_keys.data(), _scratchKeys.data(), count, (size_t)numToSort);
+            }
+
+            // the things are moved into the order of the keys by following each cycle of the permutation
+            const uint64_t INDEX_MASK = 0xffffffffu;
+            for (size_t i = 0; i < count; ++i) {
+                size_t source = (size_t)(_keys[i] & INDEX_MASK);
+                if (source == i) {
+                    continue;
+                }
+                T thing = std::move(_vector[i]);
+                size_t destination = i;
+                while (source != i) {
+                    _vector[destination] = std::move(_vector[source]);
+                    _keys[destination] = destination;
+                    destination = source;
+                    source = (size_t)(_keys[destination] & INDEX_MASK);
+                }
+                _vector[destination] = std::move(thing);
+                _keys[destination] = destination;
             }
             return _vector;
         }
 
     private:
 
-        float computePriority(const T& thing) const {
-            float priority = std::numeric_limits<float>::min();
-
-            for (const auto& view : _views) {
-                priority = std::max(priority, computePriority(view, thing));
+        // priority = weighted linear combination of multiple values:
+        //   (a) angular size
+        //   (b) proximity to center of view
+        //   (c) time since last update
+        // where the relative "weights" are tuned to scale the contributing values into units of "priority".
+        void computePendingPriorities() {
+            size_t count = _x.size();
+            if (count == 0) {
+                return;
             }
-
-            return priority;
-        }
-
-        float computePriority(const ConicalViewFrustum& view, const T& thing) const {
-            // priority = weighted linear combination of multiple values:
-            //   (a) angular size
-            //   (b) proximity to center of view
-            //   (c) time since last update
-            // where the relative "weights" are tuned to scale the contributing values into units of "priority".
-
-            glm::vec3 position = thing.getPosition();
-            glm::vec3 offset = position - view.getPosition();
-            float distance = glm::length(offset) + 0.001f; // add 1mm to avoid divide by zero
-            const float MIN_RADIUS = 0.1f; // WORKAROUND for zero size objects (we still want them to sort by distance)
-            float radius = glm::max(thing.getRadius(), MIN_RADIUS);
-            // Other item's angle from view centre:
-            float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
-            if (cosineAngle > 0.0f) {
-                cosineAngle = std::sqrt(cosineAngle);
+            size_t first = _vector.size() - count;
+            _distance.resize(count);
+            _viewPriority.resize(count);
+            for (size_t i = 0; i < count; ++i) {
+                _vector[first + i].setPriority(std::numeric_limits<float>::min());
             }
-            float age = float((_usecCurrentTime - thing.getTimestamp()) / USECS_PER_SECOND);
 
-            // the "age" term accumulates at the sum of all weights
-            float angularSize = radius / distance;
-            float priority = (_angularWeight * angularSize + _centerWeight * cosineAngle) * (age + 1.0f) + _ageWeight * age;
+            const float* x = _x.data();
+            const float* y = _y.data();
+            const float* z = _z.data();
+            const float* radius = _radius.data();
+            const float* age = _age.data();
+            float* distance = _distance.data();
+            float* viewPriority = _viewPriority.data();
+            for (const auto& view : _views) {
+                const glm::vec3& viewPosition = view.getPosition();
+                const glm::vec3& viewDirection = view.getDirection();
+
+                // a branch free loop over plain arrays, which the compiler vectorizes
+                for (size_t i = 0; i < count; ++i) {
+                    float dx = x[i] - viewPosition.x;
+                    float dy = y[i] - viewPosition.y;
+                    float dz = z[i] - viewPosition.z;
+                    distance[i] = std::sqrt(dx * dx + dy * dy + dz * dz) + 0.001f; // add 1mm to avoid divide by zero
+                    // Other item's angle from view centre:
+                    float cosineAngle = (dx * viewDirection.x + dy * viewDirection.y + dz * viewDirection.z) / distance[i];
+                    cosineAngle = cosineAngle > 0.0f ? std::sqrt(std::max(cosineAngle, 0.0f)) : cosineAngle;
+
+                    // the "age" term accumulates at the sum of all weights
+                    float angularSize = radius[i] / distance[i];
+                    viewPriority[i] = (_angularWeight * angularSize + _centerWeight * cosineAngle) * (age[i] + 1.0f) +
+                        _ageWeight * age[i];
+                }
 
-            // decrement priority of things outside keyhole
-            if (distance - radius > view.getRadius()) {
-                if (!view.intersects(offset, distance, radius)) {
-                    priority += OUT_OF_VIEW_PENALTY;
+                for (size_t i = 0; i < count; ++i) {
+                    // decrement priority of things outside keyhole
+                    if (distance[i] - radius[i] > view.getRadius()) {
+                        glm::vec3 offset = glm::vec3(x[i], y[i], z[i]) - viewPosition;
+                        if (!view.intersects(offset, distance[i], radius[i])) {
+                            viewPriority[i] += OUT_OF_VIEW_PENALTY;
+                        }
+                    }
+                    T& thing = _vector[first + i];
+                    thing.setPriority(std::max(thing.getPriority(), viewPriority[i]));
                 }
             }
-            return priority;
+
+            _x.clear();
+            _y.clear();
+            _z.clear();
+            _radius.clear();
+            _age.clear();
         }
 
         ConicalViewFrustums _views;
-        std::vector<T> _vector;
+        std::vector<T, Allocator> _vector;
         float _angularWeight { DEFAULT_ANGULAR_COEF };
         float _centerWeight { DEFAULT_CENTER_COEF };
         float _ageWeight { DEFAULT_AGE_COEF };
         quint64 _usecCurrentTime { 0 };
+
+        // the things pushed since the priorities were last computed, the last _x.size() of _vector
+        FloatVector _x;
+        FloatVector _y;
+        FloatVector _z;
+        FloatVector _radius;
+        FloatVector _age;
+        FloatVector _distance;
+        FloatVector _viewPriority;
+
+        KeyVector _keys;
+        KeyVector _scratchKeys;
     };
 } // namespace PrioritySortUtil
 
   // for now we're keeping hard-coded sorted time budgets in one spot
 const uint64_t MAX_UPDATE_RENDERABLES_TIME_BUDGET = 2000; // usec
 const uint64_t MIN_SORTED_UPDATE_RENDERABLES_TIME_BUDGET = 1000; // usec
+const uint64_t MAX_ADD_RENDERABLES_TIME_BUDGET = 2000; // usec
 const uint64_t MAX_UPDATE_AVATARS_TIME_BUDGET = 2000; // usec
 
 #endif // hifi_PrioritySortUtil_h
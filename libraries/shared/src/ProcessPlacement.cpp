@@ -0,0 +1,231 @@
+//
+//  ProcessPlacement.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ProcessPlacement.h"
+
+#include <algorithm>
+#include <atomic>
+
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QThread>
+
+#if defined(Q_OS_LINUX)
+#include <sched.h>
+#include <unistd.h>
+#include <sys/syscall.h>
+#elif defined(Q_OS_WIN)
+#include <qt_windows.h>
+#endif
+
+namespace ProcessPlacement {
+
+// any more than this is a typo rather than a host
+static const int MAX_CPUS = 4096;
+
+static std::atomic<int> preferredNumaNode { -1 };
+
+std::vector<int> parseCpuList(const QString& cpuList) {
+    std::vector<int> cpus;
+    for (const auto& range : cpuList.trimmed().split(',', Qt::SkipEmptyParts)) {
+        auto bounds = range.split('-');
+        if (bounds.size() > 2) {
+            return {};
+        }
+
+        bool isFirstValid = false;
+        bool isLastValid = false;
+        int first = bounds.first().trimmed().toInt(&isFirstValid);
+        int last = bounds.last().trimmed().toInt(&isLastValid);
+        if (!isFirstValid || !isLastValid || first < 0 || last < first || last >= MAX_CPUS) {
+            return {};
+        }
+
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+QString formatCpuList(std::vector<int> cpus) {
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+
+    QStringList ranges;
+    for (size_t i = 0; i < cpus.size();) {
+        size_t last = i;
+        while (last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1) {
+            ++last;
+        }
+        ranges << (last == i ? QString::number(cpus[i]) : QString("%1-%2").arg(cpus[i]).arg(cpus[last]));
+        i = last + 1;
+    }
+    return ranges.join(',');
+}
+
+std::vector<NumaNode> getNumaNodes() {
+    std::vector<NumaNode> nodes;
+
+#if defined(Q_OS_LINUX)
+    static const QString NODE_PREFIX = "node";
+    QDir nodesDir("/sys/devices/system/node");
+    for (const auto& entry : nodesDir.entryList({ NODE_PREFIX + "*" }, QDir::Dirs)) {
+        bool isNumber = false;
+        int id = entry.mid(NODE_PREFIX.size()).toInt(&isNumber);
+
+        QFile cpuListFile(nodesDir.filePath(entry + "/cpulist"));
+        if (!isNumber || !cpuListFile.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+
+        auto cpus = parseCpuList(QString::fromLatin1(cpuListFile.readAll()));
+        if (!cpus.empty()) {
+            nodes.push_back({ id, cpus });
+        }
+    }
+    std::sort(nodes.begin(), nodes.end(), [](const NumaNode& a, const NumaNode& b) { return a.id < b.id; });
+#endif
+
+    if (nodes.empty()) {
+        std::vector<int> cpus(std::max(QThread::idealThreadCount(), 1));
+        for (size_t i = 0; i < cpus.size(); ++i) {
+            cpus[i] = (int)i;
+        }
+        nodes.push_back({ 0, cpus });
+    }
+
+    return nodes;
+}
+
+bool bindToCpus(const std::vector<int>& cpus) {
+    if (cpus.empty()) {
+        return false;
+    }
+
+#if defined(Q_OS_LINUX)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (int cpu : cpus) {
+        if (cpu < CPU_SETSIZE) {
+            CPU_SET(cpu, &cpuSet);
+        }
+    }
+
+    // the affinity is per thread on Linux, so each thread already running is bound as well as the calling one
+    bool isBound = sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0;
+    for (const auto& task : QDir("/proc/self/task").entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        isBound = sched_setaffinity(task.toInt(), sizeof(cpuSet), &cpuSet) == 0 && isBound;
+    }
+    return isBound;
+#elif defined(Q_OS_WIN)
+    DWORD_PTR mask = 0;
+    for (int cpu : cpus) {
+        if (cpu < (int)(sizeof(DWORD_PTR) * 8)) {
+            mask |= (DWORD_PTR)1 << cpu;
+        }
+    }
+    return mask != 0 && SetProcessAffinityMask(GetCurrentProcess(), mask);
+#else
+    return false;
+#endif
+}
+
+bool preferNumaNode(int node) {
+#if defined(Q_OS_LINUX) && defined(SYS_set_mempolicy)
+    if (node < 0 || node >= MAX_CPUS) {
+        return false;
+    }
+
+    // MPOL_PREFERRED from linux/mempolicy.h, which falls back to the other nodes when this one is full
+    static const int PREFERRED_MEMORY_POLICY = 1;
+    static const int BITS_PER_MASK_WORD = sizeof(unsigned long) * 8;
+
+    std::vector<unsigned long> nodeMask(node / BITS_PER_MASK_WORD + 1, 0);
+    nodeMask[node / BITS_PER_MASK_WORD] |= 1UL << (node % BITS_PER_MASK_WORD);
+
+    // the kernel takes one more than the number of bits in the mask
+    if (syscall(SYS_set_mempolicy, PREFERRED_MEMORY_POLICY, nodeMask.data(), nodeMask.size() * BITS_PER_MASK_WORD + 1) != 0) {
+        return false;
+    }
+
+    preferredNumaNode = node;
+    return true;
+#else
+    Q_UNUSED(node);
+    return false;
+#endif
+}
+
+std::vector<int> getUsableCpus() {
+    std::vector<int> cpus;
+
+#if defined(Q_OS_LINUX)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &cpuSet)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#elif defined(Q_OS_WIN)
+    DWORD_PTR processMask = 0;
+    DWORD_PTR systemMask = 0;
+    if (GetProcessAffinityMask(GetCurrentProcess(), &processMask, &systemMask)) {
+        for (int cpu = 0; cpu < (int)(sizeof(DWORD_PTR) * 8); ++cpu) {
+            if (processMask & ((DWORD_PTR)1 << cpu)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+
+    if (cpus.empty()) {
+        for (int cpu = 0; cpu < std::max(QThread::idealThreadCount(), 1); ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+
+    return cpus;
+}
+
+int getNumUsableCpus() {
+    return (int)getUsableCpus().size();
+}
+
+QJsonObject getEffectivePlacement() {
+    auto cpus = getUsableCpus();
+
+    QJsonArray numaNodes;
+    for (const auto& node : getNumaNodes()) {
+        bool isUsed = std::any_of(node.cpus.cbegin(), node.cpus.cend(), [&cpus](int cpu) {
+            return std::binary_search(cpus.cbegin(), cpus.cend(), cpu);
+        });
+        if (isUsed) {
+            numaNodes.append(node.id);
+        }
+    }
+
+    QJsonObject placement;
+    placement["cpus"] = formatCpuList(cpus);
+    placement["num_cpus"] = (int)cpus.size();
+    placement["numa_nodes"] = numaNodes;
+    placement["memory_node"] = preferredNumaNode.load();
+    return placement;
+}
+
+}
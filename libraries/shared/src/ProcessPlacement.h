@@ -0,0 +1,53 @@
+//
+//  ProcessPlacement.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ProcessPlacement_h
+#define hifi_ProcessPlacement_h
+
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+
+/// Placing a process on a set of CPUs and the memory of a NUMA node, so that processes sharing a host don't share cores
+/// or reach across sockets for their memory. Placement is only supported on Linux, and CPU affinity on Windows.
+namespace ProcessPlacement {
+
+// parses a list of CPUs as the kernel writes them, such as "0-3,8,10-11"; empty if it isn't one
+std::vector<int> parseCpuList(const QString& cpuList);
+QString formatCpuList(std::vector<int> cpus);
+
+struct NumaNode {
+    int id;
+    std::vector<int> cpus;
+};
+
+// the NUMA nodes with CPUs, or a single node with every CPU where the topology isn't known
+std::vector<NumaNode> getNumaNodes();
+
+// binds all the threads of the process, and so the threads they start, to the CPUs
+bool bindToCpus(const std::vector<int>& cpus);
+
+// has the memory the calling thread and the threads it starts allocate come from the NUMA node where there's room
+bool preferNumaNode(int node);
+
+// the CPUs the calling thread can run on, which is what thread pools should be sized from
+std::vector<int> getUsableCpus();
+int getNumUsableCpus();
+
+// the CPUs and NUMA nodes the process is running on, for stats
+QJsonObject getEffectivePlacement();
+
+}
+
+#endif // hifi_ProcessPlacement_h
@@ -39,16 +39,51 @@ Q_LOGGING_CATEGORY(trace_baker, "trace.baker")
 #endif
 
 static bool tracingEnabled() {
-    if (!DependencyManager::isSet<tracing::Tracer>()) {
-        return false;
+    return tracing::Tracer::isActive();
+}
+
+DurationBase::DurationBase(const QLoggingCategory& category, const QString& name) : _category(category) {
+    if (tracingEnabled() && category.isDebugEnabled()) {
+        _nameID = tracing::Tracer::internName(name);
+        _categoryID = tracing::Tracer::internCategory(category);
     }
+}
 
-    // Cheers, love! The cavalry's here!
-    auto tracer = DependencyManager::get<tracing::Tracer>();
-    return (tracer && tracer->isEnabled());
+DurationBase::DurationBase(const QLoggingCategory& category, const char* name) : _category(category) {
+    if (tracingEnabled() && category.isDebugEnabled()) {
+        _nameID = tracing::Tracer::internName(name);
+        _categoryID = tracing::Tracer::internCategory(category);
+    }
 }
 
-DurationBase::DurationBase(const QLoggingCategory& category, const QString& name) : _name(name), _category(category) {
+static QString nameString(const QString& name) { return name; }
+static QString nameString(const char* name) { return QString::fromUtf8(name); }
+
+template <typename Name>
+void Duration::begin(const Name& name, uint32_t argbColor, uint64_t payload, const QVariantMap& baseArgs) {
+    // only a range with a payload or arguments takes the tracer's lock, to record them
+    if (payload == 0 && baseArgs.empty()) {
+        tracing::Tracer::recordEvent(_categoryID, _nameID, tracing::DurationBegin);
+    } else {
+        QVariantMap args = baseArgs;
+        args["nv_payload"] = QVariant::fromValue(payload);
+        tracing::traceEvent(_category, nameString(name), tracing::DurationBegin, "", args);
+    }
+
+#if defined(NSIGHT_TRACING)
+    nvtxEventAttributes_t eventAttrib{ 0 };
+    eventAttrib.version = NVTX_VERSION;
+    eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
+    eventAttrib.colorType = NVTX_COLOR_ARGB;
+    eventAttrib.color = argbColor;
+    eventAttrib.messageType = NVTX_MESSAGE_TYPE_ASCII;
+    QByteArray ascii = nameString(name).toUtf8();
+    eventAttrib.message.ascii = ascii.constData();
+    eventAttrib.payload.llValue = payload;
+    eventAttrib.payloadType = NVTX_PAYLOAD_TYPE_UNSIGNED_INT64;
+
+    nvtxRangePushEx(&eventAttrib);
+#endif
 }
 
 Duration::Duration(const QLoggingCategory& category,
@@ -57,30 +92,25 @@ Duration::Duration(const QLoggingCategory& category,
                    uint64_t payload,
                    const QVariantMap& baseArgs) :
     DurationBase(category, name) {
-    if (tracingEnabled() && category.isDebugEnabled()) {
-        QVariantMap args = baseArgs;
-        args["nv_payload"] = QVariant::fromValue(payload);
-        tracing::traceEvent(_category, _name, tracing::DurationBegin, "", args);
-
-#if defined(NSIGHT_TRACING)
-        nvtxEventAttributes_t eventAttrib{ 0 };
-        eventAttrib.version = NVTX_VERSION;
-        eventAttrib.size = NVTX_EVENT_ATTRIB_STRUCT_SIZE;
-        eventAttrib.colorType = NVTX_COLOR_ARGB;
-        eventAttrib.color = argbColor;
-        eventAttrib.messageType = NVTX_MESSAGE_TYPE_ASCII;
-        eventAttrib.message.ascii = name.toUtf8().data();
-        eventAttrib.payload.llValue = payload;
-        eventAttrib.payloadType = NVTX_PAYLOAD_TYPE_UNSIGNED_INT64;
+    if (isTraced()) {
+        begin(name, argbColor, payload, baseArgs);
+    }
+}
 
-        nvtxRangePushEx(&eventAttrib);
-#endif
+Duration::Duration(const QLoggingCategory& category,
+                   const char* name,
+                   uint32_t argbColor,
+                   uint64_t payload,
+                   const QVariantMap& baseArgs) :
+    DurationBase(category, name) {
+    if (isTraced()) {
+        begin(name, argbColor, payload, baseArgs);
     }
 }
 
 Duration::~Duration() {
-    if (tracingEnabled() && _category.isDebugEnabled()) {
-        tracing::traceEvent(_category, _name, tracing::DurationEnd);
+    if (isTraced()) {
+        tracing::Tracer::recordEvent(_categoryID, _nameID, tracing::DurationEnd);
 #ifdef NSIGHT_TRACING
         nvtxRangePop();
 #endif
@@ -117,13 +147,17 @@ ConditionalDuration::ConditionalDuration(const QLoggingCategory& category, const
     DurationBase(category, name), _startTime(tracing::Tracer::now()), _minTime(minTime * USECS_PER_MSEC) {
 }
 
+ConditionalDuration::ConditionalDuration(const QLoggingCategory& category, const char* name, uint32_t minTime) :
+    DurationBase(category, name), _startTime(tracing::Tracer::now()), _minTime(minTime * USECS_PER_MSEC) {
+}
+
 ConditionalDuration::~ConditionalDuration() {
-    if (tracingEnabled() && _category.isDebugEnabled()) {
+    if (isTraced()) {
         auto endTime = tracing::Tracer::now();
         auto duration = endTime - _startTime;
         if (duration >= _minTime) {
-            tracing::traceEvent(_category, _startTime, _name, tracing::DurationBegin);
-            tracing::traceEvent(_category, endTime, _name, tracing::DurationEnd);
+            tracing::Tracer::recordEvent(_categoryID, _nameID, tracing::DurationBegin, _startTime);
+            tracing::Tracer::recordEvent(_categoryID, _nameID, tracing::DurationEnd, endTime);
         }
     }
 }
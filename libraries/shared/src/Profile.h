@@ -37,26 +37,37 @@ Q_DECLARE_LOGGING_CATEGORY(trace_startup)
 Q_DECLARE_LOGGING_CATEGORY(trace_workload)
 Q_DECLARE_LOGGING_CATEGORY(trace_baker)
 
+// Interns the name when the category is being traced, so the range records its end under the same id without
+// keeping the name. Literal names are interned once per thread, see tracing::Tracer::internName.
 class DurationBase {
 
 protected:
     DurationBase(const QLoggingCategory& category, const QString& name);
-    const QString _name;
+    DurationBase(const QLoggingCategory& category, const char* name);
+    bool isTraced() const { return _nameID != 0; }
+
     const QLoggingCategory& _category;
+    uint32_t _nameID { 0 };
+    uint16_t _categoryID { 0 };
 };
 
 class Duration : public DurationBase {
 public:
     Duration(const QLoggingCategory& category, const QString& name, uint32_t argbColor = 0xff0000ff, uint64_t payload = 0, const QVariantMap& args = QVariantMap());
+    Duration(const QLoggingCategory& category, const char* name, uint32_t argbColor = 0xff0000ff, uint64_t payload = 0, const QVariantMap& args = QVariantMap());
     ~Duration();
 
     static uint64_t beginRange(const QLoggingCategory& category, const char* name, uint32_t argbColor);
     static void endRange(const QLoggingCategory& category, uint64_t rangeId);
+
+private:
+    template <typename Name> void begin(const Name& name, uint32_t argbColor, uint64_t payload, const QVariantMap& args);
 };
 
 class ConditionalDuration : public DurationBase {
 public:
     ConditionalDuration(const QLoggingCategory& category, const QString& name, uint32_t minTime);
+    ConditionalDuration(const QLoggingCategory& category, const char* name, uint32_t minTime);
     ~ConditionalDuration();
 
 private:
@@ -10,7 +10,6 @@
 //
 //
 // TODO:
-//   * consider adding iterator to enumerate the properties that have been set?
 //   * operator QSet<Enum> - this would be easiest way to handle enumeration
 //   * make encode(), QByteArray<< operator, and QByteArray operator const by moving calculation of encoded length to
 //     setFlag() and other calls
@@ -103,6 +102,12 @@ public:
     PropertyFlags operator^(Enum flag) const;
     PropertyFlags operator~() const;
 
+    // calls f for each flag that is set, in order, skipping over the unset flags a byte at a time
+    template<typename F> void forEachFlag(F&& f) const;
+
+    // true when every flag set here is also set in other
+    bool isSubsetOf(const PropertyFlags& other) const;
+
     void debugDumpBits();
 
     int getEncodedLength() const { return _encodedLength; }
@@ -254,6 +259,33 @@ template<typename Enum> inline size_t PropertyFlags<Enum>::decode(const QByteArr
     return decode(reinterpret_cast<const uint8_t*>(fromEncodedBytes.data()), fromEncodedBytes.size());
 }
 
+template<typename Enum> template<typename F> inline void PropertyFlags<Enum>::forEachFlag(F&& f) const {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(_flags.bits());
+    int numBytes = (_flags.size() + BITS_PER_BYTE - 1) / BITS_PER_BYTE;
+    for (int i = 0; i < numBytes; i++) {
+        int flag = i * BITS_PER_BYTE;
+        for (uint8_t byte = bytes[i]; byte != 0; byte >>= 1, flag++) {
+            if (byte & 1) {
+                f(static_cast<Enum>(flag));
+            }
+        }
+    }
+}
+
+template<typename Enum> inline bool PropertyFlags<Enum>::isSubsetOf(const PropertyFlags& other) const {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(_flags.bits());
+    const uint8_t* otherBytes = reinterpret_cast<const uint8_t*>(other._flags.bits());
+    int numBytes = (_flags.size() + BITS_PER_BYTE - 1) / BITS_PER_BYTE;
+    int numOtherBytes = (other._flags.size() + BITS_PER_BYTE - 1) / BITS_PER_BYTE;
+    for (int i = 0; i < numBytes; i++) {
+        uint8_t otherByte = i < numOtherBytes ? otherBytes[i] : 0;
+        if (bytes[i] & ~otherByte) {
+            return false;
+        }
+    }
+    return true;
+}
+
 template<typename Enum> inline void PropertyFlags<Enum>::debugDumpBits() {
     qCDebug(shared) << "_minFlag=" << _minFlag;
     qCDebug(shared) << "_maxFlag=" << _maxFlag;
@@ -281,10 +313,7 @@ template<typename Enum> inline PropertyFlags<Enum>& PropertyFlags<Enum>::operato
 }
 
 template<typename Enum> inline PropertyFlags<Enum>& PropertyFlags<Enum>::operator|=(Enum flag) {
-    PropertyFlags other(flag); 
-    _flags |= other._flags; 
-    _maxFlag = std::max(_maxFlag, other._maxFlag); 
-    _minFlag = std::min(_minFlag, other._minFlag); 
+    setHasProperty(flag, true);
     return *this; 
 }
 
@@ -315,11 +344,12 @@ template<typename Enum> inline PropertyFlags<Enum>& PropertyFlags<Enum>::operato
 }
 
 template<typename Enum> inline PropertyFlags<Enum>& PropertyFlags<Enum>::operator+=(const PropertyFlags& other) {
-    for(int flag = (int)other.firstFlag(); flag <= (int)other.lastFlag(); flag++) {
-        if (other.getHasProperty((Enum)flag)) {
-            setHasProperty((Enum)flag, true);
-        }
+    if (&other == this) {
+        return *this;
     }
+    other.forEachFlag([this](Enum flag) {
+        setHasProperty(flag, true);
+    });
     return *this; 
 }
 
@@ -329,11 +359,13 @@ template<typename Enum> inline PropertyFlags<Enum>& PropertyFlags<Enum>::operato
 }
 
 template<typename Enum> inline PropertyFlags<Enum>& PropertyFlags<Enum>::operator-=(const PropertyFlags& other) {
-    for(int flag = (int)other.firstFlag(); flag <= (int)other.lastFlag(); flag++) {
-        if (other.getHasProperty((Enum)flag)) {
-            setHasProperty((Enum)flag, false);
-        }
+    if (&other == this) {
+        clear();
+        return *this;
     }
+    other.forEachFlag([this](Enum flag) {
+        setHasProperty(flag, false);
+    });
     return *this;
 }
 
@@ -343,11 +375,12 @@ template<typename Enum> inline PropertyFlags<Enum>& PropertyFlags<Enum>::operato
 }
 
 template<typename Enum> inline PropertyFlags<Enum>& PropertyFlags<Enum>::operator<<=(const PropertyFlags& other) {
-    for(int flag = (int)other.firstFlag(); flag <= (int)other.lastFlag(); flag++) {
-        if (other.getHasProperty((Enum)flag)) {
-            setHasProperty((Enum)flag, true);
-        }
+    if (&other == this) {
+        return *this;
     }
+    other.forEachFlag([this](Enum flag) {
+        setHasProperty(flag, true);
+    });
     return *this; 
 }
 
@@ -0,0 +1,442 @@
+//
+//  SamplingProfiler.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SamplingProfiler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QProcessEnvironment>
+
+#include "Gzip.h"
+#include "NumericalConstants.h"
+#include "SharedLogging.h"
+
+#ifdef Q_OS_LINUX
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+static const QString SAMPLING_PROFILER_ENV = "HIFI_SAMPLING_PROFILER";
+
+std::atomic<bool> SamplingProfiler::_isProfiling { false };
+
+namespace {
+
+// the call stack of a thread, leaf first
+using SampleKey = std::pair<uint32_t, std::vector<uint64_t>>;
+using SampleCounts = std::map<SampleKey, int64_t>;
+
+struct Mapping {
+    uint64_t start;
+    uint64_t limit;
+    uint64_t offset;
+    QString file;
+};
+
+// Just enough of the protobuf wire format to write a profile.proto Profile
+class ProtoWriter {
+public:
+    void varint(uint64_t value) {
+        while (value >= 0x80) {
+            _data.append((char)((value & 0x7f) | 0x80));
+            value >>= 7;
+        }
+        _data.append((char)value);
+    }
+    void field(int field, uint64_t value) {
+        varint((uint64_t)field << 3);
+        varint(value);
+    }
+    void bytes(int field, const QByteArray& bytes) {
+        varint(((uint64_t)field << 3) | 2);
+        varint(bytes.size());
+        _data.append(bytes);
+    }
+    void message(int field, const ProtoWriter& message) { bytes(field, message._data); }
+    void packed(int field, const std::vector<uint64_t>& values) {
+        ProtoWriter packed;
+        for (auto value : values) {
+            packed.varint(value);
+        }
+        bytes(field, packed._data);
+    }
+    const QByteArray& data() const { return _data; }
+
+private:
+    QByteArray _data;
+};
+
+class StringTable {
+public:
+    StringTable() { index(QString()); }
+    uint64_t index(const QString& string) {
+        auto itr = _indices.find(string);
+        if (itr != _indices.end()) {
+            return itr.value();
+        }
+        uint64_t index = _strings.size();
+        _indices.insert(string, index);
+        _strings.push_back(string);
+        return index;
+    }
+    const std::vector<QString>& strings() const { return _strings; }
+
+private:
+    QHash<QString, uint64_t> _indices;
+    std::vector<QString> _strings;
+};
+
+std::vector<Mapping> readMappings() {
+    std::vector<Mapping> mappings;
+#ifdef Q_OS_LINUX
+    QFile maps("/proc/self/maps");
+    if (!maps.open(QIODevice::ReadOnly)) {
+        return mappings;
+    }
+    // start-limit perms offset device inode path
+    for (auto line : maps.readAll().split('\n')) {
+        auto fields = line.simplified().split(' ');
+        if (fields.size() < 6 || fields[1].size() < 3 || fields[1][2] != 'x' || !fields[5].startsWith('/')) {
+            continue;
+        }
+        auto range = fields[0].split('-');
+        if (range.size() != 2) {
+            continue;
+        }
+        mappings.push_back({ range[0].toULongLong(nullptr, 16), range[1].toULongLong(nullptr, 16),
+                             fields[2].toULongLong(nullptr, 16), QString::fromUtf8(fields[5]) });
+    }
+    std::sort(mappings.begin(), mappings.end(), [](const Mapping& a, const Mapping& b) { return a.start < b.start; });
+#endif
+    return mappings;
+}
+
+QByteArray writeProfile(const SampleCounts& samples, const QHash<uint32_t, QString>& threadNames,
+                        const std::vector<Mapping>& mappings, int64_t startNanos, int64_t durationNanos,
+                        int64_t periodNanos) {
+    // profile.proto field numbers
+    enum : int {
+        PROFILE_SAMPLE_TYPE = 1, PROFILE_SAMPLE, PROFILE_MAPPING, PROFILE_LOCATION, PROFILE_FUNCTION, PROFILE_STRING_TABLE,
+        PROFILE_TIME_NANOS = 9, PROFILE_DURATION_NANOS, PROFILE_PERIOD_TYPE, PROFILE_PERIOD
+    };
+    enum : int { VALUE_TYPE_TYPE = 1, VALUE_TYPE_UNIT };
+    enum : int { SAMPLE_LOCATION_ID = 1, SAMPLE_VALUE, SAMPLE_LABEL };
+    enum : int { LABEL_KEY = 1, LABEL_STR, LABEL_NUM };
+    enum : int { MAPPING_ID = 1, MAPPING_MEMORY_START, MAPPING_MEMORY_LIMIT, MAPPING_FILE_OFFSET, MAPPING_FILENAME };
+    enum : int { LOCATION_ID = 1, LOCATION_MAPPING_ID, LOCATION_ADDRESS };
+
+    StringTable strings;
+    ProtoWriter profile;
+
+    auto valueType = [&](const QString& type, const QString& unit) {
+        ProtoWriter value;
+        value.field(VALUE_TYPE_TYPE, strings.index(type));
+        value.field(VALUE_TYPE_UNIT, strings.index(unit));
+        return value;
+    };
+    profile.message(PROFILE_SAMPLE_TYPE, valueType("samples", "count"));
+    profile.message(PROFILE_SAMPLE_TYPE, valueType("cpu", "nanoseconds"));
+
+    // a location for each address sampled, in the mapping it's in
+    std::map<uint64_t, uint64_t> locationIDs;
+    for (auto& sample : samples) {
+        for (auto address : sample.first.second) {
+            locationIDs.emplace(address, 0);
+        }
+    }
+    uint64_t nextLocationID = 1;
+    for (auto& location : locationIDs) {
+        location.second = nextLocationID++;
+        uint64_t address = location.first;
+        auto mapping = std::upper_bound(mappings.begin(), mappings.end(), address, [](uint64_t address, const Mapping& mapping) {
+            return address < mapping.start;
+        });
+        ProtoWriter message;
+        message.field(LOCATION_ID, location.second);
+        if (mapping != mappings.begin() && address < std::prev(mapping)->limit) {
+            message.field(LOCATION_MAPPING_ID, (uint64_t)(std::prev(mapping) - mappings.begin()) + 1);
+        }
+        message.field(LOCATION_ADDRESS, address);
+        profile.message(PROFILE_LOCATION, message);
+    }
+
+    for (size_t i = 0; i < mappings.size(); ++i) {
+        ProtoWriter message;
+        message.field(MAPPING_ID, i + 1);
+        message.field(MAPPING_MEMORY_START, mappings[i].start);
+        message.field(MAPPING_MEMORY_LIMIT, mappings[i].limit);
+        message.field(MAPPING_FILE_OFFSET, mappings[i].offset);
+        message.field(MAPPING_FILENAME, strings.index(mappings[i].file));
+        profile.message(PROFILE_MAPPING, message);
+    }
+
+    for (auto& sample : samples) {
+        ProtoWriter message;
+        std::vector<uint64_t> locations;
+        locations.reserve(sample.first.second.size());
+        for (auto address : sample.first.second) {
+            locations.push_back(locationIDs[address]);
+        }
+        message.packed(SAMPLE_LOCATION_ID, locations);
+        message.packed(SAMPLE_VALUE, { (uint64_t)sample.second, (uint64_t)(sample.second * periodNanos) });
+
+        ProtoWriter threadLabel;
+        threadLabel.field(LABEL_KEY, strings.index("thread"));
+        threadLabel.field(LABEL_STR, strings.index(threadNames.value(sample.first.first)));
+        message.message(SAMPLE_LABEL, threadLabel);
+        ProtoWriter threadIDLabel;
+        threadIDLabel.field(LABEL_KEY, strings.index("thread_id"));
+        threadIDLabel.field(LABEL_NUM, sample.first.first);
+        message.message(SAMPLE_LABEL, threadIDLabel);
+
+        profile.message(PROFILE_SAMPLE, message);
+    }
+
+    profile.field(PROFILE_TIME_NANOS, startNanos);
+    profile.field(PROFILE_DURATION_NANOS, durationNanos);
+    profile.message(PROFILE_PERIOD_TYPE, valueType("cpu", "nanoseconds"));
+    profile.field(PROFILE_PERIOD, periodNanos);
+
+    // the string table goes last, as the rest adds to it
+    for (auto& string : strings.strings()) {
+        profile.bytes(PROFILE_STRING_TABLE, string.toUtf8());
+    }
+    return profile.data();
+}
+
+#ifdef Q_OS_LINUX
+
+// ring pages per thread, as a power of two: about a second of deep stacks at the highest frequency
+const size_t RING_DATA_PAGES = 16;
+const auto POLL_INTERVAL = std::chrono::milliseconds(10);
+const int RESCAN_THREADS_POLLS = 10;
+
+struct ThreadSampler {
+    int fd;
+    uint32_t threadID;
+    char* ring;
+    size_t ringSize;
+};
+
+// Reads the samples of a perf_event ring.
+class SampleReader {
+public:
+    SampleReader(int frequency) {
+        _pageSize = (size_t)sysconf(_SC_PAGESIZE);
+        memset(&_attributes, 0, sizeof(_attributes));
+        _attributes.size = sizeof(_attributes);
+        _attributes.type = PERF_TYPE_SOFTWARE;
+        _attributes.config = PERF_COUNT_SW_TASK_CLOCK;
+        _attributes.freq = 1;
+        _attributes.sample_freq = frequency;
+        _attributes.sample_type = PERF_SAMPLE_TID | PERF_SAMPLE_CALLCHAIN;
+        _attributes.exclude_kernel = 1;
+        _attributes.exclude_hv = 1;
+        _attributes.exclude_callchain_kernel = 1;
+    }
+
+    ~SampleReader() {
+        for (auto& sampler : _samplers) {
+            munmap(sampler.ring, sampler.ringSize);
+            close(sampler.fd);
+        }
+    }
+
+    // starts sampling the threads it isn't sampling yet, all but the calling one
+    bool addThreads(QString& error) {
+        uint32_t ownThreadID = (uint32_t)syscall(SYS_gettid);
+        for (auto& entry : QDir("/proc/self/task").entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+            uint32_t threadID = entry.toUInt();
+            if (threadID == 0 || threadID == ownThreadID || _threadNames.contains(threadID)) {
+                continue;
+            }
+
+            QFile comm(QString("/proc/self/task/%1/comm").arg(threadID));
+            _threadNames[threadID] = comm.open(QIODevice::ReadOnly) ? QString::fromUtf8(comm.readAll().trimmed()) : entry;
+
+            int fd = (int)syscall(SYS_perf_event_open, &_attributes, (pid_t)threadID, -1, -1, PERF_FLAG_FD_CLOEXEC);
+            if (fd < 0) {
+                // a thread can exit between listing and opening it, but nothing opening at all is an error
+                if (_samplers.empty() && errno != ESRCH) {
+                    error = QString("perf_event_open failed: %1, see kernel.perf_event_paranoid").arg(strerror(errno));
+                    return false;
+                }
+                continue;
+            }
+            size_t ringSize = (1 + RING_DATA_PAGES) * _pageSize;
+            void* ring = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (ring == MAP_FAILED) {
+                close(fd);
+                error = QString("mapping the perf_event ring failed: %1").arg(strerror(errno));
+                return false;
+            }
+            _samplers.push_back({ fd, threadID, (char*)ring, ringSize });
+        }
+        return true;
+    }
+
+    void read() {
+        for (auto& sampler : _samplers) {
+            auto metadata = (perf_event_mmap_page*)sampler.ring;
+            char* data = sampler.ring + _pageSize;
+            const uint64_t dataSize = RING_DATA_PAGES * _pageSize;
+
+            uint64_t head = __atomic_load_n(&metadata->data_head, __ATOMIC_ACQUIRE);
+            uint64_t tail = metadata->data_tail;
+            while (tail < head) {
+                perf_event_header header;
+                copy(data, dataSize, tail, &header, sizeof(header));
+                if (header.size < sizeof(header)) {
+                    break;
+                }
+                _record.resize(header.size);
+                copy(data, dataSize, tail, _record.data(), header.size);
+                tail += header.size;
+
+                if (header.type == PERF_RECORD_SAMPLE) {
+                    addSample();
+                } else if (header.type == PERF_RECORD_LOST) {
+                    // u64 id, u64 lost
+                    uint64_t lost;
+                    memcpy(&lost, _record.data() + sizeof(header) + sizeof(uint64_t), sizeof(lost));
+                    _numLost += lost;
+                }
+            }
+            __atomic_store_n(&metadata->data_tail, tail, __ATOMIC_RELEASE);
+        }
+    }
+
+    SampleCounts samples;
+    uint64_t _numLost { 0 };
+    QHash<uint32_t, QString> _threadNames;
+
+private:
+    static void copy(const char* data, uint64_t dataSize, uint64_t position, void* destination, size_t size) {
+        uint64_t offset = position % dataSize;
+        size_t first = (size_t)std::min<uint64_t>(size, dataSize - offset);
+        memcpy(destination, data + offset, first);
+        memcpy((char*)destination + first, data, size - first);
+    }
+
+    void addSample() {
+        // u32 pid, u32 tid, u64 nr, u64 ips[nr]
+        const char* sample = _record.data() + sizeof(perf_event_header);
+        const char* end = _record.data() + _record.size();
+        uint32_t threadID;
+        uint64_t numAddresses;
+        if (sample + 2 * sizeof(uint32_t) + sizeof(uint64_t) > end) {
+            return;
+        }
+        memcpy(&threadID, sample + sizeof(uint32_t), sizeof(threadID));
+        memcpy(&numAddresses, sample + 2 * sizeof(uint32_t), sizeof(numAddresses));
+        const char* addresses = sample + 2 * sizeof(uint32_t) + sizeof(uint64_t);
+        if (addresses + numAddresses * sizeof(uint64_t) > end) {
+            return;
+        }
+
+        SampleKey key { threadID, {} };
+        key.second.reserve(numAddresses);
+        for (uint64_t i = 0; i < numAddresses; ++i) {
+            uint64_t address;
+            memcpy(&address, addresses + i * sizeof(uint64_t), sizeof(address));
+            // skip the markers of which context the addresses after them are in
+            if (address < PERF_CONTEXT_MAX) {
+                key.second.push_back(address);
+            }
+        }
+        if (!key.second.empty()) {
+            samples[key]++;
+        }
+    }
+
+    size_t _pageSize;
+    perf_event_attr _attributes;
+    std::vector<ThreadSampler> _samplers;
+    std::vector<char> _record;
+};
+
+#endif
+
+}
+
+bool SamplingProfiler::isEnabled() {
+    static const bool enabled = QProcessEnvironment::systemEnvironment().value(SAMPLING_PROFILER_ENV) == "1";
+    return enabled;
+}
+
+QByteArray SamplingProfiler::profile(std::chrono::milliseconds duration, int frequency, QString& error) {
+    if (!isEnabled()) {
+        error = QString("sampling profiles need the process started with %1=1").arg(SAMPLING_PROFILER_ENV);
+        return QByteArray();
+    }
+    if (frequency <= 0 || frequency > MAX_FREQUENCY || duration.count() <= 0 ||
+        duration > std::chrono::seconds(MAX_DURATION_SECS)) {
+        error = QString("profiles are up to %1 seconds at up to %2 Hz").arg(MAX_DURATION_SECS).arg(MAX_FREQUENCY);
+        return QByteArray();
+    }
+
+#ifdef Q_OS_LINUX
+    if (_isProfiling.exchange(true)) {
+        error = "a profile is already being taken";
+        return QByteArray();
+    }
+
+    QByteArray result;
+    {
+        int64_t startNanos = QDateTime::currentMSecsSinceEpoch() * NSECS_PER_MSEC;
+        auto start = std::chrono::steady_clock::now();
+        auto end = start + duration;
+
+        SampleReader reader(frequency);
+        if (reader.addThreads(error)) {
+            for (int poll = 1; std::chrono::steady_clock::now() < end; ++poll) {
+                std::this_thread::sleep_for(POLL_INTERVAL);
+                reader.read();
+                if (poll % RESCAN_THREADS_POLLS == 0 && !reader.addThreads(error)) {
+                    break;
+                }
+            }
+            reader.read();
+
+            if (error.isEmpty()) {
+                if (reader._numLost > 0) {
+                    qCWarning(shared) << "Sampling profiler lost" << reader._numLost << "samples";
+                }
+                int64_t durationNanos = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start).count();
+                int64_t periodNanos = NSECS_PER_SECOND / frequency;
+                // the mappings are read last, to have the libraries loaded while sampling
+                QByteArray profile = writeProfile(reader.samples, reader._threadNames, readMappings(), startNanos,
+                                                  durationNanos, periodNanos);
+                gzip(profile, result);
+            }
+        }
+    }
+
+    _isProfiling = false;
+    return result;
+#else
+    error = "sampling profiles are only supported on Linux";
+    return QByteArray();
+#endif
+}
@@ -0,0 +1,43 @@
+//
+//  SamplingProfiler.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SamplingProfiler_h
+#define hifi_SamplingProfiler_h
+
+#include <atomic>
+#include <chrono>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+// Samples the call stacks of every thread of the process, for a CPU profile of where a running server or client spends
+// its time. Profiles are gzipped pprof protobufs holding the sampled addresses and the process's mappings, which pprof
+// symbolizes offline against the same binaries.
+//
+// Processes only profile when started with HIFI_SAMPLING_PROFILER=1. Sampling uses perf_event_open, so it works on
+// Linux when kernel.perf_event_paranoid allows it, and the stacks are as deep as the binaries' frame pointers go.
+class SamplingProfiler {
+public:
+    static const int DEFAULT_FREQUENCY = 99;
+    static const int MAX_FREQUENCY = 1000;
+    static const int MAX_DURATION_SECS = 60;
+
+    static bool isEnabled();
+
+    // samples the process for duration at frequency Hz and returns the profile, blocking the calling thread meanwhile;
+    // returns an empty profile with the reason in error if it can't, including while another profile is being taken
+    static QByteArray profile(std::chrono::milliseconds duration, int frequency, QString& error);
+
+private:
+    static std::atomic<bool> _isProfiling;
+};
+
+#endif // hifi_SamplingProfiler_h
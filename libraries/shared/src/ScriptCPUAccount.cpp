@@ -0,0 +1,58 @@
+//
+//  ScriptCPUAccount.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptCPUAccount.h"
+
+#include <algorithm>
+
+#include "NumericalConstants.h"
+
+const uint64_t ScriptCPUAccount::WINDOW_USECS = WINDOW_SECONDS * USECS_PER_SECOND;
+
+void ScriptCPUAccount::add(uint64_t now, uint64_t usecs) {
+    advance(now / USECS_PER_SECOND);
+    _buckets[_second % WINDOW_SECONDS] += usecs;
+    _totalUsecs += usecs;
+    _longestUsecs = std::max(_longestUsecs, usecs);
+}
+
+uint64_t ScriptCPUAccount::getWindowUsecs(uint64_t now) const {
+    uint64_t second = now / USECS_PER_SECOND;
+    if (second >= _second + WINDOW_SECONDS) {
+        return 0;
+    }
+
+    // the buckets that have gone past the window since the last add no longer count
+    uint64_t usecs = 0;
+    for (uint64_t bucketSecond = (second >= (uint64_t)WINDOW_SECONDS ? second - WINDOW_SECONDS + 1 : 0);
+         bucketSecond <= _second; ++bucketSecond) {
+        usecs += _buckets[bucketSecond % WINDOW_SECONDS];
+    }
+    return usecs;
+}
+
+float ScriptCPUAccount::getLoad(uint64_t now) const {
+    return std::min((float)getWindowUsecs(now) / (float)WINDOW_USECS, 1.0f);
+}
+
+void ScriptCPUAccount::advance(uint64_t second) {
+    if (second <= _second) {
+        return;
+    }
+    if (second - _second >= (uint64_t)WINDOW_SECONDS) {
+        _buckets.fill(0);
+    } else {
+        for (uint64_t bucketSecond = _second + 1; bucketSecond <= second; ++bucketSecond) {
+            _buckets[bucketSecond % WINDOW_SECONDS] = 0;
+        }
+    }
+    _second = second;
+}
@@ -0,0 +1,50 @@
+//
+//  ScriptCPUAccount.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ScriptCPUAccount_h
+#define hifi_ScriptCPUAccount_h
+
+#include <array>
+#include <cstdint>
+
+// The time a script has spent running over the last WINDOW_SECONDS, kept in one second buckets, so that its load can be held
+// to a budget without a single slow frame tripping it. Times are in microseconds, as given by usecTimestampNow(). Not thread
+// safe.
+class ScriptCPUAccount {
+public:
+    static const int WINDOW_SECONDS = 10;
+    static const uint64_t WINDOW_USECS;
+
+    // counts usecs of running that ended at now
+    void add(uint64_t now, uint64_t usecs);
+
+    // the time spent running over the window up to now
+    uint64_t getWindowUsecs(uint64_t now) const;
+
+    // the share of a thread the script took over the window up to now, always over the whole window, so a burst of running
+    // only goes over a budget if it keeps up
+    float getLoad(uint64_t now) const;
+
+    uint64_t getTotalUsecs() const { return _totalUsecs; }
+    uint64_t getLongestUsecs() const { return _longestUsecs; }
+
+private:
+    void advance(uint64_t second);
+
+    std::array<uint64_t, WINDOW_SECONDS> _buckets {};
+    uint64_t _second { 0 }; // the second the newest bucket counts
+    uint64_t _totalUsecs { 0 };
+    uint64_t _longestUsecs { 0 };
+};
+
+#endif // hifi_ScriptCPUAccount_h
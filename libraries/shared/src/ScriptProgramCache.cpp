@@ -0,0 +1,195 @@
+//
+//  ScriptProgramCache.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProgramCache.h"
+
+#include <limits>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QThread>
+#include <QtScript/QScriptEngine>
+
+// what an entry costs besides its programs: the key, the syntax check and the bookkeeping
+static const size_t ENTRY_OVERHEAD_BYTES = 256;
+
+// QtScript doesn't say how big a compiled program is; its bytecode and the tables around it typically run to a few times
+// the size of the source, and the program keeps a copy of the source as well
+static const size_t ESTIMATED_PROGRAM_BYTES_PER_SOURCE_BYTE = 5;
+
+ScriptProgramCache& ScriptProgramCache::getInstance() {
+    static ScriptProgramCache instance;
+    return instance;
+}
+
+QByteArray ScriptProgramCache::hashSource(const QString& sourceCode) {
+    auto sourceBytes = QByteArray::fromRawData(reinterpret_cast<const char*>(sourceCode.constData()),
+                                               sourceCode.size() * (int)sizeof(QChar));
+    return QCryptographicHash::hash(sourceBytes, QCryptographicHash::Sha1);
+}
+
+ScriptProgramCache::SyntaxCheck ScriptProgramCache::checkSyntax(const QString& sourceCode) {
+    auto hash = hashSource(sourceCode);
+    {
+        Lock lock(_mutex);
+        auto it = _entries.find(hash);
+        if (it != _entries.end() && it->isSyntaxChecked) {
+            ++_hits;
+            _lru.splice(_lru.end(), _lru, it->lruPosition);
+            return it->syntaxCheck;
+        }
+        ++_misses;
+    }
+
+    // parsed without holding the lock, two threads checking the same new source at once both parse it
+    SyntaxCheck syntaxCheck;
+    auto result = QScriptEngine::checkSyntax(sourceCode);
+    if (result.state() != QScriptSyntaxCheckResult::Valid) {
+        syntaxCheck.isValid = false;
+        syntaxCheck.errorMessage = result.errorMessage();
+        syntaxCheck.errorLineNumber = result.errorLineNumber();
+        syntaxCheck.errorColumnNumber = result.errorColumnNumber();
+    }
+
+    Lock lock(_mutex);
+    auto& entry = touchEntry(hash, sourceCode.size() * sizeof(QChar));
+    entry.isSyntaxChecked = true;
+    entry.syntaxCheck = syntaxCheck;
+    evict();
+    return syntaxCheck;
+}
+
+QScriptProgram ScriptProgramCache::getProgram(QScriptEngine* engine, const QString& sourceCode, const QString& fileName,
+                                              int lineNumber) {
+    auto hash = hashSource(sourceCode);
+    ProgramKey key { engine, fileName, lineNumber };
+
+    Lock lock(_mutex);
+    auto& entry = touchEntry(hash, sourceCode.size() * sizeof(QChar));
+    auto it = entry.programs.find(key);
+    if (it != entry.programs.end()) {
+        ++_hits;
+        return it->second;
+    }
+    ++_misses;
+
+    // QScriptProgram doesn't compile until it is first evaluated, so this is cheap to do under the lock
+    QScriptProgram program { sourceCode, fileName, lineNumber };
+    entry.programs.emplace(key, program);
+    updateBytes(entry);
+    evict();
+    return program;
+}
+
+void ScriptProgramCache::releaseEngine(QScriptEngine* engine) {
+    Lock lock(_mutex);
+    for (auto it = _entries.begin(); it != _entries.end();) {
+        auto& programs = it->programs;
+        auto first = programs.lower_bound(ProgramKey { engine, QString(), std::numeric_limits<int>::min() });
+        auto last = first;
+        while (last != programs.end() && std::get<0>(last->first) == engine) {
+            ++last;
+        }
+        if (first == last) {
+            ++it;
+            continue;
+        }
+
+        programs.erase(first, last);
+        if (programs.empty() && !it->isSyntaxChecked) {
+            it = removeEntry(it);
+        } else {
+            updateBytes(*it);
+            ++it;
+        }
+    }
+}
+
+void ScriptProgramCache::setMaxBytes(size_t maxBytes) {
+    Lock lock(_mutex);
+    _maxBytes = maxBytes;
+    evict();
+}
+
+size_t ScriptProgramCache::getMaxBytes() const {
+    Lock lock(_mutex);
+    return _maxBytes;
+}
+
+ScriptProgramCache::Stats ScriptProgramCache::getStats() const {
+    Lock lock(_mutex);
+    Stats stats;
+    stats.numEntries = _entries.size();
+    for (const auto& entry : _entries) {
+        stats.numPrograms += (int)entry.programs.size();
+    }
+    stats.bytes = _bytes;
+    stats.maxBytes = _maxBytes;
+    stats.hits = _hits;
+    stats.misses = _misses;
+    stats.evictions = _evictions;
+    return stats;
+}
+
+void ScriptProgramCache::clear() {
+    Lock lock(_mutex);
+    while (!_entries.isEmpty()) {
+        removeEntry(_entries.begin());
+    }
+}
+
+ScriptProgramCache::Entry& ScriptProgramCache::touchEntry(const QByteArray& hash, size_t sourceBytes) {
+    auto it = _entries.find(hash);
+    if (it == _entries.end()) {
+        it = _entries.insert(hash, Entry());
+        it->sourceBytes = sourceBytes;
+        it->lruPosition = _lru.insert(_lru.end(), hash);
+        updateBytes(*it);
+    } else {
+        _lru.splice(_lru.end(), _lru, it->lruPosition);
+    }
+    return *it;
+}
+
+void ScriptProgramCache::updateBytes(Entry& entry) {
+    _bytes -= entry.bytes;
+    entry.bytes = ENTRY_OVERHEAD_BYTES + entry.programs.size() * entry.sourceBytes * ESTIMATED_PROGRAM_BYTES_PER_SOURCE_BYTE;
+    _bytes += entry.bytes;
+}
+
+void ScriptProgramCache::evict() {
+    // the most recently used entry is the one being asked for, so it stays even if it is over the limit on its own
+    while (_bytes > _maxBytes && _lru.size() > 1) {
+        removeEntry(_entries.find(_lru.front()));
+        ++_evictions;
+    }
+}
+
+QHash<QByteArray, ScriptProgramCache::Entry>::iterator ScriptProgramCache::removeEntry(QHash<QByteArray, Entry>::iterator it) {
+    for (auto& program : it->programs) {
+        releaseProgram(std::get<0>(program.first), program.second);
+    }
+    _bytes -= it->bytes;
+    _lru.erase(it->lruPosition);
+    return _entries.erase(it);
+}
+
+void ScriptProgramCache::releaseProgram(QScriptEngine* engine, QScriptProgram& program) {
+    if (engine->thread() == QThread::currentThread()) {
+        program = QScriptProgram();
+        return;
+    }
+
+    // the engine's own copy, if it is still evaluating it, keeps the program alive; otherwise the last reference goes with the
+    // queued call, on the engine's thread. It is posted under the lock, so the engine can't be released and gone before it is
+    // posted, and posted events are dropped on the engine's thread if it goes away first.
+    QMetaObject::invokeMethod(engine, [program] {}, Qt::QueuedConnection);
+    program = QScriptProgram();
+}
@@ -0,0 +1,113 @@
+//
+//  ScriptProgramCache.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ScriptProgramCache_h
+#define hifi_ScriptProgramCache_h
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtScript/QScriptProgram>
+
+class QScriptEngine;
+
+// Caches the syntax checks and compiled programs of scripts, keyed by a hash of their source, so that a script evaluated
+// over and over -- an entity script shared by hundreds of entities, a library every script includes -- is parsed and
+// compiled once. A syntax check holds for any engine and is shared by all of them. A QScriptProgram compiles into the first
+// engine it is evaluated in and can't be shared between threads, so programs are kept per engine, are only ever handed to
+// the engine they were made for, and are always let go of on that engine's thread.
+//
+// Entries are evicted least recently used first once the estimated memory they hold goes over the limit.
+class ScriptProgramCache {
+public:
+    static const size_t DEFAULT_MAX_BYTES = 64 * 1024 * 1024;
+
+    struct SyntaxCheck {
+        bool isValid { true };
+        QString errorMessage;
+        int errorLineNumber { 0 };
+        int errorColumnNumber { 0 };
+    };
+
+    struct Stats {
+        int numEntries { 0 };
+        int numPrograms { 0 };
+        size_t bytes { 0 };
+        size_t maxBytes { 0 };
+        uint64_t hits { 0 };
+        uint64_t misses { 0 };
+        uint64_t evictions { 0 };
+    };
+
+    static ScriptProgramCache& getInstance();
+
+    // checks the source's syntax, or returns the outcome of having checked the same source before; can be called from any
+    // thread
+    SyntaxCheck checkSyntax(const QString& sourceCode);
+
+    // the program for the source in engine, compiled the first time the engine evaluates it; call from the engine's thread
+    // and only ever evaluate the program in that engine
+    QScriptProgram getProgram(QScriptEngine* engine, const QString& sourceCode, const QString& fileName, int lineNumber = 1);
+
+    // drops the engine's programs; call from the engine's thread before it goes away
+    void releaseEngine(QScriptEngine* engine);
+
+    void setMaxBytes(size_t maxBytes);
+    size_t getMaxBytes() const;
+
+    Stats getStats() const;
+    void clear();
+
+private:
+    using Mutex = std::mutex;
+    using Lock = std::unique_lock<Mutex>;
+    using ProgramKey = std::tuple<QScriptEngine*, QString, int>;
+
+    struct Entry {
+        bool isSyntaxChecked { false };
+        SyntaxCheck syntaxCheck;
+        std::map<ProgramKey, QScriptProgram> programs;
+        size_t sourceBytes { 0 };
+        size_t bytes { 0 };
+        std::list<QByteArray>::iterator lruPosition;
+    };
+
+    static QByteArray hashSource(const QString& sourceCode);
+
+    // the entry for the hash, made if there isn't one, and moved to the most recently used end
+    Entry& touchEntry(const QByteArray& hash, size_t sourceBytes);
+    void updateBytes(Entry& entry);
+
+    // evicts entries until the cache is back under its limit
+    void evict();
+    QHash<QByteArray, Entry>::iterator removeEntry(QHash<QByteArray, Entry>::iterator it);
+
+    // lets go of a program on its engine's thread
+    static void releaseProgram(QScriptEngine* engine, QScriptProgram& program);
+
+    mutable Mutex _mutex;
+    QHash<QByteArray, Entry> _entries;
+    std::list<QByteArray> _lru; // least recently used first
+    size_t _bytes { 0 };
+    size_t _maxBytes { DEFAULT_MAX_BYTES };
+    uint64_t _hits { 0 };
+    uint64_t _misses { 0 };
+    uint64_t _evictions { 0 };
+};
+
+#endif // hifi_ScriptProgramCache_h
@@ -38,7 +38,7 @@ namespace Setting {
         settingsManagerThread->wait();
 
         // [IMPORTANT] Save all settings when the QApplication goes down
-        globalManager->saveAll();
+        globalManager->writePendingChanges();
 
         qCDebug(shared) << "Settings thread stopped.";
     }
@@ -103,6 +103,8 @@ namespace Setting {
         }
 
         // Setup settings manager, the manager will live until the process shuts down
+        // It reads the file itself, so the keys loaded from the old file have to be written first
+        settings.sync();
         DependencyManager::set<Manager>();
 
         // Add pre-routine to setup threading
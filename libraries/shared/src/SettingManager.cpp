@@ -11,14 +11,54 @@
 
 #include "SettingManager.h"
 
+#include <QtCore/QCoreApplication>
 #include <QtCore/QThread>
 #include <QtCore/QDebug>
+#include <QtCore/QSet>
 #include <QtCore/QUuid>
 
+#include "NumericalConstants.h"
+#include "PerformanceCounters.h"
 #include "SettingInterface.h"
+#include "SharedUtil.h"
 
 namespace Setting {
 
+    static const int SAVE_CHECK_INTERVAL_MSEC = 1000; // 1 sec
+    // changes are written once none has been made for this long...
+    static const quint64 SAVE_SETTLE_USECS = 1 * USECS_PER_SECOND;
+    // ...or the first has waited this long
+    static const quint64 MAX_SAVE_DELAY_USECS = 5 * USECS_PER_SECOND;
+
+    static PerformanceCounters::Counter& settingChanges() {
+        static auto& counter = PerformanceCounters::getInstance().counter("setting_changes",
+            "Settings values changed in memory");
+        return counter;
+    }
+
+    static PerformanceCounters::Counter& settingWrites() {
+        static auto& counter = PerformanceCounters::getInstance().counter("setting_writes",
+            "Times the changed settings were written to disk");
+        return counter;
+    }
+
+    static PerformanceCounters::Counter& mainThreadSettingWrites() {
+        static auto& counter = PerformanceCounters::getInstance().counter("setting_main_thread_writes",
+            "Times the settings were written to disk from the main thread before shutdown, which should stay at zero");
+        return counter;
+    }
+
+    // the keys as QSettings normalizes them: slashes for backslashes and no empty sections
+    static QString normalizedKey(const QString& key) {
+        return QString(key).replace('\\', '/').split('/', Qt::SkipEmptyParts).join('/');
+    }
+
+    Manager::Manager() : _fileName(_qSettings.fileName()) {
+        // never fall back to writing the file in place, where a crash would leave half of it
+        _qSettings.setAtomicSyncRequired(true);
+        loadStore();
+    }
+
     Manager::~Manager() {
         // Cleanup timer
         stopTimer();
@@ -29,6 +69,11 @@ namespace Setting {
     // Custom deleter does nothing, because we need to shutdown later than the dependency manager
     void Manager::customDeleter() { }
 
+    void Manager::reload() {
+        writePendingChanges();
+        loadStore();
+    }
+
     void Manager::registerHandle(Interface* handle) {
         const QString& key = handle->getKey();
         withWriteLock([&] {
@@ -46,40 +91,27 @@ namespace Setting {
     }
 
     void Manager::loadSetting(Interface* handle) {
-        const auto& key = handle->getKey();
-        withWriteLock([&] {
-            QVariant loadedValue;
-            if (_pendingChanges.contains(key) && _pendingChanges[key] != UNSET_VALUE) {
-                loadedValue = _pendingChanges[key];
-            } else {
-                loadedValue = _qSettings.value(key);
-            }
-            if (loadedValue.isValid()) {
-                handle->setVariant(loadedValue);
-            }
-        });
+        QVariant loadedValue = getStoredValue(normalizedKey(handle->getKey()), QVariant());
+        if (loadedValue.isValid()) {
+            handle->setVariant(loadedValue);
+        }
     }
 
 
     void Manager::saveSetting(Interface* handle) {
-        const auto& key = handle->getKey();
         QVariant handleValue = UNSET_VALUE;
         if (handle->isSet()) {
             handleValue = handle->getVariant();
         }
-
-        withWriteLock([&] {
-            _pendingChanges[key] = handleValue;
-        });
+        storeValue(normalizedKey(handle->getKey()), handleValue);
     }
 
-    static const int SAVE_INTERVAL_MSEC = 5 * 1000; // 5 sec
     void Manager::startTimer() {
         if (!_saveTimer) {
             _saveTimer = new QTimer(this);
             Q_CHECK_PTR(_saveTimer);
             _saveTimer->setSingleShot(true); // We will restart it once settings are saved.
-            _saveTimer->setInterval(SAVE_INTERVAL_MSEC); // 5s, Qt::CoarseTimer acceptable
+            _saveTimer->setInterval(SAVE_CHECK_INTERVAL_MSEC); // Qt::CoarseTimer acceptable
             connect(_saveTimer, SIGNAL(timeout()), this, SLOT(saveAll()));
         }
         _saveTimer->start();
@@ -92,27 +124,20 @@ namespace Setting {
     }
 
     void Manager::saveAll() {
-        withWriteLock([&] {
-            bool forceSync = false;
-            for (auto key : _pendingChanges.keys()) {
-                auto newValue = _pendingChanges[key];
-                auto savedValue = _qSettings.value(key, UNSET_VALUE);
-                if (newValue == savedValue) {
-                    continue;
-                }
-                forceSync = true;
-                if (newValue == UNSET_VALUE || !newValue.isValid()) {
-                    _qSettings.remove(key);
-                } else {
-                    _qSettings.setValue(key, newValue);
-                }
-            }
-            _pendingChanges.clear();
+        bool isDue = false;
+        {
+            QMutexLocker locker(&_pendingMutex);
+            quint64 now = usecTimestampNow();
+            isDue = !_pendingChanges.isEmpty() &&
+                (now - _lastPendingChange >= SAVE_SETTLE_USECS || now - _firstPendingChange >= MAX_SAVE_DELAY_USECS);
+        }
 
-            if (forceSync) {
-                _qSettings.sync();
+        if (isDue) {
+            if (qApp && QThread::currentThread() == qApp->thread()) {
+                mainThreadSettingWrites().increment();
             }
-        });
+            writePendingChanges();
+        }
 
         // Restart timer
         if (_saveTimer) {
@@ -120,87 +145,292 @@ namespace Setting {
         }
     }
 
-    QString Manager::fileName() const {
+    void Manager::writePendingChanges() {
+        // the file lock is taken first, so changes taken out by one writer can't land on the disk after newer ones
+        QMutexLocker fileLocker(&_fileMutex);
+        QHash<QString, QVariant> changes;
+        {
+            QMutexLocker locker(&_pendingMutex);
+            changes.swap(_pendingChanges);
+            _firstPendingChange = 0;
+            _lastPendingChange = 0;
+        }
+
+        bool forceSync = false;
+        for (auto it = changes.cbegin(); it != changes.cend(); ++it) {
+            const auto& newValue = it.value();
+            auto savedValue = _qSettings.value(it.key(), UNSET_VALUE);
+            if (newValue == savedValue) {
+                continue;
+            }
+            forceSync = true;
+            if (newValue == UNSET_VALUE || !newValue.isValid()) {
+                _qSettings.remove(it.key());
+            } else {
+                _qSettings.setValue(it.key(), newValue);
+            }
+        }
+
+        if (forceSync) {
+            _qSettings.sync();
+            settingWrites().increment();
+            if (_qSettings.status() != QSettings::NoError) {
+                qWarning() << "Setting::Manager failed to write" << _fileName;
+            }
+        }
+    }
+
+    void Manager::loadStore() {
+        QHash<QString, QVariant> values;
+        {
+            QMutexLocker locker(&_fileMutex);
+            // picks up the file's changes since it was last read
+            _qSettings.sync();
+            for (const auto& key : _qSettings.allKeys()) {
+                values.insert(key, _qSettings.value(key));
+            }
+        }
+
+        for (auto& stripe : _stripes) {
+            QWriteLocker locker(&stripe.lock);
+            stripe.values.clear();
+        }
+        for (auto it = values.cbegin(); it != values.cend(); ++it) {
+            auto& stripe = getStripe(it.key());
+            QWriteLocker locker(&stripe.lock);
+            stripe.values.insert(it.key(), it.value());
+        }
+    }
+
+    QVariant Manager::getStoredValue(const QString& key, const QVariant& defaultValue) const {
+        const auto& stripe = getStripe(key);
+        QReadLocker locker(&stripe.lock);
+        return stripe.values.value(key, defaultValue);
+    }
+
+    void Manager::storeValue(const QString& key, const QVariant& value) {
+        {
+            auto& stripe = getStripe(key);
+            QWriteLocker locker(&stripe.lock);
+            if (value == UNSET_VALUE || !value.isValid()) {
+                stripe.values.remove(key);
+            } else {
+                stripe.values.insert(key, value);
+            }
+        }
+
+        quint64 now = usecTimestampNow();
+        QMutexLocker locker(&_pendingMutex);
+        _pendingChanges.insert(key, value);
+        if (_firstPendingChange == 0) {
+            _firstPendingChange = now;
+        }
+        _lastPendingChange = now;
+        settingChanges().increment();
+    }
+
+    void Manager::removeStoredValues(const QString& key) {
+        // the key and everything under it, or everything for the top level group
+        QString prefix = key + "/";
+        QStringList removedKeys;
+        for (auto& stripe : _stripes) {
+            QWriteLocker locker(&stripe.lock);
+            for (auto it = stripe.values.begin(); it != stripe.values.end();) {
+                if (key.isEmpty() || it.key() == key || it.key().startsWith(prefix)) {
+                    removedKeys.push_back(it.key());
+                    it = stripe.values.erase(it);
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+        quint64 now = usecTimestampNow();
+        QMutexLocker locker(&_pendingMutex);
+        for (const auto& removedKey : removedKeys) {
+            _pendingChanges.insert(removedKey, UNSET_VALUE);
+        }
+        if (!removedKeys.isEmpty()) {
+            if (_firstPendingChange == 0) {
+                _firstPendingChange = now;
+            }
+            _lastPendingChange = now;
+            settingChanges().increment(removedKeys.size());
+        }
+    }
+
+    QString Manager::getFullKey(const QString& key) const {
         return resultWithReadLock<QString>([&] {
-            return _qSettings.fileName();
+            return normalizedKey(_groupPrefix + key);
         });
     }
 
-    void Manager::remove(const QString &key) {
+    void Manager::beginGroupOrArray(const Group& group) {
         withWriteLock([&] {
-            _qSettings.remove(key);
+            _groups.push_back(group);
+            updateGroupPrefix();
         });
     }
 
+    void Manager::updateGroupPrefix() {
+        _groupPrefix.clear();
+        for (const auto& group : _groups) {
+            _groupPrefix += group.name + "/";
+            if (group.index >= 0) {
+                _groupPrefix += QString::number(group.index + 1) + "/";
+            }
+        }
+    }
+
+    QString Manager::fileName() const {
+        return _fileName;
+    }
+
+    void Manager::remove(const QString &key) {
+        removeStoredValues(getFullKey(key));
+    }
+
     QStringList Manager::childGroups() const {
-        return resultWithReadLock<QStringList>([&] {
-            return _qSettings.childGroups();
-        });
+        QString group = getFullKey(QString());
+        QString prefix = group.isEmpty() ? group : group + "/";
+        QSet<QString> children;
+        for (const auto& stripe : _stripes) {
+            QReadLocker locker(&stripe.lock);
+            for (auto it = stripe.values.cbegin(); it != stripe.values.cend(); ++it) {
+                if (it.key().startsWith(prefix)) {
+                    int separator = it.key().indexOf('/', prefix.length());
+                    if (separator >= 0) {
+                        children.insert(it.key().mid(prefix.length(), separator - prefix.length()));
+                    }
+                }
+            }
+        }
+        QStringList result = children.values();
+        result.sort();
+        return result;
     }
 
     QStringList Manager::childKeys() const {
-        return resultWithReadLock<QStringList>([&] {
-            return _qSettings.childKeys();
-        });
+        QString group = getFullKey(QString());
+        QString prefix = group.isEmpty() ? group : group + "/";
+        QStringList result;
+        for (const auto& stripe : _stripes) {
+            QReadLocker locker(&stripe.lock);
+            for (auto it = stripe.values.cbegin(); it != stripe.values.cend(); ++it) {
+                if (it.key().startsWith(prefix) && it.key().indexOf('/', prefix.length()) < 0) {
+                    result.push_back(it.key().mid(prefix.length()));
+                }
+            }
+        }
+        result.sort();
+        return result;
     }
 
     QStringList Manager::allKeys() const {
-        return resultWithReadLock<QStringList>([&] {
-            return _qSettings.allKeys();
-        });
+        QString group = getFullKey(QString());
+        QString prefix = group.isEmpty() ? group : group + "/";
+        QStringList result;
+        for (const auto& stripe : _stripes) {
+            QReadLocker locker(&stripe.lock);
+            for (auto it = stripe.values.cbegin(); it != stripe.values.cend(); ++it) {
+                if (it.key().startsWith(prefix)) {
+                    result.push_back(it.key().mid(prefix.length()));
+                }
+            }
+        }
+        result.sort();
+        return result;
     }
 
     bool Manager::contains(const QString &key) const {
-        return resultWithReadLock<bool>([&] {
-            return _qSettings.contains(key);
-        });
+        QString fullKey = getFullKey(key);
+        const auto& stripe = getStripe(fullKey);
+        QReadLocker locker(&stripe.lock);
+        return stripe.values.contains(fullKey);
     }
 
     int Manager::beginReadArray(const QString &prefix) {
-        return resultWithReadLock<int>([&] {
-            return _qSettings.beginReadArray(prefix);
-        });
+        Group group;
+        group.name = normalizedKey(prefix);
+        group.isArray = true;
+        beginGroupOrArray(group);
+        return value("size").toInt();
     }
 
     void Manager::beginGroup(const QString &prefix) {
-        withWriteLock([&] {
-            _qSettings.beginGroup(prefix);
-        });
+        Group group;
+        group.name = normalizedKey(prefix);
+        beginGroupOrArray(group);
     }
 
     void Manager::beginWriteArray(const QString &prefix, int size) {
-        withWriteLock([&] {
-            _qSettings.beginWriteArray(prefix, size);
-        });
+        Group group;
+        group.name = normalizedKey(prefix);
+        group.isArray = true;
+        // without a size, the size written is one past the highest index set
+        group.sizeGuess = size < 0 ? 0 : -1;
+        beginGroupOrArray(group);
+        if (size < 0) {
+            remove("size");
+        } else {
+            setValue("size", size);
+        }
     }
 
     void Manager::endArray() {
-        withWriteLock([&] {
-            _qSettings.endArray();
+        Group group;
+        bool isArray = resultWithWriteLock<bool>([&] {
+            if (_groups.isEmpty() || !_groups.back().isArray) {
+                return false;
+            }
+            group = _groups.back();
+            _groups.pop_back();
+            updateGroupPrefix();
+            return true;
         });
+
+        if (!isArray) {
+            qWarning() << "Setting::Manager::endArray(): No matching beginReadArray() or beginWriteArray()";
+        } else if (group.sizeGuess >= 0) {
+            setValue(group.name + "/size", group.sizeGuess);
+        }
     }
 
     void Manager::endGroup() {
-        withWriteLock([&] {
-            _qSettings.endGroup();
+        bool isGroup = resultWithWriteLock<bool>([&] {
+            if (_groups.isEmpty() || _groups.back().isArray) {
+                return false;
+            }
+            _groups.pop_back();
+            updateGroupPrefix();
+            return true;
         });
+
+        if (!isGroup) {
+            qWarning() << "Setting::Manager::endGroup(): No matching beginGroup()";
+        }
     }
 
     void Manager::setArrayIndex(int i) {
         withWriteLock([&] {
-            _qSettings.setArrayIndex(i);
+            if (_groups.isEmpty() || !_groups.back().isArray) {
+                qWarning() << "Setting::Manager::setArrayIndex(): Missing beginReadArray() or beginWriteArray()";
+                return;
+            }
+            auto& group = _groups.back();
+            group.index = i;
+            if (group.sizeGuess >= 0 && i + 1 > group.sizeGuess) {
+                group.sizeGuess = i + 1;
+            }
+            updateGroupPrefix();
         });
     }
 
     void Manager::setValue(const QString &key, const QVariant &value) {
-        withWriteLock([&] {
-            _qSettings.setValue(key, value);
-        });
+        storeValue(getFullKey(key), value);
     }
 
     QVariant Manager::value(const QString &key, const QVariant &defaultValue) const {
-        return resultWithReadLock<QVariant>([&] {
-            return _qSettings.value(key, defaultValue);
-        });
+        return getStoredValue(getFullKey(key), defaultValue);
     }
 }
@@ -12,10 +12,15 @@
 #ifndef hifi_SettingManager_h
 #define hifi_SettingManager_h
 
+#include <array>
+
+#include <QtCore/QMutex>
 #include <QtCore/QPointer>
+#include <QtCore/QReadWriteLock>
 #include <QtCore/QSettings>
 #include <QtCore/QTimer>
 #include <QtCore/QUuid>
+#include <QtCore/QVector>
 
 #include "DependencyManager.h"
 #include "shared/ReadWriteLockable.h"
@@ -23,13 +28,23 @@
 namespace Setting {
     class Interface;
 
+    // The settings are kept in memory, in stripes that each have their own lock, and written to disk on the settings
+    // thread once they have stopped changing for a moment. Only the changed keys are written, each once however often
+    // it changed, and QSettings writes the file to a temporary one that is renamed over it. No lock a caller can wait on
+    // is held while the file is written, so only the write at shutdown blocks the main thread on the disk.
+    // The group and array state is shared by every thread, like that of a QSettings.
     class Manager : public QObject, public ReadWriteLockable, public Dependency {
         Q_OBJECT
 
     public:
+        Manager();
+
         void customDeleter() override;
 
-        // thread-safe proxies into QSettings
+        // reads the settings file again, for when something other than the manager has changed it
+        void reload();
+
+        // thread-safe proxies into the in memory settings, with the semantics of the QSettings calls
         QString fileName() const;
         void remove(const QString &key);
         QStringList childGroups() const;
@@ -57,20 +72,65 @@ namespace Setting {
         void startTimer();
         void stopTimer();
 
+        // writes the changes once they have settled, or have waited long enough
         void saveAll();
 
     private:
+        static const int NUM_STRIPES = 16;
+
+        struct Stripe {
+            mutable QReadWriteLock lock;
+            QHash<QString, QVariant> values;
+        };
+
+        struct Group {
+            QString name;
+            bool isArray { false };
+            // the index the array is at, -1 before setArrayIndex()
+            int index { -1 };
+            // the size to write at endArray(), counted from the indices set, or -1 for none
+            int sizeGuess { -1 };
+        };
+
+        Stripe& getStripe(const QString& key) { return _stripes[qHash(key) % NUM_STRIPES]; }
+        const Stripe& getStripe(const QString& key) const { return _stripes[qHash(key) % NUM_STRIPES]; }
+
+        QString getFullKey(const QString& key) const;
+        void beginGroupOrArray(const Group& group);
+        void updateGroupPrefix();
+
+        QVariant getStoredValue(const QString& key, const QVariant& defaultValue) const;
+        void storeValue(const QString& key, const QVariant& value);
+        void removeStoredValues(const QString& key);
+        void loadStore();
+
+        // writes the changes now, on whichever thread calls it
+        void writePendingChanges();
+
         QHash<QString, Interface*> _handles;
         QPointer<QTimer> _saveTimer = nullptr;
         const QVariant UNSET_VALUE { QUuid::createUuid() };
+
+        std::array<Stripe, NUM_STRIPES> _stripes;
+
+        // guarded by the manager's lock
+        QVector<Group> _groups;
+        QString _groupPrefix;
+
+        // the value each changed key had last, UNSET_VALUE for removed keys
+        QMutex _pendingMutex;
         QHash<QString, QVariant> _pendingChanges;
+        quint64 _firstPendingChange { 0 };
+        quint64 _lastPendingChange { 0 };
 
         friend class Interface;
         friend void cleanupSettingsSaveThread();
         friend void setupSettingsSaveThread();
 
-
+        // only used with _fileMutex held, and never while any of the locks above is held
+        QMutex _fileMutex;
         QSettings _qSettings;
+        const QString _fileName;
     };
 }
 
@@ -0,0 +1,177 @@
+//
+//  SmallVector.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SmallVector_h
+#define hifi_SmallVector_h
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+
+// A vector that keeps up to InlineCapacity elements inside itself, and only goes to the heap once it grows past that.
+// For the many small lists of a big data structure, like the entities of each octree element, it saves the heap block
+// and the pointer chasing to get to it. The inline elements share their space with the heap pointer, so a
+// SmallVector is only the size and capacity bigger than its inline elements.
+template <typename T, size_t InlineCapacity>
+class SmallVector {
+    static_assert(InlineCapacity > 0, "a SmallVector without inline elements is a std::vector");
+
+public:
+    using value_type = T;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    SmallVector() {}
+    SmallVector(const SmallVector& other) {
+        reserve(other._size);
+        for (const auto& value : other) {
+            new (data() + _size) T(value);
+            ++_size;
+        }
+    }
+    SmallVector(SmallVector&& other) { moveFrom(other); }
+    ~SmallVector() {
+        clear();
+        freeHeap();
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other._size);
+            for (const auto& value : other) {
+                new (data() + _size) T(value);
+                ++_size;
+            }
+        }
+        return *this;
+    }
+    SmallVector& operator=(SmallVector&& other) {
+        if (this != &other) {
+            clear();
+            freeHeap();
+            moveFrom(other);
+        }
+        return *this;
+    }
+
+    size_t size() const { return _size; }
+    size_t capacity() const { return _capacity; }
+    bool empty() const { return _size == 0; }
+    bool isInline() const { return _capacity <= InlineCapacity; }
+
+    T* data() { return isInline() ? reinterpret_cast<T*>(_storage.values) : _storage.heap; }
+    const T* data() const { return isInline() ? reinterpret_cast<const T*>(_storage.values) : _storage.heap; }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + _size; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + _size; }
+
+    T& operator[](size_t index) { assert(index < _size); return data()[index]; }
+    const T& operator[](size_t index) const { assert(index < _size); return data()[index]; }
+    T& back() { assert(_size > 0); return data()[_size - 1]; }
+    const T& back() const { assert(_size > 0); return data()[_size - 1]; }
+
+    void reserve(size_t capacity) {
+        if (capacity <= _capacity) {
+            return;
+        }
+        T* values = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        T* oldValues = data();
+        for (uint32_t i = 0; i < _size; ++i) {
+            new (values + i) T(std::move(oldValues[i]));
+            oldValues[i].~T();
+        }
+        freeHeap();
+        _storage.heap = values;
+        _capacity = (uint32_t)capacity;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        if (_size == _capacity) {
+            // construct first, the arguments may refer to an element that growing moves
+            T value(std::forward<Args>(args)...);
+            reserve(_capacity * 2);
+            return *new (data() + _size++) T(std::move(value));
+        }
+        return *new (data() + _size++) T(std::forward<Args>(args)...);
+    }
+
+    void pop_back() {
+        assert(_size > 0);
+        data()[--_size].~T();
+    }
+
+    iterator erase(iterator first, iterator last) {
+        iterator newEnd = std::move(last, end(), first);
+        while (end() != newEnd) {
+            pop_back();
+        }
+        return first;
+    }
+    iterator erase(iterator position) { return erase(position, position + 1); }
+
+    // removes every element equal to the value, and returns how many there were
+    size_t removeAll(const T& value) {
+        size_t oldSize = _size;
+        erase(std::remove(begin(), end(), value), end());
+        return oldSize - _size;
+    }
+
+    void clear() {
+        while (_size > 0) {
+            pop_back();
+        }
+    }
+
+private:
+    void freeHeap() {
+        if (!isInline()) {
+            ::operator delete(_storage.heap);
+            _capacity = (uint32_t)InlineCapacity;
+        }
+    }
+
+    void moveFrom(SmallVector& other) {
+        if (other.isInline()) {
+            for (auto& value : other) {
+                new (data() + _size) T(std::move(value));
+                ++_size;
+            }
+            other.clear();
+        } else {
+            _storage.heap = other._storage.heap;
+            _size = other._size;
+            _capacity = other._capacity;
+            other._size = 0;
+            other._capacity = (uint32_t)InlineCapacity;
+        }
+    }
+
+    union Storage {
+        Storage() {}
+        ~Storage() {}
+        T* heap;
+        alignas(T) unsigned char values[InlineCapacity * sizeof(T)];
+    } _storage;
+    uint32_t _size { 0 };
+    uint32_t _capacity { (uint32_t)InlineCapacity };
+};
+
+#endif // hifi_SmallVector_h
@@ -31,6 +31,7 @@ SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
     _transform.setTranslation(glm::vec3(0.0f));
     _transform.setRotation(glm::quat());
     _transform.setScale(1.0f);
+    _localTransformCopy.store(_transform);
     _scaleChanged = usecTimestampNow();
     _translationChanged = usecTimestampNow();
     _rotationChanged = usecTimestampNow();
@@ -38,6 +39,7 @@ SpatiallyNestable::SpatiallyNestable(NestableType nestableType, QUuid id) :
 
 SpatiallyNestable::~SpatiallyNestable() {
     forEachChild([&](SpatiallyNestablePointer object) {
+        object->invalidateWorldTransform();
         object->parentDeleted();
     });
 }
@@ -80,6 +82,9 @@ void SpatiallyNestable::setParentID(const QUuid& parentID) {
             _parentKnowsMe = false;
         }
     });
+    if (parentChanged) {
+        invalidateWorldTransform();
+    }
 
     if (parentChanged && success && parent) {
         parent->recalculateChildCauterization();
@@ -140,6 +145,7 @@ SpatiallyNestablePointer SpatiallyNestable::getParentPointer(bool& success) cons
         parent->forgetChild(getThisPointer());
         _parentKnowsMe = false;
         _parent.reset();
+        invalidateWorldTransform();
     }
 
     // we have a _parentID but no parent pointer, or our parent pointer was to the wrong thing
@@ -152,6 +158,7 @@ SpatiallyNestablePointer SpatiallyNestable::getParentPointer(bool& success) cons
     if (!success) {
         return nullptr;
     }
+    invalidateWorldTransform();
 
     parent = _parent.lock();
     if (parent) {
@@ -186,6 +193,7 @@ void SpatiallyNestable::forgetChild(SpatiallyNestablePointer newChild) const {
 
 void SpatiallyNestable::setParentJointIndex(quint16 parentJointIndex) {
     _parentJointIndex = parentJointIndex;
+    invalidateWorldTransform();
     bool success = false;
     auto parent = getParentPointer(success);
     if (success && parent) {
@@ -500,7 +508,7 @@ void SpatiallyNestable::setWorldTransform(const glm::vec3& position, const glm::
     Transform parentTransform = getParentTransform(success);
     if (success) {
         bool changed = false;
-        _transformLock.withWriteLock([&] {
+        writeLocalTransform([&] {
             Transform myWorldTransform;
             Transform::mult(myWorldTransform, parentTransform, _transform);
             if (myWorldTransform.getRotation() != orientation) {
@@ -551,7 +559,7 @@ void SpatiallyNestable::setWorldPosition(const glm::vec3& position, bool& succes
     bool changed = false;
     Transform parentTransform = getParentTransform(success);
     Transform myWorldTransform;
-    _transformLock.withWriteLock([&] {
+    writeLocalTransform([&] {
         Transform::mult(myWorldTransform, parentTransform, _transform);
         if (myWorldTransform.getTranslation() != position) {
             changed = true;
@@ -604,7 +612,7 @@ void SpatiallyNestable::setWorldOrientation(const glm::quat& orientation, bool&
     bool changed = false;
     Transform parentTransform = getParentTransform(success);
     Transform myWorldTransform;
-    _transformLock.withWriteLock([&] {
+    writeLocalTransform([&] {
         Transform::mult(myWorldTransform, parentTransform, _transform);
         if (myWorldTransform.getRotation() != orientation) {
             changed = true;
@@ -747,12 +755,21 @@ glm::vec3 SpatiallyNestable::getParentAngularVelocity(bool& success) const {
 }
 
 const Transform SpatiallyNestable::getTransform(bool& success, int depth) const {
-    Transform result;
+    // the cached world transform is good until this object or one of its ancestors moves
+    uint32_t version = _worldTransformVersion.load();
+    uint32_t cachedVersion;
+    Transform result = _worldTransformCache.load(cachedVersion);
+    if (cachedVersion == version) {
+        success = true;
+        return result;
+    }
+
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
-    _transformLock.withReadLock([&] {
-        Transform::mult(result, parentTransform, _transform);
-    });
+    Transform::mult(result, parentTransform, _localTransformCopy.load());
+    if (success && isWorldTransformCacheable()) {
+        _worldTransformCache.tryStore(result, version);
+    }
     return result;
 }
 
@@ -760,10 +777,9 @@ const Transform SpatiallyNestable::getTransformWithOnlyLocalRotation(bool& succe
     Transform result;
     // return a world-space transform for this object's location
     Transform parentTransform = getParentTransform(success, depth);
-    _transformLock.withReadLock([&] {
-        Transform::mult(result, parentTransform, _transform);
-        result.setRotation(_transform.getRotation());
-    });
+    Transform localTransform = _localTransformCopy.load();
+    Transform::mult(result, parentTransform, localTransform);
+    result.setRotation(localTransform.getRotation());
     return result;
 }
 
@@ -780,6 +796,30 @@ const Transform SpatiallyNestable::getTransform() const {
     return result;
 }
 
+bool SpatiallyNestable::hasCachedWorldTransform() const {
+    uint32_t cachedVersion;
+    _worldTransformCache.load(cachedVersion);
+    return cachedVersion == _worldTransformVersion.load();
+}
+
+bool SpatiallyNestable::isWorldTransformCacheable() const {
+    SpatiallyNestablePointer parent = _parent.lock();
+    if (!parent) {
+        return getParentID().isNull();
+    }
+    // Joints and avatars move without telling their children, and a parent only tells the children it knows about.
+    // A parent with no cached transform of its own may be one of those, or have an ancestor that is.
+    return _parentKnowsMe && _parentJointIndex == INVALID_JOINT_INDEX && parent->getNestableType() == NestableType::Entity &&
+        !getScalesWithParent() && parent->hasCachedWorldTransform();
+}
+
+void SpatiallyNestable::invalidateWorldTransform() const {
+    _worldTransformVersion++;
+    forEachChild([&](const SpatiallyNestablePointer& child) {
+        child->invalidateWorldTransform();
+    });
+}
+
 void SpatiallyNestable::breakParentingLoop() const {
     // someone created a loop.  break it...
     qCDebug(shared) << "Parenting loop detected: " << getID();
@@ -823,7 +863,7 @@ void SpatiallyNestable::setTransform(const Transform& transform, bool& success)
     Transform parentTransform = getParentTransform(success);
     if (success) {
         bool changed = false;
-        _transformLock.withWriteLock([&] {
+        writeLocalTransform([&] {
             Transform beforeTransform = _transform;
             Transform::inverseMult(_transform, parentTransform, transform);
             if (_transform != beforeTransform) {
@@ -878,7 +918,7 @@ void SpatiallyNestable::setSNScale(const glm::vec3& scale, bool& success) {
     bool changed = false;
     Transform parentTransform = getParentTransform(success);
     Transform myWorldTransform;
-    _transformLock.withWriteLock([&] {
+    writeLocalTransform([&] {
         Transform::mult(myWorldTransform, parentTransform, _transform);
         if (myWorldTransform.getScale() != scale) {
             changed = true;
@@ -893,11 +933,7 @@ void SpatiallyNestable::setSNScale(const glm::vec3& scale, bool& success) {
 }
 
 Transform SpatiallyNestable::getLocalTransform() const {
-    Transform result;
-    _transformLock.withReadLock([&] {
-        result =_transform;
-    });
-    return result;
+    return _localTransformCopy.load();
 }
 
 void SpatiallyNestable::setLocalTransform(const Transform& transform) {
@@ -908,7 +944,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
     }
 
     bool changed = false;
-    _transformLock.withWriteLock([&] {
+    writeLocalTransform([&] {
         if (_transform != transform) {
             _transform = transform;
             changed = true;
@@ -924,11 +960,7 @@ void SpatiallyNestable::setLocalTransform(const Transform& transform) {
 }
 
 glm::vec3 SpatiallyNestable::getLocalPosition() const {
-    glm::vec3 result;
-    _transformLock.withReadLock([&] {
-        result = _transform.getTranslation();
-    });
-    return result;
+    return _localTransformCopy.loadTranslation();
 }
 
 void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhysics) {
@@ -938,7 +970,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
         return;
     }
     bool changed = false;
-    _transformLock.withWriteLock([&] {
+    writeLocalTransform([&] {
         if (_transform.getTranslation() != position) {
             _transform.setTranslation(position);
             changed = true;
@@ -951,11 +983,7 @@ void SpatiallyNestable::setLocalPosition(const glm::vec3& position, bool tellPhy
 }
 
 glm::quat SpatiallyNestable::getLocalOrientation() const {
-    glm::quat result;
-    _transformLock.withReadLock([&] {
-        result = _transform.getRotation();
-    });
-    return result;
+    return _localTransformCopy.loadRotation();
 }
 
 void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
@@ -965,7 +993,7 @@ void SpatiallyNestable::setLocalOrientation(const glm::quat& orientation) {
         return;
     }
     bool changed = false;
-    _transformLock.withWriteLock([&] {
+    writeLocalTransform([&] {
         if (_transform.getRotation() != orientation) {
             _transform.setRotation(orientation);
             changed = true;
@@ -1006,11 +1034,7 @@ void SpatiallyNestable::setLocalAngularVelocity(const glm::vec3& angularVelocity
 }
 
 glm::vec3 SpatiallyNestable::getLocalSNScale() const {
-    glm::vec3 result;
-    _transformLock.withReadLock([&] {
-        result = _transform.getScale();
-    });
-    return result;
+    return _localTransformCopy.loadScale();
 }
 
 void SpatiallyNestable::setLocalSNScale(const glm::vec3& scale) {
@@ -1021,7 +1045,7 @@ void SpatiallyNestable::setLocalSNScale(const glm::vec3& scale) {
     }
 
     bool changed = false;
-    _transformLock.withWriteLock([&] {
+    writeLocalTransform([&] {
         if (_transform.getScale() != scale) {
             _transform.setScale(scale);
             changed = true;
@@ -1353,9 +1377,7 @@ void SpatiallyNestable::getLocalTransformAndVelocities(
         glm::vec3& velocity,
         glm::vec3& angularVelocity) const {
     // transform
-    _transformLock.withReadLock([&] {
-        transform = _transform;
-    });
+    transform = _localTransformCopy.load();
     // linear velocity
     _velocityLock.withReadLock([&] {
         velocity = _velocity;
@@ -1374,7 +1396,7 @@ void SpatiallyNestable::setLocalTransformAndVelocities(
     bool changed = false;
 
     // transform
-    _transformLock.withWriteLock([&] {
+    writeLocalTransform([&] {
         if (_transform != localTransform) {
             _transform = localTransform;
             changed = true;
@@ -18,6 +18,7 @@
 #include "AACube.h"
 #include "SpatialParentFinder.h"
 #include "shared/ReadWriteLockable.h"
+#include "shared/SeqLockedTransform.h"
 #include "Grab.h"
 
 class SpatiallyNestable;
@@ -261,6 +262,12 @@ private:
     mutable ReadWriteLockable _velocityLock;
     mutable ReadWriteLockable _angularVelocityLock;
     Transform _transform; // this is to be combined with parent's world-transform to produce this' world-transform.
+    // Readers use copies of _transform and of the world transform, and never take _transformLock.  The world transform
+    // is cached when it only depends on transforms that tell their children when they change, and the cached copy is
+    // good while it is tagged with the current _worldTransformVersion.
+    SeqLockedTransform _localTransformCopy;
+    mutable SeqLockedTransform _worldTransformCache;
+    mutable std::atomic<uint32_t> _worldTransformVersion { 1 };
     glm::vec3 _velocity;
     glm::vec3 _angularVelocity;
     mutable bool _parentKnowsMe { false };
@@ -268,6 +275,27 @@ private:
     bool _queryAACubeIsPuffed { false };
 
     void breakParentingLoop() const;
+
+    // changes _transform under its lock, then passes it on to readers and to the cached world transforms
+    template <typename F>
+    void writeLocalTransform(F&& modify) {
+        bool changed = false;
+        _transformLock.withWriteLock([&] {
+            Transform before = _transform;
+            modify();
+            if (_transform != before) {
+                _localTransformCopy.store(_transform);
+                changed = true;
+            }
+        });
+        if (changed) {
+            invalidateWorldTransform();
+        }
+    }
+    bool hasCachedWorldTransform() const;
+    bool isWorldTransformCacheable() const;
+    // this object or an ancestor moved, or this object changed parents
+    void invalidateWorldTransform() const;
 };
 
 
@@ -0,0 +1,131 @@
+//
+//  TimerWheel.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheel.h"
+
+#include <algorithm>
+
+void TimerWheel::schedule(TimerID id, uint64_t expiry) {
+    expiry = std::max(expiry, _currentTick + 1);
+    _expiries[id] = expiry;
+    place({ id, expiry });
+}
+
+void TimerWheel::cancel(TimerID id) {
+    _expiries.erase(id);
+}
+
+void TimerWheel::place(const Entry& entry) {
+    uint64_t delta = entry.expiry - _currentTick;
+
+    int level = 0;
+    while (level < NUM_LEVELS - 1 && delta >= (uint64_t)1 << (SLOT_BITS * (level + 1))) {
+        ++level;
+    }
+
+    uint64_t slot;
+    if (delta >= (uint64_t)1 << (SLOT_BITS * NUM_LEVELS)) {
+        // past the end of the wheel, waits in the furthest slot and is placed again when that comes round
+        slot = ((_currentTick >> (SLOT_BITS * level)) + SLOT_MASK) & SLOT_MASK;
+    } else {
+        slot = (entry.expiry >> (SLOT_BITS * level)) & SLOT_MASK;
+    }
+
+    _levels[level][slot].push_back(entry);
+    ++_levelSizes[level];
+}
+
+void TimerWheel::cascade(int level) {
+    auto& slot = _levels[level][(_currentTick >> (SLOT_BITS * level)) & SLOT_MASK];
+    Slot entries;
+    entries.swap(slot);
+    _levelSizes[level] -= entries.size();
+
+    for (const auto& entry : entries) {
+        auto it = _expiries.find(entry.id);
+        if (it != _expiries.end() && it->second == entry.expiry) {
+            place(entry);
+        }
+    }
+}
+
+void TimerWheel::advance(uint64_t now, std::vector<TimerID>& expired) {
+    while (_currentTick < now) {
+        if (_expiries.empty()) {
+            _currentTick = now;
+            break;
+        }
+
+        // nothing happens before the lowest level with timers in it next turns over, so go straight there
+        int numEmptyLevels = 0;
+        while (numEmptyLevels < NUM_LEVELS - 1 && _levelSizes[numEmptyLevels] == 0) {
+            ++numEmptyLevels;
+        }
+        if (numEmptyLevels > 0) {
+            uint64_t beforeTurn = _currentTick | (((uint64_t)1 << (SLOT_BITS * numEmptyLevels)) - 1);
+            if (beforeTurn > _currentTick) {
+                _currentTick = std::min(beforeTurn, now);
+                continue;
+            }
+        }
+
+        ++_currentTick;
+
+        // bring the timers in the next slot of each level that turned over down to the levels below
+        int turnedLevels = 0;
+        while (turnedLevels < NUM_LEVELS - 1 && ((_currentTick >> (SLOT_BITS * turnedLevels)) & SLOT_MASK) == 0) {
+            ++turnedLevels;
+        }
+        for (int level = turnedLevels; level > 0; --level) {
+            cascade(level);
+        }
+
+        auto& slot = _levels[0][_currentTick & SLOT_MASK];
+        Slot entries;
+        entries.swap(slot);
+        _levelSizes[0] -= entries.size();
+
+        for (const auto& entry : entries) {
+            auto it = _expiries.find(entry.id);
+            if (it != _expiries.end() && it->second == entry.expiry) {
+                _expiries.erase(it);
+                expired.push_back(entry.id);
+            }
+        }
+    }
+}
+
+uint64_t TimerWheel::getNextExpiry() const {
+    if (_expiries.empty()) {
+        return NO_EXPIRY;
+    }
+
+    uint64_t nextExpiry = NO_EXPIRY;
+
+    // the timers in the higher levels can't expire before the lowest of them next turns over and brings them down
+    for (int level = 1; level < NUM_LEVELS; ++level) {
+        if (_levelSizes[level] > 0) {
+            uint64_t width = (uint64_t)1 << (SLOT_BITS * level);
+            nextExpiry = (_currentTick | (width - 1)) + 1;
+            break;
+        }
+    }
+
+    // every timer in the first level expires on the tick of its slot
+    if (_levelSizes[0] > 0) {
+        for (uint64_t tick = _currentTick + 1; tick <= _currentTick + NUM_SLOTS && tick < nextExpiry; ++tick) {
+            if (!_levels[0][tick & SLOT_MASK].empty()) {
+                return tick;
+            }
+        }
+    }
+    return nextExpiry;
+}
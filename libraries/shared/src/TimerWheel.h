@@ -0,0 +1,72 @@
+//
+//  TimerWheel.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_TimerWheel_h
+#define hifi_TimerWheel_h
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+// Keeps any number of timers in a hierarchical timing wheel in the manner of the Linux kernel's: four levels of 64 slots
+// of 1, 64, 4096 and 262144 ticks, so scheduling and cancelling are constant time and advancing only looks at the slots
+// whose time has come. Timers further out than the wheel reaches wait in its last slot and are placed again when it comes
+// round. The owner picks what a tick is and drives the wheel from its own loop.
+class TimerWheel {
+public:
+    using TimerID = uint32_t;
+
+    static const uint64_t NO_EXPIRY = std::numeric_limits<uint64_t>::max();
+
+    TimerWheel(uint64_t now = 0) : _currentTick(now) {}
+
+    // (re)schedules the timer to expire at the tick, a tick that has already passed expires on the next advance
+    void schedule(TimerID id, uint64_t expiry);
+    void cancel(TimerID id);
+
+    // appends the timers that expired up to and including the tick to expired, in the order they expired
+    void advance(uint64_t now, std::vector<TimerID>& expired);
+
+    // a tick at or before the next expiry, NO_EXPIRY if there are no timers
+    uint64_t getNextExpiry() const;
+
+    size_t size() const { return _expiries.size(); }
+    bool isEmpty() const { return _expiries.empty(); }
+    uint64_t getCurrentTick() const { return _currentTick; }
+
+private:
+    static const int SLOT_BITS = 6;
+    static const int NUM_SLOTS = 1 << SLOT_BITS;
+    static const uint64_t SLOT_MASK = NUM_SLOTS - 1;
+    static const int NUM_LEVELS = 4;
+
+    struct Entry {
+        TimerID id;
+        uint64_t expiry;
+    };
+    using Slot = std::vector<Entry>;
+
+    void place(const Entry& entry);
+    void cascade(int level);
+
+    // cancelled and rescheduled timers are left in their slots and skipped when they come up, this is the truth
+    std::unordered_map<TimerID, uint64_t> _expiries;
+    std::array<std::array<Slot, NUM_SLOTS>, NUM_LEVELS> _levels;
+    std::array<size_t, NUM_LEVELS> _levelSizes {};
+    uint64_t _currentTick;
+};
+
+#endif // hifi_TimerWheel_h
@@ -8,7 +8,10 @@
 
 #include "Trace.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <unordered_map>
 
 #include <QtCore/QDebug>
 #include <QtCore/QCoreApplication>
@@ -36,28 +39,384 @@
 
 using namespace tracing;
 
+// The binary trace is a header, then records of a tag and its payload, all in the host's byte order:
+//     header: "HFTR", uint32 version, int64 process id
+//     NameRecord: uint32 id, uint32 size, UTF-8 name
+//     CategoryRecord: uint16 id, uint32 size, UTF-8 name
+//     ThreadRecord: int64 thread id, which the EventsRecords after it are from
+//     EventsRecord: uint32 count, count RingEvents
+//     JsonRecord: uint32 size, an event with arguments as Chrome trace JSON
+static const char BINARY_TRACE_MAGIC[] = { 'H', 'F', 'T', 'R' };
+static const uint32_t BINARY_TRACE_VERSION = 1;
+
+enum RecordTag : uint8_t {
+    NameRecord = 1,
+    CategoryRecord,
+    ThreadRecord,
+    EventsRecord,
+    JsonRecord
+};
+
+// the pointers interned by a thread are forgotten past this many, in case a thread traces names it builds
+static const size_t MAX_THREAD_NAME_POINTERS = 1024;
+
+static_assert(sizeof(RingEvent) == 16, "RingEvents are written to binary traces as they are");
+
+std::atomic<bool> Tracer::_active { false };
+
+namespace tracing {
+
+// The events of one thread, which only it pushes to and only the flusher drains.
+class EventRing {
+public:
+    EventRing() : threadID(int64_t(QThread::currentThreadId())) {}
+
+    void push(const RingEvent& event) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        if (head - _tail.load(std::memory_order_acquire) >= Tracer::RING_SIZE) {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        _events[head & RING_MASK] = event;
+        _head.store(head + 1, std::memory_order_release);
+    }
+
+    void drain(std::vector<RingEvent>& events) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        uint32_t head = _head.load(std::memory_order_acquire);
+        for (; tail != head; ++tail) {
+            events.push_back(_events[tail & RING_MASK]);
+        }
+        _tail.store(tail, std::memory_order_release);
+    }
+
+    bool isEmpty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_relaxed); }
+
+    const int64_t threadID;
+    std::atomic<uint32_t> dropped { 0 };
+
+private:
+    static const uint32_t RING_MASK = Tracer::RING_SIZE - 1;
+    static_assert((Tracer::RING_SIZE & RING_MASK) == 0, "the ring size must be a power of two");
+
+    std::atomic<uint32_t> _head { 0 };
+    std::atomic<uint32_t> _tail { 0 };
+    RingEvent _events[Tracer::RING_SIZE];
+};
+
+}
+
+namespace {
+
+// Never destroyed, as threads can record while the process exits
+struct Interned {
+    std::mutex mutex;
+    QHash<QString, uint32_t> nameIDs;
+    std::vector<QByteArray> names { QByteArray() };
+    QHash<QString, uint16_t> categoryIDs;
+    std::vector<QByteArray> categories { QByteArray() };
+
+    std::mutex ringsMutex;
+    std::vector<std::shared_ptr<EventRing>> rings;
+};
+
+Interned& interned() {
+    static Interned* interned = new Interned();
+    return *interned;
+}
+
+struct InternedPointer {
+    QByteArray name;
+    uint32_t id;
+};
+
+thread_local std::unordered_map<const char*, InternedPointer> threadNamePointers;
+thread_local QHash<QString, uint32_t> threadNames;
+thread_local std::unordered_map<const QLoggingCategory*, uint16_t> threadCategories;
+thread_local std::shared_ptr<EventRing> threadRing;
+
+template <typename T>
+void appendValue(QByteArray& records, const T& value) {
+    records.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+void appendRecord(QByteArray& records, RecordTag tag, const QByteArray& data) {
+    appendValue(records, tag);
+    appendValue(records, (uint32_t)data.size());
+    records.append(data);
+}
+
+template <typename T>
+bool readValue(const QByteArray& records, int& offset, T& value) {
+    if (offset + (int)sizeof(T) > records.size()) {
+        return false;
+    }
+    memcpy(&value, records.constData() + offset, sizeof(T));
+    offset += sizeof(T);
+    return true;
+}
+
+bool readBytes(const QByteArray& records, int& offset, QByteArray& bytes) {
+    uint32_t size;
+    if (!readValue(records, offset, size) || offset + (qint64)size > records.size()) {
+        return false;
+    }
+    bytes = records.mid(offset, size);
+    offset += size;
+    return true;
+}
+
+}
+
 bool tracing::enabled() {
     return DependencyManager::get<Tracer>()->isEnabled();
 }
 
-void Tracer::startTracing() {
+Tracer::Tracer() {
+}
+
+Tracer::~Tracer() {
+    if (_enabled) {
+        stopTracing();
+    }
+}
+
+uint32_t Tracer::internName(const char* name) {
+    auto itr = threadNamePointers.find(name);
+    if (itr != threadNamePointers.end() && strcmp(itr->second.name.constData(), name) == 0) {
+        return itr->second.id;
+    }
+
+    if (threadNamePointers.size() >= MAX_THREAD_NAME_POINTERS) {
+        threadNamePointers.clear();
+    }
+    uint32_t id = internName(QString::fromUtf8(name));
+    threadNamePointers[name] = { QByteArray(name), id };
+    return id;
+}
+
+uint32_t Tracer::internName(const QString& name) {
+    auto itr = threadNames.find(name);
+    if (itr != threadNames.end()) {
+        return itr.value();
+    }
+
+    auto& table = interned();
+    uint32_t id;
+    {
+        std::lock_guard<std::mutex> guard(table.mutex);
+        auto nameItr = table.nameIDs.find(name);
+        if (nameItr != table.nameIDs.end()) {
+            id = nameItr.value();
+        } else {
+            id = (uint32_t)table.names.size();
+            table.names.push_back(name.toUtf8());
+            table.nameIDs.insert(name, id);
+        }
+    }
+    threadNames.insert(name, id);
+    return id;
+}
+
+uint16_t Tracer::internCategory(const QLoggingCategory& category) {
+    auto itr = threadCategories.find(&category);
+    if (itr != threadCategories.end()) {
+        return itr->second;
+    }
+
+    auto& table = interned();
+    QString name = category.categoryName();
+    uint16_t id;
+    {
+        std::lock_guard<std::mutex> guard(table.mutex);
+        auto categoryItr = table.categoryIDs.find(name);
+        if (categoryItr != table.categoryIDs.end()) {
+            id = categoryItr.value();
+        } else {
+            id = (uint16_t)table.categories.size();
+            table.categories.push_back(name.toUtf8());
+            table.categoryIDs.insert(name, id);
+        }
+    }
+    threadCategories[&category] = id;
+    return id;
+}
+
+void Tracer::recordEvent(uint16_t categoryID, uint32_t nameID, EventType type, int64_t timestamp) {
+    if (!isActive()) {
+        return;
+    }
+    if (!threadRing) {
+        threadRing = std::make_shared<EventRing>();
+        auto& table = interned();
+        std::lock_guard<std::mutex> guard(table.ringsMutex);
+        table.rings.push_back(threadRing);
+    }
+    threadRing->push({ timestamp, nameID, categoryID, type });
+}
+
+void Tracer::startTracing(const QString& binaryFile) {
     std::lock_guard<std::mutex> guard(_eventsMutex);
     if (_enabled) {
         qWarning() << "Tried to enable tracer, but already enabled";
         return;
     }
 
-    _events.clear();
+    {
+        std::lock_guard<std::mutex> flushGuard(_flushMutex);
+
+        // drop whatever was recorded as the last trace stopped
+        {
+            auto& table = interned();
+            std::lock_guard<std::mutex> ringsGuard(table.ringsMutex);
+            for (auto& ring : table.rings) {
+                ring->drain(_drained);
+            }
+            _drained.clear();
+        }
+        _trace.clear();
+        _pendingRecords.clear();
+        _numNamesWritten = 0;
+        _numCategoriesWritten = 0;
+
+        _streaming = !binaryFile.isEmpty();
+        if (_streaming) {
+            _file.setFileName(binaryFile);
+            if (!_file.open(QIODevice::WriteOnly)) {
+                qCWarning(shared) << "Failed to open trace file" << binaryFile;
+                _streaming = false;
+                return;
+            }
+
+            QByteArray header(BINARY_TRACE_MAGIC, sizeof(BINARY_TRACE_MAGIC));
+            appendValue(header, BINARY_TRACE_VERSION);
+            appendValue(header, (int64_t)QCoreApplication::applicationPid());
+            for (auto& event : _metadataEvents) {
+                QByteArray json;
+                {
+                    QTextStream out(&json);
+                    event.writeJson(out);
+                }
+                appendRecord(header, JsonRecord, json);
+            }
+            writeRecords(header);
+        }
+    }
+
     _enabled = true;
+    _active.store(true, std::memory_order_relaxed);
+
+    _stopFlusher = false;
+    _flusher = std::thread([this] { runFlusher(); });
 }
 
 void Tracer::stopTracing() {
-    std::lock_guard<std::mutex> guard(_eventsMutex);
-    if (!_enabled) {
-        qWarning() << "Cannot stop tracing, already disabled";
+    {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        if (!_enabled) {
+            qWarning() << "Cannot stop tracing, already disabled";
+            return;
+        }
+        _enabled = false;
+        _active.store(false, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(_flusherMutex);
+        _stopFlusher = true;
+    }
+    _flusherCondition.notify_one();
+    if (_flusher.joinable()) {
+        _flusher.join();
+    }
+
+    std::lock_guard<std::mutex> flushGuard(_flushMutex);
+    flush();
+    if (_file.isOpen()) {
+        _file.close();
+    }
+}
+
+void Tracer::runFlusher() {
+    std::unique_lock<std::mutex> lock(_flusherMutex);
+    while (!_flusherCondition.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MSECS), [this] { return _stopFlusher; })) {
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> guard(_flushMutex);
+            flush();
+        }
+        lock.lock();
+    }
+}
+
+void Tracer::flush() {
+    auto& table = interned();
+
+    QByteArray events;
+    std::vector<std::shared_ptr<EventRing>> rings;
+    {
+        std::lock_guard<std::mutex> guard(table.ringsMutex);
+        rings = table.rings;
+    }
+    for (auto& ring : rings) {
+        _drained.clear();
+        ring->drain(_drained);
+        if (!_drained.empty()) {
+            appendValue(events, ThreadRecord);
+            appendValue(events, ring->threadID);
+            appendValue(events, EventsRecord);
+            appendValue(events, (uint32_t)_drained.size());
+            events.append(reinterpret_cast<const char*>(_drained.data()), (int)(_drained.size() * sizeof(RingEvent)));
+        }
+        auto dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            qCWarning(shared) << "Tracing dropped" << dropped << "events of thread" << ring->threadID;
+        }
+    }
+    {
+        // forget the rings of threads that have finished and been drained
+        std::lock_guard<std::mutex> guard(table.ringsMutex);
+        table.rings.erase(std::remove_if(table.rings.begin(), table.rings.end(), [](const std::shared_ptr<EventRing>& ring) {
+            return ring.use_count() == 1 && ring->isEmpty();
+        }), table.rings.end());
+    }
+
+    // the names come after draining, so they include every name the drained events were recorded with
+    QByteArray records;
+    {
+        std::lock_guard<std::mutex> guard(table.mutex);
+        for (; _numNamesWritten < table.names.size(); ++_numNamesWritten) {
+            appendValue(records, NameRecord);
+            appendValue(records, _numNamesWritten);
+            appendValue(records, (uint32_t)table.names[_numNamesWritten].size());
+            records.append(table.names[_numNamesWritten]);
+        }
+        for (; _numCategoriesWritten < table.categories.size(); ++_numCategoriesWritten) {
+            appendValue(records, CategoryRecord);
+            appendValue(records, (uint16_t)_numCategoriesWritten);
+            appendValue(records, (uint32_t)table.categories[_numCategoriesWritten].size());
+            records.append(table.categories[_numCategoriesWritten]);
+        }
+    }
+    records.append(events);
+    {
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        records.append(_pendingRecords);
+        _pendingRecords.clear();
+    }
+    writeRecords(records);
+}
+
+void Tracer::writeRecords(const QByteArray& records) {
+    if (records.isEmpty()) {
         return;
     }
-    _enabled = false;
+    if (_file.isOpen()) {
+        _file.write(records);
+        _file.flush();
+    } else {
+        _trace.append(records);
+    }
 }
 
 void TraceEvent::writeJson(QTextStream& out) const {
@@ -112,32 +471,23 @@ void Tracer::serialize(const QString& filename) {
         return;
     }
 
-    std::list<TraceEvent> currentEvents;
+    QByteArray records;
     {
-        std::lock_guard<std::mutex> guard(_eventsMutex);
-        currentEvents.swap(_events);
-        for (auto& event : _metadataEvents) {
-            currentEvents.push_back(event);
-        }
+        std::lock_guard<std::mutex> guard(_flushMutex);
+        flush();
+        records.swap(_trace);
+        // the next trace starts over, so it has all the names
+        _numNamesWritten = 0;
+        _numCategoriesWritten = 0;
     }
-
-    // If we can't open a temp file for writing, fail early
-    QByteArray data;
+    std::list<TraceEvent> metadataEvents;
     {
-        QTextStream out(&data);
-        out << "[\n";
-        bool first = true;
-        for (const auto& event : currentEvents) {
-            if (first) {
-                first = false;
-            } else {
-                out << ",\n";
-            }
-            event.writeJson(out);
-        }
-        out << "\n]";
+        std::lock_guard<std::mutex> guard(_eventsMutex);
+        metadataEvents = _metadataEvents;
     }
 
+    QByteArray data = toJson(records, QCoreApplication::applicationPid(), metadataEvents);
+
     if (fullPath.endsWith(".gz")) {
         QByteArray compressed;
         gzip(data, compressed);
@@ -176,6 +526,118 @@ void Tracer::serialize(const QString& filename) {
 #endif
 }
 
+QByteArray Tracer::toJson(const QByteArray& records, qint64 processID, const std::list<TraceEvent>& metadataEvents) {
+    QByteArray data;
+    QTextStream out(&data);
+    out << "[\n";
+    bool first = true;
+    auto separate = [&] {
+        if (first) {
+            first = false;
+        } else {
+            out << ",\n";
+        }
+    };
+
+    QHash<uint32_t, QString> names;
+    QHash<uint16_t, QString> categories;
+    int64_t threadID = 0;
+    int offset = 0;
+    RecordTag tag;
+    // a trace still being written can end part way through a record, and is read up to it
+    while (readValue(records, offset, tag)) {
+        if (tag == NameRecord) {
+            uint32_t id;
+            QByteArray name;
+            if (!readValue(records, offset, id) || !readBytes(records, offset, name)) {
+                break;
+            }
+            names[id] = QString::fromUtf8(name);
+        } else if (tag == CategoryRecord) {
+            uint16_t id;
+            QByteArray name;
+            if (!readValue(records, offset, id) || !readBytes(records, offset, name)) {
+                break;
+            }
+            categories[id] = QString::fromUtf8(name);
+        } else if (tag == ThreadRecord) {
+            if (!readValue(records, offset, threadID)) {
+                break;
+            }
+        } else if (tag == EventsRecord) {
+            uint32_t count;
+            if (!readValue(records, offset, count) || offset + (qint64)count * sizeof(RingEvent) > records.size()) {
+                break;
+            }
+            for (uint32_t i = 0; i < count; ++i) {
+                RingEvent event;
+                readValue(records, offset, event);
+                separate();
+                QJsonObject ev {
+                    { "name", names.value(event.nameID) },
+                    { "cat", categories.value(event.categoryID) },
+                    { "ph", QString(event.type) },
+                    { "ts", event.timestamp },
+                    { "pid", processID },
+                    { "tid", threadID }
+                };
+                out << QJsonDocument(ev).toJson(QJsonDocument::Compact);
+            }
+        } else if (tag == JsonRecord) {
+            QByteArray json;
+            if (!readBytes(records, offset, json)) {
+                break;
+            }
+            separate();
+            out << json;
+        } else {
+            qCWarning(shared) << "Unknown record in trace at" << offset;
+            break;
+        }
+    }
+
+    for (const auto& event : metadataEvents) {
+        separate();
+        event.writeJson(out);
+    }
+    out << "\n]";
+    out.flush();
+    return data;
+}
+
+bool Tracer::binaryTraceToJson(const QString& binaryFile, const QString& jsonFile) {
+    QFile input(binaryFile);
+    if (!input.open(QIODevice::ReadOnly)) {
+        qCWarning(shared) << "Failed to open trace file" << binaryFile;
+        return false;
+    }
+    QByteArray trace = input.readAll();
+    input.close();
+
+    int offset = sizeof(BINARY_TRACE_MAGIC);
+    uint32_t version;
+    int64_t processID;
+    if (!trace.startsWith(QByteArray(BINARY_TRACE_MAGIC, sizeof(BINARY_TRACE_MAGIC))) ||
+        !readValue(trace, offset, version) || version != BINARY_TRACE_VERSION || !readValue(trace, offset, processID)) {
+        qCWarning(shared) << binaryFile << "is not a binary trace this version can read";
+        return false;
+    }
+
+    QByteArray data = toJson(trace.mid(offset), processID, std::list<TraceEvent>());
+    if (jsonFile.endsWith(".gz")) {
+        QByteArray compressed;
+        gzip(data, compressed);
+        data = compressed;
+    }
+
+    QFile output(jsonFile);
+    if (!output.open(QIODevice::WriteOnly)) {
+        qCWarning(shared) << "Failed to open" << jsonFile;
+        return false;
+    }
+    return output.write(data) == data.size();
+}
+
 int64_t Tracer::now() {
     return std::chrono::duration_cast<std::chrono::microseconds>(p_high_resolution_clock::now().time_since_epoch()).count();
 }
@@ -196,31 +658,31 @@ void Tracer::traceEvent(const QLoggingCategory& category,
         return;
     }
 
+    TraceEvent event {
+        id,
+        name,
+        type,
+        timestamp,
+        processID,
+        threadID,
+        category,
+        args,
+        extra
+    };
     if (type == Metadata) {
-        _metadataEvents.push_back({
-            id,
-            name,
-            type,
-            timestamp,
-            processID,
-            threadID,
-            category,
-            args,
-            extra
-        });
-    } else {
-        _events.push_back({
-            id,
-            name,
-            type,
-            timestamp,
-            processID,
-            threadID,
-            category,
-            args,
-            extra
-        });
+        _metadataEvents.push_back(event);
+        // a streamed trace gets metadata as it comes, one kept in memory gets it all in serialize()
+        if (!_enabled || !_streaming) {
+            return;
+        }
+    }
+
+    QByteArray json;
+    {
+        QTextStream out(&json);
+        event.writeJson(out);
     }
+    appendRecord(_pendingRecords, JsonRecord, json);
 }
 
 void Tracer::traceEvent(const QLoggingCategory& category, 
@@ -240,6 +702,11 @@ void Tracer::traceEvent(const QLoggingCategory& category,
         return;
     }
 
+    if (type != Metadata && id.isEmpty() && args.isEmpty() && extra.isEmpty()) {
+        recordEvent(internCategory(category), internName(name), type, timestamp);
+        return;
+    }
+
     auto processID = QCoreApplication::applicationPid();
     auto threadID = int64_t(QThread::currentThreadId());
     traceEvent(category, name, type, timestamp, processID, threadID, id, args, extra);
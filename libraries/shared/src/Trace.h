@@ -10,9 +10,16 @@
 #ifndef hifi_Trace_h
 #define hifi_Trace_h
 
+#include <atomic>
+#include <condition_variable>
 #include <cstdint>
+#include <list>
+#include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
+#include <QtCore/QFile>
 #include <QtCore/QString>
 #include <QtCore/QVariantMap>
 #include <QtCore/QHash>
@@ -76,9 +83,48 @@ struct TraceEvent {
     void writeJson(QTextStream& out) const;
 };
 
+// An event with no id or arguments, as most are: what the per-thread rings hold and the binary trace stores.
+// The name and the category are interned, see Tracer::internName.
+struct RingEvent {
+    int64_t timestamp;
+    uint32_t nameID;
+    uint16_t categoryID;
+    EventType type;
+    uint8_t padding { 0 };
+};
+
+class EventRing;
+
+// Events with no id or arguments are recorded without a lock, in a ring of fixed size for each thread, and a background
+// thread flushes the rings every FLUSH_INTERVAL_MSECS. A thread that records faster than that drops the events that
+// don't fit, and the count of them is reported. Events with arguments, and metadata, still take the mutex.
+//
+// startTracing() keeps the flushed events in memory for serialize() to write as Chrome trace JSON.
+// startTracing(binaryFile) streams them to the file in a compact binary format instead, which is what servers that trace
+// all the time use; binaryTraceToJson() converts such a file.
 class Tracer : public Dependency {
 public:
+    // chosen so a ring holds a flush interval of every PROFILE_RANGE a busy thread reports
+    static const uint32_t RING_SIZE = 1 << 13;
+    static const int FLUSH_INTERVAL_MSECS = 100;
+
+    Tracer();
+    virtual ~Tracer();
+
     static int64_t now();
+
+    // whether any tracer is tracing, for the cost of a relaxed atomic load
+    static bool isActive() { return _active.load(std::memory_order_relaxed); }
+
+    // The small id of a name, to record events by. Names passed as const char* are looked up by their pointer in the
+    // calling thread first, so a literal is interned once per thread; other names are hashed.
+    static uint32_t internName(const char* name);
+    static uint32_t internName(const QString& name);
+    static uint16_t internCategory(const QLoggingCategory& category);
+
+    // records an event without id or arguments in the calling thread's ring, if tracing
+    static void recordEvent(uint16_t categoryID, uint32_t nameID, EventType type, int64_t timestamp = now());
+
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
         const QString& id = "", 
@@ -90,11 +136,15 @@ public:
         const QString& id = "", 
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
-    void startTracing();
+    // if binaryFile is given the trace is streamed to it, and serialize() has nothing to write
+    void startTracing(const QString& binaryFile = QString());
     void stopTracing();
     void serialize(const QString& file);
     bool isEnabled() const { return _enabled; }
 
+    // writes a trace streamed by startTracing(binaryFile) as Chrome trace JSON, gzipped if jsonFile ends in .gz
+    static bool binaryTraceToJson(const QString& binaryFile, const QString& jsonFile);
+
 private:
     void traceEvent(const QLoggingCategory& category, 
         const QString& name, EventType type,
@@ -102,10 +152,35 @@ private:
         const QString& id = "",
         const QVariantMap& args = QVariantMap(), const QVariantMap& extra = QVariantMap());
 
+    void runFlusher();
+    // moves the events recorded since the last flush to the trace, under _flushMutex
+    void flush();
+    void writeRecords(const QByteArray& records);
+    static QByteArray toJson(const QByteArray& records, qint64 processID, const std::list<TraceEvent>& metadataEvents);
+
+    static std::atomic<bool> _active;
+
     bool _enabled { false };
-    std::list<TraceEvent> _events;
     std::list<TraceEvent> _metadataEvents;
     std::mutex _eventsMutex;
+
+    // the events with arguments since the last flush, as binary trace records
+    QByteArray _pendingRecords;
+
+    // the binary trace, in memory unless streamed to _file
+    std::mutex _flushMutex;
+    QByteArray _trace;
+    QFile _file;
+    bool _streaming { false };
+    // how many of the interned names and categories the trace has
+    uint32_t _numNamesWritten { 0 };
+    uint32_t _numCategoriesWritten { 0 };
+    std::vector<RingEvent> _drained;
+
+    std::thread _flusher;
+    std::mutex _flusherMutex;
+    std::condition_variable _flusherCondition;
+    bool _stopFlusher { false };
 };
 
 inline void traceEvent(const QLoggingCategory& category, int64_t timestamp, const QString& name, EventType type, const QString& id = "", const QVariantMap& args = {}, const QVariantMap& extra = {}) {
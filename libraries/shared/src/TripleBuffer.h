@@ -0,0 +1,65 @@
+//
+//  TripleBuffer.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TripleBuffer_h
+#define hifi_TripleBuffer_h
+
+#include <atomic>
+#include <cstdint>
+
+// Hands the latest value from one producer thread to one consumer thread without either of them ever waiting: the
+// producer writes into a buffer of its own and publishes it, the consumer picks up the last one published when it
+// asks for it. Values published in between are simply dropped, which is what is wanted for device samples where
+// only the newest one matters.
+// The consumer's buffer stays its own until its next update(), so everything it reads in a frame is from one sample.
+template <typename T>
+class TripleBuffer {
+public:
+    // producer: copies the value into the producer's buffer and publishes it
+    void write(const T& value) {
+        _buffers[_writeIndex] = value;
+        publish();
+    }
+
+    // producer: the buffer to fill in place before calling publish()
+    T& getWriteBuffer() { return _buffers[_writeIndex]; }
+
+    void publish() {
+        uint8_t previous = _shared.exchange(_writeIndex | NEW_VALUE_BIT, std::memory_order_acq_rel);
+        _writeIndex = previous & INDEX_MASK;
+    }
+
+    // consumer: takes the latest published value if there is one, returns whether there was
+    bool update() {
+        if (!(_shared.load(std::memory_order_relaxed) & NEW_VALUE_BIT)) {
+            return false;
+        }
+        uint8_t previous = _shared.exchange(_readIndex, std::memory_order_acq_rel);
+        _readIndex = previous & INDEX_MASK;
+        return true;
+    }
+
+    // consumer: the value taken by the last update()
+    T& get() { return _buffers[_readIndex]; }
+    const T& get() const { return _buffers[_readIndex]; }
+
+private:
+    static const uint8_t INDEX_MASK = 0x3;
+    static const uint8_t NEW_VALUE_BIT = 0x4;
+
+    T _buffers[3];
+    // the buffer between the two threads, and whether it's newer than the consumer's
+    std::atomic<uint8_t> _shared { 1 };
+    uint8_t _writeIndex { 0 };
+    uint8_t _readIndex { 2 };
+};
+
+#endif // hifi_TripleBuffer_h
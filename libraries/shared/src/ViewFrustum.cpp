@@ -219,6 +219,48 @@ bool ViewFrustum::boxIntersectsFrustum(const AABox& box) const {
     return true;
 }
 
+uint32_t ViewFrustum::boxesIntersectFrustum(const AABox* const boxes[4]) const {
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+    // one box per lane: a box is outside when the distance to its farthest vertex from any plane is negative
+    const glm::vec3& corner0 = boxes[0]->getCorner();
+    const glm::vec3& corner1 = boxes[1]->getCorner();
+    const glm::vec3& corner2 = boxes[2]->getCorner();
+    const glm::vec3& corner3 = boxes[3]->getCorner();
+    const glm::vec3& scale0 = boxes[0]->getScale();
+    const glm::vec3& scale1 = boxes[1]->getScale();
+    const glm::vec3& scale2 = boxes[2]->getScale();
+    const glm::vec3& scale3 = boxes[3]->getScale();
+    const __m128 cornerX = _mm_setr_ps(corner0.x, corner1.x, corner2.x, corner3.x);
+    const __m128 cornerY = _mm_setr_ps(corner0.y, corner1.y, corner2.y, corner3.y);
+    const __m128 cornerZ = _mm_setr_ps(corner0.z, corner1.z, corner2.z, corner3.z);
+    const __m128 scaleX = _mm_setr_ps(scale0.x, scale1.x, scale2.x, scale3.x);
+    const __m128 scaleY = _mm_setr_ps(scale0.y, scale1.y, scale2.y, scale3.y);
+    const __m128 scaleZ = _mm_setr_ps(scale0.z, scale1.z, scale2.z, scale3.z);
+
+    __m128 outside = _mm_setzero_ps();
+    for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
+        const glm::vec3& normal = _planes[i].getNormal();
+        __m128 distance = _mm_set1_ps(_planes[i].getDCoefficient());
+        distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(normal.x),
+            normal.x > 0.0f ? _mm_add_ps(cornerX, scaleX) : cornerX));
+        distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(normal.y),
+            normal.y > 0.0f ? _mm_add_ps(cornerY, scaleY) : cornerY));
+        distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(normal.z),
+            normal.z > 0.0f ? _mm_add_ps(cornerZ, scaleZ) : cornerZ));
+        outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, _mm_setzero_ps()));
+    }
+    return ~(uint32_t)_mm_movemask_ps(outside) & 0xf;
+#else
+    uint32_t result = 0;
+    for (int i = 0; i < 4; i++) {
+        if (boxIntersectsFrustum(*boxes[i])) {
+            result |= 1 << i;
+        }
+    }
+    return result;
+#endif
+}
+
 bool ViewFrustum::boxInsideFrustum(const AABox& box) const {
     // only check against frustum
     for (int i = 0; i < NUM_FRUSTUM_PLANES; i++) {
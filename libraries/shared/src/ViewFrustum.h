@@ -105,6 +105,8 @@ public:
     bool sphereIntersectsFrustum(const glm::vec3& center, float radius) const;
     bool cubeIntersectsFrustum(const AACube& box) const;
     bool boxIntersectsFrustum(const AABox& box) const;
+    // the same test for four boxes at once, returning a bit for each box that intersects
+    uint32_t boxesIntersectFrustum(const AABox* const boxes[4]) const;
     bool boxInsideFrustum(const AABox& box) const;
 
     bool sphereIntersectsKeyhole(const glm::vec3& center, float radius) const;
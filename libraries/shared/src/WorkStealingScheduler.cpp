@@ -0,0 +1,140 @@
+//
+//  WorkStealingScheduler.cpp
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingScheduler.h"
+
+#include <algorithm>
+#include <assert.h>
+
+void WorkStealingScheduler::reset(int numWorkers, size_t numTasks, const std::vector<float>& costs) {
+    assert(costs.empty() || costs.size() == numTasks);
+    numWorkers = std::max(1, numWorkers);
+
+    if (numWorkers > _capacity) {
+        _deques.reset(new Deque[numWorkers]);
+        _capacity = numWorkers;
+    }
+    _numWorkers = numWorkers;
+    _numSteals = 0;
+
+    float totalCost = 0.0f;
+    if (costs.empty()) {
+        totalCost = (float)numTasks;
+    } else {
+        for (auto cost : costs) {
+            totalCost += cost;
+        }
+    }
+
+    // split the tasks into contiguous ranges of about equal cost
+    Index begin = 0;
+    float cumulativeCost = 0.0f;
+    for (int worker = 0; worker < numWorkers; ++worker) {
+        Index end = begin;
+        if (worker == numWorkers - 1) {
+            end = (Index)numTasks;
+        } else {
+            float targetCost = totalCost * (float)(worker + 1) / (float)numWorkers;
+            while (end < numTasks) {
+                float cost = costs.empty() ? 1.0f : costs[end];
+                // stop before a task that takes us further past the target than we are short of it
+                if (cumulativeCost + cost - targetCost > targetCost - cumulativeCost) {
+                    break;
+                }
+                cumulativeCost += cost;
+                ++end;
+            }
+        }
+
+        _deques[worker].range.store(pack(begin, end), std::memory_order_release);
+        _deques[worker].busyUsecs = 0;
+        begin = end;
+    }
+}
+
+bool WorkStealingScheduler::pop(int worker, Index& task) {
+    assert(worker >= 0 && worker < _numWorkers);
+    auto& range = _deques[worker].range;
+
+    uint64_t current = range.load(std::memory_order_acquire);
+    while (head(current) < tail(current)) {
+        if (range.compare_exchange_weak(current, pack(head(current) + 1, tail(current)), std::memory_order_acq_rel)) {
+            task = head(current);
+            return true;
+        }
+    }
+
+    return steal(worker, task);
+}
+
+bool WorkStealingScheduler::steal(int thief, Index& task) {
+    while (true) {
+        // pick the victim with the most tasks left
+        int victim = -1;
+        Index mostRemaining = 0;
+        uint64_t victimRange = 0;
+        for (int worker = 0; worker < _numWorkers; ++worker) {
+            uint64_t current = _deques[worker].range.load(std::memory_order_acquire);
+            Index remaining = tail(current) - head(current);
+            if (worker != thief && head(current) < tail(current) && remaining > mostRemaining) {
+                victim = worker;
+                mostRemaining = remaining;
+                victimRange = current;
+            }
+        }
+
+        if (victim == -1) {
+            return false;
+        }
+
+        // take the back half, the victim keeps working through the front
+        Index stolenCount = (mostRemaining + 1) / 2;
+        Index stolenBegin = tail(victimRange) - stolenCount;
+        if (_deques[victim].range.compare_exchange_strong(victimRange, pack(head(victimRange), stolenBegin),
+                                                          std::memory_order_acq_rel)) {
+            ++_numSteals;
+            task = stolenBegin;
+            if (stolenCount > 1) {
+                // our own deque is empty, nobody else can be popping from it
+                _deques[thief].range.store(pack(stolenBegin + 1, stolenBegin + stolenCount), std::memory_order_release);
+            }
+            return true;
+        }
+    }
+}
+
+void WorkStealingScheduler::recordBusyTime(int worker, uint64_t usecs) {
+    assert(worker >= 0 && worker < _numWorkers);
+    _deques[worker].busyUsecs += usecs;
+}
+
+uint64_t WorkStealingScheduler::getTotalBusyTime() const {
+    uint64_t total = 0;
+    for (int worker = 0; worker < _numWorkers; ++worker) {
+        total += _deques[worker].busyUsecs;
+    }
+    return total;
+}
+
+float WorkStealingScheduler::getImbalance() const {
+    uint64_t total = 0;
+    uint64_t busiest = 0;
+    for (int worker = 0; worker < _numWorkers; ++worker) {
+        total += _deques[worker].busyUsecs;
+        busiest = std::max(busiest, _deques[worker].busyUsecs);
+    }
+
+    if (total == 0) {
+        return 1.0f;
+    }
+    float mean = (float)total / (float)_numWorkers;
+    return (float)busiest / mean;
+}
@@ -0,0 +1,66 @@
+//
+//  WorkStealingScheduler.h
+//  libraries/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_WorkStealingScheduler_h
+#define hifi_WorkStealingScheduler_h
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Distributes one frame worth of indexed tasks among a fixed set of worker threads.
+//
+// Every worker owns a deque over a contiguous range of task indices, chosen so that all workers start with about the
+// same total expected cost. A worker pops from the front of its own range; once that is empty it steals the back half
+// of the busiest remaining range. Pops and steals are a single compare-and-swap on the victim's packed range.
+//
+// reset() and getImbalance() must not be called while workers are popping.
+class WorkStealingScheduler {
+public:
+    using Index = uint32_t;
+
+    // prepare a frame of numTasks tasks for numWorkers workers, an empty costs vector assumes unit costs
+    void reset(int numWorkers, size_t numTasks, const std::vector<float>& costs = std::vector<float>());
+
+    // grab the next task for this worker, false once every task has been handed out
+    bool pop(int worker, Index& task);
+
+    // record the time the worker spent running tasks this frame
+    void recordBusyTime(int worker, uint64_t usecs);
+
+    // ratio of the busiest worker's time to the mean worker's time, 1.0 is perfectly balanced
+    float getImbalance() const;
+    // the time all workers spent running tasks this frame
+    uint64_t getTotalBusyTime() const;
+    int getNumSteals() const { return _numSteals; }
+    int getNumWorkers() const { return _numWorkers; }
+
+private:
+    static uint64_t pack(Index head, Index tail) { return ((uint64_t)tail << 32) | head; }
+    static Index head(uint64_t range) { return (Index)(range & 0xFFFFFFFF); }
+    static Index tail(uint64_t range) { return (Index)(range >> 32); }
+
+    bool steal(int thief, Index& task);
+
+    struct alignas(64) Deque {
+        std::atomic<uint64_t> range { 0 };
+        uint64_t busyUsecs { 0 };
+    };
+
+    std::unique_ptr<Deque[]> _deques;
+    int _capacity { 0 };
+    int _numWorkers { 0 };
+    std::atomic<int> _numSteals { 0 };
+};
+
+#endif // hifi_WorkStealingScheduler_h
@@ -23,6 +23,7 @@
 
 #include "../PathUtils.h"
 #include "../NumericalConstants.h"
+#include "StartupTask.h"
 
 #ifdef Q_OS_WIN
 #include <sys/utime.h>
@@ -65,12 +66,14 @@ std::string getCachePath(const std::string& dirname_str) {
 
 void FileCache::setMinFreeSize(size_t size) {
     _minFreeSpaceSize = size;
+    waitForInitialization();
     clean();
     emit dirty();
 }
 
 void FileCache::setMaxSize(size_t maxSize) {
     _maxSize = std::min(maxSize, MAX_MAX_SIZE);
+    waitForInitialization();
     clean();
     emit dirty();
 }
@@ -118,6 +121,20 @@ void FileCache::initialize() {
     _initialized = true;
 }
 
+void FileCache::initializeInBackground() {
+    // scanning a big cache takes a while, and holding on to the cache keeps it until the scan is done
+    auto self = shared_from_this();
+    _initialization = StartupTask::start(QString("%1 cache scan").arg(_dirname.c_str()), [self] {
+        self->initialize();
+    });
+}
+
+void FileCache::waitForInitialization() {
+    if (_initialization) {
+        _initialization->wait();
+    }
+}
+
 std::unique_ptr<File> FileCache::createFile(Metadata&& metadata, const std::string& filepath) {
     return std::unique_ptr<File>(new cache::File(std::move(metadata), filepath));
 }
@@ -146,6 +163,7 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bo
     }
 
 
+    waitForInitialization();
     Lock lock(_mutex);
 
     if (!_initialized) {
@@ -182,6 +200,7 @@ FilePointer FileCache::writeFile(const char* data, File::Metadata&& metadata, bo
 
 
 FilePointer FileCache::getFile(const Key& key) {
+    waitForInitialization();
     Lock lock(_mutex);
 
     FilePointer file;
@@ -298,6 +317,7 @@ void FileCache::clean() {
 }
 
 void FileCache::wipe() {
+    waitForInitialization();
     Lock lock(_mutex);
     while (!_unusedFiles.empty()) {
         eject(*_unusedFiles.begin());
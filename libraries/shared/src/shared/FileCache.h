@@ -25,6 +25,7 @@
 Q_DECLARE_LOGGING_CATEGORY(file_cache)
 
 class FileCacheTests;
+class StartupTask;
 
 namespace cache {
 
@@ -94,6 +95,8 @@ signals:
 public:
     /// must be called after construction to create the cache on the fs and restore persisted files
     virtual void initialize();
+    /// the same as initialize() on a pool thread, the cache's other calls wait for it to finish
+    void initializeInBackground();
 
     // Add file to the cache and return the cache entry.  
     FilePointer writeFile(const char* data, Metadata&& metadata, bool overwrite = false);
@@ -123,6 +126,8 @@ private:
 
     size_t getOverbudgetAmount() const;
 
+    void waitForInitialization();
+
     // FIXME it might be desirable to have the min free space variable be static so it can be
     // shared among multiple instances of FileCache
     std::atomic<size_t> _minFreeSpaceSize { DEFAULT_MIN_FREE_STORAGE_SPACE };
@@ -136,6 +141,7 @@ private:
     const std::string _dirname;
     const std::string _dirpath;
     bool _initialized { false };
+    std::shared_ptr<StartupTask> _initialization;
 
     Mutex _mutex;
     Map _files;
@@ -0,0 +1,141 @@
+//
+//  SeqLockedTransform.h
+//  libraries/shared/src/shared
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SeqLockedTransform_h
+#define hifi_SeqLockedTransform_h
+
+#include <atomic>
+#include <thread>
+
+#include "../Transform.h"
+
+// A copy of a Transform, and a tag saying what it was computed from, that is read without taking a lock.  A read that
+// overlaps a write is retried, so readers never block a writer and only wait for the writes they overlap.
+class SeqLockedTransform {
+public:
+    // Writers must be serialized by the caller.
+    void store(const Transform& transform, uint32_t tag = 0) {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        write(transform, tag);
+        _sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // For writers that aren't serialized: the store is skipped when another one is in progress.
+    bool tryStore(const Transform& transform, uint32_t tag) {
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        if ((sequence & 1) || !_sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed)) {
+            return false;
+        }
+        std::atomic_thread_fence(std::memory_order_release);
+        write(transform, tag);
+        _sequence.store(sequence + 2, std::memory_order_release);
+        return true;
+    }
+
+    Transform load() const {
+        uint32_t tag;
+        return load(tag);
+    }
+
+    Transform load(uint32_t& tag) const {
+        glm::quat rotation;
+        glm::vec3 scale;
+        glm::vec3 translation;
+        read(rotation, scale, translation, tag);
+
+        Transform transform;
+        transform.setTranslation(translation);
+        transform.setRotation(rotation);
+        transform.setScale(scale);
+        return transform;
+    }
+
+    glm::vec3 loadTranslation() const {
+        glm::quat rotation;
+        glm::vec3 scale;
+        glm::vec3 translation;
+        uint32_t tag;
+        read(rotation, scale, translation, tag);
+        return translation;
+    }
+
+    glm::quat loadRotation() const {
+        glm::quat rotation;
+        glm::vec3 scale;
+        glm::vec3 translation;
+        uint32_t tag;
+        read(rotation, scale, translation, tag);
+        return rotation;
+    }
+
+    glm::vec3 loadScale() const {
+        glm::quat rotation;
+        glm::vec3 scale;
+        glm::vec3 translation;
+        uint32_t tag;
+        read(rotation, scale, translation, tag);
+        return scale;
+    }
+
+private:
+    enum : int {
+        ROTATION = 0,
+        SCALE = 4,
+        TRANSLATION = 7,
+        NUM_VALUES = 10
+    };
+
+    void write(const Transform& transform, uint32_t tag) {
+        const glm::quat& rotation = transform.getRotation();
+        const glm::vec3& scale = transform.getScale();
+        const glm::vec3& translation = transform.getTranslation();
+        for (int i = 0; i < 4; i++) {
+            _values[ROTATION + i].store(rotation[i], std::memory_order_relaxed);
+        }
+        for (int i = 0; i < 3; i++) {
+            _values[SCALE + i].store(scale[i], std::memory_order_relaxed);
+            _values[TRANSLATION + i].store(translation[i], std::memory_order_relaxed);
+        }
+        _tag.store(tag, std::memory_order_relaxed);
+    }
+
+    void read(glm::quat& rotation, glm::vec3& scale, glm::vec3& translation, uint32_t& tag) const {
+        while (true) {
+            uint32_t before = _sequence.load(std::memory_order_acquire);
+            if (before & 1) {
+                // a write is in progress
+                std::this_thread::yield();
+                continue;
+            }
+            for (int i = 0; i < 4; i++) {
+                rotation[i] = _values[ROTATION + i].load(std::memory_order_relaxed);
+            }
+            for (int i = 0; i < 3; i++) {
+                scale[i] = _values[SCALE + i].load(std::memory_order_relaxed);
+                translation[i] = _values[TRANSLATION + i].load(std::memory_order_relaxed);
+            }
+            tag = _tag.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_sequence.load(std::memory_order_relaxed) == before) {
+                return;
+            }
+        }
+    }
+
+    std::atomic<uint32_t> _sequence { 0 };
+    std::atomic<uint32_t> _tag { 0 };
+    std::atomic<float> _values[NUM_VALUES] { { 0.0f }, { 0.0f }, { 0.0f }, { 1.0f }, { 1.0f }, { 1.0f }, { 1.0f },
+                                             { 0.0f }, { 0.0f }, { 0.0f } };
+};
+
+#endif // hifi_SeqLockedTransform_h
@@ -0,0 +1,120 @@
+//
+//  StartupTask.cpp
+//  libraries/shared/src/shared
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StartupTask.h"
+
+#include <QtCore/QRunnable>
+#include <QtCore/QThreadPool>
+
+#include "../Profile.h"
+
+namespace {
+
+class StartupTaskRunnable : public QRunnable {
+public:
+    StartupTaskRunnable(const std::function<void()>& run) : _run(run) {}
+
+    void run() override { _run(); }
+
+private:
+    std::function<void()> _run;
+};
+
+}
+
+StartupTask::StartupTask(const QString& name, std::function<void()> function) :
+    _name(name),
+    _function(std::move(function)) {
+}
+
+StartupTask::Pointer StartupTask::start(const QString& name, std::function<void()> function,
+                                        const std::vector<Pointer>& dependencies) {
+    auto task = std::make_shared<StartupTask>(name, std::move(function));
+    task->_dependencies = dependencies;
+
+    // counts itself until it's registered with every dependency, so one finishing meanwhile can't queue it early
+    task->_numUnfinishedDependencies = 1;
+    for (const auto& dependency : dependencies) {
+        std::lock_guard<std::mutex> lock(dependency->_mutex);
+        if (dependency->_state != State::Finished) {
+            ++task->_numUnfinishedDependencies;
+            dependency->_dependents.push_back(task);
+        }
+    }
+    task->dependencyFinished();
+    return task;
+}
+
+void StartupTask::wait() {
+    if (_state == State::Finished) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_state == State::Running && _runningThread == std::this_thread::get_id()) {
+            return;
+        }
+    }
+
+    for (const auto& dependency : _dependencies) {
+        dependency->wait();
+    }
+
+    // runs it here if no pool thread has got to it yet
+    run();
+
+    std::unique_lock<std::mutex> lock(_mutex);
+    _finished.wait(lock, [this] { return _state == State::Finished; });
+}
+
+void StartupTask::queue() {
+    State waiting = State::Waiting;
+    if (!_state.compare_exchange_strong(waiting, State::Queued)) {
+        return;
+    }
+    auto self = shared_from_this();
+    QThreadPool::globalInstance()->start(new StartupTaskRunnable([self] { self->run(); }));
+}
+
+void StartupTask::run() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_state == State::Running || _state == State::Finished) {
+            return;
+        }
+        _state = State::Running;
+        _runningThread = std::this_thread::get_id();
+    }
+
+    {
+        PROFILE_RANGE(startup, _name);
+        _function();
+    }
+
+    std::vector<Pointer> dependents;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _state = State::Finished;
+        _function = nullptr;
+        dependents.swap(_dependents);
+    }
+    _finished.notify_all();
+
+    for (const auto& dependent : dependents) {
+        dependent->dependencyFinished();
+    }
+}
+
+void StartupTask::dependencyFinished() {
+    if (--_numUnfinishedDependencies == 0) {
+        queue();
+    }
+}
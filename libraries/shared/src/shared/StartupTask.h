@@ -0,0 +1,71 @@
+//
+//  StartupTask.h
+//  libraries/shared/src/shared
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_StartupTask_h
+#define hifi_StartupTask_h
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QString>
+
+// A part of startup that doesn't need the main thread, such as loading shaders or scanning a cache directory, run on
+// the global thread pool while the main thread carries on with the rest. It starts once the tasks it depends on have
+// finished, and whatever needs its result waits for it. Waiting for a task that hasn't started yet runs it on the
+// waiting thread instead, so a wait never depends on there being a free thread in the pool.
+//
+// Each task is traced as a range under trace.startup, on whichever thread ran it.
+class StartupTask : public std::enable_shared_from_this<StartupTask> {
+public:
+    using Pointer = std::shared_ptr<StartupTask>;
+
+    static Pointer start(const QString& name, std::function<void()> function, const std::vector<Pointer>& dependencies = {});
+
+    const QString& getName() const { return _name; }
+    bool isFinished() const { return _state == State::Finished; }
+
+    // returns once the task and the ones it depends on have run, or right away when called from the task itself
+    void wait();
+
+    StartupTask(const QString& name, std::function<void()> function);
+
+private:
+    enum class State {
+        Waiting,
+        Queued,
+        Running,
+        Finished
+    };
+
+    void queue();
+    void run();
+    void dependencyFinished();
+
+    const QString _name;
+    std::function<void()> _function;
+    std::vector<Pointer> _dependencies;
+
+    std::atomic<State> _state { State::Waiting };
+    std::atomic<int> _numUnfinishedDependencies { 0 };
+    std::thread::id _runningThread;
+
+    std::mutex _mutex;
+    std::condition_variable _finished;
+    // kept until they're queued, so that a task runs even if no one holds on to it
+    std::vector<Pointer> _dependents;
+};
+
+#endif // hifi_StartupTask_h
@@ -12,6 +12,13 @@
 #include <QtCore/QDebug>
 #include "StorageLogging.h"
 
+#include <cerrno>
+
+#if !defined(Q_OS_WIN)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 Q_LOGGING_CATEGORY(storagelogging, "hifi.core.storage")
 
 using namespace storage;
@@ -103,3 +110,48 @@ FileStorage::~FileStorage() {
         _file.close();
     }
 }
+
+void FileStorage::advise(size_t offset, size_t size, Advice advice) const {
+#if !defined(Q_OS_WIN)
+    if (!isMapped() || size == 0 || (offset + size) > _size) {
+        return;
+    }
+
+    // madvise takes whole pages
+    static const size_t SYSTEM_PAGE_SIZE = (size_t)sysconf(_SC_PAGESIZE);
+    auto begin = (uintptr_t)(_mapped + offset) & ~(uintptr_t)(SYSTEM_PAGE_SIZE - 1);
+    auto end = (uintptr_t)(_mapped + offset + size);
+    int result = madvise((void*)begin, end - begin, advice == Advice::WillNeed ? MADV_WILLNEED : MADV_DONTNEED);
+    if (result != 0) {
+        qCDebug(storagelogging) << "madvise failed on" << _file.fileName() << errno;
+    }
+#endif
+}
+
+StoragePointer FileStorage::createMappedView(size_t viewSize, size_t offset) const {
+    if (viewSize == 0 || (viewSize + offset) > _size) {
+        return StoragePointer();
+    }
+    if (!isMapped()) {
+        return createView(viewSize, offset);
+    }
+    return std::make_shared<MappedViewStorage>(std::static_pointer_cast<const FileStorage>(shared_from_this()), viewSize, offset);
+}
+
+MappedViewStorage::MappedViewStorage(const std::shared_ptr<const FileStorage>& owner, size_t size, size_t offset) :
+    ViewStorage(owner, size, owner->data() + offset), _file(owner), _offset(offset) {
+    _file->advise(_offset, size, FileStorage::Advice::WillNeed);
+
+    // Read a byte of every page, so the disk is read here rather than by whoever reads the view
+    static const size_t TOUCH_STRIDE = 4096;
+    volatile uint8_t touched = 0;
+    const uint8_t* pages = data();
+    for (size_t i = 0; i < size; i += TOUCH_STRIDE) {
+        touched += pages[i];
+    }
+    touched += pages[size - 1];
+}
+
+MappedViewStorage::~MappedViewStorage() {
+    _file->advise(_offset, size(), FileStorage::Advice::DontNeed);
+}
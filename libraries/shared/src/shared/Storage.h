@@ -60,6 +60,9 @@ namespace storage {
 
     class FileStorage : public Storage {
     public:
+        // How a range of the mapping is about to be used, see madvise
+        enum class Advice { WillNeed, DontNeed };
+
         static StoragePointer create(const QString& filename, size_t size, const uint8_t* data);
         FileStorage(const QString& filename);
         ~FileStorage();
@@ -71,6 +74,16 @@ namespace storage {
         uint8_t* mutableData() override { return _hasWriteAccess ? _mapped : nullptr; }
         size_t size() const override { return _size; }
         operator bool() const override { return _valid; }
+
+        bool isMapped() const { return _mapped && _fallback.isEmpty(); }
+        // A no-op where the file isn't mapped, or the platform has no madvise
+        void advise(size_t offset, size_t size, Advice advice) const;
+
+        // A view of the mapping that faults its pages in when created, so it can be read later without blocking on
+        // the disk, and lets the kernel drop them from the process when released.  While the view is kept, only the
+        // page cache backs it, instead of a copy on the heap.
+        StoragePointer createMappedView(size_t size, size_t offset) const;
+
     private:
         // For compressed QRC files we can't map the file object, so we need to read it into memory
         QByteArray _fallback;
@@ -94,6 +107,15 @@ namespace storage {
         const uint8_t* _data;
     };
 
+    class MappedViewStorage : public ViewStorage {
+    public:
+        MappedViewStorage(const std::shared_ptr<const FileStorage>& owner, size_t size, size_t offset);
+        ~MappedViewStorage();
+    private:
+        const std::shared_ptr<const FileStorage> _file;
+        const size_t _offset;
+    };
+
 }
 
 #endif // hifi_Storage_h
@@ -0,0 +1,23 @@
+//
+//  Benchmark.cpp
+//  libraries/test-utils/src/test-utils
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "Benchmark.h"
+
+#include <QtCore/QDebug>
+
+namespace benchmark {
+
+void report(const char* name, const Result& result) {
+    qInfo().noquote() << "BENCHMARK" << name << QString::number(result.nsPerOp, 'f', 1) << "ns/op"
+                      << QString::number(result.bytesPerOp, 'f', 0) << "bytes/op";
+}
+
+}
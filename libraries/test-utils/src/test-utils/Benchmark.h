@@ -0,0 +1,72 @@
+//
+//  Benchmark.h
+//  libraries/test-utils/src/test-utils
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_test_utils_Benchmark_h
+#define hifi_test_utils_Benchmark_h
+
+#include <chrono>
+#include <cstdint>
+
+#include <MemoryAccounting.h>
+
+// Micro-benchmarks that report the time and the bytes allocated per operation, one line each, starting with
+// "BENCHMARK" so that runs can be compared against a baseline:
+//
+//     BENCHMARK NLPacket::create 212.2 ns/op 1520 bytes/op
+//
+// Bytes are only counted in test executables that use BENCHMARK_COUNT_ALLOCATIONS() once, at file scope, and only for
+// allocations made through operator new on the benchmark's thread; otherwise they're reported as -1. They're the usable
+// sizes of the blocks, as MemoryAccounting counts them, which can be a little more than was asked for.
+namespace benchmark {
+
+struct Result {
+    double nsPerOp { 0.0 };
+    double bytesPerOp { 0.0 };
+    uint64_t numOps { 0 };
+};
+
+void report(const char* name, const Result& result);
+
+// Calls operation in batches until minDuration has passed, after a first batch to warm caches up
+template <typename F>
+Result run(const char* name, F&& operation, std::chrono::milliseconds minDuration = std::chrono::milliseconds(200)) {
+    using Clock = std::chrono::steady_clock;
+    const uint64_t BATCH_SIZE = 64;
+    for (uint64_t i = 0; i < BATCH_SIZE; i++) {
+        operation();
+    }
+
+    Result result;
+    uint64_t bytesBefore = MemoryAccounting::getNumAllocatedBytes();
+    auto start = Clock::now();
+    auto elapsed = Clock::duration::zero();
+    do {
+        for (uint64_t i = 0; i < BATCH_SIZE; i++) {
+            operation();
+        }
+        result.numOps += BATCH_SIZE;
+        elapsed = Clock::now() - start;
+    } while (elapsed < minDuration);
+    uint64_t bytes = MemoryAccounting::getNumAllocatedBytes() - bytesBefore;
+
+    result.nsPerOp = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / result.numOps;
+    result.bytesPerOp = MemoryAccounting::areHooksInstalled() ? (double)bytes / result.numOps : -1.0;
+    report(name, result);
+    return result;
+}
+
+}
+
+// counts the bytes allocated with the memory accounting hooks, the one replacement of operator new there can be
+#define BENCHMARK_COUNT_ALLOCATIONS() MEMORY_ACCOUNTING_HOOKS()
+
+#endif // hifi_test_utils_Benchmark_h
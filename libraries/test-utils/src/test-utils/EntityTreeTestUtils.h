@@ -0,0 +1,71 @@
+//
+//  EntityTreeTestUtils.h
+//  libraries/test-utils/src/test-utils
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+#ifndef hifi_EntityTreeTestUtils_h
+#define hifi_EntityTreeTestUtils_h
+
+#include <random>
+
+#include <AddressManager.h>
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <NodeList.h>
+
+// Helpers for the tests and tools that build an entity tree without an application around it. They're inline, so that
+// test-utils doesn't have to link the entities library, which its users link anyway.
+
+// adding entities to a tree checks the node list for rez permissions
+inline void setUpEntityTreeDependencies() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AddressManager>();
+    DependencyManager::set<NodeList>(NodeType::Unassigned);
+}
+
+inline void tearDownEntityTreeDependencies() {
+    DependencyManager::destroy<NodeList>();
+    DependencyManager::destroy<AddressManager>();
+}
+
+// an empty tree, as the entity server has it
+inline EntityTreePointer createTestEntityTree() {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+inline EntityItemID addTestEntity(const EntityTreePointer& tree, EntityTypes::EntityType type, const glm::vec3& position,
+                                  const glm::vec3& dimensions = glm::vec3(1.0f)) {
+    EntityItemID id(QUuid::createUuid());
+    EntityItemProperties properties;
+    properties.setType(type);
+    properties.setPosition(position);
+    properties.setDimensions(dimensions);
+    tree->withWriteLock([&] {
+        tree->addEntity(id, properties);
+    });
+    return id;
+}
+
+// boxes spread over a cube of sceneSize around the origin, each side between minSize and maxSize, the same ones for a seed
+inline void addRandomTestBoxes(const EntityTreePointer& tree, int numBoxes, float sceneSize, float minSize, float maxSize,
+                               unsigned int seed) {
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<float> position(-0.5f * sceneSize, 0.5f * sceneSize);
+    std::uniform_real_distribution<float> size(minSize, maxSize);
+    for (int i = 0; i < numBoxes; i++) {
+        glm::vec3 boxPosition(position(generator), position(generator), position(generator));
+        addTestEntity(tree, EntityTypes::Box, boxPosition, glm::vec3(size(generator), size(generator), size(generator)));
+    }
+}
+
+#endif // hifi_EntityTreeTestUtils_h
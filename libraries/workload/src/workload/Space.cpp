@@ -18,8 +18,65 @@
 
 #include <glm/gtx/quaternion.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 using namespace workload;
 
+// proxies classified at a time, small enough for a block's spheres and regions to stay in L1
+static const uint32_t CATEGORIZE_BLOCK_SIZE = 1024;
+// below this many blocks the classification isn't worth handing out to other threads
+static const uint32_t MIN_PARALLEL_CATEGORIZE_BLOCKS = 8;
+
+// Classifies the proxies from begin to end against the region spheres of all the views, view after view and
+// R1 through R3 for each, and appends the proxies whose region changed to changes.
+static void categorizeProxies(Proxy* proxies, uint32_t begin, uint32_t end, const std::vector<Sphere>& regionSpheres,
+                              Changes& changes) {
+    // the spheres are copied apart, so the distance tests below run over plain arrays of floats
+    // and the compiler can vectorize them across proxies
+    float x[CATEGORIZE_BLOCK_SIZE];
+    float y[CATEGORIZE_BLOCK_SIZE];
+    float z[CATEGORIZE_BLOCK_SIZE];
+    float radius[CATEGORIZE_BLOCK_SIZE];
+    int32_t regions[CATEGORIZE_BLOCK_SIZE];
+
+    const uint32_t numProxies = end - begin;
+    for (uint32_t i = 0; i < numProxies; ++i) {
+        const Sphere& sphere = proxies[begin + i].sphere;
+        x[i] = sphere.x;
+        y[i] = sphere.y;
+        z[i] = sphere.z;
+        radius[i] = sphere.w;
+        regions[i] = Region::R4;
+    }
+
+    // a proxy is in the lowest region it touches in any of the views
+    const uint32_t numSpheres = (uint32_t)regionSpheres.size();
+    for (uint32_t j = 0; j < numSpheres; ++j) {
+        const Sphere& regionSphere = regionSpheres[j];
+        const int32_t region = (int32_t)(j % Region::NUM_TRACKED_REGIONS);
+        for (uint32_t i = 0; i < numProxies; ++i) {
+            float dx = x[i] - regionSphere.x;
+            float dy = y[i] - regionSphere.y;
+            float dz = z[i] - regionSphere.z;
+            float touchDistance = radius[i] + regionSphere.w;
+            bool touches = dx * dx + dy * dy + dz * dz < touchDistance * touchDistance;
+            regions[i] = (touches && region < regions[i]) ? region : regions[i];
+        }
+    }
+
+    for (uint32_t i = 0; i < numProxies; ++i) {
+        Proxy& proxy = proxies[begin + i];
+        if (proxy.region < Region::INVALID) {
+            proxy.prevRegion = proxy.region;
+            proxy.region = (uint8_t)regions[i];
+            if (proxy.region != proxy.prevRegion) {
+                changes.emplace_back(Space::Change((int32_t)(begin + i), proxy.region, proxy.prevRegion));
+            }
+        }
+    }
+}
+
 Space::Space() : Collection() {
 }
 
@@ -92,31 +149,41 @@ void Space::processUpdates(const Transaction::Updates& transactions) {
 
 void Space::categorizeAndGetChanges(std::vector<Space::Change>& changes) {
     std::unique_lock<std::mutex> lock(_proxiesMutex);
+    std::vector<Sphere> regionSpheres;
+    regionSpheres.reserve(_views.size() * Region::NUM_TRACKED_REGIONS);
+    for (auto& view : _views) {
+        regionSpheres.insert(regionSpheres.end(), view.regions, view.regions + Region::NUM_TRACKED_REGIONS);
+    }
+
     uint32_t numProxies = (uint32_t)_proxies.size();
-    uint32_t numViews = (uint32_t)_views.size();
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        Proxy& proxy = _proxies[i];
-        if (proxy.region < Region::INVALID) {
-            glm::vec3 proxyCenter = glm::vec3(proxy.sphere);
-            float proxyRadius = proxy.sphere.w;
-            uint8_t region = Region::R4;
-            for (uint32_t j = 0; j < numViews; ++j) {
-                auto& view = _views[j];
-                // for each 'view' we need only increment 'k' below the current value of 'region'
-                for (uint8_t k = 0; k < region; ++k) {
-                    float touchDistance = proxyRadius + view.regions[k].w;
-                    if (distance2(proxyCenter, glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
-                        region = k;
-                        break;
-                    }
-                }
-            }
-            proxy.prevRegion = proxy.region;
-            proxy.region = region;
-            if (proxy.region != proxy.prevRegion) {
-                changes.emplace_back(Space::Change((int32_t)i, proxy.region, proxy.prevRegion));
-            }
+    uint32_t numBlocks = (numProxies + CATEGORIZE_BLOCK_SIZE - 1) / CATEGORIZE_BLOCK_SIZE;
+    Proxy* proxies = _proxies.data();
+    auto blockEnd = [numProxies](uint32_t block) {
+        return std::min((block + 1) * CATEGORIZE_BLOCK_SIZE, numProxies);
+    };
+
+    if (numBlocks < MIN_PARALLEL_CATEGORIZE_BLOCKS) {
+        for (uint32_t block = 0; block < numBlocks; ++block) {
+            categorizeProxies(proxies, block * CATEGORIZE_BLOCK_SIZE, blockEnd(block), regionSpheres, changes);
         }
+        return;
+    }
+
+    // each block collects its own changes, appended in block order after so they come out sorted by proxy like above
+    std::vector<Changes> blockChanges(numBlocks);
+    tbb::parallel_for(tbb::blocked_range<uint32_t>(0, numBlocks), [&](const tbb::blocked_range<uint32_t>& range) {
+        for (uint32_t block = range.begin(); block != range.end(); ++block) {
+            categorizeProxies(proxies, block * CATEGORIZE_BLOCK_SIZE, blockEnd(block), regionSpheres, blockChanges[block]);
+        }
+    });
+
+    size_t numChanges = changes.size();
+    for (auto& block : blockChanges) {
+        numChanges += block.size();
+    }
+    changes.reserve(numChanges);
+    for (auto& block : blockChanges) {
+        changes.insert(changes.end(), block.begin(), block.end());
     }
 }
 
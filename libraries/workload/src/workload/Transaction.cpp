@@ -156,7 +156,8 @@ uint32_t Collection::enqueueFrame() {
 
 
 void Collection::processTransactionQueue() {
-    static TransactionFrames queuedFrames;
+    // each collection can be processed on a thread of its own, like the spaces of the entity server's send threads
+    TransactionFrames queuedFrames;
     {
         // capture the queued frames and clear the queue
         std::unique_lock<std::mutex> lock(_transactionFramesMutex);
@@ -27,12 +27,15 @@
 
 #include <ViewFrustum.h>
 #include <PathUtils.h>
+#include <SharedUtil.h>
 #include <shared/NsightHelpers.h>
 #include <controllers/Pose.h>
 #include <display-plugins/CompositorHelper.h>
 #include <ui-plugins/PluginContainer.h>
 #include <gl/OffscreenGLCanvas.h>
 #include <ThreadHelpers.h>
+#include <PerformanceCounters.h>
+#include <TripleBuffer.h>
 
 #include "OpenVrHelpers.h"
 
@@ -41,7 +44,14 @@ Q_DECLARE_LOGGING_CATEGORY(displayplugins)
 const char* OpenVrThreadedSubmit{ "OpenVR Threaded Submit" };  // this probably shouldn't be hardcoded here
 
 PoseData _nextRenderPoseData;
-PoseData _nextSimPoseData;
+// written by the present or submit thread, read by the main thread without either waiting on the other
+TripleBuffer<PoseData> _nextSimPoseData;
+
+static PerformanceCounters::Histogram& poseLatencyHistogram() {
+    static auto& histogram = PerformanceCounters::getInstance().histogram("openvr_pose_latency_usecs",
+        "Time from sampling the OpenVR poses to their use in rendering a frame");
+    return histogram;
+}
 
 #define MIN_CORES_FOR_NORMAL_RENDER 5
 bool forceInterleavedReprojection = (QThread::idealThreadCount() < MIN_CORES_FOR_NORMAL_RENDER);
@@ -287,6 +297,7 @@ public:
                 nextRender.frameIndex = _plugin.presentCount();
                 vr::VRCompositor()->WaitGetPoses(nextRender.vrPoses, vr::k_unMaxTrackedDeviceCount, nextSim.vrPoses,
                                                  vr::k_unMaxTrackedDeviceCount);
+                nextRender.sampleTime = nextSim.sampleTime = usecTimestampNow();
 
                 // Copy invalid poses in nextSim from nextRender
                 for (uint32_t i = 0; i < vr::k_unMaxTrackedDeviceCount; ++i) {
@@ -331,7 +342,7 @@ public:
         auto lastCount = _presentCount.load();
         Lock lock(_plugin._presentMutex);
         _presented.wait(lock, [&]() -> bool { return _presentCount.load() > lastCount; });
-        _nextSimPoseData = _nextSim;
+        _nextSimPoseData.write(_nextSim);
         _nextRenderPoseData = _nextRender;
     }
 
@@ -548,7 +559,8 @@ void OpenVrDisplayPlugin::uncustomizeContext() {
 
 void OpenVrDisplayPlugin::resetSensors() {
     glm::mat4 m;
-    withNonPresentThreadLock([&] { m = toGlm(_nextSimPoseData.vrPoses[0].mDeviceToAbsoluteTracking); });
+    _nextSimPoseData.update();
+    m = toGlm(_nextSimPoseData.get().vrPoses[0].mDeviceToAbsoluteTracking);
     _sensorResetMat = glm::inverse(cancelOutRollAndPitch(m));
 }
 
@@ -568,8 +580,11 @@ bool OpenVrDisplayPlugin::beginFrameRender(uint32_t frameIndex) {
     }
     _currentRenderFrameInfo = FrameInfo();
 
-    PoseData nextSimPoseData;
-    withNonPresentThreadLock([&] { nextSimPoseData = _nextSimPoseData; });
+    _nextSimPoseData.update();
+    PoseData nextSimPoseData = _nextSimPoseData.get();
+    if (nextSimPoseData.sampleTime != 0) {
+        poseLatencyHistogram().record(usecTimestampNow() - nextSimPoseData.sampleTime);
+    }
 
     // HACK: when interface is launched and steam vr is NOT running, openvr will return bad HMD poses for a few frames
     // To workaround this, filter out any hmd poses that are obviously bad, i.e. beneath the floor.
@@ -690,12 +705,13 @@ void OpenVrDisplayPlugin::postPreview() {
     if (!_threadedSubmit) {
         vr::VRCompositor()->WaitGetPoses(nextRender.vrPoses, vr::k_unMaxTrackedDeviceCount, nextSim.vrPoses,
                                          vr::k_unMaxTrackedDeviceCount);
+        nextRender.sampleTime = nextSim.sampleTime = usecTimestampNow();
 
         glm::mat4 resetMat;
         withPresentThreadLock([&] { resetMat = _sensorResetMat; });
         nextRender.update(resetMat);
         nextSim.update(resetMat);
-        withPresentThreadLock([&] { _nextSimPoseData = nextSim; });
+        _nextSimPoseData.write(nextSim);
         _nextRenderPoseData = nextRender;
     }
 
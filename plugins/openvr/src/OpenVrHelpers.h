@@ -68,6 +68,8 @@ inline vr::HmdMatrix34_t toOpenVr(const mat4& m) {
 
 struct PoseData {
     uint32_t frameIndex{ 0 };
+    // when the poses were sampled from the compositor, in usecTimestampNow() time
+    uint64_t sampleTime{ 0 };
     vr::TrackedDevicePose_t vrPoses[vr::k_unMaxTrackedDeviceCount];
     mat4 poses[vr::k_unMaxTrackedDeviceCount];
     vec3 linearVelocities[vr::k_unMaxTrackedDeviceCount];
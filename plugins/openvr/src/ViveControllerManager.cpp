@@ -51,6 +51,7 @@
 #include <ui-plugins/PluginContainer.h>
 #include <plugins/DisplayPlugin.h>
 #include <ThreadHelpers.h>
+#include <TripleBuffer.h>
 
 #include <controllers/UserInputMapper.h>
 #include <plugins/InputConfiguration.h>
@@ -58,7 +59,7 @@
 
 #include "OpenVrDisplayPlugin.h"
 
-extern PoseData _nextSimPoseData;
+extern TripleBuffer<PoseData> _nextSimPoseData;
 
 vr::IVRSystem* acquireOpenVrSystem();
 void releaseOpenVrSystem();
@@ -770,11 +771,15 @@ void ViveControllerManager::pluginUpdate(float deltaTime, const controller::Inpu
         return;
     }
 
+    // take the latest poses the display plugin published, which then stay the same for all of this update
+    _nextSimPoseData.update();
     if (isDesktopMode() && _desktopMode) {
-        _system->GetDeviceToAbsoluteTrackingPose(vr::TrackingUniverseStanding, 0, _nextSimPoseData.vrPoses, vr::k_unMaxTrackedDeviceCount);
-        _nextSimPoseData.update(Matrices::IDENTITY);
+        PoseData& nextSimPoseData = _nextSimPoseData.get();
+        _system->GetDeviceToAbsoluteTrackingPose(vr::TrackingUniverseStanding, 0, nextSimPoseData.vrPoses, vr::k_unMaxTrackedDeviceCount);
+        nextSimPoseData.sampleTime = usecTimestampNow();
+        nextSimPoseData.update(Matrices::IDENTITY);
     } else if (isDesktopMode()) {
-        _nextSimPoseData.resetToInvalid();
+        _nextSimPoseData.get().resetToInvalid();
     }
 
     auto userInputMapper = DependencyManager::get<controller::UserInputMapper>();
@@ -916,7 +921,7 @@ void ViveControllerManager::InputDevice::update(float deltaTime, const controlle
     calibrateFromUI(inputCalibrationData);
 
     updateCalibratedLimbs(inputCalibrationData);
-    _lastSimPoseData = _nextSimPoseData;
+    _lastSimPoseData = _nextSimPoseData.get();
 }
 
 void ViveControllerManager::InputDevice::calibrateFromHandController(const controller::InputCalibrationData& inputCalibrationData) {
@@ -1037,7 +1042,7 @@ void ViveControllerManager::InputDevice::handleTrackedObject(uint32_t deviceInde
     printDeviceTrackingResultChange(deviceIndex);
     if (_system->IsTrackedDeviceConnected(deviceIndex) &&
         _system->GetTrackedDeviceClass(deviceIndex) == vr::TrackedDeviceClass_GenericTracker &&
-        _nextSimPoseData.vrPoses[deviceIndex].bPoseIsValid &&
+        _nextSimPoseData.get().vrPoses[deviceIndex].bPoseIsValid &&
         poseIndex <= controller::TRACKED_OBJECT_15) {
 
         uint64_t now = usecTimestampNow();
@@ -1046,40 +1051,40 @@ void ViveControllerManager::InputDevice::handleTrackedObject(uint32_t deviceInde
         case OutOfRangeDataStrategy::Drop:
         default:
             // Drop - Mark all non Running_OK results as invald
-            if (_nextSimPoseData.vrPoses[deviceIndex].eTrackingResult == vr::TrackingResult_Running_OK) {
-                pose = buildPose(_nextSimPoseData.poses[deviceIndex], _nextSimPoseData.linearVelocities[deviceIndex], _nextSimPoseData.angularVelocities[deviceIndex]);
+            if (_nextSimPoseData.get().vrPoses[deviceIndex].eTrackingResult == vr::TrackingResult_Running_OK) {
+                pose = buildPose(_nextSimPoseData.get().poses[deviceIndex], _nextSimPoseData.get().linearVelocities[deviceIndex], _nextSimPoseData.get().angularVelocities[deviceIndex]);
             } else {
                 pose.valid = false;
             }
             break;
         case OutOfRangeDataStrategy::None:
             // None - Ignore eTrackingResult all together
-            pose = buildPose(_nextSimPoseData.poses[deviceIndex], _nextSimPoseData.linearVelocities[deviceIndex], _nextSimPoseData.angularVelocities[deviceIndex]);
+            pose = buildPose(_nextSimPoseData.get().poses[deviceIndex], _nextSimPoseData.get().linearVelocities[deviceIndex], _nextSimPoseData.get().angularVelocities[deviceIndex]);
             break;
         case OutOfRangeDataStrategy::Freeze:
             // Freeze - Dont invalide non Running_OK poses, instead just return the last good pose.
-            if (_nextSimPoseData.vrPoses[deviceIndex].eTrackingResult == vr::TrackingResult_Running_OK) {
-                pose = buildPose(_nextSimPoseData.poses[deviceIndex], _nextSimPoseData.linearVelocities[deviceIndex], _nextSimPoseData.angularVelocities[deviceIndex]);
+            if (_nextSimPoseData.get().vrPoses[deviceIndex].eTrackingResult == vr::TrackingResult_Running_OK) {
+                pose = buildPose(_nextSimPoseData.get().poses[deviceIndex], _nextSimPoseData.get().linearVelocities[deviceIndex], _nextSimPoseData.get().angularVelocities[deviceIndex]);
             } else {
                 pose = buildPose(_lastSimPoseData.poses[deviceIndex], _lastSimPoseData.linearVelocities[deviceIndex], _lastSimPoseData.angularVelocities[deviceIndex]);
 
                 // make sure that we do not overwrite the pose in the _lastSimPose with incorrect data.
-                _nextSimPoseData.poses[deviceIndex] = _lastSimPoseData.poses[deviceIndex];
-                _nextSimPoseData.linearVelocities[deviceIndex] = _lastSimPoseData.linearVelocities[deviceIndex];
-                _nextSimPoseData.angularVelocities[deviceIndex] = _lastSimPoseData.angularVelocities[deviceIndex];
+                _nextSimPoseData.get().poses[deviceIndex] = _lastSimPoseData.poses[deviceIndex];
+                _nextSimPoseData.get().linearVelocities[deviceIndex] = _lastSimPoseData.linearVelocities[deviceIndex];
+                _nextSimPoseData.get().angularVelocities[deviceIndex] = _lastSimPoseData.angularVelocities[deviceIndex];
             }
             break;
         case OutOfRangeDataStrategy::DropAfterDelay:
             const uint64_t DROP_DELAY_TIME = 500 * USECS_PER_MSEC;
 
             // All Running_OK results are valid.
-            if (_nextSimPoseData.vrPoses[deviceIndex].eTrackingResult == vr::TrackingResult_Running_OK) {
-                pose = buildPose(_nextSimPoseData.poses[deviceIndex], _nextSimPoseData.linearVelocities[deviceIndex], _nextSimPoseData.angularVelocities[deviceIndex]);
+            if (_nextSimPoseData.get().vrPoses[deviceIndex].eTrackingResult == vr::TrackingResult_Running_OK) {
+                pose = buildPose(_nextSimPoseData.get().poses[deviceIndex], _nextSimPoseData.get().linearVelocities[deviceIndex], _nextSimPoseData.get().angularVelocities[deviceIndex]);
                 // update the timer
                 _simDataRunningOkTimestampMap[deviceIndex] = now;
             } else if (now - _simDataRunningOkTimestampMap[deviceIndex] < DROP_DELAY_TIME) {
                 // report the pose, even though pose is out-of-range
-                pose = buildPose(_nextSimPoseData.poses[deviceIndex], _nextSimPoseData.linearVelocities[deviceIndex], _nextSimPoseData.angularVelocities[deviceIndex]);
+                pose = buildPose(_nextSimPoseData.get().poses[deviceIndex], _nextSimPoseData.get().linearVelocities[deviceIndex], _nextSimPoseData.get().angularVelocities[deviceIndex]);
             } else {
                 // this pose has been out-of-range for too long.
                 pose.valid = false;
@@ -1326,12 +1331,12 @@ controller::Pose ViveControllerManager::InputDevice::addOffsetToPuckPose(const c
 void ViveControllerManager::InputDevice::handleHmd(uint32_t deviceIndex, const controller::InputCalibrationData& inputCalibrationData) {
      if (_system->IsTrackedDeviceConnected(deviceIndex) &&
          _system->GetTrackedDeviceClass(deviceIndex) == vr::TrackedDeviceClass_HMD &&
-         _nextSimPoseData.vrPoses[deviceIndex].bPoseIsValid) {
+         _nextSimPoseData.get().vrPoses[deviceIndex].bPoseIsValid) {
 
          if (_hmdTrackingEnabled){
-             const mat4& mat = _nextSimPoseData.poses[deviceIndex];
-             const vec3 linearVelocity = _nextSimPoseData.linearVelocities[deviceIndex];
-             const vec3 angularVelocity = _nextSimPoseData.angularVelocities[deviceIndex];
+             const mat4& mat = _nextSimPoseData.get().poses[deviceIndex];
+             const vec3 linearVelocity = _nextSimPoseData.get().linearVelocities[deviceIndex];
+             const vec3 angularVelocity = _nextSimPoseData.get().angularVelocities[deviceIndex];
 
              handleHeadPoseEvent(inputCalibrationData, mat, linearVelocity, angularVelocity);
          } else {
@@ -1345,12 +1350,12 @@ void ViveControllerManager::InputDevice::handleHmd(uint32_t deviceIndex, const c
 
 void ViveControllerManager::InputDevice::handleHandController(float deltaTime, uint32_t deviceIndex, const controller::InputCalibrationData& inputCalibrationData, bool isLeftHand) {
 
-    if (isDeviceIndexActive(_system, deviceIndex) && _nextSimPoseData.vrPoses[deviceIndex].bPoseIsValid) {
+    if (isDeviceIndexActive(_system, deviceIndex) && _nextSimPoseData.get().vrPoses[deviceIndex].bPoseIsValid) {
 
         // process pose
-        const mat4& mat = _nextSimPoseData.poses[deviceIndex];
-        const vec3 linearVelocity = _nextSimPoseData.linearVelocities[deviceIndex];
-        const vec3 angularVelocity = _nextSimPoseData.angularVelocities[deviceIndex];
+        const mat4& mat = _nextSimPoseData.get().poses[deviceIndex];
+        const vec3 linearVelocity = _nextSimPoseData.get().linearVelocities[deviceIndex];
+        const vec3 angularVelocity = _nextSimPoseData.get().angularVelocities[deviceIndex];
         handlePoseEvent(deltaTime, inputCalibrationData, mat, linearVelocity, angularVelocity, isLeftHand);
 
         vr::VRControllerState_t controllerState = vr::VRControllerState_t();
@@ -1489,10 +1494,10 @@ enum ViveButtonChannel {
 };
 
 void ViveControllerManager::InputDevice::printDeviceTrackingResultChange(uint32_t deviceIndex) {
-    if (_nextSimPoseData.vrPoses[deviceIndex].eTrackingResult != _lastSimPoseData.vrPoses[deviceIndex].eTrackingResult) {
+    if (_nextSimPoseData.get().vrPoses[deviceIndex].eTrackingResult != _lastSimPoseData.vrPoses[deviceIndex].eTrackingResult) {
         qDebug() << "OpenVR: Device" << deviceIndex << "Tracking Result changed from" <<
             deviceTrackingResultToString(_lastSimPoseData.vrPoses[deviceIndex].eTrackingResult)
-                 << "to" << deviceTrackingResultToString(_nextSimPoseData.vrPoses[deviceIndex].eTrackingResult);
+                 << "to" << deviceTrackingResultToString(_nextSimPoseData.get().vrPoses[deviceIndex].eTrackingResult);
     }
 }
 
@@ -1597,7 +1602,7 @@ void ViveControllerManager::InputDevice::hapticsHelper(float deltaTime, bool lef
 
     if (_system->IsTrackedDeviceConnected(deviceIndex) &&
         _system->GetTrackedDeviceClass(deviceIndex) == vr::TrackedDeviceClass_Controller &&
-        _nextSimPoseData.vrPoses[deviceIndex].bPoseIsValid) {
+        _nextSimPoseData.get().vrPoses[deviceIndex].bPoseIsValid) {
         float strength = leftHand ? _leftHapticStrength : _rightHapticStrength;
         float duration = leftHand ? _leftHapticDuration : _rightHapticDuration;
 
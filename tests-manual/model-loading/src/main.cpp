@@ -0,0 +1,121 @@
+//
+//  main.cpp
+//  tests-manual/model-loading/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+// Times the parsing and the baking of models the way ModelCache's GeometryReader does them, to compare the parallel
+// mesh extraction and baking against a single thread on large reference models:
+//
+//   model-loading-test [--iterations N] [--threads N] model.fbx [model.glb ...]
+//
+// --threads 1 runs everything on the calling thread, as the loading used to.
+
+#include <algorithm>
+
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QUrl>
+
+#include <tbb/task_arena.h>
+
+#include <DependencyManager.h>
+#include <FBXSerializer.h>
+#include <GLTFSerializer.h>
+#include <OBJSerializer.h>
+#include <hfm/ModelFormatRegistry.h>
+#include <model-baker/Baker.h>
+#include <model-networking/ModelLoader.h>
+
+static const int BYTES_PER_MEGABYTE = 1024 * 1024;
+
+struct Timings {
+    qint64 loadMsecs { 0 };
+    qint64 bakeMsecs { 0 };
+};
+
+static bool loadAndBake(const QByteArray& data, const QUrl& url, Timings& timings) {
+    ModelLoader modelLoader;
+    hifi::VariantHash serializerMapping;
+    serializerMapping.insert("deduplicateIndices", true);
+
+    QElapsedTimer timer;
+    timer.start();
+    hfm::Model::Pointer hfmModel = modelLoader.load(data, serializerMapping, url, "");
+    timings.loadMsecs += timer.restart();
+    if (!hfmModel) {
+        return false;
+    }
+
+    baker::Baker modelBaker(hfmModel, hifi::VariantHash(), url);
+    modelBaker.run();
+    timings.bakeMsecs += timer.elapsed();
+    return (bool)modelBaker.getHFMModel();
+}
+
+int main(int argc, char** argv) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Times the loading of models");
+    parser.addHelpOption();
+    const QCommandLineOption iterationsOption("iterations", "number of loads of each model", "iterations", "5");
+    parser.addOption(iterationsOption);
+    const QCommandLineOption threadsOption("threads", "maximum number of threads, 0 for all the cores", "threads", "0");
+    parser.addOption(threadsOption);
+    parser.addPositionalArgument("models", "model files to load");
+    parser.process(app);
+
+    const int iterations = std::max(1, parser.value(iterationsOption).toInt());
+    const int threads = parser.value(threadsOption).toInt();
+    if (parser.positionalArguments().isEmpty()) {
+        parser.showHelp(1);
+    }
+
+    auto modelFormatRegistry = DependencyManager::set<ModelFormatRegistry>();
+    modelFormatRegistry->addFormat(FBXSerializer());
+    modelFormatRegistry->addFormat(OBJSerializer());
+    modelFormatRegistry->addFormat(GLTFSerializer());
+
+    tbb::task_arena arena(threads > 0 ? threads : (int)tbb::task_arena::automatic);
+    int result = 0;
+    for (const auto& path : parser.positionalArguments()) {
+        QFile file(path);
+        if (!file.open(QIODevice::ReadOnly)) {
+            qWarning() << "Can't read" << path;
+            result = 1;
+            continue;
+        }
+        QByteArray data = file.readAll();
+        QUrl url = QUrl::fromLocalFile(QFileInfo(path).absoluteFilePath());
+
+        Timings timings;
+        bool success = true;
+        arena.execute([&] {
+            for (int i = 0; i < iterations && success; i++) {
+                success = loadAndBake(data, url, timings);
+            }
+        });
+        if (!success) {
+            qWarning() << "Failed to load" << path;
+            result = 1;
+            continue;
+        }
+        qInfo().noquote() << QFileInfo(path).fileName() << "(" << data.size() / BYTES_PER_MEGABYTE << "MB ):"
+                          << "load" << timings.loadMsecs / iterations << "ms,"
+                          << "bake" << timings.bakeMsecs / iterations << "ms"
+                          << "(average of" << iterations << "on" << (threads > 0 ? threads : arena.max_concurrency())
+                          << "threads)";
+    }
+
+    DependencyManager::destroy<ModelFormatRegistry>();
+    return result;
+}
@@ -0,0 +1,261 @@
+//
+//  Flythrough.hpp
+//  tests-manual/render-perf/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QStringList>
+
+#include <GLMHelpers.h>
+
+// A scripted camera path through a scene, read from a JSON file like
+//
+//  {
+//      "scene": "scene.json",      entities JSON, relative to the path file; baked assets are read from scene.atp next to it
+//      "settleSeconds": 60,        the longest to wait for the scene's assets to load before flying
+//      "warmupFrames": 120,        frames drawn from the first keyframe before any are recorded
+//      "frameStep": 0.016667,      seconds of the path each frame moves on by, whatever the frame rate
+//      "keyframes": [
+//          { "time": 0, "position": [ 0, 2, 0 ], "orientation": [ 0, 0, 0, 1 ] },
+//          { "time": 10, "position": [ 20, 2, -30 ], "orientation": [ 0, 0.7071, 0, 0.7071 ] }
+//      ]
+//  }
+//
+// Moving the camera on by a fixed step each frame draws the same views on any hardware, so that the timings are comparable.
+struct CameraPath {
+    struct Keyframe {
+        float time;
+        glm::vec3 position;
+        glm::quat orientation;
+    };
+
+    QString name;
+    QString scene;
+    float settleSeconds { 60.0f };
+    int warmupFrames { 120 };
+    float frameStep { 1.0f / 60.0f };
+    std::vector<Keyframe> keyframes;
+
+    float getDuration() const { return keyframes.empty() ? 0.0f : keyframes.back().time; }
+    int getNumFrames() const { return frameStep > 0.0f ? (int)(getDuration() / frameStep) + 1 : 0; }
+
+    void sample(float time, glm::vec3& position, glm::quat& orientation) const {
+        auto next = std::upper_bound(keyframes.begin(), keyframes.end(), time,
+                                     [](float time, const Keyframe& keyframe) { return time < keyframe.time; });
+        if (next == keyframes.begin() || next == keyframes.end()) {
+            const Keyframe& keyframe = next == keyframes.begin() ? keyframes.front() : keyframes.back();
+            position = keyframe.position;
+            orientation = keyframe.orientation;
+            return;
+        }
+        const Keyframe& previous = *(next - 1);
+        float alpha = (time - previous.time) / (next->time - previous.time);
+        position = glm::mix(previous.position, next->position, alpha);
+        orientation = glm::slerp(previous.orientation, next->orientation, alpha);
+    }
+
+    bool read(const QString& fileName, QString& error) {
+        QFile file(fileName);
+        if (!file.open(QIODevice::ReadOnly)) {
+            error = "Cannot open camera path " + fileName;
+            return false;
+        }
+        QJsonParseError parseError;
+        QJsonObject object = QJsonDocument::fromJson(file.readAll(), &parseError).object();
+        if (parseError.error != QJsonParseError::NoError) {
+            error = "Cannot parse camera path " + fileName + ": " + parseError.errorString();
+            return false;
+        }
+
+        QFileInfo fileInfo(fileName);
+        name = fileInfo.baseName();
+        scene = object["scene"].toString();
+        if (!scene.isEmpty() && QFileInfo(scene).isRelative()) {
+            scene = fileInfo.absolutePath() + "/" + scene;
+        }
+        settleSeconds = (float)object["settleSeconds"].toDouble(settleSeconds);
+        warmupFrames = object["warmupFrames"].toInt(warmupFrames);
+        frameStep = (float)object["frameStep"].toDouble(frameStep);
+
+        keyframes.clear();
+        for (const auto& value : object["keyframes"].toArray()) {
+            QJsonObject keyframeObject = value.toObject();
+            QJsonArray position = keyframeObject["position"].toArray();
+            QJsonArray orientation = keyframeObject["orientation"].toArray();
+            if (position.size() != 3 || orientation.size() != 4) {
+                error = "Camera path keyframes need a position [x, y, z] and an orientation [x, y, z, w]";
+                return false;
+            }
+            Keyframe keyframe;
+            keyframe.time = (float)keyframeObject["time"].toDouble();
+            keyframe.position = glm::vec3(position[0].toDouble(), position[1].toDouble(), position[2].toDouble());
+            keyframe.orientation = glm::normalize(glm::quat((float)orientation[3].toDouble(), (float)orientation[0].toDouble(),
+                                                            (float)orientation[1].toDouble(), (float)orientation[2].toDouble()));
+            if (!keyframes.empty() && keyframe.time <= keyframes.back().time) {
+                error = "Camera path keyframes have to be in time order";
+                return false;
+            }
+            keyframes.push_back(keyframe);
+        }
+        if (keyframes.empty() || frameStep <= 0.0f) {
+            error = "Camera path " + fileName + " has no keyframes to fly through";
+            return false;
+        }
+        return true;
+    }
+};
+
+// The timings of each frame of a flythrough, written out as JSON and compared against those of an earlier run.
+class FlythroughRecorder {
+public:
+    // the metrics of each frame, in milliseconds unless named otherwise
+    static const QStringList& getFrameMetrics() {
+        static const QStringList FRAME_METRICS { "cpu", "renderThread", "gpu", "batch", "drawcalls", "triangles" };
+        return FRAME_METRICS;
+    }
+    // a run is slower than the baseline where these summaries of these metrics are
+    static const QStringList& getComparedMetrics() {
+        static const QStringList COMPARED_METRICS { "cpu", "renderThread", "gpu" };
+        return COMPARED_METRICS;
+    }
+    static const QStringList& getComparedSummaries() {
+        static const QStringList COMPARED_SUMMARIES { "mean", "p95" };
+        return COMPARED_SUMMARIES;
+    }
+
+    void clear() {
+        _frames.clear();
+        _taskTimes.clear();
+    }
+
+    // the values of the frame metrics, in their order
+    void addFrame(float time, const glm::vec3& position, const std::vector<double>& values) {
+        _frames.push_back({ time, position, values });
+    }
+
+    // the cpu (and for those that time it, gpu) run time of a render task job in the frame just recorded
+    void addTaskTime(const QString& job, double cpuMsecs, double gpuMsecs) {
+        auto& times = _taskTimes[job];
+        times.cpu.push_back(cpuMsecs);
+        times.gpu.push_back(gpuMsecs);
+    }
+
+    size_t getNumFrames() const { return _frames.size(); }
+
+    QJsonObject toJson(const QJsonObject& info) const {
+        QJsonObject result;
+        result["info"] = info;
+
+        QJsonObject summary;
+        for (int i = 0; i < getFrameMetrics().size(); ++i) {
+            std::vector<double> values;
+            values.reserve(_frames.size());
+            for (const auto& frame : _frames) {
+                values.push_back(frame.values[i]);
+            }
+            summary[getFrameMetrics()[i]] = summarize(values);
+        }
+        result["summary"] = summary;
+
+        QJsonObject tasks;
+        for (const auto& taskTimes : _taskTimes) {
+            QJsonObject task;
+            task["cpu"] = summarize(taskTimes.second.cpu);
+            if (std::any_of(taskTimes.second.gpu.begin(), taskTimes.second.gpu.end(), [](double msecs) { return msecs > 0.0; })) {
+                task["gpu"] = summarize(taskTimes.second.gpu);
+            }
+            tasks[taskTimes.first] = task;
+        }
+        result["tasks"] = tasks;
+
+        QJsonArray frames;
+        for (const auto& frame : _frames) {
+            QJsonObject frameObject;
+            frameObject["time"] = frame.time;
+            frameObject["position"] = QJsonArray { frame.position.x, frame.position.y, frame.position.z };
+            for (int i = 0; i < getFrameMetrics().size(); ++i) {
+                frameObject[getFrameMetrics()[i]] = frame.values[i];
+            }
+            frames.append(frameObject);
+        }
+        result["frames"] = frames;
+        return result;
+    }
+
+    // Compares the summaries of a run with those of a baseline, the result of another, and lists where the run is slower by
+    // more than the tolerance, a fraction of the baseline's value.
+    static QJsonObject compare(const QJsonObject& result, const QJsonObject& baseline, double tolerance, QStringList& regressions) {
+        QJsonObject comparison;
+        QJsonObject summary = result["summary"].toObject();
+        QJsonObject baselineSummary = baseline["summary"].toObject();
+        for (const auto& metric : getComparedMetrics()) {
+            QJsonObject metricComparison;
+            for (const auto& statistic : getComparedSummaries()) {
+                double value = summary[metric].toObject()[statistic].toDouble();
+                double baselineValue = baselineSummary[metric].toObject()[statistic].toDouble();
+                if (baselineValue <= 0.0) {
+                    continue;
+                }
+                double ratio = value / baselineValue;
+                metricComparison[statistic] = ratio;
+                if (ratio > 1.0 + tolerance) {
+                    regressions << QString("%1 %2 %3 ms against %4 ms").arg(metric, statistic)
+                                       .arg(value, 0, 'f', 3).arg(baselineValue, 0, 'f', 3);
+                }
+            }
+            comparison[metric] = metricComparison;
+        }
+        comparison["tolerance"] = tolerance;
+        comparison["regressions"] = QJsonArray::fromStringList(regressions);
+        return comparison;
+    }
+
+private:
+    static QJsonObject summarize(std::vector<double> values) {
+        QJsonObject summary;
+        if (values.empty()) {
+            return summary;
+        }
+        std::sort(values.begin(), values.end());
+        double total = 0.0;
+        for (double value : values) {
+            total += value;
+        }
+        auto percentile = [&](double fraction) { return values[std::min(values.size() - 1, (size_t)(fraction * values.size()))]; };
+        summary["mean"] = total / values.size();
+        summary["median"] = percentile(0.5);
+        summary["p95"] = percentile(0.95);
+        summary["p99"] = percentile(0.99);
+        summary["max"] = values.back();
+        return summary;
+    }
+
+    struct Frame {
+        float time;
+        glm::vec3 position;
+        std::vector<double> values;
+    };
+    struct TaskTimes {
+        std::vector<double> cpu;
+        std::vector<double> gpu;
+    };
+
+    std::vector<Frame> _frames;
+    std::map<QString, TaskTimes> _taskTimes;
+};
@@ -16,6 +16,8 @@
 
 #include <QProcessEnvironment>
 
+#include <QtCore/QCommandLineParser>
+#include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QElapsedTimer>
 #include <QtCore/QLoggingCategory>
@@ -44,6 +46,7 @@
 #include <AssetClient.h>
 #include <shaders/Shaders.h>
 
+#include <gl/GLHelpers.h>
 #include <gl/OffscreenGLCanvas.h>
 
 #include <gpu/gl/GLBackend.h>
@@ -59,8 +62,10 @@
 #include <WebEntityItem.h>
 #include <OctreeUtils.h>
 #include <render/Engine.h>
+#include <render/EngineStats.h>
 #include <Model.h>
 #include <graphics/Stage.h>
+#include <ResourceCache.h>
 #include <TextureCache.h>
 #include <FramebufferCache.h>
 #include <model-networking/ModelCache.h>
@@ -79,6 +84,7 @@
 #include <AddressManager.h>
 
 #include "Camera.hpp"
+#include "Flythrough.hpp"
 
 Q_DECLARE_LOGGING_CATEGORY(renderperflogging)
 Q_LOGGING_CATEGORY(renderperflogging, "hifi.render_perf")
@@ -204,12 +210,21 @@ public:
     std::shared_ptr<gpu::Backend> _backend;
     std::vector<uint64_t> _frameTimes;
     size_t _frameIndex{ 0 };
+    // every frame since the last resetFrameTotals, for the benchmark
+    std::atomic<uint64_t> _totalFrameUsecs{ 0 };
+    std::atomic<uint32_t> _totalFrames{ 0 };
+    std::atomic<uint64_t> _lastFrameUsecs{ 0 };
     std::mutex _frameLock;
     std::queue<gpu::FramePointer> _pendingFrames;
     gpu::FramePointer _activeFrame;
     QSize _size;
     static const size_t FRAME_TIME_BUFFER_SIZE{ 8192 };
 
+    void resetFrameTotals() {
+        _totalFrameUsecs = 0;
+        _totalFrames = 0;
+    }
+
     void submitFrame(const gpu::FramePointer& frame) {
         std::unique_lock<std::mutex> lock(_frameLock);
         _pendingFrames.push(frame);
@@ -350,6 +365,9 @@ public:
             auto duration = usecTimestampNow() - start;
             auto frameBufferIndex = _frameIndex % FRAME_TIME_BUFFER_SIZE;
             _frameTimes[frameBufferIndex] = duration;
+            _lastFrameUsecs = duration;
+            _totalFrameUsecs += duration;
+            ++_totalFrames;
             ++_frameIndex;
             if (0 == _frameIndex % FRAME_TIME_BUFFER_SIZE) {
                 report();
@@ -377,6 +395,14 @@ Q_GUI_EXPORT void qt_gl_set_global_share_context(QOpenGLContext* context);
 
 // Create a simple OpenGL window that renders text in various ways
 class QTestWindow : public QWindow, public AbstractViewStateInterface {
+    enum RenderMode
+    {
+        NORMAL = 0,
+        STEREO,
+        HMD,
+        RENDER_MODE_COUNT
+    };
+
 protected:
     void copyCurrentViewFrustum(ViewFrustum& viewOut) const override { viewOut = _viewFrustum; }
 
@@ -516,6 +542,38 @@ public:
         DependencyManager::destroy<NodeList>();
     }
 
+    // Flies the camera along the path through its scene once the scene's assets have loaded, writes the timings of each frame
+    // to the output file and compares them with those in the baseline file if there is one, then quits: with 1 if the run was
+    // slower than the baseline by more than the tolerance, a fraction, and with 2 if the baseline couldn't be read.
+    bool startFlythrough(const CameraPath& path, const QString& modeName, const QString& outputFile,
+                         const QString& baselineFile, double tolerance) {
+        RenderMode mode;
+        if (!parseMode(modeName, mode)) {
+            qWarning() << "Unknown mode" << modeName;
+            return false;
+        }
+        if (!QFileInfo(path.scene).exists()) {
+            qWarning() << "Cannot find the scene file" << path.scene << "of camera path" << path.name;
+            return false;
+        }
+
+        _flythroughPath = path;
+        _flythroughMode = modeName.toLower();
+        _flythroughOutput = outputFile.isEmpty() ? path.name + "-results.json" : outputFile;
+        _flythroughBaseline = baselineFile;
+        _flythroughTolerance = tolerance;
+        _flythroughRecorder.clear();
+        setMode(mode);
+        importScene(path.scene);
+
+        auto now = usecTimestampNow();
+        _flythroughIdleSince = now;
+        _flythroughSettleEnd = now + (uint64_t)(path.settleSeconds * USECS_PER_SECOND);
+        _flythroughPhase = FLYTHROUGH_SETTLING;
+        qDebug() << "Flying" << path.name << "through" << path.scene << "for" << path.getNumFrames() << "frames";
+        return true;
+    }
+
     void loadCommands(const QString& filename) {
         QFileInfo fileInfo(filename);
         if (!fileInfo.exists()) {
@@ -569,6 +627,10 @@ protected:
                 toggleCulling();
                 return;
 
+            case Qt::Key_F10:
+                startBenchmark(DEFAULT_BENCHMARK_SECONDS);
+                return;
+
             case Qt::Key_Home:
                 gpu::Texture::setAllowedGPUMemoryUsage(0);
                 return;
@@ -608,6 +670,7 @@ private:
             return;
         }
         _renderCount = _renderThread._presentCount.load();
+        auto frameStart = usecTimestampNow();
         update();
 
         _initContext.makeCurrent();
@@ -653,6 +716,7 @@ private:
 
         // Final framebuffer that will be handled to the display-plugin
         render(&renderArgs);
+        recordFlythroughFrame(usecTimestampNow() - frameStart);
 
         if (_fps != _renderThread._fps) {
             _fps = _renderThread._fps;
@@ -750,6 +814,23 @@ private:
                 return;
             }
             parsePath(commandParams[1]);
+        } else if (verb == "mode") {
+            // mode normal|stereo|hmd
+            if (commandParams.length() < 2) {
+                qDebug() << "No mode specified";
+                return;
+            }
+            RenderMode mode;
+            if (parseMode(commandParams[1], mode)) {
+                setMode(mode);
+            } else {
+                qDebug() << "Unknown mode " << commandParams[1];
+            }
+        } else if (verb == "benchmark") {
+            // benchmark [seconds per mode], the commands after it wait for it to finish
+            int seconds = commandParams.length() > 1 ? commandParams[1].toInt() : DEFAULT_BENCHMARK_SECONDS;
+            startBenchmark(seconds);
+            _nextCommandTime = _benchmarkModeEnd + (RENDER_MODE_COUNT - 1) * (_benchmarkWarmup + _benchmarkDuration);
         } else {
             qDebug() << "Unknown command " << command;
         }
@@ -779,6 +860,8 @@ private:
         static auto last = now;
 
         runNextCommand(now);
+        updateBenchmark(now);
+        updateFlythrough(now);
 
         float delta = now - last;
         // Update the camera
@@ -962,8 +1045,241 @@ private:
     void toggleCulling() { _cullingEnabled = !_cullingEnabled; }
 
     void cycleMode() {
+        setMode((RenderMode)((_renderMode + 1) % RENDER_MODE_COUNT));
+    }
+
+    // Draws the scene from where the camera is in each mode in turn, for the time given after a warmup, and logs the average
+    // frame time of each next to the mono one: stereo and hmd both go down the single pass instanced stereo path, hmd at the
+    // size and with the projections of a headset.
+    void startBenchmark(int seconds) {
+        if (seconds <= 0) {
+            qDebug() << "No benchmark duration specified";
+            return;
+        }
+        _benchmarkDuration = seconds * USECS_PER_SECOND;
+        _benchmarkWarmup = BENCHMARK_WARMUP_SECONDS * USECS_PER_SECOND;
+        _benchmarkResults.clear();
+        _benchmarkMode = NORMAL;
+        _benchmarkModeStart = usecTimestampNow() + _benchmarkWarmup;
+        _benchmarkModeEnd = _benchmarkModeStart + _benchmarkDuration;
+        _benchmarkRunning = true;
+        setMode(NORMAL);
+        qDebug() << "Benchmarking the render modes for" << seconds << "seconds each";
+    }
+
+    void updateBenchmark(quint64 now) {
+        if (!_benchmarkRunning || now < _benchmarkModeStart) {
+            return;
+        }
+        if (!_benchmarkMeasuring) {
+            _renderThread.resetFrameTotals();
+            _benchmarkMeasuring = true;
+            return;
+        }
+        if (now < _benchmarkModeEnd) {
+            return;
+        }
+
+        uint32_t frames = _renderThread._totalFrames;
+        float averageMsecs = frames ? (float)_renderThread._totalFrameUsecs / (float)(frames * USECS_PER_MSEC) : 0.0f;
+        _benchmarkResults.push_back(averageMsecs);
+        _benchmarkMeasuring = false;
+
+        if (_benchmarkMode + 1 < RENDER_MODE_COUNT) {
+            _benchmarkMode = (RenderMode)(_benchmarkMode + 1);
+            _benchmarkModeStart = now + _benchmarkWarmup;
+            _benchmarkModeEnd = _benchmarkModeStart + _benchmarkDuration;
+            setMode(_benchmarkMode);
+            return;
+        }
+
+        static const char* MODE_NAMES[RENDER_MODE_COUNT] = { "normal", "stereo", "hmd" };
+        float monoMsecs = _benchmarkResults[NORMAL];
+        for (int mode = NORMAL; mode < RENDER_MODE_COUNT; ++mode) {
+            float msecs = _benchmarkResults[mode];
+            qDebug().nospace() << "Benchmark " << MODE_NAMES[mode] << ": " << msecs << " ms per frame, x"
+                               << (monoMsecs > 0.0f ? msecs / monoMsecs : 0.0f) << " of normal";
+        }
+        _benchmarkRunning = false;
+        setMode(NORMAL);
+    }
+
+    void placeFlythroughCamera(float time) {
+        glm::vec3 position;
+        glm::quat orientation;
+        _flythroughPath.sample(time, position, orientation);
+        _camera.setPosition(position);
+        _camera.setRotation(orientation);
+    }
+
+    void updateFlythrough(quint64 now) {
+        // the scene has loaded once nothing has been loading for this long
+        static const uint64_t FLYTHROUGH_IDLE_USECS = 2 * USECS_PER_SECOND;
+
+        switch (_flythroughPhase) {
+            case FLYTHROUGH_OFF:
+                return;
+
+            case FLYTHROUGH_SETTLING: {
+                // from the start of the path, so that what's first seen is loaded first
+                placeFlythroughCamera(0.0f);
+                if (ResourceCache::getLoadingRequestCount() > 0 || ResourceCache::getPendingRequestCount() > 0) {
+                    _flythroughIdleSince = now;
+                }
+                bool hasSettled = now - _flythroughIdleSince >= FLYTHROUGH_IDLE_USECS;
+                if (!hasSettled && now < _flythroughSettleEnd) {
+                    return;
+                }
+                if (!hasSettled) {
+                    qWarning() << "The scene is still loading after" << _flythroughPath.settleSeconds << "seconds, flying anyway";
+                }
+                _flythroughPhase = FLYTHROUGH_WARMUP;
+                _flythroughFrame = 0;
+                return;
+            }
+
+            case FLYTHROUGH_WARMUP:
+                placeFlythroughCamera(0.0f);
+                if (++_flythroughFrame >= _flythroughPath.warmupFrames) {
+                    _flythroughPhase = FLYTHROUGH_FLYING;
+                    _flythroughFrame = 0;
+                }
+                return;
+
+            case FLYTHROUGH_FLYING:
+                placeFlythroughCamera(_flythroughFrame * _flythroughPath.frameStep);
+                return;
+        }
+    }
+
+    void recordTaskTimes(const QString& path, render::JobConfig* config, int depth) {
+        for (auto subConfig : config->getSubConfigs()) {
+            auto jobConfig = qobject_cast<render::JobConfig*>(subConfig);
+            if (!jobConfig) {
+                continue;
+            }
+            QString name = path + "." + jobConfig->objectName();
+            double gpuMsecs = 0.0;
+            if (auto gpuJobConfig = qobject_cast<render::GPUJobConfig*>(jobConfig)) {
+                gpuMsecs = gpuJobConfig->getGPURunTime();
+            } else if (auto gpuTaskConfig = qobject_cast<render::GPUTaskConfig*>(jobConfig)) {
+                gpuMsecs = gpuTaskConfig->getGPURunTime();
+            }
+            _flythroughRecorder.addTaskTime(name, jobConfig->getCPURunTime(), gpuMsecs);
+            if (depth > 1 && jobConfig->isTask()) {
+                recordTaskTimes(name, jobConfig, depth - 1);
+            }
+        }
+    }
+
+    void recordFlythroughFrame(uint64_t cpuUsecs) {
+        if (_flythroughPhase != FLYTHROUGH_FLYING) {
+            return;
+        }
+
+        // the gpu and batch times are the gpu context's moving averages over the last few frames, the render thread's is
+        // that of the latest frame it executed
+        auto& gpuContext = _renderThread._gpuContext;
+        auto engineConfig = _renderEngine->getConfiguration();
+        auto statsConfig = engineConfig->getConfig<render::EngineStats>("Stats");
+        _flythroughRecorder.addFrame(_flythroughFrame * _flythroughPath.frameStep, _camera.position, {
+            (double)cpuUsecs / USECS_PER_MSEC,
+            (double)_renderThread._lastFrameUsecs / USECS_PER_MSEC,
+            gpuContext->getFrameTimerGPUAverage(),
+            gpuContext->getFrameTimerBatchAverage(),
+            statsConfig ? (double)statsConfig->frameDrawcallCount : 0.0,
+            statsConfig ? (double)statsConfig->frameTriangleCount : 0.0
+        });
+
+        static const int TASK_TIME_DEPTH = 2;
+        if (auto mainViewConfig = engineConfig->getJobConfig("RenderMainView")) {
+            recordTaskTimes("RenderMainView", mainViewConfig, TASK_TIME_DEPTH);
+        }
+
+        if (++_flythroughFrame >= _flythroughPath.getNumFrames()) {
+            finishFlythrough();
+        }
+    }
+
+    void finishFlythrough() {
+        _flythroughPhase = FLYTHROUGH_OFF;
+
+        QJsonObject info;
+        info["path"] = _flythroughPath.name;
+        info["scene"] = QFileInfo(_flythroughPath.scene).fileName();
+        info["mode"] = _flythroughMode;
+        info["frames"] = (int)_flythroughRecorder.getNumFrames();
+        info["frameStep"] = _flythroughPath.frameStep;
+        info["width"] = _size.width();
+        info["height"] = _size.height();
+        const auto& contextInfo = gl::ContextInfo::get();
+        info["glVendor"] = QString::fromStdString(contextInfo.vendor);
+        info["glRenderer"] = QString::fromStdString(contextInfo.renderer);
+        info["glVersion"] = QString::fromStdString(contextInfo.version);
+        info["date"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+        QJsonObject result = _flythroughRecorder.toJson(info);
+
+        QJsonObject summary = result["summary"].toObject();
+        qDebug().nospace() << "Flythrough " << _flythroughPath.name << ": cpu " << summary["cpu"].toObject()["mean"].toDouble()
+                           << " ms, render thread " << summary["renderThread"].toObject()["mean"].toDouble()
+                           << " ms, gpu " << summary["gpu"].toObject()["mean"].toDouble() << " ms per frame";
+
+        int exitCode = 0;
+        if (!_flythroughBaseline.isEmpty()) {
+            QFile baselineFile(_flythroughBaseline);
+            QJsonObject baseline;
+            if (baselineFile.open(QIODevice::ReadOnly)) {
+                baseline = QJsonDocument::fromJson(baselineFile.readAll()).object();
+            }
+            if (baseline.isEmpty()) {
+                qWarning() << "Cannot read the baseline" << _flythroughBaseline;
+                exitCode = 2;
+            } else {
+                QJsonObject baselineInfo = baseline["info"].toObject();
+                if (baselineInfo.value("path") != info.value("path") || baselineInfo.value("mode") != info.value("mode") ||
+                    baselineInfo.value("frames") != info.value("frames")) {
+                    qWarning() << "The baseline" << _flythroughBaseline << "was recorded with another path or mode";
+                }
+
+                QStringList regressions;
+                result["comparison"] = FlythroughRecorder::compare(result, baseline, _flythroughTolerance, regressions);
+                for (const auto& regression : regressions) {
+                    qWarning() << "Slower than the baseline:" << regression;
+                }
+                if (!regressions.empty()) {
+                    exitCode = 1;
+                }
+            }
+        }
+
+        QFile outputFile(_flythroughOutput);
+        if (outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            outputFile.write(QJsonDocument(result).toJson());
+            qDebug() << "Wrote the flythrough timings to" << QFileInfo(outputFile).absoluteFilePath();
+        } else {
+            qWarning() << "Cannot write the flythrough timings to" << _flythroughOutput;
+        }
+
+        QCoreApplication::exit(exitCode);
+    }
+
+    static bool parseMode(const QString& name, RenderMode& mode) {
+        QString lowerName = name.toLower();
+        if (lowerName == "normal") {
+            mode = NORMAL;
+        } else if (lowerName == "stereo") {
+            mode = STEREO;
+        } else if (lowerName == "hmd") {
+            mode = HMD;
+        } else {
+            return false;
+        }
+        return true;
+    }
+
+    void setMode(RenderMode mode) {
         static auto defaultProjection = SimpleCamera().matrices.perspective;
-        _renderMode = (RenderMode)((_renderMode + 1) % RENDER_MODE_COUNT);
+        _renderMode = mode;
         if (_renderMode == HMD) {
             _camera.matrices.perspective[0] = vec4{ 0.759056330, 0.000000000, 0.000000000, 0.000000000 };
             _camera.matrices.perspective[1] = vec4{ 0.000000000, 0.682773232, 0.000000000, 0.000000000 };
@@ -1008,17 +1324,41 @@ private:
     int _commandIndex{ -1 };
     uint64_t _nextCommandTime{ 0 };
 
+    static const int DEFAULT_BENCHMARK_SECONDS { 10 };
+    static const int BENCHMARK_WARMUP_SECONDS { 2 };
+
     //TextOverlay* _textOverlay;
     static bool _cullingEnabled;
 
-    enum RenderMode
+    RenderMode _renderMode{ NORMAL };
+
+    bool _benchmarkRunning{ false };
+    bool _benchmarkMeasuring{ false };
+    RenderMode _benchmarkMode{ NORMAL };
+    uint64_t _benchmarkWarmup{ 0 };
+    uint64_t _benchmarkDuration{ 0 };
+    uint64_t _benchmarkModeStart{ 0 };
+    uint64_t _benchmarkModeEnd{ 0 };
+    std::vector<float> _benchmarkResults;
+
+    enum FlythroughPhase
     {
-        NORMAL = 0,
-        STEREO,
-        HMD,
-        RENDER_MODE_COUNT
+        FLYTHROUGH_OFF = 0,
+        FLYTHROUGH_SETTLING,
+        FLYTHROUGH_WARMUP,
+        FLYTHROUGH_FLYING
     };
-    RenderMode _renderMode{ NORMAL };
+    FlythroughPhase _flythroughPhase{ FLYTHROUGH_OFF };
+    CameraPath _flythroughPath;
+    FlythroughRecorder _flythroughRecorder;
+    QString _flythroughMode;
+    QString _flythroughOutput;
+    QString _flythroughBaseline;
+    double _flythroughTolerance{ 0.0 };
+    uint64_t _flythroughSettleEnd{ 0 };
+    uint64_t _flythroughIdleSince{ 0 };
+    int _flythroughFrame{ 0 };
+
     QSharedPointer<EntityTreeRenderer> _octree;
 };
 
@@ -1034,10 +1374,37 @@ int main(int argc, char** argv) {
     QApplication app(argc, argv);
     logger.reset(new FileLogger());
 
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Renders a scene, or benchmarks flying a camera through one with --flythrough");
+    parser.addHelpOption();
+    const QCommandLineOption flythroughOption("flythrough", "Fly the camera path in <file> and record the frame timings.", "file");
+    const QCommandLineOption outputOption("output", "Write the flythrough timings to <file>.", "file");
+    const QCommandLineOption baselineOption("baseline", "Compare the flythrough timings with those in <file>.", "file");
+    const QCommandLineOption toleranceOption("tolerance", "How much slower than the baseline, in <percent>, a run may be.",
+                                             "percent", "10");
+    const QCommandLineOption modeOption("mode", "Fly in <mode>: normal, stereo or hmd.", "mode", "normal");
+    parser.addOptions({ flythroughOption, outputOption, baselineOption, toleranceOption, modeOption });
+    parser.process(app);
+
+    CameraPath flythroughPath;
+    if (parser.isSet(flythroughOption)) {
+        QString error;
+        if (!flythroughPath.read(parser.value(flythroughOption), error)) {
+            qWarning().noquote() << error;
+            return 2;
+        }
+    }
+
     QLoggingCategory::setFilterRules(LOG_FILTER_RULES);
     QTestWindow::setup();
     QTestWindow window;
     //window.loadCommands("C:/Users/bdavis/Git/dreaming/exports2/commands.txt");
-    app.exec();
-    return 0;
+    if (parser.isSet(flythroughOption)) {
+        double tolerance = parser.value(toleranceOption).toDouble() / 100.0;
+        if (!window.startFlythrough(flythroughPath, parser.value(modeOption), parser.value(outputOption),
+                                    parser.value(baselineOption), tolerance)) {
+            return 2;
+        }
+    }
+    return app.exec();
 }
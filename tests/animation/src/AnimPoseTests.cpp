@@ -0,0 +1,217 @@
+//
+//  AnimPoseTests.cpp
+//  tests/animation/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AnimPoseTests.h"
+
+#include <random>
+
+#include <glm/gtx/transform.hpp>
+
+#include <AnimSkeleton.h>
+#include <AnimUtil.h>
+#include <GLMHelpers.h>
+
+#include <test-utils/GLMTestUtils.h>
+#include <test-utils/QTestExtensions.h>
+
+QTEST_MAIN(AnimPoseTests)
+
+namespace {
+
+const float TEST_EPSILON = 0.0001f;
+const int NUM_TEST_POSES = 1000;
+
+void addJoint(std::vector<HFMJoint>& joints, const QString& name, int parentIndex, const glm::vec3& translation) {
+    HFMJoint joint;
+    joint.name = name;
+    joint.parentIndex = parentIndex;
+    joint.translation = translation;
+    joints.push_back(joint);
+}
+
+int addChain(std::vector<HFMJoint>& joints, const QString& prefix, int parentIndex, const glm::vec3& offset, int length) {
+    for (int i = 1; i <= length; i++) {
+        addJoint(joints, prefix + QString::number(i), parentIndex, offset);
+        parentIndex = (int)joints.size() - 1;
+    }
+    return parentIndex;
+}
+
+// the joints of the standard avatar skeleton, with five four-joint fingers on each hand
+AnimSkeleton::Pointer createStandardSkeleton() {
+    std::vector<HFMJoint> joints;
+    addJoint(joints, "Hips", -1, glm::vec3(0.0f, 1.0f, 0.0f));
+    addJoint(joints, "Spine", 0, glm::vec3(0.0f, 0.1f, 0.0f));
+    addJoint(joints, "Spine1", 1, glm::vec3(0.0f, 0.1f, 0.0f));
+    addJoint(joints, "Spine2", 2, glm::vec3(0.0f, 0.1f, 0.0f));
+    addJoint(joints, "Neck", 3, glm::vec3(0.0f, 0.2f, 0.0f));
+    addJoint(joints, "Head", 4, glm::vec3(0.0f, 0.1f, 0.0f));
+    addJoint(joints, "HeadTop_End", 5, glm::vec3(0.0f, 0.2f, 0.0f));
+    addJoint(joints, "LeftEye", 5, glm::vec3(0.03f, 0.1f, 0.1f));
+    addJoint(joints, "RightEye", 5, glm::vec3(-0.03f, 0.1f, 0.1f));
+
+    const int SPINE2_INDEX = 3;
+    for (const QString& side : { QString("Left"), QString("Right") }) {
+        float sign = side == "Left" ? 1.0f : -1.0f;
+        addJoint(joints, side + "Shoulder", SPINE2_INDEX, glm::vec3(sign * 0.05f, 0.15f, 0.0f));
+        addJoint(joints, side + "Arm", (int)joints.size() - 1, glm::vec3(sign * 0.1f, 0.0f, 0.0f));
+        addJoint(joints, side + "ForeArm", (int)joints.size() - 1, glm::vec3(sign * 0.25f, 0.0f, 0.0f));
+        addJoint(joints, side + "Hand", (int)joints.size() - 1, glm::vec3(sign * 0.25f, 0.0f, 0.0f));
+        int handIndex = (int)joints.size() - 1;
+        float fingerZ = 0.04f;
+        for (const QString& finger : { QString("Thumb"), QString("Index"), QString("Middle"), QString("Ring"), QString("Pinky") }) {
+            addJoint(joints, side + "Hand" + finger + "1", handIndex, glm::vec3(sign * 0.05f, 0.0f, fingerZ));
+            addChain(joints, side + "Hand" + finger + "_", (int)joints.size() - 1, glm::vec3(sign * 0.02f, 0.0f, 0.0f), 3);
+            fingerZ -= 0.02f;
+        }
+
+        addJoint(joints, side + "UpLeg", 0, glm::vec3(sign * 0.1f, 0.0f, 0.0f));
+        addJoint(joints, side + "Leg", (int)joints.size() - 1, glm::vec3(0.0f, -0.45f, 0.0f));
+        addJoint(joints, side + "Foot", (int)joints.size() - 1, glm::vec3(0.0f, -0.45f, 0.0f));
+        addJoint(joints, side + "ToeBase", (int)joints.size() - 1, glm::vec3(0.0f, -0.05f, 0.1f));
+        addJoint(joints, side + "Toe_End", (int)joints.size() - 1, glm::vec3(0.0f, 0.0f, 0.05f));
+    }
+    return std::make_shared<AnimSkeleton>(joints, QMap<int, glm::quat>());
+}
+
+glm::quat randomRotation(std::mt19937& generator) {
+    std::uniform_real_distribution<float> component(-1.0f, 1.0f);
+    return glm::normalize(glm::quat(component(generator), component(generator), component(generator), component(generator)));
+}
+
+// poses like the anim graph's, with the odd one scaled unevenly
+AnimPoseVec createPoses(std::mt19937& generator, int numPoses) {
+    std::uniform_real_distribution<float> translation(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> scale(0.5f, 2.0f);
+    AnimPoseVec poses;
+    for (int i = 0; i < numPoses; i++) {
+        glm::vec3 poseScale = (i % 10 == 0) ? glm::vec3(scale(generator), scale(generator), scale(generator)) : glm::vec3(scale(generator));
+        poses.push_back(AnimPose(poseScale, randomRotation(generator),
+                                 glm::vec3(translation(generator), translation(generator), translation(generator))));
+    }
+    return poses;
+}
+
+AnimPoseVec createSkeletonPoses(const AnimSkeleton::Pointer& skeleton) {
+    std::mt19937 generator(1234);
+    AnimPoseVec poses = skeleton->getRelativeDefaultPoses();
+    for (auto& pose : poses) {
+        pose.rot() = glm::normalize(pose.rot() * glm::angleAxis(0.5f, glm::normalize(glm::vec3(randomRotation(generator) * Vectors::UNIT_X))));
+    }
+    return poses;
+}
+
+}
+
+void AnimPoseTests::testBlend() {
+    std::mt19937 generator(1234);
+    AnimPoseVec a = createPoses(generator, NUM_TEST_POSES);
+    AnimPoseVec b = createPoses(generator, NUM_TEST_POSES);
+
+    for (float alpha : { 0.0f, 0.25f, 0.5f, 1.0f }) {
+        AnimPoseVec result(a.size());
+        ::blend(a.size(), &a[0], &b[0], alpha, &result[0]);
+        for (size_t i = 0; i < a.size(); i++) {
+            QCOMPARE_WITH_ABS_ERROR(result[i].scale(), lerp(a[i].scale(), b[i].scale(), alpha), TEST_EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result[i].rot(), safeLerp(a[i].rot(), b[i].rot(), alpha), TEST_EPSILON);
+            QCOMPARE_WITH_ABS_ERROR(result[i].trans(), lerp(a[i].trans(), b[i].trans(), alpha), TEST_EPSILON);
+        }
+    }
+
+    // blending in place, as AnimOverlay does
+    AnimPoseVec expected(a.size());
+    ::blend(a.size(), &a[0], &b[0], 0.5f, &expected[0]);
+    ::blend(a.size(), &a[0], &b[0], 0.5f, &a[0]);
+    for (size_t i = 0; i < a.size(); i++) {
+        QCOMPARE_WITH_ABS_ERROR((glm::mat4)a[i], (glm::mat4)expected[i], TEST_EPSILON);
+    }
+}
+
+void AnimPoseTests::testMultiply() {
+    std::mt19937 generator(5678);
+    AnimPoseVec a = createPoses(generator, NUM_TEST_POSES);
+    AnimPoseVec b = createPoses(generator, NUM_TEST_POSES);
+    // mirrored poses go through the matrices
+    a[1].scale() = glm::vec3(-1.0f, 1.0f, 1.0f);
+    b[2].scale() = glm::vec3(1.0f, -1.0f, 1.0f);
+
+    for (size_t i = 0; i < a.size(); i++) {
+        glm::mat4 expected = (glm::mat4)a[i] * (glm::mat4)b[i];
+        QCOMPARE_WITH_ABS_ERROR((glm::mat4)(a[i] * b[i]), expected, TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR(a[i] * b[i].trans(), glm::vec3(expected[3]), TEST_EPSILON);
+    }
+}
+
+void AnimPoseTests::testInverse() {
+    std::mt19937 generator(9012);
+    AnimPoseVec poses = createPoses(generator, NUM_TEST_POSES);
+    for (const auto& pose : poses) {
+        QCOMPARE_WITH_ABS_ERROR((glm::mat4)pose.inverse(), glm::inverse((glm::mat4)pose), TEST_EPSILON);
+        QCOMPARE_WITH_ABS_ERROR((glm::mat4)(pose * pose.inverse()), glm::mat4(), TEST_EPSILON);
+    }
+}
+
+void AnimPoseTests::testRelativeToAbsolute() {
+    auto skeleton = createStandardSkeleton();
+    AnimPoseVec relativePoses = createSkeletonPoses(skeleton);
+
+    AnimPoseVec absolutePoses = relativePoses;
+    skeleton->convertRelativePosesToAbsolute(absolutePoses);
+    for (int i = 0; i < skeleton->getNumJoints(); i++) {
+        glm::mat4 expected = relativePoses[i];
+        for (int parent = skeleton->getParentIndex(i); parent >= 0; parent = skeleton->getParentIndex(parent)) {
+            expected = (glm::mat4)relativePoses[parent] * expected;
+        }
+        QCOMPARE_WITH_ABS_ERROR((glm::mat4)absolutePoses[i], expected, TEST_EPSILON);
+    }
+
+    skeleton->convertAbsolutePosesToRelative(absolutePoses);
+    for (int i = 0; i < skeleton->getNumJoints(); i++) {
+        QCOMPARE_WITH_ABS_ERROR((glm::mat4)absolutePoses[i], (glm::mat4)relativePoses[i], TEST_EPSILON);
+    }
+}
+
+void AnimPoseTests::benchmarkBlend() {
+    auto skeleton = createStandardSkeleton();
+    AnimPoseVec a = createSkeletonPoses(skeleton);
+    AnimPoseVec b = skeleton->getRelativeDefaultPoses();
+    AnimPoseVec result(a.size());
+    QBENCHMARK {
+        ::blend(a.size(), &a[0], &b[0], 0.3f, &result[0]);
+    }
+}
+
+void AnimPoseTests::benchmarkRelativeToAbsolute() {
+    auto skeleton = createStandardSkeleton();
+    AnimPoseVec relativePoses = createSkeletonPoses(skeleton);
+    AnimPoseVec absolutePoses;
+    QBENCHMARK {
+        absolutePoses = relativePoses;
+        skeleton->convertRelativePosesToAbsolute(absolutePoses);
+    }
+}
+
+void AnimPoseTests::benchmarkMatrixPalette() {
+    // the cluster matrices of a skinned mesh with a cluster per joint, as Model::updateClusterMatrices() builds them
+    auto skeleton = createStandardSkeleton();
+    AnimPoseVec absolutePoses = createSkeletonPoses(skeleton);
+    skeleton->convertRelativePosesToAbsolute(absolutePoses);
+    std::vector<glm::mat4> inverseBindMatrices;
+    for (const auto& pose : skeleton->getAbsoluteDefaultPoses()) {
+        inverseBindMatrices.push_back(glm::inverse((glm::mat4)pose));
+    }
+    std::vector<glm::mat4> clusterMatrices(absolutePoses.size());
+    QBENCHMARK {
+        for (size_t i = 0; i < absolutePoses.size(); i++) {
+            glm_mat4u_mul((glm::mat4)absolutePoses[i], inverseBindMatrices[i], clusterMatrices[i]);
+        }
+    }
+}
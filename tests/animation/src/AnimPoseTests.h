@@ -0,0 +1,31 @@
+//
+//  AnimPoseTests.h
+//  tests/animation/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AnimPoseTests_h
+#define hifi_AnimPoseTests_h
+
+#include <QtTest/QtTest>
+
+class AnimPoseTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testBlend();
+    void testMultiply();
+    void testInverse();
+    void testRelativeToAbsolute();
+
+    void benchmarkBlend();
+    void benchmarkRelativeToAbsolute();
+    void benchmarkMatrixPalette();
+};
+
+#endif // hifi_AnimPoseTests_h
@@ -10,6 +10,7 @@
 #include "AnimTests.h"
 #include <AnimNodeLoader.h>
 #include <AnimClip.h>
+#include <AnimClipData.h>
 #include <AnimBlendLinear.h>
 #include <AnimationLogging.h>
 #include <AnimVariant.h>
@@ -479,6 +480,57 @@ void AnimTests::testAnimPose() {
     QCOMPARE_WITH_ABS_ERROR(p.scale(), resultScale, TEST_EPSILON2);
 }
 
+void AnimTests::testClipData() {
+    // a still joint, a turning one, one moving a little and one moving far
+    const int NUM_FRAMES = 60;
+    std::vector<AnimPoseVec> frames;
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        AnimPoseVec poses;
+        poses.push_back(AnimPose(glm::vec3(1.0f), glm::quat(), glm::vec3(0.0f, 1.0f, 0.0f)));
+        poses.push_back(AnimPose(glm::angleAxis(0.05f * i, glm::vec3(0.0f, 1.0f, 0.0f)), glm::vec3(0.0f, 0.5f, 0.0f)));
+        poses.push_back(AnimPose(glm::quat(), glm::vec3(0.01f * i, 0.0f, 0.0f)));
+        poses.push_back(AnimPose(glm::quat(), glm::vec3(100.0f * i, 0.0f, -0.5f)));
+        frames.push_back(poses);
+    }
+
+    const float METERS_PER_UNIT = 1.0f;
+    AnimClipData clipData(frames, METERS_PER_UNIT);
+    QCOMPARE(clipData.getNumFrames(), NUM_FRAMES);
+    QCOMPARE(clipData.getNumJoints(), 4);
+    QVERIFY(clipData.getCompressedSize() < clipData.getUncompressedSize());
+
+    std::vector<AnimPoseVec> decompressed = clipData.decompressAll();
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        for (int j = 0; j < clipData.getNumJoints(); j++) {
+            const AnimPose& pose = decompressed[i][j];
+            glm::quat expectedRot = frames[i][j].rot();
+            if (glm::dot(pose.rot(), expectedRot) < 0.0f) {
+                expectedRot = -expectedRot;
+            }
+            QCOMPARE_WITH_ABS_ERROR(pose.rot(), expectedRot, AnimClipData::ROTATION_TOLERANCE);
+            QCOMPARE_WITH_ABS_ERROR(pose.trans(), frames[i][j].trans(), AnimClipData::TRANSLATION_TOLERANCE);
+            QCOMPARE_WITH_ABS_ERROR(pose.scale(), frames[i][j].scale(), AnimClipData::SCALE_TOLERANCE);
+        }
+    }
+
+    // clips with the same key share their data for as long as someone holds it
+    int numCreated = 0;
+    auto create = [&] {
+        numCreated++;
+        return std::make_shared<const AnimClipData>(frames, METERS_PER_UNIT);
+    };
+    const QString KEY = "testClipData";
+    AnimClipData::ConstPointer first = AnimClipData::fetch(KEY, create);
+    AnimClipData::ConstPointer second = AnimClipData::fetch(KEY, create);
+    QVERIFY(first == second);
+    QCOMPARE(numCreated, 1);
+
+    first.reset();
+    second.reset();
+    AnimClipData::fetch(KEY, create);
+    QCOMPARE(numCreated, 2);
+}
+
 void AnimTests::testExpressionTokenizer() {
     QString str = "(10 +  x) >= 20.1 && (y != !z)";
     AnimExpression e("x");
@@ -27,6 +27,7 @@ private slots:
     void testVariant();
     void testAccumulateTime();
     void testAnimPose();
+    void testClipData();
     void testExpressionTokenizer();
     void testExpressionParser();
     void testExpressionEvaluator();
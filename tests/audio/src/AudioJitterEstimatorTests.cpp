@@ -0,0 +1,70 @@
+//
+//  AudioJitterEstimatorTests.cpp
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioJitterEstimatorTests.h"
+
+#include <AudioConstants.h>
+#include <AudioJitterEstimator.h>
+
+QTEST_MAIN(AudioJitterEstimatorTests)
+
+static const quint64 FRAME_USECS = AudioConstants::NETWORK_FRAME_USECS;
+
+void AudioJitterEstimatorTests::testNoHistory() {
+    AudioJitterEstimator estimator;
+    QCOMPARE(estimator.getTargetFrames(0.95f), 0);
+
+    estimator.update(3 * FRAME_USECS);
+    estimator.reset();
+    QCOMPARE(estimator.getTargetFrames(0.95f), 0);
+}
+
+void AudioJitterEstimatorTests::testSteadyArrivals() {
+    AudioJitterEstimator estimator;
+    for (int i = 0; i < 1000; i++) {
+        // slightly early and slightly late packets both round to a single frame
+        estimator.update(FRAME_USECS - 200);
+        estimator.update(FRAME_USECS);
+    }
+    QCOMPARE(estimator.getTargetFrames(0.5f), 1);
+    QCOMPARE(estimator.getTargetFrames(0.95f), 1);
+    QCOMPARE(estimator.getTargetFrames(1.0f), 1);
+}
+
+void AudioJitterEstimatorTests::testPercentiles() {
+    AudioJitterEstimator estimator;
+    for (int i = 0; i < 1000; i++) {
+        // one packet in a hundred arrives after a 4 frame gap, one in ten after a 2 frame gap
+        quint64 gap = (i % 100 == 0) ? 4 * FRAME_USECS : (i % 10 == 0) ? 2 * FRAME_USECS : FRAME_USECS;
+        estimator.update(gap);
+    }
+    QCOMPARE(estimator.getTargetFrames(0.5f), 1);
+    QCOMPARE(estimator.getTargetFrames(0.95f), 2);
+    QCOMPARE(estimator.getTargetFrames(1.0f), 4);
+
+    // gaps beyond the histogram are counted in its last bucket
+    estimator.update(1000 * FRAME_USECS);
+    QCOMPARE(estimator.getTargetFrames(1.0f), AudioJitterEstimator::MAX_DELAY_FRAMES - 1);
+}
+
+void AudioJitterEstimatorTests::testForgetting() {
+    AudioJitterEstimator estimator;
+    for (int i = 0; i < 1000; i++) {
+        estimator.update(3 * FRAME_USECS);
+    }
+    QCOMPARE(estimator.getTargetFrames(0.95f), 3);
+
+    // after a minute of steady arrivals the burst of jitter no longer sets the target
+    for (int i = 0; i < 6000; i++) {
+        estimator.update(FRAME_USECS);
+    }
+    QCOMPARE(estimator.getTargetFrames(0.95f), 1);
+}
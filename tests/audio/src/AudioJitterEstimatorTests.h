@@ -0,0 +1,27 @@
+//
+//  AudioJitterEstimatorTests.h
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioJitterEstimatorTests_h
+#define hifi_AudioJitterEstimatorTests_h
+
+#include <QtTest/QtTest>
+
+class AudioJitterEstimatorTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testNoHistory();
+    void testSteadyArrivals();
+    void testPercentiles();
+    void testForgetting();
+};
+
+#endif // hifi_AudioJitterEstimatorTests_h
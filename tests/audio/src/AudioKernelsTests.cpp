@@ -0,0 +1,200 @@
+//
+//  AudioKernelsTests.cpp
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioKernelsTests.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include <AudioKernels.h>
+#include <CPUDetect.h>
+
+QTEST_MAIN(AudioKernelsTests)
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define HAS_AVX2_KERNELS
+#endif
+
+static const int NUM_FRAMES = 4099;  // not a multiple of the SIMD width, to cover the scalar tail
+static const int NUM_BENCHMARK_FRAMES = 240;
+static const int32_t THRESHOLD = 0x41000000;
+
+static std::vector<float> randomSamples(int numSamples, float amplitude) {
+    static std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(-amplitude, amplitude);
+
+    std::vector<float> samples(numSamples);
+    for (auto& sample : samples) {
+        sample = distribution(generator);
+    }
+    return samples;
+}
+
+void AudioKernelsTests::initTestCase() {
+#ifdef HAS_AVX2_KERNELS
+    _hasAVX2 = cpuSupportsAVX2();
+#endif
+}
+
+void AudioKernelsTests::testLimiterPeak() {
+    if (!_hasAVX2) {
+        QSKIP("AVX2 is not supported");
+    }
+#ifdef HAS_AVX2_KERNELS
+    for (int numChannels : { 1, 2, 4 }) {
+        auto input = randomSamples(numChannels * NUM_FRAMES, 4.0f);
+
+        // include silence, denormals and values beyond the limiter headroom
+        input[1] = 0.0f;
+        input[3] = -0.0f;
+        input[5] = 1e-30f;
+        input[7] = -1e30f;
+
+        std::vector<int32_t> expected(NUM_FRAMES);
+        std::vector<int32_t> actual(NUM_FRAMES);
+
+        limiterPeak_ref(input.data(), expected.data(), THRESHOLD, numChannels, NUM_FRAMES);
+        limiterPeak_AVX2(input.data(), actual.data(), THRESHOLD, numChannels, NUM_FRAMES);
+
+        // integer kernels must be bit exact
+        QCOMPARE(actual, expected);
+    }
+#endif
+}
+
+void AudioKernelsTests::testLimiterOutput() {
+    if (!_hasAVX2) {
+        QSKIP("AVX2 is not supported");
+    }
+#ifdef HAS_AVX2_KERNELS
+    for (int numChannels : { 1, 2, 4 }) {
+        // the limiter never drives its output past 16 bits
+        auto input = randomSamples(numChannels * NUM_FRAMES, 1.0f);
+        auto gain = randomSamples(NUM_FRAMES, 32000.0f);
+        auto dither = randomSamples(NUM_FRAMES, 1.0f);
+        for (auto& g : gain) {
+            g = fabsf(g);
+        }
+
+        std::vector<int16_t> expected(numChannels * NUM_FRAMES);
+        std::vector<int16_t> actual(numChannels * NUM_FRAMES);
+
+        limiterOutput_ref(input.data(), gain.data(), dither.data(), expected.data(), numChannels, NUM_FRAMES);
+        limiterOutput_AVX2(input.data(), gain.data(), dither.data(), actual.data(), numChannels, NUM_FRAMES);
+
+        // a fused multiply-add may round differently, by at most one LSB
+        for (int i = 0; i < numChannels * NUM_FRAMES; i++) {
+            QVERIFY2(abs(actual[i] - expected[i]) <= 1, qPrintable(QString("sample %1: %2 != %3")
+                     .arg(i).arg(actual[i]).arg(expected[i])));
+        }
+    }
+#endif
+}
+
+void AudioKernelsTests::testReverbMix() {
+    if (!_hasAVX2) {
+        QSKIP("AVX2 is not supported");
+    }
+#ifdef HAS_AVX2_KERNELS
+    auto dry = randomSamples(NUM_FRAMES, 1.0f);
+    auto wet = randomSamples(NUM_FRAMES, 0.5f);
+
+    std::vector<float> expected(NUM_FRAMES);
+    std::vector<float> actual = dry;
+
+    reverbMix_ref(dry.data(), wet.data(), expected.data(), 0.3f, NUM_FRAMES);
+    reverbMix_AVX2(actual.data(), wet.data(), actual.data(), 0.3f, NUM_FRAMES);    // in-place
+
+    for (int i = 0; i < NUM_FRAMES; i++) {
+        QVERIFY(fabsf(actual[i] - expected[i]) <= 1e-6f);
+    }
+#endif
+}
+
+// benchmarks run for the reference and SIMD kernels on one network frame, for comparison with -tickcounter
+static void addKernelRows(bool hasAVX2) {
+    QTest::addColumn<bool>("simd");
+    QTest::newRow("reference") << false;
+    if (hasAVX2) {
+        QTest::newRow("avx2") << true;
+    }
+}
+
+void AudioKernelsTests::benchmarkLimiterPeak_data() {
+    addKernelRows(_hasAVX2);
+}
+
+void AudioKernelsTests::benchmarkLimiterPeak() {
+    QFETCH(bool, simd);
+
+    auto input = randomSamples(2 * NUM_BENCHMARK_FRAMES, 4.0f);
+    std::vector<int32_t> attn(NUM_BENCHMARK_FRAMES);
+
+    auto kernel = limiterPeak_ref;
+#ifdef HAS_AVX2_KERNELS
+    if (simd) {
+        kernel = limiterPeak_AVX2;
+    }
+#endif
+
+    QBENCHMARK {
+        kernel(input.data(), attn.data(), THRESHOLD, 2, NUM_BENCHMARK_FRAMES);
+    }
+}
+
+void AudioKernelsTests::benchmarkLimiterOutput_data() {
+    addKernelRows(_hasAVX2);
+}
+
+void AudioKernelsTests::benchmarkLimiterOutput() {
+    QFETCH(bool, simd);
+
+    auto input = randomSamples(2 * NUM_BENCHMARK_FRAMES, 1.0f);
+    auto gain = randomSamples(NUM_BENCHMARK_FRAMES, 1.0f);
+    auto dither = randomSamples(NUM_BENCHMARK_FRAMES, 1.0f);
+    std::vector<int16_t> output(2 * NUM_BENCHMARK_FRAMES);
+
+    auto kernel = limiterOutput_ref;
+#ifdef HAS_AVX2_KERNELS
+    if (simd) {
+        kernel = limiterOutput_AVX2;
+    }
+#endif
+
+    QBENCHMARK {
+        kernel(input.data(), gain.data(), dither.data(), output.data(), 2, NUM_BENCHMARK_FRAMES);
+    }
+}
+
+void AudioKernelsTests::benchmarkReverbMix_data() {
+    addKernelRows(_hasAVX2);
+}
+
+void AudioKernelsTests::benchmarkReverbMix() {
+    QFETCH(bool, simd);
+
+    auto dry = randomSamples(NUM_BENCHMARK_FRAMES, 1.0f);
+    auto wet = randomSamples(NUM_BENCHMARK_FRAMES, 1.0f);
+    std::vector<float> output(NUM_BENCHMARK_FRAMES);
+
+    auto kernel = reverbMix_ref;
+#ifdef HAS_AVX2_KERNELS
+    if (simd) {
+        kernel = reverbMix_AVX2;
+    }
+#endif
+
+    QBENCHMARK {
+        kernel(dry.data(), wet.data(), output.data(), 0.5f, NUM_BENCHMARK_FRAMES);
+    }
+}
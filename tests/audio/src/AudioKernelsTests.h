@@ -0,0 +1,38 @@
+//
+//  AudioKernelsTests.h
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioKernelsTests_h
+#define hifi_AudioKernelsTests_h
+
+#include <QtTest/QtTest>
+
+class AudioKernelsTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void testLimiterPeak();
+    void testLimiterOutput();
+    void testReverbMix();
+
+    void benchmarkLimiterPeak_data();
+    void benchmarkLimiterPeak();
+    void benchmarkLimiterOutput_data();
+    void benchmarkLimiterOutput();
+    void benchmarkReverbMix_data();
+    void benchmarkReverbMix();
+
+private:
+    bool _hasAVX2 { false };
+};
+
+#endif // hifi_AudioKernelsTests_h
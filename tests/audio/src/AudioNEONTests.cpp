@@ -0,0 +1,240 @@
+//
+//  AudioNEONTests.cpp
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioNEONTests.h"
+
+#include <random>
+#include <vector>
+
+#include <AudioFOA.h>
+#include <AudioHRTF.h>
+
+QTEST_MAIN(AudioNEONTests)
+
+#if defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define HAS_NEON_KERNELS
+
+// kernels are internal to AudioHRTF.cpp and AudioFOA.cpp
+void FIR_1x4_ref(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void FIR_1x4_NEON(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void interleave_4x4_ref(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames);
+void interleave_4x4_NEON(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames);
+void biquad2_4x4_ref(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames);
+void biquad2_4x4_NEON(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames);
+void crossfade_4x2_ref(float* src, float* dst, const float* win, int numFrames);
+void crossfade_4x2_NEON(float* src, float* dst, const float* win, int numFrames);
+void interpolate_ref(const float* src0, const float* src1, float* dst, float frac, float gain);
+void interpolate_NEON(const float* src0, const float* src1, float* dst, float frac, float gain);
+
+void rfft512_cmadd_1X2_ref(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]);
+void rfft512_cmadd_1X2_NEON(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]);
+void convertInput_ref(int16_t* src, float *dst[4], float gain, int numFrames);
+void convertInput_NEON(int16_t* src, float *dst[4], float gain, int numFrames);
+void rotate_4x4_ref(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames);
+void rotate_4x4_NEON(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames);
+#endif
+
+#define SKIP_WITHOUT_NEON() \
+    do { \
+        if (!HAS_NEON) { \
+            QSKIP("NEON is not supported"); \
+        } \
+    } while (0)
+
+#ifdef HAS_NEON_KERNELS
+static const bool HAS_NEON = true;
+#else
+static const bool HAS_NEON = false;
+#endif
+
+static const int NUM_FRAMES = HRTF_BLOCK;
+
+static std::mt19937 generator(42);
+
+static void fillRandom(float* samples, int numSamples, float amplitude = 1.0f) {
+    std::uniform_real_distribution<float> distribution(-amplitude, amplitude);
+    for (int i = 0; i < numSamples; i++) {
+        samples[i] = distribution(generator);
+    }
+}
+
+// the kernels must match the reference exactly, not just closely
+static bool isBitExact(const float* actual, const float* expected, int numSamples) {
+    return memcmp(actual, expected, numSamples * sizeof(float)) == 0;
+}
+
+void AudioNEONTests::testHRTFFilter() {
+    SKIP_WITHOUT_NEON();
+#ifdef HAS_NEON_KERNELS
+    std::vector<float> src(HRTF_TAPS + NUM_FRAMES);
+    float coef[4][HRTF_TAPS];
+    float expected[4][NUM_FRAMES];
+    float actual[4][NUM_FRAMES];
+
+    fillRandom(src.data(), (int)src.size());
+    fillRandom(&coef[0][0], 4 * HRTF_TAPS);
+
+    // the filter reads HRTF_TAPS - 1 samples of history before src
+    float* input = &src[HRTF_TAPS];
+    FIR_1x4_ref(input, expected[0], expected[1], expected[2], expected[3], coef, NUM_FRAMES);
+    FIR_1x4_NEON(input, actual[0], actual[1], actual[2], actual[3], coef, NUM_FRAMES);
+
+    QVERIFY(isBitExact(&actual[0][0], &expected[0][0], 4 * NUM_FRAMES));
+#endif
+}
+
+void AudioNEONTests::testHRTFInterleave() {
+    SKIP_WITHOUT_NEON();
+#ifdef HAS_NEON_KERNELS
+    float src[4][NUM_FRAMES];
+    float expected[4 * NUM_FRAMES];
+    float actual[4 * NUM_FRAMES];
+
+    fillRandom(&src[0][0], 4 * NUM_FRAMES);
+
+    interleave_4x4_ref(src[0], src[1], src[2], src[3], expected, NUM_FRAMES);
+    interleave_4x4_NEON(src[0], src[1], src[2], src[3], actual, NUM_FRAMES);
+
+    QVERIFY(isBitExact(actual, expected, 4 * NUM_FRAMES));
+#endif
+}
+
+void AudioNEONTests::testHRTFBiquad() {
+    SKIP_WITHOUT_NEON();
+#ifdef HAS_NEON_KERNELS
+    float src[4 * NUM_FRAMES];
+    float coef[5][8];
+    float expectedState[3][8];
+    float actualState[3][8];
+    float expected[4 * NUM_FRAMES];
+    float actual[4 * NUM_FRAMES];
+
+    fillRandom(src, 4 * NUM_FRAMES);
+    fillRandom(&coef[0][0], 5 * 8, 0.3f);   // keep the filters stable
+    fillRandom(&expectedState[0][0], 3 * 8);
+    memcpy(actualState, expectedState, sizeof(actualState));
+
+    // run two blocks, to check that the state carries over
+    for (int block = 0; block < 2; block++) {
+        biquad2_4x4_ref(src, expected, coef, expectedState, NUM_FRAMES);
+        biquad2_4x4_NEON(src, actual, coef, actualState, NUM_FRAMES);
+
+        QVERIFY(isBitExact(actual, expected, 4 * NUM_FRAMES));
+    }
+
+    // the output of the second biquad is not part of the state
+    QVERIFY(isBitExact(&actualState[0][0], &expectedState[0][0], 4));
+    QVERIFY(isBitExact(&actualState[1][0], &expectedState[1][0], 2 * 8));
+#endif
+}
+
+void AudioNEONTests::testHRTFCrossfade() {
+    SKIP_WITHOUT_NEON();
+#ifdef HAS_NEON_KERNELS
+    float src[4 * NUM_FRAMES];
+    float win[NUM_FRAMES];
+    float expected[2 * NUM_FRAMES];
+    float actual[2 * NUM_FRAMES];
+
+    fillRandom(src, 4 * NUM_FRAMES);
+    fillRandom(win, NUM_FRAMES);
+    fillRandom(expected, 2 * NUM_FRAMES);
+    memcpy(actual, expected, sizeof(actual));
+
+    crossfade_4x2_ref(src, expected, win, NUM_FRAMES);
+    crossfade_4x2_NEON(src, actual, win, NUM_FRAMES);
+
+    QVERIFY(isBitExact(actual, expected, 2 * NUM_FRAMES));
+#endif
+}
+
+void AudioNEONTests::testHRTFInterpolate() {
+    SKIP_WITHOUT_NEON();
+#ifdef HAS_NEON_KERNELS
+    float src[2][HRTF_TAPS];
+    float expected[HRTF_TAPS];
+    float actual[HRTF_TAPS];
+
+    fillRandom(&src[0][0], 2 * HRTF_TAPS);
+
+    interpolate_ref(src[0], src[1], expected, 0.3f, 0.7f);
+    interpolate_NEON(src[0], src[1], actual, 0.3f, 0.7f);
+
+    QVERIFY(isBitExact(actual, expected, HRTF_TAPS));
+#endif
+}
+
+void AudioNEONTests::testFOAMultiplyAdd() {
+    SKIP_WITHOUT_NEON();
+#ifdef HAS_NEON_KERNELS
+    float src[FOA_NFFT];
+    float coef[2][FOA_NFFT];
+    float expected[2][FOA_NFFT];
+    float actual[2][FOA_NFFT];
+
+    fillRandom(src, FOA_NFFT);
+    fillRandom(&coef[0][0], 2 * FOA_NFFT);
+    fillRandom(&expected[0][0], 2 * FOA_NFFT);
+    memcpy(actual, expected, sizeof(actual));
+
+    rfft512_cmadd_1X2_ref(src, coef[0], coef[1], expected[0], expected[1]);
+    rfft512_cmadd_1X2_NEON(src, coef[0], coef[1], actual[0], actual[1]);
+
+    QVERIFY(isBitExact(&actual[0][0], &expected[0][0], 2 * FOA_NFFT));
+#endif
+}
+
+void AudioNEONTests::testFOAConvertInput() {
+    SKIP_WITHOUT_NEON();
+#ifdef HAS_NEON_KERNELS
+    int16_t src[4 * FOA_BLOCK];
+    float expected[4][FOA_BLOCK];
+    float actual[4][FOA_BLOCK];
+
+    std::uniform_int_distribution<int> distribution(INT16_MIN, INT16_MAX);
+    for (auto& sample : src) {
+        sample = (int16_t)distribution(generator);
+    }
+
+    float* expectedChannels[4] = { expected[0], expected[1], expected[2], expected[3] };
+    float* actualChannels[4] = { actual[0], actual[1], actual[2], actual[3] };
+
+    convertInput_ref(src, expectedChannels, 0.8f, FOA_BLOCK);
+    convertInput_NEON(src, actualChannels, 0.8f, FOA_BLOCK);
+
+    QVERIFY(isBitExact(&actual[0][0], &expected[0][0], 4 * FOA_BLOCK));
+#endif
+}
+
+void AudioNEONTests::testFOARotate() {
+    SKIP_WITHOUT_NEON();
+#ifdef HAS_NEON_KERNELS
+    float m0[4][4];
+    float m1[4][4];
+    float win[FOA_BLOCK];
+    float expected[4][FOA_BLOCK];
+    float actual[4][FOA_BLOCK];
+
+    fillRandom(&m0[0][0], 16);
+    fillRandom(&m1[0][0], 16);
+    fillRandom(win, FOA_BLOCK);
+    fillRandom(&expected[0][0], 4 * FOA_BLOCK);
+    memcpy(actual, expected, sizeof(actual));
+
+    float* expectedChannels[4] = { expected[0], expected[1], expected[2], expected[3] };
+    float* actualChannels[4] = { actual[0], actual[1], actual[2], actual[3] };
+
+    rotate_4x4_ref(expectedChannels, m0, m1, win, FOA_BLOCK);
+    rotate_4x4_NEON(actualChannels, m0, m1, win, FOA_BLOCK);
+
+    QVERIFY(isBitExact(&actual[0][0], &expected[0][0], 4 * FOA_BLOCK));
+#endif
+}
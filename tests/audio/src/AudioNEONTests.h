@@ -0,0 +1,32 @@
+//
+//  AudioNEONTests.h
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AudioNEONTests_h
+#define hifi_AudioNEONTests_h
+
+#include <QtTest/QtTest>
+
+// compares the NEON kernels of AudioHRTF and AudioFOA with the scalar reference, on ARM builds only
+class AudioNEONTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testHRTFFilter();
+    void testHRTFInterleave();
+    void testHRTFBiquad();
+    void testHRTFCrossfade();
+    void testHRTFInterpolate();
+    void testFOAMultiplyAdd();
+    void testFOAConvertInput();
+    void testFOARotate();
+};
+
+#endif // hifi_AudioNEONTests_h
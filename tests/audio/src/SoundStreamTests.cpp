@@ -0,0 +1,119 @@
+//
+//  SoundStreamTests.cpp
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SoundStreamTests.h"
+
+#include <vector>
+
+#include <AudioConstants.h>
+#include <AudioInjectorLocalBuffer.h>
+#include <SoundStream.h>
+
+QTEST_MAIN(SoundStreamTests)
+
+using AudioConstants::AudioSample;
+
+// a ramp of numFrames frames, each channel offset from the one before, after a header of headerBytes bytes
+static QByteArray makeFile(int headerBytes, int numFrames, int numChannels) {
+    QByteArray file(headerBytes + numFrames * numChannels * (int)sizeof(AudioSample), '\0');
+    auto samples = reinterpret_cast<AudioSample*>(file.data() + headerBytes);
+    for (int i = 0; i < numFrames; i++) {
+        for (int j = 0; j < numChannels; j++) {
+            samples[i * numChannels + j] = (AudioSample)((i % 1000) + j * 1000);
+        }
+    }
+    return file;
+}
+
+static SoundSourcePointer makeSource(const QByteArray& file, int headerBytes, int numChannels, uint32_t sampleRate) {
+    int size = file.size() - headerBytes;
+    uint32_t numFrames = size / (numChannels * sizeof(AudioSample));
+    uint32_t numStreamedFrames = (uint32_t)((uint64_t)numFrames * AudioConstants::SAMPLE_RATE / sampleRate);
+    return SoundSource::make(SoundSource::PCM, file, headerBytes, size, numChannels, sampleRate, numStreamedFrames);
+}
+
+void SoundStreamTests::testReadWhole() {
+    const int NUM_FRAMES = 5000;
+    auto file = makeFile(44, NUM_FRAMES, 2);
+    SoundStream stream(makeSource(file, 44, 2, AudioConstants::SAMPLE_RATE));
+
+    // at the mixer's rate the samples come out as they are in the file, past its header
+    std::vector<AudioSample> samples(2 * NUM_FRAMES + 2);
+    QCOMPARE(stream.read(samples.data(), 333), 333);
+    QCOMPARE(stream.read(samples.data() + 2 * 333, NUM_FRAMES), NUM_FRAMES - 333);
+    QVERIFY(stream.atEnd());
+    QCOMPARE(stream.read(samples.data(), 1), 0);
+
+    auto expected = reinterpret_cast<const AudioSample*>(file.constData() + 44);
+    for (int i = 0; i < 2 * NUM_FRAMES; i++) {
+        QCOMPARE(samples[i], expected[i]);
+    }
+}
+
+void SoundStreamTests::testSkipAndRewind() {
+    const int NUM_FRAMES = 3000;
+    auto file = makeFile(0, NUM_FRAMES, 1);
+    SoundStream stream(makeSource(file, 0, 1, AudioConstants::SAMPLE_RATE));
+
+    AudioSample sample;
+    stream.skip(1500);
+    QCOMPARE(stream.read(&sample, 1), 1);
+    QCOMPARE(sample, (AudioSample)(1500 % 1000));
+
+    stream.rewind();
+    QVERIFY(!stream.atEnd());
+    QCOMPARE(stream.read(&sample, 1), 1);
+    QCOMPARE(sample, (AudioSample)0);
+}
+
+void SoundStreamTests::testResample() {
+    const int NUM_FRAMES = 48000;
+    auto file = makeFile(0, NUM_FRAMES, 2);
+    auto source = makeSource(file, 0, 2, 2 * AudioConstants::SAMPLE_RATE);
+    QCOMPARE(source->getNumFrames(), (uint32_t)(NUM_FRAMES / 2));
+
+    // read in network frames, as the injectors do
+    SoundStream stream(source);
+    std::vector<AudioSample> samples(2 * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    int numFrames = 0;
+    int framesRead;
+    while ((framesRead = stream.read(samples.data(), AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL)) > 0) {
+        numFrames += framesRead;
+    }
+
+    // halved, to within the resampler's delay
+    QVERIFY(numFrames <= NUM_FRAMES / 2 + 1);
+    QVERIFY(numFrames > NUM_FRAMES / 2 - 256);
+}
+
+void SoundStreamTests::testLocalBuffer() {
+    // several times what the buffer reads ahead, so it has to refill as it's read
+    const int NUM_FRAMES = 20 * AudioConstants::SAMPLE_RATE / 10;
+    auto file = makeFile(0, NUM_FRAMES, 1);
+    AudioInjectorLocalBuffer buffer(makeSource(file, 0, 1, AudioConstants::SAMPLE_RATE));
+    buffer.open(QIODevice::ReadOnly);
+
+    auto expected = reinterpret_cast<const AudioSample*>(file.constData());
+    std::vector<AudioSample> samples(AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    int numSamples = 0;
+    qint64 bytesRead;
+    while ((bytesRead = buffer.readData((char*)samples.data(), samples.size() * sizeof(AudioSample))) > 0) {
+        int samplesRead = (int)(bytesRead / sizeof(AudioSample));
+        for (int i = 0; i < samplesRead; i++) {
+            QCOMPARE(samples[i], expected[numSamples + i]);
+        }
+        numSamples += samplesRead;
+
+        // let the refill catch up, rather than read the silence of an underrun
+        QThreadPool::globalInstance()->waitForDone();
+    }
+    QCOMPARE(numSamples, NUM_FRAMES);
+}
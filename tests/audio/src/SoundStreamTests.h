@@ -0,0 +1,27 @@
+//
+//  SoundStreamTests.h
+//  tests/audio/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SoundStreamTests_h
+#define hifi_SoundStreamTests_h
+
+#include <QtTest/QtTest>
+
+class SoundStreamTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testReadWhole();
+    void testSkipAndRewind();
+    void testResample();
+    void testLocalBuffer();
+};
+
+#endif // hifi_SoundStreamTests_h
@@ -0,0 +1,125 @@
+//
+//  AvatarEntityTraitEncodingTests.cpp
+//  tests/avatars/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarEntityTraitEncodingTests.h"
+
+#include <AvatarEntityTraitEncoding.h>
+
+QTEST_MAIN(AvatarEntityTraitEncodingTests)
+
+using namespace AvatarTraits;
+
+// stands in for the properties of a wearable, most of which an avatar's entities have in common
+static QByteArray makeBlob(const QString& name, int seed) {
+    QByteArray blob;
+    blob.append("parentID={9f3c2e4a-1b7d-4c8e-a5f6-0d2b3c4e5f60};owningAvatarID={9f3c2e4a-1b7d-4c8e-a5f6-0d2b3c4e5f60};");
+    blob.append("type=Model;modelURL=https://content.example.com/wearables/");
+    blob.append(name.toUtf8());
+    blob.append(".fst;");
+    for (int i = 0; i < 64; ++i) {
+        blob.append((char)((seed * 31 + i * 7) & 0xff));
+    }
+    blob.append("collisionless=true;grab.grabbable=false;visible=true;renderLayer=world;");
+    return blob;
+}
+
+void AvatarEntityTraitEncodingTests::standaloneTest() {
+    QByteArray blob = makeBlob("hat", 1);
+    QByteArray encoded = encodeEntityBlob(blob);
+
+    EntityEncoding encoding;
+    EntityBlobHash neededHash;
+    QVERIFY(readEntityEncoding(encoded, encoding, neededHash));
+    QCOMPARE(encoding, DeflatedEntity);
+    QVERIFY(encoded.size() < blob.size());
+
+    QByteArray decoded;
+    QVERIFY(decodeEntityBlob(encoded, QByteArray(), decoded));
+    QCOMPARE(decoded, blob);
+
+    // what deflating doesn't make smaller goes as it is
+    QByteArray tiny("a");
+    encoded = encodeEntityBlob(tiny);
+    QVERIFY(readEntityEncoding(encoded, encoding, neededHash));
+    QCOMPARE(encoding, RawEntity);
+    QVERIFY(decodeEntityBlob(encoded, QByteArray(), decoded));
+    QCOMPARE(decoded, tiny);
+}
+
+void AvatarEntityTraitEncodingTests::fromBaseTest() {
+    QByteArray base = makeBlob("hat", 1);
+    QByteArray blob = makeBlob("scarf", 2);
+
+    QByteArray standalone = encodeEntityBlob(blob);
+    QByteArray fromBase = encodeEntityBlob(blob, base);
+
+    EntityEncoding encoding;
+    EntityBlobHash neededHash;
+    QVERIFY(readEntityEncoding(fromBase, encoding, neededHash));
+    QCOMPARE(encoding, DeflatedFromBaseEntity);
+    QCOMPARE(neededHash, hashEntityBlob(base));
+    QVERIFY(fromBase.size() < standalone.size());
+
+    QByteArray decoded;
+    QVERIFY(decodeEntityBlob(fromBase, base, decoded));
+    QCOMPARE(decoded, blob);
+
+    // it can't be decoded from any other blob
+    QVERIFY(!decodeEntityBlob(fromBase, makeBlob("boots", 3), decoded));
+    QVERIFY(!decodeEntityBlob(fromBase, QByteArray(), decoded));
+
+    // an edit of an entity sent from its previous properties is little more than the change
+    QByteArray edited = blob;
+    edited.replace("visible=true", "visible=goes");
+    QByteArray editEncoded = encodeEntityBlob(edited, blob);
+    QVERIFY(readEntityEncoding(editEncoded, encoding, neededHash));
+    QCOMPARE(encoding, DeflatedFromBaseEntity);
+    QVERIFY(editEncoded.size() < fromBase.size());
+    QVERIFY(decodeEntityBlob(editEncoded, blob, decoded));
+    QCOMPARE(decoded, edited);
+}
+
+void AvatarEntityTraitEncodingTests::referenceTest() {
+    QByteArray blob = makeBlob("hat", 1);
+    QByteArray encoded = encodeEntityReference(hashEntityBlob(blob));
+
+    EntityEncoding encoding;
+    EntityBlobHash neededHash;
+    QVERIFY(readEntityEncoding(encoded, encoding, neededHash));
+    QCOMPARE(encoding, ReferencedEntity);
+    QCOMPARE(neededHash, hashEntityBlob(blob));
+
+    QByteArray decoded;
+    QVERIFY(decodeEntityBlob(encoded, blob, decoded));
+    QCOMPARE(decoded, blob);
+    QVERIFY(!decodeEntityBlob(encoded, makeBlob("hat", 2), decoded));
+
+    QVERIFY(hashEntityBlob(blob) != hashEntityBlob(makeBlob("hat", 2)));
+}
+
+void AvatarEntityTraitEncodingTests::malformedTest() {
+    EntityEncoding encoding;
+    EntityBlobHash neededHash;
+    QByteArray decoded;
+
+    QVERIFY(!readEntityEncoding(QByteArray(), encoding, neededHash));
+    QVERIFY(!readEntityEncoding(QByteArray(1, (char)NumEntityEncodings), encoding, neededHash));
+    QVERIFY(!readEntityEncoding(QByteArray(1, (char)ReferencedEntity), encoding, neededHash));
+
+    // a stream cut short, or one that inflates to other than the size it says
+    QByteArray blob = makeBlob("hat", 1);
+    QByteArray encoded = encodeEntityBlob(blob);
+    QVERIFY(!decodeEntityBlob(encoded.left(encoded.size() - 4), QByteArray(), decoded));
+    QByteArray wrongSize = encoded;
+    wrongSize[1] = (char)(wrongSize[1] + 1);
+    QVERIFY(!decodeEntityBlob(wrongSize, QByteArray(), decoded));
+    QVERIFY(decoded.isEmpty());
+}
@@ -0,0 +1,26 @@
+//
+//  AvatarEntityTraitEncodingTests.h
+//  tests/avatars/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarEntityTraitEncodingTests_h
+#define hifi_AvatarEntityTraitEncodingTests_h
+
+#include <QtTest/QtTest>
+
+class AvatarEntityTraitEncodingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void standaloneTest();
+    void fromBaseTest();
+    void referenceTest();
+    void malformedTest();
+};
+
+#endif // hifi_AvatarEntityTraitEncodingTests_h
@@ -0,0 +1,157 @@
+//
+//  DracoProfileTests.cpp
+//  tests/baking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DracoProfileTests.h"
+
+#include <cmath>
+
+#ifdef _WIN32
+#pragma warning( push )
+#pragma warning( disable : 4267 )
+#endif
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-compare"
+#endif
+
+#include <draco/compression/decode.h>
+
+#ifdef _WIN32
+#pragma warning( pop )
+#endif
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+#include <model-baker/BuildDracoMeshTask.h>
+
+QTEST_MAIN(DracoProfileTests)
+
+// the size of a typical prop's mesh
+static const int GRID_SIZE = 128;
+
+// a rippled grid, so the positions and normals vary the way a real surface's do
+static hfm::Mesh createGridMesh(std::vector<glm::vec3>& normals) {
+    hfm::Mesh mesh;
+    normals.clear();
+    for (int y = 0; y < GRID_SIZE; ++y) {
+        for (int x = 0; x < GRID_SIZE; ++x) {
+            float u = (float)x / (GRID_SIZE - 1);
+            float v = (float)y / (GRID_SIZE - 1);
+            float height = 0.1f * sinf(u * 12.0f) * cosf(v * 9.0f);
+            mesh.vertices.push_back(glm::vec3(u, height, v));
+            mesh.texCoords.push_back(glm::vec2(u, v));
+            normals.push_back(glm::normalize(glm::vec3(-1.2f * cosf(u * 12.0f) * cosf(v * 9.0f), 1.0f,
+                                                       0.9f * sinf(u * 12.0f) * sinf(v * 9.0f))));
+        }
+    }
+
+    hfm::MeshPart part;
+    part.materialID = "grid";
+    for (int y = 0; y + 1 < GRID_SIZE; ++y) {
+        for (int x = 0; x + 1 < GRID_SIZE; ++x) {
+            int corner = y * GRID_SIZE + x;
+            part.triangleIndices << corner << corner + GRID_SIZE << corner + 1;
+            part.triangleIndices << corner + 1 << corner + GRID_SIZE << corner + GRID_SIZE + 1;
+        }
+    }
+    mesh.parts.push_back(part);
+    return mesh;
+}
+
+static hifi::ByteArray encodeGridMesh(const DracoProfile& profile) {
+    std::vector<glm::vec3> normals;
+    hfm::Mesh mesh = createGridMesh(normals);
+    std::vector<hifi::ByteArray> materialList;
+    bool error = true;
+    auto bytes = BuildDracoMeshTask::encodeMesh(mesh, normals, std::vector<glm::vec3>(), baker::MeshLODs(), profile,
+                                                materialList, error);
+    return error ? hifi::ByteArray() : bytes;
+}
+
+static std::unique_ptr<draco::Mesh> decodeMesh(const hifi::ByteArray& bytes) {
+    draco::Decoder decoder;
+    draco::DecoderBuffer buffer;
+    buffer.Init(bytes.data(), bytes.size());
+    auto result = decoder.DecodeMeshFromBuffer(&buffer);
+    return result.ok() ? std::move(result).value() : std::unique_ptr<draco::Mesh>();
+}
+
+static void addProfileRows() {
+    QTest::addColumn<QString>("profile");
+    for (const auto& profile : DracoProfile::getProfiles()) {
+        QTest::newRow(profile.name.toLatin1().constData()) << profile.name;
+    }
+}
+
+void DracoProfileTests::profileNames() {
+    QVERIFY(DracoProfile::find(DEFAULT_DRACO_PROFILE) != nullptr);
+    QVERIFY(DracoProfile::find("FASTDECODE") == DracoProfile::find("fastDecode"));
+    QVERIFY(DracoProfile::find("none") == nullptr);
+    QVERIFY(DracoProfile::find(QString()) == nullptr);
+}
+
+void DracoProfileTests::encodeDecode_data() {
+    addProfileRows();
+}
+
+void DracoProfileTests::encodeDecode() {
+    QFETCH(QString, profile);
+    const DracoProfile* dracoProfile = DracoProfile::find(profile);
+    QVERIFY(dracoProfile != nullptr);
+
+    auto bytes = encodeGridMesh(*dracoProfile);
+    QVERIFY(!bytes.isEmpty());
+
+    auto mesh = decodeMesh(bytes);
+    QVERIFY(mesh != nullptr);
+    QCOMPARE((int)mesh->num_faces(), 2 * (GRID_SIZE - 1) * (GRID_SIZE - 1));
+    QVERIFY(mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION) != nullptr);
+    QVERIFY(mesh->GetNamedAttribute(draco::GeometryAttribute::NORMAL) != nullptr);
+    QVERIFY(mesh->GetNamedAttribute(draco::GeometryAttribute::TEX_COORD) != nullptr);
+
+    // the positions stay on the ripples, within what the quantization of all three coordinates moves them
+    auto positions = mesh->GetNamedAttribute(draco::GeometryAttribute::POSITION);
+    float step = 1.0f / (float)(1 << dracoProfile->positionBits);
+    for (draco::PointIndex i(0); i < mesh->num_points(); ++i) {
+        glm::vec3 position;
+        positions->GetMappedValue(i, &position[0]);
+        float height = 0.1f * sinf(position.x * 12.0f) * cosf(position.z * 9.0f);
+        QVERIFY(fabsf(position.y - height) < 2.0f * step);
+    }
+
+    qDebug() << profile << "encodes" << mesh->num_faces() << "triangles in" << bytes.size() << "bytes";
+}
+
+void DracoProfileTests::quantizationShrinksMeshes() {
+    auto compact = encodeGridMesh(*DracoProfile::find("compact"));
+    auto balanced = encodeGridMesh(*DracoProfile::find(DEFAULT_DRACO_PROFILE));
+    auto fastDecode = encodeGridMesh(*DracoProfile::find("fastDecode"));
+    QVERIFY(compact.size() < balanced.size());
+    // sequential encoding trades size for decode time
+    QVERIFY(balanced.size() < fastDecode.size());
+}
+
+void DracoProfileTests::decodeBenchmark_data() {
+    addProfileRows();
+}
+
+void DracoProfileTests::decodeBenchmark() {
+    QFETCH(QString, profile);
+    auto bytes = encodeGridMesh(*DracoProfile::find(profile));
+    QVERIFY(!bytes.isEmpty());
+
+    qDebug() << profile << bytes.size() << "bytes";
+    QBENCHMARK {
+        auto mesh = decodeMesh(bytes);
+        QVERIFY(mesh != nullptr);
+    }
+}
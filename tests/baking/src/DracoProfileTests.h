@@ -0,0 +1,30 @@
+//
+//  DracoProfileTests.h
+//  tests/baking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DracoProfileTests_h
+#define hifi_DracoProfileTests_h
+
+#include <QtTest/QtTest>
+
+// The size and decode time of a mesh baked with each of the Draco profiles
+class DracoProfileTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void profileNames();
+    void encodeDecode_data();
+    void encodeDecode();
+    void quantizationShrinksMeshes();
+    void decodeBenchmark_data();
+    void decodeBenchmark();
+};
+
+#endif // hifi_DracoProfileTests_h
@@ -0,0 +1,159 @@
+//
+//  ModelSerializationTests.cpp
+//  tests/baking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ModelSerializationTests.h"
+
+#include <model-baker/ModelSerialization.h>
+
+QTEST_MAIN(ModelSerializationTests)
+
+static hfm::Model createModel() {
+    hfm::Model model;
+    model.originalURL = "http://example.com/model.fbx";
+    model.author = "author";
+    model.hasSkeletonJoints = false;
+    model.offset = glm::mat4(2.0f);
+
+    hfm::Joint joint;
+    joint.parentIndex = -1;
+    joint.distanceToParent = 0.0f;
+    joint.translation = glm::vec3(1.0f, 2.0f, 3.0f);
+    joint.rotation = glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f));
+    joint.name = "Hips";
+    joint.isSkeletonJoint = true;
+    joint.bindTransformFoundInCluster = false;
+    joint.hasGeometricOffset = false;
+    model.joints.push_back(joint);
+    model.jointIndices["Hips"] = 1;
+
+    hfm::Mesh mesh;
+    mesh.vertices = { glm::vec3(0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f) };
+    mesh.normals = { glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f) };
+    mesh.tangents = { glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(1.0f, 0.0f, 0.0f) };
+    mesh.texCoords = { glm::vec2(0.0f), glm::vec2(1.0f, 0.0f), glm::vec2(0.0f, 1.0f) };
+    mesh.meshIndex = 0;
+    mesh.meshExtents.addPoint(glm::vec3(0.0f));
+    mesh.meshExtents.addPoint(glm::vec3(1.0f, 0.0f, 1.0f));
+
+    hfm::MeshPart part;
+    part.triangleIndices = { 0, 1, 2 };
+    part.materialID = "material";
+    mesh.parts.push_back(part);
+
+    hfm::Cluster cluster;
+    cluster.jointIndex = 0;
+    cluster.inverseBindMatrix = glm::mat4(1.0f);
+    cluster.inverseBindTransform.setTranslation(glm::vec3(0.0f, -1.0f, 0.0f));
+    mesh.clusters.push_back(cluster);
+
+    hfm::Blendshape blendshape;
+    blendshape.indices = { 1 };
+    blendshape.vertices = { glm::vec3(0.0f, 0.5f, 0.0f) };
+    blendshape.normals = { glm::vec3(0.0f, 0.0f, 1.0f) };
+    mesh.blendshapes.push_back(blendshape);
+    model.meshes.push_back(mesh);
+    model.meshIndicesToModelNames[0] = "triangle";
+
+    hfm::Material material;
+    material.materialID = "material";
+    material.name = "Material";
+    material.albedoTexture.filename = "albedo.png";
+    material.albedoTexture.transform.setScale(glm::vec3(2.0f));
+    material._material = std::make_shared<graphics::Material>();
+    material._material->setAlbedo(glm::vec3(0.25f, 0.5f, 0.75f));
+    material._material->setRoughness(0.3f);
+    material._material->setOpacity(0.5f);
+    model.materials[material.materialID] = material;
+
+    model.blendshapeChannelNames.push_back("Smile");
+    return model;
+}
+
+void ModelSerializationTests::roundTrip() {
+    auto original = createModel();
+    auto model = baker::deserializeModel(baker::serializeModel(original));
+    QVERIFY(model);
+
+    QCOMPARE(model->originalURL, original.originalURL);
+    QCOMPARE(model->author, original.author);
+    QVERIFY(model->offset == original.offset);
+
+    QCOMPARE(model->joints.size(), 1);
+    QCOMPARE(model->joints[0].name, QString("Hips"));
+    QVERIFY(model->joints[0].translation == original.joints[0].translation);
+    QVERIFY(model->joints[0].rotation == original.joints[0].rotation);
+    QCOMPARE(model->getJointIndex("Hips"), 0);
+
+    QCOMPARE(model->meshes.size(), 1);
+    const auto& mesh = model->meshes[0];
+    const auto& originalMesh = original.meshes[0];
+    QVERIFY(mesh.vertices == originalMesh.vertices);
+    QVERIFY(mesh.normals == originalMesh.normals);
+    QVERIFY(mesh.tangents == originalMesh.tangents);
+    QVERIFY(mesh.texCoords == originalMesh.texCoords);
+    QVERIFY(mesh.colors.empty());
+    QCOMPARE(mesh.parts.size(), 1);
+    QCOMPARE(mesh.parts[0].triangleIndices, originalMesh.parts[0].triangleIndices);
+    QCOMPARE(mesh.parts[0].materialID, QString("material"));
+    QCOMPARE(mesh.clusters.size(), 1);
+    QVERIFY(mesh.clusters[0].inverseBindTransform == originalMesh.clusters[0].inverseBindTransform);
+    QVERIFY(mesh.meshExtents.maximum == originalMesh.meshExtents.maximum);
+    QCOMPARE(mesh.blendshapes.size(), 1);
+    QCOMPARE(mesh.blendshapes[0].indices, originalMesh.blendshapes[0].indices);
+    QVERIFY(mesh.blendshapes[0].normals == originalMesh.blendshapes[0].normals);
+    QVERIFY(!mesh._mesh);
+
+    QCOMPARE(model->getModelNameOfMesh(0), QString("triangle"));
+    QCOMPARE(model->blendshapeChannelNames, original.blendshapeChannelNames);
+
+    QCOMPARE(model->materials.size(), 1);
+    const auto& material = model->materials["material"];
+    QCOMPARE(material.name, QString("Material"));
+    QCOMPARE(material.albedoTexture.filename, QByteArray("albedo.png"));
+    QVERIFY(material.albedoTexture.transform == original.materials["material"].albedoTexture.transform);
+    QVERIFY(material.normalTexture.isNull());
+}
+
+void ModelSerializationTests::materialKeyRoundTrip() {
+    auto original = createModel();
+    auto model = baker::deserializeModel(baker::serializeModel(original));
+    QVERIFY(model);
+
+    const auto& originalMaterial = original.materials["material"]._material;
+    const auto& material = model->materials["material"]._material;
+    QVERIFY(material);
+    QCOMPARE(material->getKey()._flags, originalMaterial->getKey()._flags);
+    QVERIFY(material->getAlbedo() == originalMaterial->getAlbedo());
+    QCOMPARE(material->getRoughness(), originalMaterial->getRoughness());
+    QCOMPARE(material->getOpacity(), originalMaterial->getOpacity());
+    QCOMPARE(material->getCullFaceMode(), originalMaterial->getCullFaceMode());
+
+    // a material whose values were never set keeps the default key
+    auto defaultModel = original;
+    defaultModel.materials["material"]._material = std::make_shared<graphics::Material>();
+    model = baker::deserializeModel(baker::serializeModel(defaultModel));
+    QVERIFY(model);
+    QCOMPARE(model->materials["material"]._material->getKey()._flags, graphics::Material().getKey()._flags);
+}
+
+void ModelSerializationTests::rejectsDamagedData() {
+    auto data = baker::serializeModel(createModel());
+    QVERIFY(baker::deserializeModel(data));
+
+    QVERIFY(!baker::deserializeModel(hifi::ByteArray()));
+    QVERIFY(!baker::deserializeModel(data.left(data.size() / 2)));
+    QVERIFY(!baker::deserializeModel(data + hifi::ByteArray(4, '\0')));
+
+    // written by another version
+    auto otherVersion = data;
+    otherVersion[4] = (char)(otherVersion[4] + 1);
+    QVERIFY(!baker::deserializeModel(otherVersion));
+}
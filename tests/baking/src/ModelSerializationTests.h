@@ -0,0 +1,26 @@
+//
+//  ModelSerializationTests.h
+//  tests/baking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ModelSerializationTests_h
+#define hifi_ModelSerializationTests_h
+
+#include <QtTest/QtTest>
+
+class ModelSerializationTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void roundTrip();
+    void materialKeyRoundTrip();
+    void rejectsDamagedData();
+};
+
+#endif // hifi_ModelSerializationTests_h
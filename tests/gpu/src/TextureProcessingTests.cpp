@@ -0,0 +1,292 @@
+//
+//  TextureProcessingTests.cpp
+//  tests/gpu/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TextureProcessingTests.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <CPUDetect.h>
+#include <image/CubeMap.h>
+#include <image/ImageKernels.h>
+
+QTEST_MAIN(TextureProcessingTests)
+
+using namespace image;
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+#define SIMD_KERNEL(name) name##_AVX2
+#define SIMD_NAME "avx2"
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define SIMD_KERNEL(name) name##_NEON
+#define SIMD_NAME "neon"
+#endif
+
+#define SKIP_WITHOUT_SIMD() \
+    do { \
+        if (!_hasSIMD) { \
+            QSKIP("no SIMD kernels for this CPU"); \
+        } \
+    } while (0)
+
+static const int NUM_PIXELS = 4099;  // not a multiple of the SIMD width, to cover the scalar tail
+static const int BENCHMARK_SIZE = 512;
+static const int CUBE_FACE_SIZE = 256;
+
+static std::mt19937 generator(42);
+
+static std::vector<float> randomFloats(size_t count, float maxValue) {
+    std::uniform_real_distribution<float> distribution(0.0f, maxValue);
+    std::vector<float> values(count);
+    for (auto& value : values) {
+        value = distribution(generator);
+    }
+    return values;
+}
+
+// pixels whose alphas are mostly opaque or transparent, and some translucent
+static std::vector<uint32_t> randomPixels(size_t count, int translucentPercent) {
+    std::uniform_int_distribution<uint32_t> distribution;
+    std::vector<uint32_t> pixels(count);
+    for (auto& pixel : pixels) {
+        uint32_t kind = distribution(generator) % 100;
+        uint32_t alpha = kind < (uint32_t)translucentPercent ? 1 + distribution(generator) % 254 : (kind % 2 ? 0xff : 0);
+        pixel = (distribution(generator) & 0xffffff) | (alpha << 24);
+    }
+    return pixels;
+}
+
+static std::vector<Image> randomFaces(int size) {
+    std::vector<Image> faces;
+    for (int face = 0; face < 6; face++) {
+        Image image(size, size, Image::Format_RGBAF);
+        auto values = randomFloats(4 * size * size, 4.0f);
+        memcpy(image.editBits(), values.data(), values.size() * sizeof(float));
+        faces.push_back(image);
+    }
+    return faces;
+}
+
+static int getMipCount(int size) {
+    return 1 + (int)log2(size);
+}
+
+void TextureProcessingTests::initTestCase() {
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+    _hasSIMD = cpuSupportsAVX2();
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+    _hasSIMD = true;
+#endif
+}
+
+void TextureProcessingTests::testPowRGBA() {
+    SKIP_WITHOUT_SIMD();
+#ifdef SIMD_NAME
+    for (float gamma : { 2.2f, 1.0f / 2.2f }) {
+        auto expected = randomFloats(4 * NUM_PIXELS, 100.0f);
+        expected[0] = 0.0f;
+        expected[4] = 1.0f;
+        expected[9] = 65000.0f;
+        auto actual = expected;
+
+        powRGBA_ref(expected.data(), NUM_PIXELS, gamma);
+        SIMD_KERNEL(powRGBA)(actual.data(), NUM_PIXELS, gamma);
+
+        for (size_t i = 0; i < actual.size(); i++) {
+            QVERIFY2(fabsf(actual[i] - expected[i]) <= 1e-5f * expected[i], qPrintable(QString("value %1: %2 != %3")
+                     .arg(i).arg(actual[i]).arg(expected[i])));
+        }
+    }
+#endif
+}
+
+void TextureProcessingTests::testInterleaveRGBA() {
+    SKIP_WITHOUT_SIMD();
+#ifdef SIMD_NAME
+    auto r = randomFloats(NUM_PIXELS, 1.0f);
+    auto g = randomFloats(NUM_PIXELS, 1.0f);
+    auto b = randomFloats(NUM_PIXELS, 1.0f);
+    auto a = randomFloats(NUM_PIXELS, 1.0f);
+    std::vector<float> expected(4 * NUM_PIXELS);
+    std::vector<float> actual(4 * NUM_PIXELS);
+
+    interleaveRGBA_ref(r.data(), g.data(), b.data(), a.data(), expected.data(), NUM_PIXELS);
+    SIMD_KERNEL(interleaveRGBA)(r.data(), g.data(), b.data(), a.data(), actual.data(), NUM_PIXELS);
+    QCOMPARE(actual, expected);
+#endif
+}
+
+void TextureProcessingTests::testDownsampleBox() {
+    SKIP_WITHOUT_SIMD();
+#ifdef SIMD_NAME
+    // an odd destination width, and strides with edges like those of the cube maps
+    const int DST_WIDTH = 37;
+    const int DST_HEIGHT = 10;
+    const size_t SRC_STRIDE = 2 * DST_WIDTH + 2;
+    const size_t DST_STRIDE = DST_WIDTH + 2;
+    auto src = randomFloats(4 * SRC_STRIDE * 2 * DST_HEIGHT, 4.0f);
+    std::vector<float> expected(4 * DST_STRIDE * DST_HEIGHT);
+    std::vector<float> actual(4 * DST_STRIDE * DST_HEIGHT);
+
+    downsampleBox_ref(src.data(), SRC_STRIDE, expected.data(), DST_STRIDE, DST_WIDTH, DST_HEIGHT);
+    SIMD_KERNEL(downsampleBox)(src.data(), SRC_STRIDE, actual.data(), DST_STRIDE, DST_WIDTH, DST_HEIGHT);
+    QCOMPARE(actual, expected);
+#endif
+}
+
+void TextureProcessingTests::testMoveChannelToRed() {
+    SKIP_WITHOUT_SIMD();
+#ifdef SIMD_NAME
+    for (int channelShift : { 0, 8, 16, 24 }) {
+        auto expected = randomPixels(NUM_PIXELS, 50);
+        auto actual = expected;
+
+        moveChannelToRed_ref(expected.data(), NUM_PIXELS, channelShift);
+        SIMD_KERNEL(moveChannelToRed)(actual.data(), NUM_PIXELS, channelShift);
+        QCOMPARE(actual, expected);
+    }
+#endif
+}
+
+void TextureProcessingTests::testCountAlpha() {
+    SKIP_WITHOUT_SIMD();
+#ifdef SIMD_NAME
+    auto pixels = randomPixels(NUM_PIXELS, 3);
+    size_t expectedOpaques, expectedTranslucents;
+    size_t actualOpaques, actualTranslucents;
+
+    // exact under the limit
+    countAlpha_ref(pixels.data(), NUM_PIXELS, NUM_PIXELS, &expectedOpaques, &expectedTranslucents);
+    SIMD_KERNEL(countAlpha)(pixels.data(), NUM_PIXELS, NUM_PIXELS, &actualOpaques, &actualTranslucents);
+    QVERIFY(expectedTranslucents > 0);
+    QCOMPARE(actualOpaques, expectedOpaques);
+    QCOMPARE(actualTranslucents, expectedTranslucents);
+
+    // past it
+    size_t maxTranslucents = expectedTranslucents / 2;
+    countAlpha_ref(pixels.data(), NUM_PIXELS, maxTranslucents, &expectedOpaques, &expectedTranslucents);
+    SIMD_KERNEL(countAlpha)(pixels.data(), NUM_PIXELS, maxTranslucents, &actualOpaques, &actualTranslucents);
+    QVERIFY(expectedTranslucents > maxTranslucents);
+    QVERIFY(actualTranslucents > maxTranslucents);
+    QVERIFY(actualOpaques < (size_t)NUM_PIXELS);
+#endif
+}
+
+void TextureProcessingTests::testCubeMapMips() {
+    // an even size halved by the kernels all the way, and one that turns odd on the way and is left to nvtt
+    for (int size : { 64, 48 }) {
+        auto faces = randomFaces(size);
+        CubeMap cubemap(faces, getMipCount(size));
+        QCOMPARE((int)cubemap.getMipCount(), getMipCount(size));
+
+        for (int face = 0; face < 6; face++) {
+            Image mip0 = cubemap.getFaceImage(0, face);
+            Image mip1 = cubemap.getFaceImage(1, face);
+            for (int y = 0; y < size / 2; y++) {
+                for (int x = 0; x < size / 2; x++) {
+                    glm::vec4 expected = (((mip0.getFloatPixel(2 * x, 2 * y) + mip0.getFloatPixel(2 * x + 1, 2 * y)) +
+                                           mip0.getFloatPixel(2 * x, 2 * y + 1)) + mip0.getFloatPixel(2 * x + 1, 2 * y + 1)) * 0.25f;
+                    QCOMPARE(mip1.getFloatPixel(x, y), expected);
+                }
+            }
+
+            glm::vec4 last = cubemap.getFaceImage(cubemap.getMipCount() - 1, face).getFloatPixel(0, 0);
+            QVERIFY(last.r > 0.0f && last.r < 4.0f);
+        }
+    }
+}
+
+// benchmarks run for the reference and SIMD kernels, for comparison with -tickcounter
+static void addKernelRows(bool hasSIMD) {
+    QTest::addColumn<bool>("simd");
+    QTest::newRow("reference") << false;
+#ifdef SIMD_NAME
+    if (hasSIMD) {
+        QTest::newRow(SIMD_NAME) << true;
+    }
+#endif
+}
+
+void TextureProcessingTests::benchmarkPowRGBA_data() {
+    addKernelRows(_hasSIMD);
+}
+
+void TextureProcessingTests::benchmarkPowRGBA() {
+    QFETCH(bool, simd);
+
+    auto pixels = randomFloats(4 * BENCHMARK_SIZE * BENCHMARK_SIZE, 1.0f);
+
+    auto kernel = powRGBA_ref;
+#ifdef SIMD_NAME
+    if (simd) {
+        kernel = SIMD_KERNEL(powRGBA);
+    }
+#endif
+
+    QBENCHMARK {
+        kernel(pixels.data(), BENCHMARK_SIZE * BENCHMARK_SIZE, 1.0f);
+    }
+}
+
+void TextureProcessingTests::benchmarkDownsampleBox_data() {
+    addKernelRows(_hasSIMD);
+}
+
+void TextureProcessingTests::benchmarkDownsampleBox() {
+    QFETCH(bool, simd);
+
+    auto src = randomFloats(4 * BENCHMARK_SIZE * BENCHMARK_SIZE, 1.0f);
+    std::vector<float> dst(src.size() / 4);
+
+    auto kernel = downsampleBox_ref;
+#ifdef SIMD_NAME
+    if (simd) {
+        kernel = SIMD_KERNEL(downsampleBox);
+    }
+#endif
+
+    QBENCHMARK {
+        kernel(src.data(), BENCHMARK_SIZE, dst.data(), BENCHMARK_SIZE / 2, BENCHMARK_SIZE / 2, BENCHMARK_SIZE / 2);
+    }
+}
+
+void TextureProcessingTests::benchmarkCountAlpha_data() {
+    addKernelRows(_hasSIMD);
+}
+
+void TextureProcessingTests::benchmarkCountAlpha() {
+    QFETCH(bool, simd);
+
+    auto pixels = randomPixels(BENCHMARK_SIZE * BENCHMARK_SIZE, 1);
+    size_t numOpaques, numTranslucents;
+
+    auto kernel = countAlpha_ref;
+#ifdef SIMD_NAME
+    if (simd) {
+        kernel = SIMD_KERNEL(countAlpha);
+    }
+#endif
+
+    QBENCHMARK {
+        kernel(pixels.data(), pixels.size(), pixels.size() / 20, &numOpaques, &numTranslucents);
+    }
+}
+
+// the mips, seams and gamma of a skybox, as the texture processing does them before the GGX convolution
+void TextureProcessingTests::benchmarkCubeMap() {
+    auto faces = randomFaces(CUBE_FACE_SIZE);
+
+    QBENCHMARK {
+        CubeMap cubemap(faces, getMipCount(CUBE_FACE_SIZE));
+        cubemap.applyGamma(2.2f);
+    }
+}
@@ -0,0 +1,42 @@
+//
+//  TextureProcessingTests.h
+//  tests/gpu/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TextureProcessingTests_h
+#define hifi_TextureProcessingTests_h
+
+#include <QtTest/QtTest>
+
+class TextureProcessingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void testPowRGBA();
+    void testInterleaveRGBA();
+    void testDownsampleBox();
+    void testMoveChannelToRed();
+    void testCountAlpha();
+    void testCubeMapMips();
+
+    void benchmarkPowRGBA_data();
+    void benchmarkPowRGBA();
+    void benchmarkDownsampleBox_data();
+    void benchmarkDownsampleBox();
+    void benchmarkCountAlpha_data();
+    void benchmarkCountAlpha();
+    void benchmarkCubeMap();
+
+private:
+    bool _hasSIMD { false };
+};
+
+#endif // hifi_TextureProcessingTests_h
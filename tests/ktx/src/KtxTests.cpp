@@ -13,6 +13,8 @@
 #include <QtTest/QtTest>
 
 #include <ktx/KTX.h>
+#include <ktx/KTX2.h>
+#include <TextureMeta.h>
 #include <gpu/Texture.h>
 #include <image/Image.h>
 #include <image/TextureProcessing.h>
@@ -147,6 +149,165 @@ void KtxTests::testKtxSerialization() {
     testTexture->setKtxBacking(TEST_IMAGE_KTX.fileName().toStdString());
 }
 
+void KtxTests::testMipTiers() {
+    QImage image(256, 128, QImage::Format_ARGB32);
+    image.fill(Qt::darkCyan);
+    std::atomic<bool> abortSignal { false };
+    gpu::TexturePointer testTexture =
+        image::TextureUsage::process2DTextureColorFromImage(std::move(image), "mipTiers", false, gpu::BackendTarget::GL45, true, abortSignal);
+    QVERIFY(testTexture);
+    auto ktxMemory = gpu::Texture::serialize(*testTexture, glm::ivec2(testTexture->getWidth(), testTexture->getHeight()));
+    QVERIFY(ktxMemory.get());
+
+    const auto& header = ktxMemory->_header;
+    auto numMips = (uint16_t)ktxMemory->_images.size();
+    auto mipDimension = [&](uint16_t mip) { return std::max({ header.getPixelWidth() >> mip, header.getPixelHeight() >> mip, 1U }); };
+    QCOMPARE(mipDimension(0), 256U);
+
+    auto tiers = MipTiers::fromKTX(*ktxMemory, 8, 64);
+    QVERIFY(!tiers.isEmpty());
+    QCOMPARE(tiers.firstMips.front(), (uint16_t)0);
+    QVERIFY(std::is_sorted(tiers.firstMips.cbegin(), tiers.firstMips.cend()));
+
+    // the low tier starts at the largest mip of 8 pixels or less, and runs to the end of the file
+    uint16_t lowFirstMip = tiers.firstMips.back();
+    QVERIFY(mipDimension(lowFirstMip) <= 8);
+    QVERIFY(lowFirstMip == 0 || mipDimension(lowFirstMip - 1) > 8);
+    auto lowTierOffset = ktx::KTX_HEADER_SIZE + header.bytesOfKeyValueData + ktxMemory->_images[lowFirstMip]._imageOffset;
+    QCOMPARE((size_t)tiers.lowTierSize, ktxMemory->getStorage()->size() - lowTierOffset);
+
+    for (uint16_t mip = 0; mip < numMips; ++mip) {
+        auto firstMip = tiers.getTierFirstMip(mip);
+        QVERIFY(firstMip <= mip);
+        QVERIFY(std::find(tiers.firstMips.cbegin(), tiers.firstMips.cend(), firstMip) != tiers.firstMips.cend());
+    }
+
+    // the tiers survive the texture meta file
+    TextureMeta meta;
+    meta.availableTextureTypes[header.getGLInternaFormat()] = QUrl("texture.ktx");
+    meta.mipTiers[header.getGLInternaFormat()] = tiers;
+    meta.uncompressedMipTiers = tiers;
+    TextureMeta readMeta;
+    QVERIFY(TextureMeta::deserialize(meta.serialize(), &readMeta));
+    QCOMPARE(readMeta.mipTiers[header.getGLInternaFormat()].firstMips, tiers.firstMips);
+    QCOMPARE(readMeta.mipTiers[header.getGLInternaFormat()].lowTierSize, tiers.lowTierSize);
+    QCOMPARE(readMeta.uncompressedMipTiers.firstMips, tiers.firstMips);
+
+    // and a meta file from before there were tiers has none
+    TextureMeta oldMeta;
+    QVERIFY(TextureMeta::deserialize("{ \"original\": \"texture.png\", \"compressed\": {} }", &oldMeta));
+    QVERIFY(oldMeta.mipTiers.empty());
+    QVERIFY(oldMeta.uncompressedMipTiers.isEmpty());
+}
+
+void KtxTests::testKtx2Reader() {
+    // an 8x8 UASTC texture with two levels, laid out as the specification has it
+    std::vector<uint8_t> file;
+    auto writeUInt32 = [&](uint32_t value) {
+        file.insert(file.end(), (const uint8_t*)&value, (const uint8_t*)&value + sizeof(value));
+    };
+    auto writeUInt64 = [&](uint64_t value) {
+        file.insert(file.end(), (const uint8_t*)&value, (const uint8_t*)&value + sizeof(value));
+    };
+
+    const uint32_t NUM_LEVELS = 2;
+    const uint32_t DFD_SIZE = 44;
+    const std::string KEY = "KTXwriter";
+    const std::string VALUE = "KtxTests";
+    const uint32_t KEY_VALUE_SIZE = (uint32_t)(KEY.size() + 1 + VALUE.size() + 1);
+    const uint32_t KVD_SIZE = sizeof(uint32_t) + ktx::evalPaddedSize(KEY_VALUE_SIZE);
+    const uint32_t LEVEL_SIZES[NUM_LEVELS] = { 64, 16 };
+
+    uint32_t dfdOffset = (uint32_t)(ktx::KTX2::HEADER_SIZE + NUM_LEVELS * ktx::KTX2::LEVEL_INDEX_ENTRY_SIZE);
+    uint32_t kvdOffset = dfdOffset + DFD_SIZE;
+    uint64_t level1Offset = kvdOffset + KVD_SIZE;
+    uint64_t level0Offset = level1Offset + LEVEL_SIZES[1];
+
+    file.insert(file.end(), ktx::KTX2::IDENTIFIER.begin(), ktx::KTX2::IDENTIFIER.end());
+    for (uint32_t value : { ktx::KTX2::VK_FORMAT_UNDEFINED, 1U, 8U, 8U, 0U, 0U, 1U, NUM_LEVELS, 0U }) {
+        writeUInt32(value);
+    }
+    writeUInt32(dfdOffset);
+    writeUInt32(DFD_SIZE);
+    writeUInt32(kvdOffset);
+    writeUInt32(KVD_SIZE);
+    writeUInt64(0);
+    writeUInt64(0);
+    QCOMPARE(file.size(), (size_t)ktx::KTX2::HEADER_SIZE);
+
+    // the index lists the largest level first, though the smallest is stored first
+    const uint64_t LEVEL_OFFSETS[NUM_LEVELS] = { level0Offset, level1Offset };
+    for (uint32_t i = 0; i < NUM_LEVELS; ++i) {
+        writeUInt64(LEVEL_OFFSETS[i]);
+        writeUInt64(LEVEL_SIZES[i]);
+        writeUInt64(LEVEL_SIZES[i]);
+    }
+
+    writeUInt32(DFD_SIZE);
+    writeUInt32(0);
+    writeUInt32(0);
+    file.insert(file.end(), { ktx::KTX2::COLOR_MODEL_UASTC, 1, ktx::KTX2::TRANSFER_FUNCTION_SRGB, 0 });
+    file.resize(kvdOffset, 0);
+
+    writeUInt32(KEY_VALUE_SIZE);
+    file.insert(file.end(), KEY.begin(), KEY.end());
+    file.push_back(0);
+    file.insert(file.end(), VALUE.begin(), VALUE.end());
+    file.push_back(0);
+    file.resize(level1Offset, 0);
+
+    file.resize(level1Offset + LEVEL_SIZES[1], 1);
+    file.resize(level0Offset + LEVEL_SIZES[0], 2);
+
+    auto storage = std::make_shared<storage::MemoryStorage>(file.size(), file.data());
+    auto ktx2 = ktx::KTX2::create(storage);
+    QVERIFY(ktx2);
+    QCOMPARE(ktx2->getHeader().pixelWidth, 8U);
+    QCOMPARE(ktx2->getHeader().levelCount, NUM_LEVELS);
+    QCOMPARE(ktx2->getSupercompressionScheme(), ktx::KTX2::SupercompressionScheme::NONE);
+    QCOMPARE(ktx2->getColorModel(), (uint8_t)ktx::KTX2::COLOR_MODEL_UASTC);
+    QVERIFY(ktx2->isBasisUniversal());
+    QVERIFY(ktx2->isSRGB());
+    QVERIFY(!ktx2->getSupercompressionGlobalData());
+
+    QCOMPARE(ktx2->getLevels().size(), (size_t)NUM_LEVELS);
+    auto level0 = ktx2->getLevelData(0);
+    QVERIFY(level0);
+    QCOMPARE(level0->size(), (size_t)LEVEL_SIZES[0]);
+    QCOMPARE(level0->data()[0], (uint8_t)2);
+    auto level1 = ktx2->getLevelData(1);
+    QVERIFY(level1);
+    QCOMPARE(level1->size(), (size_t)LEVEL_SIZES[1]);
+    QCOMPARE(level1->data()[0], (uint8_t)1);
+    QVERIFY(!ktx2->getLevelData(NUM_LEVELS));
+
+    QCOMPARE(ktx2->getKeyValues().size(), (size_t)1);
+    QCOMPARE(ktx2->getKeyValues().front()._key, KEY);
+
+    // a level running past the end of the file is rejected
+    auto truncated = std::make_shared<storage::MemoryStorage>(file.size() - 1, file.data());
+    QVERIFY(!ktx::KTX2::create(truncated));
+
+    // and so is a KTX 1 file
+    QImage image(16, 16, QImage::Format_ARGB32);
+    image.fill(Qt::darkCyan);
+    std::atomic<bool> abortSignal { false };
+    gpu::TexturePointer testTexture =
+        image::TextureUsage::process2DTextureColorFromImage(std::move(image), "ktx2", false, gpu::BackendTarget::GL45, true, abortSignal);
+    QVERIFY(testTexture);
+    auto ktxMemory = gpu::Texture::serialize(*testTexture, glm::ivec2(testTexture->getWidth(), testTexture->getHeight()));
+    QVERIFY(ktxMemory.get());
+    QVERIFY(!ktx::KTX2::checkIdentifier(ktxMemory->getStorage()->size(), ktxMemory->getStorage()->data()));
+    QVERIFY(!ktx::KTX2::create(ktxMemory->getStorage()));
+
+    // the universal variant survives the texture meta file
+    TextureMeta meta;
+    meta.universal = QUrl("texture.ktx2");
+    TextureMeta readMeta;
+    QVERIFY(TextureMeta::deserialize(meta.serialize(), &readMeta));
+    QCOMPARE(readMeta.universal, meta.universal);
+}
+
 #if 0
 
 static const QString TEST_FOLDER { "H:/ktx_cacheold" };
@@ -0,0 +1,86 @@
+//
+//  AssetChunkingTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkingTests.h"
+
+#include <random>
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QSet>
+
+#include <AssetChunking.h>
+
+QTEST_MAIN(AssetChunkingTests)
+
+using namespace AssetUtils;
+
+static const int CONTENT_SIZE = 2 * 1024 * 1024;
+
+static QByteArray randomContent(int size) {
+    std::mt19937 generator(1);
+    QByteArray content(size, 0);
+    for (auto& byte : content) {
+        byte = (char)(generator() & 0xFF);
+    }
+    return content;
+}
+
+static QSet<QByteArray> chunkHashes(const std::vector<ContentChunk>& chunks) {
+    QSet<QByteArray> hashes;
+    for (const auto& chunk : chunks) {
+        hashes.insert(chunk.hash);
+    }
+    return hashes;
+}
+
+void AssetChunkingTests::chunksCoverContent() {
+    QCOMPARE((int)chunkContent(QByteArray()).size(), 0);
+
+    auto content = randomContent(CONTENT_SIZE);
+    auto chunks = chunkContent(content);
+
+    uint64_t offset = 0;
+    for (const auto& chunk : chunks) {
+        QCOMPARE(chunk.offset, offset);
+        QCOMPARE(chunk.hash, QCryptographicHash::hash(content.mid((int)chunk.offset, (int)chunk.size),
+                                                      QCryptographicHash::Sha256));
+        offset += chunk.size;
+    }
+    QCOMPARE(offset, (uint64_t)CONTENT_SIZE);
+}
+
+void AssetChunkingTests::chunkSizesAreBounded() {
+    auto chunks = chunkContent(randomContent(CONTENT_SIZE));
+    QVERIFY(chunks.size() > 1);
+
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        QVERIFY(chunks[i].size <= MAX_CONTENT_CHUNK_SIZE);
+        if (i < chunks.size() - 1) {
+            QVERIFY(chunks[i].size > MIN_CONTENT_CHUNK_SIZE);
+        }
+    }
+
+    // content without any variation is cut at the maximum size
+    auto uniformChunks = chunkContent(QByteArray(CONTENT_SIZE, 0));
+    QCOMPARE(uniformChunks.front().size, MAX_CONTENT_CHUNK_SIZE);
+}
+
+void AssetChunkingTests::editsKeepOtherChunks() {
+    auto content = randomContent(CONTENT_SIZE);
+    auto chunks = chunkContent(content);
+
+    auto edited = content;
+    edited.insert(CONTENT_SIZE / 2, "an edit in the middle");
+    auto editedChunks = chunkContent(edited);
+
+    auto sharedHashes = chunkHashes(chunks) & chunkHashes(editedChunks);
+    QVERIFY((size_t)sharedHashes.size() >= chunks.size() - 2);
+}
@@ -0,0 +1,25 @@
+//
+//  AssetChunkingTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AssetChunkingTests_h
+#define hifi_AssetChunkingTests_h
+
+#include <QtTest/QtTest>
+
+class AssetChunkingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void chunksCoverContent();
+    void chunkSizesAreBounded();
+    void editsKeepOtherChunks();
+};
+
+#endif // hifi_AssetChunkingTests_h
@@ -0,0 +1,127 @@
+//
+//  ConnectionStatsHistoryTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ConnectionStatsHistoryTests.h"
+
+#include <cmath>
+
+#include <udt/ConnectionStatsHistory.h>
+#include <udt/LatencyHistogram.h>
+
+QTEST_MAIN(ConnectionStatsHistoryTests)
+
+using namespace udt;
+
+void ConnectionStatsHistoryTests::percentileTest() {
+    LatencyHistogram histogram;
+
+    // 1 to 100000 microseconds, so the exact percentile p is p * 1000
+    const int NUM_VALUES = 100000;
+    for (int value = NUM_VALUES; value > 0; --value) {
+        histogram.record(value);
+    }
+    QCOMPARE(histogram.getCount(), (uint32_t)NUM_VALUES);
+    QCOMPARE(histogram.getMax(), NUM_VALUES);
+    QCOMPARE(histogram.getMean(), (NUM_VALUES + 1) / 2);
+
+    const float MAX_RELATIVE_ERROR = 0.035f;
+    for (float percentile : { 1.0f, 10.0f, 50.0f, 90.0f, 99.0f, 99.9f }) {
+        float exact = percentile / 100.0f * NUM_VALUES;
+        float error = std::abs(histogram.getValueAtPercentile(percentile) - exact) / exact;
+        QVERIFY2(error < MAX_RELATIVE_ERROR, qPrintable(QString("p%1 is off by %2").arg(percentile).arg(error)));
+    }
+    QCOMPARE(histogram.getValueAtPercentile(100.0f), NUM_VALUES);
+
+    // small values are counted exactly
+    LatencyHistogram smallValues;
+    for (int value = 1; value <= 10; ++value) {
+        smallValues.record(value);
+    }
+    QCOMPARE(smallValues.getValueAtPercentile(50.0f), 5);
+    QCOMPARE(smallValues.getValueAtPercentile(90.0f), 9);
+
+    // adding histograms counts both
+    LatencyHistogram sum;
+    sum.add(histogram);
+    sum.add(smallValues);
+    QCOMPARE(sum.getCount(), histogram.getCount() + smallValues.getCount());
+    QCOMPARE(sum.getMax(), NUM_VALUES);
+}
+
+void ConnectionStatsHistoryTests::rangeTest() {
+    LatencyHistogram histogram;
+    QCOMPARE(histogram.getValueAtPercentile(99.0f), 0);
+    QCOMPARE(histogram.getMean(), 0);
+
+    histogram.record(-5);
+    histogram.record(LatencyHistogram::MAX_VALUE * 2);
+    QCOMPARE(histogram.getCount(), (uint32_t)2);
+    QCOMPARE(histogram.getValueAtPercentile(50.0f), 0);
+    QCOMPARE(histogram.getMax(), LatencyHistogram::MAX_VALUE);
+    QCOMPARE(histogram.getValueAtPercentile(100.0f), LatencyHistogram::MAX_VALUE);
+
+    histogram.reset();
+    QCOMPARE(histogram.getCount(), (uint32_t)0);
+    QCOMPARE(histogram.getMax(), 0);
+}
+
+void ConnectionStatsHistoryTests::sampleTest() {
+    ConnectionStats stats;
+    for (int i = 0; i < 99; ++i) {
+        stats.recordRTT(20000);
+        stats.recordSendLatency(100);
+    }
+    stats.recordRTT(500000);
+    stats.recordSendLatency(80000);
+
+    // percentiles are reported as the highest value of their buckets
+    auto sample = stats.sample();
+    QCOMPARE(sample.rttPercentiles.p50, 20479);
+    QCOMPARE(sample.rttPercentiles.max, 500000);
+    QCOMPARE(sample.sendLatencyPercentiles.p99, 101);
+    QCOMPARE(sample.sendLatencyPercentiles.max, 80000);
+    QCOMPARE(sample.rtt, (99 * 20000 + 500000) / 100);
+
+    // the next sample starts over
+    auto nextSample = stats.sample();
+    QCOMPARE(nextSample.rttPercentiles.max, 0);
+    QCOMPARE(nextSample.sendLatencyPercentiles.p50, 0);
+    QCOMPARE(nextSample.rtt, 0);
+}
+
+void ConnectionStatsHistoryTests::historyTest() {
+    ConnectionStatsHistory history;
+    QVERIFY(history.getSamples().empty());
+
+    const int NUM_SAMPLES = ConnectionStatsHistory::CAPACITY * 2 + 7;
+    for (int i = 0; i < NUM_SAMPLES; ++i) {
+        ConnectionStats::Stats stats;
+        stats.startTime = std::chrono::microseconds(i * 1000);
+        stats.endTime = std::chrono::microseconds((i + 1) * 1000);
+        stats.sentPackets = i;
+        stats.rttPercentiles.p99 = i * 10;
+        history.push(stats);
+
+        auto samples = history.getSamples();
+        QCOMPARE((int)samples.size(), std::min(i + 1, (int)ConnectionStatsHistory::CAPACITY));
+        QCOMPARE(samples.back().sentPackets, (uint32_t)i);
+    }
+
+    auto samples = history.getSamples();
+    QCOMPARE(history.getNumPushed(), (uint32_t)NUM_SAMPLES);
+    for (size_t i = 0; i < samples.size(); ++i) {
+        auto expected = NUM_SAMPLES - ConnectionStatsHistory::CAPACITY + (int)i;
+        QCOMPARE(samples[i].sentPackets, (uint32_t)expected);
+        QCOMPARE(samples[i].rtt.p99, expected * 10);
+        QCOMPARE(samples[i].endTime, (uint64_t)(expected + 1) * 1000);
+        QCOMPARE(samples[i].duration, (uint32_t)1000);
+    }
+}
@@ -0,0 +1,35 @@
+//
+//  ConnectionStatsHistoryTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ConnectionStatsHistoryTests_h
+#define hifi_ConnectionStatsHistoryTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ConnectionStatsHistoryTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that percentiles read back from the histogram are within its precision of the exact ones
+    void percentileTest();
+
+    // Test that values outside the range are clamped, and that an empty histogram reads as zero
+    void rangeTest();
+
+    // Test that the stats sample the RTT and send latency recorded since the last sample
+    void sampleTest();
+
+    // Test that the history keeps its last samples in order once the ring has wrapped around
+    void historyTest();
+};
+
+#endif // hifi_ConnectionStatsHistoryTests_h
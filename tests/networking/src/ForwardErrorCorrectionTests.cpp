@@ -0,0 +1,129 @@
+//
+//  ForwardErrorCorrectionTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ForwardErrorCorrectionTests.h"
+
+#include <algorithm>
+
+#include <ForwardErrorCorrection.h>
+#include <NLPacket.h>
+
+QTEST_MAIN(ForwardErrorCorrectionTests)
+
+using namespace udt;
+
+static std::unique_ptr<Packet> createPacket(SequenceNumber sequenceNumber, int payloadSize) {
+    auto packet = Packet::create(-1, false);
+    QByteArray payload(payloadSize, 0);
+    for (int i = 0; i < payloadSize; ++i) {
+        payload[i] = (char)((uint32_t)sequenceNumber * 31 + i);
+    }
+    packet->write(payload);
+    packet->writeSequenceNumber(sequenceNumber);
+    return packet;
+}
+
+// sends a group through the encoder, and hands the decoder all of it but the lost packets
+static std::vector<QByteArray> sendGroup(FECEncoder& encoder, FECDecoder& decoder,
+                                         const std::vector<std::unique_ptr<Packet>>& packets,
+                                         const std::vector<size_t>& lost) {
+    std::vector<QByteArray> parity;
+    for (size_t i = 0; i < packets.size(); ++i) {
+        parity = encoder.protect(*packets[i]);
+        if (std::find(lost.begin(), lost.end(), i) == lost.end()) {
+            decoder.packetReceived(*packets[i]);
+        }
+    }
+    return parity;
+}
+
+void ForwardErrorCorrectionTests::groupSizeTest() {
+    FECEncoder encoder;
+    QVERIFY(!encoder.isEnabled());
+    QVERIFY(encoder.protect(*createPacket(SequenceNumber(1), 100)).empty());
+
+    encoder.setLossRate(0.0f);
+    QVERIFY(encoder.isEnabled());
+    auto lowLossGroupSize = encoder.getGroupSize();
+
+    encoder.setLossRate(0.03f);
+    QVERIFY(encoder.getGroupSize() < lowLossGroupSize);
+
+    encoder.setLossRate(0.2f);
+    QCOMPARE(encoder.getGroupSize(), 2);
+}
+
+void ForwardErrorCorrectionTests::recoverLostPacketTest() {
+    FECEncoder encoder;
+    FECDecoder decoder;
+    encoder.setLossRate(0.03f);
+
+    std::vector<std::unique_ptr<Packet>> packets;
+    for (int i = 0; i < encoder.getGroupSize(); ++i) {
+        packets.push_back(createPacket(SequenceNumber(100 + i), 200 + 50 * i));
+    }
+
+    auto parity = sendGroup(encoder, decoder, packets, { 1 });
+    QCOMPARE((int)parity.size(), 1);
+
+    auto recovered = decoder.parityReceived(parity[0].constData(), parity[0].size(), SockAddr());
+    QVERIFY(recovered);
+    QCOMPARE(recovered->getSequenceNumber(), packets[1]->getSequenceNumber());
+    QCOMPARE(QByteArray(recovered->getData(), (int)recovered->getDataSize()),
+             QByteArray(packets[1]->getData(), (int)packets[1]->getDataSize()));
+    QCOMPARE(decoder.getNumRecovered(), 1);
+
+    // the original showing up after all is not handled twice
+    QVERIFY(!decoder.packetReceived(*packets[1]));
+}
+
+void ForwardErrorCorrectionTests::fragmentedParityTest() {
+    FECEncoder encoder;
+    FECDecoder decoder;
+    encoder.setLossRate(0.2f);
+
+    std::vector<std::unique_ptr<Packet>> packets;
+    for (int i = 0; i < encoder.getGroupSize(); ++i) {
+        packets.push_back(createPacket(SequenceNumber(7 + i), Packet::maxPayloadSize()));
+    }
+
+    auto parity = sendGroup(encoder, decoder, packets, { 0 });
+    QVERIFY(parity.size() > 1);
+    for (auto& payload : parity) {
+        QVERIFY(payload.size() <= NLPacket::maxPayloadSize(PacketType::FECParity));
+    }
+
+    std::unique_ptr<Packet> recovered;
+    for (auto& payload : parity) {
+        QVERIFY(!recovered);
+        recovered = decoder.parityReceived(payload.constData(), payload.size(), SockAddr());
+    }
+    QVERIFY(recovered);
+    QCOMPARE(QByteArray(recovered->getData(), (int)recovered->getDataSize()),
+             QByteArray(packets[0]->getData(), (int)packets[0]->getDataSize()));
+}
+
+void ForwardErrorCorrectionTests::doubleLossTest() {
+    FECEncoder encoder;
+    FECDecoder decoder;
+    encoder.setLossRate(0.03f);
+    QVERIFY(encoder.getGroupSize() >= 3);
+
+    std::vector<std::unique_ptr<Packet>> packets;
+    for (int i = 0; i < encoder.getGroupSize(); ++i) {
+        packets.push_back(createPacket(SequenceNumber(1000 + i), 300));
+    }
+
+    auto parity = sendGroup(encoder, decoder, packets, { 0, 2 });
+    QCOMPARE((int)parity.size(), 1);
+    QVERIFY(!decoder.parityReceived(parity[0].constData(), parity[0].size(), SockAddr()));
+    QCOMPARE(decoder.getNumRecovered(), 0);
+}
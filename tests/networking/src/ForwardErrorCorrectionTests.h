@@ -0,0 +1,35 @@
+//
+//  ForwardErrorCorrectionTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ForwardErrorCorrectionTests_h
+#define hifi_ForwardErrorCorrectionTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class ForwardErrorCorrectionTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the encoder stays off until a loss rate is reported, and protects more as the loss grows
+    void groupSizeTest();
+
+    // Test that one packet lost from a group is rebuilt exactly, and that its late copy is dropped
+    void recoverLostPacketTest();
+
+    // Test that the parity of full size packets is split across packets and still rebuilds the lost one
+    void fragmentedParityTest();
+
+    // Test that nothing is rebuilt from a group that lost two packets
+    void doubleLossTest();
+};
+
+#endif // hifi_ForwardErrorCorrectionTests_h
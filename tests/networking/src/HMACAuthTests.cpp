@@ -0,0 +1,91 @@
+//
+//  HMACAuthTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HMACAuthTests.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QUuid>
+
+#include <HMACAuth.h>
+
+QTEST_MAIN(HMACAuthTests)
+
+static QByteArray hashOf(HMACAuth& hmacAuth, const QByteArray& data) {
+    HMACAuth::HMACHash hash;
+    if (!hmacAuth.calculateHash(hash, data.constData(), data.size())) {
+        return QByteArray();
+    }
+    return QByteArray((const char*)hash.data(), (int)hash.size());
+}
+
+void HMACAuthTests::knownHashesTest() {
+    HMACAuth hmacAuth;
+    QByteArray key(16, 0x0b);
+    QVERIFY(hmacAuth.setKey(key.constData(), key.size()));
+    QCOMPARE(hashOf(hmacAuth, "Hi There").toHex(), QByteArray("9294727a3638bb1c13f48ef8158bfc9d"));
+
+    QVERIFY(hmacAuth.setKey("Jefe", 4));
+    QByteArray data("what do ya want for nothing?");
+    unsigned char hash[HMACAuth::MAX_HASH_SIZE];
+    int hashLength = hmacAuth.calculateHash(hash, data.constData(), data.size());
+    QCOMPARE(hashLength, 16);
+    QCOMPARE(QByteArray((const char*)hash, hashLength).toHex(), QByteArray("750c783e6ab0b503eaa86e310a5db738"));
+}
+
+void HMACAuthTests::reuseAndRekeyTest() {
+    HMACAuth hmacAuth;
+    QVERIFY(hashOf(hmacAuth, "data").isEmpty());
+
+    QVERIFY(hmacAuth.setKey(QUuid::createUuid()));
+    auto firstHash = hashOf(hmacAuth, "data");
+    QCOMPARE(firstHash.size(), 16);
+    QCOMPARE(hashOf(hmacAuth, "data"), firstHash);
+    QVERIFY(hashOf(hmacAuth, "other data") != firstHash);
+
+    QVERIFY(hmacAuth.setKey(QUuid::createUuid()));
+    QVERIFY(hashOf(hmacAuth, "data") != firstHash);
+}
+
+void HMACAuthTests::concurrentHashesTest() {
+    HMACAuth hmacAuth;
+    QVERIFY(hmacAuth.setKey(QUuid::createUuid()));
+
+    static const int NUM_THREADS = 8;
+    static const int NUM_HASHES = 2000;
+
+    std::vector<QByteArray> data;
+    std::vector<QByteArray> expectedHashes;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        data.push_back(QByteArray(100 + i, (char)i));
+        expectedHashes.push_back(hashOf(hmacAuth, data.back()));
+    }
+
+    // more threads than pooled contexts, so some of them share the locked one
+    std::atomic<int> numMismatches { 0 };
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&, i] {
+            for (int j = 0; j < NUM_HASHES; ++j) {
+                if (hashOf(hmacAuth, data[i]) != expectedHashes[i]) {
+                    ++numMismatches;
+                }
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    QCOMPARE(numMismatches.load(), 0);
+}
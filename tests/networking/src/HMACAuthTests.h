@@ -0,0 +1,32 @@
+//
+//  HMACAuthTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_HMACAuthTests_h
+#define hifi_HMACAuthTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class HMACAuthTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test the HMAC-MD5 vectors from RFC 2202, through both hash calls
+    void knownHashesTest();
+
+    // Test that a context is reused correctly, and picks up a new key
+    void reuseAndRekeyTest();
+
+    // Test that threads hashing with the same instance at once all get the right hashes
+    void concurrentHashesTest();
+};
+
+#endif // hifi_HMACAuthTests_h
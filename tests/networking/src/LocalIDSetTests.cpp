@@ -0,0 +1,82 @@
+//
+//  LocalIDSetTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LocalIDSetTests.h"
+
+#include <LocalIDSet.h>
+#include <Node.h>
+
+QTEST_MAIN(LocalIDSetTests)
+
+static SharedNodePointer makeNode(Node::LocalID localID) {
+    SharedNodePointer node(new Node(QUuid::createUuid(), NodeType::Agent, SockAddr(), SockAddr()));
+    node->setLocalID(localID);
+    return node;
+}
+
+void LocalIDSetTests::insertEraseTest() {
+    LocalIDSet set;
+    QVERIFY(set.empty());
+    QVERIFY(!set.contains(0));
+    QVERIFY(!set.contains(65535));
+
+    QVERIFY(set.insert(3));
+    QVERIFY(set.insert(64));
+    QVERIFY(set.insert(65535));
+    QVERIFY(!set.insert(64));
+    QCOMPARE(set.size(), (size_t)3);
+    QVERIFY(set.contains(3));
+    QVERIFY(set.contains(64));
+    QVERIFY(set.contains(65535));
+    QVERIFY(!set.contains(4));
+    QVERIFY(!set.contains(63));
+
+    QVERIFY(set.erase(64));
+    QVERIFY(!set.erase(64));
+    QVERIFY(!set.erase(1000));
+    QVERIFY(!set.contains(64));
+    QCOMPARE(set.size(), (size_t)2);
+
+    set.clear();
+    QVERIFY(set.empty());
+    QVERIFY(!set.contains(3));
+}
+
+void LocalIDSetTests::ignoredNodeTest() {
+    auto listener = makeNode(1);
+    auto ignored = makeNode(2);
+    auto other = makeNode(3);
+
+    // without a node list the ignored node isn't known to be connected until it's said to be
+    listener->addIgnoredNode(ignored->getUUID());
+    QVERIFY(listener->isIgnoringNodeWithID(ignored->getUUID()));
+    QVERIFY(!listener->isIgnoringNodeWithLocalID(ignored->getLocalID()));
+
+    listener->otherNodeAdded(*ignored);
+    listener->otherNodeAdded(*other);
+    QVERIFY(listener->isIgnoringNodeWithLocalID(ignored->getLocalID()));
+    QVERIFY(!listener->isIgnoringNodeWithLocalID(other->getLocalID()));
+
+    // the ignore outlives the node, its local ID doesn't
+    listener->otherNodeKilled(*ignored);
+    QVERIFY(listener->isIgnoringNodeWithID(ignored->getUUID()));
+    QVERIFY(!listener->isIgnoringNodeWithLocalID(ignored->getLocalID()));
+
+    listener->otherNodeAdded(*ignored);
+    QVERIFY(listener->isIgnoringNodeWithLocalID(ignored->getLocalID()));
+
+    // no longer ignored while it's gone, it's not ignored when it comes back
+    listener->otherNodeKilled(*ignored);
+    listener->removeIgnoredNode(ignored->getUUID());
+    listener->otherNodeAdded(*ignored);
+    QVERIFY(!listener->isIgnoringNodeWithID(ignored->getUUID()));
+    QVERIFY(!listener->isIgnoringNodeWithLocalID(ignored->getLocalID()));
+}
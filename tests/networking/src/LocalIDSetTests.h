@@ -0,0 +1,24 @@
+//
+//  LocalIDSetTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LocalIDSetTests_h
+#define hifi_LocalIDSetTests_h
+
+#include <QtTest/QtTest>
+
+class LocalIDSetTests : public QObject {
+    Q_OBJECT
+private slots:
+    void insertEraseTest();
+    void ignoredNodeTest();
+};
+
+#endif // hifi_LocalIDSetTests_h
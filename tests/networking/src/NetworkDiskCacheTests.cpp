@@ -0,0 +1,92 @@
+//
+//  NetworkDiskCacheTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NetworkDiskCacheTests.h"
+
+#include <memory>
+
+#include <QtCore/QTemporaryDir>
+
+#include <NetworkDiskCache.h>
+
+QTEST_MAIN(NetworkDiskCacheTests)
+
+static const int ENTRY_SIZE = 1024;
+static const int WAIT_MSECS = 20;
+
+static void insertEntry(NetworkDiskCache& cache, const QUrl& url) {
+    QNetworkCacheMetaData metaData;
+    metaData.setUrl(url);
+    metaData.setSaveToDisk(true);
+    QIODevice* device = cache.prepare(metaData);
+    QVERIFY(device);
+    device->write(QByteArray(ENTRY_SIZE, 'x'));
+    cache.insert(device);
+}
+
+static bool readEntry(NetworkDiskCache& cache, const QUrl& url) {
+    std::unique_ptr<QIODevice> device(cache.data(url));
+    return device && device->readAll().size() == ENTRY_SIZE;
+}
+
+void NetworkDiskCacheTests::evictsLeastRecentlyUsed() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    NetworkDiskCache cache;
+    cache.setCacheDirectory(directory.path());
+    QUrl first("http://example.com/first.fbx");
+    QUrl second("http://example.com/second.fbx");
+    QUrl third("http://example.com/third.fbx");
+    insertEntry(cache, first);
+    QTest::qWait(WAIT_MSECS);
+    insertEntry(cache, second);
+    QTest::qWait(WAIT_MSECS);
+    insertEntry(cache, third);
+    QTest::qWait(WAIT_MSECS);
+
+    // the oldest entry is the most recently used one
+    QVERIFY(readEntry(cache, first));
+
+    // room for two of the entries only
+    qint64 entrySize = cache.cacheSize() / 3;
+    cache.setMaximumCacheSize(entrySize * 5 / 2);
+
+    QVERIFY(readEntry(cache, first));
+    QVERIFY(!readEntry(cache, second));
+    QVERIFY(readEntry(cache, third));
+}
+
+void NetworkDiskCacheTests::keepsAccessTimes() {
+    QTemporaryDir directory;
+    QVERIFY(directory.isValid());
+
+    QUrl first("http://example.com/first.fbx");
+    QUrl second("http://example.com/second.fbx");
+    qint64 entrySize;
+    {
+        NetworkDiskCache cache;
+        cache.setCacheDirectory(directory.path());
+        insertEntry(cache, first);
+        QTest::qWait(WAIT_MSECS);
+        insertEntry(cache, second);
+        QTest::qWait(WAIT_MSECS);
+        QVERIFY(readEntry(cache, first));
+        entrySize = cache.cacheSize() / 2;
+    }
+
+    // the use of the first entry is remembered by the next cache on the directory
+    NetworkDiskCache cache;
+    cache.setCacheDirectory(directory.path());
+    cache.setMaximumCacheSize(entrySize * 3 / 2);
+    QVERIFY(readEntry(cache, first));
+    QVERIFY(!readEntry(cache, second));
+}
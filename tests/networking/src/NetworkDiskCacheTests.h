@@ -0,0 +1,24 @@
+//
+//  NetworkDiskCacheTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NetworkDiskCacheTests_h
+#define hifi_NetworkDiskCacheTests_h
+
+#include <QtTest/QtTest>
+
+class NetworkDiskCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void evictsLeastRecentlyUsed();
+    void keepsAccessTimes();
+};
+
+#endif // hifi_NetworkDiskCacheTests_h
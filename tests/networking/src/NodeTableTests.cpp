@@ -0,0 +1,69 @@
+//
+//  NodeTableTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "NodeTableTests.h"
+
+#include <NodeTable.h>
+
+QTEST_MAIN(NodeTableTests)
+
+static SharedNodePointer makeNode(Node::LocalID localID) {
+    SharedNodePointer node(new Node(QUuid::createUuid(), NodeType::Agent, SockAddr(), SockAddr()));
+    node->setLocalID(localID);
+    return node;
+}
+
+void NodeTableTests::insertEraseTest() {
+    NodeTable table;
+    auto first = makeNode(1);
+    auto second = makeNode(2);
+
+    table.insert(first, first->getLocalID());
+    table.insert(second, second->getLocalID());
+    table.insert(first, first->getLocalID());   // already present
+
+    QCOMPARE(table.size(), (size_t)2);
+    QCOMPARE(table.nodeWithUUID(first->getUUID()), first);
+    QCOMPARE(table.nodeWithLocalID(2), second);
+    QVERIFY(table.nodeWithUUID(QUuid::createUuid()).isNull());
+
+    // a local ID that is already taken keeps its node
+    auto third = makeNode(2);
+    table.insert(third, third->getLocalID());
+    QCOMPARE(table.size(), (size_t)3);
+    QCOMPARE(table.nodeWithLocalID(2), second);
+
+    table.erase(first);
+    QCOMPARE(table.size(), (size_t)2);
+    QVERIFY(table.nodeWithUUID(first->getUUID()).isNull());
+    QVERIFY(table.nodeWithLocalID(1).isNull());
+    QCOMPARE(table.nodes()[0], second);
+
+    table.clear();
+    QCOMPARE(table.size(), (size_t)0);
+}
+
+void NodeTableTests::snapshotTest() {
+    auto node = makeNode(1);
+
+    auto table = std::make_shared<NodeTable>();
+    table->insert(node, node->getLocalID());
+    NodeTablePointer snapshot = table;
+
+    // the way LimitedNodeList::editNodeTable() publishes a change
+    auto edited = std::make_shared<NodeTable>(*snapshot);
+    edited->erase(node);
+
+    // readers of the old snapshot still see the node
+    QCOMPARE(snapshot->size(), (size_t)1);
+    QCOMPARE(snapshot->nodeWithLocalID(1), node);
+    QCOMPARE(edited->size(), (size_t)0);
+}
@@ -0,0 +1,24 @@
+//
+//  NodeTableTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_NodeTableTests_h
+#define hifi_NodeTableTests_h
+
+#include <QtTest/QtTest>
+
+class NodeTableTests : public QObject {
+    Q_OBJECT
+private slots:
+    void insertEraseTest();
+    void snapshotTest();
+};
+
+#endif // hifi_NodeTableTests_h
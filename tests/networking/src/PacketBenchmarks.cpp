@@ -0,0 +1,132 @@
+//
+//  PacketBenchmarks.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBenchmarks.h"
+
+#include <QtCore/QUuid>
+
+#include <test-utils/Benchmark.h>
+
+#include <HMACAuth.h>
+#include <NLPacket.h>
+#include <NLPacketList.h>
+#include <SequenceNumberStats.h>
+
+QTEST_MAIN(PacketBenchmarks)
+
+BENCHMARK_COUNT_ALLOCATIONS()
+
+namespace {
+
+// a sourced and verified type, like most of what the mixers and servers receive
+const PacketType SOURCED_TYPE = PacketType::EntityEdit;
+const NLPacket::LocalID SOURCE_ID = 42;
+
+// a payload a few packets long, such as an entity data message
+const int LIST_PAYLOAD_SIZE = 4 * udt::MAX_PACKET_SIZE;
+
+std::unique_ptr<NLPacket> receivedCopy(const NLPacket& packet) {
+    auto size = packet.getDataSize();
+    auto data = std::unique_ptr<char[]>(new char[size]);
+    memcpy(data.get(), packet.getData(), size);
+    return NLPacket::fromReceivedPacket(std::move(data), size, SockAddr());
+}
+
+}
+
+void PacketBenchmarks::benchmarkPacketCreate() {
+    size_t totalSize = 0;
+    benchmark::run("NLPacket::create", [&] {
+        auto packet = NLPacket::create(SOURCED_TYPE);
+        totalSize += packet->getDataSize();
+    });
+    QVERIFY(totalSize > 0);
+}
+
+void PacketBenchmarks::benchmarkPacketWriteAndRead() {
+    auto packet = NLPacket::create(SOURCED_TYPE);
+    const QUuid id = QUuid::createUuid();
+    const quint64 timestamp = 1234567890;
+    const float values[] = { 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f };
+
+    benchmark::run("NLPacket write", [&] {
+        packet->reset();
+        packet->write(id.toRfc4122());
+        packet->writePrimitive(timestamp);
+        packet->write(reinterpret_cast<const char*>(values), sizeof(values));
+    });
+
+    auto readPacket = receivedCopy(*packet);
+    QUuid readID;
+    benchmark::run("NLPacket read", [&] {
+        readPacket->seek(0);
+        readID = QUuid::fromRfc4122(readPacket->readWithoutCopy(NUM_BYTES_RFC4122_UUID));
+        quint64 readTimestamp;
+        readPacket->readPrimitive(&readTimestamp);
+        float readValues[sizeof(values) / sizeof(float)];
+        readPacket->read(reinterpret_cast<char*>(readValues), sizeof(readValues));
+    });
+    QCOMPARE(readID, id);
+}
+
+void PacketBenchmarks::benchmarkPacketListCreate() {
+    const QByteArray payload(LIST_PAYLOAD_SIZE, 'x');
+    size_t totalPackets = 0;
+    benchmark::run("NLPacketList::create and write", [&] {
+        auto packetList = NLPacketList::create(PacketType::EntityData, QByteArray(), true, true);
+        packetList->write(payload);
+        packetList->closeCurrentPacket();
+        totalPackets += packetList->getNumPackets();
+    });
+    QVERIFY(totalPackets > 0);
+}
+
+void PacketBenchmarks::benchmarkVerificationHash() {
+    HMACAuth hmacAuth;
+    QVERIFY(hmacAuth.setKey(QUuid::createUuid()));
+
+    auto packet = NLPacket::create(SOURCED_TYPE);
+    const QByteArray payload(packet->getPayloadCapacity() / 2, 'x');
+    packet->write(payload);
+    packet->writeSourceID(SOURCE_ID);
+
+    benchmark::run("NLPacket::writeVerificationHash", [&] {
+        packet->writeVerificationHash(hmacAuth);
+    });
+
+    auto readPacket = receivedCopy(*packet);
+    bool matches = false;
+    benchmark::run("NLPacket::verificationHashMatches", [&] {
+        matches = NLPacket::verificationHashMatches(*readPacket, hmacAuth);
+    });
+    QVERIFY(matches);
+}
+
+void PacketBenchmarks::benchmarkSequenceNumberStats() {
+    SequenceNumberStats stats;
+    quint16 sequenceNumber = 0;
+    benchmark::run("SequenceNumberStats::sequenceNumberReceived", [&] {
+        stats.sequenceNumberReceived(sequenceNumber++);
+    });
+
+    // every few numbers arrives late or never
+    SequenceNumberStats lossyStats;
+    quint16 lossySequenceNumber = 0;
+    benchmark::run("SequenceNumberStats::sequenceNumberReceived lossy", [&] {
+        lossySequenceNumber += (lossySequenceNumber % 7 == 0) ? 2 : 1;
+        lossyStats.sequenceNumberReceived(lossySequenceNumber);
+        if (lossySequenceNumber % 11 == 0) {
+            lossyStats.sequenceNumberReceived(lossySequenceNumber - 3);
+        }
+    });
+    QVERIFY(stats.getReceived() > 0);
+    QVERIFY(lossyStats.getLost() > 0);
+}
@@ -0,0 +1,29 @@
+//
+//  PacketBenchmarks.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketBenchmarks_h
+#define hifi_PacketBenchmarks_h
+
+#include <QtTest/QtTest>
+
+// Times the packet encoding and decoding hot paths, see test-utils/Benchmark.h for the output
+class PacketBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void benchmarkPacketCreate();
+    void benchmarkPacketWriteAndRead();
+    void benchmarkPacketListCreate();
+    void benchmarkVerificationHash();
+    void benchmarkSequenceNumberStats();
+};
+
+#endif // hifi_PacketBenchmarks_h
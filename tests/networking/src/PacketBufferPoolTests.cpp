@@ -0,0 +1,97 @@
+//
+//  PacketBufferPoolTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPoolTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <NLPacket.h>
+#include <PerformanceCounters.h>
+#include <udt/PacketBufferPool.h>
+
+QTEST_MAIN(PacketBufferPoolTests)
+
+using namespace udt;
+
+static uint64_t poolHits() {
+    return PerformanceCounters::getInstance().counter("packet_buffer_pool_hits", QString()).get();
+}
+
+static uint64_t poolMisses() {
+    return PerformanceCounters::getInstance().counter("packet_buffer_pool_misses", QString()).get();
+}
+
+void PacketBufferPoolTests::testReuse() {
+    char* first;
+    {
+        auto buffer = PacketBufferPool::allocate();
+        first = buffer.get();
+    }
+
+    // the buffer just freed is the next one handed out on this thread
+    auto hits = poolHits();
+    auto buffer = PacketBufferPool::allocate(100);
+    QCOMPARE(buffer.get(), first);
+    QCOMPARE(poolHits(), hits + 1);
+
+    // and packets go through the pool too
+    buffer.reset();
+    auto packet = NLPacket::create(PacketType::Ping);
+    QCOMPARE(packet->getData(), first);
+    QCOMPARE(packet->getPayloadSize(), (qint64)0);
+}
+
+void PacketBufferPoolTests::testOversized() {
+    auto misses = poolMisses();
+    auto buffer = PacketBufferPool::allocate(PacketBufferPool::BUFFER_SIZE + 1);
+    QVERIFY(buffer);
+    QVERIFY(!buffer.get_deleter().isPooled);
+    QCOMPARE(poolMisses(), misses + 1);
+}
+
+void PacketBufferPoolTests::testCrossThreadReturn() {
+    // a receiving thread allocates, this one frees, enough to pass batches through the shared list
+    const int NUM_BUFFERS = 2000;
+    std::vector<PacketBuffer> buffers;
+    std::thread receiver([&] {
+        for (int i = 0; i < NUM_BUFFERS; ++i) {
+            buffers.push_back(PacketBufferPool::allocate());
+            buffers.back()[0] = (char)i;
+        }
+    });
+    receiver.join();
+    for (int i = 0; i < NUM_BUFFERS; ++i) {
+        QCOMPARE(buffers[i][0], (char)i);
+    }
+    buffers.clear();
+
+    // which another thread then allocates from
+    uint64_t hits = poolHits();
+    std::thread other([&] {
+        for (int i = 0; i < NUM_BUFFERS / 2; ++i) {
+            buffers.push_back(PacketBufferPool::allocate());
+        }
+    });
+    other.join();
+    QVERIFY(poolHits() - hits >= (uint64_t)NUM_BUFFERS / 4);
+    buffers.clear();
+}
+
+void PacketBufferPoolTests::testUnpooledBuffers() {
+    // buffers allocated elsewhere are handed over as they are
+    const qint64 SIZE = 64;
+    auto data = std::unique_ptr<char[]>(new char[SIZE]);
+    memset(data.get(), 0, SIZE);
+    char* pointer = data.get();
+    auto packet = udt::Packet::fromReceivedPacket(std::move(data), SIZE, SockAddr());
+    QCOMPARE(packet->getData(), pointer);
+}
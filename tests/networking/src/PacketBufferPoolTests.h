@@ -0,0 +1,26 @@
+//
+//  PacketBufferPoolTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketBufferPoolTests_h
+#define hifi_PacketBufferPoolTests_h
+
+#include <QtTest/QtTest>
+
+class PacketBufferPoolTests : public QObject {
+    Q_OBJECT
+private slots:
+    void testReuse();
+    void testOversized();
+    void testCrossThreadReturn();
+    void testUnpooledBuffers();
+};
+
+#endif // hifi_PacketBufferPoolTests_h
@@ -0,0 +1,141 @@
+//
+//  PacketCoalescerTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketCoalescerTests.h"
+
+#include <cstring>
+
+#include <udt/Constants.h>
+#include <udt/PacketCoalescer.h>
+
+QTEST_MAIN(PacketCoalescerTests)
+
+using namespace udt;
+
+static const QByteArray HEADER("CP");
+static const int HEADER_SIZE = Packet::totalHeaderSize() + HEADER.size();
+
+static std::unique_ptr<Packet> createPacket(int payloadSize, char fill, bool isReliable = true) {
+    auto packet = Packet::create(-1, isReliable);
+    packet->write(QByteArray(payloadSize, fill));
+    return packet;
+}
+
+static QByteArray dataOf(const Packet& packet) {
+    return QByteArray(packet.getData(), (int)packet.getDataSize());
+}
+
+// what the receiver splits out of the datagram
+static std::vector<std::unique_ptr<Packet>> receive(const QByteArray& data) {
+    auto buffer = PacketBufferPool::allocate(data.size());
+    memcpy(buffer.get(), data.constData(), data.size());
+    auto packet = Packet::fromReceivedPacket(std::move(buffer), data.size(), SockAddr());
+    return PacketCoalescer::split(*packet, HEADER_SIZE);
+}
+
+void PacketCoalescerTests::roundTripTest() {
+    auto message = Packet::create(-1, true, true);
+    message->write(QByteArray(40, 'm'));
+    message->writeMessageNumber(7, Packet::PacketPosition::ONLY, 0);
+
+    std::vector<std::unique_ptr<Packet>> packetsToSend;
+    packetsToSend.push_back(createPacket(10, 'a'));
+    packetsToSend.push_back(std::move(message));
+    packetsToSend.push_back(createPacket(200, 'b'));
+
+    std::vector<QByteArray> sent;
+    PacketCoalescer coalescer;
+    for (auto& packet : packetsToSend) {
+        QVERIFY(PacketCoalescer::isCoalescable(*packet));
+        QVERIFY(coalescer.fits(*packet, HEADER.size()));
+        sent.push_back(dataOf(*packet));
+        coalescer.append(std::move(packet));
+    }
+    QCOMPARE(coalescer.getNumPackets(), (size_t)3);
+
+    auto coalescedPacket = coalescer.takeCoalescedPacket(HEADER);
+    QVERIFY(coalescer.isEmpty());
+    QVERIFY(coalescedPacket->isReliable());
+    QVERIFY(!coalescedPacket->isPartOfMessage());
+    QCOMPARE(QByteArray(coalescedPacket->getPayload(), HEADER.size()), HEADER);
+
+    auto packets = receive(dataOf(*coalescedPacket));
+    QCOMPARE(packets.size(), sent.size());
+    for (size_t i = 0; i < packets.size(); ++i) {
+        QCOMPARE(dataOf(*packets[i]), sent[i]);
+        QVERIFY(packets[i]->isReliable());
+    }
+    QVERIFY(packets[1]->isPartOfMessage());
+    QCOMPARE(packets[1]->getMessageNumber(), (Packet::MessageNumber)7);
+    QCOMPARE(packets[1]->getPacketPosition(), Packet::PacketPosition::ONLY);
+    QCOMPARE(packets[2]->getPayloadSize(), (qint64)200);
+}
+
+void PacketCoalescerTests::singlePacketTest() {
+    QVERIFY(!PacketCoalescer::isCoalescable(*createPacket(10, 'a', false)));
+    QVERIFY(!PacketCoalescer::isCoalescable(*createPacket(PacketCoalescer::MAX_COALESCED_PACKET_SIZE, 'a')));
+
+    auto firstOfMany = Packet::create(-1, true, true);
+    firstOfMany->writeMessageNumber(1, Packet::PacketPosition::FIRST, 0);
+    QVERIFY(!PacketCoalescer::isCoalescable(*firstOfMany));
+
+    PacketCoalescer coalescer;
+    QVERIFY(!coalescer.takeCoalescedPacket(HEADER));
+
+    auto packet = createPacket(10, 'a');
+    auto packetPointer = packet.get();
+    coalescer.append(std::move(packet));
+    QCOMPARE(coalescer.takeCoalescedPacket(HEADER).get(), packetPointer);
+}
+
+void PacketCoalescerTests::fullDatagramTest() {
+    PacketCoalescer coalescer;
+    int numPackets = 0;
+    while (true) {
+        auto packet = createPacket(200, 'a');
+        if (!coalescer.fits(*packet, HEADER.size())) {
+            break;
+        }
+        coalescer.append(std::move(packet));
+        ++numPackets;
+    }
+    QVERIFY(numPackets > 1);
+
+    auto coalescedPacket = coalescer.takeCoalescedPacket(HEADER);
+    QVERIFY(coalescedPacket->getDataSize() <= Packet::totalHeaderSize() + Packet::maxPayloadSize());
+    QCOMPARE(receive(dataOf(*coalescedPacket)).size(), (size_t)numPackets);
+}
+
+void PacketCoalescerTests::malformedDataTest() {
+    PacketCoalescer coalescer;
+    coalescer.append(createPacket(10, 'a'));
+    coalescer.append(createPacket(20, 'b'));
+    auto data = dataOf(*coalescer.takeCoalescedPacket(HEADER));
+    QCOMPARE(receive(data).size(), (size_t)2);
+
+    // cut short, in the middle of the second packet and of its size
+    QVERIFY(receive(data.left(data.size() - 1)).empty());
+    QVERIFY(receive(data.left(HEADER_SIZE + 2 + Packet::totalHeaderSize() + 10 + 1)).empty());
+
+    // a size running past the end
+    QByteArray tooLong = data;
+    quint16 size = 0xffff;
+    memcpy(tooLong.data() + HEADER_SIZE, &size, sizeof(size));
+    QVERIFY(receive(tooLong).empty());
+
+    // an unreliable packet inside
+    QByteArray unreliable = data;
+    Packet::SequenceNumberAndBitField bitField;
+    memcpy(&bitField, unreliable.constData() + HEADER_SIZE + 2, sizeof(bitField));
+    bitField &= ~RELIABILITY_BIT_MASK;
+    memcpy(unreliable.data() + HEADER_SIZE + 2, &bitField, sizeof(bitField));
+    QVERIFY(receive(unreliable).empty());
+}
@@ -0,0 +1,35 @@
+//
+//  PacketCoalescerTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketCoalescerTests_h
+#define hifi_PacketCoalescerTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketCoalescerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that coalesced packets and single packet messages are split back into the packets that were sent
+    void roundTripTest();
+
+    // Test that a lone packet is sent as it was, and that big or unreliable packets aren't coalesced
+    void singlePacketTest();
+
+    // Test that the shared datagram stops taking packets once it is full
+    void fullDatagramTest();
+
+    // Test that nothing is split out of truncated or malformed data
+    void malformedDataTest();
+};
+
+#endif // hifi_PacketCoalescerTests_h
@@ -0,0 +1,86 @@
+//
+//  PacketQueueTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketQueueTests.h"
+
+#include <udt/PacketList.h>
+#include <udt/PacketQueue.h>
+
+QTEST_MAIN(PacketQueueTests)
+
+using namespace udt;
+
+static std::unique_ptr<PacketList> createPacketList(Packet::Priority priority, int numPackets) {
+    auto packetList = PacketList::create(PacketType::Unknown, QByteArray(), true, false);
+    packetList->setPriority(priority);
+    for (int i = 0; i < numPackets; ++i) {
+        packetList->write(QByteArray((int)packetList->getMaxSegmentSize(), 'x'));
+    }
+    packetList->closeCurrentPacket();
+    return packetList;
+}
+
+static std::unique_ptr<Packet> createPacket() {
+    auto packet = Packet::create(-1, true);
+    packet->write(QByteArray(16, 'x'));
+    return packet;
+}
+
+void PacketQueueTests::urgentPacketSkipsBulkTest() {
+    PacketQueue queue;
+    queue.queuePacketList(createPacketList(Packet::Priority::Bulk, 100));
+
+    for (int i = 0; i < 3; ++i) {
+        QCOMPARE(queue.takePacket()->getPriority(), Packet::Priority::Bulk);
+    }
+
+    queue.queuePacket(createPacket());
+    QCOMPARE(queue.takePacket()->getPriority(), Packet::Priority::Urgent);
+    QCOMPARE(queue.takePacket()->getPriority(), Packet::Priority::Bulk);
+}
+
+void PacketQueueTests::weightedSharesTest() {
+    const int NUM_PACKETS = 200;
+
+    PacketQueue queue;
+    queue.queuePacketList(createPacketList(Packet::Priority::Bulk, NUM_PACKETS));
+    queue.queuePacketList(createPacketList(Packet::Priority::Normal, NUM_PACKETS));
+    for (int i = 0; i < NUM_PACKETS; ++i) {
+        queue.queuePacket(createPacket());
+    }
+
+    // ten whole rounds of the 8 / 4 / 1 weights
+    std::array<int, Packet::NUM_PRIORITIES> counts {{ 0, 0, 0 }};
+    for (int i = 0; i < 130; ++i) {
+        ++counts[(int)queue.takePacket()->getPriority()];
+    }
+
+    QCOMPARE(counts[(int)Packet::Priority::Urgent], 80);
+    QCOMPARE(counts[(int)Packet::Priority::Normal], 40);
+    QCOMPARE(counts[(int)Packet::Priority::Bulk], 10);
+}
+
+void PacketQueueTests::singlePriorityTest() {
+    const int NUM_PACKETS = 50;
+
+    PacketQueue queue;
+    auto packetList = createPacketList(Packet::Priority::Normal, NUM_PACKETS);
+    int numPackets = (int)packetList->getNumPackets();
+    QVERIFY(numPackets >= NUM_PACKETS);
+    queue.queuePacketList(std::move(packetList));
+
+    for (int i = 0; i < numPackets; ++i) {
+        QVERIFY(!queue.isEmpty());
+        QCOMPARE(queue.takePacket()->getPriority(), Packet::Priority::Normal);
+    }
+    QVERIFY(queue.isEmpty());
+    QVERIFY(!queue.takePacket());
+}
@@ -0,0 +1,32 @@
+//
+//  PacketQueueTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PacketQueueTests_h
+#define hifi_PacketQueueTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketQueueTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a single packet queued behind a bulk transfer goes out next
+    void urgentPacketSkipsBulkTest();
+
+    // Test that the priorities share the queue by weight while they all have packets
+    void weightedSharesTest();
+
+    // Test that a priority left alone gets all of the queue
+    void singlePriorityTest();
+};
+
+#endif // hifi_PacketQueueTests_h
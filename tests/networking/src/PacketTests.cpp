@@ -15,6 +15,7 @@
 #include <test-utils/QTestExtensions.h>
 
 #include <NLPacket.h>
+#include <ReceivedMessage.h>
 
 QTEST_MAIN(PacketTests)
 
@@ -182,3 +183,44 @@ void PacketTests::primitiveTest() {
     QCOMPARE(recvPacket->peekPrimitive(&noValue), 0);
     QCOMPARE(recvPacket->readPrimitive(&noValue), 0);
 }
+
+void PacketTests::borrowedMessageTest() {
+    auto sentPacket = NLPacket::create(PacketType::MicrophoneAudioNoEcho);
+    sentPacket->write("somedata");
+    sentPacket->write("moredata");
+
+    auto packet = copyToReadPacket(sentPacket);
+    auto payload = packet->getPayload();
+
+    ReceivedMessage message(std::move(packet));
+
+    QCOMPARE(message.isBorrowed(), true);
+    QCOMPARE(message.isComplete(), true);
+    QCOMPARE(message.getType(), PacketType::MicrophoneAudioNoEcho);
+    QCOMPARE(message.getSize(), 16);
+
+    // raw access reads the packet payload in place
+    QCOMPARE(message.getRawMessage(), (const char*)payload);
+
+    // byte array access returns copies that can outlive the message
+    QByteArray data = message.getMessage();
+    QCOMPARE(data, QByteArray("somedatamoredata"));
+    QVERIFY(data.constData() != message.getRawMessage());
+
+    QByteArray head = message.readHead(8);
+    QCOMPARE(head, QByteArray("somedata"));
+    QVERIFY(head.constData() != message.getRawMessage());
+
+    QByteArray rest = message.readAll();
+    QCOMPARE(rest, QByteArray("moredata"));
+    QCOMPARE(message.getBytesLeftToRead(), 0);
+    QCOMPARE(message.read(8), QByteArray());
+
+    // reading the head past its end returns nothing, as it does for a copied message
+    auto longPacket = NLPacket::create(PacketType::MicrophoneAudioNoEcho);
+    longPacket->write(QByteArray(600, 'x'));
+    ReceivedMessage longMessage(copyToReadPacket(longPacket));
+    QCOMPARE(longMessage.isBorrowed(), true);
+    QCOMPARE(longMessage.read(520).size(), 520);
+    QCOMPARE(longMessage.readHead(8), QByteArray());
+}
@@ -36,6 +36,9 @@ private slots:
 
     // Test set/get packet type
     void packetTypeTest();
+
+    // Test reading a single packet message in place
+    void borrowedMessageTest();
 };
 
 #endif // hifi_PacketTests_h
@@ -17,6 +17,7 @@
 #include <NodeList.h>
 #include <NetworkAccessManager.h>
 #include <DependencyManager.h>
+#include <ResourceRequestObserver.h>
 #include <StatTracker.h>
 
 QTEST_MAIN(ResourceTests)
@@ -29,6 +30,7 @@ void ResourceTests::initTestCase() {
     DependencyManager::set<NodeList>(NodeType::Agent, INVALID_PORT);
     DependencyManager::set<ResourceCacheSharedItems>();
     DependencyManager::set<ResourceManager>();
+    DependencyManager::set<ResourceRequestObserver>();
     const qint64 MAXIMUM_CACHE_SIZE = 1024 * 1024 * 1024; // 1GB
 
     // set up the file cache
@@ -94,3 +96,90 @@ void ResourceTests::downloadAgain() {
 
     QVERIFY(resource->isLoaded());
 }
+
+class TestResourceCache : public ResourceCache {
+protected:
+    QSharedPointer<Resource> createResource(const QUrl& url) override {
+        return QSharedPointer<Resource>(new Resource(url), &Resource::deleter);
+    }
+    QSharedPointer<Resource> createResourceCopy(const QSharedPointer<Resource>& resource) override {
+        return QSharedPointer<Resource>(new Resource(*resource), &Resource::deleter);
+    }
+};
+
+void ResourceTests::speculativeRequests() {
+    // queue every request, to check the order they would be made in
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    uint32_t requestLimit = sharedItems->getRequestLimit();
+    sharedItems->setRequestLimit(0);
+
+    uint32_t numHits = ResourceCache::getSpeculativeHitCount();
+    uint32_t numMisses = ResourceCache::getSpeculativeMissCount();
+
+    TestResourceCache cache;
+    QUrl predictedUrl("file:///speculative/predicted.fst");
+    QUrl requestedUrl("file:///speculative/requested.fst");
+    QUrl mispredictedUrl("file:///speculative/mispredicted.fst");
+
+    auto predicted = cache.getSpeculativeResource(predictedUrl, nullptr, 0);
+    QVERIFY(predicted && predicted->isSpeculative());
+    auto mispredicted = cache.getSpeculativeResource(mispredictedUrl, nullptr, 0);
+    auto requested = cache.getResource(requestedUrl, QUrl(), nullptr, 0);
+    QVERIFY(!requested->isSpeculative());
+
+    // there is nothing to speculate on for a known resource
+    QVERIFY(!cache.getSpeculativeResource(requestedUrl, nullptr, 0));
+
+    // a requested resource goes first, whatever its priority
+    predicted->setLoadPriority(&cache, 1.0f);
+    requested->setLoadPriority(&cache, -1.0f);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), requested);
+
+    // requesting the predicted resource turns it into a requested one
+    QCOMPARE(cache.getResource(predictedUrl, QUrl(), nullptr, 0), predicted);
+    QVERIFY(!predicted->isSpeculative());
+    QCOMPARE(ResourceCache::getSpeculativeHitCount(), numHits + 1);
+
+    ResourceCache::cancelSpeculativeResource(predicted);
+    QCOMPARE(ResourceCache::getSpeculativeMissCount(), numMisses);
+    ResourceCache::cancelSpeculativeResource(mispredicted);
+    QCOMPARE(ResourceCache::getSpeculativeMissCount(), numMisses + 1);
+
+    sharedItems->clear();
+    sharedItems->setRequestLimit(requestLimit);
+}
+
+void ResourceTests::requestClasses() {
+    auto sharedItems = DependencyManager::get<ResourceCacheSharedItems>();
+    uint32_t requestLimit = sharedItems->getRequestLimit();
+    sharedItems->setRequestLimit(0);
+
+    TestResourceCache cache;
+    auto distant = cache.getResource(QUrl("http://localhost/distant.fbx"), QUrl(), nullptr, 0);
+    distant->setLoadPriority(&cache, 0.01f);
+    auto speculative = cache.getSpeculativeResource(QUrl("http://localhost/speculative.fbx"), nullptr, 0);
+    auto nearby = cache.getResource(QUrl("http://localhost/nearby.fbx"), QUrl(), nullptr, 0);
+    nearby->setLoadPriority(&cache, 1.0f);
+    auto avatar = cache.getResource(QUrl("http://localhost/avatar.fst"), QUrl(), nullptr, 0);
+    avatar->setLoadPriority(&cache, 3.0f);
+
+    QVERIFY(nearby->getRequestClass(nearby->getLoadPriority()) == ResourceRequestClass::NEARBY);
+    QCOMPARE(sharedItems->getPendingRequestsCount(), 4u);
+    auto stats = sharedItems->getRequestQueueStats();
+    QCOMPARE(stats["avatar"].toMap()["pending"].toUInt(), 1u);
+    QCOMPARE(stats["speculative"].toMap()["pending"].toUInt(), 1u);
+
+    // the classes go in order while none gets less than its share of the bandwidth
+    QCOMPARE(sharedItems->getHighestPendingRequest(), avatar);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), nearby);
+
+    // a pending request is scheduled again when its priority changes
+    distant->setLoadPriority(&cache, 2.0f);
+    QVERIFY(distant->getRequestClass(distant->getLoadPriority()) == ResourceRequestClass::AVATAR);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), distant);
+    QCOMPARE(sharedItems->getHighestPendingRequest(), speculative);
+    QVERIFY(!sharedItems->getHighestPendingRequest());
+
+    sharedItems->clear();
+    sharedItems->setRequestLimit(requestLimit);
+}
@@ -0,0 +1,150 @@
+//
+//  SecureSessionTests.cpp
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SecureSessionTests.h"
+
+#include <vector>
+
+#include <QtCore/QUuid>
+
+#include <udt/SecureSession.h>
+
+QTEST_MAIN(SecureSessionTests)
+
+using namespace udt;
+
+static QByteArray encrypt(SecureSession& session, const QByteArray& datagram) {
+    QByteArray envelope(SecureSession::encryptedSize(datagram.size()), 0);
+    auto size = session.encrypt(datagram.constData(), datagram.size(), envelope.data());
+    return size < 0 ? QByteArray() : envelope;
+}
+
+static QByteArray decrypt(SecureSession& session, QByteArray envelope) {
+    auto size = session.decrypt(envelope.data(), envelope.size());
+    return size < 0 ? QByteArray() : envelope.left((int)size);
+}
+
+static void establish(const QByteArray& preSharedKey, std::shared_ptr<SecureSession>& initiator,
+                      std::shared_ptr<SecureSession>& responder) {
+    initiator = SecureSession::initiate(preSharedKey);
+    QVERIFY(initiator);
+    QVERIFY(!initiator->isEstablished());
+
+    auto init = initiator->getHandshake();
+    responder = SecureSession::respond(init.constData(), init.size(), preSharedKey);
+    QVERIFY(responder);
+    QVERIFY(responder->isEstablished());
+    QVERIFY(responder->isResponseTo(init.constData(), init.size()));
+
+    auto response = responder->getHandshake();
+    QVERIFY(initiator->completeHandshake(response.constData(), response.size()));
+    QVERIFY(initiator->isEstablished());
+}
+
+void SecureSessionTests::initTestCase() {
+    if (!SecureSession::isSupported()) {
+        QSKIP("OpenSSL is too old for secure sessions");
+    }
+}
+
+void SecureSessionTests::handshakeTest() {
+    std::shared_ptr<SecureSession> initiator;
+    std::shared_ptr<SecureSession> responder;
+    establish(QUuid::createUuid().toRfc4122(), initiator, responder);
+    QCOMPARE(initiator->getCipher(), responder->getCipher());
+
+    QByteArray datagram("a datagram on its way from the initiator");
+    auto envelope = encrypt(*initiator, datagram);
+    QCOMPARE((qint64)envelope.size(), (qint64)datagram.size() + SECURE_DATAGRAM_OVERHEAD);
+    QVERIFY(!envelope.contains(datagram));
+
+    ControlPacket::Type type;
+    QVERIFY(SecureSession::readSecureType(envelope.constData(), envelope.size(), type));
+    QCOMPARE(type, ControlPacket::SecureData);
+    QCOMPARE(decrypt(*responder, envelope), datagram);
+
+    // each direction has its own key
+    QVERIFY(decrypt(*initiator, envelope).isEmpty());
+
+    QByteArray reply("and the reply");
+    QCOMPARE(decrypt(*initiator, encrypt(*responder, reply)), reply);
+
+    // sessions without a pre-shared key still agree on their keys
+    establish(QByteArray(), initiator, responder);
+    QCOMPARE(decrypt(*responder, encrypt(*initiator, datagram)), datagram);
+}
+
+void SecureSessionTests::preSharedKeyTest() {
+    auto preSharedKey = QUuid::createUuid().toRfc4122();
+    auto initiator = SecureSession::initiate(preSharedKey);
+    QVERIFY(initiator);
+    auto init = initiator->getHandshake();
+
+    QVERIFY(!SecureSession::respond(init.constData(), init.size(), QUuid::createUuid().toRfc4122()));
+    QVERIFY(!SecureSession::respond(init.constData(), init.size(), QByteArray()));
+
+    // a responder without the key can't answer in its place
+    auto forgedInitiator = SecureSession::initiate(QByteArray());
+    auto forgedInit = forgedInitiator->getHandshake();
+    auto other = SecureSession::respond(forgedInit.constData(), forgedInit.size(), QByteArray());
+    QVERIFY(other);
+    auto forgedResponse = other->getHandshake();
+    QVERIFY(!initiator->completeHandshake(forgedResponse.constData(), forgedResponse.size()));
+    QVERIFY(!initiator->isEstablished());
+
+    auto responder = SecureSession::respond(init.constData(), init.size(), preSharedKey);
+    QVERIFY(responder);
+    auto response = responder->getHandshake();
+    response[response.size() - 1] = response[response.size() - 1] ^ 1;
+    QVERIFY(!initiator->completeHandshake(response.constData(), response.size()));
+}
+
+void SecureSessionTests::tamperedDatagramTest() {
+    std::shared_ptr<SecureSession> initiator;
+    std::shared_ptr<SecureSession> responder;
+    establish(QUuid::createUuid().toRfc4122(), initiator, responder);
+
+    QByteArray datagram(1000, 'x');
+    for (int position : { 5, 12, 500, 1000 + SECURE_DATAGRAM_OVERHEAD - 1 }) {
+        auto envelope = encrypt(*initiator, datagram);
+        envelope[position] = envelope[position] ^ 0x10;
+        QVERIFY(decrypt(*responder, envelope).isEmpty());
+    }
+
+    // the failures didn't take the counters of the datagrams that are still to come
+    QCOMPARE(decrypt(*responder, encrypt(*initiator, datagram)), datagram);
+}
+
+void SecureSessionTests::replayTest() {
+    std::shared_ptr<SecureSession> initiator;
+    std::shared_ptr<SecureSession> responder;
+    establish(QUuid::createUuid().toRfc4122(), initiator, responder);
+
+    std::vector<QByteArray> datagrams;
+    std::vector<QByteArray> envelopes;
+    for (int i = 0; i < 2000; ++i) {
+        datagrams.push_back(QByteArray::number(i));
+        envelopes.push_back(encrypt(*initiator, datagrams.back()));
+    }
+
+    QCOMPARE(decrypt(*responder, envelopes[10]), datagrams[10]);
+    QVERIFY(decrypt(*responder, envelopes[10]).isEmpty());
+
+    // late, but within the window
+    QCOMPARE(decrypt(*responder, envelopes[3]), datagrams[3]);
+    QVERIFY(decrypt(*responder, envelopes[3]).isEmpty());
+
+    // far enough ahead that the early ones fall out of the window
+    QCOMPARE(decrypt(*responder, envelopes[1999]), datagrams[1999]);
+    QVERIFY(decrypt(*responder, envelopes[4]).isEmpty());
+    QCOMPARE(decrypt(*responder, envelopes[1500]), datagrams[1500]);
+    QVERIFY(decrypt(*responder, envelopes[1999]).isEmpty());
+}
@@ -0,0 +1,37 @@
+//
+//  SecureSessionTests.h
+//  tests/networking/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SecureSessionTests_h
+#define hifi_SecureSessionTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class SecureSessionTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that both sides of a handshake derive keys that decrypt what the other encrypts
+    void handshakeTest();
+
+    // Test that a handshake fails without the same pre-shared key, or with a forged response
+    void preSharedKeyTest();
+
+    // Test that a modified datagram doesn't decrypt
+    void tamperedDatagramTest();
+
+    // Test that a datagram only decrypts once, and that reordered ones in the window still do
+    void replayTest();
+};
+
+#endif // hifi_SecureSessionTests_h
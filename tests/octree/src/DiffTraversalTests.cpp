@@ -0,0 +1,131 @@
+//
+//  DiffTraversalTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "DiffTraversalTests.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <DiffTraversal.h>
+#include <ViewFrustum.h>
+#include <test-utils/EntityTreeTestUtils.h>
+
+QTEST_MAIN(DiffTraversalTests)
+
+namespace {
+
+const int NUM_TEST_ENTITIES = 500;
+
+EntityTreePointer createTree() {
+    auto tree = createTestEntityTree();
+    addRandomTestBoxes(tree, NUM_TEST_ENTITIES, 200.0f, 1.0f, 1.0f, 4321);
+    return tree;
+}
+
+DiffTraversal::View createView(const glm::vec3& position, float yaw) {
+    ViewFrustum viewFrustum;
+    viewFrustum.setProjection(glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 500.0f));
+    viewFrustum.setPosition(position);
+    viewFrustum.setOrientation(glm::angleAxis(yaw, glm::vec3(0.0f, 1.0f, 0.0f)));
+    viewFrustum.calculate();
+
+    DiffTraversal::View view;
+    view.viewFrustums.push_back(ConicalViewFrustum(viewFrustum));
+    return view;
+}
+
+EntityTreeElementPointer getRoot(const EntityTreePointer& tree) {
+    return std::static_pointer_cast<EntityTreeElement>(tree->getRoot());
+}
+
+void traverseToEnd(DiffTraversal& traversal) {
+    const uint64_t TIME_BUDGET = 1000000; // usecs
+    while (!traversal.finished()) {
+        traversal.traverse(TIME_BUDGET);
+    }
+}
+
+}
+
+void DiffTraversalTests::initTestCase() {
+    setUpEntityTreeDependencies();
+}
+
+void DiffTraversalTests::cleanupTestCase() {
+    tearDownEntityTreeDependencies();
+}
+
+void DiffTraversalTests::testContinueWithSmallViewChanges() {
+    auto tree = createTree();
+    DiffTraversal traversal;
+    int numScanned = 0;
+
+    QCOMPARE(traversal.prepareNewTraversal(createView(glm::vec3(0.0f), 0.0f), getRoot(tree)), DiffTraversal::First);
+    traversal.setScanCallback([&](DiffTraversal::VisibleElement& next) {
+        numScanned++;
+    });
+    // no budget, so one element at a time
+    traversal.traverse(0);
+    QVERIFY(!traversal.finished());
+
+    // a user in an HMD moves a little every frame
+    for (int frame = 1; !traversal.finished(); frame++) {
+        QVERIFY(traversal.continueWithView(createView(glm::vec3(0.0001f * (float)frame, 0.0f, 0.0f), 0.0f)));
+        traversal.traverse(0);
+    }
+    QVERIFY(numScanned > 0);
+
+    // the traversal is done, so there's nothing to continue
+    QVERIFY(!traversal.continueWithView(createView(glm::vec3(0.0f), 0.0f)));
+
+    // the view hardly changed, so the next traversal only looks for changes
+    QCOMPARE(traversal.prepareNewTraversal(createView(glm::vec3(0.5f, 0.0f, 0.0f), 0.0f), getRoot(tree)), DiffTraversal::Repeat);
+}
+
+void DiffTraversalTests::testRestartAfterTeleport() {
+    auto tree = createTree();
+    DiffTraversal traversal;
+
+    traversal.prepareNewTraversal(createView(glm::vec3(0.0f), 0.0f), getRoot(tree));
+    traversal.traverse(0);
+    QVERIFY(!traversal.finished());
+    QVERIFY(!traversal.continueWithView(createView(glm::vec3(50.0f, 0.0f, 0.0f), 0.0f)));
+
+    // and it doesn't matter how many small steps got there
+    traversal.prepareNewTraversal(createView(glm::vec3(0.0f), 0.0f), getRoot(tree));
+    traversal.traverse(0);
+    bool continued = true;
+    for (float x = 1.0f; x < 10.0f && continued; x += 1.0f) {
+        continued = traversal.continueWithView(createView(glm::vec3(x, 0.0f, 0.0f), 0.0f));
+    }
+    QVERIFY(!continued);
+}
+
+void DiffTraversalTests::testDifferentialAfterTurnDuringTraversal() {
+    auto tree = createTree();
+    DiffTraversal traversal;
+    const float TURN = glm::radians(45.0f);
+
+    traversal.prepareNewTraversal(createView(glm::vec3(0.0f), 0.0f), getRoot(tree));
+    traverseToEnd(traversal);
+    QCOMPARE(traversal.prepareNewTraversal(createView(glm::vec3(0.0f), 0.0f), getRoot(tree)), DiffTraversal::Repeat);
+    traverseToEnd(traversal);
+
+    // the elements passed before the turn were culled against the old direction, so they have to be looked at again
+    QCOMPARE(traversal.prepareNewTraversal(createView(glm::vec3(0.0f), 0.0f), getRoot(tree), true), DiffTraversal::First);
+    traversal.traverse(0);
+    QVERIFY(traversal.continueWithView(createView(glm::vec3(0.0f), TURN)));
+    traverseToEnd(traversal);
+    QCOMPARE(traversal.prepareNewTraversal(createView(glm::vec3(0.0f), TURN), getRoot(tree)), DiffTraversal::Differential);
+    traverseToEnd(traversal);
+
+    // once a whole traversal has seen that view, a Repeat is enough
+    QCOMPARE(traversal.prepareNewTraversal(createView(glm::vec3(0.0f), TURN), getRoot(tree)), DiffTraversal::Repeat);
+}
@@ -0,0 +1,29 @@
+//
+//  DiffTraversalTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_DiffTraversalTests_h
+#define hifi_DiffTraversalTests_h
+
+#include <QtTest/QtTest>
+
+class DiffTraversalTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testContinueWithSmallViewChanges();
+    void testRestartAfterTeleport();
+    void testDifferentialAfterTurnDuringTraversal();
+};
+
+#endif // hifi_DiffTraversalTests_h
@@ -0,0 +1,242 @@
+//
+//  EntityEditDeltasTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditDeltasTests.h"
+
+#include <EntityEditDeltas.h>
+#include <EntityItemProperties.h>
+
+QTEST_MAIN(EntityEditDeltasTests)
+
+namespace {
+
+const int EDIT_BUFFER_SIZE = 1400;
+const quint64 FRAME_USECS = 16 * USECS_PER_MSEC;
+const QUuid SENDER_ID("{2bfc9baa-6d8e-4be6-b0a9-0f8bb3953c3e}");
+
+struct SentEdit {
+    bool valid { false };
+    bool deltasApplied { false };
+    int size { 0 };
+    EntityEditEncoding encoding;
+    EntityItemProperties properties;
+};
+
+// encodes an edit the way EntityEditPacketSender does, and decodes it the way the entity server does
+SentEdit sendEdit(EntityEditDeltaEncoder& encoder, EntityEditDeltaDecoder* decoder, const EntityItemID& entityID,
+                  const EntityItemProperties& properties, quint64 now, bool allowCompression = true) {
+    EntityPropertyFlags requestedProperties = properties.getChangedProperties();
+    EntityEditEncoding encoding = encoder.encode(entityID, properties, requestedProperties, now);
+    encoding.allowCompression = allowCompression;
+
+    QByteArray buffer(EDIT_BUFFER_SIZE, 0);
+    EntityPropertyFlags didntFitProperties;
+    OctreeElement::AppendState appendState = EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit, entityID,
+        properties, buffer, requestedProperties, didntFitProperties, encoding);
+
+    SentEdit sent;
+    sent.size = buffer.size();
+    int processedBytes = 0;
+    EntityItemID decodedID;
+    bool valid = EntityItemProperties::decodeEntityEditPacket((const unsigned char*)buffer.constData(), buffer.size(),
+                                                              processedBytes, decodedID, sent.properties, &sent.encoding);
+    sent.valid = valid && appendState == OctreeElement::COMPLETED && processedBytes == buffer.size() && decodedID == entityID;
+    if (decoder) {
+        sent.deltasApplied = decoder->decode(SENDER_ID, entityID, sent.encoding, sent.properties, now);
+    }
+    return sent;
+}
+
+EntityItemProperties motionProperties(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& velocity,
+                                      const glm::vec3& angularVelocity) {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(position);
+    properties.setRotation(rotation);
+    properties.setVelocity(velocity);
+    properties.setAngularVelocity(angularVelocity);
+    return properties;
+}
+
+void compareVectors(const glm::vec3& actual, const glm::vec3& expected, float tolerance) {
+    QVERIFY(glm::length(actual - expected) <= tolerance);
+}
+
+}
+
+void EntityEditDeltasTests::testRotationDeltaPacking() {
+    const float ROTATION_TOLERANCE = 0.001f;
+    const glm::vec3 AXES[] = { glm::vec3(1.0f, 0.0f, 0.0f), glm::normalize(glm::vec3(1.0f, -2.0f, 0.5f)),
+                               glm::normalize(glm::vec3(-0.3f, 0.2f, -1.0f)) };
+    for (const auto& axis : AXES) {
+        for (float angle = -0.2f; angle <= 0.2f; angle += 0.05f) {
+            glm::quat delta = glm::angleAxis(angle, axis);
+            uint32_t packed;
+            QVERIFY(EntityEditEncoding::quantizeRotationDelta(delta, packed));
+            glm::quat unpacked = EntityEditEncoding::unquantizeRotationDelta(packed);
+            QVERIFY(fabsf(glm::dot(unpacked, delta)) > 1.0f - ROTATION_TOLERANCE);
+        }
+    }
+
+    // -q is the same rotation as q
+    uint32_t packed;
+    QVERIFY(EntityEditEncoding::quantizeRotationDelta(-glm::angleAxis(0.1f, AXES[1]), packed));
+
+    // more than about 28 degrees is out of range
+    QVERIFY(!EntityEditEncoding::quantizeRotationDelta(glm::angleAxis(1.0f, AXES[1]), packed));
+}
+
+void EntityEditDeltasTests::testMotionDeltasRoundTrip() {
+    EntityEditDeltaEncoder encoder;
+    EntityEditDeltaDecoder decoder;
+    EntityItemID entityID(QUuid::createUuid());
+    quint64 now = usecTimestampNow();
+
+    glm::vec3 position(12.0f, 3.5f, -40.0f);
+    glm::quat rotation = glm::angleAxis(1.2f, glm::normalize(glm::vec3(0.0f, 1.0f, 0.3f)));
+    glm::vec3 velocity(2.0f, 0.0f, -1.0f);
+    glm::vec3 angularVelocity(0.0f, 0.5f, 0.0f);
+
+    SentEdit keyframe = sendEdit(encoder, &decoder, entityID, motionProperties(position, rotation, velocity, angularVelocity), now);
+    QVERIFY(keyframe.valid);
+    QVERIFY(keyframe.encoding.isKeyframe());
+    QVERIFY(keyframe.deltasApplied);
+    QCOMPARE(keyframe.properties.getPosition(), position);
+    QCOMPARE(keyframe.properties.getVelocity(), velocity);
+
+    // a few frames of an object being carried
+    const float POSITION_TOLERANCE = EntityEditEncoding::LINEAR_DELTA_STEP;
+    for (int frame = 1; frame < 10; frame++) {
+        now += FRAME_USECS;
+        glm::vec3 nextPosition = position + (float)frame * glm::vec3(0.033f, 0.001f, -0.017f);
+        glm::quat nextRotation = glm::angleAxis(0.02f * (float)frame, glm::vec3(1.0f, 0.0f, 0.0f)) * rotation;
+        glm::vec3 nextVelocity = velocity + (float)frame * glm::vec3(0.1f, -0.05f, 0.0f);
+        glm::vec3 nextAngularVelocity = angularVelocity * (1.0f - 0.1f * (float)frame);
+
+        SentEdit delta = sendEdit(encoder, &decoder, entityID,
+                                  motionProperties(nextPosition, nextRotation, nextVelocity, nextAngularVelocity), now);
+        QVERIFY(delta.valid);
+        QVERIFY(delta.encoding.hasMotionDeltas());
+        QCOMPARE(delta.encoding.keyframeID, keyframe.encoding.keyframeID);
+        QVERIFY(delta.deltasApplied);
+        QVERIFY(delta.size < keyframe.size);
+
+        QVERIFY(delta.properties.positionChanged());
+        compareVectors(delta.properties.getPosition(), nextPosition, POSITION_TOLERANCE);
+        QVERIFY(fabsf(glm::dot(delta.properties.getRotation(), nextRotation)) > 0.9999f);
+        compareVectors(delta.properties.getVelocity(), nextVelocity, POSITION_TOLERANCE);
+        compareVectors(delta.properties.getAngularVelocity(), nextAngularVelocity, POSITION_TOLERANCE);
+    }
+}
+
+void EntityEditDeltasTests::testNewKeyframeWhenOutOfRange() {
+    EntityEditDeltaEncoder encoder;
+    EntityEditDeltaDecoder decoder;
+    EntityItemID entityID(QUuid::createUuid());
+    quint64 now = usecTimestampNow();
+    glm::quat rotation;
+
+    SentEdit first = sendEdit(encoder, &decoder, entityID, motionProperties(glm::vec3(0.0f), rotation, glm::vec3(0.0f), glm::vec3(0.0f)), now);
+    QVERIFY(first.encoding.isKeyframe());
+
+    // too far to reach with a delta
+    now += FRAME_USECS;
+    glm::vec3 farAway(2.0f * EntityEditEncoding::MAX_LINEAR_DELTA, 0.0f, 0.0f);
+    SentEdit far = sendEdit(encoder, &decoder, entityID, motionProperties(farAway, rotation, glm::vec3(0.0f), glm::vec3(0.0f)), now);
+    QVERIFY(far.valid);
+    QVERIFY(far.encoding.isKeyframe());
+    QVERIFY(far.encoding.keyframeID != first.encoding.keyframeID);
+    QCOMPARE(far.properties.getPosition(), farAway);
+
+    // and a new keyframe at least every interval
+    now += EntityEditDeltaEncoder::KEYFRAME_INTERVAL_USECS;
+    SentEdit later = sendEdit(encoder, &decoder, entityID, motionProperties(farAway, rotation, glm::vec3(0.0f), glm::vec3(0.0f)), now);
+    QVERIFY(later.encoding.isKeyframe());
+
+    // a motion property that isn't in the keyframe also needs a new one
+    now += FRAME_USECS;
+    EntityItemProperties positionOnly;
+    positionOnly.setType(EntityTypes::Box);
+    positionOnly.setPosition(farAway);
+    SentEdit positionKeyframe = sendEdit(encoder, &decoder, entityID, positionOnly, now);
+    QVERIFY(positionKeyframe.encoding.isKeyframe());
+    now += FRAME_USECS;
+    SentEdit withRotation = sendEdit(encoder, &decoder, entityID, motionProperties(farAway, rotation, glm::vec3(0.0f), glm::vec3(0.0f)), now);
+    QVERIFY(withRotation.encoding.isKeyframe());
+}
+
+void EntityEditDeltasTests::testDeltasAgainstLostKeyframe() {
+    EntityEditDeltaEncoder encoder;
+    EntityEditDeltaDecoder decoder;
+    EntityItemID entityID(QUuid::createUuid());
+    quint64 now = usecTimestampNow();
+    glm::quat rotation;
+
+    // the keyframe never arrives
+    SentEdit lost = sendEdit(encoder, nullptr, entityID, motionProperties(glm::vec3(1.0f), rotation, glm::vec3(0.0f), glm::vec3(0.0f)), now);
+    QVERIFY(lost.encoding.isKeyframe());
+
+    now += FRAME_USECS;
+    SentEdit delta = sendEdit(encoder, &decoder, entityID, motionProperties(glm::vec3(1.1f), rotation, glm::vec3(0.0f), glm::vec3(0.0f)), now);
+    QVERIFY(delta.valid);
+    QVERIFY(delta.encoding.hasMotionDeltas());
+    QVERIFY(!delta.deltasApplied);
+    QVERIFY(!delta.properties.positionChanged());
+
+    // a sender's keyframes are dropped when it disconnects
+    EntityEditDeltaEncoder otherEncoder;
+    EntityEditDeltaDecoder otherDecoder;
+    sendEdit(otherEncoder, &otherDecoder, entityID, motionProperties(glm::vec3(1.0f), rotation, glm::vec3(0.0f), glm::vec3(0.0f)), now);
+    otherDecoder.removeSender(SENDER_ID);
+    now += FRAME_USECS;
+    SentEdit afterRemoval = sendEdit(otherEncoder, &otherDecoder, entityID,
+                                     motionProperties(glm::vec3(1.1f), rotation, glm::vec3(0.0f), glm::vec3(0.0f)), now);
+    QVERIFY(afterRemoval.encoding.hasMotionDeltas());
+    QVERIFY(!afterRemoval.deltasApplied);
+}
+
+void EntityEditDeltasTests::testCompressedProperties() {
+    EntityEditDeltaEncoder encoder;
+    EntityItemID entityID(QUuid::createUuid());
+
+    // the kind of userData that scripts keep rewriting
+    QString userData = "{";
+    for (int i = 0; i < 20; i++) {
+        userData += QString("\"grabbableKey%1\":{\"grabbable\":true,\"triggerable\":false,\"cloneable\":false},").arg(i);
+    }
+    userData += "\"version\":1}";
+
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setUserData(userData);
+    properties.setName("compressed");
+
+    SentEdit compressed = sendEdit(encoder, nullptr, entityID, properties, usecTimestampNow());
+    QVERIFY(compressed.valid);
+    QVERIFY(compressed.encoding.flags & EntityEditEncoding::COMPRESSED);
+    QVERIFY(compressed.size < userData.size());
+    QCOMPARE(compressed.properties.getUserData(), userData);
+    QCOMPARE(compressed.properties.getName(), QString("compressed"));
+
+    SentEdit uncompressed = sendEdit(encoder, nullptr, entityID, properties, usecTimestampNow(), false);
+    QVERIFY(uncompressed.valid);
+    QVERIFY(!(uncompressed.encoding.flags & EntityEditEncoding::COMPRESSED));
+    QVERIFY(uncompressed.size > compressed.size);
+    QCOMPARE(uncompressed.properties.getUserData(), userData);
+
+    // small edits aren't worth compressing
+    EntityItemProperties small;
+    small.setType(EntityTypes::Box);
+    small.setName("small");
+    SentEdit smallEdit = sendEdit(encoder, nullptr, entityID, small, usecTimestampNow());
+    QVERIFY(smallEdit.valid);
+    QVERIFY(!(smallEdit.encoding.flags & EntityEditEncoding::COMPRESSED));
+}
@@ -0,0 +1,28 @@
+//
+//  EntityEditDeltasTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityEditDeltasTests_h
+#define hifi_EntityEditDeltasTests_h
+
+#include <QtTest/QtTest>
+
+class EntityEditDeltasTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRotationDeltaPacking();
+    void testMotionDeltasRoundTrip();
+    void testNewKeyframeWhenOutOfRange();
+    void testDeltasAgainstLostKeyframe();
+    void testCompressedProperties();
+};
+
+#endif // hifi_EntityEditDeltasTests_h
@@ -0,0 +1,142 @@
+//
+//  EntityPropertyTableTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityPropertyTableTests.h"
+
+#include <vector>
+
+#include <EntityEditDeltas.h>
+#include <EntityItemProperties.h>
+#include <EntityPropertyTable.h>
+
+QTEST_MAIN(EntityPropertyTableTests)
+
+namespace {
+
+const int EDIT_BUFFER_SIZE = 1400;
+const EntityItemID ENTITY_ID(QUuid("{6a1c5be4-3c1e-4f0a-9d51-7b0f4c6ad0a2}"));
+
+QByteArray encodeEdit(const EntityItemProperties& properties, const EntityPropertyFlags& requestedProperties) {
+    QByteArray buffer(EDIT_BUFFER_SIZE, 0);
+    EntityPropertyFlags didntFitProperties;
+    EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit, ENTITY_ID, properties, buffer, requestedProperties,
+                                                 didntFitProperties, EntityEditEncoding());
+    return buffer;
+}
+
+bool decodeEdit(const QByteArray& buffer, EntityItemProperties& properties) {
+    int processedBytes = 0;
+    EntityItemID entityID;
+    bool valid = EntityItemProperties::decodeEntityEditPacket((const unsigned char*)buffer.constData(), buffer.size(),
+                                                              processedBytes, entityID, properties, nullptr);
+    return valid && processedBytes == buffer.size() && entityID == ENTITY_ID;
+}
+
+EntityItemProperties baseProperties() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setLastEdited(1234567);
+    properties.setName("table");
+    properties.setPosition(glm::vec3(1.0f, -2.0f, 30.0f));
+    properties.setRotation(glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f)));
+    properties.setVelocity(glm::vec3(0.0f, -9.8f, 0.0f));
+    properties.setRenderLayer(RenderLayer::FRONT);
+    properties.getGrab().setGrabbable(false);
+    properties.getGrab().setEquippableIndicatorURL("http://example.com/indicator.fbx");
+    properties.setStaticCertificateVersion(3);
+    return properties;
+}
+
+void compareBaseProperties(const EntityItemProperties& actual, const EntityItemProperties& expected) {
+    QCOMPARE(actual.getName(), expected.getName());
+    QCOMPARE(actual.getPosition(), expected.getPosition());
+    QVERIFY(actual.getRotation() == expected.getRotation());
+    QCOMPARE(actual.getVelocity(), expected.getVelocity());
+    QVERIFY(actual.getRenderLayer() == expected.getRenderLayer());
+    QCOMPARE(actual.getGrab().getGrabbable(), expected.getGrab().getGrabbable());
+    QCOMPARE(actual.getGrab().getEquippableIndicatorURL(), expected.getGrab().getEquippableIndicatorURL());
+    QCOMPARE(actual.getStaticCertificateVersion(), expected.getStaticCertificateVersion());
+    QVERIFY(!actual.dimensionsChanged());
+}
+
+}
+
+void EntityPropertyTableTests::testFlagIteration() {
+    EntityPropertyFlags flags;
+    flags += PROP_TEXTURES;
+    flags += PROP_SIMULATION_OWNER;
+    flags += PROP_VELOCITY;
+    flags += PROP_POSITION;
+
+    std::vector<EntityPropertyList> iterated;
+    flags.forEachFlag([&](EntityPropertyList property) {
+        iterated.push_back(property);
+    });
+    std::vector<EntityPropertyList> expected { PROP_SIMULATION_OWNER, PROP_POSITION, PROP_VELOCITY, PROP_TEXTURES };
+    QVERIFY(iterated == expected);
+
+    QVERIFY(!flags.isSubsetOf(EntityPropertyTable::getProperties()));
+    flags -= PROP_TEXTURES;
+    QVERIFY(flags.isSubsetOf(EntityPropertyTable::getProperties()));
+    QVERIFY(EntityPropertyFlags().isSubsetOf(flags));
+
+    // the properties that aren't sent over the wire aren't in the table
+    QVERIFY(!EntityPropertyTable::getProperties().getHasProperty(PROP_ENTITY_HOST_TYPE));
+    QVERIFY(!EntityPropertyTable::getProperties().getHasProperty(PROP_LOCAL_POSITION));
+    QVERIFY(EntityPropertyTable::getEntry(PROP_VELOCITY).property == PROP_VELOCITY);
+
+    EntityPropertyFlags others;
+    others += PROP_POSITION;
+    others += PROP_TEXTURES;
+    flags -= others;
+    QVERIFY(!flags.getHasProperty(PROP_POSITION));
+    QVERIFY(flags.getHasProperty(PROP_VELOCITY));
+    flags += others;
+    QVERIFY(flags.getHasProperty(PROP_POSITION));
+    QVERIFY(flags.getHasProperty(PROP_TEXTURES));
+    flags -= flags;
+    QVERIFY(!flags.getHasProperty(PROP_VELOCITY));
+}
+
+void EntityPropertyTableTests::testBaseEditRoundTrip() {
+    EntityItemProperties properties = baseProperties();
+    EntityPropertyFlags requestedProperties = properties.getChangedProperties();
+    QVERIFY(requestedProperties.isSubsetOf(EntityPropertyTable::getProperties()));
+
+    EntityItemProperties decoded;
+    QVERIFY(decodeEdit(encodeEdit(properties, requestedProperties), decoded));
+    compareBaseProperties(decoded, properties);
+    QVERIFY(decoded.getChangedProperties() == requestedProperties);
+}
+
+void EntityPropertyTableTests::testTableMatchesFullEncoding() {
+    EntityItemProperties properties = baseProperties();
+    EntityPropertyFlags requestedProperties = properties.getChangedProperties();
+    QByteArray fromTable = encodeEdit(properties, requestedProperties);
+
+    // a property that isn't sent over the wire sends the edit down the full walk of every property, which writes the same
+    QByteArray fromFullEncoding = encodeEdit(properties, requestedProperties + PROP_VISIBLE_IN_SECONDARY_CAMERA);
+    QCOMPARE(fromTable, fromFullEncoding);
+}
+
+void EntityPropertyTableTests::testMixedEditRoundTrip() {
+    EntityItemProperties properties = baseProperties();
+    properties.setColor(glm::u8vec3(10, 20, 30));
+    properties.setAlpha(0.5f);
+    EntityPropertyFlags requestedProperties = properties.getChangedProperties();
+    QVERIFY(!requestedProperties.isSubsetOf(EntityPropertyTable::getProperties()));
+
+    EntityItemProperties decoded;
+    QVERIFY(decodeEdit(encodeEdit(properties, requestedProperties), decoded));
+    compareBaseProperties(decoded, properties);
+    QVERIFY(decoded.getColor() == properties.getColor());
+    QCOMPARE(decoded.getAlpha(), properties.getAlpha());
+}
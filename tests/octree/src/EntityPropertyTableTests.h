@@ -0,0 +1,27 @@
+//
+//  EntityPropertyTableTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityPropertyTableTests_h
+#define hifi_EntityPropertyTableTests_h
+
+#include <QtTest/QtTest>
+
+class EntityPropertyTableTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testFlagIteration();
+    void testBaseEditRoundTrip();
+    void testTableMatchesFullEncoding();
+    void testMixedEditRoundTrip();
+};
+
+#endif // hifi_EntityPropertyTableTests_h
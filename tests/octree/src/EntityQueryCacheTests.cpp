@@ -0,0 +1,148 @@
+//
+//  EntityQueryCacheTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityQueryCacheTests.h"
+
+#include <EntityQueryCache.h>
+#include <test-utils/EntityTreeTestUtils.h>
+
+QTEST_MAIN(EntityQueryCacheTests)
+
+namespace {
+
+const glm::vec3 NEAR_POSITION(10.0f, 0.0f, 0.0f);
+const glm::vec3 FAR_POSITION(-200.0f, 0.0f, 0.0f);
+const float QUERY_RADIUS = 5.0f;
+
+EntityItemID addBox(const EntityTreePointer& tree, const glm::vec3& position) {
+    return addTestEntity(tree, EntityTypes::Box, position);
+}
+
+void moveBox(const EntityTreePointer& tree, const EntityItemID& id, const glm::vec3& position) {
+    EntityItemProperties properties;
+    properties.setPosition(position);
+    tree->withWriteLock([&] {
+        tree->updateEntity(id, properties);
+    });
+}
+
+QVector<QUuid> findNear(const EntityTreePointer& tree) {
+    QVector<QUuid> found;
+    tree->withReadLock([&] {
+        tree->evalEntitiesInSphere(NEAR_POSITION, QUERY_RADIUS, PickFilter(), found);
+    });
+    return found;
+}
+
+}
+
+void EntityQueryCacheTests::initTestCase() {
+    setUpEntityTreeDependencies();
+    EntityQueryCache::setEnabled(true);
+}
+
+void EntityQueryCacheTests::testRepeatedQueryHits() {
+    auto tree = createTestEntityTree();
+    auto id = addBox(tree, NEAR_POSITION);
+
+    const auto& cache = tree->getQueryCache();
+    uint64_t hits = cache.getNumHits();
+    auto first = findNear(tree);
+    auto second = findNear(tree);
+    QCOMPARE(first.size(), 1);
+    QCOMPARE(first.front(), (QUuid)id);
+    QCOMPARE(second, first);
+    QCOMPARE(cache.getNumHits(), hits + 1);
+
+    QUuid closest;
+    tree->withReadLock([&] {
+        closest = tree->evalClosestEntity(NEAR_POSITION, QUERY_RADIUS, PickFilter());
+        closest = tree->evalClosestEntity(NEAR_POSITION, QUERY_RADIUS, PickFilter());
+    });
+    QCOMPARE(closest, (QUuid)id);
+    QCOMPARE(cache.getNumHits(), hits + 2);
+}
+
+void EntityQueryCacheTests::testChangeInRegion() {
+    auto tree = createTestEntityTree();
+    auto id = addBox(tree, NEAR_POSITION);
+    QCOMPARE(findNear(tree).size(), 1);
+
+    // moving the entity out, adding one in and deleting it all show up in the next query
+    moveBox(tree, id, FAR_POSITION);
+    QCOMPARE(findNear(tree).size(), 0);
+
+    auto other = addBox(tree, NEAR_POSITION + glm::vec3(1.0f));
+    QCOMPARE(findNear(tree).size(), 1);
+
+    tree->withWriteLock([&] {
+        tree->deleteEntity(other, true);
+    });
+    QCOMPARE(findNear(tree).size(), 0);
+
+    moveBox(tree, id, NEAR_POSITION);
+    QCOMPARE(findNear(tree).size(), 1);
+}
+
+void EntityQueryCacheTests::testChangeElsewhere() {
+    auto tree = createTestEntityTree();
+    addBox(tree, NEAR_POSITION);
+    auto far = addBox(tree, FAR_POSITION);
+
+    const auto& cache = tree->getQueryCache();
+    findNear(tree);
+    uint64_t hits = cache.getNumHits();
+
+    // a change far away leaves the result cached
+    moveBox(tree, far, FAR_POSITION + glm::vec3(0.0f, 1.0f, 0.0f));
+    QCOMPARE(findNear(tree).size(), 1);
+    QCOMPARE(cache.getNumHits(), hits + 1);
+}
+
+void EntityQueryCacheTests::testChangesWhileQuerying() {
+    EntityQueryCache cache;
+    auto query = EntityQueryCache::sphereQuery(EntityQueryCache::SPHERE, NEAR_POSITION, QUERY_RADIUS, PickFilter());
+    QVector<QUuid> results { QUuid::createUuid() };
+
+    // a change in the region after the query started keeps its result out
+    uint64_t changeCount = cache.getChangeCount();
+    cache.invalidate(AABox(NEAR_POSITION, glm::vec3(1.0f)));
+    cache.insert(query, results, changeCount);
+    QVector<QUuid> found;
+    QVERIFY(!cache.find(query, found));
+
+    // but one elsewhere doesn't
+    changeCount = cache.getChangeCount();
+    cache.invalidate(AABox(FAR_POSITION, glm::vec3(1.0f)));
+    cache.insert(query, results, changeCount);
+    QVERIFY(cache.find(query, found));
+    QCOMPARE(found, results);
+
+    // nor does clearing let a result from before it in
+    changeCount = cache.getChangeCount();
+    cache.clear();
+    cache.insert(query, results, changeCount);
+    QVERIFY(!cache.find(query, found));
+}
+
+void EntityQueryCacheTests::testDisabled() {
+    EntityQueryCache::setEnabled(false);
+    auto tree = createTestEntityTree();
+    addBox(tree, NEAR_POSITION);
+
+    const auto& cache = tree->getQueryCache();
+    findNear(tree);
+    findNear(tree);
+    QCOMPARE(cache.getNumHits(), (uint64_t)0);
+    QCOMPARE(cache.getNumMisses(), (uint64_t)0);
+    QVERIFY(cache.isEmpty());
+    EntityQueryCache::setEnabled(true);
+}
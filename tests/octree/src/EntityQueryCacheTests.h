@@ -0,0 +1,29 @@
+//
+//  EntityQueryCacheTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityQueryCacheTests_h
+#define hifi_EntityQueryCacheTests_h
+
+#include <QtTest/QtTest>
+
+class EntityQueryCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testRepeatedQueryHits();
+    void testChangeInRegion();
+    void testChangeElsewhere();
+    void testChangesWhileQuerying();
+    void testDisabled();
+};
+
+#endif // hifi_EntityQueryCacheTests_h
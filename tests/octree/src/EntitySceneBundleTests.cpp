@@ -0,0 +1,183 @@
+//
+//  EntitySceneBundleTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySceneBundleTests.h"
+
+#include <random>
+
+#include <QtCore/QDataStream>
+
+#include <EntitySceneBundle.h>
+#include <test-utils/EntityTreeTestUtils.h>
+
+QTEST_MAIN(EntitySceneBundleTests)
+
+namespace {
+
+const float SCENE_SIZE = 200.0f;
+const int NUM_TEST_ENTITIES = 500;
+const float TEST_CHUNK_SCALE = 32.0f;
+
+EntityTreePointer createTree(int numEntities) {
+    auto tree = createTestEntityTree();
+
+    // the same scene every run
+    std::mt19937 generator(1234);
+    std::uniform_real_distribution<float> position(-0.5f * SCENE_SIZE, 0.5f * SCENE_SIZE);
+    std::uniform_real_distribution<float> size(0.25f, 4.0f);
+    for (int i = 0; i < numEntities; i++) {
+        EntityItemProperties properties;
+        properties.setType(EntityTypes::Box);
+        properties.setName(QString("box %1").arg(i));
+        properties.setPosition(glm::vec3(position(generator), position(generator), position(generator)));
+        properties.setDimensions(glm::vec3(size(generator), size(generator), size(generator)));
+        tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+    }
+    return tree;
+}
+
+QHash<QUuid, EntityItemPointer> getEntities(const EntityTreePointer& tree) {
+    QHash<QUuid, EntityItemPointer> entities;
+    tree->withReadLock([&] {
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+            std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](const EntityItemPointer& entity) {
+                entities[entity->getID()] = entity;
+            });
+            return true;
+        }, nullptr);
+    });
+    return entities;
+}
+
+EntityTreePointer readBundle(const EntitySceneBundle& bundle) {
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    for (const auto& chunk : bundle.chunks) {
+        bool isRead = false;
+        tree->withWriteLock([&] {
+            isRead = bundle.readChunk(chunk, *tree, SharedNodePointer());
+        });
+        if (!isRead) {
+            return nullptr;
+        }
+    }
+    return tree;
+}
+
+}
+
+void EntitySceneBundleTests::initTestCase() {
+    setUpEntityTreeDependencies();
+}
+
+void EntitySceneBundleTests::cleanupTestCase() {
+    tearDownEntityTreeDependencies();
+}
+
+void EntitySceneBundleTests::testEncodeChunks() {
+    auto tree = createTree(NUM_TEST_ENTITIES);
+    QSet<QUuid> entityIDs;
+    EntitySceneBundle bundle = EntitySceneBundle::encode(tree, TEST_CHUNK_SCALE, &entityIDs);
+
+    QVERIFY(bundle.version > 0);
+    QVERIFY(bundle.chunks.size() > 1);
+    QCOMPARE(bundle.getNumEntities(), (uint32_t)NUM_TEST_ENTITIES);
+    QCOMPARE(entityIDs.size(), NUM_TEST_ENTITIES);
+
+    // every entity is in the cube of its chunk, and in no other
+    auto entities = getEntities(tree);
+    for (const auto& chunk : bundle.chunks) {
+        QVERIFY(chunk.numEntities > 0);
+        EntitySceneBundle single;
+        single.chunks.push_back(chunk);
+        auto client = readBundle(single);
+        QVERIFY(client);
+        auto chunkEntities = getEntities(client);
+        QCOMPARE((uint32_t)chunkEntities.size(), chunk.numEntities);
+        for (const auto& entity : chunkEntities) {
+            QVERIFY(entityIDs.contains(entity->getID()));
+            QVERIFY(chunk.cube.contains(entities.value(entity->getID())->getQueryAACube()));
+        }
+    }
+}
+
+void EntitySceneBundleTests::testRoundTrip() {
+    auto tree = createTree(NUM_TEST_ENTITIES);
+    EntitySceneBundle bundle = EntitySceneBundle::encode(tree, TEST_CHUNK_SCALE);
+
+    EntitySceneBundle loaded;
+    QVERIFY(loaded.fromByteArray(bundle.toByteArray()));
+    QCOMPARE(loaded.version, bundle.version);
+    QCOMPARE(loaded.chunks.size(), bundle.chunks.size());
+    for (size_t i = 0; i < loaded.chunks.size(); i++) {
+        QCOMPARE(loaded.chunks[i].cube, bundle.chunks[i].cube);
+        QCOMPARE(loaded.chunks[i].sections, bundle.chunks[i].sections);
+    }
+
+    auto client = readBundle(loaded);
+    QVERIFY(client);
+    auto expected = getEntities(tree);
+    auto actual = getEntities(client);
+    QCOMPARE(actual.size(), expected.size());
+    for (const auto& entity : actual) {
+        auto original = expected.value(entity->getID());
+        QVERIFY(original);
+        QCOMPARE(entity->getType(), original->getType());
+        QCOMPARE(entity->getName(), original->getName());
+        QCOMPARE(entity->getWorldPosition(), original->getWorldPosition());
+        QCOMPARE(entity->getScaledDimensions(), original->getScaledDimensions());
+    }
+}
+
+void EntitySceneBundleTests::testChunkOrder() {
+    auto tree = createTree(NUM_TEST_ENTITIES);
+    EntitySceneBundle bundle = EntitySceneBundle::encode(tree, TEST_CHUNK_SCALE);
+
+    glm::vec3 position(0.4f * SCENE_SIZE, 0.0f, -0.4f * SCENE_SIZE);
+    auto order = bundle.getChunkOrder(position);
+    QCOMPARE(order.size(), bundle.chunks.size());
+
+    float lastDistance = 0.0f;
+    for (size_t index : order) {
+        const AACube& cube = bundle.chunks[index].cube;
+        glm::vec3 nearestPoint = glm::clamp(position, cube.getCorner(), cube.getCorner() + glm::vec3(cube.getScale()));
+        float distance = glm::distance(position, nearestPoint);
+        QVERIFY(distance >= lastDistance);
+        lastDistance = distance;
+    }
+}
+
+void EntitySceneBundleTests::testRejectsBadData() {
+    auto tree = createTree(50);
+    EntitySceneBundle bundle = EntitySceneBundle::encode(tree, TEST_CHUNK_SCALE);
+    QByteArray data = bundle.toByteArray();
+
+    EntitySceneBundle loaded;
+    QVERIFY(!loaded.fromByteArray(QByteArray()));
+    QVERIFY(!loaded.fromByteArray(QByteArray("not a scene bundle")));
+    QVERIFY(!loaded.fromByteArray(data.left(data.size() - 1)));
+    QVERIFY(!loaded.fromByteArray(data + QByteArray(1, 0)));
+    QVERIFY(loaded.chunks.empty());
+
+    // another format version
+    QByteArray otherFormat = data;
+    {
+        QDataStream stream(&otherFormat, QIODevice::ReadWrite);
+        stream.skipRawData(sizeof(quint32));
+        stream << (quint32)0;
+    }
+    QVERIFY(!loaded.fromByteArray(otherFormat));
+
+    // a chunk whose section runs past its end
+    EntitySceneBundle corrupt = bundle;
+    corrupt.chunks[0].sections = qCompress(QByteArray("\xff\x00" "abcde", 7));
+    QVERIFY(!readBundle(corrupt));
+}
@@ -0,0 +1,30 @@
+//
+//  EntitySceneBundleTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitySceneBundleTests_h
+#define hifi_EntitySceneBundleTests_h
+
+#include <QtTest/QtTest>
+
+class EntitySceneBundleTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testEncodeChunks();
+    void testRoundTrip();
+    void testChunkOrder();
+    void testRejectsBadData();
+};
+
+#endif // hifi_EntitySceneBundleTests_h
@@ -0,0 +1,220 @@
+//
+//  EntityTreeBVHTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTreeBVHTests.h"
+
+#include <MovingEntitiesOperator.h>
+#include <test-utils/EntityTreeTestUtils.h>
+
+QTEST_MAIN(EntityTreeBVHTests)
+
+namespace {
+
+const float SCENE_SIZE = 200.0f;
+const int NUM_TEST_ENTITIES = 2000;
+const int NUM_TEST_RAYS = 256;
+const float DISTANCE_TOLERANCE = 0.001f;
+
+EntityTreePointer createTree(int numEntities) {
+    auto tree = createTestEntityTree();
+    addRandomTestBoxes(tree, numEntities, SCENE_SIZE, 0.25f, 4.0f, 1234);
+    return tree;
+}
+
+std::vector<PickRay> createRays(int numRays) {
+    // rays out from a few viewpoints, like the laser pointers of several users
+    std::mt19937 generator(5678);
+    std::uniform_real_distribution<float> spread(-1.0f, 1.0f);
+    std::vector<PickRay> rays;
+    for (int i = 0; i < numRays; i++) {
+        glm::vec3 origin((float)(i % 4) * 10.0f, 0.0f, -0.6f * SCENE_SIZE);
+        glm::vec3 direction = glm::normalize(glm::vec3(spread(generator), spread(generator), 2.0f));
+        rays.push_back(PickRay(origin, direction));
+    }
+    return rays;
+}
+
+EntityTree::RayIntersection findRayIntersection(const EntityTreePointer& tree, const PickRay& ray) {
+    EntityTree::RayIntersection intersection;
+    OctreeElementPointer element;
+    intersection.entityID = tree->evalRayIntersection(ray.origin, ray.direction, QVector<EntityItemID>(),
+        QVector<EntityItemID>(), PickFilter(), element, intersection.distance, intersection.face,
+        intersection.surfaceNormal, intersection.extraInfo, Octree::Lock);
+    return intersection;
+}
+
+std::vector<EntityTree::RayIntersection> findRayIntersections(const EntityTreePointer& tree, const std::vector<PickRay>& rays) {
+    std::vector<EntityTree::RayIntersection> intersections;
+    for (const auto& ray : rays) {
+        intersections.push_back(findRayIntersection(tree, ray));
+    }
+    return intersections;
+}
+
+void compareIntersections(const std::vector<EntityTree::RayIntersection>& actual,
+                          const std::vector<EntityTree::RayIntersection>& expected) {
+    QCOMPARE(actual.size(), expected.size());
+    int numHits = 0;
+    for (size_t i = 0; i < actual.size(); i++) {
+        QCOMPARE(actual[i].entityID, expected[i].entityID);
+        if (!expected[i].entityID.isNull()) {
+            QVERIFY(fabsf(actual[i].distance - expected[i].distance) < DISTANCE_TOLERANCE);
+            numHits++;
+        }
+    }
+    // the scene is dense enough that most of the rays hit something
+    QVERIFY(numHits > (int)actual.size() / 2);
+}
+
+}
+
+void EntityTreeBVHTests::initTestCase() {
+    setUpEntityTreeDependencies();
+}
+
+void EntityTreeBVHTests::cleanupTestCase() {
+    tearDownEntityTreeDependencies();
+}
+
+void EntityTreeBVHTests::testRaysMatchOctreeWalk() {
+    auto tree = createTree(NUM_TEST_ENTITIES);
+    auto rays = createRays(NUM_TEST_RAYS);
+
+    auto expected = findRayIntersections(tree, rays);
+    tree->setPickBVHEnabled(true);
+    QVERIFY(tree->isPickBVHEnabled());
+    compareIntersections(findRayIntersections(tree, rays), expected);
+}
+
+void EntityTreeBVHTests::testRayPacketsMatchSingleRays() {
+    auto tree = createTree(NUM_TEST_ENTITIES);
+    tree->setPickBVHEnabled(true);
+    // not a multiple of the packet size, so the last packet is partly empty
+    auto rays = createRays(NUM_TEST_RAYS + 5);
+
+    auto expected = findRayIntersections(tree, rays);
+    compareIntersections(tree->evalRayIntersections(rays, QVector<EntityItemID>(), QVector<EntityItemID>(), PickFilter(),
+                                                    Octree::Lock), expected);
+
+    // and without the BVH, the batch falls back to one octree walk per ray
+    tree->setPickBVHEnabled(false);
+    compareIntersections(tree->evalRayIntersections(rays, QVector<EntityItemID>(), QVector<EntityItemID>(), PickFilter(),
+                                                    Octree::Lock), expected);
+}
+
+void EntityTreeBVHTests::testParabolasMatchOctreeWalk() {
+    auto tree = createTree(NUM_TEST_ENTITIES);
+    auto rays = createRays(NUM_TEST_RAYS);
+    const glm::vec3 GRAVITY(0.0f, -9.8f, 0.0f);
+    const float SPEED = 20.0f;
+
+    auto findParabolaIntersections = [&] {
+        std::vector<EntityTree::RayIntersection> intersections;
+        for (const auto& ray : rays) {
+            EntityTree::RayIntersection intersection;
+            OctreeElementPointer element;
+            glm::vec3 hitPoint;
+            float distance;
+            intersection.entityID = tree->evalParabolaIntersection(PickParabola(ray.origin, SPEED * ray.direction, GRAVITY),
+                QVector<EntityItemID>(), QVector<EntityItemID>(), PickFilter(), element, hitPoint, distance,
+                intersection.distance, intersection.face, intersection.surfaceNormal, intersection.extraInfo, Octree::Lock);
+            intersections.push_back(intersection);
+        }
+        return intersections;
+    };
+
+    auto expected = findParabolaIntersections();
+    tree->setPickBVHEnabled(true);
+    compareIntersections(findParabolaIntersections(), expected);
+}
+
+void EntityTreeBVHTests::testRefitAfterMove() {
+    auto tree = createTree(0);
+    tree->setPickBVHEnabled(true);
+
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setDimensions(glm::vec3(1.0f));
+    // enough entities out of the way that the BVH is built, rather than checking them one by one
+    const int NUM_OTHER_ENTITIES = 100;
+    for (int i = 0; i < NUM_OTHER_ENTITIES; i++) {
+        properties.setPosition(glm::vec3(50.0f, 0.0f, 2.0f * (float)i));
+        tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+    }
+
+    properties.setPosition(glm::vec3(0.0f, 0.0f, 10.0f));
+    EntityItemID entityID(QUuid::createUuid());
+    EntityItemPointer entity = tree->addEntity(entityID, properties);
+    QVERIFY(entity);
+
+    PickRay ahead(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
+    PickRay up(glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    QCOMPARE(findRayIntersection(tree, ahead).entityID, entityID);
+
+    // move it the way the simulation does
+    entity->setWorldPosition(glm::vec3(0.0f, 10.0f, 0.0f));
+    entity->updateQueryAACube();
+    MovingEntitiesOperator moveOperator;
+    moveOperator.addEntityToMoveList(entity, entity->getQueryAACube());
+    tree->withWriteLock([&] {
+        tree->recurseTreeWithOperator(&moveOperator);
+    });
+
+    QVERIFY(findRayIntersection(tree, ahead).entityID.isNull());
+    EntityTree::RayIntersection intersection = findRayIntersection(tree, up);
+    QCOMPARE(intersection.entityID, entityID);
+    QVERIFY(fabsf(intersection.distance - 9.5f) < DISTANCE_TOLERANCE);
+}
+
+void EntityTreeBVHTests::testDeletedEntitiesArentHit() {
+    auto tree = createTree(NUM_TEST_ENTITIES);
+    tree->setPickBVHEnabled(true);
+    auto rays = createRays(NUM_TEST_RAYS);
+
+    EntityTree::RayIntersection first = findRayIntersection(tree, rays[0]);
+    QVERIFY(!first.entityID.isNull());
+    tree->deleteEntity(first.entityID, true);
+
+    EntityTree::RayIntersection second = findRayIntersection(tree, rays[0]);
+    QVERIFY(second.entityID != first.entityID);
+    tree->setPickBVHEnabled(false);
+    QCOMPARE(findRayIntersection(tree, rays[0]).entityID, second.entityID);
+}
+
+void EntityTreeBVHTests::benchmarkRayPicks_data() {
+    QTest::addColumn<bool>("bvh");
+    QTest::addColumn<bool>("packets");
+    QTest::newRow("octree") << false << false;
+    QTest::newRow("bvh") << true << false;
+    QTest::newRow("bvh packets") << true << true;
+}
+
+void EntityTreeBVHTests::benchmarkRayPicks() {
+    QFETCH(bool, bvh);
+    QFETCH(bool, packets);
+
+    const int NUM_BENCHMARK_ENTITIES = 20000;
+    auto tree = createTree(NUM_BENCHMARK_ENTITIES);
+    tree->setPickBVHEnabled(bvh);
+    auto rays = createRays(NUM_TEST_RAYS);
+    // build the BVH before timing
+    findRayIntersection(tree, rays[0]);
+
+    if (packets) {
+        QBENCHMARK {
+            tree->evalRayIntersections(rays, QVector<EntityItemID>(), QVector<EntityItemID>(), PickFilter(), Octree::Lock);
+        }
+    } else {
+        QBENCHMARK {
+            findRayIntersections(tree, rays);
+        }
+    }
+}
@@ -0,0 +1,34 @@
+//
+//  EntityTreeBVHTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntityTreeBVHTests_h
+#define hifi_EntityTreeBVHTests_h
+
+#include <QtTest/QtTest>
+
+class EntityTreeBVHTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testRaysMatchOctreeWalk();
+    void testRayPacketsMatchSingleRays();
+    void testParabolasMatchOctreeWalk();
+    void testRefitAfterMove();
+    void testDeletedEntitiesArentHit();
+
+    void benchmarkRayPicks_data();
+    void benchmarkRayPicks();
+};
+
+#endif // hifi_EntityTreeBVHTests_h
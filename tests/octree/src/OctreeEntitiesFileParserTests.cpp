@@ -0,0 +1,91 @@
+//
+//  OctreeEntitiesFileParserTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeEntitiesFileParserTests.h"
+
+#include <OctreeEntitiesFileParser.h>
+
+QTEST_MAIN(OctreeEntitiesFileParserTests)
+
+namespace {
+
+// the entities come before the keys that describe them, as they can in files written by other tools
+const QByteArray ENTITIES_JSON = R"({
+    "DataVersion": 3,
+    "Entities": [
+        { "id": "{5b1f1c4e-3c55-4bd8-9d36-36b1f9d3c2a1}", "type": "Box", "userData": "{ \"brace\": \"}\" }" },
+        { "id": "{8e0f2a8e-9a3a-4a3f-b6ab-1b3d2c6e7f10}", "type": "Sphere", "children": [ { "nested": [1, 2] } ] }
+    ],
+    "Id": "{2a6a4f5e-6b0c-4cfb-8f5a-6b1e9b1c0d2e}",
+    "Version": 121
+})";
+
+}
+
+void OctreeEntitiesFileParserTests::testParseToMap() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(ENTITIES_JSON);
+
+    QVariantMap parsed;
+    QVERIFY(parser.parseEntities(parsed));
+    QCOMPARE(parsed["DataVersion"].toInt(), 3);
+    QCOMPARE(parsed["Version"].toInt(), 121);
+    QCOMPARE(parsed["Id"].toUuid(), QUuid("{2a6a4f5e-6b0c-4cfb-8f5a-6b1e9b1c0d2e}"));
+
+    QVariantList entities = parsed["Entities"].toList();
+    QCOMPARE(entities.size(), 2);
+    QCOMPARE(entities[0].toMap()["type"].toString(), QString("Box"));
+    QCOMPARE(entities[0].toMap()["userData"].toString(), QString("{ \"brace\": \"}\" }"));
+    QCOMPARE(entities[1].toMap()["type"].toString(), QString("Sphere"));
+}
+
+void OctreeEntitiesFileParserTests::testStreamsEntitiesAfterHeader() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(ENTITIES_JSON);
+
+    QVariantMap header;
+    QStringList types;
+    QVERIFY(parser.parseEntities(header, [&](QJsonObject& entity) {
+        // every other key has been read by the time the first entity arrives
+        if (header["Version"].toInt() != 121 || !header.contains("Id")) {
+            return false;
+        }
+        types.append(entity["type"].toString());
+        return true;
+    }));
+
+    QCOMPARE(types, QStringList({ "Box", "Sphere" }));
+    QCOMPARE(header["DataVersion"].toInt(), 3);
+    // the entities aren't collected when they're streamed
+    QVERIFY(header["Entities"].toList().isEmpty());
+}
+
+void OctreeEntitiesFileParserTests::testStopsWhenEntityRejected() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(ENTITIES_JSON);
+
+    QVariantMap header;
+    int count = 0;
+    QVERIFY(!parser.parseEntities(header, [&](QJsonObject& entity) {
+        count++;
+        return false;
+    }));
+    QCOMPARE(count, 1);
+    QVERIFY(!parser.getErrorString().empty());
+}
+
+void OctreeEntitiesFileParserTests::testUnterminatedEntities() {
+    OctreeEntitiesFileParser parser;
+    parser.setEntitiesString(R"({ "DataVersion": 3, "Entities": [ { "type": "Box" }, { "type": "Sphere" })");
+
+    QVariantMap parsed;
+    QVERIFY(!parser.parseEntities(parsed));
+}
@@ -0,0 +1,177 @@
+//
+//  OctreeJournalTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeJournalTests.h"
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QTemporaryDir>
+
+#include <OctreeJournal.h>
+
+QTEST_MAIN(OctreeJournalTests)
+
+namespace {
+
+const PacketVersion TEST_BITSTREAM_VERSION = 42;
+const int64_t TEST_DATA_VERSION = 7;
+
+// the header is 40 bytes and each entry has a 24 byte header
+const int HEADER_SIZE = 40;
+const int ENTRY_HEADER_SIZE = 24;
+
+QByteArray readFile(const QString& filename) {
+    QFile file(filename);
+    file.open(QIODevice::ReadOnly);
+    return file.readAll();
+}
+
+}
+
+void OctreeJournalTests::testRoundTrip() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.bin.journal");
+    QUuid persistID = QUuid::createUuid();
+    QUuid editedID = QUuid::createUuid();
+    QUuid erasedID = QUuid::createUuid();
+    QByteArray editData("edited entity");
+
+    OctreeJournalWriter writer;
+    QVERIFY(writer.open(filename, persistID, TEST_DATA_VERSION, TEST_BITSTREAM_VERSION));
+    QCOMPARE(writer.getSize(), (qint64)HEADER_SIZE);
+
+    writer.addEdit(editedID, OctreeSnapshot::Encoding::JSON, editData);
+    writer.addErase(erasedID);
+    QVERIFY(writer.hasPendingEntries());
+    QVERIFY(writer.flush());
+    QVERIFY(!writer.hasPendingEntries());
+    QCOMPARE(writer.getSize(), (qint64)(HEADER_SIZE + 2 * ENTRY_HEADER_SIZE + editData.size()));
+
+    QByteArray journalData = readFile(filename);
+    QCOMPARE((qint64)journalData.size(), writer.getSize());
+
+    OctreeJournalReader reader;
+    QVERIFY(reader.setData(journalData));
+    QCOMPARE(reader.getPersistID(), persistID);
+    QCOMPARE(reader.getBaseDataVersion(), TEST_DATA_VERSION);
+    QCOMPARE(reader.getBitstreamVersion(), TEST_BITSTREAM_VERSION);
+    QCOMPARE(reader.getValidSize(), (qint64)journalData.size());
+    QCOMPARE((int)reader.getEntries().size(), 2);
+
+    const OctreeJournal::Entry& edit = reader.getEntries()[0];
+    QVERIFY(edit.operation == OctreeJournal::Operation::Edit);
+    QCOMPARE(edit.record.id, editedID);
+    QVERIFY(edit.record.encoding == OctreeSnapshot::Encoding::JSON);
+    QCOMPARE(QByteArray(edit.record.data, edit.record.size), editData);
+
+    const OctreeJournal::Entry& erase = reader.getEntries()[1];
+    QVERIFY(erase.operation == OctreeJournal::Operation::Erase);
+    QCOMPARE(erase.record.id, erasedID);
+    QCOMPARE(erase.record.size, 0);
+}
+
+void OctreeJournalTests::testContinuesMatchingJournal() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.bin.journal");
+    QUuid persistID = QUuid::createUuid();
+
+    {
+        OctreeJournalWriter writer;
+        QVERIFY(writer.open(filename, persistID, TEST_DATA_VERSION, TEST_BITSTREAM_VERSION));
+        writer.addEdit(QUuid::createUuid(), OctreeSnapshot::Encoding::Properties, QByteArray("first"));
+        QVERIFY(writer.flush());
+    }
+
+    {
+        // the same snapshot, so the journal is continued
+        OctreeJournalWriter writer;
+        QVERIFY(writer.open(filename, persistID, TEST_DATA_VERSION, TEST_BITSTREAM_VERSION));
+        writer.addEdit(QUuid::createUuid(), OctreeSnapshot::Encoding::Properties, QByteArray("second"));
+        QVERIFY(writer.flush());
+    }
+
+    QByteArray journalData = readFile(filename);
+    OctreeJournalReader reader;
+    QVERIFY(reader.setData(journalData));
+    QCOMPARE((int)reader.getEntries().size(), 2);
+
+    {
+        // a newer snapshot, so the journal starts over
+        OctreeJournalWriter writer;
+        QVERIFY(writer.open(filename, persistID, TEST_DATA_VERSION + 1, TEST_BITSTREAM_VERSION));
+        QCOMPARE(writer.getSize(), (qint64)HEADER_SIZE);
+    }
+
+    journalData = readFile(filename);
+    QVERIFY(reader.setData(journalData));
+    QCOMPARE(reader.getBaseDataVersion(), TEST_DATA_VERSION + 1);
+    QCOMPARE((int)reader.getEntries().size(), 0);
+}
+
+void OctreeJournalTests::testStopsAtTornEntry() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.bin.journal");
+    QUuid persistID = QUuid::createUuid();
+
+    OctreeJournalWriter writer;
+    QVERIFY(writer.open(filename, persistID, TEST_DATA_VERSION, TEST_BITSTREAM_VERSION));
+    writer.addEdit(QUuid::createUuid(), OctreeSnapshot::Encoding::Properties, QByteArray("complete"));
+    QVERIFY(writer.flush());
+    qint64 completeSize = writer.getSize();
+    writer.addEdit(QUuid::createUuid(), OctreeSnapshot::Encoding::Properties, QByteArray("torn by a crash"));
+    QVERIFY(writer.flush());
+
+    // cut the last entry short, as if the server crashed while writing it
+    {
+        QFile file(filename);
+        QVERIFY(file.open(QIODevice::ReadWrite));
+        QVERIFY(file.resize(writer.getSize() - 4));
+    }
+
+    QByteArray journalData = readFile(filename);
+    OctreeJournalReader reader;
+    QVERIFY(reader.setData(journalData));
+    QCOMPARE((int)reader.getEntries().size(), 1);
+    QCOMPARE(reader.getValidSize(), completeSize);
+
+    // continuing the journal drops the torn entry
+    OctreeJournalWriter continued;
+    QVERIFY(continued.open(filename, persistID, TEST_DATA_VERSION, TEST_BITSTREAM_VERSION));
+    QCOMPARE(continued.getSize(), completeSize);
+    QCOMPARE(QFileInfo(filename).size(), completeSize);
+}
+
+void OctreeJournalTests::testStopsAtCorruptEntry() {
+    QTemporaryDir dir;
+    QString filename = dir.filePath("models.bin.journal");
+
+    OctreeJournalWriter writer;
+    QVERIFY(writer.open(filename, QUuid::createUuid(), TEST_DATA_VERSION, TEST_BITSTREAM_VERSION));
+    writer.addEdit(QUuid::createUuid(), OctreeSnapshot::Encoding::Properties, QByteArray("first"));
+    writer.addEdit(QUuid::createUuid(), OctreeSnapshot::Encoding::Properties, QByteArray("second"));
+    QVERIFY(writer.flush());
+
+    QByteArray journalData = readFile(filename);
+    OctreeJournalReader reader;
+    QVERIFY(reader.setData(journalData));
+    QCOMPARE((int)reader.getEntries().size(), 2);
+
+    // flip a byte in the second entry's data, so its checksum no longer matches
+    QByteArray corruptData = journalData;
+    corruptData[corruptData.size() - 1] = corruptData[corruptData.size() - 1] ^ 0xff;
+    QVERIFY(reader.setData(corruptData));
+    QCOMPARE((int)reader.getEntries().size(), 1);
+    QCOMPARE(reader.getValidSize(), (qint64)(HEADER_SIZE + ENTRY_HEADER_SIZE + 5));
+
+    // not a journal at all
+    QByteArray badMagic = journalData;
+    badMagic[0] = '{';
+    QVERIFY(!reader.setData(badMagic));
+}
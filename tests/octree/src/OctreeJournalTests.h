@@ -0,0 +1,27 @@
+//
+//  OctreeJournalTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeJournalTests_h
+#define hifi_OctreeJournalTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeJournalTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundTrip();
+    void testContinuesMatchingJournal();
+    void testStopsAtTornEntry();
+    void testStopsAtCorruptEntry();
+};
+
+#endif // hifi_OctreeJournalTests_h
@@ -0,0 +1,102 @@
+//
+//  OctreeMemoryTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeMemoryTests.h"
+
+#include <test-utils/EntityTreeTestUtils.h>
+
+QTEST_MAIN(OctreeMemoryTests)
+
+namespace {
+
+const float SCENE_SIZE = 500.0f;
+const int NUM_TEST_ENTITIES = 20000;
+
+EntityTreePointer createTree(int numEntities) {
+    auto tree = createTestEntityTree();
+    addRandomTestBoxes(tree, numEntities, SCENE_SIZE, 0.1f, 2.0f, 4321);
+    return tree;
+}
+
+}
+
+void OctreeMemoryTests::initTestCase() {
+    setUpEntityTreeDependencies();
+}
+
+void OctreeMemoryTests::testPackedChildren() {
+    auto tree = createTree(NUM_TEST_ENTITIES / 10);
+
+    // every child the bitmask says is there can be found at its index, and only those
+    int numElements = 0;
+    bool consistent = true;
+    tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+        ++numElements;
+        int numChildren = 0;
+        for (int i = 0; i < NUMBER_OF_CHILDREN; i++) {
+            auto child = element->getChildAtIndex(i);
+            if (child) {
+                ++numChildren;
+                consistent = consistent && child->getScale() == 0.5f * element->getScale();
+            }
+        }
+        consistent = consistent && numChildren == element->getChildCount();
+        return true;
+    });
+    QVERIFY(numElements > 1);
+    QVERIFY(consistent);
+
+    // deleting the children packs the rest again
+    auto root = tree->getRoot();
+    int childCount = root->getChildCount();
+    for (int i = 0; i < NUMBER_OF_CHILDREN && root->getChildCount() > 1; i++) {
+        if (root->getChildAtIndex(i) && root->safeDeepDeleteChildAtIndex(i)) {
+            QCOMPARE(root->getChildCount(), --childCount);
+            QVERIFY(!root->getChildAtIndex(i));
+        }
+    }
+}
+
+void OctreeMemoryTests::testMemoryPerEntity() {
+    quint64 memoryBefore = OctreeElement::getTotalMemoryUsage();
+    quint64 childrenMemoryBefore = OctreeElement::getExternalChildrenMemoryUsage();
+    unsigned long nodesBefore = OctreeElement::getNodeCount();
+    auto tree = createTree(NUM_TEST_ENTITIES);
+    quint64 octreeMemory = OctreeElement::getTotalMemoryUsage() - memoryBefore;
+    unsigned long numElements = OctreeElement::getNodeCount() - nodesBefore;
+    qDebug() << "elements:" << numElements << "for" << NUM_TEST_ENTITIES << "entities,"
+             << "element size:" << sizeof(EntityTreeElement) << "bytes,"
+             << "octree memory per entity:" << (double)octreeMemory / NUM_TEST_ENTITIES << "bytes";
+    QVERIFY(numElements > 0);
+
+    // two or more children are packed, so an element holds exactly as many child pointers as it has children
+    quint64 childrenMemory = 0;
+    tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void*) {
+        if (element->getChildCount() > 1) {
+            childrenMemory += element->getChildCount() * sizeof(OctreeElementPointer);
+        }
+        return true;
+    });
+    QCOMPARE(OctreeElement::getExternalChildrenMemoryUsage() - childrenMemoryBefore, childrenMemory);
+}
+
+void OctreeMemoryTests::benchmarkEvalEntitiesInBox() {
+    auto tree = createTree(NUM_TEST_ENTITIES);
+    AABox box(glm::vec3(-0.25f * SCENE_SIZE), 0.5f * SCENE_SIZE);
+    QVector<QUuid> foundEntities;
+    QBENCHMARK {
+        foundEntities.clear();
+        tree->withReadLock([&] {
+            tree->evalEntitiesInBox(box, PickFilter(), foundEntities);
+        });
+    }
+    QVERIFY(!foundEntities.empty());
+}
@@ -0,0 +1,27 @@
+//
+//  OctreeMemoryTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeMemoryTests_h
+#define hifi_OctreeMemoryTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeMemoryTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testPackedChildren();
+    void testMemoryPerEntity();
+    void benchmarkEvalEntitiesInBox();
+};
+
+#endif // hifi_OctreeMemoryTests_h
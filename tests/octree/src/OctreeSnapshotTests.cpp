@@ -0,0 +1,131 @@
+//
+//  OctreeSnapshotTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSnapshotTests.h"
+
+#include <cstring>
+
+#include <OctreeSnapshot.h>
+
+QTEST_MAIN(OctreeSnapshotTests)
+
+namespace {
+
+const PacketVersion TEST_BITSTREAM_VERSION = 42;
+const int64_t TEST_DATA_VERSION = 7;
+
+// the header is 56 bytes, its index offset is the last field
+const int HEADER_INDEX_OFFSET_POSITION = 48;
+
+}
+
+void OctreeSnapshotTests::testRoundTrip() {
+    QUuid persistID = QUuid::createUuid();
+    QUuid firstID = QUuid::createUuid();
+    QUuid secondID = QUuid::createUuid();
+    QByteArray firstRecord("first record");
+    QByteArray secondRecord("{\"type\":\"Box\"}");
+
+    OctreeSnapshotWriter writer(persistID, TEST_DATA_VERSION, TEST_BITSTREAM_VERSION);
+    writer.addRecord(firstID, OctreeSnapshot::Encoding::Properties, firstRecord);
+    writer.addRecord(secondID, OctreeSnapshot::Encoding::JSON, secondRecord);
+    QCOMPARE(writer.getRecordCount(), 2);
+    QByteArray snapshot = writer.finish();
+    QCOMPARE(writer.getRecordCount(), 0);
+
+    OctreeSnapshotReader reader;
+    QVERIFY(reader.setData(snapshot));
+    QCOMPARE(reader.getPersistID(), persistID);
+    QCOMPARE(reader.getDataVersion(), TEST_DATA_VERSION);
+    QCOMPARE(reader.getBitstreamVersion(), TEST_BITSTREAM_VERSION);
+    QCOMPARE(reader.getRecordCount(), 2);
+
+    OctreeSnapshot::Record first = reader.getRecord(0);
+    QCOMPARE(first.id, firstID);
+    QVERIFY(first.encoding == OctreeSnapshot::Encoding::Properties);
+    QCOMPARE(QByteArray(first.data, first.size), firstRecord);
+
+    OctreeSnapshot::Record second = reader.getRecord(1);
+    QCOMPARE(second.id, secondID);
+    QVERIFY(second.encoding == OctreeSnapshot::Encoding::JSON);
+    QCOMPARE(QByteArray(second.data, second.size), secondRecord);
+
+    // out of range records are empty
+    QVERIFY(reader.getRecord(2).data == nullptr);
+    QVERIFY(reader.getRecord(-1).data == nullptr);
+}
+
+void OctreeSnapshotTests::testEmptySnapshot() {
+    OctreeSnapshotWriter writer(QUuid::createUuid(), TEST_DATA_VERSION, TEST_BITSTREAM_VERSION);
+    QByteArray snapshot = writer.finish();
+
+    OctreeSnapshotReader reader;
+    QVERIFY(reader.setData(snapshot));
+    QCOMPARE(reader.getRecordCount(), 0);
+}
+
+void OctreeSnapshotTests::testIndexIsPageAligned() {
+    OctreeSnapshotWriter writer(QUuid::createUuid(), TEST_DATA_VERSION, TEST_BITSTREAM_VERSION);
+    const int NUM_RECORDS = 100;
+    for (int i = 0; i < NUM_RECORDS; i++) {
+        writer.addRecord(QUuid::createUuid(), OctreeSnapshot::Encoding::Properties, QByteArray(i * 13, 'x'));
+    }
+    QByteArray snapshot = writer.finish();
+
+    uint64_t indexOffset;
+    memcpy(&indexOffset, snapshot.constData() + HEADER_INDEX_OFFSET_POSITION, sizeof(indexOffset));
+    QCOMPARE(indexOffset % OctreeSnapshot::PAGE_SIZE, (uint64_t)0);
+
+    OctreeSnapshotReader reader;
+    QVERIFY(reader.setData(snapshot));
+    QCOMPARE(reader.getRecordCount(), NUM_RECORDS);
+    for (int i = 0; i < NUM_RECORDS; i++) {
+        QCOMPARE(reader.getRecord(i).size, i * 13);
+    }
+}
+
+void OctreeSnapshotTests::testRejectsCorruptSnapshots() {
+    OctreeSnapshotWriter writer(QUuid::createUuid(), TEST_DATA_VERSION, TEST_BITSTREAM_VERSION);
+    writer.addRecord(QUuid::createUuid(), OctreeSnapshot::Encoding::Properties, QByteArray("record"));
+    QByteArray snapshot = writer.finish();
+
+    OctreeSnapshotReader reader;
+
+    // too short for the header
+    QByteArray truncatedHeader = snapshot.left(10);
+    QVERIFY(!reader.setData(truncatedHeader));
+
+    // not a snapshot at all
+    QByteArray badMagic = snapshot;
+    badMagic[0] = '{';
+    QVERIFY(!reader.setData(badMagic));
+
+    // the index is cut off
+    QByteArray truncatedIndex = snapshot.left(snapshot.size() - 1);
+    QVERIFY(!reader.setData(truncatedIndex));
+
+    // the index doesn't start on a page boundary
+    QByteArray misalignedIndex = snapshot;
+    uint64_t indexOffset;
+    memcpy(&indexOffset, misalignedIndex.constData() + HEADER_INDEX_OFFSET_POSITION, sizeof(indexOffset));
+    indexOffset -= 1;
+    memcpy(misalignedIndex.data() + HEADER_INDEX_OFFSET_POSITION, &indexOffset, sizeof(indexOffset));
+    QVERIFY(!reader.setData(misalignedIndex));
+
+    // a record that runs into the index
+    QByteArray badRecord = snapshot;
+    uint32_t recordSize = OctreeSnapshot::PAGE_SIZE;
+    const int RECORD_SIZE_POSITION = 16 + 8; // after the record's id and offset
+    memcpy(badRecord.data() + snapshot.size() - 32 + RECORD_SIZE_POSITION, &recordSize, sizeof(recordSize));
+    QVERIFY(!reader.setData(badRecord));
+
+    QVERIFY(reader.setData(snapshot));
+}
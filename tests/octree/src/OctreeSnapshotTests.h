@@ -0,0 +1,27 @@
+//
+//  OctreeSnapshotTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_OctreeSnapshotTests_h
+#define hifi_OctreeSnapshotTests_h
+
+#include <QtTest/QtTest>
+
+class OctreeSnapshotTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testRoundTrip();
+    void testEmptySnapshot();
+    void testIndexIsPageAligned();
+    void testRejectsCorruptSnapshots();
+};
+
+#endif // hifi_OctreeSnapshotTests_h
@@ -0,0 +1,122 @@
+//
+//  SerializationBenchmarks.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SerializationBenchmarks.h"
+
+#include <test-utils/Benchmark.h>
+
+#include <AvatarData.h>
+#include <EntityItem.h>
+#include <EntityItemProperties.h>
+#include <EntityTypes.h>
+#include <OctreePacketData.h>
+
+QTEST_MAIN(SerializationBenchmarks)
+
+BENCHMARK_COUNT_ALLOCATIONS()
+
+namespace {
+
+// about the skeleton of a typical avatar
+const int NUM_AVATAR_JOINTS = 60;
+
+EntityItemPointer createEntity() {
+    EntityItemProperties properties;
+    properties.setType(EntityTypes::Box);
+    properties.setName("Benchmark box");
+    properties.setPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    properties.setDimensions(glm::vec3(0.5f, 1.0f, 2.0f));
+    properties.setColor(glm::u8vec3(255, 128, 0));
+    properties.setUserData("{\"grabbableKey\":{\"grabbable\":true}}");
+    return EntityTypes::constructEntityItem(EntityTypes::Box, EntityItemID(QUuid::createUuid()), properties);
+}
+
+}
+
+void SerializationBenchmarks::benchmarkOctreePacketDataAppends() {
+    OctreePacketData packetData;
+    const glm::vec3 position(1.0f, 2.0f, 3.0f);
+    const glm::quat rotation(1.0f, 0.0f, 0.0f, 0.0f);
+    const QUuid id = QUuid::createUuid();
+    const QString name("Benchmark box");
+    bool appended = true;
+
+    benchmark::run("OctreePacketData::appendValue", [&] {
+        packetData.reset();
+        appended = appended && packetData.appendValue(id);
+        appended = appended && packetData.appendValue((quint64)1234567890);
+        appended = appended && packetData.appendValue(position);
+        appended = appended && packetData.appendValue(rotation);
+        appended = appended && packetData.appendValue(0.5f);
+        appended = appended && packetData.appendValue(name);
+    });
+    QVERIFY(appended);
+}
+
+void SerializationBenchmarks::benchmarkEntityAppendAndRead() {
+    auto entity = createEntity();
+    QVERIFY(entity);
+
+    OctreePacketData packetData;
+    EncodeBitstreamParams params;
+    OctreeElement::AppendState appendState = OctreeElement::NONE;
+    benchmark::run("EntityItem::appendEntityData", [&] {
+        packetData.reset();
+        appendState = entity->appendEntityData(&packetData, params, nullptr);
+    });
+    QCOMPARE(appendState, OctreeElement::COMPLETED);
+
+    // what the entity server does for every client after the first, see EntityItem::setEncodingCacheEnabled
+    EntityItem::setEncodingCacheEnabled(true);
+    benchmark::run("EntityItem::appendEntityData cached", [&] {
+        packetData.reset();
+        appendState = entity->appendEntityData(&packetData, params, nullptr);
+    });
+    EntityItem::setEncodingCacheEnabled(false);
+    QCOMPARE(appendState, OctreeElement::COMPLETED);
+
+    // as a client reading an entity it hasn't seen yet
+    const unsigned char* data = packetData.getUncompressedData();
+    int size = packetData.getUncompressedSize();
+    int bytesRead = 0;
+    benchmark::run("EntityItem::readEntityDataFromBuffer", [&] {
+        ReadBitstreamToTreeParams args;
+        auto readEntity = EntityTypes::constructEntityItem(data, size);
+        bytesRead = readEntity ? readEntity->readEntityDataFromBuffer(data, size, args) : 0;
+    });
+    QCOMPARE(bytesRead, size);
+}
+
+void SerializationBenchmarks::benchmarkAvatarToByteArrayAndParse() {
+    AvatarData avatar;
+    QVector<JointData> joints(NUM_AVATAR_JOINTS);
+    for (int i = 0; i < NUM_AVATAR_JOINTS; i++) {
+        joints[i].rotation = glm::angleAxis(0.01f * i, glm::vec3(0.0f, 1.0f, 0.0f));
+        joints[i].translation = glm::vec3(0.0f, 0.1f, 0.0f);
+        joints[i].rotationIsDefaultPose = false;
+        joints[i].translationIsDefaultPose = false;
+    }
+    avatar.setRawJointData(joints);
+    avatar.setWorldPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+
+    QByteArray avatarData;
+    benchmark::run("AvatarData::toByteArray", [&] {
+        avatarData = avatar.toByteArrayStateful(AvatarData::SendAllData);
+    });
+    QVERIFY(!avatarData.isEmpty());
+
+    AvatarData receivedAvatar;
+    int bytesRead = 0;
+    benchmark::run("AvatarData::parseDataFromBuffer", [&] {
+        bytesRead = receivedAvatar.parseDataFromBuffer(avatarData);
+    });
+    QCOMPARE(bytesRead, avatarData.size());
+}
@@ -0,0 +1,28 @@
+//
+//  SerializationBenchmarks.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SerializationBenchmarks_h
+#define hifi_SerializationBenchmarks_h
+
+#include <QtTest/QtTest>
+
+// Times encoding and decoding the octree, entity and avatar data sent over the network, see test-utils/Benchmark.h for
+// the output. The packet level hot paths are in tests/networking/src/PacketBenchmarks.
+class SerializationBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void benchmarkOctreePacketDataAppends();
+    void benchmarkEntityAppendAndRead();
+    void benchmarkAvatarToByteArrayAndParse();
+};
+
+#endif // hifi_SerializationBenchmarks_h
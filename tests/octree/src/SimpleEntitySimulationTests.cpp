@@ -0,0 +1,127 @@
+//
+//  SimpleEntitySimulationTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SimpleEntitySimulationTests.h"
+
+#include <random>
+
+#include <SimpleEntitySimulation.h>
+#include <test-utils/EntityTreeTestUtils.h>
+
+QTEST_MAIN(SimpleEntitySimulationTests)
+
+namespace {
+
+const int NUM_TEST_ENTITIES = 2000;
+// every this many entities is the parent of the next one, so some are moved one at a time
+const int PARENT_INTERVAL = 50;
+const uint64_t STEP_USECS = USECS_PER_SECOND / 60;
+
+class TestScene {
+public:
+    TestScene(int numEntities, bool parallel) :
+        _tree(createTestEntityTree()),
+        _simulation(std::make_shared<SimpleEntitySimulation>()) {
+        _simulation->setEntityTree(_tree);
+        _tree->setSimulation(_simulation);
+        _simulation->setParallelSimpleKinematics(parallel);
+
+        // the same scene every time
+        std::mt19937 generator(1234);
+        std::uniform_real_distribution<float> position(-50.0f, 50.0f);
+        std::uniform_real_distribution<float> velocity(-2.0f, 2.0f);
+        for (int i = 0; i < numEntities; i++) {
+            EntityItemProperties properties;
+            properties.setType(EntityTypes::Box);
+            properties.setPosition(glm::vec3(position(generator), position(generator), position(generator)));
+            properties.setDimensions(glm::vec3(0.5f));
+            properties.setDamping(0.1f);
+            if (i % PARENT_INTERVAL == 1) {
+                properties.setParentID(_entities.back()->getID());
+            }
+            EntityItemPointer entity = _tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+            entity->setLocalVelocity(glm::vec3(velocity(generator), velocity(generator), velocity(generator)));
+            entity->setLocalAngularVelocity(glm::vec3(velocity(generator), 0.0f, 0.0f));
+            entity->markDirtyFlags(Simulation::DIRTY_VELOCITIES);
+            _simulation->changeEntity(entity);
+            _entities.push_back(entity);
+        }
+        _simulation->processChangedEntities();
+        for (const auto& entity : _entities) {
+            entity->setLastSimulated(START_USECS);
+        }
+    }
+
+    void step(int numSteps) {
+        for (int i = 0; i < numSteps; i++) {
+            _now += STEP_USECS;
+            _simulation->moveSimpleKinematics(_now);
+        }
+    }
+
+    const std::vector<EntityItemPointer>& getEntities() const { return _entities; }
+
+    static const uint64_t START_USECS = USECS_PER_SECOND;
+
+private:
+    EntityTreePointer _tree;
+    std::shared_ptr<SimpleEntitySimulation> _simulation;
+    std::vector<EntityItemPointer> _entities;
+    uint64_t _now { START_USECS };
+};
+
+}
+
+void SimpleEntitySimulationTests::initTestCase() {
+    setUpEntityTreeDependencies();
+    // enough threads to move in parallel on any machine
+    QThreadPool::globalInstance()->setMaxThreadCount(std::max(4, QThreadPool::globalInstance()->maxThreadCount()));
+}
+
+void SimpleEntitySimulationTests::cleanupTestCase() {
+    tearDownEntityTreeDependencies();
+}
+
+void SimpleEntitySimulationTests::testParallelMatchesSerial() {
+    const int NUM_STEPS = 30;
+    TestScene serial(NUM_TEST_ENTITIES, false);
+    TestScene parallel(NUM_TEST_ENTITIES, true);
+    serial.step(NUM_STEPS);
+    parallel.step(NUM_STEPS);
+
+    // each entity is moved the same way wherever it is moved, so the results match exactly
+    const auto& expected = serial.getEntities();
+    const auto& actual = parallel.getEntities();
+    QCOMPARE(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++) {
+        QVERIFY(actual[i]->getWorldPosition() == expected[i]->getWorldPosition());
+        QVERIFY(actual[i]->getWorldOrientation() == expected[i]->getWorldOrientation());
+        QVERIFY(actual[i]->getWorldVelocity() == expected[i]->getWorldVelocity());
+    }
+    // and they did move
+    QVERIFY(actual[0]->getLastSimulated() > TestScene::START_USECS);
+}
+
+void SimpleEntitySimulationTests::benchmarkMoveSimpleKinematics_data() {
+    QTest::addColumn<bool>("parallel");
+    QTest::newRow("serial") << false;
+    QTest::newRow("parallel") << true;
+}
+
+void SimpleEntitySimulationTests::benchmarkMoveSimpleKinematics() {
+    QFETCH(bool, parallel);
+
+    const int NUM_BENCHMARK_ENTITIES = 20000;
+    TestScene scene(NUM_BENCHMARK_ENTITIES, parallel);
+    QBENCHMARK {
+        scene.step(1);
+    }
+}
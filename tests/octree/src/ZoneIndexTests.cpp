@@ -0,0 +1,131 @@
+//
+//  ZoneIndexTests.cpp
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ZoneIndexTests.h"
+
+#include <ZoneEntityItem.h>
+#include <test-utils/EntityTreeTestUtils.h>
+
+QTEST_MAIN(ZoneIndexTests)
+
+namespace {
+
+EntityItemID addZone(const EntityTreePointer& tree, const glm::vec3& position, const glm::vec3& dimensions) {
+    return addTestEntity(tree, EntityTypes::Zone, position, dimensions);
+}
+
+QSet<QUuid> findZones(const EntityTreePointer& tree, const glm::vec3& point) {
+    std::vector<ZoneEntityItemPointer> zones;
+    tree->getZoneIndex().findContainingZones(point, zones);
+    QSet<QUuid> ids;
+    for (const auto& zone : zones) {
+        ids.insert(zone->getEntityItemID());
+    }
+    return ids;
+}
+
+}
+
+void ZoneIndexTests::initTestCase() {
+    setUpEntityTreeDependencies();
+}
+
+void ZoneIndexTests::testContainingZones() {
+    auto tree = createTestEntityTree();
+    auto outer = addZone(tree, glm::vec3(0.0f), glm::vec3(20.0f));
+    auto inner = addZone(tree, glm::vec3(2.0f, 0.0f, 0.0f), glm::vec3(2.0f));
+
+    // only zones are indexed
+    EntityItemProperties box;
+    box.setType(EntityTypes::Box);
+    box.setPosition(glm::vec3(2.0f, 0.0f, 0.0f));
+    tree->withWriteLock([&] {
+        tree->addEntity(EntityItemID(QUuid::createUuid()), box);
+    });
+    QCOMPARE(tree->getZoneIndex().getZoneCount(), (size_t)2);
+
+    QCOMPARE(findZones(tree, glm::vec3(2.0f, 0.5f, 0.0f)), QSet<QUuid>({ outer, inner }));
+    // asking again gives the same answer from the kept shape tests
+    QCOMPARE(findZones(tree, glm::vec3(2.0f, 0.5f, 0.0f)), QSet<QUuid>({ outer, inner }));
+    QCOMPARE(findZones(tree, glm::vec3(-5.0f, 0.0f, 0.0f)), QSet<QUuid>({ outer }));
+    QCOMPARE(findZones(tree, glm::vec3(50.0f, 0.0f, 0.0f)), QSet<QUuid>());
+}
+
+void ZoneIndexTests::testMovedZone() {
+    auto tree = createTestEntityTree();
+    auto zone = addZone(tree, glm::vec3(0.0f), glm::vec3(2.0f));
+    const glm::vec3 point(0.5f, 0.0f, 0.0f);
+    QCOMPARE(findZones(tree, point), QSet<QUuid>({ zone }));
+
+    EntityItemProperties properties;
+    properties.setPosition(glm::vec3(30.0f, 0.0f, 0.0f));
+    tree->withWriteLock([&] {
+        tree->updateEntity(zone, properties);
+    });
+    QCOMPARE(findZones(tree, point), QSet<QUuid>());
+    QCOMPARE(findZones(tree, glm::vec3(30.5f, 0.0f, 0.0f)), QSet<QUuid>({ zone }));
+
+    // a rotation keeps the query cube but changes the points the zone contains
+    EntityItemProperties stretched;
+    stretched.setPosition(glm::vec3(0.0f));
+    stretched.setDimensions(glm::vec3(8.0f, 1.0f, 1.0f));
+    tree->withWriteLock([&] {
+        tree->updateEntity(zone, stretched);
+    });
+    const glm::vec3 onAxis(3.0f, 0.0f, 0.0f);
+    QCOMPARE(findZones(tree, onAxis), QSet<QUuid>({ zone }));
+
+    EntityItemProperties rotated;
+    rotated.setRotation(glm::angleAxis(PI / 2.0f, Vectors::UNIT_Z));
+    tree->withWriteLock([&] {
+        tree->updateEntity(zone, rotated);
+    });
+    QCOMPARE(findZones(tree, onAxis), QSet<QUuid>());
+    QCOMPARE(findZones(tree, glm::vec3(0.0f, 3.0f, 0.0f)), QSet<QUuid>({ zone }));
+}
+
+void ZoneIndexTests::testDeletedZone() {
+    auto tree = createTestEntityTree();
+    auto first = addZone(tree, glm::vec3(0.0f), glm::vec3(4.0f));
+    auto second = addZone(tree, glm::vec3(1.0f, 0.0f, 0.0f), glm::vec3(4.0f));
+    QCOMPARE(findZones(tree, glm::vec3(0.5f, 0.0f, 0.0f)), QSet<QUuid>({ first, second }));
+
+    tree->withWriteLock([&] {
+        tree->deleteEntity(first, true);
+    });
+    QCOMPARE(tree->getZoneIndex().getZoneCount(), (size_t)1);
+    QCOMPARE(findZones(tree, glm::vec3(0.5f, 0.0f, 0.0f)), QSet<QUuid>({ second }));
+
+    tree->eraseAllOctreeElements();
+    QCOMPARE(tree->getZoneIndex().getZoneCount(), (size_t)0);
+}
+
+void ZoneIndexTests::testManyZones() {
+    auto tree = createTestEntityTree();
+    const int NUM_ZONES = 100;
+    QVector<EntityItemID> ids;
+    for (int i = 0; i < NUM_ZONES; i++) {
+        ids.push_back(addZone(tree, glm::vec3(10.0f * i, 0.0f, 0.0f), glm::vec3(4.0f)));
+    }
+    for (int i = 0; i < NUM_ZONES; i++) {
+        QCOMPARE(findZones(tree, glm::vec3(10.0f * i + 1.0f, 0.0f, 0.0f)), QSet<QUuid>({ ids[i] }));
+        QCOMPARE(findZones(tree, glm::vec3(10.0f * i + 5.0f, 0.0f, 0.0f)), QSet<QUuid>());
+    }
+
+    // a move only refits the hierarchy, it still finds the zone in its new place
+    EntityItemProperties properties;
+    properties.setPosition(glm::vec3(0.0f, 50.0f, 0.0f));
+    tree->withWriteLock([&] {
+        tree->updateEntity(ids[NUM_ZONES / 2], properties);
+    });
+    QCOMPARE(findZones(tree, glm::vec3(0.0f, 50.0f, 0.0f)), QSet<QUuid>({ ids[NUM_ZONES / 2] }));
+    QCOMPARE(findZones(tree, glm::vec3(10.0f * (NUM_ZONES / 2), 0.0f, 0.0f)), QSet<QUuid>());
+}
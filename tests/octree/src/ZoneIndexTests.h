@@ -0,0 +1,28 @@
+//
+//  ZoneIndexTests.h
+//  tests/octree/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ZoneIndexTests_h
+#define hifi_ZoneIndexTests_h
+
+#include <QtTest/QtTest>
+
+class ZoneIndexTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testContainingZones();
+    void testMovedZone();
+    void testDeletedZone();
+    void testManyZones();
+};
+
+#endif // hifi_ZoneIndexTests_h
@@ -0,0 +1,176 @@
+//
+//  PhysicsSnapshotTests.cpp
+//  tests/physics/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsSnapshotTests.h"
+
+#include <memory>
+#include <vector>
+
+#include <PhysicsSnapshot.h>
+#include <ShapeFactory.h>
+
+QTEST_MAIN(PhysicsSnapshotTests)
+
+namespace {
+
+// a static floor, two boxes on a hinge, a sphere hanging from the world and a body whose shape can't be written
+class TestWorld {
+public:
+    TestWorld() :
+        _dispatcher(&_collisionConfig),
+        _world(&_dispatcher, &_broadphase, &_solver, &_collisionConfig) {
+        addBody(new btBoxShape(btVector3(10.0f, 0.5f, 10.0f)), 0.0f, btVector3(0.0f, -0.5f, 0.0f));
+        btRigidBody* boxA = addBody(new btBoxShape(btVector3(0.5f, 0.5f, 0.5f)), 1.0f, btVector3(0.0f, 2.0f, 0.0f));
+        btRigidBody* boxB = addBody(new btBoxShape(btVector3(0.5f, 0.25f, 0.5f)), 2.0f, btVector3(1.5f, 2.0f, 0.0f));
+        btRigidBody* sphere = addBody(new btSphereShape(0.25f), 0.5f, btVector3(-2.0f, 3.0f, 0.0f));
+        addBody(new btConeShape(0.5f, 1.0f), 1.0f, btVector3(3.0f, 1.0f, 0.0f));
+        boxA->setLinearVelocity(btVector3(0.0f, 0.0f, 1.0f));
+        boxB->setFriction(0.25f);
+        sphere->setDamping(0.1f, 0.2f);
+
+        btTransform frameA(btQuaternion::getIdentity(), btVector3(0.75f, 0.0f, 0.0f));
+        btTransform frameB(btQuaternion::getIdentity(), btVector3(-0.75f, 0.0f, 0.0f));
+        btHingeConstraint* hinge = new btHingeConstraint(*boxA, *boxB, frameA, frameB, true);
+        hinge->setLimit(-0.5f, 1.0f);
+        addConstraint(hinge, true);
+        addConstraint(new btPoint2PointConstraint(*sphere, btVector3(0.0f, 1.0f, 0.0f)), false);
+    }
+
+    ~TestWorld() {
+        for (auto& constraint : _constraints) {
+            _world.removeConstraint(constraint.get());
+        }
+        for (auto& body : _bodies) {
+            _world.removeRigidBody(body.get());
+        }
+    }
+
+    btDiscreteDynamicsWorld& getWorld() { return _world; }
+
+private:
+    btRigidBody* addBody(btCollisionShape* shape, float mass, const btVector3& position) {
+        _shapes.emplace_back(shape);
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+        }
+        btRigidBody::btRigidBodyConstructionInfo info(mass, nullptr, shape, inertia);
+        info.m_startWorldTransform.setOrigin(position);
+        _bodies.emplace_back(new btRigidBody(info));
+        _world.addRigidBody(_bodies.back().get());
+        return _bodies.back().get();
+    }
+
+    void addConstraint(btTypedConstraint* constraint, bool disableCollisions) {
+        _constraints.emplace_back(constraint);
+        _world.addConstraint(constraint, disableCollisions);
+    }
+
+    btDefaultCollisionConfiguration _collisionConfig;
+    btCollisionDispatcher _dispatcher;
+    btDbvtBroadphase _broadphase;
+    btSequentialImpulseConstraintSolver _solver;
+    btDiscreteDynamicsWorld _world;
+    std::vector<std::unique_ptr<btCollisionShape>> _shapes;
+    std::vector<std::unique_ptr<btRigidBody>> _bodies;
+    std::vector<std::unique_ptr<btTypedConstraint>> _constraints;
+};
+
+}
+
+void PhysicsSnapshotTests::captureBodiesAndConstraints() {
+    TestWorld world;
+    PhysicsSnapshot snapshot = PhysicsSnapshot::capture(&world.getWorld());
+
+    // the cone is left out
+    QCOMPARE(snapshot.bodies.size(), (size_t)4);
+    QCOMPARE(snapshot.shapes.size(), (size_t)4);
+    QCOMPARE(snapshot.numSkippedObjects, (uint32_t)1);
+
+    const PhysicsSnapshot::Body& floor = snapshot.bodies[0];
+    QCOMPARE(floor.motionType, MOTION_TYPE_STATIC);
+    QCOMPARE(floor.mass, 0.0f);
+    const PhysicsSnapshot::Body& boxB = snapshot.bodies[2];
+    QCOMPARE(boxB.motionType, MOTION_TYPE_DYNAMIC);
+    QCOMPARE(boxB.mass, 2.0f);
+    QCOMPARE(boxB.friction, 0.25f);
+    QVERIFY(boxB.transform.getOrigin() == btVector3(1.5f, 2.0f, 0.0f));
+    QVERIFY(snapshot.bodies[1].linearVelocity == btVector3(0.0f, 0.0f, 1.0f));
+    QCOMPARE(snapshot.bodies[3].angularDamping, 0.2f);
+
+    QCOMPARE(snapshot.constraints.size(), (size_t)2);
+    const PhysicsSnapshot::Constraint& hinge = snapshot.constraints[0];
+    QCOMPARE(hinge.type, (int32_t)HINGE_CONSTRAINT_TYPE);
+    QCOMPARE(hinge.bodyA, 1);
+    QCOMPARE(hinge.bodyB, 2);
+    QCOMPARE(hinge.limits[0], -0.5f);
+    QCOMPARE(hinge.limits[1], 1.0f);
+    QVERIFY(hinge.disableCollisions);
+    const PhysicsSnapshot::Constraint& pointToPoint = snapshot.constraints[1];
+    QCOMPARE(pointToPoint.type, (int32_t)POINT2POINT_CONSTRAINT_TYPE);
+    QCOMPARE(pointToPoint.bodyA, 3);
+    QCOMPARE(pointToPoint.bodyB, PhysicsSnapshot::FIXED_BODY);
+    QVERIFY(!pointToPoint.disableCollisions);
+
+    // the captured shapes can be built again
+    for (const auto& data : snapshot.shapes) {
+        const btCollisionShape* shape = ShapeFactory::deserializeShape(data);
+        QVERIFY(shape);
+        ShapeFactory::deleteShape(shape);
+    }
+}
+
+void PhysicsSnapshotTests::roundTrip() {
+    TestWorld world;
+    PhysicsSnapshot snapshot = PhysicsSnapshot::capture(&world.getWorld());
+    QByteArray data = snapshot.toByteArray();
+
+    PhysicsSnapshot restored;
+    QVERIFY(restored.fromByteArray(data));
+    QCOMPARE(restored.shapes, snapshot.shapes);
+    QCOMPARE(restored.numSkippedObjects, snapshot.numSkippedObjects);
+    QCOMPARE(restored.bodies.size(), snapshot.bodies.size());
+    for (size_t i = 0; i < snapshot.bodies.size(); ++i) {
+        QVERIFY(restored.bodies[i].transform == snapshot.bodies[i].transform);
+        QCOMPARE(restored.bodies[i].motionType, snapshot.bodies[i].motionType);
+        QCOMPARE(restored.bodies[i].mass, snapshot.bodies[i].mass);
+        QCOMPARE(restored.bodies[i].group, snapshot.bodies[i].group);
+        QCOMPARE(restored.bodies[i].mask, snapshot.bodies[i].mask);
+    }
+    QCOMPARE(restored.constraints.size(), snapshot.constraints.size());
+    QCOMPARE(restored.toByteArray(), data);
+
+    // and the constraints built from it are the same as the ones captured
+    btSphereShape sphere(0.5f);
+    btRigidBody bodyA(1.0f, nullptr, &sphere);
+    btRigidBody bodyB(1.0f, nullptr, &sphere);
+    std::unique_ptr<btTypedConstraint> hinge(PhysicsSnapshot::createConstraint(restored.constraints[0], bodyA, bodyB));
+    QVERIFY(hinge);
+    QCOMPARE(hinge->getConstraintType(), HINGE_CONSTRAINT_TYPE);
+    QCOMPARE(static_cast<btHingeConstraint*>(hinge.get())->getLowerLimit(), -0.5f);
+    QCOMPARE(static_cast<btHingeConstraint*>(hinge.get())->getUpperLimit(), 1.0f);
+}
+
+void PhysicsSnapshotTests::rejectBadData() {
+    PhysicsSnapshot snapshot;
+    QVERIFY(!snapshot.fromByteArray(QByteArray()));
+
+    TestWorld world;
+    QByteArray data = PhysicsSnapshot::capture(&world.getWorld()).toByteArray();
+    QVERIFY(!snapshot.fromByteArray(data.left(data.size() / 2)));
+    QVERIFY(snapshot.bodies.empty());
+    QVERIFY(!snapshot.fromByteArray(data + QByteArray(4, 0)));
+
+    // a different format version
+    QByteArray otherVersion = data;
+    otherVersion[7] = otherVersion[7] + 1;
+    QVERIFY(!snapshot.fromByteArray(otherVersion));
+}
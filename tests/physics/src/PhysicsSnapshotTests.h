@@ -0,0 +1,26 @@
+//
+//  PhysicsSnapshotTests.h
+//  tests/physics/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsSnapshotTests_h
+#define hifi_PhysicsSnapshotTests_h
+
+#include <QtTest/QtTest>
+
+class PhysicsSnapshotTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void captureBodiesAndConstraints();
+    void roundTrip();
+    void rejectBadData();
+};
+
+#endif // hifi_PhysicsSnapshotTests_h
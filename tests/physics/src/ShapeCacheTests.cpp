@@ -0,0 +1,241 @@
+//
+//  ShapeCacheTests.cpp
+//  tests/physics/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ShapeCacheTests.h"
+
+#include <QTemporaryDir>
+
+#include <ShapeCache.h>
+#include <ShapeFactory.h>
+#include <ShapeManager.h>
+
+QTEST_MAIN(ShapeCacheTests)
+
+namespace {
+
+ShapeInfo createCompoundHullInfo() {
+    QVector<glm::vec3> tetrahedron;
+    tetrahedron.push_back(glm::vec3(1.0f, 1.0f, 1.0f));
+    tetrahedron.push_back(glm::vec3(1.0f, -1.0f, -1.0f));
+    tetrahedron.push_back(glm::vec3(-1.0f, 1.0f, -1.0f));
+    tetrahedron.push_back(glm::vec3(-1.0f, -1.0f, 1.0f));
+
+    ShapeInfo::PointCollection pointCollection;
+    const int NUM_HULLS = 3;
+    for (int i = 0; i < NUM_HULLS; ++i) {
+        ShapeInfo::PointList pointList;
+        for (const auto& point : tetrahedron) {
+            pointList.push_back((float)(i + 1) * point + glm::vec3((float)i, 0.0f, 0.0f));
+        }
+        pointCollection.push_back(pointList);
+    }
+
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_COMPOUND, glm::vec3(4.0f), "http://localhost/hulls.obj");
+    info.setPointCollection(pointCollection);
+    return info;
+}
+
+// a bumpy grid of triangles, large enough for a BVH of some depth
+ShapeInfo createStaticMeshInfo(float bumpHeight = 0.25f) {
+    const int GRID_SIZE = 32;
+    ShapeInfo::PointList points;
+    for (int i = 0; i <= GRID_SIZE; ++i) {
+        for (int j = 0; j <= GRID_SIZE; ++j) {
+            points.push_back(glm::vec3((float)i, bumpHeight * (float)((i + j) % 3), (float)j));
+        }
+    }
+    ShapeInfo::PointCollection pointCollection;
+    pointCollection.push_back(points);
+
+    ShapeInfo info;
+    info.setParams(SHAPE_TYPE_STATIC_MESH, glm::vec3(0.5f * (float)GRID_SIZE), "http://localhost/mesh.fbx");
+    info.setPointCollection(pointCollection);
+    ShapeInfo::TriangleIndices& triangleIndices = info.getTriangleIndices();
+    const int ROW = GRID_SIZE + 1;
+    for (int i = 0; i < GRID_SIZE; ++i) {
+        for (int j = 0; j < GRID_SIZE; ++j) {
+            int corner = i * ROW + j;
+            triangleIndices << corner << corner + 1 << corner + ROW;
+            triangleIndices << corner + 1 << corner + ROW + 1 << corner + ROW;
+        }
+    }
+    return info;
+}
+
+class TriangleCounter : public btTriangleCallback {
+public:
+    void processTriangle(btVector3* triangle, int partId, int triangleIndex) override { ++numTriangles; }
+    int numTriangles { 0 };
+};
+
+int countTrianglesNearRay(const btBvhTriangleMeshShape* mesh, const btVector3& from, const btVector3& to) {
+    TriangleCounter counter;
+    const_cast<btBvhTriangleMeshShape*>(mesh)->performRaycast(&counter, from, to);
+    return counter.numTriangles;
+}
+
+}
+
+void ShapeCacheTests::serializeCompoundHull() {
+    ShapeInfo info = createCompoundHullInfo();
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    QVERIFY(shape);
+
+    QByteArray data = ShapeFactory::serializeShape(shape);
+    QVERIFY(!data.isEmpty());
+    const btCollisionShape* restored = ShapeFactory::deserializeShape(data);
+    QVERIFY(restored);
+    QCOMPARE(restored->getShapeType(), (int)COMPOUND_SHAPE_PROXYTYPE);
+
+    const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+    const btCompoundShape* restoredCompound = static_cast<const btCompoundShape*>(restored);
+    QCOMPARE(restoredCompound->getNumChildShapes(), compound->getNumChildShapes());
+    for (int i = 0; i < compound->getNumChildShapes(); ++i) {
+        const btConvexHullShape* hull = static_cast<const btConvexHullShape*>(compound->getChildShape(i));
+        const btConvexHullShape* restoredHull = static_cast<const btConvexHullShape*>(restoredCompound->getChildShape(i));
+        QCOMPARE(restoredHull->getShapeType(), (int)CONVEX_HULL_SHAPE_PROXYTYPE);
+        QCOMPARE(restoredHull->getNumPoints(), hull->getNumPoints());
+        QCOMPARE(restoredHull->getMargin(), hull->getMargin());
+        for (int j = 0; j < hull->getNumPoints(); ++j) {
+            QVERIFY(restoredHull->getUnscaledPoints()[j] == hull->getUnscaledPoints()[j]);
+        }
+    }
+
+    // nothing is lost, so saving it again gives the same data
+    QCOMPARE(ShapeFactory::serializeShape(restored), data);
+
+    ShapeFactory::deleteShape(restored);
+    ShapeFactory::deleteShape(shape);
+}
+
+void ShapeCacheTests::serializeStaticMesh() {
+    ShapeInfo info = createStaticMeshInfo();
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(info);
+    QVERIFY(shape);
+    QCOMPARE(shape->getShapeType(), (int)TRIANGLE_MESH_SHAPE_PROXYTYPE);
+
+    QByteArray data = ShapeFactory::serializeShape(shape);
+    QVERIFY(!data.isEmpty());
+    const btCollisionShape* restored = ShapeFactory::deserializeShape(data);
+    QVERIFY(restored);
+    QCOMPARE(restored->getShapeType(), (int)TRIANGLE_MESH_SHAPE_PROXYTYPE);
+    QCOMPARE(ShapeFactory::serializeShape(restored), data);
+
+    const btBvhTriangleMeshShape* mesh = static_cast<const btBvhTriangleMeshShape*>(shape);
+    const btBvhTriangleMeshShape* restoredMesh = static_cast<const btBvhTriangleMeshShape*>(restored);
+    QVERIFY(restoredMesh->getLocalAabbMin() == mesh->getLocalAabbMin());
+    QVERIFY(restoredMesh->getLocalAabbMax() == mesh->getLocalAabbMax());
+
+    // the restored BVH finds the same triangles
+    int numTriangles = countTrianglesNearRay(mesh, btVector3(5.5f, 10.0f, 5.5f), btVector3(5.5f, -10.0f, 5.5f));
+    QVERIFY(numTriangles > 0);
+    QCOMPARE(countTrianglesNearRay(restoredMesh, btVector3(5.5f, 10.0f, 5.5f), btVector3(5.5f, -10.0f, 5.5f)), numTriangles);
+
+    ShapeFactory::deleteShape(restored);
+    ShapeFactory::deleteShape(shape);
+}
+
+void ShapeCacheTests::serializePrimitives() {
+    ShapeInfo info;
+    std::vector<const btCollisionShape*> shapes;
+    info.setParams(SHAPE_TYPE_BOX, glm::vec3(1.0f, 2.0f, 3.0f));
+    shapes.push_back(ShapeFactory::createShapeFromInfo(info));
+    info.setParams(SHAPE_TYPE_SPHERE, glm::vec3(0.5f));
+    shapes.push_back(ShapeFactory::createShapeFromInfo(info));
+    info.setParams(SHAPE_TYPE_CAPSULE_X, glm::vec3(2.0f, 0.5f, 0.5f));
+    shapes.push_back(ShapeFactory::createShapeFromInfo(info));
+    info.setParams(SHAPE_TYPE_CYLINDER_Z, glm::vec3(0.5f, 0.5f, 2.0f));
+    shapes.push_back(ShapeFactory::createShapeFromInfo(info));
+
+    for (const btCollisionShape* shape : shapes) {
+        QVERIFY(shape);
+        QByteArray data = ShapeFactory::serializeShape(shape);
+        QVERIFY(!data.isEmpty());
+        const btCollisionShape* restored = ShapeFactory::deserializeShape(data);
+        QVERIFY(restored);
+        QCOMPARE(restored->getShapeType(), shape->getShapeType());
+        QCOMPARE(restored->getMargin(), shape->getMargin());
+
+        btVector3 minCorner, maxCorner, restoredMinCorner, restoredMaxCorner;
+        shape->getAabb(btTransform::getIdentity(), minCorner, maxCorner);
+        restored->getAabb(btTransform::getIdentity(), restoredMinCorner, restoredMaxCorner);
+        QVERIFY(restoredMinCorner == minCorner);
+        QVERIFY(restoredMaxCorner == maxCorner);
+        QCOMPARE(ShapeFactory::serializeShape(restored), data);
+
+        ShapeFactory::deleteShape(restored);
+        ShapeFactory::deleteShape(shape);
+    }
+}
+
+void ShapeCacheTests::rejectBadData() {
+    QVERIFY(ShapeFactory::deserializeShape(QByteArray()) == nullptr);
+
+    // no ShapeInfo makes cones, so they aren't written
+    btConeShape cone(1.0f, 2.0f);
+    QVERIFY(ShapeFactory::serializeShape(&cone).isEmpty());
+
+    const btCollisionShape* shape = ShapeFactory::createShapeFromInfo(createStaticMeshInfo());
+    QByteArray data = ShapeFactory::serializeShape(shape);
+    ShapeFactory::deleteShape(shape);
+
+    QVERIFY(ShapeFactory::deserializeShape(data.left(data.size() / 2)) == nullptr);
+    QVERIFY(ShapeFactory::deserializeShape(data + QByteArray(4, 0)) == nullptr);
+
+    // a different format version
+    QByteArray otherVersion = data;
+    otherVersion[7] = otherVersion[7] + 1;
+    QVERIFY(ShapeFactory::deserializeShape(otherVersion) == nullptr);
+}
+
+void ShapeCacheTests::keyCoversGeometry() {
+    ShapeInfo info = createStaticMeshInfo(0.25f);
+    ShapeInfo otherGeometry = createStaticMeshInfo(0.5f);
+    // same url and dimensions, so the same hash
+    QCOMPARE(otherGeometry.getHash(), info.getHash());
+    QVERIFY(ShapeCache::getKey(otherGeometry) != ShapeCache::getKey(info));
+    QCOMPARE(ShapeCache::getKey(createStaticMeshInfo(0.25f)), ShapeCache::getKey(info));
+    // keys are file names
+    QVERIFY(ShapeCache::getKey(info).find('.') == std::string::npos);
+}
+
+void ShapeCacheTests::shapeManagerLoadsCachedShapes() {
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    ShapeInfo info = createStaticMeshInfo();
+
+    auto getShape = [&](ShapeManager& shapeManager) {
+        QVERIFY(shapeManager.getShape(info) == nullptr);
+        QTRY_COMPARE(shapeManager.getNumUndeliveredShapes(), 1);
+        QCOMPARE(shapeManager.deliverWork(0), 1);
+        QVERIFY(shapeManager.hasShapeWithKey(info.getHash()));
+    };
+
+    {
+        auto shapeCache = std::make_shared<ShapeCache>(cacheDir.path().toStdString());
+        shapeCache->initialize();
+        ShapeManager shapeManager;
+        shapeManager.setDiskCache(shapeCache);
+        getShape(shapeManager);
+        QCOMPARE(shapeManager.getDiskCacheHitCount(), (uint32_t)0);
+        QCOMPARE(shapeCache->getNumTotalFiles(), (size_t)1);
+    }
+
+    // as on the next run
+    auto shapeCache = std::make_shared<ShapeCache>(cacheDir.path().toStdString());
+    shapeCache->initialize();
+    QCOMPARE(shapeCache->getNumTotalFiles(), (size_t)1);
+    ShapeManager shapeManager;
+    shapeManager.setDiskCache(shapeCache);
+    getShape(shapeManager);
+    QCOMPARE(shapeManager.getDiskCacheHitCount(), (uint32_t)1);
+}
@@ -0,0 +1,29 @@
+//
+//  ShapeCacheTests.h
+//  tests/physics/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ShapeCacheTests_h
+#define hifi_ShapeCacheTests_h
+
+#include <QtTest/QtTest>
+
+class ShapeCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void serializeCompoundHull();
+    void serializeStaticMesh();
+    void serializePrimitives();
+    void rejectBadData();
+    void keyCoversGeometry();
+    void shapeManagerLoadsCachedShapes();
+};
+
+#endif // hifi_ShapeCacheTests_h
@@ -218,9 +218,15 @@ void ShapeManagerTests::addCompoundShape() {
     info.setParams(SHAPE_TYPE_COMPOUND, halfExtents);
     info.setPointCollection(pointCollection);
 
-    // create the shape
+    // the shape is built on a worker thread
     ShapeManager shapeManager;
-    const btCollisionShape* shape = shapeManager.getShape(info);
+    QVERIFY(ShapeManager::isBuiltOffThread(SHAPE_TYPE_COMPOUND));
+    QVERIFY(shapeManager.getShape(info) == nullptr);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 1);
+    QTRY_COMPARE(shapeManager.getNumUndeliveredShapes(), 1);
+    QCOMPARE(shapeManager.deliverWork(0), 1);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 0);
+    const btCollisionShape* shape = shapeManager.getShapeByKey(info.getHash());
     QVERIFY(shape != nullptr);
 
     // verify the shape is correct type
@@ -244,3 +250,48 @@ void ShapeManagerTests::addCompoundShape() {
     QCOMPARE(shapeManager.getNumShapes(), 0);
     QCOMPARE(shapeManager.getNumReferences(info), 0);
 }
+
+void ShapeManagerTests::deliverShapesInSlices() {
+    ShapeManager shapeManager;
+    const int NUM_HULLS = 8;
+    std::vector<ShapeInfo> infos;
+    for (int i = 0; i < NUM_HULLS; ++i) {
+        ShapeInfo::PointList pointList;
+        float radius = (float)(i + 1);
+        pointList.push_back(radius * glm::vec3(1.0f, 1.0f, 1.0f));
+        pointList.push_back(radius * glm::vec3(1.0f, -1.0f, -1.0f));
+        pointList.push_back(radius * glm::vec3(-1.0f, 1.0f, -1.0f));
+        pointList.push_back(radius * glm::vec3(-1.0f, -1.0f, 1.0f));
+        ShapeInfo::PointCollection pointCollection;
+        pointCollection.push_back(pointList);
+
+        ShapeInfo info;
+        info.setParams(SHAPE_TYPE_SIMPLE_HULL, glm::vec3(radius));
+        info.setPointCollection(pointCollection);
+        QVERIFY(shapeManager.getShape(info) == nullptr);
+        infos.push_back(info);
+    }
+    // asking again doesn't start another worker
+    uint32_t requestCount = shapeManager.getWorkRequestCount();
+    QVERIFY(shapeManager.getShape(infos[0]) == nullptr);
+    QCOMPARE(shapeManager.getWorkRequestCount(), requestCount + 1);
+    QCOMPARE(shapeManager.getNumPendingShapes(), NUM_HULLS);
+
+    // with no time budget, shapes arrive one per call
+    QTRY_COMPARE(shapeManager.getNumUndeliveredShapes(), NUM_HULLS);
+    QCOMPARE(shapeManager.deliverWork(0), 1);
+    QCOMPARE(shapeManager.getNumShapes(), 1);
+    QCOMPARE(shapeManager.getNumUndeliveredShapes(), NUM_HULLS - 1);
+    QCOMPARE((int)shapeManager.getWorkDeliveryCount(), 1);
+
+    // and all of them with enough time
+    const uint64_t LONG_TIME_BUDGET = 1000000; // usecs
+    QCOMPARE(shapeManager.deliverWork(LONG_TIME_BUDGET), NUM_HULLS - 1);
+    QCOMPARE(shapeManager.getNumShapes(), NUM_HULLS);
+    QCOMPARE(shapeManager.getNumPendingShapes(), 0);
+    QCOMPARE(shapeManager.deliverWork(LONG_TIME_BUDGET), 0);
+    for (const auto& info : infos) {
+        QVERIFY(shapeManager.getShapeByKey(info.getHash()) != nullptr);
+        QCOMPARE(shapeManager.getNumReferences(info), 1);
+    }
+}
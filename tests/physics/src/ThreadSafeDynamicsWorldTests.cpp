@@ -0,0 +1,239 @@
+//
+//  ThreadSafeDynamicsWorldTests.cpp
+//  tests/physics/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ThreadSafeDynamicsWorldTests.h"
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <LinearMath/btThreads.h>
+
+#include <BulletUtil.h>
+#include <GLMHelpers.h>
+#include <PhysicsEngine.h>
+#include <ThreadSafeDynamicsWorld.h>
+
+QTEST_MAIN(ThreadSafeDynamicsWorldTests)
+
+namespace {
+
+const btScalar FIXED_SUBSTEP = btScalar(1.0) / btScalar(90.0);
+const int MAX_SUBSTEPS = 6;
+const int NUM_STACKS = 16;
+const int STACK_HEIGHT = 4;
+
+// stands in for an EntityMotionState, remembering the last transform it was given
+class TestMotionState : public ObjectMotionState {
+public:
+    TestMotionState(const btVector3& position) : ObjectMotionState(nullptr) {
+        _type = MOTIONSTATE_TYPE_ENTITY;
+        _transform.setIdentity();
+        _transform.setOrigin(position);
+    }
+
+    void getWorldTransform(btTransform& worldTrans) const override { worldTrans = _transform; }
+    void setWorldTransform(const btTransform& worldTrans) override { _transform = worldTrans; }
+    const btTransform& getTransform() const { return _transform; }
+
+    uint32_t getIncomingDirtyFlags() const override { return 0; }
+    void clearIncomingDirtyFlags(uint32_t mask) override { }
+    PhysicsMotionType computePhysicsMotionType() const override { return MOTION_TYPE_DYNAMIC; }
+    bool isMoving() const override { return true; }
+    float getObjectRestitution() const override { return 0.5f; }
+    float getObjectFriction() const override { return 0.5f; }
+    float getObjectLinearDamping() const override { return 0.0f; }
+    float getObjectAngularDamping() const override { return 0.0f; }
+    glm::vec3 getObjectPosition() const override { return bulletToGLM(_transform.getOrigin()); }
+    glm::quat getObjectRotation() const override { return bulletToGLM(_transform.getRotation()); }
+    glm::vec3 getObjectLinearVelocity() const override { return glm::vec3(0.0f); }
+    glm::vec3 getObjectAngularVelocity() const override { return glm::vec3(0.0f); }
+    glm::vec3 getObjectGravity() const override { return glm::vec3(0.0f); }
+    const QUuid getObjectID() const override { return QUuid(); }
+    QUuid getSimulatorID() const override { return QUuid(); }
+    ShapeType getShapeType() const override { return SHAPE_TYPE_BOX; }
+    void computeCollisionGroupAndMask(int32_t& group, int32_t& mask) const override { }
+
+private:
+    btTransform _transform;
+};
+
+// stacks of boxes on the ground, far enough apart that each is an island of its own
+class TestWorld {
+public:
+    TestWorld(int numSolvers, bool withMotionStates = false) :
+        _dispatcher(&_collisionConfig),
+        _solverPool(numSolvers),
+        _world(&_dispatcher, &_broadphase, &_solverPool, &_solverMt, &_collisionConfig),
+        _withMotionStates(withMotionStates) {
+        _world.setGravity(btVector3(0.0f, -9.8f, 0.0f));
+
+        addBody(new btStaticPlaneShape(btVector3(0.0f, 1.0f, 0.0f), 0.0f), 0.0f, btVector3(0.0f, 0.0f, 0.0f));
+        for (int i = 0; i < NUM_STACKS; i++) {
+            for (int j = 0; j < STACK_HEIGHT; j++) {
+                // a little offset so the stacks topple
+                btVector3 position(10.0f * (float)i + 0.05f * (float)j, 0.5f + 1.01f * (float)j, 0.0f);
+                addBody(new btBoxShape(btVector3(0.5f, 0.5f, 0.5f)), 1.0f, position);
+            }
+        }
+    }
+
+    ~TestWorld() {
+        for (auto& body : _bodies) {
+            _world.removeRigidBody(body.get());
+        }
+    }
+
+    ThreadSafeDynamicsWorld& getWorld() { return _world; }
+    const std::vector<std::unique_ptr<btRigidBody>>& getBodies() const { return _bodies; }
+    const std::vector<std::unique_ptr<TestMotionState>>& getMotionStates() const { return _motionStates; }
+
+private:
+    void addBody(btCollisionShape* shape, float mass, const btVector3& position) {
+        _shapes.emplace_back(shape);
+        btVector3 inertia(0.0f, 0.0f, 0.0f);
+        TestMotionState* motionState = nullptr;
+        if (mass > 0.0f) {
+            shape->calculateLocalInertia(mass, inertia);
+            if (_withMotionStates) {
+                motionState = new TestMotionState(position);
+                _motionStates.emplace_back(motionState);
+            }
+        }
+        btRigidBody::btRigidBodyConstructionInfo info(mass, motionState, shape, inertia);
+        info.m_startWorldTransform.setOrigin(position);
+        _bodies.emplace_back(new btRigidBody(info));
+        _world.addRigidBody(_bodies.back().get());
+    }
+
+    btDefaultCollisionConfiguration _collisionConfig;
+    btCollisionDispatcher _dispatcher;
+    btDbvtBroadphase _broadphase;
+    btConstraintSolverPoolMt _solverPool;
+    btSequentialImpulseConstraintSolverMt _solverMt;
+    ThreadSafeDynamicsWorld _world;
+    std::vector<std::unique_ptr<btCollisionShape>> _shapes;
+    std::vector<std::unique_ptr<btRigidBody>> _bodies;
+    std::vector<std::unique_ptr<TestMotionState>> _motionStates;
+    bool _withMotionStates;
+};
+
+void simulate(TestWorld& world, int numFrames) {
+    const btScalar FRAME_TIME = btScalar(1.0) / btScalar(60.0);
+    for (int i = 0; i < numFrames; i++) {
+        world.getWorld().stepSimulationWithSubstepCallback(FRAME_TIME, MAX_SUBSTEPS, FIXED_SUBSTEP);
+    }
+}
+
+}
+
+void ThreadSafeDynamicsWorldTests::testNumPhysicsThreads() {
+    int maxNumThreads = PhysicsEngine::getMaxNumPhysicsThreads();
+    QVERIFY(maxNumThreads >= 1);
+
+    PhysicsEngine engine(Vectors::ZERO);
+    QCOMPARE(engine.getNumPhysicsThreads(), 1);
+    engine.setNumPhysicsThreads(0);
+    QCOMPARE(engine.getNumPhysicsThreads(), 1);
+    engine.setNumPhysicsThreads(maxNumThreads + 100);
+    QCOMPARE(engine.getNumPhysicsThreads(), maxNumThreads);
+
+    // and once there is a world to step
+    engine.init();
+    engine.setNumPhysicsThreads(2);
+    QCOMPARE(engine.getNumPhysicsThreads(), std::min(2, maxNumThreads));
+    engine.setNumPhysicsThreads(1);
+    QCOMPARE(btGetTaskScheduler(), btGetSequentialTaskScheduler());
+}
+
+void ThreadSafeDynamicsWorldTests::testSubstepCallback() {
+    TestWorld world(1);
+    int numCallbacks = 0;
+    int numSubsteps = 0;
+    const btScalar LONG_FRAME_TIME = btScalar(5.5) * FIXED_SUBSTEP;
+    for (int i = 0; i < 10; i++) {
+        numSubsteps += world.getWorld().stepSimulationWithSubstepCallback(LONG_FRAME_TIME, MAX_SUBSTEPS, FIXED_SUBSTEP,
+                                                                          [&] { numCallbacks++; });
+    }
+    // one callback for each substep taken, after it is taken
+    QVERIFY(numSubsteps > 0);
+    QCOMPARE(numCallbacks, world.getWorld().getNumSubsteps());
+    QVERIFY(world.getWorld().getLocalTimeAccumulation() < FIXED_SUBSTEP);
+}
+
+void ThreadSafeDynamicsWorldTests::testParallelIslandsMatchSequential() {
+    const int NUM_FRAMES = 120;
+
+    btSetTaskScheduler(btGetSequentialTaskScheduler());
+    TestWorld sequential(1);
+    simulate(sequential, NUM_FRAMES);
+
+    std::unique_ptr<btITaskScheduler> scheduler(btCreateDefaultTaskScheduler());
+    if (!scheduler) {
+        QSKIP("Bullet was built without multithreading");
+    }
+    const int NUM_THREADS = 4;
+    scheduler->setNumThreads(std::min(NUM_THREADS, scheduler->getMaxNumThreads()));
+    btSetTaskScheduler(scheduler.get());
+    TestWorld parallel(NUM_THREADS);
+    simulate(parallel, NUM_FRAMES);
+    btSetTaskScheduler(btGetSequentialTaskScheduler());
+
+    // islands are solved independently, so solving them on other threads gives the same results
+    const float TOLERANCE = 0.001f;
+    const auto& expected = sequential.getBodies();
+    const auto& actual = parallel.getBodies();
+    QCOMPARE(actual.size(), expected.size());
+    for (size_t i = 0; i < actual.size(); i++) {
+        btVector3 offset = actual[i]->getWorldTransform().getOrigin() - expected[i]->getWorldTransform().getOrigin();
+        QVERIFY(offset.length() < TOLERANCE);
+    }
+}
+
+void ThreadSafeDynamicsWorldTests::testBulkMotionStateSync() {
+    const int NUM_FRAMES = 60;
+    TestWorld bulk(1, true);
+    TestWorld perBody(1, true);
+    QVERIFY(bulk.getWorld().isBulkMotionStateSync());
+    perBody.getWorld().setBulkMotionStateSync(false);
+
+    for (int frame = 0; frame < NUM_FRAMES; frame++) {
+        simulate(bulk, 1);
+        simulate(perBody, 1);
+        bulk.getWorld().synchronizeMotionStates();
+        perBody.getWorld().synchronizeMotionStates();
+
+        // the active dynamic entities go in the buffer instead of the changed motion states, in the same order
+        const MotionStateBuffer& buffer = bulk.getWorld().getMotionStateBuffer();
+        const VectorOfMotionStates& changed = perBody.getWorld().getChangedMotionStates();
+        QVERIFY(bulk.getWorld().getChangedMotionStates().empty());
+        QVERIFY(perBody.getWorld().getMotionStateBuffer().size() == 0);
+        QCOMPARE(buffer.size(), changed.size());
+
+        const auto& bulkStates = bulk.getMotionStates();
+        const auto& perBodyStates = perBody.getMotionStates();
+        for (size_t i = 0; i < buffer.size(); i++) {
+            // the worlds step identically, so matching motion states are at the same index in each
+            size_t index = std::find_if(bulkStates.begin(), bulkStates.end(), [&](const std::unique_ptr<TestMotionState>& state) {
+                return state.get() == buffer.motionStates[i];
+            }) - bulkStates.begin();
+            QVERIFY(index < bulkStates.size());
+            QCOMPARE((ObjectMotionState*)perBodyStates[index].get(), changed[i]);
+
+            const btTransform& expected = perBodyStates[index]->getTransform();
+            QVERIFY(buffer.positions[i] == bulletToGLM(expected.getOrigin()));
+            QVERIFY(buffer.rotations[i] == bulletToGLM(expected.getRotation()));
+            // the first body is the ground, which has no motion state
+            QVERIFY(buffer.linearVelocities[i] == bulletToGLM(perBody.getBodies()[index + 1]->getLinearVelocity()));
+        }
+    }
+}
@@ -0,0 +1,27 @@
+//
+//  ThreadSafeDynamicsWorldTests.h
+//  tests/physics/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ThreadSafeDynamicsWorldTests_h
+#define hifi_ThreadSafeDynamicsWorldTests_h
+
+#include <QtTest/QtTest>
+
+class ThreadSafeDynamicsWorldTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testNumPhysicsThreads();
+    void testSubstepCallback();
+    void testParallelIslandsMatchSequential();
+    void testBulkMotionStateSync();
+};
+
+#endif // hifi_ThreadSafeDynamicsWorldTests_h
@@ -101,6 +101,55 @@ void testFilePersist() {
     QVERIFY(readClip->duration() == 5.0f);
 }
 
+void testChunkedFilePersist() {
+    QTemporaryFile file;
+    QString fileName;
+    if (file.open()) {
+        fileName = file.fileName();
+        file.close();
+    }
+
+    // enough frames for several chunks, alike enough for some of them to be compressed
+    auto writeClip = Clip::newClip();
+    for (int i = 0; i < 300; ++i) {
+        writeClip->addFrame(std::make_shared<Frame>(TEST_FRAME_TYPE, (float)(i * 10), QByteArray(i % 7, (char)i)));
+    }
+    // Simulate an unknown frametype, which isn't written
+    writeClip->addFrame(std::make_shared<Frame>(Frame::TYPE_INVALID - 1, 5000.0f, QByteArray()));
+    QVERIFY(Clip::toChunkedFile(fileName, writeClip));
+
+    auto readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == 300);
+    QVERIFY(readClip->duration() == Frame::frameTimeToSeconds(2990));
+
+    readClip->seek(0);
+    writeClip->seek(0);
+    size_t count = 0;
+    for (auto readFrame = readClip->nextFrame(); readFrame; readFrame = readClip->nextFrame(), ++count) {
+        auto writeFrame = writeClip->nextFrame();
+        QVERIFY(readFrame->type == writeFrame->type);
+        QVERIFY(readFrame->timeOffset == writeFrame->timeOffset);
+        QVERIFY(readFrame->data == writeFrame->data);
+    }
+    QVERIFY(count == 300);
+
+    // seeking lands on the first frame at or after the time, across chunks and between frames
+    readClip->seekFrameTime(1995);
+    QVERIFY(readClip->positionFrameTime() == 2000);
+    readClip->seekFrameTime(10);
+    QVERIFY(readClip->positionFrameTime() == 10);
+    readClip->seekFrameTime(3000);
+    QVERIFY(readClip->positionFrameTime() == Frame::INVALID_TIME);
+    QVERIFY(!readClip->nextFrame());
+
+    // and back to .hfr
+    Clip::toFile(fileName, readClip);
+    readClip = Clip::fromFile(fileName);
+    QVERIFY(readClip != Clip::Pointer());
+    QVERIFY(readClip->frameCount() == 300);
+}
+
 void testClipOrdering() {
     auto writeClip = Clip::newClip();
     // simulate our of order addition of frames
@@ -124,5 +173,6 @@ int main(int, const char**) {
 
     testFrameTypeRegistration();
     testFilePersist();
+    testChunkedFilePersist();
     testClipOrdering();
 }
@@ -0,0 +1,143 @@
+//
+//  ScriptBenchmarks.cpp
+//  tests/script-engine/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptBenchmarks.h"
+
+#include <QtScript/QScriptContext>
+#include <QtScript/QScriptEngine>
+
+QTEST_MAIN(ScriptBenchmarks)
+
+static const QString VECTOR_MATH_PROGRAM = R"(
+function vectorMath(count) {
+    var position = { x: 0, y: 0, z: 0 };
+    var velocity = { x: 0.1, y: 0.2, z: 0.3 };
+    for (var i = 0; i < count; i++) {
+        var gravity = { x: 0, y: -9.8 * 0.01, z: 0 };
+        velocity = { x: velocity.x + gravity.x, y: velocity.y + gravity.y, z: velocity.z + gravity.z };
+        position = { x: position.x + velocity.x, y: position.y + velocity.y, z: position.z + velocity.z };
+        var length = Math.sqrt(position.x * position.x + position.y * position.y + position.z * position.z);
+        if (length > 100) {
+            position = { x: position.x / length, y: position.y / length, z: position.z / length };
+        }
+    }
+    return position.x + position.y + position.z;
+}
+)";
+
+static const QString CLOSURES_PROGRAM = R"(
+function closures(count) {
+    var values = [];
+    for (var i = 0; i < count; i++) {
+        values.push(i);
+    }
+    var scale = 3;
+    return values.map(function (value) { return value * scale; })
+        .filter(function (value) { return value % 2 === 0; })
+        .reduce(function (sum, value) { return sum + value; }, 0);
+}
+)";
+
+static const QString STRINGS_AND_JSON_PROGRAM = R"(
+function stringsAndJSON(count) {
+    var entities = [];
+    for (var i = 0; i < count; i++) {
+        entities.push({ id: "{" + i + "}", name: "Entity " + i, position: { x: i, y: i * 2, z: i * 3 } });
+    }
+    var parsed = JSON.parse(JSON.stringify(entities));
+    var names = "";
+    for (var j = 0; j < parsed.length; j++) {
+        names += parsed[j].name.toUpperCase() + ",";
+    }
+    return names.length;
+}
+)";
+
+static const QString NATIVE_CALLS_PROGRAM = R"(
+function nativeCalls(count) {
+    var sum = 0;
+    for (var i = 0; i < count; i++) {
+        sum += nativeAdd(i, 1);
+    }
+    return sum;
+}
+)";
+
+static const int BENCHMARK_COUNT = 1000;
+
+static QScriptValue nativeAdd(QScriptContext* context, QScriptEngine*) {
+    return QScriptValue(context->argument(0).toNumber() + context->argument(1).toNumber());
+}
+
+static QScriptValue createProgram(QScriptEngine& engine, const QString& program, const QString& functionName) {
+    engine.evaluate(program, functionName + ".js");
+    if (engine.hasUncaughtException()) {
+        qWarning() << functionName << engine.uncaughtException().toString();
+        engine.clearExceptions();
+    }
+    engine.globalObject().setProperty("nativeAdd", engine.newFunction(nativeAdd, 2));
+    return engine.globalObject().property(functionName);
+}
+
+void ScriptBenchmarks::testWorkloads() {
+    QScriptEngine engine;
+    auto closures = createProgram(engine, CLOSURES_PROGRAM, "closures");
+    auto stringsAndJSON = createProgram(engine, STRINGS_AND_JSON_PROGRAM, "stringsAndJSON");
+    auto nativeCalls = createProgram(engine, NATIVE_CALLS_PROGRAM, "nativeCalls");
+    auto vectorMath = createProgram(engine, VECTOR_MATH_PROGRAM, "vectorMath");
+
+    // 3 * (0 + 2 + 4 + 6 + 8)
+    QCOMPARE(closures.call(QScriptValue(), QScriptValueList { 10 }).toInt32(), 60);
+    QCOMPARE(stringsAndJSON.call(QScriptValue(), QScriptValueList { 2 }).toInt32(), 18);
+    QCOMPARE(nativeCalls.call(QScriptValue(), QScriptValueList { 4 }).toInt32(), 10);
+    QVERIFY(vectorMath.call(QScriptValue(), QScriptValueList { 10 }).isNumber());
+    QVERIFY(!engine.hasUncaughtException());
+}
+
+void ScriptBenchmarks::benchmarkVectorMath() {
+    QScriptEngine engine;
+    auto function = createProgram(engine, VECTOR_MATH_PROGRAM, "vectorMath");
+    QVERIFY(function.isFunction());
+
+    QBENCHMARK {
+        function.call(QScriptValue(), QScriptValueList { BENCHMARK_COUNT });
+    }
+}
+
+void ScriptBenchmarks::benchmarkClosures() {
+    QScriptEngine engine;
+    auto function = createProgram(engine, CLOSURES_PROGRAM, "closures");
+    QVERIFY(function.isFunction());
+
+    QBENCHMARK {
+        function.call(QScriptValue(), QScriptValueList { BENCHMARK_COUNT });
+    }
+}
+
+void ScriptBenchmarks::benchmarkStringsAndJSON() {
+    QScriptEngine engine;
+    auto function = createProgram(engine, STRINGS_AND_JSON_PROGRAM, "stringsAndJSON");
+    QVERIFY(function.isFunction());
+
+    QBENCHMARK {
+        function.call(QScriptValue(), QScriptValueList { BENCHMARK_COUNT / 10 });
+    }
+}
+
+void ScriptBenchmarks::benchmarkNativeCalls() {
+    QScriptEngine engine;
+    auto function = createProgram(engine, NATIVE_CALLS_PROGRAM, "nativeCalls");
+    QVERIFY(function.isFunction());
+
+    QBENCHMARK {
+        function.call(QScriptValue(), QScriptValueList { BENCHMARK_COUNT });
+    }
+}
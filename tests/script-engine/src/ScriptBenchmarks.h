@@ -0,0 +1,31 @@
+//
+//  ScriptBenchmarks.h
+//  tests/script-engine/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptBenchmarks_h
+#define hifi_ScriptBenchmarks_h
+
+#include <QtTest/QtTest>
+
+// Times the workloads scripts lean on: vector math on small objects, closures over arrays, strings and JSON, and calls
+// into native code, so that a change of script engine can be measured against the same programs.
+class ScriptBenchmarks : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testWorkloads();
+
+    void benchmarkVectorMath();
+    void benchmarkClosures();
+    void benchmarkStringsAndJSON();
+    void benchmarkNativeCalls();
+};
+
+#endif // hifi_ScriptBenchmarks_h
@@ -0,0 +1,131 @@
+//
+//  ScriptProgramCacheTests.cpp
+//  tests/script-engine/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptProgramCacheTests.h"
+
+#include <QtScript/QScriptEngine>
+
+#include <ScriptProgramCache.h>
+
+QTEST_MAIN(ScriptProgramCacheTests)
+
+static const QString PROGRAM = "(function (a, b) { return a + b; })";
+
+void ScriptProgramCacheTests::init() {
+    auto& cache = ScriptProgramCache::getInstance();
+    cache.clear();
+    cache.setMaxBytes(ScriptProgramCache::DEFAULT_MAX_BYTES);
+}
+
+void ScriptProgramCacheTests::cleanupTestCase() {
+    ScriptProgramCache::getInstance().clear();
+}
+
+void ScriptProgramCacheTests::testSyntaxCheck() {
+    auto& cache = ScriptProgramCache::getInstance();
+
+    auto valid = cache.checkSyntax(PROGRAM);
+    QVERIFY(valid.isValid);
+    auto misses = cache.getStats().misses;
+    auto hits = cache.getStats().hits;
+
+    QVERIFY(cache.checkSyntax(PROGRAM).isValid);
+    QCOMPARE(cache.getStats().misses, misses);
+    QCOMPARE(cache.getStats().hits, hits + 1);
+
+    auto invalid = cache.checkSyntax("var a = ;\n");
+    QVERIFY(!invalid.isValid);
+    QVERIFY(!invalid.errorMessage.isEmpty());
+    QCOMPARE(invalid.errorLineNumber, 1);
+
+    // the cached outcome is the same as the first
+    auto cachedInvalid = cache.checkSyntax("var a = ;\n");
+    QVERIFY(!cachedInvalid.isValid);
+    QCOMPARE(cachedInvalid.errorMessage, invalid.errorMessage);
+    QCOMPARE(cachedInvalid.errorColumnNumber, invalid.errorColumnNumber);
+}
+
+void ScriptProgramCacheTests::testProgramsPerEngine() {
+    auto& cache = ScriptProgramCache::getInstance();
+    QScriptEngine first;
+    QScriptEngine second;
+
+    auto program = cache.getProgram(&first, PROGRAM, "test.js");
+    QVERIFY(!program.isNull());
+    QCOMPARE(first.evaluate(program).call(QScriptValue(), { 2, 3 }).toInt32(), 5);
+
+    // the same source and file name in the same engine is the same program, compiled once
+    cache.getProgram(&first, PROGRAM, "test.js");
+    QCOMPARE(cache.getStats().numPrograms, 1);
+    QCOMPARE(first.evaluate(cache.getProgram(&first, PROGRAM, "test.js")).call(QScriptValue(), { 4, 5 }).toInt32(), 9);
+
+    // another engine gets a program of its own, as does the same source under another file name
+    auto secondProgram = cache.getProgram(&second, PROGRAM, "test.js");
+    QCOMPARE(second.evaluate(secondProgram).call(QScriptValue(), { 1, 1 }).toInt32(), 2);
+    cache.getProgram(&first, PROGRAM, "other.js");
+    QCOMPARE(cache.getStats().numPrograms, 3);
+    QCOMPARE(cache.getStats().numEntries, 1);
+
+    cache.releaseEngine(&first);
+    cache.releaseEngine(&second);
+}
+
+void ScriptProgramCacheTests::testReleaseEngine() {
+    auto& cache = ScriptProgramCache::getInstance();
+    QScriptEngine first;
+    QScriptEngine second;
+
+    cache.checkSyntax(PROGRAM);
+    cache.getProgram(&first, PROGRAM, "test.js");
+    cache.getProgram(&second, PROGRAM, "test.js");
+    cache.getProgram(&first, "1 + 1", "sum.js");
+    auto bytes = cache.getStats().bytes;
+
+    cache.releaseEngine(&first);
+    auto stats = cache.getStats();
+    QCOMPARE(stats.numPrograms, 1);
+    QVERIFY(stats.bytes < bytes);
+
+    // the syntax check outlives the programs, an entry with nothing left in it goes
+    QCOMPARE(stats.numEntries, 1);
+    cache.releaseEngine(&second);
+    QCOMPARE(cache.getStats().numPrograms, 0);
+    QCOMPARE(cache.getStats().numEntries, 1);
+}
+
+void ScriptProgramCacheTests::testEviction() {
+    auto& cache = ScriptProgramCache::getInstance();
+    QScriptEngine engine;
+
+    const QString source = QString("var padding = \"%1\"; ").arg(QString(1000, 'x'));
+    cache.getProgram(&engine, source + "1;", "one.js");
+    auto bytesPerEntry = cache.getStats().bytes;
+    cache.setMaxBytes(bytesPerEntry * 3);
+
+    for (int i = 0; i < 10; ++i) {
+        cache.getProgram(&engine, source + QString::number(i) + ";", "many.js");
+    }
+    auto stats = cache.getStats();
+    QCOMPARE(stats.numEntries, 3);
+    QCOMPARE(stats.evictions, (uint64_t)8);
+    QVERIFY(stats.bytes <= stats.maxBytes);
+
+    // the most recently used are the ones kept
+    auto misses = stats.misses;
+    cache.getProgram(&engine, source + "9;", "many.js");
+    QCOMPARE(cache.getStats().misses, misses);
+
+    // an entry bigger than the limit is still kept while it is the one in use
+    cache.setMaxBytes(1);
+    QCOMPARE(cache.getStats().numEntries, 1);
+
+    cache.releaseEngine(&engine);
+}
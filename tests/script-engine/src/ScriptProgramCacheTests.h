@@ -0,0 +1,30 @@
+//
+//  ScriptProgramCacheTests.h
+//  tests/script-engine/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptProgramCacheTests_h
+#define hifi_ScriptProgramCacheTests_h
+
+#include <QtTest/QtTest>
+
+class ScriptProgramCacheTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void init();
+    void cleanupTestCase();
+
+    void testSyntaxCheck();
+    void testProgramsPerEngine();
+    void testReleaseEngine();
+    void testEviction();
+};
+
+#endif // hifi_ScriptProgramCacheTests_h
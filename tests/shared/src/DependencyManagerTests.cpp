@@ -216,3 +216,71 @@ void DependencyManagerTests::testDependencyManagerMultiThreaded() {
     getThread2.join();
     assertDeps(false);
 }
+
+namespace {
+
+class Replaced : public Dependency {
+public:
+    Replaced(int value) : value(value) {}
+    int value;
+};
+
+class Base : public Dependency {
+public:
+    virtual ~Base() {}
+    virtual int value() const { return 1; }
+};
+
+class Derived : public Base {
+public:
+    int value() const override { return 2; }
+};
+
+class Benchmarked : public Dependency {};
+
+}
+
+void DependencyManagerTests::testReplacedInstances() {
+    // the instance get() keeps after the first call follows set() and destroy()
+    QVERIFY(!DependencyManager::isSet<Replaced>());
+    DependencyManager::set<Replaced>(1);
+    QCOMPARE(DependencyManager::get<Replaced>()->value, 1);
+    QVERIFY(DependencyManager::isSet<Replaced>());
+
+    DependencyManager::set<Replaced>(2);
+    QCOMPARE(DependencyManager::get<Replaced>()->value, 2);
+
+    DependencyManager::destroy<Replaced>();
+    QVERIFY(!DependencyManager::isSet<Replaced>());
+    QVERIFY(DependencyManager::get<Replaced>().isNull());
+
+    DependencyManager::set<Replaced>(3);
+    QCOMPARE(DependencyManager::get<Replaced>()->value, 3);
+    DependencyManager::destroy<Replaced>();
+}
+
+void DependencyManagerTests::testInheritance() {
+    DependencyManager::registerInheritance<Base, Derived>();
+    DependencyManager::set<Derived>();
+    QVERIFY(DependencyManager::isSet<Base>());
+    QCOMPARE(DependencyManager::get<Base>()->value(), 2);
+
+    DependencyManager::destroy<Derived>();
+    QVERIFY(!DependencyManager::isSet<Base>());
+}
+
+void DependencyManagerTests::benchmarkGet() {
+    DependencyManager::set<Benchmarked>();
+    QBENCHMARK {
+        DependencyManager::get<Benchmarked>();
+    }
+    DependencyManager::destroy<Benchmarked>();
+}
+
+void DependencyManagerTests::benchmarkIsSet() {
+    DependencyManager::set<Benchmarked>();
+    QBENCHMARK {
+        DependencyManager::isSet<Benchmarked>();
+    }
+    DependencyManager::destroy<Benchmarked>();
+}
@@ -16,6 +16,10 @@ class DependencyManagerTests : public QObject {
 private slots:
     void testDependencyManager();
     void testDependencyManagerMultiThreaded();
+    void testReplacedInstances();
+    void testInheritance();
+    void benchmarkGet();
+    void benchmarkIsSet();
 };
 
 #endif // hifi_DependencyManagerTests_h
@@ -0,0 +1,130 @@
+//
+//  FrameArenaTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameArenaTests.h"
+
+#include <map>
+#include <thread>
+
+#include <FrameArena.h>
+
+QTEST_MAIN(FrameArenaTests)
+
+void FrameArenaTests::testAlignment() {
+    FrameArena arena(256);
+    for (size_t alignment = 1; alignment <= 64; alignment *= 2) {
+        arena.allocate(1, 1);
+        auto pointer = (uintptr_t)arena.allocate(3, alignment);
+        QCOMPARE(pointer % alignment, (uintptr_t)0);
+    }
+
+    // bigger than a block
+    auto pointer = (uintptr_t)arena.allocate(1000, 32);
+    QCOMPARE(pointer % 32, (uintptr_t)0);
+}
+
+void FrameArenaTests::testResetReusesMemory() {
+    FrameArena arena(1024);
+    auto frame = [&] {
+        for (int i = 0; i < 100; ++i) {
+            memset(arena.allocate(100), i, 100);
+        }
+    };
+
+    frame();
+    auto stats = arena.takeStats();
+    QCOMPARE(stats.numAllocations, (uint64_t)100);
+    QCOMPARE(stats.numBytes, (uint64_t)10000);
+    QVERIFY(stats.numBlockAllocations > 1);
+
+    // the blocks are merged into one that holds all of the next frame
+    arena.reset();
+    QVERIFY(arena.getCapacity() >= 10000);
+    arena.takeStats();
+    frame();
+    QCOMPARE(arena.takeStats().numBlockAllocations, (uint64_t)0);
+    arena.reset();
+    frame();
+    QCOMPARE(arena.takeStats().numBlockAllocations, (uint64_t)0);
+}
+
+void FrameArenaTests::testScopes() {
+    FrameArena arena(1024);
+    void* kept = arena.allocate(16);
+    void* first;
+    {
+        FrameArena::Scope scope(arena);
+        first = arena.allocate(16);
+        QVERIFY(first != kept);
+        {
+            FrameArena::Scope innerScope(arena);
+            arena.allocate(4000);
+        }
+    }
+    // what the scope allocated is handed out again, what was there before it stays
+    FrameArena::Scope scope(arena);
+    QCOMPARE(arena.allocate(16), first);
+
+    arena.takeStats();
+    arena.allocate(4000);
+    QCOMPARE(arena.takeStats().numBlockAllocations, (uint64_t)0);
+}
+
+void FrameArenaTests::testContainers() {
+    FrameArena arena;
+    arena.takeStats();
+
+    ArenaVector<int> numbers { ArenaAllocator<int>(arena) };
+    for (int i = 0; i < 10000; ++i) {
+        numbers.push_back(i);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        QCOMPARE(numbers[i], i);
+    }
+
+    using ArenaMap = std::map<int, int, std::less<int>, ArenaAllocator<std::pair<const int, int>>>;
+    ArenaMap map { ArenaMap::allocator_type(arena) };
+    for (int i = 0; i < 1000; ++i) {
+        map[i * 7 % 1000] = i;
+    }
+    QCOMPARE(map.size(), (size_t)1000);
+    QCOMPARE(map[7], 1);
+
+    auto stats = arena.takeStats();
+    QVERIFY(stats.numAllocations > 1000);
+    QVERIFY(stats.numBlockAllocations < stats.numAllocations);
+}
+
+void FrameArenaTests::testThreadArena() {
+    FrameArena::takeThreadArenaStats();
+
+    FrameArena* mainArena = &FrameArena::forCurrentThread();
+    FrameArena* otherArena = nullptr;
+    std::thread thread([&] {
+        otherArena = &FrameArena::forCurrentThread();
+        FrameArena::Scope scope(FrameArena::forCurrentThread());
+        ArenaVector<int> numbers { ArenaAllocator<int>(scope.getArena()) };
+        numbers.resize(100);
+    });
+    thread.join();
+    QVERIFY(otherArena != mainArena);
+
+    {
+        FrameArena::Scope scope(FrameArena::forCurrentThread());
+        scope.getArena().allocate(8);
+    }
+
+    // counted once each scope has ended
+    auto stats = FrameArena::takeThreadArenaStats();
+    QCOMPARE(stats.numAllocations, (uint64_t)2);
+    QCOMPARE(stats.numBytes, (uint64_t)(100 * sizeof(int) + 8));
+    QCOMPARE(FrameArena::takeThreadArenaStats().numAllocations, (uint64_t)0);
+}
@@ -0,0 +1,28 @@
+//
+//  FrameArenaTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_FrameArenaTests_h
+#define hifi_FrameArenaTests_h
+
+#include <QtTest/QtTest>
+
+class FrameArenaTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testAlignment();
+    void testResetReusesMemory();
+    void testScopes();
+    void testContainers();
+    void testThreadArena();
+};
+
+#endif // hifi_FrameArenaTests_h
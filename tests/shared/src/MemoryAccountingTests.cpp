@@ -0,0 +1,136 @@
+//
+//  MemoryAccountingTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MemoryAccountingTests.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <FixedSizePool.h>
+#include <FrameArena.h>
+#include <MemoryAccounting.h>
+
+MEMORY_ACCOUNTING_HOOKS()
+
+QTEST_MAIN(MemoryAccountingTests)
+
+static int64_t getTagBytes(MemoryTag tag) {
+    return MemoryAccounting::takeSnapshot().tags[(int)tag].bytes;
+}
+
+void MemoryAccountingTests::testScopes() {
+    QCOMPARE(MemoryAccounting::getCurrentTag(), MemoryTag::Other);
+    {
+        MemoryAccounting::Scope scope(MemoryTag::Entities);
+        QCOMPARE(MemoryAccounting::getCurrentTag(), MemoryTag::Entities);
+        {
+            MemoryAccounting::Scope innerScope(MemoryTag::Physics);
+            QCOMPARE(MemoryAccounting::getCurrentTag(), MemoryTag::Physics);
+        }
+        QCOMPARE(MemoryAccounting::getCurrentTag(), MemoryTag::Entities);
+
+        // a thread starts outside any scope
+        MemoryTag threadTag = MemoryTag::Entities;
+        std::thread([&] { threadTag = MemoryAccounting::getCurrentTag(); }).join();
+        QCOMPARE(threadTag, MemoryTag::Other);
+    }
+    QCOMPARE(MemoryAccounting::getCurrentTag(), MemoryTag::Other);
+}
+
+void MemoryAccountingTests::testAllocatorBlocks() {
+    int64_t audioBytes = getTagBytes(MemoryTag::Audio);
+    {
+        FrameArena arena(1024, MemoryTag::Audio);
+        for (int i = 0; i < 10; ++i) {
+            arena.allocate(500);
+        }
+        QCOMPARE(getTagBytes(MemoryTag::Audio), audioBytes + (int64_t)arena.getCapacity());
+
+        // merging the blocks keeps the capacity
+        arena.reset();
+        QCOMPARE(getTagBytes(MemoryTag::Audio), audioBytes + (int64_t)arena.getCapacity());
+    }
+    QCOMPARE(getTagBytes(MemoryTag::Audio), audioBytes);
+
+    int64_t otherBytes = getTagBytes(MemoryTag::Other);
+    int64_t physicsBytes = getTagBytes(MemoryTag::Physics);
+    FixedSizePool pool(32, 8, 4);
+    void* slot = pool.allocate();
+    QCOMPARE(getTagBytes(MemoryTag::Other), otherBytes + (int64_t)pool.getCapacityBytes());
+
+    // the blocks it has already move to the tag
+    pool.setMemoryTag(MemoryTag::Physics);
+    QCOMPARE(getTagBytes(MemoryTag::Other), otherBytes);
+    QCOMPARE(getTagBytes(MemoryTag::Physics), physicsBytes + (int64_t)pool.getCapacityBytes());
+    for (int i = 0; i < 4; ++i) {
+        pool.allocate();
+    }
+    QCOMPARE(getTagBytes(MemoryTag::Physics), physicsBytes + (int64_t)pool.getCapacityBytes());
+    pool.deallocate(slot);
+}
+
+void MemoryAccountingTests::testHooks() {
+    QVERIFY(MemoryAccounting::areHooksInstalled());
+
+    static const int NUM_ALLOCATIONS = 100;
+    static const size_t ALLOCATION_SIZE = 1000;
+    auto before = MemoryAccounting::takeSnapshot();
+    uint64_t numAllocationsBefore = MemoryAccounting::getNumAllocations();
+    uint64_t numAllocatedBytesBefore = MemoryAccounting::getNumAllocatedBytes();
+    std::vector<std::unique_ptr<char[]>> allocations;
+    {
+        MemoryAccounting::Scope scope(MemoryTag::Scripts);
+        for (int i = 0; i < NUM_ALLOCATIONS; ++i) {
+            allocations.emplace_back(new char[ALLOCATION_SIZE]);
+        }
+    }
+    auto during = MemoryAccounting::takeSnapshot();
+
+    const auto& scriptStats = during.tags[(int)MemoryTag::Scripts];
+    const auto& scriptStatsBefore = before.tags[(int)MemoryTag::Scripts];
+    QVERIFY(scriptStats.numAllocations >= scriptStatsBefore.numAllocations + NUM_ALLOCATIONS);
+    QVERIFY(scriptStats.numAllocatedBytes >= scriptStatsBefore.numAllocatedBytes + NUM_ALLOCATIONS * ALLOCATION_SIZE);
+    QVERIFY(during.heapBytes >= before.heapBytes + (int64_t)(NUM_ALLOCATIONS * ALLOCATION_SIZE));
+
+    // the totals are up to date for the thread asking, as benchmarks need
+    QVERIFY(MemoryAccounting::getNumAllocations() >= numAllocationsBefore + NUM_ALLOCATIONS);
+    QVERIFY(MemoryAccounting::getNumAllocatedBytes() >= numAllocatedBytesBefore + NUM_ALLOCATIONS * ALLOCATION_SIZE);
+
+    // freeing is counted against the heap, whatever scope it's in
+    allocations.clear();
+    allocations.shrink_to_fit();
+    auto after = MemoryAccounting::takeSnapshot();
+    QVERIFY(after.heapBytes <= during.heapBytes - (int64_t)(NUM_ALLOCATIONS * ALLOCATION_SIZE));
+}
+
+void MemoryAccountingTests::testJson() {
+    MemoryAccounting::Snapshot previous;
+    previous.timestamp = 1000000;
+    previous.heapBytes = 4096;
+    previous.tags[(int)MemoryTag::Avatars] = { 100, 10, 1000 };
+
+    MemoryAccounting::Snapshot snapshot = previous;
+    snapshot.timestamp = 3000000;
+    snapshot.tags[(int)MemoryTag::Avatars] = { 200, 30, 5000 };
+
+    auto json = MemoryAccounting::toJson(snapshot, &previous);
+    QCOMPARE(json["heap_bytes"].toDouble(), 4096.0);
+    auto avatars = json["tags"].toObject()["avatars"].toObject();
+    QCOMPARE(avatars["bytes"].toDouble(), 200.0);
+    QCOMPARE(avatars["allocations_per_second"].toDouble(), 10.0);
+    QCOMPARE(avatars["allocated_bytes_per_second"].toDouble(), 2000.0);
+
+    // without a previous snapshot there are no rates
+    json = MemoryAccounting::toJson(snapshot);
+    QVERIFY(!json["tags"].toObject()["avatars"].toObject().contains("allocations_per_second"));
+    QCOMPARE(json["tags"].toObject().size(), MemoryAccounting::NUM_TAGS);
+}
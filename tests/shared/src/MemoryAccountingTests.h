@@ -0,0 +1,27 @@
+//
+//  MemoryAccountingTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MemoryAccountingTests_h
+#define hifi_MemoryAccountingTests_h
+
+#include <QtTest/QtTest>
+
+class MemoryAccountingTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testScopes();
+    void testAllocatorBlocks();
+    void testHooks();
+    void testJson();
+};
+
+#endif // hifi_MemoryAccountingTests_h
@@ -0,0 +1,95 @@
+//
+//  PerformanceCountersTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PerformanceCountersTests.h"
+
+#include <thread>
+#include <vector>
+
+#include <PerformanceCounters.h>
+
+QTEST_MAIN(PerformanceCountersTests)
+
+void PerformanceCountersTests::testCounter() {
+    auto& counters = PerformanceCounters::getInstance();
+    auto& counter = counters.counter("test_events", "Events counted by the test");
+
+    // asking again gives the same counter
+    QCOMPARE(&counters.counter("test_events", "Another help"), &counter);
+
+    static const int NUM_THREADS = 4;
+    static const int NUM_INCREMENTS = 10000;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([&counter] {
+            for (int j = 0; j < NUM_INCREMENTS; ++j) {
+                counter.increment();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    QCOMPARE(counter.get(), (uint64_t)(NUM_THREADS * NUM_INCREMENTS));
+
+    auto json = counters.toJson()["counters"].toObject()["test_events"].toObject();
+    QCOMPARE(json["value"].toDouble(), (double)(NUM_THREADS * NUM_INCREMENTS));
+    QCOMPARE(json["help"].toString(), QString("Events counted by the test"));
+}
+
+void PerformanceCountersTests::testGauge() {
+    auto& gauge = PerformanceCounters::getInstance().gauge("test_queue_depth", "Queued test items");
+    QCOMPARE(gauge.get(), 0.0);
+
+    gauge.set(2.5);
+    gauge.add(3.0);
+    gauge.add(-1.5);
+    QCOMPARE(gauge.get(), 4.0);
+
+    auto json = PerformanceCounters::getInstance().toJson()["gauges"].toObject()["test_queue_depth"].toObject();
+    QCOMPARE(json["value"].toDouble(), 4.0);
+}
+
+void PerformanceCountersTests::testHistogram() {
+    auto& histogram = PerformanceCounters::getInstance().histogram("test_frame_time_usecs", "Test frame time");
+    histogram.record(50);
+    histogram.record(100); // on a bound, counted in that bound's bucket
+    histogram.record(101);
+    histogram.record(3000);
+    histogram.record(20000000); // above every bound
+
+    auto json = PerformanceCounters::getInstance().toJson()["histograms"].toObject()["test_frame_time_usecs"].toObject();
+    auto counts = json["counts"].toArray();
+    QCOMPARE(counts.size(), PerformanceCounters::Histogram::NUM_BOUNDS + 1);
+    QCOMPARE(json["bounds"].toArray().size(), PerformanceCounters::Histogram::NUM_BOUNDS);
+    QCOMPARE(counts[0].toDouble(), 2.0);
+    QCOMPARE(counts[1].toDouble(), 1.0);
+    QCOMPARE(counts[5].toDouble(), 1.0); // 5ms
+    QCOMPARE(counts[PerformanceCounters::Histogram::NUM_BOUNDS].toDouble(), 1.0);
+    QCOMPARE(json["count"].toDouble(), 5.0);
+    QCOMPARE(json["sum"].toDouble(), 20003251.0);
+}
+
+void PerformanceCountersTests::testReset() {
+    auto& counters = PerformanceCounters::getInstance();
+    auto& counter = counters.counter("test_reset_events", "Events");
+    auto& histogram = counters.histogram("test_reset_usecs", "Durations");
+    counter.increment(5);
+    histogram.record(1000);
+
+    counters.reset();
+    QCOMPARE(counter.get(), (uint64_t)0);
+    auto json = counters.toJson()["histograms"].toObject()["test_reset_usecs"].toObject();
+    QCOMPARE(json["count"].toDouble(), 0.0);
+
+    // the metrics stay registered
+    QVERIFY(counters.toJson()["counters"].toObject().contains("test_reset_events"));
+}
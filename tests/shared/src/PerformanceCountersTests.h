@@ -0,0 +1,27 @@
+//
+//  PerformanceCountersTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PerformanceCountersTests_h
+#define hifi_PerformanceCountersTests_h
+
+#include <QtTest/QtTest>
+
+class PerformanceCountersTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCounter();
+    void testGauge();
+    void testHistogram();
+    void testReset();
+};
+
+#endif // hifi_PerformanceCountersTests_h
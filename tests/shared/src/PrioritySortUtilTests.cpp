@@ -0,0 +1,174 @@
+//
+//  PrioritySortUtilTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PrioritySortUtilTests.h"
+
+#include <random>
+
+#include <PrioritySortUtil.h>
+
+QTEST_MAIN(PrioritySortUtilTests)
+
+namespace {
+    class SortableThing final : public PrioritySortUtil::Sortable {
+    public:
+        SortableThing(int id, const glm::vec3& position, float radius, uint64_t timestamp) :
+            _id(id), _position(position), _radius(radius), _timestamp(timestamp) {}
+
+        glm::vec3 getPosition() const override { return _position; }
+        float getRadius() const override { return _radius; }
+        uint64_t getTimestamp() const override { return _timestamp; }
+        int getId() const { return _id; }
+
+    private:
+        int _id;
+        glm::vec3 _position;
+        float _radius;
+        uint64_t _timestamp;
+    };
+
+    // the priority as computed one thing and one view at a time before priorities were batched
+    float referencePriority(const ConicalViewFrustums& views, const SortableThing& thing, uint64_t now) {
+        float priority = std::numeric_limits<float>::min();
+        for (const auto& view : views) {
+            glm::vec3 offset = thing.getPosition() - view.getPosition();
+            float distance = glm::length(offset) + 0.001f;
+            float radius = glm::max(thing.getRadius(), 0.1f);
+            float cosineAngle = glm::dot(offset, view.getDirection()) / distance;
+            if (cosineAngle > 0.0f) {
+                cosineAngle = std::sqrt(cosineAngle);
+            }
+            float age = float((now - thing.getTimestamp()) / USECS_PER_SECOND);
+            float viewPriority = (PrioritySortUtil::DEFAULT_ANGULAR_COEF * radius / distance +
+                PrioritySortUtil::DEFAULT_CENTER_COEF * cosineAngle) * (age + 1.0f) + PrioritySortUtil::DEFAULT_AGE_COEF * age;
+            if (distance - radius > view.getRadius() && !view.intersects(offset, distance, radius)) {
+                viewPriority += OUT_OF_VIEW_PENALTY;
+            }
+            priority = std::max(priority, viewPriority);
+        }
+        return priority;
+    }
+
+    ConicalViewFrustums makeViews() {
+        ConicalViewFrustums views(2);
+        views[1].setPositionAndSimpleRadius(glm::vec3(40.0f, 0.0f, -20.0f), 15.0f);
+        return views;
+    }
+
+    std::vector<SortableThing> makeThings(int count, uint64_t now) {
+        std::mt19937 generator(count);
+        std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> radius(0.0f, 3.0f);
+        std::uniform_int_distribution<uint64_t> seconds(0, 5);
+        // the ages are half a second off whole seconds, so they come out the same for a queue whose clock started
+        // a little after now
+        std::vector<SortableThing> things;
+        for (int i = 0; i < count; ++i) {
+            glm::vec3 position(coordinate(generator), coordinate(generator), coordinate(generator));
+            // every tenth the same as the one before, for some equal priorities
+            if (i % 10 == 9) {
+                things.push_back(SortableThing(i, things.back().getPosition(), things.back().getRadius(),
+                                               things.back().getTimestamp()));
+            } else {
+                uint64_t timestamp = now - seconds(generator) * USECS_PER_SECOND - USECS_PER_SECOND / 2;
+                things.push_back(SortableThing(i, position, radius(generator), timestamp));
+            }
+        }
+        return things;
+    }
+
+    bool isCloseEnough(float priority, float expected) {
+        return std::abs(priority - expected) <= 1.0e-5f * std::max(1.0f, std::abs(expected));
+    }
+}
+
+void PrioritySortUtilTests::testPriorities() {
+    auto views = makeViews();
+    uint64_t now = usecTimestampNow();
+    PrioritySortUtil::PriorityQueue<SortableThing> queue(views);
+    auto things = makeThings(1000, now);
+    for (const auto& thing : things) {
+        queue.push(thing);
+    }
+
+    for (const auto& sorted : queue.getSortedVector()) {
+        QVERIFY(isCloseEnough(sorted.getPriority(), referencePriority(views, things[sorted.getId()], now)));
+    }
+}
+
+void PrioritySortUtilTests::testSortedVector() {
+    auto views = makeViews();
+    for (int count : { 10, 300, 5000 }) {
+        PrioritySortUtil::PriorityQueue<SortableThing> queue(views);
+        auto things = makeThings(count, usecTimestampNow());
+        for (const auto& thing : things) {
+            queue.push(thing);
+        }
+
+        const auto& sorted = queue.getSortedVector();
+        QCOMPARE((int)sorted.size(), count);
+        std::vector<bool> seen(count, false);
+        for (int i = 0; i < count; ++i) {
+            QVERIFY(!seen[sorted[i].getId()]);
+            seen[sorted[i].getId()] = true;
+            if (i > 0) {
+                QVERIFY(sorted[i - 1].getPriority() >= sorted[i].getPriority());
+                // things of equal priority stay in the order they were pushed
+                if (sorted[i - 1].getPriority() == sorted[i].getPriority()) {
+                    QVERIFY(sorted[i - 1].getId() < sorted[i].getId());
+                }
+            }
+        }
+    }
+}
+
+void PrioritySortUtilTests::testTopK() {
+    auto views = makeViews();
+    for (int count : { 100, 5000 }) {
+        auto things = makeThings(count, usecTimestampNow());
+        for (int numToSort : { 1, 20, count / 2, count - 1 }) {
+            PrioritySortUtil::PriorityQueue<SortableThing> queue(views);
+            for (const auto& thing : things) {
+                queue.push(thing);
+            }
+
+            const auto& sorted = queue.getSortedVector(numToSort);
+            QCOMPARE((int)sorted.size(), count);
+            std::vector<float> priorities;
+            for (const auto& thing : sorted) {
+                priorities.push_back(thing.getPriority());
+            }
+            std::sort(priorities.begin(), priorities.end(), std::greater<float>());
+            for (int i = 0; i < numToSort; ++i) {
+                QCOMPARE(sorted[i].getPriority(), priorities[i]);
+            }
+        }
+    }
+}
+
+void PrioritySortUtilTests::testPushAfterSort() {
+    auto views = makeViews();
+    PrioritySortUtil::PriorityQueue<SortableThing> queue(views);
+    auto things = makeThings(600, usecTimestampNow());
+    for (int i = 0; i < 300; ++i) {
+        queue.push(things[i]);
+    }
+    queue.getSortedVector(10);
+
+    for (int i = 300; i < 600; ++i) {
+        queue.push(things[i]);
+    }
+    const auto& sorted = queue.getSortedVector();
+    QCOMPARE((int)sorted.size(), 600);
+    for (int i = 1; i < 600; ++i) {
+        QVERIFY(sorted[i - 1].getPriority() >= sorted[i].getPriority());
+    }
+}
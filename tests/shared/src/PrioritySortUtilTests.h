@@ -0,0 +1,27 @@
+//
+//  PrioritySortUtilTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PrioritySortUtilTests_h
+#define hifi_PrioritySortUtilTests_h
+
+#include <QtTest/QtTest>
+
+class PrioritySortUtilTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testPriorities();
+    void testSortedVector();
+    void testTopK();
+    void testPushAfterSort();
+};
+
+#endif // hifi_PrioritySortUtilTests_h
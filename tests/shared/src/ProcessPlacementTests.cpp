@@ -0,0 +1,48 @@
+//
+//  ProcessPlacementTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ProcessPlacementTests.h"
+
+#include <ProcessPlacement.h>
+
+QTEST_MAIN(ProcessPlacementTests)
+
+void ProcessPlacementTests::testParseCpuList() {
+    QCOMPARE(ProcessPlacement::parseCpuList("0-3"), std::vector<int>({ 0, 1, 2, 3 }));
+    QCOMPARE(ProcessPlacement::parseCpuList("8, 2-3,2"), std::vector<int>({ 2, 3, 8 }));
+    QCOMPARE(ProcessPlacement::parseCpuList("5\n"), std::vector<int>({ 5 }));
+
+    QVERIFY(ProcessPlacement::parseCpuList("").empty());
+    QVERIFY(ProcessPlacement::parseCpuList("3-1").empty());
+    QVERIFY(ProcessPlacement::parseCpuList("1-2-3").empty());
+    QVERIFY(ProcessPlacement::parseCpuList("a").empty());
+    QVERIFY(ProcessPlacement::parseCpuList("0,-1").empty());
+    QVERIFY(ProcessPlacement::parseCpuList("0-100000").empty());
+}
+
+void ProcessPlacementTests::testFormatCpuList() {
+    QCOMPARE(ProcessPlacement::formatCpuList({ 0, 1, 2, 3 }), QString("0-3"));
+    QCOMPARE(ProcessPlacement::formatCpuList({ 9, 2, 3, 5, 8, 3 }), QString("2-3,5,8-9"));
+    QCOMPARE(ProcessPlacement::formatCpuList({}), QString());
+
+    auto cpus = ProcessPlacement::parseCpuList("0-7,16-23,31");
+    QCOMPARE(ProcessPlacement::parseCpuList(ProcessPlacement::formatCpuList(cpus)), cpus);
+}
+
+void ProcessPlacementTests::testUsableCpus() {
+    // whatever the host, we're running somewhere
+    auto cpus = ProcessPlacement::getUsableCpus();
+    QVERIFY(!cpus.empty());
+    QCOMPARE(ProcessPlacement::getNumUsableCpus(), (int)cpus.size());
+
+    auto placement = ProcessPlacement::getEffectivePlacement();
+    QCOMPARE(placement["num_cpus"].toInt(), (int)cpus.size());
+}
@@ -0,0 +1,67 @@
+//
+//  ScriptCPUAccountTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ScriptCPUAccountTests.h"
+
+#include <NumericalConstants.h>
+#include <ScriptCPUAccount.h>
+
+QTEST_MAIN(ScriptCPUAccountTests)
+
+static const uint64_t START = 1000 * USECS_PER_SECOND;
+
+void ScriptCPUAccountTests::testWindow() {
+    ScriptCPUAccount account;
+    for (int i = 0; i < ScriptCPUAccount::WINDOW_SECONDS; ++i) {
+        account.add(START + i * USECS_PER_SECOND, 1000);
+    }
+    auto last = START + (ScriptCPUAccount::WINDOW_SECONDS - 1) * USECS_PER_SECOND;
+    QCOMPARE(account.getWindowUsecs(last), (uint64_t)(ScriptCPUAccount::WINDOW_SECONDS * 1000));
+
+    // each second that passes drops the oldest second's running
+    QCOMPARE(account.getWindowUsecs(last + USECS_PER_SECOND), (uint64_t)((ScriptCPUAccount::WINDOW_SECONDS - 1) * 1000));
+    account.add(last + 2 * USECS_PER_SECOND, 5000);
+    QCOMPARE(account.getWindowUsecs(last + 2 * USECS_PER_SECOND), (uint64_t)((ScriptCPUAccount::WINDOW_SECONDS - 2) * 1000 + 5000));
+
+    QCOMPARE(account.getTotalUsecs(), (uint64_t)(ScriptCPUAccount::WINDOW_SECONDS * 1000 + 5000));
+    QCOMPARE(account.getLongestUsecs(), (uint64_t)5000);
+}
+
+void ScriptCPUAccountTests::testLoad() {
+    ScriptCPUAccount account;
+    QCOMPARE(account.getLoad(START), 0.0f);
+
+    // half of every second for the whole window
+    for (int i = 0; i < ScriptCPUAccount::WINDOW_SECONDS; ++i) {
+        account.add(START + i * USECS_PER_SECOND, USECS_PER_SECOND / 2);
+    }
+    auto last = START + (ScriptCPUAccount::WINDOW_SECONDS - 1) * USECS_PER_SECOND;
+    QCOMPARE(account.getLoad(last), 0.5f);
+
+    // one long burst is spread over the window
+    ScriptCPUAccount burst;
+    burst.add(START, USECS_PER_SECOND);
+    QCOMPARE(burst.getLoad(START), 1.0f / ScriptCPUAccount::WINDOW_SECONDS);
+}
+
+void ScriptCPUAccountTests::testIdleGap() {
+    ScriptCPUAccount account;
+    account.add(START, 1000);
+    account.add(START + USECS_PER_SECOND, 2000);
+
+    // nothing is left once a whole window goes by without running
+    auto later = START + (ScriptCPUAccount::WINDOW_SECONDS + 1) * USECS_PER_SECOND;
+    QCOMPARE(account.getWindowUsecs(later), (uint64_t)0);
+
+    account.add(later, 3000);
+    QCOMPARE(account.getWindowUsecs(later), (uint64_t)3000);
+    QCOMPARE(account.getTotalUsecs(), (uint64_t)6000);
+}
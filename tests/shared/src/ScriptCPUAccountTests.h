@@ -0,0 +1,26 @@
+//
+//  ScriptCPUAccountTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ScriptCPUAccountTests_h
+#define hifi_ScriptCPUAccountTests_h
+
+#include <QtTest/QtTest>
+
+class ScriptCPUAccountTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testWindow();
+    void testLoad();
+    void testIdleGap();
+};
+
+#endif // hifi_ScriptCPUAccountTests_h
@@ -0,0 +1,113 @@
+//
+//  SettingManagerTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SettingManagerTests.h"
+
+#include <PerformanceCounters.h>
+#include <SettingHelpers.h>
+#include <SettingManager.h>
+
+QTEST_MAIN(SettingManagerTests)
+
+static uint64_t settingWrites() {
+    return PerformanceCounters::getInstance().counter("setting_writes", QString()).get();
+}
+
+void SettingManagerTests::initTestCase() {
+    QStandardPaths::setTestModeEnabled(true);
+    QCoreApplication::setOrganizationName("SettingManagerTests");
+    QCoreApplication::setApplicationName("SettingManagerTests");
+    QSettings::setDefaultFormat(JSON_FORMAT);
+    QFile::remove(QSettings().fileName());
+
+    DependencyManager::set<Setting::Manager>();
+}
+
+void SettingManagerTests::testGroupsAndArrays() {
+    auto manager = DependencyManager::get<Setting::Manager>();
+    manager->beginGroup("a");
+    manager->setValue("x", 1);
+    manager->beginGroup("b");
+    manager->setValue("y", 2);
+    manager->endGroup();
+    manager->endGroup();
+
+    manager->beginWriteArray("list");
+    for (int i = 0; i < 3; ++i) {
+        manager->setArrayIndex(i);
+        manager->setValue("v", i * 10);
+    }
+    manager->endArray();
+
+    QCOMPARE(manager->value("a/x").toInt(), 1);
+    QCOMPARE(manager->value("/a//b/y").toInt(), 2);
+    QCOMPARE(manager->value("list/size").toInt(), 3);
+    QCOMPARE(manager->value("list/2/v").toInt(), 10);
+
+    QCOMPARE(manager->beginReadArray("list"), 3);
+    manager->setArrayIndex(2);
+    QCOMPARE(manager->value("v").toInt(), 20);
+    manager->endArray();
+
+    QCOMPARE(manager->childGroups(), QStringList({ "a", "list" }));
+    manager->beginGroup("a");
+    QCOMPARE(manager->childKeys(), QStringList({ "x" }));
+    QCOMPARE(manager->childGroups(), QStringList({ "b" }));
+    QCOMPARE(manager->allKeys(), QStringList({ "b/y", "x" }));
+    manager->endGroup();
+
+    // removing a group removes everything in it
+    manager->remove("a");
+    QVERIFY(!manager->contains("a/x"));
+    QVERIFY(!manager->contains("a/b/y"));
+    QVERIFY(manager->contains("list/size"));
+}
+
+void SettingManagerTests::testWritesCoalesced() {
+    auto manager = DependencyManager::get<Setting::Manager>();
+    uint64_t writes = settingWrites();
+    for (int i = 0; i < 100; ++i) {
+        manager->setValue("counter", i);
+    }
+    // nothing goes to the disk until the changes are written
+    QCOMPARE(settingWrites(), writes);
+
+    manager->reload();
+    QCOMPARE(settingWrites(), writes + 1);
+    QCOMPARE(manager->value("counter").toInt(), 99);
+
+    QSettings file(manager->fileName(), JSON_FORMAT);
+    QCOMPARE(file.value("counter").toInt(), 99);
+
+    // nothing changed, nothing to write
+    manager->reload();
+    QCOMPARE(settingWrites(), writes + 1);
+}
+
+void SettingManagerTests::testRemoveWritten() {
+    auto manager = DependencyManager::get<Setting::Manager>();
+    manager->setValue("gone/a", 1);
+    manager->setValue("gone/b/c", 2);
+    manager->reload();
+    QVERIFY(QSettings(manager->fileName(), JSON_FORMAT).contains("gone/b/c"));
+
+    manager->remove("gone");
+    manager->reload();
+    QSettings file(manager->fileName(), JSON_FORMAT);
+    QVERIFY(!file.contains("gone/a"));
+    QVERIFY(!file.contains("gone/b/c"));
+    QVERIFY(!manager->contains("gone/a"));
+}
+
+void SettingManagerTests::cleanupTestCase() {
+    QFile::remove(DependencyManager::get<Setting::Manager>()->fileName());
+    DependencyManager::destroy<Setting::Manager>();
+}
@@ -0,0 +1,28 @@
+//
+//  SettingManagerTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SettingManagerTests_h
+#define hifi_SettingManagerTests_h
+
+#include <QtTest/QtTest>
+
+class SettingManagerTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void testGroupsAndArrays();
+    void testWritesCoalesced();
+    void testRemoveWritten();
+    void cleanupTestCase();
+};
+
+#endif // hifi_SettingManagerTests_h
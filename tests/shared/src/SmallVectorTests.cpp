@@ -0,0 +1,155 @@
+//
+//  SmallVectorTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SmallVectorTests.h"
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <FixedSizePool.h>
+#include <SmallVector.h>
+
+QTEST_MAIN(SmallVectorTests)
+
+using PointerVector = SmallVector<std::shared_ptr<int>, 2>;
+
+void SmallVectorTests::testInline() {
+    PointerVector values;
+    QVERIFY(values.empty());
+    QVERIFY(values.isInline());
+
+    values.push_back(std::make_shared<int>(1));
+    values.push_back(std::make_shared<int>(2));
+    QCOMPARE(values.size(), (size_t)2);
+    QVERIFY(values.isInline());
+    QCOMPARE(*values[0], 1);
+    QCOMPARE(*values[1], 2);
+
+    // the inline values share their space with the heap pointer
+    QCOMPARE(sizeof(SmallVector<std::shared_ptr<int>, 1>), sizeof(std::shared_ptr<int>) + 2 * sizeof(uint32_t));
+}
+
+void SmallVectorTests::testGrowth() {
+    PointerVector values;
+    for (int i = 0; i < 100; ++i) {
+        values.push_back(std::make_shared<int>(i));
+    }
+    QVERIFY(!values.isInline());
+    QCOMPARE(values.size(), (size_t)100);
+    int expected = 0;
+    for (const auto& value : values) {
+        QCOMPARE(*value, expected++);
+    }
+
+    // pushing an element of the vector itself while it grows
+    PointerVector full;
+    full.push_back(std::make_shared<int>(7));
+    full.push_back(std::make_shared<int>(8));
+    full.push_back(full[0]);
+    QCOMPARE(*full[2], 7);
+
+    auto shared = std::make_shared<int>(3);
+    {
+        PointerVector owners;
+        for (int i = 0; i < 10; ++i) {
+            owners.push_back(shared);
+        }
+        QCOMPARE(shared.use_count(), (long)11);
+        owners.pop_back();
+        QCOMPARE(shared.use_count(), (long)10);
+    }
+    QCOMPARE(shared.use_count(), (long)1);
+}
+
+void SmallVectorTests::testCopyAndMove() {
+    PointerVector small;
+    small.push_back(std::make_shared<int>(1));
+    PointerVector big;
+    for (int i = 0; i < 10; ++i) {
+        big.push_back(std::make_shared<int>(i));
+    }
+
+    PointerVector smallCopy = small;
+    PointerVector bigCopy = big;
+    QCOMPARE(smallCopy.size(), (size_t)1);
+    QCOMPARE(bigCopy.size(), (size_t)10);
+    QCOMPARE(smallCopy[0], small[0]);
+    QCOMPARE(bigCopy[9], big[9]);
+
+    PointerVector moved = std::move(bigCopy);
+    QCOMPARE(moved.size(), (size_t)10);
+    QVERIFY(bigCopy.empty());
+    QVERIFY(bigCopy.isInline());
+
+    moved = std::move(smallCopy);
+    QCOMPARE(moved.size(), (size_t)1);
+    QVERIFY(moved.isInline());
+    QCOMPARE(moved[0], small[0]);
+
+    moved = big;
+    QCOMPARE(moved.size(), (size_t)10);
+}
+
+void SmallVectorTests::testRemoveAll() {
+    auto one = std::make_shared<int>(1);
+    auto two = std::make_shared<int>(2);
+    PointerVector values;
+    values.push_back(one);
+    values.push_back(two);
+    values.push_back(one);
+    values.push_back(two);
+
+    QCOMPARE(values.removeAll(one), (size_t)2);
+    QCOMPARE(values.size(), (size_t)2);
+    QCOMPARE(values[0], two);
+    QCOMPARE(values[1], two);
+    QCOMPARE(one.use_count(), (long)1);
+    QCOMPARE(values.removeAll(one), (size_t)0);
+}
+
+void SmallVectorTests::testPool() {
+    struct alignas(32) Item {
+        int values[10];
+    };
+    FixedSizePool& pool = PoolAllocator<Item>::getPool();
+    size_t slotsInUse = pool.getNumSlotsInUse();
+
+    PoolAllocator<Item> allocator;
+    std::vector<Item*> items;
+    for (int i = 0; i < 1000; ++i) {
+        items.push_back(allocator.allocate(1));
+        QCOMPARE((uintptr_t)items.back() % alignof(Item), (uintptr_t)0);
+    }
+    QCOMPARE(pool.getNumSlotsInUse(), slotsInUse + 1000);
+    size_t capacity = pool.getCapacityBytes();
+
+    // released on another thread, and the slots are used again rather than the pool growing
+    std::thread releaser([&] {
+        for (auto item : items) {
+            allocator.deallocate(item, 1);
+        }
+    });
+    releaser.join();
+    items.clear();
+    for (int i = 0; i < 1000; ++i) {
+        items.push_back(allocator.allocate(1));
+    }
+    QCOMPARE(pool.getCapacityBytes(), capacity);
+    for (auto item : items) {
+        allocator.deallocate(item, 1);
+    }
+    QCOMPARE(pool.getNumSlotsInUse(), slotsInUse);
+
+    // shared pointers take their control blocks with the object in them from a pool of that size
+    auto shared = std::allocate_shared<Item>(allocator);
+    QCOMPARE((uintptr_t)shared.get() % alignof(Item), (uintptr_t)0);
+}
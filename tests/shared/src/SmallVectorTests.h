@@ -0,0 +1,28 @@
+//
+//  SmallVectorTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SmallVectorTests_h
+#define hifi_SmallVectorTests_h
+
+#include <QtTest/QtTest>
+
+class SmallVectorTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testInline();
+    void testGrowth();
+    void testCopyAndMove();
+    void testRemoveAll();
+    void testPool();
+};
+
+#endif // hifi_SmallVectorTests_h
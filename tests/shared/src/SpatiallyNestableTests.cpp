@@ -0,0 +1,162 @@
+//
+//  SpatiallyNestableTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SpatiallyNestableTests.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <glm/gtx/quaternion.hpp>
+
+#include <SpatiallyNestable.h>
+
+QTEST_MAIN(SpatiallyNestableTests)
+
+namespace {
+
+const float TOLERANCE = 1.0e-5f;
+
+class TestParentFinder : public SpatialParentFinder {
+public:
+    SpatiallyNestableWeakPointer find(QUuid parentID, bool& success, SpatialParentTree* entityTree = nullptr) const override {
+        auto itr = _nestables.find(parentID);
+        success = itr != _nestables.end();
+        return success ? itr->second : SpatiallyNestableWeakPointer();
+    }
+
+    SpatiallyNestablePointer add() {
+        return add(std::make_shared<SpatiallyNestable>(NestableType::Entity, QUuid::createUuid()));
+    }
+
+    template <typename T>
+    std::shared_ptr<T> add(const std::shared_ptr<T>& nestable) {
+        _nestables[nestable->getID()] = nestable;
+        return nestable;
+    }
+
+private:
+    std::map<QUuid, SpatiallyNestableWeakPointer> _nestables;
+};
+
+// a nestable whose joint moves without telling its children, like an avatar's or a model's
+class JointedNestable : public SpatiallyNestable {
+public:
+    JointedNestable() : SpatiallyNestable(NestableType::Entity, QUuid::createUuid()) {}
+    glm::vec3 getAbsoluteJointTranslationInObjectFrame(int index) const override { return jointTranslation; }
+    glm::vec3 jointTranslation;
+};
+
+TestParentFinder& getFinder() {
+    return *DependencyManager::get<TestParentFinder>();
+}
+
+bool closeTo(const glm::vec3& a, const glm::vec3& b) {
+    return glm::length(a - b) < TOLERANCE;
+}
+
+}
+
+void SpatiallyNestableTests::initTestCase() {
+    DependencyManager::registerInheritance<SpatialParentFinder, TestParentFinder>();
+    DependencyManager::set<TestParentFinder>();
+}
+
+void SpatiallyNestableTests::cleanupTestCase() {
+    DependencyManager::destroy<TestParentFinder>();
+}
+
+void SpatiallyNestableTests::testWorldTransformFollowsAncestors() {
+    auto grandparent = getFinder().add();
+    auto parent = getFinder().add();
+    auto child = getFinder().add();
+    parent->setParentID(grandparent->getID());
+    child->setParentID(parent->getID());
+    parent->setLocalPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    child->setLocalPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+
+    QVERIFY(closeTo(child->getWorldPosition(), glm::vec3(1.0f, 1.0f, 0.0f)));
+    // read again, from the cache
+    QVERIFY(closeTo(child->getWorldPosition(), glm::vec3(1.0f, 1.0f, 0.0f)));
+
+    grandparent->setWorldPosition(glm::vec3(0.0f, 0.0f, 10.0f));
+    QVERIFY(closeTo(child->getWorldPosition(), glm::vec3(1.0f, 1.0f, 10.0f)));
+
+    grandparent->setLocalOrientation(glm::angleAxis(PI / 2.0f, glm::vec3(0.0f, 0.0f, 1.0f)));
+    QVERIFY(closeTo(child->getWorldPosition(), glm::vec3(-1.0f, 1.0f, 10.0f)));
+
+    Transform transform;
+    transform.setTranslation(glm::vec3(5.0f, 0.0f, 0.0f));
+    parent->setLocalTransformAndVelocities(transform, glm::vec3(0.0f), glm::vec3(0.0f));
+    QVERIFY(closeTo(child->getWorldPosition(), glm::vec3(-1.0f, 5.0f, 10.0f)));
+    QVERIFY(closeTo(child->getLocalPosition(), glm::vec3(0.0f, 1.0f, 0.0f)));
+}
+
+void SpatiallyNestableTests::testWorldTransformAfterReparenting() {
+    auto first = getFinder().add();
+    auto second = getFinder().add();
+    auto child = getFinder().add();
+    first->setWorldPosition(glm::vec3(1.0f, 0.0f, 0.0f));
+    second->setWorldPosition(glm::vec3(2.0f, 0.0f, 0.0f));
+    child->setLocalPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+
+    child->setParentID(first->getID());
+    QVERIFY(closeTo(child->getWorldPosition(), glm::vec3(1.0f, 1.0f, 0.0f)));
+    child->setParentID(second->getID());
+    QVERIFY(closeTo(child->getWorldPosition(), glm::vec3(2.0f, 1.0f, 0.0f)));
+    child->setParentID(QUuid());
+    QVERIFY(closeTo(child->getWorldPosition(), glm::vec3(0.0f, 1.0f, 0.0f)));
+}
+
+void SpatiallyNestableTests::testJointChildrenArentCached() {
+    auto parent = getFinder().add(std::make_shared<JointedNestable>());
+    auto child = getFinder().add();
+    child->setParentID(parent->getID());
+    child->setParentJointIndex(0);
+    child->setLocalPosition(glm::vec3(0.0f, 1.0f, 0.0f));
+    QVERIFY(closeTo(child->getWorldPosition(), glm::vec3(0.0f, 1.0f, 0.0f)));
+
+    // the joint moves without the child being told
+    parent->jointTranslation = glm::vec3(2.0f, 0.0f, 0.0f);
+    QVERIFY(closeTo(child->getWorldPosition(), glm::vec3(2.0f, 1.0f, 0.0f)));
+}
+
+void SpatiallyNestableTests::testConcurrentReads() {
+    auto nestable = getFinder().add();
+    nestable->setLocalPosition(glm::vec3(0.0f));
+    std::atomic<bool> done { false };
+    std::atomic<int> numTornReads { 0 };
+
+    // the writer only ever writes positions with equal components, so a torn read would show unequal ones
+    std::vector<std::thread> readers;
+    const int NUM_READERS = 4;
+    for (int i = 0; i < NUM_READERS; i++) {
+        readers.emplace_back([&] {
+            while (!done) {
+                glm::vec3 position = nestable->getWorldPosition();
+                if (position.x != position.y || position.y != position.z) {
+                    numTornReads++;
+                }
+            }
+        });
+    }
+    const int NUM_WRITES = 100000;
+    for (int i = 0; i < NUM_WRITES; i++) {
+        nestable->setLocalPosition(glm::vec3((float)i));
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    QCOMPARE(numTornReads.load(), 0);
+    QCOMPARE(nestable->getWorldPosition(), glm::vec3((float)(NUM_WRITES - 1)));
+}
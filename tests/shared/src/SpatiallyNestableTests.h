@@ -0,0 +1,30 @@
+//
+//  SpatiallyNestableTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SpatiallyNestableTests_h
+#define hifi_SpatiallyNestableTests_h
+
+#include <QtTest/QtTest>
+
+class SpatiallyNestableTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void testWorldTransformFollowsAncestors();
+    void testWorldTransformAfterReparenting();
+    void testJointChildrenArentCached();
+    void testConcurrentReads();
+};
+
+#endif // hifi_SpatiallyNestableTests_h
@@ -0,0 +1,84 @@
+//
+//  StartupTaskTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "StartupTaskTests.h"
+
+#include <atomic>
+#include <thread>
+
+#include <QtCore/QThreadPool>
+
+#include <shared/StartupTask.h>
+
+QTEST_GUILESS_MAIN(StartupTaskTests)
+
+void StartupTaskTests::testDependencyOrder() {
+    for (int i = 0; i < 100; ++i) {
+        std::atomic<int> order { 0 };
+        int first = -1;
+        int second = -1;
+        int third = -1;
+        auto firstTask = StartupTask::start("first", [&] { first = order++; });
+        auto secondTask = StartupTask::start("second", [&] { second = order++; }, { firstTask });
+        auto thirdTask = StartupTask::start("third", [&] { third = order++; }, { firstTask, secondTask });
+
+        thirdTask->wait();
+        QVERIFY(firstTask->isFinished());
+        QVERIFY(secondTask->isFinished());
+        QVERIFY(thirdTask->isFinished());
+        QCOMPARE(first, 0);
+        QCOMPARE(second, 1);
+        QCOMPARE(third, 2);
+    }
+}
+
+void StartupTaskTests::testWaitRunsInline() {
+    // with every pool thread busy, waiting for a task runs it on the waiting thread
+    QThreadPool* pool = QThreadPool::globalInstance();
+    std::atomic<bool> release { false };
+    std::atomic<int> numBlocking { 0 };
+    std::vector<StartupTask::Pointer> blockers;
+    for (int i = 0; i < pool->maxThreadCount(); ++i) {
+        blockers.push_back(StartupTask::start("blocker", [&] {
+            ++numBlocking;
+            while (!release) {
+                std::this_thread::yield();
+            }
+        }));
+    }
+    QTRY_COMPARE(numBlocking.load(), pool->maxThreadCount());
+
+    std::thread::id ranOn;
+    auto task = StartupTask::start("inline", [&] { ranOn = std::this_thread::get_id(); });
+    task->wait();
+    QVERIFY(ranOn == std::this_thread::get_id());
+
+    release = true;
+    for (auto& blocker : blockers) {
+        blocker->wait();
+    }
+}
+
+void StartupTaskTests::testUnheldDependent() {
+    // a task only its dependency knows about still runs
+    std::atomic<bool> ran { false };
+    std::atomic<bool> release { false };
+    auto dependency = StartupTask::start("dependency", [&] {
+        while (!release) {
+            std::this_thread::yield();
+        }
+    });
+    StartupTask::start("dependent", [&] { ran = true; }, { dependency });
+
+    release = true;
+    dependency->wait();
+    QTRY_VERIFY(ran);
+}
@@ -0,0 +1,26 @@
+//
+//  StartupTaskTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_StartupTaskTests_h
+#define hifi_StartupTaskTests_h
+
+#include <QtTest/QtTest>
+
+class StartupTaskTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testDependencyOrder();
+    void testWaitRunsInline();
+    void testUnheldDependent();
+};
+
+#endif // hifi_StartupTaskTests_h
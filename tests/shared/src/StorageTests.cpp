@@ -75,3 +75,28 @@ void StorageTests::testConversion() {
         QCOMPARE(fileInfo.size(), (qint64)newSize);
     }
 }
+
+void StorageTests::testMappedView() {
+    auto fileStorage = std::static_pointer_cast<const FileStorage>(FileStorage::create(_testFile, _testData.size(), _testData.data()));
+    QVERIFY(fileStorage->isMapped());
+
+    // Views past the end of the file aren't created
+    QVERIFY(!fileStorage->createMappedView(_testData.size(), 1));
+
+    const size_t offset = 100;
+    const size_t viewSize = _testData.size() - 2 * offset;
+    {
+        auto view = fileStorage->createMappedView(viewSize, offset);
+        QVERIFY(view);
+        QCOMPARE(view->size(), viewSize);
+        QCOMPARE(memcmp(_testData.data() + offset, view->data(), viewSize), 0);
+    }
+
+    // Releasing the view only drops its pages from the process, the file still reads the same
+    QCOMPARE(memcmp(_testData.data(), fileStorage->data(), _testData.size()), 0);
+
+    // The view keeps the file mapped
+    auto view = fileStorage->createMappedView(viewSize, offset);
+    fileStorage.reset();
+    QCOMPARE(memcmp(_testData.data() + offset, view->data(), viewSize), 0);
+}
@@ -23,6 +23,7 @@ public:
 
 private slots:
     void testConversion();
+    void testMappedView();
 
 private:
     std::array<uint8_t, 1025> _testData;
@@ -0,0 +1,148 @@
+//
+//  TimerWheelTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TimerWheelTests.h"
+
+#include <algorithm>
+#include <map>
+#include <random>
+
+#include <TimerWheel.h>
+
+QTEST_MAIN(TimerWheelTests)
+
+using TimerIDs = std::vector<TimerWheel::TimerID>;
+
+void TimerWheelTests::testExpiryOrder() {
+    TimerWheel wheel(1000);
+    // spread over the first three levels
+    wheel.schedule(1, 5000);
+    wheel.schedule(2, 1010);
+    wheel.schedule(3, 1100);
+    wheel.schedule(4, 1010);
+    QCOMPARE((int)wheel.size(), 4);
+
+    TimerIDs expired;
+    wheel.advance(1009, expired);
+    QVERIFY(expired.empty());
+
+    wheel.advance(1010, expired);
+    QCOMPARE((int)expired.size(), 2);
+    QVERIFY(std::find(expired.begin(), expired.end(), 2) != expired.end());
+    QVERIFY(std::find(expired.begin(), expired.end(), 4) != expired.end());
+
+    expired.clear();
+    wheel.advance(10000, expired);
+    QCOMPARE(expired, TimerIDs({ 3, 1 }));
+    QVERIFY(wheel.isEmpty());
+    QCOMPARE(wheel.getCurrentTick(), (uint64_t)10000);
+}
+
+void TimerWheelTests::testCancelAndReschedule() {
+    TimerWheel wheel;
+    wheel.schedule(1, 100);
+    wheel.schedule(2, 200);
+    wheel.cancel(1);
+    // moving a timer leaves it only at its new time
+    wheel.schedule(2, 50);
+    QCOMPARE((int)wheel.size(), 1);
+
+    TimerIDs expired;
+    wheel.advance(300, expired);
+    QCOMPARE(expired, TimerIDs({ 2 }));
+}
+
+void TimerWheelTests::testPastExpiry() {
+    TimerWheel wheel(500);
+    wheel.schedule(1, 100);
+
+    TimerIDs expired;
+    wheel.advance(500, expired);
+    QVERIFY(expired.empty());
+    wheel.advance(501, expired);
+    QCOMPARE(expired, TimerIDs({ 1 }));
+}
+
+void TimerWheelTests::testFarFuture() {
+    // beyond the 2^24 ticks the wheel covers
+    const uint64_t FAR = (uint64_t)1 << 26;
+    TimerWheel wheel;
+    wheel.schedule(1, FAR);
+    wheel.schedule(2, 10);
+
+    TimerIDs expired;
+    wheel.advance(FAR - 1, expired);
+    QCOMPARE(expired, TimerIDs({ 2 }));
+
+    wheel.advance(FAR, expired);
+    QCOMPARE(expired, TimerIDs({ 2, 1 }));
+}
+
+void TimerWheelTests::testNextExpiry() {
+    TimerWheel wheel;
+    QCOMPARE(wheel.getNextExpiry(), TimerWheel::NO_EXPIRY);
+
+    wheel.schedule(1, 20);
+    QCOMPARE(wheel.getNextExpiry(), (uint64_t)20);
+
+    // a timer further out is only known to the first level's next turn
+    wheel.cancel(1);
+    wheel.schedule(2, 1000);
+    QVERIFY(wheel.getNextExpiry() <= 1000);
+    QVERIFY(wheel.getNextExpiry() > 0);
+}
+
+void TimerWheelTests::testRandomSchedule() {
+    std::mt19937_64 random(1);
+    TimerWheel wheel(12345);
+    std::map<TimerWheel::TimerID, uint64_t> expected;
+    uint64_t now = 12345;
+    TimerWheel::TimerID nextID = 1;
+
+    for (int step = 0; step < 20000; ++step) {
+        int operation = random() % 10;
+        if (operation < 4) {
+            uint64_t delay = (random() % 4 == 0) ? random() % 30000000 : random() % 300;
+            auto id = nextID++;
+            wheel.schedule(id, now + delay);
+            expected[id] = std::max(now + delay, now + 1);
+        } else if (operation < 5 && !expected.empty()) {
+            auto it = expected.begin();
+            std::advance(it, random() % expected.size());
+            wheel.cancel(it->first);
+            expected.erase(it);
+        } else {
+            uint64_t earliest = TimerWheel::NO_EXPIRY;
+            for (const auto& timer : expected) {
+                earliest = std::min(earliest, timer.second);
+            }
+            QVERIFY(wheel.getNextExpiry() <= earliest);
+
+            now += (random() % 50 == 0) ? random() % 5000000 : random() % 40;
+            TimerIDs expired;
+            wheel.advance(now, expired);
+
+            uint64_t lastExpiry = 0;
+            for (auto id : expired) {
+                auto it = expected.find(id);
+                QVERIFY(it != expected.end());
+                QVERIFY(it->second <= now);
+                QVERIFY(it->second >= lastExpiry);
+                lastExpiry = it->second;
+                expected.erase(it);
+            }
+            for (const auto& timer : expected) {
+                QVERIFY(timer.second > now);
+            }
+        }
+        QCOMPARE(wheel.size(), expected.size());
+    }
+}
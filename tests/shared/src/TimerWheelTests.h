@@ -0,0 +1,29 @@
+//
+//  TimerWheelTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TimerWheelTests_h
+#define hifi_TimerWheelTests_h
+
+#include <QtTest/QtTest>
+
+class TimerWheelTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testExpiryOrder();
+    void testCancelAndReschedule();
+    void testPastExpiry();
+    void testFarFuture();
+    void testNextExpiry();
+    void testRandomSchedule();
+};
+
+#endif // hifi_TimerWheelTests_h
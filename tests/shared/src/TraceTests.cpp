@@ -8,8 +8,14 @@
 
 #include "TraceTests.h"
 
+#include <thread>
+
 #include <QtTest/QtTest>
 #include <QtGui/QDesktopServices>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QThread>
 
 #include <Profile.h>
 
@@ -45,3 +51,111 @@ void TraceTests::testTraceSerialization() {
     qDebug() << "Done";
 }
 
+
+static QJsonArray readJsonTrace(const QString& fileName) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return QJsonArray();
+    }
+    return QJsonDocument::fromJson(file.readAll()).array();
+}
+
+static void recordRanges(int count) {
+    for (int i = 0; i < count; ++i) {
+        PROFILE_RANGE(test, "Outer");
+        PROFILE_RANGE(test, QString("Inner"));
+    }
+}
+
+void TraceTests::testThreadedRanges() {
+    const int NUM_THREADS = 4;
+    // fewer than a flush interval's worth of ring slots, so none are dropped
+    const int NUM_RANGES = 1000;
+
+    QTemporaryDir dir;
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startTracing();
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NUM_THREADS; ++i) {
+        threads.emplace_back([] { recordRanges(NUM_RANGES); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    // an event with arguments, which takes the slow path
+    PROFILE_COUNTER(test, "TestCounter", { { "value", 1 } });
+    tracer->stopTracing();
+
+    QString fileName = dir.filePath("trace.json");
+    tracer->serialize(fileName);
+    auto events = readJsonTrace(fileName);
+
+    QHash<QString, int> counts;
+    QSet<qint64> threadIDs;
+    for (const auto& value : events) {
+        auto event = value.toObject();
+        if (event["cat"].toString() != "trace.test") {
+            continue;
+        }
+        counts[event["name"].toString() + event["ph"].toString()]++;
+        if (event["ph"].toString() == "B") {
+            threadIDs.insert((qint64)event["tid"].toDouble());
+        }
+    }
+    QCOMPARE(counts["OuterB"], NUM_THREADS * NUM_RANGES);
+    QCOMPARE(counts["OuterE"], NUM_THREADS * NUM_RANGES);
+    QCOMPARE(counts["InnerB"], NUM_THREADS * NUM_RANGES);
+    QCOMPARE(counts["InnerE"], NUM_THREADS * NUM_RANGES);
+    QCOMPARE(counts["TestCounterC"], 1);
+    QCOMPARE(threadIDs.size(), NUM_THREADS);
+
+    // serializing again finds the trace emptied
+    tracer->serialize(fileName);
+    QCOMPARE(readJsonTrace(fileName).size(), 0);
+}
+
+void TraceTests::testBinaryTrace() {
+    QTemporaryDir dir;
+    QString binaryFile = dir.filePath("trace.hftrace");
+    QString jsonFile = dir.filePath("trace.json");
+
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startTracing(binaryFile);
+    recordRanges(100);
+    // a flush or two pass while tracing
+    QThread::msleep(tracing::Tracer::FLUSH_INTERVAL_MSECS * 2);
+    recordRanges(100);
+    tracer->stopTracing();
+
+    QVERIFY(tracing::Tracer::binaryTraceToJson(binaryFile, jsonFile));
+    auto events = readJsonTrace(jsonFile);
+    int numRanges = 0;
+    for (const auto& value : events) {
+        auto event = value.toObject();
+        if (event["name"].toString() == "Outer" && event["ph"].toString() == "B") {
+            QCOMPARE(event["cat"].toString(), QString("trace.test"));
+            QCOMPARE((qint64)event["pid"].toDouble(), QCoreApplication::applicationPid());
+            ++numRanges;
+        }
+    }
+    QCOMPARE(numRanges, 200);
+
+    // a file cut short, as one being written is, converts up to where it ends
+    QFile file(binaryFile);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    file.resize(file.size() - 5);
+    file.close();
+    QVERIFY(tracing::Tracer::binaryTraceToJson(binaryFile, jsonFile));
+    QVERIFY(readJsonTrace(jsonFile).size() > 0);
+
+    QVERIFY(!tracing::Tracer::binaryTraceToJson(jsonFile, dir.filePath("notATrace.json")));
+}
+
+void TraceTests::benchmarkRange() {
+    auto tracer = DependencyManager::set<tracing::Tracer>();
+    tracer->startTracing();
+    QBENCHMARK {
+        PROFILE_RANGE(test, "BenchmarkRange");
+    }
+    tracer->stopTracing();
+}
@@ -15,6 +15,9 @@ class TraceTests : public QObject {
     Q_OBJECT
 private slots:
     void testTraceSerialization();
+    void testThreadedRanges();
+    void testBinaryTrace();
+    void benchmarkRange();
 };
 
 #endif // hifi_TraceTests_h
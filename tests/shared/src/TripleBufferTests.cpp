@@ -0,0 +1,92 @@
+//
+//  TripleBufferTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TripleBufferTests.h"
+
+#include <array>
+#include <atomic>
+#include <thread>
+
+#include <TripleBuffer.h>
+
+QTEST_MAIN(TripleBufferTests)
+
+void TripleBufferTests::testLatestValue() {
+    TripleBuffer<int> buffer;
+    QVERIFY(!buffer.update());
+
+    buffer.write(1);
+    buffer.write(2);
+    buffer.write(3);
+    QVERIFY(buffer.update());
+    QCOMPARE(buffer.get(), 3);
+    QVERIFY(!buffer.update());
+    QCOMPARE(buffer.get(), 3);
+
+    buffer.getWriteBuffer() = 4;
+    buffer.publish();
+    QVERIFY(buffer.update());
+    QCOMPARE(buffer.get(), 4);
+}
+
+void TripleBufferTests::testConsumerKeepsValue() {
+    TripleBuffer<int> buffer;
+    buffer.write(1);
+    QVERIFY(buffer.update());
+
+    // the consumer's buffer is its own until it takes the next value, whatever the producer publishes meanwhile
+    buffer.get() = 10;
+    buffer.write(2);
+    buffer.write(3);
+    QCOMPARE(buffer.get(), 10);
+    QVERIFY(buffer.update());
+    QCOMPARE(buffer.get(), 3);
+}
+
+void TripleBufferTests::testThreads() {
+    // every element of a sample is the same, so a torn read would show as a mismatch
+    using Sample = std::array<uint32_t, 256>;
+    static const uint32_t NUM_SAMPLES = 100000;
+
+    TripleBuffer<Sample> buffer;
+    std::atomic<bool> done { false };
+    std::thread producer([&] {
+        for (uint32_t i = 1; i <= NUM_SAMPLES; ++i) {
+            buffer.getWriteBuffer().fill(i);
+            buffer.publish();
+        }
+        done = true;
+    });
+
+    uint32_t last = 0;
+    bool consistent = true;
+    bool ordered = true;
+    while (true) {
+        bool finished = done;
+        if (!buffer.update()) {
+            if (finished) {
+                break;
+            }
+            continue;
+        }
+        const Sample& sample = buffer.get();
+        for (auto value : sample) {
+            consistent = consistent && value == sample[0];
+        }
+        ordered = ordered && sample[0] > last;
+        last = sample[0];
+    }
+    producer.join();
+
+    QVERIFY(consistent);
+    QVERIFY(ordered);
+    QCOMPARE(last, NUM_SAMPLES);
+}
@@ -0,0 +1,103 @@
+//
+//  WorkStealingSchedulerTests.cpp
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "WorkStealingSchedulerTests.h"
+
+#include <atomic>
+#include <thread>
+
+#include <WorkStealingScheduler.h>
+
+QTEST_MAIN(WorkStealingSchedulerTests)
+
+void WorkStealingSchedulerTests::testCostWeightedPartition() {
+    WorkStealingScheduler scheduler;
+
+    // one expensive task up front should get a worker to itself
+    std::vector<float> costs { 10.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f };
+    scheduler.reset(2, costs.size(), costs);
+
+    WorkStealingScheduler::Index task;
+    QVERIFY(scheduler.pop(0, task));
+    QCOMPARE(task, (WorkStealingScheduler::Index)0);
+    QVERIFY(scheduler.pop(1, task));
+    QCOMPARE(task, (WorkStealingScheduler::Index)1);
+}
+
+void WorkStealingSchedulerTests::testStealing() {
+    WorkStealingScheduler scheduler;
+    const size_t NUM_TASKS = 100;
+    scheduler.reset(4, NUM_TASKS);
+
+    // a single worker drains everything, stealing from the others
+    std::vector<int> seen(NUM_TASKS, 0);
+    WorkStealingScheduler::Index task;
+    while (scheduler.pop(0, task)) {
+        QVERIFY(task < NUM_TASKS);
+        ++seen[task];
+    }
+
+    for (auto count : seen) {
+        QCOMPARE(count, 1);
+    }
+    QVERIFY(scheduler.getNumSteals() > 0);
+    QVERIFY(!scheduler.pop(1, task));
+}
+
+void WorkStealingSchedulerTests::testConcurrentPops() {
+    WorkStealingScheduler scheduler;
+    const int NUM_WORKERS = 8;
+    const size_t NUM_TASKS = 10000;
+
+    for (int frame = 0; frame < 10; ++frame) {
+        std::vector<float> costs(NUM_TASKS);
+        for (size_t i = 0; i < NUM_TASKS; ++i) {
+            costs[i] = (float)(i % 17 + 1);
+        }
+        scheduler.reset(NUM_WORKERS, NUM_TASKS, costs);
+
+        std::vector<std::atomic<int>> seen(NUM_TASKS);
+        for (auto& count : seen) {
+            count = 0;
+        }
+
+        std::vector<std::thread> threads;
+        for (int worker = 0; worker < NUM_WORKERS; ++worker) {
+            threads.emplace_back([&, worker] {
+                WorkStealingScheduler::Index task;
+                while (scheduler.pop(worker, task)) {
+                    ++seen[task];
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (auto& count : seen) {
+            QCOMPARE(count.load(), 1);
+        }
+    }
+}
+
+void WorkStealingSchedulerTests::testImbalance() {
+    WorkStealingScheduler scheduler;
+    scheduler.reset(2, 0);
+    QCOMPARE(scheduler.getImbalance(), 1.0f);
+
+    scheduler.recordBusyTime(0, 300);
+    scheduler.recordBusyTime(1, 100);
+    QCOMPARE(scheduler.getImbalance(), 1.5f);
+    QCOMPARE(scheduler.getTotalBusyTime(), (uint64_t)400);
+
+    scheduler.reset(2, 0);
+    QCOMPARE(scheduler.getTotalBusyTime(), (uint64_t)0);
+}
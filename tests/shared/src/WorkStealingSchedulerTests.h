@@ -0,0 +1,27 @@
+//
+//  WorkStealingSchedulerTests.h
+//  tests/shared/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_WorkStealingSchedulerTests_h
+#define hifi_WorkStealingSchedulerTests_h
+
+#include <QtTest/QtTest>
+
+class WorkStealingSchedulerTests : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testCostWeightedPartition();
+    void testStealing();
+    void testConcurrentPops();
+    void testImbalance();
+};
+
+#endif // hifi_WorkStealingSchedulerTests_h
@@ -17,6 +17,8 @@
 #include <StreamUtils.h>
 #include <SharedUtil.h>
 
+#include <glm/gtx/norm.hpp>
+
 
 const float INV_SQRT_3 = 1.0f / sqrtf(3.0f);
 
@@ -115,8 +117,6 @@ void SpaceTests::testOverlaps() {
 #endif
 }
 
-#ifdef MANUAL_TEST
-
 const float WORLD_WIDTH = 1000.0f;
 const float MIN_RADIUS = 1.0f;
 const float MAX_RADIUS = 100.0f;
@@ -130,117 +130,163 @@ glm::vec3 randomVec3() {
     return v;
 }
 
-void generateSpheres(uint32_t numProxies, std::vector<workload::Space::Sphere>& spheres) {
+void generateSpheres(uint32_t numProxies, std::vector<workload::Sphere>& spheres) {
     spheres.reserve(numProxies);
     for (uint32_t i = 0; i < numProxies; ++i) {
-        workload::Space::Sphere sphere(
-                WORLD_WIDTH * randomFloat(),
-                WORLD_WIDTH * randomFloat(),
-                WORLD_WIDTH * randomFloat(),
-                (MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS)) * randomFloat());
-        spheres.push_back(sphere);
+        float radius = MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * 0.5f * (randomFloat() + 1.0f);
+        spheres.push_back(workload::Sphere(WORLD_WIDTH * randomVec3(), radius));
     }
 }
 
-void generatePositions(uint32_t numProxies, std::vector<glm::vec3>& positions) {
-    positions.reserve(numProxies);
-    for (uint32_t i = 0; i < numProxies; ++i) {
-        positions.push_back(WORLD_WIDTH * randomVec3());
+workload::Views generateViews(const std::vector<glm::vec3>& positions) {
+    workload::Views views;
+    for (auto& position : positions) {
+        workload::View view;
+        view.origin = position;
+        view.regions[workload::Region::R1] = workload::Sphere(position, 0.1f * WORLD_WIDTH);
+        view.regions[workload::Region::R2] = workload::Sphere(position, 0.25f * WORLD_WIDTH);
+        view.regions[workload::Region::R3] = workload::Sphere(position, 0.5f * WORLD_WIDTH);
+        views.push_back(view);
+    }
+    return views;
+}
+
+std::vector<workload::ProxyID> addProxies(workload::Space& space, const std::vector<workload::Sphere>& spheres) {
+    std::vector<workload::ProxyID> ids;
+    ids.reserve(spheres.size());
+    workload::Transaction transaction;
+    for (auto& sphere : spheres) {
+        ids.push_back(space.allocateID());
+        transaction.reset(ids.back(), sphere, workload::Owner());
+    }
+    space.enqueueTransaction(std::move(transaction));
+    space.enqueueFrame();
+    space.processTransactionQueue();
+    return ids;
+}
+
+// the region of a sphere, found the plain way
+uint8_t expectedRegion(const workload::Sphere& sphere, const workload::Views& views) {
+    uint8_t region = workload::Region::R4;
+    for (auto& view : views) {
+        for (uint8_t k = 0; k < region; ++k) {
+            float touchDistance = sphere.w + view.regions[k].w;
+            if (glm::distance2(glm::vec3(sphere), glm::vec3(view.regions[k])) < touchDistance * touchDistance) {
+                region = k;
+                break;
+            }
+        }
     }
+    return region;
 }
 
-void generateRadiuses(uint32_t numRadiuses, std::vector<float>& radiuses) {
-    radiuses.reserve(numRadiuses);
-    for (uint32_t i = 0; i < numRadiuses; ++i) {
-        radiuses.push_back(MIN_RADIUS + (MAX_RADIUS - MIN_RADIUS) * randomFloat());
+void verifyChanges(const workload::Space& space, const workload::Changes& changes,
+                   const std::vector<workload::Sphere>& spheres, const std::vector<uint8_t>& prevRegions,
+                   const workload::Views& views) {
+    size_t numExpected = 0;
+    for (size_t i = 0; i < spheres.size(); ++i) {
+        uint8_t region = expectedRegion(spheres[i], views);
+        QCOMPARE(space.getRegion((int32_t)i), region);
+        if (region != prevRegions[i]) {
+            QVERIFY(numExpected < changes.size());
+            const auto& change = changes[numExpected++];
+            QCOMPARE(change.proxyId, (int32_t)i);
+            QCOMPARE(change.region, region);
+            QCOMPARE(change.prevRegion, prevRegions[i]);
+        }
     }
+    QCOMPARE(changes.size(), numExpected);
 }
 
+void SpaceTests::testCategorize() {
+    // enough proxies for categorizeAndGetChanges to split them between threads, and a count that isn't a whole
+    // number of its blocks
+    const uint32_t NUM_PROXIES = 50000 + 17;
+    srand(1);
+
+    workload::Space space;
+    std::vector<workload::Sphere> spheres;
+    generateSpheres(NUM_PROXIES, spheres);
+    addProxies(space, spheres);
+
+    auto views = generateViews({ glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 0.3f * WORLD_WIDTH) });
+    space.setViews(views);
+
+    // everything leaves UNKNOWN
+    workload::Changes changes;
+    space.categorizeAndGetChanges(changes);
+    std::vector<uint8_t> prevRegions(NUM_PROXIES, workload::Region::UNKNOWN);
+    verifyChanges(space, changes, spheres, prevRegions, views);
+
+    // nothing moved
+    changes.clear();
+    space.categorizeAndGetChanges(changes);
+    QVERIFY(changes.empty());
+
+    // the views move, and a few proxies with them
+    for (uint32_t i = 0; i < NUM_PROXIES; ++i) {
+        prevRegions[i] = space.getRegion((int32_t)i);
+    }
+    workload::Transaction transaction;
+    for (uint32_t i = 0; i < NUM_PROXIES; i += 7) {
+        spheres[i] = workload::Sphere(WORLD_WIDTH * randomVec3(), spheres[i].w);
+        transaction.update((workload::ProxyID)i, spheres[i]);
+    }
+    space.enqueueTransaction(std::move(transaction));
+    space.enqueueFrame();
+    space.processTransactionQueue();
+
+    views = generateViews({ glm::vec3(0.2f * WORLD_WIDTH, 0.0f, 0.0f), glm::vec3(0.0f, 0.1f * WORLD_WIDTH, 0.0f) });
+    space.setViews(views);
+    changes.clear();
+    space.categorizeAndGetChanges(changes);
+    verifyChanges(space, changes, spheres, prevRegions, views);
+}
+
+#ifdef MANUAL_TEST
+
 void SpaceTests::benchmark() {
-    uint32_t numProxies[] = { 100, 1000, 10000, 100000 };
-    uint32_t numTests = 4;
+    uint32_t numProxies[] = { 10000, 100000, 1000000 };
+    uint32_t numTests = 3;
     std::vector<uint64_t> timeToAddAll;
     std::vector<uint64_t> timeToMoveView;
     std::vector<uint64_t> timeToMoveProxies;
     std::vector<uint64_t> timeToRemoveAll;
     for (uint32_t i = 0; i < numTests; ++i) {
-
         workload::Space space;
-
-        { // build the views
-            std::vector<glm::vec3> viewPositions;
-            viewPositions.push_back(glm::vec3(0.0f, 0.0f, 0.0f));
-            viewPositions.push_back(glm::vec3(0.0f, 0.0f, 0.1f * WORLD_WIDTH));
-            float radius0 = 0.25f * WORLD_WIDTH;
-            float radius1 = 0.50f * WORLD_WIDTH;
-            float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
-            space.setViews(views);
-        }
+        space.setViews(generateViews({ glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, 0.1f * WORLD_WIDTH) }));
 
         // build the proxies
         uint32_t n = numProxies[i];
-        std::vector<workload::Space::Sphere> proxySpheres;
+        std::vector<workload::Sphere> proxySpheres;
         generateSpheres(n, proxySpheres);
-        std::vector<int32_t> proxyKeys;
-        proxyKeys.reserve(n);
 
         // measure time to put proxies in the space
         uint64_t startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < n; ++j) {
-            int32_t key = space.createProxy(proxySpheres[j]);
-            proxyKeys.push_back(key);
-        }
+        auto proxyKeys = addProxies(space, proxySpheres);
         uint64_t usec = usecTimestampNow() - startTime;
         timeToAddAll.push_back(usec);
 
-        {
-            // build the views
-            std::vector<glm::vec3> viewPositions;
-            viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f));
-            viewPositions.push_back(glm::vec3(1.0f, 2.0f, 3.0f + 0.1f * WORLD_WIDTH));
-            float radius0 = 0.25f * WORLD_WIDTH;
-            float radius1 = 0.50f * WORLD_WIDTH;
-            float radius2 = 0.75f * WORLD_WIDTH;
-            std::vector<workload::Space::View> views;
-            views.push_back(workload::Space::View(viewPositions[0], radius0, radius1, radius2));
-            views.push_back(workload::Space::View(viewPositions[1], radius0, radius1, radius2));
-            space.setViews(views);
-        }
-
-        // measure time to categorizeAndGetChanges everything
-        std::vector<workload::Space::Change> changes;
+        // measure time to categorizeAndGetChanges everything after the views move
+        space.setViews(generateViews({ glm::vec3(1.0f, 2.0f, 3.0f), glm::vec3(1.0f, 2.0f, 3.0f + 0.1f * WORLD_WIDTH) }));
+        workload::Changes changes;
         startTime = usecTimestampNow();
         space.categorizeAndGetChanges(changes);
         usec = usecTimestampNow() - startTime;
         timeToMoveView.push_back(usec);
 
-        // move every 10th proxy around
+        // move every 10th proxy around, and measure the update and categorizeAndGetChanges
         const float proxySpeed = 1.0f;
-        std::vector<workload::Space::Sphere> newSpheres;
-        uint32_t numMovingProxies = n / 10;
-        uint32_t jstep = n / numMovingProxies;
-        uint32_t maxJ = numMovingProxies * jstep - 1;
-        glm::vec3 direction;
-        for (uint32_t j = 0; j < maxJ - jstep; j += jstep) {
-            glm::vec3 position = (glm::vec3)proxySpheres[j];
-            glm::vec3 destination = (glm::vec3)proxySpheres[j + jstep];
-            direction = glm::normalize(destination - position);
-            glm::vec3 newPosition = position + proxySpeed * direction;
-            newSpheres.push_back(workload::Space::Sphere(newPosition, proxySpheres[j].w));
+        workload::Transaction transaction;
+        for (uint32_t j = 0; j + 10 < n; j += 10) {
+            glm::vec3 position = glm::vec3(proxySpheres[j]);
+            glm::vec3 direction = glm::normalize(glm::vec3(proxySpheres[j + 10]) - position);
+            transaction.update(proxyKeys[j], workload::Sphere(position + proxySpeed * direction, proxySpheres[j].w));
         }
-        glm::vec3 position = (glm::vec3)proxySpheres[maxJ = jstep];
-        glm::vec3 destination = (glm::vec3)proxySpheres[0];
-        direction = glm::normalize(destination - position);
-        direction = position + proxySpeed * direction;
-        newSpheres.push_back(workload::Space::Sphere(direction, proxySpheres[0].w));
-        uint32_t k = 0;
         startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < maxJ; j += jstep) {
-            space.updateProxy(proxyKeys[j], newSpheres[k++]);
-        }
+        space.enqueueTransaction(std::move(transaction));
+        space.enqueueFrame();
+        space.processTransactionQueue();
         changes.clear();
         space.categorizeAndGetChanges(changes);
         usec = usecTimestampNow() - startTime;
@@ -248,9 +294,11 @@ void SpaceTests::benchmark() {
 
         // measure time to remove proxies from space
         startTime = usecTimestampNow();
-        for (uint32_t j = 0; j < n; ++j) {
-            space.deleteProxy(proxyKeys[j]);
-        }
+        workload::Transaction removals;
+        removals.remove(proxyKeys);
+        space.enqueueTransaction(std::move(removals));
+        space.enqueueFrame();
+        space.processTransactionQueue();
         usec = usecTimestampNow() - startTime;
         timeToRemoveAll.push_back(usec);
     }
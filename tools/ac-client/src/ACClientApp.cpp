@@ -11,10 +11,14 @@
 
 #include "ACClientApp.h"
 
+#include <algorithm>
+#include <cstdio>
+
 #include <QDataStream>
 #include <QThread>
 #include <QLoggingCategory>
 #include <QCommandLineParser>
+#include <QJsonDocument>
 
 #include <NetworkLogging.h>
 #include <NetworkingConstants.h>
@@ -24,6 +28,9 @@
 #include <DependencyManager.h>
 #include <SettingHandle.h>
 
+#include "LoadTestBot.h"
+#include "LoadTestHarness.h"
+
 ACClientApp::ACClientApp(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
 {
@@ -48,6 +55,39 @@ ACClientApp::ACClientApp(int argc, char* argv[]) :
     const QCommandLineOption listenPortOption("listenPort", "listen port", QString::number(INVALID_PORT));
     parser.addOption(listenPortOption);
 
+    const QCommandLineOption botsOption("bots", "load test with this many bots", "count");
+    parser.addOption(botsOption);
+
+    const QCommandLineOption botStepsOption("bot-steps", "load test in steps of these many bots", "count,count,...");
+    parser.addOption(botStepsOption);
+
+    const QCommandLineOption stepDurationOption("step-duration", "seconds each load test step runs for", "60");
+    parser.addOption(stepDurationOption);
+
+    const QCommandLineOption clipOption("clip", "recording for the bots to replay", "path");
+    parser.addOption(clipOption);
+
+    const QCommandLineOption patternOption("pattern", "how the bots move: idle, circle or wander", "circle");
+    parser.addOption(patternOption);
+
+    const QCommandLineOption radiusOption("radius", "meters the bots move within", "5");
+    parser.addOption(radiusOption);
+
+    const QCommandLineOption speedOption("speed", "meters per second the bots move at", "1");
+    parser.addOption(speedOption);
+
+    const QCommandLineOption reportOption("report", "file to write the load test report to", "path");
+    parser.addOption(reportOption);
+
+    // run by the load test for each of its bots
+    QCommandLineOption botOption("bot", "run as a single load test bot");
+    botOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(botOption);
+
+    QCommandLineOption botIndexOption("bot-index", "the load test bot's index", "0");
+    botIndexOption.setFlags(QCommandLineOption::HiddenFromHelp);
+    parser.addOption(botIndexOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << Qt::endl;
         parser.showHelp();
@@ -82,6 +122,57 @@ ACClientApp::ACClientApp(int argc, char* argv[]) :
         qDebug() << "domain-server address is" << domainServerAddress;
     }
 
+    if (parser.isSet(botsOption) || parser.isSet(botStepsOption)) {
+        std::vector<int> botSteps;
+        if (parser.isSet(botStepsOption)) {
+            for (const auto& step : parser.value(botStepsOption).split(",", Qt::SkipEmptyParts)) {
+                botSteps.push_back(step.toInt());
+            }
+        } else {
+            botSteps.push_back(parser.value(botsOption).toInt());
+        }
+        if (std::any_of(botSteps.begin(), botSteps.end(), [](int numBots) { return numBots <= 0; })) {
+            qCritical() << "--bots and --bot-steps take bot counts above zero";
+            parser.showHelp();
+            Q_UNREACHABLE();
+        }
+
+        QStringList botArguments { "-d", domainServerAddress };
+        for (const auto& option : { clipOption, patternOption, radiusOption, speedOption }) {
+            if (parser.isSet(option)) {
+                botArguments << "--" + option.names().first() << parser.value(option);
+            }
+        }
+
+        int stepDurationSecs = parser.isSet(stepDurationOption) ? parser.value(stepDurationOption).toInt() : 60;
+        _loadTestHarness = new LoadTestHarness(botSteps, stepDurationSecs, botArguments, parser.value(reportOption), this);
+        connect(_loadTestHarness, &LoadTestHarness::finished, this, &QCoreApplication::exit);
+        QTimer::singleShot(0, _loadTestHarness, &LoadTestHarness::start);
+        return;
+    }
+
+    LoadTestBotOptions botOptions;
+    bool isBot = parser.isSet(botOption);
+    if (isBot) {
+        botOptions.index = parser.value(botIndexOption).toInt();
+        botOptions.clipPath = parser.value(clipOption);
+        if (parser.isSet(patternOption)
+            && !LoadTestBotOptions::patternFromString(parser.value(patternOption), botOptions.pattern)) {
+            qCritical() << "--pattern should be idle, circle or wander";
+            parser.showHelp();
+            Q_UNREACHABLE();
+        }
+        if (parser.isSet(radiusOption)) {
+            botOptions.radius = parser.value(radiusOption).toFloat();
+        }
+        if (parser.isSet(speedOption)) {
+            botOptions.speed = parser.value(speedOption).toFloat();
+        }
+        if (parser.isSet(stepDurationOption)) {
+            botOptions.durationSecs = parser.value(stepDurationOption).toInt();
+        }
+    }
+
     int listenPort = INVALID_PORT;
     if (parser.isSet(listenPortOption)) {
         listenPort = parser.value(listenPortOption).toInt();
@@ -128,8 +219,12 @@ ACClientApp::ACClientApp(int argc, char* argv[]) :
     connect(nodeList.data(), &NodeList::nodeKilled, this, &ACClientApp::nodeKilled);
     connect(nodeList.data(), &NodeList::nodeActivated, this, &ACClientApp::nodeActivated);
     connect(nodeList.data(), &NodeList::packetVersionMismatch, this, &ACClientApp::notifyPacketVersionMismatch);
-    nodeList->addSetOfNodeTypesToNodeInterestSet(NodeSet() << NodeType::AudioMixer << NodeType::AvatarMixer
-                                                 << NodeType::EntityServer << NodeType::AssetServer << NodeType::MessagesMixer);
+    if (isBot) {
+        nodeList->addSetOfNodeTypesToNodeInterestSet(NodeSet() << NodeType::AudioMixer << NodeType::AvatarMixer);
+    } else {
+        nodeList->addSetOfNodeTypesToNodeInterestSet(NodeSet() << NodeType::AudioMixer << NodeType::AvatarMixer
+                                                     << NodeType::EntityServer << NodeType::AssetServer << NodeType::MessagesMixer);
+    }
 
     if (_verbose) {
         QString username = accountManager->getAccountInfo().getUsername();
@@ -157,6 +252,13 @@ ACClientApp::ACClientApp(int argc, char* argv[]) :
 
     DependencyManager::get<AddressManager>()->handleLookupString(domainServerAddress, false);
 
+    if (isBot) {
+        _loadTestBot = new LoadTestBot(botOptions, this);
+        connect(_loadTestBot, &LoadTestBot::finished, this, &ACClientApp::botFinished);
+        _loadTestBot->start();
+        return;
+    }
+
     QTimer* doTimer = new QTimer(this);
     doTimer->setSingleShot(true);
     connect(doTimer, &QTimer::timeout, this, &ACClientApp::timedOut);
@@ -242,6 +344,14 @@ void ACClientApp::notifyPacketVersionMismatch() {
     finish(1);
 }
 
+void ACClientApp::botFinished(const QJsonObject& report) {
+    // the log shares stdout, so the report goes out as one marked line for the load test to pick out
+    fprintf(stdout, "\n%s%s\n", LOAD_TEST_REPORT_PREFIX.constData(),
+            QJsonDocument(report).toJson(QJsonDocument::Compact).constData());
+    fflush(stdout);
+    finish(0);
+}
+
 void ACClientApp::printFailedServers() {
     if (!_sawEntityServer) {
         qDebug() << "EntityServer";
@@ -273,6 +383,8 @@ void ACClientApp::finish(int exitCode) {
     // remove the NodeList from the DependencyManager
     DependencyManager::destroy<NodeList>();
 
-    printFailedServers();
+    if (!_loadTestBot) {
+        printFailedServers();
+    }
     QCoreApplication::exit(exitCode);
 }
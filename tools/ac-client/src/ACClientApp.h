@@ -14,12 +14,16 @@
 #define hifi_ACClientApp_h
 
 #include <QCoreApplication>
+#include <QJsonObject>
 #include <udt/Constants.h>
 #include <udt/Socket.h>
 #include <ReceivedMessage.h>
 #include <NetworkPeer.h>
 #include <NodeList.h>
 
+class LoadTestBot;
+class LoadTestHarness;
+
 
 class ACClientApp : public QCoreApplication {
     Q_OBJECT
@@ -34,6 +38,7 @@ private slots:
     void nodeActivated(SharedNodePointer node);
     void nodeKilled(SharedNodePointer node);
     void notifyPacketVersionMismatch();
+    void botFinished(const QJsonObject& report);
 
 private:
     NodeList* _nodeList;
@@ -50,6 +55,9 @@ private:
 
     QString _username;
     QString _password;
+
+    LoadTestHarness* _loadTestHarness { nullptr };
+    LoadTestBot* _loadTestBot { nullptr };
 };
 
 #endif //hifi_ACClientApp_h
@@ -0,0 +1,356 @@
+//
+//  LoadTestBot.cpp
+//  tools/ac-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LoadTestBot.h"
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <AudioConstants.h>
+#include <ClientTraitsHandler.h>
+#include <GLMHelpers.h>
+#include <HeadData.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+#include <recording/Clip.h>
+#include <recording/Frame.h>
+#include <shared/ConicalViewFrustum.h>
+
+static const int TICK_INTERVAL_MSECS = 10; // one network audio frame
+static const int LATENCY_SAMPLE_INTERVAL_MSECS = 1000;
+static const int AVATAR_QUERY_INTERVAL_MSECS = 1000;
+static const int BOT_GRID_COLUMNS = 10;
+static const float BOT_GRID_SPACING = 2.0f; // meters
+
+bool LoadTestBotOptions::patternFromString(const QString& name, Pattern& pattern) {
+    if (name == "idle") {
+        pattern = Pattern::Idle;
+    } else if (name == "circle") {
+        pattern = Pattern::Circle;
+    } else if (name == "wander") {
+        pattern = Pattern::Wander;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+LoadTestAvatar::LoadTestAvatar() {
+    _headData = new HeadData(this);
+    _clientTraitsHandler.reset(new ClientTraitsHandler(this));
+}
+
+QByteArray LoadTestAvatar::toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking) {
+    _globalPosition = getWorldPosition();
+    return AvatarData::toByteArrayStateful(dataDetail, dropFaceTracking);
+}
+
+int LoadTestAvatar::sendAvatarDataPacket(bool sendAll) {
+    int bytesSent = 0;
+    if (getIdentityDataChanged()) {
+        bytesSent += sendIdentityPacket();
+    }
+    bytesSent += _clientTraitsHandler->sendChangedTraitsToMixer();
+    return bytesSent + AvatarData::sendAvatarDataPacket(sendAll);
+}
+
+LoadTestBot::LoadTestBot(const LoadTestBotOptions& options, QObject* parent) :
+    QObject(parent),
+    _options(options),
+    _avatar(new LoadTestAvatar()),
+    _random(options.index)
+{
+    // bots stand in a grid around the origin so that they don't all start inside each other
+    int column = _options.index % BOT_GRID_COLUMNS;
+    int row = _options.index / BOT_GRID_COLUMNS;
+    _spawnPosition = _options.origin
+        + glm::vec3((column - BOT_GRID_COLUMNS / 2) * BOT_GRID_SPACING, 0.0f, row * BOT_GRID_SPACING);
+    _wanderTarget = _spawnPosition;
+
+    _avatar->setDisplayName(QString("Load test bot %1").arg(_options.index));
+    _avatar->setSkeletonModelURL(QUrl());
+    _avatar->setWorldPosition(_spawnPosition);
+
+    if (!_options.clipPath.isEmpty()) {
+        _clip = recording::Clip::fromFile(_options.clipPath);
+        if (_clip) {
+            _clipDurationMsecs = std::max((uint32_t)1, (uint32_t)(_clip->duration() * MSECS_PER_SECOND));
+        } else {
+            qWarning() << "Bot" << _options.index << "couldn't load the recording" << _options.clipPath;
+        }
+    }
+
+    _tickTimer.setTimerType(Qt::PreciseTimer);
+    _tickTimer.setInterval(TICK_INTERVAL_MSECS);
+    connect(&_tickTimer, &QTimer::timeout, this, &LoadTestBot::tick);
+
+    _latencyTimer.setInterval(LATENCY_SAMPLE_INTERVAL_MSECS);
+    connect(&_latencyTimer, &QTimer::timeout, this, &LoadTestBot::sampleLatency);
+
+    _avatarQueryTimer.setInterval(AVATAR_QUERY_INTERVAL_MSECS);
+    connect(&_avatarQueryTimer, &QTimer::timeout, this, &LoadTestBot::sendAvatarQuery);
+}
+
+void LoadTestBot::start() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    connect(nodeList.data(), &NodeList::nodeActivated, this, &LoadTestBot::nodeActivated);
+    connect(nodeList.data(), &NodeList::uuidChanged, _avatar.data(), &AvatarData::setSessionUUID);
+
+    auto& packetReceiver = nodeList->getPacketReceiver();
+    packetReceiver.registerListener(PacketType::BulkAvatarData,
+        PacketReceiver::makeSourcedListenerReference<LoadTestBot>(this, &LoadTestBot::handleBulkAvatarData));
+    packetReceiver.registerListener(PacketType::MixedAudio,
+        PacketReceiver::makeSourcedListenerReference<LoadTestBot>(this, &LoadTestBot::handleMixedAudio));
+    packetReceiver.registerListener(PacketType::SilentAudioFrame,
+        PacketReceiver::makeSourcedListenerReference<LoadTestBot>(this, &LoadTestBot::handleMixedAudio));
+
+    QTimer::singleShot(_options.durationSecs * MSECS_PER_SECOND, this, &LoadTestBot::finish);
+}
+
+void LoadTestBot::nodeActivated(SharedNodePointer node) {
+    if (node->getType() == NodeType::AvatarMixer) {
+        _avatar->setSessionUUID(DependencyManager::get<NodeList>()->getSessionUUID());
+        _avatar->markIdentityDataChanged();
+    }
+
+    if (!_isRunning) {
+        // the run is timed from the first mixer coming up, the other usually follows within a few frames
+        _isRunning = true;
+        _runTimer.start();
+        _lastTickUsecs = usecTimestampNow();
+        _tickTimer.start();
+        _latencyTimer.start();
+        _avatarQueryTimer.start();
+        sendAvatarQuery();
+    }
+}
+
+void LoadTestBot::tick() {
+    auto now = usecTimestampNow();
+    auto expected = _lastTickUsecs + TICK_INTERVAL_MSECS * USECS_PER_MSEC;
+    _tickLateness.record(now > expected ? (int)(now - expected) : 0);
+    _lastTickUsecs = now;
+
+    auto elapsedMsecs = (uint32_t)_runTimer.elapsed();
+    if (_clip) {
+        playClip(elapsedMsecs);
+    }
+
+    // the recording's motion is played in place, the pattern moves it around
+    _avatar->setWorldPosition(getPatternPosition(elapsedMsecs / (float)MSECS_PER_SECOND));
+
+    if (_pendingAudio.empty()) {
+        sendAudio(QByteArray());
+    } else {
+        for (const auto& samples : _pendingAudio) {
+            sendAudio(samples);
+        }
+        _pendingAudio.clear();
+    }
+
+    if (now - _lastAvatarSendUsecs >= MIN_TIME_BETWEEN_MY_AVATAR_DATA_SENDS) {
+        auto bytesSent = _avatar->sendAvatarDataPacket();
+        if (bytesSent > 0) {
+            ++_numAvatarPacketsSent;
+            _numAvatarBytesSent += bytesSent;
+        }
+        _lastAvatarSendUsecs = now;
+    }
+}
+
+void LoadTestBot::playClip(uint32_t elapsedMsecs) {
+    static const auto AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+    static const auto AUDIO_FRAME_TYPE = recording::Frame::registerFrameType(AudioConstants::getAudioFrameName());
+
+    uint32_t loop = elapsedMsecs / _clipDurationMsecs;
+    uint32_t position = elapsedMsecs % _clipDurationMsecs;
+    if (loop != _clipLoops) {
+        _clip->seekFrameTime(0);
+        _clipLoops = loop;
+    }
+
+    // positionFrameTime() is INVALID_TIME, later than any position, once the clip has run out
+    while (_clip->positionFrameTime() <= position) {
+        auto frame = _clip->nextFrame();
+        if (!frame) {
+            break;
+        }
+        if (frame->type == AVATAR_FRAME_TYPE) {
+            AvatarData::fromFrame(frame->data, *_avatar);
+        } else if (frame->type == AUDIO_FRAME_TYPE) {
+            _pendingAudio.push_back(frame->data);
+        }
+    }
+}
+
+glm::vec3 LoadTestBot::getPatternPosition(float elapsedSecs) {
+    switch (_options.pattern) {
+        case LoadTestBotOptions::Pattern::Idle:
+            return _spawnPosition;
+
+        case LoadTestBotOptions::Pattern::Circle: {
+            float radius = std::max(_options.radius, 0.1f);
+            // start each bot at a different point on its circle
+            float angle = elapsedSecs * _options.speed / radius + _options.index * 0.5f;
+            glm::vec3 direction(glm::cos(angle), 0.0f, glm::sin(angle));
+            _avatar->setWorldOrientation(glm::quatLookAt(glm::vec3(-direction.z, 0.0f, direction.x), Vectors::UP));
+            return _spawnPosition + radius * direction;
+        }
+
+        case LoadTestBotOptions::Pattern::Wander: {
+            std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+            auto position = _avatar->getWorldPosition();
+            auto toTarget = _wanderTarget - position;
+            float step = _options.speed * TICK_INTERVAL_MSECS / (float)MSECS_PER_SECOND;
+            if (glm::length(toTarget) <= step) {
+                _wanderTarget = _spawnPosition
+                    + _options.radius * glm::vec3(distribution(_random), 0.0f, distribution(_random));
+                return _wanderTarget;
+            }
+            auto direction = glm::normalize(toTarget);
+            _avatar->setWorldOrientation(glm::quatLookAt(direction, Vectors::UP));
+            return position + step * direction;
+        }
+    }
+    return _spawnPosition;
+}
+
+void LoadTestBot::sendAudio(const QByteArray& samples) {
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer);
+    if (!audioMixer || !audioMixer->getActiveSocket()) {
+        return;
+    }
+
+    // laid out as AbstractAudioInterface::emitAudioPacket does, with uncompressed samples as no codec is negotiated
+    bool isSilent = samples.isEmpty();
+    auto audioPacket = NLPacket::create(isSilent ? PacketType::SilentAudioFrame : PacketType::MicrophoneAudioNoEcho);
+    audioPacket->writePrimitive(_audioSequenceNumber++);
+    audioPacket->writeString(QString());
+    if (isSilent) {
+        audioPacket->writePrimitive((quint16)AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+    } else {
+        audioPacket->writePrimitive((quint8)0); // mono
+    }
+    auto position = _avatar->getWorldPosition();
+    audioPacket->writePrimitive(position);
+    audioPacket->writePrimitive(_avatar->getWorldOrientation());
+    audioPacket->writePrimitive(position);
+    audioPacket->writePrimitive(glm::vec3(0.0f));
+    if (!isSilent) {
+        audioPacket->write(samples.constData(), std::min(samples.size(), AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL));
+    }
+
+    nodeList->sendUnreliablePacket(*audioPacket, *audioMixer);
+    ++_numAudioPacketsSent;
+}
+
+void LoadTestBot::sendAvatarQuery() {
+    ViewFrustum view;
+    view.setPosition(_avatar->getWorldPosition());
+    view.setOrientation(_avatar->getWorldOrientation());
+    view.setProjection(DEFAULT_FIELD_OF_VIEW_DEGREES, DEFAULT_ASPECT_RATIO, DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP);
+    view.calculate();
+    ConicalViewFrustum conicalView { view };
+
+    auto avatarPacket = NLPacket::create(PacketType::AvatarQuery);
+    auto destinationBuffer = reinterpret_cast<unsigned char*>(avatarPacket->getPayload());
+    auto bufferStart = destinationBuffer;
+
+    uint8_t numFrustums = 1;
+    memcpy(destinationBuffer, &numFrustums, sizeof(numFrustums));
+    destinationBuffer += sizeof(numFrustums);
+    destinationBuffer += conicalView.serialize(destinationBuffer);
+    avatarPacket->setPayloadSize(destinationBuffer - bufferStart);
+
+    DependencyManager::get<NodeList>()->broadcastToNodes(std::move(avatarPacket), { NodeType::AvatarMixer });
+}
+
+void LoadTestBot::handleBulkAvatarData(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    // the mixer sends each node one bulk packet per frame (more when they don't fit), so the gaps between the first of
+    // each follow its frame times; packets under a millisecond apart are taken as the same frame
+    auto now = usecTimestampNow();
+    if (_lastBulkAvatarDataUsecs != 0 && now - _lastBulkAvatarDataUsecs > USECS_PER_MSEC) {
+        _avatarMixerIntervals.record((int)(now - _lastBulkAvatarDataUsecs));
+    }
+    if (_lastBulkAvatarDataUsecs == 0 || now - _lastBulkAvatarDataUsecs > USECS_PER_MSEC) {
+        _lastBulkAvatarDataUsecs = now;
+    }
+    ++_numBulkAvatarDataReceived;
+}
+
+void LoadTestBot::handleMixedAudio(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode) {
+    auto now = usecTimestampNow();
+    if (_lastMixedAudioUsecs != 0) {
+        _audioMixerIntervals.record((int)(now - _lastMixedAudioUsecs));
+    }
+    _lastMixedAudioUsecs = now;
+    ++_numMixedAudioReceived;
+}
+
+void LoadTestBot::sampleLatency() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (auto avatarMixer = nodeList->soloNodeOfType(NodeType::AvatarMixer)) {
+        _avatarMixerPing.record(avatarMixer->getPingMs());
+    }
+    if (auto audioMixer = nodeList->soloNodeOfType(NodeType::AudioMixer)) {
+        _audioMixerPing.record(audioMixer->getPingMs());
+    }
+}
+
+QJsonObject LoadTestBot::percentilesToJson(const udt::LatencyHistogram& histogram) {
+    auto percentiles = histogram.getPercentiles();
+    QJsonObject result;
+    result["count"] = (double)histogram.getCount();
+    result["mean"] = histogram.getMean();
+    result["p50"] = percentiles.p50;
+    result["p90"] = percentiles.p90;
+    result["p99"] = percentiles.p99;
+    result["max"] = percentiles.max;
+    return result;
+}
+
+void LoadTestBot::finish() {
+    _tickTimer.stop();
+    _latencyTimer.stop();
+    _avatarQueryTimer.stop();
+
+    // the mixers keep an avatar for as long as its node is connected, so tell them this one has gone
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->eachMatchingNode([](const SharedNodePointer& node) {
+        return (node->getType() == NodeType::AvatarMixer || node->getType() == NodeType::AudioMixer)
+            && node->getActiveSocket();
+    }, [&](const SharedNodePointer& node) {
+        auto packet = NLPacket::create(PacketType::KillAvatar, NUM_BYTES_RFC4122_UUID + sizeof(KillAvatarReason), true);
+        packet->write(nodeList->getSessionUUID().toRfc4122());
+        packet->writePrimitive(KillAvatarReason::NoReason);
+        nodeList->sendPacket(std::move(packet), *node);
+    });
+
+    QJsonObject report;
+    report["bot"] = _options.index;
+    report["connected"] = _isRunning;
+    report["run_secs"] = _isRunning ? _runTimer.elapsed() / (double)MSECS_PER_SECOND : 0.0;
+    report["replayed_recording"] = (bool)_clip;
+    report["avatar_packets_sent"] = (double)_numAvatarPacketsSent;
+    report["avatar_bytes_sent"] = (double)_numAvatarBytesSent;
+    report["audio_packets_sent"] = (double)_numAudioPacketsSent;
+    report["bulk_avatar_data_received"] = (double)_numBulkAvatarDataReceived;
+    report["mixed_audio_received"] = (double)_numMixedAudioReceived;
+    report["tick_lateness_usecs"] = percentilesToJson(_tickLateness);
+    report["avatar_mixer_frame_interval_usecs"] = percentilesToJson(_avatarMixerIntervals);
+    report["audio_mixer_frame_interval_usecs"] = percentilesToJson(_audioMixerIntervals);
+    report["avatar_mixer_ping_msecs"] = percentilesToJson(_avatarMixerPing);
+    report["audio_mixer_ping_msecs"] = percentilesToJson(_audioMixerPing);
+
+    emit finished(report);
+}
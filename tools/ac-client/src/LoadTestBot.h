@@ -0,0 +1,121 @@
+//
+//  LoadTestBot.h
+//  tools/ac-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LoadTestBot_h
+#define hifi_LoadTestBot_h
+
+#include <random>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+
+#include <glm/glm.hpp>
+
+#include <AvatarData.h>
+#include <NodeList.h>
+#include <ReceivedMessage.h>
+#include <recording/Forward.h>
+#include <udt/LatencyHistogram.h>
+
+struct LoadTestBotOptions {
+    enum class Pattern { Idle, Circle, Wander };
+
+    int index { 0 };
+    QString clipPath; // a recording to replay, looped; without one the bot only moves and sends silence
+    Pattern pattern { Pattern::Circle };
+    glm::vec3 origin { 0.0f };
+    float radius { 5.0f }; // meters
+    float speed { 1.0f }; // meters per second
+    int durationSecs { 60 };
+
+    static bool patternFromString(const QString& name, Pattern& pattern);
+};
+
+// The avatar a bot sends: AvatarData with the head and traits handler that ScriptableAvatar sets up, without the rig and
+// animation it carries for scripts.
+class LoadTestAvatar : public AvatarData {
+    Q_OBJECT
+public:
+    LoadTestAvatar();
+
+    QByteArray toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking = false) override;
+    int sendAvatarDataPacket(bool sendAll = false) override;
+};
+
+// One native bot, in a process of its own since a process has one node list and so one session with the domain. It
+// connects as an agent, replays a recording's avatar and audio frames, or sends silence, while moving in a pattern, and
+// measures what it sees of the mixers: the intervals between the frames they send it, which follow their frame times, the
+// ping to each, and how late its own sends run. It reports once, at the end of its run, as a single line of JSON.
+class LoadTestBot : public QObject {
+    Q_OBJECT
+public:
+    LoadTestBot(const LoadTestBotOptions& options, QObject* parent = nullptr);
+
+    void start();
+
+signals:
+    void finished(const QJsonObject& report);
+
+private slots:
+    void nodeActivated(SharedNodePointer node);
+    void tick();
+    void sampleLatency();
+    void finish();
+
+private:
+    void handleBulkAvatarData(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+    void handleMixedAudio(QSharedPointer<ReceivedMessage> message, SharedNodePointer sendingNode);
+
+    void playClip(uint32_t elapsedMsecs);
+    glm::vec3 getPatternPosition(float elapsedSecs);
+    void sendAudio(const QByteArray& samples);
+    void sendAvatarQuery();
+
+    static QJsonObject percentilesToJson(const udt::LatencyHistogram& histogram);
+
+    LoadTestBotOptions _options;
+    QSharedPointer<LoadTestAvatar> _avatar;
+
+    recording::ClipPointer _clip;
+    uint32_t _clipDurationMsecs { 0 };
+    uint32_t _clipLoops { 0 };
+    std::vector<QByteArray> _pendingAudio;
+
+    QTimer _tickTimer;
+    QTimer _latencyTimer;
+    QTimer _avatarQueryTimer;
+    QElapsedTimer _runTimer;
+    quint64 _lastTickUsecs { 0 };
+    quint64 _lastAvatarSendUsecs { 0 };
+    quint64 _lastBulkAvatarDataUsecs { 0 };
+    quint64 _lastMixedAudioUsecs { 0 };
+    quint16 _audioSequenceNumber { 0 };
+    glm::vec3 _spawnPosition;
+    glm::vec3 _wanderTarget;
+    std::mt19937 _random; // seeded with the bot's index, so runs wander the same way
+    bool _isRunning { false };
+
+    uint32_t _numAvatarPacketsSent { 0 };
+    uint64_t _numAvatarBytesSent { 0 };
+    uint32_t _numAudioPacketsSent { 0 };
+    uint32_t _numBulkAvatarDataReceived { 0 };
+    uint32_t _numMixedAudioReceived { 0 };
+
+    udt::LatencyHistogram _tickLateness;
+    udt::LatencyHistogram _avatarMixerIntervals;
+    udt::LatencyHistogram _audioMixerIntervals;
+    udt::LatencyHistogram _avatarMixerPing;
+    udt::LatencyHistogram _audioMixerPing;
+};
+
+#endif // hifi_LoadTestBot_h
@@ -0,0 +1,261 @@
+//
+//  LoadTestHarness.cpp
+//  tools/ac-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LoadTestHarness.h"
+
+#include <algorithm>
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDebug>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
+
+// bots are started a little apart so that the domain-server isn't asked to let a whole step in at once
+static const int BOT_SPAWN_INTERVAL_MSECS = 50;
+
+// time on top of the step's duration for the bots to connect, report and exit before they are killed
+static const int STEP_GRACE_MSECS = 30 * 1000;
+
+const QByteArray LOAD_TEST_REPORT_PREFIX = "load-test-report: ";
+
+static const QStringList PERCENTILE_METRICS {
+    "tick_lateness_usecs",
+    "avatar_mixer_frame_interval_usecs",
+    "audio_mixer_frame_interval_usecs",
+    "avatar_mixer_ping_msecs",
+    "audio_mixer_ping_msecs"
+};
+
+static const QStringList COUNT_METRICS {
+    "avatar_packets_sent",
+    "avatar_bytes_sent",
+    "audio_packets_sent",
+    "bulk_avatar_data_received",
+    "mixed_audio_received"
+};
+
+LoadTestHarness::LoadTestHarness(const std::vector<int>& botSteps, int stepDurationSecs, const QStringList& botArguments,
+                                 const QString& reportPath, QObject* parent) :
+    QObject(parent),
+    _botSteps(botSteps),
+    _stepDurationSecs(stepDurationSecs),
+    _botArguments(botArguments),
+    _reportPath(reportPath)
+{
+    _spawnTimer.setInterval(BOT_SPAWN_INTERVAL_MSECS);
+    connect(&_spawnTimer, &QTimer::timeout, this, &LoadTestHarness::startNextBot);
+
+    _stepTimeoutTimer.setSingleShot(true);
+    connect(&_stepTimeoutTimer, &QTimer::timeout, this, &LoadTestHarness::stepTimedOut);
+}
+
+void LoadTestHarness::start() {
+    if (_botSteps.empty()) {
+        finishRun();
+        return;
+    }
+    startStep();
+}
+
+void LoadTestHarness::startStep() {
+    int numBots = _botSteps[_stepIndex];
+    qInfo() << "Load test step" << (_stepIndex + 1) << "of" << _botSteps.size() << ":" << numBots << "bots for"
+        << _stepDurationSecs << "seconds";
+
+    _bots.assign(numBots, nullptr);
+    _botReports.assign(numBots, QJsonObject());
+    _numBotsStarted = 0;
+    _numBotsFinished = 0;
+
+    _spawnTimer.start();
+    startNextBot();
+
+    int spawnMsecs = numBots * BOT_SPAWN_INTERVAL_MSECS;
+    _stepTimeoutTimer.start(spawnMsecs + _stepDurationSecs * 1000 + STEP_GRACE_MSECS);
+}
+
+void LoadTestHarness::startNextBot() {
+    if (_numBotsStarted >= (int)_bots.size()) {
+        _spawnTimer.stop();
+        return;
+    }
+
+    int index = _numBotsStarted++;
+    auto bot = new QProcess(this);
+    bot->setProcessChannelMode(QProcess::SeparateChannels);
+    bot->setStandardErrorFile(QProcess::nullDevice());
+    connect(bot, QOverload<int, QProcess::ExitStatus>::of(&QProcess::finished), this, [this, index] {
+        botFinished(index);
+    });
+    connect(bot, &QProcess::errorOccurred, this, [this, index](QProcess::ProcessError error) {
+        if (error == QProcess::FailedToStart) {
+            botFinished(index);
+        }
+    });
+    _bots[index] = bot;
+
+    QStringList arguments = _botArguments;
+    arguments << "--bot" << "--bot-index" << QString::number(index)
+        << "--step-duration" << QString::number(_stepDurationSecs);
+    bot->start(QCoreApplication::applicationFilePath(), arguments);
+}
+
+void LoadTestHarness::botFinished(int index) {
+    auto bot = _bots[index];
+    if (!bot) {
+        return;
+    }
+
+    // the bot's log goes to its stdout as well, the report is the line marked as one
+    QJsonObject report;
+    for (const auto& line : bot->readAllStandardOutput().split('\n')) {
+        if (line.startsWith(LOAD_TEST_REPORT_PREFIX)) {
+            report = QJsonDocument::fromJson(line.mid(LOAD_TEST_REPORT_PREFIX.size())).object();
+        }
+    }
+    if (report.isEmpty()) {
+        qWarning() << "Bot" << index << "exited without a report, exit code" << bot->exitCode();
+    }
+    _botReports[index] = report;
+
+    bot->deleteLater();
+    _bots[index] = nullptr;
+
+    if (++_numBotsFinished == (int)_bots.size()) {
+        finishStep();
+    }
+}
+
+void LoadTestHarness::stepTimedOut() {
+    qWarning() << "Load test step timed out with" << (_bots.size() - _numBotsFinished) << "bots still running";
+    _spawnTimer.stop();
+
+    // the bots that never started won't finish, count them as done
+    _numBotsFinished += (int)_bots.size() - _numBotsStarted;
+    _numBotsStarted = (int)_bots.size();
+    for (auto bot : _bots) {
+        if (bot) {
+            bot->kill();
+        }
+    }
+    if (_numBotsFinished == (int)_bots.size()) {
+        finishStep();
+    }
+}
+
+void LoadTestHarness::finishStep() {
+    _stepTimeoutTimer.stop();
+    _stepSummaries.append(summarizeStep((int)_bots.size()));
+
+    if (++_stepIndex < (int)_botSteps.size()) {
+        startStep();
+    } else {
+        finishRun();
+    }
+}
+
+QJsonObject LoadTestHarness::summarizeStep(int numBots) const {
+    QJsonObject summary;
+    summary["bots"] = numBots;
+
+    int numReported = 0;
+    int numConnected = 0;
+    for (const auto& report : _botReports) {
+        if (!report.isEmpty()) {
+            ++numReported;
+        }
+        if (report["connected"].toBool()) {
+            ++numConnected;
+        }
+    }
+    summary["bots_reported"] = numReported;
+    summary["bots_connected"] = numConnected;
+
+    for (const auto& metric : COUNT_METRICS) {
+        double total = 0.0;
+        for (const auto& report : _botReports) {
+            total += report[metric].toDouble();
+        }
+        summary[metric] = total;
+    }
+
+    // what a typical bot saw, the median of their medians, and what the worst off of them saw
+    for (const auto& metric : PERCENTILE_METRICS) {
+        std::vector<double> medians;
+        double worstP99 = 0.0;
+        double worstMax = 0.0;
+        for (const auto& report : _botReports) {
+            auto percentiles = report[metric].toObject();
+            if (percentiles["count"].toDouble() == 0.0) {
+                continue;
+            }
+            medians.push_back(percentiles["p50"].toDouble());
+            worstP99 = std::max(worstP99, percentiles["p99"].toDouble());
+            worstMax = std::max(worstMax, percentiles["max"].toDouble());
+        }
+
+        QJsonObject result;
+        if (!medians.empty()) {
+            std::nth_element(medians.begin(), medians.begin() + medians.size() / 2, medians.end());
+            result["median_p50"] = medians[medians.size() / 2];
+        } else {
+            result["median_p50"] = 0.0;
+        }
+        result["worst_p99"] = worstP99;
+        result["worst_max"] = worstMax;
+        summary[metric] = result;
+    }
+
+    QJsonArray botReports;
+    for (const auto& report : _botReports) {
+        botReports.append(report);
+    }
+    summary["bot_reports"] = botReports;
+
+    return summary;
+}
+
+void LoadTestHarness::finishRun() {
+    auto line = [](const QJsonObject& step, const QString& metric) {
+        auto result = step[metric].toObject();
+        return QString("%1/%2").arg(result["median_p50"].toDouble()).arg(result["worst_p99"].toDouble());
+    };
+
+    qInfo().noquote() << "bots  connected  avatar mixer frame us  audio mixer frame us  avatar mixer ping ms"
+                         "  audio mixer ping ms  (median p50/worst p99)";
+    for (const auto& value : _stepSummaries) {
+        auto step = value.toObject();
+        qInfo().noquote() << QString("%1  %2  %3  %4  %5  %6")
+            .arg(step["bots"].toInt(), 4)
+            .arg(step["bots_connected"].toInt(), 9)
+            .arg(line(step, "avatar_mixer_frame_interval_usecs"), 21)
+            .arg(line(step, "audio_mixer_frame_interval_usecs"), 20)
+            .arg(line(step, "avatar_mixer_ping_msecs"), 20)
+            .arg(line(step, "audio_mixer_ping_msecs"), 19);
+    }
+
+    int exitCode = 0;
+    if (!_reportPath.isEmpty()) {
+        QJsonObject report;
+        report["step_duration_secs"] = _stepDurationSecs;
+        report["steps"] = _stepSummaries;
+
+        QFile file(_reportPath);
+        if (file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            file.write(QJsonDocument(report).toJson());
+        } else {
+            qWarning() << "Couldn't write the load test report to" << _reportPath;
+            exitCode = 1;
+        }
+    }
+
+    emit finished(exitCode);
+}
@@ -0,0 +1,70 @@
+//
+//  LoadTestHarness.h
+//  tools/ac-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_LoadTestHarness_h
+#define hifi_LoadTestHarness_h
+
+#include <vector>
+
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
+#include <QtCore/QObject>
+#include <QtCore/QProcess>
+#include <QtCore/QStringList>
+#include <QtCore/QTimer>
+
+// what a bot starts the line of its report with
+extern const QByteArray LOAD_TEST_REPORT_PREFIX;
+
+// Runs a load test in steps: for each bot count it starts that many bots, each an ac-client process of its own in --bot
+// mode, lets them run for the step's duration, collects the report each prints as it exits and sums them up for the step.
+// The steps' summaries are printed as a table and, with a report path, written out as JSON.
+class LoadTestHarness : public QObject {
+    Q_OBJECT
+public:
+    // botArguments are passed to every bot, which is also given its index and the step's duration
+    LoadTestHarness(const std::vector<int>& botSteps, int stepDurationSecs, const QStringList& botArguments,
+                    const QString& reportPath, QObject* parent = nullptr);
+
+    void start();
+
+signals:
+    void finished(int exitCode);
+
+private slots:
+    void startNextBot();
+    void botFinished(int index);
+    void stepTimedOut();
+
+private:
+    void startStep();
+    void finishStep();
+    void finishRun();
+
+    QJsonObject summarizeStep(int numBots) const;
+
+    std::vector<int> _botSteps;
+    int _stepDurationSecs;
+    QStringList _botArguments;
+    QString _reportPath;
+
+    int _stepIndex { 0 };
+    std::vector<QProcess*> _bots;
+    int _numBotsStarted { 0 };
+    int _numBotsFinished { 0 };
+    std::vector<QJsonObject> _botReports;
+    QTimer _spawnTimer;
+    QTimer _stepTimeoutTimer;
+
+    QJsonArray _stepSummaries;
+};
+
+#endif // hifi_LoadTestHarness_h
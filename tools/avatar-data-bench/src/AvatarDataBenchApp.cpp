@@ -0,0 +1,131 @@
+//
+//  AvatarDataBenchApp.cpp
+//  tools/avatar-data-bench/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarDataBenchApp.h"
+
+#include <QCommandLineParser>
+#include <QDebug>
+
+#include <AvatarData.h>
+#include <recording/Clip.h>
+#include <recording/Frame.h>
+
+struct ListenerStream {
+    float distance;
+    bool compactJointRotations;
+    QVector<JointData> lastSentJointData;
+    quint64 bytesSent { 0 };
+};
+
+AvatarDataBenchApp::AvatarDataBenchApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Avatar Data Encoding Benchmark");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input recording", "filename.hfr");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption distancesOption("d", "comma separated listener distances in meters", "distances", "2,15,30,60");
+    parser.addOption(distancesOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QString inputFilename;
+    if (parser.isSet(inputFilenameOption)) {
+        inputFilename = parser.value(inputFilenameOption);
+    }
+
+    std::vector<ListenerStream> streams;
+    for (const auto& value : parser.value(distancesOption).split(',')) {
+        float distance = value.toFloat();
+        streams.push_back({ distance, false });
+        streams.push_back({ distance, true });
+    }
+
+    // the frame type must be registered for the recording to keep its avatar frames
+    const recording::FrameType AVATAR_FRAME_TYPE = recording::Frame::registerFrameType(AvatarData::FRAME_NAME);
+    auto clip = recording::Clip::fromFile(inputFilename);
+    if (!clip) {
+        qCritical() << "Failed to read recording " << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+
+    // the recorded avatar sends its data, and the mixer's copy of it re-encodes that data for each listener
+    AvatarData sender;
+    AvatarData mixerAvatar;
+    int numFrames = 0;
+    int numJoints = 0;
+
+    clip->seek(0.0f);
+    for (auto frame = clip->nextFrame(); frame; frame = clip->nextFrame()) {
+        if (frame->type != AVATAR_FRAME_TYPE) {
+            continue;
+        }
+        AvatarData::fromFrame(frame->data, sender, false);
+
+        AvatarDataPacket::SendStatus senderStatus;
+        QVector<JointData> noSentJointData(sender.getJointCount());
+        AvatarData::_compactJointRotations = true;
+        QByteArray senderData = sender.toByteArray(AvatarData::SendAllData, 0, noSentJointData, senderStatus,
+                                                   false, false, glm::vec3(0.0f), nullptr);
+        mixerAvatar.parseDataFromBuffer(senderData);
+        mixerAvatar.updateEncodingCache();
+
+        numJoints = std::max(numJoints, mixerAvatar.getJointCount());
+        numFrames++;
+
+        for (auto& stream : streams) {
+            AvatarData::_compactJointRotations = stream.compactJointRotations;
+            stream.lastSentJointData.resize(mixerAvatar.getJointCount());
+
+            glm::vec3 viewerPosition = mixerAvatar.getClientGlobalPosition() + glm::vec3(stream.distance, 0.0f, 0.0f);
+            AvatarDataPacket::SendStatus sendStatus;
+            QByteArray bytes = mixerAvatar.toByteArray(AvatarData::CullSmallData, 0, stream.lastSentJointData, sendStatus,
+                                                       false, true, viewerPosition, &stream.lastSentJointData);
+            stream.bytesSent += bytes.size();
+        }
+    }
+
+    float duration = clip->duration();
+    if (numFrames == 0 || numJoints == 0 || duration <= 0.0f) {
+        qCritical() << "No avatar joint data in recording " << inputFilename;
+        _returnCode = 3;
+        return;
+    }
+
+    qInfo().noquote() << QString("%1 avatar frames, %2 joints, %3 seconds").arg(numFrames).arg(numJoints).arg(duration);
+    qInfo().noquote() << "distance  six byte rotations  compact rotations  (bytes per joint per second)";
+    for (size_t i = 0; i < streams.size(); i += 2) {
+        float sixByteRate = (float)streams[i].bytesSent / (numJoints * duration);
+        float compactRate = (float)streams[i + 1].bytesSent / (numJoints * duration);
+        qInfo().noquote() << QString("%1 m  %2  %3  (%4%)")
+            .arg(streams[i].distance, 6, 'f', 1)
+            .arg(sixByteRate, 18, 'f', 2)
+            .arg(compactRate, 17, 'f', 2)
+            .arg(100.0f * (compactRate - sixByteRate) / sixByteRate, 0, 'f', 1);
+    }
+}
+
+AvatarDataBenchApp::~AvatarDataBenchApp() {
+}
@@ -0,0 +1,31 @@
+//
+//  AvatarDataBenchApp.h
+//  tools/avatar-data-bench/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_AvatarDataBenchApp_h
+#define hifi_AvatarDataBenchApp_h
+
+#include <QCoreApplication>
+
+// Replays the avatar frames of a recording through the avatar mixer's encoder, and reports
+// the bytes sent to listeners at several distances, with and without compact joint rotations.
+class AvatarDataBenchApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    AvatarDataBenchApp(int argc, char* argv[]);
+    ~AvatarDataBenchApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif //hifi_AvatarDataBenchApp_h
@@ -0,0 +1,109 @@
+//
+//  ClipConvertApp.cpp
+//  tools/clip-convert/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ClipConvertApp.h"
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QFileInfo>
+#include <QJsonObject>
+
+#include <recording/Clip.h>
+#include <recording/Frame.h>
+#include <recording/impl/ChunkedClip.h>
+#include <recording/impl/FileClip.h>
+
+namespace {
+
+QJsonDocument readClipHeader(const QString& filename) {
+    if (recording::ChunkedClip::isChunkedFile(filename)) {
+        return recording::ChunkedClip(filename).getHeader();
+    }
+    return recording::FileClip(filename).getHeader();
+}
+
+}
+
+ClipConvertApp::ClipConvertApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Convert recordings between the .hfr format and the chunked one");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input recording, in either format", "filename.hfr");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption outputFilenameOption("o", "output recording", "filename.hfr");
+    parser.addOption(outputFilenameOption);
+
+    const QCommandLineOption formatOption("f", "output format", "chunked|hfr", "chunked");
+    parser.addOption(formatOption);
+
+    const QCommandLineOption uncompressedOption("uncompressed", "don't compress the chunks, to play them straight from the file");
+    parser.addOption(uncompressedOption);
+
+    const QCommandLineOption chunkFramesOption("chunk-frames", "the most frames in a chunk", "frames",
+                                               QString::number(recording::ChunkedClip::DEFAULT_CHUNK_FRAMES));
+    parser.addOption(chunkFramesOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    QString outputFilename = parser.value(outputFilenameOption);
+    QString format = parser.value(formatOption);
+    uint32_t chunkFrames = parser.value(chunkFramesOption).toUInt();
+    if (inputFilename.isEmpty() || outputFilename.isEmpty() || (format != "chunked" && format != "hfr") || chunkFrames == 0) {
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    // a clip keeps only the frames of types registered in the process reading it, so register all of the input's
+    auto header = readClipHeader(inputFilename);
+    auto frameTypes = header.object()[recording::Clip::FRAME_TYPE_MAP].toObject();
+    for (const auto& frameTypeName : frameTypes.keys()) {
+        recording::Frame::registerFrameType(frameTypeName);
+    }
+
+    auto clip = recording::Clip::fromFile(inputFilename);
+    if (!clip) {
+        qCritical() << "Failed to read recording" << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+
+    bool written = false;
+    if (format == "chunked") {
+        written = recording::ChunkedClip::write(outputFilename, clip, !parser.isSet(uncompressedOption), chunkFrames);
+    } else {
+        recording::Clip::toFile(outputFilename, clip);
+        written = QFileInfo(outputFilename).size() > 0;
+    }
+    if (!written) {
+        qCritical() << "Failed to write recording" << outputFilename;
+        _returnCode = 3;
+        return;
+    }
+
+    qInfo() << "Converted" << clip->frameCount() << "frames of" << inputFilename << "(" << QFileInfo(inputFilename).size()
+            << "bytes) to" << outputFilename << "(" << QFileInfo(outputFilename).size() << "bytes)";
+}
@@ -0,0 +1,30 @@
+//
+//  ClipConvertApp.h
+//  tools/clip-convert/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ClipConvertApp_h
+#define hifi_ClipConvertApp_h
+
+#include <QCoreApplication>
+
+// Converts a recording between the .hfr format and the chunked one, which agents map and seek in without reading
+// the whole recording.
+class ClipConvertApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    ClipConvertApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif //hifi_ClipConvertApp_h
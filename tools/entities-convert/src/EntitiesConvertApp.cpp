@@ -0,0 +1,110 @@
+//
+//  EntitiesConvertApp.cpp
+//  tools/entities-convert/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitiesConvertApp.h"
+
+#include <QCommandLineParser>
+#include <QDataStream>
+#include <QDebug>
+#include <QFile>
+#include <QUrl>
+
+#include <test-utils/EntityTreeTestUtils.h>
+
+namespace {
+
+QString persistFileType(const QString& filename) {
+    for (const auto& extension : PERSIST_EXTENSIONS) {
+        if (filename.endsWith("." + extension, Qt::CaseInsensitive)) {
+            return extension;
+        }
+    }
+    return QString();
+}
+
+}
+
+EntitiesConvertApp::EntitiesConvertApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Convert entity persist files between JSON and binary snapshots");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input file", "models.json.gz|models.json|models.bin");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption outputFilenameOption("o", "output file, its extension picks the format",
+                                                  "models.json.gz|models.json|models.bin");
+    parser.addOption(outputFilenameOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    QString outputFilename = parser.value(outputFilenameOption);
+    QString inputType = persistFileType(inputFilename);
+    QString outputType = persistFileType(outputFilename);
+    if (inputType.isEmpty() || outputType.isEmpty()) {
+        qCritical() << "Input and output files must end in one of" << PERSIST_EXTENSIONS;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    setUpEntityTreeDependencies();
+
+    auto tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+
+    bool loaded = false;
+    tree->withWriteLock([&] {
+        if (inputType == "bin") {
+            loaded = tree->readSnapshotFile(inputFilename);
+        } else if (inputType == "json.gz") {
+            loaded = tree->readJSONFromGzippedFile(inputFilename);
+        } else {
+            QFile file(inputFilename);
+            if (file.open(QIODevice::ReadOnly)) {
+                QDataStream fileStream(&file);
+                QUrl relativeURL = QUrl::fromLocalFile(inputFilename).adjusted(QUrl::RemoveFilename);
+                loaded = tree->readJSONFromStream(file.size(), fileStream, "", false, relativeURL);
+            }
+        }
+    });
+
+    if (!loaded) {
+        qCritical() << "Failed to read entities from" << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+
+    if (!tree->writeToFile(outputFilename.toLocal8Bit().constData(), nullptr, outputType)) {
+        qCritical() << "Failed to write entities to" << outputFilename;
+        _returnCode = 3;
+        return;
+    }
+
+    qInfo() << "Converted" << inputFilename << "to" << outputFilename;
+}
+
+EntitiesConvertApp::~EntitiesConvertApp() {
+    tearDownEntityTreeDependencies();
+}
@@ -0,0 +1,31 @@
+//
+//  EntitiesConvertApp.h
+//  tools/entities-convert/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_EntitiesConvertApp_h
+#define hifi_EntitiesConvertApp_h
+
+#include <QCoreApplication>
+
+// Converts an entity server persist file between JSON (.json, .json.gz) and binary snapshots (.bin),
+// so that domain backups and content tools can keep working with JSON when the server persists snapshots.
+class EntitiesConvertApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    EntitiesConvertApp(int argc, char* argv[]);
+    ~EntitiesConvertApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif //hifi_EntitiesConvertApp_h
@@ -0,0 +1,21 @@
+//
+//  main.cpp
+//  tools/entities-convert/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <SharedUtil.h>
+
+#include "EntitiesConvertApp.h"
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Entities Convert");
+
+    EntitiesConvertApp app(argc, argv);
+    return app.getReturnCode();
+}
@@ -0,0 +1,176 @@
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "FrameBenchmark.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include <QtCore/QJsonArray>
+
+#include <gpu/Batch.h>
+#include <gpu/Frame.h>
+#include <gpu/FrameIOKeys.h>
+#include <gpu/Pipeline.h>
+#include <gpu/Shader.h>
+
+static QJsonObject summarize(std::vector<double> samples) {
+    QJsonObject summary;
+    if (samples.empty()) {
+        return summary;
+    }
+    std::sort(samples.begin(), samples.end());
+    double total = std::accumulate(samples.begin(), samples.end(), 0.0);
+    summary["mean"] = total / (double)samples.size();
+    summary["median"] = samples[samples.size() / 2];
+    summary["min"] = samples.front();
+    summary["max"] = samples.back();
+    // the slowest frame but one in twenty
+    summary["p95"] = samples[std::min(samples.size() - 1, (samples.size() * 95) / 100)];
+    return summary;
+}
+
+static QJsonObject toJson(const std::map<std::string, uint32_t>& counts) {
+    QJsonObject result;
+    for (const auto& count : counts) {
+        result[QString::fromStdString(count.first)] = (int)count.second;
+    }
+    return result;
+}
+
+void FrameBenchmark::addFrame(const QString& name, const gpu::FramePointer& frame) {
+    FrameResult result;
+    result.name = name;
+    result.frame = frame;
+    countCommands(result);
+    _frames.push_back(std::move(result));
+}
+
+void FrameBenchmark::countCommands(FrameResult& result) {
+    for (const auto& batch : result.frame->batches) {
+        const auto& commands = batch->getCommands();
+        const auto& offsets = batch->getCommandOffsets();
+        for (size_t i = 0; i < commands.size(); ++i) {
+            auto command = commands[i];
+            ++result.commands[gpu::keys::COMMAND_NAMES[command]];
+            if (command != gpu::Batch::COMMAND_setPipeline) {
+                continue;
+            }
+
+            const auto& pipeline = batch->_pipelines.get(batch->_params[offsets[i]]._uint);
+            std::string pipelineName = "none";
+            if (pipeline && pipeline->getProgram()) {
+                const auto& program = pipeline->getProgram();
+                pipelineName = program->getSource().name;
+                if (pipelineName.empty()) {
+                    pipelineName = "program " + std::to_string(program->getID());
+                }
+            }
+            ++result.pipelines[pipelineName];
+        }
+    }
+}
+
+void FrameBenchmark::step(const Replayer& replay) {
+    if (isDone()) {
+        return;
+    }
+
+    auto& result = _frames[_currentFrame];
+    auto timing = replay(result.frame);
+    // the first replay uploads the frame's buffers and textures, which the rest don't
+    if (!result.warmedUp) {
+        result.warmedUp = true;
+        result.cpuMsecs.reserve(_iterations);
+        result.gpuMsecs.reserve(_iterations);
+        return;
+    }
+    result.cpuMsecs.push_back(timing.cpuMsecs);
+    result.gpuMsecs.push_back(timing.gpuMsecs);
+    result.stats = timing.stats;
+
+    if (result.cpuMsecs.size() >= _iterations) {
+        // the timings are all that's needed from here on
+        result.frame.reset();
+        ++_currentFrame;
+    }
+}
+
+QJsonObject FrameBenchmark::getResults() const {
+    QJsonArray frames;
+    for (const auto& result : _frames) {
+        QJsonObject frame;
+        frame["name"] = result.name;
+        frame["iterations"] = (int)result.cpuMsecs.size();
+        frame["cpuMsecs"] = summarize(result.cpuMsecs);
+        frame["gpuMsecs"] = summarize(result.gpuMsecs);
+
+        QJsonObject stateChanges;
+        const auto& stats = result.stats;
+        stateChanges["pipelines"] = (int)stats._PSNumSetPipelines;
+        stateChanges["inputFormats"] = (int)stats._ISNumFormatChanges;
+        stateChanges["inputBuffers"] = (int)stats._ISNumInputBufferChanges;
+        stateChanges["indexBuffers"] = (int)stats._ISNumIndexBufferChanges;
+        stateChanges["textures"] = (int)stats._RSNumTextureBounded;
+        stateChanges["drawcalls"] = (int)stats._DSNumDrawcalls;
+        stateChanges["apiDrawcalls"] = (int)stats._DSNumAPIDrawcalls;
+        stateChanges["triangles"] = (int)stats._DSNumTriangles;
+        stateChanges["streamedUploads"] = (int)stats._TSNumStreamedUploads;
+        stateChanges["streamStalls"] = (int)stats._TSNumStreamStalls;
+        frame["stateChanges"] = stateChanges;
+
+        frame["commands"] = toJson(result.commands);
+        frame["pipelines"] = toJson(result.pipelines);
+        frames.push_back(frame);
+    }
+
+    QJsonObject results;
+    results["iterations"] = (int)_iterations;
+    results["frames"] = frames;
+    return results;
+}
+
+QStringList FrameBenchmark::compareToBaseline(QJsonObject& results, const QJsonObject& baseline, float thresholdPercent) {
+    std::map<QString, QJsonObject> baselineFrames;
+    for (const auto& value : baseline["frames"].toArray()) {
+        auto frame = value.toObject();
+        baselineFrames[frame["name"].toString()] = frame;
+    }
+
+    QStringList regressions;
+    QJsonArray frames;
+    for (const auto& value : results["frames"].toArray()) {
+        auto frame = value.toObject();
+        auto name = frame["name"].toString();
+        auto baselineFrame = baselineFrames.find(name);
+        if (baselineFrame != baselineFrames.end()) {
+            QJsonObject change;
+            bool regressed = false;
+            for (const auto& key : { QString("cpuMsecs"), QString("gpuMsecs") }) {
+                double mean = frame[key].toObject()["mean"].toDouble();
+                double baselineMean = baselineFrame->second[key].toObject()["mean"].toDouble();
+                if (baselineMean <= 0.0) {
+                    continue;
+                }
+                // in percent, positive when slower than the baseline
+                double percent = 100.0 * (mean - baselineMean) / baselineMean;
+                change[key] = percent;
+                regressed = regressed || percent > thresholdPercent;
+            }
+            frame["baselineChangePercent"] = change;
+            if (regressed) {
+                regressions.push_back(name);
+            }
+        }
+        frames.push_back(frame);
+    }
+    results["frames"] = frames;
+    results["thresholdPercent"] = thresholdPercent;
+    results["regressions"] = QJsonArray::fromStringList(regressions);
+    return regressions;
+}
@@ -0,0 +1,66 @@
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <QtCore/QJsonObject>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <gpu/Forward.h>
+#include <gpu/Context.h>
+
+// Replays captured frames a number of times each, timing the CPU side of submitting them and the GPU side through
+// timestamp queries, and counting the commands, pipelines and backend state changes they are made of.
+class FrameBenchmark {
+public:
+    struct Timing {
+        double cpuMsecs { 0.0 };
+        double gpuMsecs { 0.0 };
+        gpu::ContextStats stats;
+    };
+    // executes the frame once and times it, on the render thread
+    using Replayer = std::function<Timing(const gpu::FramePointer& frame)>;
+
+    FrameBenchmark(uint32_t iterations) : _iterations(iterations) {}
+
+    void addFrame(const QString& name, const gpu::FramePointer& frame);
+
+    bool isDone() const { return _currentFrame >= _frames.size(); }
+    // replays the next iteration of the frame being benchmarked
+    void step(const Replayer& replay);
+
+    QJsonObject getResults() const;
+
+    // adds each frame's change against the same frame of the baseline results to the results and returns the frames
+    // that got slower, on the CPU or the GPU, by more than thresholdPercent
+    static QStringList compareToBaseline(QJsonObject& results, const QJsonObject& baseline, float thresholdPercent);
+
+private:
+    struct FrameResult {
+        QString name;
+        gpu::FramePointer frame;
+        std::vector<double> cpuMsecs;
+        std::vector<double> gpuMsecs;
+        gpu::ContextStats stats;
+        std::map<std::string, uint32_t> commands;
+        std::map<std::string, uint32_t> pipelines;
+        bool warmedUp { false };
+    };
+
+    static void countCommands(FrameResult& result);
+
+    const uint32_t _iterations;
+    std::vector<FrameResult> _frames;
+    size_t _currentFrame { 0 };
+};
@@ -10,6 +10,9 @@
 
 #include <QtCore/QByteArray>
 #include <QtCore/QBuffer>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QJsonDocument>
 #include <QtGui/QResizeEvent>
 #include <QtGui/QImageReader>
 #include <QtGui/QScreen>
@@ -17,6 +20,8 @@
 
 #include <gpu/FrameIO.h>
 
+#include "FrameBenchmark.h"
+
 PlayerWindow::PlayerWindow() {
     installEventFilter(this);
     setFlags(Qt::MSWindowsOwnDC | Qt::Window | Qt::Dialog | Qt::WindowMinMaxButtonsHint | Qt::WindowTitleHint);
@@ -126,3 +131,55 @@ void PlayerWindow::loadFrame(const QString& path) {
         resize(size.x, size.y);
     }
 }
+
+void PlayerWindow::runBenchmark(const QString& dir, uint32_t iterations, const QString& output, const QString& baseline,
+                                float thresholdPercent) {
+    auto benchmark = std::make_shared<FrameBenchmark>(iterations);
+    auto fileNames = QDir(dir).entryList({ "*.hfb" }, QDir::Files, QDir::Name);
+    for (const auto& fileName : fileNames) {
+        auto frame = gpu::readFrame(QDir(dir).filePath(fileName).toStdString(), _renderThread._externalTexture);
+        if (frame && frame->framebuffer) {
+            benchmark->addFrame(fileName, frame);
+        } else {
+            qWarning() << "Skipping unreadable frame" << fileName;
+        }
+    }
+    if (benchmark->isDone()) {
+        qWarning() << "No frames to benchmark in" << dir;
+        QCoreApplication::exit(1);
+        return;
+    }
+
+    _renderThread.startBenchmark(benchmark, [=] {
+        QMetaObject::invokeMethod(this, [=] {
+            auto results = benchmark->getResults();
+            QStringList regressions;
+            if (!baseline.isEmpty()) {
+                QFile baselineFile(baseline);
+                if (baselineFile.open(QIODevice::ReadOnly)) {
+                    auto baselineResults = QJsonDocument::fromJson(baselineFile.readAll()).object();
+                    regressions = FrameBenchmark::compareToBaseline(results, baselineResults, thresholdPercent);
+                } else {
+                    qWarning() << "Unable to read the baseline" << baseline;
+                }
+            }
+
+            QFile outputFile(output);
+            if (outputFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                outputFile.write(QJsonDocument(results).toJson());
+            } else {
+                qWarning() << "Unable to write the results to" << output;
+            }
+
+            for (const auto& regression : regressions) {
+                qWarning() << "Frame" << regression << "is more than" << thresholdPercent << "percent slower than the baseline";
+            }
+            QCoreApplication::exit(regressions.empty() ? 0 : 1);
+        });
+    });
+    if (!_renderThread.isThreaded()) {
+        while (_renderThread._benchmark) {
+            _renderThread.process();
+        }
+    }
+}
@@ -20,6 +20,11 @@ public:
     PlayerWindow();
     virtual ~PlayerWindow();
 
+    // replays every frame in dir iterations times each, writes the timings to output and, given a baseline's output,
+    // exits with 1 when a frame got slower than the baseline by more than thresholdPercent
+    void runBenchmark(const QString& dir, uint32_t iterations, const QString& output, const QString& baseline,
+                      float thresholdPercent);
+
 protected:
     bool eventFilter(QObject* obj, QEvent* event) override;
     void keyPressEvent(QKeyEvent* event) override;
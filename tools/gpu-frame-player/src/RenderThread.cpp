@@ -9,12 +9,20 @@
 #include "RenderThread.h"
 #include <QtGui/QWindow>
 #include <gl/QOpenGLContextWrapper.h>
+#include <NumericalConstants.h>
+#include <SharedUtil.h>
 
 void RenderThread::submitFrame(const gpu::FramePointer& frame) {
     std::unique_lock<std::mutex> lock(_frameLock);
     _pendingFrames.push(frame);
 }
 
+void RenderThread::startBenchmark(const std::shared_ptr<FrameBenchmark>& benchmark, const std::function<void()>& onDone) {
+    std::unique_lock<std::mutex> lock(_frameLock);
+    _benchmark = benchmark;
+    _benchmarkDone = onDone;
+}
+
 void RenderThread::resize(const QSize& newSize) {
     std::unique_lock<std::mutex> lock(_frameLock);
     _pendingSize.push(newSize);
@@ -243,6 +251,27 @@ bool RenderThread::process() {
         pendingSize.pop();
     }
 
+    std::shared_ptr<FrameBenchmark> benchmark;
+    {
+        std::unique_lock<std::mutex> lock(_frameLock);
+        benchmark = _benchmark;
+    }
+    if (benchmark) {
+        benchmark->step([this](const gpu::FramePointer& frame) { return benchmarkFrame(frame); });
+        if (benchmark->isDone()) {
+            std::function<void()> onDone;
+            {
+                std::unique_lock<std::mutex> lock(_frameLock);
+                _benchmark.reset();
+                onDone.swap(_benchmarkDone);
+            }
+            if (onDone) {
+                onDone();
+            }
+        }
+        return true;
+    }
+
     if (!_activeFrame) {
         QThread::msleep(1);
         return true;
@@ -252,6 +281,42 @@ bool RenderThread::process() {
     return true;
 }
 
+FrameBenchmark::Timing RenderThread::benchmarkFrame(const gpu::FramePointer& frame) {
+    FrameBenchmark::Timing timing;
+#ifdef USE_GL
+    _context.makeCurrent();
+    _backend->recycle();
+    _backend->syncCache();
+
+    auto& glbackend = (gpu::gl::GLBackend&)(*_backend);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, glbackend.getFramebufferID(frame->framebuffer));
+    glClearDepth(0);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+
+    static GLuint queries[2] = { 0, 0 };
+    if (!queries[0]) {
+        glGenQueries(2, queries);
+    }
+    glQueryCounter(queries[0], GL_TIMESTAMP);
+    auto start = usecTimestampNow();
+    _gpuContext->executeFrame(frame);
+    timing.cpuMsecs = (double)(usecTimestampNow() - start) / (double)USECS_PER_MSEC;
+    glQueryCounter(queries[1], GL_TIMESTAMP);
+
+    // waiting on the results keeps each replay to itself, on the GPU as well
+    GLuint64 gpuBegin = 0, gpuEnd = 0;
+    glGetQueryObjectui64v(queries[0], GL_QUERY_RESULT, &gpuBegin);
+    glGetQueryObjectui64v(queries[1], GL_QUERY_RESULT, &gpuEnd);
+    timing.gpuMsecs = (double)(gpuEnd - gpuBegin) / (double)NSECS_PER_MSEC;
+
+    _gpuContext->getFrameStats(timing.stats);
+    (void)CHECK_GL_ERROR();
+    _context.doneCurrent();
+#endif
+    return timing;
+}
+
 #ifndef USE_GL
 
 void RenderThread::setupFramebuffers() {
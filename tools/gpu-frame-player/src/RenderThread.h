@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <functional>
+
 #include <QtCore/QElapsedTimer>
 
 #include <GenericThread.h>
@@ -22,6 +24,8 @@
 #include <gpu/vk/VKBackend.h>
 #endif
 
+#include "FrameBenchmark.h"
+
 class RenderThread : public GenericThread {
     using Parent = GenericThread;
 public:
@@ -58,6 +62,8 @@ public:
     void move(const glm::vec3& v);
     glm::mat4 _correction;
     gpu::PipelinePointer _presentPipeline;
+    std::shared_ptr<FrameBenchmark> _benchmark;
+    std::function<void()> _benchmarkDone;
 
     void resize(const QSize& newSize);
     void setup() override;
@@ -67,4 +73,8 @@ public:
     void submitFrame(const gpu::FramePointer& frame);
     void initialize(QWindow* window);
     void renderFrame(gpu::FramePointer& frame);
+
+    // replays the benchmark's frames in place of the active one, then calls onDone on the render thread
+    void startBenchmark(const std::shared_ptr<FrameBenchmark>& benchmark, const std::function<void()>& onDone);
+    FrameBenchmark::Timing benchmarkFrame(const gpu::FramePointer& frame);
 };
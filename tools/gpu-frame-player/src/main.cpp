@@ -7,6 +7,7 @@
 //
 
 #include <QtWidgets/QApplication>
+#include <QtCore/QCommandLineParser>
 #include <QtCore/QSharedPointer>
 
 #include <shared/FileLogger.h>
@@ -29,7 +30,22 @@ int main(int argc, char** argv) {
     QApplication app(argc, argv);
     logger.reset(new FileLogger());
     setup();
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+    QCommandLineOption benchmarkOption("benchmark", "Replay every frame in <dir> and report the timings", "dir");
+    QCommandLineOption iterationsOption("iterations", "Times to replay each frame when benchmarking", "count", "100");
+    QCommandLineOption outputOption("output", "File the benchmark's results are written to", "file", "benchmark.json");
+    QCommandLineOption baselineOption("baseline", "Earlier benchmark results to compare against", "file");
+    QCommandLineOption thresholdOption("threshold", "Percent slower than the baseline that fails the benchmark", "percent", "10");
+    parser.addOptions({ benchmarkOption, iterationsOption, outputOption, baselineOption, thresholdOption });
+    parser.process(app);
+
     PlayerWindow window;
-    app.exec();
-    return 0;
+    if (parser.isSet(benchmarkOption)) {
+        window.runBenchmark(parser.value(benchmarkOption), std::max(1u, parser.value(iterationsOption).toUInt()),
+                            parser.value(outputOption), parser.value(baselineOption),
+                            parser.value(thresholdOption).toFloat());
+    }
+    return app.exec();
 }
@@ -22,6 +22,8 @@
 #include <LimitedNodeList.h>
 #include <NetworkLogging.h>
 
+#include "ICELoadGenerator.h"
+
 ICEClientApp::ICEClientApp(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
 {
@@ -47,6 +49,21 @@ ICEClientApp::ICEClientApp(int argc, char* argv[]) :
     const QCommandLineOption cacheSTUNOption("s", "cache stun-server response");
     parser.addOption(cacheSTUNOption);
 
+    const QCommandLineOption loadHeartbeatsOption("load-heartbeats",
+        "benchmark the ice-server, sending this many heartbeats per second", "per-second");
+    parser.addOption(loadHeartbeatsOption);
+
+    const QCommandLineOption loadQueriesOption("load-queries",
+        "benchmark the ice-server, sending this many queries per second (for the -d domain, if given)", "per-second");
+    parser.addOption(loadQueriesOption);
+
+    const QCommandLineOption loadDomainsOption("load-domains", "how many domains the benchmark heartbeats are from",
+                                               "count", "1000");
+    parser.addOption(loadDomainsOption);
+
+    const QCommandLineOption loadSecondsOption("load-seconds", "how long to run the benchmark for", "seconds", "30");
+    parser.addOption(loadSecondsOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << Qt::endl;
         parser.showHelp();
@@ -107,6 +124,15 @@ ICEClientApp::ICEClientApp(int argc, char* argv[]) :
         qDebug() << "ICE-server address is" << _iceServerAddr;
     }
 
+    if (parser.isSet(loadHeartbeatsOption) || parser.isSet(loadQueriesOption)) {
+        auto loadGenerator = new ICELoadGenerator(_iceServerAddr, parser.value(loadDomainsOption).toInt(),
+                                                  parser.value(loadHeartbeatsOption).toInt(),
+                                                  parser.value(loadQueriesOption).toInt(), _domainID, this);
+        connect(loadGenerator, &ICELoadGenerator::finished, this, &QCoreApplication::quit);
+        loadGenerator->start(parser.value(loadSecondsOption).toInt());
+        return;
+    }
+
     setState(lookUpStunServer);
 
     QTimer* doTimer = new QTimer(this);
@@ -0,0 +1,146 @@
+//
+//  ICELoadGenerator.cpp
+//  tools/ice-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ICELoadGenerator.h"
+
+#include <algorithm>
+
+#include <QDataStream>
+#include <QRandomGenerator>
+
+#include <NLPacket.h>
+#include <NumericalConstants.h>
+
+// packets are sent this often, as many at a time as the rates call for
+static const int SEND_INTERVAL_MSECS = 5;
+static const int REPORT_INTERVAL_MSECS = 1000;
+
+// the size of a domain-server's signature
+static const int HEARTBEAT_SIGNATURE_SIZE = 256;
+
+ICELoadGenerator::ICELoadGenerator(const SockAddr& iceServerAddr, int numDomains, int heartbeatsPerSecond,
+                                   int queriesPerSecond, const QUuid& queryDomainID, QObject* parent) :
+    QObject(parent),
+    _iceServerAddr(iceServerAddr),
+    _queryDomainID(queryDomainID),
+    _heartbeatsPerSecond(heartbeatsPerSecond),
+    _queriesPerSecond(queriesPerSecond)
+{
+    _socket.bind(SocketType::UDP, QHostAddress::AnyIPv4, 0);
+    _socket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) { processPacket(std::move(packet)); });
+
+    _localSockAddr = SockAddr(SocketType::UDP, "127.0.0.1", _socket.localPort(SocketType::UDP));
+    _publicSockAddr = _localSockAddr;
+
+    _domainIDs.reserve(std::max(numDomains, 1));
+    for (int i = 0; i < std::max(numDomains, 1); ++i) {
+        _domainIDs.push_back(QUuid::createUuid());
+    }
+
+    _signature.resize(HEARTBEAT_SIGNATURE_SIZE);
+    QRandomGenerator::global()->fillRange(reinterpret_cast<quint32*>(_signature.data()),
+                                          HEARTBEAT_SIGNATURE_SIZE / (int)sizeof(quint32));
+
+    connect(&_sendTimer, &QTimer::timeout, this, &ICELoadGenerator::sendPackets);
+    connect(&_reportTimer, &QTimer::timeout, this, &ICELoadGenerator::report);
+}
+
+void ICELoadGenerator::start(int durationSeconds) {
+    qDebug() << "Sending" << _heartbeatsPerSecond << "heartbeats/s from" << _domainIDs.size() << "domains and"
+             << _queriesPerSecond << "queries/s to" << _iceServerAddr;
+
+    _durationMsecs = (qint64)durationSeconds * MSECS_PER_SECOND;
+    _sinceStart.start();
+    _sinceLastSend.start();
+    _sinceLastReport.start();
+
+    _sendTimer.setTimerType(Qt::PreciseTimer);
+    _sendTimer.start(SEND_INTERVAL_MSECS);
+    _reportTimer.start(REPORT_INTERVAL_MSECS);
+}
+
+void ICELoadGenerator::sendPackets() {
+    // the rates are kept to whatever the timer's actual interval was
+    float seconds = (float)_sinceLastSend.restart() / MSECS_PER_SECOND;
+    _heartbeatsOwed += _heartbeatsPerSecond * seconds;
+    _queriesOwed += _queriesPerSecond * seconds;
+
+    udt::Socket::SendBatch batch(_socket);
+
+    for (; _heartbeatsOwed >= 1.0f; _heartbeatsOwed -= 1.0f) {
+        const auto& domainID = _domainIDs[_nextDomain++ % _domainIDs.size()];
+
+        auto packet = NLPacket::create(PacketType::ICEServerHeartbeat);
+        QDataStream packetStream(packet.get());
+        packetStream << domainID << _publicSockAddr << _localSockAddr << _signature;
+        _socket.writePacket(*packet, _iceServerAddr);
+
+        ++_interval.heartbeatsSent;
+    }
+
+    for (; _queriesOwed >= 1.0f; _queriesOwed -= 1.0f) {
+        const auto& domainID = _queryDomainID.isNull() ? _domainIDs[_nextDomain++ % _domainIDs.size()] : _queryDomainID;
+
+        auto packet = NLPacket::create(PacketType::ICEServerQuery);
+        QDataStream packetStream(packet.get());
+        packetStream << QUuid::createUuid() << _publicSockAddr << _localSockAddr << domainID;
+        _socket.writePacket(*packet, _iceServerAddr);
+
+        ++_interval.queriesSent;
+    }
+}
+
+void ICELoadGenerator::processPacket(std::unique_ptr<udt::Packet> packet) {
+    switch (NLPacket::typeInHeader(*packet)) {
+        case PacketType::ICEServerHeartbeatACK:
+            ++_interval.heartbeatACKs;
+            break;
+        case PacketType::ICEServerHeartbeatDenied:
+            ++_interval.heartbeatDenials;
+            break;
+        case PacketType::ICEServerPeerInformation:
+            ++_interval.peerInformations;
+            break;
+        default:
+            break;
+    }
+}
+
+void ICELoadGenerator::report() {
+    float seconds = (float)_sinceLastReport.restart() / MSECS_PER_SECOND;
+    printCounts("last second", _interval, seconds);
+
+    _total.heartbeatsSent += _interval.heartbeatsSent;
+    _total.queriesSent += _interval.queriesSent;
+    _total.heartbeatACKs += _interval.heartbeatACKs;
+    _total.heartbeatDenials += _interval.heartbeatDenials;
+    _total.peerInformations += _interval.peerInformations;
+    _interval = Counts();
+
+    if (_durationMsecs > 0 && _sinceStart.elapsed() >= _durationMsecs) {
+        _sendTimer.stop();
+        _reportTimer.stop();
+        printCounts("total", _total, (float)_sinceStart.elapsed() / MSECS_PER_SECOND);
+        emit finished();
+    }
+}
+
+void ICELoadGenerator::printCounts(const char* label, const Counts& counts, float seconds) {
+    seconds = std::max(seconds, 0.001f);
+    auto heartbeatReplies = counts.heartbeatACKs + counts.heartbeatDenials;
+    qDebug().noquote() << QString("%1: sent %2 heartbeats/s, %3 queries/s - answered %4 heartbeats/s (%5%), %6 queries/s")
+        .arg(label)
+        .arg(counts.heartbeatsSent / seconds, 0, 'f', 0)
+        .arg(counts.queriesSent / seconds, 0, 'f', 0)
+        .arg(heartbeatReplies / seconds, 0, 'f', 0)
+        .arg(counts.heartbeatsSent > 0 ? 100.0f * heartbeatReplies / counts.heartbeatsSent : 0.0f, 0, 'f', 1)
+        .arg(counts.peerInformations / seconds, 0, 'f', 0);
+}
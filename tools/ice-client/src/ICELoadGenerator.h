@@ -0,0 +1,82 @@
+//
+//  ICELoadGenerator.h
+//  tools/ice-client/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_ICELoadGenerator_h
+#define hifi_ICELoadGenerator_h
+
+#include <vector>
+
+#include <QObject>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QUuid>
+
+#include <udt/Socket.h>
+
+/// Sends heartbeats and queries to an ICE server at a steady rate and reports how many it answers, to benchmark it.
+///
+/// The heartbeats are from made up domains with keys the metaverse doesn't know, so they measure the path that denies
+/// them. Queries are for the made up domains too, which go unanswered, unless they are for a live domain.
+class ICELoadGenerator : public QObject {
+    Q_OBJECT
+public:
+    ICELoadGenerator(const SockAddr& iceServerAddr, int numDomains, int heartbeatsPerSecond, int queriesPerSecond,
+                     const QUuid& queryDomainID, QObject* parent = nullptr);
+
+    void start(int durationSeconds);
+
+signals:
+    void finished();
+
+private slots:
+    void sendPackets();
+    void report();
+
+private:
+    void processPacket(std::unique_ptr<udt::Packet> packet);
+
+    struct Counts {
+        quint64 heartbeatsSent { 0 };
+        quint64 queriesSent { 0 };
+        quint64 heartbeatACKs { 0 };
+        quint64 heartbeatDenials { 0 };
+        quint64 peerInformations { 0 };
+    };
+
+    void printCounts(const char* label, const Counts& counts, float seconds);
+
+    SockAddr _iceServerAddr;
+    SockAddr _publicSockAddr;
+    SockAddr _localSockAddr;
+    udt::Socket _socket;
+
+    std::vector<QUuid> _domainIDs;
+    QUuid _queryDomainID;
+    QByteArray _signature;
+
+    int _heartbeatsPerSecond;
+    int _queriesPerSecond;
+    float _heartbeatsOwed { 0.0f };
+    float _queriesOwed { 0.0f };
+    size_t _nextDomain { 0 };
+
+    QTimer _sendTimer;
+    QTimer _reportTimer;
+    QElapsedTimer _sinceStart;
+    QElapsedTimer _sinceLastSend;
+    QElapsedTimer _sinceLastReport;
+    qint64 _durationMsecs { 0 };
+
+    Counts _total;
+    Counts _interval;
+};
+
+#endif // hifi_ICELoadGenerator_h
@@ -0,0 +1,687 @@
+//
+//  MixerBenchApp.cpp
+//  tools/mixer-bench/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MixerBenchApp.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+
+#include <glm/gtc/quaternion.hpp>
+
+#include <AddressManager.h>
+#include <AudioConstants.h>
+#include <AvatarData.h>
+#include <DependencyManager.h>
+#include <EntityTree.h>
+#include <MemoryAccounting.h>
+#include <NLPacket.h>
+#include <NodeList.h>
+#include <NumericalConstants.h>
+#include <PortableHighResolutionClock.h>
+#include <ReceivedMessage.h>
+#include <SharedUtil.h>
+#include <ViewFrustum.h>
+#include <plugins/CodecPlugin.h>
+#include <plugins/PluginManager.h>
+#include <shared/ConicalViewFrustum.h>
+
+#include "audio/AudioMixerClientData.h"
+#include "audio/AudioMixerSlave.h"
+#include "avatars/AvatarMixerClientData.h"
+#include "avatars/AvatarMixerSlave.h"
+
+namespace {
+    const quint16 FIRST_CLIENT_PORT = 40000;
+    const float TONE_AMPLITUDE = 3000.0f;
+    const float MAX_KBPS_PER_NODE = 5000.0f;
+    const float AVATAR_HERO_FRACTION = 0.4f;
+
+    // what the mixers send is only counted, from whichever thread sends it
+    std::atomic<quint64> bytesSent { 0 };
+    std::atomic<quint64> datagramsSent { 0 };
+
+    double mean(const std::vector<quint64>& values) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        double sum = 0.0;
+        for (auto value : values) {
+            sum += (double)value;
+        }
+        return sum / (double)values.size();
+    }
+
+    double percentile(std::vector<quint64> values, double fraction) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        size_t index = std::min(values.size() - 1, (size_t)(fraction * (double)(values.size() - 1) + 0.5));
+        return (double)values[index];
+    }
+
+    // makes the packet into what the mixer would have received from the node
+    QSharedPointer<ReceivedMessage> receive(NLPacket& packet, const Node& node) {
+        packet.writeSourceID(node.getLocalID());
+        packet.seek(0);
+        return QSharedPointer<ReceivedMessage>::create(packet);
+    }
+
+    void writeIDs(NLPacket& packet, const std::vector<QUuid>& ids) {
+        for (const auto& id : ids) {
+            packet.write(id.toRfc4122());
+        }
+    }
+}
+
+MixerBenchApp::MixerBenchApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Audio and Avatar Mixer Benchmark");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption mixerOption("mixer", "the mixers to run: audio, avatar or both", "mixer", "both");
+    parser.addOption(mixerOption);
+    const QCommandLineOption listenersOption("listeners", "number of listening clients", "count", "50");
+    parser.addOption(listenersOption);
+    const QCommandLineOption sourcesOption("sources", "number of speaking or moving clients", "count", "50");
+    parser.addOption(sourcesOption);
+    const QCommandLineOption framesOption("frames", "number of measured frames", "count", "500");
+    parser.addOption(framesOption);
+    const QCommandLineOption warmupOption("warmup", "number of frames run before measuring", "count", "50");
+    parser.addOption(warmupOption);
+    const QCommandLineOption spreadOption("spread", "size of the area the clients are placed in, in meters", "meters", "20");
+    parser.addOption(spreadOption);
+    const QCommandLineOption layoutOption("layout", "how the clients are placed: random or grid", "layout", "random");
+    parser.addOption(layoutOption);
+    const QCommandLineOption codecOption("codec", "the audio codec the clients use, raw PCM if not set", "name");
+    parser.addOption(codecOption);
+    const QCommandLineOption ignoreOption("ignore", "fraction of the sources each listener ignores", "fraction", "0");
+    parser.addOption(ignoreOption);
+    const QCommandLineOption soloOption("solo", "number of sources each listener soloes", "count", "0");
+    parser.addOption(soloOption);
+    const QCommandLineOption jointsOption("joints", "number of joints animated on each avatar", "count", "50");
+    parser.addOption(jointsOption);
+    const QCommandLineOption seedOption("seed", "seed of the client placement and choices", "seed", "1");
+    parser.addOption(seedOption);
+    const QCommandLineOption jsonOption("json", "write the report to a JSON file", "filename.json");
+    parser.addOption(jsonOption);
+    const QCommandLineOption baselineOption("baseline", "compare with a report from an earlier run", "filename.json");
+    parser.addOption(baselineOption);
+    const QCommandLineOption toleranceOption("tolerance", "percent a result may be worse than the baseline", "percent", "10");
+    parser.addOption(toleranceOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QString mixer = parser.value(mixerOption);
+    if (mixer != "audio" && mixer != "avatar" && mixer != "both") {
+        qCritical() << "Unknown mixer" << mixer;
+        _returnCode = 1;
+        return;
+    }
+
+    _config.numListeners = std::max(0, parser.value(listenersOption).toInt());
+    _config.numSources = std::max(0, parser.value(sourcesOption).toInt());
+    _config.numFrames = std::max(1, parser.value(framesOption).toInt());
+    _config.numWarmupFrames = std::max(0, parser.value(warmupOption).toInt());
+    _config.spread = parser.value(spreadOption).toFloat();
+    _config.grid = parser.value(layoutOption) == "grid";
+    _config.codecName = parser.value(codecOption);
+    _config.ignoreFraction = glm::clamp(parser.value(ignoreOption).toFloat(), 0.0f, 1.0f);
+    _config.numSoloed = std::max(0, parser.value(soloOption).toInt());
+    _config.numJoints = std::max(0, parser.value(jointsOption).toInt());
+    _config.seed = parser.value(seedOption).toUInt();
+
+    // the mixers find each other's data through the node list, whose sends never reach the network
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<AddressManager>();
+    auto nodeList = DependencyManager::set<NodeList>(NodeType::AudioMixer);
+    nodeList->setOutboundDatagramSink([](const char* data, qint64 size, const SockAddr& sockAddr) {
+        bytesSent += size;
+        ++datagramsSent;
+    });
+
+    std::vector<Result> results;
+    if (mixer != "avatar") {
+        results.push_back(runAudioMixer());
+        if (_returnCode != 0) {
+            return;
+        }
+    }
+    if (mixer != "audio") {
+        results.push_back(runAvatarMixer());
+    }
+
+    QJsonObject config;
+    config["listeners"] = _config.numListeners;
+    config["sources"] = _config.numSources;
+    config["frames"] = _config.numFrames;
+    config["warmup"] = _config.numWarmupFrames;
+    config["spread"] = _config.spread;
+    config["layout"] = _config.grid ? "grid" : "random";
+    config["codec"] = _config.codecName;
+    config["ignore"] = _config.ignoreFraction;
+    config["solo"] = _config.numSoloed;
+    config["joints"] = _config.numJoints;
+    config["seed"] = (qint64)_config.seed;
+
+    QJsonObject mixerReports;
+    for (const auto& result : results) {
+        mixerReports[result.mixer] = report(result);
+    }
+    QJsonObject fullReport;
+    fullReport["config"] = config;
+    fullReport["results"] = mixerReports;
+
+    if (parser.isSet(jsonOption)) {
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly)) {
+            qCritical() << "Failed to write report" << file.fileName();
+            _returnCode = 2;
+            return;
+        }
+        file.write(QJsonDocument(fullReport).toJson());
+    }
+
+    if (parser.isSet(baselineOption)) {
+        QFile file(parser.value(baselineOption));
+        if (!file.open(QIODevice::ReadOnly)) {
+            qCritical() << "Failed to read baseline" << file.fileName();
+            _returnCode = 2;
+            return;
+        }
+        QJsonObject baseline = QJsonDocument::fromJson(file.readAll()).object();
+        if (baseline["config"].toObject() != config) {
+            qWarning() << "The baseline was run with a different configuration, the comparison may not mean much";
+        }
+        if (!compareWithBaseline(mixerReports, baseline["results"].toObject(), parser.value(toleranceOption).toFloat())) {
+            _returnCode = 4;
+        }
+    }
+}
+
+MixerBenchApp::~MixerBenchApp() {
+    DependencyManager::destroy<NodeList>();
+    DependencyManager::destroy<AddressManager>();
+}
+
+std::vector<glm::vec3> MixerBenchApp::generatePositions() {
+    int numNodes = std::max(_config.numListeners, _config.numSources);
+    std::vector<glm::vec3> positions;
+    positions.reserve(numNodes);
+
+    if (_config.grid) {
+        int side = std::max(1, (int)std::ceil(std::sqrt((float)numNodes)));
+        float step = side > 1 ? _config.spread / (float)(side - 1) : 0.0f;
+        for (int i = 0; i < numNodes; ++i) {
+            positions.push_back(glm::vec3((float)(i % side) * step, 0.0f, (float)(i / side) * step) -
+                                glm::vec3(0.5f * _config.spread, 0.0f, 0.5f * _config.spread));
+        }
+    } else {
+        std::mt19937 generator(_config.seed);
+        std::uniform_real_distribution<float> distribution(-0.5f * _config.spread, 0.5f * _config.spread);
+        for (int i = 0; i < numNodes; ++i) {
+            float x = distribution(generator);
+            float z = distribution(generator);
+            positions.push_back(glm::vec3(x, 0.0f, z));
+        }
+    }
+    return positions;
+}
+
+std::vector<SharedNodePointer> MixerBenchApp::createNodes() {
+    auto nodeList = DependencyManager::get<NodeList>();
+    nodeList->eraseAllNodes("mixer-bench run");
+
+    int numNodes = std::max(_config.numListeners, _config.numSources);
+    std::vector<SharedNodePointer> nodes;
+    nodes.reserve(numNodes);
+    for (int i = 0; i < numNodes; ++i) {
+        SockAddr address(SocketType::UDP, QHostAddress::LocalHost, FIRST_CLIENT_PORT + (quint16)i);
+        auto node = nodeList->addOrUpdateNode(QUuid::createUuid(), NodeType::Agent, address, address,
+                                              (Node::LocalID)(i + 1));
+        // only the listeners are sent anything, the mixers skip nodes they have no socket for
+        if (i < _config.numListeners) {
+            node->activatePublicSocket();
+        }
+        nodes.push_back(node);
+    }
+    return nodes;
+}
+
+std::vector<std::vector<QUuid>> MixerBenchApp::chooseSources(const std::vector<SharedNodePointer>& nodes,
+                                                             float fraction, int count) {
+    // each listener picks its own set of the other sources
+    std::mt19937 generator(_config.seed + (unsigned int)count + (unsigned int)(fraction * 1000.0f));
+    std::vector<std::vector<QUuid>> chosen(_config.numListeners);
+    for (int i = 0; i < _config.numListeners; ++i) {
+        std::vector<QUuid> candidates;
+        for (int j = 0; j < _config.numSources; ++j) {
+            if (j != i) {
+                candidates.push_back(nodes[j]->getUUID());
+            }
+        }
+        std::shuffle(candidates.begin(), candidates.end(), generator);
+        size_t numChosen = std::min(candidates.size(), (size_t)(count + std::lround(fraction * (float)candidates.size())));
+        chosen[i].assign(candidates.begin(), candidates.begin() + numChosen);
+    }
+    return chosen;
+}
+
+MixerBenchApp::Result MixerBenchApp::runAudioMixer() {
+    Result result;
+    result.mixer = "audio";
+
+    CodecPluginPointer codec;
+    if (!_config.codecName.isEmpty()) {
+        // same as the mixer, only the codec plugins are loaded
+        auto pluginManager = DependencyManager::set<PluginManager>();
+        pluginManager->setPluginFilter([](const QJsonObject& metaData) {
+            QJsonValue nameValue = metaData["MetaData"]["name"];
+            return nameValue.toString().contains("codec", Qt::CaseInsensitive);
+        });
+        for (const auto& codecPlugin : pluginManager->getCodecPlugins()) {
+            if (codecPlugin->getName() == _config.codecName) {
+                codec = codecPlugin;
+            }
+        }
+        if (!codec) {
+            qCritical() << "Codec" << _config.codecName << "wasn't found in the plugins";
+            _returnCode = 3;
+            return result;
+        }
+    }
+    QString codecName = codec ? _config.codecName : QString("pcm");
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto positions = generatePositions();
+    auto nodes = createNodes();
+
+    std::vector<Encoder*> encoders(nodes.size(), nullptr);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto& node = nodes[i];
+        auto data = new AudioMixerClientData(node->getUUID(), node->getLocalID());
+        node->setLinkedData(std::unique_ptr<NodeData>(data));
+        if (codec) {
+            data->setupCodec(codec, codecName);
+            if ((int)i < _config.numSources) {
+                encoders[i] = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
+            }
+        }
+    }
+
+    AudioMixerSlave::SharedData sharedData;
+    AudioMixerSlave slave(sharedData);
+    AudioMixerStats stats;
+
+    const glm::vec3 BOUNDING_BOX_SCALE(0.5f, 1.8f, 0.5f);
+    QByteArray samples(AudioConstants::NETWORK_FRAME_BYTES_PER_CHANNEL, 0);
+    QByteArray encodedSamples;
+    quint16 sequence = 0;
+
+    int numFrames = _config.numWarmupFrames + _config.numFrames;
+    for (int frame = 0; frame < numFrames; ++frame) {
+        if (frame == _config.numWarmupFrames) {
+            bytesSent = 0;
+            datagramsSent = 0;
+        }
+
+        // the clients' packets for the frame, made outside of what's measured
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            auto& node = nodes[i];
+            auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+            bool isSource = (int)i < _config.numSources;
+
+            auto packet = NLPacket::create(isSource ? PacketType::MicrophoneAudioNoEcho : PacketType::SilentAudioFrame);
+            packet->writePrimitive(sequence);
+            packet->writeString(codecName);
+            if (isSource) {
+                packet->writePrimitive((quint8)0);
+            } else {
+                packet->writePrimitive((quint16)AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            }
+            packet->writePrimitive(positions[i]);
+            packet->writePrimitive(glm::quat());
+            packet->writePrimitive(positions[i] - 0.5f * BOUNDING_BOX_SCALE);
+            packet->writePrimitive(BOUNDING_BOX_SCALE);
+
+            if (isSource) {
+                // a steady tone of its own for each source
+                auto sampleData = reinterpret_cast<int16_t*>(samples.data());
+                float frequency = 220.0f + 20.0f * (float)i;
+                for (int s = 0; s < AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL; ++s) {
+                    float t = (float)(frame * AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL + s) / AudioConstants::SAMPLE_RATE;
+                    sampleData[s] = (int16_t)(TONE_AMPLITUDE * std::sin(TWO_PI * frequency * t));
+                }
+                if (encoders[i]) {
+                    encoders[i]->encode(samples, encodedSamples);
+                    packet->write(encodedSamples);
+                } else {
+                    packet->write(samples);
+                }
+            }
+            data->queuePacket(receive(*packet, *node), node);
+        }
+        ++sequence;
+
+        uint64_t allocationsBefore = MemoryAccounting::getNumAllocations();
+        quint64 start = usecTimestampNow();
+
+        sharedData.addedStreams.clear();
+        nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+            sharedData.downstreamMixers.clear();
+            std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+                slave.processPackets(node);
+            });
+        });
+
+        quint64 processed = usecTimestampNow();
+
+        sharedData.removedNodes.clear();
+        sharedData.removedStreams.clear();
+        sharedData.mixClusterCache.clear();
+        sharedData.encodeCache.clear();
+        slave.resetFrameArena();
+        nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+            slave.configureMix(cbegin, cend, (unsigned int)frame + 1, -1);
+            std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+                slave.mix(node);
+            });
+        });
+
+        quint64 mixed = usecTimestampNow();
+        uint64_t allocations = MemoryAccounting::getNumAllocations() - allocationsBefore;
+
+        if (frame >= _config.numWarmupFrames) {
+            result.processUsecs.push_back(processed - start);
+            result.mixUsecs.push_back(mixed - processed);
+            result.allocations.push_back(allocations);
+            stats.accumulate(slave.stats);
+        }
+        slave.stats.reset();
+
+        if (frame == 0) {
+            // the streams exist once the first packets are processed, so requests about them can be made
+            auto ignored = chooseSources(nodes, _config.ignoreFraction, 0);
+            auto soloed = chooseSources(nodes, 0.0f, _config.numSoloed);
+            for (int i = 0; i < _config.numListeners; ++i) {
+                auto& node = nodes[i];
+                auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+                if (!ignored[i].empty()) {
+                    auto packet = NLPacket::create(PacketType::NodeIgnoreRequest);
+                    packet->writePrimitive(true);
+                    writeIDs(*packet, ignored[i]);
+                    data->parseNodeIgnoreRequest(receive(*packet, *node), node);
+                }
+                if (!soloed[i].empty()) {
+                    auto packet = NLPacket::create(PacketType::AudioSoloRequest);
+                    packet->writePrimitive((uint8_t)1);
+                    writeIDs(*packet, soloed[i]);
+                    data->parseSoloRequest(receive(*packet, *node), node);
+                }
+            }
+        }
+    }
+    result.bytesSent = bytesSent;
+    result.datagramsSent = datagramsSent;
+
+    for (size_t i = 0; i < encoders.size(); ++i) {
+        if (encoders[i]) {
+            codec->releaseEncoder(encoders[i]);
+        }
+    }
+    nodeList->eraseAllNodes("mixer-bench run done");
+
+    double numMeasuredFrames = (double)_config.numFrames;
+    result.stats["streams"] = stats.sumStreams / numMeasuredFrames;
+    result.stats["listeners"] = stats.sumListeners / numMeasuredFrames;
+    result.stats["active"] = stats.active / numMeasuredFrames;
+    result.stats["inactive"] = stats.inactive / numMeasuredFrames;
+    result.stats["skipped"] = stats.skipped / numMeasuredFrames;
+    result.stats["hrtfRenders"] = stats.hrtfRenders / numMeasuredFrames;
+    result.stats["hrtfUpdates"] = stats.hrtfUpdates / numMeasuredFrames;
+    result.stats["clusterHits"] = stats.clusterHits / numMeasuredFrames;
+    result.stats["clusterMisses"] = stats.clusterMisses / numMeasuredFrames;
+    result.stats["farFieldMixes"] = stats.farFieldMixes / numMeasuredFrames;
+    result.stats["encodes"] = stats.encodes / numMeasuredFrames;
+    result.stats["encodeCacheHits"] = stats.encodeCacheHits / numMeasuredFrames;
+    result.stats["arenaAllocations"] = stats.arenaAllocations / numMeasuredFrames;
+    return result;
+}
+
+MixerBenchApp::Result MixerBenchApp::runAvatarMixer() {
+    Result result;
+    result.mixer = "avatar";
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    auto positions = generatePositions();
+    auto nodes = createNodes();
+
+    // the mixer looks up the zones the avatars move into
+    SlaveSharedData sharedData;
+    sharedData.entityTree = std::make_shared<EntityTree>();
+    sharedData.entityTree->createRootElement();
+    AvatarMixerSlave slave(&sharedData);
+    AvatarMixerSlaveStats stats;
+
+    // each client's own avatar, which it encodes and sends like the interface does
+    std::vector<std::unique_ptr<AvatarData>> clientAvatars;
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        auto& node = nodes[i];
+        node->setLinkedData(std::unique_ptr<NodeData>(new AvatarMixerClientData(node->getUUID(), node->getLocalID())));
+
+        std::unique_ptr<AvatarData> avatar(new AvatarData());
+        avatar->setSessionUUID(node->getUUID());
+        avatar->setWorldPosition(positions[i]);
+        for (int j = 0; j < _config.numJoints; ++j) {
+            avatar->setJointData(j, glm::quat(), glm::vec3(0.0f));
+        }
+        clientAvatars.push_back(std::move(avatar));
+    }
+
+    // the listeners look toward the middle of the area, with the interface's default frustum
+    for (int i = 0; i < _config.numListeners; ++i) {
+        ViewFrustum viewFrustum;
+        viewFrustum.setPosition(positions[i]);
+        glm::vec3 direction = -positions[i];
+        direction.y = 0.0f;
+        if (glm::length(direction) > 0.0f) {
+            viewFrustum.setOrientation(glm::quatLookAt(glm::normalize(direction), Vectors::UP));
+        }
+        viewFrustum.setProjection(DEFAULT_FIELD_OF_VIEW_DEGREES, 16.0f / 9.0f, DEFAULT_NEAR_CLIP, DEFAULT_FAR_CLIP);
+        viewFrustum.calculate();
+
+        QByteArray frustums(1 + 1024, 0);
+        auto buffer = reinterpret_cast<unsigned char*>(frustums.data());
+        buffer[0] = 1;
+        int size = ConicalViewFrustum(viewFrustum).serialize(buffer + 1);
+        frustums.resize(1 + size);
+        static_cast<AvatarMixerClientData*>(nodes[i]->getLinkedData())->readViewFrustumPacket(frustums);
+    }
+
+    auto ignored = chooseSources(nodes, _config.ignoreFraction, 0);
+    for (int i = 0; i < _config.numListeners; ++i) {
+        for (const auto& id : ignored[i]) {
+            nodes[i]->addIgnoredNode(id);
+        }
+    }
+
+    auto lastFrameTimestamp = p_high_resolution_clock::now();
+    quint16 sequence = 0;
+
+    int numFrames = _config.numWarmupFrames + _config.numFrames;
+    for (int frame = 0; frame < numFrames; ++frame) {
+        if (frame == _config.numWarmupFrames) {
+            bytesSent = 0;
+            datagramsSent = 0;
+        }
+
+        // the sources move their joints every frame, everyone else sends their avatar once
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            if ((int)i >= _config.numSources && frame > 0) {
+                continue;
+            }
+            auto& avatar = clientAvatars[i];
+            for (int j = 0; j < _config.numJoints; ++j) {
+                float angle = 0.3f * std::sin(0.05f * (float)frame + 0.7f * (float)j + (float)i);
+                avatar->setJointData(j, glm::angleAxis(angle, Vectors::UNIT_X), glm::vec3(0.0f));
+            }
+            QByteArray avatarBytes = avatar->toByteArrayStateful(AvatarData::CullSmallData);
+            avatar->doneEncoding(true);
+
+            auto packet = NLPacket::create(PacketType::AvatarData, sizeof(quint16) + avatarBytes.size());
+            packet->writePrimitive(sequence);
+            packet->write(avatarBytes);
+
+            auto& node = nodes[i];
+            static_cast<AvatarMixerClientData*>(node->getLinkedData())->queuePacket(receive(*packet, *node), node);
+        }
+        ++sequence;
+
+        uint64_t allocationsBefore = MemoryAccounting::getNumAllocations();
+        quint64 start = usecTimestampNow();
+
+        nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+            slave.configure(cbegin, cend);
+            std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+                slave.processIncomingPackets(node);
+            });
+        });
+
+        quint64 processed = usecTimestampNow();
+
+        nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+            slave.configureBroadcast(cbegin, cend, lastFrameTimestamp, MAX_KBPS_PER_NODE, 0.0f, AVATAR_HERO_FRACTION);
+            std::for_each(cbegin, cend, [&](const SharedNodePointer& node) {
+                slave.broadcastAvatarData(node);
+            });
+        });
+
+        quint64 broadcasted = usecTimestampNow();
+        uint64_t allocations = MemoryAccounting::getNumAllocations() - allocationsBefore;
+        lastFrameTimestamp = p_high_resolution_clock::now();
+
+        AvatarMixerSlaveStats frameStats;
+        slave.harvestStats(frameStats);
+        if (frame >= _config.numWarmupFrames) {
+            result.processUsecs.push_back(processed - start);
+            result.mixUsecs.push_back(broadcasted - processed);
+            result.allocations.push_back(allocations);
+            stats += frameStats;
+        }
+    }
+    result.bytesSent = bytesSent;
+    result.datagramsSent = datagramsSent;
+
+    nodeList->eraseAllNodes("mixer-bench run done");
+
+    double numMeasuredFrames = (double)_config.numFrames;
+    result.stats["packetsProcessed"] = stats.packetsProcessed / numMeasuredFrames;
+    result.stats["nodesBroadcastedTo"] = stats.nodesBroadcastedTo / numMeasuredFrames;
+    result.stats["othersIncluded"] = stats.numOthersIncluded / numMeasuredFrames;
+    result.stats["candidatesConsidered"] = stats.numCandidatesConsidered / numMeasuredFrames;
+    result.stats["overBudgetAvatars"] = stats.overBudgetAvatars / numMeasuredFrames;
+    result.stats["dataBytesSent"] = stats.numDataBytesSent / numMeasuredFrames;
+    result.stats["identityBytesSent"] = stats.numIdentityBytesSent / numMeasuredFrames;
+    result.stats["traitsBytesSent"] = stats.numTraitsBytesSent / numMeasuredFrames;
+    result.stats["arenaAllocations"] = (double)stats.numArenaAllocations / numMeasuredFrames;
+    return result;
+}
+
+QJsonObject MixerBenchApp::report(const Result& result) const {
+    std::vector<quint64> frameUsecs(result.processUsecs.size());
+    for (size_t i = 0; i < frameUsecs.size(); ++i) {
+        frameUsecs[i] = result.processUsecs[i] + result.mixUsecs[i];
+    }
+    double numMeasuredFrames = (double)std::max((size_t)1, frameUsecs.size());
+
+    QJsonObject frame;
+    frame["mean"] = mean(frameUsecs);
+    frame["p50"] = percentile(frameUsecs, 0.5);
+    frame["p95"] = percentile(frameUsecs, 0.95);
+    frame["max"] = percentile(frameUsecs, 1.0);
+
+    QJsonObject report;
+    report["frameUsecs"] = frame;
+    report["processUsecs"] = mean(result.processUsecs);
+    report["mixUsecs"] = mean(result.mixUsecs);
+    report["usecsPerListener"] = _config.numListeners > 0 ? mean(frameUsecs) / _config.numListeners : 0.0;
+    report["allocationsPerFrame"] = mean(result.allocations);
+    report["bytesSentPerFrame"] = (double)result.bytesSent / numMeasuredFrames;
+    report["datagramsSentPerFrame"] = (double)result.datagramsSent / numMeasuredFrames;
+    report["stats"] = result.stats;
+
+    qInfo().noquote() << QString("%1 mixer: %2 listeners, %3 sources, %4 frames")
+        .arg(result.mixer).arg(_config.numListeners).arg(_config.numSources).arg(frameUsecs.size());
+    qInfo().noquote() << QString("  frame usecs: mean %1  p50 %2  p95 %3  max %4")
+        .arg(frame["mean"].toDouble(), 0, 'f', 1).arg(frame["p50"].toDouble(), 0, 'f', 0)
+        .arg(frame["p95"].toDouble(), 0, 'f', 0).arg(frame["max"].toDouble(), 0, 'f', 0);
+    qInfo().noquote() << QString("  phases: process %1 usecs  %2 %3 usecs  per listener %4 usecs")
+        .arg(report["processUsecs"].toDouble(), 0, 'f', 1).arg(result.mixer == "audio" ? "mix" : "broadcast")
+        .arg(report["mixUsecs"].toDouble(), 0, 'f', 1).arg(report["usecsPerListener"].toDouble(), 0, 'f', 2);
+    qInfo().noquote() << QString("  per frame: %1 allocations  %2 bytes in %3 datagrams sent")
+        .arg(report["allocationsPerFrame"].toDouble(), 0, 'f', 1).arg(report["bytesSentPerFrame"].toDouble(), 0, 'f', 0)
+        .arg(report["datagramsSentPerFrame"].toDouble(), 0, 'f', 1);
+    QStringList statLines;
+    for (auto it = result.stats.begin(); it != result.stats.end(); ++it) {
+        statLines << QString("%1 %2").arg(it.key()).arg(it.value().toDouble(), 0, 'f', 1);
+    }
+    qInfo().noquote() << "  stats per frame:" << statLines.join("  ");
+
+    return report;
+}
+
+bool MixerBenchApp::compareWithBaseline(const QJsonObject& results, const QJsonObject& baseline, float tolerance) const {
+    bool passed = true;
+    auto check = [&](const QString& mixer, const QString& name, double value, double baselineValue) {
+        // allocations are measured in whole numbers, so a baseline of none allows for none
+        double limit = baselineValue * (1.0 + tolerance / 100.0);
+        bool regressed = value > limit && value - baselineValue >= 0.5;
+        qInfo().noquote() << QString("%1 %2: %3 against %4 in the baseline%5")
+            .arg(mixer).arg(name).arg(value, 0, 'f', 1).arg(baselineValue, 0, 'f', 1).arg(regressed ? "  REGRESSED" : "");
+        if (regressed) {
+            passed = false;
+        }
+    };
+
+    for (auto it = results.begin(); it != results.end(); ++it) {
+        if (!baseline.contains(it.key())) {
+            qWarning() << "The baseline has no results for the" << it.key() << "mixer";
+            continue;
+        }
+        QJsonObject result = it.value().toObject();
+        QJsonObject baselineResult = baseline[it.key()].toObject();
+        check(it.key(), "p50 frame usecs", result["frameUsecs"].toObject()["p50"].toDouble(),
+              baselineResult["frameUsecs"].toObject()["p50"].toDouble());
+        check(it.key(), "allocations per frame", result["allocationsPerFrame"].toDouble(),
+              baselineResult["allocationsPerFrame"].toDouble());
+    }
+    return passed;
+}
@@ -0,0 +1,74 @@
+//
+//  MixerBenchApp.h
+//  tools/mixer-bench/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_MixerBenchApp_h
+#define hifi_MixerBenchApp_h
+
+#include <vector>
+
+#include <QCoreApplication>
+#include <QJsonObject>
+
+#include <glm/glm.hpp>
+
+#include <Node.h>
+
+// Drives the audio and avatar mixer slaves frame by frame over a synthetic population of clients, without a domain or
+// a network: the clients' packets are queued straight into their mixer data, and what the mixers send is counted and
+// dropped. Reports the time of each mixer phase per frame and per listener and the allocations made, and compares
+// them with a baseline report so CI can catch regressions.
+class MixerBenchApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    MixerBenchApp(int argc, char* argv[]);
+    ~MixerBenchApp();
+
+    int getReturnCode() const { return _returnCode; }
+
+    struct Config {
+        int numListeners { 50 };
+        int numSources { 50 };
+        int numFrames { 500 };
+        int numWarmupFrames { 50 };
+        float spread { 20.0f };
+        bool grid { false };
+        QString codecName;
+        float ignoreFraction { 0.0f };
+        int numSoloed { 0 };
+        int numJoints { 50 };
+        unsigned int seed { 1 };
+    };
+
+    struct Result {
+        QString mixer;
+        std::vector<quint64> processUsecs; // the mixer's packet processing phase
+        std::vector<quint64> mixUsecs;     // its mix or broadcast phase
+        std::vector<quint64> allocations;
+        quint64 bytesSent { 0 };
+        quint64 datagramsSent { 0 };
+        QJsonObject stats;
+    };
+
+private:
+    std::vector<glm::vec3> generatePositions();
+    std::vector<SharedNodePointer> createNodes();
+    // for each listener, some of the other sources: the fraction of them plus the count
+    std::vector<std::vector<QUuid>> chooseSources(const std::vector<SharedNodePointer>& nodes, float fraction, int count);
+    Result runAudioMixer();
+    Result runAvatarMixer();
+    QJsonObject report(const Result& result) const;
+    bool compareWithBaseline(const QJsonObject& results, const QJsonObject& baseline, float tolerance) const;
+
+    Config _config;
+    int _returnCode { 0 };
+};
+
+#endif // hifi_MixerBenchApp_h
@@ -0,0 +1,26 @@
+//
+//  main.cpp
+//  tools/mixer-bench/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include <MemoryAccounting.h>
+#include <SharedUtil.h>
+
+#include "MixerBenchApp.h"
+
+// counts the mixers' allocations made through operator new; Qt containers allocate with malloc and aren't counted, and on
+// Windows only the code built into the tool is, which includes the mixers
+MEMORY_ACCOUNTING_HOOKS()
+
+int main(int argc, char* argv[]) {
+    setupHifiApplication("Mixer Bench");
+
+    MixerBenchApp app(argc, argv);
+    return app.getReturnCode();
+}
@@ -11,7 +11,10 @@
 
 #include "DomainBaker.h"
 
+#include <algorithm>
+
 #include <QtConcurrent>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QEventLoop>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
@@ -21,6 +24,26 @@
 #include "Oven.h"
 #include "baking/BakerLibrary.h"
 
+static const QString CONTENT_OUTPUT_FOLDER_NAME = "content";
+static const QString MANIFEST_FILE_NAME = "bake-manifest.jsonl";
+static const QString REPORT_FILE_NAME = "bake-report.json";
+
+// the manifest's first line says what was baked, and each line after it what one finished bake's references became
+static const QString MANIFEST_ENTITIES_HASH_KEY = "entitiesHash";
+static const QString MANIFEST_DESTINATION_PATH_KEY = "destinationPath";
+static const QString MANIFEST_REBAKE_ORIGINALS_KEY = "rebakeOriginals";
+static const QString MANIFEST_CONTENT_KEY = "content";
+static const QString MANIFEST_VALUE_KEY = "value";
+static const QString MANIFEST_IS_URL_KEY = "isURL";
+static const QString MANIFEST_KEEPS_URL_SUFFIX_KEY = "keepsURLSuffix";
+static const QString MANIFEST_COMPLETE_KEY = "complete";
+
+// a model bake can take gigabytes, so only one runs per this many worker threads
+static const int WORKER_THREADS_PER_MODEL_BAKE = 4;
+static const int PROGRESS_REPORT_INTERVAL_MSEC = 10 * 1000;
+
+static const char* BAKE_TYPE_NAMES[] = { "models", "textures", "scripts", "materials" };
+
 DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainName,
                          const QString& baseOutputPath, const QUrl& destinationPath,
                          bool shouldRebakeOriginals) :
@@ -38,6 +61,8 @@ DomainBaker::DomainBaker(const QUrl& localModelFileURL, const QString& domainNam
 }
 
 void DomainBaker::bake() {
+    _bakeTimer.start();
+
     setupOutputFolder();
 
     if (hasErrors()) {
@@ -56,11 +81,36 @@ void DomainBaker::bake() {
         return;
     }
 
+    // the assets an earlier run of this bake finished don't need baking again
+    rewriteResumedReferences();
+
+    // emit progress now to say we're just starting
+    emit bakeProgress(_completedSubBakes, _totalNumberOfSubBakes);
+
+    startBakeJobs();
+    if (!_runningBakeJobs.isEmpty()) {
+        _progressTimer = new QTimer(this);
+        connect(_progressTimer, &QTimer::timeout, this, &DomainBaker::reportProgress);
+        _progressTimer->start(PROGRESS_REPORT_INTERVAL_MSEC);
+    }
+
     // in case we've baked and re-written all of our entities already, check if we're done
     checkIfRewritingComplete();
 }
 
 void DomainBaker::setupOutputFolder() {
+    // the hash of the entities file tells whether an unfinished bake in the output folder was of the same file
+    QFile entitiesFile { _localEntitiesFileURL.toLocalFile() };
+    if (entitiesFile.open(QIODevice::ReadOnly)) {
+        QCryptographicHash hasher(QCryptographicHash::Sha256);
+        hasher.addData(&entitiesFile);
+        _entitiesFileHash = hasher.result().toHex();
+    }
+
+    if (findResumableBake()) {
+        return;
+    }
+
     // in order to avoid overwriting previous bakes, we create a special output folder with the domain name and timestamp
 
     // first, construct the directory name
@@ -85,7 +135,6 @@ void DomainBaker::setupOutputFolder() {
     _uniqueOutputPath = outputDir.absolutePath();
 
     // add a content folder inside the unique output folder
-    static const QString CONTENT_OUTPUT_FOLDER_NAME = "content";
     if (!outputDir.mkpath(CONTENT_OUTPUT_FOLDER_NAME)) {
         // add an error to specify that the content output directory could not be created
         handleError("Could not create content folder");
@@ -93,6 +142,78 @@ void DomainBaker::setupOutputFolder() {
     }
 
     _contentOutputPath = outputDir.absoluteFilePath(CONTENT_OUTPUT_FOLDER_NAME);
+
+    // start the manifest with what is being baked
+    _manifestPath = outputDir.absoluteFilePath(MANIFEST_FILE_NAME);
+    QJsonObject header;
+    header[MANIFEST_ENTITIES_HASH_KEY] = _entitiesFileHash;
+    header[MANIFEST_DESTINATION_PATH_KEY] = _destinationPath.toString();
+    header[MANIFEST_REBAKE_ORIGINALS_KEY] = _shouldRebakeOriginals;
+    writeManifestEntry(header);
+}
+
+bool DomainBaker::findResumableBake() {
+    if (_entitiesFileHash.isEmpty()) {
+        return false;
+    }
+
+    // the newest bake of this domain first, since the folders are named by the time they were made
+    auto domainPrefix = !_domainName.isEmpty() ? _domainName + "-" : "";
+    QDir baseDir { _baseOutputPath };
+    auto folderNames = baseDir.entryList({ domainPrefix + "*" }, QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name | QDir::Reversed);
+
+    for (const auto& folderName : folderNames) {
+        QDir folder { baseDir.absoluteFilePath(folderName) };
+        QFile manifest { folder.absoluteFilePath(MANIFEST_FILE_NAME) };
+        if (!manifest.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            continue;
+        }
+
+        auto header = QJsonDocument::fromJson(manifest.readLine()).object();
+        if (header[MANIFEST_ENTITIES_HASH_KEY].toString() != _entitiesFileHash ||
+            header[MANIFEST_DESTINATION_PATH_KEY].toString() != _destinationPath.toString() ||
+            header[MANIFEST_REBAKE_ORIGINALS_KEY].toBool() != _shouldRebakeOriginals) {
+            continue;
+        }
+
+        QHash<QString, BakeResult> results;
+        while (!manifest.atEnd()) {
+            // a line cut short by a crash doesn't parse, and its asset is baked again
+            auto entry = QJsonDocument::fromJson(manifest.readLine()).object();
+            if (entry.contains(MANIFEST_COMPLETE_KEY)) {
+                // the newest bake of this file finished, so this is a new one
+                return false;
+            }
+            if (entry.contains(MANIFEST_CONTENT_KEY)) {
+                BakeResult result;
+                result.value = entry[MANIFEST_VALUE_KEY].toString();
+                result.isURL = entry[MANIFEST_IS_URL_KEY].toBool();
+                result.keepsURLSuffix = entry[MANIFEST_KEEPS_URL_SUFFIX_KEY].toBool();
+                results.insert(entry[MANIFEST_CONTENT_KEY].toString(), result);
+            }
+        }
+        manifest.close();
+
+        if (!folder.mkpath(CONTENT_OUTPUT_FOLDER_NAME)) {
+            continue;
+        }
+
+        _uniqueOutputPath = folder.absolutePath();
+        _contentOutputPath = folder.absoluteFilePath(CONTENT_OUTPUT_FOLDER_NAME);
+        _manifestPath = manifest.fileName();
+        _resumedResults = results;
+
+        // ends whatever line the crash cut short, so the next entry starts on a line of its own
+        QFile manifestEnd { _manifestPath };
+        if (manifestEnd.open(QIODevice::Append | QIODevice::Text)) {
+            manifestEnd.write("\n");
+        }
+
+        qDebug() << "Resuming the bake in" << _uniqueOutputPath << "with" << results.size() << "assets already baked";
+        return true;
+    }
+
+    return false;
 }
 
 const QString ENTITIES_OBJECT_KEY = "Entities";
@@ -101,8 +222,9 @@ void DomainBaker::loadLocalFile() {
     // load up the local entities file
     QFile entitiesFile { _localEntitiesFileURL.toLocalFile() };
 
-    // first make a copy of the local entities file in our output folder
-    if (!entitiesFile.copy(_uniqueOutputPath + "/" + "original-" + _localEntitiesFileURL.fileName())) {
+    // first make a copy of the local entities file in our output folder, unless a bake being resumed made it already
+    QString entitiesFileCopyPath = _uniqueOutputPath + "/" + "original-" + _localEntitiesFileURL.fileName();
+    if (!QFile::exists(entitiesFileCopyPath) && !entitiesFile.copy(entitiesFileCopyPath)) {
         // add an error to our list to specify that the file could not be copied
         handleError("Could not make a copy of entities file");
 
@@ -144,13 +266,228 @@ void DomainBaker::loadLocalFile() {
     }
 }
 
+QString DomainBaker::getContentKey(BakeType type, const QUrl& url, bool keepsDirectory) {
+    QString key = QString::number(type) + "^";
+    if (!url.isLocalFile()) {
+        return key + url.toString();
+    }
+
+    QString path = url.toLocalFile();
+    auto hash = _contentHashes.find(path);
+    if (hash == _contentHashes.end()) {
+        QString fileHash;
+        QFile file { path };
+        if (file.open(QIODevice::ReadOnly)) {
+            QCryptographicHash hasher(QCryptographicHash::Sha256);
+            hasher.addData(&file);
+            fileHash = hasher.result().toHex();
+        }
+        hash = _contentHashes.insert(path, fileHash);
+    }
+
+    if (hash->isEmpty()) {
+        // the baker will report what is wrong with the file
+        return key + url.toString();
+    }
+
+    // an asset that refers to others by relative URLs only shares its bake with copies in the same folder
+    if (keepsDirectory) {
+        key += QFileInfo(path).absolutePath() + "^";
+    }
+    return key + *hash;
+}
+
+bool DomainBaker::addBakeReference(const QString& contentKey, const QUrl& rewriteKey) {
+    if (_resumedResults.contains(contentKey)) {
+        bool isNew = !_resumedRewriteKeys.contains(contentKey);
+        if (!_resumedRewriteKeys.contains(contentKey, rewriteKey)) {
+            if (!isNew) {
+                ++_deduplicatedSources;
+            }
+            _resumedRewriteKeys.insert(contentKey, rewriteKey);
+        }
+        return isNew;
+    }
+
+    auto job = _bakeJobs.find(contentKey);
+    if (job == _bakeJobs.end()) {
+        return true;
+    }
+    if (!(*job)->rewriteKeys.contains(rewriteKey)) {
+        (*job)->rewriteKeys.push_back(rewriteKey);
+        ++_deduplicatedSources;
+    }
+    return false;
+}
+
+void DomainBaker::queueBakeJob(BakeType type, const QString& contentKey, const QUrl& rewriteKey,
+                               const QSharedPointer<Baker>& baker) {
+    auto job = BakeJobPointer::create();
+    job->type = type;
+    job->contentKey = contentKey;
+    job->baker = baker;
+    job->rewriteKeys.push_back(rewriteKey);
+    _bakeJobs.insert(contentKey, job);
+
+    if (type == MODEL_BAKE) {
+        _queuedModelBakeJobs.enqueue(job);
+    } else {
+        _queuedBakeJobs.enqueue(job);
+    }
+
+    // keep track of the total number of baking entities
+    ++_totalNumberOfSubBakes;
+}
+
+void DomainBaker::startBakeJobs() {
+    auto& oven = Oven::instance();
+    if (_workerThreadLoads.empty()) {
+        _workerThreadLoads.resize(std::max(oven.getNumWorkerThreads(), 1), 0);
+        _maxRunningModelBakeJobs = std::max((int)_workerThreadLoads.size() / WORKER_THREADS_PER_MODEL_BAKE, 1);
+    }
+
+    // one bake per worker thread keeps them all busy without a long queue building up behind a slow bake on any of them
+    while (_runningBakeJobs.size() < (int)_workerThreadLoads.size()) {
+        BakeJobPointer job;
+        if (!_queuedModelBakeJobs.isEmpty() && _numRunningModelBakeJobs < _maxRunningModelBakeJobs) {
+            // the model bakes are the slowest, so they start whenever there is room for one
+            job = _queuedModelBakeJobs.dequeue();
+            ++_numRunningModelBakeJobs;
+        } else if (!_queuedBakeJobs.isEmpty()) {
+            job = _queuedBakeJobs.dequeue();
+        } else {
+            break;
+        }
+
+        auto leastLoaded = std::min_element(_workerThreadLoads.begin(), _workerThreadLoads.end());
+        ++*leastLoaded;
+        job->workerThread = (int)(leastLoaded - _workerThreadLoads.begin());
+        job->timer.start();
+        _runningBakeJobs.insert(job->baker.data(), job);
+
+        // move the baker to its worker thread and kickoff the bake
+        job->baker->moveToThread(oven.getWorkerThread(job->workerThread));
+        QMetaObject::invokeMethod(job->baker.data(), "bake", Qt::QueuedConnection);
+    }
+}
+
+DomainBaker::BakeJobPointer DomainBaker::takeRunningBakeJob(Baker* baker) {
+    auto job = _runningBakeJobs.take(baker);
+    if (job) {
+        --_workerThreadLoads[job->workerThread];
+        if (job->type == MODEL_BAKE) {
+            --_numRunningModelBakeJobs;
+        }
+        ++_completedByType[job->type];
+        _bakeMsecsByType[job->type] += job->timer.elapsed();
+    }
+    return job;
+}
+
+void DomainBaker::finishBakeJob(const BakeJobPointer& job, const BakeResult* result) {
+    if (result) {
+        for (const auto& rewriteKey : job->rewriteKeys) {
+            rewriteReferences(rewriteKey, *result);
+        }
+
+        QJsonObject entry;
+        entry[MANIFEST_CONTENT_KEY] = job->contentKey;
+        entry[MANIFEST_VALUE_KEY] = result->value;
+        entry[MANIFEST_IS_URL_KEY] = result->isURL;
+        entry[MANIFEST_KEEPS_URL_SUFFIX_KEY] = result->keepsURLSuffix;
+        writeManifestEntry(entry);
+    } else {
+        ++_failedSubBakes;
+        for (const auto& rewriteKey : job->rewriteKeys) {
+            _entitiesNeedingRewrite.remove(rewriteKey);
+        }
+    }
+
+    // drop our shared pointer to this baker so that it gets cleaned up
+    job->baker.reset();
+
+    // emit progress to tell listeners how many assets we have baked
+    emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+
+    // give the worker thread the next bake
+    startBakeJobs();
+
+    // check if this was the last asset we needed to re-write and if we are done now
+    checkIfRewritingComplete();
+}
+
+void DomainBaker::rewriteReferences(const QUrl& rewriteKey, const BakeResult& result) {
+    // enumerate the QJsonRef values for this asset from our multi hash of entity objects needing a URL re-write
+    for (auto propertyEntityPair : _entitiesNeedingRewrite.values(rewriteKey)) {
+        QString property = propertyEntityPair.first;
+        QStringList propertySplit = property.split(".");
+        assert(propertySplit.length() <= 2);
+        bool isGroupProperty = propertySplit.length() == 2;
+
+        auto rewrite = [&](const QJsonValue& oldValue) -> QJsonValue {
+            if (!result.isURL) {
+                return result.value;
+            }
+            QUrl newURL = result.value;
+            if (isGroupProperty || result.keepsURLSuffix) {
+                // copy the fragment and query, and user info from the old URL
+                QUrl oldURL = oldValue.toString();
+                newURL.setQuery(oldURL.query());
+                newURL.setFragment(oldURL.fragment());
+                newURL.setUserInfo(oldURL.userInfo());
+            }
+            return newURL.toString();
+        };
+
+        // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
+        auto entity = propertyEntityPair.second.toObject();
+        if (!isGroupProperty) {
+            entity[property] = rewrite(entity[property]);
+        } else {
+            auto oldObject = entity[propertySplit[0]].toObject();
+            oldObject[propertySplit[1]] = rewrite(oldObject[propertySplit[1]]);
+            entity[propertySplit[0]] = oldObject;
+        }
+
+        // replace our temp object with the value referenced by our QJsonValueRef
+        propertyEntityPair.second = entity;
+    }
+
+    // remove the baked URL from the multi hash of entities needing a re-write
+    _entitiesNeedingRewrite.remove(rewriteKey);
+}
+
+void DomainBaker::rewriteResumedReferences() {
+    for (auto result = _resumedResults.cbegin(); result != _resumedResults.cend(); ++result) {
+        auto rewriteKeys = _resumedRewriteKeys.values(result.key());
+        if (rewriteKeys.isEmpty()) {
+            continue;
+        }
+
+        ++_resumedSubBakes;
+        ++_totalNumberOfSubBakes;
+        ++_completedSubBakes;
+        for (const auto& rewriteKey : rewriteKeys) {
+            rewriteReferences(rewriteKey, result.value());
+        }
+    }
+}
+
+void DomainBaker::writeManifestEntry(const QJsonObject& entry) {
+    QFile manifest { _manifestPath };
+    if (!manifest.open(QIODevice::Append | QIODevice::Text) ||
+        manifest.write(QJsonDocument(entry).toJson(QJsonDocument::Compact) + "\n") == -1) {
+        qWarning() << "Could not write to the bake manifest" << _manifestPath;
+    }
+}
+
 void DomainBaker::addModelBaker(const QString& property, const QString& url, const QJsonValueRef& jsonRef) {
     // grab a QUrl for the model URL
     QUrl bakeableModelURL = getBakeableModelURL(url);
     if (!bakeableModelURL.isEmpty() && (_shouldRebakeOriginals || !isModelBaked(bakeableModelURL))) {
-        // setup a ModelBaker for this URL, as long as we don't already have one
-        bool haveBaker = _modelBakers.contains(bakeableModelURL);
-        if (!haveBaker) {
+        // setup a ModelBaker for this model, as long as we don't already have one
+        QString contentKey = getContentKey(MODEL_BAKE, bakeableModelURL, true);
+        if (addBakeReference(contentKey, bakeableModelURL) && !_resumedResults.contains(contentKey)) {
             QSharedPointer<ModelBaker> baker = QSharedPointer<ModelBaker>(getModelBaker(bakeableModelURL, _contentOutputPath).release(), &Baker::deleteLater);
             if (baker) {
                 // Hold on to the old url userinfo/query/fragment data so ModelBaker::getFullOutputMappingURL retains that data from the original model URL
@@ -163,21 +500,11 @@ void DomainBaker::addModelBaker(const QString& property, const QString& url, con
                 // make sure our handler is called when the baker is done
                 connect(baker.data(), &Baker::finished, this, &DomainBaker::handleFinishedModelBaker);
 
-                // insert it into our bakers hash so we hold a strong pointer to it
-                _modelBakers.insert(bakeableModelURL, baker);
-                haveBaker = true;
-
-                // move the baker to the baker thread
-                // and kickoff the bake
-                baker->moveToThread(Oven::instance().getNextWorkerThread());
-                QMetaObject::invokeMethod(baker.data(), "bake", Qt::QueuedConnection);
-
-                // keep track of the total number of baking entities
-                ++_totalNumberOfSubBakes;
+                queueBakeJob(MODEL_BAKE, contentKey, bakeableModelURL, baker);
             }
         }
 
-        if (haveBaker) {
+        if (_bakeJobs.contains(contentKey) || _resumedResults.contains(contentKey)) {
             // add this QJsonValueRef to our multi hash so that we can easily re-write
             // the model URL to the baked version once the baker is complete
             _entitiesNeedingRewrite.insert(bakeableModelURL, { property, jsonRef });
@@ -193,36 +520,32 @@ void DomainBaker::addTextureBaker(const QString& property, const QString& url, i
     if (QImageReader::supportedImageFormats().contains(extension.toLatin1())) {
         // grab a clean version of the URL without a query or fragment
         QUrl textureURL = QUrl(url).adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment);
-        TextureKey key = { textureURL, type };
+        // it doesn't really matter what this key is as long as it's consistent
+        QUrl rewriteKey = textureURL.toDisplayString() + "^" + QString::number(type);
+        QString contentKey = getContentKey(TEXTURE_BAKE, textureURL, false) + "^" + QString::number(type);
 
-        // setup a texture baker for this URL, as long as we aren't baking a texture already
-        if (!_textureBakers.contains(key)) {
+        // setup a texture baker for this texture, as long as we aren't baking it already
+        if (addBakeReference(contentKey, rewriteKey)) {
+            // named even when an earlier run baked it, so the names of the others come out as they did then
             auto baseTextureFileName = _textureFileNamer.createBaseTextureFileName(textureURL.fileName(), type);
 
-            // setup a baker for this texture
-            QSharedPointer<TextureBaker> textureBaker {
-                new TextureBaker(textureURL, type, _contentOutputPath, baseTextureFileName),
-                &TextureBaker::deleteLater
-            };
+            if (!_resumedResults.contains(contentKey)) {
+                // setup a baker for this texture
+                QSharedPointer<TextureBaker> textureBaker {
+                    new TextureBaker(textureURL, type, _contentOutputPath, baseTextureFileName),
+                    &TextureBaker::deleteLater
+                };
 
-            // make sure our handler is called when the texture baker is done
-            connect(textureBaker.data(), &TextureBaker::finished, this, &DomainBaker::handleFinishedTextureBaker);
+                // make sure our handler is called when the texture baker is done
+                connect(textureBaker.data(), &TextureBaker::finished, this, &DomainBaker::handleFinishedTextureBaker);
 
-            // insert it into our bakers hash so we hold a strong pointer to it
-            _textureBakers.insert(key, textureBaker);
-
-            // move the baker to a worker thread and kickoff the bake
-            textureBaker->moveToThread(Oven::instance().getNextWorkerThread());
-            QMetaObject::invokeMethod(textureBaker.data(), "bake", Qt::QueuedConnection);
-
-            // keep track of the total number of baking entities
-            ++_totalNumberOfSubBakes;
+                queueBakeJob(TEXTURE_BAKE, contentKey, rewriteKey, textureBaker);
+            }
         }
 
         // add this QJsonValueRef to our multi hash so that it can re-write the texture URL
         // to the baked version once the baker is complete
-        // it doesn't really matter what this key is as long as it's consistent
-        _entitiesNeedingRewrite.insert(textureURL.toDisplayString() + "^" + QString::number(type), { property, jsonRef });
+        _entitiesNeedingRewrite.insert(rewriteKey, { property, jsonRef });
     } else {
         qDebug() << "Texture extension not supported: " << extension;
     }
@@ -231,10 +554,10 @@ void DomainBaker::addTextureBaker(const QString& property, const QString& url, i
 void DomainBaker::addScriptBaker(const QString& property, const QString& url, const QJsonValueRef& jsonRef) {
     // grab a clean version of the URL without a query or fragment
     QUrl scriptURL = QUrl(url).adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment);
+    QString contentKey = getContentKey(SCRIPT_BAKE, scriptURL, false);
 
-    // setup a script baker for this URL, as long as we aren't baking a script already
-    if (!_scriptBakers.contains(scriptURL)) {
-
+    // setup a script baker for this script, as long as we aren't baking it already
+    if (addBakeReference(contentKey, scriptURL) && !_resumedResults.contains(contentKey)) {
         // setup a baker for this script
         QSharedPointer<JSBaker> scriptBaker {
             new JSBaker(scriptURL, _contentOutputPath),
@@ -244,15 +567,7 @@ void DomainBaker::addScriptBaker(const QString& property, const QString& url, co
         // make sure our handler is called when the script baker is done
         connect(scriptBaker.data(), &JSBaker::finished, this, &DomainBaker::handleFinishedScriptBaker);
 
-        // insert it into our bakers hash so we hold a strong pointer to it
-        _scriptBakers.insert(scriptURL, scriptBaker);
-
-        // move the baker to a worker thread and kickoff the bake
-        scriptBaker->moveToThread(Oven::instance().getNextWorkerThread());
-        QMetaObject::invokeMethod(scriptBaker.data(), "bake", Qt::QueuedConnection);
-
-        // keep track of the total number of baking entities
-        ++_totalNumberOfSubBakes;
+        queueBakeJob(SCRIPT_BAKE, contentKey, scriptURL, scriptBaker);
     }
 
     // add this QJsonValueRef to our multi hash so that it can re-write the script URL
@@ -263,15 +578,19 @@ void DomainBaker::addScriptBaker(const QString& property, const QString& url, co
 void DomainBaker::addMaterialBaker(const QString& property, const QString& data, bool isURL, const QJsonValueRef& jsonRef, QUrl destinationPath) {
     // grab a clean version of the URL without a query or fragment
     QString materialData;
+    QString contentKey;
     if (isURL) {
-        materialData = QUrl(data).adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment).toDisplayString();
+        QUrl materialURL = QUrl(data).adjusted(QUrl::RemoveQuery | QUrl::RemoveFragment);
+        materialData = materialURL.toDisplayString();
+        contentKey = getContentKey(MATERIAL_BAKE, materialURL, true);
     } else {
         materialData = data;
+        contentKey = QString::number(MATERIAL_BAKE) + "^" + destinationPath.toString() + "^" +
+            QCryptographicHash::hash(data.toUtf8(), QCryptographicHash::Sha256).toHex();
     }
 
-    // setup a material baker for this URL, as long as we aren't baking a material already
-    if (!_materialBakers.contains(materialData)) {
-
+    // setup a material baker for this material, as long as we aren't baking it already
+    if (addBakeReference(contentKey, materialData) && !_resumedResults.contains(contentKey)) {
         // setup a baker for this material
         QSharedPointer<MaterialBaker> materialBaker {
             new MaterialBaker(materialData, isURL, _contentOutputPath, destinationPath),
@@ -281,15 +600,7 @@ void DomainBaker::addMaterialBaker(const QString& property, const QString& data,
         // make sure our handler is called when the material baker is done
         connect(materialBaker.data(), &MaterialBaker::finished, this, &DomainBaker::handleFinishedMaterialBaker);
 
-        // insert it into our bakers hash so we hold a strong pointer to it
-        _materialBakers.insert(materialData, materialBaker);
-
-        // move the baker to a worker thread and kickoff the bake
-        materialBaker->moveToThread(Oven::instance().getNextWorkerThread());
-        QMetaObject::invokeMethod(materialBaker.data(), "bake", Qt::QueuedConnection);
-
-        // keep track of the total number of baking entities
-        ++_totalNumberOfSubBakes;
+        queueBakeJob(MATERIAL_BAKE, contentKey, materialData, materialBaker);
     }
 
     // add this QJsonValueRef to our multi hash so that it can re-write the material URL
@@ -422,15 +733,13 @@ void DomainBaker::enumerateEntities() {
             }
         }
     }
-
-    // emit progress now to say we're just starting
-    emit bakeProgress(0, _totalNumberOfSubBakes);
 }
 
 void DomainBaker::handleFinishedModelBaker() {
     auto baker = qobject_cast<ModelBaker*>(sender());
+    auto job = takeRunningBakeJob(baker);
 
-    if (baker) {
+    if (job) {
         if (!baker->hasErrors()) {
             // this ModelBaker is done and everything went according to plan
             qDebug() << "Re-writing entity references to" << baker->getModelURL();
@@ -441,69 +750,25 @@ void DomainBaker::handleFinishedModelBaker() {
                 relativeMappingFilePath = relativeMappingFilePath.right(relativeMappingFilePath.length() - 1);
             }
 
-            QUrl newURL = _destinationPath.resolved(relativeMappingFilePath);
-
-            // enumerate the QJsonRef values for the URL of this model from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(baker->getOriginalInputModelURL())) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // set the new URL as the value in our temp QJsonObject
-                    // The fragment, query, and user info from the original model URL should now be present on the filename in the FST file
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old model URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
-                }
-
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
-            }
+            // The fragment, query, and user info from the original model URL should now be present on the filename in the FST file
+            BakeResult result;
+            result.value = _destinationPath.resolved(relativeMappingFilePath).toString();
+            result.keepsURLSuffix = false;
+            finishBakeJob(job, &result);
         } else {
             // this model failed to bake - this doesn't fail the entire bake but we need to add
             // the errors from the model to our warnings
             _warningList << baker->getErrors();
+            finishBakeJob(job, nullptr);
         }
-
-        // remove the baked URL from the multi hash of entities needing a re-write
-        _entitiesNeedingRewrite.remove(baker->getOriginalInputModelURL());
-
-        // drop our shared pointer to this baker so that it gets cleaned up
-        _modelBakers.remove(baker->getOriginalInputModelURL());
-
-        // emit progress to tell listeners how many models we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
-
-        // check if this was the last model we needed to re-write and if we are done now
-        checkIfRewritingComplete();
     }
 }
 
 void DomainBaker::handleFinishedTextureBaker() {
     auto baker = qobject_cast<TextureBaker*>(sender());
+    auto job = takeRunningBakeJob(baker);
 
-    if (baker) {
-        QUrl rewriteKey = baker->getTextureURL().toDisplayString() + "^" + QString::number(baker->getTextureType());
-
+    if (job) {
         if (!baker->hasErrors()) {
             // this TextureBaker is done and everything went according to plan
             qDebug() << "Re-writing entity references to" << baker->getTextureURL() << "with usage" << baker->getTextureType();
@@ -513,71 +778,24 @@ void DomainBaker::handleFinishedTextureBaker() {
             if (relativeTextureFilePath.startsWith("/")) {
                 relativeTextureFilePath = relativeTextureFilePath.right(relativeTextureFilePath.length() - 1);
             }
-            auto newURL = _destinationPath.resolved(relativeTextureFilePath);
-
-            // enumerate the QJsonRef values for the URL of this texture from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(rewriteKey)) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // copy the fragment and query, and user info from the old texture URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old texture URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
-                }
 
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
-            }
+            BakeResult result;
+            result.value = _destinationPath.resolved(relativeTextureFilePath).toString();
+            finishBakeJob(job, &result);
         } else {
             // this texture failed to bake - this doesn't fail the entire bake but we need to add the errors from
             // the texture to our warnings
             _warningList << baker->getWarnings();
+            finishBakeJob(job, nullptr);
         }
-
-        // remove the baked URL from the multi hash of entities needing a re-write
-        _entitiesNeedingRewrite.remove(rewriteKey);
-
-        // drop our shared pointer to this baker so that it gets cleaned up
-        _textureBakers.remove({ baker->getTextureURL(), baker->getTextureType() });
-
-        // emit progress to tell listeners how many textures we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
-
-        // check if this was the last texture we needed to re-write and if we are done now
-        checkIfRewritingComplete();
     }
 }
 
 void DomainBaker::handleFinishedScriptBaker() {
     auto baker = qobject_cast<JSBaker*>(sender());
+    auto job = takeRunningBakeJob(baker);
 
-    if (baker) {
+    if (job) {
         if (!baker->hasErrors()) {
             // this JSBaker is done and everything went according to plan
             qDebug() << "Re-writing entity references to" << baker->getJSPath();
@@ -587,165 +805,113 @@ void DomainBaker::handleFinishedScriptBaker() {
             if (relativeScriptFilePath.startsWith("/")) {
                 relativeScriptFilePath = relativeScriptFilePath.right(relativeScriptFilePath.length() - 1);
             }
-            auto newURL = _destinationPath.resolved(relativeScriptFilePath);
-
-            // enumerate the QJsonRef values for the URL of this script from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(baker->getJSPath())) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // copy the fragment and query, and user info from the old script URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    entity[property] = newURL.toString();
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old script URL
-                    newURL.setQuery(oldURL.query());
-                    newURL.setFragment(oldURL.fragment());
-                    newURL.setUserInfo(oldURL.userInfo());
-
-                    // set the new URL as the value in our temp QJsonObject
-                    oldObject[propertySplit[1]] = newURL.toString();
-                    entity[propertySplit[0]] = oldObject;
-                }
 
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
-            }
+            BakeResult result;
+            result.value = _destinationPath.resolved(relativeScriptFilePath).toString();
+            finishBakeJob(job, &result);
         } else {
             // this script failed to bake - this doesn't fail the entire bake but we need to add
             // the errors from the script to our warnings
             _warningList << baker->getErrors();
+            finishBakeJob(job, nullptr);
         }
-
-        // remove the baked URL from the multi hash of entities needing a re-write
-        _entitiesNeedingRewrite.remove(baker->getJSPath());
-
-        // drop our shared pointer to this baker so that it gets cleaned up
-        _scriptBakers.remove(baker->getJSPath());
-
-        // emit progress to tell listeners how many scripts we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
-
-        // check if this was the last script we needed to re-write and if we are done now
-        checkIfRewritingComplete();
     }
 }
 
 void DomainBaker::handleFinishedMaterialBaker() {
     auto baker = qobject_cast<MaterialBaker*>(sender());
+    auto job = takeRunningBakeJob(baker);
 
-    if (baker) {
+    if (job) {
         if (!baker->hasErrors()) {
             // this MaterialBaker is done and everything went according to plan
             qDebug() << "Re-writing entity references to" << baker->getMaterialData();
 
-            QString newDataOrURL;
+            BakeResult result;
+            result.isURL = baker->isURL();
             if (baker->isURL()) {
                 // setup a new URL using the prefix we were passed
                 auto relativeMaterialFilePath = QDir(_contentOutputPath).relativeFilePath(baker->getBakedMaterialData());
                 if (relativeMaterialFilePath.startsWith("/")) {
                     relativeMaterialFilePath = relativeMaterialFilePath.right(relativeMaterialFilePath.length() - 1);
                 }
-                newDataOrURL = _destinationPath.resolved(relativeMaterialFilePath).toDisplayString();
+                result.value = _destinationPath.resolved(relativeMaterialFilePath).toDisplayString();
             } else {
-                newDataOrURL = baker->getBakedMaterialData();
-            }
-
-            // enumerate the QJsonRef values for the URL of this material from our multi hash of
-            // entity objects needing a URL re-write
-            for (auto propertyEntityPair : _entitiesNeedingRewrite.values(baker->getMaterialData())) {
-                QString property = propertyEntityPair.first;
-                // convert the entity QJsonValueRef to a QJsonObject so we can modify its URL
-                auto entity = propertyEntityPair.second.toObject();
-
-                if (!property.contains(".")) {
-                    // grab the old URL
-                    QUrl oldURL = entity[property].toString();
-
-                    // copy the fragment and query, and user info from the old material data
-                    if (baker->isURL()) {
-                        QUrl newURL = newDataOrURL;
-                        newURL.setQuery(oldURL.query());
-                        newURL.setFragment(oldURL.fragment());
-                        newURL.setUserInfo(oldURL.userInfo());
-
-                        // set the new URL as the value in our temp QJsonObject
-                        entity[property] = newURL.toString();
-                    } else {
-                        entity[property] = newDataOrURL;
-                    }
-                } else {
-                    // Group property
-                    QStringList propertySplit = property.split(".");
-                    assert(propertySplit.length() == 2);
-                    // grab the old URL
-                    auto oldObject = entity[propertySplit[0]].toObject();
-                    QUrl oldURL = oldObject[propertySplit[1]].toString();
-
-                    // copy the fragment and query, and user info from the old material data
-                    if (baker->isURL()) {
-                        QUrl newURL = newDataOrURL;
-                        newURL.setQuery(oldURL.query());
-                        newURL.setFragment(oldURL.fragment());
-                        newURL.setUserInfo(oldURL.userInfo());
-
-                        // set the new URL as the value in our temp QJsonObject
-                        oldObject[propertySplit[1]] = newURL.toString();
-                        entity[propertySplit[0]] = oldObject;
-                    } else {
-                        oldObject[propertySplit[1]] = newDataOrURL;
-                        entity[propertySplit[0]] = oldObject;
-                    }
-                }
-
-                // replace our temp object with the value referenced by our QJsonValueRef
-                propertyEntityPair.second = entity;
+                result.value = baker->getBakedMaterialData();
             }
+            finishBakeJob(job, &result);
         } else {
             // this material failed to bake - this doesn't fail the entire bake but we need to add
             // the errors from the material to our warnings
             _warningList << baker->getErrors();
+            finishBakeJob(job, nullptr);
         }
+    }
+}
 
-        // remove the baked URL from the multi hash of entities needing a re-write
-        _entitiesNeedingRewrite.remove(baker->getMaterialData());
-
-        // drop our shared pointer to this baker so that it gets cleaned up
-        _materialBakers.remove(baker->getMaterialData());
+void DomainBaker::reportProgress() {
+    int bakedThisRun = _completedSubBakes - _resumedSubBakes;
+    double minutes = _bakeTimer.elapsed() / (double)(60 * 1000);
+    double bakesPerMinute = minutes > 0.0 ? bakedThisRun / minutes : 0.0;
+    int remaining = _totalNumberOfSubBakes - _completedSubBakes;
+    int queued = _queuedModelBakeJobs.size() + _queuedBakeJobs.size();
+
+    qDebug().nospace() << "Baked " << _completedSubBakes << " of " << _totalNumberOfSubBakes << " assets ("
+        << _resumedSubBakes << " by an earlier run, " << _failedSubBakes << " failed), " << _runningBakeJobs.size()
+        << " baking and " << queued << " queued, at " << QString::number(bakesPerMinute, 'f', 1) << " a minute"
+        << (bakesPerMinute > 0.0 ? ", about " + QString::number(remaining / bakesPerMinute, 'f', 0) + " minutes left" : "");
+}
 
-        // emit progress to tell listeners how many materials we have baked
-        emit bakeProgress(++_completedSubBakes, _totalNumberOfSubBakes);
+void DomainBaker::writeReport() {
+    double seconds = _bakeTimer.elapsed() / 1000.0;
+    int bakedThisRun = _completedSubBakes - _resumedSubBakes;
+
+    QJsonObject types;
+    for (int type = 0; type < NUM_BAKE_TYPES; ++type) {
+        QJsonObject typeReport;
+        typeReport["baked"] = _completedByType[type];
+        typeReport["averageSeconds"] = _completedByType[type] > 0 ?
+            _bakeMsecsByType[type] / 1000.0 / _completedByType[type] : 0.0;
+        types[BAKE_TYPE_NAMES[type]] = typeReport;
+    }
 
-        // check if this was the last material we needed to re-write and if we are done now
-        checkIfRewritingComplete();
+    QJsonObject report;
+    report["assets"] = _totalNumberOfSubBakes;
+    report["bakedByEarlierRun"] = _resumedSubBakes;
+    report["failed"] = _failedSubBakes;
+    report["deduplicatedSources"] = _deduplicatedSources;
+    report["seconds"] = seconds;
+    report["bakesPerMinute"] = seconds > 0.0 ? bakedThisRun * 60.0 / seconds : 0.0;
+    report["types"] = types;
+
+    QFile reportFile { QDir(_uniqueOutputPath).filePath(REPORT_FILE_NAME) };
+    if (!reportFile.open(QIODevice::WriteOnly) || reportFile.write(QJsonDocument(report).toJson()) == -1) {
+        qWarning() << "Could not write the bake report" << reportFile.fileName();
     }
+
+    qDebug() << "Baked" << _totalNumberOfSubBakes << "assets in" << seconds << "seconds," << _resumedSubBakes
+        << "of them by an earlier run," << _failedSubBakes << "failed and" << _deduplicatedSources
+        << "URLs shared the bake of another with the same content";
 }
 
 void DomainBaker::checkIfRewritingComplete() {
     if (_entitiesNeedingRewrite.isEmpty()) {
+        if (_progressTimer) {
+            _progressTimer->stop();
+        }
+
         writeNewEntitiesFile();
 
         if (hasErrors()) {
             return;
         }
 
+        // a bake of the same file into the same folder starts over from here
+        QJsonObject complete;
+        complete[MANIFEST_COMPLETE_KEY] = true;
+        writeManifestEntry(complete);
+        writeReport();
+
         // we've now written out our new models file - time to say that we are finished up
         emit finished();
     }
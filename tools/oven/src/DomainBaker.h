@@ -12,10 +12,17 @@
 #ifndef hifi_DomainBaker_h
 #define hifi_DomainBaker_h
 
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonArray>
+#include <QtCore/QJsonObject>
 #include <QtCore/QObject>
+#include <QtCore/QPointer>
+#include <QtCore/QQueue>
 #include <QtCore/QSharedPointer>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 #include <QtCore/QThread>
 
@@ -24,12 +31,16 @@
 #include "JSBaker.h"
 #include "MaterialBaker.h"
 
+// Bakes every model, texture, script and material a domain's entities refer to, and writes a copy of the entities file
+// that refers to the baked versions instead.
+// Each distinct asset is baked once, however many URLs it is found at: local files are told apart by the hash of their
+// content, and remote ones by their URL. The bakes are queued and handed to the least busy Oven worker threads, keeping
+// them all busy but only a few on the memory hungry model bakes at a time. Each finished bake is recorded in a manifest in
+// the output folder, so baking the same entities file into the same output folder again after a crash picks up where the
+// last bake stopped.
 class DomainBaker : public Baker {
     Q_OBJECT
 public:
-    // This is a real bummer, but the FBX SDK is not thread safe - even with separate FBXManager objects.
-    // This means that we need to put all of the FBX importing/exporting from the same process on the same thread.
-    // That means you must pass a usable running QThread when constructing a domain baker.
     DomainBaker(const QUrl& localEntitiesFileURL, const QString& domainName,
                 const QString& baseOutputPath, const QUrl& destinationPath,
                 bool shouldRebakeOriginals);
@@ -44,14 +55,59 @@ private slots:
     void handleFinishedTextureBaker();
     void handleFinishedScriptBaker();
     void handleFinishedMaterialBaker();
+    void reportProgress();
 
 private:
+    enum BakeType {
+        MODEL_BAKE = 0,
+        TEXTURE_BAKE,
+        SCRIPT_BAKE,
+        MATERIAL_BAKE,
+        NUM_BAKE_TYPES
+    };
+
+    // what the references to a baked asset are rewritten to
+    struct BakeResult {
+        QString value;
+        bool isURL { true };
+        // whether a URL at the top level of an entity keeps its query, fragment and user info; the group properties'
+        // URLs always do
+        bool keepsURLSuffix { true };
+    };
+
+    // a node of the bake graph: one asset, and the keys of _entitiesNeedingRewrite for every URL it was found at
+    struct BakeJob {
+        BakeType type;
+        QString contentKey;
+        QSharedPointer<Baker> baker;
+        QList<QUrl> rewriteKeys;
+        int workerThread { -1 };
+        QElapsedTimer timer;
+    };
+    using BakeJobPointer = QSharedPointer<BakeJob>;
+
     void setupOutputFolder();
+    bool findResumableBake();
     void loadLocalFile();
     void enumerateEntities();
     void checkIfRewritingComplete();
     void writeNewEntitiesFile();
 
+    QString getContentKey(BakeType type, const QUrl& url, bool keepsDirectory);
+    // records that the references under rewriteKey are rewritten with the bake of contentKey, and returns whether the
+    // content is new, in which case it needs a baker unless an earlier run of this bake baked it
+    bool addBakeReference(const QString& contentKey, const QUrl& rewriteKey);
+    void queueBakeJob(BakeType type, const QString& contentKey, const QUrl& rewriteKey, const QSharedPointer<Baker>& baker);
+    void startBakeJobs();
+    BakeJobPointer takeRunningBakeJob(Baker* baker);
+    // rewrites the references with the result, or leaves them as they are when the bake failed
+    void finishBakeJob(const BakeJobPointer& job, const BakeResult* result);
+    void rewriteReferences(const QUrl& rewriteKey, const BakeResult& result);
+    void rewriteResumedReferences();
+
+    void writeManifestEntry(const QJsonObject& entry);
+    void writeReport();
+
     QUrl _localEntitiesFileURL;
     QString _domainName;
     QString _baseOutputPath;
@@ -64,16 +120,38 @@ private:
     QJsonDocument _json;
     QJsonArray _entities;
 
-    QHash<QUrl, QSharedPointer<ModelBaker>> _modelBakers;
-    QHash<TextureKey, QSharedPointer<TextureBaker>> _textureBakers;
     TextureFileNamer _textureFileNamer;
-    QHash<QUrl, QSharedPointer<JSBaker>> _scriptBakers;
-    QHash<QUrl, QSharedPointer<MaterialBaker>> _materialBakers;
-    
+
+    // the bake graph, by content key
+    QHash<QString, BakeJobPointer> _bakeJobs;
+    QHash<Baker*, BakeJobPointer> _runningBakeJobs;
+    QQueue<BakeJobPointer> _queuedModelBakeJobs;
+    QQueue<BakeJobPointer> _queuedBakeJobs;
+    std::vector<int> _workerThreadLoads;
+    int _maxRunningModelBakeJobs { 1 };
+    int _numRunningModelBakeJobs { 0 };
+    // the hashes of the local files looked at so far, by path
+    QHash<QString, QString> _contentHashes;
+
+    // the results of the bakes an earlier run of this bake finished, by content key, and the keys to rewrite with them
+    QString _entitiesFileHash;
+    QString _manifestPath;
+    QHash<QString, BakeResult> _resumedResults;
+    QMultiHash<QString, QUrl> _resumedRewriteKeys;
+
     QMultiHash<QUrl, std::pair<QString, QJsonValueRef>> _entitiesNeedingRewrite;
 
     int _totalNumberOfSubBakes { 0 };
     int _completedSubBakes { 0 };
+    int _resumedSubBakes { 0 };
+    int _failedSubBakes { 0 };
+    // URLs that turned out to have the same content as another one, and share its bake
+    int _deduplicatedSources { 0 };
+    int _completedByType[NUM_BAKE_TYPES] {};
+    qint64 _bakeMsecsByType[NUM_BAKE_TYPES] {};
+
+    QElapsedTimer _bakeTimer;
+    QPointer<QTimer> _progressTimer;
 
     bool _shouldRebakeOriginals { false };
 
@@ -94,13 +94,17 @@ QThread* Oven::getNextWorkerThread() {
     // (for the FBX Baker Thread to have room), and cycle through them to hand a usable running thread back to our callers.
 
     auto nextIndex = ++_nextWorkerThreadIndex;
-    auto& nextThread = _workerThreads[nextIndex % _workerThreads.size()];
+    return getWorkerThread(nextIndex % _workerThreads.size());
+}
+
+QThread* Oven::getWorkerThread(int index) {
+    auto& thread = _workerThreads[index];
 
     // start the thread if it isn't running yet
-    if (!nextThread->isRunning()) {
-        nextThread->start();
+    if (!thread->isRunning()) {
+        thread->start();
     }
 
-    return nextThread.get();
+    return thread.get();
 }
 
@@ -28,6 +28,10 @@ public:
 
     QThread* getNextWorkerThread();
 
+    int getNumWorkerThreads() const { return (int)_workerThreads.size(); }
+    // the worker thread at the index, started if it isn't running yet
+    QThread* getWorkerThread(int index);
+
 private:
     void setupWorkerThreads(int numWorkerThreads);
     void setupFBXBakerThread();
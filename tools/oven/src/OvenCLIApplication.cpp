@@ -17,6 +17,7 @@
 #include <iostream>
 
 #include <image/TextureProcessing.h>
+#include <ModelBaker.h>
 #include <TextureBaker.h>
 
 #include "BakerCLI.h"
@@ -25,6 +26,9 @@ static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_TEXTURE_PROFILE_PARAMETER = "texture-profile";
+static const QString CLI_DRACO_PROFILE_PARAMETER = "draco-profile";
+static const QString CLI_DRACO_LARGE_MESH_PROFILE_PARAMETER = "draco-large-mesh-profile";
 
 QUrl OvenCLIApplication::_inputUrlParameter;
 QUrl OvenCLIApplication::_outputUrlParameter;
@@ -47,7 +51,10 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_TEXTURE_PROFILE_PARAMETER, "Clients to bake textures for. [all|desktop|mobile|web]", "profile" },
+        { CLI_DRACO_PROFILE_PARAMETER, "Draco mesh compression profile. [compact|balanced|fastDecode|mobile]", "profile" },
+        { CLI_DRACO_LARGE_MESH_PROFILE_PARAMETER, "Draco mesh compression profile of the meshes of 50000 triangles or more.", "profile" }
     });
 
     auto versionOption = parser.addVersionOption();
@@ -91,4 +98,21 @@ void OvenCLIApplication::parseCommandLine(int argc, char* argv[]) {
         qDebug() << "Disabling texture compression";
         TextureBaker::setCompressionEnabled(false);
     }
+
+    if (parser.isSet(CLI_TEXTURE_PROFILE_PARAMETER) && !TextureBaker::setProfile(parser.value(CLI_TEXTURE_PROFILE_PARAMETER))) {
+        std::cout << "Error: Unknown texture profile" << std::endl; // Avoid Qt log spam
+        QCoreApplication mockApp(argc, argv); // required for call to showHelp()
+        parser.showHelp();
+        Q_UNREACHABLE();
+    }
+
+    if (parser.isSet(CLI_DRACO_PROFILE_PARAMETER) || parser.isSet(CLI_DRACO_LARGE_MESH_PROFILE_PARAMETER)) {
+        QString profile = parser.isSet(CLI_DRACO_PROFILE_PARAMETER) ? parser.value(CLI_DRACO_PROFILE_PARAMETER) : "balanced";
+        if (!ModelBaker::setDracoProfiles(profile, parser.value(CLI_DRACO_LARGE_MESH_PROFILE_PARAMETER))) {
+            std::cout << "Error: Unknown Draco profile" << std::endl; // Avoid Qt log spam
+            QCoreApplication mockApp(argc, argv); // required for call to showHelp()
+            parser.showHelp();
+            Q_UNREACHABLE();
+        }
+    }
 }
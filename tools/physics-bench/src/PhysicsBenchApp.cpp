@@ -0,0 +1,309 @@
+//
+//  PhysicsBenchApp.cpp
+//  tools/physics-bench/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PhysicsBenchApp.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QFile>
+#include <QJsonDocument>
+
+#include <LinearMath/btQuickprof.h>
+
+#include <GLMHelpers.h>
+#include <NumericalConstants.h>
+#include <PhysicsEngine.h>
+#include <PhysicsHelpers.h>
+#include <ShapeFactory.h>
+#include <ShapeManager.h>
+#include <SharedUtil.h>
+
+#include "SnapshotMotionState.h"
+
+namespace {
+    double mean(const std::vector<quint64>& values) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        double sum = 0.0;
+        for (auto value : values) {
+            sum += (double)value;
+        }
+        return sum / (double)values.size();
+    }
+
+    double percentile(std::vector<quint64> values, double fraction) {
+        if (values.empty()) {
+            return 0.0;
+        }
+        std::sort(values.begin(), values.end());
+        size_t index = std::min(values.size() - 1, (size_t)(fraction * (double)(values.size() - 1) + 0.5));
+        return (double)values[index];
+    }
+
+    // adds up the time of the blocks Bullet profiled under the name, anywhere below the iterator's parent, in usecs
+    double sumProfiledUsecs(CProfileIterator* itr, const char* name) {
+        double usecs = 0.0;
+        int32_t numChildren = 0;
+        for (itr->First(); !itr->Is_Done(); itr->Next()) {
+            if (strcmp(itr->Get_Current_Name(), name) == 0) {
+                usecs += (double)USECS_PER_MSEC * itr->Get_Current_Total_Time();
+            }
+            ++numChildren;
+        }
+        for (int32_t i = 0; i < numChildren; ++i) {
+            itr->Enter_Child(i);
+            usecs += sumProfiledUsecs(itr, name);
+            itr->Enter_Parent();
+        }
+        return usecs;
+    }
+
+    QJsonObject summarize(const std::vector<quint64>& usecs) {
+        QJsonObject summary;
+        summary["mean"] = mean(usecs);
+        summary["p50"] = percentile(usecs, 0.5);
+        summary["p95"] = percentile(usecs, 0.95);
+        summary["max"] = percentile(usecs, 1.0);
+        return summary;
+    }
+}
+
+PhysicsBenchApp::PhysicsBenchApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Physics Snapshot Replay Benchmark");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption stepsOption("steps", "number of measured substeps", "count", "600");
+    parser.addOption(stepsOption);
+    const QCommandLineOption warmupOption("warmup", "number of substeps run before measuring", "count", "60");
+    parser.addOption(warmupOption);
+    const QCommandLineOption threadsOption("threads", "number of threads solving simulation islands", "count", "1");
+    parser.addOption(threadsOption);
+    const QCommandLineOption checkOption("check", "replay twice and fail if the bodies don't end up in the same place");
+    parser.addOption(checkOption);
+    const QCommandLineOption jsonOption("json", "write the report to a JSON file", "filename.json");
+    parser.addOption(jsonOption);
+    parser.addPositionalArgument("snapshot", "a snapshot saved by Test.savePhysicsSnapshot()");
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    const QStringList args = parser.positionalArguments();
+    if (args.size() != 1) {
+        qCritical() << "Expected one snapshot to replay";
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    _config.numSteps = std::max(1, parser.value(stepsOption).toInt());
+    _config.numWarmupSteps = std::max(0, parser.value(warmupOption).toInt());
+    _config.numThreads = std::max(1, parser.value(threadsOption).toInt());
+
+    PhysicsSnapshot snapshot;
+    if (!snapshot.load(args[0])) {
+        _returnCode = 2;
+        return;
+    }
+
+    ShapeManager shapeManager;
+    ObjectMotionState::setShapeManager(&shapeManager);
+
+    Result result;
+    if (!replay(snapshot, result)) {
+        _returnCode = 3;
+        return;
+    }
+    if (!result.isProfiled) {
+        qWarning() << "Bullet was built without profiling, so only the substep and harvest times are known";
+    }
+
+    bool isDeterministic = true;
+    if (parser.isSet(checkOption)) {
+        Result otherResult;
+        replay(snapshot, otherResult);
+        isDeterministic = otherResult.transforms == result.transforms;
+        if (!isDeterministic) {
+            qCritical() << "The bodies ended up elsewhere when the snapshot was replayed again";
+            _returnCode = 4;
+        }
+    }
+
+    QJsonObject fullReport = report(snapshot, result);
+    if (parser.isSet(checkOption)) {
+        fullReport["deterministic"] = isDeterministic;
+    }
+
+    if (parser.isSet(jsonOption)) {
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly)) {
+            qCritical() << "Failed to write report" << file.fileName();
+            _returnCode = 2;
+            return;
+        }
+        file.write(QJsonDocument(fullReport).toJson());
+    }
+}
+
+bool PhysicsBenchApp::replay(const PhysicsSnapshot& snapshot, Result& result) const {
+    std::vector<const btCollisionShape*> shapes;
+    shapes.reserve(snapshot.shapes.size());
+    for (const auto& data : snapshot.shapes) {
+        const btCollisionShape* shape = ShapeFactory::deserializeShape(data);
+        if (!shape) {
+            qCritical() << "Snapshot shape" << shapes.size() << "can't be read";
+            for (auto readShape : shapes) {
+                ShapeFactory::deleteShape(readShape);
+            }
+            return false;
+        }
+        shapes.push_back(shape);
+    }
+
+    PhysicsEngine engine(Vectors::ZERO);
+    engine.init();
+    engine.setNumPhysicsThreads(_config.numThreads);
+
+    std::vector<std::unique_ptr<SnapshotMotionState>> motionStates;
+    motionStates.reserve(snapshot.bodies.size());
+    PhysicsEngine::Transaction transaction;
+    for (const auto& body : snapshot.bodies) {
+        motionStates.emplace_back(new SnapshotMotionState(shapes[body.shape], body));
+        transaction.objectsToAdd.push_back(motionStates.back().get());
+    }
+    engine.processTransaction(transaction);
+    transaction.clear();
+    for (size_t i = 0; i < motionStates.size(); ++i) {
+        // the engine puts the bodies that aren't moving to sleep, but some were waiting to
+        motionStates[i]->getRigidBody()->forceActivationState(snapshot.bodies[i].activationState);
+    }
+
+    std::vector<std::unique_ptr<btTypedConstraint>> constraints;
+    for (const auto& constraint : snapshot.constraints) {
+        btRigidBody& bodyA = constraint.bodyA == PhysicsSnapshot::FIXED_BODY ? btTypedConstraint::getFixedBody()
+                                                                              : *motionStates[constraint.bodyA]->getRigidBody();
+        btRigidBody& bodyB = constraint.bodyB == PhysicsSnapshot::FIXED_BODY ? btTypedConstraint::getFixedBody()
+                                                                              : *motionStates[constraint.bodyB]->getRigidBody();
+        btTypedConstraint* typedConstraint = PhysicsSnapshot::createConstraint(constraint, bodyA, bodyB);
+        if (typedConstraint) {
+            engine.getDynamicsWorld()->addConstraint(typedConstraint, constraint.disableCollisions);
+            constraints.emplace_back(typedConstraint);
+        }
+    }
+
+    int numSteps = _config.numWarmupSteps + _config.numSteps;
+    result.stepUsecs.reserve(_config.numSteps);
+    for (int step = 0; step < numSteps; ++step) {
+        quint64 start = usecTimestampNow();
+        engine.stepSimulation(PHYSICS_ENGINE_FIXED_SUBSTEP);
+        quint64 stepEnd = usecTimestampNow();
+        const VectorOfMotionStates& changedMotionStates = engine.getChangedMotionStates();
+        quint64 harvestEnd = usecTimestampNow();
+        if (step < _config.numWarmupSteps) {
+            continue;
+        }
+
+        // the profile holds this step alone, as stepSimulation() resets it
+        CProfileIterator* itr = CProfileManager::Get_Iterator();
+        double broadphase = sumProfiledUsecs(itr, "updateAabbs") + sumProfiledUsecs(itr, "calculateOverlappingPairs");
+        double narrowphase = sumProfiledUsecs(itr, "dispatchAllCollisionPairs");
+        double solver = sumProfiledUsecs(itr, "solveConstraints");
+        result.isProfiled = result.isProfiled || sumProfiledUsecs(itr, "stepSimulation") > 0.0;
+        CProfileManager::Release_Iterator(itr);
+
+        quint64 stepUsecs = stepEnd - start;
+        quint64 phaseUsecs = (quint64)(broadphase + narrowphase + solver);
+        result.stepUsecs.push_back(stepUsecs);
+        result.broadphaseUsecs.push_back((quint64)broadphase);
+        result.narrowphaseUsecs.push_back((quint64)narrowphase);
+        result.solverUsecs.push_back((quint64)solver);
+        result.otherUsecs.push_back(stepUsecs > phaseUsecs ? stepUsecs - phaseUsecs : 0);
+        result.harvestUsecs.push_back(harvestEnd - stepEnd);
+        result.numChangedMotionStates += changedMotionStates.size() + engine.getMotionStateBuffer().size();
+    }
+
+    result.transforms.reserve(motionStates.size());
+    for (const auto& motionState : motionStates) {
+        result.transforms.push_back(motionState->getRigidBody()->getWorldTransform());
+    }
+
+    for (const auto& constraint : constraints) {
+        engine.getDynamicsWorld()->removeConstraint(constraint.get());
+    }
+    constraints.clear();
+    for (const auto& motionState : motionStates) {
+        transaction.objectsToRemove.push_back(motionState.get());
+    }
+    engine.processTransaction(transaction);
+    // the ShapeManager doesn't know the shapes, which are deleted here instead
+    motionStates.clear();
+    for (auto shape : shapes) {
+        ShapeFactory::deleteShape(shape);
+    }
+    return true;
+}
+
+QJsonObject PhysicsBenchApp::report(const PhysicsSnapshot& snapshot, const Result& result) const {
+    QJsonObject config;
+    config["steps"] = _config.numSteps;
+    config["warmup"] = _config.numWarmupSteps;
+    config["threads"] = _config.numThreads;
+    config["bodies"] = (int)snapshot.bodies.size();
+    config["constraints"] = (int)snapshot.constraints.size();
+    config["skippedObjects"] = (int)snapshot.numSkippedObjects;
+    config["skippedConstraints"] = (int)snapshot.numSkippedConstraints;
+
+    QJsonObject substep;
+    substep["total"] = summarize(result.stepUsecs);
+    substep["broadphase"] = summarize(result.broadphaseUsecs);
+    substep["narrowphase"] = summarize(result.narrowphaseUsecs);
+    substep["solver"] = summarize(result.solverUsecs);
+    substep["other"] = summarize(result.otherUsecs);
+    substep["harvest"] = summarize(result.harvestUsecs);
+
+    QJsonObject report;
+    report["config"] = config;
+    report["substepUsecs"] = substep;
+    report["changedMotionStatesPerStep"] = (double)result.numChangedMotionStates / (double)std::max((size_t)1, result.stepUsecs.size());
+    report["profiled"] = result.isProfiled;
+
+    qInfo().noquote() << QString("%1 bodies, %2 constraints, %3 substeps on %4 threads")
+        .arg(snapshot.bodies.size()).arg(snapshot.constraints.size()).arg(result.stepUsecs.size()).arg(_config.numThreads);
+    if (snapshot.numSkippedObjects > 0 || snapshot.numSkippedConstraints > 0) {
+        qInfo().noquote() << QString("  not in the snapshot: %1 objects, %2 constraints")
+            .arg(snapshot.numSkippedObjects).arg(snapshot.numSkippedConstraints);
+    }
+    for (const char* phase : { "total", "broadphase", "narrowphase", "solver", "other", "harvest" }) {
+        QJsonObject summary = substep[phase].toObject();
+        qInfo().noquote() << QString("  %1 usecs: mean %2  p50 %3  p95 %4  max %5").arg(phase, -11)
+            .arg(summary["mean"].toDouble(), 0, 'f', 1).arg(summary["p50"].toDouble(), 0, 'f', 0)
+            .arg(summary["p95"].toDouble(), 0, 'f', 0).arg(summary["max"].toDouble(), 0, 'f', 0);
+    }
+    qInfo().noquote() << QString("  %1 changed motion states per substep")
+        .arg(report["changedMotionStatesPerStep"].toDouble(), 0, 'f', 1);
+    return report;
+}
@@ -0,0 +1,62 @@
+//
+//  PhysicsBenchApp.h
+//  tools/physics-bench/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_PhysicsBenchApp_h
+#define hifi_PhysicsBenchApp_h
+
+#include <vector>
+
+#include <QCoreApplication>
+#include <QJsonObject>
+
+#include <btBulletDynamicsCommon.h>
+
+#include <PhysicsSnapshot.h>
+
+// Replays a PhysicsSnapshot, as saved by Test.savePhysicsSnapshot(), in a PhysicsEngine of its own without rendering or
+// a network, one fixed substep at a time.  Reports the time of each substep split into broadphase, narrowphase, solver
+// and the rest, and of gathering the changed motion states afterwards.  With one thread the replay is deterministic,
+// which --check verifies by replaying the snapshot twice.
+class PhysicsBenchApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    PhysicsBenchApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+    struct Config {
+        int numSteps { 600 };
+        int numWarmupSteps { 60 };
+        int numThreads { 1 };
+    };
+
+    struct Result {
+        std::vector<quint64> stepUsecs;
+        std::vector<quint64> broadphaseUsecs;
+        std::vector<quint64> narrowphaseUsecs;
+        std::vector<quint64> solverUsecs;
+        std::vector<quint64> otherUsecs;
+        std::vector<quint64> harvestUsecs;
+        quint64 numChangedMotionStates { 0 };
+        // of each body, after the last step
+        std::vector<btTransform> transforms;
+        bool isProfiled { false };
+    };
+
+private:
+    bool replay(const PhysicsSnapshot& snapshot, Result& result) const;
+    QJsonObject report(const PhysicsSnapshot& snapshot, const Result& result) const;
+
+    Config _config;
+    int _returnCode { 0 };
+};
+
+#endif // hifi_PhysicsBenchApp_h
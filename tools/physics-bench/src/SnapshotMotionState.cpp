@@ -0,0 +1,71 @@
+//
+//  SnapshotMotionState.cpp
+//  tools/physics-bench/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SnapshotMotionState.h"
+
+#include <LinearMath/btTransformUtil.h>
+
+#include <BulletUtil.h>
+#include <PhysicsHelpers.h>
+
+SnapshotMotionState::SnapshotMotionState(const btCollisionShape* shape, const PhysicsSnapshot::Body& body) :
+    ObjectMotionState(shape),
+    _snapshotBody(body),
+    _transform(body.transform) {
+    // so that the results are gathered in bulk, as the entities' are
+    _type = MOTIONSTATE_TYPE_ENTITY;
+}
+
+void SnapshotMotionState::getWorldTransform(btTransform& worldTrans) const {
+    if (_motionType == MOTION_TYPE_KINEMATIC) {
+        uint32_t thisStep = ObjectMotionState::getWorldSimulationStep();
+        float dt = (thisStep - _lastKinematicStep) * PHYSICS_ENGINE_FIXED_SUBSTEP;
+        _lastKinematicStep = thisStep;
+        btTransform nextTransform;
+        btTransformUtil::integrateTransform(_transform, _snapshotBody.linearVelocity, _snapshotBody.angularVelocity, dt,
+                                            nextTransform);
+        _transform = nextTransform;
+    }
+    worldTrans = _transform;
+}
+
+void SnapshotMotionState::setWorldTransform(const btTransform& worldTrans) {
+    _transform = worldTrans;
+}
+
+bool SnapshotMotionState::isMoving() const {
+    return _snapshotBody.activationState != ISLAND_SLEEPING;
+}
+
+glm::vec3 SnapshotMotionState::getObjectPosition() const {
+    return bulletToGLM(_transform.getOrigin());
+}
+
+glm::quat SnapshotMotionState::getObjectRotation() const {
+    return bulletToGLM(_transform.getRotation());
+}
+
+glm::vec3 SnapshotMotionState::getObjectLinearVelocity() const {
+    return bulletToGLM(_snapshotBody.linearVelocity);
+}
+
+glm::vec3 SnapshotMotionState::getObjectAngularVelocity() const {
+    return bulletToGLM(_snapshotBody.angularVelocity);
+}
+
+glm::vec3 SnapshotMotionState::getObjectGravity() const {
+    return bulletToGLM(_snapshotBody.gravity);
+}
+
+void SnapshotMotionState::computeCollisionGroupAndMask(int32_t& group, int32_t& mask) const {
+    group = _snapshotBody.group;
+    mask = _snapshotBody.mask;
+}
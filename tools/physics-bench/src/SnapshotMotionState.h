@@ -0,0 +1,58 @@
+//
+//  SnapshotMotionState.h
+//  tools/physics-bench/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_SnapshotMotionState_h
+#define hifi_SnapshotMotionState_h
+
+#include <ObjectMotionState.h>
+#include <PhysicsSnapshot.h>
+
+// Stands in for the EntityMotionState of a body in a PhysicsSnapshot, so that the PhysicsEngine adds it as it would
+// have added the entity's.  Kinematic bodies move by their velocities, without the gravity or damping an entity
+// would have applied.
+class SnapshotMotionState : public ObjectMotionState {
+public:
+    SnapshotMotionState(const btCollisionShape* shape, const PhysicsSnapshot::Body& body);
+
+    void getWorldTransform(btTransform& worldTrans) const override;
+    void setWorldTransform(const btTransform& worldTrans) override;
+
+    uint32_t getIncomingDirtyFlags() const override { return 0; }
+    void clearIncomingDirtyFlags(uint32_t mask) override { }
+    PhysicsMotionType computePhysicsMotionType() const override { return _snapshotBody.motionType; }
+    bool isMoving() const override;
+
+    float getMass() const override { return _snapshotBody.mass; }
+    float getObjectRestitution() const override { return _snapshotBody.restitution; }
+    float getObjectFriction() const override { return _snapshotBody.friction; }
+    float getObjectLinearDamping() const override { return _snapshotBody.linearDamping; }
+    float getObjectAngularDamping() const override { return _snapshotBody.angularDamping; }
+
+    glm::vec3 getObjectPosition() const override;
+    glm::quat getObjectRotation() const override;
+    glm::vec3 getObjectLinearVelocity() const override;
+    glm::vec3 getObjectAngularVelocity() const override;
+    glm::vec3 getObjectGravity() const override;
+
+    const QUuid getObjectID() const override { return QUuid(); }
+    QUuid getSimulatorID() const override { return QUuid(); }
+    ShapeType getShapeType() const override { return SHAPE_TYPE_NONE; }
+
+    void computeCollisionGroupAndMask(int32_t& group, int32_t& mask) const override;
+
+    const btTransform& getTransform() const { return _transform; }
+
+private:
+    PhysicsSnapshot::Body _snapshotBody;
+    mutable btTransform _transform;
+};
+
+#endif // hifi_SnapshotMotionState_h
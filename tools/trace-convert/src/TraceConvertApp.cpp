@@ -0,0 +1,61 @@
+//
+//  TraceConvertApp.cpp
+//  tools/trace-convert/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "TraceConvertApp.h"
+
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QFileInfo>
+
+#include <Trace.h>
+
+TraceConvertApp::TraceConvertApp(int argc, char* argv[]) : QCoreApplication(argc, argv) {
+
+    // parse command-line
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Convert binary traces to Chrome trace JSON");
+    const QCommandLineOption helpOption = parser.addHelpOption();
+
+    const QCommandLineOption inputFilenameOption("i", "input binary trace", "filename.hftrace");
+    parser.addOption(inputFilenameOption);
+
+    const QCommandLineOption outputFilenameOption("o", "output JSON, gzipped if it ends in .gz", "filename.json");
+    parser.addOption(outputFilenameOption);
+
+    if (!parser.parse(QCoreApplication::arguments())) {
+        qCritical() << parser.errorText() << Qt::endl;
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (parser.isSet(helpOption)) {
+        parser.showHelp();
+        return;
+    }
+
+    QString inputFilename = parser.value(inputFilenameOption);
+    QString outputFilename = parser.value(outputFilenameOption);
+    if (inputFilename.isEmpty() || outputFilename.isEmpty()) {
+        parser.showHelp();
+        _returnCode = 1;
+        return;
+    }
+
+    if (!tracing::Tracer::binaryTraceToJson(inputFilename, outputFilename)) {
+        qCritical() << "Failed to convert" << inputFilename;
+        _returnCode = 2;
+        return;
+    }
+
+    qInfo() << "Converted" << inputFilename << "(" << QFileInfo(inputFilename).size() << "bytes) to" << outputFilename
+            << "(" << QFileInfo(outputFilename).size() << "bytes)";
+}
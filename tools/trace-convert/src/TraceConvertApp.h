@@ -0,0 +1,29 @@
+//
+//  TraceConvertApp.h
+//  tools/trace-convert/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef hifi_TraceConvertApp_h
+#define hifi_TraceConvertApp_h
+
+#include <QCoreApplication>
+
+// Converts the binary traces servers stream with HIFI_TRACE_DIRECTORY set to Chrome trace JSON.
+class TraceConvertApp : public QCoreApplication {
+    Q_OBJECT
+public:
+    TraceConvertApp(int argc, char* argv[]);
+
+    int getReturnCode() const { return _returnCode; }
+
+private:
+    int _returnCode { 0 };
+};
+
+#endif //hifi_TraceConvertApp_h
@@ -0,0 +1,90 @@
+//
+//  ImpairedRelay.cpp
+//  tools/udt-test/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "ImpairedRelay.h"
+
+#include <algorithm>
+
+#include <QtCore/QDebug>
+
+ImpairedRelay::ImpairedRelay(quint16 port, const QHostAddress& targetAddress, quint16 targetPort, double lossRate,
+                             int delayMsecs, QObject* parent) :
+    QObject(parent),
+    _targetAddress(targetAddress),
+    _targetPort(targetPort),
+    _lossRate(lossRate),
+    _delay(delayMsecs)
+{
+    _socket.bind(QHostAddress::AnyIPv4, port);
+    connect(&_socket, &QUdpSocket::readyRead, this, &ImpairedRelay::readPendingDatagrams);
+
+    // the default coarse timers could be off by 5% of the delay, which would show up as jitter
+    _sendTimer.setTimerType(Qt::PreciseTimer);
+    _sendTimer.setSingleShot(true);
+    connect(&_sendTimer, &QTimer::timeout, this, &ImpairedRelay::sendDueDatagrams);
+}
+
+void ImpairedRelay::readPendingDatagrams() {
+    while (_socket.hasPendingDatagrams()) {
+        QByteArray data;
+        data.resize(_socket.pendingDatagramSize());
+
+        QHostAddress address;
+        quint16 port;
+        if (_socket.readDatagram(data.data(), data.size(), &address, &port) < 0) {
+            continue;
+        }
+
+        if (_lossDistribution(_generator) < _lossRate) {
+            ++_numLost;
+            continue;
+        }
+        ++_numRelayed;
+
+        DelayedDatagram datagram { Clock::now() + _delay, data, _targetAddress, _targetPort };
+        if (address.isEqual(_targetAddress, QHostAddress::ConvertV4MappedToIPv4) && port == _targetPort) {
+            if (_senderPort == 0) {
+                // nobody to send the reply to yet
+                continue;
+            }
+            datagram.address = _senderAddress;
+            datagram.port = _senderPort;
+        } else {
+            _senderAddress = address;
+            _senderPort = port;
+        }
+
+        _delayedDatagrams.push_back(datagram);
+    }
+
+    sendDueDatagrams();
+}
+
+void ImpairedRelay::sendDueDatagrams() {
+    auto now = Clock::now();
+    while (!_delayedDatagrams.empty() && _delayedDatagrams.front().dueTime <= now) {
+        auto& datagram = _delayedDatagrams.front();
+        _socket.writeDatagram(datagram.data, datagram.address, datagram.port);
+        _delayedDatagrams.pop_front();
+    }
+
+    if (!_delayedDatagrams.empty()) {
+        auto untilDue = std::chrono::duration_cast<std::chrono::milliseconds>(_delayedDatagrams.front().dueTime - now);
+        _sendTimer.start(std::max(0, (int)untilDue.count()));
+    }
+
+    static const int STATS_INTERVAL_DATAGRAMS = 10000;
+    if (_numRelayed >= STATS_INTERVAL_DATAGRAMS) {
+        qDebug() << "Relayed" << _numRelayed << "datagrams and lost" << _numLost;
+        _numRelayed = 0;
+        _numLost = 0;
+    }
+}
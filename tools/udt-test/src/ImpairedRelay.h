@@ -0,0 +1,71 @@
+//
+//  ImpairedRelay.h
+//  tools/udt-test/src
+//
+//  Created by Vircadia contributors on 2026-10-14.
+//  Copyright 2026 Vircadia contributors.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#pragma once
+
+#ifndef hifi_ImpairedRelay_h
+#define hifi_ImpairedRelay_h
+
+#include <chrono>
+#include <deque>
+#include <random>
+
+#include <QtCore/QObject>
+#include <QtCore/QTimer>
+#include <QtNetwork/QHostAddress>
+#include <QtNetwork/QUdpSocket>
+
+/// Forwards datagrams between the sender that reaches it and a receiver, losing and delaying them on the way, so that
+/// congestion controls can be compared over a bad link on a single machine
+class ImpairedRelay : public QObject {
+    Q_OBJECT
+public:
+    ImpairedRelay(quint16 port, const QHostAddress& targetAddress, quint16 targetPort, double lossRate, int delayMsecs,
+                  QObject* parent = nullptr);
+
+    quint16 localPort() const { return _socket.localPort(); }
+
+private slots:
+    void readPendingDatagrams();
+    void sendDueDatagrams();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct DelayedDatagram {
+        Clock::time_point dueTime;
+        QByteArray data;
+        QHostAddress address;
+        quint16 port;
+    };
+
+    QUdpSocket _socket;
+    QHostAddress _targetAddress;
+    quint16 _targetPort;
+
+    // replies from the target go back to whoever sent to it last
+    QHostAddress _senderAddress;
+    quint16 _senderPort { 0 };
+
+    double _lossRate;
+    std::chrono::milliseconds _delay;
+
+    std::deque<DelayedDatagram> _delayedDatagrams; // in due order, since every datagram is delayed as much
+    QTimer _sendTimer;
+
+    std::mt19937 _generator { std::random_device()() };
+    std::uniform_real_distribution<double> _lossDistribution { 0.0, 1.0 };
+
+    int _numRelayed { 0 };
+    int _numLost { 0 };
+};
+
+#endif // hifi_ImpairedRelay_h
@@ -13,6 +13,9 @@
 
 #include "UDTTest.h"
 
+#include <algorithm>
+#include <chrono>
+
 #include <QtCore/QDebug>
 
 #include <udt/Constants.h>
@@ -21,6 +24,8 @@
 
 #include <LogHandler.h>
 
+#include "ImpairedRelay.h"
+
 const QCommandLineOption PORT_OPTION { "p", "listening port for socket (defaults to random)", "port", 0 };
 const QCommandLineOption TARGET_OPTION {
     "target", "target for sent packets (default is listen only)",
@@ -57,6 +62,26 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption MESSAGE_PRIORITY {
+    "message-priority", "priority of the ordered messages, urgent, normal or bulk (default is normal)", "priority"
+};
+const QCommandLineOption URGENT_INTERVAL {
+    "urgent-interval", "also send a small timestamped reliable packet this often, the receiver reports its latency",
+    "milliseconds"
+};
+const QCommandLineOption CONGESTION_CONTROL {
+    "congestion-control", "congestion control for sent packets, vegas or bbr (default is vegas)", "name"
+};
+const QCommandLineOption RELAY_TARGET {
+    "relay-to", "relay datagrams between a sender and this target, with --loss and --delay, instead of testing",
+    "IP:PORT"
+};
+const QCommandLineOption RELAY_LOSS {
+    "loss", "percentage of relayed datagrams to drop (default is 0)", "percent"
+};
+const QCommandLineOption RELAY_DELAY {
+    "delay", "delay added to relayed datagrams, each way (default is 0ms)", "milliseconds"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
@@ -65,13 +90,57 @@ const QStringList CLIENT_STATS_TABLE_HEADERS {
 
 const QStringList SERVER_STATS_TABLE_HEADERS {
     "  Mb/s  ", "Recv Mb/s", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)",
-    "Sent ACK", "Duplicates (P)"
+    "Sent ACK", "Duplicates (P)", "Urgent p50 (ms)", "Urgent p99 (ms)"
 };
 
+// the urgent packets are told apart from the bulk ones by their size and this leading value
+static const uint64_t URGENT_PACKET_MAGIC = 0x5544542d55524745;
+static const int URGENT_PACKET_PAYLOAD_SIZE = sizeof(uint64_t) + sizeof(int64_t);
+
+static int64_t usecTimestampNow() {
+    // sender and receiver have to run on the same machine (through a relay) for these to be comparable
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
 UDTTest::UDTTest(int& argc, char** argv) :
     QCoreApplication(argc, argv)
 {
     parseArguments();
+
+    if (_argumentParser.isSet(RELAY_TARGET)) {
+        // run senders with different congestion controls through a relay in turn to compare them over a bad link
+        QString hostnamePortString = _argumentParser.value(RELAY_TARGET);
+
+        QHostAddress address { hostnamePortString.left(hostnamePortString.indexOf(':')) };
+        quint16 port { (quint16) hostnamePortString.mid(hostnamePortString.indexOf(':') + 1).toUInt() };
+
+        if (address.isNull() || port == 0) {
+            qCritical() << "Could not parse an IP address and port combination from" << hostnamePortString;
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+            return;
+        }
+
+        static const double PERCENT = 100.0;
+        double lossRate = _argumentParser.value(RELAY_LOSS).toDouble() / PERCENT;
+        int delayMsecs = _argumentParser.value(RELAY_DELAY).toInt();
+
+        _relay = new ImpairedRelay(_argumentParser.value(PORT_OPTION).toUInt(), address, port, lossRate, delayMsecs, this);
+        qDebug() << "Relaying on" << _relay->localPort() << "to" << hostnamePortString << "with"
+            << lossRate * PERCENT << "% loss and" << delayMsecs << "ms delay";
+        return;
+    }
+
+    if (_argumentParser.isSet(CONGESTION_CONTROL)) {
+        auto ccFactory = udt::createCongestionControlFactory(_argumentParser.value(CONGESTION_CONTROL));
+        if (!ccFactory) {
+            qCritical() << "Unknown congestion control" << _argumentParser.value(CONGESTION_CONTROL);
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        } else {
+            qDebug() << "Using congestion control" << _argumentParser.value(CONGESTION_CONTROL);
+            _socket.setCongestionControlFactory(std::move(ccFactory));
+        }
+    }
     
     // randomize the seed for packet size randomization
     srand(time(NULL));
@@ -145,6 +214,18 @@ UDTTest::UDTTest(int& argc, char** argv) :
         _sendOrdered = true;
     }
     
+    if (_argumentParser.isSet(MESSAGE_PRIORITY)) {
+        QString priority = _argumentParser.value(MESSAGE_PRIORITY);
+        if (priority == "urgent") {
+            _messagePriority = udt::Packet::Priority::Urgent;
+        } else if (priority == "bulk") {
+            _messagePriority = udt::Packet::Priority::Bulk;
+        } else if (priority != "normal") {
+            qCritical() << "Unknown message priority" << priority;
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+    }
+
     if (_argumentParser.isSet(MESSAGE_SIZE)) {
         if (_argumentParser.isSet(ORDERED_PACKETS)) {
             static const double BYTES_PER_MEGABYTE = 1000000;
@@ -171,7 +252,25 @@ UDTTest::UDTTest(int& argc, char** argv) :
     
     if (!_target.isNull()) {
         sendInitialPackets();
+
+        if (_argumentParser.isSet(URGENT_INTERVAL)) {
+            QTimer* urgentTimer = new QTimer(this);
+            urgentTimer->setTimerType(Qt::PreciseTimer);
+            connect(urgentTimer, &QTimer::timeout, this, &UDTTest::sendUrgentPacket);
+            urgentTimer->start(_argumentParser.value(URGENT_INTERVAL).toInt());
+        }
     } else {
+        // the latency of the urgent packets sent along the test ones shows how much the bulk holds them up
+        _socket.setPacketHandler([this](std::unique_ptr<udt::Packet> packet) {
+            uint64_t magic = 0;
+            if (packet->getPayloadSize() == URGENT_PACKET_PAYLOAD_SIZE && packet->readPrimitive(&magic) == sizeof(magic)
+                && magic == URGENT_PACKET_MAGIC) {
+                int64_t sentTimestamp = 0;
+                packet->readPrimitive(&sentTimestamp);
+                _urgentLatencies.push_back(usecTimestampNow() - sentTimestamp);
+            }
+        });
+
         // this is a receiver - in case there are ordered packets (messages) being sent to us make sure that we handle them
         // so that they can be verified
         _socket.setMessageHandler(
@@ -226,7 +325,8 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, MESSAGE_PRIORITY, URGENT_INTERVAL, CONGESTION_CONTROL,
+        RELAY_TARGET, RELAY_LOSS, RELAY_DELAY
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -293,6 +393,7 @@ void UDTTest::sendPacket() {
         if (call++ % refillCount == 0) {
             // construct a reliable and ordered packet list
             auto packetList = udt::PacketList::create(PacketType::BulkAvatarData, QByteArray(), true, true);
+            packetList->setPriority(_messagePriority);
             
             // fill the packet list with random data according to the constant seed (so receiver can verify)
             for (int i = 0; i < messageSizePackets; ++i) {
@@ -333,6 +434,14 @@ void UDTTest::sendPacket() {
     
 }
 
+void UDTTest::sendUrgentPacket() {
+    auto packet = udt::Packet::create(URGENT_PACKET_PAYLOAD_SIZE, true);
+    packet->writePrimitive(URGENT_PACKET_MAGIC);
+    packet->writePrimitive(usecTimestampNow());
+
+    _socket.writePacket(std::move(packet), _target);
+}
+
 void UDTTest::handleMessage(std::unique_ptr<Message> message) {
     // generate the byte array that should match this message - using the same seed the sender did
     
@@ -407,6 +516,19 @@ void UDTTest::sampleStats() {
             int headerIndex = -1;
             
             double megabitsPerSecond = (stats.receivedBytes * MEGABITS_PER_BYTE * MS_PER_SECOND) / _statsInterval;
+
+            QString urgentP50 = "-";
+            QString urgentP99 = "-";
+            if (!_urgentLatencies.empty()) {
+                std::sort(_urgentLatencies.begin(), _urgentLatencies.end());
+                auto percentile = [this](double fraction) {
+                    auto index = std::min(_urgentLatencies.size() - 1, (size_t)(fraction * _urgentLatencies.size()));
+                    return QString::number(_urgentLatencies[index] / USECS_PER_MSEC, 'f', 2);
+                };
+                urgentP50 = percentile(0.50);
+                urgentP99 = percentile(0.99);
+                _urgentLatencies.clear();
+            }
             
             // setup a list of left justified values
             QStringList values {
@@ -416,7 +538,9 @@ void UDTTest::sampleStats() {
                 QString::number(stats.rtt / USECS_PER_MSEC, 'f', 2).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
                 QString::number(stats.congestionWindowSize).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
                 QString::number(stats.events[udt::ConnectionStats::Stats::SentACK]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
-                QString::number(stats.events[udt::ConnectionStats::Stats::Duplicate]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
+                QString::number(stats.events[udt::ConnectionStats::Stats::Duplicate]).rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
+                urgentP50.rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size()),
+                urgentP99.rightJustified(SERVER_STATS_TABLE_HEADERS[++headerIndex].size())
             };
             
             // output this line of values
@@ -18,6 +18,7 @@
 
 
 #include <random>
+#include <vector>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QCommandLineParser>
@@ -27,6 +28,8 @@
 
 #include <ReceivedMessage.h>
 
+class ImpairedRelay;
+
 struct Message {
     udt::MessageNumber messageNumber;
     QByteArray data;
@@ -39,6 +42,7 @@ public:
 
 public slots:
     void refillPacket() { sendPacket(); } // adds a new packet to the queue when we are told one is sent
+    void sendUrgentPacket(); // sends a small timestamped reliable packet, for the receiver to measure its latency
     void sampleStats();
     
 private:
@@ -50,6 +54,8 @@ private:
     
     QCommandLineParser _argumentParser;
     udt::Socket _socket;
+
+    ImpairedRelay* _relay { nullptr }; // set when relaying for other tests instead of testing
     
     SockAddr _target; // the target for sent packets
     
@@ -62,6 +68,9 @@ private:
     bool _sendOrdered { false }; // whether to send ordered packets
     
     int _messageSize { 10000000 }; // number of bytes per message while sending ordered
+    udt::Packet::Priority _messagePriority { udt::Packet::Priority::Normal };
+
+    std::vector<int64_t> _urgentLatencies; // in microseconds, of the urgent packets received since the last stats
 
     std::unordered_map<udt::Packet::MessageNumber, std::unique_ptr<Message>> _pendingMessages;
     